@@ -21,6 +21,7 @@
 //
 
 #include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/Engine/Engine.h>
 #include <Urho3D/Graphics/Camera.h>
 #include <Urho3D/Graphics/DebugRenderer.h>
@@ -36,6 +37,7 @@
 #include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Physics/PhysicsEvents.h>
 #include <Urho3D/Physics/PhysicsWorld.h>
 #include <Urho3D/Physics/RigidBody.h>
 #include <Urho3D/Resource/ResourceCache.h>
@@ -52,7 +54,9 @@ URHO3D_DEFINE_APPLICATION_MAIN(PhysicsStressTest)
 
 PhysicsStressTest::PhysicsStressTest(Context* context) :
     Sample(context),
-    drawDebug_(false)
+    drawDebug_(false),
+    stepTime_(0),
+    numSteps_(0)
 {
 }
 
@@ -190,7 +194,8 @@ void PhysicsStressTest::CreateInstructions()
         "Use WASD keys and mouse/touch to move\n"
         "LMB to spawn physics objects\n"
         "F5 to save scene, F7 to load\n"
-        "Space to toggle physics debug geometry"
+        "Space to toggle physics debug geometry\n"
+        "T to toggle multithreaded physics"
     );
     instructionText->SetFont(cache->GetResource<Font>("Fonts/Anonymous Pro.ttf"), 15);
     // The text has multiple rows. Center them in relation to each other
@@ -200,6 +205,14 @@ void PhysicsStressTest::CreateInstructions()
     instructionText->SetHorizontalAlignment(HA_CENTER);
     instructionText->SetVerticalAlignment(VA_CENTER);
     instructionText->SetPosition(0, ui->GetRoot()->GetHeight() / 4);
+
+    // Construct a text for the threading mode and step time, updated once per second
+    statusText_ = ui->GetRoot()->CreateChild<Text>();
+    statusText_->SetFont(cache->GetResource<Font>("Fonts/Anonymous Pro.ttf"), 15);
+    statusText_->SetHorizontalAlignment(HA_CENTER);
+    statusText_->SetVerticalAlignment(VA_TOP);
+    statusText_->SetPosition(0, 10);
+    UpdateStatusText();
 }
 
 void PhysicsStressTest::SetupViewport()
@@ -219,6 +232,11 @@ void PhysicsStressTest::SubscribeToEvents()
     // Subscribe HandlePostRenderUpdate() function for processing the post-render update event, during which we request
     // debug geometry
     SubscribeToEvent(E_POSTRENDERUPDATE, URHO3D_HANDLER(PhysicsStressTest, HandlePostRenderUpdate));
+
+    // Subscribe to the physics step events from any sender to time the simulation steps, so that timing continues
+    // after the scene (and its PhysicsWorld) is reloaded
+    SubscribeToEvent(E_PHYSICSPRESTEP, URHO3D_HANDLER(PhysicsStressTest, HandlePhysicsPreStep));
+    SubscribeToEvent(E_PHYSICSPOSTSTEP, URHO3D_HANDLER(PhysicsStressTest, HandlePhysicsPostStep));
 }
 
 void PhysicsStressTest::MoveCamera(float timeStep)
@@ -272,6 +290,15 @@ void PhysicsStressTest::MoveCamera(float timeStep)
     // Toggle physics debug geometry with space
     if (input->GetKeyPress(KEY_SPACE))
         drawDebug_ = !drawDebug_;
+
+    // Toggle stepping the physics on the worker threads with T. Has an effect only when the engine was built with
+    // the URHO3D_PHYSICS_THREADED option
+    if (input->GetKeyPress(KEY_T))
+    {
+        auto* physicsWorld = scene_->GetComponent<PhysicsWorld>();
+        physicsWorld->SetMultithreaded(!physicsWorld->GetMultithreaded());
+        UpdateStatusText();
+    }
 }
 
 void PhysicsStressTest::SpawnObject()
@@ -311,6 +338,9 @@ void PhysicsStressTest::HandleUpdate(StringHash eventType, VariantMap& eventData
 
     // Move the camera, scale movement with time step
     MoveCamera(timeStep);
+
+    if (statusTimer_.GetMSec(false) >= 1000)
+        UpdateStatusText();
 }
 
 void PhysicsStressTest::HandlePostRenderUpdate(StringHash eventType, VariantMap& eventData)
@@ -319,3 +349,27 @@ void PhysicsStressTest::HandlePostRenderUpdate(StringHash eventType, VariantMap&
     if (drawDebug_)
         scene_->GetComponent<PhysicsWorld>()->DrawDebugGeometry(true);
 }
+
+void PhysicsStressTest::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
+{
+    stepTimer_.Reset();
+}
+
+void PhysicsStressTest::HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData)
+{
+    stepTime_ += stepTimer_.GetUSec(false);
+    ++numSteps_;
+}
+
+void PhysicsStressTest::UpdateStatusText()
+{
+    auto* physicsWorld = scene_->GetComponent<PhysicsWorld>();
+    String mode = physicsWorld->GetMultithreaded() ?
+        "Multithreaded physics (" + String(GetSubsystem<WorkQueue>()->GetNumThreads()) + " worker threads)" : "Single-threaded physics";
+    String stepTime = numSteps_ ? String(stepTime_ / numSteps_ / 1000.0f) + " ms" : String("-");
+    statusText_->SetText(mode + "\nAverage step time: " + stepTime + "\nScene nodes: " + String(scene_->GetNumChildren()));
+
+    stepTime_ = 0;
+    numSteps_ = 0;
+    statusTimer_.Reset();
+}
@@ -29,6 +29,7 @@ namespace Urho3D
 
 class Node;
 class Scene;
+class Text;
 
 }
 
@@ -37,6 +38,7 @@ class Scene;
 ///     - Physics and rendering performance with a high (1000) moving object count
 ///     - Using triangle meshes for collision
 ///     - Optimizing physics simulation by leaving out collision event signaling
+///     - Stepping the physics simulation on the work queue worker threads (requires the URHO3D_PHYSICS_THREADED build option)
 class PhysicsStressTest : public Sample
 {
     URHO3D_OBJECT(PhysicsStressTest, Sample);
@@ -88,7 +90,23 @@ private:
     void HandleUpdate(StringHash eventType, VariantMap& eventData);
     /// Handle the post-render update event.
     void HandlePostRenderUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle the physics pre-step event, start timing the step.
+    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
+    /// Handle the physics post-step event, accumulate the step time.
+    void HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData);
+    /// Show the threading mode and the average physics step time.
+    void UpdateStatusText();
 
     /// Flag for drawing debug geometry.
     bool drawDebug_;
+    /// Threading mode and step time display.
+    SharedPtr<Text> statusText_;
+    /// Timer for the current physics step.
+    HiresTimer stepTimer_;
+    /// Accumulated physics step time in microseconds since the last status update.
+    long long stepTime_;
+    /// Number of physics steps since the last status update.
+    unsigned numSteps_;
+    /// Timer for the status updates.
+    Timer statusTimer_;
 };
@@ -202,23 +202,22 @@ void Urho2DTileMap::HandleMouseButtonDown(StringHash eventType, VariantMap& even
     int x, y;
     if (map->PositionToTileIndex(x, y, pos))
     {
-        // Get tile's sprite. Note that layer.GetTile(x, y).sprite is read-only, so we get the sprite through tile's node
-        Node* n = layer->GetTileNode(x, y);
-        if (!n)
+        // Skip tiles that are empty or already removed. Note that layer.GetTile(x, y).sprite is read-only, so the rendered sprite
+        // is replaced through the layer, which also works when the tiles are rendered in chunks
+        if (!layer->GetTileSprite(x, y))
             return;
-        auto* sprite = n->GetComponent<StaticSprite2D>();
 
         if (input->GetMouseButtonDown(MOUSEB_RIGHT))
         {
             // Swap grass and water
             if (layer->GetTile(x, y)->GetGid() < 9) // First 8 sprites in the "isometric_grass_and_water.png" tileset are mostly grass and from 9 to 24 they are mostly water
-                sprite->SetSprite(layer->GetTile(0, 0)->GetSprite()); // Replace grass by water sprite used in top tile
+                layer->SetTileSprite(x, y, layer->GetTile(0, 0)->GetSprite()); // Replace grass by water sprite used in top tile
             else
-                sprite->SetSprite(layer->GetTile(24, 24)->GetSprite()); // Replace water by grass sprite used in bottom tile
+                layer->SetTileSprite(x, y, layer->GetTile(24, 24)->GetSprite()); // Replace water by grass sprite used in bottom tile
         }
         else
         {
-            sprite->SetSprite(nullptr); // 'Remove' sprite
+            layer->SetTileSprite(x, y, nullptr); // 'Remove' sprite
         }
     }
 }
@@ -168,6 +168,31 @@ public:
 	
 	// Urho3D: added function to know when we have too many obstacle requests without update
 	bool isObstacleQueueFull() const { return m_nreqs >= MAX_REQUESTS; }
+
+	// Urho3D: added functions to process the obstacle requests and rebuild the touched tiles outside update(), so that the
+	// tiles can be rebuilt in parallel. update() must not be used at the same time.
+
+	/// Returns the maximum number of queued obstacle requests.
+	static int getMaxObstacleRequests() { return MAX_REQUESTS; }
+
+	/// Processes the queued obstacle requests and returns the tiles touched by them, which must then be rebuilt with
+	/// buildNavMeshTileData() and addNavMeshTileData() and passed to finishTileUpdate(). The same tile may be returned more than once.
+	///  @param[out]	tiles		The touched tiles. Should hold getMaxObstacleRequests() * DT_MAX_TOUCHED_TILES tiles.
+	///  @param[out]	tileCount	The number of touched tiles.
+	///  @param[in]		maxTiles	The size of the tiles array.
+	dtStatus processObstacleRequests(dtCompressedTileRef* tiles, int* tileCount, const int maxTiles);
+
+	/// Builds the navmesh data of a tile with its obstacles, without modifying the tile cache or the navmesh. Can be called from
+	/// several threads at once, if each uses its own allocator and the compressor and the mesh process are thread-safe.
+	///  @param[out]	navData		The built navmesh data allocated with dtAlloc, or null if the tile is empty.
+	dtStatus buildNavMeshTileData(const dtCompressedTileRef ref, struct dtTileCacheAlloc* talloc, unsigned char** navData,
+								  int* navDataSize) const;
+
+	/// Replaces the navmesh tile with data built by buildNavMeshTileData(), or removes it if the data is null. The navmesh owns the data.
+	dtStatus addNavMeshTileData(const dtCompressedTileRef ref, unsigned char* navData, const int navDataSize, class dtNavMesh* navmesh);
+
+	/// Updates the states of the obstacles waiting for the tile to be rebuilt.
+	void finishTileUpdate(const dtCompressedTileRef ref);
 	
 	/// Encodes a tile id.
 	inline dtCompressedTileRef encodeTileId(unsigned int salt, unsigned int it) const
@@ -215,6 +240,9 @@ private:
 	dtTileCache(const dtTileCache&);
 	dtTileCache& operator=(const dtTileCache&);
 
+	// Urho3D: added function to change the state of an obstacle whose touched tiles have all been rebuilt
+	void finishObstacle(dtTileCacheObstacle* ob);
+
 	enum ObstacleRequestAction
 	{
 		REQUEST_ADD,
@@ -602,43 +602,7 @@ dtStatus dtTileCache::update(const float /*dt*/, dtNavMesh* navmesh,
 			memmove(m_update, m_update+1, m_nupdate*sizeof(dtCompressedTileRef));
 
 		// Update obstacle states.
-		for (int i = 0; i < m_params.maxObstacles; ++i)
-		{
-			dtTileCacheObstacle* ob = &m_obstacles[i];
-			if (ob->state == DT_OBSTACLE_PROCESSING || ob->state == DT_OBSTACLE_REMOVING)
-			{
-				// Remove handled tile from pending list.
-				for (int j = 0; j < (int)ob->npending; j++)
-				{
-					if (ob->pending[j] == ref)
-					{
-						ob->pending[j] = ob->pending[(int)ob->npending-1];
-						ob->npending--;
-						break;
-					}
-				}
-				
-				// If all pending tiles processed, change state.
-				if (ob->npending == 0)
-				{
-					if (ob->state == DT_OBSTACLE_PROCESSING)
-					{
-						ob->state = DT_OBSTACLE_PROCESSED;
-					}
-					else if (ob->state == DT_OBSTACLE_REMOVING)
-					{
-						ob->state = DT_OBSTACLE_EMPTY;
-						// Update salt, salt should never be zero.
-						ob->salt = (ob->salt+1) & ((1<<16)-1);
-						if (ob->salt == 0)
-							ob->salt++;
-						// Return obstacle to free list.
-						ob->next = m_nextFreeObstacle;
-						m_nextFreeObstacle = ob;
-					}
-				}
-			}
-		}
+		finishTileUpdate(ref);
 	}
 	
 	if (upToDate)
@@ -666,9 +630,25 @@ dtStatus dtTileCache::buildNavMeshTilesAt(const int tx, const int ty, dtNavMesh*
 
 dtStatus dtTileCache::buildNavMeshTile(const dtCompressedTileRef ref, dtNavMesh* navmesh)
 {	
-	dtAssert(m_talloc);
+	// Urho3D: split to buildNavMeshTileData() and addNavMeshTileData(), so that the data can be built in another thread
+	unsigned char* navData = 0;
+	int navDataSize = 0;
+	dtStatus status = buildNavMeshTileData(ref, m_talloc, &navData, &navDataSize);
+	if (dtStatusFailed(status))
+		return status;
+	
+	return addNavMeshTileData(ref, navData, navDataSize, navmesh);
+}
+
+dtStatus dtTileCache::buildNavMeshTileData(const dtCompressedTileRef ref, dtTileCacheAlloc* talloc, unsigned char** navData,
+										   int* navDataSize) const
+{
+	dtAssert(talloc);
 	dtAssert(m_tcomp);
 	
+	*navData = 0;
+	*navDataSize = 0;
+	
 	unsigned int idx = decodeTileIdTile(ref);
 	if (idx > (unsigned int)m_params.maxTiles)
 		return DT_FAILURE | DT_INVALID_PARAM;
@@ -677,14 +657,14 @@ dtStatus dtTileCache::buildNavMeshTile(const dtCompressedTileRef ref, dtNavMesh*
 	if (tile->salt != salt)
 		return DT_FAILURE | DT_INVALID_PARAM;
 	
-	m_talloc->reset();
+	talloc->reset();
 	
-	NavMeshTileBuildContext bc(m_talloc);
+	NavMeshTileBuildContext bc(talloc);
 	const int walkableClimbVx = (int)(m_params.walkableClimb / m_params.ch);
 	dtStatus status;
 	
 	// Decompress tile layer data. 
-	status = dtDecompressTileCacheLayer(m_talloc, m_tcomp, tile->data, tile->dataSize, &bc.layer);
+	status = dtDecompressTileCacheLayer(talloc, m_tcomp, tile->data, tile->dataSize, &bc.layer);
 	if (dtStatusFailed(status))
 		return status;
 	
@@ -715,32 +695,28 @@ dtStatus dtTileCache::buildNavMeshTile(const dtCompressedTileRef ref, dtNavMesh*
 	}
 	
 	// Build navmesh
-	status = dtBuildTileCacheRegions(m_talloc, *bc.layer, walkableClimbVx);
+	status = dtBuildTileCacheRegions(talloc, *bc.layer, walkableClimbVx);
 	if (dtStatusFailed(status))
 		return status;
 	
-	bc.lcset = dtAllocTileCacheContourSet(m_talloc);
+	bc.lcset = dtAllocTileCacheContourSet(talloc);
 	if (!bc.lcset)
 		return DT_FAILURE | DT_OUT_OF_MEMORY;
-	status = dtBuildTileCacheContours(m_talloc, *bc.layer, walkableClimbVx,
+	status = dtBuildTileCacheContours(talloc, *bc.layer, walkableClimbVx,
 									  m_params.maxSimplificationError, *bc.lcset);
 	if (dtStatusFailed(status))
 		return status;
 	
-	bc.lmesh = dtAllocTileCachePolyMesh(m_talloc);
+	bc.lmesh = dtAllocTileCachePolyMesh(talloc);
 	if (!bc.lmesh)
 		return DT_FAILURE | DT_OUT_OF_MEMORY;
-	status = dtBuildTileCachePolyMesh(m_talloc, *bc.lcset, *bc.lmesh);
+	status = dtBuildTileCachePolyMesh(talloc, *bc.lcset, *bc.lmesh);
 	if (dtStatusFailed(status))
 		return status;
 	
-	// Early out if the mesh tile is empty.
+	// Early out if the mesh tile is empty. The existing tile is removed.
 	if (!bc.lmesh->npolys)
-	{
-		// Remove existing tile.
-		navmesh->removeTile(navmesh->getTileRefAt(tile->header->tx,tile->header->ty,tile->header->tlayer),0,0);
 		return DT_SUCCESS;
-	}
 	
 	dtNavMeshCreateParams params;
 	memset(&params, 0, sizeof(params));
@@ -768,11 +744,22 @@ dtStatus dtTileCache::buildNavMeshTile(const dtCompressedTileRef ref, dtNavMesh*
 		m_tmproc->process(&params, bc.lmesh->areas, bc.lmesh->flags);
 	}
 	
-	unsigned char* navData = 0;
-	int navDataSize = 0;
-	if (!dtCreateNavMeshData(&params, &navData, &navDataSize))
+	if (!dtCreateNavMeshData(&params, navData, navDataSize))
 		return DT_FAILURE;
+	
+	return DT_SUCCESS;
+}
 
+dtStatus dtTileCache::addNavMeshTileData(const dtCompressedTileRef ref, unsigned char* navData, const int navDataSize,
+										 dtNavMesh* navmesh)
+{
+	const dtCompressedTile* tile = getTileByRef(ref);
+	if (!tile || !tile->header)
+	{
+		dtFree(navData);
+		return DT_FAILURE | DT_INVALID_PARAM;
+	}
+	
 	// Remove existing tile.
 	navmesh->removeTile(navmesh->getTileRefAt(tile->header->tx,tile->header->ty,tile->header->tlayer),0,0);
 
@@ -780,7 +767,7 @@ dtStatus dtTileCache::buildNavMeshTile(const dtCompressedTileRef ref, dtNavMesh*
 	if (navData)
 	{
 		// Let the navmesh own the data.
-		status = navmesh->addTile(navData,navDataSize,DT_TILE_FREE_DATA,0,0);
+		dtStatus status = navmesh->addTile(navData,navDataSize,DT_TILE_FREE_DATA,0,0);
 		if (dtStatusFailed(status))
 		{
 			dtFree(navData);
@@ -791,6 +778,110 @@ dtStatus dtTileCache::buildNavMeshTile(const dtCompressedTileRef ref, dtNavMesh*
 	return DT_SUCCESS;
 }
 
+dtStatus dtTileCache::processObstacleRequests(dtCompressedTileRef* tiles, int* tileCount, const int maxTiles)
+{
+	int n = 0;
+	
+	for (int i = 0; i < m_nreqs; ++i)
+	{
+		ObstacleRequest* req = &m_reqs[i];
+		
+		unsigned int idx = decodeObstacleIdObstacle(req->ref);
+		if ((int)idx >= m_params.maxObstacles)
+			continue;
+		dtTileCacheObstacle* ob = &m_obstacles[idx];
+		unsigned int salt = decodeObstacleIdSalt(req->ref);
+		if (ob->salt != salt)
+			continue;
+		
+		if (req->action == REQUEST_ADD)
+		{
+			// Find touched tiles.
+			float bmin[3], bmax[3];
+			getObstacleBounds(ob, bmin, bmax);
+			
+			int ntouched = 0;
+			queryTiles(bmin, bmax, ob->touched, &ntouched, DT_MAX_TOUCHED_TILES);
+			ob->ntouched = (unsigned char)ntouched;
+		}
+		else if (req->action == REQUEST_REMOVE)
+		{
+			// Prepare to remove obstacle.
+			ob->state = DT_OBSTACLE_REMOVING;
+		}
+		else
+			continue;
+		
+		// Add tiles to update list.
+		ob->npending = 0;
+		for (int j = 0; j < ob->ntouched; ++j)
+		{
+			if (n < maxTiles)
+			{
+				tiles[n++] = ob->touched[j];
+				ob->pending[ob->npending++] = ob->touched[j];
+			}
+		}
+	}
+	
+	m_nreqs = 0;
+	*tileCount = n;
+	
+	// Finish the obstacles that touch no tiles, as no tile update would finish them.
+	for (int i = 0; i < m_params.maxObstacles; ++i)
+	{
+		dtTileCacheObstacle* ob = &m_obstacles[i];
+		if ((ob->state == DT_OBSTACLE_PROCESSING || ob->state == DT_OBSTACLE_REMOVING) && ob->npending == 0)
+			finishObstacle(ob);
+	}
+	
+	return DT_SUCCESS;
+}
+
+void dtTileCache::finishTileUpdate(const dtCompressedTileRef ref)
+{
+	for (int i = 0; i < m_params.maxObstacles; ++i)
+	{
+		dtTileCacheObstacle* ob = &m_obstacles[i];
+		if (ob->state == DT_OBSTACLE_PROCESSING || ob->state == DT_OBSTACLE_REMOVING)
+		{
+			// Remove handled tile from pending list.
+			for (int j = 0; j < (int)ob->npending; j++)
+			{
+				if (ob->pending[j] == ref)
+				{
+					ob->pending[j] = ob->pending[(int)ob->npending-1];
+					ob->npending--;
+					break;
+				}
+			}
+			
+			// If all pending tiles processed, change state.
+			if (ob->npending == 0)
+				finishObstacle(ob);
+		}
+	}
+}
+
+void dtTileCache::finishObstacle(dtTileCacheObstacle* ob)
+{
+	if (ob->state == DT_OBSTACLE_PROCESSING)
+	{
+		ob->state = DT_OBSTACLE_PROCESSED;
+	}
+	else if (ob->state == DT_OBSTACLE_REMOVING)
+	{
+		ob->state = DT_OBSTACLE_EMPTY;
+		// Update salt, salt should never be zero.
+		ob->salt = (ob->salt+1) & ((1<<16)-1);
+		if (ob->salt == 0)
+			ob->salt++;
+		// Return obstacle to free list.
+		ob->next = m_nextFreeObstacle;
+		m_nextFreeObstacle = ob;
+	}
+}
+
 void dtTileCache::calcTightTileBounds(const dtTileCacheLayerHeader* header, float* bmin, float* bmax) const
 {
 	const float cs = m_params.cs;
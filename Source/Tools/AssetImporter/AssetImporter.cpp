@@ -32,6 +32,7 @@
 #include <Urho3D/Graphics/IndexBuffer.h>
 #include <Urho3D/Graphics/Light.h>
 #include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/MeshSimplifier.h>
 #include <Urho3D/Graphics/Octree.h>
 #include <Urho3D/Graphics/VertexBuffer.h>
 #include <Urho3D/Graphics/Zone.h>
@@ -75,6 +76,15 @@ struct OutModel
     unsigned totalIndices_{};
 };
 
+struct OutGeometry
+{
+    aiMesh* mesh_{};
+    Matrix3x4 vertexTransform_;
+    Matrix3 normalTransform_;
+    PODVector<unsigned> vertexOrder_;
+    Vector<PODVector<unsigned> > lodIndices_;
+};
+
 struct OutScene
 {
     String outName_;
@@ -135,6 +145,10 @@ const char *transformSuffix[TransformationComp_MAXIMUM] =
 };
 
 static const unsigned MAX_CHANNELS = 4;
+static const unsigned VERTEX_CACHE_SIZE = 32;
+static const unsigned OVERDRAW_CACHE_SIZE = 16;
+static const unsigned MIN_OVERDRAW_CLUSTER_TRIANGLES = 16;
+static const float LOD_MIN_REDUCTION = 0.9f;
 
 SharedPtr<Context> context_(new Context());
 const aiScene* scene_ = nullptr;
@@ -163,6 +177,14 @@ bool noOverwriteTexture_ = false;
 bool noOverwriteNewerTexture_ = false;
 bool checkUniqueModel_ = true;
 bool moveToBindPose_ = false;
+bool compressAnimations_ = false;
+float animationTolerance_ = 0.001f;
+bool optimizeGeometry_ = false;
+unsigned numGeneratedLods_ = 0;
+float generatedLodDistance_ = 0.0f;
+float generatedLodRatio_ = 0.5f;
+bool octNormals_ = false;
+bool halfTexCoords_ = false;
 unsigned maxBones_ = 64;
 Vector<String> nonSkinningBoneIncludes_;
 Vector<String> nonSkinningBoneExcludes_;
@@ -216,12 +238,17 @@ String GenerateMaterialName(aiMaterial* material);
 String GenerateTextureName(unsigned texIndex);
 unsigned GetNumValidFaces(aiMesh* mesh);
 
-void WriteShortIndices(unsigned short*& dest, aiMesh* mesh, unsigned index, unsigned offset);
-void WriteLargeIndices(unsigned*& dest, aiMesh* mesh, unsigned index, unsigned offset);
+void BuildGeometries(OutModel& model, Vector<OutGeometry>& geometries);
+void BuildGeometryWork(const WorkItem* item, unsigned threadIndex);
+void OptimizeVertexCache(PODVector<unsigned>& indices, unsigned numVertices);
+void OptimizeOverdraw(PODVector<unsigned>& indices, const PODVector<Vector3>& positions);
+void OptimizeVertexFetch(Vector<PODVector<unsigned> >& lodIndices, PODVector<unsigned>& vertexOrder, unsigned numVertices);
 void WriteVertex(float*& dest, aiMesh* mesh, unsigned index, bool isSkinned, BoundingBox& box,
     const Matrix3x4& vertexTransform, const Matrix3& normalTransform, Vector<PODVector<unsigned char> >& blendIndices,
     Vector<PODVector<float> >& blendWeights);
 PODVector<VertexElement> GetVertexElements(aiMesh* mesh, bool isSkinned);
+Vector2 EncodeOctNormal(const Vector3& normal);
+short ToSNorm16(float value);
 
 aiNode* GetNode(const String& name, aiNode* rootNode, bool caseSensitive = true);
 aiMatrix4x4 GetDerivedTransform(aiNode* node, aiNode* rootNode, bool rootInclusive = true);
@@ -306,6 +333,17 @@ void Run(const Vector<String>& arguments)
             "-split <start> <end> (animation model only)\n"
             "            Split animation, will only import from start frame to end frame\n"
             "-np         Do not suppress $fbx pivot nodes (FBX files only)\n"
+            "-ca <tol>   Compress animations with quantized keys, removing keys that\n"
+            "            interpolation reproduces within the tolerance. Default 0.001\n"
+            "-oc         Optimize triangle order for the vertex cache and overdraw, and\n"
+            "            vertex order for vertex fetch\n"
+            "-gl <n> <d> Generate n simplified LOD levels for each geometry. LOD level k\n"
+            "            is used from distance k * d\n"
+            "-glr <r>    Triangle count ratio between successive generated LOD levels.\n"
+            "            Default 0.5\n"
+            "-qn         Store normals and tangents octahedral-encoded as 16-bit values.\n"
+            "            Exported materials get the OCTNORMAL vertex shader define\n"
+            "-qu         Store texture coordinates as 16-bit half floats\n"
         );
     }
 
@@ -456,6 +494,36 @@ void Run(const Vector<String>& arguments)
                 checkUniqueModel_ = false;
             else if (argument == "bp")
                 moveToBindPose_ = true;
+            else if (argument == "ca")
+            {
+                compressAnimations_ = true;
+                if (value.Length() && value[0] != '-')
+                {
+                    animationTolerance_ = Max(ToFloat(value), 0.0f);
+                    ++i;
+                }
+            }
+            else if (argument == "oc")
+                optimizeGeometry_ = true;
+            else if (argument == "gl")
+            {
+                String value2 = i + 2 < arguments.Size() ? arguments[i + 2] : String::EMPTY;
+                if (value.Length() && value2.Length() && (value[0] != '-') && (value2[0] != '-'))
+                {
+                    numGeneratedLods_ = ToUInt(value);
+                    generatedLodDistance_ = Max(ToFloat(value2), 0.0f);
+                    i += 2;
+                }
+            }
+            else if (argument == "glr" && !value.Empty())
+            {
+                generatedLodRatio_ = Clamp(ToFloat(value), 0.01f, 0.99f);
+                ++i;
+            }
+            else if (argument == "qn")
+                octNormals_ = true;
+            else if (argument == "qu")
+                halfTexCoords_ = true;
             else if (argument == "split")
             {
                 String value2 = i + 2 < arguments.Size() ? arguments[i + 2] : String::EMPTY;
@@ -468,6 +536,12 @@ void Run(const Vector<String>& arguments)
         }
     }
 
+#ifdef URHO3D_THREADING
+    // Geometries are optimized and simplified in parallel
+    if ((optimizeGeometry_ || numGeneratedLods_) && GetNumLogicalCPUs() > 1)
+        context_->GetSubsystem<WorkQueue>()->CreateThreads(GetNumLogicalCPUs() - 1);
+#endif
+
     if (command == "model" || command == "scene" || command == "anim" || command == "node" || command == "dump")
     {
         String inFile = arguments[1];
@@ -1034,6 +1108,17 @@ void BuildAndSaveModel(OutModel& model)
             combineBuffers = false;
     }
 
+    // Build the index lists of each geometry and its LOD levels
+    Vector<OutGeometry> geometries(model.meshes_.Size());
+    BuildGeometries(model, geometries);
+
+    unsigned totalIndices = 0;
+    for (unsigned i = 0; i < geometries.Size(); ++i)
+    {
+        for (unsigned j = 0; j < geometries[i].lodIndices_.Size(); ++j)
+            totalIndices += geometries[i].lodIndices_[j].Size();
+    }
+
     SharedPtr<IndexBuffer> ib;
     SharedPtr<VertexBuffer> vb;
     Vector<SharedPtr<VertexBuffer> > vbVector;
@@ -1053,6 +1138,11 @@ void BuildAndSaveModel(OutModel& model)
         if (!validFaces)
             continue;
 
+        const OutGeometry& geometry = geometries[i];
+        unsigned geometryIndices = 0;
+        for (unsigned j = 0; j < geometry.lodIndices_.Size(); ++j)
+            geometryIndices += geometry.lodIndices_[j].Size();
+
         bool largeIndices;
         if (combineBuffers)
             largeIndices = model.totalIndices_ > 65535;
@@ -1067,12 +1157,12 @@ void BuildAndSaveModel(OutModel& model)
 
             if (combineBuffers)
             {
-                ib->SetSize(model.totalIndices_, largeIndices);
+                ib->SetSize(totalIndices, largeIndices);
                 vb->SetSize(model.totalVertices_, elements);
             }
             else
             {
-                ib->SetSize(validFaces * 3, largeIndices);
+                ib->SetSize(geometryIndices, largeIndices);
                 vb->SetSize(mesh->mNumVertices, elements);
             }
 
@@ -1082,19 +1172,15 @@ void BuildAndSaveModel(OutModel& model)
             startIndexOffset = 0;
         }
 
-        // Get the world transform of the mesh for baking into the vertices
-        Matrix3x4 vertexTransform;
-        Matrix3 normalTransform;
-        Vector3 pos, scale;
-        Quaternion rot;
-        GetPosRotScale(GetMeshBakingTransform(model.meshNodes_[i], model.rootNode_), pos, rot, scale);
-        vertexTransform = Matrix3x4(pos, rot, scale);
-        normalTransform = rot.RotationMatrix();
-
-        SharedPtr<Geometry> geom(new Geometry(context_));
+        // The world transform of the mesh for baking into the vertices
+        const Matrix3x4& vertexTransform = geometry.vertexTransform_;
+        const Matrix3& normalTransform = geometry.normalTransform_;
 
         PrintLine("Writing geometry " + String(i) + " with " + String(mesh->mNumVertices) + " vertices " +
             String(validFaces * 3) + " indices");
+        for (unsigned j = 1; j < geometry.lodIndices_.Size(); ++j)
+            PrintLine("Writing LOD level " + String(j) + " of geometry " + String(i) + " with " +
+                String(geometry.lodIndices_[j].Size()) + " indices");
 
         if (model.bones_.Size() > 0 && !mesh->HasBones())
             PrintLine("Warning: model has bones but geometry " + String(i) + " has no skinning information");
@@ -1102,18 +1188,26 @@ void BuildAndSaveModel(OutModel& model)
         unsigned char* vertexData = vb->GetShadowData();
         unsigned char* indexData = ib->GetShadowData();
 
-        // Build the index data
+        // Build the index data, with the LOD levels following each other
         if (!largeIndices)
         {
             unsigned short* dest = (unsigned short*)indexData + startIndexOffset;
-            for (unsigned j = 0; j < mesh->mNumFaces; ++j)
-                WriteShortIndices(dest, mesh, j, startVertexOffset);
+            for (unsigned j = 0; j < geometry.lodIndices_.Size(); ++j)
+            {
+                const PODVector<unsigned>& indices = geometry.lodIndices_[j];
+                for (unsigned k = 0; k < indices.Size(); ++k)
+                    *dest++ = (unsigned short)(indices[k] + startVertexOffset);
+            }
         }
         else
         {
             unsigned* dest = (unsigned*)indexData + startIndexOffset;
-            for (unsigned j = 0; j < mesh->mNumFaces; ++j)
-                WriteLargeIndices(dest, mesh, j, startVertexOffset);
+            for (unsigned j = 0; j < geometry.lodIndices_.Size(); ++j)
+            {
+                const PODVector<unsigned>& indices = geometry.lodIndices_[j];
+                for (unsigned k = 0; k < indices.Size(); ++k)
+                    *dest++ = indices[k] + startVertexOffset;
+            }
         }
 
         // Build the vertex data
@@ -1126,7 +1220,8 @@ void BuildAndSaveModel(OutModel& model)
 
         auto* dest = (float*)((unsigned char*)vertexData + startVertexOffset * vb->GetVertexSize());
         for (unsigned j = 0; j < mesh->mNumVertices; ++j)
-            WriteVertex(dest, mesh, j, isSkinned, box, vertexTransform, normalTransform, blendIndices, blendWeights);
+            WriteVertex(dest, mesh, geometry.vertexOrder_[j], isSkinned, box, vertexTransform, normalTransform, blendIndices,
+                blendWeights);
 
         // Calculate the geometry center
         Vector3 center = Vector3::ZERO;
@@ -1145,18 +1240,25 @@ void BuildAndSaveModel(OutModel& model)
             center /= (float)validFaces * 3;
         }
 
-        // Define the geometry
-        geom->SetIndexBuffer(ib);
-        geom->SetVertexBuffer(0, vb);
-        geom->SetDrawRange(TRIANGLE_LIST, startIndexOffset, validFaces * 3, true);
-        outModel->SetNumGeometryLodLevels(destGeomIndex, 1);
-        outModel->SetGeometry(destGeomIndex, 0, geom);
+        // Define the geometry and its LOD levels
+        outModel->SetNumGeometryLodLevels(destGeomIndex, geometry.lodIndices_.Size());
+        unsigned lodIndexOffset = startIndexOffset;
+        for (unsigned j = 0; j < geometry.lodIndices_.Size(); ++j)
+        {
+            SharedPtr<Geometry> geom(new Geometry(context_));
+            geom->SetIndexBuffer(ib);
+            geom->SetVertexBuffer(0, vb);
+            geom->SetDrawRange(TRIANGLE_LIST, lodIndexOffset, geometry.lodIndices_[j].Size(), true);
+            geom->SetLodDistance(generatedLodDistance_ * j);
+            outModel->SetGeometry(destGeomIndex, j, geom);
+            lodIndexOffset += geometry.lodIndices_[j].Size();
+        }
         outModel->SetGeometryCenter(destGeomIndex, center);
         if (model.bones_.Size() > maxBones_)
             allBoneMappings.Push(boneMappings);
 
         startVertexOffset += mesh->mNumVertices;
-        startIndexOffset += validFaces * 3;
+        startIndexOffset += geometryIndices;
         ++destGeomIndex;
     }
 
@@ -1482,6 +1584,8 @@ void BuildAndSaveAnimations(OutModel* model)
         File outFile(context_);
         if (!outFile.Open(animOutName, FILE_WRITE))
             ErrorExit("Could not open output file " + animOutName);
+        if (compressAnimations_)
+            outAnim->Compress(animationTolerance_, animationTolerance_, animationTolerance_);
         outAnim->Save(outFile);
     }
 }
@@ -1942,6 +2046,13 @@ void BuildAndSaveMaterial(aiMaterial* material, HashSet<String>& usedTextures)
     emissiveColorElem.SetString("name", "MatEmissiveColor");
     emissiveColorElem.SetColor("value", emissiveColor);
 
+    // Octahedral-encoded normals need to be decoded in the vertex shader
+    if (octNormals_)
+    {
+        XMLElement shaderElem = materialElem.CreateChild("shader");
+        shaderElem.SetString("vsdefines", "OCTNORMAL");
+    }
+
     if (twoSided)
     {
         XMLElement cullElem = materialElem.CreateChild("cull");
@@ -2402,23 +2513,341 @@ unsigned GetNumValidFaces(aiMesh* mesh)
     return ret;
 }
 
-void WriteShortIndices(unsigned short*& dest, aiMesh* mesh, unsigned index, unsigned offset)
+void BuildGeometries(OutModel& model, Vector<OutGeometry>& geometries)
+{
+    auto* workQueue = context_->GetSubsystem<WorkQueue>();
+
+    for (unsigned i = 0; i < model.meshes_.Size(); ++i)
+    {
+        OutGeometry& geometry = geometries[i];
+        geometry.mesh_ = model.meshes_[i];
+
+        // Get the world transform of the mesh for baking into the vertices
+        Vector3 pos, scale;
+        Quaternion rot;
+        GetPosRotScale(GetMeshBakingTransform(model.meshNodes_[i], model.rootNode_), pos, rot, scale);
+        geometry.vertexTransform_ = Matrix3x4(pos, rot, scale);
+        geometry.normalTransform_ = rot.RotationMatrix();
+
+        SharedPtr<WorkItem> item = workQueue->GetFreeItem();
+        item->workFunction_ = BuildGeometryWork;
+        item->aux_ = &geometry;
+        item->priority_ = M_MAX_UNSIGNED;
+        workQueue->AddWorkItem(item);
+    }
+
+    workQueue->Complete(M_MAX_UNSIGNED);
+}
+
+void BuildGeometryWork(const WorkItem* item, unsigned /*threadIndex*/)
+{
+    auto* geometry = reinterpret_cast<OutGeometry*>(item->aux_);
+    aiMesh* mesh = geometry->mesh_;
+
+    PODVector<unsigned> indices;
+    for (unsigned i = 0; i < mesh->mNumFaces; ++i)
+    {
+        const aiFace& face = mesh->mFaces[i];
+        if (face.mNumIndices == 3)
+        {
+            indices.Push(face.mIndices[0]);
+            indices.Push(face.mIndices[1]);
+            indices.Push(face.mIndices[2]);
+        }
+    }
+
+    PODVector<Vector3> positions(mesh->mNumVertices);
+    for (unsigned i = 0; i < mesh->mNumVertices; ++i)
+        positions[i] = geometry->vertexTransform_ * ToVector3(mesh->mVertices[i]);
+
+    if (optimizeGeometry_)
+    {
+        OptimizeVertexCache(indices, mesh->mNumVertices);
+        OptimizeOverdraw(indices, positions);
+    }
+    geometry->lodIndices_.Push(indices);
+
+    // Simplify each LOD level from the previous one. Stop when the geometry can not be reduced meaningfully any more
+    for (unsigned i = 0; i < numGeneratedLods_; ++i)
+    {
+        const PODVector<unsigned>& sourceIndices = geometry->lodIndices_.Back();
+        unsigned targetIndexCount = (unsigned)(sourceIndices.Size() / 3 * generatedLodRatio_) * 3;
+
+        PODVector<unsigned> lodIndices;
+        SimplifyIndices(sourceIndices, positions, targetIndexCount, lodIndices);
+        if (lodIndices.Empty() || lodIndices.Size() > sourceIndices.Size() * LOD_MIN_REDUCTION)
+            break;
+
+        if (optimizeGeometry_)
+            OptimizeVertexCache(lodIndices, mesh->mNumVertices);
+        geometry->lodIndices_.Push(lodIndices);
+    }
+
+    if (optimizeGeometry_)
+        OptimizeVertexFetch(geometry->lodIndices_, geometry->vertexOrder_, mesh->mNumVertices);
+    else
+    {
+        geometry->vertexOrder_.Resize(mesh->mNumVertices);
+        for (unsigned i = 0; i < mesh->mNumVertices; ++i)
+            geometry->vertexOrder_[i] = i;
+    }
+}
+
+void OptimizeVertexCache(PODVector<unsigned>& indices, unsigned numVertices)
+{
+    // Linear-speed vertex cache optimization by Tom Forsyth: greedily emit the triangle with the highest score,
+    // where vertices score higher when recently used and when few of their triangles remain
+    unsigned numTriangles = indices.Size() / 3;
+    if (!numTriangles)
+        return;
+
+    auto vertexScore = [](int cachePosition, unsigned remainingTriangles)
+    {
+        if (!remainingTriangles)
+            return -1.0f;
+
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            if (cachePosition < 3)
+                score = 0.75f;
+            else
+                score = Pow(1.0f - (float)(cachePosition - 3) / (VERTEX_CACHE_SIZE - 3), 1.5f);
+        }
+        return score + 2.0f / Sqrt((float)remainingTriangles);
+    };
+
+    // Build the triangle lists of each vertex
+    PODVector<unsigned> remaining(numVertices, 0);
+    for (unsigned i = 0; i < indices.Size(); ++i)
+        ++remaining[indices[i]];
+    PODVector<unsigned> offsets(numVertices + 1, 0);
+    for (unsigned i = 0; i < numVertices; ++i)
+        offsets[i + 1] = offsets[i] + remaining[i];
+    PODVector<unsigned> adjacency(indices.Size());
+    PODVector<unsigned> fill(numVertices, 0);
+    for (unsigned i = 0; i < indices.Size(); ++i)
+    {
+        unsigned vertex = indices[i];
+        adjacency[offsets[vertex] + fill[vertex]++] = i / 3;
+    }
+
+    PODVector<float> vertexScores(numVertices);
+    for (unsigned i = 0; i < numVertices; ++i)
+        vertexScores[i] = vertexScore(-1, remaining[i]);
+
+    PODVector<unsigned char> emitted(numTriangles, 0);
+    unsigned bestTriangle = 0;
+    float bestScore = -1.0f;
+    for (unsigned i = 0; i < numTriangles; ++i)
+    {
+        float score = vertexScores[indices[i * 3]] + vertexScores[indices[i * 3 + 1]] + vertexScores[indices[i * 3 + 2]];
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestTriangle = i;
+        }
+    }
+
+    PODVector<unsigned> result;
+    result.Reserve(indices.Size());
+    PODVector<unsigned> cache;
+    PODVector<unsigned> newCache;
+    unsigned nextTriangle = 0;
+
+    for (;;)
+    {
+        // Emit the triangle and remove it from the triangle lists of its vertices
+        emitted[bestTriangle] = 1;
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            unsigned vertex = indices[bestTriangle * 3 + i];
+            result.Push(vertex);
+
+            unsigned* triangles = &adjacency[offsets[vertex]];
+            for (unsigned j = 0; j < remaining[vertex]; ++j)
+            {
+                if (triangles[j] == bestTriangle)
+                {
+                    triangles[j] = triangles[--remaining[vertex]];
+                    break;
+                }
+            }
+        }
+
+        if (result.Size() == indices.Size())
+            break;
+
+        // Move the triangle's vertices to the front of the cache
+        newCache.Clear();
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            unsigned vertex = indices[bestTriangle * 3 + i];
+            if (!newCache.Contains(vertex))
+                newCache.Push(vertex);
+        }
+        for (unsigned i = 0; i < cache.Size(); ++i)
+        {
+            if (!newCache.Contains(cache[i]))
+                newCache.Push(cache[i]);
+        }
+        for (unsigned i = VERTEX_CACHE_SIZE; i < newCache.Size(); ++i)
+            vertexScores[newCache[i]] = vertexScore(-1, remaining[newCache[i]]);
+        if (newCache.Size() > VERTEX_CACHE_SIZE)
+            newCache.Resize(VERTEX_CACHE_SIZE);
+        cache.Swap(newCache);
+
+        for (unsigned i = 0; i < cache.Size(); ++i)
+            vertexScores[cache[i]] = vertexScore(i, remaining[cache[i]]);
+
+        // Rescore the triangles of the cached vertices and pick the best of them
+        bestScore = -1.0f;
+        bestTriangle = M_MAX_UNSIGNED;
+        for (unsigned i = 0; i < cache.Size(); ++i)
+        {
+            unsigned vertex = cache[i];
+            for (unsigned j = 0; j < remaining[vertex]; ++j)
+            {
+                unsigned triangle = adjacency[offsets[vertex] + j];
+                float score = vertexScores[indices[triangle * 3]] + vertexScores[indices[triangle * 3 + 1]] +
+                    vertexScores[indices[triangle * 3 + 2]];
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    bestTriangle = triangle;
+                }
+            }
+        }
+
+        // If the cache has no triangles left, continue from the next triangle not emitted yet
+        if (bestTriangle == M_MAX_UNSIGNED)
+        {
+            while (emitted[nextTriangle])
+                ++nextTriangle;
+            bestTriangle = nextTriangle;
+        }
+    }
+
+    indices.Swap(result);
+}
+
+void OptimizeOverdraw(PODVector<unsigned>& indices, const PODVector<Vector3>& positions)
 {
-    if (mesh->mFaces[index].mNumIndices == 3)
+    struct Cluster
     {
-        *dest++ = mesh->mFaces[index].mIndices[0] + offset;
-        *dest++ = mesh->mFaces[index].mIndices[1] + offset;
-        *dest++ = mesh->mFaces[index].mIndices[2] + offset;
+        unsigned start_;
+        unsigned end_;
+        float sortKey_;
+    };
+
+    unsigned numTriangles = indices.Size() / 3;
+    if (numTriangles < 2 * MIN_OVERDRAW_CLUSTER_TRIANGLES)
+        return;
+
+    // Split the triangles into clusters where the simulated FIFO vertex cache misses all vertices, so that reordering
+    // the clusters keeps most of the cache efficiency
+    PODVector<unsigned> clusterStarts;
+    clusterStarts.Push(0);
+    PODVector<unsigned> timestamps(positions.Size(), 0);
+    unsigned time = OVERDRAW_CACHE_SIZE + 1;
+    for (unsigned i = 0; i < numTriangles; ++i)
+    {
+        unsigned misses = 0;
+        for (unsigned j = 0; j < 3; ++j)
+        {
+            unsigned vertex = indices[i * 3 + j];
+            if (time - timestamps[vertex] > OVERDRAW_CACHE_SIZE)
+            {
+                timestamps[vertex] = time++;
+                ++misses;
+            }
+        }
+
+        if (misses == 3 && i - clusterStarts.Back() >= MIN_OVERDRAW_CLUSTER_TRIANGLES)
+            clusterStarts.Push(i);
     }
+
+    Vector3 meshCenter = Vector3::ZERO;
+    for (unsigned i = 0; i < indices.Size(); ++i)
+        meshCenter += positions[indices[i]];
+    meshCenter /= (float)indices.Size();
+
+    // Draw the clusters facing away from the mesh center first, as they are most likely to occlude the others
+    PODVector<Cluster> clusters(clusterStarts.Size());
+    for (unsigned i = 0; i < clusters.Size(); ++i)
+    {
+        Cluster& cluster = clusters[i];
+        cluster.start_ = clusterStarts[i];
+        cluster.end_ = i + 1 < clusterStarts.Size() ? clusterStarts[i + 1] : numTriangles;
+
+        Vector3 center = Vector3::ZERO;
+        Vector3 normal = Vector3::ZERO;
+        float area = 0.0f;
+        for (unsigned j = cluster.start_; j < cluster.end_; ++j)
+        {
+            const Vector3& v0 = positions[indices[j * 3]];
+            const Vector3& v1 = positions[indices[j * 3 + 1]];
+            const Vector3& v2 = positions[indices[j * 3 + 2]];
+            Vector3 triangleNormal = (v1 - v0).CrossProduct(v2 - v0);
+            float triangleArea = triangleNormal.Length();
+            center += (v0 + v1 + v2) * (triangleArea / 3.0f);
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        center = area > 0.0f ? center / area : positions[indices[cluster.start_ * 3]];
+        cluster.sortKey_ = (center - meshCenter).DotProduct(normal.Normalized());
+    }
+
+    Sort(clusters.Begin(), clusters.End(), [](const Cluster& lhs, const Cluster& rhs)
+    {
+        return lhs.sortKey_ != rhs.sortKey_ ? lhs.sortKey_ > rhs.sortKey_ : lhs.start_ < rhs.start_;
+    });
+
+    PODVector<unsigned> result;
+    result.Reserve(indices.Size());
+    for (unsigned i = 0; i < clusters.Size(); ++i)
+    {
+        for (unsigned j = clusters[i].start_ * 3; j < clusters[i].end_ * 3; ++j)
+            result.Push(indices[j]);
+    }
+
+    indices.Swap(result);
 }
 
-void WriteLargeIndices(unsigned*& dest, aiMesh* mesh, unsigned index, unsigned offset)
+void OptimizeVertexFetch(Vector<PODVector<unsigned> >& lodIndices, PODVector<unsigned>& vertexOrder, unsigned numVertices)
 {
-    if (mesh->mFaces[index].mNumIndices == 3)
+    // Order the vertices by first use in the index data. Vertices not used by any LOD level go last
+    PODVector<unsigned> remap(numVertices, M_MAX_UNSIGNED);
+    vertexOrder.Clear();
+    vertexOrder.Reserve(numVertices);
+    for (unsigned i = 0; i < lodIndices.Size(); ++i)
+    {
+        PODVector<unsigned>& indices = lodIndices[i];
+        for (unsigned j = 0; j < indices.Size(); ++j)
+        {
+            unsigned vertex = indices[j];
+            if (remap[vertex] == M_MAX_UNSIGNED)
+            {
+                remap[vertex] = vertexOrder.Size();
+                vertexOrder.Push(vertex);
+            }
+        }
+    }
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        if (remap[i] == M_MAX_UNSIGNED)
+        {
+            remap[i] = vertexOrder.Size();
+            vertexOrder.Push(i);
+        }
+    }
+
+    for (unsigned i = 0; i < lodIndices.Size(); ++i)
     {
-        *dest++ = mesh->mFaces[index].mIndices[0] + offset;
-        *dest++ = mesh->mFaces[index].mIndices[1] + offset;
-        *dest++ = mesh->mFaces[index].mIndices[2] + offset;
+        PODVector<unsigned>& indices = lodIndices[i];
+        for (unsigned j = 0; j < indices.Size(); ++j)
+            indices[j] = remap[indices[j]];
     }
 }
 
@@ -2435,9 +2864,20 @@ void WriteVertex(float*& dest, aiMesh* mesh, unsigned index, bool isSkinned, Bou
     if (mesh->HasNormals())
     {
         Vector3 normal = normalTransform * ToVector3(mesh->mNormals[index]);
-        *dest++ = normal.x_;
-        *dest++ = normal.y_;
-        *dest++ = normal.z_;
+        if (octNormals_)
+        {
+            Vector2 encoded = EncodeOctNormal(normal);
+            auto* destShorts = (short*)dest;
+            destShorts[0] = ToSNorm16(encoded.x_);
+            destShorts[1] = ToSNorm16(encoded.y_);
+            ++dest;
+        }
+        else
+        {
+            *dest++ = normal.x_;
+            *dest++ = normal.y_;
+            *dest++ = normal.z_;
+        }
     }
 
     for (unsigned i = 0; i < mesh->GetNumColorChannels() && i < MAX_CHANNELS; ++i)
@@ -2450,8 +2890,18 @@ void WriteVertex(float*& dest, aiMesh* mesh, unsigned index, bool isSkinned, Bou
     for (unsigned i = 0; i < mesh->GetNumUVChannels() && i < MAX_CHANNELS; ++i)
     {
         Vector3 texCoord = ToVector3(mesh->mTextureCoords[i][index]);
-        *dest++ = texCoord.x_;
-        *dest++ = texCoord.y_;
+        if (halfTexCoords_)
+        {
+            auto* destShorts = (unsigned short*)dest;
+            destShorts[0] = FloatToHalf(texCoord.x_);
+            destShorts[1] = FloatToHalf(texCoord.y_);
+            ++dest;
+        }
+        else
+        {
+            *dest++ = texCoord.x_;
+            *dest++ = texCoord.y_;
+        }
     }
 
     if (mesh->HasTangentsAndBitangents())
@@ -2464,10 +2914,24 @@ void WriteVertex(float*& dest, aiMesh* mesh, unsigned index, bool isSkinned, Bou
         if ((tangent.CrossProduct(normal)).DotProduct(bitangent) < 0.5f)
             w = -1.0f;
 
-        *dest++ = tangent.x_;
-        *dest++ = tangent.y_;
-        *dest++ = tangent.z_;
-        *dest++ = w;
+        if (octNormals_)
+        {
+            // Tangent direction is octahedral-encoded in xy, the handedness sign is stored in w
+            Vector2 encoded = EncodeOctNormal(tangent);
+            auto* destShorts = (short*)dest;
+            destShorts[0] = ToSNorm16(encoded.x_);
+            destShorts[1] = ToSNorm16(encoded.y_);
+            destShorts[2] = 0;
+            destShorts[3] = ToSNorm16(w);
+            dest += 2;
+        }
+        else
+        {
+            *dest++ = tangent.x_;
+            *dest++ = tangent.y_;
+            *dest++ = tangent.z_;
+            *dest++ = w;
+        }
     }
 
     if (isSkinned)
@@ -2500,17 +2964,17 @@ PODVector<VertexElement> GetVertexElements(aiMesh* mesh, bool isSkinned)
     ret.Push(VertexElement(TYPE_VECTOR3, SEM_POSITION));
 
     if (mesh->HasNormals())
-        ret.Push(VertexElement(TYPE_VECTOR3, SEM_NORMAL));
+        ret.Push(VertexElement(octNormals_ ? TYPE_SHORT2_NORM : TYPE_VECTOR3, SEM_NORMAL));
 
     for (unsigned i = 0; i < mesh->GetNumColorChannels() && i < MAX_CHANNELS; ++i)
         ret.Push(VertexElement(TYPE_UBYTE4_NORM, SEM_COLOR, i));
 
     /// \todo Assimp mesh structure can specify 3D UV-coords. How to determine the difference? For now always treated as 2D.
     for (unsigned i = 0; i < mesh->GetNumUVChannels() && i < MAX_CHANNELS; ++i)
-        ret.Push(VertexElement(TYPE_VECTOR2, SEM_TEXCOORD, i));
+        ret.Push(VertexElement(halfTexCoords_ ? TYPE_HALF2 : TYPE_VECTOR2, SEM_TEXCOORD, i));
 
     if (mesh->HasTangentsAndBitangents())
-        ret.Push(VertexElement(TYPE_VECTOR4, SEM_TANGENT));
+        ret.Push(VertexElement(octNormals_ ? TYPE_SHORT4_NORM : TYPE_VECTOR4, SEM_TANGENT));
 
     if (isSkinned)
     {
@@ -2521,6 +2985,21 @@ PODVector<VertexElement> GetVertexElements(aiMesh* mesh, bool isSkinned)
     return ret;
 }
 
+Vector2 EncodeOctNormal(const Vector3& normal)
+{
+    // Project onto the octahedron, then fold the lower hemisphere over the diagonals
+    Vector3 n = normal / (Abs(normal.x_) + Abs(normal.y_) + Abs(normal.z_) + M_EPSILON);
+    if (n.z_ >= 0.0f)
+        return Vector2(n.x_, n.y_);
+
+    return Vector2((1.0f - Abs(n.y_)) * (n.x_ >= 0.0f ? 1.0f : -1.0f), (1.0f - Abs(n.x_)) * (n.y_ >= 0.0f ? 1.0f : -1.0f));
+}
+
+short ToSNorm16(float value)
+{
+    return (short)RoundToInt(Clamp(value, -1.0f, 1.0f) * 32767.0f);
+}
+
 aiNode* GetNode(const String& name, aiNode* rootNode, bool caseSensitive)
 {
     if (!rootNode)
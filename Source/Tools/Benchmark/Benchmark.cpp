@@ -0,0 +1,786 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <Urho3D/Container/Sort.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/Graphics/Batch.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Math/MathKernels.h>
+#include <Urho3D/Math/Random.h>
+#include <Urho3D/Resource/JSONFile.h>
+#include <Urho3D/Scene/Scene.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+static const unsigned DEFAULT_SAMPLES = 10;
+static const unsigned DEFAULT_SEED = 1;
+/// Element count of the container, string, variant, math, sorting and serializer fixtures.
+static const unsigned NUM_ELEMENTS = 10000;
+/// Number of keys in the variant map fixture, which is about the size of a typical event data map.
+static const unsigned NUM_VARIANT_MAP_KEYS = 16;
+/// Number of drawables in the octree fixture.
+static const unsigned NUM_DRAWABLES = 10000;
+/// Half size of the area the octree fixture drawables are scattered in.
+static const float DRAWABLE_AREA_EXTENT = 500.0f;
+/// Number of box, frustum and ray queries per octree benchmark run.
+static const unsigned NUM_QUERIES = 100;
+/// Number of elements processed by the work queue parallel for benchmark.
+static const unsigned NUM_WORK_ELEMENTS = 1000000;
+/// Number of individual items queued by the work queue dispatch benchmark.
+static const unsigned NUM_WORK_ITEMS = 1000;
+
+/// Data shared by the benchmarks. Generated once from the random seed, so that the same seed gives the same workload on every run.
+struct Fixture
+{
+    SharedPtr<Context> context_;
+    SharedPtr<Scene> scene_;
+    SharedPtr<Model> model_;
+    Octree* octree_{};
+    WorkQueue* workQueue_{};
+    Vector<String> strings_;
+    PODVector<StringHash> hashes_;
+    PODVector<unsigned> values_;
+    HashMap<StringHash, unsigned> hashMap_;
+    String text_;
+    PODVector<StringHash> variantMapKeys_;
+    VariantMap variantMap_;
+    PODVector<Vector3> points_;
+    PODVector<Vector3> transformedPoints_;
+    PODVector<Matrix3x4> matrices_;
+    PODVector<Matrix3x4> multipliedMatrices_;
+    PODVector<BoundingBox> boxes_;
+    PODVector<BoundingBox> transformedBoxes_;
+    PODVector<BoundingBox> queryBoxes_;
+    Vector<Frustum> queryFrustums_;
+    PODVector<Ray> queryRays_;
+    PODVector<Drawable*> drawableResult_;
+    PODVector<RayQueryResult> rayResult_;
+    BatchQueue batchQueue_;
+    PODVector<unsigned> workData_;
+    VectorBuffer buffer_;
+    VectorBuffer sceneBuffer_;
+    /// Accumulated results of the benchmarks, which keeps the compiler from optimizing the work away.
+    unsigned checksum_{};
+};
+
+/// Benchmark function. Performs the work once and returns the number of operations done, which the time is divided by.
+typedef unsigned (*BenchmarkFunction)(Fixture& fixture);
+
+/// Benchmark description.
+struct BenchmarkDesc
+{
+    const char* name_;
+    BenchmarkFunction function_;
+};
+
+/// Timing result of a benchmark.
+struct BenchmarkResult
+{
+    String name_;
+    unsigned operations_;
+    unsigned samples_;
+    long long minUSec_;
+    long long medianUSec_;
+    double meanUSec_;
+};
+
+int main(int argc, char** argv);
+void Run(const Vector<String>& arguments);
+void CreateFixture(Fixture& fixture, unsigned seed);
+BenchmarkResult RunBenchmark(const BenchmarkDesc& desc, Fixture& fixture, unsigned samples);
+String GetRandomString(unsigned minLength, unsigned maxLength);
+void WriteCSV(const Vector<BenchmarkResult>& results, Serializer* dest);
+void WriteJSON(const Vector<BenchmarkResult>& results, Context* context, unsigned seed, unsigned checksum, Serializer* dest);
+
+unsigned HashMapInsert(Fixture& fixture)
+{
+    HashMap<StringHash, unsigned> map;
+    for (unsigned i = 0; i < fixture.hashes_.Size(); ++i)
+        map[fixture.hashes_[i]] = i;
+    fixture.checksum_ += map.Size();
+    return fixture.hashes_.Size();
+}
+
+unsigned HashMapFind(Fixture& fixture)
+{
+    unsigned sum = 0;
+    for (unsigned i = 0; i < fixture.hashes_.Size(); ++i)
+    {
+        HashMap<StringHash, unsigned>::ConstIterator j = fixture.hashMap_.Find(fixture.hashes_[i]);
+        if (j != fixture.hashMap_.End())
+            sum += j->second_;
+    }
+    fixture.checksum_ += sum;
+    return fixture.hashes_.Size();
+}
+
+unsigned HashMapIterate(Fixture& fixture)
+{
+    unsigned sum = 0;
+    for (HashMap<StringHash, unsigned>::ConstIterator i = fixture.hashMap_.Begin(); i != fixture.hashMap_.End(); ++i)
+        sum += i->second_;
+    fixture.checksum_ += sum;
+    return fixture.hashMap_.Size();
+}
+
+unsigned HashMapErase(Fixture& fixture)
+{
+    HashMap<StringHash, unsigned> map = fixture.hashMap_;
+    for (unsigned i = 0; i < fixture.hashes_.Size(); ++i)
+        map.Erase(fixture.hashes_[i]);
+    fixture.checksum_ += map.Size();
+    return fixture.hashes_.Size();
+}
+
+unsigned VectorPush(Fixture& fixture)
+{
+    Vector<String> vector;
+    for (unsigned i = 0; i < fixture.strings_.Size(); ++i)
+        vector.Push(fixture.strings_[i]);
+    fixture.checksum_ += vector.Size();
+    return fixture.strings_.Size();
+}
+
+unsigned PODVectorPush(Fixture& fixture)
+{
+    PODVector<unsigned> vector;
+    for (unsigned i = 0; i < fixture.values_.Size(); ++i)
+        vector.Push(fixture.values_[i]);
+    fixture.checksum_ += vector.Size();
+    return fixture.values_.Size();
+}
+
+unsigned VectorSort(Fixture& fixture)
+{
+    PODVector<unsigned> vector = fixture.values_;
+    Sort(vector.Begin(), vector.End());
+    fixture.checksum_ += vector.Front();
+    return vector.Size();
+}
+
+unsigned StringAppend(Fixture& fixture)
+{
+    String result;
+    for (unsigned i = 0; i < fixture.strings_.Size(); ++i)
+        result += fixture.strings_[i];
+    fixture.checksum_ += result.Length();
+    return fixture.strings_.Size();
+}
+
+unsigned StringFind(Fixture& fixture)
+{
+    unsigned sum = 0;
+    for (unsigned i = 0; i < NUM_QUERIES; ++i)
+        sum += fixture.text_.Find(fixture.strings_[i]);
+    fixture.checksum_ += sum;
+    return NUM_QUERIES;
+}
+
+unsigned StringCompare(Fixture& fixture)
+{
+    unsigned sum = 0;
+    for (unsigned i = 1; i < fixture.strings_.Size(); ++i)
+        sum += fixture.strings_[i] < fixture.strings_[i - 1] ? 1 : 0;
+    fixture.checksum_ += sum;
+    return fixture.strings_.Size() - 1;
+}
+
+unsigned StringHashCalculate(Fixture& fixture)
+{
+    unsigned sum = 0;
+    for (unsigned i = 0; i < fixture.strings_.Size(); ++i)
+        sum += StringHash(fixture.strings_[i]).Value();
+    fixture.checksum_ += sum;
+    return fixture.strings_.Size();
+}
+
+unsigned VariantAssign(Fixture& fixture)
+{
+    Variant variant;
+    unsigned sum = 0;
+    for (unsigned i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        // Cycle through value types stored inline and on the heap
+        switch (i & 3u)
+        {
+        case 0:
+            variant = (int)fixture.values_[i];
+            sum += (unsigned)variant.GetInt();
+            break;
+
+        case 1:
+            variant = fixture.points_[i];
+            sum += (unsigned)variant.GetVector3().x_;
+            break;
+
+        case 2:
+            variant = fixture.strings_[i];
+            sum += variant.GetString().Length();
+            break;
+
+        default:
+            variant = fixture.matrices_[i];
+            sum += (unsigned)variant.GetMatrix3x4().m03_;
+            break;
+        }
+    }
+    fixture.checksum_ += sum;
+    return NUM_ELEMENTS;
+}
+
+unsigned VariantMapInsert(Fixture& fixture)
+{
+    for (unsigned i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        VariantMap map;
+        for (unsigned j = 0; j < NUM_VARIANT_MAP_KEYS; ++j)
+            map[fixture.variantMapKeys_[j]] = (int)j;
+        fixture.checksum_ += map.Size();
+    }
+    return NUM_ELEMENTS * NUM_VARIANT_MAP_KEYS;
+}
+
+unsigned VariantMapFind(Fixture& fixture)
+{
+    unsigned sum = 0;
+    for (unsigned i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        VariantMap::ConstIterator j = fixture.variantMap_.Find(fixture.variantMapKeys_[i % NUM_VARIANT_MAP_KEYS]);
+        if (j != fixture.variantMap_.End())
+            sum += (unsigned)j->second_.GetInt();
+    }
+    fixture.checksum_ += sum;
+    return NUM_ELEMENTS;
+}
+
+unsigned MathTransformPoints(Fixture& fixture)
+{
+    TransformPoints(fixture.matrices_[0], fixture.points_.Buffer(), fixture.transformedPoints_.Buffer(), fixture.points_.Size());
+    fixture.checksum_ += (unsigned)fixture.transformedPoints_.Back().x_;
+    return fixture.points_.Size();
+}
+
+unsigned MathMultiplyMatrices(Fixture& fixture)
+{
+    MultiplyMatrices(fixture.matrices_.Buffer(), fixture.matrices_.Buffer(), fixture.multipliedMatrices_.Buffer(),
+        fixture.matrices_.Size());
+    fixture.checksum_ += (unsigned)fixture.multipliedMatrices_.Back().m03_;
+    return fixture.matrices_.Size();
+}
+
+unsigned MathTransformBoundingBoxes(Fixture& fixture)
+{
+    TransformBoundingBoxes(fixture.matrices_.Buffer(), fixture.boxes_.Buffer(), fixture.transformedBoxes_.Buffer(),
+        fixture.boxes_.Size());
+    fixture.checksum_ += (unsigned)fixture.transformedBoxes_.Back().max_.x_;
+    return fixture.boxes_.Size();
+}
+
+unsigned MathFrustumIsInside(Fixture& fixture)
+{
+    const Frustum& frustum = fixture.queryFrustums_[0];
+    unsigned sum = 0;
+    for (unsigned i = 0; i < fixture.boxes_.Size(); ++i)
+        sum += frustum.IsInsideFast(fixture.boxes_[i]) != OUTSIDE ? 1 : 0;
+    fixture.checksum_ += sum;
+    return fixture.boxes_.Size();
+}
+
+unsigned OctreeGetDrawablesBox(Fixture& fixture)
+{
+    for (unsigned i = 0; i < NUM_QUERIES; ++i)
+    {
+        BoxOctreeQuery query(fixture.drawableResult_, fixture.queryBoxes_[i], DRAWABLE_GEOMETRY);
+        fixture.octree_->GetDrawables(query);
+        fixture.checksum_ += fixture.drawableResult_.Size();
+    }
+    return NUM_QUERIES;
+}
+
+unsigned OctreeGetDrawablesFrustum(Fixture& fixture)
+{
+    for (unsigned i = 0; i < NUM_QUERIES; ++i)
+    {
+        FrustumOctreeQuery query(fixture.drawableResult_, fixture.queryFrustums_[i], DRAWABLE_GEOMETRY);
+        fixture.octree_->GetDrawables(query);
+        fixture.checksum_ += fixture.drawableResult_.Size();
+    }
+    return NUM_QUERIES;
+}
+
+unsigned OctreeRaycast(Fixture& fixture)
+{
+    for (unsigned i = 0; i < NUM_QUERIES; ++i)
+    {
+        RayOctreeQuery query(fixture.rayResult_, fixture.queryRays_[i], RAY_AABB, M_INFINITY, DRAWABLE_GEOMETRY);
+        fixture.octree_->Raycast(query);
+        fixture.checksum_ += fixture.rayResult_.Size();
+    }
+    return NUM_QUERIES;
+}
+
+unsigned OctreeRaycastSingle(Fixture& fixture)
+{
+    for (unsigned i = 0; i < NUM_QUERIES; ++i)
+    {
+        RayOctreeQuery query(fixture.rayResult_, fixture.queryRays_[i], RAY_AABB, M_INFINITY, DRAWABLE_GEOMETRY);
+        fixture.octree_->RaycastSingle(query);
+        fixture.checksum_ += fixture.rayResult_.Size();
+    }
+    return NUM_QUERIES;
+}
+
+unsigned BatchQueueSortBackToFront(Fixture& fixture)
+{
+    fixture.batchQueue_.SortBackToFront();
+    fixture.checksum_ += (unsigned)fixture.batchQueue_.sortedBatches_.Front()->distance_;
+    return fixture.batchQueue_.batches_.Size();
+}
+
+unsigned BatchQueueSortFrontToBack(Fixture& fixture)
+{
+    fixture.batchQueue_.SortFrontToBack();
+    fixture.checksum_ += (unsigned)fixture.batchQueue_.sortedBatches_.Front()->distance_;
+    return fixture.batchQueue_.batches_.Size();
+}
+
+void ScrambleWork(const WorkItem* item, unsigned /*threadIndex*/)
+{
+    auto* end = reinterpret_cast<unsigned*>(item->end_);
+    for (auto* i = reinterpret_cast<unsigned*>(item->start_); i != end; ++i)
+        *i = *i * 1664525u + 1013904223u;
+}
+
+unsigned WorkQueueParallelFor(Fixture& fixture)
+{
+    fixture.workQueue_->ParallelFor(fixture.workData_.Begin().ptr_, fixture.workData_.End().ptr_, ScrambleWork, nullptr, 1024);
+    fixture.checksum_ += fixture.workData_.Back();
+    return fixture.workData_.Size();
+}
+
+unsigned WorkQueueDispatch(Fixture& fixture)
+{
+    // Many small items, so that the time is dominated by queueing and dispatching them
+    unsigned elementsPerItem = fixture.workData_.Size() / NUM_WORK_ITEMS;
+    for (unsigned i = 0; i < NUM_WORK_ITEMS; ++i)
+    {
+        SharedPtr<WorkItem> item = fixture.workQueue_->GetFreeItem();
+        item->priority_ = M_MAX_UNSIGNED;
+        item->workFunction_ = ScrambleWork;
+        item->start_ = &fixture.workData_[i * elementsPerItem];
+        item->end_ = &fixture.workData_[i * elementsPerItem] + elementsPerItem;
+        fixture.workQueue_->AddWorkItem(item);
+    }
+    fixture.workQueue_->Complete(M_MAX_UNSIGNED);
+    fixture.checksum_ += fixture.workData_.Front();
+    return NUM_WORK_ITEMS;
+}
+
+unsigned SerializerWrite(Fixture& fixture)
+{
+    fixture.buffer_.Clear();
+    for (unsigned i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        fixture.buffer_.WriteUInt(fixture.values_[i]);
+        fixture.buffer_.WriteVector3(fixture.points_[i]);
+        fixture.buffer_.WriteString(fixture.strings_[i]);
+    }
+    fixture.checksum_ += fixture.buffer_.GetSize();
+    return NUM_ELEMENTS;
+}
+
+unsigned SerializerRead(Fixture& fixture)
+{
+    MemoryBuffer source(fixture.buffer_.GetBuffer());
+    unsigned sum = 0;
+    for (unsigned i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        sum += source.ReadUInt();
+        sum += (unsigned)source.ReadVector3().y_;
+        sum += source.ReadString().Length();
+    }
+    fixture.checksum_ += sum;
+    return NUM_ELEMENTS;
+}
+
+unsigned SerializerVariantMap(Fixture& fixture)
+{
+    VectorBuffer buffer;
+    for (unsigned i = 0; i < NUM_ELEMENTS / NUM_VARIANT_MAP_KEYS; ++i)
+        buffer.WriteVariantMap(fixture.variantMap_);
+    buffer.Seek(0);
+    while (!buffer.IsEof())
+        fixture.checksum_ += buffer.ReadVariantMap().Size();
+    return NUM_ELEMENTS / NUM_VARIANT_MAP_KEYS;
+}
+
+unsigned SerializerSceneSave(Fixture& fixture)
+{
+    fixture.sceneBuffer_.Clear();
+    fixture.scene_->Save(fixture.sceneBuffer_);
+    fixture.checksum_ += fixture.sceneBuffer_.GetSize();
+    return NUM_DRAWABLES;
+}
+
+static const BenchmarkDesc benchmarks[] = {
+    {"HashMapInsert", HashMapInsert},
+    {"HashMapFind", HashMapFind},
+    {"HashMapIterate", HashMapIterate},
+    {"HashMapErase", HashMapErase},
+    {"VectorPush", VectorPush},
+    {"PODVectorPush", PODVectorPush},
+    {"VectorSort", VectorSort},
+    {"StringAppend", StringAppend},
+    {"StringFind", StringFind},
+    {"StringCompare", StringCompare},
+    {"StringHash", StringHashCalculate},
+    {"VariantAssign", VariantAssign},
+    {"VariantMapInsert", VariantMapInsert},
+    {"VariantMapFind", VariantMapFind},
+    {"MathTransformPoints", MathTransformPoints},
+    {"MathMultiplyMatrices", MathMultiplyMatrices},
+    {"MathTransformBoundingBoxes", MathTransformBoundingBoxes},
+    {"MathFrustumIsInside", MathFrustumIsInside},
+    {"OctreeGetDrawablesBox", OctreeGetDrawablesBox},
+    {"OctreeGetDrawablesFrustum", OctreeGetDrawablesFrustum},
+    {"OctreeRaycast", OctreeRaycast},
+    {"OctreeRaycastSingle", OctreeRaycastSingle},
+    {"BatchQueueSortBackToFront", BatchQueueSortBackToFront},
+    {"BatchQueueSortFrontToBack", BatchQueueSortFrontToBack},
+    {"WorkQueueParallelFor", WorkQueueParallelFor},
+    {"WorkQueueDispatch", WorkQueueDispatch},
+    {"SerializerWrite", SerializerWrite},
+    {"SerializerRead", SerializerRead},
+    {"SerializerVariantMap", SerializerVariantMap},
+    {"SerializerSceneSave", SerializerSceneSave},
+};
+
+int main(int argc, char** argv)
+{
+    Vector<String> arguments;
+
+    #ifdef WIN32
+    arguments = ParseArguments(GetCommandLineW());
+    #else
+    arguments = ParseArguments(argc, argv);
+    #endif
+
+    Run(arguments);
+    return 0;
+}
+
+void Run(const Vector<String>& arguments)
+{
+    unsigned samples = DEFAULT_SAMPLES;
+    unsigned seed = DEFAULT_SEED;
+    unsigned numThreads = GetNumLogicalCPUs() - 1;
+    bool json = false;
+    bool list = false;
+    String filter;
+    String outputFile;
+
+    for (unsigned i = 0; i < arguments.Size(); ++i)
+    {
+        const String& arg = arguments[i];
+        bool hasValue = i + 1 < arguments.Size();
+
+        if (arg == "-n" && hasValue)
+            samples = Max(ToUInt(arguments[++i]), 1U);
+        else if (arg == "-b" && hasValue)
+            filter = arguments[++i];
+        else if (arg == "-s" && hasValue)
+            seed = ToUInt(arguments[++i]);
+        else if (arg == "-t" && hasValue)
+            numThreads = ToUInt(arguments[++i]);
+        else if (arg == "-f" && hasValue)
+        {
+            String format = arguments[++i].ToLower();
+            if (format == "json")
+                json = true;
+            else if (format != "csv")
+                ErrorExit("Unknown output format " + format);
+        }
+        else if (arg == "-o" && hasValue)
+            outputFile = arguments[++i];
+        else if (arg == "-l")
+            list = true;
+        else
+        {
+            ErrorExit(
+                "Usage: Benchmark [options]\n"
+                "\n"
+                "Times the engine core hot paths on fixtures generated from a fixed random seed, and writes\n"
+                "the shortest, median and mean time of each benchmark as CSV or JSON.\n"
+                "\n"
+                "Options:\n"
+                "-n <num>    Number of timed samples per benchmark. Default 10\n"
+                "-b <name>   Run only the benchmarks whose name contains the given string\n"
+                "-s <seed>   Random seed of the fixtures. Default 1\n"
+                "-t <num>    Number of worker threads. Default is the number of logical CPUs minus one\n"
+                "-f <format> Output format, csv or json. Default csv\n"
+                "-o <file>   Write the results to a file instead of the standard output\n"
+                "-l          List the benchmarks and exit\n"
+            );
+        }
+    }
+
+    const unsigned numBenchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+    if (list)
+    {
+        for (unsigned i = 0; i < numBenchmarks; ++i)
+            PrintLine(benchmarks[i].name_);
+        return;
+    }
+
+    Fixture fixture;
+    fixture.context_ = new Context();
+    SharedPtr<Engine> engine(new Engine(fixture.context_));
+
+    auto* log = fixture.context_->GetSubsystem<Log>();
+    // Register Log subsystem manually if compiled without logging support
+    if (!log)
+    {
+        fixture.context_->RegisterSubsystem(new Log(fixture.context_));
+        log = fixture.context_->GetSubsystem<Log>();
+    }
+
+    // Keep the standard output for the results
+    log->SetLevel(LOG_WARNING);
+    log->SetTimeStamp(false);
+
+    fixture.workQueue_ = fixture.context_->GetSubsystem<WorkQueue>();
+    if (numThreads)
+        fixture.workQueue_->CreateThreads(numThreads);
+
+    CreateFixture(fixture, seed);
+
+    Vector<BenchmarkResult> results;
+    for (unsigned i = 0; i < numBenchmarks; ++i)
+    {
+        if (filter.Empty() || String(benchmarks[i].name_).Contains(filter, false))
+            results.Push(RunBenchmark(benchmarks[i], fixture, samples));
+    }
+
+    SharedPtr<File> output;
+    if (!outputFile.Empty())
+    {
+        output = new File(fixture.context_, outputFile, FILE_WRITE);
+        if (!output->IsOpen())
+            ErrorExit("Failed to open output file " + outputFile);
+    }
+
+    if (json)
+        WriteJSON(results, fixture.context_, seed, fixture.checksum_, output);
+    else
+        WriteCSV(results, output);
+
+    // Release the scene and fixtures before the context
+    fixture.scene_.Reset();
+    fixture.model_.Reset();
+}
+
+void CreateFixture(Fixture& fixture, unsigned seed)
+{
+    SetRandomSeed(seed);
+
+    for (unsigned i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        fixture.strings_.Push(GetRandomString(4, 64));
+        fixture.hashes_.Push(StringHash(fixture.strings_.Back()));
+        fixture.values_.Push((unsigned)Rand() << 16u | (unsigned)Rand());
+        fixture.hashMap_[fixture.hashes_.Back()] = i;
+
+        fixture.points_.Push(Vector3(Random(-100.0f, 100.0f), Random(-100.0f, 100.0f), Random(-100.0f, 100.0f)));
+        fixture.matrices_.Push(Matrix3x4(fixture.points_.Back(),
+            Quaternion(Random(360.0f), Random(360.0f), Random(360.0f)), Random(0.5f, 2.0f)));
+        fixture.boxes_.Push(BoundingBox(fixture.points_.Back() - Vector3::ONE, fixture.points_.Back() + Vector3::ONE));
+    }
+    fixture.transformedPoints_.Resize(NUM_ELEMENTS);
+    fixture.multipliedMatrices_.Resize(NUM_ELEMENTS);
+    fixture.transformedBoxes_.Resize(NUM_ELEMENTS);
+
+    // Long text for the substring searches, which contains the searched strings towards its end
+    for (unsigned i = NUM_ELEMENTS - 1; i < NUM_ELEMENTS; --i)
+        fixture.text_ += fixture.strings_[i];
+
+    for (unsigned i = 0; i < NUM_VARIANT_MAP_KEYS; ++i)
+    {
+        fixture.variantMapKeys_.Push(StringHash(GetRandomString(4, 16)));
+        fixture.variantMap_[fixture.variantMapKeys_.Back()] = (int)i;
+    }
+
+    // Scene of unit box drawables scattered in an octree. The model only has a bounding box, which is all the
+    // queries need, so no graphics subsystem or resources are required
+    fixture.model_ = new Model(fixture.context_);
+    fixture.model_->SetBoundingBox(BoundingBox(-0.5f, 0.5f));
+    fixture.scene_ = new Scene(fixture.context_);
+    fixture.octree_ = fixture.scene_->CreateComponent<Octree>();
+    for (unsigned i = 0; i < NUM_DRAWABLES; ++i)
+    {
+        Node* node = fixture.scene_->CreateChild("Box");
+        node->SetPosition(Vector3(Random(-DRAWABLE_AREA_EXTENT, DRAWABLE_AREA_EXTENT), Random(-10.0f, 10.0f),
+            Random(-DRAWABLE_AREA_EXTENT, DRAWABLE_AREA_EXTENT)));
+        node->SetScale(Random(1.0f, 5.0f));
+        auto* model = node->CreateComponent<StaticModel>();
+        model->SetModel(fixture.model_);
+    }
+    FrameInfo frame{};
+    fixture.octree_->Update(frame);
+
+    for (unsigned i = 0; i < NUM_QUERIES; ++i)
+    {
+        Vector3 center(Random(-DRAWABLE_AREA_EXTENT, DRAWABLE_AREA_EXTENT), 0.0f, Random(-DRAWABLE_AREA_EXTENT, DRAWABLE_AREA_EXTENT));
+        fixture.queryBoxes_.Push(BoundingBox(center - Vector3(25.0f, 25.0f, 25.0f), center + Vector3(25.0f, 25.0f, 25.0f)));
+
+        Frustum frustum;
+        frustum.Define(45.0f, 16.0f / 9.0f, 1.0f, 0.1f, 300.0f, Matrix3x4(Vector3(center.x_, 5.0f, center.z_),
+            Quaternion(0.0f, Random(360.0f), 0.0f), 1.0f));
+        fixture.queryFrustums_.Push(frustum);
+
+        fixture.queryRays_.Push(Ray(Vector3(center.x_, 0.0f, center.z_), Quaternion(0.0f, Random(360.0f), 0.0f) * Vector3::FORWARD));
+    }
+
+    // Batches with a handful of distinct states, as in a typical scene
+    fixture.batchQueue_.batches_.Resize(NUM_ELEMENTS);
+    for (unsigned i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        Batch& batch = fixture.batchQueue_.batches_[i];
+        batch.sortKey_ = ((unsigned long long)Random(32) << 48u) | ((unsigned long long)Random(64) << 16u) | (unsigned long long)Random(256);
+        batch.distance_ = Random(0.1f, 1000.0f);
+    }
+    fixture.batchQueue_.maxSortedInstances_ = 1000;
+
+    fixture.workData_.Resize(NUM_WORK_ELEMENTS);
+    for (unsigned i = 0; i < NUM_WORK_ELEMENTS; ++i)
+        fixture.workData_[i] = i;
+
+    // Fill the buffer read by the serializer read benchmark
+    SerializerWrite(fixture);
+}
+
+BenchmarkResult RunBenchmark(const BenchmarkDesc& desc, Fixture& fixture, unsigned samples)
+{
+    // Run once untimed to warm up the caches and let the containers reach their working sizes
+    BenchmarkResult result;
+    result.name_ = desc.name_;
+    result.operations_ = desc.function_(fixture);
+    result.samples_ = samples;
+
+    PODVector<long long> times;
+    HiresTimer timer;
+    for (unsigned i = 0; i < samples; ++i)
+    {
+        timer.Reset();
+        desc.function_(fixture);
+        times.Push(timer.GetUSec(false));
+    }
+
+    Sort(times.Begin(), times.End());
+    long long total = 0;
+    for (unsigned i = 0; i < times.Size(); ++i)
+        total += times[i];
+
+    result.minUSec_ = times.Front();
+    result.medianUSec_ = times[times.Size() / 2];
+    result.meanUSec_ = (double)total / (double)times.Size();
+    return result;
+}
+
+String GetRandomString(unsigned minLength, unsigned maxLength)
+{
+    static const char characters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_";
+
+    String result;
+    auto length = (unsigned)Random((int)minLength, (int)maxLength + 1);
+    for (unsigned i = 0; i < length; ++i)
+        result += characters[Rand() % (sizeof(characters) - 1)];
+    return result;
+}
+
+void WriteCSV(const Vector<BenchmarkResult>& results, Serializer* dest)
+{
+    Vector<String> lines;
+    lines.Push("name,operations,samples,min_us,median_us,mean_us,median_ns_per_op");
+    for (unsigned i = 0; i < results.Size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        lines.Push(result.name_ + "," + String(result.operations_) + "," + String(result.samples_) + "," +
+            String(result.minUSec_) + "," + String(result.medianUSec_) + "," + String(result.meanUSec_) + "," +
+            String(result.medianUSec_ * 1000.0 / Max(result.operations_, 1U)));
+    }
+
+    for (unsigned i = 0; i < lines.Size(); ++i)
+    {
+        if (dest)
+            dest->WriteLine(lines[i]);
+        else
+            PrintLine(lines[i]);
+    }
+}
+
+void WriteJSON(const Vector<BenchmarkResult>& results, Context* context, unsigned seed, unsigned checksum, Serializer* dest)
+{
+    SharedPtr<JSONFile> file(new JSONFile(context));
+    JSONValue& root = file->GetRoot();
+    root.Set("seed", seed);
+    // The checksum of the benchmark results only depends on the seed and the options, so it tells whether two runs did the same work
+    root.Set("checksum", checksum);
+
+    JSONValue benchmarkArray;
+    for (unsigned i = 0; i < results.Size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        JSONValue benchmark;
+        benchmark.Set("name", result.name_);
+        benchmark.Set("operations", result.operations_);
+        benchmark.Set("samples", result.samples_);
+        benchmark.Set("minUSec", (double)result.minUSec_);
+        benchmark.Set("medianUSec", (double)result.medianUSec_);
+        benchmark.Set("meanUSec", result.meanUSec_);
+        benchmark.Set("medianNSecPerOp", result.medianUSec_ * 1000.0 / Max(result.operations_, 1U));
+        benchmarkArray.Push(benchmark);
+    }
+    root.Set("benchmarks", benchmarkArray);
+
+    if (dest)
+        file->Save(*dest, "  ");
+    else
+        PrintLine(file->ToString("  "));
+}
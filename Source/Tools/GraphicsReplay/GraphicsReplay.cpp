@@ -0,0 +1,213 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <Urho3D/Container/Sort.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/Engine/EngineDefs.h>
+#include <Urho3D/Graphics/Graphics.h>
+#include <Urho3D/Graphics/GraphicsCapture.h>
+#include <Urho3D/Input/Input.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/Log.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+static const unsigned DEFAULT_PASSES = 10;
+/// Number of untimed passes over the capture, which create the pipeline states and let the GPU clocks settle.
+static const unsigned WARMUP_PASSES = 2;
+
+/// Timing statistics of the replayed frames.
+struct ReplayStatistics
+{
+    long long minUSec_{};
+    long long medianUSec_{};
+    double meanUSec_{};
+};
+
+int main(int argc, char** argv);
+void Run(const Vector<String>& arguments);
+ReplayStatistics GetStatistics(PODVector<long long> times);
+
+int main(int argc, char** argv)
+{
+    Vector<String> arguments;
+
+    #ifdef WIN32
+    arguments = ParseArguments(GetCommandLineW());
+    #else
+    arguments = ParseArguments(argc, argv);
+    #endif
+
+    Run(arguments);
+    return 0;
+}
+
+void Run(const Vector<String>& arguments)
+{
+    unsigned passes = DEFAULT_PASSES;
+    String captureFile;
+    String resourcePaths = "Data;CoreData";
+    String resourcePrefixPaths;
+    bool usage = false;
+
+    for (unsigned i = 0; i < arguments.Size(); ++i)
+    {
+        const String& arg = arguments[i];
+        bool hasValue = i + 1 < arguments.Size();
+
+        if (arg == "-n" && hasValue)
+            passes = Max(ToUInt(arguments[++i]), 1U);
+        else if (arg == "-p" && hasValue)
+            resourcePaths = arguments[++i];
+        else if (arg == "-pp" && hasValue)
+            resourcePrefixPaths = arguments[++i];
+        else if (captureFile.Empty() && !arg.StartsWith("-"))
+            captureFile = arg;
+        else
+            usage = true;
+    }
+
+    if (usage || captureFile.Empty())
+    {
+        ErrorExit(
+            "Usage: GraphicsReplay <capture file> [options]\n"
+            "\n"
+            "Replays a graphics command capture written by Graphics::BeginCapture() and prints the shortest,\n"
+            "median and mean CPU submission time and GPU time of the captured frames. The capture references\n"
+            "shaders and textures by resource name, so the resource paths should match the captured application.\n"
+            "\n"
+            "Options:\n"
+            "-n <num>    Number of timed passes over the captured frames. Default 10\n"
+            "-p <paths>  Resource paths separated by semicolons. Default Data;CoreData\n"
+            "-pp <paths> Resource prefix paths separated by semicolons\n"
+        );
+    }
+
+    SharedPtr<Context> context(new Context());
+    SharedPtr<Engine> engine(new Engine(context));
+
+    SharedPtr<File> file(new File(context, captureFile));
+    if (!file->IsOpen())
+        ErrorExit("Failed to open capture file " + captureFile);
+
+    SharedPtr<GraphicsReplay> replay(new GraphicsReplay(context));
+    if (!replay->Load(*file))
+        ErrorExit("Failed to load capture file " + captureFile);
+    file.Reset();
+
+    // Replay at the captured backbuffer size, without vsync or the frame limiter so that only the submission is timed
+    VariantMap engineParameters;
+    engineParameters[EP_WINDOW_WIDTH] = replay->GetWidth();
+    engineParameters[EP_WINDOW_HEIGHT] = replay->GetHeight();
+    engineParameters[EP_FULL_SCREEN] = false;
+    engineParameters[EP_VSYNC] = false;
+    engineParameters[EP_FRAME_LIMITER] = false;
+    engineParameters[EP_SOUND] = false;
+    engineParameters[EP_WINDOW_TITLE] = "GraphicsReplay";
+    engineParameters[EP_RESOURCE_PATHS] = resourcePaths;
+    if (!resourcePrefixPaths.Empty())
+        engineParameters[EP_RESOURCE_PREFIX_PATHS] = resourcePrefixPaths;
+    engineParameters[EP_LOG_LEVEL] = LOG_WARNING;
+    if (!engine->Initialize(engineParameters))
+        ErrorExit("Failed to initialize the engine");
+
+    auto* graphics = context->GetSubsystem<Graphics>();
+    auto* input = context->GetSubsystem<Input>();
+    graphics->SetGPUProfiling(true);
+
+    const unsigned numFrames = replay->GetNumFrames();
+    PODVector<long long> cpuTimes;
+    PODVector<long long> gpuTimes;
+    unsigned numDraws = 0;
+    HiresTimer timer;
+
+    for (unsigned pass = 0; pass < WARMUP_PASSES + passes; ++pass)
+    {
+        for (unsigned i = 0; i < numFrames; ++i)
+        {
+            // Keep the window responsive
+            input->Update();
+            if (engine->IsExiting())
+                return;
+
+            timer.Reset();
+            if (!replay->ReplayFrame())
+                ErrorExit("Failed to replay frame " + String(i) + " of " + captureFile);
+
+            if (pass < WARMUP_PASSES)
+                continue;
+
+            cpuTimes.Push(timer.GetUSec(false));
+            numDraws += replay->GetNumDraws();
+            // GPU timings are read back a few frames late, so they lag behind the replayed frame
+            long long gpuTime = graphics->GetGPUFrameTime();
+            if (gpuTime > 0)
+                gpuTimes.Push(gpuTime);
+        }
+    }
+
+    ReplayStatistics cpu = GetStatistics(cpuTimes);
+    PrintLine("Capture " + captureFile + ": " + String(numFrames) + " frames at " + String(replay->GetWidth()) + "x" +
+        String(replay->GetHeight()) + ", " + String(numDraws / cpuTimes.Size()) + " draws per frame");
+    PrintLine("CPU submission min " + String(cpu.minUSec_) + " us, median " + String(cpu.medianUSec_) + " us, mean " +
+        String(cpu.meanUSec_) + " us");
+
+    if (!gpuTimes.Empty())
+    {
+        ReplayStatistics gpu = GetStatistics(gpuTimes);
+        PrintLine("GPU frame min " + String(gpu.minUSec_) + " us, median " + String(gpu.medianUSec_) + " us, mean " +
+            String(gpu.meanUSec_) + " us");
+    }
+    else
+        PrintLine("GPU timing is not supported by the graphics device");
+
+    // Release the replayed resources before the graphics subsystem
+    replay.Reset();
+}
+
+ReplayStatistics GetStatistics(PODVector<long long> times)
+{
+    ReplayStatistics result;
+    if (times.Empty())
+        return result;
+
+    Sort(times.Begin(), times.End());
+    long long total = 0;
+    for (unsigned i = 0; i < times.Size(); ++i)
+        total += times[i];
+
+    result.minUSec_ = times.Front();
+    result.medianUSec_ = times[times.Size() / 2];
+    result.meanUSec_ = (double)total / (double)times.Size();
+    return result;
+}
@@ -0,0 +1,340 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Container/Sort.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Network/Connection.h>
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+static const unsigned short DEFAULT_PORT = 2345;
+static const unsigned DEFAULT_CLIENTS = 16;
+static const unsigned DEFAULT_NODES = 500;
+static const float DEFAULT_DURATION = 30.0f;
+/// Spacing of the moving nodes, which are laid out in a square grid.
+static const float NODE_SPACING = 5.0f;
+/// Node variable carrying the server time in milliseconds, from which the replication latency is measured.
+static const StringHash VAR_SENT_TIME("SentTime");
+
+/// Simulated client. Each has its own context, as a Network subsystem has only one server connection.
+struct SimulatedClient
+{
+    SharedPtr<Context> context_;
+    SharedPtr<Scene> scene_;
+    Network* network_{};
+    double lastSentTime_{-1.0};
+};
+
+int main(int argc, char** argv);
+void Run(const Vector<String>& arguments);
+void CreateClient(SimulatedClient& client, unsigned short port, int latencyMs, float packetLoss);
+float GetPercentile(const PODVector<float>& sortedValues, float percentile);
+
+int main(int argc, char** argv)
+{
+    Vector<String> arguments;
+
+    #ifdef WIN32
+    arguments = ParseArguments(GetCommandLineW());
+    #else
+    arguments = ParseArguments(argc, argv);
+    #endif
+
+    Run(arguments);
+    return 0;
+}
+
+void Run(const Vector<String>& arguments)
+{
+    unsigned numClients = DEFAULT_CLIENTS;
+    unsigned numNodes = DEFAULT_NODES;
+    float duration = DEFAULT_DURATION;
+    int updateFps = 30;
+    int latencyMs = 0;
+    float packetLoss = 0.0f;
+    float interestRadius = 0.0f;
+    unsigned bandwidthLimit = 0;
+    unsigned short port = DEFAULT_PORT;
+    bool parallel = false;
+    String outputFile;
+
+    for (unsigned i = 0; i < arguments.Size(); ++i)
+    {
+        const String& arg = arguments[i];
+        bool hasValue = i + 1 < arguments.Size();
+
+        if (arg == "-c" && hasValue)
+            numClients = Max(ToUInt(arguments[++i]), 1U);
+        else if (arg == "-n" && hasValue)
+            numNodes = ToUInt(arguments[++i]);
+        else if (arg == "-d" && hasValue)
+            duration = ToFloat(arguments[++i]);
+        else if (arg == "-f" && hasValue)
+            updateFps = ToInt(arguments[++i]);
+        else if (arg == "-l" && hasValue)
+            latencyMs = ToInt(arguments[++i]);
+        else if (arg == "-p" && hasValue)
+            packetLoss = ToFloat(arguments[++i]);
+        else if (arg == "-r" && hasValue)
+            interestRadius = ToFloat(arguments[++i]);
+        else if (arg == "-b" && hasValue)
+            bandwidthLimit = ToUInt(arguments[++i]);
+        else if (arg == "-port" && hasValue)
+            port = (unsigned short)ToUInt(arguments[++i]);
+        else if (arg == "-o" && hasValue)
+            outputFile = arguments[++i];
+        else if (arg == "-t")
+            parallel = true;
+        else
+        {
+            ErrorExit(
+                "Usage: NetworkLoadTest [options]\n"
+                "\n"
+                "Runs a server and simulated clients in one process over loopback and writes server tick\n"
+                "time, bytes sent per client and replication latency percentiles as CSV, one row per second.\n"
+                "\n"
+                "Options:\n"
+                "-c <num>    Number of simulated clients. Default 16\n"
+                "-n <num>    Number of moving replicated nodes. Default 500\n"
+                "-d <sec>    Test duration in seconds. Default 30\n"
+                "-f <fps>    Network update FPS. Default 30\n"
+                "-l <ms>     Simulated latency in milliseconds\n"
+                "-p <loss>   Simulated packet loss probability 0.0 - 1.0\n"
+                "-r <radius> Area of interest radius of the clients. Default 0 replicates all nodes\n"
+                "-b <bytes>  Replication bandwidth limit per client in bytes per second. Default unlimited\n"
+                "-t          Build the server updates in worker threads\n"
+                "-port <num> Server port. Default 2345\n"
+                "-o <file>   Write the CSV to a file instead of the standard output\n"
+            );
+        }
+    }
+
+    SharedPtr<Context> context(new Context());
+    SharedPtr<Engine> engine(new Engine(context));
+
+    auto* log = context->GetSubsystem<Log>();
+    // Register Log subsystem manually if compiled without logging support
+    if (!log)
+    {
+        context->RegisterSubsystem(new Log(context));
+        log = context->GetSubsystem<Log>();
+    }
+
+    // Keep the standard output for the CSV
+    log->SetLevel(LOG_WARNING);
+    log->SetTimeStamp(false);
+
+    auto* network = context->GetSubsystem<Network>();
+    network->SetUpdateFps(updateFps);
+    network->SetSimulatedLatency(latencyMs);
+    network->SetSimulatedPacketLoss(packetLoss);
+    if (parallel)
+    {
+        unsigned numThreads = GetNumLogicalCPUs();
+        if (numThreads > 1)
+            context->GetSubsystem<WorkQueue>()->CreateThreads(numThreads - 1);
+        network->SetParallelServerUpdate(true);
+    }
+
+    // The replicated nodes move in circles around their places in a square grid
+    SharedPtr<Scene> scene(new Scene(context));
+    if (interestRadius > 0.0f)
+        scene->SetInterestCellSize(interestRadius);
+    Node* clockNode = scene->CreateChild("Clock");
+    PODVector<Node*> nodes;
+    PODVector<Vector3> nodeCenters;
+    auto gridSize = (unsigned)ceilf(sqrtf((float)numNodes));
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        nodes.Push(scene->CreateChild("Node" + String(i)));
+        nodeCenters.Push(Vector3((float)(i % gridSize) - 0.5f * gridSize, 0.0f, (float)(i / gridSize) - 0.5f * gridSize) * NODE_SPACING);
+    }
+
+    if (!network->StartServer(port))
+        ErrorExit("Failed to start server on port " + String(port));
+
+    Vector<SimulatedClient> clients(numClients);
+    for (unsigned i = 0; i < numClients; ++i)
+        CreateClient(clients[i], port, latencyMs, packetLoss);
+
+    SharedPtr<File> output;
+    if (!outputFile.Empty())
+    {
+        output = new File(context, outputFile, FILE_WRITE);
+        if (!output->IsOpen())
+            ErrorExit("Failed to open output file " + outputFile);
+    }
+
+    String header = "time,clients,tick_ms_avg,tick_ms_max,bytes_out_per_client,latency_p50_ms,latency_p90_ms,latency_p99_ms";
+    if (output)
+        output->WriteLine(header);
+    else
+        PrintLine(header);
+
+    HiresTimer clock;
+    long long lastUSec = 0;
+    float nextReport = 1.0f;
+    PODVector<float> tickTimes;
+    PODVector<float> latencies;
+
+    for (;;)
+    {
+        long long usec = clock.GetUSec(false);
+        float time = (float)usec / 1000000.0f;
+        if (time >= duration)
+            break;
+        float timeStep = (float)(usec - lastUSec) / 1000000.0f;
+        lastUSec = usec;
+
+        for (unsigned i = 0; i < numNodes; ++i)
+        {
+            float angle = time * 90.0f + (float)i * 37.0f;
+            nodes[i]->SetPosition(nodeCenters[i] + Vector3(Cos(angle), 0.0f, Sin(angle)) * NODE_SPACING * 0.5f);
+        }
+        clockNode->SetVar(VAR_SENT_TIME, (double)usec / 1000.0);
+
+        network->Update(timeStep);
+
+        // Assign the newly connected clients to the scene
+        Vector<SharedPtr<Connection> > connections = network->GetClientConnections();
+        for (unsigned i = 0; i < connections.Size(); ++i)
+        {
+            Connection* connection = connections[i];
+            if (!connection->GetScene())
+            {
+                connection->SetInterestRadius(interestRadius);
+                connection->SetBandwidthLimit(bandwidthLimit);
+                connection->SetScene(scene);
+            }
+        }
+
+        unsigned tick = network->GetUpdateTick();
+        HiresTimer tickTimer;
+        network->PostUpdate(timeStep);
+        if (network->GetUpdateTick() != tick)
+            tickTimes.Push((float)tickTimer.GetUSec(false) / 1000.0f);
+
+        for (unsigned i = 0; i < numClients; ++i)
+        {
+            SimulatedClient& client = clients[i];
+            client.network_->Update(timeStep);
+            client.network_->PostUpdate(timeStep);
+
+            // Measure the latency whenever a new clock value has arrived
+            Node* clientClock = client.scene_->GetNode(clockNode->GetID());
+            if (clientClock)
+            {
+                double sentTime = clientClock->GetVar(VAR_SENT_TIME).GetDouble();
+                if (sentTime != client.lastSentTime_)
+                {
+                    latencies.Push((float)((double)clock.GetUSec(false) / 1000.0 - sentTime));
+                    client.lastSentTime_ = sentTime;
+                }
+            }
+        }
+
+        if (time >= nextReport)
+        {
+            unsigned numJoined = 0;
+            float bytesOut = 0.0f;
+            for (unsigned i = 0; i < connections.Size(); ++i)
+            {
+                if (connections[i]->IsSceneLoaded())
+                {
+                    ++numJoined;
+                    bytesOut += connections[i]->GetBytesOutPerSec();
+                }
+            }
+
+            float tickSum = 0.0f;
+            float tickMax = 0.0f;
+            for (unsigned i = 0; i < tickTimes.Size(); ++i)
+            {
+                tickSum += tickTimes[i];
+                tickMax = Max(tickMax, tickTimes[i]);
+            }
+            Sort(latencies.Begin(), latencies.End());
+
+            String row = String(nextReport) + "," + String(numJoined) + "," +
+                String(tickTimes.Size() ? tickSum / tickTimes.Size() : 0.0f) + "," + String(tickMax) + "," +
+                String(numJoined ? bytesOut / numJoined : 0.0f) + "," + String(GetPercentile(latencies, 0.5f)) + "," +
+                String(GetPercentile(latencies, 0.9f)) + "," + String(GetPercentile(latencies, 0.99f));
+            if (output)
+                output->WriteLine(row);
+            else
+                PrintLine(row);
+
+            tickTimes.Clear();
+            latencies.Clear();
+            nextReport += 1.0f;
+        }
+
+        Time::Sleep(1);
+    }
+
+    for (unsigned i = 0; i < numClients; ++i)
+        clients[i].network_->Disconnect();
+    network->StopServer();
+}
+
+void CreateClient(SimulatedClient& client, unsigned short port, int latencyMs, float packetLoss)
+{
+    // Only the subsystems the client connection and scene replication need
+    client.context_ = new Context();
+    client.context_->RegisterSubsystem(new FileSystem(client.context_));
+    client.context_->RegisterSubsystem(new ResourceCache(client.context_));
+    client.context_->RegisterSubsystem(new Network(client.context_));
+    RegisterSceneLibrary(client.context_);
+
+    client.scene_ = new Scene(client.context_);
+    client.network_ = client.context_->GetSubsystem<Network>();
+    client.network_->SetSimulatedLatency(latencyMs);
+    client.network_->SetSimulatedPacketLoss(packetLoss);
+    if (!client.network_->Connect("127.0.0.1", port, client.scene_))
+        ErrorExit("Failed to connect a simulated client");
+}
+
+float GetPercentile(const PODVector<float>& sortedValues, float percentile)
+{
+    if (sortedValues.Empty())
+        return 0.0f;
+
+    auto index = (unsigned)(percentile * (float)(sortedValues.Size() - 1) + 0.5f);
+    return sortedValues[index];
+}
@@ -20,12 +20,17 @@
 // THE SOFTWARE.
 //
 
+#include <Urho3D/Audio/Sound.h>
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Container/ArrayPtr.h>
 #include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/IO/PackageFile.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Resource/JSONFile.h>
+#include <Urho3D/Resource/XMLFile.h>
 
 #ifdef WIN32
 #include <windows.h>
@@ -46,14 +51,26 @@ struct FileEntry
     unsigned offset_{};
     unsigned size_{};
     unsigned checksum_{};
+    PODVector<unsigned char> compiledData_;
+};
+
+struct CompressBlock
+{
+    const unsigned char* source_{};
+    unsigned unpackedSize_{};
+    SharedArrayPtr<unsigned char> dest_;
+    unsigned packedSize_{};
 };
 
 SharedPtr<Context> context_(new Context());
 SharedPtr<FileSystem> fileSystem_(new FileSystem(context_));
+SharedPtr<WorkQueue> workQueue_;
 String basePath_;
 Vector<FileEntry> entries_;
 unsigned checksum_ = 0;
 bool compress_ = false;
+bool compileResources_ = false;
+bool compressSounds_ = false;
 bool quiet_ = false;
 unsigned blockSize_ = COMPRESSED_BLOCK_SIZE;
 
@@ -66,8 +83,11 @@ String ignoreExtensions_[] = {
 int main(int argc, char** argv);
 void Run(const Vector<String>& arguments);
 void ProcessFile(const String& fileName, const String& rootDir);
+void CompileFile(FileEntry& entry, File& file);
+void ConvertSound(FileEntry& entry, File& file);
 void WritePackageFile(const String& fileName, const String& rootDir);
 void WriteHeader(File& dest);
+void CompressBlockWork(const WorkItem* item, unsigned threadIndex);
 
 int main(int argc, char** argv)
 {
@@ -90,6 +110,8 @@ void Run(const Vector<String>& arguments)
             "Usage: PackageTool <directory to process> <package name> [basepath] [options]\n"
             "\n"
             "Options:\n"
+            "-a      Store uncompressed WAV files as IMA ADPCM compressed WAV files, which play from memory at a quarter of the size\n"
+            "-b      Store XML and JSON files in the compiled binary form, which loads without parsing text\n"
             "-c      Enable package file LZ4 compression\n"
             "-q      Enable quiet mode\n"
             "\n"
@@ -116,6 +138,12 @@ void Run(const Vector<String>& arguments)
                 {
                     switch (arguments[i][1])
                     {
+                    case 'a':
+                        compressSounds_ = true;
+                        break;
+                    case 'b':
+                        compileResources_ = true;
+                        break;
                     case 'c':
                         compress_ = true;
                         break;
@@ -135,6 +163,16 @@ void Run(const Vector<String>& arguments)
         if (!quiet_)
             PrintLine("Scanning directory " + dirName + " for files");
 
+        // Compress the blocks of each file in parallel
+        if (compress_)
+        {
+            workQueue_ = new WorkQueue(context_);
+#ifdef URHO3D_THREADING
+            if (GetNumLogicalCPUs() > 1)
+                workQueue_->CreateThreads(GetNumLogicalCPUs() - 1);
+#endif
+        }
+
         // Get the file list recursively
         Vector<String> fileNames;
         fileSystem_->ScanDir(fileNames, dirName, "*.*", SCAN_FILES, true);
@@ -172,6 +210,8 @@ void Run(const Vector<String>& arguments)
             PrintLine("Package size: " + String(packageFile->GetTotalSize()));
             PrintLine("Checksum: " + String(packageFile->GetChecksum()));
             PrintLine("Compressed: " + String(packageFile->IsCompressed() ? "yes" : "no"));
+            if (packageFile->GetBlockSize())
+                PrintLine("Block size: " + String(packageFile->GetBlockSize()));
             break;
         case 'L':
             if (!packageFile->IsCompressed())
@@ -217,9 +257,64 @@ void ProcessFile(const String& fileName, const String& rootDir)
     newEntry.offset_ = 0; // Offset not yet known
     newEntry.size_ = file.GetSize();
     newEntry.checksum_ = 0; // Will be calculated later
+
+    if (compileResources_)
+    {
+        String extension = GetExtension(fileName);
+        if (extension == ".xml" || extension == ".json")
+            CompileFile(newEntry, file);
+    }
+
+    if (compressSounds_ && GetExtension(fileName) == ".wav")
+        ConvertSound(newEntry, file);
+
     entries_.Push(newEntry);
 }
 
+void CompileFile(FileEntry& entry, File& file)
+{
+    VectorBuffer compiledData;
+    bool success;
+    if (GetExtension(entry.name_) == ".xml")
+    {
+        SharedPtr<XMLFile> xmlFile(new XMLFile(context_));
+        success = xmlFile->Load(file) && xmlFile->SaveBinary(compiledData);
+    }
+    else
+    {
+        SharedPtr<JSONFile> jsonFile(new JSONFile(context_));
+        success = jsonFile->Load(file) && jsonFile->SaveBinary(compiledData);
+    }
+
+    // Keep files that do not parse, or that can not be resolved without the resource cache, as text
+    if (!success)
+    {
+        if (!quiet_)
+            PrintLine("Could not compile " + entry.name_ + ", storing as text");
+        return;
+    }
+
+    entry.compiledData_ = compiledData.GetBuffer();
+    entry.size_ = entry.compiledData_.Size();
+}
+
+void ConvertSound(FileEntry& entry, File& file)
+{
+    // Already compressed files load as compressed, leave them as is
+    SharedPtr<Sound> sound(new Sound(context_));
+    VectorBuffer convertedData;
+    bool success = sound->LoadWav(file) && !sound->IsCompressed() && sound->SaveAdpcmWav(convertedData);
+    if (!success)
+    {
+        if (!quiet_)
+            PrintLine("Could not convert " + entry.name_ + " to ADPCM, storing as is");
+        return;
+    }
+
+    entry.compiledData_ = convertedData.GetBuffer();
+    entry.size_ = entry.compiledData_.Size();
+}
+
 void WritePackageFile(const String& fileName, const String& rootDir)
 {
     if (!quiet_)
@@ -250,17 +345,21 @@ void WritePackageFile(const String& fileName, const String& rootDir)
         lastOffset = entries_[i].offset_ = dest.GetSize();
         String fileFullPath = rootDir + "/" + entries_[i].name_;
 
-        File srcFile(context_, fileFullPath);
-        if (!srcFile.IsOpen())
-            ErrorExit("Could not open file " + fileFullPath);
-
         unsigned dataSize = entries_[i].size_;
         totalDataSize += dataSize;
         SharedArrayPtr<unsigned char> buffer(new unsigned char[dataSize]);
 
-        if (srcFile.Read(&buffer[0], dataSize) != dataSize)
-            ErrorExit("Could not read file " + fileFullPath);
-        srcFile.Close();
+        if (!entries_[i].compiledData_.Empty())
+            memcpy(&buffer[0], &entries_[i].compiledData_[0], dataSize);
+        else
+        {
+            File srcFile(context_, fileFullPath);
+            if (!srcFile.IsOpen())
+                ErrorExit("Could not open file " + fileFullPath);
+            if (srcFile.Read(&buffer[0], dataSize) != dataSize)
+                ErrorExit("Could not read file " + fileFullPath);
+            srcFile.Close();
+        }
 
         for (unsigned j = 0; j < dataSize; ++j)
         {
@@ -276,25 +375,41 @@ void WritePackageFile(const String& fileName, const String& rootDir)
         }
         else
         {
-            SharedArrayPtr<unsigned char> compressBuffer(new unsigned char[LZ4_compressBound(blockSize_)]);
-
-            unsigned pos = 0;
-
-            while (pos < dataSize)
+            unsigned numBlocks = (dataSize + blockSize_ - 1) / blockSize_;
+            Vector<CompressBlock> blocks(numBlocks);
+            for (unsigned j = 0; j < numBlocks; ++j)
             {
-                unsigned unpackedSize = blockSize_;
-                if (pos + unpackedSize > dataSize)
-                    unpackedSize = dataSize - pos;
+                CompressBlock& block = blocks[j];
+                block.source_ = &buffer[j * blockSize_];
+                block.unpackedSize_ = Min(blockSize_, dataSize - j * blockSize_);
+                block.dest_ = new unsigned char[LZ4_compressBound(block.unpackedSize_)];
+
+                SharedPtr<WorkItem> item = workQueue_->GetFreeItem();
+                item->workFunction_ = CompressBlockWork;
+                item->aux_ = &block;
+                item->priority_ = M_MAX_UNSIGNED;
+                workQueue_->AddWorkItem(item);
+            }
+            workQueue_->Complete(M_MAX_UNSIGNED);
 
-                auto packedSize = (unsigned)LZ4_compress_HC((const char*)&buffer[pos], (char*)compressBuffer.Get(), unpackedSize, LZ4_compressBound(unpackedSize), 0);
-                if (!packedSize)
-                    ErrorExit("LZ4 compression failed for file " + entries_[i].name_ + " at offset " + String(pos));
+            // Write the block offset table followed by the blocks
+            dest.WriteUInt(numBlocks);
+            unsigned blockOffset = (numBlocks + 2) * sizeof(unsigned);
+            for (unsigned j = 0; j < numBlocks; ++j)
+            {
+                if (!blocks[j].packedSize_)
+                    ErrorExit("LZ4 compression failed for file " + entries_[i].name_ + " at offset " + String(j * blockSize_));
 
-                dest.WriteUShort((unsigned short)unpackedSize);
-                dest.WriteUShort((unsigned short)packedSize);
-                dest.Write(compressBuffer.Get(), packedSize);
+                dest.WriteUInt(blockOffset);
+                blockOffset += 2 * sizeof(unsigned short) + blocks[j].packedSize_;
+            }
+            dest.WriteUInt(blockOffset);
 
-                pos += unpackedSize;
+            for (unsigned j = 0; j < numBlocks; ++j)
+            {
+                dest.WriteUShort((unsigned short)blocks[j].unpackedSize_);
+                dest.WriteUShort((unsigned short)blocks[j].packedSize_);
+                dest.Write(blocks[j].dest_.Get(), blocks[j].packedSize_);
             }
 
             if (!quiet_)
@@ -339,7 +454,16 @@ void WriteHeader(File& dest)
     if (!compress_)
         dest.WriteFileID("UPAK");
     else
-        dest.WriteFileID("ULZ4");
+        dest.WriteFileID("ULZB");
     dest.WriteUInt(entries_.Size());
     dest.WriteUInt(checksum_);
+    if (compress_)
+        dest.WriteUInt(blockSize_);
+}
+
+void CompressBlockWork(const WorkItem* item, unsigned /*threadIndex*/)
+{
+    auto* block = reinterpret_cast<CompressBlock*>(item->aux_);
+    block->packedSize_ = (unsigned)LZ4_compress_HC((const char*)block->source_, (char*)block->dest_.Get(), block->unpackedSize_,
+        LZ4_compressBound(block->unpackedSize_), 0);
 }
@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/Graphics/Graphics.h>
+#include <Urho3D/Graphics/ShaderVariation.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/XMLFile.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+void CollectShaders(Context* context, const String& fileName, PODVector<ShaderVariation*>& variations);
+
+int main(int argc, char** argv)
+{
+    #ifdef WIN32
+    const Vector<String>& arguments = ParseArguments(GetCommandLineW());
+    #else
+    const Vector<String>& arguments = ParseArguments(argc, argv);
+    #endif
+
+    if (arguments.Size() < 3)
+        ErrorExit("Usage: ShaderPrecompiler <output file> <device types> <shader list file> [shader list file] ... [-r resource path]\n\n"
+                  "Device types are separated by semicolons, for example d3d11;d3d12;vulkan. Shader list files are\n"
+                  "recorded by the ShaderPrecache class. One archive is written per device type by appending an\n"
+                  "underscore and the device type to the output file name.");
+
+    const String& outputFile = arguments[0];
+    Vector<String> deviceTypes = arguments[1].Split(';');
+    Vector<String> inputFiles;
+    Vector<String> resourcePaths;
+
+    for (unsigned i = 2; i < arguments.Size(); ++i)
+    {
+        if (arguments[i] == "-r" && i + 1 < arguments.Size())
+            resourcePaths.Push(arguments[++i]);
+        else
+            inputFiles.Push(arguments[i]);
+    }
+
+    if (inputFiles.Empty())
+        ErrorExit("No shader list files specified");
+
+    SharedPtr<Context> context(new Context());
+    SharedPtr<Engine> engine(new Engine(context));
+    // The graphics subsystem is used without opening a window or creating a device
+    context->RegisterSubsystem(new Graphics(context));
+
+    auto* log = context->GetSubsystem<Log>();
+    // Register Log subsystem manually if compiled without logging support
+    if (!log)
+    {
+        context->RegisterSubsystem(new Log(context));
+        log = context->GetSubsystem<Log>();
+    }
+
+    log->SetLevel(LOG_INFO);
+    log->SetTimeStamp(false);
+
+    auto* cache = context->GetSubsystem<ResourceCache>();
+    if (resourcePaths.Empty())
+    {
+        auto* fileSystem = context->GetSubsystem<FileSystem>();
+        resourcePaths.Push(cache->GetPreferredResourceDir(fileSystem->GetProgramDir()) + "CoreData");
+    }
+    for (unsigned i = 0; i < resourcePaths.Size(); ++i)
+        cache->AddResourceDir(resourcePaths[i]);
+
+    // Compile the variations on all cores, the main thread works too while waiting for completion
+    unsigned numThreads = GetNumLogicalCPUs();
+    if (numThreads > 1)
+        context->GetSubsystem<WorkQueue>()->CreateThreads(numThreads - 1);
+
+    PODVector<ShaderVariation*> variations;
+    for (unsigned i = 0; i < inputFiles.Size(); ++i)
+        CollectShaders(context, inputFiles[i], variations);
+
+    if (variations.Empty())
+        ErrorExit("No shader variations to compile");
+
+    PrintLine("Compiling " + String(variations.Size()) + " shader variations");
+
+    if (!context->GetSubsystem<Graphics>()->SaveShaderArchive(outputFile, variations, deviceTypes))
+        ErrorExit("Failed to write shader archive " + outputFile);
+
+    return EXIT_SUCCESS;
+}
+
+void CollectShaders(Context* context, const String& fileName, PODVector<ShaderVariation*>& variations)
+{
+    File file(context);
+    if (!file.Open(fileName))
+        ErrorExit("Could not open shader list file " + fileName);
+
+    XMLFile xmlFile(context);
+    if (!xmlFile.Load(file))
+        ErrorExit("Could not parse shader list file " + fileName);
+
+    auto* graphics = context->GetSubsystem<Graphics>();
+    HashSet<ShaderVariation*> collected;
+    for (unsigned i = 0; i < variations.Size(); ++i)
+        collected.Insert(variations[i]);
+
+    XMLElement shader = xmlFile.GetRoot().GetChild("shader");
+    while (shader)
+    {
+        ShaderVariation* vs = graphics->GetShader(VS, shader.GetAttribute("vs"), shader.GetAttribute("vsdefines"));
+        ShaderVariation* ps = graphics->GetShader(PS, shader.GetAttribute("ps"), shader.GetAttribute("psdefines"));
+        if (vs && !collected.Contains(vs))
+        {
+            collected.Insert(vs);
+            variations.Push(vs);
+        }
+        if (ps && !collected.Contains(ps))
+        {
+            collected.Insert(ps);
+            variations.Push(ps);
+        }
+
+        shader = shader.GetNext("shader");
+    }
+}
@@ -0,0 +1,219 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Resource/XMLFile.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+static const char* qualityNames[] =
+{
+    "fast",
+    "normal",
+    "high",
+    nullptr
+};
+
+int main(int argc, char** argv);
+void Run(const Vector<String>& arguments);
+CompressedFormat GetFormat(const String& name, bool hasAlpha, const String& platform);
+
+int main(int argc, char** argv)
+{
+    Vector<String> arguments;
+
+    #ifdef WIN32
+    arguments = ParseArguments(GetCommandLineW());
+    #else
+    arguments = ParseArguments(argc, argv);
+    #endif
+
+    Run(arguments);
+    return 0;
+}
+
+void Run(const Vector<String>& arguments)
+{
+    String inputFile;
+    String outputFile;
+    String parameterFile;
+    String platform = "desktop";
+    String formatName;
+    String qualityName;
+    bool noMipmaps = false;
+    bool usage = false;
+
+    for (unsigned i = 0; i < arguments.Size(); ++i)
+    {
+        const String& arg = arguments[i];
+        bool hasValue = i + 1 < arguments.Size();
+
+        if (arg == "-f" && hasValue)
+            formatName = arguments[++i].ToLower();
+        else if (arg == "-q" && hasValue)
+            qualityName = arguments[++i].ToLower();
+        else if (arg == "-p" && hasValue)
+            platform = arguments[++i].ToLower();
+        else if (arg == "-x" && hasValue)
+            parameterFile = arguments[++i];
+        else if (arg == "-nomip")
+            noMipmaps = true;
+        else if (inputFile.Empty() && !arg.StartsWith("-"))
+            inputFile = arg;
+        else if (outputFile.Empty() && !arg.StartsWith("-"))
+            outputFile = arg;
+        else
+            usage = true;
+    }
+
+    if (usage || inputFile.Empty() || outputFile.Empty())
+    {
+        ErrorExit(
+            "Usage: TextureCompressor <input image> <output dds or ktx file> [options]\n"
+            "\n"
+            "Compresses an image with its mip levels to DXT or ETC blocks. The format, quality and mip levels\n"
+            "default to the compress and mipmap elements of the texture parameter file next to the input image,\n"
+            "selected by the platform.\n"
+            "\n"
+            "Options:\n"
+            "-f <format>   dxt1, dxt3, dxt5, etc1, etc2, etc2a or auto. Auto chooses DXT on desktop and ETC2\n"
+            "              on other platforms, with alpha if the image has any. Default auto\n"
+            "-q <quality>  fast, normal or high. Default normal\n"
+            "-p <platform> Platform for choosing the compress element of the parameter file. Default desktop\n"
+            "-x <file>     Texture parameter file. Default the input image name with the xml extension\n"
+            "-nomip        Do not generate mip levels\n"
+        );
+    }
+
+    SharedPtr<Context> context(new Context());
+    context->RegisterSubsystem(new FileSystem(context));
+    context->RegisterSubsystem(new Log(context));
+    auto* workQueue = new WorkQueue(context);
+    context->RegisterSubsystem(workQueue);
+    workQueue->CreateThreads(GetNumLogicalCPUs() - 1);
+    auto* fileSystem = context->GetSubsystem<FileSystem>();
+
+    // Read the settings for the platform from the texture parameter file, if any. The command line overrides them
+    bool mipmaps = true;
+    if (parameterFile.Empty())
+        parameterFile = ReplaceExtension(inputFile, ".xml");
+    if (fileSystem->FileExists(parameterFile))
+    {
+        SharedPtr<XMLFile> xml(new XMLFile(context));
+        File file(context, parameterFile);
+        if (!xml->Load(file))
+            ErrorExit("Failed to load texture parameter file " + parameterFile);
+
+        XMLElement rootElem = xml->GetRoot();
+        XMLElement mipmapElem = rootElem.GetChild("mipmap");
+        if (mipmapElem && mipmapElem.HasAttribute("enable"))
+            mipmaps = mipmapElem.GetBool("enable");
+
+        // An element for the platform takes precedence over one without a platform
+        XMLElement compressElem;
+        for (XMLElement elem = rootElem.GetChild("compress"); elem; elem = elem.GetNext("compress"))
+        {
+            String elemPlatform = elem.GetAttributeLower("platform");
+            if (elemPlatform == platform || (elemPlatform.Empty() && !compressElem))
+                compressElem = elem;
+        }
+        if (compressElem)
+        {
+            if (formatName.Empty())
+                formatName = compressElem.GetAttributeLower("format");
+            if (qualityName.Empty())
+                qualityName = compressElem.GetAttributeLower("quality");
+        }
+    }
+    if (noMipmaps)
+        mipmaps = false;
+
+    SharedPtr<Image> image(new Image(context));
+    File file(context, inputFile);
+    if (!file.IsOpen() || !image->Load(file))
+        ErrorExit("Failed to load image " + inputFile);
+    if (image->IsCompressed())
+        ErrorExit("Image " + inputFile + " is already compressed");
+
+    CompressedFormat format = GetFormat(formatName, image->HasAlphaChannel(), platform);
+    if (format == CF_NONE)
+        ErrorExit("Unknown compressed format " + formatName);
+
+    unsigned quality = qualityName.Empty() ? (unsigned)CQ_NORMAL : GetStringListIndex(qualityName.CString(), qualityNames, M_MAX_UNSIGNED);
+    if (quality == M_MAX_UNSIGNED)
+        ErrorExit("Unknown compression quality " + qualityName);
+
+    bool dds = outputFile.EndsWith(".dds", false);
+    if (!dds && !outputFile.EndsWith(".ktx", false))
+        ErrorExit("Output file " + outputFile + " is neither dds nor ktx");
+    if (dds && format != CF_DXT1 && format != CF_DXT3 && format != CF_DXT5)
+        ErrorExit("ETC formats can only be saved to ktx");
+
+    SharedPtr<Image> compressed = image->Compress(format, (CompressionQuality)quality, mipmaps);
+    if (!compressed)
+        ErrorExit("Failed to compress image " + inputFile);
+
+    if (!(dds ? compressed->SaveDDS(outputFile) : compressed->SaveKTX(outputFile)))
+        ErrorExit("Failed to save " + outputFile);
+
+    PrintLine("Compressed " + inputFile + " to " + outputFile + " with " + String(compressed->GetNumCompressedLevels()) +
+        " levels, " + String(compressed->GetMemoryUse()) + " bytes");
+}
+
+CompressedFormat GetFormat(const String& name, bool hasAlpha, const String& platform)
+{
+    if (name.Empty() || name == "auto")
+    {
+        if (platform == "desktop" || platform == "web")
+            return hasAlpha ? CF_DXT5 : CF_DXT1;
+        else
+            return hasAlpha ? CF_ETC2_RGBA : CF_ETC2_RGB;
+    }
+
+    if (name == "dxt1" || name == "bc1")
+        return CF_DXT1;
+    else if (name == "dxt3" || name == "bc2")
+        return CF_DXT3;
+    else if (name == "dxt5" || name == "bc3")
+        return CF_DXT5;
+    else if (name == "etc1")
+        return CF_ETC1;
+    else if (name == "etc2")
+        return CF_ETC2_RGB;
+    else if (name == "etc2a")
+        return CF_ETC2_RGBA;
+    else
+        return CF_NONE;
+}
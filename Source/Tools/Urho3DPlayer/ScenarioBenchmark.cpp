@@ -0,0 +1,281 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <Urho3D/Container/Sort.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/Profiler.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Graphics.h>
+#include <Urho3D/Graphics/GraphicsEvents.h>
+#include <Urho3D/Graphics/Renderer.h>
+#include <Urho3D/Graphics/Viewport.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/JSONFile.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Node.h>
+
+#include "ScenarioBenchmark.h"
+
+#include <Urho3D/DebugNew.h>
+
+static const float DEFAULT_TIME_STEP = 1.0f / 60.0f;
+static const unsigned DEFAULT_WARMUP_FRAMES = 60;
+static const unsigned DEFAULT_FRAMES = 600;
+
+/// Return the value at the given percentile of sorted values, using the nearest rank.
+static float GetPercentile(const PODVector<float>& sortedValues, float percentile)
+{
+    auto rank = (unsigned)ceilf(percentile * (float)sortedValues.Size());
+    return sortedValues[Clamp(rank, 1U, sortedValues.Size()) - 1];
+}
+
+/// Return the statistics of per-frame values as a JSON object.
+static JSONValue GetStatistics(PODVector<float> values)
+{
+    JSONValue statistics;
+    if (values.Empty())
+        return statistics;
+
+    Sort(values.Begin(), values.End());
+    double sum = 0.0;
+    for (unsigned i = 0; i < values.Size(); ++i)
+        sum += values[i];
+
+    statistics.Set("mean", sum / values.Size());
+    statistics.Set("min", values.Front());
+    statistics.Set("max", values.Back());
+    statistics.Set("p50", GetPercentile(values, 0.50f));
+    statistics.Set("p95", GetPercentile(values, 0.95f));
+    statistics.Set("p99", GetPercentile(values, 0.99f));
+    return statistics;
+}
+
+ScenarioBenchmark::ScenarioBenchmark(Context* context) :
+    Object(context),
+    timeStep_(DEFAULT_TIME_STEP),
+    warmupFrames_(DEFAULT_WARMUP_FRAMES),
+    frames_(DEFAULT_FRAMES),
+    seed_(1),
+    frame_(0),
+    cpuTime_(-1)
+{
+}
+
+bool ScenarioBenchmark::Load(const String& scenarioName)
+{
+    SharedPtr<JSONFile> file = GetSubsystem<ResourceCache>()->GetTempResource<JSONFile>(scenarioName);
+    if (!file)
+        return false;
+
+    const JSONValue& root = file->GetRoot();
+    if (!root.IsObject())
+    {
+        URHO3D_LOGERROR("Benchmark scenario " + scenarioName + " is not a JSON object");
+        return false;
+    }
+
+    scenarioName_ = scenarioName;
+    timeStep_ = Max(root.Get("timeStep").GetFloat(DEFAULT_TIME_STEP), M_EPSILON);
+    warmupFrames_ = Max(root.Get("warmupFrames").GetUInt(DEFAULT_WARMUP_FRAMES), 1U);
+    frames_ = Max(root.Get("frames").GetUInt(DEFAULT_FRAMES), 1U);
+    seed_ = root.Get("seed").GetUInt(1);
+
+    cameraPath_.Clear();
+    const JSONArray& path = root.Get("cameraPath").GetArray();
+    for (unsigned i = 0; i < path.Size(); ++i)
+    {
+        CameraPoint point;
+        point.position_ = ToVector3(path[i].Get("position").GetString());
+        point.rotation_ = ToQuaternion(path[i].Get("rotation").GetString());
+        cameraPath_.Push(point);
+    }
+
+    return true;
+}
+
+void ScenarioBenchmark::Start(const String& outputFileName)
+{
+    outputFileName_ = outputFileName;
+    frame_ = 0;
+
+    // Measure the GPU frame time where timestamp queries are supported
+    auto* graphics = GetSubsystem<Graphics>();
+    if (graphics)
+        graphics->SetGPUProfiling(true);
+
+    GetSubsystem<Engine>()->SetNextTimeStep(timeStep_);
+
+    SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(ScenarioBenchmark, HandleBeginFrame));
+    SubscribeToEvent(E_POSTUPDATE, URHO3D_HANDLER(ScenarioBenchmark, HandlePostUpdate));
+    SubscribeToEvent(E_ENDRENDERING, URHO3D_HANDLER(ScenarioBenchmark, HandleEndRendering));
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(ScenarioBenchmark, HandleEndFrame));
+
+    URHO3D_LOGINFO("Running benchmark scenario {}: {} warmup frames, {} measured frames", scenarioName_, warmupFrames_, frames_);
+}
+
+void ScenarioBenchmark::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
+{
+    cpuTimer_.Reset();
+    cpuTime_ = -1;
+
+    // The profiler has just ended the previous frame, so its blocks hold the times of that frame
+    if (frame_ > warmupFrames_)
+    {
+        auto* profiler = GetSubsystem<Profiler>();
+        if (profiler)
+        {
+            const PODVector<ProfilerBlock*>& blocks = profiler->GetRootBlock()->children_;
+            for (unsigned i = 0; i < blocks.Size(); ++i)
+            {
+                const ProfilerBlock* block = blocks[i];
+                String name(block->name_);
+                if (!blockTimes_.Contains(name))
+                    blockNames_.Push(name);
+                blockTimes_[name].Push((float)block->frameTime_ / 1000.0f);
+
+                for (unsigned j = 0; j < block->children_.Size(); ++j)
+                {
+                    const ProfilerBlock* child = block->children_[j];
+                    String childName = name + "/" + child->name_;
+                    if (!blockTimes_.Contains(childName))
+                        blockNames_.Push(childName);
+                    blockTimes_[childName].Push((float)child->frameTime_ / 1000.0f);
+                }
+            }
+        }
+    }
+
+    if (frame_ >= warmupFrames_ + frames_)
+        Finish();
+}
+
+void ScenarioBenchmark::HandlePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    if (cameraPath_.Empty())
+        return;
+
+    auto* renderer = GetSubsystem<Renderer>();
+    Viewport* viewport = renderer ? renderer->GetViewport(0) : nullptr;
+    Camera* camera = viewport ? viewport->GetCamera() : nullptr;
+    Node* cameraNode = camera ? camera->GetNode() : nullptr;
+    if (!cameraNode)
+        return;
+
+    // Stay at the first point during the warmup, then traverse the path during the measured frames
+    float position = 0.0f;
+    if (frame_ > warmupFrames_)
+        position = (float)(frame_ - warmupFrames_) / (float)Max(frames_ - 1, 1U) * (float)(cameraPath_.Size() - 1);
+    auto index = Min((unsigned)position, cameraPath_.Size() - 1);
+    unsigned nextIndex = Min(index + 1, cameraPath_.Size() - 1);
+    float t = Min(position - (float)index, 1.0f);
+
+    const CameraPoint& point = cameraPath_[index];
+    const CameraPoint& nextPoint = cameraPath_[nextIndex];
+    cameraNode->SetWorldPosition(point.position_.Lerp(nextPoint.position_, t));
+    cameraNode->SetWorldRotation(point.rotation_.Slerp(nextPoint.rotation_, t));
+}
+
+void ScenarioBenchmark::HandleEndRendering(StringHash eventType, VariantMap& eventData)
+{
+    cpuTime_ = cpuTimer_.GetUSec(false);
+}
+
+void ScenarioBenchmark::HandleEndFrame(StringHash eventType, VariantMap& eventData)
+{
+    long long frameTime = frameTimer_.GetUSec(true);
+
+    if (frame_ >= warmupFrames_ && frame_ < warmupFrames_ + frames_)
+    {
+        // Without rendering, such as in headless mode, the whole frame is CPU time
+        if (cpuTime_ < 0)
+            cpuTime_ = cpuTimer_.GetUSec(false);
+
+        frameTimes_.Push((float)frameTime / 1000.0f);
+        cpuTimes_.Push((float)cpuTime_ / 1000.0f);
+
+        auto* graphics = GetSubsystem<Graphics>();
+        if (graphics && graphics->GetGPUFrameTime())
+            gpuTimes_.Push((float)graphics->GetGPUFrameTime() / 1000.0f);
+
+        auto* renderer = GetSubsystem<Renderer>();
+        if (renderer)
+        {
+            batches_.Push((float)renderer->GetNumBatches());
+            primitives_.Push((float)renderer->GetNumPrimitives());
+        }
+    }
+
+    ++frame_;
+
+    // The engine measures the next timestep after this frame, so override it now
+    GetSubsystem<Engine>()->SetNextTimeStep(timeStep_);
+}
+
+void ScenarioBenchmark::Finish()
+{
+    UnsubscribeFromAllEvents();
+
+    SharedPtr<JSONFile> file(new JSONFile(context_));
+    JSONValue& root = file->GetRoot();
+    root.Set("scenario", scenarioName_);
+    root.Set("platform", GetPlatform());
+    root.Set("timeStep", timeStep_);
+    root.Set("warmupFrames", warmupFrames_);
+    root.Set("frames", frames_);
+    root.Set("seed", seed_);
+
+    auto* graphics = GetSubsystem<Graphics>();
+    if (graphics)
+    {
+        root.Set("apiName", graphics->GetApiName());
+        root.Set("width", graphics->GetWidth());
+        root.Set("height", graphics->GetHeight());
+    }
+
+    root.Set("frameTime", GetStatistics(frameTimes_));
+    root.Set("cpuTime", GetStatistics(cpuTimes_));
+    if (!gpuTimes_.Empty())
+        root.Set("gpuTime", GetStatistics(gpuTimes_));
+
+    JSONValue blocks;
+    for (unsigned i = 0; i < blockNames_.Size(); ++i)
+        blocks.Set(blockNames_[i], GetStatistics(blockTimes_[blockNames_[i]]));
+    root.Set("subsystems", blocks);
+
+    root.Set("batches", GetStatistics(batches_));
+    root.Set("primitives", GetStatistics(primitives_));
+    root.Set("peakMemory", (double)GetPeakMemoryUse());
+    root.Set("resourceMemory", (double)GetSubsystem<ResourceCache>()->GetTotalMemoryUse());
+
+    File output(context_, outputFileName_, FILE_WRITE);
+    if (output.IsOpen() && file->Save(output))
+        URHO3D_LOGINFO("Benchmark results written to {}", outputFileName_);
+    else
+        URHO3D_LOGERROR("Failed to write benchmark results to {}", outputFileName_);
+
+    GetSubsystem<Engine>()->Exit();
+}
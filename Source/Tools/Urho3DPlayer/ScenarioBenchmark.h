@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Math/Quaternion.h>
+
+using namespace Urho3D;
+
+/// Runs the player through a benchmark scenario: a fixed timestep, a scripted camera path, warmup frames and measured frames. Writes the frame time percentiles, draw counts and peak memory use to a JSON file, then exits.
+class ScenarioBenchmark : public Object
+{
+    URHO3D_OBJECT(ScenarioBenchmark, Object);
+
+public:
+    /// Construct.
+    explicit ScenarioBenchmark(Context* context);
+
+    /// Load the scenario from a JSON resource. Return true if successful.
+    bool Load(const String& scenarioName);
+    /// Start running the scenario. The results are written to the given file after the last measured frame.
+    void Start(const String& outputFileName);
+
+    /// Return the random seed to set before the script starts, so that the scene is the same on every run.
+    unsigned GetSeed() const { return seed_; }
+
+private:
+    /// Point of the camera path.
+    struct CameraPoint
+    {
+        /// World position.
+        Vector3 position_;
+        /// World rotation.
+        Quaternion rotation_;
+    };
+
+    /// Handle frame begin. Collect the profiler data of the previous frame and finish after the last measured frame.
+    void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+    /// Handle post-update. Move the camera along the path after the script has updated.
+    void HandlePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle rendering end, which is before the frame is presented.
+    void HandleEndRendering(StringHash eventType, VariantMap& eventData);
+    /// Handle frame end. Collect the frame times and draw counts and set the fixed timestep of the next frame.
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+    /// Write the results and exit.
+    void Finish();
+
+    /// Scenario resource name.
+    String scenarioName_;
+    /// Output file name.
+    String outputFileName_;
+    /// Camera path, which is traversed at an even pace during the measured frames.
+    PODVector<CameraPoint> cameraPath_;
+    /// Fixed timestep in seconds.
+    float timeStep_;
+    /// Number of frames run before measuring.
+    unsigned warmupFrames_;
+    /// Number of measured frames.
+    unsigned frames_;
+    /// Random seed.
+    unsigned seed_;
+    /// Index of the current frame since the start.
+    unsigned frame_;
+    /// Timer for the wall clock frame time.
+    HiresTimer frameTimer_;
+    /// Timer for the CPU time of the frame, which excludes presenting.
+    HiresTimer cpuTimer_;
+    /// CPU time of the current frame in microseconds, or negative if rendering has not ended.
+    long long cpuTime_;
+    /// Wall clock frame times in milliseconds.
+    PODVector<float> frameTimes_;
+    /// CPU frame times in milliseconds.
+    PODVector<float> cpuTimes_;
+    /// GPU frame times in milliseconds. Only collected where GPU timing is supported.
+    PODVector<float> gpuTimes_;
+    /// Batch counts.
+    PODVector<float> batches_;
+    /// Primitive counts.
+    PODVector<float> primitives_;
+    /// Times of the profiler blocks of the first two levels in milliseconds, by block path.
+    HashMap<String, PODVector<float> > blockTimes_;
+    /// Block paths in order of first appearance.
+    Vector<String> blockNames_;
+};
@@ -32,6 +32,7 @@
 #ifdef URHO3D_LUA
 #include <Urho3D/LuaScript/LuaScript.h>
 #endif
+#include <Urho3D/Math/Random.h>
 #include <Urho3D/Resource/ResourceCache.h>
 #include <Urho3D/Resource/ResourceEvents.h>
 
@@ -74,6 +75,15 @@ void Urho3DPlayer::Setup()
 
     // Check for script file name from the arguments
     GetScriptFileName();
+    GetBenchmarkOptions();
+
+    // Benchmarks run as fast as possible with a fixed timestep, which the engine must not override when waiting for the frame limit
+    if (!benchmarkScenario_.Empty())
+    {
+        engineParameters_[EP_FRAME_LIMITER] = false;
+        engineParameters_[EP_VSYNC] = false;
+        engineParameters_[EP_LOW_LATENCY_INPUT] = false;
+    }
 
 #ifndef __EMSCRIPTEN__
     // Show usage if not found
@@ -121,10 +131,13 @@ void Urho3DPlayer::Setup()
             "-lqshadows   Use low-quality (1-sample) shadow filtering\n"
             "-noshadows   Disable shadow rendering\n"
             "-nolimit     Disable frame limiter\n"
+            "-lowlatency  Wait for the frame limit before sampling input instead of after rendering\n"
             "-nothreads   Disable worker threads\n"
             "-nosound     Disable sound output\n"
             "-noip        Disable sound mixing interpolation\n"
             "-touch       Touch emulation on desktop platform\n"
+            "-benchmark <scenario> Run the benchmark scenario (JSON resource) and exit\n"
+            "-benchmarkoutput <file> Benchmark results file, default to the scenario name with .result.json extension\n"
             #endif
         );
     }
@@ -168,6 +181,18 @@ void Urho3DPlayer::Start()
         return;
     }
 
+    // Load the benchmark scenario now that the resource system is live, and seed the random numbers before the script starts
+    if (!benchmarkScenario_.Empty())
+    {
+        benchmark_ = new ScenarioBenchmark(context_);
+        if (!benchmark_->Load(benchmarkScenario_))
+        {
+            ErrorExit("Failed to load benchmark scenario " + benchmarkScenario_);
+            return;
+        }
+        SetRandomSeed(benchmark_->GetSeed());
+    }
+
     String extension = GetExtension(scriptFileName_);
     if (extension != ".lua" && extension != ".luc")
     {
@@ -190,6 +215,7 @@ void Urho3DPlayer::Start()
             SubscribeToEvent(scriptFile_, E_RELOADSTARTED, URHO3D_HANDLER(Urho3DPlayer, HandleScriptReloadStarted));
             SubscribeToEvent(scriptFile_, E_RELOADFINISHED, URHO3D_HANDLER(Urho3DPlayer, HandleScriptReloadFinished));
             SubscribeToEvent(scriptFile_, E_RELOADFAILED, URHO3D_HANDLER(Urho3DPlayer, HandleScriptReloadFailed));
+            StartBenchmark();
             return;
         }
 #else
@@ -208,6 +234,7 @@ void Urho3DPlayer::Start()
         if (luaScript->ExecuteFile(scriptFileName_))
         {
             luaScript->ExecuteFunction("Start");
+            StartBenchmark();
             return;
         }
 #else
@@ -279,3 +306,25 @@ void Urho3DPlayer::GetScriptFileName()
     if (arguments.Size() && arguments[0][0] != '-')
         scriptFileName_ = GetInternalPath(arguments[0]);
 }
+
+void Urho3DPlayer::GetBenchmarkOptions()
+{
+    const Vector<String>& arguments = GetArguments();
+    for (unsigned i = 0; i + 1 < arguments.Size(); ++i)
+    {
+        String argument = arguments[i].ToLower();
+        if (argument == "-benchmark")
+            benchmarkScenario_ = GetInternalPath(arguments[++i]);
+        else if (argument == "-benchmarkoutput")
+            benchmarkOutput_ = arguments[++i];
+    }
+
+    if (!benchmarkScenario_.Empty() && benchmarkOutput_.Empty())
+        benchmarkOutput_ = GetFileName(benchmarkScenario_) + ".result.json";
+}
+
+void Urho3DPlayer::StartBenchmark()
+{
+    if (benchmark_)
+        benchmark_->Start(benchmarkOutput_);
+}
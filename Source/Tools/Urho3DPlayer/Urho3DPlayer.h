@@ -24,6 +24,8 @@
 
 #include <Urho3D/Engine/Application.h>
 
+#include "ScenarioBenchmark.h"
+
 using namespace Urho3D;
 
 /// Urho3DPlayer application runs a script specified on the command line.
@@ -51,11 +53,21 @@ private:
     void HandleScriptReloadFailed(StringHash eventType, VariantMap& eventData);
     /// Parse script file name from the first argument.
     void GetScriptFileName();
+    /// Parse benchmark scenario and output file names from the arguments.
+    void GetBenchmarkOptions();
+    /// Start the benchmark scenario after the script has started, if one is specified.
+    void StartBenchmark();
 
     /// Script file name.
     String scriptFileName_;
     /// Flag whether CommandLine.txt was already successfully read.
     bool commandLineRead_;
+    /// Benchmark scenario resource name.
+    String benchmarkScenario_;
+    /// Benchmark results file name.
+    String benchmarkOutput_;
+    /// Benchmark scenario runner.
+    SharedPtr<ScenarioBenchmark> benchmark_;
 
 #ifdef URHO3D_ANGELSCRIPT
     /// Script file.
@@ -2882,6 +2882,8 @@ static void Variant__Variant_constspVariantamp(Variant* _ptr, const Variant& val
 // class Variant | File: ../Core/Variant.h
 static void Register_Variant(asIScriptEngine* engine)
 {
+    // Variant::Variant(Variant&& value) noexcept
+    // Error: type "Variant&&" can not automatically bind
     // Variant::Variant(VariantType type, const char* value)
     // Error: type "const char*" can not automatically bind
     // Variant::Variant(const PODVector<unsigned char>& value)
@@ -3455,6 +3457,22 @@ static void Register_PhysicsRaycastResult(asIScriptEngine* engine)
     RegisterImplicitlyDeclaredAssignOperatorIfPossible<PhysicsRaycastResult>(engine, "PhysicsRaycastResult");
 }
 
+// struct PhysicsStatistics | File: ../Physics/PhysicsWorld.h
+static void Register_PhysicsStatistics(asIScriptEngine* engine)
+{
+    // PhysicsStatistics::~PhysicsStatistics() | Implicitly-declared
+    engine->RegisterObjectBehaviour("PhysicsStatistics", asBEHAVE_DESTRUCT, "void f()", AS_DESTRUCTOR(PhysicsStatistics), AS_CALL_CDECL_OBJFIRST);
+
+    RegisterMembers_PhysicsStatistics<PhysicsStatistics>(engine, "PhysicsStatistics");
+
+    #ifdef REGISTER_CLASS_MANUAL_PART_PhysicsStatistics
+        REGISTER_CLASS_MANUAL_PART_PhysicsStatistics();
+    #endif
+
+    // PhysicsStatistics& PhysicsStatistics::operator =(const PhysicsStatistics&) | Possible implicitly-declared
+    RegisterImplicitlyDeclaredAssignOperatorIfPossible<PhysicsStatistics>(engine, "PhysicsStatistics");
+}
+
 // struct PhysicsWorldConfig | File: ../Physics/PhysicsWorld.h
 static void Register_PhysicsWorldConfig(asIScriptEngine* engine)
 {
@@ -4008,6 +4026,28 @@ static AttributeAnimationInfo* AttributeAnimationInfo__AttributeAnimationInfo_co
     return new AttributeAnimationInfo(other);
 }
 
+// explicit AdpcmSoundStream::AdpcmSoundStream(const Sound* sound)
+static AdpcmSoundStream* AdpcmSoundStream__AdpcmSoundStream_constspSoundstar(const Sound* sound)
+{
+    return new AdpcmSoundStream(sound);
+}
+
+// class AdpcmSoundStream | File: ../Audio/AdpcmSoundStream.h
+static void Register_AdpcmSoundStream(asIScriptEngine* engine)
+{
+    // explicit AdpcmSoundStream::AdpcmSoundStream(const Sound* sound)
+    engine->RegisterObjectBehaviour("AdpcmSoundStream", asBEHAVE_FACTORY, "AdpcmSoundStream@+ f(Sound@+)", AS_FUNCTION(AdpcmSoundStream__AdpcmSoundStream_constspSoundstar) , AS_CALL_CDECL);
+
+    RegisterSubclass<SoundStream, AdpcmSoundStream>(engine, "SoundStream", "AdpcmSoundStream");
+    RegisterSubclass<RefCounted, AdpcmSoundStream>(engine, "RefCounted", "AdpcmSoundStream");
+
+    RegisterMembers_AdpcmSoundStream<AdpcmSoundStream>(engine, "AdpcmSoundStream");
+
+    #ifdef REGISTER_CLASS_MANUAL_PART_AdpcmSoundStream
+        REGISTER_CLASS_MANUAL_PART_AdpcmSoundStream();
+    #endif
+}
+
 // class AttributeAnimationInfo | File: ../Scene/Animatable.h
 static void Register_AttributeAnimationInfo(asIScriptEngine* engine)
 {
@@ -4448,6 +4488,29 @@ static void Register_Log(asIScriptEngine* engine)
     #endif
 }
 
+// explicit MaterialAtlas::MaterialAtlas(Context* context)
+static MaterialAtlas* MaterialAtlas__MaterialAtlas_Contextstar()
+{
+    Context* context = GetScriptContext();
+    return new MaterialAtlas(context);
+}
+
+// class MaterialAtlas | File: ../Graphics/MaterialAtlas.h
+static void Register_MaterialAtlas(asIScriptEngine* engine)
+{
+    // explicit MaterialAtlas::MaterialAtlas(Context* context)
+    engine->RegisterObjectBehaviour("MaterialAtlas", asBEHAVE_FACTORY, "MaterialAtlas@+ f()", AS_FUNCTION(MaterialAtlas__MaterialAtlas_Contextstar) , AS_CALL_CDECL);
+
+    RegisterSubclass<Object, MaterialAtlas>(engine, "Object", "MaterialAtlas");
+    RegisterSubclass<RefCounted, MaterialAtlas>(engine, "RefCounted", "MaterialAtlas");
+
+    RegisterMembers_MaterialAtlas<MaterialAtlas>(engine, "MaterialAtlas");
+
+    #ifdef REGISTER_CLASS_MANUAL_PART_MaterialAtlas
+        REGISTER_CLASS_MANUAL_PART_MaterialAtlas();
+    #endif
+}
+
 // explicit MessageBox::MessageBox(Context* context, const String& messageString = String::EMPTY, const String& titleString = String::EMPTY, XMLFile* layoutFile = nullptr, XMLFile* styleFile = nullptr)
 static MessageBox* MessageBox__MessageBox_Contextstar_constspStringamp_constspStringamp_XMLFilestar_XMLFilestar(const String& messageString, const String& titleString, XMLFile* layoutFile, XMLFile* styleFile)
 {
@@ -4471,6 +4534,29 @@ static void Register_MessageBox(asIScriptEngine* engine)
     #endif
 }
 
+// explicit Metrics::Metrics(Context* context)
+static Metrics* Metrics__Metrics_Contextstar()
+{
+    Context* context = GetScriptContext();
+    return new Metrics(context);
+}
+
+// class Metrics | File: ../Core/Metrics.h
+static void Register_Metrics(asIScriptEngine* engine)
+{
+    // explicit Metrics::Metrics(Context* context)
+    engine->RegisterObjectBehaviour("Metrics", asBEHAVE_FACTORY, "Metrics@+ f()", AS_FUNCTION(Metrics__Metrics_Contextstar) , AS_CALL_CDECL);
+
+    RegisterSubclass<Object, Metrics>(engine, "Object", "Metrics");
+    RegisterSubclass<RefCounted, Metrics>(engine, "RefCounted", "Metrics");
+
+    RegisterMembers_Metrics<Metrics>(engine, "Metrics");
+
+    #ifdef REGISTER_CLASS_MANUAL_PART_Metrics
+        REGISTER_CLASS_MANUAL_PART_Metrics();
+    #endif
+}
+
 // explicit NamedPipe::NamedPipe(Context* context)
 static NamedPipe* NamedPipe__NamedPipe_Contextstar()
 {
@@ -5377,6 +5463,30 @@ static void Register_ParticleEffect(asIScriptEngine* engine)
     #endif
 }
 
+// explicit PrefabTemplate::PrefabTemplate(Context* context)
+static PrefabTemplate* PrefabTemplate__PrefabTemplate_Contextstar()
+{
+    Context* context = GetScriptContext();
+    return new PrefabTemplate(context);
+}
+
+// class PrefabTemplate | File: ../Scene/PrefabTemplate.h
+static void Register_PrefabTemplate(asIScriptEngine* engine)
+{
+    // explicit PrefabTemplate::PrefabTemplate(Context* context)
+    engine->RegisterObjectBehaviour("PrefabTemplate", asBEHAVE_FACTORY, "PrefabTemplate@+ f()", AS_FUNCTION(PrefabTemplate__PrefabTemplate_Contextstar) , AS_CALL_CDECL);
+
+    RegisterSubclass<Resource, PrefabTemplate>(engine, "Resource", "PrefabTemplate");
+    RegisterSubclass<Object, PrefabTemplate>(engine, "Object", "PrefabTemplate");
+    RegisterSubclass<RefCounted, PrefabTemplate>(engine, "RefCounted", "PrefabTemplate");
+
+    RegisterMembers_PrefabTemplate<PrefabTemplate>(engine, "PrefabTemplate");
+
+    #ifdef REGISTER_CLASS_MANUAL_PART_PrefabTemplate
+        REGISTER_CLASS_MANUAL_PART_PrefabTemplate();
+    #endif
+}
+
 // explicit ResourceWithMetadata::ResourceWithMetadata(Context* context)
 static ResourceWithMetadata* ResourceWithMetadata__ResourceWithMetadata_Contextstar()
 {
@@ -6050,6 +6160,58 @@ static void Register_ScrollView(asIScriptEngine* engine)
     engine->RegisterObjectMethod("ScrollView", "bool get_selected() const", AS_METHODPR(ScrollView, IsSelected, () const, bool), AS_CALL_THISCALL);
 }
 
+// explicit SceneStreamer::SceneStreamer(Context* context)
+static SceneStreamer* SceneStreamer__SceneStreamer_Contextstar()
+{
+    Context* context = GetScriptContext();
+    return new SceneStreamer(context);
+}
+
+// class SceneStreamer | File: ../Scene/SceneStreamer.h
+static void Register_SceneStreamer(asIScriptEngine* engine)
+{
+    // explicit SceneStreamer::SceneStreamer(Context* context)
+    engine->RegisterObjectBehaviour("SceneStreamer", asBEHAVE_FACTORY, "SceneStreamer@+ f()", AS_FUNCTION(SceneStreamer__SceneStreamer_Contextstar) , AS_CALL_CDECL);
+
+    RegisterSubclass<Component, SceneStreamer>(engine, "Component", "SceneStreamer");
+    RegisterSubclass<Animatable, SceneStreamer>(engine, "Animatable", "SceneStreamer");
+    RegisterSubclass<Serializable, SceneStreamer>(engine, "Serializable", "SceneStreamer");
+    RegisterSubclass<Object, SceneStreamer>(engine, "Object", "SceneStreamer");
+    RegisterSubclass<RefCounted, SceneStreamer>(engine, "RefCounted", "SceneStreamer");
+
+    RegisterMembers_SceneStreamer<SceneStreamer>(engine, "SceneStreamer");
+
+    #ifdef REGISTER_CLASS_MANUAL_PART_SceneStreamer
+        REGISTER_CLASS_MANUAL_PART_SceneStreamer();
+    #endif
+}
+
+// explicit SignificanceManager::SignificanceManager(Context* context)
+static SignificanceManager* SignificanceManager__SignificanceManager_Contextstar()
+{
+    Context* context = GetScriptContext();
+    return new SignificanceManager(context);
+}
+
+// class SignificanceManager | File: ../Graphics/SignificanceManager.h
+static void Register_SignificanceManager(asIScriptEngine* engine)
+{
+    // explicit SignificanceManager::SignificanceManager(Context* context)
+    engine->RegisterObjectBehaviour("SignificanceManager", asBEHAVE_FACTORY, "SignificanceManager@+ f()", AS_FUNCTION(SignificanceManager__SignificanceManager_Contextstar) , AS_CALL_CDECL);
+
+    RegisterSubclass<Component, SignificanceManager>(engine, "Component", "SignificanceManager");
+    RegisterSubclass<Animatable, SignificanceManager>(engine, "Animatable", "SignificanceManager");
+    RegisterSubclass<Serializable, SignificanceManager>(engine, "Serializable", "SignificanceManager");
+    RegisterSubclass<Object, SignificanceManager>(engine, "Object", "SignificanceManager");
+    RegisterSubclass<RefCounted, SignificanceManager>(engine, "RefCounted", "SignificanceManager");
+
+    RegisterMembers_SignificanceManager<SignificanceManager>(engine, "SignificanceManager");
+
+    #ifdef REGISTER_CLASS_MANUAL_PART_SignificanceManager
+        REGISTER_CLASS_MANUAL_PART_SignificanceManager();
+    #endif
+}
+
 // explicit SmoothedTransform::SmoothedTransform(Context* context)
 static SmoothedTransform* SmoothedTransform__SmoothedTransform_Contextstar()
 {
@@ -6206,6 +6368,32 @@ static void Register_Terrain(asIScriptEngine* engine)
     #endif
 }
 
+// explicit TerrainStreamer::TerrainStreamer(Context* context)
+static TerrainStreamer* TerrainStreamer__TerrainStreamer_Contextstar()
+{
+    Context* context = GetScriptContext();
+    return new TerrainStreamer(context);
+}
+
+// class TerrainStreamer | File: ../Graphics/TerrainStreamer.h
+static void Register_TerrainStreamer(asIScriptEngine* engine)
+{
+    // explicit TerrainStreamer::TerrainStreamer(Context* context)
+    engine->RegisterObjectBehaviour("TerrainStreamer", asBEHAVE_FACTORY, "TerrainStreamer@+ f()", AS_FUNCTION(TerrainStreamer__TerrainStreamer_Contextstar) , AS_CALL_CDECL);
+
+    RegisterSubclass<Component, TerrainStreamer>(engine, "Component", "TerrainStreamer");
+    RegisterSubclass<Animatable, TerrainStreamer>(engine, "Animatable", "TerrainStreamer");
+    RegisterSubclass<Serializable, TerrainStreamer>(engine, "Serializable", "TerrainStreamer");
+    RegisterSubclass<Object, TerrainStreamer>(engine, "Object", "TerrainStreamer");
+    RegisterSubclass<RefCounted, TerrainStreamer>(engine, "RefCounted", "TerrainStreamer");
+
+    RegisterMembers_TerrainStreamer<TerrainStreamer>(engine, "TerrainStreamer");
+
+    #ifdef REGISTER_CLASS_MANUAL_PART_TerrainStreamer
+        REGISTER_CLASS_MANUAL_PART_TerrainStreamer();
+    #endif
+}
+
 // explicit Texture2D::Texture2D(Context* context)
 static Texture2D* Texture2D__Texture2D_Contextstar()
 {
@@ -7251,6 +7439,33 @@ static void Register_RibbonTrail(asIScriptEngine* engine)
     #endif
 }
 
+// explicit ScatterModel::ScatterModel(Context* context)
+static ScatterModel* ScatterModel__ScatterModel_Contextstar()
+{
+    Context* context = GetScriptContext();
+    return new ScatterModel(context);
+}
+
+// class ScatterModel | File: ../Graphics/ScatterModel.h
+static void Register_ScatterModel(asIScriptEngine* engine)
+{
+    // explicit ScatterModel::ScatterModel(Context* context)
+    engine->RegisterObjectBehaviour("ScatterModel", asBEHAVE_FACTORY, "ScatterModel@+ f()", AS_FUNCTION(ScatterModel__ScatterModel_Contextstar) , AS_CALL_CDECL);
+
+    RegisterSubclass<Drawable, ScatterModel>(engine, "Drawable", "ScatterModel");
+    RegisterSubclass<Component, ScatterModel>(engine, "Component", "ScatterModel");
+    RegisterSubclass<Animatable, ScatterModel>(engine, "Animatable", "ScatterModel");
+    RegisterSubclass<Serializable, ScatterModel>(engine, "Serializable", "ScatterModel");
+    RegisterSubclass<Object, ScatterModel>(engine, "Object", "ScatterModel");
+    RegisterSubclass<RefCounted, ScatterModel>(engine, "RefCounted", "ScatterModel");
+
+    RegisterMembers_ScatterModel<ScatterModel>(engine, "ScatterModel");
+
+    #ifdef REGISTER_CLASS_MANUAL_PART_ScatterModel
+        REGISTER_CLASS_MANUAL_PART_ScatterModel();
+    #endif
+}
+
 // explicit ScrollBar::ScrollBar(Context* context)
 static ScrollBar* ScrollBar__ScrollBar_Contextstar()
 {
@@ -8095,6 +8310,34 @@ static void Register_Menu(asIScriptEngine* engine)
     #endif
 }
 
+// explicit MeshletModel::MeshletModel(Context* context)
+static MeshletModel* MeshletModel__MeshletModel_Contextstar()
+{
+    Context* context = GetScriptContext();
+    return new MeshletModel(context);
+}
+
+// class MeshletModel | File: ../Graphics/MeshletModel.h
+static void Register_MeshletModel(asIScriptEngine* engine)
+{
+    // explicit MeshletModel::MeshletModel(Context* context)
+    engine->RegisterObjectBehaviour("MeshletModel", asBEHAVE_FACTORY, "MeshletModel@+ f()", AS_FUNCTION(MeshletModel__MeshletModel_Contextstar) , AS_CALL_CDECL);
+
+    RegisterSubclass<StaticModel, MeshletModel>(engine, "StaticModel", "MeshletModel");
+    RegisterSubclass<Drawable, MeshletModel>(engine, "Drawable", "MeshletModel");
+    RegisterSubclass<Component, MeshletModel>(engine, "Component", "MeshletModel");
+    RegisterSubclass<Animatable, MeshletModel>(engine, "Animatable", "MeshletModel");
+    RegisterSubclass<Serializable, MeshletModel>(engine, "Serializable", "MeshletModel");
+    RegisterSubclass<Object, MeshletModel>(engine, "Object", "MeshletModel");
+    RegisterSubclass<RefCounted, MeshletModel>(engine, "RefCounted", "MeshletModel");
+
+    RegisterMembers_MeshletModel<MeshletModel>(engine, "MeshletModel");
+
+    #ifdef REGISTER_CLASS_MANUAL_PART_MeshletModel
+        REGISTER_CLASS_MANUAL_PART_MeshletModel();
+    #endif
+}
+
 // explicit ParticleEmitter::ParticleEmitter(Context* context)
 static ParticleEmitter* ParticleEmitter__ParticleEmitter_Contextstar()
 {
@@ -8503,6 +8746,7 @@ void ASRegisterGeneratedClasses(asIScriptEngine* engine)
     Register_DelayedWorldTransform(engine);
     Register_ManifoldPair(engine);
     Register_PhysicsRaycastResult(engine);
+    Register_PhysicsStatistics(engine);
     Register_PhysicsWorldConfig(engine);
 #endif
 
@@ -8553,6 +8797,7 @@ void ASRegisterGeneratedClasses(asIScriptEngine* engine)
     Register_TileMapObject2D(engine);
     Register_TmxLayer2D(engine);
 #endif
+    Register_AdpcmSoundStream(engine);
     Register_AttributeAnimationInfo(engine);
     Register_Audio(engine);
     Register_BufferedSoundStream(engine);
@@ -8572,7 +8817,9 @@ void ASRegisterGeneratedClasses(asIScriptEngine* engine)
     Register_Input(engine);
     Register_Localization(engine);
     Register_Log(engine);
+    Register_MaterialAtlas(engine);
     Register_MessageBox(engine);
+    Register_Metrics(engine);
     Register_NamedPipe(engine);
     Register_OcclusionBuffer(engine);
     Register_OggVorbisSoundStream(engine);
@@ -8621,6 +8868,7 @@ void ASRegisterGeneratedClasses(asIScriptEngine* engine)
     Register_Material(engine);
     Register_ObjectAnimation(engine);
     Register_ParticleEffect(engine);
+    Register_PrefabTemplate(engine);
     Register_ResourceWithMetadata(engine);
     Register_Shader(engine);
     Register_Technique(engine);
@@ -8649,13 +8897,16 @@ void ASRegisterGeneratedClasses(asIScriptEngine* engine)
     Register_LogicComponent(engine);
     Register_Octree(engine);
     Register_Scene(engine);
+    Register_SceneStreamer(engine);
     Register_ScrollView(engine);
+    Register_SignificanceManager(engine);
     Register_SmoothedTransform(engine);
     Register_SoundListener(engine);
     Register_SoundSource(engine);
     Register_SplinePath(engine);
     Register_Sprite(engine);
     Register_Terrain(engine);
+    Register_TerrainStreamer(engine);
     Register_Texture2D(engine);
     Register_Texture2DArray(engine);
     Register_Texture3D(engine);
@@ -8714,6 +8965,7 @@ void ASRegisterGeneratedClasses(asIScriptEngine* engine)
     Register_ListView(engine);
     Register_ProgressBar(engine);
     Register_RibbonTrail(engine);
+    Register_ScatterModel(engine);
     Register_ScrollBar(engine);
     Register_Slider(engine);
     Register_SoundSource3D(engine);
@@ -8757,6 +9009,7 @@ void ASRegisterGeneratedClasses(asIScriptEngine* engine)
 #endif
     Register_AnimatedModel(engine);
     Register_Menu(engine);
+    Register_MeshletModel(engine);
     Register_ParticleEmitter(engine);
     Register_Skybox(engine);
     Register_StaticModelGroup(engine);
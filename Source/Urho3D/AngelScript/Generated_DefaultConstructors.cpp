@@ -368,6 +368,9 @@ void ASRegisterGeneratedDefaultConstructors(asIScriptEngine* engine)
     // PhysicsRaycastResult::PhysicsRaycastResult() | Implicitly-declared
     engine->RegisterObjectBehaviour("PhysicsRaycastResult", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(ASCompatibleConstructor<PhysicsRaycastResult>), AS_CALL_CDECL_OBJFIRST);
 
+    // PhysicsStatistics::PhysicsStatistics() | Implicitly-declared
+    engine->RegisterObjectBehaviour("PhysicsStatistics", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(ASCompatibleConstructor<PhysicsStatistics>), AS_CALL_CDECL_OBJFIRST);
+
     // PhysicsWorldConfig::PhysicsWorldConfig() | File: ../Physics/PhysicsWorld.h
     engine->RegisterObjectBehaviour("PhysicsWorldConfig", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(ASCompatibleConstructor<PhysicsWorldConfig>), AS_CALL_CDECL_OBJFIRST);
 #endif
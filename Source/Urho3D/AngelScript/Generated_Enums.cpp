@@ -585,6 +585,7 @@ static const unsigned UpdateEvent_USE_UPDATE = USE_UPDATE;
 static const unsigned UpdateEvent_USE_POSTUPDATE = USE_POSTUPDATE;
 static const unsigned UpdateEvent_USE_FIXEDUPDATE = USE_FIXEDUPDATE;
 static const unsigned UpdateEvent_USE_FIXEDPOSTUPDATE = USE_FIXEDPOSTUPDATE;
+static const unsigned UpdateEvent_USE_PARALLELUPDATE = USE_PARALLELUPDATE;
 
 // enum VertexMask : unsigned | File: ../Graphics/GraphicsDefs.h
 static const unsigned VertexMask_MASK_NONE = MASK_NONE;
@@ -713,6 +714,12 @@ void ASRegisterGeneratedEnums(asIScriptEngine* engine)
     engine->RegisterEnumValue("CompressedFormat", "CF_PVRTC_RGB_4BPP", CF_PVRTC_RGB_4BPP);
     engine->RegisterEnumValue("CompressedFormat", "CF_PVRTC_RGBA_4BPP", CF_PVRTC_RGBA_4BPP);
 
+    // enum CompressionQuality | File: ../Resource/Image.h
+    engine->RegisterEnum("CompressionQuality");
+    engine->RegisterEnumValue("CompressionQuality", "CQ_FAST", CQ_FAST);
+    engine->RegisterEnumValue("CompressionQuality", "CQ_NORMAL", CQ_NORMAL);
+    engine->RegisterEnumValue("CompressionQuality", "CQ_HIGH", CQ_HIGH);
+
     // enum ControllerAxis : unsigned | File: ../Input/InputConstants.h
     engine->RegisterTypedef("ControllerAxis", "uint");
     engine->RegisterGlobalProperty("const uint CONTROLLER_AXIS_LEFTX", (void*)&ControllerAxis_CONTROLLER_AXIS_LEFTX);
@@ -1309,6 +1316,11 @@ void ASRegisterGeneratedEnums(asIScriptEngine* engine)
     engine->RegisterEnumValue("LockState", "LOCK_SHADOW", LOCK_SHADOW);
     engine->RegisterEnumValue("LockState", "LOCK_SCRATCH", LOCK_SCRATCH);
 
+    // enum LogQueuePolicy | File: ../IO/Log.h
+    engine->RegisterEnum("LogQueuePolicy");
+    engine->RegisterEnumValue("LogQueuePolicy", "LOG_QUEUE_DROP", LOG_QUEUE_DROP);
+    engine->RegisterEnumValue("LogQueuePolicy", "LOG_QUEUE_BLOCK", LOG_QUEUE_BLOCK);
+
     // enum MaterialQuality : unsigned | File: ../Graphics/GraphicsDefs.h
     engine->RegisterTypedef("MaterialQuality", "uint");
     engine->RegisterGlobalProperty("const uint QUALITY_LOW", (void*)&MaterialQuality_QUALITY_LOW);
@@ -1316,6 +1328,11 @@ void ASRegisterGeneratedEnums(asIScriptEngine* engine)
     engine->RegisterGlobalProperty("const uint QUALITY_HIGH", (void*)&MaterialQuality_QUALITY_HIGH);
     engine->RegisterGlobalProperty("const uint QUALITY_MAX", (void*)&MaterialQuality_QUALITY_MAX);
 
+    // enum MetricType | File: ../Core/Metrics.h
+    engine->RegisterEnum("MetricType");
+    engine->RegisterEnumValue("MetricType", "METRIC_COUNTER", METRIC_COUNTER);
+    engine->RegisterEnumValue("MetricType", "METRIC_GAUGE", METRIC_GAUGE);
+
     // enum MouseButton : unsigned | File: ../Input/InputConstants.h
     engine->RegisterTypedef("MouseButton", "uint");
     engine->RegisterGlobalProperty("const uint MOUSEB_NONE", (void*)&MouseButton_MOUSEB_NONE);
@@ -1390,6 +1407,9 @@ void ASRegisterGeneratedEnums(asIScriptEngine* engine)
     engine->RegisterEnumValue("RenderCommandType", "CMD_LIGHTVOLUMES", CMD_LIGHTVOLUMES);
     engine->RegisterEnumValue("RenderCommandType", "CMD_RENDERUI", CMD_RENDERUI);
     engine->RegisterEnumValue("RenderCommandType", "CMD_SENDEVENT", CMD_SENDEVENT);
+    engine->RegisterEnumValue("RenderCommandType", "CMD_FORWARDCLUSTERED", CMD_FORWARDCLUSTERED);
+    engine->RegisterEnumValue("RenderCommandType", "CMD_DEFERREDCLUSTERED", CMD_DEFERREDCLUSTERED);
+    engine->RegisterEnumValue("RenderCommandType", "CMD_COMPUTE", CMD_COMPUTE);
 
     // enum RenderSurfaceUpdateMode | File: ../Graphics/GraphicsDefs.h
     engine->RegisterEnum("RenderSurfaceUpdateMode");
@@ -1698,6 +1718,20 @@ void ASRegisterGeneratedEnums(asIScriptEngine* engine)
     engine->RegisterEnumValue("StencilOp", "OP_INCR", OP_INCR);
     engine->RegisterEnumValue("StencilOp", "OP_DECR", OP_DECR);
 
+    // enum StreamingCellState | File: ../Scene/SceneStreamer.h
+    engine->RegisterEnum("StreamingCellState");
+    engine->RegisterEnumValue("StreamingCellState", "CELL_PRELOADING", CELL_PRELOADING);
+    engine->RegisterEnumValue("StreamingCellState", "CELL_INSTANTIATING", CELL_INSTANTIATING);
+    engine->RegisterEnumValue("StreamingCellState", "CELL_LOADED", CELL_LOADED);
+    engine->RegisterEnumValue("StreamingCellState", "CELL_EMPTY", CELL_EMPTY);
+
+    // enum TerrainTileState | File: ../Graphics/TerrainStreamer.h
+    engine->RegisterEnum("TerrainTileState");
+    engine->RegisterEnumValue("TerrainTileState", "TILE_LOADING", TILE_LOADING);
+    engine->RegisterEnumValue("TerrainTileState", "TILE_BUILDING", TILE_BUILDING);
+    engine->RegisterEnumValue("TerrainTileState", "TILE_LOADED", TILE_LOADED);
+    engine->RegisterEnumValue("TerrainTileState", "TILE_EMPTY", TILE_EMPTY);
+
     // enum TextEffect | File: ../UI/Text.h
     engine->RegisterEnum("TextEffect");
     engine->RegisterEnumValue("TextEffect", "TE_NONE", TE_NONE);
@@ -1762,6 +1796,7 @@ void ASRegisterGeneratedEnums(asIScriptEngine* engine)
     engine->RegisterGlobalProperty("const uint USE_POSTUPDATE", (void*)&UpdateEvent_USE_POSTUPDATE);
     engine->RegisterGlobalProperty("const uint USE_FIXEDUPDATE", (void*)&UpdateEvent_USE_FIXEDUPDATE);
     engine->RegisterGlobalProperty("const uint USE_FIXEDPOSTUPDATE", (void*)&UpdateEvent_USE_FIXEDPOSTUPDATE);
+    engine->RegisterGlobalProperty("const uint USE_PARALLELUPDATE", (void*)&UpdateEvent_USE_PARALLELUPDATE);
 
     // URHO3D_FLAGSET(UpdateEvent, UpdateEventFlags) | File: ../Scene/LogicComponent.h
     engine->RegisterTypedef("UpdateEventFlags", "uint");
@@ -1827,6 +1862,9 @@ void ASRegisterGeneratedEnums(asIScriptEngine* engine)
     engine->RegisterEnumValue("VertexElementType", "TYPE_VECTOR4", TYPE_VECTOR4);
     engine->RegisterEnumValue("VertexElementType", "TYPE_UBYTE4", TYPE_UBYTE4);
     engine->RegisterEnumValue("VertexElementType", "TYPE_UBYTE4_NORM", TYPE_UBYTE4_NORM);
+    engine->RegisterEnumValue("VertexElementType", "TYPE_SHORT2_NORM", TYPE_SHORT2_NORM);
+    engine->RegisterEnumValue("VertexElementType", "TYPE_SHORT4_NORM", TYPE_SHORT4_NORM);
+    engine->RegisterEnumValue("VertexElementType", "TYPE_HALF2", TYPE_HALF2);
     engine->RegisterEnumValue("VertexElementType", "MAX_VERTEX_ELEMENT_TYPES", MAX_VERTEX_ELEMENT_TYPES);
 
     // enum VertexLightVSVariation | File: ../Graphics/Renderer.h
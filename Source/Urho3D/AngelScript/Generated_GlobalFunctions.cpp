@@ -62,6 +62,9 @@ void ASRegisterGeneratedGlobalFunctions(asIScriptEngine* engine)
     // template <class T> T Atan2(T y, T x) | File: ../Math/MathDefs.h
     engine->RegisterGlobalFunction("float Atan2(float, float)", AS_FUNCTIONPR(Atan2, (float, float), float), AS_CALL_CDECL);
 
+    // void BuildMeshlets(PODVector<unsigned>& indices, const PODVector<Vector3>& positions, unsigned indexStart, PODVector<Meshlet>& meshlets) | File: ../Graphics/MeshletBuilder.h
+    // Error: type "PODVector<unsigned>&" can not automatically bind
+
     // void BufferToString(String& dest, const void* data, unsigned size) | File: ../Core/StringUtils.h
     // Error: type "const void*" can not automatically bind
 
@@ -102,12 +105,18 @@ void ASRegisterGeneratedGlobalFunctions(asIScriptEngine* engine)
     // unsigned CountSetBits(unsigned value) | File: ../Math/MathDefs.h
     engine->RegisterGlobalFunction("uint CountSetBits(uint)", AS_FUNCTIONPR(CountSetBits, (unsigned), unsigned), AS_CALL_CDECL);
 
+    // unsigned DecodeAdpcmBlock(short* dest, const unsigned char* src, unsigned blockSize, unsigned channels) | File: ../Audio/Adpcm.h
+    // Error: type "short*" can not automatically bind
+
     // PODVector<unsigned char> DecodeBase64(String encodedString) | File: ../Core/StringUtils.h
     // Error: type "PODVector<unsigned char>" can not automatically bind
 
     // unsigned DecompressData(void* dest, const void* src, unsigned destSize) | File: ../IO/Compression.h
     // Error: type "void*" can not automatically bind
 
+    // bool DecompressImage(unsigned char* rgba, const void* blocks, int width, int height, int depth, CompressedFormat format, WorkQueue* queue = nullptr) | File: ../Resource/Decompress.h
+    // Error: type "unsigned char*" can not automatically bind
+
     // void DecompressImageDXT(unsigned char* rgba, const void* blocks, int width, int height, int depth, CompressedFormat format) | File: ../Resource/Decompress.h
     // Error: type "unsigned char*" can not automatically bind
 
@@ -123,6 +132,9 @@ void ASRegisterGeneratedGlobalFunctions(asIScriptEngine* engine)
     // VectorBuffer DecompressVectorBuffer(VectorBuffer& src) | File: ../IO/Compression.h
     engine->RegisterGlobalFunction("VectorBuffer DecompressVectorBuffer(VectorBuffer&)", AS_FUNCTIONPR(DecompressVectorBuffer, (VectorBuffer&), VectorBuffer), AS_CALL_CDECL);
 
+    // void EncodeAdpcmBlock(unsigned char* dest, const short* src, unsigned frames, unsigned channels, unsigned blockSize, int* stepIndices) | File: ../Audio/Adpcm.h
+    // Error: type "unsigned char*" can not automatically bind
+
     // template <class T> bool Equals(T lhs, T rhs) | File: ../Math/MathDefs.h
     engine->RegisterGlobalFunction("bool Equals(float, float)", AS_FUNCTIONPR(Equals, (float, float), bool), AS_CALL_CDECL);
 
@@ -159,6 +171,9 @@ void ASRegisterGeneratedGlobalFunctions(asIScriptEngine* engine)
     // void GenerateTangents(void* vertexData, unsigned vertexSize, const void* indexData, unsigned indexSize, unsigned indexStart, unsigned indexCount, unsigned normalOffset, unsigned texCoordOffset, unsigned tangentOffset) | File: ../Graphics/Tangent.h
     // Error: type "void*" can not automatically bind
 
+    // unsigned GetAdpcmFramesPerBlock(unsigned blockSize, unsigned channels) | File: ../Audio/Adpcm.h
+    engine->RegisterGlobalFunction("uint GetAdpcmFramesPerBlock(uint, uint)", AS_FUNCTIONPR(GetAdpcmFramesPerBlock, (unsigned, unsigned), unsigned), AS_CALL_CDECL);
+
     // const Vector<String>& GetArguments() | File: ../Core/ProcessUtils.h
     engine->RegisterGlobalFunction("Array<String>@ GetArguments()", AS_FUNCTION(constspVectorlesStringgreamp_GetArguments_void), AS_CALL_CDECL);
 
@@ -207,12 +222,18 @@ void ASRegisterGeneratedGlobalFunctions(asIScriptEngine* engine)
     // String GetOSVersion() | File: ../Core/ProcessUtils.h
     engine->RegisterGlobalFunction("String GetOSVersion()", AS_FUNCTIONPR(GetOSVersion, (), String), AS_CALL_CDECL);
 
+    // unsigned long long GetPerformanceCPUMask() | File: ../Core/ProcessUtils.h
+    engine->RegisterGlobalFunction("uint64 GetPerformanceCPUMask()", AS_FUNCTIONPR(GetPerformanceCPUMask, (), unsigned long long), AS_CALL_CDECL);
+
     // String GetParentPath(const String& path) | File: ../IO/FileSystem.h
     engine->RegisterGlobalFunction("String GetParentPath(const String&in)", AS_FUNCTIONPR(GetParentPath, (const String&), String), AS_CALL_CDECL);
 
     // String GetPath(const String& fullPath) | File: ../IO/FileSystem.h
     engine->RegisterGlobalFunction("String GetPath(const String&in)", AS_FUNCTIONPR(GetPath, (const String&), String), AS_CALL_CDECL);
 
+    // unsigned long long GetPeakMemoryUse() | File: ../Core/ProcessUtils.h
+    engine->RegisterGlobalFunction("uint64 GetPeakMemoryUse()", AS_FUNCTIONPR(GetPeakMemoryUse, (), unsigned long long), AS_CALL_CDECL);
+
     // String GetPlatform() | File: ../Core/ProcessUtils.h
     engine->RegisterGlobalFunction("String GetPlatform()", AS_FUNCTIONPR(GetPlatform, (), String), AS_CALL_CDECL);
 
@@ -284,10 +305,19 @@ void ASRegisterGeneratedGlobalFunctions(asIScriptEngine* engine)
     engine->RegisterGlobalFunction("float Max(float, float)", AS_FUNCTIONPR(Max, (float, float), float), AS_CALL_CDECL);
     engine->RegisterGlobalFunction("int Max(int, int)", AS_FUNCTIONPR(Max, (int, int), int), AS_CALL_CDECL);
 
+    // BoundingBox MergeTransformedBoundingBox(const BoundingBox& box, const Matrix3x4* transforms, unsigned count) | File: ../Math/MathKernels.h
+    // Error: type "const Matrix3x4*" can not automatically bind
+
     // template <class T, class U> T Min(T lhs, U rhs) | File: ../Math/MathDefs.h
     engine->RegisterGlobalFunction("float Min(float, float)", AS_FUNCTIONPR(Min, (float, float), float), AS_CALL_CDECL);
     engine->RegisterGlobalFunction("int Min(int, int)", AS_FUNCTIONPR(Min, (int, int), int), AS_CALL_CDECL);
 
+    // void MultiplyMatrices(const Matrix3x4& lhs, const Matrix3x4* rhs, Matrix3x4* dest, unsigned count) | File: ../Math/MathKernels.h
+    // Error: type "const Matrix3x4*" can not automatically bind
+
+    // void MultiplyMatrices(const Matrix3x4* lhs, const Matrix3x4* rhs, Matrix3x4* dest, unsigned count, unsigned lhsStride = sizeof(Matrix3x4), unsigned rhsStride = sizeof(Matrix3x4), unsigned destStride = sizeof(Matrix3x4)) | File: ../Math/MathKernels.h
+    // Error: type "const Matrix3x4*" can not automatically bind
+
     // unsigned NextPowerOfTwo(unsigned value) | File: ../Math/MathDefs.h
     engine->RegisterGlobalFunction("uint NextPowerOfTwo(uint)", AS_FUNCTIONPR(NextPowerOfTwo, (unsigned), unsigned), AS_CALL_CDECL);
 
@@ -390,6 +420,9 @@ void ASRegisterGeneratedGlobalFunctions(asIScriptEngine* engine)
     // template <class T> T Sign(T value) | File: ../Math/MathDefs.h
     engine->RegisterGlobalFunction("float Sign(float)", AS_FUNCTIONPR(Sign, (float), float), AS_CALL_CDECL);
 
+    // void SimplifyIndices(const PODVector<unsigned>& indices, const PODVector<Vector3>& positions, unsigned targetIndexCount, PODVector<unsigned>& dest, float maxError = 0.02f) | File: ../Graphics/MeshSimplifier.h
+    // Error: type "PODVector<unsigned>&" can not automatically bind
+
     // template <class T> T Sin(T angle) | File: ../Math/MathDefs.h
     engine->RegisterGlobalFunction("float Sin(float)", AS_FUNCTIONPR(Sin, (float), float), AS_CALL_CDECL);
 
@@ -558,6 +591,15 @@ void ASRegisterGeneratedGlobalFunctions(asIScriptEngine* engine)
     // Variant ToVectorVariant(const char* source) | File: ../Core/StringUtils.h
     // Error: type "const char*" can not automatically bind
 
+    // void TransformBoundingBoxes(const Matrix3x4* transforms, const BoundingBox* src, BoundingBox* dest, unsigned count) | File: ../Math/MathKernels.h
+    // Error: type "const Matrix3x4*" can not automatically bind
+
+    // void TransformDirections(const Matrix3x4& transform, const Vector3* src, Vector3* dest, unsigned count, unsigned srcStride = sizeof(Vector3), unsigned destStride = sizeof(Vector3)) | File: ../Math/MathKernels.h
+    // Error: type "const Vector3*" can not automatically bind
+
+    // void TransformPoints(const Matrix3x4& transform, const Vector3* src, Vector3* dest, unsigned count, unsigned srcStride = sizeof(Vector3), unsigned destStride = sizeof(Vector3)) | File: ../Math/MathKernels.h
+    // Error: type "const Vector3*" can not automatically bind
+
     // IntVector2 VectorAbs(const IntVector2& vec) | File: ../Math/Vector2.h
     engine->RegisterGlobalFunction("IntVector2 VectorAbs(const IntVector2&in)", AS_FUNCTIONPR(VectorAbs, (const IntVector2&), IntVector2), AS_CALL_CDECL);
 
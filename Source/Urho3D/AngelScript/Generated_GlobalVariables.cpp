@@ -31,6 +31,9 @@ void ASRegisterGeneratedGlobalVariables(asIScriptEngine* engine)
     // static const unsigned DEBUGHUD_SHOW_EVENTPROFILER | File: ../Engine/DebugHud.h
     engine->RegisterGlobalProperty("const uint DEBUGHUD_SHOW_EVENTPROFILER", (void*)&DEBUGHUD_SHOW_EVENTPROFILER);
 
+    // static const unsigned DEBUGHUD_SHOW_FRAMETIME | File: ../Engine/DebugHud.h
+    engine->RegisterGlobalProperty("const uint DEBUGHUD_SHOW_FRAMETIME", (void*)&DEBUGHUD_SHOW_FRAMETIME);
+
     // static const unsigned DEBUGHUD_SHOW_MEMORY | File: ../Engine/DebugHud.h
     engine->RegisterGlobalProperty("const uint DEBUGHUD_SHOW_MEMORY", (void*)&DEBUGHUD_SHOW_MEMORY);
 
@@ -103,9 +106,15 @@ void ASRegisterGeneratedGlobalVariables(asIScriptEngine* engine)
     // const unsigned ELEMENT_TYPESIZES[] | File: ../Graphics/GraphicsDefs.h
     // Not registered because array
 
+    // static const String EP_AUDIO_THREAD_PRIORITY | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_AUDIO_THREAD_PRIORITY", (void*)&EP_AUDIO_THREAD_PRIORITY);
+
     // static const String EP_AUTOLOAD_PATHS | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_AUTOLOAD_PATHS", (void*)&EP_AUTOLOAD_PATHS);
 
+    // static const String EP_BACKGROUND_LOAD_THREAD_PRIORITY | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_BACKGROUND_LOAD_THREAD_PRIORITY", (void*)&EP_BACKGROUND_LOAD_THREAD_PRIORITY);
+
     // static const String EP_BORDERLESS | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_BORDERLESS", (void*)&EP_BORDERLESS);
 
@@ -145,12 +154,21 @@ void ASRegisterGeneratedGlobalVariables(asIScriptEngine* engine)
     // static const String EP_LOG_QUIET | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_LOG_QUIET", (void*)&EP_LOG_QUIET);
 
+    // static const String EP_LOW_LATENCY_INPUT | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_LOW_LATENCY_INPUT", (void*)&EP_LOW_LATENCY_INPUT);
+
     // static const String EP_LOW_QUALITY_SHADOWS | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_LOW_QUALITY_SHADOWS", (void*)&EP_LOW_QUALITY_SHADOWS);
 
     // static const String EP_MATERIAL_QUALITY | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_MATERIAL_QUALITY", (void*)&EP_MATERIAL_QUALITY);
 
+    // static const String EP_MEMORY_MAP_PACKAGES | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_MEMORY_MAP_PACKAGES", (void*)&EP_MEMORY_MAP_PACKAGES);
+
+    // static const String EP_METRICS_PORT | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_METRICS_PORT", (void*)&EP_METRICS_PORT);
+
     // static const String EP_MONITOR | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_MONITOR", (void*)&EP_MONITOR);
 
@@ -163,6 +181,12 @@ void ASRegisterGeneratedGlobalVariables(asIScriptEngine* engine)
     // static const String EP_PACKAGE_CACHE_DIR | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_PACKAGE_CACHE_DIR", (void*)&EP_PACKAGE_CACHE_DIR);
 
+    // static const String EP_PERFORMANCE_CORES | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_PERFORMANCE_CORES", (void*)&EP_PERFORMANCE_CORES);
+
+    // static const String EP_PIPELINED_FRAMES | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_PIPELINED_FRAMES", (void*)&EP_PIPELINED_FRAMES);
+
     // static const String EP_REFRESH_RATE | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_REFRESH_RATE", (void*)&EP_REFRESH_RATE);
 
@@ -178,6 +202,9 @@ void ASRegisterGeneratedGlobalVariables(asIScriptEngine* engine)
     // static const String EP_RESOURCE_PREFIX_PATHS | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_RESOURCE_PREFIX_PATHS", (void*)&EP_RESOURCE_PREFIX_PATHS);
 
+    // static const String EP_SHADER_ARCHIVE | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_SHADER_ARCHIVE", (void*)&EP_SHADER_ARCHIVE);
+
     // static const String EP_SHADER_CACHE_DIR | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_SHADER_CACHE_DIR", (void*)&EP_SHADER_CACHE_DIR);
 
@@ -193,6 +220,9 @@ void ASRegisterGeneratedGlobalVariables(asIScriptEngine* engine)
     // static const String EP_SOUND_INTERPOLATION | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_SOUND_INTERPOLATION", (void*)&EP_SOUND_INTERPOLATION);
 
+    // static const String EP_SOUND_MAX_VOICES | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_SOUND_MAX_VOICES", (void*)&EP_SOUND_MAX_VOICES);
+
     // static const String EP_SOUND_MIX_RATE | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_SOUND_MIX_RATE", (void*)&EP_SOUND_MIX_RATE);
 
@@ -244,6 +274,15 @@ void ASRegisterGeneratedGlobalVariables(asIScriptEngine* engine)
     // static const String EP_WORKER_THREADS | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_WORKER_THREADS", (void*)&EP_WORKER_THREADS);
 
+    // static const String EP_WORKER_THREAD_AFFINITY | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_WORKER_THREAD_AFFINITY", (void*)&EP_WORKER_THREAD_AFFINITY);
+
+    // static const String EP_WORKER_THREAD_PINNING | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_WORKER_THREAD_PINNING", (void*)&EP_WORKER_THREAD_PINNING);
+
+    // static const String EP_WORKER_THREAD_PRIORITY | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_WORKER_THREAD_PRIORITY", (void*)&EP_WORKER_THREAD_PRIORITY);
+
     // static const unsigned FIRST_LOCAL_ID | File: ../Scene/Scene.h
     engine->RegisterGlobalProperty("const uint FIRST_LOCAL_ID", (void*)&FIRST_LOCAL_ID);
 
@@ -265,6 +304,9 @@ void ASRegisterGeneratedGlobalVariables(asIScriptEngine* engine)
     // static const unsigned LAST_REPLICATED_ID | File: ../Scene/Scene.h
     engine->RegisterGlobalProperty("const uint LAST_REPLICATED_ID", (void*)&LAST_REPLICATED_ID);
 
+    // static const unsigned LATESTDATA_HISTORY | File: ../Scene/ReplicationState.h
+    engine->RegisterGlobalProperty("const uint LATESTDATA_HISTORY", (void*)&LATESTDATA_HISTORY);
+
     // const VertexElement LEGACY_VERTEXELEMENTS[] | File: ../Graphics/GraphicsDefs.h
     // Not registered because array
 
@@ -469,6 +511,9 @@ void ASRegisterGeneratedGlobalVariables(asIScriptEngine* engine)
     // const StringHash PSP_SHADOWCUBEADJUST | File: ../Graphics/GraphicsDefs.h
     engine->RegisterGlobalProperty("const StringHash PSP_SHADOWCUBEADJUST", (void*)&PSP_SHADOWCUBEADJUST);
 
+    // const StringHash PSP_SHADOWCUBESCALE | File: ../Graphics/GraphicsDefs.h
+    engine->RegisterGlobalProperty("const StringHash PSP_SHADOWCUBESCALE", (void*)&PSP_SHADOWCUBESCALE);
+
     // const StringHash PSP_SHADOWDEPTHFADE | File: ../Graphics/GraphicsDefs.h
     engine->RegisterGlobalProperty("const StringHash PSP_SHADOWDEPTHFADE", (void*)&PSP_SHADOWDEPTHFADE);
 
@@ -635,6 +680,9 @@ void ASRegisterGeneratedGlobalVariables(asIScriptEngine* engine)
     // static const int MSG_IDENTITY | File: ../Network/Protocol.h
     engine->RegisterGlobalProperty("const int MSG_IDENTITY", (void*)&MSG_IDENTITY);
 
+    // static const int MSG_LATESTDATAACK | File: ../Network/Protocol.h
+    engine->RegisterGlobalProperty("const int MSG_LATESTDATAACK", (void*)&MSG_LATESTDATAACK);
+
     // static const int MSG_LOADSCENE | File: ../Network/Protocol.h
     engine->RegisterGlobalProperty("const int MSG_LOADSCENE", (void*)&MSG_LOADSCENE);
 
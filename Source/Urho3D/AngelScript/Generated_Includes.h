@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "../Audio/Adpcm.h"
+#include "../Audio/AdpcmSoundStream.h"
 #include "../Audio/Audio.h"
 #include "../Audio/AudioDefs.h"
 #include "../Audio/BufferedSoundStream.h"
@@ -11,6 +13,7 @@
 #include "../Audio/SoundSource.h"
 #include "../Audio/SoundSource3D.h"
 #include "../Audio/SoundStream.h"
+#include "../Audio/StreamDecoder.h"
 #include "../Container/Allocator.h"
 #include "../Container/Hash.h"
 #include "../Container/HashBase.h"
@@ -24,6 +27,7 @@
 #include "../Core/Condition.h"
 #include "../Core/Context.h"
 #include "../Core/EventProfiler.h"
+#include "../Core/Metrics.h"
 #include "../Core/Mutex.h"
 #include "../Core/Object.h"
 #include "../Core/ProcessUtils.h"
@@ -63,6 +67,10 @@
 #include "../Graphics/IndexBuffer.h"
 #include "../Graphics/Light.h"
 #include "../Graphics/Material.h"
+#include "../Graphics/MaterialAtlas.h"
+#include "../Graphics/MeshSimplifier.h"
+#include "../Graphics/MeshletBuilder.h"
+#include "../Graphics/MeshletModel.h"
 #include "../Graphics/Model.h"
 #include "../Graphics/OcclusionBuffer.h"
 #include "../Graphics/Octree.h"
@@ -73,9 +81,11 @@
 #include "../Graphics/RenderSurface.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/RibbonTrail.h"
+#include "../Graphics/ScatterModel.h"
 #include "../Graphics/Shader.h"
 #include "../Graphics/ShaderPrecache.h"
 #include "../Graphics/ShaderVariation.h"
+#include "../Graphics/SignificanceManager.h"
 #include "../Graphics/Skeleton.h"
 #include "../Graphics/Skybox.h"
 #include "../Graphics/StaticModel.h"
@@ -84,6 +94,7 @@
 #include "../Graphics/Technique.h"
 #include "../Graphics/Terrain.h"
 #include "../Graphics/TerrainPatch.h"
+#include "../Graphics/TerrainStreamer.h"
 #include "../Graphics/Texture.h"
 #include "../Graphics/Texture2D.h"
 #include "../Graphics/Texture2DArray.h"
@@ -206,9 +217,11 @@
 #include "../Scene/LogicComponent.h"
 #include "../Scene/Node.h"
 #include "../Scene/ObjectAnimation.h"
+#include "../Scene/PrefabTemplate.h"
 #include "../Scene/ReplicationState.h"
 #include "../Scene/Scene.h"
 #include "../Scene/SceneResolver.h"
+#include "../Scene/SceneStreamer.h"
 #include "../Scene/Serializable.h"
 #include "../Scene/SmoothedTransform.h"
 #include "../Scene/SplinePath.h"
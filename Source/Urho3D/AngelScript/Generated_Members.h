@@ -147,6 +147,9 @@ template <class T> void RegisterMembers_AnimationTrack(asIScriptEngine* engine,
     // void AnimationTrack::InsertKeyFrame(unsigned index, const AnimationKeyFrame& keyFrame)
     engine->RegisterObjectMethod(className, "void InsertKeyFrame(uint, const AnimationKeyFrame&in)", AS_METHODPR(T, InsertKeyFrame, (unsigned, const AnimationKeyFrame&), void), AS_CALL_THISCALL);
 
+    // bool AnimationTrack::IsCompressed() const
+    engine->RegisterObjectMethod(className, "bool IsCompressed() const", AS_METHODPR(T, IsCompressed, () const, bool), AS_CALL_THISCALL);
+
     // void AnimationTrack::RemoveAllKeyFrames()
     engine->RegisterObjectMethod(className, "void RemoveAllKeyFrames()", AS_METHODPR(T, RemoveAllKeyFrames, (), void), AS_CALL_THISCALL);
 
@@ -436,8 +439,8 @@ template <class T> void RegisterMembers_BatchQueue(asIScriptEngine* engine, cons
     // void BatchQueue::SortFrontToBack()
     engine->RegisterObjectMethod(className, "void SortFrontToBack()", AS_METHODPR(T, SortFrontToBack, (), void), AS_CALL_THISCALL);
 
-    // HashMap<BatchGroupKey, BatchGroup> BatchQueue::batchGroups_
-    // Error: type "HashMap<BatchGroupKey, BatchGroup>" can not automatically bind
+    // FlatHashMap<BatchGroupKey, BatchGroup> BatchQueue::batchGroups_
+    // Error: type "FlatHashMap<BatchGroupKey, BatchGroup>" can not automatically bind
     // HashMap<unsigned, unsigned> BatchQueue::shaderRemapping_
     // Error: type "HashMap<unsigned, unsigned>" can not automatically bind
     // HashMap<unsigned short, unsigned short> BatchQueue::materialRemapping_
@@ -947,7 +950,7 @@ template <class T> void RegisterMembers_ColorFrame(asIScriptEngine* engine, cons
 // struct CompressedLevel | File: ../Resource/Image.h
 template <class T> void RegisterMembers_CompressedLevel(asIScriptEngine* engine, const char* className)
 {
-    // bool CompressedLevel::Decompress(unsigned char* dest) const
+    // bool CompressedLevel::Decompress(unsigned char* dest, WorkQueue* queue = nullptr) const
     // Error: type "unsigned char*" can not automatically bind
 
     // unsigned char* CompressedLevel::data_
@@ -1227,8 +1230,12 @@ template <class T> CScriptArray* Deserializer_StringVector_ReadStringVector_void
 // class Deserializer | File: ../IO/Deserializer.h
 template <class T> void RegisterMembers_Deserializer(asIScriptEngine* engine, const char* className)
 {
+    // virtual const unsigned char* Deserializer::GetReadPointer() const
+    // Error: type "const unsigned char*" can not automatically bind
     // virtual unsigned Deserializer::Read(void* dest, unsigned size) = 0
     // Error: type "void*" can not automatically bind
+    // const unsigned char* Deserializer::ReadBlock(unsigned& size, PODVector<unsigned char>& storage)
+    // Error: type "unsigned&" can not automatically bind
     // PODVector<unsigned char> Deserializer::ReadBuffer()
     // Error: type "PODVector<unsigned char>" can not automatically bind
     // VariantVector Deserializer::ReadVariantVector()
@@ -2389,6 +2396,9 @@ template <class T> void RegisterMembers_LightBatchQueue(asIScriptEngine* engine,
     // bool LightBatchQueue::negative_
     engine->RegisterObjectProperty(className, "bool negative", offsetof(T, negative_));
 
+    // IntRect LightBatchQueue::shadowMapRect_
+    engine->RegisterObjectProperty(className, "IntRect shadowMapRect", offsetof(T, shadowMapRect_));
+
     // BatchQueue LightBatchQueue::litBaseBatches_
     engine->RegisterObjectProperty(className, "BatchQueue litBaseBatches", offsetof(T, litBaseBatches_));
 
@@ -3185,12 +3195,20 @@ template <class T> void RegisterMembers_Octant(asIScriptEngine* engine, const ch
     // bool Octant::IsEmpty()
     engine->RegisterObjectMethod(className, "bool IsEmpty()", AS_METHODPR(T, IsEmpty, (), bool), AS_CALL_THISCALL);
 
+    // void Octant::LinkDrawable(Drawable* drawable, const BoundingBox& box)
+    engine->RegisterObjectMethod(className, "void LinkDrawable(Drawable@+, const BoundingBox&in)", AS_METHODPR(T, LinkDrawable, (Drawable*, const BoundingBox&), void), AS_CALL_THISCALL);
+
     // void Octant::RemoveDrawable(Drawable* drawable, bool resetOctant = true)
     engine->RegisterObjectMethod(className, "void RemoveDrawable(Drawable@+, bool = true)", AS_METHODPR(T, RemoveDrawable, (Drawable*, bool), void), AS_CALL_THISCALL);
 
     // void Octant::ResetRoot()
     engine->RegisterObjectMethod(className, "void ResetRoot()", AS_METHODPR(T, ResetRoot, (), void), AS_CALL_THISCALL);
 
+    // void Octant::UpdateDrawableBounds(Drawable* drawable, const BoundingBox& box)
+    engine->RegisterObjectMethod(className, "void UpdateDrawableBounds(Drawable@+, const BoundingBox&in)", AS_METHODPR(T, UpdateDrawableBounds, (Drawable*, const BoundingBox&), void), AS_CALL_THISCALL);
+
+    // void Octant::UpdateDrawableViewMask(Drawable* drawable)
+    engine->RegisterObjectMethod(className, "void UpdateDrawableViewMask(Drawable@+)", AS_METHODPR(T, UpdateDrawableViewMask, (Drawable*), void), AS_CALL_THISCALL);
     #ifdef REGISTER_MEMBERS_MANUAL_PART_Octant
         REGISTER_MEMBERS_MANUAL_PART_Octant();
     #endif
@@ -3199,6 +3217,9 @@ template <class T> void RegisterMembers_Octant(asIScriptEngine* engine, const ch
 // class OctreeQuery | File: ../Graphics/OctreeQuery.h
 template <class T> void RegisterMembers_OctreeQuery(asIScriptEngine* engine, const char* className)
 {
+    // virtual const Frustum* OctreeQuery::GetDrawableFrustum() const
+    // Error: type "const Frustum*" can not automatically bind
+
     // virtual void OctreeQuery::TestDrawables(Drawable** start, Drawable** end, bool inside) = 0
     // Error: type "Drawable**" can not automatically bind
 
@@ -4032,6 +4053,12 @@ template <class T> void RegisterMembers_RenderPathCommand(asIScriptEngine* engin
     // String RenderPathCommand::pixelShaderDefines_
     engine->RegisterObjectProperty(className, "String pixelShaderDefines", offsetof(T, pixelShaderDefines_));
 
+    // String RenderPathCommand::computeShaderName_
+    engine->RegisterObjectProperty(className, "String computeShaderName", offsetof(T, computeShaderName_));
+
+    // String RenderPathCommand::computeShaderDefines_
+    engine->RegisterObjectProperty(className, "String computeShaderDefines", offsetof(T, computeShaderDefines_));
+
     // String RenderPathCommand::depthStencilName_
     engine->RegisterObjectProperty(className, "String depthStencilName", offsetof(T, depthStencilName_));
 
@@ -4065,6 +4092,9 @@ template <class T> void RegisterMembers_RenderPathCommand(asIScriptEngine* engin
     // bool RenderPathCommand::vertexLights_
     engine->RegisterObjectProperty(className, "bool vertexLights", offsetof(T, vertexLights_));
 
+    // bool RenderPathCommand::async_
+    engine->RegisterObjectProperty(className, "bool async", offsetof(T, async_));
+
     // String RenderPathCommand::eventName_
     engine->RegisterObjectProperty(className, "String eventName", offsetof(T, eventName_));
 
@@ -4115,6 +4145,9 @@ template <class T> void RegisterMembers_RenderTargetInfo(asIScriptEngine* engine
     // bool RenderTargetInfo::persistent_
     engine->RegisterObjectProperty(className, "bool persistent", offsetof(T, persistent_));
 
+    // bool RenderTargetInfo::compute_
+    engine->RegisterObjectProperty(className, "bool compute", offsetof(T, compute_));
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_RenderTargetInfo
         REGISTER_MEMBERS_MANUAL_PART_RenderTargetInfo();
     #endif
@@ -4566,8 +4599,13 @@ template <class T> void RegisterMembers_SourceBatch(asIScriptEngine* engine, con
     // SourceBatch& SourceBatch::operator =(const SourceBatch& rhs)
     engine->RegisterObjectMethod(className, "SourceBatch& opAssign(const SourceBatch&in)", AS_METHODPR(T, operator=, (const SourceBatch&), SourceBatch&), AS_CALL_THISCALL);
 
+    // Geometry* SourceBatch::GetShadowGeometry() const
+    engine->RegisterObjectMethod(className, "Geometry@+ GetShadowGeometry() const", AS_METHODPR(T, GetShadowGeometry, () const, Geometry*), AS_CALL_THISCALL);
+
     // Geometry* SourceBatch::geometry_
     // Not registered because pointer
+    // Geometry* SourceBatch::shadowGeometry_
+    // Not registered because pointer
     // SharedPtr<Material> SourceBatch::material_
     // Error: type "SharedPtr<Material>" can not automatically bind
     // const Matrix3x4* SourceBatch::worldTransform_
@@ -5065,6 +5103,9 @@ template <class T> void RegisterMembers_String(asIScriptEngine* engine, const ch
     // static const unsigned String::NPOS
     engine->SetDefaultNamespace(className);engine->RegisterGlobalProperty("const uint NPOS", (void*)&T::NPOS);engine->SetDefaultNamespace("");
 
+    // static const unsigned String::LOCAL_CAPACITY
+    engine->SetDefaultNamespace(className);engine->RegisterGlobalProperty("const uint LOCAL_CAPACITY", (void*)&T::LOCAL_CAPACITY);engine->SetDefaultNamespace("");
+
     // static const unsigned String::MIN_CAPACITY
     engine->SetDefaultNamespace(className);engine->RegisterGlobalProperty("const uint MIN_CAPACITY", (void*)&T::MIN_CAPACITY);engine->SetDefaultNamespace("");
 
@@ -5129,10 +5170,10 @@ template <class T> void RegisterMembers_StringHash(asIScriptEngine* engine, cons
     // bool StringHash::operator <(const StringHash& rhs) const
     engine->RegisterObjectMethod(className, "int opCmp(const StringHash& in) const", AS_FUNCTION_OBJFIRST(StringHash_bool_operatorles_constspStringHashamp<T>), AS_CALL_CDECL_OBJFIRST);
 
-    // static unsigned StringHash::Calculate(const char* str, unsigned hash = 0)
+    // static constexpr unsigned StringHash::Calculate(const char* str, unsigned hash = 0)
     // Error: type "const char*" can not automatically bind
-    // static StringHashRegister* StringHash::GetGlobalStringHashRegister()
-    // Error: type "StringHashRegister*" can not automatically bind
+    // static BoundedStringHashRegister* StringHash::GetGlobalStringHashRegister()
+    // Error: type "BoundedStringHashRegister*" can not automatically bind
 
     // static const StringHash StringHash::ZERO
     engine->SetDefaultNamespace(className);engine->RegisterGlobalProperty("const StringHash ZERO", (void*)&T::ZERO);engine->SetDefaultNamespace("");
@@ -5202,12 +5243,24 @@ template <class T> void RegisterMembers_TextureFrame(asIScriptEngine* engine, co
 // class Thread | File: ../Core/Thread.h
 template <class T> void RegisterMembers_Thread(asIScriptEngine* engine, const char* className)
 {
+    // void Thread::ApplyStartParameters()
+    // Not registered because have @nobind mark
+
     // bool Thread::IsStarted() const
     engine->RegisterObjectMethod(className, "bool IsStarted() const", AS_METHODPR(T, IsStarted, () const, bool), AS_CALL_THISCALL);
 
+    // unsigned long long Thread::GetAffinity() const
+    engine->RegisterObjectMethod(className, "uint64 GetAffinity() const", AS_METHODPR(T, GetAffinity, () const, unsigned long long), AS_CALL_THISCALL);
+
+    // int Thread::GetPriority() const
+    engine->RegisterObjectMethod(className, "int GetPriority() const", AS_METHODPR(T, GetPriority, () const, int), AS_CALL_THISCALL);
+
     // bool Thread::Run()
     engine->RegisterObjectMethod(className, "bool Run()", AS_METHODPR(T, Run, (), bool), AS_CALL_THISCALL);
 
+    // void Thread::SetAffinity(unsigned long long mask)
+    engine->RegisterObjectMethod(className, "void SetAffinity(uint64)", AS_METHODPR(T, SetAffinity, (unsigned long long), void), AS_CALL_THISCALL);
+
     // void Thread::SetPriority(int priority)
     engine->RegisterObjectMethod(className, "void SetPriority(int)", AS_METHODPR(T, SetPriority, (int), void), AS_CALL_THISCALL);
 
@@ -5226,6 +5279,12 @@ template <class T> void RegisterMembers_Thread(asIScriptEngine* engine, const ch
     // static bool Thread::IsMainThread()
     engine->SetDefaultNamespace(className);engine->RegisterGlobalFunction("bool IsMainThread()", AS_FUNCTIONPR(T::IsMainThread, (), bool), AS_CALL_CDECL);engine->SetDefaultNamespace("");
 
+    // static void Thread::SetCurrentThreadPriority(int priority)
+    engine->SetDefaultNamespace(className);engine->RegisterGlobalFunction("void SetCurrentThreadPriority(int)", AS_FUNCTIONPR(T::SetCurrentThreadPriority, (int), void), AS_CALL_CDECL);engine->SetDefaultNamespace("");
+
+    // static void Thread::SetCurrentThreadAffinity(unsigned long long mask)
+    engine->SetDefaultNamespace(className);engine->RegisterGlobalFunction("void SetCurrentThreadAffinity(uint64)", AS_FUNCTIONPR(T::SetCurrentThreadAffinity, (unsigned long long), void), AS_CALL_CDECL);engine->SetDefaultNamespace("");
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_Thread
         REGISTER_MEMBERS_MANUAL_PART_Thread();
     #endif
@@ -5670,6 +5729,9 @@ template <class T> void RegisterMembers_Variant(asIScriptEngine* engine, const c
     // Variant& Variant::operator =(const Variant& rhs)
     engine->RegisterObjectMethod(className, "Variant& opAssign(const Variant&in)", AS_METHODPR(T, operator=, (const Variant&), Variant&), AS_CALL_THISCALL);
 
+    // Variant& Variant::operator =(Variant&& rhs) noexcept
+    // Error: type "Variant&&" can not automatically bind
+
     // Variant& Variant::operator =(int rhs)
     engine->RegisterObjectMethod(className, "Variant& opAssign(int)", AS_METHODPR(T, operator=, (int), Variant&), AS_CALL_THISCALL);
 
@@ -7081,8 +7143,13 @@ template <class T> void RegisterMembers_PackageDownload(asIScriptEngine* engine,
 {
     // SharedPtr<File> PackageDownload::file_
     // Error: type "SharedPtr<File>" can not automatically bind
-    // HashSet<unsigned> PackageDownload::receivedFragments_
-    // Error: type "HashSet<unsigned>" can not automatically bind
+    // SharedPtr<File> PackageDownload::bitmapFile_
+    // Error: type "SharedPtr<File>" can not automatically bind
+    // PODVector<unsigned char> PackageDownload::receivedFragments_
+    // Error: type "PODVector<unsigned char>" can not automatically bind
+
+    // unsigned PackageDownload::numReceivedFragments_
+    engine->RegisterObjectProperty(className, "uint numReceivedFragments", offsetof(T, numReceivedFragments_));
 
     // String PackageDownload::name_
     engine->RegisterObjectProperty(className, "String name", offsetof(T, name_));
@@ -7113,6 +7180,12 @@ template <class T> void RegisterMembers_PackageUpload(asIScriptEngine* engine, c
     // unsigned PackageUpload::totalFragments_
     engine->RegisterObjectProperty(className, "uint totalFragments", offsetof(T, totalFragments_));
 
+    // PODVector<unsigned char> PackageUpload::skipFragments_
+    // Error: type "PODVector<unsigned char>" can not automatically bind
+
+    // bool PackageUpload::compress_
+    engine->RegisterObjectProperty(className, "bool compress", offsetof(T, compress_));
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_PackageUpload
         REGISTER_MEMBERS_MANUAL_PART_PackageUpload();
     #endif
@@ -7200,6 +7273,59 @@ template <class T> void RegisterMembers_PhysicsRaycastResult(asIScriptEngine* en
     #endif
 }
 
+// struct PhysicsStatistics | File: ../Physics/PhysicsWorld.h
+template <class T> void RegisterMembers_PhysicsStatistics(asIScriptEngine* engine, const char* className)
+{
+    // unsigned PhysicsStatistics::numSteps_
+    engine->RegisterObjectProperty(className, "uint numSteps", offsetof(T, numSteps_));
+
+    // unsigned PhysicsStatistics::numBroadphasePairs_
+    engine->RegisterObjectProperty(className, "uint numBroadphasePairs", offsetof(T, numBroadphasePairs_));
+
+    // unsigned PhysicsStatistics::numNarrowphaseTests_
+    engine->RegisterObjectProperty(className, "uint numNarrowphaseTests", offsetof(T, numNarrowphaseTests_));
+
+    // unsigned PhysicsStatistics::numManifolds_
+    engine->RegisterObjectProperty(className, "uint numManifolds", offsetof(T, numManifolds_));
+
+    // unsigned PhysicsStatistics::numContacts_
+    engine->RegisterObjectProperty(className, "uint numContacts", offsetof(T, numContacts_));
+
+    // unsigned PhysicsStatistics::numIslands_
+    engine->RegisterObjectProperty(className, "uint numIslands", offsetof(T, numIslands_));
+
+    // unsigned PhysicsStatistics::numConstraints_
+    engine->RegisterObjectProperty(className, "uint numConstraints", offsetof(T, numConstraints_));
+
+    // unsigned PhysicsStatistics::numSolverIterations_
+    engine->RegisterObjectProperty(className, "uint numSolverIterations", offsetof(T, numSolverIterations_));
+
+    // float PhysicsStatistics::stepTime_
+    engine->RegisterObjectProperty(className, "float stepTime", offsetof(T, stepTime_));
+
+    // float PhysicsStatistics::collisionTime_
+    engine->RegisterObjectProperty(className, "float collisionTime", offsetof(T, collisionTime_));
+
+    // float PhysicsStatistics::broadphaseTime_
+    engine->RegisterObjectProperty(className, "float broadphaseTime", offsetof(T, broadphaseTime_));
+
+    // float PhysicsStatistics::narrowphaseTime_
+    engine->RegisterObjectProperty(className, "float narrowphaseTime", offsetof(T, narrowphaseTime_));
+
+    // float PhysicsStatistics::islandTime_
+    engine->RegisterObjectProperty(className, "float islandTime", offsetof(T, islandTime_));
+
+    // float PhysicsStatistics::solveTime_
+    engine->RegisterObjectProperty(className, "float solveTime", offsetof(T, solveTime_));
+
+    // float PhysicsStatistics::integrateTime_
+    engine->RegisterObjectProperty(className, "float integrateTime", offsetof(T, integrateTime_));
+
+    #ifdef REGISTER_MEMBERS_MANUAL_PART_PhysicsStatistics
+        REGISTER_MEMBERS_MANUAL_PART_PhysicsStatistics();
+    #endif
+}
+
 // struct PhysicsWorldConfig | File: ../Physics/PhysicsWorld.h
 template <class T> void RegisterMembers_PhysicsWorldConfig(asIScriptEngine* engine, const char* className)
 {
@@ -7326,6 +7452,8 @@ template <class T> void RegisterMembers_SourceBatch2D(asIScriptEngine* engine, c
     // Error: type "SharedPtr<Material>" can not automatically bind
     // Vector<Vertex2D> SourceBatch2D::vertices_
     // Error: type "Vector<Vertex2D>" can not automatically bind
+    // PODVector<SpriteInstance2D> SourceBatch2D::instances_
+    // Error: type "PODVector<SpriteInstance2D>" can not automatically bind
 
     // float SourceBatch2D::distance_
     engine->RegisterObjectProperty(className, "float distance", offsetof(T, distance_));
@@ -7333,6 +7461,9 @@ template <class T> void RegisterMembers_SourceBatch2D(asIScriptEngine* engine, c
     // int SourceBatch2D::drawOrder_
     engine->RegisterObjectProperty(className, "int drawOrder", offsetof(T, drawOrder_));
 
+    // unsigned SourceBatch2D::sortIndex_
+    engine->RegisterObjectProperty(className, "uint sortIndex", offsetof(T, sortIndex_));
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_SourceBatch2D
         REGISTER_MEMBERS_MANUAL_PART_SourceBatch2D();
     #endif
@@ -7400,8 +7531,14 @@ template <class T> void RegisterMembers_ViewBatchInfo2D(asIScriptEngine* engine,
 {
     // SharedPtr<VertexBuffer> ViewBatchInfo2D::vertexBuffer_
     // Error: type "SharedPtr<VertexBuffer>" can not automatically bind
+    // SharedPtr<VertexBuffer> ViewBatchInfo2D::instanceBuffer_
+    // Error: type "SharedPtr<VertexBuffer>" can not automatically bind
     // PODVector<const SourceBatch2D*> ViewBatchInfo2D::sourceBatches_
     // Error: type "PODVector<const SourceBatch2D*>" can not automatically bind
+    // PODVector<const SourceBatch2D*> ViewBatchInfo2D::previousSourceBatches_
+    // Error: type "PODVector<const SourceBatch2D*>" can not automatically bind
+    // PODVector<const SourceBatch2D*> ViewBatchInfo2D::newSourceBatches_
+    // Error: type "PODVector<const SourceBatch2D*>" can not automatically bind
     // PODVector<float> ViewBatchInfo2D::distances_
     // Error: type "PODVector<float>" can not automatically bind
     // Vector<SharedPtr<Material>> ViewBatchInfo2D::materials_
@@ -7418,6 +7555,9 @@ template <class T> void RegisterMembers_ViewBatchInfo2D(asIScriptEngine* engine,
     // unsigned ViewBatchInfo2D::vertexCount_
     engine->RegisterObjectProperty(className, "uint vertexCount", offsetof(T, vertexCount_));
 
+    // unsigned ViewBatchInfo2D::instanceCount_
+    engine->RegisterObjectProperty(className, "uint instanceCount", offsetof(T, instanceCount_));
+
     // unsigned ViewBatchInfo2D::batchUpdatedFrameNumber_
     engine->RegisterObjectProperty(className, "uint batchUpdatedFrameNumber", offsetof(T, batchUpdatedFrameNumber_));
 
@@ -7618,8 +7758,8 @@ template <class T> void RegisterMembers_BatchGroup(asIScriptEngine* engine, cons
     // void BatchGroup::SetInstancingData(void* lockedData, unsigned stride, unsigned& freeIndex)
     // Error: type "void*" can not automatically bind
 
-    // void BatchGroup::AddTransforms(const Batch& batch)
-    engine->RegisterObjectMethod(className, "void AddTransforms(const Batch&in)", AS_METHODPR(T, AddTransforms, (const Batch&), void), AS_CALL_THISCALL);
+    // void BatchGroup::AddTransforms(const Batch& batch, unsigned textureIndex = 0)
+    engine->RegisterObjectMethod(className, "void AddTransforms(const Batch&in, uint = 0)", AS_METHODPR(T, AddTransforms, (const Batch&, unsigned), void), AS_CALL_THISCALL);
 
     // PODVector<InstanceData> BatchGroup::instances_
     // Error: type "PODVector<InstanceData>" can not automatically bind
@@ -7697,6 +7837,8 @@ template <class T> void RegisterMembers_Context(asIScriptEngine* engine, const c
     // Error: type "const char*" can not automatically bind
     // void Context::RemoveAttribute(StringHash objectType, const char* name)
     // Error: type "const char*" can not automatically bind
+    // void Context::SetAttributeMetadata(StringHash objectType, const char* name, StringHash key, const Variant& value)
+    // Error: type "const char*" can not automatically bind
     // void Context::UpdateAttributeDefaultValue(StringHash objectType, const char* name, const Variant& defaultValue)
     // Error: type "const char*" can not automatically bind
 
@@ -7730,6 +7872,9 @@ template <class T> void RegisterMembers_Context(asIScriptEngine* engine, const c
     // const String& Context::GetTypeName(StringHash objectType) const
     engine->RegisterObjectMethod(className, "const String& GetTypeName(StringHash) const", AS_METHODPR(T, GetTypeName, (StringHash) const, const String&), AS_CALL_THISCALL);
 
+    // VariantMap& Context::GetTypedEventDataMap()
+    engine->RegisterObjectMethod(className, "VariantMap& GetTypedEventDataMap()", AS_METHODPR(T, GetTypedEventDataMap, (), VariantMap&), AS_CALL_THISCALL);
+
     // void Context::RegisterFactory(ObjectFactory* factory)
     engine->RegisterObjectMethod(className, "void RegisterFactory(ObjectFactory@+)", AS_METHODPR(T, RegisterFactory, (ObjectFactory*), void), AS_CALL_THISCALL);
 
@@ -7773,6 +7918,8 @@ template <class T> void RegisterMembers_Context(asIScriptEngine* engine, const c
     // Not registered because template
     // template <class T> void Context::RemoveSubsystem()
     // Not registered because template
+    // template <class T> void Context::SetAttributeMetadata(const char* name, StringHash key, const Variant& value)
+    // Not registered because template
     // template <class T> void Context::UpdateAttributeDefaultValue(const char* name, const Variant& defaultValue)
     // Not registered because template
 
@@ -7918,6 +8065,8 @@ template <class T> void RegisterMembers_NodeReplicationState(asIScriptEngine* en
     // Error: type "HashSet<StringHash>" can not automatically bind
     // HashMap<unsigned, ComponentReplicationState> NodeReplicationState::componentStates_
     // Error: type "HashMap<unsigned, ComponentReplicationState>" can not automatically bind
+    // Vector<PODVector<unsigned>> NodeReplicationState::latestDataHistory_
+    // Error: type "Vector<PODVector<unsigned>>" can not automatically bind
 
     // DirtyBits NodeReplicationState::dirtyAttributes_
     engine->RegisterObjectProperty(className, "DirtyBits dirtyAttributes", offsetof(T, dirtyAttributes_));
@@ -7928,6 +8077,12 @@ template <class T> void RegisterMembers_NodeReplicationState(asIScriptEngine* en
     // bool NodeReplicationState::markedDirty_
     engine->RegisterObjectProperty(className, "bool markedDirty", offsetof(T, markedDirty_));
 
+    // unsigned char NodeReplicationState::latestDataSequence_
+    engine->RegisterObjectProperty(className, "uint8 latestDataSequence", offsetof(T, latestDataSequence_));
+
+    // int NodeReplicationState::ackedLatestData_
+    engine->RegisterObjectProperty(className, "int ackedLatestData", offsetof(T, ackedLatestData_));
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_NodeReplicationState
         REGISTER_MEMBERS_MANUAL_PART_NodeReplicationState();
     #endif
@@ -7961,6 +8116,10 @@ template <class T> void RegisterMembers_Object(asIScriptEngine* engine, const ch
     // Error: type "const std::function<void(StringHash, VariantMap&)>&" can not automatically bind
     // void Object::SubscribeToEvent(Object* sender, StringHash eventType, const std::function<void(StringHash, VariantMap&)>& function, void* userData = nullptr)
     // Error: type "const std::function<void(StringHash, VariantMap&)>&" can not automatically bind
+    // virtual void Object::OnTypedEvent(Object* sender, StringHash eventType, TypedEventPayload& payload)
+    // Error: type "TypedEventPayload" can not automatically bind bacause have @nobind mark
+    // void Object::SendTypedEvent(StringHash eventType, TypedEventPayload& payload)
+    // Error: type "TypedEventPayload" can not automatically bind bacause have @nobind mark
 
     // bool Object::GetBlockEvents() const
     engine->RegisterObjectMethod(className, "bool GetBlockEvents() const", AS_METHODPR(T, GetBlockEvents, () const, bool), AS_CALL_THISCALL);
@@ -7997,6 +8156,9 @@ template <class T> void RegisterMembers_Object(asIScriptEngine* engine, const ch
     // bool Object::HasEventHandlers() const
     engine->RegisterObjectMethod(className, "bool HasEventHandlers() const", AS_METHODPR(T, HasEventHandlers, () const, bool), AS_CALL_THISCALL);
 
+    // bool Object::HasEventReceivers(StringHash eventType) const
+    engine->RegisterObjectMethod(className, "bool HasEventReceivers(StringHash) const", AS_METHODPR(T, HasEventReceivers, (StringHash) const, bool), AS_CALL_THISCALL);
+
     // bool Object::HasSubscribedToEvent(StringHash eventType) const
     engine->RegisterObjectMethod(className, "bool HasSubscribedToEvent(StringHash) const", AS_METHODPR(T, HasSubscribedToEvent, (StringHash) const, bool), AS_CALL_THISCALL);
 
@@ -8392,6 +8554,8 @@ template <class T> void RegisterMembers_RenderSurface(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "int GetHeight() const", AS_METHODPR(T, GetHeight, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_height() const", AS_METHODPR(T, GetHeight, () const, int), AS_CALL_THISCALL);
 
+    // unsigned RenderSurface::GetLastUpdateFrameNumber() const
+    engine->RegisterObjectMethod(className, "uint GetLastUpdateFrameNumber() const", AS_METHODPR(T, GetLastUpdateFrameNumber, () const, unsigned), AS_CALL_THISCALL);
     // RenderSurface* RenderSurface::GetLinkedDepthStencil() const
     engine->RegisterObjectMethod(className, "RenderSurface@+ GetLinkedDepthStencil() const", AS_METHODPR(T, GetLinkedDepthStencil, () const, RenderSurface*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "RenderSurface@+ get_linkedDepthStencil() const", AS_METHODPR(T, GetLinkedDepthStencil, () const, RenderSurface*), AS_CALL_THISCALL);
@@ -8417,10 +8581,16 @@ template <class T> void RegisterMembers_RenderSurface(asIScriptEngine* engine, c
     // unsigned RenderSurface::GetTarget() const
     engine->RegisterObjectMethod(className, "uint GetTarget() const", AS_METHODPR(T, GetTarget, () const, unsigned), AS_CALL_THISCALL);
 
+    // unsigned RenderSurface::GetUpdateInterval() const
+    engine->RegisterObjectMethod(className, "uint GetUpdateInterval() const", AS_METHODPR(T, GetUpdateInterval, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_updateInterval() const", AS_METHODPR(T, GetUpdateInterval, () const, unsigned), AS_CALL_THISCALL);
     // RenderSurfaceUpdateMode RenderSurface::GetUpdateMode() const
     engine->RegisterObjectMethod(className, "RenderSurfaceUpdateMode GetUpdateMode() const", AS_METHODPR(T, GetUpdateMode, () const, RenderSurfaceUpdateMode), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "RenderSurfaceUpdateMode get_updateMode() const", AS_METHODPR(T, GetUpdateMode, () const, RenderSurfaceUpdateMode), AS_CALL_THISCALL);
 
+    // int RenderSurface::GetUpdatePriority() const
+    engine->RegisterObjectMethod(className, "int GetUpdatePriority() const", AS_METHODPR(T, GetUpdatePriority, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_updatePriority() const", AS_METHODPR(T, GetUpdatePriority, () const, int), AS_CALL_THISCALL);
     // TextureUsage RenderSurface::GetUsage() const
     engine->RegisterObjectMethod(className, "TextureUsage GetUsage() const", AS_METHODPR(T, GetUsage, () const, TextureUsage), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "TextureUsage get_usage() const", AS_METHODPR(T, GetUsage, () const, TextureUsage), AS_CALL_THISCALL);
@@ -8452,6 +8622,8 @@ template <class T> void RegisterMembers_RenderSurface(asIScriptEngine* engine, c
     // void RenderSurface::ResetUpdateQueued()
     engine->RegisterObjectMethod(className, "void ResetUpdateQueued()", AS_METHODPR(T, ResetUpdateQueued, (), void), AS_CALL_THISCALL);
 
+    // void RenderSurface::SetLastUpdateFrameNumber(unsigned frameNumber)
+    engine->RegisterObjectMethod(className, "void SetLastUpdateFrameNumber(uint)", AS_METHODPR(T, SetLastUpdateFrameNumber, (unsigned), void), AS_CALL_THISCALL);
     // void RenderSurface::SetLinkedDepthStencil(RenderSurface* depthStencil)
     engine->RegisterObjectMethod(className, "void SetLinkedDepthStencil(RenderSurface@+)", AS_METHODPR(T, SetLinkedDepthStencil, (RenderSurface*), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_linkedDepthStencil(RenderSurface@+)", AS_METHODPR(T, SetLinkedDepthStencil, (RenderSurface*), void), AS_CALL_THISCALL);
@@ -8467,10 +8639,16 @@ template <class T> void RegisterMembers_RenderSurface(asIScriptEngine* engine, c
     // void RenderSurface::SetResolveDirty(bool enable)
     engine->RegisterObjectMethod(className, "void SetResolveDirty(bool)", AS_METHODPR(T, SetResolveDirty, (bool), void), AS_CALL_THISCALL);
 
+    // void RenderSurface::SetUpdateInterval(unsigned interval)
+    engine->RegisterObjectMethod(className, "void SetUpdateInterval(uint)", AS_METHODPR(T, SetUpdateInterval, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_updateInterval(uint)", AS_METHODPR(T, SetUpdateInterval, (unsigned), void), AS_CALL_THISCALL);
     // void RenderSurface::SetUpdateMode(RenderSurfaceUpdateMode mode)
     engine->RegisterObjectMethod(className, "void SetUpdateMode(RenderSurfaceUpdateMode)", AS_METHODPR(T, SetUpdateMode, (RenderSurfaceUpdateMode), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_updateMode(RenderSurfaceUpdateMode)", AS_METHODPR(T, SetUpdateMode, (RenderSurfaceUpdateMode), void), AS_CALL_THISCALL);
 
+    // void RenderSurface::SetUpdatePriority(int priority)
+    engine->RegisterObjectMethod(className, "void SetUpdatePriority(int)", AS_METHODPR(T, SetUpdatePriority, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_updatePriority(int)", AS_METHODPR(T, SetUpdatePriority, (int), void), AS_CALL_THISCALL);
     // void RenderSurface::SetViewport(unsigned index, Viewport* viewport)
     engine->RegisterObjectMethod(className, "void SetViewport(uint, Viewport@+)", AS_METHODPR(T, SetViewport, (unsigned, Viewport*), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_viewports(uint, Viewport@+)", AS_METHODPR(T, SetViewport, (unsigned, Viewport*), void), AS_CALL_THISCALL);
@@ -8577,6 +8755,9 @@ template <class T> void RegisterMembers_SoundStream(asIScriptEngine* engine, con
     // virtual unsigned SoundStream::GetData(signed char* dest, unsigned numBytes) = 0
     // Error: type "signed char*" can not automatically bind
 
+    // virtual bool SoundStream::DecodeAhead()
+    engine->RegisterObjectMethod(className, "bool DecodeAhead()", AS_METHODPR(T, DecodeAhead, (), bool), AS_CALL_THISCALL);
+
     // float SoundStream::GetFrequency() const
     engine->RegisterObjectMethod(className, "float GetFrequency() const", AS_METHODPR(T, GetFrequency, () const, float), AS_CALL_THISCALL);
 
@@ -8936,6 +9117,16 @@ template <class T> void RegisterMembers_TmxLayer2D(asIScriptEngine* engine, cons
 
 #endif // def URHO3D_URHO2D
 
+// class AdpcmSoundStream | File: ../Audio/AdpcmSoundStream.h
+template <class T> void RegisterMembers_AdpcmSoundStream(asIScriptEngine* engine, const char* className)
+{
+    RegisterMembers_SoundStream<T>(engine, className);
+
+    #ifdef REGISTER_MEMBERS_MANUAL_PART_AdpcmSoundStream
+        REGISTER_MEMBERS_MANUAL_PART_AdpcmSoundStream();
+    #endif
+}
+
 // class AttributeAnimationInfo | File: ../Scene/Animatable.h
 template <class T> void RegisterMembers_AttributeAnimationInfo(asIScriptEngine* engine, const char* className)
 {
@@ -8963,6 +9154,8 @@ template <class T> void RegisterMembers_Audio(asIScriptEngine* engine, const cha
 
     // void Audio::MixOutput(void* dest, unsigned samples)
     // Error: type "void*" can not automatically bind
+    // unsigned Audio::SetSoundSourcePlayback(SoundSource* soundSource, Sound* sound, SoundStream* stream, Sound* streamBuffer, signed char* position, float timePosition)
+    // Error: type "signed char*" can not automatically bind
 
     // void Audio::AddSoundSource(SoundSource* soundSource)
     engine->RegisterObjectMethod(className, "void AddSoundSource(SoundSource@+)", AS_METHODPR(T, AddSoundSource, (SoundSource*), void), AS_CALL_THISCALL);
@@ -8979,12 +9172,17 @@ template <class T> void RegisterMembers_Audio(asIScriptEngine* engine, const cha
     engine->RegisterObjectMethod(className, "float GetMasterGain(const String&in) const", AS_METHODPR(T, GetMasterGain, (const String&) const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_masterGain(const String&in) const", AS_METHODPR(T, GetMasterGain, (const String&) const, float), AS_CALL_THISCALL);
 
+    // unsigned Audio::GetMaxVoices() const
+    engine->RegisterObjectMethod(className, "uint GetMaxVoices() const", AS_METHODPR(T, GetMaxVoices, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_maxVoices() const", AS_METHODPR(T, GetMaxVoices, () const, unsigned), AS_CALL_THISCALL);
+
     // int Audio::GetMixRate() const
     engine->RegisterObjectMethod(className, "int GetMixRate() const", AS_METHODPR(T, GetMixRate, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_mixRate() const", AS_METHODPR(T, GetMixRate, () const, int), AS_CALL_THISCALL);
 
-    // Mutex& Audio::GetMutex()
-    engine->RegisterObjectMethod(className, "Mutex& GetMutex()", AS_METHODPR(T, GetMutex, (), Mutex&), AS_CALL_THISCALL);
+    // unsigned Audio::GetNumVirtualVoices() const
+    engine->RegisterObjectMethod(className, "uint GetNumVirtualVoices() const", AS_METHODPR(T, GetNumVirtualVoices, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numVirtualVoices() const", AS_METHODPR(T, GetNumVirtualVoices, () const, unsigned), AS_CALL_THISCALL);
 
     // unsigned Audio::GetSampleSize() const
     engine->RegisterObjectMethod(className, "uint GetSampleSize() const", AS_METHODPR(T, GetSampleSize, () const, unsigned), AS_CALL_THISCALL);
@@ -8996,9 +9194,16 @@ template <class T> void RegisterMembers_Audio(asIScriptEngine* engine, const cha
     // const PODVector<SoundSource*>& Audio::GetSoundSources() const
     engine->RegisterObjectMethod(className, "Array<SoundSource@>@ GetSoundSources() const", AS_FUNCTION_OBJFIRST(Audio_constspPODVectorlesSoundSourcestargreamp_GetSoundSources_void_template<Audio>), AS_CALL_CDECL_OBJFIRST);
 
+    // int Audio::GetThreadPriority() const
+    engine->RegisterObjectMethod(className, "int GetThreadPriority() const", AS_METHODPR(T, GetThreadPriority, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_threadPriority() const", AS_METHODPR(T, GetThreadPriority, () const, int), AS_CALL_THISCALL);
+
     // bool Audio::HasMasterGain(const String& type) const
     engine->RegisterObjectMethod(className, "bool HasMasterGain(const String&in) const", AS_METHODPR(T, HasMasterGain, (const String&) const, bool), AS_CALL_THISCALL);
 
+    // bool Audio::IsCommandPending(unsigned commandIndex) const
+    engine->RegisterObjectMethod(className, "bool IsCommandPending(uint) const", AS_METHODPR(T, IsCommandPending, (unsigned) const, bool), AS_CALL_THISCALL);
+
     // bool Audio::IsInitialized() const
     engine->RegisterObjectMethod(className, "bool IsInitialized() const", AS_METHODPR(T, IsInitialized, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_initialized() const", AS_METHODPR(T, IsInitialized, () const, bool), AS_CALL_THISCALL);
@@ -9029,6 +9234,9 @@ template <class T> void RegisterMembers_Audio(asIScriptEngine* engine, const cha
     // void Audio::ResumeSoundType(const String& type)
     engine->RegisterObjectMethod(className, "void ResumeSoundType(const String&in)", AS_METHODPR(T, ResumeSoundType, (const String&), void), AS_CALL_THISCALL);
 
+    // void Audio::RetireResource(RefCounted* resource, unsigned commandIndex)
+    engine->RegisterObjectMethod(className, "void RetireResource(RefCounted@+, uint)", AS_METHODPR(T, RetireResource, (RefCounted*, unsigned), void), AS_CALL_THISCALL);
+
     // void Audio::SetListener(SoundListener* listener)
     engine->RegisterObjectMethod(className, "void SetListener(SoundListener@+)", AS_METHODPR(T, SetListener, (SoundListener*), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_listener(SoundListener@+)", AS_METHODPR(T, SetListener, (SoundListener*), void), AS_CALL_THISCALL);
@@ -9037,9 +9245,17 @@ template <class T> void RegisterMembers_Audio(asIScriptEngine* engine, const cha
     engine->RegisterObjectMethod(className, "void SetMasterGain(const String&in, float)", AS_METHODPR(T, SetMasterGain, (const String&, float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_masterGain(const String&in, float)", AS_METHODPR(T, SetMasterGain, (const String&, float), void), AS_CALL_THISCALL);
 
+    // void Audio::SetMaxVoices(unsigned voices)
+    engine->RegisterObjectMethod(className, "void SetMaxVoices(uint)", AS_METHODPR(T, SetMaxVoices, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxVoices(uint)", AS_METHODPR(T, SetMaxVoices, (unsigned), void), AS_CALL_THISCALL);
+
     // bool Audio::SetMode(int bufferLengthMSec, int mixRate, bool stereo, bool interpolation = true)
     engine->RegisterObjectMethod(className, "bool SetMode(int, int, bool, bool = true)", AS_METHODPR(T, SetMode, (int, int, bool, bool), bool), AS_CALL_THISCALL);
 
+    // void Audio::SetThreadPriority(int priority)
+    engine->RegisterObjectMethod(className, "void SetThreadPriority(int)", AS_METHODPR(T, SetThreadPriority, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_threadPriority(int)", AS_METHODPR(T, SetThreadPriority, (int), void), AS_CALL_THISCALL);
+
     // void Audio::Stop()
     engine->RegisterObjectMethod(className, "void Stop()", AS_METHODPR(T, Stop, (), void), AS_CALL_THISCALL);
 
@@ -9229,6 +9445,17 @@ template <class T> void RegisterMembers_DebugHud(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "XMLFile@+ GetDefaultStyle() const", AS_METHODPR(T, GetDefaultStyle, () const, XMLFile*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "XMLFile@+ get_defaultStyle() const", AS_METHODPR(T, GetDefaultStyle, () const, XMLFile*), AS_CALL_THISCALL);
 
+    // float DebugHud::GetFrameTimePercentile(float percentile) const
+    engine->RegisterObjectMethod(className, "float GetFrameTimePercentile(float) const", AS_METHODPR(T, GetFrameTimePercentile, (float) const, float), AS_CALL_THISCALL);
+
+    // Text* DebugHud::GetFrameTimeText() const
+    engine->RegisterObjectMethod(className, "Text@+ GetFrameTimeText() const", AS_METHODPR(T, GetFrameTimeText, () const, Text*), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "Text@+ get_frameTimeText() const", AS_METHODPR(T, GetFrameTimeText, () const, Text*), AS_CALL_THISCALL);
+
+    // float DebugHud::GetLongFrameThreshold() const
+    engine->RegisterObjectMethod(className, "float GetLongFrameThreshold() const", AS_METHODPR(T, GetLongFrameThreshold, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_longFrameThreshold() const", AS_METHODPR(T, GetLongFrameThreshold, () const, float), AS_CALL_THISCALL);
+
     // Text* DebugHud::GetMemoryText() const
     engine->RegisterObjectMethod(className, "Text@+ GetMemoryText() const", AS_METHODPR(T, GetMemoryText, () const, Text*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "Text@+ get_memoryText() const", AS_METHODPR(T, GetMemoryText, () const, Text*), AS_CALL_THISCALL);
@@ -9264,6 +9491,9 @@ template <class T> void RegisterMembers_DebugHud(asIScriptEngine* engine, const
     // bool DebugHud::ResetAppStats(const String& label)
     engine->RegisterObjectMethod(className, "bool ResetAppStats(const String&in)", AS_METHODPR(T, ResetAppStats, (const String&), bool), AS_CALL_THISCALL);
 
+    // bool DebugHud::SaveFrameTimes(const String& fileName) const
+    engine->RegisterObjectMethod(className, "bool SaveFrameTimes(const String&in) const", AS_METHODPR(T, SaveFrameTimes, (const String&) const, bool), AS_CALL_THISCALL);
+
     // void DebugHud::SetAppStats(const String& label, const Variant& stats)
     engine->RegisterObjectMethod(className, "void SetAppStats(const String&in, const Variant&in)", AS_METHODPR(T, SetAppStats, (const String&, const Variant&), void), AS_CALL_THISCALL);
 
@@ -9274,6 +9504,10 @@ template <class T> void RegisterMembers_DebugHud(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "void SetDefaultStyle(XMLFile@+)", AS_METHODPR(T, SetDefaultStyle, (XMLFile*), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_defaultStyle(XMLFile@+)", AS_METHODPR(T, SetDefaultStyle, (XMLFile*), void), AS_CALL_THISCALL);
 
+    // void DebugHud::SetLongFrameThreshold(float threshold)
+    engine->RegisterObjectMethod(className, "void SetLongFrameThreshold(float)", AS_METHODPR(T, SetLongFrameThreshold, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_longFrameThreshold(float)", AS_METHODPR(T, SetLongFrameThreshold, (float), void), AS_CALL_THISCALL);
+
     // void DebugHud::SetMode(unsigned mode)
     engine->RegisterObjectMethod(className, "void SetMode(uint)", AS_METHODPR(T, SetMode, (unsigned), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_mode(uint)", AS_METHODPR(T, SetMode, (unsigned), void), AS_CALL_THISCALL);
@@ -9326,6 +9560,9 @@ template <class T> void RegisterMembers_Engine(asIScriptEngine* engine, const ch
     // DebugHud* Engine::CreateDebugHud()
     engine->RegisterObjectMethod(className, "DebugHud@+ CreateDebugHud()", AS_METHODPR(T, CreateDebugHud, (), DebugHud*), AS_CALL_THISCALL);
 
+    // void Engine::DumpGPUMemory()
+    engine->RegisterObjectMethod(className, "void DumpGPUMemory()", AS_METHODPR(T, DumpGPUMemory, (), void), AS_CALL_THISCALL);
+
     // void Engine::DumpMemory()
     engine->RegisterObjectMethod(className, "void DumpMemory()", AS_METHODPR(T, DumpMemory, (), void), AS_CALL_THISCALL);
 
@@ -9342,6 +9579,18 @@ template <class T> void RegisterMembers_Engine(asIScriptEngine* engine, const ch
     engine->RegisterObjectMethod(className, "bool GetAutoExit() const", AS_METHODPR(T, GetAutoExit, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_autoExit() const", AS_METHODPR(T, GetAutoExit, () const, bool), AS_CALL_THISCALL);
 
+    // long long Engine::GetInputLatency() const
+    engine->RegisterObjectMethod(className, "int64 GetInputLatency() const", AS_METHODPR(T, GetInputLatency, () const, long long), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int64 get_inputLatency() const", AS_METHODPR(T, GetInputLatency, () const, long long), AS_CALL_THISCALL);
+
+    // bool Engine::GetLateInputSampling() const
+    engine->RegisterObjectMethod(className, "bool GetLateInputSampling() const", AS_METHODPR(T, GetLateInputSampling, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_lateInputSampling() const", AS_METHODPR(T, GetLateInputSampling, () const, bool), AS_CALL_THISCALL);
+
+    // bool Engine::GetLowLatencyInput() const
+    engine->RegisterObjectMethod(className, "bool GetLowLatencyInput() const", AS_METHODPR(T, GetLowLatencyInput, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_lowLatencyInput() const", AS_METHODPR(T, GetLowLatencyInput, () const, bool), AS_CALL_THISCALL);
+
     // int Engine::GetMaxFps() const
     engine->RegisterObjectMethod(className, "int GetMaxFps() const", AS_METHODPR(T, GetMaxFps, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_maxFps() const", AS_METHODPR(T, GetMaxFps, () const, int), AS_CALL_THISCALL);
@@ -9361,6 +9610,10 @@ template <class T> void RegisterMembers_Engine(asIScriptEngine* engine, const ch
     engine->RegisterObjectMethod(className, "bool GetPauseMinimized() const", AS_METHODPR(T, GetPauseMinimized, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_pauseMinimized() const", AS_METHODPR(T, GetPauseMinimized, () const, bool), AS_CALL_THISCALL);
 
+    // bool Engine::GetProfilerFrameImages() const
+    engine->RegisterObjectMethod(className, "bool GetProfilerFrameImages() const", AS_METHODPR(T, GetProfilerFrameImages, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_profilerFrameImages() const", AS_METHODPR(T, GetProfilerFrameImages, () const, bool), AS_CALL_THISCALL);
+
     // int Engine::GetTimeStepSmoothing() const
     engine->RegisterObjectMethod(className, "int GetTimeStepSmoothing() const", AS_METHODPR(T, GetTimeStepSmoothing, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_timeStepSmoothing() const", AS_METHODPR(T, GetTimeStepSmoothing, () const, int), AS_CALL_THISCALL);
@@ -9393,6 +9646,14 @@ template <class T> void RegisterMembers_Engine(asIScriptEngine* engine, const ch
     engine->RegisterObjectMethod(className, "void SetAutoExit(bool)", AS_METHODPR(T, SetAutoExit, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_autoExit(bool)", AS_METHODPR(T, SetAutoExit, (bool), void), AS_CALL_THISCALL);
 
+    // void Engine::SetLateInputSampling(bool enable)
+    engine->RegisterObjectMethod(className, "void SetLateInputSampling(bool)", AS_METHODPR(T, SetLateInputSampling, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_lateInputSampling(bool)", AS_METHODPR(T, SetLateInputSampling, (bool), void), AS_CALL_THISCALL);
+
+    // void Engine::SetLowLatencyInput(bool enable)
+    engine->RegisterObjectMethod(className, "void SetLowLatencyInput(bool)", AS_METHODPR(T, SetLowLatencyInput, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_lowLatencyInput(bool)", AS_METHODPR(T, SetLowLatencyInput, (bool), void), AS_CALL_THISCALL);
+
     // void Engine::SetMaxFps(int fps)
     engine->RegisterObjectMethod(className, "void SetMaxFps(int)", AS_METHODPR(T, SetMaxFps, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_maxFps(int)", AS_METHODPR(T, SetMaxFps, (int), void), AS_CALL_THISCALL);
@@ -9412,6 +9673,10 @@ template <class T> void RegisterMembers_Engine(asIScriptEngine* engine, const ch
     engine->RegisterObjectMethod(className, "void SetPauseMinimized(bool)", AS_METHODPR(T, SetPauseMinimized, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_pauseMinimized(bool)", AS_METHODPR(T, SetPauseMinimized, (bool), void), AS_CALL_THISCALL);
 
+    // void Engine::SetProfilerFrameImages(bool enable)
+    engine->RegisterObjectMethod(className, "void SetProfilerFrameImages(bool)", AS_METHODPR(T, SetProfilerFrameImages, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_profilerFrameImages(bool)", AS_METHODPR(T, SetProfilerFrameImages, (bool), void), AS_CALL_THISCALL);
+
     // void Engine::SetTimeStepSmoothing(int frames)
     engine->RegisterObjectMethod(className, "void SetTimeStepSmoothing(int)", AS_METHODPR(T, SetTimeStepSmoothing, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_timeStepSmoothing(int)", AS_METHODPR(T, SetTimeStepSmoothing, (int), void), AS_CALL_THISCALL);
@@ -9449,6 +9714,8 @@ template <class T> void RegisterMembers_File(asIScriptEngine* engine, const char
     RegisterMembers_Object<T>(engine, className);
     RegisterMembers_AbstractFile<T>(engine, className);
 
+    // const unsigned char* File::GetReadPointer() const override
+    // Error: type "const unsigned char*" can not automatically bind
     // void* File::GetHandle() const
     // Error: type "void*" can not automatically bind
 
@@ -9462,6 +9729,10 @@ template <class T> void RegisterMembers_File(asIScriptEngine* engine, const char
     engine->RegisterObjectMethod(className, "FileMode GetMode() const", AS_METHODPR(T, GetMode, () const, FileMode), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "FileMode get_mode() const", AS_METHODPR(T, GetMode, () const, FileMode), AS_CALL_THISCALL);
 
+    // bool File::IsMemoryMapped() const
+    engine->RegisterObjectMethod(className, "bool IsMemoryMapped() const", AS_METHODPR(T, IsMemoryMapped, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_memoryMapped() const", AS_METHODPR(T, IsMemoryMapped, () const, bool), AS_CALL_THISCALL);
+
     // bool File::IsOpen() const
     engine->RegisterObjectMethod(className, "bool IsOpen() const", AS_METHODPR(T, IsOpen, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_open() const", AS_METHODPR(T, IsOpen, () const, bool), AS_CALL_THISCALL);
@@ -9707,6 +9978,9 @@ template <class T> void RegisterMembers_FileWatcher(asIScriptEngine* engine, con
     RegisterMembers_Object<T>(engine, className);
     RegisterMembers_Thread<T>(engine, className);
 
+    // bool FileWatcher::GetChanges(Vector<String>& dest)
+    // Not registered because have @nobind mark
+
     // void FileWatcher::AddChange(const String& fileName)
     engine->RegisterObjectMethod(className, "void AddChange(const String&in)", AS_METHODPR(T, AddChange, (const String&), void), AS_CALL_THISCALL);
 
@@ -9773,10 +10047,14 @@ template <class T> void RegisterMembers_Geometry(asIScriptEngine* engine, const
 
     // float Geometry::GetHitDistance(const Ray& ray, Vector3* outNormal = nullptr, Vector2* outUV = nullptr) const
     // Error: type "Vector3*" can not automatically bind
+    // const PODVector<Meshlet>& Geometry::GetMeshlets() const
+    // Error: type "const PODVector<Meshlet>&" can not automatically bind
     // void Geometry::GetRawData(const unsigned char*& vertexData, unsigned& vertexSize, const unsigned char*& indexData, unsigned& indexSize, const PODVector<VertexElement>*& elements) const
     // Error: type "const unsigned char*&" can not automatically bind
     // void Geometry::GetRawDataShared(SharedArrayPtr<unsigned char>& vertexData, unsigned& vertexSize, SharedArrayPtr<unsigned char>& indexData, unsigned& indexSize, const PODVector<VertexElement>*& elements) const
     // Error: type "SharedArrayPtr<unsigned char>&" can not automatically bind
+    // void Geometry::SetMeshlets(const PODVector<Meshlet>& meshlets)
+    // Error: type "const PODVector<Meshlet>&" can not automatically bind
     // void Geometry::SetRawIndexData(const SharedArrayPtr<unsigned char>& data, unsigned indexSize)
     // Error: type "const SharedArrayPtr<unsigned char>&" can not automatically bind
     // void Geometry::SetRawVertexData(const SharedArrayPtr<unsigned char>& data, const PODVector<VertexElement>& elements)
@@ -9802,6 +10080,14 @@ template <class T> void RegisterMembers_Geometry(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "uint GetIndexStart() const", AS_METHODPR(T, GetIndexStart, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_indexStart() const", AS_METHODPR(T, GetIndexStart, () const, unsigned), AS_CALL_THISCALL);
 
+    // unsigned Geometry::GetInstanceCount() const
+    engine->RegisterObjectMethod(className, "uint GetInstanceCount() const", AS_METHODPR(T, GetInstanceCount, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_instanceCount() const", AS_METHODPR(T, GetInstanceCount, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned Geometry::GetInstanceStart() const
+    engine->RegisterObjectMethod(className, "uint GetInstanceStart() const", AS_METHODPR(T, GetInstanceStart, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_instanceStart() const", AS_METHODPR(T, GetInstanceStart, () const, unsigned), AS_CALL_THISCALL);
+
     // float Geometry::GetLodDistance() const
     engine->RegisterObjectMethod(className, "float GetLodDistance() const", AS_METHODPR(T, GetLodDistance, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_lodDistance() const", AS_METHODPR(T, GetLodDistance, () const, float), AS_CALL_THISCALL);
@@ -9846,6 +10132,9 @@ template <class T> void RegisterMembers_Geometry(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "void SetIndexBuffer(IndexBuffer@+)", AS_METHODPR(T, SetIndexBuffer, (IndexBuffer*), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_indexBuffer(IndexBuffer@+)", AS_METHODPR(T, SetIndexBuffer, (IndexBuffer*), void), AS_CALL_THISCALL);
 
+    // void Geometry::SetInstanceRange(unsigned instanceStart, unsigned instanceCount)
+    engine->RegisterObjectMethod(className, "void SetInstanceRange(uint, uint)", AS_METHODPR(T, SetInstanceRange, (unsigned, unsigned), void), AS_CALL_THISCALL);
+
     // void Geometry::SetLodDistance(float distance)
     engine->RegisterObjectMethod(className, "void SetLodDistance(float)", AS_METHODPR(T, SetLodDistance, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_lodDistance(float)", AS_METHODPR(T, SetLodDistance, (float), void), AS_CALL_THISCALL);
@@ -9917,6 +10206,8 @@ template <class T> void RegisterMembers_Graphics(asIScriptEngine* engine, const
     // Error: type "void*" can not automatically bind
     // void Graphics::Restore()
     // Not registered because have @nobind mark
+    // bool Graphics::SaveShaderArchive(const String& fileName, const PODVector<ShaderVariation*>& variations, const Vector<String>& deviceTypes)
+    // Error: type "const PODVector<ShaderVariation*>&" can not automatically bind
     // void Graphics::SetExternalWindow(void* window)
     // Error: type "void*" can not automatically bind
     // void Graphics::SetShaderParameter(StringHash param, const float* data, unsigned count)
@@ -9932,6 +10223,9 @@ template <class T> void RegisterMembers_Graphics(asIScriptEngine* engine, const
     // bool Graphics::SetVertexBuffers(const PODVector<VertexBuffer*>& buffers, unsigned instanceOffset = 0)
     // Not registered because have @nobind mark
 
+    // void Graphics::BeginCapture(const String& fileName, unsigned numFrames = 1)
+    engine->RegisterObjectMethod(className, "void BeginCapture(const String&in, uint = 1)", AS_METHODPR(T, BeginCapture, (const String&, unsigned), void), AS_CALL_THISCALL);
+
     // void Graphics::BeginDumpShaders(const String& fileName)
     engine->RegisterObjectMethod(className, "void BeginDumpShaders(const String&in)", AS_METHODPR(T, BeginDumpShaders, (const String&), void), AS_CALL_THISCALL);
 
@@ -9974,6 +10268,9 @@ template <class T> void RegisterMembers_Graphics(asIScriptEngine* engine, const
     // void Graphics::DrawInstanced(PrimitiveType type, unsigned indexStart, unsigned indexCount, unsigned baseVertexIndex, unsigned minVertex, unsigned vertexCount, unsigned instanceCount)
     engine->RegisterObjectMethod(className, "void DrawInstanced(PrimitiveType, uint, uint, uint, uint, uint, uint)", AS_METHODPR(T, DrawInstanced, (PrimitiveType, unsigned, unsigned, unsigned, unsigned, unsigned, unsigned), void), AS_CALL_THISCALL);
 
+    // void Graphics::EndCapture()
+    engine->RegisterObjectMethod(className, "void EndCapture()", AS_METHODPR(T, EndCapture, (), void), AS_CALL_THISCALL);
+
     // void Graphics::EndDumpShaders()
     engine->RegisterObjectMethod(className, "void EndDumpShaders()", AS_METHODPR(T, EndDumpShaders, (), void), AS_CALL_THISCALL);
 
@@ -10067,6 +10364,14 @@ template <class T> void RegisterMembers_Graphics(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "bool GetFullscreen() const", AS_METHODPR(T, GetFullscreen, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_fullscreen() const", AS_METHODPR(T, GetFullscreen, () const, bool), AS_CALL_THISCALL);
 
+    // unsigned long long Graphics::GetGPUMemoryPeak() const
+    engine->RegisterObjectMethod(className, "uint64 GetGPUMemoryPeak() const", AS_METHODPR(T, GetGPUMemoryPeak, () const, unsigned long long), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint64 get_gpuMemoryPeak() const", AS_METHODPR(T, GetGPUMemoryPeak, () const, unsigned long long), AS_CALL_THISCALL);
+
+    // unsigned long long Graphics::GetGPUMemoryUse() const
+    engine->RegisterObjectMethod(className, "uint64 GetGPUMemoryUse() const", AS_METHODPR(T, GetGPUMemoryUse, () const, unsigned long long), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint64 get_gpuMemoryUse() const", AS_METHODPR(T, GetGPUMemoryUse, () const, unsigned long long), AS_CALL_THISCALL);
+
     // bool Graphics::GetHardwareShadowSupport() const
     engine->RegisterObjectMethod(className, "bool GetHardwareShadowSupport() const", AS_METHODPR(T, GetHardwareShadowSupport, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_hardwareShadowSupport() const", AS_METHODPR(T, GetHardwareShadowSupport, () const, bool), AS_CALL_THISCALL);
@@ -10256,6 +10561,9 @@ template <class T> void RegisterMembers_Graphics(asIScriptEngine* engine, const
     // bool Graphics::HasTextureUnit(TextureUnit unit)
     engine->RegisterObjectMethod(className, "bool HasTextureUnit(TextureUnit)", AS_METHODPR(T, HasTextureUnit, (TextureUnit), bool), AS_CALL_THISCALL);
 
+    // bool Graphics::IsCapturing() const
+    engine->RegisterObjectMethod(className, "bool IsCapturing() const", AS_METHODPR(T, IsCapturing, () const, bool), AS_CALL_THISCALL);
+
     // bool Graphics::IsDeviceLost() const
     engine->RegisterObjectMethod(className, "bool IsDeviceLost() const", AS_METHODPR(T, IsDeviceLost, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_deviceLost() const", AS_METHODPR(T, IsDeviceLost, () const, bool), AS_CALL_THISCALL);
@@ -10264,6 +10572,9 @@ template <class T> void RegisterMembers_Graphics(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "bool IsInitialized() const", AS_METHODPR(T, IsInitialized, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_initialized() const", AS_METHODPR(T, IsInitialized, () const, bool), AS_CALL_THISCALL);
 
+    // bool Graphics::LoadShaderArchive(const String& fileName)
+    engine->RegisterObjectMethod(className, "bool LoadShaderArchive(const String&in)", AS_METHODPR(T, LoadShaderArchive, (const String&), bool), AS_CALL_THISCALL);
+
     // void Graphics::Maximize()
     engine->RegisterObjectMethod(className, "void Maximize()", AS_METHODPR(T, Maximize, (), void), AS_CALL_THISCALL);
 
@@ -10279,12 +10590,18 @@ template <class T> void RegisterMembers_Graphics(asIScriptEngine* engine, const
     // void Graphics::PrecacheShaders(Deserializer& source)
     engine->RegisterObjectMethod(className, "void PrecacheShaders(Deserializer&)", AS_METHODPR(T, PrecacheShaders, (Deserializer&), void), AS_CALL_THISCALL);
 
+    // String Graphics::PrintGPUMemoryUsage(unsigned maxObjects = 10) const
+    engine->RegisterObjectMethod(className, "String PrintGPUMemoryUsage(uint = 10) const", AS_METHODPR(T, PrintGPUMemoryUsage, (unsigned) const, String), AS_CALL_THISCALL);
+
     // void Graphics::Raise() const
     engine->RegisterObjectMethod(className, "void Raise() const", AS_METHODPR(T, Raise, () const, void), AS_CALL_THISCALL);
 
     // void Graphics::ResetDepthStencil()
     engine->RegisterObjectMethod(className, "void ResetDepthStencil()", AS_METHODPR(T, ResetDepthStencil, (), void), AS_CALL_THISCALL);
 
+    // void Graphics::ResetGPUMemoryPeaks()
+    engine->RegisterObjectMethod(className, "void ResetGPUMemoryPeaks()", AS_METHODPR(T, ResetGPUMemoryPeaks, (), void), AS_CALL_THISCALL);
+
     // void Graphics::ResetRenderTarget(unsigned index)
     engine->RegisterObjectMethod(className, "void ResetRenderTarget(uint)", AS_METHODPR(T, ResetRenderTarget, (unsigned), void), AS_CALL_THISCALL);
 
@@ -10549,6 +10866,9 @@ template <class T> void RegisterMembers_IndexBuffer(asIScriptEngine* engine, con
     // bool IndexBuffer::SetDataRange(const void* data, unsigned start, unsigned count, bool discard = false)
     // Error: type "const void*" can not automatically bind
 
+    // unsigned IndexBuffer::GetDataRevision() const
+    engine->RegisterObjectMethod(className, "uint GetDataRevision() const", AS_METHODPR(T, GetDataRevision, () const, unsigned), AS_CALL_THISCALL);
+
     // unsigned IndexBuffer::GetIndexCount() const
     engine->RegisterObjectMethod(className, "uint GetIndexCount() const", AS_METHODPR(T, GetIndexCount, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_indexCount() const", AS_METHODPR(T, GetIndexCount, () const, unsigned), AS_CALL_THISCALL);
@@ -10662,6 +10982,9 @@ template <class T> void RegisterMembers_Input(asIScriptEngine* engine, const cha
     engine->RegisterObjectMethod(className, "IntVector2 GetMousePosition() const", AS_METHODPR(T, GetMousePosition, () const, IntVector2), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "IntVector2 get_mousePosition() const", AS_METHODPR(T, GetMousePosition, () const, IntVector2), AS_CALL_THISCALL);
 
+    // IntVector2 Input::GetPendingMouseMove()
+    engine->RegisterObjectMethod(className, "IntVector2 GetPendingMouseMove()", AS_METHODPR(T, GetPendingMouseMove, (), IntVector2), AS_CALL_THISCALL);
+
     // unsigned Input::GetNumJoysticks() const
     engine->RegisterObjectMethod(className, "uint GetNumJoysticks() const", AS_METHODPR(T, GetNumJoysticks, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numJoysticks() const", AS_METHODPR(T, GetNumJoysticks, () const, unsigned), AS_CALL_THISCALL);
@@ -10867,6 +11190,9 @@ template <class T> void RegisterMembers_Log(asIScriptEngine* engine, const char*
     // void Log::Close()
     engine->RegisterObjectMethod(className, "void Close()", AS_METHODPR(T, Close, (), void), AS_CALL_THISCALL);
 
+    // void Log::Flush()
+    engine->RegisterObjectMethod(className, "void Flush()", AS_METHODPR(T, Flush, (), void), AS_CALL_THISCALL);
+
     // String Log::GetLastMessage() const
     engine->RegisterObjectMethod(className, "String GetLastMessage() const", AS_METHODPR(T, GetLastMessage, () const, String), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "String get_lastMessage() const", AS_METHODPR(T, GetLastMessage, () const, String), AS_CALL_THISCALL);
@@ -10875,6 +11201,10 @@ template <class T> void RegisterMembers_Log(asIScriptEngine* engine, const char*
     engine->RegisterObjectMethod(className, "int GetLevel() const", AS_METHODPR(T, GetLevel, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_level() const", AS_METHODPR(T, GetLevel, () const, int), AS_CALL_THISCALL);
 
+    // LogQueuePolicy Log::GetQueuePolicy() const
+    engine->RegisterObjectMethod(className, "LogQueuePolicy GetQueuePolicy() const", AS_METHODPR(T, GetQueuePolicy, () const, LogQueuePolicy), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "LogQueuePolicy get_queuePolicy() const", AS_METHODPR(T, GetQueuePolicy, () const, LogQueuePolicy), AS_CALL_THISCALL);
+
     // bool Log::GetTimeStamp() const
     engine->RegisterObjectMethod(className, "bool GetTimeStamp() const", AS_METHODPR(T, GetTimeStamp, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_timeStamp() const", AS_METHODPR(T, GetTimeStamp, () const, bool), AS_CALL_THISCALL);
@@ -10890,6 +11220,10 @@ template <class T> void RegisterMembers_Log(asIScriptEngine* engine, const char*
     engine->RegisterObjectMethod(className, "void SetLevel(int)", AS_METHODPR(T, SetLevel, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_level(int)", AS_METHODPR(T, SetLevel, (int), void), AS_CALL_THISCALL);
 
+    // void Log::SetQueuePolicy(LogQueuePolicy policy)
+    engine->RegisterObjectMethod(className, "void SetQueuePolicy(LogQueuePolicy)", AS_METHODPR(T, SetQueuePolicy, (LogQueuePolicy), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_queuePolicy(LogQueuePolicy)", AS_METHODPR(T, SetQueuePolicy, (LogQueuePolicy), void), AS_CALL_THISCALL);
+
     // void Log::SetQuiet(bool quiet)
     engine->RegisterObjectMethod(className, "void SetQuiet(bool)", AS_METHODPR(T, SetQuiet, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_quiet(bool)", AS_METHODPR(T, SetQuiet, (bool), void), AS_CALL_THISCALL);
@@ -10903,6 +11237,9 @@ template <class T> void RegisterMembers_Log(asIScriptEngine* engine, const char*
     // static void Log::WriteFormat(int level, const char* format,...)
     // Error: type "const char*" can not automatically bind
 
+    // static bool Log::IsEnabled(int level)
+    engine->SetDefaultNamespace(className);engine->RegisterGlobalFunction("bool IsEnabled(int)", AS_FUNCTIONPR(T::IsEnabled, (int), bool), AS_CALL_CDECL);engine->SetDefaultNamespace("");
+
     // static void Log::WriteRaw(const String& message, bool error = false)
     engine->SetDefaultNamespace(className);engine->RegisterGlobalFunction("void WriteRaw(const String&in, bool = false)", AS_FUNCTIONPR(T::WriteRaw, (const String&, bool), void), AS_CALL_CDECL);engine->SetDefaultNamespace("");
 
@@ -10911,6 +11248,76 @@ template <class T> void RegisterMembers_Log(asIScriptEngine* engine, const char*
     #endif
 }
 
+// const Vector<SharedPtr<Image>>& MaterialAtlas::GetImages() const
+template <class T> CScriptArray* MaterialAtlas_constspVectorlesSharedPtrlesImagegregreamp_GetImages_void_template(T* _ptr)
+{
+    const Vector<SharedPtr<Image>>& result = _ptr->GetImages();
+    return VectorToHandleArray(result, "Array<Image@>");
+}
+
+// const Vector<SharedPtr<Material>>& MaterialAtlas::GetMaterials() const
+template <class T> CScriptArray* MaterialAtlas_constspVectorlesSharedPtrlesMaterialgregreamp_GetMaterials_void_template(T* _ptr)
+{
+    const Vector<SharedPtr<Material>>& result = _ptr->GetMaterials();
+    return VectorToHandleArray(result, "Array<Material@>");
+}
+
+// const Vector<SharedPtr<Model>>& MaterialAtlas::GetModels() const
+template <class T> CScriptArray* MaterialAtlas_constspVectorlesSharedPtrlesModelgregreamp_GetModels_void_template(T* _ptr)
+{
+    const Vector<SharedPtr<Model>>& result = _ptr->GetModels();
+    return VectorToHandleArray(result, "Array<Model@>");
+}
+
+// class MaterialAtlas | File: ../Graphics/MaterialAtlas.h
+template <class T> void RegisterMembers_MaterialAtlas(asIScriptEngine* engine, const char* className)
+{
+    RegisterMembers_Object<T>(engine, className);
+
+    // unsigned MaterialAtlas::Build(Node* node)
+    engine->RegisterObjectMethod(className, "uint Build(Node@+)", AS_METHODPR(T, Build, (Node*), unsigned), AS_CALL_THISCALL);
+
+    // void MaterialAtlas::Clear()
+    engine->RegisterObjectMethod(className, "void Clear()", AS_METHODPR(T, Clear, (), void), AS_CALL_THISCALL);
+
+    // const Vector<SharedPtr<Image>>& MaterialAtlas::GetImages() const
+    engine->RegisterObjectMethod(className, "Array<Image@>@ GetImages() const", AS_FUNCTION_OBJFIRST(MaterialAtlas_constspVectorlesSharedPtrlesImagegregreamp_GetImages_void_template<MaterialAtlas>), AS_CALL_CDECL_OBJFIRST);
+
+    // const Vector<SharedPtr<Material>>& MaterialAtlas::GetMaterials() const
+    engine->RegisterObjectMethod(className, "Array<Material@>@ GetMaterials() const", AS_FUNCTION_OBJFIRST(MaterialAtlas_constspVectorlesSharedPtrlesMaterialgregreamp_GetMaterials_void_template<MaterialAtlas>), AS_CALL_CDECL_OBJFIRST);
+
+    // int MaterialAtlas::GetMaxAtlasSize() const
+    engine->RegisterObjectMethod(className, "int GetMaxAtlasSize() const", AS_METHODPR(T, GetMaxAtlasSize, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_maxAtlasSize() const", AS_METHODPR(T, GetMaxAtlasSize, () const, int), AS_CALL_THISCALL);
+
+    // int MaterialAtlas::GetMaxTextureSize() const
+    engine->RegisterObjectMethod(className, "int GetMaxTextureSize() const", AS_METHODPR(T, GetMaxTextureSize, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_maxTextureSize() const", AS_METHODPR(T, GetMaxTextureSize, () const, int), AS_CALL_THISCALL);
+
+    // const Vector<SharedPtr<Model>>& MaterialAtlas::GetModels() const
+    engine->RegisterObjectMethod(className, "Array<Model@>@ GetModels() const", AS_FUNCTION_OBJFIRST(MaterialAtlas_constspVectorlesSharedPtrlesModelgregreamp_GetModels_void_template<MaterialAtlas>), AS_CALL_CDECL_OBJFIRST);
+
+    // int MaterialAtlas::GetPadding() const
+    engine->RegisterObjectMethod(className, "int GetPadding() const", AS_METHODPR(T, GetPadding, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_padding() const", AS_METHODPR(T, GetPadding, () const, int), AS_CALL_THISCALL);
+
+    // void MaterialAtlas::SetMaxAtlasSize(int size)
+    engine->RegisterObjectMethod(className, "void SetMaxAtlasSize(int)", AS_METHODPR(T, SetMaxAtlasSize, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxAtlasSize(int)", AS_METHODPR(T, SetMaxAtlasSize, (int), void), AS_CALL_THISCALL);
+
+    // void MaterialAtlas::SetMaxTextureSize(int size)
+    engine->RegisterObjectMethod(className, "void SetMaxTextureSize(int)", AS_METHODPR(T, SetMaxTextureSize, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxTextureSize(int)", AS_METHODPR(T, SetMaxTextureSize, (int), void), AS_CALL_THISCALL);
+
+    // void MaterialAtlas::SetPadding(int padding)
+    engine->RegisterObjectMethod(className, "void SetPadding(int)", AS_METHODPR(T, SetPadding, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_padding(int)", AS_METHODPR(T, SetPadding, (int), void), AS_CALL_THISCALL);
+
+    #ifdef REGISTER_MEMBERS_MANUAL_PART_MaterialAtlas
+        REGISTER_MEMBERS_MANUAL_PART_MaterialAtlas();
+    #endif
+}
+
 // class MemoryBuffer | File: ../IO/MemoryBuffer.h
 template <class T> void RegisterMembers_MemoryBuffer(asIScriptEngine* engine, const char* className)
 {
@@ -10960,6 +11367,58 @@ template <class T> void RegisterMembers_MessageBox(asIScriptEngine* engine, cons
     #endif
 }
 
+// class Metrics | File: ../Core/Metrics.h
+template <class T> void RegisterMembers_Metrics(asIScriptEngine* engine, const char* className)
+{
+    RegisterMembers_Object<T>(engine, className);
+
+    // bool Metrics::GetHistory(const String& subsystem, const String& name, PODVector<double>& dest, const String& labels = String::EMPTY) const
+    // Error: type "PODVector<double>&" can not automatically bind
+
+    // unsigned Metrics::GetHistorySize() const
+    engine->RegisterObjectMethod(className, "uint GetHistorySize() const", AS_METHODPR(T, GetHistorySize, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_historySize() const", AS_METHODPR(T, GetHistorySize, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned Metrics::GetNumMetrics() const
+    engine->RegisterObjectMethod(className, "uint GetNumMetrics() const", AS_METHODPR(T, GetNumMetrics, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numMetrics() const", AS_METHODPR(T, GetNumMetrics, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned Metrics::GetNumSamples() const
+    engine->RegisterObjectMethod(className, "uint GetNumSamples() const", AS_METHODPR(T, GetNumSamples, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numSamples() const", AS_METHODPR(T, GetNumSamples, () const, unsigned), AS_CALL_THISCALL);
+
+    // String Metrics::GetPrometheusText() const
+    engine->RegisterObjectMethod(className, "String GetPrometheusText() const", AS_METHODPR(T, GetPrometheusText, () const, String), AS_CALL_THISCALL);
+
+    // unsigned short Metrics::GetServerPort() const
+    engine->RegisterObjectMethod(className, "uint16 GetServerPort() const", AS_METHODPR(T, GetServerPort, () const, unsigned short), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint16 get_serverPort() const", AS_METHODPR(T, GetServerPort, () const, unsigned short), AS_CALL_THISCALL);
+
+    // double Metrics::GetValue(const String& subsystem, const String& name, const String& labels = String::EMPTY) const
+    engine->RegisterObjectMethod(className, "double GetValue(const String&in, const String&in, const String&in = String::EMPTY) const", AS_METHODPR(T, GetValue, (const String&, const String&, const String&) const, double), AS_CALL_THISCALL);
+
+    // bool Metrics::IsServerRunning() const
+    engine->RegisterObjectMethod(className, "bool IsServerRunning() const", AS_METHODPR(T, IsServerRunning, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_serverRunning() const", AS_METHODPR(T, IsServerRunning, () const, bool), AS_CALL_THISCALL);
+
+    // void Metrics::Sample()
+    engine->RegisterObjectMethod(className, "void Sample()", AS_METHODPR(T, Sample, (), void), AS_CALL_THISCALL);
+
+    // void Metrics::SetHistorySize(unsigned frames)
+    engine->RegisterObjectMethod(className, "void SetHistorySize(uint)", AS_METHODPR(T, SetHistorySize, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_historySize(uint)", AS_METHODPR(T, SetHistorySize, (unsigned), void), AS_CALL_THISCALL);
+
+    // bool Metrics::StartServer(unsigned short port)
+    engine->RegisterObjectMethod(className, "bool StartServer(uint16)", AS_METHODPR(T, StartServer, (unsigned short), bool), AS_CALL_THISCALL);
+
+    // void Metrics::StopServer()
+    engine->RegisterObjectMethod(className, "void StopServer()", AS_METHODPR(T, StopServer, (), void), AS_CALL_THISCALL);
+
+    #ifdef REGISTER_MEMBERS_MANUAL_PART_Metrics
+        REGISTER_MEMBERS_MANUAL_PART_Metrics();
+    #endif
+}
+
 // class NamedPipe | File: ../IO/NamedPipe.h
 template <class T> void RegisterMembers_NamedPipe(asIScriptEngine* engine, const char* className)
 {
@@ -11092,6 +11551,10 @@ template <class T> void RegisterMembers_PackageFile(asIScriptEngine* engine, con
     // bool PackageFile::Exists(const String& fileName) const
     engine->RegisterObjectMethod(className, "bool Exists(const String&in) const", AS_METHODPR(T, Exists, (const String&) const, bool), AS_CALL_THISCALL);
 
+    // unsigned PackageFile::GetBlockSize() const
+    engine->RegisterObjectMethod(className, "uint GetBlockSize() const", AS_METHODPR(T, GetBlockSize, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_blockSize() const", AS_METHODPR(T, GetBlockSize, () const, unsigned), AS_CALL_THISCALL);
+
     // unsigned PackageFile::GetChecksum() const
     engine->RegisterObjectMethod(className, "uint GetChecksum() const", AS_METHODPR(T, GetChecksum, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_checksum() const", AS_METHODPR(T, GetChecksum, () const, unsigned), AS_CALL_THISCALL);
@@ -11122,9 +11585,17 @@ template <class T> void RegisterMembers_PackageFile(asIScriptEngine* engine, con
     engine->RegisterObjectMethod(className, "bool IsCompressed() const", AS_METHODPR(T, IsCompressed, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_compressed() const", AS_METHODPR(T, IsCompressed, () const, bool), AS_CALL_THISCALL);
 
+    // bool PackageFile::IsMemoryMapped() const
+    engine->RegisterObjectMethod(className, "bool IsMemoryMapped() const", AS_METHODPR(T, IsMemoryMapped, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_memoryMapped() const", AS_METHODPR(T, IsMemoryMapped, () const, bool), AS_CALL_THISCALL);
+
     // bool PackageFile::Open(const String& fileName, unsigned startOffset = 0)
     engine->RegisterObjectMethod(className, "bool Open(const String&in, uint = 0)", AS_METHODPR(T, Open, (const String&, unsigned), bool), AS_CALL_THISCALL);
 
+    // void PackageFile::SetMemoryMapped(bool enable)
+    engine->RegisterObjectMethod(className, "void SetMemoryMapped(bool)", AS_METHODPR(T, SetMemoryMapped, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_memoryMapped(bool)", AS_METHODPR(T, SetMemoryMapped, (bool), void), AS_CALL_THISCALL);
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_PackageFile
         REGISTER_MEMBERS_MANUAL_PART_PackageFile();
     #endif
@@ -11141,6 +11612,8 @@ template <class T> void RegisterMembers_Profiler(asIScriptEngine* engine, const
     // Error: type "ProfilerBlock" can not automatically bind bacause have @nobind mark
     // const ProfilerBlock* Profiler::GetRootBlock()
     // Error: type "ProfilerBlock" can not automatically bind bacause have @nobind mark
+    // const PODVector<ProfilerTraceEvent>& Profiler::GetTraceEvents() const
+    // Error: type "const PODVector<ProfilerTraceEvent>&" can not automatically bind
 
     // void Profiler::BeginFrame()
     engine->RegisterObjectMethod(className, "void BeginFrame()", AS_METHODPR(T, BeginFrame, (), void), AS_CALL_THISCALL);
@@ -11148,15 +11621,28 @@ template <class T> void RegisterMembers_Profiler(asIScriptEngine* engine, const
     // void Profiler::BeginInterval()
     engine->RegisterObjectMethod(className, "void BeginInterval()", AS_METHODPR(T, BeginInterval, (), void), AS_CALL_THISCALL);
 
+    // void Profiler::BeginTrace()
+    engine->RegisterObjectMethod(className, "void BeginTrace()", AS_METHODPR(T, BeginTrace, (), void), AS_CALL_THISCALL);
+
     // void Profiler::EndBlock()
     engine->RegisterObjectMethod(className, "void EndBlock()", AS_METHODPR(T, EndBlock, (), void), AS_CALL_THISCALL);
 
     // void Profiler::EndFrame()
     engine->RegisterObjectMethod(className, "void EndFrame()", AS_METHODPR(T, EndFrame, (), void), AS_CALL_THISCALL);
 
+    // void Profiler::EndTrace()
+    engine->RegisterObjectMethod(className, "void EndTrace()", AS_METHODPR(T, EndTrace, (), void), AS_CALL_THISCALL);
+
+    // bool Profiler::IsTracing() const
+    engine->RegisterObjectMethod(className, "bool IsTracing() const", AS_METHODPR(T, IsTracing, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_tracing() const", AS_METHODPR(T, IsTracing, () const, bool), AS_CALL_THISCALL);
+
     // const String& Profiler::PrintData(bool showUnused = false, bool showTotal = false, unsigned maxDepth = M_MAX_UNSIGNED) const
     engine->RegisterObjectMethod(className, "const String& PrintData(bool = false, bool = false, uint = M_MAX_UNSIGNED) const", AS_METHODPR(T, PrintData, (bool, bool, unsigned) const, const String&), AS_CALL_THISCALL);
 
+    // bool Profiler::SaveTrace(Serializer& dest) const
+    engine->RegisterObjectMethod(className, "bool SaveTrace(Serializer&) const", AS_METHODPR(T, SaveTrace, (Serializer&) const, bool), AS_CALL_THISCALL);
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_Profiler
         REGISTER_MEMBERS_MANUAL_PART_Profiler();
     #endif
@@ -11167,15 +11653,25 @@ template <class T> void RegisterMembers_Renderer(asIScriptEngine* engine, const
 {
     RegisterMembers_Object<T>(engine, className);
 
+    // void Renderer::AddStreamedTexture(Texture2D* texture)
+    // Not registered because have @nobind mark
+
     // void Renderer::SetShadowMapFilter(Object* instance, ShadowMapFilter functionPtr)
     // Not registered because have @nobind mark
 
+    // unsigned Renderer::AllocateInstancingBuffer(unsigned numInstances)
+    engine->RegisterObjectMethod(className, "uint AllocateInstancingBuffer(uint)", AS_METHODPR(T, AllocateInstancingBuffer, (unsigned), unsigned), AS_CALL_THISCALL);
+
     // void Renderer::ApplyShadowMapFilter(View* view, Texture2D* shadowMap, float blurScale)
     engine->RegisterObjectMethod(className, "void ApplyShadowMapFilter(View@+, Texture2D@+, float)", AS_METHODPR(T, ApplyShadowMapFilter, (View*, Texture2D*, float), void), AS_CALL_THISCALL);
 
     // void Renderer::DrawDebugGeometry(bool depthTest)
     engine->RegisterObjectMethod(className, "void DrawDebugGeometry(bool)", AS_METHODPR(T, DrawDebugGeometry, (bool), void), AS_CALL_THISCALL);
 
+    // unsigned Renderer::GetAliasedScreenBufferMemory(bool allViews = false) const
+    engine->RegisterObjectMethod(className, "uint GetAliasedScreenBufferMemory(bool = false) const", AS_METHODPR(T, GetAliasedScreenBufferMemory, (bool) const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_aliasedScreenBufferMemory(bool = false) const", AS_METHODPR(T, GetAliasedScreenBufferMemory, (bool) const, unsigned), AS_CALL_THISCALL);
+
     // Texture2D* Renderer::GetDefaultLightRamp() const
     engine->RegisterObjectMethod(className, "Texture2D@+ GetDefaultLightRamp() const", AS_METHODPR(T, GetDefaultLightRamp, () const, Texture2D*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "Texture2D@+ get_defaultLightRamp() const", AS_METHODPR(T, GetDefaultLightRamp, () const, Texture2D*), AS_CALL_THISCALL);
@@ -11211,12 +11707,32 @@ template <class T> void RegisterMembers_Renderer(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "bool GetDynamicInstancing() const", AS_METHODPR(T, GetDynamicInstancing, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_dynamicInstancing() const", AS_METHODPR(T, GetDynamicInstancing, () const, bool), AS_CALL_THISCALL);
 
+    // bool Renderer::GetDynamicResolution() const
+    engine->RegisterObjectMethod(className, "bool GetDynamicResolution() const", AS_METHODPR(T, GetDynamicResolution, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_dynamicResolution() const", AS_METHODPR(T, GetDynamicResolution, () const, bool), AS_CALL_THISCALL);
+
+    // float Renderer::GetDynamicResolutionMaxScale() const
+    engine->RegisterObjectMethod(className, "float GetDynamicResolutionMaxScale() const", AS_METHODPR(T, GetDynamicResolutionMaxScale, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_dynamicResolutionMaxScale() const", AS_METHODPR(T, GetDynamicResolutionMaxScale, () const, float), AS_CALL_THISCALL);
+
+    // float Renderer::GetDynamicResolutionMinScale() const
+    engine->RegisterObjectMethod(className, "float GetDynamicResolutionMinScale() const", AS_METHODPR(T, GetDynamicResolutionMinScale, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_dynamicResolutionMinScale() const", AS_METHODPR(T, GetDynamicResolutionMinScale, () const, float), AS_CALL_THISCALL);
+
+    // float Renderer::GetDynamicResolutionTarget() const
+    engine->RegisterObjectMethod(className, "float GetDynamicResolutionTarget() const", AS_METHODPR(T, GetDynamicResolutionTarget, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_dynamicResolutionTarget() const", AS_METHODPR(T, GetDynamicResolutionTarget, () const, float), AS_CALL_THISCALL);
+
     // TextureCube* Renderer::GetFaceSelectCubeMap() const
     engine->RegisterObjectMethod(className, "TextureCube@+ GetFaceSelectCubeMap() const", AS_METHODPR(T, GetFaceSelectCubeMap, () const, TextureCube*), AS_CALL_THISCALL);
 
     // const FrameInfo& Renderer::GetFrameInfo() const
     engine->RegisterObjectMethod(className, "const FrameInfo& GetFrameInfo() const", AS_METHODPR(T, GetFrameInfo, () const, const FrameInfo&), AS_CALL_THISCALL);
 
+    // bool Renderer::GetGPUOcclusion() const
+    engine->RegisterObjectMethod(className, "bool GetGPUOcclusion() const", AS_METHODPR(T, GetGPUOcclusion, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_gpuOcclusion() const", AS_METHODPR(T, GetGPUOcclusion, () const, bool), AS_CALL_THISCALL);
+
     // bool Renderer::GetHDRRendering() const
     engine->RegisterObjectMethod(className, "bool GetHDRRendering() const", AS_METHODPR(T, GetHDRRendering, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_hdrRendering() const", AS_METHODPR(T, GetHDRRendering, () const, bool), AS_CALL_THISCALL);
@@ -11237,6 +11753,9 @@ template <class T> void RegisterMembers_Renderer(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "MaterialQuality GetMaterialQuality() const", AS_METHODPR(T, GetMaterialQuality, () const, MaterialQuality), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "MaterialQuality get_materialQuality() const", AS_METHODPR(T, GetMaterialQuality, () const, MaterialQuality), AS_CALL_THISCALL);
 
+    // int Renderer::GetMaxAuxiliaryViews() const
+    engine->RegisterObjectMethod(className, "int GetMaxAuxiliaryViews() const", AS_METHODPR(T, GetMaxAuxiliaryViews, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_maxAuxiliaryViews() const", AS_METHODPR(T, GetMaxAuxiliaryViews, () const, int), AS_CALL_THISCALL);
     // int Renderer::GetMaxOccluderTriangles() const
     engine->RegisterObjectMethod(className, "int GetMaxOccluderTriangles() const", AS_METHODPR(T, GetMaxOccluderTriangles, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_maxOccluderTriangles() const", AS_METHODPR(T, GetMaxOccluderTriangles, () const, int), AS_CALL_THISCALL);
@@ -11293,6 +11812,10 @@ template <class T> void RegisterMembers_Renderer(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "uint GetNumShadowMaps(bool = false) const", AS_METHODPR(T, GetNumShadowMaps, (bool) const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numShadowMaps(bool = false) const", AS_METHODPR(T, GetNumShadowMaps, (bool) const, unsigned), AS_CALL_THISCALL);
 
+    // unsigned Renderer::GetNumStreamedTextures() const
+    engine->RegisterObjectMethod(className, "uint GetNumStreamedTextures() const", AS_METHODPR(T, GetNumStreamedTextures, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numStreamedTextures() const", AS_METHODPR(T, GetNumStreamedTextures, () const, unsigned), AS_CALL_THISCALL);
+
     // unsigned Renderer::GetNumViewports() const
     engine->RegisterObjectMethod(className, "uint GetNumViewports() const", AS_METHODPR(T, GetNumViewports, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numViewports() const", AS_METHODPR(T, GetNumViewports, () const, unsigned), AS_CALL_THISCALL);
@@ -11318,16 +11841,39 @@ template <class T> void RegisterMembers_Renderer(asIScriptEngine* engine, const
     // Geometry* Renderer::GetQuadGeometry()
     engine->RegisterObjectMethod(className, "Geometry@+ GetQuadGeometry()", AS_METHODPR(T, GetQuadGeometry, (), Geometry*), AS_CALL_THISCALL);
 
+    // float Renderer::GetResolutionScale() const
+    engine->RegisterObjectMethod(className, "float GetResolutionScale() const", AS_METHODPR(T, GetResolutionScale, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_resolutionScale() const", AS_METHODPR(T, GetResolutionScale, () const, float), AS_CALL_THISCALL);
+
     // bool Renderer::GetReuseShadowMaps() const
     engine->RegisterObjectMethod(className, "bool GetReuseShadowMaps() const", AS_METHODPR(T, GetReuseShadowMaps, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_reuseShadowMaps() const", AS_METHODPR(T, GetReuseShadowMaps, () const, bool), AS_CALL_THISCALL);
 
-    // Texture* Renderer::GetScreenBuffer(int width, int height, unsigned format, int multiSample, bool autoResolve, bool cubemap, bool filtered, bool srgb, unsigned persistentKey = 0)
-    engine->RegisterObjectMethod(className, "Texture@+ GetScreenBuffer(int, int, uint, int, bool, bool, bool, bool, uint = 0)", AS_METHODPR(T, GetScreenBuffer, (int, int, unsigned, int, bool, bool, bool, bool, unsigned), Texture*), AS_CALL_THISCALL);
+    // bool Renderer::GetScreenBufferAliasing() const
+    engine->RegisterObjectMethod(className, "bool GetScreenBufferAliasing() const", AS_METHODPR(T, GetScreenBufferAliasing, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_screenBufferAliasing() const", AS_METHODPR(T, GetScreenBufferAliasing, () const, bool), AS_CALL_THISCALL);
+
+    // Texture* Renderer::GetScreenBuffer(int width, int height, unsigned format, int multiSample, bool autoResolve, bool cubemap, bool filtered, bool srgb, unsigned persistentKey = 0, bool computeAccess = false)
+    engine->RegisterObjectMethod(className, "Texture@+ GetScreenBuffer(int, int, uint, int, bool, bool, bool, bool, uint = 0, bool = false)", AS_METHODPR(T, GetScreenBuffer, (int, int, unsigned, int, bool, bool, bool, bool, unsigned, bool), Texture*), AS_CALL_THISCALL);
 
     // Camera* Renderer::GetShadowCamera()
     engine->RegisterObjectMethod(className, "Camera@+ GetShadowCamera()", AS_METHODPR(T, GetShadowCamera, (), Camera*), AS_CALL_THISCALL);
 
+    // bool Renderer::GetShadowAtlas() const
+    engine->RegisterObjectMethod(className, "bool GetShadowAtlas() const", AS_METHODPR(T, GetShadowAtlas, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_shadowAtlas() const", AS_METHODPR(T, GetShadowAtlas, () const, bool), AS_CALL_THISCALL);
+
+    // int Renderer::GetShadowAtlasSize() const
+    engine->RegisterObjectMethod(className, "int GetShadowAtlasSize() const", AS_METHODPR(T, GetShadowAtlasSize, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_shadowAtlasSize() const", AS_METHODPR(T, GetShadowAtlasSize, () const, int), AS_CALL_THISCALL);
+
+    // Texture2D* Renderer::GetShadowAtlasTile(Light* light, Camera* camera, unsigned viewWidth, unsigned viewHeight, IntRect& tileRect)
+    // Error: type "IntRect&" can not automatically bind
+
+    // bool Renderer::GetShadowMapCaching() const
+    engine->RegisterObjectMethod(className, "bool GetShadowMapCaching() const", AS_METHODPR(T, GetShadowMapCaching, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_shadowMapCaching() const", AS_METHODPR(T, GetShadowMapCaching, () const, bool), AS_CALL_THISCALL);
+
     // Texture2D* Renderer::GetShadowMap(Light* light, Camera* camera, unsigned viewWidth, unsigned viewHeight)
     engine->RegisterObjectMethod(className, "Texture2D@+ GetShadowMap(Light@+, Camera@+, uint, uint)", AS_METHODPR(T, GetShadowMap, (Light*, Camera*, unsigned, unsigned), Texture2D*), AS_CALL_THISCALL);
 
@@ -11359,10 +11905,22 @@ template <class T> void RegisterMembers_Renderer(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "MaterialQuality GetTextureQuality() const", AS_METHODPR(T, GetTextureQuality, () const, MaterialQuality), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "MaterialQuality get_textureQuality() const", AS_METHODPR(T, GetTextureQuality, () const, MaterialQuality), AS_CALL_THISCALL);
 
+    // unsigned long long Renderer::GetTextureStreamingBudget() const
+    engine->RegisterObjectMethod(className, "uint64 GetTextureStreamingBudget() const", AS_METHODPR(T, GetTextureStreamingBudget, () const, unsigned long long), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint64 get_textureStreamingBudget() const", AS_METHODPR(T, GetTextureStreamingBudget, () const, unsigned long long), AS_CALL_THISCALL);
+
+    // float Renderer::GetTextureStreamingScale() const
+    engine->RegisterObjectMethod(className, "float GetTextureStreamingScale() const", AS_METHODPR(T, GetTextureStreamingScale, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_textureStreamingScale() const", AS_METHODPR(T, GetTextureStreamingScale, () const, float), AS_CALL_THISCALL);
+
     // bool Renderer::GetThreadedOcclusion() const
     engine->RegisterObjectMethod(className, "bool GetThreadedOcclusion() const", AS_METHODPR(T, GetThreadedOcclusion, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_threadedOcclusion() const", AS_METHODPR(T, GetThreadedOcclusion, () const, bool), AS_CALL_THISCALL);
 
+    // float Renderer::GetUpscaleSharpness() const
+    engine->RegisterObjectMethod(className, "float GetUpscaleSharpness() const", AS_METHODPR(T, GetUpscaleSharpness, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_upscaleSharpness() const", AS_METHODPR(T, GetUpscaleSharpness, () const, float), AS_CALL_THISCALL);
+
     // Viewport* Renderer::GetViewport(unsigned index) const
     engine->RegisterObjectMethod(className, "Viewport@+ GetViewport(uint) const", AS_METHODPR(T, GetViewport, (unsigned) const, Viewport*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "Viewport@+ get_viewports(uint) const", AS_METHODPR(T, GetViewport, (unsigned) const, Viewport*), AS_CALL_THISCALL);
@@ -11424,6 +11982,21 @@ template <class T> void RegisterMembers_Renderer(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "void SetDynamicInstancing(bool)", AS_METHODPR(T, SetDynamicInstancing, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_dynamicInstancing(bool)", AS_METHODPR(T, SetDynamicInstancing, (bool), void), AS_CALL_THISCALL);
 
+    // void Renderer::SetDynamicResolution(bool enable)
+    engine->RegisterObjectMethod(className, "void SetDynamicResolution(bool)", AS_METHODPR(T, SetDynamicResolution, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_dynamicResolution(bool)", AS_METHODPR(T, SetDynamicResolution, (bool), void), AS_CALL_THISCALL);
+
+    // void Renderer::SetDynamicResolutionRange(float minScale, float maxScale)
+    engine->RegisterObjectMethod(className, "void SetDynamicResolutionRange(float, float)", AS_METHODPR(T, SetDynamicResolutionRange, (float, float), void), AS_CALL_THISCALL);
+
+    // void Renderer::SetDynamicResolutionTarget(float frameTime)
+    engine->RegisterObjectMethod(className, "void SetDynamicResolutionTarget(float)", AS_METHODPR(T, SetDynamicResolutionTarget, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_dynamicResolutionTarget(float)", AS_METHODPR(T, SetDynamicResolutionTarget, (float), void), AS_CALL_THISCALL);
+
+    // void Renderer::SetGPUOcclusion(bool enable)
+    engine->RegisterObjectMethod(className, "void SetGPUOcclusion(bool)", AS_METHODPR(T, SetGPUOcclusion, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_gpuOcclusion(bool)", AS_METHODPR(T, SetGPUOcclusion, (bool), void), AS_CALL_THISCALL);
+
     // void Renderer::SetHDRRendering(bool enable)
     engine->RegisterObjectMethod(className, "void SetHDRRendering(bool)", AS_METHODPR(T, SetHDRRendering, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_hdrRendering(bool)", AS_METHODPR(T, SetHDRRendering, (bool), void), AS_CALL_THISCALL);
@@ -11435,6 +12008,10 @@ template <class T> void RegisterMembers_Renderer(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "void SetMaterialQuality(MaterialQuality)", AS_METHODPR(T, SetMaterialQuality, (MaterialQuality), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_materialQuality(MaterialQuality)", AS_METHODPR(T, SetMaterialQuality, (MaterialQuality), void), AS_CALL_THISCALL);
 
+    // void Renderer::SetMaxAuxiliaryViews(int views)
+    engine->RegisterObjectMethod(className, "void SetMaxAuxiliaryViews(int)", AS_METHODPR(T, SetMaxAuxiliaryViews, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxAuxiliaryViews(int)", AS_METHODPR(T, SetMaxAuxiliaryViews, (int), void), AS_CALL_THISCALL);
+
     // void Renderer::SetMaxOccluderTriangles(int triangles)
     engine->RegisterObjectMethod(className, "void SetMaxOccluderTriangles(int)", AS_METHODPR(T, SetMaxOccluderTriangles, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_maxOccluderTriangles(int)", AS_METHODPR(T, SetMaxOccluderTriangles, (int), void), AS_CALL_THISCALL);
@@ -11479,10 +12056,30 @@ template <class T> void RegisterMembers_Renderer(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "void SetOcclusionBufferSize(int)", AS_METHODPR(T, SetOcclusionBufferSize, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_occlusionBufferSize(int)", AS_METHODPR(T, SetOcclusionBufferSize, (int), void), AS_CALL_THISCALL);
 
+    // void Renderer::SetResolutionScale(float scale)
+    engine->RegisterObjectMethod(className, "void SetResolutionScale(float)", AS_METHODPR(T, SetResolutionScale, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_resolutionScale(float)", AS_METHODPR(T, SetResolutionScale, (float), void), AS_CALL_THISCALL);
+
     // void Renderer::SetReuseShadowMaps(bool enable)
     engine->RegisterObjectMethod(className, "void SetReuseShadowMaps(bool)", AS_METHODPR(T, SetReuseShadowMaps, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_reuseShadowMaps(bool)", AS_METHODPR(T, SetReuseShadowMaps, (bool), void), AS_CALL_THISCALL);
 
+    // void Renderer::SetScreenBufferAliasing(bool enable)
+    engine->RegisterObjectMethod(className, "void SetScreenBufferAliasing(bool)", AS_METHODPR(T, SetScreenBufferAliasing, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_screenBufferAliasing(bool)", AS_METHODPR(T, SetScreenBufferAliasing, (bool), void), AS_CALL_THISCALL);
+
+    // void Renderer::SetShadowAtlas(bool enable)
+    engine->RegisterObjectMethod(className, "void SetShadowAtlas(bool)", AS_METHODPR(T, SetShadowAtlas, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_shadowAtlas(bool)", AS_METHODPR(T, SetShadowAtlas, (bool), void), AS_CALL_THISCALL);
+
+    // void Renderer::SetShadowAtlasSize(int size)
+    engine->RegisterObjectMethod(className, "void SetShadowAtlasSize(int)", AS_METHODPR(T, SetShadowAtlasSize, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_shadowAtlasSize(int)", AS_METHODPR(T, SetShadowAtlasSize, (int), void), AS_CALL_THISCALL);
+
+    // void Renderer::SetShadowMapCaching(bool enable)
+    engine->RegisterObjectMethod(className, "void SetShadowMapCaching(bool)", AS_METHODPR(T, SetShadowMapCaching, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_shadowMapCaching(bool)", AS_METHODPR(T, SetShadowMapCaching, (bool), void), AS_CALL_THISCALL);
+
     // void Renderer::SetShadowMapSize(int size)
     engine->RegisterObjectMethod(className, "void SetShadowMapSize(int)", AS_METHODPR(T, SetShadowMapSize, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_shadowMapSize(int)", AS_METHODPR(T, SetShadowMapSize, (int), void), AS_CALL_THISCALL);
@@ -11511,10 +12108,22 @@ template <class T> void RegisterMembers_Renderer(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "void SetTextureQuality(MaterialQuality)", AS_METHODPR(T, SetTextureQuality, (MaterialQuality), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_textureQuality(MaterialQuality)", AS_METHODPR(T, SetTextureQuality, (MaterialQuality), void), AS_CALL_THISCALL);
 
+    // void Renderer::SetTextureStreamingBudget(unsigned long long budget)
+    engine->RegisterObjectMethod(className, "void SetTextureStreamingBudget(uint64)", AS_METHODPR(T, SetTextureStreamingBudget, (unsigned long long), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_textureStreamingBudget(uint64)", AS_METHODPR(T, SetTextureStreamingBudget, (unsigned long long), void), AS_CALL_THISCALL);
+
+    // void Renderer::SetTextureStreamingScale(float scale)
+    engine->RegisterObjectMethod(className, "void SetTextureStreamingScale(float)", AS_METHODPR(T, SetTextureStreamingScale, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_textureStreamingScale(float)", AS_METHODPR(T, SetTextureStreamingScale, (float), void), AS_CALL_THISCALL);
+
     // void Renderer::SetThreadedOcclusion(bool enable)
     engine->RegisterObjectMethod(className, "void SetThreadedOcclusion(bool)", AS_METHODPR(T, SetThreadedOcclusion, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_threadedOcclusion(bool)", AS_METHODPR(T, SetThreadedOcclusion, (bool), void), AS_CALL_THISCALL);
 
+    // void Renderer::SetUpscaleSharpness(float sharpness)
+    engine->RegisterObjectMethod(className, "void SetUpscaleSharpness(float)", AS_METHODPR(T, SetUpscaleSharpness, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_upscaleSharpness(float)", AS_METHODPR(T, SetUpscaleSharpness, (float), void), AS_CALL_THISCALL);
+
     // void Renderer::SetViewport(unsigned index, Viewport* viewport)
     engine->RegisterObjectMethod(className, "void SetViewport(uint, Viewport@+)", AS_METHODPR(T, SetViewport, (unsigned, Viewport*), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_viewports(uint, Viewport@+)", AS_METHODPR(T, SetViewport, (unsigned, Viewport*), void), AS_CALL_THISCALL);
@@ -11638,12 +12247,16 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     // Error: type "ResourceRouter" can not automatically bind bacause have @nobind mark
     // const HashMap<StringHash, ResourceGroup>& ResourceCache::GetAllResources() const
     // Error: type "const HashMap<StringHash, ResourceGroup>&" can not automatically bind
+    // SharedPtr<File> ResourceCache::GetCompiledFile(Deserializer& source) const
+    // Not registered because have @nobind mark
     // ResourceRouter* ResourceCache::GetResourceRouter(unsigned index) const
     // Error: type "ResourceRouter" can not automatically bind bacause have @nobind mark
     // void ResourceCache::GetResources(PODVector<Resource*>& result, StringHash type) const
     // Error: type "PODVector<Resource*>&" can not automatically bind
     // void ResourceCache::RemoveResourceRouter(ResourceRouter* router)
     // Error: type "ResourceRouter" can not automatically bind bacause have @nobind mark
+    // bool ResourceCache::SaveCompiledFile(Deserializer& source, const void* data, unsigned size) const
+    // Not registered because have @nobind mark
 
     // bool ResourceCache::AddManualResource(Resource* resource)
     engine->RegisterObjectMethod(className, "bool AddManualResource(Resource@+)", AS_METHODPR(T, AddManualResource, (Resource*), bool), AS_CALL_THISCALL);
@@ -11660,6 +12273,15 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     // bool ResourceCache::BackgroundLoadResource(StringHash type, const String& name, bool sendEventOnFailure = true, Resource* caller = nullptr)
     engine->RegisterObjectMethod(className, "bool BackgroundLoadResource(StringHash, const String&in, bool = true, Resource@+ = null)", AS_METHODPR(T, BackgroundLoadResource, (StringHash, const String&, bool, Resource*), bool), AS_CALL_THISCALL);
 
+    // bool ResourceCache::BackgroundReloadResource(Resource* resource, int priority = 0)
+    engine->RegisterObjectMethod(className, "bool BackgroundReloadResource(Resource@+, int = 0)", AS_METHODPR(T, BackgroundReloadResource, (Resource*, int), bool), AS_CALL_THISCALL);
+
+    // void ResourceCache::BeginManifestRecording()
+    engine->RegisterObjectMethod(className, "void BeginManifestRecording()", AS_METHODPR(T, BeginManifestRecording, (), void), AS_CALL_THISCALL);
+
+    // void ResourceCache::EndManifestRecording()
+    engine->RegisterObjectMethod(className, "void EndManifestRecording()", AS_METHODPR(T, EndManifestRecording, (), void), AS_CALL_THISCALL);
+
     // bool ResourceCache::Exists(const String& name) const
     engine->RegisterObjectMethod(className, "bool Exists(const String&in) const", AS_METHODPR(T, Exists, (const String&) const, bool), AS_CALL_THISCALL);
 
@@ -11667,6 +12289,14 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "bool GetAutoReloadResources() const", AS_METHODPR(T, GetAutoReloadResources, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_autoReloadResources() const", AS_METHODPR(T, GetAutoReloadResources, () const, bool), AS_CALL_THISCALL);
 
+    // int ResourceCache::GetBackgroundLoadThreadPriority() const
+    engine->RegisterObjectMethod(className, "int GetBackgroundLoadThreadPriority() const", AS_METHODPR(T, GetBackgroundLoadThreadPriority, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_backgroundLoadThreadPriority() const", AS_METHODPR(T, GetBackgroundLoadThreadPriority, () const, int), AS_CALL_THISCALL);
+
+    // const String& ResourceCache::GetCompiledResourceDir() const
+    engine->RegisterObjectMethod(className, "const String& GetCompiledResourceDir() const", AS_METHODPR(T, GetCompiledResourceDir, () const, const String&), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "const String& get_compiledResourceDir() const", AS_METHODPR(T, GetCompiledResourceDir, () const, const String&), AS_CALL_THISCALL);
+
     // Resource* ResourceCache::GetExistingResource(StringHash type, const String& name)
     engine->RegisterObjectMethod(className, "Resource@+ GetExistingResource(StringHash, const String&in)", AS_METHODPR(T, GetExistingResource, (StringHash, const String&), Resource*), AS_CALL_THISCALL);
 
@@ -11681,6 +12311,10 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "uint64 GetMemoryBudget(StringHash) const", AS_METHODPR(T, GetMemoryBudget, (StringHash) const, unsigned long long), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint64 get_memoryBudget(StringHash) const", AS_METHODPR(T, GetMemoryBudget, (StringHash) const, unsigned long long), AS_CALL_THISCALL);
 
+    // bool ResourceCache::GetMemoryMapPackages() const
+    engine->RegisterObjectMethod(className, "bool GetMemoryMapPackages() const", AS_METHODPR(T, GetMemoryMapPackages, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_memoryMapPackages() const", AS_METHODPR(T, GetMemoryMapPackages, () const, bool), AS_CALL_THISCALL);
+
     // unsigned long long ResourceCache::GetMemoryUse(StringHash type) const
     engine->RegisterObjectMethod(className, "uint64 GetMemoryUse(StringHash) const", AS_METHODPR(T, GetMemoryUse, (StringHash) const, unsigned long long), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint64 get_memoryUse(StringHash) const", AS_METHODPR(T, GetMemoryUse, (StringHash) const, unsigned long long), AS_CALL_THISCALL);
@@ -11689,6 +12323,14 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "uint GetNumBackgroundLoadResources() const", AS_METHODPR(T, GetNumBackgroundLoadResources, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numBackgroundLoadResources() const", AS_METHODPR(T, GetNumBackgroundLoadResources, () const, unsigned), AS_CALL_THISCALL);
 
+    // unsigned ResourceCache::GetNumBackgroundLoadThreads() const
+    engine->RegisterObjectMethod(className, "uint GetNumBackgroundLoadThreads() const", AS_METHODPR(T, GetNumBackgroundLoadThreads, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numBackgroundLoadThreads() const", AS_METHODPR(T, GetNumBackgroundLoadThreads, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned ResourceCache::GetNumPendingReloads() const
+    engine->RegisterObjectMethod(className, "uint GetNumPendingReloads() const", AS_METHODPR(T, GetNumPendingReloads, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numPendingReloads() const", AS_METHODPR(T, GetNumPendingReloads, () const, unsigned), AS_CALL_THISCALL);
+
     // const Vector<SharedPtr<PackageFile>>& ResourceCache::GetPackageFiles() const
     engine->RegisterObjectMethod(className, "Array<PackageFile@>@ GetPackageFiles() const", AS_FUNCTION_OBJFIRST(ResourceCache_constspVectorlesSharedPtrlesPackageFilegregreamp_GetPackageFiles_void_template<ResourceCache>), AS_CALL_CDECL_OBJFIRST);
     engine->RegisterObjectMethod(className, "Array<PackageFile@>@ get_packageFiles() const", AS_FUNCTION_OBJFIRST(ResourceCache_constspVectorlesSharedPtrlesPackageFilegregreamp_GetPackageFiles_void_template<ResourceCache>), AS_CALL_CDECL_OBJFIRST);
@@ -11696,6 +12338,14 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     // String ResourceCache::GetPreferredResourceDir(const String& path) const
     engine->RegisterObjectMethod(className, "String GetPreferredResourceDir(const String&in) const", AS_METHODPR(T, GetPreferredResourceDir, (const String&) const, String), AS_CALL_THISCALL);
 
+    // bool ResourceCache::GetReleaseModelShadowData() const
+    engine->RegisterObjectMethod(className, "bool GetReleaseModelShadowData() const", AS_METHODPR(T, GetReleaseModelShadowData, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_releaseModelShadowData() const", AS_METHODPR(T, GetReleaseModelShadowData, () const, bool), AS_CALL_THISCALL);
+
+    // int ResourceCache::GetReloadResourcesMs() const
+    engine->RegisterObjectMethod(className, "int GetReloadResourcesMs() const", AS_METHODPR(T, GetReloadResourcesMs, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_reloadResourcesMs() const", AS_METHODPR(T, GetReloadResourcesMs, () const, int), AS_CALL_THISCALL);
+
     // Resource* ResourceCache::GetResource(StringHash type, const String& name, bool sendEventOnFailure = true)
     engine->RegisterObjectMethod(className, "Resource@+ GetResource(StringHash, const String&in, bool = true)", AS_METHODPR(T, GetResource, (StringHash, const String&, bool), Resource*), AS_CALL_THISCALL);
 
@@ -11714,6 +12364,10 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "bool GetSearchPackagesFirst() const", AS_METHODPR(T, GetSearchPackagesFirst, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_searchPackagesFirst() const", AS_METHODPR(T, GetSearchPackagesFirst, () const, bool), AS_CALL_THISCALL);
 
+    // bool ResourceCache::GetStripHeadlessRenderData() const
+    engine->RegisterObjectMethod(className, "bool GetStripHeadlessRenderData() const", AS_METHODPR(T, GetStripHeadlessRenderData, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_stripHeadlessRenderData() const", AS_METHODPR(T, GetStripHeadlessRenderData, () const, bool), AS_CALL_THISCALL);
+
     // SharedPtr<Resource> ResourceCache::GetTempResource(StringHash type, const String& name, bool sendEventOnFailure = true)
     engine->RegisterObjectMethod(className, "Resource@+ GetTempResource(StringHash, const String&in, bool = true)", AS_FUNCTION_OBJFIRST(ResourceCache_SharedPtrlesResourcegre_GetTempResource_StringHash_constspStringamp_bool_template<ResourceCache>), AS_CALL_CDECL_OBJFIRST);
 
@@ -11721,6 +12375,12 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "uint64 GetTotalMemoryUse() const", AS_METHODPR(T, GetTotalMemoryUse, () const, unsigned long long), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint64 get_totalMemoryUse() const", AS_METHODPR(T, GetTotalMemoryUse, () const, unsigned long long), AS_CALL_THISCALL);
 
+    // bool ResourceCache::IsRecordingManifest() const
+    engine->RegisterObjectMethod(className, "bool IsRecordingManifest() const", AS_METHODPR(T, IsRecordingManifest, () const, bool), AS_CALL_THISCALL);
+
+    // unsigned ResourceCache::PreloadManifest(const String& fileName)
+    engine->RegisterObjectMethod(className, "uint PreloadManifest(const String&in)", AS_METHODPR(T, PreloadManifest, (const String&), unsigned), AS_CALL_THISCALL);
+
     // String ResourceCache::PrintMemoryUsage() const
     engine->RegisterObjectMethod(className, "String PrintMemoryUsage() const", AS_METHODPR(T, PrintMemoryUsage, () const, String), AS_CALL_THISCALL);
 
@@ -11763,10 +12423,24 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     // String ResourceCache::SanitateResourceName(const String& name) const
     engine->RegisterObjectMethod(className, "String SanitateResourceName(const String&in) const", AS_METHODPR(T, SanitateResourceName, (const String&) const, String), AS_CALL_THISCALL);
 
+    // bool ResourceCache::SaveManifest(const String& fileName) const
+    engine->RegisterObjectMethod(className, "bool SaveManifest(const String&in) const", AS_METHODPR(T, SaveManifest, (const String&) const, bool), AS_CALL_THISCALL);
+
     // void ResourceCache::SetAutoReloadResources(bool enable)
     engine->RegisterObjectMethod(className, "void SetAutoReloadResources(bool)", AS_METHODPR(T, SetAutoReloadResources, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_autoReloadResources(bool)", AS_METHODPR(T, SetAutoReloadResources, (bool), void), AS_CALL_THISCALL);
 
+    // bool ResourceCache::SetBackgroundLoadPriority(StringHash type, const String& name, int priority)
+    engine->RegisterObjectMethod(className, "bool SetBackgroundLoadPriority(StringHash, const String&in, int)", AS_METHODPR(T, SetBackgroundLoadPriority, (StringHash, const String&, int), bool), AS_CALL_THISCALL);
+
+    // void ResourceCache::SetBackgroundLoadThreadPriority(int priority)
+    engine->RegisterObjectMethod(className, "void SetBackgroundLoadThreadPriority(int)", AS_METHODPR(T, SetBackgroundLoadThreadPriority, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_backgroundLoadThreadPriority(int)", AS_METHODPR(T, SetBackgroundLoadThreadPriority, (int), void), AS_CALL_THISCALL);
+
+    // void ResourceCache::SetCompiledResourceDir(const String& path)
+    engine->RegisterObjectMethod(className, "void SetCompiledResourceDir(const String&in)", AS_METHODPR(T, SetCompiledResourceDir, (const String&), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_compiledResourceDir(const String&in)", AS_METHODPR(T, SetCompiledResourceDir, (const String&), void), AS_CALL_THISCALL);
+
     // void ResourceCache::SetFinishBackgroundResourcesMs(int ms)
     engine->RegisterObjectMethod(className, "void SetFinishBackgroundResourcesMs(int)", AS_METHODPR(T, SetFinishBackgroundResourcesMs, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_finishBackgroundResourcesMs(int)", AS_METHODPR(T, SetFinishBackgroundResourcesMs, (int), void), AS_CALL_THISCALL);
@@ -11775,6 +12449,22 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "void SetMemoryBudget(StringHash, uint64)", AS_METHODPR(T, SetMemoryBudget, (StringHash, unsigned long long), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_memoryBudget(StringHash, uint64)", AS_METHODPR(T, SetMemoryBudget, (StringHash, unsigned long long), void), AS_CALL_THISCALL);
 
+    // void ResourceCache::SetMemoryMapPackages(bool enable)
+    engine->RegisterObjectMethod(className, "void SetMemoryMapPackages(bool)", AS_METHODPR(T, SetMemoryMapPackages, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_memoryMapPackages(bool)", AS_METHODPR(T, SetMemoryMapPackages, (bool), void), AS_CALL_THISCALL);
+
+    // void ResourceCache::SetNumBackgroundLoadThreads(unsigned num)
+    engine->RegisterObjectMethod(className, "void SetNumBackgroundLoadThreads(uint)", AS_METHODPR(T, SetNumBackgroundLoadThreads, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_numBackgroundLoadThreads(uint)", AS_METHODPR(T, SetNumBackgroundLoadThreads, (unsigned), void), AS_CALL_THISCALL);
+
+    // void ResourceCache::SetReleaseModelShadowData(bool enable)
+    engine->RegisterObjectMethod(className, "void SetReleaseModelShadowData(bool)", AS_METHODPR(T, SetReleaseModelShadowData, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_releaseModelShadowData(bool)", AS_METHODPR(T, SetReleaseModelShadowData, (bool), void), AS_CALL_THISCALL);
+
+    // void ResourceCache::SetReloadResourcesMs(int ms)
+    engine->RegisterObjectMethod(className, "void SetReloadResourcesMs(int)", AS_METHODPR(T, SetReloadResourcesMs, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_reloadResourcesMs(int)", AS_METHODPR(T, SetReloadResourcesMs, (int), void), AS_CALL_THISCALL);
+
     // void ResourceCache::SetReturnFailedResources(bool enable)
     engine->RegisterObjectMethod(className, "void SetReturnFailedResources(bool)", AS_METHODPR(T, SetReturnFailedResources, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_returnFailedResources(bool)", AS_METHODPR(T, SetReturnFailedResources, (bool), void), AS_CALL_THISCALL);
@@ -11783,6 +12473,10 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "void SetSearchPackagesFirst(bool)", AS_METHODPR(T, SetSearchPackagesFirst, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_searchPackagesFirst(bool)", AS_METHODPR(T, SetSearchPackagesFirst, (bool), void), AS_CALL_THISCALL);
 
+    // void ResourceCache::SetStripHeadlessRenderData(bool enable)
+    engine->RegisterObjectMethod(className, "void SetStripHeadlessRenderData(bool)", AS_METHODPR(T, SetStripHeadlessRenderData, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_stripHeadlessRenderData(bool)", AS_METHODPR(T, SetStripHeadlessRenderData, (bool), void), AS_CALL_THISCALL);
+
     // void ResourceCache::StoreResourceDependency(Resource* resource, const String& dependency)
     engine->RegisterObjectMethod(className, "void StoreResourceDependency(Resource@+, const String&in)", AS_METHODPR(T, StoreResourceDependency, (Resource*, const String&), void), AS_CALL_THISCALL);
 
@@ -11828,6 +12522,18 @@ template <class T> void RegisterMembers_Serializable(asIScriptEngine* engine, co
     // Error: type "const Vector<AttributeInfo>*" can not automatically bind
     // NetworkState* Serializable::GetNetworkState() const
     // Error: type "NetworkState*" can not automatically bind
+    // Variant Serializable::GetAttribute(const ResolvedAttribute& resolved) const
+    // Error: type "const ResolvedAttribute&" can not automatically bind
+    // ResolvedAttribute Serializable::ResolveAttribute(const String& name) const
+    // Error: type "ResolvedAttribute" can not automatically bind
+    // bool Serializable::SetAttribute(const ResolvedAttribute& resolved, const Variant& value)
+    // Error: type "const ResolvedAttribute&" can not automatically bind
+    // unsigned Serializable::SetAttributes(const PODVector<ResolvedAttribute>& attributes, const Vector<Variant>& values)
+    // Error: type "const PODVector<ResolvedAttribute>&" can not automatically bind
+    // void Serializable::WriteQuantizedLatestDataUpdate(Serializer& dest, unsigned char timeStamp, const PODVector<unsigned>* baseline, PODVector<unsigned>& values)
+    // Error: type "const PODVector<unsigned>*" can not automatically bind
+    // bool Serializable::ReadQuantizedLatestDataUpdate(Deserializer& source, const PODVector<unsigned>* baseline, PODVector<unsigned>& values)
+    // Error: type "const PODVector<unsigned>*" can not automatically bind
 
     // void Serializable::AllocateNetworkState()
     engine->RegisterObjectMethod(className, "void AllocateNetworkState()", AS_METHODPR(T, AllocateNetworkState, (), void), AS_CALL_THISCALL);
@@ -11859,6 +12565,9 @@ template <class T> void RegisterMembers_Serializable(asIScriptEngine* engine, co
     // unsigned Serializable::GetNumNetworkAttributes() const
     engine->RegisterObjectMethod(className, "uint GetNumNetworkAttributes() const", AS_METHODPR(T, GetNumNetworkAttributes, () const, unsigned), AS_CALL_THISCALL);
 
+    // bool Serializable::HasQuantizedLatestData() const
+    engine->RegisterObjectMethod(className, "bool HasQuantizedLatestData() const", AS_METHODPR(T, HasQuantizedLatestData, () const, bool), AS_CALL_THISCALL);
+
     // bool Serializable::IsTemporary() const
     engine->RegisterObjectMethod(className, "bool IsTemporary() const", AS_METHODPR(T, IsTemporary, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_temporary() const", AS_METHODPR(T, IsTemporary, () const, bool), AS_CALL_THISCALL);
@@ -12140,6 +12849,10 @@ template <class T> void RegisterMembers_UI(asIScriptEngine* engine, const char*
     engine->RegisterObjectMethod(className, "float GetScale() const", AS_METHODPR(T, GetScale, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_scale() const", AS_METHODPR(T, GetScale, () const, float), AS_CALL_THISCALL);
 
+    // bool UI::GetUseHitTestGrid() const
+    engine->RegisterObjectMethod(className, "bool GetUseHitTestGrid() const", AS_METHODPR(T, GetUseHitTestGrid, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_useHitTestGrid() const", AS_METHODPR(T, GetUseHitTestGrid, () const, bool), AS_CALL_THISCALL);
+
     // bool UI::GetUseMutableGlyphs() const
     engine->RegisterObjectMethod(className, "bool GetUseMutableGlyphs() const", AS_METHODPR(T, GetUseMutableGlyphs, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_useMutableGlyphs() const", AS_METHODPR(T, GetUseMutableGlyphs, () const, bool), AS_CALL_THISCALL);
@@ -12152,6 +12865,10 @@ template <class T> void RegisterMembers_UI(asIScriptEngine* engine, const char*
     engine->RegisterObjectMethod(className, "bool GetUseSystemClipboard() const", AS_METHODPR(T, GetUseSystemClipboard, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_useSystemClipboard() const", AS_METHODPR(T, GetUseSystemClipboard, () const, bool), AS_CALL_THISCALL);
 
+    // bool UI::GetUseThreadedGlyphRendering() const
+    engine->RegisterObjectMethod(className, "bool GetUseThreadedGlyphRendering() const", AS_METHODPR(T, GetUseThreadedGlyphRendering, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_useThreadedGlyphRendering() const", AS_METHODPR(T, GetUseThreadedGlyphRendering, () const, bool), AS_CALL_THISCALL);
+
     // bool UI::HasModalElement() const
     engine->RegisterObjectMethod(className, "bool HasModalElement() const", AS_METHODPR(T, HasModalElement, () const, bool), AS_CALL_THISCALL);
 
@@ -12252,6 +12969,10 @@ template <class T> void RegisterMembers_UI(asIScriptEngine* engine, const char*
     engine->RegisterObjectMethod(className, "void SetScale(float)", AS_METHODPR(T, SetScale, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_scale(float)", AS_METHODPR(T, SetScale, (float), void), AS_CALL_THISCALL);
 
+    // void UI::SetUseHitTestGrid(bool enable)
+    engine->RegisterObjectMethod(className, "void SetUseHitTestGrid(bool)", AS_METHODPR(T, SetUseHitTestGrid, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_useHitTestGrid(bool)", AS_METHODPR(T, SetUseHitTestGrid, (bool), void), AS_CALL_THISCALL);
+
     // void UI::SetUseMutableGlyphs(bool enable)
     engine->RegisterObjectMethod(className, "void SetUseMutableGlyphs(bool)", AS_METHODPR(T, SetUseMutableGlyphs, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_useMutableGlyphs(bool)", AS_METHODPR(T, SetUseMutableGlyphs, (bool), void), AS_CALL_THISCALL);
@@ -12264,6 +12985,10 @@ template <class T> void RegisterMembers_UI(asIScriptEngine* engine, const char*
     engine->RegisterObjectMethod(className, "void SetUseSystemClipboard(bool)", AS_METHODPR(T, SetUseSystemClipboard, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_useSystemClipboard(bool)", AS_METHODPR(T, SetUseSystemClipboard, (bool), void), AS_CALL_THISCALL);
 
+    // void UI::SetUseThreadedGlyphRendering(bool enable)
+    engine->RegisterObjectMethod(className, "void SetUseThreadedGlyphRendering(bool)", AS_METHODPR(T, SetUseThreadedGlyphRendering, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_useThreadedGlyphRendering(bool)", AS_METHODPR(T, SetUseThreadedGlyphRendering, (bool), void), AS_CALL_THISCALL);
+
     // void UI::SetWidth(float width)
     engine->RegisterObjectMethod(className, "void SetWidth(float)", AS_METHODPR(T, SetWidth, (float), void), AS_CALL_THISCALL);
 
@@ -12284,6 +13009,8 @@ template <class T> void RegisterMembers_VectorBuffer(asIScriptEngine* engine, co
     // Error: type "const PODVector<unsigned char>&" can not automatically bind
     // const unsigned char* VectorBuffer::GetData() const
     // Error: type "const unsigned char*" can not automatically bind
+    // const unsigned char* VectorBuffer::GetReadPointer() const override
+    // Error: type "const unsigned char*" can not automatically bind
     // unsigned char* VectorBuffer::GetModifiableData()
     // Error: type "unsigned char*" can not automatically bind
     // void VectorBuffer::SetData(const PODVector<unsigned char>& data)
@@ -12294,6 +13021,12 @@ template <class T> void RegisterMembers_VectorBuffer(asIScriptEngine* engine, co
     // void VectorBuffer::Clear()
     engine->RegisterObjectMethod(className, "void Clear()", AS_METHODPR(T, Clear, (), void), AS_CALL_THISCALL);
 
+    // unsigned VectorBuffer::GetCapacity() const
+    engine->RegisterObjectMethod(className, "uint GetCapacity() const", AS_METHODPR(T, GetCapacity, () const, unsigned), AS_CALL_THISCALL);
+
+    // void VectorBuffer::Reserve(unsigned size)
+    engine->RegisterObjectMethod(className, "void Reserve(uint)", AS_METHODPR(T, Reserve, (unsigned), void), AS_CALL_THISCALL);
+
     // void VectorBuffer::Resize(unsigned size)
     engine->RegisterObjectMethod(className, "void Resize(uint)", AS_METHODPR(T, Resize, (unsigned), void), AS_CALL_THISCALL);
 
@@ -12375,6 +13108,9 @@ template <class T> void RegisterMembers_VertexBuffer(asIScriptEngine* engine, co
     // unsigned long long VertexBuffer::GetBufferHash(unsigned streamIndex)
     engine->RegisterObjectMethod(className, "uint64 GetBufferHash(uint)", AS_METHODPR(T, GetBufferHash, (unsigned), unsigned long long), AS_CALL_THISCALL);
 
+    // unsigned VertexBuffer::GetDataRevision() const
+    engine->RegisterObjectMethod(className, "uint GetDataRevision() const", AS_METHODPR(T, GetDataRevision, () const, unsigned), AS_CALL_THISCALL);
+
     // VertexMaskFlags VertexBuffer::GetElementMask() const
     engine->RegisterObjectMethod(className, "VertexMaskFlags GetElementMask() const", AS_METHODPR(T, GetElementMask, () const, VertexMaskFlags), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "VertexMaskFlags get_elementMask() const", AS_METHODPR(T, GetElementMask, () const, VertexMaskFlags), AS_CALL_THISCALL);
@@ -12645,6 +13381,8 @@ template <class T> void RegisterMembers_WorkQueue(asIScriptEngine* engine, const
 {
     RegisterMembers_Object<T>(engine, className);
 
+    // void WorkQueue::AddDependency(WorkItem* item, WorkItem* dependency)
+    // Not registered because have @nobind mark
     // void WorkQueue::AddWorkItem(const SharedPtr<WorkItem>& item)
     // Error: type "const SharedPtr<WorkItem>&" can not automatically bind
     // SharedPtr<WorkItem> WorkQueue::GetFreeItem()
@@ -12653,6 +13391,10 @@ template <class T> void RegisterMembers_WorkQueue(asIScriptEngine* engine, const
     // Error: type "SharedPtr<WorkItem>" can not automatically bind
     // unsigned WorkQueue::RemoveWorkItems(const Vector<SharedPtr<WorkItem>>& items)
     // Error: type "const Vector<SharedPtr<WorkItem>>&" can not automatically bind
+    // void WorkQueue::ParallelFor(void* begin, unsigned count, unsigned elementSize, void(*workFunction)(const WorkItem*, unsigned), void* aux, unsigned minElementsPerItem, unsigned priority)
+    // Not registered because have @nobind mark
+    // void WorkQueue::Wait(WorkItem* item)
+    // Not registered because have @nobind mark
 
     // void WorkQueue::Complete(unsigned priority)
     engine->RegisterObjectMethod(className, "void Complete(uint)", AS_METHODPR(T, Complete, (unsigned), void), AS_CALL_THISCALL);
@@ -12666,6 +13408,15 @@ template <class T> void RegisterMembers_WorkQueue(asIScriptEngine* engine, const
     // unsigned WorkQueue::GetNumThreads() const
     engine->RegisterObjectMethod(className, "uint GetNumThreads() const", AS_METHODPR(T, GetNumThreads, () const, unsigned), AS_CALL_THISCALL);
 
+    // unsigned long long WorkQueue::GetThreadAffinity() const
+    engine->RegisterObjectMethod(className, "uint64 GetThreadAffinity() const", AS_METHODPR(T, GetThreadAffinity, () const, unsigned long long), AS_CALL_THISCALL);
+
+    // bool WorkQueue::GetThreadPinning() const
+    engine->RegisterObjectMethod(className, "bool GetThreadPinning() const", AS_METHODPR(T, GetThreadPinning, () const, bool), AS_CALL_THISCALL);
+
+    // int WorkQueue::GetThreadPriority() const
+    engine->RegisterObjectMethod(className, "int GetThreadPriority() const", AS_METHODPR(T, GetThreadPriority, () const, int), AS_CALL_THISCALL);
+
     // int WorkQueue::GetTolerance() const
     engine->RegisterObjectMethod(className, "int GetTolerance() const", AS_METHODPR(T, GetTolerance, () const, int), AS_CALL_THISCALL);
 
@@ -12684,6 +13435,12 @@ template <class T> void RegisterMembers_WorkQueue(asIScriptEngine* engine, const
     // void WorkQueue::SetNonThreadedWorkMs(int ms)
     engine->RegisterObjectMethod(className, "void SetNonThreadedWorkMs(int)", AS_METHODPR(T, SetNonThreadedWorkMs, (int), void), AS_CALL_THISCALL);
 
+    // void WorkQueue::SetThreadAffinity(unsigned long long mask, bool pin = false)
+    engine->RegisterObjectMethod(className, "void SetThreadAffinity(uint64, bool = false)", AS_METHODPR(T, SetThreadAffinity, (unsigned long long, bool), void), AS_CALL_THISCALL);
+
+    // void WorkQueue::SetThreadPriority(int priority)
+    engine->RegisterObjectMethod(className, "void SetThreadPriority(int)", AS_METHODPR(T, SetThreadPriority, (int), void), AS_CALL_THISCALL);
+
     // void WorkQueue::SetTolerance(int tolerance)
     engine->RegisterObjectMethod(className, "void SetTolerance(int)", AS_METHODPR(T, SetTolerance, (int), void), AS_CALL_THISCALL);
 
@@ -12699,6 +13456,9 @@ template <class T> void RegisterMembers_Database(asIScriptEngine* engine, const
 {
     RegisterMembers_Object<T>(engine, className);
 
+    // unsigned Database::QueueQuery(DbConnection* connection, const String& sql)
+    // Not registered because have @nobind mark
+
     // DbConnection* Database::Connect(const String& connectionString)
     engine->RegisterObjectMethod(className, "DbConnection@+ Connect(const String&in)", AS_METHODPR(T, Connect, (const String&), DbConnection*), AS_CALL_THISCALL);
 
@@ -12756,6 +13516,13 @@ template <class T> void RegisterMembers_Connection(asIScriptEngine* engine, cons
     engine->RegisterObjectMethod(className, "String GetAddress() const", AS_METHODPR(T, GetAddress, () const, String), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "String get_address() const", AS_METHODPR(T, GetAddress, () const, String), AS_CALL_THISCALL);
 
+    // int Connection::GetBandwidthBudget() const
+    engine->RegisterObjectMethod(className, "int GetBandwidthBudget() const", AS_METHODPR(T, GetBandwidthBudget, () const, int), AS_CALL_THISCALL);
+
+    // unsigned Connection::GetBandwidthLimit() const
+    engine->RegisterObjectMethod(className, "uint GetBandwidthLimit() const", AS_METHODPR(T, GetBandwidthLimit, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_bandwidthLimit() const", AS_METHODPR(T, GetBandwidthLimit, () const, unsigned), AS_CALL_THISCALL);
+
     // float Connection::GetBytesInPerSec() const
     engine->RegisterObjectMethod(className, "float GetBytesInPerSec() const", AS_METHODPR(T, GetBytesInPerSec, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_bytesInPerSec() const", AS_METHODPR(T, GetBytesInPerSec, () const, float), AS_CALL_THISCALL);
@@ -12764,6 +13531,10 @@ template <class T> void RegisterMembers_Connection(asIScriptEngine* engine, cons
     engine->RegisterObjectMethod(className, "float GetBytesOutPerSec() const", AS_METHODPR(T, GetBytesOutPerSec, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_bytesOutPerSec() const", AS_METHODPR(T, GetBytesOutPerSec, () const, float), AS_CALL_THISCALL);
 
+    // float Connection::GetCongestionScale() const
+    engine->RegisterObjectMethod(className, "float GetCongestionScale() const", AS_METHODPR(T, GetCongestionScale, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_congestionScale() const", AS_METHODPR(T, GetCongestionScale, () const, float), AS_CALL_THISCALL);
+
     // const Controls& Connection::GetControls() const
     engine->RegisterObjectMethod(className, "const Controls& GetControls() const", AS_METHODPR(T, GetControls, () const, const Controls&), AS_CALL_THISCALL);
 
@@ -12778,6 +13549,10 @@ template <class T> void RegisterMembers_Connection(asIScriptEngine* engine, cons
     // VariantMap& Connection::GetIdentity()
     engine->RegisterObjectMethod(className, "VariantMap& GetIdentity()", AS_METHODPR(T, GetIdentity, (), VariantMap&), AS_CALL_THISCALL);
 
+    // float Connection::GetInterestRadius() const
+    engine->RegisterObjectMethod(className, "float GetInterestRadius() const", AS_METHODPR(T, GetInterestRadius, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_interestRadius() const", AS_METHODPR(T, GetInterestRadius, () const, float), AS_CALL_THISCALL);
+
     // unsigned Connection::GetLastHeardTime() const
     engine->RegisterObjectMethod(className, "uint GetLastHeardTime() const", AS_METHODPR(T, GetLastHeardTime, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_lastHeardTime() const", AS_METHODPR(T, GetLastHeardTime, () const, unsigned), AS_CALL_THISCALL);
@@ -12873,15 +13648,26 @@ template <class T> void RegisterMembers_Connection(asIScriptEngine* engine, cons
     // void Connection::SendServerUpdate()
     engine->RegisterObjectMethod(className, "void SendServerUpdate()", AS_METHODPR(T, SendServerUpdate, (), void), AS_CALL_THISCALL);
 
+    // void Connection::SetBandwidthLimit(unsigned bytesPerSec)
+    engine->RegisterObjectMethod(className, "void SetBandwidthLimit(uint)", AS_METHODPR(T, SetBandwidthLimit, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_bandwidthLimit(uint)", AS_METHODPR(T, SetBandwidthLimit, (unsigned), void), AS_CALL_THISCALL);
+
     // void Connection::SetConnectPending(bool connectPending)
     engine->RegisterObjectMethod(className, "void SetConnectPending(bool)", AS_METHODPR(T, SetConnectPending, (bool), void), AS_CALL_THISCALL);
 
     // void Connection::SetControls(const Controls& newControls)
     engine->RegisterObjectMethod(className, "void SetControls(const Controls&in)", AS_METHODPR(T, SetControls, (const Controls&), void), AS_CALL_THISCALL);
 
+    // void Connection::SetDeferSend(bool enable)
+    engine->RegisterObjectMethod(className, "void SetDeferSend(bool)", AS_METHODPR(T, SetDeferSend, (bool), void), AS_CALL_THISCALL);
+
     // void Connection::SetIdentity(const VariantMap& identity)
     engine->RegisterObjectMethod(className, "void SetIdentity(const VariantMap&in)", AS_METHODPR(T, SetIdentity, (const VariantMap&), void), AS_CALL_THISCALL);
 
+    // void Connection::SetInterestRadius(float radius)
+    engine->RegisterObjectMethod(className, "void SetInterestRadius(float)", AS_METHODPR(T, SetInterestRadius, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_interestRadius(float)", AS_METHODPR(T, SetInterestRadius, (float), void), AS_CALL_THISCALL);
+
     // void Connection::SetLogStatistics(bool enable)
     engine->RegisterObjectMethod(className, "void SetLogStatistics(bool)", AS_METHODPR(T, SetLogStatistics, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_logStatistics(bool)", AS_METHODPR(T, SetLogStatistics, (bool), void), AS_CALL_THISCALL);
@@ -12901,6 +13687,9 @@ template <class T> void RegisterMembers_Connection(asIScriptEngine* engine, cons
     engine->RegisterObjectMethod(className, "void SetScene(Scene@+)", AS_METHODPR(T, SetScene, (Scene*), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_scene(Scene@+)", AS_METHODPR(T, SetScene, (Scene*), void), AS_CALL_THISCALL);
 
+    // void Connection::UpdateBandwidth()
+    engine->RegisterObjectMethod(className, "void UpdateBandwidth()", AS_METHODPR(T, UpdateBandwidth, (), void), AS_CALL_THISCALL);
+
     // String Connection::ToString() const
     engine->RegisterObjectMethod(className, "String ToString() const", AS_METHODPR(T, ToString, () const, String), AS_CALL_THISCALL);
 
@@ -12987,10 +13776,18 @@ template <class T> void RegisterMembers_Network(asIScriptEngine* engine, const c
     engine->RegisterObjectMethod(className, "const String& GetGUID() const", AS_METHODPR(T, GetGUID, () const, const String&), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "const String& get_guid() const", AS_METHODPR(T, GetGUID, () const, const String&), AS_CALL_THISCALL);
 
+    // unsigned Network::GetMaxConcurrentHttpRequests() const
+    engine->RegisterObjectMethod(className, "uint GetMaxConcurrentHttpRequests() const", AS_METHODPR(T, GetMaxConcurrentHttpRequests, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_maxConcurrentHttpRequests() const", AS_METHODPR(T, GetMaxConcurrentHttpRequests, () const, unsigned), AS_CALL_THISCALL);
+
     // const String& Network::GetPackageCacheDir() const
     engine->RegisterObjectMethod(className, "const String& GetPackageCacheDir() const", AS_METHODPR(T, GetPackageCacheDir, () const, const String&), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "const String& get_packageCacheDir() const", AS_METHODPR(T, GetPackageCacheDir, () const, const String&), AS_CALL_THISCALL);
 
+    // bool Network::GetParallelServerUpdate() const
+    engine->RegisterObjectMethod(className, "bool GetParallelServerUpdate() const", AS_METHODPR(T, GetParallelServerUpdate, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_parallelServerUpdate() const", AS_METHODPR(T, GetParallelServerUpdate, () const, bool), AS_CALL_THISCALL);
+
     // Connection* Network::GetServerConnection() const
     engine->RegisterObjectMethod(className, "Connection@+ GetServerConnection() const", AS_METHODPR(T, GetServerConnection, () const, Connection*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "Connection@+ get_serverConnection() const", AS_METHODPR(T, GetServerConnection, () const, Connection*), AS_CALL_THISCALL);
@@ -13007,6 +13804,9 @@ template <class T> void RegisterMembers_Network(asIScriptEngine* engine, const c
     engine->RegisterObjectMethod(className, "int GetUpdateFps() const", AS_METHODPR(T, GetUpdateFps, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_updateFps() const", AS_METHODPR(T, GetUpdateFps, () const, int), AS_CALL_THISCALL);
 
+    // unsigned Network::GetUpdateTick() const
+    engine->RegisterObjectMethod(className, "uint GetUpdateTick() const", AS_METHODPR(T, GetUpdateTick, () const, unsigned), AS_CALL_THISCALL);
+
     // bool Network::IsServerRunning() const
     engine->RegisterObjectMethod(className, "bool IsServerRunning() const", AS_METHODPR(T, IsServerRunning, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_serverRunning() const", AS_METHODPR(T, IsServerRunning, () const, bool), AS_CALL_THISCALL);
@@ -13026,6 +13826,10 @@ template <class T> void RegisterMembers_Network(asIScriptEngine* engine, const c
     // void Network::SetDiscoveryBeacon(const VariantMap& data)
     engine->RegisterObjectMethod(className, "void SetDiscoveryBeacon(const VariantMap&in)", AS_METHODPR(T, SetDiscoveryBeacon, (const VariantMap&), void), AS_CALL_THISCALL);
 
+    // void Network::SetMaxConcurrentHttpRequests(unsigned num)
+    engine->RegisterObjectMethod(className, "void SetMaxConcurrentHttpRequests(uint)", AS_METHODPR(T, SetMaxConcurrentHttpRequests, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxConcurrentHttpRequests(uint)", AS_METHODPR(T, SetMaxConcurrentHttpRequests, (unsigned), void), AS_CALL_THISCALL);
+
     // void Network::SetNATServerInfo(const String& address, unsigned short port)
     engine->RegisterObjectMethod(className, "void SetNATServerInfo(const String&in, uint16)", AS_METHODPR(T, SetNATServerInfo, (const String&, unsigned short), void), AS_CALL_THISCALL);
 
@@ -13033,6 +13837,10 @@ template <class T> void RegisterMembers_Network(asIScriptEngine* engine, const c
     engine->RegisterObjectMethod(className, "void SetPackageCacheDir(const String&in)", AS_METHODPR(T, SetPackageCacheDir, (const String&), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_packageCacheDir(const String&in)", AS_METHODPR(T, SetPackageCacheDir, (const String&), void), AS_CALL_THISCALL);
 
+    // void Network::SetParallelServerUpdate(bool enable)
+    engine->RegisterObjectMethod(className, "void SetParallelServerUpdate(bool)", AS_METHODPR(T, SetParallelServerUpdate, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_parallelServerUpdate(bool)", AS_METHODPR(T, SetParallelServerUpdate, (bool), void), AS_CALL_THISCALL);
+
     // void Network::SetPassword(const String& password)
     engine->RegisterObjectMethod(className, "void SetPassword(const String&in)", AS_METHODPR(T, SetPassword, (const String&), void), AS_CALL_THISCALL);
 
@@ -13271,6 +14079,9 @@ template <class T> void RegisterMembers_Animatable(asIScriptEngine* engine, cons
     // void Animatable::SetAttributeAnimation(const String& name, ValueAnimation* attributeAnimation, WrapMode wrapMode = WM_LOOP, float speed = 1.0f)
     engine->RegisterObjectMethod(className, "void SetAttributeAnimation(const String&in, ValueAnimation@+, WrapMode = WM_LOOP, float = 1.0f)", AS_METHODPR(T, SetAttributeAnimation, (const String&, ValueAnimation*, WrapMode, float), void), AS_CALL_THISCALL);
 
+    // void Animatable::SetAttributeAnimationScene(Scene* scene)
+    engine->RegisterObjectMethod(className, "void SetAttributeAnimationScene(Scene@+)", AS_METHODPR(T, SetAttributeAnimationScene, (Scene*), void), AS_CALL_THISCALL);
+
     // void Animatable::SetAttributeAnimationSpeed(const String& name, float speed)
     engine->RegisterObjectMethod(className, "void SetAttributeAnimationSpeed(const String&in, float)", AS_METHODPR(T, SetAttributeAnimationSpeed, (const String&, float), void), AS_CALL_THISCALL);
 
@@ -13334,6 +14145,12 @@ template <class T> void RegisterMembers_Font(asIScriptEngine* engine, const char
     engine->RegisterObjectMethod(className, "const Vector2& GetScaledGlyphOffset() const", AS_METHODPR(T, GetScaledGlyphOffset, () const, const Vector2&), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "const Vector2& get_scaledGlyphOffset() const", AS_METHODPR(T, GetScaledGlyphOffset, () const, const Vector2&), AS_CALL_THISCALL);
 
+    // float Font::GetSDFPointSize() const
+    engine->RegisterObjectMethod(className, "float GetSDFPointSize() const", AS_METHODPR(T, GetSDFPointSize, () const, float), AS_CALL_THISCALL);
+
+    // int Font::GetSDFSpread() const
+    engine->RegisterObjectMethod(className, "int GetSDFSpread() const", AS_METHODPR(T, GetSDFSpread, () const, int), AS_CALL_THISCALL);
+
     // IntVector2 Font::GetTotalGlyphOffset(float pointSize) const
     engine->RegisterObjectMethod(className, "IntVector2 GetTotalGlyphOffset(float) const", AS_METHODPR(T, GetTotalGlyphOffset, (float) const, IntVector2), AS_CALL_THISCALL);
 
@@ -13369,6 +14186,13 @@ template <class T> Image* Image_SharedPtrlesImagegre_ConvertToRGBA_void_template
     return result.Detach();
 }
 
+// SharedPtr<Image> Image::Compress(CompressedFormat format, CompressionQuality quality = CQ_NORMAL, bool mipmaps = true) const
+template <class T> Image* Image_SharedPtrlesImagegre_Compress_CompressedFormat_CompressionQuality_bool_template(T* _ptr, CompressedFormat format, CompressionQuality quality, bool mipmaps)
+{
+    SharedPtr<Image> result = _ptr->Compress(format, quality, mipmaps);
+    return result.Detach();
+}
+
 // SharedPtr<Image> Image::GetDecompressedImage() const
 template <class T> Image* Image_SharedPtrlesImagegre_GetDecompressedImage_void_template(T* _ptr)
 {
@@ -13395,6 +14219,8 @@ template <class T> void RegisterMembers_Image(asIScriptEngine* engine, const cha
 {
     RegisterMembers_Resource<T>(engine, className);
 
+    // SharedArrayPtr<unsigned char> Image::GenerateMipChain(PODVector<unsigned>& levelOffsets) const
+    // Not registered because have @nobind mark
     // unsigned char* Image::GetData() const
     // Error: type "unsigned char*" can not automatically bind
     // void Image::GetLevels(PODVector<Image*>& levels)
@@ -13415,6 +14241,9 @@ template <class T> void RegisterMembers_Image(asIScriptEngine* engine, const cha
     // void Image::ClearInt(unsigned uintColor)
     engine->RegisterObjectMethod(className, "void ClearInt(uint)", AS_METHODPR(T, ClearInt, (unsigned), void), AS_CALL_THISCALL);
 
+    // SharedPtr<Image> Image::Compress(CompressedFormat format, CompressionQuality quality = CQ_NORMAL, bool mipmaps = true) const
+    engine->RegisterObjectMethod(className, "Image@+ Compress(CompressedFormat, CompressionQuality = CQ_NORMAL, bool = true) const", AS_FUNCTION_OBJFIRST(Image_SharedPtrlesImagegre_Compress_CompressedFormat_CompressionQuality_bool_template<Image>), AS_CALL_CDECL_OBJFIRST);
+
     // SharedPtr<Image> Image::ConvertToRGBA() const
     engine->RegisterObjectMethod(className, "Image@+ ConvertToRGBA() const", AS_FUNCTION_OBJFIRST(Image_SharedPtrlesImagegre_ConvertToRGBA_void_template<Image>), AS_CALL_CDECL_OBJFIRST);
 
@@ -13516,6 +14345,9 @@ template <class T> void RegisterMembers_Image(asIScriptEngine* engine, const cha
     // bool Image::SaveDDS(const String& fileName) const
     engine->RegisterObjectMethod(className, "bool SaveDDS(const String&in) const", AS_METHODPR(T, SaveDDS, (const String&) const, bool), AS_CALL_THISCALL);
 
+    // bool Image::SaveKTX(const String& fileName) const
+    engine->RegisterObjectMethod(className, "bool SaveKTX(const String&in) const", AS_METHODPR(T, SaveKTX, (const String&) const, bool), AS_CALL_THISCALL);
+
     // bool Image::SaveJPG(const String& fileName, int quality) const
     engine->RegisterObjectMethod(className, "bool SaveJPG(const String&in, int) const", AS_METHODPR(T, SaveJPG, (const String&, int) const, bool), AS_CALL_THISCALL);
 
@@ -13562,9 +14394,16 @@ template <class T> void RegisterMembers_JSONFile(asIScriptEngine* engine, const
 {
     RegisterMembers_Resource<T>(engine, className);
 
+    // JSONView JSONFile::GetArenaRoot() const
+    // Error: type "JSONView" can not automatically bind
+
     // bool JSONFile::FromString(const String& source)
     engine->RegisterObjectMethod(className, "bool FromString(const String&in)", AS_METHODPR(T, FromString, (const String&), bool), AS_CALL_THISCALL);
 
+    // bool JSONFile::GetArenaMode() const
+    engine->RegisterObjectMethod(className, "bool GetArenaMode() const", AS_METHODPR(T, GetArenaMode, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_arenaMode() const", AS_METHODPR(T, GetArenaMode, () const, bool), AS_CALL_THISCALL);
+
     // JSONValue& JSONFile::GetRoot()
     engine->RegisterObjectMethod(className, "JSONValue& GetRoot()", AS_METHODPR(T, GetRoot, (), JSONValue&), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "JSONValue& get_root()", AS_METHODPR(T, GetRoot, (), JSONValue&), AS_CALL_THISCALL);
@@ -13575,9 +14414,18 @@ template <class T> void RegisterMembers_JSONFile(asIScriptEngine* engine, const
     // bool JSONFile::Save(Serializer& dest, const String& indendation) const
     engine->RegisterObjectMethod(className, "bool Save(Serializer&, const String&in) const", AS_METHODPR(T, Save, (Serializer&, const String&) const, bool), AS_CALL_THISCALL);
 
+    // bool JSONFile::SaveBinary(Serializer& dest) const
+    engine->RegisterObjectMethod(className, "bool SaveBinary(Serializer&) const", AS_METHODPR(T, SaveBinary, (Serializer&) const, bool), AS_CALL_THISCALL);
+
+    // void JSONFile::SetArenaMode(bool enable)
+    engine->RegisterObjectMethod(className, "void SetArenaMode(bool)", AS_METHODPR(T, SetArenaMode, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_arenaMode(bool)", AS_METHODPR(T, SetArenaMode, (bool), void), AS_CALL_THISCALL);
+
     // String JSONFile::ToString(const String& indendation = "\t") const
     engine->RegisterObjectMethod(className, "String ToString(const String&in = \"\t\") const", AS_METHODPR(T, ToString, (const String&) const, String), AS_CALL_THISCALL);
 
+    // static bool JSONFile::ParseStream(Deserializer& source, JSONStreamHandler& handler)
+    // Error: type "JSONStreamHandler&" can not automatically bind
     // static void JSONFile::RegisterObject(Context* context)
     // Not registered because have @nobind mark
 
@@ -13670,6 +14518,9 @@ template <class T> void RegisterMembers_Material(asIScriptEngine* engine, const
     // unsigned Material::GetShaderParameterHash() const
     engine->RegisterObjectMethod(className, "uint GetShaderParameterHash() const", AS_METHODPR(T, GetShaderParameterHash, () const, unsigned), AS_CALL_THISCALL);
 
+    // unsigned Material::GetShaderParameterVersion() const
+    engine->RegisterObjectMethod(className, "uint GetShaderParameterVersion() const", AS_METHODPR(T, GetShaderParameterVersion, () const, unsigned), AS_CALL_THISCALL);
+
     // CullMode Material::GetShadowCullMode() const
     engine->RegisterObjectMethod(className, "CullMode GetShadowCullMode() const", AS_METHODPR(T, GetShadowCullMode, () const, CullMode), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "CullMode get_shadowCullMode() const", AS_METHODPR(T, GetShadowCullMode, () const, CullMode), AS_CALL_THISCALL);
@@ -14212,6 +15063,27 @@ template <class T> void RegisterMembers_ParticleEffect(asIScriptEngine* engine,
     #endif
 }
 
+// class PrefabTemplate | File: ../Scene/PrefabTemplate.h
+template <class T> void RegisterMembers_PrefabTemplate(asIScriptEngine* engine, const char* className)
+{
+    RegisterMembers_Resource<T>(engine, className);
+
+    // unsigned PrefabTemplate::GetNumComponents() const
+    engine->RegisterObjectMethod(className, "uint GetNumComponents() const", AS_METHODPR(T, GetNumComponents, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numComponents() const", AS_METHODPR(T, GetNumComponents, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned PrefabTemplate::GetNumNodes() const
+    engine->RegisterObjectMethod(className, "uint GetNumNodes() const", AS_METHODPR(T, GetNumNodes, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numNodes() const", AS_METHODPR(T, GetNumNodes, () const, unsigned), AS_CALL_THISCALL);
+
+    // Node* PrefabTemplate::Instantiate(Node* parent, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED) const
+    engine->RegisterObjectMethod(className, "Node@+ Instantiate(Node@+, const Vector3&in, const Quaternion&in, CreateMode = REPLICATED) const", AS_METHODPR(T, Instantiate, (Node*, const Vector3&, const Quaternion&, CreateMode) const, Node*), AS_CALL_THISCALL);
+
+    #ifdef REGISTER_MEMBERS_MANUAL_PART_PrefabTemplate
+        REGISTER_MEMBERS_MANUAL_PART_PrefabTemplate();
+    #endif
+}
+
 // class ResourceWithMetadata | File: ../Resource/Resource.h
 template <class T> void RegisterMembers_ResourceWithMetadata(asIScriptEngine* engine, const char* className)
 {
@@ -14498,6 +15370,9 @@ template <class T> void RegisterMembers_XMLFile(asIScriptEngine* engine, const c
     // bool XMLFile::Save(Serializer& dest, const String& indentation) const
     engine->RegisterObjectMethod(className, "bool Save(Serializer&, const String&in) const", AS_METHODPR(T, Save, (Serializer&, const String&) const, bool), AS_CALL_THISCALL);
 
+    // bool XMLFile::SaveBinary(Serializer& dest) const
+    engine->RegisterObjectMethod(className, "bool SaveBinary(Serializer&) const", AS_METHODPR(T, SaveBinary, (Serializer&) const, bool), AS_CALL_THISCALL);
+
     // String XMLFile::ToString(const String& indentation = "\t") const
     engine->RegisterObjectMethod(className, "String ToString(const String&in = \"\t\") const", AS_METHODPR(T, ToString, (const String&) const, String), AS_CALL_THISCALL);
 
@@ -14965,6 +15840,9 @@ template <class T> void RegisterMembers_Animation(asIScriptEngine* engine, const
     // SharedPtr<Animation> Animation::Clone(const String& cloneName = String::EMPTY) const
     engine->RegisterObjectMethod(className, "Animation@+ Clone(const String&in = String::EMPTY) const", AS_FUNCTION_OBJFIRST(Animation_SharedPtrlesAnimationgre_Clone_constspStringamp_template<Animation>), AS_CALL_CDECL_OBJFIRST);
 
+    // void Animation::Compress(float positionTolerance = 0.001f, float rotationTolerance = 0.001f, float scaleTolerance = 0.001f)
+    engine->RegisterObjectMethod(className, "void Compress(float = 0.001f, float = 0.001f, float = 0.001f)", AS_METHODPR(T, Compress, (float, float, float), void), AS_CALL_THISCALL);
+
     // AnimationTrack* Animation::CreateTrack(const String& name)
     engine->RegisterObjectMethod(className, "AnimationTrack@ CreateTrack(const String&in)", AS_METHODPR(T, CreateTrack, (const String&), AnimationTrack*), AS_CALL_THISCALL);
 
@@ -14997,6 +15875,9 @@ template <class T> void RegisterMembers_Animation(asIScriptEngine* engine, const
     // AnimationTrack* Animation::GetTrack(StringHash nameHash)
     engine->RegisterObjectMethod(className, "AnimationTrack@ GetTrack(StringHash)", AS_METHODPR(T, GetTrack, (StringHash), AnimationTrack*), AS_CALL_THISCALL);
 
+    // bool Animation::IsCompressed() const
+    engine->RegisterObjectMethod(className, "bool IsCompressed() const", AS_METHODPR(T, IsCompressed, () const, bool), AS_CALL_THISCALL);
+
     // void Animation::RemoveAllTracks()
     engine->RegisterObjectMethod(className, "void RemoveAllTracks()", AS_METHODPR(T, RemoveAllTracks, (), void), AS_CALL_THISCALL);
 
@@ -15201,6 +16082,16 @@ template <class T> void RegisterMembers_Model(asIScriptEngine* engine, const cha
     engine->RegisterObjectMethod(className, "uint GetNumMorphs() const", AS_METHODPR(T, GetNumMorphs, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numMorphs() const", AS_METHODPR(T, GetNumMorphs, () const, unsigned), AS_CALL_THISCALL);
 
+    // bool Model::IsShadowDataReleased() const
+    engine->RegisterObjectMethod(className, "bool IsShadowDataReleased() const", AS_METHODPR(T, IsShadowDataReleased, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_shadowDataReleased() const", AS_METHODPR(T, IsShadowDataReleased, () const, bool), AS_CALL_THISCALL);
+
+    // bool Model::ReleaseShadowData()
+    engine->RegisterObjectMethod(className, "bool ReleaseShadowData()", AS_METHODPR(T, ReleaseShadowData, (), bool), AS_CALL_THISCALL);
+
+    // bool Model::RequestShadowData()
+    engine->RegisterObjectMethod(className, "bool RequestShadowData()", AS_METHODPR(T, RequestShadowData, (), bool), AS_CALL_THISCALL);
+
     // Skeleton& Model::GetSkeleton()
     engine->RegisterObjectMethod(className, "Skeleton& GetSkeleton()", AS_METHODPR(T, GetSkeleton, (), Skeleton&), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "Skeleton& get_skeleton()", AS_METHODPR(T, GetSkeleton, (), Skeleton&), AS_CALL_THISCALL);
@@ -15330,8 +16221,6 @@ template <class T> void RegisterMembers_Node(asIScriptEngine* engine, const char
     // Error: type "const Vector<WeakPtr<Component>>" can not automatically bind
     // const PODVector<unsigned char>& Node::GetNetParentAttr() const
     // Error: type "const PODVector<unsigned char>&" can not automatically bind
-    // const PODVector<unsigned char>& Node::GetNetRotationAttr() const
-    // Error: type "const PODVector<unsigned char>&" can not automatically bind
     // Connection* Node::GetOwner() const
     // Not registered because have @manualbind mark
     // bool Node::Load(Deserializer& source, SceneResolver& resolver, bool loadChildren = true, bool rewriteIDs = false, CreateMode mode = REPLICATED)
@@ -15344,8 +16233,6 @@ template <class T> void RegisterMembers_Node(asIScriptEngine* engine, const char
     // Can not be registered here bacause hidden in derived classes: Scene
     // void Node::SetNetParentAttr(const PODVector<unsigned char>& value)
     // Error: type "const PODVector<unsigned char>&" can not automatically bind
-    // void Node::SetNetRotationAttr(const PODVector<unsigned char>& value)
-    // Error: type "const PODVector<unsigned char>&" can not automatically bind
     // void Node::SetOwner(Connection* owner)
     // Not registered because have @manualbind mark
 
@@ -15436,6 +16323,9 @@ template <class T> void RegisterMembers_Node(asIScriptEngine* engine, const char
     // const Vector3& Node::GetNetPositionAttr() const
     engine->RegisterObjectMethod(className, "const Vector3& GetNetPositionAttr() const", AS_METHODPR(T, GetNetPositionAttr, () const, const Vector3&), AS_CALL_THISCALL);
 
+    // const Quaternion& Node::GetNetRotationAttr() const
+    engine->RegisterObjectMethod(className, "const Quaternion& GetNetRotationAttr() const", AS_METHODPR(T, GetNetRotationAttr, () const, const Quaternion&), AS_CALL_THISCALL);
+
     // unsigned Node::GetNumChildren(bool recursive = false) const
     engine->RegisterObjectMethod(className, "uint GetNumChildren(bool = false) const", AS_METHODPR(T, GetNumChildren, (bool) const, unsigned), AS_CALL_THISCALL);
 
@@ -15701,6 +16591,9 @@ template <class T> void RegisterMembers_Node(asIScriptEngine* engine, const char
     // void Node::SetNetPositionAttr(const Vector3& value)
     engine->RegisterObjectMethod(className, "void SetNetPositionAttr(const Vector3&in)", AS_METHODPR(T, SetNetPositionAttr, (const Vector3&), void), AS_CALL_THISCALL);
 
+    // void Node::SetNetRotationAttr(const Quaternion& value)
+    engine->RegisterObjectMethod(className, "void SetNetRotationAttr(const Quaternion&in)", AS_METHODPR(T, SetNetRotationAttr, (const Quaternion&), void), AS_CALL_THISCALL);
+
     // void Node::SetParent(Node* parent)
     engine->RegisterObjectMethod(className, "void SetParent(Node@+)", AS_METHODPR(T, SetParent, (Node*), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_parent(Node@+)", AS_METHODPR(T, SetParent, (Node*), void), AS_CALL_THISCALL);
@@ -15912,6 +16805,15 @@ template <class T> void RegisterMembers_Sound(asIScriptEngine* engine, const cha
     // void Sound::FixInterpolation()
     engine->RegisterObjectMethod(className, "void FixInterpolation()", AS_METHODPR(T, FixInterpolation, (), void), AS_CALL_THISCALL);
 
+    // unsigned Sound::GetAdpcmBlockSize() const
+    engine->RegisterObjectMethod(className, "uint GetAdpcmBlockSize() const", AS_METHODPR(T, GetAdpcmBlockSize, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned Sound::GetAdpcmFrames() const
+    engine->RegisterObjectMethod(className, "uint GetAdpcmFrames() const", AS_METHODPR(T, GetAdpcmFrames, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned Sound::GetAdpcmFramesPerBlock() const
+    engine->RegisterObjectMethod(className, "uint GetAdpcmFramesPerBlock() const", AS_METHODPR(T, GetAdpcmFramesPerBlock, () const, unsigned), AS_CALL_THISCALL);
+
     // unsigned Sound::GetDataSize() const
     engine->RegisterObjectMethod(className, "uint GetDataSize() const", AS_METHODPR(T, GetDataSize, () const, unsigned), AS_CALL_THISCALL);
 
@@ -15933,6 +16835,9 @@ template <class T> void RegisterMembers_Sound(asIScriptEngine* engine, const cha
     engine->RegisterObjectMethod(className, "uint GetSampleSize() const", AS_METHODPR(T, GetSampleSize, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_sampleSize() const", AS_METHODPR(T, GetSampleSize, () const, unsigned), AS_CALL_THISCALL);
 
+    // bool Sound::IsAdpcm() const
+    engine->RegisterObjectMethod(className, "bool IsAdpcm() const", AS_METHODPR(T, IsAdpcm, () const, bool), AS_CALL_THISCALL);
+
     // bool Sound::IsCompressed() const
     engine->RegisterObjectMethod(className, "bool IsCompressed() const", AS_METHODPR(T, IsCompressed, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_compressed() const", AS_METHODPR(T, IsCompressed, () const, bool), AS_CALL_THISCALL);
@@ -15958,6 +16863,9 @@ template <class T> void RegisterMembers_Sound(asIScriptEngine* engine, const cha
     // bool Sound::LoadWav(Deserializer& source)
     engine->RegisterObjectMethod(className, "bool LoadWav(Deserializer&)", AS_METHODPR(T, LoadWav, (Deserializer&), bool), AS_CALL_THISCALL);
 
+    // bool Sound::SaveAdpcmWav(Serializer& dest) const
+    engine->RegisterObjectMethod(className, "bool SaveAdpcmWav(Serializer&) const", AS_METHODPR(T, SaveAdpcmWav, (Serializer&) const, bool), AS_CALL_THISCALL);
+
     // void Sound::SetFormat(unsigned frequency, bool sixteenBit, bool stereo)
     engine->RegisterObjectMethod(className, "void SetFormat(uint, bool, bool)", AS_METHODPR(T, SetFormat, (unsigned, bool, bool), void), AS_CALL_THISCALL);
 
@@ -15985,6 +16893,8 @@ template <class T> void RegisterMembers_Texture(asIScriptEngine* engine, const c
     RegisterMembers_ResourceWithMetadata<T>(engine, className);
     RegisterMembers_GPUObject<T>(engine, className);
 
+    // void Texture::AddPendingUploads(int delta)
+    // Not registered because have @nobind mark
     // void* Texture::GetResolveTexture() const
     // Error: type "void*" can not automatically bind
     // void* Texture::GetSampler() const
@@ -15993,6 +16903,8 @@ template <class T> void RegisterMembers_Texture(asIScriptEngine* engine, const c
     // Error: type "void*" can not automatically bind
     // unsigned Texture::GetSRGBFormat(unsigned format)
     // Not registered because have @nobind mark
+    // bool Texture::IsUploadPending() const
+    // Not registered because have @nobind mark
 
     // TextureAddressMode Texture::GetAddressMode(TextureCoordinate coord) const
     engine->RegisterObjectMethod(className, "TextureAddressMode GetAddressMode(TextureCoordinate) const", AS_METHODPR(T, GetAddressMode, (TextureCoordinate) const, TextureAddressMode), AS_CALL_THISCALL);
@@ -16222,6 +17134,8 @@ template <class T> void RegisterMembers_UIElement(asIScriptEngine* engine, const
 
     // virtual void UIElement::GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, const IntRect& currentScissor)
     // Error: type "PODVector<UIBatch>&" can not automatically bind
+    // UIBatchCache* UIElement::GetBatchCache() const
+    // Error: type "UIBatchCache*" can not automatically bind
     // void UIElement::GetBatchesWithOffset(IntVector2& offset, PODVector<UIBatch>& batches, PODVector<float>& vertexData, IntRect currentScissor)
     // Error: type "PODVector<UIBatch>&" can not automatically bind
     // void UIElement::GetChildren(PODVector<UIElement*>& dest, bool recursive = false) const
@@ -16279,6 +17193,9 @@ template <class T> void RegisterMembers_UIElement(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "const String& GetAppliedStyle() const", AS_METHODPR(T, GetAppliedStyle, () const, const String&), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "const String& get_style() const", AS_METHODPR(T, GetAppliedStyle, () const, const String&), AS_CALL_THISCALL);
 
+    // unsigned UIElement::GetBatchVersion() const
+    engine->RegisterObjectMethod(className, "uint GetBatchVersion() const", AS_METHODPR(T, GetBatchVersion, () const, unsigned), AS_CALL_THISCALL);
+
     // bool UIElement::GetBringToBack() const
     engine->RegisterObjectMethod(className, "bool GetBringToBack() const", AS_METHODPR(T, GetBringToBack, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_bringToBack() const", AS_METHODPR(T, GetBringToBack, () const, bool), AS_CALL_THISCALL);
@@ -16287,6 +17204,14 @@ template <class T> void RegisterMembers_UIElement(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "bool GetBringToFront() const", AS_METHODPR(T, GetBringToFront, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_bringToFront() const", AS_METHODPR(T, GetBringToFront, () const, bool), AS_CALL_THISCALL);
 
+    // bool UIElement::GetCacheAsTexture() const
+    engine->RegisterObjectMethod(className, "bool GetCacheAsTexture() const", AS_METHODPR(T, GetCacheAsTexture, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_cacheAsTexture() const", AS_METHODPR(T, GetCacheAsTexture, () const, bool), AS_CALL_THISCALL);
+
+    // bool UIElement::GetCacheBatches() const
+    engine->RegisterObjectMethod(className, "bool GetCacheBatches() const", AS_METHODPR(T, GetCacheBatches, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_cacheBatches() const", AS_METHODPR(T, GetCacheBatches, () const, bool), AS_CALL_THISCALL);
+
     // UIElement* UIElement::GetChild(unsigned index) const
     engine->RegisterObjectMethod(className, "UIElement@+ GetChild(uint) const", AS_METHODPR(T, GetChild, (unsigned) const, UIElement*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "UIElement@+ get_children(uint) const", AS_METHODPR(T, GetChild, (unsigned) const, UIElement*), AS_CALL_THISCALL);
@@ -16591,6 +17516,9 @@ template <class T> void RegisterMembers_UIElement(asIScriptEngine* engine, const
     // bool UIElement::LoadXML(Deserializer& source)
     engine->RegisterObjectMethod(className, "bool LoadXML(Deserializer&)", AS_METHODPR(T, LoadXML, (Deserializer&), bool), AS_CALL_THISCALL);
 
+    // void UIElement::MarkBatchesDirty()
+    engine->RegisterObjectMethod(className, "void MarkBatchesDirty()", AS_METHODPR(T, MarkBatchesDirty, (), void), AS_CALL_THISCALL);
+
     // virtual void UIElement::OnClickBegin(const IntVector2& position, const IntVector2& screenPosition, MouseButton button, MouseButtonFlags buttons, QualifierFlags qualifiers, Cursor* cursor)
     engine->RegisterObjectMethod(className, "void OnClickBegin(const IntVector2&in, const IntVector2&in, MouseButton, MouseButtonFlags, QualifierFlags, Cursor@+)", AS_METHODPR(T, OnClickBegin, (const IntVector2&, const IntVector2&, MouseButton, MouseButtonFlags, QualifierFlags, Cursor*), void), AS_CALL_THISCALL);
 
@@ -16680,6 +17608,14 @@ template <class T> void RegisterMembers_UIElement(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "void SetBringToFront(bool)", AS_METHODPR(T, SetBringToFront, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_bringToFront(bool)", AS_METHODPR(T, SetBringToFront, (bool), void), AS_CALL_THISCALL);
 
+    // void UIElement::SetCacheAsTexture(bool enable)
+    engine->RegisterObjectMethod(className, "void SetCacheAsTexture(bool)", AS_METHODPR(T, SetCacheAsTexture, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_cacheAsTexture(bool)", AS_METHODPR(T, SetCacheAsTexture, (bool), void), AS_CALL_THISCALL);
+
+    // void UIElement::SetCacheBatches(bool enable)
+    engine->RegisterObjectMethod(className, "void SetCacheBatches(bool)", AS_METHODPR(T, SetCacheBatches, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_cacheBatches(bool)", AS_METHODPR(T, SetCacheBatches, (bool), void), AS_CALL_THISCALL);
+
     // void UIElement::SetChildOffset(const IntVector2& offset)
     engine->RegisterObjectMethod(className, "void SetChildOffset(const IntVector2&in)", AS_METHODPR(T, SetChildOffset, (const IntVector2&), void), AS_CALL_THISCALL);
 
@@ -17003,6 +17939,14 @@ template <class T> void RegisterMembers_AnimationController(asIScriptEngine* eng
     // bool AnimationController::GetRemoveOnCompletion(const String& name) const
     engine->RegisterObjectMethod(className, "bool GetRemoveOnCompletion(const String&in) const", AS_METHODPR(T, GetRemoveOnCompletion, (const String&) const, bool), AS_CALL_THISCALL);
 
+    // bool AnimationController::GetSharedPose() const
+    engine->RegisterObjectMethod(className, "bool GetSharedPose() const", AS_METHODPR(T, GetSharedPose, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_sharedPose() const", AS_METHODPR(T, GetSharedPose, () const, bool), AS_CALL_THISCALL);
+
+    // float AnimationController::GetSharedPoseTimeStep() const
+    engine->RegisterObjectMethod(className, "float GetSharedPoseTimeStep() const", AS_METHODPR(T, GetSharedPoseTimeStep, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_sharedPoseTimeStep() const", AS_METHODPR(T, GetSharedPoseTimeStep, () const, float), AS_CALL_THISCALL);
+
     // float AnimationController::GetSpeed(const String& name) const
     engine->RegisterObjectMethod(className, "float GetSpeed(const String&in) const", AS_METHODPR(T, GetSpeed, (const String&) const, float), AS_CALL_THISCALL);
 
@@ -17060,6 +18004,14 @@ template <class T> void RegisterMembers_AnimationController(asIScriptEngine* eng
     // bool AnimationController::SetRemoveOnCompletion(const String& name, bool removeOnCompletion)
     engine->RegisterObjectMethod(className, "bool SetRemoveOnCompletion(const String&in, bool)", AS_METHODPR(T, SetRemoveOnCompletion, (const String&, bool), bool), AS_CALL_THISCALL);
 
+    // void AnimationController::SetSharedPose(bool enable)
+    engine->RegisterObjectMethod(className, "void SetSharedPose(bool)", AS_METHODPR(T, SetSharedPose, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_sharedPose(bool)", AS_METHODPR(T, SetSharedPose, (bool), void), AS_CALL_THISCALL);
+
+    // void AnimationController::SetSharedPoseTimeStep(float timeStep)
+    engine->RegisterObjectMethod(className, "void SetSharedPoseTimeStep(float)", AS_METHODPR(T, SetSharedPoseTimeStep, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_sharedPoseTimeStep(float)", AS_METHODPR(T, SetSharedPoseTimeStep, (float), void), AS_CALL_THISCALL);
+
     // bool AnimationController::SetSpeed(const String& name, float speed)
     engine->RegisterObjectMethod(className, "bool SetSpeed(const String&in, float)", AS_METHODPR(T, SetSpeed, (const String&, float), bool), AS_CALL_THISCALL);
 
@@ -17518,9 +18470,15 @@ template <class T> void RegisterMembers_DebugRenderer(asIScriptEngine* engine, c
     // void DebugRenderer::AddTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3, unsigned color, bool depthTest = true)
     engine->RegisterObjectMethod(className, "void AddTriangle(const Vector3&in, const Vector3&in, const Vector3&in, uint, bool = true)", AS_METHODPR(T, AddTriangle, (const Vector3&, const Vector3&, const Vector3&, unsigned, bool), void), AS_CALL_THISCALL);
 
+    // void DebugRenderer::BeginStaticGeometry(const StringHash& key)
+    engine->RegisterObjectMethod(className, "void BeginStaticGeometry(const StringHash&in)", AS_METHODPR(T, BeginStaticGeometry, (const StringHash&), void), AS_CALL_THISCALL);
+
     // virtual void Component::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
     engine->RegisterObjectMethod(className, "void DrawDebugGeometry(DebugRenderer@+, bool)", AS_METHODPR(T, DrawDebugGeometry, (DebugRenderer*, bool), void), AS_CALL_THISCALL);
 
+    // void DebugRenderer::EndStaticGeometry()
+    engine->RegisterObjectMethod(className, "void EndStaticGeometry()", AS_METHODPR(T, EndStaticGeometry, (), void), AS_CALL_THISCALL);
+
     // const Frustum& DebugRenderer::GetFrustum() const
     engine->RegisterObjectMethod(className, "const Frustum& GetFrustum() const", AS_METHODPR(T, GetFrustum, () const, const Frustum&), AS_CALL_THISCALL);
 
@@ -17537,12 +18495,21 @@ template <class T> void RegisterMembers_DebugRenderer(asIScriptEngine* engine, c
     // bool DebugRenderer::HasContent() const
     engine->RegisterObjectMethod(className, "bool HasContent() const", AS_METHODPR(T, HasContent, () const, bool), AS_CALL_THISCALL);
 
+    // bool DebugRenderer::HasStaticGeometry(const StringHash& key) const
+    engine->RegisterObjectMethod(className, "bool HasStaticGeometry(const StringHash&in) const", AS_METHODPR(T, HasStaticGeometry, (const StringHash&) const, bool), AS_CALL_THISCALL);
+
     // bool DebugRenderer::IsInside(const BoundingBox& box) const
     engine->RegisterObjectMethod(className, "bool IsInside(const BoundingBox&in) const", AS_METHODPR(T, IsInside, (const BoundingBox&) const, bool), AS_CALL_THISCALL);
 
     // virtual void Component::OnSetEnabled()
     engine->RegisterObjectMethod(className, "void OnSetEnabled()", AS_METHODPR(T, OnSetEnabled, (), void), AS_CALL_THISCALL);
 
+    // void DebugRenderer::RemoveAllStaticGeometry()
+    engine->RegisterObjectMethod(className, "void RemoveAllStaticGeometry()", AS_METHODPR(T, RemoveAllStaticGeometry, (), void), AS_CALL_THISCALL);
+
+    // void DebugRenderer::RemoveStaticGeometry(const StringHash& key)
+    engine->RegisterObjectMethod(className, "void RemoveStaticGeometry(const StringHash&in)", AS_METHODPR(T, RemoveStaticGeometry, (const StringHash&), void), AS_CALL_THISCALL);
+
     // void DebugRenderer::Render()
     engine->RegisterObjectMethod(className, "void Render()", AS_METHODPR(T, Render, (), void), AS_CALL_THISCALL);
 
@@ -17865,18 +18832,35 @@ template <class T> void RegisterMembers_Scene(asIScriptEngine* engine, const cha
 {
     RegisterMembers_Node<T>(engine, className);
 
+    // bool Scene::GetInterestNodes(PODVector<Node*>& dest, const Vector3& center, float radius) const
+    // Error: type "PODVector<Node*>&" can not automatically bind
     // bool Scene::GetNodesWithTag(PODVector<Node*>& dest, const String& tag) const
     // Error: type "PODVector<Node*>&" can not automatically bind
+    // void Scene::AddParallelUpdate(LogicComponent* component)
+    // Error: type "LogicComponent*" can not automatically bind
+    // void Scene::RemoveParallelUpdate(LogicComponent* component)
+    // Error: type "LogicComponent*" can not automatically bind
+    // void Scene::TakeSaveChanges(PODVector<unsigned>& nodes, PODVector<unsigned>& components, PODVector<unsigned>& removedNodes, PODVector<unsigned>& removedComponents)
+    // Not registered because have @nobind mark
+
+    // void Scene::AddAnimatedObject(Animatable* object)
+    engine->RegisterObjectMethod(className, "void AddAnimatedObject(Animatable@+)", AS_METHODPR(T, AddAnimatedObject, (Animatable*), void), AS_CALL_THISCALL);
 
     // void Scene::AddRequiredPackageFile(PackageFile* package)
     engine->RegisterObjectMethod(className, "void AddRequiredPackageFile(PackageFile@+)", AS_METHODPR(T, AddRequiredPackageFile, (PackageFile*), void), AS_CALL_THISCALL);
 
+    // void Scene::AddSmoothedTransform(SmoothedTransform* transform)
+    engine->RegisterObjectMethod(className, "void AddSmoothedTransform(SmoothedTransform@+)", AS_METHODPR(T, AddSmoothedTransform, (SmoothedTransform*), void), AS_CALL_THISCALL);
+
     // void Scene::BeginThreadedUpdate()
     engine->RegisterObjectMethod(className, "void BeginThreadedUpdate()", AS_METHODPR(T, BeginThreadedUpdate, (), void), AS_CALL_THISCALL);
 
     // void Scene::Clear(bool clearReplicated = true, bool clearLocal = true)
     engine->RegisterObjectMethod(className, "void Clear(bool = true, bool = true)", AS_METHODPR(T, Clear, (bool, bool), void), AS_CALL_THISCALL);
 
+    // void Scene::ClearInstantiateQueue()
+    engine->RegisterObjectMethod(className, "void ClearInstantiateQueue()", AS_METHODPR(T, ClearInstantiateQueue, (), void), AS_CALL_THISCALL);
+
     // void Scene::ClearRequiredPackageFiles()
     engine->RegisterObjectMethod(className, "void ClearRequiredPackageFiles()", AS_METHODPR(T, ClearRequiredPackageFiles, (), void), AS_CALL_THISCALL);
 
@@ -17904,6 +18888,10 @@ template <class T> void RegisterMembers_Scene(asIScriptEngine* engine, const cha
     engine->RegisterObjectMethod(className, "float GetAsyncProgress() const", AS_METHODPR(T, GetAsyncProgress, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_asyncProgress() const", AS_METHODPR(T, GetAsyncProgress, () const, float), AS_CALL_THISCALL);
 
+    // bool Scene::GetChangeTracking() const
+    engine->RegisterObjectMethod(className, "bool GetChangeTracking() const", AS_METHODPR(T, GetChangeTracking, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_changeTracking() const", AS_METHODPR(T, GetChangeTracking, () const, bool), AS_CALL_THISCALL);
+
     // unsigned Scene::GetChecksum() const
     engine->RegisterObjectMethod(className, "uint GetChecksum() const", AS_METHODPR(T, GetChecksum, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_checksum() const", AS_METHODPR(T, GetChecksum, () const, unsigned), AS_CALL_THISCALL);
@@ -17925,9 +18913,33 @@ template <class T> void RegisterMembers_Scene(asIScriptEngine* engine, const cha
     // unsigned Scene::GetFreeNodeID(CreateMode mode)
     engine->RegisterObjectMethod(className, "uint GetFreeNodeID(CreateMode)", AS_METHODPR(T, GetFreeNodeID, (CreateMode), unsigned), AS_CALL_THISCALL);
 
+    // int Scene::GetInstantiateQueueMs() const
+    engine->RegisterObjectMethod(className, "int GetInstantiateQueueMs() const", AS_METHODPR(T, GetInstantiateQueueMs, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_instantiateQueueMs() const", AS_METHODPR(T, GetInstantiateQueueMs, () const, int), AS_CALL_THISCALL);
+
+    // float Scene::GetInterestCellSize() const
+    engine->RegisterObjectMethod(className, "float GetInterestCellSize() const", AS_METHODPR(T, GetInterestCellSize, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_interestCellSize() const", AS_METHODPR(T, GetInterestCellSize, () const, float), AS_CALL_THISCALL);
+
+    // float Scene::GetInterpolationDelay() const
+    engine->RegisterObjectMethod(className, "float GetInterpolationDelay() const", AS_METHODPR(T, GetInterpolationDelay, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_interpolationDelay() const", AS_METHODPR(T, GetInterpolationDelay, () const, float), AS_CALL_THISCALL);
+
+    // float Scene::GetInterpolationTime() const
+    engine->RegisterObjectMethod(className, "float GetInterpolationTime() const", AS_METHODPR(T, GetInterpolationTime, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_interpolationTime() const", AS_METHODPR(T, GetInterpolationTime, () const, float), AS_CALL_THISCALL);
+
+    // float Scene::GetMaxExtrapolation() const
+    engine->RegisterObjectMethod(className, "float GetMaxExtrapolation() const", AS_METHODPR(T, GetMaxExtrapolation, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_maxExtrapolation() const", AS_METHODPR(T, GetMaxExtrapolation, () const, float), AS_CALL_THISCALL);
+
     // Node* Scene::GetNode(unsigned id) const
     engine->RegisterObjectMethod(className, "Node@+ GetNode(uint) const", AS_METHODPR(T, GetNode, (unsigned) const, Node*), AS_CALL_THISCALL);
 
+    // unsigned Scene::GetNumQueuedInstantiations() const
+    engine->RegisterObjectMethod(className, "uint GetNumQueuedInstantiations() const", AS_METHODPR(T, GetNumQueuedInstantiations, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numQueuedInstantiations() const", AS_METHODPR(T, GetNumQueuedInstantiations, () const, unsigned), AS_CALL_THISCALL);
+
     // const Vector<SharedPtr<PackageFile>>& Scene::GetRequiredPackageFiles() const
     engine->RegisterObjectMethod(className, "Array<PackageFile@>@ GetRequiredPackageFiles() const", AS_FUNCTION_OBJFIRST(Scene_constspVectorlesSharedPtrlesPackageFilegregreamp_GetRequiredPackageFiles_void_template<Scene>), AS_CALL_CDECL_OBJFIRST);
     engine->RegisterObjectMethod(className, "Array<PackageFile@>@ get_requiredPackageFiles() const", AS_FUNCTION_OBJFIRST(Scene_constspVectorlesSharedPtrlesPackageFilegregreamp_GetRequiredPackageFiles_void_template<Scene>), AS_CALL_CDECL_OBJFIRST);
@@ -17936,10 +18948,20 @@ template <class T> void RegisterMembers_Scene(asIScriptEngine* engine, const cha
     engine->RegisterObjectMethod(className, "float GetSmoothingConstant() const", AS_METHODPR(T, GetSmoothingConstant, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_smoothingConstant() const", AS_METHODPR(T, GetSmoothingConstant, () const, float), AS_CALL_THISCALL);
 
+    // float Scene::GetSnapshotInterval() const
+    engine->RegisterObjectMethod(className, "float GetSnapshotInterval() const", AS_METHODPR(T, GetSnapshotInterval, () const, float), AS_CALL_THISCALL);
+
+    // float Scene::GetSnapshotTime() const
+    engine->RegisterObjectMethod(className, "float GetSnapshotTime() const", AS_METHODPR(T, GetSnapshotTime, () const, float), AS_CALL_THISCALL);
+
     // float Scene::GetSnapThreshold() const
     engine->RegisterObjectMethod(className, "float GetSnapThreshold() const", AS_METHODPR(T, GetSnapThreshold, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_snapThreshold() const", AS_METHODPR(T, GetSnapThreshold, () const, float), AS_CALL_THISCALL);
 
+    // bool Scene::GetThreadedTransformUpdate() const
+    engine->RegisterObjectMethod(className, "bool GetThreadedTransformUpdate() const", AS_METHODPR(T, GetThreadedTransformUpdate, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_threadedTransformUpdate() const", AS_METHODPR(T, GetThreadedTransformUpdate, () const, bool), AS_CALL_THISCALL);
+
     // float Scene::GetTimeScale() const
     engine->RegisterObjectMethod(className, "float GetTimeScale() const", AS_METHODPR(T, GetTimeScale, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_timeScale() const", AS_METHODPR(T, GetTimeScale, () const, float), AS_CALL_THISCALL);
@@ -17953,6 +18975,9 @@ template <class T> void RegisterMembers_Scene(asIScriptEngine* engine, const cha
     // Node* Scene::Instantiate(Deserializer& source, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED)
     engine->RegisterObjectMethod(className, "Node@+ Instantiate(Deserializer&, const Vector3&in, const Quaternion&in, CreateMode = REPLICATED)", AS_METHODPR(T, Instantiate, (Deserializer&, const Vector3&, const Quaternion&, CreateMode), Node*), AS_CALL_THISCALL);
 
+    // Node* Scene::Instantiate(PrefabTemplate* prefab, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED)
+    engine->RegisterObjectMethod(className, "Node@+ Instantiate(PrefabTemplate@+, const Vector3&in, const Quaternion&in, CreateMode = REPLICATED)", AS_METHODPR(T, Instantiate, (PrefabTemplate*, const Vector3&, const Quaternion&, CreateMode), Node*), AS_CALL_THISCALL);
+
     // Node* Scene::InstantiateJSON(const JSONValue& source, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED)
     engine->RegisterObjectMethod(className, "Node@+ InstantiateJSON(const JSONValue&in, const Vector3&in, const Quaternion&in, CreateMode = REPLICATED)", AS_METHODPR(T, InstantiateJSON, (const JSONValue&, const Vector3&, const Quaternion&, CreateMode), Node*), AS_CALL_THISCALL);
 
@@ -18000,6 +19025,15 @@ template <class T> void RegisterMembers_Scene(asIScriptEngine* engine, const cha
     // void Scene::MarkReplicationDirty(Node* node)
     engine->RegisterObjectMethod(className, "void MarkReplicationDirty(Node@+)", AS_METHODPR(T, MarkReplicationDirty, (Node*), void), AS_CALL_THISCALL);
 
+    // void Scene::MarkSaveUpdate(Node* node)
+    engine->RegisterObjectMethod(className, "void MarkSaveUpdate(Node@+)", AS_METHODPR(T, MarkSaveUpdate, (Node*), void), AS_CALL_THISCALL);
+
+    // void Scene::MarkSaveUpdate(Component* component)
+    engine->RegisterObjectMethod(className, "void MarkSaveUpdate(Component@+)", AS_METHODPR(T, MarkSaveUpdate, (Component*), void), AS_CALL_THISCALL);
+
+    // void Scene::MarkTransformHierarchyDirty()
+    engine->RegisterObjectMethod(className, "void MarkTransformHierarchyDirty()", AS_METHODPR(T, MarkTransformHierarchyDirty, (), void), AS_CALL_THISCALL);
+
     // void Scene::NodeAdded(Node* node)
     engine->RegisterObjectMethod(className, "void NodeAdded(Node@+)", AS_METHODPR(T, NodeAdded, (Node*), void), AS_CALL_THISCALL);
 
@@ -18012,25 +19046,67 @@ template <class T> void RegisterMembers_Scene(asIScriptEngine* engine, const cha
     // void Scene::NodeTagRemoved(Node* node, const String& tag)
     engine->RegisterObjectMethod(className, "void NodeTagRemoved(Node@+, const String&in)", AS_METHODPR(T, NodeTagRemoved, (Node*, const String&), void), AS_CALL_THISCALL);
 
+    // void Scene::QueueInstantiate(PrefabTemplate* prefab, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED, Node* parent = nullptr)
+    engine->RegisterObjectMethod(className, "void QueueInstantiate(PrefabTemplate@+, const Vector3&in, const Quaternion&in, CreateMode = REPLICATED, Node@+ = null)", AS_METHODPR(T, QueueInstantiate, (PrefabTemplate*, const Vector3&, const Quaternion&, CreateMode, Node*), void), AS_CALL_THISCALL);
+
     // void Scene::RegisterVar(const String& name)
     engine->RegisterObjectMethod(className, "void RegisterVar(const String&in)", AS_METHODPR(T, RegisterVar, (const String&), void), AS_CALL_THISCALL);
 
+    // void Scene::RemoveAnimatedObject(Animatable* object)
+    engine->RegisterObjectMethod(className, "void RemoveAnimatedObject(Animatable@+)", AS_METHODPR(T, RemoveAnimatedObject, (Animatable*), void), AS_CALL_THISCALL);
+
+    // void Scene::RemoveSmoothedTransform(SmoothedTransform* transform)
+    engine->RegisterObjectMethod(className, "void RemoveSmoothedTransform(SmoothedTransform@+)", AS_METHODPR(T, RemoveSmoothedTransform, (SmoothedTransform*), void), AS_CALL_THISCALL);
+
+    // void Scene::ReserveComponents(unsigned count, CreateMode mode = REPLICATED)
+    engine->RegisterObjectMethod(className, "void ReserveComponents(uint, CreateMode = REPLICATED)", AS_METHODPR(T, ReserveComponents, (unsigned, CreateMode), void), AS_CALL_THISCALL);
+
+    // void Scene::ReserveNodes(unsigned count, CreateMode mode = REPLICATED)
+    engine->RegisterObjectMethod(className, "void ReserveNodes(uint, CreateMode = REPLICATED)", AS_METHODPR(T, ReserveNodes, (unsigned, CreateMode), void), AS_CALL_THISCALL);
+
     // void Scene::SetAsyncLoadingMs(int ms)
     engine->RegisterObjectMethod(className, "void SetAsyncLoadingMs(int)", AS_METHODPR(T, SetAsyncLoadingMs, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_asyncLoadingMs(int)", AS_METHODPR(T, SetAsyncLoadingMs, (int), void), AS_CALL_THISCALL);
 
+    // void Scene::SetChangeTracking(bool enable)
+    engine->RegisterObjectMethod(className, "void SetChangeTracking(bool)", AS_METHODPR(T, SetChangeTracking, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_changeTracking(bool)", AS_METHODPR(T, SetChangeTracking, (bool), void), AS_CALL_THISCALL);
+
     // void Scene::SetElapsedTime(float time)
     engine->RegisterObjectMethod(className, "void SetElapsedTime(float)", AS_METHODPR(T, SetElapsedTime, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_elapsedTime(float)", AS_METHODPR(T, SetElapsedTime, (float), void), AS_CALL_THISCALL);
 
+    // void Scene::SetInstantiateQueueMs(int ms)
+    engine->RegisterObjectMethod(className, "void SetInstantiateQueueMs(int)", AS_METHODPR(T, SetInstantiateQueueMs, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_instantiateQueueMs(int)", AS_METHODPR(T, SetInstantiateQueueMs, (int), void), AS_CALL_THISCALL);
+
+    // void Scene::SetInterestCellSize(float size)
+    engine->RegisterObjectMethod(className, "void SetInterestCellSize(float)", AS_METHODPR(T, SetInterestCellSize, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_interestCellSize(float)", AS_METHODPR(T, SetInterestCellSize, (float), void), AS_CALL_THISCALL);
+
+    // void Scene::SetInterpolationDelay(float delay)
+    engine->RegisterObjectMethod(className, "void SetInterpolationDelay(float)", AS_METHODPR(T, SetInterpolationDelay, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_interpolationDelay(float)", AS_METHODPR(T, SetInterpolationDelay, (float), void), AS_CALL_THISCALL);
+
+    // void Scene::SetMaxExtrapolation(float time)
+    engine->RegisterObjectMethod(className, "void SetMaxExtrapolation(float)", AS_METHODPR(T, SetMaxExtrapolation, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxExtrapolation(float)", AS_METHODPR(T, SetMaxExtrapolation, (float), void), AS_CALL_THISCALL);
+
     // void Scene::SetSmoothingConstant(float constant)
     engine->RegisterObjectMethod(className, "void SetSmoothingConstant(float)", AS_METHODPR(T, SetSmoothingConstant, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_smoothingConstant(float)", AS_METHODPR(T, SetSmoothingConstant, (float), void), AS_CALL_THISCALL);
 
+    // void Scene::SetSnapshotTime(float time, float interval)
+    engine->RegisterObjectMethod(className, "void SetSnapshotTime(float, float)", AS_METHODPR(T, SetSnapshotTime, (float, float), void), AS_CALL_THISCALL);
+
     // void Scene::SetSnapThreshold(float threshold)
     engine->RegisterObjectMethod(className, "void SetSnapThreshold(float)", AS_METHODPR(T, SetSnapThreshold, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_snapThreshold(float)", AS_METHODPR(T, SetSnapThreshold, (float), void), AS_CALL_THISCALL);
 
+    // void Scene::SetThreadedTransformUpdate(bool enable)
+    engine->RegisterObjectMethod(className, "void SetThreadedTransformUpdate(bool)", AS_METHODPR(T, SetThreadedTransformUpdate, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_threadedTransformUpdate(bool)", AS_METHODPR(T, SetThreadedTransformUpdate, (bool), void), AS_CALL_THISCALL);
+
     // void Scene::SetTimeScale(float scale)
     engine->RegisterObjectMethod(className, "void SetTimeScale(float)", AS_METHODPR(T, SetTimeScale, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_timeScale(float)", AS_METHODPR(T, SetTimeScale, (float), void), AS_CALL_THISCALL);
@@ -18054,6 +19130,12 @@ template <class T> void RegisterMembers_Scene(asIScriptEngine* engine, const cha
     // void Scene::Update(float timeStep)
     engine->RegisterObjectMethod(className, "void Update(float)", AS_METHODPR(T, Update, (float), void), AS_CALL_THISCALL);
 
+    // void Scene::UpdateReplicatedTransforms()
+    engine->RegisterObjectMethod(className, "void UpdateReplicatedTransforms()", AS_METHODPR(T, UpdateReplicatedTransforms, (), void), AS_CALL_THISCALL);
+
+    // void Scene::UpdateWorldTransforms()
+    engine->RegisterObjectMethod(className, "void UpdateWorldTransforms()", AS_METHODPR(T, UpdateWorldTransforms, (), void), AS_CALL_THISCALL);
+
     // static bool Scene::IsReplicatedID(unsigned id)
     engine->SetDefaultNamespace(className);engine->RegisterGlobalFunction("bool IsReplicatedID(uint)", AS_FUNCTIONPR(T::IsReplicatedID, (unsigned), bool), AS_CALL_CDECL);engine->SetDefaultNamespace("");
 
@@ -18062,6 +19144,104 @@ template <class T> void RegisterMembers_Scene(asIScriptEngine* engine, const cha
     #endif
 }
 
+// class SceneStreamer | File: ../Scene/SceneStreamer.h
+template <class T> void RegisterMembers_SceneStreamer(asIScriptEngine* engine, const char* className)
+{
+    RegisterMembers_Component<T>(engine, className);
+
+    // virtual void Component::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
+    engine->RegisterObjectMethod(className, "void DrawDebugGeometry(DebugRenderer@+, bool)", AS_METHODPR(T, DrawDebugGeometry, (DebugRenderer*, bool), void), AS_CALL_THISCALL);
+
+    // IntVector2 SceneStreamer::GetCell(const Vector3& position) const
+    engine->RegisterObjectMethod(className, "IntVector2 GetCell(const Vector3&in) const", AS_METHODPR(T, GetCell, (const Vector3&) const, IntVector2), AS_CALL_THISCALL);
+
+    // const String& SceneStreamer::GetCellDirectory() const
+    engine->RegisterObjectMethod(className, "const String& GetCellDirectory() const", AS_METHODPR(T, GetCellDirectory, () const, const String&), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "const String& get_cellDirectory() const", AS_METHODPR(T, GetCellDirectory, () const, const String&), AS_CALL_THISCALL);
+
+    // String SceneStreamer::GetCellFileName(const IntVector2& cell) const
+    engine->RegisterObjectMethod(className, "String GetCellFileName(const IntVector2&in) const", AS_METHODPR(T, GetCellFileName, (const IntVector2&) const, String), AS_CALL_THISCALL);
+
+    // Node* SceneStreamer::GetCellNode(const IntVector2& cell) const
+    engine->RegisterObjectMethod(className, "Node@+ GetCellNode(const IntVector2&in) const", AS_METHODPR(T, GetCellNode, (const IntVector2&) const, Node*), AS_CALL_THISCALL);
+
+    // float SceneStreamer::GetCellSize() const
+    engine->RegisterObjectMethod(className, "float GetCellSize() const", AS_METHODPR(T, GetCellSize, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_cellSize() const", AS_METHODPR(T, GetCellSize, () const, float), AS_CALL_THISCALL);
+
+    // StreamingCellState SceneStreamer::GetCellState(const IntVector2& cell) const
+    engine->RegisterObjectMethod(className, "StreamingCellState GetCellState(const IntVector2&in) const", AS_METHODPR(T, GetCellState, (const IntVector2&) const, StreamingCellState), AS_CALL_THISCALL);
+
+    // Node* SceneStreamer::GetFocusNode() const
+    engine->RegisterObjectMethod(className, "Node@+ GetFocusNode() const", AS_METHODPR(T, GetFocusNode, () const, Node*), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "Node@+ get_focusNode() const", AS_METHODPR(T, GetFocusNode, () const, Node*), AS_CALL_THISCALL);
+
+    // Vector3 SceneStreamer::GetFocusPosition() const
+    engine->RegisterObjectMethod(className, "Vector3 GetFocusPosition() const", AS_METHODPR(T, GetFocusPosition, () const, Vector3), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "Vector3 get_focusPosition() const", AS_METHODPR(T, GetFocusPosition, () const, Vector3), AS_CALL_THISCALL);
+
+    // float SceneStreamer::GetLoadDistance() const
+    engine->RegisterObjectMethod(className, "float GetLoadDistance() const", AS_METHODPR(T, GetLoadDistance, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_loadDistance() const", AS_METHODPR(T, GetLoadDistance, () const, float), AS_CALL_THISCALL);
+
+    // int SceneStreamer::GetMaxInstantiationMs() const
+    engine->RegisterObjectMethod(className, "int GetMaxInstantiationMs() const", AS_METHODPR(T, GetMaxInstantiationMs, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_maxInstantiationMs() const", AS_METHODPR(T, GetMaxInstantiationMs, () const, int), AS_CALL_THISCALL);
+
+    // unsigned SceneStreamer::GetNumCells() const
+    engine->RegisterObjectMethod(className, "uint GetNumCells() const", AS_METHODPR(T, GetNumCells, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numCells() const", AS_METHODPR(T, GetNumCells, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned SceneStreamer::GetNumLoadedCells() const
+    engine->RegisterObjectMethod(className, "uint GetNumLoadedCells() const", AS_METHODPR(T, GetNumLoadedCells, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numLoadedCells() const", AS_METHODPR(T, GetNumLoadedCells, () const, unsigned), AS_CALL_THISCALL);
+
+    // float SceneStreamer::GetUnloadDistance() const
+    engine->RegisterObjectMethod(className, "float GetUnloadDistance() const", AS_METHODPR(T, GetUnloadDistance, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_unloadDistance() const", AS_METHODPR(T, GetUnloadDistance, () const, float), AS_CALL_THISCALL);
+
+    // void SceneStreamer::OnSetEnabled() override
+    engine->RegisterObjectMethod(className, "void OnSetEnabled()", AS_METHODPR(T, OnSetEnabled, (), void), AS_CALL_THISCALL);
+
+    // bool SceneStreamer::SaveCells(const String& directory) const
+    engine->RegisterObjectMethod(className, "bool SaveCells(const String&in) const", AS_METHODPR(T, SaveCells, (const String&) const, bool), AS_CALL_THISCALL);
+
+    // void SceneStreamer::SetCellDirectory(const String& directory)
+    engine->RegisterObjectMethod(className, "void SetCellDirectory(const String&in)", AS_METHODPR(T, SetCellDirectory, (const String&), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_cellDirectory(const String&in)", AS_METHODPR(T, SetCellDirectory, (const String&), void), AS_CALL_THISCALL);
+
+    // void SceneStreamer::SetCellSize(float size)
+    engine->RegisterObjectMethod(className, "void SetCellSize(float)", AS_METHODPR(T, SetCellSize, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_cellSize(float)", AS_METHODPR(T, SetCellSize, (float), void), AS_CALL_THISCALL);
+
+    // void SceneStreamer::SetFocusNode(Node* node)
+    engine->RegisterObjectMethod(className, "void SetFocusNode(Node@+)", AS_METHODPR(T, SetFocusNode, (Node*), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_focusNode(Node@+)", AS_METHODPR(T, SetFocusNode, (Node*), void), AS_CALL_THISCALL);
+
+    // void SceneStreamer::SetFocusPosition(const Vector3& position)
+    engine->RegisterObjectMethod(className, "void SetFocusPosition(const Vector3&in)", AS_METHODPR(T, SetFocusPosition, (const Vector3&), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_focusPosition(const Vector3&in)", AS_METHODPR(T, SetFocusPosition, (const Vector3&), void), AS_CALL_THISCALL);
+
+    // void SceneStreamer::SetLoadDistance(float distance)
+    engine->RegisterObjectMethod(className, "void SetLoadDistance(float)", AS_METHODPR(T, SetLoadDistance, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_loadDistance(float)", AS_METHODPR(T, SetLoadDistance, (float), void), AS_CALL_THISCALL);
+
+    // void SceneStreamer::SetMaxInstantiationMs(int ms)
+    engine->RegisterObjectMethod(className, "void SetMaxInstantiationMs(int)", AS_METHODPR(T, SetMaxInstantiationMs, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxInstantiationMs(int)", AS_METHODPR(T, SetMaxInstantiationMs, (int), void), AS_CALL_THISCALL);
+
+    // void SceneStreamer::SetUnloadDistance(float distance)
+    engine->RegisterObjectMethod(className, "void SetUnloadDistance(float)", AS_METHODPR(T, SetUnloadDistance, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_unloadDistance(float)", AS_METHODPR(T, SetUnloadDistance, (float), void), AS_CALL_THISCALL);
+
+    // void SceneStreamer::UnloadAllCells()
+    engine->RegisterObjectMethod(className, "void UnloadAllCells()", AS_METHODPR(T, UnloadAllCells, (), void), AS_CALL_THISCALL);
+
+    #ifdef REGISTER_MEMBERS_MANUAL_PART_SceneStreamer
+        REGISTER_MEMBERS_MANUAL_PART_SceneStreamer();
+    #endif
+}
+
 // class ScrollView | File: ../UI/ScrollView.h
 template <class T> void RegisterMembers_ScrollView(asIScriptEngine* engine, const char* className)
 {
@@ -18192,6 +19372,62 @@ template <class T> void RegisterMembers_ScrollView(asIScriptEngine* engine, cons
     #endif
 }
 
+// class SignificanceManager | File: ../Graphics/SignificanceManager.h
+template <class T> void RegisterMembers_SignificanceManager(asIScriptEngine* engine, const char* className)
+{
+    RegisterMembers_Component<T>(engine, className);
+
+    // bool SignificanceManager::CheckUpdate(Node* node, float& timeStep, float& accumulator)
+    // Error: type "float&" can not automatically bind
+    // static bool SignificanceManager::CheckUpdate(Component* component, float& timeStep, float& accumulator)
+    // Error: type "float&" can not automatically bind
+
+    // virtual void Component::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
+    engine->RegisterObjectMethod(className, "void DrawDebugGeometry(DebugRenderer@+, bool)", AS_METHODPR(T, DrawDebugGeometry, (DebugRenderer*, bool), void), AS_CALL_THISCALL);
+
+    // Camera* SignificanceManager::GetCamera() const
+    engine->RegisterObjectMethod(className, "Camera@+ GetCamera() const", AS_METHODPR(T, GetCamera, () const, Camera*), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "Camera@+ get_camera() const", AS_METHODPR(T, GetCamera, () const, Camera*), AS_CALL_THISCALL);
+
+    // float SignificanceManager::GetInvisibleFactor() const
+    engine->RegisterObjectMethod(className, "float GetInvisibleFactor() const", AS_METHODPR(T, GetInvisibleFactor, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_invisibleFactor() const", AS_METHODPR(T, GetInvisibleFactor, () const, float), AS_CALL_THISCALL);
+
+    // float SignificanceManager::GetMaxDistance() const
+    engine->RegisterObjectMethod(className, "float GetMaxDistance() const", AS_METHODPR(T, GetMaxDistance, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_maxDistance() const", AS_METHODPR(T, GetMaxDistance, () const, float), AS_CALL_THISCALL);
+
+    // float SignificanceManager::GetMaxUpdateInterval() const
+    engine->RegisterObjectMethod(className, "float GetMaxUpdateInterval() const", AS_METHODPR(T, GetMaxUpdateInterval, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_maxUpdateInterval() const", AS_METHODPR(T, GetMaxUpdateInterval, () const, float), AS_CALL_THISCALL);
+
+    // float SignificanceManager::GetSignificance(Node* node)
+    engine->RegisterObjectMethod(className, "float GetSignificance(Node@+)", AS_METHODPR(T, GetSignificance, (Node*), float), AS_CALL_THISCALL);
+
+    // float SignificanceManager::GetUpdateInterval(Node* node)
+    engine->RegisterObjectMethod(className, "float GetUpdateInterval(Node@+)", AS_METHODPR(T, GetUpdateInterval, (Node*), float), AS_CALL_THISCALL);
+
+    // void SignificanceManager::SetCamera(Camera* camera)
+    engine->RegisterObjectMethod(className, "void SetCamera(Camera@+)", AS_METHODPR(T, SetCamera, (Camera*), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_camera(Camera@+)", AS_METHODPR(T, SetCamera, (Camera*), void), AS_CALL_THISCALL);
+
+    // void SignificanceManager::SetInvisibleFactor(float factor)
+    engine->RegisterObjectMethod(className, "void SetInvisibleFactor(float)", AS_METHODPR(T, SetInvisibleFactor, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_invisibleFactor(float)", AS_METHODPR(T, SetInvisibleFactor, (float), void), AS_CALL_THISCALL);
+
+    // void SignificanceManager::SetMaxDistance(float distance)
+    engine->RegisterObjectMethod(className, "void SetMaxDistance(float)", AS_METHODPR(T, SetMaxDistance, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxDistance(float)", AS_METHODPR(T, SetMaxDistance, (float), void), AS_CALL_THISCALL);
+
+    // void SignificanceManager::SetMaxUpdateInterval(float interval)
+    engine->RegisterObjectMethod(className, "void SetMaxUpdateInterval(float)", AS_METHODPR(T, SetMaxUpdateInterval, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxUpdateInterval(float)", AS_METHODPR(T, SetMaxUpdateInterval, (float), void), AS_CALL_THISCALL);
+
+    #ifdef REGISTER_MEMBERS_MANUAL_PART_SignificanceManager
+        REGISTER_MEMBERS_MANUAL_PART_SignificanceManager();
+    #endif
+}
+
 // class SmoothedTransform | File: ../Scene/SmoothedTransform.h
 template <class T> void RegisterMembers_SmoothedTransform(asIScriptEngine* engine, const char* className)
 {
@@ -18200,6 +19436,10 @@ template <class T> void RegisterMembers_SmoothedTransform(asIScriptEngine* engin
     // virtual void Component::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
     engine->RegisterObjectMethod(className, "void DrawDebugGeometry(DebugRenderer@+, bool)", AS_METHODPR(T, DrawDebugGeometry, (DebugRenderer*, bool), void), AS_CALL_THISCALL);
 
+    // unsigned SmoothedTransform::GetNumSnapshots() const
+    engine->RegisterObjectMethod(className, "uint GetNumSnapshots() const", AS_METHODPR(T, GetNumSnapshots, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numSnapshots() const", AS_METHODPR(T, GetNumSnapshots, () const, unsigned), AS_CALL_THISCALL);
+
     // const Vector3& SmoothedTransform::GetTargetPosition() const
     engine->RegisterObjectMethod(className, "const Vector3& GetTargetPosition() const", AS_METHODPR(T, GetTargetPosition, () const, const Vector3&), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "const Vector3& get_targetPosition() const", AS_METHODPR(T, GetTargetPosition, () const, const Vector3&), AS_CALL_THISCALL);
@@ -18272,6 +19512,8 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     // Error: type "signed char*" can not automatically bind
     // void SoundSource::Mix(int* dest, unsigned samples, int mixRate, bool stereo, bool interpolation)
     // Error: type "int*" can not automatically bind
+    // void SoundSource::SetMixPlayback(Sound* sound, SoundStream* stream, Sound* streamBuffer, signed char* position, float timePosition)
+    // Error: type "signed char*" can not automatically bind
     // void SoundSource::SetPlayPosition(signed char* pos)
     // Error: type "signed char*" can not automatically bind
 
@@ -18294,6 +19536,9 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     engine->RegisterObjectMethod(className, "float GetGain() const", AS_METHODPR(T, GetGain, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_gain() const", AS_METHODPR(T, GetGain, () const, float), AS_CALL_THISCALL);
 
+    // float SoundSource::GetMixAudibility() const
+    engine->RegisterObjectMethod(className, "float GetMixAudibility() const", AS_METHODPR(T, GetMixAudibility, () const, float), AS_CALL_THISCALL);
+
     // float SoundSource::GetPanning() const
     engine->RegisterObjectMethod(className, "float GetPanning() const", AS_METHODPR(T, GetPanning, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_panning() const", AS_METHODPR(T, GetPanning, () const, float), AS_CALL_THISCALL);
@@ -18301,6 +19546,10 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     // int SoundSource::GetPositionAttr() const
     engine->RegisterObjectMethod(className, "int GetPositionAttr() const", AS_METHODPR(T, GetPositionAttr, () const, int), AS_CALL_THISCALL);
 
+    // float SoundSource::GetPriority() const
+    engine->RegisterObjectMethod(className, "float GetPriority() const", AS_METHODPR(T, GetPriority, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_priority() const", AS_METHODPR(T, GetPriority, () const, float), AS_CALL_THISCALL);
+
     // Sound* SoundSource::GetSound() const
     engine->RegisterObjectMethod(className, "Sound@+ GetSound() const", AS_METHODPR(T, GetSound, () const, Sound*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "Sound@+ get_sound() const", AS_METHODPR(T, GetSound, () const, Sound*), AS_CALL_THISCALL);
@@ -18312,6 +19561,9 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     engine->RegisterObjectMethod(className, "String GetSoundType() const", AS_METHODPR(T, GetSoundType, () const, String), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "String get_soundType() const", AS_METHODPR(T, GetSoundType, () const, String), AS_CALL_THISCALL);
 
+    // StringHash SoundSource::GetSoundTypeHash() const
+    engine->RegisterObjectMethod(className, "StringHash GetSoundTypeHash() const", AS_METHODPR(T, GetSoundTypeHash, () const, StringHash), AS_CALL_THISCALL);
+
     // float SoundSource::GetTimePosition() const
     engine->RegisterObjectMethod(className, "float GetTimePosition() const", AS_METHODPR(T, GetTimePosition, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_timePosition() const", AS_METHODPR(T, GetTimePosition, () const, float), AS_CALL_THISCALL);
@@ -18356,6 +19608,9 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     engine->RegisterObjectMethod(className, "void SetGain(float)", AS_METHODPR(T, SetGain, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_gain(float)", AS_METHODPR(T, SetGain, (float), void), AS_CALL_THISCALL);
 
+    // void SoundSource::SetMixVirtual(bool enable)
+    engine->RegisterObjectMethod(className, "void SetMixVirtual(bool)", AS_METHODPR(T, SetMixVirtual, (bool), void), AS_CALL_THISCALL);
+
     // void SoundSource::SetPanning(float panning)
     engine->RegisterObjectMethod(className, "void SetPanning(float)", AS_METHODPR(T, SetPanning, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_panning(float)", AS_METHODPR(T, SetPanning, (float), void), AS_CALL_THISCALL);
@@ -18366,6 +19621,10 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     // void SoundSource::SetPositionAttr(int value)
     engine->RegisterObjectMethod(className, "void SetPositionAttr(int)", AS_METHODPR(T, SetPositionAttr, (int), void), AS_CALL_THISCALL);
 
+    // void SoundSource::SetPriority(float priority)
+    engine->RegisterObjectMethod(className, "void SetPriority(float)", AS_METHODPR(T, SetPriority, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_priority(float)", AS_METHODPR(T, SetPriority, (float), void), AS_CALL_THISCALL);
+
     // void SoundSource::SetSoundAttr(const ResourceRef& value)
     engine->RegisterObjectMethod(className, "void SetSoundAttr(const ResourceRef&in)", AS_METHODPR(T, SetSoundAttr, (const ResourceRef&), void), AS_CALL_THISCALL);
 
@@ -18581,6 +19840,10 @@ template <class T> void RegisterMembers_Terrain(asIScriptEngine* engine, const c
     // virtual void Component::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
     engine->RegisterObjectMethod(className, "void DrawDebugGeometry(DebugRenderer@+, bool)", AS_METHODPR(T, DrawDebugGeometry, (DebugRenderer*, bool), void), AS_CALL_THISCALL);
 
+    // bool Terrain::GetAsyncBuild() const
+    engine->RegisterObjectMethod(className, "bool GetAsyncBuild() const", AS_METHODPR(T, GetAsyncBuild, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_asyncBuild() const", AS_METHODPR(T, GetAsyncBuild, () const, bool), AS_CALL_THISCALL);
+
     // bool Terrain::GetCastShadows() const
     engine->RegisterObjectMethod(className, "bool GetCastShadows() const", AS_METHODPR(T, GetCastShadows, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_castShadows() const", AS_METHODPR(T, GetCastShadows, () const, bool), AS_CALL_THISCALL);
@@ -18593,6 +19856,10 @@ template <class T> void RegisterMembers_Terrain(asIScriptEngine* engine, const c
     engine->RegisterObjectMethod(className, "Terrain@+ GetEastNeighbor() const", AS_METHODPR(T, GetEastNeighbor, () const, Terrain*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "Terrain@+ get_eastNeighbor() const", AS_METHODPR(T, GetEastNeighbor, () const, Terrain*), AS_CALL_THISCALL);
 
+    // bool Terrain::GetGPURendering() const
+    engine->RegisterObjectMethod(className, "bool GetGPURendering() const", AS_METHODPR(T, GetGPURendering, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_gpuRendering() const", AS_METHODPR(T, GetGPURendering, () const, bool), AS_CALL_THISCALL);
+
     // float Terrain::GetHeight(const Vector3& worldPosition) const
     engine->RegisterObjectMethod(className, "float GetHeight(const Vector3&in) const", AS_METHODPR(T, GetHeight, (const Vector3&) const, float), AS_CALL_THISCALL);
 
@@ -18694,6 +19961,9 @@ template <class T> void RegisterMembers_Terrain(asIScriptEngine* engine, const c
     // Vector3 Terrain::HeightMapToWorld(const IntVector2& pixelPosition) const
     engine->RegisterObjectMethod(className, "Vector3 HeightMapToWorld(const IntVector2&in) const", AS_METHODPR(T, HeightMapToWorld, (const IntVector2&) const, Vector3), AS_CALL_THISCALL);
 
+    // bool Terrain::IsBuilding() const
+    engine->RegisterObjectMethod(className, "bool IsBuilding() const", AS_METHODPR(T, IsBuilding, () const, bool), AS_CALL_THISCALL);
+
     // bool Terrain::IsOccludee() const
     engine->RegisterObjectMethod(className, "bool IsOccludee() const", AS_METHODPR(T, IsOccludee, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_occludee() const", AS_METHODPR(T, IsOccludee, () const, bool), AS_CALL_THISCALL);
@@ -18705,9 +19975,16 @@ template <class T> void RegisterMembers_Terrain(asIScriptEngine* engine, const c
     // bool Terrain::IsVisible() const
     engine->RegisterObjectMethod(className, "bool IsVisible() const", AS_METHODPR(T, IsVisible, () const, bool), AS_CALL_THISCALL);
 
+    // void Terrain::OnSetAttribute(const AttributeInfo& attr, const Variant& src) override
+    engine->RegisterObjectMethod(className, "void OnSetAttribute(const AttributeInfo&in, const Variant&in)", AS_METHODPR(T, OnSetAttribute, (const AttributeInfo&, const Variant&), void), AS_CALL_THISCALL);
+
     // void Terrain::OnSetEnabled() override
     engine->RegisterObjectMethod(className, "void OnSetEnabled()", AS_METHODPR(T, OnSetEnabled, (), void), AS_CALL_THISCALL);
 
+    // void Terrain::SetAsyncBuild(bool enable)
+    engine->RegisterObjectMethod(className, "void SetAsyncBuild(bool)", AS_METHODPR(T, SetAsyncBuild, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_asyncBuild(bool)", AS_METHODPR(T, SetAsyncBuild, (bool), void), AS_CALL_THISCALL);
+
     // void Terrain::SetCastShadows(bool enable)
     engine->RegisterObjectMethod(className, "void SetCastShadows(bool)", AS_METHODPR(T, SetCastShadows, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_castShadows(bool)", AS_METHODPR(T, SetCastShadows, (bool), void), AS_CALL_THISCALL);
@@ -18720,6 +19997,13 @@ template <class T> void RegisterMembers_Terrain(asIScriptEngine* engine, const c
     engine->RegisterObjectMethod(className, "void SetEastNeighbor(Terrain@+)", AS_METHODPR(T, SetEastNeighbor, (Terrain*), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_eastNeighbor(Terrain@+)", AS_METHODPR(T, SetEastNeighbor, (Terrain*), void), AS_CALL_THISCALL);
 
+    // void Terrain::SetGPURendering(bool enable)
+    engine->RegisterObjectMethod(className, "void SetGPURendering(bool)", AS_METHODPR(T, SetGPURendering, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_gpuRendering(bool)", AS_METHODPR(T, SetGPURendering, (bool), void), AS_CALL_THISCALL);
+
+    // void Terrain::SetGPURenderingAttr(bool enable)
+    engine->RegisterObjectMethod(className, "void SetGPURenderingAttr(bool)", AS_METHODPR(T, SetGPURenderingAttr, (bool), void), AS_CALL_THISCALL);
+
     // bool Terrain::SetHeightMap(Image* image)
     engine->RegisterObjectMethod(className, "bool SetHeightMap(Image@+)", AS_METHODPR(T, SetHeightMap, (Image*), bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool set_heightMap(Image@+)", AS_METHODPR(T, SetHeightMap, (Image*), bool), AS_CALL_THISCALL);
@@ -18832,11 +20116,213 @@ template <class T> Image* Texture2D_SharedPtrlesImagegre_GetImage_void_template(
     return result.Detach();
 }
 
+// class TerrainStreamer | File: ../Graphics/TerrainStreamer.h
+template <class T> void RegisterMembers_TerrainStreamer(asIScriptEngine* engine, const char* className)
+{
+    RegisterMembers_Component<T>(engine, className);
+
+    // virtual void Component::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
+    engine->RegisterObjectMethod(className, "void DrawDebugGeometry(DebugRenderer@+, bool)", AS_METHODPR(T, DrawDebugGeometry, (DebugRenderer*, bool), void), AS_CALL_THISCALL);
+
+    // bool TerrainStreamer::GetCastShadows() const
+    engine->RegisterObjectMethod(className, "bool GetCastShadows() const", AS_METHODPR(T, GetCastShadows, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_castShadows() const", AS_METHODPR(T, GetCastShadows, () const, bool), AS_CALL_THISCALL);
+
+    // float TerrainStreamer::GetDrawDistance() const
+    engine->RegisterObjectMethod(className, "float GetDrawDistance() const", AS_METHODPR(T, GetDrawDistance, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_drawDistance() const", AS_METHODPR(T, GetDrawDistance, () const, float), AS_CALL_THISCALL);
+
+    // Node* TerrainStreamer::GetFocusNode() const
+    engine->RegisterObjectMethod(className, "Node@+ GetFocusNode() const", AS_METHODPR(T, GetFocusNode, () const, Node*), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "Node@+ get_focusNode() const", AS_METHODPR(T, GetFocusNode, () const, Node*), AS_CALL_THISCALL);
+
+    // Vector3 TerrainStreamer::GetFocusPosition() const
+    engine->RegisterObjectMethod(className, "Vector3 GetFocusPosition() const", AS_METHODPR(T, GetFocusPosition, () const, Vector3), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "Vector3 get_focusPosition() const", AS_METHODPR(T, GetFocusPosition, () const, Vector3), AS_CALL_THISCALL);
+
+    // float TerrainStreamer::GetHeight(const Vector3& worldPosition) const
+    engine->RegisterObjectMethod(className, "float GetHeight(const Vector3&in) const", AS_METHODPR(T, GetHeight, (const Vector3&) const, float), AS_CALL_THISCALL);
+
+    // const String& TerrainStreamer::GetHeightMapTiles() const
+    engine->RegisterObjectMethod(className, "const String& GetHeightMapTiles() const", AS_METHODPR(T, GetHeightMapTiles, () const, const String&), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "const String& get_heightMapTiles() const", AS_METHODPR(T, GetHeightMapTiles, () const, const String&), AS_CALL_THISCALL);
+
+    // float TerrainStreamer::GetLoadDistance() const
+    engine->RegisterObjectMethod(className, "float GetLoadDistance() const", AS_METHODPR(T, GetLoadDistance, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_loadDistance() const", AS_METHODPR(T, GetLoadDistance, () const, float), AS_CALL_THISCALL);
+
+    // float TerrainStreamer::GetLodBias() const
+    engine->RegisterObjectMethod(className, "float GetLodBias() const", AS_METHODPR(T, GetLodBias, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_lodBias() const", AS_METHODPR(T, GetLodBias, () const, float), AS_CALL_THISCALL);
+
+    // Material* TerrainStreamer::GetMaterial() const
+    engine->RegisterObjectMethod(className, "Material@+ GetMaterial() const", AS_METHODPR(T, GetMaterial, () const, Material*), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "Material@+ get_material() const", AS_METHODPR(T, GetMaterial, () const, Material*), AS_CALL_THISCALL);
+
+    // ResourceRef TerrainStreamer::GetMaterialAttr() const
+    engine->RegisterObjectMethod(className, "ResourceRef GetMaterialAttr() const", AS_METHODPR(T, GetMaterialAttr, () const, ResourceRef), AS_CALL_THISCALL);
+
+    // const String& TerrainStreamer::GetMaterialTiles() const
+    engine->RegisterObjectMethod(className, "const String& GetMaterialTiles() const", AS_METHODPR(T, GetMaterialTiles, () const, const String&), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "const String& get_materialTiles() const", AS_METHODPR(T, GetMaterialTiles, () const, const String&), AS_CALL_THISCALL);
+
+    // unsigned TerrainStreamer::GetMaxLoadingTiles() const
+    engine->RegisterObjectMethod(className, "uint GetMaxLoadingTiles() const", AS_METHODPR(T, GetMaxLoadingTiles, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_maxLoadingTiles() const", AS_METHODPR(T, GetMaxLoadingTiles, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned TerrainStreamer::GetMaxLodLevels() const
+    engine->RegisterObjectMethod(className, "uint GetMaxLodLevels() const", AS_METHODPR(T, GetMaxLodLevels, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_maxLodLevels() const", AS_METHODPR(T, GetMaxLodLevels, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned TerrainStreamer::GetMaxResidentTiles() const
+    engine->RegisterObjectMethod(className, "uint GetMaxResidentTiles() const", AS_METHODPR(T, GetMaxResidentTiles, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_maxResidentTiles() const", AS_METHODPR(T, GetMaxResidentTiles, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned TerrainStreamer::GetNumLoadedTiles() const
+    engine->RegisterObjectMethod(className, "uint GetNumLoadedTiles() const", AS_METHODPR(T, GetNumLoadedTiles, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numLoadedTiles() const", AS_METHODPR(T, GetNumLoadedTiles, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned TerrainStreamer::GetNumTiles() const
+    engine->RegisterObjectMethod(className, "uint GetNumTiles() const", AS_METHODPR(T, GetNumTiles, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numTiles() const", AS_METHODPR(T, GetNumTiles, () const, unsigned), AS_CALL_THISCALL);
+
+    // int TerrainStreamer::GetPatchSize() const
+    engine->RegisterObjectMethod(className, "int GetPatchSize() const", AS_METHODPR(T, GetPatchSize, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_patchSize() const", AS_METHODPR(T, GetPatchSize, () const, int), AS_CALL_THISCALL);
+
+    // bool TerrainStreamer::GetSmoothing() const
+    engine->RegisterObjectMethod(className, "bool GetSmoothing() const", AS_METHODPR(T, GetSmoothing, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_smoothing() const", AS_METHODPR(T, GetSmoothing, () const, bool), AS_CALL_THISCALL);
+
+    // const Vector3& TerrainStreamer::GetSpacing() const
+    engine->RegisterObjectMethod(className, "const Vector3& GetSpacing() const", AS_METHODPR(T, GetSpacing, () const, const Vector3&), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "const Vector3& get_spacing() const", AS_METHODPR(T, GetSpacing, () const, const Vector3&), AS_CALL_THISCALL);
+
+    // IntVector2 TerrainStreamer::GetTile(const Vector3& worldPosition) const
+    engine->RegisterObjectMethod(className, "IntVector2 GetTile(const Vector3&in) const", AS_METHODPR(T, GetTile, (const Vector3&) const, IntVector2), AS_CALL_THISCALL);
+
+    // String TerrainStreamer::GetTileHeightMapName(const IntVector2& tile) const
+    engine->RegisterObjectMethod(className, "String GetTileHeightMapName(const IntVector2&in) const", AS_METHODPR(T, GetTileHeightMapName, (const IntVector2&) const, String), AS_CALL_THISCALL);
+
+    // String TerrainStreamer::GetTileMaterialName(const IntVector2& tile) const
+    engine->RegisterObjectMethod(className, "String GetTileMaterialName(const IntVector2&in) const", AS_METHODPR(T, GetTileMaterialName, (const IntVector2&) const, String), AS_CALL_THISCALL);
+
+    // int TerrainStreamer::GetTileSize() const
+    engine->RegisterObjectMethod(className, "int GetTileSize() const", AS_METHODPR(T, GetTileSize, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_tileSize() const", AS_METHODPR(T, GetTileSize, () const, int), AS_CALL_THISCALL);
+
+    // TerrainTileState TerrainStreamer::GetTileState(const IntVector2& tile) const
+    engine->RegisterObjectMethod(className, "TerrainTileState GetTileState(const IntVector2&in) const", AS_METHODPR(T, GetTileState, (const IntVector2&) const, TerrainTileState), AS_CALL_THISCALL);
+
+    // Terrain* TerrainStreamer::GetTileTerrain(const IntVector2& tile) const
+    engine->RegisterObjectMethod(className, "Terrain@+ GetTileTerrain(const IntVector2&in) const", AS_METHODPR(T, GetTileTerrain, (const IntVector2&) const, Terrain*), AS_CALL_THISCALL);
+
+    // float TerrainStreamer::GetUnloadDistance() const
+    engine->RegisterObjectMethod(className, "float GetUnloadDistance() const", AS_METHODPR(T, GetUnloadDistance, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_unloadDistance() const", AS_METHODPR(T, GetUnloadDistance, () const, float), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::OnSetEnabled() override
+    engine->RegisterObjectMethod(className, "void OnSetEnabled()", AS_METHODPR(T, OnSetEnabled, (), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetCastShadows(bool enable)
+    engine->RegisterObjectMethod(className, "void SetCastShadows(bool)", AS_METHODPR(T, SetCastShadows, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_castShadows(bool)", AS_METHODPR(T, SetCastShadows, (bool), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetDrawDistance(float distance)
+    engine->RegisterObjectMethod(className, "void SetDrawDistance(float)", AS_METHODPR(T, SetDrawDistance, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_drawDistance(float)", AS_METHODPR(T, SetDrawDistance, (float), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetFocusNode(Node* node)
+    engine->RegisterObjectMethod(className, "void SetFocusNode(Node@+)", AS_METHODPR(T, SetFocusNode, (Node*), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_focusNode(Node@+)", AS_METHODPR(T, SetFocusNode, (Node*), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetFocusPosition(const Vector3& position)
+    engine->RegisterObjectMethod(className, "void SetFocusPosition(const Vector3&in)", AS_METHODPR(T, SetFocusPosition, (const Vector3&), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_focusPosition(const Vector3&in)", AS_METHODPR(T, SetFocusPosition, (const Vector3&), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetHeightMapTiles(const String& pattern)
+    engine->RegisterObjectMethod(className, "void SetHeightMapTiles(const String&in)", AS_METHODPR(T, SetHeightMapTiles, (const String&), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_heightMapTiles(const String&in)", AS_METHODPR(T, SetHeightMapTiles, (const String&), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetLoadDistance(float distance)
+    engine->RegisterObjectMethod(className, "void SetLoadDistance(float)", AS_METHODPR(T, SetLoadDistance, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_loadDistance(float)", AS_METHODPR(T, SetLoadDistance, (float), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetLodBias(float bias)
+    engine->RegisterObjectMethod(className, "void SetLodBias(float)", AS_METHODPR(T, SetLodBias, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_lodBias(float)", AS_METHODPR(T, SetLodBias, (float), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetMaterial(Material* material)
+    engine->RegisterObjectMethod(className, "void SetMaterial(Material@+)", AS_METHODPR(T, SetMaterial, (Material*), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_material(Material@+)", AS_METHODPR(T, SetMaterial, (Material*), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetMaterialAttr(const ResourceRef& value)
+    engine->RegisterObjectMethod(className, "void SetMaterialAttr(const ResourceRef&in)", AS_METHODPR(T, SetMaterialAttr, (const ResourceRef&), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetMaterialTiles(const String& pattern)
+    engine->RegisterObjectMethod(className, "void SetMaterialTiles(const String&in)", AS_METHODPR(T, SetMaterialTiles, (const String&), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_materialTiles(const String&in)", AS_METHODPR(T, SetMaterialTiles, (const String&), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetMaxLoadingTiles(unsigned num)
+    engine->RegisterObjectMethod(className, "void SetMaxLoadingTiles(uint)", AS_METHODPR(T, SetMaxLoadingTiles, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxLoadingTiles(uint)", AS_METHODPR(T, SetMaxLoadingTiles, (unsigned), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetMaxLodLevels(unsigned levels)
+    engine->RegisterObjectMethod(className, "void SetMaxLodLevels(uint)", AS_METHODPR(T, SetMaxLodLevels, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxLodLevels(uint)", AS_METHODPR(T, SetMaxLodLevels, (unsigned), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetMaxResidentTiles(unsigned num)
+    engine->RegisterObjectMethod(className, "void SetMaxResidentTiles(uint)", AS_METHODPR(T, SetMaxResidentTiles, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxResidentTiles(uint)", AS_METHODPR(T, SetMaxResidentTiles, (unsigned), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetPatchSize(int size)
+    engine->RegisterObjectMethod(className, "void SetPatchSize(int)", AS_METHODPR(T, SetPatchSize, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_patchSize(int)", AS_METHODPR(T, SetPatchSize, (int), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetSmoothing(bool enable)
+    engine->RegisterObjectMethod(className, "void SetSmoothing(bool)", AS_METHODPR(T, SetSmoothing, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_smoothing(bool)", AS_METHODPR(T, SetSmoothing, (bool), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetSpacing(const Vector3& spacing)
+    engine->RegisterObjectMethod(className, "void SetSpacing(const Vector3&in)", AS_METHODPR(T, SetSpacing, (const Vector3&), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_spacing(const Vector3&in)", AS_METHODPR(T, SetSpacing, (const Vector3&), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetTileSize(int size)
+    engine->RegisterObjectMethod(className, "void SetTileSize(int)", AS_METHODPR(T, SetTileSize, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_tileSize(int)", AS_METHODPR(T, SetTileSize, (int), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::SetUnloadDistance(float distance)
+    engine->RegisterObjectMethod(className, "void SetUnloadDistance(float)", AS_METHODPR(T, SetUnloadDistance, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_unloadDistance(float)", AS_METHODPR(T, SetUnloadDistance, (float), void), AS_CALL_THISCALL);
+
+    // void TerrainStreamer::UnloadAllTiles()
+    engine->RegisterObjectMethod(className, "void UnloadAllTiles()", AS_METHODPR(T, UnloadAllTiles, (), void), AS_CALL_THISCALL);
+
+    #ifdef REGISTER_MEMBERS_MANUAL_PART_TerrainStreamer
+        REGISTER_MEMBERS_MANUAL_PART_TerrainStreamer();
+    #endif
+}
+
 // class Texture2D | File: ../Graphics/Texture2D.h
 template <class T> void RegisterMembers_Texture2D(asIScriptEngine* engine, const char* className)
 {
     RegisterMembers_Texture<T>(engine, className);
 
+    // unsigned Texture2D::GetRequestedMipsSkipped() const
+    // Not registered because have @nobind mark
+
+    // unsigned Texture2D::GetStreamingRequestFrame() const
+    // Not registered because have @nobind mark
+
+    // bool Texture2D::IsStreamingPending() const
+    // Not registered because have @nobind mark
+
+    // void Texture2D::RequestStreamedResolution(float texels, unsigned frameNumber)
+    // Not registered because have @nobind mark
+
+    // bool Texture2D::StreamMips(unsigned mipsSkipped, int priority = 0)
+    // Not registered because have @nobind mark
+
     // bool Texture2D::GetData(unsigned level, void* dest) const
     // Error: type "void*" can not automatically bind
     // bool Texture2D::SetData(unsigned level, int x, int y, int width, int height, const void* data)
@@ -18848,16 +20334,32 @@ template <class T> void RegisterMembers_Texture2D(asIScriptEngine* engine, const
     // SharedPtr<Image> Texture2D::GetImage() const
     engine->RegisterObjectMethod(className, "Image@+ GetImage() const", AS_FUNCTION_OBJFIRST(Texture2D_SharedPtrlesImagegre_GetImage_void_template<Texture2D>), AS_CALL_CDECL_OBJFIRST);
 
+    // unsigned Texture2D::GetMaxStreamedMipsSkipped() const
+    engine->RegisterObjectMethod(className, "uint GetMaxStreamedMipsSkipped() const", AS_METHODPR(T, GetMaxStreamedMipsSkipped, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_maxStreamedMipsSkipped() const", AS_METHODPR(T, GetMaxStreamedMipsSkipped, () const, unsigned), AS_CALL_THISCALL);
+
     // RenderSurface* Texture2D::GetRenderSurface() const
     engine->RegisterObjectMethod(className, "RenderSurface@+ GetRenderSurface() const", AS_METHODPR(T, GetRenderSurface, () const, RenderSurface*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "RenderSurface@+ get_renderSurface() const", AS_METHODPR(T, GetRenderSurface, () const, RenderSurface*), AS_CALL_THISCALL);
 
+    // unsigned Texture2D::GetStreamedMipsSkipped() const
+    engine->RegisterObjectMethod(className, "uint GetStreamedMipsSkipped() const", AS_METHODPR(T, GetStreamedMipsSkipped, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_streamedMipsSkipped() const", AS_METHODPR(T, GetStreamedMipsSkipped, () const, unsigned), AS_CALL_THISCALL);
+
+    // bool Texture2D::GetStreaming() const
+    engine->RegisterObjectMethod(className, "bool GetStreaming() const", AS_METHODPR(T, GetStreaming, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_streaming() const", AS_METHODPR(T, GetStreaming, () const, bool), AS_CALL_THISCALL);
+
     // bool Texture2D::SetData(Image* image, bool useAlpha = false)
     engine->RegisterObjectMethod(className, "bool SetData(Image@+, bool = false)", AS_METHODPR(T, SetData, (Image*, bool), bool), AS_CALL_THISCALL);
 
     // bool Texture2D::SetSize(int width, int height, unsigned format, TextureUsage usage = TEXTURE_STATIC, int multiSample = 1, bool autoResolve = true)
     engine->RegisterObjectMethod(className, "bool SetSize(int, int, uint, TextureUsage = TEXTURE_STATIC, int = 1, bool = true)", AS_METHODPR(T, SetSize, (int, int, unsigned, TextureUsage, int, bool), bool), AS_CALL_THISCALL);
 
+    // void Texture2D::SetStreaming(bool enable)
+    engine->RegisterObjectMethod(className, "void SetStreaming(bool)", AS_METHODPR(T, SetStreaming, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_streaming(bool)", AS_METHODPR(T, SetStreaming, (bool), void), AS_CALL_THISCALL);
+
     // static void Texture2D::RegisterObject(Context* context)
     // Not registered because have @nobind mark
 
@@ -19617,6 +21119,10 @@ template <class T> void RegisterMembers_CrowdManager(asIScriptEngine* engine, co
     engine->RegisterObjectMethod(className, "uint GetNumObstacleAvoidanceTypes() const", AS_METHODPR(T, GetNumObstacleAvoidanceTypes, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numObstacleAvoidanceTypes() const", AS_METHODPR(T, GetNumObstacleAvoidanceTypes, () const, unsigned), AS_CALL_THISCALL);
 
+    // unsigned CrowdManager::GetNumPartitions() const
+    engine->RegisterObjectMethod(className, "uint GetNumPartitions() const", AS_METHODPR(T, GetNumPartitions, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numPartitions() const", AS_METHODPR(T, GetNumPartitions, () const, unsigned), AS_CALL_THISCALL);
+
     // unsigned CrowdManager::GetNumQueryFilterTypes() const
     engine->RegisterObjectMethod(className, "uint GetNumQueryFilterTypes() const", AS_METHODPR(T, GetNumQueryFilterTypes, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numQueryFilterTypes() const", AS_METHODPR(T, GetNumQueryFilterTypes, () const, unsigned), AS_CALL_THISCALL);
@@ -19624,6 +21130,10 @@ template <class T> void RegisterMembers_CrowdManager(asIScriptEngine* engine, co
     // const CrowdObstacleAvoidanceParams& CrowdManager::GetObstacleAvoidanceParams(unsigned obstacleAvoidanceType) const
     engine->RegisterObjectMethod(className, "const CrowdObstacleAvoidanceParams& GetObstacleAvoidanceParams(uint) const", AS_METHODPR(T, GetObstacleAvoidanceParams, (unsigned) const, const CrowdObstacleAvoidanceParams&), AS_CALL_THISCALL);
 
+    // float CrowdManager::GetPartitionSize() const
+    engine->RegisterObjectMethod(className, "float GetPartitionSize() const", AS_METHODPR(T, GetPartitionSize, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_partitionSize() const", AS_METHODPR(T, GetPartitionSize, () const, float), AS_CALL_THISCALL);
+
     // Vector3 CrowdManager::MoveAlongSurface(const Vector3& start, const Vector3& end, int queryFilterType, int maxVisited = 3)
     engine->RegisterObjectMethod(className, "Vector3 MoveAlongSurface(const Vector3&in, const Vector3&in, int, int = 3)", AS_METHODPR(T, MoveAlongSurface, (const Vector3&, const Vector3&, int, int), Vector3), AS_CALL_THISCALL);
 
@@ -19663,6 +21173,10 @@ template <class T> void RegisterMembers_CrowdManager(asIScriptEngine* engine, co
     // void CrowdManager::SetObstacleAvoidanceParams(unsigned obstacleAvoidanceType, const CrowdObstacleAvoidanceParams& params)
     engine->RegisterObjectMethod(className, "void SetObstacleAvoidanceParams(uint, const CrowdObstacleAvoidanceParams&in)", AS_METHODPR(T, SetObstacleAvoidanceParams, (unsigned, const CrowdObstacleAvoidanceParams&), void), AS_CALL_THISCALL);
 
+    // void CrowdManager::SetPartitionSize(float size)
+    engine->RegisterObjectMethod(className, "void SetPartitionSize(float)", AS_METHODPR(T, SetPartitionSize, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_partitionSize(float)", AS_METHODPR(T, SetPartitionSize, (float), void), AS_CALL_THISCALL);
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_CrowdManager
         REGISTER_MEMBERS_MANUAL_PART_CrowdManager();
     #endif
@@ -19741,6 +21255,8 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     // Error: type "PODVector<Vector3>&" can not automatically bind
     // void NavigationMesh::FindPath(PODVector<NavigationPathPoint>& dest, const Vector3& start, const Vector3& end, const Vector3& extents = Vector3::ONE, const dtQueryFilter* filter = nullptr)
     // Error: type "PODVector<NavigationPathPoint>&" can not automatically bind
+    // void NavigationMesh::FindPathWaypoints(PODVector<Vector3>& dest, const Vector3& start, const Vector3& end, const Vector3& extents = Vector3::ONE, const dtQueryFilter* filter = nullptr)
+    // Error: type "PODVector<Vector3>&" can not automatically bind
     // float NavigationMesh::GetDistanceToWall(const Vector3& point, float radius, const Vector3& extents = Vector3::ONE, const dtQueryFilter* filter = nullptr, Vector3* hitPos = nullptr, Vector3* hitNormal = nullptr)
     // Error: type "const dtQueryFilter*" can not automatically bind
     // virtual PODVector<unsigned char> NavigationMesh::GetNavigationDataAttr() const
@@ -19758,6 +21274,9 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     // virtual void NavigationMesh::SetNavigationDataAttr(const PODVector<unsigned char>& value)
     // Error: type "const PODVector<unsigned char>&" can not automatically bind
 
+    // void NavigationMesh::AddStreamingPoint(Node* node)
+    engine->RegisterObjectMethod(className, "void AddStreamingPoint(Node@+)", AS_METHODPR(T, AddStreamingPoint, (Node*), void), AS_CALL_THISCALL);
+
     // virtual bool NavigationMesh::Allocate(const BoundingBox& boundingBox, unsigned maxTiles)
     engine->RegisterObjectMethod(className, "bool Allocate(const BoundingBox&in, uint)", AS_METHODPR(T, Allocate, (const BoundingBox&, unsigned), bool), AS_CALL_THISCALL);
 
@@ -19770,6 +21289,30 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     // virtual bool NavigationMesh::Build(const IntVector2& from, const IntVector2& to)
     engine->RegisterObjectMethod(className, "bool Build(const IntVector2&in, const IntVector2&in)", AS_METHODPR(T, Build, (const IntVector2&, const IntVector2&), bool), AS_CALL_THISCALL);
 
+    // bool NavigationMesh::BuildAsync(const BoundingBox& boundingBox)
+    engine->RegisterObjectMethod(className, "bool BuildAsync(const BoundingBox&in)", AS_METHODPR(T, BuildAsync, (const BoundingBox&), bool), AS_CALL_THISCALL);
+
+    // bool NavigationMesh::BuildAsync(const IntVector2& from, const IntVector2& to)
+    engine->RegisterObjectMethod(className, "bool BuildAsync(const IntVector2&in, const IntVector2&in)", AS_METHODPR(T, BuildAsync, (const IntVector2&, const IntVector2&), bool), AS_CALL_THISCALL);
+
+    // void NavigationMesh::CancelAsyncBuild()
+    engine->RegisterObjectMethod(className, "void CancelAsyncBuild()", AS_METHODPR(T, CancelAsyncBuild, (), void), AS_CALL_THISCALL);
+
+    // void NavigationMesh::CancelPathRequests()
+    engine->RegisterObjectMethod(className, "void CancelPathRequests()", AS_METHODPR(T, CancelPathRequests, (), void), AS_CALL_THISCALL);
+
+    // void NavigationMesh::ClearGeometryCache(Component* component = nullptr)
+    engine->RegisterObjectMethod(className, "void ClearGeometryCache(Component@+ = null)", AS_METHODPR(T, ClearGeometryCache, (Component*), void), AS_CALL_THISCALL);
+
+    // void NavigationMesh::ClearPathGraph()
+    engine->RegisterObjectMethod(className, "void ClearPathGraph()", AS_METHODPR(T, ClearPathGraph, (), void), AS_CALL_THISCALL);
+
+    // void NavigationMesh::CompleteAsyncBuild()
+    engine->RegisterObjectMethod(className, "void CompleteAsyncBuild()", AS_METHODPR(T, CompleteAsyncBuild, (), void), AS_CALL_THISCALL);
+
+    // void NavigationMesh::CompletePathRequests()
+    engine->RegisterObjectMethod(className, "void CompletePathRequests()", AS_METHODPR(T, CompletePathRequests, (), void), AS_CALL_THISCALL);
+
     // void NavigationMesh::DrawDebugGeometry(DebugRenderer* debug, bool depthTest) override
     engine->RegisterObjectMethod(className, "void DrawDebugGeometry(DebugRenderer@+, bool)", AS_METHODPR(T, DrawDebugGeometry, (DebugRenderer*, bool), void), AS_CALL_THISCALL);
 
@@ -19795,6 +21338,10 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     // float NavigationMesh::GetAreaCost(unsigned areaID) const
     engine->RegisterObjectMethod(className, "float GetAreaCost(uint) const", AS_METHODPR(T, GetAreaCost, (unsigned) const, float), AS_CALL_THISCALL);
 
+    // float NavigationMesh::GetAsyncBuildTimeBudget() const
+    engine->RegisterObjectMethod(className, "float GetAsyncBuildTimeBudget() const", AS_METHODPR(T, GetAsyncBuildTimeBudget, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_asyncBuildTimeBudget() const", AS_METHODPR(T, GetAsyncBuildTimeBudget, () const, float), AS_CALL_THISCALL);
+
     // const BoundingBox& NavigationMesh::GetBoundingBox() const
     engine->RegisterObjectMethod(className, "const BoundingBox& GetBoundingBox() const", AS_METHODPR(T, GetBoundingBox, () const, const BoundingBox&), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "const BoundingBox& get_boundingBox() const", AS_METHODPR(T, GetBoundingBox, () const, const BoundingBox&), AS_CALL_THISCALL);
@@ -19831,9 +21378,33 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "float GetEdgeMaxLength() const", AS_METHODPR(T, GetEdgeMaxLength, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_edgeMaxLength() const", AS_METHODPR(T, GetEdgeMaxLength, () const, float), AS_CALL_THISCALL);
 
+    // float NavigationMesh::GetHierarchicalPathDistance() const
+    engine->RegisterObjectMethod(className, "float GetHierarchicalPathDistance() const", AS_METHODPR(T, GetHierarchicalPathDistance, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_hierarchicalPathDistance() const", AS_METHODPR(T, GetHierarchicalPathDistance, () const, float), AS_CALL_THISCALL);
+
+    // bool NavigationMesh::GetHierarchicalPathfinding() const
+    engine->RegisterObjectMethod(className, "bool GetHierarchicalPathfinding() const", AS_METHODPR(T, GetHierarchicalPathfinding, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_hierarchicalPathfinding() const", AS_METHODPR(T, GetHierarchicalPathfinding, () const, bool), AS_CALL_THISCALL);
+
     // String NavigationMesh::GetMeshName() const
     engine->RegisterObjectMethod(className, "String GetMeshName() const", AS_METHODPR(T, GetMeshName, () const, String), AS_CALL_THISCALL);
 
+    // unsigned NavigationMesh::GetNumPendingPathRequests() const
+    engine->RegisterObjectMethod(className, "uint GetNumPendingPathRequests() const", AS_METHODPR(T, GetNumPendingPathRequests, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numPendingPathRequests() const", AS_METHODPR(T, GetNumPendingPathRequests, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned NavigationMesh::GetNumPendingTileLoads() const
+    engine->RegisterObjectMethod(className, "uint GetNumPendingTileLoads() const", AS_METHODPR(T, GetNumPendingTileLoads, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numPendingTileLoads() const", AS_METHODPR(T, GetNumPendingTileLoads, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned NavigationMesh::GetNumPendingTiles() const
+    engine->RegisterObjectMethod(className, "uint GetNumPendingTiles() const", AS_METHODPR(T, GetNumPendingTiles, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numPendingTiles() const", AS_METHODPR(T, GetNumPendingTiles, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned NavigationMesh::GetNumStreamedTiles() const
+    engine->RegisterObjectMethod(className, "uint GetNumStreamedTiles() const", AS_METHODPR(T, GetNumStreamedTiles, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numStreamedTiles() const", AS_METHODPR(T, GetNumStreamedTiles, () const, unsigned), AS_CALL_THISCALL);
+
     // IntVector2 NavigationMesh::GetNumTiles() const
     engine->RegisterObjectMethod(className, "IntVector2 GetNumTiles() const", AS_METHODPR(T, GetNumTiles, () const, IntVector2), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "IntVector2 get_numTiles() const", AS_METHODPR(T, GetNumTiles, () const, IntVector2), AS_CALL_THISCALL);
@@ -19846,6 +21417,10 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "NavmeshPartitionType GetPartitionType() const", AS_METHODPR(T, GetPartitionType, () const, NavmeshPartitionType), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "NavmeshPartitionType get_partitionType() const", AS_METHODPR(T, GetPartitionType, () const, NavmeshPartitionType), AS_CALL_THISCALL);
 
+    // unsigned NavigationMesh::GetPathIterationBudget() const
+    engine->RegisterObjectMethod(className, "uint GetPathIterationBudget() const", AS_METHODPR(T, GetPathIterationBudget, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_pathIterationBudget() const", AS_METHODPR(T, GetPathIterationBudget, () const, unsigned), AS_CALL_THISCALL);
+
     // float NavigationMesh::GetRegionMergeSize() const
     engine->RegisterObjectMethod(className, "float GetRegionMergeSize() const", AS_METHODPR(T, GetRegionMergeSize, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_regionMergeSize() const", AS_METHODPR(T, GetRegionMergeSize, () const, float), AS_CALL_THISCALL);
@@ -19854,6 +21429,21 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "float GetRegionMinSize() const", AS_METHODPR(T, GetRegionMinSize, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_regionMinSize() const", AS_METHODPR(T, GetRegionMinSize, () const, float), AS_CALL_THISCALL);
 
+    // String NavigationMesh::GetStreamedTileName(const IntVector2& tile) const
+    engine->RegisterObjectMethod(className, "String GetStreamedTileName(const IntVector2&in) const", AS_METHODPR(T, GetStreamedTileName, (const IntVector2&) const, String), AS_CALL_THISCALL);
+
+    // unsigned NavigationMesh::GetStreamingMemoryBudget() const
+    engine->RegisterObjectMethod(className, "uint GetStreamingMemoryBudget() const", AS_METHODPR(T, GetStreamingMemoryBudget, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_streamingMemoryBudget() const", AS_METHODPR(T, GetStreamingMemoryBudget, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned NavigationMesh::GetStreamingMemoryUse() const
+    engine->RegisterObjectMethod(className, "uint GetStreamingMemoryUse() const", AS_METHODPR(T, GetStreamingMemoryUse, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_streamingMemoryUse() const", AS_METHODPR(T, GetStreamingMemoryUse, () const, unsigned), AS_CALL_THISCALL);
+
+    // float NavigationMesh::GetStreamingRadius() const
+    engine->RegisterObjectMethod(className, "float GetStreamingRadius() const", AS_METHODPR(T, GetStreamingRadius, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_streamingRadius() const", AS_METHODPR(T, GetStreamingRadius, () const, float), AS_CALL_THISCALL);
+
     // BoundingBox NavigationMesh::GetTileBoundingBox(const IntVector2& tile) const
     engine->RegisterObjectMethod(className, "BoundingBox GetTileBoundingBox(const IntVector2&in) const", AS_METHODPR(T, GetTileBoundingBox, (const IntVector2&) const, BoundingBox), AS_CALL_THISCALL);
 
@@ -19864,6 +21454,14 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "int GetTileSize() const", AS_METHODPR(T, GetTileSize, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_tileSize() const", AS_METHODPR(T, GetTileSize, () const, int), AS_CALL_THISCALL);
 
+    // bool NavigationMesh::GetTileStreaming() const
+    engine->RegisterObjectMethod(className, "bool GetTileStreaming() const", AS_METHODPR(T, GetTileStreaming, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_tileStreaming() const", AS_METHODPR(T, GetTileStreaming, () const, bool), AS_CALL_THISCALL);
+
+    // const String& NavigationMesh::GetTileStreamPath() const
+    engine->RegisterObjectMethod(className, "const String& GetTileStreamPath() const", AS_METHODPR(T, GetTileStreamPath, () const, const String&), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "const String& get_tileStreamPath() const", AS_METHODPR(T, GetTileStreamPath, () const, const String&), AS_CALL_THISCALL);
+
     // BoundingBox NavigationMesh::GetWorldBoundingBox() const
     engine->RegisterObjectMethod(className, "BoundingBox GetWorldBoundingBox() const", AS_METHODPR(T, GetWorldBoundingBox, () const, BoundingBox), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "BoundingBox get_worldBoundingBox() const", AS_METHODPR(T, GetWorldBoundingBox, () const, BoundingBox), AS_CALL_THISCALL);
@@ -19871,6 +21469,10 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     // bool NavigationMesh::HasTile(const IntVector2& tile) const
     engine->RegisterObjectMethod(className, "bool HasTile(const IntVector2&in) const", AS_METHODPR(T, HasTile, (const IntVector2&) const, bool), AS_CALL_THISCALL);
 
+    // bool NavigationMesh::IsBuildingAsync() const
+    engine->RegisterObjectMethod(className, "bool IsBuildingAsync() const", AS_METHODPR(T, IsBuildingAsync, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_buildingAsync() const", AS_METHODPR(T, IsBuildingAsync, () const, bool), AS_CALL_THISCALL);
+
     // bool NavigationMesh::IsInitialized() const
     engine->RegisterObjectMethod(className, "bool IsInitialized() const", AS_METHODPR(T, IsInitialized, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_initialized() const", AS_METHODPR(T, IsInitialized, () const, bool), AS_CALL_THISCALL);
@@ -19878,12 +21480,21 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     // virtual void Component::OnSetEnabled()
     engine->RegisterObjectMethod(className, "void OnSetEnabled()", AS_METHODPR(T, OnSetEnabled, (), void), AS_CALL_THISCALL);
 
+    // void NavigationMesh::RemoveAllStreamingPoints()
+    engine->RegisterObjectMethod(className, "void RemoveAllStreamingPoints()", AS_METHODPR(T, RemoveAllStreamingPoints, (), void), AS_CALL_THISCALL);
+
     // virtual void NavigationMesh::RemoveAllTiles()
     engine->RegisterObjectMethod(className, "void RemoveAllTiles()", AS_METHODPR(T, RemoveAllTiles, (), void), AS_CALL_THISCALL);
 
+    // void NavigationMesh::RemoveStreamingPoint(Node* node)
+    engine->RegisterObjectMethod(className, "void RemoveStreamingPoint(Node@+)", AS_METHODPR(T, RemoveStreamingPoint, (Node*), void), AS_CALL_THISCALL);
+
     // virtual void NavigationMesh::RemoveTile(const IntVector2& tile)
     engine->RegisterObjectMethod(className, "void RemoveTile(const IntVector2&in)", AS_METHODPR(T, RemoveTile, (const IntVector2&), void), AS_CALL_THISCALL);
 
+    // bool NavigationMesh::SaveStreamedTiles(const String& directory) const
+    engine->RegisterObjectMethod(className, "bool SaveStreamedTiles(const String&in) const", AS_METHODPR(T, SaveStreamedTiles, (const String&) const, bool), AS_CALL_THISCALL);
+
     // void NavigationMesh::SetAgentHeight(float height)
     engine->RegisterObjectMethod(className, "void SetAgentHeight(float)", AS_METHODPR(T, SetAgentHeight, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_agentHeight(float)", AS_METHODPR(T, SetAgentHeight, (float), void), AS_CALL_THISCALL);
@@ -19903,6 +21514,10 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     // void NavigationMesh::SetAreaCost(unsigned areaID, float cost)
     engine->RegisterObjectMethod(className, "void SetAreaCost(uint, float)", AS_METHODPR(T, SetAreaCost, (unsigned, float), void), AS_CALL_THISCALL);
 
+    // void NavigationMesh::SetAsyncBuildTimeBudget(float ms)
+    engine->RegisterObjectMethod(className, "void SetAsyncBuildTimeBudget(float)", AS_METHODPR(T, SetAsyncBuildTimeBudget, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_asyncBuildTimeBudget(float)", AS_METHODPR(T, SetAsyncBuildTimeBudget, (float), void), AS_CALL_THISCALL);
+
     // void NavigationMesh::SetCellHeight(float height)
     engine->RegisterObjectMethod(className, "void SetCellHeight(float)", AS_METHODPR(T, SetCellHeight, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_cellHeight(float)", AS_METHODPR(T, SetCellHeight, (float), void), AS_CALL_THISCALL);
@@ -19935,6 +21550,14 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "void SetEdgeMaxLength(float)", AS_METHODPR(T, SetEdgeMaxLength, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_edgeMaxLength(float)", AS_METHODPR(T, SetEdgeMaxLength, (float), void), AS_CALL_THISCALL);
 
+    // void NavigationMesh::SetHierarchicalPathDistance(float distance)
+    engine->RegisterObjectMethod(className, "void SetHierarchicalPathDistance(float)", AS_METHODPR(T, SetHierarchicalPathDistance, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_hierarchicalPathDistance(float)", AS_METHODPR(T, SetHierarchicalPathDistance, (float), void), AS_CALL_THISCALL);
+
+    // void NavigationMesh::SetHierarchicalPathfinding(bool enable)
+    engine->RegisterObjectMethod(className, "void SetHierarchicalPathfinding(bool)", AS_METHODPR(T, SetHierarchicalPathfinding, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_hierarchicalPathfinding(bool)", AS_METHODPR(T, SetHierarchicalPathfinding, (bool), void), AS_CALL_THISCALL);
+
     // void NavigationMesh::SetMeshName(const String& newName)
     engine->RegisterObjectMethod(className, "void SetMeshName(const String&in)", AS_METHODPR(T, SetMeshName, (const String&), void), AS_CALL_THISCALL);
 
@@ -19946,6 +21569,10 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "void SetPartitionType(NavmeshPartitionType)", AS_METHODPR(T, SetPartitionType, (NavmeshPartitionType), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_partitionType(NavmeshPartitionType)", AS_METHODPR(T, SetPartitionType, (NavmeshPartitionType), void), AS_CALL_THISCALL);
 
+    // void NavigationMesh::SetPathIterationBudget(unsigned iterations)
+    engine->RegisterObjectMethod(className, "void SetPathIterationBudget(uint)", AS_METHODPR(T, SetPathIterationBudget, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_pathIterationBudget(uint)", AS_METHODPR(T, SetPathIterationBudget, (unsigned), void), AS_CALL_THISCALL);
+
     // void NavigationMesh::SetRegionMergeSize(float size)
     engine->RegisterObjectMethod(className, "void SetRegionMergeSize(float)", AS_METHODPR(T, SetRegionMergeSize, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_regionMergeSize(float)", AS_METHODPR(T, SetRegionMergeSize, (float), void), AS_CALL_THISCALL);
@@ -19954,10 +21581,29 @@ template <class T> void RegisterMembers_NavigationMesh(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "void SetRegionMinSize(float)", AS_METHODPR(T, SetRegionMinSize, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_regionMinSize(float)", AS_METHODPR(T, SetRegionMinSize, (float), void), AS_CALL_THISCALL);
 
+    // void NavigationMesh::SetStreamingMemoryBudget(unsigned bytes)
+    engine->RegisterObjectMethod(className, "void SetStreamingMemoryBudget(uint)", AS_METHODPR(T, SetStreamingMemoryBudget, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_streamingMemoryBudget(uint)", AS_METHODPR(T, SetStreamingMemoryBudget, (unsigned), void), AS_CALL_THISCALL);
+
+    // void NavigationMesh::SetStreamingRadius(float radius)
+    engine->RegisterObjectMethod(className, "void SetStreamingRadius(float)", AS_METHODPR(T, SetStreamingRadius, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_streamingRadius(float)", AS_METHODPR(T, SetStreamingRadius, (float), void), AS_CALL_THISCALL);
+
     // void NavigationMesh::SetTileSize(int size)
     engine->RegisterObjectMethod(className, "void SetTileSize(int)", AS_METHODPR(T, SetTileSize, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_tileSize(int)", AS_METHODPR(T, SetTileSize, (int), void), AS_CALL_THISCALL);
 
+    // void NavigationMesh::SetTileStreaming(bool enable)
+    engine->RegisterObjectMethod(className, "void SetTileStreaming(bool)", AS_METHODPR(T, SetTileStreaming, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_tileStreaming(bool)", AS_METHODPR(T, SetTileStreaming, (bool), void), AS_CALL_THISCALL);
+
+    // void NavigationMesh::SetTileStreamPath(const String& path)
+    engine->RegisterObjectMethod(className, "void SetTileStreamPath(const String&in)", AS_METHODPR(T, SetTileStreamPath, (const String&), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_tileStreamPath(const String&in)", AS_METHODPR(T, SetTileStreamPath, (const String&), void), AS_CALL_THISCALL);
+
+    // void NavigationMesh::UnloadStreamedTiles()
+    engine->RegisterObjectMethod(className, "void UnloadStreamedTiles()", AS_METHODPR(T, UnloadStreamedTiles, (), void), AS_CALL_THISCALL);
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_NavigationMesh
         REGISTER_MEMBERS_MANUAL_PART_NavigationMesh();
     #endif
@@ -20405,12 +22051,20 @@ template <class T> void RegisterMembers_PhysicsWorld(asIScriptEngine* engine, co
     // Error: type "const btVector3&" can not automatically bind
     // void PhysicsWorld::drawLine(const btVector3& from, const btVector3& to, const btVector3& color) override
     // Error: type "const btVector3&" can not automatically bind
+    // void PhysicsWorld::ExecuteQueries(PhysicsQueryBatch* batch)
+    // Error: type "PhysicsQueryBatch*" can not automatically bind
     // void PhysicsWorld::GetCollidingBodies(PODVector<RigidBody*>& result, const RigidBody* body)
     // Error: type "PODVector<RigidBody*>&" can not automatically bind
+    // const PODVector<PhysicsContactPair>& PhysicsWorld::GetContactPairs() const
+    // Error: type "const PODVector<PhysicsContactPair>&" can not automatically bind
+    // const PODVector<PhysicsContactPoint>& PhysicsWorld::GetContactPoints() const
+    // Error: type "const PODVector<PhysicsContactPoint>&" can not automatically bind
     // CollisionGeometryDataCache& PhysicsWorld::GetConvexCache()
     // Error: type "CollisionGeometryDataCache&" can not automatically bind
     // CollisionGeometryDataCache& PhysicsWorld::GetGImpactTrimeshCache()
     // Error: type "CollisionGeometryDataCache&" can not automatically bind
+    // PrimitiveShapeCache& PhysicsWorld::GetPrimitiveShapeCache()
+    // Error: type "PrimitiveShapeCache&" can not automatically bind
     // void PhysicsWorld::GetRigidBodies(PODVector<RigidBody*>& result, const Sphere& sphere, unsigned collisionMask = M_MAX_UNSIGNED)
     // Error: type "PODVector<RigidBody*>&" can not automatically bind
     // void PhysicsWorld::GetRigidBodies(PODVector<RigidBody*>& result, const BoundingBox& box, unsigned collisionMask = M_MAX_UNSIGNED)
@@ -20427,6 +22081,8 @@ template <class T> void RegisterMembers_PhysicsWorld(asIScriptEngine* engine, co
     // Error: type "PODVector<PhysicsRaycastResult>&" can not automatically bind
     // void PhysicsWorld::reportErrorWarning(const char* warningString) override
     // Error: type "const char*" can not automatically bind
+    // void PhysicsWorld::SubmitQueries(PhysicsQueryBatch* batch)
+    // Error: type "PhysicsQueryBatch*" can not automatically bind
 
     // void PhysicsWorld::AddCollisionShape(CollisionShape* shape)
     engine->RegisterObjectMethod(className, "void AddCollisionShape(CollisionShape@+)", AS_METHODPR(T, AddCollisionShape, (CollisionShape*), void), AS_CALL_THISCALL);
@@ -20437,12 +22093,27 @@ template <class T> void RegisterMembers_PhysicsWorld(asIScriptEngine* engine, co
     // void PhysicsWorld::AddDelayedWorldTransform(const DelayedWorldTransform& transform)
     engine->RegisterObjectMethod(className, "void AddDelayedWorldTransform(const DelayedWorldTransform&in)", AS_METHODPR(T, AddDelayedWorldTransform, (const DelayedWorldTransform&), void), AS_CALL_THISCALL);
 
+    // void PhysicsWorld::AddInterpolatedBody(RigidBody* body)
+    engine->RegisterObjectMethod(className, "void AddInterpolatedBody(RigidBody@+)", AS_METHODPR(T, AddInterpolatedBody, (RigidBody*), void), AS_CALL_THISCALL);
+
+    // void PhysicsWorld::AddRaycastVehicle(RaycastVehicle* vehicle)
+    engine->RegisterObjectMethod(className, "void AddRaycastVehicle(RaycastVehicle@+)", AS_METHODPR(T, AddRaycastVehicle, (RaycastVehicle*), void), AS_CALL_THISCALL);
+
     // void PhysicsWorld::AddRigidBody(RigidBody* body)
     engine->RegisterObjectMethod(className, "void AddRigidBody(RigidBody@+)", AS_METHODPR(T, AddRigidBody, (RigidBody*), void), AS_CALL_THISCALL);
 
+    // void PhysicsWorld::BuildStaticCompounds(float cellSize)
+    engine->RegisterObjectMethod(className, "void BuildStaticCompounds(float)", AS_METHODPR(T, BuildStaticCompounds, (float), void), AS_CALL_THISCALL);
+
+    // void PhysicsWorld::ClearStaticCompounds()
+    engine->RegisterObjectMethod(className, "void ClearStaticCompounds()", AS_METHODPR(T, ClearStaticCompounds, (), void), AS_CALL_THISCALL);
+
     // void PhysicsWorld::CleanupGeometryCache()
     engine->RegisterObjectMethod(className, "void CleanupGeometryCache()", AS_METHODPR(T, CleanupGeometryCache, (), void), AS_CALL_THISCALL);
 
+    // void PhysicsWorld::CompleteQueries()
+    engine->RegisterObjectMethod(className, "void CompleteQueries()", AS_METHODPR(T, CompleteQueries, (), void), AS_CALL_THISCALL);
+
     // void PhysicsWorld::ConvexCast(PhysicsRaycastResult& result, CollisionShape* shape, const Vector3& startPos, const Quaternion& startRot, const Vector3& endPos, const Quaternion& endRot, unsigned collisionMask = M_MAX_UNSIGNED)
     engine->RegisterObjectMethod(className, "void ConvexCast(PhysicsRaycastResult&, CollisionShape@+, const Vector3&in, const Quaternion&in, const Vector3&in, const Quaternion&in, uint = M_MAX_UNSIGNED)", AS_METHODPR(T, ConvexCast, (PhysicsRaycastResult&, CollisionShape*, const Vector3&, const Quaternion&, const Vector3&, const Quaternion&, unsigned), void), AS_CALL_THISCALL);
 
@@ -20478,20 +22149,73 @@ template <class T> void RegisterMembers_PhysicsWorld(asIScriptEngine* engine, co
     engine->RegisterObjectMethod(className, "int GetMaxSubSteps() const", AS_METHODPR(T, GetMaxSubSteps, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_maxSubSteps() const", AS_METHODPR(T, GetMaxSubSteps, () const, int), AS_CALL_THISCALL);
 
+    // bool PhysicsWorld::GetMultithreaded() const
+    engine->RegisterObjectMethod(className, "bool GetMultithreaded() const", AS_METHODPR(T, GetMultithreaded, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_multithreaded() const", AS_METHODPR(T, GetMultithreaded, () const, bool), AS_CALL_THISCALL);
+
     // int PhysicsWorld::GetNumIterations() const
     engine->RegisterObjectMethod(className, "int GetNumIterations() const", AS_METHODPR(T, GetNumIterations, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_numIterations() const", AS_METHODPR(T, GetNumIterations, () const, int), AS_CALL_THISCALL);
 
+    // unsigned PhysicsWorld::GetNumStaticCompounds() const
+    engine->RegisterObjectMethod(className, "uint GetNumStaticCompounds() const", AS_METHODPR(T, GetNumStaticCompounds, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numStaticCompounds() const", AS_METHODPR(T, GetNumStaticCompounds, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned PhysicsWorld::GetNumStreamedOutBodies() const
+    engine->RegisterObjectMethod(className, "uint GetNumStreamedOutBodies() const", AS_METHODPR(T, GetNumStreamedOutBodies, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numStreamedOutBodies() const", AS_METHODPR(T, GetNumStreamedOutBodies, () const, unsigned), AS_CALL_THISCALL);
+
+    // bool PhysicsWorld::GetSaveGeometryCache() const
+    engine->RegisterObjectMethod(className, "bool GetSaveGeometryCache() const", AS_METHODPR(T, GetSaveGeometryCache, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_saveGeometryCache() const", AS_METHODPR(T, GetSaveGeometryCache, () const, bool), AS_CALL_THISCALL);
+
+    // bool PhysicsWorld::GetSnapshotInterpolation() const
+    engine->RegisterObjectMethod(className, "bool GetSnapshotInterpolation() const", AS_METHODPR(T, GetSnapshotInterpolation, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_snapshotInterpolation() const", AS_METHODPR(T, GetSnapshotInterpolation, () const, bool), AS_CALL_THISCALL);
+
+    // unsigned PhysicsWorld::GetSnapshotStep() const
+    engine->RegisterObjectMethod(className, "uint GetSnapshotStep() const", AS_METHODPR(T, GetSnapshotStep, () const, unsigned), AS_CALL_THISCALL);
+
     // bool PhysicsWorld::GetSplitImpulse() const
     engine->RegisterObjectMethod(className, "bool GetSplitImpulse() const", AS_METHODPR(T, GetSplitImpulse, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_splitImpulse() const", AS_METHODPR(T, GetSplitImpulse, () const, bool), AS_CALL_THISCALL);
 
+    // const PhysicsStatistics& PhysicsWorld::GetStatistics() const
+    engine->RegisterObjectMethod(className, "const PhysicsStatistics& GetStatistics() const", AS_METHODPR(T, GetStatistics, () const, const PhysicsStatistics&), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "const PhysicsStatistics& get_statistics() const", AS_METHODPR(T, GetStatistics, () const, const PhysicsStatistics&), AS_CALL_THISCALL);
+
+    // float PhysicsWorld::GetStreamInDistance() const
+    engine->RegisterObjectMethod(className, "float GetStreamInDistance() const", AS_METHODPR(T, GetStreamInDistance, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_streamInDistance() const", AS_METHODPR(T, GetStreamInDistance, () const, float), AS_CALL_THISCALL);
+
+    // float PhysicsWorld::GetStreamOutDistance() const
+    engine->RegisterObjectMethod(className, "float GetStreamOutDistance() const", AS_METHODPR(T, GetStreamOutDistance, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_streamOutDistance() const", AS_METHODPR(T, GetStreamOutDistance, () const, float), AS_CALL_THISCALL);
+
+    // Vector3 PhysicsWorld::GetStreamingFocus() const
+    engine->RegisterObjectMethod(className, "Vector3 GetStreamingFocus() const", AS_METHODPR(T, GetStreamingFocus, () const, Vector3), AS_CALL_THISCALL);
+
+    // Node* PhysicsWorld::GetStreamingFocusNode() const
+    engine->RegisterObjectMethod(className, "Node@+ GetStreamingFocusNode() const", AS_METHODPR(T, GetStreamingFocusNode, () const, Node*), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "Node@+ get_streamingFocusNode() const", AS_METHODPR(T, GetStreamingFocusNode, () const, Node*), AS_CALL_THISCALL);
+
+    // const Vector3& PhysicsWorld::GetStreamingFocusPosition() const
+    engine->RegisterObjectMethod(className, "const Vector3& GetStreamingFocusPosition() const", AS_METHODPR(T, GetStreamingFocusPosition, () const, const Vector3&), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "const Vector3& get_streamingFocusPosition() const", AS_METHODPR(T, GetStreamingFocusPosition, () const, const Vector3&), AS_CALL_THISCALL);
+
     // bool PhysicsWorld::IsApplyingTransforms() const
     engine->RegisterObjectMethod(className, "bool IsApplyingTransforms() const", AS_METHODPR(T, IsApplyingTransforms, () const, bool), AS_CALL_THISCALL);
 
     // bool PhysicsWorld::IsSimulating() const
     engine->RegisterObjectMethod(className, "bool IsSimulating() const", AS_METHODPR(T, IsSimulating, () const, bool), AS_CALL_THISCALL);
 
+    // bool PhysicsWorld::IsSnapshotInterpolating() const
+    engine->RegisterObjectMethod(className, "bool IsSnapshotInterpolating() const", AS_METHODPR(T, IsSnapshotInterpolating, () const, bool), AS_CALL_THISCALL);
+
+    // bool PhysicsWorld::IsStatisticsEnabled() const
+    engine->RegisterObjectMethod(className, "bool IsStatisticsEnabled() const", AS_METHODPR(T, IsStatisticsEnabled, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_statisticsEnabled() const", AS_METHODPR(T, IsStatisticsEnabled, () const, bool), AS_CALL_THISCALL);
+
     // bool PhysicsWorld::IsUpdateEnabled() const
     engine->RegisterObjectMethod(className, "bool IsUpdateEnabled() const", AS_METHODPR(T, IsUpdateEnabled, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_updateEnabled() const", AS_METHODPR(T, IsUpdateEnabled, () const, bool), AS_CALL_THISCALL);
@@ -20514,9 +22238,18 @@ template <class T> void RegisterMembers_PhysicsWorld(asIScriptEngine* engine, co
     // void PhysicsWorld::RemoveConstraint(Constraint* constraint)
     engine->RegisterObjectMethod(className, "void RemoveConstraint(Constraint@+)", AS_METHODPR(T, RemoveConstraint, (Constraint*), void), AS_CALL_THISCALL);
 
+    // void PhysicsWorld::RemoveRaycastVehicle(RaycastVehicle* vehicle)
+    engine->RegisterObjectMethod(className, "void RemoveRaycastVehicle(RaycastVehicle@+)", AS_METHODPR(T, RemoveRaycastVehicle, (RaycastVehicle*), void), AS_CALL_THISCALL);
+
     // void PhysicsWorld::RemoveRigidBody(RigidBody* body)
     engine->RegisterObjectMethod(className, "void RemoveRigidBody(RigidBody@+)", AS_METHODPR(T, RemoveRigidBody, (RigidBody*), void), AS_CALL_THISCALL);
 
+    // void PhysicsWorld::RemoveStaticCompoundBody(RigidBody* body)
+    engine->RegisterObjectMethod(className, "void RemoveStaticCompoundBody(RigidBody@+)", AS_METHODPR(T, RemoveStaticCompoundBody, (RigidBody*), void), AS_CALL_THISCALL);
+
+    // void PhysicsWorld::RemoveStreamedOutBody(RigidBody* body)
+    engine->RegisterObjectMethod(className, "void RemoveStreamedOutBody(RigidBody@+)", AS_METHODPR(T, RemoveStreamedOutBody, (RigidBody*), void), AS_CALL_THISCALL);
+
     // void PhysicsWorld::SetApplyingTransforms(bool enable)
     engine->RegisterObjectMethod(className, "void SetApplyingTransforms(bool)", AS_METHODPR(T, SetApplyingTransforms, (bool), void), AS_CALL_THISCALL);
 
@@ -20552,14 +22285,46 @@ template <class T> void RegisterMembers_PhysicsWorld(asIScriptEngine* engine, co
     engine->RegisterObjectMethod(className, "void SetMaxSubSteps(int)", AS_METHODPR(T, SetMaxSubSteps, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_maxSubSteps(int)", AS_METHODPR(T, SetMaxSubSteps, (int), void), AS_CALL_THISCALL);
 
+    // void PhysicsWorld::SetMultithreaded(bool enable)
+    engine->RegisterObjectMethod(className, "void SetMultithreaded(bool)", AS_METHODPR(T, SetMultithreaded, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_multithreaded(bool)", AS_METHODPR(T, SetMultithreaded, (bool), void), AS_CALL_THISCALL);
+
     // void PhysicsWorld::SetNumIterations(int num)
     engine->RegisterObjectMethod(className, "void SetNumIterations(int)", AS_METHODPR(T, SetNumIterations, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_numIterations(int)", AS_METHODPR(T, SetNumIterations, (int), void), AS_CALL_THISCALL);
 
+    // void PhysicsWorld::SetSaveGeometryCache(bool enable)
+    engine->RegisterObjectMethod(className, "void SetSaveGeometryCache(bool)", AS_METHODPR(T, SetSaveGeometryCache, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_saveGeometryCache(bool)", AS_METHODPR(T, SetSaveGeometryCache, (bool), void), AS_CALL_THISCALL);
+
+    // void PhysicsWorld::SetSnapshotInterpolation(bool enable)
+    engine->RegisterObjectMethod(className, "void SetSnapshotInterpolation(bool)", AS_METHODPR(T, SetSnapshotInterpolation, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_snapshotInterpolation(bool)", AS_METHODPR(T, SetSnapshotInterpolation, (bool), void), AS_CALL_THISCALL);
+
     // void PhysicsWorld::SetSplitImpulse(bool enable)
     engine->RegisterObjectMethod(className, "void SetSplitImpulse(bool)", AS_METHODPR(T, SetSplitImpulse, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_splitImpulse(bool)", AS_METHODPR(T, SetSplitImpulse, (bool), void), AS_CALL_THISCALL);
 
+    // void PhysicsWorld::SetStatisticsEnabled(bool enable)
+    engine->RegisterObjectMethod(className, "void SetStatisticsEnabled(bool)", AS_METHODPR(T, SetStatisticsEnabled, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_statisticsEnabled(bool)", AS_METHODPR(T, SetStatisticsEnabled, (bool), void), AS_CALL_THISCALL);
+
+    // void PhysicsWorld::SetStreamInDistance(float distance)
+    engine->RegisterObjectMethod(className, "void SetStreamInDistance(float)", AS_METHODPR(T, SetStreamInDistance, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_streamInDistance(float)", AS_METHODPR(T, SetStreamInDistance, (float), void), AS_CALL_THISCALL);
+
+    // void PhysicsWorld::SetStreamOutDistance(float distance)
+    engine->RegisterObjectMethod(className, "void SetStreamOutDistance(float)", AS_METHODPR(T, SetStreamOutDistance, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_streamOutDistance(float)", AS_METHODPR(T, SetStreamOutDistance, (float), void), AS_CALL_THISCALL);
+
+    // void PhysicsWorld::SetStreamingFocusNode(Node* node)
+    engine->RegisterObjectMethod(className, "void SetStreamingFocusNode(Node@+)", AS_METHODPR(T, SetStreamingFocusNode, (Node*), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_streamingFocusNode(Node@+)", AS_METHODPR(T, SetStreamingFocusNode, (Node*), void), AS_CALL_THISCALL);
+
+    // void PhysicsWorld::SetStreamingFocusPosition(const Vector3& position)
+    engine->RegisterObjectMethod(className, "void SetStreamingFocusPosition(const Vector3&in)", AS_METHODPR(T, SetStreamingFocusPosition, (const Vector3&), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_streamingFocusPosition(const Vector3&in)", AS_METHODPR(T, SetStreamingFocusPosition, (const Vector3&), void), AS_CALL_THISCALL);
+
     // void PhysicsWorld::SetUpdateEnabled(bool enable)
     engine->RegisterObjectMethod(className, "void SetUpdateEnabled(bool)", AS_METHODPR(T, SetUpdateEnabled, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_updateEnabled(bool)", AS_METHODPR(T, SetUpdateEnabled, (bool), void), AS_CALL_THISCALL);
@@ -20567,6 +22332,12 @@ template <class T> void RegisterMembers_PhysicsWorld(asIScriptEngine* engine, co
     // void PhysicsWorld::SphereCast(PhysicsRaycastResult& result, const Ray& ray, float radius, float maxDistance, unsigned collisionMask = M_MAX_UNSIGNED)
     engine->RegisterObjectMethod(className, "void SphereCast(PhysicsRaycastResult&, const Ray&in, float, float, uint = M_MAX_UNSIGNED)", AS_METHODPR(T, SphereCast, (PhysicsRaycastResult&, const Ray&, float, float, unsigned), void), AS_CALL_THISCALL);
 
+    // void PhysicsWorld::StreamInAllBodies()
+    engine->RegisterObjectMethod(className, "void StreamInAllBodies()", AS_METHODPR(T, StreamInAllBodies, (), void), AS_CALL_THISCALL);
+
+    // void PhysicsWorld::StreamInBody(RigidBody* body)
+    engine->RegisterObjectMethod(className, "void StreamInBody(RigidBody@+)", AS_METHODPR(T, StreamInBody, (RigidBody*), void), AS_CALL_THISCALL);
+
     // void PhysicsWorld::Update(float timeStep)
     engine->RegisterObjectMethod(className, "void Update(float)", AS_METHODPR(T, Update, (float), void), AS_CALL_THISCALL);
 
@@ -20619,6 +22390,9 @@ template <class T> void RegisterMembers_RigidBody(asIScriptEngine* engine, const
     // void RigidBody::ApplyImpulse(const Vector3& impulse, const Vector3& position)
     engine->RegisterObjectMethod(className, "void ApplyImpulse(const Vector3&in, const Vector3&in)", AS_METHODPR(T, ApplyImpulse, (const Vector3&, const Vector3&), void), AS_CALL_THISCALL);
 
+    // bool RigidBody::ApplySnapshotInterpolation(float t, unsigned step)
+    engine->RegisterObjectMethod(className, "bool ApplySnapshotInterpolation(float, uint)", AS_METHODPR(T, ApplySnapshotInterpolation, (float, unsigned), bool), AS_CALL_THISCALL);
+
     // void RigidBody::ApplyTorque(const Vector3& torque)
     engine->RegisterObjectMethod(className, "void ApplyTorque(const Vector3&in)", AS_METHODPR(T, ApplyTorque, (const Vector3&), void), AS_CALL_THISCALL);
 
@@ -20628,6 +22402,12 @@ template <class T> void RegisterMembers_RigidBody(asIScriptEngine* engine, const
     // void RigidBody::ApplyWorldTransform(const Vector3& newWorldPosition, const Quaternion& newWorldRotation)
     engine->RegisterObjectMethod(className, "void ApplyWorldTransform(const Vector3&in, const Quaternion&in)", AS_METHODPR(T, ApplyWorldTransform, (const Vector3&, const Quaternion&), void), AS_CALL_THISCALL);
 
+    // bool RigidBody::CanMergeStatic() const
+    engine->RegisterObjectMethod(className, "bool CanMergeStatic() const", AS_METHODPR(T, CanMergeStatic, () const, bool), AS_CALL_THISCALL);
+
+    // bool RigidBody::CanStreamOut() const
+    engine->RegisterObjectMethod(className, "bool CanStreamOut() const", AS_METHODPR(T, CanStreamOut, () const, bool), AS_CALL_THISCALL);
+
     // void RigidBody::DisableMassUpdate()
     engine->RegisterObjectMethod(className, "void DisableMassUpdate()", AS_METHODPR(T, DisableMassUpdate, (), void), AS_CALL_THISCALL);
 
@@ -20720,6 +22500,10 @@ template <class T> void RegisterMembers_RigidBody(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "Vector3 GetPosition() const", AS_METHODPR(T, GetPosition, () const, Vector3), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "Vector3 get_position() const", AS_METHODPR(T, GetPosition, () const, Vector3), AS_CALL_THISCALL);
 
+    // bool RigidBody::GetReportContacts() const
+    engine->RegisterObjectMethod(className, "bool GetReportContacts() const", AS_METHODPR(T, GetReportContacts, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_reportContacts() const", AS_METHODPR(T, GetReportContacts, () const, bool), AS_CALL_THISCALL);
+
     // float RigidBody::GetRestitution() const
     engine->RegisterObjectMethod(className, "float GetRestitution() const", AS_METHODPR(T, GetRestitution, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_restitution() const", AS_METHODPR(T, GetRestitution, () const, float), AS_CALL_THISCALL);
@@ -20747,6 +22531,14 @@ template <class T> void RegisterMembers_RigidBody(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "bool IsKinematic() const", AS_METHODPR(T, IsKinematic, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_kinematic() const", AS_METHODPR(T, IsKinematic, () const, bool), AS_CALL_THISCALL);
 
+    // bool RigidBody::IsStaticMerged() const
+    engine->RegisterObjectMethod(className, "bool IsStaticMerged() const", AS_METHODPR(T, IsStaticMerged, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_staticMerged() const", AS_METHODPR(T, IsStaticMerged, () const, bool), AS_CALL_THISCALL);
+
+    // bool RigidBody::IsStreamedOut() const
+    engine->RegisterObjectMethod(className, "bool IsStreamedOut() const", AS_METHODPR(T, IsStreamedOut, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_streamedOut() const", AS_METHODPR(T, IsStreamedOut, () const, bool), AS_CALL_THISCALL);
+
     // bool RigidBody::IsTrigger() const
     engine->RegisterObjectMethod(className, "bool IsTrigger() const", AS_METHODPR(T, IsTrigger, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_trigger() const", AS_METHODPR(T, IsTrigger, () const, bool), AS_CALL_THISCALL);
@@ -20849,6 +22641,10 @@ template <class T> void RegisterMembers_RigidBody(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "void SetPosition(const Vector3&in)", AS_METHODPR(T, SetPosition, (const Vector3&), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_position(const Vector3&in)", AS_METHODPR(T, SetPosition, (const Vector3&), void), AS_CALL_THISCALL);
 
+    // void RigidBody::SetReportContacts(bool enable)
+    engine->RegisterObjectMethod(className, "void SetReportContacts(bool)", AS_METHODPR(T, SetReportContacts, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_reportContacts(bool)", AS_METHODPR(T, SetReportContacts, (bool), void), AS_CALL_THISCALL);
+
     // void RigidBody::SetRestitution(float restitution)
     engine->RegisterObjectMethod(className, "void SetRestitution(float)", AS_METHODPR(T, SetRestitution, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_restitution(float)", AS_METHODPR(T, SetRestitution, (float), void), AS_CALL_THISCALL);
@@ -20861,6 +22657,12 @@ template <class T> void RegisterMembers_RigidBody(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "void SetRotation(const Quaternion&in)", AS_METHODPR(T, SetRotation, (const Quaternion&), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_rotation(const Quaternion&in)", AS_METHODPR(T, SetRotation, (const Quaternion&), void), AS_CALL_THISCALL);
 
+    // void RigidBody::SetStaticMerged(bool enable)
+    engine->RegisterObjectMethod(className, "void SetStaticMerged(bool)", AS_METHODPR(T, SetStaticMerged, (bool), void), AS_CALL_THISCALL);
+
+    // void RigidBody::SetStreamedOut(bool enable)
+    engine->RegisterObjectMethod(className, "void SetStreamedOut(bool)", AS_METHODPR(T, SetStreamedOut, (bool), void), AS_CALL_THISCALL);
+
     // void RigidBody::SetTransform(const Vector3& position, const Quaternion& rotation)
     engine->RegisterObjectMethod(className, "void SetTransform(const Vector3&in, const Quaternion&in)", AS_METHODPR(T, SetTransform, (const Vector3&, const Quaternion&), void), AS_CALL_THISCALL);
 
@@ -21054,6 +22856,8 @@ template <class T> void RegisterMembers_PhysicsWorld2D(asIScriptEngine* engine,
     // Error: type "const b2Transform&" can not automatically bind
     // void PhysicsWorld2D::EndContact(b2Contact* contact) override
     // Error: type "b2Contact*" can not automatically bind
+    // void PhysicsWorld2D::ExecuteQueries(PhysicsQueryBatch2D* batch)
+    // Error: type "PhysicsQueryBatch2D*" can not automatically bind
     // void PhysicsWorld2D::GetRigidBodies(PODVector<RigidBody2D*>& results, const Rect& aabb, unsigned collisionMask = M_MAX_UNSIGNED)
     // Error: type "PODVector<RigidBody2D*>&" can not automatically bind
     // b2World* PhysicsWorld2D::GetWorld()
@@ -21062,6 +22866,8 @@ template <class T> void RegisterMembers_PhysicsWorld2D(asIScriptEngine* engine,
     // Error: type "b2Contact*" can not automatically bind
     // void PhysicsWorld2D::Raycast(PODVector<PhysicsRaycastResult2D>& results, const Vector2& startPoint, const Vector2& endPoint, unsigned collisionMask = M_MAX_UNSIGNED)
     // Error: type "PODVector<PhysicsRaycastResult2D>&" can not automatically bind
+    // void PhysicsWorld2D::SubmitQueries(PhysicsQueryBatch2D* batch)
+    // Error: type "PhysicsQueryBatch2D*" can not automatically bind
 
     // void PhysicsWorld2D::AddDelayedWorldTransform(const DelayedWorldTransform2D& transform)
     engine->RegisterObjectMethod(className, "void AddDelayedWorldTransform(const DelayedWorldTransform2D&in)", AS_METHODPR(T, AddDelayedWorldTransform, (const DelayedWorldTransform2D&), void), AS_CALL_THISCALL);
@@ -21069,6 +22875,9 @@ template <class T> void RegisterMembers_PhysicsWorld2D(asIScriptEngine* engine,
     // void PhysicsWorld2D::AddRigidBody(RigidBody2D* rigidBody)
     engine->RegisterObjectMethod(className, "void AddRigidBody(RigidBody2D@+)", AS_METHODPR(T, AddRigidBody, (RigidBody2D*), void), AS_CALL_THISCALL);
 
+    // void PhysicsWorld2D::CompleteQueries()
+    engine->RegisterObjectMethod(className, "void CompleteQueries()", AS_METHODPR(T, CompleteQueries, (), void), AS_CALL_THISCALL);
+
     // void PhysicsWorld2D::DrawDebugGeometry(DebugRenderer* debug, bool depthTest) override
     engine->RegisterObjectMethod(className, "void DrawDebugGeometry(DebugRenderer@+, bool)", AS_METHODPR(T, DrawDebugGeometry, (DebugRenderer*, bool), void), AS_CALL_THISCALL);
 
@@ -21409,6 +23218,10 @@ template <class T> void RegisterMembers_TileMap2D(asIScriptEngine* engine, const
     // void TileMap2D::DrawDebugGeometry()
     engine->RegisterObjectMethod(className, "void DrawDebugGeometry()", AS_METHODPR(T, DrawDebugGeometry, (), void), AS_CALL_THISCALL);
 
+    // int TileMap2D::GetChunkSize() const
+    engine->RegisterObjectMethod(className, "int GetChunkSize() const", AS_METHODPR(T, GetChunkSize, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_chunkSize() const", AS_METHODPR(T, GetChunkSize, () const, int), AS_CALL_THISCALL);
+
     // const TileMapInfo2D& TileMap2D::GetInfo() const
     engine->RegisterObjectMethod(className, "const TileMapInfo2D& GetInfo() const", AS_METHODPR(T, GetInfo, () const, const TileMapInfo2D&), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "const TileMapInfo2D& get_info() const", AS_METHODPR(T, GetInfo, () const, const TileMapInfo2D&), AS_CALL_THISCALL);
@@ -21436,6 +23249,10 @@ template <class T> void RegisterMembers_TileMap2D(asIScriptEngine* engine, const
     // bool TileMap2D::PositionToTileIndex(int& x, int& y, const Vector2& position) const
     engine->RegisterObjectMethod(className, "bool PositionToTileIndex(int&, int&, const Vector2&in) const", AS_METHODPR(T, PositionToTileIndex, (int&, int&, const Vector2&) const, bool), AS_CALL_THISCALL);
 
+    // void TileMap2D::SetChunkSize(int chunkSize)
+    engine->RegisterObjectMethod(className, "void SetChunkSize(int)", AS_METHODPR(T, SetChunkSize, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_chunkSize(int)", AS_METHODPR(T, SetChunkSize, (int), void), AS_CALL_THISCALL);
+
     // void TileMap2D::SetTmxFile(TmxFile2D* tmxFile)
     engine->RegisterObjectMethod(className, "void SetTmxFile(TmxFile2D@+)", AS_METHODPR(T, SetTmxFile, (TmxFile2D*), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_tmxFile(TmxFile2D@+)", AS_METHODPR(T, SetTmxFile, (TmxFile2D*), void), AS_CALL_THISCALL);
@@ -21459,6 +23276,10 @@ template <class T> void RegisterMembers_TileMapLayer2D(asIScriptEngine* engine,
     // void TileMapLayer2D::DrawDebugGeometry(DebugRenderer* debug, bool depthTest) override
     engine->RegisterObjectMethod(className, "void DrawDebugGeometry(DebugRenderer@+, bool)", AS_METHODPR(T, DrawDebugGeometry, (DebugRenderer*, bool), void), AS_CALL_THISCALL);
 
+    // int TileMapLayer2D::GetChunkSize() const
+    engine->RegisterObjectMethod(className, "int GetChunkSize() const", AS_METHODPR(T, GetChunkSize, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_chunkSize() const", AS_METHODPR(T, GetChunkSize, () const, int), AS_CALL_THISCALL);
+
     // int TileMapLayer2D::GetDrawOrder() const
     engine->RegisterObjectMethod(className, "int GetDrawOrder() const", AS_METHODPR(T, GetDrawOrder, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_drawOrder() const", AS_METHODPR(T, GetDrawOrder, () const, int), AS_CALL_THISCALL);
@@ -21497,6 +23318,9 @@ template <class T> void RegisterMembers_TileMapLayer2D(asIScriptEngine* engine,
     // Node* TileMapLayer2D::GetTileNode(int x, int y) const
     engine->RegisterObjectMethod(className, "Node@+ GetTileNode(int, int) const", AS_METHODPR(T, GetTileNode, (int, int) const, Node*), AS_CALL_THISCALL);
 
+    // Sprite2D* TileMapLayer2D::GetTileSprite(int x, int y) const
+    engine->RegisterObjectMethod(className, "Sprite2D@+ GetTileSprite(int, int) const", AS_METHODPR(T, GetTileSprite, (int, int) const, Sprite2D*), AS_CALL_THISCALL);
+
     // const TmxLayer2D* TileMapLayer2D::GetTmxLayer() const
     engine->RegisterObjectMethod(className, "TmxLayer2D@+ GetTmxLayer() const", AS_METHODPR(T, GetTmxLayer, () const, const TmxLayer2D*), AS_CALL_THISCALL);
 
@@ -21517,10 +23341,17 @@ template <class T> void RegisterMembers_TileMapLayer2D(asIScriptEngine* engine,
     // virtual void Component::OnSetEnabled()
     engine->RegisterObjectMethod(className, "void OnSetEnabled()", AS_METHODPR(T, OnSetEnabled, (), void), AS_CALL_THISCALL);
 
+    // void TileMapLayer2D::SetChunkSize(int chunkSize)
+    engine->RegisterObjectMethod(className, "void SetChunkSize(int)", AS_METHODPR(T, SetChunkSize, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_chunkSize(int)", AS_METHODPR(T, SetChunkSize, (int), void), AS_CALL_THISCALL);
+
     // void TileMapLayer2D::SetDrawOrder(int drawOrder)
     engine->RegisterObjectMethod(className, "void SetDrawOrder(int)", AS_METHODPR(T, SetDrawOrder, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_drawOrder(int)", AS_METHODPR(T, SetDrawOrder, (int), void), AS_CALL_THISCALL);
 
+    // void TileMapLayer2D::SetTileSprite(int x, int y, Sprite2D* sprite)
+    engine->RegisterObjectMethod(className, "void SetTileSprite(int, int, Sprite2D@+)", AS_METHODPR(T, SetTileSprite, (int, int, Sprite2D*), void), AS_CALL_THISCALL);
+
     // void TileMapLayer2D::SetVisible(bool visible)
     engine->RegisterObjectMethod(className, "void SetVisible(bool)", AS_METHODPR(T, SetVisible, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_visible(bool)", AS_METHODPR(T, SetVisible, (bool), void), AS_CALL_THISCALL);
@@ -21551,6 +23382,9 @@ template <class T> void RegisterMembers_BillboardSet(asIScriptEngine* engine, co
     // void BillboardSet::Commit()
     engine->RegisterObjectMethod(className, "void Commit()", AS_METHODPR(T, Commit, (), void), AS_CALL_THISCALL);
 
+    // void BillboardSet::CommitRange(unsigned start, unsigned count)
+    engine->RegisterObjectMethod(className, "void CommitRange(uint, uint)", AS_METHODPR(T, CommitRange, (unsigned, unsigned), void), AS_CALL_THISCALL);
+
     // float BillboardSet::GetAnimationLodBias() const
     engine->RegisterObjectMethod(className, "float GetAnimationLodBias() const", AS_METHODPR(T, GetAnimationLodBias, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_animationLodBias() const", AS_METHODPR(T, GetAnimationLodBias, () const, float), AS_CALL_THISCALL);
@@ -21578,6 +23412,10 @@ template <class T> void RegisterMembers_BillboardSet(asIScriptEngine* engine, co
     engine->RegisterObjectMethod(className, "uint GetNumBillboards() const", AS_METHODPR(T, GetNumBillboards, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numBillboards() const", AS_METHODPR(T, GetNumBillboards, () const, unsigned), AS_CALL_THISCALL);
 
+    // float BillboardSet::GetSortThreshold() const
+    engine->RegisterObjectMethod(className, "float GetSortThreshold() const", AS_METHODPR(T, GetSortThreshold, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_sortThreshold() const", AS_METHODPR(T, GetSortThreshold, () const, float), AS_CALL_THISCALL);
+
     // bool BillboardSet::IsFixedScreenSize() const
     engine->RegisterObjectMethod(className, "bool IsFixedScreenSize() const", AS_METHODPR(T, IsFixedScreenSize, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_fixedScreenSize() const", AS_METHODPR(T, IsFixedScreenSize, () const, bool), AS_CALL_THISCALL);
@@ -21629,6 +23467,10 @@ template <class T> void RegisterMembers_BillboardSet(asIScriptEngine* engine, co
     engine->RegisterObjectMethod(className, "void SetScaled(bool)", AS_METHODPR(T, SetScaled, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_scaled(bool)", AS_METHODPR(T, SetScaled, (bool), void), AS_CALL_THISCALL);
 
+    // void BillboardSet::SetSortThreshold(float threshold)
+    engine->RegisterObjectMethod(className, "void SetSortThreshold(float)", AS_METHODPR(T, SetSortThreshold, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_sortThreshold(float)", AS_METHODPR(T, SetSortThreshold, (float), void), AS_CALL_THISCALL);
+
     // void BillboardSet::SetSorted(bool enable)
     engine->RegisterObjectMethod(className, "void SetSorted(bool)", AS_METHODPR(T, SetSorted, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_sorted(bool)", AS_METHODPR(T, SetSorted, (bool), void), AS_CALL_THISCALL);
@@ -21777,8 +23619,12 @@ template <class T> void RegisterMembers_CustomGeometry(asIScriptEngine* engine,
     // Error: type "PODVector<unsigned char>" can not automatically bind
     // Vector<PODVector<CustomGeometryVertex>>& CustomGeometry::GetVertices()
     // Error: type "Vector<PODVector<CustomGeometryVertex>>&" can not automatically bind
+    // const Vector<PODVector<CustomGeometryVertex>>& CustomGeometry::GetVertices() const
+    // Error: type "const Vector<PODVector<CustomGeometryVertex>>&" can not automatically bind
     // void CustomGeometry::SetGeometryDataAttr(const PODVector<unsigned char>& value)
     // Error: type "const PODVector<unsigned char>&" can not automatically bind
+    // bool CustomGeometry::UpdateVertices(unsigned geometryIndex, unsigned start, const PODVector<CustomGeometryVertex>& vertices)
+    // Error: type "const PODVector<CustomGeometryVertex>&" can not automatically bind
 
     // void CustomGeometry::BeginGeometry(unsigned index, PrimitiveType type)
     engine->RegisterObjectMethod(className, "void BeginGeometry(uint, PrimitiveType)", AS_METHODPR(T, BeginGeometry, (unsigned, PrimitiveType), void), AS_CALL_THISCALL);
@@ -21829,6 +23675,9 @@ template <class T> void RegisterMembers_CustomGeometry(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "bool IsDynamic() const", AS_METHODPR(T, IsDynamic, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_dynamic() const", AS_METHODPR(T, IsDynamic, () const, bool), AS_CALL_THISCALL);
 
+    // void CustomGeometry::MarkVerticesDirty(unsigned geometryIndex, unsigned start, unsigned count)
+    engine->RegisterObjectMethod(className, "void MarkVerticesDirty(uint, uint, uint)", AS_METHODPR(T, MarkVerticesDirty, (unsigned, unsigned, unsigned), void), AS_CALL_THISCALL);
+
     // void CustomGeometry::SetDynamic(bool enable)
     engine->RegisterObjectMethod(className, "void SetDynamic(bool)", AS_METHODPR(T, SetDynamic, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_dynamic(bool)", AS_METHODPR(T, SetDynamic, (bool), void), AS_CALL_THISCALL);
@@ -21869,6 +23718,9 @@ template <class T> void RegisterMembers_DecalSet(asIScriptEngine* engine, const
     // bool DecalSet::AddDecal(Drawable* target, const Vector3& worldPosition, const Quaternion& worldRotation, float size, float aspectRatio, float depth, const Vector2& topLeftUV, const Vector2& bottomRightUV, float timeToLive = 0.0f, float normalCutoff = 0.1f, unsigned subGeometry = M_MAX_UNSIGNED)
     engine->RegisterObjectMethod(className, "bool AddDecal(Drawable@+, const Vector3&in, const Quaternion&in, float, float, float, const Vector2&in, const Vector2&in, float = 0.0f, float = 0.1f, uint = M_MAX_UNSIGNED)", AS_METHODPR(T, AddDecal, (Drawable*, const Vector3&, const Quaternion&, float, float, float, const Vector2&, const Vector2&, float, float, unsigned), bool), AS_CALL_THISCALL);
 
+    // bool DecalSet::AddDecalAsync(Drawable* target, const Vector3& worldPosition, const Quaternion& worldRotation, float size, float aspectRatio, float depth, const Vector2& topLeftUV, const Vector2& bottomRightUV, float timeToLive = 0.0f, float normalCutoff = 0.1f, unsigned subGeometry = M_MAX_UNSIGNED)
+    engine->RegisterObjectMethod(className, "bool AddDecalAsync(Drawable@+, const Vector3&in, const Quaternion&in, float, float, float, const Vector2&in, const Vector2&in, float = 0.0f, float = 0.1f, uint = M_MAX_UNSIGNED)", AS_METHODPR(T, AddDecalAsync, (Drawable*, const Vector3&, const Quaternion&, float, float, float, const Vector2&, const Vector2&, float, float, unsigned), bool), AS_CALL_THISCALL);
+
     // Material* DecalSet::GetMaterial() const
     engine->RegisterObjectMethod(className, "Material@+ GetMaterial() const", AS_METHODPR(T, GetMaterial, () const, Material*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "Material@+ get_material() const", AS_METHODPR(T, GetMaterial, () const, Material*), AS_CALL_THISCALL);
@@ -21892,6 +23744,10 @@ template <class T> void RegisterMembers_DecalSet(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "uint GetNumIndices() const", AS_METHODPR(T, GetNumIndices, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numIndices() const", AS_METHODPR(T, GetNumIndices, () const, unsigned), AS_CALL_THISCALL);
 
+    // unsigned DecalSet::GetNumPendingDecals() const
+    engine->RegisterObjectMethod(className, "uint GetNumPendingDecals() const", AS_METHODPR(T, GetNumPendingDecals, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numPendingDecals() const", AS_METHODPR(T, GetNumPendingDecals, () const, unsigned), AS_CALL_THISCALL);
+
     // unsigned DecalSet::GetNumVertices() const
     engine->RegisterObjectMethod(className, "uint GetNumVertices() const", AS_METHODPR(T, GetNumVertices, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numVertices() const", AS_METHODPR(T, GetNumVertices, () const, unsigned), AS_CALL_THISCALL);
@@ -22388,6 +24244,19 @@ template <class T> void RegisterMembers_ListView(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "bool GetSelectOnClickEnd() const", AS_METHODPR(T, GetSelectOnClickEnd, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_selectOnClickEnd() const", AS_METHODPR(T, GetSelectOnClickEnd, () const, bool), AS_CALL_THISCALL);
 
+    // unsigned ListView::GetVirtualItemCount() const
+    engine->RegisterObjectMethod(className, "uint GetVirtualItemCount() const", AS_METHODPR(T, GetVirtualItemCount, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_virtualItemCount() const", AS_METHODPR(T, GetVirtualItemCount, () const, unsigned), AS_CALL_THISCALL);
+    // int ListView::GetVirtualItemHeight() const
+    engine->RegisterObjectMethod(className, "int GetVirtualItemHeight() const", AS_METHODPR(T, GetVirtualItemHeight, () const, int), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_virtualItemHeight() const", AS_METHODPR(T, GetVirtualItemHeight, () const, int), AS_CALL_THISCALL);
+    // bool ListView::GetVirtualMode() const
+    engine->RegisterObjectMethod(className, "bool GetVirtualMode() const", AS_METHODPR(T, GetVirtualMode, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_virtualMode() const", AS_METHODPR(T, GetVirtualMode, () const, bool), AS_CALL_THISCALL);
+    // unsigned ListView::GetVirtualOverscan() const
+    engine->RegisterObjectMethod(className, "uint GetVirtualOverscan() const", AS_METHODPR(T, GetVirtualOverscan, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_virtualOverscan() const", AS_METHODPR(T, GetVirtualOverscan, () const, unsigned), AS_CALL_THISCALL);
+
     // void ListView::InsertItem(unsigned index, UIElement* item, UIElement* parentItem = nullptr)
     engine->RegisterObjectMethod(className, "void InsertItem(uint, UIElement@+, UIElement@+ = null)", AS_METHODPR(T, InsertItem, (unsigned, UIElement*, UIElement*), void), AS_CALL_THISCALL);
 
@@ -22397,6 +24266,9 @@ template <class T> void RegisterMembers_ListView(asIScriptEngine* engine, const
     // bool ListView::IsSelected(unsigned index) const
     engine->RegisterObjectMethod(className, "bool IsSelected(uint) const", AS_METHODPR(T, IsSelected, (unsigned) const, bool), AS_CALL_THISCALL);
 
+    // void ListView::RefreshVirtualItems()
+    engine->RegisterObjectMethod(className, "void RefreshVirtualItems()", AS_METHODPR(T, RefreshVirtualItems, (), void), AS_CALL_THISCALL);
+
     // void ListView::RemoveAllItems()
     engine->RegisterObjectMethod(className, "void RemoveAllItems()", AS_METHODPR(T, RemoveAllItems, (), void), AS_CALL_THISCALL);
 
@@ -22440,6 +24312,19 @@ template <class T> void RegisterMembers_ListView(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "void SetSelectOnClickEnd(bool)", AS_METHODPR(T, SetSelectOnClickEnd, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_selectOnClickEnd(bool)", AS_METHODPR(T, SetSelectOnClickEnd, (bool), void), AS_CALL_THISCALL);
 
+    // void ListView::SetVirtualItemCount(unsigned count)
+    engine->RegisterObjectMethod(className, "void SetVirtualItemCount(uint)", AS_METHODPR(T, SetVirtualItemCount, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_virtualItemCount(uint)", AS_METHODPR(T, SetVirtualItemCount, (unsigned), void), AS_CALL_THISCALL);
+    // void ListView::SetVirtualItemHeight(int height)
+    engine->RegisterObjectMethod(className, "void SetVirtualItemHeight(int)", AS_METHODPR(T, SetVirtualItemHeight, (int), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_virtualItemHeight(int)", AS_METHODPR(T, SetVirtualItemHeight, (int), void), AS_CALL_THISCALL);
+    // void ListView::SetVirtualMode(bool enable)
+    engine->RegisterObjectMethod(className, "void SetVirtualMode(bool)", AS_METHODPR(T, SetVirtualMode, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_virtualMode(bool)", AS_METHODPR(T, SetVirtualMode, (bool), void), AS_CALL_THISCALL);
+    // void ListView::SetVirtualOverscan(unsigned overscan)
+    engine->RegisterObjectMethod(className, "void SetVirtualOverscan(uint)", AS_METHODPR(T, SetVirtualOverscan, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_virtualOverscan(uint)", AS_METHODPR(T, SetVirtualOverscan, (unsigned), void), AS_CALL_THISCALL);
+
     // void ListView::ToggleExpand(unsigned index, bool recursive = false)
     engine->RegisterObjectMethod(className, "void ToggleExpand(uint, bool = false)", AS_METHODPR(T, ToggleExpand, (unsigned, bool), void), AS_CALL_THISCALL);
 
@@ -22544,6 +24429,10 @@ template <class T> void RegisterMembers_RibbonTrail(asIScriptEngine* engine, con
     // ResourceRef RibbonTrail::GetMaterialAttr() const
     engine->RegisterObjectMethod(className, "ResourceRef GetMaterialAttr() const", AS_METHODPR(T, GetMaterialAttr, () const, ResourceRef), AS_CALL_THISCALL);
 
+    // bool RibbonTrail::GetSignificanceUpdate() const
+    engine->RegisterObjectMethod(className, "bool GetSignificanceUpdate() const", AS_METHODPR(T, GetSignificanceUpdate, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_significanceUpdate() const", AS_METHODPR(T, GetSignificanceUpdate, () const, bool), AS_CALL_THISCALL);
+
     // const Color& RibbonTrail::GetStartColor() const
     engine->RegisterObjectMethod(className, "const Color& GetStartColor() const", AS_METHODPR(T, GetStartColor, () const, const Color&), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "const Color& get_startColor() const", AS_METHODPR(T, GetStartColor, () const, const Color&), AS_CALL_THISCALL);
@@ -22611,6 +24500,10 @@ template <class T> void RegisterMembers_RibbonTrail(asIScriptEngine* engine, con
     // void RibbonTrail::SetMaterialAttr(const ResourceRef& value)
     engine->RegisterObjectMethod(className, "void SetMaterialAttr(const ResourceRef&in)", AS_METHODPR(T, SetMaterialAttr, (const ResourceRef&), void), AS_CALL_THISCALL);
 
+    // void RibbonTrail::SetSignificanceUpdate(bool enable)
+    engine->RegisterObjectMethod(className, "void SetSignificanceUpdate(bool)", AS_METHODPR(T, SetSignificanceUpdate, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_significanceUpdate(bool)", AS_METHODPR(T, SetSignificanceUpdate, (bool), void), AS_CALL_THISCALL);
+
     // void RibbonTrail::SetSorted(bool enable)
     engine->RegisterObjectMethod(className, "void SetSorted(bool)", AS_METHODPR(T, SetSorted, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_sorted(bool)", AS_METHODPR(T, SetSorted, (bool), void), AS_CALL_THISCALL);
@@ -22651,6 +24544,174 @@ template <class T> void RegisterMembers_RibbonTrail(asIScriptEngine* engine, con
     #endif
 }
 
+// class ScatterModel | File: ../Graphics/ScatterModel.h
+template <class T> void RegisterMembers_ScatterModel(asIScriptEngine* engine, const char* className)
+{
+    RegisterMembers_Drawable<T>(engine, className);
+
+    // const ScatterInstance* ScatterModel::GetInstance(unsigned index) const
+    // Not registered because have @nobind mark
+    // const PODVector<ScatterInstance>& ScatterModel::GetInstances() const
+    // Not registered because have @nobind mark
+    // const PODVector<unsigned char>& ScatterModel::GetInstancesAttr() const
+    // Error: type "const PODVector<unsigned char>&" can not automatically bind
+    // void ScatterModel::SetInstances(const PODVector<ScatterInstance>& instances)
+    // Not registered because have @nobind mark
+    // void ScatterModel::SetInstancesAttr(const PODVector<unsigned char>& value)
+    // Error: type "const PODVector<unsigned char>&" can not automatically bind
+
+    // void ScatterModel::AddInstance(const Vector3& position, const Quaternion& rotation = Quaternion::IDENTITY, float scale = 1.0f)
+    engine->RegisterObjectMethod(className, "void AddInstance(const Vector3&in, const Quaternion&in = Quaternion::IDENTITY, float = 1.0f)", AS_METHODPR(T, AddInstance, (const Vector3&, const Quaternion&, float), void), AS_CALL_THISCALL);
+
+    // bool ScatterModel::GetAlignToGround() const
+    engine->RegisterObjectMethod(className, "bool GetAlignToGround() const", AS_METHODPR(T, GetAlignToGround, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_alignToGround() const", AS_METHODPR(T, GetAlignToGround, () const, bool), AS_CALL_THISCALL);
+
+    // float ScatterModel::GetCellSize() const
+    engine->RegisterObjectMethod(className, "float GetCellSize() const", AS_METHODPR(T, GetCellSize, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_cellSize() const", AS_METHODPR(T, GetCellSize, () const, float), AS_CALL_THISCALL);
+
+    // Image* ScatterModel::GetDensityMap() const
+    engine->RegisterObjectMethod(className, "Image@+ GetDensityMap() const", AS_METHODPR(T, GetDensityMap, () const, Image*), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "Image@+ get_densityMap() const", AS_METHODPR(T, GetDensityMap, () const, Image*), AS_CALL_THISCALL);
+
+    // ResourceRef ScatterModel::GetDensityMapAttr() const
+    engine->RegisterObjectMethod(className, "ResourceRef GetDensityMapAttr() const", AS_METHODPR(T, GetDensityMapAttr, () const, ResourceRef), AS_CALL_THISCALL);
+
+    // Geometry* ScatterModel::GetLodGeometry(unsigned batchIndex, unsigned level) override
+    engine->RegisterObjectMethod(className, "Geometry@+ GetLodGeometry(uint, uint)", AS_METHODPR(T, GetLodGeometry, (unsigned, unsigned), Geometry*), AS_CALL_THISCALL);
+
+    // Material* ScatterModel::GetMaterial(unsigned index = 0) const
+    engine->RegisterObjectMethod(className, "Material@+ GetMaterial(uint = 0) const", AS_METHODPR(T, GetMaterial, (unsigned) const, Material*), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "Material@+ get_materials(uint = 0) const", AS_METHODPR(T, GetMaterial, (unsigned) const, Material*), AS_CALL_THISCALL);
+
+    // const ResourceRefList& ScatterModel::GetMaterialsAttr() const
+    engine->RegisterObjectMethod(className, "const ResourceRefList& GetMaterialsAttr() const", AS_METHODPR(T, GetMaterialsAttr, () const, const ResourceRefList&), AS_CALL_THISCALL);
+
+    // float ScatterModel::GetMaxSlope() const
+    engine->RegisterObjectMethod(className, "float GetMaxSlope() const", AS_METHODPR(T, GetMaxSlope, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_maxSlope() const", AS_METHODPR(T, GetMaxSlope, () const, float), AS_CALL_THISCALL);
+
+    // Model* ScatterModel::GetModel() const
+    engine->RegisterObjectMethod(className, "Model@+ GetModel() const", AS_METHODPR(T, GetModel, () const, Model*), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "Model@+ get_model() const", AS_METHODPR(T, GetModel, () const, Model*), AS_CALL_THISCALL);
+
+    // ResourceRef ScatterModel::GetModelAttr() const
+    engine->RegisterObjectMethod(className, "ResourceRef GetModelAttr() const", AS_METHODPR(T, GetModelAttr, () const, ResourceRef), AS_CALL_THISCALL);
+
+    // unsigned ScatterModel::GetNumCells() const
+    engine->RegisterObjectMethod(className, "uint GetNumCells() const", AS_METHODPR(T, GetNumCells, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numCells() const", AS_METHODPR(T, GetNumCells, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned ScatterModel::GetNumGeometries() const
+    engine->RegisterObjectMethod(className, "uint GetNumGeometries() const", AS_METHODPR(T, GetNumGeometries, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numGeometries() const", AS_METHODPR(T, GetNumGeometries, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned ScatterModel::GetNumInstances() const
+    engine->RegisterObjectMethod(className, "uint GetNumInstances() const", AS_METHODPR(T, GetNumInstances, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numInstances() const", AS_METHODPR(T, GetNumInstances, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned ScatterModel::GetNumVisibleInstances() const
+    engine->RegisterObjectMethod(className, "uint GetNumVisibleInstances() const", AS_METHODPR(T, GetNumVisibleInstances, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numVisibleInstances() const", AS_METHODPR(T, GetNumVisibleInstances, () const, unsigned), AS_CALL_THISCALL);
+
+    // bool ScatterModel::GetProjectToTerrain() const
+    engine->RegisterObjectMethod(className, "bool GetProjectToTerrain() const", AS_METHODPR(T, GetProjectToTerrain, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_projectToTerrain() const", AS_METHODPR(T, GetProjectToTerrain, () const, bool), AS_CALL_THISCALL);
+
+    // const Vector2& ScatterModel::GetScaleRange() const
+    engine->RegisterObjectMethod(className, "const Vector2& GetScaleRange() const", AS_METHODPR(T, GetScaleRange, () const, const Vector2&), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "const Vector2& get_scaleRange() const", AS_METHODPR(T, GetScaleRange, () const, const Vector2&), AS_CALL_THISCALL);
+
+    // const Rect& ScatterModel::GetScatterArea() const
+    engine->RegisterObjectMethod(className, "const Rect& GetScatterArea() const", AS_METHODPR(T, GetScatterArea, () const, const Rect&), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "const Rect& get_scatterArea() const", AS_METHODPR(T, GetScatterArea, () const, const Rect&), AS_CALL_THISCALL);
+
+    // float ScatterModel::GetScatterDensity() const
+    engine->RegisterObjectMethod(className, "float GetScatterDensity() const", AS_METHODPR(T, GetScatterDensity, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_scatterDensity() const", AS_METHODPR(T, GetScatterDensity, () const, float), AS_CALL_THISCALL);
+
+    // unsigned ScatterModel::GetScatterSeed() const
+    engine->RegisterObjectMethod(className, "uint GetScatterSeed() const", AS_METHODPR(T, GetScatterSeed, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_scatterSeed() const", AS_METHODPR(T, GetScatterSeed, () const, unsigned), AS_CALL_THISCALL);
+
+    // void ScatterModel::RemoveAllInstances()
+    engine->RegisterObjectMethod(className, "void RemoveAllInstances()", AS_METHODPR(T, RemoveAllInstances, (), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::RemoveInstance(unsigned index)
+    engine->RegisterObjectMethod(className, "void RemoveInstance(uint)", AS_METHODPR(T, RemoveInstance, (unsigned), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::Scatter()
+    engine->RegisterObjectMethod(className, "void Scatter()", AS_METHODPR(T, Scatter, (), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetAlignToGround(bool enable)
+    engine->RegisterObjectMethod(className, "void SetAlignToGround(bool)", AS_METHODPR(T, SetAlignToGround, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_alignToGround(bool)", AS_METHODPR(T, SetAlignToGround, (bool), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetCellSize(float size)
+    engine->RegisterObjectMethod(className, "void SetCellSize(float)", AS_METHODPR(T, SetCellSize, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_cellSize(float)", AS_METHODPR(T, SetCellSize, (float), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetDensityMap(Image* image)
+    engine->RegisterObjectMethod(className, "void SetDensityMap(Image@+)", AS_METHODPR(T, SetDensityMap, (Image*), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_densityMap(Image@+)", AS_METHODPR(T, SetDensityMap, (Image*), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetDensityMapAttr(const ResourceRef& value)
+    engine->RegisterObjectMethod(className, "void SetDensityMapAttr(const ResourceRef&in)", AS_METHODPR(T, SetDensityMapAttr, (const ResourceRef&), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetMaterial(Material* material)
+    engine->RegisterObjectMethod(className, "void SetMaterial(Material@+)", AS_METHODPR(T, SetMaterial, (Material*), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_material(Material@+)", AS_METHODPR(T, SetMaterial, (Material*), void), AS_CALL_THISCALL);
+
+    // bool ScatterModel::SetMaterial(unsigned index, Material* material)
+    engine->RegisterObjectMethod(className, "bool SetMaterial(uint, Material@+)", AS_METHODPR(T, SetMaterial, (unsigned, Material*), bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool set_materials(uint, Material@+)", AS_METHODPR(T, SetMaterial, (unsigned, Material*), bool), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetMaterialsAttr(const ResourceRefList& value)
+    engine->RegisterObjectMethod(className, "void SetMaterialsAttr(const ResourceRefList&in)", AS_METHODPR(T, SetMaterialsAttr, (const ResourceRefList&), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetMaxSlope(float angle)
+    engine->RegisterObjectMethod(className, "void SetMaxSlope(float)", AS_METHODPR(T, SetMaxSlope, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxSlope(float)", AS_METHODPR(T, SetMaxSlope, (float), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetModel(Model* model)
+    engine->RegisterObjectMethod(className, "void SetModel(Model@+)", AS_METHODPR(T, SetModel, (Model*), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_model(Model@+)", AS_METHODPR(T, SetModel, (Model*), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetModelAttr(const ResourceRef& value)
+    engine->RegisterObjectMethod(className, "void SetModelAttr(const ResourceRef&in)", AS_METHODPR(T, SetModelAttr, (const ResourceRef&), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetProjectToTerrain(bool enable)
+    engine->RegisterObjectMethod(className, "void SetProjectToTerrain(bool)", AS_METHODPR(T, SetProjectToTerrain, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_projectToTerrain(bool)", AS_METHODPR(T, SetProjectToTerrain, (bool), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetScaleRange(const Vector2& range)
+    engine->RegisterObjectMethod(className, "void SetScaleRange(const Vector2&in)", AS_METHODPR(T, SetScaleRange, (const Vector2&), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_scaleRange(const Vector2&in)", AS_METHODPR(T, SetScaleRange, (const Vector2&), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetScatterArea(const Rect& area)
+    engine->RegisterObjectMethod(className, "void SetScatterArea(const Rect&in)", AS_METHODPR(T, SetScatterArea, (const Rect&), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_scatterArea(const Rect&in)", AS_METHODPR(T, SetScatterArea, (const Rect&), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetScatterDensity(float density)
+    engine->RegisterObjectMethod(className, "void SetScatterDensity(float)", AS_METHODPR(T, SetScatterDensity, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_scatterDensity(float)", AS_METHODPR(T, SetScatterDensity, (float), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::SetScatterSeed(unsigned seed)
+    engine->RegisterObjectMethod(className, "void SetScatterSeed(uint)", AS_METHODPR(T, SetScatterSeed, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_scatterSeed(uint)", AS_METHODPR(T, SetScatterSeed, (unsigned), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::Update(const FrameInfo& frame) override
+    engine->RegisterObjectMethod(className, "void Update(const FrameInfo&in)", AS_METHODPR(T, Update, (const FrameInfo&), void), AS_CALL_THISCALL);
+
+    // void ScatterModel::UpdateBatches(const FrameInfo& frame) override
+    engine->RegisterObjectMethod(className, "void UpdateBatches(const FrameInfo&in)", AS_METHODPR(T, UpdateBatches, (const FrameInfo&), void), AS_CALL_THISCALL);
+
+    #ifdef REGISTER_MEMBERS_MANUAL_PART_ScatterModel
+        REGISTER_MEMBERS_MANUAL_PART_ScatterModel();
+    #endif
+}
+
 // class ScrollBar | File: ../UI/ScrollBar.h
 template <class T> void RegisterMembers_ScrollBar(asIScriptEngine* engine, const char* className)
 {
@@ -22799,6 +24860,10 @@ template <class T> void RegisterMembers_SoundSource3D(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "float GetOuterAngle() const", AS_METHODPR(T, GetOuterAngle, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_outerAngle() const", AS_METHODPR(T, GetOuterAngle, () const, float), AS_CALL_THISCALL);
 
+    // bool SoundSource3D::GetSignificanceUpdate() const
+    engine->RegisterObjectMethod(className, "bool GetSignificanceUpdate() const", AS_METHODPR(T, GetSignificanceUpdate, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_significanceUpdate() const", AS_METHODPR(T, GetSignificanceUpdate, () const, bool), AS_CALL_THISCALL);
+
     // float SoundSource3D::RollAngleoffFactor() const
     engine->RegisterObjectMethod(className, "float RollAngleoffFactor() const", AS_METHODPR(T, RollAngleoffFactor, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_rolloffFactor() const", AS_METHODPR(T, RollAngleoffFactor, () const, float), AS_CALL_THISCALL);
@@ -22829,6 +24894,10 @@ template <class T> void RegisterMembers_SoundSource3D(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "void SetRolloffFactor(float)", AS_METHODPR(T, SetRolloffFactor, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_rolloffFactor(float)", AS_METHODPR(T, SetRolloffFactor, (float), void), AS_CALL_THISCALL);
 
+    // void SoundSource3D::SetSignificanceUpdate(bool enable)
+    engine->RegisterObjectMethod(className, "void SetSignificanceUpdate(bool)", AS_METHODPR(T, SetSignificanceUpdate, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_significanceUpdate(bool)", AS_METHODPR(T, SetSignificanceUpdate, (bool), void), AS_CALL_THISCALL);
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_SoundSource3D
         REGISTER_MEMBERS_MANUAL_PART_SoundSource3D();
     #endif
@@ -23588,6 +25657,9 @@ template <class T> void RegisterMembers_DynamicNavigationMesh(asIScriptEngine* e
 {
     RegisterMembers_NavigationMesh<T>(engine, className);
 
+    // void DynamicNavigationMesh::CompleteObstacleUpdates()
+    engine->RegisterObjectMethod(className, "void CompleteObstacleUpdates()", AS_METHODPR(T, CompleteObstacleUpdates, (), void), AS_CALL_THISCALL);
+
     // bool DynamicNavigationMesh::GetDrawObstacles() const
     engine->RegisterObjectMethod(className, "bool GetDrawObstacles() const", AS_METHODPR(T, GetDrawObstacles, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_drawObstacles() const", AS_METHODPR(T, GetDrawObstacles, () const, bool), AS_CALL_THISCALL);
@@ -23600,6 +25672,14 @@ template <class T> void RegisterMembers_DynamicNavigationMesh(asIScriptEngine* e
     engine->RegisterObjectMethod(className, "uint GetMaxObstacles() const", AS_METHODPR(T, GetMaxObstacles, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_maxObstacles() const", AS_METHODPR(T, GetMaxObstacles, () const, unsigned), AS_CALL_THISCALL);
 
+    // unsigned DynamicNavigationMesh::GetNumPendingObstacleTiles() const
+    engine->RegisterObjectMethod(className, "uint GetNumPendingObstacleTiles() const", AS_METHODPR(T, GetNumPendingObstacleTiles, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numPendingObstacleTiles() const", AS_METHODPR(T, GetNumPendingObstacleTiles, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned DynamicNavigationMesh::GetObstacleUpdateBudget() const
+    engine->RegisterObjectMethod(className, "uint GetObstacleUpdateBudget() const", AS_METHODPR(T, GetObstacleUpdateBudget, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_obstacleUpdateBudget() const", AS_METHODPR(T, GetObstacleUpdateBudget, () const, unsigned), AS_CALL_THISCALL);
+
     // bool DynamicNavigationMesh::IsObstacleInTile(Obstacle* obstacle, const IntVector2& tile) const
     engine->RegisterObjectMethod(className, "bool IsObstacleInTile(Obstacle@+, const IntVector2&in) const", AS_METHODPR(T, IsObstacleInTile, (Obstacle*, const IntVector2&) const, bool), AS_CALL_THISCALL);
 
@@ -23615,6 +25695,10 @@ template <class T> void RegisterMembers_DynamicNavigationMesh(asIScriptEngine* e
     engine->RegisterObjectMethod(className, "void SetMaxObstacles(uint)", AS_METHODPR(T, SetMaxObstacles, (unsigned), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_maxObstacles(uint)", AS_METHODPR(T, SetMaxObstacles, (unsigned), void), AS_CALL_THISCALL);
 
+    // void DynamicNavigationMesh::SetObstacleUpdateBudget(unsigned layers)
+    engine->RegisterObjectMethod(className, "void SetObstacleUpdateBudget(uint)", AS_METHODPR(T, SetObstacleUpdateBudget, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_obstacleUpdateBudget(uint)", AS_METHODPR(T, SetObstacleUpdateBudget, (unsigned), void), AS_CALL_THISCALL);
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_DynamicNavigationMesh
         REGISTER_MEMBERS_MANUAL_PART_DynamicNavigationMesh();
     #endif
@@ -23637,6 +25721,9 @@ template <class T> void RegisterMembers_RaycastVehicle(asIScriptEngine* engine,
     // void RaycastVehicle::AddWheel(Node* wheelNode, Vector3 wheelDirection, Vector3 wheelAxle, float restLength, float wheelRadius, bool frontWheel)
     engine->RegisterObjectMethod(className, "void AddWheel(Node@+, Vector3, Vector3, float, float, bool)", AS_METHODPR(T, AddWheel, (Node*, Vector3, Vector3, float, float, bool), void), AS_CALL_THISCALL);
 
+    // void RaycastVehicle::AddWheelRays(PODVector<PhysicsQuery>& queries)
+    // Not registered because have @nobind mark
+
     // void RaycastVehicle::FixedPostUpdate(float timeStep) override
     engine->RegisterObjectMethod(className, "void FixedPostUpdate(float)", AS_METHODPR(T, FixedPostUpdate, (float), void), AS_CALL_THISCALL);
 
@@ -23806,6 +25893,9 @@ template <class T> void RegisterMembers_RaycastVehicle(asIScriptEngine* engine,
     // void RaycastVehicle::SetWheelSuspensionStiffness(int wheel, float stiffness)
     engine->RegisterObjectMethod(className, "void SetWheelSuspensionStiffness(int, float)", AS_METHODPR(T, SetWheelSuspensionStiffness, (int, float), void), AS_CALL_THISCALL);
 
+    // void RaycastVehicle::UpdateVehicle(const PhysicsRaycastResult* wheelHits, float timeStep)
+    // Not registered because have @nobind mark
+
     // void RaycastVehicle::UpdateWheelTransform(int wheel, bool interpolated)
     engine->RegisterObjectMethod(className, "void UpdateWheelTransform(int, bool)", AS_METHODPR(T, UpdateWheelTransform, (int, bool), void), AS_CALL_THISCALL);
 
@@ -24597,6 +26687,9 @@ template <class T> void RegisterMembers_Drawable2D(asIScriptEngine* engine, cons
     engine->RegisterObjectMethod(className, "int GetOrderInLayer() const", AS_METHODPR(T, GetOrderInLayer, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_orderInLayer() const", AS_METHODPR(T, GetOrderInLayer, () const, int), AS_CALL_THISCALL);
 
+    // virtual void Drawable2D::OnSpriteInstancingChanged()
+    engine->RegisterObjectMethod(className, "void OnSpriteInstancingChanged()", AS_METHODPR(T, OnSpriteInstancingChanged, (), void), AS_CALL_THISCALL);
+
     // void Drawable2D::SetLayer(int layer)
     engine->RegisterObjectMethod(className, "void SetLayer(int)", AS_METHODPR(T, SetLayer, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_layer(int)", AS_METHODPR(T, SetLayer, (int), void), AS_CALL_THISCALL);
@@ -24621,12 +26714,26 @@ template <class T> void RegisterMembers_Renderer2D(asIScriptEngine* engine, cons
     // bool Renderer2D::CheckVisibility(Drawable2D* drawable) const
     engine->RegisterObjectMethod(className, "bool CheckVisibility(Drawable2D@+) const", AS_METHODPR(T, CheckVisibility, (Drawable2D*) const, bool), AS_CALL_THISCALL);
 
+    // Material* Renderer2D::GetInstancedMaterial(Texture2D* texture, BlendMode blendMode)
+    engine->RegisterObjectMethod(className, "Material@+ GetInstancedMaterial(Texture2D@+, BlendMode)", AS_METHODPR(T, GetInstancedMaterial, (Texture2D*, BlendMode), Material*), AS_CALL_THISCALL);
+
     // Material* Renderer2D::GetMaterial(Texture2D* texture, BlendMode blendMode)
     engine->RegisterObjectMethod(className, "Material@+ GetMaterial(Texture2D@+, BlendMode)", AS_METHODPR(T, GetMaterial, (Texture2D*, BlendMode), Material*), AS_CALL_THISCALL);
 
+    // bool Renderer2D::GetSpriteInstancing() const
+    engine->RegisterObjectMethod(className, "bool GetSpriteInstancing() const", AS_METHODPR(T, GetSpriteInstancing, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_spriteInstancing() const", AS_METHODPR(T, GetSpriteInstancing, () const, bool), AS_CALL_THISCALL);
+
+    // bool Renderer2D::IsSpriteInstancingActive() const
+    engine->RegisterObjectMethod(className, "bool IsSpriteInstancingActive() const", AS_METHODPR(T, IsSpriteInstancingActive, () const, bool), AS_CALL_THISCALL);
+
     // void Renderer2D::RemoveDrawable(Drawable2D* drawable)
     engine->RegisterObjectMethod(className, "void RemoveDrawable(Drawable2D@+)", AS_METHODPR(T, RemoveDrawable, (Drawable2D*), void), AS_CALL_THISCALL);
 
+    // void Renderer2D::SetSpriteInstancing(bool enable)
+    engine->RegisterObjectMethod(className, "void SetSpriteInstancing(bool)", AS_METHODPR(T, SetSpriteInstancing, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_spriteInstancing(bool)", AS_METHODPR(T, SetSpriteInstancing, (bool), void), AS_CALL_THISCALL);
+
     // virtual void Drawable::Update(const FrameInfo& frame)
     engine->RegisterObjectMethod(className, "void Update(const FrameInfo&in)", AS_METHODPR(T, Update, (const FrameInfo&), void), AS_CALL_THISCALL);
 
@@ -24681,6 +26788,12 @@ template <class T> void RegisterMembers_AnimatedModel(asIScriptEngine* engine, c
     // void AnimatedModel::ApplyAnimation()
     engine->RegisterObjectMethod(className, "void ApplyAnimation()", AS_METHODPR(T, ApplyAnimation, (), void), AS_CALL_THISCALL);
 
+    // Node* AnimatedModel::AttachBoneNode(const String& boneName)
+    engine->RegisterObjectMethod(className, "Node@+ AttachBoneNode(const String&in)", AS_METHODPR(T, AttachBoneNode, (const String&), Node*), AS_CALL_THISCALL);
+
+    // void AnimatedModel::DetachBoneNode(const String& boneName)
+    engine->RegisterObjectMethod(className, "void DetachBoneNode(const String&in)", AS_METHODPR(T, DetachBoneNode, (const String&), void), AS_CALL_THISCALL);
+
     // float AnimatedModel::GetAnimationLodBias() const
     engine->RegisterObjectMethod(className, "float GetAnimationLodBias() const", AS_METHODPR(T, GetAnimationLodBias, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_animationLodBias() const", AS_METHODPR(T, GetAnimationLodBias, () const, float), AS_CALL_THISCALL);
@@ -24701,6 +26814,17 @@ template <class T> void RegisterMembers_AnimatedModel(asIScriptEngine* engine, c
     // const Vector<SharedPtr<AnimationState>>& AnimatedModel::GetAnimationStates() const
     engine->RegisterObjectMethod(className, "Array<AnimationState@>@ GetAnimationStates() const", AS_FUNCTION_OBJFIRST(AnimatedModel_constspVectorlesSharedPtrlesAnimationStategregreamp_GetAnimationStates_void_template<AnimatedModel>), AS_CALL_CDECL_OBJFIRST);
 
+    // const Matrix3x4& AnimatedModel::GetBoneModelTransform(unsigned index) const
+    engine->RegisterObjectMethod(className, "const Matrix3x4& GetBoneModelTransform(uint) const", AS_METHODPR(T, GetBoneModelTransform, (unsigned) const, const Matrix3x4&), AS_CALL_THISCALL);
+
+    // bool AnimatedModel::GetComputeMorphs() const
+    engine->RegisterObjectMethod(className, "bool GetComputeMorphs() const", AS_METHODPR(T, GetComputeMorphs, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_computeMorphs() const", AS_METHODPR(T, GetComputeMorphs, () const, bool), AS_CALL_THISCALL);
+
+    // bool AnimatedModel::GetComputeSkinning() const
+    engine->RegisterObjectMethod(className, "bool GetComputeSkinning() const", AS_METHODPR(T, GetComputeSkinning, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_computeSkinning() const", AS_METHODPR(T, GetComputeSkinning, () const, bool), AS_CALL_THISCALL);
+
     // const Vector<SharedPtr<VertexBuffer>>& AnimatedModel::GetMorphVertexBuffers() const
     engine->RegisterObjectMethod(className, "Array<VertexBuffer@>@ GetMorphVertexBuffers() const", AS_FUNCTION_OBJFIRST(AnimatedModel_constspVectorlesSharedPtrlesVertexBuffergregreamp_GetMorphVertexBuffers_void_template<AnimatedModel>), AS_CALL_CDECL_OBJFIRST);
 
@@ -24714,6 +26838,10 @@ template <class T> void RegisterMembers_AnimatedModel(asIScriptEngine* engine, c
     // float AnimatedModel::GetMorphWeight(StringHash nameHash) const
     engine->RegisterObjectMethod(className, "float GetMorphWeight(StringHash) const", AS_METHODPR(T, GetMorphWeight, (StringHash) const, float), AS_CALL_THISCALL);
 
+    // bool AnimatedModel::GetNodelessPose() const
+    engine->RegisterObjectMethod(className, "bool GetNodelessPose() const", AS_METHODPR(T, GetNodelessPose, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_nodelessPose() const", AS_METHODPR(T, GetNodelessPose, () const, bool), AS_CALL_THISCALL);
+
     // unsigned AnimatedModel::GetNumAnimationStates() const
     engine->RegisterObjectMethod(className, "uint GetNumAnimationStates() const", AS_METHODPR(T, GetNumAnimationStates, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numAnimationStates() const", AS_METHODPR(T, GetNumAnimationStates, () const, unsigned), AS_CALL_THISCALL);
@@ -24730,6 +26858,9 @@ template <class T> void RegisterMembers_AnimatedModel(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "bool GetUpdateInvisible() const", AS_METHODPR(T, GetUpdateInvisible, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_updateInvisible() const", AS_METHODPR(T, GetUpdateInvisible, () const, bool), AS_CALL_THISCALL);
 
+    // bool AnimatedModel::IsComputeSkinningActive() const
+    engine->RegisterObjectMethod(className, "bool IsComputeSkinningActive() const", AS_METHODPR(T, IsComputeSkinningActive, () const, bool), AS_CALL_THISCALL);
+
     // bool AnimatedModel::IsMaster() const
     engine->RegisterObjectMethod(className, "bool IsMaster() const", AS_METHODPR(T, IsMaster, () const, bool), AS_CALL_THISCALL);
 
@@ -24758,6 +26889,14 @@ template <class T> void RegisterMembers_AnimatedModel(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "void SetAnimationLodBias(float)", AS_METHODPR(T, SetAnimationLodBias, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_animationLodBias(float)", AS_METHODPR(T, SetAnimationLodBias, (float), void), AS_CALL_THISCALL);
 
+    // void AnimatedModel::SetComputeMorphs(bool enable)
+    engine->RegisterObjectMethod(className, "void SetComputeMorphs(bool)", AS_METHODPR(T, SetComputeMorphs, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_computeMorphs(bool)", AS_METHODPR(T, SetComputeMorphs, (bool), void), AS_CALL_THISCALL);
+
+    // void AnimatedModel::SetComputeSkinning(bool enable)
+    engine->RegisterObjectMethod(className, "void SetComputeSkinning(bool)", AS_METHODPR(T, SetComputeSkinning, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_computeSkinning(bool)", AS_METHODPR(T, SetComputeSkinning, (bool), void), AS_CALL_THISCALL);
+
     // void AnimatedModel::SetModel(Model* model, bool createBones = true)
     engine->RegisterObjectMethod(className, "void SetModel(Model@+, bool = true)", AS_METHODPR(T, SetModel, (Model*, bool), void), AS_CALL_THISCALL);
 
@@ -24771,6 +26910,10 @@ template <class T> void RegisterMembers_AnimatedModel(asIScriptEngine* engine, c
     // void AnimatedModel::SetMorphWeight(StringHash nameHash, float weight)
     engine->RegisterObjectMethod(className, "void SetMorphWeight(StringHash, float)", AS_METHODPR(T, SetMorphWeight, (StringHash, float), void), AS_CALL_THISCALL);
 
+    // void AnimatedModel::SetNodelessPose(bool enable)
+    engine->RegisterObjectMethod(className, "void SetNodelessPose(bool)", AS_METHODPR(T, SetNodelessPose, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_nodelessPose(bool)", AS_METHODPR(T, SetNodelessPose, (bool), void), AS_CALL_THISCALL);
+
     // void AnimatedModel::SetUpdateInvisible(bool enable)
     engine->RegisterObjectMethod(className, "void SetUpdateInvisible(bool)", AS_METHODPR(T, SetUpdateInvisible, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_updateInvisible(bool)", AS_METHODPR(T, SetUpdateInvisible, (bool), void), AS_CALL_THISCALL);
@@ -24837,6 +26980,34 @@ template <class T> void RegisterMembers_Menu(asIScriptEngine* engine, const char
     #endif
 }
 
+// class MeshletModel | File: ../Graphics/MeshletModel.h
+template <class T> void RegisterMembers_MeshletModel(asIScriptEngine* engine, const char* className)
+{
+    RegisterMembers_StaticModel<T>(engine, className);
+
+    // void MeshletModel::SetModel(Model* model) override
+    // Not registered because have @manualbind mark
+
+    // bool MeshletModel::GetMeshletCulling() const
+    engine->RegisterObjectMethod(className, "bool GetMeshletCulling() const", AS_METHODPR(T, GetMeshletCulling, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_meshletCulling() const", AS_METHODPR(T, GetMeshletCulling, () const, bool), AS_CALL_THISCALL);
+
+    // unsigned MeshletModel::GetNumVisibleMeshlets() const
+    engine->RegisterObjectMethod(className, "uint GetNumVisibleMeshlets() const", AS_METHODPR(T, GetNumVisibleMeshlets, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_numVisibleMeshlets() const", AS_METHODPR(T, GetNumVisibleMeshlets, () const, unsigned), AS_CALL_THISCALL);
+
+    // bool MeshletModel::IsMeshletCullingActive() const
+    engine->RegisterObjectMethod(className, "bool IsMeshletCullingActive() const", AS_METHODPR(T, IsMeshletCullingActive, () const, bool), AS_CALL_THISCALL);
+
+    // void MeshletModel::SetMeshletCulling(bool enable)
+    engine->RegisterObjectMethod(className, "void SetMeshletCulling(bool)", AS_METHODPR(T, SetMeshletCulling, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_meshletCulling(bool)", AS_METHODPR(T, SetMeshletCulling, (bool), void), AS_CALL_THISCALL);
+
+    #ifdef REGISTER_MEMBERS_MANUAL_PART_MeshletModel
+        REGISTER_MEMBERS_MANUAL_PART_MeshletModel();
+    #endif
+}
+
 // class ParticleEmitter | File: ../Graphics/ParticleEmitter.h
 template <class T> void RegisterMembers_ParticleEmitter(asIScriptEngine* engine, const char* className)
 {
@@ -24871,6 +27042,10 @@ template <class T> void RegisterMembers_ParticleEmitter(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "bool GetSerializeParticles() const", AS_METHODPR(T, GetSerializeParticles, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_serializeParticles() const", AS_METHODPR(T, GetSerializeParticles, () const, bool), AS_CALL_THISCALL);
 
+    // bool ParticleEmitter::GetSignificanceUpdate() const
+    engine->RegisterObjectMethod(className, "bool GetSignificanceUpdate() const", AS_METHODPR(T, GetSignificanceUpdate, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_significanceUpdate() const", AS_METHODPR(T, GetSignificanceUpdate, () const, bool), AS_CALL_THISCALL);
+
     // bool ParticleEmitter::IsEmitting() const
     engine->RegisterObjectMethod(className, "bool IsEmitting() const", AS_METHODPR(T, IsEmitting, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_emitting() const", AS_METHODPR(T, IsEmitting, () const, bool), AS_CALL_THISCALL);
@@ -24907,6 +27082,10 @@ template <class T> void RegisterMembers_ParticleEmitter(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "void SetSerializeParticles(bool)", AS_METHODPR(T, SetSerializeParticles, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_serializeParticles(bool)", AS_METHODPR(T, SetSerializeParticles, (bool), void), AS_CALL_THISCALL);
 
+    // void ParticleEmitter::SetSignificanceUpdate(bool enable)
+    engine->RegisterObjectMethod(className, "void SetSignificanceUpdate(bool)", AS_METHODPR(T, SetSignificanceUpdate, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_significanceUpdate(bool)", AS_METHODPR(T, SetSignificanceUpdate, (bool), void), AS_CALL_THISCALL);
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_ParticleEmitter
         REGISTER_MEMBERS_MANUAL_PART_ParticleEmitter();
     #endif
@@ -25029,6 +27208,9 @@ template <class T> void RegisterMembers_ParticleEmitter2D(asIScriptEngine* engin
     // unsigned ParticleEmitter2D::GetMaxParticles() const
     engine->RegisterObjectMethod(className, "uint GetMaxParticles() const", AS_METHODPR(T, GetMaxParticles, () const, unsigned), AS_CALL_THISCALL);
 
+    // unsigned ParticleEmitter2D::GetNumParticles() const
+    engine->RegisterObjectMethod(className, "uint GetNumParticles() const", AS_METHODPR(T, GetNumParticles, () const, unsigned), AS_CALL_THISCALL);
+
     // ResourceRef ParticleEmitter2D::GetParticleEffectAttr() const
     engine->RegisterObjectMethod(className, "ResourceRef GetParticleEffectAttr() const", AS_METHODPR(T, GetParticleEffectAttr, () const, ResourceRef), AS_CALL_THISCALL);
 
@@ -25043,6 +27225,9 @@ template <class T> void RegisterMembers_ParticleEmitter2D(asIScriptEngine* engin
     engine->RegisterObjectMethod(className, "bool IsEmitting() const", AS_METHODPR(T, IsEmitting, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_emitting() const", AS_METHODPR(T, IsEmitting, () const, bool), AS_CALL_THISCALL);
 
+    // void ParticleEmitter2D::OnSpriteInstancingChanged() override
+    engine->RegisterObjectMethod(className, "void OnSpriteInstancingChanged()", AS_METHODPR(T, OnSpriteInstancingChanged, (), void), AS_CALL_THISCALL);
+
     // void ParticleEmitter2D::SetBlendMode(BlendMode blendMode)
     engine->RegisterObjectMethod(className, "void SetBlendMode(BlendMode)", AS_METHODPR(T, SetBlendMode, (BlendMode), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_blendMode(BlendMode)", AS_METHODPR(T, SetBlendMode, (BlendMode), void), AS_CALL_THISCALL);
@@ -25140,6 +27325,9 @@ template <class T> void RegisterMembers_StaticSprite2D(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "bool GetUseTextureRect() const", AS_METHODPR(T, GetUseTextureRect, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_useTextureRect() const", AS_METHODPR(T, GetUseTextureRect, () const, bool), AS_CALL_THISCALL);
 
+    // void StaticSprite2D::OnSpriteInstancingChanged() override
+    engine->RegisterObjectMethod(className, "void OnSpriteInstancingChanged()", AS_METHODPR(T, OnSpriteInstancingChanged, (), void), AS_CALL_THISCALL);
+
     // void StaticSprite2D::SetAlpha(float alpha)
     engine->RegisterObjectMethod(className, "void SetAlpha(float)", AS_METHODPR(T, SetAlpha, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_alpha(float)", AS_METHODPR(T, SetAlpha, (float), void), AS_CALL_THISCALL);
@@ -25323,6 +27511,10 @@ template <class T> void RegisterMembers_AnimatedSprite2D(asIScriptEngine* engine
     engine->RegisterObjectMethod(className, "LoopMode2D GetLoopMode() const", AS_METHODPR(T, GetLoopMode, () const, LoopMode2D), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "LoopMode2D get_loopMode() const", AS_METHODPR(T, GetLoopMode, () const, LoopMode2D), AS_CALL_THISCALL);
 
+    // float AnimatedSprite2D::GetPoseCacheInterval() const
+    engine->RegisterObjectMethod(className, "float GetPoseCacheInterval() const", AS_METHODPR(T, GetPoseCacheInterval, () const, float), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "float get_poseCacheInterval() const", AS_METHODPR(T, GetPoseCacheInterval, () const, float), AS_CALL_THISCALL);
+
     // float AnimatedSprite2D::GetSpeed() const
     engine->RegisterObjectMethod(className, "float GetSpeed() const", AS_METHODPR(T, GetSpeed, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_speed() const", AS_METHODPR(T, GetSpeed, () const, float), AS_CALL_THISCALL);
@@ -25349,6 +27541,10 @@ template <class T> void RegisterMembers_AnimatedSprite2D(asIScriptEngine* engine
     engine->RegisterObjectMethod(className, "void SetLoopMode(LoopMode2D)", AS_METHODPR(T, SetLoopMode, (LoopMode2D), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_loopMode(LoopMode2D)", AS_METHODPR(T, SetLoopMode, (LoopMode2D), void), AS_CALL_THISCALL);
 
+    // void AnimatedSprite2D::SetPoseCacheInterval(float interval)
+    engine->RegisterObjectMethod(className, "void SetPoseCacheInterval(float)", AS_METHODPR(T, SetPoseCacheInterval, (float), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_poseCacheInterval(float)", AS_METHODPR(T, SetPoseCacheInterval, (float), void), AS_CALL_THISCALL);
+
     // void AnimatedSprite2D::SetSpeed(float speed)
     engine->RegisterObjectMethod(className, "void SetSpeed(float)", AS_METHODPR(T, SetSpeed, (float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_speed(float)", AS_METHODPR(T, SetSpeed, (float), void), AS_CALL_THISCALL);
@@ -452,9 +452,30 @@ void ASRegisterGeneratedObjectTypes(asIScriptEngine* engine)
     // struct ManifoldPair | File: ../Physics/PhysicsWorld.h
     engine->RegisterObjectType("ManifoldPair", sizeof(ManifoldPair), asOBJ_VALUE | asGetTypeTraits<ManifoldPair>());
 
+    // struct NodeCollisionEventData | File: ../Physics/PhysicsEvents.h
+    // Not registered because have @nobind mark
+
+    // struct PhysicsCollisionEventData | File: ../Physics/PhysicsEvents.h
+    // Not registered because have @nobind mark
+
+    // struct PhysicsContactPair | File: ../Physics/PhysicsWorld.h
+    // Not registered because have @nobind mark
+
+    // struct PhysicsContactPoint | File: ../Physics/PhysicsEvents.h
+    // Not registered because have @nobind mark
+
+    // struct PhysicsQuery | File: ../Physics/PhysicsWorld.h
+    // Not registered because have @nobind mark
+
+    // class PhysicsQueryBatch | File: ../Physics/PhysicsWorld.h
+    // Not registered because have @nobind mark
+
     // struct PhysicsRaycastResult | File: ../Physics/PhysicsWorld.h
     engine->RegisterObjectType("PhysicsRaycastResult", sizeof(PhysicsRaycastResult), asOBJ_VALUE | asGetTypeTraits<PhysicsRaycastResult>());
 
+    // struct PhysicsStatistics | File: ../Physics/PhysicsWorld.h
+    engine->RegisterObjectType("PhysicsStatistics", sizeof(PhysicsStatistics), asOBJ_VALUE | asGetTypeTraits<PhysicsStatistics>());
+
     // struct PhysicsWorldConfig | File: ../Physics/PhysicsWorld.h
     engine->RegisterObjectType("PhysicsWorldConfig", sizeof(PhysicsWorldConfig), asOBJ_VALUE | asGetTypeTraits<PhysicsWorldConfig>());
 #endif
@@ -463,6 +484,12 @@ void ASRegisterGeneratedObjectTypes(asIScriptEngine* engine)
     // struct DelayedWorldTransform2D | File: ../Physics2D/PhysicsWorld2D.h
     engine->RegisterObjectType("DelayedWorldTransform2D", sizeof(DelayedWorldTransform2D), asOBJ_VALUE | asGetTypeTraits<DelayedWorldTransform2D>());
 
+    // struct PhysicsQuery2D | File: ../Physics2D/PhysicsWorld2D.h
+    // Not registered because have @nobind mark
+
+    // class PhysicsQueryBatch2D | File: ../Physics2D/PhysicsWorld2D.h
+    // Not registered because have @nobind mark
+
     // struct PhysicsRaycastResult2D | File: ../Physics2D/PhysicsWorld2D.h
     engine->RegisterObjectType("PhysicsRaycastResult2D", sizeof(PhysicsRaycastResult2D), asOBJ_VALUE | asGetTypeTraits<PhysicsRaycastResult2D>());
 #endif
@@ -502,6 +529,9 @@ void ASRegisterGeneratedObjectTypes(asIScriptEngine* engine)
     // struct BatchGroup | File: ../Graphics/Batch.h
     engine->RegisterObjectType("BatchGroup", sizeof(BatchGroup), asOBJ_VALUE | asGetTypeTraits<BatchGroup>());
 
+    // class BoundedStringHashRegister | File: ../Core/StringHashRegister.h
+    // Not registered because have @nobind mark
+
     // class BoxOctreeQuery | File: ../Graphics/OctreeQuery.h
     // Not registered because have @nobind mark
 
@@ -597,6 +627,9 @@ void ASRegisterGeneratedObjectTypes(asIScriptEngine* engine)
     engine->RegisterObjectType("TmxLayer2D", 0, asOBJ_REF);
 #endif
 
+    // class AdpcmSoundStream | File: ../Audio/AdpcmSoundStream.h
+    engine->RegisterObjectType("AdpcmSoundStream", 0, asOBJ_REF);
+
     // class AttributeAnimationInfo | File: ../Scene/Animatable.h
     engine->RegisterObjectType("AttributeAnimationInfo", 0, asOBJ_REF);
 
@@ -657,12 +690,18 @@ void ASRegisterGeneratedObjectTypes(asIScriptEngine* engine)
     // class Log | File: ../IO/Log.h
     engine->RegisterObjectType("Log", 0, asOBJ_REF);
 
+    // class MaterialAtlas | File: ../Graphics/MaterialAtlas.h
+    engine->RegisterObjectType("MaterialAtlas", 0, asOBJ_REF);
+
     // class MemoryBuffer | File: ../IO/MemoryBuffer.h
     // Not registered because have @nobind mark
 
     // class MessageBox | File: ../UI/MessageBox.h
     engine->RegisterObjectType("MessageBox", 0, asOBJ_REF);
 
+    // class Metrics | File: ../Core/Metrics.h
+    engine->RegisterObjectType("Metrics", 0, asOBJ_REF);
+
     // class NamedPipe | File: ../IO/NamedPipe.h
     engine->RegisterObjectType("NamedPipe", 0, asOBJ_REF);
 
@@ -782,6 +821,9 @@ void ASRegisterGeneratedObjectTypes(asIScriptEngine* engine)
     // class ParticleEffect | File: ../Graphics/ParticleEffect.h
     engine->RegisterObjectType("ParticleEffect", 0, asOBJ_REF);
 
+    // class PrefabTemplate | File: ../Scene/PrefabTemplate.h
+    engine->RegisterObjectType("PrefabTemplate", 0, asOBJ_REF);
+
     // class ResourceWithMetadata | File: ../Resource/Resource.h
     engine->RegisterObjectType("ResourceWithMetadata", 0, asOBJ_REF);
 
@@ -859,9 +901,15 @@ void ASRegisterGeneratedObjectTypes(asIScriptEngine* engine)
     // class Scene | File: ../Scene/Scene.h
     engine->RegisterObjectType("Scene", 0, asOBJ_REF);
 
+    // class SceneStreamer | File: ../Scene/SceneStreamer.h
+    engine->RegisterObjectType("SceneStreamer", 0, asOBJ_REF);
+
     // class ScrollView | File: ../UI/ScrollView.h
     engine->RegisterObjectType("ScrollView", 0, asOBJ_REF);
 
+    // class SignificanceManager | File: ../Graphics/SignificanceManager.h
+    engine->RegisterObjectType("SignificanceManager", 0, asOBJ_REF);
+
     // class SmoothedTransform | File: ../Scene/SmoothedTransform.h
     engine->RegisterObjectType("SmoothedTransform", 0, asOBJ_REF);
 
@@ -880,6 +928,9 @@ void ASRegisterGeneratedObjectTypes(asIScriptEngine* engine)
     // class Terrain | File: ../Graphics/Terrain.h
     engine->RegisterObjectType("Terrain", 0, asOBJ_REF);
 
+    // class TerrainStreamer | File: ../Graphics/TerrainStreamer.h
+    engine->RegisterObjectType("TerrainStreamer", 0, asOBJ_REF);
+
     // class Texture2D | File: ../Graphics/Texture2D.h
     engine->RegisterObjectType("Texture2D", 0, asOBJ_REF);
 
@@ -1012,6 +1063,9 @@ void ASRegisterGeneratedObjectTypes(asIScriptEngine* engine)
     // class RibbonTrail | File: ../Graphics/RibbonTrail.h
     engine->RegisterObjectType("RibbonTrail", 0, asOBJ_REF);
 
+    // class ScatterModel | File: ../Graphics/ScatterModel.h
+    engine->RegisterObjectType("ScatterModel", 0, asOBJ_REF);
+
     // class ScrollBar | File: ../UI/ScrollBar.h
     engine->RegisterObjectType("ScrollBar", 0, asOBJ_REF);
 
@@ -1113,6 +1167,9 @@ void ASRegisterGeneratedObjectTypes(asIScriptEngine* engine)
     // class Menu | File: ../UI/Menu.h
     engine->RegisterObjectType("Menu", 0, asOBJ_REF);
 
+    // class MeshletModel | File: ../Graphics/MeshletModel.h
+    engine->RegisterObjectType("MeshletModel", 0, asOBJ_REF);
+
     // class ParticleEmitter | File: ../Graphics/ParticleEmitter.h
     engine->RegisterObjectType("ParticleEmitter", 0, asOBJ_REF);
 
@@ -35,6 +35,7 @@ void ASRegisterManualFirst_Container(asIScriptEngine* engine)
 
 // Workaround for GCC to allow get addresses
 const unsigned String::NPOS;
+const unsigned String::LOCAL_CAPACITY;
 const unsigned String::MIN_CAPACITY;
 const unsigned HashBase::MIN_BUCKETS;
 const unsigned HashBase::MAX_LOAD_FACTOR;
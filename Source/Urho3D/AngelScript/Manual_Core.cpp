@@ -89,6 +89,85 @@ static CScriptArray* VariantMap_GetValues(const VariantMap& map)
     return VectorToArray<Variant>(map.Values(), "Array<Variant>");
 }
 
+// Typed lookups for reading event parameters. Unlike opIndex they never insert missing keys and return the default value instead
+static bool VariantMap_GetBool(StringHash key, bool defaultValue, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetBool() : defaultValue;
+}
+
+static int VariantMap_GetInt(StringHash key, int defaultValue, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetInt() : defaultValue;
+}
+
+static unsigned VariantMap_GetUInt(StringHash key, unsigned defaultValue, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetUInt() : defaultValue;
+}
+
+static float VariantMap_GetFloat(StringHash key, float defaultValue, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetFloat() : defaultValue;
+}
+
+static double VariantMap_GetDouble(StringHash key, double defaultValue, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetDouble() : defaultValue;
+}
+
+static String VariantMap_GetString(StringHash key, const String& defaultValue, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetString() : defaultValue;
+}
+
+static Vector2 VariantMap_GetVector2(StringHash key, const Vector2& defaultValue, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetVector2() : defaultValue;
+}
+
+static Vector3 VariantMap_GetVector3(StringHash key, const Vector3& defaultValue, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetVector3() : defaultValue;
+}
+
+static Vector4 VariantMap_GetVector4(StringHash key, const Vector4& defaultValue, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetVector4() : defaultValue;
+}
+
+static Quaternion VariantMap_GetQuaternion(StringHash key, const Quaternion& defaultValue, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetQuaternion() : defaultValue;
+}
+
+static Color VariantMap_GetColor(StringHash key, const Color& defaultValue, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetColor() : defaultValue;
+}
+
+static StringHash VariantMap_GetStringHash(StringHash key, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetStringHash() : StringHash::ZERO;
+}
+
+static RefCounted* VariantMap_GetPtr(StringHash key, const VariantMap& map)
+{
+    const Variant* value = map[key];
+    return value ? value->GetPtr() : nullptr;
+}
+
 static void RegisterVariantMap(asIScriptEngine* engine)
 {
     // using VariantMap = HashMap<StringHash, Variant> | File: ../Core/Variant.h
@@ -134,6 +213,21 @@ static void RegisterVariantMap(asIScriptEngine* engine)
     // using VariantMap = HashMap<StringHash, Variant> | File: ../Core/Variant.h
     // Vector<U> HashMap::Values() const | File: ../Container/HashMap.h
     engine->RegisterObjectMethod("VariantMap", "Array<Variant>@ get_values() const", AS_FUNCTION_OBJLAST(VariantMap_GetValues), AS_CALL_CDECL_OBJLAST);
+
+    // Typed lookups without insertion
+    engine->RegisterObjectMethod("VariantMap", "bool GetBool(StringHash, bool = false) const", AS_FUNCTION_OBJLAST(VariantMap_GetBool), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "int GetInt(StringHash, int = 0) const", AS_FUNCTION_OBJLAST(VariantMap_GetInt), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "uint GetUInt(StringHash, uint = 0) const", AS_FUNCTION_OBJLAST(VariantMap_GetUInt), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "float GetFloat(StringHash, float = 0.0f) const", AS_FUNCTION_OBJLAST(VariantMap_GetFloat), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "double GetDouble(StringHash, double = 0.0) const", AS_FUNCTION_OBJLAST(VariantMap_GetDouble), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "String GetString(StringHash, const String&in = String()) const", AS_FUNCTION_OBJLAST(VariantMap_GetString), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "Vector2 GetVector2(StringHash, const Vector2&in = Vector2()) const", AS_FUNCTION_OBJLAST(VariantMap_GetVector2), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "Vector3 GetVector3(StringHash, const Vector3&in = Vector3()) const", AS_FUNCTION_OBJLAST(VariantMap_GetVector3), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "Vector4 GetVector4(StringHash, const Vector4&in = Vector4()) const", AS_FUNCTION_OBJLAST(VariantMap_GetVector4), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "Quaternion GetQuaternion(StringHash, const Quaternion&in = Quaternion()) const", AS_FUNCTION_OBJLAST(VariantMap_GetQuaternion), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "Color GetColor(StringHash, const Color&in = Color()) const", AS_FUNCTION_OBJLAST(VariantMap_GetColor), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "StringHash GetStringHash(StringHash) const", AS_FUNCTION_OBJLAST(VariantMap_GetStringHash), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("VariantMap", "RefCounted@+ GetPtr(StringHash) const", AS_FUNCTION_OBJLAST(VariantMap_GetPtr), AS_CALL_CDECL_OBJLAST);
 }
 
 // ========================================================================================
@@ -373,6 +467,12 @@ static Time* GetTime()
     return GetScriptContext()->GetSubsystem<Time>();
 }
 
+// template <class T> T* Context::GetSubsystem() const | File: ../Core/Context.h
+static Metrics* GetMetrics()
+{
+    return GetScriptContext()->GetSubsystem<Metrics>();
+}
+
 // This function is called after ASRegisterGenerated()
 void ASRegisterManualLast_Core(asIScriptEngine* engine)
 {
@@ -383,6 +483,7 @@ void ASRegisterManualLast_Core(asIScriptEngine* engine)
 
     // template <class T> T* Context::GetSubsystem() const | File: ../Core/Context.h
     engine->RegisterGlobalFunction("Time@+ get_time()", AS_FUNCTION(GetTime), AS_CALL_CDECL);
+    engine->RegisterGlobalFunction("Metrics@+ get_metrics()", AS_FUNCTION(GetMetrics), AS_CALL_CDECL);
 }
 
 }
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../Core/Metrics.h"
 #include "../Core/Spline.h"
 #include "../Core/Variant.h"
 
@@ -44,6 +45,20 @@ template <class T> CScriptArray* AttributeInfo_GetEnumNames(T* ptr)
 
 // ========================================================================================
 
+// bool Metrics::GetHistory(const String& subsystem, const String& name, PODVector<double>& dest, const String& labels = String::EMPTY) const | File: ../Core/Metrics.h
+template <class T> CScriptArray* Metrics_GetHistory(const String& subsystem, const String& name, const String& labels, T* ptr)
+{
+    PODVector<double> history;
+    ptr->GetHistory(subsystem, name, history, labels);
+    return VectorToArray<double>(history, "Array<double>");
+}
+
+#define REGISTER_MEMBERS_MANUAL_PART_Metrics() \
+    /* bool Metrics::GetHistory(const String& subsystem, const String& name, PODVector<double>& dest, const String& labels = String::EMPTY) const | File: ../Core/Metrics.h */ \
+    engine->RegisterObjectMethod(className, "Array<double>@ GetHistory(const String&in, const String&in, const String&in = String::EMPTY) const", AS_FUNCTION_OBJLAST(Metrics_GetHistory<T>), AS_CALL_CDECL_OBJLAST);
+
+// ========================================================================================
+
 // StringVector ResourceRefList::names_ | File: ../Core/Variant.h
 template <class T> void ResourceRefList_Resize(unsigned size, ResourceRefList* ptr)
 {
@@ -69,6 +69,11 @@ static CScriptArray* DbResultGetRow(unsigned index, DbResult* ptr)
         return VectorToArray<Variant>(rows[index], "Array<Variant>");
 }
 
+static CScriptArray* DbResultGetColumnValues(unsigned index, DbResult* ptr)
+{
+    return VectorToArray<Variant>(ptr->GetColumnValues(index), "Array<Variant>");
+}
+
 static void RegisterDbResult(asIScriptEngine* engine)
 {
     engine->RegisterObjectBehaviour("DbResult", asBEHAVE_CONSTRUCT, "void f()", AS_FUNCTION_OBJLAST(ConstructDbResult), AS_CALL_CDECL_OBJLAST);
@@ -80,6 +85,9 @@ static void RegisterDbResult(asIScriptEngine* engine)
     engine->RegisterObjectMethod("DbResult", "int64 get_numAffectedRows() const", AS_METHOD(DbResult, GetNumAffectedRows), AS_CALL_THISCALL);
     engine->RegisterObjectMethod("DbResult", "Array<String>@ get_columns() const", AS_FUNCTION_OBJLAST(DbResultGetColumns), AS_CALL_CDECL_OBJLAST);
     engine->RegisterObjectMethod("DbResult", "Array<Variant>@ get_row(uint) const", AS_FUNCTION_OBJLAST(DbResultGetRow), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("DbResult", "bool get_columnar() const", AS_METHOD(DbResult, IsColumnar), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod("DbResult", "Array<Variant>@ GetColumnValues(uint) const", AS_FUNCTION_OBJLAST(DbResultGetColumnValues), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("DbResult", "const Variant& GetValue(uint, uint) const", AS_METHOD(DbResult, GetValue), AS_CALL_THISCALL);
 }
 
 // ========================================================================================
@@ -92,13 +100,25 @@ static DbConnection* DbConnection_DbConnection_Context()
 }
 */
 
+#ifdef URHO3D_DATABASE_SQLITE
+static DbResult DbConnectionExecuteParameters(const String& sql, CScriptArray* parameters, bool useCursorEvent, DbConnection* ptr)
+{
+    return ptr->Execute(sql, ArrayToVector<Variant>(parameters), useCursorEvent);
+}
+#endif
+
 static void RegisterDbConnection(asIScriptEngine* engine)
 {
     RegisterMembers_Object<DbConnection>(engine, "DbConnection");
 
     //engine->RegisterObjectBehaviour("DbConnection", asBEHAVE_FACTORY, "DbConnection@+ f()", AS_FUNCTION(DbConnection_DbConnection_Context), AS_CALL_CDECL);
 
-    engine->RegisterObjectMethod("DbConnection", "DbResult Execute(const String&in, bool useCursorEvent = false)", AS_METHOD(DbConnection, Execute), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod("DbConnection", "DbResult Execute(const String&in, bool useCursorEvent = false)", AS_METHODPR(DbConnection, Execute, (const String&, bool), DbResult), AS_CALL_THISCALL);
+#ifdef URHO3D_DATABASE_SQLITE
+    engine->RegisterObjectMethod("DbConnection", "DbResult Execute(const String&in, Array<Variant>@+, bool useCursorEvent = false)", AS_FUNCTION_OBJLAST(DbConnectionExecuteParameters), AS_CALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("DbConnection", "uint get_numCachedStatements() const", AS_METHOD(DbConnection, GetNumCachedStatements), AS_CALL_THISCALL);
+#endif
+    engine->RegisterObjectMethod("DbConnection", "uint ExecuteAsync(const String&in)", AS_METHOD(DbConnection, ExecuteAsync), AS_CALL_THISCALL);
     engine->RegisterObjectMethod("DbConnection", "const String& get_connectionString() const", AS_METHOD(DbConnection, GetConnectionString), AS_CALL_THISCALL);
     engine->RegisterObjectMethod("DbConnection", "bool get_connected() const", AS_METHOD(DbConnection, IsConnected), AS_CALL_THISCALL);
 
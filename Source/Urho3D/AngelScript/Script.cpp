@@ -27,8 +27,10 @@
 #include "../AngelScript/ScriptAPI.h"
 #include "../AngelScript/ScriptFile.h"
 #include "../AngelScript/ScriptInstance.h"
+#include "../AngelScript/ScriptUpdateDispatcher.h"
 #include "../AngelScript/RegistrationMacros.h"
 #include "../Core/Profiler.h"
+#include "../Core/Timer.h"
 #include "../Engine/EngineEvents.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
@@ -40,6 +42,9 @@
 namespace Urho3D
 {
 
+/// User data type of the cached function profile of a script function.
+static const asPWORD FUNCTION_PROFILE = 1001;
+
 class ScriptResourceRouter : public ResourceRouter
 {
     URHO3D_OBJECT(ScriptResourceRouter, ResourceRouter);
@@ -199,6 +204,11 @@ Script::Script(Context* context) :
     // Subscribe to console commands
     SetExecuteConsoleCommands(true);
 
+    // Cache the bytecode of compiled scripts in the application preferences directory by default
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    if (fileSystem)
+        SetByteCodeCacheDir(fileSystem->GetAppPreferencesDir("urho3d", "scriptcache"));
+
     // Create and register resource router for checking for compiled AngelScript files
     auto* cache = GetSubsystem<ResourceCache>();
     if (cache)
@@ -259,6 +269,7 @@ bool Script::Execute(const String& line)
     }
 
     bool success = immediateContext_->Execute() >= 0;
+    EndProfiledCalls(immediateContext_);
     immediateContext_->Unprepare();
     function->Release();
 
@@ -287,6 +298,62 @@ void Script::SetExecuteConsoleCommands(bool enable)
         UnsubscribeFromEvent(E_CONSOLECOMMAND);
 }
 
+void Script::SetByteCodeCacheDir(const String& path)
+{
+    String trimmedPath = path.Trimmed();
+    byteCodeCacheDir_ = trimmedPath.Length() ? AddTrailingSlash(trimmedPath) : String::EMPTY;
+}
+
+void Script::SetGCTimeBudget(unsigned usec)
+{
+    if (usec == gcTimeBudget_)
+        return;
+
+    gcTimeBudget_ = usec;
+    gcStatistics_ = ScriptGCStatistics();
+
+    // The automatic collector runs whenever a script context finishes, which can stall an arbitrary frame
+    scriptEngine_->SetEngineProperty(asEP_AUTO_GARBAGE_COLLECT, (asPWORD)(usec == 0));
+    if (usec)
+        SubscribeToEvent(E_FRAMEIDLE, URHO3D_HANDLER(Script, HandleFrameIdle));
+    else
+        UnsubscribeFromEvent(E_FRAMEIDLE);
+}
+
+void Script::SetProfiling(bool enable)
+{
+    if (enable == profiling_)
+        return;
+
+    profiling_ = enable;
+    if (enable)
+    {
+        if (!profiler_)
+            profiler_ = new ScriptProfiler(GetSubsystem<Profiler>());
+        else
+            profiler_->Reset();
+
+        immediateContext_->SetLineCallback(asMETHOD(Script, ProfileLineCallback), this, asCALL_THISCALL);
+        for (unsigned i = 0; i < scriptFileContexts_.Size(); ++i)
+            scriptFileContexts_[i]->SetLineCallback(asMETHOD(Script, ProfileLineCallback), this, asCALL_THISCALL);
+    }
+    else
+    {
+        immediateContext_->ClearLineCallback();
+        for (unsigned i = 0; i < scriptFileContexts_.Size(); ++i)
+            scriptFileContexts_[i]->ClearLineCallback();
+
+        profiler_->EndCalls(0);
+        profiledContexts_.Clear();
+        URHO3D_LOGINFO("Script function profile:\n" + profiler_->PrintData());
+    }
+}
+
+String Script::PrintProfilingData(unsigned maxFunctions) const
+{
+    return profiler_ ? profiler_->PrintData(maxFunctions) : String::EMPTY;
+}
+
 void Script::MessageCallback(const asSMessageInfo* msg)
 {
     String message;
@@ -410,6 +477,8 @@ asIScriptContext* Script::GetScriptFileContext()
     {
         asIScriptContext* newContext = scriptEngine_->CreateContext();
         newContext->SetExceptionCallback(asMETHOD(Script, ExceptionCallback), this, asCALL_THISCALL);
+        if (profiling_)
+            newContext->SetLineCallback(asMETHOD(Script, ProfileLineCallback), this, asCALL_THISCALL);
 
         scriptFileContexts_.Push(newContext);
     }
@@ -417,6 +486,85 @@ asIScriptContext* Script::GetScriptFileContext()
     return scriptFileContexts_[scriptNestingLevel_];
 }
 
+ScriptUpdateDispatcher* Script::GetUpdateDispatcher(Scene* scene)
+{
+    if (!scene)
+        return nullptr;
+
+    HashMap<Scene*, SharedPtr<ScriptUpdateDispatcher> >::Iterator i = updateDispatchers_.Find(scene);
+    if (i != updateDispatchers_.End() && i->second_->GetScene() == scene)
+        return i->second_;
+
+    // Forget the dispatchers of destroyed scenes, one of which may have had the same address
+    for (i = updateDispatchers_.Begin(); i != updateDispatchers_.End();)
+    {
+        if (!i->second_->GetScene())
+            i = updateDispatchers_.Erase(i);
+        else
+            ++i;
+    }
+
+    SharedPtr<ScriptUpdateDispatcher> dispatcher(new ScriptUpdateDispatcher(context_, scene));
+    updateDispatchers_[scene] = dispatcher;
+    return dispatcher;
+}
+
+unsigned Script::GetAPIHash()
+{
+    if (apiHash_)
+        return apiHash_;
+
+    // Hash the declarations of everything the application has registered, so that adding, removing or changing
+    // any function, property or type invalidates the cached bytecode
+    unsigned hash = StringHash::Calculate(ANGELSCRIPT_VERSION_STRING);
+
+    for (asUINT i = 0; i < scriptEngine_->GetGlobalFunctionCount(); ++i)
+        hash = StringHash::Calculate(scriptEngine_->GetGlobalFunctionByIndex(i)->GetDeclaration(true, true, true), hash);
+
+    for (asUINT i = 0; i < scriptEngine_->GetGlobalPropertyCount(); ++i)
+    {
+        const char* name = nullptr;
+        const char* nameSpace = nullptr;
+        int typeId = 0;
+        scriptEngine_->GetGlobalPropertyByIndex(i, &name, &nameSpace, &typeId);
+        hash = StringHash::Calculate(nameSpace, StringHash::Calculate(name, hash));
+        hash = StringHash::Calculate(scriptEngine_->GetTypeDeclaration(typeId, true), hash);
+    }
+
+    for (asUINT i = 0; i < scriptEngine_->GetObjectTypeCount(); ++i)
+    {
+        asITypeInfo* type = scriptEngine_->GetObjectTypeByIndex(i);
+        hash = StringHash::Calculate(type->GetName(), hash);
+        for (asUINT j = 0; j < type->GetBehaviourCount(); ++j)
+        {
+            asEBehaviours behaviour;
+            hash = StringHash::Calculate(type->GetBehaviourByIndex(j, &behaviour)->GetDeclaration(true, true, true), hash);
+        }
+        for (asUINT j = 0; j < type->GetMethodCount(); ++j)
+            hash = StringHash::Calculate(type->GetMethodByIndex(j)->GetDeclaration(true, true, true), hash);
+        for (asUINT j = 0; j < type->GetPropertyCount(); ++j)
+            hash = StringHash::Calculate(type->GetPropertyDeclaration(j, true), hash);
+    }
+
+    for (asUINT i = 0; i < scriptEngine_->GetEnumCount(); ++i)
+    {
+        asITypeInfo* type = scriptEngine_->GetEnumByIndex(i);
+        hash = StringHash::Calculate(type->GetName(), hash);
+        for (asUINT j = 0; j < type->GetEnumValueCount(); ++j)
+        {
+            int value = 0;
+            hash = StringHash::Calculate(type->GetEnumValueByIndex(j, &value), hash);
+            hash = StringHash::Calculate(String(value).CString(), hash);
+        }
+    }
+
+    for (asUINT i = 0; i < scriptEngine_->GetFuncdefCount(); ++i)
+        hash = StringHash::Calculate(scriptEngine_->GetFuncdefByIndex(i)->GetFuncdefSignature()->GetDeclaration(true, true, true), hash);
+
+    apiHash_ = hash ? hash : 1;
+    return apiHash_;
+}
+
 void Script::HandleConsoleCommand(StringHash eventType, VariantMap& eventData)
 {
     using namespace ConsoleCommand;
@@ -424,6 +572,95 @@ void Script::HandleConsoleCommand(StringHash eventType, VariantMap& eventData)
         Execute(eventData[P_COMMAND].GetString());
 }
 
+void Script::HandleFrameIdle(StringHash eventType, VariantMap& eventData)
+{
+    using namespace FrameIdle;
+
+    URHO3D_PROFILE(ScriptCollectGarbage);
+
+    int idleTime = eventData[P_TIMEBUDGET].GetInt();
+    long long budget = Max((long long)gcTimeBudget_, (long long)idleTime);
+
+    // Step until the time budget is used up, but finish at most one cycle per frame
+    HiresTimer timer;
+    long long elapsed = 0;
+    gcStatistics_.numSteps_ = 0;
+    for (;;)
+    {
+        ++gcStatistics_.numSteps_;
+        int result = scriptEngine_->GarbageCollect(asGC_ONE_STEP | asGC_DETECT_GARBAGE | asGC_DESTROY_GARBAGE);
+        elapsed = timer.GetUSec(false);
+        if (result == 0)
+            ++gcStatistics_.numCycles_;
+        if (result <= 0 || elapsed >= budget)
+            break;
+    }
+
+    asUINT currentSize, totalDestroyed;
+    scriptEngine_->GetGCStatistics(&currentSize, &totalDestroyed);
+    gcStatistics_.numObjects_ = currentSize;
+    gcStatistics_.numDestroyed_ = totalDestroyed;
+    gcStatistics_.collectTime_ = elapsed / 1000.0f;
+
+    eventData[P_TIMEBUDGET] = (int)Max((long long)idleTime - elapsed, 0LL);
+}
+
+void Script::EndProfiledContext(asIScriptContext* context)
+{
+    HashMap<asIScriptContext*, unsigned>::Iterator i = profiledContexts_.Find(context);
+    if (i == profiledContexts_.End())
+        return;
+
+    profiler_->EndCalls(i->second_);
+    profiledContexts_.Erase(i);
+}
+
+void Script::ProfileLineCallback(asIScriptContext* context)
+{
+    // The callback is invoked on entering each function and on each statement, so returns are only noticed on the next
+    // callback. Compare the open calls of the context against its callstack, starting from the innermost function
+    HashMap<asIScriptContext*, unsigned>::Iterator i = profiledContexts_.Find(context);
+    if (i == profiledContexts_.End())
+        i = profiledContexts_.Insert(MakePair(context, profiler_->GetDepth()));
+
+    unsigned base = i->second_;
+    unsigned depth = context->GetCallstackSize();
+    unsigned open = profiler_->GetDepth() > base ? profiler_->GetDepth() - base : 0;
+
+    while (open > depth || (open && profiler_->GetCurrentKey() != context->GetFunction(depth - open)))
+    {
+        profiler_->EndCall();
+        --open;
+    }
+
+    while (open < depth)
+    {
+        asIScriptFunction* function = context->GetFunction(depth - 1 - open);
+        profiler_->BeginCall(GetFunctionProfile(function), function);
+        ++open;
+    }
+}
+
+ScriptFunctionProfile* Script::GetFunctionProfile(asIScriptFunction* function)
+{
+    if (!function)
+        return profiler_->GetFunction("(unknown)");
+
+    auto* profile = static_cast<ScriptFunctionProfile*>(function->GetUserData(FUNCTION_PROFILE));
+    if (!profile)
+    {
+        String name(function->GetDeclaration(true, true));
+        const char* section = function->GetScriptSectionName();
+        if (section && *section)
+            name += " (" + String(section) + ")";
+
+        profile = profiler_->GetFunction(name);
+        function->SetUserData(profile, FUNCTION_PROFILE);
+    }
+
+    return profile;
+}
+
 void RegisterScriptLibrary(Context* context)
 {
     ScriptFile::RegisterObject(context);
@@ -26,9 +26,11 @@
 
 #include "../Core/Mutex.h"
 #include "../Core/Object.h"
+#include "../Core/ScriptProfiler.h"
 
 class asIScriptContext;
 class asIScriptEngine;
+class asIScriptFunction;
 class asIScriptModule;
 class asITypeInfo;
 
@@ -43,6 +45,22 @@ class ResourceRouter;
 class Scene;
 class ScriptFile;
 class ScriptInstance;
+class ScriptUpdateDispatcher;
+
+/// Garbage collection statistics of the AngelScript engine when collecting with a time budget.
+struct URHO3D_API ScriptGCStatistics
+{
+    /// Number of incremental collection steps on the latest frame.
+    unsigned numSteps_{};
+    /// Number of completed collection cycles since the time budget was set.
+    unsigned numCycles_{};
+    /// Number of objects currently known by the garbage collector.
+    unsigned numObjects_{};
+    /// Total number of objects destroyed by the garbage collector.
+    unsigned numDestroyed_{};
+    /// Collection time on the latest frame in milliseconds.
+    float collectTime_{};
+};
 
 /// Output mode for DumpAPI method.
 enum DumpMode
@@ -59,6 +77,7 @@ class URHO3D_API Script : public Object
 
     friend class ScriptFile;
     friend class ScriptInstance;
+    friend class ScriptUpdateDispatcher;
 
 public:
     /// Construct.
@@ -74,6 +93,12 @@ public:
     void SetDefaultScene(Scene* scene);
     /// Set whether to execute engine console commands as script code.
     void SetExecuteConsoleCommands(bool enable);
+    /// Set the directory where bytecode of compiled script files is cached, so that unchanged scripts are not compiled again. Empty path disables the cache. Default is the "scriptcache" application preferences directory.
+    void SetByteCodeCacheDir(const String& path);
+    /// Set the minimum time in microseconds spent on incremental garbage collection each frame. The collection also uses the idle time until the frame limit reported by the engine. Zero (default) leaves garbage collection to the automatic collector of AngelScript.
+    void SetGCTimeBudget(unsigned usec);
+    /// Set whether to profile the time spent in each script function. Enabling clears the previous timings.
+    void SetProfiling(bool enable);
     /// Print the whole script API (all registered classes, methods and properties) to the log. No-ops when URHO3D_LOGGING not defined.
     void DumpAPI(DumpMode mode = DOXYGEN, const String& sourceTree = String::EMPTY);
     /// Log a message from the script engine.
@@ -97,6 +122,23 @@ public:
     /// Return whether is executing engine console commands as script code.
     bool GetExecuteConsoleCommands() const { return executeConsoleCommands_; }
 
+    /// Return the bytecode cache directory.
+    const String& GetByteCodeCacheDir() const { return byteCodeCacheDir_; }
+
+    /// Return the per-frame garbage collection time budget in microseconds.
+    unsigned GetGCTimeBudget() const { return gcTimeBudget_; }
+
+    /// Return garbage collection statistics. Only updated when collecting with a time budget.
+    const ScriptGCStatistics& GetGCStatistics() const { return gcStatistics_; }
+
+    /// Return whether is profiling script functions.
+    bool IsProfiling() const { return profiling_; }
+    /// Return the script function profiler, or null if profiling has not been enabled.
+    /// @nobind
+    ScriptProfiler* GetProfiler() const { return profiler_.Get(); }
+    /// Return the script function timings as text, sorted by descending self time.
+    String PrintProfilingData(unsigned maxFunctions = M_MAX_UNSIGNED) const;
+
     /// Clear the inbuild object type cache.
     void ClearObjectTypeCache();
     /// Query for an inbuilt object type by constant declaration. Can not be used for script types.
@@ -107,6 +149,9 @@ public:
 
     /// Returns an array of strings of enum value names for Enum Attributes.
     const char** GetEnumValues(int asTypeID);
+    /// Return the dispatcher of script object update methods for a scene. Created on first use.
+    /// @nobind
+    ScriptUpdateDispatcher* GetUpdateDispatcher(Scene* scene);
 
 
 private:
@@ -121,10 +166,26 @@ private:
 
     /// Return a script function/method execution context for the current execution nesting level.
     asIScriptContext* GetScriptFileContext();
+    /// End the profiled calls of a context after its execution finished.
+    void EndProfiledCalls(asIScriptContext* context)
+    {
+        if (profiling_)
+            EndProfiledContext(context);
+    }
+    /// Remove a context from the profiled contexts and end its open calls.
+    void EndProfiledContext(asIScriptContext* context);
+    /// Line callback for profiling. Track the function calls of a context from its callstack.
+    void ProfileLineCallback(asIScriptContext* context);
+    /// Return the profile of a script function.
+    ScriptFunctionProfile* GetFunctionProfile(asIScriptFunction* function);
+    /// Return a hash of the registered script API, calculated on first use. Cached bytecode compiled against another API is not loaded. Called with the module mutex held.
+    unsigned GetAPIHash();
     /// Output a sanitated row of script API. No-ops when URHO3D_LOGGING not defined.
     void OutputAPIRow(DumpMode mode, const String& row, bool removeReference = false, const String& separator = ";");
     /// Handle a console command event.
     void HandleConsoleCommand(StringHash eventType, VariantMap& eventData);
+    /// Handle the frame idle event. Perform incremental garbage collection.
+    void HandleFrameIdle(StringHash eventType, VariantMap& eventData);
 
     /// AngelScript engine.
     asIScriptEngine* scriptEngine_;
@@ -142,12 +203,28 @@ private:
     HashMap<int, PODVector<const char*>> enumValues_;
     /// AngelScript resource router.
     SharedPtr<ResourceRouter> router_;
+    /// Script object update dispatchers per scene.
+    HashMap<Scene*, SharedPtr<ScriptUpdateDispatcher> > updateDispatchers_;
     /// Script module create/delete mutex.
     Mutex moduleMutex_;
     /// Current script execution nesting level.
     unsigned scriptNestingLevel_;
     /// Flag for executing engine console commands as script code. Default to true.
     bool executeConsoleCommands_;
+    /// Bytecode cache directory.
+    String byteCodeCacheDir_;
+    /// Hash of the registered script API. Zero until calculated.
+    unsigned apiHash_{};
+    /// Per-frame garbage collection time budget in microseconds.
+    unsigned gcTimeBudget_{};
+    /// Garbage collection statistics.
+    ScriptGCStatistics gcStatistics_;
+    /// Script function profiler. Created when profiling is first enabled.
+    UniquePtr<ScriptProfiler> profiler_;
+    /// Profiled contexts that are executing and the profiler call depth when they started.
+    HashMap<asIScriptContext*, unsigned> profiledContexts_;
+    /// Script function profiling flag.
+    bool profiling_{};
 };
 
 /// Register Script library objects.
@@ -342,6 +342,9 @@ static void RegisterScript(asIScriptEngine* engine)
     engine->RegisterObjectMethod("Script", "Scene@+ get_defaultScene() const", AS_METHOD(Script, GetDefaultScene), AS_CALL_THISCALL);
     engine->RegisterObjectMethod("Script", "void set_executeConsoleCommands(bool)", AS_METHOD(Script, SetExecuteConsoleCommands), AS_CALL_THISCALL);
     engine->RegisterObjectMethod("Script", "bool get_executeConsoleCommands() const", AS_METHOD(Script, GetExecuteConsoleCommands), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod("Script", "void set_profiling(bool)", AS_METHOD(Script, SetProfiling), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod("Script", "bool get_profiling() const", AS_METHOD(Script, IsProfiling), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod("Script", "String PrintProfilingData(uint maxFunctions = 0xffffffff) const", AS_METHOD(Script, PrintProfilingData), AS_CALL_THISCALL);
     engine->RegisterGlobalFunction("Script@+ get_script()", AS_FUNCTION(GetScript), AS_CALL_CDECL);
 
     /*
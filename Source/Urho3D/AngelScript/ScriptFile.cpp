@@ -28,6 +28,7 @@
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
+#include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../IO/MemoryBuffer.h"
@@ -40,6 +41,9 @@
 namespace Urho3D
 {
 
+/// File ID of cached bytecode, followed by the AngelScript version, the script API hash and the source hash.
+static const char* BYTECODE_CACHE_ID = "ASCH";
+
 /// Helper class for saving AngelScript bytecode.
 class ByteCodeSerializer : public asIBinaryStream
 {
@@ -115,12 +119,17 @@ bool ScriptFile::BeginLoad(Deserializer& source)
 {
     ReleaseModule();
     loadByteCode_.Reset();
+    loadCachedByteCode_ = false;
+    sourceHash_ = 0;
 
     asIScriptEngine* engine = script_->GetScriptEngine();
 
     {
         MutexLock lock(script_->GetModuleMutex());
 
+        if (!script_->GetByteCodeCacheDir().Empty())
+            apiHash_ = script_->GetAPIHash();
+
         // Create the module. Discard previous module if there was one
         scriptModule_ = engine->GetModule(GetName().CString(), asGM_ALWAYS_CREATE);
         if (!scriptModule_)
@@ -145,7 +154,15 @@ bool ScriptFile::BeginLoad(Deserializer& source)
     // Not bytecode: add the initial section and check for includes.
     // Perform actual building during EndLoad(), as AngelScript can not multithread module compilation,
     // and static initializers may access arbitrary engine functionality which may not be thread-safe
-    return AddScriptSection(engine, source);
+    if (!AddScriptSection(engine, source))
+        return false;
+
+    // Now that the hash of all sections is known, check for bytecode cached by an earlier compile. The sections stay
+    // in the module to fall back on if the bytecode fails to load
+    if (!onlyCompile_)
+        LoadCachedByteCode();
+
+    return true;
 }
 
 bool ScriptFile::EndLoad()
@@ -161,11 +178,14 @@ bool ScriptFile::EndLoad()
 
         if (scriptModule_->LoadByteCode(&deserializer) >= 0)
         {
-            URHO3D_LOGINFO("Loaded script module " + GetName() + " from bytecode");
+            URHO3D_LOGINFO("Loaded script module " + GetName() + (loadCachedByteCode_ ? " from bytecode cache" : " from bytecode"));
             success = true;
         }
+        else if (loadCachedByteCode_)
+            URHO3D_LOGWARNING("Failed to load cached bytecode of script module " + GetName() + ", compiling from source");
     }
-    else
+
+    if (!loadByteCode_ || (loadCachedByteCode_ && !success))
     {
         if (onlyCompile_)
             scriptModule_->GetEngine()->SetEngineProperty(asEP_INIT_GLOBAL_VARS_AFTER_BUILD, 0);
@@ -174,6 +194,8 @@ bool ScriptFile::EndLoad()
         {
             URHO3D_LOGINFO("Compiled script module " + GetName());
             success = true;
+            if (!onlyCompile_)
+                SaveCachedByteCode();
         }
         else
             URHO3D_LOGERROR("Failed to compile script module " + GetName());
@@ -320,6 +342,7 @@ bool ScriptFile::Execute(asIScriptFunction* function, const VariantVector& param
 
     scriptSystem->IncScriptNestingLevel();
     bool success = (context->Execute() == asEXECUTION_FINISHED);
+    scriptSystem->EndProfiledCalls(context);
     if (success && (functionReturn != nullptr))
     {
         const int typeId = function->GetReturnTypeId();
@@ -480,6 +503,7 @@ bool ScriptFile::Execute(asIScriptObject* object, asIScriptFunction* method, con
 
     scriptSystem->IncScriptNestingLevel();
     bool success = context->Execute() >= 0;
+    scriptSystem->EndProfiledCalls(context);
     if (unprepare)
         context->Unprepare();
     scriptSystem->DecScriptNestingLevel();
@@ -581,6 +605,7 @@ asIScriptObject* ScriptFile::CreateObject(const String& className, bool useInter
     Script* scriptSystem = script_;
     scriptSystem->IncScriptNestingLevel();
     bool success = context->Execute() == asEXECUTION_FINISHED;
+    scriptSystem->EndProfiledCalls(context);
     scriptSystem->DecScriptNestingLevel();
     if (!success)
         return nullptr;
@@ -833,10 +858,80 @@ bool ScriptFile::AddScriptSection(asIScriptEngine* engine, Deserializer& source)
         return false;
     }
 
+    sourceHash_ = StringHash::Calculate(source.GetName().CString(), sourceHash_);
+    for (unsigned i = 0; i < dataSize; ++i)
+        sourceHash_ = SDBMHash(sourceHash_, (unsigned char)buffer[i]);
+
     SetMemoryUse(GetMemoryUse() + dataSize);
     return true;
 }
 
+String ScriptFile::GetByteCodeCacheName() const
+{
+    const String& cacheDir = script_->GetByteCodeCacheDir();
+    if (cacheDir.Empty())
+        return String::EMPTY;
+
+    // Resources of the same file name in different directories get different cache files
+    return cacheDir + GetFileName(GetName()) + "_" + StringHash(GetName()).ToString() + ".asbc";
+}
+
+bool ScriptFile::LoadCachedByteCode()
+{
+    String cacheName = GetByteCodeCacheName();
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    if (cacheName.Empty() || !fileSystem || !fileSystem->FileExists(cacheName))
+        return false;
+
+    File file(context_);
+    if (!file.Open(cacheName))
+        return false;
+
+    // Fall back to compiling if the source, the included files, the script API or the AngelScript version have changed
+    if (file.ReadFileID() != BYTECODE_CACHE_ID || file.ReadUInt() != ANGELSCRIPT_VERSION || file.ReadUInt() != apiHash_ ||
+        file.ReadUInt() != sourceHash_)
+        return false;
+
+    loadByteCodeSize_ = file.GetSize() - file.GetPosition();
+    loadByteCode_ = new unsigned char[loadByteCodeSize_];
+    if (file.Read(loadByteCode_.Get(), loadByteCodeSize_) != loadByteCodeSize_)
+    {
+        loadByteCode_.Reset();
+        return false;
+    }
+
+    loadCachedByteCode_ = true;
+    return true;
+}
+
+void ScriptFile::SaveCachedByteCode()
+{
+    String cacheName = GetByteCodeCacheName();
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    if (cacheName.Empty() || !fileSystem)
+        return;
+
+    String cacheDir = GetPath(cacheName);
+    if (!fileSystem->DirExists(cacheDir))
+        fileSystem->CreateDir(cacheDir);
+
+    File file(context_);
+    if (!file.Open(cacheName, FILE_WRITE))
+        return;
+
+    // Keep the debug info, so that script exceptions still report line numbers
+    file.WriteFileID(BYTECODE_CACHE_ID);
+    file.WriteUInt(ANGELSCRIPT_VERSION);
+    file.WriteUInt(apiHash_);
+    file.WriteUInt(sourceHash_);
+    ByteCodeSerializer serializer = ByteCodeSerializer(file);
+    if (scriptModule_->SaveByteCode(&serializer, false) < 0)
+    {
+        file.Close();
+        fileSystem->Delete(cacheName);
+    }
+}
+
 void ScriptFile::SetParameters(asIScriptContext* context, asIScriptFunction* function, const VariantVector& parameters)
 {
     unsigned paramCount = function->GetParamCount();
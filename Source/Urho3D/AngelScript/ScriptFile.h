@@ -125,6 +125,12 @@ private:
     void AddEventHandlerInternal(Object* sender, StringHash eventType, const String& handlerName);
     /// Add a script section, checking for includes recursively. Return true if successful.
     bool AddScriptSection(asIScriptEngine* engine, Deserializer& source);
+    /// Return the bytecode cache file name, or empty if the cache is disabled.
+    String GetByteCodeCacheName() const;
+    /// Read cached bytecode for asynchronous loading if it matches the source and the script API. Return true if found.
+    bool LoadCachedByteCode();
+    /// Write the compiled bytecode to the cache.
+    void SaveCachedByteCode();
     /// Set parameters for a function or method.
     void SetParameters(asIScriptContext* context, asIScriptFunction* function, const VariantVector& parameters);
     /// Release the script module.
@@ -157,6 +163,12 @@ private:
     bool onlyCompile_{false};
     /// Byte code size for asynchronous loading.
     unsigned loadByteCodeSize_{};
+    /// Hash of the script sections, including the include files.
+    unsigned sourceHash_{};
+    /// Hash of the script API at load time.
+    unsigned apiHash_{};
+    /// Byte code for asynchronous loading is from the bytecode cache flag.
+    bool loadCachedByteCode_{};
 };
 
 /// Helper class for forwarding events to script objects that are not part of a scene.
@@ -26,14 +26,12 @@
 #include "../AngelScript/ScriptFile.h"
 #include "../AngelScript/ScriptInstance.h"
 #include "../AngelScript/Addons.h"
+#include "../AngelScript/ScriptUpdateDispatcher.h"
 #include "../AngelScript/APITemplates.h"
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
 #include "../IO/Log.h"
 #include "../IO/MemoryBuffer.h"
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
-#include "../Physics/PhysicsEvents.h"
-#endif
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 #include "../Scene/Scene.h"
@@ -77,6 +75,7 @@ inline void ScriptInstance::executeScript(asIScriptFunction* method, Op func) co
     func(context);
     scriptSystem->IncScriptNestingLevel();
     context->Execute();
+    scriptSystem->EndProfiledCalls(context);
     context->Unprepare();
     scriptSystem->DecScriptNestingLevel();
 }
@@ -556,13 +555,8 @@ void ScriptInstance::OnSceneSet(Scene* scene)
     else
     {
         UnsubscribeFromEvent(E_SCENEUPDATE);
-        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_URHO2D)
-        UnsubscribeFromEvent(E_PHYSICSPRESTEP);
-        UnsubscribeFromEvent(E_PHYSICSPOSTSTEP);
-#endif
+        RemoveFromUpdateDispatcher();
         subscribed_ = false;
-        subscribedPostFixed_ = false;
     }
 }
 
@@ -617,8 +611,8 @@ void ScriptInstance::ReleaseObject()
         UnsubscribeFromAllEventsExcept(exceptions, false);
         if (node_)
             node_->RemoveListener(this);
+        RemoveFromUpdateDispatcher();
         subscribed_ = false;
-        subscribedPostFixed_ = false;
 
         ClearScriptMethods();
         ClearScriptAttributes();
@@ -816,16 +810,19 @@ void ScriptInstance::UpdateEventSubscription()
 
     if (enabled)
     {
-        if (!subscribed_ && (methods_[METHOD_UPDATE] || methods_[METHOD_DELAYEDSTART] || delayedCalls_.Size()))
+        if (!subscribed_ && (methods_[METHOD_DELAYEDSTART] || delayedCalls_.Size()))
         {
             SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(ScriptInstance, HandleSceneUpdate));
             subscribed_ = true;
         }
 
-        if (!subscribedPostFixed_)
+        // The update methods are called in batches by the update dispatcher of the scene
+        if (!updateDispatcher_ && (methods_[METHOD_UPDATE] || methods_[METHOD_POSTUPDATE] || methods_[METHOD_FIXEDUPDATE] ||
+            methods_[METHOD_FIXEDPOSTUPDATE]))
         {
-            if (methods_[METHOD_POSTUPDATE])
-                SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ScriptInstance, HandleScenePostUpdate));
+            ScriptUpdateDispatcher* dispatcher = GetSubsystem<Script>()->GetUpdateDispatcher(scene);
+            dispatcher->AddInstance(this, METHOD_UPDATE);
+            dispatcher->AddInstance(this, METHOD_POSTUPDATE);
 
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_URHO2D)
             if (methods_[METHOD_FIXEDUPDATE] || methods_[METHOD_FIXEDPOSTUPDATE])
@@ -834,16 +831,15 @@ void ScriptInstance::UpdateEventSubscription()
 
                 if (world)
                 {
-                    if (methods_[METHOD_FIXEDUPDATE])
-                        SubscribeToEvent(world, E_PHYSICSPRESTEP, URHO3D_HANDLER(ScriptInstance, HandlePhysicsPreStep));
-                    if (methods_[METHOD_FIXEDPOSTUPDATE])
-                        SubscribeToEvent(world, E_PHYSICSPOSTSTEP, URHO3D_HANDLER(ScriptInstance, HandlePhysicsPostStep));
+                    dispatcher->SetFixedUpdateSource(world);
+                    dispatcher->AddInstance(this, METHOD_FIXEDUPDATE);
+                    dispatcher->AddInstance(this, METHOD_FIXEDPOSTUPDATE);
                 }
                 else
                     URHO3D_LOGERROR("No physics world, can not subscribe script object to fixed update events");
             }
 #endif
-            subscribedPostFixed_ = true;
+            updateDispatcher_ = dispatcher;
         }
 
         if (methods_[METHOD_TRANSFORMCHANGED])
@@ -857,27 +853,33 @@ void ScriptInstance::UpdateEventSubscription()
             subscribed_ = false;
         }
 
-        if (subscribedPostFixed_)
-        {
-            UnsubscribeFromEvent(scene, E_SCENEPOSTUPDATE);
-
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_URHO2D)
-            Component* world = GetFixedUpdateSource();
-            if (world)
-            {
-                UnsubscribeFromEvent(world, E_PHYSICSPRESTEP);
-                UnsubscribeFromEvent(world, E_PHYSICSPOSTSTEP);
-            }
-#endif
-
-            subscribedPostFixed_ = false;
-        }
+        RemoveFromUpdateDispatcher();
 
         if (methods_[METHOD_TRANSFORMCHANGED])
             node_->RemoveListener(this);
     }
 }
 
+void ScriptInstance::RemoveFromUpdateDispatcher()
+{
+    if (!updateDispatcher_)
+        return;
+
+    for (unsigned i = METHOD_UPDATE; i <= METHOD_FIXEDPOSTUPDATE; ++i)
+        updateDispatcher_->RemoveInstance(this, (ScriptInstanceMethod)i);
+    updateDispatcher_.Reset();
+}
+
+void ScriptInstance::ExecuteDelayedStart()
+{
+    if (!scriptObject_ || !methods_[METHOD_DELAYEDSTART])
+        return;
+
+    asIScriptFunction* method = methods_[METHOD_DELAYEDSTART];
+    methods_[METHOD_DELAYEDSTART] = nullptr;  // Only execute once
+    executeScript(method, [](asIScriptContext*) {});
+}
+
 void ScriptInstance::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
 {
     if (!scriptObject_)
@@ -910,64 +912,17 @@ void ScriptInstance::HandleSceneUpdate(StringHash eventType, VariantMap& eventDa
             ++i;
     }
 
-    // Execute delayed start before first update
-    if (methods_[METHOD_DELAYEDSTART])
-    {
-        executeScript(methods_[METHOD_DELAYEDSTART], [](asIScriptContext*) {});
-        methods_[METHOD_DELAYEDSTART] = nullptr;  // Only execute once
-    }
+    // Execute delayed start, unless the update dispatcher already did it before the first update
+    ExecuteDelayedStart();
 
-    if (methods_[METHOD_UPDATE])
-        executeScript(methods_[METHOD_UPDATE], [&](asIScriptContext* context) {
-            context->SetArgFloat(0, timeStep);
-        });
-}
-
-void ScriptInstance::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
-{
-    if (!scriptObject_ || !methods_[METHOD_POSTUPDATE])
-        return;
-
-    using namespace ScenePostUpdate;
-    executeScript(methods_[METHOD_POSTUPDATE], [&](asIScriptContext* context) {
-        context->SetArgFloat(0, eventData[P_TIMESTEP].GetFloat());
-    });
-}
-
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_URHO2D)
-
-void ScriptInstance::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
-{
-    if (!scriptObject_)
-        return;
-
-    // Execute delayed start before first fixed update if not called yet
-    if (methods_[METHOD_DELAYEDSTART])
+    // Stop receiving the event when there is nothing left to do
+    if (!methods_[METHOD_DELAYEDSTART] && delayedCalls_.Empty() && subscribed_)
     {
-        executeScript(methods_[METHOD_DELAYEDSTART], [](asIScriptContext*) {});
-        methods_[METHOD_DELAYEDSTART] = nullptr;  // Only execute once
-    }
-    if (methods_[METHOD_FIXEDUPDATE]) {
-        using namespace PhysicsPreStep;
-        executeScript(methods_[METHOD_FIXEDUPDATE], [&](asIScriptContext* context) {
-            context->SetArgFloat(0, eventData[P_TIMESTEP].GetFloat());
-            });
+        UnsubscribeFromEvent(E_SCENEUPDATE);
+        subscribed_ = false;
     }
 }
 
-void ScriptInstance::HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData)
-{
-    if (!scriptObject_ || !methods_[METHOD_FIXEDPOSTUPDATE])
-        return;
-
-    using namespace PhysicsPostStep;
-    executeScript(methods_[METHOD_FIXEDPOSTUPDATE], [&](asIScriptContext* context) {
-        context->SetArgFloat(0, eventData[P_TIMESTEP].GetFloat());
-    });
-}
-
-#endif
-
 void ScriptInstance::HandleScriptEvent(StringHash eventType, VariantMap& eventData)
 {
     if (!IsEnabledEffective() || !scriptFile_ || !scriptObject_)
@@ -37,6 +37,7 @@ namespace Urho3D
 
 class Script;
 class ScriptFile;
+class ScriptUpdateDispatcher;
 enum { eAttrMapUserIdx = 0x1df4};
 void CleanupTypeInfoScriptInstance(asITypeInfo *type);
 
@@ -64,6 +65,8 @@ class URHO3D_API ScriptInstance : public Component, public ScriptEventListener
 {
     URHO3D_OBJECT(ScriptInstance, Component);
 
+    friend class ScriptUpdateDispatcher;
+
 public:
     /// Construct.
     explicit ScriptInstance(Context* context);
@@ -177,16 +180,12 @@ private:
     void ClearScriptAttributes();
     /// Subscribe/unsubscribe from scene updates as necessary.
     void UpdateEventSubscription();
-    /// Handle scene update event.
+    /// Remove the update methods from the update dispatcher of the scene.
+    void RemoveFromUpdateDispatcher();
+    /// Execute the delayed start method if not executed yet.
+    void ExecuteDelayedStart();
+    /// Handle scene update event. Executes the delayed start and the delayed calls.
     void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
-    /// Handle scene post-update event.
-    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_URHO2D)
-    /// Handle physics pre-step event.
-    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
-    /// Handle physics post-step event.
-    void HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData);
-#endif
     /// Handle an event in script.
     void HandleScriptEvent(StringHash eventType, VariantMap& eventData);
     /// Handle script file reload start.
@@ -213,10 +212,10 @@ private:
     HashMap<AttributeInfo*, unsigned> idAttributes_;
     /// Storage for attributes while script object is being hot-reloaded.
     HashMap<String, Variant> storedAttributes_;
-    /// Subscribed to scene update events flag.
+    /// Update dispatcher of the scene, which calls the update methods. Null if not added to it.
+    WeakPtr<ScriptUpdateDispatcher> updateDispatcher_;
+    /// Subscribed to scene update events for delayed start and delayed calls flag.
     bool subscribed_{};
-    /// Subscribed to scene post and fixed update events flag.
-    bool subscribedPostFixed_{};
 };
 
 /// Return the active AngelScript context. Provided as a wrapper to the AngelScript API function to avoid undefined symbol error in shared library Urho3D builds.
@@ -0,0 +1,243 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../AngelScript/Script.h"
+#include "../AngelScript/ScriptUpdateDispatcher.h"
+#include "../Core/Profiler.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
+#include "../Physics/PhysicsEvents.h"
+#endif
+
+#include <AngelScript/angelscript.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+ScriptUpdateDispatcher::ScriptUpdateDispatcher(Context* context, Scene* scene) :
+    Object(context),
+    scene_(scene)
+{
+    SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(ScriptUpdateDispatcher, HandleSceneUpdate));
+    SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ScriptUpdateDispatcher, HandleScenePostUpdate));
+}
+
+ScriptUpdateDispatcher::~ScriptUpdateDispatcher() = default;
+
+void ScriptUpdateDispatcher::AddInstance(ScriptInstance* instance, ScriptInstanceMethod method)
+{
+    assert(method >= METHOD_UPDATE && method <= METHOD_FIXEDPOSTUPDATE);
+
+    asIScriptFunction* function = instance ? instance->methods_[method] : nullptr;
+    if (!function)
+        return;
+
+    Vector<Batch>& batches = batches_[method - METHOD_UPDATE];
+    for (unsigned i = 0; i < batches.Size(); ++i)
+    {
+        if (batches[i].method_ == function)
+        {
+            batches[i].instances_.Push(instance);
+            return;
+        }
+    }
+
+    Batch batch;
+    batch.method_ = function;
+    batch.instances_.Push(instance);
+    batches.Push(batch);
+}
+
+void ScriptUpdateDispatcher::RemoveInstance(ScriptInstance* instance, ScriptInstanceMethod method)
+{
+    assert(method >= METHOD_UPDATE && method <= METHOD_FIXEDPOSTUPDATE);
+
+    asIScriptFunction* function = instance ? instance->methods_[method] : nullptr;
+    if (!function)
+        return;
+
+    unsigned index = method - METHOD_UPDATE;
+    Vector<Batch>& batches = batches_[index];
+    for (unsigned i = 0; i < batches.Size(); ++i)
+    {
+        if (batches[i].method_ != function)
+            continue;
+
+        PODVector<ScriptInstance*>& instances = batches[i].instances_;
+        if (!dispatching_[index])
+        {
+            instances.RemoveSwap(instance);
+            // Drop empty batches, as the method may be freed by a script reload
+            if (instances.Empty())
+                batches.Erase(i);
+        }
+        else
+        {
+            // Keep the order and size of the list intact while it is being iterated
+            PODVector<ScriptInstance*>::Iterator j = instances.Find(instance);
+            if (j != instances.End())
+                *j = nullptr;
+        }
+        return;
+    }
+}
+
+void ScriptUpdateDispatcher::SetFixedUpdateSource(Component* source)
+{
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_URHO2D)
+    if (source == fixedUpdateSource_)
+        return;
+
+    if (fixedUpdateSource_)
+    {
+        UnsubscribeFromEvent(fixedUpdateSource_, E_PHYSICSPRESTEP);
+        UnsubscribeFromEvent(fixedUpdateSource_, E_PHYSICSPOSTSTEP);
+    }
+
+    fixedUpdateSource_ = source;
+    if (source)
+    {
+        SubscribeToEvent(source, E_PHYSICSPRESTEP, URHO3D_HANDLER(ScriptUpdateDispatcher, HandlePhysicsPreStep));
+        SubscribeToEvent(source, E_PHYSICSPOSTSTEP, URHO3D_HANDLER(ScriptUpdateDispatcher, HandlePhysicsPostStep));
+    }
+#endif
+}
+
+Scene* ScriptUpdateDispatcher::GetScene() const
+{
+    return scene_;
+}
+
+unsigned ScriptUpdateDispatcher::GetNumInstances(ScriptInstanceMethod method) const
+{
+    if (method < METHOD_UPDATE || method > METHOD_FIXEDPOSTUPDATE)
+        return 0;
+
+    unsigned numInstances = 0;
+    const Vector<Batch>& batches = batches_[method - METHOD_UPDATE];
+    for (unsigned i = 0; i < batches.Size(); ++i)
+        numInstances += batches[i].instances_.Size();
+    return numInstances;
+}
+
+void ScriptUpdateDispatcher::Dispatch(ScriptInstanceMethod method, float timeStep)
+{
+    unsigned index = method - METHOD_UPDATE;
+    Vector<Batch>& batches = batches_[index];
+    if (batches.Empty() || dispatching_[index])
+        return;
+
+    URHO3D_PROFILE(ExecuteScriptUpdates);
+
+    // Hold a reference in case a script destroys the scene and the Script subsystem drops the dispatcher
+    SharedPtr<ScriptUpdateDispatcher> self(this);
+    auto* script = GetSubsystem<Script>();
+    asIScriptContext* context = script->GetScriptFileContext();
+    // Script calls made from within the update methods use the contexts of the next nesting levels
+    script->IncScriptNestingLevel();
+    dispatching_[index] = true;
+
+    bool runDelayedStart = method == METHOD_UPDATE || method == METHOD_FIXEDUPDATE;
+
+    // Instances and batches added during the dispatch are updated on the same frame, so index instead of iterating
+    for (unsigned i = 0; i < batches.Size(); ++i)
+    {
+        asIScriptFunction* function = batches[i].method_;
+        for (unsigned j = 0; j < batches[i].instances_.Size(); ++j)
+        {
+            ScriptInstance* instance = batches[i].instances_[j];
+            if (!instance)
+                continue;
+
+            // Execute delayed start before the first update
+            if (runDelayedStart && instance->methods_[METHOD_DELAYEDSTART])
+            {
+                instance->ExecuteDelayedStart();
+                // The instance may have removed itself
+                if (!batches[i].instances_[j])
+                    continue;
+            }
+
+            // Preparing the context again for the same function only resets it
+            if (context->Prepare(function) < 0)
+                break;
+            context->SetObject(instance->scriptObject_);
+            context->SetArgFloat(0, timeStep);
+            context->Execute();
+            script->EndProfiledCalls(context);
+        }
+    }
+
+    context->Unprepare();
+    script->DecScriptNestingLevel();
+    dispatching_[index] = false;
+
+    // Remove the entries cleared during the dispatch
+    for (unsigned i = batches.Size() - 1; i < batches.Size(); --i)
+    {
+        PODVector<ScriptInstance*>& instances = batches[i].instances_;
+        unsigned dest = 0;
+        for (unsigned j = 0; j < instances.Size(); ++j)
+        {
+            if (instances[j])
+                instances[dest++] = instances[j];
+        }
+        instances.Resize(dest);
+        if (instances.Empty())
+            batches.Erase(i);
+    }
+}
+
+void ScriptUpdateDispatcher::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+{
+    using namespace SceneUpdate;
+    Dispatch(METHOD_UPDATE, eventData[P_TIMESTEP].GetFloat());
+}
+
+void ScriptUpdateDispatcher::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ScenePostUpdate;
+    Dispatch(METHOD_POSTUPDATE, eventData[P_TIMESTEP].GetFloat());
+}
+
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_URHO2D)
+
+void ScriptUpdateDispatcher::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
+{
+    using namespace PhysicsPreStep;
+    Dispatch(METHOD_FIXEDUPDATE, eventData[P_TIMESTEP].GetFloat());
+}
+
+void ScriptUpdateDispatcher::HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData)
+{
+    using namespace PhysicsPostStep;
+    Dispatch(METHOD_FIXEDPOSTUPDATE, eventData[P_TIMESTEP].GetFloat());
+}
+
+#endif
+
+}
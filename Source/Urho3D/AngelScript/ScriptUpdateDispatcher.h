@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/// \file
+
+#pragma once
+
+#include "../AngelScript/ScriptInstance.h"
+#include "../Core/Object.h"
+
+namespace Urho3D
+{
+
+class Scene;
+
+/// Number of script object update methods that are dispatched in batches: Update, PostUpdate, FixedUpdate and FixedPostUpdate.
+static const unsigned NUM_DISPATCHED_SCRIPT_METHODS = METHOD_FIXEDPOSTUPDATE - METHOD_UPDATE + 1;
+
+/// Calls the update methods of the script objects in one scene, grouped by script class so that each group runs in one script context that is prepared for the same method every time. Created by the Script subsystem; script instances register themselves instead of subscribing to the update events one by one.
+/// @nobind
+class URHO3D_API ScriptUpdateDispatcher : public Object
+{
+    URHO3D_OBJECT(ScriptUpdateDispatcher, Object);
+
+public:
+    /// Construct and subscribe to the update events of the scene.
+    ScriptUpdateDispatcher(Context* context, Scene* scene);
+    /// Destruct.
+    ~ScriptUpdateDispatcher() override;
+
+    /// Add a script instance to the batched calls of an update method. Called by ScriptInstance.
+    void AddInstance(ScriptInstance* instance, ScriptInstanceMethod method);
+    /// Remove a script instance from the batched calls of an update method. Called by ScriptInstance.
+    void RemoveInstance(ScriptInstance* instance, ScriptInstanceMethod method);
+    /// Set the physics world that sends the fixed update events. Called by ScriptInstance.
+    void SetFixedUpdateSource(Component* source);
+
+    /// Return the scene.
+    Scene* GetScene() const;
+    /// Return number of script instances that have an update method called.
+    unsigned GetNumInstances(ScriptInstanceMethod method) const;
+
+private:
+    /// Script instances of one script class, which share the update method.
+    struct Batch
+    {
+        /// Update method.
+        asIScriptFunction* method_;
+        /// Script instances. Entries of instances removed during the dispatch are cleared.
+        PODVector<ScriptInstance*> instances_;
+    };
+
+    /// Call an update method of all registered script instances.
+    void Dispatch(ScriptInstanceMethod method, float timeStep);
+    /// Handle scene update event.
+    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle scene post-update event.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_URHO2D)
+    /// Handle physics pre-step event.
+    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
+    /// Handle physics post-step event.
+    void HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData);
+#endif
+
+    /// Scene.
+    WeakPtr<Scene> scene_;
+    /// Physics world that sends the fixed update events.
+    WeakPtr<Component> fixedUpdateSource_;
+    /// Batches per update method.
+    Vector<Batch> batches_[NUM_DISPATCHED_SCRIPT_METHODS];
+    /// Dispatch in progress flags per update method.
+    bool dispatching_[NUM_DISPATCHED_SCRIPT_METHODS]{};
+};
+
+}
@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Audio/Adpcm.h"
+#include "../Math/MathDefs.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+static const int ADPCM_STEPS[] =
+{
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
+    143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
+    1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+    9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int ADPCM_INDEX_ADJUST[] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+static const int ADPCM_MAX_STEP_INDEX = 88;
+
+/// Bytes of each channel's sample data that are interleaved in stereo blocks.
+static const unsigned ADPCM_STEREO_CHUNK = 4;
+
+/// Decode one 4-bit code and update the predictor state.
+static inline short DecodeNibble(unsigned nibble, int& predictor, int& stepIndex)
+{
+    int step = ADPCM_STEPS[stepIndex];
+    int diff = step >> 3;
+    if (nibble & 4u)
+        diff += step;
+    if (nibble & 2u)
+        diff += step >> 1;
+    if (nibble & 1u)
+        diff += step >> 2;
+
+    predictor = Clamp(nibble & 8u ? predictor - diff : predictor + diff, -32768, 32767);
+    stepIndex = Clamp(stepIndex + ADPCM_INDEX_ADJUST[nibble], 0, ADPCM_MAX_STEP_INDEX);
+    return (short)predictor;
+}
+
+/// Encode one sample to a 4-bit code and update the predictor state the same way the decoder does.
+static inline unsigned EncodeNibble(int sample, int& predictor, int& stepIndex)
+{
+    int step = ADPCM_STEPS[stepIndex];
+    int delta = sample - predictor;
+    unsigned nibble = 0;
+    if (delta < 0)
+    {
+        nibble = 8;
+        delta = -delta;
+    }
+
+    int diff = step >> 3;
+    if (delta >= step)
+    {
+        nibble |= 4;
+        delta -= step;
+        diff += step;
+    }
+    step >>= 1;
+    if (delta >= step)
+    {
+        nibble |= 2;
+        delta -= step;
+        diff += step;
+    }
+    step >>= 1;
+    if (delta >= step)
+    {
+        nibble |= 1;
+        diff += step;
+    }
+
+    predictor = Clamp(nibble & 8u ? predictor - diff : predictor + diff, -32768, 32767);
+    stepIndex = Clamp(stepIndex + ADPCM_INDEX_ADJUST[nibble], 0, ADPCM_MAX_STEP_INDEX);
+    return nibble;
+}
+
+unsigned GetAdpcmFramesPerBlock(unsigned blockSize, unsigned channels)
+{
+    if (!channels || blockSize < 4 * channels)
+        return 0;
+
+    // The header of each channel holds the first sample, and every byte after it two more
+    return 1 + (blockSize - 4 * channels) * 2 / channels;
+}
+
+unsigned DecodeAdpcmBlock(short* dest, const unsigned char* src, unsigned blockSize, unsigned channels)
+{
+    if (channels < 1 || channels > 2 || blockSize < 4 * channels)
+        return 0;
+
+    int predictors[2];
+    int stepIndices[2];
+    for (unsigned i = 0; i < channels; ++i)
+    {
+        predictors[i] = (short)(src[0] | (src[1] << 8u));
+        stepIndices[i] = Min((int)src[2], ADPCM_MAX_STEP_INDEX);
+        dest[i] = (short)predictors[i];
+        src += 4;
+    }
+
+    unsigned dataSize = blockSize - 4 * channels;
+
+    if (channels == 1)
+    {
+        int predictor = predictors[0];
+        int stepIndex = stepIndices[0];
+        short* out = dest + 1;
+        for (unsigned i = 0; i < dataSize; ++i)
+        {
+            unsigned code = src[i];
+            out[0] = DecodeNibble(code & 15u, predictor, stepIndex);
+            out[1] = DecodeNibble(code >> 4u, predictor, stepIndex);
+            out += 2;
+        }
+
+        return 1 + dataSize * 2;
+    }
+
+    // Stereo data alternates between the channels every four bytes, which hold eight samples
+    unsigned chunks = dataSize / (ADPCM_STEREO_CHUNK * 2);
+    short* out = dest + 2;
+    for (unsigned i = 0; i < chunks; ++i)
+    {
+        for (unsigned c = 0; c < 2; ++c)
+        {
+            short* channelOut = out + c;
+            for (unsigned j = 0; j < ADPCM_STEREO_CHUNK; ++j)
+            {
+                unsigned code = *src++;
+                channelOut[0] = DecodeNibble(code & 15u, predictors[c], stepIndices[c]);
+                channelOut[2] = DecodeNibble(code >> 4u, predictors[c], stepIndices[c]);
+                channelOut += 4;
+            }
+        }
+        out += ADPCM_STEREO_CHUNK * 2 * 2;
+    }
+
+    return 1 + chunks * ADPCM_STEREO_CHUNK * 2;
+}
+
+void EncodeAdpcmBlock(unsigned char* dest, const short* src, unsigned frames, unsigned channels, unsigned blockSize, int* stepIndices)
+{
+    unsigned framesPerBlock = GetAdpcmFramesPerBlock(blockSize, channels);
+    if (channels < 1 || channels > 2 || !framesPerBlock || !frames)
+        return;
+
+    // Repeat the last sample to fill a short final block
+    auto sample = [&](unsigned frame, unsigned channel) {
+        return (int)src[Min(frame, frames - 1) * channels + channel];
+    };
+
+    int predictors[2];
+    for (unsigned i = 0; i < channels; ++i)
+    {
+        predictors[i] = sample(0, i);
+        dest[0] = (unsigned char)(predictors[i] & 0xffu);
+        dest[1] = (unsigned char)((predictors[i] >> 8u) & 0xffu);
+        dest[2] = (unsigned char)stepIndices[i];
+        dest[3] = 0;
+        dest += 4;
+    }
+
+    if (channels == 1)
+    {
+        for (unsigned frame = 1; frame < framesPerBlock; frame += 2)
+        {
+            unsigned low = EncodeNibble(sample(frame, 0), predictors[0], stepIndices[0]);
+            unsigned high = EncodeNibble(sample(frame + 1, 0), predictors[0], stepIndices[0]);
+            *dest++ = (unsigned char)(low | (high << 4u));
+        }
+        return;
+    }
+
+    for (unsigned frame = 1; frame < framesPerBlock; frame += ADPCM_STEREO_CHUNK * 2)
+    {
+        for (unsigned c = 0; c < 2; ++c)
+        {
+            for (unsigned j = 0; j < ADPCM_STEREO_CHUNK; ++j)
+            {
+                unsigned low = EncodeNibble(sample(frame + j * 2, c), predictors[c], stepIndices[c]);
+                unsigned high = EncodeNibble(sample(frame + j * 2 + 1, c), predictors[c], stepIndices[c]);
+                *dest++ = (unsigned char)(low | (high << 4u));
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,37 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Urho3D.h"
+
+namespace Urho3D
+{
+
+/// Return number of sample frames in an IMA ADPCM block of the specified size in bytes.
+URHO3D_API unsigned GetAdpcmFramesPerBlock(unsigned blockSize, unsigned channels);
+/// Decode an IMA ADPCM block in the WAV file layout to interleaved 16-bit samples. Mono and stereo are supported. Return number of sample frames decoded.
+URHO3D_API unsigned DecodeAdpcmBlock(short* dest, const unsigned char* src, unsigned blockSize, unsigned channels);
+/// Encode interleaved 16-bit samples to an IMA ADPCM block in the WAV file layout. A short final block is padded by repeating the last sample. The step indices, one per channel, carry the encoder state from block to block and should start at zero.
+URHO3D_API void EncodeAdpcmBlock(unsigned char* dest, const short* src, unsigned frames, unsigned channels, unsigned blockSize, int* stepIndices);
+
+}
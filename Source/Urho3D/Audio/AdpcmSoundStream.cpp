@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Audio/Adpcm.h"
+#include "../Audio/AdpcmSoundStream.h"
+#include "../Audio/Sound.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+AdpcmSoundStream::AdpcmSoundStream(const Sound* sound)
+{
+    assert(sound && sound->IsAdpcm());
+
+    SetFormat(sound->GetIntFrequency(), true, sound->IsStereo());
+    // If the sound is looped, the stream will automatically rewind at end
+    SetStopAtEnd(!sound->IsLooped());
+
+    data_ = sound->GetData();
+    dataSize_ = sound->GetDataSize();
+    blockSize_ = sound->GetAdpcmBlockSize();
+    framesPerBlock_ = sound->GetAdpcmFramesPerBlock();
+    totalFrames_ = sound->GetAdpcmFrames();
+    block_ = new short[framesPerBlock_ * (stereo_ ? 2 : 1)];
+}
+
+AdpcmSoundStream::~AdpcmSoundStream() = default;
+
+bool AdpcmSoundStream::Seek(unsigned sample_number)
+{
+    unsigned blockIndex = sample_number / framesPerBlock_;
+    nextBlock_ = blockIndex;
+    blockFrames_ = 0;
+    blockPosition_ = 0;
+
+    if (!DecodeNextBlock())
+        return false;
+
+    blockPosition_ = Min(sample_number - blockIndex * framesPerBlock_, blockFrames_);
+    return true;
+}
+
+unsigned AdpcmSoundStream::GetData(signed char* dest, unsigned numBytes)
+{
+    unsigned channels = stereo_ ? 2 : 1;
+    unsigned frameSize = channels * sizeof(short);
+    unsigned numFrames = numBytes / frameSize;
+    unsigned outFrames = 0;
+    bool rewound = false;
+
+    while (outFrames < numFrames)
+    {
+        if (blockPosition_ >= blockFrames_)
+        {
+            if (DecodeNextBlock())
+                rewound = false;
+            else
+            {
+                // Rewind if is looping, but only once in a row so that an empty sound can not loop forever
+                if (stopAtEnd_ || rewound)
+                    break;
+                nextBlock_ = 0;
+                rewound = true;
+                continue;
+            }
+        }
+
+        unsigned copyFrames = Min(numFrames - outFrames, blockFrames_ - blockPosition_);
+        memcpy(dest + outFrames * frameSize, block_.Get() + blockPosition_ * channels, copyFrames * frameSize);
+        blockPosition_ += copyFrames;
+        outFrames += copyFrames;
+    }
+
+    return outFrames * frameSize;
+}
+
+bool AdpcmSoundStream::DecodeNextBlock()
+{
+    unsigned startFrame = nextBlock_ * framesPerBlock_;
+    unsigned offset = nextBlock_ * blockSize_;
+    if (startFrame >= totalFrames_ || offset >= dataSize_)
+        return false;
+
+    // The last block may be shorter than the rest
+    unsigned channels = stereo_ ? 2 : 1;
+    unsigned size = Min(blockSize_, dataSize_ - offset);
+    unsigned decoded = DecodeAdpcmBlock(block_.Get(), (const unsigned char*)data_.Get() + offset, size, channels);
+    if (!decoded)
+        return false;
+
+    blockFrames_ = Min(decoded, totalFrames_ - startFrame);
+    blockPosition_ = 0;
+    ++nextBlock_;
+    return true;
+}
+
+}
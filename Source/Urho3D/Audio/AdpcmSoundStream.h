@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Audio/SoundStream.h"
+#include "../Container/ArrayPtr.h"
+
+namespace Urho3D
+{
+
+class Sound;
+
+/// IMA ADPCM sound stream. Decodes the in-memory compressed data one block at a time while mixing.
+class URHO3D_API AdpcmSoundStream : public SoundStream
+{
+public:
+    /// Construct from an IMA ADPCM compressed sound.
+    explicit AdpcmSoundStream(const Sound* sound);
+    /// Destruct.
+    ~AdpcmSoundStream() override;
+
+    /// Seek to sample number. Return true on success.
+    bool Seek(unsigned sample_number) override;
+
+    /// Produce sound data into destination. Return number of bytes produced. Called by SoundSource from the mixing thread.
+    unsigned GetData(signed char* dest, unsigned numBytes) override;
+
+private:
+    /// Decode the next block. Return false at the end of the sound.
+    bool DecodeNextBlock();
+
+    /// Compressed sound data.
+    SharedArrayPtr<signed char> data_;
+    /// Compressed sound data size in bytes.
+    unsigned dataSize_;
+    /// Block size in bytes.
+    unsigned blockSize_;
+    /// Sample frames per full block.
+    unsigned framesPerBlock_;
+    /// Total sample frames in the sound.
+    unsigned totalFrames_;
+    /// Decoded samples of the current block.
+    SharedArrayPtr<short> block_;
+    /// Valid sample frames in the current block.
+    unsigned blockFrames_{};
+    /// Read position in sample frames within the current block.
+    unsigned blockPosition_{};
+    /// Index of the next block to decode.
+    unsigned nextBlock_{};
+};
+
+}
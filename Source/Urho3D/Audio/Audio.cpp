@@ -26,14 +26,24 @@
 #include "../Audio/Sound.h"
 #include "../Audio/SoundListener.h"
 #include "../Audio/SoundSource3D.h"
+#include "../Audio/StreamDecoder.h"
+#include "../Container/Sort.h"
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#include "../Core/Timer.h"
 #include "../IO/Log.h"
 
 #include <SDL/SDL.h>
 
+#if defined(URHO3D_SSE)
+#include <emmintrin.h>
+#elif defined(URHO3D_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "../DebugNew.h"
 
 #ifdef _MSC_VER
@@ -49,11 +59,46 @@ static const int MIN_BUFFERLENGTH = 20;
 static const int MIN_MIXRATE = 11025;
 static const int MAX_MIXRATE = 48000;
 static const StringHash SOUND_MASTER_HASH("Master");
+/// Capacity of the command queue from the main thread to the mixing thread. Must be a power of two.
+static const unsigned AUDIO_COMMAND_QUEUE_SIZE = 4096;
+
+/// %Audio command type.
+enum AudioCommandType
+{
+    AC_ADD_SOURCE = 0,
+    AC_REMOVE_SOURCE,
+    AC_SET_PLAYBACK,
+    AC_PAUSE_TYPE,
+    AC_RESUME_TYPE,
+    AC_RESUME_ALL
+};
+
+/// Command from the main thread to the mixing thread.
+struct AudioCommand
+{
+    /// Command type.
+    AudioCommandType type_{};
+    /// Target sound source. Claimed by exchanging it to null, which also allows a destroyed sound source to cancel its pending commands.
+    std::atomic<SoundSource*> source_{};
+    /// Sound to play.
+    Sound* sound_{};
+    /// Sound stream to play.
+    SoundStream* stream_{};
+    /// Decode buffer of the sound stream.
+    Sound* streamBuffer_{};
+    /// Playback position, null to stop.
+    signed char* position_{};
+    /// Playback time position.
+    float timePosition_{};
+    /// Sound type to pause or resume.
+    StringHash soundType_;
+};
 
 static void SDLAudioCallback(void* userdata, Uint8* stream, int len);
 
 Audio::Audio(Context* context) :
-    Object(context)
+    Object(context),
+    commands_(new AudioCommand[AUDIO_COMMAND_QUEUE_SIZE])
 {
     context_->RequireSDL(SDL_INIT_AUDIO);
 
@@ -134,6 +179,10 @@ bool Audio::SetMode(int bufferLengthMSec, int mixRate, bool stereo, bool interpo
     interpolation_ = interpolation;
     clipBuffer_ = new int[stereo ? fragmentSize_ << 1u : fragmentSize_];
 
+    // Decode compressed streams on a separate thread so that the mixing thread only copies decoded data
+    streamDecoder_ = new StreamDecoder();
+    streamDecoder_->Run();
+
     URHO3D_LOGINFO("Set audio mode " + String(mixRate_) + " Hz " + (stereo_ ? "stereo" : "mono") + (interpolation_ ? " interpolated" : ""));
 
     return Play();
@@ -141,6 +190,8 @@ bool Audio::SetMode(int bufferLengthMSec, int mixRate, bool stereo, bool interpo
 
 void Audio::Update(float timeStep)
 {
+    ReleaseRetiredResources();
+
     if (!playing_)
         return;
 
@@ -182,24 +233,35 @@ void Audio::SetMasterGain(const String& type, float gain)
 
 void Audio::PauseSoundType(const String& type)
 {
-    MutexLock lock(audioMutex_);
     pausedSoundTypes_.Insert(type);
+
+    AudioCommand& command = AllocateCommand();
+    command.type_ = AC_PAUSE_TYPE;
+    command.soundType_ = type;
+    SubmitCommand(nullptr);
 }
 
 void Audio::ResumeSoundType(const String& type)
 {
-    MutexLock lock(audioMutex_);
     pausedSoundTypes_.Erase(type);
-    // Update sound sources before resuming playback to make sure 3D positions are up to date
-    // Done under mutex to ensure no mixing happens before we are ready
+    // Update sound sources before resuming playback to make sure 3D positions are up to date. The mixing thread
+    // only resumes the type after the update, as it sees the command after the updated parameters
     UpdateInternal(0.0f);
+
+    AudioCommand& command = AllocateCommand();
+    command.type_ = AC_RESUME_TYPE;
+    command.soundType_ = type;
+    SubmitCommand(nullptr);
 }
 
 void Audio::ResumeAll()
 {
-    MutexLock lock(audioMutex_);
     pausedSoundTypes_.Clear();
     UpdateInternal(0.0f);
+
+    AudioCommand& command = AllocateCommand();
+    command.type_ = AC_RESUME_ALL;
+    SubmitCommand(nullptr);
 }
 
 void Audio::SetListener(SoundListener* listener)
@@ -216,6 +278,17 @@ void Audio::StopSound(Sound* sound)
     }
 }
 
+void Audio::SetThreadPriority(int priority)
+{
+    threadPriority_ = Clamp(priority, -2, 2);
+    threadPriorityDirty_ = true;
+}
+
+void Audio::SetMaxVoices(unsigned voices)
+{
+    maxVoices_ = voices;
+}
+
 float Audio::GetMasterGain(const String& type) const
 {
     // By definition previously unknown types return full volume
@@ -238,18 +311,61 @@ SoundListener* Audio::GetListener() const
 
 void Audio::AddSoundSource(SoundSource* soundSource)
 {
-    MutexLock lock(audioMutex_);
     soundSources_.Push(soundSource);
+
+    AllocateCommand().type_ = AC_ADD_SOURCE;
+    SubmitCommand(soundSource);
 }
 
 void Audio::RemoveSoundSource(SoundSource* soundSource)
 {
     PODVector<SoundSource*>::Iterator i = soundSources_.Find(soundSource);
-    if (i != soundSources_.End())
+    if (i == soundSources_.End())
+        return;
+
+    soundSources_.Erase(i);
+
+    // Cancel the commands of the sound source that the mixing thread has not claimed yet
+    unsigned write = commandWrite_.load(std::memory_order_relaxed);
+    for (unsigned index = commandRead_.load(std::memory_order_acquire); index != write; ++index)
     {
-        MutexLock lock(audioMutex_);
-        soundSources_.Erase(i);
+        SoundSource* expected = soundSource;
+        commands_[index & (AUDIO_COMMAND_QUEUE_SIZE - 1)].source_.compare_exchange_strong(expected, nullptr);
     }
+
+    AllocateCommand().type_ = AC_REMOVE_SOURCE;
+    SubmitCommand(soundSource);
+
+    // Any mix block started from now on removes the sound source before mixing, so only the block that may currently
+    // be running can still access it
+    WaitForMixBlock();
+}
+
+unsigned Audio::SetSoundSourcePlayback(SoundSource* soundSource, Sound* sound, SoundStream* stream, Sound* streamBuffer,
+    signed char* position, float timePosition)
+{
+    AudioCommand& command = AllocateCommand();
+    command.type_ = AC_SET_PLAYBACK;
+    command.sound_ = sound;
+    command.stream_ = stream;
+    command.streamBuffer_ = streamBuffer;
+    command.position_ = position;
+    command.timePosition_ = timePosition;
+    return SubmitCommand(soundSource);
+}
+
+void Audio::RetireResource(RefCounted* resource, unsigned commandIndex)
+{
+    if (resource && IsCommandPending(commandIndex))
+        retiredResources_.Push(MakePair(commandIndex, SharedPtr<RefCounted>(resource)));
+}
+
+bool Audio::IsCommandPending(unsigned commandIndex) const
+{
+    // Commands in the range (read, write] are pending. Unsigned arithmetic keeps this valid when the indices wrap
+    unsigned read = commandRead_.load(std::memory_order_acquire);
+    unsigned write = commandWrite_.load(std::memory_order_relaxed);
+    return commandIndex - read - 1 < write - read;
 }
 
 float Audio::GetSoundSourceMasterGain(StringHash typeHash) const
@@ -270,20 +386,50 @@ float Audio::GetSoundSourceMasterGain(StringHash typeHash) const
 void SDLAudioCallback(void* userdata, Uint8* stream, int len)
 {
     auto* audio = static_cast<Audio*>(userdata);
+    audio->MixOutput(stream, len / audio->GetSampleSize());
+}
+
+/// Clip 32-bit mix buffer samples to 16-bit output with saturating packs, eight samples at a time when SSE or NEON is available.
+static void ClipSamples(short* dest, const int* src, unsigned count)
+{
+    unsigned i = 0;
+#if defined(URHO3D_SSE)
+    for (; i + 8 <= count; i += 8)
     {
-        MutexLock Lock(audio->GetMutex());
-        audio->MixOutput(stream, len / audio->GetSampleSize());
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_packs_epi32(low, high));
     }
+#elif defined(URHO3D_NEON)
+    for (; i + 8 <= count; i += 8)
+        vst1q_s16(dest + i, vcombine_s16(vqmovn_s32(vld1q_s32(src + i)), vqmovn_s32(vld1q_s32(src + i + 4))));
+#endif
+    for (; i < count; ++i)
+        dest[i] = (short)Clamp(src[i], -32768, 32767);
 }
 
 void Audio::MixOutput(void* dest, unsigned samples)
 {
+    // The mixing thread is created by SDL, so apply the priority from the thread itself
+    if (threadPriorityDirty_.exchange(false))
+        Thread::SetCurrentThreadPriority(threadPriority_);
+
+    unsigned block = mixBlocksStarted_.fetch_add(1) + 1;
+    // Order the block start before reading the command queue. Pairs with the fence in WaitForMixBlock()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Apply the state changes queued by the main thread so that the whole block is mixed from a consistent snapshot
+    ProcessCommands();
+
     if (!playing_ || !clipBuffer_)
     {
         memset(dest, 0, samples * (size_t)sampleSize_);
+        mixBlocksFinished_.store(block);
         return;
     }
 
+    UpdateVirtualVoices();
+
     while (samples)
     {
         // If sample count exceeds the fragment (clip buffer) size, split the work
@@ -297,26 +443,26 @@ void Audio::MixOutput(void* dest, unsigned samples)
         memset(clipPtr, 0, clipSamples * sizeof(int));
 
         // Mix samples to clip buffer
-        for (PODVector<SoundSource*>::Iterator i = soundSources_.Begin(); i != soundSources_.End(); ++i)
+        for (PODVector<SoundSource*>::Iterator i = mixSoundSources_.Begin(); i != mixSoundSources_.End(); ++i)
         {
             SoundSource* source = *i;
 
             // Check for pause if necessary
-            if (!pausedSoundTypes_.Empty())
+            if (!mixPausedSoundTypes_.Empty())
             {
-                if (pausedSoundTypes_.Contains(source->GetSoundType()))
+                if (mixPausedSoundTypes_.Contains(source->GetSoundTypeHash()))
                     continue;
             }
 
             source->Mix(clipPtr, workSamples, mixRate_, stereo_, interpolation_);
         }
         // Copy output from clip buffer to destination
-        auto* destPtr = (short*)dest;
-        while (clipSamples--)
-            *destPtr++ = (short)Clamp(*clipPtr++, -32768, 32767);
+        ClipSamples((short*)dest, clipPtr, clipSamples);
         samples -= workSamples;
         ((unsigned char*&)dest) += sampleSize_ * workSamples;
     }
+
+    mixBlocksFinished_.store(block);
 }
 
 void Audio::HandleRenderUpdate(StringHash eventType, VariantMap& eventData)
@@ -336,6 +482,142 @@ void Audio::Release()
         deviceID_ = 0;
         clipBuffer_.Reset();
     }
+
+    // Streams still playing fall back to decoding in the mixing thread
+    streamDecoder_.Reset();
+
+    // The mixing thread has exited, so apply the remaining commands here
+    ProcessCommands();
+    retiredResources_.Clear();
+}
+
+AudioCommand& Audio::AllocateCommand()
+{
+    unsigned write = commandWrite_.load(std::memory_order_relaxed);
+    if (write - commandRead_.load(std::memory_order_acquire) >= AUDIO_COMMAND_QUEUE_SIZE)
+    {
+        // The queue is full, for example because playback has not been started yet. Rather than waiting for the mixing
+        // thread, which may not be running, lock it out (waiting at most for the current mix block) and apply the
+        // queued commands here
+        SDL_LockAudioDevice(deviceID_);
+        ProcessCommands();
+        SDL_UnlockAudioDevice(deviceID_);
+    }
+
+    return commands_[write & (AUDIO_COMMAND_QUEUE_SIZE - 1)];
+}
+
+unsigned Audio::SubmitCommand(SoundSource* soundSource)
+{
+    unsigned write = commandWrite_.load(std::memory_order_relaxed);
+    commands_[write & (AUDIO_COMMAND_QUEUE_SIZE - 1)].source_.store(soundSource, std::memory_order_relaxed);
+    commandWrite_.store(++write, std::memory_order_release);
+
+    if (!deviceID_)
+        ProcessCommands();
+
+    return write;
+}
+
+void Audio::ProcessCommands()
+{
+    unsigned read = commandRead_.load(std::memory_order_relaxed);
+    unsigned write = commandWrite_.load(std::memory_order_acquire);
+
+    for (; read != write; ++read)
+    {
+        AudioCommand& command = commands_[read & (AUDIO_COMMAND_QUEUE_SIZE - 1)];
+        SoundSource* source = command.source_.exchange(nullptr);
+
+        switch (command.type_)
+        {
+        case AC_ADD_SOURCE:
+            if (source)
+                mixSoundSources_.Push(source);
+            break;
+
+        case AC_REMOVE_SOURCE:
+            mixSoundSources_.Remove(source);
+            break;
+
+        case AC_SET_PLAYBACK:
+            if (source)
+                source->SetMixPlayback(command.sound_, command.stream_, command.streamBuffer_, command.position_, command.timePosition_);
+            break;
+
+        case AC_PAUSE_TYPE:
+            mixPausedSoundTypes_.Insert(command.soundType_);
+            break;
+
+        case AC_RESUME_TYPE:
+            mixPausedSoundTypes_.Erase(command.soundType_);
+            break;
+
+        case AC_RESUME_ALL:
+            mixPausedSoundTypes_.Clear();
+            break;
+        }
+    }
+
+    commandRead_.store(read, std::memory_order_release);
+}
+
+void Audio::WaitForMixBlock()
+{
+    if (!deviceID_)
+        return;
+
+    // The command submitted before this must be ordered before reading the started block count, otherwise a mix block
+    // could start without seeing the command while still being missed here. Pairs with the fence in MixOutput()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    unsigned block = mixBlocksStarted_.load();
+
+    // Mix blocks started after the fence process the command first, so this waits at most for the duration of one mix
+    // block, which is short enough to yield instead of blocking on the audio device lock
+    while ((int)(mixBlocksFinished_.load() - block) < 0)
+        Time::Sleep(0);
+}
+
+void Audio::UpdateVirtualVoices()
+{
+    unsigned maxVoices = maxVoices_.load(std::memory_order_relaxed);
+    mixVoices_.Clear();
+
+    for (PODVector<SoundSource*>::Iterator i = mixSoundSources_.Begin(); i != mixSoundSources_.End(); ++i)
+    {
+        SoundSource* source = *i;
+        source->SetMixVirtual(false);
+
+        if (!maxVoices || (!mixPausedSoundTypes_.Empty() && mixPausedSoundTypes_.Contains(source->GetSoundTypeHash())))
+            continue;
+
+        // Silent sources are advanced without mixing anyway, so they do not take up a voice
+        float audibility = source->GetMixAudibility();
+        if (audibility > 0.0f)
+            mixVoices_.Push(MakePair(-audibility, source));
+    }
+
+    unsigned numVirtualVoices = 0;
+    if (maxVoices && mixVoices_.Size() > maxVoices)
+    {
+        Sort(mixVoices_.Begin(), mixVoices_.End());
+        for (unsigned i = maxVoices; i < mixVoices_.Size(); ++i)
+            mixVoices_[i].second_->SetMixVirtual(true);
+        numVirtualVoices = mixVoices_.Size() - maxVoices;
+    }
+
+    numVirtualVoices_.store(numVirtualVoices, std::memory_order_relaxed);
+}
+
+void Audio::ReleaseRetiredResources()
+{
+    // The resources were retired in command order, so the released ones are at the front
+    unsigned count = 0;
+    while (count < retiredResources_.Size() && !IsCommandPending(retiredResources_[count].first_))
+        ++count;
+
+    if (count)
+        retiredResources_.Erase(0, count);
 }
 
 void Audio::UpdateInternal(float timeStep)
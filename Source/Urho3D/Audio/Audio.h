@@ -25,16 +25,20 @@
 #include "../Audio/AudioDefs.h"
 #include "../Container/ArrayPtr.h"
 #include "../Container/HashSet.h"
-#include "../Core/Mutex.h"
 #include "../Core/Object.h"
 
+#include <atomic>
+
 namespace Urho3D
 {
 
+struct AudioCommand;
 class AudioImpl;
 class Sound;
 class SoundListener;
 class SoundSource;
+class SoundStream;
+class StreamDecoder;
 
 /// %Audio subsystem.
 class URHO3D_API Audio : public Object
@@ -69,6 +73,12 @@ public:
     void SetListener(SoundListener* listener);
     /// Stop any sound source playing a certain sound clip.
     void StopSound(Sound* sound);
+    /// Set priority of the audio mixing thread from -2 (lowest) to 2 (highest), 0 being normal. Applied on the next mixing callback. By default the priority chosen by SDL is kept.
+    /// @property
+    void SetThreadPriority(int priority);
+    /// Set maximum number of sound sources mixed at a time, 0 for unlimited (default). When more sources are audible, the least audible ones by gain, attenuation and priority only advance their play position.
+    /// @property
+    void SetMaxVoices(unsigned voices);
 
     /// Return byte size of one sample.
     /// @property
@@ -86,6 +96,18 @@ public:
     /// @property
     bool IsStereo() const { return stereo_; }
 
+    /// Return priority of the audio mixing thread, as set with SetThreadPriority().
+    /// @property
+    int GetThreadPriority() const { return threadPriority_; }
+
+    /// Return maximum number of sound sources mixed at a time, 0 for unlimited.
+    /// @property
+    unsigned GetMaxVoices() const { return maxVoices_; }
+
+    /// Return number of audible sound sources that were only advanced without mixing during the last mix block.
+    /// @property
+    unsigned GetNumVirtualVoices() const { return numVirtualVoices_; }
+
     /// Return whether audio is being output.
     /// @property
     bool IsPlaying() const { return playing_; }
@@ -105,6 +127,10 @@ public:
     /// @property
     SoundListener* GetListener() const;
 
+    /// Return the thread that decodes compressed sound streams ahead of playback, or null if no audio device is open.
+    /// @nobind
+    StreamDecoder* GetStreamDecoder() const { return streamDecoder_; }
+
     /// Return all sound sources.
     const PODVector<SoundSource*>& GetSoundSources() const { return soundSources_; }
 
@@ -116,12 +142,16 @@ public:
     /// Remove a sound source. Called by SoundSource.
     void RemoveSoundSource(SoundSource* soundSource);
 
-    /// Return audio thread mutex.
-    Mutex& GetMutex() { return audioMutex_; }
-
     /// Return sound type specific gain multiplied by master gain.
     float GetSoundSourceMasterGain(StringHash typeHash) const;
 
+    /// Queue a playback state change of a sound source for the mixing thread and return its command index. Called by SoundSource.
+    unsigned SetSoundSourcePlayback(SoundSource* soundSource, Sound* sound, SoundStream* stream, Sound* streamBuffer, signed char* position, float timePosition);
+    /// Keep a sound or sound stream alive until the mixing thread has processed the specified command. Called by SoundSource.
+    void RetireResource(RefCounted* resource, unsigned commandIndex);
+    /// Return whether the mixing thread has not yet processed the specified command.
+    bool IsCommandPending(unsigned commandIndex) const;
+
     /// Mix sound sources into the buffer.
     void MixOutput(void* dest, unsigned samples);
 
@@ -132,11 +162,33 @@ private:
     void Release();
     /// Actually update sound sources with the specific timestep. Called internally.
     void UpdateInternal(float timeStep);
+    /// Return the next free command queue slot. If the queue is full, apply the queued commands with the mixing thread locked out.
+    AudioCommand& AllocateCommand();
+    /// Make the command allocated last visible to the mixing thread and return its index. When no audio device is open, process it immediately.
+    unsigned SubmitCommand(SoundSource* soundSource);
+    /// Apply the queued commands. Called by the mixing thread at the start of each mix block, or by the main thread when no audio device is open or the mixing thread is locked out.
+    void ProcessCommands();
+    /// Wait until the mix block that may currently be running has finished. Waits at most for the duration of one mix block.
+    void WaitForMixBlock();
+    /// Release retired sounds and sound streams that the mixing thread no longer references.
+    void ReleaseRetiredResources();
+    /// Rank the audible sound sources and mark the ones exceeding the maximum number of voices as virtual. Called by the mixing thread.
+    void UpdateVirtualVoices();
 
     /// Clipping buffer for mixing.
     SharedArrayPtr<int> clipBuffer_;
-    /// Audio thread mutex.
-    Mutex audioMutex_;
+    /// Stream decode-ahead thread.
+    SharedPtr<StreamDecoder> streamDecoder_;
+    /// Command queue from the main thread to the mixing thread.
+    SharedArrayPtr<AudioCommand> commands_;
+    /// Command queue write index. Only advanced by the main thread.
+    std::atomic<unsigned> commandWrite_{};
+    /// Command queue read index. Only advanced by the consumer of the queue.
+    std::atomic<unsigned> commandRead_{};
+    /// Number of mix blocks started by the mixing thread.
+    std::atomic<unsigned> mixBlocksStarted_{};
+    /// Number of mix blocks finished by the mixing thread.
+    std::atomic<unsigned> mixBlocksFinished_{};
     /// SDL audio device ID.
     unsigned deviceID_{};
     /// Sample size.
@@ -150,13 +202,29 @@ private:
     /// Stereo flag.
     bool stereo_{};
     /// Playing flag.
-    bool playing_{};
+    std::atomic<bool> playing_{};
+    /// Mixing thread priority.
+    int threadPriority_{};
+    /// Mixing thread priority to be applied flag.
+    std::atomic<bool> threadPriorityDirty_{};
+    /// Maximum number of mixed sound sources, 0 for unlimited.
+    std::atomic<unsigned> maxVoices_{};
+    /// Number of virtual sound sources during the last mix block.
+    std::atomic<unsigned> numVirtualVoices_{};
     /// Master gain by sound source type.
     HashMap<StringHash, Variant> masterGain_;
     /// Paused sound types.
     HashSet<StringHash> pausedSoundTypes_;
     /// Sound sources.
     PODVector<SoundSource*> soundSources_;
+    /// Paused sound types as seen by the mixing thread.
+    HashSet<StringHash> mixPausedSoundTypes_;
+    /// Sound sources as seen by the mixing thread.
+    PODVector<SoundSource*> mixSoundSources_;
+    /// Audible sound sources sorted by negated audibility for voice ranking. Accessed only by the mixing thread.
+    PODVector<Pair<float, SoundSource*> > mixVoices_;
+    /// Sounds and sound streams waiting for the mixing thread to process the command that replaced them, with the command index.
+    Vector<Pair<unsigned, SharedPtr<RefCounted> > > retiredResources_;
     /// Sound listener.
     WeakPtr<SoundListener> listener_;
 };
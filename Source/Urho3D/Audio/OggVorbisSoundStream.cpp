@@ -24,6 +24,7 @@
 
 #include "../Audio/OggVorbisSoundStream.h"
 #include "../Audio/Sound.h"
+#include "../Audio/StreamDecoder.h"
 
 #include <STB/stb_vorbis.h>
 
@@ -32,6 +33,9 @@
 namespace Urho3D
 {
 
+/// Length of the decode-ahead buffer in milliseconds, rounded up to the next power of two size.
+static const unsigned DECODE_AHEAD_LENGTH = 250;
+
 OggVorbisSoundStream::OggVorbisSoundStream(const Sound* sound)
 {
     assert(sound && sound->IsCompressed());
@@ -49,6 +53,10 @@ OggVorbisSoundStream::OggVorbisSoundStream(const Sound* sound)
 
 OggVorbisSoundStream::~OggVorbisSoundStream()
 {
+    // Make sure the decoding thread is done with the stream
+    if (streamDecoder_)
+        streamDecoder_->RemoveStream(this);
+
     // Close decoder
     if (decoder_)
     {
@@ -66,7 +74,16 @@ bool OggVorbisSoundStream::Seek(unsigned sample_number)
 
     auto* vorbis = static_cast<stb_vorbis*>(decoder_);
 
-    return stb_vorbis_seek(vorbis, sample_number) == 1;
+    if (!decodeBuffer_)
+        return stb_vorbis_seek(vorbis, sample_number) == 1;
+
+    MutexLock lock(decoderMutex_);
+    bool success = stb_vorbis_seek(vorbis, sample_number) == 1;
+    // Have the mixing thread skip the data decoded before the seek
+    ended_ = false;
+    discardPosition_.store(writePosition_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    discardPending_.store(true, std::memory_order_release);
+    return success;
 }
 
 unsigned OggVorbisSoundStream::GetData(signed char* dest, unsigned numBytes)
@@ -74,6 +91,67 @@ unsigned OggVorbisSoundStream::GetData(signed char* dest, unsigned numBytes)
     if (!decoder_)
         return 0;
 
+    if (!decodeBuffer_)
+        return Decode(dest, numBytes);
+
+    unsigned outBytes = ReadFromBuffer(dest, numBytes);
+    if (outBytes == numBytes || ended_)
+        return outBytes;
+
+    // The decoding thread has fallen behind. Decode directly unless it is decoding right now, in which case output
+    // silence rather than block the mixing thread
+    if (decoderMutex_.TryAcquire())
+    {
+        outBytes += ReadFromBuffer(dest + outBytes, numBytes - outBytes);
+        if (outBytes < numBytes)
+            outBytes += Decode(dest + outBytes, numBytes - outBytes);
+        decoderMutex_.Release();
+    }
+    else
+    {
+        memset(dest + outBytes, 0, numBytes - outBytes);
+        outBytes = numBytes;
+    }
+
+    return outBytes;
+}
+
+bool OggVorbisSoundStream::StartDecodeAhead(StreamDecoder* decoder)
+{
+    if (!decoder || !decoder_ || decodeBuffer_)
+        return false;
+
+    decodeBufferSize_ = NextPowerOfTwo(GetSampleSize() * frequency_ * DECODE_AHEAD_LENGTH / 1000);
+    decodeBuffer_ = new signed char[decodeBufferSize_];
+
+    // Decode the start so that playback does not begin with an underrun
+    {
+        MutexLock lock(decoderMutex_);
+        DecodeToBuffer(decodeBufferSize_ >> 2u);
+    }
+
+    streamDecoder_ = decoder;
+    decoder->AddStream(this);
+    return true;
+}
+
+bool OggVorbisSoundStream::DecodeAhead()
+{
+    if (ended_)
+        return false;
+
+    MutexLock lock(decoderMutex_);
+
+    // Decode in larger chunks instead of topping up after every mix block
+    unsigned freeBytes = decodeBufferSize_ - (writePosition_.load(std::memory_order_relaxed) - readPosition_.load(std::memory_order_acquire));
+    if (freeBytes < (decodeBufferSize_ >> 2u))
+        return false;
+
+    return DecodeToBuffer(freeBytes) != 0;
+}
+
+unsigned OggVorbisSoundStream::Decode(signed char* dest, unsigned numBytes)
+{
     auto* vorbis = static_cast<stb_vorbis*>(decoder_);
 
     unsigned channels = stereo_ ? 2 : 1;
@@ -89,8 +167,49 @@ unsigned OggVorbisSoundStream::GetData(signed char* dest, unsigned numBytes)
             (unsigned)stb_vorbis_get_samples_short_interleaved(vorbis, channels, (short*)(dest + outBytes), numBytes >> 1u);
         outBytes += (outSamples * channels) << 1u;
     }
+    else if (outBytes < numBytes)
+        ended_ = true;
 
     return outBytes;
 }
 
+unsigned OggVorbisSoundStream::DecodeToBuffer(unsigned maxBytes)
+{
+    unsigned write = writePosition_.load(std::memory_order_relaxed);
+    unsigned freeBytes = decodeBufferSize_ - (write - readPosition_.load(std::memory_order_acquire));
+    unsigned numBytes = Min(maxBytes, freeBytes);
+
+    // Decode up to the end of the ring buffer first, then wrap to the start
+    unsigned outBytes = 0;
+    while (outBytes < numBytes && !ended_)
+    {
+        unsigned offset = (write + outBytes) & (decodeBufferSize_ - 1);
+        unsigned chunk = Min(numBytes - outBytes, decodeBufferSize_ - offset);
+        unsigned decoded = Decode(decodeBuffer_.Get() + offset, chunk);
+        outBytes += decoded;
+        if (decoded < chunk)
+            break;
+    }
+
+    writePosition_.store(write + outBytes, std::memory_order_release);
+    return outBytes;
+}
+
+unsigned OggVorbisSoundStream::ReadFromBuffer(signed char* dest, unsigned numBytes)
+{
+    unsigned read = readPosition_.load(std::memory_order_relaxed);
+    if (discardPending_.exchange(false, std::memory_order_acquire))
+        read = discardPosition_.load(std::memory_order_relaxed);
+
+    unsigned copyBytes = Min(numBytes, writePosition_.load(std::memory_order_acquire) - read);
+    unsigned offset = read & (decodeBufferSize_ - 1);
+    unsigned firstBytes = Min(copyBytes, decodeBufferSize_ - offset);
+    memcpy(dest, decodeBuffer_.Get() + offset, firstBytes);
+    if (firstBytes < copyBytes)
+        memcpy(dest + firstBytes, decodeBuffer_.Get(), copyBytes - firstBytes);
+
+    readPosition_.store(read + copyBytes, std::memory_order_release);
+    return copyBytes;
+}
+
 }
@@ -24,6 +24,10 @@
 
 #include "../Audio/SoundStream.h"
 #include "../Container/ArrayPtr.h"
+#include "../Container/Ptr.h"
+#include "../Core/Mutex.h"
+
+#include <atomic>
 
 namespace Urho3D
 {
@@ -42,16 +46,45 @@ public:
     /// Seek to sample number. Return true on success.
     bool Seek(unsigned sample_number) override;
 
-    /// Produce sound data into destination. Return number of bytes produced. Called by SoundSource from the mixing thread.
+    /// Produce sound data into destination. Return number of bytes produced. Called by SoundSource from the mixing thread. When decoding ahead, copies the already decoded data and only decodes by itself if the decoding thread has fallen behind.
     unsigned GetData(signed char* dest, unsigned numBytes) override;
+    /// Start decoding ahead of playback on the stream decoder thread. Decodes the first part of the sound immediately.
+    bool StartDecodeAhead(StreamDecoder* decoder) override;
+    /// Decode data ahead of playback into the decode buffer. Return true if any data was decoded. Called by StreamDecoder from the decoding thread.
+    bool DecodeAhead() override;
 
 protected:
+    /// Decode directly into destination, rewinding if looped. Return number of bytes produced. The decoder mutex must be held when decoding ahead.
+    unsigned Decode(signed char* dest, unsigned numBytes);
+    /// Decode up to the specified number of bytes into the decode buffer. Return number of bytes decoded. The decoder mutex must be held.
+    unsigned DecodeToBuffer(unsigned maxBytes);
+    /// Copy decoded data from the decode buffer. Return number of bytes copied. Called from the mixing thread.
+    unsigned ReadFromBuffer(signed char* dest, unsigned numBytes);
+
     /// Decoder state.
     void* decoder_;
     /// Compressed sound data.
     SharedArrayPtr<signed char> data_;
     /// Compressed sound data size in bytes.
     unsigned dataSize_;
+    /// Stream decoder thread when decoding ahead.
+    WeakPtr<StreamDecoder> streamDecoder_;
+    /// Decode-ahead ring buffer.
+    SharedArrayPtr<signed char> decodeBuffer_;
+    /// Decode-ahead ring buffer size in bytes. Always a power of two.
+    unsigned decodeBufferSize_{};
+    /// Total bytes decoded into the ring buffer. Only advanced by the decoding thread.
+    std::atomic<unsigned> writePosition_{};
+    /// Total bytes read from the ring buffer. Only advanced by the mixing thread.
+    std::atomic<unsigned> readPosition_{};
+    /// Write position at the last seek. Data before it is discarded by the mixing thread.
+    std::atomic<unsigned> discardPosition_{};
+    /// Discard pending flag, set by a seek.
+    std::atomic<bool> discardPending_{};
+    /// End of a non-looped sound reached flag.
+    std::atomic<bool> ended_{};
+    /// Mutex for the decoder state when decoding ahead.
+    Mutex decoderMutex_;
 };
 
 }
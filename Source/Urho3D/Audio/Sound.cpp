@@ -22,12 +22,15 @@
 
 #include "../Precompiled.h"
 
+#include "../Audio/Adpcm.h"
+#include "../Audio/AdpcmSoundStream.h"
 #include "../Audio/OggVorbisSoundStream.h"
 #include "../Audio/Sound.h"
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
+#include "../IO/Serializer.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/XMLFile.h"
 #ifndef STB_VORBIS_HEADER_ONLY
@@ -60,6 +63,9 @@ struct WavHeader
 
 static const unsigned IP_SAFETY = 4;
 
+static const unsigned short WAVE_FORMAT_PCM = 1;
+static const unsigned short WAVE_FORMAT_IMA_ADPCM = 0x11;
+
 Sound::Sound(Context* context) :
     ResourceWithMetadata(context),
     repeat_(nullptr),
@@ -126,6 +132,7 @@ bool Sound::LoadOggVorbis(Deserializer& source)
     dataSize_ = dataSize;
     sixteenBit_ = true;
     compressed_ = true;
+    adpcmBlockSize_ = 0;
 
     SetMemoryUse(dataSize);
     return true;
@@ -164,6 +171,7 @@ bool Sound::LoadWav(Deserializer& source)
     }
 
     // Read the FORMAT chunk
+    unsigned formatStart = source.GetPosition();
     header.format_ = source.ReadUShort();
     header.channels_ = source.ReadUShort();
     header.frequency_ = source.ReadUInt();
@@ -171,17 +179,30 @@ bool Sound::LoadWav(Deserializer& source)
     header.blockAlign_ = source.ReadUShort();
     header.bits_ = source.ReadUShort();
 
+    // IMA ADPCM stores the sample frames per block in the extended format
+    unsigned samplesPerBlock = 0;
+    if (header.format_ == WAVE_FORMAT_IMA_ADPCM && header.formatLength_ >= 20)
+    {
+        source.ReadUShort();
+        samplesPerBlock = source.ReadUShort();
+    }
+
     // Skip data if the format chunk was bigger than what we use
-    source.Seek(source.GetPosition() + header.formatLength_ - 16);
+    source.Seek(formatStart + header.formatLength_);
 
     // Check for correct format
-    if (header.format_ != 1)
+    bool adpcm = header.format_ == WAVE_FORMAT_IMA_ADPCM;
+    unsigned framesPerBlock = adpcm ? Urho3D::GetAdpcmFramesPerBlock(header.blockAlign_, header.channels_) : 0;
+    bool adpcmValid = header.bits_ == 4 && header.channels_ >= 1 && header.channels_ <= 2 && framesPerBlock &&
+        (!samplesPerBlock || samplesPerBlock == framesPerBlock);
+    if ((header.format_ != WAVE_FORMAT_PCM && !adpcm) || (adpcm && !adpcmValid))
     {
         URHO3D_LOGERROR("Could not read WAV data from " + source.GetName());
         return false;
     }
 
-    // Search for the DATA chunk
+    // Search for the DATA chunk. The FACT chunk before it holds the length of compressed data in sample frames
+    unsigned factFrames = 0;
     for (;;)
     {
         source.Read(&header.dataText_, 4);
@@ -189,7 +210,11 @@ bool Sound::LoadWav(Deserializer& source)
         if (!memcmp("data", &header.dataText_, 4))
             break;
 
-        source.Seek(source.GetPosition() + header.dataLength_);
+        unsigned chunkStart = source.GetPosition();
+        if (!memcmp("fact", &header.dataText_, 4) && header.dataLength_ >= 4)
+            factFrames = source.ReadUInt();
+
+        source.Seek(chunkStart + header.dataLength_);
         if (!header.dataLength_ || source.GetPosition() >= source.GetSize())
         {
             URHO3D_LOGERROR("Could not read WAV data from " + source.GetName());
@@ -199,6 +224,28 @@ bool Sound::LoadWav(Deserializer& source)
 
     // Allocate sound and load audio data
     unsigned length = header.dataLength_;
+    if (adpcm)
+    {
+        // Keep ADPCM data compressed, it is decoded a block at a time while mixing
+        unsigned maxFrames = length / header.blockAlign_ * framesPerBlock +
+            Urho3D::GetAdpcmFramesPerBlock(length % header.blockAlign_, header.channels_);
+
+        SetSize(length);
+        SetFormat(header.frequency_, true, header.channels_ == 2);
+        if (source.Read(data_.Get(), length) != length)
+        {
+            URHO3D_LOGERROR("Could not read WAV data from " + source.GetName());
+            return false;
+        }
+
+        adpcmBlockSize_ = header.blockAlign_;
+        adpcmFramesPerBlock_ = framesPerBlock;
+        adpcmFrames_ = factFrames ? Min(factFrames, maxFrames) : maxFrames;
+        compressed_ = true;
+        compressedLength_ = frequency_ ? (float)adpcmFrames_ / frequency_ : 0.0f;
+        return true;
+    }
+
     SetSize(length);
     SetFormat(header.frequency_, header.bits_ == 16, header.channels_ == 2);
     source.Read(data_.Get(), length);
@@ -228,6 +275,7 @@ void Sound::SetSize(unsigned dataSize)
     data_ = new signed char[dataSize + IP_SAFETY];
     dataSize_ = dataSize;
     compressed_ = false;
+    adpcmBlockSize_ = 0;
     SetLooped(false);
 
     SetMemoryUse(dataSize + IP_SAFETY);
@@ -248,6 +296,7 @@ void Sound::SetFormat(unsigned frequency, bool sixteenBit, bool stereo)
     sixteenBit_ = sixteenBit;
     stereo_ = stereo;
     compressed_ = false;
+    adpcmBlockSize_ = 0;
 }
 
 void Sound::SetLooped(bool enable)
@@ -312,7 +361,78 @@ void Sound::FixInterpolation()
 
 SharedPtr<SoundStream> Sound::GetDecoderStream() const
 {
-    return compressed_ ? SharedPtr<SoundStream>(new OggVorbisSoundStream(this)) : SharedPtr<SoundStream>();
+    if (!compressed_)
+        return SharedPtr<SoundStream>();
+    else if (IsAdpcm())
+        return SharedPtr<SoundStream>(new AdpcmSoundStream(this));
+    else
+        return SharedPtr<SoundStream>(new OggVorbisSoundStream(this));
+}
+
+bool Sound::SaveAdpcmWav(Serializer& dest) const
+{
+    if (compressed_ || !data_ || !frequency_)
+    {
+        URHO3D_LOGERROR("Can not save compressed or empty sound as ADPCM");
+        return false;
+    }
+
+    // Convert to 16-bit samples first
+    unsigned channels = stereo_ ? 2 : 1;
+    unsigned numSamples = dataSize_ / (sixteenBit_ ? 2 : 1);
+    unsigned numFrames = numSamples / channels;
+    if (!numFrames)
+        return false;
+
+    PODVector<short> samples(numSamples);
+    if (sixteenBit_)
+        memcpy(samples.Buffer(), data_.Get(), numSamples * sizeof(short));
+    else
+    {
+        for (unsigned i = 0; i < numSamples; ++i)
+            samples[i] = (short)(data_[i] * 256);
+    }
+
+    // Use the customary block size, which grows with the frequency
+    unsigned blockSize = 256 * channels * Max(frequency_ / 11025, 1U);
+    unsigned framesPerBlock = Urho3D::GetAdpcmFramesPerBlock(blockSize, channels);
+    unsigned numBlocks = (numFrames + framesPerBlock - 1) / framesPerBlock;
+    unsigned compressedSize = numBlocks * blockSize;
+
+    SharedArrayPtr<unsigned char> compressed(new unsigned char[compressedSize]);
+    int stepIndices[2] = {0, 0};
+    for (unsigned i = 0; i < numBlocks; ++i)
+    {
+        unsigned startFrame = i * framesPerBlock;
+        EncodeAdpcmBlock(compressed.Get() + i * blockSize, samples.Buffer() + startFrame * channels,
+            Min(framesPerBlock, numFrames - startFrame), channels, blockSize, stepIndices);
+    }
+
+    bool success = true;
+    success &= dest.WriteFileID("RIFF");
+    success &= dest.WriteUInt(4 + 8 + 20 + 8 + 4 + 8 + compressedSize);
+    success &= dest.WriteFileID("WAVE");
+
+    success &= dest.WriteFileID("fmt ");
+    success &= dest.WriteUInt(20);
+    success &= dest.WriteUShort(WAVE_FORMAT_IMA_ADPCM);
+    success &= dest.WriteUShort((unsigned short)channels);
+    success &= dest.WriteUInt(frequency_);
+    success &= dest.WriteUInt(frequency_ * blockSize / framesPerBlock);
+    success &= dest.WriteUShort((unsigned short)blockSize);
+    success &= dest.WriteUShort(4);
+    success &= dest.WriteUShort(2);
+    success &= dest.WriteUShort((unsigned short)framesPerBlock);
+
+    success &= dest.WriteFileID("fact");
+    success &= dest.WriteUInt(4);
+    success &= dest.WriteUInt(numFrames);
+
+    success &= dest.WriteFileID("data");
+    success &= dest.WriteUInt(compressedSize);
+    success &= dest.Write(compressed.Get(), compressedSize) == compressedSize;
+
+    return success;
 }
 
 float Sound::GetLength() const
@@ -28,6 +28,7 @@
 namespace Urho3D
 {
 
+class Serializer;
 class SoundStream;
 
 /// %Sound resource.
@@ -49,7 +50,7 @@ public:
 
     /// Load raw sound data.
     bool LoadRaw(Deserializer& source);
-    /// Load WAV format sound data.
+    /// Load WAV format sound data. PCM data is loaded uncompressed, while IMA ADPCM data stays compressed in memory and is decoded while playing.
     bool LoadWav(Deserializer& source);
     /// Load Ogg Vorbis format sound data. Does not decode at load, but will rather be decoded while playing.
     bool LoadOggVorbis(Deserializer& source);
@@ -67,6 +68,8 @@ public:
 
     /// Return a new instance of a decoder sound stream. Used by compressed sounds.
     SharedPtr<SoundStream> GetDecoderStream() const;
+    /// Save uncompressed sound data as an IMA ADPCM compressed WAV file. Return true if successful.
+    bool SaveAdpcmWav(Serializer& dest) const;
 
     /// Return shared sound data.
     SharedArrayPtr<signed char> GetData() const { return data_; }
@@ -114,6 +117,18 @@ public:
     /// @property
     bool IsCompressed() const { return compressed_; }
 
+    /// Return whether is IMA ADPCM compressed.
+    bool IsAdpcm() const { return adpcmBlockSize_ != 0; }
+
+    /// Return IMA ADPCM block size in bytes, or 0 if not ADPCM compressed.
+    unsigned GetAdpcmBlockSize() const { return adpcmBlockSize_; }
+
+    /// Return IMA ADPCM sample frames per block.
+    unsigned GetAdpcmFramesPerBlock() const { return adpcmFramesPerBlock_; }
+
+    /// Return IMA ADPCM total sample frames.
+    unsigned GetAdpcmFrames() const { return adpcmFrames_; }
+
     /// Fix interpolation by copying data from loop start to loop end (looped), or adding silence (oneshot). Called internally, does not normally need to be called, unless the sound data is modified manually on the fly.
     void FixInterpolation();
 
@@ -141,6 +156,12 @@ private:
     bool compressed_;
     /// Compressed sound length.
     float compressedLength_;
+    /// IMA ADPCM block size in bytes. Zero if not ADPCM compressed.
+    unsigned adpcmBlockSize_{};
+    /// IMA ADPCM sample frames per block.
+    unsigned adpcmFramesPerBlock_{};
+    /// IMA ADPCM total sample frames.
+    unsigned adpcmFrames_{};
 };
 
 }
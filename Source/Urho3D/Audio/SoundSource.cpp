@@ -33,69 +33,188 @@
 #include "../Scene/Node.h"
 #include "../Scene/ReplicationState.h"
 
+#if defined(URHO3D_SSE)
+#include <emmintrin.h>
+#elif defined(URHO3D_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "../DebugNew.h"
 
 namespace Urho3D
 {
 
-#define INC_POS_LOOPED() \
-    pos += intAdd; \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        ++pos; \
-    } \
-    while (pos >= end) \
-        pos -= (end - repeat); \
-
-#define INC_POS_ONESHOT() \
-    pos += intAdd; \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        ++pos; \
-    } \
-    if (pos >= end) \
-    { \
-        pos = 0; \
-        break; \
-    } \
-
-#define INC_POS_STEREO_LOOPED() \
-    pos += ((unsigned)intAdd << 1u); \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        pos += 2; \
-    } \
-    while (pos >= end) \
-        pos -= (end - repeat); \
-
-#define INC_POS_STEREO_ONESHOT() \
-    pos += ((unsigned)intAdd << 1u); \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        pos += 2; \
-    } \
-    if (pos >= end) \
-    { \
-        pos = 0; \
-        break; \
-    } \
-
-#define GET_IP_SAMPLE() (((((int)pos[1] - (int)pos[0]) * fractPos) / 65536) + (int)pos[0])
-
-#define GET_IP_SAMPLE_LEFT() (((((int)pos[2] - (int)pos[0]) * fractPos) / 65536) + (int)pos[0])
-
-#define GET_IP_SAMPLE_RIGHT() (((((int)pos[3] - (int)pos[1]) * fractPos) / 65536) + (int)pos[1])
-
 static const int STREAM_SAFETY_SAMPLES = 4;
 
+/// Mix a run of frames that stays before the end of the sound. The source position advances by step / 65536 frames per
+/// output frame. Samples are interpolated and scaled by the channel gains in floating point, then truncated and added to
+/// the mix buffer, four frames at a time when SSE or NEON is available.
+template <class T, bool StereoSource, bool StereoOutput, bool Interpolate>
+static void MixRun(const T*& pos, int& fractPos, int step, int*& dest, unsigned frames, float leftGain, float rightGain)
+{
+    const int channels = StereoSource ? 2 : 1;
+    unsigned i = 0;
+
+#if defined(URHO3D_SSE) || defined(URHO3D_NEON)
+    alignas(16) int left0[4];
+    alignas(16) int left1[4];
+    alignas(16) int right0[4];
+    alignas(16) int right1[4];
+    alignas(16) int fract[4];
+
+    for (; i + 4 <= frames; i += 4)
+    {
+        // Resampling prevents contiguous loads in general, so gather the source frames first
+        for (int k = 0; k < 4; ++k)
+        {
+            int p = fractPos + k * step;
+            const T* frame = pos + (p >> 16) * channels;
+            fract[k] = p & 65535;
+            left0[k] = frame[0];
+            right0[k] = frame[channels - 1];
+            if (Interpolate)
+            {
+                left1[k] = frame[channels];
+                right1[k] = frame[2 * channels - 1];
+            }
+        }
+        fractPos += 4 * step;
+        pos += (fractPos >> 16) * channels;
+        fractPos &= 65535;
+
+#ifdef URHO3D_SSE
+        __m128 left = _mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(left0)));
+        __m128 right = _mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(right0)));
+        if (Interpolate)
+        {
+            __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(fract))), _mm_set1_ps(1.0f / 65536.0f));
+            __m128 nextLeft = _mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(left1)));
+            __m128 nextRight = _mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(right1)));
+            left = _mm_add_ps(left, _mm_mul_ps(_mm_sub_ps(nextLeft, left), t));
+            right = _mm_add_ps(right, _mm_mul_ps(_mm_sub_ps(nextRight, right), t));
+        }
+
+        auto* d = reinterpret_cast<__m128i*>(dest);
+        if (StereoOutput)
+        {
+            __m128i leftOut = _mm_cvttps_epi32(_mm_mul_ps(left, _mm_set1_ps(leftGain)));
+            __m128i rightOut = _mm_cvttps_epi32(_mm_mul_ps(right, _mm_set1_ps(rightGain)));
+            _mm_storeu_si128(d, _mm_add_epi32(_mm_loadu_si128(d), _mm_unpacklo_epi32(leftOut, rightOut)));
+            _mm_storeu_si128(d + 1, _mm_add_epi32(_mm_loadu_si128(d + 1), _mm_unpackhi_epi32(leftOut, rightOut)));
+            dest += 8;
+        }
+        else
+        {
+            __m128 mono = StereoSource ? _mm_mul_ps(_mm_add_ps(left, right), _mm_set1_ps(0.5f)) : left;
+            __m128i out = _mm_cvttps_epi32(_mm_mul_ps(mono, _mm_set1_ps(leftGain)));
+            _mm_storeu_si128(d, _mm_add_epi32(_mm_loadu_si128(d), out));
+            dest += 4;
+        }
+#else
+        float32x4_t left = vcvtq_f32_s32(vld1q_s32(left0));
+        float32x4_t right = vcvtq_f32_s32(vld1q_s32(right0));
+        if (Interpolate)
+        {
+            float32x4_t t = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(fract)), 1.0f / 65536.0f);
+            left = vmlaq_f32(left, vsubq_f32(vcvtq_f32_s32(vld1q_s32(left1)), left), t);
+            right = vmlaq_f32(right, vsubq_f32(vcvtq_f32_s32(vld1q_s32(right1)), right), t);
+        }
+
+        if (StereoOutput)
+        {
+            int32x4x2_t out = vld2q_s32(dest);
+            out.val[0] = vaddq_s32(out.val[0], vcvtq_s32_f32(vmulq_n_f32(left, leftGain)));
+            out.val[1] = vaddq_s32(out.val[1], vcvtq_s32_f32(vmulq_n_f32(right, rightGain)));
+            vst2q_s32(dest, out);
+            dest += 8;
+        }
+        else
+        {
+            float32x4_t mono = StereoSource ? vmulq_n_f32(vaddq_f32(left, right), 0.5f) : left;
+            vst1q_s32(dest, vaddq_s32(vld1q_s32(dest), vcvtq_s32_f32(vmulq_n_f32(mono, leftGain))));
+            dest += 4;
+        }
+#endif
+    }
+#endif
+
+    for (; i < frames; ++i)
+    {
+        float left = pos[0];
+        float right = pos[channels - 1];
+        if (Interpolate)
+        {
+            float t = (float)fractPos * (1.0f / 65536.0f);
+            left += ((float)pos[channels] - left) * t;
+            right += ((float)pos[2 * channels - 1] - right) * t;
+        }
+
+        if (StereoOutput)
+        {
+            dest[0] += (int)(left * leftGain);
+            dest[1] += (int)(right * rightGain);
+            dest += 2;
+        }
+        else
+            *dest++ += (int)((StereoSource ? (left + right) * 0.5f : left) * leftGain);
+
+        fractPos += step;
+        pos += (fractPos >> 16) * channels;
+        fractPos &= 65535;
+    }
+}
+
+/// Mix samples of a sound to the mix buffer. Looped sounds wrap to the repeat point at the end; one-shot sounds stop and
+/// clear the position.
+template <class T, bool StereoSource, bool StereoOutput, bool Interpolate>
+static void MixSamples(Sound* sound, volatile signed char*& position, volatile int& fractPosition, int* dest, unsigned samples,
+    float add, float leftGain, float rightGain)
+{
+    const int channels = StereoSource ? 2 : 1;
+    auto intAdd = (int)add;
+    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
+    int step = (intAdd << 16) + fractAdd;
+
+    auto* pos = (const T*)(signed char*)position;
+    auto* end = (const T*)sound->GetEnd();
+    auto* repeat = (const T*)sound->GetRepeat();
+    int fractPos = fractPosition;
+
+    while (samples)
+    {
+        // The frames that stay before the end of the sound need no end checks, so mix them as one run
+        long long distance = (((long long)(end - pos) / channels) << 16) - fractPos - 1;
+        unsigned run = samples;
+        if (step > 0 && distance / step < (long long)samples)
+            run = distance > 0 ? (unsigned)(distance / step) : 0;
+
+        MixRun<T, StereoSource, StereoOutput, Interpolate>(pos, fractPos, step, dest, run, leftGain, rightGain);
+        samples -= run;
+        if (!samples)
+            break;
+
+        // Mix the frame that reaches the end, then wrap or stop
+        MixRun<T, StereoSource, StereoOutput, Interpolate>(pos, fractPos, step, dest, 1, leftGain, rightGain);
+        --samples;
+        if (pos >= end)
+        {
+            if (sound->IsLooped())
+            {
+                while (pos >= end)
+                    pos -= (end - repeat);
+            }
+            else
+            {
+                pos = nullptr;
+                break;
+            }
+        }
+    }
+
+    position = (signed char*)pos;
+    fractPosition = fractPos;
+}
+
 extern const char* AUDIO_CATEGORY;
 
 extern const char* autoRemoveModeNames[];
@@ -103,10 +222,12 @@ extern const char* autoRemoveModeNames[];
 SoundSource::SoundSource(Context* context) :
     Component(context),
     soundType_(SOUND_EFFECT),
+    soundTypeHash_(SOUND_EFFECT),
     frequency_(0.0f),
     gain_(1.0f),
     attenuation_(1.0f),
     panning_(0.0f),
+    priority_(1.0f),
     sendFinishedEvent_(false),
     autoRemove_(REMOVE_DISABLED),
     position_(nullptr),
@@ -139,6 +260,7 @@ void SoundSource::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Gain", float, gain_, 1.0f, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Attenuation", float, attenuation_, 1.0f, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Panning", float, panning_, 0.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Priority", float, priority_, 1.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Is Playing", IsPlaying, SetPlayingAttr, bool, false, AM_DEFAULT);
     URHO3D_ENUM_ATTRIBUTE("Autoremove Mode", autoRemove_, autoRemoveModeNames, REMOVE_DISABLED, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Play Position", GetPositionAttr, SetPositionAttr, int, 0, AM_FILE);
@@ -177,14 +299,7 @@ void SoundSource::Play(Sound* sound)
     if (frequency_ == 0.0f && sound)
         SetFrequency(sound->GetFrequency());
 
-    // If sound source is currently playing, have to lock the audio mutex
-    if (position_)
-    {
-        MutexLock lock(audio_->GetMutex());
-        PlayLockless(sound);
-    }
-    else
-        PlayLockless(sound);
+    PlayInternal(sound);
 
     // Forget the Sound & Is Playing attribute previous values so that they will be sent again, triggering
     // the sound correctly on network clients even after the initial playback
@@ -233,21 +348,8 @@ void SoundSource::Play(SoundStream* stream)
     if (frequency_ == 0.0f && stream)
         SetFrequency(stream->GetFrequency());
 
-    SharedPtr<SoundStream> streamPtr(stream);
-
-    // If sound source is currently playing, have to lock the audio mutex. When stream playback is explicitly
-    // requested, clear the existing sound if any
-    if (position_)
-    {
-        MutexLock lock(audio_->GetMutex());
-        sound_.Reset();
-        PlayLockless(streamPtr);
-    }
-    else
-    {
-        sound_.Reset();
-        PlayLockless(streamPtr);
-    }
+    // When stream playback is explicitly requested, clear the existing sound if any
+    PlayInternal(nullptr, SharedPtr<SoundStream>(stream));
 
     // Stream playback is not supported for network replication, no need to mark network dirty
 }
@@ -257,14 +359,7 @@ void SoundSource::Stop()
     if (!audio_)
         return;
 
-    // If sound source is currently playing, have to lock the audio mutex
-    if (position_)
-    {
-        MutexLock lock(audio_->GetMutex());
-        StopLockless();
-    }
-    else
-        StopLockless();
+    StopInternal();
 
     MarkNetworkUpdate();
 }
@@ -305,15 +400,29 @@ void SoundSource::SetPanning(float panning)
     MarkNetworkUpdate();
 }
 
+void SoundSource::SetPriority(float priority)
+{
+    priority_ = Max(priority, 0.0f);
+    MarkNetworkUpdate();
+}
+
 void SoundSource::SetAutoRemoveMode(AutoRemoveMode mode)
 {
     autoRemove_ = mode;
     MarkNetworkUpdate();
 }
 
+volatile signed char* SoundSource::GetPlayPosition() const
+{
+    if (audio_ && audio_->IsCommandPending(playbackCommand_))
+        return requestedPosition_;
+    else
+        return position_;
+}
+
 bool SoundSource::IsPlaying() const
 {
-    return (sound_ || soundStream_) && position_ != nullptr;
+    return (sound_ || soundStream_) && GetPlayPosition() != nullptr;
 }
 
 void SoundSource::SetPlayPosition(signed char* pos)
@@ -322,8 +431,16 @@ void SoundSource::SetPlayPosition(signed char* pos)
     if (!audio_ || !sound_ || soundStream_)
         return;
 
-    MutexLock lock(audio_->GetMutex());
-    SetPlayPositionLockless(pos);
+    signed char* start = sound_->GetStart();
+    signed char* end = sound_->GetEnd();
+    if (pos < start)
+        pos = start;
+    if (sound_->IsSixteenBit() && (pos - start) & 1u)
+        ++pos;
+    if (pos > end)
+        pos = end;
+
+    SetPlayback(sound_, nullptr, nullptr, pos, ((float)(int)(size_t)(pos - start)) / (sound_->GetSampleSize() * sound_->GetFrequency()));
 }
 
 void SoundSource::Update(float timeStep)
@@ -336,8 +453,8 @@ void SoundSource::Update(float timeStep)
         MixNull(timeStep);
 
     // Free the stream if playback has stopped
-    if (soundStream_ && !position_)
-        StopLockless();
+    if (soundStream_ && !GetPlayPosition())
+        StopInternal();
 
     bool playing = IsPlaying();
 
@@ -365,28 +482,33 @@ void SoundSource::Update(float timeStep)
 
 void SoundSource::Mix(int* dest, unsigned samples, int mixRate, bool stereo, bool interpolation)
 {
-    if (!position_ || (!sound_ && !soundStream_) || !IsEnabledEffective())
+    if (!position_ || (!mixSound_ && !mixStream_) || !IsEnabledEffective())
         return;
 
+    // Snapshot the parameters set from the main thread once per mix block. Virtual voices advance at zero volume
+    mixGain_ = mixVirtual_ ? 0.0f : masterGain_ * attenuation_ * gain_;
+    mixPanning_ = panning_;
+    mixFrequency_ = frequency_;
+
     int streamFilledSize, outBytes;
 
-    if (soundStream_ && streamBuffer_)
+    if (mixStream_ && mixStreamBuffer_)
     {
-        int streamBufferSize = streamBuffer_->GetDataSize();
+        int streamBufferSize = mixStreamBuffer_->GetDataSize();
         // Calculate how many bytes of stream sound data is needed
-        auto neededSize = (int)((float)samples * frequency_ / (float)mixRate);
+        auto neededSize = (int)((float)samples * mixFrequency_ / (float)mixRate);
         // Add a little safety buffer. Subtract previous unused data
         neededSize += STREAM_SAFETY_SAMPLES;
-        neededSize *= soundStream_->GetSampleSize();
+        neededSize *= mixStream_->GetSampleSize();
         neededSize -= unusedStreamSize_;
         neededSize = Clamp(neededSize, 0, streamBufferSize - unusedStreamSize_);
 
         // Always start play position at the beginning of the stream buffer
-        position_ = streamBuffer_->GetStart();
+        position_ = mixStreamBuffer_->GetStart();
 
         // Request new data from the stream
-        signed char* destination = streamBuffer_->GetStart() + unusedStreamSize_;
-        outBytes = neededSize ? soundStream_->GetData(destination, (unsigned)neededSize) : 0;
+        signed char* destination = mixStreamBuffer_->GetStart() + unusedStreamSize_;
+        outBytes = neededSize ? mixStream_->GetData(destination, (unsigned)neededSize) : 0;
         destination += outBytes;
         // Zero-fill rest if stream did not produce enough data
         if (outBytes < neededSize)
@@ -397,7 +519,7 @@ void SoundSource::Mix(int* dest, unsigned samples, int mixRate, bool stereo, boo
     }
 
     // If streaming, play the stream buffer. Otherwise play the original sound
-    Sound* sound = soundStream_ ? streamBuffer_ : sound_;
+    Sound* sound = mixStream_ ? mixStreamBuffer_ : mixSound_;
     if (!sound)
         return;
 
@@ -438,23 +560,42 @@ void SoundSource::Mix(int* dest, unsigned samples, int mixRate, bool stereo, boo
     }
 
     // Update the time position. In stream mode, copy unused data back to the beginning of the stream buffer
-    if (soundStream_)
+    if (mixStream_)
     {
-        timePosition_ += ((float)samples / (float)mixRate) * frequency_ / soundStream_->GetFrequency();
+        timePosition_ += ((float)samples / (float)mixRate) * mixFrequency_ / mixStream_->GetFrequency();
 
-        unusedStreamSize_ = Max(streamFilledSize - (int)(size_t)(position_ - streamBuffer_->GetStart()), 0);
+        unusedStreamSize_ = Max(streamFilledSize - (int)(size_t)(position_ - mixStreamBuffer_->GetStart()), 0);
         if (unusedStreamSize_)
-            memcpy(streamBuffer_->GetStart(), (const void*)position_, (size_t)unusedStreamSize_);
+            memcpy(mixStreamBuffer_->GetStart(), (const void*)position_, (size_t)unusedStreamSize_);
 
         // If stream did not produce any data, stop if applicable
-        if (!outBytes && soundStream_->GetStopAtEnd())
+        if (!outBytes && mixStream_->GetStopAtEnd())
         {
             position_ = nullptr;
             return;
         }
     }
-    else if (sound_)
-        timePosition_ = ((float)(int)(size_t)(position_ - sound_->GetStart())) / (sound_->GetSampleSize() * sound_->GetFrequency());
+    else if (mixSound_)
+        timePosition_ = ((float)(int)(size_t)(position_ - mixSound_->GetStart())) / (mixSound_->GetSampleSize() * mixSound_->GetFrequency());
+}
+
+float SoundSource::GetMixAudibility() const
+{
+    if (!position_ || (!mixSound_ && !mixStream_) || !IsEnabledEffective())
+        return 0.0f;
+
+    return masterGain_ * attenuation_ * gain_ * priority_;
+}
+
+void SoundSource::SetMixPlayback(Sound* sound, SoundStream* stream, Sound* streamBuffer, signed char* position, float timePosition)
+{
+    mixSound_ = sound;
+    mixStream_ = stream;
+    mixStreamBuffer_ = streamBuffer;
+    position_ = position;
+    fractPosition_ = 0;
+    timePosition_ = timePosition;
+    unusedStreamSize_ = 0;
 }
 
 void SoundSource::UpdateMasterGain()
@@ -508,11 +649,8 @@ int SoundSource::GetPositionAttr() const
         return 0;
 }
 
-void SoundSource::PlayLockless(Sound* sound)
+void SoundSource::PlayInternal(Sound* sound)
 {
-    // Reset the time position in any case
-    timePosition_ = 0.0f;
-
     if (sound)
     {
         if (!sound->IsCompressed())
@@ -522,11 +660,7 @@ void SoundSource::PlayLockless(Sound* sound)
             if (start)
             {
                 // Free existing stream & stream buffer if any
-                soundStream_.Reset();
-                streamBuffer_.Reset();
-                sound_ = sound;
-                position_ = start;
-                fractPosition_ = 0;
+                SetPlayback(sound, nullptr, nullptr, start, 0.0f);
                 sendFinishedEvent_ = true;
                 return;
             }
@@ -534,77 +668,69 @@ void SoundSource::PlayLockless(Sound* sound)
         else
         {
             // Compressed sound start
-            PlayLockless(sound->GetDecoderStream());
-            sound_ = sound;
+            PlayInternal(sound, sound->GetDecoderStream());
             return;
         }
     }
 
     // If sound pointer is null or if sound has no data, stop playback
-    StopLockless();
-    sound_.Reset();
+    SetPlayback(nullptr, nullptr, nullptr, nullptr, 0.0f);
 }
 
-void SoundSource::PlayLockless(const SharedPtr<SoundStream>& stream)
+void SoundSource::PlayInternal(Sound* sound, const SharedPtr<SoundStream>& stream)
 {
-    // Reset the time position in any case
-    timePosition_ = 0.0f;
-
     if (stream)
     {
+        // Decode ahead on the stream decoder thread if the stream supports it
+        if (audio_->GetStreamDecoder())
+            stream->StartDecodeAhead(audio_->GetStreamDecoder());
+
         // Setup the stream buffer
         unsigned sampleSize = stream->GetSampleSize();
         unsigned streamBufferSize = sampleSize * stream->GetIntFrequency() * STREAM_BUFFER_LENGTH / 1000;
 
-        streamBuffer_ = new Sound(context_);
-        streamBuffer_->SetSize(streamBufferSize);
-        streamBuffer_->SetFormat(stream->GetIntFrequency(), stream->IsSixteenBit(), stream->IsStereo());
-        streamBuffer_->SetLooped(true);
+        SharedPtr<Sound> streamBuffer(new Sound(context_));
+        streamBuffer->SetSize(streamBufferSize);
+        streamBuffer->SetFormat(stream->GetIntFrequency(), stream->IsSixteenBit(), stream->IsStereo());
+        streamBuffer->SetLooped(true);
 
-        soundStream_ = stream;
-        unusedStreamSize_ = 0;
-        position_ = streamBuffer_->GetStart();
-        fractPosition_ = 0;
+        SetPlayback(sound, stream, streamBuffer, streamBuffer->GetStart(), 0.0f);
         sendFinishedEvent_ = true;
         return;
     }
 
     // If stream pointer is null, stop playback
-    StopLockless();
+    SetPlayback(sound, nullptr, nullptr, nullptr, 0.0f);
 }
 
-void SoundSource::StopLockless()
+void SoundSource::StopInternal()
 {
-    position_ = nullptr;
-    timePosition_ = 0.0f;
-
     // Free the sound stream and decode buffer if a stream was playing
-    soundStream_.Reset();
-    streamBuffer_.Reset();
+    SetPlayback(sound_, nullptr, nullptr, nullptr, 0.0f);
 }
 
-void SoundSource::SetPlayPositionLockless(signed char* pos)
+void SoundSource::SetPlayback(Sound* sound, const SharedPtr<SoundStream>& stream, const SharedPtr<Sound>& streamBuffer,
+    signed char* position, float timePosition)
 {
-    // Setting position on a stream is not supported
-    if (!sound_ || soundStream_)
-        return;
+    SharedPtr<Sound> oldSound(sound_);
+    SharedPtr<SoundStream> oldStream(soundStream_);
+    SharedPtr<Sound> oldStreamBuffer(streamBuffer_);
 
-    signed char* start = sound_->GetStart();
-    signed char* end = sound_->GetEnd();
-    if (pos < start)
-        pos = start;
-    if (sound_->IsSixteenBit() && (pos - start) & 1u)
-        ++pos;
-    if (pos > end)
-        pos = end;
+    sound_ = sound;
+    soundStream_ = stream;
+    streamBuffer_ = streamBuffer;
+    requestedPosition_ = position;
+    playbackCommand_ = audio_->SetSoundSourcePlayback(this, sound, stream, streamBuffer, position, timePosition);
 
-    position_ = pos;
-    timePosition_ = ((float)(int)(size_t)(pos - sound_->GetStart())) / (sound_->GetSampleSize() * sound_->GetFrequency());
+    // The mixing thread may still be reading the previous sound or stream until it processes the command
+    audio_->RetireResource(oldSound, playbackCommand_);
+    audio_->RetireResource(oldStream, playbackCommand_);
+    audio_->RetireResource(oldStreamBuffer, playbackCommand_);
 }
 
 void SoundSource::MixMonoToMono(Sound* sound, int* dest, unsigned samples, int mixRate)
 {
-    float totalGain = masterGain_ * attenuation_ * gain_;
+    float totalGain = mixGain_;
     auto vol = RoundToInt(256.0f * totalGain);
     if (!vol)
     {
@@ -612,153 +738,37 @@ void SoundSource::MixMonoToMono(Sound* sound, int* dest, unsigned samples, int m
         return;
     }
 
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
+    float add = mixFrequency_ / (float)mixRate;
     if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * vol) / 256;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * vol) / 256;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
+        MixSamples<short, false, false, false>(sound, position_, fractPosition_, dest, samples, add, (float)vol / 256.0f, (float)vol / 256.0f);
     else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + *pos * vol;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + *pos * vol;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-    fractPosition_ = fractPos;
+        MixSamples<signed char, false, false, false>(sound, position_, fractPosition_, dest, samples, add, (float)vol, (float)vol);
 }
 
 void SoundSource::MixMonoToStereo(Sound* sound, int* dest, unsigned samples, int mixRate)
 {
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto leftVol = (int)((-panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
-    auto rightVol = (int)((panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
+    float totalGain = mixGain_;
+    auto leftVol = (int)((-mixPanning_ + 1.0f) * (256.0f * totalGain + 0.5f));
+    auto rightVol = (int)((mixPanning_ + 1.0f) * (256.0f * totalGain + 0.5f));
     if (!leftVol && !rightVol)
     {
         MixZeroVolume(sound, samples, mixRate);
         return;
     }
 
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
+    float add = mixFrequency_ / (float)mixRate;
     if (sound->IsSixteenBit())
     {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (*pos * rightVol) / 256;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (*pos * rightVol) / 256;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
+        MixSamples<short, false, true, false>(sound, position_, fractPosition_, dest, samples, add, (float)leftVol / 256.0f,
+            (float)rightVol / 256.0f);
     }
     else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + *pos * leftVol;
-                ++dest;
-                *dest = *dest + *pos * rightVol;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + *pos * leftVol;
-                ++dest;
-                *dest = *dest + *pos * rightVol;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
+        MixSamples<signed char, false, true, false>(sound, position_, fractPosition_, dest, samples, add, (float)leftVol, (float)rightVol);
 }
 
 void SoundSource::MixMonoToMonoIP(Sound* sound, int* dest, unsigned samples, int mixRate)
 {
-    float totalGain = masterGain_ * attenuation_ * gain_;
+    float totalGain = mixGain_;
     auto vol = RoundToInt(256.0f * totalGain);
     if (!vol)
     {
@@ -766,158 +776,37 @@ void SoundSource::MixMonoToMonoIP(Sound* sound, int* dest, unsigned samples, int
         return;
     }
 
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
+    float add = mixFrequency_ / (float)mixRate;
     if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE() * vol) / 256;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE() * vol) / 256;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
+        MixSamples<short, false, false, true>(sound, position_, fractPosition_, dest, samples, add, (float)vol / 256.0f, (float)vol / 256.0f);
     else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE() * vol;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE() * vol;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
+        MixSamples<signed char, false, false, true>(sound, position_, fractPosition_, dest, samples, add, (float)vol, (float)vol);
 }
 
 void SoundSource::MixMonoToStereoIP(Sound* sound, int* dest, unsigned samples, int mixRate)
 {
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto leftVol = (int)((-panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
-    auto rightVol = (int)((panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
+    float totalGain = mixGain_;
+    auto leftVol = (int)((-mixPanning_ + 1.0f) * (256.0f * totalGain + 0.5f));
+    auto rightVol = (int)((mixPanning_ + 1.0f) * (256.0f * totalGain + 0.5f));
     if (!leftVol && !rightVol)
     {
         MixZeroVolume(sound, samples, mixRate);
         return;
     }
 
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
+    float add = mixFrequency_ / (float)mixRate;
     if (sound->IsSixteenBit())
     {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + (s * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (s * rightVol) / 256;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + (s * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (s * rightVol) / 256;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
+        MixSamples<short, false, true, true>(sound, position_, fractPosition_, dest, samples, add, (float)leftVol / 256.0f,
+            (float)rightVol / 256.0f);
     }
     else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + s * leftVol;
-                ++dest;
-                *dest = *dest + s * rightVol;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + s * leftVol;
-                ++dest;
-                *dest = *dest + s * rightVol;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
+        MixSamples<signed char, false, true, true>(sound, position_, fractPosition_, dest, samples, add, (float)leftVol, (float)rightVol);
 }
 
 void SoundSource::MixStereoToMono(Sound* sound, int* dest, unsigned samples, int mixRate)
 {
-    float totalGain = masterGain_ * attenuation_ * gain_;
+    float totalGain = mixGain_;
     auto vol = RoundToInt(256.0f * totalGain);
     if (!vol)
     {
@@ -925,76 +814,16 @@ void SoundSource::MixStereoToMono(Sound* sound, int* dest, unsigned samples, int
         return;
     }
 
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
+    float add = mixFrequency_ / (float)mixRate;
     if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
+        MixSamples<short, true, false, false>(sound, position_, fractPosition_, dest, samples, add, (float)vol / 256.0f, (float)vol / 256.0f);
     else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
+        MixSamples<signed char, true, false, false>(sound, position_, fractPosition_, dest, samples, add, (float)vol, (float)vol);
 }
 
 void SoundSource::MixStereoToStereo(Sound* sound, int* dest, unsigned samples, int mixRate)
 {
-    float totalGain = masterGain_ * attenuation_ * gain_;
+    float totalGain = mixGain_;
     auto vol = RoundToInt(256.0f * totalGain);
     if (!vol)
     {
@@ -1002,80 +831,16 @@ void SoundSource::MixStereoToStereo(Sound* sound, int* dest, unsigned samples, i
         return;
     }
 
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
+    float add = mixFrequency_ / (float)mixRate;
     if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (pos[0] * vol) / 256;
-                ++dest;
-                *dest = *dest + (pos[1] * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (pos[0] * vol) / 256;
-                ++dest;
-                *dest = *dest + (pos[1] * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
+        MixSamples<short, true, true, false>(sound, position_, fractPosition_, dest, samples, add, (float)vol / 256.0f, (float)vol / 256.0f);
     else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + pos[0] * vol;
-                ++dest;
-                *dest = *dest + pos[1] * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + pos[0] * vol;
-                ++dest;
-                *dest = *dest + pos[1] * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
+        MixSamples<signed char, true, true, false>(sound, position_, fractPosition_, dest, samples, add, (float)vol, (float)vol);
 }
 
 void SoundSource::MixStereoToMonoIP(Sound* sound, int* dest, unsigned samples, int mixRate)
 {
-    float totalGain = masterGain_ * attenuation_ * gain_;
+    float totalGain = mixGain_;
     auto vol = RoundToInt(256.0f * totalGain);
     if (!vol)
     {
@@ -1083,76 +848,16 @@ void SoundSource::MixStereoToMonoIP(Sound* sound, int* dest, unsigned samples, i
         return;
     }
 
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
+    float add = mixFrequency_ / (float)mixRate;
     if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
+        MixSamples<short, true, false, true>(sound, position_, fractPosition_, dest, samples, add, (float)vol / 256.0f, (float)vol / 256.0f);
     else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
+        MixSamples<signed char, true, false, true>(sound, position_, fractPosition_, dest, samples, add, (float)vol, (float)vol);
 }
 
 void SoundSource::MixStereoToStereoIP(Sound* sound, int* dest, unsigned samples, int mixRate)
 {
-    float totalGain = masterGain_ * attenuation_ * gain_;
+    float totalGain = mixGain_;
     auto vol = RoundToInt(256.0f * totalGain);
     if (!vol)
     {
@@ -1160,80 +865,16 @@ void SoundSource::MixStereoToStereoIP(Sound* sound, int* dest, unsigned samples,
         return;
     }
 
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
+    float add = mixFrequency_ / (float)mixRate;
     if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256;
-                ++dest;
-                *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256;
-                ++dest;
-                *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
+        MixSamples<short, true, true, true>(sound, position_, fractPosition_, dest, samples, add, (float)vol / 256.0f, (float)vol / 256.0f);
     else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE_LEFT() * vol;
-                ++dest;
-                *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE_LEFT() * vol;
-                ++dest;
-                *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
+        MixSamples<signed char, true, true, true>(sound, position_, fractPosition_, dest, samples, add, (float)vol, (float)vol);
 }
 
 void SoundSource::MixZeroVolume(Sound* sound, unsigned samples, int mixRate)
 {
-    float add = frequency_ * (float)samples / (float)mixRate;
+    float add = mixFrequency_ * (float)samples / (float)mixRate;
     auto intAdd = (int)add;
     auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
     unsigned sampleSize = sound->GetSampleSize();
@@ -82,18 +82,24 @@ public:
     void SetAutoRemoveMode(AutoRemoveMode mode);
     /// Set new playback position.
     void SetPlayPosition(signed char* pos);
+    /// Set voice priority. Multiplies the effective gain when ranking sound sources against the maximum number of voices. Default 1.
+    /// @property
+    void SetPriority(float priority);
 
     /// Return sound.
     /// @property
     Sound* GetSound() const { return sound_; }
 
-    /// Return playback position.
-    volatile signed char* GetPlayPosition() const { return position_; }
+    /// Return playback position. Until the mixing thread has applied a playback change, returns the requested position.
+    volatile signed char* GetPlayPosition() const;
 
     /// Return sound type, determines the master gain group.
     /// @property
     String GetSoundType() const { return soundType_; }
 
+    /// Return sound type hash.
+    StringHash GetSoundTypeHash() const { return soundTypeHash_; }
+
     /// Return playback time position.
     /// @property
     float GetTimePosition() const { return timePosition_; }
@@ -114,6 +120,10 @@ public:
     /// @property
     float GetPanning() const { return panning_; }
 
+    /// Return voice priority.
+    /// @property
+    float GetPriority() const { return priority_; }
+
     /// Return automatic removal mode on sound playback completion.
     /// @property
     AutoRemoveMode GetAutoRemoveMode() const { return autoRemove_; }
@@ -126,6 +136,12 @@ public:
     virtual void Update(float timeStep);
     /// Mix sound source output to a 32-bit clipping buffer. Called by Audio.
     void Mix(int* dest, unsigned samples, int mixRate, bool stereo, bool interpolation);
+    /// Apply a playback state change in the mixing thread. Called by Audio.
+    void SetMixPlayback(Sound* sound, SoundStream* stream, Sound* streamBuffer, signed char* position, float timePosition);
+    /// Return audibility for voice ranking in the mixing thread: effective gain multiplied by priority, or zero when not playing. Called by Audio.
+    float GetMixAudibility() const;
+    /// Set whether is only advanced without mixing in the next mix block. Called by Audio.
+    void SetMixVirtual(bool enable) { mixVirtual_ = enable; }
     /// Update the effective master gain. Called internally and by Audio when the master gain changes.
     void UpdateMasterGain();
 
@@ -155,6 +171,8 @@ protected:
     float attenuation_;
     /// Stereo panning.
     float panning_;
+    /// Voice priority.
+    float priority_;
     /// Effective master gain.
     float masterGain_{};
     /// Whether finished event should be sent on playback stop.
@@ -163,14 +181,14 @@ protected:
     AutoRemoveMode autoRemove_;
 
 private:
-    /// Play a sound without locking the audio mutex. Called internally.
-    void PlayLockless(Sound* sound);
-    /// Play a sound stream without locking the audio mutex. Called internally.
-    void PlayLockless(const SharedPtr<SoundStream>& stream);
-    /// Stop sound without locking the audio mutex. Called internally.
-    void StopLockless();
-    /// Set new playback position without locking the audio mutex. Called internally.
-    void SetPlayPositionLockless(signed char* pos);
+    /// Play a sound. Called internally.
+    void PlayInternal(Sound* sound);
+    /// Play a sound stream, optionally decoding the specified sound. Called internally.
+    void PlayInternal(Sound* sound, const SharedPtr<SoundStream>& stream);
+    /// Stop sound and free the sound stream if any. Called internally.
+    void StopInternal();
+    /// Replace the playback state and queue the change for the mixing thread. The previous sound and stream are kept alive until the mixing thread has switched over.
+    void SetPlayback(Sound* sound, const SharedPtr<SoundStream>& stream, const SharedPtr<Sound>& streamBuffer, signed char* position, float timePosition);
     /// Mix mono sample to mono buffer.
     void MixMonoToMono(Sound* sound, int* dest, unsigned samples, int mixRate);
     /// Mix mono sample to stereo buffer.
@@ -196,14 +214,32 @@ private:
     SharedPtr<Sound> sound_;
     /// Sound stream that is being played.
     SharedPtr<SoundStream> soundStream_;
+    /// Decode buffer.
+    SharedPtr<Sound> streamBuffer_;
+    /// Playback position requested by the last queued playback change.
+    signed char* requestedPosition_{};
+    /// Command index of the last queued playback change.
+    unsigned playbackCommand_{};
+    /// Sound being mixed. Accessed by the mixing thread.
+    Sound* mixSound_{};
+    /// Sound stream being mixed. Accessed by the mixing thread.
+    SoundStream* mixStream_{};
+    /// Decode buffer being mixed. Accessed by the mixing thread.
+    Sound* mixStreamBuffer_{};
+    /// Effective gain snapshot of the current mix block.
+    float mixGain_{};
+    /// Stereo panning snapshot of the current mix block.
+    float mixPanning_{};
+    /// Frequency snapshot of the current mix block.
+    float mixFrequency_{};
+    /// Virtual voice flag of the current mix block.
+    bool mixVirtual_{};
     /// Playback position.
     volatile signed char* position_;
     /// Playback fractional position.
     volatile int fractPosition_;
     /// Playback time position.
     volatile float timePosition_;
-    /// Decode buffer.
-    SharedPtr<Sound> streamBuffer_;
     /// Unused stream bytes from previous frame.
     int unusedStreamSize_;
 };
@@ -28,6 +28,7 @@
 #include "../Audio/SoundSource3D.h"
 #include "../Core/Context.h"
 #include "../Graphics/DebugRenderer.h"
+#include "../Graphics/SignificanceManager.h"
 #include "../Scene/Node.h"
 
 namespace Urho3D
@@ -49,7 +50,9 @@ SoundSource3D::SoundSource3D(Context* context) :
     farDistance_(DEFAULT_FARDISTANCE),
     innerAngle_(DEFAULT_ANGLE),
     outerAngle_(DEFAULT_ANGLE),
-    rolloffFactor_(DEFAULT_ROLLOFF)
+    rolloffFactor_(DEFAULT_ROLLOFF),
+    attenuationAccumulator_(M_LARGE_VALUE),
+    significanceUpdate_(false)
 {
     // Start from zero volume until attenuation properly calculated
     attenuation_ = 0.0f;
@@ -68,6 +71,7 @@ void SoundSource3D::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Inner Angle", float, innerAngle_, DEFAULT_ANGLE, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Outer Angle", float, outerAngle_, DEFAULT_ANGLE, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Rolloff Factor", float, rolloffFactor_, DEFAULT_ROLLOFF, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Significance Update", GetSignificanceUpdate, SetSignificanceUpdate, bool, false, AM_DEFAULT);
 }
 
 void SoundSource3D::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
@@ -97,7 +101,11 @@ void SoundSource3D::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
 
 void SoundSource3D::Update(float timeStep)
 {
-    CalculateAttenuation();
+    // The accumulator starts out large so that the attenuation is calculated on the first update
+    float attenuationTimeStep = timeStep;
+    if (!significanceUpdate_ || SignificanceManager::CheckUpdate(this, attenuationTimeStep, attenuationAccumulator_))
+        CalculateAttenuation();
+
     SoundSource::Update(timeStep);
 }
 
@@ -146,6 +154,13 @@ void SoundSource3D::SetRolloffFactor(float factor)
     MarkNetworkUpdate();
 }
 
+void SoundSource3D::SetSignificanceUpdate(bool enable)
+{
+    significanceUpdate_ = enable;
+    attenuationAccumulator_ = M_LARGE_VALUE;
+    MarkNetworkUpdate();
+}
+
 void SoundSource3D::CalculateAttenuation()
 {
     if (!audio_)
@@ -65,6 +65,9 @@ public:
     /// Set rolloff power factor, defines attenuation function shape.
     /// @property
     void SetRolloffFactor(float factor);
+    /// Set whether attenuation and panning are recalculated less often when the node is insignificant to the viewer. Requires a SignificanceManager in the scene.
+    /// @property
+    void SetSignificanceUpdate(bool enable);
     /// Calculate attenuation and panning based on current position and listener position.
     void CalculateAttenuation();
 
@@ -88,6 +91,10 @@ public:
     /// @property{get_rolloffFactor}
     float RollAngleoffFactor() const { return rolloffFactor_; }
 
+    /// Return whether the attenuation update rate follows the node's significance.
+    /// @property
+    bool GetSignificanceUpdate() const { return significanceUpdate_; }
+
 protected:
     /// Near distance.
     float nearDistance_;
@@ -99,6 +106,10 @@ protected:
     float outerAngle_;
     /// Rolloff power factor.
     float rolloffFactor_;
+    /// Time accumulated between significance throttled attenuation updates.
+    float attenuationAccumulator_;
+    /// Significance update flag.
+    bool significanceUpdate_;
 };
 
 }
@@ -27,6 +27,8 @@
 namespace Urho3D
 {
 
+class StreamDecoder;
+
 /// Base class for sound streams.
 class URHO3D_API SoundStream : public RefCounted
 {
@@ -41,6 +43,11 @@ public:
 
     /// Produce sound data into destination. Return number of bytes produced. Called by SoundSource from the mixing thread.
     virtual unsigned GetData(signed char* dest, unsigned numBytes) = 0;
+    /// Start decoding ahead of playback on the stream decoder thread. Return true if supported. Need not be implemented by all streams.
+    /// @nobind
+    virtual bool StartDecodeAhead(StreamDecoder* decoder) { return false; }
+    /// Decode data ahead of playback into an internal buffer. Return true if any data was decoded. Called by StreamDecoder from the decoding thread.
+    virtual bool DecodeAhead() { return false; }
 
     /// Set sound data format.
     void SetFormat(unsigned frequency, bool sixteenBit, bool stereo);
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Audio/SoundStream.h"
+#include "../Audio/StreamDecoder.h"
+#include "../Core/Profiler.h"
+#include "../Core/Timer.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+StreamDecoder::StreamDecoder() = default;
+
+StreamDecoder::~StreamDecoder()
+{
+    Stop();
+}
+
+void StreamDecoder::ThreadFunction()
+{
+    URHO3D_PROFILE_THREAD("StreamDecoder Thread");
+
+    while (shouldRun_)
+    {
+        bool decoded = false;
+        {
+            MutexLock lock(streamsMutex_);
+            for (PODVector<SoundStream*>::Iterator i = streams_.Begin(); i != streams_.End(); ++i)
+                decoded |= (*i)->DecodeAhead();
+        }
+
+        // Sleep when all decode buffers are full enough
+        if (!decoded)
+            Time::Sleep(5);
+    }
+}
+
+void StreamDecoder::AddStream(SoundStream* stream)
+{
+    MutexLock lock(streamsMutex_);
+    if (!streams_.Contains(stream))
+        streams_.Push(stream);
+}
+
+void StreamDecoder::RemoveStream(SoundStream* stream)
+{
+    MutexLock lock(streamsMutex_);
+    streams_.Remove(stream);
+}
+
+unsigned StreamDecoder::GetNumStreams() const
+{
+    MutexLock lock(streamsMutex_);
+    return streams_.Size();
+}
+
+}
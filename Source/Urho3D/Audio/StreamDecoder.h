@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Container/RefCounted.h"
+#include "../Container/Vector.h"
+#include "../Core/Mutex.h"
+#include "../Core/Thread.h"
+
+namespace Urho3D
+{
+
+class SoundStream;
+
+/// Background thread that decodes compressed sound streams ahead of playback, so that the mixing thread only copies decoded data. Owned by the Audio subsystem.
+/// @nobind
+class URHO3D_API StreamDecoder : public RefCounted, public Thread
+{
+public:
+    /// Construct.
+    StreamDecoder();
+    /// Destruct. Stop the decoding thread.
+    ~StreamDecoder() override;
+
+    /// Stream decoding loop.
+    void ThreadFunction() override;
+
+    /// Add a stream to decode ahead. Called by the stream.
+    void AddStream(SoundStream* stream);
+    /// Remove a stream. Waits for an ongoing decode of the stream to finish. Called by the stream on destruction.
+    void RemoveStream(SoundStream* stream);
+
+    /// Return number of streams being decoded ahead.
+    unsigned GetNumStreams() const;
+
+private:
+    /// Streams being decoded ahead.
+    PODVector<SoundStream*> streams_;
+    /// Mutex for the stream list.
+    mutable Mutex streamsMutex_;
+};
+
+}
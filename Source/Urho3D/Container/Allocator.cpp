@@ -22,17 +22,28 @@
 
 #include "../Precompiled.h"
 
+#include "../Core/Profiler.h"
+
 #include "../DebugNew.h"
 
 namespace Urho3D
 {
 
+#ifdef URHO3D_TRACY_MEMORY
+/// Tracy memory pool of the allocator blocks.
+static const char* ALLOCATOR_MEMORY_POOL = "Allocator";
+#endif
+
 AllocatorBlock* AllocatorReserveBlock(AllocatorBlock* allocator, unsigned nodeSize, unsigned capacity)
 {
     if (!capacity)
         capacity = 1;
 
-    auto* blockPtr = new unsigned char[sizeof(AllocatorBlock) + capacity * (sizeof(AllocatorNode) + nodeSize)];
+    unsigned blockSize = sizeof(AllocatorBlock) + capacity * (sizeof(AllocatorNode) + nodeSize);
+    auto* blockPtr = new unsigned char[blockSize];
+#ifdef URHO3D_TRACY_MEMORY
+    URHO3D_PROFILE_ALLOC(blockPtr, blockSize, ALLOCATOR_MEMORY_POOL);
+#endif
     auto* newBlock = reinterpret_cast<AllocatorBlock*>(blockPtr);
     newBlock->nodeSize_ = nodeSize;
     newBlock->capacity_ = capacity;
@@ -59,8 +70,9 @@ AllocatorBlock* AllocatorReserveBlock(AllocatorBlock* allocator, unsigned nodeSi
     }
     // i == capacity - 1
     {
+        // Chain the existing free nodes, if any, after the new ones
         auto* newNode = reinterpret_cast<AllocatorNode*>(nodePtr);
-        newNode->next_ = nullptr;
+        newNode->next_ = allocator->free_;
     }
 
     allocator->free_ = firstNewNode;
@@ -79,6 +91,9 @@ void AllocatorUninitialize(AllocatorBlock* allocator)
     while (allocator)
     {
         AllocatorBlock* next = allocator->next_;
+#ifdef URHO3D_TRACY_MEMORY
+        URHO3D_PROFILE_FREE(allocator, ALLOCATOR_MEMORY_POOL);
+#endif
         delete[] reinterpret_cast<unsigned char*>(allocator);
         allocator = next;
     }
@@ -106,6 +121,15 @@ void* AllocatorReserve(AllocatorBlock* allocator)
     return ptr;
 }
 
+void AllocatorGrow(AllocatorBlock* allocator, unsigned count)
+{
+    if (!allocator || !count)
+        return;
+
+    AllocatorReserveBlock(allocator, allocator->nodeSize_, count);
+    allocator->capacity_ += count;
+}
+
 void AllocatorFree(AllocatorBlock* allocator, void* ptr)
 {
     if (!allocator || !ptr)
@@ -64,6 +64,8 @@ URHO3D_API AllocatorBlock* AllocatorInitialize(unsigned nodeSize, unsigned initi
 URHO3D_API void AllocatorUninitialize(AllocatorBlock* allocator);
 /// Reserve a node. Creates a new block if necessary.
 URHO3D_API void* AllocatorReserve(AllocatorBlock* allocator);
+/// Add the specified number of free nodes in a new block. Existing free nodes are kept.
+URHO3D_API void AllocatorGrow(AllocatorBlock* allocator, unsigned count);
 /// Free a node. Does not free any blocks.
 URHO3D_API void AllocatorFree(AllocatorBlock* allocator, void* ptr);
 
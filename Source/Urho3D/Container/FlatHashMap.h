@@ -0,0 +1,388 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Container/Hash.h"
+#include "../Container/Pair.h"
+#include "../Container/Vector.h"
+#include "../Math/MathDefs.h"
+
+#include <initializer_list>
+#include <utility>
+
+namespace Urho3D
+{
+
+/// Hash map template class using open addressing. The pairs are stored contiguously in insertion order and found through a linearly probed index table, so lookups and iteration touch few cache lines and inserts do not allocate nodes. Unlike HashMap, inserting may move the pairs and invalidate iterators and pointers to them, and erasing moves the last pair into the erased position.
+template <class T, class U> class FlatHashMap
+{
+public:
+    using KeyType = T;
+    using ValueType = U;
+
+    /// Hash map key-value pair. The key must not be modified.
+    class KeyValue
+    {
+    public:
+        /// Construct with default key.
+        KeyValue() :
+            first_(T())
+        {
+        }
+
+        /// Construct with key and value.
+        KeyValue(const T& first, const U& second) :
+            first_(first),
+            second_(second)
+        {
+        }
+
+        /// Test for equality with another pair.
+        bool operator ==(const KeyValue& rhs) const { return first_ == rhs.first_ && second_ == rhs.second_; }
+        /// Test for inequality with another pair.
+        bool operator !=(const KeyValue& rhs) const { return first_ != rhs.first_ || second_ != rhs.second_; }
+
+        /// Key.
+        T first_;
+        /// Value.
+        U second_;
+    };
+
+    /// Pair iterator.
+    using Iterator = typename Vector<KeyValue>::Iterator;
+    /// Const pair iterator.
+    using ConstIterator = typename Vector<KeyValue>::ConstIterator;
+
+    /// Construct empty.
+    FlatHashMap() = default;
+
+    /// Aggregate initialization constructor.
+    FlatHashMap(const std::initializer_list<Pair<T, U>>& list)
+    {
+        Reserve((unsigned)list.size());
+        for (auto it = list.begin(); it != list.end(); ++it)
+            Insert(*it);
+    }
+
+    /// Test for equality with another hash map.
+    bool operator ==(const FlatHashMap<T, U>& rhs) const
+    {
+        if (rhs.Size() != Size())
+            return false;
+
+        for (ConstIterator i = Begin(); i != End(); ++i)
+        {
+            ConstIterator j = rhs.Find(i->first_);
+            if (j == rhs.End() || j->second_ != i->second_)
+                return false;
+        }
+
+        return true;
+    }
+
+    /// Test for inequality with another hash map.
+    bool operator !=(const FlatHashMap<T, U>& rhs) const { return !(*this == rhs); }
+
+    /// Index the map. Create a new pair if key not found.
+    U& operator [](const T& key)
+    {
+        unsigned hash = MakeHash(key);
+        unsigned index = FindIndex(key, hash);
+        if (index == M_MAX_UNSIGNED)
+            index = InsertNew(key, U(), hash);
+        return pairs_[index].second_;
+    }
+
+    /// Index the map. Return null if key is not found, does not create a new pair.
+    U* operator [](const T& key) const
+    {
+        unsigned index = FindIndex(key, MakeHash(key));
+        return index != M_MAX_UNSIGNED ? const_cast<U*>(&pairs_[index].second_) : nullptr;
+    }
+
+    /// Insert a pair. Return an iterator to it. If the key exists, its value is replaced.
+    Iterator Insert(const Pair<T, U>& pair)
+    {
+        bool exists;
+        return Insert(pair, exists);
+    }
+
+    /// Insert a pair. Return an iterator to it and set exists flag according to whether the key already existed.
+    Iterator Insert(const Pair<T, U>& pair, bool& exists)
+    {
+        unsigned hash = MakeHash(pair.first_);
+        unsigned index = FindIndex(pair.first_, hash);
+        exists = index != M_MAX_UNSIGNED;
+        if (exists)
+            pairs_[index].second_ = pair.second_;
+        else
+            index = InsertNew(pair.first_, pair.second_, hash);
+        return pairs_.Begin() + index;
+    }
+
+    /// Erase a pair by key. Return true if was found.
+    bool Erase(const T& key)
+    {
+        unsigned hash = MakeHash(key);
+        unsigned slot = FindSlot(key, hash);
+        if (slot == M_MAX_UNSIGNED)
+            return false;
+
+        EraseSlot(slot);
+        return true;
+    }
+
+    /// Erase a pair by iterator. Return iterator to the pair moved into its position, which continues the iteration.
+    Iterator Erase(const Iterator& it)
+    {
+        unsigned index = (unsigned)(it - pairs_.Begin());
+        if (index >= pairs_.Size())
+            return End();
+
+        EraseSlot(FindSlotOfIndex(index));
+        return pairs_.Begin() + index;
+    }
+
+    /// Clear the map. The storage is kept for reuse.
+    void Clear()
+    {
+        pairs_.Clear();
+        if (!slots_.Empty())
+            memset(slots_.Buffer(), 0, slots_.Size() * sizeof(Slot));
+    }
+
+    /// Reserve storage and index slots for the specified number of pairs.
+    void Reserve(unsigned numElements)
+    {
+        pairs_.Reserve(numElements);
+        if (numElements * 2 > slots_.Size())
+            Rehash(Max(NextPowerOfTwo(numElements * 2), MIN_SLOTS));
+    }
+
+    /// Return iterator to the pair with key, or end iterator if not found.
+    Iterator Find(const T& key)
+    {
+        unsigned index = FindIndex(key, MakeHash(key));
+        return index != M_MAX_UNSIGNED ? pairs_.Begin() + index : End();
+    }
+
+    /// Return iterator to the pair with key, or end iterator if not found.
+    ConstIterator Find(const T& key) const
+    {
+        unsigned index = FindIndex(key, MakeHash(key));
+        return index != M_MAX_UNSIGNED ? pairs_.Begin() + index : End();
+    }
+
+    /// Return whether contains a pair with key.
+    bool Contains(const T& key) const { return FindIndex(key, MakeHash(key)) != M_MAX_UNSIGNED; }
+
+    /// Try to copy value to output. Return true if was found.
+    bool TryGetValue(const T& key, U& out) const
+    {
+        unsigned index = FindIndex(key, MakeHash(key));
+        if (index == M_MAX_UNSIGNED)
+            return false;
+
+        out = pairs_[index].second_;
+        return true;
+    }
+
+    /// Return all the keys.
+    Vector<T> Keys() const
+    {
+        Vector<T> result;
+        result.Reserve(Size());
+        for (ConstIterator i = Begin(); i != End(); ++i)
+            result.Push(i->first_);
+        return result;
+    }
+
+    /// Return all the values.
+    Vector<U> Values() const
+    {
+        Vector<U> result;
+        result.Reserve(Size());
+        for (ConstIterator i = Begin(); i != End(); ++i)
+            result.Push(i->second_);
+        return result;
+    }
+
+    /// Return iterator to the beginning.
+    Iterator Begin() { return pairs_.Begin(); }
+
+    /// Return iterator to the beginning.
+    ConstIterator Begin() const { return pairs_.Begin(); }
+
+    /// Return iterator to the end.
+    Iterator End() { return pairs_.End(); }
+
+    /// Return iterator to the end.
+    ConstIterator End() const { return pairs_.End(); }
+
+    /// Return first pair.
+    const KeyValue& Front() const { return pairs_.Front(); }
+
+    /// Return last pair.
+    const KeyValue& Back() const { return pairs_.Back(); }
+
+    /// Return number of pairs.
+    unsigned Size() const { return pairs_.Size(); }
+
+    /// Return whether the map is empty.
+    bool Empty() const { return pairs_.Empty(); }
+
+    /// Return number of index slots.
+    unsigned NumSlots() const { return slots_.Size(); }
+
+private:
+    /// Index table slot.
+    struct Slot
+    {
+        /// Pair index plus one, or zero if free.
+        unsigned index_;
+        /// Hash of the pair's key, compared before the key.
+        unsigned hash_;
+    };
+
+    /// Return the preferred slot of a hash. Multiplicative hashing spreads sequential hashes such as IDs and pointers.
+    unsigned HomeSlot(unsigned hash) const { return (hash * 2654435769u) >> shift_; }
+
+    /// Return the slot referring to a key, or M_MAX_UNSIGNED if not found.
+    unsigned FindSlot(const T& key, unsigned hash) const
+    {
+        if (slots_.Empty())
+            return M_MAX_UNSIGNED;
+
+        unsigned mask = slots_.Size() - 1;
+        for (unsigned slot = HomeSlot(hash);; slot = (slot + 1) & mask)
+        {
+            const Slot& entry = slots_[slot];
+            if (!entry.index_)
+                return M_MAX_UNSIGNED;
+            if (entry.hash_ == hash && pairs_[entry.index_ - 1].first_ == key)
+                return slot;
+        }
+    }
+
+    /// Return the pair index of a key, or M_MAX_UNSIGNED if not found.
+    unsigned FindIndex(const T& key, unsigned hash) const
+    {
+        unsigned slot = FindSlot(key, hash);
+        return slot != M_MAX_UNSIGNED ? slots_[slot].index_ - 1 : M_MAX_UNSIGNED;
+    }
+
+    /// Return the slot referring to a pair index, which must exist.
+    unsigned FindSlotOfIndex(unsigned index) const
+    {
+        unsigned mask = slots_.Size() - 1;
+        unsigned slot = HomeSlot(MakeHash(pairs_[index].first_));
+        while (slots_[slot].index_ != index + 1)
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    /// Append a pair known not to exist and return its index.
+    unsigned InsertNew(const T& key, const U& value, unsigned hash)
+    {
+        // Keep the index at most half full for short probe sequences
+        if ((pairs_.Size() + 1) * 2 > slots_.Size())
+            Rehash(Max(slots_.Size() * 2, MIN_SLOTS));
+
+        unsigned index = pairs_.Size();
+        pairs_.Push(KeyValue(key, value));
+        InsertSlot(index + 1, hash);
+        return index;
+    }
+
+    /// Enter a pair index plus one to the first free slot of its probe sequence.
+    void InsertSlot(unsigned index, unsigned hash)
+    {
+        unsigned mask = slots_.Size() - 1;
+        unsigned slot = HomeSlot(hash);
+        while (slots_[slot].index_)
+            slot = (slot + 1) & mask;
+        slots_[slot].index_ = index;
+        slots_[slot].hash_ = hash;
+    }
+
+    /// Erase the pair referred to by a slot. Move the last pair into its position.
+    void EraseSlot(unsigned slot)
+    {
+        unsigned index = slots_[slot].index_ - 1;
+        unsigned mask = slots_.Size() - 1;
+
+        // Shift back the following entries whose probe sequence passes the freed slot, so that no search stops early
+        for (unsigned next = (slot + 1) & mask; slots_[next].index_; next = (next + 1) & mask)
+        {
+            unsigned home = HomeSlot(slots_[next].hash_);
+            if (((next - home) & mask) >= ((next - slot) & mask))
+            {
+                slots_[slot] = slots_[next];
+                slot = next;
+            }
+        }
+        slots_[slot].index_ = 0;
+
+        unsigned last = pairs_.Size() - 1;
+        if (index != last)
+        {
+            slots_[FindSlotOfIndex(last)].index_ = index + 1;
+            pairs_[index] = std::move(pairs_[last]);
+        }
+        pairs_.Pop();
+    }
+
+    /// Resize the index to a power of two number of slots and reinsert the pairs.
+    void Rehash(unsigned numSlots)
+    {
+        PODVector<Slot> oldSlots(numSlots);
+        oldSlots.Swap(slots_);
+        memset(slots_.Buffer(), 0, numSlots * sizeof(Slot));
+        shift_ = 32 - LogBaseTwo(numSlots);
+        for (unsigned i = 0; i < oldSlots.Size(); ++i)
+        {
+            if (oldSlots[i].index_)
+                InsertSlot(oldSlots[i].index_, oldSlots[i].hash_);
+        }
+    }
+
+    /// Minimum number of index slots.
+    static const unsigned MIN_SLOTS = 8;
+
+    /// Key-value pairs in insertion order, except for erased pairs replaced by the last.
+    Vector<KeyValue> pairs_;
+    /// Index table with a power of two number of slots.
+    PODVector<Slot> slots_;
+    /// Shift for mapping a multiplied hash to a slot.
+    unsigned shift_{};
+};
+
+template <class T, class U> typename Urho3D::FlatHashMap<T, U>::ConstIterator begin(const Urho3D::FlatHashMap<T, U>& v) { return v.Begin(); }
+
+template <class T, class U> typename Urho3D::FlatHashMap<T, U>::ConstIterator end(const Urho3D::FlatHashMap<T, U>& v) { return v.End(); }
+
+template <class T, class U> typename Urho3D::FlatHashMap<T, U>::Iterator begin(Urho3D::FlatHashMap<T, U>& v) { return v.Begin(); }
+
+template <class T, class U> typename Urho3D::FlatHashMap<T, U>::Iterator end(Urho3D::FlatHashMap<T, U>& v) { return v.End(); }
+
+}
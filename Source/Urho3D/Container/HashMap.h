@@ -505,6 +505,23 @@ public:
         delete[] ptrs;
     }
 
+    /// Reserve node storage and buckets for the specified number of elements, so that inserting up to that many does not allocate or rehash.
+    void Reserve(unsigned numElements)
+    {
+        if (!allocator_ || numElements <= Size())
+            return;
+
+        // One node is always used by the tail
+        if (allocator_->capacity_ < numElements + 1)
+            AllocatorGrow(allocator_, numElements + 1 - allocator_->capacity_);
+
+        unsigned numBuckets = NumBuckets() ? NumBuckets() : MIN_BUCKETS;
+        while (numElements > numBuckets * MAX_LOAD_FACTOR)
+            numBuckets <<= 1;
+        if (numBuckets != NumBuckets())
+            Rehash(numBuckets);
+    }
+
     /// Rehash to a specific bucket count, which must be a power of two. Return true if successful.
     bool Rehash(unsigned numBuckets)
     {
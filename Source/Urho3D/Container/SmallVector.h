@@ -0,0 +1,418 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/VectorBase.h"
+
+#include <cassert>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+
+namespace Urho3D
+{
+
+/// %Vector template class for POD types with inline storage for N elements. Memory is allocated only when the size grows over N, which suits temporary containers on hot paths whose typical size is known. The inline storage makes the vector expensive to swap and move, so prefer PODVector for long-lived or passed-around data.
+template <class T, unsigned N> class SmallVector
+{
+    static_assert(N > 0, "SmallVector needs a nonzero inline capacity");
+
+public:
+    using ValueType = T;
+    using Iterator = RandomAccessIterator<T>;
+    using ConstIterator = RandomAccessConstIterator<T>;
+
+    /// Construct empty.
+    SmallVector() noexcept :
+        buffer_(LocalBuffer()),
+        size_(0),
+        capacity_(N)
+    {
+    }
+
+    /// Construct with initial size.
+    explicit SmallVector(unsigned size) :
+        SmallVector()
+    {
+        Resize(size);
+    }
+
+    /// Construct with initial data.
+    SmallVector(const T* data, unsigned size) :
+        SmallVector()
+    {
+        Resize(size);
+        CopyElements(buffer_, data, size);
+    }
+
+    /// Construct from another vector.
+    SmallVector(const SmallVector<T, N>& vector) :
+        SmallVector()
+    {
+        *this = vector;
+    }
+
+    /// Move-construct from another vector.
+    SmallVector(SmallVector<T, N>&& vector) noexcept :
+        SmallVector()
+    {
+        *this = std::move(vector);
+    }
+
+    /// Aggregate initialization constructor.
+    SmallVector(const std::initializer_list<T>& list) :
+        SmallVector()
+    {
+        Reserve((unsigned)list.size());
+        for (auto it = list.begin(); it != list.end(); ++it)
+            Push(*it);
+    }
+
+    /// Destruct.
+    ~SmallVector()
+    {
+        if (!IsLocal())
+            delete[] reinterpret_cast<unsigned char*>(buffer_);
+    }
+
+    /// Assign from another vector.
+    SmallVector<T, N>& operator =(const SmallVector<T, N>& rhs)
+    {
+        if (&rhs != this)
+        {
+            Resize(rhs.size_);
+            CopyElements(buffer_, rhs.buffer_, rhs.size_);
+        }
+        return *this;
+    }
+
+    /// Move-assign from another vector. Takes over the heap buffer, or copies the elements if they are stored inline.
+    SmallVector<T, N>& operator =(SmallVector<T, N>&& rhs) noexcept
+    {
+        if (&rhs == this)
+            return *this;
+
+        if (rhs.IsLocal())
+        {
+            Resize(rhs.size_);
+            CopyElements(buffer_, rhs.buffer_, rhs.size_);
+        }
+        else
+        {
+            if (!IsLocal())
+                delete[] reinterpret_cast<unsigned char*>(buffer_);
+            buffer_ = rhs.buffer_;
+            size_ = rhs.size_;
+            capacity_ = rhs.capacity_;
+            rhs.buffer_ = rhs.LocalBuffer();
+            rhs.capacity_ = N;
+        }
+        rhs.size_ = 0;
+        return *this;
+    }
+
+    /// Add-assign an element.
+    SmallVector<T, N>& operator +=(const T& rhs)
+    {
+        Push(rhs);
+        return *this;
+    }
+
+    /// Test for equality with another vector.
+    bool operator ==(const SmallVector<T, N>& rhs) const
+    {
+        if (rhs.size_ != size_)
+            return false;
+
+        for (unsigned i = 0; i < size_; ++i)
+        {
+            if (buffer_[i] != rhs.buffer_[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    /// Test for inequality with another vector.
+    bool operator !=(const SmallVector<T, N>& rhs) const { return !(*this == rhs); }
+
+    /// Return element at index.
+    T& operator [](unsigned index)
+    {
+        assert(index < size_);
+        return buffer_[index];
+    }
+
+    /// Return const element at index.
+    const T& operator [](unsigned index) const
+    {
+        assert(index < size_);
+        return buffer_[index];
+    }
+
+    /// Return element at index.
+    T& At(unsigned index)
+    {
+        assert(index < size_);
+        return buffer_[index];
+    }
+
+    /// Return const element at index.
+    const T& At(unsigned index) const
+    {
+        assert(index < size_);
+        return buffer_[index];
+    }
+
+    /// Add an element at the end.
+    void Push(const T& value)
+    {
+        if (size_ < capacity_)
+            ++size_;
+        else
+            Resize(size_ + 1);
+        Back() = value;
+    }
+
+    /// Add elements at the end.
+    void Push(const T* data, unsigned size)
+    {
+        unsigned oldSize = size_;
+        Resize(size_ + size);
+        CopyElements(buffer_ + oldSize, data, size);
+    }
+
+    /// Remove the last element.
+    void Pop()
+    {
+        if (size_)
+            --size_;
+    }
+
+    /// Erase a range of elements.
+    void Erase(unsigned pos, unsigned length = 1)
+    {
+        // Return if the range is illegal
+        if (!length || pos + length > size_)
+            return;
+
+        MoveRange(pos, pos + length, size_ - pos - length);
+        size_ -= length;
+    }
+
+    /// Erase a range of elements by swapping elements from the end of the vector.
+    void EraseSwap(unsigned pos, unsigned length = 1)
+    {
+        unsigned shiftStartIndex = pos + length;
+        // Return if the range is illegal
+        if (shiftStartIndex > size_ || !length)
+            return;
+
+        unsigned newSize = size_ - length;
+        unsigned trailingCount = size_ - shiftStartIndex;
+        if (trailingCount <= length)
+        {
+            // We're removing more elements from the array than exist past the end of the range being removed, so perform a normal shift and destroy
+            MoveRange(pos, shiftStartIndex, trailingCount);
+        }
+        else
+        {
+            // Swap elements from the end of the array into the empty space
+            CopyElements(buffer_ + pos, buffer_ + newSize, length);
+        }
+        size_ = newSize;
+    }
+
+    /// Erase an element by value. Return true if was found and erased.
+    bool Remove(const T& value)
+    {
+        Iterator i = Find(value);
+        if (i != End())
+        {
+            Erase((unsigned)(i - Begin()));
+            return true;
+        }
+        else
+            return false;
+    }
+
+    /// Clear the vector. Keeps the current buffer.
+    void Clear() { size_ = 0; }
+
+    /// Resize the vector.
+    void Resize(unsigned newSize)
+    {
+        if (newSize > capacity_)
+        {
+            unsigned newCapacity = capacity_;
+            // Increase the capacity with half each time it is exceeded
+            while (newCapacity < newSize)
+                newCapacity += (newCapacity + 1) >> 1u;
+            Reallocate(newCapacity);
+        }
+        size_ = newSize;
+    }
+
+    /// Set new capacity. The inline storage is used again when it is large enough.
+    void Reserve(unsigned newCapacity)
+    {
+        if (newCapacity < size_)
+            newCapacity = size_;
+        if (newCapacity < N)
+            newCapacity = N;
+        if (newCapacity != capacity_)
+            Reallocate(newCapacity);
+    }
+
+    /// Reallocate so that no extra memory is used.
+    void Compact() { Reserve(size_); }
+
+    /// Return iterator to value, or to the end if not found.
+    Iterator Find(const T& value)
+    {
+        Iterator it = Begin();
+        while (it != End() && *it != value)
+            ++it;
+        return it;
+    }
+
+    /// Return const iterator to value, or to the end if not found.
+    ConstIterator Find(const T& value) const
+    {
+        ConstIterator it = Begin();
+        while (it != End() && *it != value)
+            ++it;
+        return it;
+    }
+
+    /// Return index of value in vector, or size if not found.
+    unsigned IndexOf(const T& value) const
+    {
+        return (unsigned)(Find(value) - Begin());
+    }
+
+    /// Return whether contains a specific value.
+    bool Contains(const T& value) const { return Find(value) != End(); }
+
+    /// Return iterator to the beginning.
+    Iterator Begin() { return Iterator(buffer_); }
+
+    /// Return const iterator to the beginning.
+    ConstIterator Begin() const { return ConstIterator(buffer_); }
+
+    /// Return iterator to the end.
+    Iterator End() { return Iterator(buffer_ + size_); }
+
+    /// Return const iterator to the end.
+    ConstIterator End() const { return ConstIterator(buffer_ + size_); }
+
+    /// Return first element.
+    T& Front() { return buffer_[0]; }
+
+    /// Return const first element.
+    const T& Front() const { return buffer_[0]; }
+
+    /// Return last element.
+    T& Back()
+    {
+        assert(size_);
+        return buffer_[size_ - 1];
+    }
+
+    /// Return const last element.
+    const T& Back() const
+    {
+        assert(size_);
+        return buffer_[size_ - 1];
+    }
+
+    /// Return size of vector.
+    unsigned Size() const { return size_; }
+
+    /// Return capacity of vector.
+    unsigned Capacity() const { return capacity_; }
+
+    /// Return whether vector is empty.
+    bool Empty() const { return size_ == 0; }
+
+    /// Return whether the elements are stored inline.
+    bool IsLocal() const { return buffer_ == LocalBuffer(); }
+
+    /// Return the buffer with right type.
+    T* Buffer() const { return buffer_; }
+
+    /// Number of elements stored inline.
+    static const unsigned LOCAL_CAPACITY = N;
+
+private:
+    /// Return the inline storage.
+    T* LocalBuffer() const { return reinterpret_cast<T*>(const_cast<unsigned char*>(localStorage_)); }
+
+    /// Move the elements to a buffer of the given capacity, which may be the inline storage.
+    void Reallocate(unsigned newCapacity)
+    {
+        T* newBuffer = newCapacity > N ? reinterpret_cast<T*>(new unsigned char[newCapacity * sizeof(T)]) : LocalBuffer();
+        if (newBuffer == buffer_)
+            return;
+
+        CopyElements(newBuffer, buffer_, size_);
+        if (!IsLocal())
+            delete[] reinterpret_cast<unsigned char*>(buffer_);
+        buffer_ = newBuffer;
+        capacity_ = newCapacity;
+    }
+
+    /// Move a range of elements within the vector.
+    void MoveRange(unsigned dest, unsigned src, unsigned count)
+    {
+        if (count)
+            memmove(buffer_ + dest, buffer_ + src, count * sizeof(T));
+    }
+
+    /// Copy elements from one buffer to another.
+    static void CopyElements(T* dest, const T* src, unsigned count)
+    {
+        if (count)
+            memcpy(dest, src, count * sizeof(T));
+    }
+
+    /// Current buffer, either the inline storage or a heap allocation.
+    T* buffer_;
+    /// Size of vector.
+    unsigned size_;
+    /// Buffer capacity.
+    unsigned capacity_;
+    /// Inline storage for N elements.
+    alignas(T) unsigned char localStorage_[N * sizeof(T)];
+};
+
+template <class T, unsigned N> typename Urho3D::SmallVector<T, N>::ConstIterator begin(const Urho3D::SmallVector<T, N>& v) { return v.Begin(); }
+
+template <class T, unsigned N> typename Urho3D::SmallVector<T, N>::ConstIterator end(const Urho3D::SmallVector<T, N>& v) { return v.End(); }
+
+template <class T, unsigned N> typename Urho3D::SmallVector<T, N>::Iterator begin(Urho3D::SmallVector<T, N>& v) { return v.Begin(); }
+
+template <class T, unsigned N> typename Urho3D::SmallVector<T, N>::Iterator end(Urho3D::SmallVector<T, N>& v) { return v.End(); }
+
+}
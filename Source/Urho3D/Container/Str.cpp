@@ -22,6 +22,7 @@
 
 #include "../Precompiled.h"
 
+#include "../Core/Profiler.h"
 #include "../IO/Log.h"
 
 #include <cstdio>
@@ -35,22 +36,25 @@
 namespace Urho3D
 {
 
-char String::endZero = 0;
+#ifdef URHO3D_TRACY_MEMORY
+/// Tracy memory pool of the string heap buffers.
+static const char* STRING_MEMORY_POOL = "String";
+#endif
 
 const String String::EMPTY;
 
 String::String(const WString& str) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     SetUTF8FromWChar(str.CString());
 }
 
 String::String(int value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     char tempBuffer[CONVERSION_BUFFER_LENGTH];
     sprintf(tempBuffer, "%d", value);
@@ -59,8 +63,8 @@ String::String(int value) :
 
 String::String(short value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     char tempBuffer[CONVERSION_BUFFER_LENGTH];
     sprintf(tempBuffer, "%d", value);
@@ -69,8 +73,8 @@ String::String(short value) :
 
 String::String(long value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     char tempBuffer[CONVERSION_BUFFER_LENGTH];
     sprintf(tempBuffer, "%ld", value);
@@ -79,8 +83,8 @@ String::String(long value) :
 
 String::String(long long value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     char tempBuffer[CONVERSION_BUFFER_LENGTH];
     sprintf(tempBuffer, "%lld", value);
@@ -89,8 +93,8 @@ String::String(long long value) :
 
 String::String(unsigned value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     char tempBuffer[CONVERSION_BUFFER_LENGTH];
     sprintf(tempBuffer, "%u", value);
@@ -99,8 +103,8 @@ String::String(unsigned value) :
 
 String::String(unsigned short value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     char tempBuffer[CONVERSION_BUFFER_LENGTH];
     sprintf(tempBuffer, "%u", value);
@@ -109,8 +113,8 @@ String::String(unsigned short value) :
 
 String::String(unsigned long value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     char tempBuffer[CONVERSION_BUFFER_LENGTH];
     sprintf(tempBuffer, "%lu", value);
@@ -119,8 +123,8 @@ String::String(unsigned long value) :
 
 String::String(unsigned long long value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     char tempBuffer[CONVERSION_BUFFER_LENGTH];
     sprintf(tempBuffer, "%llu", value);
@@ -129,8 +133,8 @@ String::String(unsigned long long value) :
 
 String::String(float value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     char tempBuffer[CONVERSION_BUFFER_LENGTH];
     sprintf(tempBuffer, "%g", value);
@@ -139,8 +143,8 @@ String::String(float value) :
 
 String::String(double value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     char tempBuffer[CONVERSION_BUFFER_LENGTH];
     sprintf(tempBuffer, "%.15g", value);
@@ -149,8 +153,8 @@ String::String(double value) :
 
 String::String(bool value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     if (value)
         *this = "true";
@@ -160,21 +164,21 @@ String::String(bool value) :
 
 String::String(char value) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     Resize(1);
-    buffer_[0] = value;
+    Buffer()[0] = value;
 }
 
 String::String(char value, unsigned length) :
     length_(0),
-    capacity_(0),
-    buffer_(&endZero)
+    capacity_(LOCAL_CAPACITY),
+    localBuffer_()
 {
     Resize(length);
     for (unsigned i = 0; i < length; ++i)
-        buffer_[i] = value;
+        Buffer()[i] = value;
 }
 
 String& String::operator +=(int rhs)
@@ -233,8 +237,8 @@ void String::Replace(char replaceThis, char replaceWith, bool caseSensitive)
     {
         for (unsigned i = 0; i < length_; ++i)
         {
-            if (buffer_[i] == replaceThis)
-                buffer_[i] = replaceWith;
+            if (Buffer()[i] == replaceThis)
+                Buffer()[i] = replaceWith;
         }
     }
     else
@@ -242,8 +246,8 @@ void String::Replace(char replaceThis, char replaceWith, bool caseSensitive)
         replaceThis = (char)tolower(replaceThis);
         for (unsigned i = 0; i < length_; ++i)
         {
-            if (tolower(buffer_[i]) == replaceThis)
-                buffer_[i] = replaceWith;
+            if (tolower(Buffer()[i]) == replaceThis)
+                Buffer()[i] = replaceWith;
         }
     }
 }
@@ -268,7 +272,7 @@ void String::Replace(unsigned pos, unsigned length, const String& replaceWith)
     if (pos + length > length_)
         return;
 
-    Replace(pos, length, replaceWith.buffer_, replaceWith.length_);
+    Replace(pos, length, replaceWith.Buffer(), replaceWith.length_);
 }
 
 void String::Replace(unsigned pos, unsigned length, const char* replaceWith)
@@ -326,7 +330,7 @@ String& String::Append(const char* str, unsigned length)
     {
         unsigned oldLength = length_;
         Resize(oldLength + length);
-        CopyChars(&buffer_[oldLength], str, length);
+        CopyChars(&Buffer()[oldLength], str, length);
     }
     return *this;
 }
@@ -354,7 +358,7 @@ void String::Insert(unsigned pos, char c)
         unsigned oldLength = length_;
         Resize(length_ + 1);
         MoveRange(pos + 1, pos, oldLength - pos);
-        buffer_[pos] = c;
+        Buffer()[pos] = c;
     }
 }
 
@@ -417,38 +421,37 @@ String::Iterator String::Erase(const String::Iterator& start, const String::Iter
 
 void String::Resize(unsigned newLength)
 {
-    if (!capacity_)
-    {
-        // If zero length requested, do not allocate buffer yet
-        if (!newLength)
-            return;
-
-        // Calculate initial capacity
-        capacity_ = newLength + 1;
-        if (capacity_ < MIN_CAPACITY)
-            capacity_ = MIN_CAPACITY;
-
-        buffer_ = new char[capacity_];
-    }
-    else
+    if (capacity_ < newLength + 1)
     {
-        if (newLength && capacity_ < newLength + 1)
+        unsigned newCapacity;
+        if (capacity_ <= LOCAL_CAPACITY)
+        {
+            // Leaving the inline buffer: calculate initial capacity
+            newCapacity = newLength + 1;
+            if (newCapacity < MIN_CAPACITY)
+                newCapacity = MIN_CAPACITY;
+        }
+        else
         {
             // Increase the capacity with half each time it is exceeded
-            while (capacity_ < newLength + 1)
-                capacity_ += (capacity_ + 1) >> 1u;
+            newCapacity = capacity_;
+            while (newCapacity < newLength + 1)
+                newCapacity += (newCapacity + 1) >> 1u;
+        }
 
-            auto* newBuffer = new char[capacity_];
-            // Move the existing data to the new buffer, then delete the old buffer
-            if (length_)
-                CopyChars(newBuffer, buffer_, length_);
-            delete[] buffer_;
+        char* newBuffer = AllocateBuffer(newCapacity);
+        // Move the existing data to the new buffer, then delete the old buffer if it was allocated
+        char* oldBuffer = Buffer();
+        if (length_)
+            CopyChars(newBuffer, oldBuffer, length_);
+        if (capacity_ > LOCAL_CAPACITY)
+            FreeBuffer(oldBuffer);
 
-            buffer_ = newBuffer;
-        }
+        capacity_ = newCapacity;
+        heapBuffer_ = newBuffer;
     }
 
-    buffer_[newLength] = 0;
+    Buffer()[newLength] = 0;
     length_ = newLength;
 }
 
@@ -456,22 +459,51 @@ void String::Reserve(unsigned newCapacity)
 {
     if (newCapacity < length_ + 1)
         newCapacity = length_ + 1;
+    if (newCapacity < LOCAL_CAPACITY)
+        newCapacity = LOCAL_CAPACITY;
     if (newCapacity == capacity_)
         return;
 
-    auto* newBuffer = new char[newCapacity];
-    // Move the existing data to the new buffer, then delete the old buffer
-    CopyChars(newBuffer, buffer_, length_ + 1);
-    if (capacity_)
-        delete[] buffer_;
+    char* oldBuffer = Buffer();
+    if (newCapacity == LOCAL_CAPACITY)
+    {
+        // Fits in the inline buffer again. The heap pointer shares storage with it, so it was saved above
+        CopyChars(localBuffer_, oldBuffer, length_ + 1);
+        FreeBuffer(oldBuffer);
+    }
+    else
+    {
+        char* newBuffer = AllocateBuffer(newCapacity);
+        // Move the existing data to the new buffer, then delete the old buffer
+        CopyChars(newBuffer, oldBuffer, length_ + 1);
+        if (capacity_ > LOCAL_CAPACITY)
+            FreeBuffer(oldBuffer);
+        heapBuffer_ = newBuffer;
+    }
 
     capacity_ = newCapacity;
-    buffer_ = newBuffer;
 }
 
+char* String::AllocateBuffer(unsigned capacity)
+{
+    auto* buffer = new char[capacity];
+#ifdef URHO3D_TRACY_MEMORY
+    URHO3D_PROFILE_ALLOC(buffer, capacity, STRING_MEMORY_POOL);
+#endif
+    return buffer;
+}
+
+#ifdef URHO3D_TRACY_MEMORY
+void String::FreeBuffer(char* buffer)
+{
+    URHO3D_PROFILE_FREE(buffer, STRING_MEMORY_POOL);
+    delete[] buffer;
+}
+#endif
+
 void String::Compact()
 {
-    if (capacity_)
+    if (capacity_ > LOCAL_CAPACITY)
         Reserve(length_ + 1);
 }
 
@@ -484,7 +516,12 @@ void String::Swap(String& str)
 {
     Urho3D::Swap(length_, str.length_);
     Urho3D::Swap(capacity_, str.capacity_);
-    Urho3D::Swap(buffer_, str.buffer_);
+
+    // Exchange the storage bytewise, which covers both the inline buffer and the heap pointer
+    char temp[LOCAL_CAPACITY];
+    memcpy(temp, localBuffer_, LOCAL_CAPACITY);
+    memcpy(localBuffer_, str.localBuffer_, LOCAL_CAPACITY);
+    memcpy(str.localBuffer_, temp, LOCAL_CAPACITY);
 }
 
 String String::Substring(unsigned pos) const
@@ -493,7 +530,7 @@ String String::Substring(unsigned pos) const
     {
         String ret;
         ret.Resize(length_ - pos);
-        CopyChars(ret.buffer_, buffer_ + pos, ret.length_);
+        CopyChars(ret.Buffer(), Buffer() + pos, ret.length_);
 
         return ret;
     }
@@ -509,7 +546,7 @@ String String::Substring(unsigned pos, unsigned length) const
         if (pos + length > length_)
             length = length_ - pos;
         ret.Resize(length);
-        CopyChars(ret.buffer_, buffer_ + pos, ret.length_);
+        CopyChars(ret.Buffer(), Buffer() + pos, ret.length_);
 
         return ret;
     }
@@ -524,14 +561,14 @@ String String::Trimmed() const
 
     while (trimStart < trimEnd)
     {
-        char c = buffer_[trimStart];
+        char c = Buffer()[trimStart];
         if (c != ' ' && c != 9)
             break;
         ++trimStart;
     }
     while (trimEnd > trimStart)
     {
-        char c = buffer_[trimEnd - 1];
+        char c = Buffer()[trimEnd - 1];
         if (c != ' ' && c != 9)
             break;
         --trimEnd;
@@ -544,7 +581,7 @@ String String::ToLower() const
 {
     String ret(*this);
     for (unsigned i = 0; i < ret.length_; ++i)
-        ret[i] = (char)tolower(buffer_[i]);
+        ret[i] = (char)tolower(Buffer()[i]);
 
     return ret;
 }
@@ -553,7 +590,7 @@ String String::ToUpper() const
 {
     String ret(*this);
     for (unsigned i = 0; i < ret.length_; ++i)
-        ret[i] = (char)toupper(buffer_[i]);
+        ret[i] = (char)toupper(Buffer()[i]);
 
     return ret;
 }
@@ -574,7 +611,7 @@ unsigned String::Find(char c, unsigned startPos, bool caseSensitive) const
     {
         for (unsigned i = startPos; i < length_; ++i)
         {
-            if (buffer_[i] == c)
+            if (Buffer()[i] == c)
                 return i;
         }
     }
@@ -583,7 +620,7 @@ unsigned String::Find(char c, unsigned startPos, bool caseSensitive) const
         c = (char)tolower(c);
         for (unsigned i = startPos; i < length_; ++i)
         {
-            if (tolower(buffer_[i]) == c)
+            if (tolower(Buffer()[i]) == c)
                 return i;
         }
     }
@@ -596,13 +633,13 @@ unsigned String::Find(const String& str, unsigned startPos, bool caseSensitive)
     if (!str.length_ || str.length_ > length_)
         return NPOS;
 
-    char first = str.buffer_[0];
+    char first = str.Buffer()[0];
     if (!caseSensitive)
         first = (char)tolower(first);
 
     for (unsigned i = startPos; i <= length_ - str.length_; ++i)
     {
-        char c = buffer_[i];
+        char c = Buffer()[i];
         if (!caseSensitive)
             c = (char)tolower(c);
 
@@ -612,8 +649,8 @@ unsigned String::Find(const String& str, unsigned startPos, bool caseSensitive)
             bool found = true;
             for (unsigned j = 1; j < str.length_; ++j)
             {
-                c = buffer_[i + j];
-                char d = str.buffer_[j];
+                c = Buffer()[i + j];
+                char d = str.Buffer()[j];
                 if (!caseSensitive)
                 {
                     c = (char)tolower(c);
@@ -648,7 +685,7 @@ unsigned String::FindLast(char c, unsigned startPos, bool caseSensitive) const
     {
         for (unsigned i = startPos; i < length_; --i)
         {
-            if (buffer_[i] == c)
+            if (Buffer()[i] == c)
                 return i;
         }
     }
@@ -657,7 +694,7 @@ unsigned String::FindLast(char c, unsigned startPos, bool caseSensitive) const
         c = (char)tolower(c);
         for (unsigned i = startPos; i < length_; --i)
         {
-            if (tolower(buffer_[i]) == c)
+            if (tolower(Buffer()[i]) == c)
                 return i;
         }
     }
@@ -672,13 +709,13 @@ unsigned String::FindLast(const String& str, unsigned startPos, bool caseSensiti
     if (startPos > length_ - str.length_)
         startPos = length_ - str.length_;
 
-    char first = str.buffer_[0];
+    char first = str.Buffer()[0];
     if (!caseSensitive)
         first = (char)tolower(first);
 
     for (unsigned i = startPos; i < length_; --i)
     {
-        char c = buffer_[i];
+        char c = Buffer()[i];
         if (!caseSensitive)
             c = (char)tolower(c);
 
@@ -687,8 +724,8 @@ unsigned String::FindLast(const String& str, unsigned startPos, bool caseSensiti
             bool found = true;
             for (unsigned j = 1; j < str.length_; ++j)
             {
-                c = buffer_[i + j];
-                char d = str.buffer_[j];
+                c = Buffer()[i + j];
+                char d = str.Buffer()[j];
                 if (!caseSensitive)
                 {
                     c = (char)tolower(c);
@@ -781,10 +818,10 @@ unsigned String::LengthUTF8() const
 {
     unsigned ret = 0;
 
-    const char* src = buffer_;
+    const char* src = Buffer();
     if (!src)
         return ret;
-    const char* end = buffer_ + length_;
+    const char* end = Buffer() + length_;
 
     while (src < end)
     {
@@ -811,12 +848,10 @@ unsigned String::ByteOffsetUTF8(unsigned index) const
 
 unsigned String::NextUTF8Char(unsigned& byteOffset) const
 {
-    if (!buffer_)
-        return 0;
-
-    const char* src = buffer_ + byteOffset;
+    const char* buffer = Buffer();
+    const char* src = buffer + byteOffset;
     unsigned ret = DecodeUTF8(src);
-    byteOffset = (unsigned)(src - buffer_);
+    byteOffset = (unsigned)(src - buffer);
 
     return ret;
 }
@@ -1231,7 +1266,7 @@ void String::Replace(unsigned pos, unsigned length, const char* srcStart, unsign
     else
         Resize(length_ + delta);
 
-    CopyChars(buffer_ + pos, srcStart, srcLength);
+    CopyChars(Buffer() + pos, srcStart, srcLength);
 }
 
 WString::WString() :
@@ -52,16 +52,16 @@ public:
     /// Construct empty.
     String() noexcept :
         length_(0),
-        capacity_(0),
-        buffer_(&endZero)
+        capacity_(LOCAL_CAPACITY),
+        localBuffer_()
     {
     }
 
     /// Construct from another string.
     String(const String& str) :
         length_(0),
-        capacity_(0),
-        buffer_(&endZero)
+        capacity_(LOCAL_CAPACITY),
+        localBuffer_()
     {
         *this = str;
     }
@@ -69,8 +69,8 @@ public:
     /// Move-construct from another string.
     String(String && str) noexcept :
         length_(0),
-        capacity_(0),
-        buffer_(&endZero)
+        capacity_(LOCAL_CAPACITY),
+        localBuffer_()
     {
         Swap(str);
     }
@@ -78,8 +78,8 @@ public:
     /// Construct from a C string.
     String(const char* str) :   // NOLINT(google-explicit-constructor)
         length_(0),
-        capacity_(0),
-        buffer_(&endZero)
+        capacity_(LOCAL_CAPACITY),
+        localBuffer_()
     {
         *this = str;
     }
@@ -87,8 +87,8 @@ public:
     /// Construct from a C string.
     String(char* str) :         // NOLINT(google-explicit-constructor)
         length_(0),
-        capacity_(0),
-        buffer_(&endZero)
+        capacity_(LOCAL_CAPACITY),
+        localBuffer_()
     {
         *this = (const char*)str;
     }
@@ -96,18 +96,18 @@ public:
     /// Construct from a char array and length.
     String(const char* str, unsigned length) :
         length_(0),
-        capacity_(0),
-        buffer_(&endZero)
+        capacity_(LOCAL_CAPACITY),
+        localBuffer_()
     {
         Resize(length);
-        CopyChars(buffer_, str, length);
+        CopyChars(Buffer(), str, length);
     }
 
     /// Construct from a null-terminated wide character array.
     explicit String(const wchar_t* str) :
         length_(0),
-        capacity_(0),
-        buffer_(&endZero)
+        capacity_(LOCAL_CAPACITY),
+        localBuffer_()
     {
         SetUTF8FromWChar(str);
     }
@@ -115,8 +115,8 @@ public:
     /// Construct from a null-terminated wide character array.
     explicit String(wchar_t* str) :
         length_(0),
-        capacity_(0),
-        buffer_(&endZero)
+        capacity_(LOCAL_CAPACITY),
+        localBuffer_()
     {
         SetUTF8FromWChar(str);
     }
@@ -156,8 +156,8 @@ public:
     /// Construct from a convertible value.
     template <class T> explicit String(const T& value) :
         length_(0),
-        capacity_(0),
-        buffer_(&endZero)
+        capacity_(LOCAL_CAPACITY),
+        localBuffer_()
     {
         *this = value.ToString();
     }
@@ -165,8 +165,8 @@ public:
     /// Destruct.
     ~String()
     {
-        if (capacity_)
-            delete[] buffer_;
+        if (capacity_ > LOCAL_CAPACITY)
+            FreeBuffer(heapBuffer_);
     }
 
     /// Assign a string.
@@ -175,7 +175,7 @@ public:
         if (&rhs != this)
         {
             Resize(rhs.length_);
-            CopyChars(buffer_, rhs.buffer_, rhs.length_);
+            CopyChars(Buffer(), rhs.Buffer(), rhs.length_);
         }
 
         return *this;
@@ -193,7 +193,7 @@ public:
     {
         unsigned rhsLength = CStringLength(rhs);
         Resize(rhsLength);
-        CopyChars(buffer_, rhs, rhsLength);
+        CopyChars(Buffer(), rhs, rhsLength);
 
         return *this;
     }
@@ -203,7 +203,7 @@ public:
     {
         unsigned oldLength = length_;
         Resize(length_ + rhs.length_);
-        CopyChars(buffer_ + oldLength, rhs.buffer_, rhs.length_);
+        CopyChars(Buffer() + oldLength, rhs.Buffer(), rhs.length_);
 
         return *this;
     }
@@ -214,7 +214,7 @@ public:
         unsigned rhsLength = CStringLength(rhs);
         unsigned oldLength = length_;
         Resize(length_ + rhsLength);
-        CopyChars(buffer_ + oldLength, rhs, rhsLength);
+        CopyChars(Buffer() + oldLength, rhs, rhsLength);
 
         return *this;
     }
@@ -224,7 +224,7 @@ public:
     {
         unsigned oldLength = length_;
         Resize(length_ + 1);
-        buffer_[oldLength] = rhs;
+        Buffer()[oldLength] = rhs;
 
         return *this;
     }
@@ -260,8 +260,8 @@ public:
     {
         String ret;
         ret.Resize(length_ + rhs.length_);
-        CopyChars(ret.buffer_, buffer_, length_);
-        CopyChars(ret.buffer_ + length_, rhs.buffer_, rhs.length_);
+        CopyChars(ret.Buffer(), Buffer(), length_);
+        CopyChars(ret.Buffer() + length_, rhs.Buffer(), rhs.length_);
 
         return ret;
     }
@@ -272,8 +272,8 @@ public:
         unsigned rhsLength = CStringLength(rhs);
         String ret;
         ret.Resize(length_ + rhsLength);
-        CopyChars(ret.buffer_, buffer_, length_);
-        CopyChars(ret.buffer_ + length_, rhs, rhsLength);
+        CopyChars(ret.Buffer(), Buffer(), length_);
+        CopyChars(ret.Buffer() + length_, rhs, rhsLength);
 
         return ret;
     }
@@ -306,28 +306,28 @@ public:
     char& operator [](unsigned index)
     {
         assert(index < length_);
-        return buffer_[index];
+        return Buffer()[index];
     }
 
     /// Return const char at index.
     const char& operator [](unsigned index) const
     {
         assert(index < length_);
-        return buffer_[index];
+        return Buffer()[index];
     }
 
     /// Return char at index.
     char& At(unsigned index)
     {
         assert(index < length_);
-        return buffer_[index];
+        return Buffer()[index];
     }
 
     /// Return const char at index.
     const char& At(unsigned index) const
     {
         assert(index < length_);
-        return buffer_[index];
+        return Buffer()[index];
     }
 
     /// Replace all occurrences of a character.
@@ -380,22 +380,22 @@ public:
     void Swap(String& str);
 
     /// Return iterator to the beginning.
-    Iterator Begin() { return Iterator(buffer_); }
+    Iterator Begin() { return Iterator(Buffer()); }
 
     /// Return const iterator to the beginning.
-    ConstIterator Begin() const { return ConstIterator(buffer_); }
+    ConstIterator Begin() const { return ConstIterator(Buffer()); }
 
     /// Return iterator to the end.
-    Iterator End() { return Iterator(buffer_ + length_); }
+    Iterator End() { return Iterator(Buffer() + length_); }
 
     /// Return const iterator to the end.
-    ConstIterator End() const { return ConstIterator(buffer_ + length_); }
+    ConstIterator End() const { return ConstIterator(Buffer() + length_); }
 
     /// Return first char, or 0 if empty.
-    char Front() const { return buffer_[0]; }
+    char Front() const { return Buffer()[0]; }
 
     /// Return last char, or 0 if empty.
-    char Back() const { return length_ ? buffer_[length_ - 1] : buffer_[0]; }
+    char Back() const { return length_ ? Buffer()[length_ - 1] : Buffer()[0]; }
 
     /// Return a substring from position to end.
     String Substring(unsigned pos) const;
@@ -425,7 +425,7 @@ public:
     bool EndsWith(const String& str, bool caseSensitive = true) const;
 
     /// Return the C string.
-    const char* CString() const { return buffer_; }
+    const char* CString() const { return Buffer(); }
 
     /// Return length.
     /// @property
@@ -475,7 +475,7 @@ public:
     unsigned ToHash() const
     {
         unsigned hash = 0;
-        const char* ptr = buffer_;
+        const char* ptr = Buffer();
         while (*ptr)
         {
             hash = *ptr + (hash << 6u) + (hash << 16u) - hash;
@@ -514,17 +514,22 @@ public:
 
     /// Position for "not found".
     static const unsigned NPOS = 0xffffffff;
+    /// Size of the inline buffer including the terminating zero, 16 bytes on 64-bit platform. Strings that fit do not allocate. Keeps the string small enough for ResourceRef to fit in a Variant.
+    static const unsigned LOCAL_CAPACITY = sizeof(void*) * 3 - sizeof(unsigned) * 2;
     /// Initial dynamic allocation size.
-    static const unsigned MIN_CAPACITY = 8;
+    static const unsigned MIN_CAPACITY = LOCAL_CAPACITY * 2;
     /// Empty string.
     static const String EMPTY;
 
 private:
+    /// Return the character buffer, either the inline one or the heap allocation.
+    char* Buffer() const { return capacity_ > LOCAL_CAPACITY ? heapBuffer_ : const_cast<char*>(localBuffer_); }
+
     /// Move a range of characters within the string.
     void MoveRange(unsigned dest, unsigned src, unsigned count)
     {
         if (count)
-            memmove(buffer_ + dest, buffer_ + src, count);
+            memmove(Buffer() + dest, Buffer() + src, count);
     }
 
     /// Copy chars from one buffer to another.
@@ -547,15 +552,28 @@ private:
     /// Replace a substring with another substring.
     void Replace(unsigned pos, unsigned length, const char* srcStart, unsigned srcLength);
 
+    /// Allocate a heap buffer.
+    static char* AllocateBuffer(unsigned capacity);
+#ifdef URHO3D_TRACY_MEMORY
+    /// Free a heap buffer.
+    static void FreeBuffer(char* buffer);
+#else
+    /// Free a heap buffer.
+    static void FreeBuffer(char* buffer) { delete[] buffer; }
+#endif
+
     /// String length.
     unsigned length_;
-    /// Capacity, zero if buffer not allocated.
+    /// Capacity including the terminating zero, LOCAL_CAPACITY if the inline buffer is in use.
     unsigned capacity_;
-    /// String buffer, point to &endZero if buffer is not allocated.
-    char* buffer_;
-
-    /// End zero for empty strings.
-    static char endZero;
+    /// String storage. Never points into itself, so strings stay valid when relocated with memcpy.
+    union
+    {
+        /// Heap buffer when capacity exceeds LOCAL_CAPACITY.
+        char* heapBuffer_;
+        /// Inline buffer for short strings.
+        char localBuffer_[LOCAL_CAPACITY];
+    };
 };
 
 /// Add a string to a C string.
@@ -104,7 +104,7 @@ public:
     ~Vector()
     {
         DestructElements(Buffer(), size_);
-        delete[] buffer_;
+        FreeBuffer(buffer_);
     }
 
     /// Assign from another vector.
@@ -452,7 +452,7 @@ public:
 
             // Delete the old buffer
             DestructElements(Buffer(), size_);
-            delete[] buffer_;
+            FreeBuffer(buffer_);
             buffer_ = reinterpret_cast<unsigned char*>(newBuffer);
         }
     }
@@ -729,7 +729,7 @@ public:
     /// Destruct.
     ~PODVector()
     {
-        delete[] buffer_;
+        FreeBuffer(buffer_);
     }
 
     /// Assign from another vector.
@@ -1044,7 +1044,7 @@ public:
             if (buffer_)
             {
                 CopyElements(reinterpret_cast<T*>(newBuffer), Buffer(), size_);
-                delete[] buffer_;
+                FreeBuffer(buffer_);
             }
             buffer_ = newBuffer;
         }
@@ -1080,7 +1080,7 @@ public:
             }
 
             // Delete the old buffer
-            delete[] buffer_;
+            FreeBuffer(buffer_);
             buffer_ = newBuffer;
         }
     }
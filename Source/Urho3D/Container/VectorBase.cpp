@@ -23,15 +23,36 @@
 #include "../Precompiled.h"
 
 #include "../Container/VectorBase.h"
+#include "../Core/Profiler.h"
 
 #include "../DebugNew.h"
 
 namespace Urho3D
 {
 
+#ifdef URHO3D_TRACY_MEMORY
+/// Tracy memory pool of the vector buffers.
+static const char* VECTOR_MEMORY_POOL = "Vector";
+#endif
+
 unsigned char* VectorBase::AllocateBuffer(unsigned size)
 {
-    return new unsigned char[size];
+    auto* buffer = new unsigned char[size];
+#ifdef URHO3D_TRACY_MEMORY
+    URHO3D_PROFILE_ALLOC(buffer, size, VECTOR_MEMORY_POOL);
+#endif
+    return buffer;
+}
+
+#ifdef URHO3D_TRACY_MEMORY
+void VectorBase::FreeBuffer(unsigned char* buffer)
+{
+    if (buffer)
+    {
+        URHO3D_PROFILE_FREE(buffer, VECTOR_MEMORY_POOL);
+        delete[] buffer;
+    }
 }
+#endif
 
 }
@@ -58,7 +58,15 @@ public:
     }
 
 protected:
+    /// Allocate a buffer of the given size in bytes.
     static unsigned char* AllocateBuffer(unsigned size);
+#ifdef URHO3D_TRACY_MEMORY
+    /// Free a buffer allocated with AllocateBuffer().
+    static void FreeBuffer(unsigned char* buffer);
+#else
+    /// Free a buffer allocated with AllocateBuffer().
+    static void FreeBuffer(unsigned char* buffer) { delete[] buffer; }
+#endif
 
     /// Size of vector.
     unsigned size_;
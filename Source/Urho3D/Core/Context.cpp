@@ -24,6 +24,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/EventProfiler.h"
+#include "../Core/Profiler.h"
 #include "../IO/Log.h"
 
 #ifndef MINI_URHO
@@ -120,6 +121,25 @@ void RemoveNamedAttribute(HashMap<StringHash, Vector<AttributeInfo> >& attribute
         attributes.Erase(i);
 }
 
+static void SetNamedAttributeMetadata(HashMap<StringHash, Vector<AttributeInfo> >& attributes, StringHash objectType, const char* name,
+    StringHash key, const Variant& value)
+{
+    HashMap<StringHash, Vector<AttributeInfo> >::Iterator i = attributes.Find(objectType);
+    if (i == attributes.End())
+        return;
+
+    Vector<AttributeInfo>& infos = i->second_;
+
+    for (Vector<AttributeInfo>::Iterator j = infos.Begin(); j != infos.End(); ++j)
+    {
+        if (!j->name_.Compare(name, true))
+        {
+            j->metadata_[key] = value;
+            break;
+        }
+    }
+}
+
 Context::Context() :
     eventHandler_(nullptr)
 {
@@ -130,6 +150,7 @@ Context::Context() :
 
     // Set the main thread ID (assuming the Context is created in it)
     Thread::SetMainThread();
+    URHO3D_PROFILE_THREAD("Main Thread");
 }
 
 Context::~Context()
@@ -149,6 +170,9 @@ Context::~Context()
     for (PODVector<VariantMap*>::Iterator i = eventDataMaps_.Begin(); i != eventDataMaps_.End(); ++i)
         delete *i;
     eventDataMaps_.Clear();
+    for (PODVector<VariantMap*>::Iterator i = typedEventDataMaps_.Begin(); i != typedEventDataMaps_.End(); ++i)
+        delete *i;
+    typedEventDataMaps_.Clear();
 }
 
 SharedPtr<Object> Context::CreateObject(StringHash objectType)
@@ -238,6 +262,12 @@ void Context::UpdateAttributeDefaultValue(StringHash objectType, const char* nam
         info->defaultValue_ = defaultValue;
 }
 
+void Context::SetAttributeMetadata(StringHash objectType, const char* name, StringHash key, const Variant& value)
+{
+    SetNamedAttributeMetadata(attributes_, objectType, name, key, value);
+    SetNamedAttributeMetadata(networkAttributes_, objectType, name, key, value);
+}
+
 VariantMap& Context::GetEventDataMap()
 {
     unsigned nestingLevel = eventSenders_.Size();
@@ -249,6 +279,18 @@ VariantMap& Context::GetEventDataMap()
     return ret;
 }
 
+VariantMap& Context::GetTypedEventDataMap()
+{
+    // The event being sent is the innermost one on the sender stack
+    unsigned nestingLevel = eventSenders_.Size() ? eventSenders_.Size() - 1 : 0;
+    while (typedEventDataMaps_.Size() < nestingLevel + 1)
+        typedEventDataMaps_.Push(new VariantMap());
+
+    VariantMap& ret = *typedEventDataMaps_[nestingLevel];
+    ret.Clear();
+    return ret;
+}
+
 #ifndef MINI_URHO
 bool Context::RequireSDL(unsigned int sdlFlags)
 {
@@ -82,6 +82,7 @@ public:
 
         current_ = static_cast<EventProfilerBlock*>(current_)->GetChild(eventID);
         current_->Begin();
+        BeginTraceBlock();
     }
 
 private:
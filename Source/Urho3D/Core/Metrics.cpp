@@ -0,0 +1,279 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Container/HashSet.h"
+#include "../Core/CoreEvents.h"
+#include "../Core/Metrics.h"
+#include "../IO/Log.h"
+
+#ifdef URHO3D_NETWORK
+#include <Civetweb/civetweb.h>
+#endif
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+static const unsigned DEFAULT_METRICS_HISTORY_SIZE = 300;
+
+static const char* metricTypeNames[] =
+{
+    "counter",
+    "gauge",
+    nullptr
+};
+
+static String GetMetricKey(const String& subsystem, const String& name, const String& labels)
+{
+    return subsystem + "/" + name + "{" + labels + "}";
+}
+
+#ifdef URHO3D_NETWORK
+static int HandleMetricsRequest(mg_connection* connection, void* cbdata)
+{
+    String text = static_cast<Metrics*>(cbdata)->GetPrometheusText();
+    mg_printf(connection, "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %u\r\n"
+        "Connection: close\r\n\r\n", text.Length());
+    mg_write(connection, text.CString(), text.Length());
+    return 200;
+}
+#endif
+
+Metric::Metric(MetricType type, const String& subsystem, const String& name, const String& labels, const String& help) :
+    type_(type),
+    subsystem_(subsystem),
+    name_(name),
+    labels_(labels),
+    help_(help),
+    exportName_("urho3d_" + subsystem.ToLower() + "_" + name)
+{
+}
+
+Metrics::Metrics(Context* context) :
+    Object(context),
+    server_(nullptr),
+    historySize_(DEFAULT_METRICS_HISTORY_SIZE),
+    sampleIndex_(0),
+    numSamples_(0),
+    serverPort_(0)
+{
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(Metrics, HandleEndFrame));
+}
+
+Metrics::~Metrics()
+{
+    StopServer();
+}
+
+Metric* Metrics::GetCounter(const String& subsystem, const String& name, const String& help, const String& labels)
+{
+    return RegisterMetric(METRIC_COUNTER, subsystem, name, help, labels);
+}
+
+Metric* Metrics::GetGauge(const String& subsystem, const String& name, const String& help, const String& labels)
+{
+    return RegisterMetric(METRIC_GAUGE, subsystem, name, help, labels);
+}
+
+Metric* Metrics::GetMetric(const String& subsystem, const String& name, const String& labels) const
+{
+    MutexLock lock(metricsMutex_);
+
+    HashMap<String, Metric*>::ConstIterator i = metricsByKey_.Find(GetMetricKey(subsystem, name, labels));
+    return i != metricsByKey_.End() ? i->second_ : nullptr;
+}
+
+double Metrics::GetValue(const String& subsystem, const String& name, const String& labels) const
+{
+    Metric* metric = GetMetric(subsystem, name, labels);
+    return metric ? metric->GetValue() : 0.0;
+}
+
+void Metrics::SetHistorySize(unsigned frames)
+{
+    MutexLock lock(metricsMutex_);
+
+    historySize_ = Max(frames, 1U);
+    sampleIndex_ = 0;
+    numSamples_ = 0;
+    for (unsigned i = 0; i < metrics_.Size(); ++i)
+        metrics_[i]->history_.Resize(historySize_);
+}
+
+void Metrics::Sample()
+{
+    MutexLock lock(metricsMutex_);
+
+    for (unsigned i = 0; i < metrics_.Size(); ++i)
+        metrics_[i]->history_[sampleIndex_] = metrics_[i]->GetValue();
+
+    sampleIndex_ = (sampleIndex_ + 1) % historySize_;
+    numSamples_ = Min(numSamples_ + 1, historySize_);
+}
+
+bool Metrics::GetHistory(const String& subsystem, const String& name, PODVector<double>& dest, const String& labels) const
+{
+    Metric* metric = GetMetric(subsystem, name, labels);
+    if (!metric)
+    {
+        dest.Clear();
+        return false;
+    }
+
+    GetHistory(metric, dest);
+    return true;
+}
+
+void Metrics::GetHistory(const Metric* metric, PODVector<double>& dest) const
+{
+    MutexLock lock(metricsMutex_);
+
+    dest.Resize(numSamples_);
+    unsigned start = (sampleIndex_ + historySize_ - numSamples_) % historySize_;
+    for (unsigned i = 0; i < numSamples_; ++i)
+        dest[i] = metric->history_[(start + i) % historySize_];
+}
+
+String Metrics::GetPrometheusText() const
+{
+    MutexLock lock(metricsMutex_);
+
+    String text;
+    HashSet<String> writtenNames;
+
+    // Write the metrics with the same name but different labels as one group under a common description
+    for (unsigned i = 0; i < metrics_.Size(); ++i)
+    {
+        const String& exportName = metrics_[i]->exportName_;
+        if (writtenNames.Contains(exportName))
+            continue;
+        writtenNames.Insert(exportName);
+
+        if (!metrics_[i]->help_.Empty())
+            text += "# HELP " + exportName + " " + metrics_[i]->help_ + "\n";
+        text += "# TYPE " + exportName + " " + metricTypeNames[metrics_[i]->type_] + "\n";
+
+        for (unsigned j = i; j < metrics_.Size(); ++j)
+        {
+            const Metric* metric = metrics_[j];
+            if (metric->exportName_ != exportName)
+                continue;
+
+            text += exportName;
+            if (!metric->labels_.Empty())
+                text += "{" + metric->labels_ + "}";
+            text += " ";
+            if (metric->type_ == METRIC_COUNTER)
+                text += String(metric->count_.load(std::memory_order_relaxed));
+            else
+                text += String(metric->gauge_.load(std::memory_order_relaxed));
+            text += "\n";
+        }
+    }
+
+    return text;
+}
+
+bool Metrics::StartServer(unsigned short port)
+{
+#ifdef URHO3D_NETWORK
+    StopServer();
+
+    // Listen on the loopback interface only; expose it further with a reverse proxy if needed
+    String listeningPorts = "127.0.0.1:" + String(port);
+    const char* options[] =
+    {
+        "listening_ports", listeningPorts.CString(),
+        "num_threads", "1",
+        nullptr
+    };
+
+    mg_callbacks callbacks{};
+    server_ = mg_start(&callbacks, this, options);
+    if (!server_)
+    {
+        URHO3D_LOGERROR("Failed to start metrics server on port " + String(port));
+        return false;
+    }
+
+    mg_set_request_handler(server_, "/metrics", HandleMetricsRequest, this);
+    serverPort_ = port;
+    URHO3D_LOGINFO("Serving metrics on http://127.0.0.1:" + String(port) + "/metrics");
+    return true;
+#else
+    URHO3D_LOGERROR("Metrics server requires the network library");
+    return false;
+#endif
+}
+
+void Metrics::StopServer()
+{
+#ifdef URHO3D_NETWORK
+    if (server_)
+    {
+        mg_stop(server_);
+        server_ = nullptr;
+        serverPort_ = 0;
+    }
+#endif
+}
+
+unsigned Metrics::GetNumMetrics() const
+{
+    MutexLock lock(metricsMutex_);
+    return metrics_.Size();
+}
+
+Metric* Metrics::RegisterMetric(MetricType type, const String& subsystem, const String& name, const String& help,
+    const String& labels)
+{
+    MutexLock lock(metricsMutex_);
+
+    String key = GetMetricKey(subsystem, name, labels);
+    HashMap<String, Metric*>::ConstIterator i = metricsByKey_.Find(key);
+    if (i != metricsByKey_.End())
+    {
+        if (i->second_->type_ != type)
+            URHO3D_LOGERROR("Metric " + i->second_->exportName_ + " is already registered as a " + metricTypeNames[i->second_->type_]);
+        return i->second_;
+    }
+
+    SharedPtr<Metric> metric(new Metric(type, subsystem, name, labels, help));
+    metric->history_.Resize(historySize_);
+    // Zero the older samples, so that the history of a metric registered later starts from zero
+    for (unsigned j = 0; j < historySize_; ++j)
+        metric->history_[j] = 0.0;
+
+    metrics_.Push(metric);
+    metricsByKey_[key] = metric;
+    return metric;
+}
+
+void Metrics::HandleEndFrame(StringHash eventType, VariantMap& eventData)
+{
+    Sample();
+}
+
+}
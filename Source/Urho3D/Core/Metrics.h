@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Core/Mutex.h"
+#include "../Core/Object.h"
+
+#include <atomic>
+
+struct mg_context;
+
+namespace Urho3D
+{
+
+/// Metric kind.
+enum MetricType
+{
+    /// Monotonically increasing integer count.
+    METRIC_COUNTER = 0,
+    /// Value that can go up and down.
+    METRIC_GAUGE
+};
+
+/// Counter or gauge in the metrics registry. Updating the value is lock-free and can be done from any thread.
+/// @nobind
+class URHO3D_API Metric : public RefCounted
+{
+    friend class Metrics;
+
+public:
+    /// Construct.
+    Metric(MetricType type, const String& subsystem, const String& name, const String& labels, const String& help);
+
+    /// Add to a counter.
+    void Increment(long long amount = 1) { count_.fetch_add(amount, std::memory_order_relaxed); }
+    /// Set the value of a gauge.
+    void Set(double value) { gauge_.store(value, std::memory_order_relaxed); }
+
+    /// Return the current value.
+    double GetValue() const
+    {
+        return type_ == METRIC_COUNTER ? (double)count_.load(std::memory_order_relaxed) : gauge_.load(std::memory_order_relaxed);
+    }
+    /// Return kind.
+    MetricType GetType() const { return type_; }
+    /// Return subsystem name.
+    const String& GetSubsystem() const { return subsystem_; }
+    /// Return name within the subsystem.
+    const String& GetName() const { return name_; }
+    /// Return Prometheus labels, for example pass="base", or empty if none.
+    const String& GetLabels() const { return labels_; }
+    /// Return description.
+    const String& GetHelp() const { return help_; }
+    /// Return the name in the Prometheus export, for example urho3d_octree_queries_total.
+    const String& GetExportName() const { return exportName_; }
+
+private:
+    /// Kind.
+    MetricType type_;
+    /// Subsystem name.
+    String subsystem_;
+    /// Name within the subsystem.
+    String name_;
+    /// Prometheus labels.
+    String labels_;
+    /// Description.
+    String help_;
+    /// Name in the Prometheus export.
+    String exportName_;
+    /// Counter value.
+    std::atomic<long long> count_{};
+    /// Gauge value.
+    std::atomic<double> gauge_{};
+    /// Sampled values of the recent frames as a ring buffer. Written by Metrics::Sample() in the main thread.
+    PODVector<double> history_;
+};
+
+/// Registry of lightweight counters and gauges for monitoring shipping builds. Subsystems register their metrics once and keep the returned metrics for updating. All values are sampled into a ring buffer at the end of each frame, and can be exported in the Prometheus text format, either as a string or from a local HTTP endpoint.
+class URHO3D_API Metrics : public Object
+{
+    URHO3D_OBJECT(Metrics, Object);
+
+public:
+    /// Construct.
+    explicit Metrics(Context* context);
+    /// Destruct. Stop the export server.
+    ~Metrics() override;
+
+    /// Return a counter, registering it on first use. Can be called from any thread. Hold the metric in a SharedPtr if it may outlive the registry.
+    /// @nobind
+    Metric* GetCounter(const String& subsystem, const String& name, const String& help = String::EMPTY, const String& labels = String::EMPTY);
+    /// Return a gauge, registering it on first use. Can be called from any thread. Hold the metric in a SharedPtr if it may outlive the registry.
+    /// @nobind
+    Metric* GetGauge(const String& subsystem, const String& name, const String& help = String::EMPTY, const String& labels = String::EMPTY);
+    /// Return a registered metric, or null if not found.
+    /// @nobind
+    Metric* GetMetric(const String& subsystem, const String& name, const String& labels = String::EMPTY) const;
+    /// Return the current value of a registered metric, or 0 if not found.
+    double GetValue(const String& subsystem, const String& name, const String& labels = String::EMPTY) const;
+
+    /// Set number of frames kept in the sample history. Clears the history.
+    /// @property
+    void SetHistorySize(unsigned frames);
+    /// Sample the values of all metrics into the history. Called at the end of each frame.
+    void Sample();
+    /// Return the sampled values of a metric, oldest first. Return false if not found.
+    bool GetHistory(const String& subsystem, const String& name, PODVector<double>& dest, const String& labels = String::EMPTY) const;
+    /// Return the sampled values of a metric, oldest first.
+    /// @nobind
+    void GetHistory(const Metric* metric, PODVector<double>& dest) const;
+
+    /// Return all metrics in the Prometheus text exposition format. Can be called from any thread.
+    String GetPrometheusText() const;
+    /// Start serving the Prometheus text from http://127.0.0.1:port/metrics. Requires the network library. Return true if successful.
+    bool StartServer(unsigned short port);
+    /// Stop the export server.
+    void StopServer();
+
+    /// Return number of frames kept in the sample history.
+    /// @property
+    unsigned GetHistorySize() const { return historySize_; }
+    /// Return number of frames sampled into the history so far, up to the history size.
+    /// @property
+    unsigned GetNumSamples() const { return numSamples_; }
+    /// Return number of registered metrics.
+    /// @property
+    unsigned GetNumMetrics() const;
+    /// Return whether the export server is running.
+    /// @property
+    bool IsServerRunning() const { return server_ != nullptr; }
+    /// Return the export server port, or 0 if not running.
+    /// @property
+    unsigned short GetServerPort() const { return serverPort_; }
+
+private:
+    /// Register a metric or return the existing one. Log an error if it exists with another kind.
+    Metric* RegisterMetric(MetricType type, const String& subsystem, const String& name, const String& help, const String& labels);
+    /// Handle the end of frame to sample the metrics.
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+
+    /// Metrics in registration order.
+    Vector<SharedPtr<Metric> > metrics_;
+    /// Metrics by subsystem, name and labels.
+    HashMap<String, Metric*> metricsByKey_;
+    /// Mutex for the metric list, which is also read by the export server thread.
+    mutable Mutex metricsMutex_;
+    /// Export server.
+    mg_context* server_;
+    /// Number of frames kept in the sample history.
+    unsigned historySize_;
+    /// Ring buffer position of the next sample.
+    unsigned sampleIndex_;
+    /// Number of valid samples.
+    unsigned numSamples_;
+    /// Export server port.
+    unsigned short serverPort_;
+};
+
+}
@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/Mutex.h"
+#include "../Core/Profiler.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -35,17 +36,40 @@
 namespace Urho3D
 {
 
+#ifdef URHO3D_TRACY_PROFILING
+/// Shared source location announced for every engine mutex.
+static const tracy::SourceLocationData mutexSourceLocation{nullptr, "Mutex", __FILE__, __LINE__, 0};
+
+static void* CreateLockContext(const char* name)
+{
+    auto* context = new tracy::LockableCtx(&mutexSourceLocation);
+    if (name)
+        context->CustomName(name, strlen(name));
+    return context;
+}
+
+#define LOCK_CONTEXT static_cast<tracy::LockableCtx*>(lockContext_)
+#endif
+
 #ifdef _WIN32
 
-Mutex::Mutex() :
-    handle_(new CRITICAL_SECTION)
+Mutex::Mutex(const char* name) :
+    handle_(new CRITICAL_SECTION),
+    lockContext_(nullptr)
 {
     InitializeCriticalSection((CRITICAL_SECTION*)handle_);
+#ifdef URHO3D_TRACY_PROFILING
+    lockContext_ = CreateLockContext(name);
+#endif
 }
 
 Mutex::~Mutex()
 {
     CRITICAL_SECTION* cs = (CRITICAL_SECTION*)handle_;
+#ifdef URHO3D_TRACY_PROFILING
+    delete LOCK_CONTEXT;
+    lockContext_ = nullptr;
+#endif
     DeleteCriticalSection(cs);
     delete cs;
     handle_ = nullptr;
@@ -53,34 +77,59 @@ Mutex::~Mutex()
 
 void Mutex::Acquire()
 {
+#ifdef URHO3D_TRACY_PROFILING
+    const bool mark = LOCK_CONTEXT->BeforeLock();
     EnterCriticalSection((CRITICAL_SECTION*)handle_);
+    if (mark)
+        LOCK_CONTEXT->AfterLock();
+#else
+    EnterCriticalSection((CRITICAL_SECTION*)handle_);
+#endif
 }
 
 bool Mutex::TryAcquire()
 {
+#ifdef URHO3D_TRACY_PROFILING
+    const bool acquired = TryEnterCriticalSection((CRITICAL_SECTION*)handle_) != FALSE;
+    LOCK_CONTEXT->AfterTryLock(acquired);
+    return acquired;
+#else
     return TryEnterCriticalSection((CRITICAL_SECTION*)handle_) != FALSE;
+#endif
 }
 
 void Mutex::Release()
 {
     LeaveCriticalSection((CRITICAL_SECTION*)handle_);
+#ifdef URHO3D_TRACY_PROFILING
+    LOCK_CONTEXT->AfterUnlock();
+#endif
 }
 
 #else
 
-Mutex::Mutex() :
-    handle_(new pthread_mutex_t)
+Mutex::Mutex(const char* name) :
+    handle_(new pthread_mutex_t),
+    lockContext_(nullptr)
 {
     auto* mutex = (pthread_mutex_t*)handle_;
     pthread_mutexattr_t attr;
     pthread_mutexattr_init(&attr);
     pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
     pthread_mutex_init(mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+#ifdef URHO3D_TRACY_PROFILING
+    lockContext_ = CreateLockContext(name);
+#endif
 }
 
 Mutex::~Mutex()
 {
     auto* mutex = (pthread_mutex_t*)handle_;
+#ifdef URHO3D_TRACY_PROFILING
+    delete LOCK_CONTEXT;
+    lockContext_ = nullptr;
+#endif
     pthread_mutex_destroy(mutex);
     delete mutex;
     handle_ = nullptr;
@@ -88,17 +137,33 @@ Mutex::~Mutex()
 
 void Mutex::Acquire()
 {
+#ifdef URHO3D_TRACY_PROFILING
+    const bool mark = LOCK_CONTEXT->BeforeLock();
     pthread_mutex_lock((pthread_mutex_t*)handle_);
+    if (mark)
+        LOCK_CONTEXT->AfterLock();
+#else
+    pthread_mutex_lock((pthread_mutex_t*)handle_);
+#endif
 }
 
 bool Mutex::TryAcquire()
 {
+#ifdef URHO3D_TRACY_PROFILING
+    const bool acquired = pthread_mutex_trylock((pthread_mutex_t*)handle_) == 0;
+    LOCK_CONTEXT->AfterTryLock(acquired);
+    return acquired;
+#else
     return pthread_mutex_trylock((pthread_mutex_t*)handle_) == 0;
+#endif
 }
 
 void Mutex::Release()
 {
     pthread_mutex_unlock((pthread_mutex_t*)handle_);
+#ifdef URHO3D_TRACY_PROFILING
+    LOCK_CONTEXT->AfterUnlock();
+#endif
 }
 
 #endif
@@ -35,8 +35,8 @@ namespace Urho3D
 class URHO3D_API Mutex
 {
 public:
-    /// Construct.
-    Mutex();
+    /// Construct. The optional name is shown for the lock in the Tracy profiler and must outlive the mutex.
+    explicit Mutex(const char* name = nullptr);
     /// Destruct.
     ~Mutex();
 
@@ -50,6 +50,8 @@ public:
 private:
     /// Mutex handle.
     void* handle_;
+    /// Tracy lock context. Null when built without Tracy profiling.
+    void* lockContext_;
 };
 
 /// Lock that automatically acquires and releases a mutex.
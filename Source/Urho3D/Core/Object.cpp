@@ -22,6 +22,7 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/SmallVector.h"
 #include "../Core/Context.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/Thread.h"
@@ -74,6 +75,15 @@ bool TypeInfo::IsTypeOf(const TypeInfo* typeInfo) const
     return false;
 }
 
+/// Deliver an event to a receiver either with event data or with a typed payload.
+static inline void DeliverEvent(Object* receiver, Object* sender, StringHash eventType, VariantMap* eventData, TypedEventPayload* payload)
+{
+    if (payload)
+        receiver->OnTypedEvent(sender, eventType, *payload);
+    else
+        receiver->OnEvent(sender, eventType, *eventData);
+}
+
 Object::Object(Context* context) :
     context_(context),
     blockEvents_(false)
@@ -87,6 +97,17 @@ Object::~Object()
     context_->RemoveEventSender(this);
 }
 
+VariantMap& TypedEventPayload::GetEventData(Context* context)
+{
+    if (!eventData_)
+    {
+        eventData_ = &context->GetTypedEventDataMap();
+        convert_(data_, *eventData_);
+    }
+
+    return *eventData_;
+}
+
 void Object::OnEvent(Object* sender, StringHash eventType, VariantMap& eventData)
 {
     if (blockEvents_)
@@ -94,38 +115,27 @@ void Object::OnEvent(Object* sender, StringHash eventType, VariantMap& eventData
 
     // Make a copy of the context pointer in case the object is destroyed during event handler invocation
     Context* context = context_;
-    EventHandler* specific = nullptr;
-    EventHandler* nonSpecific = nullptr;
-
-    EventHandler* handler = eventHandlers_.First();
-    while (handler)
+    EventHandler* handler = FindReceiverEventHandler(sender, eventType);
+    if (handler)
     {
-        if (handler->GetEventType() == eventType)
-        {
-            if (!handler->GetSender())
-                nonSpecific = handler;
-            else if (handler->GetSender() == sender)
-            {
-                specific = handler;
-                break;
-            }
-        }
-        handler = eventHandlers_.Next(handler);
+        context->SetEventHandler(handler);
+        handler->Invoke(eventData);
+        context->SetEventHandler(nullptr);
     }
+}
 
-    // Specific event handlers have priority, so if found, invoke first
-    if (specific)
-    {
-        context->SetEventHandler(specific);
-        specific->Invoke(eventData);
-        context->SetEventHandler(nullptr);
+void Object::OnTypedEvent(Object* sender, StringHash eventType, TypedEventPayload& payload)
+{
+    if (blockEvents_)
         return;
-    }
 
-    if (nonSpecific)
+    Context* context = context_;
+    EventHandler* handler = FindReceiverEventHandler(sender, eventType);
+    if (handler)
     {
-        context->SetEventHandler(nonSpecific);
-        nonSpecific->Invoke(eventData);
+        context->SetEventHandler(handler);
+        if (!handler->InvokeTyped(payload))
+            handler->Invoke(payload.GetEventData(context));
         context->SetEventHandler(nullptr);
     }
 }
@@ -299,6 +309,16 @@ void Object::SendEvent(StringHash eventType)
 }
 
 void Object::SendEvent(StringHash eventType, VariantMap& eventData)
+{
+    SendEventInternal(eventType, &eventData, nullptr);
+}
+
+void Object::SendTypedEvent(StringHash eventType, TypedEventPayload& payload)
+{
+    SendEventInternal(eventType, nullptr, &payload);
+}
+
+void Object::SendEventInternal(StringHash eventType, VariantMap* eventData, TypedEventPayload* payload)
 {
     if (!Thread::IsMainThread())
     {
@@ -319,7 +339,8 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
     // Make a weak pointer to self to check for destruction during event handling
     WeakPtr<Object> self(this);
     Context* context = context_;
-    HashSet<Object*> processed;
+    // Specific receivers are usually few, so a linear search in inline storage beats hashing
+    SmallVector<Object*, 16> processed;
 
     context->BeginSendEvent(this, eventType);
 
@@ -338,7 +359,7 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
             if (!receiver)
                 continue;
 
-            receiver->OnEvent(this, eventType, eventData);
+            DeliverEvent(receiver, this, eventType, eventData, payload);
 
             // If self has been destroyed as a result of event handling, exit
             if (self.Expired())
@@ -348,7 +369,7 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
                 return;
             }
 
-            processed.Insert(receiver);
+            processed.Push(receiver);
         }
 
         group->EndSendEvent();
@@ -369,7 +390,7 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
                 if (!receiver)
                     continue;
 
-                receiver->OnEvent(this, eventType, eventData);
+                DeliverEvent(receiver, this, eventType, eventData, payload);
 
                 if (self.Expired())
                 {
@@ -389,7 +410,7 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
                 if (!receiver || processed.Contains(receiver))
                     continue;
 
-                receiver->OnEvent(this, eventType, eventData);
+                DeliverEvent(receiver, this, eventType, eventData, payload);
 
                 if (self.Expired())
                 {
@@ -454,6 +475,19 @@ bool Object::HasSubscribedToEvent(Object* sender, StringHash eventType) const
         return FindSpecificEventHandler(sender, eventType) != nullptr;
 }
 
+bool Object::HasEventReceivers(StringHash eventType) const
+{
+    if (blockEvents_)
+        return false;
+
+    EventReceiverGroup* group = context_->GetEventReceivers(const_cast<Object*>(this), eventType);
+    if (group && !group->receivers_.Empty())
+        return true;
+
+    group = context_->GetEventReceivers(eventType);
+    return group && !group->receivers_.Empty();
+}
+
 const String& Object::GetCategory() const
 {
     const HashMap<String, Vector<StringHash> >& objectCategories = context_->GetObjectCategories();
@@ -466,6 +500,26 @@ const String& Object::GetCategory() const
     return String::EMPTY;
 }
 
+EventHandler* Object::FindReceiverEventHandler(Object* sender, StringHash eventType) const
+{
+    EventHandler* nonSpecific = nullptr;
+
+    EventHandler* handler = eventHandlers_.First();
+    while (handler)
+    {
+        if (handler->GetEventType() == eventType)
+        {
+            if (!handler->GetSender())
+                nonSpecific = handler;
+            else if (handler->GetSender() == sender)
+                return handler;
+        }
+        handler = eventHandlers_.Next(handler);
+    }
+
+    return nonSpecific;
+}
+
 EventHandler* Object::FindEventHandler(StringHash eventType, EventHandler** previous) const
 {
     EventHandler* handler = eventHandlers_.First();
@@ -78,6 +78,54 @@ private:
         static const Urho3D::String& GetTypeNameStatic() { return GetTypeInfoStatic()->GetTypeName(); } \
         static const Urho3D::TypeInfo* GetTypeInfoStatic() { static const Urho3D::TypeInfo typeInfoStatic(#typeName, BaseClassName::GetTypeInfoStatic()); return &typeInfoStatic; }
 
+/// Return a unique identifier for a typed event payload struct. Within a shared library build each module may see a different identifier, in which case the payload is delivered through an event data map instead.
+template <class E> const void* GetTypedEventDataType()
+{
+    static const char id = 0;
+    return &id;
+}
+
+/// Convert a typed event payload struct to an event data map.
+template <class E> void ConvertTypedEventData(const void* data, VariantMap& eventData)
+{
+    static_cast<const E*>(data)->ToVariantMap(eventData);
+}
+
+/// Type-erased payload of a typed event, passed to the receivers while the event is sent. Receivers subscribed with event data map handlers get the payload converted on demand, once per send.
+/// @nobind
+class URHO3D_API TypedEventPayload
+{
+public:
+    /// Payload conversion function.
+    using ConvertFunctionPtr = void (*)(const void*, VariantMap&);
+
+    /// Construct with payload struct pointer, payload type identifier and conversion function.
+    TypedEventPayload(const void* data, const void* dataType, ConvertFunctionPtr convert) :
+        data_(data),
+        dataType_(dataType),
+        convert_(convert),
+        eventData_(nullptr)
+    {
+    }
+
+    /// Return payload struct pointer.
+    const void* GetData() const { return data_; }
+    /// Return payload type identifier.
+    const void* GetDataType() const { return dataType_; }
+    /// Return the payload converted to an event data map. Converted on first call into a map preallocated by the context.
+    VariantMap& GetEventData(Context* context);
+
+private:
+    /// Payload struct.
+    const void* data_;
+    /// Payload type identifier.
+    const void* dataType_;
+    /// Conversion function.
+    ConvertFunctionPtr convert_;
+    /// Converted event data, or null if not converted yet.
+    VariantMap* eventData_;
+};
+
 /// Base class for objects with type identification, subsystem access and event sending/receiving capability.
 /// @templateversion
 class URHO3D_API Object : public RefCounted
@@ -100,6 +148,8 @@ public:
     virtual const TypeInfo* GetTypeInfo() const = 0;
     /// Handle event.
     virtual void OnEvent(Object* sender, StringHash eventType, VariantMap& eventData);
+    /// Handle typed event. Handlers that do not accept the payload type are invoked with the payload converted to event data.
+    virtual void OnTypedEvent(Object* sender, StringHash eventType, TypedEventPayload& payload);
 
     /// Return type info static.
     static const TypeInfo* GetTypeInfoStatic() { return nullptr; }
@@ -138,6 +188,14 @@ public:
     void SendEvent(StringHash eventType, VariantMap& eventData);
     /// Return a preallocated map for event data. Used for optimization to avoid constant re-allocation of event data maps.
     VariantMap& GetEventDataMap() const;
+    /// Send typed event to all subscribers.
+    void SendTypedEvent(StringHash eventType, TypedEventPayload& payload);
+    /// Send event with a POD payload struct to all subscribers. Typed handlers of the struct receive it directly without building an event data map; the struct must provide ToVariantMap() for the other handlers, such as script event handlers.
+    template <class E> void SendTypedEvent(StringHash eventType, const E& data)
+    {
+        TypedEventPayload payload(&data, GetTypedEventDataType<E>(), &ConvertTypedEventData<E>);
+        SendTypedEvent(eventType, payload);
+    }
     /// Send event with variadic parameter pairs to all subscribers. The parameter pairs is a list of paramID and paramValue separated by comma, one pair after another.
     template <typename... Args> void SendEvent(StringHash eventType, Args... args)
     {
@@ -168,6 +226,8 @@ public:
 
     /// Return whether has subscribed to any event.
     bool HasEventHandlers() const { return !eventHandlers_.Empty(); }
+    /// Return whether an event sent by this object would currently reach any receiver. Used to skip building the data of costly events nobody listens to.
+    bool HasEventReceivers(StringHash eventType) const;
 
     /// Template version of returning a subsystem.
     template <class T> T* GetSubsystem() const;
@@ -185,6 +245,10 @@ protected:
     Context* context_;
 
 private:
+    /// Find the event handler to invoke for an event from a sender. A specific sender's handler has priority over a non-specific one.
+    EventHandler* FindReceiverEventHandler(Object* sender, StringHash eventType) const;
+    /// Send event either with event data or with a typed payload.
+    void SendEventInternal(StringHash eventType, VariantMap* eventData, TypedEventPayload* payload);
     /// Find the first event handler with no specific sender.
     EventHandler* FindEventHandler(StringHash eventType, EventHandler** previous = nullptr) const;
     /// Find the first event handler with specific sender.
@@ -275,6 +339,8 @@ public:
 
     /// Invoke event handler function.
     virtual void Invoke(VariantMap& eventData) = 0;
+    /// Invoke event handler function with a typed payload. Return false if the handler does not accept the payload type; it is then invoked with the payload converted to event data instead.
+    virtual bool InvokeTyped(const TypedEventPayload& payload) { return false; }
     /// Return a unique copy of the event handler.
     virtual EventHandler* Clone() const = 0;
 
@@ -334,6 +400,58 @@ private:
     HandlerFunctionPtr function_;
 };
 
+/// Template implementation of the event handler invoke helper for typed events (stores a function pointer of specific class that takes a payload struct). The payload struct must provide FromVariantMap() for receiving events sent with event data.
+template <class T, class E> class TypedEventHandlerImpl : public EventHandler
+{
+public:
+    using HandlerFunctionPtr = void (T::*)(StringHash, const E&);
+
+    /// Construct with receiver and function pointers and userdata.
+    TypedEventHandlerImpl(T* receiver, HandlerFunctionPtr function, void* userData = nullptr) :
+        EventHandler(receiver, userData),
+        function_(function)
+    {
+        assert(receiver_);
+        assert(function_);
+    }
+
+    /// Invoke event handler function with the payload struct built from event data.
+    void Invoke(VariantMap& eventData) override
+    {
+        E data;
+        data.FromVariantMap(eventData);
+        auto* receiver = static_cast<T*>(receiver_);
+        (receiver->*function_)(eventType_, data);
+    }
+
+    /// Invoke event handler function with a typed payload.
+    bool InvokeTyped(const TypedEventPayload& payload) override
+    {
+        if (payload.GetDataType() != GetTypedEventDataType<E>())
+            return false;
+
+        auto* receiver = static_cast<T*>(receiver_);
+        (receiver->*function_)(eventType_, *static_cast<const E*>(payload.GetData()));
+        return true;
+    }
+
+    /// Return a unique copy of the event handler.
+    EventHandler* Clone() const override
+    {
+        return new TypedEventHandlerImpl(static_cast<T*>(receiver_), function_, userData_);
+    }
+
+private:
+    /// Class-specific pointer to handler function.
+    HandlerFunctionPtr function_;
+};
+
+/// Construct a typed event handler, deducing the payload struct type from the handler function.
+template <class T, class E> EventHandler* MakeTypedEventHandler(T* receiver, void (T::*function)(StringHash, const E&), void* userData = nullptr)
+{
+    return new TypedEventHandlerImpl<T, E>(receiver, function, userData);
+}
+
 /// Template implementation of the event handler invoke helper (std::function instance).
 /// @nobind
 class EventHandler11Impl : public EventHandler
@@ -373,6 +491,8 @@ URHO3D_API StringHashRegister& GetEventNameRegister();
 #define URHO3D_PARAM(paramID, paramName) static const Urho3D::StringHash paramID(#paramName)
 /// Convenience macro to construct an EventHandler that points to a receiver object and its member function.
 #define URHO3D_HANDLER(className, function) (new Urho3D::EventHandlerImpl<className>(this, &className::function))
+/// Convenience macro to construct a typed EventHandler that points to a receiver object and its member function taking a payload struct.
+#define URHO3D_TYPED_HANDLER(className, function) (Urho3D::MakeTypedEventHandler<className>(this, &className::function))
 /// Convenience macro to construct an EventHandler that points to a receiver object and its member function, and also defines a userdata pointer.
 #define URHO3D_HANDLER_USERDATA(className, function, userData) (new Urho3D::EventHandlerImpl<className>(this, &className::function, userData))
 
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/ObjectPool.h"
+
+namespace Urho3D
+{
+
+/// Return size rounded up to keep pooled objects pointer-aligned.
+static unsigned AlignObjectSize(unsigned size)
+{
+    return (size + (unsigned)sizeof(void*) - 1) & ~((unsigned)sizeof(void*) - 1);
+}
+
+ObjectPool::ObjectPool(unsigned objectSize) :
+    allocator_(nullptr),
+    objectSize_(objectSize),
+    numAllocated_(0)
+{
+}
+
+ObjectPool::~ObjectPool()
+{
+    AllocatorUninitialize(allocator_);
+}
+
+void* ObjectPool::Allocate(size_t size)
+{
+    if (size != objectSize_)
+        return ::operator new(size);
+
+    MutexLock lock(mutex_);
+    if (!allocator_)
+        allocator_ = AllocatorInitialize(AlignObjectSize(objectSize_));
+    ++numAllocated_;
+    return AllocatorReserve(allocator_);
+}
+
+void ObjectPool::Free(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (size != objectSize_)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    MutexLock lock(mutex_);
+    AllocatorFree(allocator_, ptr);
+    --numAllocated_;
+}
+
+void ObjectPool::Reserve(unsigned count)
+{
+    MutexLock lock(mutex_);
+    if (!allocator_)
+    {
+        allocator_ = AllocatorInitialize(AlignObjectSize(objectSize_), count);
+        return;
+    }
+
+    unsigned numFree = allocator_->capacity_ - numAllocated_;
+    if (numFree < count)
+        AllocatorGrow(allocator_, count - numFree);
+}
+
+}
@@ -0,0 +1,94 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/Allocator.h"
+#include "../Core/Mutex.h"
+
+namespace Urho3D
+{
+
+/// Thread-safe fixed-size memory pool for the instances of one class. Allocations of any other size, such as those made for subclasses, fall back to the global allocator.
+class URHO3D_API ObjectPool
+{
+public:
+    /// Construct with object size.
+    explicit ObjectPool(unsigned objectSize);
+    /// Destruct. Frees all memory blocks; should only happen when no pooled objects remain.
+    ~ObjectPool();
+
+    /// Prevent copy construction.
+    ObjectPool(const ObjectPool& rhs) = delete;
+    /// Prevent assignment.
+    ObjectPool& operator =(const ObjectPool& rhs) = delete;
+
+    /// Allocate memory for an object.
+    void* Allocate(size_t size);
+    /// Free memory of an object. The size must be the same as used for allocation.
+    void Free(void* ptr, size_t size);
+    /// Ensure that at least the specified number of objects can be allocated without allocating new memory blocks.
+    void Reserve(unsigned count);
+
+    /// Return pooled object size.
+    unsigned GetObjectSize() const { return objectSize_; }
+    /// Return number of objects currently allocated from the pool.
+    unsigned GetNumAllocated() const { return numAllocated_; }
+    /// Return total number of objects the allocated memory blocks can hold.
+    unsigned GetCapacity() const { return allocator_ ? allocator_->capacity_ : 0; }
+
+private:
+    /// Fixed-size allocator.
+    AllocatorBlock* allocator_;
+    /// Mutex for thread-safe access.
+    Mutex mutex_;
+    /// Object size in bytes.
+    unsigned objectSize_;
+    /// Number of objects currently allocated.
+    unsigned numAllocated_;
+};
+
+}
+
+#if defined(_MSC_VER) && defined(_DEBUG)
+#define URHO3D_POOLED_OBJECT_DEBUG_NEW \
+        static void* operator new(size_t size, int, const char*, int) { return operator new(size); }
+#else
+#define URHO3D_POOLED_OBJECT_DEBUG_NEW
+#endif
+
+/// Declare that instances of a class are allocated from its object pool. Place in the class declaration and use URHO3D_IMPLEMENT_POOLED_OBJECT in the class's source file.
+#define URHO3D_POOLED_OBJECT(typeName) \
+    public: \
+        static void* operator new(size_t size) { return GetObjectPool().Allocate(size); } \
+        static void operator delete(void* ptr, size_t size) { GetObjectPool().Free(ptr, size); } \
+        URHO3D_POOLED_OBJECT_DEBUG_NEW \
+        static Urho3D::ObjectPool& GetObjectPool();
+
+/// Define the object pool of a class declared with URHO3D_POOLED_OBJECT. The pool is intentionally never destroyed, as pooled objects may outlive static destruction.
+#define URHO3D_IMPLEMENT_POOLED_OBJECT(typeName) \
+    Urho3D::ObjectPool& typeName::GetObjectPool() \
+    { \
+        static Urho3D::ObjectPool* pool = new Urho3D::ObjectPool((unsigned)sizeof(typeName)); \
+        return *pool; \
+    }
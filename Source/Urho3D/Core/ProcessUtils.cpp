@@ -44,6 +44,7 @@ extern "C" unsigned SDL_TVOS_GetActiveProcessorCount();
 #if defined(_WIN32)
 #include <windows.h>
 #include <io.h>
+#include <psapi.h>
 #if defined(_MSC_VER)
 #include <float.h>
 #include <Lmcons.h> // For UNLEN.
@@ -62,6 +63,9 @@ extern "C" unsigned SDL_TVOS_GetActiveProcessorCount();
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <sys/resource.h>
+#endif
 
 #if defined(__EMSCRIPTEN__) && defined(__EMSCRIPTEN_PTHREADS__)
 #include <emscripten/threading.h>
@@ -495,6 +499,72 @@ unsigned GetNumLogicalCPUs()
 #endif
 }
 
+unsigned long long GetPerformanceCPUMask()
+{
+    unsigned numLogical = Min(GetNumLogicalCPUs(), 64U);
+    unsigned long long allMask = numLogical < 64 ? (1ULL << numLogical) - 1 : ~0ULL;
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+    // On big.LITTLE and hybrid CPUs the performance cores have the highest maximum frequency
+    unsigned long long mask = 0;
+    unsigned maxFrequency = 0;
+    for (unsigned i = 0; i < numLogical; ++i)
+    {
+        char path[64];
+        sprintf(path, "/sys/devices/system/cpu/cpu%u/cpufreq/cpuinfo_max_freq", i);
+        FILE* fp = fopen(path, "r");
+        if (!fp)
+            continue; // Offline, or no frequency scaling information
+        unsigned frequency = 0;
+        int res = fscanf(fp, "%u", &frequency);                   // NOLINT(cert-err34-c)
+        fclose(fp);
+        if (res != 1)
+            continue;
+
+        if (frequency > maxFrequency)
+        {
+            maxFrequency = frequency;
+            mask = 0;
+        }
+        if (frequency == maxFrequency)
+            mask |= 1ULL << i;
+    }
+    return mask ? mask : allMask;
+#elif defined(_MSC_VER)
+    // The performance cores have the highest efficiency class. Processor groups beyond the first are not covered
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+    if (!length)
+        return allMask;
+
+    PODVector<unsigned char> buffer(length);
+    if (!GetLogicalProcessorInformationEx(RelationProcessorCore, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer.Buffer(), &length))
+        return allMask;
+
+    unsigned long long mask = 0;
+    BYTE maxClass = 0;
+    for (DWORD offset = 0; offset < length;)
+    {
+        auto* info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)&buffer[offset];
+        const PROCESSOR_RELATIONSHIP& core = info->Processor;
+        if (core.GroupMask[0].Group == 0)
+        {
+            if (core.EfficiencyClass > maxClass)
+            {
+                maxClass = core.EfficiencyClass;
+                mask = 0;
+            }
+            if (core.EfficiencyClass == maxClass)
+                mask |= (unsigned long long)core.GroupMask[0].Mask;
+        }
+        offset += info->Size;
+    }
+    return mask ? mask : allMask;
+#else
+    return allMask;
+#endif
+}
+
 void SetMiniDumpDir(const String& pathName)
 {
     miniDumpDir = AddTrailingSlash(pathName);
@@ -541,6 +611,27 @@ unsigned long long GetTotalMemory()
     return 0ull;
 }
 
+unsigned long long GetPeakMemoryUse()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+#elif !defined(__EMSCRIPTEN__)
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#ifdef __APPLE__
+        // Reported in bytes on Apple platforms and in kilobytes elsewhere
+        return (unsigned long long)usage.ru_maxrss;
+#else
+        return (unsigned long long)usage.ru_maxrss * 1024ull;
+#endif
+    }
+#endif
+    return 0ull;
+}
+
 String GetLoginName()
 {
 #if defined(__linux__) && !defined(__ANDROID__)
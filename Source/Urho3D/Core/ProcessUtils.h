@@ -67,12 +67,16 @@ URHO3D_API String GetPlatform();
 URHO3D_API unsigned GetNumPhysicalCPUs();
 /// Return the number of logical CPUs (different from physical if hyperthreading is used).
 URHO3D_API unsigned GetNumLogicalCPUs();
+/// Return a bit mask of the logical CPUs on the performance cores, or of all logical CPUs if the cores do not differ or can not be told apart. Heterogeneous cores are detected from the maximum clock frequencies on Linux and Android, and from the core efficiency classes on Windows. Covers at most the first 64 logical CPUs.
+URHO3D_API unsigned long long GetPerformanceCPUMask();
 /// Set minidump write location as an absolute path. If empty, uses default (UserProfile/AppData/Roaming/urho3D/crashdumps) Minidumps are only supported on MSVC compiler.
 URHO3D_API void SetMiniDumpDir(const String& pathName);
 /// Return minidump write location.
 URHO3D_API String GetMiniDumpDir();
 /// Return the total amount of usable memory in bytes.
 URHO3D_API unsigned long long GetTotalMemory();
+/// Return the peak physical memory use of the process in bytes, or 0 if not supported on the platform.
+URHO3D_API unsigned long long GetPeakMemoryUse();
 /// Return the name of the currently logged in user, or (?) if not identified.
 URHO3D_API String GetLoginName();
 /// Return the name of the running machine.
@@ -23,7 +23,10 @@
 #include "../Precompiled.h"
 
 #include "../Core/Profiler.h"
+#include "../IO/Log.h"
+#include "../IO/Serializer.h"
 
+#include <atomic>
 #include <cstdio>
 
 #include "../DebugNew.h"
@@ -31,19 +34,231 @@
 namespace Urho3D
 {
 
+/// Number of events in the ring buffer of a thread. Must be a power of two.
+static const unsigned THREAD_EVENTS_SIZE = 4096;
+/// Maximum length of a block name recorded by other threads, including the terminator.
+static const unsigned THREAD_EVENT_NAME_LENGTH = 32;
+/// Maximum number of captured trace events, after which the capture ends.
+static const unsigned MAX_TRACE_EVENTS = 1048576;
+
+/// Begin or end of a block recorded outside the main thread.
+struct ProfilerThreadEvent
+{
+    /// Time in microseconds since the profiler was created.
+    long long time_;
+    /// Block name, empty for the end of the innermost block.
+    char name_[THREAD_EVENT_NAME_LENGTH];
+};
+
+/// Recording state of a thread other than the main thread. The thread writes events into the ring buffer and the main
+/// thread reads them at the end of the frame, so neither side locks.
+struct ProfilerThread
+{
+    /// Construct with the thread index.
+    explicit ProfilerThread(unsigned index) :
+        index_(index),
+        head_(0),
+        tail_(0),
+        recordedDepth_(0),
+        droppedDepth_(0),
+        root_(nullptr, ("Thread " + String(index)).CString())
+    {
+        current_ = &root_;
+    }
+
+    /// Thread index in the trace.
+    unsigned index_;
+    /// Ring buffer of recorded events.
+    ProfilerThreadEvent events_[THREAD_EVENTS_SIZE];
+    /// Number of events written by the thread.
+    std::atomic<unsigned> head_;
+    /// Number of events read by the main thread.
+    std::atomic<unsigned> tail_;
+    /// Number of open blocks that have been recorded. Accessed only by the thread.
+    unsigned recordedDepth_;
+    /// Number of open blocks that were dropped because the ring buffer was full. Accessed only by the thread.
+    unsigned droppedDepth_;
+    /// Root of the profiling tree of the thread. Accessed only by the main thread.
+    ProfilerBlock root_;
+    /// Current block in the profiling tree. Accessed only by the main thread.
+    ProfilerBlock* current_;
+    /// Start times of the open blocks. Accessed only by the main thread.
+    PODVector<long long> beginTimes_;
+};
+
+/// Next profiler ID for validating the thread registrations.
+static std::atomic<unsigned> nextProfilerID(1);
+/// ID of the profiler the current thread is registered to.
+static thread_local unsigned threadProfilerID = 0;
+/// Recording state of the current thread.
+static thread_local ProfilerThread* threadState = nullptr;
+
+static void WriteEscapedName(String& dest, const char* name)
+{
+    for (const char* c = name; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            dest += '\\';
+        if ((unsigned char)*c >= 0x20)
+            dest += *c;
+    }
+}
+
 Profiler::Profiler(Context* context) :
     Object(context),
     current_(nullptr),
     root_(nullptr),
-    intervalFrames_(0)
+    gpuRoot_(nullptr),
+    intervalFrames_(0),
+    id_(nextProfilerID.fetch_add(1)),
+    tracing_(false)
 {
     current_ = root_ = new ProfilerBlock(nullptr, "RunFrame");
+    gpuRoot_ = new ProfilerBlock(nullptr, "GPU");
 }
 
 Profiler::~Profiler()
 {
     delete root_;
     root_ = nullptr;
+    delete gpuRoot_;
+    gpuRoot_ = nullptr;
+
+    MutexLock lock(threadsMutex_);
+    for (PODVector<ProfilerThread*>::Iterator i = threads_.Begin(); i != threads_.End(); ++i)
+        delete *i;
+    threads_.Clear();
+}
+
+void Profiler::BeginThreadBlock(const char* name)
+{
+    if (threadProfilerID != id_)
+    {
+        MutexLock lock(threadsMutex_);
+        threadState = new ProfilerThread(threads_.Size() + 1);
+        threads_.Push(threadState);
+        threadProfilerID = id_;
+    }
+
+    ProfilerThread* thread = threadState;
+    if (thread->droppedDepth_)
+    {
+        ++thread->droppedDepth_;
+        return;
+    }
+
+    // Reserve space for the end events of this block and all open blocks, so that every recorded block is closed
+    unsigned head = thread->head_.load(std::memory_order_relaxed);
+    unsigned tail = thread->tail_.load(std::memory_order_acquire);
+    if (head - tail + thread->recordedDepth_ + 2 > THREAD_EVENTS_SIZE)
+    {
+        ++thread->droppedDepth_;
+        return;
+    }
+
+    ProfilerThreadEvent& event = thread->events_[head & (THREAD_EVENTS_SIZE - 1)];
+    event.time_ = traceTimer_.GetUSec(false);
+    strncpy(event.name_, name, THREAD_EVENT_NAME_LENGTH - 1);
+    event.name_[THREAD_EVENT_NAME_LENGTH - 1] = 0;
+    ++thread->recordedDepth_;
+    thread->head_.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::EndThreadBlock()
+{
+    if (threadProfilerID != id_)
+        return;
+
+    ProfilerThread* thread = threadState;
+    if (thread->droppedDepth_)
+    {
+        --thread->droppedDepth_;
+        return;
+    }
+    if (!thread->recordedDepth_)
+        return;
+
+    unsigned head = thread->head_.load(std::memory_order_relaxed);
+    ProfilerThreadEvent& event = thread->events_[head & (THREAD_EVENTS_SIZE - 1)];
+    event.time_ = traceTimer_.GetUSec(false);
+    event.name_[0] = 0;
+    --thread->recordedDepth_;
+    thread->head_.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::MergeThreadBlocks()
+{
+    MutexLock lock(threadsMutex_);
+
+    for (PODVector<ProfilerThread*>::Iterator i = threads_.Begin(); i != threads_.End(); ++i)
+    {
+        ProfilerThread* thread = *i;
+        unsigned head = thread->head_.load(std::memory_order_acquire);
+        unsigned tail = thread->tail_.load(std::memory_order_relaxed);
+
+        for (; tail != head; ++tail)
+        {
+            const ProfilerThreadEvent& event = thread->events_[tail & (THREAD_EVENTS_SIZE - 1)];
+            if (event.name_[0])
+            {
+                thread->current_ = thread->current_->GetChild(event.name_);
+                thread->beginTimes_.Push(event.time_);
+            }
+            else if (!thread->beginTimes_.Empty())
+            {
+                long long start = thread->beginTimes_.Back();
+                long long duration = event.time_ - start;
+                thread->beginTimes_.Pop();
+
+                ProfilerBlock* block = thread->current_;
+                block->AddTime(duration);
+                if (tracing_)
+                    AddTraceEvent(block->name_, thread->index_, start, duration);
+                // The thread root accumulates the time spent in top-level blocks
+                if (block->parent_ == &thread->root_)
+                    thread->root_.AddTime(duration);
+                thread->current_ = block->parent_;
+            }
+        }
+
+        thread->tail_.store(head, std::memory_order_release);
+        thread->root_.EndFrame();
+    }
+}
+
+void Profiler::AddTraceEvent(const char* name, unsigned thread, long long start, long long duration)
+{
+    if (traceEvents_.Size() >= MAX_TRACE_EVENTS)
+    {
+        URHO3D_LOGWARNING("Profiler trace event limit reached, ending trace");
+        EndTrace();
+        return;
+    }
+
+    ProfilerTraceEvent event;
+    event.name_ = name;
+    event.thread_ = thread;
+    event.start_ = start;
+    event.duration_ = duration;
+    traceEvents_.Push(event);
+}
+
+void Profiler::AddGPUTime(const char* name, unsigned depth, long long time)
+{
+    if (!Thread::IsMainThread())
+        return;
+
+    ProfilerBlock* block;
+    if (!depth)
+        block = gpuRoot_;
+    else if (depth <= gpuStack_.Size())
+        block = gpuStack_[depth - 1]->GetChild(name);
+    else
+        return;
+
+    block->AddTime(time);
+    gpuStack_.Resize(depth);
+    gpuStack_.Push(block);
 }
 
 void Profiler::BeginFrame()
@@ -53,6 +268,7 @@ void Profiler::BeginFrame()
         EndFrame();
 
     root_->Begin();
+    BeginTraceBlock();
 }
 
 void Profiler::EndFrame()
@@ -60,15 +276,70 @@ void Profiler::EndFrame()
     EndBlock();
     ++intervalFrames_;
     root_->EndFrame();
+    gpuRoot_->EndFrame();
+    MergeThreadBlocks();
     current_ = root_;
+    traceStack_.Clear();
 }
 
 void Profiler::BeginInterval()
 {
     root_->BeginInterval();
+    gpuRoot_->BeginInterval();
+
+    MutexLock lock(threadsMutex_);
+    for (PODVector<ProfilerThread*>::Iterator i = threads_.Begin(); i != threads_.End(); ++i)
+        (*i)->root_.BeginInterval();
+
     intervalFrames_ = 0;
 }
 
+void Profiler::BeginTrace()
+{
+    traceEvents_.Clear();
+    traceStack_.Clear();
+
+    // The blocks already open are traced from this point on
+    long long time = traceTimer_.GetUSec(false);
+    for (ProfilerBlock* block = current_; block && block->count_; block = block->parent_)
+        traceStack_.Push(time);
+
+    tracing_ = true;
+}
+
+void Profiler::EndTrace()
+{
+    tracing_ = false;
+    traceStack_.Clear();
+}
+
+bool Profiler::SaveTrace(Serializer& dest) const
+{
+    String output = "{\"traceEvents\":[\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Main\"}}";
+
+    {
+        MutexLock lock(const_cast<Mutex&>(threadsMutex_));
+        for (PODVector<ProfilerThread*>::ConstIterator i = threads_.Begin(); i != threads_.End(); ++i)
+        {
+            output += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" + String((*i)->index_) +
+                ",\"args\":{\"name\":\"";
+            WriteEscapedName(output, (*i)->root_.name_);
+            output += "\"}}";
+        }
+    }
+
+    for (PODVector<ProfilerTraceEvent>::ConstIterator i = traceEvents_.Begin(); i != traceEvents_.End(); ++i)
+    {
+        output += ",\n{\"name\":\"";
+        WriteEscapedName(output, i->name_);
+        output += "\",\"ph\":\"X\",\"pid\":0,\"tid\":" + String(i->thread_) + ",\"ts\":" + String(i->start_) + ",\"dur\":" +
+            String(i->duration_) + "}";
+    }
+
+    output += "\n]}\n";
+    return dest.Write(output.CString(), output.Length()) == output.Length();
+}
+
 const String& Profiler::PrintData(bool showUnused, bool showTotal, unsigned maxDepth) const
 {
     static String output;
@@ -85,6 +356,15 @@ const String& Profiler::PrintData(bool showUnused, bool showTotal, unsigned maxD
         maxDepth = 1;
 
     PrintData(root_, output, 0, maxDepth, showUnused, showTotal);
+    if (gpuRoot_->totalCount_)
+        PrintData(gpuRoot_, output, 0, maxDepth, showUnused, showTotal);
+
+    MutexLock lock(const_cast<Mutex&>(threadsMutex_));
+    for (PODVector<ProfilerThread*>::ConstIterator i = threads_.Begin(); i != threads_.End(); ++i)
+    {
+        if ((*i)->root_.totalCount_)
+            PrintData(&(*i)->root_, output, 0, maxDepth, showUnused, showTotal);
+    }
 
     return output;
 }
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../Container/Str.h"
+#include "../Core/Mutex.h"
 #include "../Core/Thread.h"
 #include "../Core/Timer.h"
 
@@ -34,6 +35,9 @@
 namespace Urho3D
 {
 
+class Serializer;
+struct ProfilerThread;
+
 /// Profiling data for one block in the profiling tree.
 /// @nobind
 class URHO3D_API ProfilerBlock
@@ -92,6 +96,15 @@ public:
         time_ += time;
     }
 
+    /// Add an externally measured duration as one call.
+    void AddTime(long long time)
+    {
+        ++count_;
+        if (time > maxTime_)
+            maxTime_ = time;
+        time_ += time;
+    }
+
     /// End profiling frame and update interval and total values.
     void EndFrame()
     {
@@ -174,7 +187,21 @@ public:
     unsigned totalCount_;
 };
 
-/// Hierarchical performance profiler subsystem.
+/// Timed profiling block in a captured trace.
+/// @nobind
+struct ProfilerTraceEvent
+{
+    /// Block name. Points to the name of the block in the profiling tree.
+    const char* name_;
+    /// Thread index, 0 for the main thread.
+    unsigned thread_;
+    /// Start time in microseconds since the profiler was created.
+    long long start_;
+    /// Duration in microseconds.
+    long long duration_;
+};
+
+/// Hierarchical performance profiler subsystem. Blocks of other threads are recorded into per-thread ring buffers without locking and merged into separate trees at the end of the frame.
 class URHO3D_API Profiler : public Object
 {
     URHO3D_OBJECT(Profiler, Object);
@@ -188,31 +215,51 @@ public:
     /// Begin timing a profiling block.
     void BeginBlock(const char* name)
     {
-        // Profiler supports only the main thread currently
         if (!Thread::IsMainThread())
+        {
+            BeginThreadBlock(name);
             return;
+        }
 
         current_ = current_->GetChild(name);
         current_->Begin();
+        BeginTraceBlock();
     }
 
     /// End timing the current profiling block.
     void EndBlock()
     {
         if (!Thread::IsMainThread())
+        {
+            EndThreadBlock();
             return;
+        }
 
         current_->End();
+        EndTraceBlock(current_);
         if (current_->parent_)
             current_ = current_->parent_;
     }
 
+    /// Add a GPU block duration measured by the graphics subsystem. Blocks of depth 0 are accumulated to the GPU root block, deeper blocks to the children of the latest block one level up.
+    void AddGPUTime(const char* name, unsigned depth, long long time);
+
     /// Begin the profiling frame. Called by HandleBeginFrame().
     void BeginFrame();
     /// End the profiling frame. Called by HandleEndFrame().
     void EndFrame();
     /// Begin a new interval.
     void BeginInterval();
+    /// Begin capturing the timed blocks of all threads for trace export. Clears the previous capture.
+    void BeginTrace();
+    /// End capturing the trace.
+    void EndTrace();
+    /// Save the captured trace as Chrome trace event JSON, which can be opened in chrome://tracing or Perfetto. Return true if successful.
+    bool SaveTrace(Serializer& dest) const;
+    /// Return whether a trace is being captured.
+    bool IsTracing() const { return tracing_; }
+    /// Return the captured trace events. Blocks of other threads are added at the end of each frame.
+    const PODVector<ProfilerTraceEvent>& GetTraceEvents() const { return traceEvents_; }
 
     /// Return profiling data as text output. This method is not thread-safe.
     const String& PrintData(bool showUnused = false, bool showTotal = false, unsigned maxDepth = M_MAX_UNSIGNED) const;
@@ -221,16 +268,60 @@ public:
     /// Return the root profiling block.
     const ProfilerBlock* GetRootBlock() { return root_; }
 
+    /// Return the GPU root profiling block.
+    const ProfilerBlock* GetGPURootBlock() { return gpuRoot_; }
+
 protected:
     /// Return profiling data as text output for a specified profiling block.
     void PrintData(ProfilerBlock* block, String& output, unsigned depth, unsigned maxDepth, bool showUnused, bool showTotal) const;
+    /// Record the beginning of a block outside the main thread.
+    void BeginThreadBlock(const char* name);
+    /// Record the end of a block outside the main thread.
+    void EndThreadBlock();
+    /// Merge the blocks recorded by other threads into their profiling trees.
+    void MergeThreadBlocks();
+    /// Record the start time of a main thread block if capturing a trace.
+    void BeginTraceBlock()
+    {
+        if (tracing_)
+            traceStack_.Push(traceTimer_.GetUSec(false));
+    }
+    /// Add a finished main thread block to the trace if capturing.
+    void EndTraceBlock(ProfilerBlock* block)
+    {
+        if (tracing_ && !traceStack_.Empty())
+        {
+            AddTraceEvent(block->name_, 0, traceStack_.Back(), traceTimer_.GetUSec(false) - traceStack_.Back());
+            traceStack_.Pop();
+        }
+    }
+    /// Add a timed block to the trace.
+    void AddTraceEvent(const char* name, unsigned thread, long long start, long long duration);
 
     /// Current profiling block.
     ProfilerBlock* current_;
     /// Root profiling block.
     ProfilerBlock* root_;
+    /// GPU root profiling block.
+    ProfilerBlock* gpuRoot_;
+    /// Latest GPU blocks by depth.
+    PODVector<ProfilerBlock*> gpuStack_;
     /// Frames in the current interval.
     unsigned intervalFrames_;
+    /// Recording state of the threads other than the main thread.
+    PODVector<ProfilerThread*> threads_;
+    /// Mutex for registering threads.
+    Mutex threadsMutex_;
+    /// Unique ID for validating the thread registrations.
+    unsigned id_;
+    /// Timer for trace timestamps, started when the profiler is created. Read by all threads.
+    HiresTimer traceTimer_;
+    /// Captured trace events.
+    PODVector<ProfilerTraceEvent> traceEvents_;
+    /// Start times of the open main thread blocks while capturing.
+    PODVector<long long> traceStack_;
+    /// Trace capture flag.
+    bool tracing_;
 };
 
 /// Helper class for automatically beginning and ending a profiling block.
@@ -280,6 +371,13 @@ private:
     /// Macro for scoped profiling of a function.
     #define URHO3D_PROFILE_FUNCTION() ZoneScopedN(__FUNCTION__)
 
+    /// Macro for recording a memory allocation in a named pool. The pool name must be the same pointer when freeing.
+    #define URHO3D_PROFILE_ALLOC(ptr, size, pool) TracySecureAllocN(ptr, size, pool)
+    /// Macro for recording a memory free in a named pool.
+    #define URHO3D_PROFILE_FREE(ptr, pool) TracySecureFreeN(ptr, pool)
+    /// Macro for sending an RGBA image of the frame. Width and height must be divisible by 4.
+    #define URHO3D_PROFILE_FRAME_IMAGE(image, width, height, offset, flip) FrameImage(image, width, height, offset, flip)
+
     /// Color used for highlighting event.
     #define URHO3D_PROFILE_EVENT_COLOR tracy::Color::OrangeRed
     /// Color used for highlighting resource.
@@ -290,6 +388,9 @@ private:
     #define URHO3D_PROFILE_FRAME()
     #define URHO3D_PROFILE_THREAD(name)
     #define URHO3D_PROFILE_FUNCTION()
+    #define URHO3D_PROFILE_ALLOC(ptr, size, pool)
+    #define URHO3D_PROFILE_FREE(ptr, pool)
+    #define URHO3D_PROFILE_FRAME_IMAGE(image, width, height, offset, flip)
 
     #define URHO3D_PROFILE_EVENT_COLOR
     #define URHO3D_PROFILE_RESOURCE_COLOR
@@ -0,0 +1,175 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Container/Sort.h"
+#include "../Core/ScriptProfiler.h"
+
+#include <cstdio>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+static bool CompareSelfTime(const ScriptFunctionProfile* lhs, const ScriptFunctionProfile* rhs)
+{
+    return lhs->selfTime_ > rhs->selfTime_;
+}
+
+ScriptProfiler::ScriptProfiler(Profiler* profiler) :
+    profiler_(profiler)
+{
+}
+
+ScriptProfiler::~ScriptProfiler()
+{
+    EndCalls(0);
+}
+
+ScriptFunctionProfile* ScriptProfiler::GetFunction(const String& name)
+{
+    HashMap<String, ScriptFunctionProfile>::Iterator i = functions_.Find(name);
+    if (i == functions_.End())
+    {
+        i = functions_.Insert(MakePair(name, ScriptFunctionProfile()));
+        i->second_.name_ = name;
+    }
+
+    return &i->second_;
+}
+
+void ScriptProfiler::BeginCall(ScriptFunctionProfile* function, const void* key)
+{
+    Call call;
+    call.function_ = function;
+    call.key_ = key;
+    call.startTime_ = timer_.GetUSec(false);
+    call.childTime_ = 0;
+#ifdef URHO3D_TRACY_PROFILING
+    uint64_t srcloc = ___tracy_alloc_srcloc(0, "", 0, function->name_.CString(), function->name_.Length());
+    call.zone_ = ___tracy_emit_zone_begin_alloc(srcloc, 1);
+#else
+    if (profiler_)
+        profiler_->BeginBlock(function->name_.CString());
+#endif
+
+    ++function->openCalls_;
+    calls_.Push(call);
+}
+
+void ScriptProfiler::EndCall()
+{
+    if (calls_.Empty())
+        return;
+
+    const Call& call = calls_.Back();
+    long long time = timer_.GetUSec(false) - call.startTime_;
+    ScriptFunctionProfile* function = call.function_;
+
+    ++function->count_;
+    function->selfTime_ += time - call.childTime_;
+    // Count the total time of recursive calls only at the outermost level
+    if (!--function->openCalls_)
+        function->totalTime_ += time;
+
+#ifdef URHO3D_TRACY_PROFILING
+    ___tracy_emit_zone_end(call.zone_);
+#else
+    if (profiler_)
+        profiler_->EndBlock();
+#endif
+
+    calls_.Pop();
+    if (calls_.Size())
+        calls_.Back().childTime_ += time;
+}
+
+void ScriptProfiler::EndCalls(unsigned depth)
+{
+    while (calls_.Size() > depth)
+        EndCall();
+}
+
+void ScriptProfiler::Reset()
+{
+    EndCalls(0);
+
+    for (HashMap<String, ScriptFunctionProfile>::Iterator i = functions_.Begin(); i != functions_.End(); ++i)
+    {
+        i->second_.count_ = 0;
+        i->second_.totalTime_ = 0;
+        i->second_.selfTime_ = 0;
+    }
+}
+
+bool ScriptProfiler::IsOpen(const void* key) const
+{
+    for (PODVector<Call>::ConstIterator i = calls_.Begin(); i != calls_.End(); ++i)
+    {
+        if (i->key_ == key)
+            return true;
+    }
+
+    return false;
+}
+
+PODVector<const ScriptFunctionProfile*> ScriptProfiler::GetFunctions() const
+{
+    PODVector<const ScriptFunctionProfile*> ret;
+    for (HashMap<String, ScriptFunctionProfile>::ConstIterator i = functions_.Begin(); i != functions_.End(); ++i)
+    {
+        if (i->second_.count_)
+            ret.Push(&i->second_);
+    }
+
+    Sort(ret.Begin(), ret.End(), CompareSelfTime);
+    return ret;
+}
+
+String ScriptProfiler::PrintData(unsigned maxFunctions) const
+{
+    static const int LINE_MAX_LENGTH = 256;
+    static const int NAME_MAX_LENGTH = 40;
+
+    char line[LINE_MAX_LENGTH];
+    String output = "Function                                   Cnt      Self     Total       Avg\n\n";
+
+    PODVector<const ScriptFunctionProfile*> functions = GetFunctions();
+    for (unsigned i = 0; i < functions.Size() && i < maxFunctions; ++i)
+    {
+        const ScriptFunctionProfile* function = functions[i];
+        float self = function->selfTime_ / 1000.0f;
+        float total = function->totalTime_ / 1000.0f;
+        float avg = (float)function->totalTime_ / function->count_ / 1000.0f;
+
+        sprintf(line, "%-*.*s %7u %9.3f %9.3f %9.3f\n", NAME_MAX_LENGTH, NAME_MAX_LENGTH, function->name_.CString(),
+            Min(function->count_, 9999999U), self, total, avg);
+        output += String(line);
+    }
+
+    return output;
+}
+
+}
@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Container/HashMap.h"
+#include "../Container/Ptr.h"
+#include "../Core/Profiler.h"
+
+#ifdef URHO3D_TRACY_PROFILING
+#include "Tracy/TracyC.h"
+#endif
+
+namespace Urho3D
+{
+
+/// Aggregated timing of a profiled script function.
+/// @nobind
+struct URHO3D_API ScriptFunctionProfile
+{
+    /// Function name.
+    String name_;
+    /// Number of calls.
+    unsigned count_{};
+    /// Total time in microseconds, including the called functions. Recursive calls are counted once.
+    long long totalTime_{};
+    /// Self time in microseconds, excluding the called functions.
+    long long selfTime_{};
+    /// Number of currently open calls.
+    unsigned openCalls_{};
+};
+
+/// Instrumenting profiler for script functions, driven by the call hooks of a script runtime. Aggregates self and total time per function and forwards the calls as blocks to the Profiler subsystem and Tracy.
+/// @nobind
+class URHO3D_API ScriptProfiler
+{
+public:
+    /// Construct. Calls are forwarded as profiling blocks to the Profiler subsystem, if it exists.
+    explicit ScriptProfiler(Profiler* profiler);
+    /// Destruct. End the open calls.
+    ~ScriptProfiler();
+
+    /// Prevent copy construction.
+    ScriptProfiler(const ScriptProfiler& rhs) = delete;
+    /// Prevent assignment.
+    ScriptProfiler& operator =(const ScriptProfiler& rhs) = delete;
+
+    /// Return the profile of a function by name, creating it if necessary. Profiles live as long as the profiler, so the returned pointer can be cached.
+    ScriptFunctionProfile* GetFunction(const String& name);
+    /// Begin a call of a function. The key identifies the call to the runtime, e.g. its function object.
+    void BeginCall(ScriptFunctionProfile* function, const void* key);
+    /// End the latest open call.
+    void EndCall();
+    /// End open calls until the given number of them remains.
+    void EndCalls(unsigned depth);
+    /// End all open calls and clear the aggregated timings.
+    void Reset();
+
+    /// Return number of open calls.
+    unsigned GetDepth() const { return calls_.Size(); }
+    /// Return the key of the latest open call, or null if none.
+    const void* GetCurrentKey() const { return calls_.Size() ? calls_.Back().key_ : nullptr; }
+    /// Return whether a call with the given key is open.
+    bool IsOpen(const void* key) const;
+    /// Return the function profiles sorted by descending self time.
+    PODVector<const ScriptFunctionProfile*> GetFunctions() const;
+    /// Return the aggregated timings as text, sorted by descending self time.
+    String PrintData(unsigned maxFunctions = M_MAX_UNSIGNED) const;
+
+private:
+    /// Open function call.
+    struct Call
+    {
+        /// Called function.
+        ScriptFunctionProfile* function_;
+        /// Runtime key of the call.
+        const void* key_;
+        /// Start time in microseconds.
+        long long startTime_;
+        /// Time spent in the called functions in microseconds.
+        long long childTime_;
+#ifdef URHO3D_TRACY_PROFILING
+        /// Tracy zone of the call.
+        TracyCZoneCtx zone_;
+#endif
+    };
+
+    /// Profiler subsystem.
+    WeakPtr<Profiler> profiler_;
+    /// Timer for measuring the calls.
+    HiresTimer timer_;
+    /// Stack of open calls.
+    PODVector<Call> calls_;
+    /// Function profiles by name.
+    HashMap<String, ScriptFunctionProfile> functions_;
+};
+
+}
@@ -27,6 +27,7 @@
 #include "../IO/Log.h"
 
 #include <cstdio>
+#include <cstring>
 
 #include "../DebugNew.h"
 
@@ -105,4 +106,101 @@ const String& StringHashRegister::GetString(const StringHash& hash) const
     return iter == map_.End() ? String::EMPTY : iter->second_;
 }
 
+/// Number of entries searched for a hash before giving up.
+static const unsigned MAX_PROBES = 32;
+
+BoundedStringHashRegister::BoundedStringHashRegister(unsigned capacity) :
+    mask_(NextPowerOfTwo(Max(capacity, MAX_PROBES)) - 1),
+    shift_(32 - LogBaseTwo(mask_ + 1)),
+    numStrings_(0),
+    numDropped_(0)
+{
+    entries_ = new Entry[mask_ + 1];
+    for (unsigned i = 0; i <= mask_; ++i)
+    {
+        entries_[i].hash_.store(0, std::memory_order_relaxed);
+        entries_[i].ready_.store(false, std::memory_order_relaxed);
+    }
+}
+
+BoundedStringHashRegister::~BoundedStringHashRegister()
+{
+    delete[] entries_;
+}
+
+StringHash BoundedStringHashRegister::RegisterString(const StringHash& hash, const char* string)
+{
+    // The zero hash marks a free entry, and is only produced by the empty string in practice
+    unsigned value = hash.Value();
+    if (!value || !string)
+        return hash;
+
+    for (unsigned i = 0, index = HomeIndex(value); i < MAX_PROBES; ++i, index = (index + 1) & mask_)
+    {
+        Entry& entry = entries_[index];
+        unsigned existing = entry.hash_.load(std::memory_order_acquire);
+        if (!existing)
+        {
+            if (entry.hash_.compare_exchange_strong(existing, value, std::memory_order_acq_rel))
+            {
+                strncpy(entry.string_, string, MAX_STRING_LENGTH);
+                entry.string_[MAX_STRING_LENGTH] = 0;
+                entry.ready_.store(true, std::memory_order_release);
+                numStrings_.fetch_add(1, std::memory_order_relaxed);
+                return hash;
+            }
+            // Another thread claimed the entry, existing now holds its hash
+        }
+
+        if (existing == value)
+        {
+            // The string is compared only once written. A write in progress by another thread is not waited for
+            if (entry.ready_.load(std::memory_order_acquire))
+            {
+                char truncated[MAX_STRING_LENGTH + 1];
+                strncpy(truncated, string, MAX_STRING_LENGTH);
+                truncated[MAX_STRING_LENGTH] = 0;
+                if (String::Compare(truncated, entry.string_, false) != 0)
+                {
+                    URHO3D_LOGWARNING("StringHash collision detected! Both \"%s\" and \"%s\" have hash #%s",
+                        string, entry.string_, hash.ToString().CString());
+                }
+            }
+            return hash;
+        }
+    }
+
+    numDropped_.fetch_add(1, std::memory_order_relaxed);
+    return hash;
+}
+
+String BoundedStringHashRegister::GetStringCopy(const StringHash& hash) const
+{
+    const Entry* entry = FindEntry(hash.Value());
+    return entry ? String(entry->string_) : String::EMPTY;
+}
+
+bool BoundedStringHashRegister::Contains(const StringHash& hash) const
+{
+    return FindEntry(hash.Value()) != nullptr;
+}
+
+const BoundedStringHashRegister::Entry* BoundedStringHashRegister::FindEntry(unsigned hash) const
+{
+    if (!hash)
+        return nullptr;
+
+    for (unsigned i = 0, index = HomeIndex(hash); i < MAX_PROBES; ++i, index = (index + 1) & mask_)
+    {
+        const Entry& entry = entries_[index];
+        unsigned existing = entry.hash_.load(std::memory_order_acquire);
+        if (!existing)
+            return nullptr;
+        if (existing == hash)
+            return entry.ready_.load(std::memory_order_acquire) ? &entry : nullptr;
+    }
+
+    return nullptr;
+}
+
 }
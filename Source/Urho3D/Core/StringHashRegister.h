@@ -26,6 +26,8 @@
 #include "../Container/Ptr.h"
 #include "../Math/StringHash.h"
 
+#include <atomic>
+
 namespace Urho3D
 {
 
@@ -61,4 +63,65 @@ private:
     UniquePtr<Mutex> mutex_;
 };
 
+/// Fixed-capacity register used for StringHash reversing. Registering and reversing are lock-free and never allocate, so it is cheap enough to keep enabled in profiling builds. Strings are truncated to MAX_STRING_LENGTH characters, and once the probe sequence of a hash is full the string is dropped.
+/// @nobind
+class URHO3D_API BoundedStringHashRegister
+{
+public:
+    /// Maximum stored string length in characters.
+    static const unsigned MAX_STRING_LENGTH = 58;
+
+    /// Construct with the number of entries, which is rounded up to a power of two.
+    explicit BoundedStringHashRegister(unsigned capacity);
+    /// Destruct.
+    ~BoundedStringHashRegister();
+
+    /// Prevent copy construction.
+    BoundedStringHashRegister(const BoundedStringHashRegister& rhs) = delete;
+    /// Prevent assignment.
+    BoundedStringHashRegister& operator =(const BoundedStringHashRegister& rhs) = delete;
+
+    /// Register string for hash reverse mapping. Log a warning if a different string was registered with the same hash.
+    StringHash RegisterString(const StringHash& hash, const char* string);
+    /// Return string for given StringHash. Return empty string if not found.
+    String GetStringCopy(const StringHash& hash) const;
+    /// Return whether the string is contained in the register.
+    bool Contains(const StringHash& hash) const;
+
+    /// Return number of entries.
+    unsigned GetCapacity() const { return mask_ + 1; }
+    /// Return number of registered strings.
+    unsigned GetNumStrings() const { return numStrings_.load(std::memory_order_relaxed); }
+    /// Return number of strings that were dropped because the register was full.
+    unsigned GetNumDropped() const { return numDropped_.load(std::memory_order_relaxed); }
+
+private:
+    /// Register entry, one cache line on most platforms.
+    struct Entry
+    {
+        /// Hash, or zero if free. Claimed before the string is written.
+        std::atomic<unsigned> hash_;
+        /// Whether the string has been written.
+        std::atomic<bool> ready_;
+        /// Null-terminated string.
+        char string_[MAX_STRING_LENGTH + 1];
+    };
+
+    /// Return the first entry to probe for a hash. Multiplicative hashing spreads the similar low bits of similar strings.
+    unsigned HomeIndex(unsigned hash) const { return (hash * 2654435769u) >> shift_; }
+    /// Return the entry of a hash, or null if not found.
+    const Entry* FindEntry(unsigned hash) const;
+
+    /// Entries.
+    Entry* entries_;
+    /// Number of entries minus one.
+    unsigned mask_;
+    /// Shift for mapping a multiplied hash to an entry index.
+    unsigned shift_;
+    /// Number of registered strings.
+    std::atomic<unsigned> numStrings_;
+    /// Number of dropped strings.
+    std::atomic<unsigned> numDropped_;
+};
+
 }
@@ -23,12 +23,19 @@
 #include "../Precompiled.h"
 
 #include "../Core/Thread.h"
+#include "../Math/MathDefs.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #else
 #include <pthread.h>
 #endif
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "../DebugNew.h"
 
@@ -41,6 +48,7 @@ namespace Urho3D
 static DWORD WINAPI ThreadFunctionStatic(void* data)
 {
     Thread* thread = static_cast<Thread*>(data);
+    thread->ApplyStartParameters();
     thread->ThreadFunction();
     return 0;
 }
@@ -50,6 +58,7 @@ static DWORD WINAPI ThreadFunctionStatic(void* data)
 static void* ThreadFunctionStatic(void* data)
 {
     auto* thread = static_cast<Thread*>(data);
+    thread->ApplyStartParameters();
     thread->ThreadFunction();
     pthread_exit((void*)nullptr);
     return nullptr;
@@ -58,11 +67,42 @@ static void* ThreadFunctionStatic(void* data)
 #endif
 #endif // URHO3D_THREADING
 
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+/// Return the current thread's kernel thread ID.
+static int GetOSThreadID()
+{
+    return (int)syscall(SYS_gettid);
+}
+
+/// Set a thread's priority as a nice value, 0 for the current thread.
+static void SetOSThreadPriority(int osThreadID, int priority)
+{
+    // Each priority step is five nice levels, so the highest priority equals a nice value of -10
+    setpriority(PRIO_PROCESS, (id_t)osThreadID, -Clamp(priority, -2, 2) * 5);
+}
+
+/// Set a thread's CPU affinity, 0 for the current thread.
+static void SetOSThreadAffinity(int osThreadID, unsigned long long mask)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (unsigned i = 0; i < 64 && i < CPU_SETSIZE; ++i)
+    {
+        if (!mask || (mask & (1ULL << i)))
+            CPU_SET(i, &set);
+    }
+    sched_setaffinity((pid_t)osThreadID, sizeof set, &set);
+}
+#endif
+
 ThreadID Thread::mainThreadID;
 
 Thread::Thread() :
     handle_(nullptr),
-    shouldRun_(false)
+    shouldRun_(false),
+    priority_(0),
+    affinity_(0),
+    osThreadID_(0)
 {
 }
 
@@ -112,23 +152,74 @@ void Thread::Stop()
     delete thread;
 #endif
     handle_ = nullptr;
+    osThreadID_ = 0;
 #endif // URHO3D_THREADING
 }
 
 void Thread::SetPriority(int priority)
 {
+    priority_ = Clamp(priority, -2, 2);
+
 #ifdef URHO3D_THREADING
+    // If the thread has not started yet, it applies the priority itself
 #ifdef _WIN32
     if (handle_)
-        SetThreadPriority((HANDLE)handle_, priority);
-#elif defined(__linux__) && !defined(__ANDROID__) && !defined(__EMSCRIPTEN__)
-    auto* thread = (pthread_t*)handle_;
-    if (thread)
-        pthread_setschedprio(*thread, priority);
+        SetThreadPriority((HANDLE)handle_, priority_);
+#elif defined(__linux__) && !defined(__EMSCRIPTEN__)
+    int osThreadID = osThreadID_;
+    if (osThreadID)
+        SetOSThreadPriority(osThreadID, priority_);
+#endif
+#endif // URHO3D_THREADING
+}
+
+void Thread::SetAffinity(unsigned long long mask)
+{
+    affinity_ = mask;
+
+#ifdef URHO3D_THREADING
+#ifdef _WIN32
+    if (handle_)
+        SetThreadAffinityMask((HANDLE)handle_, mask ? (DWORD_PTR)mask : ~(DWORD_PTR)0);
+#elif defined(__linux__) && !defined(__EMSCRIPTEN__)
+    int osThreadID = osThreadID_;
+    if (osThreadID)
+        SetOSThreadAffinity(osThreadID, mask);
 #endif
 #endif // URHO3D_THREADING
 }
 
+void Thread::ApplyStartParameters()
+{
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+    // Publish the ID before reading the parameters, so that a concurrent change is applied either here or by the setter
+    osThreadID_ = GetOSThreadID();
+#endif
+
+    if (priority_)
+        SetCurrentThreadPriority(priority_);
+    if (affinity_)
+        SetCurrentThreadAffinity(affinity_);
+}
+
+void Thread::SetCurrentThreadPriority(int priority)
+{
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), Clamp(priority, -2, 2));
+#elif defined(__linux__) && !defined(__EMSCRIPTEN__)
+    SetOSThreadPriority(0, priority);
+#endif
+}
+
+void Thread::SetCurrentThreadAffinity(unsigned long long mask)
+{
+#ifdef _WIN32
+    SetThreadAffinityMask(GetCurrentThread(), mask ? (DWORD_PTR)mask : ~(DWORD_PTR)0);
+#elif defined(__linux__) && !defined(__EMSCRIPTEN__)
+    SetOSThreadAffinity(0, mask);
+#endif
+}
+
 void Thread::SetMainThread()
 {
     mainThreadID = GetCurrentThreadID();
@@ -28,6 +28,8 @@
 #include <Urho3D/Urho3D.h>
 #endif
 
+#include <atomic>
+
 #ifndef _WIN32
 #include <pthread.h>
 using ThreadID = pthread_t;
@@ -54,11 +56,17 @@ public:
     bool Run();
     /// Set the running flag to false and wait for the thread to finish.
     void Stop();
-    /// Set thread priority. The thread must have been started first.
+    /// Set thread priority from -2 (lowest) to 2 (highest), 0 being normal. If the thread is not started yet, it is applied when the thread starts. Raising the priority may require privileges on Linux.
     void SetPriority(int priority);
+    /// Set the logical CPUs the thread may run on as a bit mask, or 0 for no restriction. If the thread is not started yet, it is applied when the thread starts. Not supported on Apple platforms and Web.
+    void SetAffinity(unsigned long long mask);
 
     /// Return whether thread exists.
     bool IsStarted() const { return handle_ != nullptr; }
+    /// Return thread priority.
+    int GetPriority() const { return priority_; }
+    /// Return the logical CPUs the thread may run on as a bit mask, or 0 for no restriction.
+    unsigned long long GetAffinity() const { return affinity_; }
 
     /// Set the current thread as the main thread.
     static void SetMainThread();
@@ -67,12 +75,26 @@ public:
     static ThreadID GetCurrentThreadID();
     /// Return whether is executing in the main thread.
     static bool IsMainThread();
+    /// Set the current thread's priority from -2 (lowest) to 2 (highest), 0 being normal. Can be used for threads not created through this class.
+    static void SetCurrentThreadPriority(int priority);
+    /// Set the logical CPUs the current thread may run on as a bit mask, or 0 for no restriction.
+    static void SetCurrentThreadAffinity(unsigned long long mask);
+
+    /// Apply the priority and affinity when the thread starts. Called in the thread.
+    /// @nobind
+    void ApplyStartParameters();
 
 protected:
     /// Thread handle.
     void* handle_;
     /// Running flag.
     volatile bool shouldRun_;
+    /// Thread priority.
+    std::atomic<int> priority_;
+    /// Logical CPU mask, or 0 for no restriction.
+    std::atomic<unsigned long long> affinity_;
+    /// Operating system thread ID once the thread has started, used to change the priority and affinity on Linux. 0 when not started.
+    std::atomic<int> osThreadID_;
 
     /// Main thread's thread ID.
     static ThreadID mainThreadID;
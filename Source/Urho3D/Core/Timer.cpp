@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/CoreEvents.h"
+#include "../Core/Mutex.h"
 #include "../Core/Profiler.h"
 
 #include <ctime>
@@ -175,6 +176,10 @@ unsigned Time::GetTimeSinceEpoch()
 
 String Time::GetTimeStamp()
 {
+    // ctime() returns a static buffer, so serialize the calls from the main and the log writer threads
+    static Mutex timeStampMutex;
+    MutexLock lock(timeStampMutex);
+
     time_t sysTime;
     time(&sysTime);
     const char* dateTime = ctime(&sysTime);
@@ -115,7 +115,7 @@ public:
     static unsigned GetSystemTime();
     /// Get system time as seconds since 1.1.1970.
     static unsigned GetTimeSinceEpoch();
-    /// Get a date/time stamp as a string.
+    /// Get a date/time stamp as a string. Can be called from any thread.
     static String GetTimeStamp();
     /// Sleep for a number of milliseconds.
     static void Sleep(unsigned mSec);
@@ -22,6 +22,8 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/Allocator.h"
+#include "../Core/Mutex.h"
 #include "../Core/StringUtils.h"
 #include "../IO/VectorBuffer.h"
 
@@ -74,6 +76,40 @@ static const char* typeNames[] =
 
 static_assert(sizeof(typeNames) / sizeof(const char*) == (size_t)MAX_VAR_TYPES + 1, "Variant type name array is out-of-date");
 
+/// Pooled storage for the variant values that do not fit in VariantValue. Variants are also created and destroyed in worker threads, so access is serialized.
+template <class T> class VariantValuePool
+{
+public:
+    /// Reserve and default-construct a value.
+    static T* Reserve()
+    {
+        VariantValuePool& pool = Get();
+        MutexLock lock(pool.mutex_);
+        return pool.allocator_.Reserve();
+    }
+
+    /// Destruct and free a value.
+    static void Free(T* value)
+    {
+        VariantValuePool& pool = Get();
+        MutexLock lock(pool.mutex_);
+        pool.allocator_.Free(value);
+    }
+
+private:
+    /// Return the pool. It is never destroyed, as static variants may still free values during exit.
+    static VariantValuePool& Get()
+    {
+        static auto* pool = new VariantValuePool();
+        return *pool;
+    }
+
+    /// Fixed-size allocator.
+    Allocator<T> allocator_;
+    /// Allocator mutex.
+    Mutex mutex_;
+};
+
 Variant& Variant::operator =(const Variant& rhs)
 {
     // Handle custom types separately
@@ -97,7 +133,7 @@ Variant& Variant::operator =(const Variant& rhs)
         break;
 
     case VAR_RESOURCEREF:
-        value_.resourceRef_ = rhs.value_.resourceRef_;
+        *value_.resourceRef_ = *rhs.value_.resourceRef_;
         break;
 
     case VAR_RESOURCEREFLIST:
@@ -113,7 +149,7 @@ Variant& Variant::operator =(const Variant& rhs)
         break;
 
     case VAR_VARIANTMAP:
-        value_.variantMap_ = rhs.value_.variantMap_;
+        *value_.variantMap_ = *rhs.value_.variantMap_;
         break;
 
     case VAR_PTR:
@@ -192,7 +228,7 @@ bool Variant::operator ==(const Variant& rhs) const
         return value_.buffer_ == rhs.value_.buffer_;
 
     case VAR_RESOURCEREF:
-        return value_.resourceRef_ == rhs.value_.resourceRef_;
+        return *value_.resourceRef_ == *rhs.value_.resourceRef_;
 
     case VAR_RESOURCEREFLIST:
         return value_.resourceRefList_ == rhs.value_.resourceRefList_;
@@ -204,7 +240,7 @@ bool Variant::operator ==(const Variant& rhs) const
         return value_.stringVector_ == rhs.value_.stringVector_;
 
     case VAR_VARIANTMAP:
-        return value_.variantMap_ == rhs.value_.variantMap_;
+        return *value_.variantMap_ == *rhs.value_.variantMap_;
 
     case VAR_INTRECT:
         return value_.intRect_ == rhs.value_.intRect_;
@@ -327,8 +363,8 @@ void Variant::FromString(VariantType type, const char* value)
         if (values.Size() == 2)
         {
             SetType(VAR_RESOURCEREF);
-            value_.resourceRef_.type_ = values[0];
-            value_.resourceRef_.name_ = values[1];
+            value_.resourceRef_->type_ = values[0];
+            value_.resourceRef_->name_ = values[1];
         }
         break;
     }
@@ -562,7 +598,7 @@ bool Variant::IsZero() const
         return value_.voidPtr_ == nullptr;
 
     case VAR_RESOURCEREF:
-        return value_.resourceRef_.name_.Empty();
+        return value_.resourceRef_->name_.Empty();
 
     case VAR_RESOURCEREFLIST:
     {
@@ -582,7 +618,7 @@ bool Variant::IsZero() const
         return value_.stringVector_.Empty();
 
     case VAR_VARIANTMAP:
-        return value_.variantMap_.Empty();
+        return value_.variantMap_->Empty();
 
     case VAR_INTRECT:
         return value_.intRect_ == IntRect::ZERO;
@@ -636,7 +672,7 @@ void Variant::SetType(VariantType newType)
         break;
 
     case VAR_RESOURCEREF:
-        value_.resourceRef_.~ResourceRef();
+        VariantValuePool<ResourceRef>::Free(value_.resourceRef_);
         break;
 
     case VAR_RESOURCEREFLIST:
@@ -652,7 +688,7 @@ void Variant::SetType(VariantType newType)
         break;
 
     case VAR_VARIANTMAP:
-        value_.variantMap_.~VariantMap();
+        VariantValuePool<VariantMap>::Free(value_.variantMap_);
         break;
 
     case VAR_PTR:
@@ -660,15 +696,15 @@ void Variant::SetType(VariantType newType)
         break;
 
     case VAR_MATRIX3:
-        delete value_.matrix3_;
+        VariantValuePool<Matrix3>::Free(value_.matrix3_);
         break;
 
     case VAR_MATRIX3X4:
-        delete value_.matrix3x4_;
+        VariantValuePool<Matrix3x4>::Free(value_.matrix3x4_);
         break;
 
     case VAR_MATRIX4:
-        delete value_.matrix4_;
+        VariantValuePool<Matrix4>::Free(value_.matrix4_);
         break;
 
     case VAR_CUSTOM_HEAP:
@@ -696,7 +732,7 @@ void Variant::SetType(VariantType newType)
         break;
 
     case VAR_RESOURCEREF:
-        new(&value_.resourceRef_) ResourceRef();
+        value_.resourceRef_ = VariantValuePool<ResourceRef>::Reserve();
         break;
 
     case VAR_RESOURCEREFLIST:
@@ -712,7 +748,7 @@ void Variant::SetType(VariantType newType)
         break;
 
     case VAR_VARIANTMAP:
-        new(&value_.variantMap_) VariantMap();
+        value_.variantMap_ = VariantValuePool<VariantMap>::Reserve();
         break;
 
     case VAR_PTR:
@@ -720,15 +756,15 @@ void Variant::SetType(VariantType newType)
         break;
 
     case VAR_MATRIX3:
-        value_.matrix3_ = new Matrix3();
+        value_.matrix3_ = VariantValuePool<Matrix3>::Reserve();
         break;
 
     case VAR_MATRIX3X4:
-        value_.matrix3x4_ = new Matrix3x4();
+        value_.matrix3x4_ = VariantValuePool<Matrix3x4>::Reserve();
         break;
 
     case VAR_MATRIX4:
-        value_.matrix4_ = new Matrix4();
+        value_.matrix4_ = VariantValuePool<Matrix4>::Reserve();
         break;
 
     case VAR_CUSTOM_HEAP:
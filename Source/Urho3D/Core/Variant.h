@@ -32,6 +32,7 @@
 #include "../Math/Rect.h"
 #include "../Math/StringHash.h"
 
+#include <cstring>
 #include <typeinfo>
 
 namespace Urho3D
@@ -275,10 +276,10 @@ private:
 /// Make custom variant value.
 template <typename T> CustomVariantValueImpl<T> MakeCustomValue(const T& value) { return CustomVariantValueImpl<T>(value); }
 
-/// Size of variant value. 16 bytes on 32-bit platform, 32 bytes on 64-bit platform.
-static const unsigned VARIANT_VALUE_SIZE = sizeof(void*) * 4;
+/// Size of variant value. 16 bytes on 32-bit platform, 24 bytes on 64-bit platform, which fits a String. Variant maps, resource references and matrices are stored out of line.
+static const unsigned VARIANT_VALUE_SIZE = sizeof(void*) * 3 > 16 ? sizeof(void*) * 3 : 16;
 
-/// Union for the possible variant values. Objects exceeding the VARIANT_VALUE_SIZE are allocated on the heap.
+/// Union for the possible variant values. Objects exceeding the VARIANT_VALUE_SIZE are allocated out of line from pooled storage.
 union VariantValue
 {
     unsigned char storage_[VARIANT_VALUE_SIZE];
@@ -304,9 +305,9 @@ union VariantValue
     String string_;
     StringVector stringVector_;
     VariantVector variantVector_;
-    VariantMap variantMap_;
+    VariantMap* variantMap_;
     PODVector<unsigned char> buffer_;
-    ResourceRef resourceRef_;
+    ResourceRef* resourceRef_;
     ResourceRefList resourceRefList_;
     CustomVariantValue* customValueHeap_;
     CustomVariantValue customValueStack_;
@@ -551,10 +552,17 @@ public:
         *this = value;
     }
 
+    /// Move-construct from another variant. The other variant is left empty.
+    Variant(Variant&& value) noexcept
+    {
+        *this = std::move(value);
+    }
+
     /// Destruct.
     ~Variant()
     {
-        SetType(VAR_NONE);
+        if (type_ != VAR_NONE)
+            SetType(VAR_NONE);
     }
 
     /// Reset to empty.
@@ -566,6 +574,26 @@ public:
     /// Assign from another variant.
     Variant& operator =(const Variant& rhs);
 
+    /// Move-assign from another variant. The other variant is left empty.
+    Variant& operator =(Variant&& rhs) noexcept
+    {
+        // A custom value stored inline may not be relocatable, so copy it
+        if (rhs.type_ == VAR_CUSTOM_STACK)
+            return *this = static_cast<const Variant&>(rhs);
+
+        if (&rhs != this)
+        {
+            // All other types, including the pointers to out of line values, are relocated by copying the value bytes
+            if (type_ != VAR_NONE)
+                SetType(VAR_NONE);
+            memcpy(&value_, &rhs.value_, sizeof(VariantValue));     // NOLINT(bugprone-undefined-memory-manipulation)
+            type_ = rhs.type_;
+            rhs.type_ = VAR_NONE;
+        }
+
+        return *this;
+    }
+
     /// Assign from an integer.
     Variant& operator =(int rhs)
     {
@@ -709,7 +737,7 @@ public:
     Variant& operator =(const ResourceRef& rhs)
     {
         SetType(VAR_RESOURCEREF);
-        value_.resourceRef_ = rhs;
+        *value_.resourceRef_ = rhs;
         return *this;
     }
 
@@ -741,7 +769,7 @@ public:
     Variant& operator =(const VariantMap& rhs)
     {
         SetType(VAR_VARIANTMAP);
-        value_.variantMap_ = rhs;
+        *value_.variantMap_ = rhs;
         return *this;
     }
 
@@ -896,7 +924,7 @@ public:
     /// Test for equality with a resource reference. To return true, both the type and value must match.
     bool operator ==(const ResourceRef& rhs) const
     {
-        return type_ == VAR_RESOURCEREF ? value_.resourceRef_ == rhs : false;
+        return type_ == VAR_RESOURCEREF ? *value_.resourceRef_ == rhs : false;
     }
 
     /// Test for equality with a resource reference list. To return true, both the type and value must match.
@@ -920,7 +948,7 @@ public:
     /// Test for equality with a variant map. To return true, both the type and value must match.
     bool operator ==(const VariantMap& rhs) const
     {
-        return type_ == VAR_VARIANTMAP ? value_.variantMap_ == rhs : false;
+        return type_ == VAR_VARIANTMAP ? *value_.variantMap_ == rhs : false;
     }
 
     /// Test for equality with a rect. To return true, both the type and value must match.
@@ -1220,7 +1248,7 @@ public:
     /// Return a resource reference or empty on type mismatch.
     const ResourceRef& GetResourceRef() const
     {
-        return type_ == VAR_RESOURCEREF ? value_.resourceRef_ : emptyResourceRef;
+        return type_ == VAR_RESOURCEREF ? *value_.resourceRef_ : emptyResourceRef;
     }
 
     /// Return a resource reference list or empty on type mismatch.
@@ -1244,7 +1272,7 @@ public:
     /// Return a variant map or empty on type mismatch.
     const VariantMap& GetVariantMap() const
     {
-        return type_ == VAR_VARIANTMAP ? value_.variantMap_ : emptyVariantMap;
+        return type_ == VAR_VARIANTMAP ? *value_.variantMap_ : emptyVariantMap;
     }
 
     /// Return a rect or empty on type mismatch.
@@ -1362,7 +1390,7 @@ public:
     StringVector* GetStringVectorPtr() { return type_ == VAR_STRINGVECTOR ? &value_.stringVector_ : nullptr; }
 
     /// Return a pointer to a modifiable variant map or null on type mismatch.
-    VariantMap* GetVariantMapPtr() { return type_ == VAR_VARIANTMAP ? &value_.variantMap_ : nullptr; }
+    VariantMap* GetVariantMapPtr() { return type_ == VAR_VARIANTMAP ? value_.variantMap_ : nullptr; }
 
     /// Return a pointer to a modifiable custom variant value or null on type mismatch.
     template <class T> T* GetCustomPtr()
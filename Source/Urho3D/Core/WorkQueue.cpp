@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/CoreEvents.h"
+#include "../Core/Metrics.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/Profiler.h"
 #include "../Core/WorkQueue.h"
@@ -31,6 +32,84 @@
 namespace Urho3D
 {
 
+/// Number of ParallelFor() items per thread, so that threads finishing early can steal work from the others.
+static const unsigned PARALLEL_ITEMS_PER_THREAD = 4;
+
+/// Work item deque of one thread, sorted by ascending priority so that the highest priority item is taken from the back. Among items of equal priority the latest added is taken first. Guarded by a spin lock, as it is only held for a few instructions.
+class WorkDeque
+{
+public:
+    /// Add an item.
+    void Push(WorkItem* item)
+    {
+        Lock();
+        // Usually the items of a batch have the same priority and are appended without moving the others
+        unsigned index = items_.Size();
+        while (index && items_[index - 1]->priority_ > item->priority_)
+            --index;
+        items_.Insert(index, item);
+        UpdateTopPriority();
+        Unlock();
+    }
+
+    /// Take the highest priority item if it has at least the specified priority. Return null if none.
+    WorkItem* Pop(unsigned priority)
+    {
+        // Check the published top priority first to not lock deques that have nothing to take
+        if (topPriority_.load(std::memory_order_relaxed) < (long long)priority)
+            return nullptr;
+
+        WorkItem* item = nullptr;
+        Lock();
+        if (!items_.Empty() && items_.Back()->priority_ >= priority)
+        {
+            item = items_.Back();
+            items_.Pop();
+            UpdateTopPriority();
+        }
+        Unlock();
+        return item;
+    }
+
+    /// Remove an item. Return true if it was found.
+    bool Remove(WorkItem* item)
+    {
+        Lock();
+        bool removed = items_.Remove(item);
+        if (removed)
+            UpdateTopPriority();
+        Unlock();
+        return removed;
+    }
+
+    /// Return the priority of the highest priority item, or -1 if empty. May be out of date when read without the lock.
+    long long GetTopPriority() const { return topPriority_.load(std::memory_order_relaxed); }
+
+private:
+    /// Acquire the spin lock.
+    void Lock()
+    {
+        while (locked_.exchange(true, std::memory_order_acquire))
+        {
+            while (locked_.load(std::memory_order_relaxed))
+                ;
+        }
+    }
+
+    /// Release the spin lock.
+    void Unlock() { locked_.store(false, std::memory_order_release); }
+
+    /// Publish the priority of the highest priority item.
+    void UpdateTopPriority() { topPriority_.store(items_.Empty() ? -1 : (long long)items_.Back()->priority_, std::memory_order_relaxed); }
+
+    /// Items sorted by ascending priority.
+    PODVector<WorkItem*> items_;
+    /// Priority of the highest priority item, or -1 if empty.
+    std::atomic<long long> topPriority_{-1};
+    /// Spin lock flag.
+    std::atomic<bool> locked_{};
+};
+
 /// Worker thread managed by the work queue.
 class WorkerThread : public Thread, public RefCounted
 {
@@ -67,14 +146,29 @@ private:
 
 WorkQueue::WorkQueue(Context* context) :
     Object(context),
+    numQueued_(0),
+    nextDeque_(0),
     shutDown_(false),
     pausing_(false),
     paused_(false),
     completing_(false),
     tolerance_(10),
     lastSize_(0),
-    maxNonThreadedWorkMs_(5)
+    maxNonThreadedWorkMs_(5),
+    threadAffinity_(0),
+    pinThreads_(false),
+    threadPriority_(0)
 {
+    // The main thread's deque holds the work when there are no worker threads
+    deques_.Push(new WorkDeque());
+
+    auto* metrics = GetSubsystem<Metrics>();
+    if (metrics)
+    {
+        itemsMetric_ = metrics->GetCounter("WorkQueue", "items_total", "Work items executed.");
+        idleTimeMetric_ = metrics->GetCounter("WorkQueue", "idle_microseconds_total", "Time the worker threads spent waiting for work.");
+    }
+
     SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(WorkQueue, HandleBeginFrame));
 }
 
@@ -86,6 +180,9 @@ WorkQueue::~WorkQueue()
 
     for (unsigned i = 0; i < threads_.Size(); ++i)
         threads_[i]->Stop();
+
+    for (unsigned i = 0; i < deques_.Size(); ++i)
+        delete deques_[i];
 }
 
 void WorkQueue::CreateThreads(unsigned numThreads)
@@ -99,9 +196,14 @@ void WorkQueue::CreateThreads(unsigned numThreads)
     // Start threads in paused mode
     Pause();
 
+    // Create all deques before any thread can start stealing from them
+    for (unsigned i = 0; i < numThreads; ++i)
+        deques_.Push(new WorkDeque());
+
     for (unsigned i = 0; i < numThreads; ++i)
     {
         SharedPtr<WorkerThread> thread(new WorkerThread(this, i + 1));
+        ApplyThreadParameters(thread, i);
         thread->Run();
         threads_.Push(thread);
     }
@@ -110,12 +212,50 @@ void WorkQueue::CreateThreads(unsigned numThreads)
 #endif
 }
 
+void WorkQueue::SetThreadAffinity(unsigned long long mask, bool pin)
+{
+    threadAffinity_ = mask;
+    pinThreads_ = pin;
+
+    for (unsigned i = 0; i < threads_.Size(); ++i)
+        ApplyThreadParameters(threads_[i], i);
+}
+
+void WorkQueue::SetThreadPriority(int priority)
+{
+    threadPriority_ = Clamp(priority, -2, 2);
+
+    for (unsigned i = 0; i < threads_.Size(); ++i)
+        ApplyThreadParameters(threads_[i], i);
+}
+
+void WorkQueue::ApplyThreadParameters(WorkerThread* thread, unsigned index)
+{
+    unsigned long long affinity = threadAffinity_;
+    if (affinity && pinThreads_)
+    {
+        // Collect the CPUs of the mask, then pick one per thread starting from the second
+        PODVector<unsigned> cpus;
+        for (unsigned i = 0; i < 64; ++i)
+        {
+            if (affinity & (1ULL << i))
+                cpus.Push(i);
+        }
+        affinity = 1ULL << cpus[(index + 1) % cpus.Size()];
+    }
+
+    if (thread->GetAffinity() != affinity)
+        thread->SetAffinity(affinity);
+    if (thread->GetPriority() != threadPriority_)
+        thread->SetPriority(threadPriority_);
+}
+
 SharedPtr<WorkItem> WorkQueue::GetFreeItem()
 {
     if (poolItems_.Size() > 0)
     {
-        SharedPtr<WorkItem> item = poolItems_.Front();
-        poolItems_.PopFront();
+        SharedPtr<WorkItem> item = poolItems_.Back();
+        poolItems_.Pop();
         return item;
     }
     else
@@ -142,37 +282,112 @@ void WorkQueue::AddWorkItem(const SharedPtr<WorkItem>& item)
     // Clear completed flag in case item is reused
     workItems_.Push(item);
     item->completed_ = false;
+    item->finished_ = false;
+    item->hasDependents_ = false;
 
-    // Make sure worker threads' list is safe to modify
-    if (threads_.Size() && !paused_)
-        queueMutex_.Acquire();
+    // An item with dependencies is queued by the thread completing the last of them
+    if (--item->pendingDependencies_ == 0)
+    {
+        // Spread the items over the worker threads' deques, so that each thread mostly takes from its own
+        unsigned index = 0;
+        if (threads_.Size())
+        {
+            index = 1 + nextDeque_;
+            nextDeque_ = (nextDeque_ + 1) % threads_.Size();
+        }
+
+        QueueItem(item, index);
+    }
 
-    // Find position for new item
-    if (queue_.Empty())
-        queue_.Push(item);
+    Resume();
+}
+
+void WorkQueue::AddDependency(WorkItem* item, WorkItem* dependency)
+{
+    if (!item || !dependency || item == dependency)
+        return;
+
+    ++item->pendingDependencies_;
+
+    MutexLock lock(dependencyMutex_);
+    // The completing thread checks for dependents after setting the finished flag, so either it sees the dependent
+    // or the dependency is seen as finished here
+    dependency->hasDependents_ = true;
+    if (dependency->finished_)
+        --item->pendingDependencies_;
     else
+        dependency->dependents_.Push(item);
+}
+
+void WorkQueue::Wait(WorkItem* item)
+{
+    if (!item)
+        return;
+
+    Resume();
+
+    while (!item->completed_)
     {
-        bool inserted = false;
+        WorkItem* other = TakeItem(0, item->priority_);
+        if (other)
+            ExecuteItem(other, 0);
+        else if (threads_.Empty())
+            break;
+    }
+}
 
-        for (List<WorkItem*>::Iterator i = queue_.Begin(); i != queue_.End(); ++i)
-        {
-            if ((*i)->priority_ <= item->priority_)
-            {
-                queue_.Insert(i, item);
-                inserted = true;
-                break;
-            }
-        }
+void WorkQueue::ParallelFor(void* begin, unsigned count, unsigned elementSize, void (*workFunction)(const WorkItem*, unsigned),
+    void* aux, unsigned minElementsPerItem, unsigned priority)
+{
+    if (!count)
+        return;
+
+    auto* data = static_cast<unsigned char*>(begin);
+    unsigned maxItems = (threads_.Size() + 1) * PARALLEL_ITEMS_PER_THREAD;
+    unsigned numItems = Clamp(count / Max(minElementsPerItem, 1U), 1U, maxItems);
 
-        if (!inserted)
-            queue_.Push(item);
+    if (numItems == 1 || threads_.Empty())
+    {
+        // Not worth queueing, execute directly in the main thread
+        WorkItem item;
+        item.workFunction_ = workFunction;
+        item.start_ = data;
+        item.end_ = data + count * elementSize;
+        item.aux_ = aux;
+        item.priority_ = priority;
+        workFunction(&item, 0);
+        return;
     }
 
-    if (threads_.Size())
+    // Remember the items by position, as work functions executed in the main thread may call ParallelFor() recursively
+    unsigned first = parallelItems_.Size();
+    unsigned elementsPerItem = count / numItems;
+    unsigned remainder = count % numItems;
+    unsigned start = 0;
+
+    for (unsigned i = 0; i < numItems; ++i)
     {
-        queueMutex_.Release();
-        paused_ = false;
+        unsigned end = start + elementsPerItem + (i < remainder ? 1 : 0);
+
+        SharedPtr<WorkItem> item = GetFreeItem();
+        item->priority_ = priority;
+        item->workFunction_ = workFunction;
+        item->aux_ = aux;
+        item->start_ = data + start * elementSize;
+        item->end_ = data + end * elementSize;
+        AddWorkItem(item);
+        parallelItems_.Push(item);
+
+        start = end;
     }
+
+    for (unsigned i = first; i < parallelItems_.Size(); ++i)
+        Wait(parallelItems_[i]);
+    parallelItems_.Resize(first);
+
+    // If no work at all remaining, pause worker threads by leaving the mutex locked
+    if (!numQueued_)
+        Pause();
 }
 
 bool WorkQueue::RemoveWorkItem(SharedPtr<WorkItem> item)
@@ -180,18 +395,22 @@ bool WorkQueue::RemoveWorkItem(SharedPtr<WorkItem> item)
     if (!item)
         return false;
 
-    MutexLock lock(queueMutex_);
+    // Can only remove successfully if the item was not yet taken by threads for execution, and no other item waits for it
+    if (item->hasDependents_)
+        return false;
 
-    // Can only remove successfully if the item was not yet taken by threads for execution
-    List<WorkItem*>::Iterator i = queue_.Find(item.Get());
-    if (i != queue_.End())
+    for (unsigned i = 0; i < deques_.Size(); ++i)
     {
-        List<SharedPtr<WorkItem> >::Iterator j = workItems_.Find(item);
-        if (j != workItems_.End())
+        if (deques_[i]->Remove(item.Get()))
         {
-            queue_.Erase(i);
-            ReturnToPool(item);
-            workItems_.Erase(j);
+            --numQueued_;
+
+            Vector<SharedPtr<WorkItem> >::Iterator j = workItems_.Find(item);
+            if (j != workItems_.End())
+            {
+                ReturnToPool(item);
+                workItems_.Erase(j);
+            }
             return true;
         }
     }
@@ -201,23 +420,12 @@ bool WorkQueue::RemoveWorkItem(SharedPtr<WorkItem> item)
 
 unsigned WorkQueue::RemoveWorkItems(const Vector<SharedPtr<WorkItem> >& items)
 {
-    MutexLock lock(queueMutex_);
     unsigned removed = 0;
 
     for (Vector<SharedPtr<WorkItem> >::ConstIterator i = items.Begin(); i != items.End(); ++i)
     {
-        List<WorkItem*>::Iterator j = queue_.Find(i->Get());
-        if (j != queue_.End())
-        {
-            List<SharedPtr<WorkItem> >::Iterator k = workItems_.Find(*i);
-            if (k != workItems_.End())
-            {
-                queue_.Erase(j);
-                ReturnToPool(*k);
-                workItems_.Erase(k);
-                ++removed;
-            }
-        }
+        if (RemoveWorkItem(*i))
+            ++removed;
     }
 
     return removed;
@@ -229,7 +437,7 @@ void WorkQueue::Pause()
     {
         pausing_ = true;
 
-        queueMutex_.Acquire();
+        pauseMutex_.Acquire();
         paused_ = true;
 
         pausing_ = false;
@@ -240,7 +448,7 @@ void WorkQueue::Resume()
 {
     if (paused_)
     {
-        queueMutex_.Release();
+        pauseMutex_.Release();
         paused_ = false;
     }
 }
@@ -255,43 +463,26 @@ void WorkQueue::Complete(unsigned priority)
         Resume();
 
         // Take work items also in the main thread until queue empty or no high-priority items anymore
-        while (!queue_.Empty())
-        {
-            queueMutex_.Acquire();
-            if (!queue_.Empty() && queue_.Front()->priority_ >= priority)
-            {
-                WorkItem* item = queue_.Front();
-                queue_.PopFront();
-                queueMutex_.Release();
-                item->workFunction_(item, 0);
-                item->completed_ = true;
-            }
-            else
-            {
-                queueMutex_.Release();
-                break;
-            }
-        }
+        while (WorkItem* item = TakeItem(0, priority))
+            ExecuteItem(item, 0);
 
-        // Wait for threaded work to complete
+        // Wait for threaded work to complete. Keep executing items released by completed dependencies meanwhile
         while (!IsCompleted(priority))
         {
+            WorkItem* item = TakeItem(0, priority);
+            if (item)
+                ExecuteItem(item, 0);
         }
 
         // If no work at all remaining, pause worker threads by leaving the mutex locked
-        if (queue_.Empty())
+        if (!numQueued_)
             Pause();
     }
     else
     {
         // No worker threads: ensure all high-priority items are completed in the main thread
-        while (!queue_.Empty() && queue_.Front()->priority_ >= priority)
-        {
-            WorkItem* item = queue_.Front();
-            queue_.PopFront();
-            item->workFunction_(item, 0);
-            item->completed_ = true;
-        }
+        while (WorkItem* item = TakeItem(0, priority))
+            ExecuteItem(item, 0);
     }
 
     PurgeCompleted(priority);
@@ -300,7 +491,7 @@ void WorkQueue::Complete(unsigned priority)
 
 bool WorkQueue::IsCompleted(unsigned priority) const
 {
-    for (List<SharedPtr<WorkItem> >::ConstIterator i = workItems_.Begin(); i != workItems_.End(); ++i)
+    for (Vector<SharedPtr<WorkItem> >::ConstIterator i = workItems_.Begin(); i != workItems_.End(); ++i)
     {
         if ((*i)->priority_ >= priority && !(*i)->completed_)
             return false;
@@ -312,6 +503,7 @@ bool WorkQueue::IsCompleted(unsigned priority) const
 void WorkQueue::ProcessItems(unsigned threadIndex)
 {
     bool wasActive = false;
+    HiresTimer idleTimer;
 
     for (;;)
     {
@@ -322,52 +514,126 @@ void WorkQueue::ProcessItems(unsigned threadIndex)
             Time::Sleep(0);
         else
         {
-            queueMutex_.Acquire();
-            if (!queue_.Empty())
+            WorkItem* item = TakeItem(threadIndex, 0);
+            if (item)
             {
+                if (!wasActive && idleTimeMetric_)
+                    idleTimeMetric_->Increment(idleTimer.GetUSec(false));
                 wasActive = true;
 
-                WorkItem* item = queue_.Front();
-                queue_.PopFront();
-                queueMutex_.Release();
-                item->workFunction_(item, threadIndex);
-                item->completed_ = true;
+                ExecuteItem(item, threadIndex);
             }
             else
             {
+                if (wasActive)
+                    idleTimer.Reset();
                 wasActive = false;
 
-                queueMutex_.Release();
+                // Block here while paused
+                pauseMutex_.Acquire();
+                pauseMutex_.Release();
                 Time::Sleep(0);
             }
         }
     }
 }
 
+WorkItem* WorkQueue::TakeItem(unsigned threadIndex, unsigned priority)
+{
+    while (numQueued_)
+    {
+        // Find the deque with the highest priority item, preferring the thread's own
+        unsigned bestIndex = threadIndex;
+        long long bestPriority = deques_[threadIndex]->GetTopPriority();
+        for (unsigned i = 0; i < deques_.Size(); ++i)
+        {
+            long long topPriority = deques_[i]->GetTopPriority();
+            if (topPriority > bestPriority)
+            {
+                bestIndex = i;
+                bestPriority = topPriority;
+            }
+        }
+
+        if (bestPriority < (long long)priority)
+            return nullptr;
+
+        WorkItem* item = deques_[bestIndex]->Pop(priority);
+        if (item)
+        {
+            --numQueued_;
+            return item;
+        }
+
+        // Another thread took the item first, look again
+    }
+
+    return nullptr;
+}
+
+void WorkQueue::QueueItem(WorkItem* item, unsigned dequeIndex)
+{
+    ++numQueued_;
+    deques_[dequeIndex]->Push(item);
+}
+
+void WorkQueue::ExecuteItem(WorkItem* item, unsigned threadIndex)
+{
+    // Ready for the next use once executing, as all dependencies of this use have completed
+    item->pendingDependencies_ = 1;
+    item->workFunction_(item, threadIndex);
+    if (itemsMetric_)
+        itemsMetric_->Increment();
+
+    item->finished_ = true;
+    if (item->hasDependents_)
+    {
+        // Release the continuations to this thread, which has their input data in cache
+        MutexLock lock(dependencyMutex_);
+        for (unsigned i = 0; i < item->dependents_.Size(); ++i)
+        {
+            WorkItem* dependent = item->dependents_[i];
+            if (--dependent->pendingDependencies_ == 0)
+                QueueItem(dependent, threadIndex);
+        }
+        item->dependents_.Clear();
+    }
+
+    item->completed_ = true;
+}
+
 void WorkQueue::PurgeCompleted(unsigned priority)
 {
     // Purge completed work items and send completion events. Do not signal items lower than priority threshold,
     // as those may be user submitted and lead to eg. scene manipulation that could happen in the middle of the
     // render update, which is not allowed
-    for (List<SharedPtr<WorkItem> >::Iterator i = workItems_.Begin(); i != workItems_.End();)
+    unsigned dest = 0;
+    for (unsigned i = 0; i < workItems_.Size(); ++i)
     {
-        if ((*i)->completed_ && (*i)->priority_ >= priority)
+        WorkItem* item = workItems_[i];
+        if (item->completed_ && item->priority_ >= priority)
         {
-            if ((*i)->sendEvent_)
+            if (item->sendEvent_)
             {
                 using namespace WorkItemCompleted;
 
                 VariantMap& eventData = GetEventDataMap();
-                eventData[P_ITEM] = i->Get();
+                eventData[P_ITEM] = item;
                 SendEvent(E_WORKITEMCOMPLETED, eventData);
             }
 
-            ReturnToPool(*i);
-            i = workItems_.Erase(i);
+            ReturnToPool(workItems_[i]);
         }
         else
-            ++i;
+        {
+            // Compact the remaining items in place
+            if (dest != i)
+                workItems_[dest] = workItems_[i];
+            ++dest;
+        }
     }
+
+    workItems_.Resize(dest);
 }
 
 void WorkQueue::PurgePool()
@@ -376,8 +642,8 @@ void WorkQueue::PurgePool()
     int difference = lastSize_ - currentSize;
 
     // Difference tolerance, should be fairly significant to reduce the pool size.
-    for (unsigned i = 0; poolItems_.Size() > 0 && difference > tolerance_ && i < (unsigned)difference; i++)
-        poolItems_.PopFront();
+    if (difference > tolerance_)
+        poolItems_.Resize(poolItems_.Size() - Min((unsigned)difference, poolItems_.Size()));
 
     lastSize_ = currentSize;
 }
@@ -398,6 +664,8 @@ void WorkQueue::ReturnToPool(SharedPtr<WorkItem>& item)
         item->priority_ = M_MAX_UNSIGNED;
         item->sendEvent_ = false;
         item->completed_ = false;
+        item->pendingDependencies_ = 1;
+        item->dependents_.Clear();
 
         poolItems_.Push(item);
     }
@@ -406,18 +674,18 @@ void WorkQueue::ReturnToPool(SharedPtr<WorkItem>& item)
 void WorkQueue::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
 {
     // If no worker threads, complete low-priority work here
-    if (threads_.Empty() && !queue_.Empty())
+    if (threads_.Empty() && numQueued_)
     {
         URHO3D_PROFILE(CompleteWorkNonthreaded);
 
         HiresTimer timer;
 
-        while (!queue_.Empty() && timer.GetUSec(false) < maxNonThreadedWorkMs_ * 1000LL)
+        while (timer.GetUSec(false) < maxNonThreadedWorkMs_ * 1000LL)
         {
-            WorkItem* item = queue_.Front();
-            queue_.PopFront();
-            item->workFunction_(item, 0);
-            item->completed_ = true;
+            WorkItem* item = TakeItem(0, 0);
+            if (!item)
+                break;
+            ExecuteItem(item, 0);
         }
     }
 
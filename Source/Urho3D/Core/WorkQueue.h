@@ -22,7 +22,6 @@
 
 #pragma once
 
-#include "../Container/List.h"
 #include "../Core/Mutex.h"
 #include "../Core/Object.h"
 
@@ -37,6 +36,8 @@ URHO3D_EVENT(E_WORKITEMCOMPLETED, WorkItemCompleted)
     URHO3D_PARAM(P_ITEM, Item);                        // WorkItem ptr
 }
 
+class Metric;
+class WorkDeque;
 class WorkerThread;
 
 /// Work queue item.
@@ -62,10 +63,19 @@ public:
     std::atomic<bool> completed_{};
 
 private:
+    /// Pooled flag.
     bool pooled_{};
+    /// Number of dependencies not completed yet, plus one until the item has been added to the queue.
+    std::atomic<unsigned> pendingDependencies_{1};
+    /// Items waiting for this item to complete.
+    PODVector<WorkItem*> dependents_;
+    /// Work function returned flag. Set before the dependents are released.
+    std::atomic<bool> finished_{};
+    /// Whether dependents have been added.
+    std::atomic<bool> hasDependents_{};
 };
 
-/// Work queue subsystem for multithreading.
+/// Work queue subsystem for multithreading. Each thread has its own work item deque, from which the other threads steal when they run out of work.
 class URHO3D_API WorkQueue : public Object
 {
     URHO3D_OBJECT(WorkQueue, Object);
@@ -82,8 +92,24 @@ public:
     void CreateThreads(unsigned numThreads);
     /// Get pointer to an usable WorkItem from the item pool. Allocate one if no more free items.
     SharedPtr<WorkItem> GetFreeItem();
-    /// Add a work item and resume worker threads.
+    /// Add a work item and resume worker threads. The items are distributed to the worker threads' deques in turn.
     void AddWorkItem(const SharedPtr<WorkItem>& item);
+    /// Make a work item wait for another item to complete before it is executed, for example to continue on the results of the other item. The dependency must already have been added, but the item not yet. An item can have several dependencies. The dependency should have at least the item's priority, so that completing the item's priority also executes its dependencies.
+    /// @nobind
+    void AddDependency(WorkItem* item, WorkItem* dependency);
+    /// Wait for an added work item to complete, executing queued work of at least its priority in the main thread meanwhile. Unlike Complete(), work other than the item and its dependencies is not waited for.
+    /// @nobind
+    void Wait(WorkItem* item);
+    /// Execute a work function over a range of elements in the worker threads and the main thread, and return when all of it has been executed. Each work item's start and end point to its part of the range. The range is split into more items than there are threads, so that threads finishing early can steal the remaining items, but items have at least the minimum number of elements. Small ranges are executed directly in the main thread.
+    template <class T> void ParallelFor(T* begin, T* end, void (*workFunction)(const WorkItem*, unsigned), void* aux = nullptr,
+        unsigned minElementsPerItem = 1, unsigned priority = M_MAX_UNSIGNED)
+    {
+        ParallelFor(begin, (unsigned)(end - begin), sizeof(T), workFunction, aux, minElementsPerItem, priority);
+    }
+    /// Execute a work function over a range of elements of the specified size in the worker threads and the main thread.
+    /// @nobind
+    void ParallelFor(void* begin, unsigned count, unsigned elementSize, void (*workFunction)(const WorkItem*, unsigned), void* aux,
+        unsigned minElementsPerItem, unsigned priority);
     /// Remove a work item before it has started executing. Return true if successfully removed.
     bool RemoveWorkItem(SharedPtr<WorkItem> item);
     /// Remove a number of work items before they have started executing. Return the number of items successfully removed.
@@ -100,6 +126,10 @@ public:
 
     /// Set how many milliseconds maximum per frame to spend on low-priority work, when there are no worker threads.
     void SetNonThreadedWorkMs(int ms) { maxNonThreadedWorkMs_ = Max(ms, 1); }
+    /// Set the logical CPUs the worker threads may run on as a bit mask, or 0 for no restriction. When pinning, each thread runs only on one CPU of the mask in turn, skipping the first, which is left for the main thread. Applies also to threads created afterward.
+    void SetThreadAffinity(unsigned long long mask, bool pin = false);
+    /// Set worker thread priority from -2 (lowest) to 2 (highest), 0 being normal. Applies also to threads created afterward.
+    void SetThreadPriority(int priority);
 
     /// Return number of worker threads.
     unsigned GetNumThreads() const { return threads_.Size(); }
@@ -114,10 +144,24 @@ public:
 
     /// Return how many milliseconds maximum to spend on non-threaded low-priority work.
     int GetNonThreadedWorkMs() const { return maxNonThreadedWorkMs_; }
+    /// Return the logical CPU mask of the worker threads, or 0 for no restriction.
+    unsigned long long GetThreadAffinity() const { return threadAffinity_; }
+    /// Return whether worker threads are pinned to one CPU each.
+    bool GetThreadPinning() const { return pinThreads_; }
+    /// Return worker thread priority.
+    int GetThreadPriority() const { return threadPriority_; }
 
 private:
     /// Process work items until shut down. Called by the worker threads.
     void ProcessItems(unsigned threadIndex);
+    /// Apply the affinity and priority to a worker thread.
+    void ApplyThreadParameters(WorkerThread* thread, unsigned index);
+    /// Take the highest priority queued item with at least the specified priority, from the thread's own deque if it has the highest priority item, otherwise stealing from another deque. Return null if none.
+    WorkItem* TakeItem(unsigned threadIndex, unsigned priority);
+    /// Add an item whose dependencies have completed to a thread's deque.
+    void QueueItem(WorkItem* item, unsigned dequeIndex);
+    /// Execute an item, then release the items depending on it to the executing thread's deque.
+    void ExecuteItem(WorkItem* item, unsigned threadIndex);
     /// Purge completed work items which have at least the specified priority, and send completion events as necessary.
     void PurgeCompleted(unsigned priority);
     /// Purge the pool to reduce allocation where its unneeded.
@@ -129,19 +173,27 @@ private:
 
     /// Worker threads.
     Vector<SharedPtr<WorkerThread> > threads_;
-    /// Work item pool for reuse to cut down on allocation. The bool is a flag for item pooling and whether it is available or not.
-    List<SharedPtr<WorkItem> > poolItems_;
+    /// Work item pool for reuse to cut down on allocation.
+    Vector<SharedPtr<WorkItem> > poolItems_;
     /// Work item collection. Accessed only by the main thread.
-    List<SharedPtr<WorkItem> > workItems_;
-    /// Work item prioritized queue for worker threads. Pointers are guaranteed to be valid (point to workItems).
-    List<WorkItem*> queue_;
-    /// Worker queue mutex.
-    Mutex queueMutex_;
+    Vector<SharedPtr<WorkItem> > workItems_;
+    /// Prioritized work item deques, index 0 for the main thread followed by the worker threads. Pointers are guaranteed to be valid (point to workItems).
+    PODVector<WorkDeque*> deques_;
+    /// Number of items in the deques.
+    std::atomic<unsigned> numQueued_;
+    /// Deque to add the next item to.
+    unsigned nextDeque_;
+    /// Mutex kept locked while paused, to block idle worker threads.
+    Mutex pauseMutex_;
+    /// Mutex for the item dependents.
+    Mutex dependencyMutex_{"WorkQueue dependencies"};
+    /// Items of the ParallelFor() calls in progress.
+    PODVector<WorkItem*> parallelItems_;
     /// Shutting down flag.
     std::atomic<bool> shutDown_;
-    /// Pausing flag. Indicates the worker threads should not contend for the queue mutex.
+    /// Pausing flag. Indicates the worker threads should not contend for the pause mutex.
     std::atomic<bool> pausing_;
-    /// Paused flag. Indicates the queue mutex being locked to prevent worker threads using up CPU time.
+    /// Paused flag. Indicates the pause mutex being locked to prevent worker threads using up CPU time.
     bool paused_;
     /// Completing work in the main thread flag.
     bool completing_;
@@ -151,6 +203,16 @@ private:
     unsigned lastSize_;
     /// Maximum milliseconds per frame to spend on low-priority work, when there are no worker threads.
     int maxNonThreadedWorkMs_;
+    /// Worker thread logical CPU mask.
+    unsigned long long threadAffinity_;
+    /// Pin worker threads to one CPU each flag.
+    bool pinThreads_;
+    /// Worker thread priority.
+    int threadPriority_;
+    /// Executed work items metric.
+    SharedPtr<Metric> itemsMetric_;
+    /// Worker thread idle time metric in microseconds.
+    SharedPtr<Metric> idleTimeMetric_;
 };
 
 }
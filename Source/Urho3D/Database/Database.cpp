@@ -22,20 +22,118 @@
 
 #include "../Precompiled.h"
 
+#include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#include "../Core/Timer.h"
 #include "../Database/Database.h"
+#include "../Database/DatabaseEvents.h"
+#include "../IO/Log.h"
 
 namespace Urho3D
 {
 
+/// Asynchronous query.
+struct DbQuery
+{
+    /// Connection. Only referenced and released in the main thread.
+    SharedPtr<DbConnection> connection_;
+    /// SQL statement.
+    String sql_;
+    /// Query ID.
+    unsigned id_;
+    /// Result.
+    DbResult result_;
+};
+
+/// Worker thread executing asynchronous queries in queue order.
+class DbQueryThread : public RefCounted, public Thread
+{
+public:
+    /// Destruct. Delete the queries not delivered yet.
+    ~DbQueryThread() override
+    {
+        Stop();
+
+        for (List<DbQuery*>::Iterator i = queued_.Begin(); i != queued_.End(); ++i)
+            delete *i;
+        for (List<DbQuery*>::Iterator i = finished_.Begin(); i != finished_.End(); ++i)
+            delete *i;
+    }
+
+    /// Execute queued queries until stopped.
+    void ThreadFunction() override
+    {
+        while (shouldRun_)
+        {
+            DbQuery* query = nullptr;
+            {
+                MutexLock lock(queueMutex_);
+                if (!queued_.Empty())
+                    query = queued_.Front();
+            }
+
+            if (!query)
+            {
+                Time::Sleep(5);
+                continue;
+            }
+
+            Execute(query);
+        }
+    }
+
+    /// Queue a query.
+    void Queue(DbQuery* query)
+    {
+        MutexLock lock(queueMutex_);
+        queued_.Push(query);
+    }
+
+    /// Execute the front query and move it to the finished queries.
+    void Execute(DbQuery* query)
+    {
+        {
+            MutexLock lock(query->connection_->executeMutex_);
+            query->result_ = query->connection_->ExecuteStatement(query->sql_, false, true);
+        }
+
+        MutexLock lock(queueMutex_);
+        queued_.PopFront();
+        finished_.Push(query);
+    }
+
+    /// Take the finished queries.
+    void TakeFinished(List<DbQuery*>& dest)
+    {
+        MutexLock lock(queueMutex_);
+        Swap(dest, finished_);
+    }
+
+private:
+    /// Queued queries. The front query stays queued while being executed.
+    List<DbQuery*> queued_;
+    /// Finished queries waiting to be delivered in the main thread.
+    List<DbQuery*> finished_;
+    /// Mutex for the queues.
+    Mutex queueMutex_;
+};
+
 Database::Database(Context* context) :
     Object(context),
 #ifdef ODBC_3_OR_LATER
-    poolSize_(0)
+    poolSize_(0),
 #else
-    poolSize_(M_MAX_UNSIGNED)
+    poolSize_(M_MAX_UNSIGNED),
 #endif
+    nextQueryID_(1)
+{
+}
+
+Database::~Database()
 {
+    // Stop the worker before the connections it may be using are released
+    queryThread_.Reset();
 }
 
 DBAPI Database::GetAPI()
@@ -96,4 +194,54 @@ void Database::Disconnect(DbConnection* connection)
     }
 }
 
+unsigned Database::QueueQuery(DbConnection* connection, const String& sql)
+{
+    if (!connection)
+        return 0;
+
+    auto* query = new DbQuery();
+    query->connection_ = connection;
+    query->sql_ = sql;
+    query->id_ = nextQueryID_++;
+    if (!nextQueryID_)
+        nextQueryID_ = 1;
+
+    if (!queryThread_)
+    {
+        queryThread_ = new DbQueryThread();
+        if (!queryThread_->Run())
+            URHO3D_LOGWARNING("Could not start database worker thread, executing asynchronous queries in the main thread");
+        SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(Database, HandleBeginFrame));
+    }
+
+    queryThread_->Queue(query);
+    // Without the worker thread execute right away, but still deliver the result on the next frame
+    if (!queryThread_->IsStarted())
+        queryThread_->Execute(query);
+
+    return query->id_;
+}
+
+void Database::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
+{
+    List<DbQuery*> finished;
+    queryThread_->TakeFinished(finished);
+
+    for (List<DbQuery*>::Iterator i = finished.Begin(); i != finished.End(); ++i)
+    {
+        DbQuery* query = *i;
+
+        using namespace DbQueryFinished;
+
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_DBCONNECTION] = query->connection_.Get();
+        eventData[P_QUERYID] = query->id_;
+        eventData[P_SQL] = query->sql_;
+        eventData[P_RESULT] = &query->result_;
+        query->connection_->SendEvent(E_DBQUERYFINISHED, eventData);
+
+        delete query;
+    }
+}
+
 }
@@ -38,6 +38,7 @@ enum DBAPI
 };
 
 class DbConnection;
+class DbQueryThread;
 
 /// %Database subsystem. Manage database connections.
 class URHO3D_API Database : public Object
@@ -47,6 +48,8 @@ class URHO3D_API Database : public Object
 public:
     /// Construct.
     explicit Database(Context* context);
+    /// Destruct. Wait for the query being executed to finish and discard the other queued queries.
+    ~Database() override;
     /// Return the underlying database API.
     static DBAPI GetAPI();
 
@@ -54,6 +57,9 @@ public:
     DbConnection* Connect(const String& connectionString);
     /// Disconnect a database connection. The connection object pointer should not be used anymore after this.
     void Disconnect(DbConnection* connection);
+    /// Queue an SQL statement to be executed on a connection in the database worker thread. Return the query ID. Called by DbConnection::ExecuteAsync().
+    /// @nobind
+    unsigned QueueQuery(DbConnection* connection, const String& sql);
 
     /// Return true when using internal database connection pool. The internal database pool is managed by the Database subsystem itself and should not be confused with ODBC connection pool option when ODBC is being used.
     /// @property
@@ -68,12 +74,19 @@ public:
     void SetPoolSize(unsigned poolSize) { poolSize_ = poolSize; }
 
 private:
+    /// Handle begin frame event. Send the finished events of asynchronous queries.
+    void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+
     /// %Database connection pool size. Default to 0 when using ODBC 3.0 or later as ODBC 3.0 driver manager could manage its own database connection pool.
     unsigned poolSize_;
     /// Active database connections.
     Vector<SharedPtr<DbConnection> > connections_;
     ///%Database connections pool.
     HashMap<String, Vector<SharedPtr<DbConnection> > > connectionsPool_;
+    /// Worker thread for asynchronous queries. Started on the first asynchronous query.
+    SharedPtr<DbQueryThread> queryThread_;
+    /// Next asynchronous query ID.
+    unsigned nextQueryID_;
 };
 
 }
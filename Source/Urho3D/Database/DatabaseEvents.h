@@ -41,4 +41,13 @@ URHO3D_EVENT(E_DBCURSOR, DbCursor)
     URHO3D_PARAM(P_ABORT, Abort);                  // bool [in]
 }
 
+/// Asynchronous query finished. Sent by the connection in the main thread.
+URHO3D_EVENT(E_DBQUERYFINISHED, DbQueryFinished)
+{
+    URHO3D_PARAM(P_DBCONNECTION, DbConnection);    // DbConnection pointer
+    URHO3D_PARAM(P_QUERYID, QueryID);              // unsigned
+    URHO3D_PARAM(P_SQL, SQL);                      // String
+    URHO3D_PARAM(P_RESULT, Result);                // DbResult pointer, valid during the event (cannot be used in scripting)
+}
+
 }
@@ -22,6 +22,7 @@
 
 #include "../../Precompiled.h"
 
+#include "../../Database/Database.h"
 #include "../../Database/DatabaseEvents.h"
 #include "../../IO/Log.h"
 
@@ -71,6 +72,24 @@ void DbConnection::Finalize()
 }
 
 DbResult DbConnection::Execute(const String& sql, bool useCursorEvent)
+{
+    MutexLock lock(executeMutex_);
+    return ExecuteStatement(sql, useCursorEvent, false);
+}
+
+unsigned DbConnection::ExecuteAsync(const String& sql)
+{
+    auto* database = GetSubsystem<Database>();
+    if (!database)
+    {
+        URHO3D_LOGERROR("Could not execute asynchronously: no database subsystem");
+        return 0;
+    }
+
+    return database->QueueQuery(this, sql);
+}
+
+DbResult DbConnection::ExecuteStatement(const String& sql, bool useCursorEvent, bool columnar)
 {
     DbResult result;
 
@@ -83,6 +102,9 @@ DbResult DbConnection::Execute(const String& sql, bool useCursorEvent)
             result.columns_.Resize(numCols);
             for (unsigned i = 0; i < numCols; ++i)
                 result.columns_[i] = result.resultImpl_.column_name((short)i).c_str();
+            result.columnar_ = columnar;
+            if (columnar)
+                result.columnValues_.Resize(numCols);
 
             bool filtered = false;
             bool aborted = false;
@@ -140,7 +162,16 @@ DbResult DbConnection::Execute(const String& sql, bool useCursorEvent)
                 }
 
                 if (!filtered)
-                    result.rows_.Push(colValues);
+                {
+                    if (columnar)
+                    {
+                        for (unsigned i = 0; i < numCols; ++i)
+                            result.columnValues_[i].Push(colValues[i]);
+                        ++result.numColumnarRows_;
+                    }
+                    else
+                        result.rows_.Push(colValues);
+                }
                 if (aborted)
                     break;
             }
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../../Core/Mutex.h"
 #include "../../Core/Object.h"
 #include "../../Database/DbResult.h"
 
@@ -35,6 +36,8 @@ class URHO3D_API DbConnection : public Object
 {
     URHO3D_OBJECT(DbConnection, Object);
 
+    friend class DbQueryThread;
+
 public:
     /// Construct.
     DbConnection(Context* context, const String& connectionString);
@@ -45,6 +48,8 @@ public:
 
     /// Execute an SQL statements immediately. Send E_DBCURSOR event for each row in the resultset when useCursorEvent parameter is set to true.
     DbResult Execute(const String& sql, bool useCursorEvent = false);
+    /// Execute an SQL statement in the database worker thread. The rows are fetched into a columnar result, which is delivered in the main thread with the E_DBQUERYFINISHED event. Cursor events are not sent. Return the query ID, or 0 if failed.
+    unsigned ExecuteAsync(const String& sql);
 
     /// Return database connection string. The connection string for SQLite3 is using the URI format described in https://www.sqlite.org/uri.html, while the connection string for ODBC is using DSN format as per ODBC standard.
     const String& GetConnectionString() const { return connectionString_; }
@@ -56,11 +61,16 @@ public:
     bool IsConnected() const { return connectionImpl_.connected(); }
 
 private:
+    /// Execute an SQL statement. Called with the execution mutex locked, from either the main thread or the database worker thread.
+    DbResult ExecuteStatement(const String& sql, bool useCursorEvent, bool columnar);
+
     /// Internal helper method to handle runtime exception by logging it to stderr stream.
     void HandleRuntimeError(const char* message, const char* cause);
 
     /// The connection string for SQLite3 is using the URI format described in https://www.sqlite.org/uri.html, while the connection string for ODBC is using DSN format as per ODBC standard.
     String connectionString_;
+    /// Mutex for executing statements from the main thread and the database worker thread.
+    Mutex executeMutex_;
     /// The underlying implementation connection object.
     nanodbc::connection connectionImpl_;
 };
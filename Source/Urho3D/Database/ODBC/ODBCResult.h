@@ -37,7 +37,9 @@ class URHO3D_API DbResult
 public:
     /// Default constructor constructs an empty result object.
     DbResult() :
-        numAffectedRows_(-1)
+        numAffectedRows_(-1),
+        numColumnarRows_(0),
+        columnar_(false)
     {
     }
 
@@ -45,7 +47,7 @@ public:
     unsigned GetNumColumns() const { return columns_.Size(); }
 
     /// Return number of rows in the resultset or 0 if the number of rows is not available.
-    unsigned GetNumRows() const { return rows_.Size(); }
+    unsigned GetNumRows() const { return columnar_ ? numColumnarRows_ : rows_.Size(); }
 
     /// Return number of affected rows by the DML query or -1 if the number of affected rows is not available.
     long GetNumAffectedRows() const { return numAffectedRows_; }
@@ -59,6 +61,24 @@ public:
     /// Return fetched rows collection. Filtered rows are not included in the collection.
     const Vector<VariantVector>& GetRows() const { return rows_; }
 
+    /// Return whether the fetched rows are stored as one value collection per column instead of one per row. Results of asynchronous queries are columnar.
+    bool IsColumnar() const { return columnar_; }
+
+    /// Return the values of a column in row order. Empty if the result is not columnar.
+    const VariantVector& GetColumnValues(unsigned index) const
+    {
+        return index < columnValues_.Size() ? columnValues_[index] : Variant::emptyVariantVector;
+    }
+
+    /// Return a fetched value by row and column index in either storage layout.
+    const Variant& GetValue(unsigned row, unsigned column) const
+    {
+        if (columnar_)
+            return column < columnValues_.Size() && row < numColumnarRows_ ? columnValues_[column][row] : Variant::EMPTY;
+        else
+            return row < rows_.Size() && column < rows_[row].Size() ? rows_[row][column] : Variant::EMPTY;
+    }
+
 private:
     /// The underlying implementation connection object.
     nanodbc::result resultImpl_;
@@ -66,8 +86,14 @@ private:
     StringVector columns_;
     /// Fetched rows from the resultset.
     Vector<VariantVector> rows_;
+    /// Fetched values by column in a columnar result.
+    Vector<VariantVector> columnValues_;
     /// Number of affected rows by recent DML query.
     long numAffectedRows_;
+    /// Number of fetched rows in a columnar result.
+    unsigned numColumnarRows_;
+    /// Columnar storage flag.
+    bool columnar_;
 };
 
 }
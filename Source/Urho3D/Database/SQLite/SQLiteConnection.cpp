@@ -22,6 +22,7 @@
 
 #include "../../Precompiled.h"
 
+#include "../../Database/Database.h"
 #include "../../Database/DatabaseEvents.h"
 #include "../../IO/Log.h"
 
@@ -55,10 +56,99 @@ DbConnection::~DbConnection()
 
 void DbConnection::Finalize()
 {
-    // TODO
+    MutexLock lock(executeMutex_);
+
+    for (HashMap<String, sqlite3_stmt*>::Iterator i = statements_.Begin(); i != statements_.End(); ++i)
+        sqlite3_finalize(i->second_);
+    statements_.Clear();
 }
 
 DbResult DbConnection::Execute(const String& sql, bool useCursorEvent)
+{
+    MutexLock lock(executeMutex_);
+    return ExecuteStatement(sql, useCursorEvent, false);
+}
+
+DbResult DbConnection::Execute(const String& sql, const VariantVector& parameters, bool useCursorEvent)
+{
+    MutexLock lock(executeMutex_);
+
+    DbResult result;
+    sqlite3_stmt* pStmt = GetStatement(sql);
+    if (!pStmt || !BindParameters(pStmt, parameters))
+        return result;
+
+    FetchRows(pStmt, sql, useCursorEvent, false, result);
+    sqlite3_reset(pStmt);
+    sqlite3_clear_bindings(pStmt);
+    return result;
+}
+
+bool DbConnection::ExecuteBatch(const String& sql, const Vector<VariantVector>& rows)
+{
+    MutexLock lock(executeMutex_);
+    assert(connectionImpl_);
+
+    sqlite3_stmt* pStmt = GetStatement(sql);
+    if (!pStmt)
+        return false;
+
+    // Without an explicit transaction every row would be committed, and synced to disk, separately
+    if (sqlite3_exec(connectionImpl_, "BEGIN", nullptr, nullptr, nullptr) != SQLITE_OK)
+    {
+        URHO3D_LOGERROR("Could not begin transaction: {}", sqlite3_errmsg(connectionImpl_));
+        return false;
+    }
+
+    bool success = true;
+    for (unsigned i = 0; i < rows.Size() && success; ++i)
+    {
+        success = BindParameters(pStmt, rows[i]);
+        if (success)
+        {
+            int rc;
+            while ((rc = sqlite3_step(pStmt)) == SQLITE_ROW)
+                ;
+            if (rc != SQLITE_DONE)
+            {
+                URHO3D_LOGERROR("Could not execute: {}", sqlite3_errmsg(connectionImpl_));
+                success = false;
+            }
+        }
+        sqlite3_reset(pStmt);
+        sqlite3_clear_bindings(pStmt);
+    }
+
+    if (success && sqlite3_exec(connectionImpl_, "COMMIT", nullptr, nullptr, nullptr) != SQLITE_OK)
+    {
+        URHO3D_LOGERROR("Could not commit transaction: {}", sqlite3_errmsg(connectionImpl_));
+        success = false;
+    }
+    if (!success)
+        sqlite3_exec(connectionImpl_, "ROLLBACK", nullptr, nullptr, nullptr);
+
+    return success;
+}
+
+unsigned DbConnection::ExecuteAsync(const String& sql)
+{
+    auto* database = GetSubsystem<Database>();
+    if (!database)
+    {
+        URHO3D_LOGERROR("Could not execute asynchronously: no database subsystem");
+        return 0;
+    }
+
+    return database->QueueQuery(this, sql);
+}
+
+unsigned DbConnection::GetNumCachedStatements() const
+{
+    MutexLock lock(executeMutex_);
+    return statements_.Size();
+}
+
+DbResult DbConnection::ExecuteStatement(const String& sql, bool useCursorEvent, bool columnar)
 {
     DbResult result;
     const char* zLeftover = nullptr;
@@ -82,17 +172,120 @@ DbResult DbConnection::Execute(const String& sql, bool useCursorEvent)
         return result;
     }
 
+    FetchRows(pStmt, sql, useCursorEvent, columnar, result);
+    sqlite3_finalize(pStmt);
+    return result;
+}
+
+sqlite3_stmt* DbConnection::GetStatement(const String& sql)
+{
+    HashMap<String, sqlite3_stmt*>::ConstIterator i = statements_.Find(sql);
+    if (i != statements_.End())
+        return i->second_;
+
+    const char* zLeftover = nullptr;
+    sqlite3_stmt* pStmt = nullptr;
+    assert(connectionImpl_);
+
+    String trimmedSqlStr = sql.Trimmed();
+    if (sqlite3_prepare_v2(connectionImpl_, trimmedSqlStr.CString(), -1, &pStmt, &zLeftover) != SQLITE_OK)
+    {
+        URHO3D_LOGERROR("Could not prepare: {}", sqlite3_errmsg(connectionImpl_));
+        return nullptr;
+    }
+    if (*zLeftover)
+    {
+        URHO3D_LOGERROR("Could not prepare: only one SQL statement is allowed");
+        sqlite3_finalize(pStmt);
+        return nullptr;
+    }
+
+    statements_[sql] = pStmt;
+    return pStmt;
+}
+
+bool DbConnection::BindParameters(sqlite3_stmt* pStmt, const VariantVector& parameters)
+{
+    auto numParams = (unsigned)sqlite3_bind_parameter_count(pStmt);
+    if (parameters.Size() != numParams)
+    {
+        URHO3D_LOGERROR("Could not bind: the statement has {} parameters but {} values were given", numParams, parameters.Size());
+        return false;
+    }
+
+    for (unsigned i = 0; i < numParams; ++i)
+    {
+        // Parameter indices start from 1. The values outlive the execution, so they do not need to be copied
+        const Variant& value = parameters[i];
+        int index = (int)i + 1;
+        int rc;
+        switch (value.GetType())
+        {
+        case VAR_NONE:
+            rc = sqlite3_bind_null(pStmt, index);
+            break;
+
+        case VAR_INT:
+            rc = sqlite3_bind_int(pStmt, index, value.GetInt());
+            break;
+
+        case VAR_INT64:
+            rc = sqlite3_bind_int64(pStmt, index, value.GetInt64());
+            break;
+
+        case VAR_BOOL:
+            rc = sqlite3_bind_int(pStmt, index, value.GetBool() ? 1 : 0);
+            break;
+
+        case VAR_FLOAT:
+        case VAR_DOUBLE:
+            rc = sqlite3_bind_double(pStmt, index, value.GetDouble());
+            break;
+
+        case VAR_STRING:
+            rc = sqlite3_bind_text(pStmt, index, value.GetString().CString(), (int)value.GetString().Length(), SQLITE_STATIC);
+            break;
+
+        case VAR_BUFFER:
+            {
+                const PODVector<unsigned char>& buffer = value.GetBuffer();
+                rc = sqlite3_bind_blob(pStmt, index, buffer.Empty() ? nullptr : &buffer[0], (int)buffer.Size(), SQLITE_STATIC);
+            }
+            break;
+
+        default:
+            // All other types are bound using their string representation
+            rc = sqlite3_bind_text(pStmt, index, value.ToString().CString(), -1, SQLITE_TRANSIENT);
+            break;
+        }
+
+        if (rc != SQLITE_OK)
+        {
+            URHO3D_LOGERROR("Could not bind: {}", sqlite3_errmsg(connectionImpl_));
+            sqlite3_clear_bindings(pStmt);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void DbConnection::FetchRows(sqlite3_stmt* pStmt, const String& sql, bool useCursorEvent, bool columnar, DbResult& result)
+{
     auto numCols = (unsigned)sqlite3_column_count(pStmt);
     result.columns_.Resize(numCols);
     for (unsigned i = 0; i < numCols; ++i)
         result.columns_[i] = sqlite3_column_name(pStmt, i);
+    result.columnar_ = columnar;
+    if (columnar)
+        result.columnValues_.Resize(numCols);
 
     bool filtered = false;
     bool aborted = false;
 
     while (true)
     {
-        rc = sqlite3_step(pStmt);
+        int rc = sqlite3_step(pStmt);
         if (rc == SQLITE_ROW)
         {
             VariantVector colValues(numCols);
@@ -143,24 +336,28 @@ DbResult DbConnection::Execute(const String& sql, bool useCursorEvent)
             }
 
             if (!filtered)
-                result.rows_.Push(colValues);
-            if (aborted)
             {
-                sqlite3_finalize(pStmt);
-                break;
+                if (columnar)
+                {
+                    for (unsigned i = 0; i < numCols; ++i)
+                        result.columnValues_[i].Push(colValues[i]);
+                    ++result.numColumnarRows_;
+                }
+                else
+                    result.rows_.Push(colValues);
             }
+            if (aborted)
+                break;
         }
-        else if (rc != SQLITE_DONE)
-            URHO3D_LOGERROR("Could not execute: {}", sqlite3_errmsg(connectionImpl_));
-        if (rc != SQLITE_ROW)
+        else
         {
-            sqlite3_finalize(pStmt);
+            if (rc != SQLITE_DONE)
+                URHO3D_LOGERROR("Could not execute: {}", sqlite3_errmsg(connectionImpl_));
             break;
         }
     }
 
     result.numAffectedRows_ = numCols ? -1 : sqlite3_changes(connectionImpl_);
-    return result;
 }
 
 }
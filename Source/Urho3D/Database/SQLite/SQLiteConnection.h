@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../../Core/Mutex.h"
 #include "../../Core/Object.h"
 #include "../../Database/DbResult.h"
 
@@ -35,16 +36,24 @@ class URHO3D_API DbConnection : public Object
 {
     URHO3D_OBJECT(DbConnection, Object);
 
+    friend class DbQueryThread;
+
 public:
     /// Construct.
     DbConnection(Context* context, const String& connectionString);
     /// Destruct.
     ~DbConnection() override;
-    /// Finalize all prepared statements, close all BLOB handles, and finish all sqlite3_backup objects.
+    /// Finalize all prepared statements, including the cached ones, close all BLOB handles, and finish all sqlite3_backup objects.
     void Finalize();
 
     /// Execute an SQL statements immediately. Send E_DBCURSOR event for each row in the resultset when useCursorEvent parameter is set to true.
     DbResult Execute(const String& sql, bool useCursorEvent = false);
+    /// Execute an SQL statement in the database worker thread. The rows are fetched into a columnar result, which is delivered in the main thread with the E_DBQUERYFINISHED event. Cursor events are not sent. Return the query ID, or 0 if failed.
+    unsigned ExecuteAsync(const String& sql);
+    /// Execute an SQL statement with ? or numbered parameters bound in order from the values. The prepared statement is cached by the SQL text and reused on the next execution. Send E_DBCURSOR event for each row in the resultset when useCursorEvent parameter is set to true.
+    DbResult Execute(const String& sql, const VariantVector& parameters, bool useCursorEvent = false);
+    /// Execute a cached prepared SQL statement once for each row of parameter values inside a single transaction, for example to insert many rows. The transaction is rolled back if any execution fails. Return true if successful.
+    bool ExecuteBatch(const String& sql, const Vector<VariantVector>& rows);
 
     /// Return database connection string. The connection string for SQLite3 is using the URI format described in https://www.sqlite.org/uri.html, while the connection string for ODBC is using DSN format as per ODBC standard.
     const String& GetConnectionString() const { return connectionString_; }
@@ -55,9 +64,25 @@ public:
     /// Return true when the connection object is connected to the associated database.
     bool IsConnected() const { return connectionImpl_ != nullptr; }
 
+    /// Return number of prepared statements in the statement cache.
+    unsigned GetNumCachedStatements() const;
+
 private:
+    /// Execute an SQL statement. Called with the execution mutex locked, from either the main thread or the database worker thread.
+    DbResult ExecuteStatement(const String& sql, bool useCursorEvent, bool columnar);
+    /// Return a prepared statement from the statement cache, preparing it if not cached yet. Return null if failed.
+    sqlite3_stmt* GetStatement(const String& sql);
+    /// Bind parameter values to a prepared statement. Return true if successful.
+    bool BindParameters(sqlite3_stmt* pStmt, const VariantVector& parameters);
+    /// Step through a prepared statement and fetch its rows into a result.
+    void FetchRows(sqlite3_stmt* pStmt, const String& sql, bool useCursorEvent, bool columnar, DbResult& result);
+
     /// The connection string for SQLite3 is using the URI format described in https://www.sqlite.org/uri.html, while the connection string for ODBC is using DSN format as per ODBC standard.
     String connectionString_;
+    /// Mutex for executing statements from the main thread and the database worker thread.
+    mutable Mutex executeMutex_;
+    /// Cached prepared statements by SQL text.
+    HashMap<String, sqlite3_stmt*> statements_;
     /// The underlying implementation connection object.
     sqlite3* connectionImpl_;
 };
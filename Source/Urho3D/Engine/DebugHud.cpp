@@ -22,19 +22,34 @@
 
 #include "../Precompiled.h"
 
+#ifdef URHO3D_ANGELSCRIPT
+#include "../AngelScript/Script.h"
+#endif
 #include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
 #include "../Core/EventProfiler.h"
 #include "../Core/Context.h"
+#include "../Container/Sort.h"
 #include "../Engine/DebugHud.h"
 #include "../Engine/Engine.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Renderer.h"
+#include "../Graphics/Viewport.h"
+#include "../IO/File.h"
+#include "../Resource/JSONFile.h"
 #include "../Resource/ResourceCache.h"
 #include "../IO/Log.h"
+#ifdef URHO3D_LUA
+#include "../LuaScript/LuaScript.h"
+#endif
+#ifdef URHO3D_PHYSICS
+#include "../Physics/PhysicsWorld.h"
+#endif
+#include "../Scene/Scene.h"
 #include "../UI/Font.h"
 #include "../UI/Text.h"
 #include "../UI/UI.h"
+#include "../UI/UIBatch.h"
 
 #include "../DebugNew.h"
 
@@ -59,8 +74,117 @@ static const char* shadowQualityTexts[] =
     "Blurred VSM"
 };
 
+/// Number of frames in the frame time history, also the graph width in pixels.
+static const unsigned FRAME_TIME_HISTORY_SIZE = 300;
+/// Frame time graph height in pixels.
+static const int FRAME_TIME_GRAPH_HEIGHT = 80;
+/// Number of long frames kept.
+static const unsigned MAX_LONG_FRAMES = 32;
+/// Number of long frames listed in the frame time text.
+static const unsigned NUM_SHOWN_LONG_FRAMES = 5;
+
+/// Bar graph of the frame time history.
+class FrameTimeGraph : public UIElement
+{
+    URHO3D_OBJECT(FrameTimeGraph, UIElement);
+
+public:
+    /// Construct.
+    explicit FrameTimeGraph(Context* context) :
+        UIElement(context),
+        longFrameThreshold_(0.0f)
+    {
+    }
+
+    /// Set the frame times to show, oldest first, and the long frame threshold.
+    void SetFrameTimes(const PODVector<float>& frameTimes, float longFrameThreshold)
+    {
+        frameTimes_ = frameTimes;
+        longFrameThreshold_ = longFrameThreshold;
+        MarkBatchesDirty();
+    }
+
+    /// Return UI rendering batches.
+    void GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, const IntRect& currentScissor) override
+    {
+        const IntVector2& size = GetSize();
+        const float width = (float)size.x_;
+        const float height = (float)size.y_;
+
+        // Scale to the slowest frame, but show at least the 30 fps frame time
+        float maxTime = 1000.0f / 30.0f;
+        for (unsigned i = 0; i < frameTimes_.Size(); ++i)
+            maxTime = Max(maxTime, frameTimes_[i]);
+        const float scale = height / (maxTime * 1.1f);
+
+        UIBatch batch(this, BLEND_ALPHA, currentScissor, nullptr, &vertexData);
+        batch.SetColor(Color(0.0f, 0.0f, 0.0f, 0.5f));
+        batch.AddQuad(0.0f, 0.0f, width, height, 0, 0);
+
+        // Reference lines at the 60 and 30 fps frame times
+        batch.SetColor(Color(1.0f, 1.0f, 1.0f, 0.3f));
+        batch.AddQuad(0.0f, height - 1000.0f / 60.0f * scale, width, 1.0f, 0, 0);
+        batch.AddQuad(0.0f, height - 1000.0f / 30.0f * scale, width, 1.0f, 0, 0);
+
+        const float barWidth = width / FRAME_TIME_HISTORY_SIZE;
+        const float startX = width - frameTimes_.Size() * barWidth;
+        for (unsigned i = 0; i < frameTimes_.Size(); ++i)
+        {
+            const float time = frameTimes_[i];
+            if (longFrameThreshold_ > 0.0f && time > longFrameThreshold_)
+                batch.SetColor(Color::RED);
+            else if (time > 1000.0f / 60.0f)
+                batch.SetColor(Color::YELLOW);
+            else
+                batch.SetColor(Color::GREEN);
+
+            const float barHeight = Min(time * scale, height);
+            batch.AddQuad(startX + i * barWidth, height - barHeight, barWidth, barHeight, 0, 0);
+        }
+
+        UIBatch::AddOrMerge(batch, batches);
+    }
+
+private:
+    /// Frame times in milliseconds, oldest first.
+    PODVector<float> frameTimes_;
+    /// Long frame threshold in milliseconds.
+    float longFrameThreshold_;
+};
+
+/// Return the path and time of the profiler block that took most of the time below the given block, descending while a single child dominates.
+static void FindDominantBlock(const ProfilerBlock* block, String& path, long long& time)
+{
+    const ProfilerBlock* current = block;
+    for (;;)
+    {
+        const ProfilerBlock* dominant = nullptr;
+        for (PODVector<ProfilerBlock*>::ConstIterator i = current->children_.Begin(); i != current->children_.End(); ++i)
+        {
+            // The frame limiter sleep is not a cause of a long frame
+            if (!strcmp((*i)->name_, "ApplyFrameLimit"))
+                continue;
+            if (!dominant || (*i)->frameTime_ > dominant->frameTime_)
+                dominant = *i;
+        }
+
+        if (!dominant || !dominant->frameTime_ || (current != block && dominant->frameTime_ * 2 < current->frameTime_))
+            break;
+
+        if (!path.Empty())
+            path += "/";
+        path.Append(dominant->name_);
+        time = dominant->frameTime_;
+        current = dominant;
+    }
+}
+
 DebugHud::DebugHud(Context* context) :
     Object(context),
+    frameTimeIndex_(0),
+    numFrameTimes_(0),
+    medianFrameTime_(0.0f),
+    longFrameThreshold_(0.0f),
     profilerMaxDepth_(M_MAX_UNSIGNED),
     profilerInterval_(1000),
     useRendererStats_(false),
@@ -99,6 +223,23 @@ DebugHud::DebugHud(Context* context) :
     eventProfilerText_->SetVisible(false);
     uiRoot->AddChild(eventProfilerText_);
 
+    frameTimeGraph_ = new FrameTimeGraph(context_);
+    frameTimeGraph_->SetAlignment(HA_RIGHT, VA_BOTTOM);
+    frameTimeGraph_->SetSize(FRAME_TIME_HISTORY_SIZE, FRAME_TIME_GRAPH_HEIGHT);
+    frameTimeGraph_->SetPriority(100);
+    frameTimeGraph_->SetVisible(false);
+    uiRoot->AddChild(frameTimeGraph_);
+
+    frameTimeText_ = new Text(context_);
+    frameTimeText_->SetAlignment(HA_RIGHT, VA_BOTTOM);
+    frameTimeText_->SetPosition(0, -FRAME_TIME_GRAPH_HEIGHT);
+    frameTimeText_->SetPriority(100);
+    frameTimeText_->SetVisible(false);
+    uiRoot->AddChild(frameTimeText_);
+
+    frameTimes_.Resize(FRAME_TIME_HISTORY_SIZE);
+
+    SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(DebugHud, HandleBeginFrame));
     SubscribeToEvent(E_POSTUPDATE, URHO3D_HANDLER(DebugHud, HandlePostUpdate));
 }
 
@@ -109,6 +250,8 @@ DebugHud::~DebugHud()
     profilerText_->Remove();
     memoryText_->Remove();
     eventProfilerText_->Remove();
+    frameTimeText_->Remove();
+    frameTimeGraph_->Remove();
 }
 
 void DebugHud::Update()
@@ -126,6 +269,8 @@ void DebugHud::Update()
         uiRoot->AddChild(statsText_);
         uiRoot->AddChild(modeText_);
         uiRoot->AddChild(profilerText_);
+        uiRoot->AddChild(frameTimeGraph_);
+        uiRoot->AddChild(frameTimeText_);
     }
 
     if (statsText_->IsVisible())
@@ -151,6 +296,77 @@ void DebugHud::Update()
             renderer->GetNumShadowMaps(true),
             renderer->GetNumOccluders(true));
 
+        if (graphics->GetGPUProfiling())
+            stats.AppendWithFormat("\nGPU frame %.3f ms", graphics->GetGPUFrameTime() / 1000.0f);
+
+        auto* engine = GetSubsystem<Engine>();
+        if (engine && (engine->GetLowLatencyInput() || engine->GetLateInputSampling()))
+            stats.AppendWithFormat("\nInput latency %.3f ms", engine->GetInputLatency() / 1000.0f);
+
+#ifdef URHO3D_PHYSICS
+        // Show the step statistics of the physics worlds in the viewed scenes that collect them
+        PODVector<Scene*> scenes;
+        for (unsigned i = 0; i < renderer->GetNumViewports(); ++i)
+        {
+            Viewport* viewport = renderer->GetViewport(i);
+            Scene* scene = viewport ? viewport->GetScene() : nullptr;
+            if (!scene || scenes.Contains(scene))
+                continue;
+            scenes.Push(scene);
+
+            auto* physicsWorld = scene->GetComponent<PhysicsWorld>();
+            if (!physicsWorld || !physicsWorld->IsStatisticsEnabled())
+                continue;
+
+            const PhysicsStatistics& physicsStats = physicsWorld->GetStatistics();
+            stats.AppendWithFormat("\n\nPhysics steps %u %.3f ms\nCollision %.3f ms (broadphase %.3f narrowphase %.3f)\n"
+                "Islands %.3f ms Solve %.3f ms Integrate %.3f ms\nPairs %u Tests %u Manifolds %u Contacts %u\n"
+                "Islands %u Constraints %u Iterations %u",
+                physicsStats.numSteps_,
+                physicsStats.stepTime_,
+                physicsStats.collisionTime_,
+                physicsStats.broadphaseTime_,
+                physicsStats.narrowphaseTime_,
+                physicsStats.islandTime_,
+                physicsStats.solveTime_,
+                physicsStats.integrateTime_,
+                physicsStats.numBroadphasePairs_,
+                physicsStats.numNarrowphaseTests_,
+                physicsStats.numManifolds_,
+                physicsStats.numContacts_,
+                physicsStats.numIslands_,
+                physicsStats.numConstraints_,
+                physicsStats.numSolverIterations_);
+        }
+#endif
+
+#ifdef URHO3D_ANGELSCRIPT
+        auto* script = GetSubsystem<Script>();
+        if (script && script->GetGCTimeBudget())
+        {
+            const ScriptGCStatistics& gcStats = script->GetGCStatistics();
+            stats.AppendWithFormat("\n\nAngelScript GC %.3f ms Steps %u Cycles %u\nObjects %u Destroyed %u",
+                gcStats.collectTime_,
+                gcStats.numSteps_,
+                gcStats.numCycles_,
+                gcStats.numObjects_,
+                gcStats.numDestroyed_);
+        }
+#endif
+
+#ifdef URHO3D_LUA
+        auto* luaScript = GetSubsystem<LuaScript>();
+        if (luaScript && luaScript->GetGCTimeBudget())
+        {
+            const LuaGCStatistics& gcStats = luaScript->GetGCStatistics();
+            stats.AppendWithFormat("\n\nLua GC %.3f ms Steps %u Cycles %u\nMemory %u KB",
+                gcStats.collectTime_,
+                gcStats.numSteps_,
+                gcStats.numCycles_,
+                gcStats.memoryUse_);
+        }
+#endif
+
         if (!appStats_.Empty())
         {
             stats.Append("\n");
@@ -202,7 +418,35 @@ void DebugHud::Update()
     }
 
     if (memoryText_->IsVisible())
-        memoryText_->SetText(GetSubsystem<ResourceCache>()->PrintMemoryUsage());
+    {
+        String memoryText = GetSubsystem<ResourceCache>()->PrintMemoryUsage();
+        memoryText += "\n" + graphics->PrintGPUMemoryUsage(5);
+        memoryText_->SetText(memoryText);
+    }
+
+    if (frameTimeText_->IsVisible())
+    {
+        const float threshold = longFrameThreshold_ > 0.0f ? longFrameThreshold_ : medianFrameTime_ * 2.0f;
+        static_cast<FrameTimeGraph*>(frameTimeGraph_.Get())->SetFrameTimes(GetFrameTimes(), threshold);
+
+        String frameTime;
+        frameTime.AppendWithFormat("Frame p50 %.2f ms p95 %.2f ms p99 %.2f ms max %.2f ms",
+            GetFrameTimePercentile(50.0f),
+            GetFrameTimePercentile(95.0f),
+            GetFrameTimePercentile(99.0f),
+            GetFrameTimePercentile(100.0f));
+
+        const unsigned start = longFrames_.Size() > NUM_SHOWN_LONG_FRAMES ? longFrames_.Size() - NUM_SHOWN_LONG_FRAMES : 0;
+        for (unsigned i = longFrames_.Size(); i > start; --i)
+        {
+            const LongFrame& longFrame = longFrames_[i - 1];
+            frameTime.AppendWithFormat("\n#%u %.2f ms", longFrame.frameNumber_, longFrame.time_);
+            if (!longFrame.block_.Empty())
+                frameTime.AppendWithFormat(" %s %.2f ms", longFrame.block_.CString(), longFrame.blockTime_);
+        }
+
+        frameTimeText_->SetText(frameTime);
+    }
 }
 
 void DebugHud::SetDefaultStyle(XMLFile* style)
@@ -220,6 +464,8 @@ void DebugHud::SetDefaultStyle(XMLFile* style)
     memoryText_->SetStyle("DebugHudText");
     eventProfilerText_->SetDefaultStyle(style);
     eventProfilerText_->SetStyle("DebugHudText");
+    frameTimeText_->SetDefaultStyle(style);
+    frameTimeText_->SetStyle("DebugHudText");
 }
 
 void DebugHud::SetMode(unsigned mode)
@@ -229,6 +475,8 @@ void DebugHud::SetMode(unsigned mode)
     profilerText_->SetVisible((mode & DEBUGHUD_SHOW_PROFILER) != 0);
     memoryText_->SetVisible((mode & DEBUGHUD_SHOW_MEMORY) != 0);
     eventProfilerText_->SetVisible((mode & DEBUGHUD_SHOW_EVENTPROFILER) != 0);
+    frameTimeText_->SetVisible((mode & DEBUGHUD_SHOW_FRAMETIME) != 0);
+    frameTimeGraph_->SetVisible((mode & DEBUGHUD_SHOW_FRAMETIME) != 0);
 
     memoryText_->SetPosition(0, modeText_->IsVisible() ? modeText_->GetHeight() * -2 : 0);
 
@@ -257,6 +505,11 @@ void DebugHud::SetUseRendererStats(bool enable)
     useRendererStats_ = enable;
 }
 
+void DebugHud::SetLongFrameThreshold(float threshold)
+{
+    longFrameThreshold_ = Max(threshold, 0.0f);
+}
+
 void DebugHud::Toggle(unsigned mode)
 {
     SetMode(GetMode() ^ mode);
@@ -277,6 +530,57 @@ float DebugHud::GetProfilerInterval() const
     return (float)profilerInterval_ / 1000.0f;
 }
 
+float DebugHud::GetFrameTimePercentile(float percentile) const
+{
+    PODVector<float> sorted = GetFrameTimes();
+    if (sorted.Empty())
+        return 0.0f;
+
+    Sort(sorted.Begin(), sorted.End());
+    const auto index = (unsigned)(Clamp(percentile, 0.0f, 100.0f) / 100.0f * (sorted.Size() - 1) + 0.5f);
+    return sorted[index];
+}
+
+bool DebugHud::SaveFrameTimes(const String& fileName) const
+{
+    SharedPtr<JSONFile> file(new JSONFile(context_));
+    JSONValue& root = file->GetRoot();
+
+    root.Set("p50", GetFrameTimePercentile(50.0f));
+    root.Set("p95", GetFrameTimePercentile(95.0f));
+    root.Set("p99", GetFrameTimePercentile(99.0f));
+    root.Set("max", GetFrameTimePercentile(100.0f));
+
+    const PODVector<float> frameTimes = GetFrameTimes();
+    JSONArray frameTimeArray;
+    frameTimeArray.Reserve(frameTimes.Size());
+    for (unsigned i = 0; i < frameTimes.Size(); ++i)
+        frameTimeArray.Push(frameTimes[i]);
+    root.Set("frameTimes", frameTimeArray);
+
+    JSONArray longFrameArray;
+    for (unsigned i = 0; i < longFrames_.Size(); ++i)
+    {
+        const LongFrame& longFrame = longFrames_[i];
+        JSONValue value;
+        value.Set("frame", longFrame.frameNumber_);
+        value.Set("time", longFrame.time_);
+        value.Set("block", longFrame.block_);
+        value.Set("blockTime", longFrame.blockTime_);
+        longFrameArray.Push(value);
+    }
+    root.Set("longFrames", longFrameArray);
+
+    File output(context_, fileName, FILE_WRITE);
+    if (!output.IsOpen() || !file->Save(output))
+    {
+        URHO3D_LOGERROR("Failed to write frame times to " + fileName);
+        return false;
+    }
+
+    return true;
+}
+
 void DebugHud::SetAppStats(const String& label, const Variant& stats)
 {
     SetAppStats(label, stats.ToString());
@@ -300,6 +604,16 @@ void DebugHud::ClearAppStats()
     appStats_.Clear();
 }
 
+PODVector<float> DebugHud::GetFrameTimes() const
+{
+    PODVector<float> frameTimes;
+    frameTimes.Reserve(numFrameTimes_);
+    const unsigned start = numFrameTimes_ < FRAME_TIME_HISTORY_SIZE ? 0 : frameTimeIndex_;
+    for (unsigned i = 0; i < numFrameTimes_; ++i)
+        frameTimes.Push(frameTimes_[(start + i) % FRAME_TIME_HISTORY_SIZE]);
+    return frameTimes;
+}
+
 void DebugHud::HandlePostUpdate(StringHash eventType, VariantMap& eventData)
 {
     using namespace PostUpdate;
@@ -307,4 +621,37 @@ void DebugHud::HandlePostUpdate(StringHash eventType, VariantMap& eventData)
     Update();
 }
 
+void DebugHud::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
+{
+    using namespace BeginFrame;
+
+    const float time = frameTimer_.GetUSec(true) / 1000.0f;
+    frameTimes_[frameTimeIndex_] = time;
+    frameTimeIndex_ = (frameTimeIndex_ + 1) % FRAME_TIME_HISTORY_SIZE;
+    numFrameTimes_ = Min(numFrameTimes_ + 1, FRAME_TIME_HISTORY_SIZE);
+
+    const float threshold = longFrameThreshold_ > 0.0f ? longFrameThreshold_ : medianFrameTime_ * 2.0f;
+    if (threshold > 0.0f && time > threshold)
+    {
+        LongFrame longFrame;
+        longFrame.frameNumber_ = eventData[P_FRAMENUMBER].GetUInt() - 1;
+        longFrame.time_ = time;
+
+        // The profiler has just ended the previous frame, so its blocks hold the times of the long frame
+        auto* profiler = GetSubsystem<Profiler>();
+        if (profiler)
+        {
+            long long blockTime = 0;
+            FindDominantBlock(profiler->GetRootBlock(), longFrame.block_, blockTime);
+            longFrame.blockTime_ = blockTime / 1000.0f;
+        }
+
+        if (longFrames_.Size() >= MAX_LONG_FRAMES)
+            longFrames_.Erase(0);
+        longFrames_.Push(longFrame);
+    }
+
+    medianFrameTime_ = GetFrameTimePercentile(50.0f);
+}
+
 }
@@ -31,6 +31,7 @@ namespace Urho3D
 class Engine;
 class Font;
 class Text;
+class UIElement;
 class XMLFile;
 
 static const unsigned DEBUGHUD_SHOW_NONE = 0x0;
@@ -39,8 +40,23 @@ static const unsigned DEBUGHUD_SHOW_MODE = 0x2;
 static const unsigned DEBUGHUD_SHOW_PROFILER = 0x4;
 static const unsigned DEBUGHUD_SHOW_MEMORY = 0x8;
 static const unsigned DEBUGHUD_SHOW_EVENTPROFILER = 0x10;
+static const unsigned DEBUGHUD_SHOW_FRAMETIME = 0x20;
 static const unsigned DEBUGHUD_SHOW_ALL = DEBUGHUD_SHOW_STATS | DEBUGHUD_SHOW_MODE | DEBUGHUD_SHOW_PROFILER | DEBUGHUD_SHOW_MEMORY;
 
+/// Long frame recorded by the debug HUD.
+/// @nobind
+struct LongFrame
+{
+    /// Frame number.
+    unsigned frameNumber_{};
+    /// Frame time in milliseconds.
+    float time_{};
+    /// Path of the profiler block that took most of the frame, empty if not known.
+    String block_;
+    /// Time of the dominant profiler block in milliseconds.
+    float blockTime_{};
+};
+
 /// Displays rendering stats and profiling information.
 class URHO3D_API DebugHud : public Object
 {
@@ -69,6 +85,9 @@ public:
     /// Set whether to show 3D geometry primitive/batch count only. Default false.
     /// @property
     void SetUseRendererStats(bool enable);
+    /// Set the frame time in milliseconds above which a frame is recorded as a long frame. Zero (default) uses twice the median frame time.
+    /// @property
+    void SetLongFrameThreshold(float threshold);
     /// Toggle elements.
     void Toggle(unsigned mode);
     /// Toggle all elements.
@@ -94,6 +113,10 @@ public:
     /// @property
     Text* GetMemoryText() const { return memoryText_; }
 
+    /// Return frame time statistics text.
+    /// @property
+    Text* GetFrameTimeText() const { return frameTimeText_; }
+
     /// Return currently shown elements.
     /// @property
     unsigned GetMode() const { return mode_; }
@@ -110,6 +133,19 @@ public:
     /// @property
     bool GetUseRendererStats() const { return useRendererStats_; }
 
+    /// Return the long frame threshold in milliseconds, zero if automatic.
+    /// @property
+    float GetLongFrameThreshold() const { return longFrameThreshold_; }
+
+    /// Return a frame time percentile (0-100) in milliseconds over the frame time history.
+    float GetFrameTimePercentile(float percentile) const;
+
+    /// Return the most recent long frames, oldest first.
+    const Vector<LongFrame>& GetLongFrames() const { return longFrames_; }
+
+    /// Write the frame time history, percentiles and long frames to a JSON file. Return true if successful.
+    bool SaveFrameTimes(const String& fileName) const;
+
     /// Set application-specific stats.
     void SetAppStats(const String& label, const Variant& stats);
     /// Set application-specific stats.
@@ -122,6 +158,10 @@ public:
 private:
     /// Handle logic post-update event. The HUD texts are updated here.
     void HandlePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle frame begin event. Records the time of the previous frame.
+    void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+    /// Return the frame time history, oldest first.
+    PODVector<float> GetFrameTimes() const;
 
     /// Rendering stats text.
     SharedPtr<Text> statsText_;
@@ -133,6 +173,24 @@ private:
     SharedPtr<Text> eventProfilerText_;
     /// Memory stats text.
     SharedPtr<Text> memoryText_;
+    /// Frame time statistics text.
+    SharedPtr<Text> frameTimeText_;
+    /// Frame time graph.
+    SharedPtr<UIElement> frameTimeGraph_;
+    /// Frame time history in milliseconds as a ring buffer.
+    PODVector<float> frameTimes_;
+    /// Next write position in the frame time history.
+    unsigned frameTimeIndex_;
+    /// Number of recorded frame times.
+    unsigned numFrameTimes_;
+    /// Median frame time of the history in milliseconds.
+    float medianFrameTime_;
+    /// Most recent long frames.
+    Vector<LongFrame> longFrames_;
+    /// Frame timer.
+    HiresTimer frameTimer_;
+    /// Long frame threshold in milliseconds, zero if automatic.
+    float longFrameThreshold_;
     /// Hashmap containing application specific stats.
     HashMap<String, String> appStats_;
     /// Profiler timer.
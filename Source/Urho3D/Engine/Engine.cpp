@@ -26,12 +26,14 @@
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/EventProfiler.h"
+#include "../Core/Metrics.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/WorkQueue.h"
 #include "../Engine/Console.h"
 #include "../Engine/DebugHud.h"
 #include "../Engine/Engine.h"
 #include "../Engine/EngineDefs.h"
+#include "../Engine/EngineEvents.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Renderer.h"
 #include "../Input/Input.h"
@@ -57,6 +59,7 @@
 #ifdef URHO3D_PHYSICS2D
 #include "../Physics2D/Physics2D.h"
 #endif
+#include "../Resource/Image.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/Localization.h"
 #include "../Scene/Scene.h"
@@ -95,8 +98,51 @@ namespace Urho3D
 
 extern const char* logLevelPrefixes[];
 
+/// Resource directory or package resolved by Engine::InitializeResourceCache().
+struct ResourcePathEntry
+{
+    /// Construct undefined.
+    ResourcePathEntry() = default;
+
+    /// Construct with name, priority and whether is a package file.
+    ResourcePathEntry(const String& name, unsigned priority, bool isPackage) :
+        name_(name),
+        priority_(priority),
+        isPackage_(isPackage)
+    {
+    }
+
+    /// Directory or package file name.
+    String name_;
+    /// Priority to add to the resource cache with.
+    unsigned priority_{};
+    /// Package file, opened in a worker thread.
+    SharedPtr<PackageFile> package_;
+    /// Package flag.
+    bool isPackage_{};
+    /// Whether the package was opened successfully.
+    bool opened_{};
+};
+
+/// Open the package files in a range of resolved resource paths.
+static void OpenResourcePackages(ResourcePathEntry* start, ResourcePathEntry* end)
+{
+    for (ResourcePathEntry* entry = start; entry < end; ++entry)
+    {
+        if (entry->package_)
+            entry->opened_ = entry->package_->Open(entry->name_);
+    }
+}
+
+/// Work function to open package files in a worker thread.
+static void OpenResourcePackagesWork(const WorkItem* item, unsigned /*threadIndex*/)
+{
+    OpenResourcePackages(reinterpret_cast<ResourcePathEntry*>(item->start_), reinterpret_cast<ResourcePathEntry*>(item->end_));
+}
+
 Engine::Engine(Context* context) :
     Object(context),
+    inputLatency_(0),
     timeStep_(0.0f),
     timeStepSmoothing_(2),
     minFps_(10),
@@ -116,13 +162,17 @@ Engine::Engine(Context* context) :
     initialized_(false),
     exiting_(false),
     headless_(false),
-    audioPaused_(false)
+    audioPaused_(false),
+    lowLatencyInput_(false),
+    lateInputSampling_(false),
+    profilerFrameImages_(false)
 {
     // Register self as a subsystem
     context_->RegisterSubsystem(this);
 
     // Create subsystems which do not depend on engine initialization or startup parameters
     context_->RegisterSubsystem(new Time(context_));
+    context_->RegisterSubsystem(new Metrics(context_));
     context_->RegisterSubsystem(new WorkQueue(context_));
 #ifdef URHO3D_PROFILING
     context_->RegisterSubsystem(new Profiler(context_));
@@ -210,6 +260,7 @@ bool Engine::Initialize(const VariantMap& parameters)
     // Configure max FPS
     if (GetParameter(parameters, EP_FRAME_LIMITER, true) == false)
         SetMaxFps(0);
+    SetLowLatencyInput(GetParameter(parameters, EP_LOW_LATENCY_INPUT, false).GetBool());
 
     // Set amount of worker threads according to the available physical CPU cores. Using also hyperthreaded cores results in
     // unpredictable extra synchronization overhead. Also reserve one core for the main thread
@@ -217,10 +268,32 @@ bool Engine::Initialize(const VariantMap& parameters)
     unsigned numThreads = GetParameter(parameters, EP_WORKER_THREADS, true).GetBool() ? GetNumPhysicalCPUs() - 1 : 0;
     if (numThreads)
     {
-        GetSubsystem<WorkQueue>()->CreateThreads(numThreads);
+        auto* queue = GetSubsystem<WorkQueue>();
+
+        // Restrict the threads to an explicit mask, or to the performance cores on heterogeneous CPUs, so that work items
+        // do not stall on efficiency cores. Without SMT information per core, count the cores by the physical ratio
+        unsigned long long affinity = GetParameter(parameters, EP_WORKER_THREAD_AFFINITY, 0ULL).GetUInt64();
+        if (!affinity && GetParameter(parameters, EP_PERFORMANCE_CORES, false).GetBool())
+            affinity = GetPerformanceCPUMask();
+        if (affinity)
+        {
+            unsigned numCPUs = CountSetBits((unsigned)affinity) + CountSetBits((unsigned)(affinity >> 32));
+            unsigned numCores = Max(numCPUs * GetNumPhysicalCPUs() / Max(GetNumLogicalCPUs(), 1U), 1U);
+            numThreads = Min(numThreads, numCores - 1);
+            queue->SetThreadAffinity(affinity, GetParameter(parameters, EP_WORKER_THREAD_PINNING, false).GetBool());
+        }
+        queue->SetThreadPriority(GetParameter(parameters, EP_WORKER_THREAD_PRIORITY, 0).GetInt());
 
-        URHO3D_LOGINFO("Created {} worker thread{}", numThreads, numThreads > 1 ? "s" : "");
+        if (numThreads)
+        {
+            queue->CreateThreads(numThreads);
+
+            URHO3D_LOGINFO("Created {} worker thread{}", numThreads, numThreads > 1 ? "s" : "");
+        }
     }
+
+    if (HasParameter(parameters, EP_BACKGROUND_LOAD_THREAD_PRIORITY))
+        GetSubsystem<ResourceCache>()->SetBackgroundLoadThreadPriority(GetParameter(parameters, EP_BACKGROUND_LOAD_THREAD_PRIORITY).GetInt());
 #endif
 
     // Add resource paths
@@ -241,6 +314,7 @@ bool Engine::Initialize(const VariantMap& parameters)
         graphics->SetWindowTitle(GetParameter(parameters, EP_WINDOW_TITLE, "Urho3D").GetString());
         graphics->SetWindowIcon(cache->GetResource<Image>(GetParameter(parameters, EP_WINDOW_ICON, String::EMPTY).GetString()));
         graphics->SetFlushGPU(GetParameter(parameters, EP_FLUSH_GPU, false).GetBool());
+        graphics->SetPipelinedFrames(GetParameter(parameters, EP_PIPELINED_FRAMES, false).GetBool());
         graphics->SetOrientations(GetParameter(parameters, EP_ORIENTATIONS, "LandscapeLeft LandscapeRight").GetString());
 
         if (HasParameter(parameters, EP_WINDOW_POSITION_X) && HasParameter(parameters, EP_WINDOW_POSITION_Y))
@@ -268,6 +342,8 @@ bool Engine::Initialize(const VariantMap& parameters)
             return false;
 
         graphics->SetShaderCacheDir(GetParameter(parameters, EP_SHADER_CACHE_DIR, fileSystem->GetAppPreferencesDir("urho3d", "shadercache")).GetString());
+        if (HasParameter(parameters, EP_SHADER_ARCHIVE))
+            graphics->LoadShaderArchive(GetParameter(parameters, EP_SHADER_ARCHIVE).GetString());
 
         if (HasParameter(parameters, EP_DUMP_SHADERS))
             graphics->BeginDumpShaders(GetParameter(parameters, EP_DUMP_SHADERS, String::EMPTY).GetString());
@@ -290,6 +366,11 @@ bool Engine::Initialize(const VariantMap& parameters)
                 GetParameter(parameters, EP_SOUND_STEREO, true).GetBool(),
                 GetParameter(parameters, EP_SOUND_INTERPOLATION, true).GetBool()
             );
+
+            if (HasParameter(parameters, EP_AUDIO_THREAD_PRIORITY))
+                GetSubsystem<Audio>()->SetThreadPriority(GetParameter(parameters, EP_AUDIO_THREAD_PRIORITY).GetInt());
+            if (HasParameter(parameters, EP_SOUND_MAX_VOICES))
+                GetSubsystem<Audio>()->SetMaxVoices((unsigned)GetParameter(parameters, EP_SOUND_MAX_VOICES).GetInt());
         }
     }
 
@@ -306,6 +387,10 @@ bool Engine::Initialize(const VariantMap& parameters)
         GetSubsystem<Network>()->SetPackageCacheDir(GetParameter(parameters, EP_PACKAGE_CACHE_DIR).GetString());
 #endif
 
+    // Initialize metrics export
+    if (HasParameter(parameters, EP_METRICS_PORT))
+        GetSubsystem<Metrics>()->StartServer((unsigned short)GetParameter(parameters, EP_METRICS_PORT).GetInt());
+
 #ifdef URHO3D_TESTING
     if (HasParameter(parameters, EP_TIME_OUT))
         timeOut_ = GetParameter(parameters, EP_TIME_OUT, 0).GetInt() * 1000000LL;
@@ -341,6 +426,11 @@ bool Engine::InitializeResourceCache(const VariantMap& parameters, bool removeOl
             cache->RemovePackageFile(packageFiles[i]);
     }
 
+    cache->SetMemoryMapPackages(GetParameter(parameters, EP_MEMORY_MAP_PACKAGES, false).GetBool());
+    cache->SetStripHeadlessRenderData(headless_ && GetParameter(parameters, EP_STRIP_HEADLESS_RENDER_DATA, true).GetBool());
+    cache->SetReleaseModelShadowData(GetParameter(parameters, EP_RELEASE_MODEL_SHADOW_DATA, false).GetBool());
+    cache->SetCompiledResourceDir(GetParameter(parameters, EP_COMPILED_RESOURCE_DIR, String::EMPTY).GetString());
+
     // Add resource paths
     Vector<String> resourcePrefixPaths = GetParameter(parameters, EP_RESOURCE_PREFIX_PATHS, String::EMPTY).GetString().Split(';', true);
     for (unsigned i = 0; i < resourcePrefixPaths.Size(); ++i)
@@ -350,6 +440,10 @@ bool Engine::InitializeResourceCache(const VariantMap& parameters, bool removeOl
     Vector<String> resourcePackages = GetParameter(parameters, EP_RESOURCE_PACKAGES).GetString().Split(';');
     Vector<String> autoLoadPaths = GetParameter(parameters, EP_AUTOLOAD_PATHS, "Autoload").GetString().Split(';');
 
+    // Resolve the directories and packages first, so that the packages, which need their directories read, can be opened
+    // in parallel. They are added to the cache afterward in the resolved order
+    Vector<ResourcePathEntry> entries;
+
     for (unsigned i = 0; i < resourcePaths.Size(); ++i)
     {
         // If path is not absolute, prefer to add it as a package if possible
@@ -361,18 +455,14 @@ bool Engine::InitializeResourceCache(const VariantMap& parameters, bool removeOl
                 String packageName = resourcePrefixPaths[j] + resourcePaths[i] + ".pak";
                 if (fileSystem->FileExists(packageName))
                 {
-                    if (cache->AddPackageFile(packageName))
-                        break;
-                    else
-                        return false;   // The root cause of the error should have already been logged
+                    entries.Push(ResourcePathEntry(packageName, PRIORITY_LAST, true));
+                    break;
                 }
                 String pathName = resourcePrefixPaths[j] + resourcePaths[i];
                 if (fileSystem->DirExists(pathName))
                 {
-                    if (cache->AddResourceDir(pathName))
-                        break;
-                    else
-                        return false;
+                    entries.Push(ResourcePathEntry(pathName, PRIORITY_LAST, false));
+                    break;
                 }
             }
             if (j == resourcePrefixPaths.Size())
@@ -387,8 +477,7 @@ bool Engine::InitializeResourceCache(const VariantMap& parameters, bool removeOl
         {
             String pathName = resourcePaths[i];
             if (fileSystem->DirExists(pathName))
-                if (!cache->AddResourceDir(pathName))
-                    return false;
+                entries.Push(ResourcePathEntry(pathName, PRIORITY_LAST, false));
         }
     }
 
@@ -401,10 +490,8 @@ bool Engine::InitializeResourceCache(const VariantMap& parameters, bool removeOl
             String packageName = resourcePrefixPaths[j] + resourcePackages[i];
             if (fileSystem->FileExists(packageName))
             {
-                if (cache->AddPackageFile(packageName))
-                    break;
-                else
-                    return false;
+                entries.Push(ResourcePathEntry(packageName, PRIORITY_LAST, true));
+                break;
             }
         }
         if (j == resourcePrefixPaths.Size())
@@ -440,9 +527,7 @@ bool Engine::InitializeResourceCache(const VariantMap& parameters, bool removeOl
                     if (dir.StartsWith("."))
                         continue;
 
-                    String autoResourceDir = autoLoadPath + "/" + dir;
-                    if (!cache->AddResourceDir(autoResourceDir, 0))
-                        return false;
+                    entries.Push(ResourcePathEntry(autoLoadPath + "/" + dir, 0, false));
                 }
 
                 // Add all the found package files (non-recursive)
@@ -454,9 +539,7 @@ bool Engine::InitializeResourceCache(const VariantMap& parameters, bool removeOl
                     if (pak.StartsWith("."))
                         continue;
 
-                    String autoPackageName = autoLoadPath + "/" + pak;
-                    if (!cache->AddPackageFile(autoPackageName, 0))
-                        return false;
+                    entries.Push(ResourcePathEntry(autoLoadPath + "/" + pak, 0, true));
                 }
             }
         }
@@ -472,6 +555,52 @@ bool Engine::InitializeResourceCache(const VariantMap& parameters, bool removeOl
                 autoLoadPaths[i].CString());
     }
 
+    // Open the packages in the worker threads. Reading the directories of large packages dominates the startup time
+    // otherwise spent here
+    unsigned numPackages = 0;
+    for (unsigned i = 0; i < entries.Size(); ++i)
+    {
+        if (entries[i].isPackage_)
+        {
+            entries[i].package_ = new PackageFile(context_);
+            ++numPackages;
+        }
+    }
+    if (numPackages > 1)
+    {
+        URHO3D_PROFILE(OpenResourcePackages);
+        GetSubsystem<WorkQueue>()->ParallelFor(entries.Begin().ptr_, entries.End().ptr_, OpenResourcePackagesWork);
+    }
+    else
+        OpenResourcePackages(entries.Begin().ptr_, entries.End().ptr_);
+
+    for (unsigned i = 0; i < entries.Size(); ++i)
+    {
+        ResourcePathEntry& entry = entries[i];
+        if (entry.isPackage_)
+        {
+            // The root cause of the error should have already been logged
+            if (!entry.opened_ || !cache->AddPackageFile(entry.package_, entry.priority_))
+                return false;
+        }
+        else if (!cache->AddResourceDir(entry.name_, entry.priority_))
+            return false;
+    }
+
+    // Queue the preloaded resources to the background loader, so that they load while the rest of the engine and the
+    // application initialize. Requesting them later waits for their loading to finish
+    Vector<String> preloadResources = GetParameter(parameters, EP_PRELOAD_RESOURCES, String::EMPTY).GetString().Split(';');
+    for (unsigned i = 0; i < preloadResources.Size(); ++i)
+    {
+        Vector<String> typeAndName = preloadResources[i].Split(':');
+        if (typeAndName.Size() != 2)
+        {
+            URHO3D_LOGWARNING("Skipped preload resource '{}', the format is 'Type:Name'", preloadResources[i].CString());
+            continue;
+        }
+        cache->BackgroundLoadResource(StringHash(typeAndName[0].Trimmed()), typeAndName[1].Trimmed());
+    }
+
     return true;
 }
 
@@ -501,6 +630,12 @@ void Engine::RunFrame()
     }
 #endif
 
+    // In low latency mode wait for the frame limit now, so that the input sampled at the frame begin does not age during
+    // the wait. The wait also measures the timestep of this frame instead of the next
+    if (lowLatencyInput_)
+        ApplyFrameLimit();
+
+    inputTimer_.Reset();
     time->BeginFrame(timeStep_);
 
     // If pause when minimized -mode is in use, stop updates and audio as necessary
@@ -525,7 +660,8 @@ void Engine::RunFrame()
     }
 
     Render();
-    ApplyFrameLimit();
+    if (!lowLatencyInput_)
+        ApplyFrameLimit();
 
     time->EndFrame();
 
@@ -590,6 +726,21 @@ void Engine::SetPauseMinimized(bool enable)
     pauseMinimized_ = enable;
 }
 
+void Engine::SetLowLatencyInput(bool enable)
+{
+    lowLatencyInput_ = enable;
+}
+
+void Engine::SetLateInputSampling(bool enable)
+{
+    lateInputSampling_ = enable;
+}
+
+void Engine::SetProfilerFrameImages(bool enable)
+{
+    profilerFrameImages_ = enable;
+}
+
 void Engine::SetAutoExit(bool enable)
 {
     // On mobile platforms exit is mandatory if requested by the platform itself and should not be attempted to be disabled
@@ -651,6 +802,15 @@ void Engine::DumpResources(bool dumpFileName)
 #endif
 }
 
+void Engine::DumpGPUMemory()
+{
+#ifdef URHO3D_LOGGING
+    auto* graphics = GetSubsystem<Graphics>();
+    if (graphics)
+        URHO3D_LOGRAW(graphics->PrintGPUMemoryUsage(M_MAX_UNSIGNED) + "\n");
+#endif
+}
+
 void Engine::DumpMemory()
 {
 #ifdef URHO3D_LOGGING
@@ -724,9 +884,49 @@ void Engine::Render()
     if (!graphics->BeginFrame())
         return;
 
+    if (lateInputSampling_)
+    {
+        using namespace LateInput;
+
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_MOUSEMOVE] = GetSubsystem<Input>()->GetPendingMouseMove();
+        SendEvent(E_LATEINPUT, eventData);
+        inputTimer_.Reset();
+    }
+
     GetSubsystem<Renderer>()->Render();
     GetSubsystem<UI>()->Render();
+
+    if (profilerFrameImages_)
+        SendProfilerFrameImage();
+
     graphics->EndFrame();
+
+    inputLatency_ = inputTimer_.GetUSec(false);
+}
+
+void Engine::SendProfilerFrameImage()
+{
+#ifdef URHO3D_TRACY_PROFILING
+    URHO3D_PROFILE(SendProfilerFrameImage);
+
+    auto* graphics = GetSubsystem<Graphics>();
+    SharedPtr<Image> screenshot(new Image(context_));
+    if (!graphics->TakeScreenShot(*screenshot) || !screenshot->GetWidth())
+        return;
+
+    // Tracy requires image dimensions divisible by 4
+    const int width = 320;
+    const int height = (screenshot->GetHeight() * width / screenshot->GetWidth()) & ~3;
+    if (height < 4 || !screenshot->Resize(width, height))
+        return;
+
+    SharedPtr<Image> rgba = screenshot->GetComponents() == 4 ? screenshot : screenshot->ConvertToRGBA();
+    if (!rgba)
+        return;
+
+    URHO3D_PROFILE_FRAME_IMAGE(rgba->GetData(), (unsigned short)width, (unsigned short)height, 0, false);
+#endif
 }
 
 void Engine::ApplyFrameLimit()
@@ -741,6 +941,16 @@ void Engine::ApplyFrameLimit()
 
     long long elapsed = 0;
 
+    // Let subsystems do deferred work in the time remaining until the frame limit
+    {
+        using namespace FrameIdle;
+
+        long long idleTime = maxFps ? Max(1000000LL / maxFps - frameTimer_.GetUSec(false), 0LL) : 0LL;
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_TIMEBUDGET] = (int)idleTime;
+        SendEvent(E_FRAMEIDLE, eventData);
+    }
+
 #ifndef __EMSCRIPTEN__
     // Perform waiting loop if maximum FPS set
 #if !defined(IOS) && !defined(TVOS)
@@ -823,6 +1033,8 @@ VariantMap Engine::ParseParameters(const Vector<String>& arguments)
                 ret[EP_HEADLESS] = true;
             else if (argument == "nolimit")
                 ret[EP_FRAME_LIMITER] = false;
+            else if (argument == "lowlatency")
+                ret[EP_LOW_LATENCY_INPUT] = true;
             else if (argument == "flushgpu")
                 ret[EP_FLUSH_GPU] = true;
             else if (argument == "gl2")
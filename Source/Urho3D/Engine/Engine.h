@@ -70,6 +70,15 @@ public:
     /// Set whether to exit automatically on exit request (window close button).
     /// @property
     void SetAutoExit(bool enable);
+    /// Set whether to wait for the frame limit at the start of the frame, just before input is sampled, instead of after rendering. This reduces input latency by the time spent waiting.
+    /// @property
+    void SetLowLatencyInput(bool enable);
+    /// Set whether to send the E_LATEINPUT event with the pending mouse movement just before rendering, for late camera sampling.
+    /// @property
+    void SetLateInputSampling(bool enable);
+    /// Set whether to send a downscaled screenshot of each rendered frame to the Tracy profiler. Only has effect when built with Tracy profiling. This reads back the backbuffer every frame and is expensive.
+    /// @property
+    void SetProfilerFrameImages(bool enable);
     /// Override timestep of the next frame. Should be called in between RunFrame() calls.
     void SetNextTimeStep(float seconds);
     /// Close the graphics window and set the exit flag. No-op on iOS/tvOS, as an iOS/tvOS application can not legally exit.
@@ -80,6 +89,8 @@ public:
     void DumpResources(bool dumpFileName = false);
     /// Dump information of all memory allocations to the log. Supported in MSVC debug mode only.
     void DumpMemory();
+    /// Dump GPU memory use by category and of all GPU objects to the log.
+    void DumpGPUMemory();
 
     /// Get timestep of the next frame. Updated by ApplyFrameLimit().
     float GetNextTimeStep() const { return timeStep_; }
@@ -108,6 +119,22 @@ public:
     /// @property
     bool GetAutoExit() const { return autoExit_; }
 
+    /// Return whether the frame limit is waited for before input is sampled.
+    /// @property
+    bool GetLowLatencyInput() const { return lowLatencyInput_; }
+
+    /// Return whether late input sampling is enabled.
+    /// @property
+    bool GetLateInputSampling() const { return lateInputSampling_; }
+
+    /// Return whether frame images are sent to the Tracy profiler.
+    /// @property
+    bool GetProfilerFrameImages() const { return profilerFrameImages_; }
+
+    /// Return time in microseconds from the latest input sampling to the end of the frame's present, measured on the last rendered frame.
+    /// @property
+    long long GetInputLatency() const { return inputLatency_; }
+
     /// Return whether engine has been initialized.
     /// @property
     bool IsInitialized() const { return initialized_; }
@@ -140,9 +167,15 @@ private:
     void HandleExitRequested(StringHash eventType, VariantMap& eventData);
     /// Actually perform the exit actions.
     void DoExit();
+    /// Send a downscaled screenshot of the backbuffer to the Tracy profiler.
+    void SendProfilerFrameImage();
 
     /// Frame update timer.
     HiresTimer frameTimer_;
+    /// Timer from the latest input sampling.
+    HiresTimer inputTimer_;
+    /// Input to present latency of the last rendered frame in microseconds.
+    long long inputLatency_;
     /// Previous timesteps for smoothing.
     PODVector<float> lastTimeSteps_;
     /// Next frame timestep in seconds.
@@ -171,6 +204,12 @@ private:
     bool headless_;
     /// Audio paused flag.
     bool audioPaused_;
+    /// Low latency input flag.
+    bool lowLatencyInput_;
+    /// Late input sampling flag.
+    bool lateInputSampling_;
+    /// Profiler frame images flag.
+    bool profilerFrameImages_;
 };
 
 }
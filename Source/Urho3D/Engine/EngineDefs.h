@@ -26,8 +26,11 @@ namespace Urho3D
 {
 
 // Engine parameters
+static const String EP_AUDIO_THREAD_PRIORITY = "AudioThreadPriority";
 static const String EP_AUTOLOAD_PATHS = "AutoloadPaths";
+static const String EP_BACKGROUND_LOAD_THREAD_PRIORITY = "BackgroundLoadThreadPriority";
 static const String EP_BORDERLESS = "Borderless";
+static const String EP_COMPILED_RESOURCE_DIR = "CompiledResourceDir";
 static const String EP_DUMP_SHADERS = "DumpShaders";
 static const String EP_EVENT_PROFILER = "EventProfiler";
 static const String EP_EXTERNAL_WINDOW = "ExternalWindow";
@@ -40,24 +43,34 @@ static const String EP_HIGH_DPI = "HighDPI";
 static const String EP_LOG_LEVEL = "LogLevel";
 static const String EP_LOG_NAME = "LogName";
 static const String EP_LOG_QUIET = "LogQuiet";
+static const String EP_LOW_LATENCY_INPUT = "LowLatencyInput";
 static const String EP_LOW_QUALITY_SHADOWS = "LowQualityShadows";
 static const String EP_MATERIAL_QUALITY = "MaterialQuality";
+static const String EP_MEMORY_MAP_PACKAGES = "MemoryMapPackages";
+static const String EP_METRICS_PORT = "MetricsPort";
 static const String EP_MONITOR = "Monitor";
 static const String EP_MULTI_SAMPLE = "MultiSample";
 static const String EP_ORIENTATIONS = "Orientations";
+static const String EP_PERFORMANCE_CORES = "PerformanceCores";
 static const String EP_PACKAGE_CACHE_DIR = "PackageCacheDir";
+static const String EP_PIPELINED_FRAMES = "PipelinedFrames";
+static const String EP_PRELOAD_RESOURCES = "PreloadResources";
+static const String EP_RELEASE_MODEL_SHADOW_DATA = "ReleaseModelShadowData";
 static const String EP_RENDER_PATH = "RenderPath";
 static const String EP_REFRESH_RATE = "RefreshRate";
 static const String EP_RESOURCE_PACKAGES = "ResourcePackages";
 static const String EP_RESOURCE_PATHS = "ResourcePaths";
 static const String EP_RESOURCE_PREFIX_PATHS = "ResourcePrefixPaths";
+static const String EP_SHADER_ARCHIVE = "ShaderArchive";
 static const String EP_SHADER_CACHE_DIR = "ShaderCacheDir";
 static const String EP_SHADOWS = "Shadows";
 static const String EP_SOUND = "Sound";
 static const String EP_SOUND_BUFFER = "SoundBuffer";
 static const String EP_SOUND_INTERPOLATION = "SoundInterpolation";
+static const String EP_SOUND_MAX_VOICES = "SoundMaxVoices";
 static const String EP_SOUND_MIX_RATE = "SoundMixRate";
 static const String EP_SOUND_STEREO = "SoundStereo";
+static const String EP_STRIP_HEADLESS_RENDER_DATA = "StripHeadlessRenderData";
 static const String EP_TEXTURE_ANISOTROPY = "TextureAnisotropy";
 static const String EP_TEXTURE_FILTER_MODE = "TextureFilterMode";
 static const String EP_TEXTURE_QUALITY = "TextureQuality";
@@ -73,5 +86,8 @@ static const String EP_WINDOW_RESIZABLE = "WindowResizable";
 static const String EP_WINDOW_TITLE = "WindowTitle";
 static const String EP_WINDOW_WIDTH = "WindowWidth";
 static const String EP_WORKER_THREADS = "WorkerThreads";
+static const String EP_WORKER_THREAD_AFFINITY = "WorkerThreadAffinity";
+static const String EP_WORKER_THREAD_PINNING = "WorkerThreadPinning";
+static const String EP_WORKER_THREAD_PRIORITY = "WorkerThreadPriority";
 
 }
@@ -34,4 +34,16 @@ URHO3D_EVENT(E_CONSOLECOMMAND, ConsoleCommand)
     URHO3D_PARAM(P_ID, Id);                        // String
 }
 
+/// Sent at the end of the frame before waiting for the frame limit. Subsystems may use the remaining time for deferred work such as garbage collection, and should subtract the time they spent from the budget.
+URHO3D_EVENT(E_FRAMEIDLE, FrameIdle)
+{
+    URHO3D_PARAM(P_TIMEBUDGET, TimeBudget);        // int, microseconds until the frame limit, or 0 when not limited
+}
+
+/// Sent just before the scene is rendered when late input sampling is enabled. The camera can be adjusted here by the input that arrived during the frame update, for example by the pending mouse movement. The views have already been culled at this point, so the adjustment should be small.
+URHO3D_EVENT(E_LATEINPUT, LateInput)
+{
+    URHO3D_PARAM(P_MOUSEMOVE, MouseMove);          // IntVector2, mouse movement since the input update, reported again on the next frame
+}
+
 }
@@ -26,6 +26,7 @@
 #include "../Core/Profiler.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
+#include "../Graphics/AnimationPoseCache.h"
 #include "../Graphics/AnimationState.h"
 #include "../Graphics/Batch.h"
 #include "../Graphics/Camera.h"
@@ -38,6 +39,7 @@
 #include "../Graphics/Octree.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../IO/Log.h"
+#include "../Math/MathKernels.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 #include "../Scene/Scene.h"
@@ -66,6 +68,8 @@ static bool CompareAnimationOrder(const SharedPtr<AnimationState>& lhs, const Sh
 }
 
 static const unsigned MAX_ANIMATION_STATES = 256;
+/// Steps animation weights are quantized to for pose sharing.
+static const float SHARED_POSE_WEIGHT_STEPS = 64.0f;
 
 AnimatedModel::AnimatedModel(Context* context) :
     StaticModel(context),
@@ -74,6 +78,7 @@ AnimatedModel::AnimatedModel(Context* context) :
     animationLodBias_(1.0f),
     animationLodTimer_(-1.0f),
     animationLodDistance_(0.0f),
+    sharedPoseTimeStep_(0.0f),
     updateInvisible_(false),
     animationDirty_(false),
     animationOrderDirty_(false),
@@ -83,13 +88,31 @@ AnimatedModel::AnimatedModel(Context* context) :
     isMaster_(true),
     loading_(false),
     assignBonesPending_(false),
-    forceAnimationUpdate_(false)
+    forceAnimationUpdate_(false),
+    nodelessPose_(false),
+    computeSkinning_(false),
+    computeSkinningActive_(false),
+    computeMorphs_(false),
+    computeMorphsActive_(false)
 {
 }
 
 AnimatedModel::~AnimatedModel()
 {
     // When being destroyed, remove the bone hierarchy if appropriate (last AnimatedModel in the node)
+    if (nodelessPose_)
+    {
+        // Attached bone nodes are direct children of the model's node
+        const Vector<Bone>& bones = skeleton_.GetBones();
+        for (Vector<Bone>::ConstIterator i = bones.Begin(); i != bones.End(); ++i)
+        {
+            Node* parent = i->node_ ? i->node_->GetParent() : nullptr;
+            if (parent && !parent->GetComponent<AnimatedModel>())
+                i->node_->Remove();
+        }
+        return;
+    }
+
     Bone* rootBone = skeleton_.GetRootBone();
     if (rootBone && rootBone->node_)
     {
@@ -123,6 +146,9 @@ void AnimatedModel::RegisterObject(Context* context)
         .SetMetadata(AttributeMetadata::P_VECTOR_STRUCT_ELEMENTS, animationStatesStructureElementNames);
     URHO3D_ACCESSOR_ATTRIBUTE("Morphs", GetMorphsAttr, SetMorphsAttr, PODVector<unsigned char>, Variant::emptyBuffer,
         AM_DEFAULT | AM_NOEDIT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Nodeless Pose", GetNodelessPose, SetNodelessPose, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Compute Skinning", GetComputeSkinning, SetComputeSkinning, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Compute Morphs", GetComputeMorphs, SetComputeMorphs, bool, false, AM_DEFAULT);
 }
 
 bool AnimatedModel::Load(Deserializer& source)
@@ -178,7 +204,12 @@ void AnimatedModel::ProcessRayQuery(const RayOctreeQuery& query, PODVector<RayQu
     for (unsigned i = 0; i < bones.Size(); ++i)
     {
         const Bone& bone = bones[i];
-        if (!bone.node_)
+        Matrix3x4 transform;
+        if (nodelessPose_ && i < boneModelTransforms_.Size())
+            transform = node_->GetWorldTransform() * boneModelTransforms_[i];
+        else if (bone.node_)
+            transform = bone.node_->GetWorldTransform();
+        else
             continue;
 
         float distance;
@@ -188,7 +219,6 @@ void AnimatedModel::ProcessRayQuery(const RayOctreeQuery& query, PODVector<RayQu
         {
             // Do an initial crude test using the bone's AABB
             const BoundingBox& box = bone.boundingBox_;
-            const Matrix3x4& transform = bone.node_->GetWorldTransform();
             distance = query.ray_.HitDistance(box.Transformed(transform));
             if (distance >= query.maxDistance_)
                 continue;
@@ -204,7 +234,7 @@ void AnimatedModel::ProcessRayQuery(const RayOctreeQuery& query, PODVector<RayQu
         }
         else if (bone.collisionMask_ & BONECOLLISION_SPHERE)
         {
-            boneSphere.center_ = bone.node_->GetWorldPosition();
+            boneSphere.center_ = transform.Translation();
             boneSphere.radius_ = bone.radius_;
             distance = query.ray_.HitDistance(boneSphere);
             if (distance >= query.maxDistance_)
@@ -307,12 +337,17 @@ void AnimatedModel::UpdateGeometry(const FrameInfo& frame)
         UpdateMorphs();
 
     if (skinningDirty_)
+    {
         UpdateSkinning();
+        if (computeSkinningActive_)
+            DispatchComputeSkinning();
+    }
 }
 
 UpdateGeometryType AnimatedModel::GetUpdateGeometryType()
 {
-    if (morphsDirty_ || forceAnimationUpdate_)
+    // Compute skinning issues GPU commands, so it can not be done in a worker thread
+    if (morphsDirty_ || forceAnimationUpdate_ || (skinningDirty_ && computeSkinningActive_))
         return UPDATE_MAIN_THREAD;
     else if (skinningDirty_)
         return UPDATE_WORKER_THREAD;
@@ -325,7 +360,24 @@ void AnimatedModel::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
     if (debug && IsEnabledEffective())
     {
         debug->AddBoundingBox(GetWorldBoundingBox(), Color::GREEN, depthTest);
-        debug->AddSkeleton(skeleton_, Color(0.75f, 0.75f, 0.75f), depthTest);
+
+        const Vector<Bone>& bones = skeleton_.GetBones();
+        if (nodelessPose_ && boneModelTransforms_.Size() == bones.Size())
+        {
+            // There are no bone nodes for DebugRenderer::AddSkeleton(), so draw from the node-free pose instead
+            const Matrix3x4& worldTransform = node_->GetWorldTransform();
+            const Color color(0.75f, 0.75f, 0.75f);
+            for (unsigned i = 0; i < bones.Size(); ++i)
+            {
+                unsigned parentIndex = bones[i].parentIndex_;
+                if (parentIndex == i || parentIndex >= bones.Size())
+                    continue;
+                debug->AddLine(worldTransform * boneModelTransforms_[i].Translation(),
+                    worldTransform * boneModelTransforms_[parentIndex].Translation(), color, depthTest);
+            }
+        }
+        else
+            debug->AddSkeleton(skeleton_, Color(0.75f, 0.75f, 0.75f), depthTest);
     }
 }
 
@@ -398,38 +450,17 @@ void AnimatedModel::SetModel(Model* model, bool createBones)
         skinMatrices_.Resize(skeleton_.GetNumBones());
         SetGeometryBoneMappings();
 
-        // Enable skinning in batches
-        for (unsigned i = 0; i < batches_.Size(); ++i)
-        {
-            if (skinMatrices_.Size())
-            {
-                batches_[i].geometryType_ = GEOM_SKINNED;
-                // Check if model has per-geometry bone mappings
-                if (geometrySkinMatrices_.Size() && geometrySkinMatrices_[i].Size())
-                {
-                    batches_[i].worldTransform_ = &geometrySkinMatrices_[i][0];
-                    batches_[i].numWorldTransforms_ = geometrySkinMatrices_[i].Size();
-                }
-                // If not, use the global skin matrices
-                else
-                {
-                    batches_[i].worldTransform_ = &skinMatrices_[0];
-                    batches_[i].numWorldTransforms_ = skinMatrices_.Size();
-                }
-            }
-            else
-            {
-                batches_[i].geometryType_ = GEOM_STATIC;
-                batches_[i].worldTransform_ = &node_->GetWorldTransform();
-                batches_[i].numWorldTransforms_ = 1;
-            }
-        }
+        // Enable skinning in batches, either in the vertex shader or with compute skinned geometries
+        computeSkinningActive_ = false;
+        UpdateComputeSkinningMode();
     }
     else
     {
         RemoveRootBone(); // Remove existing root bone if any
         SetNumGeometries(0);
         geometryBoneMappings_.Clear();
+        skinnedVertexBuffers_.Clear();
+        computeSkinningActive_ = false;
         morphVertexBuffers_.Clear();
         morphs_.Clear();
         morphElementMask_ = MASK_NONE;
@@ -548,6 +579,138 @@ void AnimatedModel::SetUpdateInvisible(bool enable)
     MarkNetworkUpdate();
 }
 
+void AnimatedModel::SetSharedPoseTimeStep(float timeStep)
+{
+    sharedPoseTimeStep_ = Max(timeStep, 0.0f);
+}
+
+void AnimatedModel::SetNodelessPose(bool enable)
+{
+    if (enable == nodelessPose_)
+        return;
+
+    nodelessPose_ = enable;
+    MarkNetworkUpdate();
+
+    // During loading the bone nodes (if any) are serialized as child nodes, and will be assigned afterward
+    if (loading_ || !isMaster_ || !node_ || !skeleton_.GetNumBones())
+        return;
+
+    // Remove the current bone nodes: either the whole hierarchy, or the nodes attached to the node-free pose
+    Vector<Bone>& bones = skeleton_.GetModifiableBones();
+    for (Vector<Bone>::Iterator i = bones.Begin(); i != bones.End(); ++i)
+    {
+        if (i->node_)
+            i->node_->Remove();
+        i->node_.Reset();
+    }
+
+    if (enable)
+        InitBonePose();
+    else
+        CreateBoneNodes();
+
+    ReassignAnimationStateTracks();
+    MarkAnimationDirty();
+}
+
+void AnimatedModel::SetComputeSkinning(bool enable)
+{
+    if (enable == computeSkinning_)
+        return;
+
+    computeSkinning_ = enable;
+    if (model_)
+        UpdateComputeSkinningMode();
+
+    MarkNetworkUpdate();
+}
+
+void AnimatedModel::SetComputeMorphs(bool enable)
+{
+    if (enable == computeMorphs_)
+        return;
+
+    computeMorphs_ = enable;
+
+    // Recreate existing morph vertex buffers for the new mode, cloning again from the model's geometries
+    if (model_ && !morphVertexBuffers_.Empty())
+    {
+        const Vector<Vector<SharedPtr<Geometry> > >& geometries = model_->GetGeometries();
+        for (unsigned i = 0; i < geometries.Size() && i < geometries_.Size(); ++i)
+            geometries_[i] = geometries[i];
+        CloneGeometries();
+    }
+
+    MarkNetworkUpdate();
+}
+
+Node* AnimatedModel::AttachBoneNode(const String& boneName)
+{
+    if (!node_)
+    {
+        URHO3D_LOGERROR("AnimatedModel not attached to a scene node, can not attach bone nodes");
+        return nullptr;
+    }
+
+    // Non-master models do not evaluate the pose, so attach through the master
+    if (!isMaster_)
+    {
+        auto* master = node_->GetComponent<AnimatedModel>();
+        return master && master != this ? master->AttachBoneNode(boneName) : nullptr;
+    }
+
+    Bone* bone = skeleton_.GetBone(boneName);
+    if (!bone)
+    {
+        URHO3D_LOGERROR("Bone " + boneName + " not found, can not attach bone node");
+        return nullptr;
+    }
+
+    if (bone->node_ || !nodelessPose_)
+        return bone->node_;
+
+    // Create as local like the regular bone nodes, as they are never to be directly synchronized over the network
+    Node* boneNode = node_->CreateChild(bone->name_, LOCAL);
+    boneNode->AddListener(this);
+    boneNode->SetTemporary(IsTemporary());
+    bone->node_ = boneNode;
+
+    // Place at the current pose right away instead of waiting for the next animation update
+    unsigned index = skeleton_.GetBoneIndex(bone);
+    if (index < boneModelTransforms_.Size())
+    {
+        Vector3 position;
+        Quaternion rotation;
+        Vector3 scale;
+        boneModelTransforms_[index].Decompose(position, rotation, scale);
+        boneNode->SetTransform(position, rotation, scale);
+    }
+
+    return boneNode;
+}
+
+void AnimatedModel::DetachBoneNode(const String& boneName)
+{
+    if (!node_)
+        return;
+
+    if (!isMaster_)
+    {
+        auto* master = node_->GetComponent<AnimatedModel>();
+        if (master && master != this)
+            master->DetachBoneNode(boneName);
+        return;
+    }
+
+    Bone* bone = skeleton_.GetBone(boneName);
+    if (!nodelessPose_ || !bone || !bone->node_)
+        return;
+
+    bone->node_->Remove();
+    bone->node_.Reset();
+}
+
 
 void AnimatedModel::SetMorphWeight(unsigned index, float weight)
 {
@@ -691,6 +854,11 @@ AnimationState* AnimatedModel::GetAnimationState(unsigned index) const
     return index < animationStates_.Size() ? animationStates_[index].Get() : nullptr;
 }
 
+const Matrix3x4& AnimatedModel::GetBoneModelTransform(unsigned index) const
+{
+    return index < boneModelTransforms_.Size() ? boneModelTransforms_[index] : Matrix3x4::IDENTITY;
+}
+
 void AnimatedModel::SetSkeleton(const Skeleton& skeleton, bool createBones)
 {
     if (!node_ && createBones)
@@ -710,7 +878,7 @@ void AnimatedModel::SetSkeleton(const Skeleton& skeleton, bool createBones)
 
             for (unsigned i = 0; i < destBones.Size(); ++i)
             {
-                if (destBones[i].node_ && destBones[i].name_ == srcBones[i].name_ && destBones[i].parentIndex_ ==
+                if ((destBones[i].node_ || nodelessPose_) && destBones[i].name_ == srcBones[i].name_ && destBones[i].parentIndex_ ==
                                                                                      srcBones[i].parentIndex_)
                 {
                     // If compatible, just copy the values and retain the old node and animated status
@@ -732,37 +900,32 @@ void AnimatedModel::SetSkeleton(const Skeleton& skeleton, bool createBones)
 
         RemoveAllAnimationStates();
 
-        // Detach the rootbone of the previous model if any
+        // Detach the rootbone of the previous model if any, or the nodes attached to its node-free pose
         if (createBones)
-            RemoveRootBone();
+        {
+            if (nodelessPose_)
+            {
+                const Vector<Bone>& oldBones = skeleton_.GetBones();
+                for (Vector<Bone>::ConstIterator i = oldBones.Begin(); i != oldBones.End(); ++i)
+                {
+                    if (i->node_)
+                        i->node_->Remove();
+                }
+            }
+            else
+                RemoveRootBone();
+        }
 
         skeleton_.Define(skeleton);
 
         // Merge bounding boxes from non-master models
         FinalizeBoneBoundingBoxes();
 
-        Vector<Bone>& bones = skeleton_.GetModifiableBones();
-        // Create scene nodes for the bones
-        if (createBones)
-        {
-            for (Vector<Bone>::Iterator i = bones.Begin(); i != bones.End(); ++i)
-            {
-                // Create bones as local, as they are never to be directly synchronized over the network
-                Node* boneNode = node_->CreateChild(i->name_, LOCAL);
-                boneNode->AddListener(this);
-                boneNode->SetTransform(i->initialPosition_, i->initialRotation_, i->initialScale_);
-                // Copy the model component's temporary status
-                boneNode->SetTemporary(IsTemporary());
-                i->node_ = boneNode;
-            }
+        InitBonePose();
 
-            for (unsigned i = 0; i < bones.Size(); ++i)
-            {
-                unsigned parentIndex = bones[i].parentIndex_;
-                if (parentIndex != i && parentIndex < bones.Size())
-                    bones[parentIndex].node_->AddChild(bones[i].node_);
-            }
-        }
+        // Create scene nodes for the bones, unless evaluating the pose without them
+        if (createBones && !nodelessPose_)
+            CreateBoneNodes();
 
         using namespace BoneHierarchyCreated;
 
@@ -907,11 +1070,29 @@ void AnimatedModel::UpdateBoneBoundingBox()
 {
     if (skeleton_.GetNumBones())
     {
-        // The bone bounding box is in local space, so need the node's inverse transform
         boneBoundingBox_.Clear();
+        const Vector<Bone>& bones = skeleton_.GetBones();
+
+        // The node-free pose is already in local space
+        if (nodelessPose_ && boneModelTransforms_.Size() == bones.Size())
+        {
+            for (unsigned i = 0; i < bones.Size(); ++i)
+            {
+                const Bone& bone = bones[i];
+                if (bone.collisionMask_ & BONECOLLISION_BOX)
+                    boneBoundingBox_.Merge(bone.boundingBox_.Transformed(boneModelTransforms_[i]));
+                else if (bone.collisionMask_ & BONECOLLISION_SPHERE)
+                    boneBoundingBox_.Merge(Sphere(boneModelTransforms_[i].Translation(), bone.radius_ * 0.5f));
+            }
+
+            boneBoundingBoxDirty_ = false;
+            worldBoundingBoxDirty_ = true;
+            return;
+        }
+
+        // The bone bounding box is in local space, so need the node's inverse transform
         Matrix3x4 inverseNodeTransform = node_->GetWorldTransform().Inverse();
 
-        const Vector<Bone>& bones = skeleton_.GetBones();
         for (Vector<Bone>::ConstIterator i = bones.Begin(); i != bones.End(); ++i)
         {
             Node* boneNode = i->node_;
@@ -950,8 +1131,9 @@ void AnimatedModel::OnMarkedDirty(Node* node)
     if (skeleton_.GetNumBones())
     {
         skinningDirty_ = true;
-        // Bone bounding box doesn't need to be marked dirty when only the base scene node moves
-        if (node != node_)
+        // Bone bounding box doesn't need to be marked dirty when only the base scene node moves. The node-free
+        // pose does not depend on the bone nodes, so its bounding box only changes on animation update
+        if (node != node_ && !nodelessPose_)
             boneBoundingBoxDirty_ = true;
     }
 }
@@ -998,16 +1180,11 @@ void AnimatedModel::AssignBoneNodes()
     }
 
     // If no bones found, this may be a prefab where the bone information was left out.
-    // In that case reassign the skeleton now if possible
-    if (!boneFound && model_)
+    // In that case reassign the skeleton now if possible. A node-free pose legitimately has no bone nodes
+    if (!boneFound && model_ && !nodelessPose_)
         SetSkeleton(model_->GetSkeleton(), true);
 
-    // Re-assign the same start bone to animations to get the proper bone node this time
-    for (Vector<SharedPtr<AnimationState> >::Iterator i = animationStates_.Begin(); i != animationStates_.End(); ++i)
-    {
-        AnimationState* state = *i;
-        state->SetStartBone(state->GetStartBone());
-    }
+    ReassignAnimationStateTracks();
 }
 
 void AnimatedModel::FinalizeBoneBoundingBoxes()
@@ -1079,6 +1256,165 @@ void AnimatedModel::RemoveRootBone()
         rootBone->node_->Remove();
 }
 
+void AnimatedModel::CreateBoneNodes()
+{
+    Vector<Bone>& bones = skeleton_.GetModifiableBones();
+    for (Vector<Bone>::Iterator i = bones.Begin(); i != bones.End(); ++i)
+    {
+        // Create bones as local, as they are never to be directly synchronized over the network
+        Node* boneNode = node_->CreateChild(i->name_, LOCAL);
+        boneNode->AddListener(this);
+        boneNode->SetTransform(i->initialPosition_, i->initialRotation_, i->initialScale_);
+        // Copy the model component's temporary status
+        boneNode->SetTemporary(IsTemporary());
+        i->node_ = boneNode;
+    }
+
+    for (unsigned i = 0; i < bones.Size(); ++i)
+    {
+        unsigned parentIndex = bones[i].parentIndex_;
+        if (parentIndex != i && parentIndex < bones.Size())
+            bones[parentIndex].node_->AddChild(bones[i].node_);
+    }
+}
+
+void AnimatedModel::ReassignAnimationStateTracks()
+{
+    // Re-assign the same start bone to animations to get the proper bone node this time
+    for (Vector<SharedPtr<AnimationState> >::Iterator i = animationStates_.Begin(); i != animationStates_.End(); ++i)
+    {
+        AnimationState* state = *i;
+        state->SetStartBone(state->GetStartBone());
+    }
+}
+
+void AnimatedModel::InitBonePose()
+{
+    const Vector<Bone>& bones = skeleton_.GetBones();
+    const unsigned numBones = bones.Size();
+
+    bonePose_.Resize(numBones);
+    boneModelTransforms_.Resize(numBones);
+    boneEvalOrder_.Clear();
+    boneEvalOrder_.Reserve(numBones);
+
+    // Bones are not guaranteed to be stored parents first, so sort them into evaluation order
+    PODVector<bool> added(numBones);
+    for (unsigned i = 0; i < numBones; ++i)
+        added[i] = false;
+
+    while (boneEvalOrder_.Size() < numBones)
+    {
+        unsigned oldSize = boneEvalOrder_.Size();
+        for (unsigned i = 0; i < numBones; ++i)
+        {
+            if (added[i])
+                continue;
+            unsigned parentIndex = bones[i].parentIndex_;
+            if (parentIndex == i || parentIndex >= numBones || added[parentIndex])
+            {
+                boneEvalOrder_.Push(i);
+                added[i] = true;
+            }
+        }
+
+        // Malformed hierarchy with a cycle: evaluate the remaining bones in storage order
+        if (boneEvalOrder_.Size() == oldSize)
+        {
+            for (unsigned i = 0; i < numBones; ++i)
+            {
+                if (!added[i])
+                    boneEvalOrder_.Push(i);
+            }
+        }
+    }
+
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        BonePose& pose = bonePose_[i];
+        pose.position_ = bones[i].initialPosition_;
+        pose.rotation_ = bones[i].initialRotation_;
+        pose.scale_ = bones[i].initialScale_;
+    }
+
+    UpdateBonePose();
+}
+
+void AnimatedModel::ResetBonePose()
+{
+    const Vector<Bone>& bones = skeleton_.GetBones();
+    for (unsigned i = 0; i < bones.Size() && i < bonePose_.Size(); ++i)
+    {
+        const Bone& bone = bones[i];
+        if (bone.animated_)
+        {
+            BonePose& pose = bonePose_[i];
+            pose.position_ = bone.initialPosition_;
+            pose.rotation_ = bone.initialRotation_;
+            pose.scale_ = bone.initialScale_;
+        }
+    }
+}
+
+void AnimatedModel::UpdateBonePose()
+{
+    const Vector<Bone>& bones = skeleton_.GetBones();
+    if (boneEvalOrder_.Size() != bones.Size())
+        return;
+
+    for (unsigned i = 0; i < boneEvalOrder_.Size(); ++i)
+    {
+        unsigned index = boneEvalOrder_[i];
+        const Bone& bone = bones[index];
+        Node* boneNode = bone.node_;
+        Matrix3x4& modelTransform = boneModelTransforms_[index];
+
+        // An attached node of a bone with animation disabled drives the pose instead of following it
+        if (boneNode && !bone.animated_)
+        {
+            modelTransform = boneNode->GetTransform();
+            continue;
+        }
+
+        const BonePose& pose = bonePose_[index];
+        unsigned parentIndex = bone.parentIndex_;
+        if (parentIndex != index && parentIndex < bones.Size())
+            modelTransform = boneModelTransforms_[parentIndex] * Matrix3x4(pose.position_, pose.rotation_, pose.scale_);
+        else
+            modelTransform = Matrix3x4(pose.position_, pose.rotation_, pose.scale_);
+
+        if (boneNode)
+        {
+            Vector3 position;
+            Quaternion rotation;
+            Vector3 scale;
+            modelTransform.Decompose(position, rotation, scale);
+            boneNode->SetTransformSilent(position, rotation, scale);
+        }
+    }
+}
+
+void AnimatedModel::UpdateMasterBoneIndices(const AnimatedModel* master)
+{
+    const Vector<Bone>& bones = skeleton_.GetBones();
+    const Vector<Bone>& masterBones = master->skeleton_.GetBones();
+
+    if (masterBoneIndices_.Size() != bones.Size())
+    {
+        masterBoneIndices_.Resize(bones.Size());
+        for (unsigned i = 0; i < masterBoneIndices_.Size(); ++i)
+            masterBoneIndices_[i] = M_MAX_UNSIGNED;
+    }
+
+    // Only search again when the cached index no longer refers to the same bone
+    for (unsigned i = 0; i < bones.Size(); ++i)
+    {
+        unsigned masterIndex = masterBoneIndices_[i];
+        if (masterIndex >= masterBones.Size() || masterBones[masterIndex].nameHash_ != bones[i].nameHash_)
+            masterBoneIndices_[i] = master->skeleton_.GetBoneIndex(bones[i].nameHash_);
+    }
+}
+
 void AnimatedModel::MarkAnimationDirty()
 {
     if (isMaster_)
@@ -1108,6 +1444,15 @@ void AnimatedModel::CloneGeometries()
     HashMap<VertexBuffer*, SharedPtr<VertexBuffer> > clonedVertexBuffers;
     morphVertexBuffers_.Resize(originalVertexBuffers.Size());
 
+    // Compute morphing reads the original buffers and the model's morph deltas on the GPU
+    auto* graphics = GetSubsystem<Graphics>();
+    computeMorphsActive_ = computeMorphs_ && graphics && graphics->GetComputeSkinningSupport();
+    for (unsigned i = 0; i < originalVertexBuffers.Size() && computeMorphsActive_; ++i)
+    {
+        if (model_->GetMorphRangeCount(i) && (originalVertexBuffers[i]->IsDynamic() || !model_->GetMorphDeltaBuffer(i)))
+            computeMorphsActive_ = false;
+    }
+
     for (unsigned i = 0; i < originalVertexBuffers.Size(); ++i)
     {
         VertexBuffer* original = originalVertexBuffers[i];
@@ -1115,7 +1460,13 @@ void AnimatedModel::CloneGeometries()
         {
             SharedPtr<VertexBuffer> clone(new VertexBuffer(context_));
             clone->SetShadowed(true);
-            clone->SetSize(original->GetVertexCount(), morphElementMask_ & original->GetElementMask(), true);
+            // Buffers written by compute shaders can not be dynamic
+            if (computeMorphsActive_)
+            {
+                original->SetComputeAccess(true);
+                clone->SetComputeAccess(true);
+            }
+            clone->SetSize(original->GetVertexCount(), morphElementMask_ & original->GetElementMask(), !computeMorphsActive_);
             void* dest = clone->Lock(0, original->GetVertexCount());
             if (dest)
             {
@@ -1178,6 +1529,191 @@ void AnimatedModel::CloneGeometries()
     MarkMorphsDirty();
 }
 
+void AnimatedModel::SetSkinningBatches()
+{
+    for (unsigned i = 0; i < batches_.Size(); ++i)
+    {
+        if (computeSkinningActive_)
+        {
+            // The skinned vertices are already in world space
+            batches_[i].geometryType_ = GEOM_STATIC;
+            batches_[i].worldTransform_ = &Matrix3x4::IDENTITY;
+            batches_[i].numWorldTransforms_ = 1;
+        }
+        else if (skinMatrices_.Size())
+        {
+            batches_[i].geometryType_ = GEOM_SKINNED;
+            // Check if model has per-geometry bone mappings
+            if (geometrySkinMatrices_.Size() && geometrySkinMatrices_[i].Size())
+            {
+                batches_[i].worldTransform_ = &geometrySkinMatrices_[i][0];
+                batches_[i].numWorldTransforms_ = geometrySkinMatrices_[i].Size();
+            }
+            // If not, use the global skin matrices
+            else
+            {
+                batches_[i].worldTransform_ = &skinMatrices_[0];
+                batches_[i].numWorldTransforms_ = skinMatrices_.Size();
+            }
+        }
+        else
+        {
+            batches_[i].geometryType_ = GEOM_STATIC;
+            batches_[i].worldTransform_ = &node_->GetWorldTransform();
+            batches_[i].numWorldTransforms_ = 1;
+        }
+    }
+}
+
+void AnimatedModel::UpdateComputeSkinningMode()
+{
+    bool wasActive = computeSkinningActive_;
+    computeSkinningActive_ = false;
+    skinnedVertexBuffers_.Clear();
+
+    // Morphs are applied to the vertex buffers on the CPU, so morphable models keep vertex shader skinning
+    auto* graphics = GetSubsystem<Graphics>();
+    if (computeSkinning_ && skinMatrices_.Size() && morphs_.Empty() && graphics && graphics->GetComputeSkinningSupport())
+    {
+        const Vector<SharedPtr<VertexBuffer> >& originalVertexBuffers = model_->GetVertexBuffers();
+        skinnedVertexBuffers_.Resize(originalVertexBuffers.Size());
+
+        for (unsigned i = 0; i < originalVertexBuffers.Size(); ++i)
+        {
+            VertexBuffer* original = originalVertexBuffers[i];
+            // The original buffer is recreated from its shadow data when compute access is first enabled
+            if (!original->IsShadowed() || original->IsDynamic() || !original->HasElement(TYPE_VECTOR3, SEM_POSITION) ||
+                !original->HasElement(TYPE_VECTOR4, SEM_BLENDWEIGHTS) || !original->HasElement(TYPE_UBYTE4, SEM_BLENDINDICES))
+                continue;
+            // Packed normals or tangents are decoded only in the vertex shader; keep skinning them there
+            if ((original->HasElement(SEM_NORMAL) && !original->HasElement(TYPE_VECTOR3, SEM_NORMAL)) ||
+                (original->HasElement(SEM_TANGENT) && !original->HasElement(TYPE_VECTOR4, SEM_TANGENT)))
+                continue;
+            original->SetComputeAccess(true);
+
+            VertexMaskFlags mask = MASK_POSITION;
+            if (original->HasElement(TYPE_VECTOR3, SEM_NORMAL))
+                mask |= MASK_NORMAL;
+            if (original->HasElement(TYPE_VECTOR4, SEM_TANGENT))
+                mask |= MASK_TANGENT;
+
+            SharedPtr<VertexBuffer> skinned(new VertexBuffer(context_));
+            skinned->SetComputeAccess(true);
+            if (skinned->SetSize(original->GetVertexCount(), mask))
+            {
+                skinnedVertexBuffers_[i] = skinned;
+                computeSkinningActive_ = true;
+            }
+        }
+
+        if (!computeSkinningActive_)
+            skinnedVertexBuffers_.Clear();
+    }
+
+    if (computeSkinningActive_ || wasActive)
+    {
+        const Vector<SharedPtr<VertexBuffer> >& originalVertexBuffers = model_->GetVertexBuffers();
+        const Vector<Vector<SharedPtr<Geometry> > >& geometries = model_->GetGeometries();
+
+        for (unsigned i = 0; i < geometries.Size() && i < geometries_.Size(); ++i)
+        {
+            for (unsigned j = 0; j < geometries[i].Size() && j < geometries_[i].Size(); ++j)
+            {
+                Geometry* original = geometries[i][j];
+                if (!computeSkinningActive_)
+                {
+                    geometries_[i][j] = original;
+                    continue;
+                }
+
+                // Like morph clones, add the skinned vertex buffer at a greater index to override the original positions,
+                // normals and tangents
+                SharedPtr<Geometry> clone(new Geometry(context_));
+                PODVector<VertexBuffer*> buffers;
+                for (unsigned k = 0; k < original->GetNumVertexBuffers(); ++k)
+                {
+                    VertexBuffer* originalBuffer = original->GetVertexBuffer(k);
+                    buffers.Push(originalBuffer);
+                    for (unsigned l = 0; l < originalVertexBuffers.Size(); ++l)
+                    {
+                        if (originalVertexBuffers[l] == originalBuffer && skinnedVertexBuffers_[l])
+                            buffers.Push(skinnedVertexBuffers_[l]);
+                    }
+                }
+
+                clone->SetNumVertexBuffers(buffers.Size());
+                for (unsigned k = 0; k < buffers.Size(); ++k)
+                    clone->SetVertexBuffer(k, buffers[k]);
+                clone->SetIndexBuffer(original->GetIndexBuffer());
+                clone->SetDrawRange(original->GetPrimitiveType(), original->GetIndexStart(), original->GetIndexCount(),
+                    original->GetVertexStart(), original->GetVertexCount());
+                clone->SetLodDistance(original->GetLodDistance());
+
+                geometries_[i][j] = clone;
+            }
+        }
+
+        ResetLodLevels();
+    }
+
+    SetSkinningBatches();
+    skinningDirty_ = true;
+}
+
+void AnimatedModel::DispatchComputeSkinning()
+{
+    auto* graphics = GetSubsystem<Graphics>();
+    if (!graphics || !model_)
+        return;
+
+    URHO3D_PROFILE(DispatchComputeSkinning);
+
+    const Vector<SharedPtr<VertexBuffer> >& originalVertexBuffers = model_->GetVertexBuffers();
+    bool success = true;
+
+    if (geometrySkinMatrices_.Size())
+    {
+        // Blend indices refer to the bone mapping of each subgeometry, so skin the vertex range of each geometry with its
+        // own matrices
+        const Vector<Vector<SharedPtr<Geometry> > >& geometries = model_->GetGeometries();
+        for (unsigned i = 0; i < geometries.Size(); ++i)
+        {
+            const PODVector<Matrix3x4>& matrices = geometrySkinMatrices_[i].Size() ? geometrySkinMatrices_[i] : skinMatrices_;
+
+            for (unsigned j = 0; j < geometries[i].Size(); ++j)
+            {
+                Geometry* geometry = geometries[i][j];
+                for (unsigned k = 0; k < geometry->GetNumVertexBuffers(); ++k)
+                {
+                    VertexBuffer* buffer = geometry->GetVertexBuffer(k);
+                    for (unsigned l = 0; l < originalVertexBuffers.Size(); ++l)
+                    {
+                        if (originalVertexBuffers[l] == buffer && skinnedVertexBuffers_[l])
+                        {
+                            success &= graphics->SkinVertices(buffer, skinnedVertexBuffers_[l], geometry->GetVertexStart(),
+                                geometry->GetVertexCount(), &matrices[0], matrices.Size());
+                        }
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        for (unsigned i = 0; i < skinnedVertexBuffers_.Size(); ++i)
+        {
+            if (skinnedVertexBuffers_[i])
+            {
+                success &= graphics->SkinVertices(originalVertexBuffers[i], skinnedVertexBuffers_[i], 0,
+                    originalVertexBuffers[i]->GetVertexCount(), &skinMatrices_[0], skinMatrices_.Size());
+            }
+        }
+    }
+
+    if (!success)
+        URHO3D_LOGERROR("Failed to compute skin vertices of model " + model_->GetName());
+}
+
 void AnimatedModel::CopyMorphVertices(void* destVertexData, void* srcVertexData, unsigned vertexCount, VertexBuffer* destBuffer,
     VertexBuffer* srcBuffer)
 {
@@ -1286,9 +1822,51 @@ void AnimatedModel::ApplyAnimation()
     // (first AnimatedModel in a node)
     if (isMaster_)
     {
-        skeleton_.ResetSilent();
-        for (Vector<SharedPtr<AnimationState> >::Iterator i = animationStates_.Begin(); i != animationStates_.End(); ++i)
-            (*i)->Apply();
+        // Reuse the pose of a model that played identical animations this frame if possible
+        auto* poseCache = sharedPoseTimeStep_ > 0.0f ? GetSubsystem<AnimationPoseCache>() : nullptr;
+        PODVector<unsigned> poseKey;
+        if (poseCache && !GetSharedPoseKey(poseKey))
+            poseCache = nullptr;
+
+        bool poseReused = false;
+        if (poseCache)
+        {
+            if (nodelessPose_)
+                poseReused = poseCache->GetPose(poseKey, bonePose_);
+            else
+            {
+                PODVector<BonePose> pose;
+                poseReused = poseCache->GetPose(poseKey, pose);
+                if (poseReused)
+                    SetBoneNodePose(pose);
+            }
+        }
+
+        if (!poseReused)
+        {
+            if (nodelessPose_)
+                ResetBonePose();
+            else
+                skeleton_.ResetSilent();
+            for (Vector<SharedPtr<AnimationState> >::Iterator i = animationStates_.Begin(); i != animationStates_.End(); ++i)
+                (*i)->Apply();
+
+            if (poseCache)
+            {
+                if (nodelessPose_)
+                    poseCache->StorePose(poseKey, bonePose_);
+                else
+                {
+                    PODVector<BonePose> pose;
+                    GetBoneNodePose(pose);
+                    poseCache->StorePose(poseKey, pose);
+                }
+            }
+        }
+
+        // Evaluate the node-free model-space transforms, which also moves the attached bone nodes
+        if (nodelessPose_)
+            UpdateBonePose();
 
         // Skeleton reset and animations apply the node transforms "silently" to avoid repeated marking dirty. Mark dirty now
         node_->MarkDirty();
@@ -1300,6 +1878,73 @@ void AnimatedModel::ApplyAnimation()
     animationDirty_ = false;
 }
 
+bool AnimatedModel::GetSharedPoseKey(PODVector<unsigned>& key) const
+{
+    key.Clear();
+    if (!model_)
+        return false;
+
+    // Bones driven by their nodes instead of the animation keep a pose of their own
+    const Vector<Bone>& bones = skeleton_.GetBones();
+    for (Vector<Bone>::ConstIterator i = bones.Begin(); i != bones.End(); ++i)
+    {
+        if (!i->animated_ || (!nodelessPose_ && !i->node_))
+            return false;
+    }
+
+    // The same model resource guarantees the same skeleton
+    auto modelAddress = (unsigned long long)(size_t)model_.Get();
+    key.Push((unsigned)modelAddress);
+    key.Push((unsigned)(modelAddress >> 32u));
+    key.Push(nodelessPose_ ? 1 : 0);
+
+    for (Vector<SharedPtr<AnimationState> >::ConstIterator i = animationStates_.Begin(); i != animationStates_.End(); ++i)
+    {
+        const AnimationState* state = *i;
+        if (!state->GetAnimation() || !state->IsEnabled())
+            continue;
+        if (state->HasBoneWeights())
+            return false;
+
+        auto animationAddress = (unsigned long long)(size_t)state->GetAnimation();
+        Bone* startBone = state->GetStartBone();
+        key.Push((unsigned)animationAddress);
+        key.Push((unsigned)(animationAddress >> 32u));
+        key.Push((unsigned)(state->GetTime() / sharedPoseTimeStep_));
+        key.Push((unsigned)RoundToInt(state->GetWeight() * SHARED_POSE_WEIGHT_STEPS));
+        key.Push((unsigned)state->GetBlendMode() | (state->IsLooped() ? 0x100u : 0u));
+        key.Push(startBone ? startBone->nameHash_.Value() : 0);
+    }
+
+    return true;
+}
+
+void AnimatedModel::GetBoneNodePose(PODVector<BonePose>& pose) const
+{
+    const Vector<Bone>& bones = skeleton_.GetBones();
+    pose.Resize(bones.Size());
+
+    for (unsigned i = 0; i < bones.Size(); ++i)
+    {
+        if (Node* boneNode = bones[i].node_)
+        {
+            pose[i].position_ = boneNode->GetPosition();
+            pose[i].rotation_ = boneNode->GetRotation();
+            pose[i].scale_ = boneNode->GetScale();
+        }
+    }
+}
+
+void AnimatedModel::SetBoneNodePose(const PODVector<BonePose>& pose)
+{
+    const Vector<Bone>& bones = skeleton_.GetBones();
+    for (unsigned i = 0; i < bones.Size() && i < pose.Size(); ++i)
+    {
+        if (Node* boneNode = bones[i].node_)
+            boneNode->SetTransformSilent(pose[i].position_, pose[i].rotation_, pose[i].scale_);
+    }
+}
+
 void AnimatedModel::UpdateSkinning()
 {
     // Note: the model's world transform will be baked in the skin matrices
@@ -1307,30 +1952,59 @@ void AnimatedModel::UpdateSkinning()
     // Use model's world transform in case a bone is missing
     const Matrix3x4& worldTransform = node_->GetWorldTransform();
 
-    // Skinning with global matrices only
-    if (!geometrySkinMatrices_.Size())
+    const unsigned numBones = bones.Size();
+    if (!numBones)
+    {
+        skinningDirty_ = false;
+        return;
+    }
+
+    // Gather the bone transforms first, so that the products with the offset matrices can be computed in one batch
+    // The node-free pose is evaluated by the master model. Non-master models skin from it by bone name
+    const AnimatedModel* master = isMaster_ ? this : node_->GetComponent<AnimatedModel>();
+    if (master && master->nodelessPose_ && master->boneModelTransforms_.Size())
     {
-        for (unsigned i = 0; i < bones.Size(); ++i)
+        if (master != this)
+            UpdateMasterBoneIndices(master);
+
+        const PODVector<Matrix3x4>& modelTransforms = master->boneModelTransforms_;
+        for (unsigned i = 0; i < numBones; ++i)
         {
-            const Bone& bone = bones[i];
-            if (bone.node_)
-                skinMatrices_[i] = bone.node_->GetWorldTransform() * bone.offsetMatrix_;
-            else
+            unsigned poseIndex = master == this ? i : masterBoneIndices_[i];
+            skinMatrices_[i] = poseIndex < modelTransforms.Size() ? modelTransforms[poseIndex] : Matrix3x4::IDENTITY;
+        }
+
+        MultiplyMatrices(&skinMatrices_[0], &bones[0].offsetMatrix_, &skinMatrices_[0], numBones, sizeof(Matrix3x4),
+            sizeof(Bone));
+        MultiplyMatrices(worldTransform, &skinMatrices_[0], &skinMatrices_[0], numBones);
+
+        for (unsigned i = 0; i < numBones; ++i)
+        {
+            unsigned poseIndex = master == this ? i : masterBoneIndices_[i];
+            if (poseIndex >= modelTransforms.Size())
                 skinMatrices_[i] = worldTransform;
         }
     }
-    // Skinning with per-geometry matrices
     else
     {
-        for (unsigned i = 0; i < bones.Size(); ++i)
+        for (unsigned i = 0; i < numBones; ++i)
+            skinMatrices_[i] = bones[i].node_ ? bones[i].node_->GetWorldTransform() : Matrix3x4::IDENTITY;
+
+        MultiplyMatrices(&skinMatrices_[0], &bones[0].offsetMatrix_, &skinMatrices_[0], numBones, sizeof(Matrix3x4),
+            sizeof(Bone));
+
+        for (unsigned i = 0; i < numBones; ++i)
         {
-            const Bone& bone = bones[i];
-            if (bone.node_)
-                skinMatrices_[i] = bone.node_->GetWorldTransform() * bone.offsetMatrix_;
-            else
+            if (!bones[i].node_)
                 skinMatrices_[i] = worldTransform;
+        }
+    }
 
-            // Copy the skin matrix to per-geometry matrices as needed
+    // Copy the skin matrices to per-geometry matrices as needed
+    if (geometrySkinMatrices_.Size())
+    {
+        for (unsigned i = 0; i < numBones; ++i)
+        {
             for (unsigned j = 0; j < geometrySkinMatrixPtrs_[i].Size(); ++j)
                 *geometrySkinMatrixPtrs_[i][j] = skinMatrices_[i];
         }
@@ -1351,7 +2025,7 @@ void AnimatedModel::UpdateMorphs()
         for (unsigned i = 0; i < morphVertexBuffers_.Size(); ++i)
         {
             VertexBuffer* buffer = morphVertexBuffers_[i];
-            if (buffer)
+            if (buffer && !(computeMorphsActive_ && ApplyComputeMorphs(i)))
             {
                 VertexBuffer* originalBuffer = model_->GetVertexBuffers()[i];
                 unsigned morphStart = model_->GetMorphRangeStart(i);
@@ -1383,6 +2057,32 @@ void AnimatedModel::UpdateMorphs()
     morphsDirty_ = false;
 }
 
+bool AnimatedModel::ApplyComputeMorphs(unsigned bufferIndex)
+{
+    // Pass only the active morphs, along with their delta block in the model's delta buffer
+    PODVector<unsigned> deltaBlocks;
+    PODVector<float> weights;
+    unsigned block = 0;
+    for (unsigned i = 0; i < morphs_.Size(); ++i)
+    {
+        if (!morphs_[i].buffers_.Contains(bufferIndex))
+            continue;
+        if (morphs_[i].weight_ != 0.0f)
+        {
+            deltaBlocks.Push(block);
+            weights.Push(morphs_[i].weight_);
+        }
+        ++block;
+    }
+
+    if (deltaBlocks.Size() > MAX_COMPUTE_MORPHS)
+        return false;
+
+    return GetSubsystem<Graphics>()->MorphVertices(model_->GetVertexBuffers()[bufferIndex], morphVertexBuffers_[bufferIndex],
+        model_->GetMorphDeltaBuffer(bufferIndex), model_->GetMorphRangeStart(bufferIndex), model_->GetMorphRangeCount(bufferIndex),
+        deltaBlocks.Empty() ? nullptr : &deltaBlocks[0], weights.Empty() ? nullptr : &weights[0], deltaBlocks.Size());
+}
+
 void AnimatedModel::ApplyMorph(VertexBuffer* buffer, void* destVertexData, unsigned morphRangeStart, const VertexBufferMorph& morph,
     float weight)
 {
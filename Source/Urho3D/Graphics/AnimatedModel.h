@@ -32,6 +32,17 @@ namespace Urho3D
 class Animation;
 class AnimationState;
 
+/// Local-space transform of a bone in a node-free pose.
+struct BonePose
+{
+    /// Position.
+    Vector3 position_;
+    /// Rotation.
+    Quaternion rotation_;
+    /// Scale.
+    Vector3 scale_;
+};
+
 /// Animated model component.
 class URHO3D_API AnimatedModel : public StaticModel
 {
@@ -102,6 +113,22 @@ public:
     void ResetMorphWeights();
     /// Apply all animation states to nodes.
     void ApplyAnimation();
+    /// Set whether to evaluate the skeleton pose into flat bone arrays instead of a bone node hierarchy. Enabling removes the existing bone nodes; nodes are then only created for bones attached with AttachBoneNode(). Has an effect on the master model only.
+    /// @property
+    void SetNodelessPose(bool enable);
+    /// Create or return a scene node that follows a bone of the node-free pose. The node is created as a local direct child of the model's scene node. If the bone's animation is disabled, the node instead drives the bone. In the regular bone hierarchy mode, returns the existing bone node.
+    Node* AttachBoneNode(const String& boneName);
+    /// Remove a node created with AttachBoneNode(). Has no effect in the regular bone hierarchy mode.
+    void DetachBoneNode(const String& boneName);
+    /// Set the time step the animation times are quantized to for sharing the pose with other models of the same model resource that play identical animations. Zero disables sharing. Called by AnimationController. Has an effect on the master model only.
+    /// @nobind
+    void SetSharedPoseTimeStep(float timeStep);
+    /// Set whether to skin the vertices once per frame with a compute shader into a per-model vertex buffer, which all render passes then draw without skinning. Falls back to vertex shader skinning if compute skinning is not supported or the model has vertex morphs.
+    /// @property
+    void SetComputeSkinning(bool enable);
+    /// Set whether to blend vertex morphs with a compute shader instead of on the CPU. Falls back to CPU morphing if compute shaders are not supported, or for a frame where more than MAX_COMPUTE_MORPHS morphs of a vertex buffer are active.
+    /// @property
+    void SetComputeMorphs(bool enable);
 
     /// Return skeleton.
     /// @property
@@ -132,6 +159,27 @@ public:
     /// @property
     bool GetUpdateInvisible() const { return updateInvisible_; }
 
+    /// Return whether the skeleton pose is evaluated without bone nodes.
+    /// @property
+    bool GetNodelessPose() const { return nodelessPose_; }
+
+    /// Return model-space transform of a bone in the node-free pose, or identity if not available.
+    const Matrix3x4& GetBoneModelTransform(unsigned index) const;
+
+    /// Return the animation time step for pose sharing, or zero if disabled.
+    float GetSharedPoseTimeStep() const { return sharedPoseTimeStep_; }
+
+    /// Return whether compute skinning is requested.
+    /// @property
+    bool GetComputeSkinning() const { return computeSkinning_; }
+
+    /// Return whether the vertices are currently skinned with a compute shader.
+    bool IsComputeSkinningActive() const { return computeSkinningActive_; }
+
+    /// Return whether compute morphing is requested.
+    /// @property
+    bool GetComputeMorphs() const { return computeMorphs_; }
+
     /// Return all vertex morphs.
     const Vector<ModelMorph>& GetMorphs() const { return morphs_; }
 
@@ -194,6 +242,18 @@ private:
     void FinalizeBoneBoundingBoxes();
     /// Remove (old) skeleton root bone.
     void RemoveRootBone();
+    /// Create scene nodes for the whole bone hierarchy.
+    void CreateBoneNodes();
+    /// Reassign animation state tracks after the bone nodes have changed.
+    void ReassignAnimationStateTracks();
+    /// Size the node-free pose arrays to the skeleton and compute the bone evaluation order.
+    void InitBonePose();
+    /// Reset the node-free pose of animated bones to the initial pose.
+    void ResetBonePose();
+    /// Evaluate node-free model-space bone transforms and synchronize the attached bone nodes.
+    void UpdateBonePose();
+    /// Refresh the mapping from own bones to the master model's bones for skinning from a node-free pose.
+    void UpdateMasterBoneIndices(const AnimatedModel* master);
     /// Mark animation and skinning to require an update.
     void MarkAnimationDirty();
     /// Mark animation and skinning to require a forced update (blending order changed).
@@ -206,14 +266,28 @@ private:
     void SetGeometryBoneMappings();
     /// Clone geometries for vertex morphing.
     void CloneGeometries();
+    /// Set the geometry type and world transforms of the batches for the current skinning mode.
+    void SetSkinningBatches();
+    /// Switch between compute and vertex shader skinning according to the request and support, recreating the skinned vertex buffers and geometries.
+    void UpdateComputeSkinningMode();
+    /// Skin the vertices into the skinned vertex buffers with a compute shader.
+    void DispatchComputeSkinning();
     /// Copy morph vertices.
     void CopyMorphVertices(void* destVertexData, void* srcVertexData, unsigned vertexCount, VertexBuffer* destBuffer, VertexBuffer* srcBuffer);
     /// Recalculate animations. Called from Update().
     void UpdateAnimation(const FrameInfo& frame);
+    /// Build the key identifying the current animation playback for pose sharing. Return false if the pose can not be shared.
+    bool GetSharedPoseKey(PODVector<unsigned>& key) const;
+    /// Read the local transforms of the bone nodes.
+    void GetBoneNodePose(PODVector<BonePose>& pose) const;
+    /// Set the local transforms of the bone nodes silently.
+    void SetBoneNodePose(const PODVector<BonePose>& pose);
     /// Recalculate skinning.
     void UpdateSkinning();
     /// Reapply all vertex morphs.
     void UpdateMorphs();
+    /// Reapply the vertex morphs of a vertex buffer with a compute shader. Return true on success.
+    bool ApplyComputeMorphs(unsigned bufferIndex);
     /// Apply a vertex morph.
     void ApplyMorph
         (VertexBuffer* buffer, void* destVertexData, unsigned morphRangeStart, const VertexBufferMorph& morph, float weight);
@@ -224,6 +298,8 @@ private:
     Skeleton skeleton_;
     /// Morph vertex buffers.
     Vector<SharedPtr<VertexBuffer> > morphVertexBuffers_;
+    /// Compute skinned vertex buffers per model vertex buffer, null if the buffer is not skinned.
+    Vector<SharedPtr<VertexBuffer> > skinnedVertexBuffers_;
     /// Vertex morphs.
     Vector<ModelMorph> morphs_;
     /// Animation states.
@@ -236,6 +312,14 @@ private:
     Vector<PODVector<Matrix3x4> > geometrySkinMatrices_;
     /// Subgeometry skinning matrix pointers, if more bones than skinning shader can manage.
     Vector<PODVector<Matrix3x4*> > geometrySkinMatrixPtrs_;
+    /// Node-free local-space bone pose.
+    PODVector<BonePose> bonePose_;
+    /// Node-free model-space bone transforms.
+    PODVector<Matrix3x4> boneModelTransforms_;
+    /// Node-free pose evaluation order, parents before children.
+    PODVector<unsigned> boneEvalOrder_;
+    /// Matching master model bone indices, used by non-master models skinned from a node-free pose.
+    PODVector<unsigned> masterBoneIndices_;
     /// Bounding box calculated from bones.
     BoundingBox boneBoundingBox_;
     /// Attribute buffer.
@@ -250,6 +334,8 @@ private:
     float animationLodTimer_;
     /// Animation LOD distance, the minimum of all LOD view distances last frame.
     float animationLodDistance_;
+    /// Animation time step for pose sharing, zero if disabled.
+    float sharedPoseTimeStep_;
     /// Update animation when invisible flag.
     bool updateInvisible_;
     /// Animation dirty flag.
@@ -270,6 +356,16 @@ private:
     bool assignBonesPending_;
     /// Force animation update after becoming visible flag.
     bool forceAnimationUpdate_;
+    /// Node-free pose evaluation flag.
+    bool nodelessPose_;
+    /// Compute skinning requested flag.
+    bool computeSkinning_;
+    /// Compute skinning in use flag.
+    bool computeSkinningActive_;
+    /// Compute morphing requested flag.
+    bool computeMorphs_;
+    /// Compute morphing in use flag.
+    bool computeMorphsActive_;
 };
 
 }
@@ -49,6 +49,256 @@ inline bool CompareKeyFrames(AnimationKeyFrame& lhs, AnimationKeyFrame& rhs)
     return lhs.time_ < rhs.time_;
 }
 
+/// Quantization steps of compressed key times and position and scale values.
+static const float MAX_QUANTIZED_KEY = 65535.0f;
+/// Quantization steps of compressed rotation components.
+static const float MAX_QUANTIZED_ROTATION = 32767.0f;
+/// Bound of the three smallest components of a normalized quaternion.
+static const float SMALLEST_THREE_BOUND = 0.70710678f;
+/// Indices of the compressed position, rotation and scale channels.
+static const unsigned POSITION_CHANNEL = 0;
+static const unsigned ROTATION_CHANNEL = 1;
+static const unsigned SCALE_CHANNEL = 2;
+
+/// Interpolate between position or scale keys.
+static Vector3 InterpolateKey(const Vector3& lhs, const Vector3& rhs, float t)
+{
+    return lhs.Lerp(rhs, t);
+}
+
+/// Interpolate between rotation keys.
+static Quaternion InterpolateKey(const Quaternion& lhs, const Quaternion& rhs, float t)
+{
+    return lhs.Slerp(rhs, t);
+}
+
+/// Return the distance between position or scale keys.
+static float GetKeyError(const Vector3& lhs, const Vector3& rhs)
+{
+    return (lhs - rhs).Length();
+}
+
+/// Return the angle in radians between rotation keys.
+static float GetKeyError(const Quaternion& lhs, const Quaternion& rhs)
+{
+    return 2.0f * acosf(Min(Abs(lhs.DotProduct(rhs)), 1.0f));
+}
+
+/// Select the keys to keep so that interpolating between them reproduces the removed keys within the tolerance. A constant channel keeps only its first key.
+template <class T> static void ReduceKeys(const PODVector<float>& times, const PODVector<T>& values, float tolerance,
+    PODVector<unsigned>& keys)
+{
+    keys.Clear();
+    keys.Push(0);
+
+    bool constant = true;
+    for (unsigned i = 1; i < values.Size() && constant; ++i)
+        constant = GetKeyError(values[0], values[i]) <= tolerance;
+    if (constant)
+        return;
+
+    // Extend the span from the last kept key for as long as interpolation across it stays within the tolerance
+    unsigned start = 0;
+    for (unsigned end = 2; end < values.Size(); ++end)
+    {
+        float span = times[end] - times[start];
+        bool fits = true;
+        for (unsigned i = start + 1; i < end && fits; ++i)
+        {
+            float t = span > 0.0f ? (times[i] - times[start]) / span : 0.0f;
+            fits = GetKeyError(InterpolateKey(values[start], values[end], t), values[i]) <= tolerance;
+        }
+
+        if (!fits)
+        {
+            start = end - 1;
+            keys.Push(start);
+        }
+    }
+
+    keys.Push(values.Size() - 1);
+}
+
+/// Quantize a key time to a fraction of the animation length.
+static unsigned short QuantizeKeyTime(float time, float length)
+{
+    return length > 0.0f ? (unsigned short)Clamp(RoundToInt(time / length * MAX_QUANTIZED_KEY), 0, 65535) : 0;
+}
+
+/// Quantize a value within bounds.
+static unsigned short QuantizeKeyValue(float value, float min, float range)
+{
+    return range > 0.0f ? (unsigned short)Clamp(RoundToInt((value - min) / range * MAX_QUANTIZED_KEY), 0, 65535) : 0;
+}
+
+/// Encode a rotation as its three smallest components, with the index of the largest in the top bits of the first two.
+static void PackRotation(const Quaternion& rotation, unsigned short* dest)
+{
+    Quaternion normalized = rotation.Normalized();
+    const float components[4] = {normalized.w_, normalized.x_, normalized.y_, normalized.z_};
+
+    unsigned largest = 0;
+    for (unsigned i = 1; i < 4; ++i)
+    {
+        if (Abs(components[i]) > Abs(components[largest]))
+            largest = i;
+    }
+
+    // Negate if necessary so that the largest component is positive and can be reconstructed
+    float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    unsigned j = 0;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        float value = components[i] * sign / SMALLEST_THREE_BOUND * 0.5f + 0.5f;
+        dest[j++] = (unsigned short)Clamp(RoundToInt(value * MAX_QUANTIZED_ROTATION), 0, 32767);
+    }
+
+    dest[0] |= (unsigned short)((largest & 1u) << 15u);
+    dest[1] |= (unsigned short)((largest >> 1u) << 15u);
+}
+
+/// Decode a smallest-three encoded rotation.
+static Quaternion UnpackRotation(const unsigned short* src)
+{
+    unsigned largest = (src[0] >> 15u) | ((src[1] >> 15u) << 1u);
+    float components[4];
+    float sumSquares = 0.0f;
+    unsigned j = 0;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        float value = ((float)(src[j++] & 0x7fffu) / MAX_QUANTIZED_ROTATION - 0.5f) * 2.0f * SMALLEST_THREE_BOUND;
+        components[i] = value;
+        sumSquares += value * value;
+    }
+    components[largest] = sqrtf(Max(1.0f - sumSquares, 0.0f));
+
+    return Quaternion(components[0], components[1], components[2], components[3]);
+}
+
+/// Decode a position or scale key.
+static Vector3 UnpackVector(const AnimationCompressedChannel& channel, unsigned index)
+{
+    const unsigned short* src = &channel.values_[index * 3];
+    return channel.min_ + channel.range_ * Vector3((float)src[0], (float)src[1], (float)src[2]) / MAX_QUANTIZED_KEY;
+}
+
+/// Compress a position or scale channel.
+static void CompressVectorChannel(AnimationCompressedChannel& channel, const PODVector<float>& times, const PODVector<Vector3>& values,
+    float length, float tolerance)
+{
+    PODVector<unsigned> keys;
+    ReduceKeys(times, values, tolerance, keys);
+
+    Vector3 min = values[keys[0]];
+    Vector3 max = min;
+    for (unsigned i = 1; i < keys.Size(); ++i)
+    {
+        min = VectorMin(min, values[keys[i]]);
+        max = VectorMax(max, values[keys[i]]);
+    }
+    channel.min_ = min;
+    channel.range_ = max - min;
+
+    channel.times_.Resize(keys.Size());
+    channel.values_.Resize(keys.Size() * 3);
+    for (unsigned i = 0; i < keys.Size(); ++i)
+    {
+        const Vector3& value = values[keys[i]];
+        channel.times_[i] = QuantizeKeyTime(times[keys[i]], length);
+        channel.values_[i * 3] = QuantizeKeyValue(value.x_, min.x_, channel.range_.x_);
+        channel.values_[i * 3 + 1] = QuantizeKeyValue(value.y_, min.y_, channel.range_.y_);
+        channel.values_[i * 3 + 2] = QuantizeKeyValue(value.z_, min.z_, channel.range_.z_);
+    }
+}
+
+/// Compress a rotation channel.
+static void CompressRotationChannel(AnimationCompressedChannel& channel, const PODVector<float>& times,
+    const PODVector<Quaternion>& values, float length, float tolerance)
+{
+    PODVector<unsigned> keys;
+    ReduceKeys(times, values, tolerance, keys);
+
+    channel.times_.Resize(keys.Size());
+    channel.values_.Resize(keys.Size() * 3);
+    for (unsigned i = 0; i < keys.Size(); ++i)
+    {
+        channel.times_[i] = QuantizeKeyTime(times[keys[i]], length);
+        PackRotation(values[keys[i]], &channel.values_[i * 3]);
+    }
+}
+
+/// Find the keys of a compressed channel to interpolate between at time, using and updating the key index hint. Return the interpolation factor.
+static float GetCompressedKeys(const PODVector<unsigned short>& times, float time, float length, bool looped, unsigned& key,
+    unsigned& nextKey)
+{
+    const float timeScale = length / MAX_QUANTIZED_KEY;
+    const unsigned numKeys = times.Size();
+
+    if (time < 0.0f)
+        time = 0.0f;
+    if (key >= numKeys)
+        key = numKeys - 1;
+
+    while (key && time < times[key] * timeScale)
+        --key;
+    while (key < numKeys - 1 && time >= times[key + 1] * timeScale)
+        ++key;
+
+    nextKey = key + 1;
+    if (nextKey >= numKeys)
+    {
+        if (!looped)
+        {
+            nextKey = key;
+            return 0.0f;
+        }
+        nextKey = 0;
+    }
+
+    float timeInterval = ((float)times[nextKey] - (float)times[key]) * timeScale;
+    if (timeInterval < 0.0f)
+        timeInterval += length;
+    return timeInterval > 0.0f ? (time - times[key] * timeScale) / timeInterval : 1.0f;
+}
+
+/// Return the memory use of a compressed channel.
+static unsigned GetCompressedChannelMemoryUse(const AnimationCompressedChannel& channel)
+{
+    return (channel.times_.Size() + channel.values_.Size()) * sizeof(unsigned short);
+}
+
+/// Write a compressed channel.
+static void WriteCompressedChannel(Serializer& dest, const AnimationCompressedChannel& channel, bool bounds)
+{
+    dest.WriteUInt(channel.times_.Size());
+    dest.Write(channel.times_.Buffer(), channel.times_.Size() * sizeof(unsigned short));
+    dest.Write(channel.values_.Buffer(), channel.values_.Size() * sizeof(unsigned short));
+    if (bounds)
+    {
+        dest.WriteVector3(channel.min_);
+        dest.WriteVector3(channel.range_);
+    }
+}
+
+/// Read a compressed channel.
+static void ReadCompressedChannel(Deserializer& source, AnimationCompressedChannel& channel, bool bounds)
+{
+    unsigned numKeys = source.ReadUInt();
+    channel.times_.Resize(numKeys);
+    channel.values_.Resize(numKeys * 3);
+    source.Read(channel.times_.Buffer(), numKeys * sizeof(unsigned short));
+    source.Read(channel.values_.Buffer(), numKeys * 3 * sizeof(unsigned short));
+    if (bounds)
+    {
+        channel.min_ = source.ReadVector3();
+        channel.range_ = source.ReadVector3();
+    }
+}
+
 void AnimationTrack::SetKeyFrame(unsigned index, const AnimationKeyFrame& keyFrame)
 {
     if (index < keyFrames_.Size())
@@ -111,6 +361,79 @@ bool AnimationTrack::GetKeyFrameIndex(float time, unsigned& index) const
     return true;
 }
 
+void AnimationTrack::Compress(float length, float positionTolerance, float rotationTolerance, float scaleTolerance)
+{
+    if (compressed_ || keyFrames_.Empty())
+        return;
+
+    const unsigned numKeyFrames = keyFrames_.Size();
+    PODVector<float> times(numKeyFrames);
+    for (unsigned i = 0; i < numKeyFrames; ++i)
+        times[i] = keyFrames_[i].time_;
+
+    if (channelMask_ & CHANNEL_POSITION)
+    {
+        PODVector<Vector3> values(numKeyFrames);
+        for (unsigned i = 0; i < numKeyFrames; ++i)
+            values[i] = keyFrames_[i].position_;
+        CompressVectorChannel(compressedChannels_[POSITION_CHANNEL], times, values, length, positionTolerance);
+    }
+    if (channelMask_ & CHANNEL_ROTATION)
+    {
+        PODVector<Quaternion> values(numKeyFrames);
+        for (unsigned i = 0; i < numKeyFrames; ++i)
+            values[i] = keyFrames_[i].rotation_;
+        CompressRotationChannel(compressedChannels_[ROTATION_CHANNEL], times, values, length, rotationTolerance);
+    }
+    if (channelMask_ & CHANNEL_SCALE)
+    {
+        PODVector<Vector3> values(numKeyFrames);
+        for (unsigned i = 0; i < numKeyFrames; ++i)
+            values[i] = keyFrames_[i].scale_;
+        CompressVectorChannel(compressedChannels_[SCALE_CHANNEL], times, values, length, scaleTolerance);
+    }
+
+    keyFrames_.Clear();
+    keyFrames_.Compact();
+    compressed_ = true;
+}
+
+void AnimationTrack::SampleCompressed(float time, float length, bool looped, unsigned* keyIndices, Vector3& position,
+    Quaternion& rotation, Vector3& scale) const
+{
+    unsigned nextKey;
+
+    const AnimationCompressedChannel& positionChannel = compressedChannels_[POSITION_CHANNEL];
+    if ((channelMask_ & CHANNEL_POSITION) && !positionChannel.times_.Empty())
+    {
+        unsigned& key = keyIndices[POSITION_CHANNEL];
+        float t = GetCompressedKeys(positionChannel.times_, time, length, looped, key, nextKey);
+        position = UnpackVector(positionChannel, key);
+        if (nextKey != key)
+            position = position.Lerp(UnpackVector(positionChannel, nextKey), t);
+    }
+
+    const AnimationCompressedChannel& rotationChannel = compressedChannels_[ROTATION_CHANNEL];
+    if ((channelMask_ & CHANNEL_ROTATION) && !rotationChannel.times_.Empty())
+    {
+        unsigned& key = keyIndices[ROTATION_CHANNEL];
+        float t = GetCompressedKeys(rotationChannel.times_, time, length, looped, key, nextKey);
+        rotation = UnpackRotation(&rotationChannel.values_[key * 3]);
+        if (nextKey != key)
+            rotation = rotation.Slerp(UnpackRotation(&rotationChannel.values_[nextKey * 3]), t);
+    }
+
+    const AnimationCompressedChannel& scaleChannel = compressedChannels_[SCALE_CHANNEL];
+    if ((channelMask_ & CHANNEL_SCALE) && !scaleChannel.times_.Empty())
+    {
+        unsigned& key = keyIndices[SCALE_CHANNEL];
+        float t = GetCompressedKeys(scaleChannel.times_, time, length, looped, key, nextKey);
+        scale = UnpackVector(scaleChannel, key);
+        if (nextKey != key)
+            scale = scale.Lerp(UnpackVector(scaleChannel, nextKey), t);
+    }
+}
+
 Animation::Animation(Context* context) :
     ResourceWithMetadata(context),
     length_(0.f)
@@ -128,8 +451,10 @@ bool Animation::BeginLoad(Deserializer& source)
 {
     unsigned memoryUse = sizeof(Animation);
 
-    // Check ID
-    if (source.ReadFileID() != "UANI")
+    // Check ID. Compressed animations store a compressed flag per track
+    String fileID = source.ReadFileID();
+    bool compressedFormat = fileID == "UANC";
+    if (fileID != "UANI" && !compressedFormat)
     {
         URHO3D_LOGERROR(source.GetName() + " is not a valid animation file");
         return false;
@@ -150,6 +475,21 @@ bool Animation::BeginLoad(Deserializer& source)
         AnimationTrack* newTrack = CreateTrack(source.ReadString());
         newTrack->channelMask_ = AnimationChannelFlags(source.ReadUByte());
 
+        if (compressedFormat && source.ReadBool())
+        {
+            newTrack->compressed_ = true;
+            if (newTrack->channelMask_ & CHANNEL_POSITION)
+                ReadCompressedChannel(source, newTrack->compressedChannels_[POSITION_CHANNEL], true);
+            if (newTrack->channelMask_ & CHANNEL_ROTATION)
+                ReadCompressedChannel(source, newTrack->compressedChannels_[ROTATION_CHANNEL], false);
+            if (newTrack->channelMask_ & CHANNEL_SCALE)
+                ReadCompressedChannel(source, newTrack->compressedChannels_[SCALE_CHANNEL], true);
+
+            for (unsigned j = 0; j < 3; ++j)
+                memoryUse += GetCompressedChannelMemoryUse(newTrack->compressedChannels_[j]);
+            continue;
+        }
+
         unsigned keyFrames = source.ReadUInt();
         newTrack->keyFrames_.Resize(keyFrames);
         memoryUse += keyFrames * sizeof(AnimationKeyFrame);
@@ -229,7 +569,8 @@ bool Animation::BeginLoad(Deserializer& source)
 bool Animation::Save(Serializer& dest) const
 {
     // Write ID, name and length
-    dest.WriteFileID("UANI");
+    bool compressedFormat = IsCompressed();
+    dest.WriteFileID(compressedFormat ? "UANC" : "UANI");
     dest.WriteString(animationName_);
     dest.WriteFloat(length_);
 
@@ -240,6 +581,22 @@ bool Animation::Save(Serializer& dest) const
         const AnimationTrack& track = i->second_;
         dest.WriteString(track.name_);
         dest.WriteUByte(track.channelMask_);
+
+        if (compressedFormat)
+        {
+            dest.WriteBool(track.compressed_);
+            if (track.compressed_)
+            {
+                if (track.channelMask_ & CHANNEL_POSITION)
+                    WriteCompressedChannel(dest, track.compressedChannels_[POSITION_CHANNEL], true);
+                if (track.channelMask_ & CHANNEL_ROTATION)
+                    WriteCompressedChannel(dest, track.compressedChannels_[ROTATION_CHANNEL], false);
+                if (track.channelMask_ & CHANNEL_SCALE)
+                    WriteCompressedChannel(dest, track.compressedChannels_[SCALE_CHANNEL], true);
+                continue;
+            }
+        }
+
         dest.WriteUInt(track.keyFrames_.Size());
 
         // Write keyframes of the track
@@ -386,6 +743,40 @@ SharedPtr<Animation> Animation::Clone(const String& cloneName) const
     return ret;
 }
 
+void Animation::Compress(float positionTolerance, float rotationTolerance, float scaleTolerance)
+{
+    for (HashMap<StringHash, AnimationTrack>::Iterator i = tracks_.Begin(); i != tracks_.End(); ++i)
+        i->second_.Compress(length_, positionTolerance, rotationTolerance, scaleTolerance);
+
+    UpdateMemoryUse();
+}
+
+bool Animation::IsCompressed() const
+{
+    for (HashMap<StringHash, AnimationTrack>::ConstIterator i = tracks_.Begin(); i != tracks_.End(); ++i)
+    {
+        if (i->second_.compressed_)
+            return true;
+    }
+
+    return false;
+}
+
+void Animation::UpdateMemoryUse()
+{
+    unsigned memoryUse = sizeof(Animation) + tracks_.Size() * sizeof(AnimationTrack) +
+        triggers_.Size() * sizeof(AnimationTriggerPoint);
+    for (HashMap<StringHash, AnimationTrack>::ConstIterator i = tracks_.Begin(); i != tracks_.End(); ++i)
+    {
+        const AnimationTrack& track = i->second_;
+        memoryUse += track.keyFrames_.Size() * sizeof(AnimationKeyFrame);
+        for (unsigned j = 0; j < 3; ++j)
+            memoryUse += GetCompressedChannelMemoryUse(track.compressedChannels_[j]);
+    }
+
+    SetMemoryUse(memoryUse);
+}
+
 AnimationTrack* Animation::GetTrack(unsigned index)
 {
     if (index >= GetNumTracks())
@@ -62,6 +62,19 @@ struct AnimationKeyFrame
     Vector3 scale_;
 };
 
+/// Quantized keys of one channel of a compressed animation track.
+struct AnimationCompressedChannel
+{
+    /// Key times in 1/65535 fractions of the animation length.
+    PODVector<unsigned short> times_;
+    /// Three quantized values per key: a position or scale within the key bounds, or a smallest-three encoded rotation.
+    PODVector<unsigned short> values_;
+    /// Minimum of the position or scale keys.
+    Vector3 min_;
+    /// Extent of the position or scale keys.
+    Vector3 range_;
+};
+
 /// Skeletal animation track, stores keyframes of a single bone.
 /// @nocount
 struct URHO3D_API AnimationTrack
@@ -90,6 +103,14 @@ struct URHO3D_API AnimationTrack
     unsigned GetNumKeyFrames() const { return keyFrames_.Size(); }
     /// Return keyframe index based on time and previous index. Return false if animation is empty.
     bool GetKeyFrameIndex(float time, unsigned& index) const;
+    /// Return whether the keyframes have been compressed into quantized channels.
+    bool IsCompressed() const { return compressed_; }
+
+    /// Compress the keyframes into quantized channels of an animation with given length. Constant channels are stored as a single key, and keys reproduced by interpolating their neighbours within the tolerances are removed. Position and scale tolerances are distances, rotation tolerance is an angle in radians. The keyframes are removed.
+    void Compress(float length, float positionTolerance, float rotationTolerance, float scaleTolerance);
+    /// Sample the compressed channels at time into the values of the included channels, using the per-channel key indices as search hints and updating them. Wrap from the last key to the first if looped.
+    void SampleCompressed(float time, float length, bool looped, unsigned* keyIndices, Vector3& position, Quaternion& rotation,
+        Vector3& scale) const;
 
     /// Bone or scene node name.
     String name_;
@@ -97,8 +118,12 @@ struct URHO3D_API AnimationTrack
     StringHash nameHash_;
     /// Bitmask of included data (position, rotation, scale).
     AnimationChannelFlags channelMask_{};
-    /// Keyframes.
+    /// Keyframes. Empty if compressed.
     Vector<AnimationKeyFrame> keyFrames_;
+    /// Compressed position, rotation and scale channels.
+    AnimationCompressedChannel compressedChannels_[3];
+    /// Compressed flag.
+    bool compressed_{};
 };
 
 /// %Animation trigger point.
@@ -163,6 +188,8 @@ public:
     void SetNumTriggers(unsigned num);
     /// Clone the animation.
     SharedPtr<Animation> Clone(const String& cloneName = String::EMPTY) const;
+    /// Compress the keyframes of all tracks with quantized keys, constant channel elimination and key reduction within the tolerances. Position and scale tolerances are distances, rotation tolerance is an angle in radians. Compressed animations are saved in the compressed format.
+    void Compress(float positionTolerance = 0.001f, float rotationTolerance = 0.001f, float scaleTolerance = 0.001f);
 
     /// Return animation name.
     /// @property
@@ -201,7 +228,13 @@ public:
     /// Return a trigger point by index.
     AnimationTriggerPoint* GetTrigger(unsigned index);
 
+    /// Return whether any track is compressed.
+    bool IsCompressed() const;
+
 private:
+    /// Recalculate memory use from the tracks and triggers.
+    void UpdateMemoryUse();
+
     /// Animation name.
     String animationName_;
     /// Animation name hash.
@@ -27,6 +27,7 @@
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
 #include "../Graphics/AnimationController.h"
+#include "../Graphics/AnimationPoseCache.h"
 #include "../Graphics/AnimationState.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
@@ -50,11 +51,14 @@ static const unsigned char CTRL_ADDITIVE = 0x40;
 static const float EXTRA_ANIM_FADEOUT_TIME = 0.1f;
 static const float COMMAND_STAY_TIME = 0.25f;
 static const unsigned MAX_NODE_ANIMATION_STATES = 256;
+static const float DEFAULT_SHARED_POSE_TIME_STEP = 1.0f / 30.0f;
 
 extern const char* LOGIC_CATEGORY;
 
 AnimationController::AnimationController(Context* context) :
-    Component(context)
+    Component(context),
+    sharedPose_(false),
+    sharedPoseTimeStep_(DEFAULT_SHARED_POSE_TIME_STEP)
 {
 }
 
@@ -71,6 +75,9 @@ void AnimationController::RegisterObject(Context* context)
         Variant::emptyBuffer, AM_NET | AM_LATESTDATA | AM_NOEDIT);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Node Animation States", GetNodeAnimationStatesAttr, SetNodeAnimationStatesAttr, VariantVector,
         Variant::emptyVariantVector, AM_FILE | AM_NOEDIT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Shared Pose", GetSharedPose, SetSharedPose, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Shared Pose Time Step", GetSharedPoseTimeStep, SetSharedPoseTimeStep, float,
+        DEFAULT_SHARED_POSE_TIME_STEP, AM_DEFAULT);
 }
 
 void AnimationController::OnSetEnabled()
@@ -154,6 +161,33 @@ void AnimationController::Update(float timeStep)
     // Node hierarchy animations need to be applied manually
     for (Vector<SharedPtr<AnimationState> >::Iterator i = nodeAnimationStates_.Begin(); i != nodeAnimationStates_.End(); ++i)
         (*i)->Apply();
+
+    if (sharedPose_)
+    {
+        if (auto* model = GetComponent<AnimatedModel>())
+            model->SetSharedPoseTimeStep(sharedPoseTimeStep_);
+    }
+}
+
+void AnimationController::SetSharedPose(bool enable)
+{
+    if (enable == sharedPose_)
+        return;
+
+    sharedPose_ = enable;
+    if (enable)
+    {
+        // The pose cache is created on demand, as most applications do not need it
+        if (!GetSubsystem<AnimationPoseCache>())
+            context_->RegisterSubsystem(new AnimationPoseCache(context_));
+    }
+    else if (auto* model = GetComponent<AnimatedModel>())
+        model->SetSharedPoseTimeStep(0.0f);
+}
+
+void AnimationController::SetSharedPoseTimeStep(float timeStep)
+{
+    sharedPoseTimeStep_ = Max(timeStep, M_EPSILON);
 }
 
 bool AnimationController::Play(const String& name, unsigned char layer, bool looped, float fadeInTime)
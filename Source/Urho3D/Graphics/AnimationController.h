@@ -133,6 +133,12 @@ public:
     bool SetRemoveOnCompletion(const String& name, bool removeOnCompletion);
     /// Set animation blending mode. Return true on success.
     bool SetBlendMode(const String& name, AnimationBlendMode mode);
+    /// Set whether to reuse the bone pose of other models playing the same animations at the same time during a frame. Useful for crowds.
+    /// @property
+    void SetSharedPose(bool enable);
+    /// Set time bucket size for shared pose matching. Animation times within the same bucket produce the same pose.
+    /// @property
+    void SetSharedPoseTimeStep(float timeStep);
 
     /// Return whether an animation is active. Note that non-looping animations that are being clamped at the end also return true.
     bool IsPlaying(const String& name) const;
@@ -176,6 +182,12 @@ public:
     AnimationState* GetAnimationState(StringHash nameHash) const;
     /// Return the animation control structures for inspection.
     const Vector<AnimationControl>& GetAnimations() const { return animations_; }
+    /// Return whether the bone pose is shared with other models.
+    /// @property
+    bool GetSharedPose() const { return sharedPose_; }
+    /// Return time bucket size for shared pose matching.
+    /// @property
+    float GetSharedPoseTimeStep() const { return sharedPoseTimeStep_; }
 
     /// Set animation control structures attribute.
     void SetAnimationsAttr(const VariantVector& value);
@@ -210,6 +222,10 @@ private:
     Vector<SharedPtr<AnimationState> > nodeAnimationStates_;
     /// Attribute buffer for network replication.
     mutable VectorBuffer attrBuffer_;
+    /// Shared pose flag.
+    bool sharedPose_;
+    /// Time bucket size for shared pose matching.
+    float sharedPoseTimeStep_;
 };
 
 }
@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Timer.h"
+#include "../Graphics/AnimationPoseCache.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Return hash of a pose key.
+static unsigned GetPoseKeyHash(const PODVector<unsigned>& key)
+{
+    unsigned hash = 0;
+    for (unsigned i = 0; i < key.Size(); ++i)
+    {
+        unsigned value = key[i];
+        for (unsigned j = 0; j < 4; ++j)
+            hash = SDBMHash(hash, (unsigned char)(value >> (j * 8)));
+    }
+    return hash;
+}
+
+AnimationPoseCache::AnimationPoseCache(Context* context) :
+    Object(context)
+{
+}
+
+AnimationPoseCache::~AnimationPoseCache() = default;
+
+bool AnimationPoseCache::GetPose(const PODVector<unsigned>& key, PODVector<BonePose>& pose)
+{
+    unsigned hash = GetPoseKeyHash(key);
+    MutexLock lock(poseMutex_);
+    CheckFrame();
+
+    HashMap<unsigned, SharedBonePose>::Iterator i = poses_.Find(hash);
+    if (i == poses_.End() || i->second_.frameNumber_ != frameNumber_ || i->second_.key_ != key)
+        return false;
+
+    pose = i->second_.pose_;
+    ++numReuses_;
+    return true;
+}
+
+void AnimationPoseCache::StorePose(const PODVector<unsigned>& key, const PODVector<BonePose>& pose)
+{
+    unsigned hash = GetPoseKeyHash(key);
+    MutexLock lock(poseMutex_);
+    CheckFrame();
+
+    // On a hash collision with a pose of this frame, keep the existing pose
+    SharedBonePose& entry = poses_[hash];
+    if (entry.frameNumber_ == frameNumber_ && !entry.key_.Empty())
+        return;
+
+    entry.frameNumber_ = frameNumber_;
+    entry.key_ = key;
+    entry.pose_ = pose;
+    ++numPoses_;
+}
+
+void AnimationPoseCache::Clear()
+{
+    MutexLock lock(poseMutex_);
+    poses_.Clear();
+    numPoses_ = 0;
+    numReuses_ = 0;
+}
+
+void AnimationPoseCache::CheckFrame()
+{
+    auto* time = GetSubsystem<Time>();
+    unsigned frameNumber = time ? time->GetFrameNumber() : 0;
+    if (frameNumber == frameNumber_)
+        return;
+
+    // Keep the poses used during the previous frame, so that their storage is reused while the crowd keeps playing
+    for (HashMap<unsigned, SharedBonePose>::Iterator i = poses_.Begin(); i != poses_.End();)
+    {
+        if (i->second_.frameNumber_ != frameNumber_)
+            i = poses_.Erase(i);
+        else
+            ++i;
+    }
+
+    frameNumber_ = frameNumber;
+    numPoses_ = 0;
+    numReuses_ = 0;
+}
+
+}
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/HashMap.h"
+#include "../Core/Mutex.h"
+#include "../Core/Object.h"
+#include "../Graphics/AnimatedModel.h"
+
+namespace Urho3D
+{
+
+/// Bone pose shared by the models that play identical animations during a frame.
+struct SharedBonePose
+{
+    /// Frame number the pose was last stored or reused on.
+    unsigned frameNumber_{};
+    /// Full key of the pose, to detect hash collisions.
+    PODVector<unsigned> key_;
+    /// Local-space bone transforms.
+    PODVector<BonePose> pose_;
+};
+
+/// %Animation pose cache subsystem. Lets models with the same skeleton and identical animation playback reuse a pose that is sampled and blended once per frame. Created on demand by AnimationController.
+class URHO3D_API AnimationPoseCache : public Object
+{
+    URHO3D_OBJECT(AnimationPoseCache, Object);
+
+public:
+    /// Construct.
+    explicit AnimationPoseCache(Context* context);
+    /// Destruct.
+    ~AnimationPoseCache() override;
+
+    /// Copy the pose stored during this frame with a key. Return true if found. Safe to call from worker threads.
+    bool GetPose(const PODVector<unsigned>& key, PODVector<BonePose>& pose);
+    /// Store a pose with a key for the rest of this frame. Safe to call from worker threads.
+    void StorePose(const PODVector<unsigned>& key, const PODVector<BonePose>& pose);
+    /// Remove all poses.
+    void Clear();
+
+    /// Return number of poses stored during this frame.
+    unsigned GetNumPoses() const { return numPoses_; }
+
+    /// Return number of times a pose was reused during this frame.
+    unsigned GetNumReuses() const { return numReuses_; }
+
+private:
+    /// Begin a new frame if the frame number has changed, removing the poses not used during the previous frame.
+    void CheckFrame();
+
+    /// Mutex for the poses, as models are animated in worker threads.
+    Mutex poseMutex_;
+    /// Poses by key hash.
+    HashMap<unsigned, SharedBonePose> poses_;
+    /// Current frame number.
+    unsigned frameNumber_{};
+    /// Number of poses stored during this frame.
+    unsigned numPoses_{};
+    /// Number of poses reused during this frame.
+    unsigned numReuses_{};
+};
+
+}
@@ -36,13 +36,32 @@ namespace Urho3D
 AnimationStateTrack::AnimationStateTrack() :
     track_(nullptr),
     bone_(nullptr),
+    boneIndex_(M_MAX_UNSIGNED),
     weight_(1.0f),
-    keyFrame_(0)
+    keyFrame_(0),
+    channelKeyFrames_{}
 {
 }
 
 AnimationStateTrack::~AnimationStateTrack() = default;
 
+/// Return whether a bone is the given ancestor bone itself or one of its descendants.
+static bool IsBoneInSubtree(const Vector<Bone>& bones, unsigned boneIndex, unsigned ancestorIndex)
+{
+    // The iteration count bound guards against malformed hierarchies with cycles
+    for (unsigned i = 0; i < bones.Size() && boneIndex < bones.Size(); ++i)
+    {
+        if (boneIndex == ancestorIndex)
+            return true;
+        unsigned parentIndex = bones[boneIndex].parentIndex_;
+        if (parentIndex == boneIndex)
+            return false;
+        boneIndex = parentIndex;
+    }
+
+    return false;
+}
+
 AnimationState::AnimationState(AnimatedModel* model, Animation* animation) :
     model_(model),
     animation_(animation),
@@ -51,7 +70,8 @@ AnimationState::AnimationState(AnimatedModel* model, Animation* animation) :
     weight_(0.0f),
     time_(0.0f),
     layer_(0),
-    blendingMode_(ABM_LERP)
+    blendingMode_(ABM_LERP),
+    nodelessTracks_(false)
 {
     // Set default start bone (use all tracks)
     SetStartBone(nullptr);
@@ -65,7 +85,8 @@ AnimationState::AnimationState(Node* node, Animation* animation) :
     weight_(1.0f),
     time_(0.0f),
     layer_(0),
-    blendingMode_(ABM_LERP)
+    blendingMode_(ABM_LERP),
+    nodelessTracks_(false)
 {
     if (animation_)
     {
@@ -117,14 +138,38 @@ void AnimationState::SetStartBone(Bone* startBone)
     }
 
     // Do not reassign if the start bone did not actually change, and we already have valid bone nodes
-    if (startBone == startBone_ && !stateTracks_.Empty())
+    if (startBone == startBone_ && !stateTracks_.Empty() && nodelessTracks_ == model_->GetNodelessPose())
         return;
 
     startBone_ = startBone;
+    nodelessTracks_ = model_->GetNodelessPose();
 
     const HashMap<StringHash, AnimationTrack>& tracks = animation_->GetTracks();
     stateTracks_.Clear();
 
+    // Without bone nodes, find the start bone's children from the skeleton and apply to the pose by bone index
+    if (nodelessTracks_)
+    {
+        Vector<Bone>& bones = skeleton.GetModifiableBones();
+        unsigned startIndex = skeleton.GetBoneIndex(startBone);
+
+        for (HashMap<StringHash, AnimationTrack>::ConstIterator i = tracks.Begin(); i != tracks.End(); ++i)
+        {
+            unsigned boneIndex = skeleton.GetBoneIndex(i->second_.nameHash_);
+            if (!IsBoneInSubtree(bones, boneIndex, startIndex))
+                continue;
+
+            AnimationStateTrack stateTrack;
+            stateTrack.track_ = &i->second_;
+            stateTrack.bone_ = &bones[boneIndex];
+            stateTrack.boneIndex_ = boneIndex;
+            stateTracks_.Push(stateTrack);
+        }
+
+        model_->MarkAnimationDirty();
+        return;
+    }
+
     if (!startBone->node_)
         return;
 
@@ -149,6 +194,7 @@ void AnimationState::SetStartBone(Bone* startBone)
         if (trackBone && trackBone->node_)
         {
             stateTrack.bone_ = trackBone;
+            stateTrack.boneIndex_ = skeleton.GetBoneIndex(trackBone);
             stateTrack.node_ = trackBone->node_;
             stateTracks_.Push(stateTrack);
         }
@@ -229,6 +275,18 @@ void AnimationState::SetBoneWeight(unsigned index, float weight, bool recursive)
                     SetBoneWeight(childTrackIndex, weight, true);
             }
         }
+        else if (nodelessTracks_ && model_)
+        {
+            // Without bone nodes, find the child tracks through the skeleton's parent indices instead
+            const Vector<Bone>& bones = model_->GetSkeleton().GetBones();
+            unsigned boneIndex = stateTracks_[index].boneIndex_;
+            for (unsigned i = 0; i < stateTracks_.Size(); ++i)
+            {
+                unsigned childIndex = stateTracks_[i].boneIndex_;
+                if (childIndex != boneIndex && childIndex < bones.Size() && bones[childIndex].parentIndex_ == boneIndex)
+                    SetBoneWeight(i, weight, true);
+            }
+        }
     }
 }
 
@@ -406,13 +464,25 @@ unsigned AnimationState::GetTrackIndex(const String& name) const
     for (unsigned i = 0; i < stateTracks_.Size(); ++i)
     {
         Node* node = stateTracks_[i].node_;
-        if (node && node->GetName() == name)
+        Bone* bone = stateTracks_[i].bone_;
+        if (node ? node->GetName() == name : bone && bone->name_ == name)
             return i;
     }
 
     return M_MAX_UNSIGNED;
 }
 
+bool AnimationState::HasBoneWeights() const
+{
+    for (Vector<AnimationStateTrack>::ConstIterator i = stateTracks_.Begin(); i != stateTracks_.End(); ++i)
+    {
+        if (i->weight_ != 1.0f)
+            return true;
+    }
+
+    return false;
+}
+
 unsigned AnimationState::GetTrackIndex(Node* node) const
 {
     for (unsigned i = 0; i < stateTracks_.Size(); ++i)
@@ -429,7 +499,8 @@ unsigned AnimationState::GetTrackIndex(StringHash nameHash) const
     for (unsigned i = 0; i < stateTracks_.Size(); ++i)
     {
         Node* node = stateTracks_[i].node_;
-        if (node && node->GetNameHash() == nameHash)
+        Bone* bone = stateTracks_[i].bone_;
+        if (node ? node->GetNameHash() == nameHash : bone && bone->nameHash_ == nameHash)
             return i;
     }
 
@@ -478,77 +549,94 @@ void AnimationState::ApplyTrack(AnimationStateTrack& stateTrack, float weight, b
 {
     const AnimationTrack* track = stateTrack.track_;
     Node* node = stateTrack.node_;
+    // Without a bone node, apply to the model's node-free pose
+    BonePose* pose = !node && nodelessTracks_ && model_ && stateTrack.boneIndex_ < model_->bonePose_.Size() ?
+        &model_->bonePose_[stateTrack.boneIndex_] : nullptr;
 
-    if (track->keyFrames_.Empty() || !node)
+    if ((track->keyFrames_.Empty() && !track->IsCompressed()) || (!node && !pose))
         return;
 
-    unsigned& frame = stateTrack.keyFrame_;
-    track->GetKeyFrameIndex(time_, frame);
-
-    // Check if next frame to interpolate to is valid, or if wrapping is needed (looping animation only)
-    unsigned nextFrame = frame + 1;
-    bool interpolate = true;
-    if (nextFrame >= track->keyFrames_.Size())
-    {
-        if (!looped_)
-        {
-            nextFrame = frame;
-            interpolate = false;
-        }
-        else
-            nextFrame = 0;
-    }
-
-    const AnimationKeyFrame* keyFrame = &track->keyFrames_[frame];
     const AnimationChannelFlags channelMask = track->channelMask_;
 
     Vector3 newPosition;
     Quaternion newRotation;
     Vector3 newScale;
 
-    if (interpolate)
+    // Compressed tracks are sampled per channel directly from the quantized keys
+    if (track->IsCompressed())
     {
-        const AnimationKeyFrame* nextKeyFrame = &track->keyFrames_[nextFrame];
-        float timeInterval = nextKeyFrame->time_ - keyFrame->time_;
-        if (timeInterval < 0.0f)
-            timeInterval += animation_->GetLength();
-        float t = timeInterval > 0.0f ? (time_ - keyFrame->time_) / timeInterval : 1.0f;
-
-        if (channelMask & CHANNEL_POSITION)
-            newPosition = keyFrame->position_.Lerp(nextKeyFrame->position_, t);
-        if (channelMask & CHANNEL_ROTATION)
-            newRotation = keyFrame->rotation_.Slerp(nextKeyFrame->rotation_, t);
-        if (channelMask & CHANNEL_SCALE)
-            newScale = keyFrame->scale_.Lerp(nextKeyFrame->scale_, t);
+        track->SampleCompressed(time_, animation_->GetLength(), looped_, stateTrack.channelKeyFrames_, newPosition, newRotation,
+            newScale);
     }
     else
     {
-        if (channelMask & CHANNEL_POSITION)
-            newPosition = keyFrame->position_;
-        if (channelMask & CHANNEL_ROTATION)
-            newRotation = keyFrame->rotation_;
-        if (channelMask & CHANNEL_SCALE)
-            newScale = keyFrame->scale_;
+        unsigned& frame = stateTrack.keyFrame_;
+        track->GetKeyFrameIndex(time_, frame);
+
+        // Check if next frame to interpolate to is valid, or if wrapping is needed (looping animation only)
+        unsigned nextFrame = frame + 1;
+        bool interpolate = true;
+        if (nextFrame >= track->keyFrames_.Size())
+        {
+            if (!looped_)
+            {
+                nextFrame = frame;
+                interpolate = false;
+            }
+            else
+                nextFrame = 0;
+        }
+
+        const AnimationKeyFrame* keyFrame = &track->keyFrames_[frame];
+
+        if (interpolate)
+        {
+            const AnimationKeyFrame* nextKeyFrame = &track->keyFrames_[nextFrame];
+            float timeInterval = nextKeyFrame->time_ - keyFrame->time_;
+            if (timeInterval < 0.0f)
+                timeInterval += animation_->GetLength();
+            float t = timeInterval > 0.0f ? (time_ - keyFrame->time_) / timeInterval : 1.0f;
+
+            if (channelMask & CHANNEL_POSITION)
+                newPosition = keyFrame->position_.Lerp(nextKeyFrame->position_, t);
+            if (channelMask & CHANNEL_ROTATION)
+                newRotation = keyFrame->rotation_.Slerp(nextKeyFrame->rotation_, t);
+            if (channelMask & CHANNEL_SCALE)
+                newScale = keyFrame->scale_.Lerp(nextKeyFrame->scale_, t);
+        }
+        else
+        {
+            if (channelMask & CHANNEL_POSITION)
+                newPosition = keyFrame->position_;
+            if (channelMask & CHANNEL_ROTATION)
+                newRotation = keyFrame->rotation_;
+            if (channelMask & CHANNEL_SCALE)
+                newScale = keyFrame->scale_;
+        }
     }
 
+    const Vector3& currentPosition = node ? node->GetPosition() : pose->position_;
+    const Quaternion& currentRotation = node ? node->GetRotation() : pose->rotation_;
+    const Vector3& currentScale = node ? node->GetScale() : pose->scale_;
+
     if (blendingMode_ == ABM_ADDITIVE) // not ABM_LERP
     {
         if (channelMask & CHANNEL_POSITION)
         {
             Vector3 delta = newPosition - stateTrack.bone_->initialPosition_;
-            newPosition = node->GetPosition() + delta * weight;
+            newPosition = currentPosition + delta * weight;
         }
         if (channelMask & CHANNEL_ROTATION)
         {
             Quaternion delta = newRotation * stateTrack.bone_->initialRotation_.Inverse();
-            newRotation = (delta * node->GetRotation()).Normalized();
+            newRotation = (delta * currentRotation).Normalized();
             if (!Equals(weight, 1.0f))
-                newRotation = node->GetRotation().Slerp(newRotation, weight);
+                newRotation = currentRotation.Slerp(newRotation, weight);
         }
         if (channelMask & CHANNEL_SCALE)
         {
             Vector3 delta = newScale - stateTrack.bone_->initialScale_;
-            newScale = node->GetScale() + delta * weight;
+            newScale = currentScale + delta * weight;
         }
     }
     else
@@ -556,15 +644,24 @@ void AnimationState::ApplyTrack(AnimationStateTrack& stateTrack, float weight, b
         if (!Equals(weight, 1.0f)) // not full weight
         {
             if (channelMask & CHANNEL_POSITION)
-                newPosition = node->GetPosition().Lerp(newPosition, weight);
+                newPosition = currentPosition.Lerp(newPosition, weight);
             if (channelMask & CHANNEL_ROTATION)
-                newRotation = node->GetRotation().Slerp(newRotation, weight);
+                newRotation = currentRotation.Slerp(newRotation, weight);
             if (channelMask & CHANNEL_SCALE)
-                newScale = node->GetScale().Lerp(newScale, weight);
+                newScale = currentScale.Lerp(newScale, weight);
         }
     }
 
-    if (silent)
+    if (pose)
+    {
+        if (channelMask & CHANNEL_POSITION)
+            pose->position_ = newPosition;
+        if (channelMask & CHANNEL_ROTATION)
+            pose->rotation_ = newRotation;
+        if (channelMask & CHANNEL_SCALE)
+            pose->scale_ = newScale;
+    }
+    else if (silent)
     {
         if (channelMask & CHANNEL_POSITION)
             node->SetPositionSilent(newPosition);
@@ -59,12 +59,16 @@ struct AnimationStateTrack
     const AnimationTrack* track_;
     /// Bone pointer.
     Bone* bone_;
+    /// Bone index in the model's skeleton.
+    unsigned boneIndex_;
     /// Scene node pointer.
     WeakPtr<Node> node_;
     /// Blending weight.
     float weight_;
     /// Last key frame.
     unsigned keyFrame_;
+    /// Last keys of the position, rotation and scale channels of a compressed track.
+    unsigned channelKeyFrames_[3];
 };
 
 /// %Animation instance.
@@ -134,6 +138,9 @@ public:
     /// Return track index by bone name hash, or M_MAX_UNSIGNED if not found.
     unsigned GetTrackIndex(StringHash nameHash) const;
 
+    /// Return whether any bone track has a weight other than full.
+    bool HasBoneWeights() const;
+
     /// Return whether weight is nonzero.
     /// @property
     bool IsEnabled() const { return weight_ > 0.0f; }
@@ -193,6 +200,8 @@ private:
     unsigned char layer_;
     /// Blending mode.
     AnimationBlendMode blendingMode_;
+    /// Whether the tracks were assigned to the model's node-free pose instead of bone nodes.
+    bool nodelessTracks_;
 };
 
 }
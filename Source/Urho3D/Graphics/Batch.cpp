@@ -40,44 +40,124 @@
 namespace Urho3D
 {
 
-inline bool CompareBatchesState(Batch* lhs, Batch* rhs)
+/// Entry count below which an insertion sort is used instead of a radix sort.
+static const unsigned MIN_RADIX_SORT_ENTRIES = 64;
+
+/// Return an unsigned integer that sorts in the same order as the float value.
+inline unsigned GetFloatSortKey(float value)
+{
+    unsigned bits;
+    memcpy(&bits, &value, sizeof bits);
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+/// Return sort key for render order and distance front to back.
+inline unsigned long long GetFrontToBackKey(const Batch* batch)
+{
+    return ((unsigned long long)batch->renderOrder_ << 32u) | GetFloatSortKey(batch->distance_);
+}
+
+/// Return sort key for render order and distance back to front.
+inline unsigned long long GetBackToFrontKey(const Batch* batch)
+{
+    return ((unsigned long long)batch->renderOrder_ << 32u) | ~GetFloatSortKey(batch->distance_);
+}
+
+/// Return sort key for render order and state, using the remapped state sort key of the 2-pass sort. The shader ID is clamped to
+/// 23 bits to make room for the render order.
+inline unsigned long long GetStateKey(const Batch* batch)
 {
-    if (lhs->renderOrder_ != rhs->renderOrder_)
-        return lhs->renderOrder_ < rhs->renderOrder_;
-    else if (lhs->sortKey_ != rhs->sortKey_)
-        return lhs->sortKey_ < rhs->sortKey_;
-    else
-        return lhs->distance_ < rhs->distance_;
+    auto shaderID = (unsigned)(batch->sortKey_ >> 32u);
+    unsigned shaderIndex = Min(shaderID & 0x7fffffffu, 0x7fffffu);
+    return ((unsigned long long)batch->renderOrder_ << 56u) | ((unsigned long long)(shaderID >> 31u) << 55u) |
+           ((unsigned long long)shaderIndex << 32u) | (batch->sortKey_ & 0xffffffffu);
 }
 
-inline bool CompareBatchesFrontToBack(Batch* lhs, Batch* rhs)
+/// Stable sort of key entries in ascending key order. Uses a least significant digit first radix sort with 8-bit digits, skipping
+/// digits that are equal in all keys, or an insertion sort for short arrays.
+static void SortKeyEntries(PODVector<SortKeyEntry>& entries, PODVector<SortKeyEntry>& temp)
 {
-    if (lhs->renderOrder_ != rhs->renderOrder_)
-        return lhs->renderOrder_ < rhs->renderOrder_;
-    else if (lhs->distance_ != rhs->distance_)
-        return lhs->distance_ < rhs->distance_;
-    else
-        return lhs->sortKey_ < rhs->sortKey_;
+    unsigned numEntries = entries.Size();
+    if (numEntries < MIN_RADIX_SORT_ENTRIES)
+    {
+        for (unsigned i = 1; i < numEntries; ++i)
+        {
+            SortKeyEntry entry = entries[i];
+            unsigned j = i;
+            for (; j > 0 && entries[j - 1].key_ > entry.key_; --j)
+                entries[j] = entries[j - 1];
+            entries[j] = entry;
+        }
+        return;
+    }
+
+    // Count all digits in one pass over the keys
+    unsigned counts[8][256] = {};
+    for (unsigned i = 0; i < numEntries; ++i)
+    {
+        unsigned long long key = entries[i].key_;
+        for (unsigned j = 0; j < 8; ++j)
+            ++counts[j][(key >> (j * 8u)) & 0xffu];
+    }
+
+    temp.Resize(numEntries);
+    SortKeyEntry* src = entries.Buffer();
+    SortKeyEntry* dest = temp.Buffer();
+
+    for (unsigned j = 0; j < 8; ++j)
+    {
+        unsigned shift = j * 8u;
+        unsigned* digitCounts = counts[j];
+        if (digitCounts[(src[0].key_ >> shift) & 0xffu] == numEntries)
+            continue;
+
+        unsigned offset = 0;
+        for (unsigned k = 0; k < 256; ++k)
+        {
+            unsigned count = digitCounts[k];
+            digitCounts[k] = offset;
+            offset += count;
+        }
+
+        for (unsigned i = 0; i < numEntries; ++i)
+            dest[digitCounts[(src[i].key_ >> shift) & 0xffu]++] = src[i];
+
+        Swap(src, dest);
+    }
+
+    if (src != entries.Buffer())
+        memcpy(entries.Buffer(), src, numEntries * sizeof(SortKeyEntry));
 }
 
-inline bool CompareBatchesBackToFront(Batch* lhs, Batch* rhs)
+#ifdef GL_ES_VERSION_2_0
+/// Return the state sort key only.
+inline unsigned long long GetSortKey(const Batch* batch)
 {
-    if (lhs->renderOrder_ != rhs->renderOrder_)
-        return lhs->renderOrder_ < rhs->renderOrder_;
-    else if (lhs->distance_ != rhs->distance_)
-        return lhs->distance_ > rhs->distance_;
-    else
-        return lhs->sortKey_ < rhs->sortKey_;
+    return batch->sortKey_;
 }
 
-inline bool CompareInstancesFrontToBack(const InstanceData& lhs, const InstanceData& rhs)
+/// Return the render order only.
+inline unsigned long long GetRenderOrderKey(const Batch* batch)
 {
-    return lhs.distance_ < rhs.distance_;
+    return batch->renderOrder_;
 }
+#endif
 
-inline bool CompareBatchGroupOrder(BatchGroup* lhs, BatchGroup* rhs)
+/// Stable sort of batches by a key calculated from each batch.
+template <class T> void SortBatches(PODVector<T*>& batches, PODVector<SortKeyEntry>& entries, PODVector<SortKeyEntry>& temp,
+    unsigned long long (*getKey)(const Batch*))
 {
-    return lhs->renderOrder_ < rhs->renderOrder_;
+    entries.Resize(batches.Size());
+    for (unsigned i = 0; i < batches.Size(); ++i)
+    {
+        entries[i].key_ = getKey(batches[i]);
+        entries[i].value_ = batches[i];
+    }
+
+    SortKeyEntries(entries, temp);
+
+    for (unsigned i = 0; i < batches.Size(); ++i)
+        batches[i] = static_cast<T*>(entries[i].value_);
 }
 
 void CalculateShadowMatrix(Matrix4& dest, LightBatchQueue* queue, unsigned split, Renderer* renderer)
@@ -426,21 +506,26 @@ void Batch::Prepare(View* view, Camera* camera, bool setModelTransform, bool all
             if (shadowMap)
             {
                 {
-                    // Calculate point light shadow sampling offsets (unrolled cube map)
-                    auto faceWidth = (unsigned)(shadowMap->GetWidth() / 2);
-                    auto faceHeight = (unsigned)(shadowMap->GetHeight() / 3);
+                    // Calculate point light shadow sampling offsets (unrolled cube map), which may be in a tile of the atlas
+                    const IntRect& shadowMapRect = lightQueue_->shadowMapRect_;
+                    auto faceWidth = (unsigned)(shadowMapRect.Width() / 2);
+                    auto faceHeight = (unsigned)(shadowMapRect.Height() / 3);
                     auto width = (float)shadowMap->GetWidth();
                     auto height = (float)shadowMap->GetHeight();
+                    auto offsetX = (float)shadowMapRect.left_;
 #ifdef URHO3D_OPENGL
+                    // OpenGL texture coordinates start from the bottom
+                    auto offsetY = (float)(shadowMap->GetHeight() - shadowMapRect.bottom_);
                     float mulX = (float)(faceWidth - 3) / width;
                     float mulY = (float)(faceHeight - 3) / height;
-                    float addX = 1.5f / width;
-                    float addY = 1.5f / height;
+                    float addX = (offsetX + 1.5f) / width;
+                    float addY = (offsetY + 1.5f) / height;
 #else
+                    auto offsetY = (float)shadowMapRect.top_;
                     float mulX = (float)(faceWidth - 4) / width;
                     float mulY = (float)(faceHeight - 4) / height;
-                    float addX = 2.5f / width;
-                    float addY = 2.5f / height;
+                    float addX = (offsetX + 2.5f) / width;
+                    float addY = (offsetY + 2.5f) / height;
 #endif
                     // If using 4 shadow samples, offset the position diagonally by half pixel
                     if (renderer->GetShadowQuality() == SHADOWQUALITY_PCF_16BIT || renderer->GetShadowQuality() == SHADOWQUALITY_PCF_24BIT)
@@ -449,6 +534,9 @@ void Batch::Prepare(View* view, Camera* camera, bool setModelTransform, bool all
                         addY -= 0.5f / height;
                     }
                     graphics->SetShaderParameter(PSP_SHADOWCUBEADJUST, Vector4(mulX, mulY, addX, addY));
+                    // Scale of the face column and row offsets from the indirection cube map
+                    graphics->SetShaderParameter(PSP_SHADOWCUBESCALE, Vector2((float)faceWidth / width,
+                        (float)shadowMapRect.Height() / height));
                 }
 
                 {
@@ -597,11 +685,7 @@ void Batch::Prepare(View* view, Camera* camera, bool setModelTransform, bool all
     if (material_)
     {
         if (graphics->NeedParameterUpdate(SP_MATERIAL, reinterpret_cast<const void*>(material_->GetShaderParameterHash())))
-        {
-            const HashMap<StringHash, MaterialShaderParameter>& parameters = material_->GetShaderParameters();
-            for (HashMap<StringHash, MaterialShaderParameter>::ConstIterator i = parameters.Begin(); i != parameters.End(); ++i)
-                graphics->SetShaderParameter(i->first_, i->second_.value_);
-        }
+            graphics->SetMaterialShaderParameters(material_);
 
         const HashMap<TextureUnit, SharedPtr<Texture> >& textures = material_->GetTextures();
         for (HashMap<TextureUnit, SharedPtr<Texture> >::ConstIterator i = textures.Begin(); i != textures.End(); ++i)
@@ -642,6 +726,55 @@ void Batch::Draw(View* view, Camera* camera, bool allowDepthWrite) const
     }
 }
 
+unsigned BatchGroup::AddBindlessTexture(Material* material, Texture* texture)
+{
+    if (material != material_ && !material_->IsBindlessCompatible(*material))
+        return M_MAX_UNSIGNED;
+
+    for (unsigned i = 0; i < bindlessTextures_.Size(); ++i)
+    {
+        if (bindlessTextures_[i] == texture)
+            return i;
+    }
+
+    if (bindlessTextures_.Size() >= MAX_BINDLESS_TEXTURES)
+        return M_MAX_UNSIGNED;
+
+    bindlessTextures_.Push(texture);
+    return bindlessTextures_.Size() - 1;
+}
+
+bool BatchGroup::MergeBindlessTextures(BatchGroup& group)
+{
+    if (group.material_ != material_ && !material_->IsBindlessCompatible(*group.material_))
+        return false;
+
+    unsigned remap[MAX_BINDLESS_TEXTURES];
+    unsigned numTextures = bindlessTextures_.Size();
+    for (unsigned i = 0; i < group.bindlessTextures_.Size(); ++i)
+    {
+        PODVector<Texture*>::Iterator j = bindlessTextures_.Find(group.bindlessTextures_[i]);
+        if (j != bindlessTextures_.End())
+            remap[i] = (unsigned)(j - bindlessTextures_.Begin());
+        else if (numTextures < MAX_BINDLESS_TEXTURES)
+            remap[i] = numTextures++;
+        else
+            return false;
+    }
+
+    // New textures were given consecutive indices in order
+    for (unsigned i = 0; i < group.bindlessTextures_.Size(); ++i)
+    {
+        if (remap[i] >= bindlessTextures_.Size())
+            bindlessTextures_.Push(group.bindlessTextures_[i]);
+    }
+
+    for (PODVector<InstanceData>::Iterator i = group.instances_.Begin(); i != group.instances_.End(); ++i)
+        i->textureIndex_ = remap[i->textureIndex_];
+
+    return true;
+}
+
 void BatchGroup::SetInstancingData(void* lockedData, unsigned stride, unsigned& freeIndex)
 {
     // Do not use up buffer space if not going to draw as instanced
@@ -656,7 +789,9 @@ void BatchGroup::SetInstancingData(void* lockedData, unsigned stride, unsigned&
         const InstanceData& instance = instances_[i];
 
         memcpy(buffer, instance.worldTransform_, sizeof(Matrix3x4));
-        if (instance.instancingData_)
+        if (!bindlessTextures_.Empty())
+            *reinterpret_cast<float*>(buffer + sizeof(Matrix3x4)) = (float)instance.textureIndex_;
+        else if (instance.instancingData_)
             memcpy(buffer + sizeof(Matrix3x4), instance.instancingData_, stride - sizeof(Matrix3x4));
 
         buffer += stride;
@@ -685,6 +820,8 @@ void BatchGroup::Draw(View* view, Camera* camera, bool allowDepthWrite) const
             {
                 if (graphics->NeedParameterUpdate(SP_OBJECT, instances_[i].worldTransform_))
                     graphics->SetShaderParameter(VSP_MODEL, *instances_[i].worldTransform_);
+                if (!bindlessTextures_.Empty())
+                    graphics->SetTexture(TU_DIFFUSE, bindlessTextures_[instances_[i].textureIndex_]);
 
                 graphics->Draw(geometry_->GetPrimitiveType(), geometry_->GetIndexStart(), geometry_->GetIndexCount(),
                     geometry_->GetVertexStart(), geometry_->GetVertexCount());
@@ -702,6 +839,8 @@ void BatchGroup::Draw(View* view, Camera* camera, bool allowDepthWrite) const
 
             graphics->SetIndexBuffer(geometry_->GetIndexBuffer());
             graphics->SetVertexBuffers(vertexBuffers, startIndex_);
+            if (!bindlessTextures_.Empty())
+                graphics->SetBindlessTextures(bindlessTextures_);
             graphics->DrawInstanced(geometry_->GetPrimitiveType(), geometry_->GetIndexStart(), geometry_->GetIndexCount(),
                 geometry_->GetVertexStart(), geometry_->GetVertexCount(), instances_.Size());
 
@@ -714,17 +853,47 @@ void BatchGroup::Draw(View* view, Camera* camera, bool allowDepthWrite) const
 unsigned BatchGroupKey::ToHash() const
 {
     return (unsigned)((size_t)zone_ / sizeof(Zone) + (size_t)lightQueue_ / sizeof(LightBatchQueue) + (size_t)pass_ / sizeof(Pass) +
-                      (size_t)material_ / sizeof(Material) + (size_t)geometry_ / sizeof(Geometry)) + renderOrder_;
+                      (size_t)material_ / sizeof(Material) + (size_t)geometry_ / sizeof(Geometry)) + bindlessHash_ + renderOrder_;
 }
 
 void BatchQueue::Clear(int maxSortedInstances)
 {
     batches_.Clear();
     sortedBatches_.Clear();
+
+    // Recycle the instance buffers, as the same groups usually reappear on the next frame
+    for (FlatHashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
+    {
+        PODVector<InstanceData>& instances = i->second_.instances_;
+        if (instances.Capacity())
+        {
+            instances.Clear();
+            freeInstanceBuffers_.Push(PODVector<InstanceData>());
+            freeInstanceBuffers_.Back().Swap(instances);
+        }
+    }
+
     batchGroups_.Clear();
     maxSortedInstances_ = (unsigned)maxSortedInstances;
 }
 
+FlatHashMap<BatchGroupKey, BatchGroup>::Iterator BatchQueue::AddBatchGroup(const BatchGroupKey& key, BatchGroup& group)
+{
+    // Keep the instances out of the copy
+    PODVector<InstanceData> instances;
+    instances.Swap(group.instances_);
+    FlatHashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Insert(MakePair(key, group));
+    group.instances_.Swap(instances);
+
+    if (!freeInstanceBuffers_.Empty())
+    {
+        i->second_.instances_.Swap(freeInstanceBuffers_.Back());
+        freeInstanceBuffers_.Pop();
+    }
+
+    return i;
+}
+
 void BatchQueue::SortBackToFront()
 {
     sortedBatches_.Resize(batches_.Size());
@@ -732,15 +901,24 @@ void BatchQueue::SortBackToFront()
     for (unsigned i = 0; i < batches_.Size(); ++i)
         sortedBatches_[i] = &batches_[i];
 
-    Sort(sortedBatches_.Begin(), sortedBatches_.End(), CompareBatchesBackToFront);
+    SortBatches(sortedBatches_, sortEntries_, sortTemp_, GetBackToFrontKey);
 
     sortedBatchGroups_.Resize(batchGroups_.Size());
 
     unsigned index = 0;
-    for (HashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
+    for (FlatHashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
         sortedBatchGroups_[index++] = &i->second_;
 
-    Sort(sortedBatchGroups_.Begin(), sortedBatchGroups_.End(), CompareBatchGroupOrder);
+    // Stable sort by render order only, so that groups keep their insertion order within the same render order
+    sortEntries_.Resize(sortedBatchGroups_.Size());
+    for (unsigned i = 0; i < sortedBatchGroups_.Size(); ++i)
+    {
+        sortEntries_[i].key_ = sortedBatchGroups_[i]->renderOrder_;
+        sortEntries_[i].value_ = sortedBatchGroups_[i];
+    }
+    SortKeyEntries(sortEntries_, sortTemp_);
+    for (unsigned i = 0; i < sortedBatchGroups_.Size(); ++i)
+        sortedBatchGroups_[i] = static_cast<BatchGroup*>(sortEntries_[i].value_);
 }
 
 void BatchQueue::SortFrontToBack()
@@ -753,13 +931,28 @@ void BatchQueue::SortFrontToBack()
     SortFrontToBack2Pass(sortedBatches_);
 
     // Sort each group front to back
-    for (HashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
+    for (FlatHashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
     {
-        if (i->second_.instances_.Size() <= maxSortedInstances_)
+        PODVector<InstanceData>& instances = i->second_.instances_;
+        if (instances.Size() <= maxSortedInstances_)
         {
-            Sort(i->second_.instances_.Begin(), i->second_.instances_.End(), CompareInstancesFrontToBack);
-            if (i->second_.instances_.Size())
-                i->second_.distance_ = i->second_.instances_[0].distance_;
+            if (instances.Size() > 1)
+            {
+                sortEntries_.Resize(instances.Size());
+                for (unsigned j = 0; j < instances.Size(); ++j)
+                {
+                    sortEntries_[j].key_ = GetFloatSortKey(instances[j].distance_);
+                    sortEntries_[j].value_ = &instances[j];
+                }
+                SortKeyEntries(sortEntries_, sortTemp_);
+
+                sortInstances_.Resize(instances.Size());
+                for (unsigned j = 0; j < instances.Size(); ++j)
+                    sortInstances_[j] = *static_cast<InstanceData*>(sortEntries_[j].value_);
+                memcpy(instances.Buffer(), sortInstances_.Buffer(), instances.Size() * sizeof(InstanceData));
+            }
+            if (instances.Size())
+                i->second_.distance_ = instances[0].distance_;
         }
         else
         {
@@ -773,7 +966,7 @@ void BatchQueue::SortFrontToBack()
     sortedBatchGroups_.Resize(batchGroups_.Size());
 
     unsigned index = 0;
-    for (HashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
+    for (FlatHashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
         sortedBatchGroups_[index++] = &i->second_;
 
     SortFrontToBack2Pass(reinterpret_cast<PODVector<Batch*>& >(sortedBatchGroups_));
@@ -784,10 +977,11 @@ void BatchQueue::SortFrontToBack2Pass(PODVector<Batch*>& batches)
     // Mobile devices likely use a tiled deferred approach, with which front-to-back sorting is irrelevant. The 2-pass
     // method is also time consuming, so just sort with state having priority
 #ifdef GL_ES_VERSION_2_0
-    Sort(batches.Begin(), batches.End(), CompareBatchesState);
+    SortBatches(batches, sortEntries_, sortTemp_, GetSortKey);
+    SortBatches(batches, sortEntries_, sortTemp_, GetRenderOrderKey);
 #else
     // For desktop, first sort by distance and remap shader/material/geometry IDs in the sort key
-    Sort(batches.Begin(), batches.End(), CompareBatchesFrontToBack);
+    SortBatches(batches, sortEntries_, sortTemp_, GetFrontToBackKey);
 
     unsigned freeShaderID = 0;
     unsigned short freeMaterialID = 0;
@@ -834,14 +1028,14 @@ void BatchQueue::SortFrontToBack2Pass(PODVector<Batch*>& batches)
     materialRemapping_.Clear();
     geometryRemapping_.Clear();
 
-    // Finally sort again with the rewritten ID's
-    Sort(batches.Begin(), batches.End(), CompareBatchesState);
+    // Finally sort again with the rewritten ID's. The sort is stable, so batches with equal state stay in distance order
+    SortBatches(batches, sortEntries_, sortTemp_, GetStateKey);
 #endif
 }
 
 void BatchQueue::SetInstancingData(void* lockedData, unsigned stride, unsigned& freeIndex)
 {
-    for (HashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
+    for (FlatHashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
         i->second_.SetInstancingData(lockedData, stride, freeIndex);
 }
 
@@ -892,7 +1086,7 @@ unsigned BatchQueue::GetNumInstances() const
 {
     unsigned total = 0;
 
-    for (HashMap<BatchGroupKey, BatchGroup>::ConstIterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
+    for (FlatHashMap<BatchGroupKey, BatchGroup>::ConstIterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
     {
         if (i->second_.geometryType_ == GEOM_INSTANCED)
             total += i->second_.instances_.Size();
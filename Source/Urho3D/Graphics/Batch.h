@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../Container/FlatHashMap.h"
 #include "../Container/Ptr.h"
 #include "../Graphics/Drawable.h"
 #include "../Graphics/Material.h"
@@ -128,6 +129,8 @@ struct InstanceData
     const void* instancingData_{};
     /// Distance from camera.
     float distance_{};
+    /// Index into the group's bindless texture array.
+    unsigned textureIndex_{};
 };
 
 /// Instanced 3D geometry draw call.
@@ -150,11 +153,12 @@ struct BatchGroup : public Batch
     ~BatchGroup() = default;
 
     /// Add world transform(s) from a batch.
-    void AddTransforms(const Batch& batch)
+    void AddTransforms(const Batch& batch, unsigned textureIndex = 0)
     {
         InstanceData newInstance;
         newInstance.distance_ = batch.distance_;
         newInstance.instancingData_ = batch.instancingData_;
+        newInstance.textureIndex_ = textureIndex;
 
         for (unsigned i = 0; i < batch.numWorldTransforms_; ++i)
         {
@@ -163,6 +167,10 @@ struct BatchGroup : public Batch
         }
     }
 
+    /// Add a batch's diffuse texture to the bindless texture array. Return its index, or M_MAX_UNSIGNED if the material is not compatible or the array is full.
+    unsigned AddBindlessTexture(Material* material, Texture* texture);
+    /// Take the bindless textures of another group and remap its instances' texture indices. Return false if the material is not compatible or the array would overflow.
+    bool MergeBindlessTextures(BatchGroup& group);
     /// Pre-set the instance data. Buffer must be big enough to hold all data.
     void SetInstancingData(void* lockedData, unsigned stride, unsigned& freeIndex);
     /// Prepare and draw.
@@ -170,6 +178,8 @@ struct BatchGroup : public Batch
 
     /// Instance data.
     PODVector<InstanceData> instances_;
+    /// Diffuse textures indexed by the instances of a bindless group. Empty for a regular group.
+    PODVector<Texture*> bindlessTextures_;
     /// Instance stream start index, or M_MAX_UNSIGNED if transforms not pre-set.
     unsigned startIndex_;
 };
@@ -187,6 +197,7 @@ struct BatchGroupKey
         pass_(batch.pass_),
         material_(batch.material_),
         geometry_(batch.geometry_),
+        bindlessHash_(0),
         renderOrder_(batch.renderOrder_)
     {
     }
@@ -201,6 +212,8 @@ struct BatchGroupKey
     Material* material_;
     /// Geometry.
     Geometry* geometry_;
+    /// Material render state hash for a bindless group, which leaves the material null. Zero for a regular group.
+    unsigned bindlessHash_;
     /// 8-bit render order modifier from material.
     unsigned char renderOrder_;
 
@@ -208,26 +221,37 @@ struct BatchGroupKey
     bool operator ==(const BatchGroupKey& rhs) const
     {
         return zone_ == rhs.zone_ && lightQueue_ == rhs.lightQueue_ && pass_ == rhs.pass_ && material_ == rhs.material_ &&
-               geometry_ == rhs.geometry_ && renderOrder_ == rhs.renderOrder_;
+               geometry_ == rhs.geometry_ && bindlessHash_ == rhs.bindlessHash_ && renderOrder_ == rhs.renderOrder_;
     }
 
     /// Test for inequality with another batch group key.
     bool operator !=(const BatchGroupKey& rhs) const
     {
         return zone_ != rhs.zone_ || lightQueue_ != rhs.lightQueue_ || pass_ != rhs.pass_ || material_ != rhs.material_ ||
-               geometry_ != rhs.geometry_ || renderOrder_ != rhs.renderOrder_;
+               geometry_ != rhs.geometry_ || bindlessHash_ != rhs.bindlessHash_ || renderOrder_ != rhs.renderOrder_;
     }
 
     /// Return hash value.
     unsigned ToHash() const;
 };
 
+/// Sort key and value pair for radix sorting batches and instances.
+struct SortKeyEntry
+{
+    /// Sort key.
+    unsigned long long key_;
+    /// Sorted batch or instance.
+    void* value_;
+};
+
 /// Queue that contains both instanced and non-instanced draw calls.
-struct BatchQueue
+struct URHO3D_API BatchQueue
 {
 public:
-    /// Clear for new frame by clearing all groups and batches.
+    /// Clear for new frame by clearing all groups and batches. The groups' instance buffers are kept for reuse.
     void Clear(int maxSortedInstances);
+    /// Add a copy of a batch group without its instances. The new group takes a previously used instance buffer, so that filling it does not allocate. Return the iterator to the new group.
+    FlatHashMap<BatchGroupKey, BatchGroup>::Iterator AddBatchGroup(const BatchGroupKey& key, BatchGroup& group);
     /// Sort non-instanced draw calls back to front.
     void SortBackToFront();
     /// Sort instanced and non-instanced draw calls front to back.
@@ -245,7 +269,7 @@ public:
     bool IsEmpty() const { return batches_.Empty() && batchGroups_.Empty(); }
 
     /// Instanced draw calls.
-    HashMap<BatchGroupKey, BatchGroup> batchGroups_;
+    FlatHashMap<BatchGroupKey, BatchGroup> batchGroups_;
     /// Shader remapping table for 2-pass state and distance sort.
     HashMap<unsigned, unsigned> shaderRemapping_;
     /// Material remapping table for 2-pass state and distance sort.
@@ -259,6 +283,14 @@ public:
     PODVector<Batch*> sortedBatches_;
     /// Sorted instanced draw calls.
     PODVector<BatchGroup*> sortedBatchGroups_;
+    /// Sort key entries for radix sorting.
+    PODVector<SortKeyEntry> sortEntries_;
+    /// Sort key scratch buffer for radix sorting.
+    PODVector<SortKeyEntry> sortTemp_;
+    /// Instance scratch buffer for sorting instances.
+    PODVector<InstanceData> sortInstances_;
+    /// Instance buffers of the groups cleared on previous frames, retaining their capacity.
+    Vector<PODVector<InstanceData> > freeInstanceBuffers_;
     /// Maximum sorted instances.
     unsigned maxSortedInstances_;
     /// Whether the pass command contains extra shader defines.
@@ -273,6 +305,21 @@ public:
     StringHash psExtraDefinesHash_;
 };
 
+/// Persistent copy of a light's shadow map containing only the static shadow casters.
+struct ShadowMapCache
+{
+    /// Light the cache belongs to.
+    WeakPtr<Light> light_;
+    /// View camera the shadow map was focused for.
+    WeakPtr<Camera> camera_;
+    /// Cached static caster depth.
+    SharedPtr<Texture2D> texture_;
+    /// Static caster hash per split when the cache was last rendered. Zero if not rendered.
+    PODVector<unsigned> splitHashes_;
+    /// Frame number when the cache was last used.
+    unsigned frameNumber_{};
+};
+
 /// Queue for shadow map draw calls.
 struct ShadowBatchQueue
 {
@@ -280,8 +327,14 @@ struct ShadowBatchQueue
     Camera* shadowCamera_{};
     /// Shadow map viewport.
     IntRect shadowViewport_;
-    /// Shadow caster draw calls.
+    /// Shadow caster draw calls. When the shadow map is cached, contains only the dynamic casters.
     BatchQueue shadowBatches_;
+    /// Static shadow caster draw calls. Only filled when the split's cached depth needs to be re-rendered.
+    BatchQueue staticShadowBatches_;
+    /// Hash of the split's shadow camera and static casters.
+    unsigned staticHash_{};
+    /// Whether static casters need to be rendered to the cache.
+    bool renderStatic_{};
     /// Directional light cascade near split distance.
     float nearSplit_{};
     /// Directional light cascade far split distance.
@@ -297,6 +350,10 @@ struct LightBatchQueue
     bool negative_;
     /// Shadow map depth texture.
     Texture2D* shadowMap_;
+    /// Region of the shadow map used by the light. The whole texture unless allocated from the shadow map atlas.
+    IntRect shadowMapRect_;
+    /// Static shadow caster cache, or null if not cached.
+    ShadowMapCache* shadowCache_;
     /// Lit geometry draw calls, base (replace blend mode).
     BatchQueue litBaseBatches_;
     /// Lit geometry draw calls, non-base (additive).
@@ -94,7 +94,13 @@ BillboardSet::BillboardSet(Context* context) :
     sortThisFrame_(false),
     hasOrthoCamera_(false),
     sortFrameNumber_(0),
-    previousOffset_(Vector3::ZERO)
+    previousOffset_(Vector3::ZERO),
+    sortThreshold_(0.0f),
+    sortedCamera_(nullptr),
+    sortedFrameNumber_(0),
+    dirtyStart_(M_MAX_UNSIGNED),
+    dirtyEnd_(0),
+    identityLayout_(false)
 {
     geometry_->SetVertexBuffer(0, vertexBuffer_);
     geometry_->SetIndexBuffer(indexBuffer_);
@@ -117,6 +123,7 @@ void BillboardSet::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Relative Position", IsRelative, SetRelative, bool, true, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Relative Scale", IsScaled, SetScaled, bool, true, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Sort By Distance", IsSorted, SetSorted, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Sort Threshold", GetSortThreshold, SetSortThreshold, float, 0.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Fixed Screen Size", IsFixedScreenSize, SetFixedScreenSize, bool, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Can Be Occluded", IsOccludee, SetOccludee, bool, true, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Cast Shadows", bool, castShadows_, false, AM_DEFAULT);
@@ -188,10 +195,11 @@ void BillboardSet::UpdateBatches(const FrameInfo& frame)
 
     Vector3 worldPos = node_->GetWorldPosition();
     Vector3 offset = (worldPos - frame.camera_->GetNode()->GetWorldPosition());
-    // Sort if position relative to camera has changed
+    // Sort if position relative to camera has changed, or moved further than the threshold if one is set
     if (offset != previousOffset_ || frame.camera_->IsOrthographic() != hasOrthoCamera_)
     {
-        if (sorted_)
+        if (sorted_ && (sortThreshold_ <= 0.0f || frame.camera_->IsOrthographic() != hasOrthoCamera_ ||
+            (offset - previousOffset_).LengthSquared() >= sortThreshold_ * sortThreshold_))
             sortThisFrame_ = true;
         if (faceCameraMode_ == FC_DIRECTION)
             bufferDirty_ = true;
@@ -199,6 +207,16 @@ void BillboardSet::UpdateBatches(const FrameInfo& frame)
         hasOrthoCamera_ = frame.camera_->IsOrthographic();
     }
 
+    // Sort already here in the worker thread so that the main thread only needs to write the vertices. Shadow light
+    // processing may call this concurrently for the same billboard set; in that case leave the sorting to the other caller
+    // or the main thread
+    if (sorted_ && (sortThisFrame_ || bufferDirty_) && sortMutex_.TryAcquire())
+    {
+        if (sortedCamera_ != frame.camera_ || sortedFrameNumber_ != frame.frameNumber_)
+            SortBillboards(frame);
+        sortMutex_.Release();
+    }
+
     // Calculate fixed screen size scale factor for billboards. Will not dirty the buffer unless actually changed
     if (fixedScreenSize_)
         CalculateFixedScreenSize(frame);
@@ -240,13 +258,15 @@ void BillboardSet::UpdateGeometry(const FrameInfo& frame)
 
     if (bufferDirty_ || sortThisFrame_ || vertexBuffer_->IsDataLost())
         UpdateVertexBuffer(frame);
+    else if (dirtyStart_ < dirtyEnd_)
+        UpdateVertexRange(frame);
 }
 
 UpdateGeometryType BillboardSet::GetUpdateGeometryType()
 {
     // If using camera facing, always need some kind of geometry update, in case the billboard set is rendered from several views
     if (bufferDirty_ || bufferSizeDirty_ || vertexBuffer_->IsDataLost() || indexBuffer_->IsDataLost() || sortThisFrame_ ||
-        faceCameraMode_ != FC_NONE || fixedScreenSize_)
+        dirtyStart_ < dirtyEnd_ || faceCameraMode_ != FC_NONE || fixedScreenSize_)
         return UPDATE_MAIN_THREAD;
     else
         return UPDATE_NONE;
@@ -343,12 +363,37 @@ void BillboardSet::SetAnimationLodBias(float bias)
     MarkNetworkUpdate();
 }
 
+void BillboardSet::SetSortThreshold(float threshold)
+{
+    sortThreshold_ = Max(threshold, 0.0f);
+    MarkNetworkUpdate();
+}
+
 void BillboardSet::Commit()
 {
     MarkPositionsDirty();
     MarkNetworkUpdate();
 }
 
+void BillboardSet::CommitRange(unsigned start, unsigned count)
+{
+    unsigned end = Min(start + count, billboards_.Size());
+    if (start >= end)
+        return;
+
+    // Sorted billboards need their distances and order updated too, so rewrite them all
+    if (sorted_)
+    {
+        Commit();
+        return;
+    }
+
+    Drawable::OnMarkedDirty(node_);
+    dirtyStart_ = Min(dirtyStart_, start);
+    dirtyEnd_ = Max(dirtyEnd_, end);
+    MarkNetworkUpdate();
+}
+
 Material* BillboardSet::GetMaterial() const
 {
     return batches_[0].material_;
@@ -590,11 +635,72 @@ void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
         }
     }
 
+    // Reuse the order from the threaded batch update if already sorted for this view, otherwise sort now
+    if (sortedCamera_ != frame.camera_ || sortedFrameNumber_ != frame.frameNumber_)
+        SortBillboards(frame);
+
+    unsigned numBillboards = billboards_.Size();
+    unsigned enabledBillboards = sortedBillboards_.Size();
+    identityLayout_ = !sorted_ && enabledBillboards == numBillboards;
+
+    batches_[0].geometry_->SetDrawRange(TRIANGLE_LIST, 0, enabledBillboards * 6, false);
+
+    bufferDirty_ = false;
+    forceUpdate_ = false;
+    dirtyStart_ = M_MAX_UNSIGNED;
+    dirtyEnd_ = 0;
+    if (!enabledBillboards)
+        return;
+
+    auto* dest = (float*)vertexBuffer_->Lock(0, enabledBillboards * 4, true);
+    if (!dest)
+        return;
+
+    WriteVertices(dest, sortedBillboards_.Buffer(), enabledBillboards);
+
+    vertexBuffer_->Unlock();
+    vertexBuffer_->ClearDataLost();
+}
+
+void BillboardSet::UpdateVertexRange(const FrameInfo& frame)
+{
+    // Vertices of a billboard are at its own index only if none are disabled or reordered
+    unsigned start = dirtyStart_;
+    unsigned end = Min(dirtyEnd_, billboards_.Size());
+    if (!identityLayout_ || sorted_ || vertexBuffer_->GetVertexCount() < end * 4)
+    {
+        UpdateVertexBuffer(frame);
+        return;
+    }
+    for (unsigned i = start; i < end; ++i)
+    {
+        if (!billboards_[i].enabled_)
+        {
+            UpdateVertexBuffer(frame);
+            return;
+        }
+    }
+
+    dirtyStart_ = M_MAX_UNSIGNED;
+    dirtyEnd_ = 0;
+    if (start >= end)
+        return;
+
+    unsigned count = end - start;
+    PODVector<Billboard*> rangeBillboards(count);
+    for (unsigned i = 0; i < count; ++i)
+        rangeBillboards[i] = &billboards_[start + i];
+
+    PODVector<float> vertexData(count * 4 * vertexBuffer_->GetVertexSize() / sizeof(float));
+    WriteVertices(vertexData.Buffer(), rangeBillboards.Buffer(), count);
+    vertexBuffer_->SetDataRange(vertexData.Buffer(), start * 4, count * 4);
+}
+
+void BillboardSet::SortBillboards(const FrameInfo& frame)
+{
     unsigned numBillboards = billboards_.Size();
     unsigned enabledBillboards = 0;
-    const Matrix3x4& worldTransform = node_->GetWorldTransform();
-    Matrix3x4 billboardTransform = relative_ ? worldTransform : Matrix3x4::IDENTITY;
-    Vector3 billboardScale = scaled_ ? worldTransform.Scale() : Vector3::ONE;
+    Matrix3x4 billboardTransform = relative_ ? node_->GetWorldTransform() : Matrix3x4::IDENTITY;
 
     // First check number of enabled billboards
     for (unsigned i = 0; i < numBillboards; ++i)
@@ -618,14 +724,7 @@ void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
         }
     }
 
-    batches_[0].geometry_->SetDrawRange(TRIANGLE_LIST, 0, enabledBillboards * 6, false);
-
-    bufferDirty_ = false;
-    forceUpdate_ = false;
-    if (!enabledBillboards)
-        return;
-
-    if (sorted_)
+    if (sorted_ && enabledBillboards)
     {
         Sort(sortedBillboards_.Begin(), sortedBillboards_.End(), CompareBillboards);
         Vector3 worldPos = node_->GetWorldPosition();
@@ -633,15 +732,19 @@ void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
         previousOffset_ = (worldPos - frame.camera_->GetNode()->GetWorldPosition());
     }
 
-    auto* dest = (float*)vertexBuffer_->Lock(0, enabledBillboards * 4, true);
-    if (!dest)
-        return;
+    sortedCamera_ = frame.camera_;
+    sortedFrameNumber_ = frame.frameNumber_;
+}
+
+void BillboardSet::WriteVertices(float* dest, Billboard* const* billboards, unsigned count) const
+{
+    Vector3 billboardScale = scaled_ ? node_->GetWorldTransform().Scale() : Vector3::ONE;
 
     if (faceCameraMode_ != FC_DIRECTION)
     {
-        for (unsigned i = 0; i < enabledBillboards; ++i)
+        for (unsigned i = 0; i < count; ++i)
         {
-            Billboard& billboard = *sortedBillboards_[i];
+            Billboard& billboard = *billboards[i];
 
             Vector2 size(billboard.size_.x_ * billboardScale.x_, billboard.size_.y_ * billboardScale.y_);
             unsigned color = billboard.color_.ToUInt();
@@ -694,9 +797,9 @@ void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
     }
     else
     {
-        for (unsigned i = 0; i < enabledBillboards; ++i)
+        for (unsigned i = 0; i < count; ++i)
         {
-            Billboard& billboard = *sortedBillboards_[i];
+            Billboard& billboard = *billboards[i];
 
             Vector2 size(billboard.size_.x_ * billboardScale.x_, billboard.size_.y_ * billboardScale.y_);
             unsigned color = billboard.color_.ToUInt();
@@ -759,15 +862,13 @@ void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
             dest += 44;
         }
     }
-
-    vertexBuffer_->Unlock();
-    vertexBuffer_->ClearDataLost();
 }
 
 void BillboardSet::MarkPositionsDirty()
 {
     Drawable::OnMarkedDirty(node_);
     bufferDirty_ = true;
+    sortedCamera_ = nullptr;
 }
 
 void BillboardSet::CalculateFixedScreenSize(const FrameInfo& frame)
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../Core/Mutex.h"
 #include "../Graphics/Drawable.h"
 #include "../IO/VectorBuffer.h"
 #include "../Math/Color.h"
@@ -108,8 +109,13 @@ public:
     /// Set animation LOD bias.
     /// @property
     void SetAnimationLodBias(float bias);
+    /// Set how far the camera (relative to the billboard set) must move before the billboards are sorted again. Default 0 sorts on any movement.
+    /// @property
+    void SetSortThreshold(float threshold);
     /// Mark for bounding box and vertex buffer update. Call after modifying the billboards.
     void Commit();
+    /// Mark for bounding box update and a vertex update of a range of billboards only. Call after modifying only those billboards, without enabling or disabling any. Falls back to a full rewrite when sorted.
+    void CommitRange(unsigned start, unsigned count);
 
     /// Return material.
     /// @property
@@ -154,6 +160,10 @@ public:
     /// @property
     float GetAnimationLodBias() const { return animationLodBias_; }
 
+    /// Return camera movement threshold for re-sorting the billboards.
+    /// @property
+    float GetSortThreshold() const { return sortThreshold_; }
+
     /// Set material attribute.
     void SetMaterialAttr(const ResourceRef& value);
     /// Set billboards attribute.
@@ -197,6 +207,12 @@ private:
     void UpdateBufferSize();
     /// Rewrite billboard vertex buffer.
     void UpdateVertexBuffer(const FrameInfo& frame);
+    /// Rewrite the vertices of the dirty billboard range only, or the whole vertex buffer if the range can not be mapped directly to vertices.
+    void UpdateVertexRange(const FrameInfo& frame);
+    /// Collect the enabled billboards and sort them by distance to the camera if sorting is enabled.
+    void SortBillboards(const FrameInfo& frame);
+    /// Write the vertices of billboards.
+    void WriteVertices(float* dest, Billboard* const* billboards, unsigned count) const;
     /// Calculate billboard scale factors in fixed screen size mode.
     void CalculateFixedScreenSize(const FrameInfo& frame);
 
@@ -224,8 +240,22 @@ private:
     unsigned sortFrameNumber_;
     /// Previous offset to camera for determining whether sorting is necessary.
     Vector3 previousOffset_;
+    /// Camera movement threshold for re-sorting.
+    float sortThreshold_;
+    /// Camera the billboard pointers were last sorted for, or null if they must be collected again.
+    Camera* sortedCamera_;
+    /// Frame number on which the billboard pointers were last sorted.
+    unsigned sortedFrameNumber_;
+    /// First billboard of the dirty range.
+    unsigned dirtyStart_;
+    /// End of the dirty range.
+    unsigned dirtyEnd_;
+    /// Whether the vertex buffer holds every billboard in its original order, allowing range updates.
+    bool identityLayout_;
     /// Billboard pointers for sorting.
     Vector<Billboard*> sortedBillboards_;
+    /// Sorting mutex for sorting in the threaded batch update.
+    Mutex sortMutex_;
     /// Attribute buffer for network replication.
     mutable VectorBuffer attrBuffer_;
 };
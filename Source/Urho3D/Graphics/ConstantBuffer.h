@@ -54,12 +54,19 @@ public:
     void SetVector3ArrayParameter(unsigned offset, unsigned rows, const void* data);
     /// Apply to GPU.
     void Apply();
+    /// Replace the contents with data that has already been written to the constant ring buffer, so that applying does not upload it again. Used only on Diligent.
+    void SetRingData(const void* data, unsigned ringOffset, unsigned ringEpoch);
 
     /// Return size.
     unsigned GetSize() const { return size_; }
 
     /// Return whether has unapplied data.
     bool IsDirty() const { return dirty_; }
+    /// Return shadow data.
+    const unsigned char* GetShadowData() const { return shadowData_.Get(); }
+
+    /// Return byte offset of the applied data in the constant ring buffer. Used on Diligent, and on OpenGL with persistent mapping where M_MAX_UNSIGNED means the buffer object of its own is in use.
+    unsigned GetRingOffset() const { return ringOffset_; }
 
 private:
     /// Shadow data.
@@ -68,6 +75,10 @@ private:
     unsigned size_{};
     /// Dirty flag.
     bool dirty_{};
+    /// Byte offset of the applied data in the constant ring buffer. Used on Diligent and OpenGL.
+    unsigned ringOffset_{};
+    /// Constant ring buffer epoch the data was applied in. Used on Diligent and OpenGL.
+    unsigned ringEpoch_{};
 };
 
 }
@@ -211,6 +211,9 @@ void CustomGeometry::Clear()
     geometries_.Clear();
     primitiveTypes_.Clear();
     vertices_.Clear();
+    geometryBoundingBoxes_.Clear();
+    dirtyStarts_.Clear();
+    dirtyEnds_.Clear();
 }
 
 void CustomGeometry::SetNumGeometries(unsigned num)
@@ -219,6 +222,11 @@ void CustomGeometry::SetNumGeometries(unsigned num)
     geometries_.Resize(num);
     primitiveTypes_.Resize(num);
     vertices_.Resize(num);
+    geometryBoundingBoxes_.Resize(num);
+
+    unsigned oldNum = dirtyStarts_.Size();
+    dirtyStarts_.Resize(num);
+    dirtyEnds_.Resize(num);
 
     for (unsigned i = 0; i < geometries_.Size(); ++i)
     {
@@ -227,6 +235,13 @@ void CustomGeometry::SetNumGeometries(unsigned num)
 
         batches_[i].geometry_ = geometries_[i];
     }
+
+    for (unsigned i = oldNum; i < num; ++i)
+    {
+        geometryBoundingBoxes_[i].Clear();
+        dirtyStarts_[i] = 0;
+        dirtyEnds_[i] = M_MAX_UNSIGNED;
+    }
 }
 
 void CustomGeometry::SetDynamic(bool enable)
@@ -247,6 +262,7 @@ void CustomGeometry::BeginGeometry(unsigned index, PrimitiveType type)
     geometryIndex_ = index;
     primitiveTypes_[index] = type;
     vertices_[index].Clear();
+    MarkDirty(index, 0, M_MAX_UNSIGNED);
 
     // If beginning the first geometry, reset the element mask
     if (!index)
@@ -310,6 +326,7 @@ void CustomGeometry::DefineGeometry(unsigned index, PrimitiveType type, unsigned
     geometryIndex_ = index;
     primitiveTypes_[index] = type;
     vertices_[index].Resize(numVertices);
+    MarkDirty(index, 0, M_MAX_UNSIGNED);
 
     // If defining the first geometry, reset the element mask
     if (!index)
@@ -324,19 +341,60 @@ void CustomGeometry::DefineGeometry(unsigned index, PrimitiveType type, unsigned
         elementMask_ |= MASK_TANGENT;
 }
 
+bool CustomGeometry::UpdateVertices(unsigned geometryIndex, unsigned start, const PODVector<CustomGeometryVertex>& vertices)
+{
+    if (geometryIndex >= vertices_.Size() || start + vertices.Size() > vertices_[geometryIndex].Size())
+    {
+        URHO3D_LOGERROR("Illegal range for updating custom geometry vertices");
+        return false;
+    }
+
+    if (vertices.Empty())
+        return true;
+
+    memcpy(&vertices_[geometryIndex][start], &vertices[0], vertices.Size() * sizeof(CustomGeometryVertex));
+    MarkDirty(geometryIndex, start, start + vertices.Size());
+    return true;
+}
+
+void CustomGeometry::MarkVerticesDirty(unsigned geometryIndex, unsigned start, unsigned count)
+{
+    if (geometryIndex < vertices_.Size() && count)
+        MarkDirty(geometryIndex, start, start + count);
+}
+
 void CustomGeometry::Commit()
 {
     URHO3D_PROFILE(CommitCustomGeometry);
 
     unsigned totalVertices = 0;
-    boundingBox_.Clear();
+    bool bufferLayoutChanged = false;
 
     for (unsigned i = 0; i < vertices_.Size(); ++i)
     {
+        // Ranged upload is only possible if the geometry stays where it was in the vertex buffer
+        Geometry* geometry = geometries_[i];
+        if (geometry->GetVertexBuffer(0) != vertexBuffer_ || geometry->GetPrimitiveType() != primitiveTypes_[i] ||
+            geometry->GetVertexStart() != totalVertices || geometry->GetVertexCount() != vertices_[i].Size())
+            bufferLayoutChanged = true;
+
         totalVertices += vertices_[i].Size();
 
-        for (unsigned j = 0; j < vertices_[i].Size(); ++j)
-            boundingBox_.Merge(vertices_[i][j].position_);
+        // Recalculate the bounding box only for geometries that changed
+        if (dirtyStarts_[i] < dirtyEnds_[i])
+        {
+            BoundingBox& box = geometryBoundingBoxes_[i];
+            box.Clear();
+            for (unsigned j = 0; j < vertices_[i].Size(); ++j)
+                box.Merge(vertices_[i][j].position_);
+        }
+    }
+
+    boundingBox_.Clear();
+    for (unsigned i = 0; i < geometryBoundingBoxes_.Size(); ++i)
+    {
+        if (geometryBoundingBoxes_[i].Defined())
+            boundingBox_.Merge(geometryBoundingBoxes_[i]);
     }
 
     // Make sure world-space bounding box will be updated
@@ -345,9 +403,35 @@ void CustomGeometry::Commit()
     // Resize (recreate) the vertex buffer only if necessary
     if (vertexBuffer_->GetVertexCount() != totalVertices || vertexBuffer_->GetElementMask() != elementMask_ ||
         vertexBuffer_->IsDynamic() != dynamic_)
+    {
         vertexBuffer_->SetSize(totalVertices, elementMask_, dynamic_);
+        bufferLayoutChanged = true;
+    }
 
-    if (totalVertices)
+    if (!bufferLayoutChanged && !vertexBuffer_->IsDataLost())
+    {
+        // Upload only the changed vertex ranges
+        unsigned vertexStart = 0;
+        for (unsigned i = 0; i < vertices_.Size(); ++i)
+        {
+            unsigned start = dirtyStarts_[i];
+            unsigned end = Min(dirtyEnds_[i], vertices_[i].Size());
+            if (start < end)
+            {
+                auto* dest = (unsigned char*)vertexBuffer_->Lock(vertexStart + start, end - start, false);
+                if (dest)
+                {
+                    FillVertices(dest, i, start, end - start);
+                    vertexBuffer_->Unlock();
+                }
+                else
+                    URHO3D_LOGERROR("Failed to lock custom geometry vertex buffer");
+            }
+
+            vertexStart += vertices_[i].Size();
+        }
+    }
+    else if (totalVertices)
     {
         auto* dest = (unsigned char*)vertexBuffer_->Lock(0, totalVertices, true);
         if (dest)
@@ -356,36 +440,9 @@ void CustomGeometry::Commit()
 
             for (unsigned i = 0; i < vertices_.Size(); ++i)
             {
-                unsigned vertexCount = 0;
-
-                for (unsigned j = 0; j < vertices_[i].Size(); ++j)
-                {
-                    *((Vector3*)dest) = vertices_[i][j].position_;
-                    dest += sizeof(Vector3);
-
-                    if (elementMask_ & MASK_NORMAL)
-                    {
-                        *((Vector3*)dest) = vertices_[i][j].normal_;
-                        dest += sizeof(Vector3);
-                    }
-                    if (elementMask_ & MASK_COLOR)
-                    {
-                        *((unsigned*)dest) = vertices_[i][j].color_;
-                        dest += sizeof(unsigned);
-                    }
-                    if (elementMask_ & MASK_TEXCOORD1)
-                    {
-                        *((Vector2*)dest) = vertices_[i][j].texCoord_;
-                        dest += sizeof(Vector2);
-                    }
-                    if (elementMask_ & MASK_TANGENT)
-                    {
-                        *((Vector4*)dest) = vertices_[i][j].tangent_;
-                        dest += sizeof(Vector4);
-                    }
-
-                    ++vertexCount;
-                }
+                unsigned vertexCount = vertices_[i].Size();
+                FillVertices(dest, i, 0, vertexCount);
+                dest += vertexCount * vertexBuffer_->GetVertexSize();
 
                 geometries_[i]->SetVertexBuffer(0, vertexBuffer_);
                 geometries_[i]->SetDrawRange(primitiveTypes_[i], 0, 0, vertexStart, vertexCount);
@@ -406,6 +463,9 @@ void CustomGeometry::Commit()
         }
     }
 
+    for (unsigned i = 0; i < dirtyStarts_.Size(); ++i)
+        dirtyStarts_[i] = dirtyEnds_[i] = 0;
+
     vertexBuffer_->ClearDataLost();
 }
 
@@ -440,11 +500,21 @@ Material* CustomGeometry::GetMaterial(unsigned index) const
     return index < batches_.Size() ? batches_[index].material_ : nullptr;
 }
 
+Vector<PODVector<CustomGeometryVertex> >& CustomGeometry::GetVertices()
+{
+    for (unsigned i = 0; i < vertices_.Size(); ++i)
+        MarkDirty(i, 0, M_MAX_UNSIGNED);
+
+    return vertices_;
+}
+
 CustomGeometryVertex* CustomGeometry::GetVertex(unsigned geometryIndex, unsigned vertexNum)
 {
-    return (geometryIndex < vertices_.Size() && vertexNum < vertices_[geometryIndex].Size())
-               ? &vertices_[geometryIndex][vertexNum]
-               : nullptr;
+    if (geometryIndex >= vertices_.Size() || vertexNum >= vertices_[geometryIndex].Size())
+        return nullptr;
+
+    MarkDirty(geometryIndex, vertexNum, vertexNum + 1);
+    return &vertices_[geometryIndex][vertexNum];
 }
 
 void CustomGeometry::SetGeometryDataAttr(const PODVector<unsigned char>& value)
@@ -462,6 +532,7 @@ void CustomGeometry::SetGeometryDataAttr(const PODVector<unsigned char>& value)
         unsigned numVertices = buffer.ReadVLE();
         vertices_[i].Resize(numVertices);
         primitiveTypes_[i] = (PrimitiveType)buffer.ReadUByte();
+        MarkDirty(i, 0, M_MAX_UNSIGNED);
 
         for (unsigned j = 0; j < numVertices; ++j)
         {
@@ -528,6 +599,52 @@ const ResourceRefList& CustomGeometry::GetMaterialsAttr() const
     return materialsAttr_;
 }
 
+void CustomGeometry::MarkDirty(unsigned geometryIndex, unsigned start, unsigned end)
+{
+    if (dirtyStarts_[geometryIndex] < dirtyEnds_[geometryIndex])
+    {
+        dirtyStarts_[geometryIndex] = Min(dirtyStarts_[geometryIndex], start);
+        dirtyEnds_[geometryIndex] = Max(dirtyEnds_[geometryIndex], end);
+    }
+    else
+    {
+        dirtyStarts_[geometryIndex] = start;
+        dirtyEnds_[geometryIndex] = end;
+    }
+}
+
+void CustomGeometry::FillVertices(unsigned char* dest, unsigned geometryIndex, unsigned start, unsigned count) const
+{
+    const CustomGeometryVertex* src = &vertices_[geometryIndex][start];
+
+    for (unsigned i = 0; i < count; ++i, ++src)
+    {
+        *((Vector3*)dest) = src->position_;
+        dest += sizeof(Vector3);
+
+        if (elementMask_ & MASK_NORMAL)
+        {
+            *((Vector3*)dest) = src->normal_;
+            dest += sizeof(Vector3);
+        }
+        if (elementMask_ & MASK_COLOR)
+        {
+            *((unsigned*)dest) = src->color_;
+            dest += sizeof(unsigned);
+        }
+        if (elementMask_ & MASK_TEXCOORD1)
+        {
+            *((Vector2*)dest) = src->texCoord_;
+            dest += sizeof(Vector2);
+        }
+        if (elementMask_ & MASK_TANGENT)
+        {
+            *((Vector4*)dest) = src->tangent_;
+            dest += sizeof(Vector4);
+        }
+    }
+}
+
 void CustomGeometry::OnWorldBoundingBoxUpdate()
 {
     worldBoundingBox_ = boundingBox_.Transformed(node_->GetWorldTransform());
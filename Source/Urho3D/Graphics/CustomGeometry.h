@@ -92,7 +92,11 @@ public:
     void DefineGeometry
         (unsigned index, PrimitiveType type, unsigned numVertices, bool hasNormals, bool hasColors, bool hasTexCoords,
             bool hasTangents);
-    /// Update vertex buffer and calculate the bounding box. Call after finishing defining geometry.
+    /// Replace vertices of a geometry starting from a vertex index without defining the geometry again. The number of vertices does not change. Effective at the next Commit() call. Return true if successful.
+    bool UpdateVertices(unsigned geometryIndex, unsigned start, const PODVector<CustomGeometryVertex>& vertices);
+    /// Mark a vertex range of a geometry changed, for example after editing vertices through a pointer kept from GetVertex(). Only changed vertices are uploaded at the next Commit() call.
+    void MarkVerticesDirty(unsigned geometryIndex, unsigned start, unsigned count);
+    /// Update vertex buffer and calculate the bounding box. Call after finishing defining geometry. Only changed geometries are processed, and if the vertex counts stay the same only the changed vertex ranges are uploaded.
     void Commit();
     /// Set material on all geometries.
     /// @property
@@ -117,10 +121,12 @@ public:
     /// @property{get_materials}
     Material* GetMaterial(unsigned index = 0) const;
 
-    /// Return all vertices. These can be edited; calling Commit() updates the vertex buffer.
-    Vector<PODVector<CustomGeometryVertex> >& GetVertices() { return vertices_; }
+    /// Return all vertices. These can be edited; calling Commit() updates the vertex buffer. Marks all geometries changed.
+    Vector<PODVector<CustomGeometryVertex> >& GetVertices();
+    /// Return all vertices for reading.
+    const Vector<PODVector<CustomGeometryVertex> >& GetVertices() const { return vertices_; }
 
-    /// Return a vertex in a geometry for editing, or null if out of bounds. After the edits are finished, calling Commit() updates  the vertex buffer.
+    /// Return a vertex in a geometry for editing, or null if out of bounds. After the edits are finished, calling Commit() updates  the vertex buffer. Marks the vertex changed.
     CustomGeometryVertex* GetVertex(unsigned geometryIndex, unsigned vertexNum);
 
     /// Set geometry data attribute.
@@ -137,12 +143,23 @@ protected:
     void OnWorldBoundingBoxUpdate() override;
 
 private:
+    /// Mark a vertex range of a geometry changed. An end of M_MAX_UNSIGNED marks all of its vertices.
+    void MarkDirty(unsigned geometryIndex, unsigned start, unsigned end);
+    /// Write vertices of a geometry to vertex buffer memory using the current element mask.
+    void FillVertices(unsigned char* dest, unsigned geometryIndex, unsigned start, unsigned count) const;
+
     /// Primitive type per geometry.
     PODVector<PrimitiveType> primitiveTypes_;
     /// Source vertices per geometry.
     Vector<PODVector<CustomGeometryVertex> > vertices_;
     /// All geometries.
     Vector<SharedPtr<Geometry> > geometries_;
+    /// Local-space bounding box per geometry.
+    PODVector<BoundingBox> geometryBoundingBoxes_;
+    /// First vertex changed since the last commit per geometry.
+    PODVector<unsigned> dirtyStarts_;
+    /// End of the vertex range changed since the last commit per geometry, exclusive. Equal to the start if unchanged.
+    PODVector<unsigned> dirtyEnds_;
     /// Vertex buffer.
     SharedPtr<VertexBuffer> vertexBuffer_;
     /// Element mask used so far.
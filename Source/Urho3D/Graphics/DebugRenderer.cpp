@@ -22,6 +22,7 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/Sort.h"
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
@@ -29,9 +30,11 @@
 #include "../Graphics/Camera.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Graphics.h"
+#include "../Graphics/IndexBuffer.h"
 #include "../Graphics/Light.h"
 #include "../Graphics/ShaderVariation.h"
 #include "../Graphics/VertexBuffer.h"
+#include "../IO/Log.h"
 #include "../Math/Polyhedron.h"
 #include "../Resource/ResourceCache.h"
 
@@ -46,6 +49,85 @@ extern const char* SUBSYSTEM_CATEGORY;
 static const unsigned MAX_LINES = 1000000;
 // Cap the amount of triangles to prevent crash.
 static const unsigned MAX_TRIANGLES = 100000;
+// Cap the amount of instanced primitives per shape.
+static const unsigned MAX_INSTANCES = 100000;
+// Minimum vertex and instance buffer size, to avoid recreating the buffers for small changes in the amount of geometry.
+static const unsigned MIN_BUFFER_SIZE = 1024;
+
+// Primitive types of the instanced unit meshes.
+static const PrimitiveType shapePrimitiveTypes[] =
+{
+    LINE_LIST,
+    TRIANGLE_LIST,
+    LINE_LIST,
+    LINE_LIST
+};
+
+static_assert(sizeof(shapePrimitiveTypes) / sizeof(shapePrimitiveTypes[0]) == MAX_DEBUG_SHAPES, "Missing primitive type for a debug shape");
+
+// Write line vertices with position and color.
+static float* WriteLines(float* dest, const DebugLine* lines, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const DebugLine& line = lines[i];
+
+        dest[0] = line.start_.x_;
+        dest[1] = line.start_.y_;
+        dest[2] = line.start_.z_;
+        ((unsigned&)dest[3]) = line.color_;
+        dest[4] = line.end_.x_;
+        dest[5] = line.end_.y_;
+        dest[6] = line.end_.z_;
+        ((unsigned&)dest[7]) = line.color_;
+
+        dest += 8;
+    }
+
+    return dest;
+}
+
+// Write triangle vertices with position and color.
+static float* WriteTriangles(float* dest, const DebugTriangle* triangles, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const DebugTriangle& triangle = triangles[i];
+
+        dest[0] = triangle.v1_.x_;
+        dest[1] = triangle.v1_.y_;
+        dest[2] = triangle.v1_.z_;
+        ((unsigned&)dest[3]) = triangle.color_;
+
+        dest[4] = triangle.v2_.x_;
+        dest[5] = triangle.v2_.y_;
+        dest[6] = triangle.v2_.z_;
+        ((unsigned&)dest[7]) = triangle.color_;
+
+        dest[8] = triangle.v3_.x_;
+        dest[9] = triangle.v3_.y_;
+        dest[10] = triangle.v3_.z_;
+        ((unsigned&)dest[11]) = triangle.color_;
+
+        dest += 12;
+    }
+
+    return dest;
+}
+
+// Return buffer size for an amount of data. Grow in powers of two, and shrink only when much too large.
+static unsigned GetBufferSize(unsigned currentSize, unsigned neededSize)
+{
+    if (currentSize >= neededSize && currentSize <= Max(neededSize * 4, MIN_BUFFER_SIZE))
+        return currentSize;
+
+    return Max(NextPowerOfTwo(neededSize), MIN_BUFFER_SIZE);
+}
+
+static bool CompareInstanceColors(const DebugInstance& lhs, const DebugInstance& rhs)
+{
+    return lhs.color_ < rhs.color_;
+}
 
 DebugRenderer::DebugRenderer(Context* context) :
     Component(context),
@@ -53,6 +135,9 @@ DebugRenderer::DebugRenderer(Context* context) :
 {
     vertexBuffer_ = new VertexBuffer(context_);
 
+    auto* graphics = GetSubsystem<Graphics>();
+    instancing_ = graphics && graphics->GetInstancingSupport();
+
     SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(DebugRenderer, HandleEndFrame));
 }
 
@@ -78,6 +163,9 @@ void DebugRenderer::SetView(Camera* camera)
     if (!camera)
         return;
 
+    auto* graphics = GetSubsystem<Graphics>();
+    instancing_ = graphics && graphics->GetInstancingSupport();
+
     view_ = camera->GetView();
     projection_ = camera->GetProjection();
     gpuProjection_ = camera->GetGPUProjection();
@@ -143,6 +231,10 @@ void DebugRenderer::AddNode(Node* node, float scale, bool depthTest)
 
 void DebugRenderer::AddBoundingBox(const BoundingBox& box, const Color& color, bool depthTest, bool solid)
 {
+    if (AddInstance(solid ? DEBUG_SHAPE_SOLID_BOX : DEBUG_SHAPE_BOX, Matrix3x4(box.Center(), Quaternion::IDENTITY, box.Size()),
+        color.ToUInt(), depthTest))
+        return;
+
     const Vector3& min = box.min_;
     const Vector3& max = box.max_;
 
@@ -183,6 +275,10 @@ void DebugRenderer::AddBoundingBox(const BoundingBox& box, const Color& color, b
 
 void DebugRenderer::AddBoundingBox(const BoundingBox& box, const Matrix3x4& transform, const Color& color, bool depthTest, bool solid)
 {
+    if (AddInstance(solid ? DEBUG_SHAPE_SOLID_BOX : DEBUG_SHAPE_BOX, transform * Matrix3x4(box.Center(), Quaternion::IDENTITY, box.Size()),
+        color.ToUInt(), depthTest))
+        return;
+
     const Vector3& min = box.min_;
     const Vector3& max = box.max_;
 
@@ -261,6 +357,9 @@ void DebugRenderer::AddSphere(const Sphere& sphere, const Color& color, bool dep
 {
     unsigned uintColor = color.ToUInt();
 
+    if (AddInstance(DEBUG_SHAPE_SPHERE, Matrix3x4(sphere.center_, Quaternion::IDENTITY, sphere.radius_), uintColor, depthTest))
+        return;
+
     for (auto j = 0; j < 180; j += 45)
     {
         for (auto i = 0; i < 360; i += 45)
@@ -334,6 +433,10 @@ void DebugRenderer::AddSphereSector(const Sphere& sphere, const Quaternion& rota
 
 void DebugRenderer::AddCylinder(const Vector3& position, float radius, float height, const Color& color, bool depthTest)
 {
+    if (AddInstance(DEBUG_SHAPE_CYLINDER, Matrix3x4(position, Quaternion::IDENTITY, Vector3(radius, height, radius)), color.ToUInt(),
+        depthTest))
+        return;
+
     Sphere sphere(position, radius);
     Vector3 heightVec(0, height, 0);
     Vector3 offsetXVec(radius, 0, 0);
@@ -485,6 +588,74 @@ void DebugRenderer::AddQuad(const Vector3& center, float width, float height, co
     AddLine(v3, v0, uintColor, depthTest);
 }
 
+void DebugRenderer::BeginStaticGeometry(const StringHash& key)
+{
+    if (recordingStatic_)
+        EndStaticGeometry();
+
+    staticGeometryKey_ = key;
+    staticLinesStart_ = lines_.Size();
+    staticNoDepthLinesStart_ = noDepthLines_.Size();
+    staticTrianglesStart_ = triangles_.Size();
+    staticNoDepthTrianglesStart_ = noDepthTriangles_.Size();
+    recordingStatic_ = true;
+}
+
+void DebugRenderer::EndStaticGeometry()
+{
+    if (!recordingStatic_)
+        return;
+
+    recordingStatic_ = false;
+
+    DebugStaticGeometry geometry;
+    geometry.numLines_ = lines_.Size() - staticLinesStart_;
+    geometry.numNoDepthLines_ = noDepthLines_.Size() - staticNoDepthLinesStart_;
+    geometry.numTriangles_ = triangles_.Size() - staticTrianglesStart_;
+    geometry.numNoDepthTriangles_ = noDepthTriangles_.Size() - staticNoDepthTrianglesStart_;
+
+    unsigned numVertices = (geometry.numLines_ + geometry.numNoDepthLines_) * 2 +
+        (geometry.numTriangles_ + geometry.numNoDepthTriangles_) * 3;
+    if (!numVertices)
+    {
+        staticGeometries_.Erase(staticGeometryKey_);
+        return;
+    }
+
+    PODVector<float> vertexData(numVertices * 4);
+    float* dest = vertexData.Buffer();
+    dest = WriteLines(dest, lines_.Buffer() + staticLinesStart_, geometry.numLines_);
+    dest = WriteLines(dest, noDepthLines_.Buffer() + staticNoDepthLinesStart_, geometry.numNoDepthLines_);
+    dest = WriteTriangles(dest, triangles_.Buffer() + staticTrianglesStart_, geometry.numTriangles_);
+    WriteTriangles(dest, noDepthTriangles_.Buffer() + staticNoDepthTrianglesStart_, geometry.numNoDepthTriangles_);
+
+    // The recorded geometry is now owned by the static vertex buffer, so remove it from the per-frame arrays
+    lines_.Resize(staticLinesStart_);
+    noDepthLines_.Resize(staticNoDepthLinesStart_);
+    triangles_.Resize(staticTrianglesStart_);
+    noDepthTriangles_.Resize(staticNoDepthTrianglesStart_);
+
+    geometry.vertexBuffer_ = new VertexBuffer(context_);
+    if (!geometry.vertexBuffer_->SetSize(numVertices, MASK_POSITION | MASK_COLOR) || !geometry.vertexBuffer_->SetData(vertexData.Buffer()))
+    {
+        URHO3D_LOGERROR("Failed to create static debug geometry vertex buffer");
+        staticGeometries_.Erase(staticGeometryKey_);
+        return;
+    }
+
+    staticGeometries_[staticGeometryKey_] = geometry;
+}
+
+void DebugRenderer::RemoveStaticGeometry(const StringHash& key)
+{
+    staticGeometries_.Erase(key);
+}
+
+void DebugRenderer::RemoveAllStaticGeometry()
+{
+    staticGeometries_.Clear();
+}
+
 void DebugRenderer::Render()
 {
     if (!HasContent())
@@ -500,156 +671,328 @@ void DebugRenderer::Render()
     ShaderVariation* ps = graphics->GetShader(PS, "Basic", "VERTEXCOLOR");
 
     unsigned numVertices = (lines_.Size() + noDepthLines_.Size()) * 2 + (triangles_.Size() + noDepthTriangles_.Size()) * 3;
-    // Resize the vertex buffer if too small or much too large
-    if (vertexBuffer_->GetVertexCount() < numVertices || vertexBuffer_->GetVertexCount() > numVertices * 2)
-        vertexBuffer_->SetSize(numVertices, MASK_POSITION | MASK_COLOR, true);
-
-    auto* dest = (float*)vertexBuffer_->Lock(0, numVertices, true);
-    if (!dest)
-        return;
-
-    for (unsigned i = 0; i < lines_.Size(); ++i)
+    if (numVertices)
     {
-        const DebugLine& line = lines_[i];
+        // Resize the vertex buffer if too small or much too large
+        unsigned bufferSize = GetBufferSize(vertexBuffer_->GetVertexCount(), numVertices);
+        if (bufferSize != vertexBuffer_->GetVertexCount())
+            vertexBuffer_->SetSize(bufferSize, MASK_POSITION | MASK_COLOR, true);
 
-        dest[0] = line.start_.x_;
-        dest[1] = line.start_.y_;
-        dest[2] = line.start_.z_;
-        ((unsigned&)dest[3]) = line.color_;
-        dest[4] = line.end_.x_;
-        dest[5] = line.end_.y_;
-        dest[6] = line.end_.z_;
-        ((unsigned&)dest[7]) = line.color_;
+        auto* dest = (float*)vertexBuffer_->Lock(0, numVertices, true);
+        if (!dest)
+            return;
 
-        dest += 8;
+        dest = WriteLines(dest, lines_.Buffer(), lines_.Size());
+        dest = WriteLines(dest, noDepthLines_.Buffer(), noDepthLines_.Size());
+        dest = WriteTriangles(dest, triangles_.Buffer(), triangles_.Size());
+        WriteTriangles(dest, noDepthTriangles_.Buffer(), noDepthTriangles_.Size());
+
+        vertexBuffer_->Unlock();
     }
 
-    for (unsigned i = 0; i < noDepthLines_.Size(); ++i)
+    // Upload the transforms of all instanced primitives at once, sorted by color within each shape so that each color
+    // can be drawn with a single instanced draw call
+    unsigned numInstances = 0;
+    for (unsigned i = 0; i < MAX_DEBUG_SHAPES; ++i)
+        numInstances += instances_[i].Size() + noDepthInstances_[i].Size();
+
+    if (numInstances)
     {
-        const DebugLine& line = noDepthLines_[i];
+        if (!shapeVertexBuffer_)
+            CreateShapeMeshes();
+        if (!instanceBuffer_)
+            instanceBuffer_ = new VertexBuffer(context_);
 
-        dest[0] = line.start_.x_;
-        dest[1] = line.start_.y_;
-        dest[2] = line.start_.z_;
-        ((unsigned&)dest[3]) = line.color_;
-        dest[4] = line.end_.x_;
-        dest[5] = line.end_.y_;
-        dest[6] = line.end_.z_;
-        ((unsigned&)dest[7]) = line.color_;
+        unsigned bufferSize = GetBufferSize(instanceBuffer_->GetVertexCount(), numInstances);
+        if (bufferSize != instanceBuffer_->GetVertexCount())
+        {
+            // Reuse the texcoords the renderer uses for instancing, which the Basic shader reads the model matrix from
+            PODVector<VertexElement> elements;
+            for (unsigned i = 0; i < 3; ++i)
+                elements.Push(VertexElement(TYPE_VECTOR4, SEM_TEXCOORD, 4 + i, true));
+            instanceBuffer_->SetSize(bufferSize, elements, true);
+        }
 
-        dest += 8;
+        auto* dest = (Matrix3x4*)instanceBuffer_->Lock(0, numInstances, true);
+        if (!dest)
+            return;
+
+        for (unsigned i = 0; i < MAX_DEBUG_SHAPES; ++i)
+        {
+            PODVector<DebugInstance>* buckets[] = { &instances_[i], &noDepthInstances_[i] };
+            for (PODVector<DebugInstance>* bucket : buckets)
+            {
+                Sort(bucket->Begin(), bucket->End(), CompareInstanceColors);
+                for (const DebugInstance& instance : *bucket)
+                    *dest++ = instance.transform_;
+            }
+        }
+
+        instanceBuffer_->Unlock();
     }
 
-    for (unsigned i = 0; i < triangles_.Size(); ++i)
+    graphics->SetBlendMode(lineAntiAlias_ ? BLEND_ALPHA : BLEND_REPLACE);
+    graphics->SetColorWrite(true);
+    graphics->SetCullMode(CULL_NONE);
+    graphics->SetDepthWrite(true);
+    graphics->SetLineAntiAlias(lineAntiAlias_);
+    graphics->SetScissorTest(false);
+    graphics->SetStencilTest(false);
+
+    for (unsigned pass = 0; pass < 2; ++pass)
     {
-        const DebugTriangle& triangle = triangles_[i];
+        const bool solid = pass == 1;
+        if (solid)
+        {
+            graphics->SetBlendMode(BLEND_ALPHA);
+            graphics->SetDepthWrite(false);
+        }
 
-        dest[0] = triangle.v1_.x_;
-        dest[1] = triangle.v1_.y_;
-        dest[2] = triangle.v1_.z_;
-        ((unsigned&)dest[3]) = triangle.color_;
+        graphics->SetShaders(vs, ps);
+        graphics->SetShaderParameter(VSP_MODEL, Matrix3x4::IDENTITY);
+        graphics->SetShaderParameter(VSP_VIEW, view_);
+        graphics->SetShaderParameter(VSP_VIEWINV, view_.Inverse());
+        graphics->SetShaderParameter(VSP_VIEWPROJ, gpuProjection_ * view_);
+        graphics->SetShaderParameter(PSP_MATDIFFCOLOR, Color(1.0f, 1.0f, 1.0f, 1.0f));
 
-        dest[4] = triangle.v2_.x_;
-        dest[5] = triangle.v2_.y_;
-        dest[6] = triangle.v2_.z_;
-        ((unsigned&)dest[7]) = triangle.color_;
+        // Per-frame geometry is stored lines first, triangles after
+        if (numVertices)
+        {
+            graphics->SetVertexBuffer(vertexBuffer_);
+
+            unsigned numLines = lines_.Size() * 2;
+            unsigned numNoDepthLines = noDepthLines_.Size() * 2;
+            unsigned numTriangles = triangles_.Size() * 3;
+            unsigned numNoDepthTriangles = noDepthTriangles_.Size() * 3;
+
+            PrimitiveType type = solid ? TRIANGLE_LIST : LINE_LIST;
+            unsigned start = solid ? numLines + numNoDepthLines : 0;
+            unsigned count = solid ? numTriangles : numLines;
+            unsigned noDepthCount = solid ? numNoDepthTriangles : numNoDepthLines;
+
+            if (count)
+            {
+                graphics->SetDepthTest(CMP_LESSEQUAL);
+                graphics->Draw(type, start, count);
+            }
+            if (noDepthCount)
+            {
+                graphics->SetDepthTest(CMP_ALWAYS);
+                graphics->Draw(type, start + count, noDepthCount);
+            }
+        }
 
-        dest[8] = triangle.v3_.x_;
-        dest[9] = triangle.v3_.y_;
-        dest[10] = triangle.v3_.z_;
-        ((unsigned&)dest[11]) = triangle.color_;
+        for (HashMap<StringHash, DebugStaticGeometry>::ConstIterator i = staticGeometries_.Begin(); i != staticGeometries_.End(); ++i)
+        {
+            const DebugStaticGeometry& geometry = i->second_;
+            graphics->SetVertexBuffer(geometry.vertexBuffer_);
+
+            unsigned numLines = geometry.numLines_ * 2;
+            unsigned numNoDepthLines = geometry.numNoDepthLines_ * 2;
+
+            PrimitiveType type = solid ? TRIANGLE_LIST : LINE_LIST;
+            unsigned start = solid ? numLines + numNoDepthLines : 0;
+            unsigned count = solid ? geometry.numTriangles_ * 3 : numLines;
+            unsigned noDepthCount = solid ? geometry.numNoDepthTriangles_ * 3 : numNoDepthLines;
+
+            if (count)
+            {
+                graphics->SetDepthTest(CMP_LESSEQUAL);
+                graphics->Draw(type, start, count);
+            }
+            if (noDepthCount)
+            {
+                graphics->SetDepthTest(CMP_ALWAYS);
+                graphics->Draw(type, start + count, noDepthCount);
+            }
+        }
 
-        dest += 12;
+        if (numInstances)
+            RenderInstances(graphics, solid);
     }
 
-    for (unsigned i = 0; i < noDepthTriangles_.Size(); ++i)
-    {
-        const DebugTriangle& triangle = noDepthTriangles_[i];
-
-        dest[0] = triangle.v1_.x_;
-        dest[1] = triangle.v1_.y_;
-        dest[2] = triangle.v1_.z_;
-        ((unsigned&)dest[3]) = triangle.color_;
+    graphics->SetLineAntiAlias(false);
+}
 
-        dest[4] = triangle.v2_.x_;
-        dest[5] = triangle.v2_.y_;
-        dest[6] = triangle.v2_.z_;
-        ((unsigned&)dest[7]) = triangle.color_;
+bool DebugRenderer::IsInside(const BoundingBox& box) const
+{
+    return frustum_.IsInsideFast(box) == INSIDE;
+}
 
-        dest[8] = triangle.v3_.x_;
-        dest[9] = triangle.v3_.y_;
-        dest[10] = triangle.v3_.z_;
-        ((unsigned&)dest[11]) = triangle.color_;
+bool DebugRenderer::HasContent() const
+{
+    if (!(lines_.Empty() && noDepthLines_.Empty() && triangles_.Empty() && noDepthTriangles_.Empty() && staticGeometries_.Empty()))
+        return true;
 
-        dest += 12;
+    for (unsigned i = 0; i < MAX_DEBUG_SHAPES; ++i)
+    {
+        if (!instances_[i].Empty() || !noDepthInstances_[i].Empty())
+            return true;
     }
 
-    vertexBuffer_->Unlock();
+    return false;
+}
 
-    graphics->SetBlendMode(lineAntiAlias_ ? BLEND_ALPHA : BLEND_REPLACE);
-    graphics->SetColorWrite(true);
-    graphics->SetCullMode(CULL_NONE);
-    graphics->SetDepthWrite(true);
-    graphics->SetLineAntiAlias(lineAntiAlias_);
-    graphics->SetScissorTest(false);
-    graphics->SetStencilTest(false);
-    graphics->SetShaders(vs, ps);
-    graphics->SetShaderParameter(VSP_MODEL, Matrix3x4::IDENTITY);
-    graphics->SetShaderParameter(VSP_VIEW, view_);
-    graphics->SetShaderParameter(VSP_VIEWINV, view_.Inverse());
-    graphics->SetShaderParameter(VSP_VIEWPROJ, gpuProjection_ * view_);
-    graphics->SetShaderParameter(PSP_MATDIFFCOLOR, Color(1.0f, 1.0f, 1.0f, 1.0f));
-    graphics->SetVertexBuffer(vertexBuffer_);
+bool DebugRenderer::AddInstance(DebugShape shape, const Matrix3x4& transform, unsigned color, bool depthTest)
+{
+    // Static geometry is baked into a vertex buffer, so it can not use instancing
+    if (!instancing_ || recordingStatic_)
+        return false;
+
+    PODVector<DebugInstance>& dest = depthTest ? instances_[shape] : noDepthInstances_[shape];
+    if (dest.Size() < MAX_INSTANCES)
+        dest.Push(DebugInstance(transform, color));
+
+    return true;
+}
 
-    unsigned start = 0;
-    unsigned count = 0;
-    if (lines_.Size())
+void DebugRenderer::CreateShapeMeshes()
+{
+    PODVector<Vector3> vertices;
+    PODVector<unsigned short> indices;
+
+    // Unit box centered on origin. Corner index bits select the positive side on X, Y and Z axes
+    const unsigned boxStart = vertices.Size();
+    for (unsigned i = 0; i < 8; ++i)
+        vertices.Push(Vector3((i & 1u) ? 0.5f : -0.5f, (i & 2u) ? 0.5f : -0.5f, (i & 4u) ? 0.5f : -0.5f));
+
+    const unsigned short boxLines[] = { 0, 1, 1, 3, 3, 2, 2, 0, 4, 5, 5, 7, 7, 6, 6, 4, 0, 4, 1, 5, 3, 7, 2, 6 };
+    shapeIndexStarts_[DEBUG_SHAPE_BOX] = indices.Size();
+    for (unsigned short index : boxLines)
+        indices.Push(boxStart + index);
+    shapeIndexCounts_[DEBUG_SHAPE_BOX] = indices.Size() - shapeIndexStarts_[DEBUG_SHAPE_BOX];
+
+    const unsigned short boxFaces[] = { 0, 1, 3, 2, 4, 5, 7, 6, 0, 4, 6, 2, 1, 5, 7, 3, 2, 3, 7, 6, 0, 1, 5, 4 };
+    shapeIndexStarts_[DEBUG_SHAPE_SOLID_BOX] = indices.Size();
+    for (unsigned i = 0; i < 24; i += 4)
     {
-        count = lines_.Size() * 2;
-        graphics->SetDepthTest(CMP_LESSEQUAL);
-        graphics->Draw(LINE_LIST, start, count);
-        start += count;
+        const unsigned short* face = &boxFaces[i];
+        const unsigned short triangles[] = { face[0], face[1], face[2], face[2], face[3], face[0] };
+        for (unsigned short index : triangles)
+            indices.Push(boxStart + index);
     }
-    if (noDepthLines_.Size())
+    shapeIndexCounts_[DEBUG_SHAPE_SOLID_BOX] = indices.Size() - shapeIndexStarts_[DEBUG_SHAPE_SOLID_BOX];
+
+    // Unit sphere, tessellated the same way as the non-instanced version
+    const unsigned sphereStart = vertices.Size();
+    const Sphere unitSphere(Vector3::ZERO, 1.0f);
+    for (unsigned j = 0; j < 5; ++j)
     {
-        count = noDepthLines_.Size() * 2;
-        graphics->SetDepthTest(CMP_ALWAYS);
-        graphics->Draw(LINE_LIST, start, count);
-        start += count;
+        for (unsigned i = 0; i < 8; ++i)
+            vertices.Push(unitSphere.GetLocalPoint(i * 45.0f, j * 45.0f));
     }
 
-    graphics->SetBlendMode(BLEND_ALPHA);
-    graphics->SetDepthWrite(false);
+    shapeIndexStarts_[DEBUG_SHAPE_SPHERE] = indices.Size();
+    for (unsigned j = 0; j < 4; ++j)
+    {
+        for (unsigned i = 0; i < 8; ++i)
+        {
+            // Horizontal rings, skipping the degenerate pole ring
+            if (j)
+            {
+                indices.Push(sphereStart + j * 8 + i);
+                indices.Push(sphereStart + j * 8 + (i + 1) % 8);
+            }
+            indices.Push(sphereStart + j * 8 + i);
+            indices.Push(sphereStart + (j + 1) * 8 + i);
+        }
+    }
+    shapeIndexCounts_[DEBUG_SHAPE_SPHERE] = indices.Size() - shapeIndexStarts_[DEBUG_SHAPE_SPHERE];
 
-    if (triangles_.Size())
+    // Unit cylinder with base on origin, extending along the positive Y axis
+    const unsigned cylinderStart = vertices.Size();
+    for (unsigned j = 0; j < 2; ++j)
     {
-        count = triangles_.Size() * 3;
-        graphics->SetDepthTest(CMP_LESSEQUAL);
-        graphics->Draw(TRIANGLE_LIST, start, count);
-        start += count;
+        for (unsigned i = 0; i < 8; ++i)
+        {
+            float angle = i * 45.0f;
+            vertices.Push(Vector3(Sin(angle), (float)j, Cos(angle)));
+        }
     }
-    if (noDepthTriangles_.Size())
+
+    shapeIndexStarts_[DEBUG_SHAPE_CYLINDER] = indices.Size();
+    for (unsigned i = 0; i < 8; ++i)
     {
-        count = noDepthTriangles_.Size() * 3;
-        graphics->SetDepthTest(CMP_ALWAYS);
-        graphics->Draw(TRIANGLE_LIST, start, count);
+        for (unsigned j = 0; j < 2; ++j)
+        {
+            indices.Push(cylinderStart + j * 8 + i);
+            indices.Push(cylinderStart + j * 8 + (i + 1) % 8);
+        }
+        if (!(i & 1u))
+        {
+            indices.Push(cylinderStart + i);
+            indices.Push(cylinderStart + 8 + i);
+        }
     }
+    shapeIndexCounts_[DEBUG_SHAPE_CYLINDER] = indices.Size() - shapeIndexStarts_[DEBUG_SHAPE_CYLINDER];
 
-    graphics->SetLineAntiAlias(false);
-}
+    shapeVertexBuffer_ = new VertexBuffer(context_);
+    shapeVertexBuffer_->SetSize(vertices.Size(), MASK_POSITION);
+    shapeVertexBuffer_->SetData(vertices.Buffer());
 
-bool DebugRenderer::IsInside(const BoundingBox& box) const
-{
-    return frustum_.IsInsideFast(box) == INSIDE;
+    shapeIndexBuffer_ = new IndexBuffer(context_);
+    shapeIndexBuffer_->SetSize(indices.Size(), false);
+    shapeIndexBuffer_->SetData(indices.Buffer());
 }
 
-bool DebugRenderer::HasContent() const
+void DebugRenderer::RenderInstances(Graphics* graphics, bool solid)
 {
-    return !(lines_.Empty() && noDepthLines_.Empty() && triangles_.Empty() && noDepthTriangles_.Empty());
+    ShaderVariation* vs = graphics->GetShader(VS, "Basic", "INSTANCED");
+    ShaderVariation* ps = graphics->GetShader(PS, "Basic");
+
+    graphics->SetShaders(vs, ps);
+    graphics->SetShaderParameter(VSP_VIEW, view_);
+    graphics->SetShaderParameter(VSP_VIEWINV, view_.Inverse());
+    graphics->SetShaderParameter(VSP_VIEWPROJ, gpuProjection_ * view_);
+    graphics->SetIndexBuffer(shapeIndexBuffer_);
+
+    PODVector<VertexBuffer*> vertexBuffers(2);
+    vertexBuffers[0] = shapeVertexBuffer_;
+    vertexBuffers[1] = instanceBuffer_;
+
+    // Instances are stored in shape order, with depth tested instances before the others
+    unsigned instanceStart = 0;
+    for (unsigned i = 0; i < MAX_DEBUG_SHAPES; ++i)
+    {
+        const PODVector<DebugInstance>* buckets[] = { &instances_[i], &noDepthInstances_[i] };
+        for (unsigned j = 0; j < 2; ++j)
+        {
+            const PODVector<DebugInstance>& bucket = *buckets[j];
+            if (bucket.Empty() || (shapePrimitiveTypes[i] == TRIANGLE_LIST) != solid)
+            {
+                instanceStart += bucket.Size();
+                continue;
+            }
+
+            graphics->SetDepthTest(j ? CMP_ALWAYS : CMP_LESSEQUAL);
+
+            // Draw each run of same colored instances with one call
+            unsigned runStart = 0;
+            while (runStart < bucket.Size())
+            {
+                unsigned color = bucket[runStart].color_;
+                unsigned runEnd = runStart + 1;
+                while (runEnd < bucket.Size() && bucket[runEnd].color_ == color)
+                    ++runEnd;
+
+                graphics->SetShaderParameter(PSP_MATDIFFCOLOR, Color(color));
+                graphics->SetVertexBuffers(vertexBuffers, instanceStart + runStart);
+                graphics->DrawInstanced(shapePrimitiveTypes[i], shapeIndexStarts_[i], shapeIndexCounts_[i], 0,
+                    shapeVertexBuffer_->GetVertexCount(), runEnd - runStart);
+
+                runStart = runEnd;
+            }
+
+            instanceStart += bucket.Size();
+        }
+    }
 }
 
 void DebugRenderer::HandleEndFrame(StringHash eventType, VariantMap& eventData)
 {
+    // Static geometry recording may not span frames
+    EndStaticGeometry();
+
     // When the amount of debug geometry is reduced, release memory
     unsigned linesSize = lines_.Size();
     unsigned noDepthLinesSize = noDepthLines_.Size();
@@ -669,6 +1012,20 @@ void DebugRenderer::HandleEndFrame(StringHash eventType, VariantMap& eventData)
         triangles_.Reserve(trianglesSize);
     if (noDepthTriangles_.Capacity() > noDepthTrianglesSize * 2)
         noDepthTriangles_.Reserve(noDepthTrianglesSize);
+
+    for (unsigned i = 0; i < MAX_DEBUG_SHAPES; ++i)
+    {
+        unsigned instancesSize = instances_[i].Size();
+        unsigned noDepthInstancesSize = noDepthInstances_[i].Size();
+
+        instances_[i].Clear();
+        noDepthInstances_[i].Clear();
+
+        if (instances_[i].Capacity() > instancesSize * 2)
+            instances_[i].Reserve(instancesSize);
+        if (noDepthInstances_[i].Capacity() > noDepthInstancesSize * 2)
+            noDepthInstances_[i].Reserve(noDepthInstancesSize);
+    }
 }
 
 }
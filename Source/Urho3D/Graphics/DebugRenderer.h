@@ -33,10 +33,12 @@ class BoundingBox;
 class Camera;
 class Polyhedron;
 class Drawable;
+class Graphics;
 class Light;
 class Matrix3x4;
 class Renderer;
 class Skeleton;
+class IndexBuffer;
 class Sphere;
 class VertexBuffer;
 
@@ -87,6 +89,50 @@ struct DebugTriangle
     unsigned color_{};
 };
 
+/// Debug render primitive drawn by instancing a shared unit mesh.
+struct DebugInstance
+{
+    /// Construct undefined.
+    DebugInstance() = default;
+
+    /// Construct with transform and color.
+    DebugInstance(const Matrix3x4& transform, unsigned color) :
+        transform_(transform),
+        color_(color)
+    {
+    }
+
+    /// Transform of the unit mesh.
+    Matrix3x4 transform_;
+    /// Color.
+    unsigned color_{};
+};
+
+/// Instanced debug render primitive type.
+enum DebugShape
+{
+    DEBUG_SHAPE_BOX = 0,
+    DEBUG_SHAPE_SOLID_BOX,
+    DEBUG_SHAPE_SPHERE,
+    DEBUG_SHAPE_CYLINDER,
+    MAX_DEBUG_SHAPES
+};
+
+/// Cached debug geometry. Rendered every frame until removed, and uploaded to the GPU only when recorded again.
+struct DebugStaticGeometry
+{
+    /// Vertex buffer.
+    SharedPtr<VertexBuffer> vertexBuffer_;
+    /// Number of lines rendered with depth test.
+    unsigned numLines_{};
+    /// Number of lines rendered without depth test.
+    unsigned numNoDepthLines_{};
+    /// Number of triangles rendered with depth test.
+    unsigned numTriangles_{};
+    /// Number of triangles rendered without depth test.
+    unsigned numNoDepthTriangles_{};
+};
+
 /// Debug geometry rendering component. Should be added only to the root scene node.
 class URHO3D_API DebugRenderer : public Component
 {
@@ -150,6 +196,15 @@ public:
     /// Add a quad on the XZ plane.
     void AddQuad(const Vector3& center, float width, float height, const Color& color, bool depthTest = true);
 
+    /// Begin recording static debug geometry under a key, replacing any geometry recorded under it before. Geometry added until EndStaticGeometry() is cached and rendered every frame without being uploaded again.
+    void BeginStaticGeometry(const StringHash& key);
+    /// End recording static debug geometry and upload it.
+    void EndStaticGeometry();
+    /// Remove static debug geometry.
+    void RemoveStaticGeometry(const StringHash& key);
+    /// Remove all static debug geometry.
+    void RemoveAllStaticGeometry();
+
     /// Update vertex buffer and render all debug lines. The viewport and rendertarget should be set before.
     void Render();
 
@@ -166,6 +221,9 @@ public:
     /// Return the view frustum.
     const Frustum& GetFrustum() const { return frustum_; }
 
+    /// Return whether static debug geometry exists under a key.
+    bool HasStaticGeometry(const StringHash& key) const { return staticGeometries_.Contains(key); }
+
     /// Check whether a bounding box is inside the view frustum.
     bool IsInside(const BoundingBox& box) const;
     /// Return whether has something to render.
@@ -174,6 +232,12 @@ public:
 private:
     /// Handle end of frame. Clear debug geometry.
     void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+    /// Add an instanced primitive. Return false if instancing can not be used, in which case the caller should add lines or triangles instead.
+    bool AddInstance(DebugShape shape, const Matrix3x4& transform, unsigned color, bool depthTest);
+    /// Create the unit meshes drawn by instanced primitives.
+    void CreateShapeMeshes();
+    /// Render either the wireframe or the solid instanced primitives.
+    void RenderInstances(Graphics* graphics, bool solid);
 
     /// Lines rendered with depth test.
     PODVector<DebugLine> lines_;
@@ -193,6 +257,36 @@ private:
     Frustum frustum_;
     /// Vertex buffer.
     SharedPtr<VertexBuffer> vertexBuffer_;
+    /// Instanced primitives rendered with depth test, per shape.
+    PODVector<DebugInstance> instances_[MAX_DEBUG_SHAPES];
+    /// Instanced primitives rendered without depth test, per shape.
+    PODVector<DebugInstance> noDepthInstances_[MAX_DEBUG_SHAPES];
+    /// Unit mesh vertex buffer for instanced primitives.
+    SharedPtr<VertexBuffer> shapeVertexBuffer_;
+    /// Unit mesh index buffer for instanced primitives.
+    SharedPtr<IndexBuffer> shapeIndexBuffer_;
+    /// Index start per unit mesh.
+    unsigned shapeIndexStarts_[MAX_DEBUG_SHAPES]{};
+    /// Index count per unit mesh.
+    unsigned shapeIndexCounts_[MAX_DEBUG_SHAPES]{};
+    /// Per-instance transform buffer.
+    SharedPtr<VertexBuffer> instanceBuffer_;
+    /// Static debug geometry by key.
+    HashMap<StringHash, DebugStaticGeometry> staticGeometries_;
+    /// Key of the static debug geometry being recorded.
+    StringHash staticGeometryKey_;
+    /// Number of lines with depth test when static geometry recording began.
+    unsigned staticLinesStart_{};
+    /// Number of lines without depth test when static geometry recording began.
+    unsigned staticNoDepthLinesStart_{};
+    /// Number of triangles with depth test when static geometry recording began.
+    unsigned staticTrianglesStart_{};
+    /// Number of triangles without depth test when static geometry recording began.
+    unsigned staticNoDepthTrianglesStart_{};
+    /// Static geometry recording flag.
+    bool recordingStatic_{};
+    /// Primitive instancing support flag, updated when the view is set.
+    bool instancing_{};
     /// Line antialiasing flag.
     bool lineAntiAlias_;
 };
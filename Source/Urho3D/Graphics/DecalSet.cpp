@@ -24,6 +24,8 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Batch.h"
 #include "../Graphics/Camera.h"
@@ -36,6 +38,7 @@
 #include "../Graphics/VertexBuffer.h"
 #include "../IO/Log.h"
 #include "../IO/MemoryBuffer.h"
+#include "../Math/MathKernels.h"
 #include "../Resource/ResourceCache.h"
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
@@ -128,6 +131,12 @@ static void ClipPolygon(PODVector<DecalVertex>& dest, const PODVector<DecalVerte
         dest.Push(ClipEdge(src[last], src[0], lastDistance, distance, skinned));
 }
 
+void BuildDecalWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* job = reinterpret_cast<DecalJob*>(item->aux_);
+    job->decalSet_->BuildDecal(*job);
+}
+
 void Decal::AddVertex(const DecalVertex& vertex)
 {
     for (unsigned i = 0; i < vertices_.Size(); ++i)
@@ -175,7 +184,10 @@ DecalSet::DecalSet(Context* context) :
     batches_[0].geometryType_ = GEOM_STATIC_NOINSTANCING;
 }
 
-DecalSet::~DecalSet() = default;
+DecalSet::~DecalSet()
+{
+    CancelPendingDecals();
+}
 
 void DecalSet::RegisterObject(Context* context)
 {
@@ -304,181 +316,49 @@ bool DecalSet::AddDecal(Drawable* target, const Vector3& worldPosition, const Qu
 {
     URHO3D_PROFILE(AddDecal);
 
-    // Do not add decals in headless mode
-    if (!node_ || !GetSubsystem<Graphics>())
-        return false;
-
-    if (!target || !target->GetNode())
-    {
-        URHO3D_LOGERROR("Null target drawable for decal");
+    DecalJob job;
+    if (!PrepareDecal(job, target, worldPosition, worldRotation, size, aspectRatio, depth, topLeftUV, bottomRightUV, normalCutoff,
+        subGeometry))
         return false;
-    }
-
-    // Check for animated target and switch into skinned/static mode if necessary
-    auto* animatedModel = dynamic_cast<AnimatedModel*>(target);
-    if ((animatedModel && !skinned_) || (!animatedModel && skinned_))
-    {
-        RemoveAllDecals();
-        skinned_ = animatedModel != nullptr;
-        bufferDirty_ = true;
-    }
-
-    // Center the decal frustum on the world position
-    Vector3 adjustedWorldPosition = worldPosition - 0.5f * depth * (worldRotation * Vector3::FORWARD);
-    /// \todo target transform is not right if adding a decal to StaticModelGroup
-    Matrix3x4 targetTransform = target->GetNode()->GetWorldTransform().Inverse();
-
-    // For an animated model, adjust the decal position back to the bind pose
-    // To do this, need to find the bone the decal is colliding with
-    if (animatedModel)
-    {
-        Skeleton& skeleton = animatedModel->GetSkeleton();
-        unsigned numBones = skeleton.GetNumBones();
-        Bone* bestBone = nullptr;
-        float bestSize = 0.0f;
-
-        for (unsigned i = 0; i < numBones; ++i)
-        {
-            Bone* bone = skeleton.GetBone(i);
-            if (!bone->node_ || !bone->collisionMask_)
-                continue;
-
-            // Represent the decal as a sphere, try to find the biggest colliding bone
-            Sphere decalSphere
-                (bone->node_->GetWorldTransform().Inverse() * worldPosition, 0.5f * size / bone->node_->GetWorldScale().Length());
-
-            if (bone->collisionMask_ & BONECOLLISION_BOX)
-            {
-                float size = bone->boundingBox_.HalfSize().Length();
-                if (bone->boundingBox_.IsInside(decalSphere) && size > bestSize)
-                {
-                    bestBone = bone;
-                    bestSize = size;
-                }
-            }
-            else if (bone->collisionMask_ & BONECOLLISION_SPHERE)
-            {
-                Sphere boneSphere(Vector3::ZERO, bone->radius_);
-                float size = bone->radius_;
-                if (boneSphere.IsInside(decalSphere) && size > bestSize)
-                {
-                    bestBone = bone;
-                    bestSize = size;
-                }
-            }
-        }
-
-        if (bestBone)
-            targetTransform = (bestBone->node_->GetWorldTransform() * bestBone->offsetMatrix_).Inverse();
-    }
-
-    // Build the decal frustum
-    Frustum decalFrustum;
-    Matrix3x4 frustumTransform = targetTransform * Matrix3x4(adjustedWorldPosition, worldRotation, 1.0f);
-    decalFrustum.DefineOrtho(size, aspectRatio, 1.0, 0.0f, depth, frustumTransform);
-
-    Vector3 decalNormal = (targetTransform * Vector4(worldRotation * Vector3::BACK, 0.0f)).Normalized();
-
-    decals_.Resize(decals_.Size() + 1);
-    Decal& newDecal = decals_.Back();
-    newDecal.timeToLive_ = timeToLive;
-
-    Vector<PODVector<DecalVertex> > faces;
-    PODVector<DecalVertex> tempFace;
-
-    unsigned numBatches = target->GetBatches().Size();
 
-    // Use either a specified subgeometry in the target, or all
-    if (subGeometry < numBatches)
-        GetFaces(faces, target, subGeometry, decalFrustum, decalNormal, normalCutoff);
-    else
-    {
-        for (unsigned i = 0; i < numBatches; ++i)
-            GetFaces(faces, target, i, decalFrustum, decalNormal, normalCutoff);
-    }
-
-    // Clip the acquired faces against all frustum planes
-    for (const auto& plane : decalFrustum.planes_)
-    {
-        for (unsigned j = 0; j < faces.Size(); ++j)
-        {
-            PODVector<DecalVertex>& face = faces[j];
-            if (face.Empty())
-                continue;
-
-            ClipPolygon(tempFace, face, plane, skinned_);
-            face = tempFace;
-        }
-    }
+    job.decal_.timeToLive_ = timeToLive;
+    BuildDecal(job);
+    return FinishDecal(job);
+}
 
-    // Now triangulate the resulting faces into decal vertices
-    for (unsigned i = 0; i < faces.Size(); ++i)
+bool DecalSet::AddDecalAsync(Drawable* target, const Vector3& worldPosition, const Quaternion& worldRotation, float size,
+    float aspectRatio, float depth, const Vector2& topLeftUV, const Vector2& bottomRightUV, float timeToLive, float normalCutoff,
+    unsigned subGeometry)
+{
+    // Skinned decals remap the target's bones while collecting the faces, so they can not be built in a worker thread
+    auto* queue = GetSubsystem<WorkQueue>();
+    if (!queue || !queue->GetNumThreads() || dynamic_cast<AnimatedModel*>(target))
     {
-        PODVector<DecalVertex>& face = faces[i];
-        if (face.Size() < 3)
-            continue;
-
-        for (unsigned j = 2; j < face.Size(); ++j)
-        {
-            newDecal.AddVertex(face[0]);
-            newDecal.AddVertex(face[j - 1]);
-            newDecal.AddVertex(face[j]);
-        }
+        return AddDecal(target, worldPosition, worldRotation, size, aspectRatio, depth, topLeftUV, bottomRightUV, timeToLive,
+            normalCutoff, subGeometry);
     }
 
-    // Check if resulted in no triangles
-    if (newDecal.vertices_.Empty())
-    {
-        decals_.Pop();
-        return true;
-    }
+    URHO3D_PROFILE(AddDecalAsync);
 
-    if (newDecal.vertices_.Size() > maxVertices_)
-    {
-        URHO3D_LOGWARNING("Can not add decal, vertex count " + String(newDecal.vertices_.Size()) + " exceeds maximum " +
-                   String(maxVertices_));
-        decals_.Pop();
+    DecalJob newJob;
+    if (!PrepareDecal(newJob, target, worldPosition, worldRotation, size, aspectRatio, depth, topLeftUV, bottomRightUV,
+        normalCutoff, subGeometry))
         return false;
-    }
-    if (newDecal.indices_.Size() > maxIndices_)
-    {
-        URHO3D_LOGWARNING("Can not add decal, index count " + String(newDecal.indices_.Size()) + " exceeds maximum " +
-                   String(maxIndices_));
-        decals_.Pop();
-        return false;
-    }
 
-    // Calculate UVs
-    Matrix4 projection(Matrix4::ZERO);
-    projection.m11_ = (1.0f / (size * 0.5f));
-    projection.m00_ = projection.m11_ / aspectRatio;
-    projection.m22_ = 1.0f / depth;
-    projection.m33_ = 1.0f;
+    newJob.decal_.timeToLive_ = timeToLive;
+    newJob.target_ = nullptr;
+    pendingDecals_.Push(newJob);
+    DecalJob& job = pendingDecals_.Back();
 
-    CalculateUVs(newDecal, frustumTransform.Inverse(), projection, topLeftUV, bottomRightUV);
+    // Not a pooled item, as the work queue would reset and reuse it while still being polled here
+    job.workItem_ = new WorkItem();
+    job.workItem_->priority_ = 0;
+    job.workItem_->workFunction_ = BuildDecalWork;
+    job.workItem_->aux_ = &job;
+    queue->AddWorkItem(job.workItem_);
 
-    // Transform vertices to this node's local space and generate tangents
-    Matrix3x4 decalTransform = node_->GetWorldTransform().Inverse() * target->GetNode()->GetWorldTransform();
-    TransformVertices(newDecal, skinned_ ? Matrix3x4::IDENTITY : decalTransform);
-    GenerateTangents(&newDecal.vertices_[0], sizeof(DecalVertex), &newDecal.indices_[0], sizeof(unsigned short), 0,
-        newDecal.indices_.Size(), offsetof(DecalVertex, normal_), offsetof(DecalVertex, texCoord_), offsetof(DecalVertex,
-        tangent_));
-
-    newDecal.CalculateBoundingBox();
-    numVertices_ += newDecal.vertices_.Size();
-    numIndices_ += newDecal.indices_.Size();
-
-    // Remove oldest decals if total vertices exceeded
-    while (decals_.Size() && (numVertices_ > maxVertices_ || numIndices_ > maxIndices_))
-        RemoveDecals(1);
-
-    URHO3D_LOGDEBUG("Added decal with " + String(newDecal.vertices_.Size()) + " vertices");
-
-    // If new decal is time limited, subscribe to scene post-update
-    if (newDecal.timeToLive_ > 0.0f && !subscribed_)
-        UpdateEventSubscription(false);
-
-    MarkDecalsDirty();
+    // The finished decals are added on scene post-update
+    UpdateEventSubscription(false);
     return true;
 }
 
@@ -490,6 +370,8 @@ void DecalSet::RemoveDecals(unsigned num)
 
 void DecalSet::RemoveAllDecals()
 {
+    CancelPendingDecals();
+
     if (!decals_.Empty())
     {
         decals_.Clear();
@@ -694,14 +576,252 @@ void DecalSet::OnWorldBoundingBoxUpdate()
     }
 }
 
-void DecalSet::GetFaces(Vector<PODVector<DecalVertex> >& faces, Drawable* target, unsigned batchIndex, const Frustum& frustum,
-    const Vector3& decalNormal, float normalCutoff)
+bool DecalSet::PrepareDecal(DecalJob& job, Drawable* target, const Vector3& worldPosition, const Quaternion& worldRotation,
+    float size, float aspectRatio, float depth, const Vector2& topLeftUV, const Vector2& bottomRightUV, float normalCutoff,
+    unsigned subGeometry)
+{
+    // Do not add decals in headless mode
+    if (!node_ || !GetSubsystem<Graphics>())
+        return false;
+
+    if (!target || !target->GetNode())
+    {
+        URHO3D_LOGERROR("Null target drawable for decal");
+        return false;
+    }
+
+    // Check for animated target and switch into skinned/static mode if necessary
+    auto* animatedModel = dynamic_cast<AnimatedModel*>(target);
+    if ((animatedModel && !skinned_) || (!animatedModel && skinned_))
+    {
+        RemoveAllDecals();
+        skinned_ = animatedModel != nullptr;
+        bufferDirty_ = true;
+    }
+
+    // The faces are read from the shadow data of the target's model
+    auto* staticModel = dynamic_cast<StaticModel*>(target);
+    if (staticModel && staticModel->GetModel())
+        staticModel->GetModel()->RequestShadowData();
+
+    // Center the decal frustum on the world position
+    Vector3 adjustedWorldPosition = worldPosition - 0.5f * depth * (worldRotation * Vector3::FORWARD);
+    /// \todo target transform is not right if adding a decal to StaticModelGroup
+    Matrix3x4 targetTransform = target->GetNode()->GetWorldTransform().Inverse();
+
+    // For an animated model, adjust the decal position back to the bind pose
+    // To do this, need to find the bone the decal is colliding with
+    if (animatedModel)
+    {
+        Skeleton& skeleton = animatedModel->GetSkeleton();
+        unsigned numBones = skeleton.GetNumBones();
+        Bone* bestBone = nullptr;
+        float bestSize = 0.0f;
+
+        for (unsigned i = 0; i < numBones; ++i)
+        {
+            Bone* bone = skeleton.GetBone(i);
+            if (!bone->node_ || !bone->collisionMask_)
+                continue;
+
+            // Represent the decal as a sphere, try to find the biggest colliding bone
+            Sphere decalSphere
+                (bone->node_->GetWorldTransform().Inverse() * worldPosition, 0.5f * size / bone->node_->GetWorldScale().Length());
+
+            if (bone->collisionMask_ & BONECOLLISION_BOX)
+            {
+                float size = bone->boundingBox_.HalfSize().Length();
+                if (bone->boundingBox_.IsInside(decalSphere) && size > bestSize)
+                {
+                    bestBone = bone;
+                    bestSize = size;
+                }
+            }
+            else if (bone->collisionMask_ & BONECOLLISION_SPHERE)
+            {
+                Sphere boneSphere(Vector3::ZERO, bone->radius_);
+                float size = bone->radius_;
+                if (boneSphere.IsInside(decalSphere) && size > bestSize)
+                {
+                    bestBone = bone;
+                    bestSize = size;
+                }
+            }
+        }
+
+        if (bestBone)
+            targetTransform = (bestBone->node_->GetWorldTransform() * bestBone->offsetMatrix_).Inverse();
+    }
+
+    // Build the decal frustum
+    Matrix3x4 frustumTransform = targetTransform * Matrix3x4(adjustedWorldPosition, worldRotation, 1.0f);
+    job.frustum_.DefineOrtho(size, aspectRatio, 1.0, 0.0f, depth, frustumTransform);
+    job.decalNormal_ = (targetTransform * Vector4(worldRotation * Vector3::BACK, 0.0f)).Normalized();
+    job.normalCutoff_ = normalCutoff;
+
+    // Use either a specified subgeometry in the target, or all. Try to use the most accurate LOD level if possible
+    unsigned numBatches = target->GetBatches().Size();
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        if (subGeometry < numBatches && i != subGeometry)
+            continue;
+
+        Geometry* geometry = target->GetLodGeometry(i, 0);
+        if (geometry && geometry->GetPrimitiveType() == TRIANGLE_LIST)
+        {
+            job.geometries_.Push(SharedPtr<Geometry>(geometry));
+            job.batchIndices_.Push(i);
+        }
+    }
+
+    // Calculate UVs in the decal frustum space
+    job.view_ = frustumTransform.Inverse();
+    job.projection_ = Matrix4::ZERO;
+    job.projection_.m11_ = (1.0f / (size * 0.5f));
+    job.projection_.m00_ = job.projection_.m11_ / aspectRatio;
+    job.projection_.m22_ = 1.0f / depth;
+    job.projection_.m33_ = 1.0f;
+    job.topLeftUV_ = topLeftUV;
+    job.bottomRightUV_ = bottomRightUV;
+
+    // Transform vertices to this node's local space
+    job.vertexTransform_ = skinned_ ? Matrix3x4::IDENTITY : node_->GetWorldTransform().Inverse() *
+        target->GetNode()->GetWorldTransform();
+    job.decalSet_ = this;
+    job.target_ = target;
+    return true;
+}
+
+void DecalSet::BuildDecal(DecalJob& job)
 {
-    // Try to use the most accurate LOD level if possible
-    Geometry* geometry = target->GetLodGeometry(batchIndex, 0);
-    if (!geometry || geometry->GetPrimitiveType() != TRIANGLE_LIST)
+    Decal& newDecal = job.decal_;
+    Vector<PODVector<DecalVertex> > faces;
+    PODVector<DecalVertex> tempFace;
+
+    for (unsigned i = 0; i < job.geometries_.Size(); ++i)
+    {
+        GetFaces(faces, job.target_, job.geometries_[i], job.batchIndices_[i], job.frustum_, job.decalNormal_,
+            job.normalCutoff_);
+    }
+
+    // Clip the acquired faces against all frustum planes
+    for (const auto& plane : job.frustum_.planes_)
+    {
+        for (unsigned j = 0; j < faces.Size(); ++j)
+        {
+            PODVector<DecalVertex>& face = faces[j];
+            if (face.Empty())
+                continue;
+
+            ClipPolygon(tempFace, face, plane, skinned_);
+            face = tempFace;
+        }
+    }
+
+    // Now triangulate the resulting faces into decal vertices
+    for (unsigned i = 0; i < faces.Size(); ++i)
+    {
+        PODVector<DecalVertex>& face = faces[i];
+        if (face.Size() < 3)
+            continue;
+
+        for (unsigned j = 2; j < face.Size(); ++j)
+        {
+            newDecal.AddVertex(face[0]);
+            newDecal.AddVertex(face[j - 1]);
+            newDecal.AddVertex(face[j]);
+        }
+    }
+
+    // Check if resulted in no triangles, or too many to ever fit the decal set
+    if (newDecal.vertices_.Empty() || newDecal.vertices_.Size() > MAX_VERTICES)
         return;
 
+    CalculateUVs(newDecal, job.view_, job.projection_, job.topLeftUV_, job.bottomRightUV_);
+
+    // Transform vertices to this node's local space and generate tangents
+    TransformVertices(newDecal, job.vertexTransform_);
+    GenerateTangents(&newDecal.vertices_[0], sizeof(DecalVertex), &newDecal.indices_[0], sizeof(unsigned short), 0,
+        newDecal.indices_.Size(), offsetof(DecalVertex, normal_), offsetof(DecalVertex, texCoord_), offsetof(DecalVertex,
+        tangent_));
+
+    newDecal.CalculateBoundingBox();
+}
+
+bool DecalSet::FinishDecal(DecalJob& job)
+{
+    Decal& newDecal = job.decal_;
+
+    // Check if resulted in no triangles
+    if (newDecal.vertices_.Empty())
+        return true;
+
+    if (newDecal.vertices_.Size() > maxVertices_)
+    {
+        URHO3D_LOGWARNING("Can not add decal, vertex count " + String(newDecal.vertices_.Size()) + " exceeds maximum " +
+                   String(maxVertices_));
+        return false;
+    }
+    if (newDecal.indices_.Size() > maxIndices_)
+    {
+        URHO3D_LOGWARNING("Can not add decal, index count " + String(newDecal.indices_.Size()) + " exceeds maximum " +
+                   String(maxIndices_));
+        return false;
+    }
+
+    decals_.Push(newDecal);
+    numVertices_ += newDecal.vertices_.Size();
+    numIndices_ += newDecal.indices_.Size();
+
+    // Remove oldest decals if total vertices exceeded
+    while (decals_.Size() && (numVertices_ > maxVertices_ || numIndices_ > maxIndices_))
+        RemoveDecals(1);
+
+    URHO3D_LOGDEBUG("Added decal with " + String(newDecal.vertices_.Size()) + " vertices");
+
+    // If new decal is time limited, subscribe to scene post-update
+    if (newDecal.timeToLive_ > 0.0f && !subscribed_)
+        UpdateEventSubscription(false);
+
+    MarkDecalsDirty();
+    return true;
+}
+
+void DecalSet::FinishPendingDecals()
+{
+    for (List<DecalJob>::Iterator i = pendingDecals_.Begin(); i != pendingDecals_.End();)
+    {
+        if (!i->workItem_->completed_)
+        {
+            ++i;
+            continue;
+        }
+
+        FinishDecal(*i);
+        i = pendingDecals_.Erase(i);
+    }
+}
+
+void DecalSet::CancelPendingDecals()
+{
+    auto* queue = GetSubsystem<WorkQueue>();
+
+    // The job can only be freed once the worker thread no longer uses it
+    for (List<DecalJob>::Iterator i = pendingDecals_.Begin(); i != pendingDecals_.End(); ++i)
+    {
+        if (!i->workItem_->completed_ && !(queue && queue->RemoveWorkItem(i->workItem_)))
+        {
+            while (queue && !i->workItem_->completed_)
+                Time::Sleep(0);
+        }
+    }
+
+    pendingDecals_.Clear();
+}
+
+void DecalSet::GetFaces(Vector<PODVector<DecalVertex> >& faces, Drawable* target, Geometry* geometry, unsigned batchIndex,
+    const Frustum& frustum, const Vector3& decalNormal, float normalCutoff)
+{
     const unsigned char* positionData = nullptr;
     const unsigned char* normalData = nullptr;
     const unsigned char* skinningData = nullptr;
@@ -974,11 +1094,16 @@ void DecalSet::CalculateUVs(Decal& decal, const Matrix3x4& view, const Matrix4&
 
 void DecalSet::TransformVertices(Decal& decal, const Matrix3x4& transform)
 {
-    for (PODVector<DecalVertex>::Iterator i = decal.vertices_.Begin(); i != decal.vertices_.End(); ++i)
-    {
-        i->position_ = transform * i->position_;
-        i->normal_ = (transform * Vector4(i->normal_, 0.0f)).Normalized();
-    }
+    if (decal.vertices_.Empty())
+        return;
+
+    DecalVertex* vertices = &decal.vertices_[0];
+    const unsigned numVertices = decal.vertices_.Size();
+    TransformPoints(transform, &vertices->position_, &vertices->position_, numVertices, sizeof(DecalVertex), sizeof(DecalVertex));
+    TransformDirections(transform, &vertices->normal_, &vertices->normal_, numVertices, sizeof(DecalVertex), sizeof(DecalVertex));
+
+    for (unsigned i = 0; i < numVertices; ++i)
+        vertices[i].normal_.Normalize();
 }
 
 List<Decal>::Iterator DecalSet::RemoveDecal(List<Decal>::Iterator i)
@@ -1074,13 +1199,20 @@ void DecalSet::UpdateSkinning()
     // Use model's world transform in case a bone is missing
     const Matrix3x4& worldTransform = node_->GetWorldTransform();
 
-    for (unsigned i = 0; i < bones_.Size(); ++i)
+    const unsigned numBones = bones_.Size();
+    if (numBones)
     {
-        const Bone& bone = bones_[i];
-        if (bone.node_)
-            skinMatrices_[i] = bone.node_->GetWorldTransform() * bone.offsetMatrix_;
-        else
-            skinMatrices_[i] = worldTransform;
+        for (unsigned i = 0; i < numBones; ++i)
+            skinMatrices_[i] = bones_[i].node_ ? bones_[i].node_->GetWorldTransform() : Matrix3x4::IDENTITY;
+
+        MultiplyMatrices(&skinMatrices_[0], &bones_[0].offsetMatrix_, &skinMatrices_[0], numBones, sizeof(Matrix3x4),
+            sizeof(Bone));
+
+        for (unsigned i = 0; i < numBones; ++i)
+        {
+            if (!bones_[i].node_)
+                skinMatrices_[i] = worldTransform;
+        }
     }
 
     skinningDirty_ = false;
@@ -1140,8 +1272,8 @@ void DecalSet::UpdateEventSubscription(bool checkAllDecals)
             }
         }
 
-        // If no time limited decals, no need to subscribe to scene update
-        enabled = hasTimeLimitedDecals;
+        // If no time limited or pending decals, no need to subscribe to scene update
+        enabled = hasTimeLimitedDecals || !pendingDecals_.Empty();
     }
 
     if (enabled && !subscribed_)
@@ -1162,6 +1294,13 @@ void DecalSet::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData
 
     float timeStep = eventData[P_TIMESTEP].GetFloat();
 
+    if (!pendingDecals_.Empty())
+    {
+        FinishPendingDecals();
+        if (pendingDecals_.Empty())
+            UpdateEventSubscription(true);
+    }
+
     for (List<Decal>::Iterator i = decals_.Begin(); i != decals_.End();)
     {
         i->timer_ += timeStep;
@@ -30,8 +30,10 @@
 namespace Urho3D
 {
 
+class Geometry;
 class IndexBuffer;
 class VertexBuffer;
+struct WorkItem;
 
 /// %Decal vertex.
 struct DecalVertex
@@ -99,11 +101,49 @@ struct Decal
     PODVector<unsigned short> indices_;
 };
 
+class DecalSet;
+
+/// %Decal being clipped from target geometry, possibly in a worker thread.
+/// @nobind
+struct DecalJob
+{
+    /// Decal set the decal is added to.
+    DecalSet* decalSet_{};
+    /// Target drawable. Only used when building on the main thread, as skinned decals need its bones.
+    Drawable* target_{};
+    /// Target geometries to collect faces from.
+    Vector<SharedPtr<Geometry> > geometries_;
+    /// Target batch indices of the geometries.
+    PODVector<unsigned> batchIndices_;
+    /// Decal frustum in target space.
+    Frustum frustum_;
+    /// Decal normal in target space.
+    Vector3 decalNormal_;
+    /// Normal cutoff for faces.
+    float normalCutoff_{};
+    /// Inverse of the decal frustum transform for UV calculation.
+    Matrix3x4 view_;
+    /// Decal projection for UV calculation.
+    Matrix4 projection_;
+    /// Top left UV coordinate.
+    Vector2 topLeftUV_;
+    /// Bottom right UV coordinate.
+    Vector2 bottomRightUV_;
+    /// Transform from target space to the decal set's local space.
+    Matrix3x4 vertexTransform_;
+    /// Resulting decal.
+    Decal decal_;
+    /// Work item when building in a worker thread.
+    SharedPtr<WorkItem> workItem_;
+};
+
 /// %Decal renderer component.
 class URHO3D_API DecalSet : public Drawable
 {
     URHO3D_OBJECT(DecalSet, Drawable);
 
+    friend void BuildDecalWork(const WorkItem* item, unsigned threadIndex);
+
 public:
     /// Construct.
     explicit DecalSet(Context* context);
@@ -142,9 +182,13 @@ public:
     bool AddDecal(Drawable* target, const Vector3& worldPosition, const Quaternion& worldRotation, float size, float aspectRatio,
         float depth, const Vector2& topLeftUV, const Vector2& bottomRightUV, float timeToLive = 0.0f, float normalCutoff = 0.1f,
         unsigned subGeometry = M_MAX_UNSIGNED);
+    /// Add a decal like AddDecal(), but clip it against the target geometry in a worker thread. The decal appears once clipping has finished, at the latest on the next scene update after that. Decals on animated models and decals without worker threads are added immediately. Return true if successfully queued or added.
+    bool AddDecalAsync(Drawable* target, const Vector3& worldPosition, const Quaternion& worldRotation, float size, float aspectRatio,
+        float depth, const Vector2& topLeftUV, const Vector2& bottomRightUV, float timeToLive = 0.0f, float normalCutoff = 0.1f,
+        unsigned subGeometry = M_MAX_UNSIGNED);
     /// Remove n oldest decals.
     void RemoveDecals(unsigned num);
-    /// Remove all decals.
+    /// Remove all decals, including ones still being clipped in a worker thread.
     void RemoveAllDecals();
 
     /// Return material.
@@ -155,6 +199,10 @@ public:
     /// @property
     unsigned GetNumDecals() const { return decals_.Size(); }
 
+    /// Return number of decals still being clipped in a worker thread.
+    /// @property
+    unsigned GetNumPendingDecals() const { return pendingDecals_.Size(); }
+
     /// Retur number of vertices in the decals.
     /// @property
     unsigned GetNumVertices() const { return numVertices_; }
@@ -191,9 +239,21 @@ protected:
     void OnMarkedDirty(Node* node) override;
 
 private:
-    /// Get triangle faces from the target geometry.
-    void GetFaces(Vector<PODVector<DecalVertex> >& faces, Drawable* target, unsigned batchIndex, const Frustum& frustum,
-        const Vector3& decalNormal, float normalCutoff);
+    /// Set up the decal frustum and target geometries for building a decal. Return true if successful.
+    bool PrepareDecal(DecalJob& job, Drawable* target, const Vector3& worldPosition, const Quaternion& worldRotation, float size,
+        float aspectRatio, float depth, const Vector2& topLeftUV, const Vector2& bottomRightUV, float normalCutoff,
+        unsigned subGeometry);
+    /// Clip and triangulate the decal and calculate its vertex attributes. May be called from a worker thread.
+    void BuildDecal(DecalJob& job);
+    /// Add a built decal to the decal set. Return true if successful.
+    bool FinishDecal(DecalJob& job);
+    /// Add the decals that have finished clipping in a worker thread.
+    void FinishPendingDecals();
+    /// Cancel the decals being clipped in a worker thread, waiting for the ones already started.
+    void CancelPendingDecals();
+    /// Get triangle faces from the target geometry. Target is needed only for skinned decals.
+    void GetFaces(Vector<PODVector<DecalVertex> >& faces, Drawable* target, Geometry* geometry, unsigned batchIndex,
+        const Frustum& frustum, const Vector3& decalNormal, float normalCutoff);
     /// Get triangle face from the target geometry.
     void GetFace
         (Vector<PODVector<DecalVertex> >& faces, Drawable* target, unsigned batchIndex, unsigned i0, unsigned i1, unsigned i2,
@@ -235,6 +295,8 @@ private:
     SharedPtr<IndexBuffer> indexBuffer_;
     /// Decals.
     List<Decal> decals_;
+    /// Decals being clipped in a worker thread.
+    List<DecalJob> pendingDecals_;
     /// Bones used for skinned decals.
     Vector<Bone> bones_;
     /// Skinning matrices.
@@ -63,46 +63,34 @@ bool ConstantBuffer::SetSize(unsigned size)
 
     size_ = size;
     dirty_ = false;
+    ringEpoch_ = 0;
     shadowData_ = new unsigned char[size_];
     memset(shadowData_.Get(), 0, size_);
 
-    if (graphics_)
-    {
-        BufferDesc bufferDesc;
-        bufferDesc.Size = size_;
-        bufferDesc.Usage = USAGE_DYNAMIC;
-        bufferDesc.BindFlags = BIND_UNIFORM_BUFFER;
-        bufferDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
-
-        graphics_->GetImpl()->GetDevice()->CreateBuffer(bufferDesc, nullptr, (IBuffer**)&object_.ptr_);
-        if (object_.ptr_ == nullptr)
-        {
-            URHO3D_SAFE_RELEASE(object_.ptr_);
-            URHO3D_LOGERROR("Failed to create constant buffer");
-            return false;
-        }
-    }
-
+    // The data is sub-allocated from the constant ring buffer on apply, so no GPU-side buffer of its own is created
     return true;
 }
 
 void ConstantBuffer::Apply()
 {
-    if (dirty_ && object_.ptr_)
-    {
-        auto& context = graphics_->GetImpl()->GetDeviceContext();
-        auto* buffer = (IBuffer*)object_.ptr_;
-        unsigned char* mappedData;
-
-        context->MapBuffer(buffer, MAP_WRITE, MAP_FLAG_DISCARD, (PVoid&)mappedData);
-        if (mappedData != nullptr)
-        {
-            memcpy(mappedData, shadowData_.Get(), size_);
-            context->UnmapBuffer(buffer, MAP_WRITE);
-        }
+    GraphicsImpl* impl = graphics_->GetImpl();
 
+    // Data written to the ring buffer before it was last discarded is no longer available to the GPU
+    if (dirty_ || ringEpoch_ != impl->GetConstantRingEpoch())
+    {
+        ringOffset_ = impl->WriteConstantData(shadowData_.Get(), size_);
+        ringEpoch_ = impl->GetConstantRingEpoch();
         dirty_ = false;
     }
 }
 
+void ConstantBuffer::SetRingData(const void* data, unsigned ringOffset, unsigned ringEpoch)
+{
+    // Keep the shadow data in sync in case further parameters are set, or the ring buffer is discarded before drawing
+    memcpy(shadowData_.Get(), data, size_);
+    ringOffset_ = ringOffset;
+    ringEpoch_ = ringEpoch;
+    dirty_ = false;
+}
+
 }
@@ -27,12 +27,17 @@
 #include "../../Core/Context.h"
 #include "../../Core/ProcessUtils.h"
 #include "../../Core/Profiler.h"
+#include "../../Core/Timer.h"
+#include "../../Core/WorkQueue.h"
 #include "../../Graphics/ConstantBuffer.h"
 #include "../../Graphics/Geometry.h"
+#include "../../Graphics/GPUParticleEmitter.h"
 #include "../../Graphics/Graphics.h"
+#include "../../Graphics/GraphicsCapture.h"
 #include "../../Graphics/GraphicsEvents.h"
 #include "../../Graphics/GraphicsImpl.h"
 #include "../../Graphics/IndexBuffer.h"
+#include "../../Graphics/ParticleEffect.h"
 #include "../../Graphics/Renderer.h"
 #include "../../Graphics/Shader.h"
 #include "../../Graphics/ShaderPrecache.h"
@@ -41,12 +46,19 @@
 #include "../../Graphics/TextureCube.h"
 #include "../../Graphics/VertexBuffer.h"
 #include "../../IO/File.h"
+#include "../../IO/FileSystem.h"
 #include "../../IO/Log.h"
+#include "../../Resource/Image.h"
 #include "../../Resource/ResourceCache.h"
 
 #include <SDL/SDL.h>
 #include <SDL/SDL_syswm.h>
 
+#if ARCHIVER_SUPPORTED
+#include <Graphics/Archiver/interface/ArchiverFactory.h>
+#include <Graphics/Archiver/interface/ArchiverFactoryLoader.h>
+#endif
+
 #include "../../DebugNew.h"
 
 #ifdef _MSC_VER
@@ -160,7 +172,10 @@ static const VALUE_TYPE diligentValueType[] =
     VT_FLOAT32,
     VT_FLOAT32,
     VT_UINT8,
-    VT_UINT8
+    VT_UINT8,
+    VT_INT16,
+    VT_INT16,
+    VT_FLOAT16
 };
 
 static const Uint32 diligentNumComponents[] = {
@@ -170,7 +185,10 @@ static const Uint32 diligentNumComponents[] = {
     3,
     4,
     4,
-    4
+    4,
+    2,
+    4,
+    2
 };
 
 static const bool diligentIsNormalized[] = {
@@ -180,7 +198,10 @@ static const bool diligentIsNormalized[] = {
     false,
     false,
     false,
-    true
+    true,
+    true,
+    true,
+    false
 };
 
 static const VALUE_TYPE diligentIndexType[] = {
@@ -229,6 +250,200 @@ static HWND GetWindowHandle(SDL_Window* window)
     return sysInfo.info.win.window;
 }
 
+/// Pipeline state cache file format version. Increment when the layout changes.
+static const unsigned PIPELINE_STATE_CACHE_VERSION = 3;
+
+static const char* GetDeviceTypeName(RENDER_DEVICE_TYPE deviceType)
+{
+    switch (deviceType)
+    {
+    case RENDER_DEVICE_TYPE_D3D11:
+        return "d3d11";
+    case RENDER_DEVICE_TYPE_D3D12:
+        return "d3d12";
+    case RENDER_DEVICE_TYPE_GL:
+        return "gl";
+    case RENDER_DEVICE_TYPE_GLES:
+        return "gles";
+    case RENDER_DEVICE_TYPE_VULKAN:
+        return "vulkan";
+    case RENDER_DEVICE_TYPE_METAL:
+        return "metal";
+    default:
+        return "unknown";
+    }
+}
+
+/// Return pipeline state cache file name within the shader cache directory.
+static String GetPipelineStateCacheFileName(const String& shaderCacheDir, RENDER_DEVICE_TYPE deviceType)
+{
+    return shaderCacheDir + "PipelineStateCache_Diligent" + GetDeviceTypeName(deviceType) + ".bin";
+}
+
+/// Return precompiled shader archive file name for a device type.
+static String GetShaderArchiveFileName(const String& fileName, RENDER_DEVICE_TYPE deviceType)
+{
+    String path, file, extension;
+    SplitPath(fileName, path, file, extension, false);
+    return path + file + "_" + GetDeviceTypeName(deviceType) + extension;
+}
+
+/// Return a hash identifying the adapter and driver interface that pipeline state cache data is only valid for.
+static unsigned GetAdapterHash(IRenderDevice* device)
+{
+    const GraphicsAdapterInfo& adapterInfo = device->GetAdapterInfo();
+    const RenderDeviceInfo& deviceInfo = device->GetDeviceInfo();
+
+    unsigned hash = StringHash(adapterInfo.Description).Value();
+    hash = hash * 31 + adapterInfo.VendorId;
+    hash = hash * 31 + adapterInfo.DeviceId;
+    hash = hash * 31 + deviceInfo.APIVersion.Major;
+    hash = hash * 31 + deviceInfo.APIVersion.Minor;
+    hash = hash * 31 + DILIGENT_API_VERSION;
+    return hash;
+}
+
+/// Return key of a shader variation in the pipeline state cache shader table.
+static StringHash GetPipelineStateCacheShaderKey(ShaderVariation* variation)
+{
+    return StringHash((variation->GetShaderType() == VS ? "VS:" : "PS:") + variation->GetFullName());
+}
+
+/// Return hash of the compiled bytecode of a shader variation.
+static unsigned GetShaderByteCodeHash(ShaderVariation* variation)
+{
+    IShader* shader = (IShader*)variation->GetGPUObject();
+    if (!shader)
+        return 0;
+
+    const void* byteCode = nullptr;
+    Uint64 byteCodeSize = 0;
+    shader->GetBytecode(&byteCode, byteCodeSize);
+
+    unsigned hash = 0;
+    const unsigned char* data = (const unsigned char*)byteCode;
+    for (Uint64 i = 0; i < byteCodeSize; ++i)
+        hash = SDBMHash(hash, data[i]);
+    return hash;
+}
+
+/// Work function for creating a pipeline state on a worker thread.
+static void CreatePipelineStateWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* data = reinterpret_cast<PipelineStateCreateData*>(item->aux_);
+    HiresTimer timer;
+    data->device_->CreateGraphicsPipelineState(data->createInfo_, &data->pipelineState_);
+    data->creationTime_ = timer.GetUSec(false);
+}
+
+#if ARCHIVER_SUPPORTED
+/// Shader variation to compile for a precompiled shader archive.
+struct ShaderArchiveJob
+{
+    /// Shader variation.
+    ShaderVariation* variation_;
+    /// Device type to compile for.
+    RENDER_DEVICE_TYPE deviceType_;
+    /// Serialization device.
+    ISerializationDevice* device_;
+    /// Serialized shader. Null if compiling failed.
+    RefCntAutoPtr<IShader> shader_;
+};
+
+/// Work function for compiling a shader variation for a precompiled shader archive on a worker thread.
+static void ArchiveShaderWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* job = reinterpret_cast<ShaderArchiveJob*>(item->aux_);
+    const String name = GetShaderArchiveName(job->variation_);
+    ShaderMacroHelper macros;
+    ShaderCreateInfo createInfo;
+    FillShaderCreateInfo(job->variation_, job->deviceType_, name, macros, createInfo);
+
+    ShaderArchiveInfo archiveInfo;
+    archiveInfo.DeviceFlags = static_cast<ARCHIVE_DEVICE_DATA_FLAGS>(1u << job->deviceType_);
+    job->device_->CreateShader(createInfo, archiveInfo, &job->shader_);
+}
+#endif
+
+/// Read the HLSL source of a compute shader. Return empty if not found.
+static String ReadComputeShaderSource(ResourceCache* cache, const String& fileName)
+{
+    String source;
+    SharedPtr<File> file = cache->GetFile(fileName);
+    if (file)
+    {
+        source.Resize(file->GetSize());
+        if (source.Length())
+            file->Read(&source[0], source.Length());
+    }
+    return source;
+}
+
+/// Select the adapter to create the device on and describe an async compute context on its compute-only queue after the graphics context. Return the number of immediate contexts to create, which is 1 without a compute-only queue.
+static unsigned SetImmediateContexts(IEngineFactory* factory, EngineCreateInfo& engineCI, ImmediateContextCreateInfo* contextInfos)
+{
+    Uint32 numAdapters = 0;
+    factory->EnumerateAdapters(engineCI.GraphicsAPIVersion, numAdapters, nullptr);
+    if (!numAdapters)
+        return 1;
+    Vector<GraphicsAdapterInfo> adapters(numAdapters);
+    factory->EnumerateAdapters(engineCI.GraphicsAPIVersion, numAdapters, &adapters[0]);
+
+    // Prefer a discrete adapter like the engine does when no adapter is specified
+    unsigned adapterId = 0;
+    for (unsigned i = 0; i < numAdapters; ++i)
+    {
+        if (adapters[i].Type == ADAPTER_TYPE_DISCRETE)
+        {
+            adapterId = i;
+            break;
+        }
+    }
+
+    const GraphicsAdapterInfo& adapter = adapters[adapterId];
+    unsigned graphicsQueue = M_MAX_UNSIGNED;
+    unsigned computeQueue = M_MAX_UNSIGNED;
+    for (unsigned i = 0; i < adapter.NumQueues; ++i)
+    {
+        const COMMAND_QUEUE_TYPE queueType = adapter.Queues[i].QueueType & COMMAND_QUEUE_TYPE_PRIMARY_MASK;
+        if (queueType == COMMAND_QUEUE_TYPE_GRAPHICS && graphicsQueue == M_MAX_UNSIGNED)
+            graphicsQueue = i;
+        else if (queueType == COMMAND_QUEUE_TYPE_COMPUTE && computeQueue == M_MAX_UNSIGNED)
+            computeQueue = i;
+    }
+    if (graphicsQueue == M_MAX_UNSIGNED || computeQueue == M_MAX_UNSIGNED)
+        return 1;
+
+    contextInfos[0] = ImmediateContextCreateInfo("Graphics", (Uint8)graphicsQueue);
+    contextInfos[1] = ImmediateContextCreateInfo("Async compute", (Uint8)computeQueue);
+    engineCI.AdapterId = adapterId;
+    engineCI.pImmediateContextInfo = contextInfos;
+    engineCI.NumImmediateContexts = 2;
+    return 2;
+}
+
+/// Read a backbuffer staging texture into an RGB image.
+static bool ReadScreenShot(GraphicsImpl* impl, ITexture* stagingTexture, Image& destImage)
+{
+    const TextureDesc& textureDesc = stagingTexture->GetDesc();
+    PODVector<unsigned char> rgbaData(textureDesc.Width * textureDesc.Height * 4);
+    if (!impl->ReadStagingTexture(stagingTexture, rgbaData.Buffer(), textureDesc.Width * 4, textureDesc.Height))
+        return false;
+
+    destImage.SetSize(textureDesc.Width, textureDesc.Height, 3);
+    unsigned char* destData = destImage.GetData();
+    const unsigned char* src = rgbaData.Buffer();
+    for (unsigned i = 0; i < textureDesc.Width * textureDesc.Height; ++i)
+    {
+        *destData++ = *src++;
+        *destData++ = *src++;
+        *destData++ = *src++;
+        ++src;
+    }
+
+    return true;
+}
+
 const Vector2 Graphics::pixelUVOffset(0.0f, 0.0f);
 bool Graphics::gl3Support = false;
 
@@ -306,13 +521,11 @@ Graphics::~Graphics()
 #else
     PARTIALLY_IMPLEMENTED();
 
-    #ifdef USE_WAIT_FOR_IDLE_WORKAROUND
-    if (impl_->waitForIdleThread_)
-    {
-        impl_->waitForIdleThread_->join();
-        impl_->waitForIdleThread_ = nullptr;
-    }
-    #endif
+    // Finish presenting before the swap chain is destroyed
+    impl_->SetPresentThread(false);
+
+    UpdatePendingPipelineStates(true);
+    SavePipelineStateCache();
 
     if (window_)
     {
@@ -408,7 +621,46 @@ void Graphics::SetFlushGPU(bool enable)
 
     if (impl_->swapChain_)
     {
-        impl_->swapChain_->SetMaximumFrameLatency(enable ? 1 : 3);
+        impl_->WaitForPresent();
+        impl_->swapChain_->SetMaximumFrameLatency(enable ? 1 : maxFramesInFlight_);
+    }
+}
+
+void Graphics::SetMaxFramesInFlight(unsigned frames)
+{
+    maxFramesInFlight_ = Clamp(frames, 1u, MAX_FRAMES_IN_FLIGHT);
+
+    if (impl_->swapChain_)
+    {
+        impl_->WaitForPresent();
+        impl_->swapChain_->SetMaximumFrameLatency(flushGPU_ ? 1 : maxFramesInFlight_);
+    }
+}
+
+void Graphics::SetPipelinedFrames(bool enable)
+{
+    pipelinedFrames_ = enable;
+
+    if (impl_->swapChain_)
+        impl_->SetPresentThread(enable);
+}
+
+void Graphics::SetGPUProfiling(bool enable)
+{
+    if (enable == gpuProfiling_)
+        return;
+
+    if (enable && !impl_->IsTimestampQuerySupported())
+    {
+        URHO3D_LOGWARNING("Timestamp queries are not supported, can not enable GPU profiling");
+        return;
+    }
+
+    gpuProfiling_ = enable;
+    if (!enable)
+    {
+        impl_->ReleaseGPUTimings();
+        gpuTimings_.Clear();
     }
 }
 
@@ -429,96 +681,91 @@ void Graphics::Close()
 
 bool Graphics::TakeScreenShot(Image& destImage)
 {
-#if 0
     URHO3D_PROFILE(TakeScreenShot);
 
     if (!impl_->device_)
         return false;
 
-    D3D11_TEXTURE2D_DESC textureDesc;
-    memset(&textureDesc, 0, sizeof textureDesc);
-    textureDesc.Width = (UINT)width_;
-    textureDesc.Height = (UINT)height_;
-    textureDesc.MipLevels = 1;
-    textureDesc.ArraySize = 1;
-    textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-    textureDesc.SampleDesc.Count = 1;
-    textureDesc.SampleDesc.Quality = 0;
-    textureDesc.Usage = D3D11_USAGE_STAGING;
-    textureDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
-
-    ID3D11Texture2D* stagingTexture = nullptr;
-    HRESULT hr = impl_->device_->CreateTexture2D(&textureDesc, nullptr, &stagingTexture);
-    if (FAILED(hr))
-    {
-        URHO3D_SAFE_RELEASE(stagingTexture);
-        URHO3D_LOGD3DERROR("Could not create staging texture for screenshot", hr);
+    if (screenParams_.multiSample_ > 1)
+        CreateResolveTexture();
+
+    RefCntAutoPtr<ITexture> stagingTexture = impl_->CopyBackbufferToStagingTexture();
+    if (!stagingTexture)
         return false;
-    }
 
-    ID3D11Resource* source = nullptr;
-    impl_->defaultRenderTargetView_->GetResource(&source);
+    const Uint64 fenceValue = impl_->SignalReadbackFence();
+    if (!fenceValue)
+        return false;
+
+    impl_->readbackFence_->Wait(fenceValue);
+    return ReadScreenShot(impl_, stagingTexture, destImage);
+}
+
+unsigned Graphics::RequestScreenShot()
+{
+    if (!impl_->device_)
+        return 0;
 
     if (screenParams_.multiSample_ > 1)
-    {
-        // If backbuffer is multisampled, need another DEFAULT usage texture to resolve the data to first
         CreateResolveTexture();
 
-        if (!impl_->resolveTexture_)
-        {
-            stagingTexture->Release();
-            source->Release();
-            return false;
-        }
+    RefCntAutoPtr<ITexture> stagingTexture = impl_->CopyBackbufferToStagingTexture();
+    if (!stagingTexture)
+        return 0;
+
+    return impl_->QueueReadback(stagingTexture, nullptr, 0);
+}
 
-        impl_->deviceContext_->ResolveSubresource(impl_->resolveTexture_, 0, source, 0, DXGI_FORMAT_R8G8B8A8_UNORM);
-        impl_->deviceContext_->CopyResource(stagingTexture, impl_->resolveTexture_);
+unsigned Graphics::RequestTextureData(Texture2D* texture, unsigned level)
+{
+    if (!texture || !texture->GetGPUObject())
+    {
+        URHO3D_LOGERROR("No texture created, can not request data");
+        return 0;
     }
-    else
-        impl_->deviceContext_->CopyResource(stagingTexture, source);
 
-    source->Release();
+    if (level >= texture->GetLevels())
+    {
+        URHO3D_LOGERROR("Illegal mip level for requesting data");
+        return 0;
+    }
 
-    D3D11_MAPPED_SUBRESOURCE mappedData;
-    mappedData.pData = nullptr;
-    hr = impl_->deviceContext_->Map(stagingTexture, 0, D3D11_MAP_READ, 0, &mappedData);
-    if (FAILED(hr) || !mappedData.pData)
+    if (texture->GetFormat() != GetRGBAFormat() && texture->GetFormat() != GetRGBFormat() &&
+        texture->GetFormat() != GetFloat32Format())
     {
-        URHO3D_LOGD3DERROR("Could not map staging texture for screenshot", hr);
-        stagingTexture->Release();
-        return false;
+        URHO3D_LOGERROR("Unsupported texture format, can not convert to Image");
+        return 0;
     }
 
-    destImage.SetSize(width_, height_, 3);
-    unsigned char* destData = destImage.GetData();
-    for (int y = 0; y < height_; ++y)
+    if (texture->GetMultiSample() > 1 && !texture->GetAutoResolve())
     {
-        unsigned char* src = (unsigned char*)mappedData.pData + y * mappedData.RowPitch;
-        for (int x = 0; x < width_; ++x)
-        {
-            *destData++ = *src++;
-            *destData++ = *src++;
-            *destData++ = *src++;
-            ++src;
-        }
+        URHO3D_LOGERROR("Can not request data from multisampled texture without autoresolve");
+        return 0;
     }
 
-    impl_->deviceContext_->Unmap(stagingTexture, 0);
-    stagingTexture->Release();
+    if (texture->IsResolveDirty())
+        ResolveToTexture(texture);
 
-    return true;
-#else
-    NOT_IMPLEMENTED();
+    auto* source = (ITexture*)(texture->GetResolveTexture() ? texture->GetResolveTexture() : texture->GetGPUObject());
+    RefCntAutoPtr<ITexture> stagingTexture = impl_->CopyToStagingTexture(source, level, 0);
+    if (!stagingTexture)
+        return 0;
 
-    return true;
-#endif
+    return impl_->QueueReadback(stagingTexture, texture, level);
 }
 
+
 bool Graphics::BeginFrame()
 {
     if (!IsInitialized())
         return false;
 
+    // The previous frame may still be presenting on the present thread
+    {
+        URHO3D_PROFILE(WaitForPresent);
+        impl_->WaitForPresent();
+    }
+
     // If using an external window, check it for size changes, and reset screen mode if necessary
     if (externalWindow_)
     {
@@ -536,6 +783,16 @@ bool Graphics::BeginFrame()
             return false;
     }
 
+    // Limit how far the CPU runs ahead, so that per-frame resources of the oldest queued frame can be reused
+    impl_->WaitForFramesInFlight(flushGPU_ ? 1 : maxFramesInFlight_);
+
+    // Upload texture data queued by background loading before anything of the frame is drawn
+    impl_->UpdateTextureUploads(uploadBudget_);
+
+    // The frame block encloses all other GPU timing blocks of the frame
+    if (gpuProfiling_)
+        impl_->BeginGPUTiming("Frame");
+
     // Set default rendertarget and depth buffer
     ResetRenderTargets();
 
@@ -546,6 +803,10 @@ bool Graphics::BeginFrame()
     numPrimitives_ = 0;
     numBatches_ = 0;
 
+    // Capture starts from the state reset above
+    if (graphicsCapture_)
+        graphicsCapture_->BeginFrame();
+
     SendEvent(E_BEGINRENDERING);
 
     return true;
@@ -559,32 +820,54 @@ void Graphics::EndFrame()
     {
         URHO3D_PROFILE(Present);
 
-#ifdef USE_WAIT_FOR_IDLE_WORKAROUND
-        if (impl_->waitForIdleThread_)
-        {
-            impl_->waitForIdleThread_->join();
-            impl_->waitForIdleThread_ = nullptr;
-        }
-#endif
         SendEvent(E_ENDRENDERING);
-        impl_->swapChain_->Present(screenParams_.vsync_ ? 1 : 0);
 
-#ifdef USE_WAIT_FOR_IDLE_WORKAROUND
-        const bool isVulkan = impl_->deviceType_ == RENDER_DEVICE_TYPE_VULKAN;
+        if (graphicsCapture_ && graphicsCapture_->EndFrame())
+            graphicsCapture_.Reset();
 
-        if (isVulkan)
-        {
-            impl_->waitForIdleThread_ = std::make_unique<std::thread>([device = impl_->device_.RawPtr()]() { device->IdleGPU(); });
-        }
-#endif
+        if (gpuProfiling_)
+            impl_->EndGPUTimingFrame();
+
+        // The frame fence also covers the async compute work when the graphics queue waits for it
+        WaitAsyncCompute();
+        impl_->SignalFrameFence();
+        // When pipelining frames, the present overlaps the following frame's update on the main thread. Functions
+        // using the immediate context wait for it to finish
+        if (impl_->presentThread_)
+            impl_->presentThread_->Present(screenParams_.vsync_ ? 1 : 0);
+        else
+            impl_->PresentFrame(screenParams_.vsync_ ? 1 : 0);
+
+        if (impl_->computeContext_)
+            impl_->computeContext_->FinishFrame();
+
+        // Dynamic buffer allocations are only valid within the frame
+        impl_->InvalidateConstantRing();
     }
 
+    UpdateReadbacks();
+
+    if (gpuProfiling_)
+        UpdateGPUTimings();
+
+    UpdateInternalGPUMemory();
+
+    // Pick up pipeline states finished on worker threads, also ones not requested again during this frame
+    UpdatePendingPipelineStates(false);
+
     // Clean up too large scratch buffers
     CleanupScratchBuffers();
 }
 
 void Graphics::Clear(ClearTargetFlags flags, const Color& color, float depth, unsigned stencil)
 {
+    // The state changes and the draw of a partial clear are replayed by the clear itself
+    if (graphicsCapture_)
+    {
+        graphicsCapture_->RecordClear(flags, color, depth, stencil);
+        graphicsCapture_->SetSuspended(true);
+    }
+
     IntVector2 rtSize = GetRenderTargetDimensions();
 
     bool oldColorWrite = colorWrite_;
@@ -617,7 +900,11 @@ void Graphics::Clear(ClearTargetFlags flags, const Color& color, float depth, un
     {
         Renderer* renderer = GetSubsystem<Renderer>();
         if (!renderer)
+        {
+            if (graphicsCapture_)
+                graphicsCapture_->SetSuspended(false);
             return;
+        }
 
         Geometry* geometry = renderer->GetQuadGeometry();
 
@@ -647,6 +934,9 @@ void Graphics::Clear(ClearTargetFlags flags, const Color& color, float depth, un
     // Restore color & depth write state now
     SetColorWrite(oldColorWrite);
     SetDepthWrite(oldDepthWrite);
+
+    if (graphicsCapture_)
+        graphicsCapture_->SetSuspended(false);
 }
 
 bool Graphics::ResolveToTexture(Texture2D* destination, const IntRect& viewport)
@@ -654,6 +944,9 @@ bool Graphics::ResolveToTexture(Texture2D* destination, const IntRect& viewport)
     if (!destination || !destination->GetRenderSurface())
         return false;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordResolveToTexture(destination, viewport);
+
     URHO3D_PROFILE(ResolveToTexture);
 
     IntRect vpCopy = viewport;
@@ -731,6 +1024,10 @@ bool Graphics::ResolveToTexture(Texture2D* texture)
 {
     if (!texture)
         return false;
+
+    if (graphicsCapture_)
+        graphicsCapture_->RecordResolveToTexture(texture);
+
     RenderSurface* surface = texture->GetRenderSurface();
     if (!surface)
         return false;
@@ -747,6 +1044,7 @@ bool Graphics::ResolveToTexture(Texture2D* texture)
     resolveTextureSubresourceAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
     resolveTextureSubresourceAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
 
+    impl_->WaitForPresent();
     impl_->deviceContext_->ResolveTextureSubresource(source, dest, resolveTextureSubresourceAttribs);
 
     return true;
@@ -757,12 +1055,17 @@ bool Graphics::ResolveToTexture(TextureCube* texture)
     if (!texture)
         return false;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordResolveToTexture(texture);
+
     texture->SetResolveDirty(false);
     ITexture* source = (ITexture*)texture->GetGPUObject();
     ITexture* dest = (ITexture*)texture->GetResolveTexture();
     if (!source || !dest)
         return false;
 
+    impl_->WaitForPresent();
+
     for (unsigned i = 0; i < MAX_CUBEMAP_FACES; ++i)
     {
         // Resolve only the surface(s) that were actually rendered to
@@ -785,17 +1088,624 @@ bool Graphics::ResolveToTexture(TextureCube* texture)
     return true;
 }
 
+bool Graphics::CopyTexture(Texture2D* destination, Texture2D* source)
+{
+    if (!destination || !source || destination == source)
+        return false;
+    if (destination->GetWidth() != source->GetWidth() || destination->GetHeight() != source->GetHeight() ||
+        destination->GetFormat() != source->GetFormat())
+    {
+        URHO3D_LOGERROR("Texture copy requires textures of the same size and format");
+        return false;
+    }
+
+    ITexture* src = (ITexture*)source->GetGPUObject();
+    ITexture* dest = (ITexture*)destination->GetGPUObject();
+    if (!src || !dest)
+        return false;
+
+    URHO3D_PROFILE(CopyTexture);
+
+    if (graphicsCapture_)
+        graphicsCapture_->RecordCopyTexture(destination, source);
+
+    impl_->WaitForPresent();
+    impl_->deviceContext_->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    impl_->renderTargetsDirty_ = true;
+
+    CopyTextureAttribs copyTextureAttribs(src, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, dest,
+                                          RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    impl_->deviceContext_->CopyTexture(copyTextureAttribs);
+    // The copy may have transitioned textures that are currently bound for sampling
+    impl_->MarkShaderResourcesDirty();
+
+    return true;
+}
+
+bool Graphics::SkinVertices(VertexBuffer* source, VertexBuffer* dest, unsigned vertexStart, unsigned vertexCount,
+    const Matrix3x4* skinMatrices, unsigned numSkinMatrices)
+{
+    if (!computeSkinningSupport_ || !source || !dest || source == dest || !skinMatrices || !numSkinMatrices)
+        return false;
+    if (!vertexCount)
+        return true;
+    if (vertexStart + vertexCount > source->GetVertexCount() || vertexStart + vertexCount > dest->GetVertexCount())
+    {
+        URHO3D_LOGERROR("Illegal vertex range for compute skinning");
+        return false;
+    }
+    if (!source->GetComputeAccess() || !dest->GetComputeAccess() || !source->GetGPUObject() || !dest->GetGPUObject())
+    {
+        URHO3D_LOGERROR("Vertex buffers for compute skinning must have compute access enabled");
+        return false;
+    }
+
+    SkinningConstants constants;
+    constants.vertexStart_ = vertexStart;
+    constants.vertexCount_ = vertexCount;
+    constants.sourceStride_ = source->GetVertexSize();
+    constants.destStride_ = dest->GetVertexSize();
+    constants.positionOffset_ = source->GetElementOffset(TYPE_VECTOR3, SEM_POSITION);
+    constants.normalOffset_ = source->GetElementOffset(TYPE_VECTOR3, SEM_NORMAL);
+    constants.tangentOffset_ = source->GetElementOffset(TYPE_VECTOR4, SEM_TANGENT);
+    constants.weightsOffset_ = source->GetElementOffset(TYPE_VECTOR4, SEM_BLENDWEIGHTS);
+    constants.indicesOffset_ = source->GetElementOffset(TYPE_UBYTE4, SEM_BLENDINDICES);
+    constants.destPositionOffset_ = dest->GetElementOffset(TYPE_VECTOR3, SEM_POSITION);
+    constants.destNormalOffset_ = constants.normalOffset_ != M_MAX_UNSIGNED ? dest->GetElementOffset(TYPE_VECTOR3, SEM_NORMAL) :
+        M_MAX_UNSIGNED;
+    constants.destTangentOffset_ = constants.tangentOffset_ != M_MAX_UNSIGNED ? dest->GetElementOffset(TYPE_VECTOR4, SEM_TANGENT) :
+        M_MAX_UNSIGNED;
+
+    if (constants.positionOffset_ == M_MAX_UNSIGNED || constants.weightsOffset_ == M_MAX_UNSIGNED ||
+        constants.indicesOffset_ == M_MAX_UNSIGNED || constants.destPositionOffset_ == M_MAX_UNSIGNED ||
+        (constants.normalOffset_ != M_MAX_UNSIGNED && constants.destNormalOffset_ == M_MAX_UNSIGNED) ||
+        (constants.tangentOffset_ != M_MAX_UNSIGNED && constants.destTangentOffset_ == M_MAX_UNSIGNED))
+    {
+        URHO3D_LOGERROR("Vertex buffers are missing elements required for compute skinning");
+        return false;
+    }
+
+    // Compile the skinning pipeline on first use
+    if (!impl_->skinningPipeline_.pipeline_)
+    {
+        if (impl_->skinningPipeline_.failed_ || !impl_->CreateComputePipeline(impl_->skinningPipeline_, "Skinning",
+            ReadComputeShaderSource(GetSubsystem<ResourceCache>(), shaderPath_ + "Skinning" + shaderExtension_),
+            "SkinningParameters", sizeof(SkinningConstants)))
+            return false;
+    }
+
+    URHO3D_PROFILE(SkinVertices);
+
+    // The buffers are written and read as raw data, so they must not stay bound for vertex input
+    for (unsigned i = 0; i < MAX_VERTEX_STREAMS; ++i)
+    {
+        if (vertexBuffers_[i] == source || vertexBuffers_[i] == dest)
+        {
+            SetVertexBuffer(nullptr);
+            break;
+        }
+    }
+
+    return impl_->DispatchSkinning((IBuffer*)source->GetGPUObject(), (IBuffer*)dest->GetGPUObject(), constants, skinMatrices,
+        numSkinMatrices);
+}
+
+bool Graphics::MorphVertices(VertexBuffer* source, VertexBuffer* dest, VertexBuffer* deltas, unsigned vertexStart, unsigned vertexCount,
+    const unsigned* deltaBlocks, const float* weights, unsigned numMorphs)
+{
+    if (!computeSkinningSupport_ || !source || !dest || !deltas || source == dest || (numMorphs && (!deltaBlocks || !weights)))
+        return false;
+    if (numMorphs > MAX_COMPUTE_MORPHS)
+    {
+        URHO3D_LOGERROR("Too many morphs for compute morphing");
+        return false;
+    }
+    if (!vertexCount)
+        return true;
+    if (vertexStart + vertexCount > source->GetVertexCount() || vertexStart + vertexCount > dest->GetVertexCount())
+    {
+        URHO3D_LOGERROR("Illegal vertex range for compute morphing");
+        return false;
+    }
+    if (!source->GetComputeAccess() || !dest->GetComputeAccess() || !deltas->GetComputeAccess() || !source->GetGPUObject() ||
+        !dest->GetGPUObject() || !deltas->GetGPUObject())
+    {
+        URHO3D_LOGERROR("Vertex buffers for compute morphing must have compute access enabled");
+        return false;
+    }
+
+    MorphConstants constants{};
+    constants.vertexStart_ = vertexStart;
+    constants.vertexCount_ = vertexCount;
+    constants.sourceStride_ = source->GetVertexSize();
+    constants.destStride_ = dest->GetVertexSize();
+    constants.destPositionOffset_ = dest->GetElementOffset(TYPE_VECTOR3, SEM_POSITION);
+    constants.destNormalOffset_ = dest->GetElementOffset(TYPE_VECTOR3, SEM_NORMAL);
+    constants.destTangentOffset_ = dest->GetElementOffset(TYPE_VECTOR4, SEM_TANGENT);
+    constants.positionOffset_ = constants.destPositionOffset_ != M_MAX_UNSIGNED ?
+        source->GetElementOffset(TYPE_VECTOR3, SEM_POSITION) : M_MAX_UNSIGNED;
+    constants.normalOffset_ = constants.destNormalOffset_ != M_MAX_UNSIGNED ? source->GetElementOffset(TYPE_VECTOR3, SEM_NORMAL) :
+        M_MAX_UNSIGNED;
+    constants.tangentOffset_ = constants.destTangentOffset_ != M_MAX_UNSIGNED ? source->GetElementOffset(TYPE_VECTOR4, SEM_TANGENT) :
+        M_MAX_UNSIGNED;
+    constants.numMorphs_ = numMorphs;
+
+    // Delta blocks are vertexCount vertices of three Vector3 deltas each
+    unsigned numBlocks = deltas->GetVertexCount() / vertexCount;
+    for (unsigned i = 0; i < numMorphs; ++i)
+    {
+        if (deltaBlocks[i] >= numBlocks)
+        {
+            URHO3D_LOGERROR("Illegal morph delta block for compute morphing");
+            return false;
+        }
+        constants.weights_[i] = weights[i];
+        constants.deltaBlocks_[i] = deltaBlocks[i];
+    }
+
+    if ((constants.destPositionOffset_ != M_MAX_UNSIGNED && constants.positionOffset_ == M_MAX_UNSIGNED) ||
+        (constants.destNormalOffset_ != M_MAX_UNSIGNED && constants.normalOffset_ == M_MAX_UNSIGNED) ||
+        (constants.destTangentOffset_ != M_MAX_UNSIGNED && constants.tangentOffset_ == M_MAX_UNSIGNED) ||
+        deltas->GetVertexSize() != 3 * sizeof(Vector3))
+    {
+        URHO3D_LOGERROR("Vertex buffers are missing elements required for compute morphing");
+        return false;
+    }
+
+    // Compile the morph pipeline on first use
+    if (!impl_->morphPipeline_.pipeline_)
+    {
+        if (impl_->morphPipeline_.failed_ || !impl_->CreateComputePipeline(impl_->morphPipeline_, "Morph",
+            ReadComputeShaderSource(GetSubsystem<ResourceCache>(), shaderPath_ + "Morph" + shaderExtension_),
+            "MorphParameters", sizeof(MorphConstants)))
+            return false;
+    }
+
+    URHO3D_PROFILE(MorphVertices);
+
+    // The buffers are written and read as raw data, so they must not stay bound for vertex input
+    for (unsigned i = 0; i < MAX_VERTEX_STREAMS; ++i)
+    {
+        if (vertexBuffers_[i] == source || vertexBuffers_[i] == dest)
+        {
+            SetVertexBuffer(nullptr);
+            break;
+        }
+    }
+
+    return impl_->DispatchMorph((IBuffer*)source->GetGPUObject(), (IBuffer*)dest->GetGPUObject(), (IBuffer*)deltas->GetGPUObject(),
+        constants);
+}
+
+bool Graphics::SimulateParticles(VertexBuffer* states, VertexBuffer* dest, const GPUParticleSimulation& simulation)
+{
+    ParticleEffect* effect = simulation.effect_;
+    if (!computeSkinningSupport_ || !states || !dest || !effect)
+        return false;
+    unsigned numParticles = states->GetVertexCount();
+    if (!numParticles)
+        return true;
+    if (dest->GetVertexCount() != numParticles * 4 || states->GetVertexSize() != 4 * sizeof(Vector4) ||
+        simulation.numSpawn_ > numParticles)
+    {
+        URHO3D_LOGERROR("Illegal buffer sizes for GPU particles");
+        return false;
+    }
+    if (!states->GetComputeAccess() || !dest->GetComputeAccess() || !states->GetGPUObject() || !dest->GetGPUObject())
+    {
+        URHO3D_LOGERROR("Vertex buffers for GPU particles must have compute access enabled");
+        return false;
+    }
+
+    ParticleConstants constants{};
+    constants.numParticles_ = numParticles;
+    constants.spawnStart_ = simulation.spawnStart_ % numParticles;
+    constants.numSpawn_ = simulation.numSpawn_;
+    constants.seed_ = simulation.seed_;
+    constants.destStride_ = dest->GetVertexSize();
+    constants.directionOffset_ = dest->GetElementOffset(TYPE_VECTOR3, SEM_NORMAL);
+    constants.emitterType_ = effect->GetEmitterType();
+    constants.reset_ = simulation.reset_ ? 1 : 0;
+    constants.timeStep_ = simulation.timeStep_;
+    constants.dampingForce_ = effect->GetDampingForce();
+    constants.sizeAdd_ = effect->GetSizeAdd();
+    constants.sizeMul_ = effect->GetSizeMul();
+    constants.minVelocity_ = effect->GetMinVelocity();
+    constants.maxVelocity_ = effect->GetMaxVelocity();
+    constants.minTimeToLive_ = effect->GetMinTimeToLive();
+    constants.maxTimeToLive_ = effect->GetMaxTimeToLive();
+    constants.minRotation_ = effect->GetMinRotation();
+    constants.maxRotation_ = effect->GetMaxRotation();
+    constants.minRotationSpeed_ = effect->GetMinRotationSpeed();
+    constants.maxRotationSpeed_ = effect->GetMaxRotationSpeed();
+    memcpy(constants.sizeScale_, simulation.sizeScale_.Data(), sizeof(Vector2));
+    memcpy(constants.sizeRange_, effect->GetMinParticleSize().Data(), sizeof(Vector2));
+    memcpy(constants.sizeRange_ + 2, effect->GetMaxParticleSize().Data(), sizeof(Vector2));
+    memcpy(constants.emitterSize_, effect->GetEmitterSize().Data(), sizeof(Vector3));
+    memcpy(constants.minDirection_, effect->GetMinDirection().Data(), sizeof(Vector3));
+    memcpy(constants.maxDirection_, effect->GetMaxDirection().Data(), sizeof(Vector3));
+    memcpy(constants.constantForce_, simulation.constantForce_.Data(), sizeof(Vector3));
+    memcpy(constants.positionScale_, simulation.positionScale_.Data(), sizeof(Vector3));
+    constants.emitTransform_ = simulation.emitTransform_;
+
+    // Animation frames beyond the constant buffer capacity are ignored
+    const Vector<ColorFrame>& colorFrames = effect->GetColorFrames();
+    constants.numColorFrames_ = Min(colorFrames.Size(), MAX_GPU_PARTICLE_FRAMES);
+    for (unsigned i = 0; i < constants.numColorFrames_; ++i)
+    {
+        memcpy(constants.colorFrames_ + i * 4, colorFrames[i].color_.Data(), sizeof(Color));
+        constants.colorTimes_[i] = colorFrames[i].time_;
+    }
+    const Vector<TextureFrame>& textureFrames = effect->GetTextureFrames();
+    constants.numTextureFrames_ = Min(textureFrames.Size(), MAX_GPU_PARTICLE_FRAMES);
+    for (unsigned i = 0; i < constants.numTextureFrames_; ++i)
+    {
+        const Rect& uv = textureFrames[i].uv_;
+        constants.textureFrames_[i * 4] = uv.min_.x_;
+        constants.textureFrames_[i * 4 + 1] = uv.min_.y_;
+        constants.textureFrames_[i * 4 + 2] = uv.max_.x_;
+        constants.textureFrames_[i * 4 + 3] = uv.max_.y_;
+        constants.textureTimes_[i] = textureFrames[i].time_;
+    }
+
+    // Compile the particle pipeline on first use
+    if (!impl_->particlePipeline_.pipeline_)
+    {
+        if (impl_->particlePipeline_.failed_ || !impl_->CreateComputePipeline(impl_->particlePipeline_, "GPUParticles",
+            ReadComputeShaderSource(GetSubsystem<ResourceCache>(), shaderPath_ + "GPUParticles" + shaderExtension_),
+            "ParticleParameters", sizeof(ParticleConstants)))
+            return false;
+    }
+
+    URHO3D_PROFILE(SimulateParticles);
+
+    // The destination is written as raw data, so it must not stay bound for vertex input
+    for (unsigned i = 0; i < MAX_VERTEX_STREAMS; ++i)
+    {
+        if (vertexBuffers_[i] == dest)
+        {
+            SetVertexBuffer(nullptr);
+            break;
+        }
+    }
+
+    return impl_->DispatchParticles((IBuffer*)states->GetGPUObject(), (IBuffer*)dest->GetGPUObject(), constants);
+}
+
+bool Graphics::CompactIndices(IndexBuffer* source, IndexBuffer* dest, const unsigned* ranges, unsigned numRanges)
+{
+    if (!computeSkinningSupport_ || !source || !dest || source == dest || (numRanges && !ranges))
+        return false;
+    if (!numRanges)
+        return true;
+    if (dest->GetIndexSize() != sizeof(unsigned))
+    {
+        URHO3D_LOGERROR("Destination of index compaction must have 32-bit indices");
+        return false;
+    }
+    for (unsigned i = 0; i < numRanges; ++i)
+    {
+        const unsigned* range = ranges + i * 3;
+        if (range[0] + range[2] > source->GetIndexCount() || range[1] + range[2] > dest->GetIndexCount())
+        {
+            URHO3D_LOGERROR("Illegal index range for index compaction");
+            return false;
+        }
+    }
+    if (!source->GetComputeAccess() || !dest->GetComputeAccess() || !source->GetGPUObject() || !dest->GetGPUObject())
+    {
+        URHO3D_LOGERROR("Index buffers for index compaction must have compute access enabled");
+        return false;
+    }
+
+    CompactIndexConstants constants{};
+    constants.numRanges_ = numRanges;
+    constants.largeSourceIndices_ = source->GetIndexSize() == sizeof(unsigned) ? 1 : 0;
+
+    // Compile the index compaction pipeline on first use
+    if (!impl_->compactIndexPipeline_.pipeline_)
+    {
+        if (impl_->compactIndexPipeline_.failed_ || !impl_->CreateComputePipeline(impl_->compactIndexPipeline_, "CompactIndices",
+            ReadComputeShaderSource(GetSubsystem<ResourceCache>(), shaderPath_ + "CompactIndices" + shaderExtension_),
+            "CompactParameters", sizeof(CompactIndexConstants)))
+            return false;
+    }
+
+    URHO3D_PROFILE(CompactIndices);
+
+    // The buffers are written and read as raw data, so they must not stay bound for index input
+    if (indexBuffer_ == source || indexBuffer_ == dest)
+        SetIndexBuffer(nullptr);
+
+    return impl_->DispatchCompactIndices((IBuffer*)source->GetGPUObject(), (IBuffer*)dest->GetGPUObject(), constants, ranges);
+}
+
+bool Graphics::DispatchCompute(const String& shaderName, const String& defines, Texture2D* const* textures, Texture2D* output,
+    const PODVector<Vector4>& parameters, bool async)
+{
+    if (!computeSkinningSupport_ || shaderName.Empty() || !output)
+        return false;
+    ITexture* outputTexture = (ITexture*)output->GetGPUObject();
+    if (!outputTexture || !(outputTexture->GetDesc().BindFlags & BIND_UNORDERED_ACCESS))
+    {
+        URHO3D_LOGERROR("Output of compute shader " + shaderName + " must have compute access and not be multisampled or sRGB");
+        return false;
+    }
+
+    // Compile the pipeline of each shader and defines combination on first use. The pipelines may run on both queues
+    ComputePipeline& pipeline = impl_->textureComputePipelines_[StringHash(shaderName + " " + defines)];
+    if (!pipeline.pipeline_)
+    {
+        if (pipeline.failed_)
+            return false;
+
+        String source = ReadComputeShaderSource(GetSubsystem<ResourceCache>(), shaderPath_ + shaderName + shaderExtension_);
+        if (!source.Empty())
+        {
+            String defineLines;
+            Vector<String> defineList = defines.Split(' ');
+            for (unsigned i = 0; i < defineList.Size(); ++i)
+                defineLines += "#define " + defineList[i].Replaced('=', ' ') + "\n";
+            source = defineLines + source;
+        }
+
+        if (!impl_->CreateComputePipeline(pipeline, shaderName.CString(), source, "ComputeParameters",
+            sizeof(TextureComputeConstants), impl_->GetImmediateContextMask()))
+            return false;
+    }
+
+    URHO3D_PROFILE(DispatchCompute);
+
+    // Bind the inputs by the shader names of their texture units
+    IShaderResourceBinding* binding = pipeline.binding_;
+    ITexture* inputs[MAX_TEXTURE_UNITS];
+    Texture* usedTextures[MAX_TEXTURE_UNITS + 1];
+    unsigned numInputs = 0;
+    for (HashMap<String, TextureUnit>::ConstIterator i = textureUnits_.Begin(); i != textureUnits_.End() && numInputs <
+        MAX_TEXTURE_UNITS; ++i)
+    {
+        Texture2D* texture = textures ? textures[i->second_] : nullptr;
+        if (!texture || texture == output || !texture->GetShaderResourceView())
+            continue;
+        IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, ("t" + i->first_).CString());
+        if (!variable)
+            continue;
+
+        if (texture->GetMultiSample() > 1 && texture->GetAutoResolve() && texture->IsResolveDirty())
+            ResolveToTexture(texture);
+        variable->Set((ITextureView*)texture->GetShaderResourceView());
+        inputs[numInputs] = texture->GetResolveTexture() ? (ITexture*)texture->GetResolveTexture() : (ITexture*)texture->GetGPUObject();
+        usedTextures[numInputs++] = texture;
+    }
+    usedTextures[numInputs] = output;
+
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "rwOutput"))
+        variable->Set(outputTexture->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+
+    // The output must not stay bound for sampling, nor any of the textures for rendering, while the compute shader runs
+    for (unsigned i = 0; i < MAX_TEXTURE_UNITS; ++i)
+    {
+        if (textures_[i] == output)
+            SetTexture(i, nullptr);
+    }
+    for (unsigned i = 0; i <= numInputs; ++i)
+    {
+        for (unsigned j = 0; j < MAX_RENDERTARGETS; ++j)
+        {
+            if (renderTargets_[j] && renderTargets_[j]->GetParentTexture() == usedTextures[i])
+                SetRenderTarget(j, (RenderSurface*)nullptr);
+        }
+        if (depthStencil_ && depthStencil_->GetParentTexture() == usedTextures[i])
+            SetDepthStencil((RenderSurface*)nullptr);
+    }
+
+    TextureComputeConstants constants{};
+    const auto width = (float)output->GetWidth();
+    const auto height = (float)output->GetHeight();
+    constants.outputSize_ = Vector4(width, height, 1.0f / width, 1.0f / height);
+    for (unsigned i = 0; i < parameters.Size() && i < MAX_COMPUTE_PARAMETERS; ++i)
+        constants.parameters_[i] = parameters[i];
+
+    bool dispatchedAsync = false;
+    if (!impl_->DispatchTextureCompute(pipeline, constants, inputs, numInputs, outputTexture, async, dispatchedAsync))
+        return false;
+
+    if (dispatchedAsync)
+        asyncComputePending_ = true;
+    output->SetLevelsDirty();
+    return true;
+}
+
+void Graphics::WaitAsyncCompute()
+{
+    if (!asyncComputePending_)
+        return;
+
+    impl_->WaitComputeQueue();
+    asyncComputePending_ = false;
+}
+
+bool Graphics::LoadShaderArchive(const String& fileName)
+{
+    impl_->shaderArchive_.Release();
+
+    if (!impl_->device_)
+    {
+        URHO3D_LOGERROR("Can not load shader archive before the graphics device is created");
+        return false;
+    }
+
+    const String archiveFileName = GetShaderArchiveFileName(fileName, impl_->deviceType_);
+    SharedPtr<File> file = GetSubsystem<ResourceCache>()->GetFile(archiveFileName);
+    if (!file || !file->GetSize())
+        return false;
+
+    IEngineFactory* factory = impl_->device_->GetEngineFactory();
+    RefCntAutoPtr<IDataBlob> archiveData;
+    factory->CreateDataBlob(file->GetSize(), nullptr, &archiveData);
+    if (!archiveData || file->Read(archiveData->GetDataPtr(), file->GetSize()) != file->GetSize())
+    {
+        URHO3D_LOGERROR("Failed to read shader archive " + archiveFileName);
+        return false;
+    }
+
+    DearchiverCreateInfo dearchiverCreateInfo;
+    factory->CreateDearchiver(dearchiverCreateInfo, &impl_->shaderArchive_);
+    if (!impl_->shaderArchive_ || !impl_->shaderArchive_->LoadArchive(archiveData))
+    {
+        URHO3D_LOGERROR(archiveFileName + " is not a valid shader archive");
+        impl_->shaderArchive_.Release();
+        return false;
+    }
+
+    URHO3D_LOGINFO("Loaded shader archive " + archiveFileName);
+    return true;
+}
+
+bool Graphics::SaveShaderArchive(const String& fileName, const PODVector<ShaderVariation*>& variations, const Vector<String>& deviceTypes)
+{
+#if ARCHIVER_SUPPORTED
+    URHO3D_PROFILE(SaveShaderArchive);
+
+    IArchiverFactory* archiverFactory = GetArchiverFactory();
+    SerializationDeviceCreateInfo deviceCreateInfo;
+    RefCntAutoPtr<ISerializationDevice> serializationDevice;
+    if (archiverFactory)
+        archiverFactory->CreateSerializationDevice(deviceCreateInfo, &serializationDevice);
+    if (!serializationDevice)
+    {
+        URHO3D_LOGERROR("Failed to create shader serialization device");
+        return false;
+    }
+
+    // Resolve the device type names, skipping the ones the serialization device can not compile for
+    bool success = true;
+    PODVector<RENDER_DEVICE_TYPE> archiveDeviceTypes;
+    for (unsigned i = 0; i < deviceTypes.Size(); ++i)
+    {
+        RENDER_DEVICE_TYPE deviceType = RENDER_DEVICE_TYPE_UNDEFINED;
+        for (unsigned j = RENDER_DEVICE_TYPE_UNDEFINED + 1; j < RENDER_DEVICE_TYPE_COUNT; ++j)
+        {
+            if (deviceTypes[i].Compare(GetDeviceTypeName((RENDER_DEVICE_TYPE)j), false) == 0)
+                deviceType = (RENDER_DEVICE_TYPE)j;
+        }
+
+        if (deviceType == RENDER_DEVICE_TYPE_UNDEFINED)
+        {
+            URHO3D_LOGERROR("Unknown shader archive device type " + deviceTypes[i]);
+            success = false;
+        }
+        else if (!(serializationDevice->GetSupportedDeviceFlags() & (1u << deviceType)))
+        {
+            URHO3D_LOGERROR("Shader archives for device type " + deviceTypes[i] + " are not supported on this platform");
+            success = false;
+        }
+        else if (!archiveDeviceTypes.Contains(deviceType))
+            archiveDeviceTypes.Push(deviceType);
+    }
+
+    // Compile all variations for all device types in parallel, as the serialization device is thread-safe
+    Vector<ShaderArchiveJob> jobs;
+    jobs.Reserve(variations.Size() * archiveDeviceTypes.Size());
+    for (unsigned i = 0; i < archiveDeviceTypes.Size(); ++i)
+    {
+        for (unsigned j = 0; j < variations.Size(); ++j)
+        {
+            if (variations[j] && variations[j]->GetOwner())
+                jobs.Push(ShaderArchiveJob{variations[j], archiveDeviceTypes[i], serializationDevice, {}});
+        }
+    }
+
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    for (unsigned i = 0; i < jobs.Size(); ++i)
+    {
+        SharedPtr<WorkItem> item = workQueue->GetFreeItem();
+        item->priority_ = M_MAX_UNSIGNED;
+        item->workFunction_ = ArchiveShaderWork;
+        item->aux_ = &jobs[i];
+        workQueue->AddWorkItem(item);
+    }
+    workQueue->Complete(M_MAX_UNSIGNED);
+
+    for (unsigned i = 0; i < archiveDeviceTypes.Size(); ++i)
+    {
+        RefCntAutoPtr<IArchiver> archiver;
+        archiverFactory->CreateArchiver(serializationDevice, &archiver);
+        if (!archiver)
+            return false;
+
+        for (unsigned j = 0; j < jobs.Size(); ++j)
+        {
+            const ShaderArchiveJob& job = jobs[j];
+            if (job.deviceType_ != archiveDeviceTypes[i])
+                continue;
+
+            if (!job.shader_ || !archiver->AddShader(job.shader_))
+            {
+                URHO3D_LOGERROR("Failed to compile shader " + job.variation_->GetFullName() + " for device type " +
+                                GetDeviceTypeName(job.deviceType_));
+                success = false;
+            }
+        }
+
+        const String archiveFileName = GetShaderArchiveFileName(fileName, archiveDeviceTypes[i]);
+        RefCntAutoPtr<IDataBlob> archiveData;
+        if (!archiver->SerializeToBlob(&archiveData) || !archiveData)
+        {
+            URHO3D_LOGERROR("Failed to serialize shader archive " + archiveFileName);
+            success = false;
+            continue;
+        }
+
+        File file(context_, archiveFileName, FILE_WRITE);
+        if (!file.IsOpen() || file.Write(archiveData->GetConstDataPtr(), (unsigned)archiveData->GetSize()) != archiveData->GetSize())
+        {
+            URHO3D_LOGERROR("Failed to write shader archive " + archiveFileName);
+            success = false;
+            continue;
+        }
+
+        URHO3D_LOGINFO("Saved shader archive " + archiveFileName);
+    }
+
+    return success;
+#else
+    URHO3D_LOGERROR("Saving shader archives requires the Diligent archiver, which is not supported on this platform");
+    return false;
+#endif
+}
+
+void Graphics::BeginGPUTiming(const String& name)
+{
+    if (graphicsCapture_)
+        graphicsCapture_->RecordBeginGPUTiming(name);
+    if (gpuProfiling_)
+        impl_->BeginGPUTiming(name);
+}
+
+void Graphics::EndGPUTiming()
+{
+    if (graphicsCapture_)
+        graphicsCapture_->RecordEndGPUTiming();
+    if (gpuProfiling_)
+        impl_->EndGPUTiming();
+}
 
 void Graphics::Draw(PrimitiveType type, unsigned vertexStart, unsigned vertexCount)
 {
     if (!vertexCount || !impl_->shaderProgram_)
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordDraw(type, vertexStart, vertexCount);
+
     if (fillMode_ == FILL_POINT)
         type = POINT_LIST;
 
     impl_->SetPrimitiveType(type);
     PrepareDraw();
+    if (impl_->pipelineStatePending_)
+        return;
 
     DrawAttribs drawAttribs;
     drawAttribs.NumVertices = vertexCount;
@@ -811,11 +1721,16 @@ void Graphics::Draw(PrimitiveType type, unsigned indexStart, unsigned indexCount
     if (!vertexCount || !impl_->shaderProgram_)
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordDraw(type, indexStart, indexCount, 0, minVertex, vertexCount, 0);
+
     if (fillMode_ == FILL_POINT)
         type = POINT_LIST;
 
     impl_->SetPrimitiveType(type);
     PrepareDraw();
+    if (impl_->pipelineStatePending_)
+        return;
 
     DrawIndexedAttribs drawAttribs;
     drawAttribs.IndexType = diligentIndexType[indexBuffer_->GetIndexSize()];
@@ -832,11 +1747,16 @@ void Graphics::Draw(PrimitiveType type, unsigned indexStart, unsigned indexCount
     if (!vertexCount || !impl_->shaderProgram_)
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordDraw(type, indexStart, indexCount, baseVertexIndex, minVertex, vertexCount, 0);
+
     if (fillMode_ == FILL_POINT)
         type = POINT_LIST;
 
     impl_->SetPrimitiveType(type);
     PrepareDraw();
+    if (impl_->pipelineStatePending_)
+        return;
 
     DrawIndexedAttribs drawAttribs;
     drawAttribs.IndexType = diligentIndexType[indexBuffer_->GetIndexSize()];
@@ -855,11 +1775,16 @@ void Graphics::DrawInstanced(PrimitiveType type, unsigned indexStart, unsigned i
     if (!indexCount || !instanceCount || !impl_->shaderProgram_)
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordDraw(type, indexStart, indexCount, 0, minVertex, vertexCount, instanceCount);
+
     if (fillMode_ == FILL_POINT)
         type = POINT_LIST;
 
     impl_->SetPrimitiveType(type);
     PrepareDraw();
+    if (impl_->pipelineStatePending_)
+        return;
 
     DrawIndexedAttribs drawAttribs;
     drawAttribs.IndexType = diligentIndexType[indexBuffer_->GetIndexSize()];
@@ -878,11 +1803,16 @@ void Graphics::DrawInstanced(PrimitiveType type, unsigned indexStart, unsigned i
     if (!indexCount || !instanceCount || !impl_->shaderProgram_)
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordDraw(type, indexStart, indexCount, baseVertexIndex, minVertex, vertexCount, instanceCount);
+
     if (fillMode_ == FILL_POINT)
         type = POINT_LIST;
 
     impl_->SetPrimitiveType(type);
     PrepareDraw();
+    if (impl_->pipelineStatePending_)
+        return;
 
     DrawIndexedAttribs drawAttribs;
     drawAttribs.IndexType = diligentIndexType[indexBuffer_->GetIndexSize()];
@@ -912,6 +1842,9 @@ bool Graphics::SetVertexBuffers(const PODVector<VertexBuffer*>& buffers, unsigne
         return false;
     }
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordVertexBuffers(buffers, instanceOffset);
+
     for (unsigned i = 0; i < MAX_VERTEX_STREAMS; ++i)
     {
         VertexBuffer* buffer = nullptr;
@@ -969,6 +1902,9 @@ bool Graphics::SetVertexBuffers(const Vector<SharedPtr<VertexBuffer> >& buffers,
 
 void Graphics::SetIndexBuffer(IndexBuffer* buffer)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordIndexBuffer(buffer);
+
     if (buffer != indexBuffer_)
     {
         if (buffer)
@@ -983,6 +1919,9 @@ void Graphics::SetIndexBuffer(IndexBuffer* buffer)
 
 void Graphics::SetShaders(ShaderVariation* vs, ShaderVariation* ps)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordShaders(vs, ps);
+
     // Switch to the clip plane variations if necessary
     if (useClipPlane_)
     {
@@ -1057,19 +1996,17 @@ void Graphics::SetShaders(ShaderVariation* vs, ShaderVariation* ps)
 
         for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS; ++i)
         {
-            void* vsBuffer = impl_->shaderProgram_->vsConstantBuffers_[i]
-                                 ? impl_->shaderProgram_->vsConstantBuffers_[i]->GetGPUObject()
-                                 : nullptr;
-            if (vsBuffer != (void*)impl_->constantBuffers_[VS][i])
+            ConstantBuffer* vsBuffer = impl_->shaderProgram_->vsConstantBuffers_[i].Get();
+            if (vsBuffer != impl_->constantBuffers_[VS][i])
             {
+                impl_->constantBuffers_[VS][i] = vsBuffer;
                 shaderParameterSources_[i] = (const void*)M_MAX_UNSIGNED;
             }
 
-            void* psBuffer = impl_->shaderProgram_->psConstantBuffers_[i]
-                                 ? impl_->shaderProgram_->psConstantBuffers_[i]->GetGPUObject()
-                                 : nullptr;
-            if (psBuffer != (void*)impl_->constantBuffers_[PS][i])
+            ConstantBuffer* psBuffer = impl_->shaderProgram_->psConstantBuffers_[i].Get();
+            if (psBuffer != impl_->constantBuffers_[PS][i])
             {
+                impl_->constantBuffers_[PS][i] = psBuffer;
                 shaderParameterSources_[i] = (const void*)M_MAX_UNSIGNED;
             }
         }
@@ -1093,9 +2030,13 @@ void Graphics::SetShaderParameter(StringHash param, const float* data, unsigned
         (i = impl_->shaderProgram_->parameters_.Find(param)) == impl_->shaderProgram_->parameters_.End())
         return;
 
+    if (graphicsCapture_)
+    {
+        graphicsCapture_->RecordShaderParameter(param,
+            VariantBuffer(reinterpret_cast<const unsigned char*>(data), count * (unsigned)sizeof(float)));
+    }
+
     ConstantBuffer* buffer = i->second_.bufferPtr_;
-    if (!buffer->IsDirty())
-        impl_->dirtyConstantBuffers_.Push(buffer);
     buffer->SetParameter(i->second_.offset_, (unsigned)(count * sizeof(float)), data);
 }
 
@@ -1106,9 +2047,10 @@ void Graphics::SetShaderParameter(StringHash param, float value)
         (i = impl_->shaderProgram_->parameters_.Find(param)) == impl_->shaderProgram_->parameters_.End())
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordShaderParameter(param, value);
+
     ConstantBuffer* buffer = i->second_.bufferPtr_;
-    if (!buffer->IsDirty())
-        impl_->dirtyConstantBuffers_.Push(buffer);
     buffer->SetParameter(i->second_.offset_, sizeof(float), &value);
 }
 
@@ -1119,9 +2061,10 @@ void Graphics::SetShaderParameter(StringHash param, int value)
         (i = impl_->shaderProgram_->parameters_.Find(param)) == impl_->shaderProgram_->parameters_.End())
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordShaderParameter(param, value);
+
     ConstantBuffer* buffer = i->second_.bufferPtr_;
-    if (!buffer->IsDirty())
-        impl_->dirtyConstantBuffers_.Push(buffer);
     buffer->SetParameter(i->second_.offset_, sizeof(int), &value);
 }
 
@@ -1132,9 +2075,10 @@ void Graphics::SetShaderParameter(StringHash param, bool value)
         (i = impl_->shaderProgram_->parameters_.Find(param)) == impl_->shaderProgram_->parameters_.End())
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordShaderParameter(param, value);
+
     ConstantBuffer* buffer = i->second_.bufferPtr_;
-    if (!buffer->IsDirty())
-        impl_->dirtyConstantBuffers_.Push(buffer);
     buffer->SetParameter(i->second_.offset_, sizeof(bool), &value);
 }
 
@@ -1145,9 +2089,10 @@ void Graphics::SetShaderParameter(StringHash param, const Color& color)
         (i = impl_->shaderProgram_->parameters_.Find(param)) == impl_->shaderProgram_->parameters_.End())
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordShaderParameter(param, color);
+
     ConstantBuffer* buffer = i->second_.bufferPtr_;
-    if (!buffer->IsDirty())
-        impl_->dirtyConstantBuffers_.Push(buffer);
     buffer->SetParameter(i->second_.offset_, sizeof(Color), &color);
 }
 
@@ -1158,9 +2103,10 @@ void Graphics::SetShaderParameter(StringHash param, const Vector2& vector)
         (i = impl_->shaderProgram_->parameters_.Find(param)) == impl_->shaderProgram_->parameters_.End())
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordShaderParameter(param, vector);
+
     ConstantBuffer* buffer = i->second_.bufferPtr_;
-    if (!buffer->IsDirty())
-        impl_->dirtyConstantBuffers_.Push(buffer);
     buffer->SetParameter(i->second_.offset_, sizeof(Vector2), &vector);
 }
 
@@ -1171,9 +2117,10 @@ void Graphics::SetShaderParameter(StringHash param, const Matrix3& matrix)
         (i = impl_->shaderProgram_->parameters_.Find(param)) == impl_->shaderProgram_->parameters_.End())
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordShaderParameter(param, matrix);
+
     ConstantBuffer* buffer = i->second_.bufferPtr_;
-    if (!buffer->IsDirty())
-        impl_->dirtyConstantBuffers_.Push(buffer);
     buffer->SetVector3ArrayParameter(i->second_.offset_, 3, &matrix);
 }
 
@@ -1184,9 +2131,10 @@ void Graphics::SetShaderParameter(StringHash param, const Vector3& vector)
         (i = impl_->shaderProgram_->parameters_.Find(param)) == impl_->shaderProgram_->parameters_.End())
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordShaderParameter(param, vector);
+
     ConstantBuffer* buffer = i->second_.bufferPtr_;
-    if (!buffer->IsDirty())
-        impl_->dirtyConstantBuffers_.Push(buffer);
     buffer->SetParameter(i->second_.offset_, sizeof(Vector3), &vector);
 }
 
@@ -1197,9 +2145,10 @@ void Graphics::SetShaderParameter(StringHash param, const Matrix4& matrix)
         (i = impl_->shaderProgram_->parameters_.Find(param)) == impl_->shaderProgram_->parameters_.End())
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordShaderParameter(param, matrix);
+
     ConstantBuffer* buffer = i->second_.bufferPtr_;
-    if (!buffer->IsDirty())
-        impl_->dirtyConstantBuffers_.Push(buffer);
     buffer->SetParameter(i->second_.offset_, sizeof(Matrix4), &matrix);
 }
 
@@ -1210,9 +2159,10 @@ void Graphics::SetShaderParameter(StringHash param, const Vector4& vector)
         (i = impl_->shaderProgram_->parameters_.Find(param)) == impl_->shaderProgram_->parameters_.End())
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordShaderParameter(param, vector);
+
     ConstantBuffer* buffer = i->second_.bufferPtr_;
-    if (!buffer->IsDirty())
-        impl_->dirtyConstantBuffers_.Push(buffer);
     buffer->SetParameter(i->second_.offset_, sizeof(Vector4), &vector);
 }
 
@@ -1223,9 +2173,10 @@ void Graphics::SetShaderParameter(StringHash param, const Matrix3x4& matrix)
         (i = impl_->shaderProgram_->parameters_.Find(param)) == impl_->shaderProgram_->parameters_.End())
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordShaderParameter(param, matrix);
+
     ConstantBuffer* buffer = i->second_.bufferPtr_;
-    if (!buffer->IsDirty())
-        impl_->dirtyConstantBuffers_.Push(buffer);
     buffer->SetParameter(i->second_.offset_, sizeof(Matrix3x4), &matrix);
 }
 
@@ -1278,6 +2229,9 @@ void Graphics::SetTexture(unsigned index, Texture* texture)
     if (index >= MAX_TEXTURE_UNITS)
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordTexture(index, texture);
+
     // Check if texture is currently bound as a rendertarget. In that case, use its backup texture, or blank if not
     // defined
     if (texture)
@@ -1306,7 +2260,12 @@ void Graphics::SetTexture(unsigned index, Texture* texture)
         textures_[index] = nullptr; // Force reassign
     }
 
-    if (texture != textures_[index])
+    // A texture whose data is still queued for upload is sampled as the placeholder, and rebound once uploaded
+    ITextureView* view = nullptr;
+    if (texture)
+        view = texture->IsUploadPending() ? impl_->GetPlaceholderView() : (ITextureView*)texture->GetShaderResourceView();
+
+    if (texture != textures_[index] || view != impl_->shaderResourceViews_[index])
     {
         if (impl_->firstDirtyTexture_ == M_MAX_UNSIGNED)
             impl_->firstDirtyTexture_ = impl_->lastDirtyTexture_ = index;
@@ -1319,7 +2278,7 @@ void Graphics::SetTexture(unsigned index, Texture* texture)
         }
 
         textures_[index] = texture;
-        impl_->shaderResourceViews_[index] = texture ? (ITextureView*)texture->GetShaderResourceView() : nullptr;
+        impl_->shaderResourceViews_[index] = view;
         impl_->samplers_[index] = texture ? (ISampler*)texture->GetSampler() : nullptr;
         impl_->texturesDirty_ = true;
     }
@@ -1330,6 +2289,64 @@ void SetTextureForUpdate(Texture* texture)
     // No-op on Diligent
 }
 
+void Graphics::SetBindlessTextures(const PODVector<Texture*>& textures)
+{
+    if (graphicsCapture_)
+        graphicsCapture_->RecordBindlessTextures(textures);
+
+    impl_->bindlessViews_.Clear();
+    unsigned hash = 0;
+
+    for (unsigned i = 0; i < textures.Size() && i < MAX_BINDLESS_TEXTURES; ++i)
+    {
+        Texture* texture = textures[i];
+        if (!texture)
+            continue;
+
+        if (texture->GetLevelsDirty())
+            texture->RegenerateLevels();
+        if (texture->GetParametersDirty())
+            texture->UpdateParameters();
+
+        auto* view = texture->IsUploadPending() ? impl_->GetPlaceholderView() : (ITextureView*)texture->GetShaderResourceView();
+        auto* sampler = (ISampler*)texture->GetSampler();
+        if (!view)
+            continue;
+
+        // The sampler is captured along with the view when the array is set
+        view->SetSampler(sampler);
+        impl_->bindlessViews_.Push(view);
+        CombineHash(hash, MakeHash((void*)view));
+        CombineHash(hash, MakeHash((void*)sampler));
+    }
+
+    if (hash != impl_->bindlessTexturesHash_)
+    {
+        impl_->bindlessTexturesHash_ = hash;
+        impl_->MarkShaderResourcesDirty();
+    }
+}
+
+void Graphics::SetClusteredLights(const PODVector<Vector4>& lightData, const PODVector<unsigned>& clusters,
+    const PODVector<unsigned>& lightIndices)
+{
+    if (!clusteredLightingSupport_)
+        return;
+
+    if (graphicsCapture_)
+        graphicsCapture_->RecordClusteredLights(lightData, clusters, lightIndices);
+
+    bool success = impl_->UpdateClusterBuffer(0, lightData.Buffer(), lightData.Size() * sizeof(Vector4),
+        CLUSTER_LIGHT_VECTORS * sizeof(Vector4));
+    success &= impl_->UpdateClusterBuffer(1, clusters.Buffer(), clusters.Size() * sizeof(unsigned), 2 * sizeof(unsigned));
+    success &= impl_->UpdateClusterBuffer(2, lightIndices.Buffer(), lightIndices.Size() * sizeof(unsigned), sizeof(unsigned));
+    if (!success)
+        URHO3D_LOGERROR("Failed to upload clustered light lists");
+
+    // The buffer views may have changed, so the shader resource bindings must be checked again
+    impl_->MarkShaderResourcesDirty();
+}
+
 void Graphics::SetDefaultTextureFilterMode(TextureFilterMode mode)
 {
     if (mode != defaultTextureFilterMode_)
@@ -1402,6 +2419,9 @@ void Graphics::SetRenderTarget(unsigned index, RenderSurface* renderTarget)
     if (index >= MAX_RENDERTARGETS)
         return;
 
+    if (graphicsCapture_)
+        graphicsCapture_->RecordRenderTarget(index, renderTarget);
+
     if (renderTarget != renderTargets_[index])
     {
         renderTargets_[index] = renderTarget;
@@ -1443,6 +2463,9 @@ void Graphics::SetRenderTarget(unsigned index, Texture2D* texture)
 
 void Graphics::SetDepthStencil(RenderSurface* depthStencil)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordDepthStencil(depthStencil);
+
     if (depthStencil != depthStencil_)
     {
         depthStencil_ = depthStencil;
@@ -1463,6 +2486,9 @@ void Graphics::SetDepthStencil(Texture2D* texture)
 
 void Graphics::SetViewport(const IntRect& rect)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordViewport(rect);
+
     IntVector2 size = GetRenderTargetDimensions();
 
     IntRect rectCopy = rect;
@@ -1494,6 +2520,9 @@ void Graphics::SetViewport(const IntRect& rect)
 
 void Graphics::SetBlendMode(BlendMode mode, bool alphaToCoverage)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordBlendMode(mode, alphaToCoverage);
+
     if (mode != blendMode_ || alphaToCoverage != alphaToCoverage_)
     {
         blendMode_ = mode;
@@ -1504,6 +2533,9 @@ void Graphics::SetBlendMode(BlendMode mode, bool alphaToCoverage)
 
 void Graphics::SetColorWrite(bool enable)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordColorWrite(enable);
+
     if (enable != colorWrite_)
     {
         colorWrite_ = enable;
@@ -1513,6 +2545,9 @@ void Graphics::SetColorWrite(bool enable)
 
 void Graphics::SetCullMode(CullMode mode)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordCullMode(mode);
+
     if (mode != cullMode_)
     {
         cullMode_ = mode;
@@ -1522,6 +2557,9 @@ void Graphics::SetCullMode(CullMode mode)
 
 void Graphics::SetDepthBias(float constantBias, float slopeScaledBias)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordDepthBias(constantBias, slopeScaledBias);
+
     if (constantBias != constantDepthBias_ || slopeScaledBias != slopeScaledDepthBias_)
     {
         constantDepthBias_ = constantBias;
@@ -1532,6 +2570,9 @@ void Graphics::SetDepthBias(float constantBias, float slopeScaledBias)
 
 void Graphics::SetDepthTest(CompareMode mode)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordDepthTest(mode);
+
     if (mode != depthTestMode_)
     {
         depthTestMode_ = mode;
@@ -1541,6 +2582,9 @@ void Graphics::SetDepthTest(CompareMode mode)
 
 void Graphics::SetDepthWrite(bool enable)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordDepthWrite(enable);
+
     if (enable != depthWrite_)
     {
         depthWrite_ = enable;
@@ -1552,6 +2596,9 @@ void Graphics::SetDepthWrite(bool enable)
 
 void Graphics::SetFillMode(FillMode mode)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordFillMode(mode);
+
     if (mode != fillMode_)
     {
         fillMode_ = mode;
@@ -1561,6 +2608,9 @@ void Graphics::SetFillMode(FillMode mode)
 
 void Graphics::SetLineAntiAlias(bool enable)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordLineAntiAlias(enable);
+
     if (enable != lineAntiAlias_)
     {
         lineAntiAlias_ = enable;
@@ -1570,6 +2620,9 @@ void Graphics::SetLineAntiAlias(bool enable)
 
 void Graphics::SetScissorTest(bool enable, const Rect& rect, bool borderInclusive)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordScissorTest(enable, rect, borderInclusive);
+
     // During some light rendering loops, a full rect is toggled on/off repeatedly.
     // Disable scissor in that case to reduce state changes
     if (rect.min_.x_ <= 0.0f && rect.min_.y_ <= 0.0f && rect.max_.x_ >= 1.0f && rect.max_.y_ >= 1.0f)
@@ -1612,6 +2665,9 @@ void Graphics::SetScissorTest(bool enable, const Rect& rect, bool borderInclusiv
 
 void Graphics::SetScissorTest(bool enable, const IntRect& rect)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordScissorTest(enable, rect);
+
     IntVector2 rtSize(GetRenderTargetDimensions());
     IntVector2 viewPos(viewport_.left_, viewport_.top_);
 
@@ -1648,6 +2704,9 @@ void Graphics::SetScissorTest(bool enable, const IntRect& rect)
 void Graphics::SetStencilTest(bool enable, CompareMode mode, StencilOp pass, StencilOp fail, StencilOp zFail, unsigned stencilRef,
     unsigned compareMask, unsigned writeMask)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordStencilTest(enable, mode, pass, fail, zFail, stencilRef, compareMask, writeMask);
+
     if (enable != stencilTest_)
     {
         stencilTest_ = enable;
@@ -1697,6 +2756,9 @@ void Graphics::SetStencilTest(bool enable, CompareMode mode, StencilOp pass, Ste
 
 void Graphics::SetClipPlane(bool enable, const Plane& clipPlane, const Matrix3x4& view, const Matrix4& projection)
 {
+    if (graphicsCapture_)
+        graphicsCapture_->RecordClipPlane(enable, clipPlane, view, projection);
+
     useClipPlane_ = enable;
 
     if (enable)
@@ -1946,7 +3008,6 @@ void Graphics::OnWindowMoved()
 
 void Graphics::CleanupShaderPrograms(ShaderVariation* variation)
 {
-#if 0
     for (ShaderProgramMap::Iterator i = impl_->shaderPrograms_.Begin(); i != impl_->shaderPrograms_.End();)
     {
         if (i->first_.first_ == variation || i->first_.second_ == variation)
@@ -1957,9 +3018,31 @@ void Graphics::CleanupShaderPrograms(ShaderVariation* variation)
 
     if (vertexShader_ == variation || pixelShader_ == variation)
         impl_->shaderProgram_ = nullptr;
-#else
-    NOT_IMPLEMENTED();
-#endif
+
+    // Pipeline states being created from the variation would hold its old shader object, so drop them too
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    for (auto i = impl_->pendingPipelineStates_.begin(); i != impl_->pendingPipelineStates_.end();)
+    {
+        PipelineStateCreateData& data = *i->second;
+        if (!data.desc_.UsesShader(variation))
+        {
+            ++i;
+            continue;
+        }
+
+        // The creation data can only be freed once the worker thread no longer uses it
+        if (!data.workItem_->completed_ && workQueue && !workQueue->RemoveWorkItem(data.workItem_))
+            workQueue->Wait(data.workItem_);
+        i = impl_->pendingPipelineStates_.erase(i);
+    }
+
+    unsigned removed = impl_->RemovePipelineStates(variation);
+    if (removed)
+    {
+        pipelineStateStats_.evictions_ += removed;
+        pipelineStateStats_.live_ = impl_->numPipelineStates_;
+        impl_->vertexShaderDirty_ = true;
+    }
 }
 
 void Graphics::CleanupRenderSurface(RenderSurface* surface)
@@ -2219,7 +3302,11 @@ bool Graphics::CreateDevice(int width, int height)
             if (!impl_->device_)
             {
                 Diligent::EngineD3D11CreateInfo EngineCI;
-                pFactoryD3D11->CreateDeviceAndContextsD3D11(EngineCI, &impl_->device_, &impl_->deviceContext_);
+                EngineCI.Features.TimestampQueries = DEVICE_FEATURE_STATE_OPTIONAL;
+
+                IDeviceContext* context = nullptr;
+                pFactoryD3D11->CreateDeviceAndContextsD3D11(EngineCI, &impl_->device_, &context);
+                impl_->SetDeviceContexts(&context, 1);
 
                 CheckFeatureSupport();
             }
@@ -2247,7 +3334,15 @@ bool Graphics::CreateDevice(int width, int height)
                 EngineCI.GPUDescriptorHeapDynamicSize[1] = 2048 - 64;
                 EngineCI.GPUDescriptorHeapSize[0] = 65536; // For mutable mode
                 EngineCI.GPUDescriptorHeapSize[1] = 64; // For mutable mode
-                pFactoryD3D12->CreateDeviceAndContextsD3D12(EngineCI, &impl_->device_, &impl_->deviceContext_);
+                EngineCI.Features.TimestampQueries = DEVICE_FEATURE_STATE_OPTIONAL;
+                EngineCI.Features.BindlessResources = DEVICE_FEATURE_STATE_OPTIONAL;
+
+                ImmediateContextCreateInfo contextInfos[2];
+                const unsigned numImmediateContexts = SetImmediateContexts(pFactoryD3D12, EngineCI, contextInfos);
+
+                IDeviceContext* contexts[2] = {};
+                pFactoryD3D12->CreateDeviceAndContextsD3D12(EngineCI, &impl_->device_, contexts);
+                impl_->SetDeviceContexts(contexts, numImmediateContexts);
 
                 CheckFeatureSupport();
             }
@@ -2283,7 +3378,15 @@ bool Graphics::CreateDevice(int width, int height)
                 EngineCI.ppIgnoreDebugMessageNames = ppIgnoreDebugMessages;
                 EngineCI.IgnoreDebugMessageCount = _countof(ppIgnoreDebugMessages);
 
-                pFactoryVk->CreateDeviceAndContextsVk(EngineCI, &impl_->device_, &impl_->deviceContext_);
+                EngineCI.Features.TimestampQueries = DEVICE_FEATURE_STATE_OPTIONAL;
+                EngineCI.Features.BindlessResources = DEVICE_FEATURE_STATE_OPTIONAL;
+
+                ImmediateContextCreateInfo contextInfos[2];
+                const unsigned numImmediateContexts = SetImmediateContexts(pFactoryVk, EngineCI, contextInfos);
+
+                IDeviceContext* contexts[2] = {};
+                pFactoryVk->CreateDeviceAndContextsVk(EngineCI, &impl_->device_, contexts);
+                impl_->SetDeviceContexts(contexts, numImmediateContexts);
 
                 CheckFeatureSupport();
             }
@@ -2302,6 +3405,11 @@ bool Graphics::CreateDevice(int width, int height)
         return false;
     }
 
+    if (!impl_->constantRingBuffer_ && !impl_->CreateConstantRingBuffer())
+        return false;
+
+    impl_->SetPresentThread(pipelinedFrames_);
+
     return true;
 }
 
@@ -2309,6 +3417,8 @@ bool Graphics::UpdateSwapChain(int width, int height)
 {
     bool success = true;
 
+    impl_->WaitForPresent();
+
     impl_->deviceContext_->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
     if (impl_->defaultRenderTargetView_)
@@ -2365,6 +3475,17 @@ void Graphics::CheckFeatureSupport()
     deferredSupport_ = true;
     hardwareShadowSupport_ = true;
     instancingSupport_ = true;
+    // Texture arrays indexed per instance need descriptor indexing, which is only exposed on D3D12 and Vulkan
+    bindlessTexturesSupport_ = impl_->device_ &&
+        (impl_->deviceType_ == RENDER_DEVICE_TYPE_D3D12 || impl_->deviceType_ == RENDER_DEVICE_TYPE_VULKAN) &&
+        impl_->device_->GetDeviceInfo().Features.BindlessResources == DEVICE_FEATURE_STATE_ENABLED;
+    // Structured buffers are available on all Diligent backends
+    clusteredLightingSupport_ = impl_->device_ != nullptr;
+    computeSkinningSupport_ = impl_->device_ &&
+        impl_->device_->GetDeviceInfo().Features.ComputeShaders == DEVICE_FEATURE_STATE_ENABLED;
+    textureCopySupport_ = true;
+    asyncReadbackSupport_ = true;
+    asyncComputeSupport_ = computeSkinningSupport_ && impl_->computeContext_ != nullptr;
     shadowMapFormat_ = TEX_FORMAT_R16_TYPELESS;
     hiresShadowMapFormat_ = TEX_FORMAT_R32_TYPELESS;
     dummyColorFormat_ = TEX_FORMAT_UNKNOWN;
@@ -2432,6 +3553,10 @@ void Graphics::ResetCachedState()
     stencilWriteMask_ = M_MAX_UNSIGNED;
     useClipPlane_ = false;
     impl_->shaderProgram_ = nullptr;
+    impl_->currentPipelineState_ = nullptr;
+    impl_->currentShaderResourceBinding_ = nullptr;
+    impl_->currentTextureMap_.reset();
+    impl_->currentBindingCache_.reset();
     impl_->renderTargetsDirty_ = true;
     impl_->texturesDirty_ = true;
     impl_->vertexDeclarationDirty_ = true;
@@ -2445,11 +3570,28 @@ void Graphics::ResetCachedState()
     impl_->rasterizerStateHash_ = M_MAX_UNSIGNED;
     impl_->firstDirtyTexture_ = impl_->lastDirtyTexture_ = M_MAX_UNSIGNED;
     impl_->firstDirtyVB_ = impl_->lastDirtyVB_ = M_MAX_UNSIGNED;
-    impl_->dirtyConstantBuffers_.Clear();
+    impl_->currentConstantBufferMap_.reset();
+    impl_->constantOffsetsBinding_ = nullptr;
+    // The device context may have changed, and dynamic buffer data is specific to a device context
+    impl_->InvalidateConstantRing();
 }
 
 void Graphics::PrepareDraw()
 {
+    impl_->pipelineStatePending_ = false;
+
+    // Dynamic buffer contents written in an earlier frame do not persist on D3D12 and Vulkan
+    if (!impl_->IsDynamicDataPersistent())
+    {
+        for (unsigned i = 0; i < MAX_VERTEX_STREAMS; ++i)
+        {
+            if (vertexBuffers_[i])
+                vertexBuffers_[i]->RestoreDynamicData();
+        }
+        if (indexBuffer_)
+            indexBuffer_->RestoreDynamicData();
+    }
+
     bool pipelineStateChanged = false;
     bool renderTargetHashChanged = false;
     if (impl_->renderTargetsDirty_)
@@ -2615,346 +3757,497 @@ void Graphics::PrepareDraw()
         if (pipelineStateDirty)
         {
             RefCntAutoPtr<IPipelineState> pipelineState;
-            RefCntAutoPtr<IShaderResourceBinding> shaderResourceBinding;
             std::shared_ptr<GraphicsImpl::PipelineState::TextureMap> textureMap;
 
-            auto pipelineKey = std::make_tuple(vertexShader_, pixelShader_, impl_->blendStateHash_,
-                                               impl_->depthStateHash_, impl_->rasterizerStateHash_,
-                                               vertexDeclarationHash_, impl_->primitiveType_, impl_->renderTargetHash_);
-            auto iterator = impl_->pipelineStates_.find(pipelineKey);
-            if (iterator == impl_->pipelineStates_.end())
+            PipelineStateDesc desc;
+            desc.vertexShader_ = vertexShader_;
+            desc.pixelShader_ = pixelShader_;
+            desc.vertexDeclarationHash_ = vertexDeclarationHash_;
+            desc.blendStateHash_ = impl_->blendStateHash_;
+            desc.depthStateHash_ = impl_->depthStateHash_;
+            desc.rasterizerStateHash_ = impl_->rasterizerStateHash_;
+            desc.renderTargetHash_ = impl_->renderTargetHash_;
+            desc.primitiveType_ = impl_->primitiveType_;
+            const unsigned long long pipelineKey = desc.ToKey();
+
+            GraphicsImpl::PipelineState* entry = impl_->FindPipelineState(pipelineKey, desc);
+            if (entry)
+                ++pipelineStateStats_.hits_;
+            else
             {
-                GraphicsPipelineStateCreateInfo pipelineStateCreateInfo;
-                // TODO: Remove
-#if 1
-                static int count = 0;
-                String psoName = String().AppendWithFormat("%d", count++);
-                pipelineStateCreateInfo.PSODesc.Name = psoName.CString();
-#else
-                pipelineStateCreateInfo.PSODesc.Name = "";
-#endif
-                pipelineStateCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
-                if (impl_->renderTargetHash_ != 0)
+                auto pendingIterator = impl_->pendingPipelineStates_.find(pipelineKey);
+                // A pending pipeline state with a colliding key but different description is not waited for
+                bool async = asyncPipelineCompile_ && impl_->deviceType_ != RENDER_DEVICE_TYPE_GL &&
+                             impl_->deviceType_ != RENDER_DEVICE_TYPE_GLES && GetSubsystem<WorkQueue>() &&
+                             (pendingIterator == impl_->pendingPipelineStates_.end() || pendingIterator->second->desc_ == desc);
+
+                if (async)
                 {
-                    unsigned renderTargetsCount = 0;
-                    for (unsigned i = 0; i < MAX_RENDERTARGETS; i++)
+                    if (pendingIterator == impl_->pendingPipelineStates_.end())
+                    {
+                        ++pipelineStateStats_.misses_;
+
+                        auto data = std::make_unique<PipelineStateCreateData>();
+                        FillPipelineStateCreateData(*data);
+                        data->desc_ = desc;
+
+                        // Not a pooled item, as the work queue would reset and reuse it while still being polled here
+                        data->workItem_ = new WorkItem();
+                        data->workItem_->priority_ = 0;
+                        data->workItem_->workFunction_ = CreatePipelineStateWork;
+                        data->workItem_->aux_ = data.get();
+                        GetSubsystem<WorkQueue>()->AddWorkItem(data->workItem_);
+
+                        pendingIterator = impl_->pendingPipelineStates_.emplace(pipelineKey, std::move(data)).first;
+                    }
+
+                    PipelineStateCreateData& data = *pendingIterator->second;
+                    if (!data.workItem_->completed_)
                     {
-                        if (impl_->renderTargetViews_[i])
-                        {
-                            pipelineStateCreateInfo.GraphicsPipeline.RTVFormats[i] =
-                                impl_->renderTargetViews_[i]->GetDesc().Format;
-                            renderTargetsCount = i + 1;
-                        }
-                        else
-                        {
-                            pipelineStateCreateInfo.GraphicsPipeline.RTVFormats[i] = TEX_FORMAT_UNKNOWN;
-                        }
+                        // Skip draws using this state until the worker thread is done. Force the state to be looked up
+                        // again on the next draw, as the dirty flags and state hashes have already been consumed
+                        impl_->currentPipelineState_ = nullptr;
+                        impl_->vertexShaderDirty_ = true;
+                        impl_->pipelineStatePending_ = true;
+                        return;
                     }
-                    pipelineStateCreateInfo.GraphicsPipeline.NumRenderTargets = renderTargetsCount;
+
+                    pipelineStateStats_.creationTime_ += data.creationTime_;
+                    entry = impl_->AddPipelineState(this, data);
+                    impl_->pendingPipelineStates_.erase(pendingIterator);
                 }
                 else
                 {
-                    pipelineStateCreateInfo.GraphicsPipeline.NumRenderTargets = 0;
+                    ++pipelineStateStats_.misses_;
+
+                    PipelineStateCreateData data;
+                    FillPipelineStateCreateData(data);
+                    data.desc_ = desc;
+                    HiresTimer timer;
+                    impl_->device_->CreateGraphicsPipelineState(data.createInfo_, &data.pipelineState_);
+                    pipelineStateStats_.creationTime_ += timer.GetUSec(false);
+                    entry = impl_->AddPipelineState(this, data);
                 }
-                pipelineStateCreateInfo.GraphicsPipeline.DSVFormat =
-                    impl_->depthStencilView_ ? impl_->depthStencilView_->GetDesc().Format : TEX_FORMAT_UNKNOWN;
-                pipelineStateCreateInfo.GraphicsPipeline.PrimitiveTopology = impl_->GetPrimitiveTopology();
 
-                IShader* vertexShader = (IShader*)vertexShader_->GetGPUObject();
-                IShader* pixelShader = (IShader*)pixelShader_->GetGPUObject();
-                pipelineStateCreateInfo.pVS = vertexShader;
-                pipelineStateCreateInfo.pPS = pipelineStateCreateInfo.GraphicsPipeline.NumRenderTargets > 0 ? pixelShader : nullptr;
+                pipelineStateStats_.live_ = impl_->numPipelineStates_;
+                pipelineStateStats_.capacity_ = impl_->pipelineStates_.Size();
+            }
 
-                pipelineStateCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+            if (!entry->pipelineState_)
+            {
+                // Pipeline state creation has failed, skip the draw. The state is looked up again on the next draw, which
+                // finds the failed entry without creating it again
+                impl_->currentPipelineState_ = nullptr;
+                impl_->vertexShaderDirty_ = true;
+                impl_->pipelineStatePending_ = true;
+                return;
+            }
 
-                PODVector<ShaderResourceVariableDesc> variableDescriptors;
-                for (uint32_t i = 0; i < vertexShader->GetResourceCount(); i++)
-                {
-                    ShaderResourceDesc srd;
-                    vertexShader->GetResourceDesc(i, srd);
-                    if (srd.Type == SHADER_RESOURCE_TYPE_TEXTURE_SRV)
-                    {
-                        variableDescriptors.Push(ShaderResourceVariableDesc(SHADER_TYPE_VERTEX, srd.Name,
-                                                                            SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC));
-                    }
-                }
+            pipelineState = entry->pipelineState_;
+            textureMap = entry->textureMap_;
 
-                for (uint32_t i = 0; i < pixelShader->GetResourceCount(); i++)
-                {
-                    ShaderResourceDesc srd;
-                    pixelShader->GetResourceDesc(i, srd);
-                    if (srd.Type == SHADER_RESOURCE_TYPE_TEXTURE_SRV)
-                    {
-                        variableDescriptors.Push(ShaderResourceVariableDesc(SHADER_TYPE_PIXEL, srd.Name,
-                                                                            SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC));
-                    }
-                }
-                pipelineStateCreateInfo.PSODesc.ResourceLayout.Variables = variableDescriptors.Size() > 0 ? &variableDescriptors[0] : nullptr;
-                pipelineStateCreateInfo.PSODesc.ResourceLayout.NumVariables = variableDescriptors.Size();
+            if (impl_->currentPipelineState_ != pipelineState)
+            {
+                pipelineStateChanged = true;
+                impl_->currentPipelineState_ = pipelineState;
+                impl_->currentTextureMap_ = textureMap;
+                impl_->currentBindingCache_ = entry->bindingCache_;
+                impl_->currentConstantBufferMap_ = entry->constantBufferMap_;
+            }
+        }
+    }
 
-                pipelineStateCreateInfo.PSODesc.ResourceLayout.ImmutableSamplers = nullptr;
-                pipelineStateCreateInfo.PSODesc.ResourceLayout.NumImmutableSamplers = 0;
+    assert(impl_->currentPipelineState_ != nullptr);
+    impl_->deviceContext_->SetPipelineState(impl_->currentPipelineState_);
 
-                PODVector<LayoutElement> layoutElements;
-                unsigned prevLayoutElementsCount = 0;
+    if (pipelineStateChanged || (impl_->texturesDirty_ && impl_->firstDirtyTexture_ < M_MAX_UNSIGNED))
+    {
+        // Switch to the binding cached for the texture set instead of rewriting the variables of a single binding
+        IShaderResourceBinding* shaderResourceBinding = impl_->PrepareShaderResourceBinding();
+        if (shaderResourceBinding && (pipelineStateChanged || shaderResourceBinding != impl_->currentShaderResourceBinding_))
+        {
+            impl_->currentShaderResourceBinding_ = shaderResourceBinding;
 
-                const bool isHlsl = (impl_->deviceType_ == RENDER_DEVICE_TYPE_D3D11) || (impl_->deviceType_ == RENDER_DEVICE_TYPE_D3D12);
+            // Resources were transitioned when the binding was prepared, so only verify their states in debug builds
+#ifdef _DEBUG
+            impl_->deviceContext_->CommitShaderResources(shaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+#else
+            impl_->deviceContext_->CommitShaderResources(shaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE_NONE);
+#endif
+        }
 
-                layoutElements.Reserve(MAX_VERTEX_STREAMS);
-                for (unsigned i = 0; i < MAX_VERTEX_STREAMS; ++i)
-                {
-                    if (!vertexBuffers_[i])
-                        continue;
+        impl_->firstDirtyTexture_ = impl_->lastDirtyTexture_ = M_MAX_UNSIGNED;
+        impl_->texturesDirty_ = false;
+    }
 
-                    const PODVector<VertexElement>& srcElements = vertexBuffers_[i]->GetElements();
-                    bool isExisting = false;
+    if (impl_->scissorRectDirty_)
+    {
+        Diligent::Rect rect;
+        rect.left = scissorRect_.left_;
+        rect.top = scissorRect_.top_;
+        rect.right = scissorRect_.right_;
+        rect.bottom = scissorRect_.bottom_;
+        impl_->deviceContext_->SetScissorRects(1, &rect, 0, 0);
+        impl_->scissorRectDirty_ = false;
+    }
 
-                    for (unsigned j = 0; j < srcElements.Size(); ++j)
-                    {
-                        const VertexElement& srcElement = srcElements[j];
-                        const char* semanticName = ShaderVariation::elementSemanticNames[srcElement.semantic_];
-                        Diligent::Uint32 semanticIndex = srcElement.index_;
-
-                        if (!isHlsl)
-                        {
-                            std::string fullSemanticName = std::string(semanticName) + std::to_string(semanticIndex);
-                            semanticIndex = ShaderVariation::semanticsToAttribs[fullSemanticName];
-                            semanticName = "ATTRIB";
-                        }
-
-                        // Override existing element if necessary
-                        for (unsigned k = 0; k < prevLayoutElementsCount; ++k)
-                        {
-                            if (layoutElements[k].HLSLSemantic == semanticName &&
-                                layoutElements[k].InputIndex == semanticIndex)
-                            {
-                                isExisting = true;
-                                layoutElements[k].BufferSlot = i;
-                                layoutElements[k].RelativeOffset = srcElement.offset_;
-                                layoutElements[k].Frequency = srcElement.perInstance_ ? INPUT_ELEMENT_FREQUENCY_PER_INSTANCE
-                                                                                      : INPUT_ELEMENT_FREQUENCY_PER_VERTEX;
-                                layoutElements[k].InstanceDataStepRate = srcElement.perInstance_ ? 1 : 0;
-                                break;
-                            }
-                        }
-
-                        if (isExisting)
-                            continue;
-
-                        LayoutElement newLayoutElement;
-                        newLayoutElement.HLSLSemantic = semanticName;
-                        newLayoutElement.InputIndex = semanticIndex;
-                        newLayoutElement.ValueType = diligentValueType[srcElement.type_];
-                        newLayoutElement.NumComponents = diligentNumComponents[srcElement.type_];
-                        newLayoutElement.IsNormalized = diligentIsNormalized[srcElement.type_];
-                        newLayoutElement.BufferSlot = (Uint32)i;
-                        newLayoutElement.RelativeOffset = srcElement.offset_;
-                        newLayoutElement.Frequency = srcElement.perInstance_ ? INPUT_ELEMENT_FREQUENCY_PER_INSTANCE
-                                                                             : INPUT_ELEMENT_FREQUENCY_PER_VERTEX;
-                        newLayoutElement.InstanceDataStepRate = srcElement.perInstance_ ? 1 : 0;
-                        layoutElements.Push(newLayoutElement);
-                    }
+    impl_->CommitConstantBuffers();
+}
 
-                    prevLayoutElementsCount = layoutElements.Size();
-                }
+void Graphics::FillPipelineStateCreateData(PipelineStateCreateData& data)
+{
+    if (!impl_->pipelineStateCacheLoaded_)
+        LoadPipelineStateCache();
 
-                pipelineStateCreateInfo.GraphicsPipeline.InputLayout.LayoutElements = layoutElements.Size() > 0 ? &layoutElements[0] : nullptr;
-                pipelineStateCreateInfo.GraphicsPipeline.InputLayout.NumElements = layoutElements.Size();
-
-                pipelineStateCreateInfo.GraphicsPipeline.BlendDesc.AlphaToCoverageEnable = alphaToCoverage_ ? true : false;
-                pipelineStateCreateInfo.GraphicsPipeline.BlendDesc.IndependentBlendEnable = false;
-                pipelineStateCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].BlendEnable = diligentBlendEnable[blendMode_];
-                pipelineStateCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].SrcBlend = diligentSrcBlend[blendMode_];
-                pipelineStateCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].DestBlend = diligentDestBlend[blendMode_];
-                pipelineStateCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].BlendOp = diligentBlendOp[blendMode_];
-                pipelineStateCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].SrcBlendAlpha = diligentSrcBlend[blendMode_];
-                pipelineStateCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].DestBlendAlpha = diligentDestBlend[blendMode_];
-                pipelineStateCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].BlendOpAlpha = diligentBlendOp[blendMode_];
-                pipelineStateCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].RenderTargetWriteMask = colorWrite_ ? COLOR_MASK_ALL : COLOR_MASK_NONE;
-
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = true;
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthWriteEnable = depthWrite_;
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthFunc = diligentCmpFunc[depthTestMode_];
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.StencilEnable = stencilTest_;
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.StencilReadMask = (Uint8)stencilCompareMask_;
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.StencilWriteMask = (Uint8)stencilWriteMask_;
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.FrontFace.StencilFailOp = diligentStencilOp[stencilFail_];
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.FrontFace.StencilDepthFailOp = diligentStencilOp[stencilZFail_];
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.FrontFace.StencilPassOp = diligentStencilOp[stencilPass_];
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.FrontFace.StencilFunc = diligentCmpFunc[stencilTestMode_];
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.BackFace.StencilFailOp = diligentStencilOp[stencilFail_];
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.BackFace.StencilDepthFailOp = diligentStencilOp[stencilZFail_];
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.BackFace.StencilPassOp = diligentStencilOp[stencilPass_];
-                pipelineStateCreateInfo.GraphicsPipeline.DepthStencilDesc.BackFace.StencilFunc = diligentCmpFunc[stencilTestMode_];
-
-                pipelineStateCreateInfo.GraphicsPipeline.RasterizerDesc.FillMode = diligentFillMode[fillMode_];
-                pipelineStateCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = diligentCullMode[cullMode_];
-                pipelineStateCreateInfo.GraphicsPipeline.RasterizerDesc.FrontCounterClockwise = false;
-                pipelineStateCreateInfo.GraphicsPipeline.RasterizerDesc.DepthBias = scaledDepthBias;
-                pipelineStateCreateInfo.GraphicsPipeline.RasterizerDesc.DepthBiasClamp = M_INFINITY;
-                pipelineStateCreateInfo.GraphicsPipeline.RasterizerDesc.SlopeScaledDepthBias = slopeScaledDepthBias_;
-                pipelineStateCreateInfo.GraphicsPipeline.RasterizerDesc.DepthClipEnable = true;
-                pipelineStateCreateInfo.GraphicsPipeline.RasterizerDesc.ScissorEnable = scissorTest_;
-                // TODO: Chack if MultisampleEnable is needed; in Diligent code MultisampleEnable is set to AntialiasedLineEnable
-                //pipelineStateCreateInfo.GraphicsPipeline.RasterizerDesc.MultisampleEnable = !lineAntiAlias_;
-                pipelineStateCreateInfo.GraphicsPipeline.RasterizerDesc.AntialiasedLineEnable = lineAntiAlias_;
-
-                impl_->device_->CreateGraphicsPipelineState(pipelineStateCreateInfo, &pipelineState);
-                assert(pipelineState != nullptr);
-
-                const unsigned* vsBufferSizes = vertexShader_->GetConstantBufferSizes();
-                const String* vsBufferNames = vertexShader_->GetConstantBufferNames();
-                for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS; ++i)
-                {
-                    if (vsBufferSizes[i] > 0 && !vsBufferNames[i].Empty())
-                    {
-                        pipelineState->GetStaticVariableByName(SHADER_TYPE_VERTEX, vsBufferNames[i].CString())
-                            ->Set((IBuffer*)impl_->shaderProgram_->vsConstantBuffers_[i]->GetGPUObject());
-                    }
-                }
+    ValidatePipelineStateCache(vertexShader_);
+    ValidatePipelineStateCache(pixelShader_);
 
-                if (pipelineStateCreateInfo.pPS)
-                {
-                    const unsigned* psBufferSizes = pixelShader_->GetConstantBufferSizes();
-                    const String* psBufferNames = pixelShader_->GetConstantBufferNames();
-                    for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS; ++i)
-                    {
-                        if (psBufferSizes[i] > 0 && !psBufferNames[i].Empty())
-                        {
-                            pipelineState->GetStaticVariableByName(SHADER_TYPE_PIXEL, psBufferNames[i].CString())
-                                ->Set((IBuffer*)impl_->shaderProgram_->psConstantBuffers_[i]->GetGPUObject());
-                        }
-                    }
-                }
+    data.device_ = impl_->device_;
+    data.pipelineStateCache_ = impl_->pipelineStateCache_;
+    data.vertexShaderVariation_ = vertexShader_;
+    data.pixelShaderVariation_ = pixelShader_;
 
-                pipelineState->CreateShaderResourceBinding(&shaderResourceBinding, true);
-                assert(shaderResourceBinding != nullptr);
+    unsigned depthBits = 24;
+    if (depthStencil_ && depthStencil_->GetParentTexture()->GetFormat() == DXGI_FORMAT_R16_TYPELESS)
+        depthBits = 16;
+    int scaledDepthBias = (int)(constantDepthBias_ * (1 << depthBits));
 
-                const Uint32 vertexShaderVariableCount = shaderResourceBinding->GetVariableCount(SHADER_TYPE_VERTEX);
-                const Uint32 pixelShaderVariableCount = shaderResourceBinding->GetVariableCount(SHADER_TYPE_PIXEL);
-                textureMap = std::make_shared<GraphicsImpl::PipelineState::TextureMap>();
-                textureMap->reserve(vertexShaderVariableCount + pixelShaderVariableCount);
+    data.createInfo_.pPSOCache = impl_->pipelineStateCache_;
+    data.createInfo_.PSODesc.Name = "";
+    data.createInfo_.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
+    if (impl_->renderTargetHash_ != 0)
+    {
+        unsigned renderTargetsCount = 0;
+        for (unsigned i = 0; i < MAX_RENDERTARGETS; i++)
+        {
+            if (impl_->renderTargetViews_[i])
+            {
+                data.createInfo_.GraphicsPipeline.RTVFormats[i] =
+                    impl_->renderTargetViews_[i]->GetDesc().Format;
+                renderTargetsCount = i + 1;
+            }
+            else
+            {
+                data.createInfo_.GraphicsPipeline.RTVFormats[i] = TEX_FORMAT_UNKNOWN;
+            }
+        }
+        data.createInfo_.GraphicsPipeline.NumRenderTargets = renderTargetsCount;
+    }
+    else
+    {
+        data.createInfo_.GraphicsPipeline.NumRenderTargets = 0;
+    }
+    data.createInfo_.GraphicsPipeline.DSVFormat =
+        impl_->depthStencilView_ ? impl_->depthStencilView_->GetDesc().Format : TEX_FORMAT_UNKNOWN;
+    data.createInfo_.GraphicsPipeline.PrimitiveTopology = impl_->GetPrimitiveTopology();
 
-                auto numberPostfix = [](const char* str)
-                {
-                    for (unsigned i = 0; str[i] != '\0'; ++i)
-                    {
-                        if (IsDigit(str[i]))
-                            return ToUInt(&str[i]);
-                    }
+    IShader* vertexShader = (IShader*)vertexShader_->GetGPUObject();
+    IShader* pixelShader = (IShader*)pixelShader_->GetGPUObject();
+    data.vertexShader_ = vertexShader;
+    data.pixelShader_ = pixelShader;
+    data.createInfo_.pVS = vertexShader;
+    data.createInfo_.pPS = data.createInfo_.GraphicsPipeline.NumRenderTargets > 0 ? pixelShader : nullptr;
 
-                    return M_MAX_UNSIGNED;
-                };
+    data.createInfo_.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
 
-                auto getTextureUnitFromVariable = [&](IShaderResourceVariable* variable)
-                {
-                    ShaderResourceDesc shaderResourceDesc;
-                    variable->GetResourceDesc(shaderResourceDesc);
+    for (uint32_t i = 0; i < vertexShader->GetResourceCount(); i++)
+    {
+        ShaderResourceDesc srd;
+        vertexShader->GetResourceDesc(i, srd);
+        if (srd.Type == SHADER_RESOURCE_TYPE_TEXTURE_SRV || srd.Type == SHADER_RESOURCE_TYPE_CONSTANT_BUFFER)
+        {
+            data.variables_.Push(ShaderResourceVariableDesc(SHADER_TYPE_VERTEX, srd.Name,
+                                                            SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE));
+        }
+    }
 
-                    const char* variableName =
-                        shaderResourceDesc.Name[0] == 't' ? &shaderResourceDesc.Name[1] : shaderResourceDesc.Name;
+    for (uint32_t i = 0; i < pixelShader->GetResourceCount(); i++)
+    {
+        ShaderResourceDesc srd;
+        pixelShader->GetResourceDesc(i, srd);
+        if (srd.Type == SHADER_RESOURCE_TYPE_TEXTURE_SRV || srd.Type == SHADER_RESOURCE_TYPE_CONSTANT_BUFFER)
+        {
+            data.variables_.Push(ShaderResourceVariableDesc(SHADER_TYPE_PIXEL, srd.Name,
+                                                           SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE));
+        }
+    }
+    data.createInfo_.PSODesc.ResourceLayout.Variables = data.variables_.Size() > 0 ? &data.variables_[0] : nullptr;
+    data.createInfo_.PSODesc.ResourceLayout.NumVariables = data.variables_.Size();
 
-                    unsigned textureUnit = GetTextureUnit(variableName);
-                    if (textureUnit >= MAX_TEXTURE_UNITS)
-                    {
-                        textureUnit = numberPostfix(variableName);
-                    }
+    data.createInfo_.PSODesc.ResourceLayout.ImmutableSamplers = nullptr;
+    data.createInfo_.PSODesc.ResourceLayout.NumImmutableSamplers = 0;
 
-                    return textureUnit;
-                };
+    unsigned prevLayoutElementsCount = 0;
 
-                for (Uint32 i = 0; i < vertexShaderVariableCount; i++)
-                {
-                    IShaderResourceVariable* variable = shaderResourceBinding->GetVariableByIndex(SHADER_TYPE_VERTEX, i);
-                    unsigned textureUnit = getTextureUnitFromVariable(variable);
+    const bool isHlsl = (impl_->deviceType_ == RENDER_DEVICE_TYPE_D3D11) || (impl_->deviceType_ == RENDER_DEVICE_TYPE_D3D12);
 
-                    if (textureUnit < MAX_TEXTURE_UNITS)
-                    {
-                        textureMap->push_back(GraphicsImpl::PipelineState::TextureMapEntry{textureUnit, variable});
-                    }
-                }
+    data.layoutElements_.Reserve(MAX_VERTEX_STREAMS);
+    for (unsigned i = 0; i < MAX_VERTEX_STREAMS; ++i)
+    {
+        if (!vertexBuffers_[i])
+            continue;
 
-                for (Uint32 i = 0; i < pixelShaderVariableCount; i++)
-                {
-                    IShaderResourceVariable* variable = shaderResourceBinding->GetVariableByIndex(SHADER_TYPE_PIXEL, i);
-                    unsigned textureUnit = getTextureUnitFromVariable(variable);
+        const PODVector<VertexElement>& srcElements = vertexBuffers_[i]->GetElements();
+        bool isExisting = false;
 
-                    if (textureUnit < MAX_TEXTURE_UNITS)
-                    {
-                        textureMap->push_back(GraphicsImpl::PipelineState::TextureMapEntry{textureUnit, variable});
-                    }
-                }
+        for (unsigned j = 0; j < srcElements.Size(); ++j)
+        {
+            const VertexElement& srcElement = srcElements[j];
+            const char* semanticName = ShaderVariation::elementSemanticNames[srcElement.semantic_];
+            Diligent::Uint32 semanticIndex = srcElement.index_;
 
-                impl_->pipelineStates_[pipelineKey] = GraphicsImpl::PipelineState{
-                    pipelineState, shaderResourceBinding, textureMap};
-            }
-            else
+            if (!isHlsl)
             {
-                pipelineState = iterator->second.pipelineState_;
-                shaderResourceBinding = iterator->second.shaderResourceBinding_;
-                textureMap = iterator->second.textureMap_;
+                std::string fullSemanticName = std::string(semanticName) + std::to_string(semanticIndex);
+                semanticIndex = ShaderVariation::semanticsToAttribs[fullSemanticName];
+                semanticName = "ATTRIB";
             }
 
-            if (impl_->currentPipelineState_ != pipelineState)
+            // Override existing element if necessary
+            for (unsigned k = 0; k < prevLayoutElementsCount; ++k)
             {
-                pipelineStateChanged = true;
-                impl_->currentPipelineState_ = pipelineState;
-                impl_->currentShaderResourceBinding_ = shaderResourceBinding;
-                impl_->currentTextureMap_ = textureMap;
+                if (data.layoutElements_[k].HLSLSemantic == semanticName &&
+                    data.layoutElements_[k].InputIndex == semanticIndex)
+                {
+                    isExisting = true;
+                    data.layoutElements_[k].BufferSlot = i;
+                    data.layoutElements_[k].RelativeOffset = srcElement.offset_;
+                    data.layoutElements_[k].Frequency = srcElement.perInstance_ ? INPUT_ELEMENT_FREQUENCY_PER_INSTANCE
+                                                                          : INPUT_ELEMENT_FREQUENCY_PER_VERTEX;
+                    data.layoutElements_[k].InstanceDataStepRate = srcElement.perInstance_ ? 1 : 0;
+                    break;
+                }
             }
+
+            if (isExisting)
+                continue;
+
+            LayoutElement newLayoutElement;
+            newLayoutElement.HLSLSemantic = semanticName;
+            newLayoutElement.InputIndex = semanticIndex;
+            newLayoutElement.ValueType = diligentValueType[srcElement.type_];
+            newLayoutElement.NumComponents = diligentNumComponents[srcElement.type_];
+            newLayoutElement.IsNormalized = diligentIsNormalized[srcElement.type_];
+            newLayoutElement.BufferSlot = (Uint32)i;
+            newLayoutElement.RelativeOffset = srcElement.offset_;
+            newLayoutElement.Frequency = srcElement.perInstance_ ? INPUT_ELEMENT_FREQUENCY_PER_INSTANCE
+                                                                 : INPUT_ELEMENT_FREQUENCY_PER_VERTEX;
+            newLayoutElement.InstanceDataStepRate = srcElement.perInstance_ ? 1 : 0;
+            data.layoutElements_.Push(newLayoutElement);
         }
+
+        prevLayoutElementsCount = data.layoutElements_.Size();
     }
 
-    assert(impl_->currentPipelineState_ != nullptr);
-    impl_->deviceContext_->SetPipelineState(impl_->currentPipelineState_);
+    data.createInfo_.GraphicsPipeline.InputLayout.LayoutElements = data.layoutElements_.Size() > 0 ? &data.layoutElements_[0] : nullptr;
+    data.createInfo_.GraphicsPipeline.InputLayout.NumElements = data.layoutElements_.Size();
+
+    data.createInfo_.GraphicsPipeline.BlendDesc.AlphaToCoverageEnable = alphaToCoverage_ ? true : false;
+    data.createInfo_.GraphicsPipeline.BlendDesc.IndependentBlendEnable = false;
+    data.createInfo_.GraphicsPipeline.BlendDesc.RenderTargets[0].BlendEnable = diligentBlendEnable[blendMode_];
+    data.createInfo_.GraphicsPipeline.BlendDesc.RenderTargets[0].SrcBlend = diligentSrcBlend[blendMode_];
+    data.createInfo_.GraphicsPipeline.BlendDesc.RenderTargets[0].DestBlend = diligentDestBlend[blendMode_];
+    data.createInfo_.GraphicsPipeline.BlendDesc.RenderTargets[0].BlendOp = diligentBlendOp[blendMode_];
+    data.createInfo_.GraphicsPipeline.BlendDesc.RenderTargets[0].SrcBlendAlpha = diligentSrcBlend[blendMode_];
+    data.createInfo_.GraphicsPipeline.BlendDesc.RenderTargets[0].DestBlendAlpha = diligentDestBlend[blendMode_];
+    data.createInfo_.GraphicsPipeline.BlendDesc.RenderTargets[0].BlendOpAlpha = diligentBlendOp[blendMode_];
+    data.createInfo_.GraphicsPipeline.BlendDesc.RenderTargets[0].RenderTargetWriteMask = colorWrite_ ? COLOR_MASK_ALL : COLOR_MASK_NONE;
+
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.DepthEnable = true;
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.DepthWriteEnable = depthWrite_;
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.DepthFunc = diligentCmpFunc[depthTestMode_];
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.StencilEnable = stencilTest_;
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.StencilReadMask = (Uint8)stencilCompareMask_;
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.StencilWriteMask = (Uint8)stencilWriteMask_;
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.FrontFace.StencilFailOp = diligentStencilOp[stencilFail_];
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.FrontFace.StencilDepthFailOp = diligentStencilOp[stencilZFail_];
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.FrontFace.StencilPassOp = diligentStencilOp[stencilPass_];
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.FrontFace.StencilFunc = diligentCmpFunc[stencilTestMode_];
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.BackFace.StencilFailOp = diligentStencilOp[stencilFail_];
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.BackFace.StencilDepthFailOp = diligentStencilOp[stencilZFail_];
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.BackFace.StencilPassOp = diligentStencilOp[stencilPass_];
+    data.createInfo_.GraphicsPipeline.DepthStencilDesc.BackFace.StencilFunc = diligentCmpFunc[stencilTestMode_];
+
+    data.createInfo_.GraphicsPipeline.RasterizerDesc.FillMode = diligentFillMode[fillMode_];
+    data.createInfo_.GraphicsPipeline.RasterizerDesc.CullMode = diligentCullMode[cullMode_];
+    data.createInfo_.GraphicsPipeline.RasterizerDesc.FrontCounterClockwise = false;
+    data.createInfo_.GraphicsPipeline.RasterizerDesc.DepthBias = scaledDepthBias;
+    data.createInfo_.GraphicsPipeline.RasterizerDesc.DepthBiasClamp = M_INFINITY;
+    data.createInfo_.GraphicsPipeline.RasterizerDesc.SlopeScaledDepthBias = slopeScaledDepthBias_;
+    data.createInfo_.GraphicsPipeline.RasterizerDesc.DepthClipEnable = true;
+    data.createInfo_.GraphicsPipeline.RasterizerDesc.ScissorEnable = scissorTest_;
+    data.createInfo_.GraphicsPipeline.RasterizerDesc.AntialiasedLineEnable = lineAntiAlias_;
+}
 
-    bool bindingChanged = false;
-    if (pipelineStateChanged || (impl_->texturesDirty_ && impl_->firstDirtyTexture_ < M_MAX_UNSIGNED))
+void Graphics::UpdatePendingPipelineStates(bool wait)
+{
+    if (impl_->pendingPipelineStates_.empty())
+        return;
+
+    auto* workQueue = GetSubsystem<WorkQueue>();
+
+    for (auto i = impl_->pendingPipelineStates_.begin(); i != impl_->pendingPipelineStates_.end();)
     {
-        if (impl_->currentTextureMap_)
+        PipelineStateCreateData& data = *i->second;
+        if (!data.workItem_->completed_)
         {
-            const auto& textureMap = *impl_->currentTextureMap_.get();
+            if (!wait)
+            {
+                ++i;
+                continue;
+            }
 
-            for (const auto& textureMapEntry : textureMap)
+            // Cancel if not started yet, otherwise wait for the worker thread to finish
+            if (workQueue && workQueue->RemoveWorkItem(data.workItem_))
             {
-                if ((pipelineStateChanged || (textureMapEntry.textureUnit >= impl_->firstDirtyTexture_ &&
-                     textureMapEntry.textureUnit <= impl_->lastDirtyTexture_)) &&
-                    impl_->shaderResourceViews_[textureMapEntry.textureUnit])
-                {
-                    impl_->shaderResourceViews_[textureMapEntry.textureUnit]->SetSampler(
-                        impl_->samplers_[textureMapEntry.textureUnit]);
-                    textureMapEntry.variable->Set(impl_->shaderResourceViews_[textureMapEntry.textureUnit]);
+                i = impl_->pendingPipelineStates_.erase(i);
+                continue;
+            }
+            if (workQueue)
+                workQueue->Wait(data.workItem_);
+        }
 
-                    bindingChanged = true;
-                }
+        if (data.workItem_->completed_)
+        {
+            pipelineStateStats_.creationTime_ += data.creationTime_;
+            // May already exist if it was created synchronously because of a key collision
+            if (!impl_->FindPipelineState(i->first, data.desc_))
+                impl_->AddPipelineState(this, data);
+        }
+        i = impl_->pendingPipelineStates_.erase(i);
+    }
+
+    pipelineStateStats_.live_ = impl_->numPipelineStates_;
+    pipelineStateStats_.capacity_ = impl_->pipelineStates_.Size();
+}
+
+void Graphics::LoadPipelineStateCache()
+{
+    impl_->pipelineStateCacheLoaded_ = true;
+    impl_->pipelineStateCacheShaders_.Clear();
+
+    if (!impl_->device_)
+        return;
+
+    PODVector<unsigned char> cacheData;
+
+    const String fileName = GetPipelineStateCacheFileName(shaderCacheDir_, impl_->deviceType_);
+    FileSystem* fileSystem = GetSubsystem<FileSystem>();
+    if (!shaderCacheDir_.Empty() && fileSystem && fileSystem->FileExists(fileName))
+    {
+        File file(context_, fileName);
+        if (!file.IsOpen() || file.ReadFileID() != "UPSC")
+            URHO3D_LOGWARNING(fileName + " is not a valid pipeline state cache file");
+        else if (file.ReadUInt() != PIPELINE_STATE_CACHE_VERSION || file.ReadUInt() != GetAdapterHash(impl_->device_))
+        {
+            // Adapter, driver interface or file layout changed, the cached pipelines can not be reused
+            URHO3D_LOGDEBUG("Discarding stale pipeline state cache " + fileName);
+        }
+        else
+        {
+            unsigned numShaders = file.ReadUInt();
+            for (unsigned i = 0; i < numShaders && !file.IsEof(); ++i)
+            {
+                StringHash key = file.ReadStringHash();
+                impl_->pipelineStateCacheShaders_[key] = file.ReadUInt();
             }
+            cacheData = file.ReadBuffer();
+
+            URHO3D_LOGDEBUG("Loaded pipeline state cache " + fileName);
         }
+    }
 
-        impl_->firstDirtyTexture_ = impl_->lastDirtyTexture_ = M_MAX_UNSIGNED;
-        impl_->texturesDirty_ = false;
+    PipelineStateCacheCreateInfo cacheCreateInfo;
+    cacheCreateInfo.Desc.Name = "Urho3D pipeline state cache";
+    cacheCreateInfo.Desc.Mode = PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE;
+    cacheCreateInfo.pCacheData = cacheData.Size() ? &cacheData[0] : nullptr;
+    cacheCreateInfo.CacheDataSize = cacheData.Size();
+
+    impl_->pipelineStateCache_ = nullptr;
+    impl_->device_->CreatePipelineStateCache(cacheCreateInfo, &impl_->pipelineStateCache_);
+
+    // Creation from data rejected by the driver fails, retry with an empty cache
+    if (!impl_->pipelineStateCache_ && cacheData.Size())
+    {
+        impl_->pipelineStateCacheShaders_.Clear();
+        cacheCreateInfo.pCacheData = nullptr;
+        cacheCreateInfo.CacheDataSize = 0;
+        impl_->device_->CreatePipelineStateCache(cacheCreateInfo, &impl_->pipelineStateCache_);
     }
 
-    if (pipelineStateChanged || bindingChanged)
+    impl_->pipelineStateCacheDirty_ = false;
+}
+
+void Graphics::SavePipelineStateCache()
+{
+    if (!impl_->pipelineStateCache_ || !impl_->pipelineStateCacheDirty_ || shaderCacheDir_.Empty())
+        return;
+
+    RefCntAutoPtr<IDataBlob> cacheData;
+    impl_->pipelineStateCache_->GetData(&cacheData);
+    if (!cacheData || !cacheData->GetSize())
+        return;
+
+    FileSystem* fileSystem = GetSubsystem<FileSystem>();
+    if (fileSystem && !fileSystem->DirExists(shaderCacheDir_))
+        fileSystem->CreateDir(shaderCacheDir_);
+
+    const String fileName = GetPipelineStateCacheFileName(shaderCacheDir_, impl_->deviceType_);
+    File file(context_, fileName, FILE_WRITE);
+    if (!file.IsOpen())
+        return;
+
+    file.WriteFileID("UPSC");
+    file.WriteUInt(PIPELINE_STATE_CACHE_VERSION);
+    file.WriteUInt(GetAdapterHash(impl_->device_));
+
+    file.WriteUInt(impl_->pipelineStateCacheShaders_.Size());
+    for (HashMap<StringHash, unsigned>::ConstIterator i = impl_->pipelineStateCacheShaders_.Begin();
+         i != impl_->pipelineStateCacheShaders_.End(); ++i)
     {
-        assert(impl_->currentShaderResourceBinding_);
-        impl_->deviceContext_->CommitShaderResources(impl_->currentShaderResourceBinding_,
-                                                     RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        file.WriteStringHash(i->first_);
+        file.WriteUInt(i->second_);
     }
 
-    if (impl_->scissorRectDirty_)
+    file.WriteVLE((unsigned)cacheData->GetSize());
+    file.Write(cacheData->GetConstDataPtr(), (unsigned)cacheData->GetSize());
+
+    impl_->pipelineStateCacheDirty_ = false;
+
+    URHO3D_LOGDEBUG("Saved pipeline state cache " + fileName);
+}
+
+void Graphics::ValidatePipelineStateCache(ShaderVariation* variation)
+{
+    if (!impl_->pipelineStateCache_)
+        return;
+
+    const StringHash key = GetPipelineStateCacheShaderKey(variation);
+    const unsigned byteCodeHash = GetShaderByteCodeHash(variation);
+
+    HashMap<StringHash, unsigned>::Iterator i = impl_->pipelineStateCacheShaders_.Find(key);
+    if (i == impl_->pipelineStateCacheShaders_.End())
     {
-        Diligent::Rect rect;
-        rect.left = scissorRect_.left_;
-        rect.top = scissorRect_.top_;
-        rect.right = scissorRect_.right_;
-        rect.bottom = scissorRect_.bottom_;
-        impl_->deviceContext_->SetScissorRects(1, &rect, 0, 0);
-        impl_->scissorRectDirty_ = false;
+        impl_->pipelineStateCacheShaders_[key] = byteCodeHash;
+        return;
     }
 
-    for (unsigned i = 0; i < impl_->dirtyConstantBuffers_.Size(); ++i)
-        impl_->dirtyConstantBuffers_[i]->Apply();
-    impl_->dirtyConstantBuffers_.Clear();
+    if (i->second_ == byteCodeHash)
+        return;
+
+    // The shader source has changed since the cache was written. The old pipelines will never be matched again, so start
+    // over with an empty cache instead of carrying the stale entries forward indefinitely
+    URHO3D_LOGDEBUG("Shader " + variation->GetFullName() + " bytecode changed, discarding pipeline state cache");
+
+    impl_->pipelineStateCacheShaders_.Clear();
+    impl_->pipelineStateCacheShaders_[key] = byteCodeHash;
+    impl_->pipelineStateCache_ = nullptr;
+
+    PipelineStateCacheCreateInfo cacheCreateInfo;
+    cacheCreateInfo.Desc.Name = "Urho3D pipeline state cache";
+    cacheCreateInfo.Desc.Mode = PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE;
+    impl_->device_->CreatePipelineStateCache(cacheCreateInfo, &impl_->pipelineStateCache_);
+    impl_->pipelineStateCacheDirty_ = true;
 }
 
 void Graphics::CreateResolveTexture()
@@ -2982,6 +4275,82 @@ void Graphics::CreateResolveTexture()
     }
 }
 
+void Graphics::UpdateReadbacks()
+{
+    // The fence values increase in request order, so readbacks complete in order
+    while (!impl_->pendingReadbacks_.Empty() && impl_->IsReadbackComplete(impl_->pendingReadbacks_.Front().fenceValue_))
+    {
+        GraphicsImpl::PendingReadback readback = impl_->pendingReadbacks_.Front();
+        impl_->pendingReadbacks_.Erase(0);
+
+        SharedPtr<Image> image(new Image(context_));
+        bool success;
+        if (readback.screenShot_)
+            success = ReadScreenShot(impl_, readback.stagingTexture_, *image);
+        else
+        {
+            const TextureDesc& desc = readback.stagingTexture_->GetDesc();
+            image->SetSize(desc.Width, desc.Height, 4);
+            success = impl_->ReadStagingTexture(readback.stagingTexture_, image->GetData(), desc.Width * 4, desc.Height);
+        }
+
+        using namespace ReadbackComplete;
+
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_ID] = readback.id_;
+        eventData[P_TEXTURE] = readback.texture_.Get();
+        eventData[P_LEVEL] = readback.level_;
+        eventData[P_IMAGE] = success ? image.Get() : nullptr;
+        SendEvent(E_READBACKCOMPLETE, eventData);
+    }
+}
+
+void Graphics::UpdateInternalGPUMemory()
+{
+    GPUMemoryStats stats[MAX_GPU_MEMORY_CATEGORIES];
+    impl_->CollectInternalGPUMemory(stats);
+
+    for (unsigned i = 0; i < MAX_GPU_MEMORY_CATEGORIES; ++i)
+    {
+        GPUMemoryStats& previous = internalGPUMemoryStats_[i];
+        if (stats[i].count_ == previous.count_ && stats[i].use_ == previous.use_)
+            continue;
+
+        MutexLock lock(gpuObjectMutex_);
+        GPUMemoryStats& total = gpuMemoryStats_[i];
+        total.count_ = total.count_ - previous.count_ + stats[i].count_;
+        total.use_ = total.use_ - previous.use_ + stats[i].use_;
+        total.peak_ = Max(total.peak_, total.use_);
+        gpuMemoryUse_ = gpuMemoryUse_ - previous.use_ + stats[i].use_;
+        gpuMemoryPeak_ = Max(gpuMemoryPeak_, gpuMemoryUse_);
+        previous = stats[i];
+    }
+}
+
+void Graphics::UpdateGPUTimings()
+{
+    if (!impl_->ResolveGPUTimings(gpuTimings_))
+        return;
+
+#ifdef URHO3D_PROFILING
+    if (auto* profiler = GetSubsystem<Profiler>())
+    {
+        for (unsigned i = 0; i < gpuTimings_.Size(); ++i)
+            profiler->AddGPUTime(gpuTimings_[i].name_.CString(), gpuTimings_[i].depth_, gpuTimings_[i].time_);
+    }
+#endif
+
+#ifdef URHO3D_TRACY_PROFILING
+    // Tracy keeps the plot name pointers, so the names are stored for the lifetime of the process
+    static HashSet<String> plotNames;
+    for (unsigned i = 0; i < gpuTimings_.Size(); ++i)
+    {
+        const String& plotName = *plotNames.Insert("GPU " + gpuTimings_[i].name_);
+        TracyPlot(plotName.CString(), gpuTimings_[i].time_ / 1000.0);
+    }
+#endif
+}
+
 void Graphics::SetTextureUnitMappings()
 {
     textureUnits_["DiffMap"] = TU_DIFFUSE;
@@ -22,8 +22,15 @@
 
 #include "../../Precompiled.h"
 
+#include "../../Core/Profiler.h"
+#include "../../Core/Timer.h"
 #include "../../Graphics/Graphics.h"
 #include "../../Graphics/GraphicsImpl.h"
+#include "../../Graphics/Material.h"
+#include "../../Graphics/ShaderProgram.h"
+#include "../../Graphics/Texture2D.h"
+#include "../../Math/Matrix3x4.h"
+#include "../../IO/Log.h"
 
 #include "../../DebugNew.h"
 
@@ -32,6 +39,79 @@ using namespace Diligent;
 namespace Urho3D
 {
 
+/// Maximum number of texture set specific shader resource bindings cached per pipeline state.
+static const unsigned MAX_BINDINGS_PER_PIPELINE_STATE = 64;
+/// Size of the dynamic buffer constant data is sub-allocated from. It is discarded at least once per frame.
+static const unsigned CONSTANT_RING_BUFFER_SIZE = 1024 * 1024;
+/// Initial number of slots in the pipeline state table.
+static const unsigned MIN_PIPELINE_STATE_SLOTS = 256;
+/// Size of the staging buffer static data is uploaded through on D3D12 and Vulkan.
+static const unsigned UPLOAD_RING_BUFFER_SIZE = 16 * 1024 * 1024;
+/// Byte offset alignment of upload ring buffer regions, as required for texture copies on D3D12.
+static const unsigned UPLOAD_RING_OFFSET_ALIGNMENT = 512;
+/// Row pitch alignment of texture data in the upload ring buffer, as required for texture copies on D3D12.
+static const unsigned UPLOAD_RING_ROW_ALIGNMENT = 256;
+
+PresentThread::PresentThread(GraphicsImpl* impl) :
+    impl_(impl)
+{
+    // The main thread keeps the idle mutex while it has no frame queued
+    idleMutex_.Acquire();
+}
+
+PresentThread::~PresentThread()
+{
+    Wait();
+
+    // Let the thread see the stop request
+    shouldRun_ = false;
+    idleMutex_.Release();
+    Stop();
+}
+
+void PresentThread::Present(unsigned syncInterval)
+{
+    Wait();
+
+    syncInterval_ = syncInterval;
+    pending_ = true;
+    numQueued_.fetch_add(1, std::memory_order_release);
+    idleMutex_.Release();
+}
+
+void PresentThread::Wait()
+{
+    if (!pending_)
+        return;
+
+    while (numPresented_.load(std::memory_order_acquire) != numQueued_.load(std::memory_order_relaxed))
+        Time::Sleep(0);
+
+    idleMutex_.Acquire();
+    pending_ = false;
+}
+
+void PresentThread::ThreadFunction()
+{
+    URHO3D_PROFILE_THREAD("PresentThread");
+
+    while (shouldRun_)
+    {
+        if (numPresented_.load(std::memory_order_relaxed) != numQueued_.load(std::memory_order_acquire))
+        {
+            impl_->PresentFrame(syncInterval_);
+            numPresented_.fetch_add(1, std::memory_order_release);
+        }
+        else
+        {
+            // Block here while no frame is queued
+            idleMutex_.Acquire();
+            idleMutex_.Release();
+            Time::Sleep(0);
+        }
+    }
+}
+
 GraphicsImpl::GraphicsImpl()
 {
     for (unsigned i = 0; i < MAX_RENDERTARGETS; ++i)
@@ -54,9 +134,1323 @@ GraphicsImpl::GraphicsImpl()
     {
         constantBuffers_[VS][i] = nullptr;
         constantBuffers_[PS][i] = nullptr;
+        constantOffsets_[VS][i] = M_MAX_UNSIGNED;
+        constantOffsets_[PS][i] = M_MAX_UNSIGNED;
+    }
+}
+
+IShaderResourceBinding* GraphicsImpl::PrepareShaderResourceBinding()
+{
+    if (!currentTextureMap_ || !currentBindingCache_ || !currentConstantBufferMap_)
+        return nullptr;
+
+    const PipelineState::TextureMap& textureMap = *currentTextureMap_;
+    PipelineState::BindingCache& bindingCache = *currentBindingCache_;
+
+    // The sampler is captured along with the view when a variable is set, so it is part of the texture set
+    unsigned textureSetHash = 0;
+    for (const auto& entry : textureMap)
+    {
+        if (entry.textureUnit == BINDLESS_TEXTURE_UNIT)
+        {
+            CombineHash(textureSetHash, bindlessTexturesHash_);
+            continue;
+        }
+        if (entry.textureUnit >= CLUSTER_BUFFER_UNIT)
+        {
+            CombineHash(textureSetHash, MakeHash((void*)clusterBufferViews_[entry.textureUnit - CLUSTER_BUFFER_UNIT]));
+            continue;
+        }
+        CombineHash(textureSetHash, MakeHash((void*)shaderResourceViews_[entry.textureUnit]));
+        CombineHash(textureSetHash, MakeHash((void*)samplers_[entry.textureUnit]));
+    }
+
+    PipelineState::BindingCache::Iterator i = bindingCache.Find(textureSetHash);
+    bool populate = i == bindingCache.End();
+    if (populate)
+    {
+        // Limit the cache size, as the cached bindings keep their textures alive
+        if (bindingCache.Size() >= MAX_BINDINGS_PER_PIPELINE_STATE)
+            bindingCache.Clear();
+
+        i = bindingCache.Insert(MakePair(textureSetHash, PipelineState::BindingCacheEntry()));
+        i->second_.views_.Resize(textureMap.size());
+        i->second_.samplers_.Resize(textureMap.size());
+    }
+    else
+    {
+        for (unsigned j = 0; j < textureMap.size(); ++j)
+        {
+            const unsigned textureUnit = textureMap[j].textureUnit;
+            if (textureUnit == BINDLESS_TEXTURE_UNIT)
+            {
+                if (i->second_.bindlessHash_ != bindlessTexturesHash_)
+                {
+                    populate = true;
+                    break;
+                }
+            }
+            else if (textureUnit >= CLUSTER_BUFFER_UNIT)
+            {
+                if (i->second_.clusterBufferViews_[textureUnit - CLUSTER_BUFFER_UNIT] != clusterBufferViews_[textureUnit - CLUSTER_BUFFER_UNIT])
+                {
+                    populate = true;
+                    break;
+                }
+            }
+            else if (i->second_.views_[j] != shaderResourceViews_[textureUnit] || i->second_.samplers_[j] != samplers_[textureUnit])
+            {
+                populate = true;
+                break;
+            }
+        }
+    }
+
+    PipelineState::BindingCacheEntry& entry = i->second_;
+    if (populate)
+    {
+        // On hash collision replace the binding instead of rewriting it, as it may still be in use by the GPU
+        entry.binding_.Release();
+        currentPipelineState_->CreateShaderResourceBinding(&entry.binding_, true);
+        if (!entry.binding_)
+            return nullptr;
+
+        // Constant data is addressed with dynamic offsets into the same ring buffer range
+        for (const auto& constantBufferEntry : *currentConstantBufferMap_)
+        {
+            entry.binding_->GetVariableByIndex(constantBufferEntry.variableShaderType, constantBufferEntry.variableIndex)
+                ->SetBufferRange(constantRingBuffer_, 0, constantBufferEntry.rangeSize);
+        }
+    }
+    if (!entry.binding_)
+        return nullptr;
+
+    textureTransitions_.Clear();
+    for (unsigned j = 0; j < textureMap.size(); ++j)
+    {
+        const unsigned textureUnit = textureMap[j].textureUnit;
+        if (textureUnit == BINDLESS_TEXTURE_UNIT)
+        {
+            if (bindlessViews_.Empty())
+                continue;
+
+            if (populate)
+            {
+                entry.bindlessHash_ = bindlessTexturesHash_;
+
+                // Every element of the array must be bound, so repeat the first texture in the unused ones
+                bindlessObjects_.Resize(MAX_BINDLESS_TEXTURES);
+                for (unsigned k = 0; k < MAX_BINDLESS_TEXTURES; ++k)
+                    bindlessObjects_[k] = k < bindlessViews_.Size() ? bindlessViews_[k] : bindlessViews_[0];
+                entry.binding_->GetVariableByIndex(textureMap[j].shaderType, textureMap[j].variableIndex)
+                    ->SetArray(&bindlessObjects_[0], 0, MAX_BINDLESS_TEXTURES);
+            }
+
+            for (unsigned k = 0; k < bindlessViews_.Size(); ++k)
+                AddShaderResourceTransition(bindlessViews_[k]);
+            continue;
+        }
+
+        // Clustered lighting buffers are transitioned for shader access when updated
+        if (textureUnit >= CLUSTER_BUFFER_UNIT)
+        {
+            IBufferView* bufferView = clusterBufferViews_[textureUnit - CLUSTER_BUFFER_UNIT];
+            if (populate)
+            {
+                entry.clusterBufferViews_[textureUnit - CLUSTER_BUFFER_UNIT] = bufferView;
+                if (bufferView)
+                    entry.binding_->GetVariableByIndex(textureMap[j].shaderType, textureMap[j].variableIndex)->Set(bufferView);
+            }
+            continue;
+        }
+
+        ITextureView* view = shaderResourceViews_[textureUnit];
+        if (populate)
+        {
+            entry.views_[j] = view;
+            entry.samplers_[j] = samplers_[textureUnit];
+        }
+        if (!view)
+            continue;
+
+        if (populate)
+        {
+            view->SetSampler(samplers_[textureUnit]);
+            entry.binding_->GetVariableByIndex(textureMap[j].shaderType, textureMap[j].variableIndex)->Set(view);
+        }
+
+        AddShaderResourceTransition(view);
+    }
+
+    if (!textureTransitions_.Empty())
+        deviceContext_->TransitionResourceStates(textureTransitions_.Size(), &textureTransitions_[0]);
+
+    return entry.binding_;
+}
+
+void GraphicsImpl::AddShaderResourceTransition(ITextureView* view)
+{
+    // Textures are normally already readable; those last rendered to or updated need an explicit transition
+    ITexture* texture = view->GetTexture();
+    const RESOURCE_STATE state = texture->GetState();
+    if (state != RESOURCE_STATE_UNKNOWN && (state & RESOURCE_STATE_SHADER_RESOURCE) == 0)
+    {
+        // Keep a read-only depth stencil readable by the depth test at the same time
+        const RESOURCE_STATE newState = (state & RESOURCE_STATE_DEPTH_READ)
+            ? RESOURCE_STATE_DEPTH_READ | RESOURCE_STATE_SHADER_RESOURCE : RESOURCE_STATE_SHADER_RESOURCE;
+        textureTransitions_.Push(StateTransitionDesc(texture, RESOURCE_STATE_UNKNOWN, newState,
+                                                     STATE_TRANSITION_FLAG_UPDATE_STATE));
+    }
+}
+
+bool GraphicsImpl::UpdateClusterBuffer(unsigned index, const void* data, unsigned size, unsigned stride)
+{
+    WaitForPresent();
+
+    RefCntAutoPtr<IBuffer>& buffer = clusterBuffers_[index];
+
+    // Grow in powers of two so that the buffers and the bindings referring to them are rarely recreated
+    if (!buffer || buffer->GetDesc().Size < size)
+    {
+        BufferDesc bufferDesc;
+        bufferDesc.Name = CLUSTER_BUFFER_VARIABLES[index];
+        bufferDesc.Size = NextPowerOfTwo(Max(size, stride * 64));
+        bufferDesc.Usage = USAGE_DEFAULT;
+        bufferDesc.BindFlags = BIND_SHADER_RESOURCE;
+        bufferDesc.Mode = BUFFER_MODE_STRUCTURED;
+        bufferDesc.ElementByteStride = stride;
+
+        clusterBufferViews_[index] = nullptr;
+        buffer.Release();
+        device_->CreateBuffer(bufferDesc, nullptr, &buffer);
+        if (!buffer)
+        {
+            URHO3D_LOGERROR("Failed to create clustered lighting buffer");
+            return false;
+        }
+
+        clusterBufferViews_[index] = buffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE);
+    }
+
+    if (size)
+        deviceContext_->UpdateBuffer(buffer, 0, size, data, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    StateTransitionDesc transition(buffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    deviceContext_->TransitionResourceStates(1, &transition);
+    return true;
+}
+
+bool GraphicsImpl::CreateComputePipeline(ComputePipeline& pipeline, const char* name, const String& source,
+    const char* constantsName, unsigned constantsSize, Uint64 immediateContextMask)
+{
+    if (source.Empty())
+    {
+        URHO3D_LOGERROR("Missing source of compute shader " + String(name));
+        pipeline.failed_ = true;
+        return false;
+    }
+
+    ShaderCreateInfo shaderCI;
+    shaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    shaderCI.HLSLVersion = {5, 0};
+    shaderCI.Desc.Name = name;
+    shaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    shaderCI.EntryPoint = "CS";
+    shaderCI.Source = source.CString();
+    shaderCI.SourceLength = source.Length();
+
+    RefCntAutoPtr<IShader> shader;
+    device_->CreateShader(shaderCI, &shader);
+    if (!shader)
+    {
+        URHO3D_LOGERROR("Failed to compile compute shader " + String(name));
+        pipeline.failed_ = true;
+        return false;
+    }
+
+    // The buffers change between dispatches, so all variables are dynamic
+    ComputePipelineStateCreateInfo pipelineCI;
+    pipelineCI.PSODesc.Name = name;
+    pipelineCI.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    pipelineCI.PSODesc.ImmediateContextMask = immediateContextMask;
+    pipelineCI.pCS = shader;
+
+    device_->CreateComputePipelineState(pipelineCI, &pipeline.pipeline_);
+    if (pipeline.pipeline_)
+        pipeline.pipeline_->CreateShaderResourceBinding(&pipeline.binding_, true);
+
+    BufferDesc bufferDesc;
+    bufferDesc.Name = constantsName;
+    bufferDesc.Size = constantsSize;
+    bufferDesc.Usage = USAGE_DYNAMIC;
+    bufferDesc.BindFlags = BIND_UNIFORM_BUFFER;
+    bufferDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    bufferDesc.ImmediateContextMask = immediateContextMask;
+    device_->CreateBuffer(bufferDesc, nullptr, &pipeline.constants_);
+
+    if (!pipeline.pipeline_ || !pipeline.binding_ || !pipeline.constants_)
+    {
+        URHO3D_LOGERROR("Failed to create compute pipeline " + String(name));
+        pipeline.pipeline_.Release();
+        pipeline.binding_.Release();
+        pipeline.constants_.Release();
+        pipeline.failed_ = true;
+        return false;
+    }
+
+    if (IShaderResourceVariable* variable = pipeline.binding_->GetVariableByName(SHADER_TYPE_COMPUTE, constantsName))
+        variable->Set(pipeline.constants_);
+
+    return true;
+}
+
+bool GraphicsImpl::DispatchComputePipeline(ComputePipeline& pipeline, const void* constants, unsigned constantsSize,
+    unsigned numGroups, unsigned numGroupsY)
+{
+    WaitForPresent();
+
+    void* mappedData = nullptr;
+    deviceContext_->MapBuffer(pipeline.constants_, MAP_WRITE, MAP_FLAG_DISCARD, mappedData);
+    if (!mappedData)
+        return false;
+    memcpy(mappedData, constants, constantsSize);
+    deviceContext_->UnmapBuffer(pipeline.constants_, MAP_WRITE);
+
+    deviceContext_->SetPipelineState(pipeline.pipeline_);
+    deviceContext_->CommitShaderResources(pipeline.binding_, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DispatchComputeAttribs dispatchAttribs(numGroups, numGroupsY, 1);
+    deviceContext_->DispatchCompute(dispatchAttribs);
+
+    // Make the next draw set its pipeline resources again
+    currentShaderResourceBinding_ = nullptr;
+    MarkShaderResourcesDirty();
+    return true;
+}
+
+bool GraphicsImpl::DispatchTextureCompute(ComputePipeline& pipeline, const TextureComputeConstants& constants, ITexture* const* inputs,
+    unsigned numInputs, ITexture* output, bool async, bool& dispatchedAsync)
+{
+    WaitForPresent();
+
+    dispatchedAsync = false;
+    const TextureDesc& outputDesc = output->GetDesc();
+    const unsigned numGroupsX = (outputDesc.Width + TEXTURE_COMPUTE_GROUP_SIZE - 1) / TEXTURE_COMPUTE_GROUP_SIZE;
+    const unsigned numGroupsY = (outputDesc.Height + TEXTURE_COMPUTE_GROUP_SIZE - 1) / TEXTURE_COMPUTE_GROUP_SIZE;
+
+    // The compute queue may only be used for textures shared with it
+    const Uint64 computeContextMask = 2;
+    if (async && computeContext_ && (outputDesc.ImmediateContextMask & computeContextMask))
+    {
+        for (unsigned i = 0; i < numInputs; ++i)
+        {
+            if (!(inputs[i]->GetDesc().ImmediateContextMask & computeContextMask))
+            {
+                async = false;
+                break;
+            }
+        }
+    }
+    else
+        async = false;
+
+    if (!async)
+        return DispatchComputePipeline(pipeline, &constants, sizeof constants, numGroupsX, numGroupsY);
+
+    if (!graphicsQueueFence_ || !computeQueueFence_)
+    {
+        FenceDesc fenceDesc;
+        fenceDesc.Type = FENCE_TYPE_GENERAL;
+        fenceDesc.Name = "Graphics queue fence";
+        device_->CreateFence(fenceDesc, &graphicsQueueFence_);
+        fenceDesc.Name = "Compute queue fence";
+        device_->CreateFence(fenceDesc, &computeQueueFence_);
+        if (!graphicsQueueFence_ || !computeQueueFence_)
+        {
+            URHO3D_LOGERROR("Failed to create async compute fences");
+            graphicsQueueFence_.Release();
+            computeQueueFence_.Release();
+            return DispatchComputePipeline(pipeline, &constants, sizeof constants, numGroupsX, numGroupsY);
+        }
+    }
+
+    // A compute queue can not transition resources out of graphics states, so move the textures to their compute states on the
+    // graphics queue before signaling it
+    StateTransitionDesc transitions[MAX_TEXTURE_UNITS + 1];
+    unsigned numTransitions = 0;
+    for (unsigned i = 0; i < numInputs && numTransitions < MAX_TEXTURE_UNITS; ++i)
+    {
+        transitions[numTransitions++] = StateTransitionDesc(inputs[i], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE,
+            STATE_TRANSITION_FLAG_UPDATE_STATE);
+    }
+    transitions[numTransitions++] = StateTransitionDesc(output, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS,
+        STATE_TRANSITION_FLAG_UPDATE_STATE);
+    immediateContext_->TransitionResourceStates(numTransitions, transitions);
+
+    // The compute queue may only wait for a value whose signal has been submitted
+    immediateContext_->EnqueueSignal(graphicsQueueFence_, ++graphicsQueueFenceValue_);
+    immediateContext_->Flush();
+    // Flushing requires the pipeline resources to be committed again on the next draw
+    currentShaderResourceBinding_ = nullptr;
+    MarkShaderResourcesDirty();
+
+    computeContext_->DeviceWaitForFence(graphicsQueueFence_, graphicsQueueFenceValue_);
+
+    void* mappedData = nullptr;
+    computeContext_->MapBuffer(pipeline.constants_, MAP_WRITE, MAP_FLAG_DISCARD, mappedData);
+    if (!mappedData)
+        return false;
+    memcpy(mappedData, &constants, sizeof constants);
+    computeContext_->UnmapBuffer(pipeline.constants_, MAP_WRITE);
+
+    computeContext_->SetPipelineState(pipeline.pipeline_);
+    computeContext_->CommitShaderResources(pipeline.binding_, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    DispatchComputeAttribs dispatchAttribs(numGroupsX, numGroupsY, 1);
+    computeContext_->DispatchCompute(dispatchAttribs);
+
+    computeContext_->EnqueueSignal(computeQueueFence_, ++computeQueueFenceValue_);
+    computeContext_->Flush();
+    dispatchedAsync = true;
+    return true;
+}
+
+void GraphicsImpl::WaitComputeQueue()
+{
+    if (computeQueueFence_ && computeQueueFenceValue_)
+        immediateContext_->DeviceWaitForFence(computeQueueFence_, computeQueueFenceValue_);
+}
+
+bool GraphicsImpl::DispatchSkinning(IBuffer* source, IBuffer* dest, const SkinningConstants& constants,
+    const Matrix3x4* skinMatrices, unsigned numSkinMatrices)
+{
+    WaitForPresent();
+
+    if (!skinningPipeline_.pipeline_ || !source || !dest || !constants.vertexCount_ || !numSkinMatrices)
+        return false;
+
+    // Each matrix is stored as three rows
+    unsigned matrixDataSize = numSkinMatrices * sizeof(Matrix3x4);
+    if (!skinMatrixBuffer_ || skinMatrixBuffer_->GetDesc().Size < matrixDataSize)
+    {
+        BufferDesc bufferDesc;
+        bufferDesc.Name = "sSkinMatrices";
+        bufferDesc.Size = NextPowerOfTwo(Max(matrixDataSize, (unsigned)(64 * sizeof(Matrix3x4))));
+        bufferDesc.Usage = USAGE_DEFAULT;
+        bufferDesc.BindFlags = BIND_SHADER_RESOURCE;
+        bufferDesc.Mode = BUFFER_MODE_STRUCTURED;
+        bufferDesc.ElementByteStride = sizeof(Vector4);
+
+        skinMatrixBuffer_.Release();
+        device_->CreateBuffer(bufferDesc, nullptr, &skinMatrixBuffer_);
+        if (!skinMatrixBuffer_)
+        {
+            URHO3D_LOGERROR("Failed to create skin matrix buffer");
+            return false;
+        }
+    }
+
+    IBufferView* sourceView = source->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE);
+    IBufferView* destView = dest->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS);
+    if (!sourceView || !destView)
+    {
+        URHO3D_LOGERROR("Vertex buffers for compute skinning must have compute access enabled");
+        return false;
+    }
+
+    deviceContext_->UpdateBuffer(skinMatrixBuffer_, 0, matrixDataSize, skinMatrices, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    IShaderResourceBinding* binding = skinningPipeline_.binding_;
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "sSkinMatrices"))
+        variable->Set(skinMatrixBuffer_->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "bSourceVertices"))
+        variable->Set(sourceView);
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "rwSkinnedVertices"))
+        variable->Set(destView);
+
+    if (!DispatchComputePipeline(skinningPipeline_, &constants, sizeof constants,
+        (constants.vertexCount_ + SKINNING_GROUP_SIZE - 1) / SKINNING_GROUP_SIZE))
+        return false;
+
+    // Return both buffers to vertex input use
+    StateTransitionDesc transitions[] = {
+        StateTransitionDesc(source, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE),
+        StateTransitionDesc(dest, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE)
+    };
+    deviceContext_->TransitionResourceStates(2, transitions);
+    return true;
+}
+
+bool GraphicsImpl::DispatchMorph(IBuffer* source, IBuffer* dest, IBuffer* deltas, const MorphConstants& constants)
+{
+    WaitForPresent();
+
+    if (!morphPipeline_.pipeline_ || !source || !dest || !deltas || !constants.vertexCount_)
+        return false;
+
+    IBufferView* sourceView = source->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE);
+    IBufferView* destView = dest->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS);
+    IBufferView* deltaView = deltas->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE);
+    if (!sourceView || !destView || !deltaView)
+    {
+        URHO3D_LOGERROR("Vertex buffers for compute morphing must have compute access enabled");
+        return false;
+    }
+
+    IShaderResourceBinding* binding = morphPipeline_.binding_;
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "bMorphDeltas"))
+        variable->Set(deltaView);
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "bSourceVertices"))
+        variable->Set(sourceView);
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "rwMorphedVertices"))
+        variable->Set(destView);
+
+    if (!DispatchComputePipeline(morphPipeline_, &constants, sizeof constants,
+        (constants.vertexCount_ + MORPH_GROUP_SIZE - 1) / MORPH_GROUP_SIZE))
+        return false;
+
+    // Return both vertex buffers to vertex input use. The delta buffer stays a shader resource
+    StateTransitionDesc transitions[] = {
+        StateTransitionDesc(source, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE),
+        StateTransitionDesc(dest, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE)
+    };
+    deviceContext_->TransitionResourceStates(2, transitions);
+    return true;
+}
+
+bool GraphicsImpl::DispatchParticles(IBuffer* states, IBuffer* dest, const ParticleConstants& constants)
+{
+    WaitForPresent();
+
+    if (!particlePipeline_.pipeline_ || !states || !dest || !constants.numParticles_)
+        return false;
+
+    IBufferView* stateView = states->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS);
+    IBufferView* destView = dest->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS);
+    if (!stateView || !destView)
+    {
+        URHO3D_LOGERROR("Vertex buffers for GPU particles must have compute access enabled");
+        return false;
+    }
+
+    IShaderResourceBinding* binding = particlePipeline_.binding_;
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "rwParticleStates"))
+        variable->Set(stateView);
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "rwParticleVertices"))
+        variable->Set(destView);
+
+    if (!DispatchComputePipeline(particlePipeline_, &constants, sizeof constants,
+        (constants.numParticles_ + PARTICLE_GROUP_SIZE - 1) / PARTICLE_GROUP_SIZE))
+        return false;
+
+    // Return the billboard vertices to vertex input use. The state buffer stays an unordered access resource
+    StateTransitionDesc transition(dest, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    deviceContext_->TransitionResourceStates(1, &transition);
+    return true;
+}
+
+bool GraphicsImpl::DispatchCompactIndices(IBuffer* source, IBuffer* dest, CompactIndexConstants& constants, const unsigned* ranges)
+{
+    WaitForPresent();
+
+    if (!compactIndexPipeline_.pipeline_ || !source || !dest || !constants.numRanges_)
+        return false;
+
+    unsigned rangeDataSize = constants.numRanges_ * 3 * sizeof(unsigned);
+    if (!compactRangeBuffer_ || compactRangeBuffer_->GetDesc().Size < rangeDataSize)
+    {
+        BufferDesc bufferDesc;
+        bufferDesc.Name = "sIndexRanges";
+        bufferDesc.Size = NextPowerOfTwo(Max(rangeDataSize, (unsigned)(256 * 3 * sizeof(unsigned))));
+        bufferDesc.Usage = USAGE_DEFAULT;
+        bufferDesc.BindFlags = BIND_SHADER_RESOURCE;
+        bufferDesc.Mode = BUFFER_MODE_STRUCTURED;
+        bufferDesc.ElementByteStride = 3 * sizeof(unsigned);
+
+        compactRangeBuffer_.Release();
+        device_->CreateBuffer(bufferDesc, nullptr, &compactRangeBuffer_);
+        if (!compactRangeBuffer_)
+        {
+            URHO3D_LOGERROR("Failed to create index range buffer");
+            return false;
+        }
+    }
+
+    IBufferView* sourceView = source->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE);
+    IBufferView* destView = dest->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS);
+    if (!sourceView || !destView)
+    {
+        URHO3D_LOGERROR("Index buffers for index compaction must have compute access enabled");
+        return false;
+    }
+
+    deviceContext_->UpdateBuffer(compactRangeBuffer_, 0, rangeDataSize, ranges, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    IShaderResourceBinding* binding = compactIndexPipeline_.binding_;
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "sIndexRanges"))
+        variable->Set(compactRangeBuffer_->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "bSourceIndices"))
+        variable->Set(sourceView);
+    if (IShaderResourceVariable* variable = binding->GetVariableByName(SHADER_TYPE_COMPUTE, "rwCompactedIndices"))
+        variable->Set(destView);
+
+    // A dispatch can have at most 65535 thread groups, so split large range counts
+    for (constants.firstRange_ = 0; constants.firstRange_ < constants.numRanges_; constants.firstRange_ += MAX_COMPUTE_GROUPS)
+    {
+        if (!DispatchComputePipeline(compactIndexPipeline_, &constants, sizeof constants,
+            Min(constants.numRanges_ - constants.firstRange_, MAX_COMPUTE_GROUPS)))
+            return false;
+    }
+
+    // Return both buffers to index input use
+    StateTransitionDesc transitions[] = {
+        StateTransitionDesc(source, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE),
+        StateTransitionDesc(dest, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE)
+    };
+    deviceContext_->TransitionResourceStates(2, transitions);
+    return true;
+}
+
+void GraphicsImpl::CommitConstantBuffers()
+{
+    if (!shaderProgram_ || !currentConstantBufferMap_ || !currentShaderResourceBinding_)
+        return;
+
+    const PipelineState::ConstantBufferMap& constantBufferMap = *currentConstantBufferMap_;
+
+    // If the ring buffer wraps around while uploading, the buffers uploaded before it are no longer available
+    unsigned epoch;
+    do
+    {
+        epoch = constantRingEpoch_;
+        for (const auto& entry : constantBufferMap)
+        {
+            ConstantBuffer* buffer = entry.shaderType == VS ? shaderProgram_->vsConstantBuffers_[entry.group].Get()
+                                                            : shaderProgram_->psConstantBuffers_[entry.group].Get();
+            if (buffer)
+                buffer->Apply();
+        }
+    }
+    while (epoch != constantRingEpoch_);
+
+    if (constantOffsetsBinding_ != currentShaderResourceBinding_)
+    {
+        constantOffsetsBinding_ = currentShaderResourceBinding_;
+        for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS; ++i)
+            constantOffsets_[VS][i] = constantOffsets_[PS][i] = M_MAX_UNSIGNED;
+    }
+
+    // Changing the dynamic offsets does not require committing the shader resource binding again
+    for (const auto& entry : constantBufferMap)
+    {
+        ConstantBuffer* buffer = entry.shaderType == VS ? shaderProgram_->vsConstantBuffers_[entry.group].Get()
+                                                        : shaderProgram_->psConstantBuffers_[entry.group].Get();
+        if (buffer && buffer->GetRingOffset() != constantOffsets_[entry.shaderType][entry.group])
+        {
+            currentShaderResourceBinding_->GetVariableByIndex(entry.variableShaderType, entry.variableIndex)
+                ->SetBufferOffset(buffer->GetRingOffset());
+            constantOffsets_[entry.shaderType][entry.group] = buffer->GetRingOffset();
+        }
     }
 }
 
+bool GraphicsImpl::CreateConstantRingBuffer()
+{
+    constantRingAlignment_ = Max(device_->GetAdapterInfo().Buffer.ConstantBufferOffsetAlignment, 16u);
+
+    BufferDesc bufferDesc;
+    bufferDesc.Name = "Constant ring buffer";
+    bufferDesc.Size = CONSTANT_RING_BUFFER_SIZE;
+    bufferDesc.Usage = USAGE_DYNAMIC;
+    bufferDesc.BindFlags = BIND_UNIFORM_BUFFER;
+    bufferDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+    constantRingBuffer_.Release();
+    device_->CreateBuffer(bufferDesc, nullptr, &constantRingBuffer_);
+    if (!constantRingBuffer_)
+    {
+        URHO3D_LOGERROR("Failed to create constant ring buffer");
+        return false;
+    }
+
+    InvalidateConstantRing();
+    return true;
+}
+
+static void AddBufferMemory(GPUMemoryStats& stats, const IBuffer* buffer)
+{
+    if (buffer)
+    {
+        ++stats.count_;
+        stats.use_ += buffer->GetDesc().Size;
+    }
+}
+
+void GraphicsImpl::CollectInternalGPUMemory(GPUMemoryStats* stats) const
+{
+    GPUMemoryStats& constantStats = stats[GPU_MEMORY_CONSTANTBUFFER];
+    AddBufferMemory(constantStats, constantRingBuffer_);
+    AddBufferMemory(constantStats, skinningPipeline_.constants_);
+    AddBufferMemory(constantStats, morphPipeline_.constants_);
+    AddBufferMemory(constantStats, particlePipeline_.constants_);
+    AddBufferMemory(constantStats, compactIndexPipeline_.constants_);
+
+    GPUMemoryStats& otherStats = stats[GPU_MEMORY_OTHER];
+    AddBufferMemory(otherStats, uploadRingBuffer_);
+    AddBufferMemory(otherStats, skinMatrixBuffer_);
+    AddBufferMemory(otherStats, compactRangeBuffer_);
+    for (unsigned i = 0; i < NUM_CLUSTER_BUFFERS; ++i)
+        AddBufferMemory(otherStats, clusterBuffers_[i]);
+}
+
+void GraphicsImpl::InvalidateConstantRing()
+{
+    ++constantRingEpoch_;
+    constantRingDiscardPending_ = true;
+}
+
+unsigned GraphicsImpl::GetConstantRingRangeSize(unsigned size) const
+{
+    return (size + constantRingAlignment_ - 1) / constantRingAlignment_ * constantRingAlignment_;
+}
+
+unsigned GraphicsImpl::WriteConstantData(const void* data, unsigned size)
+{
+    const unsigned rangeSize = GetConstantRingRangeSize(size);
+
+    MAP_FLAGS mapFlags = MAP_FLAG_NO_OVERWRITE;
+    if (constantRingDiscardPending_ || constantRingOffset_ + rangeSize > CONSTANT_RING_BUFFER_SIZE)
+    {
+        // Wrapping around within the frame makes the data written so far unavailable for later draws
+        if (!constantRingDiscardPending_)
+            ++constantRingEpoch_;
+        constantRingDiscardPending_ = false;
+        constantRingOffset_ = 0;
+        mapFlags = MAP_FLAG_DISCARD;
+    }
+
+    unsigned char* mappedData = nullptr;
+    deviceContext_->MapBuffer(constantRingBuffer_, MAP_WRITE, mapFlags, (PVoid&)mappedData);
+    if (mappedData != nullptr)
+    {
+        memcpy(mappedData + constantRingOffset_, data, size);
+        deviceContext_->UnmapBuffer(constantRingBuffer_, MAP_WRITE);
+    }
+
+    const unsigned offset = constantRingOffset_;
+    constantRingOffset_ += rangeSize;
+    return offset;
+}
+
+bool GraphicsImpl::BindMaterialConstants(Material* material)
+{
+    if (!shaderProgram_ || !shaderProgram_->materialLayoutHash_)
+        return false;
+
+    MaterialConstantBlock& block = material->GetConstantBlock(shaderProgram_->materialLayoutHash_);
+    if (!block.complete_ || block.version_ != material->GetShaderParameterVersion())
+        return false;
+
+    ConstantBuffer* buffers[] = {shaderProgram_->vsConstantBuffers_[SP_MATERIAL].Get(), shaderProgram_->psConstantBuffers_[SP_MATERIAL].Get()};
+    const unsigned offsets[] = {0, block.vsSize_};
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        if (!buffers[i])
+            continue;
+
+        // The block is written to the ring buffer once per ring buffer epoch, and later draws with the material only change the
+        // dynamic offset
+        const unsigned char* data = &block.data_[offsets[i]];
+        if (block.ringEpochs_[i] != constantRingEpoch_)
+        {
+            block.ringOffsets_[i] = WriteConstantData(data, buffers[i]->GetSize());
+            block.ringEpochs_[i] = constantRingEpoch_;
+        }
+        buffers[i]->SetRingData(data, block.ringOffsets_[i], block.ringEpochs_[i]);
+    }
+
+    return true;
+}
+
+void GraphicsImpl::StoreMaterialConstants(Material* material)
+{
+    if (!shaderProgram_ || !shaderProgram_->materialLayoutHash_)
+        return;
+
+    MaterialConstantBlock& block = material->GetConstantBlock(shaderProgram_->materialLayoutHash_);
+    if (block.version_ == material->GetShaderParameterVersion())
+        return;
+
+    block.version_ = material->GetShaderParameterVersion();
+    block.ringEpochs_[0] = block.ringEpochs_[1] = 0;
+
+    // A parameter in another constant buffer would not be restored by binding the block
+    block.complete_ = true;
+    const HashMap<StringHash, MaterialShaderParameter>& parameters = material->GetShaderParameters();
+    for (HashMap<StringHash, MaterialShaderParameter>::ConstIterator i = parameters.Begin(); i != parameters.End(); ++i)
+    {
+        HashMap<StringHash, ShaderParameter>::ConstIterator j = shaderProgram_->parameters_.Find(i->first_);
+        if (j != shaderProgram_->parameters_.End() && j->second_.buffer_ != SP_MATERIAL)
+        {
+            block.complete_ = false;
+            return;
+        }
+    }
+
+    ConstantBuffer* vsBuffer = shaderProgram_->vsConstantBuffers_[SP_MATERIAL].Get();
+    ConstantBuffer* psBuffer = shaderProgram_->psConstantBuffers_[SP_MATERIAL].Get();
+    block.vsSize_ = vsBuffer ? vsBuffer->GetSize() : 0;
+    unsigned psSize = psBuffer ? psBuffer->GetSize() : 0;
+    block.data_.Resize(block.vsSize_ + psSize);
+    if (vsBuffer)
+        memcpy(block.data_.Buffer(), vsBuffer->GetShadowData(), block.vsSize_);
+    if (psBuffer)
+        memcpy(block.data_.Buffer() + block.vsSize_, psBuffer->GetShadowData(), psSize);
+}
+
+RefCntAutoPtr<ITexture> GraphicsImpl::CopyToStagingTexture(ITexture* source, unsigned mipLevel, unsigned arraySlice)
+{
+    WaitForPresent();
+
+    RefCntAutoPtr<ITexture> stagingTexture;
+    if (!source)
+        return stagingTexture;
+
+    const TextureDesc& sourceDesc = source->GetDesc();
+
+    TextureDesc textureDesc;
+    textureDesc.Name = "Readback staging texture";
+    textureDesc.Type = sourceDesc.Type == RESOURCE_DIM_TEX_3D ? RESOURCE_DIM_TEX_3D : RESOURCE_DIM_TEX_2D;
+    textureDesc.Width = Max(sourceDesc.Width >> mipLevel, 1u);
+    textureDesc.Height = Max(sourceDesc.Height >> mipLevel, 1u);
+    if (textureDesc.Type == RESOURCE_DIM_TEX_3D)
+        textureDesc.Depth = Max(sourceDesc.Depth >> mipLevel, 1u);
+    else
+        textureDesc.ArraySize = 1;
+    textureDesc.MipLevels = 1;
+    textureDesc.Format = sourceDesc.Format;
+    textureDesc.SampleCount = 1;
+    textureDesc.Usage = USAGE_STAGING;
+    textureDesc.BindFlags = BIND_NONE;
+    textureDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    device_->CreateTexture(textureDesc, nullptr, &stagingTexture);
+    if (!stagingTexture)
+    {
+        URHO3D_LOGERROR("Failed to create staging texture for readback");
+        return stagingTexture;
+    }
+
+    CopyTextureAttribs copyTextureAttribs(source, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, stagingTexture,
+                                          RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    copyTextureAttribs.SrcMipLevel = mipLevel;
+    copyTextureAttribs.SrcSlice = arraySlice;
+    immediateContext_->CopyTexture(copyTextureAttribs);
+
+    return stagingTexture;
+}
+
+RefCntAutoPtr<ITexture> GraphicsImpl::CopyBackbufferToStagingTexture()
+{
+    WaitForPresent();
+
+    ITexture* source = defaultRenderTargetView_->GetTexture();
+    if (source->GetDesc().SampleCount > 1)
+    {
+        if (!resolveTexture_)
+            return RefCntAutoPtr<ITexture>();
+
+        ResolveTextureSubresourceAttribs resolveTextureSubresourceAttribs;
+        resolveTextureSubresourceAttribs.Format = TEX_FORMAT_RGBA8_UNORM;
+        resolveTextureSubresourceAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        resolveTextureSubresourceAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        immediateContext_->ResolveTextureSubresource(source, resolveTexture_, resolveTextureSubresourceAttribs);
+        source = resolveTexture_;
+    }
+
+    return CopyToStagingTexture(source, 0, 0);
+}
+
+Uint64 GraphicsImpl::SignalReadbackFence()
+{
+    WaitForPresent();
+
+    if (!readbackFence_)
+    {
+        FenceDesc fenceDesc;
+        fenceDesc.Name = "Readback fence";
+        fenceDesc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+        device_->CreateFence(fenceDesc, &readbackFence_);
+        if (!readbackFence_)
+        {
+            URHO3D_LOGERROR("Failed to create readback fence");
+            return 0;
+        }
+    }
+
+    immediateContext_->EnqueueSignal(readbackFence_, ++readbackFenceValue_);
+    // Submit now so that the copy finishes in the background rather than at frame end
+    immediateContext_->Flush();
+    return readbackFenceValue_;
+}
+
+bool GraphicsImpl::ReadStagingTexture(ITexture* stagingTexture, void* dest, unsigned rowSize, unsigned numRows, unsigned numSlices)
+{
+    WaitForPresent();
+
+    MappedTextureSubresource mappedData;
+    immediateContext_->MapTextureSubresource(stagingTexture, 0, 0, MAP_READ, MAP_FLAG_NONE, nullptr, mappedData);
+    if (!mappedData.pData)
+    {
+        URHO3D_LOGERROR("Failed to map staging texture for readback");
+        return false;
+    }
+
+    unsigned char* destData = (unsigned char*)dest;
+    for (unsigned slice = 0; slice < numSlices; ++slice)
+    {
+        const unsigned char* sliceData = (const unsigned char*)mappedData.pData + slice * mappedData.DepthStride;
+        for (unsigned row = 0; row < numRows; ++row)
+        {
+            memcpy(destData, sliceData + row * mappedData.Stride, rowSize);
+            destData += rowSize;
+        }
+    }
+
+    immediateContext_->UnmapTextureSubresource(stagingTexture, 0, 0);
+    return true;
+}
+
+bool GraphicsImpl::ReadTextureData(ITexture* source, unsigned mipLevel, unsigned arraySlice, void* dest, unsigned rowSize,
+                                   unsigned numRows, unsigned numSlices)
+{
+    RefCntAutoPtr<ITexture> stagingTexture = CopyToStagingTexture(source, mipLevel, arraySlice);
+    if (!stagingTexture)
+        return false;
+
+    const Uint64 fenceValue = SignalReadbackFence();
+    if (!fenceValue)
+        return false;
+
+    readbackFence_->Wait(fenceValue);
+    return ReadStagingTexture(stagingTexture, dest, rowSize, numRows, numSlices);
+}
+
+unsigned GraphicsImpl::QueueReadback(ITexture* stagingTexture, Texture2D* texture, unsigned level)
+{
+    const Uint64 fenceValue = SignalReadbackFence();
+    if (!fenceValue)
+        return 0;
+
+    PendingReadback readback;
+    readback.id_ = nextReadbackId_++;
+    if (!nextReadbackId_)
+        nextReadbackId_ = 1;
+    readback.stagingTexture_ = stagingTexture;
+    readback.fenceValue_ = fenceValue;
+    readback.texture_ = texture;
+    readback.level_ = level;
+    readback.screenShot_ = texture == nullptr;
+    pendingReadbacks_.Push(readback);
+    return readback.id_;
+}
+
+bool GraphicsImpl::AllocateUploadRing(unsigned size, unsigned& offset)
+{
+    if (!size || size > UPLOAD_RING_BUFFER_SIZE)
+        return false;
+
+    if (!uploadRingBuffer_)
+    {
+        BufferDesc bufferDesc;
+        bufferDesc.Name = "Upload ring buffer";
+        bufferDesc.Size = UPLOAD_RING_BUFFER_SIZE;
+        bufferDesc.Usage = USAGE_STAGING;
+        bufferDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+        device_->CreateBuffer(bufferDesc, nullptr, &uploadRingBuffer_);
+        if (!uploadRingBuffer_)
+        {
+            URHO3D_LOGERROR("Failed to create upload ring buffer, uploading static data directly");
+            uploadRingFailed_ = true;
+            return false;
+        }
+    }
+
+    // Free the regions of the frames the GPU has finished
+    const Uint64 completedFrame = frameFence_->GetCompletedValue();
+    unsigned numFreed = 0;
+    while (numFreed < uploadRingRegions_.Size() && uploadRingRegions_[numFreed].frame_ <= completedFrame)
+        ++numFreed;
+    if (numFreed)
+        uploadRingRegions_.Erase(0, numFreed);
+    if (uploadRingRegions_.Empty())
+        uploadRingHead_ = 0;
+
+    // Regions are allocated in order, so the free space is after the head and, once wrapped, up to the oldest region
+    const unsigned tail = uploadRingRegions_.Empty() ? 0 : uploadRingRegions_.Front().start_;
+    bool wrapped = !uploadRingRegions_.Empty() && uploadRingHead_ <= tail;
+    unsigned start = (uploadRingHead_ + UPLOAD_RING_OFFSET_ALIGNMENT - 1) & ~(UPLOAD_RING_OFFSET_ALIGNMENT - 1);
+    if (!wrapped && start + size > UPLOAD_RING_BUFFER_SIZE)
+    {
+        start = 0;
+        wrapped = !uploadRingRegions_.Empty();
+    }
+    if (wrapped && start + size > tail)
+        return false;
+
+    UploadRingRegion region;
+    region.start_ = start;
+    region.end_ = start + size;
+    region.frame_ = frameFenceValue_ + 1;
+    uploadRingRegions_.Push(region);
+    uploadRingHead_ = region.end_;
+    offset = start;
+    return true;
+}
+
+/// Return whether static data can be staged through the upload ring buffer.
+static bool UseUploadRing(RENDER_DEVICE_TYPE deviceType, bool hasFrameFence, bool ringFailed)
+{
+    // Without the frame fence it is not known when regions become free
+    return (deviceType == RENDER_DEVICE_TYPE_D3D12 || deviceType == RENDER_DEVICE_TYPE_VULKAN) && hasFrameFence && !ringFailed;
+}
+
+void GraphicsImpl::UpdateTextureData(ITexture* texture, unsigned mipLevel, unsigned arraySlice, const Box& destBox,
+                                     const void* data, unsigned rowSize, unsigned numRows)
+{
+    WaitForPresent();
+
+    if (UseUploadRing(deviceType_, frameFence_ != nullptr, uploadRingFailed_))
+    {
+        const unsigned stride = (rowSize + UPLOAD_RING_ROW_ALIGNMENT - 1) & ~(UPLOAD_RING_ROW_ALIGNMENT - 1);
+        unsigned offset;
+        void* mappedData = nullptr;
+        if (AllocateUploadRing(stride * numRows, offset))
+            immediateContext_->MapBuffer(uploadRingBuffer_, MAP_WRITE, MAP_FLAG_NONE, mappedData);
+
+        if (mappedData)
+        {
+            for (unsigned row = 0; row < numRows; ++row)
+                memcpy((unsigned char*)mappedData + offset + row * stride, (const unsigned char*)data + row * rowSize, rowSize);
+            immediateContext_->UnmapBuffer(uploadRingBuffer_, MAP_WRITE);
+
+            TextureSubResData textureSubResData;
+            textureSubResData.pSrcBuffer = uploadRingBuffer_;
+            textureSubResData.SrcOffset = offset;
+            textureSubResData.Stride = stride;
+            textureSubResData.DepthStride = 0;
+            immediateContext_->UpdateTexture(texture, mipLevel, arraySlice, destBox, textureSubResData,
+                RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            return;
+        }
+    }
+
+    TextureSubResData textureSubResData;
+    textureSubResData.pData = data;
+    textureSubResData.Stride = rowSize;
+    textureSubResData.DepthStride = 0;
+    deviceContext_->UpdateTexture(texture, mipLevel, arraySlice, destBox, textureSubResData,
+        RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void GraphicsImpl::UpdateBufferData(IBuffer* buffer, unsigned offset, unsigned size, const void* data)
+{
+    WaitForPresent();
+
+    if (UseUploadRing(deviceType_, frameFence_ != nullptr, uploadRingFailed_))
+    {
+        unsigned srcOffset;
+        void* mappedData = nullptr;
+        if (AllocateUploadRing(size, srcOffset))
+            immediateContext_->MapBuffer(uploadRingBuffer_, MAP_WRITE, MAP_FLAG_NONE, mappedData);
+
+        if (mappedData)
+        {
+            memcpy((unsigned char*)mappedData + srcOffset, data, size);
+            immediateContext_->UnmapBuffer(uploadRingBuffer_, MAP_WRITE);
+            immediateContext_->CopyBuffer(uploadRingBuffer_, srcOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, buffer,
+                offset, size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            return;
+        }
+    }
+
+    deviceContext_->UpdateBuffer(buffer, offset, size, data, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void GraphicsImpl::QueueTextureUpload(Texture2D* texture, unsigned level, const void* data, Image* image,
+                                      const SharedArrayPtr<unsigned char>& ownedData)
+{
+    PendingTextureUpload upload;
+    upload.texture_ = texture;
+    upload.object_ = (ITexture*)texture->GetGPUObject();
+    upload.level_ = level;
+    upload.data_ = data;
+    upload.image_ = image;
+    upload.ownedData_ = ownedData;
+    pendingTextureUploads_.Push(upload);
+    texture->AddPendingUploads(1);
+}
+
+void GraphicsImpl::UpdateTextureUploads(unsigned budget)
+{
+    unsigned numUploaded = 0;
+    unsigned bytesUploaded = 0;
+
+    while (numUploaded < pendingTextureUploads_.Size() && (!numUploaded || bytesUploaded < budget))
+    {
+        const PendingTextureUpload& upload = pendingTextureUploads_[numUploaded++];
+        Texture2D* texture = upload.texture_;
+        if (!texture)
+            continue;
+
+        texture->AddPendingUploads(-1);
+        // A texture recreated since queuing has new data of its own
+        if ((ITexture*)texture->GetGPUObject() != upload.object_.RawPtr())
+            continue;
+
+        const int width = texture->GetLevelWidth(upload.level_);
+        const int height = texture->GetLevelHeight(upload.level_);
+        texture->SetData(upload.level_, 0, 0, width, height, upload.data_);
+        bytesUploaded += texture->GetDataSize(width, height);
+    }
+
+    if (numUploaded)
+        pendingTextureUploads_.Erase(0, numUploaded);
+}
+
+ITextureView* GraphicsImpl::GetPlaceholderView()
+{
+    if (!placeholderTexture_)
+    {
+        static const unsigned char black[] = { 0, 0, 0, 255 };
+
+        TextureDesc textureDesc;
+        textureDesc.Name = "Upload placeholder texture";
+        textureDesc.Type = RESOURCE_DIM_TEX_2D;
+        textureDesc.Width = 1;
+        textureDesc.Height = 1;
+        textureDesc.Format = TEX_FORMAT_RGBA8_UNORM;
+        textureDesc.Usage = USAGE_IMMUTABLE;
+        textureDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+        TextureSubResData subResData;
+        subResData.pData = black;
+        subResData.Stride = sizeof black;
+        TextureData initData(&subResData, 1);
+
+        device_->CreateTexture(textureDesc, &initData, &placeholderTexture_);
+        if (!placeholderTexture_)
+        {
+            URHO3D_LOGERROR("Failed to create upload placeholder texture");
+            return nullptr;
+        }
+    }
+
+    return placeholderTexture_->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+}
+
+void GraphicsImpl::SignalFrameFence()
+{
+    if (!frameFence_)
+    {
+        FenceDesc fenceDesc;
+        fenceDesc.Name = "Frame fence";
+        fenceDesc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+        device_->CreateFence(fenceDesc, &frameFence_);
+        if (!frameFence_)
+        {
+            URHO3D_LOGERROR("Failed to create frame fence, frames in flight are not limited");
+            ++frameFenceValue_;
+            return;
+        }
+    }
+
+    immediateContext_->EnqueueSignal(frameFence_, ++frameFenceValue_);
+}
+
+void GraphicsImpl::WaitForFramesInFlight(unsigned maxFramesInFlight)
+{
+    if (!frameFence_ || frameFenceValue_ < maxFramesInFlight)
+        return;
+
+    // The frame about to begin may proceed once the frame that is maxFramesInFlight frames older has finished on the GPU
+    const Uint64 waitValue = frameFenceValue_ + 1 - maxFramesInFlight;
+    if (frameFence_->GetCompletedValue() < waitValue)
+    {
+        URHO3D_PROFILE(WaitForGPU);
+        frameFence_->Wait(waitValue);
+    }
+}
+
+void GraphicsImpl::SetPresentThread(bool enable)
+{
+    if (enable && (!swapChain_ || deviceType_ == RENDER_DEVICE_TYPE_GL || deviceType_ == RENDER_DEVICE_TYPE_GLES))
+        enable = false;
+    if (enable == presentThread_.NotNull())
+        return;
+
+    if (enable)
+    {
+        presentThread_ = new PresentThread(this);
+        if (!presentThread_->Run())
+        {
+            URHO3D_LOGWARNING("Failed to start present thread, frames are not pipelined");
+            presentThread_.Reset();
+        }
+    }
+    else
+        presentThread_.Reset();
+}
+
+void GraphicsImpl::PresentFrame(unsigned syncInterval)
+{
+    swapChain_->Present(syncInterval);
+}
+
+/// Maximum number of ended frames whose GPU timings may wait for the GPU. Older frames are dropped.
+static const unsigned MAX_PENDING_GPU_TIMING_FRAMES = MAX_FRAMES_IN_FLIGHT + 2;
+
+bool GraphicsImpl::IsTimestampQuerySupported() const
+{
+    return device_ && device_->GetDeviceInfo().Features.TimestampQueries == DEVICE_FEATURE_STATE_ENABLED;
+}
+
+RefCntAutoPtr<IQuery> GraphicsImpl::IssueTimestamp()
+{
+    WaitForPresent();
+
+    RefCntAutoPtr<IQuery> query;
+    if (!freeTimestampQueries_.Empty())
+    {
+        query = freeTimestampQueries_.Back();
+        freeTimestampQueries_.Pop();
+    }
+    else
+    {
+        QueryDesc queryDesc;
+        queryDesc.Name = "GPU timing query";
+        queryDesc.Type = QUERY_TYPE_TIMESTAMP;
+        device_->CreateQuery(queryDesc, &query);
+        if (!query)
+        {
+            URHO3D_LOGERROR("Failed to create timestamp query");
+            return query;
+        }
+    }
+
+    // Timestamp queries are only ended
+    immediateContext_->EndQuery(query);
+    return query;
+}
+
+void GraphicsImpl::BeginGPUTiming(const String& name)
+{
+    GPUTimingQuery timing;
+    timing.name_ = name;
+    timing.depth_ = gpuTimingStack_.Size();
+    timing.begin_ = IssueTimestamp();
+    if (!timing.begin_)
+    {
+        gpuTimingStack_.Push(M_MAX_UNSIGNED);
+        return;
+    }
+
+    gpuTimingStack_.Push(gpuTimingQueries_.Size());
+    gpuTimingQueries_.Push(timing);
+}
+
+void GraphicsImpl::EndGPUTiming()
+{
+    if (gpuTimingStack_.Empty())
+        return;
+
+    unsigned index = gpuTimingStack_.Back();
+    gpuTimingStack_.Pop();
+    if (index == M_MAX_UNSIGNED)
+        return;
+
+    gpuTimingQueries_[index].end_ = IssueTimestamp();
+}
+
+void GraphicsImpl::EndGPUTimingFrame()
+{
+    while (!gpuTimingStack_.Empty())
+        EndGPUTiming();
+
+    // Drop blocks whose end timestamp could not be issued
+    for (unsigned i = gpuTimingQueries_.Size() - 1; i < gpuTimingQueries_.Size(); --i)
+    {
+        if (!gpuTimingQueries_[i].end_)
+            gpuTimingQueries_.Erase(i);
+    }
+    if (gpuTimingQueries_.Empty())
+        return;
+
+    if (pendingGPUTimings_.Size() >= MAX_PENDING_GPU_TIMING_FRAMES)
+        pendingGPUTimings_.Erase(0);
+    pendingGPUTimings_.Push(gpuTimingQueries_);
+    gpuTimingQueries_.Clear();
+}
+
+bool GraphicsImpl::ResolveGPUTimings(Vector<GPUTiming>& timings)
+{
+    WaitForPresent();
+
+    bool resolved = false;
+
+    while (!pendingGPUTimings_.Empty())
+    {
+        Vector<GPUTimingQuery>& frame = pendingGPUTimings_.Front();
+
+        // Check availability first without invalidating, so that a partially available frame can be read later
+        for (unsigned i = 0; i < frame.Size(); ++i)
+        {
+            if (!frame[i].begin_->GetData(nullptr, 0) || !frame[i].end_->GetData(nullptr, 0))
+                return resolved;
+        }
+
+        timings.Resize(frame.Size());
+        for (unsigned i = 0; i < frame.Size(); ++i)
+        {
+            QueryDataTimestamp begin;
+            QueryDataTimestamp end;
+            GPUTiming& timing = timings[i];
+            timing.name_ = frame[i].name_;
+            timing.depth_ = frame[i].depth_;
+            timing.time_ = 0;
+            if (frame[i].begin_->GetData(&begin, sizeof begin) && frame[i].end_->GetData(&end, sizeof end) && begin.Frequency &&
+                end.Counter > begin.Counter)
+                timing.time_ = (long long)((double)(end.Counter - begin.Counter) * 1000000.0 / (double)begin.Frequency);
+
+            freeTimestampQueries_.Push(frame[i].begin_);
+            freeTimestampQueries_.Push(frame[i].end_);
+        }
+
+        pendingGPUTimings_.Erase(0);
+        resolved = true;
+    }
+
+    return resolved;
+}
+
+void GraphicsImpl::ReleaseGPUTimings()
+{
+    gpuTimingQueries_.Clear();
+    gpuTimingStack_.Clear();
+    pendingGPUTimings_.Clear();
+    freeTimestampQueries_.Clear();
+}
+
+void GraphicsImpl::SetDeviceContexts(IDeviceContext** contexts, unsigned numImmediateContexts)
+{
+    // The factory returns already referenced contexts, with the graphics context before the async compute context
+    immediateContext_.Attach(contexts[0]);
+    deviceContext_ = immediateContext_;
+    computeContext_.Release();
+    if (numImmediateContexts > 1 && contexts[1])
+        computeContext_.Attach(contexts[1]);
+}
+
 bool GraphicsImpl::CheckMultiSampleSupport(TEXTURE_FORMAT format, unsigned sampleCount) const
 {
 #if 0
@@ -96,6 +1490,233 @@ unsigned GraphicsImpl::GetMultiSampleQuality(TEXTURE_FORMAT format, unsigned sam
 #endif
 }
 
+GraphicsImpl::PipelineState GraphicsImpl::CreatePipelineStateBindings(Graphics* graphics, const PipelineStateCreateData& data)
+{
+    RefCntAutoPtr<IShaderResourceBinding> shaderResourceBinding;
+    data.pipelineState_->CreateShaderResourceBinding(&shaderResourceBinding, true);
+    assert(shaderResourceBinding != nullptr);
+
+    const Uint32 vertexShaderVariableCount = shaderResourceBinding->GetVariableCount(SHADER_TYPE_VERTEX);
+    const Uint32 pixelShaderVariableCount = shaderResourceBinding->GetVariableCount(SHADER_TYPE_PIXEL);
+    std::shared_ptr<PipelineState::TextureMap> textureMap = std::make_shared<PipelineState::TextureMap>();
+    textureMap->reserve(vertexShaderVariableCount + pixelShaderVariableCount);
+    std::shared_ptr<PipelineState::ConstantBufferMap> constantBufferMap = std::make_shared<PipelineState::ConstantBufferMap>();
+
+    auto numberPostfix = [](const char* str)
+    {
+        for (unsigned i = 0; str[i] != '\0'; ++i)
+        {
+            if (IsDigit(str[i]))
+                return ToUInt(&str[i]);
+        }
+
+        return M_MAX_UNSIGNED;
+    };
+
+    auto getTextureUnitFromVariable = [&](const ShaderResourceDesc& shaderResourceDesc)
+    {
+        const char* variableName =
+            shaderResourceDesc.Name[0] == 't' ? &shaderResourceDesc.Name[1] : shaderResourceDesc.Name;
+
+        unsigned textureUnit = graphics->GetTextureUnit(variableName);
+        if (textureUnit >= MAX_TEXTURE_UNITS)
+        {
+            textureUnit = numberPostfix(variableName);
+        }
+
+        return textureUnit;
+    };
+
+    auto addVariables = [&](SHADER_TYPE variableShaderType, ShaderType shaderType, ShaderVariation* variation, Uint32 count)
+    {
+        const unsigned* bufferSizes = variation->GetConstantBufferSizes();
+        const String* bufferNames = variation->GetConstantBufferNames();
+
+        for (Uint32 i = 0; i < count; i++)
+        {
+            IShaderResourceVariable* variable = shaderResourceBinding->GetVariableByIndex(variableShaderType, i);
+            ShaderResourceDesc shaderResourceDesc;
+            variable->GetResourceDesc(shaderResourceDesc);
+
+            if (shaderResourceDesc.Type == SHADER_RESOURCE_TYPE_CONSTANT_BUFFER)
+            {
+                for (unsigned group = 0; group < MAX_SHADER_PARAMETER_GROUPS; ++group)
+                {
+                    if (bufferSizes[group] > 0 && bufferNames[group] == shaderResourceDesc.Name)
+                    {
+                        // Constant buffer sizes are rounded up to 16 bytes, same as in ConstantBuffer::SetSize()
+                        const unsigned rangeSize = GetConstantRingRangeSize((bufferSizes[group] + 15) & 0xfffffff0);
+                        constantBufferMap->push_back(
+                            PipelineState::ConstantBufferMapEntry{shaderType, group, rangeSize, variableShaderType, i});
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                unsigned textureUnit = !strcmp(shaderResourceDesc.Name, BINDLESS_TEXTURE_VARIABLE) ? BINDLESS_TEXTURE_UNIT :
+                    getTextureUnitFromVariable(shaderResourceDesc);
+                for (unsigned k = 0; k < NUM_CLUSTER_BUFFERS; ++k)
+                {
+                    if (!strcmp(shaderResourceDesc.Name, CLUSTER_BUFFER_VARIABLES[k]))
+                        textureUnit = CLUSTER_BUFFER_UNIT + k;
+                }
+
+                if (textureUnit < MAX_TEXTURE_UNITS || textureUnit == BINDLESS_TEXTURE_UNIT ||
+                    (textureUnit >= CLUSTER_BUFFER_UNIT && textureUnit < CLUSTER_BUFFER_UNIT + NUM_CLUSTER_BUFFERS))
+                {
+                    textureMap->push_back(PipelineState::TextureMapEntry{textureUnit, variableShaderType, i});
+                }
+            }
+        }
+    };
+
+    addVariables(SHADER_TYPE_VERTEX, VS, data.vertexShaderVariation_, vertexShaderVariableCount);
+    if (data.createInfo_.pPS)
+        addVariables(SHADER_TYPE_PIXEL, PS, data.pixelShaderVariation_, pixelShaderVariableCount);
+
+    return PipelineState{data.pipelineState_, shaderResourceBinding, textureMap,
+                         std::make_shared<PipelineState::BindingCache>(), constantBufferMap};
+}
+
+/// Mix a value into a 64-bit hash.
+static inline unsigned long long MixPipelineKey(unsigned long long hash, unsigned long long value)
+{
+    hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+unsigned long long PipelineStateDesc::ToKey() const
+{
+    unsigned long long hash = MixPipelineKey(0, (unsigned long long)(size_t)vertexShader_);
+    hash = MixPipelineKey(hash, (unsigned long long)(size_t)pixelShader_);
+    hash = MixPipelineKey(hash, vertexDeclarationHash_);
+    hash = MixPipelineKey(hash, blendStateHash_ | ((unsigned long long)depthStateHash_ << 32));
+    hash = MixPipelineKey(hash, rasterizerStateHash_ | ((unsigned long long)renderTargetHash_ << 32));
+    hash = MixPipelineKey(hash, primitiveType_);
+
+    // Finalize so that the low bits used for the table index depend on all inputs
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    // Zero marks an empty table slot
+    return hash ? hash : 1;
+}
+
+GraphicsImpl::PipelineState* GraphicsImpl::FindPipelineState(unsigned long long key, const PipelineStateDesc& desc)
+{
+    if (pipelineStates_.Empty())
+        return nullptr;
+
+    const unsigned mask = pipelineStates_.Size() - 1;
+    for (unsigned i = (unsigned)key & mask;; i = (i + 1) & mask)
+    {
+        PipelineStateSlot& slot = pipelineStates_[i];
+        if (!slot.key_)
+            return nullptr;
+        if (slot.key_ == key && slot.desc_ == desc)
+            return &slot.state_;
+    }
+}
+
+GraphicsImpl::PipelineState* GraphicsImpl::AddPipelineState(Graphics* graphics, const PipelineStateCreateData& data)
+{
+    // Keep the load factor at most 1/2 so that probe sequences stay short
+    if ((numPipelineStates_ + 1) * 2 > pipelineStates_.Size())
+        ResizePipelineStateTable(Max(pipelineStates_.Size() * 2, MIN_PIPELINE_STATE_SLOTS));
+
+    const unsigned long long key = data.desc_.ToKey();
+    const unsigned mask = pipelineStates_.Size() - 1;
+    unsigned i = (unsigned)key & mask;
+    while (pipelineStates_[i].key_)
+        i = (i + 1) & mask;
+
+    PipelineStateSlot& slot = pipelineStates_[i];
+    slot.key_ = key;
+    slot.desc_ = data.desc_;
+    ++numPipelineStates_;
+
+    if (!data.pipelineState_)
+    {
+        // Store the failed state without a pipeline state, so that the draws using it are skipped without creating it
+        // again and logging the error on every draw. It is removed with the pipeline states of its shaders
+        URHO3D_LOGERROR("Failed to create pipeline state for shaders " + data.vertexShaderVariation_->GetFullName() + " and " +
+                        data.pixelShaderVariation_->GetFullName());
+        slot.state_ = PipelineState();
+        return &slot.state_;
+    }
+
+    slot.state_ = CreatePipelineStateBindings(graphics, data);
+
+    pipelineStateCacheDirty_ = true;
+    return &slot.state_;
+}
+
+unsigned GraphicsImpl::RemovePipelineStates(ShaderVariation* variation)
+{
+    unsigned removed = 0;
+
+    for (unsigned i = 0; i < pipelineStates_.Size();)
+    {
+        PipelineStateSlot& slot = pipelineStates_[i];
+        if (slot.key_ && slot.desc_.UsesShader(variation))
+        {
+            if (currentPipelineState_ == slot.state_.pipelineState_)
+                currentPipelineState_ = nullptr;
+
+            // A following entry may be moved into this slot, so check it again
+            RemovePipelineStateSlot(i);
+            ++removed;
+        }
+        else
+            ++i;
+    }
+
+    return removed;
+}
+
+void GraphicsImpl::RemovePipelineStateSlot(unsigned index)
+{
+    const unsigned mask = pipelineStates_.Size() - 1;
+    unsigned hole = index;
+
+    for (unsigned i = (index + 1) & mask; pipelineStates_[i].key_; i = (i + 1) & mask)
+    {
+        // Move the entry back if its home slot is not cyclically between the hole and its current slot
+        const unsigned home = (unsigned)pipelineStates_[i].key_ & mask;
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            pipelineStates_[hole] = pipelineStates_[i];
+            hole = i;
+        }
+    }
+
+    pipelineStates_[hole] = PipelineStateSlot();
+    --numPipelineStates_;
+}
+
+void GraphicsImpl::ResizePipelineStateTable(unsigned numSlots)
+{
+    Vector<PipelineStateSlot> oldSlots;
+    oldSlots.Swap(pipelineStates_);
+    pipelineStates_.Resize(numSlots);
+
+    const unsigned mask = numSlots - 1;
+    for (unsigned i = 0; i < oldSlots.Size(); ++i)
+    {
+        if (!oldSlots[i].key_)
+            continue;
+
+        unsigned j = (unsigned)oldSlots[i].key_ & mask;
+        while (pipelineStates_[j].key_)
+            j = (j + 1) & mask;
+        pipelineStates_[j] = oldSlots[i];
+    }
+}
+
 void GraphicsImpl::SetPrimitiveType(const PrimitiveType primitiveType)
 {
     if (primitiveType_ != primitiveType)
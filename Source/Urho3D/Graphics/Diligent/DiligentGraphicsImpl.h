@@ -27,7 +27,11 @@
 #include <Graphics/GraphicsEngineOpenGL/interface/EngineFactoryOpenGL.h>
 #include <Graphics/GraphicsEngineVulkan/interface/EngineFactoryVk.h>
 
+#include <Graphics/GraphicsEngine/interface/Dearchiver.h>
 #include <Graphics/GraphicsEngine/interface/DeviceContext.h>
+#include <Graphics/GraphicsEngine/interface/Fence.h>
+#include <Graphics/GraphicsEngine/interface/PipelineStateCache.h>
+#include <Graphics/GraphicsEngine/interface/Query.h>
 #include <Graphics/GraphicsEngine/interface/RenderDevice.h>
 #include <Graphics/GraphicsEngine/interface/SwapChain.h>
 
@@ -35,19 +39,21 @@
 
 #include <Common/interface/RefCntAutoPtr.hpp>
 
+#include "../../Core/Mutex.h"
+#include "../../Core/Thread.h"
+#include "../../Core/WorkQueue.h"
 #include "../../Graphics/ConstantBuffer.h"
 #include "../../Graphics/GraphicsDefs.h"
 #include "../../Graphics/ShaderProgram.h"
 #include "../../Graphics/VertexDeclaration.h"
 #include "../../Math/Color.h"
+#include "../../Resource/Image.h"
+
+#include <atomic>
 
 #include <d3d11.h>
 #include <dxgi.h>
 
-// TODO: Consider removing once Diligent usage improves
-// This workaround is used to prevent artifacts in PBRMaterials sample hi resolution (fullscreen) no vsync mode
-#define USE_WAIT_FOR_IDLE_WORKAROUND
-
 // TODO: Remove
 #ifndef __FUNCTION_NAME__
 #ifdef WIN32 // WINDOWS
@@ -78,55 +84,325 @@
         }                                                                                                              \
     } while (false)
 
-namespace std
+namespace Urho3D
+{
+
+class GraphicsImpl;
+class Material;
+class Matrix3x4;
+class ShaderVariation;
+class Texture2D;
+struct GPUTiming;
+
+/// Texture map unit of the bindless texture array variable.
+static const unsigned BINDLESS_TEXTURE_UNIT = MAX_TEXTURE_UNITS;
+/// Name of the bindless texture array variable in shaders.
+static const char* const BINDLESS_TEXTURE_VARIABLE = "tDiffMaps";
+/// Number of clustered lighting structured buffers.
+static const unsigned NUM_CLUSTER_BUFFERS = 3;
+/// Texture map unit of the first clustered lighting structured buffer variable.
+static const unsigned CLUSTER_BUFFER_UNIT = MAX_TEXTURE_UNITS + 1;
+/// Names of the clustered lighting structured buffer variables in shaders: light data, cluster light lists and light indices.
+static const char* const CLUSTER_BUFFER_VARIABLES[NUM_CLUSTER_BUFFERS] = {"sClusterLights", "sClusters", "sClusterLightIndices"};
+
+#define URHO3D_SAFE_RELEASE(p) if (p) { ((Diligent::IObject*)p)->Release();  p = 0; }
+
+#define URHO3D_LOGD3DERROR(msg, hr) URHO3D_LOGERRORF("%s (HRESULT %x)", msg, (unsigned)hr)
+
+/// Return the name a shader variation is stored with in a precompiled shader archive.
+String GetShaderArchiveName(const ShaderVariation* variation);
+/// Fill the create info for compiling a shader variation from source for a device type. The create info refers to the name, the macros and the owner shader's source code, which must outlive it.
+void FillShaderCreateInfo(const ShaderVariation* variation, Diligent::RENDER_DEVICE_TYPE deviceType, const String& name,
+    Diligent::ShaderMacroHelper& macros, Diligent::ShaderCreateInfo& createInfo);
+
+/// Number of vertices skinned by a compute skinning thread group.
+static const unsigned SKINNING_GROUP_SIZE = 64;
+
+/// Compute skinning shader constants. Byte offsets are M_MAX_UNSIGNED for absent elements. Matches the SkinningParameters constant buffer.
+struct SkinningConstants
 {
-namespace
+    /// First vertex to skin.
+    unsigned vertexStart_;
+    /// Number of vertices to skin.
+    unsigned vertexCount_;
+    /// Source vertex size in bytes.
+    unsigned sourceStride_;
+    /// Destination vertex size in bytes.
+    unsigned destStride_;
+    /// Source position byte offset.
+    unsigned positionOffset_;
+    /// Source normal byte offset.
+    unsigned normalOffset_;
+    /// Source tangent byte offset.
+    unsigned tangentOffset_;
+    /// Source blend weights byte offset.
+    unsigned weightsOffset_;
+    /// Source blend indices byte offset.
+    unsigned indicesOffset_;
+    /// Destination position byte offset.
+    unsigned destPositionOffset_;
+    /// Destination normal byte offset.
+    unsigned destNormalOffset_;
+    /// Destination tangent byte offset.
+    unsigned destTangentOffset_;
+};
+
+/// Number of vertices morphed by a compute morph thread group.
+static const unsigned MORPH_GROUP_SIZE = 64;
+
+/// Compute morph shader constants. Byte offsets are M_MAX_UNSIGNED for absent elements. Matches the MorphParameters constant buffer.
+struct MorphConstants
 {
+    /// First vertex of the morph range.
+    unsigned vertexStart_;
+    /// Number of vertices in the morph range.
+    unsigned vertexCount_;
+    /// Source vertex size in bytes.
+    unsigned sourceStride_;
+    /// Destination vertex size in bytes.
+    unsigned destStride_;
+    /// Source position byte offset.
+    unsigned positionOffset_;
+    /// Source normal byte offset.
+    unsigned normalOffset_;
+    /// Source tangent byte offset.
+    unsigned tangentOffset_;
+    /// Destination position byte offset.
+    unsigned destPositionOffset_;
+    /// Destination normal byte offset.
+    unsigned destNormalOffset_;
+    /// Destination tangent byte offset.
+    unsigned destTangentOffset_;
+    /// Number of morphs to apply.
+    unsigned numMorphs_;
+    /// Padding to the next constant register.
+    unsigned padding_;
+    /// Morph weights, four per constant register.
+    float weights_[MAX_COMPUTE_MORPHS];
+    /// Morph delta block indices, four per constant register.
+    unsigned deltaBlocks_[MAX_COMPUTE_MORPHS];
+};
 
-// Code from boost
-// Reciprocal of the golden ratio helps spread entropy
-//     and handles duplicates.
-// See Mike Seymour in magic-numbers-in-boosthash-combine:
-//     https://stackoverflow.com/questions/4948780
+/// Number of particles simulated by a GPU particle thread group.
+static const unsigned PARTICLE_GROUP_SIZE = 64;
 
-template <class T> inline void hash_combine(std::size_t& seed, T const& v)
+/// GPU particle shader constants. Matches the ParticleParameters constant buffer.
+struct ParticleConstants
 {
-    seed ^= hash<T>()(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-}
+    /// Number of particles.
+    unsigned numParticles_;
+    /// First particle to spawn.
+    unsigned spawnStart_;
+    /// Number of particles to spawn.
+    unsigned numSpawn_;
+    /// Random seed of the spawned particles.
+    unsigned seed_;
+    /// Destination vertex size in bytes.
+    unsigned destStride_;
+    /// Destination direction byte offset, or M_MAX_UNSIGNED if not facing the direction.
+    unsigned directionOffset_;
+    /// Emitter shape.
+    unsigned emitterType_;
+    /// Remove existing particles flag.
+    unsigned reset_;
+    /// Number of color animation frames.
+    unsigned numColorFrames_;
+    /// Number of texture animation frames.
+    unsigned numTextureFrames_;
+    /// Time step.
+    float timeStep_;
+    /// Damping force.
+    float dampingForce_;
+    /// Size addition per second.
+    float sizeAdd_;
+    /// Size multiplication per second.
+    float sizeMul_;
+    /// Minimum velocity.
+    float minVelocity_;
+    /// Maximum velocity.
+    float maxVelocity_;
+    /// Minimum time to live.
+    float minTimeToLive_;
+    /// Maximum time to live.
+    float maxTimeToLive_;
+    /// Minimum rotation in degrees.
+    float minRotation_;
+    /// Maximum rotation in degrees.
+    float maxRotation_;
+    /// Minimum rotation speed.
+    float minRotationSpeed_;
+    /// Maximum rotation speed.
+    float maxRotationSpeed_;
+    /// Billboard size scale.
+    float sizeScale_[2];
+    /// Minimum and maximum particle size.
+    float sizeRange_[4];
+    /// Emitter size, padded to a constant register.
+    float emitterSize_[4];
+    /// Minimum emission direction, padded to a constant register.
+    float minDirection_[4];
+    /// Maximum emission direction, padded to a constant register.
+    float maxDirection_[4];
+    /// Constant force in the particle space, padded to a constant register.
+    float constantForce_[4];
+    /// Position update scale, padded to a constant register.
+    float positionScale_[4];
+    /// Transform of the spawned particles to the particle space.
+    Matrix3x4 emitTransform_;
+    /// Animation frame colors.
+    float colorFrames_[MAX_GPU_PARTICLE_FRAMES * 4];
+    /// Animation frame color times, four per constant register.
+    float colorTimes_[MAX_GPU_PARTICLE_FRAMES];
+    /// Animation frame texture coordinates as min and max.
+    float textureFrames_[MAX_GPU_PARTICLE_FRAMES * 4];
+    /// Animation frame texture times, four per constant register.
+    float textureTimes_[MAX_GPU_PARTICLE_FRAMES];
+};
 
-// Recursive template code derived from Matthieu M.
-template <class Tuple, size_t Index = std::tuple_size<Tuple>::value - 1> struct HashValueImpl
+/// Maximum number of thread groups in one compute dispatch dimension.
+static const unsigned MAX_COMPUTE_GROUPS = 65535;
+
+/// Index compaction shader constants. Matches the CompactParameters constant buffer.
+struct CompactIndexConstants
 {
-    static void apply(size_t& seed, Tuple const& tuple)
-    {
-        HashValueImpl<Tuple, Index - 1>::apply(seed, tuple);
-        hash_combine(seed, get<Index>(tuple));
-    }
+    /// Number of index ranges.
+    unsigned numRanges_;
+    /// Range copied by the first thread group of the dispatch.
+    unsigned firstRange_;
+    /// Whether the source indices are 32-bit.
+    unsigned largeSourceIndices_;
+    /// Padding to the constant register size.
+    unsigned padding_;
+};
+
+/// Number of texels along each axis written by a texture compute thread group.
+static const unsigned TEXTURE_COMPUTE_GROUP_SIZE = 8;
+
+/// Texture compute shader constants. Matches the ComputeParameters constant buffer.
+struct TextureComputeConstants
+{
+    /// Output size in texels and its inverse.
+    Vector4 outputSize_;
+    /// Parameters of the compute command.
+    Vector4 parameters_[MAX_COMPUTE_PARAMETERS];
 };
 
-template <class Tuple> struct HashValueImpl<Tuple, 0>
+/// Compute shader pipeline with its shader resource binding and constant buffer.
+struct ComputePipeline
 {
-    static void apply(size_t& seed, Tuple const& tuple) { hash_combine(seed, get<0>(tuple)); }
+    /// Pipeline state.
+    Diligent::RefCntAutoPtr<Diligent::IPipelineState> pipeline_;
+    /// Shader resource binding.
+    Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding> binding_;
+    /// Constant buffer.
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> constants_;
+    /// Whether creating the pipeline has failed.
+    bool failed_ = false;
 };
-} // namespace
 
-template <typename... TT> struct hash<std::tuple<TT...>>
+/// Rendering state a pipeline state is created from.
+struct PipelineStateDesc
 {
-    size_t operator()(std::tuple<TT...> const& tt) const
+    /// Return the compact 64-bit pipeline key hashed from the description. Never zero.
+    unsigned long long ToKey() const;
+
+    /// Test for equality with another description.
+    bool operator ==(const PipelineStateDesc& rhs) const
     {
-        size_t seed = 0;
-        HashValueImpl<std::tuple<TT...>>::apply(seed, tt);
-        return seed;
+        return vertexShader_ == rhs.vertexShader_ && pixelShader_ == rhs.pixelShader_ &&
+               vertexDeclarationHash_ == rhs.vertexDeclarationHash_ && blendStateHash_ == rhs.blendStateHash_ &&
+               depthStateHash_ == rhs.depthStateHash_ && rasterizerStateHash_ == rhs.rasterizerStateHash_ &&
+               renderTargetHash_ == rhs.renderTargetHash_ && primitiveType_ == rhs.primitiveType_;
     }
+
+    /// Test for inequality with another description.
+    bool operator !=(const PipelineStateDesc& rhs) const { return !(*this == rhs); }
+
+    /// Return whether uses a shader variation.
+    bool UsesShader(ShaderVariation* variation) const { return vertexShader_ == variation || pixelShader_ == variation; }
+
+    /// Vertex shader variation.
+    ShaderVariation* vertexShader_{};
+    /// Pixel shader variation.
+    ShaderVariation* pixelShader_{};
+    /// Vertex declaration hash.
+    unsigned long long vertexDeclarationHash_{};
+    /// Blend state hash.
+    unsigned blendStateHash_{};
+    /// Depth-stencil state hash.
+    unsigned depthStateHash_{};
+    /// Rasterizer state hash.
+    unsigned rasterizerStateHash_{};
+    /// Render target format hash.
+    unsigned renderTargetHash_{};
+    /// Primitive type.
+    PrimitiveType primitiveType_{};
 };
-} // namespace std
 
-namespace Urho3D
+/// Pipeline state description captured from the rendering state. Self-contained so that the pipeline state can be created on a worker thread.
+struct PipelineStateCreateData
+{
+    /// Diligent pipeline state create info. Points into the storage below.
+    Diligent::GraphicsPipelineStateCreateInfo createInfo_;
+    /// Shader resource variable descriptions.
+    PODVector<Diligent::ShaderResourceVariableDesc> variables_;
+    /// Vertex input layout elements.
+    PODVector<Diligent::LayoutElement> layoutElements_;
+    /// Render device.
+    Diligent::RefCntAutoPtr<Diligent::IRenderDevice> device_;
+    /// Pipeline state cache in use at the time of capture.
+    Diligent::RefCntAutoPtr<Diligent::IPipelineStateCache> pipelineStateCache_;
+    /// Vertex shader object.
+    Diligent::RefCntAutoPtr<Diligent::IShader> vertexShader_;
+    /// Pixel shader object.
+    Diligent::RefCntAutoPtr<Diligent::IShader> pixelShader_;
+    /// Vertex shader variation.
+    ShaderVariation* vertexShaderVariation_{};
+    /// Pixel shader variation.
+    ShaderVariation* pixelShaderVariation_{};
+    /// Rendering state description.
+    PipelineStateDesc desc_;
+    /// Time spent creating the pipeline state in microseconds.
+    long long creationTime_{};
+    /// Work item when created asynchronously.
+    SharedPtr<WorkItem> workItem_;
+    /// Created pipeline state.
+    Diligent::RefCntAutoPtr<Diligent::IPipelineState> pipelineState_;
+};
+
+/// Thread that presents the swap chain of an ended frame while the main thread continues with the update of the next frame.
+class PresentThread : public Thread
 {
+public:
+    /// Construct. The thread is blocked until a frame is queued.
+    explicit PresentThread(GraphicsImpl* impl);
+    /// Destruct. Present a still queued frame and stop the thread.
+    ~PresentThread() override;
 
-#define URHO3D_SAFE_RELEASE(p) if (p) { ((Diligent::IObject*)p)->Release();  p = 0; }
+    /// Queue the ended frame to be presented with the given sync interval. Called on the main thread.
+    void Present(unsigned syncInterval);
+    /// Block until the queued frame has been presented. No-op if no frame is queued. Called on the main thread.
+    void Wait();
+    /// Present queued frames until stopped.
+    void ThreadFunction() override;
 
-#define URHO3D_LOGD3DERROR(msg, hr) URHO3D_LOGERRORF("%s (HRESULT %x)", msg, (unsigned)hr)
+    /// Return whether a frame is queued or being presented.
+    bool IsPending() const { return pending_; }
+
+private:
+    /// Graphics implementation.
+    GraphicsImpl* impl_;
+    /// Mutex held by the main thread while no frame is queued, which blocks the thread.
+    Mutex idleMutex_;
+    /// Number of frames queued.
+    std::atomic<unsigned> numQueued_{};
+    /// Number of frames presented.
+    std::atomic<unsigned> numPresented_{};
+    /// Sync interval of the queued frame.
+    unsigned syncInterval_{};
+    /// Whether the main thread has queued a frame it has not waited for.
+    bool pending_{};
+};
 
 using ShaderProgramMap = HashMap<Pair<ShaderVariation*, ShaderVariation*>, SharedPtr<ShaderProgram> >;
 using VertexDeclarationMap = HashMap<unsigned long long, SharedPtr<VertexDeclaration> >;
@@ -147,18 +423,112 @@ public:
     /// Return Diligent render device type.
     Diligent::RENDER_DEVICE_TYPE GetDeviceType() const { return deviceType_; }
 
+    /// Return Diligent device context used for rendering commands. Waits for a frame being presented on the present thread first.
+    Diligent::RefCntAutoPtr<Diligent::IDeviceContext> GetDeviceContext() const
+    {
+        WaitForPresent();
+        return deviceContext_;
+    }
+
     /// Return Diligent immediate device context.
-    Diligent::RefCntAutoPtr<Diligent::IDeviceContext> GetDeviceContext() const { return deviceContext_; }
+    Diligent::RefCntAutoPtr<Diligent::IDeviceContext> GetImmediateContext() const { return immediateContext_; }
+
+    /// Return Diligent async compute context, or null if the device has no separate compute queue.
+    Diligent::IDeviceContext* GetComputeContext() const { return computeContext_; }
+
+    /// Return the mask of immediate contexts, which resources shared between the graphics and async compute queues need.
+    Diligent::Uint64 GetImmediateContextMask() const { return computeContext_ ? 3 : 1; }
 
     /// Return swapchain.
     Diligent::RefCntAutoPtr<Diligent::ISwapChain> GetSwapChain() const { return swapChain_; }
 
+    /// Return the precompiled shader archive, or null if not loaded.
+    Diligent::IDearchiver* GetShaderArchive() const { return shaderArchive_; }
+
     /// Return whether multisampling is supported for a given texture format and sample count.
     bool CheckMultiSampleSupport(Diligent::TEXTURE_FORMAT format, unsigned sampleCount) const;
 
     /// Return multisample quality level for a given texture format and sample count. The sample count must be supported. On D3D feature level 10.1+, uses the standard level. Below that uses the best quality.
     unsigned GetMultiSampleQuality(Diligent::TEXTURE_FORMAT format, unsigned sampleCount) const;
 
+    /// Write constant data to the constant ring buffer and return its byte offset. Discards the ring buffer first if necessary.
+    unsigned WriteConstantData(const void* data, unsigned size);
+
+    /// Return constant ring buffer epoch. It changes whenever previously written constant data becomes unavailable.
+    unsigned GetConstantRingEpoch() const { return constantRingEpoch_; }
+
+    /// Return constant ring buffer range size for constant data of given size, rounded up to the offset alignment.
+    unsigned GetConstantRingRangeSize(unsigned size) const;
+
+    /// Bind the material's packed constant block for the current shader program. Return false if the block is missing or out of date, in which case the parameters must be set one by one.
+    bool BindMaterialConstants(Material* material);
+
+    /// Pack the material constant buffers of the current shader program into the material's constant block after its parameters have been set.
+    void StoreMaterialConstants(Material* material);
+
+    /// Add the sizes of the buffers owned by the implementation instead of GPU objects to the category stats.
+    void CollectInternalGPUMemory(GPUMemoryStats* stats) const;
+
+    /// Return number of frames ended so far, which identifies the frame being rendered.
+    unsigned GetFrameNumber() const { return (unsigned)frameFenceValue_; }
+
+    /// Return whether dynamic buffer contents persist across frames. On D3D12 and Vulkan they must be rewritten with a discard in every frame they are used.
+    bool IsDynamicDataPersistent() const
+    {
+        return deviceType_ != Diligent::RENDER_DEVICE_TYPE_D3D12 && deviceType_ != Diligent::RENDER_DEVICE_TYPE_VULKAN;
+    }
+
+    /// Copy a texture subresource to a new staging texture readable by the CPU, using the immediate context. Return null if failed.
+    Diligent::RefCntAutoPtr<Diligent::ITexture> CopyToStagingTexture(Diligent::ITexture* source, unsigned mipLevel, unsigned arraySlice);
+
+    /// Copy the backbuffer to a new staging texture readable by the CPU, resolving it first if multisampled. Return null if failed.
+    Diligent::RefCntAutoPtr<Diligent::ITexture> CopyBackbufferToStagingTexture();
+
+    /// Signal the readback fence after all commands submitted so far and flush the immediate context. Return the signaled fence value, or 0 if failed.
+    Diligent::Uint64 SignalReadbackFence();
+
+    /// Return whether the GPU has passed a readback fence value.
+    bool IsReadbackComplete(Diligent::Uint64 fenceValue) const { return readbackFence_ && readbackFence_->GetCompletedValue() >= fenceValue; }
+
+    /// Copy rows of a staging texture to CPU memory. Return true if successful.
+    bool ReadStagingTexture(Diligent::ITexture* stagingTexture, void* dest, unsigned rowSize, unsigned numRows, unsigned numSlices = 1);
+
+    /// Read a texture subresource to CPU memory, blocking until the GPU has finished the copy. Return true if successful.
+    bool ReadTextureData(Diligent::ITexture* source, unsigned mipLevel, unsigned arraySlice, void* dest, unsigned rowSize, unsigned numRows, unsigned numSlices = 1);
+
+    /// Copy data to a static texture subresource region. On D3D12 and Vulkan the data is staged through the upload ring buffer when it has room.
+    void UpdateTextureData(Diligent::ITexture* texture, unsigned mipLevel, unsigned arraySlice, const Diligent::Box& destBox, const void* data, unsigned rowSize, unsigned numRows);
+
+    /// Copy data to a static buffer range. On D3D12 and Vulkan the data is staged through the upload ring buffer when it has room.
+    void UpdateBufferData(Diligent::IBuffer* buffer, unsigned offset, unsigned size, const void* data);
+
+    /// Queue a texture mip level to be uploaded within the per-frame upload budget. The level data must be owned by the image or the data array.
+    void QueueTextureUpload(Texture2D* texture, unsigned level, const void* data, Image* image, const SharedArrayPtr<unsigned char>& ownedData);
+
+    /// Upload queued texture mip levels in queue order until the byte budget is used up. At least one level is uploaded if any are queued.
+    void UpdateTextureUploads(unsigned budget);
+
+    /// Return the 1x1 black texture view sampled in place of textures with pending uploads, created on demand. Return null if failed.
+    Diligent::ITextureView* GetPlaceholderView();
+
+    /// Return whether the device supports timestamp queries.
+    bool IsTimestampQuerySupported() const;
+
+    /// Begin a named GPU timing block by issuing a timestamp on the immediate context.
+    void BeginGPUTiming(const String& name);
+
+    /// End the current GPU timing block.
+    void EndGPUTiming();
+
+    /// End all open GPU timing blocks and queue the timestamps of the frame for resolving.
+    void EndGPUTimingFrame();
+
+    /// Resolve the queued frames whose timestamps are all available, oldest first, and return the timing blocks of the latest one. Return false if no frame was resolved.
+    bool ResolveGPUTimings(Vector<GPUTiming>& timings);
+
+    /// Release all queued and pooled timestamp queries.
+    void ReleaseGPUTimings();
+
     void SetPrimitiveType(const PrimitiveType primitiveType);
 
     Diligent::PRIMITIVE_TOPOLOGY GetPrimitiveTopology();
@@ -171,27 +541,275 @@ private:
 
         struct TextureMapEntry
         {
+            /// Texture unit, BINDLESS_TEXTURE_UNIT for the bindless texture array, or CLUSTER_BUFFER_UNIT onwards for the clustered lighting buffers.
             unsigned textureUnit;
-            Diligent::IShaderResourceVariable* variable;
+            Diligent::SHADER_TYPE shaderType;
+            /// Variable index, valid in all shader resource bindings of the pipeline state.
+            Diligent::Uint32 variableIndex;
         };
         typedef std::vector<TextureMapEntry> TextureMap;
         std::shared_ptr<TextureMap> textureMap_;
+
+        /// Shader resource binding populated with a texture set.
+        struct BindingCacheEntry
+        {
+            /// Bound texture views in texture map order.
+            PODVector<Diligent::ITextureView*> views_;
+            /// Bound samplers in texture map order.
+            PODVector<Diligent::ISampler*> samplers_;
+            /// Hash of the bound bindless textures.
+            unsigned bindlessHash_{};
+            /// Bound clustered lighting buffer views.
+            Diligent::IBufferView* clusterBufferViews_[NUM_CLUSTER_BUFFERS]{};
+            Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding> binding_;
+        };
+        /// Shader resource bindings keyed by texture set hash.
+        typedef HashMap<unsigned, BindingCacheEntry> BindingCache;
+        std::shared_ptr<BindingCache> bindingCache_;
+
+        struct ConstantBufferMapEntry
+        {
+            ShaderType shaderType;
+            unsigned group;
+            /// Bound range size in the constant ring buffer.
+            unsigned rangeSize;
+            Diligent::SHADER_TYPE variableShaderType;
+            /// Variable index, valid in all shader resource bindings of the pipeline state.
+            Diligent::Uint32 variableIndex;
+        };
+        typedef std::vector<ConstantBufferMapEntry> ConstantBufferMap;
+        std::shared_ptr<ConstantBufferMap> constantBufferMap_;
+    };
+
+    /// Open addressing pipeline state table slot.
+    struct PipelineStateSlot
+    {
+        /// Compact pipeline key, zero if the slot is empty.
+        unsigned long long key_;
+        /// Full description, compared on lookup in case of key collisions.
+        PipelineStateDesc desc_;
+        /// Pipeline state.
+        PipelineState state_;
     };
 
-    #ifdef USE_WAIT_FOR_IDLE_WORKAROUND
-    std::unique_ptr<std::thread> waitForIdleThread_;
-    #endif
+    /// Create the shader resource binding and texture map for a newly created pipeline state.
+    PipelineState CreatePipelineStateBindings(Graphics* graphics, const PipelineStateCreateData& data);
+    /// Return pipeline state by key and description, or null if not found.
+    PipelineState* FindPipelineState(unsigned long long key, const PipelineStateDesc& desc);
+    /// Store a newly created pipeline state and return it. The pointer is valid until the table is modified. If creation had failed, store and return an entry with a null pipeline state, so that it is not created again.
+    PipelineState* AddPipelineState(Graphics* graphics, const PipelineStateCreateData& data);
+    /// Remove all pipeline states created from a shader variation. Return number of pipeline states removed.
+    unsigned RemovePipelineStates(ShaderVariation* variation);
+    /// Remove the pipeline state in a table slot, moving the following colliding entries back to keep their probe sequences intact.
+    void RemovePipelineStateSlot(unsigned index);
+    /// Resize the pipeline state table and reinsert all pipeline states.
+    void ResizePipelineStateTable(unsigned numSlots);
+    /// Return a shader resource binding of the current pipeline state populated with the current textures, creating it if not cached. Transition the textures for shader access if necessary.
+    Diligent::IShaderResourceBinding* PrepareShaderResourceBinding();
+    /// Queue a transition of a texture to be readable by shaders if necessary.
+    void AddShaderResourceTransition(Diligent::ITextureView* view);
+    /// Mark the shader resource binding to be checked on the next draw without a texture unit having changed.
+    void MarkShaderResourcesDirty()
+    {
+        if (firstDirtyTexture_ == M_MAX_UNSIGNED)
+            firstDirtyTexture_ = lastDirtyTexture_ = 0;
+        texturesDirty_ = true;
+    }
+    /// Upload data to a clustered lighting structured buffer, growing it if necessary. Return true on success.
+    bool UpdateClusterBuffer(unsigned index, const void* data, unsigned size, unsigned stride);
+    /// Create a compute pipeline from HLSL source with a CS entry point and a single dynamic constant buffer. Marks the pipeline failed on error. Return true on success.
+    bool CreateComputePipeline(ComputePipeline& pipeline, const char* name, const String& source, const char* constantsName,
+        unsigned constantsSize, Diligent::Uint64 immediateContextMask = 1);
+    /// Upload constants and dispatch a compute pipeline whose other resources have been set. Return true on success.
+    bool DispatchComputePipeline(ComputePipeline& pipeline, const void* constants, unsigned constantsSize, unsigned numGroups,
+        unsigned numGroupsY = 1);
+    /// Dispatch a texture compute pipeline whose textures have been set over the output texture. When async, submit it to the compute queue after the graphics work so far if the textures are shared with it. Return true on success.
+    bool DispatchTextureCompute(ComputePipeline& pipeline, const TextureComputeConstants& constants, Diligent::ITexture* const* inputs,
+        unsigned numInputs, Diligent::ITexture* output, bool async, bool& dispatchedAsync);
+    /// Make the immediate context wait on the GPU for the work submitted to the compute queue.
+    void WaitComputeQueue();
+    /// Skin vertices between raw vertex buffers with the compute skinning pipeline. Return true on success.
+    bool DispatchSkinning(Diligent::IBuffer* source, Diligent::IBuffer* dest, const SkinningConstants& constants,
+        const Matrix3x4* skinMatrices, unsigned numSkinMatrices);
+    /// Morph vertices between raw vertex buffers with the compute morph pipeline. Return true on success.
+    bool DispatchMorph(Diligent::IBuffer* source, Diligent::IBuffer* dest, Diligent::IBuffer* deltas, const MorphConstants& constants);
+    /// Spawn and simulate particles between a raw state buffer and a raw vertex buffer with the GPU particle pipeline. Return true on success.
+    bool DispatchParticles(Diligent::IBuffer* states, Diligent::IBuffer* dest, const ParticleConstants& constants);
+    /// Copy index ranges between raw index buffers with the index compaction pipeline, one thread group per range. Return true on success.
+    bool DispatchCompactIndices(Diligent::IBuffer* source, Diligent::IBuffer* dest, CompactIndexConstants& constants,
+        const unsigned* ranges);
+    /// Upload the constant buffers used by the current shader program and set their offsets in the current shader resource binding.
+    void CommitConstantBuffers();
+    /// Create the constant ring buffer.
+    bool CreateConstantRingBuffer();
+    /// Make all previously written constant data unavailable, so that it is rewritten to a newly discarded ring buffer. Called at frame end and on device context change.
+    void InvalidateConstantRing();
+    /// Signal the readback fence after a staging texture copy and queue it as an asynchronous readback. Return request ID, or 0 if failed.
+    unsigned QueueReadback(Diligent::ITexture* stagingTexture, Texture2D* texture, unsigned level);
+    /// Allocate an aligned region of the upload ring buffer for the frame being rendered, creating the buffer on demand. Return false if there is no room.
+    bool AllocateUploadRing(unsigned size, unsigned& offset);
+    /// Issue a timestamp on the immediate context using a pooled query. Return null if failed.
+    Diligent::RefCntAutoPtr<Diligent::IQuery> IssueTimestamp();
+    /// Signal the frame fence after the commands of the frame being ended.
+    void SignalFrameFence();
+    /// Block until the GPU is at most the given number of frames behind, so that the next frame's per-frame resources are no longer in use.
+    void WaitForFramesInFlight(unsigned maxFramesInFlight);
+    /// Create or destroy the present thread. Not created for OpenGL devices, whose context is bound to the creating thread.
+    void SetPresentThread(bool enable);
+    /// Present the swap chain. Called on the present thread when it exists.
+    void PresentFrame(unsigned syncInterval);
+    /// Block until the frame queued to the present thread has been presented, so that the immediate context may be used again.
+    void WaitForPresent() const
+    {
+        if (presentThread_)
+            presentThread_->Wait();
+    }
+    /// Take ownership of the immediate and async compute device contexts returned on device creation.
+    void SetDeviceContexts(Diligent::IDeviceContext** contexts, unsigned numImmediateContexts);
 
     Diligent::SwapChainDesc swapChainInitDesc_;
     Diligent::RefCntAutoPtr<Diligent::IRenderDevice> device_;
     Diligent::RefCntAutoPtr<Diligent::IDeviceContext> deviceContext_;
+    /// Immediate device context.
+    Diligent::RefCntAutoPtr<Diligent::IDeviceContext> immediateContext_;
+    /// Async compute immediate context on a separate compute queue, or null if not created.
+    Diligent::RefCntAutoPtr<Diligent::IDeviceContext> computeContext_;
     Diligent::RefCntAutoPtr<Diligent::ISwapChain> swapChain_;
-    std::unordered_map<
-        std::tuple<ShaderVariation*, ShaderVariation*, unsigned, unsigned, unsigned, unsigned long long, PrimitiveType, uint32_t>,
-        PipelineState> pipelineStates_;
+    /// Open addressing pipeline state table with linear probing. Size is zero or a power of two.
+    Vector<PipelineStateSlot> pipelineStates_;
+    /// Number of pipeline states in the table.
+    unsigned numPipelineStates_ = 0;
+    /// Pipeline states being created on worker threads, keyed by compact pipeline key.
+    std::unordered_map<unsigned long long, std::unique_ptr<PipelineStateCreateData>> pendingPipelineStates_;
+    /// Pipeline state for the current draw is not available yet flag.
+    bool pipelineStatePending_ = false;
+    /// Pipeline state cache passed to every created pipeline state. Null if the device does not support it.
+    Diligent::RefCntAutoPtr<Diligent::IPipelineStateCache> pipelineStateCache_;
+    /// Shader bytecode hashes the pipeline state cache was built with, keyed by shader variation name hash.
+    HashMap<StringHash, unsigned> pipelineStateCacheShaders_;
+    /// Pipeline state cache load attempted flag.
+    bool pipelineStateCacheLoaded_ = false;
+    /// Pipeline state cache has new entries flag.
+    bool pipelineStateCacheDirty_ = false;
+    /// Precompiled shader archive for the device type.
+    Diligent::RefCntAutoPtr<Diligent::IDearchiver> shaderArchive_;
     Diligent::RefCntAutoPtr<Diligent::IPipelineState> currentPipelineState_;
     Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding> currentShaderResourceBinding_;
     std::shared_ptr<PipelineState::TextureMap> currentTextureMap_;
+    std::shared_ptr<PipelineState::BindingCache> currentBindingCache_;
+    std::shared_ptr<PipelineState::ConstantBufferMap> currentConstantBufferMap_;
+    /// Shader resource binding the constant ring buffer offsets were last set in.
+    Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding> constantOffsetsBinding_;
+    /// Constant ring buffer offsets last set in the shader resource binding.
+    unsigned constantOffsets_[2][MAX_SHADER_PARAMETER_GROUPS];
+    /// Dynamic buffer all constant data is sub-allocated from.
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> constantRingBuffer_;
+    /// Next free byte offset in the constant ring buffer.
+    unsigned constantRingOffset_ = 0;
+    /// Required alignment of constant buffer offsets.
+    unsigned constantRingAlignment_ = 256;
+    /// Constant ring buffer epoch.
+    unsigned constantRingEpoch_ = 1;
+    /// Constant ring buffer must be discarded before next write flag.
+    bool constantRingDiscardPending_ = true;
+    /// Fence signaled at the end of every frame, created on demand.
+    Diligent::RefCntAutoPtr<Diligent::IFence> frameFence_;
+    /// Last signaled frame fence value, equal to the number of frames ended.
+    Diligent::Uint64 frameFenceValue_ = 0;
+    /// Thread presenting the swap chain when frames are pipelined, or null.
+    UniquePtr<PresentThread> presentThread_;
+    /// Asynchronous readback waiting for the GPU.
+    struct PendingReadback
+    {
+        /// Request ID.
+        unsigned id_;
+        /// Staging texture the data was copied to.
+        Diligent::RefCntAutoPtr<Diligent::ITexture> stagingTexture_;
+        /// Readback fence value signaled after the copy.
+        Diligent::Uint64 fenceValue_;
+        /// Source texture, null for a screenshot.
+        WeakPtr<Texture2D> texture_;
+        /// Source mip level.
+        unsigned level_;
+        /// Whether the backbuffer was copied.
+        bool screenShot_;
+    };
+    /// Asynchronous readbacks in request order.
+    Vector<PendingReadback> pendingReadbacks_;
+    /// Fence signaled after readback copies, created on demand.
+    Diligent::RefCntAutoPtr<Diligent::IFence> readbackFence_;
+    /// Last signaled readback fence value.
+    Diligent::Uint64 readbackFenceValue_ = 0;
+    /// Next asynchronous readback request ID.
+    unsigned nextReadbackId_ = 1;
+    /// Fence signaled on the graphics queue before async compute work that depends on it, created on demand.
+    Diligent::RefCntAutoPtr<Diligent::IFence> graphicsQueueFence_;
+    /// Last signaled graphics queue fence value.
+    Diligent::Uint64 graphicsQueueFenceValue_ = 0;
+    /// Fence signaled on the compute queue after async compute work, created on demand.
+    Diligent::RefCntAutoPtr<Diligent::IFence> computeQueueFence_;
+    /// Last signaled compute queue fence value.
+    Diligent::Uint64 computeQueueFenceValue_ = 0;
+    /// Texture mip level waiting to be uploaded.
+    struct PendingTextureUpload
+    {
+        /// Destination texture.
+        WeakPtr<Texture2D> texture_;
+        /// GPU texture the upload was queued for. The upload is dropped if the texture has been recreated since.
+        Diligent::RefCntAutoPtr<Diligent::ITexture> object_;
+        /// Mip level.
+        unsigned level_;
+        /// Level data.
+        const void* data_;
+        /// Image owning the level data.
+        SharedPtr<Image> image_;
+        /// Decompressed level data, if not owned by the image.
+        SharedArrayPtr<unsigned char> ownedData_;
+    };
+    /// Texture uploads in queue order.
+    Vector<PendingTextureUpload> pendingTextureUploads_;
+    /// Region of the upload ring buffer in use by the GPU.
+    struct UploadRingRegion
+    {
+        /// Start byte offset.
+        unsigned start_;
+        /// End byte offset.
+        unsigned end_;
+        /// Frame fence value after which the region is free.
+        Diligent::Uint64 frame_;
+    };
+    /// Staging buffer static texture and buffer data is copied from on D3D12 and Vulkan, created on demand.
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> uploadRingBuffer_;
+    /// Regions of the upload ring buffer in use, oldest first.
+    PODVector<UploadRingRegion> uploadRingRegions_;
+    /// End byte offset of the newest upload ring buffer region.
+    unsigned uploadRingHead_ = 0;
+    /// Upload ring buffer creation failed flag.
+    bool uploadRingFailed_ = false;
+    /// Texture sampled in place of textures with pending uploads.
+    Diligent::RefCntAutoPtr<Diligent::ITexture> placeholderTexture_;
+    /// Timestamp queries of a GPU timing block.
+    struct GPUTimingQuery
+    {
+        /// Block name.
+        String name_;
+        /// Nesting depth.
+        unsigned depth_;
+        /// Timestamp issued when the block began.
+        Diligent::RefCntAutoPtr<Diligent::IQuery> begin_;
+        /// Timestamp issued when the block ended, null while the block is open.
+        Diligent::RefCntAutoPtr<Diligent::IQuery> end_;
+    };
+    /// GPU timing blocks of the frame being rendered.
+    Vector<GPUTimingQuery> gpuTimingQueries_;
+    /// Indices of the open GPU timing blocks, M_MAX_UNSIGNED for a skipped block.
+    PODVector<unsigned> gpuTimingStack_;
+    /// GPU timing blocks of the ended frames waiting for the GPU, oldest first.
+    Vector<Vector<GPUTimingQuery> > pendingGPUTimings_;
+    /// Timestamp queries whose results have been read and which can be issued again.
+    Vector<Diligent::RefCntAutoPtr<Diligent::IQuery> > freeTimestampQueries_;
+    /// Texture transitions collected when preparing a shader resource binding.
+    PODVector<Diligent::StateTransitionDesc> textureTransitions_;
     Diligent::RENDER_DEVICE_TYPE deviceType_ = Diligent::RENDER_DEVICE_TYPE_D3D11;
 
     /// Default (backbuffer) rendertarget view.
@@ -236,11 +854,35 @@ private:
     Diligent::ITextureView* shaderResourceViews_[MAX_TEXTURE_UNITS];
     /// Bound sampler state objects.
     Diligent::ISampler* samplers_[MAX_TEXTURE_UNITS];
+    /// Bound bindless texture views, with their samplers set.
+    PODVector<Diligent::ITextureView*> bindlessViews_;
+    /// Hash of the bound bindless texture views and samplers.
+    unsigned bindlessTexturesHash_ = 0;
+    /// Bindless texture views padded to the shader array size.
+    PODVector<Diligent::IDeviceObject*> bindlessObjects_;
+    /// Clustered lighting structured buffers.
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> clusterBuffers_[NUM_CLUSTER_BUFFERS];
+    /// Shader resource views of the clustered lighting structured buffers.
+    Diligent::IBufferView* clusterBufferViews_[NUM_CLUSTER_BUFFERS]{};
+    /// Compute skinning pipeline.
+    ComputePipeline skinningPipeline_;
+    /// Compute skinning matrix structured buffer.
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> skinMatrixBuffer_;
+    /// Compute morph pipeline.
+    ComputePipeline morphPipeline_;
+    /// GPU particle pipeline.
+    ComputePipeline particlePipeline_;
+    /// Index compaction pipeline.
+    ComputePipeline compactIndexPipeline_;
+    /// Index compaction range structured buffer.
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> compactRangeBuffer_;
+    /// Texture compute pipelines of renderpath compute commands, keyed by shader name and defines.
+    HashMap<StringHash, ComputePipeline> textureComputePipelines_;
 
     /// Bound vertex buffers.
     Diligent::IBuffer* vertexBuffers_[MAX_VERTEX_STREAMS];
     /// Bound constant buffers.
-    Diligent::IBuffer* constantBuffers_[2][MAX_SHADER_PARAMETER_GROUPS];
+    ConstantBuffer* constantBuffers_[2][MAX_SHADER_PARAMETER_GROUPS];
     /// Vertex sizes per buffer.
     unsigned vertexSizes_[MAX_VERTEX_STREAMS];
     /// Vertex stream offsets per buffer.
@@ -253,8 +895,6 @@ private:
 
     /// Constant buffer search map.
     ConstantBufferMap allConstantBuffers_;
-    /// Currently dirty constant buffers.
-    PODVector<ConstantBuffer*> dirtyConstantBuffers_;
     /// Shader programs.
     ShaderProgramMap shaderPrograms_;
     /// Shader program in use.
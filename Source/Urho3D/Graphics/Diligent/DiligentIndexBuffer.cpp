@@ -69,6 +69,7 @@ bool IndexBuffer::SetData(const void* data)
         return false;
     }
 
+    ++dataRevision_;
     if (shadowData_ && data != shadowData_.Get())
         memcpy(shadowData_.Get(), data, indexCount_ * indexSize_);
 
@@ -87,10 +88,7 @@ bool IndexBuffer::SetData(const void* data)
         }
         else
         {
-            // TODO: Make sure transition mode is correct
-            graphics_->GetImpl()->GetDeviceContext()->UpdateBuffer(
-                (IBuffer*)object_.ptr_, 0, indexCount_ * indexSize_,
-                data, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            graphics_->GetImpl()->UpdateBufferData((IBuffer*)object_.ptr_, 0, indexCount_ * indexSize_, data);
         }
     }
 
@@ -123,6 +121,7 @@ bool IndexBuffer::SetDataRange(const void* data, unsigned start, unsigned count,
     if (!count)
         return true;
 
+    ++dataRevision_;
     if (shadowData_ && shadowData_.Get() + start * indexSize_ != data)
         memcpy(shadowData_.Get() + start * indexSize_, data, count * indexSize_);
 
@@ -141,9 +140,7 @@ bool IndexBuffer::SetDataRange(const void* data, unsigned start, unsigned count,
         }
         else
         {
-            graphics_->GetImpl()->GetDeviceContext()->UpdateBuffer((IBuffer*)object_.ptr_, start * indexSize_,
-                                                                   count * indexSize_, data,
-                                                                   RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            graphics_->GetImpl()->UpdateBufferData((IBuffer*)object_.ptr_, start * indexSize_, count * indexSize_, data);
         }
     }
 
@@ -223,6 +220,7 @@ void IndexBuffer::Unlock()
 bool IndexBuffer::Create()
 {
     Release();
+    discardFrame_ = M_MAX_UNSIGNED;
 
     if (!indexCount_)
         return true;
@@ -236,6 +234,14 @@ bool IndexBuffer::Create()
         bufferDesc.Usage = dynamic_ ? USAGE_DYNAMIC : USAGE_DEFAULT;
         bufferDesc.Size = (UINT)(indexCount_ * indexSize_);
 
+        // Compute shaders address the indices as raw data, in whole 32-bit words
+        if (computeAccess_ && !dynamic_)
+        {
+            bufferDesc.BindFlags |= BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+            bufferDesc.Mode = BUFFER_MODE_RAW;
+            bufferDesc.Size = (bufferDesc.Size + 3) & ~3u;
+        }
+
         graphics_->GetImpl()->GetDevice()->CreateBuffer(bufferDesc, nullptr, (IBuffer**)&object_.ptr_);
         if (object_.ptr_ == nullptr)
         {
@@ -267,15 +273,32 @@ void* IndexBuffer::MapBuffer(unsigned start, unsigned count, bool discard)
 
     if (object_.ptr_)
     {
+        GraphicsImpl* impl = graphics_->GetImpl();
+        const unsigned frameNumber = impl->GetFrameNumber();
+
+        // On D3D12 and Vulkan the first map of a dynamic buffer in each frame must discard. Keep the rest of the
+        // contents by restoring them from shadow data
+        bool restore = false;
+        if (!discard && discardFrame_ != frameNumber && !impl->IsDynamicDataPersistent())
+        {
+            discard = true;
+            restore = true;
+        }
+
         PVoid mappedData = nullptr;
 
-        graphics_->GetImpl()->GetDeviceContext()->MapBuffer((IBuffer*)object_.ptr_, MAP_WRITE,
-                                                            discard ? MAP_FLAG_DISCARD : MAP_FLAG_NONE, mappedData);
+        impl->GetDeviceContext()->MapBuffer((IBuffer*)object_.ptr_, MAP_WRITE,
+                                            discard ? MAP_FLAG_DISCARD : MAP_FLAG_NO_OVERWRITE, mappedData);
         if (mappedData == nullptr)
             URHO3D_LOGERROR("Failed to map index buffer");
         else
         {
-            hwData = mappedData;
+            if (discard)
+                discardFrame_ = frameNumber;
+            if (restore && shadowData_)
+                memcpy(mappedData, shadowData_.Get(), indexCount_ * indexSize_);
+
+            hwData = (unsigned char*)mappedData + start * indexSize_;
             lockState_ = LOCK_HARDWARE;
         }
     }
@@ -283,6 +306,26 @@ void* IndexBuffer::MapBuffer(unsigned start, unsigned count, bool discard)
     return hwData;
 }
 
+void IndexBuffer::RestoreDynamicData()
+{
+    if (!dynamic_ || !object_.ptr_ || discardFrame_ == graphics_->GetImpl()->GetFrameNumber())
+        return;
+
+    if (shadowData_)
+        SetData(shadowData_.Get());
+    else
+    {
+        // Without shadow data the contents can not be restored
+        static bool warned = false;
+        if (!warned)
+        {
+            URHO3D_LOGWARNING("Dynamic index buffer without shadow data used in a later frame than written, contents are undefined");
+            warned = true;
+        }
+        discardFrame_ = graphics_->GetImpl()->GetFrameNumber();
+    }
+}
+
 void IndexBuffer::UnmapBuffer()
 {
     if (object_.ptr_ && lockState_ == LOCK_HARDWARE)
@@ -69,6 +69,25 @@ public:
 
         // Optimize shader parameter lookup by rehashing to next power of two
         parameters_.Rehash(NextPowerOfTwo(parameters_.Size()));
+
+        // Hash the material constant buffer layout, so that materials can keep their parameters packed per layout
+        if (vsConstantBuffers_[SP_MATERIAL] || psConstantBuffers_[SP_MATERIAL])
+        {
+            // Sum the parameter hashes so that the order of the parameters does not matter
+            materialLayoutHash_ = HashLayoutValue(vsBufferSizes[SP_MATERIAL], psBufferSizes[SP_MATERIAL]);
+            for (HashMap<StringHash, ShaderParameter>::ConstIterator i = vsParams.Begin(); i != vsParams.End(); ++i)
+            {
+                if (i->second_.buffer_ == SP_MATERIAL)
+                    materialLayoutHash_ += HashLayoutValue(i->first_.Value(), i->second_.offset_);
+            }
+            for (HashMap<StringHash, ShaderParameter>::ConstIterator i = psParams.Begin(); i != psParams.End(); ++i)
+            {
+                if (i->second_.buffer_ == SP_MATERIAL)
+                    materialLayoutHash_ += HashLayoutValue(i->first_.Value() + 1, i->second_.offset_);
+            }
+            if (!materialLayoutHash_)
+                materialLayoutHash_ = 1;
+        }
     }
 
     /// Destruct.
@@ -82,6 +101,12 @@ public:
     SharedPtr<ConstantBuffer> vsConstantBuffers_[MAX_SHADER_PARAMETER_GROUPS];
     /// Pixel shader constant buffers.
     SharedPtr<ConstantBuffer> psConstantBuffers_[MAX_SHADER_PARAMETER_GROUPS];
+    /// Hash of the material constant buffer layout, or zero if the program has no material constant buffers.
+    unsigned materialLayoutHash_{};
+
+private:
+    /// Combine two values into a layout hash.
+    static unsigned HashLayoutValue(unsigned a, unsigned b) { return (a * 2654435761u) ^ (b * 40503u + 0x9e3779b9u); }
 };
 
 }
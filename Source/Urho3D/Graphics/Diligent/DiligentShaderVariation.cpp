@@ -122,6 +122,99 @@ std::unordered_map<std::string, uint32_t> ShaderVariation::semanticsToAttribs =
 
 // clang-format on
 
+String GetShaderArchiveName(const ShaderVariation* variation)
+{
+    // Vertex and pixel shader variations of the same file share the full name
+    return String(variation->GetShaderType() == VS ? "VS " : "PS ") + variation->GetFullName();
+}
+
+void FillShaderCreateInfo(const ShaderVariation* variation, RENDER_DEVICE_TYPE deviceType, const String& name,
+    ShaderMacroHelper& macros, ShaderCreateInfo& createInfo)
+{
+    const ShaderType type = variation->GetShaderType();
+    const String& sourceCode = variation->GetOwner()->GetSourceCode(type);
+    Vector<String> defines = variation->GetDefines().Split(' ');
+
+    // Set the entrypoint according to the shader being compiled
+    const char* entryPoint = nullptr;
+
+    defines.Push("DILIGENT");
+
+    if (type == VS)
+    {
+        entryPoint = "VS";
+        defines.Push("COMPILEVS");
+    }
+    else
+    {
+        entryPoint = "PS";
+        defines.Push("COMPILEPS");
+    }
+
+    defines.Push("MAXBONES=" + String(Graphics::GetMaxBones()));
+
+    // Bindless variations index a texture array per instance
+    const bool bindless = defines.Contains("BINDLESS");
+    if (bindless)
+        defines.Push("MAXBINDLESSTEXTURES=" + String(MAX_BINDLESS_TEXTURES));
+
+    // Clustered variations index the light grid
+    if (defines.Contains("CLUSTERED"))
+    {
+        defines.Push("CLUSTERGRIDX=" + String(CLUSTER_GRID_X));
+        defines.Push("CLUSTERGRIDY=" + String(CLUSTER_GRID_Y));
+        defines.Push("CLUSTERGRIDZ=" + String(CLUSTER_GRID_Z));
+    }
+
+    // Collect defines into macros
+    Vector<String> defineValues;
+
+    for (unsigned i = 0; i < defines.Size(); ++i)
+    {
+        unsigned equalsPos = defines[i].Find('=');
+        if (equalsPos != String::NPOS)
+        {
+            defineValues.Push(defines[i].Substring(equalsPos + 1));
+            defines[i].Resize(equalsPos);
+        }
+        else
+            defineValues.Push("1");
+    }
+    for (unsigned i = 0; i < defines.Size(); ++i)
+    {
+        macros.AddShaderMacro(defines[i].CString(), defineValues[i].CString());
+
+        // In debug mode, check that all defines are referenced by the shader code
+#ifdef _DEBUG
+        if (sourceCode.Find(defines[i]) == String::NPOS)
+            URHO3D_LOGWARNING("Shader " + variation->GetFullName() + " does not use the define " + defines[i]);
+#endif
+    }
+
+    if (deviceType == RENDER_DEVICE_TYPE_VULKAN)
+    {
+        for (const auto& semanticsToAttrib : ShaderVariation::semanticsToAttribs)
+        {
+            std::string semanticName =
+                std::string("ATTRIB") + std::to_string(semanticsToAttrib.second);
+            macros.AddShaderMacro(semanticsToAttrib.first.c_str(), semanticName.c_str());
+        }
+    }
+
+    createInfo.Desc.Name = name.CString();
+    createInfo.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    createInfo.Desc.UseCombinedTextureSamplers = true;
+    createInfo.Desc.CombinedSamplerSuffix = "_sampler";
+    createInfo.Desc.ShaderType = type == VS ? SHADER_TYPE_VERTEX : SHADER_TYPE_PIXEL;
+    createInfo.EntryPoint = entryPoint;
+    createInfo.Source = sourceCode.CString();
+    createInfo.SourceLength = sourceCode.Length();
+    createInfo.Macros = macros;
+    createInfo.LoadConstantBufferReflection = true;
+    // Non-uniform resource indexing needs shader model 5.1
+    createInfo.HLSLVersion = bindless ? ShaderVersion{5, 1} : ShaderVersion{5, 0};
+}
+
 void ShaderVariation::OnDeviceLost()
 {
     // No-op on Diligent
@@ -170,26 +263,42 @@ bool ShaderVariation::Create()
                               getDeviceTypeName(graphics_->GetImpl()->GetDeviceType()) + "_" +
                               StringHash(defines_).ToString() + extension;
 
-    if (!LoadByteCode(binaryShaderName))
+    // Prefer the precompiled shader from the shader archive if it contains this variation
+    IDearchiver* shaderArchive = graphics_->GetImpl()->GetShaderArchive();
+    if (shaderArchive)
+    {
+        const String archiveName = GetShaderArchiveName(this);
+        ShaderUnpackInfo unpackInfo;
+        unpackInfo.pDevice = graphics_->GetImpl()->GetDevice();
+        unpackInfo.Name = archiveName.CString();
+        shaderArchive->UnpackShader(unpackInfo, (IShader**)&object_.ptr_);
+        if (object_.ptr_)
+            URHO3D_LOGDEBUG("Unpacked precompiled shader " + GetFullName());
+    }
+
+    if (!object_.ptr_)
     {
-        // Compile shader if don't have valid bytecode
-        if (CompileToBinary())
+        if (!LoadByteCode(binaryShaderName))
         {
-            // Save the bytecode after successful compile, but not if the source is from a package
-            if (owner_->GetTimeStamp())
-                SaveByteCode(binaryShaderName);
+            // Compile shader if don't have valid bytecode
+            if (CompileToBinary())
+            {
+                // Save the bytecode after successful compile, but not if the source is from a package
+                if (owner_->GetTimeStamp())
+                    SaveByteCode(binaryShaderName);
 
-            CreateFromBinary();
+                CreateFromBinary();
+            }
+            else
+            {
+                CreateFromSource();
+            }
         }
         else
         {
             CreateFromSource();
         }
     }
-    else
-    {
-        CreateFromSource();
-    }
 
     // Update parameters
     if (object_.ptr_ != nullptr)
@@ -298,23 +407,23 @@ bool ShaderVariation::Create()
 
 void ShaderVariation::Release()
 {
-#if 0
     if (object_.ptr_)
     {
-        if (!graphics_)
-            return;
-
-        graphics_->CleanupShaderPrograms(this);
-
-        if (type_ == VS)
-        {
-            if (graphics_->GetVertexShader() == this)
-                graphics_->SetShaders(nullptr, nullptr);
-        }
-        else
+        if (graphics_)
         {
-            if (graphics_->GetPixelShader() == this)
-                graphics_->SetShaders(nullptr, nullptr);
+            // Shader programs and pipeline states created from this variation refer to its shader object
+            graphics_->CleanupShaderPrograms(this);
+
+            if (type_ == VS)
+            {
+                if (graphics_->GetVertexShader() == this)
+                    graphics_->SetShaders(nullptr, nullptr);
+            }
+            else
+            {
+                if (graphics_->GetPixelShader() == this)
+                    graphics_->SetShaders(nullptr, nullptr);
+            }
         }
 
         URHO3D_SAFE_RELEASE(object_.ptr_);
@@ -322,16 +431,6 @@ void ShaderVariation::Release()
 
     compilerOutput_.Clear();
 
-    for (unsigned i = 0; i < MAX_TEXTURE_UNITS; ++i)
-        useTextureUnits_[i] = false;
-    for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS; ++i)
-        constantBufferSizes_[i] = 0;
-    parameters_.Clear();
-    byteCode_.Clear();
-    elementHash_ = 0;
-#else
-    PARTIALLY_IMPLEMENTED();
-
     for (unsigned i = 0; i < MAX_TEXTURE_UNITS; ++i)
         useTextureUnits_[i] = false;
     for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS; ++i)
@@ -341,7 +440,6 @@ void ShaderVariation::Release()
     }
     parameters_.Clear();
     elementHash_ = 0;
-#endif
 }
 
 void ShaderVariation::SetDefines(const String& defines)
@@ -694,94 +792,10 @@ void ShaderVariation::CreateFromBinary()
 
 void ShaderVariation::CreateFromSource()
 {
-    const String& sourceCode = owner_->GetSourceCode(type_);
-    Vector<String> defines = defines_.Split(' ');
-
-    // Set the entrypoint, profile and flags according to the shader being compiled
-    const char* entryPoint = nullptr;
-    const char* profile = nullptr;
-    unsigned flags = D3DCOMPILE_OPTIMIZATION_LEVEL3;
-
-    defines.Push("DILIGENT");
-
-    if (type_ == VS)
-    {
-        entryPoint = "VS";
-        defines.Push("COMPILEVS");
-        profile = "vs_4_0";
-    }
-    else
-    {
-        entryPoint = "PS";
-        defines.Push("COMPILEPS");
-        profile = "ps_4_0";
-        flags |= D3DCOMPILE_PREFER_FLOW_CONTROL;
-    }
-
-    defines.Push("MAXBONES=" + String(Graphics::GetMaxBones()));
-
-    // Collect defines into macros
-    Vector<String> defineValues;
+    const String shaderFullName = GetFullName();
     ShaderMacroHelper macros;
-
-    for (unsigned i = 0; i < defines.Size(); ++i)
-    {
-        unsigned equalsPos = defines[i].Find('=');
-        if (equalsPos != String::NPOS)
-        {
-            defineValues.Push(defines[i].Substring(equalsPos + 1));
-            defines[i].Resize(equalsPos);
-        }
-        else
-            defineValues.Push("1");
-    }
-    for (unsigned i = 0; i < defines.Size(); ++i)
-    {
-        macros.AddShaderMacro(defines[i].CString(), defineValues[i].CString());
-
-        // In debug mode, check that all defines are referenced by the shader code
-#ifdef _DEBUG
-        if (sourceCode.Find(defines[i]) == String::NPOS)
-            URHO3D_LOGWARNING("Shader " + GetFullName() + " does not use the define " + defines[i]);
-#endif
-    }
-
-    if (graphics_->GetImpl()->GetDeviceType() == RENDER_DEVICE_TYPE_VULKAN)
-    {
-        for (const auto& semanticsToAttrib : semanticsToAttribs)
-        {
-            std::string semanticName =
-                std::string("ATTRIB") + std::to_string(semanticsToAttrib.second);
-            macros.AddShaderMacro(semanticsToAttrib.first.c_str(), semanticName.c_str());
-        }
-    }
-
-    auto shaderFullName = GetFullName();
-
     ShaderCreateInfo shaderCreateInfo;
-    // TODO: Remove
-//    memset(&shaderCreateInfo, 0, sizeof(shaderCreateInfo));
-    shaderCreateInfo.Desc.Name = shaderFullName.CString();
-    shaderCreateInfo.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
-    shaderCreateInfo.Desc.UseCombinedTextureSamplers = true;
-    shaderCreateInfo.Desc.CombinedSamplerSuffix = "_sampler";
-    shaderCreateInfo.Desc.ShaderType = type_ == VS ? SHADER_TYPE_VERTEX : SHADER_TYPE_PIXEL;
-    shaderCreateInfo.EntryPoint = entryPoint;
-    shaderCreateInfo.Source = sourceCode.CString();
-    shaderCreateInfo.SourceLength = sourceCode.Length();
-    shaderCreateInfo.Macros = macros;
-    shaderCreateInfo.LoadConstantBufferReflection = true;
-    shaderCreateInfo.HLSLVersion = {5, 0};
-
-    // TODO: Remove
-#if 0
-    const String fileName = GetFullName() + "_source_code_" + (type_ == VS ? "vs" : "ps") + ".txt";
-    const char* fileNameCString = fileName.CString();
-    const char* sourceCodeCString = sourceCode.CString();
-    FILE* f = fopen(fileNameCString, "w");
-    fprintf(f, "%s", sourceCodeCString);
-    fclose(f);
-#endif
+    FillShaderCreateInfo(this, graphics_->GetImpl()->GetDeviceType(), shaderFullName, macros, shaderCreateInfo);
 
     object_.ptr_ = nullptr;
     graphics_->GetImpl()->GetDevice()->CreateShader(shaderCreateInfo, (IShader**)&object_.ptr_);
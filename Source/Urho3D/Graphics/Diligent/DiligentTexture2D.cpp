@@ -24,6 +24,7 @@
 
 #include "../../Core/Context.h"
 #include "../../Core/Profiler.h"
+#include "../../Core/WorkQueue.h"
 #include "../../Graphics/Graphics.h"
 #include "../../Graphics/GraphicsEvents.h"
 #include "../../Graphics/GraphicsImpl.h"
@@ -144,15 +145,9 @@ bool Texture2D::SetData(unsigned level, int x, int y, int width, int height, con
     else
     {
         Box destBox((UINT)x, (UINT)(x + width), (UINT)y, (UINT)(y + height), 0, 1);
+        unsigned numRows = (unsigned)(IsCompressed() ? (height + 3) >> 2 : height);
 
-        TextureSubResData textureSubResData;
-        textureSubResData.pData = data;
-        textureSubResData.Stride = rowSize;
-        textureSubResData.DepthStride = 0;
-
-        // TODO: Make sure transition modes are correct
-        graphics_->GetImpl()->GetDeviceContext()->UpdateTexture((ITexture*)object_.ptr_, level, 0, destBox, 
-            textureSubResData, RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        graphics_->GetImpl()->UpdateTextureData((ITexture*)object_.ptr_, level, 0, destBox, data, rowSize, numRows);
     }
 
     return true;
@@ -168,6 +163,10 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
 
     // Use a shared ptr for managing the temporary mip images created during this function
     SharedPtr<Image> mipImage;
+    // Static textures finishing a background load upload their levels over the following frames when there is an
+    // upload budget
+    GraphicsImpl* impl = graphics_->GetImpl();
+    bool queueUpload = graphics_->GetUploadBudget() && usage_ == TEXTURE_STATIC && GetAsyncLoadState() == ASYNC_SUCCESS;
     unsigned memoryUse = sizeof(Texture2D);
     MaterialQuality quality = QUALITY_HIGH;
     Renderer* renderer = GetSubsystem<Renderer>();
@@ -193,7 +192,7 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
         unsigned format = 0;
 
         // Discard unnecessary mip levels
-        for (unsigned i = 0; i < mipsToSkip_[quality]; ++i)
+        for (unsigned i = 0; i < mipsToSkip_[quality] + streamedMipsSkipped_; ++i)
         {
             mipImage = image->GetNextLevel();
             image = mipImage;
@@ -224,7 +223,10 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
 
         for (unsigned i = 0; i < levels_; ++i)
         {
-            SetData(i, 0, 0, levelWidth, levelHeight, levelData);
+            if (queueUpload)
+                impl->QueueTextureUpload(this, i, levelData, image, SharedArrayPtr<unsigned char>());
+            else
+                SetData(i, 0, 0, levelWidth, levelHeight, levelData);
             memoryUse += levelWidth * levelHeight * components;
 
             if (i < levels_ - 1)
@@ -251,7 +253,7 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
             needDecompress = true;
         }
 
-        unsigned mipsToSkip = mipsToSkip_[quality];
+        unsigned mipsToSkip = mipsToSkip_[quality] + streamedMipsSkipped_;
         if (mipsToSkip >= levels)
             mipsToSkip = levels - 1;
         while (mipsToSkip && (width / (1 << mipsToSkip) < 4 || height / (1 << mipsToSkip) < 4))
@@ -267,16 +269,21 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
             CompressedLevel level = image->GetCompressedLevel(i + mipsToSkip);
             if (!needDecompress)
             {
-                SetData(i, 0, 0, level.width_, level.height_, level.data_);
+                if (queueUpload)
+                    impl->QueueTextureUpload(this, i, level.data_, image, SharedArrayPtr<unsigned char>());
+                else
+                    SetData(i, 0, 0, level.width_, level.height_, level.data_);
                 memoryUse += level.rows_ * level.rowSize_;
             }
             else
             {
-                unsigned char* rgbaData = new unsigned char[level.width_ * level.height_ * 4];
-                level.Decompress(rgbaData);
-                SetData(i, 0, 0, level.width_, level.height_, rgbaData);
+                SharedArrayPtr<unsigned char> rgbaData(new unsigned char[level.width_ * level.height_ * 4]);
+                level.Decompress(rgbaData.Get(), GetSubsystem<WorkQueue>());
+                if (queueUpload)
+                    impl->QueueTextureUpload(this, i, rgbaData.Get(), nullptr, rgbaData);
+                else
+                    SetData(i, 0, 0, level.width_, level.height_, rgbaData.Get());
                 memoryUse += level.width_ * level.height_ * 4;
-                delete[] rgbaData;
             }
         }
     }
@@ -288,7 +295,6 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
 
 bool Texture2D::GetData(unsigned level, void* dest) const
 {
-#if 0
     if (!object_.ptr_)
     {
         URHO3D_LOGERROR("No texture created, can not get data");
@@ -318,66 +324,11 @@ bool Texture2D::GetData(unsigned level, void* dest) const
 
     int levelWidth = GetLevelWidth(level);
     int levelHeight = GetLevelHeight(level);
-
-    D3D11_TEXTURE2D_DESC textureDesc;
-    memset(&textureDesc, 0, sizeof textureDesc);
-    textureDesc.Width = (UINT)levelWidth;
-    textureDesc.Height = (UINT)levelHeight;
-    textureDesc.MipLevels = 1;
-    textureDesc.ArraySize = 1;
-    textureDesc.Format = (DXGI_FORMAT)format_;
-    textureDesc.SampleDesc.Count = 1;
-    textureDesc.SampleDesc.Quality = 0;
-    textureDesc.Usage = D3D11_USAGE_STAGING;
-    textureDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
-
-    ID3D11Texture2D* stagingTexture = nullptr;
-    HRESULT hr = graphics_->GetImpl()->GetDevice()->CreateTexture2D(&textureDesc, nullptr, &stagingTexture);
-    if (FAILED(hr))
-    {
-        URHO3D_LOGD3DERROR("Failed to create staging texture for GetData", hr);
-        URHO3D_SAFE_RELEASE(stagingTexture);
-        return false;
-    }
-
-    ID3D11Resource* srcResource = (ID3D11Resource*)(resolveTexture_ ? resolveTexture_ : object_.ptr_);
-    unsigned srcSubResource = D3D11CalcSubresource(level, 0, levels_);
-
-    D3D11_BOX srcBox;
-    srcBox.left = 0;
-    srcBox.right = (UINT)levelWidth;
-    srcBox.top = 0;
-    srcBox.bottom = (UINT)levelHeight;
-    srcBox.front = 0;
-    srcBox.back = 1;
-    graphics_->GetImpl()->GetDeviceContext()->CopySubresourceRegion(stagingTexture, 0, 0, 0, 0, srcResource,
-        srcSubResource, &srcBox);
-
-    D3D11_MAPPED_SUBRESOURCE mappedData;
-    mappedData.pData = nullptr;
     unsigned rowSize = GetRowDataSize(levelWidth);
     unsigned numRows = (unsigned)(IsCompressed() ? (levelHeight + 3) >> 2 : levelHeight);
 
-    hr = graphics_->GetImpl()->GetDeviceContext()->Map((ID3D11Resource*)stagingTexture, 0, D3D11_MAP_READ, 0, &mappedData);
-    if (FAILED(hr) || !mappedData.pData)
-    {
-        URHO3D_LOGD3DERROR("Failed to map staging texture for GetData", hr);
-        URHO3D_SAFE_RELEASE(stagingTexture);
-        return false;
-    }
-    else
-    {
-        for (unsigned row = 0; row < numRows; ++row)
-            memcpy((unsigned char*)dest + row * rowSize, (unsigned char*)mappedData.pData + row * mappedData.RowPitch, rowSize);
-        graphics_->GetImpl()->GetDeviceContext()->Unmap((ID3D11Resource*)stagingTexture, 0);
-        URHO3D_SAFE_RELEASE(stagingTexture);
-        return true;
-    }
-#else
-    NOT_IMPLEMENTED();
-
-    return true;
-#endif
+    auto* source = (ITexture*)(resolveTexture_ ? resolveTexture_ : object_.ptr_);
+    return graphics_->GetImpl()->ReadTextureData(source, level, 0, dest, rowSize, numRows);
 }
 
 bool Texture2D::Create()
@@ -421,7 +372,12 @@ bool Texture2D::Create()
         textureDesc.BindFlags |= BIND_RENDER_TARGET;
     else if (usage_ == TEXTURE_DEPTHSTENCIL)
         textureDesc.BindFlags |= BIND_DEPTH_STENCIL;
+    if (computeAccess_ && multiSample_ == 1 && !sRGB_ && usage_ != TEXTURE_DEPTHSTENCIL)
+        textureDesc.BindFlags |= BIND_UNORDERED_ACCESS;
     textureDesc.CPUAccessFlags = usage_ == TEXTURE_DYNAMIC ? CPU_ACCESS_WRITE : CPU_ACCESS_NONE;
+    // Rendertargets may be read and written by the async compute queue in addition to the graphics queue
+    if (usage_ == TEXTURE_RENDERTARGET || usage_ == TEXTURE_DEPTHSTENCIL)
+        textureDesc.ImmediateContextMask = graphics_->GetImpl()->GetImmediateContextMask();
 
     graphics_->GetImpl()->GetDevice()->CreateTexture(textureDesc, nullptr, (ITexture**)&object_.ptr_);
     if (object_.ptr_ == nullptr)
@@ -24,6 +24,7 @@
 
 #include "../../Core/Context.h"
 #include "../../Core/Profiler.h"
+#include "../../Core/WorkQueue.h"
 #include "../../Graphics/Graphics.h"
 #include "../../Graphics/GraphicsEvents.h"
 #include "../../Graphics/GraphicsImpl.h"
@@ -291,7 +292,7 @@ bool Texture3D::SetData(Image* image, bool useAlpha)
             else
             {
                 unsigned char* rgbaData = new unsigned char[level.width_ * level.height_ * level.depth_ * 4];
-                level.Decompress(rgbaData);
+                level.Decompress(rgbaData, GetSubsystem<WorkQueue>());
                 SetData(i, 0, 0, 0, level.width_, level.height_, level.depth_, rgbaData);
                 memoryUse += level.width_ * level.height_ * level.depth_ * 4;
                 delete[] rgbaData;
@@ -310,7 +311,6 @@ bool Texture3D::SetData(Image* image, bool useAlpha)
 
 bool Texture3D::GetData(unsigned level, void* dest) const
 {
-#if 0
     if (!object_.ptr_)
     {
         URHO3D_LOGERROR("No texture created, can not get data");
@@ -332,68 +332,11 @@ bool Texture3D::GetData(unsigned level, void* dest) const
     int levelWidth = GetLevelWidth(level);
     int levelHeight = GetLevelHeight(level);
     int levelDepth = GetLevelDepth(level);
-
-    D3D11_TEXTURE3D_DESC textureDesc;
-    memset(&textureDesc, 0, sizeof textureDesc);
-    textureDesc.Width = (UINT)levelWidth;
-    textureDesc.Height = (UINT)levelHeight;
-    textureDesc.Depth = (UINT)levelDepth;
-    textureDesc.MipLevels = 1;
-    textureDesc.Format = (DXGI_FORMAT)format_;
-    textureDesc.Usage = D3D11_USAGE_STAGING;
-    textureDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
-
-    ID3D11Texture3D* stagingTexture = nullptr;
-    HRESULT hr = graphics_->GetImpl()->GetDevice()->CreateTexture3D(&textureDesc, nullptr, &stagingTexture);
-    if (FAILED(hr))
-    {
-        URHO3D_LOGD3DERROR("Failed to create staging texture for GetData", hr);
-        URHO3D_SAFE_RELEASE(stagingTexture);
-        return false;
-    }
-
-    unsigned srcSubResource = D3D11CalcSubresource(level, 0, levels_);
-    D3D11_BOX srcBox;
-    srcBox.left = 0;
-    srcBox.right = (UINT)levelWidth;
-    srcBox.top = 0;
-    srcBox.bottom = (UINT)levelHeight;
-    srcBox.front = 0;
-    srcBox.back = (UINT)levelDepth;
-    graphics_->GetImpl()->GetDeviceContext()->CopySubresourceRegion(stagingTexture, 0, 0, 0, 0, (ID3D11Resource*)object_.ptr_,
-        srcSubResource, &srcBox);
-
-    D3D11_MAPPED_SUBRESOURCE mappedData;
-    mappedData.pData = nullptr;
     unsigned rowSize = GetRowDataSize(levelWidth);
     unsigned numRows = (unsigned)(IsCompressed() ? (levelHeight + 3) >> 2 : levelHeight);
 
-    hr = graphics_->GetImpl()->GetDeviceContext()->Map((ID3D11Resource*)stagingTexture, 0, D3D11_MAP_READ, 0, &mappedData);
-    if (FAILED(hr) || !mappedData.pData)
-    {
-        URHO3D_LOGD3DERROR("Failed to map staging texture for GetData", hr);
-        URHO3D_SAFE_RELEASE(stagingTexture);
-        return false;
-    }
-    else
-    {
-        for (int page = 0; page < levelDepth; ++page)
-        {
-            for (unsigned row = 0; row < numRows; ++row)
-            {
-                memcpy((unsigned char*)dest + (page * numRows + row) * rowSize,
-                    (unsigned char*)mappedData.pData + page * mappedData.DepthPitch + row * mappedData.RowPitch, rowSize);
-            }
-        }
-        graphics_->GetImpl()->GetDeviceContext()->Unmap((ID3D11Resource*)stagingTexture, 0);
-        URHO3D_SAFE_RELEASE(stagingTexture);
-        return true;
-    }
-#else
-    NOT_IMPLEMENTED();
-
-    return true;
-#endif
+    auto* source = (Diligent::ITexture*)object_.ptr_;
+    return graphics_->GetImpl()->ReadTextureData(source, level, 0, dest, rowSize, numRows, (unsigned)levelDepth);
 }
 
 bool Texture3D::Create()
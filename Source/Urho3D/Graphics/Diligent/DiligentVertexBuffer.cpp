@@ -74,6 +74,7 @@ bool VertexBuffer::SetData(const void* data)
         return false;
     }
 
+    ++dataRevision_;
     if (shadowData_ && data != shadowData_.Get())
         memcpy(shadowData_.Get(), data, vertexCount_ * vertexSize_);
 
@@ -92,10 +93,7 @@ bool VertexBuffer::SetData(const void* data)
         }
         else
         {
-            // TODO: Make sure transition mode is correct
-            graphics_->GetImpl()->GetDeviceContext()->UpdateBuffer(
-                (IBuffer*)object_.ptr_, 0, vertexCount_ * vertexSize_,
-                data, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            graphics_->GetImpl()->UpdateBufferData((IBuffer*)object_.ptr_, 0, vertexCount_ * vertexSize_, data);
         }
     }
 
@@ -128,6 +126,7 @@ bool VertexBuffer::SetDataRange(const void* data, unsigned start, unsigned count
     if (!count)
         return true;
 
+    ++dataRevision_;
     if (shadowData_ && shadowData_.Get() + start * vertexSize_ != data)
         memcpy(shadowData_.Get() + start * vertexSize_, data, count * vertexSize_);
 
@@ -146,9 +145,7 @@ bool VertexBuffer::SetDataRange(const void* data, unsigned start, unsigned count
         }
         else
         {
-            graphics_->GetImpl()->GetDeviceContext()->UpdateBuffer((IBuffer*)object_.ptr_, start * vertexSize_,
-                                                                   count * vertexSize_, data,
-                                                                   RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            graphics_->GetImpl()->UpdateBufferData((IBuffer*)object_.ptr_, start * vertexSize_, count * vertexSize_, data);
         }
     }
 
@@ -228,6 +225,7 @@ void VertexBuffer::Unlock()
 bool VertexBuffer::Create()
 {
     Release();
+    discardFrame_ = M_MAX_UNSIGNED;
 
     if (!vertexCount_ || !elementMask_)
         return true;
@@ -241,6 +239,13 @@ bool VertexBuffer::Create()
         bufferDesc.Usage = dynamic_ ? USAGE_DYNAMIC : USAGE_DEFAULT;
         bufferDesc.Size = (UINT)(vertexCount_ * vertexSize_);
 
+        // Compute shaders address the vertices as raw data
+        if (computeAccess_ && !dynamic_)
+        {
+            bufferDesc.BindFlags |= BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+            bufferDesc.Mode = BUFFER_MODE_RAW;
+        }
+
         graphics_->GetImpl()->GetDevice()->CreateBuffer(bufferDesc, nullptr, (IBuffer**)&object_.ptr_);
         if (object_.ptr_ == nullptr)
         {
@@ -272,15 +277,32 @@ void* VertexBuffer::MapBuffer(unsigned start, unsigned count, bool discard)
 
     if (object_.ptr_)
     {
+        GraphicsImpl* impl = graphics_->GetImpl();
+        const unsigned frameNumber = impl->GetFrameNumber();
+
+        // On D3D12 and Vulkan the first map of a dynamic buffer in each frame must discard. Keep the rest of the
+        // contents by restoring them from shadow data
+        bool restore = false;
+        if (!discard && discardFrame_ != frameNumber && !impl->IsDynamicDataPersistent())
+        {
+            discard = true;
+            restore = true;
+        }
+
         PVoid mappedData = nullptr;
 
-        graphics_->GetImpl()->GetDeviceContext()->MapBuffer(
-            (IBuffer*)object_.ptr_, MAP_WRITE, discard ? MAP_FLAG_DISCARD : MAP_FLAG_NONE, mappedData);
+        impl->GetDeviceContext()->MapBuffer((IBuffer*)object_.ptr_, MAP_WRITE,
+                                            discard ? MAP_FLAG_DISCARD : MAP_FLAG_NO_OVERWRITE, mappedData);
         if (mappedData == nullptr)
             URHO3D_LOGERROR("Failed to map vertex buffer");
         else
         {
-            hwData = mappedData;
+            if (discard)
+                discardFrame_ = frameNumber;
+            if (restore && shadowData_)
+                memcpy(mappedData, shadowData_.Get(), vertexCount_ * vertexSize_);
+
+            hwData = (unsigned char*)mappedData + start * vertexSize_;
             lockState_ = LOCK_HARDWARE;
         }
     }
@@ -288,6 +310,26 @@ void* VertexBuffer::MapBuffer(unsigned start, unsigned count, bool discard)
     return hwData;
 }
 
+void VertexBuffer::RestoreDynamicData()
+{
+    if (!dynamic_ || !object_.ptr_ || discardFrame_ == graphics_->GetImpl()->GetFrameNumber())
+        return;
+
+    if (shadowData_)
+        SetData(shadowData_.Get());
+    else
+    {
+        // Without shadow data the contents can not be restored
+        static bool warned = false;
+        if (!warned)
+        {
+            URHO3D_LOGWARNING("Dynamic vertex buffer without shadow data used in a later frame than written, contents are undefined");
+            warned = true;
+        }
+        discardFrame_ = graphics_->GetImpl()->GetFrameNumber();
+    }
+}
+
 void VertexBuffer::UnmapBuffer()
 {
     if (object_.ptr_ && lockState_ == LOCK_HARDWARE)
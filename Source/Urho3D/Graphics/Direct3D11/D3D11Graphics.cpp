@@ -28,6 +28,7 @@
 #include "../../Graphics/ConstantBuffer.h"
 #include "../../Graphics/Geometry.h"
 #include "../../Graphics/Graphics.h"
+#include "../../Graphics/GraphicsCapture.h"
 #include "../../Graphics/GraphicsEvents.h"
 #include "../../Graphics/GraphicsImpl.h"
 #include "../../Graphics/IndexBuffer.h"
@@ -353,6 +354,23 @@ void Graphics::SetFlushGPU(bool enable)
     }
 }
 
+void Graphics::SetMaxFramesInFlight(unsigned frames)
+{
+    // No effect on Direct3D11
+    maxFramesInFlight_ = Clamp(frames, 1u, MAX_FRAMES_IN_FLIGHT);
+}
+
+void Graphics::SetPipelinedFrames(bool enable)
+{
+    // No effect on Direct3D11
+    pipelinedFrames_ = enable;
+}
+
+void Graphics::SetGPUProfiling(bool enable)
+{
+    // GPU timing is not supported on Direct3D11
+}
+
 void Graphics::SetForceGL2(bool enable)
 {
     // No effect on Direct3D11
@@ -448,6 +466,18 @@ bool Graphics::TakeScreenShot(Image& destImage)
     return true;
 }
 
+unsigned Graphics::RequestScreenShot()
+{
+    // Asynchronous readback is not supported on Direct3D11
+    return 0;
+}
+
+unsigned Graphics::RequestTextureData(Texture2D* texture, unsigned level)
+{
+    // Asynchronous readback is not supported on Direct3D11
+    return 0;
+}
+
 bool Graphics::BeginFrame()
 {
     if (!IsInitialized())
@@ -665,6 +695,90 @@ bool Graphics::ResolveToTexture(TextureCube* texture)
     return true;
 }
 
+bool Graphics::CopyTexture(Texture2D* destination, Texture2D* source)
+{
+    if (!destination || !source || destination == source)
+        return false;
+    if (destination->GetWidth() != source->GetWidth() || destination->GetHeight() != source->GetHeight() ||
+        destination->GetFormat() != source->GetFormat() || destination->GetMultiSample() != source->GetMultiSample())
+    {
+        URHO3D_LOGERROR("Texture copy requires textures of the same size and format");
+        return false;
+    }
+
+    ID3D11Resource* src = (ID3D11Resource*)source->GetGPUObject();
+    ID3D11Resource* dest = (ID3D11Resource*)destination->GetGPUObject();
+    if (!src || !dest)
+        return false;
+
+    URHO3D_PROFILE(CopyTexture);
+
+    // Unbind the rendertargets so that neither texture is bound for output during the copy
+    impl_->deviceContext_->OMSetRenderTargets(0, nullptr, nullptr);
+    impl_->renderTargetsDirty_ = true;
+    impl_->deviceContext_->CopyResource(dest, src);
+    return true;
+}
+
+bool Graphics::SkinVertices(VertexBuffer* source, VertexBuffer* dest, unsigned vertexStart, unsigned vertexCount,
+    const Matrix3x4* skinMatrices, unsigned numSkinMatrices)
+{
+    // Compute skinning is not supported on Direct3D11
+    return false;
+}
+
+bool Graphics::MorphVertices(VertexBuffer* source, VertexBuffer* dest, VertexBuffer* deltas, unsigned vertexStart, unsigned vertexCount,
+    const unsigned* deltaBlocks, const float* weights, unsigned numMorphs)
+{
+    // Compute morphing is not supported on Direct3D11
+    return false;
+}
+
+bool Graphics::SimulateParticles(VertexBuffer* states, VertexBuffer* dest, const GPUParticleSimulation& simulation)
+{
+    // Compute particle simulation is not supported on Direct3D11
+    return false;
+}
+
+bool Graphics::CompactIndices(IndexBuffer* source, IndexBuffer* dest, const unsigned* ranges, unsigned numRanges)
+{
+    // Compute index compaction is not supported on Direct3D11
+    return false;
+}
+
+bool Graphics::DispatchCompute(const String& shaderName, const String& defines, Texture2D* const* textures, Texture2D* output,
+    const PODVector<Vector4>& parameters, bool async)
+{
+    // Compute shaders are not supported on Direct3D11
+    return false;
+}
+
+void Graphics::WaitAsyncCompute()
+{
+}
+
+bool Graphics::LoadShaderArchive(const String& fileName)
+{
+    // Precompiled shader archives are not supported on Direct3D11
+    return false;
+}
+
+bool Graphics::SaveShaderArchive(const String& fileName, const PODVector<ShaderVariation*>& variations, const Vector<String>& deviceTypes)
+{
+    // Precompiled shader archives are not supported on Direct3D11
+    return false;
+}
+
+
+void Graphics::BeginGPUTiming(const String& name)
+{
+    // GPU timing is not supported on Direct3D11
+}
+
+void Graphics::EndGPUTiming()
+{
+    // GPU timing is not supported on Direct3D11
+}
 
 void Graphics::Draw(PrimitiveType type, unsigned vertexStart, unsigned vertexCount)
 {
@@ -1220,6 +1334,17 @@ void SetTextureForUpdate(Texture* texture)
     // No-op on Direct3D11
 }
 
+void Graphics::SetBindlessTextures(const PODVector<Texture*>& textures)
+{
+    // Bindless textures are not supported on Direct3D11
+}
+
+void Graphics::SetClusteredLights(const PODVector<Vector4>& lightData, const PODVector<unsigned>& clusters,
+    const PODVector<unsigned>& lightIndices)
+{
+    // Clustered forward lighting is not supported on Direct3D11
+}
+
 void Graphics::SetDefaultTextureFilterMode(TextureFilterMode mode)
 {
     if (mode != defaultTextureFilterMode_)
@@ -2262,6 +2387,7 @@ void Graphics::CheckFeatureSupport()
     deferredSupport_ = true;
     hardwareShadowSupport_ = true;
     instancingSupport_ = true;
+    textureCopySupport_ = true;
     shadowMapFormat_ = DXGI_FORMAT_R16_TYPELESS;
     hiresShadowMapFormat_ = DXGI_FORMAT_R32_TYPELESS;
     dummyColorFormat_ = DXGI_FORMAT_UNKNOWN;
@@ -67,6 +67,7 @@ bool IndexBuffer::SetData(const void* data)
         return false;
     }
 
+    ++dataRevision_;
     if (shadowData_ && data != shadowData_.Get())
         memcpy(shadowData_.Get(), data, indexCount_ * indexSize_);
 
@@ -126,6 +127,7 @@ bool IndexBuffer::SetDataRange(const void* data, unsigned start, unsigned count,
     if (!count)
         return true;
 
+    ++dataRevision_;
     if (shadowData_ && shadowData_.Get() + start * indexSize_ != data)
         memcpy(shadowData_.Get() + start * indexSize_, data, count * indexSize_);
 
@@ -72,6 +72,7 @@ bool VertexBuffer::SetData(const void* data)
         return false;
     }
 
+    ++dataRevision_;
     if (shadowData_ && data != shadowData_.Get())
         memcpy(shadowData_.Get(), data, vertexCount_ * vertexSize_);
 
@@ -131,6 +132,7 @@ bool VertexBuffer::SetDataRange(const void* data, unsigned start, unsigned count
     if (!count)
         return true;
 
+    ++dataRevision_;
     if (shadowData_ && shadowData_.Get() + start * vertexSize_ != data)
         memcpy(shadowData_.Get() + start * vertexSize_, data, count * vertexSize_);
 
@@ -278,13 +280,14 @@ void* VertexBuffer::MapBuffer(unsigned start, unsigned count, bool discard)
         D3D11_MAPPED_SUBRESOURCE mappedData;
         mappedData.pData = nullptr;
 
-        HRESULT hr = graphics_->GetImpl()->GetDeviceContext()->Map((ID3D11Buffer*)object_.ptr_, 0, discard ? D3D11_MAP_WRITE_DISCARD :
-            D3D11_MAP_WRITE, 0, &mappedData);
+        // Dynamic buffers can only be mapped for discard or for appending without overwriting data in use
+        D3D11_MAP mapType = discard ? D3D11_MAP_WRITE_DISCARD : (dynamic_ ? D3D11_MAP_WRITE_NO_OVERWRITE : D3D11_MAP_WRITE);
+        HRESULT hr = graphics_->GetImpl()->GetDeviceContext()->Map((ID3D11Buffer*)object_.ptr_, 0, mapType, 0, &mappedData);
         if (FAILED(hr) || !mappedData.pData)
             URHO3D_LOGD3DERROR("Failed to map vertex buffer", hr);
         else
         {
-            hwData = mappedData.pData;
+            hwData = (unsigned char*)mappedData.pData + start * vertexSize_;
             lockState_ = LOCK_HARDWARE;
         }
     }
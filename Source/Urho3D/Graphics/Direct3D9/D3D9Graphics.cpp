@@ -26,6 +26,7 @@
 #include "../../Core/ProcessUtils.h"
 #include "../../Core/Profiler.h"
 #include "../../Graphics/Graphics.h"
+#include "../../Graphics/GraphicsCapture.h"
 #include "../../Graphics/GraphicsEvents.h"
 #include "../../Graphics/GraphicsImpl.h"
 #include "../../Graphics/IndexBuffer.h"
@@ -465,6 +466,23 @@ void Graphics::SetFlushGPU(bool enable)
     flushGPU_ = enable;
 }
 
+void Graphics::SetMaxFramesInFlight(unsigned frames)
+{
+    // No effect on Direct3D9
+    maxFramesInFlight_ = Clamp(frames, 1u, MAX_FRAMES_IN_FLIGHT);
+}
+
+void Graphics::SetPipelinedFrames(bool enable)
+{
+    // No effect on Direct3D9
+    pipelinedFrames_ = enable;
+}
+
+void Graphics::SetGPUProfiling(bool enable)
+{
+    // GPU timing is not supported on Direct3D9
+}
+
 void Graphics::SetForceGL2(bool enable)
 {
     // No effect on Direct3D9
@@ -609,6 +627,18 @@ bool Graphics::TakeScreenShot(Image& destImage)
     return true;
 }
 
+unsigned Graphics::RequestScreenShot()
+{
+    // Asynchronous readback is not supported on Direct3D9
+    return 0;
+}
+
+unsigned Graphics::RequestTextureData(Texture2D* texture, unsigned level)
+{
+    // Asynchronous readback is not supported on Direct3D9
+    return 0;
+}
+
 bool Graphics::BeginFrame()
 {
     if (!IsInitialized())
@@ -845,6 +875,71 @@ bool Graphics::ResolveToTexture(TextureCube* texture)
     return true;
 }
 
+bool Graphics::CopyTexture(Texture2D* destination, Texture2D* source)
+{
+    // Texture copy is not supported on Direct3D9
+    return false;
+}
+
+bool Graphics::SkinVertices(VertexBuffer* source, VertexBuffer* dest, unsigned vertexStart, unsigned vertexCount,
+    const Matrix3x4* skinMatrices, unsigned numSkinMatrices)
+{
+    // Compute skinning is not supported on Direct3D9
+    return false;
+}
+
+bool Graphics::MorphVertices(VertexBuffer* source, VertexBuffer* dest, VertexBuffer* deltas, unsigned vertexStart, unsigned vertexCount,
+    const unsigned* deltaBlocks, const float* weights, unsigned numMorphs)
+{
+    // Compute morphing is not supported on Direct3D9
+    return false;
+}
+
+bool Graphics::SimulateParticles(VertexBuffer* states, VertexBuffer* dest, const GPUParticleSimulation& simulation)
+{
+    // Compute particle simulation is not supported on Direct3D9
+    return false;
+}
+
+bool Graphics::CompactIndices(IndexBuffer* source, IndexBuffer* dest, const unsigned* ranges, unsigned numRanges)
+{
+    // Compute index compaction is not supported on Direct3D9
+    return false;
+}
+
+bool Graphics::DispatchCompute(const String& shaderName, const String& defines, Texture2D* const* textures, Texture2D* output,
+    const PODVector<Vector4>& parameters, bool async)
+{
+    // Compute shaders are not supported on Direct3D9
+    return false;
+}
+
+void Graphics::WaitAsyncCompute()
+{
+}
+
+bool Graphics::LoadShaderArchive(const String& fileName)
+{
+    // Precompiled shader archives are not supported on Direct3D9
+    return false;
+}
+
+bool Graphics::SaveShaderArchive(const String& fileName, const PODVector<ShaderVariation*>& variations, const Vector<String>& deviceTypes)
+{
+    // Precompiled shader archives are not supported on Direct3D9
+    return false;
+}
+
+void Graphics::BeginGPUTiming(const String& name)
+{
+    // GPU timing is not supported on Direct3D9
+}
+
+void Graphics::EndGPUTiming()
+{
+    // GPU timing is not supported on Direct3D9
+}
+
 void Graphics::Draw(PrimitiveType type, unsigned vertexStart, unsigned vertexCount)
 {
     if (!vertexCount)
@@ -1446,6 +1541,17 @@ void Graphics::SetTexture(unsigned index, Texture* texture)
     }
 }
 
+void Graphics::SetBindlessTextures(const PODVector<Texture*>& textures)
+{
+    // Bindless textures are not supported on Direct3D9
+}
+
+void Graphics::SetClusteredLights(const PODVector<Vector4>& lightData, const PODVector<unsigned>& clusters,
+    const PODVector<unsigned>& lightIndices)
+{
+    // Clustered forward lighting is not supported on Direct3D9
+}
+
 void Graphics::SetDefaultTextureFilterMode(TextureFilterMode mode)
 {
     defaultTextureFilterMode_ = mode;
@@ -41,7 +41,10 @@ const BYTE d3dElementType[] =
     D3DDECLTYPE_FLOAT3, // Vector3
     D3DDECLTYPE_FLOAT4, // Vector4
     D3DDECLTYPE_UBYTE4, // 4 bytes, not normalized
-    D3DDECLTYPE_UBYTE4N // 4 bytes, normalized
+    D3DDECLTYPE_UBYTE4N, // 4 bytes, normalized
+    D3DDECLTYPE_SHORT2N, // 2 shorts, normalized
+    D3DDECLTYPE_SHORT4N, // 4 shorts, normalized
+    D3DDECLTYPE_FLOAT16_2 // 2 half floats
 };
 
 const BYTE d3dElementUsage[] =
@@ -29,8 +29,10 @@
 #include "../IO/File.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/Material.h"
+#include "../Graphics/Model.h"
 #include "../Graphics/Octree.h"
 #include "../Graphics/Renderer.h"
+#include "../Graphics/StaticModel.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../Graphics/Zone.h"
 #include "../IO/Log.h"
@@ -67,6 +69,7 @@ Drawable::Drawable(Context* context, unsigned char drawableFlags) :
     updateQueued_(false),
     zoneDirty_(false),
     octant_(nullptr),
+    octantIndex_(0),
     zone_(nullptr),
     viewMask_(DEFAULT_VIEWMASK),
     lightMask_(DEFAULT_LIGHTMASK),
@@ -191,6 +194,8 @@ void Drawable::SetLodBias(float bias)
 void Drawable::SetViewMask(unsigned mask)
 {
     viewMask_ = mask;
+    if (octant_)
+        octant_->UpdateDrawableViewMask(this);
     MarkNetworkUpdate();
 }
 
@@ -444,6 +449,11 @@ bool WriteDrawablesToOBJ(const PODVector<Drawable*>& drawables, File* outputFile
         Matrix3 normalMat = Matrix3(n.m00_, n.m01_, n.m02_, n.m10_, n.m11_, n.m12_, n.m20_, n.m21_, n.m22_);
         normalMat = normalMat.Transpose();
 
+        // The geometry is written from the shadow data of the model
+        auto* staticModel = dynamic_cast<StaticModel*>(drawable);
+        if (staticModel && staticModel->GetModel())
+            staticModel->GetModel()->RequestShadowData();
+
         const Vector<SourceBatch>& batches = drawable->GetBatches();
         for (unsigned geoIndex = 0; geoIndex < batches.Size(); ++geoIndex)
         {
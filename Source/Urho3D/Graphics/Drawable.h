@@ -90,10 +90,15 @@ struct URHO3D_API SourceBatch
     /// Assignment operator.
     SourceBatch& operator =(const SourceBatch& rhs);
 
+    /// Return the geometry to render into shadow maps.
+    Geometry* GetShadowGeometry() const { return shadowGeometry_ ? shadowGeometry_ : geometry_; }
+
     /// Distance from camera.
     float distance_{};
     /// Geometry.
     Geometry* geometry_{};
+    /// Geometry to render into shadow maps instead, when the geometry is culled for the camera. Null to use the geometry.
+    Geometry* shadowGeometry_{};
     /// Material.
     SharedPtr<Material> material_;
     /// World transform(s). For a skinned model, these are the bone transforms.
@@ -134,6 +139,9 @@ public:
     virtual void UpdateBatches(const FrameInfo& frame);
     /// Prepare geometry for rendering.
     virtual void UpdateGeometry(const FrameInfo& frame) { }
+    /// Finish a geometry update that ran in a worker thread, for example by uploading the vertex data it generated. Called from the main thread after all threaded geometry updates have completed.
+    /// @nobind
+    virtual void FinishUpdateGeometry(const FrameInfo& frame) { }
 
     /// Return whether a geometry update is necessary, and if it can happen in a worker thread.
     virtual UpdateGeometryType GetUpdateGeometryType() { return UPDATE_NONE; }
@@ -374,6 +382,8 @@ protected:
     bool zoneDirty_;
     /// Octree octant.
     Octant* octant_;
+    /// Index within the octant's drawables.
+    unsigned octantIndex_;
     /// Current zone.
     Zone* zone_;
     /// View mask.
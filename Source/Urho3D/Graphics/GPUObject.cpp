@@ -22,6 +22,7 @@
 
 #include "../Precompiled.h"
 
+#include "../Core/Profiler.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/GPUObject.h"
 
@@ -30,6 +31,9 @@
 namespace Urho3D
 {
 
+/// Profiler memory pool for vertex and index buffers and textures.
+static const char* GPU_MEMORY_POOL = "GPU";
+
 GPUObject::GPUObject(Graphics* graphics) :
     graphics_(graphics)
 {
@@ -45,6 +49,8 @@ GPUObject::GPUObject(Graphics* graphics) :
 
 GPUObject::~GPUObject()
 {
+    SetGPUMemoryUse(gpuMemoryCategory_, 0);
+
     if (graphics_)
         graphics_->RemoveGPUObject(this);
 }
@@ -75,4 +81,24 @@ Graphics* GPUObject::GetGraphics() const
     return graphics_;
 }
 
+void GPUObject::SetGPUMemoryUse(GPUMemoryCategory category, unsigned long long size)
+{
+    if (gpuMemoryUse_)
+    {
+        URHO3D_PROFILE_FREE(this, GPU_MEMORY_POOL);
+        if (graphics_)
+            graphics_->RemoveGPUMemory(gpuMemoryCategory_, gpuMemoryUse_);
+    }
+
+    gpuMemoryUse_ = size;
+    gpuMemoryCategory_ = category;
+
+    if (gpuMemoryUse_)
+    {
+        URHO3D_PROFILE_ALLOC(this, gpuMemoryUse_, GPU_MEMORY_POOL);
+        if (graphics_)
+            graphics_->AddGPUMemory(gpuMemoryCategory_, gpuMemoryUse_);
+    }
+}
+
 }
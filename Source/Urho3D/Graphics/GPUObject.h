@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../Container/Ptr.h"
+#include "../Graphics/GraphicsDefs.h"
 
 namespace Urho3D
 {
@@ -68,8 +69,15 @@ public:
     bool IsDataLost() const { return dataLost_; }
     /// Return whether has pending data assigned while graphics context was lost.
     bool HasPendingData() const { return dataPending_; }
+    /// Return the GPU memory size of the object as recorded for accounting.
+    unsigned long long GetGPUMemoryUse() const { return gpuMemoryUse_; }
+    /// Return the GPU memory accounting category of the object.
+    GPUMemoryCategory GetGPUMemoryCategory() const { return gpuMemoryCategory_; }
 
 protected:
+    /// Record the GPU memory size of the object in the Graphics accounting and the profiler, replacing any previous record. Zero size only removes the record.
+    void SetGPUMemoryUse(GPUMemoryCategory category, unsigned long long size);
+
     /// Graphics subsystem.
     WeakPtr<Graphics> graphics_;
     /// Object pointer or name.
@@ -78,6 +86,10 @@ protected:
     bool dataLost_{};
     /// Data pending flag.
     bool dataPending_{};
+    /// Recorded GPU memory size.
+    unsigned long long gpuMemoryUse_{};
+    /// GPU memory accounting category.
+    GPUMemoryCategory gpuMemoryCategory_{GPU_MEMORY_OTHER};
 };
 
 }
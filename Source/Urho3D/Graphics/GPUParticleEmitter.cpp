@@ -0,0 +1,499 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Graphics/Batch.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/DrawableEvents.h"
+#include "../Graphics/Geometry.h"
+#include "../Graphics/GPUParticleEmitter.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/IndexBuffer.h"
+#include "../Graphics/ParticleEffect.h"
+#include "../Graphics/VertexBuffer.h"
+#include "../IO/Log.h"
+#include "../Resource/ResourceCache.h"
+#include "../Resource/ResourceEvents.h"
+#include "../Scene/Node.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+extern const char* GEOMETRY_CATEGORY;
+extern const char* autoRemoveModeNames[];
+
+/// Return how far from the emitter the particles of an effect can reach, including their size.
+static float GetParticleReach(ParticleEffect* effect)
+{
+    float timeToLive = effect->GetMaxTimeToLive();
+    float velocity = Max(Abs(effect->GetMinVelocity()), Abs(effect->GetMaxVelocity()));
+    float travel = velocity * timeToLive + 0.5f * effect->GetConstantForce().Length() * timeToLive * timeToLive;
+
+    // Size multiplication compounds once per frame, which never exceeds the continuous exponential growth
+    float scale = Max(1.0f + effect->GetSizeAdd() * timeToLive, 1.0f);
+    if (effect->GetSizeMul() > 1.0f)
+        scale *= expf((effect->GetSizeMul() - 1.0f) * timeToLive);
+    const Vector2& minSize = effect->GetMinParticleSize();
+    const Vector2& maxSize = effect->GetMaxParticleSize();
+    float size = Max(Max(minSize.x_, minSize.y_), Max(maxSize.x_, maxSize.y_));
+
+    // Particles facing their direction also start offset by their height
+    return 0.5f * effect->GetEmitterSize().Length() + travel + size * (scale + 1.0f);
+}
+
+GPUParticleEmitter::GPUParticleEmitter(Context* context) :
+    Drawable(context, DRAWABLE_GEOMETRY),
+    geometry_(new Geometry(context)),
+    vertexBuffer_(new VertexBuffer(context)),
+    indexBuffer_(new IndexBuffer(context)),
+    stateBuffer_(new VertexBuffer(context)),
+    numParticles_(DEFAULT_NUM_PARTICLES),
+    spawnIndex_(0),
+    seed_(0),
+    lastUpdateFrameNumber_(M_MAX_UNSIGNED),
+    periodTimer_(0.0f),
+    emissionTimer_(0.0f),
+    spawnAge_(M_INFINITY),
+    reach_(0.0f),
+    relative_(true),
+    scaled_(true),
+    faceCameraMode_(FC_ROTATE_XYZ),
+    emitting_(true),
+    resetParticles_(true),
+    bufferSizeDirty_(true),
+    sendFinishedEvent_(true),
+    unsupportedWarned_(false),
+    autoRemove_(REMOVE_DISABLED)
+{
+    // Buffers written by compute shaders can not be dynamic
+    vertexBuffer_->SetComputeAccess(true);
+    stateBuffer_->SetComputeAccess(true);
+    geometry_->SetIndexBuffer(indexBuffer_);
+
+    batches_.Resize(1);
+    batches_[0].geometry_ = geometry_;
+    batches_[0].geometryType_ = GEOM_BILLBOARD;
+    batches_[0].worldTransform_ = &transforms_[0];
+    batches_[0].numWorldTransforms_ = 2;
+}
+
+GPUParticleEmitter::~GPUParticleEmitter() = default;
+
+void GPUParticleEmitter::RegisterObject(Context* context)
+{
+    context->RegisterFactory<GPUParticleEmitter>(GEOMETRY_CATEGORY);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Effect", GetEffectAttr, SetEffectAttr, ResourceRef, ResourceRef(ParticleEffect::GetTypeStatic()),
+        AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Can Be Occluded", IsOccludee, SetOccludee, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Draw Distance", GetDrawDistance, SetDrawDistance, float, 0.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Is Emitting", bool, emitting_, true, AM_FILE);
+    URHO3D_ATTRIBUTE("Period Timer", float, periodTimer_, 0.0f, AM_FILE | AM_NOEDIT);
+    URHO3D_ATTRIBUTE("Emission Timer", float, emissionTimer_, 0.0f, AM_FILE | AM_NOEDIT);
+    URHO3D_ENUM_ATTRIBUTE("Autoremove Mode", autoRemove_, autoRemoveModeNames, REMOVE_DISABLED, AM_DEFAULT);
+    URHO3D_COPY_BASE_ATTRIBUTES(Drawable);
+}
+
+void GPUParticleEmitter::OnSetEnabled()
+{
+    Drawable::OnSetEnabled();
+
+    Scene* scene = GetScene();
+    if (scene)
+    {
+        if (IsEnabledEffective())
+            SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(GPUParticleEmitter, HandleScenePostUpdate));
+        else
+            UnsubscribeFromEvent(scene, E_SCENEPOSTUPDATE);
+    }
+}
+
+void GPUParticleEmitter::UpdateBatches(const FrameInfo& frame)
+{
+    distance_ = frame.camera_->GetDistance(GetWorldBoundingBox().Center());
+
+    float scale = GetWorldBoundingBox().Size().DotProduct(DOT_SCALE);
+    lodDistance_ = frame.camera_->GetLodDistance(distance_, scale, lodBias_);
+
+    batches_[0].distance_ = distance_;
+    // Billboard positioning
+    transforms_[0] = relative_ ? node_->GetWorldTransform() : Matrix3x4::IDENTITY;
+    // Billboard rotation
+    transforms_[1] = Matrix3x4(Vector3::ZERO, faceCameraMode_ != FC_NONE ? frame.camera_->GetFaceCameraRotation(
+        node_->GetWorldPosition(), node_->GetWorldRotation(), faceCameraMode_) : node_->GetWorldRotation(), Vector3::ONE);
+}
+
+void GPUParticleEmitter::UpdateGeometry(const FrameInfo& frame)
+{
+    // If using camera facing, re-update the rotation for the current view now
+    if (faceCameraMode_ != FC_NONE)
+    {
+        transforms_[1] = Matrix3x4(Vector3::ZERO, frame.camera_->GetFaceCameraRotation(node_->GetWorldPosition(),
+            node_->GetWorldRotation(), faceCameraMode_), Vector3::ONE);
+    }
+}
+
+UpdateGeometryType GPUParticleEmitter::GetUpdateGeometryType()
+{
+    // The vertices are written by the compute shader, so only the camera facing rotation may need updating per view
+    return faceCameraMode_ != FC_NONE ? UPDATE_MAIN_THREAD : UPDATE_NONE;
+}
+
+void GPUParticleEmitter::SetEffect(ParticleEffect* effect)
+{
+    if (effect == effect_)
+        return;
+
+    Reset();
+
+    // Unsubscribe from the reload event of previous effect (if any), then subscribe to the new
+    if (effect_)
+        UnsubscribeFromEvent(effect_, E_RELOADFINISHED);
+
+    effect_ = effect;
+
+    if (effect_)
+        SubscribeToEvent(effect_, E_RELOADFINISHED, URHO3D_HANDLER(GPUParticleEmitter, HandleEffectReloadFinished));
+
+    ApplyEffect();
+    MarkNetworkUpdate();
+}
+
+void GPUParticleEmitter::SetNumParticles(unsigned num)
+{
+    if (num == numParticles_)
+        return;
+
+    numParticles_ = num;
+    bufferSizeDirty_ = true;
+    RemoveAllParticles();
+}
+
+void GPUParticleEmitter::SetEmitting(bool enable)
+{
+    if (enable != emitting_)
+    {
+        emitting_ = enable;
+
+        // If stopping emission now, and there are active particles, send finish event once they are gone
+        sendFinishedEvent_ = enable || (effect_ && spawnAge_ < effect_->GetMaxTimeToLive());
+        periodTimer_ = 0.0f;
+        // Note: network update does not need to be marked as this is a file only attribute
+    }
+}
+
+void GPUParticleEmitter::SetAutoRemoveMode(AutoRemoveMode mode)
+{
+    autoRemove_ = mode;
+    MarkNetworkUpdate();
+}
+
+void GPUParticleEmitter::ResetEmissionTimer()
+{
+    emissionTimer_ = 0.0f;
+}
+
+void GPUParticleEmitter::RemoveAllParticles()
+{
+    // The particles only exist on the GPU, so they are removed by the next simulation
+    resetParticles_ = true;
+    spawnAge_ = M_INFINITY;
+}
+
+void GPUParticleEmitter::Reset()
+{
+    RemoveAllParticles();
+    ResetEmissionTimer();
+    SetEmitting(true);
+}
+
+void GPUParticleEmitter::ApplyEffect()
+{
+    if (!effect_)
+        return;
+
+    batches_[0].material_ = effect_->GetMaterial();
+    SetNumParticles(effect_->GetNumParticles());
+    relative_ = effect_->IsRelative();
+    scaled_ = effect_->IsScaled();
+    reach_ = GetParticleReach(effect_);
+
+    FaceCameraMode faceCameraMode = effect_->GetFaceCameraMode();
+    if ((faceCameraMode == FC_DIRECTION) != (faceCameraMode_ == FC_DIRECTION))
+    {
+        // The vertex format changes between direction facing and other modes
+        bufferSizeDirty_ = true;
+        RemoveAllParticles();
+    }
+    faceCameraMode_ = faceCameraMode;
+    batches_[0].geometryType_ = faceCameraMode_ == FC_DIRECTION ? GEOM_DIRBILLBOARD : GEOM_BILLBOARD;
+
+    if (node_)
+        OnMarkedDirty(node_);
+}
+
+ParticleEffect* GPUParticleEmitter::GetEffect() const
+{
+    return effect_;
+}
+
+void GPUParticleEmitter::SetEffectAttr(const ResourceRef& value)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    SetEffect(cache->GetResource<ParticleEffect>(value.name_));
+}
+
+ResourceRef GPUParticleEmitter::GetEffectAttr() const
+{
+    return GetResourceRef(effect_, ParticleEffect::GetTypeStatic());
+}
+
+void GPUParticleEmitter::OnSceneSet(Scene* scene)
+{
+    Drawable::OnSceneSet(scene);
+
+    if (scene && IsEnabledEffective())
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(GPUParticleEmitter, HandleScenePostUpdate));
+    else if (!scene)
+         UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+}
+
+void GPUParticleEmitter::OnWorldBoundingBoxUpdate()
+{
+    // The particles are never read back, so use the furthest distance they can reach. Particles that are not relative
+    // stay where they were emitted, so the box assumes the node does not move far during their lifetime
+    Vector3 worldScale = node_->GetWorldScale();
+    float reach = reach_ * Max(Max(Abs(worldScale.x_), Abs(worldScale.y_)), Abs(worldScale.z_));
+    Vector3 center = node_->GetWorldPosition();
+    worldBoundingBox_ = BoundingBox(center - reach * Vector3::ONE, center + reach * Vector3::ONE);
+}
+
+void GPUParticleEmitter::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ScenePostUpdate;
+
+    if (!effect_)
+        return;
+
+    float timeStep = eventData[P_TIMESTEP].GetFloat();
+
+    // If no invisible update, check that the emitter is in view (framenumber has changed)
+    if (effect_->GetUpdateInvisible() || viewFrameNumber_ != lastUpdateFrameNumber_)
+    {
+        lastUpdateFrameNumber_ = viewFrameNumber_;
+        Simulate(timeStep, UpdateEmission(timeStep));
+    }
+
+    // Send finished event only once the last spawned particles have lived out the maximum lifetime
+    if (node_ && !emitting_ && sendFinishedEvent_ && spawnAge_ >= effect_->GetMaxTimeToLive())
+    {
+        sendFinishedEvent_ = false;
+
+        // Make a weak pointer to self to check for destruction during event handling
+        WeakPtr<GPUParticleEmitter> self(this);
+
+        using namespace ParticleEffectFinished;
+
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_NODE] = node_;
+        eventData[P_EFFECT] = effect_;
+
+        node_->SendEvent(E_PARTICLEEFFECTFINISHED, eventData);
+
+        if (self.Expired())
+            return;
+
+        DoAutoRemove(autoRemove_);
+    }
+}
+
+void GPUParticleEmitter::HandleEffectReloadFinished(StringHash eventType, VariantMap& eventData)
+{
+    // When particle effect file is live-edited, remove existing particles and reapply the effect parameters
+    Reset();
+    ApplyEffect();
+}
+
+unsigned GPUParticleEmitter::UpdateEmission(float timeStep)
+{
+    // Check active/inactive period switching
+    periodTimer_ += timeStep;
+    if (emitting_)
+    {
+        float activeTime = effect_->GetActiveTime();
+        if (activeTime && periodTimer_ >= activeTime)
+        {
+            emitting_ = false;
+            periodTimer_ -= activeTime;
+        }
+    }
+    else
+    {
+        float inactiveTime = effect_->GetInactiveTime();
+        if (inactiveTime && periodTimer_ >= inactiveTime)
+        {
+            emitting_ = true;
+            sendFinishedEvent_ = true;
+            periodTimer_ -= inactiveTime;
+        }
+        // If emitter has an indefinite stop interval, keep period timer reset to allow restarting emission in the editor
+        if (inactiveTime == 0.0f)
+            periodTimer_ = 0.0f;
+    }
+
+    unsigned numSpawn = 0;
+    if (emitting_)
+    {
+        emissionTimer_ += timeStep;
+
+        float intervalMin = 1.0f / effect_->GetMaxEmissionRate();
+        float intervalMax = 1.0f / effect_->GetMinEmissionRate();
+
+        // If emission timer has a longer delay than max. interval, clamp it
+        if (emissionTimer_ < -intervalMax)
+            emissionTimer_ = -intervalMax;
+
+        while (emissionTimer_ > 0.0f && numSpawn < numParticles_)
+        {
+            emissionTimer_ -= Lerp(intervalMin, intervalMax, Random(1.0f));
+            ++numSpawn;
+        }
+
+        // Spawning more than the whole ring buffer in one frame would overwrite the new particles, so drop the rest
+        if (emissionTimer_ > 0.0f)
+            emissionTimer_ = 0.0f;
+    }
+
+    spawnAge_ = numSpawn ? 0.0f : spawnAge_ + timeStep;
+    return numSpawn;
+}
+
+bool GPUParticleEmitter::UpdateBufferSize()
+{
+    bufferSizeDirty_ = false;
+    resetParticles_ = true;
+    spawnIndex_ = 0;
+    // Draw nothing until the compute shader has written the vertices
+    geometry_->SetDrawRange(TRIANGLE_LIST, 0, 0, false);
+
+    // With no particles there is nothing to create
+    if (!numParticles_)
+        return false;
+
+    VertexMaskFlags mask = MASK_POSITION | MASK_COLOR | MASK_TEXCOORD1 | MASK_TEXCOORD2;
+    if (faceCameraMode_ == FC_DIRECTION)
+        mask |= MASK_NORMAL;
+
+    // Each particle state is 16 floats
+    PODVector<VertexElement> stateElements;
+    for (unsigned char i = 0; i < 4; ++i)
+        stateElements.Push(VertexElement(TYPE_VECTOR4, SEM_TEXCOORD, i));
+
+    bool largeIndices = (numParticles_ * 4) >= 65536;
+    if (!vertexBuffer_->SetSize(numParticles_ * 4, mask) || !stateBuffer_->SetSize(numParticles_, stateElements) ||
+        !indexBuffer_->SetSize(numParticles_ * 6, largeIndices))
+    {
+        URHO3D_LOGERROR("Failed to create GPU particle buffers");
+        return false;
+    }
+    geometry_->SetVertexBuffer(0, vertexBuffer_);
+
+    // Indices do not change for a given particle capacity
+    PODVector<unsigned char> indexData(numParticles_ * 6 * indexBuffer_->GetIndexSize());
+    for (unsigned i = 0; i < numParticles_; ++i)
+    {
+        unsigned vertexIndex = i * 4;
+        unsigned indices[] = {vertexIndex, vertexIndex + 1, vertexIndex + 2, vertexIndex + 2, vertexIndex + 3, vertexIndex};
+        for (unsigned j = 0; j < 6; ++j)
+        {
+            if (largeIndices)
+                reinterpret_cast<unsigned*>(&indexData[0])[i * 6 + j] = indices[j];
+            else
+                reinterpret_cast<unsigned short*>(&indexData[0])[i * 6 + j] = (unsigned short)indices[j];
+        }
+    }
+
+    return indexBuffer_->SetData(&indexData[0]);
+}
+
+void GPUParticleEmitter::Simulate(float timeStep, unsigned numSpawn)
+{
+    auto* graphics = GetSubsystem<Graphics>();
+    if (!graphics || !node_)
+        return;
+
+    if (!graphics->GetComputeSkinningSupport())
+    {
+        if (!unsupportedWarned_)
+        {
+            URHO3D_LOGWARNING("GPU particle emitter requires compute shader support, particles will not be rendered");
+            unsupportedWarned_ = true;
+        }
+        return;
+    }
+
+    if (bufferSizeDirty_ && !UpdateBufferSize())
+        return;
+
+    URHO3D_PROFILE(SimulateGPUParticles);
+
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    Vector3 worldScale = worldTransform.Scale();
+
+    GPUParticleSimulation simulation;
+    simulation.effect_ = effect_;
+    // Particles that are not relative are emitted directly in world space
+    simulation.emitTransform_ = relative_ ? Matrix3x4::IDENTITY : worldTransform;
+    simulation.constantForce_ = relative_ ? node_->GetWorldRotation().Inverse() * effect_->GetConstantForce() :
+        effect_->GetConstantForce();
+    // If billboards are not relative, apply scaling to the position update
+    if (scaled_ && !relative_)
+        simulation.positionScale_ = worldScale;
+    if (scaled_)
+        simulation.sizeScale_ = Vector2(worldScale.x_, worldScale.y_);
+    simulation.spawnStart_ = spawnIndex_;
+    simulation.numSpawn_ = numSpawn;
+    simulation.seed_ = seed_++;
+    simulation.timeStep_ = timeStep;
+    simulation.reset_ = resetParticles_;
+
+    if (!graphics->SimulateParticles(stateBuffer_, vertexBuffer_, simulation))
+        return;
+
+    if (resetParticles_)
+    {
+        geometry_->SetDrawRange(TRIANGLE_LIST, 0, numParticles_ * 6, false);
+        resetParticles_ = false;
+    }
+    spawnIndex_ = (spawnIndex_ + numSpawn) % numParticles_;
+}
+
+}
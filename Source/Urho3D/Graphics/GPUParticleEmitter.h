@@ -0,0 +1,193 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Graphics/Drawable.h"
+#include "../Math/Matrix3x4.h"
+
+namespace Urho3D
+{
+
+class Geometry;
+class IndexBuffer;
+class ParticleEffect;
+class VertexBuffer;
+
+/// Parameters for spawning and simulating GPU particles with one compute shader dispatch.
+struct GPUParticleSimulation
+{
+    /// Particle effect to spawn and animate the particles with.
+    ParticleEffect* effect_{};
+    /// Transform of the spawned particles from the emitter space to the particle space.
+    Matrix3x4 emitTransform_;
+    /// Constant force in the particle space.
+    Vector3 constantForce_;
+    /// Position update scale.
+    Vector3 positionScale_{Vector3::ONE};
+    /// Billboard size scale.
+    Vector2 sizeScale_{Vector2::ONE};
+    /// Index of the first particle to spawn. Spawning wraps around to the first particle.
+    unsigned spawnStart_{};
+    /// Number of particles to spawn.
+    unsigned numSpawn_{};
+    /// Random seed of the spawned particles.
+    unsigned seed_{};
+    /// Time step to simulate.
+    float timeStep_{};
+    /// Whether to remove all existing particles before spawning.
+    bool reset_{};
+};
+
+/// %Particle emitter component that spawns, simulates and renders its particles on the GPU with a compute shader, using the parameters of a particle effect. Supported only on Diligent. The particles are not sorted and do not support fixed screen size.
+class URHO3D_API GPUParticleEmitter : public Drawable
+{
+    URHO3D_OBJECT(GPUParticleEmitter, Drawable);
+
+public:
+    /// Construct.
+    explicit GPUParticleEmitter(Context* context);
+    /// Destruct.
+    ~GPUParticleEmitter() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Handle enabled/disabled state change.
+    void OnSetEnabled() override;
+    /// Calculate distance and prepare batches for rendering. May be called from worker thread(s), possibly re-entrantly.
+    void UpdateBatches(const FrameInfo& frame) override;
+    /// Prepare geometry for rendering.
+    void UpdateGeometry(const FrameInfo& frame) override;
+    /// Return whether a geometry update is necessary, and if it can happen in a worker thread.
+    UpdateGeometryType GetUpdateGeometryType() override;
+
+    /// Set particle effect.
+    /// @property
+    void SetEffect(ParticleEffect* effect);
+    /// Set maximum number of particles.
+    /// @property
+    void SetNumParticles(unsigned num);
+    /// Set whether should be emitting. If the state was changed, also resets the emission period timer.
+    /// @property
+    void SetEmitting(bool enable);
+    /// Set to remove either the emitter component or its owner node from the scene automatically on particle effect completion. Disabled by default.
+    /// @property
+    void SetAutoRemoveMode(AutoRemoveMode mode);
+    /// Reset the emission period timer.
+    void ResetEmissionTimer();
+    /// Remove all current particles.
+    void RemoveAllParticles();
+    /// Reset the particle emitter completely. Removes current particles, sets emitting state on, and resets the emission timer.
+    void Reset();
+    /// Apply not continuously updated values such as the material, the number of particles and the face camera mode from the particle effect. Call this if you change the effect programmatically.
+    void ApplyEffect();
+
+    /// Return particle effect.
+    /// @property
+    ParticleEffect* GetEffect() const;
+
+    /// Return maximum number of particles.
+    /// @property
+    unsigned GetNumParticles() const { return numParticles_; }
+
+    /// Return whether is currently emitting.
+    /// @property
+    bool IsEmitting() const { return emitting_; }
+
+    /// Return automatic removal mode on particle effect completion.
+    /// @property
+    AutoRemoveMode GetAutoRemoveMode() const { return autoRemove_; }
+
+    /// Set particles effect attribute.
+    void SetEffectAttr(const ResourceRef& value);
+    /// Return particles effect attribute.
+    ResourceRef GetEffectAttr() const;
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+    /// Recalculate the world-space bounding box.
+    void OnWorldBoundingBoxUpdate() override;
+
+private:
+    /// Handle scene post-update event.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle live reload of the particle effect.
+    void HandleEffectReloadFinished(StringHash eventType, VariantMap& eventData);
+    /// Advance the emission timers and return the number of particles to spawn.
+    unsigned UpdateEmission(float timeStep);
+    /// Resize the particle state, vertex and index buffers. Return true on success.
+    bool UpdateBufferSize();
+    /// Spawn and simulate the particles with a compute shader.
+    void Simulate(float timeStep, unsigned numSpawn);
+
+    /// Particle effect.
+    SharedPtr<ParticleEffect> effect_;
+    /// Geometry.
+    SharedPtr<Geometry> geometry_;
+    /// Billboard vertex buffer written by the compute shader.
+    SharedPtr<VertexBuffer> vertexBuffer_;
+    /// Index buffer.
+    SharedPtr<IndexBuffer> indexBuffer_;
+    /// Particle state buffer read and written by the compute shader.
+    SharedPtr<VertexBuffer> stateBuffer_;
+    /// Transform matrices for position and billboard orientation.
+    Matrix3x4 transforms_[2];
+    /// Maximum number of particles.
+    unsigned numParticles_;
+    /// Index of the next particle to spawn.
+    unsigned spawnIndex_;
+    /// Random seed of the next spawned particles.
+    unsigned seed_;
+    /// Rendering framenumber on which was last updated.
+    unsigned lastUpdateFrameNumber_;
+    /// Active/inactive period timer.
+    float periodTimer_;
+    /// New particle emission timer.
+    float emissionTimer_;
+    /// Time since the last particle was spawned.
+    float spawnAge_;
+    /// Distance from the emitter the particles can reach, including their size.
+    float reach_;
+    /// Billboards relative flag.
+    bool relative_;
+    /// Scale affects billboard scale flag.
+    bool scaled_;
+    /// Billboard rotation mode in relation to the camera.
+    FaceCameraMode faceCameraMode_;
+    /// Currently emitting flag.
+    bool emitting_;
+    /// Remove the existing particles on the next simulation flag.
+    bool resetParticles_;
+    /// Buffers need resize flag.
+    bool bufferSizeDirty_;
+    /// Ready to send effect finish event flag.
+    bool sendFinishedEvent_;
+    /// Warned of missing compute shader support flag.
+    bool unsupportedWarned_;
+    /// Automatic removal mode.
+    AutoRemoveMode autoRemove_;
+};
+
+}
@@ -0,0 +1,501 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/Geometry.h"
+#include "../Graphics/GPUTerrain.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/IndexBuffer.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/OctreeQuery.h"
+#include "../Graphics/Terrain.h"
+#include "../Graphics/Texture2D.h"
+#include "../Graphics/VertexBuffer.h"
+#include "../IO/Log.h"
+#include "../Scene/Node.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+static const unsigned RAY_REFINE_STEPS = 8;
+
+GPUTerrain::GPUTerrain(Context* context) :
+    Drawable(context, DRAWABLE_GEOMETRY),
+    geometry_(new Geometry(context)),
+    vertexBuffer_(new VertexBuffer(context)),
+    indexBuffer_(new IndexBuffer(context)),
+    numVertices_(IntVector2::ZERO),
+    numPatches_(IntVector2::ZERO),
+    patchSize_(0),
+    numLodLevels_(0),
+    lastLodBias_(0.0f),
+    lodParametersDirty_(true)
+{
+    vertexBuffer_->SetShadowed(true);
+    indexBuffer_->SetShadowed(true);
+    geometry_->SetVertexBuffer(0, vertexBuffer_);
+    geometry_->SetIndexBuffer(indexBuffer_);
+}
+
+GPUTerrain::~GPUTerrain() = default;
+
+void GPUTerrain::RegisterObject(Context* context)
+{
+    context->RegisterFactory<GPUTerrain>();
+}
+
+void GPUTerrain::ProcessRayQuery(const RayOctreeQuery& query, PODVector<RayQueryResult>& results)
+{
+    RayQueryLevel level = query.level_;
+
+    switch (level)
+    {
+    case RAY_AABB:
+        Drawable::ProcessRayQuery(query, results);
+        break;
+
+    case RAY_OBB:
+    case RAY_TRIANGLE:
+        {
+            Matrix3x4 inverse(node_->GetWorldTransform().Inverse());
+            Ray localRay = query.ray_.Transformed(inverse);
+            float distance = localRay.HitDistance(boundingBox_);
+            Vector3 normal = -query.ray_.direction_;
+
+            if (level == RAY_TRIANGLE && distance < query.maxDistance_)
+            {
+                float end = Min(distance + worldBoundingBox_.Size().Length(), query.maxDistance_);
+                distance = GetHitDistance(query.ray_, distance, end, normal);
+            }
+
+            if (distance < query.maxDistance_)
+            {
+                RayQueryResult result;
+                result.position_ = query.ray_.origin_ + distance * query.ray_.direction_;
+                result.normal_ = normal;
+                result.distance_ = distance;
+                result.drawable_ = this;
+                result.node_ = node_;
+                result.subObject_ = M_MAX_UNSIGNED;
+                results.Push(result);
+            }
+        }
+        break;
+
+    case RAY_TRIANGLE_UV:
+        URHO3D_LOGWARNING("RAY_TRIANGLE_UV query level is not supported for GPUTerrain component");
+        break;
+    }
+}
+
+void GPUTerrain::UpdateBatches(const FrameInfo& frame)
+{
+    distance_ = frame.camera_->GetDistance(GetWorldBoundingBox().Center());
+
+    for (unsigned i = 0; i < lodTransforms_.Size(); ++i)
+        lodTransforms_[i].Clear();
+
+    if (!numLodLevels_ || !material_)
+    {
+        for (unsigned i = 0; i < batches_.Size(); ++i)
+            batches_[i].numWorldTransforms_ = 0;
+        return;
+    }
+
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    if (lodParametersDirty_ || worldTransform != lastWorldTransform_ || lodBias_ != lastLodBias_)
+        UpdateLodParameters();
+
+    // Shadow casters may be outside the view frustum, so only cull by it when not casting shadows
+    Vector3 cameraPos = frame.camera_->GetNode()->GetWorldPosition();
+    const Frustum* frustum = castShadows_ ? nullptr : &frame.camera_->GetFrustum();
+    SelectNodes(numLodLevels_ - 1, 0, 0, frustum, cameraPos);
+
+    for (unsigned i = 0; i < batches_.Size(); ++i)
+    {
+        SourceBatch& batch = batches_[i];
+        PODVector<Matrix3x4>& transforms = lodTransforms_[i];
+        batch.distance_ = distance_;
+        batch.worldTransform_ = transforms.Size() ? &transforms[0] : &Matrix3x4::IDENTITY;
+        batch.numWorldTransforms_ = transforms.Size();
+        lodMaterials_[i]->SetShaderParameter("GPUTerrainCamera", cameraPos);
+    }
+}
+
+void GPUTerrain::UpdateGeometry(const FrameInfo& frame)
+{
+    if (heightTexture_ && heightTexture_->IsDataLost())
+        UpdateHeightTexture();
+}
+
+UpdateGeometryType GPUTerrain::GetUpdateGeometryType()
+{
+    // The geomorph depends on the camera, so the terrain must not be treated as a static shadow caster either
+    return UPDATE_MAIN_THREAD;
+}
+
+Geometry* GPUTerrain::GetLodGeometry(unsigned batchIndex, unsigned level)
+{
+    return nullptr;
+}
+
+void GPUTerrain::SetOwner(Terrain* terrain)
+{
+    owner_ = terrain;
+}
+
+void GPUTerrain::SetMaterial(Material* material)
+{
+    material_ = material;
+    UpdateMaterials();
+}
+
+void GPUTerrain::UpdateHeightData()
+{
+    URHO3D_PROFILE(UpdateGPUTerrain);
+
+    SharedArrayPtr<float> heightData = owner_ ? owner_->GetHeightData() : SharedArrayPtr<float>();
+    numVertices_ = heightData ? owner_->GetNumVertices() : IntVector2::ZERO;
+    numPatches_ = heightData ? owner_->GetNumPatches() : IntVector2::ZERO;
+
+    if (!numPatches_.x_ || !numPatches_.y_)
+    {
+        numLodLevels_ = 0;
+        batches_.Clear();
+        lodTransforms_.Clear();
+        heightRanges_.Clear();
+        heightTexture_.Reset();
+        boundingBox_ = BoundingBox(Vector3::ZERO, Vector3::ZERO);
+        OnMarkedDirty(node_);
+        return;
+    }
+
+    if (owner_->GetPatchSize() != patchSize_)
+    {
+        patchSize_ = owner_->GetPatchSize();
+        CreatePatchGeometry();
+    }
+
+    // The root level covers the whole terrain with a single node
+    int maxSize = Max(numVertices_.x_, numVertices_.y_) - 1;
+    numLodLevels_ = 1;
+    while ((patchSize_ << (numLodLevels_ - 1)) < maxSize)
+        ++numLodLevels_;
+
+    // Build the height ranges of the quadtree nodes bottom-up
+    heightRanges_.Resize(numLodLevels_);
+    heightRanges_[0].Resize((unsigned)(numPatches_.x_ * numPatches_.y_));
+    for (int pz = 0; pz < numPatches_.y_; ++pz)
+    {
+        for (int px = 0; px < numPatches_.x_; ++px)
+        {
+            Vector2 range(M_INFINITY, -M_INFINITY);
+            for (int z = pz * patchSize_; z <= (pz + 1) * patchSize_; ++z)
+            {
+                const float* src = &heightData[z * numVertices_.x_ + px * patchSize_];
+                for (int x = 0; x <= patchSize_; ++x)
+                {
+                    range.x_ = Min(range.x_, src[x]);
+                    range.y_ = Max(range.y_, src[x]);
+                }
+            }
+            heightRanges_[0][pz * numPatches_.x_ + px] = range;
+        }
+    }
+
+    for (unsigned i = 1; i < numLodLevels_; ++i)
+    {
+        int width = GetLevelWidth(i);
+        int height = GetLevelHeight(i);
+        int childWidth = GetLevelWidth(i - 1);
+        int childHeight = GetLevelHeight(i - 1);
+        heightRanges_[i].Resize((unsigned)(width * height));
+
+        for (int z = 0; z < height; ++z)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                Vector2 range(M_INFINITY, -M_INFINITY);
+                for (int cz = z * 2; cz < Min(z * 2 + 2, childHeight); ++cz)
+                {
+                    for (int cx = x * 2; cx < Min(x * 2 + 2, childWidth); ++cx)
+                    {
+                        const Vector2& childRange = heightRanges_[i - 1][cz * childWidth + cx];
+                        range.x_ = Min(range.x_, childRange.x_);
+                        range.y_ = Max(range.y_, childRange.y_);
+                    }
+                }
+                heightRanges_[i][z * width + x] = range;
+            }
+        }
+    }
+
+    const Vector3& spacing = owner_->GetSpacing();
+    const Vector2& rootRange = heightRanges_[numLodLevels_ - 1][0];
+    Vector2 origin(-0.5f * (float)(numVertices_.x_ - 1) * spacing.x_, -0.5f * (float)(numVertices_.y_ - 1) * spacing.z_);
+    boundingBox_ = BoundingBox(Vector3(origin.x_, rootRange.x_, origin.y_), Vector3(-origin.x_, rootRange.y_, -origin.y_));
+    OnMarkedDirty(node_);
+
+    UpdateHeightTexture();
+
+    lodTransforms_.Resize(numLodLevels_);
+    batches_.Resize(numLodLevels_);
+    for (unsigned i = 0; i < numLodLevels_; ++i)
+    {
+        batches_[i].geometry_ = geometry_;
+        batches_[i].geometryType_ = GEOM_STATIC;
+        batches_[i].worldTransform_ = &Matrix3x4::IDENTITY;
+        batches_[i].numWorldTransforms_ = 0;
+    }
+
+    UpdateMaterials();
+}
+
+Terrain* GPUTerrain::GetOwner() const
+{
+    return owner_;
+}
+
+Material* GPUTerrain::GetMaterial() const
+{
+    return material_;
+}
+
+void GPUTerrain::OnWorldBoundingBoxUpdate()
+{
+    worldBoundingBox_ = boundingBox_.Transformed(node_->GetWorldTransform());
+}
+
+void GPUTerrain::CreatePatchGeometry()
+{
+    auto row = (unsigned)(patchSize_ + 1);
+    vertexBuffer_->SetSize(row * row, MASK_POSITION);
+    indexBuffer_->SetSize((unsigned)(patchSize_ * patchSize_ * 6), false);
+
+    auto* vertexData = (float*)vertexBuffer_->Lock(0, vertexBuffer_->GetVertexCount());
+    if (vertexData)
+    {
+        for (unsigned z = 0; z < row; ++z)
+        {
+            for (unsigned x = 0; x < row; ++x)
+            {
+                *vertexData++ = (float)x;
+                *vertexData++ = 0.0f;
+                *vertexData++ = (float)z;
+            }
+        }
+
+        vertexBuffer_->Unlock();
+    }
+
+    // Use the same triangulation as the CPU-rendered patches, which the shader geomorph relies on
+    auto* indexData = (unsigned short*)indexBuffer_->Lock(0, indexBuffer_->GetIndexCount());
+    if (indexData)
+    {
+        for (unsigned z = 0; z < (unsigned)patchSize_; ++z)
+        {
+            for (unsigned x = 0; x < (unsigned)patchSize_; ++x)
+            {
+                *indexData++ = (unsigned short)(x + (z + 1) * row);
+                *indexData++ = (unsigned short)((x + 1) + z * row);
+                *indexData++ = (unsigned short)(x + z * row);
+                *indexData++ = (unsigned short)(x + (z + 1) * row);
+                *indexData++ = (unsigned short)((x + 1) + (z + 1) * row);
+                *indexData++ = (unsigned short)((x + 1) + z * row);
+            }
+        }
+
+        indexBuffer_->Unlock();
+    }
+
+    geometry_->SetDrawRange(TRIANGLE_LIST, 0, indexBuffer_->GetIndexCount());
+}
+
+void GPUTerrain::UpdateHeightTexture()
+{
+    SharedArrayPtr<float> heightData = owner_ ? owner_->GetHeightData() : SharedArrayPtr<float>();
+    if (!heightData)
+        return;
+
+    if (!heightTexture_)
+    {
+        heightTexture_ = new Texture2D(context_);
+        heightTexture_->SetNumLevels(1);
+        heightTexture_->SetFilterMode(FILTER_NEAREST);
+        heightTexture_->SetAddressMode(COORD_U, ADDRESS_CLAMP);
+        heightTexture_->SetAddressMode(COORD_V, ADDRESS_CLAMP);
+    }
+
+    if (heightTexture_->GetWidth() != numVertices_.x_ || heightTexture_->GetHeight() != numVertices_.y_)
+    {
+        if (!heightTexture_->SetSize(numVertices_.x_, numVertices_.y_, Graphics::GetFloat32Format()))
+        {
+            URHO3D_LOGERROR("Failed to create GPU terrain height texture");
+            return;
+        }
+    }
+
+    heightTexture_->SetData(0, 0, 0, numVertices_.x_, numVertices_.y_, heightData.Get());
+    heightTexture_->ClearDataLost();
+}
+
+void GPUTerrain::UpdateMaterials()
+{
+    lodMaterials_.Resize(numLodLevels_);
+
+    for (unsigned i = 0; i < numLodLevels_; ++i)
+    {
+        lodMaterials_[i] = material_ ? material_->Clone() : SharedPtr<Material>();
+#ifdef DESKTOP_GRAPHICS
+        if (lodMaterials_[i])
+            lodMaterials_[i]->SetTexture(TU_CUSTOM1, heightTexture_);
+#endif
+        batches_[i].material_ = lodMaterials_[i];
+    }
+
+    lodParametersDirty_ = true;
+}
+
+void GPUTerrain::UpdateLodParameters()
+{
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    const Vector3& spacing = owner_->GetSpacing();
+    float heightExtent = boundingBox_.max_.y_ - boundingBox_.min_.y_;
+
+    texelToWorld_ = worldTransform * Matrix3x4(Vector3(boundingBox_.min_.x_, 0.0f, boundingBox_.min_.z_), Quaternion::IDENTITY,
+        Vector3(spacing.x_, 1.0f, spacing.z_));
+
+    Vector4 size((float)(numVertices_.x_ - 1), (float)(numVertices_.y_ - 1), 1.0f / (float)numVertices_.x_,
+        1.0f / (float)numVertices_.y_);
+
+    // Each LOD level is used up to its range, and morphs to the next coarser level before reaching it. The ranges must leave
+    // room for a node's diagonal in between, so that neighbor nodes always differ by at most one level and match at the edges
+    lodRanges_.Resize(numLodLevels_);
+    float lastRange = 0.0f;
+    for (unsigned i = 0; i < numLodLevels_; ++i)
+    {
+        auto nodeTexels = (float)(patchSize_ << i);
+        BoundingBox nodeBox(Vector3::ZERO, Vector3(nodeTexels, heightExtent, nodeTexels));
+        float diagonal = nodeBox.Transformed(texelToWorld_).Size().Length();
+        float range = i ? lastRange * 2.0f : 2.0f * lodBias_ * diagonal;
+        range = Max(range, lastRange + 2.0f * diagonal);
+        float morphStart = lastRange + diagonal;
+        float morphScale = i < numLodLevels_ - 1 ? 1.0f / (range - morphStart) : 0.0f;
+
+        Material* material = lodMaterials_[i];
+        if (material)
+        {
+            material->SetShaderParameter("GPUTerrainTransform", texelToWorld_);
+            material->SetShaderParameter("GPUTerrainSize", size);
+            material->SetShaderParameter("GPUTerrainLod", Vector4((float)(1u << i), morphStart, morphScale, 0.0f));
+        }
+
+        lodRanges_[i] = range;
+        lastRange = range;
+    }
+
+    lastWorldTransform_ = worldTransform;
+    lastLodBias_ = lodBias_;
+    lodParametersDirty_ = false;
+}
+
+void GPUTerrain::SelectNodes(unsigned level, int x, int z, const Frustum* frustum, const Vector3& cameraPos)
+{
+    int width = GetLevelWidth(level);
+    const Vector2& heightRange = heightRanges_[level][z * width + x];
+    int nodeTexels = patchSize_ << level;
+
+    // Nodes on the far edges may extend past the terrain, so clip the box to it
+    BoundingBox box(Vector3((float)(x * nodeTexels), heightRange.x_, (float)(z * nodeTexels)),
+        Vector3((float)Min((x + 1) * nodeTexels, numVertices_.x_ - 1), heightRange.y_,
+        (float)Min((z + 1) * nodeTexels, numVertices_.y_ - 1)));
+    box = box.Transformed(texelToWorld_);
+
+    if (frustum && frustum->IsInsideFast(box) == OUTSIDE)
+        return;
+
+    if (level && Sphere(cameraPos, lodRanges_[level - 1]).IsInsideFast(box) != OUTSIDE)
+    {
+        int childWidth = GetLevelWidth(level - 1);
+        int childHeight = GetLevelHeight(level - 1);
+        for (int cz = z * 2; cz < Min(z * 2 + 2, childHeight); ++cz)
+        {
+            for (int cx = x * 2; cx < Min(x * 2 + 2, childWidth); ++cx)
+                SelectNodes(level - 1, cx, cz, frustum, cameraPos);
+        }
+        return;
+    }
+
+    auto step = (float)(1u << level);
+    lodTransforms_[level].Push(Matrix3x4(Vector3((float)(x * nodeTexels), 0.0f, (float)(z * nodeTexels)), Quaternion::IDENTITY,
+        Vector3(step, 1.0f, step)));
+}
+
+float GPUTerrain::GetHitDistance(const Ray& ray, float start, float end, Vector3& normal) const
+{
+    if (!owner_)
+        return M_INFINITY;
+
+    // March with half the world-space vertex spacing, then refine the crossing with a binary search
+    Vector3 worldScale = node_->GetWorldScale();
+    const Vector3& spacing = owner_->GetSpacing();
+    float stepSize = 0.5f * Min(spacing.x_ * Abs(worldScale.x_), spacing.z_ * Abs(worldScale.z_));
+    if (stepSize <= 0.0f)
+        return M_INFINITY;
+
+    float lastDistance = start;
+    for (float distance = start; distance <= end + stepSize; distance += stepSize)
+    {
+        float d = Min(distance, end);
+        Vector3 position = ray.origin_ + d * ray.direction_;
+        if (position.y_ <= owner_->GetHeight(position))
+        {
+            float above = lastDistance;
+            float below = d;
+            for (unsigned i = 0; i < RAY_REFINE_STEPS; ++i)
+            {
+                float middle = 0.5f * (above + below);
+                Vector3 middlePosition = ray.origin_ + middle * ray.direction_;
+                if (middlePosition.y_ <= owner_->GetHeight(middlePosition))
+                    below = middle;
+                else
+                    above = middle;
+            }
+
+            normal = owner_->GetNormal(ray.origin_ + below * ray.direction_);
+            return below;
+        }
+
+        lastDistance = d;
+    }
+
+    return M_INFINITY;
+}
+
+}
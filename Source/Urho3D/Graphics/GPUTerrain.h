@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Graphics/Drawable.h"
+
+namespace Urho3D
+{
+
+class Geometry;
+class IndexBuffer;
+class Terrain;
+class Texture2D;
+class VertexBuffer;
+
+/// Heightmap terrain rendered from a single grid patch mesh, instanced once per visible quadtree node. Heights are sampled from a texture in the vertex shader, and vertices geomorph toward the next coarser LOD with distance. Created by Terrain when GPU rendering is enabled.
+/// @nobind
+class URHO3D_API GPUTerrain : public Drawable
+{
+    URHO3D_OBJECT(GPUTerrain, Drawable);
+
+public:
+    /// Construct.
+    explicit GPUTerrain(Context* context);
+    /// Destruct.
+    ~GPUTerrain() override;
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Process octree raycast. May be called from a worker thread.
+    void ProcessRayQuery(const RayOctreeQuery& query, PODVector<RayQueryResult>& results) override;
+    /// Calculate distance, select the visible quadtree nodes and prepare batches for rendering. May be called from worker thread(s), possibly re-entrantly.
+    void UpdateBatches(const FrameInfo& frame) override;
+    /// Prepare geometry for rendering. Restores the height texture if its data was lost.
+    void UpdateGeometry(const FrameInfo& frame) override;
+    /// Return whether a geometry update is necessary, and if it can happen in a worker thread.
+    UpdateGeometryType GetUpdateGeometryType() override;
+    /// Return the geometry for a specific LOD level. There is no CPU-side geometry, so always null.
+    Geometry* GetLodGeometry(unsigned batchIndex, unsigned level) override;
+
+    /// Set owner terrain.
+    void SetOwner(Terrain* terrain);
+    /// Set material. Should use a technique with the GPUTERRAIN vertex shader define, such as TerrainBlendGPU.
+    void SetMaterial(Material* material);
+    /// Rebuild the patch mesh, height texture and quadtree height ranges from the owner terrain's height data.
+    void UpdateHeightData();
+
+    /// Return owner terrain.
+    Terrain* GetOwner() const;
+    /// Return material.
+    Material* GetMaterial() const;
+
+    /// Return height texture.
+    Texture2D* GetHeightTexture() const { return heightTexture_; }
+
+    /// Return number of quadtree levels, which is also the number of LOD levels.
+    unsigned GetNumLodLevels() const { return numLodLevels_; }
+
+    /// Return number of patch instances drawn on a LOD level during the last update.
+    unsigned GetNumInstances(unsigned level) const { return level < lodTransforms_.Size() ? lodTransforms_[level].Size() : 0; }
+
+protected:
+    /// Recalculate the world-space bounding box.
+    void OnWorldBoundingBoxUpdate() override;
+
+private:
+    /// Create the shared grid patch mesh.
+    void CreatePatchGeometry();
+    /// Upload the owner terrain's height data to the height texture.
+    void UpdateHeightTexture();
+    /// Create the per-LOD material clones.
+    void UpdateMaterials();
+    /// Recalculate LOD ranges and the material parameters which do not depend on the camera.
+    void UpdateLodParameters();
+    /// Select the quadtree nodes to render, starting from the root node and recursing into children which are within range of the camera.
+    void SelectNodes(unsigned level, int x, int z, const Frustum* frustum, const Vector3& cameraPos);
+    /// Return quadtree width in nodes on a level.
+    int GetLevelWidth(unsigned level) const { return (numPatches_.x_ + (1 << level) - 1) >> level; }
+    /// Return quadtree height in nodes on a level.
+    int GetLevelHeight(unsigned level) const { return (numPatches_.y_ + (1 << level) - 1) >> level; }
+    /// Return ray hit distance to the heightfield by marching between the start and end distances, or infinity if no hit.
+    float GetHitDistance(const Ray& ray, float start, float end, Vector3& normal) const;
+
+    /// Grid patch geometry.
+    SharedPtr<Geometry> geometry_;
+    /// Grid patch vertex buffer.
+    SharedPtr<VertexBuffer> vertexBuffer_;
+    /// Grid patch index buffer.
+    SharedPtr<IndexBuffer> indexBuffer_;
+    /// Height texture.
+    SharedPtr<Texture2D> heightTexture_;
+    /// Parent terrain.
+    WeakPtr<Terrain> owner_;
+    /// Material.
+    SharedPtr<Material> material_;
+    /// Material clones with the LOD parameters, one per LOD level.
+    Vector<SharedPtr<Material> > lodMaterials_;
+    /// Instance transforms of the selected nodes per LOD level. Grid vertices are transformed to heightmap texels.
+    Vector<PODVector<Matrix3x4> > lodTransforms_;
+    /// Minimum and maximum height of the quadtree nodes per level.
+    Vector<PODVector<Vector2> > heightRanges_;
+    /// Distance up to which each LOD level is used.
+    PODVector<float> lodRanges_;
+    /// Transform from heightmap texels to world space.
+    Matrix3x4 texelToWorld_;
+    /// World transform at the time of the last LOD parameter update.
+    Matrix3x4 lastWorldTransform_;
+    /// Terrain size in vertices.
+    IntVector2 numVertices_;
+    /// Terrain size in patches.
+    IntVector2 numPatches_;
+    /// Patch size, quads per side.
+    int patchSize_;
+    /// Number of quadtree levels.
+    unsigned numLodLevels_;
+    /// LOD bias at the time of the last LOD parameter update.
+    float lastLodBias_;
+    /// LOD parameters need update flag.
+    bool lodParametersDirty_;
+};
+
+}
@@ -22,9 +22,11 @@
 
 #include "../Precompiled.h"
 
+#include "../Core/Profiler.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/IndexBuffer.h"
+#include "../Graphics/TriangleBVH.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../IO/Log.h"
 #include "../Math/Ray.h"
@@ -41,9 +43,15 @@ Geometry::Geometry(Context* context) :
     indexCount_(0),
     vertexStart_(0),
     vertexCount_(0),
+    instanceStart_(0),
+    instanceCount_(0),
     rawVertexSize_(0),
     rawIndexSize_(0),
-    lodDistance_(0.0f)
+    lodDistance_(0.0f),
+    raycastBVHVertexRevision_(0),
+    raycastBVHIndexRevision_(0),
+    raycastBVHIndexStart_(0),
+    raycastBVHIndexCount_(0)
 {
     SetNumVertexBuffers(1);
 }
@@ -73,12 +81,15 @@ bool Geometry::SetVertexBuffer(unsigned index, VertexBuffer* buffer)
     }
 
     vertexBuffers_[index] = buffer;
+    if (!index)
+        ResetRaycastBVH();
     return true;
 }
 
 void Geometry::SetIndexBuffer(IndexBuffer* buffer)
 {
     indexBuffer_ = buffer;
+    ResetRaycastBVH();
 }
 
 bool Geometry::SetDrawRange(PrimitiveType type, unsigned indexStart, unsigned indexCount, bool getUsedVertexRange)
@@ -145,6 +156,12 @@ bool Geometry::SetDrawRange(PrimitiveType type, unsigned indexStart, unsigned in
     return true;
 }
 
+void Geometry::SetInstanceRange(unsigned instanceStart, unsigned instanceCount)
+{
+    instanceStart_ = instanceStart;
+    instanceCount_ = instanceCount;
+}
+
 void Geometry::SetLodDistance(float distance)
 {
     if (distance < 0.0f)
@@ -153,11 +170,17 @@ void Geometry::SetLodDistance(float distance)
     lodDistance_ = distance;
 }
 
+void Geometry::SetMeshlets(const PODVector<Meshlet>& meshlets)
+{
+    meshlets_ = meshlets;
+}
+
 void Geometry::SetRawVertexData(const SharedArrayPtr<unsigned char>& data, const PODVector<VertexElement>& elements)
 {
     rawVertexData_ = data;
     rawVertexSize_ = VertexBuffer::GetVertexSize(elements);
     rawElements_ = elements;
+    ResetRaycastBVH();
 }
 
 void Geometry::SetRawVertexData(const SharedArrayPtr<unsigned char>& data, unsigned elementMask)
@@ -165,17 +188,25 @@ void Geometry::SetRawVertexData(const SharedArrayPtr<unsigned char>& data, unsig
     rawVertexData_ = data;
     rawVertexSize_ = VertexBuffer::GetVertexSize(elementMask);
     rawElements_ = VertexBuffer::GetElements(elementMask);
+    ResetRaycastBVH();
 }
 
 void Geometry::SetRawIndexData(const SharedArrayPtr<unsigned char>& data, unsigned indexSize)
 {
     rawIndexData_ = data;
     rawIndexSize_ = indexSize;
+    ResetRaycastBVH();
 }
 
 void Geometry::Draw(Graphics* graphics)
 {
-    if (indexBuffer_ && indexCount_ > 0)
+    if (indexBuffer_ && indexCount_ > 0 && instanceCount_ > 0)
+    {
+        graphics->SetIndexBuffer(indexBuffer_);
+        graphics->SetVertexBuffers(vertexBuffers_, instanceStart_);
+        graphics->DrawInstanced(primitiveType_, indexStart_, indexCount_, vertexStart_, vertexCount_, instanceCount_);
+    }
+    else if (indexBuffer_ && indexCount_ > 0)
     {
         graphics->SetIndexBuffer(indexBuffer_);
         graphics->SetVertexBuffers(vertexBuffers_);
@@ -322,6 +353,13 @@ float Geometry::GetHitDistance(const Ray& ray, Vector3* outNormal, Vector2* outU
         outUV = nullptr;
     }
 
+    if (indexData)
+    {
+        TriangleBVH* bvh = GetRaycastBVH(vertexData, vertexSize, indexData, indexSize);
+        if (bvh)
+            return bvh->HitDistance(ray, vertexData, vertexSize, outNormal, outUV, uvOffset);
+    }
+
     return indexData ? ray.HitDistance(vertexData, vertexSize, indexData, indexSize, indexStart_, indexCount_, outNormal, outUV,
         uvOffset) : ray.HitDistance(vertexData, vertexSize, vertexStart_, vertexCount_, outNormal, outUV, uvOffset);
 }
@@ -340,4 +378,46 @@ bool Geometry::IsInside(const Ray& ray) const
                          ray.InsideGeometry(vertexData, vertexSize, vertexStart_, vertexCount_)) : false;
 }
 
+TriangleBVH* Geometry::GetRaycastBVH(const unsigned char* vertexData, unsigned vertexSize, const unsigned char* indexData,
+    unsigned indexSize) const
+{
+    if (primitiveType_ != TRIANGLE_LIST || indexCount_ < MIN_RAYCAST_BVH_TRIANGLES * 3)
+        return nullptr;
+
+    // Data that is rewritten constantly would need a rebuild for nearly every query, so leave it to the brute force test
+    VertexBuffer* vertexBuffer = rawVertexData_ ? nullptr : vertexBuffers_[0].Get();
+    IndexBuffer* indexBuffer = rawIndexData_ ? nullptr : indexBuffer_.Get();
+    if ((vertexBuffer && vertexBuffer->IsDynamic()) || (indexBuffer && indexBuffer->IsDynamic()))
+        return nullptr;
+
+    unsigned vertexRevision = vertexBuffer ? vertexBuffer->GetDataRevision() : 0;
+    unsigned indexRevision = indexBuffer ? indexBuffer->GetDataRevision() : 0;
+
+    // Raycasts may run in worker threads. The hierarchy is only replaced after the data has been modified, which must not
+    // happen concurrently with raycasts, so the pointer stays valid after releasing the lock
+    MutexLock lock(raycastBVHMutex_);
+
+    if (!raycastBVH_ || raycastBVHVertexRevision_ != vertexRevision || raycastBVHIndexRevision_ != indexRevision ||
+        raycastBVHIndexStart_ != indexStart_ || raycastBVHIndexCount_ != indexCount_)
+    {
+        URHO3D_PROFILE(BuildRaycastBVH);
+
+        if (!raycastBVH_)
+            raycastBVH_ = new TriangleBVH();
+        raycastBVH_->Build(vertexData, vertexSize, indexData, indexSize, indexStart_, indexCount_);
+        raycastBVHVertexRevision_ = vertexRevision;
+        raycastBVHIndexRevision_ = indexRevision;
+        raycastBVHIndexStart_ = indexStart_;
+        raycastBVHIndexCount_ = indexCount_;
+    }
+
+    return raycastBVH_;
+}
+
+void Geometry::ResetRaycastBVH()
+{
+    MutexLock lock(raycastBVHMutex_);
+    raycastBVH_.Reset();
+}
+
 }
@@ -23,8 +23,10 @@
 #pragma once
 
 #include "../Container/ArrayPtr.h"
+#include "../Core/Mutex.h"
 #include "../Core/Object.h"
 #include "../Graphics/GraphicsDefs.h"
+#include "../Math/Vector3.h"
 
 namespace Urho3D
 {
@@ -32,8 +34,33 @@ namespace Urho3D
 class IndexBuffer;
 class Ray;
 class Graphics;
+class TriangleBVH;
 class VertexBuffer;
 
+/// Maximum number of triangles in a meshlet.
+static const unsigned MAX_MESHLET_TRIANGLES = 64;
+/// Maximum number of vertices in a meshlet.
+static const unsigned MAX_MESHLET_VERTICES = 64;
+/// Minimum number of triangles for building a bounding volume hierarchy to accelerate ray queries.
+static const unsigned MIN_RAYCAST_BVH_TRIANGLES = 64;
+
+/// Cluster of triangles in a contiguous index range of a triangle list geometry, with bounds for culling.
+struct Meshlet
+{
+    /// First index.
+    unsigned indexStart_;
+    /// Number of indices.
+    unsigned indexCount_;
+    /// Bounding sphere center.
+    Vector3 center_;
+    /// Bounding sphere radius.
+    float radius_;
+    /// Axis of the cone containing the triangle normals.
+    Vector3 coneAxis_;
+    /// Cone cutoff. All triangles face away from a viewer at offset d from the center if dot(d, axis) >= cutoff * |d| + radius. One or more if the cone can not cull.
+    float coneCutoff_;
+};
+
 /// Defines one or more vertex buffers, an index buffer and a draw range.
 class URHO3D_API Geometry : public Object
 {
@@ -58,9 +85,13 @@ public:
     /// Set the draw range.
     bool SetDrawRange(PrimitiveType type, unsigned indexStart, unsigned indexCount, unsigned vertexStart, unsigned vertexCount,
         bool checkIllegal = true);
+    /// Set the range of instances to draw from the per-instance vertex buffers. Zero count draws non-instanced.
+    void SetInstanceRange(unsigned instanceStart, unsigned instanceCount);
     /// Set the LOD distance.
     /// @property
     void SetLodDistance(float distance);
+    /// Set the meshlets that divide the draw range for per-cluster culling. Their index ranges must be within the index buffer.
+    void SetMeshlets(const PODVector<Meshlet>& meshlets);
     /// Override raw vertex data to be returned for CPU-side operations.
     void SetRawVertexData(const SharedArrayPtr<unsigned char>& data, const PODVector<VertexElement>& elements);
     /// Override raw vertex data to be returned for CPU-side operations using a legacy vertex bitmask.
@@ -105,10 +136,21 @@ public:
     /// @property
     unsigned GetVertexCount() const { return vertexCount_; }
 
+    /// Return first instance to draw.
+    /// @property
+    unsigned GetInstanceStart() const { return instanceStart_; }
+
+    /// Return number of instances to draw, or zero if drawn non-instanced.
+    /// @property
+    unsigned GetInstanceCount() const { return instanceCount_; }
+
     /// Return LOD distance.
     /// @property
     float GetLodDistance() const { return lodDistance_; }
 
+    /// Return meshlets, or empty if not divided into meshlets.
+    const PODVector<Meshlet>& GetMeshlets() const { return meshlets_; }
+
     /// Return buffers' combined hash value for state sorting.
     unsigned short GetBufferHash() const;
     /// Return raw vertex and index data for CPU operations, or null pointers if not available. Will return data of the first vertex buffer if override data not set.
@@ -116,7 +158,7 @@ public:
     /// Return raw vertex and index data for CPU operations, or null pointers if not available. Will return data of the first vertex buffer if override data not set.
     void GetRawDataShared(SharedArrayPtr<unsigned char>& vertexData, unsigned& vertexSize, SharedArrayPtr<unsigned char>& indexData,
         unsigned& indexSize, const PODVector<VertexElement>*& elements) const;
-    /// Return ray hit distance or infinity if no hit. Requires raw data to be set. Optionally return hit normal and hit uv coordinates at intersect point.
+    /// Return ray hit distance or infinity if no hit. Requires raw data to be set. Optionally return hit normal and hit uv coordinates at intersect point. Indexed triangle lists with non-dynamic data build a bounding volume hierarchy on first use.
     float GetHitDistance(const Ray& ray, Vector3* outNormal = nullptr, Vector2* outUV = nullptr) const;
     /// Return whether or not the ray is inside geometry.
     bool IsInside(const Ray& ray) const;
@@ -126,6 +168,11 @@ public:
     bool IsEmpty() const { return indexCount_ == 0 && vertexCount_ == 0; }
 
 private:
+    /// Return the ray query bounding volume hierarchy matching the current data, building it if necessary, or null if not applicable.
+    TriangleBVH* GetRaycastBVH(const unsigned char* vertexData, unsigned vertexSize, const unsigned char* indexData, unsigned indexSize) const;
+    /// Discard the ray query bounding volume hierarchy.
+    void ResetRaycastBVH();
+
     /// Vertex buffers.
     Vector<SharedPtr<VertexBuffer> > vertexBuffers_;
     /// Index buffer.
@@ -140,8 +187,14 @@ private:
     unsigned vertexStart_;
     /// Number of used vertices.
     unsigned vertexCount_;
+    /// First instance.
+    unsigned instanceStart_;
+    /// Number of instances.
+    unsigned instanceCount_;
     /// LOD distance.
     float lodDistance_;
+    /// Meshlets.
+    PODVector<Meshlet> meshlets_;
     /// Raw vertex data elements.
     PODVector<VertexElement> rawElements_;
     /// Raw vertex data override.
@@ -152,6 +205,18 @@ private:
     unsigned rawVertexSize_;
     /// Raw index data override size.
     unsigned rawIndexSize_;
+    /// Ray query bounding volume hierarchy, built lazily.
+    mutable SharedPtr<TriangleBVH> raycastBVH_;
+    /// Vertex data revision the ray query hierarchy was built from.
+    mutable unsigned raycastBVHVertexRevision_;
+    /// Index data revision the ray query hierarchy was built from.
+    mutable unsigned raycastBVHIndexRevision_;
+    /// Start index the ray query hierarchy was built from.
+    mutable unsigned raycastBVHIndexStart_;
+    /// Number of indices the ray query hierarchy was built from.
+    mutable unsigned raycastBVHIndexCount_;
+    /// Mutex for building the ray query hierarchy from worker threads.
+    mutable Mutex raycastBVHMutex_;
 };
 
 }
@@ -22,7 +22,9 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/Sort.h"
 #include "../Core/Profiler.h"
+#include "../Core/StringUtils.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
 #include "../Graphics/AnimationController.h"
@@ -30,21 +32,28 @@
 #include "../Graphics/CustomGeometry.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/DecalSet.h"
+#include "../Graphics/GPUParticleEmitter.h"
+#include "../Graphics/GPUTerrain.h"
 #include "../Graphics/Graphics.h"
+#include "../Graphics/GraphicsCapture.h"
 #include "../Graphics/GraphicsEvents.h"
 #include "../Graphics/GraphicsImpl.h"
 #include "../Graphics/Material.h"
+#include "../Graphics/MeshletModel.h"
 #include "../Graphics/Octree.h"
 #include "../Graphics/ParticleEffect.h"
 #include "../Graphics/ParticleEmitter.h"
 #include "../Graphics/RibbonTrail.h"
+#include "../Graphics/ScatterModel.h"
 #include "../Graphics/Shader.h"
 #include "../Graphics/ShaderPrecache.h"
+#include "../Graphics/SignificanceManager.h"
 #include "../Graphics/Skybox.h"
 #include "../Graphics/StaticModelGroup.h"
 #include "../Graphics/Technique.h"
 #include "../Graphics/Terrain.h"
 #include "../Graphics/TerrainPatch.h"
+#include "../Graphics/TerrainStreamer.h"
 #ifdef _WIN32
 #include "../Graphics/Texture2D.h"
 #endif
@@ -231,6 +240,24 @@ void Graphics::SetShaderParameter(StringHash param, const Variant& value)
     }
 }
 
+void Graphics::SetMaterialShaderParameters(Material* material)
+{
+#ifdef URHO3D_DILIGENT
+    // Captures record the parameters one by one
+    if (!graphicsCapture_ && impl_->BindMaterialConstants(material))
+        return;
+#endif
+
+    const HashMap<StringHash, MaterialShaderParameter>& parameters = material->GetShaderParameters();
+    for (HashMap<StringHash, MaterialShaderParameter>::ConstIterator i = parameters.Begin(); i != parameters.End(); ++i)
+        SetShaderParameter(i->first_, i->second_.value_);
+
+#ifdef URHO3D_DILIGENT
+    if (!graphicsCapture_)
+        impl_->StoreMaterialConstants(material);
+#endif
+}
+
 IntVector2 Graphics::GetWindowPosition() const
 {
     if (window_)
@@ -368,6 +395,20 @@ void Graphics::EndDumpShaders()
     shaderPrecache_.Reset();
 }
 
+void Graphics::BeginCapture(const String& fileName, unsigned numFrames)
+{
+#ifdef URHO3D_DILIGENT
+    graphicsCapture_ = new GraphicsCapture(context_, fileName, numFrames);
+#else
+    URHO3D_LOGERROR("Graphics command capture is supported only on Diligent");
+#endif
+}
+
+void Graphics::EndCapture()
+{
+    graphicsCapture_.Reset();
+}
+
 void Graphics::PrecacheShaders(Deserializer& source)
 {
     URHO3D_PROFILE(PrecacheShaders);
@@ -375,6 +416,16 @@ void Graphics::PrecacheShaders(Deserializer& source)
     ShaderPrecache::LoadShaders(this, source);
 }
 
+void Graphics::SetAsyncPipelineCompile(bool enable)
+{
+    asyncPipelineCompile_ = enable;
+}
+
+void Graphics::SetUploadBudget(unsigned bytes)
+{
+    uploadBudget_ = bytes;
+}
+
 void Graphics::SetShaderCacheDir(const String& path)
 {
     String trimmedPath = path.Trimmed();
@@ -396,6 +447,112 @@ void Graphics::RemoveGPUObject(GPUObject* object)
     gpuObjects_.Remove(object);
 }
 
+void Graphics::AddGPUMemory(GPUMemoryCategory category, unsigned long long size)
+{
+    MutexLock lock(gpuObjectMutex_);
+
+    GPUMemoryStats& stats = gpuMemoryStats_[category];
+    ++stats.count_;
+    stats.use_ += size;
+    stats.peak_ = Max(stats.peak_, stats.use_);
+    gpuMemoryUse_ += size;
+    gpuMemoryPeak_ = Max(gpuMemoryPeak_, gpuMemoryUse_);
+}
+
+void Graphics::RemoveGPUMemory(GPUMemoryCategory category, unsigned long long size)
+{
+    MutexLock lock(gpuObjectMutex_);
+
+    GPUMemoryStats& stats = gpuMemoryStats_[category];
+    if (stats.count_)
+        --stats.count_;
+    stats.use_ -= Min(stats.use_, size);
+    gpuMemoryUse_ -= Min(gpuMemoryUse_, size);
+}
+
+void Graphics::ResetGPUMemoryPeaks()
+{
+    MutexLock lock(gpuObjectMutex_);
+
+    for (unsigned i = 0; i < MAX_GPU_MEMORY_CATEGORIES; ++i)
+        gpuMemoryStats_[i].peak_ = gpuMemoryStats_[i].use_;
+    gpuMemoryPeak_ = gpuMemoryUse_;
+}
+
+static bool CompareGPUMemoryUse(GPUObject* lhs, GPUObject* rhs)
+{
+    return lhs->GetGPUMemoryUse() > rhs->GetGPUMemoryUse();
+}
+
+String Graphics::PrintGPUMemoryUsage(unsigned maxObjects) const
+{
+    static const char* categoryNames[] =
+    {
+        "Vertex buffers",
+        "Index buffers",
+        "Textures",
+        "Render targets",
+        "Constant buffers",
+        "Other"
+    };
+    static_assert(sizeof(categoryNames) / sizeof(categoryNames[0]) == MAX_GPU_MEMORY_CATEGORIES, "Missing GPU memory category name");
+
+    MutexLock lock(gpuObjectMutex_);
+
+    String output = "GPU Memory                    Cnt   Current      Peak\n\n";
+    char outputLine[256];
+
+    unsigned totalCount = 0;
+    for (unsigned i = 0; i < MAX_GPU_MEMORY_CATEGORIES; ++i)
+    {
+        const GPUMemoryStats& stats = gpuMemoryStats_[i];
+        totalCount += stats.count_;
+        sprintf(outputLine, "%-28s %4u %9s %9s\n", categoryNames[i], stats.count_, GetFileSizeString(stats.use_).CString(),
+            GetFileSizeString(stats.peak_).CString());
+        output += (const char*)outputLine;
+    }
+
+    // Pipeline state sizes can not be queried, so only their count is shown
+    if (pipelineStateStats_.live_)
+    {
+        sprintf(outputLine, "%-28s %4u %9s %9s\n", "Pipeline states", pipelineStateStats_.live_, "-", "-");
+        output += (const char*)outputLine;
+    }
+
+    sprintf(outputLine, "%-28s %4u %9s %9s\n", "All", totalCount, GetFileSizeString(gpuMemoryUse_).CString(),
+        GetFileSizeString(gpuMemoryPeak_).CString());
+    output += (const char*)outputLine;
+
+    if (maxObjects)
+    {
+        PODVector<GPUObject*> objects;
+        for (PODVector<GPUObject*>::ConstIterator i = gpuObjects_.Begin(); i != gpuObjects_.End(); ++i)
+        {
+            if ((*i)->GetGPUMemoryUse())
+                objects.Push(*i);
+        }
+        Sort(objects.Begin(), objects.End(), CompareGPUMemoryUse);
+        if (objects.Size() > maxObjects)
+            objects.Resize(maxObjects);
+
+        if (objects.Size())
+            output += "\nLargest GPU Objects\n\n";
+
+        for (PODVector<GPUObject*>::ConstIterator i = objects.Begin(); i != objects.End(); ++i)
+        {
+            GPUObject* object = *i;
+            auto* texture = dynamic_cast<Texture*>(object);
+            const String name = texture && !texture->GetName().Empty() ? texture->GetName() : String("Unnamed");
+            sprintf(outputLine, "%-16s %9s  ", categoryNames[object->GetGPUMemoryCategory()],
+                GetFileSizeString(object->GetGPUMemoryUse()).CString());
+            output += (const char*)outputLine;
+            output += name + "\n";
+        }
+    }
+
+    return output;
+}
+
 void* Graphics::ReserveScratchBuffer(unsigned size)
 {
     if (!size)
@@ -613,20 +770,26 @@ void RegisterGraphicsLibrary(Context* context)
     Light::RegisterObject(context);
     StaticModel::RegisterObject(context);
     StaticModelGroup::RegisterObject(context);
+    MeshletModel::RegisterObject(context);
+    ScatterModel::RegisterObject(context);
     Skybox::RegisterObject(context);
     AnimatedModel::RegisterObject(context);
     AnimationController::RegisterObject(context);
     BillboardSet::RegisterObject(context);
     ParticleEffect::RegisterObject(context);
     ParticleEmitter::RegisterObject(context);
+    GPUParticleEmitter::RegisterObject(context);
     RibbonTrail::RegisterObject(context);
     CustomGeometry::RegisterObject(context);
     DecalSet::RegisterObject(context);
     Terrain::RegisterObject(context);
     TerrainPatch::RegisterObject(context);
+    TerrainStreamer::RegisterObject(context);
+    GPUTerrain::RegisterObject(context);
     DebugRenderer::RegisterObject(context);
     Octree::RegisterObject(context);
     Zone::RegisterObject(context);
+    SignificanceManager::RegisterObject(context);
 }
 
 }
@@ -43,6 +43,8 @@ class File;
 class Image;
 class IndexBuffer;
 class GPUObject;
+class Material;
+class GraphicsCapture;
 class GraphicsImpl;
 class RenderSurface;
 class Shader;
@@ -58,6 +60,8 @@ class Vector4;
 class VertexBuffer;
 class VertexDeclaration;
 
+struct GPUParticleSimulation;
+struct PipelineStateCreateData;
 struct ShaderParameter;
 
 /// CPU-side scratch buffer for vertex data updates.
@@ -135,6 +139,34 @@ struct WindowModeParams
     ScreenModeParams screenParams_;
 };
 
+/// Pipeline state cache statistics. Collected only on Diligent.
+struct PipelineStateStats
+{
+    /// Pipeline state lookups that found an existing pipeline state.
+    unsigned hits_{};
+    /// Pipeline state lookups that started creating a new pipeline state.
+    unsigned misses_{};
+    /// Pipeline states evicted because a shader variation they were created from was released.
+    unsigned evictions_{};
+    /// Pipeline states currently alive.
+    unsigned live_{};
+    /// Slots in the pipeline state table.
+    unsigned capacity_{};
+    /// Time spent creating pipeline states in microseconds.
+    long long creationTime_{};
+};
+
+/// GPU duration of a timing block, measured with timestamp queries.
+struct GPUTiming
+{
+    /// Block name.
+    String name_;
+    /// Nesting depth, 0 for the whole frame.
+    unsigned depth_{};
+    /// Duration in microseconds.
+    long long time_{};
+};
+
 /// %Graphics subsystem. Manages the application window, rendering state and GPU resources.
 class URHO3D_API Graphics : public Object
 {
@@ -184,6 +216,10 @@ public:
     /// Set whether to flush the GPU command buffer to prevent multiple frames being queued and uneven frame timesteps. Default off, may decrease performance if enabled. Not currently implemented on OpenGL.
     /// @property
     void SetFlushGPU(bool enable);
+    /// Set maximum number of frames the CPU may queue ahead of the GPU, from 1 to MAX_FRAMES_IN_FLIGHT. Default 2. Flushing the GPU limits it to 1. Effective only on Diligent.
+    void SetMaxFramesInFlight(unsigned frames);
+    /// Set whether to pipeline frames by presenting the swap chain on a separate thread, so that the next frame's update overlaps the present of the previous frame. Default false. Effective only on Diligent with a non-OpenGL device.
+    void SetPipelinedFrames(bool enable);
     /// Set forced use of OpenGL 2 even if OpenGL 3 is available. Must be called before setting the screen mode for the first time. Default false. No effect on Direct3D9 & 11.
     void SetForceGL2(bool enable);
     /// Set allowed screen orientations as a space-separated list of "LandscapeLeft", "LandscapeRight", "Portrait" and "PortraitUpsideDown". Affects currently only iOS platform.
@@ -195,6 +231,10 @@ public:
     void Close();
     /// Take a screenshot. Return true if successful.
     bool TakeScreenShot(Image& destImage);
+    /// Request a screenshot to be read back without stalling the GPU. The result is sent with the E_READBACKCOMPLETE event a few frames later. Return request ID, or 0 if not successful. Supported only on Diligent.
+    unsigned RequestScreenShot();
+    /// Request a texture mip level to be read back without stalling the GPU. The texture format must be convertible to an Image, or 32-bit float single channel, in which case the Image holds the raw floats as 4-byte pixels. The result is sent with the E_READBACKCOMPLETE event a few frames later. Return request ID, or 0 if not successful. Supported only on Diligent.
+    unsigned RequestTextureData(Texture2D* texture, unsigned level = 0);
     /// Begin frame rendering. Return true if device available and can render.
     bool BeginFrame();
     /// End frame rendering and swap buffers.
@@ -207,6 +247,30 @@ public:
     bool ResolveToTexture(Texture2D* texture);
     /// Resolve a multisampled cube texture on itself.
     bool ResolveToTexture(TextureCube* texture);
+    /// Copy the whole contents of a texture to another texture of the same size, format and usage. Return true if successful. Supported on Direct3D11 and Diligent.
+    bool CopyTexture(Texture2D* destination, Texture2D* source);
+    /// Skin a vertex range of a source buffer with bone matrices into the same vertices of a destination buffer with a compute shader. The source needs position, blend weight and blend index elements, the destination position and the normal and tangent elements the source has. Both buffers need compute access. Return true if successful. Supported only on Diligent.
+    /// @nobind
+    bool SkinVertices(VertexBuffer* source, VertexBuffer* dest, unsigned vertexStart, unsigned vertexCount, const Matrix3x4* skinMatrices, unsigned numSkinMatrices);
+    /// Add weighted morph deltas to the morph range of a source buffer with a compute shader, writing into the same vertices of a destination buffer. The delta buffer holds position, normal and tangent deltas for each vertex of the range in consecutive blocks, one block per morph, which are selected by block index. At most MAX_COMPUTE_MORPHS morphs can be applied at once. All buffers need compute access. Return true if successful. Supported only on Diligent.
+    /// @nobind
+    bool MorphVertices(VertexBuffer* source, VertexBuffer* dest, VertexBuffer* deltas, unsigned vertexStart, unsigned vertexCount, const unsigned* deltaBlocks, const float* weights, unsigned numMorphs);
+    /// Spawn and simulate GPU particles with a compute shader. The state buffer holds 64 bytes per particle and the destination buffer receives four billboard vertices per particle in the billboard set vertex format, with zero-size quads for dead particles. Both buffers need compute access. Return true if successful. Supported only on Diligent.
+    /// @nobind
+    bool SimulateParticles(VertexBuffer* states, VertexBuffer* dest, const GPUParticleSimulation& simulation);
+    /// Copy index ranges of a source index buffer into a 32-bit destination index buffer with a compute shader. Each range is three values: source index start, destination index start and index count. Both buffers need compute access. Return true if successful. Supported only on Diligent.
+    /// @nobind
+    bool CompactIndices(IndexBuffer* source, IndexBuffer* dest, const unsigned* ranges, unsigned numRanges);
+    /// Run a compute shader over every texel of an output texture, 8x8 texels per thread group. Input textures are indexed by texture unit and bound by the unit's shader name, for example tDiffMap, and at most MAX_COMPUTE_PARAMETERS parameter vectors are passed in the cParams array. The output needs compute access. When async is true and the device has an async compute queue, the work waits for the rendering submitted so far and then overlaps later rendering until WaitAsyncCompute() is called. Rendertargets and textures that are the inputs or output are unbound. Return true if successful. Supported only on Diligent.
+    /// @nobind
+    bool DispatchCompute(const String& shaderName, const String& defines, Texture2D* const* textures, Texture2D* output,
+        const PODVector<Vector4>& parameters, bool async);
+    /// Make subsequent rendering wait for the compute work submitted to the async compute queue. No-op if none is pending.
+    void WaitAsyncCompute();
+    /// Begin a named GPU timing block. Blocks may be nested and are closed with EndGPUTiming(). No effect unless GPU profiling is enabled.
+    void BeginGPUTiming(const String& name);
+    /// End the current GPU timing block.
+    void EndGPUTiming();
     /// Draw non-indexed geometry.
     void Draw(PrimitiveType type, unsigned vertexStart, unsigned vertexCount);
     /// Draw indexed geometry.
@@ -254,6 +318,9 @@ public:
     void SetShaderParameter(StringHash param, const Matrix3x4& matrix);
     /// Set shader constant from a variant. Supported variant types: bool, float, vector2, vector3, vector4, color.
     void SetShaderParameter(StringHash param, const Variant& value);
+    /// Set all shader parameters of a material. On Diligent binds the material's constant block packed for the current shaders when it is up to date, instead of setting the parameters one by one.
+    /// @nobind
+    void SetMaterialShaderParameters(Material* material);
     /// Check whether a shader parameter group needs update. Does not actually check whether parameters exist in the shaders.
     bool NeedParameterUpdate(ShaderParameterGroup group, const void* source);
     /// Check whether a shader parameter exists on the currently set shaders.
@@ -271,6 +338,10 @@ public:
     /// Bind texture unit 0 for update. Called by Texture. Used only on OpenGL.
     /// @nobind
     void SetTextureForUpdate(Texture* texture);
+    /// Set the textures a bindless instanced draw indexes with the texture index of its instance stream. At most MAX_BINDLESS_TEXTURES are used. Used only on Diligent.
+    void SetBindlessTextures(const PODVector<Texture*>& textures);
+    /// Set the light lists of clustered forward lighting: CLUSTER_LIGHT_VECTORS vectors per light, an offset and count pair into the light indices per cluster, and the light indices. Used only on Diligent.
+    void SetClusteredLights(const PODVector<Vector4>& lightData, const PODVector<unsigned>& clusters, const PODVector<unsigned>& lightIndices);
     /// Dirty texture parameters of all textures (when global settings change.)
     /// @nobind
     void SetTextureParametersDirty();
@@ -325,8 +396,22 @@ public:
     void BeginDumpShaders(const String& fileName);
     /// End dumping shader variations names.
     void EndDumpShaders();
+    /// Begin capturing the graphics commands of the following frames to a binary file for replay with the GraphicsReplay tool. The capture ends and the file is written after the given number of frames or on EndCapture(). Supported only on Diligent.
+    void BeginCapture(const String& fileName, unsigned numFrames = 1);
+    /// End and write a graphics command capture.
+    void EndCapture();
     /// Precache shader variations from an XML file generated with BeginDumpShaders().
     void PrecacheShaders(Deserializer& source);
+    /// Load a precompiled shader archive for the current device type, named by appending an underscore and the device type to the file name. Shader variations found in the archive are then created without compiling. Requires the graphics device and should be called before rendering. Supported only on Diligent.
+    bool LoadShaderArchive(const String& fileName);
+    /// Compile shader variations into a precompiled shader archive for each listed device type (d3d11, d3d12, vulkan, gl, gles), named by appending an underscore and the device type to the file name. Compiles on worker threads and does not require the graphics device. Return true if all variations compiled. Supported only on Diligent when built with the archiver.
+    bool SaveShaderArchive(const String& fileName, const PODVector<ShaderVariation*>& variations, const Vector<String>& deviceTypes);
+    /// Set whether to create new pipeline states on worker threads. Draws are skipped until their pipeline state is ready. Effective only on Diligent with Direct3D or Vulkan devices.
+    void SetAsyncPipelineCompile(bool enable);
+    /// Set maximum bytes of texture data uploaded per frame. When nonzero, static textures finishing a background load upload their mip levels at the start of the following frames within the budget and are sampled as a black placeholder until done. Zero (default) uploads immediately. Effective only on Diligent.
+    void SetUploadBudget(unsigned bytes);
+    /// Set whether to measure GPU durations of timing blocks with timestamp queries. Results are resolved a few frames later without stalling. Supported only on Diligent when the device supports timestamp queries.
+    void SetGPUProfiling(bool enable);
     /// Set shader cache directory, Direct3D only. This can either be an absolute path or a path within the resource system.
     /// @property
     void SetShaderCacheDir(const String& path);
@@ -416,9 +501,56 @@ public:
     /// @property
     bool GetFlushGPU() const { return flushGPU_; }
 
+    /// Return maximum number of frames the CPU may queue ahead of the GPU.
+    unsigned GetMaxFramesInFlight() const { return maxFramesInFlight_; }
+
+    /// Return whether frames are pipelined by presenting on a separate thread.
+    bool GetPipelinedFrames() const { return pipelinedFrames_; }
+
     /// Return whether OpenGL 2 use is forced. Effective only on OpenGL.
     bool GetForceGL2() const { return forceGL2_; }
 
+    /// Return whether new pipeline states are created on worker threads. Effective only on Diligent.
+    bool GetAsyncPipelineCompile() const { return asyncPipelineCompile_; }
+
+    /// Return maximum bytes of texture data uploaded per frame, or zero if uploads are immediate.
+    unsigned GetUploadBudget() const { return uploadBudget_; }
+
+    /// Return pipeline state cache statistics.
+    const PipelineStateStats& GetPipelineStateStats() const { return pipelineStateStats_; }
+
+    /// Reset the accumulated pipeline state cache counters. The live pipeline state count and capacity are kept.
+    void ResetPipelineStateStats()
+    {
+        pipelineStateStats_.hits_ = 0;
+        pipelineStateStats_.misses_ = 0;
+        pipelineStateStats_.evictions_ = 0;
+        pipelineStateStats_.creationTime_ = 0;
+    }
+
+    /// Return whether GPU durations of timing blocks are measured.
+    bool GetGPUProfiling() const { return gpuProfiling_; }
+
+    /// Return GPU timing blocks of the latest frame with resolved results, in begin order.
+    const Vector<GPUTiming>& GetGPUTimings() const { return gpuTimings_; }
+
+    /// Return GPU duration of the latest frame with resolved results in microseconds, or 0 if not available.
+    long long GetGPUFrameTime() const { return !gpuTimings_.Empty() && !gpuTimings_[0].depth_ ? gpuTimings_[0].time_ : 0; }
+
+    /// Return GPU memory use of an accounting category.
+    const GPUMemoryStats& GetGPUMemoryStats(GPUMemoryCategory category) const { return gpuMemoryStats_[category]; }
+
+    /// Return total GPU memory use in bytes of all categories.
+    /// @property
+    unsigned long long GetGPUMemoryUse() const { return gpuMemoryUse_; }
+
+    /// Return highest total GPU memory use in bytes since startup or the last reset of the peaks.
+    /// @property
+    unsigned long long GetGPUMemoryPeak() const { return gpuMemoryPeak_; }
+
+    /// Return a GPU memory use report by category, followed by the largest GPU objects up to the given count.
+    String PrintGPUMemoryUsage(unsigned maxObjects = 10) const;
+
     /// Return allowed screen orientations.
     /// @property
     const String& GetOrientations() const { return orientations_; }
@@ -427,6 +559,9 @@ public:
     /// @property
     bool IsDeviceLost() const;
 
+    /// Return whether graphics commands are being captured.
+    bool IsCapturing() const { return graphicsCapture_.NotNull(); }
+
     /// Return number of primitives drawn this frame.
     /// @property
     unsigned GetNumPrimitives() const { return numPrimitives_; }
@@ -448,6 +583,27 @@ public:
     /// @property
     bool GetInstancingSupport() const { return instancingSupport_; }
 
+    /// Return whether shaders can index an array of textures per instance.
+    bool GetBindlessTexturesSupport() const { return bindlessTexturesSupport_; }
+
+    /// Return whether shaders can read clustered forward lighting light lists.
+    bool GetClusteredLightingSupport() const { return clusteredLightingSupport_; }
+
+    /// Return whether vertices can be skinned and morphed and particles simulated with a compute shader.
+    bool GetComputeSkinningSupport() const { return computeSkinningSupport_; }
+
+    /// Return whether whole textures can be copied on the GPU.
+    bool GetTextureCopySupport() const { return textureCopySupport_; }
+
+    /// Return whether screenshots and texture data can be read back without stalling the GPU.
+    bool GetAsyncReadbackSupport() const { return asyncReadbackSupport_; }
+
+    /// Return whether compute work can run on an async compute queue, overlapping rendering.
+    bool GetAsyncComputeSupport() const { return asyncComputeSupport_; }
+
+    /// Return whether compute work submitted to the async compute queue has not yet been waited for.
+    bool IsAsyncComputePending() const { return asyncComputePending_; }
+
     /// Return whether light pre-pass rendering is supported.
     /// @property
     bool GetLightPrepassSupport() const { return lightPrepassSupport_; }
@@ -630,6 +786,12 @@ public:
     void AddGPUObject(GPUObject* object);
     /// Remove a GPU object. Called by GPUObject.
     void RemoveGPUObject(GPUObject* object);
+    /// Record a GPU memory allocation for accounting. Called by GPUObject.
+    void AddGPUMemory(GPUMemoryCategory category, unsigned long long size);
+    /// Record a GPU memory release for accounting. Called by GPUObject.
+    void RemoveGPUMemory(GPUMemoryCategory category, unsigned long long size);
+    /// Reset the GPU memory high-water marks to the current use.
+    void ResetGPUMemoryPeaks();
     /// Reserve a CPU-side scratch buffer.
     void* ReserveScratchBuffer(unsigned size);
     /// Free a CPU-side scratch buffer.
@@ -756,9 +918,25 @@ private:
     void SetVertexAttribDivisor(unsigned location, unsigned divisor);
     /// Release/clear GPU objects and optionally close the window. Used only on OpenGL.
     void Release(bool clearGPUObjects, bool closeWindow);
+    /// Load the pipeline state cache from the shader cache directory. Used only on Diligent.
+    void LoadPipelineStateCache();
+    /// Save the pipeline state cache to the shader cache directory if it has new entries. Used only on Diligent.
+    void SavePipelineStateCache();
+    /// Capture the current rendering state for creating a new pipeline state. Used only on Diligent.
+    void FillPipelineStateCreateData(PipelineStateCreateData& data);
+    /// Store pipeline states finished on worker threads. If wait is true, block until all are finished. Used only on Diligent.
+    void UpdatePendingPipelineStates(bool wait);
+    /// Discard the pipeline state cache if a shader's bytecode has changed since the cache was built. Used only on Diligent.
+    void ValidatePipelineStateCache(ShaderVariation* variation);
+    /// Send the finished readback requests. Used only on Diligent.
+    void UpdateReadbacks();
+    /// Collect the GPU timing results that have become available and publish them to the profilers. Used only on Diligent.
+    void UpdateGPUTimings();
+    /// Update the accounting of GPU memory owned by the backend instead of GPU objects. Used only on Diligent.
+    void UpdateInternalGPUMemory();
 
     /// Mutex for accessing the GPU objects vector from several threads.
-    Mutex gpuObjectMutex_;
+    mutable Mutex gpuObjectMutex_{"GPUObjects"};
     /// Implementation.
     GraphicsImpl* impl_;
     /// SDL window.
@@ -784,10 +962,32 @@ private:
     ScreenModeParams screenParams_;
     /// Flush GPU command buffer flag.
     bool flushGPU_{};
+    /// Maximum number of frames queued ahead of the GPU. Only used on Diligent.
+    unsigned maxFramesInFlight_{2};
+    /// Pipelined frames flag. Only used on Diligent.
+    bool pipelinedFrames_{};
     /// Force OpenGL 2 flag. Only used on OpenGL.
     bool forceGL2_{};
+    /// Asynchronous pipeline state creation flag. Only used on Diligent.
+    bool asyncPipelineCompile_{};
+    /// Texture data upload budget per frame in bytes. Only used on Diligent.
+    unsigned uploadBudget_{};
     /// sRGB conversion on write flag for the main window.
     bool sRGB_{};
+    /// Pipeline state cache statistics.
+    PipelineStateStats pipelineStateStats_;
+    /// GPU profiling flag. Only used on Diligent.
+    bool gpuProfiling_{};
+    /// GPU timing blocks of the latest resolved frame.
+    Vector<GPUTiming> gpuTimings_;
+    /// GPU memory use by category.
+    GPUMemoryStats gpuMemoryStats_[MAX_GPU_MEMORY_CATEGORIES];
+    /// GPU memory owned by the backend by category, included in the category totals. Only used on Diligent.
+    GPUMemoryStats internalGPUMemoryStats_[MAX_GPU_MEMORY_CATEGORIES];
+    /// Total GPU memory use.
+    unsigned long long gpuMemoryUse_{};
+    /// Highest total GPU memory use.
+    unsigned long long gpuMemoryPeak_{};
     /// Light pre-pass rendering support flag.
     bool lightPrepassSupport_{};
     /// Deferred rendering support flag.
@@ -806,6 +1006,20 @@ private:
     bool hardwareShadowSupport_{};
     /// Instancing support flag.
     bool instancingSupport_{};
+    /// Bindless textures support flag.
+    bool bindlessTexturesSupport_{};
+    /// Clustered forward lighting support flag.
+    bool clusteredLightingSupport_{};
+    /// Compute skinning support flag.
+    bool computeSkinningSupport_{};
+    /// Texture copy support flag.
+    bool textureCopySupport_{};
+    /// Asynchronous readback support flag.
+    bool asyncReadbackSupport_{};
+    /// Async compute queue support flag.
+    bool asyncComputeSupport_{};
+    /// Async compute work pending flag.
+    bool asyncComputePending_{};
     /// sRGB conversion on read support flag.
     bool sRGBSupport_{};
     /// sRGB conversion on write support flag.
@@ -910,6 +1124,8 @@ private:
     mutable String lastShaderName_;
     /// Shader precache utility.
     SharedPtr<ShaderPrecache> shaderPrecache_;
+    /// Graphics command capture.
+    SharedPtr<GraphicsCapture> graphicsCapture_;
     /// Allowed screen orientations.
     String orientations_;
     /// Graphics API name.
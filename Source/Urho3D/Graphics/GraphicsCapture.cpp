@@ -0,0 +1,1280 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/GraphicsCapture.h"
+#include "../Graphics/IndexBuffer.h"
+#include "../Graphics/RenderSurface.h"
+#include "../Graphics/Shader.h"
+#include "../Graphics/ShaderVariation.h"
+#include "../Graphics/Texture2D.h"
+#include "../Graphics/Texture2DArray.h"
+#include "../Graphics/Texture3D.h"
+#include "../Graphics/TextureCube.h"
+#include "../Graphics/VertexBuffer.h"
+#include "../IO/File.h"
+#include "../IO/Log.h"
+#include "../Resource/ResourceCache.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Version of the capture file format.
+static const unsigned CAPTURE_VERSION = 2;
+
+/// Commands of the capture stream.
+enum CaptureCommand : unsigned char
+{
+    CAPTURE_BEGINFRAME = 1,
+    CAPTURE_ENDFRAME,
+    CAPTURE_DEFINEVERTEXBUFFER,
+    CAPTURE_DEFINEINDEXBUFFER,
+    CAPTURE_DEFINESHADER,
+    CAPTURE_DEFINETEXTURE,
+    CAPTURE_DEFINESURFACE,
+    CAPTURE_VERTEXBUFFERDATA,
+    CAPTURE_INDEXBUFFERDATA,
+    CAPTURE_CLEAR,
+    CAPTURE_DRAW,
+    CAPTURE_DRAWINDEXED,
+    CAPTURE_VERTEXBUFFERS,
+    CAPTURE_INDEXBUFFER,
+    CAPTURE_SHADERS,
+    CAPTURE_SHADERPARAMETER,
+    CAPTURE_TEXTURE,
+    CAPTURE_BINDLESSTEXTURES,
+    CAPTURE_CLUSTEREDLIGHTS,
+    CAPTURE_RENDERTARGET,
+    CAPTURE_DEPTHSTENCIL,
+    CAPTURE_VIEWPORT,
+    CAPTURE_BLENDMODE,
+    CAPTURE_COLORWRITE,
+    CAPTURE_CULLMODE,
+    CAPTURE_DEPTHBIAS,
+    CAPTURE_DEPTHTEST,
+    CAPTURE_DEPTHWRITE,
+    CAPTURE_FILLMODE,
+    CAPTURE_LINEANTIALIAS,
+    CAPTURE_SCISSORRECT,
+    CAPTURE_SCISSORINTRECT,
+    CAPTURE_STENCILTEST,
+    CAPTURE_CLIPPLANE,
+    CAPTURE_RESOLVEBACKBUFFER,
+    CAPTURE_RESOLVETEXTURE,
+    CAPTURE_COPYTEXTURE,
+    CAPTURE_BEGINGPUTIMING,
+    CAPTURE_ENDGPUTIMING
+};
+
+GraphicsCapture::GraphicsCapture(Context* context, const String& fileName, unsigned numFrames) :
+    Object(context),
+    fileName_(fileName),
+    numFrames_(Max(numFrames, 1U)),
+    numCapturedFrames_(0),
+    width_(0),
+    height_(0),
+    recording_(false),
+    suspended_(false)
+{
+    // ID zero stands for null
+    resources_.Resize(1);
+    dataRevisions_.Resize(1);
+
+    URHO3D_LOGINFO("Capturing {} graphics frame(s) to {}", numFrames_, fileName_);
+}
+
+GraphicsCapture::~GraphicsCapture()
+{
+    if (!numCapturedFrames_)
+    {
+        URHO3D_LOGWARNING("No graphics frames were captured");
+        return;
+    }
+
+    File file(context_, fileName_, FILE_WRITE);
+    if (!file.IsOpen())
+    {
+        URHO3D_LOGERROR("Could not open graphics capture file " + fileName_);
+        return;
+    }
+
+    file.WriteFileID("UCAP");
+    file.WriteUInt(CAPTURE_VERSION);
+    file.WriteInt(width_);
+    file.WriteInt(height_);
+    file.WriteUInt(numCapturedFrames_);
+    file.WriteUInt(commands_.GetSize());
+    file.Write(commands_.GetData(), commands_.GetSize());
+
+    URHO3D_LOGINFO("Wrote {} graphics frame(s) with {} resources to {}", numCapturedFrames_, resources_.Size() - 1, fileName_);
+}
+
+void GraphicsCapture::BeginFrame()
+{
+    auto* graphics = GetSubsystem<Graphics>();
+    if (!graphics)
+        return;
+
+    if (!numCapturedFrames_)
+    {
+        width_ = graphics->GetWidth();
+        height_ = graphics->GetHeight();
+    }
+
+    recording_ = true;
+    WriteCommand(CAPTURE_BEGINFRAME);
+
+    // Record the state carried over from the previous frame. Rendertargets and textures were reset by BeginFrame()
+    RecordBlendMode(graphics->GetBlendMode(), graphics->GetAlphaToCoverage());
+    RecordColorWrite(graphics->GetColorWrite());
+    RecordCullMode(graphics->GetCullMode());
+    RecordDepthBias(graphics->GetDepthConstantBias(), graphics->GetDepthSlopeScaledBias());
+    RecordDepthTest(graphics->GetDepthTest());
+    RecordDepthWrite(graphics->GetDepthWrite());
+    RecordFillMode(graphics->GetFillMode());
+    RecordLineAntiAlias(graphics->GetLineAntiAlias());
+    RecordScissorTest(graphics->GetScissorTest(), graphics->GetScissorRect());
+    RecordStencilTest(graphics->GetStencilTest(), graphics->GetStencilTestMode(), graphics->GetStencilPass(),
+        graphics->GetStencilFail(), graphics->GetStencilZFail(), graphics->GetStencilRef(), graphics->GetStencilCompareMask(),
+        graphics->GetStencilWriteMask());
+
+    PODVector<VertexBuffer*> vertexBuffers;
+    for (unsigned i = 0; i < MAX_VERTEX_STREAMS; ++i)
+        vertexBuffers.Push(graphics->GetVertexBuffer(i));
+    RecordVertexBuffers(vertexBuffers, 0);
+    RecordIndexBuffer(graphics->GetIndexBuffer());
+    RecordShaders(graphics->GetVertexShader(), graphics->GetPixelShader());
+
+    // Shader parameters kept in the constant buffers from the previous frame are not known, so make sure they are set again
+    graphics->ClearParameterSources();
+}
+
+bool GraphicsCapture::EndFrame()
+{
+    if (!recording_)
+        return false;
+
+    WriteCommand(CAPTURE_ENDFRAME);
+    recording_ = false;
+    ++numCapturedFrames_;
+
+    return numCapturedFrames_ >= numFrames_;
+}
+
+void GraphicsCapture::RecordClear(ClearTargetFlags flags, const Color& color, float depth, unsigned stencil)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_CLEAR);
+    commands_.WriteUInt(flags);
+    commands_.WriteColor(color);
+    commands_.WriteFloat(depth);
+    commands_.WriteUInt(stencil);
+}
+
+void GraphicsCapture::RecordDraw(PrimitiveType type, unsigned vertexStart, unsigned vertexCount)
+{
+    if (!IsRecording())
+        return;
+
+    UpdateBufferData();
+    WriteCommand(CAPTURE_DRAW);
+    commands_.WriteUByte((unsigned char)type);
+    commands_.WriteUInt(vertexStart);
+    commands_.WriteUInt(vertexCount);
+}
+
+void GraphicsCapture::RecordDraw(PrimitiveType type, unsigned indexStart, unsigned indexCount, unsigned baseVertexIndex,
+    unsigned minVertex, unsigned vertexCount, unsigned instanceCount)
+{
+    if (!IsRecording())
+        return;
+
+    UpdateBufferData();
+    WriteCommand(CAPTURE_DRAWINDEXED);
+    commands_.WriteUByte((unsigned char)type);
+    commands_.WriteUInt(indexStart);
+    commands_.WriteUInt(indexCount);
+    commands_.WriteUInt(baseVertexIndex);
+    commands_.WriteUInt(minVertex);
+    commands_.WriteUInt(vertexCount);
+    commands_.WriteUInt(instanceCount);
+}
+
+void GraphicsCapture::RecordVertexBuffers(const PODVector<VertexBuffer*>& buffers, unsigned instanceOffset)
+{
+    if (!IsRecording())
+        return;
+
+    PODVector<unsigned> ids(buffers.Size());
+    for (unsigned i = 0; i < buffers.Size(); ++i)
+        ids[i] = GetVertexBufferID(buffers[i]);
+
+    WriteCommand(CAPTURE_VERTEXBUFFERS);
+    commands_.WritePODVector(ids);
+    commands_.WriteUInt(instanceOffset);
+}
+
+void GraphicsCapture::RecordIndexBuffer(IndexBuffer* buffer)
+{
+    if (!IsRecording())
+        return;
+
+    unsigned id = GetIndexBufferID(buffer);
+    WriteCommand(CAPTURE_INDEXBUFFER);
+    commands_.WriteUInt(id);
+}
+
+void GraphicsCapture::RecordShaders(ShaderVariation* vs, ShaderVariation* ps)
+{
+    if (!IsRecording())
+        return;
+
+    unsigned vsID = GetShaderID(vs);
+    unsigned psID = GetShaderID(ps);
+    WriteCommand(CAPTURE_SHADERS);
+    commands_.WriteUInt(vsID);
+    commands_.WriteUInt(psID);
+}
+
+void GraphicsCapture::RecordShaderParameter(StringHash param, const Variant& value)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_SHADERPARAMETER);
+    commands_.WriteStringHash(param);
+    commands_.WriteVariant(value);
+}
+
+void GraphicsCapture::RecordTexture(unsigned index, Texture* texture)
+{
+    if (!IsRecording())
+        return;
+
+    unsigned id = GetTextureID(texture);
+    WriteCommand(CAPTURE_TEXTURE);
+    commands_.WriteUInt(index);
+    commands_.WriteUInt(id);
+}
+
+void GraphicsCapture::RecordBindlessTextures(const PODVector<Texture*>& textures)
+{
+    if (!IsRecording())
+        return;
+
+    PODVector<unsigned> ids(textures.Size());
+    for (unsigned i = 0; i < textures.Size(); ++i)
+        ids[i] = GetTextureID(textures[i]);
+
+    WriteCommand(CAPTURE_BINDLESSTEXTURES);
+    commands_.WritePODVector(ids);
+}
+
+void GraphicsCapture::RecordClusteredLights(const PODVector<Vector4>& lightData, const PODVector<unsigned>& clusters,
+    const PODVector<unsigned>& lightIndices)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_CLUSTEREDLIGHTS);
+    commands_.WritePODVector(lightData);
+    commands_.WritePODVector(clusters);
+    commands_.WritePODVector(lightIndices);
+}
+
+void GraphicsCapture::RecordRenderTarget(unsigned index, RenderSurface* renderTarget)
+{
+    if (!IsRecording())
+        return;
+
+    unsigned id = GetSurfaceID(renderTarget);
+    WriteCommand(CAPTURE_RENDERTARGET);
+    commands_.WriteUInt(index);
+    commands_.WriteUInt(id);
+}
+
+void GraphicsCapture::RecordDepthStencil(RenderSurface* depthStencil)
+{
+    if (!IsRecording())
+        return;
+
+    unsigned id = GetSurfaceID(depthStencil);
+    WriteCommand(CAPTURE_DEPTHSTENCIL);
+    commands_.WriteUInt(id);
+}
+
+void GraphicsCapture::RecordViewport(const IntRect& rect)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_VIEWPORT);
+    commands_.WriteIntRect(rect);
+}
+
+void GraphicsCapture::RecordBlendMode(BlendMode mode, bool alphaToCoverage)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_BLENDMODE);
+    commands_.WriteUByte((unsigned char)mode);
+    commands_.WriteBool(alphaToCoverage);
+}
+
+void GraphicsCapture::RecordColorWrite(bool enable)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_COLORWRITE);
+    commands_.WriteBool(enable);
+}
+
+void GraphicsCapture::RecordCullMode(CullMode mode)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_CULLMODE);
+    commands_.WriteUByte((unsigned char)mode);
+}
+
+void GraphicsCapture::RecordDepthBias(float constantBias, float slopeScaledBias)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_DEPTHBIAS);
+    commands_.WriteFloat(constantBias);
+    commands_.WriteFloat(slopeScaledBias);
+}
+
+void GraphicsCapture::RecordDepthTest(CompareMode mode)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_DEPTHTEST);
+    commands_.WriteUByte((unsigned char)mode);
+}
+
+void GraphicsCapture::RecordDepthWrite(bool enable)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_DEPTHWRITE);
+    commands_.WriteBool(enable);
+}
+
+void GraphicsCapture::RecordFillMode(FillMode mode)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_FILLMODE);
+    commands_.WriteUByte((unsigned char)mode);
+}
+
+void GraphicsCapture::RecordLineAntiAlias(bool enable)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_LINEANTIALIAS);
+    commands_.WriteBool(enable);
+}
+
+void GraphicsCapture::RecordScissorTest(bool enable, const Rect& rect, bool borderInclusive)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_SCISSORRECT);
+    commands_.WriteBool(enable);
+    commands_.WriteRect(rect);
+    commands_.WriteBool(borderInclusive);
+}
+
+void GraphicsCapture::RecordScissorTest(bool enable, const IntRect& rect)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_SCISSORINTRECT);
+    commands_.WriteBool(enable);
+    commands_.WriteIntRect(rect);
+}
+
+void GraphicsCapture::RecordStencilTest(bool enable, CompareMode mode, StencilOp pass, StencilOp fail, StencilOp zFail,
+    unsigned stencilRef, unsigned compareMask, unsigned writeMask)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_STENCILTEST);
+    commands_.WriteBool(enable);
+    commands_.WriteUByte((unsigned char)mode);
+    commands_.WriteUByte((unsigned char)pass);
+    commands_.WriteUByte((unsigned char)fail);
+    commands_.WriteUByte((unsigned char)zFail);
+    commands_.WriteUInt(stencilRef);
+    commands_.WriteUInt(compareMask);
+    commands_.WriteUInt(writeMask);
+}
+
+void GraphicsCapture::RecordClipPlane(bool enable, const Plane& clipPlane, const Matrix3x4& view, const Matrix4& projection)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_CLIPPLANE);
+    commands_.WriteBool(enable);
+    commands_.WriteVector4(Vector4(clipPlane.normal_, clipPlane.d_));
+    commands_.WriteMatrix3x4(view);
+    commands_.WriteMatrix4(projection);
+}
+
+void GraphicsCapture::RecordResolveToTexture(Texture2D* destination, const IntRect& viewport)
+{
+    if (!IsRecording())
+        return;
+
+    unsigned id = GetTextureID(destination);
+    WriteCommand(CAPTURE_RESOLVEBACKBUFFER);
+    commands_.WriteUInt(id);
+    commands_.WriteIntRect(viewport);
+}
+
+void GraphicsCapture::RecordResolveToTexture(Texture* texture)
+{
+    if (!IsRecording())
+        return;
+
+    unsigned id = GetTextureID(texture);
+    WriteCommand(CAPTURE_RESOLVETEXTURE);
+    commands_.WriteUInt(id);
+}
+
+void GraphicsCapture::RecordCopyTexture(Texture2D* destination, Texture2D* source)
+{
+    if (!IsRecording())
+        return;
+
+    unsigned destID = GetTextureID(destination);
+    unsigned sourceID = GetTextureID(source);
+    WriteCommand(CAPTURE_COPYTEXTURE);
+    commands_.WriteUInt(destID);
+    commands_.WriteUInt(sourceID);
+}
+
+void GraphicsCapture::RecordBeginGPUTiming(const String& name)
+{
+    if (!IsRecording())
+        return;
+
+    WriteCommand(CAPTURE_BEGINGPUTIMING);
+    commands_.WriteString(name);
+}
+
+void GraphicsCapture::RecordEndGPUTiming()
+{
+    if (IsRecording())
+        WriteCommand(CAPTURE_ENDGPUTIMING);
+}
+
+void GraphicsCapture::WriteCommand(unsigned char command)
+{
+    commands_.WriteUByte(command);
+}
+
+unsigned GraphicsCapture::GetVertexBufferID(VertexBuffer* buffer)
+{
+    if (!buffer)
+        return 0;
+
+    unsigned id = FindID(buffer);
+    if (id)
+        return id;
+
+    // Buffers without a CPU-side copy can not be read back, so keep one from now on. Their contents are recorded from
+    // the next time they are written
+    bool hasData = buffer->IsShadowed();
+    if (!hasData)
+        buffer->SetShadowed(true);
+
+    id = AddID(buffer);
+    WriteCommand(CAPTURE_DEFINEVERTEXBUFFER);
+    commands_.WriteUInt(id);
+    commands_.WriteUInt(buffer->GetVertexCount());
+    const PODVector<VertexElement>& elements = buffer->GetElements();
+    commands_.WriteVLE(elements.Size());
+    for (unsigned i = 0; i < elements.Size(); ++i)
+    {
+        commands_.WriteUByte((unsigned char)elements[i].type_);
+        commands_.WriteUByte((unsigned char)elements[i].semantic_);
+        commands_.WriteUByte(elements[i].index_);
+        commands_.WriteBool(elements[i].perInstance_);
+    }
+    commands_.WriteBool(buffer->IsDynamic());
+
+    if (!hasData)
+        dataRevisions_[id] = buffer->GetDataRevision();
+
+    return id;
+}
+
+unsigned GraphicsCapture::GetIndexBufferID(IndexBuffer* buffer)
+{
+    if (!buffer)
+        return 0;
+
+    unsigned id = FindID(buffer);
+    if (id)
+        return id;
+
+    bool hasData = buffer->IsShadowed();
+    if (!hasData)
+        buffer->SetShadowed(true);
+
+    id = AddID(buffer);
+    WriteCommand(CAPTURE_DEFINEINDEXBUFFER);
+    commands_.WriteUInt(id);
+    commands_.WriteUInt(buffer->GetIndexCount());
+    commands_.WriteBool(buffer->GetIndexSize() > sizeof(unsigned short));
+    commands_.WriteBool(buffer->IsDynamic());
+
+    if (!hasData)
+        dataRevisions_[id] = buffer->GetDataRevision();
+
+    return id;
+}
+
+unsigned GraphicsCapture::GetShaderID(ShaderVariation* variation)
+{
+    if (!variation || !variation->GetOwner())
+        return 0;
+
+    unsigned id = FindID(variation);
+    if (id)
+        return id;
+
+    id = AddID(variation);
+    WriteCommand(CAPTURE_DEFINESHADER);
+    commands_.WriteUInt(id);
+    commands_.WriteUByte((unsigned char)variation->GetShaderType());
+    commands_.WriteString(variation->GetOwner()->GetName());
+    commands_.WriteString(variation->GetDefines());
+
+    return id;
+}
+
+unsigned GraphicsCapture::GetTextureID(Texture* texture)
+{
+    if (!texture)
+        return 0;
+
+    unsigned id = FindID(texture);
+    if (id)
+        return id;
+
+    int depth = texture->GetDepth();
+    if (texture->GetType() == Texture2DArray::GetTypeStatic())
+        depth = (int)static_cast<Texture2DArray*>(texture)->GetLayers();
+
+    // Textures are referenced by resource name, or recreated with the same parameters if they were created by code
+    id = AddID(texture);
+    WriteCommand(CAPTURE_DEFINETEXTURE);
+    commands_.WriteUInt(id);
+    commands_.WriteStringHash(texture->GetType());
+    commands_.WriteString(texture->GetName());
+    commands_.WriteInt(texture->GetWidth());
+    commands_.WriteInt(texture->GetHeight());
+    commands_.WriteInt(depth);
+    commands_.WriteUInt(texture->GetFormat());
+    commands_.WriteUByte((unsigned char)texture->GetUsage());
+    commands_.WriteUInt(texture->GetLevels());
+    commands_.WriteInt(texture->GetMultiSample());
+    commands_.WriteBool(texture->GetAutoResolve());
+    commands_.WriteBool(texture->GetSRGB());
+    commands_.WriteUByte((unsigned char)texture->GetFilterMode());
+    for (unsigned i = 0; i < MAX_COORDS; ++i)
+        commands_.WriteUByte((unsigned char)texture->GetAddressMode((TextureCoordinate)i));
+    commands_.WriteUInt(texture->GetAnisotropy());
+    commands_.WriteBool(texture->GetShadowCompare());
+    commands_.WriteColor(texture->GetBorderColor());
+
+    return id;
+}
+
+unsigned GraphicsCapture::GetSurfaceID(RenderSurface* surface)
+{
+    if (!surface || !surface->GetParentTexture())
+        return 0;
+
+    unsigned id = FindID(surface);
+    if (id)
+        return id;
+
+    Texture* texture = surface->GetParentTexture();
+    unsigned textureID = GetTextureID(texture);
+    unsigned char face = 0;
+    if (texture->GetType() == TextureCube::GetTypeStatic())
+    {
+        auto* cube = static_cast<TextureCube*>(texture);
+        for (unsigned i = 0; i < MAX_CUBEMAP_FACES; ++i)
+        {
+            if (cube->GetRenderSurface((CubeMapFace)i) == surface)
+                face = (unsigned char)i;
+        }
+    }
+
+    id = AddID(surface);
+    WriteCommand(CAPTURE_DEFINESURFACE);
+    commands_.WriteUInt(id);
+    commands_.WriteUInt(textureID);
+    commands_.WriteUByte(face);
+
+    return id;
+}
+
+unsigned GraphicsCapture::FindID(RefCounted* object) const
+{
+    HashMap<RefCounted*, unsigned>::ConstIterator i = resourceIDs_.Find(object);
+    // An object at the same address may have been destroyed and a new one created in its place
+    return i != resourceIDs_.End() && resources_[i->second_].Get() == object ? i->second_ : 0;
+}
+
+unsigned GraphicsCapture::AddID(RefCounted* object)
+{
+    unsigned id = resources_.Size();
+    resources_.Push(WeakPtr<RefCounted>(object));
+    dataRevisions_.Push(M_MAX_UNSIGNED);
+    resourceIDs_[object] = id;
+    return id;
+}
+
+void GraphicsCapture::UpdateBufferData()
+{
+    auto* graphics = GetSubsystem<Graphics>();
+
+    for (unsigned i = 0; i < MAX_VERTEX_STREAMS; ++i)
+    {
+        VertexBuffer* buffer = graphics->GetVertexBuffer(i);
+        unsigned id = buffer ? FindID(buffer) : 0;
+        if (id && buffer->GetShadowData() && dataRevisions_[id] != buffer->GetDataRevision())
+        {
+            dataRevisions_[id] = buffer->GetDataRevision();
+            WriteCommand(CAPTURE_VERTEXBUFFERDATA);
+            commands_.WriteUInt(id);
+            unsigned size = buffer->GetVertexCount() * buffer->GetVertexSize();
+            commands_.WriteVLE(size);
+            commands_.Write(buffer->GetShadowData(), size);
+        }
+    }
+
+    IndexBuffer* buffer = graphics->GetIndexBuffer();
+    unsigned id = buffer ? FindID(buffer) : 0;
+    if (id && buffer->GetShadowData() && dataRevisions_[id] != buffer->GetDataRevision())
+    {
+        dataRevisions_[id] = buffer->GetDataRevision();
+        WriteCommand(CAPTURE_INDEXBUFFERDATA);
+        commands_.WriteUInt(id);
+        unsigned size = buffer->GetIndexCount() * buffer->GetIndexSize();
+        commands_.WriteVLE(size);
+        commands_.Write(buffer->GetShadowData(), size);
+    }
+}
+
+GraphicsReplay::GraphicsReplay(Context* context) :
+    Object(context),
+    numFrames_(0),
+    nextFrame_(0),
+    numDraws_(0),
+    width_(0),
+    height_(0)
+{
+    Reset();
+}
+
+GraphicsReplay::~GraphicsReplay() = default;
+
+bool GraphicsReplay::Load(Deserializer& source)
+{
+    commands_.Clear();
+    numFrames_ = 0;
+    Reset();
+
+    if (source.ReadFileID() != "UCAP")
+    {
+        URHO3D_LOGERROR(source.GetName() + " is not a valid graphics capture file");
+        return false;
+    }
+
+    unsigned version = source.ReadUInt();
+    if (version != CAPTURE_VERSION)
+    {
+        URHO3D_LOGERROR("Unsupported graphics capture version {} in {}", version, source.GetName());
+        return false;
+    }
+
+    width_ = source.ReadInt();
+    height_ = source.ReadInt();
+    unsigned numFrames = source.ReadUInt();
+    unsigned size = source.ReadUInt();
+    commands_.SetData(source, size);
+    if (commands_.GetSize() != size || !numFrames)
+    {
+        URHO3D_LOGERROR("Truncated graphics capture file " + source.GetName());
+        commands_.Clear();
+        return false;
+    }
+
+    numFrames_ = numFrames;
+    return true;
+}
+
+bool GraphicsReplay::ReplayFrame()
+{
+    auto* graphics = GetSubsystem<Graphics>();
+    if (!graphics || !numFrames_)
+        return false;
+
+    if (nextFrame_ >= numFrames_)
+    {
+        commands_.Seek(0);
+        nextFrame_ = 0;
+    }
+
+    if (!graphics->BeginFrame())
+        return false;
+
+    bool success = commands_.ReadUByte() == CAPTURE_BEGINFRAME && ReplayCommands(graphics);
+    graphics->EndFrame();
+
+    if (!success)
+    {
+        URHO3D_LOGERROR("Invalid graphics capture data in frame {}", nextFrame_);
+        // Start over from the first frame, keeping the resources
+        nextFrame_ = numFrames_;
+        return false;
+    }
+
+    ++nextFrame_;
+    return true;
+}
+
+void GraphicsReplay::Reset()
+{
+    resources_.Clear();
+    resourceTypes_.Clear();
+    // ID zero stands for null
+    resources_.Resize(1);
+    resourceTypes_.Resize(1);
+    resourceTypes_[0] = 0;
+
+    commands_.Seek(0);
+    nextFrame_ = 0;
+    numDraws_ = 0;
+}
+
+bool GraphicsReplay::ReplayCommands(Graphics* graphics)
+{
+    URHO3D_PROFILE(ReplayGraphicsCommands);
+
+    numDraws_ = 0;
+
+    while (!commands_.IsEof())
+    {
+        unsigned char command = commands_.ReadUByte();
+
+        switch (command)
+        {
+        case CAPTURE_ENDFRAME:
+            return true;
+
+        case CAPTURE_DEFINEVERTEXBUFFER:
+        case CAPTURE_DEFINEINDEXBUFFER:
+        case CAPTURE_DEFINESHADER:
+        case CAPTURE_DEFINETEXTURE:
+        case CAPTURE_DEFINESURFACE:
+            if (!DefineResource(command, graphics))
+                return false;
+            break;
+
+        case CAPTURE_VERTEXBUFFERDATA:
+            {
+                auto* buffer = static_cast<VertexBuffer*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINEVERTEXBUFFER));
+                unsigned size = commands_.ReadVLE();
+                if (size > commands_.GetSize() - commands_.GetPosition())
+                    return false;
+                // Use the data directly from the stream
+                if (buffer && size == buffer->GetVertexCount() * buffer->GetVertexSize())
+                    buffer->SetData(commands_.GetData() + commands_.GetPosition());
+                commands_.Seek(commands_.GetPosition() + size);
+            }
+            break;
+
+        case CAPTURE_INDEXBUFFERDATA:
+            {
+                auto* buffer = static_cast<IndexBuffer*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINEINDEXBUFFER));
+                unsigned size = commands_.ReadVLE();
+                if (size > commands_.GetSize() - commands_.GetPosition())
+                    return false;
+                if (buffer && size == buffer->GetIndexCount() * buffer->GetIndexSize())
+                    buffer->SetData(commands_.GetData() + commands_.GetPosition());
+                commands_.Seek(commands_.GetPosition() + size);
+            }
+            break;
+
+        case CAPTURE_CLEAR:
+            {
+                auto flags = (ClearTargetFlags)commands_.ReadUInt();
+                Color color = commands_.ReadColor();
+                float depth = commands_.ReadFloat();
+                unsigned stencil = commands_.ReadUInt();
+                graphics->Clear(flags, color, depth, stencil);
+            }
+            break;
+
+        case CAPTURE_DRAW:
+            {
+                auto type = (PrimitiveType)commands_.ReadUByte();
+                unsigned vertexStart = commands_.ReadUInt();
+                unsigned vertexCount = commands_.ReadUInt();
+                graphics->Draw(type, vertexStart, vertexCount);
+                ++numDraws_;
+            }
+            break;
+
+        case CAPTURE_DRAWINDEXED:
+            {
+                auto type = (PrimitiveType)commands_.ReadUByte();
+                unsigned indexStart = commands_.ReadUInt();
+                unsigned indexCount = commands_.ReadUInt();
+                unsigned baseVertexIndex = commands_.ReadUInt();
+                unsigned minVertex = commands_.ReadUInt();
+                unsigned vertexCount = commands_.ReadUInt();
+                unsigned instanceCount = commands_.ReadUInt();
+                // The index buffer may have failed to be recreated
+                if (!graphics->GetIndexBuffer())
+                    break;
+                if (instanceCount)
+                    graphics->DrawInstanced(type, indexStart, indexCount, baseVertexIndex, minVertex, vertexCount, instanceCount);
+                else
+                    graphics->Draw(type, indexStart, indexCount, baseVertexIndex, minVertex, vertexCount);
+                ++numDraws_;
+            }
+            break;
+
+        case CAPTURE_VERTEXBUFFERS:
+            {
+                PODVector<unsigned> ids = commands_.ReadPODVector<unsigned>();
+                unsigned instanceOffset = commands_.ReadUInt();
+                vertexBuffers_.Resize(Min(ids.Size(), MAX_VERTEX_STREAMS));
+                for (unsigned i = 0; i < vertexBuffers_.Size(); ++i)
+                    vertexBuffers_[i] = static_cast<VertexBuffer*>(GetResource(ids[i], CAPTURE_DEFINEVERTEXBUFFER));
+                graphics->SetVertexBuffers(vertexBuffers_, instanceOffset);
+            }
+            break;
+
+        case CAPTURE_INDEXBUFFER:
+            graphics->SetIndexBuffer(static_cast<IndexBuffer*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINEINDEXBUFFER)));
+            break;
+
+        case CAPTURE_SHADERS:
+            {
+                auto* vs = static_cast<ShaderVariation*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINESHADER));
+                auto* ps = static_cast<ShaderVariation*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINESHADER));
+                graphics->SetShaders(vs, ps);
+            }
+            break;
+
+        case CAPTURE_SHADERPARAMETER:
+            {
+                StringHash param = commands_.ReadStringHash();
+                Variant value = commands_.ReadVariant();
+                graphics->SetShaderParameter(param, value);
+            }
+            break;
+
+        case CAPTURE_TEXTURE:
+            {
+                unsigned index = commands_.ReadUInt();
+                auto* texture = static_cast<Texture*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINETEXTURE));
+                graphics->SetTexture(index, texture);
+            }
+            break;
+
+        case CAPTURE_BINDLESSTEXTURES:
+            {
+                PODVector<unsigned> ids = commands_.ReadPODVector<unsigned>();
+                textures_.Resize(ids.Size());
+                for (unsigned i = 0; i < ids.Size(); ++i)
+                    textures_[i] = static_cast<Texture*>(GetResource(ids[i], CAPTURE_DEFINETEXTURE));
+                graphics->SetBindlessTextures(textures_);
+            }
+            break;
+
+        case CAPTURE_CLUSTEREDLIGHTS:
+            {
+                PODVector<Vector4> lightData = commands_.ReadPODVector<Vector4>();
+                PODVector<unsigned> clusters = commands_.ReadPODVector<unsigned>();
+                PODVector<unsigned> lightIndices = commands_.ReadPODVector<unsigned>();
+                graphics->SetClusteredLights(lightData, clusters, lightIndices);
+            }
+            break;
+
+        case CAPTURE_RENDERTARGET:
+            {
+                unsigned index = commands_.ReadUInt();
+                auto* surface = static_cast<RenderSurface*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINESURFACE));
+                graphics->SetRenderTarget(index, surface);
+            }
+            break;
+
+        case CAPTURE_DEPTHSTENCIL:
+            graphics->SetDepthStencil(static_cast<RenderSurface*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINESURFACE)));
+            break;
+
+        case CAPTURE_VIEWPORT:
+            graphics->SetViewport(commands_.ReadIntRect());
+            break;
+
+        case CAPTURE_BLENDMODE:
+            {
+                auto mode = (BlendMode)commands_.ReadUByte();
+                bool alphaToCoverage = commands_.ReadBool();
+                graphics->SetBlendMode(mode, alphaToCoverage);
+            }
+            break;
+
+        case CAPTURE_COLORWRITE:
+            graphics->SetColorWrite(commands_.ReadBool());
+            break;
+
+        case CAPTURE_CULLMODE:
+            graphics->SetCullMode((CullMode)commands_.ReadUByte());
+            break;
+
+        case CAPTURE_DEPTHBIAS:
+            {
+                float constantBias = commands_.ReadFloat();
+                float slopeScaledBias = commands_.ReadFloat();
+                graphics->SetDepthBias(constantBias, slopeScaledBias);
+            }
+            break;
+
+        case CAPTURE_DEPTHTEST:
+            graphics->SetDepthTest((CompareMode)commands_.ReadUByte());
+            break;
+
+        case CAPTURE_DEPTHWRITE:
+            graphics->SetDepthWrite(commands_.ReadBool());
+            break;
+
+        case CAPTURE_FILLMODE:
+            graphics->SetFillMode((FillMode)commands_.ReadUByte());
+            break;
+
+        case CAPTURE_LINEANTIALIAS:
+            graphics->SetLineAntiAlias(commands_.ReadBool());
+            break;
+
+        case CAPTURE_SCISSORRECT:
+            {
+                bool enable = commands_.ReadBool();
+                Rect rect = commands_.ReadRect();
+                bool borderInclusive = commands_.ReadBool();
+                graphics->SetScissorTest(enable, rect, borderInclusive);
+            }
+            break;
+
+        case CAPTURE_SCISSORINTRECT:
+            {
+                bool enable = commands_.ReadBool();
+                IntRect rect = commands_.ReadIntRect();
+                graphics->SetScissorTest(enable, rect);
+            }
+            break;
+
+        case CAPTURE_STENCILTEST:
+            {
+                bool enable = commands_.ReadBool();
+                auto mode = (CompareMode)commands_.ReadUByte();
+                auto pass = (StencilOp)commands_.ReadUByte();
+                auto fail = (StencilOp)commands_.ReadUByte();
+                auto zFail = (StencilOp)commands_.ReadUByte();
+                unsigned stencilRef = commands_.ReadUInt();
+                unsigned compareMask = commands_.ReadUInt();
+                unsigned writeMask = commands_.ReadUInt();
+                graphics->SetStencilTest(enable, mode, pass, fail, zFail, stencilRef, compareMask, writeMask);
+            }
+            break;
+
+        case CAPTURE_CLIPPLANE:
+            {
+                bool enable = commands_.ReadBool();
+                Plane clipPlane(commands_.ReadVector4());
+                Matrix3x4 view = commands_.ReadMatrix3x4();
+                Matrix4 projection = commands_.ReadMatrix4();
+                graphics->SetClipPlane(enable, clipPlane, view, projection);
+            }
+            break;
+
+        case CAPTURE_RESOLVEBACKBUFFER:
+            {
+                auto* texture = static_cast<Texture*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINETEXTURE));
+                IntRect viewport = commands_.ReadIntRect();
+                if (texture && texture->GetType() == Texture2D::GetTypeStatic())
+                    graphics->ResolveToTexture(static_cast<Texture2D*>(texture), viewport);
+            }
+            break;
+
+        case CAPTURE_RESOLVETEXTURE:
+            {
+                auto* texture = static_cast<Texture*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINETEXTURE));
+                if (texture && texture->GetType() == Texture2D::GetTypeStatic())
+                    graphics->ResolveToTexture(static_cast<Texture2D*>(texture));
+                else if (texture && texture->GetType() == TextureCube::GetTypeStatic())
+                    graphics->ResolveToTexture(static_cast<TextureCube*>(texture));
+            }
+            break;
+
+        case CAPTURE_COPYTEXTURE:
+            {
+                auto* destination = static_cast<Texture*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINETEXTURE));
+                auto* source = static_cast<Texture*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINETEXTURE));
+                if (destination && source && destination->GetType() == Texture2D::GetTypeStatic() &&
+                    source->GetType() == Texture2D::GetTypeStatic())
+                    graphics->CopyTexture(static_cast<Texture2D*>(destination), static_cast<Texture2D*>(source));
+            }
+            break;
+
+        case CAPTURE_BEGINGPUTIMING:
+            graphics->BeginGPUTiming(commands_.ReadString());
+            break;
+
+        case CAPTURE_ENDGPUTIMING:
+            graphics->EndGPUTiming();
+            break;
+
+        default:
+            URHO3D_LOGERROR("Unknown graphics capture command {}", (unsigned)command);
+            return false;
+        }
+    }
+
+    // The stream ended without the end of the frame
+    return false;
+}
+
+bool GraphicsReplay::DefineResource(unsigned char command, Graphics* graphics)
+{
+    unsigned id = commands_.ReadUInt();
+    if (!id)
+        return false;
+
+    if (id >= resources_.Size())
+    {
+        resources_.Resize(id + 1);
+        resourceTypes_.Resize(id + 1, 0);
+    }
+    // When starting over from the first frame, the resources already exist
+    bool create = resourceTypes_[id] != command;
+    resourceTypes_[id] = command;
+
+    auto* cache = GetSubsystem<ResourceCache>();
+
+    switch (command)
+    {
+    case CAPTURE_DEFINEVERTEXBUFFER:
+        {
+            unsigned vertexCount = commands_.ReadUInt();
+            PODVector<VertexElement> elements(commands_.ReadVLE());
+            for (unsigned i = 0; i < elements.Size(); ++i)
+            {
+                elements[i].type_ = (VertexElementType)commands_.ReadUByte();
+                elements[i].semantic_ = (VertexElementSemantic)commands_.ReadUByte();
+                elements[i].index_ = commands_.ReadUByte();
+                elements[i].perInstance_ = commands_.ReadBool();
+            }
+            bool dynamic = commands_.ReadBool();
+
+            if (create)
+            {
+                SharedPtr<VertexBuffer> buffer(new VertexBuffer(context_));
+                buffer->SetShadowed(true);
+                buffer->SetSize(vertexCount, elements, dynamic);
+                // Contents not recorded during the capture stay zero
+                if (buffer->GetShadowData())
+                {
+                    memset(buffer->GetShadowData(), 0, vertexCount * buffer->GetVertexSize());
+                    buffer->SetData(buffer->GetShadowData());
+                }
+                resources_[id] = buffer;
+            }
+        }
+        break;
+
+    case CAPTURE_DEFINEINDEXBUFFER:
+        {
+            unsigned indexCount = commands_.ReadUInt();
+            bool largeIndices = commands_.ReadBool();
+            bool dynamic = commands_.ReadBool();
+
+            if (create)
+            {
+                SharedPtr<IndexBuffer> buffer(new IndexBuffer(context_));
+                buffer->SetShadowed(true);
+                buffer->SetSize(indexCount, largeIndices, dynamic);
+                if (buffer->GetShadowData())
+                {
+                    memset(buffer->GetShadowData(), 0, indexCount * buffer->GetIndexSize());
+                    buffer->SetData(buffer->GetShadowData());
+                }
+                resources_[id] = buffer;
+            }
+        }
+        break;
+
+    case CAPTURE_DEFINESHADER:
+        {
+            auto type = (ShaderType)commands_.ReadUByte();
+            String name = commands_.ReadString();
+            String defines = commands_.ReadString();
+
+            if (create)
+            {
+                auto* shader = cache->GetResource<Shader>(name);
+                resources_[id] = shader ? shader->GetVariation(type, defines) : nullptr;
+            }
+        }
+        break;
+
+    case CAPTURE_DEFINETEXTURE:
+        {
+            StringHash type = commands_.ReadStringHash();
+            String name = commands_.ReadString();
+            int width = commands_.ReadInt();
+            int height = commands_.ReadInt();
+            int depth = commands_.ReadInt();
+            unsigned format = commands_.ReadUInt();
+            auto usage = (TextureUsage)commands_.ReadUByte();
+            unsigned levels = commands_.ReadUInt();
+            int multiSample = commands_.ReadInt();
+            bool autoResolve = commands_.ReadBool();
+            bool sRGB = commands_.ReadBool();
+            auto filterMode = (TextureFilterMode)commands_.ReadUByte();
+            TextureAddressMode addressModes[MAX_COORDS];
+            for (unsigned i = 0; i < MAX_COORDS; ++i)
+                addressModes[i] = (TextureAddressMode)commands_.ReadUByte();
+            unsigned anisotropy = commands_.ReadUInt();
+            bool shadowCompare = commands_.ReadBool();
+            Color borderColor = commands_.ReadColor();
+
+            if (!create)
+                break;
+
+            if (type != Texture2D::GetTypeStatic() && type != TextureCube::GetTypeStatic() && type != Texture3D::GetTypeStatic() &&
+                type != Texture2DArray::GetTypeStatic())
+                return false;
+
+            // Textures loaded from resources are loaded again, rendertargets and textures created by code are recreated
+            // empty with the same parameters
+            SharedPtr<Texture> texture;
+            if (!name.Empty() && usage < TEXTURE_RENDERTARGET)
+                texture = static_cast<Texture*>(cache->GetResource(type, name, false));
+
+            if (!texture)
+            {
+                texture = StaticCast<Texture>(context_->CreateObject(type));
+                texture->SetName(name);
+                texture->SetNumLevels(levels);
+                texture->SetSRGB(sRGB);
+                texture->SetFilterMode(filterMode);
+                for (unsigned i = 0; i < MAX_COORDS; ++i)
+                    texture->SetAddressMode((TextureCoordinate)i, addressModes[i]);
+                texture->SetAnisotropy(anisotropy);
+                texture->SetShadowCompare(shadowCompare);
+                texture->SetBorderColor(borderColor);
+
+                bool success = false;
+                if (type == Texture2D::GetTypeStatic())
+                    success = static_cast<Texture2D*>(texture.Get())->SetSize(width, height, format, usage, multiSample, autoResolve);
+                else if (type == TextureCube::GetTypeStatic())
+                    success = static_cast<TextureCube*>(texture.Get())->SetSize(width, format, usage, multiSample);
+                else if (type == Texture3D::GetTypeStatic())
+                    success = static_cast<Texture3D*>(texture.Get())->SetSize(width, height, depth, format, usage);
+                else
+                    success = static_cast<Texture2DArray*>(texture.Get())->SetSize((unsigned)depth, width, height, format, usage);
+
+                if (!success)
+                    URHO3D_LOGWARNING("Failed to recreate captured texture {}", name.Empty() ? String(id) : name);
+            }
+
+            resources_[id] = texture;
+        }
+        break;
+
+    case CAPTURE_DEFINESURFACE:
+        {
+            auto* texture = static_cast<Texture*>(GetResource(commands_.ReadUInt(), CAPTURE_DEFINETEXTURE));
+            unsigned char face = commands_.ReadUByte();
+
+            if (create)
+            {
+                RenderSurface* surface = nullptr;
+                if (texture && texture->GetType() == Texture2D::GetTypeStatic())
+                    surface = static_cast<Texture2D*>(texture)->GetRenderSurface();
+                else if (texture && texture->GetType() == TextureCube::GetTypeStatic() && face < MAX_CUBEMAP_FACES)
+                    surface = static_cast<TextureCube*>(texture)->GetRenderSurface((CubeMapFace)face);
+                else if (texture && texture->GetType() == Texture2DArray::GetTypeStatic())
+                    surface = static_cast<Texture2DArray*>(texture)->GetRenderSurface();
+                resources_[id] = surface;
+            }
+        }
+        break;
+
+    default:
+        return false;
+    }
+
+    return !commands_.IsEof();
+}
+
+RefCounted* GraphicsReplay::GetResource(unsigned id, unsigned char defineCommand) const
+{
+    return id < resources_.Size() && resourceTypes_[id] == defineCommand ? resources_[id].Get() : nullptr;
+}
+
+}
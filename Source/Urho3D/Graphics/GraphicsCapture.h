@@ -0,0 +1,239 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/HashMap.h"
+#include "../Core/Object.h"
+#include "../Graphics/GraphicsDefs.h"
+#include "../IO/VectorBuffer.h"
+#include "../Math/Color.h"
+#include "../Math/Rect.h"
+
+namespace Urho3D
+{
+
+class Deserializer;
+class IndexBuffer;
+class Matrix3x4;
+class Matrix4;
+class Plane;
+class RenderSurface;
+class ShaderVariation;
+class Texture;
+class Texture2D;
+class VertexBuffer;
+
+/// Utility class for recording the Graphics calls of whole frames, along with the resources they reference, into a file that GraphicsReplay can re-issue.
+class URHO3D_API GraphicsCapture : public Object
+{
+    URHO3D_OBJECT(GraphicsCapture, Object);
+
+public:
+    /// Construct and begin capturing from the next frame. The capture is written to the file after the given number of frames.
+    GraphicsCapture(Context* context, const String& fileName, unsigned numFrames);
+    /// Destruct. Write the captured frames to the file.
+    ~GraphicsCapture() override;
+
+    /// Begin recording a frame and record the state carried over from the previous frame. Called by Graphics at the end of BeginFrame().
+    void BeginFrame();
+    /// End recording a frame. Called by Graphics from EndFrame(). Return true when all requested frames have been captured.
+    bool EndFrame();
+    /// Set whether recording is suspended. Used by Graphics functions whose own Graphics calls are reproduced by replaying the function.
+    void SetSuspended(bool enable) { suspended_ = enable; }
+
+    /// Record a clear.
+    void RecordClear(ClearTargetFlags flags, const Color& color, float depth, unsigned stencil);
+    /// Record a non-indexed draw.
+    void RecordDraw(PrimitiveType type, unsigned vertexStart, unsigned vertexCount);
+    /// Record an indexed draw, instanced if the instance count is nonzero.
+    void RecordDraw(PrimitiveType type, unsigned indexStart, unsigned indexCount, unsigned baseVertexIndex, unsigned minVertex,
+        unsigned vertexCount, unsigned instanceCount);
+    /// Record setting vertex buffers.
+    void RecordVertexBuffers(const PODVector<VertexBuffer*>& buffers, unsigned instanceOffset);
+    /// Record setting the index buffer.
+    void RecordIndexBuffer(IndexBuffer* buffer);
+    /// Record setting shaders.
+    void RecordShaders(ShaderVariation* vs, ShaderVariation* ps);
+    /// Record setting a shader parameter.
+    void RecordShaderParameter(StringHash param, const Variant& value);
+    /// Record setting a texture.
+    void RecordTexture(unsigned index, Texture* texture);
+    /// Record setting the bindless textures.
+    void RecordBindlessTextures(const PODVector<Texture*>& textures);
+    /// Record setting the clustered light lists.
+    void RecordClusteredLights(const PODVector<Vector4>& lightData, const PODVector<unsigned>& clusters,
+        const PODVector<unsigned>& lightIndices);
+    /// Record setting a rendertarget.
+    void RecordRenderTarget(unsigned index, RenderSurface* renderTarget);
+    /// Record setting the depth-stencil surface.
+    void RecordDepthStencil(RenderSurface* depthStencil);
+    /// Record setting the viewport.
+    void RecordViewport(const IntRect& rect);
+    /// Record setting the blending mode.
+    void RecordBlendMode(BlendMode mode, bool alphaToCoverage);
+    /// Record setting color write.
+    void RecordColorWrite(bool enable);
+    /// Record setting the cull mode.
+    void RecordCullMode(CullMode mode);
+    /// Record setting the depth bias.
+    void RecordDepthBias(float constantBias, float slopeScaledBias);
+    /// Record setting the depth test mode.
+    void RecordDepthTest(CompareMode mode);
+    /// Record setting depth write.
+    void RecordDepthWrite(bool enable);
+    /// Record setting the fill mode.
+    void RecordFillMode(FillMode mode);
+    /// Record setting line antialiasing.
+    void RecordLineAntiAlias(bool enable);
+    /// Record setting the scissor test with a normalized rectangle.
+    void RecordScissorTest(bool enable, const Rect& rect, bool borderInclusive);
+    /// Record setting the scissor test with a viewport-relative rectangle.
+    void RecordScissorTest(bool enable, const IntRect& rect);
+    /// Record setting the stencil test.
+    void RecordStencilTest(bool enable, CompareMode mode, StencilOp pass, StencilOp fail, StencilOp zFail, unsigned stencilRef,
+        unsigned compareMask, unsigned writeMask);
+    /// Record setting the clip plane.
+    void RecordClipPlane(bool enable, const Plane& clipPlane, const Matrix3x4& view, const Matrix4& projection);
+    /// Record resolving the multisampled backbuffer to a texture.
+    void RecordResolveToTexture(Texture2D* destination, const IntRect& viewport);
+    /// Record resolving a multisampled texture on itself.
+    void RecordResolveToTexture(Texture* texture);
+    /// Record copying a texture.
+    void RecordCopyTexture(Texture2D* destination, Texture2D* source);
+    /// Record beginning a GPU timing block.
+    void RecordBeginGPUTiming(const String& name);
+    /// Record ending a GPU timing block.
+    void RecordEndGPUTiming();
+
+    /// Return the capture file name.
+    const String& GetFileName() const { return fileName_; }
+    /// Return number of frames captured so far.
+    unsigned GetNumCapturedFrames() const { return numCapturedFrames_; }
+    /// Return whether is recording a frame.
+    bool IsRecording() const { return recording_ && !suspended_; }
+
+private:
+    /// Write a command code.
+    void WriteCommand(unsigned char command);
+    /// Return the ID of a vertex buffer, defining it on first use. Zero for null.
+    unsigned GetVertexBufferID(VertexBuffer* buffer);
+    /// Return the ID of an index buffer, defining it on first use. Zero for null.
+    unsigned GetIndexBufferID(IndexBuffer* buffer);
+    /// Return the ID of a shader variation, defining it on first use. Zero for null.
+    unsigned GetShaderID(ShaderVariation* variation);
+    /// Return the ID of a texture, defining it on first use. Zero for null.
+    unsigned GetTextureID(Texture* texture);
+    /// Return the ID of a rendersurface, defining it on first use. Zero for null or the backbuffer.
+    unsigned GetSurfaceID(RenderSurface* surface);
+    /// Return an existing resource ID, or zero if the object has not been defined.
+    unsigned FindID(RefCounted* object) const;
+    /// Assign a new resource ID.
+    unsigned AddID(RefCounted* object);
+    /// Record the current contents of the vertex and index buffers bound for drawing if they changed since last recorded.
+    void UpdateBufferData();
+
+    /// Capture file name.
+    String fileName_;
+    /// Recorded command stream.
+    VectorBuffer commands_;
+    /// Resource IDs by object.
+    HashMap<RefCounted*, unsigned> resourceIDs_;
+    /// Resources by ID, to detect objects that were destroyed and whose address was reused.
+    Vector<WeakPtr<RefCounted> > resources_;
+    /// Last recorded data revision of the buffer resources by ID.
+    PODVector<unsigned> dataRevisions_;
+    /// Number of frames to capture.
+    unsigned numFrames_;
+    /// Number of frames captured so far.
+    unsigned numCapturedFrames_;
+    /// Backbuffer width at the start of the capture.
+    int width_;
+    /// Backbuffer height at the start of the capture.
+    int height_;
+    /// Recording flag.
+    bool recording_;
+    /// Suspended flag.
+    bool suspended_;
+};
+
+/// Replays frames recorded with GraphicsCapture through the Graphics subsystem, looping over them.
+class URHO3D_API GraphicsReplay : public Object
+{
+    URHO3D_OBJECT(GraphicsReplay, Object);
+
+public:
+    /// Construct.
+    explicit GraphicsReplay(Context* context);
+    /// Destruct. Release the resources created for replaying.
+    ~GraphicsReplay() override;
+
+    /// Load a capture from a stream. Return true if successful.
+    bool Load(Deserializer& source);
+    /// Render the next captured frame, starting over after the last one. Resources are created when the first frame that references them is replayed. Return true if successful.
+    bool ReplayFrame();
+    /// Release the resources created for replaying and start over from the first frame.
+    void Reset();
+
+    /// Return number of captured frames.
+    unsigned GetNumFrames() const { return numFrames_; }
+    /// Return index of the frame replayed next.
+    unsigned GetNextFrame() const { return nextFrame_; }
+    /// Return backbuffer width at capture time.
+    int GetWidth() const { return width_; }
+    /// Return backbuffer height at capture time.
+    int GetHeight() const { return height_; }
+    /// Return number of draw calls issued by the last replayed frame.
+    unsigned GetNumDraws() const { return numDraws_; }
+
+private:
+    /// Replay commands until the end of the frame. Return true if successful.
+    bool ReplayCommands(Graphics* graphics);
+    /// Define a resource from the stream. Return true if successful.
+    bool DefineResource(unsigned char command, Graphics* graphics);
+    /// Return a resource by ID if it was defined with the given command, otherwise null.
+    RefCounted* GetResource(unsigned id, unsigned char defineCommand) const;
+
+    /// Captured command stream.
+    VectorBuffer commands_;
+    /// Resources by ID.
+    Vector<SharedPtr<RefCounted> > resources_;
+    /// Commands the resources were defined with by ID.
+    PODVector<unsigned char> resourceTypes_;
+    /// Scratch buffer for vertex buffer lists.
+    PODVector<VertexBuffer*> vertexBuffers_;
+    /// Scratch buffer for texture lists.
+    PODVector<Texture*> textures_;
+    /// Number of captured frames.
+    unsigned numFrames_;
+    /// Index of the frame replayed next.
+    unsigned nextFrame_;
+    /// Number of draw calls in the last replayed frame.
+    unsigned numDraws_;
+    /// Backbuffer width at capture time.
+    int width_;
+    /// Backbuffer height at capture time.
+    int height_;
+};
+
+}
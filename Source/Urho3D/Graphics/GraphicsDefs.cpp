@@ -76,7 +76,11 @@ extern URHO3D_API const StringHash PSP_MATENVMAPCOLOR("MatEnvMapColor");
 extern URHO3D_API const StringHash PSP_MATSPECCOLOR("MatSpecColor");
 extern URHO3D_API const StringHash PSP_NEARCLIP("NearClipPS");
 extern URHO3D_API const StringHash PSP_FARCLIP("FarClipPS");
+extern URHO3D_API const StringHash PSP_CLUSTERTILE("ClusterTile");
+extern URHO3D_API const StringHash PSP_CLUSTERPLANE("ClusterPlane");
+extern URHO3D_API const StringHash PSP_CLUSTERSLICE("ClusterSlice");
 extern URHO3D_API const StringHash PSP_SHADOWCUBEADJUST("ShadowCubeAdjust");
+extern URHO3D_API const StringHash PSP_SHADOWCUBESCALE("ShadowCubeScale");
 extern URHO3D_API const StringHash PSP_SHADOWDEPTHFADE("ShadowDepthFade");
 extern URHO3D_API const StringHash PSP_SHADOWINTENSITY("ShadowIntensity");
 extern URHO3D_API const StringHash PSP_SHADOWMAPINVSIZE("ShadowMapInvSize");
@@ -118,7 +122,10 @@ extern URHO3D_API const unsigned ELEMENT_TYPESIZES[] =
     3 * sizeof(float),
     4 * sizeof(float),
     sizeof(unsigned),
-    sizeof(unsigned)
+    sizeof(unsigned),
+    2 * sizeof(short),
+    4 * sizeof(short),
+    2 * sizeof(short)
 };
 
 
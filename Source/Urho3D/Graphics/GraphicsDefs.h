@@ -161,6 +161,9 @@ enum VertexElementType
     TYPE_VECTOR4,
     TYPE_UBYTE4,
     TYPE_UBYTE4_NORM,
+    TYPE_SHORT2_NORM,
+    TYPE_SHORT4_NORM,
+    TYPE_HALF2,
     MAX_VERTEX_ELEMENT_TYPES
 };
 
@@ -266,6 +269,29 @@ enum TextureUsage
     TEXTURE_DEPTHSTENCIL
 };
 
+/// GPU memory accounting categories.
+enum GPUMemoryCategory
+{
+    GPU_MEMORY_VERTEXBUFFER = 0,
+    GPU_MEMORY_INDEXBUFFER,
+    GPU_MEMORY_TEXTURE,
+    GPU_MEMORY_RENDERTARGET,
+    GPU_MEMORY_CONSTANTBUFFER,
+    GPU_MEMORY_OTHER,
+    MAX_GPU_MEMORY_CATEGORIES
+};
+
+/// GPU memory use of an accounting category.
+struct GPUMemoryStats
+{
+    /// Number of live allocations.
+    unsigned count_{};
+    /// Current size in bytes.
+    unsigned long long use_{};
+    /// Highest size in bytes since startup or the last reset of the peaks.
+    unsigned long long peak_{};
+};
+
 /// Cube map faces.
 enum CubeMapFace
 {
@@ -417,7 +443,11 @@ extern URHO3D_API const StringHash PSP_MATENVMAPCOLOR;
 extern URHO3D_API const StringHash PSP_MATSPECCOLOR;
 extern URHO3D_API const StringHash PSP_NEARCLIP;
 extern URHO3D_API const StringHash PSP_FARCLIP;
+extern URHO3D_API const StringHash PSP_CLUSTERTILE;
+extern URHO3D_API const StringHash PSP_CLUSTERPLANE;
+extern URHO3D_API const StringHash PSP_CLUSTERSLICE;
 extern URHO3D_API const StringHash PSP_SHADOWCUBEADJUST;
+extern URHO3D_API const StringHash PSP_SHADOWCUBESCALE;
 extern URHO3D_API const StringHash PSP_SHADOWDEPTHFADE;
 extern URHO3D_API const StringHash PSP_SHADOWINTENSITY;
 extern URHO3D_API const StringHash PSP_SHADOWMAPINVSIZE;
@@ -474,6 +504,18 @@ URHO3D_FLAGSET(VertexMask, VertexMaskFlags);
 static const int MAX_RENDERTARGETS = 4;
 static const int MAX_VERTEX_STREAMS = 4;
 static const int MAX_CONSTANT_REGISTERS = 256;
+static const unsigned MAX_FRAMES_IN_FLIGHT = 3;
+static const unsigned MAX_BINDLESS_TEXTURES = 64;
+static const unsigned MAX_COMPUTE_MORPHS = 64;
+static const unsigned MAX_COMPUTE_PARAMETERS = 4;
+static const unsigned MAX_GPU_PARTICLE_FRAMES = 16;
+static const unsigned CLUSTER_GRID_X = 16;
+static const unsigned CLUSTER_GRID_Y = 8;
+static const unsigned CLUSTER_GRID_Z = 24;
+static const unsigned NUM_CLUSTERS = CLUSTER_GRID_X * CLUSTER_GRID_Y * CLUSTER_GRID_Z;
+static const unsigned MAX_CLUSTERED_LIGHTS = 1024;
+static const unsigned MAX_LIGHTS_PER_CLUSTER = 64;
+static const unsigned CLUSTER_LIGHT_VECTORS = 4;
 
 static const int BITS_PER_COMPONENT = 8;
 }
@@ -133,6 +133,15 @@ URHO3D_EVENT(E_RENDERPATHEVENT, RenderPathEvent)
     URHO3D_PARAM(P_NAME, Name);                    // String
 }
 
+/// Asynchronous GPU readback requested from Graphics has finished.
+URHO3D_EVENT(E_READBACKCOMPLETE, ReadbackComplete)
+{
+    URHO3D_PARAM(P_ID, ID);                        // unsigned
+    URHO3D_PARAM(P_TEXTURE, Texture);              // Texture pointer, null for a screenshot
+    URHO3D_PARAM(P_LEVEL, Level);                  // unsigned
+    URHO3D_PARAM(P_IMAGE, Image);                  // Image pointer, null if failed
+}
+
 /// Graphics context has been lost. Some or all (depending on the API) GPU objects have lost their contents.
 URHO3D_EVENT(E_DEVICELOST, DeviceLost)
 {
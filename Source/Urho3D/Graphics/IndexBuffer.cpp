@@ -44,7 +44,13 @@ IndexBuffer::IndexBuffer(Context* context, bool forceHeadless) :
     lockScratchData_(nullptr),
     shadowed_(false),
     dynamic_(false),
-    discardLock_(false)
+    discardLock_(false),
+    computeAccess_(false),
+    discardFrame_(M_MAX_UNSIGNED),
+    persistentData_(nullptr),
+    persistentCopies_(MAX_FRAMES_IN_FLIGHT),
+    persistentCopy_(0),
+    dataRevision_(0)
 {
     // Force shadowing mode if graphics subsystem does not exist
     if (!graphics_)
@@ -73,6 +79,18 @@ void IndexBuffer::SetShadowed(bool enable)
     }
 }
 
+void IndexBuffer::SetComputeAccess(bool enable)
+{
+    if (enable == computeAccess_)
+        return;
+
+    computeAccess_ = enable;
+
+    // Recreate with the new bind flags
+    if (object_.ptr_ && Create() && shadowData_)
+        SetData(shadowData_.Get());
+}
+
 bool IndexBuffer::SetSize(unsigned indexCount, bool largeIndices, bool dynamic)
 {
     Unlock();
@@ -80,13 +98,16 @@ bool IndexBuffer::SetSize(unsigned indexCount, bool largeIndices, bool dynamic)
     indexCount_ = indexCount;
     indexSize_ = (unsigned)(largeIndices ? sizeof(uint32_t) : sizeof(uint16_t));
     dynamic_ = dynamic;
+    ++dataRevision_;
 
     if (shadowed_ && indexCount_ && indexSize_)
         shadowData_ = new unsigned char[indexCount_ * indexSize_];
     else
         shadowData_.Reset();
 
-    return Create();
+    const bool success = Create();
+    SetGPUMemoryUse(GPU_MEMORY_INDEXBUFFER, success ? (unsigned long long)indexCount_ * indexSize_ : 0);
+    return success;
 }
 
 bool IndexBuffer::GetUsedVertexRange(unsigned start, unsigned count, unsigned& minVertex, unsigned& vertexCount)
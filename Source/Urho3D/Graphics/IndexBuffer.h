@@ -51,6 +51,8 @@ public:
     /// Enable shadowing in CPU memory. Shadowing is forced on if the graphics subsystem does not exist.
     /// @property
     void SetShadowed(bool enable);
+    /// Set whether compute shaders can read and write the buffer as raw data. Dynamic buffers can not be accessed. Recreates an existing GPU buffer, restoring its contents from shadow data if available. Used only on Diligent.
+    void SetComputeAccess(bool enable);
     /// Set size and vertex elements and dynamic mode. Previous data will be lost.
     bool SetSize(unsigned indexCount, bool largeIndices, bool dynamic = false);
     /// Set all data in the buffer.
@@ -70,6 +72,9 @@ public:
     /// @property
     bool IsDynamic() const { return dynamic_; }
 
+    /// Return whether compute shaders can access the buffer.
+    bool GetComputeAccess() const { return computeAccess_; }
+
     /// Return whether is currently locked.
     bool IsLocked() const { return lockState_ != LOCK_NONE; }
 
@@ -90,6 +95,15 @@ public:
     /// Return shared array pointer to the CPU memory shadow data.
     SharedArrayPtr<unsigned char> GetShadowDataShared() const { return shadowData_; }
 
+    /// Return revision of the CPU-side data, incremented whenever it is resized or written through the buffer.
+    unsigned GetDataRevision() const { return dataRevision_; }
+
+    /// Rewrite dynamic buffer contents from shadow data if they did not persist from an earlier frame. Used only on Diligent.
+    void RestoreDynamicData();
+
+    /// Return byte offset of the current data within the GPU buffer object. Nonzero only for persistently mapped dynamic buffers on OpenGL.
+    unsigned GetGPUDataOffset() const { return persistentCopy_ * indexCount_ * indexSize_; }
+
 private:
     /// Create buffer.
     bool Create();
@@ -99,6 +113,12 @@ private:
     void* MapBuffer(unsigned start, unsigned count, bool discard);
     /// Unmap the GPU buffer. Not used on OpenGL.
     void UnmapBuffer();
+    /// Allocate persistently mapped storage for the copies of the data. Return true on success. Used only on OpenGL.
+    bool CreatePersistentStorage();
+    /// Delete the persistently mapped storage along with the buffer object. Used only on OpenGL.
+    void ReleasePersistentStorage();
+    /// Move to the next copy of the data in the persistent storage, growing the storage instead of waiting if the GPU still uses it. Used only on OpenGL.
+    void AdvancePersistentCopy();
 
     /// Shadow data.
     SharedArrayPtr<unsigned char> shadowData_;
@@ -120,6 +140,20 @@ private:
     bool shadowed_;
     /// Discard lock flag. Used by OpenGL only.
     bool discardLock_;
+    /// Compute shader access flag. Used only on Diligent.
+    bool computeAccess_;
+    /// Frame number of the last discard. Used only on Diligent.
+    unsigned discardFrame_;
+    /// Persistently mapped memory holding the copies of the data. Used only on OpenGL.
+    unsigned char* persistentData_;
+    /// Fences guarding the copies of the data still used by the GPU. Used only on OpenGL.
+    PODVector<void*> persistentFences_;
+    /// Number of copies of the data in the persistent storage. Used only on OpenGL.
+    unsigned persistentCopies_;
+    /// Copy of the data currently written to and drawn from. Used only on OpenGL.
+    unsigned persistentCopy_;
+    /// Data revision.
+    unsigned dataRevision_;
 };
 
 }
@@ -157,6 +157,8 @@ StringHash ParseTextureTypeXml(ResourceCache* cache, const String& filename)
 
 static TechniqueEntry noEntry;
 
+static const unsigned MAX_MATERIAL_CONSTANT_BLOCKS = 16;
+
 bool CompareTechniqueEntries(const TechniqueEntry& lhs, const TechniqueEntry& rhs)
 {
     if (lhs.lodDistance_ != rhs.lodDistance_)
@@ -1200,6 +1202,71 @@ Texture* Material::GetTexture(TextureUnit unit) const
     return i != textures_.End() ? i->second_.Get() : nullptr;
 }
 
+MaterialConstantBlock& Material::GetConstantBlock(unsigned layoutHash)
+{
+    for (Vector<MaterialConstantBlock>::Iterator i = constantBlocks_.Begin(); i != constantBlocks_.End(); ++i)
+    {
+        if (i->layoutHash_ == layoutHash)
+            return *i;
+    }
+
+    // A material is normally drawn with a handful of layouts. Start over if it keeps meeting new ones, e.g. after shader reloads
+    if (constantBlocks_.Size() >= MAX_MATERIAL_CONSTANT_BLOCKS)
+        constantBlocks_.Clear();
+
+    MaterialConstantBlock& block = constantBlocks_.EmplaceBack();
+    block.layoutHash_ = layoutHash;
+    // Make sure the empty block is not mistaken as up to date
+    block.version_ = shaderParameterVersion_ - 1;
+    return block;
+}
+
+unsigned Material::GetBindlessHash() const
+{
+    unsigned hash = shaderParameterHash_;
+    for (HashMap<TextureUnit, SharedPtr<Texture> >::ConstIterator i = textures_.Begin(); i != textures_.End(); ++i)
+    {
+        if (i->first_ != TU_DIFFUSE)
+            CombineHash(hash, MakeHash(i->second_.Get()) ^ i->first_);
+    }
+
+    CombineHash(hash, cullMode_ | shadowCullMode_ << 4u | fillMode_ << 8u | (unsigned)renderOrder_ << 16u);
+    CombineHash(hash, (unsigned)alphaToCoverage_ | (unsigned)lineAntiAlias_ << 1u | (unsigned)specular_ << 2u);
+    return hash;
+}
+
+bool Material::IsBindlessCompatible(const Material& other) const
+{
+    if (&other == this)
+        return true;
+
+    if (cullMode_ != other.cullMode_ || shadowCullMode_ != other.shadowCullMode_ || fillMode_ != other.fillMode_ ||
+        renderOrder_ != other.renderOrder_ || alphaToCoverage_ != other.alphaToCoverage_ ||
+        lineAntiAlias_ != other.lineAntiAlias_ || specular_ != other.specular_ ||
+        depthBias_.constantBias_ != other.depthBias_.constantBias_ ||
+        depthBias_.slopeScaledBias_ != other.depthBias_.slopeScaledBias_ ||
+        vertexShaderDefines_ != other.vertexShaderDefines_ || pixelShaderDefines_ != other.pixelShaderDefines_ ||
+        textures_.Size() != other.textures_.Size() || shaderParameters_.Size() != other.shaderParameters_.Size())
+        return false;
+
+    for (HashMap<TextureUnit, SharedPtr<Texture> >::ConstIterator i = textures_.Begin(); i != textures_.End(); ++i)
+    {
+        HashMap<TextureUnit, SharedPtr<Texture> >::ConstIterator j = other.textures_.Find(i->first_);
+        if (j == other.textures_.End() || (i->first_ != TU_DIFFUSE && j->second_ != i->second_))
+            return false;
+    }
+
+    for (HashMap<StringHash, MaterialShaderParameter>::ConstIterator i = shaderParameters_.Begin();
+         i != shaderParameters_.End(); ++i)
+    {
+        HashMap<StringHash, MaterialShaderParameter>::ConstIterator j = other.shaderParameters_.Find(i->first_);
+        if (j == other.shaderParameters_.End() || j->second_.value_ != i->second_.value_)
+            return false;
+    }
+
+    return true;
+}
+
 const Variant& Material::GetShaderParameter(const String& name) const
 {
     HashMap<StringHash, MaterialShaderParameter>::ConstIterator i = shaderParameters_.Find(name);
@@ -1299,6 +1366,9 @@ void Material::RefreshShaderParameterHash()
     unsigned dataSize = temp.GetSize();
     for (unsigned i = 0; i < dataSize; ++i)
         shaderParameterHash_ = SDBMHash(shaderParameterHash_, data[i]);
+
+    // Packed constant blocks are rebuilt on next use
+    ++shaderParameterVersion_;
 }
 
 void Material::RefreshMemoryUse()
@@ -52,6 +52,25 @@ struct MaterialShaderParameter
     Variant value_;
 };
 
+/// %Material's shader parameters packed into the material constant buffers of one shader program layout. Built and bound by Graphics on Diligent.
+struct MaterialConstantBlock
+{
+    /// Layout hash of the vertex and pixel shader material constant buffers.
+    unsigned layoutHash_{};
+    /// %Material shader parameter version the data was packed from.
+    unsigned version_{};
+    /// Whether all parameters were packed. Parameters outside the material constant buffers must be set one by one.
+    bool complete_{};
+    /// Packed vertex shader constant data followed by the pixel shader constant data.
+    PODVector<unsigned char> data_;
+    /// Byte size of the vertex shader constant data.
+    unsigned vsSize_{};
+    /// Byte offsets of the vertex and pixel shader data in the constant ring buffer.
+    unsigned ringOffsets_[2]{};
+    /// Constant ring buffer epochs the vertex and pixel shader data were written in. Zero if not written.
+    unsigned ringEpochs_[2]{};
+};
+
 /// %Material's technique list entry.
 struct TechniqueEntry
 {
@@ -286,6 +305,15 @@ public:
 
     /// Return shader parameter hash value. Used as an optimization to avoid setting shader parameters unnecessarily.
     unsigned GetShaderParameterHash() const { return shaderParameterHash_; }
+    /// Return shader parameter version, which changes whenever a shader parameter is set or animated.
+    unsigned GetShaderParameterVersion() const { return shaderParameterVersion_; }
+    /// Return the packed constant block for a shader program layout, created empty if it does not exist. Used by Graphics on Diligent.
+    /// @nobind
+    MaterialConstantBlock& GetConstantBlock(unsigned layoutHash);
+    /// Return hash of the render state excluding the diffuse texture. Used to group bindless instanced batches.
+    unsigned GetBindlessHash() const;
+    /// Return whether renders identically to another material except for the diffuse texture.
+    bool IsBindlessCompatible(const Material& other) const;
 
     /// Return name for texture unit.
     static String GetTextureUnitName(TextureUnit unit);
@@ -339,6 +367,10 @@ private:
     unsigned auxViewFrameNumber_{};
     /// Shader parameter hash value.
     unsigned shaderParameterHash_{};
+    /// Shader parameter version.
+    unsigned shaderParameterVersion_{};
+    /// Packed constant blocks per shader program layout.
+    Vector<MaterialConstantBlock> constantBlocks_;
     /// Alpha-to-coverage flag.
     bool alphaToCoverage_{};
     /// Line antialiasing flag.
@@ -0,0 +1,544 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Graphics/Geometry.h"
+#include "../Graphics/IndexBuffer.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/MaterialAtlas.h"
+#include "../Graphics/Model.h"
+#include "../Graphics/StaticModel.h"
+#include "../Graphics/Texture2D.h"
+#include "../Graphics/VertexBuffer.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../Math/AreaAllocator.h"
+#include "../Resource/Image.h"
+#include "../Resource/ResourceCache.h"
+#include "../Resource/XMLFile.h"
+#include "../Scene/Node.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Texture units packed into the atlases.
+static const TextureUnit atlasUnits[] = {TU_DIFFUSE, TU_NORMAL, TU_SPECULAR, TU_EMISSIVE};
+/// Texture unit names for the atlas texture names.
+static const char* atlasUnitNames[] = {"Diffuse", "Normal", "Specular", "Emissive"};
+/// Number of texture units packed into the atlases.
+static const unsigned NUM_ATLAS_UNITS = sizeof(atlasUnits) / sizeof(atlasUnits[0]);
+/// Tolerance for texture coordinates outside the 0-1 range.
+static const float UV_EPSILON = 0.001f;
+
+/// Material evaluated for packing into an atlas.
+struct AtlasSource
+{
+    /// Original material.
+    Material* material_{};
+    /// Images of the packed units, null for the units the material does not use.
+    SharedPtr<Image> images_[NUM_ATLAS_UNITS];
+    /// Size of the packed region, which is the diffuse texture size.
+    IntVector2 size_;
+    /// Compatibility key: the material description without the texture names.
+    String key_;
+    /// Atlas material, or null if not packed.
+    Material* atlasMaterial_{};
+    /// Texture coordinate scale into the atlas.
+    Vector2 uvScale_;
+    /// Texture coordinate offset into the atlas.
+    Vector2 uvOffset_;
+};
+
+/// Read the packed textures and the compatibility key of a material. Return false if the material can not be packed.
+static bool GetAtlasSource(ResourceCache* cache, Material* material, int maxTextureSize, AtlasSource& dest)
+{
+    dest.material_ = material;
+
+    // A texture coordinate transform would apply on top of the atlas coordinates
+    const Variant& uOffset = material->GetShaderParameter("UOffset");
+    const Variant& vOffset = material->GetShaderParameter("VOffset");
+    if ((!uOffset.IsEmpty() && uOffset.GetVector4() != Vector4(1.0f, 0.0f, 0.0f, 0.0f)) ||
+        (!vOffset.IsEmpty() && vOffset.GetVector4() != Vector4(0.0f, 1.0f, 0.0f, 0.0f)))
+        return false;
+
+    if (!material->GetTexture(TU_DIFFUSE))
+        return false;
+
+    const HashMap<TextureUnit, SharedPtr<Texture> >& textures = material->GetTextures();
+    for (HashMap<TextureUnit, SharedPtr<Texture> >::ConstIterator i = textures.Begin(); i != textures.End(); ++i)
+    {
+        unsigned index = 0;
+        while (index < NUM_ATLAS_UNITS && atlasUnits[index] != i->first_)
+            ++index;
+
+        Texture* texture = i->second_;
+        if (index == NUM_ATLAS_UNITS || !texture || texture->GetType() != Texture2D::GetTypeStatic() || texture->GetName().Empty())
+            return false;
+
+        // The GPU textures do not keep their pixels, so read them again
+        SharedPtr<Image> image = cache->GetTempResource<Image>(texture->GetName(), false);
+        if (!image || image->IsCompressed() || image->GetDepth() > 1 || image->GetWidth() > maxTextureSize ||
+            image->GetHeight() > maxTextureSize)
+            return false;
+        if (image->GetComponents() != 4)
+        {
+            image = image->ConvertToRGBA();
+            if (!image)
+                return false;
+        }
+
+        dest.images_[index] = image;
+    }
+
+    dest.size_ = IntVector2(dest.images_[0]->GetWidth(), dest.images_[0]->GetHeight());
+
+    XMLFile xml(material->GetContext());
+    XMLElement rootElem = xml.CreateRoot("material");
+    if (!material->Save(rootElem))
+        return false;
+    for (XMLElement textureElem = rootElem.GetChild("texture"); textureElem; textureElem = textureElem.GetNext("texture"))
+        textureElem.RemoveAttribute("name");
+    dest.key_ = xml.ToString(String::EMPTY);
+
+    // The atlas textures take their sampling settings from the first material, so these must match too
+    for (unsigned i = 0; i < NUM_ATLAS_UNITS; ++i)
+    {
+        Texture* texture = material->GetTexture(atlasUnits[i]);
+        if (texture)
+            dest.key_.AppendWithFormat(" %u:%d:%d:%u", i, texture->GetSRGB() ? 1 : 0, (int)texture->GetFilterMode(), texture->GetAnisotropy());
+    }
+
+    return true;
+}
+
+/// Collect the vertices used by the draw range of a geometry, including duplicates. Return false if the data is not available.
+static bool GetVertexIndices(Geometry* geometry, PODVector<unsigned>& dest)
+{
+    dest.Clear();
+
+    IndexBuffer* indexBuffer = geometry->GetIndexBuffer();
+    if (!indexBuffer)
+    {
+        for (unsigned i = 0; i < geometry->GetVertexCount(); ++i)
+            dest.Push(geometry->GetVertexStart() + i);
+        return true;
+    }
+
+    const unsigned char* data = indexBuffer->GetShadowData();
+    if (!data || geometry->GetIndexStart() + geometry->GetIndexCount() > indexBuffer->GetIndexCount())
+        return false;
+
+    dest.Resize(geometry->GetIndexCount());
+    for (unsigned i = 0; i < dest.Size(); ++i)
+    {
+        unsigned index = geometry->GetIndexStart() + i;
+        dest[i] = indexBuffer->GetIndexSize() == sizeof(unsigned) ? reinterpret_cast<const unsigned*>(data)[index] :
+            reinterpret_cast<const unsigned short*>(data)[index];
+    }
+    return true;
+}
+
+/// Return whether all LOD levels of a model geometry have their texture coordinates in the 0-1 range, so that they can be remapped into an atlas region.
+static bool HasAtlasCoordinates(const Vector<SharedPtr<Geometry> >& lodLevels)
+{
+    PODVector<unsigned> vertices;
+
+    for (unsigned i = 0; i < lodLevels.Size(); ++i)
+    {
+        Geometry* geometry = lodLevels[i];
+        if (!geometry || geometry->GetNumVertexBuffers() != 1)
+            return false;
+
+        VertexBuffer* buffer = geometry->GetVertexBuffer(0);
+        unsigned offset = buffer ? buffer->GetElementOffset(TYPE_VECTOR2, SEM_TEXCOORD) : M_MAX_UNSIGNED;
+        if (offset == M_MAX_UNSIGNED || !buffer->GetShadowData() || !GetVertexIndices(geometry, vertices))
+            return false;
+
+        const unsigned char* data = buffer->GetShadowData();
+        unsigned vertexSize = buffer->GetVertexSize();
+        for (unsigned j = 0; j < vertices.Size(); ++j)
+        {
+            if (vertices[j] >= buffer->GetVertexCount())
+                return false;
+
+            const auto& uv = *reinterpret_cast<const Vector2*>(data + vertices[j] * vertexSize + offset);
+            if (uv.x_ < -UV_EPSILON || uv.x_ > 1.0f + UV_EPSILON || uv.y_ < -UV_EPSILON || uv.y_ > 1.0f + UV_EPSILON)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/// Clone a model and remap the texture coordinates of its geometries into the atlas regions of their materials. Return null if geometries using different regions share vertices.
+static SharedPtr<Model> CloneRemapped(Model* model, const PODVector<AtlasSource*>& remaps, const String& cloneName)
+{
+    SharedPtr<Model> clone = model->Clone(cloneName);
+
+    // Each vertex may be remapped only once, as the LOD levels of a geometry usually share them
+    HashMap<VertexBuffer*, PODVector<AtlasSource*> > owners;
+    HashMap<VertexBuffer*, SharedArrayPtr<unsigned char> > vertexData;
+    PODVector<unsigned> vertices;
+
+    for (unsigned i = 0; i < remaps.Size() && i < clone->GetNumGeometries(); ++i)
+    {
+        AtlasSource* source = remaps[i];
+        if (!source)
+            continue;
+
+        for (unsigned j = 0; j < clone->GetNumGeometryLodLevels(i); ++j)
+        {
+            Geometry* geometry = clone->GetGeometry(i, j);
+            VertexBuffer* buffer = geometry->GetVertexBuffer(0);
+            unsigned vertexSize = buffer->GetVertexSize();
+            unsigned offset = buffer->GetElementOffset(TYPE_VECTOR2, SEM_TEXCOORD);
+            GetVertexIndices(geometry, vertices);
+
+            SharedArrayPtr<unsigned char>& data = vertexData[buffer];
+            PODVector<AtlasSource*>& owner = owners[buffer];
+            if (!data)
+            {
+                data = new unsigned char[buffer->GetVertexCount() * vertexSize];
+                memcpy(data.Get(), buffer->GetShadowData(), buffer->GetVertexCount() * vertexSize);
+                owner.Resize(buffer->GetVertexCount());
+                for (unsigned k = 0; k < owner.Size(); ++k)
+                    owner[k] = nullptr;
+            }
+
+            for (unsigned k = 0; k < vertices.Size(); ++k)
+            {
+                unsigned vertex = vertices[k];
+                if (owner[vertex] == source)
+                    continue;
+                if (owner[vertex])
+                    return SharedPtr<Model>();
+
+                owner[vertex] = source;
+                auto& uv = *reinterpret_cast<Vector2*>(data.Get() + vertex * vertexSize + offset);
+                uv = source->uvOffset_ + uv * source->uvScale_;
+            }
+        }
+    }
+
+    for (HashMap<VertexBuffer*, SharedArrayPtr<unsigned char> >::Iterator i = vertexData.Begin(); i != vertexData.End(); ++i)
+        i->first_->SetData(i->second_.Get());
+
+    return clone;
+}
+
+/// Extend the edge pixels of an image region into the padding around it.
+static void PadRegion(Image* image, const IntRect& rect, int padding)
+{
+    for (int y = rect.top_ - padding; y < rect.bottom_ + padding; ++y)
+    {
+        for (int x = rect.left_ - padding; x < rect.right_ + padding; ++x)
+        {
+            if (x >= rect.left_ && x < rect.right_ && y >= rect.top_ && y < rect.bottom_)
+                continue;
+            int sourceX = Clamp(x, rect.left_, rect.right_ - 1);
+            int sourceY = Clamp(y, rect.top_, rect.bottom_ - 1);
+            image->SetPixelInt(x, y, image->GetPixelInt(sourceX, sourceY));
+        }
+    }
+}
+
+/// Return a resource name not yet used in the resource cache, formatting the base name with an increasing number.
+static String GetUniqueName(ResourceCache* cache, StringHash type, const char* format, const String& baseName, unsigned& number)
+{
+    for (;;)
+    {
+        String name = baseName + ToString(format, number++);
+        if (!cache->GetExistingResource(type, name))
+            return name;
+    }
+}
+
+MaterialAtlas::MaterialAtlas(Context* context) :
+    Object(context),
+    maxAtlasSize_(2048),
+    maxTextureSize_(512),
+    padding_(4),
+    numAtlases_(0)
+{
+}
+
+MaterialAtlas::~MaterialAtlas() = default;
+
+void MaterialAtlas::SetMaxAtlasSize(int size)
+{
+    maxAtlasSize_ = Max(size, 1);
+}
+
+void MaterialAtlas::SetMaxTextureSize(int size)
+{
+    maxTextureSize_ = Max(size, 1);
+}
+
+void MaterialAtlas::SetPadding(int padding)
+{
+    padding_ = Max(padding, 0);
+}
+
+unsigned MaterialAtlas::Build(Node* node)
+{
+    if (!node)
+        return 0;
+
+    URHO3D_PROFILE(BuildMaterialAtlas);
+
+    auto* cache = GetSubsystem<ResourceCache>();
+
+    // Subclasses such as animated models and model groups have geometry of their own, so only pack the static models
+    PODVector<StaticModel*> staticModels;
+    node->GetComponents<StaticModel>(staticModels, true);
+    for (unsigned i = staticModels.Size() - 1; i < staticModels.Size(); --i)
+    {
+        if (staticModels[i]->GetType() != StaticModel::GetTypeStatic() || !staticModels[i]->GetModel())
+            staticModels.Erase(i);
+    }
+
+    // Evaluate the materials of the geometries whose texture coordinates can be remapped
+    Vector<AtlasSource> sources;
+    HashMap<Material*, unsigned> sourceIndices;
+    HashMap<Pair<Model*, unsigned>, bool> remappableGeometries;
+    for (unsigned i = 0; i < staticModels.Size(); ++i)
+    {
+        StaticModel* staticModel = staticModels[i];
+        Model* model = staticModel->GetModel();
+        // The texture coordinates are checked and remapped in the shadow data
+        model->RequestShadowData();
+        for (unsigned j = 0; j < staticModel->GetNumGeometries() && j < model->GetNumGeometries(); ++j)
+        {
+            Material* material = staticModel->GetMaterial(j);
+            if (!material)
+                continue;
+
+            Pair<Model*, unsigned> geometryKey(model, j);
+            HashMap<Pair<Model*, unsigned>, bool>::Iterator remappable = remappableGeometries.Find(geometryKey);
+            if (remappable == remappableGeometries.End())
+                remappable = remappableGeometries.Insert(MakePair(geometryKey, HasAtlasCoordinates(model->GetGeometries()[j])));
+            if (!remappable->second_ || sourceIndices.Contains(material))
+                continue;
+
+            AtlasSource source;
+            if (GetAtlasSource(cache, material, maxTextureSize_, source))
+            {
+                sourceIndices[material] = sources.Size();
+                sources.Push(source);
+            }
+            else
+                sourceIndices[material] = M_MAX_UNSIGNED;
+        }
+    }
+
+    HashMap<String, PODVector<unsigned> > groups;
+    for (unsigned i = 0; i < sources.Size(); ++i)
+        groups[sources[i].key_].Push(i);
+
+    unsigned numPacked = 0;
+    for (HashMap<String, PODVector<unsigned> >::Iterator i = groups.Begin(); i != groups.End(); ++i)
+    {
+        PODVector<unsigned>& indices = i->second_;
+        if (indices.Size() < 2)
+            continue;
+
+        // Pack the tallest first for a tighter fit
+        Sort(indices.Begin(), indices.End(), [&sources](unsigned lhs, unsigned rhs) {
+            return sources[lhs].size_.y_ > sources[rhs].size_.y_;
+        });
+
+        // Fill atlases one at a time, starting a new one when the current is full
+        unsigned first = 0;
+        while (first < indices.Size())
+        {
+            const IntVector2& firstSize = sources[indices[first]].size_;
+            AreaAllocator allocator(NextPowerOfTwo(firstSize.x_ + 2 * padding_), NextPowerOfTwo(firstSize.y_ + 2 * padding_),
+                maxAtlasSize_, maxAtlasSize_);
+            PODVector<IntVector2> positions;
+            unsigned last = first;
+            for (; last < indices.Size(); ++last)
+            {
+                const IntVector2& size = sources[indices[last]].size_;
+                int x, y;
+                if (!allocator.Allocate(size.x_ + 2 * padding_, size.y_ + 2 * padding_, x, y))
+                    break;
+                positions.Push(IntVector2(x + padding_, y + padding_));
+            }
+
+            // A material that does not fit an atlas alone stays as is, as does a material left alone in an atlas
+            if (last - first < 2)
+            {
+                first = Max(last, first + 1);
+                continue;
+            }
+
+            int width = allocator.GetWidth();
+            int height = allocator.GetHeight();
+            Material* firstMaterial = sources[indices[first]].material_;
+            String materialName = GetUniqueName(cache, Material::GetTypeStatic(), "%u.xml", "Materials/Atlas", numAtlases_);
+            String textureBaseName = "Textures/" + GetFileName(materialName);
+            SharedPtr<Material> atlasMaterial = firstMaterial->Clone(materialName);
+
+            for (unsigned j = 0; j < NUM_ATLAS_UNITS; ++j)
+            {
+                if (!sources[indices[first]].images_[j])
+                    continue;
+
+                SharedPtr<Image> image(new Image(context_));
+                image->SetSize(width, height, 4);
+                image->Clear(Color::TRANSPARENT_BLACK);
+                for (unsigned k = first; k < last; ++k)
+                {
+                    const IntVector2& position = positions[k - first];
+                    const IntVector2& size = sources[indices[k]].size_;
+                    IntRect rect(position.x_, position.y_, position.x_ + size.x_, position.y_ + size.y_);
+                    image->SetSubimage(sources[indices[k]].images_[j], rect);
+                    PadRegion(image, rect, padding_);
+                }
+
+                auto* original = static_cast<Texture2D*>(firstMaterial->GetTexture(atlasUnits[j]));
+                SharedPtr<Texture2D> texture(new Texture2D(context_));
+                texture->SetName(textureBaseName + atlasUnitNames[j] + ".png");
+                texture->SetSRGB(original->GetSRGB());
+                texture->SetFilterMode(original->GetFilterMode());
+                texture->SetAnisotropy(original->GetAnisotropy());
+                texture->SetAddressMode(COORD_U, ADDRESS_CLAMP);
+                texture->SetAddressMode(COORD_V, ADDRESS_CLAMP);
+                if (!texture->SetData(image, true))
+                    URHO3D_LOGERROR("Failed to create atlas texture {}", texture->GetName().CString());
+                image->SetName(texture->GetName());
+
+                atlasMaterial->SetTexture(atlasUnits[j], texture);
+                cache->AddManualResource(texture);
+                textures_.Push(texture);
+                images_.Push(image);
+            }
+
+            cache->AddManualResource(atlasMaterial);
+            materials_.Push(atlasMaterial);
+
+            for (unsigned k = first; k < last; ++k)
+            {
+                AtlasSource& source = sources[indices[k]];
+                const IntVector2& position = positions[k - first];
+                source.atlasMaterial_ = atlasMaterial;
+                source.uvScale_ = Vector2((float)source.size_.x_ / width, (float)source.size_.y_ / height);
+                source.uvOffset_ = Vector2((float)position.x_ / width, (float)position.y_ / height);
+            }
+
+            URHO3D_LOGDEBUG("Packed {} materials into atlas {} of {}x{}", last - first, materialName.CString(), width, height);
+            numPacked += last - first;
+            first = last;
+        }
+    }
+
+    if (!numPacked)
+        return 0;
+
+    // Assign the atlas materials, sharing a model clone between the static models with the same model and atlas regions
+    HashMap<String, SharedPtr<Model> > clones;
+    PODVector<AtlasSource*> remaps;
+    PODVector<Material*> materials;
+    for (unsigned i = 0; i < staticModels.Size(); ++i)
+    {
+        StaticModel* staticModel = staticModels[i];
+        Model* model = staticModel->GetModel();
+        unsigned numGeometries = staticModel->GetNumGeometries();
+        remaps.Resize(numGeometries);
+        materials.Resize(numGeometries);
+
+        String cloneKey = ToString("%p", model);
+        bool remapped = false;
+        for (unsigned j = 0; j < numGeometries; ++j)
+        {
+            materials[j] = staticModel->GetMaterial(j);
+            remaps[j] = nullptr;
+
+            HashMap<Material*, unsigned>::ConstIterator source = sourceIndices.Find(materials[j]);
+            if (source != sourceIndices.End() && source->second_ != M_MAX_UNSIGNED && sources[source->second_].atlasMaterial_ &&
+                remappableGeometries[MakePair(model, j)])
+            {
+                remaps[j] = &sources[source->second_];
+                remapped = true;
+            }
+            cloneKey.AppendWithFormat(" %p", remaps[j]);
+        }
+        if (!remapped)
+            continue;
+
+        HashMap<String, SharedPtr<Model> >::Iterator clone = clones.Find(cloneKey);
+        if (clone == clones.End())
+        {
+            String baseName = model->GetName().Empty() ? String("Models/") : ReplaceExtension(model->GetName(), String::EMPTY);
+            unsigned number = 0;
+            String cloneName = GetUniqueName(cache, Model::GetTypeStatic(), "_Atlas%u.mdl", baseName, number);
+            SharedPtr<Model> newClone = CloneRemapped(model, remaps, cloneName);
+            if (newClone)
+            {
+                cache->AddManualResource(newClone);
+                models_.Push(newClone);
+            }
+            else
+                URHO3D_LOGWARNING("Could not remap model {} into atlases, as its geometries share vertices", model->GetName().CString());
+
+            clone = clones.Insert(MakePair(cloneKey, newClone));
+        }
+        if (!clone->second_)
+            continue;
+
+        staticModel->SetModel(clone->second_);
+        for (unsigned j = 0; j < numGeometries; ++j)
+            staticModel->SetMaterial(j, remaps[j] ? remaps[j]->atlasMaterial_ : materials[j]);
+    }
+
+    return numPacked;
+}
+
+void MaterialAtlas::Clear()
+{
+    // Drop the own references first, so that the resource cache releases the resources no static model uses anymore
+    Vector<Pair<StringHash, String> > resources;
+    for (unsigned i = 0; i < textures_.Size(); ++i)
+        resources.Push(MakePair(Texture2D::GetTypeStatic(), textures_[i]->GetName()));
+    for (unsigned i = 0; i < materials_.Size(); ++i)
+        resources.Push(MakePair(Material::GetTypeStatic(), materials_[i]->GetName()));
+    for (unsigned i = 0; i < models_.Size(); ++i)
+        resources.Push(MakePair(Model::GetTypeStatic(), models_[i]->GetName()));
+
+    materials_.Clear();
+    textures_.Clear();
+    images_.Clear();
+    models_.Clear();
+
+    // Release the models and materials before the textures they refer to
+    auto* cache = GetSubsystem<ResourceCache>();
+    for (unsigned i = resources.Size() - 1; i < resources.Size(); --i)
+        cache->ReleaseResource(resources[i].first_, resources[i].second_);
+}
+
+}
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Object.h"
+
+namespace Urho3D
+{
+
+class Image;
+class Material;
+class Model;
+class Node;
+class Texture2D;
+
+/// Utility class for packing the textures of compatible materials into shared atlas textures at runtime or import time. The static models using the materials get model clones with remapped texture coordinates, so that they share the atlas material and its render state. Identical models using materials of the same atlas share one clone, which keeps them in the same instanced batch group.
+class URHO3D_API MaterialAtlas : public Object
+{
+    URHO3D_OBJECT(MaterialAtlas, Object);
+
+public:
+    /// Construct.
+    explicit MaterialAtlas(Context* context);
+    /// Destruct.
+    ~MaterialAtlas() override;
+
+    /// Set maximum width and height of an atlas texture. Default 2048.
+    /// @property
+    void SetMaxAtlasSize(int size);
+    /// Set maximum width and height of a material's textures to pack. Materials with larger textures are left as is. Default 512.
+    /// @property
+    void SetMaxTextureSize(int size);
+    /// Set padding in pixels around each packed texture, filled by repeating its edge pixels to limit bleeding in the lower mip levels. Default 4.
+    /// @property
+    void SetPadding(int padding);
+
+    /// Pack the materials of the static models in a node and its children. Materials are compatible if they differ only by their textures, which must be uncompressed 2D textures, and only the diffuse, normal, specular and emissive units are packed. Geometries with texture coordinates outside the 0-1 range keep their original material. Return the number of materials replaced by atlas materials.
+    unsigned Build(Node* node);
+    /// Release the created atlas resources. Static models keep referring to the ones they use.
+    void Clear();
+
+    /// Return maximum width and height of an atlas texture.
+    /// @property
+    int GetMaxAtlasSize() const { return maxAtlasSize_; }
+    /// Return maximum width and height of a material's textures to pack.
+    /// @property
+    int GetMaxTextureSize() const { return maxTextureSize_; }
+    /// Return padding in pixels around each packed texture.
+    /// @property
+    int GetPadding() const { return padding_; }
+
+    /// Return the created atlas materials.
+    const Vector<SharedPtr<Material> >& GetMaterials() const { return materials_; }
+    /// Return the CPU-side images of the created atlas textures, for example to save them at import time.
+    const Vector<SharedPtr<Image> >& GetImages() const { return images_; }
+    /// Return the created model clones with remapped texture coordinates.
+    const Vector<SharedPtr<Model> >& GetModels() const { return models_; }
+
+private:
+    /// Created atlas materials.
+    Vector<SharedPtr<Material> > materials_;
+    /// Created atlas textures.
+    Vector<SharedPtr<Texture2D> > textures_;
+    /// Images of the created atlas textures.
+    Vector<SharedPtr<Image> > images_;
+    /// Created model clones.
+    Vector<SharedPtr<Model> > models_;
+    /// Maximum atlas texture size.
+    int maxAtlasSize_;
+    /// Maximum packed texture size.
+    int maxTextureSize_;
+    /// Padding around packed textures.
+    int padding_;
+    /// Number of atlases created, for naming the atlas resources uniquely.
+    unsigned numAtlases_;
+};
+
+}
@@ -0,0 +1,250 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Container/HashMap.h"
+#include "../Container/Pair.h"
+#include "../Container/Sort.h"
+#include "../Graphics/MeshSimplifier.h"
+#include "../Math/BoundingBox.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Symmetric 4x4 error quadric of a vertex.
+struct Quadric
+{
+    void AddPlane(const Vector3& normal, float distance)
+    {
+        double a = normal.x_, b = normal.y_, c = normal.z_, d = distance;
+        a00_ += a * a; a01_ += a * b; a02_ += a * c; a03_ += a * d;
+        a11_ += b * b; a12_ += b * c; a13_ += b * d;
+        a22_ += c * c; a23_ += c * d;
+        a33_ += d * d;
+    }
+
+    void Add(const Quadric& rhs)
+    {
+        a00_ += rhs.a00_; a01_ += rhs.a01_; a02_ += rhs.a02_; a03_ += rhs.a03_;
+        a11_ += rhs.a11_; a12_ += rhs.a12_; a13_ += rhs.a13_;
+        a22_ += rhs.a22_; a23_ += rhs.a23_;
+        a33_ += rhs.a33_;
+    }
+
+    float Evaluate(const Vector3& pos) const
+    {
+        double x = pos.x_, y = pos.y_, z = pos.z_;
+        double error = a00_ * x * x + 2.0 * a01_ * x * y + 2.0 * a02_ * x * z + 2.0 * a03_ * x +
+            a11_ * y * y + 2.0 * a12_ * y * z + 2.0 * a13_ * y +
+            a22_ * z * z + 2.0 * a23_ * z + a33_;
+        return (float)Abs(error);
+    }
+
+    double a00_{}, a01_{}, a02_{}, a03_{};
+    double a11_{}, a12_{}, a13_{};
+    double a22_{}, a23_{};
+    double a33_{};
+};
+
+void SimplifyIndices(const PODVector<unsigned>& indices, const PODVector<Vector3>& positions, unsigned targetIndexCount,
+    PODVector<unsigned>& dest, float maxError)
+{
+    struct Collapse
+    {
+        unsigned from_;
+        unsigned to_;
+        float error_;
+    };
+
+    unsigned numVertices = positions.Size();
+    dest = indices;
+
+    // Lock vertices that share their position with other vertices, as they are on a normal or texture coordinate seam,
+    // and vertices on open borders, so that the mapping and outline of the geometry are kept
+    PODVector<unsigned char> locked(numVertices, 0);
+    HashMap<Vector3, unsigned> positionVertices;
+    HashMap<Pair<unsigned, unsigned>, unsigned> edgeCounts;
+    BoundingBox box;
+    for (unsigned i = 0; i < dest.Size(); ++i)
+    {
+        unsigned vertex = dest[i];
+        HashMap<Vector3, unsigned>::Iterator j = positionVertices.Find(positions[vertex]);
+        if (j == positionVertices.End())
+            positionVertices[positions[vertex]] = vertex;
+        else if (j->second_ != vertex)
+            locked[vertex] = locked[j->second_] = 1;
+
+        unsigned next = dest[i - i % 3 + (i + 1) % 3];
+        ++edgeCounts[MakePair(Min(vertex, next), Max(vertex, next))];
+        box.Merge(positions[vertex]);
+    }
+    for (HashMap<Pair<unsigned, unsigned>, unsigned>::ConstIterator i = edgeCounts.Begin(); i != edgeCounts.End(); ++i)
+    {
+        if (i->second_ == 1)
+            locked[i->first_.first_] = locked[i->first_.second_] = 1;
+    }
+
+    // Sum the planes of the triangles around each vertex. The error of moving a vertex is the sum of its squared distances
+    // to these planes
+    Vector<Quadric> quadrics(numVertices);
+    for (unsigned i = 0; i < dest.Size(); i += 3)
+    {
+        const Vector3& v0 = positions[dest[i]];
+        Vector3 normal = (positions[dest[i + 1]] - v0).CrossProduct(positions[dest[i + 2]] - v0);
+        if (normal.Length() <= M_EPSILON)
+            continue;
+        normal.Normalize();
+        for (unsigned j = 0; j < 3; ++j)
+            quadrics[dest[i + j]].AddPlane(normal, -normal.DotProduct(v0));
+    }
+
+    maxError *= box.Size().Length();
+    maxError *= maxError;
+
+    PODVector<Collapse> collapses;
+    PODVector<unsigned> remaining(numVertices);
+    PODVector<unsigned> offsets(numVertices + 1);
+    PODVector<unsigned> adjacency;
+    PODVector<unsigned> remap(numVertices);
+    PODVector<unsigned char> touched(numVertices);
+
+    // Collapse edges in passes. Each pass collapses the cheapest edges whose surroundings were not changed yet in the pass
+    while (dest.Size() > targetIndexCount)
+    {
+        collapses.Clear();
+        for (unsigned i = 0; i < dest.Size(); ++i)
+        {
+            unsigned from = dest[i];
+            unsigned to = dest[i - i % 3 + (i + 1) % 3];
+            if (from == to)
+                continue;
+            if (!locked[from])
+                collapses.Push({from, to, quadrics[from].Evaluate(positions[to])});
+            if (!locked[to])
+                collapses.Push({to, from, quadrics[to].Evaluate(positions[from])});
+        }
+        if (collapses.Empty())
+            break;
+
+        Sort(collapses.Begin(), collapses.End(), [](const Collapse& lhs, const Collapse& rhs)
+        {
+            return lhs.error_ < rhs.error_;
+        });
+
+        // Build the triangle lists of each vertex
+        for (unsigned i = 0; i < numVertices; ++i)
+            remaining[i] = 0;
+        for (unsigned i = 0; i < dest.Size(); ++i)
+            ++remaining[dest[i]];
+        offsets[0] = 0;
+        for (unsigned i = 0; i < numVertices; ++i)
+            offsets[i + 1] = offsets[i] + remaining[i];
+        adjacency.Resize(dest.Size());
+        for (unsigned i = 0; i < numVertices; ++i)
+            remaining[i] = 0;
+        for (unsigned i = 0; i < dest.Size(); ++i)
+            adjacency[offsets[dest[i]] + remaining[dest[i]]++] = i / 3;
+
+        for (unsigned i = 0; i < numVertices; ++i)
+        {
+            remap[i] = i;
+            touched[i] = 0;
+        }
+
+        unsigned trianglesToRemove = (dest.Size() - targetIndexCount) / 3;
+        unsigned removedTriangles = 0;
+        for (unsigned i = 0; i < collapses.Size() && removedTriangles < trianglesToRemove; ++i)
+        {
+            const Collapse& collapse = collapses[i];
+            if (collapse.error_ > maxError)
+                break;
+            if (touched[collapse.from_] || touched[collapse.to_])
+                continue;
+
+            // Reject the collapse if it would flip or sharply rotate a remaining triangle, as repeated small rotations could
+            // otherwise flip it over several passes
+            bool valid = true;
+            unsigned collapsedTriangles = 0;
+            for (unsigned j = offsets[collapse.from_]; j < offsets[collapse.from_ + 1]; ++j)
+            {
+                const unsigned* triangle = &dest[adjacency[j] * 3];
+                if (triangle[0] == collapse.to_ || triangle[1] == collapse.to_ || triangle[2] == collapse.to_)
+                {
+                    ++collapsedTriangles;
+                    continue;
+                }
+
+                Vector3 v[3];
+                Vector3 moved[3];
+                for (unsigned k = 0; k < 3; ++k)
+                {
+                    v[k] = positions[triangle[k]];
+                    moved[k] = triangle[k] == collapse.from_ ? positions[collapse.to_] : v[k];
+                }
+                Vector3 normal = (v[1] - v[0]).CrossProduct(v[2] - v[0]);
+                Vector3 movedNormal = (moved[1] - moved[0]).CrossProduct(moved[2] - moved[0]);
+                if (normal.DotProduct(movedNormal) <= 0.25f * normal.Length() * movedNormal.Length())
+                {
+                    valid = false;
+                    break;
+                }
+            }
+            if (!valid)
+                continue;
+
+            // Mark the surrounding vertices so that later collapses in this pass see valid positions and triangles
+            for (unsigned j = offsets[collapse.from_]; j < offsets[collapse.from_ + 1]; ++j)
+            {
+                const unsigned* triangle = &dest[adjacency[j] * 3];
+                touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = 1;
+            }
+
+            remap[collapse.from_] = collapse.to_;
+            quadrics[collapse.to_].Add(quadrics[collapse.from_]);
+            removedTriangles += collapsedTriangles;
+        }
+
+        if (!removedTriangles)
+            break;
+
+        // Rewrite the triangles, dropping the collapsed ones
+        unsigned numIndices = 0;
+        for (unsigned i = 0; i < dest.Size(); i += 3)
+        {
+            unsigned v0 = remap[dest[i]];
+            unsigned v1 = remap[dest[i + 1]];
+            unsigned v2 = remap[dest[i + 2]];
+            if (v0 != v1 && v1 != v2 && v2 != v0)
+            {
+                dest[numIndices++] = v0;
+                dest[numIndices++] = v1;
+                dest[numIndices++] = v2;
+            }
+        }
+        dest.Resize(numIndices);
+    }
+}
+
+}
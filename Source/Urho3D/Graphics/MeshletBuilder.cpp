@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/MeshletBuilder.h"
+#include "../Math/BoundingBox.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Minimum dot product of the triangle normals with the cone axis for the cone to be able to cull the meshlet.
+static const float MIN_CONE_DOT = 0.1f;
+
+static void CalculateMeshletBounds(const unsigned* indices, unsigned numIndices, const PODVector<Vector3>& positions,
+    Meshlet& meshlet)
+{
+    BoundingBox box;
+    for (unsigned i = 0; i < numIndices; ++i)
+        box.Merge(positions[indices[i]]);
+
+    meshlet.center_ = box.Center();
+    float radiusSquared = 0.0f;
+    for (unsigned i = 0; i < numIndices; ++i)
+        radiusSquared = Max(radiusSquared, (positions[indices[i]] - meshlet.center_).LengthSquared());
+    meshlet.radius_ = sqrtf(radiusSquared);
+
+    // The cone axis is the average triangle normal. Degenerate triangles do not face any direction and are ignored
+    PODVector<Vector3> normals;
+    Vector3 axis = Vector3::ZERO;
+    for (unsigned i = 0; i + 2 < numIndices; i += 3)
+    {
+        const Vector3& v0 = positions[indices[i]];
+        Vector3 normal = (positions[indices[i + 1]] - v0).CrossProduct(positions[indices[i + 2]] - v0);
+        float length = normal.Length();
+        if (length < M_EPSILON)
+            continue;
+        normal /= length;
+        normals.Push(normal);
+        axis += normal;
+    }
+
+    meshlet.coneAxis_ = Vector3::FORWARD;
+    meshlet.coneCutoff_ = 1.0f;
+
+    float axisLength = axis.Length();
+    if (normals.Empty() || axisLength < M_EPSILON)
+        return;
+    axis /= axisLength;
+
+    float minDot = 1.0f;
+    for (unsigned i = 0; i < normals.Size(); ++i)
+        minDot = Min(minDot, normals[i].DotProduct(axis));
+    meshlet.coneAxis_ = axis;
+    if (minDot > MIN_CONE_DOT)
+        meshlet.coneCutoff_ = sqrtf(1.0f - minDot * minDot);
+}
+
+void BuildMeshlets(PODVector<unsigned>& indices, const PODVector<Vector3>& positions, unsigned indexStart,
+    PODVector<Meshlet>& meshlets)
+{
+    meshlets.Clear();
+
+    unsigned numTriangles = indices.Size() / 3;
+    unsigned numVertices = positions.Size();
+    if (!numTriangles)
+        return;
+
+    // Build the vertex to triangle adjacency
+    PODVector<unsigned> adjacencyStarts(numVertices + 1, 0);
+    for (unsigned i = 0; i < numTriangles * 3; ++i)
+        ++adjacencyStarts[indices[i] + 1];
+    for (unsigned i = 0; i < numVertices; ++i)
+        adjacencyStarts[i + 1] += adjacencyStarts[i];
+    PODVector<unsigned> adjacency(numTriangles * 3);
+    PODVector<unsigned> adjacencyFill(adjacencyStarts.Buffer(), numVertices);
+    for (unsigned i = 0; i < numTriangles * 3; ++i)
+        adjacency[adjacencyFill[indices[i]]++] = i / 3;
+
+    PODVector<bool> emitted(numTriangles, false);
+    PODVector<unsigned> vertexMeshlet(numVertices, M_MAX_UNSIGNED);
+    PODVector<unsigned> candidateMeshlet(numTriangles, M_MAX_UNSIGNED);
+    PODVector<unsigned> candidates;
+    PODVector<unsigned> dest;
+    dest.Reserve(numTriangles * 3);
+
+    unsigned seed = 0;
+    for (;;)
+    {
+        while (seed < numTriangles && emitted[seed])
+            ++seed;
+        if (seed >= numTriangles)
+            break;
+
+        // Grow the meshlet from the seed triangle, preferring the neighbors that add the least new vertices
+        unsigned meshletIndex = meshlets.Size();
+        unsigned meshletStart = dest.Size();
+        unsigned numMeshletVertices = 0;
+        unsigned numMeshletTriangles = 0;
+        candidates.Clear();
+        candidates.Push(seed);
+        candidateMeshlet[seed] = meshletIndex;
+
+        while (!candidates.Empty() && numMeshletTriangles < MAX_MESHLET_TRIANGLES)
+        {
+            unsigned best = M_MAX_UNSIGNED;
+            unsigned bestNewVertices = 4;
+            for (unsigned i = 0; i < candidates.Size();)
+            {
+                unsigned triangle = candidates[i];
+                if (emitted[triangle])
+                {
+                    candidates.EraseSwap(i);
+                    continue;
+                }
+
+                unsigned newVertices = 0;
+                for (unsigned j = 0; j < 3; ++j)
+                {
+                    if (vertexMeshlet[indices[triangle * 3 + j]] != meshletIndex)
+                        ++newVertices;
+                }
+                if (newVertices < bestNewVertices)
+                {
+                    best = i;
+                    bestNewVertices = newVertices;
+                    if (!newVertices)
+                        break;
+                }
+                ++i;
+            }
+
+            if (best == M_MAX_UNSIGNED || numMeshletVertices + bestNewVertices > MAX_MESHLET_VERTICES)
+                break;
+
+            unsigned triangle = candidates[best];
+            candidates.EraseSwap(best);
+            emitted[triangle] = true;
+            ++numMeshletTriangles;
+            numMeshletVertices += bestNewVertices;
+
+            for (unsigned i = 0; i < 3; ++i)
+            {
+                unsigned vertex = indices[triangle * 3 + i];
+                dest.Push(vertex);
+                vertexMeshlet[vertex] = meshletIndex;
+
+                for (unsigned j = adjacencyStarts[vertex]; j < adjacencyStarts[vertex + 1]; ++j)
+                {
+                    unsigned neighbor = adjacency[j];
+                    if (!emitted[neighbor] && candidateMeshlet[neighbor] != meshletIndex)
+                    {
+                        candidateMeshlet[neighbor] = meshletIndex;
+                        candidates.Push(neighbor);
+                    }
+                }
+            }
+        }
+
+        Meshlet meshlet;
+        meshlet.indexStart_ = indexStart + meshletStart;
+        meshlet.indexCount_ = dest.Size() - meshletStart;
+        CalculateMeshletBounds(&dest[meshletStart], meshlet.indexCount_, positions, meshlet);
+        meshlets.Push(meshlet);
+    }
+
+    // Keep any trailing indices that do not form a whole triangle
+    for (unsigned i = numTriangles * 3; i < indices.Size(); ++i)
+        dest.Push(indices[i]);
+    indices.Swap(dest);
+}
+
+}
@@ -0,0 +1,374 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/Geometry.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/IndexBuffer.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/MeshletModel.h"
+#include "../Graphics/Model.h"
+#include "../Graphics/OcclusionBuffer.h"
+#include "../Graphics/Renderer.h"
+#include "../IO/Log.h"
+#include "../Scene/Node.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+extern const char* GEOMETRY_CATEGORY;
+
+/// Maximum number of indices in one compacted range, as each range is copied by a single thread group.
+static const unsigned MAX_COMPACT_RANGE_INDICES = 1024;
+
+MeshletModel::MeshletModel(Context* context) :
+    StaticModel(context),
+    numVisibleMeshlets_(0),
+    meshletCulling_(true),
+    compactPending_(false),
+    compactFailed_(false)
+{
+}
+
+MeshletModel::~MeshletModel() = default;
+
+void MeshletModel::RegisterObject(Context* context)
+{
+    context->RegisterFactory<MeshletModel>(GEOMETRY_CATEGORY);
+
+    URHO3D_COPY_BASE_ATTRIBUTES(StaticModel);
+    URHO3D_ACCESSOR_ATTRIBUTE("Meshlet Culling", GetMeshletCulling, SetMeshletCulling, bool, true, AM_DEFAULT);
+}
+
+void MeshletModel::UpdateBatches(const FrameInfo& frame)
+{
+    MutexLock lock(cullMutex_);
+
+    StaticModel::UpdateBatches(frame);
+    if (!IsMeshletCullingActive())
+        return;
+
+    MeshletCullResult* result = GetCullResult(frame);
+    if (result->frameNumber_ != frame.frameNumber_)
+        CullMeshlets(frame, *result);
+
+    // The LOD geometry stays available for shadow rendering, which must not use the meshlets culled for the camera
+    for (unsigned i = 0; i < batches_.Size(); ++i)
+    {
+        Geometry* drawGeometry = result->drawGeometries_[i];
+        Geometry* sourceGeometry = result->sourceGeometries_[i];
+        batches_[i].geometry_ = drawGeometry;
+        batches_[i].shadowGeometry_ = drawGeometry != sourceGeometry ? sourceGeometry : nullptr;
+    }
+}
+
+void MeshletModel::UpdateGeometry(const FrameInfo& frame)
+{
+    MutexLock lock(cullMutex_);
+
+    compactPending_ = false;
+    if (!IsMeshletCullingActive())
+        return;
+
+    MeshletCullResult* result = nullptr;
+    for (unsigned i = 0; i < cullResults_.Size(); ++i)
+    {
+        if (cullResults_[i]->camera_ == frame.camera_ && cullResults_[i]->frameNumber_ == frame.frameNumber_)
+        {
+            result = cullResults_[i].Get();
+            break;
+        }
+    }
+    if (!result || result->compactFrameNumber_ == frame.frameNumber_)
+        return;
+    result->compactFrameNumber_ = frame.frameNumber_;
+
+    URHO3D_PROFILE(CompactMeshlets);
+
+    auto* graphics = GetSubsystem<Graphics>();
+
+    for (unsigned i = 0; i < result->ranges_.Size(); ++i)
+    {
+        Geometry* sourceGeometry = result->sourceGeometries_[i];
+        if (!sourceGeometry || sourceGeometry->GetMeshlets().Empty())
+            continue;
+
+        // Create the compacted index buffer on first use, large enough for any LOD level. Until then the batch draws the
+        // whole LOD geometry
+        if (!result->indexBuffers_[i])
+        {
+            unsigned maxIndexCount = 0;
+            for (unsigned j = 0; j < geometries_[i].Size(); ++j)
+                maxIndexCount = Max(maxIndexCount, geometries_[i][j]->GetIndexCount());
+
+            SharedPtr<IndexBuffer> buffer(new IndexBuffer(context_));
+            buffer->SetComputeAccess(true);
+            buffer->SetSize(maxIndexCount, true);
+            SharedPtr<Geometry> geometry(new Geometry(context_));
+            geometry->SetIndexBuffer(buffer);
+            result->indexBuffers_[i] = buffer;
+            result->culledGeometries_[i] = geometry;
+        }
+
+        const PODVector<unsigned>& ranges = result->ranges_[i];
+        if (ranges.Empty())
+            continue;
+
+        // Vertex buffers are reference counted, so they are assigned here instead of in the worker threads
+        Geometry* culledGeometry = result->culledGeometries_[i];
+        unsigned numVertexBuffers = sourceGeometry->GetNumVertexBuffers();
+        if (culledGeometry->GetNumVertexBuffers() != numVertexBuffers)
+            culledGeometry->SetNumVertexBuffers(numVertexBuffers);
+        for (unsigned j = 0; j < numVertexBuffers; ++j)
+        {
+            if (culledGeometry->GetVertexBuffer(j) != sourceGeometry->GetVertexBuffer(j))
+                culledGeometry->SetVertexBuffer(j, sourceGeometry->GetVertexBuffer(j));
+        }
+
+        IndexBuffer* sourceBuffer = sourceGeometry->GetIndexBuffer();
+        sourceBuffer->SetComputeAccess(true);
+        if (!graphics->CompactIndices(sourceBuffer, result->indexBuffers_[i], ranges.Buffer(), ranges.Size() / 3))
+        {
+            URHO3D_LOGWARNING("Could not compact meshlet indices of " + (model_ ? model_->GetName() : String::EMPTY) +
+                ", drawing whole geometries instead");
+            compactFailed_ = true;
+
+            // The batches of this frame are already queued, so make the culled geometries draw nothing
+            for (unsigned j = 0; j < result->culledGeometries_.Size(); ++j)
+            {
+                if (result->culledGeometries_[j])
+                    result->culledGeometries_[j]->SetDrawRange(TRIANGLE_LIST, 0, 0, false);
+            }
+            for (unsigned j = 0; j < batches_.Size(); ++j)
+            {
+                batches_[j].geometry_ = GetLodGeometry(j, M_MAX_UNSIGNED);
+                batches_[j].shadowGeometry_ = nullptr;
+            }
+            return;
+        }
+    }
+}
+
+UpdateGeometryType MeshletModel::GetUpdateGeometryType()
+{
+    return compactPending_ ? UPDATE_MAIN_THREAD : UPDATE_NONE;
+}
+
+Geometry* MeshletModel::GetLodGeometry(unsigned batchIndex, unsigned level)
+{
+    if (batchIndex >= geometries_.Size() || geometries_[batchIndex].Empty())
+        return nullptr;
+
+    // If level is out of range, use the visible LOD level, as the batch may draw a culled geometry without CPU-side data
+    const Vector<SharedPtr<Geometry> >& lodGeometries = geometries_[batchIndex];
+    if (level >= lodGeometries.Size())
+        level = geometryData_[batchIndex].lodLevel_;
+    return lodGeometries[Min(level, lodGeometries.Size() - 1)];
+}
+
+void MeshletModel::SetModel(Model* model)
+{
+    StaticModel::SetModel(model);
+    ResetCullResults();
+}
+
+void MeshletModel::SetMeshletCulling(bool enable)
+{
+    if (enable != meshletCulling_)
+    {
+        meshletCulling_ = enable;
+        ResetCullResults();
+        MarkNetworkUpdate();
+    }
+}
+
+bool MeshletModel::IsMeshletCullingActive() const
+{
+    if (!meshletCulling_ || compactFailed_)
+        return false;
+
+    auto* graphics = GetSubsystem<Graphics>();
+    return graphics && graphics->GetComputeSkinningSupport();
+}
+
+void MeshletModel::ResetCullResults()
+{
+    MutexLock lock(cullMutex_);
+
+    cullResults_.Clear();
+    compactPending_ = false;
+    compactFailed_ = false;
+    numVisibleMeshlets_ = 0;
+
+    for (unsigned i = 0; i < batches_.Size(); ++i)
+    {
+        batches_[i].geometry_ = GetLodGeometry(i, M_MAX_UNSIGNED);
+        batches_[i].shadowGeometry_ = nullptr;
+    }
+}
+
+MeshletCullResult* MeshletModel::GetCullResult(const FrameInfo& frame)
+{
+    MeshletCullResult* freeResult = nullptr;
+
+    for (unsigned i = 0; i < cullResults_.Size(); ++i)
+    {
+        MeshletCullResult* result = cullResults_[i].Get();
+        if (result->camera_ == frame.camera_)
+            return result;
+        // Results of earlier frames have been rendered already and can be reused for another camera
+        if (!freeResult && result->frameNumber_ != frame.frameNumber_)
+            freeResult = result;
+    }
+
+    if (!freeResult)
+    {
+        cullResults_.Push(UniquePtr<MeshletCullResult>(new MeshletCullResult()));
+        freeResult = cullResults_.Back().Get();
+    }
+
+    freeResult->camera_ = frame.camera_;
+    freeResult->frameNumber_ = M_MAX_UNSIGNED;
+    freeResult->compactFrameNumber_ = M_MAX_UNSIGNED;
+    return freeResult;
+}
+
+void MeshletModel::CullMeshlets(const FrameInfo& frame, MeshletCullResult& result)
+{
+    URHO3D_PROFILE(CullMeshlets);
+
+    Camera* camera = frame.camera_;
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    Matrix3x4 inverseWorld = worldTransform.Inverse();
+
+    // Test in the local space, where the meshlet bounds are. For the normal cones this is exact for any transform that
+    // keeps the triangle winding
+    Frustum localFrustum = camera->GetFrustum().Transformed(inverseWorld);
+    bool frustumCulling = localFrustum.IsInsideFast(boundingBox_) != INSIDE;
+    Vector3 localCameraPosition = inverseWorld * camera->GetNode()->GetWorldPosition();
+    Vector3 row0(worldTransform.m00_, worldTransform.m01_, worldTransform.m02_);
+    Vector3 row1(worldTransform.m10_, worldTransform.m11_, worldTransform.m12_);
+    Vector3 row2(worldTransform.m20_, worldTransform.m21_, worldTransform.m22_);
+    bool coneCulling = !camera->IsOrthographic() && !camera->GetReverseCulling() && row0.DotProduct(row1.CrossProduct(row2)) > 0.0f;
+
+    // Use the depth read back from the GPU on earlier frames as a depth hierarchy
+    auto* renderer = GetSubsystem<Renderer>();
+    OcclusionBuffer* occlusionBuffer = occludee_ && renderer ? renderer->GetGPUOcclusionBuffer(camera) : nullptr;
+
+    unsigned numBatches = batches_.Size();
+    result.frameNumber_ = frame.frameNumber_;
+    result.drawGeometries_.Resize(numBatches);
+    result.sourceGeometries_.Resize(numBatches);
+    result.ranges_.Resize(numBatches);
+    result.culledGeometries_.Resize(numBatches);
+    result.indexBuffers_.Resize(numBatches);
+    numVisibleMeshlets_ = 0;
+
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        Geometry* lodGeometry = GetLodGeometry(i, M_MAX_UNSIGNED);
+        result.sourceGeometries_[i] = lodGeometry;
+        result.drawGeometries_[i] = lodGeometry;
+        PODVector<unsigned>& ranges = result.ranges_[i];
+        ranges.Clear();
+
+        // The source indices are read by the compute shader, which needs them shadowed to recreate the buffer for access
+        if (!lodGeometry || lodGeometry->GetMeshlets().Empty() || lodGeometry->GetPrimitiveType() != TRIANGLE_LIST)
+            continue;
+        IndexBuffer* sourceBuffer = lodGeometry->GetIndexBuffer();
+        if (!sourceBuffer || (!sourceBuffer->GetComputeAccess() && !sourceBuffer->IsShadowed()))
+            continue;
+
+        // Backfacing cones can only be culled when the material culls the back faces
+        Material* material = batches_[i].material_;
+        bool batchConeCulling = coneCulling && (!material || material->GetCullMode() == CULL_CCW);
+
+        const PODVector<Meshlet>& meshlets = lodGeometry->GetMeshlets();
+        unsigned numIndices = 0;
+        unsigned numVisibleIndices = 0;
+        for (unsigned j = 0; j < meshlets.Size(); ++j)
+        {
+            const Meshlet& meshlet = meshlets[j];
+            numIndices += meshlet.indexCount_;
+
+            Sphere sphere(meshlet.center_, meshlet.radius_);
+            if (frustumCulling && localFrustum.IsInsideFast(sphere) == OUTSIDE)
+                continue;
+            if (batchConeCulling && meshlet.coneCutoff_ < 1.0f)
+            {
+                Vector3 direction = meshlet.center_ - localCameraPosition;
+                if (direction.DotProduct(meshlet.coneAxis_) >= meshlet.coneCutoff_ * direction.Length() + meshlet.radius_)
+                    continue;
+            }
+            if (occlusionBuffer && !occlusionBuffer->IsVisible(BoundingBox(sphere).Transformed(worldTransform)))
+                continue;
+
+            // Merge consecutive visible meshlets into one range
+            unsigned numRanges = ranges.Size() / 3;
+            if (numRanges && ranges[numRanges * 3 - 3] + ranges[numRanges * 3 - 1] == meshlet.indexStart_ &&
+                ranges[numRanges * 3 - 1] + meshlet.indexCount_ <= MAX_COMPACT_RANGE_INDICES)
+                ranges[numRanges * 3 - 1] += meshlet.indexCount_;
+            else
+            {
+                ranges.Push(meshlet.indexStart_);
+                ranges.Push(numVisibleIndices);
+                ranges.Push(meshlet.indexCount_);
+            }
+            numVisibleIndices += meshlet.indexCount_;
+            ++numVisibleMeshlets_;
+        }
+
+        if (numVisibleIndices == numIndices)
+        {
+            // Everything is visible, so draw the LOD geometry as is
+            ranges.Clear();
+            continue;
+        }
+        if (!numVisibleIndices)
+        {
+            result.drawGeometries_[i] = nullptr;
+            continue;
+        }
+
+        // The compacted buffers are created in the main thread, after which the culled geometry is drawn from the next frame on
+        compactPending_ = true;
+        IndexBuffer* destBuffer = result.indexBuffers_[i];
+        if (!destBuffer || destBuffer->GetIndexCount() < numVisibleIndices)
+        {
+            ranges.Clear();
+            continue;
+        }
+
+        result.culledGeometries_[i]->SetDrawRange(TRIANGLE_LIST, 0, numVisibleIndices, lodGeometry->GetVertexStart(),
+            lodGeometry->GetVertexCount(), false);
+        result.drawGeometries_[i] = result.culledGeometries_[i];
+    }
+}
+
+}
@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/Ptr.h"
+#include "../Core/Mutex.h"
+#include "../Graphics/StaticModel.h"
+
+namespace Urho3D
+{
+
+class IndexBuffer;
+
+/// Meshlets of a MeshletModel visible from one camera. Kept until a later frame so that the culled geometries stay valid until rendered.
+struct MeshletCullResult
+{
+    /// Camera.
+    Camera* camera_{};
+    /// Frame number on which was culled.
+    unsigned frameNumber_{M_MAX_UNSIGNED};
+    /// Frame number on which the visible indices were compacted.
+    unsigned compactFrameNumber_{M_MAX_UNSIGNED};
+    /// Geometry drawn by each batch: the LOD geometry, the culled geometry, or null if no meshlet is visible.
+    PODVector<Geometry*> drawGeometries_;
+    /// LOD geometry the visible meshlets of each batch are from.
+    PODVector<Geometry*> sourceGeometries_;
+    /// Visible index ranges of each batch, as source index start, compacted index start and index count.
+    Vector<PODVector<unsigned> > ranges_;
+    /// Culled geometry of each batch, drawing the compacted indices.
+    Vector<SharedPtr<Geometry> > culledGeometries_;
+    /// Compacted index buffer of each batch.
+    Vector<SharedPtr<IndexBuffer> > indexBuffers_;
+};
+
+/// Static model component that culls the meshlets of its geometries individually by the frustum, their normal cones and the GPU depth readback, and compacts the visible triangles with a compute shader before drawing. Falls back to drawing the whole geometries when the model has no meshlets or compute shaders are not supported.
+class URHO3D_API MeshletModel : public StaticModel
+{
+    URHO3D_OBJECT(MeshletModel, StaticModel);
+
+public:
+    /// Construct.
+    explicit MeshletModel(Context* context);
+    /// Destruct.
+    ~MeshletModel() override;
+    /// Register object factory. StaticModel must be registered first.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Calculate distance and prepare batches for rendering. May be called from worker thread(s), possibly re-entrantly.
+    void UpdateBatches(const FrameInfo& frame) override;
+    /// Compact the visible meshlet indices for the current camera.
+    void UpdateGeometry(const FrameInfo& frame) override;
+    /// Return whether a geometry update is necessary, and if it can happen in a worker thread.
+    UpdateGeometryType GetUpdateGeometryType() override;
+    /// Return the geometry for a specific LOD level.
+    Geometry* GetLodGeometry(unsigned batchIndex, unsigned level) override;
+
+    /// Set model.
+    /// @manualbind
+    void SetModel(Model* model) override;
+    /// Set whether meshlets are culled individually.
+    /// @property
+    void SetMeshletCulling(bool enable);
+
+    /// Return whether meshlets are culled individually.
+    /// @property
+    bool GetMeshletCulling() const { return meshletCulling_; }
+    /// Return whether meshlets are culled individually and the model and the graphics device support it.
+    bool IsMeshletCullingActive() const;
+    /// Return number of visible meshlets on the last culled frame.
+    /// @property
+    unsigned GetNumVisibleMeshlets() const { return numVisibleMeshlets_; }
+
+private:
+    /// Invalidate the cull results and restore the LOD geometries into the batches.
+    void ResetCullResults();
+    /// Return the cull result for a camera, or a free one to fill for it on the current frame.
+    MeshletCullResult* GetCullResult(const FrameInfo& frame);
+    /// Cull the meshlets of the current LOD geometries for a camera and collect the visible index ranges.
+    void CullMeshlets(const FrameInfo& frame, MeshletCullResult& result);
+
+    /// Cull results by camera.
+    Vector<UniquePtr<MeshletCullResult> > cullResults_;
+    /// Mutex for culling, as shadow casters may be updated from several threads.
+    Mutex cullMutex_;
+    /// Number of visible meshlets on the last culled frame.
+    unsigned numVisibleMeshlets_;
+    /// Meshlet culling enable flag.
+    bool meshletCulling_;
+    /// Whether visible indices are waiting to be compacted or compacted index buffers to be created on the main thread.
+    bool compactPending_;
+    /// Whether compacting the indices has failed, after which the whole geometries are drawn.
+    bool compactFailed_;
+};
+
+}
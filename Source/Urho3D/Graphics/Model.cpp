@@ -24,10 +24,15 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/IndexBuffer.h"
+#include "../Graphics/MeshSimplifier.h"
+#include "../Graphics/MeshletBuilder.h"
 #include "../Graphics/Model.h"
 #include "../Graphics/Graphics.h"
+#include "../Graphics/GraphicsEvents.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../IO/Log.h"
 #include "../IO/File.h"
@@ -40,6 +45,145 @@
 namespace Urho3D
 {
 
+/// Version of the generated LOD cache files. Increment when the format or the simplification changes.
+static const unsigned LOD_CACHE_VERSION = 1;
+/// Minimum reduction of the index count from the previous LOD level for a generated level to be kept.
+static const float LOD_MIN_REDUCTION = 0.9f;
+
+/// Geometry to generate LOD levels for. Uses a compacted vertex numbering, so that the simplification only touches the vertices of the geometry.
+struct LodGenerationTask
+{
+    /// Geometry index.
+    unsigned geometryIndex_;
+    /// Vertex buffer index.
+    unsigned vbRef_;
+    /// Number of LOD levels to generate.
+    unsigned numLevels_;
+    /// Index count ratio of each generated level to the previous one.
+    float ratio_;
+    /// Maximum simplification error relative to the geometry size.
+    float maxError_;
+    /// Vertex buffer index of each compacted vertex.
+    PODVector<unsigned> vertices_;
+    /// Positions of the compacted vertices.
+    PODVector<Vector3> positions_;
+    /// Full detail indices using the compacted vertices.
+    PODVector<unsigned> indices_;
+    /// Generated LOD level indices using the compacted vertices.
+    Vector<PODVector<unsigned> > lodIndices_;
+};
+
+static inline unsigned HashWords(unsigned hash, const void* data, unsigned numWords)
+{
+    const auto* words = static_cast<const unsigned*>(data);
+    for (unsigned i = 0; i < numWords; ++i)
+        hash = words[i] + (hash << 6u) + (hash << 16u) - hash;
+    return hash;
+}
+
+/// Return the resource name of the generated LOD cache file of a model, next to the model.
+static String GetLodCacheName(const String& modelName)
+{
+    return GetPath(modelName) + GetFileName(modelName) + ".lod";
+}
+
+/// Simplify each LOD level from the previous one. Stop when the geometry can not be reduced meaningfully any more.
+static void SimplifyLodLevels(LodGenerationTask& task)
+{
+    const PODVector<unsigned>* sourceIndices = &task.indices_;
+    for (unsigned i = 0; i < task.numLevels_; ++i)
+    {
+        auto targetIndexCount = (unsigned)(sourceIndices->Size() / 3 * task.ratio_) * 3;
+
+        PODVector<unsigned> lodIndices;
+        SimplifyIndices(*sourceIndices, task.positions_, targetIndexCount, lodIndices, task.maxError_);
+        if (lodIndices.Empty() || lodIndices.Size() > sourceIndices->Size() * LOD_MIN_REDUCTION)
+            break;
+
+        task.lodIndices_.Push(lodIndices);
+        sourceIndices = &task.lodIndices_.Back();
+    }
+}
+
+static void SimplifyLodLevelsWork(const WorkItem* item, unsigned /*threadIndex*/)
+{
+    SimplifyLodLevels(*reinterpret_cast<LodGenerationTask*>(item->aux_));
+}
+
+static bool LoadLodCache(Deserializer& source, Vector<LodGenerationTask>& tasks, unsigned dataHash)
+{
+    if (source.ReadFileID() != "ULOD" || source.ReadUInt() != LOD_CACHE_VERSION || source.ReadUInt() != dataHash ||
+        source.ReadUInt() != tasks.Size())
+        return false;
+
+    for (unsigned i = 0; i < tasks.Size(); ++i)
+    {
+        LodGenerationTask& task = tasks[i];
+        unsigned numLevels = source.ReadUInt();
+        if (numLevels > task.numLevels_)
+            return false;
+
+        task.lodIndices_.Resize(numLevels);
+        for (unsigned j = 0; j < numLevels; ++j)
+        {
+            PODVector<unsigned>& lodIndices = task.lodIndices_[j];
+            lodIndices.Resize(source.ReadUInt());
+            if (lodIndices.Size() % 3 || lodIndices.Size() > task.indices_.Size())
+                return false;
+            if (source.Read(lodIndices.Buffer(), lodIndices.Size() * sizeof(unsigned)) != lodIndices.Size() * sizeof(unsigned))
+                return false;
+            for (unsigned k = 0; k < lodIndices.Size(); ++k)
+            {
+                if (lodIndices[k] >= task.vertices_.Size())
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool SaveLodCache(Serializer& dest, const Vector<LodGenerationTask>& tasks, unsigned dataHash)
+{
+    dest.WriteFileID("ULOD");
+    dest.WriteUInt(LOD_CACHE_VERSION);
+    dest.WriteUInt(dataHash);
+    dest.WriteUInt(tasks.Size());
+    for (unsigned i = 0; i < tasks.Size(); ++i)
+    {
+        const LodGenerationTask& task = tasks[i];
+        dest.WriteUInt(task.lodIndices_.Size());
+        for (unsigned j = 0; j < task.lodIndices_.Size(); ++j)
+        {
+            const PODVector<unsigned>& lodIndices = task.lodIndices_[j];
+            dest.WriteUInt(lodIndices.Size());
+            if (dest.Write(lodIndices.Buffer(), lodIndices.Size() * sizeof(unsigned)) != lodIndices.Size() * sizeof(unsigned))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/// Read the vertex elements of a vertex buffer from a model file.
+static PODVector<VertexElement> ReadVertexElements(Deserializer& source, bool hasVertexDeclarations)
+{
+    if (!hasVertexDeclarations)
+        return VertexBuffer::GetElements(source.ReadUInt());
+
+    PODVector<VertexElement> elements;
+    unsigned numElements = source.ReadUInt();
+    for (unsigned i = 0; i < numElements; ++i)
+    {
+        unsigned elementDesc = source.ReadUInt();
+        auto type = (VertexElementType)(elementDesc & 0xffu);
+        auto semantic = (VertexElementSemantic)((elementDesc >> 8u) & 0xffu);
+        auto index = (unsigned char)((elementDesc >> 16u) & 0xffu);
+        elements.Push(VertexElement(type, semantic, index));
+    }
+    return elements;
+}
+
 unsigned LookupVertexBuffer(VertexBuffer* buffer, const Vector<SharedPtr<VertexBuffer> >& buffers)
 {
     for (unsigned i = 0; i < buffers.Size(); ++i)
@@ -88,12 +232,18 @@ bool Model::BeginLoad(Deserializer& source)
     geometryBoneMappings_.Clear();
     geometryCenters_.Clear();
     morphs_.Clear();
+    morphDeltaBuffers_.Clear();
     vertexBuffers_.Clear();
     indexBuffers_.Clear();
+    shadowDataReleased_ = false;
 
     unsigned memoryUse = sizeof(Model);
     bool async = GetAsyncLoadState() == ASYNC_LOADING;
 
+    // In headless mode only the positions and indices, which physics and navigation read, are needed
+    auto* cache = GetSubsystem<ResourceCache>();
+    bool stripRenderData = cache->GetStripHeadlessRenderData() && !GetSubsystem<Graphics>();
+
     // Read vertex buffers
     unsigned numVertexBuffers = source.ReadUInt();
     vertexBuffers_.Reserve(numVertexBuffers);
@@ -105,24 +255,7 @@ bool Model::BeginLoad(Deserializer& source)
         VertexBufferDesc& desc = loadVBData_[i];
 
         desc.vertexCount_ = source.ReadUInt();
-        if (!hasVertexDeclarations)
-        {
-            unsigned elementMask = source.ReadUInt();
-            desc.vertexElements_ = VertexBuffer::GetElements(elementMask);
-        }
-        else
-        {
-            desc.vertexElements_.Clear();
-            unsigned numElements = source.ReadUInt();
-            for (unsigned j = 0; j < numElements; ++j)
-            {
-                unsigned elementDesc = source.ReadUInt();
-                auto type = (VertexElementType)(elementDesc & 0xffu);
-                auto semantic = (VertexElementSemantic)((elementDesc >> 8u) & 0xffu);
-                auto index = (unsigned char)((elementDesc >> 16u) & 0xffu);
-                desc.vertexElements_.Push(VertexElement(type, semantic, index));
-            }
-        }
+        desc.vertexElements_ = ReadVertexElements(source, hasVertexDeclarations);
 
         morphRangeStarts_[i] = source.ReadUInt();
         morphRangeCounts_[i] = source.ReadUInt();
@@ -132,7 +265,30 @@ bool Model::BeginLoad(Deserializer& source)
         desc.dataSize_ = desc.vertexCount_ * vertexSize;
 
         // Prepare vertex buffer data to be uploaded during EndLoad()
-        if (async)
+        if (stripRenderData)
+        {
+            desc.data_ = new unsigned char[desc.dataSize_];
+            source.Read(desc.data_.Get(), desc.dataSize_);
+
+            unsigned positionOffset = VertexBuffer::GetElementOffset(desc.vertexElements_, TYPE_VECTOR3, SEM_POSITION);
+            if (positionOffset != M_MAX_UNSIGNED && vertexSize > sizeof(Vector3))
+            {
+                SharedArrayPtr<unsigned char> positions(new unsigned char[desc.vertexCount_ * sizeof(Vector3)]);
+                for (unsigned j = 0; j < desc.vertexCount_; ++j)
+                    memcpy(&positions[j * sizeof(Vector3)], &desc.data_[j * vertexSize + positionOffset], sizeof(Vector3));
+
+                desc.vertexElements_.Clear();
+                desc.vertexElements_.Push(VertexElement(TYPE_VECTOR3, SEM_POSITION));
+                vertexSize = sizeof(Vector3);
+                desc.dataSize_ = desc.vertexCount_ * vertexSize;
+                desc.data_ = positions;
+            }
+
+            // The morphs are not applied without rendering
+            morphRangeStarts_[i] = 0;
+            morphRangeCounts_[i] = 0;
+        }
+        else if (async)
         {
             desc.data_ = new unsigned char[desc.dataSize_];
             source.Read(desc.data_.Get(), desc.dataSize_);
@@ -186,6 +342,7 @@ bool Model::BeginLoad(Deserializer& source)
         memoryUse += sizeof(IndexBuffer) + indexCount * indexSize;
         indexBuffers_.Push(buffer);
     }
+    numFileIndexBuffers_ = numIndexBuffers;
 
     // Read geometries
     unsigned numGeometries = source.ReadUInt();
@@ -281,6 +438,14 @@ bool Model::BeginLoad(Deserializer& source)
             if (newBuffer.elementMask_ & MASK_TANGENT)
                 vertexSize += sizeof(Vector3);
             newBuffer.dataSize_ = newBuffer.vertexCount_ * vertexSize;
+
+            // Keep only the morph names in headless mode, so that setting the weights still works
+            if (stripRenderData)
+            {
+                source.SeekRelative(newBuffer.dataSize_);
+                continue;
+            }
+
             newBuffer.morphData_ = new unsigned char[newBuffer.dataSize_];
 
             source.Read(&newBuffer.morphData_[0], newBuffer.vertexCount_ * vertexSize);
@@ -307,12 +472,45 @@ bool Model::BeginLoad(Deserializer& source)
         geometryCenters_.Push(Vector3::ZERO);
     memoryUse += sizeof(Vector3) * geometries_.Size();
 
+    // The shadow data can be released and read back later only if the GPU copies are all that rendering needs, and the
+    // buffers loaded from the file are not modified afterward
+    bool releaseShadowData = cache->GetReleaseModelShadowData();
+    shadowDataReloadable_ = !stripRenderData && GetSubsystem<Graphics>() && morphs_.Empty();
+
     // Read metadata
-    auto* cache = GetSubsystem<ResourceCache>();
     String xmlName = ReplaceExtension(GetName(), ".xml");
     SharedPtr<XMLFile> file(cache->GetTempResource<XMLFile>(xmlName, false));
     if (file)
-        LoadMetadataFromXML(file->GetRoot());
+    {
+        XMLElement rootElem = file->GetRoot();
+        LoadMetadataFromXML(rootElem);
+
+        // Override the shadow data release policy for this model, if specified
+        XMLElement shadowDataElem = rootElem.GetChild("shadowdata");
+        if (shadowDataElem && shadowDataElem.HasAttribute("release"))
+            releaseShadowData = shadowDataElem.GetBool("release");
+
+        // Generate LOD levels for the geometries that have none, if requested
+        XMLElement autoLodElem = rootElem.GetChild("autolod");
+        if (autoLodElem && !stripRenderData)
+        {
+            unsigned numLevels = autoLodElem.HasAttribute("levels") ? autoLodElem.GetUInt("levels") : 3;
+            float ratio = autoLodElem.HasAttribute("ratio") ? Clamp(autoLodElem.GetFloat("ratio"), 0.01f, 0.99f) : 0.5f;
+            float distance = autoLodElem.HasAttribute("distance") ? Max(autoLodElem.GetFloat("distance"), 0.0f) :
+                boundingBox_.Size().Length();
+            float maxError = autoLodElem.HasAttribute("maxerror") ? Max(autoLodElem.GetFloat("maxerror"), 0.0f) : 0.02f;
+            memoryUse += GenerateLodLevels(numLevels, ratio, distance, maxError);
+        }
+
+        // Build meshlets for per-cluster culling, if requested
+        if (rootElem.GetChild("meshlets") && !stripRenderData)
+        {
+            memoryUse += BuildLoadMeshlets();
+            shadowDataReloadable_ = false;
+        }
+    }
+
+    releaseShadowDataOnLoad_ = releaseShadowData && shadowDataReloadable_;
 
     SetMemoryUse(memoryUse);
     return true;
@@ -362,11 +560,22 @@ bool Model::EndLoad()
     loadVBData_.Clear();
     loadIBData_.Clear();
     loadGeometries_.Clear();
+
+    // Drop the shadow data now that it is on the GPU, unless a consumer has asked for it before a reload
+    if (releaseShadowDataOnLoad_ && !shadowDataRequested_)
+        ReleaseShadowData();
+
     return true;
 }
 
 bool Model::Save(Serializer& dest) const
 {
+    if (shadowDataReleased_ && !const_cast<Model*>(this)->RequestShadowData())
+    {
+        URHO3D_LOGERROR("Can not save model " + GetName() + " without its shadow data");
+        return false;
+    }
+
     // Write ID
     if (!dest.WriteFileID("UMD2"))
         return false;
@@ -483,6 +692,263 @@ bool Model::Save(Serializer& dest) const
     return true;
 }
 
+bool Model::GetLoadTriangles(const GeometryDesc& desc, PODVector<unsigned>& vertices, PODVector<Vector3>& positions,
+    PODVector<unsigned>& indices) const
+{
+    bool async = GetAsyncLoadState() == ASYNC_LOADING;
+    const VertexBufferDesc& vbDesc = loadVBData_[desc.vbRef_];
+    const IndexBufferDesc& ibDesc = loadIBData_[desc.ibRef_];
+    IndexBuffer* indexBuffer = indexBuffers_[desc.ibRef_];
+    const unsigned char* vertexData = async ? vbDesc.data_.Get() : vertexBuffers_[desc.vbRef_]->GetShadowData();
+    const unsigned char* indexData = async ? ibDesc.data_.Get() : indexBuffer->GetShadowData();
+    unsigned indexSize = async ? ibDesc.indexSize_ : indexBuffer->GetIndexSize();
+    unsigned indexCount = async ? ibDesc.indexCount_ : indexBuffer->GetIndexCount();
+    if (!vertexData || !indexData || desc.indexStart_ + desc.indexCount_ > indexCount)
+        return false;
+
+    unsigned vertexSize = VertexBuffer::GetVertexSize(vbDesc.vertexElements_);
+    unsigned positionOffset = VertexBuffer::GetElementOffset(vbDesc.vertexElements_, TYPE_VECTOR3, SEM_POSITION);
+
+    vertices.Clear();
+    positions.Clear();
+    indices.Resize(desc.indexCount_);
+
+    PODVector<unsigned> compactVertices(vbDesc.vertexCount_, M_MAX_UNSIGNED);
+    for (unsigned i = 0; i < desc.indexCount_; ++i)
+    {
+        unsigned index = desc.indexStart_ + i;
+        unsigned vertex = indexSize == sizeof(unsigned short) ? ((const unsigned short*)indexData)[index] :
+            ((const unsigned*)indexData)[index];
+        if (vertex >= vbDesc.vertexCount_)
+            return false;
+        if (compactVertices[vertex] == M_MAX_UNSIGNED)
+        {
+            compactVertices[vertex] = vertices.Size();
+            vertices.Push(vertex);
+            positions.Push(*reinterpret_cast<const Vector3*>(vertexData + vertex * vertexSize + positionOffset));
+        }
+        indices[i] = compactVertices[vertex];
+    }
+
+    return true;
+}
+
+unsigned Model::GenerateLodLevels(unsigned numLevels, float ratio, float distance, float maxError)
+{
+    URHO3D_PROFILE(GenerateModelLods);
+
+    bool async = GetAsyncLoadState() == ASYNC_LOADING;
+
+    // Collect the triangle list geometries that have a single LOD level, with the vertex and index data from either the
+    // loaded data or the shadowed buffers
+    Vector<LodGenerationTask> tasks;
+    unsigned dataHash = HashWords(numLevels, &ratio, 1);
+    dataHash = HashWords(dataHash, &maxError, 1);
+    for (unsigned i = 0; i < geometries_.Size(); ++i)
+    {
+        if (geometries_[i].Size() != 1)
+            continue;
+        const GeometryDesc& desc = loadGeometries_[i][0];
+        const VertexBufferDesc& vbDesc = loadVBData_[desc.vbRef_];
+        if (desc.type_ != TRIANGLE_LIST || !desc.indexCount_ || desc.indexCount_ % 3 ||
+            !VertexBuffer::HasElement(vbDesc.vertexElements_, TYPE_VECTOR3, SEM_POSITION))
+            continue;
+
+        tasks.Resize(tasks.Size() + 1);
+        LodGenerationTask& task = tasks.Back();
+        task.geometryIndex_ = i;
+        task.vbRef_ = desc.vbRef_;
+        task.numLevels_ = numLevels;
+        task.ratio_ = ratio;
+        task.maxError_ = maxError;
+        if (!GetLoadTriangles(desc, task.vertices_, task.positions_, task.indices_))
+        {
+            tasks.Pop();
+            continue;
+        }
+
+        dataHash = HashWords(dataHash, &i, 1);
+        dataHash = HashWords(dataHash, task.positions_.Buffer(), task.positions_.Size() * 3);
+        dataHash = HashWords(dataHash, task.indices_.Buffer(), task.indices_.Size());
+    }
+
+    if (tasks.Empty())
+        return 0;
+
+    // Use the cached LOD levels if they were generated from the same data, otherwise generate and cache them
+    auto* cache = GetSubsystem<ResourceCache>();
+    String cacheName = GetLodCacheName(GetName());
+    bool cacheLoaded = false;
+    if (!GetName().Empty() && cache->Exists(cacheName))
+    {
+        SharedPtr<File> cacheFile = cache->GetFile(cacheName, false);
+        cacheLoaded = cacheFile && LoadLodCache(*cacheFile, tasks, dataHash);
+        if (!cacheLoaded)
+        {
+            URHO3D_LOGDEBUG("Generated LOD cache " + cacheName + " is outdated");
+            for (unsigned i = 0; i < tasks.Size(); ++i)
+                tasks[i].lodIndices_.Clear();
+        }
+    }
+
+    if (!cacheLoaded)
+    {
+        // When loading asynchronously, this is already a background thread. Otherwise simplify the geometries in parallel
+        // in the work queue
+        auto* queue = GetSubsystem<WorkQueue>();
+        if (!async && queue && queue->GetNumThreads() && tasks.Size() > 1 && Thread::IsMainThread())
+        {
+            for (unsigned i = 0; i < tasks.Size(); ++i)
+            {
+                SharedPtr<WorkItem> item = queue->GetFreeItem();
+                item->priority_ = M_MAX_UNSIGNED;
+                item->workFunction_ = SimplifyLodLevelsWork;
+                item->aux_ = &tasks[i];
+                queue->AddWorkItem(item);
+            }
+            queue->Complete(M_MAX_UNSIGNED);
+        }
+        else
+        {
+            for (unsigned i = 0; i < tasks.Size(); ++i)
+                SimplifyLodLevels(tasks[i]);
+        }
+
+        String modelFileName = GetName().Empty() ? String::EMPTY : cache->GetResourceFileName(GetName());
+        if (!modelFileName.Empty())
+        {
+            File cacheFile(context_, GetLodCacheName(modelFileName), FILE_WRITE);
+            if (!cacheFile.IsOpen() || !SaveLodCache(cacheFile, tasks, dataHash))
+                URHO3D_LOGWARNING("Could not save generated LOD cache for " + GetName());
+        }
+        else
+            URHO3D_LOGWARNING("Can not save generated LOD cache for " + GetName() + ", as it is not loaded from a file");
+    }
+
+    // Store the generated levels into a new index buffer, remapped to the vertex buffer vertices
+    unsigned numIndices = 0;
+    bool largeIndices = false;
+    for (unsigned i = 0; i < tasks.Size(); ++i)
+    {
+        const LodGenerationTask& task = tasks[i];
+        for (unsigned j = 0; j < task.lodIndices_.Size(); ++j)
+            numIndices += task.lodIndices_[j].Size();
+        if (task.lodIndices_.Size() && loadVBData_[task.vbRef_].vertexCount_ > 0xffff)
+            largeIndices = true;
+    }
+    if (!numIndices)
+        return 0;
+
+    unsigned indexSize = largeIndices ? sizeof(unsigned) : sizeof(unsigned short);
+    SharedArrayPtr<unsigned char> indexData(new unsigned char[numIndices * indexSize]);
+    unsigned ibRef = indexBuffers_.Size();
+    unsigned indexStart = 0;
+    unsigned memoryUse = sizeof(IndexBuffer) + numIndices * indexSize;
+    for (unsigned i = 0; i < tasks.Size(); ++i)
+    {
+        const LodGenerationTask& task = tasks[i];
+        for (unsigned j = 0; j < task.lodIndices_.Size(); ++j)
+        {
+            const PODVector<unsigned>& lodIndices = task.lodIndices_[j];
+            for (unsigned k = 0; k < lodIndices.Size(); ++k)
+            {
+                unsigned vertex = task.vertices_[lodIndices[k]];
+                if (largeIndices)
+                    ((unsigned*)indexData.Get())[indexStart + k] = vertex;
+                else
+                    ((unsigned short*)indexData.Get())[indexStart + k] = (unsigned short)vertex;
+            }
+
+            SharedPtr<Geometry> geometry(new Geometry(context_));
+            geometry->SetLodDistance(distance * (j + 1));
+            geometries_[task.geometryIndex_].Push(geometry);
+
+            GeometryDesc desc;
+            desc.type_ = TRIANGLE_LIST;
+            desc.vbRef_ = task.vbRef_;
+            desc.ibRef_ = ibRef;
+            desc.indexStart_ = indexStart;
+            desc.indexCount_ = lodIndices.Size();
+            loadGeometries_[task.geometryIndex_].Push(desc);
+
+            indexStart += lodIndices.Size();
+            memoryUse += sizeof(Geometry);
+        }
+    }
+
+    SharedPtr<IndexBuffer> buffer(new IndexBuffer(context_));
+    IndexBufferDesc ibDesc;
+    ibDesc.indexCount_ = numIndices;
+    ibDesc.indexSize_ = indexSize;
+    ibDesc.dataSize_ = numIndices * indexSize;
+    if (async)
+        ibDesc.data_ = indexData;
+    else
+    {
+        buffer->SetShadowed(true);
+        buffer->SetSize(numIndices, largeIndices);
+        buffer->SetData(indexData.Get());
+    }
+    indexBuffers_.Push(buffer);
+    loadIBData_.Push(ibDesc);
+
+    URHO3D_LOGDEBUG((cacheLoaded ? "Loaded " : "Generated ") + String(tasks.Size()) + " geometries' LOD levels for " + GetName());
+    return memoryUse;
+}
+
+unsigned Model::BuildLoadMeshlets()
+{
+    URHO3D_PROFILE(BuildModelMeshlets);
+
+    bool async = GetAsyncLoadState() == ASYNC_LOADING;
+    unsigned numMeshlets = 0;
+
+    PODVector<unsigned> vertices;
+    PODVector<Vector3> positions;
+    PODVector<unsigned> indices;
+    PODVector<Meshlet> meshlets;
+
+    for (unsigned i = 0; i < geometries_.Size(); ++i)
+    {
+        for (unsigned j = 0; j < geometries_[i].Size(); ++j)
+        {
+            const GeometryDesc& desc = loadGeometries_[i][j];
+            if (desc.type_ != TRIANGLE_LIST || !desc.indexCount_ || desc.indexCount_ % 3 ||
+                !VertexBuffer::HasElement(loadVBData_[desc.vbRef_].vertexElements_, TYPE_VECTOR3, SEM_POSITION) ||
+                !GetLoadTriangles(desc, vertices, positions, indices))
+                continue;
+
+            BuildMeshlets(indices, positions, desc.indexStart_, meshlets);
+
+            // Write back the indices in meshlet order
+            IndexBuffer* indexBuffer = indexBuffers_[desc.ibRef_];
+            unsigned indexSize = async ? loadIBData_[desc.ibRef_].indexSize_ : indexBuffer->GetIndexSize();
+            SharedArrayPtr<unsigned char> indexData(new unsigned char[desc.indexCount_ * indexSize]);
+            for (unsigned k = 0; k < desc.indexCount_; ++k)
+            {
+                unsigned vertex = vertices[indices[k]];
+                if (indexSize == sizeof(unsigned))
+                    ((unsigned*)indexData.Get())[k] = vertex;
+                else
+                    ((unsigned short*)indexData.Get())[k] = (unsigned short)vertex;
+            }
+            if (async)
+            {
+                memcpy(loadIBData_[desc.ibRef_].data_.Get() + desc.indexStart_ * indexSize, indexData.Get(),
+                    desc.indexCount_ * indexSize);
+            }
+            else
+                indexBuffer->SetDataRange(indexData.Get(), desc.indexStart_, desc.indexCount_);
+
+            geometries_[i][j]->SetMeshlets(meshlets);
+            numMeshlets += meshlets.Size();
+        }
+    }
+
+    URHO3D_LOGDEBUG("Built " + String(numMeshlets) + " meshlets for " + GetName());
+    return numMeshlets * sizeof(Meshlet);
+}
+
 void Model::SetBoundingBox(const BoundingBox& box)
 {
     boundingBox_ = box;
@@ -505,7 +971,12 @@ bool Model::SetVertexBuffers(const Vector<SharedPtr<VertexBuffer> >& buffers, co
         }
     }
 
+    // The buffers are no longer the ones of the model file
+    RequestShadowData();
+    shadowDataReloadable_ = false;
+
     vertexBuffers_ = buffers;
+    morphDeltaBuffers_.Clear();
     morphRangeStarts_.Resize(buffers.Size());
     morphRangeCounts_.Resize(buffers.Size());
 
@@ -535,6 +1006,10 @@ bool Model::SetIndexBuffers(const Vector<SharedPtr<IndexBuffer> >& buffers)
         }
     }
 
+    // The buffers are no longer the ones of the model file
+    RequestShadowData();
+    shadowDataReloadable_ = false;
+
     indexBuffers_ = buffers;
     return true;
 }
@@ -612,10 +1087,15 @@ void Model::SetGeometryBoneMappings(const Vector<PODVector<unsigned> >& geometry
 void Model::SetMorphs(const Vector<ModelMorph>& morphs)
 {
     morphs_ = morphs;
+    morphDeltaBuffers_.Clear();
 }
 
 SharedPtr<Model> Model::Clone(const String& cloneName) const
 {
+    // Copy from the shadow data rather than read back the GPU buffers
+    if (shadowDataReleased_)
+        const_cast<Model*>(this)->RequestShadowData();
+
     SharedPtr<Model> ret(new Model(context_));
 
     ret->SetName(cloneName);
@@ -705,6 +1185,7 @@ SharedPtr<Model> Model::Clone(const String& cloneName) const
                 cloneGeometry->SetDrawRange(origGeometry->GetPrimitiveType(), origGeometry->GetIndexStart(),
                     origGeometry->GetIndexCount(), origGeometry->GetVertexStart(), origGeometry->GetVertexCount(), false);
                 cloneGeometry->SetLodDistance(origGeometry->GetLodDistance());
+                cloneGeometry->SetMeshlets(origGeometry->GetMeshlets());
             }
 
             ret->geometries_[i][j] = cloneGeometry;
@@ -733,6 +1214,51 @@ SharedPtr<Model> Model::Clone(const String& cloneName) const
     return ret;
 }
 
+bool Model::ReleaseShadowData()
+{
+    if (shadowDataReleased_)
+        return true;
+    if (!shadowDataReloadable_)
+        return false;
+
+    unsigned releasedSize = 0;
+    for (unsigned i = 0; i < vertexBuffers_.Size(); ++i)
+    {
+        VertexBuffer* buffer = vertexBuffers_[i];
+        releasedSize += buffer->GetVertexCount() * buffer->GetVertexSize();
+        buffer->SetShadowed(false);
+    }
+    for (unsigned i = 0; i < numFileIndexBuffers_ && i < indexBuffers_.Size(); ++i)
+    {
+        IndexBuffer* buffer = indexBuffers_[i];
+        releasedSize += buffer->GetIndexCount() * buffer->GetIndexSize();
+        buffer->SetShadowed(false);
+    }
+
+    shadowDataReleased_ = true;
+    SetMemoryUse(GetMemoryUse() - releasedSize);
+
+    // Without the shadow data the buffers can not restore themselves when the device is lost
+    SubscribeToEvent(E_DEVICERESET, URHO3D_HANDLER(Model, HandleDeviceReset));
+    return true;
+}
+
+bool Model::RequestShadowData()
+{
+    shadowDataRequested_ = true;
+
+    if (shadowDataReleased_)
+    {
+        URHO3D_PROFILE(ReloadModelShadowData);
+
+        if (!ReloadShadowData())
+            return false;
+        UnsubscribeFromEvent(E_DEVICERESET);
+    }
+
+    return true;
+}
+
 unsigned Model::GetNumGeometryLodLevels(unsigned index) const
 {
     return index < geometries_.Size() ? geometries_[index].Size() : 0;
@@ -780,4 +1306,211 @@ unsigned Model::GetMorphRangeCount(unsigned bufferIndex) const
     return bufferIndex < vertexBuffers_.Size() ? morphRangeCounts_[bufferIndex] : 0;
 }
 
+VertexBuffer* Model::GetMorphDeltaBuffer(unsigned bufferIndex)
+{
+    unsigned morphStart = GetMorphRangeStart(bufferIndex);
+    unsigned morphCount = GetMorphRangeCount(bufferIndex);
+    if (!morphCount)
+        return nullptr;
+
+    if (morphDeltaBuffers_.Size() != vertexBuffers_.Size())
+        morphDeltaBuffers_.Resize(vertexBuffers_.Size());
+    if (morphDeltaBuffers_[bufferIndex])
+        return morphDeltaBuffers_[bufferIndex];
+
+    unsigned numBlocks = 0;
+    for (unsigned i = 0; i < morphs_.Size(); ++i)
+    {
+        if (morphs_[i].buffers_.Contains(bufferIndex))
+            ++numBlocks;
+    }
+    if (!numBlocks)
+        return nullptr;
+
+    // Expand the sparse morph data to position, normal and tangent deltas for every vertex of the morph range
+    PODVector<Vector3> deltas(numBlocks * morphCount * 3);
+    for (unsigned i = 0; i < deltas.Size(); ++i)
+        deltas[i] = Vector3::ZERO;
+
+    unsigned block = 0;
+    for (unsigned i = 0; i < morphs_.Size(); ++i)
+    {
+        HashMap<unsigned, VertexBufferMorph>::ConstIterator j = morphs_[i].buffers_.Find(bufferIndex);
+        if (j == morphs_[i].buffers_.End())
+            continue;
+
+        const VertexBufferMorph& morph = j->second_;
+        const unsigned char* srcData = morph.morphData_.Get();
+        for (unsigned k = 0; k < morph.vertexCount_; ++k)
+        {
+            unsigned vertexIndex = *((const unsigned*)srcData) - morphStart;
+            srcData += sizeof(unsigned);
+
+            Vector3 vertexDeltas[3];
+            if (morph.elementMask_ & MASK_POSITION)
+            {
+                vertexDeltas[0] = *((const Vector3*)srcData);
+                srcData += sizeof(Vector3);
+            }
+            if (morph.elementMask_ & MASK_NORMAL)
+            {
+                vertexDeltas[1] = *((const Vector3*)srcData);
+                srcData += sizeof(Vector3);
+            }
+            if (morph.elementMask_ & MASK_TANGENT)
+            {
+                vertexDeltas[2] = *((const Vector3*)srcData);
+                srcData += sizeof(Vector3);
+            }
+
+            if (vertexIndex < morphCount)
+            {
+                Vector3* dest = &deltas[(block * morphCount + vertexIndex) * 3];
+                dest[0] = vertexDeltas[0];
+                dest[1] = vertexDeltas[1];
+                dest[2] = vertexDeltas[2];
+            }
+        }
+
+        ++block;
+    }
+
+    PODVector<VertexElement> elements;
+    elements.Push(VertexElement(TYPE_VECTOR3, SEM_POSITION));
+    elements.Push(VertexElement(TYPE_VECTOR3, SEM_NORMAL));
+    elements.Push(VertexElement(TYPE_VECTOR3, SEM_TANGENT));
+
+    SharedPtr<VertexBuffer> buffer(new VertexBuffer(context_));
+    buffer->SetComputeAccess(true);
+    if (!buffer->SetSize(numBlocks * morphCount, elements) || !buffer->SetData(&deltas[0]))
+    {
+        URHO3D_LOGERROR("Failed to create morph delta buffer for model " + GetName());
+        return nullptr;
+    }
+
+    morphDeltaBuffers_[bufferIndex] = buffer;
+    return buffer;
+}
+
+bool Model::ReloadShadowData()
+{
+    SharedPtr<File> file = GetSubsystem<ResourceCache>()->GetFile(GetName(), false);
+    if (!file)
+    {
+        URHO3D_LOGERROR("Could not open " + GetName() + " to reload the model shadow data");
+        return false;
+    }
+
+    String fileID = file->ReadFileID();
+    if (fileID != "UMDL" && fileID != "UMD2")
+    {
+        URHO3D_LOGERROR(GetName() + " is not a valid model file");
+        return false;
+    }
+    bool hasVertexDeclarations = (fileID == "UMD2");
+
+    // Read all the data before touching the buffers, so that a model file changed since loading leaves them as they were
+    Vector<SharedArrayPtr<unsigned char> > vertexData;
+    Vector<SharedArrayPtr<unsigned char> > indexData;
+    bool matches = file->ReadUInt() == vertexBuffers_.Size();
+    for (unsigned i = 0; i < vertexBuffers_.Size() && matches; ++i)
+    {
+        VertexBuffer* buffer = vertexBuffers_[i];
+        unsigned vertexCount = file->ReadUInt();
+        unsigned vertexSize = VertexBuffer::GetVertexSize(ReadVertexElements(*file, hasVertexDeclarations));
+        file->ReadUInt(); // Morph range start
+        file->ReadUInt(); // Morph range count
+        unsigned dataSize = vertexCount * vertexSize;
+
+        matches = vertexCount == buffer->GetVertexCount() && vertexSize == buffer->GetVertexSize();
+        if (matches)
+        {
+            vertexData.Push(SharedArrayPtr<unsigned char>(new unsigned char[dataSize]));
+            matches = file->Read(vertexData.Back().Get(), dataSize) == dataSize;
+        }
+    }
+
+    matches = matches && file->ReadUInt() == numFileIndexBuffers_;
+    for (unsigned i = 0; i < numFileIndexBuffers_ && matches; ++i)
+    {
+        IndexBuffer* buffer = indexBuffers_[i];
+        unsigned indexCount = file->ReadUInt();
+        unsigned indexSize = file->ReadUInt();
+        unsigned dataSize = indexCount * indexSize;
+
+        matches = indexCount == buffer->GetIndexCount() && indexSize == buffer->GetIndexSize();
+        if (matches)
+        {
+            indexData.Push(SharedArrayPtr<unsigned char>(new unsigned char[dataSize]));
+            matches = file->Read(indexData.Back().Get(), dataSize) == dataSize;
+        }
+    }
+
+    if (!matches)
+    {
+        URHO3D_LOGERROR("Model file " + GetName() + " has changed since loading, could not reload the shadow data");
+        return false;
+    }
+
+    unsigned reloadedSize = 0;
+    for (unsigned i = 0; i < vertexBuffers_.Size(); ++i)
+    {
+        VertexBuffer* buffer = vertexBuffers_[i];
+        unsigned dataSize = buffer->GetVertexCount() * buffer->GetVertexSize();
+        buffer->SetShadowed(true);
+        if (dataSize)
+            memcpy(buffer->GetShadowData(), vertexData[i].Get(), dataSize);
+        reloadedSize += dataSize;
+    }
+    for (unsigned i = 0; i < numFileIndexBuffers_; ++i)
+    {
+        IndexBuffer* buffer = indexBuffers_[i];
+        unsigned dataSize = buffer->GetIndexCount() * buffer->GetIndexSize();
+        buffer->SetShadowed(true);
+        if (dataSize)
+            memcpy(buffer->GetShadowData(), indexData[i].Get(), dataSize);
+        reloadedSize += dataSize;
+    }
+
+    shadowDataReleased_ = false;
+    SetMemoryUse(GetMemoryUse() + reloadedSize);
+    return true;
+}
+
+void Model::HandleDeviceReset(StringHash eventType, VariantMap& eventData)
+{
+    if (!shadowDataReleased_)
+        return;
+
+    bool dataLost = false;
+    for (unsigned i = 0; i < vertexBuffers_.Size(); ++i)
+        dataLost |= vertexBuffers_[i]->IsDataLost();
+    for (unsigned i = 0; i < numFileIndexBuffers_; ++i)
+        dataLost |= indexBuffers_[i]->IsDataLost();
+    if (!dataLost || !ReloadShadowData())
+        return;
+
+    // Upload the reloaded data, then release it again
+    for (unsigned i = 0; i < vertexBuffers_.Size(); ++i)
+    {
+        VertexBuffer* buffer = vertexBuffers_[i];
+        if (buffer->IsDataLost() && buffer->GetShadowData())
+        {
+            buffer->SetData(buffer->GetShadowData());
+            buffer->ClearDataLost();
+        }
+    }
+    for (unsigned i = 0; i < numFileIndexBuffers_; ++i)
+    {
+        IndexBuffer* buffer = indexBuffers_[i];
+        if (buffer->IsDataLost() && buffer->GetShadowData())
+        {
+            buffer->SetData(buffer->GetShadowData());
+            buffer->ClearDataLost();
+        }
+    }
+
+    ReleaseShadowData();
+}
+
 }
@@ -152,6 +152,10 @@ public:
     void SetMorphs(const Vector<ModelMorph>& morphs);
     /// Clone the model. The geometry data is deep-copied and can be modified in the clone without affecting the original.
     SharedPtr<Model> Clone(const String& cloneName = String::EMPTY) const;
+    /// Release the CPU shadow copies of the vertex and index data loaded from the model file, so that only the GPU copies remain. Only possible for models loaded from a file with the Graphics subsystem, that have no morphs or generated meshlets. Return true if the shadow data is released.
+    bool ReleaseShadowData();
+    /// Make the CPU shadow copies of the vertex and index data available and keep them from now on, reloading them from the model file if they were released. Called by the consumers that read the geometry data, such as physics, navigation, occlusion and triangle raycasts. Must be called from the main thread. Return true if successful.
+    bool RequestShadowData();
 
     /// Return bounding box.
     /// @property
@@ -211,8 +215,25 @@ public:
     unsigned GetMorphRangeStart(unsigned bufferIndex) const;
     /// Return vertex buffer morph range vertex count.
     unsigned GetMorphRangeCount(unsigned bufferIndex) const;
+    /// Return whether the CPU shadow copies of the vertex and index data are released.
+    /// @property
+    bool IsShadowDataReleased() const { return shadowDataReleased_; }
+    /// Return a buffer with the morph deltas of a vertex buffer for compute morphing, creating it on first use. Holds position, normal and tangent deltas for each morph range vertex, in one block per morph that affects the vertex buffer, in morph order. Return null if no morphs affect the vertex buffer.
+    VertexBuffer* GetMorphDeltaBuffer(unsigned bufferIndex);
 
 private:
+    /// Generate simplified LOD levels for the triangle geometries that have a single LOD level during BeginLoad(), or load them from the cache file next to the model if it is up to date. Return the memory use of the added LOD levels.
+    unsigned GenerateLodLevels(unsigned numLevels, float ratio, float distance, float maxError);
+    /// Reorder the triangle geometries' indices into meshlets and store the meshlet bounds into the geometries during BeginLoad(). Return the memory use of the meshlets.
+    unsigned BuildLoadMeshlets();
+    /// Read the triangles of a geometry during BeginLoad() with a compacted vertex numbering. Return false if the data is not available or is invalid.
+    bool GetLoadTriangles(const GeometryDesc& desc, PODVector<unsigned>& vertices, PODVector<Vector3>& positions,
+        PODVector<unsigned>& indices) const;
+    /// Read back the released shadow data from the model file. Return true if successful.
+    bool ReloadShadowData();
+    /// Handle device reset to restore the GPU copies of the released shadow data.
+    void HandleDeviceReset(StringHash eventType, VariantMap& eventData);
+
     /// Bounding box.
     BoundingBox boundingBox_;
     /// Skeleton.
@@ -233,12 +254,24 @@ private:
     PODVector<unsigned> morphRangeStarts_;
     /// Vertex buffer morph range vertex count.
     PODVector<unsigned> morphRangeCounts_;
+    /// Compute morph delta buffers.
+    Vector<SharedPtr<VertexBuffer> > morphDeltaBuffers_;
     /// Vertex buffer data for asynchronous loading.
     Vector<VertexBufferDesc> loadVBData_;
     /// Index buffer data for asynchronous loading.
     Vector<IndexBufferDesc> loadIBData_;
     /// Geometry definitions for asynchronous loading.
     Vector<PODVector<GeometryDesc> > loadGeometries_;
+    /// Number of index buffers read from the model file. The generated LOD level index buffers follow them.
+    unsigned numFileIndexBuffers_{};
+    /// Whether the shadow data can be reloaded from the model file as is.
+    bool shadowDataReloadable_{};
+    /// Release shadow data after the upload flag, resolved during BeginLoad().
+    bool releaseShadowDataOnLoad_{};
+    /// Shadow data released flag.
+    bool shadowDataReleased_{};
+    /// Shadow data requested by a consumer flag. Prevents releasing it again.
+    bool shadowDataRequested_{};
 };
 
 }
@@ -28,6 +28,10 @@
 #include "../Graphics/OcclusionBuffer.h"
 #include "../IO/Log.h"
 
+#ifdef URHO3D_SSE
+#include <emmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -44,6 +48,44 @@ enum ClipMask : unsigned
 };
 URHO3D_FLAGSET(ClipMask, ClipMaskFlags);
 
+#ifdef URHO3D_SSE
+/// Return per-lane minimum of signed integers. SSE2 lacks a direct instruction for this.
+static inline __m128i MinInt4(__m128i a, __m128i b)
+{
+    __m128i less = _mm_cmplt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(less, a), _mm_andnot_si128(less, b));
+}
+#endif
+
+/// Rasterize a horizontal span of depth values, keeping the closest depth per pixel.
+static inline void DrawSpan(int* dest, int* end, int invZ, int dInvZdX)
+{
+#ifdef URHO3D_SSE
+    // Process 4 pixels at a time. Integer wraparound matches the scalar loop's accumulation exactly
+    if (end - dest >= 4)
+    {
+        __m128i depth = _mm_add_epi32(_mm_set1_epi32(invZ), _mm_set_epi32(dInvZdX * 3, dInvZdX * 2, dInvZdX, 0));
+        const __m128i step = _mm_set1_epi32(dInvZdX * 4);
+        while (end - dest >= 4)
+        {
+            __m128i old = _mm_loadu_si128((const __m128i*)dest);
+            _mm_storeu_si128((__m128i*)dest, MinInt4(depth, old));
+            depth = _mm_add_epi32(depth, step);
+            dest += 4;
+        }
+        invZ = _mm_cvtsi128_si32(depth);
+    }
+#endif
+
+    while (dest < end)
+    {
+        if (invZ < *dest)
+            *dest = invZ;
+        invZ += dInvZdX;
+        ++dest;
+    }
+}
+
 void DrawOcclusionBatchWork(const WorkItem* item, unsigned threadIndex)
 {
     auto* buffer = reinterpret_cast<OcclusionBuffer*>(item->aux_);
@@ -231,6 +273,24 @@ void OcclusionBuffer::DrawTriangles()
     batches_.Clear();
 }
 
+void OcclusionBuffer::SetDepthData(const float* data)
+{
+    if (buffers_.Empty() || !data)
+        return;
+
+    int* dest = buffers_[0].data_;
+    int count = width_ * height_;
+
+    while (count--)
+        *dest++ = (int)(Clamp(*data++, 0.0f, 1.0f) * OCCLUSION_Z_SCALE);
+
+    for (unsigned i = 1; i < buffers_.Size(); ++i)
+        buffers_[i].used_ = false;
+
+    depthHierarchyDirty_ = true;
+    BuildDepthHierarchy();
+}
+
 void OcclusionBuffer::BuildDepthHierarchy()
 {
     if (buffers_.Empty() || !depthHierarchyDirty_)
@@ -420,6 +480,20 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
             {
                 DepthValue* src = row + left;
                 DepthValue* end = row + right;
+#ifdef URHO3D_SSE
+                // Test 2 depth values (min & max interleaved) at a time. Mask bits are set where z <= value
+                const __m128i depth = _mm_set1_epi32(z);
+                while (src < end)
+                {
+                    __m128i values = _mm_loadu_si128((const __m128i*)src);
+                    int mask = ~_mm_movemask_epi8(_mm_cmpgt_epi32(depth, values)) & 0xffff;
+                    if (mask & 0x0f0f)
+                        return true;
+                    if (mask & 0xf0f0)
+                        allOccluded = false;
+                    src += 2;
+                }
+#endif
                 while (src <= end)
                 {
                     if (z <= src->min_)
@@ -439,10 +513,23 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
     // If no conclusive result, finally check the pixel-level data
     int* row = buffers_[0].data_ + rect.top_ * width_;
     int* endRow = buffers_[0].data_ + rect.bottom_ * width_;
+#ifdef URHO3D_SSE
+    const __m128i depth = _mm_set1_epi32(z);
+#endif
     while (row <= endRow)
     {
         int* src = row + rect.left_;
         int* end = row + rect.right_;
+#ifdef URHO3D_SSE
+        // Test 4 pixels at a time
+        while (end - src >= 3)
+        {
+            __m128i values = _mm_loadu_si128((const __m128i*)src);
+            if (_mm_movemask_epi8(_mm_cmpgt_epi32(depth, values)) != 0xffff)
+                return true;
+            src += 4;
+        }
+#endif
         while (src <= end)
         {
             if (z <= *src)
@@ -901,16 +988,7 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
             int* endRow = bufferData + middleY * width_;
             while (row < endRow)
             {
-                int invZ = topToBottom.invZ_;
-                int* dest = row + (topToBottom.x_ >> 16u);
-                int* end = row + (topToMiddle.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
+                DrawSpan(row + (topToBottom.x_ >> 16u), row + (topToMiddle.x_ >> 16u), topToBottom.invZ_, gradients.dInvZdXInt_);
 
                 topToBottom.x_ += topToBottom.xStep_;
                 topToBottom.invZ_ += topToBottom.invZStep_;
@@ -927,16 +1005,7 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
             int* endRow = bufferData + bottomY * width_;
             while (row < endRow)
             {
-                int invZ = topToBottom.invZ_;
-                int* dest = row + (topToBottom.x_ >> 16u);
-                int* end = row + (middleToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
+                DrawSpan(row + (topToBottom.x_ >> 16u), row + (middleToBottom.x_ >> 16u), topToBottom.invZ_, gradients.dInvZdXInt_);
 
                 topToBottom.x_ += topToBottom.xStep_;
                 topToBottom.invZ_ += topToBottom.invZStep_;
@@ -955,16 +1024,7 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
             int* endRow = bufferData + middleY * width_;
             while (row < endRow)
             {
-                int invZ = topToMiddle.invZ_;
-                int* dest = row + (topToMiddle.x_ >> 16u);
-                int* end = row + (topToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
+                DrawSpan(row + (topToMiddle.x_ >> 16u), row + (topToBottom.x_ >> 16u), topToMiddle.invZ_, gradients.dInvZdXInt_);
 
                 topToMiddle.x_ += topToMiddle.xStep_;
                 topToMiddle.invZ_ += topToMiddle.invZStep_;
@@ -981,16 +1041,7 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
             int* endRow = bufferData + bottomY * width_;
             while (row < endRow)
             {
-                int invZ = middleToBottom.invZ_;
-                int* dest = row + (middleToBottom.x_ >> 16u);
-                int* end = row + (topToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
+                DrawSpan(row + (middleToBottom.x_ >> 16u), row + (topToBottom.x_ >> 16u), middleToBottom.invZ_, gradients.dInvZdXInt_);
 
                 middleToBottom.x_ += middleToBottom.xStep_;
                 middleToBottom.invZ_ += middleToBottom.invZStep_;
@@ -1014,6 +1065,17 @@ void OcclusionBuffer::MergeBuffers()
         int* dest = buffers_[0].data_;
         int count = width_ * height_;
 
+#ifdef URHO3D_SSE
+        for (; count >= 4; count -= 4)
+        {
+            __m128i threadValues = _mm_loadu_si128((const __m128i*)src);
+            __m128i values = _mm_loadu_si128((const __m128i*)dest);
+            _mm_storeu_si128((__m128i*)dest, MinInt4(threadValues, values));
+            src += 4;
+            dest += 4;
+        }
+#endif
+
         while (count--)
         {
             // If thread buffer's depth value is closer, overwrite the original
@@ -117,6 +117,8 @@ public:
         unsigned indexStart, unsigned indexCount);
     /// Draw submitted batches. Uses worker threads if enabled during SetSize().
     void DrawTriangles();
+    /// Set the buffer contents from hardware depth values (0-1) in rows from top to bottom, for example read back from the GPU. The data must match the buffer size. Builds the depth hierarchy.
+    void SetDepthData(const float* data);
     /// Build reduced size mip levels.
     void BuildDepthHierarchy();
     /// Reset last used timer.
@@ -24,6 +24,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
+#include "../Core/Metrics.h"
 #include "../Core/Profiler.h"
 #include "../Core/Thread.h"
 #include "../Core/WorkQueue.h"
@@ -34,6 +35,10 @@
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
 
+#ifdef URHO3D_SSE
+#include <emmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 #ifdef _MSC_VER
@@ -45,6 +50,16 @@ namespace Urho3D
 
 static const float DEFAULT_OCTREE_SIZE = 1000.0f;
 static const int DEFAULT_OCTREE_LEVELS = 8;
+/// Number of drawables tested against a frustum before passing the ones inside to the query.
+static const unsigned DRAWABLE_TEST_BATCH_SIZE = 64;
+/// Minimum number of drawables per work item for preparing reinsertions in worker threads.
+static const int MIN_REINSERTIONS_PER_WORK_ITEM = 64;
+/// Minimum number of drawables per work item for the drawable updates.
+static const unsigned MIN_DRAWABLES_PER_ITEM = 16;
+/// Maximum octree levels for which insertion branches are prepared in worker threads. Each level takes three bits.
+static const unsigned MAX_THREADED_REINSERTION_LEVELS = 18;
+/// Reinsertion value for drawables that are inserted recursively on the main thread.
+static const unsigned long long INSERT_RECURSIVELY = 0xffffffffffffffffULL;
 
 extern const char* SUBSYSTEM_CATEGORY;
 
@@ -63,11 +78,125 @@ void UpdateDrawablesWork(const WorkItem* item, unsigned threadIndex)
     }
 }
 
+void ReinsertDrawablesWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* octree = reinterpret_cast<Octree*>(item->aux_);
+    auto** start = reinterpret_cast<Drawable**>(item->start_);
+    auto** end = reinterpret_cast<Drawable**>(item->end_);
+    Drawable** first = &octree->drawableUpdates_.Front();
+
+    octree->PrepareReinsertions((unsigned)(start - first), (unsigned)(end - first));
+}
+
+/// Return whether a box fits an octant of the given bounds and subdivision level.
+static inline bool CheckOctantFit(const BoundingBox& octantBox, const Vector3& halfSize, unsigned level, unsigned numLevels,
+    const BoundingBox& box)
+{
+    Vector3 boxSize = box.Size();
+
+    // If max split level, size always OK, otherwise check that box is at least half size of octant
+    if (level >= numLevels || boxSize.x_ >= halfSize.x_ || boxSize.y_ >= halfSize.y_ || boxSize.z_ >= halfSize.z_)
+        return true;
+    // Also check if the box can not fit a child octant's culling box, in that case size OK (must insert here)
+    else
+    {
+        if (box.min_.x_ <= octantBox.min_.x_ - 0.5f * halfSize.x_ ||
+            box.max_.x_ >= octantBox.max_.x_ + 0.5f * halfSize.x_ ||
+            box.min_.y_ <= octantBox.min_.y_ - 0.5f * halfSize.y_ ||
+            box.max_.y_ >= octantBox.max_.y_ + 0.5f * halfSize.y_ ||
+            box.min_.z_ <= octantBox.min_.z_ - 0.5f * halfSize.z_ ||
+            box.max_.z_ >= octantBox.max_.z_ + 0.5f * halfSize.z_)
+            return true;
+    }
+
+    // Bounding box too small, should create a child octant
+    return false;
+}
+
+/// Return the bounds of a child octant by index.
+static inline BoundingBox GetChildOctantBox(const BoundingBox& octantBox, unsigned index)
+{
+    Vector3 newMin = octantBox.min_;
+    Vector3 newMax = octantBox.max_;
+    Vector3 oldCenter = octantBox.Center();
+
+    if (index & 1u)
+        newMin.x_ = oldCenter.x_;
+    else
+        newMax.x_ = oldCenter.x_;
+
+    if (index & 2u)
+        newMin.y_ = oldCenter.y_;
+    else
+        newMax.y_ = oldCenter.y_;
+
+    if (index & 4u)
+        newMin.z_ = oldCenter.z_;
+    else
+        newMax.z_ = oldCenter.z_;
+
+    return BoundingBox(newMin, newMax);
+}
+
 inline bool CompareRayQueryResults(const RayQueryResult& lhs, const RayQueryResult& rhs)
 {
     return lhs.distance_ < rhs.distance_;
 }
 
+void OctantDrawableData::Push(const BoundingBox& box, unsigned viewMask, unsigned char flags)
+{
+    // Store center and half size the same way as Frustum::IsInsideFast() calculates them
+    Vector3 center = box.Center();
+    Vector3 edge = center - box.min_;
+    centerX_.Push(center.x_);
+    centerY_.Push(center.y_);
+    centerZ_.Push(center.z_);
+    edgeX_.Push(edge.x_);
+    edgeY_.Push(edge.y_);
+    edgeZ_.Push(edge.z_);
+    viewMasks_.Push(viewMask);
+    flags_.Push(flags);
+}
+
+void OctantDrawableData::SetBoundingBox(unsigned index, const BoundingBox& box)
+{
+    Vector3 center = box.Center();
+    Vector3 edge = center - box.min_;
+    centerX_[index] = center.x_;
+    centerY_[index] = center.y_;
+    centerZ_[index] = center.z_;
+    edgeX_[index] = edge.x_;
+    edgeY_[index] = edge.y_;
+    edgeZ_[index] = edge.z_;
+}
+
+void OctantDrawableData::EraseSwap(unsigned index)
+{
+    centerX_.EraseSwap(index);
+    centerY_.EraseSwap(index);
+    centerZ_.EraseSwap(index);
+    edgeX_.EraseSwap(index);
+    edgeY_.EraseSwap(index);
+    edgeZ_.EraseSwap(index);
+    viewMasks_.EraseSwap(index);
+    flags_.EraseSwap(index);
+}
+
+/// Return whether a bounding box given as center and half size is not outside a frustum.
+static inline bool IsInsideFrustum(const Frustum& frustum, float centerX, float centerY, float centerZ, float edgeX,
+    float edgeY, float edgeZ)
+{
+    for (const auto& plane : frustum.planes_)
+    {
+        float dist = plane.normal_.x_ * centerX + plane.normal_.y_ * centerY + plane.normal_.z_ * centerZ + plane.d_;
+        float absDist = plane.absNormal_.x_ * edgeX + plane.absNormal_.y_ * edgeY + plane.absNormal_.z_ * edgeZ;
+        if (dist < -absDist)
+            return false;
+    }
+
+    return true;
+}
+
 Octant::Octant(const BoundingBox& box, unsigned level, Octant* parent, Octree* root, unsigned index) :
     level_(level),
     parent_(parent),
@@ -84,8 +213,7 @@ Octant::~Octant()
         // Remove the drawables (if any) from this octant to the root octant
         for (PODVector<Drawable*>::Iterator i = drawables_.Begin(); i != drawables_.End(); ++i)
         {
-            (*i)->SetOctant(root_);
-            root_->drawables_.Push(*i);
+            root_->PushDrawable(*i);
             root_->QueueUpdate(*i);
         }
         drawables_.Clear();
@@ -101,26 +229,7 @@ Octant* Octant::GetOrCreateChild(unsigned index)
     if (children_[index])
         return children_[index];
 
-    Vector3 newMin = worldBoundingBox_.min_;
-    Vector3 newMax = worldBoundingBox_.max_;
-    Vector3 oldCenter = worldBoundingBox_.Center();
-
-    if (index & 1u)
-        newMin.x_ = oldCenter.x_;
-    else
-        newMax.x_ = oldCenter.x_;
-
-    if (index & 2u)
-        newMin.y_ = oldCenter.y_;
-    else
-        newMax.y_ = oldCenter.y_;
-
-    if (index & 4u)
-        newMin.z_ = oldCenter.z_;
-    else
-        newMax.z_ = oldCenter.z_;
-
-    children_[index] = new Octant(BoundingBox(newMin, newMax), level_ + 1, this, root_, index);
+    children_[index] = new Octant(GetChildOctantBox(worldBoundingBox_, index), level_ + 1, this, root_, index);
     return children_[index];
 }
 
@@ -144,16 +253,7 @@ void Octant::InsertDrawable(Drawable* drawable)
         insertHere = CheckDrawableFit(box);
 
     if (insertHere)
-    {
-        Octant* oldOctant = drawable->octant_;
-        if (oldOctant != this)
-        {
-            // Add first, then remove, because drawable count going to zero deletes the octree branch in question
-            AddDrawable(drawable);
-            if (oldOctant)
-                oldOctant->RemoveDrawable(drawable, false);
-        }
-    }
+        LinkDrawable(drawable, box);
     else
     {
         Vector3 boxCenter = box.Center();
@@ -167,26 +267,58 @@ void Octant::InsertDrawable(Drawable* drawable)
 
 bool Octant::CheckDrawableFit(const BoundingBox& box) const
 {
-    Vector3 boxSize = box.Size();
+    return CheckOctantFit(worldBoundingBox_, halfSize_, level_, root_->GetNumLevels(), box);
+}
 
-    // If max split level, size always OK, otherwise check that box is at least half size of octant
-    if (level_ >= root_->GetNumLevels() || boxSize.x_ >= halfSize_.x_ || boxSize.y_ >= halfSize_.y_ ||
-        boxSize.z_ >= halfSize_.z_)
-        return true;
-    // Also check if the box can not fit a child octant's culling box, in that case size OK (must insert here)
-    else
+void Octant::LinkDrawable(Drawable* drawable, const BoundingBox& box)
+{
+    Octant* oldOctant = drawable->octant_;
+    if (oldOctant != this)
     {
-        if (box.min_.x_ <= worldBoundingBox_.min_.x_ - 0.5f * halfSize_.x_ ||
-            box.max_.x_ >= worldBoundingBox_.max_.x_ + 0.5f * halfSize_.x_ ||
-            box.min_.y_ <= worldBoundingBox_.min_.y_ - 0.5f * halfSize_.y_ ||
-            box.max_.y_ >= worldBoundingBox_.max_.y_ + 0.5f * halfSize_.y_ ||
-            box.min_.z_ <= worldBoundingBox_.min_.z_ - 0.5f * halfSize_.z_ ||
-            box.max_.z_ >= worldBoundingBox_.max_.z_ + 0.5f * halfSize_.z_)
-            return true;
+        // Remove from the old octant's drawables first, as that uses the drawable's index within them. Decrease its
+        // count only after adding, because drawable count going to zero deletes the octree branch in question
+        if (oldOctant)
+            oldOctant->EraseDrawable(drawable);
+        AddDrawable(drawable);
+        if (oldOctant)
+            oldOctant->DecDrawableCount();
     }
+    else
+        UpdateDrawableBounds(drawable, box);
+}
 
-    // Bounding box too small, should create a child octant
-    return false;
+void Octant::UpdateDrawableBounds(Drawable* drawable, const BoundingBox& box)
+{
+    assert(drawable->octant_ == this && drawables_[drawable->octantIndex_] == drawable);
+    drawableData_.SetBoundingBox(drawable->octantIndex_, box);
+}
+
+void Octant::UpdateDrawableViewMask(Drawable* drawable)
+{
+    assert(drawable->octant_ == this && drawables_[drawable->octantIndex_] == drawable);
+    drawableData_.viewMasks_[drawable->octantIndex_] = drawable->GetViewMask();
+}
+
+void Octant::PushDrawable(Drawable* drawable)
+{
+    drawable->SetOctant(this);
+    drawable->octantIndex_ = drawables_.Size();
+    drawables_.Push(drawable);
+    drawableData_.Push(drawable->GetWorldBoundingBox(), drawable->GetViewMask(), drawable->GetDrawableFlags());
+}
+
+bool Octant::EraseDrawable(Drawable* drawable)
+{
+    unsigned index = drawable->octantIndex_;
+    if (index >= drawables_.Size() || drawables_[index] != drawable)
+        return false;
+
+    // Move the last drawable in place of the removed one so that the indices of the others stay valid
+    drawables_.EraseSwap(index);
+    drawableData_.EraseSwap(index);
+    if (index < drawables_.Size())
+        drawables_[index]->octantIndex_ = index;
+    return true;
 }
 
 void Octant::ResetRoot()
@@ -242,9 +374,15 @@ void Octant::GetDrawablesInternal(OctreeQuery& query, bool inside) const
 
     if (drawables_.Size())
     {
-        auto** start = const_cast<Drawable**>(&drawables_[0]);
-        Drawable** end = start + drawables_.Size();
-        query.TestDrawables(start, end, inside);
+        const Frustum* frustum = query.GetDrawableFrustum();
+        if (frustum)
+            TestDrawablesInternal(query, *frustum, inside);
+        else
+        {
+            auto** start = const_cast<Drawable**>(&drawables_[0]);
+            Drawable** end = start + drawables_.Size();
+            query.TestDrawables(start, end, inside);
+        }
     }
 
     for (auto child : children_)
@@ -254,6 +392,90 @@ void Octant::GetDrawablesInternal(OctreeQuery& query, bool inside) const
     }
 }
 
+void Octant::TestDrawablesInternal(OctreeQuery& query, const Frustum& frustum, bool inside) const
+{
+    const unsigned numDrawables = drawables_.Size();
+    const unsigned char drawableFlags = query.drawableFlags_;
+    const unsigned viewMask = query.viewMask_;
+    const unsigned* viewMasks = &drawableData_.viewMasks_[0];
+    const unsigned char* flags = &drawableData_.flags_[0];
+    const float* centerX = &drawableData_.centerX_[0];
+    const float* centerY = &drawableData_.centerY_[0];
+    const float* centerZ = &drawableData_.centerZ_[0];
+    const float* edgeX = &drawableData_.edgeX_[0];
+    const float* edgeY = &drawableData_.edgeY_[0];
+    const float* edgeZ = &drawableData_.edgeZ_[0];
+
+#ifdef URHO3D_SSE
+    // Broadcast the frustum planes for testing four drawables at a time
+    __m128 normalX[NUM_FRUSTUM_PLANES], normalY[NUM_FRUSTUM_PLANES], normalZ[NUM_FRUSTUM_PLANES], planeD[NUM_FRUSTUM_PLANES];
+    __m128 absNormalX[NUM_FRUSTUM_PLANES], absNormalY[NUM_FRUSTUM_PLANES], absNormalZ[NUM_FRUSTUM_PLANES];
+    for (unsigned i = 0; i < NUM_FRUSTUM_PLANES; ++i)
+    {
+        const Plane& plane = frustum.planes_[i];
+        normalX[i] = _mm_set1_ps(plane.normal_.x_);
+        normalY[i] = _mm_set1_ps(plane.normal_.y_);
+        normalZ[i] = _mm_set1_ps(plane.normal_.z_);
+        planeD[i] = _mm_set1_ps(plane.d_);
+        absNormalX[i] = _mm_set1_ps(plane.absNormal_.x_);
+        absNormalY[i] = _mm_set1_ps(plane.absNormal_.y_);
+        absNormalZ[i] = _mm_set1_ps(plane.absNormal_.z_);
+    }
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+#endif
+
+    // Collect the drawables that pass into a small batch, so that only they are dereferenced by the query
+    Drawable* passed[DRAWABLE_TEST_BATCH_SIZE];
+    unsigned i = 0;
+    while (i < numDrawables)
+    {
+        unsigned batchEnd = Min(i + DRAWABLE_TEST_BATCH_SIZE, numDrawables);
+        unsigned numPassed = 0;
+
+#ifdef URHO3D_SSE
+        for (; i + 4 <= batchEnd; i += 4)
+        {
+            int insideMask = 0xf;
+            if (!inside)
+            {
+                const __m128 cx = _mm_loadu_ps(centerX + i);
+                const __m128 cy = _mm_loadu_ps(centerY + i);
+                const __m128 cz = _mm_loadu_ps(centerZ + i);
+                const __m128 ex = _mm_loadu_ps(edgeX + i);
+                const __m128 ey = _mm_loadu_ps(edgeY + i);
+                const __m128 ez = _mm_loadu_ps(edgeZ + i);
+                __m128 outside = _mm_setzero_ps();
+                for (unsigned j = 0; j < NUM_FRUSTUM_PLANES; ++j)
+                {
+                    __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX[j], cx), _mm_mul_ps(normalY[j], cy)),
+                        _mm_mul_ps(normalZ[j], cz)), planeD[j]);
+                    __m128 absDist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absNormalX[j], ex), _mm_mul_ps(absNormalY[j], ey)),
+                        _mm_mul_ps(absNormalZ[j], ez));
+                    outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_xor_ps(absDist, signMask)));
+                }
+                insideMask = ~_mm_movemask_ps(outside) & 0xf;
+            }
+
+            for (unsigned j = 0; j < 4; ++j)
+            {
+                if ((insideMask & (1 << j)) && (flags[i + j] & drawableFlags) && (viewMasks[i + j] & viewMask))
+                    passed[numPassed++] = drawables_[i + j];
+            }
+        }
+#endif
+
+        for (; i < batchEnd; ++i)
+        {
+            if ((flags[i] & drawableFlags) && (viewMasks[i] & viewMask) && (inside ||
+                IsInsideFrustum(frustum, centerX[i], centerY[i], centerZ[i], edgeX[i], edgeY[i], edgeZ[i])))
+                passed[numPassed++] = drawables_[i];
+        }
+
+        if (numPassed)
+            query.TestDrawables(passed, passed + numPassed, true);
+    }
+}
+
 void Octant::GetDrawablesInternal(RayOctreeQuery& query) const
 {
     float octantDist = query.ray_.HitDistance(cullingBox_);
@@ -313,6 +535,14 @@ Octree::Octree(Context* context) :
     Octant(BoundingBox(-DEFAULT_OCTREE_SIZE, DEFAULT_OCTREE_SIZE), 0, nullptr, this),
     numLevels_(DEFAULT_OCTREE_LEVELS)
 {
+    auto* metrics = GetSubsystem<Metrics>();
+    if (metrics)
+    {
+        queriesMetric_ = metrics->GetCounter("Octree", "queries_total", "Octree drawable queries.");
+        raycastsMetric_ = metrics->GetCounter("Octree", "raycasts_total", "Octree raycasts.");
+        updatesMetric_ = metrics->GetCounter("Octree", "drawable_updates_total", "Drawables updated and reinserted by the octree.");
+    }
+
     // If the engine is running headless, subscribe to RenderUpdate events for manually updating the octree
     // to allow raycasts and animation update
     if (!GetSubsystem<Graphics>())
@@ -369,41 +599,27 @@ void Octree::Update(const FrameInfo& frame)
         return;
     }
 
+    // Bring the node world transforms up to date level by level if the scene uses the threaded transform update,
+    // so that drawables do not need to walk dirty parent chains in the worker threads below
+    if (GetScene())
+        GetScene()->UpdateWorldTransforms();
+
     // Let drawables update themselves before reinsertion. This can be used for animation
     if (!drawableUpdates_.Empty())
     {
         URHO3D_PROFILE(UpdateDrawables);
 
+        if (updatesMetric_)
+            updatesMetric_->Increment(drawableUpdates_.Size());
+
         // Perform updates in worker threads. Notify the scene that a threaded update is going on and components
         // (for example physics objects) should not perform non-threadsafe work when marked dirty
         Scene* scene = GetScene();
         auto* queue = GetSubsystem<WorkQueue>();
         scene->BeginThreadedUpdate();
 
-        int numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
-        int drawablesPerItem = Max((int)(drawableUpdates_.Size() / numWorkItems), 1);
-
-        PODVector<Drawable*>::Iterator start = drawableUpdates_.Begin();
-        // Create a work item for each thread
-        for (int i = 0; i < numWorkItems; ++i)
-        {
-            SharedPtr<WorkItem> item = queue->GetFreeItem();
-            item->priority_ = M_MAX_UNSIGNED;
-            item->workFunction_ = UpdateDrawablesWork;
-            item->aux_ = const_cast<FrameInfo*>(&frame);
-
-            PODVector<Drawable*>::Iterator end = drawableUpdates_.End();
-            if (i < numWorkItems - 1 && end - start > drawablesPerItem)
-                end = start + drawablesPerItem;
-
-            item->start_ = &(*start);
-            item->end_ = &(*end);
-            queue->AddWorkItem(item);
-
-            start = end;
-        }
-
-        queue->Complete(M_MAX_UNSIGNED);
+        queue->ParallelFor(drawableUpdates_.Begin().ptr_, drawableUpdates_.End().ptr_, UpdateDrawablesWork,
+            const_cast<FrameInfo*>(&frame), MIN_DRAWABLES_PER_ITEM);
         scene->EndThreadedUpdate();
     }
 
@@ -425,6 +641,21 @@ void Octree::Update(const FrameInfo& frame)
         threadedDrawableUpdates_.Clear();
     }
 
+    // Update the drawables that deferred their update to the main thread. These are already queued for reinsertion
+    if (!mainThreadDrawableUpdates_.Empty())
+    {
+        URHO3D_PROFILE(UpdateDrawablesOnMainThread);
+
+        for (PODVector<Drawable*>::ConstIterator i = mainThreadDrawableUpdates_.Begin(); i != mainThreadDrawableUpdates_.End(); ++i)
+        {
+            Drawable* drawable = *i;
+            if (drawable)
+                drawable->Update(frame);
+        }
+
+        mainThreadDrawableUpdates_.Clear();
+    }
+
     // Notify drawable update being finished. Custom animation (eg. IK) can be done at this point
     Scene* scene = GetScene();
     if (scene)
@@ -438,30 +669,69 @@ void Octree::Update(const FrameInfo& frame)
     }
 
     // Reinsert drawables that have been moved or resized, or that have been newly added to the octree and do not sit inside
-    // the proper octant yet
+    // the proper octant yet. The drawables that need to move and their octant branches are determined in worker threads,
+    // then linked to the octants on the main thread
     if (!drawableUpdates_.Empty())
     {
         URHO3D_PROFILE(ReinsertToOctree);
 
-        for (PODVector<Drawable*>::Iterator i = drawableUpdates_.Begin(); i != drawableUpdates_.End(); ++i)
+        drawableReinsertions_.Resize(drawableUpdates_.Size());
+
+        auto* queue = GetSubsystem<WorkQueue>();
+        int numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
+        int drawablesPerItem = Max((int)(drawableUpdates_.Size() / numWorkItems), MIN_REINSERTIONS_PER_WORK_ITEM);
+
+        if (numWorkItems > 1 && (int)drawableUpdates_.Size() > drawablesPerItem)
         {
-            Drawable* drawable = *i;
-            drawable->updateQueued_ = false;
-            Octant* octant = drawable->GetOctant();
-            const BoundingBox& box = drawable->GetWorldBoundingBox();
+            Scene* scene = GetScene();
+            scene->BeginThreadedUpdate();
 
-            // Skip if no octant or does not belong to this octree anymore
-            if (!octant || octant->GetRoot() != this)
-                continue;
-            // Skip if still fits the current octant
-            if (drawable->IsOccludee() && octant->GetCullingBox().IsInside(box) == INSIDE && octant->CheckDrawableFit(box))
+            PODVector<Drawable*>::Iterator start = drawableUpdates_.Begin();
+            while (start != drawableUpdates_.End())
+            {
+                PODVector<Drawable*>::Iterator end = drawableUpdates_.End();
+                if (end - start > drawablesPerItem * 2)
+                    end = start + drawablesPerItem;
+
+                SharedPtr<WorkItem> item = queue->GetFreeItem();
+                item->priority_ = M_MAX_UNSIGNED;
+                item->workFunction_ = ReinsertDrawablesWork;
+                item->aux_ = this;
+                item->start_ = &(*start);
+                item->end_ = &(*end);
+                queue->AddWorkItem(item);
+
+                start = end;
+            }
+
+            queue->Complete(M_MAX_UNSIGNED);
+            scene->EndThreadedUpdate();
+        }
+        else
+            PrepareReinsertions(0, drawableUpdates_.Size());
+
+        for (unsigned i = 0; i < drawableUpdates_.Size(); ++i)
+        {
+            unsigned long long branch = drawableReinsertions_[i];
+            if (!branch)
                 continue;
 
-            InsertDrawable(drawable);
+            Drawable* drawable = drawableUpdates_[i];
+            const BoundingBox& box = drawable->GetWorldBoundingBox();
+            if (branch == INSERT_RECURSIVELY)
+                InsertDrawable(drawable);
+            else
+            {
+                Octant* octant = this;
+                unsigned levels = (unsigned)(branch & 0xffu) - 1;
+                for (unsigned j = 0; j < levels; ++j)
+                    octant = octant->GetOrCreateChild((unsigned)(branch >> (8 + 3 * j)) & 7u);
+                octant->LinkDrawable(drawable, box);
+            }
 
 #ifdef _DEBUG
             // Verify that the drawable will be culled correctly
-            octant = drawable->GetOctant();
+            Octant* octant = drawable->GetOctant();
             if (octant != this && octant->GetCullingBox().IsInside(box) != INSIDE)
             {
                 URHO3D_LOGERROR("Drawable is not fully inside its octant's culling bounds: drawable box " + box.ToString() +
@@ -474,6 +744,62 @@ void Octree::Update(const FrameInfo& frame)
     drawableUpdates_.Clear();
 }
 
+void Octree::PrepareReinsertions(unsigned start, unsigned end)
+{
+    const bool prepareBranches = numLevels_ <= MAX_THREADED_REINSERTION_LEVELS;
+
+    for (unsigned i = start; i < end; ++i)
+    {
+        Drawable* drawable = drawableUpdates_[i];
+        drawable->updateQueued_ = false;
+        Octant* octant = drawable->GetOctant();
+        const BoundingBox& box = drawable->GetWorldBoundingBox();
+        drawableReinsertions_[i] = 0;
+
+        // Skip if no octant or does not belong to this octree anymore
+        if (!octant || octant->GetRoot() != this)
+            continue;
+        // Skip if still fits the current octant, but refresh the bounds used for culling
+        if (drawable->IsOccludee() && octant->GetCullingBox().IsInside(box) == INSIDE && octant->CheckDrawableFit(box))
+        {
+            octant->UpdateDrawableBounds(drawable, box);
+            continue;
+        }
+
+        // With too many levels for the branch to be encoded, insert recursively on the main thread instead
+        drawableReinsertions_[i] = prepareBranches ? GetInsertionBranch(box, drawable->IsOccludee()) : INSERT_RECURSIVELY;
+    }
+}
+
+unsigned long long Octree::GetInsertionBranch(const BoundingBox& box, bool occludee) const
+{
+    // Follow the same steps as InsertDrawable(), but on the octant bounds only so that no octants need to be created
+    BoundingBox octantBox = worldBoundingBox_;
+    Vector3 boxCenter = box.Center();
+    unsigned long long branch = 0;
+    unsigned level = 0;
+
+    for (;;)
+    {
+        Vector3 center = octantBox.Center();
+        Vector3 halfSize = 0.5f * octantBox.Size();
+        bool fits = CheckOctantFit(octantBox, halfSize, level, numLevels_, box);
+
+        // If root octant, insert all non-occludees here, and also if drawable is outside the root octant bounds
+        if (fits || (!level && (!occludee || cullingBox_.IsInside(box) != INSIDE)))
+            break;
+
+        unsigned x = boxCenter.x_ < center.x_ ? 0 : 1;
+        unsigned y = boxCenter.y_ < center.y_ ? 0 : 2;
+        unsigned z = boxCenter.z_ < center.z_ ? 0 : 4;
+        branch |= (unsigned long long)(x + y + z) << (8 + 3 * level);
+        octantBox = GetChildOctantBox(octantBox, x + y + z);
+        ++level;
+    }
+
+    return branch | (level + 1);
+}
+
 void Octree::AddManualDrawable(Drawable* drawable)
 {
     if (!drawable || drawable->GetOctant())
@@ -494,6 +820,9 @@ void Octree::RemoveManualDrawable(Drawable* drawable)
 
 void Octree::GetDrawables(OctreeQuery& query) const
 {
+    if (queriesMetric_)
+        queriesMetric_->Increment();
+
     query.result_.Clear();
     GetDrawablesInternal(query, false);
 }
@@ -502,6 +831,9 @@ void Octree::Raycast(RayOctreeQuery& query) const
 {
     URHO3D_PROFILE(Raycast);
 
+    if (raycastsMetric_)
+        raycastsMetric_->Increment();
+
     query.result_.Clear();
     GetDrawablesInternal(query);
     Sort(query.result_.Begin(), query.result_.End(), CompareRayQueryResults);
@@ -511,6 +843,9 @@ void Octree::RaycastSingle(RayOctreeQuery& query) const
 {
     URHO3D_PROFILE(Raycast);
 
+    if (raycastsMetric_)
+        raycastsMetric_->Increment();
+
     query.result_.Clear();
     rayQueryDrawables_.Clear();
     GetDrawablesOnlyInternal(query, rayQueryDrawables_);
@@ -561,11 +896,18 @@ void Octree::QueueUpdate(Drawable* drawable)
     drawable->updateQueued_ = true;
 }
 
+void Octree::QueueMainThreadUpdate(Drawable* drawable)
+{
+    MutexLock lock(octreeMutex_);
+    mainThreadDrawableUpdates_.Push(drawable);
+}
+
 void Octree::CancelUpdate(Drawable* drawable)
 {
     // This doesn't have to take into account scene being in threaded update, because it is called only
     // when removing a drawable from octree, which should only ever happen from the main thread.
     drawableUpdates_.Remove(drawable);
+    mainThreadDrawableUpdates_.Remove(drawable);
     drawable->updateQueued_ = false;
 }
 
@@ -30,11 +30,41 @@
 namespace Urho3D
 {
 
+class Metric;
 class Octree;
 
 static const int NUM_OCTANTS = 8;
 static const unsigned ROOT_INDEX = M_MAX_UNSIGNED;
 
+/// Structure-of-arrays copy of the culling data of an octant's drawables, in the same order as the drawables. Lets queries test drawables without dereferencing them.
+/// @nobind
+struct URHO3D_API OctantDrawableData
+{
+    /// Append the culling data of a drawable.
+    void Push(const BoundingBox& box, unsigned viewMask, unsigned char flags);
+    /// Set the bounding box of a drawable by index.
+    void SetBoundingBox(unsigned index, const BoundingBox& box);
+    /// Remove the culling data of a drawable by index, moving the last drawable's data in its place.
+    void EraseSwap(unsigned index);
+
+    /// Bounding box center X coordinates.
+    PODVector<float> centerX_;
+    /// Bounding box center Y coordinates.
+    PODVector<float> centerY_;
+    /// Bounding box center Z coordinates.
+    PODVector<float> centerZ_;
+    /// Bounding box half sizes on the X axis.
+    PODVector<float> edgeX_;
+    /// Bounding box half sizes on the Y axis.
+    PODVector<float> edgeY_;
+    /// Bounding box half sizes on the Z axis.
+    PODVector<float> edgeZ_;
+    /// View masks.
+    PODVector<unsigned> viewMasks_;
+    /// Drawable flags.
+    PODVector<unsigned char> flags_;
+};
+
 /// %Octree octant.
 /// @nobind
 class URHO3D_API Octant
@@ -53,19 +83,20 @@ public:
     void InsertDrawable(Drawable* drawable);
     /// Check if a drawable object fits.
     bool CheckDrawableFit(const BoundingBox& box) const;
+    /// Link a drawable object to this octant, moving it from its old octant. If already in this octant, only update its stored bounding box.
+    void LinkDrawable(Drawable* drawable, const BoundingBox& box);
 
     /// Add a drawable object to this octant.
     void AddDrawable(Drawable* drawable)
     {
-        drawable->SetOctant(this);
-        drawables_.Push(drawable);
+        PushDrawable(drawable);
         IncDrawableCount();
     }
 
     /// Remove a drawable object from this octant.
     void RemoveDrawable(Drawable* drawable, bool resetOctant = true)
     {
-        if (drawables_.Remove(drawable))
+        if (EraseDrawable(drawable))
         {
             if (resetOctant)
                 drawable->SetOctant(nullptr);
@@ -73,6 +104,11 @@ public:
         }
     }
 
+    /// Update the stored bounding box of a drawable object in this octant.
+    void UpdateDrawableBounds(Drawable* drawable, const BoundingBox& box);
+    /// Update the stored view mask of a drawable object in this octant.
+    void UpdateDrawableViewMask(Drawable* drawable);
+
     /// Return world-space bounding box.
     /// @property
     const BoundingBox& GetWorldBoundingBox() const { return worldBoundingBox_; }
@@ -106,11 +142,18 @@ protected:
     void Initialize(const BoundingBox& box);
     /// Return drawable objects by a query, called internally.
     void GetDrawablesInternal(OctreeQuery& query, bool inside) const;
+    /// Test the drawable objects of this octant against a query's frustum using the stored culling data, then pass the ones inside to the query. Called internally.
+    void TestDrawablesInternal(OctreeQuery& query, const Frustum& frustum, bool inside) const;
     /// Return drawable objects by a ray query, called internally.
     void GetDrawablesInternal(RayOctreeQuery& query) const;
     /// Return drawable objects only for a threaded ray query, called internally.
     void GetDrawablesOnlyInternal(RayOctreeQuery& query, PODVector<Drawable*>& drawables) const;
 
+    /// Append a drawable object and its culling data without changing the drawable object counts.
+    void PushDrawable(Drawable* drawable);
+    /// Remove a drawable object and its culling data without changing the drawable object counts. Return true if was found.
+    bool EraseDrawable(Drawable* drawable);
+
     /// Increase drawable object count recursively.
     void IncDrawableCount()
     {
@@ -141,6 +184,8 @@ protected:
     BoundingBox cullingBox_;
     /// Drawable objects.
     PODVector<Drawable*> drawables_;
+    /// Culling data of the drawable objects.
+    OctantDrawableData drawableData_;
     /// Child octants.
     Octant* children_[NUM_OCTANTS]{};
     /// World bounding box center.
@@ -164,6 +209,8 @@ class URHO3D_API Octree : public Component, public Octant
 {
     URHO3D_OBJECT(Octree, Component);
 
+    friend void ReinsertDrawablesWork(const WorkItem* item, unsigned threadIndex);
+
 public:
     /// Construct.
     explicit Octree(Context* context);
@@ -201,6 +248,9 @@ public:
     void QueueUpdate(Drawable* drawable);
     /// Cancel drawable object's update.
     void CancelUpdate(Drawable* drawable);
+    /// Request a drawable object that is already queued for update to be updated again from the main thread once the threaded drawable update is finished. Called from worker threads by drawables whose update wants to use the work queue itself.
+    /// @nobind
+    void QueueMainThreadUpdate(Drawable* drawable);
     /// Visualize the component as debug geometry.
     void DrawDebugGeometry(bool depthTest);
 
@@ -209,17 +259,31 @@ private:
     void HandleRenderUpdate(StringHash eventType, VariantMap& eventData);
     /// Update octree size.
     void UpdateOctreeSize() { SetSize(worldBoundingBox_, numLevels_); }
+    /// Determine which of the queued drawables in a range need reinsertion and the octant branch for each. Safe to call from worker threads for separate ranges.
+    void PrepareReinsertions(unsigned start, unsigned end);
+    /// Return the octant branch a drawable object would be inserted to, as child octant indices from the root (three bits per level) shifted left by eight bits, plus the number of levels plus one.
+    unsigned long long GetInsertionBranch(const BoundingBox& box, bool occludee) const;
 
     /// Drawable objects that require update.
     PODVector<Drawable*> drawableUpdates_;
     /// Drawable objects that were inserted during threaded update phase.
     PODVector<Drawable*> threadedDrawableUpdates_;
+    /// Drawable objects that deferred their update to the main thread during threaded update phase.
+    PODVector<Drawable*> mainThreadDrawableUpdates_;
+    /// Octant branches for reinserting the drawable objects that require update, or zero if not moving.
+    PODVector<unsigned long long> drawableReinsertions_;
     /// Mutex for octree reinsertions.
-    Mutex octreeMutex_;
+    Mutex octreeMutex_{"Octree"};
     /// Ray query temporary list of drawables.
     mutable PODVector<Drawable*> rayQueryDrawables_;
     /// Subdivision level.
     unsigned numLevels_;
+    /// Drawable query metric.
+    SharedPtr<Metric> queriesMetric_;
+    /// Raycast metric.
+    SharedPtr<Metric> raycastsMetric_;
+    /// Drawable update metric.
+    SharedPtr<Metric> updatesMetric_;
 };
 
 }
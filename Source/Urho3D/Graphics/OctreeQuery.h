@@ -60,6 +60,8 @@ public:
     virtual Intersection TestOctant(const BoundingBox& box, bool inside) = 0;
     /// Intersection test for drawables.
     virtual void TestDrawables(Drawable** start, Drawable** end, bool inside) = 0;
+    /// Return a frustum for the octants to test their drawables against before TestDrawables(), or null to pass all drawables to TestDrawables(). When a frustum is returned, only drawables matching the drawable flags and view mask and inside the frustum are passed to TestDrawables(), with inside set.
+    virtual const Frustum* GetDrawableFrustum() const { return nullptr; }
 
     /// Result vector reference.
     PODVector<Drawable*>& result_;
@@ -152,6 +154,8 @@ public:
     Intersection TestOctant(const BoundingBox& box, bool inside) override;
     /// Intersection test for drawables.
     void TestDrawables(Drawable** start, Drawable** end, bool inside) override;
+    /// Return the frustum for testing the octants' drawable culling data.
+    const Frustum* GetDrawableFrustum() const override { return &frustum_; }
 
     /// Frustum.
     Frustum frustum_;
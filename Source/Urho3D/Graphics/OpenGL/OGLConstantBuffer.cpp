@@ -70,6 +70,8 @@ bool ConstantBuffer::SetSize(unsigned size)
 
     size_ = size;
     dirty_ = false;
+    ringOffset_ = M_MAX_UNSIGNED;
+    ringEpoch_ = 0;
     shadowData_ = new unsigned char[size_];
     memset(shadowData_.Get(), 0, size_);
 
@@ -88,6 +90,27 @@ bool ConstantBuffer::SetSize(unsigned size)
 
 void ConstantBuffer::Apply()
 {
+#ifndef GL_ES_VERSION_2_0
+    GraphicsImpl* impl = graphics_->GetImpl();
+    if (impl->GetPersistentMappingSupport() && object_.name_)
+    {
+        // Data written to the constant ring in an earlier frame may already have been overwritten
+        if (dirty_ || ringEpoch_ != impl->GetConstantRingEpoch())
+        {
+            ringOffset_ = impl->WriteConstantData(shadowData_.Get(), size_);
+            ringEpoch_ = impl->GetConstantRingEpoch();
+            // Out of ring space: use the buffer object of its own for the rest of the frame
+            if (ringOffset_ == M_MAX_UNSIGNED)
+            {
+                graphics_->SetUBO(object_.name_);
+                glBufferData(GL_UNIFORM_BUFFER, size_, shadowData_.Get(), GL_DYNAMIC_DRAW);
+            }
+            dirty_ = false;
+        }
+        return;
+    }
+#endif
+
     if (dirty_ && object_.name_)
     {
 #ifndef GL_ES_VERSION_2_0
@@ -28,6 +28,7 @@
 #include "../../Core/Profiler.h"
 #include "../../Graphics/ConstantBuffer.h"
 #include "../../Graphics/Graphics.h"
+#include "../../Graphics/GraphicsCapture.h"
 #include "../../Graphics/GraphicsEvents.h"
 #include "../../Graphics/GraphicsImpl.h"
 #include "../../Graphics/IndexBuffer.h"
@@ -228,9 +229,21 @@ static const unsigned glElementTypes[] =
     GL_FLOAT,
     GL_FLOAT,
     GL_UNSIGNED_BYTE,
-    GL_UNSIGNED_BYTE
+    GL_UNSIGNED_BYTE,
+    GL_SHORT,
+    GL_SHORT,
+#ifdef GL_ES_VERSION_2_0
+    GL_HALF_FLOAT_OES
+#else
+    GL_HALF_FLOAT
+#endif
 };
 
+/// Initial byte size of one frame's segment of the constant ring buffer.
+static const unsigned CONSTANT_RING_SEGMENT_SIZE = 1024 * 1024;
+/// Largest per-frame constant ring segment the ring grows to when a frame runs out of space.
+static const unsigned MAX_CONSTANT_RING_SEGMENT_SIZE = 16 * 1024 * 1024;
+
 static const unsigned glElementComponents[] =
 {
     1,
@@ -239,7 +252,24 @@ static const unsigned glElementComponents[] =
     3,
     4,
     4,
-    4
+    4,
+    2,
+    4,
+    2
+};
+
+static const bool glElementNormalized[] =
+{
+    false,
+    false,
+    false,
+    false,
+    false,
+    false,
+    true,
+    true,
+    true,
+    false
 };
 
 #ifdef GL_ES_VERSION_2_0
@@ -542,6 +572,23 @@ void Graphics::SetFlushGPU(bool enable)
     // Currently unimplemented on OpenGL
 }
 
+void Graphics::SetMaxFramesInFlight(unsigned frames)
+{
+    // No effect on OpenGL
+    maxFramesInFlight_ = Clamp(frames, 1u, MAX_FRAMES_IN_FLIGHT);
+}
+
+void Graphics::SetPipelinedFrames(bool enable)
+{
+    // No effect on OpenGL
+    pipelinedFrames_ = enable;
+}
+
+void Graphics::SetGPUProfiling(bool enable)
+{
+    // GPU timing is not supported on OpenGL
+}
+
 void Graphics::SetForceGL2(bool enable)
 {
     if (IsInitialized())
@@ -592,6 +639,18 @@ bool Graphics::TakeScreenShot(Image& destImage)
     return true;
 }
 
+unsigned Graphics::RequestScreenShot()
+{
+    // Asynchronous readback is not supported on OpenGL
+    return 0;
+}
+
+unsigned Graphics::RequestTextureData(Texture2D* texture, unsigned level)
+{
+    // Asynchronous readback is not supported on OpenGL
+    return 0;
+}
+
 bool Graphics::BeginFrame()
 {
     if (!IsInitialized() || IsDeviceLost())
@@ -641,6 +700,8 @@ void Graphics::EndFrame()
 
     SDL_GL_SwapWindow(window_);
 
+    impl_->AdvanceFrame();
+
     // Clean up too large scratch buffers
     CleanupScratchBuffers();
 }
@@ -849,6 +910,71 @@ bool Graphics::ResolveToTexture(TextureCube* texture)
 #endif
 }
 
+bool Graphics::CopyTexture(Texture2D* destination, Texture2D* source)
+{
+    // Texture copy is not supported on OpenGL
+    return false;
+}
+
+bool Graphics::SkinVertices(VertexBuffer* source, VertexBuffer* dest, unsigned vertexStart, unsigned vertexCount,
+    const Matrix3x4* skinMatrices, unsigned numSkinMatrices)
+{
+    // Compute skinning is not supported on OpenGL
+    return false;
+}
+
+bool Graphics::MorphVertices(VertexBuffer* source, VertexBuffer* dest, VertexBuffer* deltas, unsigned vertexStart, unsigned vertexCount,
+    const unsigned* deltaBlocks, const float* weights, unsigned numMorphs)
+{
+    // Compute morphing is not supported on OpenGL
+    return false;
+}
+
+bool Graphics::SimulateParticles(VertexBuffer* states, VertexBuffer* dest, const GPUParticleSimulation& simulation)
+{
+    // Compute particle simulation is not supported on OpenGL
+    return false;
+}
+
+bool Graphics::CompactIndices(IndexBuffer* source, IndexBuffer* dest, const unsigned* ranges, unsigned numRanges)
+{
+    // Compute index compaction is not supported on OpenGL
+    return false;
+}
+
+bool Graphics::DispatchCompute(const String& shaderName, const String& defines, Texture2D* const* textures, Texture2D* output,
+    const PODVector<Vector4>& parameters, bool async)
+{
+    // Compute shaders are not supported on OpenGL
+    return false;
+}
+
+void Graphics::WaitAsyncCompute()
+{
+}
+
+bool Graphics::LoadShaderArchive(const String& fileName)
+{
+    // Precompiled shader archives are not supported on OpenGL
+    return false;
+}
+
+bool Graphics::SaveShaderArchive(const String& fileName, const PODVector<ShaderVariation*>& variations, const Vector<String>& deviceTypes)
+{
+    // Precompiled shader archives are not supported on OpenGL
+    return false;
+}
+
+void Graphics::BeginGPUTiming(const String& name)
+{
+    // GPU timing is not supported on OpenGL
+}
+
+void Graphics::EndGPUTiming()
+{
+    // GPU timing is not supported on OpenGL
+}
+
 void Graphics::Draw(PrimitiveType type, unsigned vertexStart, unsigned vertexCount)
 {
     if (!vertexCount)
@@ -879,7 +1005,7 @@ void Graphics::Draw(PrimitiveType type, unsigned indexStart, unsigned indexCount
 
     GetGLPrimitiveType(indexCount, type, primitiveCount, glPrimitiveType);
     GLenum indexType = indexSize == sizeof(unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
-    glDrawElements(glPrimitiveType, indexCount, indexType, reinterpret_cast<const GLvoid*>(indexStart * indexSize));
+    glDrawElements(glPrimitiveType, indexCount, indexType, reinterpret_cast<const GLvoid*>(indexStart * indexSize + indexBuffer_->GetGPUDataOffset()));
 
     numPrimitives_ += primitiveCount;
     ++numBatches_;
@@ -899,7 +1025,7 @@ void Graphics::Draw(PrimitiveType type, unsigned indexStart, unsigned indexCount
 
     GetGLPrimitiveType(indexCount, type, primitiveCount, glPrimitiveType);
     GLenum indexType = indexSize == sizeof(unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
-    glDrawElementsBaseVertex(glPrimitiveType, indexCount, indexType, reinterpret_cast<GLvoid*>(indexStart * indexSize), baseVertexIndex);
+    glDrawElementsBaseVertex(glPrimitiveType, indexCount, indexType, reinterpret_cast<GLvoid*>(indexStart * indexSize + indexBuffer_->GetGPUDataOffset()), baseVertexIndex);
 
     numPrimitives_ += primitiveCount;
     ++numBatches_;
@@ -922,17 +1048,17 @@ void Graphics::DrawInstanced(PrimitiveType type, unsigned indexStart, unsigned i
     GetGLPrimitiveType(indexCount, type, primitiveCount, glPrimitiveType);
     GLenum indexType = indexSize == sizeof(unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
 #ifdef __EMSCRIPTEN__
-    glDrawElementsInstancedANGLE(glPrimitiveType, indexCount, indexType, reinterpret_cast<const GLvoid*>(indexStart * indexSize),
+    glDrawElementsInstancedANGLE(glPrimitiveType, indexCount, indexType, reinterpret_cast<const GLvoid*>(indexStart * indexSize + indexBuffer_->GetGPUDataOffset()),
         instanceCount);
 #else
     if (gl3Support)
     {
-        glDrawElementsInstanced(glPrimitiveType, indexCount, indexType, reinterpret_cast<const GLvoid*>(indexStart * indexSize),
+        glDrawElementsInstanced(glPrimitiveType, indexCount, indexType, reinterpret_cast<const GLvoid*>(indexStart * indexSize + indexBuffer_->GetGPUDataOffset()),
             instanceCount);
     }
     else
     {
-        glDrawElementsInstancedARB(glPrimitiveType, indexCount, indexType, reinterpret_cast<const GLvoid*>(indexStart * indexSize),
+        glDrawElementsInstancedARB(glPrimitiveType, indexCount, indexType, reinterpret_cast<const GLvoid*>(indexStart * indexSize + indexBuffer_->GetGPUDataOffset()),
             instanceCount);
     }
 #endif
@@ -958,7 +1084,7 @@ void Graphics::DrawInstanced(PrimitiveType type, unsigned indexStart, unsigned i
     GetGLPrimitiveType(indexCount, type, primitiveCount, glPrimitiveType);
     GLenum indexType = indexSize == sizeof(unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
 
-    glDrawElementsInstancedBaseVertex(glPrimitiveType, indexCount, indexType, reinterpret_cast<const GLvoid*>(indexStart * indexSize),
+    glDrawElementsInstancedBaseVertex(glPrimitiveType, indexCount, indexType, reinterpret_cast<const GLvoid*>(indexStart * indexSize + indexBuffer_->GetGPUDataOffset()),
         instanceCount, baseVertexIndex);
 
     numPrimitives_ += instanceCount * primitiveCount;
@@ -1125,10 +1251,16 @@ void Graphics::SetShaders(ShaderVariation* vs, ShaderVariation* ps)
             ConstantBuffer* buffer = constantBuffers[i].Get();
             if (buffer != impl_->constantBuffers_[i])
             {
-                unsigned object = buffer ? buffer->GetGPUObjectName() : 0;
-                glBindBufferBase(GL_UNIFORM_BUFFER, i, object);
-                // Calling glBindBufferBase also affects the generic buffer binding point
-                impl_->boundUBO_ = object;
+                // With the constant ring buffer the binding range is only known once the data has been applied
+                if (impl_->persistentMappingSupport_)
+                    impl_->constantBufferOffsets_[i] = M_MAX_UNSIGNED;
+                else
+                {
+                    unsigned object = buffer ? buffer->GetGPUObjectName() : 0;
+                    glBindBufferBase(GL_UNIFORM_BUFFER, i, object);
+                    // Calling glBindBufferBase also affects the generic buffer binding point
+                    impl_->boundUBO_ = object;
+                }
                 impl_->constantBuffers_[i] = buffer;
                 ShaderProgram::ClearGlobalParameterSource((ShaderParameterGroup)(i % MAX_SHADER_PARAMETER_GROUPS));
             }
@@ -1586,6 +1718,17 @@ void Graphics::SetTextureForUpdate(Texture* texture)
     textures_[0] = texture;
 }
 
+void Graphics::SetBindlessTextures(const PODVector<Texture*>& textures)
+{
+    // Bindless textures are not supported on OpenGL
+}
+
+void Graphics::SetClusteredLights(const PODVector<Vector4>& lightData, const PODVector<unsigned>& clusters,
+    const PODVector<unsigned>& lightIndices)
+{
+    // Clustered forward lighting is not supported on OpenGL
+}
+
 void Graphics::SetDefaultTextureFilterMode(TextureFilterMode mode)
 {
     if (mode != defaultTextureFilterMode_)
@@ -2399,6 +2542,8 @@ void Graphics::Release(bool clearGPUObjects, bool closeWindow)
 
     if (impl_->context_)
     {
+        impl_->ReleasePersistentResources();
+
         // Do not log this message if we are exiting
         if (!clearGPUObjects)
             URHO3D_LOGINFO("OpenGL context lost");
@@ -2756,10 +2901,21 @@ void Graphics::CheckFeatureSupport()
         sRGBWriteSupport_ = true;
 
         glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &numSupportedRTs);
+
+        // Persistent mapping replaces buffer orphaning for dynamic buffers and constant buffers
+        impl_->persistentMappingSupport_ = (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) && glBufferStorage != nullptr &&
+            glFenceSync != nullptr;
+        if (impl_->persistentMappingSupport_)
+        {
+            int alignment = 0;
+            glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+            impl_->constantRingAlignment_ = (unsigned)Max(alignment, 16);
+        }
     }
     else
     {
         instancingSupport_ = GLEW_ARB_instanced_arrays != 0;
+        impl_->persistentMappingSupport_ = false;
         dxtTextureSupport_ = GLEW_EXT_texture_compression_s3tc != 0;
         anisotropySupport_ = GLEW_EXT_texture_filter_anisotropic != 0;
         sRGBSupport_ = GLEW_EXT_texture_sRGB != 0;
@@ -2841,6 +2997,36 @@ void Graphics::PrepareDraw()
         for (PODVector<ConstantBuffer*>::Iterator i = impl_->dirtyConstantBuffers_.Begin(); i != impl_->dirtyConstantBuffers_.End(); ++i)
             (*i)->Apply();
         impl_->dirtyConstantBuffers_.Clear();
+
+        if (impl_->persistentMappingSupport_)
+        {
+            // Bound buffers move within the constant ring whenever they are applied, or every frame even if unchanged
+            for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS * 2; ++i)
+            {
+                ConstantBuffer* buffer = impl_->constantBuffers_[i];
+                unsigned object = 0;
+                unsigned offset = 0;
+                if (buffer)
+                {
+                    buffer->Apply();
+                    offset = buffer->GetRingOffset();
+                    object = offset != M_MAX_UNSIGNED ? impl_->constantRingBuffer_ : buffer->GetGPUObjectName();
+                    if (offset == M_MAX_UNSIGNED)
+                        offset = 0;
+                }
+
+                if (object != impl_->constantBufferObjects_[i] || offset != impl_->constantBufferOffsets_[i])
+                {
+                    if (object == impl_->constantRingBuffer_ && object)
+                        glBindBufferRange(GL_UNIFORM_BUFFER, i, object, offset, buffer->GetSize());
+                    else
+                        glBindBufferBase(GL_UNIFORM_BUFFER, i, object);
+                    impl_->boundUBO_ = object;
+                    impl_->constantBufferObjects_[i] = object;
+                    impl_->constantBufferOffsets_[i] = offset;
+                }
+            }
+        }
     }
 #endif
 
@@ -3100,7 +3286,7 @@ void Graphics::PrepareDraw()
                     }
 
                     // Enable/disable instancing divisor as necessary
-                    unsigned dataStart = element.offset_;
+                    unsigned dataStart = buffer->GetGPUDataOffset() + element.offset_;
                     if (element.perInstance_)
                     {
                         dataStart += impl_->lastInstanceOffset_ * buffer->GetVertexSize();
@@ -3121,7 +3307,7 @@ void Graphics::PrepareDraw()
 
                     SetVBO(buffer->GetGPUObjectName());
                     glVertexAttribPointer(location, glElementComponents[element.type_], glElementTypes[element.type_],
-                        element.type_ == TYPE_UBYTE4_NORM ? GL_TRUE : GL_FALSE, (unsigned)buffer->GetVertexSize(),
+                        glElementNormalized[element.type_] ? GL_TRUE : GL_FALSE, (unsigned)buffer->GetVertexSize(),
                         (const void *)(size_t)dataStart);
                 }
             }
@@ -3233,6 +3419,11 @@ void Graphics::ResetCachedState()
 
     for (auto& constantBuffer : impl_->constantBuffers_)
         constantBuffer = nullptr;
+    for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS * 2; ++i)
+    {
+        impl_->constantBufferObjects_[i] = 0;
+        impl_->constantBufferOffsets_[i] = 0;
+    }
     impl_->dirtyConstantBuffers_.Clear();
 }
 
@@ -3388,4 +3579,176 @@ void Graphics::SetVertexAttribDivisor(unsigned location, unsigned divisor)
 #endif
 }
 
+unsigned char* GraphicsImpl::CreatePersistentStorage(unsigned target, unsigned size)
+{
+#ifndef GL_ES_VERSION_2_0
+    if (!persistentMappingSupport_ || !size)
+        return nullptr;
+
+    // Dynamic storage is kept so that partial updates without discard can still go through glBufferSubData
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(target, size, nullptr, flags | GL_DYNAMIC_STORAGE_BIT);
+    return reinterpret_cast<unsigned char*>(glMapBufferRange(target, 0, size, flags));
+#else
+    return nullptr;
+#endif
+}
+
+void* GraphicsImpl::InsertFence()
+{
+#ifndef GL_ES_VERSION_2_0
+    return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#else
+    return nullptr;
+#endif
+}
+
+bool GraphicsImpl::IsFenceSignaled(void* fence)
+{
+#ifndef GL_ES_VERSION_2_0
+    if (!fence)
+        return true;
+
+    GLenum result = glClientWaitSync(reinterpret_cast<GLsync>(fence), 0, 0);
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+#else
+    return true;
+#endif
+}
+
+void GraphicsImpl::WaitFence(void*& fence)
+{
+#ifndef GL_ES_VERSION_2_0
+    if (!fence)
+        return;
+
+    // Flush on the first wait so that the fence is guaranteed to be reached
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    for (;;)
+    {
+        GLenum result = glClientWaitSync(reinterpret_cast<GLsync>(fence), flags, 1000000);
+        if (result != GL_TIMEOUT_EXPIRED)
+            break;
+        flags = 0;
+    }
+
+    DeleteFence(fence);
+#endif
+}
+
+void GraphicsImpl::DeleteFence(void*& fence)
+{
+#ifndef GL_ES_VERSION_2_0
+    if (fence)
+        glDeleteSync(reinterpret_cast<GLsync>(fence));
+#endif
+    fence = nullptr;
+}
+
+bool GraphicsImpl::CreateConstantRingBuffer(unsigned segmentSize)
+{
+#ifndef GL_ES_VERSION_2_0
+    // The old buffer may still be in use by frames in flight, but the driver defers its actual deletion until then
+    if (constantRingBuffer_)
+        glDeleteBuffers(1, &constantRingBuffer_);
+    constantRingData_ = nullptr;
+    constantRingSegmentSize_ = 0;
+
+    glGenBuffers(1, &constantRingBuffer_);
+    if (constantRingBuffer_)
+    {
+        glBindBuffer(GL_UNIFORM_BUFFER, constantRingBuffer_);
+        boundUBO_ = constantRingBuffer_;
+        constantRingData_ = CreatePersistentStorage(GL_UNIFORM_BUFFER, segmentSize * MAX_FRAMES_IN_FLIGHT);
+    }
+
+    if (!constantRingData_)
+    {
+        URHO3D_LOGERROR("Failed to create constant ring buffer, falling back to individual constant buffers");
+        if (constantRingBuffer_)
+            glDeleteBuffers(1, &constantRingBuffer_);
+        constantRingBuffer_ = 0;
+        persistentMappingSupport_ = false;
+        return false;
+    }
+
+    constantRingSegmentSize_ = segmentSize;
+    constantRingOffset_ = 0;
+    // Data written to the previous buffer must be rewritten
+    ++constantRingEpoch_;
+    return true;
+#else
+    return false;
+#endif
+}
+
+unsigned GraphicsImpl::WriteConstantData(const void* data, unsigned size)
+{
+    if (!persistentMappingSupport_)
+        return M_MAX_UNSIGNED;
+    if (!constantRingBuffer_ && !CreateConstantRingBuffer(CONSTANT_RING_SEGMENT_SIZE))
+        return M_MAX_UNSIGNED;
+
+    const unsigned rangeSize = (size + constantRingAlignment_ - 1) / constantRingAlignment_ * constantRingAlignment_;
+    if (constantRingOffset_ + rangeSize > constantRingSegmentSize_)
+    {
+        // The following segment belongs to a frame still in flight, so fall back for the rest of this frame and grow at the end of it
+        constantRingOverflow_ = true;
+        return M_MAX_UNSIGNED;
+    }
+
+    const unsigned offset = frameIndex_ * constantRingSegmentSize_ + constantRingOffset_;
+    memcpy(constantRingData_ + offset, data, size);
+    constantRingOffset_ += rangeSize;
+    return offset;
+}
+
+void GraphicsImpl::AdvanceFrame()
+{
+    if (!constantRingBuffer_)
+        return;
+
+    DeleteFence(frameFences_[frameIndex_]);
+    frameFences_[frameIndex_] = InsertFence();
+    frameIndex_ = (frameIndex_ + 1) % MAX_FRAMES_IN_FLIGHT;
+    WaitFence(frameFences_[frameIndex_]);
+
+    constantRingOffset_ = 0;
+    ++constantRingEpoch_;
+
+    if (constantRingOverflow_)
+    {
+        constantRingOverflow_ = false;
+        if (constantRingSegmentSize_ < MAX_CONSTANT_RING_SEGMENT_SIZE)
+        {
+            URHO3D_LOGDEBUG("Growing constant ring buffer segment to {} bytes", constantRingSegmentSize_ * 2);
+            CreateConstantRingBuffer(constantRingSegmentSize_ * 2);
+        }
+    }
+}
+
+void GraphicsImpl::ReleasePersistentResources()
+{
+    for (auto& fence : frameFences_)
+        DeleteFence(fence);
+
+#ifndef GL_ES_VERSION_2_0
+    if (constantRingBuffer_)
+        glDeleteBuffers(1, &constantRingBuffer_);
+#endif
+    constantRingBuffer_ = 0;
+    constantRingData_ = nullptr;
+    constantRingSegmentSize_ = 0;
+    constantRingOffset_ = 0;
+    constantRingOverflow_ = false;
+    frameIndex_ = 0;
+    ++constantRingEpoch_;
+
+    for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS * 2; ++i)
+    {
+        constantBufferObjects_[i] = 0;
+        constantBufferOffsets_[i] = 0;
+    }
+}
+
 }
@@ -75,6 +75,9 @@ using SDL_GLContext = void *;
 namespace Urho3D
 {
 
+/// Maximum number of data copies a persistently mapped dynamic buffer grows to before it waits for the GPU instead.
+static const unsigned MAX_PERSISTENT_COPIES = 16;
+
 class Context;
 
 using ConstantBufferMap = HashMap<unsigned, SharedPtr<ConstantBuffer> >;
@@ -107,7 +110,35 @@ public:
     /// Return the GL Context.
     const SDL_GLContext& GetGLContext() { return context_; }
 
+    /// Return whether dynamic buffers can use persistently mapped storage. Requires ARB_buffer_storage on desktop OpenGL.
+    bool GetPersistentMappingSupport() const { return persistentMappingSupport_; }
+    /// Allocate immutable, persistently and coherently mapped storage for the buffer object bound to the target. Return the mapped memory, or null on failure.
+    unsigned char* CreatePersistentStorage(unsigned target, unsigned size);
+    /// Insert a fence after the commands issued so far and return it.
+    void* InsertFence();
+    /// Return whether a fence has been signaled. A null fence counts as signaled.
+    bool IsFenceSignaled(void* fence);
+    /// Wait until a fence has been signaled, then delete it.
+    void WaitFence(void*& fence);
+    /// Delete a fence without waiting.
+    void DeleteFence(void*& fence);
+
+    /// Write data to the constant ring buffer. Return the byte offset, or M_MAX_UNSIGNED if the constant ring is not in use or out of space for this frame.
+    unsigned WriteConstantData(const void* data, unsigned size);
+    /// Return the constant ring buffer epoch. Data written in an earlier epoch is no longer available to the GPU.
+    unsigned GetConstantRingEpoch() const { return constantRingEpoch_; }
+
+    /// Mark vertex attribute pointers for update, for example after a bound vertex buffer moved its data within the buffer object.
+    void MarkVertexBuffersDirty() { vertexBuffersDirty_ = true; }
+
 private:
+    /// Create the constant ring buffer with the given per-frame segment size. Return true on success.
+    bool CreateConstantRingBuffer(unsigned segmentSize);
+    /// Fence the current frame's constant ring segment and advance to the next one, waiting for the GPU if it is still in use.
+    void AdvanceFrame();
+    /// Delete the constant ring buffer and the frame fences.
+    void ReleasePersistentResources();
+
     /// SDL OpenGL context.
     SDL_GLContext context_{};
     /// iOS/tvOS system framebuffer handle.
@@ -144,6 +175,26 @@ private:
     ConstantBuffer* constantBuffers_[MAX_SHADER_PARAMETER_GROUPS * 2]{};
     /// Dirty constant buffers.
     PODVector<ConstantBuffer*> dirtyConstantBuffers_;
+    /// Buffer objects bound to the constant buffer slots. Used with the constant ring buffer.
+    unsigned constantBufferObjects_[MAX_SHADER_PARAMETER_GROUPS * 2]{};
+    /// Byte offsets bound to the constant buffer slots. Used with the constant ring buffer.
+    unsigned constantBufferOffsets_[MAX_SHADER_PARAMETER_GROUPS * 2]{};
+    /// Persistently mapped constant ring buffer object. Split into one segment per frame in flight.
+    unsigned constantRingBuffer_{};
+    /// Mapped constant ring buffer memory.
+    unsigned char* constantRingData_{};
+    /// Byte size of one frame's constant ring segment.
+    unsigned constantRingSegmentSize_{};
+    /// Write offset within the current constant ring segment.
+    unsigned constantRingOffset_{};
+    /// Uniform buffer offset alignment required by the driver.
+    unsigned constantRingAlignment_{256};
+    /// Current constant ring epoch. Advanced every frame.
+    unsigned constantRingEpoch_{1};
+    /// Fences guarding the constant ring segments of the frames in flight.
+    void* frameFences_[MAX_FRAMES_IN_FLIGHT]{};
+    /// Index of the current frame's constant ring segment.
+    unsigned frameIndex_{};
     /// Last used instance data offset.
     unsigned lastInstanceOffset_{};
     /// Map for additional depth textures, to emulate Direct3D9 ability to mix render texture and backbuffer rendering.
@@ -158,6 +209,10 @@ private:
     bool vertexBuffersDirty_{};
     /// sRGB write mode flag.
     bool sRGBWrite_{};
+    /// Persistent buffer mapping support flag.
+    bool persistentMappingSupport_{};
+    /// Constant ring segment ran out of space during the current frame flag.
+    bool constantRingOverflow_{};
 };
 
 }
@@ -36,7 +36,16 @@ namespace Urho3D
 void IndexBuffer::OnDeviceLost()
 {
     if (object_.name_ && !graphics_->IsDeviceLost())
-        glDeleteBuffers(1, &object_.name_);
+    {
+        if (persistentData_)
+            ReleasePersistentStorage();
+        else
+            glDeleteBuffers(1, &object_.name_);
+    }
+
+    persistentData_ = nullptr;
+    persistentFences_.Clear();
+    persistentCopy_ = 0;
 
     GPUObject::OnDeviceLost();
 }
@@ -68,11 +77,18 @@ void IndexBuffer::Release()
             if (graphics_->GetIndexBuffer() == this)
                 graphics_->SetIndexBuffer(nullptr);
 
-            glDeleteBuffers(1, &object_.name_);
+            if (persistentData_)
+                ReleasePersistentStorage();
+            else
+                glDeleteBuffers(1, &object_.name_);
         }
 
         object_.name_ = 0;
     }
+
+    persistentData_ = nullptr;
+    persistentFences_.Clear();
+    persistentCopy_ = 0;
 }
 
 bool IndexBuffer::SetData(const void* data)
@@ -89,6 +105,7 @@ bool IndexBuffer::SetData(const void* data)
         return false;
     }
 
+    ++dataRevision_;
     if (shadowData_ && data != shadowData_.Get())
         memcpy(shadowData_.Get(), data, indexCount_ * (size_t)indexSize_);
 
@@ -96,8 +113,16 @@ bool IndexBuffer::SetData(const void* data)
     {
         if (!graphics_->IsDeviceLost())
         {
-            graphics_->SetIndexBuffer(this);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount_ * (size_t)indexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            if (persistentData_)
+                AdvancePersistentCopy();
+
+            if (persistentData_)
+                memcpy(persistentData_ + GetGPUDataOffset(), data, indexCount_ * (size_t)indexSize_);
+            else
+            {
+                graphics_->SetIndexBuffer(this);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount_ * (size_t)indexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            }
         }
         else
         {
@@ -136,6 +161,7 @@ bool IndexBuffer::SetDataRange(const void* data, unsigned start, unsigned count,
     if (!count)
         return true;
 
+    ++dataRevision_;
     if (shadowData_ && shadowData_.Get() + start * indexSize_ != data)
         memcpy(shadowData_.Get() + start * indexSize_, data, count * (size_t)indexSize_);
 
@@ -143,11 +169,24 @@ bool IndexBuffer::SetDataRange(const void* data, unsigned start, unsigned count,
     {
         if (!graphics_->IsDeviceLost())
         {
-            graphics_->SetIndexBuffer(this);
-            if (!discard || start != 0)
-                glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, start * (size_t)indexSize_, count * indexSize_, data);
+            // Discarding moves to a copy of the data the GPU is done with, so it can be written without synchronization
+            bool persistentWrite = persistentData_ && discard && start == 0;
+            if (persistentWrite)
+            {
+                AdvancePersistentCopy();
+                persistentWrite = persistentData_ != nullptr;
+            }
+
+            if (persistentWrite)
+                memcpy(persistentData_ + GetGPUDataOffset(), data, count * (size_t)indexSize_);
             else
-                glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * (size_t)indexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            {
+                graphics_->SetIndexBuffer(this);
+                if (!discard || start != 0)
+                    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, GetGPUDataOffset() + start * (size_t)indexSize_, count * indexSize_, data);
+                else
+                    glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * (size_t)indexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            }
         }
         else
         {
@@ -239,6 +278,10 @@ bool IndexBuffer::Create()
             return true;
         }
 
+        // Immutable storage can not be reallocated, so the buffer object is recreated
+        if (persistentData_)
+            ReleasePersistentStorage();
+
         if (!object_.name_)
             glGenBuffers(1, &object_.name_);
         if (!object_.name_)
@@ -247,8 +290,11 @@ bool IndexBuffer::Create()
             return false;
         }
 
-        graphics_->SetIndexBuffer(this);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount_ * (size_t)indexSize_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+        if (!dynamic_ || !graphics_->GetImpl()->GetPersistentMappingSupport() || !CreatePersistentStorage())
+        {
+            graphics_->SetIndexBuffer(this);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount_ * (size_t)indexSize_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+        }
     }
 
     return true;
@@ -273,4 +319,66 @@ void IndexBuffer::UnmapBuffer()
     // Never called on OpenGL
 }
 
+bool IndexBuffer::CreatePersistentStorage()
+{
+    graphics_->SetIndexBuffer(this);
+    persistentData_ = graphics_->GetImpl()->CreatePersistentStorage(GL_ELEMENT_ARRAY_BUFFER, persistentCopies_ * indexCount_ * indexSize_);
+    persistentFences_.Resize(persistentCopies_);
+    for (unsigned i = 0; i < persistentFences_.Size(); ++i)
+        persistentFences_[i] = nullptr;
+    persistentCopy_ = 0;
+    return persistentData_ != nullptr;
+}
+
+void IndexBuffer::ReleasePersistentStorage()
+{
+    GraphicsImpl* impl = graphics_->GetImpl();
+    for (unsigned i = 0; i < persistentFences_.Size(); ++i)
+        impl->DeleteFence(persistentFences_[i]);
+    persistentFences_.Clear();
+    persistentData_ = nullptr;
+    persistentCopy_ = 0;
+
+    // The driver defers deleting the buffer object until the GPU no longer uses it
+    if (object_.name_)
+    {
+        if (graphics_->GetIndexBuffer() == this)
+            graphics_->SetIndexBuffer(nullptr);
+        glDeleteBuffers(1, &object_.name_);
+        object_.name_ = 0;
+    }
+}
+
+void IndexBuffer::AdvancePersistentCopy()
+{
+    GraphicsImpl* impl = graphics_->GetImpl();
+
+    // Fence the draws issued from the current copy, then move on to the next one
+    impl->DeleteFence(persistentFences_[persistentCopy_]);
+    persistentFences_[persistentCopy_] = impl->InsertFence();
+    unsigned nextCopy = (persistentCopy_ + 1) % persistentCopies_;
+
+    if (!impl->IsFenceSignaled(persistentFences_[nextCopy]))
+    {
+        // Discarded more often than the GPU keeps up with: rather than wait, grow the storage. Its contents are discarded anyway
+        if (persistentCopies_ < MAX_PERSISTENT_COPIES)
+        {
+            persistentCopies_ *= 2;
+            ReleasePersistentStorage();
+            glGenBuffers(1, &object_.name_);
+            if (!CreatePersistentStorage())
+            {
+                URHO3D_LOGWARNING("Failed to grow persistently mapped index buffer storage, falling back to buffer orphaning");
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount_ * (size_t)indexSize_, nullptr, GL_DYNAMIC_DRAW);
+            }
+            return;
+        }
+
+        impl->WaitFence(persistentFences_[nextCopy]);
+    }
+
+    impl->DeleteFence(persistentFences_[nextCopy]);
+    persistentCopy_ = nextCopy;
+}
+
 }
@@ -35,7 +35,16 @@ namespace Urho3D
 void VertexBuffer::OnDeviceLost()
 {
     if (object_.name_ && !graphics_->IsDeviceLost())
-        glDeleteBuffers(1, &object_.name_);
+    {
+        if (persistentData_)
+            ReleasePersistentStorage();
+        else
+            glDeleteBuffers(1, &object_.name_);
+    }
+
+    persistentData_ = nullptr;
+    persistentFences_.Clear();
+    persistentCopy_ = 0;
 
     GPUObject::OnDeviceLost();
 }
@@ -71,11 +80,18 @@ void VertexBuffer::Release()
             }
 
             graphics_->SetVBO(0);
-            glDeleteBuffers(1, &object_.name_);
+            if (persistentData_)
+                ReleasePersistentStorage();
+            else
+                glDeleteBuffers(1, &object_.name_);
         }
 
         object_.name_ = 0;
     }
+
+    persistentData_ = nullptr;
+    persistentFences_.Clear();
+    persistentCopy_ = 0;
 }
 
 bool VertexBuffer::SetData(const void* data)
@@ -92,6 +108,7 @@ bool VertexBuffer::SetData(const void* data)
         return false;
     }
 
+    ++dataRevision_;
     if (shadowData_ && data != shadowData_.Get())
         memcpy(shadowData_.Get(), data, vertexCount_ * (size_t)vertexSize_);
 
@@ -99,8 +116,16 @@ bool VertexBuffer::SetData(const void* data)
     {
         if (!graphics_->IsDeviceLost())
         {
-            graphics_->SetVBO(object_.name_);
-            glBufferData(GL_ARRAY_BUFFER, vertexCount_ * (size_t)vertexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            if (persistentData_)
+                AdvancePersistentCopy();
+
+            if (persistentData_)
+                memcpy(persistentData_ + GetGPUDataOffset(), data, vertexCount_ * (size_t)vertexSize_);
+            else
+            {
+                graphics_->SetVBO(object_.name_);
+                glBufferData(GL_ARRAY_BUFFER, vertexCount_ * (size_t)vertexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            }
         }
         else
         {
@@ -139,6 +164,7 @@ bool VertexBuffer::SetDataRange(const void* data, unsigned start, unsigned count
     if (!count)
         return true;
 
+    ++dataRevision_;
     if (shadowData_ && shadowData_.Get() + start * vertexSize_ != data)
         memcpy(shadowData_.Get() + start * vertexSize_, data, count * (size_t)vertexSize_);
 
@@ -146,11 +172,30 @@ bool VertexBuffer::SetDataRange(const void* data, unsigned start, unsigned count
     {
         if (!graphics_->IsDeviceLost())
         {
-            graphics_->SetVBO(object_.name_);
-            if (!discard || start != 0)
-                glBufferSubData(GL_ARRAY_BUFFER, start * (size_t)vertexSize_, count * vertexSize_, data);
+            // Discarding moves to a copy of the data the GPU is done with, so it can be written without synchronization
+            bool persistentWrite = persistentData_ && discard && start == 0;
+            if (persistentWrite)
+            {
+                AdvancePersistentCopy();
+                persistentWrite = persistentData_ != nullptr;
+            }
+
+            if (persistentWrite)
+                memcpy(persistentData_ + GetGPUDataOffset(), data, count * (size_t)vertexSize_);
             else
-                glBufferData(GL_ARRAY_BUFFER, count * (size_t)vertexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            {
+                graphics_->SetVBO(object_.name_);
+                if (!discard || start != 0)
+                    glBufferSubData(GL_ARRAY_BUFFER, GetGPUDataOffset() + start * (size_t)vertexSize_, count * vertexSize_, data);
+                else if (count == vertexCount_)
+                    glBufferData(GL_ARRAY_BUFFER, count * (size_t)vertexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+                else
+                {
+                    // Orphan the whole buffer so that the rest of it can be appended to without changing its size
+                    glBufferData(GL_ARRAY_BUFFER, vertexCount_ * (size_t)vertexSize_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+                    glBufferSubData(GL_ARRAY_BUFFER, 0, count * vertexSize_, data);
+                }
+            }
         }
         else
         {
@@ -242,6 +287,10 @@ bool VertexBuffer::Create()
             return true;
         }
 
+        // Immutable storage can not be reallocated, so the buffer object is recreated
+        if (persistentData_)
+            ReleasePersistentStorage();
+
         if (!object_.name_)
             glGenBuffers(1, &object_.name_);
         if (!object_.name_)
@@ -250,8 +299,11 @@ bool VertexBuffer::Create()
             return false;
         }
 
-        graphics_->SetVBO(object_.name_);
-        glBufferData(GL_ARRAY_BUFFER, vertexCount_ * (size_t)vertexSize_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+        if (!dynamic_ || !graphics_->GetImpl()->GetPersistentMappingSupport() || !CreatePersistentStorage())
+        {
+            graphics_->SetVBO(object_.name_);
+            glBufferData(GL_ARRAY_BUFFER, vertexCount_ * (size_t)vertexSize_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+        }
     }
 
     return true;
@@ -276,4 +328,69 @@ void VertexBuffer::UnmapBuffer()
     // Never called on OpenGL
 }
 
+bool VertexBuffer::CreatePersistentStorage()
+{
+    graphics_->SetVBO(object_.name_);
+    persistentData_ = graphics_->GetImpl()->CreatePersistentStorage(GL_ARRAY_BUFFER, persistentCopies_ * vertexCount_ * vertexSize_);
+    persistentFences_.Resize(persistentCopies_);
+    for (unsigned i = 0; i < persistentFences_.Size(); ++i)
+        persistentFences_[i] = nullptr;
+    persistentCopy_ = 0;
+    return persistentData_ != nullptr;
+}
+
+void VertexBuffer::ReleasePersistentStorage()
+{
+    GraphicsImpl* impl = graphics_->GetImpl();
+    for (unsigned i = 0; i < persistentFences_.Size(); ++i)
+        impl->DeleteFence(persistentFences_[i]);
+    persistentFences_.Clear();
+    persistentData_ = nullptr;
+    persistentCopy_ = 0;
+
+    // The driver defers deleting the buffer object until the GPU no longer uses it
+    if (object_.name_)
+    {
+        graphics_->SetVBO(0);
+        glDeleteBuffers(1, &object_.name_);
+        object_.name_ = 0;
+    }
+
+    // Vertex attribute pointers may refer to the deleted buffer object
+    impl->MarkVertexBuffersDirty();
+}
+
+void VertexBuffer::AdvancePersistentCopy()
+{
+    GraphicsImpl* impl = graphics_->GetImpl();
+
+    // Fence the draws issued from the current copy, then move on to the next one
+    impl->DeleteFence(persistentFences_[persistentCopy_]);
+    persistentFences_[persistentCopy_] = impl->InsertFence();
+    unsigned nextCopy = (persistentCopy_ + 1) % persistentCopies_;
+
+    if (!impl->IsFenceSignaled(persistentFences_[nextCopy]))
+    {
+        // Discarded more often than the GPU keeps up with: rather than wait, grow the storage. Its contents are discarded anyway
+        if (persistentCopies_ < MAX_PERSISTENT_COPIES)
+        {
+            persistentCopies_ *= 2;
+            ReleasePersistentStorage();
+            glGenBuffers(1, &object_.name_);
+            if (!CreatePersistentStorage())
+            {
+                URHO3D_LOGWARNING("Failed to grow persistently mapped vertex buffer storage, falling back to buffer orphaning");
+                glBufferData(GL_ARRAY_BUFFER, vertexCount_ * (size_t)vertexSize_, nullptr, GL_DYNAMIC_DRAW);
+            }
+            return;
+        }
+
+        impl->WaitFence(persistentFences_[nextCopy]);
+    }
+
+    impl->DeleteFence(persistentFences_[nextCopy]);
+    persistentCopy_ = nextCopy;
+    impl->MarkVertexBuffersDirty();
+}
+
 }
@@ -24,9 +24,13 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DrawableEvents.h"
+#include "../Graphics/Octree.h"
 #include "../Graphics/ParticleEffect.h"
 #include "../Graphics/ParticleEmitter.h"
+#include "../Graphics/SignificanceManager.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 #include "../Scene/Scene.h"
@@ -40,19 +44,70 @@ namespace Urho3D
 extern const char* GEOMETRY_CATEGORY;
 extern const char* faceCameraModeNames[];
 static const unsigned MAX_PARTICLES_IN_FRAME = 100;
+/// Particle amount from which the particle update is split into work items.
+static const unsigned MIN_THREADED_PARTICLES = 8192;
+/// Minimum amount of particles in one work item.
+static const unsigned MIN_PARTICLES_PER_WORK_ITEM = 1024;
+
+/// Particle values, each stored in its own array.
+enum ParticleValue
+{
+    PV_TIMER = 0,
+    PV_TIMETOLIVE,
+    PV_VELOCITYX,
+    PV_VELOCITYY,
+    PV_VELOCITYZ,
+    PV_SIZEX,
+    PV_SIZEY,
+    PV_SCALE,
+    PV_ROTATIONSPEED,
+    MAX_PARTICLE_VALUES
+};
+
+/// Particle range update parameters and result of one work item.
+struct ParticleUpdateWork
+{
+    /// Emitter.
+    ParticleEmitter* emitter_;
+    /// Constant force in the billboard space.
+    Vector3 constantForce_;
+    /// Position update scale.
+    Vector3 scaleVector_;
+    /// Whether any of the particles was enabled.
+    bool needCommit_;
+};
 
 extern const char* autoRemoveModeNames[];
 
+void UpdateParticlesWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* update = reinterpret_cast<ParticleUpdateWork*>(item->aux_);
+    auto start = (unsigned)reinterpret_cast<size_t>(item->start_);
+    auto end = (unsigned)reinterpret_cast<size_t>(item->end_);
+    update->needCommit_ = update->emitter_->UpdateParticles(start, end, update->constantForce_, update->scaleVector_);
+}
+
+#ifdef URHO3D_SSE
+/// Return the values of the first vector where the mask is set and of the second vector elsewhere.
+static inline __m128 SelectMasked(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
 ParticleEmitter::ParticleEmitter(Context* context) :
     BillboardSet(context),
+    numParticles_(0),
     periodTimer_(0.0f),
     emissionTimer_(0.0f),
     lastTimeStep_(0.0f),
+    updateAccumulator_(0.0f),
     lastUpdateFrameNumber_(M_MAX_UNSIGNED),
     emitting_(true),
     needUpdate_(false),
     serializeParticles_(true),
     sendFinishedEvent_(true),
+    significanceUpdate_(false),
     autoRemove_(REMOVE_DISABLED)
 {
     SetNumParticles(DEFAULT_NUM_PARTICLES);
@@ -72,6 +127,7 @@ void ParticleEmitter::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Draw Distance", GetDrawDistance, SetDrawDistance, float, 0.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Shadow Distance", GetShadowDistance, SetShadowDistance, float, 0.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Animation LOD Bias", GetAnimationLodBias, SetAnimationLodBias, float, 1.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Significance Update", GetSignificanceUpdate, SetSignificanceUpdate, bool, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Is Emitting", bool, emitting_, true, AM_FILE);
     URHO3D_ATTRIBUTE("Period Timer", float, periodTimer_, 0.0f, AM_FILE | AM_NOEDIT);
     URHO3D_ATTRIBUTE("Emission Timer", float, emissionTimer_, 0.0f, AM_FILE | AM_NOEDIT);
@@ -107,9 +163,18 @@ void ParticleEmitter::Update(const FrameInfo& frame)
     if (!needUpdate_)
         return;
 
+    // Large emitters split their particles into work items, which can not be done while the work queue is busy with the
+    // threaded drawable update. Ask the octree to call the update again from the main thread once it is finished
+    Scene* scene = GetScene();
+    if (numParticles_ >= MIN_THREADED_PARTICLES && octant_ && scene && scene->IsThreadedUpdate())
+    {
+        octant_->GetRoot()->QueueMainThreadUpdate(this);
+        return;
+    }
+
     // If there is an amount mismatch between particles and billboards, correct it
-    if (particles_.Size() != billboards_.Size())
-        SetNumBillboards(particles_.Size());
+    if (numParticles_ != billboards_.Size())
+        SetNumBillboards(numParticles_);
 
     bool needCommit = false;
 
@@ -166,93 +231,56 @@ void ParticleEmitter::Update(const FrameInfo& frame)
     }
 
     // Update existing particles
-    Vector3 relativeConstantForce = node_->GetWorldRotation().Inverse() * effect_->GetConstantForce();
+    Vector3 constantForce = effect_->GetConstantForce();
+    if (relative_ && constantForce != Vector3::ZERO)
+        constantForce = node_->GetWorldRotation().Inverse() * constantForce;
     // If billboards are not relative, apply scaling to the position update
     Vector3 scaleVector = Vector3::ONE;
     if (scaled_ && !relative_)
         scaleVector = node_->GetWorldScale();
 
-    for (unsigned i = 0; i < particles_.Size(); ++i)
+    auto* queue = GetSubsystem<WorkQueue>();
+    unsigned numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
+    if (numParticles_ >= MIN_THREADED_PARTICLES && numWorkItems > 1 && Thread::IsMainThread() &&
+        !(scene && scene->IsThreadedUpdate()))
     {
-        Particle& particle = particles_[i];
-        Billboard& billboard = billboards_[i];
-
-        if (billboard.enabled_)
-        {
-            needCommit = true;
+        URHO3D_PROFILE(UpdateParticles);
 
-            // Time to live
-            if (particle.timer_ >= particle.timeToLive_)
-            {
-                billboard.enabled_ = false;
-                continue;
-            }
-            particle.timer_ += lastTimeStep_;
+        unsigned particlesPerItem = Max(numParticles_ / numWorkItems, MIN_PARTICLES_PER_WORK_ITEM);
+        PODVector<ParticleUpdateWork> updates(numWorkItems);
+        unsigned start = 0;
+        unsigned numUpdates = 0;
 
-            // Velocity & position
-            const Vector3& constantForce = effect_->GetConstantForce();
-            if (constantForce != Vector3::ZERO)
-            {
-                if (relative_)
-                    particle.velocity_ += lastTimeStep_ * relativeConstantForce;
-                else
-                    particle.velocity_ += lastTimeStep_ * constantForce;
-            }
-
-            float dampingForce = effect_->GetDampingForce();
-            if (dampingForce != 0.0f)
-            {
-                Vector3 force = -dampingForce * particle.velocity_;
-                particle.velocity_ += lastTimeStep_ * force;
-            }
-            billboard.position_ += lastTimeStep_ * particle.velocity_ * scaleVector;
-            billboard.direction_ = particle.velocity_.Normalized();
-
-            // Rotation
-            billboard.rotation_ += lastTimeStep_ * particle.rotationSpeed_;
+        while (start < numParticles_)
+        {
+            unsigned end = numParticles_;
+            if (numUpdates < numWorkItems - 1 && end - start > particlesPerItem)
+                end = start + particlesPerItem;
+
+            ParticleUpdateWork& update = updates[numUpdates++];
+            update.emitter_ = this;
+            update.constantForce_ = constantForce;
+            update.scaleVector_ = scaleVector;
+            update.needCommit_ = false;
+
+            SharedPtr<WorkItem> item = queue->GetFreeItem();
+            item->priority_ = M_MAX_UNSIGNED;
+            item->workFunction_ = UpdateParticlesWork;
+            item->aux_ = &update;
+            item->start_ = reinterpret_cast<void*>((size_t)start);
+            item->end_ = reinterpret_cast<void*>((size_t)end);
+            queue->AddWorkItem(item);
+
+            start = end;
+        }
 
-            // Scaling
-            float sizeAdd = effect_->GetSizeAdd();
-            float sizeMul = effect_->GetSizeMul();
-            if (sizeAdd != 0.0f || sizeMul != 1.0f)
-            {
-                particle.scale_ += lastTimeStep_ * sizeAdd;
-                if (particle.scale_ < 0.0f)
-                    particle.scale_ = 0.0f;
-                if (sizeMul != 1.0f)
-                    particle.scale_ *= (lastTimeStep_ * (sizeMul - 1.0f)) + 1.0f;
-                billboard.size_ = particle.size_ * particle.scale_;
-            }
+        queue->Complete(M_MAX_UNSIGNED);
 
-            // Color interpolation
-            unsigned& index = particle.colorIndex_;
-            const Vector<ColorFrame>& colorFrames_ = effect_->GetColorFrames();
-            if (index < colorFrames_.Size())
-            {
-                if (index < colorFrames_.Size() - 1)
-                {
-                    if (particle.timer_ >= colorFrames_[index + 1].time_)
-                        ++index;
-                }
-                if (index < colorFrames_.Size() - 1)
-                    billboard.color_ = colorFrames_[index].Interpolate(colorFrames_[index + 1], particle.timer_);
-                else
-                    billboard.color_ = colorFrames_[index].color_;
-            }
-
-            // Texture animation
-            unsigned& texIndex = particle.texIndex_;
-            const Vector<TextureFrame>& textureFrames_ = effect_->GetTextureFrames();
-            if (textureFrames_.Size() && texIndex < textureFrames_.Size() - 1)
-            {
-                if (particle.timer_ >= textureFrames_[texIndex + 1].time_)
-                {
-                    billboard.uv_ = textureFrames_[texIndex + 1].uv_;
-                    ++texIndex;
-                }
-            }
-        }
+        for (unsigned i = 0; i < numUpdates; ++i)
+            needCommit |= updates[i].needCommit_;
     }
+    else
+        needCommit |= UpdateParticles(0, numParticles_, constantForce, scaleVector);
 
     if (needCommit)
         Commit();
@@ -286,7 +314,26 @@ void ParticleEmitter::SetNumParticles(unsigned num)
     if (num > M_MAX_INT)
         num = 0;
 
-    particles_.Resize(num);
+    if (num != numParticles_)
+    {
+        // Each value has its own array, so resizing moves the particles of every array to the new array offsets. Added
+        // particles are zeroed, which also leaves them expired
+        unsigned numKept = Min(num, numParticles_);
+        PODVector<float> particleData(num * MAX_PARTICLE_VALUES, 0.0f);
+        for (unsigned i = 0; i < MAX_PARTICLE_VALUES && numKept; ++i)
+            memcpy(&particleData[i * num], GetParticleArray(i), numKept * sizeof(float));
+
+        particleData_.Swap(particleData);
+        colorIndices_.Resize(num);
+        texIndices_.Resize(num);
+        for (unsigned i = numKept; i < num; ++i)
+        {
+            colorIndices_[i] = 0;
+            texIndices_[i] = 0;
+        }
+        numParticles_ = num;
+    }
+
     SetNumBillboards(num);
 }
 
@@ -315,6 +362,13 @@ void ParticleEmitter::SetAutoRemoveMode(AutoRemoveMode mode)
     MarkNetworkUpdate();
 }
 
+void ParticleEmitter::SetSignificanceUpdate(bool enable)
+{
+    significanceUpdate_ = enable;
+    updateAccumulator_ = 0.0f;
+    MarkNetworkUpdate();
+}
+
 void ParticleEmitter::ResetEmissionTimer()
 {
     emissionTimer_ = 0.0f;
@@ -371,16 +425,18 @@ void ParticleEmitter::SetParticlesAttr(const VariantVector& value)
     unsigned index = 0;
     SetNumParticles(index < value.Size() ? value[index++].GetUInt() : 0);
 
-    for (PODVector<Particle>::Iterator i = particles_.Begin(); i != particles_.End() && index < value.Size(); ++i)
+    for (unsigned i = 0; i < numParticles_ && index < value.Size(); ++i)
     {
-        i->velocity_ = value[index++].GetVector3();
-        i->size_ = value[index++].GetVector2();
-        i->timer_ = value[index++].GetFloat();
-        i->timeToLive_ = value[index++].GetFloat();
-        i->scale_ = value[index++].GetFloat();
-        i->rotationSpeed_ = value[index++].GetFloat();
-        i->colorIndex_ = (unsigned)value[index++].GetInt();
-        i->texIndex_ = (unsigned)value[index++].GetInt();
+        Particle particle;
+        particle.velocity_ = value[index++].GetVector3();
+        particle.size_ = value[index++].GetVector2();
+        particle.timer_ = value[index++].GetFloat();
+        particle.timeToLive_ = value[index++].GetFloat();
+        particle.scale_ = value[index++].GetFloat();
+        particle.rotationSpeed_ = value[index++].GetFloat();
+        particle.colorIndex_ = (unsigned)value[index++].GetInt();
+        particle.texIndex_ = (unsigned)value[index++].GetInt();
+        SetParticle(i, particle);
     }
 }
 
@@ -389,22 +445,23 @@ VariantVector ParticleEmitter::GetParticlesAttr() const
     VariantVector ret;
     if (!serializeParticles_)
     {
-        ret.Push(particles_.Size());
+        ret.Push(numParticles_);
         return ret;
     }
 
-    ret.Reserve(particles_.Size() * 8 + 1);
-    ret.Push(particles_.Size());
-    for (PODVector<Particle>::ConstIterator i = particles_.Begin(); i != particles_.End(); ++i)
+    ret.Reserve(numParticles_ * 8 + 1);
+    ret.Push(numParticles_);
+    for (unsigned i = 0; i < numParticles_; ++i)
     {
-        ret.Push(i->velocity_);
-        ret.Push(i->size_);
-        ret.Push(i->timer_);
-        ret.Push(i->timeToLive_);
-        ret.Push(i->scale_);
-        ret.Push(i->rotationSpeed_);
-        ret.Push(i->colorIndex_);
-        ret.Push(i->texIndex_);
+        Particle particle = GetParticle(i);
+        ret.Push(particle.velocity_);
+        ret.Push(particle.size_);
+        ret.Push(particle.timer_);
+        ret.Push(particle.timeToLive_);
+        ret.Push(particle.scale_);
+        ret.Push(particle.rotationSpeed_);
+        ret.Push(particle.colorIndex_);
+        ret.Push(particle.texIndex_);
     }
     return ret;
 }
@@ -450,8 +507,8 @@ bool ParticleEmitter::EmitNewParticle()
     unsigned index = GetFreeParticle();
     if (index == M_MAX_UNSIGNED)
         return false;
-    assert(index < particles_.Size());
-    Particle& particle = particles_[index];
+    assert(index < numParticles_);
+    Particle particle;
     Billboard& billboard = billboards_[index];
 
     Vector3 startDir;
@@ -533,9 +590,10 @@ bool ParticleEmitter::EmitNewParticle()
     };
 
     particle.velocity_ = effect_->GetRandomVelocity() * startDir;
+    SetParticle(index, particle);
 
     billboard.position_ = startPos;
-    billboard.size_ = particles_[index].size_;
+    billboard.size_ = particle.size_;
     const Vector<TextureFrame>& textureFrames_ = effect_->GetTextureFrames();
     billboard.uv_ = textureFrames_.Size() ? textureFrames_[0].uv_ : Rect::POSITIVE;
     billboard.rotation_ = effect_->GetRandomRotation();
@@ -572,6 +630,175 @@ bool ParticleEmitter::CheckActiveParticles() const
     return false;
 }
 
+bool ParticleEmitter::UpdateParticles(unsigned start, unsigned end, const Vector3& constantForce, const Vector3& scaleVector)
+{
+    // Move the effect parameters out of the particle loops. Damping and the time step are folded into constant factors,
+    // which leave the velocity unchanged when there is no force or damping
+    float timeStep = lastTimeStep_;
+    Vector3 forceStep = timeStep * constantForce;
+    float dampingStep = 1.0f - timeStep * effect_->GetDampingForce();
+    float sizeAdd = effect_->GetSizeAdd();
+    float sizeMul = effect_->GetSizeMul();
+    bool applyScaling = sizeAdd != 0.0f || sizeMul != 1.0f;
+    float sizeAddStep = timeStep * sizeAdd;
+    float sizeMulStep = (timeStep * (sizeMul - 1.0f)) + 1.0f;
+    const Vector<ColorFrame>& colorFrames = effect_->GetColorFrames();
+    const Vector<TextureFrame>& textureFrames = effect_->GetTextureFrames();
+    unsigned numColorFrames = colorFrames.Size();
+    unsigned numTextureFrames = textureFrames.Size();
+    bool needCommit = false;
+
+    float* timers = GetParticleArray(PV_TIMER);
+    const float* timeToLive = GetParticleArray(PV_TIMETOLIVE);
+    float* velocityX = GetParticleArray(PV_VELOCITYX);
+    float* velocityY = GetParticleArray(PV_VELOCITYY);
+    float* velocityZ = GetParticleArray(PV_VELOCITYZ);
+    const float* sizeX = GetParticleArray(PV_SIZEX);
+    const float* sizeY = GetParticleArray(PV_SIZEY);
+    float* scales = GetParticleArray(PV_SCALE);
+    const float* rotationSpeeds = GetParticleArray(PV_ROTATIONSPEED);
+    Billboard* billboards = billboards_.Buffer();
+
+    // Disable the particles whose time to live has run out
+    for (unsigned i = start; i < end; ++i)
+    {
+        Billboard& billboard = billboards[i];
+        if (!billboard.enabled_)
+            continue;
+
+        needCommit = true;
+        if (timers[i] >= timeToLive[i])
+            billboard.enabled_ = false;
+    }
+
+    if (!needCommit)
+        return false;
+
+    // Advance the timers, velocities and scales of the live particles. Expired particles are masked out, so their state
+    // stays unchanged
+    unsigned i = start;
+#ifdef URHO3D_SSE
+    const __m128 timeStep4 = _mm_set1_ps(timeStep);
+    const __m128 forceStepX = _mm_set1_ps(forceStep.x_);
+    const __m128 forceStepY = _mm_set1_ps(forceStep.y_);
+    const __m128 forceStepZ = _mm_set1_ps(forceStep.z_);
+    const __m128 dampingStep4 = _mm_set1_ps(dampingStep);
+    const __m128 sizeAddStep4 = _mm_set1_ps(sizeAddStep);
+    const __m128 sizeMulStep4 = _mm_set1_ps(sizeMulStep);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 timer = _mm_loadu_ps(timers + i);
+        __m128 live = _mm_cmplt_ps(timer, _mm_loadu_ps(timeToLive + i));
+        _mm_storeu_ps(timers + i, _mm_add_ps(timer, _mm_and_ps(live, timeStep4)));
+
+        __m128 vx = _mm_loadu_ps(velocityX + i);
+        __m128 vy = _mm_loadu_ps(velocityY + i);
+        __m128 vz = _mm_loadu_ps(velocityZ + i);
+        _mm_storeu_ps(velocityX + i, SelectMasked(live, _mm_mul_ps(_mm_add_ps(vx, forceStepX), dampingStep4), vx));
+        _mm_storeu_ps(velocityY + i, SelectMasked(live, _mm_mul_ps(_mm_add_ps(vy, forceStepY), dampingStep4), vy));
+        _mm_storeu_ps(velocityZ + i, SelectMasked(live, _mm_mul_ps(_mm_add_ps(vz, forceStepZ), dampingStep4), vz));
+
+        if (applyScaling)
+        {
+            __m128 scale = _mm_loadu_ps(scales + i);
+            __m128 newScale = _mm_mul_ps(_mm_max_ps(_mm_add_ps(scale, sizeAddStep4), zero), sizeMulStep4);
+            _mm_storeu_ps(scales + i, SelectMasked(live, newScale, scale));
+        }
+    }
+#endif
+    for (; i < end; ++i)
+    {
+        if (timers[i] >= timeToLive[i])
+            continue;
+
+        timers[i] += timeStep;
+        velocityX[i] = (velocityX[i] + forceStep.x_) * dampingStep;
+        velocityY[i] = (velocityY[i] + forceStep.y_) * dampingStep;
+        velocityZ[i] = (velocityZ[i] + forceStep.z_) * dampingStep;
+        if (applyScaling)
+            scales[i] = Max(scales[i] + sizeAddStep, 0.0f) * sizeMulStep;
+    }
+
+    // Write the simulation state of the live particles to their billboards
+    for (i = start; i < end; ++i)
+    {
+        Billboard& billboard = billboards[i];
+        if (!billboard.enabled_)
+            continue;
+
+        // Position & direction
+        Vector3 velocity(velocityX[i], velocityY[i], velocityZ[i]);
+        billboard.position_ += timeStep * velocity * scaleVector;
+        billboard.direction_ = velocity.Normalized();
+
+        // Rotation
+        billboard.rotation_ += timeStep * rotationSpeeds[i];
+
+        // Scaling
+        if (applyScaling)
+            billboard.size_ = Vector2(sizeX[i] * scales[i], sizeY[i] * scales[i]);
+
+        // Color interpolation
+        unsigned& index = colorIndices_[i];
+        if (index < numColorFrames)
+        {
+            if (index < numColorFrames - 1)
+            {
+                if (timers[i] >= colorFrames[index + 1].time_)
+                    ++index;
+            }
+            if (index < numColorFrames - 1)
+                billboard.color_ = colorFrames[index].Interpolate(colorFrames[index + 1], timers[i]);
+            else
+                billboard.color_ = colorFrames[index].color_;
+        }
+
+        // Texture animation
+        unsigned& texIndex = texIndices_[i];
+        if (numTextureFrames && texIndex < numTextureFrames - 1)
+        {
+            if (timers[i] >= textureFrames[texIndex + 1].time_)
+            {
+                billboard.uv_ = textureFrames[texIndex + 1].uv_;
+                ++texIndex;
+            }
+        }
+    }
+
+    return true;
+}
+
+void ParticleEmitter::SetParticle(unsigned index, const Particle& particle)
+{
+    GetParticleArray(PV_TIMER)[index] = particle.timer_;
+    GetParticleArray(PV_TIMETOLIVE)[index] = particle.timeToLive_;
+    GetParticleArray(PV_VELOCITYX)[index] = particle.velocity_.x_;
+    GetParticleArray(PV_VELOCITYY)[index] = particle.velocity_.y_;
+    GetParticleArray(PV_VELOCITYZ)[index] = particle.velocity_.z_;
+    GetParticleArray(PV_SIZEX)[index] = particle.size_.x_;
+    GetParticleArray(PV_SIZEY)[index] = particle.size_.y_;
+    GetParticleArray(PV_SCALE)[index] = particle.scale_;
+    GetParticleArray(PV_ROTATIONSPEED)[index] = particle.rotationSpeed_;
+    colorIndices_[index] = particle.colorIndex_;
+    texIndices_[index] = particle.texIndex_;
+}
+
+Particle ParticleEmitter::GetParticle(unsigned index) const
+{
+    Particle particle;
+    particle.timer_ = GetParticleArray(PV_TIMER)[index];
+    particle.timeToLive_ = GetParticleArray(PV_TIMETOLIVE)[index];
+    particle.velocity_ = Vector3(GetParticleArray(PV_VELOCITYX)[index], GetParticleArray(PV_VELOCITYY)[index],
+        GetParticleArray(PV_VELOCITYZ)[index]);
+    particle.size_ = Vector2(GetParticleArray(PV_SIZEX)[index], GetParticleArray(PV_SIZEY)[index]);
+    particle.scale_ = GetParticleArray(PV_SCALE)[index];
+    particle.rotationSpeed_ = GetParticleArray(PV_ROTATIONSPEED)[index];
+    particle.colorIndex_ = colorIndices_[index];
+    particle.texIndex_ = texIndices_[index];
+    return particle;
+}
+
 void ParticleEmitter::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
 {
     // Store scene's timestep and use it instead of global timestep, as time scale may be other than 1
@@ -583,8 +810,13 @@ void ParticleEmitter::HandleScenePostUpdate(StringHash eventType, VariantMap& ev
     if ((effect_ && effect_->GetUpdateInvisible()) || viewFrameNumber_ != lastUpdateFrameNumber_)
     {
         lastUpdateFrameNumber_ = viewFrameNumber_;
-        needUpdate_ = true;
-        MarkForUpdate();
+
+        // With significance update, insignificant emitters skip frames and then simulate the accumulated time at once
+        if (!significanceUpdate_ || SignificanceManager::CheckUpdate(this, lastTimeStep_, updateAccumulator_))
+        {
+            needUpdate_ = true;
+            MarkForUpdate();
+        }
     }
 
     // Send finished event only once all particles are gone
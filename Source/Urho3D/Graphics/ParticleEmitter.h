@@ -29,7 +29,7 @@ namespace Urho3D
 
 class ParticleEffect;
 
-/// One particle in the particle system.
+/// One particle in the particle system. ParticleEmitter stores its particles as a structure of arrays; this is the state of one particle.
 struct Particle
 {
     /// Velocity.
@@ -55,6 +55,8 @@ class URHO3D_API ParticleEmitter : public BillboardSet
 {
     URHO3D_OBJECT(ParticleEmitter, BillboardSet);
 
+    friend void UpdateParticlesWork(const WorkItem* item, unsigned threadIndex);
+
 public:
     /// Construct.
     explicit ParticleEmitter(Context* context);
@@ -66,7 +68,7 @@ public:
 
     /// Handle enabled/disabled state change.
     void OnSetEnabled() override;
-    /// Update before octree reinsertion. Is called from a worker thread.
+    /// Update before octree reinsertion. Is called from a worker thread. Emitters with many particles defer to the main thread and split the particle update into work items.
     void Update(const FrameInfo& frame) override;
 
     /// Set particle effect.
@@ -84,6 +86,9 @@ public:
     /// Set to remove either the emitter component or its owner node from the scene automatically on particle effect completion. Disabled by default.
     /// @property
     void SetAutoRemoveMode(AutoRemoveMode mode);
+    /// Set whether particles update less often when the node is insignificant to the viewer. Requires a SignificanceManager in the scene. Disabled by default.
+    /// @property
+    void SetSignificanceUpdate(bool enable);
     /// Reset the emission period timer.
     void ResetEmissionTimer();
     /// Remove all current particles.
@@ -99,7 +104,7 @@ public:
 
     /// Return maximum number of particles.
     /// @property
-    unsigned GetNumParticles() const { return particles_.Size(); }
+    unsigned GetNumParticles() const { return numParticles_; }
 
     /// Return whether is currently emitting.
     /// @property
@@ -113,6 +118,10 @@ public:
     /// @property
     AutoRemoveMode GetAutoRemoveMode() const { return autoRemove_; }
 
+    /// Return whether the update rate follows the node's significance.
+    /// @property
+    bool GetSignificanceUpdate() const { return significanceUpdate_; }
+
     /// Set particles effect attribute.
     void SetEffectAttr(const ResourceRef& value);
     /// Set particles effect attribute.
@@ -136,6 +145,16 @@ protected:
     bool CheckActiveParticles() const;
 
 private:
+    /// Update the existing particles of a range with the given velocity change and position scale. Return true if any of them was enabled. Safe to call from worker threads for separate ranges.
+    bool UpdateParticles(unsigned start, unsigned end, const Vector3& constantForce, const Vector3& scaleVector);
+    /// Store particle state to the particle arrays.
+    void SetParticle(unsigned index, const Particle& particle);
+    /// Return particle state from the particle arrays.
+    Particle GetParticle(unsigned index) const;
+    /// Return the array of one particle value.
+    float* GetParticleArray(unsigned value) { return particleData_.Buffer() + value * numParticles_; }
+    /// Return the array of one particle value.
+    const float* GetParticleArray(unsigned value) const { return particleData_.Buffer() + value * numParticles_; }
     /// Handle scene post-update event.
     void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
     /// Handle live reload of the particle effect.
@@ -143,14 +162,22 @@ private:
 
     /// Particle effect.
     SharedPtr<ParticleEffect> effect_;
-    /// Particles.
-    PODVector<Particle> particles_;
+    /// Particle arrays, one array of the number of particles per particle value.
+    PODVector<float> particleData_;
+    /// Current color animation index of each particle.
+    PODVector<unsigned> colorIndices_;
+    /// Current texture animation index of each particle.
+    PODVector<unsigned> texIndices_;
+    /// Number of particles.
+    unsigned numParticles_;
     /// Active/inactive period timer.
     float periodTimer_;
     /// New particle emission timer.
     float emissionTimer_;
     /// Last scene timestep.
     float lastTimeStep_;
+    /// Time accumulated between significance throttled updates.
+    float updateAccumulator_;
     /// Rendering framenumber on which was last updated.
     unsigned lastUpdateFrameNumber_;
     /// Currently emitting flag.
@@ -161,6 +188,8 @@ private:
     bool serializeParticles_;
     /// Ready to send effect finish event flag.
     bool sendFinishedEvent_;
+    /// Significance update flag.
+    bool significanceUpdate_;
     /// Automatic removal mode.
     AutoRemoveMode autoRemove_;
 };
@@ -47,6 +47,9 @@ static const char* commandTypeNames[] =
     "lightvolumes",
     "renderui",
     "sendevent",
+    "forwardclustered",
+    "deferredclustered",
+    "compute",
     nullptr
 };
 
@@ -82,6 +85,9 @@ void RenderTargetInfo::Load(const XMLElement& element)
     if (element.HasAttribute("persistent"))
         persistent_ = element.GetBool("persistent");
 
+    if (element.HasAttribute("compute"))
+        compute_ = element.GetBool("compute");
+
     if (element.HasAttribute("size"))
         size_ = element.GetVector2("size");
     if (element.HasAttribute("sizedivisor"))
@@ -146,7 +152,10 @@ void RenderPathCommand::Load(const XMLElement& element)
         break;
 
     case CMD_SCENEPASS:
+    case CMD_FORWARDCLUSTERED:
         pass_ = element.GetAttribute("pass");
+        if (pass_.Empty() && type_ == CMD_FORWARDCLUSTERED)
+            pass_ = "base";
         sortMode_ =
             (RenderCommandSortMode)GetStringListIndex(element.GetAttributeLower("sort").CString(), sortModeNames, SORT_FRONTTOBACK);
         if (element.HasAttribute("marktostencil"))
@@ -162,6 +171,7 @@ void RenderPathCommand::Load(const XMLElement& element)
         break;
 
     case CMD_LIGHTVOLUMES:
+    case CMD_DEFERREDCLUSTERED:
     case CMD_QUAD:
         vertexShaderName_ = element.GetAttribute("vs");
         pixelShaderName_ = element.GetAttribute("ps");
@@ -173,6 +183,13 @@ void RenderPathCommand::Load(const XMLElement& element)
         }
         break;
 
+    case CMD_COMPUTE:
+        computeShaderName_ = element.GetAttribute("cs");
+        computeShaderDefines_ = element.GetAttribute("csdefines");
+        if (element.HasAttribute("async"))
+            async_ = element.GetBool("async");
+        break;
+
     case CMD_SENDEVENT:
         eventName_ = element.GetAttribute("name");
         break;
@@ -306,6 +323,16 @@ CubeMapFace RenderPathCommand::GetOutputFace(unsigned index) const
     return index < outputs_.Size() ? outputs_[index].second_ : FACE_POSITIVE_X;
 }
 
+String RenderPathCommand::GetProfileName() const
+{
+    String name(commandTypeNames[type_]);
+    if (!pass_.Empty())
+        name += " " + pass_;
+    else if (!tag_.Empty())
+        name += " " + tag_;
+    return name;
+}
+
 RenderPath::RenderPath() = default;
 
 RenderPath::~RenderPath() = default;
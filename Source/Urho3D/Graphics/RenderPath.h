@@ -46,7 +46,10 @@ enum RenderCommandType
     CMD_FORWARDLIGHTS,
     CMD_LIGHTVOLUMES,
     CMD_RENDERUI,
-    CMD_SENDEVENT
+    CMD_SENDEVENT,
+    CMD_FORWARDCLUSTERED,
+    CMD_DEFERREDCLUSTERED,
+    CMD_COMPUTE
 };
 
 /// Rendering path sorting modes.
@@ -94,6 +97,8 @@ struct URHO3D_API RenderTargetInfo
     bool sRGB_{};
     /// Should be persistent and not shared/reused between other buffers of same size.
     bool persistent_{};
+    /// Compute shader write access flag. Needed for the output of a compute command.
+    bool compute_{};
 };
 
 /// Rendering path command.
@@ -146,6 +151,9 @@ struct URHO3D_API RenderPathCommand
     /// @property
     const String& GetDepthStencilName() const { return depthStencilName_; }
 
+    /// Return name for profiling, which is the command type followed by the scene pass name or the tag.
+    String GetProfileName() const;
+
     /// Tag name.
     String tag_;
     /// Command type.
@@ -166,6 +174,10 @@ struct URHO3D_API RenderPathCommand
     String vertexShaderDefines_;
     /// Pixel shader defines.
     String pixelShaderDefines_;
+    /// Compute shader name. Affects compute command only.
+    String computeShaderName_;
+    /// Compute shader defines. Affects compute command only.
+    String computeShaderDefines_;
     /// Textures.
     String textureNames_[MAX_TEXTURE_UNITS];
     /// %Shader parameters.
@@ -194,6 +206,8 @@ struct URHO3D_API RenderPathCommand
     bool useLitBase_{true};
     /// Vertex lights flag.
     bool vertexLights_{};
+    /// Run on the asynchronous compute queue when available. Affects compute command only.
+    bool async_{};
     /// Event name.
     String eventName_;
 };
@@ -57,6 +57,16 @@ void RenderSurface::SetUpdateMode(RenderSurfaceUpdateMode mode)
     updateMode_ = mode;
 }
 
+void RenderSurface::SetUpdateInterval(unsigned interval)
+{
+    updateInterval_ = Max(interval, 1U);
+}
+
+void RenderSurface::SetUpdatePriority(int priority)
+{
+    updatePriority_ = priority;
+}
+
 void RenderSurface::SetLinkedRenderTarget(RenderSurface* renderTarget)
 {
     if (renderTarget != this)
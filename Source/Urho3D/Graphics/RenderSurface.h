@@ -52,6 +52,12 @@ public:
     /// Set viewport update mode. Default is to update when visible.
     /// @property
     void SetUpdateMode(RenderSurfaceUpdateMode mode);
+    /// Set minimum number of frames between automatic viewport updates. Default 1 allows an update on every frame. Manual updates are not limited.
+    /// @property
+    void SetUpdateInterval(unsigned interval);
+    /// Set priority of automatic viewport updates when the renderer limits auxiliary views per frame. Higher priority surfaces update first. Default 0.
+    /// @property
+    void SetUpdatePriority(int priority);
     /// Set linked color rendertarget.
     /// @property
     void SetLinkedRenderTarget(RenderSurface* renderTarget);
@@ -97,6 +103,14 @@ public:
     /// @property
     RenderSurfaceUpdateMode GetUpdateMode() const { return updateMode_; }
 
+    /// Return minimum number of frames between automatic viewport updates.
+    /// @property
+    unsigned GetUpdateInterval() const { return updateInterval_; }
+
+    /// Return priority of automatic viewport updates.
+    /// @property
+    int GetUpdatePriority() const { return updatePriority_; }
+
     /// Return linked color rendertarget.
     /// @property
     RenderSurface* GetLinkedRenderTarget() const { return linkedRenderTarget_; }
@@ -111,6 +125,12 @@ public:
     /// Reset update queued flag. Called internally.
     void ResetUpdateQueued();
 
+    /// Return frame number of the last viewport update. Called internally.
+    unsigned GetLastUpdateFrameNumber() const { return lastUpdateFrameNumber_; }
+
+    /// Set frame number of the last viewport update. Called internally.
+    void SetLastUpdateFrameNumber(unsigned frameNumber) { lastUpdateFrameNumber_ = frameNumber; }
+
     /// Return parent texture.
     /// @property
     Texture* GetParentTexture() const { return parentTexture_; }
@@ -174,6 +194,12 @@ private:
     WeakPtr<RenderSurface> linkedDepthStencil_;
     /// Update mode for viewports.
     RenderSurfaceUpdateMode updateMode_{SURFACE_UPDATEVISIBLE};
+    /// Minimum frames between automatic viewport updates.
+    unsigned updateInterval_{1};
+    /// Automatic viewport update priority.
+    int updatePriority_{};
+    /// Frame number of the last viewport update.
+    unsigned lastUpdateFrameNumber_{};
     /// Update queued flag.
     bool updateQueued_{};
     /// Multisampled resolve dirty flag.
@@ -22,7 +22,9 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/SmallVector.h"
 #include "../Core/CoreEvents.h"
+#include "../Core/Metrics.h"
 #include "../Core/Profiler.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/DebugRenderer.h"
@@ -36,6 +38,7 @@
 #include "../Graphics/Octree.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/RenderPath.h"
+#include "../Graphics/Shader.h"
 #include "../Graphics/ShaderVariation.h"
 #include "../Graphics/Technique.h"
 #include "../Graphics/Texture2D.h"
@@ -44,6 +47,7 @@
 #include "../Graphics/View.h"
 #include "../Graphics/Zone.h"
 #include "../IO/Log.h"
+#include "../Resource/Image.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/XMLFile.h"
 #include "../Scene/Scene.h"
@@ -57,6 +61,23 @@
 namespace Urho3D
 {
 
+/// Number of frames an unused shadow map cache is kept before it is released.
+static const unsigned SHADOW_CACHE_MAX_UNUSED_FRAMES = 60;
+/// Maximum age in frames of GPU depth used for occlusion culling.
+static const unsigned GPU_OCCLUSION_MAX_AGE = 4;
+/// Frames after their latest resolution request that streamed textures are considered out of view.
+static const unsigned STREAMED_TEXTURE_UNUSED_FRAMES = 30;
+/// Maximum number of streamed texture reloads pending at once.
+static const unsigned MAX_STREAMED_TEXTURE_RELOADS = 4;
+/// Smallest allowed resolution scale.
+static const float MIN_RESOLUTION_SCALE = 0.25f;
+/// Dynamic resolution scale granularity. Limits the number of screen buffer sizes in use.
+static const float RESOLUTION_SCALE_STEP = 0.05f;
+/// Fraction of the target GPU frame time the measured time must stay below before dynamic resolution increases the scale.
+static const float RESOLUTION_INCREASE_THRESHOLD = 0.85f;
+/// Frames to wait after a resolution scale change until the GPU frame timings belong to frames rendered with the new scale.
+static const unsigned RESOLUTION_SETTLE_FRAMES = MAX_FRAMES_IN_FLIGHT + 2;
+
 static const float dirLightVertexData[] =
 {
     -1, 1, 0,
@@ -271,6 +292,19 @@ Renderer::Renderer(Context* context) :
 {
     SubscribeToEvent(E_SCREENMODE, URHO3D_HANDLER(Renderer, HandleScreenMode));
 
+    auto* metrics = GetSubsystem<Metrics>();
+    if (metrics)
+    {
+        frameMetrics_[0] = metrics->GetGauge("Renderer", "views", "Views rendered on the last frame.");
+        frameMetrics_[1] = metrics->GetGauge("Renderer", "batches", "Batches rendered on the last frame.");
+        frameMetrics_[2] = metrics->GetGauge("Renderer", "primitives", "Primitives rendered on the last frame.");
+        frameMetrics_[3] = metrics->GetGauge("Renderer", "lights", "Lights rendered on the last frame.");
+        frameMetrics_[4] = metrics->GetGauge("Renderer", "shadow_maps", "Shadow maps rendered on the last frame.");
+        frameMetrics_[5] = metrics->GetGauge("Renderer", "occluders", "Occluders rendered on the last frame.");
+        pipelineStateMissesMetric_ = metrics->GetCounter("Renderer", "pipeline_state_misses_total",
+            "Pipeline state cache misses, which create a new pipeline state.");
+    }
+
     // Try to initialize right now, but skip if screen mode is not yet set
     Initialize();
 }
@@ -339,6 +373,16 @@ void Renderer::SetTextureQuality(MaterialQuality quality)
     }
 }
 
+void Renderer::SetTextureStreamingBudget(unsigned long long budget)
+{
+    textureStreamingBudget_ = budget;
+}
+
+void Renderer::SetTextureStreamingScale(float scale)
+{
+    textureStreamingScale_ = Max(scale, 0.0f);
+}
+
 void Renderer::SetMaterialQuality(MaterialQuality quality)
 {
     quality = Clamp(quality, QUALITY_LOW, QUALITY_MAX);
@@ -443,6 +487,35 @@ void Renderer::SetReuseShadowMaps(bool enable)
     reuseShadowMaps_ = enable;
 }
 
+void Renderer::SetShadowMapCaching(bool enable)
+{
+    if (enable == shadowMapCaching_)
+        return;
+
+    shadowMapCaching_ = enable;
+    shadowMapCaches_.Clear();
+}
+
+void Renderer::SetShadowAtlas(bool enable)
+{
+    if (enable == shadowAtlas_)
+        return;
+
+    shadowAtlas_ = enable;
+    if (!shadowAtlas_)
+        shadowAtlasTexture_.Reset();
+}
+
+void Renderer::SetShadowAtlasSize(int size)
+{
+    size = NextPowerOfTwo((unsigned)Max(size, SHADOW_MIN_PIXELS));
+    if (size != shadowAtlasSize_)
+    {
+        shadowAtlasSize_ = size;
+        shadowAtlasTexture_.Reset();
+    }
+}
+
 void Renderer::SetMaxShadowMaps(int shadowMaps)
 {
     if (shadowMaps < 1)
@@ -473,6 +546,22 @@ void Renderer::SetNumExtraInstancingBufferElements(int elements)
     }
 }
 
+void Renderer::SetBindlessInstancing(bool enable)
+{
+    if (enable && graphics_ && !graphics_->GetBindlessTexturesSupport())
+    {
+        URHO3D_LOGWARNING("Bindless textures not supported, can not enable bindless instancing");
+        enable = false;
+    }
+
+    if (enable != bindlessInstancing_)
+    {
+        bindlessInstancing_ = enable;
+        if (initialized_ && !numExtraInstancingBufferElements_)
+            CreateInstancingBuffer();
+    }
+}
+
 void Renderer::SetMinInstances(int instances)
 {
     minInstances_ = Max(instances, 1);
@@ -483,6 +572,11 @@ void Renderer::SetMaxSortedInstances(int instances)
     maxSortedInstances_ = Max(instances, 0);
 }
 
+void Renderer::SetMaxAuxiliaryViews(int views)
+{
+    maxAuxiliaryViews_ = Max(views, 0);
+}
+
 void Renderer::SetMaxOccluderTriangles(int triangles)
 {
     maxOccluderTriangles_ = Max(triangles, 0);
@@ -523,6 +617,61 @@ void Renderer::SetThreadedOcclusion(bool enable)
     }
 }
 
+void Renderer::SetGPUOcclusion(bool enable)
+{
+    if (enable == gpuOcclusion_)
+        return;
+
+    gpuOcclusion_ = enable;
+    gpuOcclusionStates_.Clear();
+    if (enable)
+        SubscribeToEvent(E_READBACKCOMPLETE, URHO3D_HANDLER(Renderer, HandleReadbackComplete));
+    else
+        UnsubscribeFromEvent(E_READBACKCOMPLETE);
+}
+
+void Renderer::SetScreenBufferAliasing(bool enable)
+{
+    screenBufferAliasing_ = enable;
+}
+
+void Renderer::SetResolutionScale(float scale)
+{
+    resolutionScale_ = Clamp(scale, MIN_RESOLUTION_SCALE, 1.0f);
+}
+
+void Renderer::SetDynamicResolution(bool enable)
+{
+    dynamicResolution_ = enable;
+    resolutionSettleFrames_ = 0;
+
+    if (enable)
+    {
+        resolutionScale_ = Clamp(resolutionScale_, minResolutionScale_, maxResolutionScale_);
+        if (graphics_)
+            graphics_->SetGPUProfiling(true);
+    }
+}
+
+void Renderer::SetDynamicResolutionRange(float minScale, float maxScale)
+{
+    minResolutionScale_ = Clamp(minScale, MIN_RESOLUTION_SCALE, 1.0f);
+    maxResolutionScale_ = Clamp(maxScale, minResolutionScale_, 1.0f);
+
+    if (dynamicResolution_)
+        resolutionScale_ = Clamp(resolutionScale_, minResolutionScale_, maxResolutionScale_);
+}
+
+void Renderer::SetDynamicResolutionTarget(float frameTime)
+{
+    dynamicResolutionTarget_ = Max(frameTime, M_EPSILON);
+}
+
+void Renderer::SetUpscaleSharpness(float sharpness)
+{
+    upscaleSharpness_ = Clamp(sharpness, 0.0f, 1.0f);
+}
+
 void Renderer::ReloadShaders()
 {
     shadersDirty_ = true;
@@ -570,6 +719,12 @@ Technique* Renderer::GetDefaultTechnique() const
     return defaultTechnique_;
 }
 
+bool Renderer::GetBindlessInstancing() const
+{
+    return bindlessInstancing_ && !numExtraInstancingBufferElements_ && dynamicInstancing_ && graphics_ &&
+           graphics_->GetBindlessTexturesSupport();
+}
+
 unsigned Renderer::GetNumGeometries(bool allViews) const
 {
     unsigned numGeometries = 0;
@@ -644,6 +799,24 @@ unsigned Renderer::GetNumOccluders(bool allViews) const
     return numOccluders;
 }
 
+unsigned Renderer::GetAliasedScreenBufferMemory(bool allViews) const
+{
+    unsigned memory = 0;
+    unsigned lastView = allViews ? views_.Size() : 1;
+
+    for (unsigned i = 0; i < lastView; ++i)
+    {
+        // Every view allocates its own screen buffers, so do not substitute the source view here
+        View* view = views_[i];
+        if (!view)
+            continue;
+
+        memory += view->GetAliasedScreenBufferMemory();
+    }
+
+    return memory;
+}
+
 void Renderer::Update(float timeStep)
 {
     URHO3D_PROFILE(UpdateViews);
@@ -664,10 +837,34 @@ void Renderer::Update(float timeStep)
     numOcclusionBuffers_ = 0;
     updatedOctrees_.Clear();
 
+    // Release GPU occlusion data of destroyed cameras
+    for (HashMap<Camera*, GPUOcclusionState>::Iterator i = gpuOcclusionStates_.Begin(); i != gpuOcclusionStates_.End();)
+    {
+        if (i->second_.camera_.Expired())
+            i = gpuOcclusionStates_.Erase(i);
+        else
+            ++i;
+    }
+
+    // Release shadow map caches whose light or camera is gone, or which have not been used for a while
+    for (HashMap<Pair<Light*, Camera*>, ShadowMapCache>::Iterator i = shadowMapCaches_.Begin(); i != shadowMapCaches_.End();)
+    {
+        const ShadowMapCache& cache = i->second_;
+        if (cache.light_.Expired() || cache.camera_.Expired() ||
+            frame_.frameNumber_ - cache.frameNumber_ > SHADOW_CACHE_MAX_UNUSED_FRAMES)
+            i = shadowMapCaches_.Erase(i);
+        else
+            ++i;
+    }
+
     // Reload shaders now if needed
     if (shadersDirty_)
         LoadShaders();
 
+    // Choose the resolution scale of this frame's views before they are defined
+    if (dynamicResolution_)
+        UpdateDynamicResolution();
+
     // Queue update of the main viewports. Use reverse order, as rendering order is also reverse
     // to render auxiliary views before dependent main views
     for (unsigned i = viewports_.Size() - 1; i < viewports_.Size(); --i)
@@ -678,13 +875,17 @@ void Renderer::Update(float timeStep)
     for (unsigned i = 0; i < numMainViewports; ++i)
         UpdateQueuedViewport(i);
 
-    // Gather queued & autoupdated render surfaces
+    // Gather queued & autoupdated render surfaces, then queue the viewports of those due for update
     SendEvent(E_RENDERSURFACEUPDATE);
+    ScheduleRenderSurfaces();
 
     // Update viewports that were added as result of the event above
     for (unsigned i = numMainViewports; i < queuedViewports_.Size(); ++i)
         UpdateQueuedViewport(i);
 
+    // The views have now requested their streamed texture resolutions
+    UpdateTextureStreaming();
+
     queuedViewports_.Clear();
     resetViews_ = false;
 }
@@ -739,6 +940,8 @@ void Renderer::Render()
     numPrimitives_ = graphics_->GetNumPrimitives();
     numBatches_ = graphics_->GetNumBatches();
 
+    UpdateMetrics();
+
     // Remove unused occlusion buffers and renderbuffers
     RemoveUnusedBuffers();
 
@@ -791,12 +994,12 @@ void Renderer::DrawDebugGeometry(bool depthTest)
 
 void Renderer::QueueRenderSurface(RenderSurface* renderTarget)
 {
-    if (renderTarget)
+    // The viewports are queued later by ScheduleRenderSurfaces(), which applies the update interval and view limit
+    if (renderTarget && renderTarget->GetNumViewports())
     {
-        unsigned numViewports = renderTarget->GetNumViewports();
-
-        for (unsigned i = 0; i < numViewports; ++i)
-            QueueViewport(renderTarget, renderTarget->GetViewport(i));
+        WeakPtr<RenderSurface> surface(renderTarget);
+        if (!queuedRenderSurfaces_.Contains(surface))
+            queuedRenderSurfaces_.Push(surface);
     }
 }
 
@@ -813,6 +1016,26 @@ void Renderer::QueueViewport(RenderSurface* renderTarget, Viewport* viewport)
     }
 }
 
+void Renderer::AddStreamedTexture(Texture2D* texture)
+{
+    if (texture)
+        streamedTextures_.Push(WeakPtr<Texture2D>(texture));
+}
+
+void Renderer::AddPassBatches(unsigned passIndex, const String& passName, unsigned numBatches)
+{
+    HashMap<unsigned, SharedPtr<Metric> >::Iterator i = passBatchMetrics_.Find(passIndex);
+    if (i == passBatchMetrics_.End())
+    {
+        auto* metrics = GetSubsystem<Metrics>();
+        i = passBatchMetrics_.Insert(MakePair(passIndex, SharedPtr<Metric>(metrics ? metrics->GetCounter("Renderer",
+            "pass_batches_total", "Batches drawn by scene passes.", "pass=\"" + passName.ToLower() + "\"") : nullptr)));
+    }
+
+    if (i->second_)
+        i->second_->Increment(numBatches);
+}
+
 Geometry* Renderer::GetLightGeometry(Light* light)
 {
     switch (light->GetLightType())
@@ -836,42 +1059,9 @@ Geometry* Renderer::GetQuadGeometry()
 Texture2D* Renderer::GetShadowMap(Light* light, Camera* camera, unsigned viewWidth, unsigned viewHeight)
 {
     LightType type = light->GetLightType();
-    const FocusParameters& parameters = light->GetShadowFocus();
-    float size = (float)shadowMapSize_ * light->GetShadowResolution();
-    // Automatically reduce shadow map size when far away
-    if (parameters.autoSize_ && type != LIGHT_DIRECTIONAL)
-    {
-        const Matrix3x4& view = camera->GetView();
-        const Matrix4& projection = camera->GetProjection();
-        BoundingBox lightBox;
-        float lightPixels;
-
-        if (type == LIGHT_POINT)
-        {
-            // Calculate point light pixel size from the projection of its diagonal
-            Vector3 center = view * light->GetNode()->GetWorldPosition();
-            float extent = 0.58f * light->GetRange();
-            lightBox.Define(center + Vector3(extent, extent, extent), center - Vector3(extent, extent, extent));
-        }
-        else
-        {
-            // Calculate spot light pixel size from the projection of its frustum far vertices
-            Frustum lightFrustum = light->GetViewSpaceFrustum(view);
-            lightBox.Define(&lightFrustum.vertices_[4], 4);
-        }
-
-        Vector2 projectionSize = lightBox.Projected(projection).Size();
-        lightPixels = Max(0.5f * (float)viewWidth * projectionSize.x_, 0.5f * (float)viewHeight * projectionSize.y_);
-
-        // Clamp pixel amount to a sufficient minimum to avoid self-shadowing artifacts due to loss of precision
-        if (lightPixels < SHADOW_MIN_PIXELS)
-            lightPixels = SHADOW_MIN_PIXELS;
-
-        size = Min(size, lightPixels);
-    }
 
     /// \todo Allow to specify maximum shadow maps per resolution, as smaller shadow maps take less memory
-    int width = NextPowerOfTwo((unsigned)size);
+    int width = GetShadowMapFaceSize(light, camera, viewWidth, viewHeight);
     int height = width;
 
     // Adjust the size for directional or point light shadow map atlases
@@ -909,92 +1099,92 @@ Texture2D* Renderer::GetShadowMap(Light* light, Camera* camera, unsigned viewWid
         }
     }
 
-    // Find format and usage of the shadow map
-    unsigned shadowMapFormat = 0;
-    TextureUsage shadowMapUsage = TEXTURE_DEPTHSTENCIL;
-    int multiSample = 1;
+    // If failed to create, store a null pointer so that we will not retry
+    SharedPtr<Texture2D> newShadowMap = CreateShadowMap(width, height);
+    shadowMaps_[searchKey].Push(newShadowMap);
+    if (!reuseShadowMaps_)
+        shadowMapAllocations_[searchKey].Push(light);
 
-    switch (shadowQuality_)
-    {
-    case SHADOWQUALITY_SIMPLE_16BIT:
-    case SHADOWQUALITY_PCF_16BIT:
-        shadowMapFormat = graphics_->GetShadowMapFormat();
-        break;
+    return newShadowMap;
+}
 
-    case SHADOWQUALITY_SIMPLE_24BIT:
-    case SHADOWQUALITY_PCF_24BIT:
-        shadowMapFormat = graphics_->GetHiresShadowMapFormat();
-        break;
+Texture2D* Renderer::GetShadowAtlasTile(Light* light, Camera* camera, unsigned viewWidth, unsigned viewHeight, IntRect& tileRect)
+{
+    // Directional light cascades use their own shadow maps, and VSM shadow maps are blurred as a whole
+    LightType type = light->GetLightType();
+    if (!shadowAtlas_ || type == LIGHT_DIRECTIONAL || shadowQuality_ == SHADOWQUALITY_VSM ||
+        shadowQuality_ == SHADOWQUALITY_BLUR_VSM)
+        return nullptr;
 
-    case SHADOWQUALITY_VSM:
-    case SHADOWQUALITY_BLUR_VSM:
-        shadowMapFormat = graphics_->GetRGFloat32Format();
-        shadowMapUsage = TEXTURE_RENDERTARGET;
-        multiSample = vsmMultiSample_;
-        break;
+    if (!shadowAtlasTexture_)
+    {
+        shadowAtlasTexture_ = CreateShadowMap(shadowAtlasSize_, shadowAtlasSize_);
+        if (!shadowAtlasTexture_)
+        {
+            URHO3D_LOGERROR("Failed to create shadow map atlas, using separate shadow maps");
+            shadowAtlas_ = false;
+            return nullptr;
+        }
+        shadowAtlasAllocator_.Reset(shadowAtlasTexture_->GetWidth(), shadowAtlasTexture_->GetHeight(),
+            shadowAtlasTexture_->GetWidth(), shadowAtlasTexture_->GetHeight(), false);
     }
 
-    if (!shadowMapFormat)
-        return nullptr;
+    // Point lights use 2x3 faces like their separate shadow maps. If the atlas is too full, retry with smaller tiles
+    // before falling back to a separate shadow map
+    int faceSize = GetShadowMapFaceSize(light, camera, viewWidth, viewHeight);
+    for (unsigned i = 0; i < 3 && faceSize >= SHADOW_MIN_PIXELS; ++i, faceSize >>= 1)
+    {
+        int width = type == LIGHT_POINT ? faceSize * 2 : faceSize;
+        int height = type == LIGHT_POINT ? faceSize * 3 : faceSize;
+        int x, y;
+        if (shadowAtlasAllocator_.Allocate(width, height, x, y))
+        {
+            tileRect = IntRect(x, y, x + width, y + height);
+            return shadowAtlasTexture_;
+        }
+    }
 
-    SharedPtr<Texture2D> newShadowMap(new Texture2D(context_));
-    int retries = 3;
-    unsigned dummyColorFormat = graphics_->GetDummyColorFormat();
+    return nullptr;
+}
 
-    // Disable mipmaps from the shadow map
-    newShadowMap->SetNumLevels(1);
+ShadowMapCache* Renderer::GetShadowMapCache(Light* light, Camera* camera, Texture2D* shadowMap)
+{
+    // Depth can only be composited when the shadow map is a depth texture that can be copied as a whole
+    if (!shadowMapCaching_ || !light || !camera || !shadowMap || !graphics_->GetTextureCopySupport() ||
+        shadowMap->GetUsage() != TEXTURE_DEPTHSTENCIL)
+        return nullptr;
 
-    while (retries)
+    ShadowMapCache& cache = shadowMapCaches_[MakePair(light, camera)];
+    Texture2D* texture = cache.texture_;
+    if (!texture || texture->GetWidth() != shadowMap->GetWidth() || texture->GetHeight() != shadowMap->GetHeight() ||
+        texture->GetFormat() != shadowMap->GetFormat())
     {
-        if (!newShadowMap->SetSize(width, height, shadowMapFormat, shadowMapUsage, multiSample))
+        if (!texture)
         {
-            width >>= 1;
-            height >>= 1;
-            --retries;
+            cache.light_ = light;
+            cache.camera_ = camera;
+            cache.texture_ = new Texture2D(context_);
+            texture = cache.texture_;
+            texture->SetNumLevels(1);
         }
-        else
+
+        if (!texture->SetSize(shadowMap->GetWidth(), shadowMap->GetHeight(), shadowMap->GetFormat(), TEXTURE_DEPTHSTENCIL))
         {
-#ifndef GL_ES_VERSION_2_0
-            // OpenGL (desktop) and D3D11: shadow compare mode needs to be specifically enabled for the shadow map
-            newShadowMap->SetFilterMode(FILTER_BILINEAR);
-            newShadowMap->SetShadowCompare(shadowMapUsage == TEXTURE_DEPTHSTENCIL);
-#endif
-#ifndef URHO3D_OPENGL
-            // Direct3D9: when shadow compare must be done manually, use nearest filtering so that the filtering of point lights
-            // and other shadowed lights matches
-            newShadowMap->SetFilterMode(graphics_->GetHardwareShadowSupport() ? FILTER_BILINEAR : FILTER_NEAREST);
-#endif
-            // Create dummy color texture for the shadow map if necessary: Direct3D9, or OpenGL when working around an OS X +
-            // Intel driver bug
-            if (shadowMapUsage == TEXTURE_DEPTHSTENCIL && dummyColorFormat)
-            {
-                // If no dummy color rendertarget for this size exists yet, create one now
-                if (!colorShadowMaps_.Contains(searchKey))
-                {
-                    colorShadowMaps_[searchKey] = new Texture2D(context_);
-                    colorShadowMaps_[searchKey]->SetNumLevels(1);
-                    colorShadowMaps_[searchKey]->SetSize(width, height, dummyColorFormat, TEXTURE_RENDERTARGET);
-                }
-                // Link the color rendertarget to the shadow map
-                newShadowMap->GetRenderSurface()->SetLinkedRenderTarget(colorShadowMaps_[searchKey]->GetRenderSurface());
-            }
-            break;
+            shadowMapCaches_.Erase(MakePair(light, camera));
+            return nullptr;
         }
-    }
 
-    // If failed to set size, store a null pointer so that we will not retry
-    if (!retries)
-        newShadowMap.Reset();
-
-    shadowMaps_[searchKey].Push(newShadowMap);
-    if (!reuseShadowMaps_)
-        shadowMapAllocations_[searchKey].Push(light);
+        cache.splitHashes_.Clear();
+    }
 
-    return newShadowMap;
+    cache.frameNumber_ = frame_.frameNumber_;
+    if (cache.splitHashes_.Size() < MAX_LIGHT_SPLITS)
+        cache.splitHashes_.Resize(MAX_LIGHT_SPLITS, 0);
+    return &cache;
 }
 
 Texture* Renderer::GetScreenBuffer(int width, int height, unsigned format, int multiSample, bool autoResolve, bool cubemap, bool filtered, bool srgb,
-    unsigned persistentKey)
+    unsigned persistentKey, bool computeAccess)
 {
     bool depthStencil = (format == Graphics::GetDepthStencilFormat()) || (format == Graphics::GetReadableDepthFormat());
     if (depthStencil)
@@ -1019,6 +1209,8 @@ Texture* Renderer::GetScreenBuffer(int width, int height, unsigned format, int m
         searchKey |= 0x2000000000000000ULL;
     if (autoResolve)
         searchKey |= 0x1000000000000000ULL;
+    if (computeAccess)
+        searchKey |= 0x0800000000000000ULL;
 
     // Add persistent key if defined
     if (persistentKey)
@@ -1043,6 +1235,7 @@ Texture* Renderer::GetScreenBuffer(int width, int height, unsigned format, int m
             SharedPtr<Texture2D> newTex2D(new Texture2D(context_));
             /// \todo Mipmaps disabled for now. Allow to request mipmapped buffer?
             newTex2D->SetNumLevels(1);
+            newTex2D->SetComputeAccess(computeAccess);
             newTex2D->SetSize(width, height, format, depthStencil ? TEXTURE_DEPTHSTENCIL : TEXTURE_RENDERTARGET, multiSample, autoResolve);
 
 #ifdef URHO3D_OPENGL
@@ -1120,6 +1313,54 @@ OcclusionBuffer* Renderer::GetOcclusionBuffer(Camera* camera)
     return buffer;
 }
 
+OcclusionBuffer* Renderer::GetGPUOcclusionBuffer(Camera* camera)
+{
+    if (!gpuOcclusion_)
+        return nullptr;
+
+    HashMap<Camera*, GPUOcclusionState>::Iterator i = gpuOcclusionStates_.Find(camera);
+    if (i == gpuOcclusionStates_.End() || !i->second_.buffer_)
+        return nullptr;
+
+    // Too old depth would cull objects that have since become visible
+    if (frame_.frameNumber_ - i->second_.frameNumber_ > GPU_OCCLUSION_MAX_AGE)
+        return nullptr;
+
+    return i->second_.buffer_;
+}
+
+OcclusionBuffer* Renderer::GetGPUOcclusionReadbackBuffer(Camera* camera)
+{
+    if (!gpuOcclusion_ || !camera || !graphics_->GetAsyncReadbackSupport())
+        return nullptr;
+
+    GPUOcclusionState& state = gpuOcclusionStates_[camera];
+    if (state.pendingId_)
+        return nullptr;
+
+    if (!state.pendingBuffer_)
+        state.pendingBuffer_ = new OcclusionBuffer(context_);
+
+    int width = occlusionBufferSize_;
+    auto height = RoundToInt(occlusionBufferSize_ / camera->GetAspectRatio());
+    if (!state.pendingBuffer_->SetSize(width, height, false))
+        return nullptr;
+
+    state.camera_ = camera;
+    state.pendingBuffer_->SetView(camera);
+    state.pendingFrameNumber_ = frame_.frameNumber_;
+    return state.pendingBuffer_;
+}
+
+void Renderer::RequestGPUOcclusionReadback(Camera* camera, Texture2D* depthTexture)
+{
+    HashMap<Camera*, GPUOcclusionState>::Iterator i = gpuOcclusionStates_.Find(camera);
+    if (i == gpuOcclusionStates_.End() || i->second_.pendingId_ || !i->second_.pendingBuffer_)
+        return;
+
+    i->second_.pendingId_ = graphics_->RequestTextureData(depthTexture, 0);
+}
+
 Camera* Renderer::GetShadowCamera()
 {
     MutexLock lock(rendererMutex_);
@@ -1264,8 +1505,10 @@ void Renderer::SetBatchShaders(Batch& batch, Technique* tech, bool allowShadows,
     }
 
     // Log error if shaders could not be assigned, but only once per technique
-    if (!batch.vertexShader_ || !batch.pixelShader_)
+    if (tech && (!batch.vertexShader_ || !batch.pixelShader_))
     {
+        // Batches may be collected in worker threads
+        MutexLock lock(rendererMutex_);
         if (!shaderErrorDisplayed_.Contains(tech))
         {
             shaderErrorDisplayed_.Insert(tech);
@@ -1274,6 +1517,26 @@ void Renderer::SetBatchShaders(Batch& batch, Technique* tech, bool allowShadows,
     }
 }
 
+void Renderer::SetBindlessBatchShaders(Batch& batch)
+{
+    if (batch.pixelShader_ && batch.pixelShader_->GetDefines().Contains("BINDLESS"))
+        return;
+
+    if (batch.vertexShader_)
+        batch.vertexShader_ = batch.vertexShader_->GetOwner()->GetVariation(VS, batch.vertexShader_->GetDefines() + " BINDLESS");
+    if (batch.pixelShader_)
+        batch.pixelShader_ = batch.pixelShader_->GetOwner()->GetVariation(PS, batch.pixelShader_->GetDefines() + " BINDLESS");
+}
+
+bool Renderer::HasBatchShaders(Pass* pass, const BatchQueue& queue) const
+{
+    if (pass->GetShadersLoadedFrameNumber() != shadersChangedFrameNumber_)
+        return false;
+
+    return queue.hasExtraDefines_ ? pass->HasShaders(queue.vsExtraDefinesHash_, queue.psExtraDefinesHash_) :
+        pass->HasShaders(StringHash::ZERO, StringHash::ZERO);
+}
+
 void Renderer::SetLightVolumeBatchShaders(Batch& batch, Camera* camera, const String& vsName, const String& psName, const String& vsDefines,
     const String& psDefines)
 {
@@ -1356,7 +1619,7 @@ bool Renderer::ResizeInstancingBuffer(unsigned numInstances)
     while (newSize < numInstances)
         newSize <<= 1;
 
-    const PODVector<VertexElement> instancingBufferElements = CreateInstancingBufferElements(numExtraInstancingBufferElements_);
+    const PODVector<VertexElement> instancingBufferElements = CreateInstancingBufferElements(GetNumInstancingBufferExtraElements());
     if (!instancingBuffer_->SetSize(newSize, instancingBufferElements, true))
     {
         URHO3D_LOGERROR("Failed to resize instancing buffer to " + String(newSize));
@@ -1369,6 +1632,39 @@ bool Renderer::ResizeInstancingBuffer(unsigned numInstances)
     return true;
 }
 
+unsigned Renderer::AllocateInstancingBuffer(unsigned numInstances)
+{
+    if (!instancingBuffer_ || !dynamicInstancing_ || !numInstances)
+        return M_MAX_UNSIGNED;
+
+    // On a new frame, grow to fit everything the previous frame requested before any range is written
+    if (instancingBufferFrameNumber_ != frame_.frameNumber_)
+    {
+        if (instancingBufferDemand_ > instancingBuffer_->GetVertexCount())
+            ResizeInstancingBuffer(instancingBufferDemand_);
+
+        instancingBufferFrameNumber_ = frame_.frameNumber_;
+        instancingBufferOffset_ = 0;
+        instancingBufferDemand_ = 0;
+    }
+
+    instancingBufferDemand_ += numInstances;
+
+    // The first range of the frame may still resize immediately, as nothing has been written yet
+    if (!instancingBufferOffset_ && numInstances > instancingBuffer_->GetVertexCount())
+    {
+        if (!ResizeInstancingBuffer(numInstances))
+            return M_MAX_UNSIGNED;
+    }
+
+    if (instancingBufferOffset_ + numInstances > instancingBuffer_->GetVertexCount())
+        return M_MAX_UNSIGNED;
+
+    unsigned start = instancingBufferOffset_;
+    instancingBufferOffset_ += numInstances;
+    return start;
+}
+
 void Renderer::OptimizeLightByScissor(Light* light, Camera* camera)
 {
     if (light && light->GetLightType() != LIGHT_DIRECTIONAL)
@@ -1472,6 +1768,97 @@ const Rect& Renderer::GetLightScissor(Light* light, Camera* camera)
     }
 }
 
+/// Compare queued render surfaces for update order: higher priority first, then the one that has waited longest.
+static bool CompareRenderSurfaceUpdates(RenderSurface* lhs, RenderSurface* rhs)
+{
+    if (lhs->GetUpdatePriority() != rhs->GetUpdatePriority())
+        return lhs->GetUpdatePriority() > rhs->GetUpdatePriority();
+    return lhs->GetLastUpdateFrameNumber() < rhs->GetLastUpdateFrameNumber();
+}
+
+void Renderer::ScheduleRenderSurfaces()
+{
+    if (queuedRenderSurfaces_.Empty())
+        return;
+
+    SmallVector<RenderSurface*, 16> surfaces;
+    for (unsigned i = 0; i < queuedRenderSurfaces_.Size(); ++i)
+    {
+        RenderSurface* surface = queuedRenderSurfaces_[i];
+        if (!surface)
+            continue;
+
+        // Manually updated surfaces are always updated, as their update request has already been consumed
+        if (surface->GetUpdateMode() == SURFACE_MANUALUPDATE)
+        {
+            UpdateRenderSurface(surface);
+            continue;
+        }
+
+        if (frame_.frameNumber_ - surface->GetLastUpdateFrameNumber() >= surface->GetUpdateInterval())
+            surfaces.Push(surface);
+    }
+    queuedRenderSurfaces_.Clear();
+
+    Sort(surfaces.Begin(), surfaces.End(), CompareRenderSurfaceUpdates);
+
+    // Surfaces that do not fit in the view limit are queued again on later frames while visible, and having waited
+    // longer they then go ahead of the surfaces updated now
+    unsigned numViews = 0;
+    for (unsigned i = 0; i < surfaces.Size(); ++i)
+    {
+        RenderSurface* surface = surfaces[i];
+        if (maxAuxiliaryViews_ && numViews + surface->GetNumViewports() > (unsigned)maxAuxiliaryViews_)
+            continue;
+
+        numViews += surface->GetNumViewports();
+        UpdateRenderSurface(surface);
+    }
+}
+
+void Renderer::UpdateRenderSurface(RenderSurface* renderTarget)
+{
+    unsigned numViewports = renderTarget->GetNumViewports();
+    for (unsigned i = 0; i < numViewports; ++i)
+        QueueViewport(renderTarget, renderTarget->GetViewport(i));
+
+    renderTarget->SetLastUpdateFrameNumber(frame_.frameNumber_);
+}
+
+void Renderer::UpdateDynamicResolution()
+{
+    if (resolutionSettleFrames_)
+    {
+        --resolutionSettleFrames_;
+        return;
+    }
+
+    long long gpuFrameTime = graphics_->GetGPUFrameTime();
+    if (gpuFrameTime <= 0)
+        return;
+
+    // The number of pixels rendered, which dominates the GPU time when it is over budget, grows with the square of the scale
+    float frameTime = (float)gpuFrameTime / 1000.0f;
+    float desiredScale = resolutionScale_ * sqrtf(dynamicResolutionTarget_ / frameTime);
+    float newScale = Clamp(Round(desiredScale / RESOLUTION_SCALE_STEP) * RESOLUTION_SCALE_STEP, minResolutionScale_,
+        maxResolutionScale_);
+
+    // Drop immediately when over budget, but recover one step at a time and only with headroom, to avoid oscillating
+    // around the target
+    if (newScale > resolutionScale_)
+    {
+        if (frameTime > dynamicResolutionTarget_ * RESOLUTION_INCREASE_THRESHOLD)
+            return;
+        newScale = Min(newScale, resolutionScale_ + RESOLUTION_SCALE_STEP);
+    }
+
+    if (Abs(newScale - resolutionScale_) < 0.5f * RESOLUTION_SCALE_STEP)
+        return;
+
+    resolutionScale_ = newScale;
+    resolutionSettleFrames_ = RESOLUTION_SETTLE_FRAMES;
+}
+
 void Renderer::UpdateQueuedViewport(unsigned index)
 {
     WeakPtr<RenderSurface>& renderTarget = queuedViewports_[index].first_;
@@ -1523,6 +1910,106 @@ void Renderer::UpdateQueuedViewport(unsigned index)
     view->Update(frame_);
 }
 
+/// Estimate memory use of a streamed texture with a number of top mips left out, from its current memory use. Each mip left out quarters it.
+static unsigned long long GetStreamedMemoryUse(Texture2D* texture, unsigned mipsSkipped)
+{
+    unsigned long long memoryUse = texture->GetMemoryUse();
+    unsigned current = texture->GetStreamedMipsSkipped();
+    return mipsSkipped >= current ? memoryUse >> (2 * (mipsSkipped - current)) : memoryUse << (2 * (current - mipsSkipped));
+}
+
+void Renderer::UpdateTextureStreaming()
+{
+    if (streamedTextures_.Empty())
+        return;
+
+    URHO3D_PROFILE(UpdateTextureStreaming);
+
+    // Textures in view get the resolution they were requested at, but are not reduced below their resident resolution
+    // as long as there is room in the budget
+    PODVector<Texture2D*> textures;
+    PODVector<unsigned> targets;
+    PODVector<Pair<unsigned, unsigned> > unusedTextures;
+    unsigned long long totalMemoryUse = 0;
+    unsigned numPending = 0;
+
+    for (unsigned i = streamedTextures_.Size() - 1; i < streamedTextures_.Size(); --i)
+    {
+        Texture2D* texture = streamedTextures_[i];
+        if (!texture)
+        {
+            streamedTextures_.EraseSwap(i);
+            continue;
+        }
+        if (!texture->GetStreaming())
+            continue;
+        if (texture->IsStreamingPending())
+            ++numPending;
+
+        unsigned target = texture->GetStreamedMipsSkipped();
+        if (frame_.frameNumber_ - texture->GetStreamingRequestFrame() <= STREAMED_TEXTURE_UNUSED_FRAMES)
+            target = Min(target, texture->GetRequestedMipsSkipped());
+        else
+            unusedTextures.Push(MakePair(texture->GetStreamingRequestFrame(), textures.Size()));
+
+        textures.Push(texture);
+        targets.Push(target);
+        totalMemoryUse += GetStreamedMemoryUse(texture, target);
+    }
+
+    if (textureStreamingBudget_ && totalMemoryUse > textureStreamingBudget_)
+    {
+        // Over the budget, first reduce the textures out of view to their low mips, least recently viewed first
+        Sort(unusedTextures.Begin(), unusedTextures.End());
+        for (unsigned i = 0; i < unusedTextures.Size() && totalMemoryUse > textureStreamingBudget_; ++i)
+        {
+            unsigned index = unusedTextures[i].second_;
+            Texture2D* texture = textures[index];
+            totalMemoryUse -= GetStreamedMemoryUse(texture, targets[index]);
+            targets[index] = texture->GetMaxStreamedMipsSkipped();
+            totalMemoryUse += GetStreamedMemoryUse(texture, targets[index]);
+        }
+
+        // Then drop one mip at a time from the largest textures
+        while (totalMemoryUse > textureStreamingBudget_)
+        {
+            unsigned largest = M_MAX_UNSIGNED;
+            unsigned long long largestMemoryUse = 0;
+            for (unsigned i = 0; i < textures.Size(); ++i)
+            {
+                unsigned long long memoryUse = GetStreamedMemoryUse(textures[i], targets[i]);
+                if (targets[i] < textures[i]->GetMaxStreamedMipsSkipped() && memoryUse > largestMemoryUse)
+                {
+                    largest = i;
+                    largestMemoryUse = memoryUse;
+                }
+            }
+            if (largest == M_MAX_UNSIGNED)
+                break;
+
+            totalMemoryUse -= largestMemoryUse;
+            ++targets[largest];
+            totalMemoryUse += GetStreamedMemoryUse(textures[largest], targets[largest]);
+        }
+    }
+
+    // Queue the reloads, reductions first so that memory is freed before more is taken. Raise the priority of the
+    // textures that gain the most mips
+    for (unsigned pass = 0; pass < 2; ++pass)
+    {
+        for (unsigned i = 0; i < textures.Size() && numPending < MAX_STREAMED_TEXTURE_RELOADS; ++i)
+        {
+            unsigned current = textures[i]->GetStreamedMipsSkipped();
+            if ((pass == 0) != (targets[i] > current))
+                continue;
+
+            int priority = targets[i] < current ? (int)(current - targets[i]) : 0;
+            if (textures[i]->StreamMips(targets[i], priority))
+                ++numPending;
+        }
+    }
+}
+
 void Renderer::PrepareViewRender()
 {
     ResetScreenBufferAllocations();
@@ -1530,6 +2017,24 @@ void Renderer::PrepareViewRender()
     lightStencilValue_ = 1;
 }
 
+void Renderer::UpdateMetrics()
+{
+    if (!pipelineStateMissesMetric_)
+        return;
+
+    frameMetrics_[0]->Set(views_.Size());
+    frameMetrics_[1]->Set(numBatches_);
+    frameMetrics_[2]->Set(numPrimitives_);
+    frameMetrics_[3]->Set(GetNumLights(true));
+    frameMetrics_[4]->Set(GetNumShadowMaps(true));
+    frameMetrics_[5]->Set(GetNumOccluders(true));
+
+    // The pipeline state statistics accumulate until reset, so count the difference from the last frame
+    unsigned misses = graphics_->GetPipelineStateStats().misses_;
+    pipelineStateMissesMetric_->Increment(misses >= lastPipelineStateMisses_ ? misses - lastPipelineStateMisses_ : misses);
+    lastPipelineStateMisses_ = misses;
+}
+
 void Renderer::RemoveUnusedBuffers()
 {
     for (unsigned i = occlusionBuffers_.Size() - 1; i < occlusionBuffers_.Size(); --i)
@@ -1567,6 +2072,10 @@ void Renderer::ResetShadowMapAllocations()
 {
     for (HashMap<int, PODVector<Light*> >::Iterator i = shadowMapAllocations_.Begin(); i != shadowMapAllocations_.End(); ++i)
         i->second_.Clear();
+
+    if (shadowAtlasTexture_)
+        shadowAtlasAllocator_.Reset(shadowAtlasTexture_->GetWidth(), shadowAtlasTexture_->GetHeight(),
+            shadowAtlasTexture_->GetWidth(), shadowAtlasTexture_->GetHeight(), false);
 }
 
 void Renderer::ResetScreenBufferAllocations()
@@ -1876,6 +2385,128 @@ void Renderer::SetIndirectionTextureData()
     indirectionCubeMap_->ClearDataLost();
 }
 
+int Renderer::GetShadowMapFaceSize(Light* light, Camera* camera, unsigned viewWidth, unsigned viewHeight) const
+{
+    LightType type = light->GetLightType();
+    const FocusParameters& parameters = light->GetShadowFocus();
+    float size = (float)shadowMapSize_ * light->GetShadowResolution();
+    // Automatically reduce shadow map size when far away
+    if (parameters.autoSize_ && type != LIGHT_DIRECTIONAL)
+    {
+        const Matrix3x4& view = camera->GetView();
+        const Matrix4& projection = camera->GetProjection();
+        BoundingBox lightBox;
+        float lightPixels;
+
+        if (type == LIGHT_POINT)
+        {
+            // Calculate point light pixel size from the projection of its diagonal
+            Vector3 center = view * light->GetNode()->GetWorldPosition();
+            float extent = 0.58f * light->GetRange();
+            lightBox.Define(center + Vector3(extent, extent, extent), center - Vector3(extent, extent, extent));
+        }
+        else
+        {
+            // Calculate spot light pixel size from the projection of its frustum far vertices
+            Frustum lightFrustum = light->GetViewSpaceFrustum(view);
+            lightBox.Define(&lightFrustum.vertices_[4], 4);
+        }
+
+        Vector2 projectionSize = lightBox.Projected(projection).Size();
+        lightPixels = Max(0.5f * (float)viewWidth * projectionSize.x_, 0.5f * (float)viewHeight * projectionSize.y_);
+
+        // Clamp pixel amount to a sufficient minimum to avoid self-shadowing artifacts due to loss of precision
+        if (lightPixels < SHADOW_MIN_PIXELS)
+            lightPixels = SHADOW_MIN_PIXELS;
+
+        size = Min(size, lightPixels);
+    }
+
+    return NextPowerOfTwo((unsigned)size);
+}
+
+SharedPtr<Texture2D> Renderer::CreateShadowMap(int width, int height)
+{
+    // Find format and usage of the shadow map
+    unsigned shadowMapFormat = 0;
+    TextureUsage shadowMapUsage = TEXTURE_DEPTHSTENCIL;
+    int multiSample = 1;
+
+    switch (shadowQuality_)
+    {
+    case SHADOWQUALITY_SIMPLE_16BIT:
+    case SHADOWQUALITY_PCF_16BIT:
+        shadowMapFormat = graphics_->GetShadowMapFormat();
+        break;
+
+    case SHADOWQUALITY_SIMPLE_24BIT:
+    case SHADOWQUALITY_PCF_24BIT:
+        shadowMapFormat = graphics_->GetHiresShadowMapFormat();
+        break;
+
+    case SHADOWQUALITY_VSM:
+    case SHADOWQUALITY_BLUR_VSM:
+        shadowMapFormat = graphics_->GetRGFloat32Format();
+        shadowMapUsage = TEXTURE_RENDERTARGET;
+        multiSample = vsmMultiSample_;
+        break;
+    }
+
+    if (!shadowMapFormat)
+        return SharedPtr<Texture2D>();
+
+    SharedPtr<Texture2D> newShadowMap(new Texture2D(context_));
+    int retries = 3;
+    unsigned dummyColorFormat = graphics_->GetDummyColorFormat();
+
+    // Disable mipmaps from the shadow map
+    newShadowMap->SetNumLevels(1);
+
+    while (retries)
+    {
+        if (!newShadowMap->SetSize(width, height, shadowMapFormat, shadowMapUsage, multiSample))
+        {
+            width >>= 1;
+            height >>= 1;
+            --retries;
+        }
+        else
+        {
+#ifndef GL_ES_VERSION_2_0
+            // OpenGL (desktop) and D3D11: shadow compare mode needs to be specifically enabled for the shadow map
+            newShadowMap->SetFilterMode(FILTER_BILINEAR);
+            newShadowMap->SetShadowCompare(shadowMapUsage == TEXTURE_DEPTHSTENCIL);
+#endif
+#ifndef URHO3D_OPENGL
+            // Direct3D9: when shadow compare must be done manually, use nearest filtering so that the filtering of point lights
+            // and other shadowed lights matches
+            newShadowMap->SetFilterMode(graphics_->GetHardwareShadowSupport() ? FILTER_BILINEAR : FILTER_NEAREST);
+#endif
+            // Create dummy color texture for the shadow map if necessary: Direct3D9, or OpenGL when working around an OS X +
+            // Intel driver bug
+            if (shadowMapUsage == TEXTURE_DEPTHSTENCIL && dummyColorFormat)
+            {
+                // If no dummy color rendertarget for this size exists yet, create one now
+                int searchKey = width << 16u | height;
+                if (!colorShadowMaps_.Contains(searchKey))
+                {
+                    colorShadowMaps_[searchKey] = new Texture2D(context_);
+                    colorShadowMaps_[searchKey]->SetNumLevels(1);
+                    colorShadowMaps_[searchKey]->SetSize(width, height, dummyColorFormat, TEXTURE_RENDERTARGET);
+                }
+                // Link the color rendertarget to the shadow map
+                newShadowMap->GetRenderSurface()->SetLinkedRenderTarget(colorShadowMaps_[searchKey]->GetRenderSurface());
+            }
+            break;
+        }
+    }
+
+    if (!retries)
+        newShadowMap.Reset();
+
+    return newShadowMap;
+}
+
 void Renderer::CreateInstancingBuffer()
 {
     // Do not create buffer if instancing not supported
@@ -1887,7 +2518,7 @@ void Renderer::CreateInstancingBuffer()
     }
 
     instancingBuffer_ = new VertexBuffer(context_);
-    const PODVector<VertexElement> instancingBufferElements = CreateInstancingBufferElements(numExtraInstancingBufferElements_);
+    const PODVector<VertexElement> instancingBufferElements = CreateInstancingBufferElements(GetNumInstancingBufferExtraElements());
     if (!instancingBuffer_->SetSize(INSTANCING_BUFFER_DEFAULT_SIZE, instancingBufferElements, true))
     {
         instancingBuffer_.Reset();
@@ -1895,11 +2526,19 @@ void Renderer::CreateInstancingBuffer()
     }
 }
 
+unsigned Renderer::GetNumInstancingBufferExtraElements() const
+{
+    // The bindless texture index occupies the first extra element
+    return numExtraInstancingBufferElements_ ? (unsigned)numExtraInstancingBufferElements_ : (bindlessInstancing_ ? 1 : 0);
+}
+
 void Renderer::ResetShadowMaps()
 {
     shadowMaps_.Clear();
     shadowMapAllocations_.Clear();
     colorShadowMaps_.Clear();
+    shadowMapCaches_.Clear();
+    shadowAtlasTexture_.Reset();
 }
 
 void Renderer::ResetBuffers()
@@ -1958,6 +2597,31 @@ void Renderer::HandleRenderUpdate(StringHash eventType, VariantMap& eventData)
     Update(eventData[P_TIMESTEP].GetFloat());
 }
 
+void Renderer::HandleReadbackComplete(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ReadbackComplete;
+
+    unsigned id = eventData[P_ID].GetUInt();
+    for (HashMap<Camera*, GPUOcclusionState>::Iterator i = gpuOcclusionStates_.Begin(); i != gpuOcclusionStates_.End(); ++i)
+    {
+        GPUOcclusionState& state = i->second_;
+        if (state.pendingId_ != id)
+            continue;
+
+        state.pendingId_ = 0;
+        auto* image = static_cast<Image*>(eventData[P_IMAGE].GetPtr());
+        OcclusionBuffer* buffer = state.pendingBuffer_;
+        if (image && buffer && image->GetWidth() == buffer->GetWidth() && image->GetHeight() == buffer->GetHeight())
+        {
+            // The readback holds raw 32-bit float depth
+            buffer->SetDepthData(reinterpret_cast<const float*>(image->GetData()));
+            state.buffer_.Swap(state.pendingBuffer_);
+            state.frameNumber_ = state.pendingFrameNumber_;
+        }
+        break;
+    }
+}
+
 
 void Renderer::BlurShadowMap(View* view, Texture2D* shadowMap, float blurScale)
 {
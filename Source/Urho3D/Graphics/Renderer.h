@@ -29,6 +29,7 @@
 #include "../Graphics/Batch.h"
 #include "../Graphics/Drawable.h"
 #include "../Graphics/Viewport.h"
+#include "../Math/AreaAllocator.h"
 #include "../Math/Color.h"
 
 namespace Urho3D
@@ -38,6 +39,7 @@ class Geometry;
 class Drawable;
 class Light;
 class Material;
+class Metric;
 class Pass;
 class Technique;
 class Octree;
@@ -171,6 +173,23 @@ enum DeferredLightPSVariation
     MAX_DEFERRED_LIGHT_PS_VARIATIONS
 };
 
+/// Occlusion data built from a camera's GPU depth, read back with a few frames of latency.
+struct GPUOcclusionState
+{
+    /// Camera the depth was rendered from.
+    WeakPtr<Camera> camera_;
+    /// Latest completed occlusion buffer.
+    SharedPtr<OcclusionBuffer> buffer_;
+    /// Occlusion buffer receiving the pending readback.
+    SharedPtr<OcclusionBuffer> pendingBuffer_;
+    /// Pending readback request ID, or 0 if none.
+    unsigned pendingId_{};
+    /// Frame number on which the completed buffer's depth was rendered.
+    unsigned frameNumber_{};
+    /// Frame number on which the pending depth was rendered.
+    unsigned pendingFrameNumber_{};
+};
+
 /// High-level rendering subsystem. Manages drawing of 3D views.
 class URHO3D_API Renderer : public Object
 {
@@ -216,6 +235,12 @@ public:
     /// Set material quality level. See the QUALITY constants in GraphicsDefs.h.
     /// @property
     void SetMaterialQuality(MaterialQuality quality);
+    /// Set memory budget of streamed textures in bytes. When over the budget, the streamed textures are reduced to lower mips, the ones out of view first. Zero (default) is unlimited.
+    /// @property
+    void SetTextureStreamingBudget(unsigned long long budget);
+    /// Set scale of the resolution streamed textures are requested at, relative to the on-screen size of the drawables using them. Raise for textures that repeat across their drawables.
+    /// @property
+    void SetTextureStreamingScale(float scale);
     /// Set shadows on/off.
     /// @property
     void SetDrawShadows(bool enable);
@@ -239,6 +264,15 @@ public:
     /// Set reuse of shadow maps. Default is true. If disabled, also transparent geometry can be shadowed.
     /// @property
     void SetReuseShadowMaps(bool enable);
+    /// Set caching of static shadow caster depth per light. Default is false. Requires GPU texture copy support and is not used with VSM shadows.
+    /// @property
+    void SetShadowMapCaching(bool enable);
+    /// Set rendering of spot and point light shadows into tiles of one shared shadow map atlas. Default is false. Not used with VSM shadows.
+    /// @property
+    void SetShadowAtlas(bool enable);
+    /// Set shadow map atlas width and height. Default 4096.
+    /// @property
+    void SetShadowAtlasSize(int size);
     /// Set maximum number of shadow maps created for one resolution. Only has effect if reuse of shadow maps is disabled.
     /// @property
     void SetMaxShadowMaps(int shadowMaps);
@@ -248,12 +282,17 @@ public:
     /// Set number of extra instancing buffer elements. Default is 0. Extra 4-vectors are available through TEXCOORD7 and further.
     /// @property
     void SetNumExtraInstancingBufferElements(int elements);
+    /// Set bindless instancing on/off. When on, instanced batches whose materials differ only by the diffuse texture are combined to one draw call that indexes a bindless texture array. Requires bindless texture support and no extra instancing buffer elements.
+    void SetBindlessInstancing(bool enable);
     /// Set minimum number of instances required in a batch group to render as instanced.
     /// @property
     void SetMinInstances(int instances);
     /// Set maximum number of sorted instances per batch group. If exceeded, instances are rendered unsorted.
     /// @property
     void SetMaxSortedInstances(int instances);
+    /// Set maximum number of auxiliary views (render surface viewports updated automatically) per frame. Surfaces that do not fit update on later frames, higher priority and longest waiting first. Default 0 is unlimited.
+    /// @property
+    void SetMaxAuxiliaryViews(int views);
     /// Set maximum number of occluder triangles.
     /// @property
     void SetMaxOccluderTriangles(int triangles);
@@ -266,6 +305,26 @@ public:
     /// Set whether to thread occluder rendering. Default false.
     /// @property
     void SetThreadedOcclusion(bool enable);
+    /// Set occlusion culling against the view's depth from previous frames, read back from the GPU. Requires asynchronous readback support and a render path with a readable depth rendertarget named "depth". Default false.
+    /// @property
+    void SetGPUOcclusion(bool enable);
+    /// Set sharing of screen buffers between non-persistent render path rendertargets that have the same size and format and whose uses within the render path do not overlap. Default true.
+    /// @property
+    void SetScreenBufferAliasing(bool enable);
+    /// Set resolution scale of views rendering to the backbuffer, from 0.25 to 1. Such views are rendered to a screen buffer of the scaled size and upscaled to the viewport with a sharpening pass, before the UI is rendered. Default 1 (full resolution.)
+    /// @property
+    void SetResolutionScale(float scale);
+    /// Set whether to adjust the resolution scale automatically to keep the GPU frame time at the target. Reads the GPU frame timestamps, so also enables GPU profiling. Effective only where GPU timing is supported. Default false.
+    /// @property
+    void SetDynamicResolution(bool enable);
+    /// Set the range of resolution scales dynamic resolution may choose from. Default 0.5 to 1.
+    void SetDynamicResolutionRange(float minScale, float maxScale);
+    /// Set the GPU frame time in milliseconds dynamic resolution aims for. Default 16.
+    /// @property
+    void SetDynamicResolutionTarget(float frameTime);
+    /// Set sharpening strength of the upscaling pass of reduced resolution views, from 0 (plain bilinear) to 1. Default 0.5.
+    /// @property
+    void SetUpscaleSharpness(float sharpness);
     /// Set shadow depth bias multiplier for mobile platforms to counteract possible worse shadow map precision. Default 1.0 (no effect).
     /// @property
     void SetMobileShadowBiasMul(float mul);
@@ -325,6 +384,18 @@ public:
     /// @property
     MaterialQuality GetMaterialQuality() const { return materialQuality_; }
 
+    /// Return memory budget of streamed textures in bytes.
+    /// @property
+    unsigned long long GetTextureStreamingBudget() const { return textureStreamingBudget_; }
+
+    /// Return scale of the resolution streamed textures are requested at.
+    /// @property
+    float GetTextureStreamingScale() const { return textureStreamingScale_; }
+
+    /// Return number of textures registered for mip streaming.
+    /// @property
+    unsigned GetNumStreamedTextures() const { return streamedTextures_.Size(); }
+
     /// Return shadow map resolution.
     /// @property
     int GetShadowMapSize() const { return shadowMapSize_; }
@@ -353,6 +424,18 @@ public:
     /// @property
     int GetMaxShadowMaps() const { return maxShadowMaps_; }
 
+    /// Return whether static shadow caster depth is cached.
+    /// @property
+    bool GetShadowMapCaching() const { return shadowMapCaching_; }
+
+    /// Return whether spot and point light shadows are rendered into the shadow map atlas.
+    /// @property
+    bool GetShadowAtlas() const { return shadowAtlas_; }
+
+    /// Return shadow map atlas width and height.
+    /// @property
+    int GetShadowAtlasSize() const { return shadowAtlasSize_; }
+
     /// Return whether dynamic instancing is in use.
     /// @property
     bool GetDynamicInstancing() const { return dynamicInstancing_; }
@@ -361,6 +444,9 @@ public:
     /// @property
     int GetNumExtraInstancingBufferElements() const { return numExtraInstancingBufferElements_; };
 
+    /// Return whether bindless instancing is in use.
+    bool GetBindlessInstancing() const;
+
     /// Return minimum number of instances required in a batch group to render as instanced.
     /// @property
     int GetMinInstances() const { return minInstances_; }
@@ -369,6 +455,10 @@ public:
     /// @property
     int GetMaxSortedInstances() const { return maxSortedInstances_; }
 
+    /// Return maximum number of auxiliary views per frame.
+    /// @property
+    int GetMaxAuxiliaryViews() const { return maxAuxiliaryViews_; }
+
     /// Return maximum number of occluder triangles.
     /// @property
     int GetMaxOccluderTriangles() const { return maxOccluderTriangles_; }
@@ -385,6 +475,38 @@ public:
     /// @property
     bool GetThreadedOcclusion() const { return threadedOcclusion_; }
 
+    /// Return whether occlusion culling against previous frames' GPU depth is enabled.
+    /// @property
+    bool GetGPUOcclusion() const { return gpuOcclusion_; }
+
+    /// Return whether non-overlapping render path rendertargets share screen buffers.
+    /// @property
+    bool GetScreenBufferAliasing() const { return screenBufferAliasing_; }
+
+    /// Return current resolution scale of views rendering to the backbuffer.
+    /// @property
+    float GetResolutionScale() const { return resolutionScale_; }
+
+    /// Return whether the resolution scale is adjusted automatically to the GPU frame time.
+    /// @property
+    bool GetDynamicResolution() const { return dynamicResolution_; }
+
+    /// Return minimum resolution scale used by dynamic resolution.
+    /// @property
+    float GetDynamicResolutionMinScale() const { return minResolutionScale_; }
+
+    /// Return maximum resolution scale used by dynamic resolution.
+    /// @property
+    float GetDynamicResolutionMaxScale() const { return maxResolutionScale_; }
+
+    /// Return GPU frame time in milliseconds dynamic resolution aims for.
+    /// @property
+    float GetDynamicResolutionTarget() const { return dynamicResolutionTarget_; }
+
+    /// Return sharpening strength of the upscaling pass.
+    /// @property
+    float GetUpscaleSharpness() const { return upscaleSharpness_; }
+
     /// Return shadow depth bias multiplier for mobile platforms.
     /// @property
     float GetMobileShadowBiasMul() const { return mobileShadowBiasMul_; }
@@ -421,6 +543,9 @@ public:
     /// Return number of occluders rendered.
     /// @property
     unsigned GetNumOccluders(bool allViews = false) const;
+    /// Return estimated screen buffer memory in bytes saved by rendertarget aliasing.
+    /// @property
+    unsigned GetAliasedScreenBufferMemory(bool allViews = false) const;
 
     /// Return the default zone.
     /// @property
@@ -460,6 +585,12 @@ public:
     void QueueRenderSurface(RenderSurface* renderTarget);
     /// Queue a viewport for rendering. Null surface means backbuffer.
     void QueueViewport(RenderSurface* renderTarget, Viewport* viewport);
+    /// Register a texture for mip streaming. Called by Texture2D.
+    /// @nobind
+    void AddStreamedTexture(Texture2D* texture);
+    /// Count the batches drawn by a scene pass into its metric. Called by View.
+    /// @nobind
+    void AddPassBatches(unsigned passIndex, const String& passName, unsigned numBatches);
 
     /// Return volume geometry for a light.
     Geometry* GetLightGeometry(Light* light);
@@ -467,21 +598,35 @@ public:
     Geometry* GetQuadGeometry();
     /// Allocate a shadow map. If shadow map reuse is disabled, a different map is returned each time.
     Texture2D* GetShadowMap(Light* light, Camera* camera, unsigned viewWidth, unsigned viewHeight);
-    /// Allocate a rendertarget or depth-stencil texture for deferred rendering or postprocessing. Should only be called during actual rendering, not before.
-    Texture* GetScreenBuffer
-        (int width, int height, unsigned format, int multiSample, bool autoResolve, bool cubemap, bool filtered, bool srgb, unsigned persistentKey = 0);
+    /// Allocate a tile of the shadow map atlas for a spot or point light and return the atlas, or null if the atlas is not in use or is full.
+    Texture2D* GetShadowAtlasTile(Light* light, Camera* camera, unsigned viewWidth, unsigned viewHeight, IntRect& tileRect);
+    /// Return the static shadow caster cache for a light and its allocated shadow map, or null if caching is not possible. Recreates the cache if the shadow map size or format changed.
+    ShadowMapCache* GetShadowMapCache(Light* light, Camera* camera, Texture2D* shadowMap);
+    /// Allocate a rendertarget or depth-stencil texture for deferred rendering or postprocessing, optionally writable by compute shaders. Should only be called during actual rendering, not before.
+    Texture* GetScreenBuffer(int width, int height, unsigned format, int multiSample, bool autoResolve, bool cubemap, bool filtered,
+        bool srgb, unsigned persistentKey = 0, bool computeAccess = false);
     /// Allocate a depth-stencil surface that does not need to be readable. Should only be called during actual rendering, not before.
     RenderSurface* GetDepthStencil(int width, int height, int multiSample, bool autoResolve);
     /// Allocate an occlusion buffer.
     OcclusionBuffer* GetOcclusionBuffer(Camera* camera);
+    /// Return the occlusion buffer built from a camera's recent GPU depth, or null if not available.
+    OcclusionBuffer* GetGPUOcclusionBuffer(Camera* camera);
+    /// Return an occlusion buffer set up with the camera's current view to receive its GPU depth, or null if a readback for the camera is still pending. Should only be called during actual rendering.
+    OcclusionBuffer* GetGPUOcclusionReadbackBuffer(Camera* camera);
+    /// Request readback of a camera's downsampled GPU depth into its readback buffer. The texture must match the readback buffer size.
+    void RequestGPUOcclusionReadback(Camera* camera, Texture2D* depthTexture);
     /// Allocate a temporary shadow camera and a scene node for it. Is thread-safe.
     Camera* GetShadowCamera();
     /// Mark a view as prepared by the specified culling camera.
     void StorePreparedView(View* view, Camera* camera);
     /// Return a prepared view if exists for the specified camera. Used to avoid duplicate view preparation CPU work.
     View* GetPreparedView(Camera* camera);
-    /// Choose shaders for a forward rendering batch. The related batch queue is provided in case it has extra shader compilation defines.
+    /// Choose shaders for a forward rendering batch. The related batch queue is provided in case it has extra shader compilation defines. The technique is only used for error reporting and may be null.
     void SetBatchShaders(Batch& batch, Technique* tech, bool allowShadows, const BatchQueue& queue);
+    /// Switch an instanced batch's shaders to their bindless diffuse texture variations. Does nothing if already switched.
+    void SetBindlessBatchShaders(Batch& batch);
+    /// Return whether a pass has its shaders loaded for a batch queue. If true, SetBatchShaders() may be called from worker threads.
+    bool HasBatchShaders(Pass* pass, const BatchQueue& queue) const;
     /// Choose shaders for a deferred light volume batch.
     void SetLightVolumeBatchShaders
         (Batch& batch, Camera* camera, const String& vsName, const String& psName, const String& vsDefines, const String& psDefines);
@@ -489,6 +634,8 @@ public:
     void SetCullMode(CullMode mode, Camera* camera);
     /// Ensure sufficient size of the instancing vertex buffer. Return true if successful.
     bool ResizeInstancingBuffer(unsigned numInstances);
+    /// Reserve a range of the instancing vertex buffer for the current frame and return its first instance, or M_MAX_UNSIGNED if it does not fit. Growth to fit the whole frame is deferred to the next frame so that ranges already written stay valid.
+    unsigned AllocateInstancingBuffer(unsigned numInstances);
     /// Optimize a light by scissor rectangle.
     void OptimizeLightByScissor(Light* light, Camera* camera);
     /// Optimize a light by marking it to the stencil buffer and setting a stencil test.
@@ -514,12 +661,28 @@ private:
     void CreateGeometries();
     /// Create instancing vertex buffer.
     void CreateInstancingBuffer();
+    /// Return number of instancing buffer elements in addition to the world transform.
+    unsigned GetNumInstancingBufferExtraElements() const;
     /// Create point light shadow indirection texture data.
     void SetIndirectionTextureData();
+    /// Return the shadow map face size of a light, reduced by its screen coverage if auto-sizing is enabled.
+    int GetShadowMapFaceSize(Light* light, Camera* camera, unsigned viewWidth, unsigned viewHeight) const;
+    /// Create a shadow map texture in the current shadow quality's format. The size is halved on failure. Return null if failed altogether.
+    SharedPtr<Texture2D> CreateShadowMap(int width, int height);
+    /// Queue the viewports of the queued render surfaces that are due for update, within the auxiliary view limit.
+    void ScheduleRenderSurfaces();
+    /// Queue the viewports of a render surface and record its update frame.
+    void UpdateRenderSurface(RenderSurface* renderTarget);
     /// Update a queued viewport for rendering.
     void UpdateQueuedViewport(unsigned index);
+    /// Adjust the resolution scale to the last measured GPU frame time.
+    void UpdateDynamicResolution();
+    /// Choose the resident mips of the streamed textures from the frame's resolution requests and the budget, and queue their reloads.
+    void UpdateTextureStreaming();
     /// Prepare for rendering of a new view.
     void PrepareViewRender();
+    /// Publish the statistics of the rendered frame to the metrics registry.
+    void UpdateMetrics();
     /// Remove unused occlusion and screen buffers.
     void RemoveUnusedBuffers();
     /// Reset shadow map allocation counts.
@@ -536,6 +699,8 @@ private:
     void HandleScreenMode(StringHash eventType, VariantMap& eventData);
     /// Handle render update event.
     void HandleRenderUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle GPU readback completion event.
+    void HandleReadbackComplete(StringHash eventType, VariantMap& eventData);
     /// Blur the shadow map.
     void BlurShadowMap(View* view, Texture2D* shadowMap, float blurScale);
 
@@ -569,12 +734,20 @@ private:
     Vector<SharedPtr<Node> > shadowCameraNodes_;
     /// Reusable occlusion buffers.
     Vector<SharedPtr<OcclusionBuffer> > occlusionBuffers_;
+    /// GPU depth occlusion data by camera.
+    HashMap<Camera*, GPUOcclusionState> gpuOcclusionStates_;
     /// Shadow maps by resolution.
     HashMap<int, Vector<SharedPtr<Texture2D> > > shadowMaps_;
     /// Shadow map dummy color buffers by resolution.
     HashMap<int, SharedPtr<Texture2D> > colorShadowMaps_;
     /// Shadow map allocations by resolution.
     HashMap<int, PODVector<Light*> > shadowMapAllocations_;
+    /// Static shadow caster caches by light and view camera.
+    HashMap<Pair<Light*, Camera*>, ShadowMapCache> shadowMapCaches_;
+    /// Shadow map atlas for spot and point lights.
+    SharedPtr<Texture2D> shadowAtlasTexture_;
+    /// Shadow map atlas tile allocator. Reset for each view.
+    AreaAllocator shadowAtlasAllocator_;
     /// Instance of shadow map filter.
     Object* shadowMapFilterInstance_{};
     /// Function pointer of shadow map filter.
@@ -587,18 +760,22 @@ private:
     HashMap<Pair<Light*, Camera*>, Rect> lightScissorCache_;
     /// Backbuffer viewports.
     Vector<SharedPtr<Viewport> > viewports_;
+    /// Render surfaces queued for update, before scheduling.
+    Vector<WeakPtr<RenderSurface> > queuedRenderSurfaces_;
     /// Render surface viewports queued for update.
     Vector<Pair<WeakPtr<RenderSurface>, WeakPtr<Viewport> > > queuedViewports_;
     /// Views that have been processed this frame.
     Vector<WeakPtr<View> > views_;
     /// Prepared views by culling camera.
     HashMap<Camera*, WeakPtr<View> > preparedViews_;
+    /// Textures registered for mip streaming.
+    Vector<WeakPtr<Texture2D> > streamedTextures_;
     /// Octrees that have been updated during the frame.
     HashSet<Octree*> updatedOctrees_;
     /// Techniques for which missing shader error has been displayed.
     HashSet<Technique*> shaderErrorDisplayed_;
-    /// Mutex for shadow camera allocation.
-    Mutex rendererMutex_;
+    /// Mutex for shadow camera allocation and shader error reporting.
+    Mutex rendererMutex_{"Renderer"};
     /// Current variation names for deferred light volume shaders.
     Vector<String> deferredLightPSVariations_;
     /// Frame info for rendering.
@@ -611,6 +788,10 @@ private:
     MaterialQuality textureQuality_{QUALITY_HIGH};
     /// Material quality level.
     MaterialQuality materialQuality_{QUALITY_HIGH};
+    /// Memory budget of streamed textures.
+    unsigned long long textureStreamingBudget_{};
+    /// Scale of the resolution streamed textures are requested at.
+    float textureStreamingScale_{1.0f};
     /// Shadow map resolution.
     int shadowMapSize_{1024};
     /// Shadow quality.
@@ -627,6 +808,8 @@ private:
     int minInstances_{2};
     /// Maximum sorted instances per batch group.
     int maxSortedInstances_{1000};
+    /// Maximum auxiliary views per frame.
+    int maxAuxiliaryViews_{};
     /// Maximum occluder triangles.
     int maxOccluderTriangles_{5000};
     /// Occlusion buffer width.
@@ -647,6 +830,20 @@ private:
     unsigned numPrimitives_{};
     /// Number of batches (3D geometry only).
     unsigned numBatches_{};
+    /// Frame statistic gauges: views, batches, primitives, lights, shadow maps and occluders.
+    SharedPtr<Metric> frameMetrics_[6];
+    /// Pipeline state cache miss metric.
+    SharedPtr<Metric> pipelineStateMissesMetric_;
+    /// Batch count metrics by scene pass index.
+    HashMap<unsigned, SharedPtr<Metric> > passBatchMetrics_;
+    /// Pipeline state cache misses at the end of the last frame.
+    unsigned lastPipelineStateMisses_{};
+    /// Instances reserved from the instancing buffer on the current frame.
+    unsigned instancingBufferOffset_{};
+    /// Instances requested from the instancing buffer on the current frame, including ranges that did not fit.
+    unsigned instancingBufferDemand_{};
+    /// Frame number of the instancing buffer ranges.
+    unsigned instancingBufferFrameNumber_{M_MAX_UNSIGNED};
     /// Frame number on which shaders last changed.
     unsigned shadersChangedFrameNumber_{M_MAX_UNSIGNED};
     /// Current stencil value for light optimization.
@@ -659,12 +856,38 @@ private:
     bool drawShadows_{true};
     /// Shadow map reuse flag.
     bool reuseShadowMaps_{true};
+    /// Static shadow caster caching flag.
+    bool shadowMapCaching_{};
+    /// Shadow map atlas flag.
+    bool shadowAtlas_{};
+    /// Shadow map atlas size.
+    int shadowAtlasSize_{4096};
     /// Dynamic instancing flag.
     bool dynamicInstancing_{true};
     /// Number of extra instancing data elements.
     int numExtraInstancingBufferElements_{};
+    /// Bindless instancing flag.
+    bool bindlessInstancing_{};
     /// Threaded occlusion rendering flag.
     bool threadedOcclusion_{};
+    /// GPU depth occlusion flag.
+    bool gpuOcclusion_{};
+    /// Screen buffer aliasing flag.
+    bool screenBufferAliasing_{true};
+    /// Dynamic resolution flag.
+    bool dynamicResolution_{};
+    /// Resolution scale of views rendering to the backbuffer.
+    float resolutionScale_{1.0f};
+    /// Minimum dynamic resolution scale.
+    float minResolutionScale_{0.5f};
+    /// Maximum dynamic resolution scale.
+    float maxResolutionScale_{1.0f};
+    /// Target GPU frame time of dynamic resolution in milliseconds.
+    float dynamicResolutionTarget_{16.0f};
+    /// Upscaling pass sharpening strength.
+    float upscaleSharpness_{0.5f};
+    /// Frames to skip before the GPU frame time reflects the last resolution scale change.
+    unsigned resolutionSettleFrames_{};
     /// Shaders need reloading flag.
     bool shadersDirty_{true};
     /// Initialized flag.
@@ -23,12 +23,14 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/Thread.h"
 #include "../Graphics/RibbonTrail.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../Graphics/IndexBuffer.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/Material.h"
 #include "../Graphics/OctreeQuery.h"
+#include "../Graphics/SignificanceManager.h"
 #include "../Graphics/Geometry.h"
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
@@ -77,6 +79,7 @@ RibbonTrail::RibbonTrail(Context* context) :
     startScale_(1.0f),
     endScale_(1.0f),
     lastTimeStep_(0.0f),
+    updateAccumulator_(0.0f),
     endColor_(Color(1.0f, 1.0f, 1.0f, 0.0f)),
     startColor_(Color(1.0f, 1.0f, 1.0f, 1.0f)),
     lastUpdateFrameNumber_(M_MAX_UNSIGNED),
@@ -87,8 +90,10 @@ RibbonTrail::RibbonTrail(Context* context) :
     trailType_(TT_FACE_CAMERA),
     tailColumn_(1),
     updateInvisible_(false),
+    significanceUpdate_(false),
     emitting_(true),
-    startEndTailTime_(0.0f)
+    startEndTailTime_(0.0f),
+    pendingVertices_(0)
 {
     geometry_->SetVertexBuffer(0, vertexBuffer_);
     geometry_->SetIndexBuffer(indexBuffer_);
@@ -111,6 +116,7 @@ void RibbonTrail::RegisterObject(Context* context)
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Material", GetMaterialAttr, SetMaterialAttr, ResourceRef, ResourceRef(Material::GetTypeStatic()), AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Emitting", IsEmitting, SetEmitting, bool, true, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Update Invisible", GetUpdateInvisible, SetUpdateInvisible, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Significance Update", GetSignificanceUpdate, SetSignificanceUpdate, bool, false, AM_DEFAULT);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Trail Type", GetTrailType, SetTrailType, TrailType, trailTypeNames, TT_FACE_CAMERA, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Base Velocity", GetBaseVelocity, SetBaseVelocity, Vector3, Vector3::ZERO, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Tail Lifetime", GetLifetime, SetLifetime, float, 1.0f, AM_DEFAULT);
@@ -193,8 +199,13 @@ void RibbonTrail::HandleScenePostUpdate(StringHash eventType, VariantMap& eventD
         }
 
         lastUpdateFrameNumber_ = viewFrameNumber_;
-        needUpdate_ = true;
-        MarkForUpdate();
+
+        // With significance update, insignificant trails skip frames and then advance by the accumulated time at once
+        if (!significanceUpdate_ || SignificanceManager::CheckUpdate(this, lastTimeStep_, updateAccumulator_))
+        {
+            needUpdate_ = true;
+            MarkForUpdate();
+        }
     }
 }
 
@@ -205,7 +216,7 @@ void RibbonTrail::Update(const FrameInfo &frame)
     if (!needUpdate_)
         return;
 
-    UpdateTail(frame.timeStep_);
+    UpdateTail(significanceUpdate_ ? lastTimeStep_ : frame.timeStep_);
     OnMarkedDirty(node_);
     needUpdate_ = false;
 }
@@ -401,12 +412,25 @@ void RibbonTrail::UpdateGeometry(const FrameInfo& frame)
 
     if (bufferDirty_ || vertexBuffer_->IsDataLost())
         UpdateVertexBuffer(frame);
+
+    // In a worker thread the upload is left to FinishUpdateGeometry()
+    if (pendingVertices_ && Thread::IsMainThread())
+        UploadVertexBuffer();
+}
+
+void RibbonTrail::FinishUpdateGeometry(const FrameInfo& frame)
+{
+    if (pendingVertices_)
+        UploadVertexBuffer();
 }
 
 UpdateGeometryType RibbonTrail::GetUpdateGeometryType()
 {
-    if (bufferDirty_ || bufferSizeDirty_ || vertexBuffer_->IsDataLost() || indexBuffer_->IsDataLost())
+    // Resizing the buffers needs the GPU, but the vertices can be generated in a worker thread
+    if (bufferSizeDirty_ || indexBuffer_->IsDataLost())
         return UPDATE_MAIN_THREAD;
+    else if (bufferDirty_ || vertexBuffer_->IsDataLost())
+        return UPDATE_WORKER_THREAD;
     else
         return UPDATE_NONE;
 }
@@ -575,9 +599,9 @@ void RibbonTrail::UpdateVertexBuffer(const FrameInfo& frame)
     bufferDirty_ = false;
     forceUpdate_ = false;
 
-    auto* dest = (float*)vertexBuffer_->Lock(0, (numPoints_ - 1) * vertexPerSegment, true);
-    if (!dest)
-        return;
+    pendingVertices_ = (numPoints_ - 1) * vertexPerSegment;
+    vertexData_.Resize(pendingVertices_ * vertexBuffer_->GetVertexSize() / sizeof(float));
+    float* dest = vertexData_.Buffer();
 
     // Generate trail mesh
     if (trailType_ == TT_FACE_CAMERA)
@@ -804,9 +828,13 @@ void RibbonTrail::UpdateVertexBuffer(const FrameInfo& frame)
             dest += 26;
         }
     }
+}
 
-    vertexBuffer_->Unlock();
+void RibbonTrail::UploadVertexBuffer()
+{
+    vertexBuffer_->SetDataRange(vertexData_.Buffer(), 0, pendingVertices_, true);
     vertexBuffer_->ClearDataLost();
+    pendingVertices_ = 0;
 }
 
 void RibbonTrail::SetLifetime(float time)
@@ -886,6 +914,13 @@ void RibbonTrail::SetUpdateInvisible(bool enable)
     MarkNetworkUpdate();
 }
 
+void RibbonTrail::SetSignificanceUpdate(bool enable)
+{
+    significanceUpdate_ = enable;
+    updateAccumulator_ = 0.0f;
+    MarkNetworkUpdate();
+}
+
 void RibbonTrail::Commit()
 {
     MarkPositionsDirty();
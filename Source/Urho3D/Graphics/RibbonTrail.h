@@ -84,6 +84,8 @@ public:
     void UpdateBatches(const FrameInfo& frame) override;
     /// Prepare geometry for rendering. Called from a worker thread if possible (no GPU update).
     void UpdateGeometry(const FrameInfo& frame) override;
+    /// Upload the vertices generated in a worker thread. Called from the main thread.
+    void FinishUpdateGeometry(const FrameInfo& frame) override;
     /// Return whether a geometry update is necessary, and if it can happen in a worker thread.
     UpdateGeometryType GetUpdateGeometryType() override;
 
@@ -134,6 +136,9 @@ public:
     /// Set animation LOD bias.
     /// @property
     void SetAnimationLodBias(float bias);
+    /// Set whether trails update less often when the node is insignificant to the viewer. Requires a SignificanceManager in the scene.
+    /// @property
+    void SetSignificanceUpdate(bool enable);
     /// Mark for bounding box and vertex buffer update. Call after modifying the trails.
     void Commit();
 
@@ -200,6 +205,10 @@ public:
     /// @property
     bool GetUpdateInvisible() const { return updateInvisible_; }
 
+    /// Return whether the update rate follows the node's significance.
+    /// @property
+    bool GetSignificanceUpdate() const { return significanceUpdate_; }
+
 protected:
     /// Handle node being assigned.
     void OnSceneSet(Scene* scene) override;
@@ -226,8 +235,10 @@ private:
 
     /// Resize RibbonTrail vertex and index buffers.
     void UpdateBufferSize();
-    /// Rewrite RibbonTrail vertex buffer.
+    /// Generate RibbonTrail vertices into the CPU-side vertex data. May be called from a worker thread.
     void UpdateVertexBuffer(const FrameInfo& frame);
+    /// Upload the generated vertex data to the vertex buffer.
+    void UploadVertexBuffer();
     /// Update/Rebuild tail mesh only if position changed (called by UpdateBatches()).
     void UpdateTail(float timeStep);
     /// Geometry.
@@ -260,6 +271,8 @@ private:
     float endScale_;
     /// Last scene timestep.
     float lastTimeStep_;
+    /// Time accumulated between significance throttled updates.
+    float updateAccumulator_;
     /// Lifetime.
     float lifetime_;
     /// Number of columns for every tails.
@@ -278,11 +291,17 @@ private:
     bool emitting_;
     /// Update when invisible flag.
     bool updateInvisible_;
+    /// Significance update flag.
+    bool significanceUpdate_;
 
     /// End of trail point for smoother tail disappearance.
     TrailPoint endTail_;
     /// The time the tail become end of trail.
     float startEndTailTime_;
+    /// Generated vertex data waiting for upload.
+    PODVector<float> vertexData_;
+    /// Number of generated vertices waiting for upload.
+    unsigned pendingVertices_;
 };
 
 }
@@ -0,0 +1,855 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/Geometry.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Model.h"
+#include "../Graphics/OcclusionBuffer.h"
+#include "../Graphics/OctreeQuery.h"
+#include "../Graphics/Renderer.h"
+#include "../Graphics/ScatterModel.h"
+#include "../Graphics/Terrain.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../IO/VectorBuffer.h"
+#include "../Resource/Image.h"
+#include "../Resource/ResourceCache.h"
+#include "../Resource/ResourceEvents.h"
+#include "../Scene/Scene.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+extern const char* GEOMETRY_CATEGORY;
+
+static const float DEFAULT_CELL_SIZE = 32.0f;
+static const Rect DEFAULT_SCATTER_AREA(Vector2(-50.0f, -50.0f), Vector2(50.0f, 50.0f));
+static const Vector2 DEFAULT_SCALE_RANGE(1.0f, 1.0f);
+static const float DEFAULT_MAX_SLOPE = 90.0f;
+/// Maximum number of cells along each axis. Larger areas use larger cells.
+static const int MAX_CELLS_PER_AXIS = 256;
+/// Maximum number of candidate positions when scattering.
+static const unsigned MAX_SCATTER_CANDIDATES = 4 * 1024 * 1024;
+/// Maximum number of batches, limited by the base pass flags having a bit per batch.
+static const unsigned MAX_SCATTER_BATCHES = 32;
+
+/// Advance a xorshift random number state. Scattering uses its own generator so that the results do not depend on the global random seed.
+static inline unsigned NextRandom(unsigned& state)
+{
+    state ^= state << 13u;
+    state ^= state >> 17u;
+    state ^= state << 5u;
+    return state;
+}
+
+/// Return a random number between 0 and 1 from a xorshift random number state.
+static inline float RandomUnit(unsigned& state)
+{
+    return (float)(NextRandom(state) >> 8u) * (1.0f / 16777216.0f);
+}
+
+/// Return the LOD level of a geometry at a LOD distance.
+static inline unsigned GetInstanceLodLevel(const Vector<SharedPtr<Geometry> >& lodGeometries, float lodDistance)
+{
+    unsigned i;
+    for (i = 1; i < lodGeometries.Size(); ++i)
+    {
+        if (lodGeometries[i] && lodDistance <= lodGeometries[i]->GetLodDistance())
+            break;
+    }
+
+    return i - 1;
+}
+
+ScatterModel::ScatterModel(Context* context) :
+    Drawable(context, DRAWABLE_GEOMETRY),
+    appliedCullResult_(nullptr),
+    scatterArea_(DEFAULT_SCATTER_AREA),
+    scaleRange_(DEFAULT_SCALE_RANGE),
+    materialsAttr_(Material::GetTypeStatic()),
+    cellSize_(DEFAULT_CELL_SIZE),
+    scatterDensity_(0.0f),
+    maxSlope_(DEFAULT_MAX_SLOPE),
+    lodScale_(0.0f),
+    worldRadius_(0.0f),
+    numVisible_(0),
+    numLodLevels_(1),
+    scatterSeed_(0),
+    alignToGround_(false),
+    projectToTerrain_(false),
+    cellsDirty_(false),
+    scatterDirty_(false)
+{
+    boundingBox_ = BoundingBox(Vector3::ZERO, Vector3::ZERO);
+}
+
+ScatterModel::~ScatterModel() = default;
+
+void ScatterModel::RegisterObject(Context* context)
+{
+    context->RegisterFactory<ScatterModel>(GEOMETRY_CATEGORY);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Model", GetModelAttr, SetModelAttr, ResourceRef, ResourceRef(Model::GetTypeStatic()), AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Material", GetMaterialsAttr, SetMaterialsAttr, ResourceRefList, ResourceRefList(Material::GetTypeStatic()),
+        AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cell Size", GetCellSize, SetCellSize, float, DEFAULT_CELL_SIZE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Scatter Area", GetScatterArea, SetScatterArea, Rect, DEFAULT_SCATTER_AREA, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Scatter Density", GetScatterDensity, SetScatterDensity, float, 0.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Scatter Seed", GetScatterSeed, SetScatterSeed, unsigned, 0, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Scale Range", GetScaleRange, SetScaleRange, Vector2, DEFAULT_SCALE_RANGE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Slope", GetMaxSlope, SetMaxSlope, float, DEFAULT_MAX_SLOPE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Align To Ground", GetAlignToGround, SetAlignToGround, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Project To Terrain", GetProjectToTerrain, SetProjectToTerrain, bool, false, AM_DEFAULT);
+    URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Density Map", GetDensityMapAttr, SetDensityMapAttr, ResourceRef, ResourceRef(Image::GetTypeStatic()),
+        AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Can Be Occluded", IsOccludee, SetOccludee, bool, true, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Cast Shadows", bool, castShadows_, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Draw Distance", GetDrawDistance, SetDrawDistance, float, 0.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Shadow Distance", GetShadowDistance, SetShadowDistance, float, 0.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("LOD Bias", GetLodBias, SetLodBias, float, 1.0f, AM_DEFAULT);
+    URHO3D_COPY_BASE_ATTRIBUTES(Drawable);
+    URHO3D_ACCESSOR_ATTRIBUTE("Instances", GetInstancesAttr, SetInstancesAttr, PODVector<unsigned char>, Variant::emptyBuffer,
+        AM_FILE | AM_NOEDIT);
+}
+
+void ScatterModel::ProcessRayQuery(const RayOctreeQuery& query, PODVector<RayQueryResult>& results)
+{
+    RayQueryLevel level = query.level_;
+    if (level < RAY_OBB)
+    {
+        Drawable::ProcessRayQuery(query, results);
+        return;
+    }
+
+    // GetWorldBoundingBox() updates the cell bounding boxes
+    if (query.ray_.HitDistance(GetWorldBoundingBox()) >= query.maxDistance_)
+        return;
+
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+
+    for (unsigned i = 0; i < cells_.Size(); ++i)
+    {
+        if (query.ray_.HitDistance(cellWorldBoxes_[i]) >= query.maxDistance_)
+            continue;
+
+        const ScatterCell& cell = cells_[i];
+        for (unsigned j = cell.start_; j < cell.start_ + cell.count_; ++j)
+        {
+            unsigned index = cellInstances_[j];
+            const ScatterInstance& instance = instances_[index];
+            Matrix3x4 transform = worldTransform * Matrix3x4(instance.position_, instance.rotation_, instance.scale_);
+            Ray localRay = query.ray_.Transformed(transform.Inverse());
+            float distance = localRay.HitDistance(boundingBox_);
+            Vector3 normal = -query.ray_.direction_;
+
+            if (level >= RAY_TRIANGLE && distance < query.maxDistance_)
+            {
+                distance = M_INFINITY;
+
+                for (unsigned k = 0; k < geometries_.Size(); ++k)
+                {
+                    Geometry* geometry = geometries_[k][0];
+                    if (geometry)
+                    {
+                        Vector3 geometryNormal;
+                        float geometryDistance = geometry->GetHitDistance(localRay, &geometryNormal);
+                        if (geometryDistance < query.maxDistance_ && geometryDistance < distance)
+                        {
+                            distance = geometryDistance;
+                            normal = (transform * Vector4(geometryNormal, 0.0f)).Normalized();
+                        }
+                    }
+                }
+            }
+
+            if (distance < query.maxDistance_)
+            {
+                RayQueryResult result;
+                result.position_ = query.ray_.origin_ + distance * query.ray_.direction_;
+                result.normal_ = normal;
+                result.distance_ = distance;
+                result.drawable_ = this;
+                result.node_ = node_;
+                result.subObject_ = index;
+                results.Push(result);
+            }
+        }
+    }
+}
+
+void ScatterModel::Update(const FrameInfo& frame)
+{
+    // Only this component's own data is touched, so scattering and sorting into cells can be done here in the worker thread
+    if (scatterDirty_)
+    {
+        if (scatterDensity_ > 0.0f)
+        {
+            GenerateInstances();
+            cellsDirty_ = true;
+        }
+        scatterDirty_ = false;
+    }
+
+    if (cellsDirty_)
+    {
+        UpdateCells();
+        worldBoundingBoxDirty_ = true;
+    }
+}
+
+void ScatterModel::UpdateBatches(const FrameInfo& frame)
+{
+    // Getting the world bounding box ensures the cell bounding boxes are updated
+    GetWorldBoundingBox();
+
+    MutexLock lock(cullMutex_);
+
+    ScatterCullResult* result = GetCullResult(frame);
+    if (result->frameNumber_ != frame.frameNumber_)
+    {
+        CullInstances(frame, *result);
+        appliedCullResult_ = nullptr;
+    }
+
+    // Shadow caster updates for the same camera may run in other threads while they read the batches, so only touch them when
+    // switching to another result
+    if (result != appliedCullResult_)
+    {
+        batches_ = result->batches_;
+        appliedCullResult_ = result;
+    }
+
+    distance_ = result->distance_;
+    numVisible_ = result->numVisible_;
+}
+
+Geometry* ScatterModel::GetLodGeometry(unsigned batchIndex, unsigned level)
+{
+    // The batches change with the visible LOD levels, so index by geometry instead
+    if (batchIndex >= geometries_.Size())
+        return nullptr;
+
+    const Vector<SharedPtr<Geometry> >& lodGeometries = geometries_[batchIndex];
+    return lodGeometries[Min(level, lodGeometries.Size() - 1)];
+}
+
+void ScatterModel::SetModel(Model* model)
+{
+    if (model == model_)
+        return;
+
+    // Unsubscribe from the reload event of previous model (if any), then subscribe to the new
+    if (model_)
+        UnsubscribeFromEvent(model_, E_RELOADFINISHED);
+
+    model_ = model;
+    geometries_.Clear();
+    numLodLevels_ = 1;
+
+    if (model)
+    {
+        SubscribeToEvent(model, E_RELOADFINISHED, URHO3D_HANDLER(ScatterModel, HandleModelReloadFinished));
+
+        // Ensure that each geometry has at least one LOD level
+        geometries_ = model->GetGeometries();
+        for (unsigned i = 0; i < geometries_.Size(); ++i)
+        {
+            if (!geometries_[i].Size())
+                geometries_[i].Resize(1);
+            numLodLevels_ = Max(numLodLevels_, geometries_[i].Size());
+        }
+
+        boundingBox_ = model->GetBoundingBox();
+    }
+    else
+        boundingBox_ = BoundingBox(Vector3::ZERO, Vector3::ZERO);
+
+    materials_.Resize(geometries_.Size());
+    ResetCullResults();
+    MarkCellsDirty();
+}
+
+void ScatterModel::SetMaterial(Material* material)
+{
+    for (unsigned i = 0; i < materials_.Size(); ++i)
+        materials_[i] = material;
+
+    ResetCullResults();
+    MarkNetworkUpdate();
+}
+
+bool ScatterModel::SetMaterial(unsigned index, Material* material)
+{
+    if (index >= materials_.Size())
+    {
+        URHO3D_LOGERROR("Material index out of bounds");
+        return false;
+    }
+
+    materials_[index] = material;
+    ResetCullResults();
+    MarkNetworkUpdate();
+    return true;
+}
+
+void ScatterModel::SetCellSize(float size)
+{
+    cellSize_ = Max(size, M_EPSILON);
+    MarkCellsDirty();
+}
+
+void ScatterModel::AddInstance(const Vector3& position, const Quaternion& rotation, float scale)
+{
+    ScatterInstance instance;
+    instance.position_ = position;
+    instance.rotation_ = rotation;
+    instance.scale_ = scale;
+    instances_.Push(instance);
+    MarkCellsDirty();
+}
+
+void ScatterModel::RemoveInstance(unsigned index)
+{
+    if (index >= instances_.Size())
+        return;
+
+    instances_.Erase(index);
+    MarkCellsDirty();
+}
+
+void ScatterModel::RemoveAllInstances()
+{
+    instances_.Clear();
+    MarkCellsDirty();
+}
+
+void ScatterModel::SetInstances(const PODVector<ScatterInstance>& instances)
+{
+    instances_ = instances;
+    MarkCellsDirty();
+}
+
+void ScatterModel::SetScatterArea(const Rect& area)
+{
+    scatterArea_ = area;
+    scatterDirty_ = true;
+    MarkCellsDirty();
+}
+
+void ScatterModel::SetScatterDensity(float density)
+{
+    scatterDensity_ = Max(density, 0.0f);
+    scatterDirty_ = true;
+    MarkCellsDirty();
+}
+
+void ScatterModel::SetScatterSeed(unsigned seed)
+{
+    scatterSeed_ = seed;
+    scatterDirty_ = true;
+    MarkCellsDirty();
+}
+
+void ScatterModel::SetScaleRange(const Vector2& range)
+{
+    scaleRange_ = range;
+    scatterDirty_ = true;
+    MarkCellsDirty();
+}
+
+void ScatterModel::SetMaxSlope(float angle)
+{
+    maxSlope_ = Clamp(angle, 0.0f, 90.0f);
+    scatterDirty_ = true;
+    MarkCellsDirty();
+}
+
+void ScatterModel::SetAlignToGround(bool enable)
+{
+    alignToGround_ = enable;
+    scatterDirty_ = true;
+    MarkCellsDirty();
+}
+
+void ScatterModel::SetProjectToTerrain(bool enable)
+{
+    projectToTerrain_ = enable;
+    scatterDirty_ = true;
+    MarkCellsDirty();
+}
+
+void ScatterModel::SetDensityMap(Image* image)
+{
+    if (image && image->IsCompressed())
+    {
+        URHO3D_LOGERROR("Can not use a compressed image as a scatter density map");
+        return;
+    }
+
+    densityMap_ = image;
+    scatterDirty_ = true;
+    MarkCellsDirty();
+}
+
+void ScatterModel::Scatter()
+{
+    GenerateInstances();
+    scatterDirty_ = false;
+    MarkCellsDirty();
+}
+
+Material* ScatterModel::GetMaterial(unsigned index) const
+{
+    return index < materials_.Size() ? materials_[index] : nullptr;
+}
+
+Image* ScatterModel::GetDensityMap() const
+{
+    return densityMap_;
+}
+
+void ScatterModel::SetModelAttr(const ResourceRef& value)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    SetModel(cache->GetResource<Model>(value.name_));
+}
+
+void ScatterModel::SetMaterialsAttr(const ResourceRefList& value)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    for (unsigned i = 0; i < value.names_.Size(); ++i)
+        SetMaterial(i, cache->GetResource<Material>(value.names_[i]));
+}
+
+void ScatterModel::SetDensityMapAttr(const ResourceRef& value)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    SetDensityMap(cache->GetResource<Image>(value.name_));
+}
+
+void ScatterModel::SetInstancesAttr(const PODVector<unsigned char>& value)
+{
+    MemoryBuffer buf(value);
+    instances_ = buf.ReadPODVector<ScatterInstance>();
+    MarkCellsDirty();
+}
+
+ResourceRef ScatterModel::GetModelAttr() const
+{
+    return GetResourceRef(model_, Model::GetTypeStatic());
+}
+
+const ResourceRefList& ScatterModel::GetMaterialsAttr() const
+{
+    materialsAttr_.names_.Resize(materials_.Size());
+    for (unsigned i = 0; i < materials_.Size(); ++i)
+        materialsAttr_.names_[i] = GetResourceName(materials_[i]);
+
+    return materialsAttr_;
+}
+
+ResourceRef ScatterModel::GetDensityMapAttr() const
+{
+    return GetResourceRef(densityMap_, Image::GetTypeStatic());
+}
+
+const PODVector<unsigned char>& ScatterModel::GetInstancesAttr() const
+{
+    // Procedurally scattered instances are not saved, as they are scattered again on load
+    instancesAttr_.Clear();
+    if (scatterDensity_ <= 0.0f && instances_.Size())
+    {
+        VectorBuffer buf;
+        buf.WritePODVector(instances_);
+        instancesAttr_ = buf.GetBuffer();
+    }
+
+    return instancesAttr_;
+}
+
+void ScatterModel::OnSceneSet(Scene* scene)
+{
+    Drawable::OnSceneSet(scene);
+
+    // The update could not be queued before being in an octree
+    if (scene && (cellsDirty_ || scatterDirty_))
+        MarkForUpdate();
+}
+
+void ScatterModel::OnWorldBoundingBoxUpdate()
+{
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    Vector3 worldScale = worldTransform.Scale();
+    float maxScale = Max(Max(worldScale.x_, worldScale.y_), worldScale.z_);
+
+    lodScale_ = boundingBox_.Size().DotProduct(DOT_SCALE) * maxScale;
+    worldRadius_ = boundingBox_.HalfSize().Length() * maxScale;
+
+    // May be called from several worker threads simultaneously, so only write values that do not depend on the caller
+    for (unsigned i = 0; i < cells_.Size(); ++i)
+        cellWorldBoxes_[i] = cells_[i].boundingBox_.Transformed(worldTransform);
+
+    worldBoundingBox_ = instancesBoundingBox_.Defined() ? instancesBoundingBox_.Transformed(worldTransform) : BoundingBox();
+}
+
+void ScatterModel::MarkCellsDirty()
+{
+    cellsDirty_ = true;
+    MarkForUpdate();
+    MarkNetworkUpdate();
+}
+
+void ScatterModel::UpdateCells()
+{
+    URHO3D_PROFILE(UpdateScatterCells);
+
+    cells_.Clear();
+    cellInstances_.Clear();
+    instancesBoundingBox_.Clear();
+    cellsDirty_ = false;
+
+    if (instances_.Empty())
+    {
+        cellWorldBoxes_.Clear();
+        return;
+    }
+
+    Rect area;
+    for (unsigned i = 0; i < instances_.Size(); ++i)
+        area.Merge(Vector2(instances_[i].position_.x_, instances_[i].position_.z_));
+
+    Vector2 areaSize = area.Size();
+    float size = Max(cellSize_, Max(areaSize.x_, areaSize.y_) / MAX_CELLS_PER_AXIS);
+    int numX = Min(FloorToInt(areaSize.x_ / size) + 1, MAX_CELLS_PER_AXIS);
+    int numZ = Min(FloorToInt(areaSize.y_ / size) + 1, MAX_CELLS_PER_AXIS);
+    auto numGridCells = (unsigned)(numX * numZ);
+
+    // Counting sort of the instance indices by grid cell
+    PODVector<unsigned> instanceCells(instances_.Size());
+    PODVector<unsigned> cellStarts(numGridCells + 1);
+    for (unsigned i = 0; i <= numGridCells; ++i)
+        cellStarts[i] = 0;
+
+    for (unsigned i = 0; i < instances_.Size(); ++i)
+    {
+        const Vector3& position = instances_[i].position_;
+        int x = Min(FloorToInt((position.x_ - area.min_.x_) / size), numX - 1);
+        int z = Min(FloorToInt((position.z_ - area.min_.y_) / size), numZ - 1);
+        instanceCells[i] = (unsigned)(z * numX + x);
+        ++cellStarts[instanceCells[i] + 1];
+    }
+
+    for (unsigned i = 1; i <= numGridCells; ++i)
+        cellStarts[i] += cellStarts[i - 1];
+
+    cellInstances_.Resize(instances_.Size());
+    PODVector<unsigned> cellFill(cellStarts.Buffer(), numGridCells);
+    for (unsigned i = 0; i < instances_.Size(); ++i)
+        cellInstances_[cellFill[instanceCells[i]]++] = i;
+
+    // Bound each instance by the model's bounding sphere, which avoids transforming the box corners of every instance
+    Vector3 modelCenter = boundingBox_.Center();
+    float modelRadius = boundingBox_.HalfSize().Length();
+
+    for (unsigned i = 0; i < numGridCells; ++i)
+    {
+        unsigned start = cellStarts[i];
+        unsigned count = cellStarts[i + 1] - start;
+        if (!count)
+            continue;
+
+        ScatterCell cell;
+        cell.start_ = start;
+        cell.count_ = count;
+
+        for (unsigned j = start; j < start + count; ++j)
+        {
+            const ScatterInstance& instance = instances_[cellInstances_[j]];
+            Vector3 center = instance.position_ + instance.rotation_ * (modelCenter * instance.scale_);
+            Vector3 extent(Vector3::ONE * (modelRadius * Abs(instance.scale_)));
+            cell.boundingBox_.Merge(BoundingBox(center - extent, center + extent));
+        }
+
+        instancesBoundingBox_.Merge(cell.boundingBox_);
+        cells_.Push(cell);
+    }
+
+    cellWorldBoxes_.Resize(cells_.Size());
+}
+
+void ScatterModel::GenerateInstances()
+{
+    URHO3D_PROFILE(ScatterInstances);
+
+    instances_.Clear();
+
+    Vector2 areaSize = scatterArea_.Size();
+    if (scatterDensity_ <= 0.0f || areaSize.x_ <= 0.0f || areaSize.y_ <= 0.0f || !node_)
+        return;
+
+    // Place one candidate at a random position inside each cell of a grid matching the density, so that the instances cover the
+    // area evenly without clumping
+    float step = 1.0f / sqrtf(scatterDensity_);
+    if ((double)areaSize.x_ * areaSize.y_ / ((double)step * step) > MAX_SCATTER_CANDIDATES)
+    {
+        URHO3D_LOGWARNING("Scatter density of " + String(scatterDensity_) + " is too high for the area, reducing");
+        step = sqrtf(areaSize.x_ * areaSize.y_ / MAX_SCATTER_CANDIDATES);
+    }
+
+    int numX = CeilToInt(areaSize.x_ / step);
+    int numZ = CeilToInt(areaSize.y_ / step);
+
+    PODVector<Terrain*> terrains;
+    PODVector<Rect> terrainAreas;
+    Scene* scene = GetScene();
+    if (projectToTerrain_ && scene)
+    {
+        scene->GetComponents<Terrain>(terrains, true);
+        for (unsigned i = 0; i < terrains.Size();)
+        {
+            const IntVector2& numVertices = terrains[i]->GetNumVertices();
+            if (numVertices.x_ < 2 || numVertices.y_ < 2)
+            {
+                terrains.Erase(i);
+                continue;
+            }
+
+            Vector3 corner1 = terrains[i]->HeightMapToWorld(IntVector2(0, numVertices.y_ - 1));
+            Vector3 corner2 = terrains[i]->HeightMapToWorld(IntVector2(numVertices.x_ - 1, 0));
+            Rect terrainArea;
+            terrainArea.Merge(Vector2(corner1.x_, corner1.z_));
+            terrainArea.Merge(Vector2(corner2.x_, corner2.z_));
+            terrainAreas.Push(terrainArea);
+            ++i;
+        }
+    }
+
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    Matrix3x4 inverseWorldTransform = worldTransform.Inverse();
+    float minNormalY = cosf(maxSlope_ * M_DEGTORAD) - M_EPSILON;
+    unsigned state = scatterSeed_ * 0x9e3779b9u + 0x7f4a7c15u;
+    if (!state)
+        state = 1;
+
+    for (int z = 0; z < numZ; ++z)
+    {
+        for (int x = 0; x < numX; ++x)
+        {
+            // Consume the same amount of random numbers for each candidate, so that rejections do not move the others
+            float u = RandomUnit(state);
+            float v = RandomUnit(state);
+            float keep = RandomUnit(state);
+            float yaw = RandomUnit(state);
+            float scale = RandomUnit(state);
+
+            Vector2 point(scatterArea_.min_.x_ + (x + u) * step, scatterArea_.min_.y_ + (z + v) * step);
+            if (point.x_ > scatterArea_.max_.x_ || point.y_ > scatterArea_.max_.y_)
+                continue;
+
+            if (densityMap_ && keep >= densityMap_->GetPixelBilinear((point.x_ - scatterArea_.min_.x_) / areaSize.x_,
+                1.0f - (point.y_ - scatterArea_.min_.y_) / areaSize.y_).r_)
+                continue;
+
+            Vector3 position(point.x_, 0.0f, point.y_);
+            Vector3 normal = Vector3::UP;
+
+            if (projectToTerrain_)
+            {
+                Vector3 worldPosition = worldTransform * position;
+                Vector2 worldPoint(worldPosition.x_, worldPosition.z_);
+                Terrain* terrain = nullptr;
+                for (unsigned i = 0; i < terrains.Size(); ++i)
+                {
+                    if (terrainAreas[i].IsInside(worldPoint) != OUTSIDE)
+                    {
+                        terrain = terrains[i];
+                        break;
+                    }
+                }
+
+                if (!terrain)
+                    continue;
+
+                worldPosition.y_ = terrain->GetHeight(worldPosition);
+                position = inverseWorldTransform * worldPosition;
+                normal = (inverseWorldTransform * Vector4(terrain->GetNormal(worldPosition), 0.0f)).Normalized();
+            }
+
+            if (normal.y_ < minNormalY)
+                continue;
+
+            ScatterInstance instance;
+            instance.position_ = position;
+            instance.rotation_ = Quaternion(yaw * 360.0f, Vector3::UP);
+            if (alignToGround_)
+                instance.rotation_ = Quaternion(Vector3::UP, normal) * instance.rotation_;
+            instance.scale_ = Lerp(scaleRange_.x_, scaleRange_.y_, scale);
+            instances_.Push(instance);
+        }
+    }
+}
+
+void ScatterModel::ResetCullResults()
+{
+    MutexLock lock(cullMutex_);
+
+    for (unsigned i = 0; i < cullResults_.Size(); ++i)
+    {
+        cullResults_[i]->frameNumber_ = M_MAX_UNSIGNED;
+        cullResults_[i]->batches_.Clear();
+    }
+
+    batches_.Clear();
+    appliedCullResult_ = nullptr;
+}
+
+ScatterCullResult* ScatterModel::GetCullResult(const FrameInfo& frame)
+{
+    ScatterCullResult* freeResult = nullptr;
+
+    for (unsigned i = 0; i < cullResults_.Size(); ++i)
+    {
+        ScatterCullResult* result = cullResults_[i].Get();
+        if (result->camera_ == frame.camera_)
+            return result;
+        // Results of earlier frames have been rendered already and can be reused for another camera
+        if (!freeResult && result->frameNumber_ != frame.frameNumber_)
+            freeResult = result;
+    }
+
+    if (!freeResult)
+    {
+        cullResults_.Push(UniquePtr<ScatterCullResult>(new ScatterCullResult()));
+        freeResult = cullResults_.Back().Get();
+    }
+
+    if (freeResult == appliedCullResult_)
+        appliedCullResult_ = nullptr;
+
+    freeResult->camera_ = frame.camera_;
+    freeResult->frameNumber_ = M_MAX_UNSIGNED;
+    return freeResult;
+}
+
+void ScatterModel::CullInstances(const FrameInfo& frame, ScatterCullResult& result)
+{
+    URHO3D_PROFILE(CullScatterInstances);
+
+    Camera* camera = frame.camera_;
+    const Frustum& frustum = camera->GetFrustum();
+    Vector3 cameraPosition = camera->GetNode()->GetWorldPosition();
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    Vector3 modelCenter = boundingBox_.Center();
+    float maxDistance = drawDistance_ > 0.0f ? drawDistance_ : M_INFINITY;
+
+    // Use the depth read back from the GPU on earlier frames as a depth hierarchy for culling whole cells
+    auto* renderer = GetSubsystem<Renderer>();
+    OcclusionBuffer* occlusionBuffer = occludee_ && renderer ? renderer->GetGPUOcclusionBuffer(camera) : nullptr;
+
+    unsigned numLists = geometries_.Size() * numLodLevels_;
+    result.transforms_.Resize(numLists);
+    for (unsigned i = 0; i < numLists; ++i)
+        result.transforms_[i].Clear();
+    result.batches_.Clear();
+    result.numVisible_ = 0;
+
+    float minDistance = M_INFINITY;
+
+    if (numLists)
+    {
+        for (unsigned i = 0; i < cells_.Size(); ++i)
+        {
+            const BoundingBox& cellBox = cellWorldBoxes_[i];
+            if (cellBox.DistanceToPoint(cameraPosition) > maxDistance)
+                continue;
+            Intersection cellInside = frustum.IsInsideFast(cellBox);
+            if (cellInside == OUTSIDE)
+                continue;
+            if (occlusionBuffer && !occlusionBuffer->IsVisible(cellBox))
+                continue;
+
+            const ScatterCell& cell = cells_[i];
+            for (unsigned j = cell.start_; j < cell.start_ + cell.count_; ++j)
+            {
+                const ScatterInstance& instance = instances_[cellInstances_[j]];
+                Vector3 center = worldTransform * (instance.position_ + instance.rotation_ * (modelCenter * instance.scale_));
+
+                // Instances of cells fully inside the frustum do not need testing individually
+                if (cellInside == INTERSECTS && frustum.IsInsideFast(Sphere(center, worldRadius_ * Abs(instance.scale_))) == OUTSIDE)
+                    continue;
+
+                float distance = camera->GetDistance(center);
+                if (distance > maxDistance)
+                    continue;
+
+                minDistance = Min(minDistance, distance);
+                float lodDistance = camera->GetLodDistance(distance, lodScale_ * Abs(instance.scale_), lodBias_);
+                Matrix3x4 transform = worldTransform * Matrix3x4(instance.position_, instance.rotation_, instance.scale_);
+
+                for (unsigned k = 0; k < geometries_.Size(); ++k)
+                    result.transforms_[k * numLodLevels_ + GetInstanceLodLevel(geometries_[k], lodDistance)].Push(transform);
+
+                ++result.numVisible_;
+            }
+        }
+    }
+
+    // Draw each nonempty geometry and LOD level combination as one instanced batch
+    for (unsigned i = 0; i < numLists && result.batches_.Size() < MAX_SCATTER_BATCHES; ++i)
+    {
+        const PODVector<Matrix3x4>& transforms = result.transforms_[i];
+        if (transforms.Empty())
+            continue;
+
+        unsigned geometryIndex = i / numLodLevels_;
+        unsigned lodLevel = Min(i % numLodLevels_, geometries_[geometryIndex].Size() - 1);
+
+        SourceBatch batch;
+        batch.distance_ = minDistance;
+        batch.geometry_ = geometries_[geometryIndex][lodLevel];
+        batch.material_ = materials_[geometryIndex];
+        batch.worldTransform_ = &transforms[0];
+        batch.numWorldTransforms_ = transforms.Size();
+        result.batches_.Push(batch);
+    }
+
+    result.distance_ = result.numVisible_ ? minDistance : camera->GetDistance(worldBoundingBox_.Center());
+    result.frameNumber_ = frame.frameNumber_;
+}
+
+void ScatterModel::HandleModelReloadFinished(StringHash eventType, VariantMap& eventData)
+{
+    Model* currentModel = model_;
+    model_.Reset(); // Set null to allow to be re-set
+    SetModel(currentModel);
+}
+
+}
@@ -0,0 +1,315 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/Ptr.h"
+#include "../Core/Mutex.h"
+#include "../Graphics/Drawable.h"
+#include "../Math/Matrix3x4.h"
+#include "../Math/Rect.h"
+
+namespace Urho3D
+{
+
+class Image;
+class Model;
+
+/// Model instance of a ScatterModel, in the scene node's local space.
+struct ScatterInstance
+{
+    /// Position.
+    Vector3 position_;
+    /// Uniform scale.
+    float scale_;
+    /// Rotation.
+    Quaternion rotation_;
+};
+
+/// Spatial cell of ScatterModel instances.
+struct ScatterCell
+{
+    /// Local space bounding box of the instances.
+    BoundingBox boundingBox_;
+    /// Index of the first instance index in the cell instance list.
+    unsigned start_;
+    /// Number of instances.
+    unsigned count_;
+};
+
+/// Instances of a ScatterModel visible from one camera. Kept until a later frame so that the transforms stay valid until rendered.
+struct ScatterCullResult
+{
+    /// Camera.
+    Camera* camera_{};
+    /// Frame number on which was culled.
+    unsigned frameNumber_{M_MAX_UNSIGNED};
+    /// Distance of the nearest visible instance.
+    float distance_{};
+    /// Number of visible instances.
+    unsigned numVisible_{};
+    /// World transforms of the visible instances, one list per geometry and LOD level.
+    Vector<PODVector<Matrix3x4> > transforms_;
+    /// Batches of the nonempty transform lists.
+    Vector<SourceBatch> batches_;
+};
+
+/// Renders a model at a large number of instances that are stored compactly instead of as scene nodes. The instances can be scattered procedurally over an area, optionally projected onto terrains. They are sorted into cells that are frustum, distance and GPU depth occlusion culled per camera, and the visible instances choose their LOD levels individually.
+class URHO3D_API ScatterModel : public Drawable
+{
+    URHO3D_OBJECT(ScatterModel, Drawable);
+
+public:
+    /// Construct.
+    explicit ScatterModel(Context* context);
+    /// Destruct.
+    ~ScatterModel() override;
+    /// Register object factory. Drawable must be registered first.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Process octree raycast. May be called from a worker thread.
+    void ProcessRayQuery(const RayOctreeQuery& query, PODVector<RayQueryResult>& results) override;
+    /// Update before octree reinsertion. Is called from a worker thread.
+    void Update(const FrameInfo& frame) override;
+    /// Calculate distance and prepare batches for rendering. May be called from worker thread(s), possibly re-entrantly.
+    void UpdateBatches(const FrameInfo& frame) override;
+    /// Return the geometry for a specific LOD level.
+    Geometry* GetLodGeometry(unsigned batchIndex, unsigned level) override;
+
+    /// Set model.
+    /// @property
+    void SetModel(Model* model);
+    /// Set material on all geometries.
+    /// @property
+    void SetMaterial(Material* material);
+    /// Set material on one geometry. Return true if successful.
+    /// @property{set_materials}
+    bool SetMaterial(unsigned index, Material* material);
+    /// Set size of the culling cells in the local XZ plane.
+    /// @property
+    void SetCellSize(float size);
+
+    /// Add an instance.
+    void AddInstance(const Vector3& position, const Quaternion& rotation = Quaternion::IDENTITY, float scale = 1.0f);
+    /// Remove an instance by index.
+    void RemoveInstance(unsigned index);
+    /// Remove all instances.
+    void RemoveAllInstances();
+    /// Replace all instances.
+    /// @nobind
+    void SetInstances(const PODVector<ScatterInstance>& instances);
+
+    /// Set the local XZ area to scatter instances over.
+    /// @property
+    void SetScatterArea(const Rect& area);
+    /// Set number of instances to scatter per unit of area. When nonzero, the instances are scattered again on the next update after any scatter parameter changes. Zero (default) keeps the explicitly added instances instead.
+    /// @property
+    void SetScatterDensity(float density);
+    /// Set random seed of the scattering.
+    /// @property
+    void SetScatterSeed(unsigned seed);
+    /// Set range of the scattered instances' random scale.
+    /// @property
+    void SetScaleRange(const Vector2& range);
+    /// Set maximum ground slope in degrees to scatter instances on.
+    /// @property
+    void SetMaxSlope(float angle);
+    /// Set whether to orient the scattered instances along the ground normal.
+    /// @property
+    void SetAlignToGround(bool enable);
+    /// Set whether to place the scattered instances on the heights of the scene's terrains. Instances outside the terrains are skipped.
+    /// @property
+    void SetProjectToTerrain(bool enable);
+    /// Set image whose red channel scales the scatter density over the area. The top of the image is the area's maximum Z.
+    /// @property
+    void SetDensityMap(Image* image);
+    /// Scatter the instances now according to the scatter parameters, replacing the current instances.
+    void Scatter();
+
+    /// Return model.
+    /// @property
+    Model* GetModel() const { return model_; }
+
+    /// Return number of geometries.
+    /// @property
+    unsigned GetNumGeometries() const { return geometries_.Size(); }
+
+    /// Return material by geometry index.
+    /// @property{get_materials}
+    Material* GetMaterial(unsigned index = 0) const;
+
+    /// Return size of the culling cells.
+    /// @property
+    float GetCellSize() const { return cellSize_; }
+
+    /// Return number of instances.
+    /// @property
+    unsigned GetNumInstances() const { return instances_.Size(); }
+
+    /// Return instance by index.
+    /// @nobind
+    const ScatterInstance* GetInstance(unsigned index) const { return index < instances_.Size() ? &instances_[index] : nullptr; }
+
+    /// Return all instances.
+    /// @nobind
+    const PODVector<ScatterInstance>& GetInstances() const { return instances_; }
+
+    /// Return number of culling cells.
+    /// @property
+    unsigned GetNumCells() const { return cells_.Size(); }
+
+    /// Return number of instances visible on the latest culling.
+    /// @property
+    unsigned GetNumVisibleInstances() const { return numVisible_; }
+
+    /// Return scatter area.
+    /// @property
+    const Rect& GetScatterArea() const { return scatterArea_; }
+
+    /// Return scatter density.
+    /// @property
+    float GetScatterDensity() const { return scatterDensity_; }
+
+    /// Return scatter random seed.
+    /// @property
+    unsigned GetScatterSeed() const { return scatterSeed_; }
+
+    /// Return scale range of the scattered instances.
+    /// @property
+    const Vector2& GetScaleRange() const { return scaleRange_; }
+
+    /// Return maximum ground slope.
+    /// @property
+    float GetMaxSlope() const { return maxSlope_; }
+
+    /// Return whether the scattered instances are oriented along the ground normal.
+    /// @property
+    bool GetAlignToGround() const { return alignToGround_; }
+
+    /// Return whether the scattered instances are placed on terrains.
+    /// @property
+    bool GetProjectToTerrain() const { return projectToTerrain_; }
+
+    /// Return density map.
+    /// @property
+    Image* GetDensityMap() const;
+
+    /// Set model attribute.
+    void SetModelAttr(const ResourceRef& value);
+    /// Set materials attribute.
+    void SetMaterialsAttr(const ResourceRefList& value);
+    /// Set density map attribute.
+    void SetDensityMapAttr(const ResourceRef& value);
+    /// Set instances attribute.
+    void SetInstancesAttr(const PODVector<unsigned char>& value);
+    /// Return model attribute.
+    ResourceRef GetModelAttr() const;
+    /// Return materials attribute.
+    const ResourceRefList& GetMaterialsAttr() const;
+    /// Return density map attribute.
+    ResourceRef GetDensityMapAttr() const;
+    /// Return instances attribute. Empty when the instances are scattered procedurally.
+    const PODVector<unsigned char>& GetInstancesAttr() const;
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+    /// Recalculate the world-space bounding box.
+    void OnWorldBoundingBoxUpdate() override;
+
+private:
+    /// Mark the cells for rebuilding on the next update.
+    void MarkCellsDirty();
+    /// Sort the instances into cells and calculate the cell bounding boxes.
+    void UpdateCells();
+    /// Scatter the instances according to the scatter parameters.
+    void GenerateInstances();
+    /// Invalidate the cull results and the current batches.
+    void ResetCullResults();
+    /// Return the cull result for a camera, or a free one to fill for it on the current frame.
+    ScatterCullResult* GetCullResult(const FrameInfo& frame);
+    /// Cull the instances for a camera and collect their transforms by geometry and LOD level.
+    void CullInstances(const FrameInfo& frame, ScatterCullResult& result);
+    /// Handle live reload of the model.
+    void HandleModelReloadFinished(StringHash eventType, VariantMap& eventData);
+
+    /// Model.
+    SharedPtr<Model> model_;
+    /// LOD geometries of each geometry.
+    Vector<Vector<SharedPtr<Geometry> > > geometries_;
+    /// Material of each geometry.
+    Vector<SharedPtr<Material> > materials_;
+    /// Density map.
+    SharedPtr<Image> densityMap_;
+    /// Instances.
+    PODVector<ScatterInstance> instances_;
+    /// Cells with at least one instance.
+    PODVector<ScatterCell> cells_;
+    /// World space bounding boxes of the cells.
+    PODVector<BoundingBox> cellWorldBoxes_;
+    /// Instance indices sorted by cell.
+    PODVector<unsigned> cellInstances_;
+    /// Cull results by camera.
+    Vector<UniquePtr<ScatterCullResult> > cullResults_;
+    /// Cull result the current batches are from.
+    ScatterCullResult* appliedCullResult_;
+    /// Mutex for culling, as shadow casters may be updated from several threads.
+    Mutex cullMutex_;
+    /// Scatter area.
+    Rect scatterArea_;
+    /// Range of the scattered instance scale.
+    Vector2 scaleRange_;
+    /// Local space bounding box of all instances.
+    BoundingBox instancesBoundingBox_;
+    /// Material list attribute.
+    mutable ResourceRefList materialsAttr_;
+    /// Instances attribute.
+    mutable PODVector<unsigned char> instancesAttr_;
+    /// Cell size.
+    float cellSize_;
+    /// Scatter density.
+    float scatterDensity_;
+    /// Maximum ground slope.
+    float maxSlope_;
+    /// Model bounding box size scaled by the node's maximum world scale, for calculating instance LOD distances.
+    float lodScale_;
+    /// Bounding sphere radius of the model scaled by the node's maximum world scale.
+    float worldRadius_;
+    /// Number of instances visible on the latest culling.
+    unsigned numVisible_;
+    /// Maximum number of LOD levels of the geometries.
+    unsigned numLodLevels_;
+    /// Scatter random seed.
+    unsigned scatterSeed_;
+    /// Orient along ground normal flag.
+    bool alignToGround_;
+    /// Place on terrains flag.
+    bool projectToTerrain_;
+    /// Cells need rebuilding flag.
+    bool cellsDirty_;
+    /// Scatter parameters changed flag.
+    bool scatterDirty_;
+};
+
+}
@@ -23,10 +23,12 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/Mutex.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Shader.h"
 #include "../Graphics/ShaderVariation.h"
 #include "../IO/Deserializer.h"
+#include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../Resource/ResourceCache.h"
@@ -61,6 +63,95 @@ void CommentOutFunction(String& code, const String& signature)
     }
 }
 
+/// Preprocessed include file shared by all shaders that include it.
+struct ShaderInclude : public RefCounted
+{
+    /// Source code with nested includes resolved.
+    String code_;
+    /// Resource names of the file and its nested includes.
+    Vector<String> files_;
+    /// Full path names of the files for checking for modification. Empty for packaged files.
+    Vector<String> fullNames_;
+    /// Modification timestamps of the files. Zero for packaged files.
+    PODVector<unsigned> timeStamps_;
+};
+
+/// Preprocessed include files by resource name.
+static HashMap<String, SharedPtr<ShaderInclude> > includeCache;
+/// Mutex for the include cache, as shaders may be loaded in worker threads.
+static Mutex includeCacheMutex;
+
+/// Return whether none of the files of a preprocessed include have been modified since.
+static bool IsIncludeValid(const ShaderInclude& include, FileSystem* fileSystem)
+{
+    for (unsigned i = 0; i < include.fullNames_.Size(); ++i)
+    {
+        if (!include.fullNames_[i].Empty() && fileSystem->GetLastModifiedTime(include.fullNames_[i]) != include.timeStamps_[i])
+            return false;
+    }
+    return true;
+}
+
+/// Return a preprocessed include file, reading and resolving it only if not cached yet or modified since.
+static SharedPtr<ShaderInclude> GetInclude(Context* context, const String& fileName)
+{
+    auto* cache = context->GetSubsystem<ResourceCache>();
+    auto* fileSystem = context->GetSubsystem<FileSystem>();
+
+    {
+        MutexLock lock(includeCacheMutex);
+        HashMap<String, SharedPtr<ShaderInclude> >::ConstIterator i = includeCache.Find(fileName);
+        if (i != includeCache.End() && IsIncludeValid(*i->second_, fileSystem))
+            return i->second_;
+    }
+
+    SharedPtr<File> file = cache->GetFile(fileName);
+    if (!file)
+        return SharedPtr<ShaderInclude>();
+
+    SharedPtr<ShaderInclude> include(new ShaderInclude());
+    include->files_.Push(file->GetName());
+    String fullName = file->IsPackaged() ? String::EMPTY : cache->GetResourceFileName(file->GetName());
+    include->fullNames_.Push(fullName);
+    include->timeStamps_.Push(fullName.Empty() ? 0 : fileSystem->GetLastModifiedTime(fullName));
+
+    while (!file->IsEof())
+    {
+        String line = file->ReadLine();
+
+        if (line.StartsWith("#include"))
+        {
+            String nestedFileName = GetPath(file->GetName()) + line.Substring(9).Replaced("\"", "").Trimmed();
+            if (nestedFileName == fileName)
+            {
+                URHO3D_LOGERROR("Shader include file " + fileName + " includes itself");
+                return SharedPtr<ShaderInclude>();
+            }
+
+            SharedPtr<ShaderInclude> nested = GetInclude(context, nestedFileName);
+            if (!nested)
+                return SharedPtr<ShaderInclude>();
+
+            include->code_ += nested->code_;
+            include->files_.Push(nested->files_);
+            include->fullNames_.Push(nested->fullNames_);
+            include->timeStamps_.Push(nested->timeStamps_);
+        }
+        else
+        {
+            include->code_ += line;
+            include->code_ += "\n";
+        }
+    }
+
+    // Finally insert an empty line to mark the space between files
+    include->code_ += "\n";
+
+    MutexLock lock(includeCacheMutex);
+    includeCache[fileName] = include;
+    return include;
+}
+
 Shader::Shader(Context* context) :
     Resource(context),
     timeStamp_(0),
@@ -83,9 +174,10 @@ void Shader::RegisterObject(Context* context)
 
 bool Shader::BeginLoad(Deserializer& source)
 {
+    // In headless mode, fail unless render data is stripped, in which case the shader loads empty
     auto* graphics = GetSubsystem<Graphics>();
     if (!graphics)
-        return false;
+        return GetSubsystem<ResourceCache>()->GetStripHeadlessRenderData();
 
     // Load the shader source code and resolve any includes
     timeStamp_ = 0;
@@ -172,10 +264,6 @@ bool Shader::ProcessSource(String& code, Deserializer& source)
             timeStamp_ = fileTimeStamp;
     }
 
-    // Store resource dependencies for includes so that we know to reload if any of them changes
-    if (source.GetName() != GetName())
-        cache->StoreResourceDependency(this, source.GetName());
-
     while (!source.IsEof())
     {
         String line = source.ReadLine();
@@ -184,13 +272,19 @@ bool Shader::ProcessSource(String& code, Deserializer& source)
         {
             String includeFileName = GetPath(source.GetName()) + line.Substring(9).Replaced("\"", "").Trimmed();
 
-            SharedPtr<File> includeFile = cache->GetFile(includeFileName);
-            if (!includeFile)
+            SharedPtr<ShaderInclude> include = GetInclude(context_, includeFileName);
+            if (!include)
                 return false;
 
-            // Add the include file into the current code recursively
-            if (!ProcessSource(code, *includeFile))
-                return false;
+            // Store resource dependencies for includes so that we know to reload if any of them changes
+            for (unsigned i = 0; i < include->files_.Size(); ++i)
+            {
+                cache->StoreResourceDependency(this, include->files_[i]);
+                if (include->timeStamps_[i] > timeStamp_)
+                    timeStamp_ = include->timeStamps_[i];
+            }
+
+            code += include->code_;
         }
         else
         {
@@ -28,6 +28,10 @@
 #include "../Graphics/GPUObject.h"
 #include "../Graphics/GraphicsDefs.h"
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
 namespace Urho3D
 {
 
@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/CoreEvents.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/Drawable.h"
+#include "../Graphics/Renderer.h"
+#include "../Graphics/SignificanceManager.h"
+#include "../Graphics/Viewport.h"
+#include "../Scene/Node.h"
+#include "../Scene/Scene.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+extern const char* SUBSYSTEM_CATEGORY;
+
+static const float DEFAULT_MAX_DISTANCE = 200.0f;
+static const float DEFAULT_MAX_UPDATE_INTERVAL = 0.25f;
+static const float DEFAULT_INVISIBLE_FACTOR = 0.25f;
+
+SignificanceManager::SignificanceManager(Context* context) :
+    Component(context),
+    maxDistance_(DEFAULT_MAX_DISTANCE),
+    maxUpdateInterval_(DEFAULT_MAX_UPDATE_INTERVAL),
+    invisibleFactor_(DEFAULT_INVISIBLE_FACTOR)
+{
+    SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(SignificanceManager, HandleBeginFrame));
+}
+
+SignificanceManager::~SignificanceManager() = default;
+
+void SignificanceManager::RegisterObject(Context* context)
+{
+    context->RegisterFactory<SignificanceManager>(SUBSYSTEM_CATEGORY);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Distance", GetMaxDistance, SetMaxDistance, float, DEFAULT_MAX_DISTANCE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Update Interval", GetMaxUpdateInterval, SetMaxUpdateInterval, float, DEFAULT_MAX_UPDATE_INTERVAL, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Invisible Factor", GetInvisibleFactor, SetInvisibleFactor, float, DEFAULT_INVISIBLE_FACTOR, AM_DEFAULT);
+}
+
+void SignificanceManager::SetCamera(Camera* camera)
+{
+    camera_ = camera;
+    significances_.Clear();
+}
+
+void SignificanceManager::SetMaxDistance(float distance)
+{
+    maxDistance_ = Max(distance, 0.0f);
+    significances_.Clear();
+}
+
+void SignificanceManager::SetMaxUpdateInterval(float interval)
+{
+    maxUpdateInterval_ = Max(interval, 0.0f);
+}
+
+void SignificanceManager::SetInvisibleFactor(float factor)
+{
+    invisibleFactor_ = Clamp(factor, 0.0f, 1.0f);
+    significances_.Clear();
+}
+
+float SignificanceManager::GetSignificance(Node* node)
+{
+    if (!node)
+        return 1.0f;
+
+    HashMap<unsigned, float>::ConstIterator i = significances_.Find(node->GetID());
+    if (i != significances_.End())
+        return i->second_;
+
+    Camera* camera = GetEffectiveCamera();
+    float significance = camera ? CalculateSignificance(node, camera) : 1.0f;
+    significances_[node->GetID()] = significance;
+    return significance;
+}
+
+float SignificanceManager::GetUpdateInterval(Node* node)
+{
+    return (1.0f - GetSignificance(node)) * maxUpdateInterval_;
+}
+
+bool SignificanceManager::CheckUpdate(Node* node, float& timeStep, float& accumulator)
+{
+    accumulator += timeStep;
+    if (accumulator < GetUpdateInterval(node))
+        return false;
+
+    timeStep = accumulator;
+    accumulator = 0.0f;
+    return true;
+}
+
+bool SignificanceManager::CheckUpdate(Component* component, float& timeStep, float& accumulator)
+{
+    Scene* scene = component->GetScene();
+    auto* manager = scene ? scene->GetComponent<SignificanceManager>() : nullptr;
+    if (manager && manager->IsEnabledEffective())
+        return manager->CheckUpdate(component->GetNode(), timeStep, accumulator);
+
+    // Flush any time accumulated while the manager was active
+    timeStep += accumulator;
+    accumulator = 0.0f;
+    return true;
+}
+
+Camera* SignificanceManager::GetEffectiveCamera() const
+{
+    if (camera_)
+        return camera_;
+
+    auto* renderer = GetSubsystem<Renderer>();
+    if (!renderer)
+        return nullptr;
+
+    for (unsigned i = 0; i < renderer->GetNumViewports(); ++i)
+    {
+        Viewport* viewport = renderer->GetViewport(i);
+        if (viewport && viewport->GetScene() == GetScene() && viewport->GetCamera())
+            return viewport->GetCamera();
+    }
+
+    return nullptr;
+}
+
+float SignificanceManager::CalculateSignificance(Node* node, Camera* camera) const
+{
+    Node* cameraNode = camera->GetNode();
+    if (!cameraNode)
+        return 1.0f;
+
+    float distance = (node->GetWorldPosition() - cameraNode->GetWorldPosition()).Length();
+    float significance = maxDistance_ > 0.0f ? Max(1.0f - distance / maxDistance_, 0.0f) : 1.0f;
+
+    // Nodes without drawables are rated by distance only
+    PODVector<Drawable*> drawables;
+    node->GetDerivedComponents<Drawable>(drawables);
+    if (drawables.Empty())
+        return significance;
+
+    bool inView = false;
+    float screenSize = 0.0f;
+    for (Drawable* drawable : drawables)
+    {
+        if (!drawable->IsInView())
+            continue;
+
+        inView = true;
+        // Approximate the fraction of the view height the drawable's bounding sphere covers
+        float radius = drawable->GetWorldBoundingBox().HalfSize().Length();
+        float viewHeight = camera->IsOrthographic() ? camera->GetOrthoSize() * 0.5f :
+            Max(distance, M_EPSILON) * tanf(camera->GetFov() * M_DEGTORAD * 0.5f);
+        if (viewHeight > 0.0f)
+            screenSize = Max(screenSize, Min(radius * camera->GetZoom() / viewHeight, 1.0f));
+    }
+
+    return inView ? Max(significance, screenSize) : significance * invisibleFactor_;
+}
+
+void SignificanceManager::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
+{
+    significances_.Clear();
+}
+
+}
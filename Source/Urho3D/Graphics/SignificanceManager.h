@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Container/HashMap.h"
+#include "../Scene/Component.h"
+
+namespace Urho3D
+{
+
+class Camera;
+
+/// %Scene component that rates how significant each node is to the viewer, from its distance to the camera, visibility and screen size. Components that opt in to significance update accumulate their time step and update less often the less significant their node is.
+class URHO3D_API SignificanceManager : public Component
+{
+    URHO3D_OBJECT(SignificanceManager, Component);
+
+public:
+    /// Construct.
+    explicit SignificanceManager(Context* context);
+    /// Destruct.
+    ~SignificanceManager() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Set camera to measure significance from. When null, the camera of the first viewport showing the scene is used.
+    /// @property
+    void SetCamera(Camera* camera);
+    /// Set distance from the camera at which significance reaches zero.
+    /// @property
+    void SetMaxDistance(float distance);
+    /// Set update interval in seconds of the least significant nodes. The most significant nodes update every frame.
+    /// @property
+    void SetMaxUpdateInterval(float interval);
+    /// Set significance multiplier for nodes whose drawables were not in view on the last frame.
+    /// @property
+    void SetInvisibleFactor(float factor);
+
+    /// Return camera set to measure significance from.
+    /// @property
+    Camera* GetCamera() const { return camera_; }
+    /// Return distance from the camera at which significance reaches zero.
+    /// @property
+    float GetMaxDistance() const { return maxDistance_; }
+    /// Return update interval of the least significant nodes.
+    /// @property
+    float GetMaxUpdateInterval() const { return maxUpdateInterval_; }
+    /// Return significance multiplier for nodes that were not in view.
+    /// @property
+    float GetInvisibleFactor() const { return invisibleFactor_; }
+
+    /// Return significance of a node in range 0-1. Computed at most once per frame and node. Must be called from the main thread.
+    float GetSignificance(Node* node);
+    /// Return update interval of a node in seconds.
+    float GetUpdateInterval(Node* node);
+    /// Accumulate a component's time step. Return true when the component should update on this frame, in which case the time step is replaced with the time accumulated since the last update.
+    bool CheckUpdate(Node* node, float& timeStep, float& accumulator);
+
+    /// Accumulate a component's time step through the significance manager of its scene. Always return true if the scene has no enabled significance manager.
+    static bool CheckUpdate(Component* component, float& timeStep, float& accumulator);
+
+private:
+    /// Return camera to measure significance from.
+    Camera* GetEffectiveCamera() const;
+    /// Compute significance of a node.
+    float CalculateSignificance(Node* node, Camera* camera) const;
+    /// Handle frame begin event. Discard the cached significances.
+    void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+
+    /// Camera to measure significance from.
+    WeakPtr<Camera> camera_;
+    /// Significance of nodes by ID, computed during this frame.
+    HashMap<unsigned, float> significances_;
+    /// Distance at which significance reaches zero.
+    float maxDistance_;
+    /// Update interval of the least significant nodes.
+    float maxUpdateInterval_;
+    /// Significance multiplier for nodes that were not in view.
+    float invisibleFactor_;
+};
+
+}
@@ -44,6 +44,8 @@ namespace Urho3D
 
 extern const char* GEOMETRY_CATEGORY;
 
+URHO3D_IMPLEMENT_POOLED_OBJECT(StaticModel)
+
 StaticModel::StaticModel(Context* context) :
     Drawable(context, DRAWABLE_GEOMETRY),
     occlusionLodLevel_(M_MAX_UNSIGNED),
@@ -95,9 +97,14 @@ void StaticModel::ProcessRayQuery(const RayOctreeQuery& query, PODVector<RayQuer
         {
             distance = M_INFINITY;
 
+            // The triangle tests read the shadow data of the model
+            if (model_)
+                model_->RequestShadowData();
+
             for (unsigned i = 0; i < batches_.Size(); ++i)
             {
-                Geometry* geometry = batches_[i].geometry_;
+                // An out of range LOD level returns the visible geometry
+                Geometry* geometry = GetLodGeometry(i, M_MAX_UNSIGNED);
                 if (geometry)
                 {
                     Vector3 geometryNormal;
@@ -188,6 +195,9 @@ unsigned StaticModel::GetNumOccluderTriangles()
 
 bool StaticModel::DrawOcclusion(OcclusionBuffer* buffer)
 {
+    if (model_)
+        model_->RequestShadowData();
+
     for (unsigned i = 0; i < batches_.Size(); ++i)
     {
         Geometry* geometry = GetLodGeometry(i, occlusionLodLevel_);
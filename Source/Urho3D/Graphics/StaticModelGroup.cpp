@@ -27,10 +27,12 @@
 #include "../Graphics/Camera.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/Material.h"
+#include "../Graphics/Model.h"
 #include "../Graphics/OcclusionBuffer.h"
 #include "../Graphics/OctreeQuery.h"
 #include "../Graphics/StaticModelGroup.h"
 #include "../Graphics/VertexBuffer.h"
+#include "../Math/MathKernels.h"
 #include "../Scene/Scene.h"
 
 #include "../DebugNew.h"
@@ -135,6 +137,10 @@ void StaticModelGroup::ProcessRayQuery(const RayOctreeQuery& query, PODVector<Ra
             {
                 distance = M_INFINITY;
 
+                // The triangle tests read the shadow data of the model
+                if (model_)
+                    model_->RequestShadowData();
+
                 for (unsigned j = 0; j < batches_.Size(); ++j)
                 {
                     Geometry* geometry = batches_[j].geometry_;
@@ -228,6 +234,9 @@ bool StaticModelGroup::DrawOcclusion(OcclusionBuffer* buffer)
     // Make sure instance transforms are up-to-date
     GetWorldBoundingBox();
 
+    if (model_)
+        model_->RequestShadowData();
+
     for (unsigned i = 0; i < numWorldTransforms_; ++i)
     {
         for (unsigned j = 0; j < batches_.Size(); ++j)
@@ -367,23 +376,19 @@ void StaticModelGroup::OnNodeSetEnabled(Node* node)
 
 void StaticModelGroup::OnWorldBoundingBoxUpdate()
 {
-    // Update transforms and bounding box at the same time to have to go through the objects only once
+    // Gather the transforms of the enabled instances, then merge their bounding boxes in one batch
     unsigned index = 0;
 
-    BoundingBox worldBox;
-
     for (unsigned i = 0; i < instanceNodes_.Size(); ++i)
     {
         Node* node = instanceNodes_[i];
         if (!node || !node->IsEnabled())
             continue;
 
-        const Matrix3x4& worldTransform = node->GetWorldTransform();
-        worldTransforms_[index++] = worldTransform;
-        worldBox.Merge(boundingBox_.Transformed(worldTransform));
+        worldTransforms_[index++] = node->GetWorldTransform();
     }
 
-    worldBoundingBox_ = worldBox;
+    worldBoundingBox_ = index ? MergeTransformedBoundingBox(boundingBox_, &worldTransforms_[0], index) : BoundingBox();
 
     // Store the amount of valid instances we found instead of resizing worldTransforms_. This is because this function may be
     // called from multiple worker threads simultaneously
@@ -81,6 +81,7 @@ Pass::Pass(const String& name) :
     shadersLoadedFrameNumber_(0),
     alphaToCoverage_(false),
     depthWrite_(true),
+    bindless_(false),
     isDesktop_(false)
 {
     name_ = name.ToLower();
@@ -126,6 +127,11 @@ void Pass::SetAlphaToCoverage(bool enable)
     alphaToCoverage_ = enable;
 }
 
+void Pass::SetBindless(bool enable)
+{
+    bindless_ = enable;
+}
+
 
 void Pass::SetIsDesktop(bool enable)
 {
@@ -226,6 +232,30 @@ Vector<SharedPtr<ShaderVariation> >& Pass::GetPixelShaders(const StringHash& ext
         return extraPixelShaders_[extraDefinesHash];
 }
 
+bool Pass::HasShaders(const StringHash& vsExtraDefinesHash, const StringHash& psExtraDefinesHash) const
+{
+    const Vector<SharedPtr<ShaderVariation> >* vertexShaders = &vertexShaders_;
+    const Vector<SharedPtr<ShaderVariation> >* pixelShaders = &pixelShaders_;
+
+    if (vsExtraDefinesHash.Value())
+    {
+        HashMap<StringHash, Vector<SharedPtr<ShaderVariation> > >::ConstIterator i = extraVertexShaders_.Find(vsExtraDefinesHash);
+        if (i == extraVertexShaders_.End())
+            return false;
+        vertexShaders = &i->second_;
+    }
+
+    if (psExtraDefinesHash.Value())
+    {
+        HashMap<StringHash, Vector<SharedPtr<ShaderVariation> > >::ConstIterator i = extraPixelShaders_.Find(psExtraDefinesHash);
+        if (i == extraPixelShaders_.End())
+            return false;
+        pixelShaders = &i->second_;
+    }
+
+    return vertexShaders->Size() && pixelShaders->Size();
+}
+
 unsigned Technique::basePassIndex = 0;
 unsigned Technique::alphaPassIndex = 0;
 unsigned Technique::materialPassIndex = 0;
@@ -262,6 +292,10 @@ bool Technique::BeginLoad(Deserializer& source)
 
     SetMemoryUse(sizeof(Technique));
 
+    // In headless mode with render data stripping, load the technique empty, as materials are not loaded either
+    if (!GetSubsystem<Graphics>() && GetSubsystem<ResourceCache>()->GetStripHeadlessRenderData())
+        return true;
+
     SharedPtr<XMLFile> xml(new XMLFile(context_));
     if (!xml->Load(source))
         return false;
@@ -348,6 +382,9 @@ bool Technique::BeginLoad(Deserializer& source)
 
             if (passElem.HasAttribute("alphatocoverage"))
                 newPass->SetAlphaToCoverage(passElem.GetBool("alphatocoverage"));
+
+            if (passElem.HasAttribute("bindless"))
+                newPass->SetBindless(passElem.GetBool("bindless"));
         }
         else
             URHO3D_LOGERROR("Missing pass name");
@@ -393,6 +430,7 @@ SharedPtr<Technique> Technique::Clone(const String& cloneName) const
         newPass->SetLightingMode(srcPass->GetLightingMode());
         newPass->SetDepthWrite(srcPass->GetDepthWrite());
         newPass->SetAlphaToCoverage(srcPass->GetAlphaToCoverage());
+        newPass->SetBindless(srcPass->GetBindless());
         newPass->SetIsDesktop(srcPass->IsDesktop());
         newPass->SetVertexShader(srcPass->GetVertexShader());
         newPass->SetPixelShader(srcPass->GetPixelShader());
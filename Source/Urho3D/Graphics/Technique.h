@@ -67,6 +67,8 @@ public:
     /// Set alpha-to-coverage on/off.
     /// @property
     void SetAlphaToCoverage(bool enable);
+    /// Set whether instanced batches may index the diffuse texture from a bindless texture array.
+    void SetBindless(bool enable);
     /// Set whether requires desktop level hardware.
     /// @property{set_desktop}
     void SetIsDesktop(bool enable);
@@ -126,6 +128,9 @@ public:
     /// @property
     bool GetAlphaToCoverage() const { return alphaToCoverage_; }
 
+    /// Return whether instanced batches may index the diffuse texture from a bindless texture array.
+    bool GetBindless() const { return bindless_; }
+
     /// Return whether requires desktop level hardware.
     /// @property
     bool IsDesktop() const { return isDesktop_; }
@@ -164,6 +169,8 @@ public:
     Vector<SharedPtr<ShaderVariation> >& GetVertexShaders(const StringHash& extraDefinesHash);
     /// Return pixel shaders with extra defines from the renderpath.
     Vector<SharedPtr<ShaderVariation> >& GetPixelShaders(const StringHash& extraDefinesHash);
+    /// Return whether vertex and pixel shaders have been loaded for the extra defines. Does not modify the pass, so is safe to call from worker threads.
+    bool HasShaders(const StringHash& vsExtraDefinesHash, const StringHash& psExtraDefinesHash) const;
     /// Return the effective vertex shader defines, accounting for excludes. Called internally by Renderer.
     String GetEffectiveVertexShaderDefines() const;
     /// Return the effective pixel shader defines, accounting for excludes. Called internally by Renderer.
@@ -186,6 +193,8 @@ private:
     bool depthWrite_;
     /// Alpha-to-coverage mode.
     bool alphaToCoverage_;
+    /// Bindless diffuse texture mode.
+    bool bindless_;
     /// Require desktop level hardware flag.
     bool isDesktop_;
     /// Vertex shader name.
@@ -24,8 +24,12 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DrawableEvents.h"
 #include "../Graphics/Geometry.h"
+#include "../Graphics/GPUTerrain.h"
+#include "../Graphics/Graphics.h"
 #include "../Graphics/IndexBuffer.h"
 #include "../Graphics/Material.h"
 #include "../Graphics/Octree.h"
@@ -38,6 +42,7 @@
 #include "../Resource/ResourceEvents.h"
 #include "../Scene/Node.h"
 #include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
 
 #include "../DebugNew.h"
 
@@ -77,6 +82,20 @@ inline void GrowUpdateRegion(IntRect& updateRegion, int x, int y)
     }
 }
 
+void BuildTerrainPatchesWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* terrain = reinterpret_cast<Terrain*>(item->aux_);
+    auto* start = reinterpret_cast<TerrainPatchBuild*>(item->start_);
+    auto* end = reinterpret_cast<TerrainPatchBuild*>(item->end_);
+
+    while (start != end)
+    {
+        terrain->BuildPatchGeometry(*start);
+        terrain->CalculateLodErrors(start->coordinates_, start->lodErrors_);
+        ++start;
+    }
+}
+
 Terrain::Terrain(Context* context) :
     Component(context),
     indexBuffer_(new IndexBuffer(context)),
@@ -97,6 +116,7 @@ Terrain::Terrain(Context* context) :
     castShadows_(false),
     occluder_(false),
     occludee_(true),
+    gpuRendering_(false),
     viewMask_(DEFAULT_VIEWMASK),
     lightMask_(DEFAULT_LIGHTMASK),
     shadowMask_(DEFAULT_SHADOWMASK),
@@ -110,12 +130,16 @@ Terrain::Terrain(Context* context) :
     westID_(0),
     eastID_(0),
     recreateTerrain_(false),
-    neighborsDirty_(false)
+    neighborsDirty_(false),
+    asyncBuild_(false)
 {
     indexBuffer_->SetShadowed(true);
 }
 
-Terrain::~Terrain() = default;
+Terrain::~Terrain()
+{
+    CancelPendingBuild();
+}
 
 void Terrain::RegisterObject(Context* context)
 {
@@ -146,6 +170,15 @@ void Terrain::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Shadow Mask", GetShadowMask, SetShadowMask, unsigned, DEFAULT_SHADOWMASK, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Zone Mask", GetZoneMask, SetZoneMask, unsigned, DEFAULT_ZONEMASK, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Occlusion LOD level", GetOcclusionLodLevel, SetOcclusionLodLevelAttr, unsigned, M_MAX_UNSIGNED, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("GPU Rendering", GetGPURendering, SetGPURenderingAttr, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Async Build", GetAsyncBuild, SetAsyncBuild, bool, false, AM_DEFAULT);
+}
+
+void Terrain::OnSetAttribute(const AttributeInfo& attr, const Variant& src)
+{
+    // Attributes such as the vertex spacing are read by the worker threads, so let them finish first
+    CompletePendingBuild();
+    Component::OnSetAttribute(attr, src);
 }
 
 void Terrain::ApplyAttributes()
@@ -178,6 +211,8 @@ void Terrain::OnSetEnabled()
         if (patches_[i])
             patches_[i]->SetEnabled(enabled);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetEnabled(enabled);
 }
 
 void Terrain::SetPatchSize(int size)
@@ -187,6 +222,7 @@ void Terrain::SetPatchSize(int size)
 
     if (size != patchSize_)
     {
+        CompletePendingBuild();
         patchSize_ = size;
 
         CreateGeometry();
@@ -198,6 +234,7 @@ void Terrain::SetSpacing(const Vector3& spacing)
 {
     if (spacing != spacing_)
     {
+        CompletePendingBuild();
         spacing_ = spacing;
 
         CreateGeometry();
@@ -222,6 +259,7 @@ void Terrain::SetOcclusionLodLevel(unsigned level)
 {
     if (level != occlusionLodLevel_)
     {
+        CompletePendingBuild();
         occlusionLodLevel_ = level;
         lastPatchSize_ = 0; // Force full recreate
 
@@ -257,6 +295,8 @@ void Terrain::SetMaterial(Material* material)
         if (patches_[i])
             patches_[i]->SetMaterial(material);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetMaterial(material);
 
     MarkNetworkUpdate();
 }
@@ -385,6 +425,8 @@ void Terrain::SetDrawDistance(float distance)
         if (patches_[i])
             patches_[i]->SetDrawDistance(distance);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetDrawDistance(distance);
 
     MarkNetworkUpdate();
 }
@@ -397,6 +439,8 @@ void Terrain::SetShadowDistance(float distance)
         if (patches_[i])
             patches_[i]->SetShadowDistance(distance);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetShadowDistance(distance);
 
     MarkNetworkUpdate();
 }
@@ -409,6 +453,8 @@ void Terrain::SetLodBias(float bias)
         if (patches_[i])
             patches_[i]->SetLodBias(bias);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetLodBias(bias);
 
     MarkNetworkUpdate();
 }
@@ -421,6 +467,8 @@ void Terrain::SetViewMask(unsigned mask)
         if (patches_[i])
             patches_[i]->SetViewMask(mask);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetViewMask(mask);
 
     MarkNetworkUpdate();
 }
@@ -433,6 +481,8 @@ void Terrain::SetLightMask(unsigned mask)
         if (patches_[i])
             patches_[i]->SetLightMask(mask);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetLightMask(mask);
 
     MarkNetworkUpdate();
 }
@@ -445,6 +495,8 @@ void Terrain::SetShadowMask(unsigned mask)
         if (patches_[i])
             patches_[i]->SetShadowMask(mask);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetShadowMask(mask);
 
     MarkNetworkUpdate();
 }
@@ -457,6 +509,8 @@ void Terrain::SetZoneMask(unsigned mask)
         if (patches_[i])
             patches_[i]->SetZoneMask(mask);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetZoneMask(mask);
 
     MarkNetworkUpdate();
 }
@@ -469,6 +523,8 @@ void Terrain::SetMaxLights(unsigned num)
         if (patches_[i])
             patches_[i]->SetMaxLights(num);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetMaxLights(num);
 
     MarkNetworkUpdate();
 }
@@ -481,6 +537,8 @@ void Terrain::SetCastShadows(bool enable)
         if (patches_[i])
             patches_[i]->SetCastShadows(enable);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetCastShadows(enable);
 
     MarkNetworkUpdate();
 }
@@ -505,10 +563,30 @@ void Terrain::SetOccludee(bool enable)
         if (patches_[i])
             patches_[i]->SetOccludee(enable);
     }
+    if (gpuTerrain_)
+        gpuTerrain_->SetOccludee(enable);
 
     MarkNetworkUpdate();
 }
 
+void Terrain::SetGPURendering(bool enable)
+{
+    if (enable != gpuRendering_)
+    {
+        gpuRendering_ = enable;
+        lastPatchSize_ = 0; // Force full recreate
+
+        CreateGeometry();
+        MarkNetworkUpdate();
+    }
+}
+
+void Terrain::SetAsyncBuild(bool enable)
+{
+    asyncBuild_ = enable;
+    MarkNetworkUpdate();
+}
+
 void Terrain::ApplyHeightMap()
 {
     if (heightMap_)
@@ -652,95 +730,110 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
 {
     URHO3D_PROFILE(CreatePatchGeometry);
 
-    auto row = (unsigned)(patchSize_ + 1);
-    VertexBuffer* vertexBuffer = patch->GetVertexBuffer();
-    Geometry* geometry = patch->GetGeometry();
-    Geometry* maxLodGeometry = patch->GetMaxLodGeometry();
-    Geometry* occlusionGeometry = patch->GetOcclusionGeometry();
+    TerrainPatchBuild build;
+    build.coordinates_ = patch->GetCoordinates();
+    BuildPatchGeometry(build);
+    ApplyPatchGeometry(patch, build);
+}
 
-    if (vertexBuffer->GetVertexCount() != row * row)
-        vertexBuffer->SetSize(row * row, MASK_POSITION | MASK_NORMAL | MASK_TEXCOORD1 | MASK_TANGENT);
+void Terrain::BuildPatchGeometry(TerrainPatchBuild& build) const
+{
+    auto row = (unsigned)(patchSize_ + 1);
 
-    SharedArrayPtr<unsigned char> cpuVertexData(new unsigned char[row * row * sizeof(Vector3)]);
-    SharedArrayPtr<unsigned char> occlusionCpuVertexData(new unsigned char[row * row * sizeof(Vector3)]);
+    // Position, normal, texture coordinate and tangent
+    build.vertexData_ = new float[row * row * 12];
+    build.cpuVertexData_ = new unsigned char[row * row * sizeof(Vector3)];
+    build.occlusionCpuVertexData_ = new unsigned char[row * row * sizeof(Vector3)];
 
-    auto* vertexData = (float*)vertexBuffer->Lock(0, vertexBuffer->GetVertexCount());
-    auto* positionData = (float*)cpuVertexData.Get();
-    auto* occlusionData = (float*)occlusionCpuVertexData.Get();
-    BoundingBox box;
+    float* vertexData = build.vertexData_.Get();
+    auto* positionData = (float*)build.cpuVertexData_.Get();
+    auto* occlusionData = (float*)build.occlusionCpuVertexData_.Get();
+    BoundingBox& box = build.boundingBox_;
 
     unsigned occlusionLevel = occlusionLodLevel_;
     if (occlusionLevel > numLodLevels_ - 1)
         occlusionLevel = numLodLevels_ - 1;
 
-    if (vertexData)
-    {
-        const IntVector2& coords = patch->GetCoordinates();
-        unsigned lodExpand = (1u << (occlusionLevel)) - 1;
-        unsigned halfLodExpand = (1u << (occlusionLevel)) / 2;
+    const IntVector2& coords = build.coordinates_;
+    unsigned lodExpand = (1u << (occlusionLevel)) - 1;
+    unsigned halfLodExpand = (1u << (occlusionLevel)) / 2;
 
-        for (unsigned z = 0; z <= patchSize_; ++z)
+    for (unsigned z = 0; z <= patchSize_; ++z)
+    {
+        for (unsigned x = 0; x <= patchSize_; ++x)
         {
-            for (unsigned x = 0; x <= patchSize_; ++x)
+            int xPos = coords.x_ * patchSize_ + x;
+            int zPos = coords.y_ * patchSize_ + z;
+
+            // Position
+            Vector3 position((float)x * spacing_.x_, GetRawHeight(xPos, zPos), (float)z * spacing_.z_);
+            *vertexData++ = position.x_;
+            *vertexData++ = position.y_;
+            *vertexData++ = position.z_;
+            *positionData++ = position.x_;
+            *positionData++ = position.y_;
+            *positionData++ = position.z_;
+
+            box.Merge(position);
+
+            // For vertices that are part of the occlusion LOD, calculate the minimum height in the neighborhood
+            // to prevent false positive occlusion due to inaccuracy between occlusion LOD & visible LOD
+            float minHeight = position.y_;
+            if (halfLodExpand > 0 && (x & lodExpand) == 0 && (z & lodExpand) == 0)
             {
-                int xPos = coords.x_ * patchSize_ + x;
-                int zPos = coords.y_ * patchSize_ + z;
-
-                // Position
-                Vector3 position((float)x * spacing_.x_, GetRawHeight(xPos, zPos), (float)z * spacing_.z_);
-                *vertexData++ = position.x_;
-                *vertexData++ = position.y_;
-                *vertexData++ = position.z_;
-                *positionData++ = position.x_;
-                *positionData++ = position.y_;
-                *positionData++ = position.z_;
-
-                box.Merge(position);
-
-                // For vertices that are part of the occlusion LOD, calculate the minimum height in the neighborhood
-                // to prevent false positive occlusion due to inaccuracy between occlusion LOD & visible LOD
-                float minHeight = position.y_;
-                if (halfLodExpand > 0 && (x & lodExpand) == 0 && (z & lodExpand) == 0)
+                int minX = Max(xPos - halfLodExpand, 0);
+                int maxX = Min(xPos + halfLodExpand, numVertices_.x_ - 1);
+                int minZ = Max(zPos - halfLodExpand, 0);
+                int maxZ = Min(zPos + halfLodExpand, numVertices_.y_ - 1);
+                for (int nZ = minZ; nZ <= maxZ; ++nZ)
                 {
-                    int minX = Max(xPos - halfLodExpand, 0);
-                    int maxX = Min(xPos + halfLodExpand, numVertices_.x_ - 1);
-                    int minZ = Max(zPos - halfLodExpand, 0);
-                    int maxZ = Min(zPos + halfLodExpand, numVertices_.y_ - 1);
-                    for (int nZ = minZ; nZ <= maxZ; ++nZ)
-                    {
-                        for (int nX = minX; nX <= maxX; ++nX)
-                            minHeight = Min(minHeight, GetRawHeight(nX, nZ));
-                    }
+                    for (int nX = minX; nX <= maxX; ++nX)
+                        minHeight = Min(minHeight, GetRawHeight(nX, nZ));
                 }
-                *occlusionData++ = position.x_;
-                *occlusionData++ = minHeight;
-                *occlusionData++ = position.z_;
-
-                // Normal
-                Vector3 normal = GetRawNormal(xPos, zPos);
-                *vertexData++ = normal.x_;
-                *vertexData++ = normal.y_;
-                *vertexData++ = normal.z_;
-
-                // Texture coordinate
-                Vector2 texCoord((float)xPos / (float)(numVertices_.x_ - 1), 1.0f - (float)zPos / (float)(numVertices_.y_ - 1));
-                *vertexData++ = texCoord.x_;
-                *vertexData++ = texCoord.y_;
-
-                // Tangent
-                Vector3 xyz = (Vector3::RIGHT - normal * normal.DotProduct(Vector3::RIGHT)).Normalized();
-                *vertexData++ = xyz.x_;
-                *vertexData++ = xyz.y_;
-                *vertexData++ = xyz.z_;
-                *vertexData++ = 1.0f;
             }
+            *occlusionData++ = position.x_;
+            *occlusionData++ = minHeight;
+            *occlusionData++ = position.z_;
+
+            // Normal
+            Vector3 normal = GetRawNormal(xPos, zPos);
+            *vertexData++ = normal.x_;
+            *vertexData++ = normal.y_;
+            *vertexData++ = normal.z_;
+
+            // Texture coordinate
+            Vector2 texCoord((float)xPos / (float)(numVertices_.x_ - 1), 1.0f - (float)zPos / (float)(numVertices_.y_ - 1));
+            *vertexData++ = texCoord.x_;
+            *vertexData++ = texCoord.y_;
+
+            // Tangent
+            Vector3 xyz = (Vector3::RIGHT - normal * normal.DotProduct(Vector3::RIGHT)).Normalized();
+            *vertexData++ = xyz.x_;
+            *vertexData++ = xyz.y_;
+            *vertexData++ = xyz.z_;
+            *vertexData++ = 1.0f;
         }
+    }
+}
 
-        vertexBuffer->Unlock();
+void Terrain::ApplyPatchGeometry(TerrainPatch* patch, TerrainPatchBuild& build)
+{
+    auto row = (unsigned)(patchSize_ + 1);
+    VertexBuffer* vertexBuffer = patch->GetVertexBuffer();
+    Geometry* geometry = patch->GetGeometry();
+    Geometry* maxLodGeometry = patch->GetMaxLodGeometry();
+    Geometry* occlusionGeometry = patch->GetOcclusionGeometry();
+
+    if (vertexBuffer->GetVertexCount() != row * row)
+        vertexBuffer->SetSize(row * row, MASK_POSITION | MASK_NORMAL | MASK_TEXCOORD1 | MASK_TANGENT);
+    if (vertexBuffer->SetData(build.vertexData_.Get()))
         vertexBuffer->ClearDataLost();
-    }
 
-    patch->SetBoundingBox(box);
+    patch->SetBoundingBox(build.boundingBox_);
+
+    unsigned occlusionLevel = occlusionLodLevel_;
+    if (occlusionLevel > numLodLevels_ - 1)
+        occlusionLevel = numLodLevels_ - 1;
 
     if (drawRanges_.Size())
     {
@@ -748,13 +841,13 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
 
         geometry->SetIndexBuffer(indexBuffer_);
         geometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[0].first_, drawRanges_[0].second_, false);
-        geometry->SetRawVertexData(cpuVertexData, MASK_POSITION);
+        geometry->SetRawVertexData(build.cpuVertexData_, MASK_POSITION);
         maxLodGeometry->SetIndexBuffer(indexBuffer_);
         maxLodGeometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[0].first_, drawRanges_[0].second_, false);
-        maxLodGeometry->SetRawVertexData(cpuVertexData, MASK_POSITION);
+        maxLodGeometry->SetRawVertexData(build.cpuVertexData_, MASK_POSITION);
         occlusionGeometry->SetIndexBuffer(indexBuffer_);
         occlusionGeometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[occlusionDrawRange].first_, drawRanges_[occlusionDrawRange].second_, false);
-        occlusionGeometry->SetRawVertexData(occlusionCpuVertexData, MASK_POSITION);
+        occlusionGeometry->SetRawVertexData(build.occlusionCpuVertexData_, MASK_POSITION);
     }
 
     patch->ResetLod();
@@ -762,6 +855,7 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
 
 void Terrain::UpdatePatchLod(TerrainPatch* patch)
 {
+    // May be called from worker threads: only reads neighbor LOD levels and modifies this patch's own geometry
     Geometry* geometry = patch->GetGeometry();
 
     // All LOD levels except the coarsest have 16 versions for stitching
@@ -835,6 +929,16 @@ void Terrain::SetOcclusionLodLevelAttr(unsigned value)
     }
 }
 
+void Terrain::SetGPURenderingAttr(bool enable)
+{
+    if (enable != gpuRendering_)
+    {
+        gpuRendering_ = enable;
+        lastPatchSize_ = 0; // Force full recreate
+        recreateTerrain_ = true;
+    }
+}
+
 ResourceRef Terrain::GetMaterialAttr() const
 {
     return GetResourceRef(material_, Material::GetTypeStatic());
@@ -854,7 +958,20 @@ void Terrain::CreateGeometry()
 
     URHO3D_PROFILE(CreateTerrainGeometry);
 
+    // Apply the previous build first, as the dirty patches are found by comparing against the current height data
+    if (!buildItems_.Empty())
+    {
+        CompletePendingBuild();
+        FinishPendingBuild();
+    }
+
     unsigned prevNumPatches = patches_.Size();
+    bool hadGPUTerrain = gpuTerrain_ != nullptr;
+
+    bool gpuRendering = gpuRendering_ && IsGPURenderingSupported();
+    if (gpuRendering_ && !gpuRendering)
+        URHO3D_LOGWARNING("GPU terrain rendering is not supported, using terrain patches instead");
+    bool asyncBuild = !gpuRendering && IsAsyncBuildSupported();
 
     // Determine number of LOD levels
     auto lodSize = (unsigned)patchSize_;
@@ -905,8 +1022,9 @@ void Terrain::CreateGeometry()
     lastPatchSize_ = patchSize_;
     lastSpacing_ = spacing_;
 
-    // Remove old patch nodes which are not needed
-    if (updateAll)
+    // Remove old patch nodes which are not needed. When rendering on the GPU, none of them are. When building
+    // asynchronously, remove all on a full update so that stale patches are not drawn with the new index data
+    if (updateAll || gpuRendering)
     {
         URHO3D_PROFILE(RemoveOldPatches);
 
@@ -916,7 +1034,7 @@ void Terrain::CreateGeometry()
         {
             bool nodeOk = false;
             Vector<String> coords = (*i)->GetName().Substring(6).Split('_');
-            if (coords.Size() == 2)
+            if (!gpuRendering && !asyncBuild && coords.Size() == 2)
             {
                 int x = ToInt(coords[0]);
                 int z = ToInt(coords[1]);
@@ -929,6 +1047,14 @@ void Terrain::CreateGeometry()
         }
     }
 
+    if (!gpuRendering || !heightMap_)
+    {
+        Node* gpuTerrainNode = node_->GetChild("GPUTerrain");
+        if (gpuTerrainNode)
+            node_->RemoveChild(gpuTerrainNode);
+        gpuTerrain_.Reset();
+    }
+
     // Keep track of which patches actually need an update
     PODVector<bool> dirtyPatches((unsigned)(numPatches_.x_ * numPatches_.y_));
     for (unsigned i = 0; i < dirtyPatches.Size(); ++i)
@@ -1019,53 +1145,60 @@ void Terrain::CreateGeometry()
             }
         }
 
-        patches_.Reserve((unsigned)(numPatches_.x_ * numPatches_.y_));
-
         bool enabled = IsEnabledEffective();
 
+        if (gpuRendering)
+        {
+            Node* gpuTerrainNode = node_->GetChild("GPUTerrain");
+            if (!gpuTerrainNode)
+            {
+                // Create the scene node as local and temporary so that it is not unnecessarily serialized to either file or
+                // replicated over the network
+                gpuTerrainNode = node_->CreateTemporaryChild("GPUTerrain", LOCAL);
+            }
+
+            gpuTerrain_ = gpuTerrainNode->GetComponent<GPUTerrain>();
+            if (!gpuTerrain_)
+            {
+                gpuTerrain_ = gpuTerrainNode->CreateComponent<GPUTerrain>();
+                gpuTerrain_->SetOwner(this);
+
+                // Copy initial drawable parameters
+                gpuTerrain_->SetEnabled(enabled);
+                gpuTerrain_->SetMaterial(material_);
+                gpuTerrain_->SetDrawDistance(drawDistance_);
+                gpuTerrain_->SetShadowDistance(shadowDistance_);
+                gpuTerrain_->SetLodBias(lodBias_);
+                gpuTerrain_->SetViewMask(viewMask_);
+                gpuTerrain_->SetLightMask(lightMask_);
+                gpuTerrain_->SetShadowMask(shadowMask_);
+                gpuTerrain_->SetZoneMask(zoneMask_);
+                gpuTerrain_->SetMaxLights(maxLights_);
+                gpuTerrain_->SetCastShadows(castShadows_);
+                gpuTerrain_->SetOccludee(occludee_);
+            }
+        }
+        else
         {
             URHO3D_PROFILE(CreatePatches);
 
+            patches_.Reserve((unsigned)(numPatches_.x_ * numPatches_.y_));
+
             // Create patches and set node transforms
             for (int z = 0; z < numPatches_.y_; ++z)
             {
                 for (int x = 0; x < numPatches_.x_; ++x)
                 {
-                    String nodeName = "Patch_" + String(x) + "_" + String(z);
-                    Node* patchNode = node_->GetChild(nodeName);
-
-                    if (!patchNode)
-                    {
-                        // Create the patch scene node as local and temporary so that it is not unnecessarily serialized to either
-                        // file or replicated over the network
-                        patchNode = node_->CreateTemporaryChild(nodeName, LOCAL);
-                    }
-
-                    patchNode->SetPosition(Vector3(patchWorldOrigin_.x_ + (float)x * patchWorldSize_.x_, 0.0f,
-                        patchWorldOrigin_.y_ + (float)z * patchWorldSize_.y_));
-
-                    auto* patch = patchNode->GetComponent<TerrainPatch>();
-                    if (!patch)
+                    // When building asynchronously, new patches are created only once their geometry is ready
+                    TerrainPatch* patch = nullptr;
+                    if (asyncBuild)
                     {
-                        patch = patchNode->CreateComponent<TerrainPatch>();
-                        patch->SetOwner(this);
-                        patch->SetCoordinates(IntVector2(x, z));
-
-                        // Copy initial drawable parameters
-                        patch->SetEnabled(enabled);
-                        patch->SetMaterial(material_);
-                        patch->SetDrawDistance(drawDistance_);
-                        patch->SetShadowDistance(shadowDistance_);
-                        patch->SetLodBias(lodBias_);
-                        patch->SetViewMask(viewMask_);
-                        patch->SetLightMask(lightMask_);
-                        patch->SetShadowMask(shadowMask_);
-                        patch->SetZoneMask(zoneMask_);
-                        patch->SetMaxLights(maxLights_);
-                        patch->SetCastShadows(castShadows_);
-                        patch->SetOccluder(occluder_);
-                        patch->SetOccludee(occludee_);
+                        Node* patchNode = node_->GetChild("Patch_" + String(x) + "_" + String(z));
+                        if (patchNode)
+                            patch = patchNode->GetComponent<TerrainPatch>();
                     }
+                    else
+                        patch = CreatePatch(x, z);
 
                     patches_.Push(WeakPtr<TerrainPatch>(patch));
                 }
@@ -1073,7 +1206,7 @@ void Terrain::CreateGeometry()
         }
 
         // Create the shared index data
-        if (updateAll)
+        if (updateAll && !gpuRendering)
             CreateIndexData();
 
         // Create vertex data for patches. First update smoothing to ensure normals are calculated correctly across patch borders
@@ -1081,15 +1214,13 @@ void Terrain::CreateGeometry()
         {
             URHO3D_PROFILE(UpdateSmoothing);
 
-            for (unsigned i = 0; i < patches_.Size(); ++i)
+            for (unsigned i = 0; i < dirtyPatches.Size(); ++i)
             {
                 if (dirtyPatches[i])
                 {
-                    TerrainPatch* patch = patches_[i];
-                    const IntVector2& coords = patch->GetCoordinates();
-                    int startX = coords.x_ * patchSize_;
+                    int startX = (int)(i % numPatches_.x_) * patchSize_;
                     int endX = startX + patchSize_;
-                    int startZ = coords.y_ * patchSize_;
+                    int startZ = (int)(i / numPatches_.x_) * patchSize_;
                     int endZ = startZ + patchSize_;
 
                     for (int z = startZ; z <= endZ; ++z)
@@ -1109,6 +1240,20 @@ void Terrain::CreateGeometry()
             }
         }
 
+        if (asyncBuild)
+        {
+            bool anyDirty = false;
+            for (unsigned i = 0; i < dirtyPatches.Size() && !anyDirty; ++i)
+                anyDirty = dirtyPatches[i];
+
+            // The terrain created event is sent once the patches have been built
+            if (anyDirty)
+            {
+                StartPatchBuild(dirtyPatches);
+                return;
+            }
+        }
+
         for (unsigned i = 0; i < patches_.Size(); ++i)
         {
             TerrainPatch* patch = patches_[i];
@@ -1116,22 +1261,19 @@ void Terrain::CreateGeometry()
             if (dirtyPatches[i])
             {
                 CreatePatchGeometry(patch);
-                CalculateLodErrors(patch);
+                CalculateLodErrors(patch->GetCoordinates(), patch->GetLodErrors());
             }
 
             SetPatchNeighbors(patch);
         }
+
+        if (gpuTerrain_)
+            gpuTerrain_->UpdateHeightData();
     }
 
     // Send event only if new geometry was generated, or the old was cleared
-    if (patches_.Size() || prevNumPatches)
-    {
-        using namespace TerrainCreated;
-
-        VariantMap& eventData = GetEventDataMap();
-        eventData[P_NODE] = node_;
-        node_->SendEvent(E_TERRAINCREATED, eventData);
-    }
+    if (patches_.Size() || prevNumPatches || gpuTerrain_ || hadGPUTerrain)
+        SendTerrainCreatedEvent();
 }
 
 void Terrain::CreateIndexData()
@@ -1362,12 +1504,10 @@ Vector3 Terrain::GetRawNormal(int x, int z) const
             Vector3(nwSlope, up, nwSlope)).Normalized();
 }
 
-void Terrain::CalculateLodErrors(TerrainPatch* patch)
+void Terrain::CalculateLodErrors(const IntVector2& coords, PODVector<float>& lodErrors) const
 {
     URHO3D_PROFILE(CalculateLodErrors);
 
-    const IntVector2& coords = patch->GetCoordinates();
-    PODVector<float>& lodErrors = patch->GetLodErrors();
     lodErrors.Clear();
     lodErrors.Reserve(numLodLevels_);
 
@@ -1403,6 +1543,182 @@ void Terrain::CalculateLodErrors(TerrainPatch* patch)
     }
 }
 
+bool Terrain::IsGPURenderingSupported() const
+{
+#ifdef DESKTOP_GRAPHICS
+    return GetSubsystem<Graphics>() != nullptr;
+#else
+    return false;
+#endif
+}
+
+bool Terrain::IsAsyncBuildSupported() const
+{
+    auto* queue = GetSubsystem<WorkQueue>();
+    return asyncBuild_ && queue && queue->GetNumThreads() && GetScene();
+}
+
+TerrainPatch* Terrain::CreatePatch(int x, int z)
+{
+    String nodeName = "Patch_" + String(x) + "_" + String(z);
+    Node* patchNode = node_->GetChild(nodeName);
+
+    if (!patchNode)
+    {
+        // Create the patch scene node as local and temporary so that it is not unnecessarily serialized to either
+        // file or replicated over the network
+        patchNode = node_->CreateTemporaryChild(nodeName, LOCAL);
+    }
+
+    patchNode->SetPosition(Vector3(patchWorldOrigin_.x_ + (float)x * patchWorldSize_.x_, 0.0f,
+        patchWorldOrigin_.y_ + (float)z * patchWorldSize_.y_));
+
+    auto* patch = patchNode->GetComponent<TerrainPatch>();
+    if (!patch)
+    {
+        patch = patchNode->CreateComponent<TerrainPatch>();
+        patch->SetOwner(this);
+        patch->SetCoordinates(IntVector2(x, z));
+
+        // Copy initial drawable parameters
+        patch->SetEnabled(IsEnabledEffective());
+        patch->SetMaterial(material_);
+        patch->SetDrawDistance(drawDistance_);
+        patch->SetShadowDistance(shadowDistance_);
+        patch->SetLodBias(lodBias_);
+        patch->SetViewMask(viewMask_);
+        patch->SetLightMask(lightMask_);
+        patch->SetShadowMask(shadowMask_);
+        patch->SetZoneMask(zoneMask_);
+        patch->SetMaxLights(maxLights_);
+        patch->SetCastShadows(castShadows_);
+        patch->SetOccluder(occluder_);
+        patch->SetOccludee(occludee_);
+    }
+
+    return patch;
+}
+
+void Terrain::StartPatchBuild(const PODVector<bool>& dirtyPatches)
+{
+    auto* queue = GetSubsystem<WorkQueue>();
+
+    pendingPatches_.Clear();
+    for (unsigned i = 0; i < dirtyPatches.Size(); ++i)
+    {
+        if (dirtyPatches[i])
+        {
+            TerrainPatchBuild build;
+            build.coordinates_ = IntVector2(i % numPatches_.x_, i / numPatches_.x_);
+            pendingPatches_.Push(build);
+        }
+    }
+
+    // Split the patches evenly between the worker threads
+    unsigned numItems = Min(queue->GetNumThreads(), pendingPatches_.Size());
+    for (unsigned i = 0; i < numItems; ++i)
+    {
+        // Not pooled items, as the work queue would reset and reuse them while still being polled here
+        SharedPtr<WorkItem> item(new WorkItem());
+        item->priority_ = 0;
+        item->workFunction_ = BuildTerrainPatchesWork;
+        item->aux_ = this;
+        item->start_ = pendingPatches_.Buffer() + i * pendingPatches_.Size() / numItems;
+        item->end_ = pendingPatches_.Buffer() + (i + 1) * pendingPatches_.Size() / numItems;
+        queue->AddWorkItem(item);
+        buildItems_.Push(item);
+    }
+
+    // The built patches are applied on scene post-update
+    SubscribeToEvent(GetScene(), E_SCENEPOSTUPDATE, URHO3D_HANDLER(Terrain, HandleScenePostUpdate));
+}
+
+void Terrain::CompletePendingBuild()
+{
+    auto* queue = GetSubsystem<WorkQueue>();
+
+    for (unsigned i = 0; i < buildItems_.Size(); ++i)
+    {
+        WorkItem* item = buildItems_[i];
+        if (item->completed_)
+            continue;
+
+        // Build on this thread the patches that the worker threads have not started yet
+        if (queue && queue->RemoveWorkItem(SharedPtr<WorkItem>(item)))
+        {
+            item->workFunction_(item, 0);
+            item->completed_ = true;
+        }
+        else
+        {
+            while (!item->completed_)
+                Time::Sleep(0);
+        }
+    }
+}
+
+void Terrain::CancelPendingBuild()
+{
+    auto* queue = GetSubsystem<WorkQueue>();
+
+    // The patches can only be freed once the worker threads no longer use them
+    for (unsigned i = 0; i < buildItems_.Size(); ++i)
+    {
+        WorkItem* item = buildItems_[i];
+        if (!item->completed_ && !(queue && queue->RemoveWorkItem(SharedPtr<WorkItem>(item))))
+        {
+            while (queue && !item->completed_)
+                Time::Sleep(0);
+        }
+    }
+
+    UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+    buildItems_.Clear();
+    pendingPatches_.Clear();
+}
+
+void Terrain::FinishPendingBuild()
+{
+    URHO3D_PROFILE(FinishTerrainPatches);
+
+    UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+    buildItems_.Clear();
+
+    for (unsigned i = 0; i < pendingPatches_.Size(); ++i)
+    {
+        TerrainPatchBuild& build = pendingPatches_[i];
+        unsigned index = build.coordinates_.y_ * numPatches_.x_ + build.coordinates_.x_;
+        if (index >= patches_.Size())
+            continue;
+
+        TerrainPatch* patch = patches_[index];
+        if (!patch)
+        {
+            patch = CreatePatch(build.coordinates_.x_, build.coordinates_.y_);
+            patches_[index] = patch;
+        }
+
+        ApplyPatchGeometry(patch, build);
+        patch->GetLodErrors().Swap(build.lodErrors_);
+    }
+
+    pendingPatches_.Clear();
+
+    for (unsigned i = 0; i < patches_.Size(); ++i)
+        SetPatchNeighbors(patches_[i]);
+
+    SendTerrainCreatedEvent();
+}
+
+void Terrain::SendTerrainCreatedEvent()
+{
+    using namespace TerrainCreated;
+
+    VariantMap& eventData = GetEventDataMap();
+    eventData[P_NODE] = node_;
+    node_->SendEvent(E_TERRAINCREATED, eventData);
+}
+
 void Terrain::SetPatchNeighbors(TerrainPatch* patch)
 {
     if (!patch)
@@ -1447,6 +1763,23 @@ void Terrain::HandleNeighborTerrainCreated(StringHash /*eventType*/, VariantMap&
     UpdateEdgePatchNeighbors();
 }
 
+void Terrain::HandleScenePostUpdate(StringHash /*eventType*/, VariantMap& /*eventData*/)
+{
+    if (!node_)
+    {
+        CancelPendingBuild();
+        return;
+    }
+
+    for (unsigned i = 0; i < buildItems_.Size(); ++i)
+    {
+        if (!buildItems_[i]->completed_)
+            return;
+    }
+
+    FinishPendingBuild();
+}
+
 void Terrain::UpdateEdgePatchNeighbors()
 {
     for (int x = 1; x < numPatches_.x_ - 1; ++x)
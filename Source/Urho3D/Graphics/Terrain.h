@@ -23,22 +23,45 @@
 #pragma once
 
 #include "../Container/ArrayPtr.h"
+#include "../Math/BoundingBox.h"
 #include "../Scene/Component.h"
 
 namespace Urho3D
 {
 
+class GPUTerrain;
 class Image;
 class IndexBuffer;
 class Material;
 class Node;
 class TerrainPatch;
+struct WorkItem;
+
+/// %Terrain patch vertex data being built, possibly in a worker thread.
+/// @nobind
+struct TerrainPatchBuild
+{
+    /// Patch coordinates.
+    IntVector2 coordinates_;
+    /// Vertex buffer data.
+    SharedArrayPtr<float> vertexData_;
+    /// CPU-side position data for raycasts.
+    SharedArrayPtr<unsigned char> cpuVertexData_;
+    /// CPU-side position data for the occlusion LOD.
+    SharedArrayPtr<unsigned char> occlusionCpuVertexData_;
+    /// Local space bounding box.
+    BoundingBox boundingBox_;
+    /// LOD errors.
+    PODVector<float> lodErrors_;
+};
 
 /// Heightmap terrain component.
 class URHO3D_API Terrain : public Component
 {
     URHO3D_OBJECT(Terrain, Component);
 
+    friend void BuildTerrainPatchesWork(const WorkItem* item, unsigned threadIndex);
+
 public:
     /// Construct.
     explicit Terrain(Context* context);
@@ -48,6 +71,8 @@ public:
     /// @nobind
     static void RegisterObject(Context* context);
 
+    /// Handle attribute write access.
+    void OnSetAttribute(const AttributeInfo& attr, const Variant& src) override;
     /// Apply attribute changes that can not be applied immediately. Called after scene load or a network update.
     void ApplyAttributes() override;
     /// Handle enabled/disabled state change.
@@ -121,6 +146,12 @@ public:
     /// Set occludee flag for patches.
     /// @property
     void SetOccludee(bool enable);
+    /// Set GPU rendering. When enabled, the terrain is drawn by instancing a single grid patch per visible quadtree node with heights sampled from a texture in the vertex shader, instead of creating a patch drawable per terrain patch. Requires desktop graphics and a material using a GPUTERRAIN technique such as TerrainBlendGPU; falls back to CPU patches otherwise.
+    /// @property
+    void SetGPURendering(bool enable);
+    /// Set asynchronous patch building. When enabled and the scene has worker threads, patch vertex data is built in worker threads and uploaded on scene post-update; patches that did not exist before appear once built.
+    /// @property
+    void SetAsyncBuild(bool enable);
     /// Apply changes from the heightmap image.
     void ApplyHeightMap();
 
@@ -240,6 +271,21 @@ public:
     /// @property
     bool IsOccludee() const { return occludee_; }
 
+    /// Return whether GPU rendering is requested.
+    /// @property
+    bool GetGPURendering() const { return gpuRendering_; }
+
+    /// Return whether asynchronous patch building is enabled.
+    /// @property
+    bool GetAsyncBuild() const { return asyncBuild_; }
+
+    /// Return whether patch geometry is currently being built in worker threads.
+    bool IsBuilding() const { return !buildItems_.Empty(); }
+
+    /// Return the GPU terrain drawable, or null when rendering with CPU patches.
+    /// @nobind
+    GPUTerrain* GetGPUTerrain() const { return gpuTerrain_; }
+
     /// Regenerate patch geometry.
     void CreatePatchGeometry(TerrainPatch* patch);
     /// Update patch based on LOD and neighbor LOD.
@@ -254,6 +300,8 @@ public:
     void SetMaxLodLevelsAttr(unsigned value);
     /// Set occlusion LOD level attribute.
     void SetOcclusionLodLevelAttr(unsigned value);
+    /// Set GPU rendering attribute.
+    void SetGPURenderingAttr(bool enable);
     /// Return heightmap attribute.
     ResourceRef GetHeightMapAttr() const;
     /// Return material attribute.
@@ -272,10 +320,32 @@ private:
     float GetLodHeight(int x, int z, unsigned lodLevel) const;
     /// Get slope-based terrain normal at position.
     Vector3 GetRawNormal(int x, int z) const;
-    /// Calculate LOD errors for a patch.
-    void CalculateLodErrors(TerrainPatch* patch);
+    /// Calculate LOD errors for a patch. May be called from a worker thread.
+    void CalculateLodErrors(const IntVector2& coords, PODVector<float>& lodErrors) const;
+    /// Build patch vertex data and bounding box. May be called from a worker thread.
+    void BuildPatchGeometry(TerrainPatchBuild& build) const;
+    /// Upload built patch vertex data to the patch geometry.
+    void ApplyPatchGeometry(TerrainPatch* patch, TerrainPatchBuild& build);
+    /// Return patch at coordinates, creating its scene node and component if necessary.
+    TerrainPatch* CreatePatch(int x, int z);
+    /// Queue the dirty patches to be built in worker threads.
+    void StartPatchBuild(const PODVector<bool>& dirtyPatches);
+    /// Wait until the patches being built in worker threads are ready.
+    void CompletePendingBuild();
+    /// Apply the patches built in worker threads.
+    void FinishPendingBuild();
+    /// Cancel the patches being built in worker threads, waiting for the ones already started.
+    void CancelPendingBuild();
+    /// Return whether the dirty patches can be built in worker threads.
+    bool IsAsyncBuildSupported() const;
+    /// Send the terrain created event.
+    void SendTerrainCreatedEvent();
+    /// Handle scene post-update event. Apply the built patches once all worker threads are done.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
     /// Set neighbors for a patch.
     void SetPatchNeighbors(TerrainPatch* patch);
+    /// Return whether GPU rendering can be used.
+    bool IsGPURenderingSupported() const;
     /// Set heightmap image and optionally recreate the geometry immediately. Return true if successful.
     bool SetHeightMapInternal(Image* image, bool recreateNow);
     /// Handle heightmap image reload finished.
@@ -301,6 +371,8 @@ private:
     SharedPtr<Material> material_;
     /// Terrain patches.
     Vector<WeakPtr<TerrainPatch> > patches_;
+    /// GPU terrain drawable when GPU rendering is in use.
+    WeakPtr<GPUTerrain> gpuTerrain_;
     /// Draw ranges for different LODs and stitching combinations.
     PODVector<Pair<unsigned, unsigned> > drawRanges_;
     /// North neighbor terrain.
@@ -345,6 +417,8 @@ private:
     bool occluder_;
     /// Occludee flag.
     bool occludee_;
+    /// GPU rendering flag.
+    bool gpuRendering_;
     /// View mask.
     unsigned viewMask_;
     /// Light mask.
@@ -373,6 +447,12 @@ private:
     bool recreateTerrain_;
     /// Terrain neighbor attributes dirty flag.
     bool neighborsDirty_;
+    /// Asynchronous patch building flag.
+    bool asyncBuild_;
+    /// Patches being built in worker threads.
+    Vector<TerrainPatchBuild> pendingPatches_;
+    /// Work items building the pending patches.
+    Vector<SharedPtr<WorkItem> > buildItems_;
 };
 
 }
@@ -154,9 +154,10 @@ void TerrainPatch::UpdateGeometry(const FrameInfo& frame)
 
 UpdateGeometryType TerrainPatch::GetUpdateGeometryType()
 {
-    // Because there is a latency in starting worker thread updates, and the update of terrain patch LOD should not take
-    // much time, always update in the main thread
-    return UPDATE_MAIN_THREAD;
+    // Stitching only picks a precomputed draw range based on the LOD levels chosen in UpdateBatches(), which are final for
+    // all patches by the time geometries update, so it can be done in worker threads. Restoring lost vertex data needs the
+    // main thread
+    return vertexBuffer_->IsDataLost() ? UPDATE_MAIN_THREAD : UPDATE_WORKER_THREAD;
 }
 
 Geometry* TerrainPatch::GetLodGeometry(unsigned batchIndex, unsigned level)
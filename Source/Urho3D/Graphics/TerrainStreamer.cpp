@@ -0,0 +1,659 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Terrain.h"
+#include "../Graphics/TerrainStreamer.h"
+#include "../IO/Log.h"
+#include "../Resource/Image.h"
+#include "../Resource/ResourceCache.h"
+#include "../Resource/ResourceEvents.h"
+#include "../Scene/Node.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+extern const char* GEOMETRY_CATEGORY;
+
+static const Vector3 DEFAULT_SPACING(1.0f, 0.25f, 1.0f);
+static const int DEFAULT_TILE_SIZE = 256;
+static const int DEFAULT_PATCH_SIZE = 32;
+static const unsigned DEFAULT_MAX_LOD_LEVELS = 4;
+static const float DEFAULT_LOAD_DISTANCE = 400.0f;
+static const float DEFAULT_UNLOAD_DISTANCE = 500.0f;
+static const unsigned DEFAULT_MAX_RESIDENT_TILES = 16;
+static const unsigned DEFAULT_MAX_LOADING_TILES = 4;
+/// Tile terrains created per frame. Creating one copies and smooths its heights on the main thread.
+static const unsigned MAX_TILE_BUILDS_PER_FRAME = 1;
+
+/// Tile waiting to start loading, sorted by distance.
+struct TileCandidate
+{
+    /// Tile coordinates.
+    IntVector2 coords_;
+    /// Distance to the focus position.
+    float distance_;
+};
+
+static bool CompareTileCandidates(const TileCandidate& lhs, const TileCandidate& rhs)
+{
+    return lhs.distance_ < rhs.distance_;
+}
+
+static String GetTileName(const String& pattern, const IntVector2& tile)
+{
+    return pattern.Replaced("{x}", String(tile.x_)).Replaced("{z}", String(tile.y_));
+}
+
+TerrainStreamer::TerrainStreamer(Context* context) :
+    Component(context),
+    focusPosition_(Vector3::ZERO),
+    spacing_(DEFAULT_SPACING),
+    tileSize_(DEFAULT_TILE_SIZE),
+    patchSize_(DEFAULT_PATCH_SIZE),
+    maxLodLevels_(DEFAULT_MAX_LOD_LEVELS),
+    smoothing_(false),
+    castShadows_(false),
+    drawDistance_(0.0f),
+    lodBias_(1.0f),
+    loadDistance_(DEFAULT_LOAD_DISTANCE),
+    unloadDistance_(DEFAULT_UNLOAD_DISTANCE),
+    maxResidentTiles_(DEFAULT_MAX_RESIDENT_TILES),
+    maxLoadingTiles_(DEFAULT_MAX_LOADING_TILES),
+    subscribed_(false)
+{
+}
+
+TerrainStreamer::~TerrainStreamer()
+{
+    UnloadAllTiles();
+}
+
+void TerrainStreamer::RegisterObject(Context* context)
+{
+    context->RegisterFactory<TerrainStreamer>(GEOMETRY_CATEGORY);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Height Map Tiles", GetHeightMapTiles, SetHeightMapTiles, String, String::EMPTY, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Material Tiles", GetMaterialTiles, SetMaterialTiles, String, String::EMPTY, AM_DEFAULT);
+    URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Material", GetMaterialAttr, SetMaterialAttr, ResourceRef, ResourceRef(Material::GetTypeStatic()),
+        AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Tile Size", GetTileSize, SetTileSize, int, DEFAULT_TILE_SIZE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Vertex Spacing", GetSpacing, SetSpacing, Vector3, DEFAULT_SPACING, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Patch Size", GetPatchSize, SetPatchSize, int, DEFAULT_PATCH_SIZE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max LOD Levels", GetMaxLodLevels, SetMaxLodLevels, unsigned, DEFAULT_MAX_LOD_LEVELS, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Smooth Height Map", GetSmoothing, SetSmoothing, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cast Shadows", GetCastShadows, SetCastShadows, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Draw Distance", GetDrawDistance, SetDrawDistance, float, 0.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("LOD Bias", GetLodBias, SetLodBias, float, 1.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Load Distance", GetLoadDistance, SetLoadDistance, float, DEFAULT_LOAD_DISTANCE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Unload Distance", GetUnloadDistance, SetUnloadDistance, float, DEFAULT_UNLOAD_DISTANCE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Resident Tiles", GetMaxResidentTiles, SetMaxResidentTiles, unsigned, DEFAULT_MAX_RESIDENT_TILES,
+        AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Loading Tiles", GetMaxLoadingTiles, SetMaxLoadingTiles, unsigned, DEFAULT_MAX_LOADING_TILES,
+        AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Focus Position", GetFocusPosition, SetFocusPosition, Vector3, Vector3::ZERO, AM_DEFAULT);
+}
+
+void TerrainStreamer::OnSetEnabled()
+{
+    UpdateEventSubscription();
+}
+
+void TerrainStreamer::SetHeightMapTiles(const String& pattern)
+{
+    if (pattern != heightMapTiles_)
+    {
+        UnloadAllTiles();
+        heightMapTiles_ = pattern;
+        MarkNetworkUpdate();
+    }
+}
+
+void TerrainStreamer::SetMaterialTiles(const String& pattern)
+{
+    if (pattern != materialTiles_)
+    {
+        UnloadAllTiles();
+        materialTiles_ = pattern;
+        MarkNetworkUpdate();
+    }
+}
+
+void TerrainStreamer::SetMaterial(Material* material)
+{
+    material_ = material;
+
+    for (HashMap<IntVector2, StreamedTerrainTile>::Iterator i = tiles_.Begin(); i != tiles_.End(); ++i)
+    {
+        Terrain* terrain = GetTileTerrain(i->first_);
+        if (terrain && i->second_.materialName_.Empty())
+            terrain->SetMaterial(material);
+    }
+
+    MarkNetworkUpdate();
+}
+
+void TerrainStreamer::SetTileSize(int size)
+{
+    size = Max(size, 1);
+    if (size != tileSize_)
+    {
+        // The resident tiles no longer match the grid, so start over
+        UnloadAllTiles();
+        tileSize_ = size;
+        MarkNetworkUpdate();
+    }
+}
+
+void TerrainStreamer::SetSpacing(const Vector3& spacing)
+{
+    if (spacing != spacing_)
+    {
+        UnloadAllTiles();
+        spacing_ = spacing;
+        MarkNetworkUpdate();
+    }
+}
+
+void TerrainStreamer::SetPatchSize(int size)
+{
+    if (size != patchSize_)
+    {
+        UnloadAllTiles();
+        patchSize_ = size;
+        MarkNetworkUpdate();
+    }
+}
+
+void TerrainStreamer::SetMaxLodLevels(unsigned levels)
+{
+    if (levels != maxLodLevels_)
+    {
+        UnloadAllTiles();
+        maxLodLevels_ = levels;
+        MarkNetworkUpdate();
+    }
+}
+
+void TerrainStreamer::SetSmoothing(bool enable)
+{
+    if (enable != smoothing_)
+    {
+        UnloadAllTiles();
+        smoothing_ = enable;
+        MarkNetworkUpdate();
+    }
+}
+
+void TerrainStreamer::SetCastShadows(bool enable)
+{
+    castShadows_ = enable;
+
+    for (HashMap<IntVector2, StreamedTerrainTile>::Iterator i = tiles_.Begin(); i != tiles_.End(); ++i)
+    {
+        Terrain* terrain = GetTileTerrain(i->first_);
+        if (terrain)
+            terrain->SetCastShadows(enable);
+    }
+
+    MarkNetworkUpdate();
+}
+
+void TerrainStreamer::SetDrawDistance(float distance)
+{
+    drawDistance_ = distance;
+
+    for (HashMap<IntVector2, StreamedTerrainTile>::Iterator i = tiles_.Begin(); i != tiles_.End(); ++i)
+    {
+        Terrain* terrain = GetTileTerrain(i->first_);
+        if (terrain)
+            terrain->SetDrawDistance(distance);
+    }
+
+    MarkNetworkUpdate();
+}
+
+void TerrainStreamer::SetLodBias(float bias)
+{
+    lodBias_ = bias;
+
+    for (HashMap<IntVector2, StreamedTerrainTile>::Iterator i = tiles_.Begin(); i != tiles_.End(); ++i)
+    {
+        Terrain* terrain = GetTileTerrain(i->first_);
+        if (terrain)
+            terrain->SetLodBias(bias);
+    }
+
+    MarkNetworkUpdate();
+}
+
+void TerrainStreamer::SetLoadDistance(float distance)
+{
+    loadDistance_ = Max(distance, 0.0f);
+    MarkNetworkUpdate();
+}
+
+void TerrainStreamer::SetUnloadDistance(float distance)
+{
+    unloadDistance_ = Max(distance, 0.0f);
+    MarkNetworkUpdate();
+}
+
+void TerrainStreamer::SetMaxResidentTiles(unsigned num)
+{
+    maxResidentTiles_ = Max(num, 1U);
+    MarkNetworkUpdate();
+}
+
+void TerrainStreamer::SetMaxLoadingTiles(unsigned num)
+{
+    maxLoadingTiles_ = Max(num, 1U);
+    MarkNetworkUpdate();
+}
+
+void TerrainStreamer::SetFocusNode(Node* node)
+{
+    focusNode_ = node;
+}
+
+void TerrainStreamer::SetFocusPosition(const Vector3& position)
+{
+    focusPosition_ = position;
+    MarkNetworkUpdate();
+}
+
+void TerrainStreamer::UnloadAllTiles()
+{
+    for (HashMap<IntVector2, StreamedTerrainTile>::Iterator i = tiles_.Begin(); i != tiles_.End(); ++i)
+        UnloadTile(i->second_);
+    tiles_.Clear();
+}
+
+Material* TerrainStreamer::GetMaterial() const
+{
+    return material_;
+}
+
+Vector3 TerrainStreamer::GetFocusPosition() const
+{
+    return focusNode_ ? focusNode_->GetWorldPosition() : focusPosition_;
+}
+
+unsigned TerrainStreamer::GetNumLoadedTiles() const
+{
+    unsigned numLoaded = 0;
+    for (HashMap<IntVector2, StreamedTerrainTile>::ConstIterator i = tiles_.Begin(); i != tiles_.End(); ++i)
+    {
+        if (i->second_.state_ == TILE_LOADED)
+            ++numLoaded;
+    }
+    return numLoaded;
+}
+
+TerrainTileState TerrainStreamer::GetTileState(const IntVector2& tile) const
+{
+    HashMap<IntVector2, StreamedTerrainTile>::ConstIterator i = tiles_.Find(tile);
+    return i != tiles_.End() ? i->second_.state_ : TILE_EMPTY;
+}
+
+Terrain* TerrainStreamer::GetTileTerrain(const IntVector2& tile) const
+{
+    HashMap<IntVector2, StreamedTerrainTile>::ConstIterator i = tiles_.Find(tile);
+    return i != tiles_.End() && i->second_.node_ ? i->second_.node_->GetComponent<Terrain>() : nullptr;
+}
+
+IntVector2 TerrainStreamer::GetTile(const Vector3& worldPosition) const
+{
+    Vector3 position = node_ ? node_->GetWorldTransform().Inverse() * worldPosition : worldPosition;
+    return IntVector2(FloorToInt(position.x_ / (tileSize_ * spacing_.x_)), FloorToInt(position.z_ / (tileSize_ * spacing_.z_)));
+}
+
+float TerrainStreamer::GetHeight(const Vector3& worldPosition) const
+{
+    Terrain* terrain = GetTileTerrain(GetTile(worldPosition));
+    return terrain ? terrain->GetHeight(worldPosition) : 0.0f;
+}
+
+String TerrainStreamer::GetTileHeightMapName(const IntVector2& tile) const
+{
+    return GetTileName(heightMapTiles_, tile);
+}
+
+String TerrainStreamer::GetTileMaterialName(const IntVector2& tile) const
+{
+    return materialTiles_.Empty() ? String::EMPTY : GetTileName(materialTiles_, tile);
+}
+
+void TerrainStreamer::SetMaterialAttr(const ResourceRef& value)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    SetMaterial(cache->GetResource<Material>(value.name_));
+}
+
+ResourceRef TerrainStreamer::GetMaterialAttr() const
+{
+    return GetResourceRef(material_, Material::GetTypeStatic());
+}
+
+void TerrainStreamer::OnSceneSet(Scene* scene)
+{
+    if (!scene)
+    {
+        UnloadAllTiles();
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+        UnsubscribeFromEvent(E_RESOURCEBACKGROUNDLOADED);
+        subscribed_ = false;
+    }
+    else
+        UpdateEventSubscription();
+}
+
+void TerrainStreamer::UpdateEventSubscription()
+{
+    Scene* scene = GetScene();
+    if (!scene)
+        return;
+
+    bool enabled = IsEnabledEffective();
+
+    if (enabled && !subscribed_)
+    {
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(TerrainStreamer, HandleScenePostUpdate));
+        SubscribeToEvent(E_RESOURCEBACKGROUNDLOADED, URHO3D_HANDLER(TerrainStreamer, HandleResourceBackgroundLoaded));
+        subscribed_ = true;
+    }
+    else if (!enabled && subscribed_)
+    {
+        // Keep the resident tiles, but do not stream while disabled
+        UnsubscribeFromEvent(scene, E_SCENEPOSTUPDATE);
+        UnsubscribeFromEvent(E_RESOURCEBACKGROUNDLOADED);
+        subscribed_ = false;
+    }
+}
+
+void TerrainStreamer::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    URHO3D_PROFILE(UpdateTerrainStreaming);
+
+    if (heightMapTiles_.Empty())
+        return;
+
+    Vector3 focus = node_->GetWorldTransform().Inverse() * GetFocusPosition();
+    unsigned numLoading = 0;
+
+    // Unload the tiles beyond the unload distance, including ones that are still loading. Also forget tiles whose
+    // terrain was removed from outside, so that they load again
+    for (HashMap<IntVector2, StreamedTerrainTile>::Iterator i = tiles_.Begin(); i != tiles_.End();)
+    {
+        StreamedTerrainTile& tile = i->second_;
+        if (GetTileDistance(i->first_, focus) > unloadDistance_ || ((tile.state_ == TILE_BUILDING || tile.state_ == TILE_LOADED) &&
+            !tile.node_))
+        {
+            UnloadTile(tile);
+            i = tiles_.Erase(i);
+            continue;
+        }
+
+        if (tile.state_ == TILE_LOADING)
+            ++numLoading;
+        else if (tile.state_ == TILE_BUILDING)
+        {
+            auto* terrain = tile.node_->GetComponent<Terrain>();
+            if (!terrain || !terrain->IsBuilding())
+                tile.state_ = TILE_LOADED;
+        }
+
+        ++i;
+    }
+
+    // Find the tiles within the load distance that are not resident yet, nearest first
+    PODVector<TileCandidate> candidates;
+    float tileWidth = tileSize_ * spacing_.x_;
+    float tileDepth = tileSize_ * spacing_.z_;
+    IntVector2 minTile(FloorToInt((focus.x_ - loadDistance_) / tileWidth), FloorToInt((focus.z_ - loadDistance_) / tileDepth));
+    IntVector2 maxTile(FloorToInt((focus.x_ + loadDistance_) / tileWidth), FloorToInt((focus.z_ + loadDistance_) / tileDepth));
+    for (int z = minTile.y_; z <= maxTile.y_; ++z)
+    {
+        for (int x = minTile.x_; x <= maxTile.x_; ++x)
+        {
+            TileCandidate candidate;
+            candidate.coords_ = IntVector2(x, z);
+            candidate.distance_ = GetTileDistance(candidate.coords_, focus);
+            if (candidate.distance_ <= loadDistance_ && !tiles_.Contains(candidate.coords_))
+                candidates.Push(candidate);
+        }
+    }
+    Sort(candidates.Begin(), candidates.End(), CompareTileCandidates);
+
+    for (PODVector<TileCandidate>::ConstIterator i = candidates.Begin(); i != candidates.End() && numLoading < maxLoadingTiles_; ++i)
+    {
+        // Keep the resident set at a fixed size by unloading the farthest tile, if it is farther than the new one
+        if (tiles_.Size() >= maxResidentTiles_)
+        {
+            HashMap<IntVector2, StreamedTerrainTile>::Iterator farthest = tiles_.End();
+            float farthestDistance = i->distance_;
+            for (HashMap<IntVector2, StreamedTerrainTile>::Iterator j = tiles_.Begin(); j != tiles_.End(); ++j)
+            {
+                float distance = GetTileDistance(j->first_, focus);
+                if (distance > farthestDistance)
+                {
+                    farthest = j;
+                    farthestDistance = distance;
+                }
+            }
+
+            if (farthest == tiles_.End())
+                break;
+
+            if (farthest->second_.state_ == TILE_LOADING)
+                --numLoading;
+            UnloadTile(farthest->second_);
+            tiles_.Erase(farthest);
+        }
+
+        BeginLoadTile(i->coords_);
+        if (tiles_[i->coords_].state_ == TILE_LOADING)
+            ++numLoading;
+    }
+
+    // Create the terrains of the tiles whose resources have loaded. Their patches are then built in worker threads
+    unsigned numBuilds = 0;
+    for (HashMap<IntVector2, StreamedTerrainTile>::Iterator i = tiles_.Begin(); i != tiles_.End() &&
+        numBuilds < MAX_TILE_BUILDS_PER_FRAME; ++i)
+    {
+        if (i->second_.state_ == TILE_LOADING && i->second_.resources_.Empty())
+        {
+            BuildTile(i->first_, i->second_);
+            ++numBuilds;
+        }
+    }
+}
+
+void TerrainStreamer::HandleResourceBackgroundLoaded(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ResourceBackgroundLoaded;
+
+    auto* resource = static_cast<Resource*>(eventData[P_RESOURCE].GetPtr());
+    StringHash nameHash = resource->GetNameHash();
+    bool used = false;
+
+    for (HashMap<IntVector2, StreamedTerrainTile>::Iterator i = tiles_.Begin(); i != tiles_.End(); ++i)
+    {
+        if (i->second_.state_ == TILE_LOADING && i->second_.resources_.Erase(nameHash))
+            used = true;
+    }
+
+    // Do not keep resources of tiles that were unloaded while loading
+    if (cancelledResources_.Erase(nameHash) && !used)
+        GetSubsystem<ResourceCache>()->ReleaseResource(resource->GetType(), resource->GetName());
+}
+
+void TerrainStreamer::BeginLoadTile(const IntVector2& tile)
+{
+    StreamedTerrainTile& newTile = tiles_[tile];
+
+    // Tiles without a heightmap are remembered as empty so that the heightmap is not looked up again while in range
+    auto* cache = GetSubsystem<ResourceCache>();
+    newTile.heightMapName_ = GetTileHeightMapName(tile);
+    if (!cache->Exists(newTile.heightMapName_))
+    {
+        newTile.state_ = TILE_EMPTY;
+        return;
+    }
+
+    QueueTileResource(newTile, Image::GetTypeStatic(), newTile.heightMapName_);
+
+    // The material loads its textures, such as tile specific weight and normal maps, as dependencies
+    String materialName = GetTileMaterialName(tile);
+    if (!materialName.Empty() && cache->Exists(materialName))
+    {
+        newTile.materialName_ = materialName;
+        QueueTileResource(newTile, Material::GetTypeStatic(), materialName);
+    }
+
+    newTile.state_ = TILE_LOADING;
+}
+
+void TerrainStreamer::QueueTileResource(StreamedTerrainTile& tile, StringHash type, const String& name)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    if (cache->GetExistingResource(type, name))
+        return;
+
+    // Without threading support the resource is loaded immediately
+    cache->BackgroundLoadResource(type, name);
+    if (!cache->GetExistingResource(type, name))
+        tile.resources_.Insert(StringHash(name));
+}
+
+void TerrainStreamer::BuildTile(const IntVector2& coords, StreamedTerrainTile& tile)
+{
+    URHO3D_PROFILE(BuildTerrainTile);
+
+    auto* cache = GetSubsystem<ResourceCache>();
+    auto* heightMap = cache->GetExistingResource<Image>(tile.heightMapName_);
+    if (!heightMap)
+    {
+        URHO3D_LOGERROR("Could not load terrain tile heightmap " + tile.heightMapName_);
+        tile.state_ = TILE_EMPTY;
+        return;
+    }
+
+    if (heightMap->GetWidth() != tileSize_ + 1 || heightMap->GetHeight() != tileSize_ + 1)
+    {
+        URHO3D_LOGWARNING("Terrain tile heightmap " + tile.heightMapName_ + " should be " + String(tileSize_ + 1) + "x" +
+            String(tileSize_ + 1) + " pixels");
+    }
+
+    Material* material = material_;
+    if (!tile.materialName_.Empty())
+    {
+        material = cache->GetExistingResource<Material>(tile.materialName_);
+        if (!material)
+        {
+            URHO3D_LOGERROR("Could not load terrain tile material " + tile.materialName_);
+            material = material_;
+        }
+    }
+
+    // Create the tile node as local and temporary so that it is not unnecessarily serialized to either file or replicated
+    // over the network
+    tile.node_ = node_->CreateTemporaryChild("Tile_" + String(coords.x_) + "_" + String(coords.y_), LOCAL);
+    tile.node_->SetPosition(GetTileCenter(coords));
+
+    auto* terrain = tile.node_->CreateComponent<Terrain>();
+    terrain->SetAsyncBuild(true);
+    terrain->SetPatchSize(patchSize_);
+    terrain->SetMaxLodLevels(maxLodLevels_);
+    terrain->SetSpacing(spacing_);
+    terrain->SetSmoothing(smoothing_);
+    terrain->SetCastShadows(castShadows_);
+    terrain->SetDrawDistance(drawDistance_);
+    terrain->SetLodBias(lodBias_);
+    terrain->SetMaterial(material);
+
+    // Link the neighbor tiles for seamless LOD stitching. North is towards positive Z
+    Terrain* north = GetTileTerrain(coords + IntVector2(0, 1));
+    Terrain* south = GetTileTerrain(coords + IntVector2(0, -1));
+    Terrain* west = GetTileTerrain(coords + IntVector2(-1, 0));
+    Terrain* east = GetTileTerrain(coords + IntVector2(1, 0));
+    terrain->SetNeighbors(north, south, west, east);
+    if (north)
+        north->SetSouthNeighbor(terrain);
+    if (south)
+        south->SetNorthNeighbor(terrain);
+    if (west)
+        west->SetEastNeighbor(terrain);
+    if (east)
+        east->SetWestNeighbor(terrain);
+
+    terrain->SetHeightMap(heightMap);
+    tile.state_ = terrain->IsBuilding() ? TILE_BUILDING : TILE_LOADED;
+}
+
+void TerrainStreamer::UnloadTile(StreamedTerrainTile& tile)
+{
+    if (tile.node_)
+        tile.node_->Remove();
+    tile.node_.Reset();
+
+    // Release the tile resources from the cache, unless used elsewhere
+    auto* cache = GetSubsystem<ResourceCache>();
+    if (tile.state_ == TILE_LOADING)
+    {
+        for (HashSet<StringHash>::ConstIterator i = tile.resources_.Begin(); i != tile.resources_.End(); ++i)
+            cancelledResources_.Insert(*i);
+    }
+    if (!tile.heightMapName_.Empty())
+        cache->ReleaseResource<Image>(tile.heightMapName_);
+    if (!tile.materialName_.Empty())
+        cache->ReleaseResource<Material>(tile.materialName_);
+    tile.resources_.Clear();
+}
+
+Vector3 TerrainStreamer::GetTileCenter(const IntVector2& tile) const
+{
+    return Vector3((tile.x_ + 0.5f) * tileSize_ * spacing_.x_, 0.0f, (tile.y_ + 0.5f) * tileSize_ * spacing_.z_);
+}
+
+float TerrainStreamer::GetTileDistance(const IntVector2& tile, const Vector3& localPosition) const
+{
+    float width = tileSize_ * spacing_.x_;
+    float depth = tileSize_ * spacing_.z_;
+    float minX = tile.x_ * width;
+    float minZ = tile.y_ * depth;
+    float dx = Max(Max(minX - localPosition.x_, localPosition.x_ - (minX + width)), 0.0f);
+    float dz = Max(Max(minZ - localPosition.z_, localPosition.z_ - (minZ + depth)), 0.0f);
+    return sqrtf(dx * dx + dz * dz);
+}
+
+}
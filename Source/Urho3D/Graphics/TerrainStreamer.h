@@ -0,0 +1,296 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/HashSet.h"
+#include "../Math/Vector2.h"
+#include "../Resource/Resource.h"
+#include "../Scene/Component.h"
+
+namespace Urho3D
+{
+
+class Material;
+class Terrain;
+
+/// Streaming state of a terrain tile.
+enum TerrainTileState
+{
+    /// Tile resources are being loaded in the background.
+    TILE_LOADING = 0,
+    /// Tile terrain patches are being built in worker threads.
+    TILE_BUILDING,
+    /// Tile is fully loaded.
+    TILE_LOADED,
+    /// Tile has no heightmap or it failed to load.
+    TILE_EMPTY
+};
+
+/// Terrain tile tracked by the streamer.
+struct StreamedTerrainTile
+{
+    /// Heightmap resource name.
+    String heightMapName_;
+    /// Material resource name, empty if using the streamer's material.
+    String materialName_;
+    /// Node of the tile terrain.
+    WeakPtr<Node> node_;
+    /// Resources that are still loading in the background.
+    HashSet<StringHash> resources_;
+    /// Streaming state.
+    TerrainTileState state_{TILE_LOADING};
+};
+
+/// %Terrain component that streams a large terrain split into a grid of heightmap tiles on the XZ plane. Tiles around the focus position have their heightmap and optional per-tile material loaded in the background, and become child Terrain components whose patches are built in worker threads. The number of resident tiles is capped, unloading the farthest tiles first.
+class URHO3D_API TerrainStreamer : public Component
+{
+    URHO3D_OBJECT(TerrainStreamer, Component);
+
+public:
+    /// Construct.
+    explicit TerrainStreamer(Context* context);
+    /// Destruct.
+    ~TerrainStreamer() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Handle enabled/disabled state change.
+    void OnSetEnabled() override;
+
+    /// Set heightmap resource name pattern. {x} and {z} are replaced with the tile coordinates, for example Textures/Terrain/Height_{x}_{z}.png. Heightmaps should be the tile size plus one pixel square, sharing the edge pixels with the neighbor tiles.
+    /// @property
+    void SetHeightMapTiles(const String& pattern);
+    /// Set material resource name pattern for per-tile materials, for example with tile specific weight and normal textures. If empty, all tiles use the streamer's material.
+    /// @property
+    void SetMaterialTiles(const String& pattern);
+    /// Set material used by tiles without a per-tile material.
+    /// @property
+    void SetMaterial(Material* material);
+    /// Set tile quads per side.
+    /// @property
+    void SetTileSize(int size);
+    /// Set vertex (XZ) and height (Y) spacing of the tiles.
+    /// @property
+    void SetSpacing(const Vector3& spacing);
+    /// Set patch quads per side of the tiles. Must be a power of two.
+    /// @property
+    void SetPatchSize(int size);
+    /// Set maximum number of LOD levels of the tiles.
+    /// @property
+    void SetMaxLodLevels(unsigned levels);
+    /// Set tile heightmap smoothing.
+    /// @property
+    void SetSmoothing(bool enable);
+    /// Set shadowcaster flag of the tiles.
+    /// @property
+    void SetCastShadows(bool enable);
+    /// Set draw distance of the tile patches.
+    /// @property
+    void SetDrawDistance(float distance);
+    /// Set LOD bias of the tile patches.
+    /// @property
+    void SetLodBias(float bias);
+    /// Set distance from the focus position within which tiles are loaded.
+    /// @property
+    void SetLoadDistance(float distance);
+    /// Set distance from the focus position beyond which tiles are unloaded. Should be larger than the load distance to avoid tiles being loaded and unloaded repeatedly.
+    /// @property
+    void SetUnloadDistance(float distance);
+    /// Set maximum number of resident tiles. When reached, the farthest tile is unloaded to make room for a nearer one.
+    /// @property
+    void SetMaxResidentTiles(unsigned num);
+    /// Set maximum number of tiles loading in the background at once.
+    /// @property
+    void SetMaxLoadingTiles(unsigned num);
+    /// Set node whose world position is used as the focus position. If null, the focus position set directly is used.
+    /// @property
+    void SetFocusNode(Node* node);
+    /// Set focus position used when there is no focus node.
+    /// @property
+    void SetFocusPosition(const Vector3& position);
+    /// Unload all tiles.
+    void UnloadAllTiles();
+
+    /// Return heightmap resource name pattern.
+    /// @property
+    const String& GetHeightMapTiles() const { return heightMapTiles_; }
+
+    /// Return material resource name pattern.
+    /// @property
+    const String& GetMaterialTiles() const { return materialTiles_; }
+
+    /// Return material.
+    /// @property
+    Material* GetMaterial() const;
+
+    /// Return tile quads per side.
+    /// @property
+    int GetTileSize() const { return tileSize_; }
+
+    /// Return vertex and height spacing.
+    /// @property
+    const Vector3& GetSpacing() const { return spacing_; }
+
+    /// Return patch quads per side.
+    /// @property
+    int GetPatchSize() const { return patchSize_; }
+
+    /// Return maximum number of LOD levels.
+    /// @property
+    unsigned GetMaxLodLevels() const { return maxLodLevels_; }
+
+    /// Return heightmap smoothing.
+    /// @property
+    bool GetSmoothing() const { return smoothing_; }
+
+    /// Return shadowcaster flag.
+    /// @property
+    bool GetCastShadows() const { return castShadows_; }
+
+    /// Return draw distance.
+    /// @property
+    float GetDrawDistance() const { return drawDistance_; }
+
+    /// Return LOD bias.
+    /// @property
+    float GetLodBias() const { return lodBias_; }
+
+    /// Return load distance.
+    /// @property
+    float GetLoadDistance() const { return loadDistance_; }
+
+    /// Return unload distance.
+    /// @property
+    float GetUnloadDistance() const { return unloadDistance_; }
+
+    /// Return maximum number of resident tiles.
+    /// @property
+    unsigned GetMaxResidentTiles() const { return maxResidentTiles_; }
+
+    /// Return maximum number of tiles loading at once.
+    /// @property
+    unsigned GetMaxLoadingTiles() const { return maxLoadingTiles_; }
+
+    /// Return focus node.
+    /// @property
+    Node* GetFocusNode() const { return focusNode_; }
+
+    /// Return focus position, either from the focus node or the one set directly.
+    /// @property
+    Vector3 GetFocusPosition() const;
+
+    /// Return number of tiles resident or loading.
+    /// @property
+    unsigned GetNumTiles() const { return tiles_.Size(); }
+
+    /// Return number of fully loaded tiles.
+    /// @property
+    unsigned GetNumLoadedTiles() const;
+
+    /// Return the streaming state of a tile, or TILE_EMPTY if the tile is not resident.
+    TerrainTileState GetTileState(const IntVector2& tile) const;
+    /// Return the terrain of a tile, or null if the tile is not resident.
+    Terrain* GetTileTerrain(const IntVector2& tile) const;
+    /// Return the tile that contains a world position.
+    IntVector2 GetTile(const Vector3& worldPosition) const;
+    /// Return terrain height at world position, or zero if the tile there is not resident.
+    float GetHeight(const Vector3& worldPosition) const;
+    /// Return the heightmap resource name of a tile.
+    String GetTileHeightMapName(const IntVector2& tile) const;
+    /// Return the material resource name of a tile, or empty if not using per-tile materials.
+    String GetTileMaterialName(const IntVector2& tile) const;
+
+    /// Set material attribute.
+    void SetMaterialAttr(const ResourceRef& value);
+    /// Return material attribute.
+    ResourceRef GetMaterialAttr() const;
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    /// Subscribe/unsubscribe to scene updates based on the current enabled state.
+    void UpdateEventSubscription();
+    /// Handle scene post-update event.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle a background loaded resource completing.
+    void HandleResourceBackgroundLoaded(StringHash eventType, VariantMap& eventData);
+    /// Begin loading a tile: queue its heightmap and material for background loading.
+    void BeginLoadTile(const IntVector2& tile);
+    /// Queue a tile resource for background loading.
+    void QueueTileResource(StreamedTerrainTile& tile, StringHash type, const String& name);
+    /// Create the terrain of a tile whose resources have loaded.
+    void BuildTile(const IntVector2& coords, StreamedTerrainTile& tile);
+    /// Unload a tile and remove its terrain from the scene.
+    void UnloadTile(StreamedTerrainTile& tile);
+    /// Return the center of a tile in local space.
+    Vector3 GetTileCenter(const IntVector2& tile) const;
+    /// Return distance from a local space position to a tile on the XZ plane.
+    float GetTileDistance(const IntVector2& tile, const Vector3& localPosition) const;
+
+    /// Resident tiles.
+    HashMap<IntVector2, StreamedTerrainTile> tiles_;
+    /// Resources of unloaded tiles that were still loading. Released from the resource cache once loaded.
+    HashSet<StringHash> cancelledResources_;
+    /// Material used by tiles without a per-tile material.
+    SharedPtr<Material> material_;
+    /// Focus node.
+    WeakPtr<Node> focusNode_;
+    /// Focus position used when there is no focus node.
+    Vector3 focusPosition_;
+    /// Heightmap resource name pattern.
+    String heightMapTiles_;
+    /// Material resource name pattern.
+    String materialTiles_;
+    /// Vertex and height spacing.
+    Vector3 spacing_;
+    /// Tile quads per side.
+    int tileSize_;
+    /// Patch quads per side.
+    int patchSize_;
+    /// Maximum number of LOD levels.
+    unsigned maxLodLevels_;
+    /// Heightmap smoothing.
+    bool smoothing_;
+    /// Shadowcaster flag.
+    bool castShadows_;
+    /// Draw distance.
+    float drawDistance_;
+    /// LOD bias.
+    float lodBias_;
+    /// Load distance.
+    float loadDistance_;
+    /// Unload distance.
+    float unloadDistance_;
+    /// Maximum number of resident tiles.
+    unsigned maxResidentTiles_;
+    /// Maximum number of tiles loading at once.
+    unsigned maxLoadingTiles_;
+    /// Subscribed to scene updates flag.
+    bool subscribed_;
+};
+
+}
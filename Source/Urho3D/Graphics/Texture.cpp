@@ -160,6 +160,22 @@ unsigned Texture::GetDataSize(int width, int height, int depth) const
     return depth * GetDataSize(width, height);
 }
 
+bool Texture::CreateAndProfile(unsigned layers)
+{
+    const bool success = Create();
+
+    unsigned long long memoryUse = 0;
+    if (success)
+    {
+        for (unsigned i = 0; i < levels_; ++i)
+            memoryUse += GetDataSize(GetLevelWidth(i), GetLevelHeight(i), GetLevelDepth(i));
+        memoryUse *= layers * multiSample_;
+    }
+
+    SetGPUMemoryUse(usage_ >= TEXTURE_RENDERTARGET ? GPU_MEMORY_RENDERTARGET : GPU_MEMORY_TEXTURE, memoryUse);
+    return success;
+}
+
 unsigned Texture::GetComponents() const
 {
     if (!width_ || IsCompressed())
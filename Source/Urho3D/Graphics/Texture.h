@@ -75,6 +75,8 @@ public:
     /// Set mip levels to skip on a quality setting when loading. Ensures higher quality levels do not skip more.
     /// @property
     void SetMipsToSkip(MaterialQuality quality, int toSkip);
+    /// Set whether compute shaders can write the texture. Needs to be called before setting size. Has no effect on multisampled or sRGB textures. Used only on Diligent.
+    void SetComputeAccess(bool enable) { computeAccess_ = enable; }
 
     /// Return API-specific texture format.
     /// @property
@@ -138,6 +140,13 @@ public:
     /// @property
     bool GetLevelsDirty() const { return levelsDirty_; }
 
+    /// Return whether compute shaders can write the texture.
+    bool GetComputeAccess() const { return computeAccess_; }
+
+    /// Return whether image data is queued for upload. The texture is sampled as a placeholder until the upload finishes. Only used on Diligent.
+    /// @nobind
+    bool IsUploadPending() const { return pendingUploads_ != 0; }
+
     /// Return backup texture.
     /// @property
     Texture* GetBackupTexture() const { return backupTexture_; }
@@ -201,6 +210,9 @@ public:
 
     /// Set the mipmap levels dirty flag. Called internally by Graphics.
     void SetLevelsDirty();
+    /// Adjust the number of queued data uploads. Called internally by Graphics.
+    /// @nobind
+    void AddPendingUploads(int delta) { pendingUploads_ += delta; }
     /// Regenerate mipmap levels for a rendertarget after rendering and before sampling. Called internally by Graphics. No-op on Direct3D9. On OpenGL the texture must have been bound to work properly.
     void RegenerateLevels();
 
@@ -226,6 +238,8 @@ protected:
     void CheckTextureBudget(StringHash type);
     /// Create the GPU texture. Implemented in subclasses.
     virtual bool Create() { return true; }
+    /// Create the GPU texture and record its memory for accounting. Layers is the number of array layers or cube faces.
+    bool CreateAndProfile(unsigned layers = 1);
 
     /// OpenGL target.
     unsigned target_{};
@@ -275,6 +289,10 @@ protected:
     bool resolveDirty_{};
     /// Mipmap levels regeneration needed -flag.
     bool levelsDirty_{};
+    /// Compute shader write access flag. Used only on Diligent.
+    bool computeAccess_{};
+    /// Number of queued data uploads. Only used on Diligent.
+    unsigned pendingUploads_{};
     /// Backup texture.
     SharedPtr<Texture> backupTexture_;
 };
@@ -39,6 +39,9 @@
 namespace Urho3D
 {
 
+/// Smallest size the largest dimension of a streamed texture is reduced to.
+static const int MIN_STREAMED_SIZE = 64;
+
 Texture2D::Texture2D(Context* context) :
     Texture(context)
 {
@@ -101,7 +104,10 @@ bool Texture2D::EndLoad()
     CheckTextureBudget(GetTypeStatic());
 
     SetParameters(loadParameters_);
+    PrepareStreaming();
     bool success = SetData(loadImage_);
+    if (success)
+        RegisterStreaming();
 
     loadImage_.Reset();
     loadParameters_.Reset();
@@ -157,7 +163,53 @@ bool Texture2D::SetSize(int width, int height, unsigned format, TextureUsage usa
     multiSample_ = multiSample;
     autoResolve_ = autoResolve;
 
-    return Create();
+    return CreateAndProfile();
+}
+
+void Texture2D::SetStreaming(bool enable)
+{
+    if (enable == streaming_)
+        return;
+
+    streaming_ = enable;
+    if (streaming_)
+        RegisterStreaming();
+    else if (streamedMipsSkipped_ && !IsStreamingPending())
+    {
+        // Bring back the full resolution
+        pendingMipsSkipped_ = 0;
+        GetSubsystem<ResourceCache>()->BackgroundReloadResource(this);
+    }
+}
+
+void Texture2D::RequestStreamedResolution(float texels, unsigned frameNumber)
+{
+    // Leave out the top mips as long as the remaining ones still have the requested resolution
+    unsigned mipsSkipped = 0;
+    while (mipsSkipped < maxStreamedMipsSkipped_ && (float)(streamingSourceSize_ >> (mipsSkipped + 1)) >= texels)
+        ++mipsSkipped;
+
+    if (frameNumber != streamingRequestFrame_)
+    {
+        streamingRequestFrame_ = frameNumber;
+        requestedMipsSkipped_ = mipsSkipped;
+    }
+    else
+        requestedMipsSkipped_ = Min(requestedMipsSkipped_, mipsSkipped);
+}
+
+bool Texture2D::StreamMips(unsigned mipsSkipped, int priority)
+{
+    mipsSkipped = Min(mipsSkipped, maxStreamedMipsSkipped_);
+    if (!streaming_ || mipsSkipped == streamedMipsSkipped_ || IsStreamingPending())
+        return false;
+
+    pendingMipsSkipped_ = mipsSkipped;
+    if (GetSubsystem<ResourceCache>()->BackgroundReloadResource(this, priority))
+        return true;
+
+    pendingMipsSkipped_ = streamedMipsSkipped_;
+    return false;
 }
 
 bool Texture2D::GetImage(Image& image) const
@@ -181,6 +233,52 @@ SharedPtr<Image> Texture2D::GetImage() const
     return rawImage;
 }
 
+void Texture2D::PrepareStreaming()
+{
+    if (!loadImage_)
+        return;
+
+    if (loadParameters_)
+    {
+        XMLElement streamingElem = loadParameters_->GetRoot().GetChild("streaming");
+        if (streamingElem)
+            streaming_ = streamingElem.GetBool("enable");
+    }
+
+    MaterialQuality quality = QUALITY_HIGH;
+    auto* renderer = GetSubsystem<Renderer>();
+    if (renderer)
+        quality = renderer->GetTextureQuality();
+
+    // Streaming leaves out mips on top of the texture quality, but keeps a low resolution version resident. Compressed
+    // images can not leave out more mips than they have
+    unsigned qualityMips = mipsToSkip_[quality];
+    int largest = Max(loadImage_->GetWidth(), loadImage_->GetHeight()) >> qualityMips;
+    int smallest = Min(loadImage_->GetWidth(), loadImage_->GetHeight()) >> qualityMips;
+    unsigned maxLevels = loadImage_->IsCompressed() ? loadImage_->GetNumCompressedLevels() : M_MAX_UNSIGNED;
+    maxStreamedMipsSkipped_ = 0;
+    while (qualityMips + maxStreamedMipsSkipped_ + 1 < maxLevels && (largest >> (maxStreamedMipsSkipped_ + 1)) >= MIN_STREAMED_SIZE &&
+        (smallest >> (maxStreamedMipsSkipped_ + 1)) >= 4)
+        ++maxStreamedMipsSkipped_;
+    streamingSourceSize_ = Max(largest, 1);
+
+    streamedMipsSkipped_ = streaming_ ? Min(pendingMipsSkipped_, maxStreamedMipsSkipped_) : 0;
+    pendingMipsSkipped_ = streamedMipsSkipped_;
+}
+
+void Texture2D::RegisterStreaming()
+{
+    if (!streaming_ || streamingRegistered_ || !streamingSourceSize_)
+        return;
+
+    auto* renderer = GetSubsystem<Renderer>();
+    if (renderer)
+    {
+        renderer->AddStreamedTexture(this);
+        streamingRegistered_ = true;
+    }
+}
+
 void Texture2D::HandleRenderSurfaceUpdate(StringHash eventType, VariantMap& eventData)
 {
     if (renderSurface_ && (renderSurface_->GetUpdateMode() == SURFACE_UPDATEALWAYS || renderSurface_->IsUpdateQueued()))
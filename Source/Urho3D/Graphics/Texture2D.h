@@ -66,6 +66,15 @@ public:
     bool SetData(unsigned level, int x, int y, int width, int height, const void* data);
     /// Set data from an image. Return true if successful. Optionally make a single channel image alpha-only.
     bool SetData(Image* image, bool useAlpha = false);
+    /// Set whether to stream the mip levels according to the on-screen size the texture is viewed at. A streamed texture starts with only its low mips resident and is reloaded in the background at a higher or lower resolution on demand. Can also be enabled from the texture parameter file.
+    /// @property
+    void SetStreaming(bool enable);
+    /// Request the resolution a streamed texture is needed at on a frame, in texels across its largest dimension. The largest request of the frame counts. Called by View.
+    /// @nobind
+    void RequestStreamedResolution(float texels, unsigned frameNumber);
+    /// Reload a streamed texture in the background with the given number of top mips skipped in addition to the texture quality. Return true if queued. Called by Renderer.
+    /// @nobind
+    bool StreamMips(unsigned mipsSkipped, int priority = 0);
 
     /// Get data from a mip level. The destination buffer must be big enough. Return true if successful.
     bool GetData(unsigned level, void* dest) const;
@@ -77,6 +86,24 @@ public:
     /// Return render surface.
     /// @property
     RenderSurface* GetRenderSurface() const { return renderSurface_; }
+    /// Return whether mip levels are streamed.
+    /// @property
+    bool GetStreaming() const { return streaming_; }
+    /// Return number of top mip levels currently left out by streaming.
+    /// @property
+    unsigned GetStreamedMipsSkipped() const { return streamedMipsSkipped_; }
+    /// Return the largest number of top mip levels streaming can leave out.
+    /// @property
+    unsigned GetMaxStreamedMipsSkipped() const { return maxStreamedMipsSkipped_; }
+    /// Return number of top mip levels the latest resolution request can do without.
+    /// @nobind
+    unsigned GetRequestedMipsSkipped() const { return requestedMipsSkipped_; }
+    /// Return frame number of the latest resolution request.
+    /// @nobind
+    unsigned GetStreamingRequestFrame() const { return streamingRequestFrame_; }
+    /// Return whether a background reload is pending.
+    /// @nobind
+    bool IsStreamingPending() const { return GetAsyncLoadState() != ASYNC_DONE; }
 
 protected:
     /// Create the GPU texture.
@@ -85,6 +112,10 @@ protected:
 private:
     /// Handle render surface update event.
     void HandleRenderSurfaceUpdate(StringHash eventType, VariantMap& eventData);
+    /// Apply streaming parameters and the streamed mips to skip before uploading the loaded image.
+    void PrepareStreaming();
+    /// Register to the renderer for streaming if not yet registered.
+    void RegisterStreaming();
 
     /// Render surface.
     SharedPtr<RenderSurface> renderSurface_;
@@ -92,6 +123,22 @@ private:
     SharedPtr<Image> loadImage_;
     /// Parameter file acquired during BeginLoad.
     SharedPtr<XMLFile> loadParameters_;
+    /// Mip streaming flag.
+    bool streaming_{};
+    /// Registered to the renderer for streaming flag.
+    bool streamingRegistered_{};
+    /// Top mip levels left out by streaming when the image was last uploaded.
+    unsigned streamedMipsSkipped_{};
+    /// Top mip levels to leave out on the next load. Initially as many as possible, so that streaming starts from the low mips.
+    unsigned pendingMipsSkipped_{M_MAX_UNSIGNED};
+    /// Largest number of top mip levels streaming can leave out.
+    unsigned maxStreamedMipsSkipped_{};
+    /// Top mip levels the latest resolution request can do without.
+    unsigned requestedMipsSkipped_{};
+    /// Frame number of the latest resolution request.
+    unsigned streamingRequestFrame_{};
+    /// Largest dimension of the loaded image after skipping the texture quality mips.
+    int streamingSourceSize_{};
 };
 
 }
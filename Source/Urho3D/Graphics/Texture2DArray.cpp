@@ -192,7 +192,7 @@ bool Texture2DArray::SetSize(unsigned layers, int width, int height, unsigned fo
     for (unsigned i = 0; i < layers_; ++i)
         layerMemoryUse_[i] = 0;
 
-    return Create();
+    return CreateAndProfile(layers_);
 }
 
 void Texture2DArray::HandleRenderSurfaceUpdate(StringHash eventType, VariantMap& eventData)
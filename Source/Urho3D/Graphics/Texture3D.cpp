@@ -176,7 +176,7 @@ bool Texture3D::SetSize(int width, int height, int depth, unsigned format, Textu
     depth_ = depth;
     format_ = format;
 
-    return Create();
+    return CreateAndProfile();
 }
 
 }
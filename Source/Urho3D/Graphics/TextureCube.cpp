@@ -310,7 +310,7 @@ bool TextureCube::SetSize(int size, unsigned format, TextureUsage usage, int mul
     multiSample_ = multiSample;
     autoResolve_ = multiSample > 1;
 
-    return Create();
+    return CreateAndProfile(MAX_CUBEMAP_FACES);
 }
 
 SharedPtr<Image> TextureCube::GetImage(CubeMapFace face) const
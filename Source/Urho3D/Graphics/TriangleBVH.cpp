@@ -0,0 +1,294 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Container/Sort.h"
+#include "../Graphics/TriangleBVH.h"
+#include "../Math/Ray.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Maximum number of triangles in a leaf node.
+static const unsigned MAX_LEAF_TRIANGLES = 4;
+/// Maximum traversal stack depth. The median split keeps the tree balanced, so this suffices for any index count.
+static const unsigned MAX_TRAVERSAL_DEPTH = 64;
+
+/// Triangle being sorted into the hierarchy.
+struct BVHBuildTriangle
+{
+    /// Bounding box minimum.
+    Vector3 min_;
+    /// Bounding box maximum.
+    Vector3 max_;
+    /// Bounding box center.
+    Vector3 center_;
+    /// Vertex indices.
+    unsigned indices_[3];
+};
+
+/// Comparison of triangle centers along an axis.
+struct CompareBVHBuildTriangles
+{
+    explicit CompareBVHBuildTriangles(unsigned axis) :
+        axis_(axis)
+    {
+    }
+
+    bool operator ()(const BVHBuildTriangle& lhs, const BVHBuildTriangle& rhs) const
+    {
+        return lhs.center_.Data()[axis_] < rhs.center_.Data()[axis_];
+    }
+
+    unsigned axis_;
+};
+
+static void BuildNode(PODVector<TriangleBVHNode>& nodes, PODVector<BVHBuildTriangle>& triangles, unsigned start, unsigned end)
+{
+    unsigned nodeIndex = nodes.Size();
+    nodes.Resize(nodeIndex + 1);
+
+    Vector3 min = triangles[start].min_;
+    Vector3 max = triangles[start].max_;
+    Vector3 centerMin = triangles[start].center_;
+    Vector3 centerMax = triangles[start].center_;
+    for (unsigned i = start + 1; i < end; ++i)
+    {
+        const BVHBuildTriangle& triangle = triangles[i];
+        min = VectorMin(min, triangle.min_);
+        max = VectorMax(max, triangle.max_);
+        centerMin = VectorMin(centerMin, triangle.center_);
+        centerMax = VectorMax(centerMax, triangle.center_);
+    }
+
+    nodes[nodeIndex].min_ = min;
+    nodes[nodeIndex].max_ = max;
+
+    if (end - start <= MAX_LEAF_TRIANGLES)
+    {
+        nodes[nodeIndex].offset_ = start;
+        nodes[nodeIndex].count_ = end - start;
+        return;
+    }
+
+    // Split at the median along the axis with the largest spread of triangle centers
+    Vector3 extent = centerMax - centerMin;
+    unsigned axis = 0;
+    if (extent.y_ > extent.x_)
+        axis = 1;
+    if (extent.z_ > extent.Data()[axis])
+        axis = 2;
+
+    Sort(triangles.Begin() + start, triangles.Begin() + end, CompareBVHBuildTriangles(axis));
+    unsigned middle = (start + end) / 2;
+
+    BuildNode(nodes, triangles, start, middle);
+    // The second child follows the whole subtree of the first
+    nodes[nodeIndex].offset_ = nodes.Size();
+    nodes[nodeIndex].count_ = 0;
+    BuildNode(nodes, triangles, middle, end);
+}
+
+static inline float HitDistanceNode(const TriangleBVHNode& node, const Vector3& origin, const Vector3& invDirection)
+{
+    float x1 = (node.min_.x_ - origin.x_) * invDirection.x_;
+    float x2 = (node.max_.x_ - origin.x_) * invDirection.x_;
+    float y1 = (node.min_.y_ - origin.y_) * invDirection.y_;
+    float y2 = (node.max_.y_ - origin.y_) * invDirection.y_;
+    float z1 = (node.min_.z_ - origin.z_) * invDirection.z_;
+    float z2 = (node.max_.z_ - origin.z_) * invDirection.z_;
+
+    float nearHit = Max(Max(Min(x1, x2), Min(y1, y2)), Max(Min(z1, z2), 0.0f));
+    float farHit = Min(Min(Max(x1, x2), Max(y1, y2)), Max(z1, z2));
+
+    return nearHit <= farHit ? nearHit : M_INFINITY;
+}
+
+static inline float InverseDirection(float direction)
+{
+    if (Abs(direction) > M_EPSILON)
+        return 1.0f / direction;
+    else
+        return direction >= 0.0f ? M_LARGE_VALUE : -M_LARGE_VALUE;
+}
+
+bool TriangleBVH::Build(const unsigned char* vertexData, unsigned vertexSize, const unsigned char* indexData, unsigned indexSize,
+    unsigned indexStart, unsigned indexCount)
+{
+    Clear();
+
+    unsigned numTriangles = indexCount / 3;
+    if (!vertexData || !indexData || !numTriangles)
+        return false;
+
+    PODVector<BVHBuildTriangle> triangles(numTriangles);
+    const unsigned short* indices16 = ((const unsigned short*)indexData) + indexStart;
+    const unsigned* indices32 = ((const unsigned*)indexData) + indexStart;
+
+    for (unsigned i = 0; i < numTriangles; ++i)
+    {
+        BVHBuildTriangle& triangle = triangles[i];
+        for (unsigned j = 0; j < 3; ++j)
+            triangle.indices_[j] = indexSize == sizeof(unsigned short) ? indices16[i * 3 + j] : indices32[i * 3 + j];
+
+        const Vector3& v0 = *((const Vector3*)(&vertexData[triangle.indices_[0] * vertexSize]));
+        const Vector3& v1 = *((const Vector3*)(&vertexData[triangle.indices_[1] * vertexSize]));
+        const Vector3& v2 = *((const Vector3*)(&vertexData[triangle.indices_[2] * vertexSize]));
+        triangle.min_ = VectorMin(VectorMin(v0, v1), v2);
+        triangle.max_ = VectorMax(VectorMax(v0, v1), v2);
+        triangle.center_ = (triangle.min_ + triangle.max_) * 0.5f;
+    }
+
+    nodes_.Reserve(2 * numTriangles / MAX_LEAF_TRIANGLES + 1);
+    BuildNode(nodes_, triangles, 0, numTriangles);
+
+    indices_.Resize(numTriangles * 3);
+    for (unsigned i = 0; i < numTriangles; ++i)
+    {
+        for (unsigned j = 0; j < 3; ++j)
+            indices_[i * 3 + j] = triangles[i].indices_[j];
+    }
+
+    return true;
+}
+
+void TriangleBVH::Clear()
+{
+    nodes_.Clear();
+    indices_.Clear();
+}
+
+float TriangleBVH::HitDistance(const Ray& ray, const unsigned char* vertexData, unsigned vertexSize, Vector3* outNormal,
+    Vector2* outUV, unsigned uvOffset) const
+{
+    if (outUV && uvOffset == M_MAX_UNSIGNED)
+    {
+        *outUV = Vector2::ZERO;
+        outUV = nullptr;
+    }
+
+    if (nodes_.Empty() || !vertexData)
+        return M_INFINITY;
+
+    const Vector3 invDirection(InverseDirection(ray.direction_.x_), InverseDirection(ray.direction_.y_),
+        InverseDirection(ray.direction_.z_));
+
+    float nearest = M_INFINITY;
+    const unsigned* nearestIndices = nullptr;
+
+    Vector3 tempNormal;
+    Vector3* tempNormalPtr = outNormal ? &tempNormal : nullptr;
+    Vector3 barycentric;
+    Vector3 tempBarycentric;
+    Vector3* tempBarycentricPtr = outUV ? &tempBarycentric : nullptr;
+
+    unsigned stack[MAX_TRAVERSAL_DEPTH];
+    float stackDistances[MAX_TRAVERSAL_DEPTH];
+    unsigned stackSize = 0;
+
+    if (HitDistanceNode(nodes_[0], ray.origin_, invDirection) < M_INFINITY)
+    {
+        stack[0] = 0;
+        stackDistances[0] = 0.0f;
+        stackSize = 1;
+    }
+
+    while (stackSize)
+    {
+        --stackSize;
+        if (stackDistances[stackSize] >= nearest)
+            continue;
+
+        const TriangleBVHNode& node = nodes_[stack[stackSize]];
+
+        if (node.count_)
+        {
+            const unsigned* indices = &indices_[node.offset_ * 3];
+            const unsigned* indicesEnd = indices + node.count_ * 3;
+            while (indices < indicesEnd)
+            {
+                const Vector3& v0 = *((const Vector3*)(&vertexData[indices[0] * vertexSize]));
+                const Vector3& v1 = *((const Vector3*)(&vertexData[indices[1] * vertexSize]));
+                const Vector3& v2 = *((const Vector3*)(&vertexData[indices[2] * vertexSize]));
+                float distance = ray.HitDistance(v0, v1, v2, tempNormalPtr, tempBarycentricPtr);
+                if (distance < nearest)
+                {
+                    nearest = distance;
+                    nearestIndices = indices;
+
+                    if (outNormal)
+                        *outNormal = tempNormal;
+                    if (outUV)
+                        barycentric = tempBarycentric;
+                }
+                indices += 3;
+            }
+        }
+        else
+        {
+            // Visit the nearer child first by pushing it last
+            unsigned first = stack[stackSize] + 1;
+            unsigned second = node.offset_;
+            float firstDistance = HitDistanceNode(nodes_[first], ray.origin_, invDirection);
+            float secondDistance = HitDistanceNode(nodes_[second], ray.origin_, invDirection);
+            if (secondDistance < firstDistance)
+            {
+                Swap(first, second);
+                Swap(firstDistance, secondDistance);
+            }
+
+            if (secondDistance < nearest)
+            {
+                stack[stackSize] = second;
+                stackDistances[stackSize++] = secondDistance;
+            }
+            if (firstDistance < nearest)
+            {
+                stack[stackSize] = first;
+                stackDistances[stackSize++] = firstDistance;
+            }
+        }
+    }
+
+    if (outUV)
+    {
+        if (!nearestIndices)
+            *outUV = Vector2::ZERO;
+        else
+        {
+            // Interpolate the UV coordinate using barycentric coordinate
+            const Vector2& uv0 = *((const Vector2*)(&vertexData[uvOffset + nearestIndices[0] * vertexSize]));
+            const Vector2& uv1 = *((const Vector2*)(&vertexData[uvOffset + nearestIndices[1] * vertexSize]));
+            const Vector2& uv2 = *((const Vector2*)(&vertexData[uvOffset + nearestIndices[2] * vertexSize]));
+            *outUV = Vector2(uv0.x_ * barycentric.x_ + uv1.x_ * barycentric.y_ + uv2.x_ * barycentric.z_,
+                uv0.y_ * barycentric.x_ + uv1.y_ * barycentric.y_ + uv2.y_ * barycentric.z_);
+        }
+    }
+
+    return nearest;
+}
+
+}
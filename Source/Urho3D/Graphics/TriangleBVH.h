@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/Ptr.h"
+#include "../Container/Vector.h"
+#include "../Math/Vector3.h"
+
+namespace Urho3D
+{
+
+class Ray;
+
+/// Node of a triangle bounding volume hierarchy.
+struct TriangleBVHNode
+{
+    /// Bounding box minimum.
+    Vector3 min_;
+    /// Index of the second child for an inner node, or first triangle for a leaf.
+    unsigned offset_;
+    /// Bounding box maximum.
+    Vector3 max_;
+    /// Number of triangles for a leaf, zero for an inner node whose first child immediately follows it.
+    unsigned count_;
+};
+
+/// Bounding volume hierarchy over the triangles of an indexed triangle list, used to accelerate ray queries. Stores only nodes and reordered vertex indices; the vertex data is supplied at query time.
+class URHO3D_API TriangleBVH : public RefCounted
+{
+public:
+    /// Construct empty.
+    TriangleBVH() = default;
+
+    /// Build from vertex positions at offset zero and an index range. Return true if any triangles.
+    bool Build(const unsigned char* vertexData, unsigned vertexSize, const unsigned char* indexData, unsigned indexSize,
+        unsigned indexStart, unsigned indexCount);
+    /// Clear the hierarchy.
+    void Clear();
+
+    /// Return ray hit distance to the nearest front-facing triangle or infinity if no hit. The vertex data must be the same layout the hierarchy was built from. Optionally return hit normal and uv coordinates.
+    float HitDistance(const Ray& ray, const unsigned char* vertexData, unsigned vertexSize, Vector3* outNormal = nullptr,
+        Vector2* outUV = nullptr, unsigned uvOffset = M_MAX_UNSIGNED) const;
+
+    /// Return nodes.
+    const PODVector<TriangleBVHNode>& GetNodes() const { return nodes_; }
+    /// Return number of triangles.
+    unsigned GetNumTriangles() const { return indices_.Size() / 3; }
+    /// Return whether is empty.
+    bool IsEmpty() const { return nodes_.Empty(); }
+
+private:
+    /// Nodes in depth-first order.
+    PODVector<TriangleBVHNode> nodes_;
+    /// Vertex indices of the triangles in leaf order.
+    PODVector<unsigned> indices_;
+};
+
+}
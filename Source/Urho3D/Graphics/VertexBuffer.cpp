@@ -66,6 +66,18 @@ void VertexBuffer::SetShadowed(bool enable)
     }
 }
 
+void VertexBuffer::SetComputeAccess(bool enable)
+{
+    if (enable == computeAccess_)
+        return;
+
+    computeAccess_ = enable;
+
+    // Recreate with the new bind flags
+    if (object_.ptr_ && Create() && shadowData_)
+        SetData(shadowData_.Get());
+}
+
 bool VertexBuffer::SetSize(unsigned vertexCount, unsigned elementMask, bool dynamic)
 {
     return SetSize(vertexCount, GetElements(elementMask), dynamic);
@@ -78,6 +90,7 @@ bool VertexBuffer::SetSize(unsigned vertexCount, const PODVector<VertexElement>&
     vertexCount_ = vertexCount;
     elements_ = elements;
     dynamic_ = dynamic;
+    ++dataRevision_;
 
     UpdateOffsets();
 
@@ -86,7 +99,9 @@ bool VertexBuffer::SetSize(unsigned vertexCount, const PODVector<VertexElement>&
     else
         shadowData_.Reset();
 
-    return Create();
+    const bool success = Create();
+    SetGPUMemoryUse(GPU_MEMORY_VERTEXBUFFER, success ? (unsigned long long)vertexCount_ * vertexSize_ : 0);
+    return success;
 }
 
 void VertexBuffer::UpdateOffsets()
@@ -22,6 +22,7 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/SmallVector.h"
 #include "../Core/Profiler.h"
 #include "../Core/WorkQueue.h"
 #include "../Graphics/Camera.h"
@@ -55,6 +56,21 @@
 namespace Urho3D
 {
 
+/// Minimum number of visible geometries per work item to collect base batches in worker threads.
+static const unsigned MIN_THREADED_BATCH_GEOMETRIES = 64;
+/// Minimum number of drawables per work item for the visibility checks.
+static const unsigned MIN_DRAWABLES_PER_ITEM = 32;
+/// Smallest near clip distance of the clustered light grid relative to the far clip distance, to keep the slices usable when the near clip is zero.
+static const float CLUSTER_MIN_NEAR_RATIO = 0.001f;
+/// Part of a clustered spot light's cone over which the light fades out at the edge.
+static const float CLUSTER_SPOT_FADE = 0.2f;
+/// Minimum number of visible zones to look up drawable zones through a grid instead of testing every zone.
+static const unsigned ZONE_GRID_MIN_ZONES = 16;
+/// Target number of zone lookup grid cells per visible zone.
+static const unsigned ZONE_GRID_CELLS_PER_ZONE = 4;
+/// Maximum number of zone lookup grid cells along each axis.
+static const int ZONE_GRID_MAX_SIZE = 32;
+
 /// %Frustum octree query for shadowcasters.
 class ShadowCasterOctreeQuery : public FrustumOctreeQuery
 {
@@ -163,6 +179,7 @@ void CheckVisibilityWork(const WorkItem* item, unsigned threadIndex)
     auto** start = reinterpret_cast<Drawable**>(item->start_);
     auto** end = reinterpret_cast<Drawable**>(item->end_);
     OcclusionBuffer* buffer = view->occlusionBuffer_;
+    OcclusionBuffer* gpuBuffer = view->gpuOcclusionBuffer_;
     const Matrix3x4& viewMatrix = view->cullCamera_->GetView();
     Vector3 viewZ = Vector3(viewMatrix.m20_, viewMatrix.m21_, viewMatrix.m22_);
     Vector3 absViewZ = viewZ.Abs();
@@ -174,7 +191,8 @@ void CheckVisibilityWork(const WorkItem* item, unsigned threadIndex)
     {
         Drawable* drawable = *start++;
 
-        if (!buffer || !drawable->IsOccludee() || buffer->IsVisible(drawable->GetWorldBoundingBox()))
+        if (!drawable->IsOccludee() || ((!buffer || buffer->IsVisible(drawable->GetWorldBoundingBox())) &&
+            (!gpuBuffer || gpuBuffer->IsVisible(drawable->GetWorldBoundingBox()))))
         {
             drawable->UpdateBatches(view->frame_);
             // If draw distance non-zero, update and check it
@@ -234,6 +252,213 @@ void ProcessLightWork(const WorkItem* item, unsigned threadIndex)
     view->ProcessLight(*query, threadIndex);
 }
 
+void GetLightBatchesWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* view = reinterpret_cast<View*>(item->aux_);
+    auto* result = reinterpret_cast<PerThreadBatchResult*>(item->start_);
+
+    view->CollectLightBatches(*result->lightQuery_, *result->lightQueue_,
+        result->batchQueues_.Size() ? &result->batchQueues_[0] : nullptr, result);
+}
+
+void GetBaseBatchesWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* view = reinterpret_cast<View*>(item->aux_);
+    auto* result = reinterpret_cast<PerThreadBatchResult*>(item->start_);
+
+    view->CollectBaseBatches(result->start_, result->end_, result);
+}
+
+void BuildLightClusterSliceWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* view = reinterpret_cast<View*>(item->aux_);
+    auto* slice = reinterpret_cast<LightClusterSlice*>(item->start_);
+
+    view->BuildLightClusterSlice(*slice);
+}
+
+/// Return the depth slice scale and bias of the clustered light grid, so that slice = log(depth) * scale + bias.
+static Vector2 GetClusterSliceParams(Camera* camera)
+{
+    float farClip = camera->GetFarClip();
+    float nearClip = Max(camera->GetNearClip(), farClip * CLUSTER_MIN_NEAR_RATIO);
+    float scale = (float)CLUSTER_GRID_Z / Ln(farClip / nearClip);
+    return Vector2(scale, -Ln(nearClip) * scale);
+}
+
+/// Return the clustered light grid depth slice of a view space depth.
+static int GetClusterSlice(float depth, const Vector2& sliceParams)
+{
+    if (depth <= 0.0f)
+        return 0;
+    return Clamp((int)(Ln(depth) * sliceParams.x_ + sliceParams.y_), 0, (int)CLUSTER_GRID_Z - 1);
+}
+
+/// Combine the bit patterns of floats to a hash.
+static void CombineFloatHash(unsigned& hash, const float* data, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        unsigned bits;
+        memcpy(&bits, &data[i], sizeof bits);
+        CombineHash(hash, bits);
+    }
+}
+
+/// Return whether a shadow caster's depth can be cached: it does not update its geometry and all its batches are static geometry.
+static bool IsStaticShadowCaster(Drawable* drawable)
+{
+    if (drawable->GetUpdateGeometryType() != UPDATE_NONE)
+        return false;
+
+    const Vector<SourceBatch>& batches = drawable->GetBatches();
+    for (unsigned i = 0; i < batches.Size(); ++i)
+    {
+        if (batches[i].geometryType_ != GEOM_STATIC)
+            return false;
+    }
+
+    return true;
+}
+
+/// Return a nonzero hash of a shadow split's camera, viewport, depth bias and static shadow casters.
+static unsigned GetStaticShadowHash(Light* light, const ShadowBatchQueue& shadowQueue, PODVector<Drawable*>::ConstIterator begin,
+    PODVector<Drawable*>::ConstIterator end)
+{
+    unsigned hash = 0;
+    Camera* shadowCamera = shadowQueue.shadowCamera_;
+    Matrix4 projection = shadowCamera->GetProjection();
+    CombineFloatHash(hash, shadowCamera->GetView().Data(), 12);
+    CombineFloatHash(hash, projection.Data(), 16);
+
+    const IntRect& viewport = shadowQueue.shadowViewport_;
+    CombineHash(hash, (unsigned)viewport.left_);
+    CombineHash(hash, (unsigned)viewport.top_);
+    CombineHash(hash, (unsigned)viewport.right_);
+    CombineHash(hash, (unsigned)viewport.bottom_);
+
+    const BiasParameters& bias = light->GetShadowBias();
+    CombineFloatHash(hash, &bias.constantBias_, 1);
+    CombineFloatHash(hash, &bias.slopeScaledBias_, 1);
+
+    for (PODVector<Drawable*>::ConstIterator i = begin; i != end; ++i)
+    {
+        Drawable* drawable = *i;
+        if (!IsStaticShadowCaster(drawable))
+            continue;
+
+        const BoundingBox& box = drawable->GetWorldBoundingBox();
+        CombineHash(hash, MakeHash(drawable));
+        CombineFloatHash(hash, box.min_.Data(), 3);
+        CombineFloatHash(hash, box.max_.Data(), 3);
+
+        const Vector<SourceBatch>& batches = drawable->GetBatches();
+        for (unsigned j = 0; j < batches.Size(); ++j)
+        {
+            const SourceBatch& srcBatch = batches[j];
+            CombineHash(hash, MakeHash(srcBatch.GetShadowGeometry()));
+            CombineHash(hash, MakeHash(srcBatch.material_.Get()));
+            CombineHash(hash, srcBatch.numWorldTransforms_);
+            if (srcBatch.worldTransform_)
+                CombineFloatHash(hash, srcBatch.worldTransform_->Data(), 12 * srcBatch.numWorldTransforms_);
+        }
+    }
+
+    return hash ? hash : 1;
+}
+
+/// Set the depth bias of a shadow split.
+static void SetShadowSplitDepthBias(Graphics* graphics, Renderer* renderer, const LightBatchQueue& queue, unsigned split,
+    const BiasParameters& parameters)
+{
+    const ShadowBatchQueue& shadowQueue = queue.shadowSplits_[split];
+
+    float multiplier = 1.0f;
+    // For directional light cascade splits, adjust depth bias according to the far clip ratio of the splits
+    if (split > 0 && queue.light_->GetLightType() == LIGHT_DIRECTIONAL)
+    {
+        multiplier =
+            Max(shadowQueue.shadowCamera_->GetFarClip() / queue.shadowSplits_[0].shadowCamera_->GetFarClip(), 1.0f);
+        multiplier = 1.0f + (multiplier - 1.0f) * queue.light_->GetShadowCascade().biasAutoAdjust_;
+        // Quantize multiplier to prevent creation of too many rasterizer states on D3D11
+        multiplier = (int)(multiplier * 10.0f) / 10.0f;
+    }
+
+    // Perform further modification of depth bias on OpenGL ES, as shadow calculations' precision is limited
+    float addition = 0.0f;
+#ifdef GL_ES_VERSION_2_0
+    multiplier *= renderer->GetMobileShadowBiasMul();
+    addition = renderer->GetMobileShadowBiasAdd();
+#endif
+
+    graphics->SetDepthBias(multiplier * parameters.constantBias_ + addition, multiplier * parameters.slopeScaledBias_);
+}
+
+/// Render path rendertarget that owns a screen buffer which later rendertargets may alias.
+struct ScreenBufferAlias
+{
+    /// Rendertarget info of the first user.
+    const RenderTargetInfo* info_;
+    /// Allocated width.
+    int width_;
+    /// Allocated height.
+    int height_;
+    /// Allocated screen buffer.
+    Texture* texture_;
+    /// Index of the last command using the screen buffer.
+    int lastUse_;
+};
+
+/// Extend the command index range of the rendertargets matching a name to include a command.
+static void ExtendRenderTargetLifetime(const Vector<RenderTargetInfo>& renderTargets, const String& name, int commandIndex,
+    PODVector<IntVector2>& lifetimes)
+{
+    if (name.Empty())
+        return;
+
+    StringHash nameHash(name);
+    for (unsigned i = 0; i < renderTargets.Size(); ++i)
+    {
+        if (StringHash(renderTargets[i].name_) != nameHash)
+            continue;
+
+        IntVector2& lifetime = lifetimes[i];
+        if (lifetime.x_ < 0)
+            lifetime.x_ = commandIndex;
+        lifetime.y_ = commandIndex;
+    }
+}
+
+/// Return estimated GPU memory use of a screen buffer in bytes.
+static unsigned GetScreenBufferMemory(Texture* texture)
+{
+    unsigned memory = texture->GetRowDataSize(texture->GetWidth()) * texture->GetHeight() * Max(texture->GetMultiSample(), 1);
+    if (texture->GetType() == TextureCube::GetTypeStatic())
+        memory *= MAX_CUBEMAP_FACES;
+    return memory;
+}
+
+/// Prepare a worker thread batch queue to receive batches destined to a view batch queue.
+static void InitThreadBatchQueue(BatchQueue& queue, const BatchQueue& destQueue)
+{
+    queue.Clear((int)destQueue.maxSortedInstances_);
+    queue.hasExtraDefines_ = destQueue.hasExtraDefines_;
+    queue.vsExtraDefines_ = destQueue.vsExtraDefines_;
+    queue.psExtraDefines_ = destQueue.psExtraDefines_;
+    queue.vsExtraDefinesHash_ = destQueue.vsExtraDefinesHash_;
+    queue.psExtraDefinesHash_ = destQueue.psExtraDefinesHash_;
+}
+
+/// Reset a batch collection result for a new work item.
+static void ResetBatchResult(PerThreadBatchResult& result)
+{
+    result.nonThreadedGeometries_.Clear();
+    result.threadedGeometries_.Clear();
+    result.auxViewMaterials_.Clear();
+    result.streamedMaterials_.Clear();
+    result.shadersMissing_ = false;
+}
+
 void UpdateDrawableGeometriesWork(const WorkItem* item, unsigned threadIndex)
 {
     const FrameInfo& frame = *(reinterpret_cast<FrameInfo*>(item->aux_));
@@ -274,7 +499,10 @@ void SortShadowQueueWork(const WorkItem* item, unsigned threadIndex)
 {
     auto* start = reinterpret_cast<LightBatchQueue*>(item->start_);
     for (unsigned i = 0; i < start->shadowSplits_.Size(); ++i)
+    {
         start->shadowSplits_[i].shadowBatches_.SortFrontToBack();
+        start->shadowSplits_[i].staticShadowBatches_.SortFrontToBack();
+    }
 }
 
 StringHash ParseTextureTypeXml(ResourceCache* cache, const String& filename);
@@ -327,6 +555,15 @@ bool View::Define(RenderSurface* renderTarget, Viewport* viewport)
     }
 #endif
 
+    // Render views to the backbuffer at the renderer's resolution scale. They are upscaled to the viewport at the end
+    float resolutionScale = renderTarget_ ? 1.0f : renderer_->GetResolutionScale();
+    upscale_ = resolutionScale < 1.0f;
+    if (upscale_)
+    {
+        viewSize_.x_ = Max(RoundToInt(viewSize_.x_ * resolutionScale), 1);
+        viewSize_.y_ = Max(RoundToInt(viewSize_.y_ * resolutionScale), 1);
+    }
+
     scene_ = viewport->GetScene();
     cullCamera_ = viewport->GetCullCamera();
     camera_ = viewport->GetCamera();
@@ -342,6 +579,7 @@ bool View::Define(RenderSurface* renderTarget, Viewport* viewport)
             deferred_ = sourceView_->deferred_;
             deferredAmbient_ = sourceView_->deferredAmbient_;
             useLitBase_ = sourceView_->useLitBase_;
+            clusteredLighting_ = sourceView_->clusteredLighting_;
             hasScenePasses_ = sourceView_->hasScenePasses_;
             noStencil_ = sourceView_->noStencil_;
             lightVolumeCommand_ = sourceView_->lightVolumeCommand_;
@@ -369,6 +607,7 @@ bool View::Define(RenderSurface* renderTarget, Viewport* viewport)
     useLitBase_ = false;
     hasScenePasses_ = false;
     noStencil_ = false;
+    clusteredLighting_ = false;
     lightVolumeCommand_ = nullptr;
     forwardLightsCommand_ = nullptr;
 
@@ -404,10 +643,14 @@ bool View::Define(RenderSurface* renderTarget, Viewport* viewport)
         if (!command.enabled_)
             continue;
 
-        if (command.type_ == CMD_SCENEPASS)
+        if (command.type_ == CMD_SCENEPASS || command.type_ == CMD_FORWARDCLUSTERED)
         {
             hasScenePasses_ = true;
 
+            // Clustered passes need shader readable light lists, otherwise they render as plain scene passes
+            if (command.type_ == CMD_FORWARDCLUSTERED && graphics_->GetClusteredLightingSupport())
+                clusteredLighting_ = true;
+
             ScenePassInfo info{};
             info.passIndex_ = command.passIndex_ = Technique::GetPassIndex(command.pass_);
             info.allowInstancing_ = command.sortMode_ != SORT_BACKTOFRONT;
@@ -442,6 +685,9 @@ bool View::Define(RenderSurface* renderTarget, Viewport* viewport)
         // Allow a custom forward light pass
         else if (command.type_ == CMD_FORWARDLIGHTS && !command.pass_.Empty())
             lightPassIndex_ = command.passIndex_ = Technique::GetPassIndex(command.pass_);
+        // The deferred cluster pass shades the unshadowed point and spot lights from the light lists instead of light volumes
+        else if (command.type_ == CMD_DEFERREDCLUSTERED && graphics_->GetClusteredLightingSupport())
+            clusteredLighting_ = true;
     }
 
     octree_ = nullptr;
@@ -475,12 +721,12 @@ bool View::Define(RenderSurface* renderTarget, Viewport* viewport)
             continue;
 
         // Check if ambient pass and G-buffer rendering happens at the same time
-        if (command.type_ == CMD_SCENEPASS && command.outputs_.Size() > 1)
+        if ((command.type_ == CMD_SCENEPASS || command.type_ == CMD_FORWARDCLUSTERED) && command.outputs_.Size() > 1)
         {
             if (CheckViewportWrite(command))
                 deferredAmbient_ = true;
         }
-        else if (command.type_ == CMD_LIGHTVOLUMES)
+        else if (command.type_ == CMD_LIGHTVOLUMES || command.type_ == CMD_DEFERREDCLUSTERED)
         {
             lightVolumeCommand_ = &command;
             deferred_ = true;
@@ -492,10 +738,15 @@ bool View::Define(RenderSurface* renderTarget, Viewport* viewport)
         }
     }
 
+    // The lit base pass would replace the clustered base pass, so it can not be used with clustered lighting
+    if (clusteredLighting_)
+        useLitBase_ = false;
+
     drawShadows_ = renderer_->GetDrawShadows();
     materialQuality_ = renderer_->GetMaterialQuality();
     maxOccluderTriangles_ = renderer_->GetMaxOccluderTriangles();
     minInstances_ = renderer_->GetMinInstances();
+    bindlessInstancing_ = renderer_->GetBindlessInstancing();
 
     // Set possible quality overrides from the camera
     // Note that the culling camera is used here (its settings are authoritative) while the render camera
@@ -622,6 +873,9 @@ void View::Render()
     graphics_->SetScissorTest(false);
     graphics_->SetStencilTest(false);
 
+    if (renderer_->GetGPUOcclusion() && hasScenePasses_ && cullCamera_)
+        RequestGPUOcclusionDepth();
+
     // Draw the associated debug geometry now if enabled
     if (drawDebug_ && octree_ && camera_)
     {
@@ -755,11 +1009,27 @@ void View::SetCameraShaderParameters(Camera* camera)
 
     graphics_->SetShaderParameter(VSP_VIEWPROJ, projection * camera->GetView());
 
+    if (clusteredLighting_)
+        SetClusterShaderParameters(camera);
+
     // If in a scene pass and the command defines shader parameters, set them now
     if (passCommand_)
         SetCommandShaderParameters(*passCommand_);
 }
 
+void View::SetClusterShaderParameters(Camera* camera)
+{
+    // The tiles span the viewport of the current rendertarget
+    const IntRect& viewport = graphics_->GetViewport();
+    graphics_->SetShaderParameter(PSP_CLUSTERTILE, Vector4((float)viewport.left_, (float)viewport.top_,
+        (float)CLUSTER_GRID_X / (float)Max(viewport.Width(), 1), (float)CLUSTER_GRID_Y / (float)Max(viewport.Height(), 1)));
+
+    // The depth plane gives the view space depth of a world position, also for orthographic cameras
+    const Matrix3x4& view = camera->GetView();
+    graphics_->SetShaderParameter(PSP_CLUSTERPLANE, Vector4(view.m20_, view.m21_, view.m22_, view.m23_));
+    graphics_->SetShaderParameter(PSP_CLUSTERSLICE, GetClusterSliceParams(camera));
+}
+
 void View::SetCommandShaderParameters(const RenderPathCommand& command)
 {
     const HashMap<StringHash, Variant>& parameters = command.shaderParameters_;
@@ -833,6 +1103,8 @@ void View::GetDrawables()
             occluders_.Push(drawable);
     }
 
+    BuildZoneGrid();
+
     // Determine the zone at far clip distance. If not found, or camera zone has override mode, use camera zone
     cameraZoneOverride_ = cameraZone_->GetOverride();
     if (!cameraZoneOverride_)
@@ -869,6 +1141,9 @@ void View::GetDrawables()
     else
         occluders_.Clear();
 
+    // Previous frames' GPU depth is stale, so it is only used for individual drawables, not for octants
+    gpuOcclusionBuffer_ = renderer_->GetGPUOcclusionBuffer(cullCamera_);
+
     // Get lights and geometries. Coarse occlusion for octants is used at this point
     if (occlusionBuffer_)
     {
@@ -894,30 +1169,8 @@ void View::GetDrawables()
             result.maxZ_ = 0.0f;
         }
 
-        int numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
-        int drawablesPerItem = tempDrawables.Size() / numWorkItems;
-
-        PODVector<Drawable*>::Iterator start = tempDrawables.Begin();
-        // Create a work item for each thread
-        for (int i = 0; i < numWorkItems; ++i)
-        {
-            SharedPtr<WorkItem> item = queue->GetFreeItem();
-            item->priority_ = M_MAX_UNSIGNED;
-            item->workFunction_ = CheckVisibilityWork;
-            item->aux_ = this;
-
-            PODVector<Drawable*>::Iterator end = tempDrawables.End();
-            if (i < numWorkItems - 1 && end - start > drawablesPerItem)
-                end = start + drawablesPerItem;
-
-            item->start_ = &(*start);
-            item->end_ = &(*end);
-            queue->AddWorkItem(item);
-
-            start = end;
-        }
-
-        queue->Complete(M_MAX_UNSIGNED);
+        // Split into more items than threads, as the cost of a drawable varies a lot with its batches
+        queue->ParallelFor(tempDrawables.Begin().ptr_, tempDrawables.End().ptr_, CheckVisibilityWork, this, MIN_DRAWABLES_PER_ITEM);
     }
 
     // Combine lights, geometries & scene Z range from the threads
@@ -971,6 +1224,8 @@ void View::GetBatches()
 
     ProcessLights();
     GetLightBatches();
+    if (clusteredLighting_)
+        BuildLightClusters();
     GetBaseBatches();
 }
 
@@ -980,9 +1235,11 @@ void View::ProcessLights()
     URHO3D_PROFILE(ProcessLights);
 
     auto* queue = GetSubsystem<WorkQueue>();
-    lightQueryResults_.Resize(lights_.Size());
+    // Only grow the results, so that their drawable vectors keep their capacity when the number of lights varies
+    if (lightQueryResults_.Size() < lights_.Size())
+        lightQueryResults_.Resize(lights_.Size());
 
-    for (unsigned i = 0; i < lightQueryResults_.Size(); ++i)
+    for (unsigned i = 0; i < lights_.Size(); ++i)
     {
         SharedPtr<WorkItem> item = queue->GetFreeItem();
         item->priority_ = M_MAX_UNSIGNED;
@@ -1011,17 +1268,23 @@ void View::GetLightBatches()
         // Preallocate light queues: per-pixel lights which have lit geometries
         unsigned numLightQueues = 0;
         unsigned usedLightQueues = 0;
-        for (Vector<LightQueryResult>::ConstIterator i = lightQueryResults_.Begin(); i != lightQueryResults_.End(); ++i)
+        for (Vector<LightQueryResult>::ConstIterator i = lightQueryResults_.Begin(); i != lightQueryResults_.Begin() + lights_.Size(); ++i)
         {
-            if (!i->light_->GetPerVertex() && i->litGeometries_.Size())
+            if (!i->light_->GetPerVertex() && i->litGeometries_.Size() && !IsClusteredLight(*i))
                 ++numLightQueues;
         }
 
         lightQueues_.Resize(numLightQueues);
+        clusteredLights_.Clear();
         maxLightsDrawables_.Clear();
         auto maxSortedInstances = (unsigned)renderer_->GetMaxSortedInstances();
 
-        for (Vector<LightQueryResult>::Iterator i = lightQueryResults_.Begin(); i != lightQueryResults_.End(); ++i)
+        auto* queue = GetSubsystem<WorkQueue>();
+        bool threaded = queue->GetNumThreads() && numLightQueues > 1;
+        if (threaded && batchResults_.Size() < numLightQueues)
+            batchResults_.Resize(numLightQueues);
+
+        for (Vector<LightQueryResult>::Iterator i = lightQueryResults_.Begin(); i != lightQueryResults_.Begin() + lights_.Size(); ++i)
         {
             LightQueryResult& query = *i;
 
@@ -1031,6 +1294,13 @@ void View::GetLightBatches()
 
             Light* light = query.light_;
 
+            // Clustered light, shaded in the clustered scene passes or the deferred cluster pass without batches of its own
+            if (IsClusteredLight(query))
+            {
+                clusteredLights_.Push(light);
+                continue;
+            }
+
             // Per-pixel light
             if (!light->GetPerVertex())
             {
@@ -1042,6 +1312,7 @@ void View::GetLightBatches()
                 lightQueue.light_ = light;
                 lightQueue.negative_ = light->IsNegative();
                 lightQueue.shadowMap_ = nullptr;
+                lightQueue.shadowCache_ = nullptr;
                 lightQueue.litBaseBatches_.Clear(maxSortedInstances);
                 lightQueue.litBatches_.Clear(maxSortedInstances);
                 if (forwardLightsCommand_)
@@ -1059,7 +1330,19 @@ void View::GetLightBatches()
                 // Allocate shadow map now
                 if (shadowSplits > 0)
                 {
-                    lightQueue.shadowMap_ = renderer_->GetShadowMap(light, cullCamera_, (unsigned)viewSize_.x_, (unsigned)viewSize_.y_);
+                    // Spot and point lights get a tile of the shadow map atlas if it is in use and has room. Static caster
+                    // caching copies whole shadow maps, so it is only used with separate shadow maps
+                    lightQueue.shadowMap_ = renderer_->GetShadowAtlasTile(light, cullCamera_, (unsigned)viewSize_.x_,
+                        (unsigned)viewSize_.y_, lightQueue.shadowMapRect_);
+                    if (!lightQueue.shadowMap_)
+                    {
+                        lightQueue.shadowMap_ = renderer_->GetShadowMap(light, cullCamera_, (unsigned)viewSize_.x_, (unsigned)viewSize_.y_);
+                        if (lightQueue.shadowMap_)
+                        {
+                            lightQueue.shadowMapRect_ = IntRect(0, 0, lightQueue.shadowMap_->GetWidth(), lightQueue.shadowMap_->GetHeight());
+                            lightQueue.shadowCache_ = renderer_->GetShadowMapCache(light, cullCamera_, lightQueue.shadowMap_);
+                        }
+                    }
                     // If did not manage to get a shadow map, convert the light to unshadowed
                     if (!lightQueue.shadowMap_)
                         shadowSplits = 0;
@@ -1075,17 +1358,20 @@ void View::GetLightBatches()
                     shadowQueue.nearSplit_ = query.shadowNearSplits_[j];
                     shadowQueue.farSplit_ = query.shadowFarSplits_[j];
                     shadowQueue.shadowBatches_.Clear(maxSortedInstances);
+                    shadowQueue.staticShadowBatches_.Clear(maxSortedInstances);
+                    shadowQueue.staticHash_ = 0;
+                    shadowQueue.renderStatic_ = false;
 
                     // Setup the shadow split viewport and finalize shadow camera parameters
-                    shadowQueue.shadowViewport_ = GetShadowMapViewport(light, j, lightQueue.shadowMap_);
+                    shadowQueue.shadowViewport_ = GetShadowMapViewport(light, j, lightQueue.shadowMapRect_);
                     FinalizeShadowCamera(shadowCamera, light, shadowQueue.shadowViewport_, query.shadowCasterBox_[j]);
 
-                    // Loop through shadow casters
+                    // Mark shadow casters in view. If drawable is not in actual view frustum, mark it in view here and check
+                    // its geometry update type
                     for (PODVector<Drawable*>::ConstIterator k = query.shadowCasters_.Begin() + query.shadowCasterBegin_[j];
                          k < query.shadowCasters_.Begin() + query.shadowCasterEnd_[j]; ++k)
                     {
                         Drawable* drawable = *k;
-                        // If drawable is not in actual view frustum, mark it in view here and check its geometry update type
                         if (!drawable->IsInView(frame_, true))
                         {
                             drawable->MarkInView(frame_.frameNumber_);
@@ -1095,44 +1381,30 @@ void View::GetLightBatches()
                             else if (type == UPDATE_WORKER_THREAD)
                                 threadedGeometries_.Push(drawable);
                         }
-
-                        const Vector<SourceBatch>& batches = drawable->GetBatches();
-
-                        for (unsigned l = 0; l < batches.Size(); ++l)
-                        {
-                            const SourceBatch& srcBatch = batches[l];
-
-                            Technique* tech = GetTechnique(drawable, srcBatch.material_);
-                            if (!srcBatch.geometry_ || !srcBatch.numWorldTransforms_ || !tech)
-                                continue;
-
-                            Pass* pass = tech->GetSupportedPass(Technique::shadowPassIndex);
-                            // Skip if material has no shadow pass
-                            if (!pass)
-                                continue;
-
-                            Batch destBatch(srcBatch);
-                            destBatch.pass_ = pass;
-                            destBatch.zone_ = nullptr;
-
-                            AddBatchToQueue(shadowQueue.shadowBatches_, destBatch, tech);
-                        }
                     }
                 }
 
-                // Process lit geometries
+                // Record the light to lit geometries
                 for (PODVector<Drawable*>::ConstIterator j = query.litGeometries_.Begin(); j != query.litGeometries_.End(); ++j)
                 {
                     Drawable* drawable = *j;
                     drawable->AddLight(light);
 
                     // If drawable limits maximum lights, only record the light, and check maximum count / build batches later
-                    if (!drawable->GetMaxLights())
-                        GetLitBatches(drawable, lightQueue, alphaQueue);
-                    else
+                    if (drawable->GetMaxLights())
                         maxLightsDrawables_.Insert(drawable);
                 }
 
+                // Build shadow caster and lit batches now, or in worker threads after all lights have been set up
+                if (threaded)
+                {
+                    PerThreadBatchResult& result = batchResults_[usedLightQueues - 1];
+                    result.lightQuery_ = &query;
+                    result.lightQueue_ = &lightQueue;
+                }
+                else
+                    CollectLightBatches(query, lightQueue, alphaQueue, nullptr);
+
                 // In deferred modes, store the light volume batch now. Since light mask 8 lowest bits are output to the stencil,
                 // lights that have all zeroes in the low 8 bits can be skipped; they would not affect geometry anyway
                 if (deferred_ && (light->GetLightMask() & 0xffu) != 0)
@@ -1164,6 +1436,63 @@ void View::GetLightBatches()
                 }
             }
         }
+
+        if (threaded)
+        {
+            // Each light queue is only written by its own work item. Lit alpha batches go to per-item queues
+            threadedBatches_ = true;
+            for (unsigned i = 0; i < usedLightQueues; ++i)
+            {
+                PerThreadBatchResult& result = batchResults_[i];
+                ResetBatchResult(result);
+                result.batchQueues_.Resize(alphaQueue ? 1 : 0);
+                if (alphaQueue)
+                    InitThreadBatchQueue(result.batchQueues_[0], *alphaQueue);
+
+                SharedPtr<WorkItem> item = queue->GetFreeItem();
+                item->priority_ = M_MAX_UNSIGNED;
+                item->workFunction_ = GetLightBatchesWork;
+                item->aux_ = this;
+                item->start_ = &result;
+                queue->AddWorkItem(item);
+            }
+
+            queue->Complete(M_MAX_UNSIGNED);
+            threadedBatches_ = false;
+
+            bool shadersMissing = false;
+            for (unsigned i = 0; i < usedLightQueues; ++i)
+                shadersMissing |= batchResults_[i].shadersMissing_;
+
+            for (unsigned i = 0; i < usedLightQueues; ++i)
+            {
+                PerThreadBatchResult& result = batchResults_[i];
+                LightBatchQueue& lightQueue = *result.lightQueue_;
+
+                // If shaders need to be loaded, start over in the main thread
+                if (shadersMissing)
+                {
+                    lightQueue.litBaseBatches_.Clear(maxSortedInstances);
+                    lightQueue.litBatches_.Clear(maxSortedInstances);
+                    for (unsigned j = 0; j < lightQueue.shadowSplits_.Size(); ++j)
+                    {
+                        lightQueue.shadowSplits_[j].shadowBatches_.Clear(maxSortedInstances);
+                        lightQueue.shadowSplits_[j].staticShadowBatches_.Clear(maxSortedInstances);
+                    }
+                    CollectLightBatches(*result.lightQuery_, lightQueue, alphaQueue, nullptr);
+                }
+                else
+                {
+                    SetBindlessGroupShaders(lightQueue.litBaseBatches_);
+                    SetBindlessGroupShaders(lightQueue.litBatches_);
+                    if (alphaQueue)
+                        MergeBatchQueue(*alphaQueue, result.batchQueues_[0]);
+                }
+            }
+
+            if (alphaQueue && !shadersMissing)
+                SetBindlessGroupShaders(*alphaQueue);
+        }
     }
 
     // Process drawables with limited per-pixel light count
@@ -1189,30 +1518,319 @@ void View::GetLightBatches()
     }
 }
 
+bool View::IsClusteredLight(const LightQueryResult& query) const
+{
+    // Shadowed lights need their shadow maps bound, and directional lights affect every cluster, so they keep their light queues
+    Light* light = query.light_;
+    return clusteredLighting_ && !light->GetPerVertex() && light->GetLightType() != LIGHT_DIRECTIONAL && !query.numSplits_;
+}
+
+void View::BuildLightClusters()
+{
+    URHO3D_PROFILE(BuildLightClusters);
+
+    Camera* camera = camera_ ? camera_ : cullCamera_;
+    const Matrix3x4& view = camera->GetView();
+    const Matrix4& projection = camera->GetProjection();
+    Vector2 sliceParams = GetClusterSliceParams(camera);
+    float nearClip = camera->GetNearClip();
+    bool orthographic = camera->IsOrthographic();
+
+    unsigned numLights = Min(clusteredLights_.Size(), MAX_CLUSTERED_LIGHTS);
+    clusterLightData_.Resize(numLights * CLUSTER_LIGHT_VECTORS);
+    clusterLightBounds_.Clear();
+
+    for (unsigned i = 0; i < numLights; ++i)
+    {
+        Light* light = clusteredLights_[i];
+        Node* lightNode = light->GetNode();
+        Vector3 position = lightNode->GetWorldPosition();
+        Vector3 direction = lightNode->GetWorldDirection();
+        float range = light->GetRange();
+        Color color = light->GetEffectiveColor();
+
+        // Bounding sphere of the lit volume
+        Vector3 center = position;
+        float radius = range;
+        // Point lights use a cone test that always passes
+        float cosOuter = -2.0f;
+        float spotScale = 1.0f;
+        if (light->GetLightType() == LIGHT_SPOT)
+        {
+            float halfAngle = light->GetFov() * 0.5f;
+            cosOuter = Cos(halfAngle);
+            spotScale = 1.0f / Max(Cos(halfAngle * (1.0f - CLUSTER_SPOT_FADE)) - cosOuter, M_EPSILON);
+            if (halfAngle > 45.0f)
+            {
+                center = position + direction * range * cosOuter;
+                radius = range * Sin(halfAngle);
+            }
+            else
+            {
+                radius = range * 0.5f / cosOuter;
+                center = position + direction * radius;
+            }
+        }
+
+        Vector4* data = &clusterLightData_[i * CLUSTER_LIGHT_VECTORS];
+        data[0] = Vector4(position, 1.0f / Max(range, M_EPSILON));
+        data[1] = Vector4(color.r_, color.g_, color.b_, light->GetEffectiveSpecularIntensity());
+        data[2] = Vector4(direction, cosOuter);
+        data[3] = Vector4(spotScale, 0.0f, 0.0f, 0.0f);
+
+        Vector3 viewCenter = view * center;
+        float minZ = viewCenter.z_ - radius;
+        float maxZ = viewCenter.z_ + radius;
+        if (maxZ < nearClip)
+            continue;
+
+        LightClusterBounds bounds;
+        bounds.lightIndex_ = i;
+        bounds.minSlice_ = GetClusterSlice(Max(minZ, nearClip), sliceParams);
+        bounds.maxSlice_ = GetClusterSlice(maxZ, sliceParams);
+
+        // Project the view space bounding box to screen tiles. A perspective projection is unbounded if the box reaches behind the
+        // near plane
+        bounds.tiles_ = IntRect(0, 0, CLUSTER_GRID_X - 1, CLUSTER_GRID_Y - 1);
+        if (orthographic || minZ > nearClip)
+        {
+            Vector2 minNdc(M_INFINITY, M_INFINITY);
+            Vector2 maxNdc(-M_INFINITY, -M_INFINITY);
+            for (unsigned j = 0; j < 8; ++j)
+            {
+                Vector3 corner(viewCenter.x_ + ((j & 1u) ? radius : -radius), viewCenter.y_ + ((j & 2u) ? radius : -radius),
+                    (j & 4u) ? maxZ : minZ);
+                Vector4 clipPos = projection * Vector4(corner, 1.0f);
+                Vector2 ndc(clipPos.x_ / clipPos.w_, clipPos.y_ / clipPos.w_);
+                minNdc.x_ = Min(minNdc.x_, ndc.x_);
+                minNdc.y_ = Min(minNdc.y_, ndc.y_);
+                maxNdc.x_ = Max(maxNdc.x_, ndc.x_);
+                maxNdc.y_ = Max(maxNdc.y_, ndc.y_);
+            }
+
+            // Tile rows run from the top of the viewport
+            bounds.tiles_.left_ = Max((int)floorf((minNdc.x_ * 0.5f + 0.5f) * CLUSTER_GRID_X), 0);
+            bounds.tiles_.right_ = Min((int)floorf((maxNdc.x_ * 0.5f + 0.5f) * CLUSTER_GRID_X), (int)CLUSTER_GRID_X - 1);
+            bounds.tiles_.top_ = Max((int)floorf((0.5f - maxNdc.y_ * 0.5f) * CLUSTER_GRID_Y), 0);
+            bounds.tiles_.bottom_ = Min((int)floorf((0.5f - minNdc.y_ * 0.5f) * CLUSTER_GRID_Y), (int)CLUSTER_GRID_Y - 1);
+            if (bounds.tiles_.left_ > bounds.tiles_.right_ || bounds.tiles_.top_ > bounds.tiles_.bottom_)
+                continue;
+        }
+
+        clusterLightBounds_.Push(bounds);
+    }
+
+    // Build the light lists of each depth slice in its own work item
+    auto* queue = GetSubsystem<WorkQueue>();
+    clusterSlices_.Resize(CLUSTER_GRID_Z);
+    for (unsigned i = 0; i < CLUSTER_GRID_Z; ++i)
+    {
+        LightClusterSlice& slice = clusterSlices_[i];
+        slice.slice_ = i;
+
+        SharedPtr<WorkItem> item = queue->GetFreeItem();
+        item->priority_ = M_MAX_UNSIGNED;
+        item->workFunction_ = BuildLightClusterSliceWork;
+        item->aux_ = this;
+        item->start_ = &slice;
+        queue->AddWorkItem(item);
+    }
+
+    queue->Complete(M_MAX_UNSIGNED);
+
+    // Concatenate the slices in order
+    const unsigned clustersPerSlice = CLUSTER_GRID_X * CLUSTER_GRID_Y;
+    clusters_.Resize(NUM_CLUSTERS * 2);
+    clusterLightIndices_.Clear();
+    for (unsigned i = 0; i < CLUSTER_GRID_Z; ++i)
+    {
+        const LightClusterSlice& slice = clusterSlices_[i];
+        unsigned offset = clusterLightIndices_.Size();
+        unsigned* dest = &clusters_[i * clustersPerSlice * 2];
+        for (unsigned j = 0; j < clustersPerSlice; ++j)
+        {
+            dest[j * 2] = slice.clusters_[j * 2] + offset;
+            dest[j * 2 + 1] = slice.clusters_[j * 2 + 1];
+        }
+        clusterLightIndices_.Push(slice.lightIndices_);
+    }
+}
+
+void View::BuildLightClusterSlice(LightClusterSlice& slice)
+{
+    auto sliceIndex = (int)slice.slice_;
+
+    slice.lights_.Clear();
+    for (PODVector<LightClusterBounds>::ConstIterator i = clusterLightBounds_.Begin(); i != clusterLightBounds_.End(); ++i)
+    {
+        if (sliceIndex >= i->minSlice_ && sliceIndex <= i->maxSlice_)
+            slice.lights_.Push(&(*i));
+    }
+
+    slice.clusters_.Resize(CLUSTER_GRID_X * CLUSTER_GRID_Y * 2);
+    slice.lightIndices_.Clear();
+    for (int y = 0; y < (int)CLUSTER_GRID_Y; ++y)
+    {
+        for (int x = 0; x < (int)CLUSTER_GRID_X; ++x)
+        {
+            unsigned offset = slice.lightIndices_.Size();
+            unsigned count = 0;
+            for (PODVector<const LightClusterBounds*>::ConstIterator i = slice.lights_.Begin(); i != slice.lights_.End() &&
+                count < MAX_LIGHTS_PER_CLUSTER; ++i)
+            {
+                const IntRect& tiles = (*i)->tiles_;
+                if (x >= tiles.left_ && x <= tiles.right_ && y >= tiles.top_ && y <= tiles.bottom_)
+                {
+                    slice.lightIndices_.Push((*i)->lightIndex_);
+                    ++count;
+                }
+            }
+
+            unsigned cluster = (unsigned)(y * CLUSTER_GRID_X + x) * 2;
+            slice.clusters_[cluster] = offset;
+            slice.clusters_[cluster + 1] = count;
+        }
+    }
+}
+
 void View::GetBaseBatches()
 {
     URHO3D_PROFILE(GetBaseBatches);
 
-    for (PODVector<Drawable*>::ConstIterator i = geometries_.Begin(); i != geometries_.End(); ++i)
+    // Streamed textures are requested at the size the drawables appear on screen. Assume the texture spans the drawable
+    // once, scaled by the renderer's streaming scale
+    if (renderer_->GetNumStreamedTextures())
     {
-        Drawable* drawable = *i;
+        float halfViewSize = camera_->GetHalfViewSize();
+        streamingTexelScale_ = halfViewSize > 0.0f ? renderer_->GetTextureStreamingScale() * viewSize_.y_ / (2.0f * halfViewSize) : 0.0f;
+    }
+    else
+        streamingTexelScale_ = 0.0f;
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    unsigned numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
+    if (numWorkItems == 1 || geometries_.Size() < numWorkItems * MIN_THREADED_BATCH_GEOMETRIES)
+    {
+        CollectBaseBatches(0, geometries_.Size(), nullptr);
+        return;
+    }
+
+    // Collect batches from contiguous geometry ranges, so that merging the results in order gives the same batch order regardless
+    // of which thread processed which range
+    if (batchResults_.Size() < numWorkItems)
+        batchResults_.Resize(numWorkItems);
+
+    unsigned geometriesPerItem = geometries_.Size() / numWorkItems;
+    unsigned start = 0;
+
+    threadedBatches_ = true;
+    for (unsigned i = 0; i < numWorkItems; ++i)
+    {
+        PerThreadBatchResult& result = batchResults_[i];
+        ResetBatchResult(result);
+        result.start_ = start;
+        result.end_ = i < numWorkItems - 1 ? start + geometriesPerItem : geometries_.Size();
+        result.batchQueues_.Resize(scenePasses_.Size());
+        for (unsigned j = 0; j < scenePasses_.Size(); ++j)
+            InitThreadBatchQueue(result.batchQueues_[j], *scenePasses_[j].batchQueue_);
+
+        SharedPtr<WorkItem> item = queue->GetFreeItem();
+        item->priority_ = M_MAX_UNSIGNED;
+        item->workFunction_ = GetBaseBatchesWork;
+        item->aux_ = this;
+        item->start_ = &result;
+        queue->AddWorkItem(item);
+
+        start = result.end_;
+    }
+
+    queue->Complete(M_MAX_UNSIGNED);
+    threadedBatches_ = false;
+
+    // If shaders need to be loaded, start over in the main thread
+    for (unsigned i = 0; i < numWorkItems; ++i)
+    {
+        if (batchResults_[i].shadersMissing_)
+        {
+            CollectBaseBatches(0, geometries_.Size(), nullptr);
+            return;
+        }
+    }
+
+    for (unsigned i = 0; i < numWorkItems; ++i)
+    {
+        PerThreadBatchResult& result = batchResults_[i];
+        nonThreadedGeometries_.Push(result.nonThreadedGeometries_);
+        threadedGeometries_.Push(result.threadedGeometries_);
+
+        for (PODVector<Material*>::ConstIterator j = result.auxViewMaterials_.Begin(); j != result.auxViewMaterials_.End(); ++j)
+        {
+            if ((*j)->GetAuxViewFrameNumber() != frame_.frameNumber_)
+                CheckMaterialForAuxView(*j);
+        }
+
+        for (PODVector<Pair<Material*, float> >::ConstIterator j = result.streamedMaterials_.Begin();
+             j != result.streamedMaterials_.End(); ++j)
+            RequestStreamedTextures(j->first_, j->second_);
+    }
+
+    for (unsigned i = 0; i < scenePasses_.Size(); ++i)
+    {
+        BatchQueue& batchQueue = *scenePasses_[i].batchQueue_;
+        for (unsigned j = 0; j < numWorkItems; ++j)
+            MergeBatchQueue(batchQueue, batchResults_[j].batchQueues_[i]);
+        SetBindlessGroupShaders(batchQueue);
+    }
+}
+
+void View::CollectBaseBatches(unsigned start, unsigned end, PerThreadBatchResult* result)
+{
+    PODVector<Drawable*>& nonThreadedGeometries = result ? result->nonThreadedGeometries_ : nonThreadedGeometries_;
+    PODVector<Drawable*>& threadedGeometries = result ? result->threadedGeometries_ : threadedGeometries_;
+
+    for (unsigned i = start; i < end; ++i)
+    {
+        Drawable* drawable = geometries_[i];
         UpdateGeometryType type = drawable->GetUpdateGeometryType();
         if (type == UPDATE_MAIN_THREAD)
-            nonThreadedGeometries_.Push(drawable);
+            nonThreadedGeometries.Push(drawable);
         else if (type == UPDATE_WORKER_THREAD)
-            threadedGeometries_.Push(drawable);
+            threadedGeometries.Push(drawable);
 
         const Vector<SourceBatch>& batches = drawable->GetBatches();
         bool vertexLightsProcessed = false;
 
+        float streamedTexels = 0.0f;
+        if (streamingTexelScale_ > 0.0f)
+        {
+            streamedTexels = drawable->GetWorldBoundingBox().Size().Length() * streamingTexelScale_;
+            if (!camera_->IsOrthographic())
+                streamedTexels /= Max(drawable->GetDistance(), camera_->GetNearClip());
+        }
+
         for (unsigned j = 0; j < batches.Size(); ++j)
         {
             const SourceBatch& srcBatch = batches[j];
 
+            // Request the streamed textures, worker threads defer the requests to the main thread
+            if (streamedTexels > 0.0f && srcBatch.material_)
+            {
+                if (!result)
+                    RequestStreamedTextures(srcBatch.material_, streamedTexels);
+                else
+                    result->streamedMaterials_.Push(MakePair(srcBatch.material_.Get(), streamedTexels));
+            }
+
             // Check here if the material refers to a rendertarget texture with camera(s) attached
             // Only check this for backbuffer views (null rendertarget)
             if (srcBatch.material_ && srcBatch.material_->GetAuxViewFrameNumber() != frame_.frameNumber_ && !renderTarget_)
-                CheckMaterialForAuxView(srcBatch.material_);
+            {
+                // Worker threads defer the check to the main thread
+                if (!result)
+                    CheckMaterialForAuxView(srcBatch.material_);
+                else if (result->auxViewMaterials_.Empty() || result->auxViewMaterials_.Back() != srcBatch.material_)
+                    result->auxViewMaterials_.Push(srcBatch.material_);
+            }
 
             Technique* tech = GetTechnique(drawable, srcBatch.material_);
             if (!srcBatch.geometry_ || !srcBatch.numWorldTransforms_ || !tech)
@@ -1239,29 +1857,36 @@ void View::GetBaseBatches()
                 if (info.vertexLights_)
                 {
                     const PODVector<Light*>& drawableVertexLights = drawable->GetVertexLights();
-                    if (drawableVertexLights.Size() && !vertexLightsProcessed)
-                    {
-                        // Limit vertex lights. If this is a deferred opaque batch, remove converted per-pixel lights,
-                        // as they will be rendered as light volumes in any case, and drawing them also as vertex lights
-                        // would result in double lighting
-                        drawable->LimitVertexLights(deferred_ && destBatch.pass_->GetBlendMode() == BLEND_REPLACE);
-                        vertexLightsProcessed = true;
-                    }
-
                     if (drawableVertexLights.Size())
                     {
-                        // Find a vertex light queue. If not found, create new
-                        unsigned long long hash = GetVertexLightQueueHash(drawableVertexLights);
-                        HashMap<unsigned long long, LightBatchQueue>::Iterator i = vertexLightQueues_.Find(hash);
-                        if (i == vertexLightQueues_.End())
+                        // Vertex light limiting writes sort values to the lights, and the vertex light queues are shared
+                        MutexLock lock(batchMutex_);
+
+                        if (!vertexLightsProcessed)
                         {
-                            i = vertexLightQueues_.Insert(MakePair(hash, LightBatchQueue()));
-                            i->second_.light_ = nullptr;
-                            i->second_.shadowMap_ = nullptr;
-                            i->second_.vertexLights_ = drawableVertexLights;
+                            // Limit vertex lights. If this is a deferred opaque batch, remove converted per-pixel lights,
+                            // as they will be rendered as light volumes in any case, and drawing them also as vertex lights
+                            // would result in double lighting
+                            drawable->LimitVertexLights(deferred_ && destBatch.pass_->GetBlendMode() == BLEND_REPLACE);
+                            vertexLightsProcessed = true;
                         }
 
-                        destBatch.lightQueue_ = &(i->second_);
+                        if (drawableVertexLights.Size())
+                        {
+                            // Find a vertex light queue. If not found, create new
+                            unsigned long long hash = GetVertexLightQueueHash(drawableVertexLights);
+                            HashMap<unsigned long long, LightBatchQueue>::Iterator i = vertexLightQueues_.Find(hash);
+                            if (i == vertexLightQueues_.End())
+                            {
+                                i = vertexLightQueues_.Insert(MakePair(hash, LightBatchQueue()));
+                                i->second_.light_ = nullptr;
+                                i->second_.shadowMap_ = nullptr;
+                                i->second_.shadowCache_ = nullptr;
+                                i->second_.vertexLights_ = drawableVertexLights;
+                            }
+
+                            destBatch.lightQueue_ = &(i->second_);
+                        }
                     }
                 }
                 else
@@ -1271,7 +1896,15 @@ void View::GetBaseBatches()
                 if (allowInstancing && info.markToStencil_ && destBatch.lightMask_ != (destBatch.zone_->GetLightMask() & 0xffu))
                     allowInstancing = false;
 
-                AddBatchToQueue(*info.batchQueue_, destBatch, tech, allowInstancing);
+                BatchQueue& batchQueue = result ? result->batchQueues_[k] : *info.batchQueue_;
+                // Shaders can only be loaded in the main thread
+                if (result && !renderer_->HasBatchShaders(pass, batchQueue))
+                {
+                    result->shadersMissing_ = true;
+                    return;
+                }
+
+                AddBatchToQueue(batchQueue, destBatch, tech, allowInstancing);
             }
         }
     }
@@ -1298,7 +1931,7 @@ void View::UpdateGeometries()
             if (!IsNecessary(command))
                 continue;
 
-            if (command.type_ == CMD_SCENEPASS)
+            if (command.type_ == CMD_SCENEPASS || command.type_ == CMD_FORWARDCLUSTERED)
             {
                 SharedPtr<WorkItem> item = queue->GetFreeItem();
                 item->priority_ = M_MAX_UNSIGNED;
@@ -1371,12 +2004,88 @@ void View::UpdateGeometries()
             (*i)->UpdateGeometry(frame_);
     }
 
-    // Finally ensure all threaded work has completed
+    // Finally ensure all threaded work has completed, then let the threaded updates upload what they generated
     queue->Complete(M_MAX_UNSIGNED);
+    for (PODVector<Drawable*>::ConstIterator i = threadedGeometries_.Begin(); i != threadedGeometries_.End(); ++i)
+    {
+        if (*i)
+            (*i)->FinishUpdateGeometry(frame_);
+    }
     geometriesUpdated_ = true;
 }
 
-void View::GetLitBatches(Drawable* drawable, LightBatchQueue& lightQueue, BatchQueue* alphaQueue)
+void View::CollectLightBatches(LightQueryResult& query, LightBatchQueue& lightQueue, BatchQueue* alphaQueue,
+    PerThreadBatchResult* result)
+{
+    ShadowMapCache* cache = lightQueue.shadowCache_;
+
+    // Loop through shadow casters
+    for (unsigned i = 0; i < lightQueue.shadowSplits_.Size(); ++i)
+    {
+        ShadowBatchQueue& shadowQueue = lightQueue.shadowSplits_[i];
+        PODVector<Drawable*>::ConstIterator begin = query.shadowCasters_.Begin() + query.shadowCasterBegin_[i];
+        PODVector<Drawable*>::ConstIterator end = query.shadowCasters_.Begin() + query.shadowCasterEnd_[i];
+
+        // With a shadow map cache, static casters only need to be rendered when the split's caster set has changed
+        if (cache)
+        {
+            shadowQueue.staticHash_ = GetStaticShadowHash(lightQueue.light_, shadowQueue, begin, end);
+            shadowQueue.renderStatic_ = shadowQueue.staticHash_ != cache->splitHashes_[i];
+        }
+
+        for (PODVector<Drawable*>::ConstIterator j = begin; j < end; ++j)
+        {
+            Drawable* drawable = *j;
+            bool isStatic = cache && IsStaticShadowCaster(drawable);
+            if (isStatic && !shadowQueue.renderStatic_)
+                continue;
+
+            BatchQueue& shadowBatches = isStatic ? shadowQueue.staticShadowBatches_ : shadowQueue.shadowBatches_;
+            const Vector<SourceBatch>& batches = drawable->GetBatches();
+
+            for (unsigned k = 0; k < batches.Size(); ++k)
+            {
+                const SourceBatch& srcBatch = batches[k];
+
+                Technique* tech = GetTechnique(drawable, srcBatch.material_);
+                Geometry* geometry = srcBatch.GetShadowGeometry();
+                if (!geometry || !srcBatch.numWorldTransforms_ || !tech)
+                    continue;
+
+                Pass* pass = tech->GetSupportedPass(Technique::shadowPassIndex);
+                // Skip if material has no shadow pass
+                if (!pass)
+                    continue;
+
+                // Shaders can only be loaded in the main thread
+                if (result && !renderer_->HasBatchShaders(pass, shadowBatches))
+                {
+                    result->shadersMissing_ = true;
+                    return;
+                }
+
+                Batch destBatch(srcBatch);
+                destBatch.geometry_ = geometry;
+                destBatch.pass_ = pass;
+                destBatch.zone_ = nullptr;
+
+                AddBatchToQueue(shadowBatches, destBatch, tech);
+            }
+        }
+    }
+
+    // Process lit geometries
+    for (PODVector<Drawable*>::ConstIterator i = query.litGeometries_.Begin(); i != query.litGeometries_.End(); ++i)
+    {
+        Drawable* drawable = *i;
+        if (!drawable->GetMaxLights())
+            GetLitBatches(drawable, lightQueue, alphaQueue, result);
+        if (result && result->shadersMissing_)
+            return;
+    }
+}
+
+void View::GetLitBatches(Drawable* drawable, LightBatchQueue& lightQueue, BatchQueue* alphaQueue, PerThreadBatchResult* result)
 {
     Light* light = lightQueue.light_;
     Zone* zone = GetZone(drawable);
@@ -1431,18 +2140,24 @@ void View::GetLitBatches(Drawable* drawable, LightBatchQueue& lightQueue, BatchQ
         destBatch.lightQueue_ = &lightQueue;
         destBatch.zone_ = zone;
 
-        if (!isLitAlpha)
+        BatchQueue* queue = !isLitAlpha ? (destBatch.isBase_ ? &lightQueue.litBaseBatches_ : &lightQueue.litBatches_) : alphaQueue;
+        if (!queue)
+            continue;
+
+        // Shaders can only be loaded in the main thread
+        if (result && !renderer_->HasBatchShaders(destBatch.pass_, *queue))
         {
-            if (destBatch.isBase_)
-                AddBatchToQueue(lightQueue.litBaseBatches_, destBatch, tech);
-            else
-                AddBatchToQueue(lightQueue.litBatches_, destBatch, tech);
+            result->shadersMissing_ = true;
+            return;
         }
-        else if (alphaQueue)
+
+        if (!isLitAlpha)
+            AddBatchToQueue(*queue, destBatch, tech);
+        else
         {
             // Transparent batches can not be instanced, and shadows on transparencies can only be rendered if shadow maps are
             // not reused
-            AddBatchToQueue(*alphaQueue, destBatch, tech, false, !renderer_->GetReuseShadowMaps());
+            AddBatchToQueue(*queue, destBatch, tech, false, !renderer_->GetReuseShadowMaps());
         }
     }
 }
@@ -1473,6 +2188,7 @@ void View::ExecuteRenderPathCommands()
 
         bool viewportModified = false;
         bool isPingponging = false;
+        bool clusterListsUploaded = false;
         usedResolve_ = false;
 
         unsigned lastCommandIndex = 0;
@@ -1489,6 +2205,13 @@ void View::ExecuteRenderPathCommands()
             if (!actualView->IsNecessary(command))
                 continue;
 
+            // Rendering must wait for the async compute work using the same textures to finish on the GPU
+            if (graphics_->IsAsyncComputePending() && CheckAsyncComputeAccess(command))
+            {
+                graphics_->WaitAsyncCompute();
+                asyncComputeTextures_.Clear();
+            }
+
             bool viewportRead = actualView->CheckViewportRead(command);
             bool viewportWrite = actualView->CheckViewportWrite(command);
             bool beginPingpong = actualView->CheckPingpong(i);
@@ -1551,9 +2274,9 @@ void View::ExecuteRenderPathCommands()
                     // However, on OpenGL we can not reliably do this in case the final target is the backbuffer, and we want to
                     // render depth buffer sensitive debug geometry afterward (backbuffer and textures can not share depth)
 #ifndef URHO3D_OPENGL
-                    if (i == lastCommandIndex && command.type_ == CMD_QUAD)
+                    if (i == lastCommandIndex && command.type_ == CMD_QUAD && !upscale_)
 #else
-                    if (i == lastCommandIndex && command.type_ == CMD_QUAD && renderTarget_)
+                    if (i == lastCommandIndex && command.type_ == CMD_QUAD && renderTarget_ && !upscale_)
 #endif
                         currentRenderTarget_ = renderTarget_;
                 }
@@ -1561,6 +2284,10 @@ void View::ExecuteRenderPathCommands()
                     currentRenderTarget_ = substituteRenderTarget_ ? substituteRenderTarget_ : renderTarget_;
             }
 
+            bool gpuTiming = graphics_->GetGPUProfiling();
+            if (gpuTiming)
+                graphics_->BeginGPUTiming(command.GetProfileName());
+
             switch (command.type_)
             {
             case CMD_CLEAR:
@@ -1577,6 +2304,7 @@ void View::ExecuteRenderPathCommands()
                 break;
 
             case CMD_SCENEPASS:
+            case CMD_FORWARDCLUSTERED:
                 {
                     BatchQueue& queue = actualView->batchQueues_[command.passIndex_];
                     if (!queue.IsEmpty())
@@ -1584,6 +2312,20 @@ void View::ExecuteRenderPathCommands()
                         URHO3D_PROFILE(RenderScenePass);
 
                         SetRenderTargets(command);
+
+                        if (command.type_ == CMD_FORWARDCLUSTERED && clusteredLighting_)
+                        {
+                            // Upload the light lists once per view, and make sure the grid parameters follow this command's
+                            // rendertarget viewport
+                            if (!clusterListsUploaded)
+                            {
+                                graphics_->SetClusteredLights(actualView->clusterLightData_, actualView->clusters_,
+                                    actualView->clusterLightIndices_);
+                                clusterListsUploaded = true;
+                            }
+                            graphics_->ClearParameterSources();
+                        }
+
                         bool allowDepthWrite = SetTextures(command);
                         graphics_->SetClipPlane(camera_->GetUseClipping(), camera_->GetClipPlane(), camera_->GetView(),
                             camera_->GetGPUProjection());
@@ -1596,7 +2338,9 @@ void View::ExecuteRenderPathCommands()
                             passCommand_ = &command;
                         }
 
+                        unsigned oldBatches = graphics_->GetNumBatches();
                         queue.Draw(this, camera_, command.markToStencil_, false, allowDepthWrite);
+                        renderer_->AddPassBatches(command.passIndex_, command.pass_, graphics_->GetNumBatches() - oldBatches);
 
                         passCommand_ = nullptr;
                     }
@@ -1661,6 +2405,7 @@ void View::ExecuteRenderPathCommands()
                 break;
 
             case CMD_LIGHTVOLUMES:
+            case CMD_DEFERREDCLUSTERED:
                 // Render shadow maps + light volumes
                 if (!actualView->lightQueues_.Empty())
                 {
@@ -1696,6 +2441,24 @@ void View::ExecuteRenderPathCommands()
                     graphics_->SetScissorTest(false);
                     graphics_->SetStencilTest(false);
                 }
+
+                // Then accumulate the clustered lights in one fullscreen pass
+                if (command.type_ == CMD_DEFERREDCLUSTERED && clusteredLighting_ && !actualView->clusterLightIndices_.Empty())
+                {
+                    URHO3D_PROFILE(RenderClusteredLights);
+
+                    if (!clusterListsUploaded)
+                    {
+                        graphics_->SetClusteredLights(actualView->clusterLightData_, actualView->clusters_,
+                            actualView->clusterLightIndices_);
+                        clusterListsUploaded = true;
+                    }
+
+                    SetRenderTargets(command);
+                    SetTextures(command);
+                    graphics_->ClearParameterSources();
+                    RenderClusteredLights(command);
+                }
                 break;
 
             case CMD_RENDERUI:
@@ -1705,6 +2468,14 @@ void View::ExecuteRenderPathCommands()
                 }
                 break;
 
+            case CMD_COMPUTE:
+                {
+                    URHO3D_PROFILE(RunCompute);
+
+                    RunCompute(command);
+                }
+                break;
+
             case CMD_SENDEVENT:
                 {
                     using namespace RenderPathEvent;
@@ -1719,10 +2490,17 @@ void View::ExecuteRenderPathCommands()
                 break;
             }
 
+            if (gpuTiming)
+                graphics_->EndGPUTiming();
+
             // If current command output to the viewport, mark it modified
             if (viewportWrite)
                 viewportModified = true;
         }
+
+        // The screen buffers may be reused by other views
+        graphics_->WaitAsyncCompute();
+        asyncComputeTextures_.Clear();
     }
 }
 
@@ -1867,39 +2645,186 @@ void View::RenderQuad(RenderPathCommand& command)
         if (!rtInfo.enabled_)
             continue;
 
-        StringHash nameHash(rtInfo.name_);
-        if (!renderTargets_.Contains(nameHash))
-            continue;
+        StringHash nameHash(rtInfo.name_);
+        if (!renderTargets_.Contains(nameHash))
+            continue;
+
+        String invSizeName = rtInfo.name_ + "InvSize";
+        String offsetsName = rtInfo.name_ + "Offsets";
+        auto width = (float)renderTargets_[nameHash]->GetWidth();
+        auto height = (float)renderTargets_[nameHash]->GetHeight();
+
+        const Vector2& pixelUVOffset = Graphics::GetPixelUVOffset();
+        graphics_->SetShaderParameter(invSizeName, Vector2(1.0f / width, 1.0f / height));
+        graphics_->SetShaderParameter(offsetsName, Vector2(pixelUVOffset.x_ / width, pixelUVOffset.y_ / height));
+    }
+
+    // Set command's shader parameters last to allow them to override any of the above
+    SetCommandShaderParameters(command);
+
+    graphics_->SetBlendMode(command.blendMode_);
+    graphics_->SetDepthTest(CMP_ALWAYS);
+    graphics_->SetDepthWrite(false);
+    graphics_->SetFillMode(FILL_SOLID);
+    graphics_->SetLineAntiAlias(false);
+    graphics_->SetClipPlane(false);
+    graphics_->SetScissorTest(false);
+    graphics_->SetStencilTest(false);
+
+    DrawFullscreenQuad(false);
+}
+
+void View::RenderClusteredLights(const RenderPathCommand& command)
+{
+    // The fullscreen variation of the light volume shaders loops over the light list of each pixel's cluster
+    String defines = camera_->IsOrthographic() ? "CLUSTERED ORTHO " : "CLUSTERED ";
+    ShaderVariation* vs = graphics_->GetShader(VS, command.vertexShaderName_, defines + command.vertexShaderDefines_);
+    ShaderVariation* ps = graphics_->GetShader(PS, command.pixelShaderName_, defines + command.pixelShaderDefines_);
+    if (!vs || !ps)
+        return;
 
-        String invSizeName = rtInfo.name_ + "InvSize";
-        String offsetsName = rtInfo.name_ + "Offsets";
-        auto width = (float)renderTargets_[nameHash]->GetWidth();
-        auto height = (float)renderTargets_[nameHash]->GetHeight();
+    graphics_->SetShaders(vs, ps);
 
-        const Vector2& pixelUVOffset = Graphics::GetPixelUVOffset();
-        graphics_->SetShaderParameter(invSizeName, Vector2(1.0f / width, 1.0f / height));
-        graphics_->SetShaderParameter(offsetsName, Vector2(pixelUVOffset.x_ / width, pixelUVOffset.y_ / height));
-    }
+    SetGlobalShaderParameters();
+    SetCameraShaderParameters(camera_);
 
-    // Set command's shader parameters last to allow them to override any of the above
+    IntRect viewport = graphics_->GetViewport();
+    IntVector2 viewSize = IntVector2(viewport.Width(), viewport.Height());
+    SetGBufferShaderParameters(viewSize, IntRect(0, 0, viewSize.x_, viewSize.y_));
     SetCommandShaderParameters(command);
 
-    graphics_->SetBlendMode(command.blendMode_);
+    graphics_->SetBlendMode(BLEND_ADD);
+    graphics_->SetDepthBias(0.0f, 0.0f);
     graphics_->SetDepthTest(CMP_ALWAYS);
     graphics_->SetDepthWrite(false);
     graphics_->SetFillMode(FILL_SOLID);
     graphics_->SetLineAntiAlias(false);
     graphics_->SetClipPlane(false);
     graphics_->SetScissorTest(false);
-    graphics_->SetStencilTest(false);
+    // Skip the pixels that no G-buffer geometry was written to
+    if (!noStencil_)
+        graphics_->SetStencilTest(true, CMP_NOTEQUAL, OP_KEEP, OP_KEEP, OP_KEEP, 0, 0xffu);
+    else
+        graphics_->SetStencilTest(false);
 
     DrawFullscreenQuad(false);
+
+    graphics_->SetStencilTest(false);
+}
+
+void View::RunCompute(RenderPathCommand& command)
+{
+    if (command.computeShaderName_.Empty())
+        return;
+
+    // The output must be a rendertarget of the renderpath, as the viewport can not be written by compute shaders
+    const String& outputName = command.outputs_[0].first_;
+    auto* output = dynamic_cast<Texture2D*>(!outputName.Compare("viewport", false) ? nullptr :
+        FindNamedTexture(outputName, true, false));
+    if (!output)
+    {
+        URHO3D_LOGERROR("Compute command output " + outputName + " is not a 2D rendertarget");
+        command.computeShaderName_ = String::EMPTY;
+        return;
+    }
+
+    Texture2D* textures[MAX_TEXTURE_UNITS]{};
+    for (unsigned i = 0; i < MAX_TEXTURE_UNITS; ++i)
+    {
+        if (command.textureNames_[i].Empty())
+            continue;
+        Texture* texture = !command.textureNames_[i].Compare("viewport", false) ? currentViewportTexture_ :
+            FindNamedTexture(command.textureNames_[i], false, false);
+        textures[i] = dynamic_cast<Texture2D*>(texture);
+    }
+
+    // Parameters are passed in definition order
+    PODVector<Vector4> parameters;
+    for (HashMap<StringHash, Variant>::ConstIterator i = command.shaderParameters_.Begin(); i != command.shaderParameters_.End() &&
+        parameters.Size() < MAX_COMPUTE_PARAMETERS; ++i)
+    {
+        const Variant& value = i->second_;
+        switch (value.GetType())
+        {
+        case VAR_FLOAT:
+            parameters.Push(Vector4(value.GetFloat(), 0.0f, 0.0f, 0.0f));
+            break;
+        case VAR_VECTOR2:
+            parameters.Push(Vector4(value.GetVector2().x_, value.GetVector2().y_, 0.0f, 0.0f));
+            break;
+        case VAR_VECTOR3:
+            parameters.Push(Vector4(value.GetVector3(), 0.0f));
+            break;
+        case VAR_COLOR:
+            parameters.Push(value.GetColor().ToVector4());
+            break;
+        default:
+            parameters.Push(value.GetVector4());
+            break;
+        }
+    }
+
+    // If compiling fails, clear the shader from the command to prevent redundant attempts
+    bool async = command.async_ && graphics_->GetAsyncComputeSupport();
+    if (!graphics_->DispatchCompute(command.computeShaderName_, command.computeShaderDefines_, textures, output, parameters, async))
+    {
+        command.computeShaderName_ = String::EMPTY;
+        return;
+    }
+
+    if (graphics_->IsAsyncComputePending())
+    {
+        for (unsigned i = 0; i < MAX_TEXTURE_UNITS; ++i)
+        {
+            if (textures[i])
+                asyncComputeTextures_.Push(textures[i]);
+        }
+        asyncComputeTextures_.Push(output);
+    }
+}
+
+bool View::CheckAsyncComputeAccess(const RenderPathCommand& command)
+{
+    // The viewport may be resolved, blitted or pingponged into any of the viewport textures
+    if (CheckViewportRead(command) || CheckViewportWrite(command))
+    {
+        if (asyncComputeTextures_.Contains(currentViewportTexture_) || asyncComputeTextures_.Contains(viewportTextures_[0]) ||
+            asyncComputeTextures_.Contains(viewportTextures_[1]) || (currentRenderTarget_ &&
+            asyncComputeTextures_.Contains(currentRenderTarget_->GetParentTexture())) || (substituteRenderTarget_ &&
+            asyncComputeTextures_.Contains(substituteRenderTarget_->GetParentTexture())))
+            return true;
+    }
+
+    // Only rendertargets are written by rendering, but aliased screen buffers may be shared between several of them
+    for (unsigned i = 0; i < command.outputs_.Size(); ++i)
+    {
+        HashMap<StringHash, Texture*>::ConstIterator j = renderTargets_.Find(StringHash(command.outputs_[i].first_));
+        if (j != renderTargets_.End() && asyncComputeTextures_.Contains(j->second_))
+            return true;
+    }
+    if (command.depthStencilName_.Length())
+    {
+        HashMap<StringHash, Texture*>::ConstIterator j = renderTargets_.Find(StringHash(command.depthStencilName_));
+        if (j != renderTargets_.End() && asyncComputeTextures_.Contains(j->second_))
+            return true;
+    }
+    for (const auto& textureName : command.textureNames_)
+    {
+        if (textureName.Empty())
+            continue;
+        HashMap<StringHash, Texture*>::ConstIterator j = renderTargets_.Find(StringHash(textureName));
+        if (j != renderTargets_.End() && asyncComputeTextures_.Contains(j->second_))
+            return true;
+    }
+
+    return false;
 }
 
 bool View::IsNecessary(const RenderPathCommand& command)
 {
     return command.enabled_ && command.outputs_.Size() &&
-           (command.type_ != CMD_SCENEPASS || !batchQueues_[command.passIndex_].IsEmpty());
+           ((command.type_ != CMD_SCENEPASS && command.type_ != CMD_FORWARDCLUSTERED) ||
+               !batchQueues_[command.passIndex_].IsEmpty());
 }
 
 bool View::CheckViewportRead(const RenderPathCommand& command)
@@ -1975,7 +2900,7 @@ void View::AllocateScreenBuffers()
             hasPingpong = true;
         if (command.depthStencilName_.Length())
             hasCustomDepth = true;
-        if (!hasScenePassToRTs && command.type_ == CMD_SCENEPASS)
+        if (!hasScenePassToRTs && (command.type_ == CMD_SCENEPASS || command.type_ == CMD_FORWARDCLUSTERED))
         {
             for (unsigned j = 0; j < command.outputs_.Size(); ++j)
             {
@@ -2002,6 +2927,9 @@ void View::AllocateScreenBuffers()
     // If backbuffer is antialiased when using deferred rendering, need to reserve a buffer
     if (deferred_ && !renderTarget_ && graphics_->GetMultiSample() > 1)
         needSubstitute = true;
+    // A reduced resolution view renders to a buffer of its scaled size
+    if (upscale_)
+        needSubstitute = true;
     // If viewport is smaller than whole texture/backbuffer in deferred rendering, need to reserve a buffer, as the G-buffer
     // textures will be sized equal to the viewport
     if (viewSize_.x_ < rtSize_.x_ || viewSize_.y_ < rtSize_.y_)
@@ -2065,10 +2993,42 @@ void View::AllocateScreenBuffers()
     if (numViewportTextures == 1 && substituteRenderTarget_)
         viewportTextures_[1] = substituteRenderTarget_->GetParentTexture();
 
+    // Find the range of necessary commands using each rendertarget. Non-persistent rendertargets whose ranges do not overlap
+    // may share a screen buffer when their parameters match
+    const Vector<RenderTargetInfo>& rtInfos = renderPath_->renderTargets_;
+    PODVector<IntVector2> lifetimes(rtInfos.Size(), IntVector2(-1, -1));
+    if (renderer_->GetScreenBufferAliasing())
+    {
+        for (unsigned i = 0; i < renderPath_->commands_.Size(); ++i)
+        {
+            const RenderPathCommand& command = renderPath_->commands_[i];
+            if (!actualView->IsNecessary(command))
+                continue;
+
+            for (unsigned j = 0; j < command.outputs_.Size(); ++j)
+                ExtendRenderTargetLifetime(rtInfos, command.outputs_[j].first_, i, lifetimes);
+            ExtendRenderTargetLifetime(rtInfos, command.depthStencilName_, i, lifetimes);
+            for (unsigned j = 0; j < MAX_TEXTURE_UNITS; ++j)
+                ExtendRenderTargetLifetime(rtInfos, command.textureNames_[j], i, lifetimes);
+        }
+    }
+
+    // Allocate in the order of first use so that each screen buffer is handed to the next rendertarget that starts after
+    // the previous user has finished
+    SmallVector<unsigned, 16> allocationOrder(rtInfos.Size());
+    for (unsigned i = 0; i < rtInfos.Size(); ++i)
+        allocationOrder[i] = i;
+    Sort(allocationOrder.Begin(), allocationOrder.End(), [&lifetimes](unsigned lhs, unsigned rhs)
+        { return lifetimes[lhs].x_ < lifetimes[rhs].x_; });
+
+    SmallVector<ScreenBufferAlias, 16> aliases;
+    aliasedScreenBufferMemory_ = 0;
+
     // Allocate extra render targets defined by the render path
-    for (unsigned i = 0; i < renderPath_->renderTargets_.Size(); ++i)
+    for (unsigned i = 0; i < allocationOrder.Size(); ++i)
     {
-        const RenderTargetInfo& rtInfo = renderPath_->renderTargets_[i];
+        const RenderTargetInfo& rtInfo = rtInfos[allocationOrder[i]];
+        const IntVector2& lifetime = lifetimes[allocationOrder[i]];
         if (!rtInfo.enabled_)
             continue;
 
@@ -2089,11 +3049,39 @@ void View::AllocateScreenBuffers()
         auto intWidth = RoundToInt(width);
         auto intHeight = RoundToInt(height);
 
+        // Depth-stencil screen buffers are already shared by the renderer whenever the size matches
+        bool canAlias = lifetime.x_ >= 0 && !rtInfo.persistent_ && rtInfo.format_ != Graphics::GetDepthStencilFormat() &&
+            rtInfo.format_ != Graphics::GetReadableDepthFormat();
+        if (canAlias)
+        {
+            bool aliased = false;
+            for (unsigned j = 0; j < aliases.Size(); ++j)
+            {
+                ScreenBufferAlias& alias = aliases[j];
+                const RenderTargetInfo& aliasInfo = *alias.info_;
+                if (alias.lastUse_ < lifetime.x_ && alias.width_ == intWidth && alias.height_ == intHeight &&
+                    aliasInfo.format_ == rtInfo.format_ && aliasInfo.multiSample_ == rtInfo.multiSample_ &&
+                    aliasInfo.autoResolve_ == rtInfo.autoResolve_ && aliasInfo.cubemap_ == rtInfo.cubemap_ &&
+                    aliasInfo.filtered_ == rtInfo.filtered_ && aliasInfo.sRGB_ == rtInfo.sRGB_ && aliasInfo.compute_ == rtInfo.compute_)
+                {
+                    renderTargets_[rtInfo.name_] = alias.texture_;
+                    alias.lastUse_ = lifetime.y_;
+                    aliasedScreenBufferMemory_ += GetScreenBufferMemory(alias.texture_);
+                    aliased = true;
+                    break;
+                }
+            }
+            if (aliased)
+                continue;
+        }
+
         // If the rendertarget is persistent, key it with a hash derived from the RT name and the view's pointer
-        renderTargets_[rtInfo.name_] =
-            renderer_->GetScreenBuffer(intWidth, intHeight, rtInfo.format_, rtInfo.multiSample_, rtInfo.autoResolve_,
-                rtInfo.cubemap_, rtInfo.filtered_, rtInfo.sRGB_, rtInfo.persistent_ ? StringHash(rtInfo.name_).Value()
-                + (unsigned)(size_t)this : 0);
+        Texture* texture = renderer_->GetScreenBuffer(intWidth, intHeight, rtInfo.format_, rtInfo.multiSample_,
+            rtInfo.autoResolve_, rtInfo.cubemap_, rtInfo.filtered_, rtInfo.sRGB_, rtInfo.persistent_ ?
+            StringHash(rtInfo.name_).Value() + (unsigned)(size_t)this : 0, rtInfo.compute_);
+        renderTargets_[rtInfo.name_] = texture;
+        if (canAlias && texture)
+            aliases.Push(ScreenBufferAlias{&rtInfo, intWidth, intHeight, texture, lifetime.y_});
     }
 }
 
@@ -2127,8 +3115,19 @@ void View::BlitFramebuffer(Texture* source, RenderSurface* destination, bool dep
     graphics_->SetDepthStencil(GetDepthStencil(destination));
     graphics_->SetViewport(destRect);
 
-    static const char* shaderName = "CopyFramebuffer";
-    graphics_->SetShaders(graphics_->GetShader(VS, shaderName), graphics_->GetShader(PS, shaderName));
+    // A reduced resolution view is sharpened while upscaling it to the destination
+    if (upscale_ && destination == renderTarget_)
+    {
+        static const char* upscaleShaderName = "UpscaleFramebuffer";
+        static const StringHash sharpnessParam("Sharpness");
+        graphics_->SetShaders(graphics_->GetShader(VS, upscaleShaderName), graphics_->GetShader(PS, upscaleShaderName));
+        graphics_->SetShaderParameter(sharpnessParam, renderer_->GetUpscaleSharpness());
+    }
+    else
+    {
+        static const char* shaderName = "CopyFramebuffer";
+        graphics_->SetShaders(graphics_->GetShader(VS, shaderName), graphics_->GetShader(PS, shaderName));
+    }
 
     SetGBufferShaderParameters(srcSize, srcRect);
 
@@ -2136,6 +3135,48 @@ void View::BlitFramebuffer(Texture* source, RenderSurface* destination, bool dep
     DrawFullscreenQuad(true);
 }
 
+void View::RequestGPUOcclusionDepth()
+{
+    HashMap<StringHash, Texture*>::ConstIterator i = renderTargets_.Find(StringHash("depth"));
+    if (i == renderTargets_.End() || !i->second_ || i->second_->GetType() != Texture2D::GetTypeStatic() ||
+        i->second_->GetFormat() != Graphics::GetReadableDepthFormat())
+        return;
+
+    Texture* depthTexture = i->second_;
+    OcclusionBuffer* buffer = renderer_->GetGPUOcclusionReadbackBuffer(cullCamera_);
+    if (!buffer)
+        return;
+
+    URHO3D_PROFILE(RequestGPUOcclusionDepth);
+
+    // Reduce the depth to the occlusion buffer size, keeping the farthest depth of each covered block to stay conservative
+    IntVector2 size(buffer->GetWidth(), buffer->GetHeight());
+    auto* destination = static_cast<Texture2D*>(renderer_->GetScreenBuffer(size.x_, size.y_, Graphics::GetFloat32Format(), 1,
+        false, false, false, false));
+    if (!destination)
+        return;
+
+    graphics_->SetBlendMode(BLEND_REPLACE);
+    graphics_->SetDepthTest(CMP_ALWAYS);
+    graphics_->SetDepthWrite(false);
+    graphics_->SetRenderTarget(0, destination);
+    for (unsigned j = 1; j < MAX_RENDERTARGETS; ++j)
+        graphics_->SetRenderTarget(j, (RenderSurface*)nullptr);
+    graphics_->SetDepthStencil(renderer_->GetDepthStencil(size.x_, size.y_, 1, false));
+    graphics_->SetViewport(IntRect(0, 0, size.x_, size.y_));
+
+    static const char* shaderName = "GPUOcclusionDepth";
+    graphics_->SetShaders(graphics_->GetShader(VS, shaderName), graphics_->GetShader(PS, shaderName));
+
+    SetGBufferShaderParameters(size, IntRect(0, 0, size.x_, size.y_));
+
+    graphics_->SetTexture(TU_DEPTHBUFFER, depthTexture);
+    DrawFullscreenQuad(true);
+    graphics_->SetTexture(TU_DEPTHBUFFER, nullptr);
+
+    renderer_->RequestGPUOcclusionReadback(cullCamera_, destination);
+}
+
 void View::DrawFullscreenQuad(bool setIdentityProjection)
 {
     Geometry* geometry = renderer_->GetQuadGeometry();
@@ -2488,10 +3529,12 @@ bool View::IsShadowCasterVisible(Drawable* drawable, BoundingBox lightViewBox, C
     }
 }
 
-IntRect View::GetShadowMapViewport(Light* light, int splitIndex, Texture2D* shadowMap)
+IntRect View::GetShadowMapViewport(Light* light, int splitIndex, const IntRect& shadowMapRect)
 {
-    int width = shadowMap->GetWidth();
-    int height = shadowMap->GetHeight();
+    int x = shadowMapRect.left_;
+    int y = shadowMapRect.top_;
+    int width = shadowMapRect.Width();
+    int height = shadowMapRect.Height();
 
     switch (light->GetLightType())
     {
@@ -2499,20 +3542,20 @@ IntRect View::GetShadowMapViewport(Light* light, int splitIndex, Texture2D* shad
         {
             int numSplits = light->GetNumShadowSplits();
             if (numSplits == 1)
-                return {0, 0, width, height};
+                return shadowMapRect;
             else if (numSplits == 2)
-                return {splitIndex * width / 2, 0, (splitIndex + 1) * width / 2, height};
+                return {x + splitIndex * width / 2, y, x + (splitIndex + 1) * width / 2, y + height};
             else
-                return {(splitIndex & 1) * width / 2, (splitIndex / 2) * height / 2,
-                    ((splitIndex & 1) + 1) * width / 2, (splitIndex / 2 + 1) * height / 2};
+                return {x + (splitIndex & 1) * width / 2, y + (splitIndex / 2) * height / 2,
+                    x + ((splitIndex & 1) + 1) * width / 2, y + (splitIndex / 2 + 1) * height / 2};
         }
 
     case LIGHT_SPOT:
-        return {0, 0, width, height};
+        return shadowMapRect;
 
     case LIGHT_POINT:
-        return {(splitIndex & 1) * width / 2, (splitIndex / 2) * height / 3,
-            ((splitIndex & 1) + 1) * width / 2, (splitIndex / 2 + 1) * height / 3};
+        return {x + (splitIndex & 1) * width / 2, y + (splitIndex / 2) * height / 3,
+            x + ((splitIndex & 1) + 1) * width / 2, y + (splitIndex / 2 + 1) * height / 3};
     }
 
     return {};
@@ -2793,6 +3836,28 @@ void View::FindZone(Drawable* drawable)
     if (lastZone && (lastZone->GetViewMask() & cullCamera_->GetViewMask()) && lastZone->GetPriority() >= highestZonePriority_ &&
         (drawable->GetZoneMask() & lastZone->GetZoneMask()) && lastZone->IsInside(center))
         newZone = lastZone;
+    else if (!zoneGridStarts_.Empty())
+    {
+        // The grid cell's zones are sorted by descending priority, so the first match is the best
+        if (zoneGridBox_.IsInside(center) != OUTSIDE)
+        {
+            Vector3 cellPos = (center - zoneGridBox_.min_) * zoneGridInvCellSize_;
+            int x = Min((int)cellPos.x_, zoneGridSize_.x_ - 1);
+            int y = Min((int)cellPos.y_, zoneGridSize_.y_ - 1);
+            int z = Min((int)cellPos.z_, zoneGridSize_.z_ - 1);
+            unsigned cell = (unsigned)((z * zoneGridSize_.y_ + y) * zoneGridSize_.x_ + x);
+
+            for (unsigned i = zoneGridStarts_[cell]; i < zoneGridStarts_[cell + 1]; ++i)
+            {
+                Zone* zone = zoneGridZones_[i];
+                if ((drawable->GetZoneMask() & zone->GetZoneMask()) && zone->IsInside(center))
+                {
+                    newZone = zone;
+                    break;
+                }
+            }
+        }
+    }
     else
     {
         for (PODVector<Zone*>::Iterator i = zones_.Begin(); i != zones_.End(); ++i)
@@ -2810,6 +3875,95 @@ void View::FindZone(Drawable* drawable)
     drawable->SetZone(newZone, temporary);
 }
 
+void View::BuildZoneGrid()
+{
+    zoneGridZones_.Clear();
+    zoneGridStarts_.Clear();
+
+    if (zones_.Size() < ZONE_GRID_MIN_ZONES)
+        return;
+
+    URHO3D_PROFILE(BuildZoneGrid);
+
+    // Sort by descending priority. Equal priorities keep their visible zone order, so that lookups pick the same zone as a
+    // linear scan would
+    PODVector<unsigned> order(zones_.Size());
+    for (unsigned i = 0; i < order.Size(); ++i)
+        order[i] = i;
+    const PODVector<Zone*>& zones = zones_;
+    Sort(order.Begin(), order.End(), [&zones](unsigned lhs, unsigned rhs)
+    {
+        int lhsPriority = zones[lhs]->GetPriority();
+        int rhsPriority = zones[rhs]->GetPriority();
+        return lhsPriority != rhsPriority ? lhsPriority > rhsPriority : lhs < rhs;
+    });
+
+    zoneGridBox_.Clear();
+    for (PODVector<Zone*>::ConstIterator i = zones_.Begin(); i != zones_.End(); ++i)
+        zoneGridBox_.Merge((*i)->GetWorldBoundingBox());
+
+    // Size the cells so that there are a few per zone, while keeping flat or thin grids from degenerating
+    Vector3 size = zoneGridBox_.Size();
+    float minSize = Max(Max(size.x_, size.y_), size.z_) / ZONE_GRID_MAX_SIZE;
+    size = Vector3(Max(size.x_, minSize), Max(size.y_, minSize), Max(size.z_, minSize));
+    float cellSize = Pow(size.x_ * size.y_ * size.z_ / (float)(zones_.Size() * ZONE_GRID_CELLS_PER_ZONE), 1.0f / 3.0f);
+    if (!(cellSize > 0.0f))
+        return;
+
+    zoneGridSize_ = IntVector3(Clamp(CeilToInt(size.x_ / cellSize), 1, ZONE_GRID_MAX_SIZE),
+        Clamp(CeilToInt(size.y_ / cellSize), 1, ZONE_GRID_MAX_SIZE), Clamp(CeilToInt(size.z_ / cellSize), 1, ZONE_GRID_MAX_SIZE));
+    zoneGridBox_.max_ = zoneGridBox_.min_ + size;
+    zoneGridInvCellSize_ = Vector3((float)zoneGridSize_.x_ / size.x_, (float)zoneGridSize_.y_ / size.y_,
+        (float)zoneGridSize_.z_ / size.z_);
+    auto numCells = (unsigned)(zoneGridSize_.x_ * zoneGridSize_.y_ * zoneGridSize_.z_);
+
+    // Count the zones overlapping each cell, then fill the cells in priority order
+    PODVector<IntVector3> zoneMin(zones_.Size());
+    PODVector<IntVector3> zoneMax(zones_.Size());
+    zoneGridStarts_.Resize(numCells + 1);
+    for (unsigned i = 0; i <= numCells; ++i)
+        zoneGridStarts_[i] = 0;
+
+    for (unsigned i = 0; i < zones_.Size(); ++i)
+    {
+        const BoundingBox& box = zones_[i]->GetWorldBoundingBox();
+        Vector3 minPos = (box.min_ - zoneGridBox_.min_) * zoneGridInvCellSize_;
+        Vector3 maxPos = (box.max_ - zoneGridBox_.min_) * zoneGridInvCellSize_;
+        zoneMin[i] = IntVector3(Clamp((int)minPos.x_, 0, zoneGridSize_.x_ - 1), Clamp((int)minPos.y_, 0, zoneGridSize_.y_ - 1),
+            Clamp((int)minPos.z_, 0, zoneGridSize_.z_ - 1));
+        zoneMax[i] = IntVector3(Clamp((int)maxPos.x_, 0, zoneGridSize_.x_ - 1), Clamp((int)maxPos.y_, 0, zoneGridSize_.y_ - 1),
+            Clamp((int)maxPos.z_, 0, zoneGridSize_.z_ - 1));
+
+        for (int z = zoneMin[i].z_; z <= zoneMax[i].z_; ++z)
+        {
+            for (int y = zoneMin[i].y_; y <= zoneMax[i].y_; ++y)
+            {
+                for (int x = zoneMin[i].x_; x <= zoneMax[i].x_; ++x)
+                    ++zoneGridStarts_[(z * zoneGridSize_.y_ + y) * zoneGridSize_.x_ + x + 1];
+            }
+        }
+    }
+
+    for (unsigned i = 1; i <= numCells; ++i)
+        zoneGridStarts_[i] += zoneGridStarts_[i - 1];
+
+    zoneGridZones_.Resize(zoneGridStarts_[numCells]);
+    PODVector<unsigned> cellFill(zoneGridStarts_.Buffer(), numCells);
+
+    for (unsigned i = 0; i < order.Size(); ++i)
+    {
+        unsigned index = order[i];
+        for (int z = zoneMin[index].z_; z <= zoneMax[index].z_; ++z)
+        {
+            for (int y = zoneMin[index].y_; y <= zoneMax[index].y_; ++y)
+            {
+                for (int x = zoneMin[index].x_; x <= zoneMax[index].x_; ++x)
+                    zoneGridZones_[cellFill[(z * zoneGridSize_.y_ + y) * zoneGridSize_.x_ + x]++] = zones_[index];
+            }
+        }
+    }
+}
+
 Technique* View::GetTechnique(Drawable* drawable, Material* material)
 {
     if (!material)
@@ -2844,6 +3998,21 @@ Technique* View::GetTechnique(Drawable* drawable, Material* material)
     }
 }
 
+void View::RequestStreamedTextures(Material* material, float texels)
+{
+    const HashMap<TextureUnit, SharedPtr<Texture> >& textures = material->GetTextures();
+    for (HashMap<TextureUnit, SharedPtr<Texture> >::ConstIterator i = textures.Begin(); i != textures.End(); ++i)
+    {
+        Texture* texture = i->second_;
+        if (texture && texture->GetType() == Texture2D::GetTypeStatic())
+        {
+            auto* texture2D = static_cast<Texture2D*>(texture);
+            if (texture2D->GetStreaming())
+                texture2D->RequestStreamedResolution(texels, frame_.frameNumber_);
+        }
+    }
+}
+
 void View::CheckMaterialForAuxView(Material* material)
 {
     const HashMap<TextureUnit, SharedPtr<Texture> >& textures = material->GetTextures();
@@ -2882,6 +4051,9 @@ void View::SetQueueShaderDefines(BatchQueue& queue, const RenderPathCommand& com
 {
     String vsDefines = command.vertexShaderDefines_.Trimmed();
     String psDefines = command.pixelShaderDefines_.Trimmed();
+    // Clustered passes shade the clustered lights in the pixel shader
+    if (command.type_ == CMD_FORWARDCLUSTERED && clusteredLighting_)
+        psDefines = (psDefines + " CLUSTERED").Trimmed();
     if (vsDefines.Length() || psDefines.Length())
     {
         queue.hasExtraDefines_ = true;
@@ -2906,8 +4078,41 @@ void View::AddBatchToQueue(BatchQueue& queue, Batch& batch, Technique* tech, boo
     if (batch.geometryType_ == GEOM_INSTANCED)
     {
         BatchGroupKey key(batch);
+        FlatHashMap<BatchGroupKey, BatchGroup>::Iterator i = queue.batchGroups_.End();
+        unsigned textureIndex = 0;
+
+        // With bindless instancing, group materials that differ only by the diffuse texture and index it per instance.
+        // Fall back to a regular group if the materials turn out incompatible or the texture array is full
+        Texture* diffuseTexture = bindlessInstancing_ && batch.pass_->GetBindless() ? batch.material_->GetTexture(TU_DIFFUSE) : nullptr;
+        if (diffuseTexture && diffuseTexture->GetType() == Texture2D::GetTypeStatic())
+        {
+            BatchGroupKey bindlessKey(key);
+            bindlessKey.material_ = nullptr;
+            bindlessKey.bindlessHash_ = batch.material_->GetBindlessHash() | 1u;
+
+            i = queue.batchGroups_.Find(bindlessKey);
+            if (i == queue.batchGroups_.End())
+            {
+                BatchGroup newGroup(batch);
+                newGroup.geometryType_ = GEOM_STATIC;
+                newGroup.bindlessTextures_.Push(diffuseTexture);
+                renderer_->SetBatchShaders(newGroup, tech, allowShadows, queue);
+                newGroup.CalculateSortKey();
+                i = queue.AddBatchGroup(bindlessKey, newGroup);
+            }
+            else
+            {
+                textureIndex = i->second_.AddBindlessTexture(batch.material_, diffuseTexture);
+                if (textureIndex == M_MAX_UNSIGNED)
+                {
+                    i = queue.batchGroups_.End();
+                    textureIndex = 0;
+                }
+            }
+        }
 
-        HashMap<BatchGroupKey, BatchGroup>::Iterator i = queue.batchGroups_.Find(key);
+        if (i == queue.batchGroups_.End())
+            i = queue.batchGroups_.Find(key);
         if (i == queue.batchGroups_.End())
         {
             // Create a new group based on the batch
@@ -2916,16 +4121,19 @@ void View::AddBatchToQueue(BatchQueue& queue, Batch& batch, Technique* tech, boo
             newGroup.geometryType_ = GEOM_STATIC;
             renderer_->SetBatchShaders(newGroup, tech, allowShadows, queue);
             newGroup.CalculateSortKey();
-            i = queue.batchGroups_.Insert(MakePair(key, newGroup));
+            i = queue.AddBatchGroup(key, newGroup);
         }
 
         int oldSize = i->second_.instances_.Size();
-        i->second_.AddTransforms(batch);
+        i->second_.AddTransforms(batch, textureIndex);
         // Convert to using instancing shaders when the instancing limit is reached
         if (oldSize < minInstances_ && (int)i->second_.instances_.Size() >= minInstances_)
         {
             i->second_.geometryType_ = GEOM_INSTANCED;
             renderer_->SetBatchShaders(i->second_, tech, allowShadows, queue);
+            // Getting shader variations is not thread-safe, so worker threads leave it to SetBindlessGroupShaders()
+            if (!i->second_.bindlessTextures_.Empty() && !threadedBatches_)
+                renderer_->SetBindlessBatchShaders(i->second_);
             i->second_.CalculateSortKey();
         }
     }
@@ -2951,6 +4159,65 @@ void View::AddBatchToQueue(BatchQueue& queue, Batch& batch, Technique* tech, boo
     }
 }
 
+void View::MergeBatchQueue(BatchQueue& dest, BatchQueue& src)
+{
+    dest.batches_.Push(src.batches_);
+
+    for (FlatHashMap<BatchGroupKey, BatchGroup>::Iterator i = src.batchGroups_.Begin(); i != src.batchGroups_.End(); ++i)
+    {
+        BatchGroupKey key = i->first_;
+        BatchGroup& srcGroup = i->second_;
+
+        // If a bindless group can not take the textures, probe for another bindless group key
+        FlatHashMap<BatchGroupKey, BatchGroup>::Iterator j = dest.batchGroups_.Find(key);
+        while (j != dest.batchGroups_.End() && !srcGroup.bindlessTextures_.Empty() && !j->second_.MergeBindlessTextures(srcGroup))
+        {
+            key.bindlessHash_ = (key.bindlessHash_ * 31) | 1u;
+            j = dest.batchGroups_.Find(key);
+        }
+
+        if (j == dest.batchGroups_.End())
+        {
+            dest.AddBatchGroup(key, srcGroup)->second_.instances_.Push(srcGroup.instances_);
+            continue;
+        }
+
+        BatchGroup& destGroup = j->second_;
+        destGroup.instances_.Push(srcGroup.instances_);
+
+        // Convert to using instancing shaders when the combined instances reach the instancing limit
+        if (destGroup.geometryType_ != GEOM_INSTANCED)
+        {
+            if (srcGroup.geometryType_ == GEOM_INSTANCED)
+            {
+                destGroup.geometryType_ = GEOM_INSTANCED;
+                destGroup.vertexShader_ = srcGroup.vertexShader_;
+                destGroup.pixelShader_ = srcGroup.pixelShader_;
+                destGroup.CalculateSortKey();
+            }
+            else if ((int)destGroup.instances_.Size() >= minInstances_)
+            {
+                destGroup.geometryType_ = GEOM_INSTANCED;
+                renderer_->SetBatchShaders(destGroup, nullptr, true, dest);
+                destGroup.CalculateSortKey();
+            }
+        }
+    }
+}
+
+void View::SetBindlessGroupShaders(BatchQueue& queue)
+{
+    for (FlatHashMap<BatchGroupKey, BatchGroup>::Iterator i = queue.batchGroups_.Begin(); i != queue.batchGroups_.End(); ++i)
+    {
+        BatchGroup& group = i->second_;
+        if (!group.bindlessTextures_.Empty() && group.geometryType_ == GEOM_INSTANCED)
+        {
+            renderer_->SetBindlessBatchShaders(group);
+            group.CalculateSortKey();
+        }
+    }
+}
+
 void View::PrepareInstancingBuffer()
 {
     // Prepare instancing buffer from the source view
@@ -2971,28 +4238,42 @@ void View::PrepareInstancingBuffer()
     for (Vector<LightBatchQueue>::Iterator i = lightQueues_.Begin(); i != lightQueues_.End(); ++i)
     {
         for (unsigned j = 0; j < i->shadowSplits_.Size(); ++j)
+        {
             totalInstances += i->shadowSplits_[j].shadowBatches_.GetNumInstances();
+            totalInstances += i->shadowSplits_[j].staticShadowBatches_.GetNumInstances();
+        }
         totalInstances += i->litBaseBatches_.GetNumInstances();
         totalInstances += i->litBatches_.GetNumInstances();
     }
 
-    if (!totalInstances || !renderer_->ResizeInstancingBuffer(totalInstances))
+    // Take a range of this frame's instancing buffer. If it does not fit, the batches are drawn without instancing
+    // on this frame and the buffer grows on the next
+    if (!totalInstances)
+        return;
+    unsigned freeIndex = renderer_->AllocateInstancingBuffer(totalInstances);
+    if (freeIndex == M_MAX_UNSIGNED)
         return;
 
+    // Only the first range of the frame discards, later views append without overwriting the ranges in flight
     VertexBuffer* instancingBuffer = renderer_->GetInstancingBuffer();
-    unsigned freeIndex = 0;
-    void* dest = instancingBuffer->Lock(0, totalInstances, true);
+    unsigned char* dest = static_cast<unsigned char*>(instancingBuffer->Lock(freeIndex, totalInstances, freeIndex == 0));
     if (!dest)
         return;
 
+    // SetInstancingData() addresses the buffer from its start
     const unsigned stride = instancingBuffer->GetVertexSize();
+    dest -= freeIndex * stride;
+
     for (HashMap<unsigned, BatchQueue>::Iterator i = batchQueues_.Begin(); i != batchQueues_.End(); ++i)
         i->second_.SetInstancingData(dest, stride, freeIndex);
 
     for (Vector<LightBatchQueue>::Iterator i = lightQueues_.Begin(); i != lightQueues_.End(); ++i)
     {
         for (unsigned j = 0; j < i->shadowSplits_.Size(); ++j)
+        {
             i->shadowSplits_[j].shadowBatches_.SetInstancingData(dest, stride, freeIndex);
+            i->shadowSplits_[j].staticShadowBatches_.SetInstancingData(dest, stride, freeIndex);
+        }
         i->litBaseBatches_.SetInstancingData(dest, stride, freeIndex);
         i->litBatches_.SetInstancingData(dest, stride, freeIndex);
     }
@@ -3060,6 +4341,10 @@ void View::RenderShadowMap(const LightBatchQueue& queue)
 {
     URHO3D_PROFILE(RenderShadowMap);
 
+    bool gpuTiming = graphics_->GetGPUProfiling();
+    if (gpuTiming)
+        graphics_->BeginGPUTiming("shadowmap");
+
     Texture2D* shadowMap = queue.shadowMap_;
     graphics_->SetTexture(TU_SHADOWMAP, nullptr);
 
@@ -3070,17 +4355,42 @@ void View::RenderShadowMap(const LightBatchQueue& queue)
     // Set shadow depth bias
     BiasParameters parameters = queue.light_->GetShadowBias();
 
+    // Check whether static caster depth can be taken from the cache, and whether any split needs to update it
+    ShadowMapCache* cache = shadowMap->GetUsage() == TEXTURE_DEPTHSTENCIL ? queue.shadowCache_ : nullptr;
+    bool useCache = false;
+    bool updateCache = false;
+    if (cache)
+    {
+        for (unsigned i = 0; i < queue.shadowSplits_.Size(); ++i)
+        {
+            if (cache->splitHashes_[i])
+                useCache = true;
+            if (queue.shadowSplits_[i].renderStatic_)
+                updateCache = true;
+        }
+    }
+
     // The shadow map is a depth stencil texture
     if (shadowMap->GetUsage() == TEXTURE_DEPTHSTENCIL)
     {
+        if (useCache)
+        {
+            useCache = graphics_->CopyTexture(shadowMap, cache->texture_);
+            // If the copy failed, unchanged splits lack their static casters this frame, so re-render them on the next
+            if (!useCache)
+                cache->splitHashes_.Clear();
+        }
+
         graphics_->SetColorWrite(false);
         graphics_->SetDepthStencil(shadowMap);
         graphics_->SetRenderTarget(0, shadowMap->GetRenderSurface()->GetLinkedRenderTarget());
         // Disable other render targets
         for (unsigned i = 1; i < MAX_RENDERTARGETS; ++i)
             graphics_->SetRenderTarget(i, (RenderSurface*) nullptr);
-        graphics_->SetViewport(IntRect(0, 0, shadowMap->GetWidth(), shadowMap->GetHeight()));
-        graphics_->Clear(CLEAR_DEPTH);
+        // Clear only the light's own region, as an atlas tile's neighbours may belong to already rendered lights
+        graphics_->SetViewport(queue.shadowMapRect_);
+        if (!useCache)
+            graphics_->Clear(CLEAR_DEPTH);
     }
     else // if the shadow map is a color rendertarget
     {
@@ -3091,41 +4401,66 @@ void View::RenderShadowMap(const LightBatchQueue& queue)
             graphics_->SetRenderTarget(i, (RenderSurface*) nullptr);
         graphics_->SetDepthStencil(renderer_->GetDepthStencil(shadowMap->GetWidth(), shadowMap->GetHeight(),
             shadowMap->GetMultiSample(), shadowMap->GetAutoResolve()));
-        graphics_->SetViewport(IntRect(0, 0, shadowMap->GetWidth(), shadowMap->GetHeight()));
+        graphics_->SetViewport(queue.shadowMapRect_);
         graphics_->Clear(CLEAR_DEPTH | CLEAR_COLOR, Color::WHITE);
 
         parameters = BiasParameters(0.0f, 0.0f);
     }
 
-    // Render each of the splits
-    for (unsigned i = 0; i < queue.shadowSplits_.Size(); ++i)
+    // Render the static casters of changed splits and store the result to the cache before adding dynamic casters
+    if (updateCache)
     {
-        const ShadowBatchQueue& shadowQueue = queue.shadowSplits_[i];
+        for (unsigned i = 0; i < queue.shadowSplits_.Size(); ++i)
+        {
+            const ShadowBatchQueue& shadowQueue = queue.shadowSplits_[i];
+            if (!shadowQueue.renderStatic_)
+                continue;
+
+            graphics_->SetViewport(shadowQueue.shadowViewport_);
+            // The cached depth of the split is stale, so clear it
+            if (useCache)
+            {
+                graphics_->SetDepthBias(0.0f, 0.0f);
+                graphics_->Clear(CLEAR_DEPTH);
+            }
+
+            if (!shadowQueue.staticShadowBatches_.IsEmpty())
+            {
+                if (gpuTiming)
+                    graphics_->BeginGPUTiming("static split " + String(i));
+                SetShadowSplitDepthBias(graphics_, renderer_, queue, i, parameters);
+                shadowQueue.staticShadowBatches_.Draw(this, shadowQueue.shadowCamera_, false, false, true);
+                if (gpuTiming)
+                    graphics_->EndGPUTiming();
+            }
+        }
 
-        float multiplier = 1.0f;
-        // For directional light cascade splits, adjust depth bias according to the far clip ratio of the splits
-        if (i > 0 && queue.light_->GetLightType() == LIGHT_DIRECTIONAL)
+        // The shadow map is rebound automatically on the next draw
+        if (graphics_->CopyTexture(cache->texture_, shadowMap) && cache->splitHashes_.Size())
         {
-            multiplier =
-                Max(shadowQueue.shadowCamera_->GetFarClip() / queue.shadowSplits_[0].shadowCamera_->GetFarClip(), 1.0f);
-            multiplier = 1.0f + (multiplier - 1.0f) * queue.light_->GetShadowCascade().biasAutoAdjust_;
-            // Quantize multiplier to prevent creation of too many rasterizer states on D3D11
-            multiplier = (int)(multiplier * 10.0f) / 10.0f;
+            for (unsigned i = 0; i < queue.shadowSplits_.Size(); ++i)
+            {
+                if (queue.shadowSplits_[i].renderStatic_)
+                    cache->splitHashes_[i] = queue.shadowSplits_[i].staticHash_;
+            }
         }
+    }
 
-        // Perform further modification of depth bias on OpenGL ES, as shadow calculations' precision is limited
-        float addition = 0.0f;
-#ifdef GL_ES_VERSION_2_0
-        multiplier *= renderer_->GetMobileShadowBiasMul();
-        addition = renderer_->GetMobileShadowBiasAdd();
-#endif
+    // Render each of the splits
+    for (unsigned i = 0; i < queue.shadowSplits_.Size(); ++i)
+    {
+        const ShadowBatchQueue& shadowQueue = queue.shadowSplits_[i];
 
-        graphics_->SetDepthBias(multiplier * parameters.constantBias_ + addition, multiplier * parameters.slopeScaledBias_);
+        SetShadowSplitDepthBias(graphics_, renderer_, queue, i, parameters);
 
         if (!shadowQueue.shadowBatches_.IsEmpty())
         {
+            if (gpuTiming)
+                graphics_->BeginGPUTiming("split " + String(i));
             graphics_->SetViewport(shadowQueue.shadowViewport_);
             shadowQueue.shadowBatches_.Draw(this, shadowQueue.shadowCamera_, false, false, true);
+            if (gpuTiming)
+                graphics_->EndGPUTiming();
         }
     }
 
@@ -3136,6 +4471,9 @@ void View::RenderShadowMap(const LightBatchQueue& queue)
     // reset some parameters
     graphics_->SetColorWrite(true);
     graphics_->SetDepthBias(0.0f, 0.0f);
+
+    if (gpuTiming)
+        graphics_->EndGPUTiming();
 }
 
 RenderSurface* View::GetDepthStencil(RenderSurface* renderTarget)
@@ -24,6 +24,7 @@
 
 #include "../Container/HashSet.h"
 #include "../Container/List.h"
+#include "../Core/Mutex.h"
 #include "../Core/Object.h"
 #include "../Graphics/Batch.h"
 #include "../Graphics/Light.h"
@@ -104,6 +105,57 @@ struct PerThreadSceneResult
     float maxZ_;
 };
 
+/// Batches collected in a worker thread from a range of geometries or from one light. Merged to the view's queues afterward.
+struct PerThreadBatchResult
+{
+    /// Batch queues. Indexed like the scene passes for base batches, or holds only the alpha queue for light batches.
+    Vector<BatchQueue> batchQueues_;
+    /// Geometry objects that will be updated in the main thread.
+    PODVector<Drawable*> nonThreadedGeometries_;
+    /// Geometry objects that will be updated in worker threads.
+    PODVector<Drawable*> threadedGeometries_;
+    /// Materials to check for auxiliary views in the main thread.
+    PODVector<Material*> auxViewMaterials_;
+    /// Materials and the texel resolution they are viewed at, to request streamed textures for in the main thread.
+    PODVector<Pair<Material*, float> > streamedMaterials_;
+    /// Start index of the geometry range.
+    unsigned start_{};
+    /// End index of the geometry range.
+    unsigned end_{};
+    /// Light query for light batches.
+    LightQueryResult* lightQuery_{};
+    /// Light queue for light batches.
+    LightBatchQueue* lightQueue_{};
+    /// Set when a pass had no loaded shaders. The batches must then be collected again in the main thread.
+    bool shadersMissing_{};
+};
+
+/// Screen tile and depth slice range of a clustered light.
+struct LightClusterBounds
+{
+    /// Light index in the clustered light data.
+    unsigned lightIndex_;
+    /// Screen tile range, inclusive.
+    IntRect tiles_;
+    /// First depth slice.
+    int minSlice_;
+    /// Last depth slice.
+    int maxSlice_;
+};
+
+/// Light lists of one depth slice of the clustered light grid. Built in a worker thread.
+struct LightClusterSlice
+{
+    /// Depth slice index.
+    unsigned slice_{};
+    /// Lights that touch the slice.
+    PODVector<const LightClusterBounds*> lights_;
+    /// Light index offset and count pairs of the slice's clusters. The offsets are relative to the slice.
+    PODVector<unsigned> clusters_;
+    /// Light indices of the slice's clusters.
+    PODVector<unsigned> lightIndices_;
+};
+
 static const unsigned MAX_VIEWPORT_TEXTURES = 2;
 
 /// Internal structure for 3D rendering work. Created for each backbuffer and texture viewport, but not for shadow cameras.
@@ -111,6 +163,9 @@ class URHO3D_API View : public Object
 {
     friend void CheckVisibilityWork(const WorkItem* item, unsigned threadIndex);
     friend void ProcessLightWork(const WorkItem* item, unsigned threadIndex);
+    friend void GetLightBatchesWork(const WorkItem* item, unsigned threadIndex);
+    friend void GetBaseBatchesWork(const WorkItem* item, unsigned threadIndex);
+    friend void BuildLightClusterSliceWork(const WorkItem* item, unsigned threadIndex);
 
     URHO3D_OBJECT(View, Object);
 
@@ -156,7 +211,7 @@ public:
     /// Return view rectangle.
     const IntRect& GetViewRect() const { return viewRect_; }
 
-    /// Return view dimensions.
+    /// Return view dimensions. Smaller than the view rectangle when rendering at a reduced resolution scale.
     const IntVector2& GetViewSize() const { return viewSize_; }
 
     /// Return geometry objects.
@@ -177,6 +232,9 @@ public:
     /// Return number of occluders that were actually rendered. Occluders may be rejected if running out of triangles or if behind other occluders.
     unsigned GetNumActiveOccluders() const { return activeOccluders_; }
 
+    /// Return estimated screen buffer memory in bytes saved by sharing rendertargets with non-overlapping lifetimes.
+    unsigned GetAliasedScreenBufferMemory() const { return aliasedScreenBufferMemory_; }
+
     /// Return the source view that was already prepared. Used when viewports specify the same culling camera.
     View* GetSourceView() const;
 
@@ -206,10 +264,26 @@ private:
     void GetLightBatches();
     /// Get unlit batches.
     void GetBaseBatches();
+    /// Return whether a light is shaded by the clustered scene passes instead of its own light queue.
+    bool IsClusteredLight(const LightQueryResult& query) const;
+    /// Build the light lists of the clustered light grid for the clustered lights.
+    void BuildLightClusters();
+    /// Build the light lists of one depth slice of the clustered light grid.
+    void BuildLightClusterSlice(LightClusterSlice& slice);
+    /// Set the clustered light grid shader parameters for the current viewport.
+    void SetClusterShaderParameters(Camera* camera);
     /// Update geometries and sort batches.
     void UpdateGeometries();
-    /// Get pixel lit batches for a certain light and drawable.
-    void GetLitBatches(Drawable* drawable, LightBatchQueue& lightQueue, BatchQueue* alphaQueue);
+    /// Get pixel lit batches for a certain light and drawable. The result is given when called from a worker thread.
+    void GetLitBatches(Drawable* drawable, LightBatchQueue& lightQueue, BatchQueue* alphaQueue, PerThreadBatchResult* result = nullptr);
+    /// Get shadow caster and lit batches for a light. The result is given when called from a worker thread.
+    void CollectLightBatches(LightQueryResult& query, LightBatchQueue& lightQueue, BatchQueue* alphaQueue, PerThreadBatchResult* result);
+    /// Get unlit batches for a range of geometries. The result is given when called from a worker thread.
+    void CollectBaseBatches(unsigned start, unsigned end, PerThreadBatchResult* result);
+    /// Merge a batch queue collected in a worker thread to a view batch queue.
+    void MergeBatchQueue(BatchQueue& dest, BatchQueue& src);
+    /// Switch instanced bindless batch groups to bindless shaders after they were collected in worker threads.
+    void SetBindlessGroupShaders(BatchQueue& queue);
     /// Execute render commands.
     void ExecuteRenderPathCommands();
     /// Set rendertargets for current render command.
@@ -218,6 +292,12 @@ private:
     bool SetTextures(RenderPathCommand& command);
     /// Perform a quad rendering command.
     void RenderQuad(RenderPathCommand& command);
+    /// Shade the clustered lights from the G-buffer in one fullscreen pass.
+    void RenderClusteredLights(const RenderPathCommand& command);
+    /// Perform a compute command.
+    void RunCompute(RenderPathCommand& command);
+    /// Check if a command reads or writes a texture that async compute work may still be using.
+    bool CheckAsyncComputeAccess(const RenderPathCommand& command);
     /// Check if a command is enabled and has content to render. To be called only after render update has completed for the frame.
     bool IsNecessary(const RenderPathCommand& command);
     /// Check if a command reads the destination render target.
@@ -230,6 +310,8 @@ private:
     void AllocateScreenBuffers();
     /// Blit the viewport from one surface to another.
     void BlitFramebuffer(Texture* source, RenderSurface* destination, bool depthWrite);
+    /// Downsample the view's readable depth and request its readback for GPU occlusion culling on later frames.
+    void RequestGPUOcclusionDepth();
     /// Query for occluders as seen from a camera.
     void UpdateOccluders(PODVector<Drawable*>& occluders, Camera* camera);
     /// Draw occluders to occlusion buffer.
@@ -252,13 +334,17 @@ private:
     bool IsShadowCasterVisible(Drawable* drawable, BoundingBox lightViewBox, Camera* shadowCamera, const Matrix3x4& lightView,
         const Frustum& lightViewFrustum, const BoundingBox& lightViewFrustumBox);
     /// Return the viewport for a shadow map split.
-    IntRect GetShadowMapViewport(Light* light, int splitIndex, Texture2D* shadowMap);
+    IntRect GetShadowMapViewport(Light* light, int splitIndex, const IntRect& shadowMapRect);
+    /// Build the zone lookup grid over the visible zones' bounding boxes, if there are enough zones to benefit.
+    void BuildZoneGrid();
     /// Find and set a new zone for a drawable when it has moved.
     void FindZone(Drawable* drawable);
     /// Return material technique, considering the drawable's LOD distance.
     Technique* GetTechnique(Drawable* drawable, Material* material);
     /// Check if material should render an auxiliary view (if it has a camera attached).
     void CheckMaterialForAuxView(Material* material);
+    /// Request the resolution a material's streamed textures are viewed at.
+    void RequestStreamedTextures(Material* material, float texels);
     /// Set shader defines for a batch queue if used.
     void SetQueueShaderDefines(BatchQueue& queue, const RenderPathCommand& command);
     /// Choose shaders for a batch and add it to queue.
@@ -328,6 +414,8 @@ private:
     Zone* farClipZone_{};
     /// Occlusion buffer for the main camera.
     OcclusionBuffer* occlusionBuffer_{};
+    /// Occlusion buffer built from the main camera's GPU depth on a previous frame.
+    OcclusionBuffer* gpuOcclusionBuffer_{};
     /// Destination color rendertarget.
     RenderSurface* renderTarget_{};
     /// Substitute rendertarget for deferred rendering. Allocated if necessary.
@@ -340,11 +428,13 @@ private:
     RenderSurface* lastCustomDepthSurface_{};
     /// Texture containing the latest viewport texture.
     Texture* currentViewportTexture_{};
+    /// Textures read or written by the async compute work dispatched during the current renderpath command sequence.
+    PODVector<Texture*> asyncComputeTextures_;
     /// Dummy texture for D3D9 depth only rendering.
     Texture* depthOnlyDummyTexture_{};
     /// Viewport rectangle.
     IntRect viewRect_;
-    /// Viewport size.
+    /// Rendered viewport size.
     IntVector2 viewSize_;
     /// Destination rendertarget size.
     IntVector2 rtSize_;
@@ -356,6 +446,8 @@ private:
     float minZ_{};
     /// Maximum Z value of the visible scene.
     float maxZ_{};
+    /// Texels per world unit at unit distance for streamed texture resolution requests. Zero when no textures are streamed.
+    float streamingTexelScale_{};
     /// Material quality level.
     int materialQuality_{};
     /// Maximum number of occluder triangles.
@@ -370,7 +462,13 @@ private:
     bool cameraZoneOverride_{};
     /// Draw shadows flag.
     bool drawShadows_{};
-    /// Deferred flag. Inferred from the existence of a light volume command in the renderpath.
+    /// Bindless instancing flag.
+    bool bindlessInstancing_{};
+    /// Batches are being collected in worker threads flag.
+    bool threadedBatches_{};
+    /// Clustered lighting flag. Inferred from the existence of a forwardclustered or deferredclustered command in the renderpath.
+    bool clusteredLighting_{};
+    /// Deferred flag. Inferred from the existence of a light volume or deferredclustered command in the renderpath.
     bool deferred_{};
     /// Deferred ambient pass flag. This means that the destination rendertarget is being written to at the same time as albedo/normal/depth buffers, and needs to be RGBA on OpenGL.
     bool deferredAmbient_{};
@@ -388,8 +486,22 @@ private:
     Vector<PODVector<Drawable*> > tempDrawables_;
     /// Per-thread geometries, lights and Z range collection results.
     Vector<PerThreadSceneResult> sceneResults_;
+    /// Per-work item batch collection results.
+    Vector<PerThreadBatchResult> batchResults_;
+    /// Mutex for vertex light processing during threaded batch collection.
+    Mutex batchMutex_;
     /// Visible zones.
     PODVector<Zone*> zones_;
+    /// Visible zones overlapping each zone lookup grid cell, sorted by descending priority.
+    PODVector<Zone*> zoneGridZones_;
+    /// Index of each zone lookup grid cell's first zone, with an end index after the last cell. Empty when the grid is not in use.
+    PODVector<unsigned> zoneGridStarts_;
+    /// Zone lookup grid bounds.
+    BoundingBox zoneGridBox_;
+    /// Inverse of the zone lookup grid cell size.
+    Vector3 zoneGridInvCellSize_;
+    /// Zone lookup grid cell counts.
+    IntVector3 zoneGridSize_;
     /// Visible geometry objects.
     PODVector<Drawable*> geometries_;
     /// Geometry objects that will be updated in the main thread.
@@ -402,6 +514,8 @@ private:
     PODVector<Light*> lights_;
     /// Number of active occluders.
     unsigned activeOccluders_{};
+    /// Estimated screen buffer memory saved by rendertarget aliasing.
+    unsigned aliasedScreenBufferMemory_{};
 
     /// Drawables that limit their maximum light count.
     HashSet<Drawable*> maxLightsDrawables_;
@@ -413,6 +527,18 @@ private:
     PODVector<ScenePassInfo> scenePasses_;
     /// Per-pixel light queues.
     Vector<LightBatchQueue> lightQueues_;
+    /// Lights shaded by the clustered scene passes.
+    PODVector<Light*> clusteredLights_;
+    /// Screen tile and depth slice ranges of the clustered lights.
+    PODVector<LightClusterBounds> clusterLightBounds_;
+    /// Per-slice clustered light grid build results.
+    Vector<LightClusterSlice> clusterSlices_;
+    /// Clustered light data, CLUSTER_LIGHT_VECTORS vectors per light.
+    PODVector<Vector4> clusterLightData_;
+    /// Light index offset and count pairs of all clusters.
+    PODVector<unsigned> clusters_;
+    /// Light indices of all clusters.
+    PODVector<unsigned> clusterLightIndices_;
     /// Per-vertex light queues.
     HashMap<unsigned long long, LightBatchQueue> vertexLightQueues_;
     /// Batch queues by pass index.
@@ -437,6 +563,8 @@ private:
     const RenderPathCommand* passCommand_{};
     /// Flag for scene being resolved from the backbuffer.
     bool usedResolve_{};
+    /// Flag for rendering at a reduced resolution scale and upscaling to the viewport at the end.
+    bool upscale_{};
 };
 
 }
@@ -157,6 +157,10 @@ unsigned int IKEffector::GetChainLength() const
 // ----------------------------------------------------------------------------
 void IKEffector::SetChainLength(unsigned chainLength)
 {
+    // Changing the chain length requires the solver's chain trees to be rebuilt, so keep them if nothing changes
+    if (chainLength == chainLength_)
+        return;
+
     chainLength_ = chainLength;
     if (ikEffectorNode_ != nullptr)
     {
@@ -188,7 +192,11 @@ float IKEffector::GetRotationWeight() const
 // ----------------------------------------------------------------------------
 void IKEffector::SetRotationWeight(float weight)
 {
-    rotationWeight_ = Clamp(weight, 0.0f, 1.0f);
+    weight = Clamp(weight, 0.0f, 1.0f);
+    if (weight == rotationWeight_)
+        return;
+
+    rotationWeight_ = weight;
     if (ikEffectorNode_ != nullptr)
     {
         ikEffectorNode_->rotation_weight = rotationWeight_;
@@ -205,7 +213,11 @@ float IKEffector::GetRotationDecay() const
 // ----------------------------------------------------------------------------
 void IKEffector::SetRotationDecay(float decay)
 {
-    rotationDecay_ = Clamp(decay, 0.0f, 1.0f);
+    decay = Clamp(decay, 0.0f, 1.0f);
+    if (decay == rotationDecay_)
+        return;
+
+    rotationDecay_ = decay;
     if (ikEffectorNode_ != nullptr)
     {
         ikEffectorNode_->effector->rotation_decay = rotationDecay_;
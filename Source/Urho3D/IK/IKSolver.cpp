@@ -21,6 +21,7 @@
 //
 
 #include "../IK/IKSolver.h"
+#include "../IK/IKSolverBatch.h"
 #include "../IK/IKConstraint.h"
 #include "../IK/IKEvents.h"
 #include "../IK/IKEffector.h"
@@ -72,6 +73,10 @@ IKSolver::~IKSolver()
     for (PODVector<IKEffector*>::ConstIterator it = effectorList_.Begin(); it != effectorList_.End(); ++it)
         (*it)->SetIKEffectorNode(nullptr);
 
+    auto* batch = GetSubsystem<IKSolverBatch>();
+    if (batch != nullptr)
+        batch->RemoveSolver(this);
+
     ik_solver_destroy(solver_);
     context_->ReleaseIK();
 }
@@ -170,23 +175,15 @@ void IKSolver::SetFeature(Feature feature, bool enable)
                 solver_->flags |= SOLVER_CALCULATE_TARGET_ROTATIONS;
         } break;
 
-        case AUTO_SOLVE:
-        {
-            if (((features_ & AUTO_SOLVE) != 0) == enable)
-                break;
-
-            if (enable)
-                SubscribeToEvent(GetScene(), E_SCENEDRAWABLEUPDATEFINISHED, URHO3D_HANDLER(IKSolver, HandleSceneDrawableUpdateFinished));
-            else
-                UnsubscribeFromEvent(GetScene(), E_SCENEDRAWABLEUPDATEFINISHED);
-        } break;
-
         default: break;
     }
 
     features_ &= ~feature;
     if (enable)
         features_ |= feature;
+
+    if (feature == AUTO_SOLVE)
+        UpdateAutoSolve();
 }
 
 // ----------------------------------------------------------------------------
@@ -400,6 +397,16 @@ void IKSolver::Solve()
 {
     URHO3D_PROFILE(IKSolve);
 
+    if (BeginSolve() == false)
+        return;
+
+    SolveTree();
+    EndSolve();
+}
+
+// ----------------------------------------------------------------------------
+bool IKSolver::BeginSolve()
+{
     if (treeNeedsRebuild)
         RebuildTree();
 
@@ -407,7 +414,7 @@ void IKSolver::Solve()
         RebuildChainTrees();
 
     if (IsSolverTreeValid() == false)
-        return;
+        return false;
 
     if (features_ & UPDATE_ORIGINAL_POSE)
         ApplySceneToOriginalPose();
@@ -423,11 +430,21 @@ void IKSolver::Solve()
         (*it)->UpdateTargetNodePosition();
     }
 
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void IKSolver::SolveTree()
+{
     ik_solver_solve(solver_);
 
     if (features_ & JOINT_ROTATIONS)
         ik_solver_calculate_joint_rotations(solver_);
+}
 
+// ----------------------------------------------------------------------------
+void IKSolver::EndSolve()
+{
     ApplyActivePoseToScene();
 }
 
@@ -518,8 +535,22 @@ bool IKSolver::IsSolverTreeValid() const
 // ----------------------------------------------------------------------------
 void IKSolver::OnSceneSet(Scene* scene)
 {
-    if (features_ & AUTO_SOLVE)
-        SubscribeToEvent(scene, E_SCENEDRAWABLEUPDATEFINISHED, URHO3D_HANDLER(IKSolver, HandleSceneDrawableUpdateFinished));
+    UpdateAutoSolve();
+}
+
+// ----------------------------------------------------------------------------
+void IKSolver::UpdateAutoSolve()
+{
+    auto* batch = GetSubsystem<IKSolverBatch>();
+    if ((features_ & AUTO_SOLVE) && GetScene() != nullptr)
+    {
+        // The batch is created on demand, as applications without IK do not need it
+        if (batch == nullptr)
+            batch = context_->RegisterSubsystem<IKSolverBatch>();
+        batch->AddSolver(this);
+    }
+    else if (batch != nullptr)
+        batch->RemoveSolver(this);
 }
 
 // ----------------------------------------------------------------------------
@@ -719,12 +750,6 @@ void IKSolver::HandleNodeRemoved(StringHash eventType, VariantMap& eventData)
     }
 }
 
-// ----------------------------------------------------------------------------
-void IKSolver::HandleSceneDrawableUpdateFinished(StringHash eventType, VariantMap& eventData)
-{
-    Solve();
-}
-
 // ----------------------------------------------------------------------------
 void IKSolver::DrawDebugGeometry(bool depthTest)
 {
@@ -158,9 +158,10 @@ public:
 
         /*!
          * Mostly exists because of the editor. When enabled, the solver
-         * will be invoked automatically for you. If you need to do additional
-         * calculations before being able to set the effector target data, you will
-         * want to disable this and call Solve() manually.
+         * will be invoked automatically for you, together with the other
+         * auto-solving solvers of the scene (see IKSolverBatch). If you need to
+         * do additional calculations before being able to set the effector
+         * target data, you will want to disable this and call Solve() manually.
          */
         AUTO_SOLVE = 0x40
     };
@@ -278,6 +279,30 @@ public:
      */
     void Solve();
 
+    /*!
+     * @brief First step of Solve(). Rebuilds the tree and chains if needed
+     * and reads the poses and effector targets from the scene graph. Must be
+     * called from the main thread.
+     * @return False if the tree is not valid and can't be solved.
+     * @nobind
+     */
+    bool BeginSolve();
+
+    /*!
+     * @brief Second step of Solve(). Runs the solver algorithm on the tree. Only
+     * touches the solver's own tree, so different solvers can solve in
+     * parallel from worker threads.
+     * @nobind
+     */
+    void SolveTree();
+
+    /*!
+     * @brief Last step of Solve(). Applies the solution back to the scene
+     * graph. Must be called from the main thread.
+     * @nobind
+     */
+    void EndSolve();
+
     /*!
      * Copies the original pose into the scene graph. This will reset the pose
      * to whatever state it had when the IKSolver component was first created,
@@ -327,7 +352,7 @@ private:
     /// Returns false if calling Solve() would cause the IK library to abort. Urho3D's error handling philosophy is to log an error and continue, not crash.
     bool IsSolverTreeValid() const;
 
-    /// Subscribe to drawable update finished event here.
+    /// Registers the solver to be solved automatically in the new scene.
     void OnSceneSet(Scene* scene) override;
     /// Destroys and creates the tree.
     void OnNodeSet(Node* node) override;
@@ -354,8 +379,8 @@ private:
     void HandleComponentRemoved(StringHash eventType, VariantMap& eventData);
     void HandleNodeAdded(StringHash eventType, VariantMap& eventData);
     void HandleNodeRemoved(StringHash eventType, VariantMap& eventData);
-    /// Invokes the IK solver.
-    void HandleSceneDrawableUpdateFinished(StringHash eventType, VariantMap& eventData);
+    /// Adds to or removes from the automatically solved solvers depending on the AUTO_SOLVE feature and the scene.
+    void UpdateAutoSolve();
 
     // Need these wrapper functions flags of GetFeature/SetFeature can be correctly exposed to the editor and to AngelScript and lua
 public:
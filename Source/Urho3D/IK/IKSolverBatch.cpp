@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../IK/IKSolver.h"
+#include "../IK/IKSolverBatch.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+
+namespace Urho3D
+{
+
+static const unsigned DEFAULT_MIN_PARALLEL_SOLVERS = 8;
+
+// ----------------------------------------------------------------------------
+/// Solve the trees of a range of solvers.
+static void SolveTreesWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto** start = reinterpret_cast<IKSolver**>(item->start_);
+    auto** end = reinterpret_cast<IKSolver**>(item->end_);
+
+    while (start != end)
+    {
+        (*start)->SolveTree();
+        ++start;
+    }
+}
+
+// ----------------------------------------------------------------------------
+/// Return whether a solver's node is below the node of another solver, in which case its initial pose depends on the other solver's solution.
+static bool IsNestedSolver(IKSolver* solver)
+{
+    for (Node* node = solver->GetNode()->GetParent(); node != nullptr; node = node->GetParent())
+    {
+        if (node->HasComponent<IKSolver>())
+            return true;
+    }
+
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+IKSolverBatch::IKSolverBatch(Context* context) :
+    Object(context),
+    minParallelSolvers_(DEFAULT_MIN_PARALLEL_SOLVERS)
+{
+    SubscribeToEvent(E_SCENEDRAWABLEUPDATEFINISHED, URHO3D_HANDLER(IKSolverBatch, HandleSceneDrawableUpdateFinished));
+}
+
+// ----------------------------------------------------------------------------
+IKSolverBatch::~IKSolverBatch() = default;
+
+// ----------------------------------------------------------------------------
+void IKSolverBatch::AddSolver(IKSolver* solver)
+{
+    if (solver != nullptr && !solvers_.Contains(solver))
+        solvers_.Push(solver);
+}
+
+// ----------------------------------------------------------------------------
+void IKSolverBatch::RemoveSolver(IKSolver* solver)
+{
+    solvers_.RemoveSwap(solver);
+}
+
+// ----------------------------------------------------------------------------
+void IKSolverBatch::SolveScene(Scene* scene)
+{
+    URHO3D_PROFILE(SolveIK);
+
+    // Read the poses from the scene graph. Nested solvers must wait for the solutions of the solvers above them
+    PODVector<IKSolver*> nestedSolvers;
+    readySolvers_.Clear();
+    for (PODVector<IKSolver*>::ConstIterator it = solvers_.Begin(); it != solvers_.End(); ++it)
+    {
+        IKSolver* solver = *it;
+        if (solver->GetScene() != scene)
+            continue;
+
+        if (IsNestedSolver(solver))
+            nestedSolvers.Push(solver);
+        else if (solver->BeginSolve())
+            readySolvers_.Push(solver);
+    }
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    if (queue != nullptr && queue->GetNumThreads() > 0 && readySolvers_.Size() >= minParallelSolvers_)
+    {
+        int numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
+        int solversPerItem = Max((int)(readySolvers_.Size() / numWorkItems), 1);
+
+        PODVector<IKSolver*>::Iterator start = readySolvers_.Begin();
+        // Create a work item for each thread
+        for (int i = 0; i < numWorkItems && start != readySolvers_.End(); ++i)
+        {
+            SharedPtr<WorkItem> item = queue->GetFreeItem();
+            item->priority_ = M_MAX_UNSIGNED;
+            item->workFunction_ = SolveTreesWork;
+
+            PODVector<IKSolver*>::Iterator end = readySolvers_.End();
+            if (i < numWorkItems - 1 && end - start > solversPerItem)
+                end = start + solversPerItem;
+
+            item->start_ = &(*start);
+            item->end_ = &(*end);
+            queue->AddWorkItem(item);
+
+            start = end;
+        }
+
+        queue->Complete(M_MAX_UNSIGNED);
+    }
+    else
+    {
+        for (PODVector<IKSolver*>::ConstIterator it = readySolvers_.Begin(); it != readySolvers_.End(); ++it)
+            (*it)->SolveTree();
+    }
+
+    // Write the solutions back to the scene graph
+    for (PODVector<IKSolver*>::ConstIterator it = readySolvers_.Begin(); it != readySolvers_.End(); ++it)
+        (*it)->EndSolve();
+    readySolvers_.Clear();
+
+    for (PODVector<IKSolver*>::ConstIterator it = nestedSolvers.Begin(); it != nestedSolvers.End(); ++it)
+        (*it)->Solve();
+}
+
+// ----------------------------------------------------------------------------
+void IKSolverBatch::HandleSceneDrawableUpdateFinished(StringHash eventType, VariantMap& eventData)
+{
+    using namespace SceneDrawableUpdateFinished;
+
+    if (!solvers_.Empty())
+        SolveScene(static_cast<Scene*>(eventData[P_SCENE].GetPtr()));
+}
+
+} // namespace Urho3D
@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Object.h"
+
+namespace Urho3D
+{
+
+class IKSolver;
+class Scene;
+
+/*!
+ * @brief Solves the auto-solving IKSolver components of a scene together when
+ * the drawables of the scene have been updated, which is right after the
+ * animations have been applied.
+ *
+ * The solvers read their active and original poses from the scene graph and
+ * write their solutions back to it on the main thread, one after another.
+ * The solving itself only touches the IK library's trees, which are private
+ * to each solver, so when there are enough solvers it runs in parallel on the
+ * WorkQueue. Created on demand by IKSolver.
+ */
+class URHO3D_API IKSolverBatch : public Object
+{
+    URHO3D_OBJECT(IKSolverBatch, Object);
+
+public:
+    /// Construct.
+    explicit IKSolverBatch(Context* context);
+    /// Destruct.
+    ~IKSolverBatch() override;
+
+    /// Add a solver to be solved automatically. Called by IKSolver.
+    void AddSolver(IKSolver* solver);
+    /// Remove a solver. Called by IKSolver.
+    void RemoveSolver(IKSolver* solver);
+    /// Solve all added solvers of a scene.
+    void SolveScene(Scene* scene);
+
+    /// Set the minimum number of solvers of a scene to solve in worker threads. Default 8.
+    void SetMinParallelSolvers(unsigned count) { minParallelSolvers_ = count; }
+
+    /// Return the minimum number of solvers of a scene to solve in worker threads.
+    unsigned GetMinParallelSolvers() const { return minParallelSolvers_; }
+
+    /// Return number of added solvers.
+    unsigned GetNumSolvers() const { return solvers_.Size(); }
+
+private:
+    /// Handle a scene's drawable update finishing.
+    void HandleSceneDrawableUpdateFinished(StringHash eventType, VariantMap& eventData);
+
+    /// Added solvers.
+    PODVector<IKSolver*> solvers_;
+    /// Solvers ready to solve during SolveScene().
+    PODVector<IKSolver*> readySolvers_;
+    /// Minimum number of solvers to solve in worker threads.
+    unsigned minParallelSolvers_;
+};
+
+} // namespace Urho3D
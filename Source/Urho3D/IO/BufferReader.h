@@ -0,0 +1,251 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../IO/Deserializer.h"
+#include "../Math/Color.h"
+#include "../Math/Quaternion.h"
+#include "../Math/StringHash.h"
+#include "../Math/Vector4.h"
+
+namespace Urho3D
+{
+
+/// Non-virtual reader over contiguous memory. Reads the same binary format as Deserializer. Reading past the end returns zero values and sets the failed flag.
+class BufferReader
+{
+public:
+    /// Construct from a memory area.
+    BufferReader(const void* data, unsigned size) :
+        source_(nullptr),
+        data_(static_cast<const unsigned char*>(data)),
+        position_(0),
+        size_(data ? size : 0),
+        failed_(false)
+    {
+    }
+
+    /// Construct to read the rest of a stream held in memory, such as MemoryBuffer or VectorBuffer. The stream's position is advanced by Finish() or on destruction.
+    explicit BufferReader(Deserializer& source) :
+        source_(&source),
+        data_(source.GetReadPointer()),
+        position_(0),
+        size_(data_ ? source.GetSize() - source.GetPosition() : 0),
+        failed_(false)
+    {
+    }
+
+    /// Destruct. Advance the source stream.
+    ~BufferReader() { Finish(); }
+
+    /// Prevent copy construction.
+    BufferReader(const BufferReader& rhs) = delete;
+    /// Prevent assignment.
+    BufferReader& operator =(const BufferReader& rhs) = delete;
+
+    /// Advance the source stream past the data read so far.
+    void Finish()
+    {
+        if (source_)
+        {
+            source_->SeekRelative((int)position_);
+            data_ += position_;
+            size_ -= position_;
+            position_ = 0;
+        }
+    }
+
+    /// Return pointer to the given number of bytes at the current position and advance past them, or null if not enough data.
+    const unsigned char* Consume(unsigned size)
+    {
+        if (size > size_ - position_)
+        {
+            position_ = size_;
+            failed_ = true;
+            return nullptr;
+        }
+        const unsigned char* src = data_ + position_;
+        position_ += size;
+        return src;
+    }
+
+    /// Read bytes. Return true if all bytes could be read.
+    bool Read(void* dest, unsigned size)
+    {
+        const unsigned char* src = Consume(size);
+        if (!src)
+            return false;
+        if (size)
+            memcpy(dest, src, size);
+        return true;
+    }
+
+    /// Read a plain value without conversion.
+    template <class T> T ReadPOD()
+    {
+        T value{};
+        Read(&value, sizeof(T));
+        return value;
+    }
+    /// Read an array of plain values without conversion. Return true if all values could be read.
+    template <class T> bool ReadPODArray(T* dest, unsigned count) { return Read(dest, count * sizeof(T)); }
+
+    /// Read a 32-bit integer.
+    int ReadInt() { return ReadPOD<int>(); }
+    /// Read a 16-bit integer.
+    short ReadShort() { return ReadPOD<short>(); }
+    /// Read an 8-bit integer.
+    signed char ReadByte() { return ReadPOD<signed char>(); }
+    /// Read a 32-bit unsigned integer.
+    unsigned ReadUInt() { return ReadPOD<unsigned>(); }
+    /// Read a 16-bit unsigned integer.
+    unsigned short ReadUShort() { return ReadPOD<unsigned short>(); }
+    /// Read an 8-bit unsigned integer.
+    unsigned char ReadUByte() { return ReadPOD<unsigned char>(); }
+    /// Read a bool.
+    bool ReadBool() { return ReadUByte() != 0; }
+    /// Read a float.
+    float ReadFloat() { return ReadPOD<float>(); }
+    /// Read a double.
+    double ReadDouble() { return ReadPOD<double>(); }
+
+    /// Read a Vector2.
+    Vector2 ReadVector2()
+    {
+        float data[2]{};
+        Read(data, sizeof data);
+        return Vector2(data);
+    }
+
+    /// Read a Vector3.
+    Vector3 ReadVector3()
+    {
+        float data[3]{};
+        Read(data, sizeof data);
+        return Vector3(data);
+    }
+
+    /// Read a Vector4.
+    Vector4 ReadVector4()
+    {
+        float data[4]{};
+        Read(data, sizeof data);
+        return Vector4(data);
+    }
+
+    /// Read a quaternion.
+    Quaternion ReadQuaternion()
+    {
+        float data[4]{};
+        Read(data, sizeof data);
+        return Quaternion(data);
+    }
+
+    /// Read a color.
+    Color ReadColor()
+    {
+        float data[4]{};
+        Read(data, sizeof data);
+        return Color(data);
+    }
+
+    /// Read a 32-bit StringHash.
+    StringHash ReadStringHash() { return StringHash(ReadUInt()); }
+
+    /// Return a null-terminated string in place without copying and advance past it, or null if not terminated before the end.
+    const char* ReadCString()
+    {
+        const unsigned char* src = data_ + position_;
+        const auto* end = position_ < size_ ? static_cast<const unsigned char*>(memchr(src, 0, size_ - position_)) : nullptr;
+        if (!end)
+        {
+            position_ = size_;
+            failed_ = true;
+            return nullptr;
+        }
+        position_ += (unsigned)(end - src) + 1;
+        return reinterpret_cast<const char*>(src);
+    }
+
+    /// Read a null-terminated string.
+    String ReadString()
+    {
+        const char* str = ReadCString();
+        return str ? String(str) : String::EMPTY;
+    }
+
+    /// Read a variable-length encoded unsigned integer, which can use 29 bits maximum.
+    unsigned ReadVLE()
+    {
+        unsigned char byte = ReadUByte();
+        unsigned ret = (unsigned)(byte & 0x7fu);
+        if (byte < 0x80)
+            return ret;
+
+        byte = ReadUByte();
+        ret |= ((unsigned)(byte & 0x7fu)) << 7u;
+        if (byte < 0x80)
+            return ret;
+
+        byte = ReadUByte();
+        ret |= ((unsigned)(byte & 0x7fu)) << 14u;
+        if (byte < 0x80)
+            return ret;
+
+        byte = ReadUByte();
+        ret |= ((unsigned)byte) << 21u;
+        return ret;
+    }
+
+    /// Read a 24-bit network object ID.
+    unsigned ReadNetID()
+    {
+        unsigned ret = 0;
+        Read(&ret, 3);
+        return ret;
+    }
+
+    /// Return current position relative to the start of the data.
+    unsigned GetPosition() const { return position_; }
+    /// Return number of bytes left to read.
+    unsigned GetRemaining() const { return size_ - position_; }
+    /// Return whether the end has been reached.
+    bool IsEof() const { return position_ >= size_; }
+    /// Return whether a read has gone past the end.
+    bool HasFailed() const { return failed_; }
+
+private:
+    /// Source stream to advance, if any.
+    Deserializer* source_;
+    /// Start of the data.
+    const unsigned char* data_;
+    /// Current read position.
+    unsigned position_;
+    /// Size of the data.
+    unsigned size_;
+    /// Failed flag.
+    bool failed_;
+};
+
+}
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../IO/VectorBuffer.h"
+#include "../Math/Color.h"
+#include "../Math/Quaternion.h"
+#include "../Math/StringHash.h"
+#include "../Math/Vector4.h"
+
+namespace Urho3D
+{
+
+/// Non-virtual writer that appends to a vector buffer through a raw pointer. Writes the same binary format as Serializer. The buffer's size and position are updated by Finish() or on destruction; do not use the buffer directly in the meantime.
+class BufferWriter
+{
+public:
+    /// Construct to write at the current position of the buffer, optionally reserving space for the expected amount of data.
+    explicit BufferWriter(VectorBuffer& buffer, unsigned reserveSize = 0) :
+        buffer_(buffer),
+        data_(nullptr),
+        position_(buffer.GetPosition()),
+        end_(0),
+        originalSize_(buffer.GetSize())
+    {
+        Grow(reserveSize);
+    }
+
+    /// Destruct. Update the buffer.
+    ~BufferWriter() { Finish(); }
+
+    /// Prevent copy construction.
+    BufferWriter(const BufferWriter& rhs) = delete;
+    /// Prevent assignment.
+    BufferWriter& operator =(const BufferWriter& rhs) = delete;
+
+    /// Set the buffer's size and position to match the data written so far.
+    void Finish()
+    {
+        buffer_.Resize(Max(position_, originalSize_));
+        buffer_.Seek(position_);
+        data_ = buffer_.GetModifiableData();
+        end_ = buffer_.GetSize();
+    }
+
+    /// Return space for the given number of bytes at the current position and advance past it.
+    unsigned char* Allocate(unsigned size)
+    {
+        if (position_ + size > end_)
+            Grow(size);
+        unsigned char* dest = data_ + position_;
+        position_ += size;
+        return dest;
+    }
+
+    /// Write bytes.
+    void Write(const void* data, unsigned size)
+    {
+        if (size)
+            memcpy(Allocate(size), data, size);
+    }
+
+    /// Write a plain value without conversion.
+    template <class T> void WritePOD(const T& value) { memcpy(Allocate(sizeof(T)), &value, sizeof(T)); }
+    /// Write an array of plain values without conversion.
+    template <class T> void WritePODArray(const T* data, unsigned count) { Write(data, count * sizeof(T)); }
+
+    /// Write a 32-bit integer.
+    void WriteInt(int value) { WritePOD(value); }
+    /// Write a 16-bit integer.
+    void WriteShort(short value) { WritePOD(value); }
+    /// Write an 8-bit integer.
+    void WriteByte(signed char value) { WritePOD(value); }
+    /// Write a 32-bit unsigned integer.
+    void WriteUInt(unsigned value) { WritePOD(value); }
+    /// Write a 16-bit unsigned integer.
+    void WriteUShort(unsigned short value) { WritePOD(value); }
+    /// Write an 8-bit unsigned integer.
+    void WriteUByte(unsigned char value) { WritePOD(value); }
+    /// Write a bool.
+    void WriteBool(bool value) { WriteUByte((unsigned char)(value ? 1 : 0)); }
+    /// Write a float.
+    void WriteFloat(float value) { WritePOD(value); }
+    /// Write a double.
+    void WriteDouble(double value) { WritePOD(value); }
+    /// Write a Vector2.
+    void WriteVector2(const Vector2& value) { Write(value.Data(), sizeof(float) * 2); }
+    /// Write a Vector3.
+    void WriteVector3(const Vector3& value) { Write(value.Data(), sizeof(float) * 3); }
+    /// Write a Vector4.
+    void WriteVector4(const Vector4& value) { Write(value.Data(), sizeof(float) * 4); }
+    /// Write a quaternion.
+    void WriteQuaternion(const Quaternion& value) { Write(value.Data(), sizeof(float) * 4); }
+    /// Write a color.
+    void WriteColor(const Color& value) { Write(value.Data(), sizeof(float) * 4); }
+    /// Write a 32-bit StringHash.
+    void WriteStringHash(const StringHash& value) { WriteUInt(value.Value()); }
+
+    /// Write a null-terminated string.
+    void WriteString(const String& value)
+    {
+        const char* chars = value.CString();
+        // Count length to the first zero, because ReadString() does the same
+        Write(chars, String::CStringLength(chars) + 1);
+    }
+
+    /// Write a variable-length encoded unsigned integer, which can use 29 bits maximum.
+    void WriteVLE(unsigned value)
+    {
+        if (value < 0x80)
+            WriteUByte((unsigned char)value);
+        else if (value < 0x4000)
+        {
+            unsigned char* dest = Allocate(2);
+            dest[0] = (unsigned char)(value | 0x80u);
+            dest[1] = (unsigned char)(value >> 7u);
+        }
+        else if (value < 0x200000)
+        {
+            unsigned char* dest = Allocate(3);
+            dest[0] = (unsigned char)(value | 0x80u);
+            dest[1] = (unsigned char)(value >> 7u | 0x80u);
+            dest[2] = (unsigned char)(value >> 14u);
+        }
+        else
+        {
+            unsigned char* dest = Allocate(4);
+            dest[0] = (unsigned char)(value | 0x80u);
+            dest[1] = (unsigned char)(value >> 7u | 0x80u);
+            dest[2] = (unsigned char)(value >> 14u | 0x80u);
+            dest[3] = (unsigned char)(value >> 21u);
+        }
+    }
+
+    /// Write a 24-bit network object ID.
+    void WriteNetID(unsigned value) { Write(&value, 3); }
+
+    /// Return current position in the buffer.
+    unsigned GetPosition() const { return position_; }
+
+private:
+    /// Make room for at least the given number of bytes after the current position.
+    void Grow(unsigned size)
+    {
+        if (!size)
+            return;
+
+        unsigned newSize = position_ + size;
+        // Use the capacity the buffer already has, so that later writes do not need to resize it
+        buffer_.Resize(Max(Max(newSize, buffer_.GetCapacity()), originalSize_));
+        data_ = buffer_.GetModifiableData();
+        end_ = buffer_.GetSize();
+    }
+
+    /// Destination buffer.
+    VectorBuffer& buffer_;
+    /// Buffer data.
+    unsigned char* data_;
+    /// Current write position.
+    unsigned position_;
+    /// End of the space available for writing.
+    unsigned end_;
+    /// Size of the buffer before writing.
+    unsigned originalSize_;
+};
+
+}
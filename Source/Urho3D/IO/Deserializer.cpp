@@ -246,6 +246,18 @@ BoundingBox Deserializer::ReadBoundingBox()
 
 String Deserializer::ReadString()
 {
+    // Find the terminator in place if the stream is in memory, instead of reading byte by byte
+    const unsigned char* data = GetReadPointer();
+    if (data && position_ < size_)
+    {
+        unsigned available = size_ - position_;
+        const auto* end = static_cast<const unsigned char*>(memchr(data, 0, available));
+        unsigned length = end ? (unsigned)(end - data) : available;
+        String ret(reinterpret_cast<const char*>(data), length);
+        Seek(position_ + length + (end ? 1 : 0));
+        return ret;
+    }
+
     String ret;
 
     while (!IsEof())
@@ -273,6 +285,22 @@ StringHash Deserializer::ReadStringHash()
     return StringHash(ReadUInt());
 }
 
+const unsigned char* Deserializer::ReadBlock(unsigned& size, PODVector<unsigned char>& storage)
+{
+    const unsigned char* data = GetReadPointer();
+    if (data)
+    {
+        size = Min(size, size_ > position_ ? size_ - position_ : 0);
+        Seek(position_ + size);
+        return data;
+    }
+
+    storage.Resize(size);
+    if (size)
+        size = Read(&storage[0], size);
+    return size ? &storage[0] : nullptr;
+}
+
 PODVector<unsigned char> Deserializer::ReadBuffer()
 {
     PODVector<unsigned char> ret(ReadVLE());
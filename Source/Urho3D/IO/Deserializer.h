@@ -54,6 +54,8 @@ public:
     /// Return whether the end of stream has been reached.
     /// @property
     virtual bool IsEof() const { return position_ >= size_; }
+    /// Return pointer to the data at the current position if the whole stream is held in memory, or null otherwise. Used for reading in place without copying.
+    virtual const unsigned char* GetReadPointer() const { return nullptr; }
 
     /// Set position relative to current position. Return actual new position.
     unsigned SeekRelative(int delta);
@@ -125,6 +127,8 @@ public:
     String ReadFileID();
     /// Read a 32-bit StringHash.
     StringHash ReadStringHash();
+    /// Read a block of bytes and return a pointer to them. If the stream is held in memory, the pointer refers to the stream's own memory, otherwise the bytes are copied into the storage vector. The size is updated to the number of bytes actually read.
+    const unsigned char* ReadBlock(unsigned& size, PODVector<unsigned char>& storage);
     /// Read a buffer with size encoded as VLE.
     PODVector<unsigned char> ReadBuffer();
     /// Read a resource reference.
@@ -148,6 +152,26 @@ public:
     /// Read a text line.
     String ReadLine();
 
+    /// Read an array of plain values in one call without conversion. Return true if all values could be read.
+    template <class T> bool ReadPODArray(T* dest, unsigned count)
+    {
+        unsigned size = count * sizeof(T);
+        return Read(dest, size) == size;
+    }
+
+    /// Read a vector of plain values written by Serializer::WritePODVector().
+    template <class T> PODVector<T> ReadPODVector()
+    {
+        unsigned count = ReadVLE();
+        // Do not trust the count beyond the data that is left, if the size of the stream is known
+        if (size_ && count > (size_ - position_) / sizeof(T))
+            count = 0;
+        PODVector<T> ret(count);
+        if (count && !ReadPODArray(ret.Buffer(), count))
+            ret.Clear();
+        return ret;
+    }
+
 protected:
     /// Stream position.
     unsigned position_;
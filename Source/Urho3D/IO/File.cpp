@@ -23,6 +23,9 @@
 #include "../Precompiled.h"
 
 #include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
@@ -64,6 +67,41 @@ const char* APK = "/apk/";
 static const unsigned READ_BUFFER_SIZE = 32768;
 #endif
 static const unsigned SKIP_BUFFER_SIZE = 1024;
+static const unsigned MIN_PARALLEL_DECOMPRESS_BLOCKS = 8;
+
+/// Range of contiguous LZ4 blocks, each starting with its uncompressed and compressed size, to decompress into contiguous memory.
+struct BlockRange
+{
+    /// Compressed source data.
+    const unsigned char* source_;
+    /// Destination for the uncompressed data.
+    unsigned char* dest_;
+    /// Number of blocks.
+    unsigned numBlocks_;
+};
+
+/// Decompress a range of LZ4 blocks.
+static void DecompressBlockRange(const BlockRange& range)
+{
+    const unsigned char* source = range.source_;
+    unsigned char* dest = range.dest_;
+
+    for (unsigned i = 0; i < range.numBlocks_; ++i)
+    {
+        MemoryBuffer blockHeader(source, 4);
+        unsigned unpackedSize = blockHeader.ReadUShort();
+        unsigned packedSize = blockHeader.ReadUShort();
+        LZ4_decompress_fast((const char*)source + 4, (char*)dest, unpackedSize);
+        source += 4 + packedSize;
+        dest += unpackedSize;
+    }
+}
+
+/// Work function for decompressing a range of LZ4 blocks.
+static void DecompressBlockRangeWork(const WorkItem* item, unsigned /*threadIndex*/)
+{
+    DecompressBlockRange(*reinterpret_cast<const BlockRange*>(item->aux_));
+}
 
 File::File(Context* context) :
     Object(context),
@@ -77,6 +115,8 @@ File::File(Context* context) :
     offset_(0),
     checksum_(0),
     compressed_(false),
+    blockSize_(0),
+    mappedPosition_(0),
     readSyncNeeded_(false),
     writeSyncNeeded_(false)
 {
@@ -94,6 +134,8 @@ File::File(Context* context, const String& fileName, FileMode mode) :
     offset_(0),
     checksum_(0),
     compressed_(false),
+    blockSize_(0),
+    mappedPosition_(0),
     readSyncNeeded_(false),
     writeSyncNeeded_(false)
 {
@@ -112,6 +154,8 @@ File::File(Context* context, PackageFile* package, const String& fileName) :
     offset_(0),
     checksum_(0),
     compressed_(false),
+    blockSize_(0),
+    mappedPosition_(0),
     readSyncNeeded_(false),
     writeSyncNeeded_(false)
 {
@@ -137,11 +181,25 @@ bool File::Open(PackageFile* package, const String& fileName)
     if (!entry)
         return false;
 
-    bool success = OpenInternal(package->GetName(), FILE_READ, true);
-    if (!success)
+    PackageMapping* mapping = package->GetMapping();
+    if (mapping)
     {
-        URHO3D_LOGERROR("Could not open package file " + fileName);
-        return false;
+        // Read straight from the package mapping without opening a file handle
+        Close();
+        mapping_ = mapping;
+        mode_ = FILE_READ;
+        position_ = 0;
+        readSyncNeeded_ = false;
+        writeSyncNeeded_ = false;
+    }
+    else
+    {
+        bool success = OpenInternal(package->GetName(), FILE_READ, true);
+        if (!success)
+        {
+            URHO3D_LOGERROR("Could not open package file " + fileName);
+            return false;
+        }
     }
 
     name_ = fileName;
@@ -152,6 +210,32 @@ bool File::Open(PackageFile* package, const String& fileName)
 
     // Seek to beginning of package entry's file data
     SeekInternal(offset_);
+
+    // Read the block offset table of a block indexed entry, converted to offsets within the package
+    if (compressed_ && package->GetBlockSize())
+    {
+        unsigned numBlocks;
+        if (!ReadInternal(&numBlocks, sizeof numBlocks))
+        {
+            URHO3D_LOGERROR("Could not read block index of packaged file " + fileName);
+            Close();
+            return false;
+        }
+
+        blockOffsets_.Resize(numBlocks + 1);
+        if (!ReadInternal(&blockOffsets_[0], (numBlocks + 1) * sizeof(unsigned)))
+        {
+            URHO3D_LOGERROR("Could not read block index of packaged file " + fileName);
+            Close();
+            return false;
+        }
+
+        for (unsigned i = 0; i < blockOffsets_.Size(); ++i)
+            blockOffsets_[i] += offset_;
+        blockSize_ = package->GetBlockSize();
+        SeekInternal(blockOffsets_[0]);
+    }
+
     return true;
 }
 
@@ -216,7 +300,60 @@ unsigned File::Read(void* dest, unsigned size)
 
         while (sizeLeft)
         {
-            if (!readBuffer_ || readBufferOffset_ >= readBufferSize_)
+            // Decompress runs of whole blocks at once when the block offsets are known, in parallel if possible
+            if (blockSize_ && (!readBuffer_ || readBufferOffset_ >= readBufferSize_))
+            {
+                unsigned numBlocks = sizeLeft == size_ - position_ ? (sizeLeft + blockSize_ - 1) / blockSize_ : sizeLeft / blockSize_;
+                if (numBlocks >= MIN_PARALLEL_DECOMPRESS_BLOCKS)
+                {
+                    unsigned readSize = ReadBlocks(destPtr, position_ / blockSize_, numBlocks);
+                    if (!readSize)
+                    {
+                        URHO3D_LOGERROR("Error while reading from file " + GetName());
+                        return size - sizeLeft;
+                    }
+
+                    destPtr += readSize;
+                    sizeLeft -= readSize;
+                    position_ += readSize;
+                    readBufferOffset_ = 0;
+                    readBufferSize_ = 0;
+                    continue;
+                }
+            }
+
+            if (mapping_ && (!readBuffer_ || readBufferOffset_ >= readBufferSize_))
+            {
+                // Decode straight from the mapping, and into the destination when the whole block is wanted
+                const unsigned char* block = mapping_->GetData() + mappedPosition_;
+                MemoryBuffer blockHeader(block, 4);
+                unsigned unpackedSize = blockHeader.ReadUShort();
+                unsigned packedSize = blockHeader.ReadUShort();
+                mappedPosition_ += 4 + packedSize;
+
+                if (sizeLeft >= unpackedSize)
+                {
+                    LZ4_decompress_fast((const char*)block + 4, (char*)destPtr, unpackedSize);
+                    destPtr += unpackedSize;
+                    sizeLeft -= unpackedSize;
+                    position_ += unpackedSize;
+                    readBufferOffset_ = 0;
+                    readBufferSize_ = 0;
+                    continue;
+                }
+
+                // The first block of an entry is the largest, so size the buffer by it in case this block is a shorter last one
+                if (!readBuffer_)
+                {
+                    MemoryBuffer firstHeader(mapping_->GetData() + (blockOffsets_.Empty() ? offset_ : blockOffsets_[0]), 2);
+                    readBuffer_ = new unsigned char[Max((unsigned)firstHeader.ReadUShort(), unpackedSize)];
+                }
+
+                LZ4_decompress_fast((const char*)block + 4, (char*)readBuffer_.Get(), unpackedSize);
+                readBufferSize_ = unpackedSize;
+                readBufferOffset_ = 0;
+            }
+            else if (!readBuffer_ || readBufferOffset_ >= readBufferSize_)
             {
                 unsigned char blockHeaderBytes[4];
                 ReadInternal(blockHeaderBytes, sizeof blockHeaderBytes);
@@ -225,10 +362,12 @@ unsigned File::Read(void* dest, unsigned size)
                 unsigned unpackedSize = blockHeader.ReadUShort();
                 unsigned packedSize = blockHeader.ReadUShort();
 
+                // Seeking by the block index may start from a shorter last block, so size by the block size when known
                 if (!readBuffer_)
                 {
-                    readBuffer_ = new unsigned char[unpackedSize];
-                    inputBuffer_ = new unsigned char[LZ4_compressBound(unpackedSize)];
+                    unsigned bufferSize = Max(unpackedSize, blockSize_);
+                    readBuffer_ = new unsigned char[bufferSize];
+                    inputBuffer_ = new unsigned char[LZ4_compressBound(bufferSize)];
                 }
 
                 /// \todo Handle errors
@@ -284,23 +423,41 @@ unsigned File::Seek(unsigned position)
 
     if (compressed_)
     {
+        if (blockSize_)
+        {
+            // Move within the read buffer if it holds the position
+            if (position >= position_ && position - position_ <= readBufferSize_ - readBufferOffset_)
+            {
+                readBufferOffset_ += position - position_;
+                position_ = position;
+                return position_;
+            }
+
+            // Otherwise jump to the start of the block containing the position, as the block offsets are known
+            unsigned block = Min(position / blockSize_, blockOffsets_.Size() - 1);
+            position_ = block * blockSize_;
+            readBufferOffset_ = 0;
+            readBufferSize_ = 0;
+            SeekInternal(blockOffsets_[block]);
+        }
         // Start over from the beginning
-        if (position == 0)
+        else if (position == 0)
         {
             position_ = 0;
             readBufferOffset_ = 0;
             readBufferSize_ = 0;
             SeekInternal(offset_);
         }
+
         // Skip bytes
-        else if (position >= position_)
+        if (position >= position_)
         {
             unsigned char skipBuffer[SKIP_BUFFER_SIZE];
             while (position > position_)
                 Read(skipBuffer, Min(position - position_, SKIP_BUFFER_SIZE));
         }
         else
-            URHO3D_LOGERROR("Seeking backward in a compressed file is not supported");
+            URHO3D_LOGERROR("Seeking backward in a compressed file without a block index is not supported");
 
         return position_;
     }
@@ -352,6 +509,11 @@ unsigned File::Write(const void* data, unsigned size)
     return size;
 }
 
+const unsigned char* File::GetReadPointer() const
+{
+    return mapping_ && !compressed_ ? mapping_->GetData() + offset_ + position_ : nullptr;
+}
+
 unsigned File::GetChecksum()
 {
     if (offset_ || checksum_)
@@ -393,11 +555,18 @@ void File::Close()
 
     readBuffer_.Reset();
     inputBuffer_.Reset();
+    blockOffsets_.Clear();
+    blockSize_ = 0;
 
-    if (handle_)
+    if (handle_ || mapping_)
     {
-        fclose((FILE*)handle_);
-        handle_ = nullptr;
+        if (handle_)
+        {
+            fclose((FILE*)handle_);
+            handle_ = nullptr;
+        }
+        mapping_.Reset();
+        mappedPosition_ = 0;
         position_ = 0;
         size_ = 0;
         offset_ = 0;
@@ -414,9 +583,9 @@ void File::Flush()
 bool File::IsOpen() const
 {
 #ifdef __ANDROID__
-    return handle_ != 0 || assetHandle_ != 0;
+    return handle_ != 0 || assetHandle_ != 0 || mapping_;
 #else
-    return handle_ != nullptr;
+    return handle_ != nullptr || mapping_;
 #endif
 }
 
@@ -518,8 +687,85 @@ bool File::OpenInternal(const String& fileName, FileMode mode, bool fromPackage)
     return true;
 }
 
+unsigned File::ReadBlocks(unsigned char* dest, unsigned firstBlock, unsigned numBlocks)
+{
+    unsigned endBlock = firstBlock + numBlocks;
+    const unsigned char* source;
+    PODVector<unsigned char> packedData;
+
+    if (mapping_)
+    {
+        source = mapping_->GetData() + blockOffsets_[firstBlock];
+        SeekInternal(blockOffsets_[endBlock]);
+    }
+    else
+    {
+        // Read the compressed data of all the blocks in one go
+        packedData.Resize(blockOffsets_[endBlock] - blockOffsets_[firstBlock]);
+        SeekInternal(blockOffsets_[firstBlock]);
+        if (!ReadInternal(&packedData[0], packedData.Size()))
+        {
+            SeekInternal(blockOffsets_[firstBlock]);
+            return 0;
+        }
+        source = &packedData[0];
+    }
+
+    // Work items can only be queued from the main thread
+    WorkQueue* queue = Thread::IsMainThread() ? GetSubsystem<WorkQueue>() : nullptr;
+    unsigned numRanges = queue ? Min(queue->GetNumThreads() + 1, numBlocks) : 1;
+
+    PODVector<BlockRange> ranges(numRanges);
+    for (unsigned i = 0; i < numRanges; ++i)
+    {
+        unsigned rangeStart = firstBlock + numBlocks * i / numRanges;
+        unsigned rangeEnd = firstBlock + numBlocks * (i + 1) / numRanges;
+        ranges[i].source_ = source + blockOffsets_[rangeStart] - blockOffsets_[firstBlock];
+        ranges[i].dest_ = dest + (rangeStart - firstBlock) * blockSize_;
+        ranges[i].numBlocks_ = rangeEnd - rangeStart;
+    }
+
+    Vector<SharedPtr<WorkItem> > items;
+    for (unsigned i = 1; i < numRanges; ++i)
+    {
+        SharedPtr<WorkItem> item(new WorkItem());
+        item->workFunction_ = DecompressBlockRangeWork;
+        item->aux_ = &ranges[i];
+        item->priority_ = M_MAX_UNSIGNED;
+        queue->AddWorkItem(item);
+        items.Push(item);
+    }
+
+    DecompressBlockRange(ranges[0]);
+
+    // Decompress the ranges no worker thread has taken yet here, and wait for the rest
+    for (unsigned i = 0; i < items.Size(); ++i)
+    {
+        if (items[i]->completed_)
+            continue;
+        if (queue->RemoveWorkItem(items[i]))
+            DecompressBlockRange(ranges[i + 1]);
+        else
+        {
+            while (!items[i]->completed_)
+                Time::Sleep(0);
+        }
+    }
+
+    return Min(numBlocks * blockSize_, size_ - firstBlock * blockSize_);
+}
+
 bool File::ReadInternal(void* dest, unsigned size)
 {
+    if (mapping_)
+    {
+        if (mappedPosition_ + size > mapping_->GetSize())
+            return false;
+        memcpy(dest, mapping_->GetData() + mappedPosition_, size);
+        mappedPosition_ += size;
+        return true;
+    }
+
 #ifdef __ANDROID__
     if (assetHandle_)
     {
@@ -532,6 +778,12 @@ bool File::ReadInternal(void* dest, unsigned size)
 
 void File::SeekInternal(unsigned newPosition)
 {
+    if (mapping_)
+    {
+        mappedPosition_ = newPosition;
+        return;
+    }
+
 #ifdef __ANDROID__
     if (assetHandle_)
     {
@@ -57,6 +57,7 @@ enum FileMode
 };
 
 class PackageFile;
+class PackageMapping;
 
 /// %File opened either through the filesystem or from within a package file.
 class URHO3D_API File : public Object, public AbstractFile
@@ -79,6 +80,8 @@ public:
     unsigned Seek(unsigned position) override;
     /// Write bytes to the file. Return number of bytes actually written.
     unsigned Write(const void* data, unsigned size) override;
+    /// Return pointer to the data at the current position when reading an uncompressed file from a memory mapped package, otherwise null.
+    const unsigned char* GetReadPointer() const override;
 
     /// Return a checksum of the file contents using the SDBM hash algorithm.
     unsigned GetChecksum() override;
@@ -107,6 +110,10 @@ public:
     /// @property
     bool IsPackaged() const { return offset_ != 0; }
 
+    /// Return whether the file reads from a memory mapped package.
+    /// @property
+    bool IsMemoryMapped() const { return mapping_.NotNull(); }
+
 private:
     /// Open file internally using either C standard IO functions or SDL RWops for Android asset files. Return true if successful.
     bool OpenInternal(const String& fileName, FileMode mode, bool fromPackage = false);
@@ -114,6 +121,8 @@ private:
     bool ReadInternal(void* dest, unsigned size);
     /// Seek in file internally using either C standard IO functions or SDL RWops for Android asset files.
     void SeekInternal(unsigned newPosition);
+    /// Decompress a run of whole blocks of a block indexed compressed file into the destination, in parallel on the work queue when called from the main thread. Return number of bytes decompressed, 0 on read error.
+    unsigned ReadBlocks(unsigned char* dest, unsigned firstBlock, unsigned numBlocks);
 
     /// Open mode.
     FileMode mode_;
@@ -137,6 +146,14 @@ private:
     unsigned checksum_;
     /// Compression flag.
     bool compressed_;
+    /// Offsets of the compressed blocks within the package followed by the end offset of the data, empty if the package has no block index.
+    PODVector<unsigned> blockOffsets_;
+    /// Uncompressed block size, 0 if the package has no block index.
+    unsigned blockSize_;
+    /// Memory mapping of the package the file was opened from, null when reading through the file handle.
+    SharedPtr<PackageMapping> mapping_;
+    /// Read position within a memory mapped package.
+    unsigned mappedPosition_;
     /// Synchronization needed before read -flag.
     bool readSyncNeeded_;
     /// Synchronization needed before write -flag.
@@ -332,6 +332,7 @@ void FileWatcher::AddChange(const String& fileName)
 
     // Reset the timer associated with the filename. Will be notified once timer exceeds the delay
     changes_[fileName].Reset();
+    lastChangeTimer_.Reset();
 }
 
 bool FileWatcher::GetNextChange(String& dest)
@@ -358,4 +359,19 @@ bool FileWatcher::GetNextChange(String& dest)
     }
 }
 
+bool FileWatcher::GetChanges(Vector<String>& dest)
+{
+    MutexLock lock(changesMutex_);
+
+    dest.Clear();
+    if (changes_.Empty() || lastChangeTimer_.GetMSec(false) < (unsigned)(delay_ * 1000.0f))
+        return false;
+
+    dest.Reserve(changes_.Size());
+    for (HashMap<String, Timer>::ConstIterator i = changes_.Begin(); i != changes_.End(); ++i)
+        dest.Push(i->first_);
+    changes_.Clear();
+    return true;
+}
+
 }
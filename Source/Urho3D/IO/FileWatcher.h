@@ -51,12 +51,15 @@ public:
     bool StartWatching(const String& pathName, bool watchSubDirs);
     /// Stop watching the directory.
     void StopWatching();
-    /// Set the delay in seconds before file changes are notified. This (hopefully) avoids notifying when a file save is still in progress. Default 1 second.
+    /// Set the delay in seconds before file changes are notified. This (hopefully) avoids notifying when a file save is still in progress. For batched changes, the delay is counted from the latest change of any file. Default 1 second.
     void SetDelay(float interval);
     /// Add a file change into the changes queue.
     void AddChange(const String& fileName);
     /// Return a file change (true if was found, false if not).
     bool GetNextChange(String& dest);
+    /// Return all pending file changes as one batch once no file has changed for the delay, so that a sync of many files is notified together. Each file is included once however many times it changed. Return true if changes were returned.
+    /// @nobind
+    bool GetChanges(Vector<String>& dest);
 
     /// Return the path being watched, or empty if not watching.
     const String& GetPath() const { return path_; }
@@ -71,6 +74,8 @@ private:
     String path_;
     /// Pending changes. These will be returned and removed from the list when their timer has exceeded the delay.
     HashMap<String, Timer> changes_;
+    /// Time since the latest change of any file.
+    Timer lastChangeTimer_;
     /// Mutex for the change buffer.
     Mutex changesMutex_;
     /// Delay in seconds for notifying changes.
@@ -26,6 +26,7 @@
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/ProcessUtils.h"
+#include "../Core/Profiler.h"
 #include "../Core/Thread.h"
 #include "../Core/Timer.h"
 #include "../IO/File.h"
@@ -56,11 +57,156 @@ const char* logLevelPrefixes[] =
     nullptr
 };
 
+/// Number of messages the log queue can hold. Must be a power of two.
+static const unsigned LOG_QUEUE_SIZE = 4096;
+
 static Log* logInstance = nullptr;
 static bool threadErrorDisplayed = false;
+/// Whether the current thread is the log writer thread.
+static thread_local bool logWriterThread = false;
+
+/// Bounded queue of log messages with multiple producers and a single consumer. Producers reserve a cell by advancing
+/// the enqueue position and publish it through the cell sequence number, so writing threads do not lock each other.
+class LogQueue
+{
+public:
+    /// Construct with the number of cells, which must be a power of two.
+    explicit LogQueue(unsigned size) :
+        cells_(new Cell[size]),
+        mask_(size - 1),
+        enqueuePos_(0),
+        dequeuePos_(0)
+    {
+        for (unsigned i = 0; i < size; ++i)
+            cells_[i].sequence_.store(i, std::memory_order_relaxed);
+    }
+
+    /// Destruct.
+    ~LogQueue()
+    {
+        delete[] cells_;
+    }
+
+    /// Add a message. Return false if the queue is full.
+    bool Push(const StoredLogMessage& message)
+    {
+        Cell* cell;
+        unsigned pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &cells_[pos & mask_];
+            unsigned sequence = cell->sequence_.load(std::memory_order_acquire);
+            int diff = (int)(sequence - pos);
+            if (!diff)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;
+            else
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+
+        cell->message_ = message;
+        cell->sequence_.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Remove the oldest message. Return false if the queue is empty. May only be called from one thread at a time.
+    bool Pop(StoredLogMessage& message)
+    {
+        unsigned pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell* cell = &cells_[pos & mask_];
+        if (cell->sequence_.load(std::memory_order_acquire) != pos + 1)
+            return false;
+
+        message.message_.Swap(cell->message_.message_);
+        message.level_ = cell->message_.level_;
+        message.error_ = cell->message_.error_;
+        message.textStart_ = cell->message_.textStart_;
+        message.threaded_ = cell->message_.threaded_;
+        cell->message_.message_.Clear();
+        cell->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+        dequeuePos_.store(pos + 1);
+        return true;
+    }
+
+    /// Return whether there are no messages in the queue, including ones that are being added.
+    bool Empty() const { return dequeuePos_.load() == enqueuePos_.load(); }
+
+private:
+    /// Queue cell.
+    struct Cell
+    {
+        /// Sequence number. Equals the enqueue position when the cell is free and the position plus one when the message has been written.
+        std::atomic<unsigned> sequence_;
+        /// Message.
+        StoredLogMessage message_;
+    };
+
+    /// Cells.
+    Cell* cells_;
+    /// Mask for wrapping the positions.
+    unsigned mask_;
+    /// Next position to add to.
+    std::atomic<unsigned> enqueuePos_;
+    /// Next position to remove from.
+    std::atomic<unsigned> dequeuePos_;
+};
+
+/// Thread that writes the queued log messages to the console and the log file.
+class LogWriter : public Thread
+{
+public:
+    /// Construct.
+    explicit LogWriter(Log* owner) :
+        owner_(owner)
+    {
+    }
+
+    /// Write messages until stopped.
+    void ThreadFunction() override
+    {
+        URHO3D_PROFILE_THREAD("LogWriter Thread");
+
+        logWriterThread = true;
+        while (shouldRun_)
+        {
+            if (!owner_->WriteQueuedMessages())
+                Time::Sleep(5);
+        }
+
+        // Write the messages that were queued before stopping
+        owner_->WriteQueuedMessages();
+    }
+
+private:
+    /// Log subsystem.
+    Log* owner_;
+};
+
+/// Add the timestamp and level prefix to a message.
+static void FormatLogMessage(StoredLogMessage& message, bool timeStamp)
+{
+    if (message.level_ == LOG_RAW)
+        return;
+
+    String formattedMessage = logLevelPrefixes[message.level_];
+    formattedMessage += ": ";
+    if (timeStamp)
+        formattedMessage = "[" + Time::GetTimeStamp() + "] " + formattedMessage;
+
+    message.textStart_ = formattedMessage.Length();
+    formattedMessage += message.message_;
+    message.message_.Swap(formattedMessage);
+}
 
 Log::Log(Context* context) :
     Object(context),
+    queue_(new LogQueue(LOG_QUEUE_SIZE)),
+    numDroppedMessages_(0),
+    writing_(false),
 #ifdef _DEBUG
     level_(LOG_DEBUG),
 #else
@@ -68,15 +214,27 @@ Log::Log(Context* context) :
 #endif
     timeStamp_(true),
     inWrite_(false),
-    quiet_(false)
+    quiet_(false),
+    queuePolicy_(LOG_QUEUE_BLOCK)
 {
     logInstance = this;
 
+    // Without threading support the messages are written immediately
+    writer_ = new LogWriter(this);
+    if (!writer_->Run())
+        writer_.Reset();
+
     SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(Log, HandleEndFrame));
 }
 
 Log::~Log()
 {
+    if (writer_)
+    {
+        writer_->Stop();
+        writer_.Reset();
+    }
+
     logInstance = nullptr;
 }
 
@@ -93,14 +251,17 @@ void Log::Open(const String& fileName)
             Close();
     }
 
-    logFile_ = new File(context_);
-    if (logFile_->Open(fileName, FILE_WRITE))
+    SharedPtr<File> logFile(new File(context_));
+    if (logFile->Open(fileName, FILE_WRITE))
+    {
+        {
+            MutexLock lock(outputMutex_);
+            logFile_ = logFile;
+        }
         Write(LOG_INFO, "Opened log file " + fileName);
+    }
     else
-    {
-        logFile_.Reset();
         Write(LOG_ERROR, "Failed to create log file " + fileName);
-    }
 #endif
 }
 
@@ -109,6 +270,9 @@ void Log::Close()
 #if !defined(__ANDROID__) && !defined(IOS) && !defined(TVOS)
     if (logFile_ && logFile_->IsOpen())
     {
+        Flush();
+
+        MutexLock lock(outputMutex_);
         logFile_->Close();
         logFile_.Reset();
     }
@@ -136,6 +300,31 @@ void Log::SetQuiet(bool quiet)
     quiet_ = quiet;
 }
 
+void Log::SetQueuePolicy(LogQueuePolicy policy)
+{
+    queuePolicy_ = policy;
+}
+
+void Log::Flush()
+{
+    if (!writer_ || logWriterThread)
+        return;
+
+    // Check the queue before the busy flag, as the writer thread sets the flag before taking the last message
+    while (!queue_->Empty() || writing_)
+        Time::Sleep(1);
+}
+
+bool Log::IsEnabled(int level)
+{
+    if (!logInstance)
+        return false;
+    if (level == LOG_RAW)
+        return true;
+
+    return level >= LOG_TRACE && level < LOG_NONE && logInstance->level_ <= level;
+}
+
 void Log::WriteFormat(int level, const char* format, ...)
 {
     if (!logInstance || logInstance->level_ > level)
@@ -164,57 +353,33 @@ void Log::Write(int level, const String& message)
     if (level < LOG_TRACE || level >= LOG_NONE)
         return;
 
-    // If not in the main thread, store message for later processing
+    // Do not log if message level excluded
+    if (!logInstance || logInstance->level_ > level)
+        return;
+
+    // If not in the main thread, queue the message as is. The log writer thread formats it and the log event is sent at
+    // the end of the frame
     if (!Thread::IsMainThread())
     {
-        if (logInstance)
-        {
-            MutexLock lock(logInstance->logMutex_);
-            logInstance->threadMessages_.Push(StoredLogMessage(message, level, false));
-        }
-
+        logInstance->QueueMessage(StoredLogMessage(message, level, false, 0, true));
         return;
     }
 
-    // Do not log if message level excluded or if currently sending a log event
-    if (!logInstance || logInstance->level_ > level || logInstance->inWrite_)
+    // Do not log if currently sending a log event
+    if (logInstance->inWrite_)
         return;
 
-    String formattedMessage = logLevelPrefixes[level];
-    formattedMessage += ": " + message;
+    StoredLogMessage formattedMessage(message, level, false);
+    FormatLogMessage(formattedMessage, logInstance->timeStamp_);
     logInstance->lastMessage_ = message;
-
-    if (logInstance->timeStamp_)
-        formattedMessage = "[" + Time::GetTimeStamp() + "] " + formattedMessage;
-
-#if defined(__ANDROID__)
-    int androidLevel = ANDROID_LOG_VERBOSE + level;
-    __android_log_print(androidLevel, "Urho3D", "%s", message.CString());
-#elif defined(IOS) || defined(TVOS)
-    SDL_IOS_LogMessage(message.CString());
-#else
-    if (logInstance->quiet_)
-    {
-        // If in quiet mode, still print the error message to the standard error stream
-        if (level == LOG_ERROR)
-            PrintUnicodeLine(formattedMessage, true);
-    }
-    else
-        PrintUnicodeLine(formattedMessage, level == LOG_ERROR);
-#endif
-
-    if (logInstance->logFile_)
-    {
-        logInstance->logFile_->WriteLine(formattedMessage);
-        logInstance->logFile_->Flush();
-    }
+    logInstance->QueueMessage(formattedMessage);
 
     logInstance->inWrite_ = true;
 
     using namespace LogMessage;
 
     VariantMap& eventData = logInstance->GetEventDataMap();
-    eventData[P_MESSAGE] = formattedMessage;
+    eventData[P_MESSAGE] = formattedMessage.message_;
     eventData[P_LEVEL] = level;
     logInstance->SendEvent(E_LOGMESSAGE, eventData);
 
@@ -223,14 +388,11 @@ void Log::Write(int level, const String& message)
 
 void Log::WriteRaw(const String& message, bool error)
 {
-    // If not in the main thread, store message for later processing
+    // If not in the main thread, queue the message and send the log event at the end of the frame
     if (!Thread::IsMainThread())
     {
         if (logInstance)
-        {
-            MutexLock lock(logInstance->logMutex_);
-            logInstance->threadMessages_.Push(StoredLogMessage(message, LOG_RAW, error));
-        }
+            logInstance->QueueMessage(StoredLogMessage(message, LOG_RAW, error, 0, true));
 
         return;
     }
@@ -240,44 +402,126 @@ void Log::WriteRaw(const String& message, bool error)
         return;
 
     logInstance->lastMessage_ = message;
+    logInstance->QueueMessage(StoredLogMessage(message, LOG_RAW, error));
 
-#if defined(__ANDROID__)
-    if (logInstance->quiet_)
+    logInstance->inWrite_ = true;
+
+    using namespace LogMessage;
+
+    VariantMap& eventData = logInstance->GetEventDataMap();
+    eventData[P_MESSAGE] = message;
+    eventData[P_LEVEL] = error ? LOG_ERROR : LOG_INFO;
+    logInstance->SendEvent(E_LOGMESSAGE, eventData);
+
+    logInstance->inWrite_ = false;
+}
+
+void Log::QueueMessage(const StoredLogMessage& message)
+{
+    if (writer_)
     {
-        if (error)
-            __android_log_print(ANDROID_LOG_ERROR, "Urho3D", "%s", message.CString());
+        while (!queue_->Push(message))
+        {
+            // The log writer thread can not wait for itself
+            if (queuePolicy_ == LOG_QUEUE_DROP || logWriterThread)
+            {
+                ++numDroppedMessages_;
+                return;
+            }
+
+            Time::Sleep(1);
+        }
     }
     else
-        __android_log_print(error ? ANDROID_LOG_ERROR : ANDROID_LOG_INFO, "Urho3D", "%s", message.CString());
+    {
+        StoredLogMessage formattedMessage(message);
+        if (formattedMessage.threaded_)
+            FormatLogMessage(formattedMessage, timeStamp_);
+        WriteMessage(formattedMessage, true);
+    }
+}
+
+void Log::WriteMessage(const StoredLogMessage& message, bool flush)
+{
+    {
+        MutexLock lock(outputMutex_);
+
+        bool raw = message.level_ == LOG_RAW;
+        bool error = raw ? message.error_ : message.level_ == LOG_ERROR;
+
+#if defined(__ANDROID__)
+        const char* text = message.message_.CString() + message.textStart_;
+        if (!raw)
+            __android_log_print(ANDROID_LOG_VERBOSE + message.level_, "Urho3D", "%s", text);
+        else if (!quiet_ || error)
+            __android_log_print(error ? ANDROID_LOG_ERROR : ANDROID_LOG_INFO, "Urho3D", "%s", text);
 #elif defined(IOS) || defined(TVOS)
-    SDL_IOS_LogMessage(message.CString());
+        SDL_IOS_LogMessage(message.message_.CString() + message.textStart_);
 #else
-    if (logInstance->quiet_)
-    {
         // If in quiet mode, still print the error message to the standard error stream
-        if (error)
-            PrintUnicode(message, true);
-    }
-    else
-        PrintUnicode(message, error);
+        if (!quiet_ || error)
+        {
+            if (raw)
+                PrintUnicode(message.message_, error);
+            else
+                PrintUnicodeLine(message.message_, error);
+        }
 #endif
 
-    if (logInstance->logFile_)
+        if (logFile_)
+        {
+            if (raw)
+                logFile_->Write(message.message_.CString(), message.message_.Length());
+            else
+                logFile_->WriteLine(message.message_);
+            if (flush)
+                logFile_->Flush();
+        }
+    }
+
+    if (message.threaded_)
     {
-        logInstance->logFile_->Write(message.CString(), message.Length());
-        logInstance->logFile_->Flush();
+        MutexLock lock(logMutex_);
+        threadMessages_.Push(message);
     }
+}
 
-    logInstance->inWrite_ = true;
+bool Log::WriteQueuedMessages()
+{
+    writing_ = true;
 
-    using namespace LogMessage;
+    bool written = false;
+    StoredLogMessage message;
+    while (queue_->Pop(message))
+    {
+        if (message.threaded_)
+            FormatLogMessage(message, timeStamp_);
+        // Flush errors immediately so that they are not lost if the application crashes
+        bool error = message.level_ == LOG_RAW ? message.error_ : message.level_ == LOG_ERROR;
+        WriteMessage(message, error);
+        written = true;
+    }
 
-    VariantMap& eventData = logInstance->GetEventDataMap();
-    eventData[P_MESSAGE] = message;
-    eventData[P_LEVEL] = error ? LOG_ERROR : LOG_INFO;
-    logInstance->SendEvent(E_LOGMESSAGE, eventData);
+    unsigned numDroppedMessages = numDroppedMessages_.exchange(0);
+    if (numDroppedMessages)
+    {
+        StoredLogMessage warning("Discarded " + String(numDroppedMessages) + " log messages because the log queue was full",
+            LOG_WARNING, false, 0, true);
+        FormatLogMessage(warning, timeStamp_);
+        WriteMessage(warning, false);
+        written = true;
+    }
 
-    logInstance->inWrite_ = false;
+    // Flush the other messages once after writing all currently queued messages
+    if (written)
+    {
+        MutexLock lock(outputMutex_);
+        if (logFile_)
+            logFile_->Flush();
+    }
+
+    writing_ = false;
+    return written;
 }
 
 void Log::HandleEndFrame(StringHash eventType, VariantMap& eventData)
@@ -293,20 +537,36 @@ void Log::HandleEndFrame(StringHash eventType, VariantMap& eventData)
         return;
     }
 
-    MutexLock lock(logMutex_);
+    // If already sending log events, leave the messages from other threads to the next frame
+    if (inWrite_)
+        return;
 
-    // Process messages accumulated from other threads (if any)
-    while (!threadMessages_.Empty())
+    // Take the messages already written from other threads (if any), then send their log events without holding the lock
+    List<StoredLogMessage> messages;
     {
-        const StoredLogMessage& stored = threadMessages_.Front();
+        MutexLock lock(logMutex_);
+        messages.Swap(threadMessages_);
+    }
 
-        if (stored.level_ != LOG_RAW)
-            Write(stored.level_, stored.message_);
-        else
-            WriteRaw(stored.message_, stored.error_);
+    if (messages.Empty())
+        return;
 
-        threadMessages_.PopFront();
+    inWrite_ = true;
+
+    using namespace LogMessage;
+
+    for (List<StoredLogMessage>::ConstIterator i = messages.Begin(); i != messages.End(); ++i)
+    {
+        bool raw = i->level_ == LOG_RAW;
+        lastMessage_ = raw ? i->message_ : i->message_.Substring(i->textStart_);
+
+        VariantMap& messageData = GetEventDataMap();
+        messageData[P_MESSAGE] = i->message_;
+        messageData[P_LEVEL] = raw ? (i->error_ ? LOG_ERROR : LOG_INFO) : i->level_;
+        SendEvent(E_LOGMESSAGE, messageData);
     }
+
+    inWrite_ = false;
 }
 
 }
@@ -27,6 +27,8 @@
 #include "../Core/Object.h"
 #include "../Core/StringUtils.h"
 
+#include <atomic>
+
 namespace Urho3D
 {
 
@@ -45,28 +47,45 @@ static const int LOG_ERROR = 4;
 /// Disable all log messages.
 static const int LOG_NONE = 5;
 
+/// Behavior when the log message queue is full.
+enum LogQueuePolicy
+{
+    /// Discard the message. The number of discarded messages is logged once the queue has space again.
+    LOG_QUEUE_DROP = 0,
+    /// Wait until the log writer thread has made space in the queue.
+    LOG_QUEUE_BLOCK
+};
+
 class File;
+class LogQueue;
+class LogWriter;
 
-/// Stored log message from another thread.
+/// Log message queued for output.
 struct StoredLogMessage
 {
     /// Construct undefined.
     StoredLogMessage() = default;
 
     /// Construct with parameters.
-    StoredLogMessage(const String& message, int level, bool error) :
+    StoredLogMessage(const String& message, int level, bool error, unsigned textStart = 0, bool threaded = false) :
         message_(message),
         level_(level),
-        error_(error)
+        error_(error),
+        textStart_(textStart),
+        threaded_(threaded)
     {
     }
 
-    /// Message text.
+    /// Message text, including the timestamp and level prefix for other than raw messages.
     String message_;
     /// Message level. -1 for raw messages.
     int level_{};
     /// Error flag for raw messages.
     bool error_{};
+    /// Offset of the unformatted message in the text.
+    unsigned textStart_{};
+    /// Whether written from another thread than the main thread, in which case the main thread sends the log event at the end of the frame.
+    bool threaded_{};
 };
 
 /// Logging subsystem.
@@ -74,6 +93,8 @@ class URHO3D_API Log : public Object
 {
     URHO3D_OBJECT(Log, Object);
 
+    friend class LogWriter;
+
 public:
     /// Construct.
     explicit Log(Context* context);
@@ -93,6 +114,11 @@ public:
     /// Set quiet mode ie. only print error entries to standard error stream (which is normally redirected to console also). Output to log file is not affected by this mode.
     /// @property
     void SetQuiet(bool quiet);
+    /// Set behavior when the log message queue is full. Default is to wait.
+    /// @property
+    void SetQueuePolicy(LogQueuePolicy policy);
+    /// Wait until all queued log messages have been written to the console and the log file.
+    void Flush();
 
     /// Return logging level.
     /// @property
@@ -110,6 +136,13 @@ public:
     /// @property
     bool IsQuiet() const { return quiet_; }
 
+    /// Return behavior when the log message queue is full.
+    /// @property
+    LogQueuePolicy GetQueuePolicy() const { return queuePolicy_; }
+
+    /// Return whether messages of the level would be logged. Can be called from any thread.
+    static bool IsEnabled(int level);
+
     /// Write to the log. If logging level is higher than the level of the message, the message is ignored.
     /// @nobind
     static void Write(int level, const String& message);
@@ -117,21 +150,38 @@ public:
     static void WriteFormat(int level, const char* format, ...);
     /// Write raw output to the log.
     static void WriteRaw(const String& message, bool error = false);
-    /// Write to the log using the FormatString formatting syntax. Requires at least one argument so that curly braces do not need to be escaped for unformatted Log::Write.
+    /// Write to the log using the FormatString formatting syntax. Requires at least one argument so that curly braces do not need to be escaped for unformatted Log::Write. The message is not formatted if its level is not logged.
     template<typename Arg0, typename... Args>
     static void Write(int level, const char* format, Arg0&& arg0, Args&&... args)
     {
-        Write(level, FormatString(format, std::forward<Arg0>(arg0), std::forward<Args>(args)...));
+        if (IsEnabled(level))
+            Write(level, FormatString(format, std::forward<Arg0>(arg0), std::forward<Args>(args)...));
     }
 
 private:
-    /// Handle end of frame. Process the threaded log messages.
+    /// Handle end of frame. Send the log events of the messages from other threads.
     void HandleEndFrame(StringHash eventType, VariantMap& eventData);
-
-    /// Mutex for threaded operation.
-    Mutex logMutex_;
-    /// Log messages from other threads.
+    /// Queue a message for output, or write it immediately if the log writer thread is not running.
+    void QueueMessage(const StoredLogMessage& message);
+    /// Write a message to the console and the log file.
+    void WriteMessage(const StoredLogMessage& message, bool flush);
+    /// Write the queued messages to the console and the log file. Called by the log writer thread. Return true if any messages were written.
+    bool WriteQueuedMessages();
+
+    /// Mutex for the log messages from other threads.
+    Mutex logMutex_{"Log"};
+    /// Log messages from other threads that have been written, but whose log events have not been sent yet.
     List<StoredLogMessage> threadMessages_;
+    /// Mutex for the console and log file output.
+    Mutex outputMutex_;
+    /// Bounded queue of messages waiting for output.
+    UniquePtr<LogQueue> queue_;
+    /// Thread writing the queued messages.
+    UniquePtr<LogWriter> writer_;
+    /// Number of messages discarded because the queue was full.
+    std::atomic<unsigned> numDroppedMessages_;
+    /// Log writer thread busy flag.
+    std::atomic<bool> writing_;
     /// Log file.
     SharedPtr<File> logFile_;
     /// Last log message.
@@ -144,6 +194,8 @@ private:
     bool inWrite_;
     /// Quiet mode flag.
     bool quiet_;
+    /// Behavior when the log message queue is full.
+    LogQueuePolicy queuePolicy_;
 };
 
 #ifdef URHO3D_LOGGING
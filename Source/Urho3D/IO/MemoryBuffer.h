@@ -47,6 +47,8 @@ public:
     unsigned Seek(unsigned position) override;
     /// Write bytes to the memory area.
     unsigned Write(const void* data, unsigned size) override;
+    /// Return pointer to the data at the current position.
+    const unsigned char* GetReadPointer() const override { return buffer_ ? buffer_ + position_ : nullptr; }
 
     /// Return memory area.
     unsigned char* GetData() { return buffer_; }
@@ -23,18 +23,36 @@
 #include "../Precompiled.h"
 
 #include "../IO/File.h"
+#include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../IO/PackageFile.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace Urho3D
 {
 
+/// Return whether a file ID identifies a package file: uncompressed, compressed or compressed with a block index.
+static bool IsPackageID(const String& id)
+{
+    return id == "UPAK" || id == "ULZ4" || id == "ULZB";
+}
+
 PackageFile::PackageFile(Context* context) :
     Object(context),
     totalSize_(0),
     totalDataSize_(0),
     checksum_(0),
-    compressed_(false)
+    blockSize_(0),
+    compressed_(false),
+    memoryMapped_(false)
 {
 }
 
@@ -43,15 +61,73 @@ PackageFile::PackageFile(Context* context, const String& fileName, unsigned star
     totalSize_(0),
     totalDataSize_(0),
     checksum_(0),
-    compressed_(false)
+    blockSize_(0),
+    compressed_(false),
+    memoryMapped_(false)
 {
     Open(fileName, startOffset);
 }
 
+PackageMapping::PackageMapping(const String& fileName, unsigned size) :
+    data_(nullptr),
+    size_(0)
+{
+#ifdef __ANDROID__
+    if (URHO3D_IS_ASSET(fileName))
+        return;
+#endif
+
+    if (!size)
+        return;
+
+#ifdef _WIN32
+    HANDLE fileHandle = CreateFileW(GetWideNativePath(fileName).CString(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle != INVALID_HANDLE_VALUE)
+    {
+        // The view keeps the mapping alive, so both handles can be closed right away
+        HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle)
+        {
+            data_ = (unsigned char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, size);
+            CloseHandle(mappingHandle);
+        }
+        CloseHandle(fileHandle);
+    }
+#else
+    int fd = open(GetNativePath(fileName).CString(), O_RDONLY);
+    if (fd >= 0)
+    {
+        // The mapping stays valid after the descriptor is closed
+        void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data != MAP_FAILED)
+            data_ = (unsigned char*)data;
+        close(fd);
+    }
+#endif
+
+    if (data_)
+        size_ = size;
+}
+
+PackageMapping::~PackageMapping()
+{
+    if (!data_)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+#else
+    munmap(data_, size_);
+#endif
+}
+
 PackageFile::~PackageFile() = default;
 
 bool PackageFile::Open(const String& fileName, unsigned startOffset)
 {
+    mapping_.Reset();
+
     SharedPtr<File> file(new File(context_, fileName));
     if (!file->IsOpen())
         return false;
@@ -59,7 +135,7 @@ bool PackageFile::Open(const String& fileName, unsigned startOffset)
     // Check ID, then read the directory
     file->Seek(startOffset);
     String id = file->ReadFileID();
-    if (id != "UPAK" && id != "ULZ4")
+    if (!IsPackageID(id))
     {
         // If start offset has not been explicitly specified, also try to read package size from the end of file
         // to know how much we must rewind to find the package start
@@ -76,7 +152,7 @@ bool PackageFile::Open(const String& fileName, unsigned startOffset)
             }
         }
 
-        if (id != "UPAK" && id != "ULZ4")
+        if (!IsPackageID(id))
         {
             URHO3D_LOGERROR(fileName + " is not a valid package file");
             return false;
@@ -86,10 +162,11 @@ bool PackageFile::Open(const String& fileName, unsigned startOffset)
     fileName_ = fileName;
     nameHash_ = fileName_;
     totalSize_ = file->GetSize();
-    compressed_ = id == "ULZ4";
+    compressed_ = id != "UPAK";
 
     unsigned numFiles = file->ReadUInt();
     checksum_ = file->ReadUInt();
+    blockSize_ = id == "ULZB" ? file->ReadUInt() : 0;
 
     for (unsigned i = 0; i < numFiles; ++i)
     {
@@ -107,9 +184,35 @@ bool PackageFile::Open(const String& fileName, unsigned startOffset)
             entries_[entryName] = newEntry;
     }
 
+    if (memoryMapped_)
+        MapFile();
+
     return true;
 }
 
+void PackageFile::SetMemoryMapped(bool enable)
+{
+    if (enable == memoryMapped_)
+        return;
+
+    memoryMapped_ = enable;
+    if (!enable)
+        mapping_.Reset();
+    else if (!fileName_.Empty())
+        MapFile();
+}
+
+MemoryBuffer PackageFile::GetEntryBuffer(const String& fileName) const
+{
+    const PackageEntry* entry = mapping_ && !compressed_ ? GetEntry(fileName) : nullptr;
+    if (!entry)
+        return MemoryBuffer((const void*)nullptr, 0);
+
+    MemoryBuffer buffer(static_cast<const void*>(mapping_->GetData() + entry->offset_), entry->size_);
+    buffer.SetName(fileName);
+    return buffer;
+}
+
 bool PackageFile::Exists(const String& fileName) const
 {
     bool found = entries_.Find(fileName) != entries_.End();
@@ -153,4 +256,17 @@ const PackageEntry* PackageFile::GetEntry(const String& fileName) const
     return nullptr;
 }
 
+bool PackageFile::MapFile()
+{
+    mapping_ = new PackageMapping(fileName_, totalSize_);
+    if (!mapping_->GetData())
+    {
+        URHO3D_LOGWARNING("Could not memory map package file " + fileName_ + ", reading through the file instead");
+        mapping_.Reset();
+        return false;
+    }
+
+    return true;
+}
+
 }
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../Core/Object.h"
+#include "../IO/MemoryBuffer.h"
 
 namespace Urho3D
 {
@@ -38,6 +39,28 @@ struct PackageEntry
     unsigned checksum_;
 };
 
+/// Read-only memory mapping of a package file. Kept alive by the package and by the files opened from it.
+/// @nobind
+class URHO3D_API PackageMapping : public RefCounted
+{
+public:
+    /// Construct and map the whole file. Leaves the mapping empty on failure.
+    PackageMapping(const String& fileName, unsigned size);
+    /// Destruct. Release the mapping.
+    ~PackageMapping() override;
+
+    /// Return the mapped data, or null if mapping failed.
+    const unsigned char* GetData() const { return data_; }
+    /// Return the mapped size.
+    unsigned GetSize() const { return size_; }
+
+private:
+    /// Mapped data.
+    unsigned char* data_;
+    /// Mapped size.
+    unsigned size_;
+};
+
 /// Stores files of a directory tree sequentially for convenient access.
 class URHO3D_API PackageFile : public Object
 {
@@ -57,6 +80,12 @@ public:
     bool Exists(const String& fileName) const;
     /// Return the file entry corresponding to the name, or null if not found. This will be case-insensitive on Windows and case-sensitive on other platforms.
     const PackageEntry* GetEntry(const String& fileName) const;
+    /// Set whether to map the package file into memory. Files opened from a mapped package read from the mapping without file system calls.
+    /// @property
+    void SetMemoryMapped(bool enable);
+    /// Return a read-only view over the mapped data of an uncompressed file entry, valid while the package stays mapped. The view is empty if the package is not mapped, is compressed or the entry is not found.
+    /// @nobind
+    MemoryBuffer GetEntryBuffer(const String& fileName) const;
 
     /// Return all file entries.
     const HashMap<String, PackageEntry>& GetEntries() const { return entries_; }
@@ -88,10 +117,25 @@ public:
     /// @property
     bool IsCompressed() const { return compressed_; }
 
+    /// Return the uncompressed size of the compressed blocks when each compressed file entry starts with a block offset table, or 0 if the package has no block index.
+    /// @property
+    unsigned GetBlockSize() const { return blockSize_; }
+
+    /// Return whether the package file is mapped into memory.
+    /// @property
+    bool IsMemoryMapped() const { return mapping_.NotNull(); }
+
+    /// Return the memory mapping, or null if not mapped.
+    /// @nobind
+    PackageMapping* GetMapping() const { return mapping_; }
+
     /// Return list of file names in the package.
     const Vector<String> GetEntryNames() const { return entries_.Keys(); }
 
 private:
+    /// Map the package file into memory. Return true if successful.
+    bool MapFile();
+
     /// File entries.
     HashMap<String, PackageEntry> entries_;
     /// File name.
@@ -104,8 +148,14 @@ private:
     unsigned totalDataSize_;
     /// Package file checksum.
     unsigned checksum_;
+    /// Uncompressed block size of a block indexed compressed package, 0 if not indexed.
+    unsigned blockSize_;
+    /// Memory mapping of the package file.
+    SharedPtr<PackageMapping> mapping_;
     /// Compressed flag.
     bool compressed_;
+    /// Memory mapping requested flag.
+    bool memoryMapped_;
 };
 
 }
@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../IO/ScatterGatherBuffer.h"
+#include "../IO/VectorBuffer.h"
+
+namespace Urho3D
+{
+
+ScatterGatherBuffer::ScatterGatherBuffer() :
+    readSegment_(0),
+    readOffset_(0)
+{
+}
+
+unsigned ScatterGatherBuffer::Read(void* dest, unsigned size)
+{
+    if (size + position_ > size_)
+        size = size_ - position_;
+    if (!size)
+        return 0;
+
+    auto* destPtr = (unsigned char*)dest;
+    unsigned remaining = size;
+    while (remaining)
+    {
+        const Segment& segment = segments_[readSegment_];
+        unsigned copySize = Min(remaining, segment.size_ - readOffset_);
+        memcpy(destPtr, GetSegmentData(readSegment_) + readOffset_, copySize);
+        destPtr += copySize;
+        remaining -= copySize;
+        readOffset_ += copySize;
+        if (readOffset_ == segment.size_)
+        {
+            ++readSegment_;
+            readOffset_ = 0;
+        }
+    }
+
+    position_ += size;
+    return size;
+}
+
+unsigned ScatterGatherBuffer::Seek(unsigned position)
+{
+    if (position > size_)
+        position = size_;
+
+    readSegment_ = 0;
+    readOffset_ = position;
+    while (readSegment_ < segments_.Size() && readOffset_ >= segments_[readSegment_].size_)
+    {
+        readOffset_ -= segments_[readSegment_].size_;
+        ++readSegment_;
+    }
+
+    position_ = position;
+    return position_;
+}
+
+unsigned ScatterGatherBuffer::Write(const void* data, unsigned size)
+{
+    if (!size)
+        return 0;
+
+    unsigned offset = storage_.Size();
+    storage_.Resize(offset + size);
+    memcpy(&storage_[offset], data, size);
+
+    // Extend the last segment if it ends at the end of the storage
+    if (!segments_.Empty() && !segments_.Back().external_ && segments_.Back().offset_ + segments_.Back().size_ == offset)
+        segments_.Back().size_ += size;
+    else
+        segments_.Push(Segment{nullptr, offset, size});
+
+    size_ += size;
+    return size;
+}
+
+void ScatterGatherBuffer::WriteExternal(const void* data, unsigned size)
+{
+    if (!data || !size)
+        return;
+
+    segments_.Push(Segment{static_cast<const unsigned char*>(data), 0, size});
+    size_ += size;
+}
+
+void ScatterGatherBuffer::Clear()
+{
+    segments_.Clear();
+    storage_.Clear();
+    readSegment_ = 0;
+    readOffset_ = 0;
+    position_ = 0;
+    size_ = 0;
+}
+
+const unsigned char* ScatterGatherBuffer::GetSegmentData(unsigned index) const
+{
+    if (index >= segments_.Size())
+        return nullptr;
+
+    const Segment& segment = segments_[index];
+    return segment.external_ ? segment.external_ : storage_.Buffer() + segment.offset_;
+}
+
+void ScatterGatherBuffer::CopyTo(void* dest) const
+{
+    auto* destPtr = (unsigned char*)dest;
+    for (unsigned i = 0; i < segments_.Size(); ++i)
+    {
+        memcpy(destPtr, GetSegmentData(i), segments_[i].size_);
+        destPtr += segments_[i].size_;
+    }
+}
+
+void ScatterGatherBuffer::CopyTo(VectorBuffer& dest) const
+{
+    dest.Resize(size_);
+    if (size_)
+        CopyTo(dest.GetModifiableData());
+    dest.Seek(0);
+}
+
+}
@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../IO/AbstractFile.h"
+
+namespace Urho3D
+{
+
+class VectorBuffer;
+
+/// Buffer made of segments that can refer to external memory without copying it. Written data is appended at the end; reading and seeking work across the segments.
+class URHO3D_API ScatterGatherBuffer : public AbstractFile
+{
+public:
+    /// Construct an empty buffer.
+    ScatterGatherBuffer();
+
+    /// Read bytes from the buffer. Return number of bytes actually read.
+    unsigned Read(void* dest, unsigned size) override;
+    /// Set read position from the beginning of the buffer. Return actual new position.
+    unsigned Seek(unsigned position) override;
+    /// Append bytes, copying them to the buffer's own storage. Return number of bytes actually written.
+    unsigned Write(const void* data, unsigned size) override;
+
+    /// Append external memory without copying it. The memory must stay valid and unchanged as long as the buffer is used.
+    void WriteExternal(const void* data, unsigned size);
+    /// Reset to zero size.
+    void Clear();
+
+    /// Return number of segments.
+    unsigned GetNumSegments() const { return segments_.Size(); }
+    /// Return data of a segment.
+    const unsigned char* GetSegmentData(unsigned index) const;
+    /// Return size of a segment.
+    unsigned GetSegmentSize(unsigned index) const { return index < segments_.Size() ? segments_[index].size_ : 0; }
+
+    /// Copy all data to a memory area of at least GetSize() bytes.
+    void CopyTo(void* dest) const;
+    /// Copy all data to a vector buffer, replacing its contents.
+    void CopyTo(VectorBuffer& dest) const;
+
+private:
+    /// Part of the buffer's data.
+    struct Segment
+    {
+        /// External memory, or null if the data is in the buffer's own storage.
+        const unsigned char* external_;
+        /// Offset in the buffer's own storage.
+        unsigned offset_;
+        /// Size.
+        unsigned size_;
+    };
+
+    /// Data segments.
+    PODVector<Segment> segments_;
+    /// Storage for copied data.
+    PODVector<unsigned char> storage_;
+    /// Segment at the read position.
+    unsigned readSegment_;
+    /// Read position within the segment.
+    unsigned readOffset_;
+};
+
+}
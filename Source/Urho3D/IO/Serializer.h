@@ -131,6 +131,19 @@ public:
     bool WriteNetID(unsigned value);
     /// Write a text line. Char codes 13 & 10 will be automatically appended.
     bool WriteLine(const String& value);
+
+    /// Write an array of plain values in one call without conversion.
+    template <class T> bool WritePODArray(const T* data, unsigned count)
+    {
+        unsigned size = count * sizeof(T);
+        return Write(data, size) == size;
+    }
+
+    /// Write a vector of plain values in one call, with the element count encoded as VLE.
+    template <class T> bool WritePODVector(const PODVector<T>& value)
+    {
+        return WriteVLE(value.Size()) && WritePODArray(value.Buffer(), value.Size());
+    }
 };
 
 }
@@ -46,6 +46,8 @@ public:
     unsigned Seek(unsigned position) override;
     /// Write bytes to the buffer. Return number of bytes actually written.
     unsigned Write(const void* data, unsigned size) override;
+    /// Return pointer to the data at the current position.
+    const unsigned char* GetReadPointer() const override { return size_ ? buffer_.Buffer() + position_ : nullptr; }
 
     /// Set data from another buffer.
     void SetData(const PODVector<unsigned char>& data);
@@ -57,6 +59,8 @@ public:
     void Clear();
     /// Set size.
     void Resize(unsigned size);
+    /// Reserve space for the given total size, so that writing up to it does not reallocate.
+    void Reserve(unsigned size) { buffer_.Reserve(size); }
 
     /// Return data.
     const unsigned char* GetData() const { return size_ ? &buffer_[0] : nullptr; }
@@ -66,6 +70,8 @@ public:
 
     /// Return the buffer.
     const PODVector<unsigned char>& GetBuffer() const { return buffer_; }
+    /// Return the allocated size.
+    unsigned GetCapacity() const { return buffer_.Capacity(); }
 
 private:
     /// Dynamic data buffer.
@@ -68,6 +68,7 @@ const StringHash VAR_LAST_KEYSYM("VAR_LAST_KEYSYM");
 const StringHash VAR_SCREEN_JOYSTICK_ID("VAR_SCREEN_JOYSTICK_ID");
 
 const unsigned TOUCHID_MAX = 32;
+const int MAX_PENDING_EVENTS = 256;
 
 /// Convert SDL keycode if necessary.
 Key ConvertSDLKeyCode(int keySym, int scanCode)
@@ -1436,6 +1437,38 @@ int Input::GetMouseMoveY() const
         return 0;
 }
 
+IntVector2 Input::GetPendingMouseMove()
+{
+#ifndef __EMSCRIPTEN__
+    if (!initialized_ || touchEmulation_ || suppressNextMouseMove_)
+        return IntVector2::ZERO;
+
+    // Relative motion comes from the motion events, which are peeked without removing them from the queue
+    if (sdlMouseRelative_ || mouseVisible_ || mouseMode_ == MM_FREE)
+    {
+        SDL_PumpEvents();
+
+        SDL_Event events[MAX_PENDING_EVENTS];
+        int numEvents = SDL_PeepEvents(events, MAX_PENDING_EVENTS, SDL_PEEKEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+
+        IntVector2 move;
+        for (int i = 0; i < numEvents; ++i)
+        {
+            move.x_ += events[i].motion.xrel;
+            move.y_ += events[i].motion.yrel;
+        }
+
+        return IntVector2((int)(move.x_ * inputScale_.x_), (int)(move.y_ * inputScale_.y_));
+    }
+
+    // Otherwise the cursor was recentered in the update, and the movement is its offset from there
+    if (inputFocus_)
+        return GetMousePosition() - lastMousePosition_;
+#endif
+
+    return IntVector2::ZERO;
+}
+
 TouchState* Input::GetTouch(unsigned index) const
 {
     if (index >= touches_.Size())
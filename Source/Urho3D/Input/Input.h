@@ -284,6 +284,8 @@ public:
     /// Return mouse wheel movement since last frame.
     /// @property
     int GetMouseMoveWheel() const { return mouseMoveWheel_; }
+    /// Return mouse movement that has arrived since the input update of this frame. The operating system events are peeked but left queued, so the movement is still reported normally on the next frame. Used for late camera sampling just before rendering.
+    IntVector2 GetPendingMouseMove();
     /// Return input coordinate scaling. Should return non-unity on High DPI display.
     /// @property
     Vector2 GetInputScale() const { return inputScale_; }
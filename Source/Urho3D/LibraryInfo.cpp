@@ -45,6 +45,8 @@ const char* GetCompilerDefines()
 #endif
 #ifdef URHO3D_SSE
     "#define URHO3D_SSE\n"
+#elif defined(URHO3D_NEON)
+    "#define URHO3D_NEON\n"
 #endif
 #ifdef URHO3D_DATABASE_ODBC
     "#define URHO3D_DATABASE_ODBC\n"
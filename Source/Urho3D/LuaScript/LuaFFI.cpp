@@ -0,0 +1,250 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#ifdef URHO3D_LUAJIT
+
+#include "../LuaScript/LuaFFI.h"
+#include "../Scene/Component.h"
+#include "../Scene/Node.h"
+
+extern "C"
+{
+#include <lua.h>
+}
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+// The functions below are called from Lua through FFI function pointers, so they must only use C compatible parameter types.
+// Math values are passed through pointers to structs with the same layout as the Urho3D math classes; FFI calls with struct
+// arguments or return values by value are not compiled by the LuaJIT tracer.
+
+static unsigned NodeGetID(const Node* node)
+{
+    return node->GetID();
+}
+
+static bool NodeIsEnabled(const Node* node)
+{
+    return node->IsEnabled();
+}
+
+static void NodeSetEnabled(Node* node, bool enable)
+{
+    node->SetEnabled(enable);
+}
+
+static Node* NodeGetParent(const Node* node)
+{
+    return node->GetParent();
+}
+
+static void NodeGetPosition(const Node* node, Vector3* position)
+{
+    *position = node->GetPosition();
+}
+
+static void NodeSetPosition(Node* node, const Vector3* position)
+{
+    node->SetPosition(*position);
+}
+
+static void NodeGetRotation(const Node* node, Quaternion* rotation)
+{
+    *rotation = node->GetRotation();
+}
+
+static void NodeSetRotation(Node* node, const Quaternion* rotation)
+{
+    node->SetRotation(*rotation);
+}
+
+static void NodeGetScale(const Node* node, Vector3* scale)
+{
+    *scale = node->GetScale();
+}
+
+static void NodeSetScale(Node* node, const Vector3* scale)
+{
+    node->SetScale(*scale);
+}
+
+static void NodeGetDirection(const Node* node, Vector3* direction)
+{
+    *direction = node->GetDirection();
+}
+
+static void NodeSetTransform(Node* node, const Vector3* position, const Quaternion* rotation)
+{
+    node->SetTransform(*position, *rotation);
+}
+
+static void NodeGetWorldPosition(const Node* node, Vector3* position)
+{
+    *position = node->GetWorldPosition();
+}
+
+static void NodeSetWorldPosition(Node* node, const Vector3* position)
+{
+    node->SetWorldPosition(*position);
+}
+
+static void NodeGetWorldRotation(const Node* node, Quaternion* rotation)
+{
+    *rotation = node->GetWorldRotation();
+}
+
+static void NodeSetWorldRotation(Node* node, const Quaternion* rotation)
+{
+    node->SetWorldRotation(*rotation);
+}
+
+static void NodeGetWorldScale(const Node* node, Vector3* scale)
+{
+    *scale = node->GetWorldScale();
+}
+
+static void NodeSetWorldScale(Node* node, const Vector3* scale)
+{
+    node->SetWorldScale(*scale);
+}
+
+static void NodeGetWorldDirection(const Node* node, Vector3* direction)
+{
+    *direction = node->GetWorldDirection();
+}
+
+static void NodeTranslate(Node* node, const Vector3* delta, int space)
+{
+    node->Translate(*delta, (TransformSpace)space);
+}
+
+static void NodeRotate(Node* node, const Quaternion* delta, int space)
+{
+    node->Rotate(*delta, (TransformSpace)space);
+}
+
+static bool NodeLookAt(Node* node, const Vector3* target, const Vector3* up, int space)
+{
+    return node->LookAt(*target, *up, (TransformSpace)space);
+}
+
+static unsigned ComponentGetID(const Component* component)
+{
+    return component->GetID();
+}
+
+static bool ComponentIsEnabled(const Component* component)
+{
+    return component->IsEnabled();
+}
+
+static bool ComponentIsEnabledEffective(const Component* component)
+{
+    return component->IsEnabledEffective();
+}
+
+static void ComponentSetEnabled(Component* component, bool enable)
+{
+    component->SetEnabled(enable);
+}
+
+static Node* ComponentGetNode(const Component* component)
+{
+    return component->GetNode();
+}
+
+/// FFI function description.
+struct LuaFFIFunction
+{
+    /// Name in the API table.
+    const char* name_;
+    /// Function pointer.
+    void* function_;
+};
+
+#define URHO3D_LUA_FFI_FUNCTION(function) {#function, reinterpret_cast<void*>(&function)}
+
+static const LuaFFIFunction luaFFIFunctions[] =
+{
+    URHO3D_LUA_FFI_FUNCTION(NodeGetID),
+    URHO3D_LUA_FFI_FUNCTION(NodeIsEnabled),
+    URHO3D_LUA_FFI_FUNCTION(NodeSetEnabled),
+    URHO3D_LUA_FFI_FUNCTION(NodeGetParent),
+    URHO3D_LUA_FFI_FUNCTION(NodeGetPosition),
+    URHO3D_LUA_FFI_FUNCTION(NodeSetPosition),
+    URHO3D_LUA_FFI_FUNCTION(NodeGetRotation),
+    URHO3D_LUA_FFI_FUNCTION(NodeSetRotation),
+    URHO3D_LUA_FFI_FUNCTION(NodeGetScale),
+    URHO3D_LUA_FFI_FUNCTION(NodeSetScale),
+    URHO3D_LUA_FFI_FUNCTION(NodeGetDirection),
+    URHO3D_LUA_FFI_FUNCTION(NodeSetTransform),
+    URHO3D_LUA_FFI_FUNCTION(NodeGetWorldPosition),
+    URHO3D_LUA_FFI_FUNCTION(NodeSetWorldPosition),
+    URHO3D_LUA_FFI_FUNCTION(NodeGetWorldRotation),
+    URHO3D_LUA_FFI_FUNCTION(NodeSetWorldRotation),
+    URHO3D_LUA_FFI_FUNCTION(NodeGetWorldScale),
+    URHO3D_LUA_FFI_FUNCTION(NodeSetWorldScale),
+    URHO3D_LUA_FFI_FUNCTION(NodeGetWorldDirection),
+    URHO3D_LUA_FFI_FUNCTION(NodeTranslate),
+    URHO3D_LUA_FFI_FUNCTION(NodeRotate),
+    URHO3D_LUA_FFI_FUNCTION(NodeLookAt),
+    URHO3D_LUA_FFI_FUNCTION(ComponentGetID),
+    URHO3D_LUA_FFI_FUNCTION(ComponentIsEnabled),
+    URHO3D_LUA_FFI_FUNCTION(ComponentIsEnabledEffective),
+    URHO3D_LUA_FFI_FUNCTION(ComponentSetEnabled),
+    URHO3D_LUA_FFI_FUNCTION(ComponentGetNode),
+};
+
+#undef URHO3D_LUA_FFI_FUNCTION
+
+// The binding layer reinterprets the math classes as plain structs, so they must not gain padding or hidden members
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 layout does not match the FFI struct");
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 layout does not match the FFI struct");
+static_assert(sizeof(Vector4) == 4 * sizeof(float), "Vector4 layout does not match the FFI struct");
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion layout does not match the FFI struct");
+static_assert(sizeof(Color) == 4 * sizeof(float), "Color layout does not match the FFI struct");
+
+void RegisterLuaFFI(lua_State* L)
+{
+    lua_getglobal(L, "package");
+    lua_getfield(L, -1, "loaded");
+
+    lua_newtable(L);
+    for (const LuaFFIFunction& function : luaFFIFunctions)
+    {
+        lua_pushlightuserdata(L, function.function_);
+        lua_setfield(L, -2, function.name_);
+    }
+    lua_setfield(L, -2, "Urho3D.ffi.api");
+
+    lua_pop(L, 2);
+}
+
+}
+
+#endif
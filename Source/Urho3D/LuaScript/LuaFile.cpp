@@ -27,6 +27,7 @@
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../LuaScript/LuaFile.h"
+#include "../LuaScript/LuaScript.h"
 #include "../Core/ProcessUtils.h"
 #include "../IO/Serializer.h"
 
@@ -120,7 +121,7 @@ bool LuaFile::LoadAndExecute(lua_State* luaState)
     if (!LoadChunk(luaState))
         return false;
 
-    if (lua_pcall(luaState, 0, 0, 0))
+    if (LuaScript::ProtectedCall(luaState, 0, 0))
     {
         const char* message = lua_tostring(luaState, -1);
         URHO3D_LOGERROR("Lua Execute failed for {}: {}", GetName().CString(), message);
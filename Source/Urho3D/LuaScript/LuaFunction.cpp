@@ -88,7 +88,7 @@ bool LuaFunction::EndCall(int numReturns)
     int numArguments = numArguments_;
     numArguments_ = -1;
 
-    if (lua_pcall(luaState_, numArguments, numReturns, 0) != 0)
+    if (LuaScript::ProtectedCall(luaState_, numArguments, numReturns) != 0)
     {
         const char* message = lua_tostring(luaState_, -1);
         URHO3D_LOGERROR("Execute Lua function failed: {}", message);
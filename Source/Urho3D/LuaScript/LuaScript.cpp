@@ -25,10 +25,12 @@
 #include "../Core/CoreEvents.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/Profiler.h"
+#include "../Core/Timer.h"
 #include "../Engine/EngineEvents.h"
 #include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
+#include "../LuaScript/LuaFFI.h"
 #include "../LuaScript/LuaFile.h"
 #include "../LuaScript/LuaFunction.h"
 #include "../LuaScript/LuaScript.h"
@@ -135,6 +137,9 @@ LuaScript::LuaScript(Context* context) :
     tolua_Urho2DLuaAPI_open(luaState_);
 #endif
     tolua_LuaScriptLuaAPI_open(luaState_);
+#ifdef URHO3D_LUAJIT
+    RegisterLuaFFI(luaState_);
+#endif
 
     SetContext(luaState_, context_);
 
@@ -158,7 +163,10 @@ LuaScript::~LuaScript()
     coroutineUpdate_ = nullptr;
 
     if (luaState)
+    {
+        lua_sethook(luaState, nullptr, 0, 0);
         lua_close(luaState);
+    }
 }
 
 void LuaScript::AddEventHandler(const String& eventName, int index)
@@ -258,7 +266,7 @@ bool LuaScript::ExecuteString(const String& string)
 {
     URHO3D_PROFILE(ExecuteString);
 
-    if (luaL_dostring(luaState_, string.CString()))
+    if (luaL_loadstring(luaState_, string.CString()) || ProtectedCall(luaState_, 0, LUA_MULTRET))
     {
         const char* message = lua_tostring(luaState_, -1);
         URHO3D_LOGERROR("Execute Lua string failed: {}", message);
@@ -308,7 +316,7 @@ bool LuaScript::ExecuteRawFile(const String& fileName)
     if (!LoadRawFile(fileName))
         return false;
 
-    if (lua_pcall(luaState_, 0, 0, 0))
+    if (ProtectedCall(luaState_, 0, 0))
     {
         const char* message = lua_tostring(luaState_, -1);
         URHO3D_LOGERROR("Execute Lua file failed: {}", message);
@@ -337,6 +345,47 @@ void LuaScript::SetExecuteConsoleCommands(bool enable)
         UnsubscribeFromEvent(E_CONSOLECOMMAND);
 }
 
+void LuaScript::SetGCTimeBudget(unsigned usec)
+{
+    if (usec == gcTimeBudget_)
+        return;
+
+    gcTimeBudget_ = usec;
+    gcStatistics_ = LuaGCStatistics();
+    if (usec)
+        SubscribeToEvent(E_FRAMEIDLE, URHO3D_HANDLER(LuaScript, HandleFrameIdle));
+    else
+        UnsubscribeFromEvent(E_FRAMEIDLE);
+}
+
+void LuaScript::SetProfiling(bool enable)
+{
+    if (enable == profiling_)
+        return;
+
+    profiling_ = enable;
+    if (enable)
+    {
+        if (!profiler_)
+            profiler_ = new ScriptProfiler(GetSubsystem<Profiler>());
+        else
+            profiler_->Reset();
+
+        lua_sethook(luaState_, ProfileHook, LUA_MASKCALL | LUA_MASKRET, 0);
+    }
+    else
+    {
+        lua_sethook(luaState_, nullptr, 0, 0);
+        profiler_->EndCalls(0);
+        URHO3D_LOGINFO("Lua function profile:\n" + profiler_->PrintData());
+    }
+}
+
+String LuaScript::PrintProfilingData(unsigned maxFunctions) const
+{
+    return profiler_ ? profiler_->PrintData(maxFunctions) : String::EMPTY;
+}
+
 void LuaScript::RegisterLoader()
 {
     // Get package.loaders table
@@ -479,13 +528,45 @@ void LuaScript::HandlePostUpdate(StringHash eventType, VariantMap& eventData)
         coroutineUpdate_->EndCall();
     }
 
-    // Collect garbage
+    // Collect garbage, unless done with a time budget at the end of the frame
+    if (!gcTimeBudget_)
     {
         URHO3D_PROFILE(LuaCollectGarbage);
         lua_gc(luaState_, LUA_GCSTEP, 0);
     }
 }
 
+void LuaScript::HandleFrameIdle(StringHash eventType, VariantMap& eventData)
+{
+    using namespace FrameIdle;
+
+    URHO3D_PROFILE(LuaCollectGarbage);
+
+    int idleTime = eventData[P_TIMEBUDGET].GetInt();
+    long long budget = Max((long long)gcTimeBudget_, (long long)idleTime);
+
+    // Step until the time budget is used up, but finish at most one cycle per frame. The automatic collector stays enabled
+    // as a fallback, but as the steps here pay off its debt it rarely needs to run during the frame
+    HiresTimer timer;
+    long long elapsed = 0;
+    gcStatistics_.numSteps_ = 0;
+    for (;;)
+    {
+        ++gcStatistics_.numSteps_;
+        bool cycleFinished = lua_gc(luaState_, LUA_GCSTEP, 0) != 0;
+        elapsed = timer.GetUSec(false);
+        if (cycleFinished)
+            ++gcStatistics_.numCycles_;
+        if (cycleFinished || elapsed >= budget)
+            break;
+    }
+
+    gcStatistics_.memoryUse_ = (unsigned)lua_gc(luaState_, LUA_GCCOUNT, 0);
+    gcStatistics_.collectTime_ = elapsed / 1000.0f;
+
+    eventData[P_TIMEBUDGET] = (int)Max((long long)idleTime - elapsed, 0LL);
+}
+
 void LuaScript::HandleConsoleCommand(StringHash eventType, VariantMap& eventData)
 {
     using namespace ConsoleCommand;
@@ -533,6 +614,64 @@ bool LuaScript::PushLuaFunction(lua_State* L, const String& functionName)
     return true;
 }
 
+int LuaScript::ProtectedCall(lua_State* L, int numArguments, int numReturns)
+{
+    // Calls interrupted by an error do not generate return hooks, so end them after the protected call
+    LuaScript* luaScript = lua_gethook(L) == ProfileHook ? ::GetContext(L)->GetSubsystem<LuaScript>() : nullptr;
+    unsigned depth = luaScript ? luaScript->profiler_->GetDepth() : 0;
+
+    int result = lua_pcall(L, numArguments, numReturns, 0);
+    if (luaScript)
+        luaScript->profiler_->EndCalls(depth);
+
+    return result;
+}
+
+void LuaScript::ProfileHook(lua_State* L, lua_Debug* ar)
+{
+    Context* context = ::GetContext(L);
+    LuaScript* luaScript = context ? context->GetSubsystem<LuaScript>() : nullptr;
+    if (!luaScript || !luaScript->profiling_ || !lua_getinfo(L, "S", ar) || !strcmp(ar->what, "C"))
+        return;
+
+    // Identify the functions by their source and first line, which stay the same across the instantiated closures
+    unsigned key = StringHash::Calculate(ar->source, (unsigned)ar->linedefined);
+    ScriptProfiler* profiler = luaScript->profiler_.Get();
+    ScriptFunctionProfile* profile = nullptr;
+
+    HashMap<unsigned, ScriptFunctionProfile*>::ConstIterator i = luaScript->functionProfiles_.Find(key);
+    if (i != luaScript->functionProfiles_.End())
+        profile = i->second_;
+    else
+    {
+        // Functions that are not called again before returning are named on their first call instead
+        if (ar->event != LUA_HOOKCALL)
+            return;
+
+        String name;
+        if (!strcmp(ar->what, "main"))
+            name = ToString("main chunk (%s)", ar->short_src);
+        else
+        {
+            lua_getinfo(L, "n", ar);
+            name = ToString("%s (%s:%d)", ar->name ? ar->name : "?", ar->short_src, ar->linedefined);
+        }
+
+        profile = profiler->GetFunction(name);
+        luaScript->functionProfiles_[key] = profile;
+    }
+
+    if (ar->event == LUA_HOOKCALL)
+        profiler->BeginCall(profile, profile);
+    else if (profiler->IsOpen(profile))
+    {
+        // Also end the calls that left the function without return hooks, e.g. the tail calls
+        while (profiler->GetCurrentKey() != profile)
+            profiler->EndCall();
+        profiler->EndCall();
+    }
+}
+
 void RegisterLuaScriptLibrary(Context* context)
 {
     LuaFile::RegisterObject(context);
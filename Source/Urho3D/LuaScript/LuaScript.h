@@ -24,8 +24,10 @@
 
 #include "../Core/Context.h"
 #include "../Core/Object.h"
+#include "../Core/ScriptProfiler.h"
 #include "../LuaScript/LuaScriptEventListener.h"
 
+struct lua_Debug;
 struct lua_State;
 
 namespace Urho3D
@@ -37,6 +39,19 @@ class LuaFunction;
 class LuaScriptEventInvoker;
 class Scene;
 
+/// Garbage collection statistics of the Lua state when collecting with a time budget.
+struct URHO3D_API LuaGCStatistics
+{
+    /// Number of incremental collection steps on the latest frame.
+    unsigned numSteps_{};
+    /// Number of completed collection cycles since the time budget was set.
+    unsigned numCycles_{};
+    /// Memory in use by the Lua state in kilobytes.
+    unsigned memoryUse_{};
+    /// Collection time on the latest frame in milliseconds.
+    float collectTime_{};
+};
+
 /// Lua script subsystem.
 class URHO3D_API LuaScript : public Object, public LuaScriptEventListener
 {
@@ -83,6 +98,10 @@ public:
     bool ExecuteFunction(const String& functionName);
     /// Set whether to execute engine console commands as script code.
     void SetExecuteConsoleCommands(bool enable);
+    /// Set the minimum time in microseconds spent on incremental garbage collection each frame. The collection also uses the idle time until the frame limit reported by the engine. Zero (default) performs a single collection step on each post update instead.
+    void SetGCTimeBudget(unsigned usec);
+    /// Set whether to profile the time spent in each Lua function. Only calls on the main Lua state, not in coroutines, are profiled. Enabling clears the previous timings.
+    void SetProfiling(bool enable);
 
     /// Return Lua state.
     lua_State* GetState() const { return luaState_; }
@@ -95,8 +114,23 @@ public:
     /// Return whether is executing engine console commands as script code.
     bool GetExecuteConsoleCommands() const { return executeConsoleCommands_; }
 
+    /// Return the per-frame garbage collection time budget in microseconds.
+    unsigned GetGCTimeBudget() const { return gcTimeBudget_; }
+
+    /// Return garbage collection statistics. Only updated when collecting with a time budget.
+    const LuaGCStatistics& GetGCStatistics() const { return gcStatistics_; }
+
+    /// Return whether is profiling Lua functions.
+    bool IsProfiling() const { return profiling_; }
+    /// Return the Lua function profiler, or null if profiling has not been enabled.
+    ScriptProfiler* GetProfiler() const { return profiler_.Get(); }
+    /// Return the Lua function timings as text, sorted by descending self time.
+    String PrintProfilingData(unsigned maxFunctions = M_MAX_UNSIGNED) const;
+
     /// Push Lua function to stack. Return true if is successful. Return false on any error and an error string is pushed instead.
     static bool PushLuaFunction(lua_State* L, const String& functionName);
+    /// Call a function in protected mode like lua_pcall. The profiled calls interrupted by an error are ended afterward.
+    static int ProtectedCall(lua_State* L, int numArguments, int numReturns);
 
 private:
     /// Register loader.
@@ -107,6 +141,8 @@ private:
     void HandlePostUpdate(StringHash eventType, VariantMap& eventData);
     /// Handle a console command event.
     void HandleConsoleCommand(StringHash eventType, VariantMap& eventData);
+    /// Handle the frame idle event. Perform incremental garbage collection.
+    void HandleFrameIdle(StringHash eventType, VariantMap& eventData);
 
     /// At panic.
     static int AtPanic(lua_State* L);
@@ -114,6 +150,8 @@ private:
     static int Loader(lua_State* L);
     /// Print function.
     static int Print(lua_State* L);
+    /// Call and return hook for profiling.
+    static void ProfileHook(lua_State* L, lua_Debug* ar);
 
     /// Lua state.
     lua_State* luaState_;
@@ -127,6 +165,16 @@ private:
     HashMap<const void*, SharedPtr<LuaFunction> > functionPointerToFunctionMap_;
     /// Function name to function map.
     HashMap<String, SharedPtr<LuaFunction> > functionNameToFunctionMap_;
+    /// Per-frame garbage collection time budget in microseconds.
+    unsigned gcTimeBudget_{};
+    /// Garbage collection statistics.
+    LuaGCStatistics gcStatistics_;
+    /// Lua function profiler. Created when profiling is first enabled.
+    UniquePtr<ScriptProfiler> profiler_;
+    /// Function profiles by hash of the source and the first line of the function.
+    HashMap<unsigned, ScriptFunctionProfile*> functionProfiles_;
+    /// Lua function profiling flag.
+    bool profiling_{};
 };
 
 /// Register Lua script library objects.
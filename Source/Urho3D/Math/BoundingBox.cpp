@@ -154,6 +154,30 @@ BoundingBox BoundingBox::Transformed(const Matrix3x4& transform) const
     t2 = _mm_add_ps(_mm_unpacklo_ps(z, zero), _mm_unpackhi_ps(z, zero));
     __m128 newDir = _mm_add_ps(_mm_movelh_ps(t0, t2), _mm_movehl_ps(t2, t0));
     return BoundingBox(_mm_sub_ps(newCenter, newDir), _mm_add_ps(newCenter, newDir));
+#elif defined(URHO3D_NEON)
+    const float minData[4] = {min_.x_, min_.y_, min_.z_, 1.f};
+    const float maxData[4] = {max_.x_, max_.y_, max_.z_, 1.f};
+    float32x4_t minPt = vld1q_f32(minData);
+    float32x4_t centerPoint = vmulq_n_f32(vaddq_f32(minPt, vld1q_f32(maxData)), 0.5f);
+    float32x4_t halfSize = vsubq_f32(centerPoint, minPt);
+    float32x4_t m0 = vld1q_f32(&transform.m00_);
+    float32x4_t m1 = vld1q_f32(&transform.m10_);
+    float32x4_t m2 = vld1q_f32(&transform.m20_);
+    const float32x2_t zero = vdup_n_f32(0.f);
+    // Sum each row's products horizontally, leaving the fourth lane zero
+    float32x4_t r0 = vmulq_f32(m0, centerPoint);
+    float32x4_t r1 = vmulq_f32(m1, centerPoint);
+    float32x4_t r2 = vmulq_f32(m2, centerPoint);
+    float32x2_t t0 = vpadd_f32(vadd_f32(vget_low_f32(r0), vget_high_f32(r0)), vadd_f32(vget_low_f32(r1), vget_high_f32(r1)));
+    float32x2_t t2 = vpadd_f32(vadd_f32(vget_low_f32(r2), vget_high_f32(r2)), zero);
+    float32x4_t newCenter = vcombine_f32(t0, t2);
+    float32x4_t x = vabsq_f32(vmulq_f32(m0, halfSize));
+    float32x4_t y = vabsq_f32(vmulq_f32(m1, halfSize));
+    float32x4_t z = vabsq_f32(vmulq_f32(m2, halfSize));
+    t0 = vpadd_f32(vadd_f32(vget_low_f32(x), vget_high_f32(x)), vadd_f32(vget_low_f32(y), vget_high_f32(y)));
+    t2 = vpadd_f32(vadd_f32(vget_low_f32(z), vget_high_f32(z)), zero);
+    float32x4_t newDir = vcombine_f32(t0, t2);
+    return BoundingBox(vsubq_f32(newCenter, newDir), vaddq_f32(newCenter, newDir));
 #else
     Vector3 newCenter = transform * Center();
     Vector3 oldEdge = Size() * 0.5f;
@@ -27,6 +27,8 @@
 
 #ifdef URHO3D_SSE
 #include <xmmintrin.h>
+#elif defined(URHO3D_NEON)
+#include <arm_neon.h>
 #endif
 
 namespace Urho3D
@@ -86,6 +88,13 @@ public:
         _mm_storeu_ps(&min_.x_, min);
         _mm_storeu_ps(&max_.x_, max);
     }
+#elif defined(URHO3D_NEON)
+    /// @nobind
+    BoundingBox(float32x4_t min, float32x4_t max) noexcept
+    {
+        vst1q_f32(&min_.x_, min);
+        vst1q_f32(&max_.x_, max);
+    }
 #endif
 
     /// Construct from an array of vertices.
@@ -181,6 +190,11 @@ public:
         __m128 vec = _mm_set_ps(1.f, point.z_, point.y_, point.x_);
         _mm_storeu_ps(&min_.x_, _mm_min_ps(_mm_loadu_ps(&min_.x_), vec));
         _mm_storeu_ps(&max_.x_, _mm_max_ps(_mm_loadu_ps(&max_.x_), vec));
+#elif defined(URHO3D_NEON)
+        const float vecData[4] = {point.x_, point.y_, point.z_, 1.f};
+        float32x4_t vec = vld1q_f32(vecData);
+        vst1q_f32(&min_.x_, vminq_f32(vld1q_f32(&min_.x_), vec));
+        vst1q_f32(&max_.x_, vmaxq_f32(vld1q_f32(&max_.x_), vec));
 #else
         if (point.x_ < min_.x_)
             min_.x_ = point.x_;
@@ -203,6 +217,9 @@ public:
 #ifdef URHO3D_SSE
         _mm_storeu_ps(&min_.x_, _mm_min_ps(_mm_loadu_ps(&min_.x_), _mm_loadu_ps(&box.min_.x_)));
         _mm_storeu_ps(&max_.x_, _mm_max_ps(_mm_loadu_ps(&max_.x_), _mm_loadu_ps(&box.max_.x_)));
+#elif defined(URHO3D_NEON)
+        vst1q_f32(&min_.x_, vminq_f32(vld1q_f32(&min_.x_), vld1q_f32(&box.min_.x_)));
+        vst1q_f32(&max_.x_, vmaxq_f32(vld1q_f32(&max_.x_), vld1q_f32(&box.max_.x_)));
 #else
         if (box.min_.x_ < min_.x_)
             min_.x_ = box.min_.x_;
@@ -248,6 +265,9 @@ public:
 #ifdef URHO3D_SSE
         _mm_storeu_ps(&min_.x_, _mm_set1_ps(M_INFINITY));
         _mm_storeu_ps(&max_.x_, _mm_set1_ps(-M_INFINITY));
+#elif defined(URHO3D_NEON)
+        vst1q_f32(&min_.x_, vdupq_n_f32(M_INFINITY));
+        vst1q_f32(&max_.x_, vdupq_n_f32(-M_INFINITY));
 #else
         min_ = Vector3(M_INFINITY, M_INFINITY, M_INFINITY);
         max_ = Vector3(-M_INFINITY, -M_INFINITY, -M_INFINITY);
@@ -0,0 +1,306 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Math/MathKernels.h"
+
+#include <type_traits>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Advance a pointer by a stride in bytes.
+template <class T> static inline T* AdvanceBytes(T* ptr, unsigned stride)
+{
+    using BytePtr = typename std::conditional<std::is_const<T>::value, const unsigned char*, unsigned char*>::type;
+    return reinterpret_cast<T*>(reinterpret_cast<BytePtr>(ptr) + stride);
+}
+
+#ifdef URHO3D_SSE
+/// Return a * b + c, fused when the target supports FMA.
+static inline __m128 MulAdd(__m128 a, __m128 b, __m128 c)
+{
+#ifdef __FMA__
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+/// Return the transformed center and the new half-size of a box given as center and half-size, with zero fourth lanes.
+static inline void TransformCenterAndHalfSize(const Matrix3x4& transform, __m128 center, __m128 halfSize, __m128& newCenter,
+    __m128& newHalfSize)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 m0 = _mm_loadu_ps(&transform.m00_);
+    __m128 m1 = _mm_loadu_ps(&transform.m10_);
+    __m128 m2 = _mm_loadu_ps(&transform.m20_);
+    // The center has one in the fourth lane to pick up the translation
+    __m128 point = _mm_add_ps(center, _mm_set_ps(1.f, 0.f, 0.f, 0.f));
+    __m128 r0 = _mm_mul_ps(m0, point);
+    __m128 r1 = _mm_mul_ps(m1, point);
+    __m128 r2 = _mm_mul_ps(m2, point);
+    __m128 t0 = _mm_add_ps(_mm_unpacklo_ps(r0, r1), _mm_unpackhi_ps(r0, r1));
+    __m128 t2 = _mm_add_ps(_mm_unpacklo_ps(r2, zero), _mm_unpackhi_ps(r2, zero));
+    newCenter = _mm_add_ps(_mm_movelh_ps(t0, t2), _mm_movehl_ps(t2, t0));
+    __m128 x = _mm_and_ps(absMask, _mm_mul_ps(m0, halfSize));
+    __m128 y = _mm_and_ps(absMask, _mm_mul_ps(m1, halfSize));
+    __m128 z = _mm_and_ps(absMask, _mm_mul_ps(m2, halfSize));
+    t0 = _mm_add_ps(_mm_unpacklo_ps(x, y), _mm_unpackhi_ps(x, y));
+    t2 = _mm_add_ps(_mm_unpacklo_ps(z, zero), _mm_unpackhi_ps(z, zero));
+    newHalfSize = _mm_add_ps(_mm_movelh_ps(t0, t2), _mm_movehl_ps(t2, t0));
+}
+#elif defined(URHO3D_NEON)
+/// Return the horizontal sums of three vectors in the first three lanes, zero in the fourth.
+static inline float32x4_t HorizontalSum3(float32x4_t a, float32x4_t b, float32x4_t c)
+{
+    float32x2_t ab = vpadd_f32(vadd_f32(vget_low_f32(a), vget_high_f32(a)), vadd_f32(vget_low_f32(b), vget_high_f32(b)));
+    float32x2_t cc = vpadd_f32(vadd_f32(vget_low_f32(c), vget_high_f32(c)), vdup_n_f32(0.f));
+    return vcombine_f32(ab, cc);
+}
+
+/// Return the transformed center and the new half-size of a box given as center and half-size, with zero fourth lanes.
+static inline void TransformCenterAndHalfSize(const Matrix3x4& transform, float32x4_t center, float32x4_t halfSize,
+    float32x4_t& newCenter, float32x4_t& newHalfSize)
+{
+    const float one[4] = {0.f, 0.f, 0.f, 1.f};
+    float32x4_t m0 = vld1q_f32(&transform.m00_);
+    float32x4_t m1 = vld1q_f32(&transform.m10_);
+    float32x4_t m2 = vld1q_f32(&transform.m20_);
+    float32x4_t point = vaddq_f32(center, vld1q_f32(one));
+    newCenter = HorizontalSum3(vmulq_f32(m0, point), vmulq_f32(m1, point), vmulq_f32(m2, point));
+    newHalfSize = HorizontalSum3(vabsq_f32(vmulq_f32(m0, halfSize)), vabsq_f32(vmulq_f32(m1, halfSize)),
+        vabsq_f32(vmulq_f32(m2, halfSize)));
+}
+#endif
+
+void TransformPoints(const Matrix3x4& transform, const Vector3* src, Vector3* dest, unsigned count, unsigned srcStride,
+    unsigned destStride)
+{
+#ifdef URHO3D_SSE
+    // Transpose once, so that each point is the sum of the columns scaled by its coordinates
+    __m128 c0 = _mm_loadu_ps(&transform.m00_);
+    __m128 c1 = _mm_loadu_ps(&transform.m10_);
+    __m128 c2 = _mm_loadu_ps(&transform.m20_);
+    __m128 c3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);      // NOLINT(modernize-use-bool-literals)
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        __m128 r = MulAdd(c0, _mm_set1_ps(src->x_), MulAdd(c1, _mm_set1_ps(src->y_), MulAdd(c2, _mm_set1_ps(src->z_), c3)));
+        _mm_storel_pi(reinterpret_cast<__m64*>(&dest->x_), r);
+        _mm_store_ss(&dest->z_, _mm_movehl_ps(r, r));
+        src = AdvanceBytes(src, srcStride);
+        dest = AdvanceBytes(dest, destStride);
+    }
+#elif defined(URHO3D_NEON)
+    const float columns[16] = {
+        transform.m00_, transform.m10_, transform.m20_, 0.f,
+        transform.m01_, transform.m11_, transform.m21_, 0.f,
+        transform.m02_, transform.m12_, transform.m22_, 0.f,
+        transform.m03_, transform.m13_, transform.m23_, 0.f
+    };
+    const float32x4_t c0 = vld1q_f32(columns);
+    const float32x4_t c1 = vld1q_f32(columns + 4);
+    const float32x4_t c2 = vld1q_f32(columns + 8);
+    const float32x4_t c3 = vld1q_f32(columns + 12);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(c3, c0, src->x_), c1, src->y_), c2, src->z_);
+        vst1_f32(&dest->x_, vget_low_f32(r));
+        vst1q_lane_f32(&dest->z_, r, 2);
+        src = AdvanceBytes(src, srcStride);
+        dest = AdvanceBytes(dest, destStride);
+    }
+#else
+    for (unsigned i = 0; i < count; ++i)
+    {
+        *dest = transform * *src;
+        src = AdvanceBytes(src, srcStride);
+        dest = AdvanceBytes(dest, destStride);
+    }
+#endif
+}
+
+void TransformDirections(const Matrix3x4& transform, const Vector3* src, Vector3* dest, unsigned count, unsigned srcStride,
+    unsigned destStride)
+{
+#ifdef URHO3D_SSE
+    __m128 c0 = _mm_loadu_ps(&transform.m00_);
+    __m128 c1 = _mm_loadu_ps(&transform.m10_);
+    __m128 c2 = _mm_loadu_ps(&transform.m20_);
+    __m128 c3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);      // NOLINT(modernize-use-bool-literals)
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        __m128 r = MulAdd(c0, _mm_set1_ps(src->x_), MulAdd(c1, _mm_set1_ps(src->y_), _mm_mul_ps(c2, _mm_set1_ps(src->z_))));
+        _mm_storel_pi(reinterpret_cast<__m64*>(&dest->x_), r);
+        _mm_store_ss(&dest->z_, _mm_movehl_ps(r, r));
+        src = AdvanceBytes(src, srcStride);
+        dest = AdvanceBytes(dest, destStride);
+    }
+#elif defined(URHO3D_NEON)
+    const float columns[12] = {
+        transform.m00_, transform.m10_, transform.m20_, 0.f,
+        transform.m01_, transform.m11_, transform.m21_, 0.f,
+        transform.m02_, transform.m12_, transform.m22_, 0.f
+    };
+    const float32x4_t c0 = vld1q_f32(columns);
+    const float32x4_t c1 = vld1q_f32(columns + 4);
+    const float32x4_t c2 = vld1q_f32(columns + 8);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(c0, src->x_), c1, src->y_), c2, src->z_);
+        vst1_f32(&dest->x_, vget_low_f32(r));
+        vst1q_lane_f32(&dest->z_, r, 2);
+        src = AdvanceBytes(src, srcStride);
+        dest = AdvanceBytes(dest, destStride);
+    }
+#else
+    for (unsigned i = 0; i < count; ++i)
+    {
+        *dest = transform * Vector4(*src, 0.0f);
+        src = AdvanceBytes(src, srcStride);
+        dest = AdvanceBytes(dest, destStride);
+    }
+#endif
+}
+
+void TransformBoundingBoxes(const Matrix3x4* transforms, const BoundingBox* src, BoundingBox* dest, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+        dest[i] = src[i].Transformed(transforms[i]);
+}
+
+BoundingBox MergeTransformedBoundingBox(const BoundingBox& box, const Matrix3x4* transforms, unsigned count)
+{
+#ifdef URHO3D_SSE
+    // The center and half-size are shared by all transforms, and the union is accumulated in registers
+    __m128 minPt = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&box.min_.x_), _mm_set_ss(box.min_.z_));
+    __m128 maxPt = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&box.max_.x_), _mm_set_ss(box.max_.z_));
+    __m128 center = _mm_mul_ps(_mm_add_ps(minPt, maxPt), _mm_set1_ps(0.5f));
+    __m128 halfSize = _mm_sub_ps(center, minPt);
+    __m128 unionMin = _mm_set1_ps(M_INFINITY);
+    __m128 unionMax = _mm_set1_ps(-M_INFINITY);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        __m128 newCenter, newHalfSize;
+        TransformCenterAndHalfSize(transforms[i], center, halfSize, newCenter, newHalfSize);
+        unionMin = _mm_min_ps(unionMin, _mm_sub_ps(newCenter, newHalfSize));
+        unionMax = _mm_max_ps(unionMax, _mm_add_ps(newCenter, newHalfSize));
+    }
+
+    return BoundingBox(unionMin, unionMax);
+#elif defined(URHO3D_NEON)
+    const float minData[4] = {box.min_.x_, box.min_.y_, box.min_.z_, 0.f};
+    const float maxData[4] = {box.max_.x_, box.max_.y_, box.max_.z_, 0.f};
+    float32x4_t minPt = vld1q_f32(minData);
+    float32x4_t center = vmulq_n_f32(vaddq_f32(minPt, vld1q_f32(maxData)), 0.5f);
+    float32x4_t halfSize = vsubq_f32(center, minPt);
+    float32x4_t unionMin = vdupq_n_f32(M_INFINITY);
+    float32x4_t unionMax = vdupq_n_f32(-M_INFINITY);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        float32x4_t newCenter, newHalfSize;
+        TransformCenterAndHalfSize(transforms[i], center, halfSize, newCenter, newHalfSize);
+        unionMin = vminq_f32(unionMin, vsubq_f32(newCenter, newHalfSize));
+        unionMax = vmaxq_f32(unionMax, vaddq_f32(newCenter, newHalfSize));
+    }
+
+    return BoundingBox(unionMin, unionMax);
+#else
+    BoundingBox ret;
+    for (unsigned i = 0; i < count; ++i)
+        ret.Merge(box.Transformed(transforms[i]));
+    return ret;
+#endif
+}
+
+void MultiplyMatrices(const Matrix3x4* lhs, const Matrix3x4* rhs, Matrix3x4* dest, unsigned count, unsigned lhsStride,
+    unsigned rhsStride, unsigned destStride)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        // The product is complete before it is stored, so the destination may alias either source
+        Matrix3x4 product = *lhs * *rhs;
+        *dest = product;
+        lhs = AdvanceBytes(lhs, lhsStride);
+        rhs = AdvanceBytes(rhs, rhsStride);
+        dest = AdvanceBytes(dest, destStride);
+    }
+}
+
+void MultiplyMatrices(const Matrix3x4& lhs, const Matrix3x4* rhs, Matrix3x4* dest, unsigned count)
+{
+#ifdef URHO3D_SSE
+    // Broadcast the left-hand elements once. Its translation only contributes to the fourth lane of each row
+    const __m128 l00 = _mm_set1_ps(lhs.m00_), l01 = _mm_set1_ps(lhs.m01_), l02 = _mm_set1_ps(lhs.m02_);
+    const __m128 l10 = _mm_set1_ps(lhs.m10_), l11 = _mm_set1_ps(lhs.m11_), l12 = _mm_set1_ps(lhs.m12_);
+    const __m128 l20 = _mm_set1_ps(lhs.m20_), l21 = _mm_set1_ps(lhs.m21_), l22 = _mm_set1_ps(lhs.m22_);
+    const __m128 t0 = _mm_set_ps(lhs.m03_, 0.f, 0.f, 0.f);
+    const __m128 t1 = _mm_set_ps(lhs.m13_, 0.f, 0.f, 0.f);
+    const __m128 t2 = _mm_set_ps(lhs.m23_, 0.f, 0.f, 0.f);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        __m128 r0 = _mm_loadu_ps(&rhs[i].m00_);
+        __m128 r1 = _mm_loadu_ps(&rhs[i].m10_);
+        __m128 r2 = _mm_loadu_ps(&rhs[i].m20_);
+        _mm_storeu_ps(&dest[i].m00_, MulAdd(l00, r0, MulAdd(l01, r1, MulAdd(l02, r2, t0))));
+        _mm_storeu_ps(&dest[i].m10_, MulAdd(l10, r0, MulAdd(l11, r1, MulAdd(l12, r2, t1))));
+        _mm_storeu_ps(&dest[i].m20_, MulAdd(l20, r0, MulAdd(l21, r1, MulAdd(l22, r2, t2))));
+    }
+#elif defined(URHO3D_NEON)
+    const float translation[12] = {0.f, 0.f, 0.f, lhs.m03_, 0.f, 0.f, 0.f, lhs.m13_, 0.f, 0.f, 0.f, lhs.m23_};
+    const float32x4_t t0 = vld1q_f32(translation);
+    const float32x4_t t1 = vld1q_f32(translation + 4);
+    const float32x4_t t2 = vld1q_f32(translation + 8);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        float32x4_t r0 = vld1q_f32(&rhs[i].m00_);
+        float32x4_t r1 = vld1q_f32(&rhs[i].m10_);
+        float32x4_t r2 = vld1q_f32(&rhs[i].m20_);
+        vst1q_f32(&dest[i].m00_, vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(t0, r0, lhs.m00_), r1, lhs.m01_), r2, lhs.m02_));
+        vst1q_f32(&dest[i].m10_, vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(t1, r0, lhs.m10_), r1, lhs.m11_), r2, lhs.m12_));
+        vst1q_f32(&dest[i].m20_, vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(t2, r0, lhs.m20_), r1, lhs.m21_), r2, lhs.m22_));
+    }
+#else
+    for (unsigned i = 0; i < count; ++i)
+    {
+        Matrix3x4 product = lhs * rhs[i];
+        dest[i] = product;
+    }
+#endif
+}
+
+}
@@ -0,0 +1,47 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Math/BoundingBox.h"
+#include "../Math/Matrix3x4.h"
+
+namespace Urho3D
+{
+
+/// Transform positions by a matrix. Strides are in bytes, so the vectors may be members of larger vertex structures. Source and destination may be the same array.
+URHO3D_API void TransformPoints(const Matrix3x4& transform, const Vector3* src, Vector3* dest, unsigned count,
+    unsigned srcStride = sizeof(Vector3), unsigned destStride = sizeof(Vector3));
+/// Transform direction vectors by a matrix, ignoring its translation. Strides are in bytes. Source and destination may be the same array.
+URHO3D_API void TransformDirections(const Matrix3x4& transform, const Vector3* src, Vector3* dest, unsigned count,
+    unsigned srcStride = sizeof(Vector3), unsigned destStride = sizeof(Vector3));
+/// Transform bounding boxes, each by its own matrix. Source and destination may be the same array.
+URHO3D_API void TransformBoundingBoxes(const Matrix3x4* transforms, const BoundingBox* src, BoundingBox* dest, unsigned count);
+/// Return the union of a bounding box transformed by each of the matrices. Returns an undefined box if count is zero.
+URHO3D_API BoundingBox MergeTransformedBoundingBox(const BoundingBox& box, const Matrix3x4* transforms, unsigned count);
+/// Multiply matrices pairwise into dest. Strides are in bytes. Destination may be the same array as either source.
+URHO3D_API void MultiplyMatrices(const Matrix3x4* lhs, const Matrix3x4* rhs, Matrix3x4* dest, unsigned count,
+    unsigned lhsStride = sizeof(Matrix3x4), unsigned rhsStride = sizeof(Matrix3x4), unsigned destStride = sizeof(Matrix3x4));
+/// Multiply each matrix of an array by a common left-hand matrix into dest. Destination may be the same array as the source.
+URHO3D_API void MultiplyMatrices(const Matrix3x4& lhs, const Matrix3x4* rhs, Matrix3x4* dest, unsigned count);
+
+}
@@ -27,6 +27,11 @@
 
 #ifdef URHO3D_SSE
 #include <emmintrin.h>
+#ifdef __FMA__
+#include <immintrin.h>
+#endif
+#elif defined(URHO3D_NEON)
+#include <arm_neon.h>
 #endif
 
 namespace Urho3D
@@ -275,6 +280,18 @@ public:
             _mm_cvtss_f32(vec),
             _mm_cvtss_f32(_mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 1, 1, 1))),
             _mm_cvtss_f32(_mm_movehl_ps(vec, vec)));
+#elif defined(URHO3D_NEON)
+        const float vecData[4] = {rhs.x_, rhs.y_, rhs.z_, 1.f};
+        float32x4_t vec = vld1q_f32(vecData);
+        float32x4_t r0 = vmulq_f32(vld1q_f32(&m00_), vec);
+        float32x4_t r1 = vmulq_f32(vld1q_f32(&m10_), vec);
+        float32x4_t r2 = vmulq_f32(vld1q_f32(&m20_), vec);
+        float32x4_t r3 = vmulq_f32(vld1q_f32(&m30_), vec);
+        float32x2_t s01 = vpadd_f32(vadd_f32(vget_low_f32(r0), vget_high_f32(r0)), vadd_f32(vget_low_f32(r1), vget_high_f32(r1)));
+        float32x2_t s23 = vpadd_f32(vadd_f32(vget_low_f32(r2), vget_high_f32(r2)), vadd_f32(vget_low_f32(r3), vget_high_f32(r3)));
+        float invW = 1.0f / vget_lane_f32(s23, 1);
+
+        return Vector3(vget_lane_f32(s01, 0) * invW, vget_lane_f32(s01, 1) * invW, vget_lane_f32(s23, 0) * invW);
 #else
         float invW = 1.0f / (m30_ * rhs.x_ + m31_ * rhs.y_ + m32_ * rhs.z_ + m33_);
 
@@ -306,6 +323,18 @@ public:
         Vector4 ret;
         _mm_storeu_ps(&ret.x_, vec);
         return ret;
+#elif defined(URHO3D_NEON)
+        float32x4_t vec = vld1q_f32(&rhs.x_);
+        float32x4_t r0 = vmulq_f32(vld1q_f32(&m00_), vec);
+        float32x4_t r1 = vmulq_f32(vld1q_f32(&m10_), vec);
+        float32x4_t r2 = vmulq_f32(vld1q_f32(&m20_), vec);
+        float32x4_t r3 = vmulq_f32(vld1q_f32(&m30_), vec);
+        float32x2_t s01 = vpadd_f32(vadd_f32(vget_low_f32(r0), vget_high_f32(r0)), vadd_f32(vget_low_f32(r1), vget_high_f32(r1)));
+        float32x2_t s23 = vpadd_f32(vadd_f32(vget_low_f32(r2), vget_high_f32(r2)), vadd_f32(vget_low_f32(r3), vget_high_f32(r3)));
+
+        Vector4 ret;
+        vst1q_f32(&ret.x_, vcombine_f32(s01, s23));
+        return ret;
 #else
         return Vector4(
             m00_ * rhs.x_ + m01_ * rhs.y_ + m02_ * rhs.z_ + m03_ * rhs.w_,
@@ -416,7 +445,35 @@ public:
     /// Multiply a matrix.
     Matrix4 operator *(const Matrix4& rhs) const
     {
-#ifdef URHO3D_SSE
+#if defined(URHO3D_SSE) && defined(__FMA__)
+        Matrix4 out;
+
+        const __m128 r0 = _mm_loadu_ps(&rhs.m00_);
+        const __m128 r1 = _mm_loadu_ps(&rhs.m10_);
+        const __m128 r2 = _mm_loadu_ps(&rhs.m20_);
+        const __m128 r3 = _mm_loadu_ps(&rhs.m30_);
+        __m128 l = _mm_loadu_ps(&m00_);
+        _mm_storeu_ps(&out.m00_, _mm_add_ps(
+            _mm_fmadd_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0)), r0, _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1)), r1)),
+            _mm_fmadd_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2)), r2, _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)), r3))));
+
+        l = _mm_loadu_ps(&m10_);
+        _mm_storeu_ps(&out.m10_, _mm_add_ps(
+            _mm_fmadd_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0)), r0, _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1)), r1)),
+            _mm_fmadd_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2)), r2, _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)), r3))));
+
+        l = _mm_loadu_ps(&m20_);
+        _mm_storeu_ps(&out.m20_, _mm_add_ps(
+            _mm_fmadd_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0)), r0, _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1)), r1)),
+            _mm_fmadd_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2)), r2, _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)), r3))));
+
+        l = _mm_loadu_ps(&m30_);
+        _mm_storeu_ps(&out.m30_, _mm_add_ps(
+            _mm_fmadd_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0)), r0, _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1)), r1)),
+            _mm_fmadd_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2)), r2, _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)), r3))));
+
+        return out;
+#elif defined(URHO3D_SSE)
         Matrix4 out;
 
         __m128 r0 = _mm_loadu_ps(&rhs.m00_);
@@ -452,6 +509,30 @@ public:
         t3 = _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)), r3);
         _mm_storeu_ps(&out.m30_, _mm_add_ps(_mm_add_ps(t0, t1), _mm_add_ps(t2, t3)));
 
+        return out;
+#elif defined(URHO3D_NEON)
+        Matrix4 out;
+
+        const float32x4_t r0 = vld1q_f32(&rhs.m00_);
+        const float32x4_t r1 = vld1q_f32(&rhs.m10_);
+        const float32x4_t r2 = vld1q_f32(&rhs.m20_);
+        const float32x4_t r3 = vld1q_f32(&rhs.m30_);
+        float32x4_t l = vld1q_f32(&m00_);
+        vst1q_f32(&out.m00_, vaddq_f32(vmlaq_lane_f32(vmulq_lane_f32(r0, vget_low_f32(l), 0), r1, vget_low_f32(l), 1),
+            vmlaq_lane_f32(vmulq_lane_f32(r2, vget_high_f32(l), 0), r3, vget_high_f32(l), 1)));
+
+        l = vld1q_f32(&m10_);
+        vst1q_f32(&out.m10_, vaddq_f32(vmlaq_lane_f32(vmulq_lane_f32(r0, vget_low_f32(l), 0), r1, vget_low_f32(l), 1),
+            vmlaq_lane_f32(vmulq_lane_f32(r2, vget_high_f32(l), 0), r3, vget_high_f32(l), 1)));
+
+        l = vld1q_f32(&m20_);
+        vst1q_f32(&out.m20_, vaddq_f32(vmlaq_lane_f32(vmulq_lane_f32(r0, vget_low_f32(l), 0), r1, vget_low_f32(l), 1),
+            vmlaq_lane_f32(vmulq_lane_f32(r2, vget_high_f32(l), 0), r3, vget_high_f32(l), 1)));
+
+        l = vld1q_f32(&m30_);
+        vst1q_f32(&out.m30_, vaddq_f32(vmlaq_lane_f32(vmulq_lane_f32(r0, vget_low_f32(l), 0), r1, vget_low_f32(l), 1),
+            vmlaq_lane_f32(vmulq_lane_f32(r2, vget_high_f32(l), 0), r3, vget_high_f32(l), 1)));
+
         return out;
 #else
         return Matrix4(
@@ -592,6 +673,14 @@ public:
         _mm_storeu_ps(&out.m20_, m2);
         _mm_storeu_ps(&out.m30_, m3);
         return out;
+#elif defined(URHO3D_NEON)
+        float32x4x4_t rows = vld4q_f32(&m00_);
+        Matrix4 out;
+        vst1q_f32(&out.m00_, rows.val[0]);
+        vst1q_f32(&out.m10_, rows.val[1]);
+        vst1q_f32(&out.m20_, rows.val[2]);
+        vst1q_f32(&out.m30_, rows.val[3]);
+        return out;
 #else
         return Matrix4(
             m00_,
@@ -24,7 +24,6 @@
 
 #include "../Math/MathDefs.h"
 #include "../Math/StringHash.h"
-#include "../Container/HashMap.h"
 #include "../Core/StringHashRegister.h"
 #include "../IO/Log.h"
 
@@ -37,14 +36,13 @@ namespace Urho3D
 
 #ifdef URHO3D_HASH_DEBUG
 
-// Expose map to let Visual Studio debugger access it if Urho3D is linked statically.
-const StringMap* hashReverseMap = nullptr;
+/// Number of entries in the global register, which takes 64 bytes each.
+static const unsigned GLOBAL_REGISTER_CAPACITY = 16384;
 
 // Hide static global variables in functions to ensure initialization order.
-static StringHashRegister& GetGlobalStringHashRegister()
+static BoundedStringHashRegister& GetGlobalStringHashRegister()
 {
-    static StringHashRegister stringHashRegister(true /*thread safe*/ );
-    hashReverseMap = &stringHashRegister.GetInternalMap();
+    static BoundedStringHashRegister stringHashRegister(GLOBAL_REGISTER_CAPACITY);
     return stringHashRegister;
 }
 
@@ -52,13 +50,13 @@ static StringHashRegister& GetGlobalStringHashRegister()
 
 const StringHash StringHash::ZERO;
 
+#ifdef URHO3D_HASH_DEBUG
 StringHash::StringHash(const char* str) noexcept :
     value_(Calculate(str))
 {
-#ifdef URHO3D_HASH_DEBUG
     Urho3D::GetGlobalStringHashRegister().RegisterString(*this, str);
-#endif
 }
+#endif
 
 StringHash::StringHash(const String& str) noexcept :
     value_(Calculate(str.CString()))
@@ -68,20 +66,7 @@ StringHash::StringHash(const String& str) noexcept :
 #endif
 }
 
-unsigned StringHash::Calculate(const char* str, unsigned hash)
-{
-    if (!str)
-        return hash;
-
-    while (*str)
-    {
-        hash = SDBMHash(hash, (unsigned char)*str++);
-    }
-
-    return hash;
-}
-
-StringHashRegister* StringHash::GetGlobalStringHashRegister()
+BoundedStringHashRegister* StringHash::GetGlobalStringHashRegister()
 {
 #ifdef URHO3D_HASH_DEBUG
     return &Urho3D::GetGlobalStringHashRegister();
@@ -23,18 +23,21 @@
 #pragma once
 
 #include "../Container/Str.h"
+#include "../Math/MathDefs.h"
+
+#include <cstddef>
 
 namespace Urho3D
 {
 
-class StringHashRegister;
+class BoundedStringHashRegister;
 
-/// 32-bit hash value for a string.
+/// 32-bit hash value for a string. Hashing a string literal is a constant expression unless URHO3D_HASH_DEBUG is on, so static hashes such as event parameters are initialized at compile time.
 class URHO3D_API StringHash
 {
 public:
     /// Construct with zero value.
-    StringHash() noexcept :
+    constexpr StringHash() noexcept :
         value_(0)
     {
     }
@@ -43,13 +46,21 @@ public:
     StringHash(const StringHash& rhs) noexcept = default;
 
     /// Construct with an initial value.
-    explicit StringHash(unsigned value) noexcept :
+    explicit constexpr StringHash(unsigned value) noexcept :
         value_(value)
     {
     }
 
-    /// Construct from a C string.
+#ifdef URHO3D_HASH_DEBUG
+    /// Construct from a C string and register it for reversing.
     StringHash(const char* str) noexcept;        // NOLINT(google-explicit-constructor)
+#else
+    /// Construct from a C string.
+    constexpr StringHash(const char* str) noexcept :     // NOLINT(google-explicit-constructor)
+        value_(Calculate(str))
+    {
+    }
+#endif
     /// Construct from a string.
     StringHash(const String& str) noexcept;      // NOLINT(google-explicit-constructor)
 
@@ -72,23 +83,23 @@ public:
     }
 
     /// Test for equality with another hash.
-    bool operator ==(const StringHash& rhs) const { return value_ == rhs.value_; }
+    constexpr bool operator ==(const StringHash& rhs) const { return value_ == rhs.value_; }
 
     /// Test for inequality with another hash.
-    bool operator !=(const StringHash& rhs) const { return value_ != rhs.value_; }
+    constexpr bool operator !=(const StringHash& rhs) const { return value_ != rhs.value_; }
 
     /// Test if less than another hash.
-    bool operator <(const StringHash& rhs) const { return value_ < rhs.value_; }
+    constexpr bool operator <(const StringHash& rhs) const { return value_ < rhs.value_; }
 
     /// Test if greater than another hash.
-    bool operator >(const StringHash& rhs) const { return value_ > rhs.value_; }
+    constexpr bool operator >(const StringHash& rhs) const { return value_ > rhs.value_; }
 
     /// Return true if nonzero hash value.
-    explicit operator bool() const { return value_ != 0; }
+    explicit constexpr operator bool() const { return value_ != 0; }
 
     /// Return hash value.
     /// @property
-    unsigned Value() const { return value_; }
+    constexpr unsigned Value() const { return value_; }
 
     /// Return as string.
     String ToString() const;
@@ -97,13 +108,22 @@ public:
     String Reverse() const;
 
     /// Return hash value for HashSet & HashMap.
-    unsigned ToHash() const { return value_; }
+    constexpr unsigned ToHash() const { return value_; }
 
     /// Calculate hash value from a C string.
-    static unsigned Calculate(const char* str, unsigned hash = 0);
+    static constexpr unsigned Calculate(const char* str, unsigned hash = 0)
+    {
+        if (!str)
+            return hash;
+
+        while (*str)
+            hash = SDBMHash(hash, (unsigned char)*str++);
 
-    /// Get global StringHashRegister. Use for debug purposes only. Return nullptr if URHO3D_HASH_DEBUG is off.
-    static StringHashRegister* GetGlobalStringHashRegister();
+        return hash;
+    }
+
+    /// Get global register of hashed strings. Use for debug purposes only. Return nullptr if URHO3D_HASH_DEBUG is off.
+    static BoundedStringHashRegister* GetGlobalStringHashRegister();
 
     /// Zero hash.
     static const StringHash ZERO;
@@ -113,4 +133,7 @@ private:
     unsigned value_;
 };
 
+/// Hash a string literal at compile time, also when URHO3D_HASH_DEBUG is on. The string is not registered for reversing.
+constexpr StringHash operator "" _hash(const char* str, std::size_t /*length*/) { return StringHash(StringHash::Calculate(str)); }
+
 }
@@ -263,7 +263,8 @@ void CrowdAgent::UpdateParameters(unsigned scope)
             params.obstacleAvoidanceType = (unsigned char)obstacleAvoidanceType_;
         }
 
-        crowdManager_->GetCrowd()->updateAgentParameters(agentCrowdId_, &params);
+        int index;
+        crowdManager_->GetAgentCrowd(agentCrowdId_, index)->updateAgentParameters(index, &params);
     }
 }
 
@@ -337,7 +338,10 @@ void CrowdAgent::SetTargetPosition(const Vector3& position)
         {
             dtPolyRef nearestRef;
             Vector3 nearestPos = crowdManager_->FindNearestPoint(position, queryFilterType_, &nearestRef);
-            crowdManager_->GetCrowd()->requestMoveTarget(agentCrowdId_, nearestRef, nearestPos.Data());
+            int index;
+            dtCrowd* crowd = crowdManager_->GetAgentCrowd(agentCrowdId_, index);
+            if (crowd)
+                crowd->requestMoveTarget(index, nearestRef, nearestPos.Data());
         }
     }
 }
@@ -350,8 +354,10 @@ void CrowdAgent::SetTargetVelocity(const Vector3& velocity)
         requestedTargetType_ = CA_REQUESTEDTARGET_VELOCITY;
         MarkNetworkUpdate();
 
-        if (IsInCrowd())
-            crowdManager_->GetCrowd()->requestMoveVelocity(agentCrowdId_, velocity.Data());
+        int index;
+        dtCrowd* crowd = IsInCrowd() ? crowdManager_->GetAgentCrowd(agentCrowdId_, index) : nullptr;
+        if (crowd)
+            crowd->requestMoveVelocity(index, velocity.Data());
     }
 }
 
@@ -362,8 +368,10 @@ void CrowdAgent::ResetTarget()
         requestedTargetType_ = CA_REQUESTEDTARGET_NONE;
         MarkNetworkUpdate();
 
-        if (IsInCrowd())
-            crowdManager_->GetCrowd()->resetMoveTarget(agentCrowdId_);
+        int index;
+        dtCrowd* crowd = IsInCrowd() ? crowdManager_->GetAgentCrowd(agentCrowdId_, index) : nullptr;
+        if (crowd)
+            crowd->resetMoveTarget(index);
     }
 }
 
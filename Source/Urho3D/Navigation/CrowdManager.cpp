@@ -24,6 +24,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../IO/Log.h"
 #include "../Navigation/CrowdAgent.h"
@@ -34,6 +35,7 @@
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
 
+#include <Detour/DetourCommon.h>
 #include <DetourCrowd/DetourCrowd.h>
 
 #include "../DebugNew.h"
@@ -45,6 +47,8 @@ extern const char* NAVIGATION_CATEGORY;
 
 static const unsigned DEFAULT_MAX_AGENTS = 512;
 static const float DEFAULT_MAX_AGENT_RADIUS = 0.f;
+/// Distance relative to the partition size that an agent must leave its partition's cell by before it is moved to another partition.
+static const float PARTITION_MIGRATE_MARGIN = 0.1f;
 
 static const StringVector filterTypesStructureElementNames =
 {
@@ -74,6 +78,14 @@ void CrowdAgentUpdateCallback(dtCrowdAgent* ag, float dt)
     static_cast<CrowdAgent*>(ag->params.userData)->OnCrowdUpdate(ag, dt);
 }
 
+static void CopyCrowdConfig(const dtCrowd* source, dtCrowd* dest)
+{
+    for (int i = 0; i < DT_CROWD_MAX_QUERY_FILTER_TYPE; ++i)
+        *dest->getEditableFilter(i) = *source->getFilter(i);
+    for (int i = 0; i < DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS; ++i)
+        dest->setObstacleAvoidanceParams(i, source->getObstacleAvoidanceParams(i));
+}
+
 CrowdManager::CrowdManager(Context* context) :
     Component(context),
     maxAgents_(DEFAULT_MAX_AGENTS),
@@ -87,6 +99,8 @@ CrowdManager::CrowdManager(Context* context) :
 
 CrowdManager::~CrowdManager()
 {
+    for (unsigned i = 1; i < partitions_.Size(); ++i)
+        dtFreeCrowd(partitions_[i].crowd_);
     dtFreeCrowd(crowd_);
     crowd_ = nullptr;
 }
@@ -97,6 +111,7 @@ void CrowdManager::RegisterObject(Context* context)
 
     URHO3D_ATTRIBUTE("Max Agents", unsigned, maxAgents_, DEFAULT_MAX_AGENTS, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Max Agent Radius", float, maxAgentRadius_, DEFAULT_MAX_AGENT_RADIUS, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Partition Size", float, partitionSize_, 0.0f, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Navigation Mesh", unsigned, navigationMeshId_, 0, AM_DEFAULT | AM_COMPONENTID);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Filter Types", GetQueryFilterTypesAttr, SetQueryFilterTypesAttr,
         VariantVector, Variant::emptyVariantVector, AM_DEFAULT)
@@ -111,6 +126,7 @@ void CrowdManager::ApplyAttributes()
     // Values from Editor, saved-file, or network must be checked before applying
     maxAgents_ = Max(1U, maxAgents_);
     maxAgentRadius_ = Max(0.f, maxAgentRadius_);
+    partitionSize_ = Max(0.f, partitionSize_);
 
     bool navMeshChange = false;
     Scene* scene = GetScene();
@@ -127,19 +143,28 @@ void CrowdManager::ApplyAttributes()
     navigationMeshId_ = navigationMesh_ ? navigationMesh_->GetID() : 0;
 
     // If the Detour crowd initialization parameters have changed then recreate it
-    if (crowd_ && (navMeshChange || crowd_->getAgentCount() != maxAgents_ || crowd_->getMaxAgentRadius() != maxAgentRadius_))
+    if (crowd_ && (navMeshChange || crowd_->getAgentCount() != maxAgents_ || crowd_->getMaxAgentRadius() != maxAgentRadius_ ||
+        crowdPartitionSize_ != partitionSize_))
         CreateCrowd();
 }
 
 void CrowdManager::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
 {
-    if (debug && crowd_)
+    if (!debug)
+        return;
+
+    for (const CrowdPartition& partition : partitions_)
     {
+        dtCrowd* crowd = partition.crowd_;
+        if (!crowd)
+            continue;
+
         // Current position-to-target line
-        for (int i = 0; i < crowd_->getAgentCount(); i++)
+        for (int i = 0; i < crowd->getAgentCount(); i++)
         {
-            const dtCrowdAgent* ag = crowd_->getAgent(i);
-            if (!ag->active)
+            // Skip inactive agents and the ghosts of agents from neighbouring partitions
+            const dtCrowdAgent* ag = crowd->getAgent(i);
+            if (!ag->active || !ag->params.userData)
                 continue;
 
             // Draw CrowdAgent shape (from its radius & height)
@@ -253,6 +278,17 @@ void CrowdManager::SetMaxAgentRadius(float maxAgentRadius)
     }
 }
 
+void CrowdManager::SetPartitionSize(float size)
+{
+    size = Max(size, 0.f);
+    if (size != partitionSize_)
+    {
+        partitionSize_ = size;
+        CreateCrowd();
+        MarkNetworkUpdate();
+    }
+}
+
 void CrowdManager::SetNavigationMesh(NavigationMesh* navMesh)
 {
     UnsubscribeFromEvent(E_COMPONENTADDED);
@@ -306,6 +342,8 @@ void CrowdManager::SetQueryFilterTypesAttr(const VariantVector& value)
         }
         ++queryFilterType;
     }
+
+    SyncPartitionConfig();
 }
 
 void CrowdManager::SetIncludeFlags(unsigned queryFilterType, unsigned short flags)
@@ -316,6 +354,7 @@ void CrowdManager::SetIncludeFlags(unsigned queryFilterType, unsigned short flag
         filter->setIncludeFlags(flags);
         if (numQueryFilterTypes_ < queryFilterType + 1)
             numQueryFilterTypes_ = queryFilterType + 1;
+        SyncPartitionConfig();
         MarkNetworkUpdate();
     }
 }
@@ -328,6 +367,7 @@ void CrowdManager::SetExcludeFlags(unsigned queryFilterType, unsigned short flag
         filter->setExcludeFlags(flags);
         if (numQueryFilterTypes_ < queryFilterType + 1)
             numQueryFilterTypes_ = queryFilterType + 1;
+        SyncPartitionConfig();
         MarkNetworkUpdate();
     }
 }
@@ -342,6 +382,7 @@ void CrowdManager::SetAreaCost(unsigned queryFilterType, unsigned areaID, float
             numQueryFilterTypes_ = queryFilterType + 1;
         if (numAreas_[queryFilterType] < areaID + 1)
             numAreas_[queryFilterType] = areaID + 1;
+        SyncPartitionConfig();
         MarkNetworkUpdate();
     }
 }
@@ -374,6 +415,8 @@ void CrowdManager::SetObstacleAvoidanceTypesAttr(const VariantVector& value)
         }
         ++obstacleAvoidanceType;
     }
+
+    SyncPartitionConfig();
 }
 
 void CrowdManager::SetObstacleAvoidanceParams(unsigned obstacleAvoidanceType, const CrowdObstacleAvoidanceParams& params)
@@ -383,6 +426,7 @@ void CrowdManager::SetObstacleAvoidanceParams(unsigned obstacleAvoidanceType, co
         crowd_->setObstacleAvoidanceParams(obstacleAvoidanceType, reinterpret_cast<const dtObstacleAvoidanceParams*>(&params));
         if (numObstacleAvoidanceTypes_ < obstacleAvoidanceType + 1)
             numObstacleAvoidanceTypes_ = obstacleAvoidanceType + 1;
+        SyncPartitionConfig();
         MarkNetworkUpdate();
     }
 }
@@ -577,14 +621,23 @@ bool CrowdManager::CreateCrowd()
     {
         queryFilterTypeConfiguration = GetQueryFilterTypesAttr();
         obstacleAvoidanceTypeConfiguration = GetObstacleAvoidanceTypesAttr();
+        for (unsigned i = 1; i < partitions_.Size(); ++i)
+            dtFreeCrowd(partitions_[i].crowd_);
         dtFreeCrowd(crowd_);
     }
     crowd_ = dtAllocCrowd();
 
-    // Initialize the crowd
+    partitions_.Clear();
+    partitionCells_.Clear();
+    partitions_.Resize(1);
+    partitions_[0].crowd_ = crowd_;
+    crowdPartitionSize_ = partitionSize_;
+
+    // Initialize the crowd. The partitions are updated in the worker threads, so their agents are notified afterward instead of through the callback
     if (maxAgentRadius_ == 0.f)
         maxAgentRadius_ = navigationMesh_->GetAgentRadius();
-    if (!crowd_->init(maxAgents_, maxAgentRadius_, navigationMesh_->navMesh_, CrowdAgentUpdateCallback))
+    if (!crowd_->init(maxAgents_, maxAgentRadius_, navigationMesh_->navMesh_,
+        crowdPartitionSize_ > 0.f ? nullptr : CrowdAgentUpdateCallback))
     {
         URHO3D_LOGERROR("Could not initialize DetourCrowd");
         return false;
@@ -624,17 +677,42 @@ int CrowdManager::AddAgent(CrowdAgent* agent, const Vector3& pos)
         agent->height_ = navigationMesh_->GetAgentHeight();
     // dtCrowd::addAgent() requires the query filter type to find the nearest position on navmesh as the initial agent's position
     params.queryFilterType = (unsigned char)agent->GetQueryFilterType();
-    return crowd_->addAgent(pos.Data(), &params);
+
+    unsigned partition = 0;
+    if (crowdPartitionSize_ > 0.f)
+    {
+        partition = GetOrCreatePartition(GetPartitionCell(pos));
+        if (partition == M_MAX_UNSIGNED)
+            return -1;
+    }
+
+    int index = partitions_[partition].crowd_->addAgent(pos.Data(), &params);
+    return index != -1 ? (int)partition * crowd_->getAgentCount() + index : -1;
 }
 
 void CrowdManager::RemoveAgent(CrowdAgent* agent)
 {
     if (!crowd_ || !agent)
         return;
-    dtCrowdAgent* agt = crowd_->getEditableAgent(agent->GetAgentCrowdId());
+    int index;
+    dtCrowd* crowd = GetAgentCrowd(agent->GetAgentCrowdId(), index);
+    if (!crowd)
+        return;
+    dtCrowdAgent* agt = crowd->getEditableAgent(index);
     if (agt)
         agt->params.userData = nullptr;
-    crowd_->removeAgent(agent->GetAgentCrowdId());
+    crowd->removeAgent(index);
+
+    // Remove the agent's ghosts from the neighbouring partitions
+    for (CrowdPartition& partition : partitions_)
+    {
+        HashMap<CrowdAgent*, Pair<int, unsigned> >::Iterator ghost = partition.ghosts_.Find(agent);
+        if (ghost != partition.ghosts_.End())
+        {
+            partition.crowd_->removeAgent(ghost->second_.first_);
+            partition.ghosts_.Erase(ghost);
+        }
+    }
 }
 
 void CrowdManager::OnSceneSet(Scene* scene)
@@ -679,12 +757,319 @@ void CrowdManager::Update(float delta)
 {
     assert(crowd_ && navigationMesh_);
     URHO3D_PROFILE(UpdateCrowd);
-    crowd_->update(delta, nullptr);
+    if (crowdPartitionSize_ > 0.f)
+        UpdatePartitions(delta);
+    else
+        crowd_->update(delta, nullptr);
 }
 
 const dtCrowdAgent* CrowdManager::GetDetourCrowdAgent(int agent) const
 {
-    return crowd_ ? crowd_->getAgent(agent) : nullptr;
+    int index;
+    dtCrowd* crowd = GetAgentCrowd(agent, index);
+    return crowd ? crowd->getAgent(index) : nullptr;
+}
+
+dtCrowd* CrowdManager::GetAgentCrowd(int agent, int& index) const
+{
+    index = -1;
+    if (!crowd_ || agent < 0)
+        return nullptr;
+
+    // Agent IDs of the partitioned crowd are offset by the partition index times the partition capacity
+    int capacity = crowd_->getAgentCount();
+    if (capacity <= 0)
+        return nullptr;
+    auto partition = (unsigned)(agent / capacity);
+    if (partition >= partitions_.Size())
+        return nullptr;
+
+    index = agent % capacity;
+    return partitions_[partition].crowd_;
+}
+
+void CrowdManager::UpdatePartitions(float delta)
+{
+    ++partitionUpdate_;
+    int capacity = crowd_->getAgentCount();
+    activeAgents_.Resize((unsigned)capacity);
+    float migrateMargin = crowdPartitionSize_ * PARTITION_MIGRATE_MARGIN;
+    float ghostRange = 0.f;
+
+    {
+        URHO3D_PROFILE(MoveCrowdAgentsBetweenPartitions);
+
+        for (unsigned i = 0; i < partitions_.Size(); ++i)
+        {
+            if (!partitions_[i].inUse_)
+                continue;
+
+            // Copy the partition's values, as moving agents may add partitions
+            dtCrowd* crowd = partitions_[i].crowd_;
+            IntVector2 cell = partitions_[i].cell_;
+            float minX = cell.x_ * crowdPartitionSize_ - migrateMargin;
+            float maxX = (cell.x_ + 1) * crowdPartitionSize_ + migrateMargin;
+            float minZ = cell.y_ * crowdPartitionSize_ - migrateMargin;
+            float maxZ = (cell.y_ + 1) * crowdPartitionSize_ + migrateMargin;
+
+            int numActive = crowd->getActiveAgents(activeAgents_.Buffer(), capacity);
+            unsigned numAgents = 0;
+            for (int j = 0; j < numActive; ++j)
+            {
+                dtCrowdAgent* ag = activeAgents_[j];
+                auto* agent = static_cast<CrowdAgent*>(ag->params.userData);
+                if (!agent)
+                    continue;
+
+                ghostRange = Max(ghostRange, ag->params.collisionQueryRange);
+
+                // Agents on an off-mesh connection are animated by their crowd, so move them only after they have left it
+                if (ag->state != DT_CROWDAGENT_STATE_OFFMESH &&
+                    (ag->npos[0] < minX || ag->npos[0] > maxX || ag->npos[2] < minZ || ag->npos[2] > maxZ))
+                {
+                    unsigned target = GetOrCreatePartition(GetPartitionCell(Vector3(ag->npos)));
+                    if (target != M_MAX_UNSIGNED && MoveAgentToPartition(agent, target))
+                        continue;
+                }
+                ++numAgents;
+            }
+
+            if (!numAgents)
+                ReleasePartition(i);
+        }
+    }
+
+    {
+        URHO3D_PROFILE(UpdateCrowdGhosts);
+
+        // Add or refresh the ghosts of the agents within the neighbour query range of other partitions. The range is extended by the migrate margin, as agents may be that far outside their partition's cell
+        float range = ghostRange + migrateMargin;
+        for (unsigned i = 0; i < partitions_.Size(); ++i)
+        {
+            if (!partitions_[i].inUse_)
+                continue;
+
+            IntVector2 cell = partitions_[i].cell_;
+            int numActive = partitions_[i].crowd_->getActiveAgents(activeAgents_.Buffer(), capacity);
+            for (int j = 0; j < numActive; ++j)
+            {
+                const dtCrowdAgent* ag = activeAgents_[j];
+                auto* agent = static_cast<CrowdAgent*>(ag->params.userData);
+                if (!agent || ag->state != DT_CROWDAGENT_STATE_WALKING)
+                    continue;
+
+                IntVector2 minCell = GetPartitionCell(Vector3(ag->npos[0] - range, 0.f, ag->npos[2] - range));
+                IntVector2 maxCell = GetPartitionCell(Vector3(ag->npos[0] + range, 0.f, ag->npos[2] + range));
+                for (int z = minCell.y_; z <= maxCell.y_; ++z)
+                {
+                    for (int x = minCell.x_; x <= maxCell.x_; ++x)
+                    {
+                        IntVector2 neighbourCell(x, z);
+                        if (neighbourCell == cell)
+                            continue;
+                        HashMap<IntVector2, unsigned>::ConstIterator k = partitionCells_.Find(neighbourCell);
+                        if (k == partitionCells_.End())
+                            continue;
+
+                        CrowdPartition& neighbour = partitions_[k->second_];
+                        HashMap<CrowdAgent*, Pair<int, unsigned> >::Iterator ghost = neighbour.ghosts_.Find(agent);
+                        int ghostIndex;
+                        if (ghost == neighbour.ghosts_.End())
+                        {
+                            dtCrowdAgentParams params = ag->params;
+                            params.userData = nullptr;
+                            params.updateFlags = 0;
+                            ghostIndex = neighbour.crowd_->addAgent(ag->npos, &params);
+                            if (ghostIndex == -1)
+                                continue;
+                            neighbour.ghosts_[agent] = MakePair(ghostIndex, partitionUpdate_);
+                        }
+                        else
+                        {
+                            ghostIndex = ghost->second_.first_;
+                            ghost->second_.second_ = partitionUpdate_;
+                        }
+
+                        // The ghost only steers with the agent's desired velocity, so that the neighbours see its movement as is
+                        dtCrowdAgent* ghostAgent = neighbour.crowd_->getEditableAgent(ghostIndex);
+                        ghostAgent->params = ag->params;
+                        ghostAgent->params.userData = nullptr;
+                        ghostAgent->params.updateFlags = 0;
+                        dtVcopy(ghostAgent->npos, ag->npos);
+                        dtVcopy(ghostAgent->vel, ag->vel);
+                        dtVcopy(ghostAgent->nvel, ag->nvel);
+                        dtVcopy(ghostAgent->dvel, ag->dvel);
+                        neighbour.crowd_->requestMoveVelocity(ghostIndex, ag->dvel);
+                    }
+                }
+            }
+        }
+
+        // Remove the ghosts that were not refreshed
+        for (CrowdPartition& partition : partitions_)
+        {
+            for (HashMap<CrowdAgent*, Pair<int, unsigned> >::Iterator ghost = partition.ghosts_.Begin(); ghost != partition.ghosts_.End();)
+            {
+                if (ghost->second_.second_ != partitionUpdate_)
+                {
+                    partition.crowd_->removeAgent(ghost->second_.first_);
+                    ghost = partition.ghosts_.Erase(ghost);
+                }
+                else
+                    ++ghost;
+            }
+        }
+    }
+
+    PODVector<dtCrowd*> crowds;
+    for (const CrowdPartition& partition : partitions_)
+    {
+        if (partition.inUse_)
+            crowds.Push(partition.crowd_);
+    }
+
+    // Each crowd has its own navigation mesh queries, so the partitions can be updated at once
+    auto* queue = GetSubsystem<WorkQueue>();
+    if (queue)
+        queue->ParallelFor(crowds.Buffer(), crowds.Buffer() + crowds.Size(), UpdatePartitionWork, &delta);
+    else
+    {
+        for (unsigned i = 0; i < crowds.Size(); ++i)
+            crowds[i]->update(delta, nullptr);
+    }
+
+    // Notify the agents in the main thread
+    for (unsigned i = 0; i < crowds.Size(); ++i)
+    {
+        int numActive = crowds[i]->getActiveAgents(activeAgents_.Buffer(), capacity);
+        for (int j = 0; j < numActive; ++j)
+        {
+            dtCrowdAgent* ag = activeAgents_[j];
+            if (ag->active && ag->params.userData && ag->state == DT_CROWDAGENT_STATE_WALKING)
+                CrowdAgentUpdateCallback(ag, delta);
+        }
+    }
+}
+
+IntVector2 CrowdManager::GetPartitionCell(const Vector3& position) const
+{
+    return IntVector2(FloorToInt(position.x_ / crowdPartitionSize_), FloorToInt(position.z_ / crowdPartitionSize_));
+}
+
+unsigned CrowdManager::GetOrCreatePartition(const IntVector2& cell)
+{
+    HashMap<IntVector2, unsigned>::ConstIterator i = partitionCells_.Find(cell);
+    if (i != partitionCells_.End())
+        return i->second_;
+
+    unsigned index = 0;
+    while (index < partitions_.Size() && partitions_[index].inUse_)
+        ++index;
+    if (index == partitions_.Size())
+        partitions_.Resize(index + 1);
+
+    CrowdPartition& partition = partitions_[index];
+    if (!partition.crowd_)
+    {
+        partition.crowd_ = dtAllocCrowd();
+        if (!partition.crowd_->init(crowd_->getAgentCount(), crowd_->getMaxAgentRadius(), navigationMesh_->navMesh_, nullptr))
+        {
+            URHO3D_LOGERROR("Could not initialize DetourCrowd partition");
+            dtFreeCrowd(partition.crowd_);
+            partition.crowd_ = nullptr;
+            return M_MAX_UNSIGNED;
+        }
+        CopyCrowdConfig(crowd_, partition.crowd_);
+    }
+
+    partition.cell_ = cell;
+    partition.inUse_ = true;
+    partitionCells_[cell] = index;
+    return index;
+}
+
+void CrowdManager::ReleasePartition(unsigned index)
+{
+    CrowdPartition& partition = partitions_[index];
+    for (HashMap<CrowdAgent*, Pair<int, unsigned> >::ConstIterator i = partition.ghosts_.Begin(); i != partition.ghosts_.End(); ++i)
+        partition.crowd_->removeAgent(i->second_.first_);
+    partition.ghosts_.Clear();
+    partitionCells_.Erase(partition.cell_);
+    partition.inUse_ = false;
+
+    if (index)
+    {
+        dtFreeCrowd(partition.crowd_);
+        partition.crowd_ = nullptr;
+    }
+}
+
+bool CrowdManager::MoveAgentToPartition(CrowdAgent* agent, unsigned partition)
+{
+    int index;
+    dtCrowd* crowd = GetAgentCrowd(agent->agentCrowdId_, index);
+    dtCrowd* newCrowd = partitions_[partition].crowd_;
+    if (!crowd || crowd == newCrowd)
+        return false;
+
+    // The agent no longer needs a ghost in its new partition
+    CrowdPartition& newPartition = partitions_[partition];
+    HashMap<CrowdAgent*, Pair<int, unsigned> >::Iterator ghost = newPartition.ghosts_.Find(agent);
+    if (ghost != newPartition.ghosts_.End())
+    {
+        newCrowd->removeAgent(ghost->second_.first_);
+        newPartition.ghosts_.Erase(ghost);
+    }
+
+    dtCrowdAgent* ag = crowd->getEditableAgent(index);
+    int newIndex = newCrowd->addAgent(ag->npos, &ag->params);
+    if (newIndex == -1)
+        return false;
+
+    dtCrowdAgent* newAg = newCrowd->getEditableAgent(newIndex);
+    dtVcopy(newAg->vel, ag->vel);
+    dtVcopy(newAg->nvel, ag->nvel);
+    dtVcopy(newAg->dvel, ag->dvel);
+    newAg->desiredSpeed = ag->desiredSpeed;
+
+    // Keep a valid path, so that the agent does not need to replan. Pending path requests are queued again in the new crowd
+    if (ag->targetState == DT_CROWDAGENT_TARGET_VALID && ag->corridor.getPathCount())
+    {
+        newAg->corridor.setCorridor(ag->corridor.getTarget(), ag->corridor.getPath(), ag->corridor.getPathCount());
+        newAg->targetState = ag->targetState;
+        newAg->targetRef = ag->targetRef;
+        dtVcopy(newAg->targetPos, ag->targetPos);
+        newAg->partial = ag->partial;
+    }
+    else if (ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
+        newCrowd->requestMoveVelocity(newIndex, ag->targetPos);
+    else if (ag->targetState != DT_CROWDAGENT_TARGET_NONE && ag->targetState != DT_CROWDAGENT_TARGET_FAILED && ag->targetRef)
+        newCrowd->requestMoveTarget(newIndex, ag->targetRef, ag->targetPos);
+    else
+        newAg->targetState = ag->targetState;
+
+    ag->params.userData = nullptr;
+    crowd->removeAgent(index);
+    agent->agentCrowdId_ = (int)partition * crowd_->getAgentCount() + newIndex;
+    return true;
+}
+
+void CrowdManager::SyncPartitionConfig()
+{
+    for (unsigned i = 1; i < partitions_.Size(); ++i)
+    {
+        if (partitions_[i].crowd_)
+            CopyCrowdConfig(crowd_, partitions_[i].crowd_);
+    }
+}
+
+void CrowdManager::UpdatePartitionWork(const WorkItem* item, unsigned /*threadIndex*/)
+{
+    float delta = *static_cast<float*>(item->aux_);
+    auto** start = static_cast<dtCrowd**>(item->start_);
+    auto** end = static_cast<dtCrowd**>(item->end_);
+    for (dtCrowd** i = start; i != end; ++i)
+        (*i)->update(delta, nullptr);
 }
 
 const dtQueryFilter* CrowdManager::GetDetourQueryFilter(unsigned queryFilterType) const
@@ -40,6 +40,8 @@ namespace Urho3D
 class CrowdAgent;
 class NavigationMesh;
 
+struct WorkItem;
+
 /// Parameter structure for obstacle avoidance params (copied from DetourObstacleAvoidance.h in order to hide Detour header from Urho3D library users).
 /// @pod
 struct CrowdObstacleAvoidanceParams
@@ -106,6 +108,9 @@ public:
     void SetObstacleAvoidanceTypesAttr(const VariantVector& value);
     /// Set the params for the specified obstacle avoidance type.
     void SetObstacleAvoidanceParams(unsigned obstacleAvoidanceType, const CrowdObstacleAvoidanceParams& params);
+    /// Set the size of the square spatial partitions on the XZ plane, each simulated by its own Detour crowd in parallel with the others. Zero (default) simulates all agents in a single crowd. Max agents then applies to each partition.
+    /// @property
+    void SetPartitionSize(float size);
 
     /// Get all the crowd agent components in the specified node hierarchy. If the node is not specified then use scene node. When inCrowdFilter is set to true then only get agents that are in the crowd.
     PODVector<CrowdAgent*> GetAgents(Node* node = nullptr, bool inCrowdFilter = true) const;
@@ -132,6 +137,14 @@ public:
     /// @property
     float GetMaxAgentRadius() const { return maxAgentRadius_; }
 
+    /// Get the size of the spatial partitions, or zero if the crowd is not partitioned.
+    /// @property
+    float GetPartitionSize() const { return partitionSize_; }
+
+    /// Get the number of spatial partitions containing agents. Zero if the crowd is not partitioned.
+    /// @property
+    unsigned GetNumPartitions() const { return partitionCells_.Size(); }
+
     /// Get the Navigation mesh assigned to the crowd.
     /// @property{get_navMesh}
     NavigationMesh* GetNavigationMesh() const { return navigationMesh_; }
@@ -176,6 +189,8 @@ protected:
     void Update(float delta);
     /// Get the detour crowd agent.
     const dtCrowdAgent* GetDetourCrowdAgent(int agent) const;
+    /// Get the detour crowd holding the agent and the agent's index in it.
+    dtCrowd* GetAgentCrowd(int agent, int& index) const;
     /// Get the detour query filter.
     const dtQueryFilter* GetDetourQueryFilter(unsigned queryFilterType) const;
 
@@ -183,6 +198,33 @@ protected:
     dtCrowd* GetCrowd() const { return crowd_; }
 
 private:
+    /// Spatial partition of the crowd.
+    struct CrowdPartition
+    {
+        /// Detour crowd of the partition. Null if the slot is free.
+        dtCrowd* crowd_{};
+        /// Partition cell on the XZ plane.
+        IntVector2 cell_;
+        /// Whether the partition is assigned to a cell.
+        bool inUse_{};
+        /// Ghost copies of the agents near the partition in the neighbouring partitions, so that avoidance works across the boundaries. Maps the agent to the ghost's index and the update it was last refreshed in.
+        HashMap<CrowdAgent*, Pair<int, unsigned> > ghosts_;
+    };
+
+    /// Update the partitioned crowd: move agents between partitions, refresh the ghosts, and update the partitions in parallel.
+    void UpdatePartitions(float delta);
+    /// Return the partition cell containing a position.
+    IntVector2 GetPartitionCell(const Vector3& position) const;
+    /// Return the index of the partition of a cell, creating it if necessary. Return M_MAX_UNSIGNED on failure.
+    unsigned GetOrCreatePartition(const IntVector2& cell);
+    /// Free the partition's crowd, except for the first one which holds the crowd configuration.
+    void ReleasePartition(unsigned index);
+    /// Move an agent to another partition, keeping its path and velocity. Return true if successful.
+    bool MoveAgentToPartition(CrowdAgent* agent, unsigned partition);
+    /// Copy the query filters and obstacle avoidance params to the other partitions' crowds.
+    void SyncPartitionConfig();
+    /// Work function to update one partition's crowd.
+    static void UpdatePartitionWork(const WorkItem* item, unsigned threadIndex);
     /// Handle the scene subsystem update event.
     void HandleSceneSubsystemUpdate(StringHash eventType, VariantMap& eventData);
     /// Handle navigation mesh changed event. It can be navmesh being rebuilt or being removed from its node.
@@ -206,6 +248,18 @@ private:
     PODVector<unsigned> numAreas_;
     /// Number of obstacle avoidance types configured in the crowd. Limit to DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS.
     unsigned numObstacleAvoidanceTypes_{};
+    /// Size of the spatial partitions, or zero for a single crowd.
+    float partitionSize_{};
+    /// Partition size the crowd was created with.
+    float crowdPartitionSize_{};
+    /// Crowd partitions. The first one holds the crowd configuration and is always allocated.
+    Vector<CrowdPartition> partitions_;
+    /// Partition indices of the cells containing agents.
+    HashMap<IntVector2, unsigned> partitionCells_;
+    /// Partition update counter for the ghost refreshes.
+    unsigned partitionUpdate_{};
+    /// Temporary buffer of the active agents of a crowd.
+    PODVector<dtCrowdAgent*> activeAgents_;
 };
 
 }
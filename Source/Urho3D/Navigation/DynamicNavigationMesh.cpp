@@ -25,6 +25,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../IO/Log.h"
 #include "../IO/MemoryBuffer.h"
@@ -58,11 +59,20 @@ extern const char* NAVIGATION_CATEGORY;
 
 static const int DEFAULT_MAX_OBSTACLES = 1024;
 static const int DEFAULT_MAX_LAYERS = 16;
+static const unsigned DEFAULT_OBSTACLE_UPDATE_BUDGET = 32;
+static const int TILECACHE_ALLOCATOR_SIZE = 32000;
 
-struct DynamicNavigationMesh::TileCacheData
+/// Tile layer rebuilt for obstacle changes in a worker thread.
+struct ObstacleTileBuild
 {
-    unsigned char* data;
-    int dataSize;
+    /// Tile cache layer.
+    dtCompressedTileRef ref_;
+    /// Built navigation mesh tile data, or null if the tile is empty.
+    unsigned char* navData_;
+    /// Size of the built data.
+    int navDataSize_;
+    /// Build status.
+    dtStatus status_;
 };
 
 struct TileCompressor : public dtTileCacheCompressor
@@ -95,6 +105,7 @@ struct MeshProcess : public dtTileCacheMeshProcess
     PODVector<unsigned short> offMeshFlags_;
     PODVector<unsigned char> offMeshAreas_;
     PODVector<unsigned char> offMeshDir_;
+    bool prepared_{};
 
     inline explicit MeshProcess(DynamicNavigationMesh* owner) :
         owner_(owner)
@@ -111,6 +122,13 @@ struct MeshProcess : public dtTileCacheMeshProcess
                 polyFlags[i] = RC_WALKABLE_AREA;
         }
 
+        // When building in the worker threads the connections have been collected beforehand
+        if (prepared_)
+        {
+            SetConnectionParams(params);
+            return;
+        }
+
         BoundingBox bounds;
         rcVcopy(&bounds.min_.x_, params->bmin);
         rcVcopy(&bounds.max_.x_, params->bmin);
@@ -121,32 +139,57 @@ struct MeshProcess : public dtTileCacheMeshProcess
         if (offMeshConnections.Size() > 0)
         {
             if (offMeshConnections.Size() != offMeshRadii_.Size())
-            {
-                Matrix3x4 inverse = owner_->GetNode()->GetWorldTransform().Inverse();
-                ClearConnectionData();
-                for (unsigned i = 0; i < offMeshConnections.Size(); ++i)
-                {
-                    OffMeshConnection* connection = offMeshConnections[i];
-                    Vector3 start = inverse * connection->GetNode()->GetWorldPosition();
-                    Vector3 end = inverse * connection->GetEndPoint()->GetWorldPosition();
-
-                    offMeshVertices_.Push(start);
-                    offMeshVertices_.Push(end);
-                    offMeshRadii_.Push(connection->GetRadius());
-                    offMeshFlags_.Push((unsigned short)connection->GetMask());
-                    offMeshAreas_.Push((unsigned char)connection->GetAreaID());
-                    offMeshDir_.Push((unsigned char)(connection->IsBidirectional() ? DT_OFFMESH_CON_BIDIR : 0));
-                }
-            }
-            params->offMeshConCount = offMeshRadii_.Size();
-            params->offMeshConVerts = &offMeshVertices_[0].x_;
-            params->offMeshConRad = &offMeshRadii_[0];
-            params->offMeshConFlags = &offMeshFlags_[0];
-            params->offMeshConAreas = &offMeshAreas_[0];
-            params->offMeshConDir = &offMeshDir_[0];
+                CopyConnections(offMeshConnections);
+            SetConnectionParams(params);
         }
     }
 
+    /// Collect the off-mesh connections in the main thread, for building tiles in the worker threads.
+    void PrepareConnections()
+    {
+        BoundingBox bounds;
+        CopyConnections(owner_->CollectOffMeshConnections(bounds));
+        prepared_ = true;
+    }
+
+    /// Return to collecting the off-mesh connections for each tile.
+    void ReleaseConnections()
+    {
+        prepared_ = false;
+    }
+
+    void CopyConnections(const PODVector<OffMeshConnection*>& offMeshConnections)
+    {
+        Matrix3x4 inverse = owner_->GetNode()->GetWorldTransform().Inverse();
+        ClearConnectionData();
+        for (unsigned i = 0; i < offMeshConnections.Size(); ++i)
+        {
+            OffMeshConnection* connection = offMeshConnections[i];
+            Vector3 start = inverse * connection->GetNode()->GetWorldPosition();
+            Vector3 end = inverse * connection->GetEndPoint()->GetWorldPosition();
+
+            offMeshVertices_.Push(start);
+            offMeshVertices_.Push(end);
+            offMeshRadii_.Push(connection->GetRadius());
+            offMeshFlags_.Push((unsigned short)connection->GetMask());
+            offMeshAreas_.Push((unsigned char)connection->GetAreaID());
+            offMeshDir_.Push((unsigned char)(connection->IsBidirectional() ? DT_OFFMESH_CON_BIDIR : 0));
+        }
+    }
+
+    void SetConnectionParams(struct dtNavMeshCreateParams* params) const
+    {
+        if (offMeshRadii_.Empty())
+            return;
+
+        params->offMeshConCount = offMeshRadii_.Size();
+        params->offMeshConVerts = &offMeshVertices_[0].x_;
+        params->offMeshConRad = &offMeshRadii_[0];
+        params->offMeshConFlags = &offMeshFlags_[0];
+        params->offMeshConAreas = &offMeshAreas_[0];
+        params->offMeshConDir = &offMeshDir_[0];
+    }
+
     void ClearConnectionData()
     {
         offMeshVertices_.Clear();
@@ -210,12 +253,13 @@ struct LinearAllocator : public dtTileCacheAlloc
 
 DynamicNavigationMesh::DynamicNavigationMesh(Context* context) :
     NavigationMesh(context),
-    maxLayers_(DEFAULT_MAX_LAYERS)
+    maxLayers_(DEFAULT_MAX_LAYERS),
+    obstacleUpdateBudget_(DEFAULT_OBSTACLE_UPDATE_BUDGET)
 {
     // 64 is the largest tile-size that DetourTileCache will tolerate without silently failing
     tileSize_ = 64;
     partitionType_ = NAVMESH_PARTITION_MONOTONE;
-    allocator_ = new LinearAllocator(32000); //32kb to start
+    allocator_ = new LinearAllocator(TILECACHE_ALLOCATOR_SIZE); //32kb to start
     compressor_ = new TileCompressor();
     meshProcessor_ = new MeshProcess(this);
 }
@@ -233,6 +277,8 @@ void DynamicNavigationMesh::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Max Obstacles", GetMaxObstacles, SetMaxObstacles, unsigned, DEFAULT_MAX_OBSTACLES, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Max Layers", GetMaxLayers, SetMaxLayers, unsigned, DEFAULT_MAX_LAYERS, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Draw Obstacles", GetDrawObstacles, SetDrawObstacles, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Obstacle Update Budget", GetObstacleUpdateBudget, SetObstacleUpdateBudget, unsigned,
+        DEFAULT_OBSTACLE_UPDATE_BUDGET, AM_DEFAULT);
 }
 
 bool DynamicNavigationMesh::Allocate(const BoundingBox& boundingBox, unsigned maxTiles)
@@ -433,19 +479,11 @@ bool DynamicNavigationMesh::Build()
         {
             for (int x = 0; x < numTilesX_; ++x)
             {
-                TileCacheData tiles[TILECACHE_MAXLAYERS];
-                int layerCt = BuildTile(geometryList, x, z, tiles);
-                for (int i = 0; i < layerCt; ++i)
-                {
-                    dtCompressedTileRef tileRef;
-                    int status = tileCache_->addTile(tiles[i].data, tiles[i].dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tileRef);
-                    if (dtStatusFailed((dtStatus)status))
-                    {
-                        dtFree(tiles[i].data);
-                        tiles[i].data = nullptr;
-                    }
-                }
-                tileCache_->buildNavMeshTilesAt(x, z, navMesh_);
+                URHO3D_PROFILE(BuildNavigationMeshTile);
+
+                SharedPtr<TileBuild> tileBuild = PrepareTileBuild(geometryList, x, z);
+                BuildTileData(*tileBuild);
+                AddTileData(*tileBuild);
                 ++numTiles;
             }
         }
@@ -737,9 +775,13 @@ PODVector<unsigned char> DynamicNavigationMesh::GetNavigationDataAttr() const
         const dtTileCacheParams* tcParams = tileCache_->getParams();
         ret.Write(tcParams, sizeof(dtTileCacheParams));
 
-        for (int z = 0; z < numTilesZ_; ++z)
-            for (int x = 0; x < numTilesX_; ++x)
-                WriteTiles(ret, x, z);
+        // Streamed tiles are saved to their own files instead
+        if (!tileStreaming_)
+        {
+            for (int z = 0; z < numTilesZ_; ++z)
+                for (int x = 0; x < numTilesX_; ++x)
+                    WriteTiles(ret, x, z);
+        }
     }
     return ret.GetBuffer();
 }
@@ -817,61 +859,31 @@ bool DynamicNavigationMesh::ReadTiles(Deserializer& source, bool silent)
     return true;
 }
 
-int DynamicNavigationMesh::BuildTile(Vector<NavigationGeometryInfo>& geometryList, int x, int z, TileCacheData* tiles)
+NavBuildData* DynamicNavigationMesh::CreateTileBuildData()
 {
-    URHO3D_PROFILE(BuildNavigationMeshTile);
-
-    tileCache_->removeTile(navMesh_->getTileRefAt(x, z, 0), nullptr, nullptr);
-
-    const BoundingBox tileBoundingBox = GetTileBoundingBox(IntVector2(x, z));
-
-    DynamicNavBuildData build(allocator_.Get());
-
-    rcConfig cfg;   // NOLINT(hicpp-member-init)
-    memset(&cfg, 0, sizeof cfg);
-    cfg.cs = cellSize_;
-    cfg.ch = cellHeight_;
-    cfg.walkableSlopeAngle = agentMaxSlope_;
-    cfg.walkableHeight = (int)ceilf(agentHeight_ / cfg.ch);
-    cfg.walkableClimb = (int)floorf(agentMaxClimb_ / cfg.ch);
-    cfg.walkableRadius = (int)ceilf(agentRadius_ / cfg.cs);
-    cfg.maxEdgeLen = (int)(edgeMaxLength_ / cellSize_);
-    cfg.maxSimplificationError = edgeMaxError_;
-    cfg.minRegionArea = (int)sqrtf(regionMinSize_);
-    cfg.mergeRegionArea = (int)sqrtf(regionMergeSize_);
-    cfg.maxVertsPerPoly = 6;
-    cfg.tileSize = tileSize_;
-    cfg.borderSize = cfg.walkableRadius + 3; // Add padding
-    cfg.width = cfg.tileSize + cfg.borderSize * 2;
-    cfg.height = cfg.tileSize + cfg.borderSize * 2;
-    cfg.detailSampleDist = detailSampleDistance_ < 0.9f ? 0.0f : cellSize_ * detailSampleDistance_;
-    cfg.detailSampleMaxError = cellHeight_ * detailSampleMaxError_;
-
-    rcVcopy(cfg.bmin, &tileBoundingBox.min_.x_);
-    rcVcopy(cfg.bmax, &tileBoundingBox.max_.x_);
-    cfg.bmin[0] -= cfg.borderSize * cfg.cs;
-    cfg.bmin[2] -= cfg.borderSize * cfg.cs;
-    cfg.bmax[0] += cfg.borderSize * cfg.cs;
-    cfg.bmax[2] += cfg.borderSize * cfg.cs;
-
-    BoundingBox expandedBox(*reinterpret_cast<Vector3*>(cfg.bmin), *reinterpret_cast<Vector3*>(cfg.bmax));
-    GetTileGeometry(&build, geometryList, expandedBox);
+    return new DynamicNavBuildData(allocator_.Get());
+}
+
+bool DynamicNavigationMesh::BuildTileData(TileBuild& tileBuild) const
+{
+    DynamicNavBuildData& build = static_cast<DynamicNavBuildData&>(*tileBuild.build_);
+    const rcConfig& cfg = *tileBuild.config_;
 
     if (build.vertices_.Empty() || build.indices_.Empty())
-        return 0; // Nothing to do
+        return true; // Nothing to do
 
     build.heightField_ = rcAllocHeightfield();
     if (!build.heightField_)
     {
         URHO3D_LOGERROR("Could not allocate heightfield");
-        return 0;
+        return false;
     }
 
     if (!rcCreateHeightfield(build.ctx_, *build.heightField_, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs,
         cfg.ch))
     {
         URHO3D_LOGERROR("Could not create heightfield");
-        return 0;
+        return false;
     }
 
     unsigned numTriangles = build.indices_.Size() / 3;
@@ -891,18 +903,18 @@ int DynamicNavigationMesh::BuildTile(Vector<NavigationGeometryInfo>& geometryLis
     if (!build.compactHeightField_)
     {
         URHO3D_LOGERROR("Could not allocate create compact heightfield");
-        return 0;
+        return false;
     }
     if (!rcBuildCompactHeightfield(build.ctx_, cfg.walkableHeight, cfg.walkableClimb, *build.heightField_,
         *build.compactHeightField_))
     {
         URHO3D_LOGERROR("Could not build compact heightfield");
-        return 0;
+        return false;
     }
     if (!rcErodeWalkableArea(build.ctx_, cfg.walkableRadius, *build.compactHeightField_))
     {
         URHO3D_LOGERROR("Could not erode compact heightfield");
-        return 0;
+        return false;
     }
 
     // area volumes
@@ -910,18 +922,18 @@ int DynamicNavigationMesh::BuildTile(Vector<NavigationGeometryInfo>& geometryLis
         rcMarkBoxArea(build.ctx_, &build.navAreas_[i].bounds_.min_.x_, &build.navAreas_[i].bounds_.max_.x_,
             build.navAreas_[i].areaID_, *build.compactHeightField_);
 
-    if (this->partitionType_ == NAVMESH_PARTITION_WATERSHED)
+    if (tileBuild.partitionType_ == NAVMESH_PARTITION_WATERSHED)
     {
         if (!rcBuildDistanceField(build.ctx_, *build.compactHeightField_))
         {
             URHO3D_LOGERROR("Could not build distance field");
-            return 0;
+            return false;
         }
         if (!rcBuildRegions(build.ctx_, *build.compactHeightField_, cfg.borderSize, cfg.minRegionArea,
             cfg.mergeRegionArea))
         {
             URHO3D_LOGERROR("Could not build regions");
-            return 0;
+            return false;
         }
     }
     else
@@ -929,7 +941,7 @@ int DynamicNavigationMesh::BuildTile(Vector<NavigationGeometryInfo>& geometryLis
         if (!rcBuildRegionsMonotone(build.ctx_, *build.compactHeightField_, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
         {
             URHO3D_LOGERROR("Could not build monotone regions");
-            return 0;
+            return false;
         }
     }
 
@@ -937,24 +949,23 @@ int DynamicNavigationMesh::BuildTile(Vector<NavigationGeometryInfo>& geometryLis
     if (!build.heightFieldLayers_)
     {
         URHO3D_LOGERROR("Could not allocate height field layer set");
-        return 0;
+        return false;
     }
 
     if (!rcBuildHeightfieldLayers(build.ctx_, *build.compactHeightField_, cfg.borderSize, cfg.walkableHeight,
         *build.heightFieldLayers_))
     {
         URHO3D_LOGERROR("Could not build height field layers");
-        return 0;
+        return false;
     }
 
-    int retCt = 0;
     for (int i = 0; i < build.heightFieldLayers_->nlayers; ++i)
     {
         dtTileCacheLayerHeader header;      // NOLINT(hicpp-member-init)
         header.magic = DT_TILECACHE_MAGIC;
         header.version = DT_TILECACHE_VERSION;
-        header.tx = x;
-        header.ty = z;
+        header.tx = tileBuild.tile_.x_;
+        header.ty = tileBuild.tile_.y_;
         header.tlayer = i;
 
         rcHeightfieldLayer* layer = &build.heightFieldLayers_->layers[i];
@@ -971,29 +982,72 @@ int DynamicNavigationMesh::BuildTile(Vector<NavigationGeometryInfo>& geometryLis
         header.hmin = (unsigned short)layer->hmin;
         header.hmax = (unsigned short)layer->hmax;
 
+        unsigned char* data = nullptr;
+        int dataSize = 0;
         if (dtStatusFailed(
             dtBuildTileCacheLayer(compressor_.Get()/*compressor*/, &header, layer->heights, layer->areas/*areas*/, layer->cons,
-                &(tiles[retCt].data), &tiles[retCt].dataSize)))
+                &data, &dataSize)))
         {
             URHO3D_LOGERROR("Failed to build tile cache layers");
-            return 0;
+            // Do not add a partial set of layers
+            for (unsigned j = 0; j < tileBuild.tileData_.Size(); ++j)
+                dtFree(tileBuild.tileData_[j].first_);
+            tileBuild.tileData_.Clear();
+            return false;
         }
+
+        tileBuild.tileData_.Push(MakePair(data, dataSize));
+    }
+
+    return true;
+}
+
+unsigned DynamicNavigationMesh::AddTileData(TileBuild& tileBuild)
+{
+    const IntVector2& tile = tileBuild.tile_;
+
+    dtCompressedTileRef existing[TILECACHE_MAXLAYERS];
+    const int existingCt = tileCache_->getTilesAt(tile.x_, tile.y_, existing, maxLayers_);
+    for (int i = 0; i < existingCt; ++i)
+    {
+        unsigned char* data = nullptr;
+        if (!dtStatusFailed(tileCache_->removeTile(existing[i], &data, nullptr)) && data != nullptr)
+            dtFree(data);
+    }
+
+    if (tileBuild.tileData_.Empty())
+        return 0;
+
+    unsigned numTiles = 0;
+    for (unsigned i = 0; i < tileBuild.tileData_.Size(); ++i)
+    {
+        const Pair<unsigned char*, int>& layerData = tileBuild.tileData_[i];
+        dtCompressedTileRef tileRef;
+        int status = tileCache_->addTile(layerData.first_, layerData.second_, DT_COMPRESSEDTILE_FREE_DATA, &tileRef);
+        if (dtStatusFailed((dtStatus)status))
+            dtFree(layerData.first_);
         else
-            ++retCt;
+        {
+            tileCache_->buildNavMeshTile(tileRef, navMesh_);
+            ++numTiles;
+        }
     }
 
+    // The layers are freed by the tile cache from now on
+    tileBuild.tileData_.Clear();
+
     // Send a notification of the rebuild of this tile to anyone interested
     {
         using namespace NavigationAreaRebuilt;
         VariantMap& eventData = GetContext()->GetEventDataMap();
         eventData[P_NODE] = GetNode();
         eventData[P_MESH] = this;
-        eventData[P_BOUNDSMIN] = Variant(tileBoundingBox.min_);
-        eventData[P_BOUNDSMAX] = Variant(tileBoundingBox.max_);
+        eventData[P_BOUNDSMIN] = Variant(tileBuild.boundingBox_.min_);
+        eventData[P_BOUNDSMAX] = Variant(tileBuild.boundingBox_.max_);
         SendEvent(E_NAVIGATION_AREA_REBUILT, eventData);
     }
 
-    return retCt;
+    return numTiles;
 }
 
 unsigned DynamicNavigationMesh::BuildTiles(Vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to)
@@ -1004,32 +1058,11 @@ unsigned DynamicNavigationMesh::BuildTiles(Vector<NavigationGeometryInfo>& geome
     {
         for (int x = from.x_; x <= to.x_; ++x)
         {
-            dtCompressedTileRef existing[TILECACHE_MAXLAYERS];
-            const int existingCt = tileCache_->getTilesAt(x, z, existing, maxLayers_);
-            for (int i = 0; i < existingCt; ++i)
-            {
-                unsigned char* data = nullptr;
-                if (!dtStatusFailed(tileCache_->removeTile(existing[i], &data, nullptr)) && data != nullptr)
-                    dtFree(data);
-            }
+            URHO3D_PROFILE(BuildNavigationMeshTile);
 
-            TileCacheData tiles[TILECACHE_MAXLAYERS];
-            int layerCt = BuildTile(geometryList, x, z, tiles);
-            for (int i = 0; i < layerCt; ++i)
-            {
-                dtCompressedTileRef tileRef;
-                int status = tileCache_->addTile(tiles[i].data, tiles[i].dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tileRef);
-                if (dtStatusFailed((dtStatus)status))
-                {
-                    dtFree(tiles[i].data);
-                    tiles[i].data = nullptr;
-                }
-                else
-                {
-                    tileCache_->buildNavMeshTile(tileRef, navMesh_);
-                    ++numTiles;
-                }
-            }
+            SharedPtr<TileBuild> tileBuild = PrepareTileBuild(geometryList, x, z);
+            BuildTileData(*tileBuild);
+            numTiles += AddTileData(*tileBuild);
         }
     }
 
@@ -1064,10 +1097,17 @@ void DynamicNavigationMesh::ReleaseTileCache()
 {
     dtFreeTileCache(tileCache_);
     tileCache_ = nullptr;
+
+    // The pending obstacle changes refer to the freed tile cache
+    pendingObstacles_.Clear();
+    pendingObstacleRemovals_.Clear();
+    obstacleTileUpdates_.Clear();
 }
 
 void DynamicNavigationMesh::OnSceneSet(Scene* scene)
 {
+    NavigationMesh::OnSceneSet(scene);
+
     // Subscribe to the scene subsystem update, which will trigger the tile cache to update the nav mesh
     if (scene)
         SubscribeToEvent(scene, E_SCENESUBSYSTEMUPDATE, URHO3D_HANDLER(DynamicNavigationMesh, HandleSceneSubsystemUpdate));
@@ -1077,43 +1117,21 @@ void DynamicNavigationMesh::OnSceneSet(Scene* scene)
 
 void DynamicNavigationMesh::AddObstacle(Obstacle* obstacle, bool silent)
 {
-    if (tileCache_)
-    {
-        float pos[3];
-        Vector3 obsPos = obstacle->GetNode()->GetWorldPosition();
-        rcVcopy(pos, &obsPos.x_);
-        dtObstacleRef refHolder;
-
-        // Because dtTileCache doesn't process obstacle requests while updating tiles
-        // it's necessary update until sufficient request space is available
-        while (tileCache_->isObstacleQueueFull())
-            tileCache_->update(1, navMesh_);
-
-        if (dtStatusFailed(tileCache_->addObstacle(pos, obstacle->GetRadius(), obstacle->GetHeight(), &refHolder)))
-        {
-            URHO3D_LOGERROR("Failed to add obstacle");
-            return;
-        }
-        obstacle->obstacleId_ = refHolder;
-        assert(refHolder > 0);
+    if (!tileCache_)
+        return;
 
-        if (!silent)
-        {
-            using namespace NavigationObstacleAdded;
-            VariantMap& eventData = GetContext()->GetEventDataMap();
-            eventData[P_NODE] = obstacle->GetNode();
-            eventData[P_OBSTACLE] = obstacle;
-            eventData[P_POSITION] = obstacle->GetNode()->GetWorldPosition();
-            eventData[P_RADIUS] = obstacle->GetRadius();
-            eventData[P_HEIGHT] = obstacle->GetHeight();
-            SendEvent(E_NAVIGATION_OBSTACLE_ADDED, eventData);
-        }
-    }
+    // Coalesce the obstacle changes of the frame, so that each touched tile layer is rebuilt only once
+    HashMap<Obstacle*, bool>::Iterator i = pendingObstacles_.Find(obstacle);
+    if (i != pendingObstacles_.End())
+        i->second_ |= !silent;
+    else
+        pendingObstacles_[obstacle] = !silent;
 }
 
 void DynamicNavigationMesh::ObstacleChanged(Obstacle* obstacle)
 {
-    if (tileCache_)
+    // An obstacle waiting to be added is added with its current position and size
+    if (tileCache_ && !pendingObstacles_.Contains(obstacle))
     {
         RemoveObstacle(obstacle, true);
         AddObstacle(obstacle, true);
@@ -1122,18 +1140,11 @@ void DynamicNavigationMesh::ObstacleChanged(Obstacle* obstacle)
 
 void DynamicNavigationMesh::RemoveObstacle(Obstacle* obstacle, bool silent)
 {
+    pendingObstacles_.Erase(obstacle);
+
     if (tileCache_ && obstacle->obstacleId_ > 0)
     {
-        // Because dtTileCache doesn't process obstacle requests while updating tiles
-        // it's necessary update until sufficient request space is available
-        while (tileCache_->isObstacleQueueFull())
-            tileCache_->update(1, navMesh_);
-
-        if (dtStatusFailed(tileCache_->removeObstacle(obstacle->obstacleId_)))
-        {
-            URHO3D_LOGERROR("Failed to remove obstacle");
-            return;
-        }
+        pendingObstacleRemovals_.Push(obstacle->obstacleId_);
         obstacle->obstacleId_ = 0;
         // Require a node in order to send an event
         if (!silent && obstacle->GetNode())
@@ -1150,12 +1161,169 @@ void DynamicNavigationMesh::RemoveObstacle(Obstacle* obstacle, bool silent)
     }
 }
 
-void DynamicNavigationMesh::HandleSceneSubsystemUpdate(StringHash eventType, VariantMap& eventData)
+void DynamicNavigationMesh::CompleteObstacleUpdates()
+{
+    UpdateObstacles(true);
+}
+
+void DynamicNavigationMesh::UpdateObstacles(bool complete)
+{
+    if (!tileCache_ || !navMesh_)
+        return;
+
+    URHO3D_PROFILE(UpdateNavigationObstacles);
+
+    do
+    {
+        // Like the tile cache itself, queue the new obstacle changes only after the tiles of the previous ones have been rebuilt
+        if (obstacleTileUpdates_.Empty())
+            ApplyObstacleChanges();
+        if (obstacleTileUpdates_.Empty())
+            break;
+
+        unsigned count = obstacleTileUpdates_.Size();
+        if (!complete && obstacleUpdateBudget_)
+            count = Min(count, obstacleUpdateBudget_);
+        RebuildObstacleTiles(count);
+    } while (complete);
+}
+
+void DynamicNavigationMesh::ApplyObstacleChanges()
+{
+    if (pendingObstacles_.Empty() && pendingObstacleRemovals_.Empty())
+        return;
+
+    PODVector<dtCompressedTileRef> touched((unsigned)(dtTileCache::getMaxObstacleRequests() * DT_MAX_TOUCHED_TILES));
+    HashSet<dtCompressedTileRef> queued;
+    PODVector<Obstacle*> added;
+
+    // The tile cache holds a limited number of requests, so queue them in batches. Removals go first
+    unsigned numRemoved = 0;
+    HashMap<Obstacle*, bool>::ConstIterator next = pendingObstacles_.Begin();
+    while (numRemoved < pendingObstacleRemovals_.Size() || next != pendingObstacles_.End())
+    {
+        for (; numRemoved < pendingObstacleRemovals_.Size() && !tileCache_->isObstacleQueueFull(); ++numRemoved)
+        {
+            if (dtStatusFailed(tileCache_->removeObstacle(pendingObstacleRemovals_[numRemoved])))
+                URHO3D_LOGERROR("Failed to remove obstacle");
+        }
+
+        for (; next != pendingObstacles_.End() && !tileCache_->isObstacleQueueFull(); ++next)
+        {
+            Obstacle* obstacle = next->first_;
+            float pos[3];
+            Vector3 obsPos = obstacle->GetNode()->GetWorldPosition();
+            rcVcopy(pos, &obsPos.x_);
+            dtObstacleRef refHolder;
+
+            if (dtStatusFailed(tileCache_->addObstacle(pos, obstacle->GetRadius(), obstacle->GetHeight(), &refHolder)))
+            {
+                URHO3D_LOGERROR("Failed to add obstacle");
+                continue;
+            }
+            obstacle->obstacleId_ = refHolder;
+            assert(refHolder > 0);
+
+            if (next->second_)
+                added.Push(obstacle);
+        }
+
+        // Each tile layer touched by several obstacles is rebuilt once
+        int numTouched = 0;
+        tileCache_->processObstacleRequests(&touched[0], &numTouched, (int)touched.Size());
+        for (int i = 0; i < numTouched; ++i)
+        {
+            if (!queued.Contains(touched[i]))
+            {
+                queued.Insert(touched[i]);
+                obstacleTileUpdates_.Push(touched[i]);
+            }
+        }
+    }
+
+    pendingObstacles_.Clear();
+    pendingObstacleRemovals_.Clear();
+
+    // Send the events last, as the handlers may change the obstacles
+    for (unsigned i = 0; i < added.Size(); ++i)
+    {
+        Obstacle* obstacle = added[i];
+
+        using namespace NavigationObstacleAdded;
+        VariantMap& eventData = GetContext()->GetEventDataMap();
+        eventData[P_NODE] = obstacle->GetNode();
+        eventData[P_OBSTACLE] = obstacle;
+        eventData[P_POSITION] = obstacle->GetNode()->GetWorldPosition();
+        eventData[P_RADIUS] = obstacle->GetRadius();
+        eventData[P_HEIGHT] = obstacle->GetHeight();
+        SendEvent(E_NAVIGATION_OBSTACLE_ADDED, eventData);
+    }
+}
+
+void DynamicNavigationMesh::RebuildObstacleTiles(unsigned count)
 {
-    using namespace SceneSubsystemUpdate;
+    URHO3D_PROFILE(RebuildObstacleTiles);
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    const unsigned numThreads = (queue ? queue->GetNumThreads() : 0) + 1;
+    while (threadAllocators_.Size() < numThreads)
+        threadAllocators_.Push(UniquePtr<dtTileCacheAlloc>(new LinearAllocator(TILECACHE_ALLOCATOR_SIZE)));
 
+    PODVector<ObstacleTileBuild> builds(count);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        ObstacleTileBuild& build = builds[i];
+        build.ref_ = obstacleTileUpdates_[i];
+        build.navData_ = nullptr;
+        build.navDataSize_ = 0;
+        build.status_ = DT_SUCCESS;
+    }
+
+    // The scene can not be read in the worker threads, so collect the off-mesh connections first
+    auto* meshProcess = static_cast<MeshProcess*>(meshProcessor_.Get());
+    meshProcess->PrepareConnections();
+
+    // Returns when all the layers have been built, so the tile cache can not be modified meanwhile
+    if (queue)
+        queue->ParallelFor(builds.Buffer(), builds.Buffer() + count, RebuildObstacleTilesWork, this);
+    else
+    {
+        WorkItem item;
+        item.start_ = builds.Buffer();
+        item.end_ = builds.Buffer() + count;
+        item.aux_ = this;
+        RebuildObstacleTilesWork(&item, 0);
+    }
+
+    meshProcess->ReleaseConnections();
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        ObstacleTileBuild& build = builds[i];
+        if (dtStatusSucceed(build.status_))
+            tileCache_->addNavMeshTileData(build.ref_, build.navData_, build.navDataSize_, navMesh_);
+        // The obstacles waiting for the layer advance even if it failed to build, as in dtTileCache::update()
+        tileCache_->finishTileUpdate(build.ref_);
+    }
+
+    obstacleTileUpdates_.Erase(0, count);
+}
+
+void DynamicNavigationMesh::RebuildObstacleTilesWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* mesh = static_cast<DynamicNavigationMesh*>(item->aux_);
+    dtTileCacheAlloc* allocator = mesh->threadAllocators_[threadIndex].Get();
+
+    auto* start = static_cast<ObstacleTileBuild*>(item->start_);
+    auto* end = static_cast<ObstacleTileBuild*>(item->end_);
+    for (ObstacleTileBuild* i = start; i != end; ++i)
+        i->status_ = mesh->tileCache_->buildNavMeshTileData(i->ref_, allocator, &i->navData_, &i->navDataSize_);
+}
+
+void DynamicNavigationMesh::HandleSceneSubsystemUpdate(StringHash eventType, VariantMap& eventData)
+{
     if (tileCache_ && navMesh_ && IsEnabledEffective())
-        tileCache_->update(eventData[P_TIMESTEP].GetFloat(), navMesh_);
+        UpdateObstacles(false);
 }
 
 }
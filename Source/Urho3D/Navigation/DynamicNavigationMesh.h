@@ -105,23 +105,46 @@ public:
     /// @property
     bool GetDrawObstacles() const { return drawObstacles_; }
 
-protected:
-    struct TileCacheData;
+    /// Set the maximum number of tile layers rebuilt per frame for obstacle changes, or 0 for no limit. The layers of one frame are rebuilt in parallel in the work queue threads.
+    /// @property
+    void SetObstacleUpdateBudget(unsigned layers) { obstacleUpdateBudget_ = layers; }
 
+    /// Return the maximum number of tile layers rebuilt per frame for obstacle changes.
+    /// @property
+    unsigned GetObstacleUpdateBudget() const { return obstacleUpdateBudget_; }
+
+    /// Return number of tile layers waiting to be rebuilt for obstacle changes.
+    /// @property
+    unsigned GetNumPendingObstacleTiles() const { return obstacleTileUpdates_.Size(); }
+
+    /// Apply the pending obstacle changes and rebuild all the affected tile layers immediately.
+    void CompleteObstacleUpdates();
+
+protected:
     /// Subscribe to events when assigned to a scene.
     void OnSceneSet(Scene* scene) override;
     /// Trigger the tile cache to make updates to the nav mesh if necessary.
     void HandleSceneSubsystemUpdate(StringHash eventType, VariantMap& eventData);
 
-    /// Used by Obstacle class to add itself to the tile cache, if 'silent' an event will not be raised.
+    /// Used by Obstacle class to add itself to the tile cache, if 'silent' an event will not be raised. The obstacle is added on the next update, together with the other obstacle changes of the frame.
     void AddObstacle(Obstacle* obstacle, bool silent = false);
     /// Used by Obstacle class to update itself.
     void ObstacleChanged(Obstacle* obstacle);
     /// Used by Obstacle class to remove itself from the tile cache, if 'silent' an event will not be raised.
     void RemoveObstacle(Obstacle*, bool silent = false);
-
-    /// Build one tile of the navigation mesh. Return true if successful.
-    int BuildTile(Vector<NavigationGeometryInfo>& geometryList, int x, int z, TileCacheData* tiles);
+    /// Queue the pending obstacle changes to the tile cache once the previous tile rebuilds have finished, and rebuild the affected tile layers within the budget, or all of them if complete.
+    void UpdateObstacles(bool complete);
+    /// Queue the pending obstacle changes to the tile cache and collect the touched tile layers to be rebuilt.
+    void ApplyObstacleChanges();
+    /// Rebuild a number of the tile layers touched by obstacle changes in the work queue threads and add them to the navigation mesh.
+    void RebuildObstacleTiles(unsigned count);
+
+    /// Create the build data for one tile.
+    NavBuildData* CreateTileBuildData() override;
+    /// Run the Recast build of the tile cache layers of one tile. Accesses only the tile build, so can be called from a worker thread. Return true if successful.
+    bool BuildTileData(TileBuild& tileBuild) const override;
+    /// Replace the tile cache layers of the tile with the built ones and rebuild the navigation mesh tiles from them. Return number of layers added.
+    unsigned AddTileData(TileBuild& tileBuild) override;
     /// Build tiles in the rectangular area. Return number of built tiles.
     unsigned BuildTiles(Vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to);
     /// Off-mesh connections to be rebuilt in the mesh processor.
@@ -136,6 +159,8 @@ private:
     bool ReadTiles(Deserializer& source, bool silent);
     /// Free the tile cache.
     void ReleaseTileCache();
+    /// Work function to rebuild a range of tile layers touched by obstacle changes.
+    static void RebuildObstacleTilesWork(const WorkItem* item, unsigned threadIndex);
 
     /// Detour tile cache instance that works with the nav mesh.
     dtTileCache* tileCache_{};
@@ -153,6 +178,16 @@ private:
     bool drawObstacles_{};
     /// Queue of tiles to be built.
     PODVector<IntVector2> tileQueue_;
+    /// Obstacles waiting to be added to the tile cache, and whether to send the added event for each.
+    HashMap<Obstacle*, bool> pendingObstacles_;
+    /// Tile cache obstacles waiting to be removed.
+    PODVector<unsigned> pendingObstacleRemovals_;
+    /// Tile layers touched by the obstacle changes, waiting to be rebuilt.
+    PODVector<unsigned> obstacleTileUpdates_;
+    /// Maximum number of tile layers rebuilt per frame for obstacle changes, 0 for no limit.
+    unsigned obstacleUpdateBudget_;
+    /// Tile cache allocators for rebuilding the tile layers, indexed by the work queue thread index.
+    Vector<UniquePtr<dtTileCacheAlloc> > threadAllocators_;
 };
 
 }
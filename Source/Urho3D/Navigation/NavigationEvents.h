@@ -43,6 +43,23 @@ URHO3D_EVENT(E_NAVIGATION_AREA_REBUILT, NavigationAreaRebuilt)
     URHO3D_PARAM(P_BOUNDSMAX, BoundsMax); // Vector3
 }
 
+/// Asynchronous rebuild of navigation mesh tiles has finished and all the built tiles have been added.
+URHO3D_EVENT(E_NAVIGATION_ASYNC_REBUILT, NavigationAsyncRebuilt)
+{
+    URHO3D_PARAM(P_NODE, Node); // Node pointer
+    URHO3D_PARAM(P_MESH, Mesh); // NavigationMesh pointer
+    URHO3D_PARAM(P_NUMTILES, NumTiles); // unsigned
+}
+
+/// Asynchronous path request has completed.
+URHO3D_EVENT(E_NAVIGATION_PATH_FOUND, NavigationPathFound)
+{
+    URHO3D_PARAM(P_NODE, Node); // Node pointer
+    URHO3D_PARAM(P_MESH, Mesh); // NavigationMesh pointer
+    URHO3D_PARAM(P_REQUEST, Request); // NavigationPathRequest pointer
+    URHO3D_PARAM(P_SUCCESS, Success); // bool
+}
+
 /// Mesh tile is added to navigation mesh.
 URHO3D_EVENT(E_NAVIGATION_TILE_ADDED, NavigationTileAdded)
 {
@@ -22,8 +22,11 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/Sort.h"
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Drawable.h"
 #include "../Graphics/Geometry.h"
@@ -31,6 +34,8 @@
 #include "../Graphics/StaticModel.h"
 #include "../Graphics/TerrainPatch.h"
 #include "../Graphics/VertexBuffer.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../IO/MemoryBuffer.h"
 #include "../Navigation/CrowdAgent.h"
@@ -45,7 +50,9 @@
 #ifdef URHO3D_PHYSICS
 #include "../Physics/CollisionShape.h"
 #endif
+#include "../Resource/ResourceCache.h"
 #include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
 
 #include <cfloat>
 #include <Detour/DetourNavMesh.h>
@@ -80,6 +87,18 @@ static const float DEFAULT_EDGE_MAX_LENGTH = 12.0f;
 static const float DEFAULT_EDGE_MAX_ERROR = 1.3f;
 static const float DEFAULT_DETAIL_SAMPLE_DISTANCE = 6.0f;
 static const float DEFAULT_DETAIL_SAMPLE_MAX_ERROR = 1.0f;
+static const float DEFAULT_ASYNC_BUILD_TIME_BUDGET = 2.0f;
+static const unsigned DEFAULT_PATH_ITERATION_BUDGET = 1024;
+static const float DEFAULT_STREAMING_RADIUS = 250.0f;
+/// Minimum number of path requests per work item when finding the paths in the worker threads.
+static const unsigned PATH_REQUESTS_PER_WORK_ITEM = 16;
+/// Maximum number of streamed tile files being read at once.
+static const unsigned MAX_TILE_LOADS = 8;
+static const float DEFAULT_HIERARCHICAL_PATH_DISTANCE = 150.0f;
+/// Maximum number of tile layers at one tile index considered by the hierarchical path graph.
+static const int MAX_PATH_GRAPH_LAYERS = 32;
+/// Maximum number of entrances expanded by one hierarchical path graph search.
+static const unsigned MAX_PATH_GRAPH_EXPANSIONS = 65536;
 
 static const int MAX_POLYS = 2048;
 
@@ -97,12 +116,608 @@ struct FindPathData
     unsigned char pathFlags_[MAX_POLYS]{};
 };
 
+/// NavArea used for assigning the area IDs of path points. Copied in the main thread, as the nodes can not be safely read in the worker threads.
+struct PathAreaInfo
+{
+    /// World-space bounding box.
+    BoundingBox boundingBox_;
+    /// World-space position of the area node.
+    Vector3 position_;
+    /// Area ID.
+    unsigned char areaID_;
+};
+
+/// Shared state of the path requests found during one update.
+struct PathQueryBatch
+{
+    /// Navigation mesh.
+    NavigationMesh* mesh_;
+    /// World transform of the navigation mesh node.
+    Matrix3x4 transform_;
+    /// Inverse world transform of the navigation mesh node.
+    Matrix3x4 inverse_;
+    /// Enabled NavAreas.
+    PODVector<PathAreaInfo> areas_;
+};
+
+/// Streamed tile to be loaded or unloaded, with its distance to the nearest streaming point.
+struct StreamedTileDistance
+{
+    /// Tile index.
+    IntVector2 tile_;
+    /// Distance in the node space.
+    float distance_;
+};
+
+static bool CompareTileDistances(const StreamedTileDistance& lhs, const StreamedTileDistance& rhs)
+{
+    return lhs.distance_ < rhs.distance_;
+}
+
+/// Entrance between neighbouring tiles in the hierarchical path graph.
+struct PathGraphPortal
+{
+    /// Point on the navigation mesh just inside the tile, in the node space.
+    Vector3 position_;
+    /// Polygon containing the point.
+    dtPolyRef polyRef_;
+    /// Detour side of the tile boundary: 0 = +X, 2 = +Z, 4 = -X and 6 = -Z.
+    int side_;
+    /// Minimum coordinate of the entrance along the boundary.
+    float min_;
+    /// Maximum coordinate of the entrance along the boundary.
+    float max_;
+};
+
+/// Connected part of a tile boundary, before merging into entrances.
+struct PathGraphSegment
+{
+    /// Detour side of the tile boundary.
+    int side_;
+    /// Minimum coordinate along the boundary.
+    float min_;
+    /// Maximum coordinate along the boundary.
+    float max_;
+    /// Coordinate across the boundary.
+    float boundary_;
+    /// Height at the middle of the segment.
+    float height_;
+};
+
+/// Tile column in the hierarchical path graph, with the entrances and the cached path lengths between them.
+struct PathGraphCluster
+{
+    /// Hash of the tile references of the column and its neighbours when built. The references change whenever tiles are replaced.
+    unsigned hash_;
+    /// Search on which the hash was last checked.
+    unsigned checkedSearch_;
+    /// Search on which the search nodes were last assigned.
+    unsigned nodeSearch_;
+    /// Entrances.
+    PODVector<PathGraphPortal> portals_;
+    /// Path lengths between the entrances as a square matrix, M_INFINITY if not connected.
+    PODVector<float> costs_;
+    /// Search node index of each entrance, or -1 if not reached.
+    PODVector<int> searchNodes_;
+};
+
+/// Entrance reached by the hierarchical path graph search.
+struct PathGraphSearchNode
+{
+    /// Cluster.
+    PathGraphCluster* cluster_;
+    /// Tile index of the cluster.
+    IntVector2 tile_;
+    /// Entrance index in the cluster.
+    unsigned portal_;
+    /// Path length from the start.
+    float cost_;
+    /// Path length from the start and the estimate to the end.
+    float total_;
+    /// Index of the previous search node, or -1 for the first.
+    int parent_;
+    /// Whether expanded.
+    bool closed_;
+};
+
+/// Open list entry of the hierarchical path graph search.
+struct PathGraphOpenEntry
+{
+    /// Total estimated path length when added.
+    float total_;
+    /// Search node index.
+    int node_;
+};
+
+static bool CompareOpenEntries(const PathGraphOpenEntry& lhs, const PathGraphOpenEntry& rhs)
+{
+    return lhs.total_ > rhs.total_;
+}
+
+static bool CompareGraphSegments(const PathGraphSegment& lhs, const PathGraphSegment& rhs)
+{
+    return lhs.side_ != rhs.side_ ? lhs.side_ < rhs.side_ : lhs.min_ < rhs.min_;
+}
+
+static IntVector2 GetNeighbourTile(const IntVector2& tile, int side)
+{
+    switch (side)
+    {
+    case 0:
+        return IntVector2(tile.x_ + 1, tile.y_);
+    case 2:
+        return IntVector2(tile.x_, tile.y_ + 1);
+    case 4:
+        return IntVector2(tile.x_ - 1, tile.y_);
+    default:
+        return IntVector2(tile.x_, tile.y_ - 1);
+    }
+}
+
+/// Hierarchical path graph over the navigation mesh tiles. The tile columns are the clusters, the connected parts of their boundaries the entrances, and the path lengths between the entrances of a cluster are cached until the tiles change.
+struct NavigationPathGraph
+{
+    /// Return the cluster of a tile column, building it if missing or if the tiles have changed. Return null if the column has no tiles.
+    PathGraphCluster* GetCluster(const IntVector2& tile);
+    /// Build the entrances and the path lengths between them.
+    void BuildCluster(PathGraphCluster& cluster, const IntVector2& tile);
+    /// Return the hash of the tile references of a tile column, or 0 if it has no tiles.
+    unsigned GetColumnHash(int x, int z) const;
+    /// Return the length of the path between two points, or M_INFINITY if not found.
+    float GetPathLength(dtPolyRef startRef, const Vector3& start, dtPolyRef endRef, const Vector3& end);
+    /// Reach an entrance with a path length, if shorter than the previous one.
+    void AddSearchNode(PathGraphCluster* cluster, const IntVector2& tile, unsigned portal, float cost, int parent, const Vector3& end);
+    /// Find the entrances on the path between two points. Return false if the points are in the same cluster or no path was found.
+    bool FindWaypoints(PODVector<Vector3>& dest, dtPolyRef startRef, const Vector3& start, dtPolyRef endRef, const Vector3& end,
+        const IntVector2& startTile, const IntVector2& endTile);
+
+    /// Clusters by tile index.
+    HashMap<IntVector2, PathGraphCluster> clusters_;
+    /// Search nodes of the current search.
+    PODVector<PathGraphSearchNode> nodes_;
+    /// Open list of the current search as a binary heap.
+    PODVector<PathGraphOpenEntry> open_;
+    /// Current search number.
+    unsigned search_{};
+    /// Detour navigation mesh of the current search.
+    const dtNavMesh* navMesh_{};
+    /// Detour navigation mesh query of the current search.
+    dtNavMeshQuery* query_{};
+    /// Temporary data for the local path searches.
+    FindPathData* data_{};
+    /// Query filter the path lengths are cached for.
+    const dtQueryFilter* filter_{};
+    /// Cell size of the navigation mesh.
+    float cellSize_{};
+    /// Agent height of the navigation mesh.
+    float agentHeight_{};
+    /// Agent max vertical climb of the navigation mesh.
+    float agentMaxClimb_{};
+};
+
+unsigned NavigationPathGraph::GetColumnHash(int x, int z) const
+{
+    const dtMeshTile* tiles[MAX_PATH_GRAPH_LAYERS];
+    const int numTiles = navMesh_->getTilesAt(x, z, tiles, MAX_PATH_GRAPH_LAYERS);
+
+    unsigned hash = 0;
+    for (int i = 0; i < numTiles; ++i)
+        hash = hash * 31 + (unsigned)navMesh_->getTileRef(tiles[i]);
+    return hash;
+}
+
+PathGraphCluster* NavigationPathGraph::GetCluster(const IntVector2& tile)
+{
+    HashMap<IntVector2, PathGraphCluster>::Iterator i = clusters_.Find(tile);
+    if (i != clusters_.End() && i->second_.checkedSearch_ == search_)
+        return &i->second_;
+
+    unsigned columnHash = GetColumnHash(tile.x_, tile.y_);
+    if (!columnHash)
+    {
+        if (i != clusters_.End())
+            clusters_.Erase(i);
+        return nullptr;
+    }
+
+    unsigned hash = columnHash;
+    for (int side = 0; side < 8; side += 2)
+    {
+        IntVector2 neighbour = GetNeighbourTile(tile, side);
+        hash = hash * 31 + GetColumnHash(neighbour.x_, neighbour.y_);
+    }
+
+    if (i == clusters_.End())
+    {
+        i = clusters_.Insert(MakePair(tile, PathGraphCluster()));
+        i->second_.hash_ = hash + 1;
+        i->second_.nodeSearch_ = 0;
+    }
+
+    PathGraphCluster& cluster = i->second_;
+    if (cluster.hash_ != hash)
+    {
+        BuildCluster(cluster, tile);
+        cluster.hash_ = hash;
+        cluster.nodeSearch_ = 0;
+    }
+    cluster.checkedSearch_ = search_;
+    return &cluster;
+}
+
+void NavigationPathGraph::BuildCluster(PathGraphCluster& cluster, const IntVector2& tile)
+{
+    cluster.portals_.Clear();
+    cluster.costs_.Clear();
+
+    // Collect the parts of the polygon edges linked to the neighbouring tiles
+    PODVector<PathGraphSegment> segments;
+    const dtMeshTile* tiles[MAX_PATH_GRAPH_LAYERS];
+    const int numTiles = navMesh_->getTilesAt(tile.x_, tile.y_, tiles, MAX_PATH_GRAPH_LAYERS);
+    for (int i = 0; i < numTiles; ++i)
+    {
+        const dtMeshTile* meshTile = tiles[i];
+        for (int j = 0; j < meshTile->header->polyCount; ++j)
+        {
+            const dtPoly& poly = meshTile->polys[j];
+            if (poly.getType() == DT_POLYTYPE_OFFMESH_CONNECTION)
+                continue;
+
+            for (unsigned k = poly.firstLink; k != DT_NULL_LINK; k = meshTile->links[k].next)
+            {
+                const dtLink& link = meshTile->links[k];
+                if (link.side == 0xff || (link.side & 1))
+                    continue;
+
+                const Vector3& va = *reinterpret_cast<const Vector3*>(&meshTile->verts[poly.verts[link.edge] * 3]);
+                const Vector3& vb = *reinterpret_cast<const Vector3*>(&meshTile->verts[poly.verts[(link.edge + 1) % poly.vertCount] * 3]);
+                Vector3 p0 = va.Lerp(vb, link.bmin / 255.0f);
+                Vector3 p1 = va.Lerp(vb, link.bmax / 255.0f);
+
+                PathGraphSegment segment;
+                segment.side_ = link.side;
+                if (link.side == 0 || link.side == 4)
+                {
+                    segment.min_ = Min(p0.z_, p1.z_);
+                    segment.max_ = Max(p0.z_, p1.z_);
+                    segment.boundary_ = p0.x_;
+                }
+                else
+                {
+                    segment.min_ = Min(p0.x_, p1.x_);
+                    segment.max_ = Max(p0.x_, p1.x_);
+                    segment.boundary_ = p0.z_;
+                }
+                segment.height_ = (p0.y_ + p1.y_) * 0.5f;
+                segments.Push(segment);
+            }
+        }
+    }
+
+    // Merge the touching segments on each side into entrances
+    Sort(segments.Begin(), segments.End(), CompareGraphSegments);
+    const Vector3 extents(cellSize_ * 2.0f, agentHeight_, cellSize_ * 2.0f);
+    for (unsigned i = 0; i < segments.Size();)
+    {
+        PathGraphSegment merged = segments[i];
+        unsigned j = i + 1;
+        for (; j < segments.Size(); ++j)
+        {
+            const PathGraphSegment& next = segments[j];
+            if (next.side_ != merged.side_ || next.min_ > merged.max_ + cellSize_ ||
+                Abs(next.height_ - merged.height_) > agentMaxClimb_)
+                break;
+            merged.max_ = Max(merged.max_, next.max_);
+        }
+        i = j;
+
+        // Place the entrance in the middle, one cell inside the tile
+        const float middle = (merged.min_ + merged.max_) * 0.5f;
+        Vector3 position;
+        switch (merged.side_)
+        {
+        case 0:
+            position = Vector3(merged.boundary_ - cellSize_, merged.height_, middle);
+            break;
+        case 2:
+            position = Vector3(middle, merged.height_, merged.boundary_ - cellSize_);
+            break;
+        case 4:
+            position = Vector3(merged.boundary_ + cellSize_, merged.height_, middle);
+            break;
+        default:
+            position = Vector3(middle, merged.height_, merged.boundary_ + cellSize_);
+            break;
+        }
+
+        PathGraphPortal portal;
+        query_->findNearestPoly(&position.x_, &extents.x_, filter_, &portal.polyRef_, &portal.position_.x_);
+        if (!portal.polyRef_)
+            continue;
+
+        portal.side_ = merged.side_;
+        portal.min_ = merged.min_;
+        portal.max_ = merged.max_;
+        cluster.portals_.Push(portal);
+    }
+
+    // Cache the path lengths between the entrances
+    const unsigned numPortals = cluster.portals_.Size();
+    cluster.costs_.Resize(numPortals * numPortals);
+    for (unsigned i = 0; i < numPortals; ++i)
+    {
+        cluster.costs_[i * numPortals + i] = 0.0f;
+        for (unsigned j = i + 1; j < numPortals; ++j)
+        {
+            const PathGraphPortal& from = cluster.portals_[i];
+            const PathGraphPortal& to = cluster.portals_[j];
+            float cost = GetPathLength(from.polyRef_, from.position_, to.polyRef_, to.position_);
+            cluster.costs_[i * numPortals + j] = cost;
+            cluster.costs_[j * numPortals + i] = cost;
+        }
+    }
+}
+
+float NavigationPathGraph::GetPathLength(dtPolyRef startRef, const Vector3& start, dtPolyRef endRef, const Vector3& end)
+{
+    int numPolys = 0;
+    dtStatus status = query_->findPath(startRef, endRef, &start.x_, &end.x_, filter_, data_->polys_, &numPolys, MAX_POLYS);
+    if (dtStatusFailed(status) || !numPolys || data_->polys_[numPolys - 1] != endRef)
+        return M_INFINITY;
+
+    int numPathPoints = 0;
+    query_->findStraightPath(&start.x_, &end.x_, data_->polys_, numPolys, &data_->pathPoints_[0].x_, data_->pathFlags_,
+        data_->pathPolys_, &numPathPoints, MAX_POLYS);
+
+    float length = 0.0f;
+    for (int i = 1; i < numPathPoints; ++i)
+        length += (data_->pathPoints_[i] - data_->pathPoints_[i - 1]).Length();
+    return length;
+}
+
+void NavigationPathGraph::AddSearchNode(PathGraphCluster* cluster, const IntVector2& tile, unsigned portal, float cost, int parent,
+    const Vector3& end)
+{
+    if (cluster->nodeSearch_ != search_)
+    {
+        cluster->nodeSearch_ = search_;
+        cluster->searchNodes_.Resize(cluster->portals_.Size());
+        for (unsigned i = 0; i < cluster->searchNodes_.Size(); ++i)
+            cluster->searchNodes_[i] = -1;
+    }
+
+    int index = cluster->searchNodes_[portal];
+    if (index < 0)
+    {
+        index = nodes_.Size();
+        cluster->searchNodes_[portal] = index;
+        PathGraphSearchNode node;
+        node.cluster_ = cluster;
+        node.tile_ = tile;
+        node.portal_ = portal;
+        node.closed_ = false;
+        nodes_.Push(node);
+    }
+    // The straight line estimate never overestimates, so expanded entrances are not reached again with a shorter path
+    else if (nodes_[index].closed_ || cost >= nodes_[index].cost_)
+        return;
+
+    PathGraphSearchNode& node = nodes_[index];
+    node.cost_ = cost;
+    node.total_ = cost + (end - cluster->portals_[portal].position_).Length();
+    node.parent_ = parent;
+
+    PathGraphOpenEntry entry;
+    entry.total_ = node.total_;
+    entry.node_ = index;
+    open_.Push(entry);
+    std::push_heap(open_.Buffer(), open_.Buffer() + open_.Size(), CompareOpenEntries);
+}
+
+bool NavigationPathGraph::FindWaypoints(PODVector<Vector3>& dest, dtPolyRef startRef, const Vector3& start, dtPolyRef endRef,
+    const Vector3& end, const IntVector2& startTile, const IntVector2& endTile)
+{
+    ++search_;
+    nodes_.Clear();
+    open_.Clear();
+
+    PathGraphCluster* startCluster = GetCluster(startTile);
+    PathGraphCluster* endCluster = GetCluster(endTile);
+    if (!startCluster || !endCluster || startCluster == endCluster)
+        return false;
+
+    PODVector<float> endCosts(endCluster->portals_.Size());
+    for (unsigned i = 0; i < endCosts.Size(); ++i)
+    {
+        const PathGraphPortal& portal = endCluster->portals_[i];
+        endCosts[i] = GetPathLength(portal.polyRef_, portal.position_, endRef, end);
+    }
+
+    for (unsigned i = 0; i < startCluster->portals_.Size(); ++i)
+    {
+        const PathGraphPortal& portal = startCluster->portals_[i];
+        float cost = GetPathLength(startRef, start, portal.polyRef_, portal.position_);
+        if (cost < M_INFINITY)
+            AddSearchNode(startCluster, startTile, i, cost, -1, end);
+    }
+
+    float goalCost = M_INFINITY;
+    int goalNode = -1;
+    unsigned numExpanded = 0;
+
+    while (!open_.Empty() && numExpanded < MAX_PATH_GRAPH_EXPANSIONS)
+    {
+        std::pop_heap(open_.Buffer(), open_.Buffer() + open_.Size(), CompareOpenEntries);
+        PathGraphOpenEntry entry = open_.Back();
+        open_.Pop();
+
+        // Skip the entries superseded by a shorter path
+        if (nodes_[entry.node_].closed_ || entry.total_ > nodes_[entry.node_].total_)
+            continue;
+        if (entry.total_ >= goalCost)
+            break;
+
+        nodes_[entry.node_].closed_ = true;
+        ++numExpanded;
+
+        // Copy, as reaching new entrances grows the node list
+        const PathGraphSearchNode node = nodes_[entry.node_];
+        PathGraphCluster* cluster = node.cluster_;
+        const PathGraphPortal& portal = cluster->portals_[node.portal_];
+
+        if (cluster == endCluster && node.cost_ + endCosts[node.portal_] < goalCost)
+        {
+            goalCost = node.cost_ + endCosts[node.portal_];
+            goalNode = entry.node_;
+        }
+
+        // Entrances of the same cluster
+        const unsigned numPortals = cluster->portals_.Size();
+        for (unsigned i = 0; i < numPortals; ++i)
+        {
+            float cost = cluster->costs_[node.portal_ * numPortals + i];
+            if (i != node.portal_ && cost < M_INFINITY)
+                AddSearchNode(cluster, node.tile_, i, node.cost_ + cost, entry.node_, end);
+        }
+
+        // Facing entrances of the neighbouring cluster
+        const IntVector2 neighbourTile = GetNeighbourTile(node.tile_, portal.side_);
+        PathGraphCluster* neighbour = GetCluster(neighbourTile);
+        if (!neighbour)
+            continue;
+
+        const int oppositeSide = (portal.side_ + 4) & 7;
+        const Vector3 position = portal.position_;
+        const float portalMin = portal.min_;
+        const float portalMax = portal.max_;
+        for (unsigned i = 0; i < neighbour->portals_.Size(); ++i)
+        {
+            const PathGraphPortal& facing = neighbour->portals_[i];
+            if (facing.side_ != oppositeSide || facing.max_ + cellSize_ < portalMin || facing.min_ - cellSize_ > portalMax ||
+                Abs(facing.position_.y_ - position.y_) > agentHeight_ + agentMaxClimb_)
+                continue;
+
+            AddSearchNode(neighbour, neighbourTile, i, node.cost_ + (facing.position_ - position).Length(), entry.node_, end);
+        }
+    }
+
+    if (goalNode < 0)
+        return false;
+
+    PODVector<int> chain;
+    for (int i = goalNode; i >= 0; i = nodes_[i].parent_)
+        chain.Push(i);
+
+    dest.Clear();
+    dest.Push(start);
+    for (unsigned i = chain.Size() - 1; i < chain.Size(); --i)
+    {
+        const PathGraphSearchNode& node = nodes_[chain[i]];
+        // Of the two entrances facing each other across a tile boundary, keep only the exit
+        if (i < chain.Size() - 1 && nodes_[chain[i + 1]].cluster_ != node.cluster_)
+            continue;
+        dest.Push(node.cluster_->portals_[node.portal_].position_);
+    }
+    dest.Push(end);
+    return true;
+}
+
+static String GetTileFileName(const IntVector2& tile)
+{
+    return String(tile.x_) + "_" + String(tile.y_) + ".navtile";
+}
+
+static void CollectPathAreas(const Vector<WeakPtr<NavArea> >& areas, PODVector<PathAreaInfo>& dest)
+{
+    for (unsigned i = 0; i < areas.Size(); ++i)
+    {
+        NavArea* area = areas[i].Get();
+        if (area && area->IsEnabledEffective())
+        {
+            PathAreaInfo info;
+            info.boundingBox_ = area->GetWorldBoundingBox();
+            info.position_ = area->GetNode()->GetWorldPosition();
+            info.areaID_ = (unsigned char)area->GetAreaID();
+            dest.Push(info);
+        }
+    }
+}
+
+/// Turn a polygon corridor into world space path points.
+static void FinishPath(PODVector<NavigationPathPoint>& dest, dtNavMeshQuery* query, FindPathData& data, int numPolys, bool partial,
+    const Vector3& localStart, const Vector3& localEnd, const Matrix3x4& transform, const PODVector<PathAreaInfo>& areas)
+{
+    if (!numPolys)
+        return;
+
+    Vector3 actualLocalEnd = localEnd;
+
+    // If full path was not found, clamp end point to the end polygon
+    if (partial)
+        query->closestPointOnPoly(data.polys_[numPolys - 1], &localEnd.x_, &actualLocalEnd.x_, nullptr);
+
+    int numPathPoints = 0;
+    query->findStraightPath(&localStart.x_, &actualLocalEnd.x_, data.polys_, numPolys,
+        &data.pathPoints_[0].x_, data.pathFlags_, data.pathPolys_, &numPathPoints, MAX_POLYS);
+
+    // Transform path result back to world space
+    for (int i = 0; i < numPathPoints; ++i)
+    {
+        NavigationPathPoint pt;
+        pt.position_ = transform * data.pathPoints_[i];
+        pt.flag_ = (NavigationPathPointFlag)data.pathFlags_[i];
+
+        // Walk through all NavAreas and find nearest
+        unsigned char nearestNavAreaID = 0;       // 0 is the default nav area ID
+        float nearestDistance = M_LARGE_VALUE;
+        for (unsigned j = 0; j < areas.Size(); j++)
+        {
+            const PathAreaInfo& area = areas[j];
+            if (area.boundingBox_.IsInside(pt.position_) == INSIDE)
+            {
+                float distance = (area.position_ - pt.position_).LengthSquared();
+                if (distance < nearestDistance)
+                {
+                    nearestDistance = distance;
+                    nearestNavAreaID = area.areaID_;
+                }
+            }
+        }
+        pt.areaID_ = nearestNavAreaID;
+
+        dest.Push(pt);
+    }
+}
+
+/// Find a path with the given query and temporary data, so that paths can be found in several threads at once.
+static void FindPathWithQuery(PODVector<NavigationPathPoint>& dest, dtNavMeshQuery* query, FindPathData& data, const Vector3& start,
+    const Vector3& end, const Vector3& extents, const dtQueryFilter* filter, const PathQueryBatch& batch)
+{
+    // Navigation data is in local space. Transform path points from world to local
+    Vector3 localStart = batch.inverse_ * start;
+    Vector3 localEnd = batch.inverse_ * end;
+
+    dtPolyRef startRef;
+    dtPolyRef endRef;
+    query->findNearestPoly(&localStart.x_, &extents.x_, filter, &startRef, nullptr);
+    query->findNearestPoly(&localEnd.x_, &extents.x_, filter, &endRef, nullptr);
+
+    if (!startRef || !endRef)
+        return;
+
+    int numPolys = 0;
+    query->findPath(startRef, endRef, &localStart.x_, &localEnd.x_, filter, data.polys_, &numPolys, MAX_POLYS);
+    FinishPath(dest, query, data, numPolys, numPolys && data.polys_[numPolys - 1] != endRef, localStart, localEnd, batch.transform_,
+        batch.areas_);
+}
+
 NavigationMesh::NavigationMesh(Context* context) :
     Component(context),
     navMesh_(nullptr),
     navMeshQuery_(nullptr),
     queryFilter_(new dtQueryFilter()),
     pathData_(new FindPathData()),
+    pathGraph_(new NavigationPathGraph()),
     tileSize_(DEFAULT_TILE_SIZE),
     cellSize_(DEFAULT_CELL_SIZE),
     cellHeight_(DEFAULT_CELL_HEIGHT),
@@ -122,15 +737,44 @@ NavigationMesh::NavigationMesh(Context* context) :
     partitionType_(NAVMESH_PARTITION_WATERSHED),
     keepInterResults_(false),
     drawOffMeshConnections_(false),
-    drawNavAreas_(false)
+    drawNavAreas_(false),
+    numAsyncTiles_(0),
+    asyncBuildTimeBudget_(DEFAULT_ASYNC_BUILD_TIME_BUDGET),
+    slicedQuery_(nullptr),
+    pathIterationBudget_(DEFAULT_PATH_ITERATION_BUDGET),
+    hierarchicalPathfinding_(false),
+    hierarchicalPathDistance_(DEFAULT_HIERARCHICAL_PATH_DISTANCE),
+    tileStreaming_(false),
+    streamingRadius_(DEFAULT_STREAMING_RADIUS),
+    streamingMemoryBudget_(0),
+    streamingMemoryUse_(0)
 {
 }
 
 NavigationMesh::~NavigationMesh()
 {
+    CancelPathRequests();
     ReleaseNavigationMesh();
 }
 
+NavigationMesh::TileBuild::TileBuild(const IntVector2& tile, NavBuildData* build) :
+    tile_(tile),
+    config_(new rcConfig()),
+    agentHeight_(0.0f),
+    agentRadius_(0.0f),
+    agentMaxClimb_(0.0f),
+    partitionType_(NAVMESH_PARTITION_WATERSHED),
+    build_(build)
+{
+    memset(config_.Get(), 0, sizeof(rcConfig));
+}
+
+NavigationMesh::TileBuild::~TileBuild()
+{
+    for (unsigned i = 0; i < tileData_.Size(); ++i)
+        dtFree(tileData_[i].first_);
+}
+
 void NavigationMesh::RegisterObject(Context* context)
 {
     context->RegisterFactory<NavigationMesh>(NAVIGATION_CATEGORY);
@@ -157,6 +801,13 @@ void NavigationMesh::RegisterObject(Context* context)
         NAVMESH_PARTITION_WATERSHED, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Draw OffMeshConnections", GetDrawOffMeshConnections, SetDrawOffMeshConnections, bool, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Draw NavAreas", GetDrawNavAreas, SetDrawNavAreas, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Hierarchical Pathfinding", GetHierarchicalPathfinding, SetHierarchicalPathfinding, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Hierarchical Path Distance", GetHierarchicalPathDistance, SetHierarchicalPathDistance, float,
+        DEFAULT_HIERARCHICAL_PATH_DISTANCE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Tile Streaming", GetTileStreaming, SetTileStreaming, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Tile Stream Path", GetTileStreamPath, SetTileStreamPath, String, String::EMPTY, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Streaming Radius", GetStreamingRadius, SetStreamingRadius, float, DEFAULT_STREAMING_RADIUS, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Streaming Memory Budget", GetStreamingMemoryBudget, SetStreamingMemoryBudget, unsigned, 0, AM_DEFAULT);
 }
 
 void NavigationMesh::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
@@ -521,46 +1172,147 @@ bool NavigationMesh::Build(const IntVector2& from, const IntVector2& to)
     return true;
 }
 
-PODVector<unsigned char> NavigationMesh::GetTileData(const IntVector2& tile) const
+bool NavigationMesh::BuildAsync(const BoundingBox& boundingBox)
 {
-    VectorBuffer ret;
-    WriteTile(ret, tile.x_, tile.y_);
-    return ret.GetBuffer();
-}
+    if (!node_)
+        return false;
 
-bool NavigationMesh::AddTile(const PODVector<unsigned char>& tileData)
-{
-    MemoryBuffer buffer(tileData);
-    return ReadTile(buffer, false);
-}
+    if (!navMesh_)
+    {
+        URHO3D_LOGERROR("Navigation mesh must first be built fully before it can be partially rebuilt");
+        return false;
+    }
 
-bool NavigationMesh::HasTile(const IntVector2& tile) const
-{
-    if (navMesh_)
-        return !!navMesh_->getTileAt(tile.x_, tile.y_, 0);
-    return false;
-}
+    BoundingBox localSpaceBox = boundingBox.Transformed(node_->GetWorldTransform().Inverse());
 
-BoundingBox NavigationMesh::GetTileBoundingBox(const IntVector2& tile) const
-{
-    const float tileEdgeLength = (float)tileSize_ * cellSize_;
-    return BoundingBox(
-        Vector3(
-            boundingBox_.min_.x_ + tileEdgeLength * (float)tile.x_,
-            boundingBox_.min_.y_,
-            boundingBox_.min_.z_ + tileEdgeLength * (float)tile.y_
-        ),
-        Vector3(
-            boundingBox_.min_.x_ + tileEdgeLength * (float)(tile.x_ + 1),
-            boundingBox_.max_.y_,
-            boundingBox_.min_.z_ + tileEdgeLength * (float)(tile.y_ + 1)
-        ));
+    float tileEdgeLength = (float)tileSize_ * cellSize_;
+
+    int sx = Clamp((int)((localSpaceBox.min_.x_ - boundingBox_.min_.x_) / tileEdgeLength), 0, numTilesX_ - 1);
+    int sz = Clamp((int)((localSpaceBox.min_.z_ - boundingBox_.min_.z_) / tileEdgeLength), 0, numTilesZ_ - 1);
+    int ex = Clamp((int)((localSpaceBox.max_.x_ - boundingBox_.min_.x_) / tileEdgeLength), 0, numTilesX_ - 1);
+    int ez = Clamp((int)((localSpaceBox.max_.z_ - boundingBox_.min_.z_) / tileEdgeLength), 0, numTilesZ_ - 1);
+
+    return BuildAsync(IntVector2(sx, sz), IntVector2(ex, ez));
 }
 
-IntVector2 NavigationMesh::GetTileIndex(const Vector3& position) const
+bool NavigationMesh::BuildAsync(const IntVector2& from, const IntVector2& to)
 {
-    const float tileEdgeLength = (float)tileSize_ * cellSize_;
-    const Vector3 localPosition = node_->GetWorldTransform().Inverse() * position - boundingBox_.min_;
+    URHO3D_PROFILE(BuildNavigationMeshAsync);
+
+    Scene* scene = GetScene();
+    if (!node_ || !scene)
+        return false;
+
+    if (!navMesh_)
+    {
+        URHO3D_LOGERROR("Navigation mesh must first be built fully before it can be partially rebuilt");
+        return false;
+    }
+
+    if (!node_->GetWorldScale().Equals(Vector3::ONE))
+        URHO3D_LOGWARNING("Navigation mesh root node has scaling. Agent parameters may not work as intended");
+
+    Vector<NavigationGeometryInfo> geometryList;
+    CollectGeometries(geometryList);
+
+    if (tileBuilds_.Empty())
+        numAsyncTiles_ = 0;
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    for (int z = from.y_; z <= to.y_; ++z)
+    {
+        for (int x = from.x_; x <= to.x_; ++x)
+        {
+            // Copy the input geometry here, as the scene can not be safely read in the worker threads
+            SharedPtr<TileBuild> tileBuild = PrepareTileBuild(geometryList, x, z);
+
+            // Not pooled, as pooled items may be reset on the next frame begin before the tile has been added
+            SharedPtr<WorkItem> item(new WorkItem());
+            item->workFunction_ = BuildTileWork;
+            item->start_ = tileBuild.Get();
+            item->aux_ = this;
+            // Lowest priority, so that completing the frame's work does not wait for the tile builds
+            item->priority_ = 0;
+            tileBuild->item_ = item;
+            tileBuilds_.Push(tileBuild);
+
+            if (queue)
+                queue->AddWorkItem(item);
+            else
+            {
+                BuildTileWork(item, 0);
+                item->completed_ = true;
+            }
+        }
+    }
+
+    UpdatePostUpdateSubscription();
+    return true;
+}
+
+void NavigationMesh::CompleteAsyncBuild()
+{
+    if (!tileBuilds_.Empty())
+        UpdateAsyncBuild(true);
+}
+
+void NavigationMesh::CancelAsyncBuild()
+{
+    if (tileBuilds_.Empty())
+        return;
+
+    // The builds already running must finish before the tile builds can be freed
+    auto* queue = GetSubsystem<WorkQueue>();
+    for (const SharedPtr<TileBuild>& tileBuild : tileBuilds_)
+    {
+        if (queue && !queue->RemoveWorkItem(tileBuild->item_))
+            queue->Wait(tileBuild->item_);
+    }
+
+    tileBuilds_.Clear();
+    UpdatePostUpdateSubscription();
+}
+
+PODVector<unsigned char> NavigationMesh::GetTileData(const IntVector2& tile) const
+{
+    VectorBuffer ret;
+    WriteTile(ret, tile.x_, tile.y_);
+    return ret.GetBuffer();
+}
+
+bool NavigationMesh::AddTile(const PODVector<unsigned char>& tileData)
+{
+    MemoryBuffer buffer(tileData);
+    return ReadTile(buffer, false);
+}
+
+bool NavigationMesh::HasTile(const IntVector2& tile) const
+{
+    if (navMesh_)
+        return !!navMesh_->getTileAt(tile.x_, tile.y_, 0);
+    return false;
+}
+
+BoundingBox NavigationMesh::GetTileBoundingBox(const IntVector2& tile) const
+{
+    const float tileEdgeLength = (float)tileSize_ * cellSize_;
+    return BoundingBox(
+        Vector3(
+            boundingBox_.min_.x_ + tileEdgeLength * (float)tile.x_,
+            boundingBox_.min_.y_,
+            boundingBox_.min_.z_ + tileEdgeLength * (float)tile.y_
+        ),
+        Vector3(
+            boundingBox_.min_.x_ + tileEdgeLength * (float)(tile.x_ + 1),
+            boundingBox_.max_.y_,
+            boundingBox_.min_.z_ + tileEdgeLength * (float)(tile.y_ + 1)
+        ));
+}
+
+IntVector2 NavigationMesh::GetTileIndex(const Vector3& position) const
+{
+    const float tileEdgeLength = (float)tileSize_ * cellSize_;
+    const Vector3 localPosition = node_->GetWorldTransform().Inverse() * position - boundingBox_.min_;
     const Vector2 localPosition2D(localPosition.x_, localPosition.z_);
     return VectorMin(VectorMax(IntVector2::ZERO, VectorFloorToInt(localPosition2D / tileEdgeLength)), GetNumTiles() - IntVector2::ONE);
 }
@@ -670,71 +1422,222 @@ void NavigationMesh::FindPath(PODVector<NavigationPathPoint>& dest, const Vector
     if (!InitializeQuery())
         return;
 
-    // Navigation data is in local space. Transform path points from world to local
+    PathQueryBatch batch;
+    batch.mesh_ = this;
+    batch.transform_ = node_->GetWorldTransform();
+    batch.inverse_ = batch.transform_.Inverse();
+    CollectPathAreas(areas_, batch.areas_);
+
+    if (!filter)
+        filter = queryFilter_.Get();
+
+    PODVector<Vector3> waypoints;
+    if (!hierarchicalPathfinding_ || (end - start).Length() <= hierarchicalPathDistance_ ||
+        !FindLocalWaypoints(waypoints, batch.inverse_ * start, batch.inverse_ * end, extents, filter))
+    {
+        FindPathWithQuery(dest, navMeshQuery_, *pathData_, start, end, extents, filter, batch);
+        return;
+    }
+
+    // Refine the path between each pair of waypoints, stopping at the first one that can not be reached
+    PODVector<NavigationPathPoint> segment;
+    for (unsigned i = 1; i < waypoints.Size(); ++i)
+    {
+        segment.Clear();
+        FindPathWithQuery(segment, navMeshQuery_, *pathData_, batch.transform_ * waypoints[i - 1], batch.transform_ * waypoints[i],
+            extents, filter, batch);
+        if (segment.Empty())
+            break;
+
+        unsigned first = 0;
+        if (!dest.Empty())
+        {
+            dest.Back().flag_ = (NavigationPathPointFlag)(dest.Back().flag_ & ~NAVPATHFLAG_END);
+            first = 1;
+        }
+        for (unsigned j = first; j < segment.Size(); ++j)
+            dest.Push(segment[j]);
+
+        // A partial segment ends the path
+        if ((batch.inverse_ * segment.Back().position_ - waypoints[i]).Length() > agentRadius_)
+            break;
+    }
+}
+
+void NavigationMesh::FindPathWaypoints(PODVector<Vector3>& dest, const Vector3& start, const Vector3& end, const Vector3& extents,
+    const dtQueryFilter* filter)
+{
+    URHO3D_PROFILE(FindPathWaypoints);
+    dest.Clear();
+
+    if (!InitializeQuery())
+        return;
+
     const Matrix3x4& transform = node_->GetWorldTransform();
     Matrix3x4 inverse = transform.Inverse();
 
-    Vector3 localStart = inverse * start;
-    Vector3 localEnd = inverse * end;
+    if (FindLocalWaypoints(dest, inverse * start, inverse * end, extents, filter ? filter : queryFilter_.Get()))
+    {
+        for (unsigned i = 0; i < dest.Size(); ++i)
+            dest[i] = transform * dest[i];
+        return;
+    }
 
-    const dtQueryFilter* queryFilter = filter ? filter : queryFilter_.Get();
-    dtPolyRef startRef;
-    dtPolyRef endRef;
-    navMeshQuery_->findNearestPoly(&localStart.x_, &extents.x_, queryFilter, &startRef, nullptr);
-    navMeshQuery_->findNearestPoly(&localEnd.x_, &extents.x_, queryFilter, &endRef, nullptr);
+    // Without entrances to pass through, return the end points if a path exists between them
+    PODVector<NavigationPathPoint> path;
+    PathQueryBatch batch;
+    batch.mesh_ = this;
+    batch.transform_ = transform;
+    batch.inverse_ = inverse;
+    FindPathWithQuery(path, navMeshQuery_, *pathData_, start, end, extents, filter ? filter : queryFilter_.Get(), batch);
+    if (!path.Empty())
+    {
+        dest.Push(path.Front().position_);
+        dest.Push(path.Back().position_);
+    }
+}
 
-    if (!startRef || !endRef)
-        return;
+void NavigationMesh::SetHierarchicalPathfinding(bool enable)
+{
+    hierarchicalPathfinding_ = enable;
+    MarkNetworkUpdate();
+}
 
-    int numPolys = 0;
-    int numPathPoints = 0;
+void NavigationMesh::SetHierarchicalPathDistance(float distance)
+{
+    hierarchicalPathDistance_ = Max(distance, 0.0f);
+    MarkNetworkUpdate();
+}
 
-    navMeshQuery_->findPath(startRef, endRef, &localStart.x_, &localEnd.x_, queryFilter, pathData_->polys_, &numPolys,
-        MAX_POLYS);
-    if (!numPolys)
+void NavigationMesh::ClearPathGraph()
+{
+    pathGraph_->clusters_.Clear();
+}
+
+SharedPtr<NavigationPathRequest> NavigationMesh::FindPathAsync(const Vector3& start, const Vector3& end, const Vector3& extents,
+    const dtQueryFilter* filter, bool sliced)
+{
+    SharedPtr<NavigationPathRequest> request(new NavigationPathRequest());
+    request->start_ = start;
+    request->end_ = end;
+    request->extents_ = extents;
+    request->filter_ = filter;
+    request->sliced_ = sliced;
+
+    if (sliced)
+        slicedPathRequests_.Push(request);
+    else
+        pathRequests_.Push(request);
+
+    UpdatePostUpdateSubscription();
+    return request;
+}
+
+void NavigationMesh::CompletePathRequests()
+{
+    UpdatePathRequests(true);
+}
+
+void NavigationMesh::CancelPathRequests()
+{
+    for (const SharedPtr<NavigationPathRequest>& request : pathRequests_)
+        request->completed_ = true;
+    for (const SharedPtr<NavigationPathRequest>& request : slicedPathRequests_)
+        request->completed_ = true;
+
+    pathRequests_.Clear();
+    slicedPathRequests_.Clear();
+    UpdatePostUpdateSubscription();
+}
+
+void NavigationMesh::SetPathIterationBudget(unsigned iterations)
+{
+    pathIterationBudget_ = Max(iterations, 1U);
+}
+
+void NavigationMesh::AddStreamingPoint(Node* node)
+{
+    if (!node)
         return;
 
-    Vector3 actualLocalEnd = localEnd;
+    WeakPtr<Node> nodeWeak(node);
+    if (!streamingPoints_.Contains(nodeWeak))
+    {
+        streamingPoints_.Push(nodeWeak);
+        UpdatePostUpdateSubscription();
+    }
+}
 
-    // If full path was not found, clamp end point to the end polygon
-    if (pathData_->polys_[numPolys - 1] != endRef)
-        navMeshQuery_->closestPointOnPoly(pathData_->polys_[numPolys - 1], &localEnd.x_, &actualLocalEnd.x_, nullptr);
+void NavigationMesh::RemoveStreamingPoint(Node* node)
+{
+    streamingPoints_.Remove(WeakPtr<Node>(node));
+}
+
+void NavigationMesh::RemoveAllStreamingPoints()
+{
+    streamingPoints_.Clear();
+}
 
-    navMeshQuery_->findStraightPath(&localStart.x_, &actualLocalEnd.x_, pathData_->polys_, numPolys,
-        &pathData_->pathPoints_[0].x_, pathData_->pathFlags_, pathData_->pathPolys_, &numPathPoints, MAX_POLYS);
+void NavigationMesh::UnloadStreamedTiles()
+{
+    CancelTileLoads();
 
-    // Transform path result back to world space
-    for (int i = 0; i < numPathPoints; ++i)
+    PODVector<IntVector2> tiles;
+    for (HashMap<IntVector2, unsigned>::ConstIterator i = streamedTiles_.Begin(); i != streamedTiles_.End(); ++i)
+        tiles.Push(i->first_);
+    for (unsigned i = 0; i < tiles.Size(); ++i)
+        UnloadStreamedTile(tiles[i]);
+
+    UpdatePostUpdateSubscription();
+}
+
+bool NavigationMesh::SaveStreamedTiles(const String& directory) const
+{
+    if (!navMesh_)
     {
-        NavigationPathPoint pt;
-        pt.position_ = transform * pathData_->pathPoints_[i];
-        pt.flag_ = (NavigationPathPointFlag)pathData_->pathFlags_[i];
+        URHO3D_LOGERROR("Navigation mesh must first be built before its tiles can be saved");
+        return false;
+    }
 
-        // Walk through all NavAreas and find nearest
-        unsigned nearestNavAreaID = 0;       // 0 is the default nav area ID
-        float nearestDistance = M_LARGE_VALUE;
-        for (unsigned j = 0; j < areas_.Size(); j++)
+    const String path = AddTrailingSlash(directory);
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    if (fileSystem && !fileSystem->CreateDir(path))
+    {
+        URHO3D_LOGERROR("Could not create directory " + path + " for the navigation mesh tiles");
+        return false;
+    }
+
+    unsigned numTiles = 0;
+    for (int z = 0; z < numTilesZ_; ++z)
+    {
+        for (int x = 0; x < numTilesX_; ++x)
         {
-            NavArea* area = areas_[j].Get();
-            if (area && area->IsEnabledEffective())
+            const IntVector2 tile(x, z);
+            if (!HasTile(tile))
+                continue;
+
+            PODVector<unsigned char> tileData = GetTileData(tile);
+            if (tileData.Empty())
+                continue;
+
+            File file(context_, path + GetTileFileName(tile), FILE_WRITE);
+            if (!file.IsOpen() || file.Write(tileData.Buffer(), tileData.Size()) != tileData.Size())
             {
-                BoundingBox bb = area->GetWorldBoundingBox();
-                if (bb.IsInside(pt.position_) == INSIDE)
-                {
-                    Vector3 areaWorldCenter = area->GetNode()->GetWorldPosition();
-                    float distance = (areaWorldCenter - pt.position_).LengthSquared();
-                    if (distance < nearestDistance)
-                    {
-                        nearestDistance = distance;
-                        nearestNavAreaID = area->GetAreaID();
-                    }
-                }
+                URHO3D_LOGERROR("Could not save navigation mesh tile to " + file.GetName());
+                return false;
             }
-        }
-        pt.areaID_ = (unsigned char)nearestNavAreaID;
 
-        dest.Push(pt);
+            ++numTiles;
+        }
     }
+
+    URHO3D_LOGDEBUG("Saved " + String(numTiles) + " navigation mesh tiles to " + path);
+    return true;
+}
+
+String NavigationMesh::GetStreamedTileName(const IntVector2& tile) const
+{
+    return AddTrailingSlash(tileStreamPath_) + GetTileFileName(tile);
 }
 
 Vector3 NavigationMesh::GetRandomPoint(const dtQueryFilter* filter, dtPolyRef* randomRef)
@@ -869,6 +1772,11 @@ BoundingBox NavigationMesh::GetWorldBoundingBox() const
     return node_ ? boundingBox_.Transformed(node_->GetWorldTransform()) : boundingBox_;
 }
 
+void NavigationMesh::SetAsyncBuildTimeBudget(float ms)
+{
+    asyncBuildTimeBudget_ = Max(ms, 0.0f);
+}
+
 float NavigationMesh::GetAreaCost(unsigned areaID) const
 {
     if (queryFilter_)
@@ -940,11 +1848,13 @@ PODVector<unsigned char> NavigationMesh::GetNavigationDataAttr() const
         ret.WriteInt(params->maxTiles);
         ret.WriteInt(params->maxPolys);
 
-        const dtNavMesh* navMesh = navMesh_;
-
-        for (int z = 0; z < numTilesZ_; ++z)
-            for (int x = 0; x < numTilesX_; ++x)
-                WriteTile(ret, x, z);
+        // Streamed tiles are saved to their own files instead
+        if (!tileStreaming_)
+        {
+            for (int z = 0; z < numTilesZ_; ++z)
+                for (int x = 0; x < numTilesX_; ++x)
+                    WriteTile(ret, x, z);
+        }
     }
 
     return ret.GetBuffer();
@@ -1002,6 +1912,22 @@ void NavigationMesh::CollectGeometries(Vector<NavigationGeometryInfo>& geometryL
             areas_.Push(WeakPtr<NavArea>(area));
         }
     }
+
+    // Forget the cached triangles of the components that no longer contribute
+    if (!geometryCache_.Empty())
+    {
+        HashSet<Component*> contributors;
+        for (unsigned i = 0; i < geometryList.Size(); ++i)
+            contributors.Insert(geometryList[i].component_);
+
+        for (HashMap<Component*, GeometryCacheEntry>::Iterator i = geometryCache_.Begin(); i != geometryCache_.End();)
+        {
+            if (!contributors.Contains(i->first_) || i->second_.component_.Expired())
+                i = geometryCache_.Erase(i);
+            else
+                ++i;
+        }
+    }
 }
 
 void NavigationMesh::CollectGeometries(Vector<NavigationGeometryInfo>& geometryList, Node* node, HashSet<Node*>& processedNodes,
@@ -1060,7 +1986,13 @@ void NavigationMesh::CollectGeometries(Vector<NavigationGeometryInfo>& geometryL
             NavigationGeometryInfo info;
 
             if (drawable->GetType() == StaticModel::GetTypeStatic())
-                info.lodLevel_ = static_cast<StaticModel*>(drawable)->GetOcclusionLodLevel();
+            {
+                auto* staticModel = static_cast<StaticModel*>(drawable);
+                info.lodLevel_ = staticModel->GetOcclusionLodLevel();
+                // The geometry is read later, possibly in worker threads, so make the shadow data available now
+                if (staticModel->GetModel())
+                    staticModel->GetModel()->RequestShadowData();
+            }
             else if (drawable->GetType() == TerrainPatch::GetTypeStatic())
                 info.lodLevel_ = 0;
             else
@@ -1082,119 +2014,7 @@ void NavigationMesh::CollectGeometries(Vector<NavigationGeometryInfo>& geometryL
     }
 }
 
-void NavigationMesh::GetTileGeometry(NavBuildData* build, Vector<NavigationGeometryInfo>& geometryList, BoundingBox& box)
-{
-    Matrix3x4 inverse = node_->GetWorldTransform().Inverse();
-
-    for (unsigned i = 0; i < geometryList.Size(); ++i)
-    {
-        if (box.IsInsideFast(geometryList[i].boundingBox_) != OUTSIDE)
-        {
-            const Matrix3x4& transform = geometryList[i].transform_;
-
-            if (geometryList[i].component_->GetType() == OffMeshConnection::GetTypeStatic())
-            {
-                auto* connection = static_cast<OffMeshConnection*>(geometryList[i].component_);
-                Vector3 start = inverse * connection->GetNode()->GetWorldPosition();
-                Vector3 end = inverse * connection->GetEndPoint()->GetWorldPosition();
-
-                build->offMeshVertices_.Push(start);
-                build->offMeshVertices_.Push(end);
-                build->offMeshRadii_.Push(connection->GetRadius());
-                build->offMeshFlags_.Push((unsigned short)connection->GetMask());
-                build->offMeshAreas_.Push((unsigned char)connection->GetAreaID());
-                build->offMeshDir_.Push((unsigned char)(connection->IsBidirectional() ? DT_OFFMESH_CON_BIDIR : 0));
-                continue;
-            }
-            else if (geometryList[i].component_->GetType() == NavArea::GetTypeStatic())
-            {
-                auto* area = static_cast<NavArea*>(geometryList[i].component_);
-                NavAreaStub stub;
-                stub.areaID_ = (unsigned char)area->GetAreaID();
-                stub.bounds_ = area->GetWorldBoundingBox();
-                build->navAreas_.Push(stub);
-                continue;
-            }
-
-#ifdef URHO3D_PHYSICS
-            auto* shape = dynamic_cast<CollisionShape*>(geometryList[i].component_);
-            if (shape)
-            {
-                switch (shape->GetShapeType())
-                {
-                case SHAPE_TRIANGLEMESH:
-                    {
-                        Model* model = shape->GetModel();
-                        if (!model)
-                            continue;
-
-                        unsigned lodLevel = shape->GetLodLevel();
-                        for (unsigned j = 0; j < model->GetNumGeometries(); ++j)
-                            AddTriMeshGeometry(build, model->GetGeometry(j, lodLevel), transform);
-                    }
-                    break;
-
-                case SHAPE_CONVEXHULL:
-                    {
-                        auto* data = static_cast<ConvexData*>(shape->GetGeometryData());
-                        if (!data)
-                            continue;
-
-                        unsigned numVertices = data->vertexCount_;
-                        unsigned numIndices = data->indexCount_;
-                        unsigned destVertexStart = build->vertices_.Size();
-
-                        for (unsigned j = 0; j < numVertices; ++j)
-                            build->vertices_.Push(transform * data->vertexData_[j]);
-
-                        for (unsigned j = 0; j < numIndices; ++j)
-                            build->indices_.Push(data->indexData_[j] + destVertexStart);
-                    }
-                    break;
-
-                case SHAPE_BOX:
-                    {
-                        unsigned destVertexStart = build->vertices_.Size();
-
-                        build->vertices_.Push(transform * Vector3(-0.5f, 0.5f, -0.5f));
-                        build->vertices_.Push(transform * Vector3(0.5f, 0.5f, -0.5f));
-                        build->vertices_.Push(transform * Vector3(0.5f, -0.5f, -0.5f));
-                        build->vertices_.Push(transform * Vector3(-0.5f, -0.5f, -0.5f));
-                        build->vertices_.Push(transform * Vector3(-0.5f, 0.5f, 0.5f));
-                        build->vertices_.Push(transform * Vector3(0.5f, 0.5f, 0.5f));
-                        build->vertices_.Push(transform * Vector3(0.5f, -0.5f, 0.5f));
-                        build->vertices_.Push(transform * Vector3(-0.5f, -0.5f, 0.5f));
-
-                        const unsigned indices[] = {
-                            0, 1, 2, 0, 2, 3, 1, 5, 6, 1, 6, 2, 4, 5, 1, 4, 1, 0, 5, 4, 7, 5, 7, 6,
-                            4, 0, 3, 4, 3, 7, 1, 0, 4, 1, 4, 5
-                        };
-
-                        for (unsigned index : indices)
-                            build->indices_.Push(index + destVertexStart);
-                    }
-                    break;
-
-                default:
-                    break;
-                }
-
-                continue;
-            }
-#endif
-            auto* drawable = dynamic_cast<Drawable*>(geometryList[i].component_);
-            if (drawable)
-            {
-                const Vector<SourceBatch>& batches = drawable->GetBatches();
-
-                for (unsigned j = 0; j < batches.Size(); ++j)
-                    AddTriMeshGeometry(build, drawable->GetLodGeometry(j, geometryList[i].lodLevel_), transform);
-            }
-        }
-    }
-}
-
-void NavigationMesh::AddTriMeshGeometry(NavBuildData* build, Geometry* geometry, const Matrix3x4& transform)
+static void ExtractTriMeshGeometry(PODVector<Vector3>& vertices, PODVector<int>& indices, Geometry* geometry, const Matrix3x4& transform)
 {
     if (!geometry)
         return;
@@ -1217,43 +2037,223 @@ void NavigationMesh::AddTriMeshGeometry(NavBuildData* build, Geometry* geometry,
     if (!srcIndexCount)
         return;
 
-    unsigned destVertexStart = build->vertices_.Size();
+    unsigned destVertexStart = vertices.Size();
 
     for (unsigned k = srcVertexStart; k < srcVertexStart + srcVertexCount; ++k)
     {
         Vector3 vertex = transform * *((const Vector3*)(&vertexData[k * vertexSize]));
-        build->vertices_.Push(vertex);
+        vertices.Push(vertex);
     }
 
     // Copy remapped indices
     if (indexSize == sizeof(unsigned short))
     {
-        const unsigned short* indices = ((const unsigned short*)indexData) + srcIndexStart;
-        const unsigned short* indicesEnd = indices + srcIndexCount;
+        const unsigned short* srcIndices = ((const unsigned short*)indexData) + srcIndexStart;
+        const unsigned short* srcIndicesEnd = srcIndices + srcIndexCount;
 
-        while (indices < indicesEnd)
+        while (srcIndices < srcIndicesEnd)
         {
-            build->indices_.Push(*indices - srcVertexStart + destVertexStart);
-            ++indices;
+            indices.Push(*srcIndices - srcVertexStart + destVertexStart);
+            ++srcIndices;
         }
     }
     else
     {
-        const unsigned* indices = ((const unsigned*)indexData) + srcIndexStart;
-        const unsigned* indicesEnd = indices + srcIndexCount;
+        const unsigned* srcIndices = ((const unsigned*)indexData) + srcIndexStart;
+        const unsigned* srcIndicesEnd = srcIndices + srcIndexCount;
 
-        while (indices < indicesEnd)
+        while (srcIndices < srcIndicesEnd)
         {
-            build->indices_.Push(*indices - srcVertexStart + destVertexStart);
-            ++indices;
+            indices.Push(*srcIndices - srcVertexStart + destVertexStart);
+            ++srcIndices;
         }
     }
 }
 
-void NavigationMesh::WriteTile(Serializer& dest, int x, int z) const
+/// Extract the triangles of a navigation geometry component in the navigation mesh node space.
+static void ExtractGeometry(const NavigationGeometryInfo& info, PODVector<Vector3>& vertices, PODVector<int>& indices)
 {
-    const dtNavMesh* navMesh = navMesh_;
-    const dtMeshTile* tile = navMesh->getTileAt(x, z, 0);
+    const Matrix3x4& transform = info.transform_;
+
+#ifdef URHO3D_PHYSICS
+    auto* shape = dynamic_cast<CollisionShape*>(info.component_);
+    if (shape)
+    {
+        switch (shape->GetShapeType())
+        {
+        case SHAPE_TRIANGLEMESH:
+            {
+                Model* model = shape->GetModel();
+                if (!model)
+                    return;
+
+                unsigned lodLevel = shape->GetLodLevel();
+                for (unsigned j = 0; j < model->GetNumGeometries(); ++j)
+                    ExtractTriMeshGeometry(vertices, indices, model->GetGeometry(j, lodLevel), transform);
+            }
+            break;
+
+        case SHAPE_CONVEXHULL:
+            {
+                auto* data = static_cast<ConvexData*>(shape->GetGeometryData());
+                if (!data)
+                    return;
+
+                unsigned numVertices = data->vertexCount_;
+                unsigned numIndices = data->indexCount_;
+                unsigned destVertexStart = vertices.Size();
+
+                for (unsigned j = 0; j < numVertices; ++j)
+                    vertices.Push(transform * data->vertexData_[j]);
+
+                for (unsigned j = 0; j < numIndices; ++j)
+                    indices.Push(data->indexData_[j] + destVertexStart);
+            }
+            break;
+
+        case SHAPE_BOX:
+            {
+                unsigned destVertexStart = vertices.Size();
+
+                vertices.Push(transform * Vector3(-0.5f, 0.5f, -0.5f));
+                vertices.Push(transform * Vector3(0.5f, 0.5f, -0.5f));
+                vertices.Push(transform * Vector3(0.5f, -0.5f, -0.5f));
+                vertices.Push(transform * Vector3(-0.5f, -0.5f, -0.5f));
+                vertices.Push(transform * Vector3(-0.5f, 0.5f, 0.5f));
+                vertices.Push(transform * Vector3(0.5f, 0.5f, 0.5f));
+                vertices.Push(transform * Vector3(0.5f, -0.5f, 0.5f));
+                vertices.Push(transform * Vector3(-0.5f, -0.5f, 0.5f));
+
+                const unsigned boxIndices[] = {
+                    0, 1, 2, 0, 2, 3, 1, 5, 6, 1, 6, 2, 4, 5, 1, 4, 1, 0, 5, 4, 7, 5, 7, 6,
+                    4, 0, 3, 4, 3, 7, 1, 0, 4, 1, 4, 5
+                };
+
+                for (unsigned index : boxIndices)
+                    indices.Push(index + destVertexStart);
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        return;
+    }
+#endif
+    auto* drawable = dynamic_cast<Drawable*>(info.component_);
+    if (drawable)
+    {
+        const Vector<SourceBatch>& batches = drawable->GetBatches();
+
+        for (unsigned j = 0; j < batches.Size(); ++j)
+            ExtractTriMeshGeometry(vertices, indices, drawable->GetLodGeometry(j, info.lodLevel_), transform);
+    }
+}
+
+/// Return the resources and geometries the triangles of a navigation geometry component are extracted from.
+static void GetGeometrySources(const NavigationGeometryInfo& info, PODVector<const void*>& dest)
+{
+#ifdef URHO3D_PHYSICS
+    auto* shape = dynamic_cast<CollisionShape*>(info.component_);
+    if (shape)
+    {
+        // The collision geometry data is recreated whenever the shape type, model or LOD level changes
+        dest.Push(shape->GetModel());
+        dest.Push(shape->GetGeometryData());
+        return;
+    }
+#endif
+    auto* drawable = dynamic_cast<Drawable*>(info.component_);
+    if (drawable)
+    {
+        const Vector<SourceBatch>& batches = drawable->GetBatches();
+        for (unsigned j = 0; j < batches.Size(); ++j)
+            dest.Push(drawable->GetLodGeometry(j, info.lodLevel_));
+    }
+}
+
+void NavigationMesh::GetTileGeometry(NavBuildData* build, Vector<NavigationGeometryInfo>& geometryList, BoundingBox& box)
+{
+    Matrix3x4 inverse = node_->GetWorldTransform().Inverse();
+
+    for (unsigned i = 0; i < geometryList.Size(); ++i)
+    {
+        if (box.IsInsideFast(geometryList[i].boundingBox_) != OUTSIDE)
+        {
+            if (geometryList[i].component_->GetType() == OffMeshConnection::GetTypeStatic())
+            {
+                auto* connection = static_cast<OffMeshConnection*>(geometryList[i].component_);
+                Vector3 start = inverse * connection->GetNode()->GetWorldPosition();
+                Vector3 end = inverse * connection->GetEndPoint()->GetWorldPosition();
+
+                build->offMeshVertices_.Push(start);
+                build->offMeshVertices_.Push(end);
+                build->offMeshRadii_.Push(connection->GetRadius());
+                build->offMeshFlags_.Push((unsigned short)connection->GetMask());
+                build->offMeshAreas_.Push((unsigned char)connection->GetAreaID());
+                build->offMeshDir_.Push((unsigned char)(connection->IsBidirectional() ? DT_OFFMESH_CON_BIDIR : 0));
+                continue;
+            }
+            else if (geometryList[i].component_->GetType() == NavArea::GetTypeStatic())
+            {
+                auto* area = static_cast<NavArea*>(geometryList[i].component_);
+                NavAreaStub stub;
+                stub.areaID_ = (unsigned char)area->GetAreaID();
+                stub.bounds_ = area->GetWorldBoundingBox();
+                build->navAreas_.Push(stub);
+                continue;
+            }
+
+
+            AddCachedGeometry(build, geometryList[i]);
+        }
+    }
+}
+
+void NavigationMesh::AddCachedGeometry(NavBuildData* build, const NavigationGeometryInfo& info)
+{
+    PODVector<const void*> sources;
+    GetGeometrySources(info, sources);
+
+    // Extract the triangles again only if the component, its transform or the geometry it uses have changed
+    GeometryCacheEntry& entry = geometryCache_[info.component_];
+    if (entry.component_ != info.component_ || entry.transform_ != info.transform_ || entry.boundingBox_ != info.boundingBox_ ||
+        entry.sources_ != sources)
+    {
+        entry.component_ = info.component_;
+        entry.transform_ = info.transform_;
+        entry.boundingBox_ = info.boundingBox_;
+        entry.sources_ = sources;
+        entry.vertices_.Clear();
+        entry.indices_.Clear();
+        ExtractGeometry(info, entry.vertices_, entry.indices_);
+    }
+
+    unsigned destVertexStart = build->vertices_.Size();
+    build->vertices_.Push(entry.vertices_);
+    build->indices_.Reserve(build->indices_.Size() + entry.indices_.Size());
+    for (unsigned i = 0; i < entry.indices_.Size(); ++i)
+        build->indices_.Push(entry.indices_[i] + destVertexStart);
+}
+
+void NavigationMesh::ClearGeometryCache(Component* component)
+{
+    if (component)
+        geometryCache_.Erase(component);
+    else
+        geometryCache_.Clear();
+}
+
+void NavigationMesh::AddTriMeshGeometry(NavBuildData* build, Geometry* geometry, const Matrix3x4& transform)
+{
+    ExtractTriMeshGeometry(build->vertices_, build->indices_, geometry, transform);
+}
+
+void NavigationMesh::WriteTile(Serializer& dest, int x, int z) const
+{
+    const dtNavMesh* navMesh = navMesh_;
+    const dtMeshTile* tile = navMesh->getTileAt(x, z, 0);
     if (!tile)
         return;
 
@@ -1303,15 +2303,31 @@ bool NavigationMesh::BuildTile(Vector<NavigationGeometryInfo>& geometryList, int
 {
     URHO3D_PROFILE(BuildNavigationMeshTile);
 
-    // Remove previous tile (if any)
-    navMesh_->removeTile(navMesh_->getTileRefAt(x, z, 0), nullptr, nullptr);
+    SharedPtr<TileBuild> tileBuild = PrepareTileBuild(geometryList, x, z);
+    bool success = BuildTileData(*tileBuild);
+    AddTileData(*tileBuild);
 
-    const BoundingBox tileBoundingBox = GetTileBoundingBox(IntVector2(x, z));
+    // The added tile data is owned by the navigation mesh, so data left over means that adding failed
+    return success && tileBuild->tileData_.Empty();
+}
+
+NavBuildData* NavigationMesh::CreateTileBuildData()
+{
+    return new SimpleNavBuildData();
+}
+
+SharedPtr<NavigationMesh::TileBuild> NavigationMesh::PrepareTileBuild(Vector<NavigationGeometryInfo>& geometryList, int x, int z)
+{
+    SharedPtr<TileBuild> tileBuild(new TileBuild(IntVector2(x, z), CreateTileBuildData()));
+    tileBuild->boundingBox_ = GetTileBoundingBox(tileBuild->tile_);
+    tileBuild->agentHeight_ = agentHeight_;
+    tileBuild->agentRadius_ = agentRadius_;
+    tileBuild->agentMaxClimb_ = agentMaxClimb_;
+    tileBuild->partitionType_ = partitionType_;
 
-    SimpleNavBuildData build;
+    const BoundingBox& tileBoundingBox = tileBuild->boundingBox_;
 
-    rcConfig cfg;       // NOLINT(hicpp-member-init)
-    memset(&cfg, 0, sizeof cfg);
+    rcConfig& cfg = *tileBuild->config_;
     cfg.cs = cellSize_;
     cfg.ch = cellHeight_;
     cfg.walkableSlopeAngle = agentMaxSlope_;
@@ -1338,7 +2354,15 @@ bool NavigationMesh::BuildTile(Vector<NavigationGeometryInfo>& geometryList, int
     cfg.bmax[2] += cfg.borderSize * cfg.cs;
 
     BoundingBox expandedBox(*reinterpret_cast<Vector3*>(cfg.bmin), *reinterpret_cast<Vector3*>(cfg.bmax));
-    GetTileGeometry(&build, geometryList, expandedBox);
+    GetTileGeometry(tileBuild->build_.Get(), geometryList, expandedBox);
+
+    return tileBuild;
+}
+
+bool NavigationMesh::BuildTileData(TileBuild& tileBuild) const
+{
+    SimpleNavBuildData& build = static_cast<SimpleNavBuildData&>(*tileBuild.build_);
+    const rcConfig& cfg = *tileBuild.config_;
 
     if (build.vertices_.Empty() || build.indices_.Empty())
         return true; // Nothing to do
@@ -1393,7 +2417,7 @@ bool NavigationMesh::BuildTile(Vector<NavigationGeometryInfo>& geometryList, int
         rcMarkBoxArea(build.ctx_, &build.navAreas_[i].bounds_.min_.x_, &build.navAreas_[i].bounds_.max_.x_,
             build.navAreas_[i].areaID_, *build.compactHeightField_);
 
-    if (this->partitionType_ == NAVMESH_PARTITION_WATERSHED)
+    if (tileBuild.partitionType_ == NAVMESH_PARTITION_WATERSHED)
     {
         if (!rcBuildDistanceField(build.ctx_, *build.compactHeightField_))
         {
@@ -1479,11 +2503,11 @@ bool NavigationMesh::BuildTile(Vector<NavigationGeometryInfo>& geometryList, int
     params.detailVertsCount = build.polyMeshDetail_->nverts;
     params.detailTris = build.polyMeshDetail_->tris;
     params.detailTriCount = build.polyMeshDetail_->ntris;
-    params.walkableHeight = agentHeight_;
-    params.walkableRadius = agentRadius_;
-    params.walkableClimb = agentMaxClimb_;
-    params.tileX = x;
-    params.tileY = z;
+    params.walkableHeight = tileBuild.agentHeight_;
+    params.walkableRadius = tileBuild.agentRadius_;
+    params.walkableClimb = tileBuild.agentMaxClimb_;
+    params.tileX = tileBuild.tile_.x_;
+    params.tileY = tileBuild.tile_.y_;
     rcVcopy(params.bmin, build.polyMesh_->bmin);
     rcVcopy(params.bmax, build.polyMesh_->bmax);
     params.cs = cfg.cs;
@@ -1507,24 +2531,41 @@ bool NavigationMesh::BuildTile(Vector<NavigationGeometryInfo>& geometryList, int
         return false;
     }
 
-    if (dtStatusFailed(navMesh_->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, nullptr)))
+    tileBuild.tileData_.Push(MakePair(navData, navDataSize));
+    return true;
+}
+
+unsigned NavigationMesh::AddTileData(TileBuild& tileBuild)
+{
+    const IntVector2& tile = tileBuild.tile_;
+
+    // Remove previous tile (if any)
+    navMesh_->removeTile(navMesh_->getTileRefAt(tile.x_, tile.y_, 0), nullptr, nullptr);
+
+    if (tileBuild.tileData_.Empty())
+        return 0;
+
+    const Pair<unsigned char*, int>& navData = tileBuild.tileData_.Front();
+    if (dtStatusFailed(navMesh_->addTile(navData.first_, navData.second_, DT_TILE_FREE_DATA, 0, nullptr)))
     {
         URHO3D_LOGERROR("Failed to add navigation mesh tile");
-        dtFree(navData);
-        return false;
+        return 0;
     }
 
+    // The navigation mesh frees the data from now on
+    tileBuild.tileData_.Clear();
+
     // Send a notification of the rebuild of this tile to anyone interested
     {
         using namespace NavigationAreaRebuilt;
         VariantMap& eventData = GetContext()->GetEventDataMap();
         eventData[P_NODE] = GetNode();
         eventData[P_MESH] = this;
-        eventData[P_BOUNDSMIN] = Variant(tileBoundingBox.min_);
-        eventData[P_BOUNDSMAX] = Variant(tileBoundingBox.max_);
+        eventData[P_BOUNDSMIN] = Variant(tileBuild.boundingBox_.min_);
+        eventData[P_BOUNDSMAX] = Variant(tileBuild.boundingBox_.max_);
         SendEvent(E_NAVIGATION_AREA_REBUILT, eventData);
     }
-    return true;
+    return 1;
 }
 
 unsigned NavigationMesh::BuildTiles(Vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to)
@@ -1542,6 +2583,41 @@ unsigned NavigationMesh::BuildTiles(Vector<NavigationGeometryInfo>& geometryList
     return numTiles;
 }
 
+bool NavigationMesh::FindLocalWaypoints(PODVector<Vector3>& dest, const Vector3& localStart, const Vector3& localEnd,
+    const Vector3& extents, const dtQueryFilter* filter)
+{
+    dtPolyRef startRef;
+    dtPolyRef endRef;
+    Vector3 nearestStart;
+    Vector3 nearestEnd;
+    navMeshQuery_->findNearestPoly(&localStart.x_, &extents.x_, filter, &startRef, &nearestStart.x_);
+    navMeshQuery_->findNearestPoly(&localEnd.x_, &extents.x_, filter, &endRef, &nearestEnd.x_);
+    if (!startRef || !endRef)
+        return false;
+
+    const float tileEdgeLength = (float)tileSize_ * cellSize_;
+    const IntVector2 maxTile = GetNumTiles() - IntVector2::ONE;
+    const IntVector2 startTile = VectorMin(VectorMax(IntVector2::ZERO,
+        VectorFloorToInt(Vector2(nearestStart.x_ - boundingBox_.min_.x_, nearestStart.z_ - boundingBox_.min_.z_) / tileEdgeLength)), maxTile);
+    const IntVector2 endTile = VectorMin(VectorMax(IntVector2::ZERO,
+        VectorFloorToInt(Vector2(nearestEnd.x_ - boundingBox_.min_.x_, nearestEnd.z_ - boundingBox_.min_.z_) / tileEdgeLength)), maxTile);
+
+    // The neighbouring tiles are searched directly
+    if (Abs(startTile.x_ - endTile.x_) <= 1 && Abs(startTile.y_ - endTile.y_) <= 1)
+        return false;
+
+    // The cached path lengths are for the default filter, the given filter only restricts the local searches
+    NavigationPathGraph& graph = *pathGraph_;
+    graph.navMesh_ = navMesh_;
+    graph.query_ = navMeshQuery_;
+    graph.data_ = pathData_.Get();
+    graph.filter_ = queryFilter_.Get();
+    graph.cellSize_ = cellSize_;
+    graph.agentHeight_ = agentHeight_;
+    graph.agentMaxClimb_ = agentMaxClimb_;
+    return graph.FindWaypoints(dest, startRef, nearestStart, endRef, nearestEnd, startTile, endTile);
+}
+
 bool NavigationMesh::InitializeQuery()
 {
     if (!navMesh_ || !node_)
@@ -1568,12 +2644,30 @@ bool NavigationMesh::InitializeQuery()
 
 void NavigationMesh::ReleaseNavigationMesh()
 {
+    CancelAsyncBuild();
+    CancelTileLoads();
+    streamedTiles_.Clear();
+    streamingMemoryUse_ = 0;
+
+    // Tile references of a new navigation mesh could match the old ones
+    pathGraph_->clusters_.Clear();
+
     dtFreeNavMesh(navMesh_);
     navMesh_ = nullptr;
 
     dtFreeNavMeshQuery(navMeshQuery_);
     navMeshQuery_ = nullptr;
 
+    for (unsigned i = 0; i < threadQueries_.Size(); ++i)
+        dtFreeNavMeshQuery(threadQueries_[i]);
+    threadQueries_.Clear();
+
+    // A sliced path search in progress is restarted on the new navigation mesh
+    dtFreeNavMeshQuery(slicedQuery_);
+    slicedQuery_ = nullptr;
+    if (!slicedPathRequests_.Empty())
+        slicedPathRequests_.Front()->started_ = false;
+
     numTilesX_ = 0;
     numTilesZ_ = 0;
     boundingBox_.Clear();
@@ -1585,6 +2679,530 @@ void NavigationMesh::SetPartitionType(NavmeshPartitionType partitionType)
     MarkNetworkUpdate();
 }
 
+void NavigationMesh::SetTileStreaming(bool enable)
+{
+    if (enable == tileStreaming_)
+        return;
+
+    tileStreaming_ = enable;
+
+    // When streaming is disabled the resident tiles stay in the navigation mesh as regular tiles
+    if (!tileStreaming_)
+    {
+        CancelTileLoads();
+        streamedTiles_.Clear();
+        streamingMemoryUse_ = 0;
+    }
+
+    UpdatePostUpdateSubscription();
+    MarkNetworkUpdate();
+}
+
+void NavigationMesh::SetTileStreamPath(const String& path)
+{
+    tileStreamPath_ = path;
+    MarkNetworkUpdate();
+}
+
+void NavigationMesh::SetStreamingRadius(float radius)
+{
+    streamingRadius_ = Max(radius, 0.0f);
+    MarkNetworkUpdate();
+}
+
+void NavigationMesh::SetStreamingMemoryBudget(unsigned bytes)
+{
+    streamingMemoryBudget_ = bytes;
+    MarkNetworkUpdate();
+}
+
+void NavigationMesh::OnSceneSet(Scene* scene)
+{
+    if (!scene)
+    {
+        CancelAsyncBuild();
+        CancelPathRequests();
+        CancelTileLoads();
+    }
+    else
+        UpdatePostUpdateSubscription();
+}
+
+void NavigationMesh::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    // Add the finished tiles first, so that the paths are found on the updated navigation mesh
+    if (!tileBuilds_.Empty())
+        UpdateAsyncBuild(false);
+    if (tileStreaming_ || !tileLoads_.Empty())
+        UpdateTileStreaming();
+    UpdatePathRequests(false);
+}
+
+void NavigationMesh::UpdateAsyncBuild(bool complete)
+{
+    URHO3D_PROFILE(AddAsyncNavigationMeshTiles);
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    HiresTimer timer;
+    auto budget = (long long)(asyncBuildTimeBudget_ * 1000.0f);
+
+    // Add the tiles in order, so that a later rebuild of the same tile replaces an earlier one
+    unsigned numAdded = 0;
+    while (numAdded < tileBuilds_.Size())
+    {
+        TileBuild* tileBuild = tileBuilds_[numAdded];
+        if (!tileBuild->item_->completed_)
+        {
+            if (!complete)
+                break;
+            if (queue)
+                queue->Wait(tileBuild->item_);
+        }
+        if (!complete && numAdded && timer.GetUSec(false) >= budget)
+            break;
+
+        numAsyncTiles_ += AddTileData(*tileBuild);
+        ++numAdded;
+    }
+
+    tileBuilds_.Erase(0, numAdded);
+    if (!tileBuilds_.Empty())
+        return;
+
+    UpdatePostUpdateSubscription();
+
+    using namespace NavigationAsyncRebuilt;
+    VariantMap& eventData = GetContext()->GetEventDataMap();
+    eventData[P_NODE] = GetNode();
+    eventData[P_MESH] = this;
+    eventData[P_NUMTILES] = numAsyncTiles_;
+    SendEvent(E_NAVIGATION_ASYNC_REBUILT, eventData);
+}
+
+void NavigationMesh::BuildTileWork(const WorkItem* item, unsigned /*threadIndex*/)
+{
+    auto* mesh = static_cast<NavigationMesh*>(item->aux_);
+    auto* tileBuild = static_cast<TileBuild*>(item->start_);
+    mesh->BuildTileData(*tileBuild);
+}
+
+void NavigationMesh::UpdatePathRequests(bool complete)
+{
+    if (pathRequests_.Empty() && slicedPathRequests_.Empty())
+        return;
+
+    URHO3D_PROFILE(UpdatePathRequests);
+
+    Vector<SharedPtr<NavigationPathRequest> > completed;
+
+    if (InitializePathQueries())
+    {
+        PathQueryBatch batch;
+        batch.mesh_ = this;
+        batch.transform_ = node_->GetWorldTransform();
+        batch.inverse_ = batch.transform_.Inverse();
+        CollectPathAreas(areas_, batch.areas_);
+
+        if (!pathRequests_.Empty())
+        {
+            // Returns when all the paths have been found, so the navigation mesh can not be modified meanwhile
+            auto* queue = GetSubsystem<WorkQueue>();
+            SharedPtr<NavigationPathRequest>* begin = pathRequests_.Buffer();
+            SharedPtr<NavigationPathRequest>* end = begin + pathRequests_.Size();
+            if (queue)
+                queue->ParallelFor(begin, end, FindPathWork, &batch, PATH_REQUESTS_PER_WORK_ITEM);
+            else
+            {
+                WorkItem item;
+                item.start_ = begin;
+                item.end_ = end;
+                item.aux_ = &batch;
+                FindPathWork(&item, 0);
+            }
+            completed.Swap(pathRequests_);
+        }
+
+        // Advance the sliced path searches one at a time in the main thread
+        auto iterations = (int)pathIterationBudget_;
+        unsigned numSliced = 0;
+        while (numSliced < slicedPathRequests_.Size() && (complete || iterations > 0))
+        {
+            NavigationPathRequest* request = slicedPathRequests_[numSliced];
+            const dtQueryFilter* filter = request->filter_ ? request->filter_ : queryFilter_.Get();
+
+            if (!request->started_)
+            {
+                slicedStart_ = batch.inverse_ * request->start_;
+                slicedEnd_ = batch.inverse_ * request->end_;
+
+                dtPolyRef startRef;
+                dtPolyRef endRef;
+                slicedQuery_->findNearestPoly(&slicedStart_.x_, &request->extents_.x_, filter, &startRef, nullptr);
+                slicedQuery_->findNearestPoly(&slicedEnd_.x_, &request->extents_.x_, filter, &endRef, nullptr);
+
+                if (!startRef || !endRef ||
+                    dtStatusFailed(slicedQuery_->initSlicedFindPath(startRef, endRef, &slicedStart_.x_, &slicedEnd_.x_, filter)))
+                {
+                    ++numSliced;
+                    continue;
+                }
+                request->started_ = true;
+            }
+
+            int doneIterations = 0;
+            dtStatus status = slicedQuery_->updateSlicedFindPath(complete ? M_MAX_INT : iterations, &doneIterations);
+            iterations -= doneIterations;
+            if (dtStatusInProgress(status))
+                continue;
+
+            if (dtStatusSucceed(status))
+            {
+                int numPolys = 0;
+                status = slicedQuery_->finalizeSlicedFindPath(pathData_->polys_, &numPolys, MAX_POLYS);
+                if (dtStatusSucceed(status))
+                {
+                    FinishPath(request->path_, slicedQuery_, *pathData_, numPolys, dtStatusDetail(status, DT_PARTIAL_RESULT),
+                        slicedStart_, slicedEnd_, batch.transform_, batch.areas_);
+                }
+            }
+            ++numSliced;
+        }
+
+        for (unsigned i = 0; i < numSliced; ++i)
+            completed.Push(slicedPathRequests_[i]);
+        slicedPathRequests_.Erase(0, numSliced);
+    }
+    else
+    {
+        // No navigation mesh to find the paths on
+        completed.Swap(pathRequests_);
+        completed.Push(slicedPathRequests_);
+        slicedPathRequests_.Clear();
+    }
+
+    UpdatePostUpdateSubscription();
+
+    // Send the events last, as the handlers may queue new requests
+    using namespace NavigationPathFound;
+    for (const SharedPtr<NavigationPathRequest>& request : completed)
+    {
+        request->completed_ = true;
+
+        VariantMap& eventData = GetContext()->GetEventDataMap();
+        eventData[P_NODE] = GetNode();
+        eventData[P_MESH] = this;
+        eventData[P_REQUEST] = request.Get();
+        eventData[P_SUCCESS] = !request->path_.Empty();
+        SendEvent(E_NAVIGATION_PATH_FOUND, eventData);
+    }
+}
+
+bool NavigationMesh::InitializePathQueries()
+{
+    if (!InitializeQuery())
+        return false;
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    unsigned numThreads = (queue ? queue->GetNumThreads() : 0) + 1;
+
+    // Worker threads may have been created after the queries
+    while (threadQueries_.Size() < numThreads)
+    {
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        if (!query || dtStatusFailed(query->init(navMesh_, MAX_POLYS)))
+        {
+            URHO3D_LOGERROR("Could not init navigation mesh query");
+            dtFreeNavMeshQuery(query);
+            return false;
+        }
+        threadQueries_.Push(query);
+    }
+    while (threadPathData_.Size() < numThreads)
+        threadPathData_.Push(UniquePtr<FindPathData>(new FindPathData()));
+
+    if (!slicedQuery_)
+    {
+        slicedQuery_ = dtAllocNavMeshQuery();
+        if (!slicedQuery_ || dtStatusFailed(slicedQuery_->init(navMesh_, MAX_POLYS)))
+        {
+            URHO3D_LOGERROR("Could not init navigation mesh query");
+            dtFreeNavMeshQuery(slicedQuery_);
+            slicedQuery_ = nullptr;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void NavigationMesh::UpdatePostUpdateSubscription()
+{
+    Scene* scene = GetScene();
+    const bool streaming = tileStreaming_ && (!streamingPoints_.Empty() || !streamedTiles_.Empty());
+    if (scene && (!tileBuilds_.Empty() || !pathRequests_.Empty() || !slicedPathRequests_.Empty() || !tileLoads_.Empty() || streaming))
+    {
+        if (!HasSubscribedToEvent(scene, E_SCENEPOSTUPDATE))
+            SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(NavigationMesh, HandleScenePostUpdate));
+    }
+    else
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+}
+
+void NavigationMesh::FindPathWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* batch = static_cast<PathQueryBatch*>(item->aux_);
+    NavigationMesh* mesh = batch->mesh_;
+    dtNavMeshQuery* query = mesh->threadQueries_[threadIndex];
+    FindPathData& data = *mesh->threadPathData_[threadIndex];
+
+    auto* start = static_cast<SharedPtr<NavigationPathRequest>*>(item->start_);
+    auto* end = static_cast<SharedPtr<NavigationPathRequest>*>(item->end_);
+    for (SharedPtr<NavigationPathRequest>* i = start; i != end; ++i)
+    {
+        NavigationPathRequest* request = i->Get();
+        FindPathWithQuery(request->path_, query, data, request->start_, request->end_, request->extents_,
+            request->filter_ ? request->filter_ : mesh->queryFilter_.Get(), *batch);
+    }
+}
+
+void NavigationMesh::UpdateTileStreaming()
+{
+    URHO3D_PROFILE(UpdateNavigationTileStreaming);
+
+    if (!navMesh_ || !node_ || !tileStreaming_)
+    {
+        CancelTileLoads();
+        return;
+    }
+
+    // Streaming points in the node space, as the tile bounding boxes
+    const Matrix3x4 inverse = node_->GetWorldTransform().Inverse();
+    PODVector<Vector3> points;
+    for (unsigned i = 0; i < streamingPoints_.Size();)
+    {
+        if (streamingPoints_[i])
+        {
+            points.Push(inverse * streamingPoints_[i]->GetWorldPosition());
+            ++i;
+        }
+        else
+            streamingPoints_.Erase(i);
+    }
+
+    // Unload only one tile beyond the radius, so that moving along the edge does not reload the same tiles repeatedly
+    const float tileEdgeLength = (float)tileSize_ * cellSize_;
+    const float unloadDistance = streamingRadius_ + tileEdgeLength;
+
+    // Add the loaded tiles within the time budget. At least one tile is added each frame
+    HiresTimer timer;
+    auto budget = (long long)(asyncBuildTimeBudget_ * 1000.0f);
+    unsigned numAdded = 0;
+    for (unsigned i = 0; i < tileLoads_.Size();)
+    {
+        TileLoad* load = tileLoads_[i];
+        if (!load->item_->completed_)
+        {
+            ++i;
+            continue;
+        }
+        if (numAdded && timer.GetUSec(false) >= budget)
+            break;
+
+        if (GetStreamingDistance(load->tile_, points) <= unloadDistance)
+            AddStreamedTile(load->tile_, load->data_, points);
+        tileLoads_.Erase(i);
+        ++numAdded;
+    }
+
+    PODVector<IntVector2> unloads;
+    float maxResidentDistance = 0.0f;
+    for (HashMap<IntVector2, unsigned>::ConstIterator i = streamedTiles_.Begin(); i != streamedTiles_.End(); ++i)
+    {
+        const float distance = GetStreamingDistance(i->first_, points);
+        if (distance > unloadDistance)
+            unloads.Push(i->first_);
+        else
+            maxResidentDistance = Max(maxResidentDistance, distance);
+    }
+    for (unsigned i = 0; i < unloads.Size(); ++i)
+        UnloadStreamedTile(unloads[i]);
+
+    // Start loading the missing tiles within the radius, nearest first
+    if (tileLoads_.Size() < MAX_TILE_LOADS)
+    {
+        HashSet<IntVector2> requested;
+        for (unsigned i = 0; i < tileLoads_.Size(); ++i)
+            requested.Insert(tileLoads_[i]->tile_);
+
+        PODVector<StreamedTileDistance> candidates;
+        const bool budgetFull = streamingMemoryBudget_ && streamingMemoryUse_ >= streamingMemoryBudget_;
+        for (unsigned i = 0; i < points.Size(); ++i)
+        {
+            const Vector3 localPoint = points[i] - boundingBox_.min_;
+            const Vector2 localPoint2D(localPoint.x_, localPoint.z_);
+            const IntVector2 from = VectorMax(IntVector2::ZERO, VectorFloorToInt((localPoint2D - Vector2::ONE * streamingRadius_) /
+                tileEdgeLength));
+            const IntVector2 to = VectorMin(GetNumTiles() - IntVector2::ONE, VectorFloorToInt((localPoint2D + Vector2::ONE *
+                streamingRadius_) / tileEdgeLength));
+
+            for (int z = from.y_; z <= to.y_; ++z)
+            {
+                for (int x = from.x_; x <= to.x_; ++x)
+                {
+                    const IntVector2 tile(x, z);
+                    if (streamedTiles_.Contains(tile) || requested.Contains(tile) || HasTile(tile))
+                        continue;
+
+                    const float distance = GetStreamingDistance(tile, points);
+                    // When the budget is used up, a tile can only replace farther ones
+                    if (distance > streamingRadius_ || (budgetFull && distance >= maxResidentDistance))
+                        continue;
+
+                    requested.Insert(tile);
+                    candidates.Push(StreamedTileDistance{tile, distance});
+                }
+            }
+        }
+
+        Sort(candidates.Begin(), candidates.End(), CompareTileDistances);
+
+        auto* queue = GetSubsystem<WorkQueue>();
+        auto* cache = GetSubsystem<ResourceCache>();
+        for (unsigned i = 0; i < candidates.Size() && tileLoads_.Size() < MAX_TILE_LOADS; ++i)
+        {
+            SharedPtr<TileLoad> load(new TileLoad());
+            load->tile_ = candidates[i].tile_;
+            load->name_ = GetStreamedTileName(load->tile_);
+            load->cache_ = cache;
+
+            // Not pooled, as the load may take longer than a frame
+            SharedPtr<WorkItem> item(new WorkItem());
+            item->workFunction_ = LoadTileWork;
+            item->aux_ = load.Get();
+            item->priority_ = 0;
+            load->item_ = item;
+            tileLoads_.Push(load);
+
+            if (queue)
+                queue->AddWorkItem(item);
+            else
+            {
+                LoadTileWork(item, 0);
+                item->completed_ = true;
+            }
+        }
+    }
+
+    UpdatePostUpdateSubscription();
+}
+
+void NavigationMesh::AddStreamedTile(const IntVector2& tile, const PODVector<unsigned char>& tileData, const PODVector<Vector3>& points)
+{
+    // The tile may have been built in the meantime
+    if (HasTile(tile))
+        return;
+
+    unsigned size = tileData.Size();
+    if (streamingMemoryBudget_ && size && streamingMemoryUse_ + size > streamingMemoryBudget_)
+    {
+        // Make room by unloading the tiles farther from the streaming points, farthest first. Skip the tile if there is not enough
+        const float distance = GetStreamingDistance(tile, points);
+        PODVector<StreamedTileDistance> farther;
+        unsigned fartherSize = 0;
+        for (HashMap<IntVector2, unsigned>::ConstIterator i = streamedTiles_.Begin(); i != streamedTiles_.End(); ++i)
+        {
+            const float tileDistance = GetStreamingDistance(i->first_, points);
+            if (i->second_ && tileDistance > distance)
+            {
+                farther.Push(StreamedTileDistance{i->first_, tileDistance});
+                fartherSize += i->second_;
+            }
+        }
+
+        if (streamingMemoryUse_ - fartherSize + size > streamingMemoryBudget_)
+            return;
+
+        Sort(farther.Begin(), farther.End(), CompareTileDistances);
+        unsigned i = farther.Size();
+        while (i > 0 && streamingMemoryUse_ + size > streamingMemoryBudget_)
+            UnloadStreamedTile(farther[--i].tile_);
+    }
+
+    // A tile that fails to load is kept as empty, so that it is not requested again while within the radius
+    if (size && !AddTile(tileData))
+        size = 0;
+
+    streamedTiles_[tile] = size;
+    streamingMemoryUse_ += size;
+}
+
+void NavigationMesh::UnloadStreamedTile(const IntVector2& tile)
+{
+    HashMap<IntVector2, unsigned>::Iterator i = streamedTiles_.Find(tile);
+    if (i == streamedTiles_.End())
+        return;
+
+    if (i->second_)
+    {
+        RemoveTile(tile);
+        streamingMemoryUse_ -= i->second_;
+    }
+
+    streamedTiles_.Erase(i);
+}
+
+void NavigationMesh::CancelTileLoads()
+{
+    if (tileLoads_.Empty())
+        return;
+
+    // The loads already running must finish before their data can be freed
+    auto* queue = GetSubsystem<WorkQueue>();
+    for (const SharedPtr<TileLoad>& load : tileLoads_)
+    {
+        if (queue && !queue->RemoveWorkItem(load->item_))
+            queue->Wait(load->item_);
+    }
+
+    tileLoads_.Clear();
+    UpdatePostUpdateSubscription();
+}
+
+float NavigationMesh::GetStreamingDistance(const IntVector2& tile, const PODVector<Vector3>& points) const
+{
+    const BoundingBox box = GetTileBoundingBox(tile);
+    float minDistance = M_INFINITY;
+
+    for (unsigned i = 0; i < points.Size(); ++i)
+    {
+        const Vector3& point = points[i];
+        const float dx = Max(Max(box.min_.x_ - point.x_, point.x_ - box.max_.x_), 0.0f);
+        const float dz = Max(Max(box.min_.z_ - point.z_, point.z_ - box.max_.z_), 0.0f);
+        minDistance = Min(minDistance, Vector2(dx, dz).Length());
+    }
+
+    return minDistance;
+}
+
+void NavigationMesh::LoadTileWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* load = static_cast<TileLoad*>(item->aux_);
+    if (!load->cache_)
+        return;
+
+    // A missing file means that the tile is empty
+    SharedPtr<File> file = load->cache_->GetFile(load->name_, false);
+    if (!file)
+        return;
+
+    load->data_.Resize(file->GetSize());
+    if (file->Read(load->data_.Buffer(), load->data_.Size()) != load->data_.Size())
+    {
+        URHO3D_LOGERROR("Could not read navigation mesh tile " + load->name_);
+        load->data_.Clear();
+    }
+}
+
 void RegisterNavigationLibrary(Context* context)
 {
     Navigable::RegisterObject(context);
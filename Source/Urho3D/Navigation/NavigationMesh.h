@@ -39,6 +39,7 @@ using dtPolyRef = unsigned int;
 class dtNavMesh;
 class dtNavMeshQuery;
 class dtQueryFilter;
+struct rcConfig;
 
 namespace Urho3D
 {
@@ -51,9 +52,12 @@ enum NavmeshPartitionType
 
 class Geometry;
 class NavArea;
+class ResourceCache;
 
 struct FindPathData;
+struct NavigationPathGraph;
 struct NavBuildData;
+struct WorkItem;
 
 /// Description of a navigation mesh geometry component, with transform and bounds information.
 struct NavigationGeometryInfo
@@ -88,6 +92,28 @@ struct URHO3D_API NavigationPathPoint
     unsigned char areaID_;
 };
 
+/// Asynchronous path request. The path is filled in by the navigation mesh when the request completes.
+/// @nobind
+struct URHO3D_API NavigationPathRequest : public RefCounted
+{
+    /// World-space start point.
+    Vector3 start_;
+    /// World-space end point.
+    Vector3 end_;
+    /// How far off the navigation mesh the points can be.
+    Vector3 extents_;
+    /// Query filter, or null to use the navigation mesh's own. Must stay valid until the request completes.
+    const dtQueryFilter* filter_{};
+    /// Whether to search the path in slices within the per-frame iteration budget, for long paths.
+    bool sliced_{};
+    /// Found path points. Empty if no path was found.
+    PODVector<NavigationPathPoint> path_;
+    /// Whether the request has completed.
+    bool completed_{};
+    /// Whether the sliced path search has been started.
+    bool started_{};
+};
+
 /// Navigation mesh component. Collects the navigation geometry from child nodes with the Navigable component and responds to path queries.
 class URHO3D_API NavigationMesh : public Component
 {
@@ -159,6 +185,14 @@ public:
     virtual bool Build(const BoundingBox& boundingBox);
     /// Rebuild part of the navigation mesh in the rectangular area. Return true if successful.
     virtual bool Build(const IntVector2& from, const IntVector2& to);
+    /// Rebuild part of the navigation mesh contained by the world-space bounding box in the work queue worker threads. The input geometry is copied immediately, after which the scene can be modified freely. The built tiles replace the old ones over the following frames within the time budget, and E_NAVIGATION_ASYNC_REBUILT is sent when all of them have been added. Return true if the rebuild was started.
+    bool BuildAsync(const BoundingBox& boundingBox);
+    /// Rebuild part of the navigation mesh in the rectangular area in the work queue worker threads. Return true if the rebuild was started.
+    bool BuildAsync(const IntVector2& from, const IntVector2& to);
+    /// Wait for the asynchronous rebuild to finish and add all its remaining tiles to the navigation mesh.
+    void CompleteAsyncBuild();
+    /// Cancel the asynchronous rebuild. The tiles already added to the navigation mesh are kept.
+    void CancelAsyncBuild();
     /// Return tile data.
     virtual PODVector<unsigned char> GetTileData(const IntVector2& tile) const;
     /// Add tile to navigation mesh.
@@ -186,6 +220,55 @@ public:
     void FindPath
         (PODVector<NavigationPathPoint>& dest, const Vector3& start, const Vector3& end, const Vector3& extents = Vector3::ONE,
             const dtQueryFilter* filter = nullptr);
+    /// Find the coarse waypoints of a path on the hierarchical path graph: the start point, the tile entrances to pass through and the end point. The detailed path to the next waypoint can be found as the agent progresses. Return the start and end points only if they are in the same or neighbouring tiles, or an empty list if no path was found.
+    void FindPathWaypoints(PODVector<Vector3>& dest, const Vector3& start, const Vector3& end, const Vector3& extents = Vector3::ONE,
+        const dtQueryFilter* filter = nullptr);
+    /// Set whether FindPath plans the paths longer than the hierarchical path distance on the hierarchical path graph and refines them between the waypoints.
+    /// @property
+    void SetHierarchicalPathfinding(bool enable);
+    /// Return whether FindPath uses the hierarchical path graph for long paths.
+    /// @property
+    bool GetHierarchicalPathfinding() const { return hierarchicalPathfinding_; }
+    /// Set the straight line distance above which FindPath uses the hierarchical path graph.
+    /// @property
+    void SetHierarchicalPathDistance(float distance);
+    /// Return the straight line distance above which FindPath uses the hierarchical path graph.
+    /// @property
+    float GetHierarchicalPathDistance() const { return hierarchicalPathDistance_; }
+    /// Discard the cached hierarchical path graph. Changed tiles are detected and their part of the graph rebuilt automatically.
+    void ClearPathGraph();
+    /// Queue a path request between world space points. The paths are found during the scene post-update, with the queued requests spread over the worker threads, and NavigationPathFound is sent for each completed request. Sliced requests are advanced over several frames within the iteration budget instead.
+    /// @nobind
+    SharedPtr<NavigationPathRequest> FindPathAsync
+        (const Vector3& start, const Vector3& end, const Vector3& extents = Vector3::ONE, const dtQueryFilter* filter = nullptr,
+            bool sliced = false);
+    /// Complete all queued path requests immediately.
+    void CompletePathRequests();
+    /// Cancel all queued path requests. They are marked completed without a path and no events are sent.
+    void CancelPathRequests();
+    /// Set the number of sliced path search iterations per frame.
+    /// @property
+    void SetPathIterationBudget(unsigned iterations);
+    /// Return the number of sliced path search iterations per frame.
+    /// @property
+    unsigned GetPathIterationBudget() const { return pathIterationBudget_; }
+    /// Return number of queued path requests.
+    /// @property
+    unsigned GetNumPendingPathRequests() const { return pathRequests_.Size() + slicedPathRequests_.Size(); }
+    /// Discard the cached triangles of a navigation geometry component, or of all components if null. Changes of the transforms, models and collision shapes are detected automatically, but geometry modified in place is not.
+    void ClearGeometryCache(Component* component = nullptr);
+    /// Add a node around which the streamed tiles are kept loaded.
+    void AddStreamingPoint(Node* node);
+    /// Remove a streaming point node.
+    void RemoveStreamingPoint(Node* node);
+    /// Remove all streaming point nodes. The streamed tiles are unloaded on the next update.
+    void RemoveAllStreamingPoints();
+    /// Unload all streamed tiles and cancel the tile loads in progress.
+    void UnloadStreamedTiles();
+    /// Save the tiles to separate files in a directory, to be streamed from the tile stream path. Return true if successful.
+    bool SaveStreamedTiles(const String& directory) const;
+    /// Return the resource name of the file a tile is streamed from.
+    String GetStreamedTileName(const IntVector2& tile) const;
     /// Return a random point on the navigation mesh.
     Vector3 GetRandomPoint(const dtQueryFilter* filter = nullptr, dtPolyRef* randomRef = nullptr);
     /// Return a random point on the navigation mesh within a circle. The circle radius is only a guideline and in practice the returned point may be further away.
@@ -272,6 +355,66 @@ public:
     /// @property
     bool IsInitialized() const { return navMesh_ != nullptr; }
 
+    /// Set the time budget in milliseconds per frame for adding asynchronously built tiles to the navigation mesh. At least one tile is added each frame.
+    /// @property
+    void SetAsyncBuildTimeBudget(float ms);
+
+    /// Return the time budget in milliseconds per frame for adding asynchronously built tiles.
+    /// @property
+    float GetAsyncBuildTimeBudget() const { return asyncBuildTimeBudget_; }
+
+    /// Return whether an asynchronous rebuild is in progress.
+    /// @property
+    bool IsBuildingAsync() const { return !tileBuilds_.Empty(); }
+
+    /// Return number of tiles not yet added by the asynchronous rebuild.
+    /// @property
+    unsigned GetNumPendingTiles() const { return tileBuilds_.Size(); }
+
+    /// Set whether the tiles are streamed from separate files around the streaming points. When enabled the navigation data attribute holds only the navigation mesh parameters and not the tiles.
+    /// @property
+    void SetTileStreaming(bool enable);
+
+    /// Return whether the tiles are streamed.
+    /// @property
+    bool GetTileStreaming() const { return tileStreaming_; }
+
+    /// Set the resource directory the streamed tiles are loaded from.
+    /// @property
+    void SetTileStreamPath(const String& path);
+
+    /// Return the resource directory the streamed tiles are loaded from.
+    /// @property
+    const String& GetTileStreamPath() const { return tileStreamPath_; }
+
+    /// Set the distance from the streaming points within which the tiles are loaded.
+    /// @property
+    void SetStreamingRadius(float radius);
+
+    /// Return the distance from the streaming points within which the tiles are loaded.
+    /// @property
+    float GetStreamingRadius() const { return streamingRadius_; }
+
+    /// Set the maximum size in bytes of the resident streamed tile data, or 0 for no limit. The tiles farthest from the streaming points are unloaded first.
+    /// @property
+    void SetStreamingMemoryBudget(unsigned bytes);
+
+    /// Return the maximum size in bytes of the resident streamed tile data.
+    /// @property
+    unsigned GetStreamingMemoryBudget() const { return streamingMemoryBudget_; }
+
+    /// Return the size in bytes of the resident streamed tile data.
+    /// @property
+    unsigned GetStreamingMemoryUse() const { return streamingMemoryUse_; }
+
+    /// Return number of resident streamed tiles.
+    /// @property
+    unsigned GetNumStreamedTiles() const { return streamedTiles_.Size(); }
+
+    /// Return number of tile loads in progress.
+    /// @property
+    unsigned GetNumPendingTileLoads() const { return tileLoads_.Size(); }
+
     /// Return local space bounding box of the navigation mesh.
     /// @property
     const BoundingBox& GetBoundingBox() const { return boundingBox_; }
@@ -318,20 +461,124 @@ private:
     void WriteTile(Serializer& dest, int x, int z) const;
     /// Read tile data to the navigation mesh.
     bool ReadTile(Deserializer& source, bool silent);
+    /// Add the asynchronously built tiles that have finished, while within the time budget.
+    void UpdateAsyncBuild(bool complete);
+    /// Work function to build one tile.
+    static void BuildTileWork(const WorkItem* item, unsigned threadIndex);
+    /// Find the paths of the queued requests and advance the sliced requests within the iteration budget.
+    void UpdatePathRequests(bool complete);
+    /// Ensure that the per-thread and sliced path queries are initialized. Return true if successful.
+    bool InitializePathQueries();
+    /// Subscribe to the scene post-update while there are asynchronous tile builds or path requests, and unsubscribe otherwise.
+    void UpdatePostUpdateSubscription();
+    /// Work function to find the paths of a range of path requests.
+    static void FindPathWork(const WorkItem* item, unsigned threadIndex);
+    /// Add the loaded streamed tiles, unload the tiles outside the streaming radius and start loading the missing ones.
+    void UpdateTileStreaming();
+    /// Add a loaded streamed tile if it is still wanted and fits in the memory budget.
+    void AddStreamedTile(const IntVector2& tile, const PODVector<unsigned char>& tileData, const PODVector<Vector3>& points);
+    /// Unload a streamed tile.
+    void UnloadStreamedTile(const IntVector2& tile);
+    /// Cancel the tile loads in progress.
+    void CancelTileLoads();
+    /// Return the distance in the node space from a tile to the nearest streaming point.
+    float GetStreamingDistance(const IntVector2& tile, const PODVector<Vector3>& points) const;
+    /// Work function to read the file of a streamed tile.
+    static void LoadTileWork(const WorkItem* item, unsigned threadIndex);
 
 protected:
+    /// Tile rebuild holding a copy of the settings and the input geometry, so that the Recast build can run in a worker thread.
+    struct TileBuild : public RefCounted
+    {
+        /// Construct.
+        TileBuild(const IntVector2& tile, NavBuildData* build);
+        /// Destruct. Free the tile data that was not added to the navigation mesh.
+        ~TileBuild() override;
+
+        /// Tile index.
+        IntVector2 tile_;
+        /// Tile bounding box in the navigation mesh node space.
+        BoundingBox boundingBox_;
+        /// Recast configuration.
+        UniquePtr<rcConfig> config_;
+        /// Navigation agent height.
+        float agentHeight_;
+        /// Navigation agent radius.
+        float agentRadius_;
+        /// Navigation agent max vertical climb.
+        float agentMaxClimb_;
+        /// Type of the heightfield partitioning.
+        NavmeshPartitionType partitionType_;
+        /// Build data with the copied input geometry.
+        UniquePtr<NavBuildData> build_;
+        /// Built Detour tile data, or the tile cache layers of a DynamicNavigationMesh. Allocated with dtAlloc.
+        PODVector<Pair<unsigned char*, int> > tileData_;
+        /// Work item running the build.
+        SharedPtr<WorkItem> item_;
+    };
+
+    /// Streamed tile file being read in a worker thread.
+    struct TileLoad : public RefCounted
+    {
+        /// Tile index.
+        IntVector2 tile_;
+        /// Resource name of the tile file.
+        String name_;
+        /// Resource cache to read the file from.
+        ResourceCache* cache_{};
+        /// Read tile data. Empty if the tile has no file.
+        PODVector<unsigned char> data_;
+        /// Work item reading the file.
+        SharedPtr<WorkItem> item_;
+    };
+
+    /// Triangles of a navigation geometry component, extracted in the navigation mesh node space and reused by the tile builds until the component changes.
+    struct GeometryCacheEntry
+    {
+        /// Component the triangles were extracted from.
+        WeakPtr<Component> component_;
+        /// Transform relative to the navigation mesh node when extracted.
+        Matrix3x4 transform_;
+        /// Bounding box relative to the navigation mesh node when extracted.
+        BoundingBox boundingBox_;
+        /// Resources and geometries the triangles were extracted from.
+        PODVector<const void*> sources_;
+        /// Vertices.
+        PODVector<Vector3> vertices_;
+        /// Triangle indices.
+        PODVector<int> indices_;
+    };
+
+    /// Handle scene post-update event to add the asynchronously built tiles and process the path requests.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
     /// Collect geometry from under Navigable components.
     void CollectGeometries(Vector<NavigationGeometryInfo>& geometryList);
     /// Visit nodes and collect navigable geometry.
     void CollectGeometries(Vector<NavigationGeometryInfo>& geometryList, Node* node, HashSet<Node*>& processedNodes, bool recursive);
     /// Get geometry data within a bounding box.
     void GetTileGeometry(NavBuildData* build, Vector<NavigationGeometryInfo>& geometryList, BoundingBox& box);
+    /// Add the cached triangles of a navigation geometry component to the geometry data, extracting them first if the component has changed.
+    void AddCachedGeometry(NavBuildData* build, const NavigationGeometryInfo& info);
     /// Add a triangle mesh to the geometry data.
     void AddTriMeshGeometry(NavBuildData* build, Geometry* geometry, const Matrix3x4& transform);
     /// Build one tile of the navigation mesh. Return true if successful.
     virtual bool BuildTile(Vector<NavigationGeometryInfo>& geometryList, int x, int z);
     /// Build tiles in the rectangular area. Return number of built tiles.
     unsigned BuildTiles(Vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to);
+    /// Create the build data for one tile.
+    virtual NavBuildData* CreateTileBuildData();
+    /// Copy the settings and the input geometry for building one tile.
+    SharedPtr<TileBuild> PrepareTileBuild(Vector<NavigationGeometryInfo>& geometryList, int x, int z);
+    /// Run the Recast build of one tile. Accesses only the tile build, so can be called from a worker thread. Return true if successful.
+    virtual bool BuildTileData(TileBuild& tileBuild) const;
+    /// Replace the tile in the navigation mesh with the built tile data. Return number of tiles added.
+    virtual unsigned AddTileData(TileBuild& tileBuild);
+    /// Find the node space waypoints of a path on the hierarchical path graph. Return true if the path passes through tile entrances.
+    bool FindLocalWaypoints(PODVector<Vector3>& dest, const Vector3& localStart, const Vector3& localEnd, const Vector3& extents,
+        const dtQueryFilter* filter);
+
     /// Ensure that the navigation mesh query is initialized. Return true if successful.
     bool InitializeQuery();
     /// Release the navigation mesh and the query.
@@ -347,6 +594,8 @@ protected:
     UniquePtr<dtQueryFilter> queryFilter_;
     /// Temporary data for finding a path.
     UniquePtr<FindPathData> pathData_;
+    /// Hierarchical path graph over the tiles, built as the path searches reach them.
+    UniquePtr<NavigationPathGraph> pathGraph_;
     /// Tile size.
     int tileSize_;
     /// Cell size.
@@ -391,6 +640,50 @@ protected:
     bool drawNavAreas_;
     /// NavAreas for this NavMesh.
     Vector<WeakPtr<NavArea> > areas_;
+    /// Cached triangles of the navigation geometry components.
+    HashMap<Component*, GeometryCacheEntry> geometryCache_;
+    /// Asynchronous tile rebuilds, in the order they are added to the navigation mesh.
+    Vector<SharedPtr<TileBuild> > tileBuilds_;
+    /// Number of tiles added by the current asynchronous rebuild.
+    unsigned numAsyncTiles_;
+    /// Time budget in milliseconds per frame for adding asynchronously built tiles.
+    float asyncBuildTimeBudget_;
+    /// Detour navigation mesh queries for the path requests, indexed by the work queue thread index.
+    PODVector<dtNavMeshQuery*> threadQueries_;
+    /// Temporary data for finding paths, indexed by the work queue thread index.
+    Vector<UniquePtr<FindPathData> > threadPathData_;
+    /// Detour navigation mesh query for the sliced path searches, which keeps its state between frames.
+    dtNavMeshQuery* slicedQuery_;
+    /// Start point of the sliced path search in progress, in the node space.
+    Vector3 slicedStart_;
+    /// End point of the sliced path search in progress, in the node space.
+    Vector3 slicedEnd_;
+    /// Queued path requests.
+    Vector<SharedPtr<NavigationPathRequest> > pathRequests_;
+    /// Queued sliced path requests. The first one is in progress.
+    Vector<SharedPtr<NavigationPathRequest> > slicedPathRequests_;
+    /// Sliced path search iterations per frame.
+    unsigned pathIterationBudget_;
+    /// Whether FindPath uses the hierarchical path graph for long paths.
+    bool hierarchicalPathfinding_;
+    /// Straight line distance above which FindPath uses the hierarchical path graph.
+    float hierarchicalPathDistance_;
+    /// Whether the tiles are streamed.
+    bool tileStreaming_;
+    /// Resource directory the streamed tiles are loaded from.
+    String tileStreamPath_;
+    /// Distance from the streaming points within which the tiles are loaded.
+    float streamingRadius_;
+    /// Maximum size in bytes of the resident streamed tile data, 0 for no limit.
+    unsigned streamingMemoryBudget_;
+    /// Size in bytes of the resident streamed tile data.
+    unsigned streamingMemoryUse_;
+    /// Nodes around which the streamed tiles are kept loaded.
+    Vector<WeakPtr<Node> > streamingPoints_;
+    /// Resident streamed tiles and their data sizes. Tiles without a file are included with zero size, so that they are not requested again.
+    HashMap<IntVector2, unsigned> streamedTiles_;
+    /// Streamed tile loads in progress, in the order they were started.
+    Vector<SharedPtr<TileLoad> > tileLoads_;
 };
 
 /// Register Navigation library objects.
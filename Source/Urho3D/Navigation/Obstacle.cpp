@@ -47,7 +47,8 @@ Obstacle::Obstacle(Context* context) :
 
 Obstacle::~Obstacle()
 {
-    if (obstacleId_ > 0 && ownerMesh_)
+    // Also called when not yet added, to cancel a pending add
+    if (ownerMesh_)
         ownerMesh_->RemoveObstacle(this);
 }
 
@@ -111,7 +112,7 @@ void Obstacle::OnSceneSet(Scene* scene)
     }
     else
     {
-        if (obstacleId_ > 0 && ownerMesh_)
+        if (ownerMesh_)
             ownerMesh_->RemoveObstacle(this);
 
         UnsubscribeFromEvent(E_NAVIGATION_TILE_ADDED);
@@ -22,7 +22,12 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/Sort.h"
+#include "../Core/Metrics.h"
+#include "../Core/Mutex.h"
 #include "../Core/Profiler.h"
+#include "../IO/BufferWriter.h"
+#include "../IO/Compression.h"
 #include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
@@ -54,8 +59,35 @@ namespace Urho3D
 {
 
 static const int STATS_INTERVAL_MSEC = 2000;
+/// Number of quantized node latest data updates kept by the client as baselines. Larger than on the server, as the updates may arrive out of order.
+static const unsigned CLIENT_LATESTDATA_HISTORY = LATESTDATA_HISTORY * 2;
+/// Estimated bytes used by the SLikeNet datagram and message headers, subtracted from the path MTU for the packed message size.
+static const int PACKED_MESSAGE_OVERHEAD = 64;
+/// Smallest packed message size derived from the path MTU.
+static const int MIN_PACKED_MESSAGE_LIMIT = 256;
+/// Bytes charged from the bandwidth budget per message in addition to its data.
+static const int MESSAGE_BUDGET_OVERHEAD = 8;
+/// Number of update allowances the bandwidth budget may accumulate, to absorb bursts.
+static const int MAX_BANDWIDTH_BURST = 2;
+/// Congestion scale multiplier applied on each update while SLikeNet reports congestion.
+static const float CONGESTION_BACKOFF = 0.8f;
+/// Congestion scale increase on each update without congestion.
+static const float CONGESTION_RECOVERY = 0.02f;
+/// Lowest congestion scale.
+static const float MIN_CONGESTION_SCALE = 0.1f;
+/// Multiplier of the interest radius beyond which nodes the client already has are removed from it.
+static const float INTEREST_HYSTERESIS = 1.1f;
+
+/// File name suffix of partially downloaded package files.
+static const char* PARTIAL_PACKAGE_SUFFIX = ".part";
+/// File name suffix of the received fragment bitmaps of partially downloaded package files.
+static const char* FRAGMENT_BITMAP_SUFFIX = ".bitmap";
+
+/// Mutex for the replication state lists of nodes and components, which are shared by all connections, and for the weak references of the states to them.
+static Mutex replicationMutex;
 
 PackageDownload::PackageDownload() :
+    numReceivedFragments_(0),
     totalFragments_(0),
     checksum_(0),
     initiated_(false)
@@ -64,7 +96,8 @@ PackageDownload::PackageDownload() :
 
 PackageUpload::PackageUpload() :
     fragment_(0),
-    totalFragments_(0)
+    totalFragments_(0),
+    compress_(true)
 {
 }
 
@@ -73,16 +106,30 @@ Connection::Connection(Context* context, bool isClient, const SLNet::AddressOrGU
     timeStamp_(0),
     peer_(peer),
     sendMode_(OPSM_NONE),
+    serverTick_(0),
+    serverTickBase_(0),
+    hasServerTick_(false),
+    serverUpdateInterval_(0.0f),
+    interestRadius_(0.0f),
+    bandwidthLimit_(0),
+    bandwidthBudget_(0),
+    congestionScale_(1.0f),
     isClient_(isClient),
     connectPending_(false),
     sceneLoaded_(false),
     logStatistics_(false),
     address_(nullptr),
-    packedMessageLimit_(1024)
+    packedMessageLimit_(1024),
+    autoPacketSizeLimit_(true),
+    deferSend_(false)
 {
     sceneState_.connection_ = this;
     port_ = address.systemAddress.GetPort();
     SetAddressOrGUID(address);
+
+    auto* metrics = GetSubsystem<Metrics>();
+    if (metrics)
+        bytesSentMetric_ = metrics->GetCounter("Network", "sent_bytes_total", "Bytes sent in network packets.");
 }
 
 Connection::~Connection()
@@ -128,15 +175,20 @@ void Connection::SendMessage(int msgID, bool reliable, bool inOrder, const unsig
     if (buffer.GetSize() + numBytes >= packedMessageLimit_)
         SendBuffer(type);
 
-    if (buffer.GetSize() == 0)
+    // Append through a non-virtual writer, reserving a full packet when starting a new one
+    bool newPacket = buffer.GetSize() == 0;
+    BufferWriter writer(buffer, newPacket ? Max((unsigned)packedMessageLimit_, numBytes + 13) : numBytes + 8);
+    if (newPacket)
     {
-        buffer.WriteUByte((unsigned char)DefaultMessageIDTypes::ID_USER_PACKET_ENUM);
-        buffer.WriteUInt((unsigned int)MSG_PACKED_MESSAGE);
+        writer.WriteUByte((unsigned char)DefaultMessageIDTypes::ID_USER_PACKET_ENUM);
+        writer.WriteUInt((unsigned int)MSG_PACKED_MESSAGE);
     }
 
-    buffer.WriteUInt((unsigned int) msgID);
-    buffer.WriteUInt(numBytes);
-    buffer.Write(data, numBytes);
+    writer.WriteUInt((unsigned int) msgID);
+    writer.WriteUInt(numBytes);
+    writer.Write(data, numBytes);
+
+    bandwidthBudget_ -= (int)numBytes + MESSAGE_BUDGET_OVERHEAD;
 }
 
 void Connection::SendRemoteEvent(StringHash eventType, bool inOrder, const VariantMap& eventData)
@@ -199,6 +251,7 @@ void Connection::SetScene(Scene* newScene)
         unsigned numPackages = packages.Size();
         msg_.Clear();
         msg_.WriteString(scene_->GetFileName());
+        msg_.WriteVLE((unsigned)GetSubsystem<Network>()->GetUpdateFps());
         msg_.WriteVLE(numPackages);
         for (unsigned i = 0; i < numPackages; ++i)
         {
@@ -241,6 +294,44 @@ void Connection::SetRotation(const Quaternion& rotation)
         sendMode_ = OPSM_POSITION_ROTATION;
 }
 
+void Connection::SetInterestRadius(float radius)
+{
+    interestRadius_ = Max(radius, 0.0f);
+}
+
+void Connection::SetBandwidthLimit(unsigned bytesPerSec)
+{
+    bandwidthLimit_ = bytesPerSec;
+    bandwidthBudget_ = 0;
+    congestionScale_ = 1.0f;
+}
+
+void Connection::UpdateBandwidth()
+{
+    if (autoPacketSizeLimit_)
+    {
+        int mtu = peer_->GetMTUSize(address_->systemAddress);
+        packedMessageLimit_ = Max(mtu - PACKED_MESSAGE_OVERHEAD, MIN_PACKED_MESSAGE_LIMIT);
+    }
+
+    if (!bandwidthLimit_)
+        return;
+
+    // Back off while SLikeNet is limited by congestion control or has to resend, and recover slowly otherwise
+    SLNet::RakNetStatistics stats{};
+    if (peer_->GetStatistics(address_->systemAddress, &stats))
+    {
+        if (stats.isLimitedByCongestionControl || stats.packetlossLastSecond > 0.0f)
+            congestionScale_ = Max(congestionScale_ * CONGESTION_BACKOFF, MIN_CONGESTION_SCALE);
+        else
+            congestionScale_ = Min(congestionScale_ + CONGESTION_RECOVERY, 1.0f);
+    }
+
+    int updateFps = Max(GetSubsystem<Network>()->GetUpdateFps(), 1);
+    auto allowance = (int)(bandwidthLimit_ * congestionScale_ / updateFps);
+    bandwidthBudget_ = Min(bandwidthBudget_ + allowance, allowance * MAX_BANDWIDTH_BURST);
+}
+
 void Connection::SetConnectPending(bool connectPending)
 {
     connectPending_ = connectPending;
@@ -261,16 +352,75 @@ void Connection::SendServerUpdate()
     if (!scene_ || !sceneLoaded_)
         return;
 
+    serverTick_ = (int)GetSubsystem<Network>()->GetUpdateTick();
+
     // Always check the root node (scene) first so that the scene-wide components get sent first,
     // and all other replicated nodes get added to the dirty set for sending the initial state
     unsigned sceneID = scene_->GetID();
     nodesToProcess_.Insert(sceneID);
     ProcessNode(sceneID);
 
-    // Then go through all dirtied nodes
-    nodesToProcess_.Insert(sceneState_.dirtyNodes_);
+    if (interestRadius_ > 0.0f && scene_->GetInterestCellSize() > 0.0f)
+    {
+        ProcessInterest();
+
+        // Then go through the dirtied nodes the client has or that are in the area of interest. Other new nodes are sent once
+        // they enter it, so they need not stay dirty
+        for (HashSet<unsigned>::Iterator i = sceneState_.dirtyNodes_.Begin(); i != sceneState_.dirtyNodes_.End();)
+        {
+            unsigned nodeID = *i;
+            if (!interestNodes_.Contains(nodeID) && !sceneState_.nodeStates_.Contains(nodeID))
+            {
+                Node* node = scene_->GetNode(nodeID);
+                if (!node || node->GetOwner() != this)
+                {
+                    i = sceneState_.dirtyNodes_.Erase(i);
+                    continue;
+                }
+            }
+
+            nodesToProcess_.Insert(nodeID);
+            ++i;
+        }
+    }
+    else
+    {
+        // Then go through all dirtied nodes
+        nodesToProcess_.Insert(sceneState_.dirtyNodes_);
+    }
     nodesToProcess_.Erase(sceneID); // Do not process the root node twice
 
+    if (bandwidthLimit_)
+    {
+        // Send the nodes in priority order, so that the budget runs out on the least important ones: creations and removals
+        // first, as they are never deferred, then owned nodes, then by distance to the observer, shortened for each time the
+        // node has already been deferred so that far away nodes are not starved
+        prioritizedNodes_.Clear();
+        for (HashSet<unsigned>::ConstIterator i = nodesToProcess_.Begin(); i != nodesToProcess_.End(); ++i)
+        {
+            unsigned nodeID = *i;
+            float key = -1.0f;
+            HashMap<unsigned, NodeReplicationState>::ConstIterator j = sceneState_.nodeStates_.Find(nodeID);
+            if (j != sceneState_.nodeStates_.End() && j->second_.node_)
+            {
+                Node* node = j->second_.node_;
+                if (node->GetOwner() == this)
+                    key = 0.0f;
+                else
+                    key = (node->GetWorldPosition() - position_).Length() / (1.0f + j->second_.deferredUpdates_);
+            }
+            prioritizedNodes_.Push(MakePair(key, nodeID));
+        }
+        Sort(prioritizedNodes_.Begin(), prioritizedNodes_.End());
+
+        // Nodes may already have been processed as dependencies or parents of earlier ones
+        for (PODVector<Pair<float, unsigned> >::ConstIterator i = prioritizedNodes_.Begin(); i != prioritizedNodes_.End(); ++i)
+        {
+            if (nodesToProcess_.Contains(i->second_))
+                ProcessNode(i->second_);
+        }
+    }
+
     while (nodesToProcess_.Size())
     {
         unsigned nodeID = nodesToProcess_.Front();
@@ -295,6 +445,20 @@ void Connection::SendClientUpdate()
         msg_.WritePackedQuaternion(rotation_);
     SendMessage(MSG_CONTROLS, false, false, msg_, CONTROLS_CONTENT_ID);
 
+    // Acknowledge the quantized latest data received since the last update, so that the server can send the changes to them
+    if (!latestDataAcks_.Empty())
+    {
+        msg_.Clear();
+        msg_.WriteVLE(latestDataAcks_.Size());
+        for (HashMap<unsigned, unsigned char>::ConstIterator i = latestDataAcks_.Begin(); i != latestDataAcks_.End(); ++i)
+        {
+            msg_.WriteNetID(i->first_);
+            msg_.WriteUByte(i->second_);
+        }
+        SendMessage(MSG_LATESTDATAACK, false, false, msg_);
+        latestDataAcks_.Clear();
+    }
+
     ++timeStamp_;
 }
 
@@ -353,11 +517,24 @@ void Connection::SendPackages()
     while (!uploads_.Empty())
     {
         unsigned char buffer[PACKAGE_FRAGMENT_SIZE];
+        unsigned char compressBuffer[PACKAGE_FRAGMENT_COMPRESS_BOUND];
 
         for (HashMap<StringHash, PackageUpload>::Iterator i = uploads_.Begin(); i != uploads_.End();)
         {
             HashMap<StringHash, PackageUpload>::Iterator current = i++;
             PackageUpload& upload = current->second_;
+
+            // Skip the fragments the client already has
+            while (upload.fragment_ < upload.totalFragments_ && (upload.fragment_ >> 3u) < upload.skipFragments_.Size() &&
+                   (upload.skipFragments_[upload.fragment_ >> 3u] & (1u << (upload.fragment_ & 7u))))
+                ++upload.fragment_;
+            if (upload.fragment_ >= upload.totalFragments_)
+            {
+                uploads_.Erase(current);
+                continue;
+            }
+
+            upload.file_->Seek(upload.fragment_ * PACKAGE_FRAGMENT_SIZE);
             auto fragmentSize =
                 (unsigned)Min((int)(upload.file_->GetSize() - upload.file_->GetPosition()), (int)PACKAGE_FRAGMENT_SIZE);
             upload.file_->Read(buffer, fragmentSize);
@@ -365,7 +542,13 @@ void Connection::SendPackages()
             msg_.Clear();
             msg_.WriteStringHash(current->first_);
             msg_.WriteUInt(upload.fragment_++);
-            msg_.Write(buffer, fragmentSize);
+            msg_.WriteVLE(fragmentSize);
+            // Send the fragment compressed only if it gets smaller, which the client detects from the data size
+            unsigned compressedSize = upload.compress_ ? CompressData(compressBuffer, buffer, fragmentSize) : 0;
+            if (compressedSize && compressedSize < fragmentSize)
+                msg_.Write(compressBuffer, compressedSize);
+            else
+                msg_.Write(buffer, fragmentSize);
             SendMessage(MSG_PACKAGEDATA, true, false, msg_);
 
             // Check if upload finished
@@ -381,6 +564,41 @@ void Connection::SendBuffer(PacketType type)
     if (buffer.GetSize() == 0)
         return;
 
+    if (deferSend_)
+    {
+        deferredPackets_.Resize(deferredPackets_.Size() + 1);
+        deferredPackets_.Back().first_ = type;
+        deferredPackets_.Back().second_.Resize(buffer.GetSize());
+        memcpy(deferredPackets_.Back().second_.Buffer(), buffer.GetData(), buffer.GetSize());
+    }
+    else
+        SendPacket(type, buffer.GetData(), buffer.GetSize());
+
+    buffer.Clear();
+}
+
+void Connection::SendAllBuffers()
+{
+    SendBuffer(PT_RELIABLE_ORDERED);
+    SendBuffer(PT_RELIABLE_UNORDERED);
+    SendBuffer(PT_UNRELIABLE_ORDERED);
+    SendBuffer(PT_UNRELIABLE_UNORDERED);
+}
+
+void Connection::SetDeferSend(bool enable)
+{
+    deferSend_ = enable;
+    if (deferSend_)
+        return;
+
+    // Send the queued packets first, as the messages still in the outgoing buffers were written after them
+    for (Vector<Pair<PacketType, PODVector<unsigned char> > >::ConstIterator i = deferredPackets_.Begin(); i != deferredPackets_.End(); ++i)
+        SendPacket(i->first_, i->second_.Buffer(), i->second_.Size());
+    deferredPackets_.Clear();
+}
+
+void Connection::SendPacket(PacketType type, const unsigned char* data, unsigned numBytes)
+{
     PacketReliability reliability = PacketReliability::UNRELIABLE;
     if (type == PT_UNRELIABLE_ORDERED)
         reliability = PacketReliability::UNRELIABLE_SEQUENCED;
@@ -392,20 +610,11 @@ void Connection::SendBuffer(PacketType type)
         reliability = PacketReliability::RELIABLE;
 
     if (peer_) {
-        peer_->Send((const char *) buffer.GetData(), (int) buffer.GetSize(), HIGH_PRIORITY, reliability, (char) 0,
-                    *address_, false);
+        peer_->Send((const char *) data, (int) numBytes, HIGH_PRIORITY, reliability, (char) 0, *address_, false);
         tempPacketCounter_.y_++;
+        if (bytesSentMetric_)
+            bytesSentMetric_->Increment(numBytes);
     }
-
-    buffer.Clear();
-}
-
-void Connection::SendAllBuffers()
-{
-    SendBuffer(PT_RELIABLE_ORDERED);
-    SendBuffer(PT_RELIABLE_UNORDERED);
-    SendBuffer(PT_UNRELIABLE_ORDERED);
-    SendBuffer(PT_UNRELIABLE_UNORDERED);
 }
 
 void Connection::ProcessPendingLatestData()
@@ -422,7 +631,7 @@ void Connection::ProcessPendingLatestData()
         {
             MemoryBuffer msg(current->second_);
             msg.ReadNetID(); // Skip the node ID
-            node->ReadLatestDataUpdate(msg);
+            ReadNodeLatestData(node, msg);
             // ApplyAttributes() is deliberately skipped, as Node has no attributes that require late applying.
             // Furthermore it would propagate to components and child nodes, which is not desired in this case
             nodeLatestData_.Erase(current);
@@ -477,6 +686,10 @@ bool Connection::ProcessMessage(int msgID, MemoryBuffer& buffer)
                 ProcessSceneLoaded(msgID, msg);
                 break;
 
+            case MSG_LATESTDATAACK:
+                ProcessLatestDataAck(msgID, msg);
+                break;
+
             case MSG_REQUESTPACKAGE:
             case MSG_PACKAGEDATA:
                 ProcessPackageDownload(msgID, msg);
@@ -541,10 +754,14 @@ void Connection::ProcessLoadScene(int msgID, MemoryBuffer& msg)
 
     // Store the scene file name we need to eventually load
     sceneFileName_ = msg.ReadString();
+    serverUpdateInterval_ = 1.0f / (float)Max(msg.ReadVLE(), 1U);
+    hasServerTick_ = false;
 
     // Clear previous pending latest data and package downloads if any
     nodeLatestData_.Clear();
     componentLatestData_.Clear();
+    nodeLatestDataHistory_.Clear();
+    latestDataAcks_.Clear();
     downloads_.Clear();
 
     // In case we have joined other scenes in this session, remove first all downloaded package files from the resource system
@@ -688,7 +905,7 @@ void Connection::ProcessSceneUpdate(int msgID, MemoryBuffer& msg)
             Node* node = scene_->GetNode(nodeID);
             if (node)
             {
-                node->ReadLatestDataUpdate(msg);
+                ReadNodeLatestData(node, msg);
                 // ApplyAttributes() is deliberately skipped, as Node has no attributes that require late applying.
                 // Furthermore it would propagate to components and child nodes, which is not desired in this case
             }
@@ -709,6 +926,8 @@ void Connection::ProcessSceneUpdate(int msgID, MemoryBuffer& msg)
             if (node)
                 node->Remove();
             nodeLatestData_.Erase(nodeID);
+            nodeLatestDataHistory_.Erase(nodeID);
+            latestDataAcks_.Erase(nodeID);
         }
         break;
 
@@ -841,9 +1060,24 @@ void Connection::ProcessPackageDownload(int msgID, MemoryBuffer& msg)
 
                     URHO3D_LOGINFO("Transmitting package file " + name + " to client " + ToString());
 
-                    uploads_[nameHash].file_ = file;
-                    uploads_[nameHash].fragment_ = 0;
-                    uploads_[nameHash].totalFragments_ = (file->GetSize() + PACKAGE_FRAGMENT_SIZE - 1) / PACKAGE_FRAGMENT_SIZE;
+                    PackageUpload& upload = uploads_[nameHash];
+                    upload.file_ = file;
+                    upload.fragment_ = 0;
+                    upload.totalFragments_ = (file->GetSize() + PACKAGE_FRAGMENT_SIZE - 1) / PACKAGE_FRAGMENT_SIZE;
+                    // The fragments of compressed packages would not get smaller
+                    upload.compress_ = !package->IsCompressed();
+
+                    // Resume an interrupted download
+                    if (!msg.IsEof())
+                    {
+                        unsigned bitmapSize = msg.ReadVLE();
+                        if (bitmapSize <= msg.GetSize() - msg.GetPosition())
+                        {
+                            upload.skipFragments_.Resize(bitmapSize);
+                            if (bitmapSize)
+                                msg.Read(&upload.skipFragments_[0], bitmapSize);
+                        }
+                    }
                     return;
                 }
             }
@@ -880,52 +1114,96 @@ void Connection::ProcessPackageDownload(int msgID, MemoryBuffer& msg)
                 return;
             }
 
-            // If file has not yet been opened, try to open now. Prepend the checksum to the filename to allow multiple versions
+            // Prepend the checksum to the filename to allow multiple versions. Until complete, the download is written to a
+            // partial file, along with the bitmap of the received fragments
+            auto* fileSystem = GetSubsystem<FileSystem>();
+            String fileName = GetSubsystem<Network>()->GetPackageCacheDir() + ToStringHex(download.checksum_) + "_" + download.name_;
+            String partialName = fileName + PARTIAL_PACKAGE_SUFFIX;
+            String bitmapName = partialName + FRAGMENT_BITMAP_SUFFIX;
+
+            // If file has not yet been opened, try to open now
             if (!download.file_)
             {
-                download.file_ = new File(context_,
-                    GetSubsystem<Network>()->GetPackageCacheDir() + ToStringHex(download.checksum_) + "_" + download.name_,
-                    FILE_WRITE);
-                if (!download.file_->IsOpen())
+                download.file_ = new File(context_, partialName, FILE_READWRITE);
+                download.bitmapFile_ = new File(context_, bitmapName, FILE_READWRITE);
+                if (!download.file_->IsOpen() || !download.bitmapFile_->IsOpen())
                 {
                     OnPackageDownloadFailed(download.name_);
                     return;
                 }
+                download.bitmapFile_->Write(download.receivedFragments_.Buffer(), download.receivedFragments_.Size());
             }
 
-            // Write the fragment data to the proper index
-            unsigned char buffer[PACKAGE_FRAGMENT_SIZE];
             unsigned index = msg.ReadUInt();
-            unsigned fragmentSize = msg.GetSize() - msg.GetPosition();
+            unsigned fragmentSize = msg.ReadVLE();
+            unsigned dataSize = msg.GetSize() - msg.GetPosition();
+            if (index >= download.totalFragments_ || fragmentSize > PACKAGE_FRAGMENT_SIZE || dataSize > fragmentSize)
+            {
+                URHO3D_LOGERROR("Received invalid fragment of package " + download.name_);
+                OnPackageDownloadFailed(download.name_);
+                return;
+            }
+
+            unsigned char& bitmapByte = download.receivedFragments_[index >> 3u];
+            auto bit = (unsigned char)(1u << (index & 7u));
+            if (bitmapByte & bit)
+                return;
+
+            // Decompress the fragment if it is smaller than the original
+            unsigned char buffer[PACKAGE_FRAGMENT_SIZE];
+            if (dataSize < fragmentSize)
+            {
+                if (DecompressData(buffer, msg.GetData() + msg.GetPosition(), fragmentSize) != dataSize)
+                {
+                    URHO3D_LOGERROR("Failed to decompress fragment of package " + download.name_);
+                    OnPackageDownloadFailed(download.name_);
+                    return;
+                }
+            }
+            else
+                msg.Read(buffer, fragmentSize);
 
-            msg.Read(buffer, fragmentSize);
+            // Write the fragment data to the proper index, then mark it received
             download.file_->Seek(index * PACKAGE_FRAGMENT_SIZE);
             download.file_->Write(buffer, fragmentSize);
-            download.receivedFragments_.Insert(index);
+            bitmapByte |= bit;
+            download.bitmapFile_->Seek(index >> 3u);
+            download.bitmapFile_->WriteUByte(bitmapByte);
+            ++download.numReceivedFragments_;
 
             // Check if all fragments received
-            if (download.receivedFragments_.Size() == download.totalFragments_)
+            if (download.numReceivedFragments_ == download.totalFragments_)
             {
+                download.file_->Close();
+                download.bitmapFile_->Close();
+                fileSystem->Delete(bitmapName);
+                if (fileSystem->FileExists(fileName))
+                    fileSystem->Delete(fileName);
+                if (!fileSystem->Rename(partialName, fileName))
+                {
+                    OnPackageDownloadFailed(download.name_);
+                    return;
+                }
+
+                SharedPtr<PackageFile> package(new PackageFile(context_, fileName));
+                if (package->GetChecksum() != download.checksum_)
+                {
+                    fileSystem->Delete(fileName);
+                    OnPackageDownloadFailed(download.name_);
+                    return;
+                }
+
                 URHO3D_LOGINFO("Package " + download.name_ + " downloaded successfully");
 
-                // Instantiate the package and add to the resource system, as we will need it to load the scene
-                download.file_->Close();
-                GetSubsystem<ResourceCache>()->AddPackageFile(download.file_->GetName(), 0);
+                // Add the package to the resource system, as we will need it to load the scene
+                GetSubsystem<ResourceCache>()->AddPackageFile(package, 0);
 
                 // Then start the next download if there are more
                 downloads_.Erase(i);
                 if (downloads_.Empty())
                     OnPackagesReady();
                 else
-                {
-                    PackageDownload& nextDownload = downloads_.Begin()->second_;
-
-                    URHO3D_LOGINFO("Requesting package " + nextDownload.name_ + " from server");
-                    msg_.Clear();
-                    msg_.WriteString(nextDownload.name_);
-                    SendMessage(MSG_REQUESTPACKAGE, true, true, msg_);
-                    nextDownload.initiated_ = true;
-                }
+                    SendPackageRequest(downloads_.Begin()->second_);
             }
         }
         break;
@@ -980,6 +1258,123 @@ void Connection::ProcessControls(int msgID, MemoryBuffer& msg)
         rotation_ = msg.ReadPackedQuaternion();
 }
 
+void Connection::ProcessLatestDataAck(int msgID, MemoryBuffer& msg)
+{
+    if (!IsClient())
+    {
+        URHO3D_LOGWARNING("Received unexpected LatestDataAck message from server");
+        return;
+    }
+
+    unsigned numAcks = msg.ReadVLE();
+    while (numAcks-- && !msg.IsEof())
+    {
+        unsigned nodeID = msg.ReadNetID();
+        unsigned char sequence = msg.ReadUByte();
+
+        HashMap<unsigned, NodeReplicationState>::Iterator i = sceneState_.nodeStates_.Find(nodeID);
+        if (i == sceneState_.nodeStates_.End())
+            continue;
+
+        // Only accept the updates still in the history, and ignore acknowledgements arriving out of order
+        NodeReplicationState& nodeState = i->second_;
+        auto age = (unsigned char)(nodeState.latestDataSequence_ - sequence);
+        if (age && age < LATESTDATA_HISTORY && (nodeState.ackedLatestData_ < 0 ||
+            (signed char)(sequence - (unsigned char)nodeState.ackedLatestData_) > 0))
+            nodeState.ackedLatestData_ = sequence;
+    }
+}
+
+void Connection::WriteNodeLatestData(Node* node, NodeReplicationState& nodeState)
+{
+    msg_.WriteUShort((unsigned short)serverTick_);
+
+    if (!node->HasQuantizedLatestData())
+    {
+        node->WriteLatestDataUpdate(msg_, timeStamp_);
+        return;
+    }
+
+    if (nodeState.latestDataHistory_.Size() != LATESTDATA_HISTORY)
+        nodeState.latestDataHistory_.Resize(LATESTDATA_HISTORY);
+
+    unsigned char sequence = nodeState.latestDataSequence_++;
+    unsigned char baselineSequence = sequence;
+    const PODVector<unsigned>* baseline = nullptr;
+
+    // Write the changes to the newest acknowledged update while it is in the history, otherwise the full values
+    if (nodeState.ackedLatestData_ >= 0)
+    {
+        auto age = (unsigned char)(sequence - (unsigned char)nodeState.ackedLatestData_);
+        if (age && age < LATESTDATA_HISTORY)
+        {
+            baselineSequence = (unsigned char)nodeState.ackedLatestData_;
+            baseline = &nodeState.latestDataHistory_[baselineSequence % LATESTDATA_HISTORY];
+        }
+        else
+            nodeState.ackedLatestData_ = -1;
+    }
+
+    msg_.WriteUByte(sequence);
+    msg_.WriteUByte(baselineSequence);
+    node->WriteQuantizedLatestDataUpdate(msg_, timeStamp_, baseline, nodeState.latestDataHistory_[sequence % LATESTDATA_HISTORY]);
+}
+
+void Connection::ReadNodeLatestData(Node* node, Deserializer& source)
+{
+    // Unwrap the 16-bit server tick relative to the newest one, tolerating updates that arrive out of order
+    auto tick = source.ReadUShort();
+    if (!hasServerTick_)
+    {
+        serverTickBase_ = tick;
+        serverTick_ = 0;
+        hasServerTick_ = true;
+    }
+    int tickNumber = serverTick_ + (short)(unsigned short)(tick - (unsigned short)(serverTickBase_ + serverTick_));
+    serverTick_ = Max(serverTick_, tickNumber);
+
+    // Let the smoothed transforms buffer the update at its server time for interpolation
+    scene_->SetSnapshotTime((float)tickNumber * serverUpdateInterval_, serverUpdateInterval_);
+
+    if (!node->HasQuantizedLatestData())
+    {
+        node->ReadLatestDataUpdate(source);
+        return;
+    }
+
+    unsigned char sequence = source.ReadUByte();
+    unsigned char baselineSequence = source.ReadUByte();
+
+    QuantizedLatestData& history = nodeLatestDataHistory_[node->GetID()];
+    if (history.values_.Size() != CLIENT_LATESTDATA_HISTORY)
+    {
+        history.values_.Resize(CLIENT_LATESTDATA_HISTORY);
+        history.sequences_.Resize(CLIENT_LATESTDATA_HISTORY);
+        for (unsigned i = 0; i < CLIENT_LATESTDATA_HISTORY; ++i)
+            history.sequences_[i] = -1;
+    }
+
+    const PODVector<unsigned>* baseline = nullptr;
+    unsigned baselineIndex = baselineSequence % CLIENT_LATESTDATA_HISTORY;
+    if (history.sequences_[baselineIndex] == baselineSequence)
+        baseline = &history.values_[baselineIndex];
+
+    PODVector<unsigned> values;
+    if (!node->ReadQuantizedLatestDataUpdate(source, baseline, values))
+    {
+        URHO3D_LOGWARNING("Discarding latest data for node " + String(node->GetID()) + " without its baseline");
+        return;
+    }
+
+    unsigned index = sequence % CLIENT_LATESTDATA_HISTORY;
+    history.values_[index].Swap(values);
+    history.sequences_[index] = sequence;
+
+    HashMap<unsigned, unsigned char>::Iterator i = latestDataAcks_.Find(node->GetID());
+    if (i == latestDataAcks_.End() || (signed char)(sequence - i->second_) > 0)
+        latestDataAcks_[node->GetID()] = sequence;
+}
+
 void Connection::ProcessSceneLoaded(int msgID, MemoryBuffer& msg)
 {
     if (!IsClient())
@@ -1143,7 +1538,7 @@ float Connection::GetDownloadProgress() const
     for (HashMap<StringHash, PackageDownload>::ConstIterator i = downloads_.Begin(); i != downloads_.End(); ++i)
     {
         if (i->second_.initiated_)
-            return (float)i->second_.receivedFragments_.Size() / (float)i->second_.totalFragments_;
+            return (float)i->second_.numReceivedFragments_ / (float)i->second_.totalFragments_;
     }
     return 1.0f;
 }
@@ -1181,7 +1576,9 @@ void Connection::ConfigureNetworkSimulator(int latencyMs, float packetLoss)
 
 void Connection::SetPacketSizeLimit(int limit)
 {
-    packedMessageLimit_ = limit;
+    autoPacketSizeLimit_ = limit <= 0;
+    if (!autoPacketSizeLimit_)
+        packedMessageLimit_ = limit;
 }
 
 void Connection::HandleAsyncLoadFinished(StringHash eventType, VariantMap& eventData)
@@ -1196,6 +1593,70 @@ void Connection::HandleAsyncLoadFinished(StringHash eventType, VariantMap& event
     SendMessage(MSG_SCENELOADED, true, true, msg_);
 }
 
+void Connection::ProcessInterest()
+{
+    URHO3D_PROFILE(ProcessInterest);
+
+    // Nodes the client already has are kept until they are further away than the hysteresis distance, so that nodes moving
+    // at the edge of the area are not repeatedly removed and recreated
+    interestNodes_.Clear();
+    scene_->GetInterestNodes(interestQuery_, position_, interestRadius_ * INTEREST_HYSTERESIS);
+    float radiusSquared = interestRadius_ * interestRadius_;
+    for (PODVector<Node*>::ConstIterator i = interestQuery_.Begin(); i != interestQuery_.End(); ++i)
+    {
+        Node* node = *i;
+        if (!sceneState_.nodeStates_.Contains(node->GetID()) && (node->GetWorldPosition() - position_).LengthSquared() > radiusSquared)
+            continue;
+        AddInterestNode(node);
+    }
+
+    // Remove the nodes that have left the area of interest from the client. Nodes owned by this connection are always kept
+    for (HashMap<unsigned, NodeReplicationState>::Iterator i = sceneState_.nodeStates_.Begin(); i != sceneState_.nodeStates_.End();)
+    {
+        Node* node = i->second_.node_;
+        if (!node || node == scene_ || node->GetOwner() == this || interestNodes_.Contains(i->first_))
+        {
+            ++i;
+            continue;
+        }
+
+        msg_.Clear();
+        msg_.WriteNetID(i->first_);
+        SendMessage(MSG_REMOVENODE, true, true, msg_);
+
+        sceneState_.dirtyNodes_.Erase(i->first_);
+
+        // Stop tracking the node and its components. The owner is not this connection, so it is not reset
+        MutexLock lock(replicationMutex);
+        node->CleanupConnection(this);
+        const Vector<SharedPtr<Component> >& components = node->GetComponents();
+        for (Vector<SharedPtr<Component> >::ConstIterator j = components.Begin(); j != components.End(); ++j)
+            (*j)->CleanupConnection(this);
+        i = sceneState_.nodeStates_.Erase(i);
+    }
+
+    // Mark the nodes entering the area of interest dirty to send their initial state
+    for (HashSet<unsigned>::ConstIterator i = interestNodes_.Begin(); i != interestNodes_.End(); ++i)
+    {
+        if (!sceneState_.nodeStates_.Contains(*i))
+            sceneState_.dirtyNodes_.Insert(*i);
+    }
+}
+
+void Connection::AddInterestNode(Node* node)
+{
+    if (!node || node == scene_ || !node->IsReplicated() || interestNodes_.Contains(node->GetID()))
+        return;
+
+    interestNodes_.Insert(node->GetID());
+
+    // The parent and other depended upon nodes need to exist on the client as well
+    AddInterestNode(node->GetParent());
+    const PODVector<Node*>& dependencyNodes = node->GetDependencyNodes();
+    for (PODVector<Node*>::ConstIterator i = dependencyNodes.Begin(); i != dependencyNodes.End(); ++i)
+        AddInterestNode(*i);
+}
+
 void Connection::ProcessNode(unsigned nodeID)
 {
     // Check that we have not already processed this due to dependency recursion
@@ -1217,6 +1678,8 @@ void Connection::ProcessNode(unsigned nodeID)
             // would be enough. However, this may be better due to the client not possibly having updated parenting
             // information at the time of receiving this message
             SendMessage(MSG_REMOVENODE, true, true, msg_);
+
+            MutexLock lock(replicationMutex);
             sceneState_.nodeStates_.Erase(nodeID);
         }
         else
@@ -1251,10 +1714,13 @@ void Connection::ProcessNewNode(Node* node)
     msg_.WriteNetID(node->GetID());
 
     NodeReplicationState& nodeState = sceneState_.nodeStates_[node->GetID()];
-    nodeState.connection_ = this;
-    nodeState.sceneState_ = &sceneState_;
-    nodeState.node_ = node;
-    node->AddReplicationState(&nodeState);
+    {
+        MutexLock lock(replicationMutex);
+        nodeState.connection_ = this;
+        nodeState.sceneState_ = &sceneState_;
+        nodeState.node_ = node;
+        node->AddReplicationState(&nodeState);
+    }
 
     // Write node's attributes
     node->WriteInitialDeltaUpdate(msg_, timeStamp_);
@@ -1279,10 +1745,13 @@ void Connection::ProcessNewNode(Node* node)
             continue;
 
         ComponentReplicationState& componentState = nodeState.componentStates_[component->GetID()];
-        componentState.connection_ = this;
-        componentState.nodeState_ = &nodeState;
-        componentState.component_ = component;
-        component->AddReplicationState(&componentState);
+        {
+            MutexLock lock(replicationMutex);
+            componentState.connection_ = this;
+            componentState.nodeState_ = &nodeState;
+            componentState.component_ = component;
+            component->AddReplicationState(&componentState);
+        }
 
         msg_.WriteStringHash(component->GetType());
         msg_.WriteNetID(component->GetID());
@@ -1306,6 +1775,14 @@ void Connection::ProcessExistingNode(Node* node, NodeReplicationState& nodeState
             ProcessNode(nodeID);
     }
 
+    // Defer the update when the bandwidth budget is used up. The node stays dirty and is checked again on the next update
+    if (bandwidthLimit_ && bandwidthBudget_ <= 0 && node->GetOwner() != this)
+    {
+        ++nodeState.deferredUpdates_;
+        return;
+    }
+    nodeState.deferredUpdates_ = 0;
+
     // Check from the interest management component, if exists, whether should update
     /// \todo Searching for the component is a potential CPU hotspot. It should be cached
     auto* priority = node->GetComponent<NetworkPriority>();
@@ -1337,7 +1814,7 @@ void Connection::ProcessExistingNode(Node* node, NodeReplicationState& nodeState
         {
             msg_.Clear();
             msg_.WriteNetID(node->GetID());
-            node->WriteLatestDataUpdate(msg_, timeStamp_);
+            WriteNodeLatestData(node, nodeState);
 
             SendMessage(MSG_NODELATESTDATA, true, false, msg_, node->GetID());
         }
@@ -1390,6 +1867,8 @@ void Connection::ProcessExistingNode(Node* node, NodeReplicationState& nodeState
             msg_.WriteNetID(current->first_);
 
             SendMessage(MSG_REMOVECOMPONENT, true, true, msg_);
+
+            MutexLock lock(replicationMutex);
             nodeState.componentStates_.Erase(current);
         }
         else
@@ -1451,10 +1930,13 @@ void Connection::ProcessExistingNode(Node* node, NodeReplicationState& nodeState
             {
                 // New component
                 ComponentReplicationState& componentState = nodeState.componentStates_[component->GetID()];
-                componentState.connection_ = this;
-                componentState.nodeState_ = &nodeState;
-                componentState.component_ = component;
-                component->AddReplicationState(&componentState);
+                {
+                    MutexLock lock(replicationMutex);
+                    componentState.connection_ = this;
+                    componentState.nodeState_ = &nodeState;
+                    componentState.component_ = component;
+                    component->AddReplicationState(&componentState);
+                }
 
                 msg_.Clear();
                 msg_.WriteNetID(node->GetID());
@@ -1552,16 +2034,59 @@ void Connection::RequestPackage(const String& name, unsigned fileSize, unsigned
     download.name_ = name;
     download.totalFragments_ = (fileSize + PACKAGE_FRAGMENT_SIZE - 1) / PACKAGE_FRAGMENT_SIZE;
     download.checksum_ = checksum;
+    download.receivedFragments_.Resize((download.totalFragments_ + 7) >> 3u);
+    for (unsigned i = 0; i < download.receivedFragments_.Size(); ++i)
+        download.receivedFragments_[i] = 0;
+
+    // Resume an interrupted download of the same package version from its bitmap of received fragments
+    String partialName = GetSubsystem<Network>()->GetPackageCacheDir() + ToStringHex(checksum) + "_" + name + PARTIAL_PACKAGE_SUFFIX;
+    String bitmapName = partialName + FRAGMENT_BITMAP_SUFFIX;
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    if (download.totalFragments_ && fileSystem->FileExists(partialName) && fileSystem->FileExists(bitmapName))
+    {
+        File bitmapFile(context_, bitmapName);
+        if (bitmapFile.GetSize() == download.receivedFragments_.Size() &&
+            bitmapFile.Read(&download.receivedFragments_[0], download.receivedFragments_.Size()) == bitmapFile.GetSize())
+        {
+            for (unsigned i = 0; i < download.totalFragments_; ++i)
+            {
+                if (download.receivedFragments_[i >> 3u] & (1u << (i & 7u)))
+                    ++download.numReceivedFragments_;
+            }
+        }
+
+        // All fragments received, but the download was not finished: start over to be sure
+        if (download.numReceivedFragments_ == download.totalFragments_)
+        {
+            for (unsigned i = 0; i < download.receivedFragments_.Size(); ++i)
+                download.receivedFragments_[i] = 0;
+            download.numReceivedFragments_ = 0;
+        }
+    }
 
     // Start download now only if no existing downloads, else wait for the existing ones to finish
     if (downloads_.Size() == 1)
+        SendPackageRequest(download);
+}
+
+void Connection::SendPackageRequest(PackageDownload& download)
+{
+    msg_.Clear();
+    msg_.WriteString(download.name_);
+    if (download.numReceivedFragments_)
     {
-        URHO3D_LOGINFO("Requesting package " + name + " from server");
-        msg_.Clear();
-        msg_.WriteString(name);
-        SendMessage(MSG_REQUESTPACKAGE, true, true, msg_);
-        download.initiated_ = true;
+        URHO3D_LOGINFO("Resuming download of package " + download.name_ + " from server, " +
+            String(download.numReceivedFragments_) + " of " + String(download.totalFragments_) + " fragments received");
+        msg_.WriteVLE(download.receivedFragments_.Size());
+        msg_.Write(&download.receivedFragments_[0], download.receivedFragments_.Size());
+    }
+    else
+    {
+        URHO3D_LOGINFO("Requesting package " + download.name_ + " from server");
+        msg_.WriteVLE(0);
     }
+    SendMessage(MSG_REQUESTPACKAGE, true, true, msg_);
+    download.initiated_ = true;
 }
 
 void Connection::SendPackageError(const String& name)
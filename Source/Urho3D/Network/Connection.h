@@ -46,6 +46,7 @@ namespace Urho3D
 
 class File;
 class MemoryBuffer;
+class Metric;
 class Node;
 class Scene;
 class Serializable;
@@ -72,8 +73,12 @@ struct PackageDownload
 
     /// Destination file.
     SharedPtr<File> file_;
-    /// Already received fragments.
-    HashSet<unsigned> receivedFragments_;
+    /// Received fragments bitmap file, which allows resuming an interrupted download.
+    SharedPtr<File> bitmapFile_;
+    /// Bitmap of the already received fragments.
+    PODVector<unsigned char> receivedFragments_;
+    /// Number of already received fragments.
+    unsigned numReceivedFragments_;
     /// Package name.
     String name_;
     /// Total number of fragments.
@@ -96,6 +101,10 @@ struct PackageUpload
     unsigned fragment_;
     /// Total number of fragments.
     unsigned totalFragments_;
+    /// Bitmap of the fragments the client already has from an interrupted download, which are skipped.
+    PODVector<unsigned char> skipFragments_;
+    /// Compress the fragments flag. False if the package is compressed already.
+    bool compress_;
 };
 
 /// Send modes for observer position/rotation. Activated by the client setting either position or rotation.
@@ -148,6 +157,9 @@ public:
     /// Set the observer rotation for interest management, to be sent to the server. Note: not used by the NetworkPriority component.
     /// @property
     void SetRotation(const Quaternion& rotation);
+    /// Set the radius of the area of interest around the observer position. Only the replicated nodes within it are created and updated on the client, and nodes leaving it are removed from the client. Requires the scene's interest grid to be enabled. 0 replicates all nodes (default). To be called on the server.
+    /// @property
+    void SetInterestRadius(float radius);
     /// Set the connection pending status. Called by Network.
     void SetConnectPending(bool connectPending);
     /// Set whether to log data in/out statistics.
@@ -167,6 +179,8 @@ public:
     void SendBuffer(PacketType type);
     /// Send out all buffered messages
     void SendAllBuffers();
+    /// Set whether to queue full outgoing packets instead of handing them to SLikeNet, so that the server update can be built in a worker thread. Disabling sends the queued packets. Called by Network.
+    void SetDeferSend(bool enable);
     /// Process pending latest data for nodes and components.
     void ProcessPendingLatestData();
     /// Process a message from the server or client. Called by Network.
@@ -198,6 +212,21 @@ public:
     /// @property
     const Quaternion& GetRotation() const { return rotation_; }
 
+    /// Return the radius of the area of interest, or 0 if all nodes are replicated.
+    /// @property
+    float GetInterestRadius() const { return interestRadius_; }
+
+    /// Return the replication bandwidth limit in bytes per second, or 0 if unlimited.
+    /// @property
+    unsigned GetBandwidthLimit() const { return bandwidthLimit_; }
+
+    /// Return the bandwidth budget left of the current server update in bytes.
+    int GetBandwidthBudget() const { return bandwidthBudget_; }
+
+    /// Return the congestion scale applied to the bandwidth limit, 1.0 when not congested.
+    /// @property
+    float GetCongestionScale() const { return congestionScale_; }
+
     /// Return whether is a client connection.
     /// @property
     bool IsClient() const { return isClient_; }
@@ -266,8 +295,13 @@ public:
 
     /// Set network simulation parameters. Called by Network.
     void ConfigureNetworkSimulator(int latencyMs, float packetLoss);
-    /// Buffered packet size limit, when reached, packet is sent out immediately
+    /// Buffered packet size limit, when reached, packet is sent out immediately. 0 derives the limit from the path MTU reported by SLikeNet (default).
     void SetPacketSizeLimit(int limit);
+    /// Set the replication bandwidth limit in bytes per second on the server. When the budget of a server update is used up, the updates of existing nodes are deferred to later updates, the nodes furthest from the observer first. 0 is unlimited (default).
+    /// @property
+    void SetBandwidthLimit(unsigned bytesPerSec);
+    /// Refill the bandwidth budget for the next update, backing off when SLikeNet reports congestion, and adapt the packed message size to the path MTU. Called by Network.
+    void UpdateBandwidth();
 
     /// Current controls.
     Controls controls_;
@@ -277,6 +311,15 @@ public:
     VariantMap identity_;
 
 private:
+    /// Quantized latest data updates received for a node, by the sequence number modulo the history size.
+    struct QuantizedLatestData
+    {
+        /// Quantized values.
+        Vector<PODVector<unsigned> > values_;
+        /// Sequence numbers of the values, or -1 for none.
+        PODVector<int> sequences_;
+    };
+
     /// Handle scene loaded event.
     void HandleAsyncLoadFinished(StringHash eventType, VariantMap& eventData);
     /// Process a LoadScene message from the server. Called by Network.
@@ -293,8 +336,20 @@ private:
     void ProcessControls(int msgID, MemoryBuffer& msg);
     /// Process a SceneLoaded message from the client. Called by Network.
     void ProcessSceneLoaded(int msgID, MemoryBuffer& msg);
+    /// Process a latest data acknowledgement message from the client. Called by Network.
+    void ProcessLatestDataAck(int msgID, MemoryBuffer& msg);
+    /// Write the latest data of a node to the message buffer, quantized against the newest update acknowledged by the client if possible.
+    void WriteNodeLatestData(Node* node, NodeReplicationState& nodeState);
+    /// Read and apply the latest data of a node, remembering the quantized values as baselines and queuing their acknowledgement.
+    void ReadNodeLatestData(Node* node, Deserializer& source);
     /// Process a remote event message from the client or server. Called by Network.
     void ProcessRemoteEvent(int msgID, MemoryBuffer& msg);
+    /// Find the nodes in the area of interest, remove the nodes that have left it from the client and mark the entering nodes dirty.
+    void ProcessInterest();
+    /// Add a node and the nodes it depends on to the area of interest.
+    void AddInterestNode(Node* node);
+    /// Hand an outgoing packet to SLikeNet.
+    void SendPacket(PacketType type, const unsigned char* data, unsigned numBytes);
     /// Process a node for sending a network update. Recurses to process depended on node(s) first.
     void ProcessNode(unsigned nodeID);
     /// Process a node that the client has not yet received.
@@ -309,6 +364,8 @@ private:
     bool RequestNeededPackages(unsigned numPackages, MemoryBuffer& msg);
     /// Initiate a package download.
     void RequestPackage(const String& name, unsigned fileSize, unsigned checksum);
+    /// Send the request message of a package download, including the fragments already received.
+    void SendPackageRequest(PackageDownload& download);
     /// Send an error reply for a package download.
     void SendPackageError(const String& name);
     /// Handle scene load failure on the server or client.
@@ -330,8 +387,18 @@ private:
     HashMap<unsigned, PODVector<unsigned char> > nodeLatestData_;
     /// Pending latest data for not yet received components.
     HashMap<unsigned, PODVector<unsigned char> > componentLatestData_;
+    /// Received quantized node latest data by node ID, kept as the baselines of the following updates.
+    HashMap<unsigned, QuantizedLatestData> nodeLatestDataHistory_;
+    /// Sequence numbers of the newest received quantized node latest data by node ID, to acknowledge on the next client update.
+    HashMap<unsigned, unsigned char> latestDataAcks_;
     /// Node ID's to process during a replication update.
     HashSet<unsigned> nodesToProcess_;
+    /// Node ID's to process sorted by send priority when the bandwidth is limited.
+    PODVector<Pair<float, unsigned> > prioritizedNodes_;
+    /// Node ID's in the area of interest during a replication update.
+    HashSet<unsigned> interestNodes_;
+    /// Reusable interest grid query result.
+    PODVector<Node*> interestQuery_;
     /// Reusable message buffer.
     VectorBuffer msg_;
     /// Queued remote events.
@@ -348,6 +415,22 @@ private:
     Quaternion rotation_;
     /// Send mode for the observer position & rotation.
     ObserverPositionSendMode sendMode_;
+    /// Server tick of the update being sent on the server, or the newest server tick received relative to the first on the client.
+    int serverTick_;
+    /// First server tick received on the client, before unwrapping.
+    unsigned short serverTickBase_;
+    /// Server tick received flag.
+    bool hasServerTick_;
+    /// Server network update interval in seconds, received when loading the scene.
+    float serverUpdateInterval_;
+    /// Radius of the area of interest, or 0 if all nodes are replicated.
+    float interestRadius_;
+    /// Replication bandwidth limit in bytes per second, or 0 if unlimited.
+    unsigned bandwidthLimit_;
+    /// Bandwidth budget left of the current server update in bytes.
+    int bandwidthBudget_;
+    /// Congestion scale applied to the bandwidth limit.
+    float congestionScale_;
     /// Client connection flag.
     bool isClient_;
     /// Connection pending flag.
@@ -372,6 +455,14 @@ private:
     HashMap<int, VectorBuffer> outgoingBuffer_;
     /// Outgoing packet size limit
     int packedMessageLimit_;
+    /// Derive the packet size limit from the path MTU flag.
+    bool autoPacketSizeLimit_;
+    /// Outgoing packets queued while sending is deferred, by packet type.
+    Vector<Pair<PacketType, PODVector<unsigned char> > > deferredPackets_;
+    /// Defer sending flag.
+    bool deferSend_;
+    /// Sent bytes metric.
+    SharedPtr<Metric> bytesSentMetric_;
 };
 
 }
@@ -35,8 +35,36 @@ namespace Urho3D
 
 static const unsigned ERROR_BUFFER_SIZE = 256;
 static const unsigned READ_BUFFER_SIZE = 65536; // Must be a power of two
+/// Time in milliseconds after which an idle kept-alive connection is closed. Servers commonly close them after 5 to 60 seconds.
+static const unsigned IDLE_CONNECTION_TIMEOUT = 5000;
 
-HttpRequest::HttpRequest(const String& url, const String& verb, const Vector<String>& headers, const String& postData) :
+/// HTTP request pool worker thread.
+class HttpWorkerThread : public Thread, public RefCounted
+{
+public:
+    /// Construct.
+    HttpWorkerThread(HttpRequestPool* owner, unsigned index) :
+        owner_(owner),
+        index_(index)
+    {
+    }
+
+    /// Process requests until the pool is shut down.
+    void ThreadFunction() override
+    {
+        URHO3D_PROFILE_THREAD("HttpRequest Thread");
+        owner_->ProcessRequests(index_);
+    }
+
+private:
+    /// Pool.
+    HttpRequestPool* owner_;
+    /// Thread index.
+    unsigned index_;
+};
+
+HttpRequest::HttpRequest(const String& url, const String& verb, const Vector<String>& headers, const String& postData,
+    HttpRequestPool* pool) :
     url_(url.Trimmed()),
     verb_(!verb.Empty() ? verb : "GET"),
     headers_(headers),
@@ -45,7 +73,8 @@ HttpRequest::HttpRequest(const String& url, const String& verb, const Vector<Str
     httpReadBuffer_(new unsigned char[READ_BUFFER_SIZE]),
     readBuffer_(new unsigned char[READ_BUFFER_SIZE]),
     readPosition_(0),
-    writePosition_(0)
+    writePosition_(0),
+    pool_(pool)
 {
     // Size of response is unknown, so just set maximum value. The position will also be changed
     // to maximum value once the request is done, signaling end for Deserializer::IsEof().
@@ -63,8 +92,17 @@ HttpRequest::HttpRequest(const String& url, const String& verb, const Vector<Str
 #endif
 
 #ifdef URHO3D_THREADING
-    // Start the worker thread to actually create the connection and read the response data.
-    Run();
+    if (pool)
+    {
+        // The pool's worker thread checks the run flag the same way as the request's own thread would
+        shouldRun_ = true;
+        pool->QueueRequest(this);
+    }
+    else
+    {
+        // Start the worker thread to actually create the connection and read the response data.
+        Run();
+    }
 #else
     URHO3D_LOGERROR("HTTP request will not execute as threading is disabled");
 #endif
@@ -72,13 +110,21 @@ HttpRequest::HttpRequest(const String& url, const String& verb, const Vector<Str
 
 HttpRequest::~HttpRequest()
 {
-    Stop();
+    if (pool_)
+        pool_->CancelRequest(this);
+    else
+        Stop();
 }
 
 void HttpRequest::ThreadFunction()
 {
     URHO3D_PROFILE_THREAD("HttpRequest Thread");
 
+    Process(nullptr);
+}
+
+void HttpRequest::Process(HttpRequestPool* pool)
+{
     String protocol = "http";
     String host;
     String path = "/";
@@ -108,6 +154,8 @@ void HttpRequest::ThreadFunction()
     } else if (protocol.Compare("https", false) >= 0)
         port = 443;
 
+    const int useSSL = protocol.Compare("https", false) >= 0 ? 1 : 0;
+
     char errorBuffer[ERROR_BUFFER_SIZE];
     memset(errorBuffer, 0, sizeof(errorBuffer));
 
@@ -119,27 +167,43 @@ void HttpRequest::ThreadFunction()
         if (header.Length())
             headersStr += header + "\r\n";
     }
+    if (!postData_.Empty())
+        headersStr += "Content-Length: " + String(postData_.Length()) + "\r\n";
+    // Only connections of the pool are kept alive for other requests
+    headersStr += pool ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
 
-    // Initiate the connection. This may block due to DNS query
-    mg_connection* connection = nullptr;
+    // A kept-alive connection may have been closed by the server while idle. In that case retry once on a new connection
+    const String connectionKey = protocol.ToLower() + "://" + host.ToLower() + ":" + String(port);
+    mg_connection* connection = pool ? pool->AcquireConnection(connectionKey) : nullptr;
+    bool reused = connection != nullptr;
 
-    if (postData_.Empty())
-    {
-        connection = mg_download(host.CString(), port, protocol.Compare("https", false) >= 0 ? 1 : 0, errorBuffer, sizeof(errorBuffer),
-            "%s %s HTTP/1.0\r\n"
-            "Host: %s\r\n"
-            "%s"
-            "\r\n", verb_.CString(), path.CString(), host.CString(), headersStr.CString());
-    }
-    else
+    for (;;)
     {
-        connection = mg_download(host.CString(), port, protocol.Compare("https", false) >= 0 ? 1 : 0, errorBuffer, sizeof(errorBuffer),
-            "%s %s HTTP/1.0\r\n"
+        // Initiate the connection. This may block due to DNS query
+        if (!connection)
+            connection = mg_connect_client(host.CString(), port, useSSL, errorBuffer, sizeof(errorBuffer));
+        if (!connection)
+            break;
+
+        bool sent = mg_printf(connection,
+            "%s %s HTTP/1.1\r\n"
             "Host: %s\r\n"
             "%s"
-            "Content-Length: %d\r\n"
-            "\r\n"
-            "%s", verb_.CString(), path.CString(), host.CString(), headersStr.CString(), postData_.Length(), postData_.CString());
+            "\r\n", verb_.CString(), path.CString(), host.CString(), headersStr.CString()) > 0;
+        if (sent && !postData_.Empty())
+            sent = mg_write(connection, postData_.CString(), postData_.Length()) == (int)postData_.Length();
+        if (sent && mg_get_response(connection, errorBuffer, sizeof(errorBuffer), -1) >= 0)
+            break;
+
+        if (!sent && !errorBuffer[0])
+            strcpy(errorBuffer, "Error sending request");
+        mg_close_connection(connection);
+        connection = nullptr;
+
+        if (!reused)
+            break;
+        reused = false;
+        memset(errorBuffer, 0, sizeof(errorBuffer));
     }
 
     {
@@ -154,13 +218,22 @@ void HttpRequest::ThreadFunction()
         }
     }
 
+    // Responses to HEAD requests and the no content statuses have no body even when they have a Content-Length
+    const mg_response_info* responseInfo = mg_get_response_info(connection);
+    const int statusCode = responseInfo ? responseInfo->status_code : 0;
+    const bool noBody = verb_.Compare("HEAD", false) == 0 || statusCode == 204 || statusCode == 304;
+    bool completed = noBody;
+
     // Loop while should run, read data from the connection, copy to the main thread buffer if there is space
-    while (shouldRun_)
+    while (shouldRun_ && !completed)
     {
         // Read less than full buffer to be able to distinguish between full and empty ring buffer. Reading may block
         int bytesRead = mg_read(connection, httpReadBuffer_.Get(), READ_BUFFER_SIZE / 4);
         if (bytesRead <= 0)
+        {
+            completed = bytesRead == 0;
             break;
+        }
 
         mutex_.Acquire();
 
@@ -199,8 +272,24 @@ void HttpRequest::ThreadFunction()
         mutex_.Release();
     }
 
-    // Close the connection
-    mg_close_connection(connection);
+    // The connection can be reused if the response was read to its end, the end was delimited by length or chunked
+    // encoding rather than by closing the connection, and the server did not ask to close it
+    bool keepAlive = pool && completed && responseInfo && responseInfo->http_version &&
+        !strcmp(responseInfo->http_version, "1.1");
+    if (keepAlive)
+    {
+        const char* connectionHeader = mg_get_header(connection, "Connection");
+        const char* transferEncoding = mg_get_header(connection, "Transfer-Encoding");
+        bool delimited = noBody || responseInfo->content_length >= 0 ||
+            (transferEncoding && String(transferEncoding).Compare("chunked", false) == 0);
+        keepAlive = delimited && !(connectionHeader && String(connectionHeader).Compare("close", false) == 0);
+    }
+
+    // Close the connection, or return it to the pool
+    if (keepAlive)
+        pool->ReleaseConnection(connectionKey, connection);
+    else
+        mg_close_connection(connection);
 
     {
         MutexLock lock(mutex_);
@@ -304,4 +393,196 @@ Pair<unsigned, bool> HttpRequest::CheckAvailableSizeAndEof() const
     return {size, (state_ == HTTP_ERROR || (state_ == HTTP_CLOSED && !size))};
 }
 
+HttpRequestPool::HttpRequestPool(unsigned maxConcurrentRequests) :
+    maxConcurrentRequests_(0),
+    shutDown_(false)
+{
+    SetMaxConcurrentRequests(maxConcurrentRequests);
+}
+
+HttpRequestPool::~HttpRequestPool()
+{
+    {
+        MutexLock lock(mutex_);
+        shutDown_ = true;
+
+        // Queued requests will never be processed
+        for (List<HttpRequest*>::Iterator i = queue_.Begin(); i != queue_.End(); ++i)
+        {
+            HttpRequest* request = *i;
+            MutexLock requestLock(request->mutex_);
+            request->state_ = HTTP_ERROR;
+            request->error_ = "HTTP request pool was destroyed";
+        }
+        queue_.Clear();
+
+        // Interrupt the requests being processed at the next read
+        for (unsigned i = 0; i < activeRequests_.Size(); ++i)
+            activeRequests_[i]->shouldRun_ = false;
+    }
+
+    for (unsigned i = 0; i < threads_.Size(); ++i)
+        threads_[i]->Stop();
+    threads_.Clear();
+
+    for (unsigned i = 0; i < idleConnections_.Size(); ++i)
+        mg_close_connection(idleConnections_[i].connection_);
+    idleConnections_.Clear();
+}
+
+void HttpRequestPool::SetMaxConcurrentRequests(unsigned num)
+{
+    num = Max(num, 1U);
+
+    {
+        MutexLock lock(mutex_);
+        maxConcurrentRequests_ = num;
+    }
+
+    // Each worker thread processes one request at a time
+    while (threads_.Size() < num)
+    {
+        SharedPtr<HttpWorkerThread> thread(new HttpWorkerThread(this, threads_.Size()));
+        if (!thread->Run())
+            break;
+        threads_.Push(thread);
+    }
+}
+
+void HttpRequestPool::QueueRequest(HttpRequest* request)
+{
+    if (!request)
+        return;
+
+    MutexLock lock(mutex_);
+    queue_.Push(request);
+}
+
+void HttpRequestPool::CancelRequest(HttpRequest* request)
+{
+    mutex_.Acquire();
+
+    List<HttpRequest*>::Iterator i = queue_.Find(request);
+    if (i != queue_.End())
+    {
+        queue_.Erase(i);
+        mutex_.Release();
+        return;
+    }
+
+    // The request's own thread would be joined here, so wait for the worker thread to finish with it likewise
+    request->shouldRun_ = false;
+    while (activeRequests_.Contains(request))
+    {
+        mutex_.Release();
+        Time::Sleep(1);
+        mutex_.Acquire();
+    }
+
+    mutex_.Release();
+}
+
+void HttpRequestPool::ProcessRequests(unsigned index)
+{
+    for (;;)
+    {
+        HttpRequest* request = nullptr;
+
+        {
+            MutexLock lock(mutex_);
+            if (shutDown_)
+                return;
+
+            // Threads beyond a lowered limit stay idle
+            if (index < maxConcurrentRequests_ && !queue_.Empty())
+            {
+                request = queue_.Front();
+                queue_.PopFront();
+                activeRequests_.Push(request);
+            }
+        }
+
+        if (!request)
+        {
+            Time::Sleep(5);
+            continue;
+        }
+
+        request->Process(this);
+
+        MutexLock lock(mutex_);
+        activeRequests_.Remove(request);
+    }
+}
+
+mg_connection* HttpRequestPool::AcquireConnection(const String& key)
+{
+    MutexLock lock(mutex_);
+    CloseExpiredConnections();
+
+    // Prefer the most recently used connection, which is the least likely to have been closed by the server
+    for (unsigned i = idleConnections_.Size() - 1; i < idleConnections_.Size(); --i)
+    {
+        if (idleConnections_[i].key_ == key)
+        {
+            mg_connection* connection = idleConnections_[i].connection_;
+            idleConnections_.Erase(i);
+            return connection;
+        }
+    }
+
+    return nullptr;
+}
+
+void HttpRequestPool::ReleaseConnection(const String& key, mg_connection* connection)
+{
+    if (!connection)
+        return;
+
+    MutexLock lock(mutex_);
+    if (shutDown_)
+    {
+        mg_close_connection(connection);
+        return;
+    }
+
+    CloseExpiredConnections();
+
+    // Keep at most as many idle connections as there can be requests in progress
+    if (idleConnections_.Size() >= maxConcurrentRequests_)
+    {
+        mg_close_connection(idleConnections_.Front().connection_);
+        idleConnections_.Erase(0);
+    }
+
+    IdleConnection idle;
+    idle.key_ = key;
+    idle.connection_ = connection;
+    idle.idleTime_ = Time::GetSystemTime();
+    idleConnections_.Push(idle);
+}
+
+unsigned HttpRequestPool::GetNumQueuedRequests() const
+{
+    MutexLock lock(mutex_);
+    return queue_.Size();
+}
+
+unsigned HttpRequestPool::GetNumIdleConnections() const
+{
+    MutexLock lock(mutex_);
+    return idleConnections_.Size();
+}
+
+void HttpRequestPool::CloseExpiredConnections()
+{
+    unsigned now = Time::GetSystemTime();
+
+    while (!idleConnections_.Empty() && now - idleConnections_.Front().idleTime_ > IDLE_CONNECTION_TIMEOUT)
+    {
+        mg_close_connection(idleConnections_.Front().connection_);
+        idleConnections_.Erase(0);
+    }
+}
+
 }
@@ -25,14 +25,21 @@
 #pragma once
 
 #include "../Container/ArrayPtr.h"
+#include "../Container/List.h"
 #include "../Core/Mutex.h"
+#include "../Container/Ptr.h"
 #include "../Container/RefCounted.h"
 #include "../Core/Thread.h"
 #include "../IO/Deserializer.h"
 
+struct mg_connection;
+
 namespace Urho3D
 {
 
+class HttpRequestPool;
+class HttpWorkerThread;
+
 /// HTTP connection state.
 enum HttpRequestState
 {
@@ -45,9 +52,11 @@ enum HttpRequestState
 /// An HTTP connection with response data stream.
 class URHO3D_API HttpRequest : public RefCounted, public Deserializer, public Thread
 {
+    friend class HttpRequestPool;
+
 public:
-    /// Construct with parameters.
-    HttpRequest(const String& url, const String& verb, const Vector<String>& headers, const String& postData);
+    /// Construct with parameters. With a pool, the request is queued for the pool's worker threads and may reuse a kept-alive connection to the same host. Otherwise it runs in its own thread on a connection of its own.
+    HttpRequest(const String& url, const String& verb, const Vector<String>& headers, const String& postData, HttpRequestPool* pool = nullptr);
     /// Destruct. Release the connection object.
     ~HttpRequest() override;
 
@@ -84,6 +93,8 @@ public:
     bool IsOpen() const { return GetState() == HTTP_OPEN; }
 
 private:
+    /// Send the request and stream the response data to the read buffer until closed. Acquire and release the connection through the pool if not null.
+    void Process(HttpRequestPool* pool);
     /// Check for available read data in buffer and whether end has been reached. Must only be called when the mutex is held by the main thread.
     Pair<unsigned, bool> CheckAvailableSizeAndEof() const;
 
@@ -109,6 +120,69 @@ private:
     unsigned readPosition_;
     /// Read buffer write cursor.
     unsigned writePosition_;
+    /// Pool the request was queued to.
+    WeakPtr<HttpRequestPool> pool_;
+};
+
+/// Worker threads and kept-alive connections shared by the HTTP requests made through the Network subsystem.
+/// @nobind
+class URHO3D_API HttpRequestPool : public RefCounted
+{
+public:
+    /// Construct with the maximum number of requests processed at the same time.
+    explicit HttpRequestPool(unsigned maxConcurrentRequests);
+    /// Destruct. Cancel the requests in progress, fail the queued requests and close the idle connections.
+    ~HttpRequestPool() override;
+
+    /// Set the maximum number of requests processed at the same time. Additional requests wait in a queue. Worker threads are created as needed, but are not removed when the limit is lowered.
+    void SetMaxConcurrentRequests(unsigned num);
+    /// Queue a request for the worker threads.
+    void QueueRequest(HttpRequest* request);
+    /// Remove a request from the queue, or cancel it and wait for the worker thread to finish with it.
+    void CancelRequest(HttpRequest* request);
+    /// Process queued requests until shut down. Called by the worker threads.
+    void ProcessRequests(unsigned index);
+    /// Take an idle connection to the given protocol, host and port for reuse, or return null if none.
+    mg_connection* AcquireConnection(const String& key);
+    /// Return a connection whose response was read to the end for reuse by later requests to the same host.
+    void ReleaseConnection(const String& key, mg_connection* connection);
+
+    /// Return the maximum number of requests processed at the same time.
+    unsigned GetMaxConcurrentRequests() const { return maxConcurrentRequests_; }
+    /// Return the number of requests waiting in the queue.
+    unsigned GetNumQueuedRequests() const;
+    /// Return the number of idle kept-alive connections.
+    unsigned GetNumIdleConnections() const;
+
+private:
+    /// Kept-alive connection waiting for reuse.
+    struct IdleConnection
+    {
+        /// Protocol, host and port.
+        String key_;
+        /// Connection.
+        mg_connection* connection_;
+        /// System time in milliseconds when the connection became idle.
+        unsigned idleTime_;
+    };
+
+    /// Close idle connections that have been unused for too long. Must be called with the mutex held.
+    void CloseExpiredConnections();
+
+    /// Worker threads.
+    Vector<SharedPtr<HttpWorkerThread> > threads_;
+    /// Requests waiting for a worker thread.
+    List<HttpRequest*> queue_;
+    /// Requests being processed.
+    PODVector<HttpRequest*> activeRequests_;
+    /// Idle kept-alive connections, oldest first.
+    Vector<IdleConnection> idleConnections_;
+    /// Mutex for the queue, the active requests and the idle connections.
+    mutable Mutex mutex_;
+    /// Maximum number of requests processed at the same time.
+    unsigned maxConcurrentRequests_;
+    /// Shutting down flag.
+    volatile bool shutDown_;
 };
 
 }
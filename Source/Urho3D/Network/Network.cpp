@@ -24,7 +24,9 @@
 
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
+#include "../Core/Metrics.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Engine/EngineEvents.h"
 #include "../IO/FileSystem.h"
 #include "../Input/InputEvents.h"
@@ -52,6 +54,12 @@
 namespace Urho3D
 {
 
+/// Build the server update of a client connection in a worker thread.
+static void SendServerUpdateWork(const WorkItem* item, unsigned threadIndex)
+{
+    static_cast<Connection*>(item->start_)->SendServerUpdate();
+}
+
 static const char* RAKNET_MESSAGEID_STRINGS[] = {
     "ID_CONNECTED_PING",
     "ID_UNCONNECTED_PING",
@@ -192,6 +200,7 @@ static const char* RAKNET_MESSAGEID_STRINGS[] = {
 
 static const int DEFAULT_UPDATE_FPS = 30;
 static const int SERVER_TIMEOUT_TIME = 10000;
+static const unsigned DEFAULT_MAX_CONCURRENT_HTTP_REQUESTS = 4;
 
 Network::Network(Context* context) :
     Object(context),
@@ -200,7 +209,10 @@ Network::Network(Context* context) :
     simulatedPacketLoss_(0.0f),
     updateInterval_(1.0f / (float)DEFAULT_UPDATE_FPS),
     updateAcc_(0.0f),
+    updateTick_(0),
+    maxConcurrentHttpRequests_(DEFAULT_MAX_CONCURRENT_HTTP_REQUESTS),
     isServer_(false),
+    parallelServerUpdate_(false),
     scene_(nullptr),
     natPunchServerAddress_(nullptr),
     remoteGUID_(nullptr)
@@ -219,6 +231,14 @@ Network::Network(Context* context) :
     // Register Network library object factories
     RegisterNetworkLibrary(context_);
 
+    auto* metrics = GetSubsystem<Metrics>();
+    if (metrics)
+    {
+        bytesReceivedMetric_ = metrics->GetCounter("Network", "received_bytes_total", "Bytes received in network packets.");
+        bytesSentMetric_ = metrics->GetCounter("Network", "sent_bytes_total", "Bytes sent in network packets.");
+        connectionsMetric_ = metrics->GetGauge("Network", "connections", "Open client and server connections.");
+    }
+
     SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(Network, HandleBeginFrame));
     SubscribeToEvent(E_RENDERUPDATE, URHO3D_HANDLER(Network, HandleRenderUpdate));
 
@@ -276,6 +296,9 @@ Network::~Network()
 
     clientConnections_.Clear();
 
+    // Cancel the HTTP requests in progress and close the kept-alive connections
+    httpRequestPool_.Reset();
+
     delete natPunchthroughServerClient_;
     natPunchthroughServerClient_ = nullptr;
     delete natPunchthroughClient_;
@@ -527,7 +550,11 @@ void Network::BroadcastMessage(int msgID, bool reliable, bool inOrder, const uns
     msgData.Write(data, numBytes);
 
     if (isServer_)
+    {
         rakPeer_->Send((const char*)msgData.GetData(), (int)msgData.GetSize(), HIGH_PRIORITY, RELIABLE, (char)0, SLNet::UNASSIGNED_RAKNET_GUID, true);
+        if (bytesSentMetric_)
+            bytesSentMetric_->Increment((long long)msgData.GetSize() * clientConnections_.Size());
+    }
     else
         URHO3D_LOGERROR("Server not running, can not broadcast messages");
 }
@@ -577,6 +604,11 @@ void Network::SetUpdateFps(int fps)
     updateAcc_ = 0.0f;
 }
 
+void Network::SetParallelServerUpdate(bool enable)
+{
+    parallelServerUpdate_ = enable;
+}
+
 void Network::SetSimulatedLatency(int ms)
 {
     simulatedLatency_ = Max(ms, 0);
@@ -641,11 +673,21 @@ SharedPtr<HttpRequest> Network::MakeHttpRequest(const String& url, const String&
 {
     URHO3D_PROFILE(MakeHttpRequest);
 
+    if (!httpRequestPool_)
+        httpRequestPool_ = new HttpRequestPool(maxConcurrentHttpRequests_);
+
     // The initialization of the request will take time, can not know at this point if it has an error or not
-    SharedPtr<HttpRequest> request(new HttpRequest(url, verb, headers, postData));
+    SharedPtr<HttpRequest> request(new HttpRequest(url, verb, headers, postData, httpRequestPool_));
     return request;
 }
 
+void Network::SetMaxConcurrentHttpRequests(unsigned num)
+{
+    maxConcurrentHttpRequests_ = Max(num, 1U);
+    if (httpRequestPool_)
+        httpRequestPool_->SetMaxConcurrentRequests(maxConcurrentHttpRequests_);
+}
+
 void Network::BanAddress(const String& address)
 {
     rakPeer_->AddToBanList(address.CString(), 0);
@@ -895,6 +937,8 @@ void Network::Update(float timeStep)
     {
         while (SLNet::Packet* packet = rakPeer_->Receive())
         {
+            if (bytesReceivedMetric_)
+                bytesReceivedMetric_->Increment(packet->length);
             HandleIncomingPacket(packet, true);
             rakPeer_->DeallocatePacket(packet);
         }
@@ -905,10 +949,15 @@ void Network::Update(float timeStep)
     {
         while (SLNet::Packet* packet = rakPeerClient_->Receive())
         {
+            if (bytesReceivedMetric_)
+                bytesReceivedMetric_->Increment(packet->length);
             HandleIncomingPacket(packet, false);
             rakPeerClient_->DeallocatePacket(packet);
         }
     }
+
+    if (connectionsMetric_)
+        connectionsMetric_->Set(clientConnections_.Size() + (serverConnection_ ? 1 : 0));
 }
 
 void Network::PostUpdate(float timeStep)
@@ -923,6 +972,7 @@ void Network::PostUpdate(float timeStep)
         // Notify of the impending update to allow for example updated client controls to be set
         SendEvent(E_NETWORKUPDATE);
         updateAcc_ = fmodf(updateAcc_, updateInterval_);
+        ++updateTick_;
 
         if (IsServerRunning())
         {
@@ -946,14 +996,51 @@ void Network::PostUpdate(float timeStep)
             {
                 URHO3D_PROFILE(SendServerUpdate);
 
-                // Then send server updates for each client connection
-                for (HashMap<SLNet::AddressOrGUID, SharedPtr<Connection> >::Iterator i = clientConnections_.Begin();
-                     i != clientConnections_.End(); ++i)
+                auto* queue = GetSubsystem<WorkQueue>();
+                if (parallelServerUpdate_ && queue && queue->GetNumThreads() && clientConnections_.Size() > 1)
+                {
+                    // The replication states are per connection, so the updates can be built in parallel. The workers read
+                    // world positions for interest management, so bring them up to date first
+                    for (HashSet<Scene*>::ConstIterator i = networkScenes_.Begin(); i != networkScenes_.End(); ++i)
+                        (*i)->UpdateReplicatedTransforms();
+
+                    for (HashMap<SLNet::AddressOrGUID, SharedPtr<Connection> >::Iterator i = clientConnections_.Begin();
+                         i != clientConnections_.End(); ++i)
+                    {
+                        Connection* connection = i->second_;
+                        connection->UpdateBandwidth();
+                        connection->SetDeferSend(true);
+
+                        SharedPtr<WorkItem> item = queue->GetFreeItem();
+                        item->priority_ = M_MAX_UNSIGNED;
+                        item->workFunction_ = SendServerUpdateWork;
+                        item->start_ = connection;
+                        queue->AddWorkItem(item);
+                    }
+                    queue->Complete(M_MAX_UNSIGNED);
+
+                    // Hand the packets that filled up during the update to SLikeNet in order, then send the rest as usual
+                    for (HashMap<SLNet::AddressOrGUID, SharedPtr<Connection> >::Iterator i = clientConnections_.Begin();
+                         i != clientConnections_.End(); ++i)
+                    {
+                        i->second_->SetDeferSend(false);
+                        i->second_->SendRemoteEvents();
+                        i->second_->SendPackages();
+                        i->second_->SendAllBuffers();
+                    }
+                }
+                else
                 {
-                    i->second_->SendServerUpdate();
-                    i->second_->SendRemoteEvents();
-                    i->second_->SendPackages();
-                    i->second_->SendAllBuffers();
+                    // Then send server updates for each client connection
+                    for (HashMap<SLNet::AddressOrGUID, SharedPtr<Connection> >::Iterator i = clientConnections_.Begin();
+                         i != clientConnections_.End(); ++i)
+                    {
+                        i->second_->UpdateBandwidth();
+                        i->second_->SendServerUpdate();
+                        i->second_->SendRemoteEvents();
+                        i->second_->SendPackages();
+                        i->second_->SendAllBuffers();
+                    }
                 }
             }
         }
@@ -961,6 +1048,7 @@ void Network::PostUpdate(float timeStep)
         if (serverConnection_)
         {
             // Send the client update
+            serverConnection_->UpdateBandwidth();
             serverConnection_->SendClientUpdate();
             serverConnection_->SendRemoteEvents();
             serverConnection_->SendAllBuffers();
@@ -31,7 +31,9 @@ namespace Urho3D
 {
 
 class HttpRequest;
+class HttpRequestPool;
 class MemoryBuffer;
+class Metric;
 class Scene;
 
 /// %Network subsystem. Manages client-server communications using the UDP protocol.
@@ -88,6 +90,9 @@ public:
     /// Set network update FPS.
     /// @property
     void SetUpdateFps(int fps);
+    /// Set whether to build the server updates of the client connections in worker threads. The messages are still handed to SLikeNet from the main thread.
+    /// @property
+    void SetParallelServerUpdate(bool enable);
     /// Set simulated latency in milliseconds. This adds a fixed delay before sending each packet.
     /// @property
     void SetSimulatedLatency(int ms);
@@ -105,7 +110,10 @@ public:
     void SetPackageCacheDir(const String& path);
     /// Trigger all client connections in the specified scene to download a package file from the server. Can be used to download additional resource packages when clients are already joined in the scene. The package must have been added as a requirement to the scene, or else the eventual download will fail.
     void SendPackageToClients(Scene* scene, PackageFile* package);
-    /// Perform an HTTP request to the specified URL. Empty verb defaults to a GET request. Return a request object which can be used to read the response data.
+    /// Set the maximum number of HTTP requests processed at the same time by the shared worker threads. Requests beyond the limit wait in a queue. Default 4.
+    /// @property
+    void SetMaxConcurrentHttpRequests(unsigned num);
+    /// Perform an HTTP request to the specified URL. Empty verb defaults to a GET request. Return a request object which can be used to read the response data. The request is processed by the shared worker threads, which reuse kept-alive connections to the same host.
     SharedPtr<HttpRequest> MakeHttpRequest(const String& url, const String& verb = String::EMPTY, const Vector<String>& headers = Vector<String>(), const String& postData = String::EMPTY);
     /// Ban specific IP addresses.
     void BanAddress(const String& address);
@@ -113,6 +121,13 @@ public:
     /// @property
     int GetUpdateFps() const { return updateFps_; }
 
+    /// Return the number of network updates sent so far. Carried in the node latest data as the server tick, from which the clients interpolate.
+    unsigned GetUpdateTick() const { return updateTick_; }
+
+    /// Return whether the server updates of the client connections are built in worker threads.
+    /// @property
+    bool GetParallelServerUpdate() const { return parallelServerUpdate_; }
+
     /// Return simulated latency in milliseconds.
     /// @property
     int GetSimulatedLatency() const { return simulatedLatency_; }
@@ -139,6 +154,10 @@ public:
     /// @property
     const String& GetPackageCacheDir() const { return packageCacheDir_; }
 
+    /// Return the maximum number of HTTP requests processed at the same time.
+    /// @property
+    unsigned GetMaxConcurrentHttpRequests() const { return maxConcurrentHttpRequests_; }
+
     /// Process incoming messages from connections. Called by HandleBeginFrame.
     void Update(float timeStep);
     /// Send outgoing messages after frame logic. Called by HandleRenderUpdate.
@@ -182,10 +201,18 @@ private:
     float updateInterval_;
     /// Update time accumulator.
     float updateAcc_;
+    /// Number of network updates sent.
+    unsigned updateTick_;
     /// Package cache directory.
     String packageCacheDir_;
+    /// HTTP request worker threads and kept-alive connections. Created on the first request.
+    SharedPtr<HttpRequestPool> httpRequestPool_;
+    /// Maximum number of HTTP requests processed at the same time.
+    unsigned maxConcurrentHttpRequests_;
     /// Whether we started as server or not.
     bool isServer_;
+    /// Build the server updates in worker threads flag.
+    bool parallelServerUpdate_;
     /// Server/Client password used for connecting.
     String password_;
     /// Scene which will be used for NAT punchtrough connections.
@@ -202,6 +229,12 @@ private:
     SLNet::RakNetGUID* remoteGUID_;
     /// Local server GUID.
     String guid_;
+    /// Received bytes metric.
+    SharedPtr<Metric> bytesReceivedMetric_;
+    /// Sent bytes metric for broadcasts. The connections count their own packets into the same metric.
+    SharedPtr<Metric> bytesSentMetric_;
+    /// Open connections metric.
+    SharedPtr<Metric> connectionsMetric_;
 };
 
 /// Register Network library objects.
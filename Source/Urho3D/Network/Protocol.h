@@ -31,10 +31,10 @@ static const int MSG_IDENTITY = 0x87;
 static const int MSG_CONTROLS = 0x88;
 /// Client->server: scene has been loaded and client is ready to proceed.
 static const int MSG_SCENELOADED = 0x89;
-/// Client->server: request a package file.
+/// Client->server: request a package file, with the bitmap of the fragments already received from an interrupted download.
 static const int MSG_REQUESTPACKAGE = 0x8A;
 
-/// Server->client: package file data fragment.
+/// Server->client: package file data fragment, LZ4 compressed if smaller.
 static const int MSG_PACKAGEDATA = 0x8B;
 /// Server->client: load new scene. In case of empty filename the client should just empty the scene.
 static const int MSG_LOADSCENE = 0x8C;
@@ -63,6 +63,8 @@ static const int MSG_REMOTEEVENT = 0x96;
 static const int MSG_REMOTENODEEVENT = 0x97;
 /// Server->client: info about package.
 static const int MSG_PACKAGEINFO = 0x98;
+/// Client->server: acknowledge received quantized node latest data.
+static const int MSG_LATESTDATAACK = 0x9A;
 
 /// Packet that includes all the above messages
 static const int MSG_PACKED_MESSAGE = 0x99;
@@ -74,5 +76,7 @@ static const int MSG_USER = 0x200;
 static const unsigned CONTROLS_CONTENT_ID = 1;
 /// Package file fragment size.
 static const unsigned PACKAGE_FRAGMENT_SIZE = 1024;
+/// Maximum size of an LZ4 compressed package file fragment.
+static const unsigned PACKAGE_FRAGMENT_COMPRESS_BOUND = PACKAGE_FRAGMENT_SIZE + PACKAGE_FRAGMENT_SIZE / 255 + 16;
 
 }
@@ -32,6 +32,8 @@
 #include "../Graphics/Model.h"
 #include "../Graphics/Terrain.h"
 #include "../Graphics/VertexBuffer.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../Physics/CollisionShape.h"
 #include "../Physics/PhysicsUtils.h"
@@ -49,6 +51,7 @@
 #include <Bullet/BulletCollision/CollisionShapes/btConvexHullShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btCylinderShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+#include <Bullet/BulletCollision/CollisionShapes/btOptimizedBvh.h>
 #include <Bullet/BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btSphereShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h>
@@ -62,6 +65,10 @@ namespace Urho3D
 
 static const float DEFAULT_COLLISION_MARGIN = 0.04f;
 static const unsigned QUANTIZE_MAX_TRIANGLES = 1000000;
+/// Version of the collision geometry cache files. Increment when the format changes.
+static const unsigned GEOMETRY_CACHE_VERSION = 1;
+/// Alignment of the serialized BVH buffer required by Bullet.
+static const unsigned BVH_BUFFER_ALIGNMENT = 16;
 
 static const btVector3 WHITE(1.0f, 1.0f, 1.0f);
 static const btVector3 GREEN(0.0f, 1.0f, 0.0f);
@@ -83,6 +90,80 @@ static const char* typeNames[] =
 
 extern const char* PHYSICS_CATEGORY;
 
+static inline unsigned HashWords(unsigned hash, const void* data, unsigned numWords)
+{
+    const auto* words = static_cast<const unsigned*>(data);
+    for (unsigned i = 0; i < numWords; ++i)
+        hash = words[i] + (hash << 6u) + (hash << 16u) - hash;
+    return hash;
+}
+
+/// Return the resource name of the geometry cache file of a model shape, next to the model.
+static String GetGeometryCacheName(const String& modelName, ShapeType shapeType, unsigned lodLevel)
+{
+    return GetPath(modelName) + GetFileName(modelName) + "." + typeNames[shapeType] + String(lodLevel) + ".col";
+}
+
+static void WriteGeometryCacheHeader(Serializer& dest, ShapeType shapeType, unsigned dataHash)
+{
+    dest.WriteFileID("UCOL");
+    dest.WriteUInt(GEOMETRY_CACHE_VERSION);
+    // The serialized Bullet structures are only valid for the same build configuration
+    dest.WriteUByte((unsigned char)sizeof(void*));
+    dest.WriteUByte((unsigned char)sizeof(btScalar));
+    dest.WriteUShort((unsigned short)sizeof(btQuantizedBvh));
+    dest.WriteUInt(shapeType);
+    dest.WriteUInt(dataHash);
+}
+
+static bool ReadGeometryCacheHeader(Deserializer& source, ShapeType shapeType, unsigned dataHash)
+{
+    return source.ReadFileID() == "UCOL" && source.ReadUInt() == GEOMETRY_CACHE_VERSION && source.ReadUByte() == sizeof(void*) &&
+        source.ReadUByte() == sizeof(btScalar) && source.ReadUShort() == sizeof(btQuantizedBvh) && source.ReadUInt() == shapeType &&
+        source.ReadUInt() == dataHash;
+}
+
+/// Open the geometry cache file of a model shape made from the same source data, or return null if it does not exist or is outdated.
+static SharedPtr<File> OpenGeometryCacheFile(Model* model, ShapeType shapeType, unsigned lodLevel, unsigned dataHash)
+{
+    if (model->GetName().Empty())
+        return SharedPtr<File>();
+
+    auto* cache = model->GetSubsystem<ResourceCache>();
+    String cacheName = GetGeometryCacheName(model->GetName(), shapeType, lodLevel);
+    if (!cache->Exists(cacheName))
+        return SharedPtr<File>();
+
+    SharedPtr<File> file = cache->GetFile(cacheName, false);
+    if (!file || !ReadGeometryCacheHeader(*file, shapeType, dataHash))
+    {
+        URHO3D_LOGDEBUG("Collision geometry cache " + cacheName + " is outdated");
+        return SharedPtr<File>();
+    }
+
+    return file;
+}
+
+/// Create the geometry cache file of a model shape next to the model file. Return null if the model was not loaded from a file in the resource directories.
+static SharedPtr<File> CreateGeometryCacheFile(Model* model, ShapeType shapeType, unsigned lodLevel, unsigned dataHash)
+{
+    auto* cache = model->GetSubsystem<ResourceCache>();
+    String modelFileName = cache->GetResourceFileName(model->GetName());
+    if (modelFileName.Empty())
+    {
+        URHO3D_LOGWARNING("Can not save collision geometry cache for " + model->GetName() + ", as it is not loaded from a file");
+        return SharedPtr<File>();
+    }
+
+    String cacheFileName = GetGeometryCacheName(modelFileName, shapeType, lodLevel);
+    SharedPtr<File> file(new File(model->GetContext(), cacheFileName, FILE_WRITE));
+    if (!file->IsOpen())
+        return SharedPtr<File>();
+
+    WriteGeometryCacheHeader(*file, shapeType, dataHash);
+    return file;
+}
+
 class TriangleMeshInterface : public btTriangleIndexVertexArray
 {
 public:
@@ -143,7 +224,8 @@ public:
     explicit TriangleMeshInterface(CustomGeometry* custom) :
         btTriangleIndexVertexArray()
     {
-        const Vector<PODVector<CustomGeometryVertex> >& srcVertices = custom->GetVertices();
+        // Read through a const pointer so that the custom geometry is not marked changed
+        const Vector<PODVector<CustomGeometryVertex> >& srcVertices = static_cast<const CustomGeometry*>(custom)->GetVertices();
         unsigned totalVertexCount = 0;
         unsigned totalTriangles = 0;
 
@@ -188,6 +270,31 @@ public:
         useQuantize_ = totalTriangles <= QUANTIZE_MAX_TRIANGLES;
     }
 
+    /// Return a hash of the triangle vertex positions, for validating the geometry cache.
+    unsigned GetTriangleHash() const
+    {
+        unsigned hash = 0;
+
+        for (int i = 0; i < m_indexedMeshes.size(); ++i)
+        {
+            const btIndexedMesh& mesh = m_indexedMeshes[i];
+            hash = HashWords(hash, &mesh.m_numTriangles, 1);
+
+            for (int j = 0; j < mesh.m_numTriangles; ++j)
+            {
+                const unsigned char* indices = mesh.m_triangleIndexBase + j * mesh.m_triangleIndexStride;
+                for (unsigned k = 0; k < 3; ++k)
+                {
+                    unsigned index = mesh.m_indexType == PHY_SHORT ? reinterpret_cast<const unsigned short*>(indices)[k] :
+                        reinterpret_cast<const unsigned*>(indices)[k];
+                    hash = HashWords(hash, mesh.m_vertexBase + index * mesh.m_vertexStride, 3);
+                }
+            }
+        }
+
+        return hash;
+    }
+
     /// OK to use quantization flag.
     bool useQuantize_;
 
@@ -196,24 +303,122 @@ private:
     Vector<SharedArrayPtr<unsigned char> > dataArrays_;
 };
 
-TriangleMeshData::TriangleMeshData(Model* model, unsigned lodLevel)
+TriangleMeshData::TriangleMeshData(Model* model, unsigned lodLevel, bool saveCacheFile)
 {
     meshInterface_ = new TriangleMeshInterface(model, lodLevel);
-    shape_ = new btBvhTriangleMeshShape(meshInterface_.Get(), meshInterface_->useQuantize_, true);
 
-    infoMap_ = new btTriangleInfoMap();
-    btGenerateInternalEdgeInfo(shape_.Get(), infoMap_.Get());
+    // Building the BVH and the internal edge info of a big mesh is slow, so check first for a cache file made from the same
+    // triangles
+    unsigned triangleHash = meshInterface_->GetTriangleHash();
+    SharedPtr<File> cacheFile = OpenGeometryCacheFile(model, SHAPE_TRIANGLEMESH, lodLevel, triangleHash);
+    if (cacheFile && LoadCacheFile(*cacheFile, triangleHash))
+        return;
+
+    Build();
+
+    if (saveCacheFile)
+    {
+        cacheFile = CreateGeometryCacheFile(model, SHAPE_TRIANGLEMESH, lodLevel, triangleHash);
+        if (!cacheFile || !SaveCacheFile(*cacheFile, triangleHash))
+            URHO3D_LOGWARNING("Failed to save collision geometry cache for " + model->GetName());
+    }
 }
 
 TriangleMeshData::TriangleMeshData(CustomGeometry* custom)
 {
     meshInterface_ = new TriangleMeshInterface(custom);
+    Build();
+}
+
+TriangleMeshData::~TriangleMeshData()
+{
+    // The shape does not own a BVH loaded in place, so destroy it after the shape
+    shape_.Reset();
+    if (bvhBuffer_)
+    {
+        static_cast<btOptimizedBvh*>(bvhBuffer_)->~btOptimizedBvh();
+        btAlignedFree(bvhBuffer_);
+    }
+}
+
+void TriangleMeshData::Build()
+{
     shape_ = new btBvhTriangleMeshShape(meshInterface_.Get(), meshInterface_->useQuantize_, true);
 
     infoMap_ = new btTriangleInfoMap();
     btGenerateInternalEdgeInfo(shape_.Get(), infoMap_.Get());
 }
 
+bool TriangleMeshData::LoadCacheFile(Deserializer& source, unsigned triangleHash)
+{
+    bool useQuantize = source.ReadBool();
+    unsigned bvhSize = source.ReadUInt();
+    if (useQuantize != meshInterface_->useQuantize_ || !bvhSize || bvhSize > source.GetSize() - source.GetPosition())
+        return false;
+
+    void* bvhBuffer = btAlignedAlloc(bvhSize, BVH_BUFFER_ALIGNMENT);
+    btOptimizedBvh* bvh = nullptr;
+    if (source.Read(bvhBuffer, bvhSize) == bvhSize)
+        bvh = btOptimizedBvh::deSerializeInPlace(bvhBuffer, bvhSize, false);
+    if (!bvh)
+    {
+        btAlignedFree(bvhBuffer);
+        return false;
+    }
+
+    auto infoMap = MakeUnique<btTriangleInfoMap>();
+    unsigned numInfos = source.ReadVLE();
+    for (unsigned i = 0; i < numInfos && !source.IsEof(); ++i)
+    {
+        int triangleIndex = source.ReadInt();
+        btTriangleInfo info;
+        info.m_flags = source.ReadInt();
+        info.m_edgeV0V1Angle = source.ReadFloat();
+        info.m_edgeV1V2Angle = source.ReadFloat();
+        info.m_edgeV2V0Angle = source.ReadFloat();
+        infoMap->insert(triangleIndex, info);
+    }
+    if (infoMap->size() != (int)numInfos)
+    {
+        bvh->~btOptimizedBvh();
+        btAlignedFree(bvhBuffer);
+        return false;
+    }
+
+    shape_ = new btBvhTriangleMeshShape(meshInterface_.Get(), useQuantize, false);
+    shape_->setOptimizedBvh(bvh);
+    shape_->setTriangleInfoMap(infoMap.Get());
+    infoMap_ = infoMap.Detach();
+    bvhBuffer_ = bvhBuffer;
+    return true;
+}
+
+bool TriangleMeshData::SaveCacheFile(Serializer& dest, unsigned triangleHash) const
+{
+    btOptimizedBvh* bvh = shape_->getOptimizedBvh();
+    unsigned bvhSize = bvh->calculateSerializeBufferSize();
+    void* bvhBuffer = btAlignedAlloc(bvhSize, BVH_BUFFER_ALIGNMENT);
+    bool success = bvh->serializeInPlace(bvhBuffer, bvhSize, false);
+
+    success &= dest.WriteBool(meshInterface_->useQuantize_);
+    success &= dest.WriteUInt(bvhSize);
+    success &= dest.Write(bvhBuffer, bvhSize) == bvhSize;
+    btAlignedFree(bvhBuffer);
+
+    success &= dest.WriteVLE((unsigned)infoMap_->size());
+    for (int i = 0; i < infoMap_->size(); ++i)
+    {
+        const btTriangleInfo* info = infoMap_->getAtIndex(i);
+        success &= dest.WriteInt(infoMap_->getKeyAtIndex(i).getUid1());
+        success &= dest.WriteInt(info->m_flags);
+        success &= dest.WriteFloat(info->m_edgeV0V1Angle);
+        success &= dest.WriteFloat(info->m_edgeV1V2Angle);
+        success &= dest.WriteFloat(info->m_edgeV2V0Angle);
+    }
+
+    return success;
+}
+
 GImpactMeshData::GImpactMeshData(Model* model, unsigned lodLevel)
 {
     meshInterface_ = new TriangleMeshInterface(model, lodLevel);
@@ -224,7 +429,7 @@ GImpactMeshData::GImpactMeshData(CustomGeometry* custom)
     meshInterface_ = new TriangleMeshInterface(custom);
 }
 
-ConvexData::ConvexData(Model* model, unsigned lodLevel)
+ConvexData::ConvexData(Model* model, unsigned lodLevel, bool saveCacheFile)
 {
     PODVector<Vector3> vertices;
     unsigned numGeometries = model->GetNumGeometries();
@@ -262,12 +467,24 @@ ConvexData::ConvexData(Model* model, unsigned lodLevel)
         }
     }
 
+    unsigned vertexHash = HashWords(vertices.Size(), vertices.Size() ? vertices[0].Data() : nullptr, vertices.Size() * 3);
+    SharedPtr<File> cacheFile = OpenGeometryCacheFile(model, SHAPE_CONVEXHULL, lodLevel, vertexHash);
+    if (cacheFile && LoadCacheFile(*cacheFile, vertexHash))
+        return;
+
     BuildHull(vertices);
+
+    if (saveCacheFile)
+    {
+        cacheFile = CreateGeometryCacheFile(model, SHAPE_CONVEXHULL, lodLevel, vertexHash);
+        if (!cacheFile || !SaveCacheFile(*cacheFile, vertexHash))
+            URHO3D_LOGWARNING("Failed to save collision geometry cache for " + model->GetName());
+    }
 }
 
 ConvexData::ConvexData(CustomGeometry* custom)
 {
-    const Vector<PODVector<CustomGeometryVertex> >& srcVertices = custom->GetVertices();
+    const Vector<PODVector<CustomGeometryVertex> >& srcVertices = static_cast<const CustomGeometry*>(custom)->GetVertices();
     PODVector<Vector3> vertices;
 
     for (unsigned i = 0; i < srcVertices.Size(); ++i)
@@ -314,6 +531,41 @@ void ConvexData::BuildHull(const PODVector<Vector3>& vertices)
     }
 }
 
+bool ConvexData::LoadCacheFile(Deserializer& source, unsigned vertexHash)
+{
+    unsigned vertexCount = source.ReadVLE();
+    unsigned indexCount = source.ReadVLE();
+    if ((vertexCount * sizeof(Vector3) + indexCount * sizeof(unsigned)) > source.GetSize() - source.GetPosition())
+        return false;
+
+    SharedArrayPtr<Vector3> vertexData(new Vector3[vertexCount]);
+    SharedArrayPtr<unsigned> indexData(new unsigned[indexCount]);
+    if (source.Read(vertexData.Get(), vertexCount * sizeof(Vector3)) != vertexCount * sizeof(Vector3) ||
+        source.Read(indexData.Get(), indexCount * sizeof(unsigned)) != indexCount * sizeof(unsigned))
+        return false;
+
+    for (unsigned i = 0; i < indexCount; ++i)
+    {
+        if (indexData[i] >= vertexCount)
+            return false;
+    }
+
+    vertexCount_ = vertexCount;
+    vertexData_ = vertexData;
+    indexCount_ = indexCount;
+    indexData_ = indexData;
+    return true;
+}
+
+bool ConvexData::SaveCacheFile(Serializer& dest, unsigned vertexHash) const
+{
+    bool success = dest.WriteVLE(vertexCount_);
+    success &= dest.WriteVLE(indexCount_);
+    success &= dest.Write(vertexData_.Get(), vertexCount_ * sizeof(Vector3)) == vertexCount_ * sizeof(Vector3);
+    success &= dest.Write(indexData_.Get(), indexCount_ * sizeof(unsigned)) == indexCount_ * sizeof(unsigned);
+    return success;
+}
+
 HeightfieldData::HeightfieldData(Terrain* terrain, unsigned lodLevel) :
     heightData_(terrain->GetHeightData()),
     spacing_(terrain->GetSpacing()),
@@ -368,6 +620,14 @@ HeightfieldData::HeightfieldData(Terrain* terrain, unsigned lodLevel) :
     }
 }
 
+PrimitiveShapeData::PrimitiveShapeData(btCollisionShape* shape, CollisionGeometryData* source) :
+    shape_(shape),
+    source_(source)
+{
+}
+
+PrimitiveShapeData::~PrimitiveShapeData() = default;
+
 bool HasDynamicBuffers(Model* model, unsigned lodLevel)
 {
     unsigned numGeometries = model->GetNumGeometries();
@@ -394,14 +654,17 @@ bool HasDynamicBuffers(Model* model, unsigned lodLevel)
     return false;
 }
 
-CollisionGeometryData* CreateCollisionGeometryData(ShapeType shapeType, Model* model, unsigned lodLevel)
+CollisionGeometryData* CreateCollisionGeometryData(ShapeType shapeType, Model* model, unsigned lodLevel, bool saveCacheFile)
 {
+    // The triangle mesh keeps referring to the shadow data, so it must not be released afterward
+    model->RequestShadowData();
+
     switch (shapeType)
     {
     case SHAPE_TRIANGLEMESH:
-        return new TriangleMeshData(model, lodLevel);
+        return new TriangleMeshData(model, lodLevel, saveCacheFile);
     case SHAPE_CONVEXHULL:
-        return new ConvexData(model, lodLevel);
+        return new ConvexData(model, lodLevel, saveCacheFile);
     case SHAPE_GIMPACTMESH:
         return new GImpactMeshData(model, lodLevel);
     default:
@@ -453,6 +716,62 @@ btCollisionShape* CreateCollisionGeometryDataShape(ShapeType shapeType, Collisio
     }
 }
 
+static btCollisionShape* CreatePrimitiveShape(ShapeType shapeType, const Vector3& size, const Vector3& scale)
+{
+    btCollisionShape* shape = nullptr;
+
+    switch (shapeType)
+    {
+    case SHAPE_BOX:
+        shape = new btBoxShape(ToBtVector3(size * 0.5f));
+        break;
+
+    case SHAPE_SPHERE:
+        shape = new btSphereShape(size.x_ * 0.5f);
+        break;
+
+    case SHAPE_STATICPLANE:
+        return new btStaticPlaneShape(btVector3(0.0f, 1.0f, 0.0f), 0.0f);
+
+    case SHAPE_CYLINDER:
+        shape = new btCylinderShape(btVector3(size.x_ * 0.5f, size.y_ * 0.5f, size.x_ * 0.5f));
+        break;
+
+    case SHAPE_CAPSULE:
+        shape = new btCapsuleShape(size.x_ * 0.5f, Max(size.y_ - size.x_, 0.0f));
+        break;
+
+    case SHAPE_CONE:
+        shape = new btConeShape(size.x_ * 0.5f, size.y_);
+        break;
+
+    default:
+        return nullptr;
+    }
+
+    shape->setLocalScaling(ToBtVector3(scale));
+    return shape;
+}
+
+/// Remove one instance of a collision shape from a compound. A shared shape may be in the same compound several times, so match also the offset it was added with.
+static void RemoveChildShape(btCompoundShape* compound, btCollisionShape* shape, const Vector3& position, const Quaternion& rotation)
+{
+    int index = -1;
+    for (int i = compound->getNumChildShapes() - 1; i >= 0; --i)
+    {
+        if (compound->getChildShape(i) != shape)
+            continue;
+
+        index = i;
+        const btTransform& transform = compound->getChildTransform(i);
+        if (ToVector3(transform.getOrigin()) == position && ToQuaternion(transform.getRotation()) == rotation)
+            break;
+    }
+
+    if (index >= 0)
+        compound->removeChildShapeByIndex(index);
+}
+
 CollisionShape::CollisionShape(Context* context) :
     Component(context),
     shapeType_(SHAPE_BOX),
@@ -783,9 +1102,15 @@ void CollisionShape::SetMargin(float margin)
 
     if (margin != margin_)
     {
-        if (shape_)
-            shape_->setMargin(margin);
         margin_ = margin;
+        // A shared shape is replaced by one with the new margin instead of modifying it
+        if (sharedShape_)
+        {
+            UpdateShape();
+            NotifyRigidBody();
+        }
+        else if (shape_)
+            shape_->setMargin(margin);
         MarkNetworkUpdate();
     }
 }
@@ -848,7 +1173,7 @@ void CollisionShape::NotifyRigidBody(bool updateMass)
     if (node_ && shape_ && compound)
     {
         // Remove the shape first to ensure it is not added twice
-        compound->removeChildShape(shape_.Get());
+        RemoveChildShape(compound, shape_.Get(), compoundPosition_, compoundRotation_);
 
         if (IsEnabledEffective())
         {
@@ -865,6 +1190,8 @@ void CollisionShape::NotifyRigidBody(bool updateMass)
             offset.setOrigin(ToBtVector3(node_->GetWorldScale() * position));
             offset.setRotation(ToBtQuaternion(rotation_));
             compound->addChildShape(offset, shape_.Get());
+            compoundPosition_ = ToVector3(offset.getOrigin());
+            compoundRotation_ = ToQuaternion(offset.getRotation());
         }
 
         // Finally tell the rigid body to update its mass
@@ -891,11 +1218,16 @@ void CollisionShape::ReleaseShape()
     btCompoundShape* compound = GetParentCompoundShape();
     if (shape_ && compound)
     {
-        compound->removeChildShape(shape_.Get());
+        RemoveChildShape(compound, shape_.Get(), compoundPosition_, compoundRotation_);
         rigidBody_->UpdateMass();
     }
 
-    shape_.Reset();
+    // The shared shape is owned by the cache
+    if (sharedShape_)
+        shape_.Detach();
+    else
+        shape_.Reset();
+    sharedShape_.Reset();
 
     geometry_.Reset();
 
@@ -957,6 +1289,14 @@ void CollisionShape::OnMarkedDirty(Node* node)
             return;
         }
 
+        // A shared shape is replaced by one with the new scale instead of modifying it
+        if (sharedShape_)
+        {
+            UpdateShape();
+            NotifyRigidBody();
+            return;
+        }
+
         switch (shapeType_)
         {
         case SHAPE_BOX:
@@ -1018,32 +1358,12 @@ void CollisionShape::UpdateShape()
         switch (shapeType_)
         {
         case SHAPE_BOX:
-            shape_ = new btBoxShape(ToBtVector3(size_ * 0.5f));
-            shape_->setLocalScaling(ToBtVector3(cachedWorldScale_));
-            break;
-
         case SHAPE_SPHERE:
-            shape_ = new btSphereShape(size_.x_ * 0.5f);
-            shape_->setLocalScaling(ToBtVector3(cachedWorldScale_));
-            break;
-
         case SHAPE_STATICPLANE:
-            shape_ = new btStaticPlaneShape(btVector3(0.0f, 1.0f, 0.0f), 0.0f);
-            break;
-
         case SHAPE_CYLINDER:
-            shape_ = new btCylinderShape(btVector3(size_.x_ * 0.5f, size_.y_ * 0.5f, size_.x_ * 0.5f));
-            shape_->setLocalScaling(ToBtVector3(cachedWorldScale_));
-            break;
-
         case SHAPE_CAPSULE:
-            shape_ = new btCapsuleShape(size_.x_ * 0.5f, Max(size_.y_ - size_.x_, 0.0f));
-            shape_->setLocalScaling(ToBtVector3(cachedWorldScale_));
-            break;
-
         case SHAPE_CONE:
-            shape_ = new btConeShape(size_.x_ * 0.5f, size_.y_);
-            shape_->setLocalScaling(ToBtVector3(cachedWorldScale_));
+            UpdateSharedShape();
             break;
 
         case SHAPE_TRIANGLEMESH:
@@ -1081,7 +1401,7 @@ void CollisionShape::UpdateShape()
             break;
         }
 
-        if (shape_)
+        if (shape_ && !sharedShape_)
         {
             shape_->setUserPointer(this);
             shape_->setMargin(margin_);
@@ -1122,20 +1442,51 @@ void CollisionShape::UpdateCachedGeometryShape(CollisionGeometryDataCache& cache
             geometry_ = cachedGeometry->second_;
         else
         {
-            geometry_ = CreateCollisionGeometryData(shapeType_, model_, lodLevel_);
-            assert(geometry_);
             // Check if model has dynamic buffers, do not cache in that case
-            if (!HasDynamicBuffers(model_, lodLevel_))
+            bool dynamic = HasDynamicBuffers(model_, lodLevel_);
+            bool saveCacheFile = !dynamic && physicsWorld_ && physicsWorld_->GetSaveGeometryCache();
+            geometry_ = CreateCollisionGeometryData(shapeType_, model_, lodLevel_, saveCacheFile);
+            assert(geometry_);
+            if (!dynamic)
                 cache[id] = geometry_;
         }
 
-        shape_ = CreateCollisionGeometryDataShape(shapeType_, geometry_.Get(), cachedWorldScale_ * size_);
+        // Share the convex hulls of cached geometry, as each hull shape holds its own copy of the vertices
+        if (shapeType_ == SHAPE_CONVEXHULL && cache.Contains(id))
+            UpdateSharedShape(geometry_);
+        else
+            shape_ = CreateCollisionGeometryDataShape(shapeType_, geometry_.Get(), cachedWorldScale_ * size_);
         assert(shape_);
         // Watch for live reloads of the collision model to reload the geometry if necessary
         SubscribeToEvent(model_, E_RELOADFINISHED, URHO3D_HANDLER(CollisionShape, HandleModelReloadFinished));
     }
 }
 
+void CollisionShape::UpdateSharedShape(CollisionGeometryData* source)
+{
+    PrimitiveShapeKey key;
+    key.shapeType_ = shapeType_;
+    key.size_ = size_;
+    key.scale_ = cachedWorldScale_;
+    key.margin_ = margin_;
+    key.source_ = source;
+    // The static plane does not use the size or scale
+    if (shapeType_ == SHAPE_STATICPLANE)
+        key.size_ = key.scale_ = Vector3::ZERO;
+
+    SharedPtr<CollisionGeometryData>& data = physicsWorld_->GetPrimitiveShapeCache()[key];
+    if (!data)
+    {
+        btCollisionShape* shape = source ? CreateCollisionGeometryDataShape(shapeType_, source, cachedWorldScale_ * size_) :
+            CreatePrimitiveShape(shapeType_, size_, cachedWorldScale_);
+        shape->setMargin(margin_);
+        data = new PrimitiveShapeData(shape, source);
+    }
+
+    sharedShape_ = static_cast<PrimitiveShapeData*>(data.Get());
+    shape_ = sharedShape_->shape_.Get();
+}
+
 void CollisionShape::SetModelShape(ShapeType shapeType, Model* model, unsigned lodLevel,
     const Vector3& scale, const Vector3& position, const Quaternion& rotation)
 {
@@ -41,10 +41,12 @@ namespace Urho3D
 {
 
 class CustomGeometry;
+class Deserializer;
 class Geometry;
 class Model;
 class PhysicsWorld;
 class RigidBody;
+class Serializer;
 class Terrain;
 class TriangleMeshInterface;
 
@@ -75,10 +77,19 @@ using CollisionGeometryDataCache = HashMap<Pair<Model*, unsigned>, SharedPtr<Col
 /// Triangle mesh geometry data.
 struct TriangleMeshData : public CollisionGeometryData
 {
-    /// Construct from a model.
-    TriangleMeshData(Model* model, unsigned lodLevel);
+    /// Construct from a model. Load the BVH and internal edge info from the model's geometry cache file if it is up to date, and optionally save the file after building them.
+    TriangleMeshData(Model* model, unsigned lodLevel, bool saveCacheFile = false);
     /// Construct from a custom geometry.
     explicit TriangleMeshData(CustomGeometry* custom);
+    /// Destruct.
+    ~TriangleMeshData() override;
+
+    /// Build the BVH and internal edge info.
+    void Build();
+    /// Load the BVH and internal edge info from a geometry cache file made from the same triangles. Return true if successful.
+    bool LoadCacheFile(Deserializer& source, unsigned triangleHash);
+    /// Save the BVH and internal edge info to a geometry cache file. Return true if successful.
+    bool SaveCacheFile(Serializer& dest, unsigned triangleHash) const;
 
     /// Bullet triangle mesh interface.
     UniquePtr<TriangleMeshInterface> meshInterface_;
@@ -86,6 +97,8 @@ struct TriangleMeshData : public CollisionGeometryData
     UniquePtr<btBvhTriangleMeshShape> shape_;
     /// Bullet triangle info map.
     UniquePtr<btTriangleInfoMap> infoMap_;
+    /// Aligned buffer holding the BVH loaded from a geometry cache file, used by the shape in place. Null if the BVH was built.
+    void* bvhBuffer_{};
 };
 
 /// Triangle mesh geometry data.
@@ -103,13 +116,17 @@ struct GImpactMeshData : public CollisionGeometryData
 /// Convex hull geometry data.
 struct ConvexData : public CollisionGeometryData
 {
-    /// Construct from a model.
-    ConvexData(Model* model, unsigned lodLevel);
+    /// Construct from a model. Load the hull from the model's geometry cache file if it is up to date, and optionally save the file after building it.
+    ConvexData(Model* model, unsigned lodLevel, bool saveCacheFile = false);
     /// Construct from a custom geometry.
     explicit ConvexData(CustomGeometry* custom);
 
     /// Build the convex hull from vertices.
     void BuildHull(const PODVector<Vector3>& vertices);
+    /// Load the hull from a geometry cache file made from the same vertices. Return true if successful.
+    bool LoadCacheFile(Deserializer& source, unsigned vertexHash);
+    /// Save the hull to a geometry cache file. Return true if successful.
+    bool SaveCacheFile(Serializer& dest, unsigned vertexHash) const;
 
     /// Vertex data.
     SharedArrayPtr<Vector3> vertexData_;
@@ -139,6 +156,20 @@ struct HeightfieldData : public CollisionGeometryData
     float maxHeight_;
 };
 
+/// Primitive or convex hull collision shape shared by the collision shapes with the same parameters.
+struct PrimitiveShapeData : public CollisionGeometryData
+{
+    /// Construct with the Bullet collision shape to share and the convex hull geometry it was created from.
+    PrimitiveShapeData(btCollisionShape* shape, CollisionGeometryData* source);
+    /// Destruct.
+    ~PrimitiveShapeData() override;
+
+    /// Bullet collision shape.
+    UniquePtr<btCollisionShape> shape_;
+    /// Convex hull geometry data, kept alive as the cache is keyed by it.
+    SharedPtr<CollisionGeometryData> source_;
+};
+
 /// Physics collision shape component.
 class URHO3D_API CollisionShape : public Component
 {
@@ -216,7 +247,7 @@ public:
     /// @property
     void SetLodLevel(unsigned lodLevel);
 
-    /// Return Bullet collision shape.
+    /// Return Bullet collision shape. Primitive and model convex hull shapes are shared between the collision shapes with the same parameters, and have no user pointer.
     btCollisionShape* GetCollisionShape() const { return shape_.Get(); }
 
     /// Return the shared geometry data.
@@ -289,6 +320,8 @@ private:
     void UpdateShape();
     /// Update cached geometry collision shape.
     void UpdateCachedGeometryShape(CollisionGeometryDataCache& cache);
+    /// Update the collision shape shared through the primitive shape cache, created from the shape parameters or from convex hull geometry.
+    void UpdateSharedShape(CollisionGeometryData* source = nullptr);
     /// Set as specified shape type using model and LOD.
     void SetModelShape(ShapeType shapeType, Model* model, unsigned lodLevel,
         const Vector3& scale, const Vector3& position, const Quaternion& rotation);
@@ -310,8 +343,10 @@ private:
     SharedPtr<Model> model_;
     /// Shared geometry data.
     SharedPtr<CollisionGeometryData> geometry_;
-    /// Bullet collision shape.
+    /// Bullet collision shape. Not owned if shared.
     UniquePtr<btCollisionShape> shape_;
+    /// Shared Bullet collision shape data.
+    SharedPtr<PrimitiveShapeData> sharedShape_;
     /// Collision shape type.
     ShapeType shapeType_;
     /// Offset position.
@@ -322,6 +357,10 @@ private:
     Vector3 size_;
     /// Cached world scale for determining if the collision shape needs update.
     Vector3 cachedWorldScale_;
+    /// Offset position the shape was added to the compound shape of the rigid body with.
+    Vector3 compoundPosition_;
+    /// Offset rotation the shape was added to the compound shape of the rigid body with.
+    Quaternion compoundRotation_;
     /// Model LOD level.
     unsigned lodLevel_;
     /// CustomGeometry component ID. 0 if not creating the convex hull / triangle mesh from a CustomGeometry.
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../Core/Object.h"
+#include "../Math/Vector3.h"
 
 namespace Urho3D
 {
@@ -41,6 +42,70 @@ URHO3D_EVENT(E_PHYSICSPOSTSTEP, PhysicsPostStep)
     URHO3D_PARAM(P_TIMESTEP, TimeStep);            // float
 }
 
+class Node;
+class PhysicsWorld;
+class RigidBody;
+
+/// Physics collision contact point. Same layout as each contact in the collision event contacts buffer.
+/// @nobind
+struct PhysicsContactPoint
+{
+    /// Contact position in world space.
+    Vector3 position_;
+    /// Contact normal in world space, pointing toward the body receiving the contact.
+    Vector3 normal_;
+    /// Contact distance, negative when penetrating.
+    float distance_;
+    /// Impulse applied by the constraint solver.
+    float impulse_;
+};
+
+/// Typed payload of the physics collision events E_PHYSICSCOLLISIONSTART, E_PHYSICSCOLLISION and E_PHYSICSCOLLISIONEND, for sending them without building event data.
+/// @nobind
+struct URHO3D_API PhysicsCollisionEventData
+{
+    /// Convert to event data.
+    void ToVariantMap(VariantMap& eventData) const;
+    /// Convert from event data.
+    void FromVariantMap(VariantMap& eventData);
+
+    /// Physics world.
+    PhysicsWorld* world_{};
+    /// First node.
+    Node* nodeA_{};
+    /// Second node.
+    Node* nodeB_{};
+    /// First rigid body.
+    RigidBody* bodyA_{};
+    /// Second rigid body.
+    RigidBody* bodyB_{};
+    /// Trigger flag.
+    bool trigger_{};
+    /// Contact points with the normals pointing toward the first body. Empty for the collision end event.
+    PODVector<PhysicsContactPoint> contacts_;
+};
+
+/// Typed payload of the node collision events E_NODECOLLISIONSTART, E_NODECOLLISION and E_NODECOLLISIONEND, for sending them without building event data.
+/// @nobind
+struct URHO3D_API NodeCollisionEventData
+{
+    /// Convert to event data.
+    void ToVariantMap(VariantMap& eventData) const;
+    /// Convert from event data.
+    void FromVariantMap(VariantMap& eventData);
+
+    /// Rigid body of the node.
+    RigidBody* body_{};
+    /// Other node.
+    Node* otherNode_{};
+    /// Other rigid body.
+    RigidBody* otherBody_{};
+    /// Trigger flag.
+    bool trigger_{};
+    /// Contact points with the normals pointing toward the node's body. Empty for the collision end event.
+    PODVector<PhysicsContactPoint> contacts_;
+};
+
 /// Physics collision started. Global event sent by the PhysicsWorld.
 URHO3D_EVENT(E_PHYSICSCOLLISIONSTART, PhysicsCollisionStart)
 {
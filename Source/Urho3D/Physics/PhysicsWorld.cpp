@@ -23,8 +23,11 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/CoreEvents.h"
 #include "../Core/Mutex.h"
 #include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Model.h"
 #include "../IO/Log.h"
@@ -38,18 +41,36 @@
 #include "../Physics/RigidBody.h"
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
+#include "../Scene/SceneStreamer.h"
 
 #include <Bullet/BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <Bullet/BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
 #include <Bullet/BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
 #include <Bullet/BulletCollision/CollisionDispatch/btInternalEdgeUtility.h>
 #include <Bullet/BulletCollision/CollisionShapes/btBoxShape.h>
+#include <Bullet/BulletCollision/CollisionShapes/btCompoundShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btSphereShape.h>
 #include <Bullet/BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h>
 #include <Bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <Bullet/BulletDynamics/ConstraintSolver/btTypedConstraint.h>
+#include <Bullet/BulletDynamics/Dynamics/btActionInterface.h>
 #include <Bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <Bullet/LinearMath/btQuickprof.h>
+#include <Bullet/LinearMath/btTransformUtil.h>
+#if BT_THREADSAFE
+#include <Bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <Bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <Bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#endif
 
 extern ContactAddedCallback gContactAddedCallback;
 
+#if BT_THREADSAFE
+// Maintained by Bullet's own task schedulers to detect nested parallel loops, but not declared in its headers
+void btPushThreadsAreRunning();
+void btPopThreadsAreRunning();
+#endif
+
 namespace Urho3D
 {
 
@@ -57,7 +78,34 @@ const char* PHYSICS_CATEGORY = "Physics";
 extern const char* SUBSYSTEM_CATEGORY;
 
 static const int MAX_SOLVER_ITERATIONS = 256;
+static const unsigned MIN_QUERIES_PER_ITEM = 16;
+static const unsigned QUERY_ITEMS_PER_THREAD = 4;
+static const unsigned MIN_VEHICLES_PER_ITEM = 8;
 static const Vector3 DEFAULT_GRAVITY = Vector3(0.0f, -9.81f, 0.0f);
+static const unsigned MAX_PROFILE_ZONE_DEPTH = 32;
+static const int STATIC_COMPOUND_USER_INDEX = 0x5354434d;
+
+/// Bullet profile zone entered on a thread.
+struct ProfileZone
+{
+    /// Zone name.
+    const char* name_;
+    /// Profiler the zone was forwarded to, or null.
+    Profiler* profiler_;
+};
+
+/// Profiler to forward the Bullet profile zones to during a step.
+static std::atomic<Profiler*> zoneProfiler{};
+/// Physics world collecting the zone times on the main thread during a step.
+static std::atomic<PhysicsWorld*> zoneStatisticsWorld{};
+/// Whether the profile zone hooks have been installed to Bullet.
+static bool zoneHooksInstalled = false;
+/// Entered Bullet profile zones of the current thread.
+static thread_local ProfileZone zoneStack[MAX_PROFILE_ZONE_DEPTH];
+/// Nesting depth of the Bullet profile zones of the current thread.
+static thread_local unsigned zoneDepth = 0;
+/// Start timers of the main thread zones.
+static HiresTimer zoneTimers[MAX_PROFILE_ZONE_DEPTH];
 
 PhysicsWorldConfig PhysicsWorld::config;
 
@@ -105,7 +153,7 @@ void RemoveCachedGeometryImpl(CollisionGeometryDataCache& cache, Model* model)
     }
 }
 
-void CleanupGeometryCacheImpl(CollisionGeometryDataCache& cache)
+template <class T> void CleanupGeometryCacheImpl(HashMap<T, SharedPtr<CollisionGeometryData> >& cache)
 {
     for (auto i = cache.Begin(); i != cache.End();)
     {
@@ -115,6 +163,267 @@ void CleanupGeometryCacheImpl(CollisionGeometryDataCache& cache)
     }
 }
 
+#if BT_THREADSAFE
+/// Range of loop indices dispatched as one Bullet task.
+struct ParallelRange
+{
+    /// Begin index.
+    int begin_;
+    /// End index (exclusive)
+    int end_;
+    /// Sum returned by a parallel sum body. Only the first range of each work item receives a value.
+    btScalar sum_;
+};
+
+/// Bullet task scheduler that executes parallel loops on the work queue, so that the physics simulation shares the worker threads with the rest of the engine instead of creating its own.
+class WorkQueueTaskScheduler : public btITaskScheduler
+{
+public:
+    /// Construct.
+    WorkQueueTaskScheduler() :
+        btITaskScheduler("WorkQueue")
+    {
+    }
+
+    /// Set the work queue to execute on. Worlds created afterward size their per-thread data by its thread count.
+    void SetWorkQueue(WorkQueue* workQueue)
+    {
+        workQueue_ = workQueue;
+        numThreads_ = (int)Min((workQueue ? workQueue->GetNumThreads() : 0) + 1, BT_MAX_THREAD_COUNT);
+    }
+
+    /// Set whether to use the worker threads. When disabled, loops are executed directly in the calling thread.
+    void SetEnabled(bool enable) { enabled_ = enable; }
+
+    /// Return the work queue.
+    WorkQueue* GetWorkQueue() const { return workQueue_; }
+
+    /// Return maximum number of threads. Includes the main thread.
+    int getMaxNumThreads() const override { return numThreads_; }
+    /// Return number of threads. Includes the main thread.
+    int getNumThreads() const override { return numThreads_; }
+    /// Set number of threads. Ignored, as the worker threads are owned by the work queue.
+    void setNumThreads(int /*numThreads*/) override {}
+
+    /// Execute a parallel loop.
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+    {
+        if (!Dispatch(iBegin, iEnd, grainSize, ParallelForWork, &body))
+            body.forLoop(iBegin, iEnd);
+    }
+
+    /// Execute a parallel loop and return the sum of its iterations.
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+    {
+        if (!Dispatch(iBegin, iEnd, grainSize, ParallelSumWork, &body))
+            return body.sumLoop(iBegin, iEnd);
+
+        btScalar sum = 0;
+        for (const ParallelRange& range : ranges_)
+            sum += range.sum_;
+        return sum;
+    }
+
+private:
+    /// Split the loop into ranges and execute them on the work queue. Return false if the loop should rather be executed directly in the calling thread.
+    bool Dispatch(int iBegin, int iEnd, int grainSize, void (*workFunction)(const WorkItem*, unsigned), const void* body)
+    {
+        // Nested loops, or loops started from a worker thread, can not wait for the work queue
+        if (!enabled_ || !workQueue_ || !workQueue_->GetNumThreads() || btThreadsAreRunning() || !Thread::IsMainThread())
+            return false;
+
+        grainSize = Max(grainSize, 1);
+        if (iEnd - iBegin <= grainSize)
+            return false;
+
+        ranges_.Clear();
+        for (int i = iBegin; i < iEnd; i += grainSize)
+            ranges_.Push({i, Min(i + grainSize, iEnd), 0});
+
+        btPushThreadsAreRunning();
+        workQueue_->ParallelFor(ranges_.Buffer(), ranges_.Buffer() + ranges_.Size(), workFunction, const_cast<void*>(body));
+        btPopThreadsAreRunning();
+        return true;
+    }
+
+    /// Work function for parallel loops. The ranges of a work item are consecutive, so the body is called only once.
+    static void ParallelForWork(const WorkItem* item, unsigned /*threadIndex*/)
+    {
+        auto* start = static_cast<ParallelRange*>(item->start_);
+        auto* end = static_cast<ParallelRange*>(item->end_);
+        static_cast<const btIParallelForBody*>(item->aux_)->forLoop(start->begin_, (end - 1)->end_);
+    }
+
+    /// Work function for parallel sums.
+    static void ParallelSumWork(const WorkItem* item, unsigned /*threadIndex*/)
+    {
+        auto* start = static_cast<ParallelRange*>(item->start_);
+        auto* end = static_cast<ParallelRange*>(item->end_);
+        start->sum_ = static_cast<const btIParallelSumBody*>(item->aux_)->sumLoop(start->begin_, (end - 1)->end_);
+    }
+
+    /// Work queue.
+    WeakPtr<WorkQueue> workQueue_;
+    /// Ranges of the loop being executed.
+    PODVector<ParallelRange> ranges_;
+    /// Number of threads including the main thread.
+    int numThreads_{1};
+    /// Use worker threads flag.
+    bool enabled_{};
+};
+
+/// Return the task scheduler shared by all physics worlds and make it current. Bullet numbers the worker threads per scheduler, so sharing one keeps the thread indices unique when several worlds are stepped.
+static WorkQueueTaskScheduler* GetTaskScheduler(WorkQueue* workQueue)
+{
+    static WorkQueueTaskScheduler scheduler;
+    if (scheduler.GetWorkQueue() != workQueue)
+        scheduler.SetWorkQueue(workQueue);
+    if (btGetTaskScheduler() != &scheduler)
+        btSetTaskScheduler(&scheduler);
+    return &scheduler;
+}
+#endif
+
+/// Static rigid bodies merged into one compound collision object.
+struct StaticCompound
+{
+    /// Construct.
+    StaticCompound() :
+        object_(new btCollisionObject()),
+        shape_(new btCompoundShape())
+    {
+        // Identify the compound in hits, as it has no rigid body user pointer
+        object_->setUserIndex(STATIC_COMPOUND_USER_INDEX);
+        object_->setCollisionShape(shape_.Get());
+        shape_->setUserPointer(this);
+    }
+
+    /// Bullet collision object.
+    UniquePtr<btCollisionObject> object_;
+    /// Bullet compound shape of the merged collision shapes.
+    UniquePtr<btCompoundShape> shape_;
+    /// Merged rigid body of each compound child.
+    PODVector<RigidBody*> childBodies_;
+    /// Merged rigid bodies.
+    PODVector<RigidBody*> bodies_;
+};
+
+/// Grouping of the rigid bodies merged into the same static compound.
+struct StaticCompoundKey
+{
+    /// Test for equality with another key.
+    bool operator ==(const StaticCompoundKey& rhs) const
+    {
+        return cell_ == rhs.cell_ && collisionLayer_ == rhs.collisionLayer_ && collisionMask_ == rhs.collisionMask_ &&
+            friction_ == rhs.friction_ && rollingFriction_ == rhs.rollingFriction_ && restitution_ == rhs.restitution_;
+    }
+
+    /// Return hash value for HashSet & HashMap.
+    unsigned ToHash() const
+    {
+        unsigned hash = cell_.ToHash();
+        hash = 37 * hash + collisionLayer_;
+        hash = 37 * hash + collisionMask_;
+        hash = 37 * hash + FloatToRawIntBits(friction_);
+        hash = 37 * hash + FloatToRawIntBits(rollingFriction_);
+        hash = 37 * hash + FloatToRawIntBits(restitution_);
+        return hash;
+    }
+
+    /// Grid cell.
+    IntVector3 cell_;
+    /// Collision layer.
+    unsigned collisionLayer_;
+    /// Collision mask.
+    unsigned collisionMask_;
+    /// Friction.
+    float friction_;
+    /// Rolling friction.
+    float rollingFriction_;
+    /// Restitution.
+    float restitution_;
+};
+
+/// Return the compound child index of a ray or sweep hit, or -1 if not known.
+static int GetHitChildIndex(const btCollisionWorld::LocalShapeInfo* shapeInfo)
+{
+    return shapeInfo ? shapeInfo->m_triangleIndex : -1;
+}
+
+/// Return the rigid body of a hit collision object. For a static compound, return the merged rigid body of the hit child.
+static RigidBody* GetHitBody(const btCollisionObject* object, int childIndex)
+{
+    auto* body = static_cast<RigidBody*>(object->getUserPointer());
+    if (!body && object->getUserIndex() == STATIC_COMPOUND_USER_INDEX)
+    {
+        auto* compound = static_cast<StaticCompound*>(object->getCollisionShape()->getUserPointer());
+        if (childIndex >= 0 && childIndex < (int)compound->childBodies_.Size())
+            body = compound->childBodies_[childIndex];
+    }
+
+    return body;
+}
+
+/// Closest hit ray callback that also records the compound child index of the hit.
+struct ClosestRayCallback : public btCollisionWorld::ClosestRayResultCallback
+{
+    /// Construct.
+    ClosestRayCallback(const btVector3& from, const btVector3& to) :
+        btCollisionWorld::ClosestRayResultCallback(from, to)
+    {
+    }
+
+    /// Add a hit. Called only for hits closer than the previous ones.
+    btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace) override
+    {
+        childIndex_ = GetHitChildIndex(rayResult.m_localShapeInfo);
+        return btCollisionWorld::ClosestRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
+    }
+
+    /// Compound child index of the hit.
+    int childIndex_{-1};
+};
+
+/// All hits ray callback that also records the compound child indices of the hits.
+struct AllHitsRayCallback : public btCollisionWorld::AllHitsRayResultCallback
+{
+    /// Construct.
+    AllHitsRayCallback(const btVector3& from, const btVector3& to) :
+        btCollisionWorld::AllHitsRayResultCallback(from, to)
+    {
+    }
+
+    /// Add a hit.
+    btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace) override
+    {
+        childIndices_.Push(GetHitChildIndex(rayResult.m_localShapeInfo));
+        return btCollisionWorld::AllHitsRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
+    }
+
+    /// Compound child indices of the hits.
+    PODVector<int> childIndices_;
+};
+
+/// Closest hit sweep callback that also records the compound child index of the hit.
+struct ClosestConvexCallback : public btCollisionWorld::ClosestConvexResultCallback
+{
+    /// Construct.
+    ClosestConvexCallback(const btVector3& from, const btVector3& to) :
+        btCollisionWorld::ClosestConvexResultCallback(from, to)
+    {
+    }
+
+    /// Add a hit. Called only for hits closer than the previous ones.
+    btScalar addSingleResult(btCollisionWorld::LocalConvexResult& convexResult, bool normalInWorldSpace) override
+    {
+        childIndex_ = GetHitChildIndex(convexResult.m_localShapeInfo);
+        return btCollisionWorld::ClosestConvexResultCallback::addSingleResult(convexResult, normalInWorldSpace);
+    }
+
+    /// Compound child index of the hit.
+    int childIndex_{-1};
+};
+
 /// Callback for physics world queries.
 struct PhysicsQueryCallback : public btCollisionWorld::ContactResultCallback
 {
@@ -126,13 +435,13 @@ struct PhysicsQueryCallback : public btCollisionWorld::ContactResultCallback
     }
 
     /// Add a contact result.
-    btScalar addSingleResult(btManifoldPoint&, const btCollisionObjectWrapper* colObj0Wrap, int, int,
-        const btCollisionObjectWrapper* colObj1Wrap, int, int) override
+    btScalar addSingleResult(btManifoldPoint&, const btCollisionObjectWrapper* colObj0Wrap, int, int index0,
+        const btCollisionObjectWrapper* colObj1Wrap, int, int index1) override
     {
-        auto* body = reinterpret_cast<RigidBody*>(colObj0Wrap->getCollisionObject()->getUserPointer());
+        RigidBody* body = GetHitBody(colObj0Wrap->getCollisionObject(), index0);
         if (body && !result_.Contains(body) && (body->GetCollisionLayer() & collisionMask_))
             result_.Push(body);
-        body = reinterpret_cast<RigidBody*>(colObj1Wrap->getCollisionObject()->getUserPointer());
+        body = GetHitBody(colObj1Wrap->getCollisionObject(), index1);
         if (body && !result_.Contains(body) && (body->GetCollisionLayer() & collisionMask_))
             result_.Push(body);
         return 0.0f;
@@ -144,6 +453,211 @@ struct PhysicsQueryCallback : public btCollisionWorld::ContactResultCallback
     unsigned collisionMask_;
 };
 
+/// Calls the ray or sweep callback for the broadphase leaves.
+struct QueryBroadphaseTester : public btDbvt::ICollide
+{
+    /// Construct.
+    explicit QueryBroadphaseTester(btBroadphaseRayCallback& callback) :
+        callback_(callback)
+    {
+    }
+
+    /// Process a leaf.
+    void Process(const btDbvtNode* leaf)
+    {
+        callback_.process(static_cast<btDbvtProxy*>(leaf->data));
+    }
+
+    /// Ray or sweep callback.
+    btBroadphaseRayCallback& callback_;
+};
+
+/// Broadphase callback base for batch queries. The broadphase ray test of btDbvtBroadphase shares one traversal stack unless Bullet is built with BT_THREADSAFE, so batch queries traverse the trees with their own stack instead.
+struct QueryBroadphaseCallback : public btBroadphaseRayCallback
+{
+    /// Construct with the ray or sweep segment.
+    QueryBroadphaseCallback(const btVector3& from, const btVector3& to)
+    {
+        btVector3 segment = to - from;
+        btVector3 direction = segment.fuzzyZero() ? btVector3(1.0f, 0.0f, 0.0f) : segment.normalized();
+        for (int i = 0; i < 3; ++i)
+        {
+            m_rayDirectionInverse[i] = direction[i] == 0.0f ? BT_LARGE_FLOAT : 1.0f / direction[i];
+            m_signs[i] = m_rayDirectionInverse[i] < 0.0f;
+        }
+        m_lambda_max = direction.dot(segment);
+    }
+
+    /// Traverse the broadphase trees along the segment, with the bounds expanded by the swept shape's bounds.
+    void Traverse(btDbvtBroadphase* broadphase, const btVector3& from, const btVector3& to, const btVector3& aabbMin,
+        const btVector3& aabbMax, btAlignedObjectArray<const btDbvtNode*>& stack)
+    {
+        QueryBroadphaseTester tester(*this);
+        for (btDbvt& tree : broadphase->m_sets)
+        {
+            tree.rayTestInternal(tree.m_root, from, to, m_rayDirectionInverse, m_signs, m_lambda_max, aabbMin, aabbMax,
+                stack, tester);
+        }
+    }
+};
+
+/// Broadphase callback testing a ray against the overlapped collision objects.
+struct QueryRayCallback : public QueryBroadphaseCallback
+{
+    /// Construct.
+    QueryRayCallback(const btVector3& from, const btVector3& to, btCollisionWorld::RayResultCallback& result) :
+        QueryBroadphaseCallback(from, to),
+        from_(btQuaternion::getIdentity(), from),
+        to_(btQuaternion::getIdentity(), to),
+        result_(result)
+    {
+    }
+
+    /// Test the ray against a collision object. Return false to terminate when a hit at the ray start has been found.
+    bool process(const btBroadphaseProxy* proxy) override
+    {
+        if (result_.m_closestHitFraction == 0.0f)
+            return false;
+
+        auto* object = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        if (result_.needsCollision(object->getBroadphaseHandle()))
+            btCollisionWorld::rayTestSingle(from_, to_, object, object->getCollisionShape(), object->getWorldTransform(), result_);
+        return true;
+    }
+
+    /// Ray start transform.
+    btTransform from_;
+    /// Ray end transform.
+    btTransform to_;
+    /// Result callback.
+    btCollisionWorld::RayResultCallback& result_;
+};
+
+/// Closest hit sweep result callback that excludes the swept shape's own collision object.
+struct QueryConvexResultCallback : public ClosestConvexCallback
+{
+    /// Construct.
+    QueryConvexResultCallback(const btVector3& from, const btVector3& to, const btCollisionObject* ignore) :
+        ClosestConvexCallback(from, to),
+        ignore_(ignore)
+    {
+    }
+
+    /// Return whether to test against a broadphase proxy.
+    bool needsCollision(btBroadphaseProxy* proxy) const override
+    {
+        return proxy->m_clientObject != ignore_ && btCollisionWorld::ClosestConvexResultCallback::needsCollision(proxy);
+    }
+
+    /// Collision object to exclude.
+    const btCollisionObject* ignore_;
+};
+
+/// Broadphase callback sweeping a convex shape against the overlapped collision objects.
+struct QuerySweepCallback : public QueryBroadphaseCallback
+{
+    /// Construct.
+    QuerySweepCallback(const btConvexShape* shape, const btTransform& from, const btTransform& to,
+        btCollisionWorld::ConvexResultCallback& result) :
+        QueryBroadphaseCallback(from.getOrigin(), to.getOrigin()),
+        shape_(shape),
+        from_(from),
+        to_(to),
+        result_(result)
+    {
+    }
+
+    /// Sweep against a collision object. Return false to terminate when a hit at the sweep start has been found.
+    bool process(const btBroadphaseProxy* proxy) override
+    {
+        if (result_.m_closestHitFraction == 0.0f)
+            return false;
+
+        auto* object = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        if (result_.needsCollision(object->getBroadphaseHandle()))
+        {
+            btCollisionWorld::objectQuerySingle(shape_, from_, to_, object, object->getCollisionShape(),
+                object->getWorldTransform(), result_, 0.0f);
+        }
+        return true;
+    }
+
+    /// Swept shape.
+    const btConvexShape* shape_;
+    /// Sweep start transform.
+    btTransform from_;
+    /// Sweep end transform.
+    btTransform to_;
+    /// Result callback.
+    btCollisionWorld::ConvexResultCallback& result_;
+};
+
+static void AppendContactPoints(PODVector<PhysicsContactPoint>& dest, btPersistentManifold* manifold, bool flipNormals)
+{
+    if (!manifold)
+        return;
+
+    for (int i = 0; i < manifold->getNumContacts(); ++i)
+    {
+        const btManifoldPoint& point = manifold->getContactPoint(i);
+        PhysicsContactPoint contact;
+        contact.position_ = ToVector3(point.m_positionWorldOnB);
+        contact.normal_ = flipNormals ? -ToVector3(point.m_normalWorldOnB) : ToVector3(point.m_normalWorldOnB);
+        contact.distance_ = point.m_distance1;
+        contact.impulse_ = point.m_appliedImpulse;
+        dest.Push(contact);
+    }
+}
+
+/// Bullet action running the batched update of all raycast vehicles of a physics world.
+class RaycastVehicleAction : public btActionInterface
+{
+public:
+    /// Construct.
+    explicit RaycastVehicleAction(PhysicsWorld* world) :
+        world_(world)
+    {
+    }
+
+    /// Update the vehicles.
+    void updateAction(btCollisionWorld* collisionWorld, btScalar deltaTimeStep) override
+    {
+        world_->UpdateRaycastVehicles(deltaTimeStep);
+    }
+
+    /// Debug draw. The vehicles are not drawn.
+    void debugDraw(btIDebugDraw* debugDrawer) override
+    {
+    }
+
+private:
+    /// Physics world.
+    PhysicsWorld* world_;
+};
+
+static void SetNoHit(PhysicsRaycastResult& result)
+{
+    result.body_ = nullptr;
+    result.position_ = Vector3::ZERO;
+    result.normal_ = Vector3::ZERO;
+    result.distance_ = M_INFINITY;
+    result.hitFraction_ = 0.0f;
+}
+
+bool PhysicsQueryBatch::IsCompleted() const
+{
+    if (!started_)
+        return false;
+
+    for (const SharedPtr<WorkItem>& item : items_)
+    {
+        if (!item->completed_)
+            return false;
+    }
+
+    return true;
+}
+
 PhysicsWorld::PhysicsWorld(Context* context) :
     Component(context),
     fps_(DEFAULT_FPS),
@@ -156,12 +670,26 @@ PhysicsWorld::PhysicsWorld(Context* context) :
     else
         collisionConfiguration_ = new btDefaultCollisionConfiguration();
 
+#if BT_THREADSAFE
+    // The multithreaded world and dispatcher size their per-thread data from the current task scheduler on construction
+    WorkQueueTaskScheduler* scheduler = GetTaskScheduler(GetSubsystem<WorkQueue>());
+
+    collisionDispatcher_ = new btCollisionDispatcherMt(collisionConfiguration_);
+    btGImpactCollisionAlgorithm::registerAlgorithm(static_cast<btCollisionDispatcher*>(collisionDispatcher_.Get()));
+
+    broadphase_ = new btDbvtBroadphase();
+    solver_ = new btConstraintSolverPoolMt(scheduler->getNumThreads());
+    solverMt_ = new btSequentialImpulseConstraintSolverMt();
+    world_ = new btDiscreteDynamicsWorldMt(collisionDispatcher_.Get(), broadphase_.Get(),
+        static_cast<btConstraintSolverPoolMt*>(solver_.Get()), solverMt_.Get(), collisionConfiguration_);
+#else
     collisionDispatcher_ = new btCollisionDispatcher(collisionConfiguration_);
     btGImpactCollisionAlgorithm::registerAlgorithm(static_cast<btCollisionDispatcher*>(collisionDispatcher_.Get()));
 
     broadphase_ = new btDbvtBroadphase();
     solver_ = new btSequentialImpulseConstraintSolver();
     world_ = new btDiscreteDynamicsWorld(collisionDispatcher_.Get(), broadphase_.Get(), solver_.Get(), collisionConfiguration_);
+#endif
 
     world_->setGravity(ToBtVector3(DEFAULT_GRAVITY));
     world_->getDispatchInfo().m_useContinuous = true;
@@ -174,6 +702,9 @@ PhysicsWorld::PhysicsWorld(Context* context) :
 
 PhysicsWorld::~PhysicsWorld()
 {
+    CompleteQueries();
+    ClearStaticCompounds();
+
     if (scene_)
     {
         // Force all remaining constraints, rigid bodies and collision shapes to release themselves
@@ -187,7 +718,11 @@ PhysicsWorld::~PhysicsWorld()
             (*i)->ReleaseShape();
     }
 
+    if (vehicleAction_)
+        world_->removeAction(vehicleAction_.Get());
+
     world_.Reset();
+    solverMt_.Reset();
     solver_.Reset();
     broadphase_.Reset();
     collisionDispatcher_.Reset();
@@ -208,8 +743,12 @@ void PhysicsWorld::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Solver Iterations", GetNumIterations, SetNumIterations, int, 10, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Net Max Angular Vel.", float, maxNetworkAngularVelocity_, DEFAULT_MAX_NETWORK_ANGULAR_VELOCITY, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Interpolation", bool, interpolation_, true, AM_FILE);
+    URHO3D_ATTRIBUTE("Snapshot Interpolation", bool, snapshotInterpolation_, false, AM_FILE);
     URHO3D_ATTRIBUTE("Internal Edge Utility", bool, internalEdge_, true, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Split Impulse", GetSplitImpulse, SetSplitImpulse, bool, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Multithreaded", bool, multithreaded_, false, AM_FILE);
+    URHO3D_ACCESSOR_ATTRIBUTE("Stream Out Distance", GetStreamOutDistance, SetStreamOutDistance, float, 0.0f, AM_FILE);
+    URHO3D_ACCESSOR_ATTRIBUTE("Stream In Distance", GetStreamInDistance, SetStreamInDistance, float, 0.0f, AM_FILE);
 }
 
 bool PhysicsWorld::isVisible(const btVector3& aabbMin, const btVector3& aabbMax)
@@ -267,16 +806,27 @@ void PhysicsWorld::Update(float timeStep)
     else if (maxSubSteps_ > 0)
         maxSubSteps = Min(maxSubSteps, maxSubSteps_);
 
+    // Pending query batches read the broadphase, so complete them before modifying it
+    CompleteQueries();
+
     delayedWorldTransforms_.Clear();
+    contactPairs_.Clear();
+    contactPoints_.Clear();
+    if (statisticsEnabled_)
+        statistics_ = PhysicsStatistics();
+    ActivateTaskScheduler();
+    ActivateProfileZones();
     simulating_ = true;
 
-    if (interpolation_)
+    bool snapshotInterpolation = IsSnapshotInterpolating();
+    if (interpolation_ && !snapshotInterpolation)
         world_->stepSimulation(timeStep, maxSubSteps, internalTimeStep);
     else
     {
         timeAcc_ += timeStep;
         while (timeAcc_ >= internalTimeStep && maxSubSteps > 0)
         {
+            ++snapshotStep_;
             world_->stepSimulation(internalTimeStep, 0, internalTimeStep);
             timeAcc_ -= internalTimeStep;
             --maxSubSteps;
@@ -284,6 +834,15 @@ void PhysicsWorld::Update(float timeStep)
     }
 
     simulating_ = false;
+    zoneProfiler.store(nullptr, std::memory_order_relaxed);
+    zoneStatisticsWorld.store(nullptr, std::memory_order_relaxed);
+
+    // Interpolate the bodies that moved in the latest step between their last two snapshots by the time left over in the
+    // accumulator. If the mode was just turned off, place them at their last snapshot
+    if (snapshotInterpolation)
+        UpdateSnapshotInterpolation(Min(timeAcc_ * fps_, 1.0f), snapshotStep_);
+    else if (!interpolatedBodies_.Empty())
+        UpdateSnapshotInterpolation(1.0f, snapshotStep_ + 1);
 
     // Apply delayed (parented) world transforms now
     while (!delayedWorldTransforms_.Empty())
@@ -303,10 +862,124 @@ void PhysicsWorld::Update(float timeStep)
                 ++i;
         }
     }
+
+    UpdateStreaming();
+
+    // Start the query batches submitted during the step now that the world is no longer modified
+    for (const SharedPtr<PhysicsQueryBatch>& batch : queryBatches_)
+    {
+        if (!batch->started_)
+            StartQueries(batch);
+    }
+}
+
+void PhysicsWorld::UpdateSnapshotInterpolation(float t, unsigned step)
+{
+    for (unsigned i = 0; i < interpolatedBodies_.Size();)
+    {
+        if (interpolatedBodies_[i]->ApplySnapshotInterpolation(t, step))
+            ++i;
+        else
+            interpolatedBodies_.EraseSwap(i);
+    }
+}
+
+void PhysicsWorld::UpdateStreaming()
+{
+    if (streamOutDistance_ <= 0.0f)
+        return;
+
+    URHO3D_PROFILE(UpdatePhysicsStreaming);
+
+    Vector3 focus = GetStreamingFocus();
+    float streamInDistance = GetEffectiveStreamInDistance();
+    if (streamingCellSize_ != streamInDistance)
+        RebuildStreamingCells();
+
+    PODVector<RigidBody*> bodies;
+
+    // Add back the streamed out bodies within the stream in distance. As the grid cell size equals the distance, only the
+    // cells neighbouring the focus cell need to be checked
+    if (!streamedOutBodies_.Empty())
+    {
+        IntVector3 focusCell = GetStreamingCell(focus);
+        float streamInDistanceSquared = streamInDistance * streamInDistance;
+
+        for (int z = focusCell.z_ - 1; z <= focusCell.z_ + 1; ++z)
+        {
+            for (int y = focusCell.y_ - 1; y <= focusCell.y_ + 1; ++y)
+            {
+                for (int x = focusCell.x_ - 1; x <= focusCell.x_ + 1; ++x)
+                {
+                    HashMap<IntVector3, PODVector<RigidBody*> >::ConstIterator i = streamedOutCells_.Find(IntVector3(x, y, z));
+                    if (i == streamedOutCells_.End())
+                        continue;
+
+                    for (RigidBody* body : i->second_)
+                    {
+                        if ((body->GetPosition() - focus).LengthSquared() < streamInDistanceSquared)
+                            bodies.Push(body);
+                    }
+                }
+            }
+        }
+
+        for (RigidBody* body : bodies)
+            StreamInBody(body);
+    }
+
+    // Remove the sleeping bodies beyond the stream out distance. Only the bodies in the Bullet world need to be checked, so
+    // this does not grow with the number of streamed out bodies
+    bodies.Clear();
+    float streamOutDistanceSquared = streamOutDistance_ * streamOutDistance_;
+    const btCollisionObjectArray& objects = world_->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); ++i)
+    {
+        btRigidBody* object = btRigidBody::upcast(objects[i]);
+        if (!object || object->getActivationState() != ISLAND_SLEEPING)
+            continue;
+
+        auto* body = static_cast<RigidBody*>(object->getUserPointer());
+        if (body && body->CanStreamOut() && (body->GetPosition() - focus).LengthSquared() > streamOutDistanceSquared)
+            bodies.Push(body);
+    }
+
+    for (RigidBody* body : bodies)
+    {
+        IntVector3 cell = GetStreamingCell(body->GetPosition());
+        body->SetStreamedOut(true);
+        streamedOutCells_[cell].Push(body);
+        streamedOutBodies_[body] = cell;
+    }
+}
+
+float PhysicsWorld::GetEffectiveStreamInDistance() const
+{
+    return streamInDistance_ > 0.0f ? Min(streamInDistance_, streamOutDistance_) : streamOutDistance_;
+}
+
+IntVector3 PhysicsWorld::GetStreamingCell(const Vector3& position) const
+{
+    return IntVector3(FloorToInt(position.x_ / streamingCellSize_), FloorToInt(position.y_ / streamingCellSize_),
+        FloorToInt(position.z_ / streamingCellSize_));
+}
+
+void PhysicsWorld::RebuildStreamingCells()
+{
+    streamingCellSize_ = GetEffectiveStreamInDistance();
+    streamedOutCells_.Clear();
+
+    for (HashMap<RigidBody*, IntVector3>::Iterator i = streamedOutBodies_.Begin(); i != streamedOutBodies_.End(); ++i)
+    {
+        i->second_ = GetStreamingCell(i->first_->GetPosition());
+        streamedOutCells_[i->second_].Push(i->first_);
+    }
 }
 
 void PhysicsWorld::UpdateCollisions()
 {
+    CompleteQueries();
+    ActivateTaskScheduler();
     world_->performDiscreteCollisionDetection();
 }
 
@@ -348,6 +1021,144 @@ void PhysicsWorld::SetInterpolation(bool enable)
     interpolation_ = enable;
 }
 
+void PhysicsWorld::SetSaveGeometryCache(bool enable)
+{
+    saveGeometryCache_ = enable;
+}
+
+void PhysicsWorld::SetStatisticsEnabled(bool enable)
+{
+    if (enable == statisticsEnabled_)
+        return;
+
+    statisticsEnabled_ = enable;
+    statistics_ = PhysicsStatistics();
+    narrowphaseTests_.store(0, std::memory_order_relaxed);
+
+    // Count the narrowphase tests only when needed, as the callback is invoked for each overlapping pair
+    auto* dispatcher = static_cast<btCollisionDispatcher*>(collisionDispatcher_.Get());
+    dispatcher->setNearCallback(enable ? NarrowphaseNearCallback : btCollisionDispatcher::defaultNearCallback);
+}
+
+void PhysicsWorld::SetSnapshotInterpolation(bool enable)
+{
+    snapshotInterpolation_ = enable;
+}
+
+void PhysicsWorld::SetStreamOutDistance(float distance)
+{
+    streamOutDistance_ = Max(distance, 0.0f);
+    if (streamOutDistance_ == 0.0f)
+        StreamInAllBodies();
+}
+
+void PhysicsWorld::SetStreamInDistance(float distance)
+{
+    streamInDistance_ = Max(distance, 0.0f);
+}
+
+void PhysicsWorld::SetStreamingFocusNode(Node* node)
+{
+    streamingFocusNode_ = node;
+}
+
+void PhysicsWorld::SetStreamingFocusPosition(const Vector3& position)
+{
+    streamingFocusPosition_ = position;
+}
+
+void PhysicsWorld::StreamInAllBodies()
+{
+    while (!streamedOutBodies_.Empty())
+        StreamInBody(streamedOutBodies_.Begin()->first_);
+}
+
+void PhysicsWorld::BuildStaticCompounds(float cellSize)
+{
+    URHO3D_PROFILE(BuildStaticCompounds);
+
+    ClearStaticCompounds();
+
+    if (cellSize <= 0.0f)
+    {
+        URHO3D_LOGERROR("Static compound cell size must be positive");
+        return;
+    }
+
+    HashMap<StaticCompoundKey, PODVector<RigidBody*> > groups;
+    for (RigidBody* body : rigidBodies_)
+    {
+        if (!body->CanMergeStatic())
+            continue;
+
+        btRigidBody* object = body->GetBody();
+        Vector3 position = body->GetPosition() / cellSize;
+        StaticCompoundKey key;
+        key.cell_ = IntVector3(FloorToInt(position.x_), FloorToInt(position.y_), FloorToInt(position.z_));
+        key.collisionLayer_ = body->GetCollisionLayer();
+        key.collisionMask_ = body->GetCollisionMask();
+        key.friction_ = object->getFriction();
+        key.rollingFriction_ = object->getRollingFriction();
+        key.restitution_ = object->getRestitution();
+        groups[key].Push(body);
+    }
+
+    for (HashMap<StaticCompoundKey, PODVector<RigidBody*> >::ConstIterator i = groups.Begin(); i != groups.End(); ++i)
+    {
+        const PODVector<RigidBody*>& bodies = i->second_;
+        // Merging a single body would not save a broadphase proxy
+        if (bodies.Size() < 2)
+            continue;
+
+        auto* compound = new StaticCompound();
+        for (RigidBody* body : bodies)
+        {
+            btRigidBody* object = body->GetBody();
+            const btTransform& transform = object->getWorldTransform();
+            btCollisionShape* shape = object->getCollisionShape();
+
+            // Flatten the body's own compound so that each child index maps to one body
+            if (shape->isCompound())
+            {
+                auto* bodyCompound = static_cast<btCompoundShape*>(shape);
+                for (int j = 0; j < bodyCompound->getNumChildShapes(); ++j)
+                {
+                    compound->shape_->addChildShape(transform * bodyCompound->getChildTransform(j), bodyCompound->getChildShape(j));
+                    compound->childBodies_.Push(body);
+                }
+            }
+            else
+            {
+                compound->shape_->addChildShape(transform, shape);
+                compound->childBodies_.Push(body);
+            }
+
+            compound->bodies_.Push(body);
+        }
+
+        btCollisionObject* object = compound->object_.Get();
+        btRigidBody* first = bodies.Front()->GetBody();
+        object->setFriction(first->getFriction());
+        object->setRollingFriction(first->getRollingFriction());
+        object->setRestitution(first->getRestitution());
+        object->setCollisionFlags(first->getCollisionFlags());
+        world_->addCollisionObject(object, (short)i->first_.collisionLayer_, (short)i->first_.collisionMask_);
+
+        staticCompounds_.Push(compound);
+        for (RigidBody* body : bodies)
+        {
+            staticCompoundBodies_[body] = compound;
+            body->SetStaticMerged(true);
+        }
+    }
+}
+
+void PhysicsWorld::ClearStaticCompounds()
+{
+    while (!staticCompounds_.Empty())
+        DissolveStaticCompound(staticCompounds_.Back());
+}
+
 void PhysicsWorld::SetInternalEdge(bool enable)
 {
     internalEdge_ = enable;
@@ -362,6 +1173,16 @@ void PhysicsWorld::SetSplitImpulse(bool enable)
     MarkNetworkUpdate();
 }
 
+void PhysicsWorld::SetMultithreaded(bool enable)
+{
+#if !BT_THREADSAFE
+    if (enable)
+        URHO3D_LOGWARNING("Multithreaded physics is not available, the engine was built without URHO3D_PHYSICS_THREADED");
+#endif
+
+    multithreaded_ = enable;
+}
+
 void PhysicsWorld::SetMaxNetworkAngularVelocity(float velocity)
 {
     maxNetworkAngularVelocity_ = Clamp(velocity, 1.0f, 32767.0f);
@@ -376,8 +1197,7 @@ void PhysicsWorld::Raycast(PODVector<PhysicsRaycastResult>& result, const Ray& r
     if (maxDistance >= M_INFINITY)
         URHO3D_LOGWARNING("Infinite maxDistance in physics raycast is not supported");
 
-    btCollisionWorld::AllHitsRayResultCallback
-        rayCallback(ToBtVector3(ray.origin_), ToBtVector3(ray.origin_ + maxDistance * ray.direction_));
+    AllHitsRayCallback rayCallback(ToBtVector3(ray.origin_), ToBtVector3(ray.origin_ + maxDistance * ray.direction_));
     rayCallback.m_collisionFilterGroup = (short)0xffff;
     rayCallback.m_collisionFilterMask = (short)collisionMask;
 
@@ -386,7 +1206,7 @@ void PhysicsWorld::Raycast(PODVector<PhysicsRaycastResult>& result, const Ray& r
     for (int i = 0; i < rayCallback.m_collisionObjects.size(); ++i)
     {
         PhysicsRaycastResult newResult;
-        newResult.body_ = static_cast<RigidBody*>(rayCallback.m_collisionObjects[i]->getUserPointer());
+        newResult.body_ = GetHitBody(rayCallback.m_collisionObjects[i], rayCallback.childIndices_[i]);
         newResult.position_ = ToVector3(rayCallback.m_hitPointWorld[i]);
         newResult.normal_ = ToVector3(rayCallback.m_hitNormalWorld[i]);
         newResult.distance_ = (newResult.position_ - ray.origin_).Length();
@@ -404,8 +1224,7 @@ void PhysicsWorld::RaycastSingle(PhysicsRaycastResult& result, const Ray& ray, f
     if (maxDistance >= M_INFINITY)
         URHO3D_LOGWARNING("Infinite maxDistance in physics raycast is not supported");
 
-    btCollisionWorld::ClosestRayResultCallback
-        rayCallback(ToBtVector3(ray.origin_), ToBtVector3(ray.origin_ + maxDistance * ray.direction_));
+    ClosestRayCallback rayCallback(ToBtVector3(ray.origin_), ToBtVector3(ray.origin_ + maxDistance * ray.direction_));
     rayCallback.m_collisionFilterGroup = (short)0xffff;
     rayCallback.m_collisionFilterMask = (short)collisionMask;
 
@@ -417,7 +1236,7 @@ void PhysicsWorld::RaycastSingle(PhysicsRaycastResult& result, const Ray& ray, f
         result.normal_ = ToVector3(rayCallback.m_hitNormalWorld);
         result.distance_ = (result.position_ - ray.origin_).Length();
         result.hitFraction_ = rayCallback.m_closestHitFraction;
-        result.body_ = static_cast<RigidBody*>(rayCallback.m_collisionObject->getUserPointer());
+        result.body_ = GetHitBody(rayCallback.m_collisionObject, rayCallback.childIndex_);
     }
     else
     {
@@ -451,7 +1270,7 @@ void PhysicsWorld::RaycastSingleSegmented(PhysicsRaycastResult& result, const Ra
         const float distance = Min(remainingDistance, segmentDistance); // The last segment may be shorter
         const btVector3 end = start + distance * direction;
 
-        btCollisionWorld::ClosestRayResultCallback rayCallback(start, end);
+        ClosestRayCallback rayCallback(start, end);
         rayCallback.m_collisionFilterGroup = (short)0xffff;
         rayCallback.m_collisionFilterMask = (short)collisionMask;
 
@@ -463,7 +1282,7 @@ void PhysicsWorld::RaycastSingleSegmented(PhysicsRaycastResult& result, const Ra
             result.normal_ = ToVector3(rayCallback.m_hitNormalWorld);
             result.distance_ = (result.position_ - ray.origin_).Length();
             result.hitFraction_ = rayCallback.m_closestHitFraction;
-            result.body_ = static_cast<RigidBody*>(rayCallback.m_collisionObject->getUserPointer());
+            result.body_ = GetHitBody(rayCallback.m_collisionObject, rayCallback.childIndex_);
             // No need to cast the rest of the segments
             return;
         }
@@ -491,8 +1310,7 @@ void PhysicsWorld::SphereCast(PhysicsRaycastResult& result, const Ray& ray, floa
     btSphereShape shape(radius);
     Vector3 endPos = ray.origin_ + maxDistance * ray.direction_;
 
-    btCollisionWorld::ClosestConvexResultCallback
-        convexCallback(ToBtVector3(ray.origin_), ToBtVector3(endPos));
+    ClosestConvexCallback convexCallback(ToBtVector3(ray.origin_), ToBtVector3(endPos));
     convexCallback.m_collisionFilterGroup = (short)0xffff;
     convexCallback.m_collisionFilterMask = (short)collisionMask;
 
@@ -501,7 +1319,7 @@ void PhysicsWorld::SphereCast(PhysicsRaycastResult& result, const Ray& ray, floa
 
     if (convexCallback.hasHit())
     {
-        result.body_ = static_cast<RigidBody*>(convexCallback.m_hitCollisionObject->getUserPointer());
+        result.body_ = GetHitBody(convexCallback.m_hitCollisionObject, convexCallback.childIndex_);
         result.position_ = ToVector3(convexCallback.m_hitPointWorld);
         result.normal_ = ToVector3(convexCallback.m_hitNormalWorld);
         result.distance_ = convexCallback.m_closestHitFraction * (endPos - ray.origin_).Length();
@@ -581,34 +1399,112 @@ void PhysicsWorld::ConvexCast(PhysicsRaycastResult& result, btCollisionShape* sh
         result.distance_ = M_INFINITY;
         result.hitFraction_ = 0.0f;
         return;
-    }
+    }
+
+    URHO3D_PROFILE(PhysicsConvexCast);
+
+    ClosestConvexCallback convexCallback(ToBtVector3(startPos), ToBtVector3(endPos));
+    convexCallback.m_collisionFilterGroup = (short)0xffff;
+    convexCallback.m_collisionFilterMask = (short)collisionMask;
+
+    world_->convexSweepTest(static_cast<btConvexShape*>(shape), btTransform(ToBtQuaternion(startRot),
+            convexCallback.m_convexFromWorld), btTransform(ToBtQuaternion(endRot), convexCallback.m_convexToWorld),
+        convexCallback);
+
+    if (convexCallback.hasHit())
+    {
+        result.body_ = GetHitBody(convexCallback.m_hitCollisionObject, convexCallback.childIndex_);
+        result.position_ = ToVector3(convexCallback.m_hitPointWorld);
+        result.normal_ = ToVector3(convexCallback.m_hitNormalWorld);
+        result.distance_ = convexCallback.m_closestHitFraction * (endPos - startPos).Length();
+        result.hitFraction_ = convexCallback.m_closestHitFraction;
+    }
+    else
+    {
+        result.body_ = nullptr;
+        result.position_ = Vector3::ZERO;
+        result.normal_ = Vector3::ZERO;
+        result.distance_ = M_INFINITY;
+        result.hitFraction_ = 0.0f;
+    }
+}
+
+void PhysicsWorld::SubmitQueries(PhysicsQueryBatch* batch)
+{
+    if (!batch)
+        return;
+
+    if (batch->pending_)
+    {
+        URHO3D_LOGERROR("Physics query batch is already pending");
+        return;
+    }
+
+    if (queryBatches_.Empty())
+        SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(PhysicsWorld, HandleBeginFrame));
+
+    batch->pending_ = true;
+    batch->started_ = false;
+    queryBatches_.Push(SharedPtr<PhysicsQueryBatch>(batch));
+
+    // The broadphase is being updated during the step, so start only after it
+    if (!simulating_)
+        StartQueries(batch);
+}
+
+void PhysicsWorld::ExecuteQueries(PhysicsQueryBatch* batch)
+{
+    if (!batch)
+        return;
 
-    URHO3D_PROFILE(PhysicsConvexCast);
+    if (batch->pending_)
+    {
+        URHO3D_LOGERROR("Can not execute a pending physics query batch");
+        return;
+    }
 
-    btCollisionWorld::ClosestConvexResultCallback convexCallback(ToBtVector3(startPos), ToBtVector3(endPos));
-    convexCallback.m_collisionFilterGroup = (short)0xffff;
-    convexCallback.m_collisionFilterMask = (short)collisionMask;
+    URHO3D_PROFILE(ExecutePhysicsQueries);
 
-    world_->convexSweepTest(static_cast<btConvexShape*>(shape), btTransform(ToBtQuaternion(startRot),
-            convexCallback.m_convexFromWorld), btTransform(ToBtQuaternion(endRot), convexCallback.m_convexToWorld),
-        convexCallback);
+    StartQueries(batch);
 
-    if (convexCallback.hasHit())
+    auto* queue = GetSubsystem<WorkQueue>();
+    for (const SharedPtr<WorkItem>& item : batch->items_)
     {
-        result.body_ = static_cast<RigidBody*>(convexCallback.m_hitCollisionObject->getUserPointer());
-        result.position_ = ToVector3(convexCallback.m_hitPointWorld);
-        result.normal_ = ToVector3(convexCallback.m_hitNormalWorld);
-        result.distance_ = convexCallback.m_closestHitFraction * (endPos - startPos).Length();
-        result.hitFraction_ = convexCallback.m_closestHitFraction;
+        if (queue)
+            queue->Wait(item);
+        else
+            item->workFunction_(item, 0);
     }
-    else
+    batch->items_.Clear();
+}
+
+void PhysicsWorld::CompleteQueries()
+{
+    if (queryBatches_.Empty())
+        return;
+
+    URHO3D_PROFILE(CompletePhysicsQueries);
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    for (const SharedPtr<PhysicsQueryBatch>& batch : queryBatches_)
     {
-        result.body_ = nullptr;
-        result.position_ = Vector3::ZERO;
-        result.normal_ = Vector3::ZERO;
-        result.distance_ = M_INFINITY;
-        result.hitFraction_ = 0.0f;
+        if (!batch->started_)
+            StartQueries(batch);
+
+        for (const SharedPtr<WorkItem>& item : batch->items_)
+        {
+            if (queue)
+                queue->Wait(item);
+            else
+                item->workFunction_(item, 0);
+        }
+
+        batch->items_.Clear();
+        batch->pending_ = false;
     }
+
+    queryBatches_.Clear();
+    UnsubscribeFromEvent(E_BEGINFRAME);
 }
 
 void PhysicsWorld::RemoveCachedGeometry(Model* model)
@@ -715,6 +1611,26 @@ bool PhysicsWorld::GetSplitImpulse() const
     return world_->getSolverInfo().m_splitImpulse != 0;
 }
 
+Node* PhysicsWorld::GetStreamingFocusNode() const
+{
+    return streamingFocusNode_;
+}
+
+Vector3 PhysicsWorld::GetStreamingFocus() const
+{
+    if (streamingFocusNode_)
+        return streamingFocusNode_->GetWorldPosition();
+
+    if (scene_)
+    {
+        auto* streamer = scene_->GetComponent<SceneStreamer>();
+        if (streamer)
+            return streamer->GetFocusPosition();
+    }
+
+    return streamingFocusPosition_;
+}
+
 void PhysicsWorld::AddRigidBody(RigidBody* body)
 {
     rigidBodies_.Push(body);
@@ -723,8 +1639,26 @@ void PhysicsWorld::AddRigidBody(RigidBody* body)
 void PhysicsWorld::RemoveRigidBody(RigidBody* body)
 {
     rigidBodies_.Remove(body);
+    interpolatedBodies_.Remove(body);
+    RemoveStreamedOutBody(body);
+    RemoveStaticCompoundBody(body);
     // Remove possible dangling pointer from the delayedWorldTransforms structure
     delayedWorldTransforms_.Erase(body);
+    // Also from the reported contact pairs
+    for (PhysicsContactPair& pair : contactPairs_)
+    {
+        if (pair.bodyA_ == body)
+            pair.bodyA_ = nullptr;
+        if (pair.bodyB_ == body)
+            pair.bodyB_ = nullptr;
+    }
+}
+
+void PhysicsWorld::RemoveStaticCompoundBody(RigidBody* body)
+{
+    HashMap<RigidBody*, StaticCompound*>::Iterator i = staticCompoundBodies_.Find(body);
+    if (i != staticCompoundBodies_.End())
+        DissolveStaticCompound(i->second_);
 }
 
 void PhysicsWorld::AddCollisionShape(CollisionShape* shape)
@@ -747,11 +1681,73 @@ void PhysicsWorld::RemoveConstraint(Constraint* constraint)
     constraints_.Remove(constraint);
 }
 
+void PhysicsWorld::AddRaycastVehicle(RaycastVehicle* vehicle)
+{
+    if (raycastVehicles_.Contains(vehicle))
+        return;
+
+    if (!vehicleAction_)
+    {
+        vehicleAction_ = new RaycastVehicleAction(this);
+        world_->addAction(vehicleAction_.Get());
+    }
+
+    raycastVehicles_.Push(vehicle);
+}
+
+void PhysicsWorld::RemoveRaycastVehicle(RaycastVehicle* vehicle)
+{
+    raycastVehicles_.Remove(vehicle);
+}
+
 void PhysicsWorld::AddDelayedWorldTransform(const DelayedWorldTransform& transform)
 {
     delayedWorldTransforms_[transform.rigidBody_] = transform;
 }
 
+void PhysicsWorld::AddInterpolatedBody(RigidBody* body)
+{
+    interpolatedBodies_.Push(body);
+}
+
+void PhysicsWorld::StreamInBody(RigidBody* body)
+{
+    // Forget the body first, as adding it back may activate it
+    RemoveStreamedOutBody(body);
+    body->SetStreamedOut(false);
+}
+
+void PhysicsWorld::RemoveStreamedOutBody(RigidBody* body)
+{
+    HashMap<RigidBody*, IntVector3>::Iterator i = streamedOutBodies_.Find(body);
+    if (i == streamedOutBodies_.End())
+        return;
+
+    HashMap<IntVector3, PODVector<RigidBody*> >::Iterator j = streamedOutCells_.Find(i->second_);
+    if (j != streamedOutCells_.End())
+    {
+        j->second_.RemoveSwap(body);
+        if (j->second_.Empty())
+            streamedOutCells_.Erase(j);
+    }
+
+    streamedOutBodies_.Erase(i);
+}
+
+void PhysicsWorld::DissolveStaticCompound(StaticCompound* compound)
+{
+    world_->removeCollisionObject(compound->object_.Get());
+    staticCompounds_.Remove(compound);
+
+    for (RigidBody* body : compound->bodies_)
+    {
+        staticCompoundBodies_.Erase(body);
+        body->SetStaticMerged(false);
+    }
+
+    delete compound;
+}
+
 void PhysicsWorld::DrawDebugGeometry(bool depthTest)
 {
     auto* debug = GetComponent<DebugRenderer>();
@@ -768,9 +1764,231 @@ void PhysicsWorld::SetDebugDepthTest(bool enable)
     debugDepthTest_ = enable;
 }
 
+void PhysicsWorld::StartQueries(PhysicsQueryBatch* batch)
+{
+    unsigned numQueries = batch->queries_.Size();
+    batch->results_.Resize(numQueries);
+    batch->sweeps_.Clear();
+    batch->items_.Clear();
+    batch->world_ = this;
+    batch->started_ = true;
+
+    if (!numQueries)
+        return;
+
+    // Resolve the collision shape sweeps here, as the shape's node transform can not be safely read in the worker threads
+    for (unsigned i = 0; i < numQueries; ++i)
+    {
+        const PhysicsQuery& query = batch->queries_[i];
+        if (!query.shape_)
+            continue;
+
+        if (batch->sweeps_.Empty())
+            batch->sweeps_.Resize(numQueries);
+
+        PhysicsQueryBatch::ShapeSweep& sweep = batch->sweeps_[i];
+        sweep.shape_ = nullptr;
+        sweep.ignore_ = nullptr;
+
+        btCollisionShape* shape = query.shape_->GetCollisionShape();
+        if (!shape)
+        {
+            URHO3D_LOGERROR("Null collision shape for convex cast");
+            continue;
+        }
+        if (!shape->isConvex())
+        {
+            URHO3D_LOGERROR("Can not use non-convex collision shape for convex cast");
+            continue;
+        }
+
+        // Exclude the shape's own rigid body from the sweep result
+        auto* bodyComp = query.shape_->GetComponent<RigidBody>();
+        sweep.shape_ = static_cast<btConvexShape*>(shape);
+        sweep.ignore_ = bodyComp ? bodyComp->GetBody() : nullptr;
+
+        // Take the shape's offset position & rotation into account
+        Node* shapeNode = query.shape_->GetNode();
+        Vector3 worldScale = shapeNode ? shapeNode->GetWorldScale() : Vector3::ONE;
+        sweep.start_ = Matrix3x4(query.start_, query.startRotation_, worldScale) * query.shape_->GetPosition();
+        sweep.end_ = Matrix3x4(query.end_, query.endRotation_, worldScale) * query.shape_->GetPosition();
+        sweep.startRotation_ = query.startRotation_ * query.shape_->GetRotation();
+        sweep.endRotation_ = query.endRotation_ * query.shape_->GetRotation();
+    }
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    unsigned numItems = queue ? Max(queue->GetNumThreads(), 1U) * QUERY_ITEMS_PER_THREAD : 1;
+    unsigned queriesPerItem = Max((numQueries + numItems - 1) / numItems, MIN_QUERIES_PER_ITEM);
+
+    PhysicsQuery* start = batch->queries_.Buffer();
+    PhysicsQuery* end = start + numQueries;
+    while (start < end)
+    {
+        PhysicsQuery* itemEnd = start + Min(queriesPerItem, (unsigned)(end - start));
+
+        // Not pooled, as pooled items may be reset on the next frame begin before the batch has been reaped
+        SharedPtr<WorkItem> item(new WorkItem());
+        item->workFunction_ = ExecuteQueriesWork;
+        item->start_ = start;
+        item->end_ = itemEnd;
+        item->aux_ = batch;
+        batch->items_.Push(item);
+        if (queue)
+            queue->AddWorkItem(item);
+
+        start = itemEnd;
+    }
+}
+
+void PhysicsWorld::UpdateRaycastVehicles(float timeStep)
+{
+    if (raycastVehicles_.Empty())
+        return;
+
+    URHO3D_PROFILE(UpdateRaycastVehicles);
+
+    // Cast the wheel rays of all vehicles at once. The broadphase is not modified while the actions are updated
+    if (!vehicleQueries_)
+        vehicleQueries_ = new PhysicsQueryBatch();
+
+    vehicleQueries_->queries_.Clear();
+    vehicleQueryOffsets_.Resize(raycastVehicles_.Size());
+    for (unsigned i = 0; i < raycastVehicles_.Size(); ++i)
+    {
+        vehicleQueryOffsets_[i] = vehicleQueries_->queries_.Size();
+        raycastVehicles_[i]->AddWheelRays(vehicleQueries_->queries_);
+    }
+
+    if (!vehicleQueries_->queries_.Empty())
+        ExecuteQueries(vehicleQueries_);
+
+    // A vehicle only applies impulses to its own hull body, so the vehicles can be updated in parallel
+    vehicleTimeStep_ = timeStep;
+
+    RaycastVehicle** start = raycastVehicles_.Buffer();
+    RaycastVehicle** end = start + raycastVehicles_.Size();
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    if (queue)
+        queue->ParallelFor(start, end, UpdateRaycastVehiclesWork, this, MIN_VEHICLES_PER_ITEM);
+    else
+    {
+        WorkItem item;
+        item.start_ = start;
+        item.end_ = end;
+        item.aux_ = this;
+        UpdateRaycastVehiclesWork(&item, 0);
+    }
+}
+
+void PhysicsWorld::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
+{
+    CompleteQueries();
+}
+
+void PhysicsWorld::ExecuteQueriesWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* batch = reinterpret_cast<PhysicsQueryBatch*>(item->aux_);
+    auto* start = reinterpret_cast<PhysicsQuery*>(item->start_);
+    auto* end = reinterpret_cast<PhysicsQuery*>(item->end_);
+    auto* broadphase = static_cast<btDbvtBroadphase*>(batch->world_->broadphase_.Get());
+    unsigned index = (unsigned)(start - batch->queries_.Buffer());
+
+    btAlignedObjectArray<const btDbvtNode*> stack;
+    btVector3 zero(0.0f, 0.0f, 0.0f);
+
+    for (PhysicsQuery* query = start; query < end; ++query, ++index)
+    {
+        PhysicsRaycastResult& result = batch->results_[index];
+        SetNoHit(result);
+
+        if (!query->shape_ && query->radius_ <= 0.0f)
+        {
+            ClosestRayCallback rayCallback(ToBtVector3(query->start_), ToBtVector3(query->end_));
+            rayCallback.m_collisionFilterGroup = (short)0xffff;
+            rayCallback.m_collisionFilterMask = (short)query->collisionMask_;
+
+            QueryRayCallback callback(rayCallback.m_rayFromWorld, rayCallback.m_rayToWorld, rayCallback);
+            callback.Traverse(broadphase, rayCallback.m_rayFromWorld, rayCallback.m_rayToWorld, zero, zero, stack);
+
+            if (rayCallback.hasHit())
+            {
+                result.position_ = ToVector3(rayCallback.m_hitPointWorld);
+                result.normal_ = ToVector3(rayCallback.m_hitNormalWorld);
+                result.distance_ = (result.position_ - query->start_).Length();
+                result.hitFraction_ = rayCallback.m_closestHitFraction;
+                result.body_ = GetHitBody(rayCallback.m_collisionObject, rayCallback.childIndex_);
+            }
+            continue;
+        }
+
+        btSphereShape sphere(query->radius_);
+        const btConvexShape* shape = &sphere;
+        const btCollisionObject* ignore = nullptr;
+        Vector3 startPos = query->start_;
+        Vector3 endPos = query->end_;
+        Quaternion startRot = Quaternion::IDENTITY;
+        Quaternion endRot = Quaternion::IDENTITY;
+
+        if (query->shape_)
+        {
+            const PhysicsQueryBatch::ShapeSweep& sweep = batch->sweeps_[index];
+            if (!sweep.shape_)
+                continue;
+
+            shape = sweep.shape_;
+            ignore = sweep.ignore_;
+            startPos = sweep.start_;
+            endPos = sweep.end_;
+            startRot = sweep.startRotation_;
+            endRot = sweep.endRotation_;
+        }
+
+        QueryConvexResultCallback convexCallback(ToBtVector3(startPos), ToBtVector3(endPos), ignore);
+        convexCallback.m_collisionFilterGroup = (short)0xffff;
+        convexCallback.m_collisionFilterMask = (short)query->collisionMask_;
+
+        btTransform from(ToBtQuaternion(startRot), convexCallback.m_convexFromWorld);
+        btTransform to(ToBtQuaternion(endRot), convexCallback.m_convexToWorld);
+
+        // Expand the broadphase traversal by the bounds of the shape rotating along the sweep
+        btVector3 linVel, angVel, aabbMin, aabbMax;
+        btTransformUtil::calculateVelocity(from, to, 1.0f, linVel, angVel);
+        btTransform rotation(from.getRotation());
+        shape->calculateTemporalAabb(rotation, zero, angVel, 1.0f, aabbMin, aabbMax);
+
+        QuerySweepCallback callback(shape, from, to, convexCallback);
+        callback.Traverse(broadphase, from.getOrigin(), to.getOrigin(), aabbMin, aabbMax, stack);
+
+        if (convexCallback.hasHit())
+        {
+            result.body_ = GetHitBody(convexCallback.m_hitCollisionObject, convexCallback.childIndex_);
+            result.position_ = ToVector3(convexCallback.m_hitPointWorld);
+            result.normal_ = ToVector3(convexCallback.m_hitNormalWorld);
+            result.distance_ = convexCallback.m_closestHitFraction * (endPos - startPos).Length();
+            result.hitFraction_ = convexCallback.m_closestHitFraction;
+        }
+    }
+}
+
+void PhysicsWorld::UpdateRaycastVehiclesWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* world = reinterpret_cast<PhysicsWorld*>(item->aux_);
+    auto* start = reinterpret_cast<RaycastVehicle**>(item->start_);
+    auto* end = reinterpret_cast<RaycastVehicle**>(item->end_);
+    const PODVector<PhysicsRaycastResult>& results = world->vehicleQueries_->results_;
+
+    for (RaycastVehicle** vehicle = start; vehicle < end; ++vehicle)
+    {
+        unsigned offset = world->vehicleQueryOffsets_[(unsigned)(vehicle - world->raycastVehicles_.Buffer())];
+        (*vehicle)->UpdateVehicle(results.Buffer() + offset, world->vehicleTimeStep_);
+    }
+}
+
 void PhysicsWorld::CleanupGeometryCache()
 {
-    // Remove cached shapes whose only reference is the cache itself
+    // Remove cached shapes whose only reference is the cache itself. The shared convex hulls reference the convex geometry, so clean them first
+    CleanupGeometryCacheImpl(primitiveShapeCache_);
     CleanupGeometryCacheImpl(triMeshCache_);
     CleanupGeometryCacheImpl(convexCache_);
     CleanupGeometryCacheImpl(gimpactTrimeshCache_);
@@ -823,6 +2041,9 @@ void PhysicsWorld::PostStep(float timeStep)
         profiler->EndBlock();
 #endif
 
+    if (statisticsEnabled_)
+        UpdateStepStatistics();
+
     SendCollisionEvents();
 
     // Send post-step event
@@ -839,14 +2060,12 @@ void PhysicsWorld::SendCollisionEvents()
     URHO3D_PROFILE(SendCollisionEvents);
 
     currentCollisions_.Clear();
-    physicsCollisionData_.Clear();
-    nodeCollisionData_.Clear();
 
     int numManifolds = collisionDispatcher_->getNumManifolds();
 
     if (numManifolds)
     {
-        physicsCollisionData_[PhysicsCollision::P_WORLD] = this;
+        physicsCollisionData_.world_ = this;
 
         for (int i = 0; i < numManifolds; ++i)
         {
@@ -906,121 +2125,104 @@ void PhysicsWorld::SendCollisionEvents()
 
             bool trigger = bodyA->IsTrigger() || bodyB->IsTrigger();
             bool newCollision = !previousCollisions_.Contains(i->first_);
+            bool reportContacts = bodyA->GetReportContacts() || bodyB->GetReportContacts();
 
-            physicsCollisionData_[PhysicsCollision::P_NODEA] = nodeA;
-            physicsCollisionData_[PhysicsCollision::P_NODEB] = nodeB;
-            physicsCollisionData_[PhysicsCollision::P_BODYA] = bodyA;
-            physicsCollisionData_[PhysicsCollision::P_BODYB] = bodyB;
-            physicsCollisionData_[PhysicsCollision::P_TRIGGER] = trigger;
+            // Resting pairs are usually not listened to, so skip gathering the contacts when nothing would receive them.
+            // The pair is still tracked in the current collisions to detect the collision start and end
+            if (!reportContacts && !HasEventReceivers(E_PHYSICSCOLLISION) && !nodeA->HasEventReceivers(E_NODECOLLISION) &&
+                !nodeB->HasEventReceivers(E_NODECOLLISION) && (!newCollision || (!HasEventReceivers(E_PHYSICSCOLLISIONSTART) &&
+                !nodeA->HasEventReceivers(E_NODECOLLISIONSTART) && !nodeB->HasEventReceivers(E_NODECOLLISIONSTART))))
+                continue;
 
-            contacts_.Clear();
+            physicsCollisionData_.nodeA_ = nodeA;
+            physicsCollisionData_.nodeB_ = nodeB;
+            physicsCollisionData_.bodyA_ = bodyA;
+            physicsCollisionData_.bodyB_ = bodyB;
+            physicsCollisionData_.trigger_ = trigger;
+            physicsCollisionData_.contacts_.Clear();
 
-            // "Pointers not flipped"-manifold, send unmodified normals
-            btPersistentManifold* contactManifold = i->second_.manifold_;
-            if (contactManifold)
-            {
-                for (int j = 0; j < contactManifold->getNumContacts(); ++j)
-                {
-                    btManifoldPoint& point = contactManifold->getContactPoint(j);
-                    contacts_.WriteVector3(ToVector3(point.m_positionWorldOnB));
-                    contacts_.WriteVector3(ToVector3(point.m_normalWorldOnB));
-                    contacts_.WriteFloat(point.m_distance1);
-                    contacts_.WriteFloat(point.m_appliedImpulse);
-                }
-            }
-            // "Pointers flipped"-manifold, flip normals also
-            contactManifold = i->second_.flippedManifold_;
-            if (contactManifold)
+            // "Pointers not flipped"-manifold, send unmodified normals. "Pointers flipped"-manifold, flip normals also
+            AppendContactPoints(physicsCollisionData_.contacts_, i->second_.manifold_, false);
+            AppendContactPoints(physicsCollisionData_.contacts_, i->second_.flippedManifold_, true);
+
+            if (reportContacts)
             {
-                for (int j = 0; j < contactManifold->getNumContacts(); ++j)
-                {
-                    btManifoldPoint& point = contactManifold->getContactPoint(j);
-                    contacts_.WriteVector3(ToVector3(point.m_positionWorldOnB));
-                    contacts_.WriteVector3(-ToVector3(point.m_normalWorldOnB));
-                    contacts_.WriteFloat(point.m_distance1);
-                    contacts_.WriteFloat(point.m_appliedImpulse);
-                }
+                PhysicsContactPair pair;
+                pair.bodyA_ = bodyA;
+                pair.bodyB_ = bodyB;
+                pair.firstContact_ = contactPoints_.Size();
+                pair.numContacts_ = physicsCollisionData_.contacts_.Size();
+                pair.started_ = newCollision;
+                pair.trigger_ = trigger;
+                contactPairs_.Push(pair);
+                contactPoints_.Push(physicsCollisionData_.contacts_);
             }
 
-            physicsCollisionData_[PhysicsCollision::P_CONTACTS] = contacts_.GetBuffer();
-
             // Send separate collision start event if collision is new
-            if (newCollision)
+            if (newCollision && HasEventReceivers(E_PHYSICSCOLLISIONSTART))
             {
-                SendEvent(E_PHYSICSCOLLISIONSTART, physicsCollisionData_);
+                SendTypedEvent(E_PHYSICSCOLLISIONSTART, physicsCollisionData_);
                 // Skip rest of processing if either of the nodes or bodies is removed as a response to the event
                 if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
                     continue;
             }
 
             // Then send the ongoing collision event
-            SendEvent(E_PHYSICSCOLLISION, physicsCollisionData_);
-            if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
-                continue;
-
-            nodeCollisionData_[NodeCollision::P_BODY] = bodyA;
-            nodeCollisionData_[NodeCollision::P_OTHERNODE] = nodeB;
-            nodeCollisionData_[NodeCollision::P_OTHERBODY] = bodyB;
-            nodeCollisionData_[NodeCollision::P_TRIGGER] = trigger;
-            nodeCollisionData_[NodeCollision::P_CONTACTS] = contacts_.GetBuffer();
-
-            if (newCollision)
+            if (HasEventReceivers(E_PHYSICSCOLLISION))
             {
-                nodeA->SendEvent(E_NODECOLLISIONSTART, nodeCollisionData_);
+                SendTypedEvent(E_PHYSICSCOLLISION, physicsCollisionData_);
                 if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
                     continue;
             }
 
-            nodeA->SendEvent(E_NODECOLLISION, nodeCollisionData_);
-            if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
-                continue;
-
-            // Flip perspective to body B
-            contacts_.Clear();
-            contactManifold = i->second_.manifold_;
-            if (contactManifold)
+            if (nodeA->HasEventReceivers(E_NODECOLLISION) || (newCollision && nodeA->HasEventReceivers(E_NODECOLLISIONSTART)))
             {
-                for (int j = 0; j < contactManifold->getNumContacts(); ++j)
+                nodeCollisionData_.body_ = bodyA;
+                nodeCollisionData_.otherNode_ = nodeB;
+                nodeCollisionData_.otherBody_ = bodyB;
+                nodeCollisionData_.trigger_ = trigger;
+                nodeCollisionData_.contacts_ = physicsCollisionData_.contacts_;
+
+                if (newCollision)
                 {
-                    btManifoldPoint& point = contactManifold->getContactPoint(j);
-                    contacts_.WriteVector3(ToVector3(point.m_positionWorldOnB));
-                    contacts_.WriteVector3(-ToVector3(point.m_normalWorldOnB));
-                    contacts_.WriteFloat(point.m_distance1);
-                    contacts_.WriteFloat(point.m_appliedImpulse);
+                    nodeA->SendTypedEvent(E_NODECOLLISIONSTART, nodeCollisionData_);
+                    if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
+                        continue;
                 }
+
+                nodeA->SendTypedEvent(E_NODECOLLISION, nodeCollisionData_);
+                if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
+                    continue;
             }
-            contactManifold = i->second_.flippedManifold_;
-            if (contactManifold)
+
+            if (nodeB->HasEventReceivers(E_NODECOLLISION) || (newCollision && nodeB->HasEventReceivers(E_NODECOLLISIONSTART)))
             {
-                for (int j = 0; j < contactManifold->getNumContacts(); ++j)
+                // Flip perspective to body B
+                nodeCollisionData_.body_ = bodyB;
+                nodeCollisionData_.otherNode_ = nodeA;
+                nodeCollisionData_.otherBody_ = bodyA;
+                nodeCollisionData_.trigger_ = trigger;
+                nodeCollisionData_.contacts_.Clear();
+                AppendContactPoints(nodeCollisionData_.contacts_, i->second_.manifold_, true);
+                AppendContactPoints(nodeCollisionData_.contacts_, i->second_.flippedManifold_, false);
+
+                if (newCollision)
                 {
-                    btManifoldPoint& point = contactManifold->getContactPoint(j);
-                    contacts_.WriteVector3(ToVector3(point.m_positionWorldOnB));
-                    contacts_.WriteVector3(ToVector3(point.m_normalWorldOnB));
-                    contacts_.WriteFloat(point.m_distance1);
-                    contacts_.WriteFloat(point.m_appliedImpulse);
+                    nodeB->SendTypedEvent(E_NODECOLLISIONSTART, nodeCollisionData_);
+                    if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
+                        continue;
                 }
-            }
-
-            nodeCollisionData_[NodeCollision::P_BODY] = bodyB;
-            nodeCollisionData_[NodeCollision::P_OTHERNODE] = nodeA;
-            nodeCollisionData_[NodeCollision::P_OTHERBODY] = bodyA;
-            nodeCollisionData_[NodeCollision::P_CONTACTS] = contacts_.GetBuffer();
 
-            if (newCollision)
-            {
-                nodeB->SendEvent(E_NODECOLLISIONSTART, nodeCollisionData_);
-                if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
-                    continue;
+                nodeB->SendTypedEvent(E_NODECOLLISION, nodeCollisionData_);
             }
-
-            nodeB->SendEvent(E_NODECOLLISION, nodeCollisionData_);
         }
     }
 
     // Send collision end events as applicable
     {
-        physicsCollisionData_[PhysicsCollisionEnd::P_WORLD] = this;
+        physicsCollisionData_.world_ = this;
+        physicsCollisionData_.contacts_.Clear();
+        nodeCollisionData_.contacts_.Clear();
 
         for (HashMap<Pair<WeakPtr<RigidBody>, WeakPtr<RigidBody> >, ManifoldPair>::Iterator
                  i = previousCollisions_.Begin(); i != previousCollisions_.End(); ++i)
@@ -1048,31 +2250,52 @@ void PhysicsWorld::SendCollisionEvents()
                 WeakPtr<Node> nodeWeakA(nodeA);
                 WeakPtr<Node> nodeWeakB(nodeB);
 
-                physicsCollisionData_[PhysicsCollisionEnd::P_BODYA] = bodyA;
-                physicsCollisionData_[PhysicsCollisionEnd::P_BODYB] = bodyB;
-                physicsCollisionData_[PhysicsCollisionEnd::P_NODEA] = nodeA;
-                physicsCollisionData_[PhysicsCollisionEnd::P_NODEB] = nodeB;
-                physicsCollisionData_[PhysicsCollisionEnd::P_TRIGGER] = trigger;
+                if (bodyA->GetReportContacts() || bodyB->GetReportContacts())
+                {
+                    PhysicsContactPair pair;
+                    pair.bodyA_ = bodyA;
+                    pair.bodyB_ = bodyB;
+                    pair.firstContact_ = contactPoints_.Size();
+                    pair.ended_ = true;
+                    pair.trigger_ = trigger;
+                    contactPairs_.Push(pair);
+                }
 
-                SendEvent(E_PHYSICSCOLLISIONEND, physicsCollisionData_);
-                // Skip rest of processing if either of the nodes or bodies is removed as a response to the event
-                if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
-                    continue;
+                if (HasEventReceivers(E_PHYSICSCOLLISIONEND))
+                {
+                    physicsCollisionData_.bodyA_ = bodyA;
+                    physicsCollisionData_.bodyB_ = bodyB;
+                    physicsCollisionData_.nodeA_ = nodeA;
+                    physicsCollisionData_.nodeB_ = nodeB;
+                    physicsCollisionData_.trigger_ = trigger;
+
+                    SendTypedEvent(E_PHYSICSCOLLISIONEND, physicsCollisionData_);
+                    // Skip rest of processing if either of the nodes or bodies is removed as a response to the event
+                    if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
+                        continue;
+                }
 
-                nodeCollisionData_[NodeCollisionEnd::P_BODY] = bodyA;
-                nodeCollisionData_[NodeCollisionEnd::P_OTHERNODE] = nodeB;
-                nodeCollisionData_[NodeCollisionEnd::P_OTHERBODY] = bodyB;
-                nodeCollisionData_[NodeCollisionEnd::P_TRIGGER] = trigger;
+                nodeCollisionData_.trigger_ = trigger;
 
-                nodeA->SendEvent(E_NODECOLLISIONEND, nodeCollisionData_);
-                if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
-                    continue;
+                if (nodeA->HasEventReceivers(E_NODECOLLISIONEND))
+                {
+                    nodeCollisionData_.body_ = bodyA;
+                    nodeCollisionData_.otherNode_ = nodeB;
+                    nodeCollisionData_.otherBody_ = bodyB;
 
-                nodeCollisionData_[NodeCollisionEnd::P_BODY] = bodyB;
-                nodeCollisionData_[NodeCollisionEnd::P_OTHERNODE] = nodeA;
-                nodeCollisionData_[NodeCollisionEnd::P_OTHERBODY] = bodyA;
+                    nodeA->SendTypedEvent(E_NODECOLLISIONEND, nodeCollisionData_);
+                    if (!nodeWeakA || !nodeWeakB || !i->first_.first_ || !i->first_.second_)
+                        continue;
+                }
+
+                if (nodeB->HasEventReceivers(E_NODECOLLISIONEND))
+                {
+                    nodeCollisionData_.body_ = bodyB;
+                    nodeCollisionData_.otherNode_ = nodeA;
+                    nodeCollisionData_.otherBody_ = bodyA;
 
-                nodeB->SendEvent(E_NODECOLLISIONEND, nodeCollisionData_);
+                    nodeB->SendTypedEvent(E_NODECOLLISIONEND, nodeCollisionData_);
+                }
             }
         }
     }
@@ -1080,6 +2303,206 @@ void PhysicsWorld::SendCollisionEvents()
     previousCollisions_ = currentCollisions_;
 }
 
+void PhysicsWorld::ActivateTaskScheduler()
+{
+#if BT_THREADSAFE
+    // The scheduler is shared, so apply this world's setting in case another world has been stepped in between
+    GetTaskScheduler(GetSubsystem<WorkQueue>())->SetEnabled(multithreaded_);
+#endif
+}
+
+void PhysicsWorld::ActivateProfileZones()
+{
+    Profiler* profiler = nullptr;
+#ifdef URHO3D_PROFILING
+    profiler = GetSubsystem<Profiler>();
+#endif
+
+    zoneProfiler.store(profiler, std::memory_order_relaxed);
+    zoneStatisticsWorld.store(statisticsEnabled_ ? this : nullptr, std::memory_order_relaxed);
+
+    // The hooks are global, so once installed they stay, and ignore the zones outside a step
+    if ((profiler || statisticsEnabled_) && !zoneHooksInstalled)
+    {
+        btSetCustomEnterProfileZoneFunc(EnterProfileZone);
+        btSetCustomLeaveProfileZoneFunc(LeaveProfileZone);
+        zoneHooksInstalled = true;
+    }
+}
+
+void PhysicsWorld::UpdateStepStatistics()
+{
+    ++statistics_.numSteps_;
+    statistics_.numBroadphasePairs_ = (unsigned)broadphase_->getOverlappingPairCache()->getNumOverlappingPairs();
+    statistics_.numNarrowphaseTests_ = narrowphaseTests_.exchange(0, std::memory_order_relaxed);
+
+    int numManifolds = collisionDispatcher_->getNumManifolds();
+    unsigned numContacts = 0;
+    for (int i = 0; i < numManifolds; ++i)
+        numContacts += (unsigned)collisionDispatcher_->getManifoldByIndexInternal(i)->getNumContacts();
+    statistics_.numManifolds_ = (unsigned)numManifolds;
+    statistics_.numContacts_ = numContacts;
+
+    // Bodies of the same island share the island tag, so count the distinct tags of the active bodies
+    islandTags_.Clear();
+    const btCollisionObjectArray& objects = world_->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); ++i)
+    {
+        const btCollisionObject* object = objects[i];
+        if (!object->isStaticOrKinematicObject() && object->isActive() && object->getIslandTag() >= 0)
+            islandTags_.Push(object->getIslandTag());
+    }
+    Sort(islandTags_.Begin(), islandTags_.End());
+    unsigned numIslands = 0;
+    for (unsigned i = 0; i < islandTags_.Size(); ++i)
+    {
+        if (!i || islandTags_[i] != islandTags_[i - 1])
+            ++numIslands;
+    }
+    statistics_.numIslands_ = numIslands;
+
+    unsigned numConstraints = 0;
+    for (int i = 0; i < world_->getNumConstraints(); ++i)
+    {
+        if (world_->getConstraint(i)->isEnabled())
+            ++numConstraints;
+    }
+    statistics_.numConstraints_ = numConstraints;
+    statistics_.numSolverIterations_ = (unsigned)world_->getSolverInfo().m_numIterations;
+}
+
+void PhysicsWorld::EnterProfileZone(const char* name)
+{
+    unsigned depth = zoneDepth++;
+    if (depth >= MAX_PROFILE_ZONE_DEPTH)
+        return;
+
+    ProfileZone& zone = zoneStack[depth];
+    zone.name_ = name;
+    zone.profiler_ = zoneProfiler.load(std::memory_order_relaxed);
+    if (zone.profiler_)
+        zone.profiler_->BeginBlock(name);
+
+    if (Thread::IsMainThread() && zoneStatisticsWorld.load(std::memory_order_relaxed))
+        zoneTimers[depth].Reset();
+}
+
+void PhysicsWorld::LeaveProfileZone()
+{
+    // A zone entered before the hooks were installed is left without a matching enter
+    if (!zoneDepth)
+        return;
+
+    unsigned depth = --zoneDepth;
+    if (depth >= MAX_PROFILE_ZONE_DEPTH)
+        return;
+
+    ProfileZone& zone = zoneStack[depth];
+    if (zone.profiler_)
+        zone.profiler_->EndBlock();
+
+    PhysicsWorld* world = Thread::IsMainThread() ? zoneStatisticsWorld.load(std::memory_order_relaxed) : nullptr;
+    if (!world)
+        return;
+
+    float time = zoneTimers[depth].GetUSec(false) / 1000.0f;
+    PhysicsStatistics& stats = world->statistics_;
+    const char* name = zone.name_;
+
+    if (!strcmp(name, "internalSingleStepSimulation"))
+        stats.stepTime_ += time;
+    else if (!strcmp(name, "performDiscreteCollisionDetection"))
+        stats.collisionTime_ += time;
+    else if (!strcmp(name, "updateAabbs") || !strcmp(name, "calculateOverlappingPairs"))
+        stats.broadphaseTime_ += time;
+    else if (!strcmp(name, "dispatchAllCollisionPairs"))
+        stats.narrowphaseTime_ += time;
+    else if (!strcmp(name, "calculateSimulationIslands") || !strcmp(name, "updateActivationState"))
+        stats.islandTime_ += time;
+    else if (!strcmp(name, "solveConstraints"))
+        stats.solveTime_ += time;
+    else if (!strcmp(name, "predictUnconstraintMotion") || !strcmp(name, "createPredictiveContacts") ||
+        !strcmp(name, "integrateTransforms"))
+        stats.integrateTime_ += time;
+}
+
+void PhysicsWorld::NarrowphaseNearCallback(btBroadphasePair& pair, btCollisionDispatcher& dispatcher,
+    const btDispatcherInfo& dispatchInfo)
+{
+    // The world is the debug drawer of its dispatch info
+    auto* world = static_cast<PhysicsWorld*>(dispatchInfo.m_debugDraw);
+    if (world && dispatcher.needsCollision(static_cast<btCollisionObject*>(pair.m_pProxy0->m_clientObject),
+        static_cast<btCollisionObject*>(pair.m_pProxy1->m_clientObject)))
+        world->narrowphaseTests_.fetch_add(1, std::memory_order_relaxed);
+
+    btCollisionDispatcher::defaultNearCallback(pair, dispatcher, dispatchInfo);
+}
+
+static void WriteContactsBuffer(Variant& dest, const PODVector<PhysicsContactPoint>& contacts)
+{
+    static_assert(sizeof(PhysicsContactPoint) == 8 * sizeof(float), "Contact point must match the contacts buffer layout");
+    dest.SetBuffer(contacts.Buffer(), contacts.Size() * sizeof(PhysicsContactPoint));
+}
+
+static void ReadContactsBuffer(PODVector<PhysicsContactPoint>& dest, const Variant& src)
+{
+    const PODVector<unsigned char>& buffer = src.GetBuffer();
+    dest.Resize(buffer.Size() / sizeof(PhysicsContactPoint));
+    if (!dest.Empty())
+        memcpy(dest.Buffer(), buffer.Buffer(), dest.Size() * sizeof(PhysicsContactPoint));
+}
+
+void PhysicsCollisionEventData::ToVariantMap(VariantMap& eventData) const
+{
+    using namespace PhysicsCollision;
+
+    eventData[P_WORLD] = world_;
+    eventData[P_NODEA] = nodeA_;
+    eventData[P_NODEB] = nodeB_;
+    eventData[P_BODYA] = bodyA_;
+    eventData[P_BODYB] = bodyB_;
+    eventData[P_TRIGGER] = trigger_;
+    // The collision end event has no contacts
+    if (!contacts_.Empty())
+        WriteContactsBuffer(eventData[P_CONTACTS], contacts_);
+}
+
+void PhysicsCollisionEventData::FromVariantMap(VariantMap& eventData)
+{
+    using namespace PhysicsCollision;
+
+    world_ = static_cast<PhysicsWorld*>(eventData[P_WORLD].GetPtr());
+    nodeA_ = static_cast<Node*>(eventData[P_NODEA].GetPtr());
+    nodeB_ = static_cast<Node*>(eventData[P_NODEB].GetPtr());
+    bodyA_ = static_cast<RigidBody*>(eventData[P_BODYA].GetPtr());
+    bodyB_ = static_cast<RigidBody*>(eventData[P_BODYB].GetPtr());
+    trigger_ = eventData[P_TRIGGER].GetBool();
+    ReadContactsBuffer(contacts_, eventData[P_CONTACTS]);
+}
+
+void NodeCollisionEventData::ToVariantMap(VariantMap& eventData) const
+{
+    using namespace NodeCollision;
+
+    eventData[P_BODY] = body_;
+    eventData[P_OTHERNODE] = otherNode_;
+    eventData[P_OTHERBODY] = otherBody_;
+    eventData[P_TRIGGER] = trigger_;
+    if (!contacts_.Empty())
+        WriteContactsBuffer(eventData[P_CONTACTS], contacts_);
+}
+
+void NodeCollisionEventData::FromVariantMap(VariantMap& eventData)
+{
+    using namespace NodeCollision;
+
+    body_ = static_cast<RigidBody*>(eventData[P_BODY].GetPtr());
+    otherNode_ = static_cast<Node*>(eventData[P_OTHERNODE].GetPtr());
+    otherBody_ = static_cast<RigidBody*>(eventData[P_OTHERBODY].GetPtr());
+    trigger_ = eventData[P_TRIGGER].GetBool();
+    ReadContactsBuffer(contacts_, eventData[P_CONTACTS]);
+}
+
 void RegisterPhysicsLibrary(Context* context)
 {
     CollisionShape::RegisterObject(context);
@@ -25,20 +25,30 @@
 #include "../Container/HashSet.h"
 #include "../IO/VectorBuffer.h"
 #include "../Math/BoundingBox.h"
+#include "../Math/Quaternion.h"
 #include "../Math/Sphere.h"
 #include "../Math/Vector3.h"
+#include "../Physics/PhysicsEvents.h"
 #include "../Scene/Component.h"
 
 #include <Bullet/LinearMath/btIDebugDraw.h>
 
+#include <atomic>
+
+class btActionInterface;
 class btCollisionConfiguration;
+class btCollisionDispatcher;
+class btCollisionObject;
 class btCollisionShape;
+class btConvexShape;
 class btBroadphaseInterface;
 class btConstraintSolver;
 class btDiscreteDynamicsWorld;
 class btDispatcher;
 class btDynamicsWorld;
 class btPersistentManifold;
+struct btBroadphasePair;
+struct btDispatcherInfo;
 
 namespace Urho3D
 {
@@ -48,13 +58,17 @@ class Deserializer;
 class Constraint;
 class Model;
 class Node;
+class PhysicsWorld;
 class Ray;
+class RaycastVehicle;
 class RigidBody;
 class Scene;
 class Serializer;
 class XMLElement;
 
 struct CollisionGeometryData;
+struct StaticCompound;
+struct WorkItem;
 
 /// Physics raycast hit.
 struct URHO3D_API PhysicsRaycastResult
@@ -77,6 +91,71 @@ struct URHO3D_API PhysicsRaycastResult
     RigidBody* body_{};
 };
 
+/// Physics batch query: a closest hit raycast, or a sweep of a sphere or a convex collision shape.
+/// @nobind
+struct URHO3D_API PhysicsQuery
+{
+    /// Start position.
+    Vector3 start_;
+    /// End position.
+    Vector3 end_;
+    /// Rotation of the swept collision shape at the start position.
+    Quaternion startRotation_;
+    /// Rotation of the swept collision shape at the end position.
+    Quaternion endRotation_;
+    /// Collision shape to sweep. Must be convex. If null, a sphere of the radius is swept instead.
+    CollisionShape* shape_{};
+    /// Radius of the swept sphere. Zero for a raycast.
+    float radius_{};
+    /// Collision mask.
+    unsigned collisionMask_{M_MAX_UNSIGNED};
+};
+
+/// Batch of physics queries executed on the work queue worker threads. Fill the queries and submit to the physics world, the results are in the same order once completed.
+/// @nobind
+class URHO3D_API PhysicsQueryBatch : public RefCounted
+{
+    friend class PhysicsWorld;
+
+public:
+    /// Return whether the queries have been executed and the results can be read.
+    bool IsCompleted() const;
+
+    /// Queries to execute. Must not be modified while the batch is pending.
+    PODVector<PhysicsQuery> queries_;
+    /// Results of the queries. Resized to the number of queries when the batch is started.
+    PODVector<PhysicsRaycastResult> results_;
+
+private:
+    /// Collision shape sweep resolved in the main thread, as reading the node transforms is not thread-safe.
+    struct ShapeSweep
+    {
+        /// Bullet convex shape. Null if unusable.
+        btConvexShape* shape_;
+        /// Collision object of the shape's own rigid body, excluded from the results.
+        btCollisionObject* ignore_;
+        /// Start position including the shape offset.
+        Vector3 start_;
+        /// End position including the shape offset.
+        Vector3 end_;
+        /// Start rotation including the shape rotation.
+        Quaternion startRotation_;
+        /// End rotation including the shape rotation.
+        Quaternion endRotation_;
+    };
+
+    /// Physics world executing the batch.
+    PhysicsWorld* world_{};
+    /// Work items of the batch. Not pooled, so that their completed flags stay valid until reaped.
+    Vector<SharedPtr<WorkItem> > items_;
+    /// Resolved collision shape sweeps by query index. Empty if no query sweeps a collision shape.
+    PODVector<ShapeSweep> sweeps_;
+    /// Pending flag. Set when submitted and cleared when reaped.
+    bool pending_{};
+    /// Started flag. Submission is deferred while the world is simulating.
+    bool started_{};
+};
+
 /// Delayed world transform assignment for parented rigidbodies.
 struct DelayedWorldTransform
 {
@@ -90,6 +169,26 @@ struct DelayedWorldTransform
     Quaternion worldRotation_;
 };
 
+/// Colliding rigid body pair in the contact stream of the physics world. Reported when either body has contact reporting enabled.
+/// @nobind
+struct URHO3D_API PhysicsContactPair
+{
+    /// First rigid body. Null if removed after the pair was reported.
+    RigidBody* bodyA_{};
+    /// Second rigid body. Null if removed after the pair was reported.
+    RigidBody* bodyB_{};
+    /// Index of the first contact point in the contact stream.
+    unsigned firstContact_{};
+    /// Number of contact points, with the normals pointing toward the first body. Zero when the collision ended.
+    unsigned numContacts_{};
+    /// Whether the collision started on this substep.
+    bool started_{};
+    /// Whether the collision ended on this substep.
+    bool ended_{};
+    /// Trigger flag.
+    bool trigger_{};
+};
+
 /// Manifold pointers stored during collision processing.
 struct ManifoldPair
 {
@@ -106,6 +205,41 @@ struct ManifoldPair
     btPersistentManifold* flippedManifold_;
 };
 
+/// Physics simulation step statistics, collected when enabled with PhysicsWorld::SetStatisticsEnabled(). The counts are from the latest simulation step, the times in milliseconds are summed over the steps of the latest update.
+struct URHO3D_API PhysicsStatistics
+{
+    /// Number of simulation steps on the latest update.
+    unsigned numSteps_{};
+    /// Number of overlapping pairs in the broadphase.
+    unsigned numBroadphasePairs_{};
+    /// Number of pairs tested by the narrowphase. Excludes the pairs of sleeping or filtered out bodies.
+    unsigned numNarrowphaseTests_{};
+    /// Number of contact manifolds.
+    unsigned numManifolds_{};
+    /// Number of contact points.
+    unsigned numContacts_{};
+    /// Number of simulation islands with active bodies.
+    unsigned numIslands_{};
+    /// Number of enabled constraints, excluding contacts.
+    unsigned numConstraints_{};
+    /// Number of constraint solver iterations per step.
+    unsigned numSolverIterations_{};
+    /// Total simulation step time, including the physics step events.
+    float stepTime_{};
+    /// Collision detection time, including broadphase and narrowphase.
+    float collisionTime_{};
+    /// Broadphase bounding box update and pair search time.
+    float broadphaseTime_{};
+    /// Narrowphase pair dispatch time.
+    float narrowphaseTime_{};
+    /// Island building and activation state update time.
+    float islandTime_{};
+    /// Constraint solver time.
+    float solveTime_{};
+    /// Motion prediction and transform integration time.
+    float integrateTime_{};
+};
+
 /// Custom overrides of physics internals. To use overrides, must be set before the physics component is created.
 struct PhysicsWorldConfig
 {
@@ -124,6 +258,42 @@ static const float DEFAULT_MAX_NETWORK_ANGULAR_VELOCITY = 100.0f;
 /// Cache of collision geometry data.
 using CollisionGeometryDataCache = HashMap<Pair<Model*, unsigned>, SharedPtr<CollisionGeometryData> >;
 
+/// Parameters identifying a shared primitive collision shape.
+struct PrimitiveShapeKey
+{
+    /// Test for equality with another key.
+    bool operator ==(const PrimitiveShapeKey& rhs) const
+    {
+        return shapeType_ == rhs.shapeType_ && size_ == rhs.size_ && scale_ == rhs.scale_ && margin_ == rhs.margin_ &&
+            source_ == rhs.source_;
+    }
+
+    /// Return hash value for HashSet & HashMap.
+    unsigned ToHash() const
+    {
+        unsigned hash = (unsigned)shapeType_;
+        hash = 37 * hash + size_.ToHash();
+        hash = 37 * hash + scale_.ToHash();
+        hash = 37 * hash + FloatToRawIntBits(margin_);
+        hash = 37 * hash + (unsigned)((size_t)source_ / sizeof(void*));
+        return hash;
+    }
+
+    /// Shape type.
+    int shapeType_;
+    /// Shape size.
+    Vector3 size_;
+    /// World scale.
+    Vector3 scale_;
+    /// Collision margin.
+    float margin_;
+    /// Convex hull geometry data, or null for a primitive shape.
+    CollisionGeometryData* source_;
+};
+
+/// Cache of shared primitive collision shapes.
+using PrimitiveShapeCache = HashMap<PrimitiveShapeKey, SharedPtr<CollisionGeometryData> >;
+
 /// Physics simulation world component. Should be added only to the root scene node.
 class URHO3D_API PhysicsWorld : public Component, public btIDebugDraw
 {
@@ -131,6 +301,7 @@ class URHO3D_API PhysicsWorld : public Component, public btIDebugDraw
 
     friend void InternalPreTickCallback(btDynamicsWorld* world, btScalar timeStep);
     friend void InternalTickCallback(btDynamicsWorld* world, btScalar timeStep);
+    friend class RaycastVehicleAction;
 
 public:
     /// Construct.
@@ -184,12 +355,42 @@ public:
     /// Set whether to interpolate between simulation steps.
     /// @property
     void SetInterpolation(bool enable);
+    /// Set whether to step the simulation at the fixed rate and interpolate the rigid body node transforms between the last two simulation steps. Unlike the default interpolation, which extrapolates from the last step, this stays smooth when the physics rate is much lower than the frame rate, at the cost of one step of latency. Takes precedence over SetInterpolation(), and has no effect with an adaptive timestep. Disabled by default.
+    /// @property
+    void SetSnapshotInterpolation(bool enable);
     /// Set whether to use Bullet's internal edge utility for trimesh collisions. Disabled by default.
     /// @property
     void SetInternalEdge(bool enable);
     /// Set split impulse collision mode. This is more accurate, but slower. Disabled by default.
     /// @property
     void SetSplitImpulse(bool enable);
+    /// Set whether to step the simulation on the work queue worker threads. Requires the engine to be built with URHO3D_PHYSICS_THREADED, otherwise has no effect. Disabled by default.
+    /// @property
+    void SetMultithreaded(bool enable);
+    /// Set whether to save the collision geometry cache file next to the model, when building triangle mesh or convex hull geometry from a model loaded from a file. Disabled by default.
+    /// @property
+    void SetSaveGeometryCache(bool enable);
+    /// Set whether to collect simulation step statistics. Disabled by default.
+    /// @property
+    void SetStatisticsEnabled(bool enable);
+    /// Set distance from the streaming focus beyond which sleeping dynamic rigid bodies are removed from the Bullet world, keeping their state, until the focus approaches or they are activated. 0 (default) disables streaming.
+    /// @property
+    void SetStreamOutDistance(float distance);
+    /// Set distance from the streaming focus within which streamed out rigid bodies are added back to the Bullet world. Should be smaller than the stream out distance. 0 (default) uses the stream out distance.
+    /// @property
+    void SetStreamInDistance(float distance);
+    /// Set node to use as the streaming focus. If not set, uses the focus of the scene's SceneStreamer, if any, or the focus position.
+    /// @property
+    void SetStreamingFocusNode(Node* node);
+    /// Set the streaming focus position, used when there is no focus node or SceneStreamer.
+    /// @property
+    void SetStreamingFocusPosition(const Vector3& position);
+    /// Add all streamed out rigid bodies back to the Bullet world.
+    void StreamInAllBodies();
+    /// Merge the static rigid bodies that have collision event mode COLLISION_NEVER and only convex collision shapes into one compound collision object per grid cell of the given size, to reduce the number of broadphase proxies. Bodies that differ in collision layer, mask, friction or restitution are merged separately. A body is split out again, along with the rest of its compound, when it is modified.
+    void BuildStaticCompounds(float cellSize);
+    /// Split all static compounds back into individual rigid bodies.
+    void ClearStaticCompounds();
     /// Set maximum angular velocity for network replication.
     void SetMaxNetworkAngularVelocity(float velocity);
     /// Perform a physics world raycast and return all hits.
@@ -209,6 +410,12 @@ public:
     /// Perform a physics world swept convex test using a user-supplied Bullet collision shape and return the first hit.
     void ConvexCast(PhysicsRaycastResult& result, btCollisionShape* shape, const Vector3& startPos, const Quaternion& startRot,
         const Vector3& endPos, const Quaternion& endRot, unsigned collisionMask = M_MAX_UNSIGNED);
+    /// Submit a batch of physics queries to be executed on the work queue worker threads, without waiting for the results. If submitted during a simulation step, is started after the step. The physics world must not be modified until the batch is completed: the world completes pending batches on the next frame begin and before stepping, at the latest.
+    void SubmitQueries(PhysicsQueryBatch* batch);
+    /// Execute a batch of physics queries on the work queue worker threads and wait for the results.
+    void ExecuteQueries(PhysicsQueryBatch* batch);
+    /// Wait for all submitted query batches to complete.
+    void CompleteQueries();
     /// Invalidate cached collision geometry for a model.
     void RemoveCachedGeometry(Model* model);
     /// Return rigid bodies by a sphere query.
@@ -240,6 +447,10 @@ public:
     /// @property
     bool GetInterpolation() const { return interpolation_; }
 
+    /// Return whether rigid body node transforms are interpolated between the last two simulation steps.
+    /// @property
+    bool GetSnapshotInterpolation() const { return snapshotInterpolation_; }
+
     /// Return whether Bullet's internal edge utility for trimesh collisions is enabled.
     /// @property
     bool GetInternalEdge() const { return internalEdge_; }
@@ -248,6 +459,49 @@ public:
     /// @property
     bool GetSplitImpulse() const;
 
+    /// Return whether collision geometry cache files are saved when building model geometry.
+    /// @property
+    bool GetSaveGeometryCache() const { return saveGeometryCache_; }
+
+    /// Return whether simulation step statistics are collected.
+    /// @property
+    bool IsStatisticsEnabled() const { return statisticsEnabled_; }
+
+    /// Return simulation step statistics of the latest update.
+    /// @property
+    const PhysicsStatistics& GetStatistics() const { return statistics_; }
+
+    /// Return rigid body stream out distance.
+    /// @property
+    float GetStreamOutDistance() const { return streamOutDistance_; }
+
+    /// Return rigid body stream in distance.
+    /// @property
+    float GetStreamInDistance() const { return streamInDistance_; }
+
+    /// Return streaming focus node.
+    /// @property
+    Node* GetStreamingFocusNode() const;
+
+    /// Return the streaming focus position set directly.
+    /// @property
+    const Vector3& GetStreamingFocusPosition() const { return streamingFocusPosition_; }
+
+    /// Return the effective streaming focus position from the focus node, the SceneStreamer or the focus position.
+    Vector3 GetStreamingFocus() const;
+
+    /// Return number of rigid bodies currently streamed out of the Bullet world.
+    /// @property
+    unsigned GetNumStreamedOutBodies() const { return streamedOutBodies_.Size(); }
+
+    /// Return number of static compounds built from merged rigid bodies.
+    /// @property
+    unsigned GetNumStaticCompounds() const { return staticCompounds_.Size(); }
+
+    /// Return whether the simulation is stepped on the work queue worker threads.
+    /// @property
+    bool GetMultithreaded() const { return multithreaded_; }
+
     /// Return simulation steps per second.
     /// @property
     int GetFps() const { return fps_; }
@@ -267,8 +521,20 @@ public:
     void AddConstraint(Constraint* constraint);
     /// Remove a constraint. Called by Constraint.
     void RemoveConstraint(Constraint* constraint);
+    /// Add a raycast vehicle to the batched vehicle update. Called by RaycastVehicle.
+    void AddRaycastVehicle(RaycastVehicle* vehicle);
+    /// Remove a raycast vehicle from the batched vehicle update. Called by RaycastVehicle.
+    void RemoveRaycastVehicle(RaycastVehicle* vehicle);
     /// Add a delayed world transform assignment. Called by RigidBody.
     void AddDelayedWorldTransform(const DelayedWorldTransform& transform);
+    /// Add a rigid body to interpolate between simulation step snapshots. Called by RigidBody.
+    void AddInterpolatedBody(RigidBody* body);
+    /// Add a streamed out rigid body back to the Bullet world. Called by RigidBody when activated.
+    void StreamInBody(RigidBody* body);
+    /// Forget a streamed out rigid body without adding it back. Called by RigidBody when it is re-added or released.
+    void RemoveStreamedOutBody(RigidBody* body);
+    /// Split the static compound containing a rigid body back into individual rigid bodies. Called by RigidBody when modified.
+    void RemoveStaticCompoundBody(RigidBody* body);
     /// Add debug geometry to the debug renderer.
     void DrawDebugGeometry(bool depthTest);
     /// Set debug renderer to use. Called both by PhysicsWorld itself and physics components.
@@ -291,6 +557,9 @@ public:
     /// Return GImpact trimesh collision geometry cache.
     CollisionGeometryDataCache& GetGImpactTrimeshCache() { return gimpactTrimeshCache_; }
 
+    /// Return shared primitive collision shape cache.
+    PrimitiveShapeCache& GetPrimitiveShapeCache() { return primitiveShapeCache_; }
+
     /// Set node dirtying to be disregarded.
     void SetApplyingTransforms(bool enable) { applyingTransforms_ = enable; }
 
@@ -300,6 +569,18 @@ public:
     /// Return whether is currently inside the Bullet substep loop.
     bool IsSimulating() const { return simulating_; }
 
+    /// Return whether the rigid bodies are currently stepped with snapshot interpolation.
+    bool IsSnapshotInterpolating() const { return snapshotInterpolation_ && maxSubSteps_ >= 0; }
+
+    /// Return the number of the current or latest simulation step taken with snapshot interpolation.
+    unsigned GetSnapshotStep() const { return snapshotStep_; }
+
+    /// Return the colliding pairs reported during the last update, from all its substeps in order. Only pairs where either body has contact reporting enabled are included.
+    const PODVector<PhysicsContactPair>& GetContactPairs() const { return contactPairs_; }
+
+    /// Return the contact points of the reported colliding pairs.
+    const PODVector<PhysicsContactPoint>& GetContactPoints() const { return contactPoints_; }
+
     /// Overrides of the internal configuration.
     static struct PhysicsWorldConfig config;
 
@@ -316,6 +597,40 @@ private:
     void PostStep(float timeStep);
     /// Send accumulated collision events.
     void SendCollisionEvents();
+    /// Make the shared task scheduler current with this world's multithreading setting before stepping or collision detection.
+    void ActivateTaskScheduler();
+    /// Route the Bullet profile zones of the coming step to the profiler and the statistics.
+    void ActivateProfileZones();
+    /// Collect the counts of the simulation step statistics after a step.
+    void UpdateStepStatistics();
+    /// Resolve the collision shape sweeps and queue the work items of a query batch.
+    void StartQueries(PhysicsQueryBatch* batch);
+    /// Apply the snapshot interpolated transforms of the interpolated rigid bodies, and stop interpolating the ones without a snapshot from the given step.
+    void UpdateSnapshotInterpolation(float t, unsigned step);
+    /// Stream sleeping rigid bodies far from the streaming focus out of the Bullet world and nearby ones back in.
+    void UpdateStreaming();
+    /// Return the effective stream in distance.
+    float GetEffectiveStreamInDistance() const;
+    /// Return the streaming grid cell of a position.
+    IntVector3 GetStreamingCell(const Vector3& position) const;
+    /// Move the streamed out rigid bodies to new grid cells after the cell size has changed.
+    void RebuildStreamingCells();
+    /// Remove a static compound from the Bullet world and add its rigid bodies back individually.
+    void DissolveStaticCompound(StaticCompound* compound);
+    /// Cast the wheel rays of all raycast vehicles as one query batch, then update the vehicles on the work queue. Called from the vehicle action during the simulation step.
+    void UpdateRaycastVehicles(float timeStep);
+    /// Handle the frame begin event, complete the query batches submitted on the previous frame.
+    void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+    /// Work function executing a range of batch queries.
+    static void ExecuteQueriesWork(const WorkItem* item, unsigned threadIndex);
+    /// Work function updating a range of raycast vehicles.
+    static void UpdateRaycastVehiclesWork(const WorkItem* item, unsigned threadIndex);
+    /// Bullet profile zone enter hook.
+    static void EnterProfileZone(const char* name);
+    /// Bullet profile zone leave hook.
+    static void LeaveProfileZone();
+    /// Bullet narrowphase callback counting the tested pairs.
+    static void NarrowphaseNearCallback(btBroadphasePair& pair, btCollisionDispatcher& dispatcher, const btDispatcherInfo& dispatchInfo);
 
     /// Bullet collision configuration.
     btCollisionConfiguration* collisionConfiguration_{};
@@ -325,6 +640,8 @@ private:
     UniquePtr<btBroadphaseInterface> broadphase_;
     /// Bullet constraint solver.
     UniquePtr<btConstraintSolver> solver_;
+    /// Bullet multithreaded constraint solver for large islands. Only used in the multithreaded build.
+    UniquePtr<btConstraintSolver> solverMt_;
     /// Bullet physics world.
     UniquePtr<btDiscreteDynamicsWorld> world_;
     /// Extra weak pointer to scene to allow for cleanup in case the world is destroyed before other components.
@@ -339,34 +656,86 @@ private:
     HashMap<Pair<WeakPtr<RigidBody>, WeakPtr<RigidBody> >, ManifoldPair> currentCollisions_;
     /// Collision pairs on the previous frame. Used to check if a collision is "new." Manifolds are not guaranteed to exist anymore.
     HashMap<Pair<WeakPtr<RigidBody>, WeakPtr<RigidBody> >, ManifoldPair> previousCollisions_;
+    /// Submitted query batches not yet reaped.
+    Vector<SharedPtr<PhysicsQueryBatch> > queryBatches_;
     /// Delayed (parented) world transform assignments.
     HashMap<RigidBody*, DelayedWorldTransform> delayedWorldTransforms_;
+    /// Rigid bodies interpolated between simulation step snapshots.
+    PODVector<RigidBody*> interpolatedBodies_;
+    /// Streamed out rigid bodies by streaming grid cell.
+    HashMap<IntVector3, PODVector<RigidBody*> > streamedOutCells_;
+    /// Streaming grid cells of the streamed out rigid bodies.
+    HashMap<RigidBody*, IntVector3> streamedOutBodies_;
+    /// Static compounds built from merged rigid bodies.
+    PODVector<StaticCompound*> staticCompounds_;
+    /// Static compounds of the merged rigid bodies.
+    HashMap<RigidBody*, StaticCompound*> staticCompoundBodies_;
+    /// Simulation step statistics.
+    PhysicsStatistics statistics_;
+    /// Narrowphase tested pairs counter, incremented from the collision dispatcher threads.
+    std::atomic<unsigned> narrowphaseTests_{};
+    /// Raycast vehicles updated by the batched vehicle update.
+    PODVector<RaycastVehicle*> raycastVehicles_;
+    /// Bullet action running the batched vehicle update. Created when the first vehicle is added.
+    UniquePtr<btActionInterface> vehicleAction_;
+    /// Wheel ray query batch of the batched vehicle update.
+    SharedPtr<PhysicsQueryBatch> vehicleQueries_;
+    /// Index of the first wheel ray of each raycast vehicle in the query batch.
+    PODVector<unsigned> vehicleQueryOffsets_;
+    /// Island tags gathered for counting the islands.
+    PODVector<int> islandTags_;
+    /// Streaming focus node.
+    WeakPtr<Node> streamingFocusNode_;
+    /// Streaming focus position.
+    Vector3 streamingFocusPosition_;
     /// Cache for trimesh geometry data by model and LOD level.
     CollisionGeometryDataCache triMeshCache_;
     /// Cache for convex geometry data by model and LOD level.
     CollisionGeometryDataCache convexCache_;
     /// Cache for GImpact trimesh geometry data by model and LOD level.
     CollisionGeometryDataCache gimpactTrimeshCache_;
-    /// Preallocated event data map for physics collision events.
-    VariantMap physicsCollisionData_;
-    /// Preallocated event data map for node collision events.
-    VariantMap nodeCollisionData_;
-    /// Preallocated buffer for physics collision contact data.
-    VectorBuffer contacts_;
+    /// Cache of shared primitive collision shapes by shape parameters.
+    PrimitiveShapeCache primitiveShapeCache_;
+    /// Preallocated payload for physics collision events.
+    PhysicsCollisionEventData physicsCollisionData_;
+    /// Preallocated payload for node collision events.
+    NodeCollisionEventData nodeCollisionData_;
+    /// Reported colliding pairs of the last update.
+    PODVector<PhysicsContactPair> contactPairs_;
+    /// Contact points of the reported colliding pairs.
+    PODVector<PhysicsContactPoint> contactPoints_;
     /// Simulation substeps per second.
     unsigned fps_{DEFAULT_FPS};
     /// Maximum number of simulation substeps per frame. 0 (default) unlimited, or negative values for adaptive timestep.
     int maxSubSteps_{};
-    /// Time accumulator for non-interpolated mode.
+    /// Time accumulator for non-interpolated and snapshot interpolation modes.
     float timeAcc_{};
+    /// Number of simulation steps taken with snapshot interpolation.
+    unsigned snapshotStep_{};
+    /// Timestep of the ongoing batched vehicle update.
+    float vehicleTimeStep_{};
+    /// Rigid body stream out distance.
+    float streamOutDistance_{};
+    /// Rigid body stream in distance.
+    float streamInDistance_{};
+    /// Streaming grid cell size the streamed out rigid bodies are stored with.
+    float streamingCellSize_{};
     /// Maximum angular velocity for network replication.
     float maxNetworkAngularVelocity_{DEFAULT_MAX_NETWORK_ANGULAR_VELOCITY};
     /// Automatic simulation update enabled flag.
     bool updateEnabled_{true};
     /// Interpolation flag.
     bool interpolation_{true};
+    /// Snapshot interpolation flag.
+    bool snapshotInterpolation_{};
     /// Use internal edge utility flag.
     bool internalEdge_{true};
+    /// Multithreaded simulation flag.
+    bool multithreaded_{};
+    /// Save collision geometry cache files flag.
+    bool saveGeometryCache_{};
+    /// Collect simulation step statistics flag.
+    bool statisticsEnabled_{};
     /// Applying transforms flag.
     bool applyingTransforms_{};
     /// Simulating flag.
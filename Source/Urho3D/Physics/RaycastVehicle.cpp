@@ -41,9 +41,59 @@ const IntVector3 RaycastVehicle::UP_RIGHT_FORWARD(1, 0, 2);
 const IntVector3 RaycastVehicle::FORWARD_RIGHT_UP(2, 0, 1);
 const IntVector3 RaycastVehicle::FORWARD_UP_RIGHT(2, 1, 0);
 
+/// Vehicle raycaster returning the wheel ray hits of the batched vehicle update in wheel order. Outside the update, casts against the world like Bullet's default vehicle raycaster.
+class BatchedVehicleRaycaster : public btVehicleRaycaster
+{
+public:
+    /// Construct.
+    explicit BatchedVehicleRaycaster(btDynamicsWorld* world) :
+        defaultRaycaster_(world)
+    {
+    }
+
+    /// Set the wheel ray hits to return, or null to cast against the world.
+    void SetHits(const PhysicsRaycastResult* hits, unsigned numHits)
+    {
+        hits_ = hits;
+        numHits_ = numHits;
+        nextHit_ = 0;
+    }
+
+    /// Cast a wheel ray.
+    void* castRay(const btVector3& from, const btVector3& to, btVehicleRaycasterResult& result) override
+    {
+        if (!hits_)
+            return defaultRaycaster_.castRay(from, to, result);
+        if (nextHit_ >= numHits_)
+            return nullptr;
+
+        // Like the default raycaster, only rigid bodies with contact response support the wheels
+        const PhysicsRaycastResult& hit = hits_[nextHit_++];
+        if (!hit.body_ || hit.body_->IsTrigger())
+            return nullptr;
+
+        result.m_hitPointInWorld = ToBtVector3(hit.position_);
+        result.m_hitNormalInWorld = ToBtVector3(hit.normal_);
+        result.m_hitNormalInWorld.normalize();
+        result.m_distFraction = hit.hitFraction_;
+        return hit.body_->GetBody();
+    }
+
+private:
+    /// Raycaster used outside the batched vehicle update.
+    btDefaultVehicleRaycaster defaultRaycaster_;
+    /// Wheel ray hits.
+    const PhysicsRaycastResult* hits_{};
+    /// Number of wheel ray hits.
+    unsigned numHits_{};
+    /// Index of the next wheel ray hit.
+    unsigned nextHit_{};
+};
+
 struct RaycastVehicleData
 {
-    RaycastVehicleData()
+    explicit RaycastVehicleData(RaycastVehicle* owner) :
+        owner_(owner)
     {
         vehicleRayCaster_ = nullptr;
         vehicle_ = nullptr;
@@ -58,12 +108,8 @@ struct RaycastVehicleData
         if (vehicle_)
         {
             if (physWorld_ && added_)
-            {
-                btDynamicsWorld* pbtDynWorld = physWorld_->GetWorld();
-                if (pbtDynWorld)
-                    pbtDynWorld->removeAction(vehicle_);
-                added_ = false;
-            }
+                physWorld_->RemoveRaycastVehicle(owner_);
+            added_ = false;
             delete vehicle_;
         }
         vehicle_ = nullptr;
@@ -81,26 +127,27 @@ struct RaycastVehicleData
         if (!pbtDynWorld)
             return;
 
-        // Delete old vehicle & action first
+        // Delete old vehicle & remove it from the batched update first
         delete vehicleRayCaster_;
         if (vehicle_)
         {
-            if (added_)
-                pbtDynWorld->removeAction(vehicle_);
+            if (physWorld_ && added_)
+                physWorld_->RemoveRaycastVehicle(owner_);
+            added_ = false;
             delete vehicle_;
         }
 
-        vehicleRayCaster_ = new btDefaultVehicleRaycaster(pbtDynWorld);
+        physWorld_ = pPhysWorld;
+        vehicleRayCaster_ = new BatchedVehicleRaycaster(pbtDynWorld);
         btRigidBody* bthullBody = body->GetBody();
         vehicle_ = new btRaycastVehicle(tuning_, bthullBody, vehicleRayCaster_);
         if (enabled)
         {
-            pbtDynWorld->addAction(vehicle_);
+            physWorld_->AddRaycastVehicle(owner_);
             added_ = true;
         }
 
         SetCoordinateSystem(coordinateSystem);
-        physWorld_ = pPhysWorld;
     }
 
     void SetCoordinateSystem(const IntVector3& coordinateSystem)
@@ -113,24 +160,22 @@ struct RaycastVehicleData
     {
         if (!physWorld_ || !vehicle_)
             return;
-        btDynamicsWorld* pbtDynWorld = physWorld_->GetWorld();
-        if (!pbtDynWorld)
-            return;
 
         if (enabled && !added_)
         {
-            pbtDynWorld->addAction(vehicle_);
+            physWorld_->AddRaycastVehicle(owner_);
             added_ = true;
         }
         else if (!enabled && added_)
         {
-            pbtDynWorld->removeAction(vehicle_);
+            physWorld_->RemoveRaycastVehicle(owner_);
             added_ = false;
         }
     }
 
+    RaycastVehicle* owner_;
     WeakPtr<PhysicsWorld> physWorld_;
-    btVehicleRaycaster* vehicleRayCaster_;
+    BatchedVehicleRaycaster* vehicleRayCaster_;
     btRaycastVehicle* vehicle_;
     btRaycastVehicle::btVehicleTuning tuning_;
     bool added_;
@@ -141,7 +186,7 @@ RaycastVehicle::RaycastVehicle(Context* context) :
 {
     // fixed update() for inputs and post update() to sync wheels for rendering
     SetUpdateEventMask(USE_FIXEDUPDATE | USE_FIXEDPOSTUPDATE | USE_POSTUPDATE);
-    vehicleData_ = new RaycastVehicleData();
+    vehicleData_ = new RaycastVehicleData(this);
     coordinateSystem_ = RIGHT_UP_FORWARD;
     wheelNodes_.Clear();
     activate_ = false;
@@ -413,6 +458,38 @@ void RaycastVehicle::UpdateWheelTransform(int wheel, bool interpolated)
     vehicle->updateWheelTransform(wheel, interpolated);
 }
 
+void RaycastVehicle::AddWheelRays(PODVector<PhysicsQuery>& queries)
+{
+    btRaycastVehicle* vehicle = vehicleData_->Get();
+    if (!vehicle)
+        return;
+
+    // Same rays as btRaycastVehicle::rayCast() casts from the updated wheel hardpoints
+    for (int i = 0; i < vehicle->getNumWheels(); ++i)
+    {
+        btWheelInfo& wheel = vehicle->getWheelInfo(i);
+        vehicle->updateWheelTransformsWS(wheel, false);
+
+        PhysicsQuery query;
+        query.start_ = ToVector3(wheel.m_raycastInfo.m_hardPointWS);
+        query.end_ = ToVector3(wheel.m_raycastInfo.m_hardPointWS +
+            wheel.m_raycastInfo.m_wheelDirectionWS * (wheel.getSuspensionRestLength() + wheel.m_wheelsRadius));
+        queries.Push(query);
+    }
+}
+
+void RaycastVehicle::UpdateVehicle(const PhysicsRaycastResult* wheelHits, float timeStep)
+{
+    btRaycastVehicle* vehicle = vehicleData_->Get();
+    if (!vehicle)
+        return;
+
+    BatchedVehicleRaycaster* raycaster = vehicleData_->vehicleRayCaster_;
+    raycaster->SetHits(wheelHits, (unsigned)vehicle->getNumWheels());
+    vehicle->updateVehicle(timeStep);
+    raycaster->SetHits(nullptr, 0);
+}
+
 Vector3 RaycastVehicle::GetWheelPosition(int wheel)
 {
     btRaycastVehicle* vehicle = vehicleData_->Get();
@@ -28,6 +28,8 @@
 
 namespace Urho3D
 {
+struct PhysicsQuery;
+struct PhysicsRaycastResult;
 struct RaycastVehicleData;
 
 class URHO3D_API RaycastVehicle : public LogicComponent
@@ -56,6 +58,12 @@ public:
     void ResetSuspension();
     /// Update transform for particular wheel.
     void UpdateWheelTransform(int wheel, bool interpolated);
+    /// Update the wheel transforms and append the suspension rays of the wheels to a query batch. Called by PhysicsWorld.
+    /// @nobind
+    void AddWheelRays(PODVector<PhysicsQuery>& queries);
+    /// Update the suspension and friction using the wheel ray hits in wheel order. Called by PhysicsWorld, possibly from a worker thread.
+    /// @nobind
+    void UpdateVehicle(const PhysicsRaycastResult* wheelHits, float timeStep);
     /// Set steering value of particular wheel.
     void SetSteeringValue(int wheel, float steeringValue);
     /// Set suspension stiffness for particular wheel.
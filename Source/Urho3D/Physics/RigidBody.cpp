@@ -71,13 +71,23 @@ RigidBody::RigidBody(Context* context) :
     collisionEventMode_(COLLISION_ACTIVE),
     lastPosition_(Vector3::ZERO),
     lastRotation_(Quaternion::IDENTITY),
+    prevSnapshotPosition_(Vector3::ZERO),
+    prevSnapshotRotation_(Quaternion::IDENTITY),
+    snapshotPosition_(Vector3::ZERO),
+    snapshotRotation_(Quaternion::IDENTITY),
+    snapshotStep_(0),
     kinematic_(false),
     trigger_(false),
+    reportContacts_(false),
     useGravity_(true),
     readdBody_(false),
     inWorld_(false),
     enableMassUpdate_(true),
-    hasSimulated_(false)
+    hasSimulated_(false),
+    snapshotValid_(false),
+    interpolating_(false),
+    streamedOut_(false),
+    staticMerged_(false)
 {
     compoundShape_ = new btCompoundShape();
     shiftedCompoundShape_ = new btCompoundShape();
@@ -122,6 +132,7 @@ void RigidBody::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Network Angular Velocity", GetNetAngularVelocityAttr, SetNetAngularVelocityAttr, PODVector<unsigned char>,
         Variant::emptyBuffer, AM_NET | AM_LATESTDATA | AM_NOEDIT);
     URHO3D_ENUM_ATTRIBUTE_EX("Collision Event Mode", collisionEventMode_, MarkBodyDirty, collisionEventModeNames, COLLISION_ACTIVE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Report Contacts", GetReportContacts, SetReportContacts, bool, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Use Gravity", GetUseGravity, SetUseGravity, bool, true, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Is Kinematic", bool, kinematic_, MarkBodyDirty, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Is Trigger", bool, trigger_, MarkBodyDirty, false, AM_DEFAULT);
@@ -136,6 +147,8 @@ void RigidBody::ApplyAttributes()
 
 void RigidBody::OnSetEnabled()
 {
+    SplitStaticCompound();
+
     bool enabled = IsEnabledEffective();
 
     if (enabled && !inWorld_)
@@ -166,29 +179,16 @@ void RigidBody::setWorldTransform(const btTransform& worldTrans)
 
     Quaternion newWorldRotation = ToQuaternion(worldTrans.getRotation());
     Vector3 newWorldPosition = ToVector3(worldTrans.getOrigin()) - newWorldRotation * centerOfMass_;
-    RigidBody* parentRigidBody = nullptr;
 
     // It is possible that the RigidBody component has been kept alive via a shared pointer,
     // while its scene node has already been destroyed
     if (node_)
     {
-        // If the rigid body is parented to another rigid body, can not set the transform immediately.
-        // In that case store it to PhysicsWorld for delayed assignment
-        Node* parent = node_->GetParent();
-        if (parent != GetScene() && parent)
-            parentRigidBody = parent->GetComponent<RigidBody>();
-
-        if (!parentRigidBody)
-            ApplyWorldTransform(newWorldPosition, newWorldRotation);
+        // With snapshot interpolation the node transform is assigned by the physics world after the substep loop
+        if (physicsWorld_->IsSnapshotInterpolating())
+            StoreSnapshot(newWorldPosition, newWorldRotation);
         else
-        {
-            DelayedWorldTransform delayed;
-            delayed.rigidBody_ = this;
-            delayed.parentRigidBody_ = parentRigidBody;
-            delayed.worldPosition_ = newWorldPosition;
-            delayed.worldRotation_ = newWorldRotation;
-            physicsWorld_->AddDelayedWorldTransform(delayed);
-        }
+            ApplySimulatedTransform(newWorldPosition, newWorldRotation);
 
         MarkNetworkUpdate();
     }
@@ -241,6 +241,7 @@ void RigidBody::SetPosition(const Vector3& position)
             body_->setInterpolationWorldTransform(interpTrans);
         }
 
+        snapshotValid_ = false;
         Activate();
         MarkNetworkUpdate();
     }
@@ -267,6 +268,7 @@ void RigidBody::SetRotation(const Quaternion& rotation)
 
         body_->updateInertiaTensor();
 
+        snapshotValid_ = false;
         Activate();
         MarkNetworkUpdate();
     }
@@ -290,6 +292,7 @@ void RigidBody::SetTransform(const Vector3& position, const Quaternion& rotation
 
         body_->updateInertiaTensor();
 
+        snapshotValid_ = false;
         Activate();
         MarkNetworkUpdate();
     }
@@ -375,6 +378,7 @@ void RigidBody::SetFriction(float friction)
 {
     if (body_)
     {
+        SplitStaticCompound();
         body_->setFriction(friction);
         MarkNetworkUpdate();
     }
@@ -384,6 +388,7 @@ void RigidBody::SetAnisotropicFriction(const Vector3& friction)
 {
     if (body_)
     {
+        SplitStaticCompound();
         body_->setAnisotropicFriction(ToBtVector3(friction));
         MarkNetworkUpdate();
     }
@@ -393,6 +398,7 @@ void RigidBody::SetRollingFriction(float friction)
 {
     if (body_)
     {
+        SplitStaticCompound();
         body_->setRollingFriction(friction);
         MarkNetworkUpdate();
     }
@@ -402,6 +408,7 @@ void RigidBody::SetRestitution(float restitution)
 {
     if (body_)
     {
+        SplitStaticCompound();
         body_->setRestitution(restitution);
         MarkNetworkUpdate();
     }
@@ -509,10 +516,23 @@ void RigidBody::SetCollisionLayerAndMask(unsigned layer, unsigned mask)
 
 void RigidBody::SetCollisionEventMode(CollisionEventMode mode)
 {
+    // The merged bodies do not report collisions
+    if (mode != COLLISION_NEVER)
+        SplitStaticCompound();
+
     collisionEventMode_ = mode;
     MarkNetworkUpdate();
 }
 
+void RigidBody::SetReportContacts(bool enable)
+{
+    if (enable)
+        SplitStaticCompound();
+
+    reportContacts_ = enable;
+    MarkNetworkUpdate();
+}
+
 void RigidBody::ApplyForce(const Vector3& force)
 {
     if (body_ && force != Vector3::ZERO)
@@ -575,13 +595,18 @@ void RigidBody::ResetForces()
 
 void RigidBody::Activate()
 {
+    SplitStaticCompound();
+
+    if (streamedOut_ && physicsWorld_)
+        physicsWorld_->StreamInBody(this);
+
     if (body_ && mass_ > 0.0f)
         body_->activate(true);
 }
 
 void RigidBody::ReAddBodyToWorld()
 {
-    if (body_ && inWorld_)
+    if (body_ && (inWorld_ || streamedOut_ || staticMerged_))
         AddBodyToWorld();
 }
 
@@ -736,8 +761,82 @@ void RigidBody::ApplyWorldTransform(const Vector3& newWorldPosition, const Quate
     physicsWorld_->SetApplyingTransforms(false);
 }
 
+bool RigidBody::ApplySnapshotInterpolation(float t, unsigned step)
+{
+    // A direct transform assignment since the snapshot takes precedence
+    if (!snapshotValid_ || !node_)
+    {
+        interpolating_ = false;
+        return false;
+    }
+
+    if (snapshotStep_ != step)
+    {
+        // Did not move in the latest step, so rest at the last snapshot
+        ApplySimulatedTransform(snapshotPosition_, snapshotRotation_);
+        interpolating_ = false;
+        return false;
+    }
+
+    ApplySimulatedTransform(prevSnapshotPosition_.Lerp(snapshotPosition_, t),
+        prevSnapshotRotation_.Nlerp(snapshotRotation_, t, true));
+    return true;
+}
+
+void RigidBody::ApplySimulatedTransform(const Vector3& newWorldPosition, const Quaternion& newWorldRotation)
+{
+    // If the rigid body is parented to another rigid body, can not set the transform immediately.
+    // In that case store it to PhysicsWorld for delayed assignment
+    RigidBody* parentRigidBody = nullptr;
+    Node* parent = node_->GetParent();
+    if (parent != GetScene() && parent)
+        parentRigidBody = parent->GetComponent<RigidBody>();
+
+    if (!parentRigidBody)
+        ApplyWorldTransform(newWorldPosition, newWorldRotation);
+    else
+    {
+        DelayedWorldTransform delayed;
+        delayed.rigidBody_ = this;
+        delayed.parentRigidBody_ = parentRigidBody;
+        delayed.worldPosition_ = newWorldPosition;
+        delayed.worldRotation_ = newWorldRotation;
+        physicsWorld_->AddDelayedWorldTransform(delayed);
+    }
+}
+
+void RigidBody::StoreSnapshot(const Vector3& newWorldPosition, const Quaternion& newWorldRotation)
+{
+    // The previous snapshot is the pose of the previous step also when the body did not move in it. After a direct
+    // transform assignment there is nothing to interpolate from
+    if (snapshotValid_)
+    {
+        prevSnapshotPosition_ = snapshotPosition_;
+        prevSnapshotRotation_ = snapshotRotation_;
+    }
+    else
+    {
+        prevSnapshotPosition_ = newWorldPosition;
+        prevSnapshotRotation_ = newWorldRotation;
+    }
+
+    snapshotPosition_ = newWorldPosition;
+    snapshotRotation_ = newWorldRotation;
+    snapshotStep_ = physicsWorld_->GetSnapshotStep();
+    snapshotValid_ = true;
+
+    if (!interpolating_)
+    {
+        physicsWorld_->AddInterpolatedBody(this);
+        interpolating_ = true;
+    }
+}
+
 void RigidBody::UpdateMass()
 {
+    // The static compound refers to the collision shapes, which may be about to change
+    SplitStaticCompound();
+
     if (!body_ || !enableMassUpdate_)
         return;
 
@@ -862,6 +961,7 @@ const PODVector<unsigned char>& RigidBody::GetNetAngularVelocityAttr() const
 
 void RigidBody::AddConstraint(Constraint* constraint)
 {
+    SplitStaticCompound();
     constraints_.Push(constraint);
 }
 
@@ -882,8 +982,16 @@ void RigidBody::ReleaseBody()
         for (PODVector<Constraint*>::Iterator i = constraints.Begin(); i != constraints.End(); ++i)
             (*i)->ReleaseConstraint();
 
+        SplitStaticCompound();
         RemoveBodyFromWorld();
 
+        if (streamedOut_)
+        {
+            if (physicsWorld_)
+                physicsWorld_->RemoveStreamedOutBody(this);
+            streamedOut_ = false;
+        }
+
         body_.Reset();
     }
 }
@@ -946,6 +1054,7 @@ void RigidBody::OnSceneSet(Scene* scene)
 
         if (physicsWorld_)
             physicsWorld_->RemoveRigidBody(this);
+        interpolating_ = false;
     }
 }
 
@@ -959,6 +1068,14 @@ void RigidBody::AddBodyToWorld()
     if (mass_ < 0.0f)
         mass_ = 0.0f;
 
+    if (streamedOut_)
+    {
+        physicsWorld_->RemoveStreamedOutBody(this);
+        streamedOut_ = false;
+    }
+
+    SplitStaticCompound();
+
     if (body_)
         RemoveBodyFromWorld();
     else
@@ -1025,6 +1142,98 @@ void RigidBody::AddBodyToWorld()
     }
 }
 
+bool RigidBody::CanStreamOut() const
+{
+    return body_ && inWorld_ && mass_ > 0.0f && !kinematic_ && constraints_.Empty() &&
+        body_->getActivationState() == ISLAND_SLEEPING;
+}
+
+void RigidBody::SetStreamedOut(bool enable)
+{
+    if (enable == streamedOut_ || !physicsWorld_ || !body_)
+        return;
+
+    btDiscreteDynamicsWorld* world = physicsWorld_->GetWorld();
+    if (enable)
+    {
+        if (!inWorld_)
+            return;
+
+        // Unlike RemoveBodyFromWorld(), keeps the flags, velocities and sleeping state so that the body resumes as it was
+        world->removeRigidBody(body_.Get());
+        inWorld_ = false;
+        streamedOut_ = true;
+    }
+    else
+    {
+        streamedOut_ = false;
+
+        // If disabled meanwhile, OnSetEnabled() adds the body back instead
+        if (!IsEnabledEffective())
+            return;
+
+        world->addRigidBody(body_.Get(), (short)collisionLayer_, (short)collisionMask_);
+        inWorld_ = true;
+    }
+}
+
+bool RigidBody::CanMergeStatic() const
+{
+    if (!body_ || !inWorld_ || mass_ > 0.0f || kinematic_ || trigger_ || collisionEventMode_ != COLLISION_NEVER ||
+        reportContacts_ || !constraints_.Empty() || body_->hasAnisotropicFriction())
+        return false;
+
+    // Hits on a static compound are resolved to the merged bodies by compound child index, which is only reported for convex children
+    const btCollisionShape* shape = body_->getCollisionShape();
+    if (!shape->isCompound())
+        return shape->isConvex();
+
+    auto* compound = static_cast<const btCompoundShape*>(shape);
+    if (!compound->getNumChildShapes())
+        return false;
+    for (int i = 0; i < compound->getNumChildShapes(); ++i)
+    {
+        if (!compound->getChildShape(i)->isConvex())
+            return false;
+    }
+
+    return true;
+}
+
+void RigidBody::SetStaticMerged(bool enable)
+{
+    if (enable == staticMerged_ || !physicsWorld_ || !body_)
+        return;
+
+    btDiscreteDynamicsWorld* world = physicsWorld_->GetWorld();
+    if (enable)
+    {
+        if (!inWorld_)
+            return;
+
+        world->removeRigidBody(body_.Get());
+        inWorld_ = false;
+        staticMerged_ = true;
+    }
+    else
+    {
+        staticMerged_ = false;
+
+        // If disabled meanwhile, OnSetEnabled() adds the body back instead
+        if (!IsEnabledEffective())
+            return;
+
+        world->addRigidBody(body_.Get(), (short)collisionLayer_, (short)collisionMask_);
+        inWorld_ = true;
+    }
+}
+
+void RigidBody::SplitStaticCompound()
+{
+    if (staticMerged_ && physicsWorld_)
+        physicsWorld_->RemoveStaticCompoundBody(this);
+}
+
 void RigidBody::RemoveBodyFromWorld()
 {
     if (physicsWorld_ && body_ && inWorld_)
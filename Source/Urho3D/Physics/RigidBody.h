@@ -154,6 +154,9 @@ public:
     /// Set collision event signaling mode. Default is to signal when rigid bodies are active.
     /// @property
     void SetCollisionEventMode(CollisionEventMode mode);
+    /// Set whether the body's collisions are written to the contact stream of the physics world. Default false.
+    /// @property
+    void SetReportContacts(bool enable);
     /// Apply force to center of mass.
     void ApplyForce(const Vector3& force);
     /// Apply force at local position.
@@ -168,7 +171,7 @@ public:
     void ApplyTorqueImpulse(const Vector3& torque);
     /// Reset accumulated forces.
     void ResetForces();
-    /// Activate rigid body if it was resting.
+    /// Activate rigid body if it was resting. Adds it back to the physics world if it was streamed out.
     void Activate();
     /// Readd rigid body to the physics world to clean up internal state like stale contacts.
     void ReAddBodyToWorld();
@@ -268,6 +271,14 @@ public:
     /// @property
     bool IsActive() const;
 
+    /// Return whether rigid body has been streamed out of the physics world for sleeping far from the streaming focus.
+    /// @property
+    bool IsStreamedOut() const { return streamedOut_; }
+
+    /// Return whether rigid body has been merged into a static compound of the physics world.
+    /// @property
+    bool IsStaticMerged() const { return staticMerged_; }
+
     /// Return collision layer.
     /// @property
     unsigned GetCollisionLayer() const { return collisionLayer_; }
@@ -280,11 +291,25 @@ public:
     /// @property
     CollisionEventMode GetCollisionEventMode() const { return collisionEventMode_; }
 
+    /// Return whether the body's collisions are written to the contact stream of the physics world.
+    /// @property
+    bool GetReportContacts() const { return reportContacts_; }
+
     /// Return colliding rigid bodies from the last simulation step. Only returns collisions that were sent as events (depends on collision event mode) and excludes e.g. static-static collisions.
     void GetCollidingBodies(PODVector<RigidBody*>& result) const;
 
     /// Apply new world transform after a simulation step. Called internally.
     void ApplyWorldTransform(const Vector3& newWorldPosition, const Quaternion& newWorldRotation);
+    /// Apply the world transform interpolated between the last two simulation step snapshots. Return false if the body has no snapshot from the latest step, in which case its last snapshot is applied and it stops being interpolated. Called internally.
+    bool ApplySnapshotInterpolation(float t, unsigned step);
+    /// Return whether can be streamed out of the physics world: is a sleeping dynamic body in the world without constraints. Called internally.
+    bool CanStreamOut() const;
+    /// Remove the Bullet rigid body from the physics world keeping its state, or add it back. Called internally.
+    void SetStreamedOut(bool enable);
+    /// Return whether can be merged into a static compound: is a static body in the world with only convex collision shapes, no constraints and no collision events or contact reports. Called internally.
+    bool CanMergeStatic() const;
+    /// Remove the Bullet rigid body from the physics world when merged into a static compound, or add it back. Called internally.
+    void SetStaticMerged(bool enable);
     /// Update mass and inertia to the Bullet rigid body. Readd body to world if necessary: if was in world and the Bullet collision shape to use changed.
     void UpdateMass();
     /// Update gravity parameters to the Bullet rigid body.
@@ -313,12 +338,18 @@ private:
     void AddBodyToWorld();
     /// Remove the rigid body from the physics world.
     void RemoveBodyFromWorld();
+    /// Split the static compound the body has been merged into before modifying the body.
+    void SplitStaticCompound();
     /// Handle SmoothedTransform target position update.
     void HandleTargetPosition(StringHash eventType, VariantMap& eventData);
     /// Handle SmoothedTransform target rotation update.
     void HandleTargetRotation(StringHash eventType, VariantMap& eventData);
     /// Mark body dirty.
     void MarkBodyDirty() { readdBody_ = true; }
+    /// Apply a simulated world transform to the node, or to the physics world's delayed transforms if parented to another rigid body.
+    void ApplySimulatedTransform(const Vector3& newWorldPosition, const Quaternion& newWorldRotation);
+    /// Store the world transform of a simulation step for snapshot interpolation.
+    void StoreSnapshot(const Vector3& newWorldPosition, const Quaternion& newWorldRotation);
 
     /// Bullet rigid body.
     UniquePtr<btRigidBody> body_;
@@ -350,10 +381,22 @@ private:
     mutable Vector3 lastPosition_;
     /// Last interpolated rotation from the simulation.
     mutable Quaternion lastRotation_;
+    /// World position of the simulation step before the latest snapshot.
+    Vector3 prevSnapshotPosition_;
+    /// World rotation of the simulation step before the latest snapshot.
+    Quaternion prevSnapshotRotation_;
+    /// World position of the latest snapshot.
+    Vector3 snapshotPosition_;
+    /// World rotation of the latest snapshot.
+    Quaternion snapshotRotation_;
+    /// Simulation step of the latest snapshot.
+    unsigned snapshotStep_;
     /// Kinematic flag.
     bool kinematic_;
     /// Trigger flag.
     bool trigger_;
+    /// Contact reporting flag.
+    bool reportContacts_;
     /// Use gravity flag.
     bool useGravity_;
     /// Readd body to world flag.
@@ -364,6 +407,14 @@ private:
     bool enableMassUpdate_;
     /// Internal flag whether has simulated at least once.
     mutable bool hasSimulated_;
+    /// Snapshots valid flag. Cleared when the transform is set directly, so that the next step does not interpolate from the old position.
+    bool snapshotValid_;
+    /// Being interpolated by the physics world flag.
+    bool interpolating_;
+    /// Streamed out of the physics world flag.
+    bool streamedOut_;
+    /// Merged into a static compound flag.
+    bool staticMerged_;
 };
 
 }
@@ -23,7 +23,9 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Renderer.h"
@@ -45,6 +47,10 @@ extern const char* SUBSYSTEM_CATEGORY;
 static const Vector2 DEFAULT_GRAVITY(0.0f, -9.81f);
 static const int DEFAULT_VELOCITY_ITERATIONS = 8;
 static const int DEFAULT_POSITION_ITERATIONS = 3;
+/// Minimum number of batch queries executed by one work item.
+static const unsigned MIN_QUERIES_PER_ITEM = 16;
+/// Number of work items per worker thread a query batch is split to, for load balancing.
+static const unsigned QUERY_ITEMS_PER_THREAD = 4;
 
 PhysicsWorld2D::PhysicsWorld2D(Context* context) :
     Component(context),
@@ -65,6 +71,8 @@ PhysicsWorld2D::PhysicsWorld2D(Context* context) :
 
 PhysicsWorld2D::~PhysicsWorld2D()
 {
+    CompleteQueries();
+
     for (unsigned i = 0; i < rigidBodies_.Size(); ++i)
         if (rigidBodies_[i])
             rigidBodies_[i]->ReleaseBody();
@@ -115,6 +123,10 @@ void PhysicsWorld2D::BeginContact(b2Contact* contact)
     if (!fixtureA || !fixtureB)
         return;
 
+    // Skip the contact if its events would not be heard, building the contact info is not free with large numbers of bodies
+    if (!HasContactReceivers(contact, E_PHYSICSBEGINCONTACT2D, E_NODEBEGINCONTACT2D))
+        return;
+
     beginContactInfos_.Push(ContactInfo(contact));
 }
 
@@ -128,6 +140,9 @@ void PhysicsWorld2D::EndContact(b2Contact* contact)
     if (!fixtureA || !fixtureB)
         return;
 
+    if (!HasContactReceivers(contact, E_PHYSICSENDCONTACT2D, E_NODEENDCONTACT2D))
+        return;
+
     endContactInfos_.Push(ContactInfo(contact));
 }
 
@@ -138,30 +153,49 @@ void PhysicsWorld2D::PreSolve(b2Contact* contact, const b2Manifold* oldManifold)
     if (!fixtureA || !fixtureB)
         return;
 
+    // PreSolve is called for every touching contact on each step inside the solver, so do not build the event data for
+    // contacts nobody listens to
+    auto* bodyA = (RigidBody2D*)(fixtureA->GetBody()->GetUserData());
+    auto* bodyB = (RigidBody2D*)(fixtureB->GetBody()->GetUserData());
+    Node* nodeA = bodyA->GetNode();
+    Node* nodeB = bodyB->GetNode();
+    bool sendWorldEvent = HasEventReceivers(E_PHYSICSUPDATECONTACT2D);
+    bool sendNodeEventA = nodeA && nodeA->HasEventReceivers(E_NODEUPDATECONTACT2D);
+    bool sendNodeEventB = nodeB && nodeB->HasEventReceivers(E_NODEUPDATECONTACT2D);
+    if (!sendWorldEvent && !sendNodeEventA && !sendNodeEventB)
+        return;
+
     ContactInfo contactInfo(contact);
+    const PODVector<unsigned char>& contacts = contactInfo.Serialize(contacts_);
 
     // Send global event
     VariantMap& eventData = GetEventDataMap();
-    eventData[PhysicsUpdateContact2D::P_WORLD] = this;
-    eventData[PhysicsUpdateContact2D::P_ENABLED] = contact->IsEnabled();
-
-    eventData[PhysicsUpdateContact2D::P_BODYA] = contactInfo.bodyA_.Get();
-    eventData[PhysicsUpdateContact2D::P_BODYB] = contactInfo.bodyB_.Get();
-    eventData[PhysicsUpdateContact2D::P_NODEA] = contactInfo.nodeA_.Get();
-    eventData[PhysicsUpdateContact2D::P_NODEB] = contactInfo.nodeB_.Get();
-    eventData[PhysicsUpdateContact2D::P_CONTACTS] = contactInfo.Serialize(contacts_);
-    eventData[PhysicsUpdateContact2D::P_SHAPEA] = contactInfo.shapeA_.Get();
-    eventData[PhysicsUpdateContact2D::P_SHAPEB] = contactInfo.shapeB_.Get();
+    if (sendWorldEvent)
+    {
+        eventData[PhysicsUpdateContact2D::P_WORLD] = this;
+        eventData[PhysicsUpdateContact2D::P_ENABLED] = contact->IsEnabled();
+
+        eventData[PhysicsUpdateContact2D::P_BODYA] = contactInfo.bodyA_.Get();
+        eventData[PhysicsUpdateContact2D::P_BODYB] = contactInfo.bodyB_.Get();
+        eventData[PhysicsUpdateContact2D::P_NODEA] = contactInfo.nodeA_.Get();
+        eventData[PhysicsUpdateContact2D::P_NODEB] = contactInfo.nodeB_.Get();
+        eventData[PhysicsUpdateContact2D::P_CONTACTS] = contacts;
+        eventData[PhysicsUpdateContact2D::P_SHAPEA] = contactInfo.shapeA_.Get();
+        eventData[PhysicsUpdateContact2D::P_SHAPEB] = contactInfo.shapeB_.Get();
+
+        SendEvent(E_PHYSICSUPDATECONTACT2D, eventData);
+        contact->SetEnabled(eventData[PhysicsUpdateContact2D::P_ENABLED].GetBool());
+        eventData.Clear();
+    }
 
-    SendEvent(E_PHYSICSUPDATECONTACT2D, eventData);
-    contact->SetEnabled(eventData[PhysicsUpdateContact2D::P_ENABLED].GetBool());
-    eventData.Clear();
+    if (!sendNodeEventA && !sendNodeEventB)
+        return;
 
     // Send node event
     eventData[NodeUpdateContact2D::P_ENABLED] = contact->IsEnabled();
-    eventData[NodeUpdateContact2D::P_CONTACTS] = contactInfo.Serialize(contacts_);
+    eventData[NodeUpdateContact2D::P_CONTACTS] = contacts;
 
-    if (contactInfo.nodeA_)
+    if (sendNodeEventA && contactInfo.nodeA_)
     {
         eventData[NodeUpdateContact2D::P_BODY] = contactInfo.bodyA_.Get();
         eventData[NodeUpdateContact2D::P_OTHERNODE] = contactInfo.nodeB_.Get();
@@ -172,7 +206,7 @@ void PhysicsWorld2D::PreSolve(b2Contact* contact, const b2Manifold* oldManifold)
         contactInfo.nodeA_->SendEvent(E_NODEUPDATECONTACT2D, eventData);
     }
 
-    if (contactInfo.nodeB_)
+    if (sendNodeEventB && contactInfo.nodeB_)
     {
         eventData[NodeUpdateContact2D::P_BODY] = contactInfo.bodyB_.Get();
         eventData[NodeUpdateContact2D::P_OTHERNODE] = contactInfo.nodeA_.Get();
@@ -287,10 +321,20 @@ void PhysicsWorld2D::Update(float timeStep)
     eventData[P_TIMESTEP] = timeStep;
     SendEvent(E_PHYSICSPRESTEP, eventData);
 
+    // Pending query batches read the broadphase, so complete them before modifying it
+    CompleteQueries();
+
     physicsStepping_ = true;
     world_->Step(timeStep, velocityIterations_, positionIterations_);
     physicsStepping_ = false;
 
+    // Start the query batches submitted during the step
+    for (const SharedPtr<PhysicsQueryBatch2D>& batch : queryBatches_)
+    {
+        if (!batch->started_)
+            StartQueries(batch);
+    }
+
     // Apply world transforms. Unparented transforms first
     for (unsigned i = 0; i < rigidBodies_.Size();)
     {
@@ -519,12 +563,12 @@ public:
     // Called for each fixture found in the query.
     float32 ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float32 fraction) override
     {
-        // Ignore sensor
+        // Ignore sensor. Returning -1 ignores the fixture without changing the ray length
         if (fixture->IsSensor())
-            return true;
+            return -1.0f;
 
         if ((fixture->GetFilterData().maskBits & collisionMask_) == 0)
-            return true;
+            return -1.0f;
 
         float distance = (ToVector2(point) - startPoint_).Length();
         if (distance < minDistance_)
@@ -537,7 +581,8 @@ public:
             result_.body_ = (RigidBody2D*)(fixture->GetBody()->GetUserData());
         }
 
-        return true;
+        // Clip the ray to the hit so that farther fixtures are not tested
+        return fraction;
     }
 
 private:
@@ -677,6 +722,174 @@ void PhysicsWorld2D::GetRigidBodies(PODVector<RigidBody2D*>& results, const Rect
     world_->QueryAABB(&callback, b2Aabb);
 }
 
+bool PhysicsQueryBatch2D::IsCompleted() const
+{
+    if (!started_)
+        return false;
+
+    for (const SharedPtr<WorkItem>& item : items_)
+    {
+        if (!item->completed_)
+            return false;
+    }
+
+    return true;
+}
+
+void PhysicsWorld2D::SubmitQueries(PhysicsQueryBatch2D* batch)
+{
+    if (!batch)
+        return;
+
+    if (batch->pending_)
+    {
+        URHO3D_LOGERROR("Physics query batch is already pending");
+        return;
+    }
+
+    if (queryBatches_.Empty())
+        SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(PhysicsWorld2D, HandleBeginFrame));
+
+    batch->pending_ = true;
+    batch->started_ = false;
+    queryBatches_.Push(SharedPtr<PhysicsQueryBatch2D>(batch));
+
+    // The broadphase is being updated during the step, so start only after it
+    if (!physicsStepping_)
+        StartQueries(batch);
+}
+
+void PhysicsWorld2D::ExecuteQueries(PhysicsQueryBatch2D* batch)
+{
+    if (!batch)
+        return;
+
+    if (batch->pending_)
+    {
+        URHO3D_LOGERROR("Can not execute a pending physics query batch");
+        return;
+    }
+
+    URHO3D_PROFILE(ExecutePhysicsQueries2D);
+
+    StartQueries(batch);
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    for (const SharedPtr<WorkItem>& item : batch->items_)
+    {
+        if (queue)
+            queue->Wait(item);
+        else
+            item->workFunction_(item, 0);
+    }
+    batch->items_.Clear();
+}
+
+void PhysicsWorld2D::CompleteQueries()
+{
+    if (queryBatches_.Empty())
+        return;
+
+    URHO3D_PROFILE(CompletePhysicsQueries2D);
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    for (const SharedPtr<PhysicsQueryBatch2D>& batch : queryBatches_)
+    {
+        if (!batch->started_)
+            StartQueries(batch);
+
+        for (const SharedPtr<WorkItem>& item : batch->items_)
+        {
+            if (queue)
+                queue->Wait(item);
+            else
+                item->workFunction_(item, 0);
+        }
+
+        batch->items_.Clear();
+        batch->pending_ = false;
+    }
+
+    queryBatches_.Clear();
+    UnsubscribeFromEvent(E_BEGINFRAME);
+}
+
+void PhysicsWorld2D::StartQueries(PhysicsQueryBatch2D* batch)
+{
+    unsigned numQueries = batch->queries_.Size();
+    batch->results_.Resize(numQueries);
+    batch->bodies_.Resize(numQueries);
+    batch->items_.Clear();
+    batch->world_ = this;
+    batch->started_ = true;
+
+    if (!numQueries)
+        return;
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    unsigned numItems = queue ? Max(queue->GetNumThreads(), 1U) * QUERY_ITEMS_PER_THREAD : 1;
+    unsigned queriesPerItem = Max((numQueries + numItems - 1) / numItems, MIN_QUERIES_PER_ITEM);
+
+    PhysicsQuery2D* start = batch->queries_.Buffer();
+    PhysicsQuery2D* end = start + numQueries;
+    while (start < end)
+    {
+        PhysicsQuery2D* itemEnd = start + Min(queriesPerItem, (unsigned)(end - start));
+
+        // Not pooled, as pooled items may be reset on the next frame begin before the batch has been reaped
+        SharedPtr<WorkItem> item(new WorkItem());
+        item->workFunction_ = ExecuteQueriesWork;
+        item->start_ = start;
+        item->end_ = itemEnd;
+        item->aux_ = batch;
+        batch->items_.Push(item);
+        if (queue)
+            queue->AddWorkItem(item);
+
+        start = itemEnd;
+    }
+}
+
+void PhysicsWorld2D::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
+{
+    CompleteQueries();
+}
+
+void PhysicsWorld2D::ExecuteQueriesWork(const WorkItem* item, unsigned threadIndex)
+{
+    // The Box2D world queries only read the broadphase tree and the fixtures, so they can run concurrently while the world
+    // is not stepped or modified
+    auto* batch = reinterpret_cast<PhysicsQueryBatch2D*>(item->aux_);
+    auto* start = reinterpret_cast<PhysicsQuery2D*>(item->start_);
+    auto* end = reinterpret_cast<PhysicsQuery2D*>(item->end_);
+    const b2World* world = batch->world_->world_.Get();
+    unsigned index = (unsigned)(start - batch->queries_.Buffer());
+
+    for (PhysicsQuery2D* query = start; query < end; ++query, ++index)
+    {
+        PhysicsRaycastResult2D& result = batch->results_[index];
+        PODVector<RigidBody2D*>& bodies = batch->bodies_[index];
+        result = PhysicsRaycastResult2D();
+        bodies.Clear();
+
+        if (query->box_)
+        {
+            AabbQueryCallback callback(bodies, query->collisionMask_);
+
+            b2AABB b2Aabb;
+            Vector2 delta(M_EPSILON, M_EPSILON);
+            b2Aabb.lowerBound = ToB2Vec2(VectorMin(query->start_, query->end_) - delta);
+            b2Aabb.upperBound = ToB2Vec2(VectorMax(query->start_, query->end_) + delta);
+            world->QueryAABB(&callback, b2Aabb);
+        }
+        else if (query->start_ != query->end_)
+        {
+            SingleRayCastCallback callback(result, query->start_, query->collisionMask_);
+            world->RayCast(&callback, ToB2Vec2(query->start_), ToB2Vec2(query->end_));
+        }
+    }
+}
+
 bool PhysicsWorld2D::GetAllowSleeping() const
 {
     return world_->GetAllowSleeping();
@@ -733,19 +946,25 @@ void PhysicsWorld2D::SendBeginContactEvents()
     for (unsigned i = 0; i < beginContactInfos_.Size(); ++i)
     {
         ContactInfo& contactInfo = beginContactInfos_[i];
-        eventData[P_BODYA] = contactInfo.bodyA_.Get();
-        eventData[P_BODYB] = contactInfo.bodyB_.Get();
-        eventData[P_NODEA] = contactInfo.nodeA_.Get();
-        eventData[P_NODEB] = contactInfo.nodeB_.Get();
-        eventData[P_CONTACTS] = contactInfo.Serialize(contacts_);
-        eventData[P_SHAPEA] = contactInfo.shapeA_.Get();
-        eventData[P_SHAPEB] = contactInfo.shapeB_.Get();
+        const PODVector<unsigned char>& contacts = contactInfo.Serialize(contacts_);
 
-        SendEvent(E_PHYSICSBEGINCONTACT2D, eventData);
+        // Receivers may have unsubscribed or been removed by the handlers of earlier contacts
+        if (HasEventReceivers(E_PHYSICSBEGINCONTACT2D))
+        {
+            eventData[P_BODYA] = contactInfo.bodyA_.Get();
+            eventData[P_BODYB] = contactInfo.bodyB_.Get();
+            eventData[P_NODEA] = contactInfo.nodeA_.Get();
+            eventData[P_NODEB] = contactInfo.nodeB_.Get();
+            eventData[P_CONTACTS] = contacts;
+            eventData[P_SHAPEA] = contactInfo.shapeA_.Get();
+            eventData[P_SHAPEB] = contactInfo.shapeB_.Get();
+
+            SendEvent(E_PHYSICSBEGINCONTACT2D, eventData);
+        }
 
-        nodeEventData[NodeBeginContact2D::P_CONTACTS] = contactInfo.Serialize(contacts_);
+        nodeEventData[NodeBeginContact2D::P_CONTACTS] = contacts;
 
-        if (contactInfo.nodeA_)
+        if (contactInfo.nodeA_ && contactInfo.nodeA_->HasEventReceivers(E_NODEBEGINCONTACT2D))
         {
             nodeEventData[NodeBeginContact2D::P_BODY] = contactInfo.bodyA_.Get();
             nodeEventData[NodeBeginContact2D::P_OTHERNODE] = contactInfo.nodeB_.Get();
@@ -756,7 +975,7 @@ void PhysicsWorld2D::SendBeginContactEvents()
             contactInfo.nodeA_->SendEvent(E_NODEBEGINCONTACT2D, nodeEventData);
         }
 
-        if (contactInfo.nodeB_)
+        if (contactInfo.nodeB_ && contactInfo.nodeB_->HasEventReceivers(E_NODEBEGINCONTACT2D))
         {
             nodeEventData[NodeBeginContact2D::P_BODY] = contactInfo.bodyB_.Get();
             nodeEventData[NodeBeginContact2D::P_OTHERNODE] = contactInfo.nodeA_.Get();
@@ -784,19 +1003,25 @@ void PhysicsWorld2D::SendEndContactEvents()
     for (unsigned i = 0; i < endContactInfos_.Size(); ++i)
     {
         ContactInfo& contactInfo = endContactInfos_[i];
-        eventData[P_BODYA] = contactInfo.bodyA_.Get();
-        eventData[P_BODYB] = contactInfo.bodyB_.Get();
-        eventData[P_NODEA] = contactInfo.nodeA_.Get();
-        eventData[P_NODEB] = contactInfo.nodeB_.Get();
-        eventData[P_CONTACTS] = contactInfo.Serialize(contacts_);
-        eventData[P_SHAPEA] = contactInfo.shapeA_.Get();
-        eventData[P_SHAPEB] = contactInfo.shapeB_.Get();
+        const PODVector<unsigned char>& contacts = contactInfo.Serialize(contacts_);
 
-        SendEvent(E_PHYSICSENDCONTACT2D, eventData);
+        // Receivers may have unsubscribed or been removed by the handlers of earlier contacts
+        if (HasEventReceivers(E_PHYSICSENDCONTACT2D))
+        {
+            eventData[P_BODYA] = contactInfo.bodyA_.Get();
+            eventData[P_BODYB] = contactInfo.bodyB_.Get();
+            eventData[P_NODEA] = contactInfo.nodeA_.Get();
+            eventData[P_NODEB] = contactInfo.nodeB_.Get();
+            eventData[P_CONTACTS] = contacts;
+            eventData[P_SHAPEA] = contactInfo.shapeA_.Get();
+            eventData[P_SHAPEB] = contactInfo.shapeB_.Get();
+
+            SendEvent(E_PHYSICSENDCONTACT2D, eventData);
+        }
 
-        nodeEventData[NodeEndContact2D::P_CONTACTS] = contactInfo.Serialize(contacts_);
+        nodeEventData[NodeEndContact2D::P_CONTACTS] = contacts;
 
-        if (contactInfo.nodeA_)
+        if (contactInfo.nodeA_ && contactInfo.nodeA_->HasEventReceivers(E_NODEENDCONTACT2D))
         {
             nodeEventData[NodeEndContact2D::P_BODY] = contactInfo.bodyA_.Get();
             nodeEventData[NodeEndContact2D::P_OTHERNODE] = contactInfo.nodeB_.Get();
@@ -807,7 +1032,7 @@ void PhysicsWorld2D::SendEndContactEvents()
             contactInfo.nodeA_->SendEvent(E_NODEENDCONTACT2D, nodeEventData);
         }
 
-        if (contactInfo.nodeB_)
+        if (contactInfo.nodeB_ && contactInfo.nodeB_->HasEventReceivers(E_NODEENDCONTACT2D))
         {
             nodeEventData[NodeEndContact2D::P_BODY] = contactInfo.bodyB_.Get();
             nodeEventData[NodeEndContact2D::P_OTHERNODE] = contactInfo.nodeA_.Get();
@@ -822,6 +1047,16 @@ void PhysicsWorld2D::SendEndContactEvents()
     endContactInfos_.Clear();
 }
 
+bool PhysicsWorld2D::HasContactReceivers(b2Contact* contact, StringHash eventType, StringHash nodeEventType) const
+{
+    if (HasEventReceivers(eventType))
+        return true;
+
+    Node* nodeA = ((RigidBody2D*)(contact->GetFixtureA()->GetBody()->GetUserData()))->GetNode();
+    Node* nodeB = ((RigidBody2D*)(contact->GetFixtureB()->GetBody()->GetUserData()))->GetNode();
+    return (nodeA && nodeA->HasEventReceivers(nodeEventType)) || (nodeB && nodeB->HasEventReceivers(nodeEventType));
+}
+
 PhysicsWorld2D::ContactInfo::ContactInfo() = default;
 
 PhysicsWorld2D::ContactInfo::ContactInfo(b2Contact* contact)
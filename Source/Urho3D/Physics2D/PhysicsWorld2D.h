@@ -32,8 +32,11 @@ namespace Urho3D
 
 class Camera;
 class CollisionShape2D;
+class PhysicsWorld2D;
 class RigidBody2D;
 
+struct WorkItem;
+
 /// 2D Physics raycast hit.
 struct URHO3D_API PhysicsRaycastResult2D
 {
@@ -53,6 +56,48 @@ struct URHO3D_API PhysicsRaycastResult2D
     RigidBody2D* body_{};
 };
 
+/// 2D physics batch query: a closest hit raycast, or a box query of the rigid bodies overlapping the box spanned by the start and end points.
+/// @nobind
+struct URHO3D_API PhysicsQuery2D
+{
+    /// Start point of the ray, or the box corner.
+    Vector2 start_;
+    /// End point of the ray, or the opposite box corner.
+    Vector2 end_;
+    /// Collision mask.
+    unsigned collisionMask_{M_MAX_UNSIGNED};
+    /// Box query flag.
+    bool box_{};
+};
+
+/// Batch of 2D physics queries executed on the work queue worker threads. Fill the queries and submit to the physics world, the results are in the same order once completed.
+/// @nobind
+class URHO3D_API PhysicsQueryBatch2D : public RefCounted
+{
+    friend class PhysicsWorld2D;
+
+public:
+    /// Return whether the queries have been executed and the results can be read.
+    bool IsCompleted() const;
+
+    /// Queries to execute. Must not be modified while the batch is pending.
+    PODVector<PhysicsQuery2D> queries_;
+    /// Raycast hits of the queries. Resized to the number of queries when the batch is started. The body is null for box queries and missed rays.
+    PODVector<PhysicsRaycastResult2D> results_;
+    /// Rigid bodies found by the box queries. Resized to the number of queries when the batch is started, so that reusing the batch reuses the allocations. Empty for raycasts.
+    Vector<PODVector<RigidBody2D*> > bodies_;
+
+private:
+    /// Physics world executing the batch.
+    PhysicsWorld2D* world_{};
+    /// Work items of the batch. Not pooled, so that their completed flags stay valid until reaped.
+    Vector<SharedPtr<WorkItem> > items_;
+    /// Pending flag. Set when submitted and cleared when reaped.
+    bool pending_{};
+    /// Started flag. Submission is deferred while the world is stepping.
+    bool started_{};
+};
+
 /// Delayed world transform assignment for parented 2D rigidbodies.
 struct DelayedWorldTransform2D
 {
@@ -166,6 +211,12 @@ public:
     /// Perform a physics world raycast and return the closest hit.
     void RaycastSingle(PhysicsRaycastResult2D& result, const Vector2& startPoint, const Vector2& endPoint,
         unsigned collisionMask = M_MAX_UNSIGNED);
+    /// Submit a batch of physics queries to be executed on the work queue worker threads, without waiting for the results. If submitted during the world step, is started after the step. The physics world must not be modified until the batch is completed: the world completes pending batches on the next frame begin and before stepping, at the latest.
+    void SubmitQueries(PhysicsQueryBatch2D* batch);
+    /// Execute a batch of physics queries on the work queue worker threads and wait for the results.
+    void ExecuteQueries(PhysicsQueryBatch2D* batch);
+    /// Wait for all submitted query batches to complete.
+    void CompleteQueries();
     /// Return rigid body at point.
     RigidBody2D* GetRigidBody(const Vector2& point, unsigned collisionMask = M_MAX_UNSIGNED);
     /// Return rigid body at screen point.
@@ -244,6 +295,14 @@ protected:
     void SendBeginContactEvents();
     /// Send end contact events.
     void SendEndContactEvents();
+    /// Return whether a contact event or the node contact event of either body has receivers.
+    bool HasContactReceivers(b2Contact* contact, StringHash eventType, StringHash nodeEventType) const;
+    /// Queue the work items of a query batch.
+    void StartQueries(PhysicsQueryBatch2D* batch);
+    /// Handle the frame begin event, complete the query batches submitted on the previous frame.
+    void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+    /// Work function executing a range of batch queries.
+    static void ExecuteQueriesWork(const WorkItem* item, unsigned threadIndex);
 
     /// Box2D physics world.
     UniquePtr<b2World> world_;
@@ -271,6 +330,8 @@ protected:
     Vector<WeakPtr<RigidBody2D> > rigidBodies_;
     /// Delayed (parented) world transform assignments.
     HashMap<RigidBody2D*, DelayedWorldTransform2D> delayedWorldTransforms_;
+    /// Submitted query batches not yet reaped.
+    Vector<SharedPtr<PhysicsQueryBatch2D> > queryBatches_;
 
     /// Contact info.
     struct ContactInfo
@@ -25,6 +25,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/Metrics.h"
 #include "../Core/Profiler.h"
 #include "../IO/Log.h"
 #include "../Resource/BackgroundLoader.h"
@@ -36,13 +37,51 @@
 namespace Urho3D
 {
 
+/// Background loader thread in addition to the loader's own thread.
+class BackgroundLoaderThread : public Thread, public RefCounted
+{
+public:
+    /// Construct.
+    explicit BackgroundLoaderThread(BackgroundLoader* owner) :
+        owner_(owner)
+    {
+    }
+
+    /// Load queued resources until stopped.
+    void ThreadFunction() override
+    {
+        URHO3D_PROFILE_THREAD("BackgroundLoader Thread");
+
+        while (shouldRun_)
+        {
+            if (!owner_->LoadNextResource())
+                Time::Sleep(5);
+        }
+    }
+
+private:
+    /// Background loader.
+    BackgroundLoader* owner_;
+};
+
+/// Compare resources to finish by priority.
+static bool CompareFinishPriority(const Pair<int, Pair<StringHash, StringHash> >& lhs,
+    const Pair<int, Pair<StringHash, StringHash> >& rhs)
+{
+    return lhs.first_ > rhs.first_;
+}
+
 BackgroundLoader::BackgroundLoader(ResourceCache* owner) :
-    owner_(owner)
+    owner_(owner),
+    numThreads_(1)
 {
 }
 
 BackgroundLoader::~BackgroundLoader()
 {
+    // Stop the additional threads before the queue they are loading from goes away
+    threads_.Clear();
+
     MutexLock lock(backgroundLoadMutex_);
 
     backgroundLoadQueue_.Clear();
@@ -54,63 +93,104 @@ void BackgroundLoader::ThreadFunction()
 
     while (shouldRun_)
     {
-        backgroundLoadMutex_.Acquire();
+        if (!LoadNextResource())
+            Time::Sleep(5);
+    }
+}
 
-        // Search for a queued resource that has not been loaded yet
-        HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator i = backgroundLoadQueue_.Begin();
-        while (i != backgroundLoadQueue_.End())
-        {
-            if (i->second_.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
-                break;
-            else
-                ++i;
-        }
+bool BackgroundLoader::LoadNextResource()
+{
+    backgroundLoadMutex_.Acquire();
+
+    // Search for the highest priority queued resource that has not been loaded yet. On equal priority prefer resources
+    // that others depend on, as those can not finish before them
+    HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator best = backgroundLoadQueue_.End();
+    for (HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator i = backgroundLoadQueue_.Begin();
+         i != backgroundLoadQueue_.End(); ++i)
+    {
+        const BackgroundLoadItem& item = i->second_;
+        if (item.resource_->GetAsyncLoadState() != ASYNC_QUEUED)
+            continue;
+
+        if (best == backgroundLoadQueue_.End() || item.priority_ > best->second_.priority_ ||
+            (item.priority_ == best->second_.priority_ && !item.dependents_.Empty() && best->second_.dependents_.Empty()))
+            best = i;
+    }
 
-        if (i == backgroundLoadQueue_.End())
+    if (best == backgroundLoadQueue_.End())
+    {
+        // No resources to load found
+        backgroundLoadMutex_.Release();
+        return false;
+    }
+
+    BackgroundLoadItem& item = best->second_;
+    Resource* resource = item.resource_;
+    // Claim the resource before releasing the mutex so that no other loading thread picks it. We can be sure that the
+    // item is not removed from the queue as long as it is in the "queued" or "loading" state
+    resource->SetAsyncLoadState(ASYNC_LOADING);
+    backgroundLoadMutex_.Release();
+
+    bool success = false;
+    SharedPtr<File> file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
+    if (file)
+        success = resource->BeginLoad(*file);
+
+    // Process dependencies now
+    // Need to lock the queue again when manipulating other entries
+    Pair<StringHash, StringHash> key = MakePair(resource->GetType(), resource->GetNameHash());
+    backgroundLoadMutex_.Acquire();
+    if (item.dependents_.Size())
+    {
+        for (HashSet<Pair<StringHash, StringHash> >::Iterator i = item.dependents_.Begin();
+             i != item.dependents_.End(); ++i)
         {
-            // No resources to load found
-            backgroundLoadMutex_.Release();
-            Time::Sleep(5);
+            HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator j = backgroundLoadQueue_.Find(*i);
+            if (j != backgroundLoadQueue_.End())
+                j->second_.dependencies_.Erase(key);
         }
-        else
-        {
-            BackgroundLoadItem& item = i->second_;
-            Resource* resource = item.resource_;
-            // We can be sure that the item is not removed from the queue as long as it is in the
-            // "queued" or "loading" state
-            backgroundLoadMutex_.Release();
 
-            bool success = false;
-            SharedPtr<File> file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
-            if (file)
-            {
-                resource->SetAsyncLoadState(ASYNC_LOADING);
-                success = resource->BeginLoad(*file);
-            }
+        item.dependents_.Clear();
+    }
 
-            // Process dependencies now
-            // Need to lock the queue again when manipulating other entries
-            Pair<StringHash, StringHash> key = MakePair(resource->GetType(), resource->GetNameHash());
-            backgroundLoadMutex_.Acquire();
-            if (item.dependents_.Size())
-            {
-                for (HashSet<Pair<StringHash, StringHash> >::Iterator i = item.dependents_.Begin();
-                     i != item.dependents_.End(); ++i)
-                {
-                    HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator j = backgroundLoadQueue_.Find(*i);
-                    if (j != backgroundLoadQueue_.End())
-                        j->second_.dependencies_.Erase(key);
-                }
+    resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
+    backgroundLoadMutex_.Release();
+    return true;
+}
 
-                item.dependents_.Clear();
-            }
+void BackgroundLoader::StartThreads()
+{
+    if (!IsStarted())
+        Run();
 
-            resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
-            backgroundLoadMutex_.Release();
-        }
+    while (threads_.Size() + 1 < numThreads_)
+    {
+        SharedPtr<BackgroundLoaderThread> thread(new BackgroundLoaderThread(this));
+        thread->SetPriority(GetThreadPriority());
+        thread->Run();
+        threads_.Push(thread);
     }
 }
 
+void BackgroundLoader::SetNumThreads(unsigned num)
+{
+    numThreads_ = Max(num, 1U);
+
+    // Stopping a thread waits for the resource it is loading
+    if (threads_.Size() + 1 > numThreads_)
+        threads_.Resize(numThreads_ - 1);
+    else if (IsStarted())
+        StartThreads();
+}
+
+void BackgroundLoader::SetThreadPriority(int priority)
+{
+    // The base class function is hidden by the queue priority function
+    Thread::SetPriority(priority);
+    for (unsigned i = 0; i < threads_.Size(); ++i)
+        threads_[i]->SetPriority(priority);
+}
+
 bool BackgroundLoader::QueueResource(StringHash type, const String& name, bool sendEventOnFailure, Resource* caller)
 {
     StringHash nameHash(name);
@@ -124,6 +204,8 @@ bool BackgroundLoader::QueueResource(StringHash type, const String& name, bool s
 
     BackgroundLoadItem& item = backgroundLoadQueue_[key];
     item.sendEventOnFailure_ = sendEventOnFailure;
+    item.priority_ = 0;
+    item.reload_ = false;
 
     // Make sure the pointer is non-null and is a Resource subclass
     item.resource_ = DynamicCast<Resource>(owner_->GetContext()->CreateObject(type));
@@ -158,6 +240,7 @@ bool BackgroundLoader::QueueResource(StringHash type, const String& name, bool s
         {
             BackgroundLoadItem& callerItem = j->second_;
             item.dependents_.Insert(callerKey);
+            item.priority_ = callerItem.priority_;
             callerItem.dependencies_.Insert(key);
         }
         else
@@ -165,13 +248,60 @@ bool BackgroundLoader::QueueResource(StringHash type, const String& name, bool s
                        " requested for a background loaded resource but was not in the background load queue");
     }
 
-    // Start the background loader thread now
-    if (!IsStarted())
-        Run();
+    // Start the background loader threads now
+    StartThreads();
+
+    return true;
+}
+
+bool BackgroundLoader::QueueReload(Resource* resource, int priority)
+{
+    Pair<StringHash, StringHash> key = MakePair(resource->GetType(), resource->GetNameHash());
+
+    MutexLock lock(backgroundLoadMutex_);
+
+    if (backgroundLoadQueue_.Find(key) != backgroundLoadQueue_.End())
+        return false;
+
+    BackgroundLoadItem& item = backgroundLoadQueue_[key];
+    item.resource_ = resource;
+    item.sendEventOnFailure_ = false;
+    item.priority_ = priority;
+    item.reload_ = true;
+
+    URHO3D_LOGDEBUG("Background reloading resource " + resource->GetName());
+
+    resource->SetAsyncLoadState(ASYNC_QUEUED);
+    StartThreads();
 
     return true;
 }
 
+bool BackgroundLoader::SetPriority(StringHash type, StringHash nameHash, int priority)
+{
+    MutexLock lock(backgroundLoadMutex_);
+
+    Pair<StringHash, StringHash> key = MakePair(type, nameHash);
+    if (backgroundLoadQueue_.Find(key) == backgroundLoadQueue_.End())
+        return false;
+
+    RaisePriority(key, priority);
+    return true;
+}
+
+void BackgroundLoader::RaisePriority(const Pair<StringHash, StringHash>& key, int priority)
+{
+    HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator i = backgroundLoadQueue_.Find(key);
+    if (i == backgroundLoadQueue_.End() || i->second_.priority_ >= priority)
+        return;
+
+    // A resource can only finish after its dependencies, so they need at least the same priority
+    i->second_.priority_ = priority;
+    for (HashSet<Pair<StringHash, StringHash> >::ConstIterator j = i->second_.dependencies_.Begin();
+         j != i->second_.dependencies_.End(); ++j)
+        RaisePriority(*j, priority);
+}
+
 void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
 {
     backgroundLoadMutex_.Acquire();
@@ -223,25 +353,33 @@ void BackgroundLoader::FinishResources(int maxMs)
     {
         HiresTimer timer;
 
+        // Collect the resources ready to finish and finish them in priority order
+        Vector<Pair<int, Pair<StringHash, StringHash> > > readyResources;
         backgroundLoadMutex_.Acquire();
 
         for (HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator i = backgroundLoadQueue_.Begin();
-             i != backgroundLoadQueue_.End();)
+             i != backgroundLoadQueue_.End(); ++i)
         {
-            Resource* resource = i->second_.resource_;
-            unsigned numDeps = i->second_.dependencies_.Size();
-            AsyncLoadState state = resource->GetAsyncLoadState();
-            if (numDeps > 0 || state == ASYNC_QUEUED || state == ASYNC_LOADING)
-                ++i;
-            else
-            {
-                // Finishing a resource may need it to wait for other resources to load, in which case we can not
-                // hold on to the mutex
-                backgroundLoadMutex_.Release();
-                FinishBackgroundLoading(i->second_);
-                backgroundLoadMutex_.Acquire();
-                i = backgroundLoadQueue_.Erase(i);
-            }
+            AsyncLoadState state = i->second_.resource_->GetAsyncLoadState();
+            if (!i->second_.dependencies_.Size() && state != ASYNC_QUEUED && state != ASYNC_LOADING)
+                readyResources.Push(MakePair(i->second_.priority_, i->first_));
+        }
+
+        Sort(readyResources.Begin(), readyResources.End(), CompareFinishPriority);
+
+        for (unsigned i = 0; i < readyResources.Size(); ++i)
+        {
+            // Finishing an earlier resource may have waited for and finished this one already
+            HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator j = backgroundLoadQueue_.Find(readyResources[i].second_);
+            if (j == backgroundLoadQueue_.End())
+                continue;
+
+            // Finishing a resource may need it to wait for other resources to load, in which case we can not
+            // hold on to the mutex
+            backgroundLoadMutex_.Release();
+            FinishBackgroundLoading(j->second_);
+            backgroundLoadMutex_.Acquire();
+            backgroundLoadQueue_.Erase(j);
 
             // Break when the time limit passed so that we keep sufficient FPS
             if (timer.GetUSec(false) >= maxMs * 1000LL)
@@ -289,6 +427,25 @@ void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
     }
     resource->SetAsyncLoadState(ASYNC_DONE);
 
+    if (owner_->backgroundLoadsMetric_)
+        owner_->backgroundLoadsMetric_->Increment();
+    if (!success && owner_->loadFailuresMetric_)
+        owner_->loadFailuresMetric_->Increment();
+
+    // A reloaded resource is already in the cache, so only update the memory use and notify the resource's listeners
+    if (item.reload_)
+    {
+        if (success)
+        {
+            resource->ResetUseTimer();
+            owner_->UpdateResourceGroup(resource->GetType());
+            resource->SendEvent(E_RELOADFINISHED);
+        }
+        else
+            resource->SendEvent(E_RELOADFAILED);
+        return;
+    }
+
     if (!success && item.sendEventOnFailure_)
     {
         using namespace LoadFailed;
@@ -301,6 +458,8 @@ void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
     // Store to the cache just before sending the event; use same mechanism as for manual resources
     if (success || owner_->GetReturnFailedResources())
         owner_->AddManualResource(resource);
+    if (success)
+        owner_->RecordManifestResource(resource);
 
     // Send event, either success or failure
     {
@@ -33,6 +33,7 @@
 namespace Urho3D
 {
 
+class BackgroundLoaderThread;
 class Resource;
 class ResourceCache;
 
@@ -47,12 +48,18 @@ struct BackgroundLoadItem
     HashSet<Pair<StringHash, StringHash> > dependents_;
     /// Whether to send failure event.
     bool sendEventOnFailure_;
+    /// Loading and finishing priority. Higher value = loaded and finished first.
+    int priority_;
+    /// Whether this is a reload of a resource already in the cache.
+    bool reload_;
 };
 
 /// Background loader of resources. Owned by the ResourceCache.
 /// @nobind
 class BackgroundLoader : public RefCounted, public Thread
 {
+    friend class BackgroundLoaderThread;
+
 public:
     /// Construct.
     explicit BackgroundLoader(ResourceCache* owner);
@@ -65,6 +72,14 @@ public:
 
     /// Queue loading of a resource. The name must be sanitated to ensure consistent format. Return true if queued (not a duplicate and resource was a known type).
     bool QueueResource(StringHash type, const String& name, bool sendEventOnFailure, Resource* caller);
+    /// Queue reloading of a resource that is already in the cache. It stays usable until the reload finishes. Return true if queued (not already in the queue).
+    bool QueueReload(Resource* resource, int priority);
+    /// Raise the priority of a queued resource and the resources it depends on. Return true if the resource was in the queue.
+    bool SetPriority(StringHash type, StringHash nameHash, int priority);
+    /// Set number of loading threads. Takes effect immediately if already started.
+    void SetNumThreads(unsigned num);
+    /// Set priority of the loading threads. Takes effect immediately if already started.
+    void SetThreadPriority(int priority);
     /// Wait and finish possible loading of a resource when being requested from the cache.
     void WaitForResource(StringHash type, StringHash nameHash);
     /// Process resources that are ready to finish.
@@ -72,17 +87,31 @@ public:
 
     /// Return amount of resources in the load queue.
     unsigned GetNumQueuedResources() const;
+    /// Return number of loading threads.
+    unsigned GetNumThreads() const { return numThreads_; }
+    /// Return priority of the loading threads.
+    int GetThreadPriority() const { return Thread::GetPriority(); }
 
 private:
+    /// Begin loading the highest priority queued resource. Called by the loading threads. Return false if none was queued.
+    bool LoadNextResource();
+    /// Start the loading threads.
+    void StartThreads();
+    /// Raise the priority of a queued resource and its dependencies. Must be called with the queue locked.
+    void RaisePriority(const Pair<StringHash, StringHash>& key, int priority);
     /// Finish one background loaded resource.
     void FinishBackgroundLoading(BackgroundLoadItem& item);
 
     /// Resource cache.
     ResourceCache* owner_;
     /// Mutex for thread-safe access to the background load queue.
-    mutable Mutex backgroundLoadMutex_;
+    mutable Mutex backgroundLoadMutex_{"BackgroundLoader"};
     /// Resources that are queued for background loading.
     HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem> backgroundLoadQueue_;
+    /// Loading threads in addition to this one.
+    Vector<SharedPtr<BackgroundLoaderThread> > threads_;
+    /// Number of loading threads including this one.
+    unsigned numThreads_;
 };
 
 }
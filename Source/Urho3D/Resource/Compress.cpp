@@ -0,0 +1,899 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Core/Thread.h"
+#include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
+#include "../Resource/Compress.h"
+
+#include <cstring>
+
+namespace Urho3D
+{
+
+/// Images with fewer pixels are compressed on the calling thread only.
+static const int MIN_PARALLEL_COMPRESS_PIXELS = 128 * 128;
+
+/// ETC1 intensity modifier tables, small and large modifier.
+static const int etcModifiers[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+/// EAC alpha modifier tables.
+static const int eacModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8}
+};
+
+/// Read the 4x4 RGBA pixels of a block. Pixels outside the image repeat its last row and column.
+static void ReadBlockPixels(unsigned char* block, const unsigned char* rgba, int width, int height, int x, int y)
+{
+    for (int py = 0; py < 4; ++py)
+    {
+        const unsigned char* row = rgba + 4 * Min(y + py, height - 1) * width;
+        for (int px = 0; px < 4; ++px)
+            memcpy(block + 16 * py + 4 * px, row + 4 * Min(x + px, width - 1), 4);
+    }
+}
+
+/// Return squared distance of two RGB colors.
+static inline unsigned ColorDistance(const int* a, const unsigned char* b)
+{
+    const int dr = a[0] - b[0];
+    const int dg = a[1] - b[1];
+    const int db = a[2] - b[2];
+    return (unsigned)(dr * dr + dg * dg + db * db);
+}
+
+/// Quantize a color to 5:6:5 bits.
+static unsigned short PackColor565(const float* color)
+{
+    const int r = Clamp((int)(color[0] * (31.0f / 255.0f) + 0.5f), 0, 31);
+    const int g = Clamp((int)(color[1] * (63.0f / 255.0f) + 0.5f), 0, 63);
+    const int b = Clamp((int)(color[2] * (31.0f / 255.0f) + 0.5f), 0, 31);
+    return (unsigned short)((r << 11) | (g << 5) | b);
+}
+
+/// Expand a 5:6:5 color to 8 bits per channel.
+static void UnpackColor565(unsigned short packed, int* color)
+{
+    const int r = (packed >> 11) & 0x1f;
+    const int g = (packed >> 5) & 0x3f;
+    const int b = packed & 0x1f;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+/// Candidate encoding of a DXT color block.
+struct DXTColorFit
+{
+    /// First endpoint.
+    unsigned short color0_;
+    /// Second endpoint.
+    unsigned short color1_;
+    /// Whether the endpoints select the three color mode.
+    bool threeColor_;
+    /// Palette index of each pixel.
+    unsigned char indices_[16];
+    /// Total squared error.
+    unsigned error_;
+};
+
+/// Fit the pixels of a DXT color block to a pair of endpoints, and keep the fit if it has less error than the best so far. Transparent pixels use index 3 of the three color mode.
+static void TryColorEndpointsDXT(DXTColorFit& best, const float* endpoint0, const float* endpoint1, const unsigned char* pixels,
+    unsigned transparentMask)
+{
+    DXTColorFit fit;
+    fit.color0_ = PackColor565(endpoint0);
+    fit.color1_ = PackColor565(endpoint1);
+
+    // Four colors require the first endpoint to be greater, three colors the opposite. Equal endpoints give three colors,
+    // which is also safe for the DXT3 and DXT5 color blocks as long as index 3 is not used
+    if (transparentMask ? fit.color0_ > fit.color1_ : fit.color0_ < fit.color1_)
+        Swap(fit.color0_, fit.color1_);
+    fit.threeColor_ = transparentMask || fit.color0_ == fit.color1_;
+
+    int palette[4][3];
+    UnpackColor565(fit.color0_, palette[0]);
+    UnpackColor565(fit.color1_, palette[1]);
+    for (unsigned k = 0; k < 3; ++k)
+    {
+        if (fit.threeColor_)
+            palette[2][k] = (palette[0][k] + palette[1][k]) / 2;
+        else
+        {
+            palette[2][k] = (2 * palette[0][k] + palette[1][k]) / 3;
+            palette[3][k] = (palette[0][k] + 2 * palette[1][k]) / 3;
+        }
+    }
+    const unsigned numColors = fit.threeColor_ ? 3 : 4;
+
+    fit.error_ = 0;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        if (transparentMask & (1u << i))
+        {
+            fit.indices_[i] = 3;
+            continue;
+        }
+
+        unsigned bestIndex = 0;
+        unsigned bestDistance = ColorDistance(palette[0], pixels + 4 * i);
+        for (unsigned j = 1; j < numColors; ++j)
+        {
+            const unsigned distance = ColorDistance(palette[j], pixels + 4 * i);
+            if (distance < bestDistance)
+            {
+                bestIndex = j;
+                bestDistance = distance;
+            }
+        }
+        fit.indices_[i] = (unsigned char)bestIndex;
+        fit.error_ += bestDistance;
+    }
+
+    if (fit.error_ < best.error_)
+        best = fit;
+}
+
+/// Solve the endpoints that best reproduce the opaque pixels with the palette indices of a fit in the least squares sense. Return false if the indices do not determine them.
+static bool RefineColorEndpointsDXT(float* endpoint0, float* endpoint1, const DXTColorFit& fit, const unsigned char* pixels,
+    unsigned transparentMask)
+{
+    static const float fourColorWeights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+    static const float threeColorWeights[4] = {1.0f, 0.0f, 0.5f, 0.0f};
+    const float* weights = fit.threeColor_ ? threeColorWeights : fourColorWeights;
+
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+    float ax[3] = {}, bx[3] = {};
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        if (transparentMask & (1u << i))
+            continue;
+
+        const float a = weights[fit.indices_[i]];
+        const float b = 1.0f - a;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (unsigned k = 0; k < 3; ++k)
+        {
+            ax[k] += a * pixels[4 * i + k];
+            bx[k] += b * pixels[4 * i + k];
+        }
+    }
+
+    const float det = aa * bb - ab * ab;
+    if (Abs(det) < M_EPSILON)
+        return false;
+
+    const float invDet = 1.0f / det;
+    for (unsigned k = 0; k < 3; ++k)
+    {
+        endpoint0[k] = Clamp((ax[k] * bb - bx[k] * ab) * invDet, 0.0f, 255.0f);
+        endpoint1[k] = Clamp((bx[k] * aa - ax[k] * ab) * invDet, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+/// Compress the color of a 4x4 block to a DXT color block. When allowed, pixels with alpha below 128 become transparent.
+static void CompressColorBlockDXT(unsigned char* dest, const unsigned char* pixels, bool allowTransparency, CompressionQuality quality)
+{
+    unsigned transparentMask = 0;
+    if (allowTransparency)
+    {
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            if (pixels[4 * i + 3] < 128)
+                transparentMask |= 1u << i;
+        }
+    }
+
+    DXTColorFit best;
+    best.error_ = M_MAX_UNSIGNED;
+
+    if (transparentMask == 0xffff)
+    {
+        best.color0_ = best.color1_ = 0;
+        memset(best.indices_, 3, sizeof best.indices_);
+    }
+    else
+    {
+        // Find the principal axis of the opaque colors by power iteration on their covariance
+        float mean[3] = {};
+        float minColor[3] = {255.0f, 255.0f, 255.0f};
+        float maxColor[3] = {};
+        unsigned count = 0;
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            if (transparentMask & (1u << i))
+                continue;
+            for (unsigned k = 0; k < 3; ++k)
+            {
+                const float value = pixels[4 * i + k];
+                mean[k] += value;
+                minColor[k] = Min(minColor[k], value);
+                maxColor[k] = Max(maxColor[k], value);
+            }
+            ++count;
+        }
+        for (unsigned k = 0; k < 3; ++k)
+            mean[k] /= (float)count;
+
+        float covariance[6] = {};
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            if (transparentMask & (1u << i))
+                continue;
+            const float r = pixels[4 * i] - mean[0];
+            const float g = pixels[4 * i + 1] - mean[1];
+            const float b = pixels[4 * i + 2] - mean[2];
+            covariance[0] += r * r;
+            covariance[1] += r * g;
+            covariance[2] += r * b;
+            covariance[3] += g * g;
+            covariance[4] += g * b;
+            covariance[5] += b * b;
+        }
+
+        float axis[3] = {maxColor[0] - minColor[0], maxColor[1] - minColor[1], maxColor[2] - minColor[2]};
+        for (unsigned iteration = 0; iteration < 8; ++iteration)
+        {
+            const float x = axis[0] * covariance[0] + axis[1] * covariance[1] + axis[2] * covariance[2];
+            const float y = axis[0] * covariance[1] + axis[1] * covariance[3] + axis[2] * covariance[4];
+            const float z = axis[0] * covariance[2] + axis[1] * covariance[4] + axis[2] * covariance[5];
+            const float length = Max(Max(Abs(x), Abs(y)), Abs(z));
+            if (length < M_EPSILON)
+                break;
+            axis[0] = x / length;
+            axis[1] = y / length;
+            axis[2] = z / length;
+        }
+
+        // Take the extreme colors along the axis as the endpoints, inset slightly as the ends are rarely hit exactly
+        float minDot = M_INFINITY;
+        float maxDot = -M_INFINITY;
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            if (transparentMask & (1u << i))
+                continue;
+            const float dot = (pixels[4 * i] - mean[0]) * axis[0] + (pixels[4 * i + 1] - mean[1]) * axis[1] +
+                (pixels[4 * i + 2] - mean[2]) * axis[2];
+            minDot = Min(minDot, dot);
+            maxDot = Max(maxDot, dot);
+        }
+        const float axisLengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        if (axisLengthSquared > M_EPSILON)
+        {
+            const float inset = (maxDot - minDot) / 16.0f;
+            minDot = (minDot + inset) / axisLengthSquared;
+            maxDot = (maxDot - inset) / axisLengthSquared;
+        }
+        else
+            minDot = maxDot = 0.0f;
+
+        float endpoint0[3];
+        float endpoint1[3];
+        for (unsigned k = 0; k < 3; ++k)
+        {
+            endpoint0[k] = Clamp(mean[k] + axis[k] * maxDot, 0.0f, 255.0f);
+            endpoint1[k] = Clamp(mean[k] + axis[k] * minDot, 0.0f, 255.0f);
+        }
+        TryColorEndpointsDXT(best, endpoint0, endpoint1, pixels, transparentMask);
+
+        if (quality == CQ_HIGH)
+            TryColorEndpointsDXT(best, maxColor, minColor, pixels, transparentMask);
+
+        // Refine the endpoints from the chosen indices until the error stops decreasing
+        const unsigned refinements = quality == CQ_FAST ? 0 : (quality == CQ_NORMAL ? 1 : 4);
+        for (unsigned i = 0; i < refinements && best.error_; ++i)
+        {
+            const unsigned lastError = best.error_;
+            if (!RefineColorEndpointsDXT(endpoint0, endpoint1, best, pixels, transparentMask))
+                break;
+            TryColorEndpointsDXT(best, endpoint0, endpoint1, pixels, transparentMask);
+            if (best.error_ >= lastError)
+                break;
+        }
+    }
+
+    dest[0] = (unsigned char)(best.color0_ & 0xff);
+    dest[1] = (unsigned char)(best.color0_ >> 8);
+    dest[2] = (unsigned char)(best.color1_ & 0xff);
+    dest[3] = (unsigned char)(best.color1_ >> 8);
+    for (unsigned y = 0; y < 4; ++y)
+    {
+        const unsigned char* indices = best.indices_ + 4 * y;
+        dest[4 + y] = (unsigned char)(indices[0] | (indices[1] << 2) | (indices[2] << 4) | (indices[3] << 6));
+    }
+}
+
+/// Compress the alpha of a 4x4 block to a DXT3 explicit alpha block.
+static void CompressAlphaBlockDXT3(unsigned char* dest, const unsigned char* pixels)
+{
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        const unsigned low = (pixels[8 * i + 3] + 8) / 17;
+        const unsigned high = (pixels[8 * i + 7] + 8) / 17;
+        dest[i] = (unsigned char)(low | (high << 4));
+    }
+}
+
+/// Fit the alpha of a 4x4 block to a pair of DXT5 alpha endpoints. Return the total squared error.
+static unsigned FitAlphaEndpointsDXT5(unsigned char* indices, const unsigned char* pixels, int alpha0, int alpha1)
+{
+    int palette[8];
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+    if (alpha0 > alpha1)
+    {
+        for (int j = 1; j < 7; ++j)
+            palette[j + 1] = ((7 - j) * alpha0 + j * alpha1) / 7;
+    }
+    else
+    {
+        for (int j = 1; j < 5; ++j)
+            palette[j + 1] = ((5 - j) * alpha0 + j * alpha1) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    unsigned error = 0;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        const int alpha = pixels[4 * i + 3];
+        unsigned bestIndex = 0;
+        int bestDistance = Abs(palette[0] - alpha);
+        for (unsigned j = 1; j < 8; ++j)
+        {
+            const int distance = Abs(palette[j] - alpha);
+            if (distance < bestDistance)
+            {
+                bestIndex = j;
+                bestDistance = distance;
+            }
+        }
+        indices[i] = (unsigned char)bestIndex;
+        error += (unsigned)(bestDistance * bestDistance);
+    }
+    return error;
+}
+
+/// Compress the alpha of a 4x4 block to a DXT5 interpolated alpha block.
+static void CompressAlphaBlockDXT5(unsigned char* dest, const unsigned char* pixels, CompressionQuality quality)
+{
+    int minAlpha = 255, maxAlpha = 0;
+    int minInnerAlpha = 255, maxInnerAlpha = 0;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        const int alpha = pixels[4 * i + 3];
+        minAlpha = Min(minAlpha, alpha);
+        maxAlpha = Max(maxAlpha, alpha);
+        if (alpha != 0 && alpha != 255)
+        {
+            minInnerAlpha = Min(minInnerAlpha, alpha);
+            maxInnerAlpha = Max(maxInnerAlpha, alpha);
+        }
+    }
+
+    // Eight interpolated values between the extremes
+    int bestAlpha0 = maxAlpha;
+    int bestAlpha1 = minAlpha;
+    unsigned char bestIndices[16];
+    unsigned bestError = FitAlphaEndpointsDXT5(bestIndices, pixels, bestAlpha0, bestAlpha1);
+
+    unsigned char indices[16];
+    if (quality != CQ_FAST && bestError)
+    {
+        // Six interpolated values between the other extremes, with 0 and 255 exact
+        if (minInnerAlpha <= maxInnerAlpha && (minAlpha == 0 || maxAlpha == 255))
+        {
+            const unsigned error = FitAlphaEndpointsDXT5(indices, pixels, minInnerAlpha, maxInnerAlpha);
+            if (error < bestError)
+            {
+                bestAlpha0 = minInnerAlpha;
+                bestAlpha1 = maxInnerAlpha;
+                bestError = error;
+                memcpy(bestIndices, indices, sizeof indices);
+            }
+        }
+
+        // Pull the eight value endpoints inward, as the extremes may be isolated pixels
+        if (quality == CQ_HIGH)
+        {
+            for (int inset0 = 0; inset0 <= 4; ++inset0)
+            {
+                for (int inset1 = 0; inset1 <= 4; ++inset1)
+                {
+                    const int alpha0 = maxAlpha - inset0;
+                    const int alpha1 = minAlpha + inset1;
+                    if (alpha0 <= alpha1 || (!inset0 && !inset1))
+                        continue;
+
+                    const unsigned error = FitAlphaEndpointsDXT5(indices, pixels, alpha0, alpha1);
+                    if (error < bestError)
+                    {
+                        bestAlpha0 = alpha0;
+                        bestAlpha1 = alpha1;
+                        bestError = error;
+                        memcpy(bestIndices, indices, sizeof indices);
+                    }
+                }
+            }
+        }
+    }
+
+    dest[0] = (unsigned char)bestAlpha0;
+    dest[1] = (unsigned char)bestAlpha1;
+    unsigned long long bits = 0;
+    for (unsigned i = 0; i < 16; ++i)
+        bits |= (unsigned long long)bestIndices[i] << (3 * i);
+    for (unsigned i = 0; i < 6; ++i)
+        dest[2 + i] = (unsigned char)((bits >> (8 * i)) & 0xff);
+}
+
+/// Candidate encoding of an ETC1 subblock.
+struct ETCSubblockFit
+{
+    /// Quantized base color.
+    int color_[3];
+    /// Modifier table.
+    unsigned table_;
+    /// Bit mask of the pixels with the most significant index bit set, in the block's index bit order.
+    unsigned msb_;
+    /// Bit mask of the pixels with the least significant index bit set, in the block's index bit order.
+    unsigned lsb_;
+    /// Total squared error.
+    unsigned error_;
+};
+
+/// Return the pixel index and index bit position of the pixel i of an ETC1 subblock.
+static inline void GetSubblockPixelETC(unsigned subblock, bool flip, unsigned i, unsigned& pixel, unsigned& bit)
+{
+    // Without flip the subblocks are 2x4 pixels side by side, with flip 4x2 pixels on top of each other
+    const unsigned x = flip ? (i & 3) : (subblock * 2 + (i & 1));
+    const unsigned y = flip ? (subblock * 2 + (i >> 2)) : (i >> 1);
+    pixel = y * 4 + x;
+    bit = x * 4 + y;
+}
+
+/// Fit the pixels of an ETC1 subblock to a quantized base color with the best modifier table, and keep the fit if it has less error than the best so far.
+static void TrySubblockColorETC(ETCSubblockFit& best, const unsigned char* pixels, unsigned subblock, bool flip, const int* color,
+    unsigned bits)
+{
+    int base[3];
+    for (unsigned k = 0; k < 3; ++k)
+        base[k] = bits == 4 ? (color[k] << 4) | color[k] : (color[k] << 3) | (color[k] >> 2);
+
+    for (unsigned table = 0; table < 8; ++table)
+    {
+        // Indices select the small positive, large positive, small negative and large negative modifier
+        const int modifiers[4] = {etcModifiers[table][0], etcModifiers[table][1], -etcModifiers[table][0], -etcModifiers[table][1]};
+        int palette[4][3];
+        for (unsigned j = 0; j < 4; ++j)
+        {
+            for (unsigned k = 0; k < 3; ++k)
+                palette[j][k] = Clamp(base[k] + modifiers[j], 0, 255);
+        }
+
+        unsigned error = 0;
+        unsigned msb = 0;
+        unsigned lsb = 0;
+        for (unsigned i = 0; i < 8 && error < best.error_; ++i)
+        {
+            unsigned pixel, bit;
+            GetSubblockPixelETC(subblock, flip, i, pixel, bit);
+
+            unsigned bestIndex = 0;
+            unsigned bestDistance = ColorDistance(palette[0], pixels + 4 * pixel);
+            for (unsigned j = 1; j < 4; ++j)
+            {
+                const unsigned distance = ColorDistance(palette[j], pixels + 4 * pixel);
+                if (distance < bestDistance)
+                {
+                    bestIndex = j;
+                    bestDistance = distance;
+                }
+            }
+            error += bestDistance;
+            msb |= (bestIndex >> 1) << bit;
+            lsb |= (bestIndex & 1) << bit;
+        }
+
+        if (error < best.error_)
+        {
+            for (unsigned k = 0; k < 3; ++k)
+                best.color_[k] = color[k];
+            best.table_ = table;
+            best.msb_ = msb;
+            best.lsb_ = lsb;
+            best.error_ = error;
+        }
+    }
+}
+
+/// Fit an ETC1 subblock with base colors around its quantized average color. In differential mode a reference color limits the base color to its range.
+static void FitSubblockETC(ETCSubblockFit& best, const unsigned char* pixels, unsigned subblock, bool flip, unsigned bits,
+    CompressionQuality quality, const int* reference = nullptr)
+{
+    float average[3] = {};
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        unsigned pixel, bit;
+        GetSubblockPixelETC(subblock, flip, i, pixel, bit);
+        for (unsigned k = 0; k < 3; ++k)
+            average[k] += pixels[4 * pixel + k];
+    }
+
+    const int maxValue = (1 << bits) - 1;
+    int center[3];
+    for (unsigned k = 0; k < 3; ++k)
+        center[k] = Clamp((int)(average[k] / 8.0f * maxValue / 255.0f + 0.5f), 0, maxValue);
+
+    best.error_ = M_MAX_UNSIGNED;
+
+    // Fast tries the average only, normal also moves it along the gray axis, high searches all neighbors
+    const int range = quality == CQ_FAST ? 0 : 1;
+    for (int dr = -range; dr <= range; ++dr)
+    {
+        for (int dg = -range; dg <= range; ++dg)
+        {
+            for (int db = -range; db <= range; ++db)
+            {
+                if (quality == CQ_NORMAL && (dg != dr || db != dr))
+                    continue;
+
+                int color[3] = {center[0] + dr, center[1] + dg, center[2] + db};
+                bool valid = true;
+                for (unsigned k = 0; k < 3; ++k)
+                {
+                    if (reference)
+                        color[k] = Clamp(color[k], reference[k] - 4, reference[k] + 3);
+                    valid &= color[k] >= 0 && color[k] <= maxValue;
+                }
+                if (valid)
+                    TrySubblockColorETC(best, pixels, subblock, flip, color, bits);
+            }
+        }
+    }
+
+    // The reference range may exclude all the candidates, so fall back to the nearest valid color
+    if (best.error_ == M_MAX_UNSIGNED)
+    {
+        int color[3];
+        for (unsigned k = 0; k < 3; ++k)
+            color[k] = Clamp(Clamp(center[k], reference[k] - 4, reference[k] + 3), 0, maxValue);
+        TrySubblockColorETC(best, pixels, subblock, flip, color, bits);
+    }
+}
+
+/// Compress the color of a 4x4 block to an ETC1 block, which is also a valid ETC2 RGB block.
+static void CompressColorBlockETC(unsigned char* dest, const unsigned char* pixels, CompressionQuality quality)
+{
+    unsigned bestError = M_MAX_UNSIGNED;
+    unsigned bestPart1 = 0;
+    unsigned bestPart2 = 0;
+
+    for (unsigned flip = 0; flip < 2; ++flip)
+    {
+        // Individual mode with a 4-bit base color per subblock
+        ETCSubblockFit first, second;
+        FitSubblockETC(first, pixels, 0, flip != 0, 4, quality);
+        FitSubblockETC(second, pixels, 1, flip != 0, 4, quality);
+        if (first.error_ + second.error_ < bestError)
+        {
+            bestError = first.error_ + second.error_;
+            bestPart1 = (unsigned)first.color_[0] << 28 | (unsigned)second.color_[0] << 24 | (unsigned)first.color_[1] << 20 |
+                (unsigned)second.color_[1] << 16 | (unsigned)first.color_[2] << 12 | (unsigned)second.color_[2] << 8 |
+                first.table_ << 5 | second.table_ << 2 | flip;
+            bestPart2 = (first.msb_ | second.msb_) << 16 | first.lsb_ | second.lsb_;
+        }
+
+        // Differential mode with a 5-bit base color and a 3-bit signed offset for the second subblock
+        FitSubblockETC(first, pixels, 0, flip != 0, 5, quality);
+        FitSubblockETC(second, pixels, 1, flip != 0, 5, quality, first.color_);
+        if (first.error_ + second.error_ < bestError)
+        {
+            bestError = first.error_ + second.error_;
+            bestPart1 = (unsigned)first.color_[0] << 27 | (unsigned)((second.color_[0] - first.color_[0]) & 7) << 24 |
+                (unsigned)first.color_[1] << 19 | (unsigned)((second.color_[1] - first.color_[1]) & 7) << 16 |
+                (unsigned)first.color_[2] << 11 | (unsigned)((second.color_[2] - first.color_[2]) & 7) << 8 |
+                first.table_ << 5 | second.table_ << 2 | 2u | flip;
+            bestPart2 = (first.msb_ | second.msb_) << 16 | first.lsb_ | second.lsb_;
+        }
+    }
+
+    // ETC blocks are big-endian
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        dest[i] = (unsigned char)(bestPart1 >> (24 - 8 * i));
+        dest[4 + i] = (unsigned char)(bestPart2 >> (24 - 8 * i));
+    }
+}
+
+/// Fit the alpha of a 4x4 block to an EAC base value, multiplier and modifier table. Return the total squared error, or stop early once it exceeds the limit.
+static unsigned FitAlphaEAC(unsigned char* indices, const unsigned char* pixels, int base, int multiplier, unsigned table,
+    unsigned limit)
+{
+    int palette[8];
+    for (unsigned j = 0; j < 8; ++j)
+        palette[j] = Clamp(base + eacModifiers[table][j] * multiplier, 0, 255);
+
+    unsigned error = 0;
+    for (unsigned i = 0; i < 16 && error < limit; ++i)
+    {
+        const int alpha = pixels[4 * i + 3];
+        unsigned bestIndex = 0;
+        int bestDistance = Abs(palette[0] - alpha);
+        for (unsigned j = 1; j < 8; ++j)
+        {
+            const int distance = Abs(palette[j] - alpha);
+            if (distance < bestDistance)
+            {
+                bestIndex = j;
+                bestDistance = distance;
+            }
+        }
+        indices[i] = (unsigned char)bestIndex;
+        error += (unsigned)(bestDistance * bestDistance);
+    }
+    return error;
+}
+
+/// Compress the alpha of a 4x4 block to an EAC alpha block of ETC2 RGBA.
+static void CompressAlphaBlockEAC(unsigned char* dest, const unsigned char* pixels, CompressionQuality quality)
+{
+    int minAlpha = 255, maxAlpha = 0;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        minAlpha = Min(minAlpha, (int)pixels[4 * i + 3]);
+        maxAlpha = Max(maxAlpha, (int)pixels[4 * i + 3]);
+    }
+
+    // Table 13 has a zero modifier for a constant alpha
+    int bestBase = minAlpha;
+    int bestMultiplier = 1;
+    unsigned bestTable = 13;
+    unsigned char bestIndices[16];
+    unsigned bestError = M_MAX_UNSIGNED;
+    if (minAlpha == maxAlpha)
+    {
+        memset(bestIndices, 4, sizeof bestIndices);
+        bestError = 0;
+    }
+
+    unsigned char indices[16];
+    const int multiplierRange = quality == CQ_FAST ? 0 : 1;
+    const int baseRange = quality == CQ_HIGH ? 2 : 0;
+    for (unsigned table = 0; table < 16 && bestError; ++table)
+    {
+        // Spread the table's modifiers over the alpha range, centered on it
+        const int low = eacModifiers[table][3];
+        const int high = eacModifiers[table][7];
+        const int multiplier = Clamp((int)((float)(maxAlpha - minAlpha) / (float)(high - low) + 0.5f), 1, 15);
+        const int base = (int)((minAlpha + maxAlpha) * 0.5f - (low + high) * multiplier * 0.5f + 0.5f);
+
+        for (int dm = -multiplierRange; dm <= multiplierRange; ++dm)
+        {
+            const int tryMultiplier = multiplier + dm;
+            if (tryMultiplier < 1 || tryMultiplier > 15)
+                continue;
+
+            for (int db = -baseRange; db <= baseRange; ++db)
+            {
+                const int tryBase = Clamp(base + db, 0, 255);
+                const unsigned error = FitAlphaEAC(indices, pixels, tryBase, tryMultiplier, table, bestError);
+                if (error < bestError)
+                {
+                    bestBase = tryBase;
+                    bestMultiplier = tryMultiplier;
+                    bestTable = table;
+                    bestError = error;
+                    memcpy(bestIndices, indices, sizeof indices);
+                }
+            }
+        }
+    }
+
+    dest[0] = (unsigned char)bestBase;
+    dest[1] = (unsigned char)(bestMultiplier << 4 | bestTable);
+
+    // The indices are in column order, the first one in the most significant bits
+    unsigned long long bits = 0;
+    for (unsigned x = 0; x < 4; ++x)
+    {
+        for (unsigned y = 0; y < 4; ++y)
+            bits = bits << 3 | bestIndices[y * 4 + x];
+    }
+    for (unsigned i = 0; i < 6; ++i)
+        dest[2 + i] = (unsigned char)((bits >> (40 - 8 * i)) & 0xff);
+}
+
+/// Return the size of a compressed block in bytes, or 0 if the format can not be compressed to.
+static unsigned GetBlockSize(CompressedFormat format)
+{
+    switch (format)
+    {
+    case CF_DXT1:
+    case CF_ETC1:
+    case CF_ETC2_RGB:
+        return 8;
+
+    case CF_DXT3:
+    case CF_DXT5:
+    case CF_ETC2_RGBA:
+        return 16;
+
+    default:
+        return 0;
+    }
+}
+
+/// Block rows of an image to compress.
+struct CompressRowRange
+{
+    /// Destination compressed data.
+    unsigned char* blocks_;
+    /// Source RGBA data.
+    const unsigned char* rgba_;
+    /// Image width.
+    int width_;
+    /// Image height.
+    int height_;
+    /// Compressed format.
+    CompressedFormat format_;
+    /// Compression quality.
+    CompressionQuality quality_;
+    /// First block row.
+    int startRow_;
+    /// End block row.
+    int endRow_;
+};
+
+/// Compress a range of block rows of an image.
+static void CompressRows(const CompressRowRange& range)
+{
+    const unsigned blockSize = GetBlockSize(range.format_);
+    const int blocksPerRow = (range.width_ + 3) / 4;
+    unsigned char* dest = range.blocks_ + range.startRow_ * blocksPerRow * blockSize;
+    unsigned char pixels[16 * 4];
+
+    for (int row = range.startRow_; row < range.endRow_; ++row)
+    {
+        for (int x = 0; x < range.width_; x += 4)
+        {
+            ReadBlockPixels(pixels, range.rgba_, range.width_, range.height_, x, row * 4);
+
+            switch (range.format_)
+            {
+            case CF_DXT1:
+                CompressColorBlockDXT(dest, pixels, true, range.quality_);
+                break;
+
+            case CF_DXT3:
+                CompressAlphaBlockDXT3(dest, pixels);
+                CompressColorBlockDXT(dest + 8, pixels, false, range.quality_);
+                break;
+
+            case CF_DXT5:
+                CompressAlphaBlockDXT5(dest, pixels, range.quality_);
+                CompressColorBlockDXT(dest + 8, pixels, false, range.quality_);
+                break;
+
+            case CF_ETC2_RGBA:
+                CompressAlphaBlockEAC(dest, pixels, range.quality_);
+                CompressColorBlockETC(dest + 8, pixels, range.quality_);
+                break;
+
+            default:
+                CompressColorBlockETC(dest, pixels, range.quality_);
+                break;
+            }
+
+            dest += blockSize;
+        }
+    }
+}
+
+/// Work function for compressing a range of block rows of an image.
+static void CompressRowsWork(const WorkItem* item, unsigned /*threadIndex*/)
+{
+    CompressRows(*reinterpret_cast<const CompressRowRange*>(item->aux_));
+}
+
+unsigned GetCompressedImageSize(int width, int height, CompressedFormat format)
+{
+    return (unsigned)(((width + 3) / 4) * ((height + 3) / 4)) * GetBlockSize(format);
+}
+
+bool CompressImage(unsigned char* blocks, const unsigned char* rgba, int width, int height, CompressedFormat format,
+    CompressionQuality quality, WorkQueue* queue)
+{
+    if (!GetBlockSize(format) || width <= 0 || height <= 0)
+        return false;
+
+    const int numRows = (height + 3) / 4;
+
+    // Work items can only be queued from the main thread
+    unsigned numRanges = 1;
+    if (queue && width * height >= MIN_PARALLEL_COMPRESS_PIXELS && Thread::IsMainThread())
+        numRanges = Min(queue->GetNumThreads() + 1, (unsigned)numRows);
+
+    PODVector<CompressRowRange> ranges(numRanges);
+    for (unsigned i = 0; i < numRanges; ++i)
+    {
+        ranges[i].blocks_ = blocks;
+        ranges[i].rgba_ = rgba;
+        ranges[i].width_ = width;
+        ranges[i].height_ = height;
+        ranges[i].format_ = format;
+        ranges[i].quality_ = quality;
+        ranges[i].startRow_ = (int)(numRows * i / numRanges);
+        ranges[i].endRow_ = (int)(numRows * (i + 1) / numRanges);
+    }
+
+    Vector<SharedPtr<WorkItem> > items;
+    for (unsigned i = 1; i < numRanges; ++i)
+    {
+        SharedPtr<WorkItem> item(new WorkItem());
+        item->workFunction_ = CompressRowsWork;
+        item->aux_ = &ranges[i];
+        item->priority_ = M_MAX_UNSIGNED;
+        queue->AddWorkItem(item);
+        items.Push(item);
+    }
+
+    CompressRows(ranges[0]);
+
+    // Compress the ranges no worker thread has taken yet here, and wait for the rest
+    for (unsigned i = 0; i < items.Size(); ++i)
+    {
+        if (items[i]->completed_)
+            continue;
+        if (queue->RemoveWorkItem(items[i]))
+            CompressRows(ranges[i + 1]);
+        else
+        {
+            while (!items[i]->completed_)
+                Time::Sleep(0);
+        }
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,36 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Resource/Image.h"
+
+namespace Urho3D
+{
+
+/// Return the size in bytes of an image compressed to DXT1, DXT3, DXT5, ETC1, ETC2 RGB or ETC2 RGBA, or 0 if the format can not be compressed to.
+URHO3D_API unsigned GetCompressedImageSize(int width, int height, CompressedFormat format);
+/// Compress a 2D RGBA image to DXT1, DXT3, DXT5, ETC1, ETC2 RGB or ETC2 RGBA blocks. DXT1 keeps 1-bit alpha for the pixels with alpha below 128. ETC2 RGB is written in the ETC1 compatible block modes. When called from the main thread with a work queue, the block rows of large images are split across the worker threads. Return false if the format is not supported.
+URHO3D_API bool CompressImage(unsigned char* blocks, const unsigned char* rgba, int width, int height, CompressedFormat format,
+    CompressionQuality quality = CQ_NORMAL, WorkQueue* queue = nullptr);
+
+}
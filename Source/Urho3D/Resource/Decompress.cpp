@@ -22,9 +22,20 @@
 
 #include "../Precompiled.h"
 
+#include "../Core/Thread.h"
+#include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
 #include "../Resource/Decompress.h"
 
 #include <cstdint>
+#include <cstring>
+
+#if defined(URHO3D_SSE)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define URHO3D_DECOMPRESS_NEON
+#endif
 
 // ETC2 decompress
 typedef unsigned char uint8;
@@ -86,7 +97,7 @@ static int Unpack565(unsigned char const* packed, unsigned char* colour)
     return value;
 }
 
-static void DecompressColourDXT(unsigned char* rgba, void const* block, bool isDxt1)
+static void DecompressColourDXT(unsigned char* rgba, int pitch, void const* block, bool isDxt1)
 {
     // get the block bytes
     auto const* bytes = reinterpret_cast< unsigned char const* >( block );
@@ -118,29 +129,61 @@ static void DecompressColourDXT(unsigned char* rgba, void const* block, bool isD
     codes[8 + 3] = 255;
     codes[12 + 3] = (unsigned char)((isDxt1 && a <= b) ? 0 : 255);
 
-    // unpack the indices
-    unsigned char indices[16];
+#if defined(URHO3D_SSE)
+    // select the colours of a row of 4 pixels by comparing each pixel's masked 2-bit index to the 4 possible values
+    const __m128i indexMask = _mm_setr_epi32(0x3, 0xc, 0x30, 0xc0);
+    __m128i palette[4];
+    __m128i indexValues[4];
     for (int i = 0; i < 4; ++i)
     {
-        unsigned char* ind = indices + 4 * i;
-        unsigned char packed = bytes[4 + i];
+        int colour;
+        memcpy(&colour, codes + 4 * i, 4);
+        palette[i] = _mm_set1_epi32(colour);
+        indexValues[i] = _mm_setr_epi32(i, i << 2, i << 4, i << 6);
+    }
 
-        ind[0] = (unsigned char)(packed & 0x3);
-        ind[1] = (unsigned char)((packed >> 2) & 0x3);
-        ind[2] = (unsigned char)((packed >> 4) & 0x3);
-        ind[3] = (unsigned char)((packed >> 6) & 0x3);
+    for (int i = 0; i < 4; ++i)
+    {
+        __m128i indices = _mm_and_si128(_mm_set1_epi32(bytes[4 + i]), indexMask);
+        __m128i row = _mm_and_si128(_mm_cmpeq_epi32(indices, indexValues[0]), palette[0]);
+        for (int j = 1; j < 4; ++j)
+            row = _mm_or_si128(row, _mm_and_si128(_mm_cmpeq_epi32(indices, indexValues[j]), palette[j]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * pitch), row);
+    }
+#elif defined(URHO3D_DECOMPRESS_NEON)
+    const uint32_t indexMaskValues[4] = { 0x3, 0xc, 0x30, 0xc0 };
+    const uint32x4_t indexMask = vld1q_u32(indexMaskValues);
+    uint32x4_t palette[4];
+    uint32x4_t indexValues[4];
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        uint32_t colour;
+        memcpy(&colour, codes + 4 * i, 4);
+        palette[i] = vdupq_n_u32(colour);
+        const uint32_t values[4] = { i, i << 2, i << 4, i << 6 };
+        indexValues[i] = vld1q_u32(values);
     }
 
-    // store out the colours
-    for (int i = 0; i < 16; ++i)
+    for (int i = 0; i < 4; ++i)
+    {
+        uint32x4_t indices = vandq_u32(vdupq_n_u32(bytes[4 + i]), indexMask);
+        uint32x4_t row = vandq_u32(vceqq_u32(indices, indexValues[0]), palette[0]);
+        for (int j = 1; j < 4; ++j)
+            row = vorrq_u32(row, vandq_u32(vceqq_u32(indices, indexValues[j]), palette[j]));
+        vst1q_u8(rgba + i * pitch, vreinterpretq_u8_u32(row));
+    }
+#else
+    // store out the colours, unpacking the indices
+    for (int i = 0; i < 4; ++i)
     {
-        auto offset = (unsigned char)(4 * indices[i]);
+        unsigned char packed = bytes[4 + i];
         for (int j = 0; j < 4; ++j)
-            rgba[4 * i + j] = codes[offset + j];
+            memcpy(rgba + i * pitch + 4 * j, codes + 4 * ((packed >> 2 * j) & 0x3), 4);
     }
+#endif
 }
 
-static void DecompressAlphaDXT3(unsigned char* rgba, void const* block)
+static void DecompressAlphaDXT3(unsigned char* rgba, int pitch, void const* block)
 {
     auto const* bytes = reinterpret_cast< unsigned char const* >( block );
 
@@ -155,12 +198,13 @@ static void DecompressAlphaDXT3(unsigned char* rgba, void const* block)
         auto hi = (unsigned char)(quant & 0xf0);
 
         // convert back up to bytes
-        rgba[8 * i + 3] = lo | (lo << 4);
-        rgba[8 * i + 7] = hi | (hi >> 4);
+        unsigned char* pixels = rgba + (i >> 1) * pitch + 8 * (i & 1);
+        pixels[3] = lo | (lo << 4);
+        pixels[7] = hi | (hi >> 4);
     }
 }
 
-static void DecompressAlphaDXT5(unsigned char* rgba, void const* block)
+static void DecompressAlphaDXT5(unsigned char* rgba, int pitch, void const* block)
 {
     // get the two alpha values
     auto const* bytes = reinterpret_cast< unsigned char const* >( block );
@@ -186,34 +230,19 @@ static void DecompressAlphaDXT5(unsigned char* rgba, void const* block)
             codes[1 + i] = (unsigned char)(((7 - i) * alpha0 + i * alpha1) / 7);
     }
 
-    // decode the indices
-    unsigned char indices[16];
+    // decode the indices 8 at a time, each 3 bytes holding 2 rows of pixels
     unsigned char const* src = bytes + 2;
-    unsigned char* dest = indices;
     for (int i = 0; i < 2; ++i)
     {
-        // grab 3 bytes
-        int value = 0;
-        for (int j = 0; j < 3; ++j)
-        {
-            int byte = *src++;
-            value |= (byte << 8 * j);
-        }
+        int value = src[0] | (src[1] << 8) | (src[2] << 16);
+        src += 3;
 
-        // unpack 8 3-bit values from it
         for (int j = 0; j < 8; ++j)
-        {
-            int index = (value >> 3 * j) & 0x7;
-            *dest++ = (unsigned char)index;
-        }
+            rgba[(2 * i + (j >> 2)) * pitch + 4 * (j & 3) + 3] = codes[(value >> 3 * j) & 0x7];
     }
-
-    // write out the indexed codebook values
-    for (int i = 0; i < 16; ++i)
-        rgba[4 * i + 3] = codes[indices[i]];
 }
 
-static void DecompressDXT(unsigned char* rgba, const void* block, CompressedFormat format)
+static void DecompressDXT(unsigned char* rgba, int pitch, const void* block, CompressedFormat format)
 {
     // get the block locations
     void const* colourBlock = block;
@@ -222,65 +251,61 @@ static void DecompressDXT(unsigned char* rgba, const void* block, CompressedForm
         colourBlock = reinterpret_cast< unsigned char const* >( block ) + 8;
 
     // decompress colour
-    DecompressColourDXT(rgba, colourBlock, format == CF_DXT1);
+    DecompressColourDXT(rgba, pitch, colourBlock, format == CF_DXT1);
 
     // decompress alpha separately if necessary
     if (format == CF_DXT3)
-        DecompressAlphaDXT3(rgba, alphaBock);
+        DecompressAlphaDXT3(rgba, pitch, alphaBock);
     else if (format == CF_DXT5)
-        DecompressAlphaDXT5(rgba, alphaBock);
+        DecompressAlphaDXT5(rgba, pitch, alphaBock);
 }
 
-void DecompressImageDXT(unsigned char* rgba, const void* blocks, int width, int height, int depth, CompressedFormat format)
+/// Copy the pixels of a decompressed 4x4 block that are inside the image.
+static void CopyBlockPixels(unsigned char* rgba, int width, int height, int x, int y, const unsigned char* block)
 {
-    // initialise the block input
-    auto const* sourceBlock = reinterpret_cast< unsigned char const* >( blocks );
-    int bytesPerBlock = format == CF_DXT1 ? 8 : 16;
+    const int blockWidth = Min(width - x, 4);
+    const int blockHeight = Min(height - y, 4);
+    for (int py = 0; py < blockHeight; ++py)
+        memcpy(rgba + 4 * ((y + py) * width + x), block + 16 * py, (size_t)blockWidth * 4);
+}
 
-    // loop over blocks
-    for (int z = 0; z < depth; ++z)
+/// Decompress a range of DXT block rows. The rows of all depth slices are counted in sequence.
+static void DecompressBlockRowsDXT(unsigned char* rgba, const void* blocks, int width, int height, CompressedFormat format,
+    int startRow, int endRow)
+{
+    const int bytesPerBlock = format == CF_DXT1 ? 8 : 16;
+    const int blocksPerRow = (width + 3) / 4;
+    const int rowsPerSlice = (height + 3) / 4;
+    const int pitch = width * 4;
+    auto const* sourceBlock = reinterpret_cast< unsigned char const* >( blocks ) + startRow * blocksPerRow * bytesPerBlock;
+
+    for (int row = startRow; row < endRow; ++row)
     {
-        int sz = width * height * 4 * z;
-        for (int y = 0; y < height; y += 4)
+        unsigned char* slice = rgba + (row / rowsPerSlice) * width * height * 4;
+        const int y = (row % rowsPerSlice) * 4;
+
+        for (int x = 0; x < width; x += 4)
         {
-            for (int x = 0; x < width; x += 4)
+            // whole blocks are written to the image directly, blocks crossing its edge through a temporary
+            if (x + 4 <= width && y + 4 <= height)
+                DecompressDXT(slice + y * pitch + 4 * x, pitch, sourceBlock, format);
+            else
             {
-                // decompress the block
                 unsigned char targetRgba[4 * 16];
-                DecompressDXT(targetRgba, sourceBlock, format);
-
-                // write the decompressed pixels to the correct image locations
-                unsigned char const* sourcePixel = targetRgba;
-                for (int py = 0; py < 4; ++py)
-                {
-                    for (int px = 0; px < 4; ++px)
-                    {
-                        // get the target location
-                        int sx = x + px;
-                        int sy = y + py;
-                        if (sx < width && sy < height)
-                        {
-                            unsigned char* targetPixel = rgba + sz + 4 * (width * sy + sx);
-
-                            // copy the rgba value
-                            for (int i = 0; i < 4; ++i)
-                                *targetPixel++ = *sourcePixel++;
-                        }
-                        else
-                        {
-                            // skip this pixel as its outside the image
-                            sourcePixel += 4;
-                        }
-                    }
-                }
-
-                // advance
-                sourceBlock += bytesPerBlock;
+                DecompressDXT(targetRgba, 16, sourceBlock, format);
+                CopyBlockPixels(slice, width, height, x, y, targetRgba);
             }
+
+            sourceBlock += bytesPerBlock;
         }
     }
 }
 
+void DecompressImageDXT(unsigned char* rgba, const void* blocks, int width, int height, int depth, CompressedFormat format)
+{
+    DecompressBlockRowsDXT(rgba, blocks, width, height, format, 0, depth * ((height + 3) / 4));
+}
+
 // PVRTC decompression based on the Oolong Engine, modified for Urho3D
 
 #define PT_INDEX    (2) /*The Punch-through index*/
@@ -634,7 +659,9 @@ static unsigned TwiddleUV(unsigned YSize, unsigned XSize, unsigned YPos, unsigne
     return Twiddled;
 }
 
-void DecompressImagePVRTC(unsigned char* rgba, const void* blocks, int width, int height, CompressedFormat format)
+/// Decompress a range of PVRTC pixel rows.
+static void DecompressPixelRowsPVRTC(unsigned char* rgba, const void* blocks, int width, int height, CompressedFormat format,
+    int startY, int endY)
 {
     auto* pCompressedData = (AMTC_BLOCK_STRUCT*)blocks;
     int AssumeImageTiles = 1;
@@ -689,7 +716,7 @@ void DecompressImagePVRTC(unsigned char* rgba, const void* blocks, int width, in
     // Step through the pixels of the image decompressing each one in turn
     //
     // Note that this is a hideously inefficient way to do this!
-    for (y = 0; y < height; y++)
+    for (y = startY; y < endY; y++)
     {
         for (x = 0; x < width; x++)
         {
@@ -780,6 +807,11 @@ void DecompressImagePVRTC(unsigned char* rgba, const void* blocks, int width, in
     }
 }
 
+void DecompressImagePVRTC(unsigned char* rgba, const void* blocks, int width, int height, CompressedFormat format)
+{
+    DecompressPixelRowsPVRTC(rgba, blocks, width, height, format, 0, height);
+}
+
 void FlipBlockVertical(unsigned char* dest, const unsigned char* src, CompressedFormat format)
 {
     switch (format)
@@ -908,23 +940,28 @@ static void ReadBigEndian4byteWord(uint32_t* pBlock, const unsigned char *s)
     *pBlock = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
 }
 
-// Use ETCPACK to decompress ETC texture.
-void DecompressImageETC(unsigned char* dstImage, const void* blocks, int width, int height, bool hasAlpha)
+/// Initialize the ETCPACK tables once.
+static void SetupETCTables()
 {
-    // ETCPACK initialization.
-    static const bool placeholder = []() { setupAlphaTable(); return true; }();
+    static const bool initialized = []() { setupAlphaTable(); return true; }();
+    (void)initialized;
+}
 
+/// Decompress a range of ETC block rows using ETCPACK.
+static void DecompressBlockRowsETC(unsigned char* dstImage, const void* blocks, int width, int height, bool hasAlpha,
+    int startRow, int endRow)
+{
     const int channelCount = hasAlpha ? 4 : 3;
-    unsigned char* src = (unsigned char*)blocks;
-    unsigned int blockPart1, blockPart2;
+    const int bytesPerBlock = hasAlpha ? 16 : 8;
 
     // ETCPACK write 4x4 blocks, so it needs padding.
-    int w4 = ((width + 3) / 4);
-    int h4 = ((height + 3) / 4);
+    const int w4 = ((width + 3) / 4);
+    unsigned char* src = (unsigned char*)blocks + startRow * w4 * bytesPerBlock;
+    unsigned int blockPart1, blockPart2;
 
     unsigned char buffer4x4[4 * 4 * 4];
 
-    for (int y = 0; y < h4; ++y)
+    for (int y = startRow; y < endRow; ++y)
     {
         for (int x = 0; x < w4; ++x)
         {
@@ -941,22 +978,147 @@ void DecompressImageETC(unsigned char* dstImage, const void* blocks, int width,
             src += 4;
             decompressBlockETC2c(blockPart1, blockPart2, &buffer4x4[0], 4, 4, 0, 0, 4);
 
-            int wbuf = Min(width - x * 4, 4);
-            int hbuf = Min(height - y * 4, 4);
-            for(int dy = 0; dy < hbuf; ++dy)
-            {
-                for (int dx = 0; dx < wbuf; ++dx)
-                {
-                    int idst = ((y * 4 + dy) * width + x * 4 + dx) * 4;
-                    int ibuf = (dy * 4 + dx) * 4;
-                    dstImage[idst] = buffer4x4[ibuf];
-                    dstImage[idst + 1] = buffer4x4[ibuf + 1];
-                    dstImage[idst + 2] = buffer4x4[ibuf + 2];
-                    dstImage[idst + 3] = buffer4x4[ibuf + 3];
-                }
-            }
+            CopyBlockPixels(dstImage, width, height, x * 4, y * 4, buffer4x4);
+        }
+    }
+}
+
+void DecompressImageETC(unsigned char* dstImage, const void* blocks, int width, int height, bool hasAlpha)
+{
+    SetupETCTables();
+    DecompressBlockRowsETC(dstImage, blocks, width, height, hasAlpha, 0, (height + 3) / 4);
+}
+
+/// Images with fewer pixels are decompressed on the calling thread only.
+static const int MIN_PARALLEL_DECOMPRESS_PIXELS = 256 * 256;
+
+/// Rows of a compressed image to decompress. Counted in block rows for DXT and ETC, and in pixel rows for PVRTC.
+struct DecompressRowRange
+{
+    /// Destination RGBA data.
+    unsigned char* rgba_;
+    /// Compressed source data.
+    const void* blocks_;
+    /// Image width.
+    int width_;
+    /// Image height.
+    int height_;
+    /// Compressed format.
+    CompressedFormat format_;
+    /// First row.
+    int startRow_;
+    /// End row.
+    int endRow_;
+};
+
+/// Decompress a range of rows of a compressed image.
+static void DecompressRows(const DecompressRowRange& range)
+{
+    switch (range.format_)
+    {
+    case CF_DXT1:
+    case CF_DXT3:
+    case CF_DXT5:
+        DecompressBlockRowsDXT(range.rgba_, range.blocks_, range.width_, range.height_, range.format_, range.startRow_, range.endRow_);
+        break;
+
+    // ETC2 format is compatible with ETC1, so we just use the same function.
+    case CF_ETC1:
+    case CF_ETC2_RGB:
+    case CF_ETC2_RGBA:
+        DecompressBlockRowsETC(range.rgba_, range.blocks_, range.width_, range.height_, range.format_ == CF_ETC2_RGBA,
+            range.startRow_, range.endRow_);
+        break;
+
+    default:
+        DecompressPixelRowsPVRTC(range.rgba_, range.blocks_, range.width_, range.height_, range.format_, range.startRow_,
+            range.endRow_);
+        break;
+    }
+}
+
+/// Work function for decompressing a range of rows of a compressed image.
+static void DecompressRowsWork(const WorkItem* item, unsigned /*threadIndex*/)
+{
+    DecompressRows(*reinterpret_cast<const DecompressRowRange*>(item->aux_));
+}
+
+bool DecompressImage(unsigned char* rgba, const void* blocks, int width, int height, int depth, CompressedFormat format,
+    WorkQueue* queue)
+{
+    int numRows;
+    switch (format)
+    {
+    case CF_DXT1:
+    case CF_DXT3:
+    case CF_DXT5:
+        numRows = depth * ((height + 3) / 4);
+        break;
+
+    case CF_ETC1:
+    case CF_ETC2_RGB:
+    case CF_ETC2_RGBA:
+        SetupETCTables();
+        numRows = (height + 3) / 4;
+        break;
+
+    case CF_PVRTC_RGB_2BPP:
+    case CF_PVRTC_RGBA_2BPP:
+    case CF_PVRTC_RGB_4BPP:
+    case CF_PVRTC_RGBA_4BPP:
+        numRows = height;
+        break;
+
+    default:
+        // Unknown format
+        return false;
+    }
+
+    // Work items can only be queued from the main thread
+    unsigned numRanges = 1;
+    if (queue && width * height * depth >= MIN_PARALLEL_DECOMPRESS_PIXELS && Thread::IsMainThread())
+        numRanges = Min(queue->GetNumThreads() + 1, (unsigned)numRows);
+
+    PODVector<DecompressRowRange> ranges(numRanges);
+    for (unsigned i = 0; i < numRanges; ++i)
+    {
+        ranges[i].rgba_ = rgba;
+        ranges[i].blocks_ = blocks;
+        ranges[i].width_ = width;
+        ranges[i].height_ = height;
+        ranges[i].format_ = format;
+        ranges[i].startRow_ = (int)(numRows * i / numRanges);
+        ranges[i].endRow_ = (int)(numRows * (i + 1) / numRanges);
+    }
+
+    Vector<SharedPtr<WorkItem> > items;
+    for (unsigned i = 1; i < numRanges; ++i)
+    {
+        SharedPtr<WorkItem> item(new WorkItem());
+        item->workFunction_ = DecompressRowsWork;
+        item->aux_ = &ranges[i];
+        item->priority_ = M_MAX_UNSIGNED;
+        queue->AddWorkItem(item);
+        items.Push(item);
+    }
+
+    DecompressRows(ranges[0]);
+
+    // Decompress the ranges no worker thread has taken yet here, and wait for the rest
+    for (unsigned i = 0; i < items.Size(); ++i)
+    {
+        if (items[i]->completed_)
+            continue;
+        if (queue->RemoveWorkItem(items[i]))
+            DecompressRows(ranges[i + 1]);
+        else
+        {
+            while (!items[i]->completed_)
+                Time::Sleep(0);
         }
     }
+
+    return true;
 }
 
 }
@@ -34,6 +34,9 @@ URHO3D_API void
 URHO3D_API void DecompressImageETC(unsigned char* dstImage, const void* blocks, int width, int height, bool hasAlpha);
 /// Decompress a PVRTC compressed image to RGBA.
 URHO3D_API void DecompressImagePVRTC(unsigned char* rgba, const void* blocks, int width, int height, CompressedFormat format);
+/// Decompress a DXT, ETC or PVRTC compressed image to RGBA. When called from the main thread with a work queue, the rows of large images are split across the worker threads. Return false if the format is not supported.
+URHO3D_API bool DecompressImage(unsigned char* rgba, const void* blocks, int width, int height, int depth, CompressedFormat format,
+    WorkQueue* queue = nullptr);
 /// Flip a compressed block vertically.
 URHO3D_API void FlipBlockVertical(unsigned char* dest, const unsigned char* src, CompressedFormat format);
 /// Flip a compressed block horizontally.
@@ -24,9 +24,13 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
+#include "../Resource/Compress.h"
 #include "../Resource/Decompress.h"
 
 #include <SDL/SDL_surface.h>
@@ -40,6 +44,13 @@
 #include <webp/mux.h>
 #endif
 
+#if defined(URHO3D_SSE)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define URHO3D_IMAGE_NEON
+#endif
+
 #include "../DebugNew.h"
 
 #ifndef MAKEFOURCC
@@ -216,39 +227,12 @@ struct DDSurfaceDesc2
     unsigned dwTextureStage_;
 };
 
-bool CompressedLevel::Decompress(unsigned char* dest) const
+bool CompressedLevel::Decompress(unsigned char* dest, WorkQueue* queue) const
 {
     if (!data_)
         return false;
 
-    switch (format_)
-    {
-    case CF_DXT1:
-    case CF_DXT3:
-    case CF_DXT5:
-        DecompressImageDXT(dest, data_, width_, height_, depth_, format_);
-        return true;
-
-    // ETC2 format is compatible with ETC1, so we just use the same function.
-    case CF_ETC1:
-    case CF_ETC2_RGB:
-        DecompressImageETC(dest, data_, width_, height_, false);
-        return true;
-    case CF_ETC2_RGBA:
-        DecompressImageETC(dest, data_, width_, height_, true);
-        return true;
-
-    case CF_PVRTC_RGB_2BPP:
-    case CF_PVRTC_RGBA_2BPP:
-    case CF_PVRTC_RGB_4BPP:
-    case CF_PVRTC_RGBA_4BPP:
-        DecompressImagePVRTC(dest, data_, width_, height_, format_);
-        return true;
-
-    default:
-        // Unknown format
-        return false;
-    }
+    return DecompressImage(dest, data_, width_, height_, depth_, format_, queue);
 }
 
 Image::Image(Context* context) :
@@ -872,6 +856,8 @@ bool Image::SaveFile(const String& fileName) const
 {
     if (fileName.EndsWith(".dds", false))
         return SaveDDS(fileName);
+    else if (fileName.EndsWith(".ktx", false))
+        return SaveKTX(fileName);
     else if (fileName.EndsWith(".bmp", false))
         return SaveBMP(fileName);
     else if (fileName.EndsWith(".jpg", false) || fileName.EndsWith(".jpeg", false))
@@ -1337,24 +1323,72 @@ bool Image::SaveDDS(const String& fileName) const
         return false;
     }
 
-    if (IsCompressed())
+    unsigned fourCC = 0;
+    switch (compressedFormat_)
     {
-        URHO3D_LOGERROR("Can not save compressed image to DDS");
+    case CF_NONE:
+        break;
+    case CF_DXT1:
+        fourCC = FOURCC_DXT1;
+        break;
+    case CF_DXT3:
+        fourCC = FOURCC_DXT3;
+        break;
+    case CF_DXT5:
+        fourCC = FOURCC_DXT5;
+        break;
+    default:
+        URHO3D_LOGERROR("Can not save compressed image to DDS in other formats than DXT1, DXT3 and DXT5");
         return false;
     }
 
-    if (components_ != 4)
+    if (!fourCC && components_ != 4)
     {
         URHO3D_LOGERROR("Can not save image with {} components to DDS", components_);
         return false;
     }
 
+    if (fourCC && (depth_ > 1 || nextSibling_))
+    {
+        URHO3D_LOGERROR("Can not save compressed 3D, array or cube image to DDS");
+        return false;
+    }
+
+    outFile.WriteFileID("DDS ");
+
+    if (fourCC)
+    {
+        DDSurfaceDesc2 ddsd;        // NOLINT(hicpp-member-init)
+        memset(&ddsd, 0, sizeof(ddsd));
+        ddsd.dwSize_ = sizeof(ddsd);
+        ddsd.dwFlags_ = 0x00000001l /*DDSD_CAPS*/
+            | 0x00000002l /*DDSD_HEIGHT*/ | 0x00000004l /*DDSD_WIDTH*/ | 0x00020000l /*DDSD_MIPMAPCOUNT*/ | 0x00001000l /*DDSD_PIXELFORMAT*/
+            | 0x00080000l /*DDSD_LINEARSIZE*/;
+        ddsd.dwWidth_ = width_;
+        ddsd.dwHeight_ = height_;
+        ddsd.dwLinearSize_ = GetCompressedLevel(0).dataSize_;
+        ddsd.dwMipMapCount_ = numCompressedLevels_;
+        ddsd.ddpfPixelFormat_.dwFlags_ = 0x00000004l /*DDPF_FOURCC*/;
+        ddsd.ddpfPixelFormat_.dwSize_ = sizeof(ddsd.ddpfPixelFormat_);
+        ddsd.ddpfPixelFormat_.dwFourCC_ = fourCC;
+        ddsd.ddsCaps_.dwCaps_ = DDSCAPS_TEXTURE | (numCompressedLevels_ > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+
+        outFile.Write(&ddsd, sizeof(ddsd));
+        for (unsigned i = 0; i < numCompressedLevels_; ++i)
+        {
+            CompressedLevel level = GetCompressedLevel(i);
+            if (!level.data_)
+                return false;
+            outFile.Write(level.data_, level.dataSize_);
+        }
+
+        return true;
+    }
+
     // Write image
     PODVector<const Image*> levels;
     GetLevels(levels);
 
-    outFile.WriteFileID("DDS ");
-
     DDSurfaceDesc2 ddsd;        // NOLINT(hicpp-member-init)
     memset(&ddsd, 0, sizeof(ddsd));
     ddsd.dwSize_ = sizeof(ddsd);
@@ -1378,6 +1412,91 @@ bool Image::SaveDDS(const String& fileName) const
     return true;
 }
 
+bool Image::SaveKTX(const String& fileName) const
+{
+    URHO3D_PROFILE(SaveImageKTX);
+
+    unsigned internalFormat;
+    switch (compressedFormat_)
+    {
+    case CF_DXT1:
+        internalFormat = 0x83f1;
+        break;
+    case CF_DXT3:
+        internalFormat = 0x83f2;
+        break;
+    case CF_DXT5:
+        internalFormat = 0x83f3;
+        break;
+    case CF_ETC1:
+        internalFormat = 0x8d64;
+        break;
+    case CF_ETC2_RGB:
+        internalFormat = 0x9274;
+        break;
+    case CF_ETC2_RGBA:
+        internalFormat = 0x9278;
+        break;
+    case CF_PVRTC_RGB_4BPP:
+        internalFormat = 0x8c00;
+        break;
+    case CF_PVRTC_RGB_2BPP:
+        internalFormat = 0x8c01;
+        break;
+    case CF_PVRTC_RGBA_4BPP:
+        internalFormat = 0x8c02;
+        break;
+    case CF_PVRTC_RGBA_2BPP:
+        internalFormat = 0x8c03;
+        break;
+    default:
+        URHO3D_LOGERROR("Can not save uncompressed image to KTX");
+        return false;
+    }
+
+    if (depth_ > 1 || nextSibling_)
+    {
+        URHO3D_LOGERROR("Can not save 3D, array or cube image to KTX");
+        return false;
+    }
+
+    File outFile(context_, fileName, FILE_WRITE);
+    if (!outFile.IsOpen())
+    {
+        URHO3D_LOGERROR("Access denied to " + fileName);
+        return false;
+    }
+
+    static const unsigned char identifier[12] = {0xab, 'K', 'T', 'X', ' ', '1', '1', 0xbb, '\r', '\n', 0x1a, '\n'};
+    outFile.Write(identifier, sizeof identifier);
+    outFile.WriteUInt(0x04030201); // Endianness
+    outFile.WriteUInt(0); // Type, 0 for compressed
+    outFile.WriteUInt(1); // Type size
+    outFile.WriteUInt(0); // Format, 0 for compressed
+    outFile.WriteUInt(internalFormat);
+    outFile.WriteUInt(HasAlphaChannel() ? 0x1908 /*GL_RGBA*/ : 0x1907 /*GL_RGB*/);
+    outFile.WriteUInt((unsigned)width_);
+    outFile.WriteUInt((unsigned)height_);
+    outFile.WriteUInt(0); // Depth
+    outFile.WriteUInt(0); // Array elements
+    outFile.WriteUInt(1); // Faces
+    outFile.WriteUInt(numCompressedLevels_);
+    outFile.WriteUInt(0); // Key-value data size
+
+    for (unsigned i = 0; i < numCompressedLevels_; ++i)
+    {
+        CompressedLevel level = GetCompressedLevel(i);
+        if (!level.data_)
+            return false;
+
+        // The levels are padded to 4 bytes, which the block sizes already are
+        outFile.WriteUInt(level.dataSize_);
+        outFile.Write(level.data_, level.dataSize_);
+    }
+
+    return true;
+}
+
 bool Image::SaveWEBP(const String& fileName, float compression /* = 0.0f */) const
 {
 #ifdef URHO3D_WEBP
@@ -1588,6 +1707,258 @@ Color Image::GetPixelTrilinear(float x, float y, float z) const
     return colorNear.Lerp(colorFar, zF);
 }
 
+/// Mip levels with fewer output pixels are generated on the calling thread only.
+static const int MIN_PARALLEL_MIP_PIXELS = 128 * 128;
+
+/// Output rows of a mip level to generate from the level above by averaging.
+struct DownsampleRange
+{
+    /// Source level data.
+    const unsigned char* in_;
+    /// Destination level data.
+    unsigned char* out_;
+    /// Source level width.
+    int width_;
+    /// Source level height.
+    int height_;
+    /// Source level depth.
+    int depth_;
+    /// Number of components.
+    unsigned components_;
+    /// First output row. The rows of all depth slices are counted in sequence.
+    int startRow_;
+    /// End output row.
+    int endRow_;
+};
+
+/// Average a row of 2x2 pixel blocks of a 4-component image. Return the number of output pixels written.
+static int DownsampleRowRGBA(const unsigned char* inUpper, const unsigned char* inLower, unsigned char* out, int widthOut)
+{
+    int x = 0;
+
+#if defined(URHO3D_SSE)
+    // 4 output pixels from 8 source pixels of both rows at a time
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 4 <= widthOut; x += 4)
+    {
+        __m128i upper0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inUpper + x * 8));
+        __m128i upper1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inUpper + x * 8 + 16));
+        __m128i lower0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inLower + x * 8));
+        __m128i lower1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inLower + x * 8 + 16));
+
+        // vertical sums of source pixel pairs in 16 bits
+        __m128i sum01 = _mm_add_epi16(_mm_unpacklo_epi8(upper0, zero), _mm_unpacklo_epi8(lower0, zero));
+        __m128i sum23 = _mm_add_epi16(_mm_unpackhi_epi8(upper0, zero), _mm_unpackhi_epi8(lower0, zero));
+        __m128i sum45 = _mm_add_epi16(_mm_unpacklo_epi8(upper1, zero), _mm_unpacklo_epi8(lower1, zero));
+        __m128i sum67 = _mm_add_epi16(_mm_unpackhi_epi8(upper1, zero), _mm_unpackhi_epi8(lower1, zero));
+
+        // horizontal sums of the even and odd source pixels
+        __m128i out01 = _mm_add_epi16(_mm_unpacklo_epi64(sum01, sum23), _mm_unpackhi_epi64(sum01, sum23));
+        __m128i out23 = _mm_add_epi16(_mm_unpacklo_epi64(sum45, sum67), _mm_unpackhi_epi64(sum45, sum67));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4),
+            _mm_packus_epi16(_mm_srli_epi16(out01, 2), _mm_srli_epi16(out23, 2)));
+    }
+#elif defined(URHO3D_IMAGE_NEON)
+    for (; x + 4 <= widthOut; x += 4)
+    {
+        uint8x16_t upper0 = vld1q_u8(inUpper + x * 8);
+        uint8x16_t upper1 = vld1q_u8(inUpper + x * 8 + 16);
+        uint8x16_t lower0 = vld1q_u8(inLower + x * 8);
+        uint8x16_t lower1 = vld1q_u8(inLower + x * 8 + 16);
+
+        uint16x8_t sum01 = vaddl_u8(vget_low_u8(upper0), vget_low_u8(lower0));
+        uint16x8_t sum23 = vaddl_u8(vget_high_u8(upper0), vget_high_u8(lower0));
+        uint16x8_t sum45 = vaddl_u8(vget_low_u8(upper1), vget_low_u8(lower1));
+        uint16x8_t sum67 = vaddl_u8(vget_high_u8(upper1), vget_high_u8(lower1));
+
+        uint16x8_t out01 = vaddq_u16(vcombine_u16(vget_low_u16(sum01), vget_low_u16(sum23)),
+            vcombine_u16(vget_high_u16(sum01), vget_high_u16(sum23)));
+        uint16x8_t out23 = vaddq_u16(vcombine_u16(vget_low_u16(sum45), vget_low_u16(sum67)),
+            vcombine_u16(vget_high_u16(sum45), vget_high_u16(sum67)));
+        vst1q_u8(out + x * 4, vcombine_u8(vshrn_n_u16(out01, 2), vshrn_n_u16(out23, 2)));
+    }
+#else
+    (void)inUpper;
+    (void)inLower;
+    (void)out;
+    (void)widthOut;
+#endif
+
+    return x;
+}
+
+/// Average a row of 2x2 pixel blocks of a 1-component image. Return the number of output pixels written.
+static int DownsampleRowAlpha(const unsigned char* inUpper, const unsigned char* inLower, unsigned char* out, int widthOut)
+{
+    int x = 0;
+
+#if defined(URHO3D_SSE)
+    // 16 output pixels from 32 source pixels of both rows at a time
+    const __m128i lowBytes = _mm_set1_epi16(0xff);
+    for (; x + 16 <= widthOut; x += 16)
+    {
+        __m128i sums[2];
+        for (int i = 0; i < 2; ++i)
+        {
+            __m128i upper = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inUpper + x * 2 + i * 16));
+            __m128i lower = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inLower + x * 2 + i * 16));
+            sums[i] = _mm_add_epi16(_mm_add_epi16(_mm_and_si128(upper, lowBytes), _mm_srli_epi16(upper, 8)),
+                _mm_add_epi16(_mm_and_si128(lower, lowBytes), _mm_srli_epi16(lower, 8)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x),
+            _mm_packus_epi16(_mm_srli_epi16(sums[0], 2), _mm_srli_epi16(sums[1], 2)));
+    }
+#elif defined(URHO3D_IMAGE_NEON)
+    for (; x + 16 <= widthOut; x += 16)
+    {
+        uint16x8_t sum0 = vaddq_u16(vpaddlq_u8(vld1q_u8(inUpper + x * 2)), vpaddlq_u8(vld1q_u8(inLower + x * 2)));
+        uint16x8_t sum1 = vaddq_u16(vpaddlq_u8(vld1q_u8(inUpper + x * 2 + 16)), vpaddlq_u8(vld1q_u8(inLower + x * 2 + 16)));
+        vst1q_u8(out + x, vcombine_u8(vshrn_n_u16(sum0, 2), vshrn_n_u16(sum1, 2)));
+    }
+#else
+    (void)inUpper;
+    (void)inLower;
+    (void)out;
+    (void)widthOut;
+#endif
+
+    return x;
+}
+
+/// Generate a range of output rows of a mip level.
+static void DownsampleRows(const DownsampleRange& range)
+{
+    const int width = range.width_;
+    const int height = range.height_;
+    const int components = (int)range.components_;
+    const int widthOut = Max(width / 2, 1);
+    const int heightOut = Max(height / 2, 1);
+
+    // 1D case, with the larger dimension as the single row
+    if (range.depth_ == 1 && (height == 1 || width == 1))
+    {
+        const int count = Max(widthOut, heightOut) * components;
+        for (int x = 0; x < count; x += components)
+        {
+            for (int c = 0; c < components; ++c)
+                range.out_[x + c] = (unsigned char)(((unsigned)range.in_[x * 2 + c] + range.in_[x * 2 + components + c]) >> 1);
+        }
+        return;
+    }
+
+    const int slicesInPerOut = range.depth_ > 1 ? 2 : 1;
+    const int rowSize = width * components;
+    const int sliceSize = rowSize * height;
+    const int rowSizeOut = widthOut * components;
+
+    for (int row = range.startRow_; row < range.endRow_; ++row)
+    {
+        const int z = row / heightOut;
+        const int y = row % heightOut;
+        const unsigned char* inUpper = range.in_ + (z * slicesInPerOut) * sliceSize + (y * 2) * rowSize;
+        const unsigned char* inLower = inUpper + rowSize;
+        unsigned char* out = range.out_ + row * rowSizeOut;
+
+        // 3D case
+        if (slicesInPerOut > 1)
+        {
+            const unsigned char* inInnerUpper = inUpper + sliceSize;
+            const unsigned char* inInnerLower = inLower + sliceSize;
+            for (int x = 0; x < rowSizeOut; x += components)
+            {
+                for (int c = 0; c < components; ++c)
+                {
+                    const int i = x * 2 + c;
+                    out[x + c] = (unsigned char)(((unsigned)inUpper[i] + inUpper[i + components] + inLower[i] +
+                        inLower[i + components] + inInnerUpper[i] + inInnerUpper[i + components] + inInnerLower[i] +
+                        inInnerLower[i + components]) >> 3);
+                }
+            }
+            continue;
+        }
+
+        // 2D case, vectorized for the common formats
+        int start = 0;
+        if (components == 4)
+            start = DownsampleRowRGBA(inUpper, inLower, out, widthOut) * 4;
+        else if (components == 1)
+            start = DownsampleRowAlpha(inUpper, inLower, out, widthOut);
+
+        for (int x = start; x < rowSizeOut; x += components)
+        {
+            for (int c = 0; c < components; ++c)
+            {
+                const int i = x * 2 + c;
+                out[x + c] = (unsigned char)(((unsigned)inUpper[i] + inUpper[i + components] + inLower[i] +
+                    inLower[i + components]) >> 2);
+            }
+        }
+    }
+}
+
+/// Work function for generating a range of output rows of a mip level.
+static void DownsampleRowsWork(const WorkItem* item, unsigned /*threadIndex*/)
+{
+    DownsampleRows(*reinterpret_cast<const DownsampleRange*>(item->aux_));
+}
+
+/// Generate the next mip level of image data by averaging. When called from the main thread with a work queue, the rows of large levels are split across the worker threads.
+static void DownsampleLevel(const unsigned char* in, int width, int height, int depth, unsigned components, unsigned char* out,
+    WorkQueue* queue)
+{
+    const int widthOut = Max(width / 2, 1);
+    const int heightOut = Max(height / 2, 1);
+    const int depthOut = Max(depth / 2, 1);
+    // A 1D level is generated as a single range
+    const bool is1D = depth == 1 && (height == 1 || width == 1);
+    const int numRows = is1D ? 1 : heightOut * depthOut;
+
+    // Work items can only be queued from the main thread
+    unsigned numRanges = 1;
+    if (queue && !is1D && widthOut * heightOut * depthOut >= MIN_PARALLEL_MIP_PIXELS && Thread::IsMainThread())
+        numRanges = Min(queue->GetNumThreads() + 1, (unsigned)numRows);
+
+    PODVector<DownsampleRange> ranges(numRanges);
+    for (unsigned i = 0; i < numRanges; ++i)
+    {
+        ranges[i].in_ = in;
+        ranges[i].out_ = out;
+        ranges[i].width_ = width;
+        ranges[i].height_ = height;
+        ranges[i].depth_ = depth;
+        ranges[i].components_ = components;
+        ranges[i].startRow_ = (int)(numRows * i / numRanges);
+        ranges[i].endRow_ = (int)(numRows * (i + 1) / numRanges);
+    }
+
+    Vector<SharedPtr<WorkItem> > items;
+    for (unsigned i = 1; i < numRanges; ++i)
+    {
+        SharedPtr<WorkItem> item(new WorkItem());
+        item->workFunction_ = DownsampleRowsWork;
+        item->aux_ = &ranges[i];
+        item->priority_ = M_MAX_UNSIGNED;
+        queue->AddWorkItem(item);
+        items.Push(item);
+    }
+
+    DownsampleRows(ranges[0]);
+
+    // Generate the ranges no worker thread has taken yet here, and wait for the rest
+    for (unsigned i = 0; i < items.Size(); ++i)
+    {
+        if (items[i]->completed_)
+            continue;
+        if (queue->RemoveWorkItem(items[i]))
+            DownsampleRows(ranges[i + 1]);
+        else
+        {
+            while (!items[i]->completed_)
+                Time::Sleep(0);
+        }
+    }
+}
+
 SharedPtr<Image> Image::GetNextLevel() const
 {
     if (IsCompressed())
@@ -1624,273 +1995,132 @@ SharedPtr<Image> Image::GetNextLevel() const
     else
         mipImage->SetSize(widthOut, heightOut, components_);
 
-    const unsigned char* pixelDataIn = data_.Get();
-    unsigned char* pixelDataOut = mipImage->data_.Get();
+    DownsampleLevel(data_.Get(), width_, height_, depth_, components_, mipImage->data_.Get(), GetSubsystem<WorkQueue>());
 
-    // 1D case
-    if (depth_ == 1 && (height_ == 1 || width_ == 1))
-    {
-        // Loop using the larger dimension
-        if (widthOut < heightOut)
-            widthOut = heightOut;
-
-        switch (components_)
-        {
-        case 1:
-            for (int x = 0; x < widthOut; ++x)
-                pixelDataOut[x] = (unsigned char)(((unsigned)pixelDataIn[x * 2] + pixelDataIn[x * 2 + 1]) >> 1);
-            break;
-
-        case 2:
-            for (int x = 0; x < widthOut * 2; x += 2)
-            {
-                pixelDataOut[x] = (unsigned char)(((unsigned)pixelDataIn[x * 2] + pixelDataIn[x * 2 + 2]) >> 1);
-                pixelDataOut[x + 1] = (unsigned char)(((unsigned)pixelDataIn[x * 2 + 1] + pixelDataIn[x * 2 + 3]) >> 1);
-            }
-            break;
-
-        case 3:
-            for (int x = 0; x < widthOut * 3; x += 3)
-            {
-                pixelDataOut[x] = (unsigned char)(((unsigned)pixelDataIn[x * 2] + pixelDataIn[x * 2 + 3]) >> 1);
-                pixelDataOut[x + 1] = (unsigned char)(((unsigned)pixelDataIn[x * 2 + 1] + pixelDataIn[x * 2 + 4]) >> 1);
-                pixelDataOut[x + 2] = (unsigned char)(((unsigned)pixelDataIn[x * 2 + 2] + pixelDataIn[x * 2 + 5]) >> 1);
-            }
-            break;
+    return mipImage;
+}
 
-        case 4:
-            for (int x = 0; x < widthOut * 4; x += 4)
-            {
-                pixelDataOut[x] = (unsigned char)(((unsigned)pixelDataIn[x * 2] + pixelDataIn[x * 2 + 4]) >> 1);
-                pixelDataOut[x + 1] = (unsigned char)(((unsigned)pixelDataIn[x * 2 + 1] + pixelDataIn[x * 2 + 5]) >> 1);
-                pixelDataOut[x + 2] = (unsigned char)(((unsigned)pixelDataIn[x * 2 + 2] + pixelDataIn[x * 2 + 6]) >> 1);
-                pixelDataOut[x + 3] = (unsigned char)(((unsigned)pixelDataIn[x * 2 + 3] + pixelDataIn[x * 2 + 7]) >> 1);
-            }
-            break;
+SharedArrayPtr<unsigned char> Image::GenerateMipChain(PODVector<unsigned>& levelOffsets) const
+{
+    levelOffsets.Clear();
 
-        default:
-            assert(false);  // Should never reach here
-            break;
-        }
+    if (IsCompressed())
+    {
+        URHO3D_LOGERROR("Can not generate mip levels from compressed data");
+        return SharedArrayPtr<unsigned char>();
     }
-    // 2D case
-    else if (depth_ == 1)
+    if (components_ < 1 || components_ > 4)
     {
-        switch (components_)
-        {
-        case 1:
-            for (int y = 0; y < heightOut; ++y)
-            {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_];
-                unsigned char* out = &pixelDataOut[y * widthOut];
-
-                for (int x = 0; x < widthOut; ++x)
-                {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 1] +
-                                              inLower[x * 2] + inLower[x * 2 + 1]) >> 2);
-                }
-            }
-            break;
+        URHO3D_LOGERROR("Illegal number of image components for mip level generation");
+        return SharedArrayPtr<unsigned char>();
+    }
+    if (!data_)
+        return SharedArrayPtr<unsigned char>();
 
-        case 2:
-            for (int y = 0; y < heightOut; ++y)
-            {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 2];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 2];
-                unsigned char* out = &pixelDataOut[y * widthOut * 2];
+    URHO3D_PROFILE(GenerateImageMipChain);
 
-                for (int x = 0; x < widthOut * 2; x += 2)
-                {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 2] +
-                                              inLower[x * 2] + inLower[x * 2 + 2]) >> 2);
-                    out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 3] +
-                                                  inLower[x * 2 + 1] + inLower[x * 2 + 3]) >> 2);
-                }
-            }
-            break;
+    // Lay out the levels down to 1x1 one after another
+    unsigned totalSize = 0;
+    int width = width_;
+    int height = height_;
+    int depth = depth_;
+    while (width > 1 || height > 1)
+    {
+        width = Max(width / 2, 1);
+        height = Max(height / 2, 1);
+        depth = Max(depth / 2, 1);
+        levelOffsets.Push(totalSize);
+        totalSize += (unsigned)(width * height * depth) * components_;
+    }
 
-        case 3:
-            for (int y = 0; y < heightOut; ++y)
-            {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 3];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 3];
-                unsigned char* out = &pixelDataOut[y * widthOut * 3];
+    if (!totalSize)
+        return SharedArrayPtr<unsigned char>();
 
-                for (int x = 0; x < widthOut * 3; x += 3)
-                {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 3] +
-                                              inLower[x * 2] + inLower[x * 2 + 3]) >> 2);
-                    out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 4] +
-                                                  inLower[x * 2 + 1] + inLower[x * 2 + 4]) >> 2);
-                    out[x + 2] = (unsigned char)(((unsigned)inUpper[x * 2 + 2] + inUpper[x * 2 + 5] +
-                                                  inLower[x * 2 + 2] + inLower[x * 2 + 5]) >> 2);
-                }
-            }
-            break;
+    SharedArrayPtr<unsigned char> levelData(new unsigned char[totalSize]);
+    WorkQueue* queue = GetSubsystem<WorkQueue>();
+    const unsigned char* source = data_.Get();
+    width = width_;
+    height = height_;
+    depth = depth_;
 
-        case 4:
-            for (int y = 0; y < heightOut; ++y)
-            {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 4];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 4];
-                unsigned char* out = &pixelDataOut[y * widthOut * 4];
+    for (unsigned i = 0; i < levelOffsets.Size(); ++i)
+    {
+        unsigned char* dest = levelData.Get() + levelOffsets[i];
+        DownsampleLevel(source, width, height, depth, components_, dest, queue);
+        source = dest;
+        width = Max(width / 2, 1);
+        height = Max(height / 2, 1);
+        depth = Max(depth / 2, 1);
+    }
 
-                for (int x = 0; x < widthOut * 4; x += 4)
-                {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 4] +
-                                              inLower[x * 2] + inLower[x * 2 + 4]) >> 2);
-                    out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 5] +
-                                                  inLower[x * 2 + 1] + inLower[x * 2 + 5]) >> 2);
-                    out[x + 2] = (unsigned char)(((unsigned)inUpper[x * 2 + 2] + inUpper[x * 2 + 6] +
-                                                  inLower[x * 2 + 2] + inLower[x * 2 + 6]) >> 2);
-                    out[x + 3] = (unsigned char)(((unsigned)inUpper[x * 2 + 3] + inUpper[x * 2 + 7] +
-                                                  inLower[x * 2 + 3] + inLower[x * 2 + 7]) >> 2);
-                }
-            }
-            break;
+    return levelData;
+}
 
-        default:
-            assert(false);  // Should never reach here
-            break;
-        }
+SharedPtr<Image> Image::Compress(CompressedFormat format, CompressionQuality quality, bool mipmaps) const
+{
+    if (IsCompressed())
+    {
+        URHO3D_LOGERROR("Can not compress an already compressed image");
+        return SharedPtr<Image>();
     }
-    // 3D case
-    else
+    if (depth_ > 1)
     {
-        switch (components_)
-        {
-        case 1:
-            for (int z = 0; z < depthOut; ++z)
-            {
-                const unsigned char* inOuter = &pixelDataIn[(z * 2) * width_ * height_];
-                const unsigned char* inInner = &pixelDataIn[(z * 2 + 1) * width_ * height_];
-
-                for (int y = 0; y < heightOut; ++y)
-                {
-                    const unsigned char* inOuterUpper = &inOuter[(y * 2) * width_];
-                    const unsigned char* inOuterLower = &inOuter[(y * 2 + 1) * width_];
-                    const unsigned char* inInnerUpper = &inInner[(y * 2) * width_];
-                    const unsigned char* inInnerLower = &inInner[(y * 2 + 1) * width_];
-                    unsigned char* out = &pixelDataOut[z * widthOut * heightOut + y * widthOut];
-
-                    for (int x = 0; x < widthOut; ++x)
-                    {
-                        out[x] = (unsigned char)(((unsigned)inOuterUpper[x * 2] + inOuterUpper[x * 2 + 1] +
-                                                  inOuterLower[x * 2] + inOuterLower[x * 2 + 1] +
-                                                  inInnerUpper[x * 2] + inInnerUpper[x * 2 + 1] +
-                                                  inInnerLower[x * 2] + inInnerLower[x * 2 + 1]) >> 3);
-                    }
-                }
-            }
-            break;
-
-        case 2:
-            for (int z = 0; z < depthOut; ++z)
-            {
-                const unsigned char* inOuter = &pixelDataIn[(z * 2) * width_ * height_ * 2];
-                const unsigned char* inInner = &pixelDataIn[(z * 2 + 1) * width_ * height_ * 2];
-
-                for (int y = 0; y < heightOut; ++y)
-                {
-                    const unsigned char* inOuterUpper = &inOuter[(y * 2) * width_ * 2];
-                    const unsigned char* inOuterLower = &inOuter[(y * 2 + 1) * width_ * 2];
-                    const unsigned char* inInnerUpper = &inInner[(y * 2) * width_ * 2];
-                    const unsigned char* inInnerLower = &inInner[(y * 2 + 1) * width_ * 2];
-                    unsigned char* out = &pixelDataOut[z * widthOut * heightOut * 2 + y * widthOut * 2];
-
-                    for (int x = 0; x < widthOut * 2; x += 2)
-                    {
-                        out[x] = (unsigned char)(((unsigned)inOuterUpper[x * 2] + inOuterUpper[x * 2 + 2] +
-                                                  inOuterLower[x * 2] + inOuterLower[x * 2 + 2] +
-                                                  inInnerUpper[x * 2] + inInnerUpper[x * 2 + 2] +
-                                                  inInnerLower[x * 2] + inInnerLower[x * 2 + 2]) >> 3);
-                        out[x + 1] = (unsigned char)(((unsigned)inOuterUpper[x * 2 + 1] + inOuterUpper[x * 2 + 3] +
-                                                      inOuterLower[x * 2 + 1] + inOuterLower[x * 2 + 3] +
-                                                      inInnerUpper[x * 2 + 1] + inInnerUpper[x * 2 + 3] +
-                                                      inInnerLower[x * 2 + 1] + inInnerLower[x * 2 + 3]) >> 3);
-                    }
-                }
-            }
-            break;
-
-        case 3:
-            for (int z = 0; z < depthOut; ++z)
-            {
-                const unsigned char* inOuter = &pixelDataIn[(z * 2) * width_ * height_ * 3];
-                const unsigned char* inInner = &pixelDataIn[(z * 2 + 1) * width_ * height_ * 3];
-
-                for (int y = 0; y < heightOut; ++y)
-                {
-                    const unsigned char* inOuterUpper = &inOuter[(y * 2) * width_ * 3];
-                    const unsigned char* inOuterLower = &inOuter[(y * 2 + 1) * width_ * 3];
-                    const unsigned char* inInnerUpper = &inInner[(y * 2) * width_ * 3];
-                    const unsigned char* inInnerLower = &inInner[(y * 2 + 1) * width_ * 3];
-                    unsigned char* out = &pixelDataOut[z * widthOut * heightOut * 3 + y * widthOut * 3];
+        URHO3D_LOGERROR("Can not compress a 3D image");
+        return SharedPtr<Image>();
+    }
+    if (!GetCompressedImageSize(1, 1, format))
+    {
+        URHO3D_LOGERROR("Unsupported format for image compression");
+        return SharedPtr<Image>();
+    }
 
-                    for (int x = 0; x < widthOut * 3; x += 3)
-                    {
-                        out[x] = (unsigned char)(((unsigned)inOuterUpper[x * 2] + inOuterUpper[x * 2 + 3] +
-                                                  inOuterLower[x * 2] + inOuterLower[x * 2 + 3] +
-                                                  inInnerUpper[x * 2] + inInnerUpper[x * 2 + 3] +
-                                                  inInnerLower[x * 2] + inInnerLower[x * 2 + 3]) >> 3);
-                        out[x + 1] = (unsigned char)(((unsigned)inOuterUpper[x * 2 + 1] + inOuterUpper[x * 2 + 4] +
-                                                      inOuterLower[x * 2 + 1] + inOuterLower[x * 2 + 4] +
-                                                      inInnerUpper[x * 2 + 1] + inInnerUpper[x * 2 + 4] +
-                                                      inInnerLower[x * 2 + 1] + inInnerLower[x * 2 + 4]) >> 3);
-                        out[x + 2] = (unsigned char)(((unsigned)inOuterUpper[x * 2 + 2] + inOuterUpper[x * 2 + 5] +
-                                                      inOuterLower[x * 2 + 2] + inOuterLower[x * 2 + 5] +
-                                                      inInnerUpper[x * 2 + 2] + inInnerUpper[x * 2 + 5] +
-                                                      inInnerLower[x * 2 + 2] + inInnerLower[x * 2 + 5]) >> 3);
-                    }
-                }
-            }
-            break;
+    SharedPtr<Image> rgbaImage = ConvertToRGBA();
+    if (!rgbaImage)
+        return SharedPtr<Image>();
 
-        case 4:
-            for (int z = 0; z < depthOut; ++z)
-            {
-                const unsigned char* inOuter = &pixelDataIn[(z * 2) * width_ * height_ * 4];
-                const unsigned char* inInner = &pixelDataIn[(z * 2 + 1) * width_ * height_ * 4];
+    URHO3D_PROFILE(CompressImage);
 
-                for (int y = 0; y < heightOut; ++y)
-                {
-                    const unsigned char* inOuterUpper = &inOuter[(y * 2) * width_ * 4];
-                    const unsigned char* inOuterLower = &inOuter[(y * 2 + 1) * width_ * 4];
-                    const unsigned char* inInnerUpper = &inInner[(y * 2) * width_ * 4];
-                    const unsigned char* inInnerLower = &inInner[(y * 2 + 1) * width_ * 4];
-                    unsigned char* out = &pixelDataOut[z * widthOut * heightOut * 4 + y * widthOut * 4];
+    PODVector<unsigned> levelOffsets;
+    SharedArrayPtr<unsigned char> mipData;
+    if (mipmaps)
+        mipData = rgbaImage->GenerateMipChain(levelOffsets);
 
-                    for (int x = 0; x < widthOut * 4; x += 4)
-                    {
-                        out[x] = (unsigned char)(((unsigned)inOuterUpper[x * 2] + inOuterUpper[x * 2 + 4] +
-                                                  inOuterLower[x * 2] + inOuterLower[x * 2 + 4] +
-                                                  inInnerUpper[x * 2] + inInnerUpper[x * 2 + 4] +
-                                                  inInnerLower[x * 2] + inInnerLower[x * 2 + 4]) >> 3);
-                        out[x + 1] = (unsigned char)(((unsigned)inOuterUpper[x * 2 + 1] + inOuterUpper[x * 2 + 5] +
-                                                      inOuterLower[x * 2 + 1] + inOuterLower[x * 2 + 5] +
-                                                      inInnerUpper[x * 2 + 1] + inInnerUpper[x * 2 + 5] +
-                                                      inInnerLower[x * 2 + 1] + inInnerLower[x * 2 + 5]) >> 3);
-                        out[x + 2] = (unsigned char)(((unsigned)inOuterUpper[x * 2 + 2] + inOuterUpper[x * 2 + 6] +
-                                                      inOuterLower[x * 2 + 2] + inOuterLower[x * 2 + 6] +
-                                                      inInnerUpper[x * 2 + 2] + inInnerUpper[x * 2 + 6] +
-                                                      inInnerLower[x * 2 + 2] + inInnerLower[x * 2 + 6]) >> 3);
-                        out[x + 3] = (unsigned char)(((unsigned)inOuterUpper[x * 2 + 3] + inOuterUpper[x * 2 + 7] +
-                                                      inOuterLower[x * 2 + 3] + inOuterLower[x * 2 + 7] +
-                                                      inInnerUpper[x * 2 + 3] + inInnerUpper[x * 2 + 7] +
-                                                      inInnerLower[x * 2 + 3] + inInnerLower[x * 2 + 7]) >> 3);
-                    }
-                }
-            }
-            break;
+    // Compress the levels one after another, like they are read from DDS and KTX files
+    unsigned totalSize = 0;
+    int width = width_;
+    int height = height_;
+    for (unsigned i = 0; i <= levelOffsets.Size(); ++i)
+    {
+        totalSize += GetCompressedImageSize(width, height, format);
+        width = Max(width / 2, 1);
+        height = Max(height / 2, 1);
+    }
 
-        default:
-            assert(false);  // Should never reach here
-            break;
-        }
+    SharedArrayPtr<unsigned char> compressedData(new unsigned char[totalSize]);
+    WorkQueue* queue = GetSubsystem<WorkQueue>();
+    unsigned offset = 0;
+    width = width_;
+    height = height_;
+    for (unsigned i = 0; i <= levelOffsets.Size(); ++i)
+    {
+        const unsigned char* source = i ? mipData.Get() + levelOffsets[i - 1] : rgbaImage->GetData();
+        CompressImage(compressedData.Get() + offset, source, width, height, format, quality, queue);
+        offset += GetCompressedImageSize(width, height, format);
+        width = Max(width / 2, 1);
+        height = Max(height / 2, 1);
     }
 
-    return mipImage;
+    SharedPtr<Image> ret(new Image(context_));
+    ret->width_ = width_;
+    ret->height_ = height_;
+    ret->depth_ = 1;
+    ret->components_ = (format == CF_ETC1 || format == CF_ETC2_RGB) ? 3 : 4;
+    ret->compressedFormat_ = format;
+    ret->numCompressedLevels_ = levelOffsets.Size() + 1;
+    ret->sRGB_ = sRGB_;
+    ret->data_ = compressedData;
+    ret->SetMemoryUse(totalSize);
+    return ret;
 }
 
 SharedPtr<Image> Image::ConvertToRGBA() const
@@ -2107,7 +2337,7 @@ SharedPtr<Image> Image::GetDecompressedImage() const
 
     auto decompressedImage = MakeShared<Image>(context_);
     decompressedImage->SetSize(compressedLevel.width_, compressedLevel.height_, 4);
-    compressedLevel.Decompress(decompressedImage->GetData());
+    compressedLevel.Decompress(decompressedImage->GetData(), GetSubsystem<WorkQueue>());
 
     return decompressedImage;
 }
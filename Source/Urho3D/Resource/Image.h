@@ -32,6 +32,8 @@ struct SDL_Surface;
 namespace Urho3D
 {
 
+class WorkQueue;
+
 static const int COLOR_LUT_SIZE = 16;
 
 /// Supported compressed image formats.
@@ -51,11 +53,19 @@ enum CompressedFormat
     CF_PVRTC_RGBA_4BPP,
 };
 
+/// Block compression quality. Higher qualities search more encodings per block and take longer.
+enum CompressionQuality
+{
+    CQ_FAST = 0,
+    CQ_NORMAL,
+    CQ_HIGH,
+};
+
 /// Compressed image mip level.
 struct CompressedLevel
 {
-    /// Decompress to RGBA. The destination buffer required is width * height * 4 bytes. Return true if successful.
-    bool Decompress(unsigned char* dest) const;
+    /// Decompress to RGBA. The destination buffer required is width * height * 4 bytes. Large levels are decompressed on the work queue threads too when given one and called from the main thread. Return true if successful.
+    bool Decompress(unsigned char* dest, WorkQueue* queue = nullptr) const;
 
     /// Compressed image data.
     unsigned char* data_{};
@@ -132,8 +142,10 @@ public:
     bool SaveTGA(const String& fileName) const;
     /// Save in JPG format with specified quality. Return true if successful.
     bool SaveJPG(const String& fileName, int quality) const;
-    /// Save in DDS format. Only uncompressed RGBA images are supported. Return true if successful.
+    /// Save in DDS format. Uncompressed RGBA and DXT compressed images are supported. Return true if successful.
     bool SaveDDS(const String& fileName) const;
+    /// Save in KTX format. Only DXT, ETC and PVRTC compressed 2D images are supported. Return true if successful.
+    bool SaveKTX(const String& fileName) const;
     /// Save in WebP format with minimum (fastest) or specified compression. Return true if successful. Fails always if WebP support is not compiled in.
     bool SaveWEBP(const String& fileName, float compression = 0.0f) const;
     /// Whether this texture is detected as a cubemap, only relevant for DDS.
@@ -192,8 +204,13 @@ public:
 
     /// Return next mip level by bilinear filtering. Note that if the image is already 1x1x1, will keep returning an image of that size.
     SharedPtr<Image> GetNextLevel() const;
+    /// Generate all mip levels below this one down to 1x1 into one contiguous buffer and return it, or null if not possible. The byte offset of each level in the buffer, starting from the first level below this one, is written to levelOffsets. Large levels are generated on the work queue threads too when called from the main thread.
+    /// @nobind
+    SharedArrayPtr<unsigned char> GenerateMipChain(PODVector<unsigned>& levelOffsets) const;
     /// Return the next sibling image of an array or cubemap.
     SharedPtr<Image> GetNextSibling() const { return nextSibling_;  }
+    /// Return the image compressed to DXT1, DXT3, DXT5, ETC1, ETC2 RGB or ETC2 RGBA, with the mip levels down to 1x1 generated by bilinear filtering when mipmaps is true, or null if failed. Only uncompressed 2D images are supported. Large levels are compressed on the work queue threads too when called from the main thread.
+    SharedPtr<Image> Compress(CompressedFormat format, CompressionQuality quality = CQ_NORMAL, bool mipmaps = true) const;
     /// Return image converted to 4-component (RGBA) to circumvent modern rendering API's not supporting e.g. the luminance-alpha format.
     SharedPtr<Image> ConvertToRGBA() const;
     /// Return a compressed mip level.
@@ -28,12 +28,14 @@
 #include "../IO/Deserializer.h"
 #include "../IO/Log.h"
 #include "../IO/MemoryBuffer.h"
+#include "../IO/VectorBuffer.h"
 #include "../Resource/JSONFile.h"
 #include "../Resource/ResourceCache.h"
 
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/reader.h>
 
 #include "../DebugNew.h"
 
@@ -42,8 +44,105 @@ using namespace rapidjson;
 namespace Urho3D
 {
 
+/// Arena-allocated rapidjson document parsed in place from its text buffer.
+struct JSONArenaDocument
+{
+    /// Text buffer, which also holds the parsed strings.
+    SharedArrayPtr<char> buffer_;
+    /// Document, which allocates all values from its memory pool.
+    rapidjson::Document document_;
+};
+
+/// Buffered rapidjson input stream over a deserializer.
+class JSONInputStream
+{
+public:
+    typedef char Ch;
+
+    /// Construct and fill the first buffer.
+    explicit JSONInputStream(Deserializer& source) :
+        source_(source),
+        position_(0),
+        size_(0),
+        count_(0)
+    {
+        Fill();
+    }
+
+    /// Return the current character without consuming it.
+    Ch Peek() const { return position_ < size_ ? buffer_[position_] : '\0'; }
+
+    /// Consume and return the current character.
+    Ch Take()
+    {
+        Ch c = Peek();
+        if (position_ < size_)
+        {
+            ++count_;
+            if (++position_ == size_)
+                Fill();
+        }
+        return c;
+    }
+
+    /// Return number of characters consumed.
+    size_t Tell() const { return count_; }
+
+    // Writing is not supported.
+    Ch* PutBegin() { assert(false); return nullptr; }
+    void Put(Ch) { assert(false); }
+    void Flush() { assert(false); }
+    size_t PutEnd(Ch*) { assert(false); return 0; }
+
+private:
+    /// Read the next block of data.
+    void Fill()
+    {
+        size_ = source_.IsEof() ? 0 : source_.Read(buffer_, sizeof buffer_);
+        position_ = 0;
+    }
+
+    /// Source stream.
+    Deserializer& source_;
+    /// Read buffer.
+    char buffer_[16384];
+    /// Position in the read buffer.
+    unsigned position_;
+    /// Amount of data in the read buffer.
+    unsigned size_;
+    /// Characters consumed in total.
+    size_t count_;
+};
+
+/// Forwards rapidjson reader events to a stream handler.
+struct JSONReaderAdapter
+{
+    explicit JSONReaderAdapter(JSONStreamHandler& handler) :
+        handler_(handler)
+    {
+    }
+
+    bool Null() { return handler_.OnNull(); }
+    bool Bool(bool b) { return handler_.OnBool(b); }
+    bool Int(int i) { return handler_.OnInt(i); }
+    bool Uint(unsigned u) { return handler_.OnUInt(u); }
+    bool Int64(int64_t i) { return handler_.OnDouble((double)i); }
+    bool Uint64(uint64_t u) { return handler_.OnDouble((double)u); }
+    bool Double(double d) { return handler_.OnDouble(d); }
+    bool RawNumber(const char* str, SizeType length, bool) { return handler_.OnString(str, length); }
+    bool String(const char* str, SizeType length, bool) { return handler_.OnString(str, length); }
+    bool StartObject() { return handler_.OnStartObject(); }
+    bool Key(const char* str, SizeType length, bool) { return handler_.OnKey(str, length); }
+    bool EndObject(SizeType memberCount) { return handler_.OnEndObject(memberCount); }
+    bool StartArray() { return handler_.OnStartArray(); }
+    bool EndArray(SizeType elementCount) { return handler_.OnEndArray(elementCount); }
+
+    JSONStreamHandler& handler_;
+};
+
 JSONFile::JSONFile(Context* context) :
-    Resource(context)
+    Resource(context),
+    arenaMode_(false)
 {
 }
 
@@ -111,6 +210,323 @@ static void ToJSONValue(JSONValue& jsonValue, const rapidjson::Value& rapidjsonV
     }
 }
 
+/// Return the rapidjson value of a view.
+static inline const rapidjson::Value* GetRapidjsonValue(const void* value)
+{
+    return static_cast<const rapidjson::Value*>(value);
+}
+
+JSONValueType JSONView::GetValueType() const
+{
+    if (!value_)
+        return JSON_NULL;
+
+    switch (GetRapidjsonValue(value_)->GetType())
+    {
+    case kFalseType:
+    case kTrueType:
+        return JSON_BOOL;
+
+    case kNumberType:
+        return JSON_NUMBER;
+
+    case kStringType:
+        return JSON_STRING;
+
+    case kArrayType:
+        return JSON_ARRAY;
+
+    case kObjectType:
+        return JSON_OBJECT;
+
+    default:
+        return JSON_NULL;
+    }
+}
+
+bool JSONView::GetBool(bool defaultValue) const
+{
+    return IsBool() ? GetRapidjsonValue(value_)->GetBool() : defaultValue;
+}
+
+int JSONView::GetInt(int defaultValue) const
+{
+    if (!IsNumber())
+        return defaultValue;
+    const rapidjson::Value* value = GetRapidjsonValue(value_);
+    return value->IsInt() ? value->GetInt() : (int)value->GetDouble();
+}
+
+unsigned JSONView::GetUInt(unsigned defaultValue) const
+{
+    if (!IsNumber())
+        return defaultValue;
+    const rapidjson::Value* value = GetRapidjsonValue(value_);
+    return value->IsUint() ? value->GetUint() : (unsigned)value->GetDouble();
+}
+
+float JSONView::GetFloat(float defaultValue) const
+{
+    return IsNumber() ? (float)GetRapidjsonValue(value_)->GetDouble() : defaultValue;
+}
+
+double JSONView::GetDouble(double defaultValue) const
+{
+    return IsNumber() ? GetRapidjsonValue(value_)->GetDouble() : defaultValue;
+}
+
+const char* JSONView::GetCString(const char* defaultValue) const
+{
+    return IsString() ? GetRapidjsonValue(value_)->GetString() : defaultValue;
+}
+
+unsigned JSONView::GetStringLength() const
+{
+    return IsString() ? GetRapidjsonValue(value_)->GetStringLength() : 0;
+}
+
+String JSONView::GetString(const String& defaultValue) const
+{
+    return IsString() ? String(GetRapidjsonValue(value_)->GetString(), GetRapidjsonValue(value_)->GetStringLength()) : defaultValue;
+}
+
+unsigned JSONView::Size() const
+{
+    if (IsArray())
+        return GetRapidjsonValue(value_)->Size();
+    else if (IsObject())
+        return GetRapidjsonValue(value_)->MemberCount();
+    else
+        return 0;
+}
+
+JSONView JSONView::operator [](unsigned index) const
+{
+    if (!IsArray() || index >= GetRapidjsonValue(value_)->Size())
+        return JSONView();
+
+    return JSONView(&(*GetRapidjsonValue(value_))[index]);
+}
+
+JSONView JSONView::Get(const char* name) const
+{
+    if (!IsObject())
+        return JSONView();
+
+    const rapidjson::Value* value = GetRapidjsonValue(value_);
+    rapidjson::Value::ConstMemberIterator i = value->FindMember(name);
+    return i != value->MemberEnd() ? JSONView(&i->value) : JSONView();
+}
+
+const char* JSONView::GetMemberName(unsigned index) const
+{
+    if (!IsObject() || index >= GetRapidjsonValue(value_)->MemberCount())
+        return "";
+
+    return (GetRapidjsonValue(value_)->MemberBegin() + index)->name.GetString();
+}
+
+JSONView JSONView::GetMemberValue(unsigned index) const
+{
+    if (!IsObject() || index >= GetRapidjsonValue(value_)->MemberCount())
+        return JSONView();
+
+    return JSONView(&(GetRapidjsonValue(value_)->MemberBegin() + index)->value);
+}
+
+void JSONView::ToJSONValue(JSONValue& dest) const
+{
+    if (value_)
+        Urho3D::ToJSONValue(dest, *GetRapidjsonValue(value_));
+    else
+        dest.SetType(JSON_NULL);
+}
+
+/// Value types in the compiled binary form.
+enum JSONBinaryType
+{
+    JSONBT_NULL = 0,
+    JSONBT_FALSE,
+    JSONBT_TRUE,
+    JSONBT_INT,
+    JSONBT_UINT,
+    JSONBT_DOUBLE,
+    JSONBT_STRING,
+    JSONBT_ARRAY,
+    JSONBT_OBJECT
+};
+
+/// Read a null-terminated string in place from the compiled binary form. The data must be null-terminated at the end.
+static const char* ReadBinaryString(const char*& pos, const char* end)
+{
+    const char* str = pos;
+    pos += String::CStringLength(str) + 1;
+    return pos <= end ? str : nullptr;
+}
+
+/// Read a plain value from the compiled binary form.
+template <class T> static bool ReadBinaryValue(const char*& pos, const char* end, T& value)
+{
+    if (pos + sizeof(T) > end)
+        return false;
+    memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+/// Write a JSON value to the compiled binary form.
+static void WriteBinaryValue(Serializer& dest, const JSONValue& jsonValue)
+{
+    switch (jsonValue.GetValueType())
+    {
+    case JSON_BOOL:
+        dest.WriteUByte(jsonValue.GetBool() ? JSONBT_TRUE : JSONBT_FALSE);
+        break;
+
+    case JSON_NUMBER:
+        switch (jsonValue.GetNumberType())
+        {
+        case JSONNT_INT:
+            dest.WriteUByte(JSONBT_INT);
+            dest.WriteInt(jsonValue.GetInt());
+            break;
+
+        case JSONNT_UINT:
+            dest.WriteUByte(JSONBT_UINT);
+            dest.WriteUInt(jsonValue.GetUInt());
+            break;
+
+        default:
+            dest.WriteUByte(JSONBT_DOUBLE);
+            dest.WriteDouble(jsonValue.GetDouble());
+            break;
+        }
+        break;
+
+    case JSON_STRING:
+        dest.WriteUByte(JSONBT_STRING);
+        dest.WriteString(jsonValue.GetString());
+        break;
+
+    case JSON_ARRAY:
+        {
+            const JSONArray& jsonArray = jsonValue.GetArray();
+            dest.WriteUByte(JSONBT_ARRAY);
+            dest.WriteUInt(jsonArray.Size());
+            for (unsigned i = 0; i < jsonArray.Size(); ++i)
+                WriteBinaryValue(dest, jsonArray[i]);
+        }
+        break;
+
+    case JSON_OBJECT:
+        {
+            const JSONObject& jsonObject = jsonValue.GetObject();
+            dest.WriteUByte(JSONBT_OBJECT);
+            dest.WriteUInt(jsonObject.Size());
+            for (JSONObject::ConstIterator i = jsonObject.Begin(); i != jsonObject.End(); ++i)
+            {
+                dest.WriteString(i->first_);
+                WriteBinaryValue(dest, i->second_);
+            }
+        }
+        break;
+
+    default:
+        dest.WriteUByte(JSONBT_NULL);
+        break;
+    }
+}
+
+/// Read a JSON value from the compiled binary form.
+static bool ReadBinaryValue(const char*& pos, const char* end, JSONValue& jsonValue)
+{
+    if (pos >= end)
+        return false;
+
+    switch (*pos++)
+    {
+    case JSONBT_NULL:
+        jsonValue.SetType(JSON_NULL);
+        return true;
+
+    case JSONBT_FALSE:
+        jsonValue = false;
+        return true;
+
+    case JSONBT_TRUE:
+        jsonValue = true;
+        return true;
+
+    case JSONBT_INT:
+        {
+            int value;
+            if (!ReadBinaryValue(pos, end, value))
+                return false;
+            jsonValue = value;
+        }
+        return true;
+
+    case JSONBT_UINT:
+        {
+            unsigned value;
+            if (!ReadBinaryValue(pos, end, value))
+                return false;
+            jsonValue = value;
+        }
+        return true;
+
+    case JSONBT_DOUBLE:
+        {
+            double value;
+            if (!ReadBinaryValue(pos, end, value))
+                return false;
+            jsonValue = value;
+        }
+        return true;
+
+    case JSONBT_STRING:
+        {
+            const char* value = ReadBinaryString(pos, end);
+            if (!value)
+                return false;
+            jsonValue = value;
+        }
+        return true;
+
+    case JSONBT_ARRAY:
+        {
+            unsigned size;
+            if (!ReadBinaryValue(pos, end, size) || size > (unsigned)(end - pos))
+                return false;
+            jsonValue.Resize(size);
+            for (unsigned i = 0; i < size; ++i)
+            {
+                if (!ReadBinaryValue(pos, end, jsonValue[i]))
+                    return false;
+            }
+        }
+        return true;
+
+    case JSONBT_OBJECT:
+        {
+            unsigned size;
+            if (!ReadBinaryValue(pos, end, size))
+                return false;
+            jsonValue.SetType(JSON_OBJECT);
+            for (unsigned i = 0; i < size; ++i)
+            {
+                const char* name = ReadBinaryString(pos, end);
+                if (!name || !ReadBinaryValue(pos, end, jsonValue[String(name)]))
+                    return false;
+            }
+        }
+        return true;
+
+    default:
+        return false;
+    }
+}
+
 bool JSONFile::BeginLoad(Deserializer& source)
 {
     unsigned dataSize = source.GetSize();
@@ -120,6 +536,49 @@ bool JSONFile::BeginLoad(Deserializer& source)
         return false;
     }
 
+    arena_.Reset();
+
+    if (arenaMode_)
+    {
+        root_ = JSONValue::EMPTY;
+        if (!LoadArena(source, dataSize))
+            return false;
+
+        SetMemoryUse(dataSize + (unsigned)arena_->document_.GetAllocator().Capacity());
+        return true;
+    }
+
+    if (!LoadRoot(source, dataSize))
+        return false;
+
+    SetMemoryUse(dataSize);
+
+    return true;
+}
+
+bool JSONFile::LoadRoot(Deserializer& source, unsigned dataSize)
+{
+    // The compiled binary form may be stored in place of the text, for example by PackageTool
+    unsigned start = source.GetPosition();
+    if (dataSize >= 4)
+    {
+        if (source.ReadFileID() == "UJSN")
+        {
+            if (LoadBinary(source))
+                return true;
+
+            URHO3D_LOGERROR("Could not load compiled JSON data from " + source.GetName());
+            return false;
+        }
+        source.Seek(start);
+    }
+
+    // Use the compiled form from the compiled resource directory if it has been made from this source file
+    auto* cache = GetSubsystem<ResourceCache>();
+    SharedPtr<File> compiledFile = cache ? cache->GetCompiledFile(source) : SharedPtr<File>();
+    if (compiledFile && compiledFile->ReadFileID() == "UJSN" && LoadBinary(*compiledFile))
+        return true;
+
     SharedArrayPtr<char> buffer(new char[dataSize + 1]);
     if (source.Read(buffer.Get(), dataSize) != dataSize)
         return false;
@@ -134,8 +593,89 @@ bool JSONFile::BeginLoad(Deserializer& source)
 
     ToJSONValue(root_, document);
 
-    SetMemoryUse(dataSize);
+    // Store the compiled form for the next load
+    if (cache && !cache->GetCompiledResourceDir().Empty())
+    {
+        VectorBuffer compiledData;
+        if (SaveBinary(compiledData))
+            cache->SaveCompiledFile(source, compiledData.GetData(), compiledData.GetSize());
+    }
+
+    return true;
+}
+
+bool JSONFile::LoadArena(Deserializer& source, unsigned dataSize)
+{
+    UniquePtr<JSONArenaDocument> arena(new JSONArenaDocument());
+    arena->buffer_ = new char[dataSize + 1];
+    if (source.Read(arena->buffer_.Get(), dataSize) != dataSize)
+        return false;
+    arena->buffer_[dataSize] = '\0';
+
+    if (dataSize >= 4 && !memcmp(arena->buffer_.Get(), "UJSN", 4))
+    {
+        URHO3D_LOGERROR("Compiled JSON data can not be loaded in arena mode from " + source.GetName());
+        return false;
+    }
+
+    // Parse in place, so that strings point into the text buffer and values are allocated from the document's pool
+    if (arena->document_.ParseInsitu<kParseCommentsFlag | kParseTrailingCommasFlag>(arena->buffer_.Get()).HasParseError())
+    {
+        URHO3D_LOGERROR("Could not parse JSON data from " + source.GetName());
+        return false;
+    }
+
+    arena_ = arena.Detach();
+    return true;
+}
+
+JSONView JSONFile::GetArenaRoot() const
+{
+    return arena_ ? JSONView(&arena_->document_) : JSONView();
+}
+
+bool JSONFile::ParseStream(Deserializer& source, JSONStreamHandler& handler)
+{
+    JSONInputStream stream(source);
+    JSONReaderAdapter adapter(handler);
+    rapidjson::Reader reader;
+
+    ParseResult result = reader.Parse<kParseCommentsFlag | kParseTrailingCommasFlag>(stream, adapter);
+    if (result.IsError())
+    {
+        // Stopping from the handler is not an error worth logging
+        if (result.Code() != kParseErrorTermination)
+            URHO3D_LOGERROR("Could not parse JSON data from " + source.GetName() + " at offset " + String((unsigned)result.Offset()));
+        return false;
+    }
+
+    return true;
+}
+
+bool JSONFile::LoadBinary(Deserializer& source)
+{
+    unsigned dataSize = source.GetSize() - source.GetPosition();
+    SharedArrayPtr<char> buffer(new char[dataSize + 1]);
+    if (source.Read(buffer.Get(), dataSize) != dataSize)
+        return false;
+    // Terminate the data so that reading a truncated string stops at the end
+    buffer[dataSize] = '\0';
+
+    const char* pos = buffer.Get();
+    root_ = JSONValue::EMPTY;
+    if (ReadBinaryValue(pos, pos + dataSize, root_))
+        return true;
+
+    root_ = JSONValue::EMPTY;
+    return false;
+}
+
+bool JSONFile::SaveBinary(Serializer& dest) const
+{
+    if (!dest.WriteFileID("UJSN"))
+        return false;
 
+    WriteBinaryValue(dest, root_);
     return true;
 }
 
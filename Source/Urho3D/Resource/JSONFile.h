@@ -28,6 +28,112 @@
 namespace Urho3D
 {
 
+struct JSONArenaDocument;
+
+/// Read-only view of a value in an arena-allocated JSON document. Valid only as long as the owning JSON file is loaded.
+class URHO3D_API JSONView
+{
+    friend class JSONFile;
+
+public:
+    /// Construct a null view.
+    JSONView() :
+        value_(nullptr)
+    {
+    }
+
+    /// Return value type.
+    JSONValueType GetValueType() const;
+    /// Return whether the view refers to a value.
+    bool NotNull() const { return value_ != nullptr; }
+    /// Check is null.
+    bool IsNull() const { return GetValueType() == JSON_NULL; }
+    /// Check is boolean.
+    bool IsBool() const { return GetValueType() == JSON_BOOL; }
+    /// Check is number.
+    bool IsNumber() const { return GetValueType() == JSON_NUMBER; }
+    /// Check is string.
+    bool IsString() const { return GetValueType() == JSON_STRING; }
+    /// Check is array.
+    bool IsArray() const { return GetValueType() == JSON_ARRAY; }
+    /// Check is object.
+    bool IsObject() const { return GetValueType() == JSON_OBJECT; }
+
+    /// Return boolean value.
+    bool GetBool(bool defaultValue = false) const;
+    /// Return integer value.
+    int GetInt(int defaultValue = 0) const;
+    /// Return unsigned integer value.
+    unsigned GetUInt(unsigned defaultValue = 0) const;
+    /// Return float value.
+    float GetFloat(float defaultValue = 0.0f) const;
+    /// Return double value.
+    double GetDouble(double defaultValue = 0.0) const;
+    /// Return C string value. The string is stored in the document and is not copied.
+    const char* GetCString(const char* defaultValue = "") const;
+    /// Return length of the string value.
+    unsigned GetStringLength() const;
+    /// Return string value as a copy.
+    String GetString(const String& defaultValue = String::EMPTY) const;
+
+    /// Return number of array elements or object members.
+    unsigned Size() const;
+    /// Return array element, or a null view if out of range.
+    JSONView operator [](unsigned index) const;
+    /// Return object member by name, or a null view if not found.
+    JSONView Get(const char* name) const;
+    /// Return whether the object has a member.
+    bool Contains(const char* name) const { return Get(name).NotNull(); }
+    /// Return name of object member by index.
+    const char* GetMemberName(unsigned index) const;
+    /// Return value of object member by index.
+    JSONView GetMemberValue(unsigned index) const;
+
+    /// Copy the value and all its children to a JSON value.
+    void ToJSONValue(JSONValue& dest) const;
+
+private:
+    /// Construct from a rapidjson value.
+    explicit JSONView(const void* value) :
+        value_(value)
+    {
+    }
+
+    /// Viewed rapidjson value.
+    const void* value_;
+};
+
+/// Handler for streaming JSON parsing. Each callback returns false to stop parsing.
+class URHO3D_API JSONStreamHandler
+{
+public:
+    /// Destruct.
+    virtual ~JSONStreamHandler() = default;
+
+    /// Handle a null value.
+    virtual bool OnNull() { return true; }
+    /// Handle a boolean value.
+    virtual bool OnBool(bool value) { return true; }
+    /// Handle an integer value.
+    virtual bool OnInt(int value) { return true; }
+    /// Handle an unsigned integer value.
+    virtual bool OnUInt(unsigned value) { return true; }
+    /// Handle a double value. Also used for integers out of 32-bit range.
+    virtual bool OnDouble(double value) { return true; }
+    /// Handle a string value. The string is null-terminated and valid only during the call.
+    virtual bool OnString(const char* value, unsigned length) { return true; }
+    /// Handle the start of an object.
+    virtual bool OnStartObject() { return true; }
+    /// Handle an object member name. The name is null-terminated and valid only during the call.
+    virtual bool OnKey(const char* name, unsigned length) { return true; }
+    /// Handle the end of an object.
+    virtual bool OnEndObject(unsigned memberCount) { return true; }
+    /// Handle the start of an array.
+    virtual bool OnStartArray() { return true; }
+    /// Handle the end of an array.
+    virtual bool OnEndArray(unsigned elementCount) { return true; }
+};
+
 /// JSON document resource.
 class URHO3D_API JSONFile : public Resource
 {
@@ -48,6 +154,8 @@ public:
     bool Save(Serializer& dest) const override;
     /// Save resource with user-defined indentation, only the first character (if any) of the string is used and the length of the string defines the character count. Return true if successful.
     bool Save(Serializer& dest, const String& indendation) const;
+    /// Save resource in the compiled binary form, which loads without parsing text. Return true if successful.
+    bool SaveBinary(Serializer& dest) const;
 
     /// Deserialize from a string. Return true if successful.
     bool FromString(const String& source);
@@ -60,9 +168,33 @@ public:
     /// Return root value.
     const JSONValue& GetRoot() const { return root_; }
 
+    /// Set whether to load text into an arena-allocated read-only document instead of the root value. Takes effect on the next load.
+    /// @property
+    void SetArenaMode(bool enable) { arenaMode_ = enable; }
+    /// Return whether loads into an arena-allocated document.
+    /// @property
+    bool GetArenaMode() const { return arenaMode_; }
+    /// Return root of the arena-allocated document, or a null view if not loaded in arena mode.
+    JSONView GetArenaRoot() const;
+
+    /// Parse JSON text from a stream without building a document, reporting values to the handler. Return true if successful.
+    static bool ParseStream(Deserializer& source, JSONStreamHandler& handler);
+
 private:
+    /// Load the root value from text or from the compiled binary form.
+    bool LoadRoot(Deserializer& source, unsigned dataSize);
+    /// Load the root value from the compiled binary form. The file ID has already been read.
+    bool LoadBinary(Deserializer& source);
+
+    /// Load the text into the arena-allocated document.
+    bool LoadArena(Deserializer& source, unsigned dataSize);
+
     /// JSON root value.
     JSONValue root_;
+    /// Arena-allocated document when loaded in arena mode.
+    UniquePtr<JSONArenaDocument> arena_;
+    /// Arena mode flag.
+    bool arenaMode_;
 };
 
 }
@@ -24,7 +24,9 @@
 
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
+#include "../Core/Metrics.h"
 #include "../Core/Profiler.h"
+#include "../Core/Timer.h"
 #include "../Core/WorkQueue.h"
 #include "../IO/FileSystem.h"
 #include "../IO/FileWatcher.h"
@@ -67,17 +69,54 @@ static const char* checkDirs[] =
 
 static const SharedPtr<Resource> noResource;
 
+/// Version of the compiled resource files. Increment when the compiled formats change.
+static const unsigned COMPILED_FILE_VERSION = 1;
+
+/// Immutable lookup table of the loaded resources of one type. Shared between lookup snapshots until the type changes.
+struct ResourceLookupGroup : public RefCounted
+{
+    /// Name hashes of the loaded resources.
+    HashSet<StringHash> names_;
+};
+
+/// Immutable snapshot of the loaded resources, read without locking outside the main thread.
+struct ResourceLookup : public RefCounted
+{
+    /// Resource lookup tables by type.
+    HashMap<StringHash, SharedPtr<ResourceLookupGroup> > groups_;
+};
+
 ResourceCache::ResourceCache(Context* context) :
     Object(context),
     autoReloadResources_(false),
     returnFailedResources_(false),
     searchPackagesFirst_(true),
+    memoryMapPackages_(false),
+    stripHeadlessRenderData_(false),
+    releaseModelShadowData_(false),
     isRouting_(false),
-    finishBackgroundResourcesMs_(5)
+    finishBackgroundResourcesMs_(5),
+    reloadResourcesMs_(5),
+    recordingManifest_(false),
+    lookup_(nullptr),
+    lookupEpoch_(1),
+    drainedEpoch_(0)
 {
+    lookupReaders_[0].store(0);
+    lookupReaders_[1].store(0);
+
     // Register Resource library object factories
     RegisterResourceLibrary(context_);
 
+    auto* metrics = GetSubsystem<Metrics>();
+    if (metrics)
+    {
+        loadsMetric_ = metrics->GetCounter("ResourceCache", "loads_total", "Resources loaded.", "mode=\"sync\"");
+        backgroundLoadsMetric_ = metrics->GetCounter("ResourceCache", "loads_total", "Resources loaded.", "mode=\"background\"");
+        loadFailuresMetric_ = metrics->GetCounter("ResourceCache", "load_failures_total", "Resources that failed to load.");
+        memoryUseMetric_ = metrics->GetGauge("ResourceCache", "memory_use_bytes", "Memory used by the cached resources.");
+    }
+
 #ifdef URHO3D_THREADING
     // Create resource background loader. Its thread will start on the first background request
     backgroundLoader_ = new BackgroundLoader(this);
@@ -93,6 +132,8 @@ ResourceCache::~ResourceCache()
     // Shut down the background loader first
     backgroundLoader_.Reset();
 #endif
+
+    lookup_.store(nullptr);
 }
 
 bool ResourceCache::AddResourceDir(const String& pathName, unsigned priority)
@@ -144,6 +185,9 @@ bool ResourceCache::AddPackageFile(PackageFile* package, unsigned priority)
         return false;
     }
 
+    if (memoryMapPackages_)
+        package->SetMemoryMapped(true);
+
     if (priority < packages_.Size())
         packages_.Insert(priority, SharedPtr<PackageFile>(package));
     else
@@ -374,6 +418,11 @@ bool ResourceCache::ReloadResource(Resource* resource)
     if (!resource)
         return false;
 
+#ifdef URHO3D_THREADING
+    // Finish a pending background reload first so that it does not load concurrently with this one
+    backgroundLoader_->WaitForResource(resource->GetType(), resource->GetNameHash());
+#endif
+
     resource->SendEvent(E_RELOADSTARTED);
 
     bool success = false;
@@ -433,6 +482,72 @@ void ResourceCache::ReloadResourceWithDependencies(const String& fileName)
     }
 }
 
+void ResourceCache::QueueReloads(const Vector<String>& fileNames)
+{
+    // Reloading a resource may modify the dependency tracking structure. Therefore collect all the resources to reload first
+    HashSet<StringHash> visited;
+    Vector<SharedPtr<Resource> > reloads;
+    for (unsigned i = 0; i < fileNames.Size(); ++i)
+    {
+        StringHash fileNameHash(fileNames[i]);
+        if (!visited.Contains(fileNameHash))
+            CollectReloads(fileNameHash, visited, reloads);
+    }
+
+    // A resource still waiting from an earlier batch is moved to its place in the new order
+    for (unsigned i = 0; i < reloads.Size(); ++i)
+        pendingReloads_.Remove(reloads[i]);
+
+    // Reverse post order puts each resource before the resources depending on it
+    for (unsigned i = reloads.Size() - 1; i < reloads.Size(); --i)
+        pendingReloads_.Push(reloads[i]);
+}
+
+void ResourceCache::CollectReloads(StringHash nameHash, HashSet<StringHash>& visited, Vector<SharedPtr<Resource> >& dest)
+{
+    visited.Insert(nameHash);
+
+    const SharedPtr<Resource>& resource = FindResource(nameHash);
+    // Always perform dependency resource check for resource loaded from XML file as it could be used in inheritance
+    if (!resource || GetExtension(resource->GetName()) == ".xml")
+    {
+        // Check if this is a dependency resource, reload dependents
+        HashMap<StringHash, HashSet<StringHash> >::ConstIterator i = dependentResources_.Find(nameHash);
+        if (i != dependentResources_.End())
+        {
+            for (HashSet<StringHash>::ConstIterator j = i->second_.Begin(); j != i->second_.End(); ++j)
+            {
+                if (!visited.Contains(*j))
+                    CollectReloads(*j, visited, dest);
+            }
+        }
+    }
+
+    if (resource)
+        dest.Push(resource);
+}
+
+void ResourceCache::ProcessReloads()
+{
+    HiresTimer timer;
+    unsigned count = 0;
+    while (count < pendingReloads_.Size())
+    {
+        SharedPtr<Resource> resource = pendingReloads_[count++];
+        // Skip resources that have been released from the cache while waiting
+        if (FindResource(resource->GetType(), resource->GetNameHash()) == resource)
+        {
+            URHO3D_LOGDEBUG("Reloading changed resource " + resource->GetName());
+            ReloadResource(resource);
+        }
+
+        if (timer.GetUSec(false) >= reloadResourcesMs_ * 1000LL)
+            break;
+    }
+
+    pendingReloads_.Erase(0, count);
+}
+
 void ResourceCache::SetMemoryBudget(StringHash type, unsigned long long budget)
 {
     resourceGroups_[type].memoryBudget_ = budget;
@@ -458,6 +573,62 @@ void ResourceCache::SetAutoReloadResources(bool enable)
     }
 }
 
+void ResourceCache::SetMemoryMapPackages(bool enable)
+{
+    MutexLock lock(resourceMutex_);
+
+    memoryMapPackages_ = enable;
+    for (unsigned i = 0; i < packages_.Size(); ++i)
+        packages_[i]->SetMemoryMapped(enable);
+}
+
+void ResourceCache::SetCompiledResourceDir(const String& path)
+{
+    String trimmedPath = path.Trimmed();
+    compiledResourceDir_ = trimmedPath.Length() ? AddTrailingSlash(trimmedPath) : String::EMPTY;
+}
+
+SharedPtr<File> ResourceCache::GetCompiledFile(Deserializer& source) const
+{
+    String sourceFileName, compiledFileName;
+    if (!GetCompiledFileNames(source, sourceFileName, compiledFileName))
+        return SharedPtr<File>();
+
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    if (!fileSystem->FileExists(compiledFileName))
+        return SharedPtr<File>();
+
+    // The compiled form is valid only for the exact source file it was made from
+    SharedPtr<File> file(new File(context_, compiledFileName));
+    if (!file->IsOpen() || file->ReadFileID() != "UCMP" || file->ReadUInt() != COMPILED_FILE_VERSION ||
+        file->ReadUInt() != fileSystem->GetLastModifiedTime(sourceFileName) || file->ReadUInt() != source.GetSize())
+        return SharedPtr<File>();
+
+    file->SetName(source.GetName());
+    return file;
+}
+
+bool ResourceCache::SaveCompiledFile(Deserializer& source, const void* data, unsigned size) const
+{
+    String sourceFileName, compiledFileName;
+    if (!GetCompiledFileNames(source, sourceFileName, compiledFileName))
+        return false;
+
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    if (!fileSystem->DirExists(compiledResourceDir_) && !fileSystem->CreateDir(compiledResourceDir_))
+        return false;
+
+    File file(context_);
+    if (!file.Open(compiledFileName, FILE_WRITE))
+        return false;
+
+    file.WriteFileID("UCMP");
+    file.WriteUInt(COMPILED_FILE_VERSION);
+    file.WriteUInt(fileSystem->GetLastModifiedTime(sourceFileName));
+    file.WriteUInt(source.GetSize());
+    return file.Write(data, size) == size;
+}
+
 void ResourceCache::AddResourceRouter(ResourceRouter* router, bool addAsFirst)
 {
     // Check for duplicate
@@ -543,6 +714,7 @@ Resource* ResourceCache::GetExistingResource(StringHash type, const String& name
 {
     String sanitatedName = SanitateResourceName(name);
 
+    // Reference counting is not thread-safe, so resource pointers are only handed out in the main thread
     if (!Thread::IsMainThread())
     {
         URHO3D_LOGERROR("Attempted to get resource " + sanitatedName + " from outside the main thread");
@@ -611,8 +783,14 @@ Resource* ResourceCache::GetResource(StringHash type, const String& name, bool s
     URHO3D_LOGDEBUG("Loading resource " + sanitatedName);
     resource->SetName(sanitatedName);
 
-    if (!resource->Load(*(file.Get())))
+    bool success = resource->Load(*(file.Get()));
+    if (loadsMetric_)
+        loadsMetric_->Increment();
+    if (!success)
     {
+        if (loadFailuresMetric_)
+            loadFailuresMetric_->Increment();
+
         // Error should already been logged by corresponding resource descendant class
         if (sendEventOnFailure)
         {
@@ -631,6 +809,8 @@ Resource* ResourceCache::GetResource(StringHash type, const String& name, bool s
     resource->ResetUseTimer();
     resourceGroups_[type].resources_[nameHash] = resource;
     UpdateResourceGroup(type);
+    if (success)
+        RecordManifestResource(resource);
 
     return resource;
 }
@@ -645,9 +825,12 @@ bool ResourceCache::BackgroundLoadResource(StringHash type, const String& name,
 
     // First check if already exists as a loaded resource
     StringHash nameHash(sanitatedName);
-    if (FindResource(type, nameHash) != noResource)
+    if (Thread::IsMainThread() ? FindResource(type, nameHash) != noResource : HasLookupResource(type, nameHash))
         return false;
 
+    if (caller)
+        RecordManifestDependency(caller->GetName(), sanitatedName);
+
     return backgroundLoader_->QueueResource(type, sanitatedName, sendEventOnFailure, caller);
 #else
     // When threading not supported, fall back to synchronous loading
@@ -655,6 +838,23 @@ bool ResourceCache::BackgroundLoadResource(StringHash type, const String& name,
 #endif
 }
 
+bool ResourceCache::BackgroundReloadResource(Resource* resource, int priority)
+{
+    if (!resource)
+        return false;
+
+#ifdef URHO3D_THREADING
+    if (!backgroundLoader_->QueueReload(resource, priority))
+        return false;
+
+    resource->SendEvent(E_RELOADSTARTED);
+    return true;
+#else
+    // When threading not supported, fall back to synchronous reloading
+    return ReloadResource(resource);
+#endif
+}
+
 SharedPtr<Resource> ResourceCache::GetTempResource(StringHash type, const String& name, bool sendEventOnFailure)
 {
     String sanitatedName = SanitateResourceName(name);
@@ -708,6 +908,154 @@ SharedPtr<Resource> ResourceCache::GetTempResource(StringHash type, const String
     return resource;
 }
 
+bool ResourceCache::SetBackgroundLoadPriority(StringHash type, const String& name, int priority)
+{
+#ifdef URHO3D_THREADING
+    return backgroundLoader_->SetPriority(type, StringHash(SanitateResourceName(name)), priority);
+#else
+    return false;
+#endif
+}
+
+void ResourceCache::SetNumBackgroundLoadThreads(unsigned num)
+{
+#ifdef URHO3D_THREADING
+    backgroundLoader_->SetNumThreads(num);
+#endif
+}
+
+void ResourceCache::SetBackgroundLoadThreadPriority(int priority)
+{
+#ifdef URHO3D_THREADING
+    backgroundLoader_->SetThreadPriority(priority);
+#endif
+}
+
+int ResourceCache::GetBackgroundLoadThreadPriority() const
+{
+#ifdef URHO3D_THREADING
+    return backgroundLoader_->GetThreadPriority();
+#else
+    return 0;
+#endif
+}
+
+unsigned ResourceCache::GetNumBackgroundLoadThreads() const
+{
+#ifdef URHO3D_THREADING
+    return backgroundLoader_->GetNumThreads();
+#else
+    return 0;
+#endif
+}
+
+void ResourceCache::BeginManifestRecording()
+{
+    MutexLock lock(resourceMutex_);
+
+    manifestResources_.Clear();
+    manifestResourceSet_.Clear();
+    manifestDependencies_.Clear();
+    manifestDependencySet_.Clear();
+    recordingManifest_ = true;
+}
+
+void ResourceCache::EndManifestRecording()
+{
+    MutexLock lock(resourceMutex_);
+
+    recordingManifest_ = false;
+}
+
+bool ResourceCache::SaveManifest(const String& fileName) const
+{
+    XMLFile xml(context_);
+    XMLElement rootElem = xml.CreateRoot("manifest");
+
+    {
+        MutexLock lock(resourceMutex_);
+
+        for (Vector<Pair<String, String> >::ConstIterator i = manifestResources_.Begin(); i != manifestResources_.End(); ++i)
+        {
+            XMLElement resourceElem = rootElem.CreateChild("resource");
+            resourceElem.SetAttribute("type", i->first_);
+            resourceElem.SetAttribute("name", i->second_);
+        }
+
+        for (Vector<Pair<String, String> >::ConstIterator i = manifestDependencies_.Begin(); i != manifestDependencies_.End(); ++i)
+        {
+            XMLElement dependencyElem = rootElem.CreateChild("dependency");
+            dependencyElem.SetAttribute("resource", i->first_);
+            dependencyElem.SetAttribute("name", i->second_);
+        }
+    }
+
+    File file(context_);
+    if (!file.Open(fileName, FILE_WRITE))
+    {
+        URHO3D_LOGERROR("Could not open preload manifest " + fileName + " for writing");
+        return false;
+    }
+
+    return xml.Save(file);
+}
+
+unsigned ResourceCache::PreloadManifest(const String& fileName)
+{
+    SharedPtr<File> file = GetFile(fileName);
+    if (!file)
+        return 0;   // Error is already logged
+
+    XMLFile xml(context_);
+    if (!xml.Load(*file))
+        return 0;
+
+    XMLElement rootElem = xml.GetRoot("manifest");
+    if (!rootElem)
+    {
+        URHO3D_LOGERROR("Preload manifest " + fileName + " has no manifest root element");
+        return 0;
+    }
+
+    Vector<Pair<StringHash, String> > resources;
+    for (XMLElement resourceElem = rootElem.GetChild("resource"); resourceElem; resourceElem = resourceElem.GetNext("resource"))
+        resources.Push(MakePair(StringHash(resourceElem.GetAttribute("type")), resourceElem.GetAttribute("name")));
+
+    // Queue in the recorded order, which has dependencies before the resources that need them
+    unsigned numQueued = 0;
+    HashMap<String, Pair<StringHash, int> > priorities;
+    for (unsigned i = 0; i < resources.Size(); ++i)
+    {
+        const Pair<StringHash, String>& resource = resources[i];
+        if (!BackgroundLoadResource(resource.first_, resource.second_, false))
+            continue;
+
+        // Resources that were needed earlier load first
+        int priority = (int)(resources.Size() - i);
+        SetBackgroundLoadPriority(resource.first_, resource.second_, priority);
+        priorities[resource.second_] = MakePair(resource.first_, priority);
+        ++numQueued;
+    }
+
+    // Make sure dependencies do not wait behind the resources that need them. Dependencies on files that are not
+    // preloaded resources, such as shader includes, are skipped
+    for (XMLElement dependencyElem = rootElem.GetChild("dependency"); dependencyElem;
+        dependencyElem = dependencyElem.GetNext("dependency"))
+    {
+        HashMap<String, Pair<StringHash, int> >::Iterator resource = priorities.Find(dependencyElem.GetAttribute("resource"));
+        HashMap<String, Pair<StringHash, int> >::Iterator dependency = priorities.Find(dependencyElem.GetAttribute("name"));
+        if (resource == priorities.End() || dependency == priorities.End() ||
+            dependency->second_.second_ >= resource->second_.second_)
+            continue;
+
+        dependency->second_.second_ = resource->second_.second_;
+        SetBackgroundLoadPriority(dependency->second_.first_, dependency->first_, dependency->second_.second_);
+    }
+
+    URHO3D_LOGDEBUG("Queued " + String(numQueued) + " resources from preload manifest " + fileName);
+    return numQueued;
+}
+
 unsigned ResourceCache::GetNumBackgroundLoadResources() const
 {
 #ifdef URHO3D_THREADING
@@ -891,6 +1239,9 @@ void ResourceCache::StoreResourceDependency(Resource* resource, const String& de
     StringHash nameHash(resource->GetName());
     HashSet<StringHash>& dependents = dependentResources_[dependency];
     dependents.Insert(nameHash);
+
+    if (recordingManifest_)
+        RecordManifestDependency(resource->GetName(), SanitateResourceName(dependency));
 }
 
 void ResourceCache::ResetDependencies(Resource* resource)
@@ -974,8 +1325,6 @@ String ResourceCache::PrintMemoryUsage() const
 
 const SharedPtr<Resource>& ResourceCache::FindResource(StringHash type, StringHash nameHash)
 {
-    MutexLock lock(resourceMutex_);
-
     HashMap<StringHash, ResourceGroup>::Iterator i = resourceGroups_.Find(type);
     if (i == resourceGroups_.End())
         return noResource;
@@ -988,8 +1337,6 @@ const SharedPtr<Resource>& ResourceCache::FindResource(StringHash type, StringHa
 
 const SharedPtr<Resource>& ResourceCache::FindResource(StringHash nameHash)
 {
-    MutexLock lock(resourceMutex_);
-
     for (HashMap<StringHash, ResourceGroup>::Iterator i = resourceGroups_.Begin(); i != resourceGroups_.End(); ++i)
     {
         HashMap<StringHash, SharedPtr<Resource> >::Iterator j = i->second_.resources_.Find(nameHash);
@@ -1068,27 +1415,64 @@ void ResourceCache::UpdateResourceGroup(StringHash type)
         else
             break;
     }
+
+    dirtyLookupGroups_.Insert(type);
+
+    // Publish removals immediately, so that other threads do not skip background loading a resource that was released.
+    // Additions are published once per frame
+    bool removed = false;
+    if (currentLookup_)
+    {
+        HashMap<StringHash, SharedPtr<ResourceLookupGroup> >::ConstIterator j = currentLookup_->groups_.Find(type);
+        if (j != currentLookup_->groups_.End())
+        {
+            for (HashSet<StringHash>::ConstIterator k = j->second_->names_.Begin(); k != j->second_->names_.End() && !removed; ++k)
+                removed = !i->second_.resources_.Contains(*k);
+        }
+    }
+    if (removed)
+        UpdateLookup();
 }
 
 void ResourceCache::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
 {
     for (unsigned i = 0; i < fileWatchers_.Size(); ++i)
     {
-        String fileName;
-        while (fileWatchers_[i]->GetNextChange(fileName))
+        // Take the changes of a directory as one batch once it has settled, so that the reloads can be ordered and spread
+        // over frames
+        Vector<String> fileNames;
+        if (!fileWatchers_[i]->GetChanges(fileNames))
+            continue;
+
+        QueueReloads(fileNames);
+
         {
-            ReloadResourceWithDependencies(fileName);
+            using namespace FilesChanged;
+
+            VariantMap& eventData = GetEventDataMap();
+            eventData[P_PATH] = fileWatchers_[i]->GetPath();
+            eventData[P_RESOURCENAMES] = fileNames;
+            SendEvent(E_FILESCHANGED, eventData);
+        }
 
-            // Finally send a general file changed event even if the file was not a tracked resource
+        // Finally send a general file changed event even if the file was not a tracked resource
+        for (unsigned j = 0; j < fileNames.Size(); ++j)
+        {
             using namespace FileChanged;
 
             VariantMap& eventData = GetEventDataMap();
-            eventData[P_FILENAME] = fileWatchers_[i]->GetPath() + fileName;
-            eventData[P_RESOURCENAME] = fileName;
+            eventData[P_FILENAME] = fileWatchers_[i]->GetPath() + fileNames[j];
+            eventData[P_RESOURCENAME] = fileNames[j];
             SendEvent(E_FILECHANGED, eventData);
         }
     }
 
+    if (!pendingReloads_.Empty())
+    {
+        URHO3D_PROFILE(ReloadResources);
+        ProcessReloads();
+    }
+
     // Check for background loaded resources that can be finished
 #ifdef URHO3D_THREADING
     {
@@ -1096,6 +1480,13 @@ void ResourceCache::HandleBeginFrame(StringHash eventType, VariantMap& eventData
         backgroundLoader_->FinishResources(finishBackgroundResourcesMs_);
     }
 #endif
+
+    // Publish the resources stored to the cache during the last frame for lookups outside the main thread
+    UpdateLookup();
+    FreeRetiredLookups();
+
+    if (memoryUseMetric_)
+        memoryUseMetric_->Set((double)GetTotalMemoryUse());
 }
 
 File* ResourceCache::SearchResourceDirs(const String& name)
@@ -1120,6 +1511,24 @@ File* ResourceCache::SearchResourceDirs(const String& name)
     return nullptr;
 }
 
+bool ResourceCache::GetCompiledFileNames(Deserializer& source, String& sourceFileName, String& compiledFileName) const
+{
+    // Only resources loaded from files in the resource directories are compiled. Packages can store the compiled forms
+    // in place of the text instead
+    auto* sourceFile = dynamic_cast<File*>(&source);
+    if (compiledResourceDir_.Empty() || !sourceFile || sourceFile->IsPackaged())
+        return false;
+
+    sourceFileName = GetResourceFileName(source.GetName());
+    if (sourceFileName.Empty())
+        return false;
+
+    // Include a hash of the full path, so that same-named resources in different directories do not collide
+    compiledFileName = compiledResourceDir_ + GetFileNameAndExtension(sourceFileName) + "_" +
+        StringHash(sourceFileName).ToString() + ".bin";
+    return true;
+}
+
 File* ResourceCache::SearchPackages(const String& name)
 {
     for (unsigned i = 0; i < packages_.Size(); ++i)
@@ -1131,6 +1540,117 @@ File* ResourceCache::SearchPackages(const String& name)
     return nullptr;
 }
 
+bool ResourceCache::HasLookupResource(StringHash type, StringHash nameHash) const
+{
+    bool found = false;
+
+    // Register as a reader of the current epoch, so that the main thread does not destroy a snapshot retired during it
+    // while it is being read
+    unsigned epoch = lookupEpoch_.load();
+    lookupReaders_[epoch & 1].fetch_add(1);
+    ResourceLookup* lookup = lookup_.load();
+    if (lookup)
+    {
+        HashMap<StringHash, SharedPtr<ResourceLookupGroup> >::ConstIterator i = lookup->groups_.Find(type);
+        if (i != lookup->groups_.End())
+            found = i->second_->names_.Contains(nameHash);
+    }
+    lookupReaders_[epoch & 1].fetch_sub(1);
+
+    return found;
+}
+
+void ResourceCache::UpdateLookup()
+{
+    if (dirtyLookupGroups_.Empty())
+        return;
+
+    // Copy the snapshot, sharing the tables of the unchanged types
+    SharedPtr<ResourceLookup> lookup(new ResourceLookup());
+    if (currentLookup_)
+        lookup->groups_ = currentLookup_->groups_;
+
+    for (HashSet<StringHash>::ConstIterator i = dirtyLookupGroups_.Begin(); i != dirtyLookupGroups_.End(); ++i)
+    {
+        HashMap<StringHash, ResourceGroup>::ConstIterator j = resourceGroups_.Find(*i);
+        if (j == resourceGroups_.End() || j->second_.resources_.Empty())
+        {
+            lookup->groups_.Erase(*i);
+            continue;
+        }
+
+        SharedPtr<ResourceLookupGroup> group(new ResourceLookupGroup());
+        for (HashMap<StringHash, SharedPtr<Resource> >::ConstIterator k = j->second_.resources_.Begin();
+             k != j->second_.resources_.End(); ++k)
+            group->names_.Insert(k->first_);
+        lookup->groups_[*i] = group;
+    }
+    dirtyLookupGroups_.Clear();
+
+    lookup_.store(lookup.Get());
+
+    // Other threads may still be reading the old snapshot, so retire it instead of destroying it now
+    if (currentLookup_)
+    {
+        RetiredLookup retired;
+        retired.epoch_ = lookupEpoch_.load();
+        retired.lookup_ = currentLookup_;
+        retiredLookups_.Push(retired);
+    }
+    currentLookup_ = lookup;
+}
+
+void ResourceCache::FreeRetiredLookups()
+{
+    // Readers register in the counter of the current epoch. Once the counter of the previous epoch has drained, no lookup
+    // started before the epoch was advanced is in progress, so the snapshots retired until then are no longer read.
+    // Lookups started after it register in the current epoch's counter, so a steady stream of them can not keep the
+    // previous epoch from draining
+    unsigned epoch = lookupEpoch_.load();
+    if (!lookupReaders_[(epoch + 1) & 1].load())
+    {
+        drainedEpoch_ = epoch;
+        lookupEpoch_.store(epoch + 1);
+    }
+
+    unsigned numFreed = 0;
+    while (numFreed < retiredLookups_.Size() && retiredLookups_[numFreed].epoch_ < drainedEpoch_)
+        ++numFreed;
+
+    if (numFreed)
+        retiredLookups_.Erase(0, numFreed);
+}
+
+void ResourceCache::RecordManifestResource(Resource* resource)
+{
+    if (!recordingManifest_ || !resource)
+        return;
+
+    MutexLock lock(resourceMutex_);
+
+    Pair<String, String> entry(resource->GetTypeName(), resource->GetName());
+    if (!manifestResourceSet_.Contains(entry))
+    {
+        manifestResourceSet_.Insert(entry);
+        manifestResources_.Push(entry);
+    }
+}
+
+void ResourceCache::RecordManifestDependency(const String& resourceName, const String& dependency)
+{
+    if (!recordingManifest_ || resourceName.Empty() || dependency.Empty())
+        return;
+
+    MutexLock lock(resourceMutex_);
+
+    Pair<String, String> entry(resourceName, dependency);
+    if (!manifestDependencySet_.Contains(entry))
+    {
+        manifestDependencySet_.Insert(entry);
+        manifestDependencies_.Push(entry);
+    }
+}
+
 void RegisterResourceLibrary(Context* context)
 {
     Image::RegisterObject(context);
@@ -30,12 +30,16 @@
 #include "../IO/File.h"
 #include "../Resource/Resource.h"
 
+#include <atomic>
+
 namespace Urho3D
 {
 
 class BackgroundLoader;
 class FileWatcher;
+class Metric;
 class PackageFile;
+struct ResourceLookup;
 
 /// Sets to priority so that a package or file is pushed to the end of the vector.
 static const unsigned PRIORITY_LAST = 0xffffffff;
@@ -58,6 +62,15 @@ struct ResourceGroup
     HashMap<StringHash, SharedPtr<Resource> > resources_;
 };
 
+/// Replaced lookup snapshot, kept alive while other threads may still read it.
+struct RetiredLookup
+{
+    /// Lookup epoch when retired.
+    unsigned epoch_;
+    /// Replaced lookup snapshot.
+    SharedPtr<ResourceLookup> lookup_;
+};
+
 /// Resource request types.
 enum ResourceRequest
 {
@@ -85,6 +98,8 @@ class URHO3D_API ResourceCache : public Object
 {
     URHO3D_OBJECT(ResourceCache, Object);
 
+    friend class BackgroundLoader;
+
 public:
     /// Construct.
     explicit ResourceCache(Context* context);
@@ -132,10 +147,31 @@ public:
     /// Define whether when getting resources should check package files or directories first. True for packages, false for directories.
     /// @property
     void SetSearchPackagesFirst(bool value) { searchPackagesFirst_ = value; }
+    /// Set whether to memory map the added package files, so that files opened from them read without file system calls. Applies also to the packages already added. Default false.
+    /// @property
+    void SetMemoryMapPackages(bool enable);
+    /// Set whether resources loaded without the Graphics subsystem drop their render data: models keep only vertex positions and indices, and techniques and shaders load empty. Textures, materials and fonts skip their data in headless mode regardless. Applies to resources loaded afterward. Default false, enabled by the engine in headless mode.
+    /// @property
+    void SetStripHeadlessRenderData(bool enable) { stripHeadlessRenderData_ = enable; }
+    /// Set whether models drop the CPU shadow copies of their vertex and index data after uploading them to the GPU. Consumers that need the data, such as physics, navigation, occlusion and triangle raycasts, reload it from the model file on demand. Can be overridden per model in the model's metadata XML file. Applies to models loaded afterward. Default false.
+    /// @property
+    void SetReleaseModelShadowData(bool enable) { releaseModelShadowData_ = enable; }
+    /// Set directory for the compiled binary forms of XML and JSON resources loaded from files, or empty to disable. Default empty. A compiled form is written when a resource is first parsed from text and reused while the source file's timestamp and size are unchanged.
+    /// @property
+    void SetCompiledResourceDir(const String& path);
 
     /// Set how many milliseconds maximum per frame to spend on finishing background loaded resources.
     /// @property
     void SetFinishBackgroundResourcesMs(int ms) { finishBackgroundResourcesMs_ = Max(ms, 1); }
+    /// Set how many milliseconds maximum per frame to spend on reloading automatically reloaded resources. At least one resource is reloaded per frame. Default 5.
+    /// @property
+    void SetReloadResourcesMs(int ms) { reloadResourcesMs_ = Max(ms, 1); }
+    /// Set number of threads loading background loaded resources in parallel. Default 1. Resources loaded in the background must be safe to begin loading concurrently.
+    /// @property
+    void SetNumBackgroundLoadThreads(unsigned num);
+    /// Set priority of the background loading threads from -2 (lowest) to 2 (highest), 0 being normal.
+    /// @property
+    void SetBackgroundLoadThreadPriority(int priority);
 
     /// Add a resource router object. By default there is none, so the routing process is skipped.
     void AddResourceRouter(ResourceRouter* router, bool addAsFirst = false);
@@ -150,12 +186,24 @@ public:
     SharedPtr<Resource> GetTempResource(StringHash type, const String& name, bool sendEventOnFailure = true);
     /// Background load a resource. An event will be sent when complete. Return true if successfully stored to the load queue, false if eg. already exists. Can be called from outside the main thread.
     bool BackgroundLoadResource(StringHash type, const String& name, bool sendEventOnFailure = true, Resource* caller = nullptr);
+    /// Reload a resource in the background. It stays usable with its old data until the reload finishes, upon which it sends the reload finished or failed event. Return true if queued or, without threading support, if reloaded synchronously. Can be called only from the main thread.
+    bool BackgroundReloadResource(Resource* resource, int priority = 0);
+    /// Set priority of a pending background-loaded resource, for example according to its distance to the camera. Higher priority resources and the resources they depend on are loaded and finished first. Priority can only be raised. Return true if the resource was pending.
+    bool SetBackgroundLoadPriority(StringHash type, const String& name, int priority);
+    /// Start recording a preload manifest of the resources stored to the cache and their dependencies, in the order they finish loading. Clears any previously recorded manifest.
+    void BeginManifestRecording();
+    /// Stop recording the preload manifest. The recorded data is kept until saved or recording is restarted.
+    void EndManifestRecording();
+    /// Save the recorded preload manifest to an XML file. Return true if successful.
+    bool SaveManifest(const String& fileName) const;
+    /// Queue the resources of a preload manifest for background loading, with the resources needed first and their dependencies prioritized. Return the number of resources queued.
+    unsigned PreloadManifest(const String& fileName);
     /// Return number of pending background-loaded resources.
     /// @property
     unsigned GetNumBackgroundLoadResources() const;
     /// Return all loaded resources of a specific type.
     void GetResources(PODVector<Resource*>& result, StringHash type) const;
-    /// Return an already loaded resource of specific type & name, or null if not found. Will not load if does not exist.
+    /// Return an already loaded resource of specific type & name, or null if not found. Will not load if does not exist. Can be called only from the main thread.
     Resource* GetExistingResource(StringHash type, const String& name);
 
     /// Return all loaded resources.
@@ -207,9 +255,48 @@ public:
     /// @property
     bool GetSearchPackagesFirst() const { return searchPackagesFirst_; }
 
+    /// Return whether package files are memory mapped.
+    /// @property
+    bool GetMemoryMapPackages() const { return memoryMapPackages_; }
+
+    /// Return whether resources loaded without the Graphics subsystem drop their render data.
+    /// @property
+    bool GetStripHeadlessRenderData() const { return stripHeadlessRenderData_; }
+
+    /// Return whether models drop the CPU shadow copies of their geometry data after uploading them to the GPU.
+    /// @property
+    bool GetReleaseModelShadowData() const { return releaseModelShadowData_; }
+
+    /// Return directory for the compiled binary forms of XML and JSON resources.
+    /// @property
+    const String& GetCompiledResourceDir() const { return compiledResourceDir_; }
+
+    /// Open the compiled form of a resource from the compiled resource directory, if it has been made from the same source file. Return null if not found or outdated. Can be called from any thread.
+    /// @nobind
+    SharedPtr<File> GetCompiledFile(Deserializer& source) const;
+    /// Save the compiled form of a resource loaded from a source file into the compiled resource directory. Return true if successful. Can be called from any thread.
+    /// @nobind
+    bool SaveCompiledFile(Deserializer& source, const void* data, unsigned size) const;
+
     /// Return how many milliseconds maximum to spend on finishing background loaded resources.
     /// @property
     int GetFinishBackgroundResourcesMs() const { return finishBackgroundResourcesMs_; }
+    /// Return how many milliseconds maximum per frame to spend on reloading automatically reloaded resources.
+    /// @property
+    int GetReloadResourcesMs() const { return reloadResourcesMs_; }
+    /// Return number of automatically reloaded resources waiting to be reloaded.
+    /// @property
+    unsigned GetNumPendingReloads() const { return pendingReloads_.Size(); }
+
+    /// Return number of threads loading background loaded resources.
+    /// @property
+    unsigned GetNumBackgroundLoadThreads() const;
+    /// Return priority of the background loading threads.
+    /// @property
+    int GetBackgroundLoadThreadPriority() const;
+
+    /// Return whether a preload manifest is being recorded.
+    bool IsRecordingManifest() const { return recordingManifest_; }
 
     /// Return a resource router by index.
     ResourceRouter* GetResourceRouter(unsigned index) const;
@@ -239,15 +326,47 @@ private:
     void UpdateResourceGroup(StringHash type);
     /// Handle begin frame event. Automatic resource reloads and the finalization of background loaded resources are processed here.
     void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+    /// Queue the resources of changed files and their dependents for reloading, with dependencies before the resources depending on them.
+    void QueueReloads(const Vector<String>& fileNames);
+    /// Collect a changed resource and its dependents in depth-first post order.
+    void CollectReloads(StringHash nameHash, HashSet<StringHash>& visited, Vector<SharedPtr<Resource> >& dest);
+    /// Reload queued resources within the time budget.
+    void ProcessReloads();
     /// Search FileSystem for file.
     File* SearchResourceDirs(const String& name);
     /// Search resource packages for file.
     File* SearchPackages(const String& name);
+    /// Return the source file name and the compiled file name for a resource source, or false if it can not be compiled.
+    bool GetCompiledFileNames(Deserializer& source, String& sourceFileName, String& compiledFileName) const;
+    /// Return whether a resource is loaded according to the lookup snapshot, without locking. Used outside the main thread.
+    bool HasLookupResource(StringHash type, StringHash nameHash) const;
+    /// Rebuild and publish the lookup snapshot for the changed resource types, and retire the old snapshot.
+    void UpdateLookup();
+    /// Destroy the retired snapshots that no other thread can read anymore. Called at the start of each frame.
+    void FreeRetiredLookups();
+    /// Record a resource stored to the cache into the preload manifest, if recording.
+    void RecordManifestResource(Resource* resource);
+    /// Record a dependency of a resource into the preload manifest, if recording.
+    void RecordManifestDependency(const String& resourceName, const String& dependency);
 
     /// Mutex for thread-safe access to the resource directories, resource packages and resource dependencies.
-    mutable Mutex resourceMutex_;
-    /// Resources by type.
+    mutable Mutex resourceMutex_{"ResourceCache"};
+    /// Resources by type. Only accessed from the main thread.
     HashMap<StringHash, ResourceGroup> resourceGroups_;
+    /// Published snapshot of the loaded resources for lookups outside the main thread.
+    std::atomic<ResourceLookup*> lookup_;
+    /// Owning pointer to the published lookup snapshot.
+    SharedPtr<ResourceLookup> currentLookup_;
+    /// Lookup epoch. Readers register in the counter of the current epoch's parity.
+    std::atomic<unsigned> lookupEpoch_;
+    /// Number of threads currently reading the lookup snapshot, by epoch parity.
+    mutable std::atomic<unsigned> lookupReaders_[2];
+    /// Retired snapshots with an epoch older than this are no longer read by lookups in progress.
+    unsigned drainedEpoch_;
+    /// Resource types whose lookup tables need to be rebuilt.
+    HashSet<StringHash> dirtyLookupGroups_;
+    /// Retired snapshots waiting to be destroyed, oldest first.
+    Vector<RetiredLookup> retiredLookups_;
     /// Resource load directories.
     Vector<String> resourceDirs_;
     /// File watchers for resource directories, if automatic reloading enabled.
@@ -266,10 +385,40 @@ private:
     bool returnFailedResources_;
     /// Search priority flag.
     bool searchPackagesFirst_;
+    /// Package memory mapping flag.
+    bool memoryMapPackages_;
+    /// Headless render data stripping flag.
+    bool stripHeadlessRenderData_;
+    /// Model shadow data release flag.
+    bool releaseModelShadowData_;
+    /// Directory for the compiled binary forms of XML and JSON resources.
+    String compiledResourceDir_;
     /// Resource routing flag to prevent endless recursion.
     mutable bool isRouting_;
     /// How many milliseconds maximum per frame to spend on finishing background loaded resources.
     int finishBackgroundResourcesMs_;
+    /// How many milliseconds maximum per frame to spend on reloading automatically reloaded resources.
+    int reloadResourcesMs_;
+    /// Automatically reloaded resources waiting to be reloaded, in reload order.
+    Vector<SharedPtr<Resource> > pendingReloads_;
+    /// Preload manifest recording flag.
+    bool recordingManifest_;
+    /// Recorded manifest resource type names and resource names, in load completion order.
+    Vector<Pair<String, String> > manifestResources_;
+    /// Recorded manifest resources for duplicate checking.
+    HashSet<Pair<String, String> > manifestResourceSet_;
+    /// Recorded manifest dependencies as dependent resource and dependency names.
+    Vector<Pair<String, String> > manifestDependencies_;
+    /// Recorded manifest dependencies for duplicate checking.
+    HashSet<Pair<String, String> > manifestDependencySet_;
+    /// Resources loaded in the calling thread metric.
+    SharedPtr<Metric> loadsMetric_;
+    /// Resources loaded in the background metric.
+    SharedPtr<Metric> backgroundLoadsMetric_;
+    /// Failed resource loads metric.
+    SharedPtr<Metric> loadFailuresMetric_;
+    /// Resource memory use metric.
+    SharedPtr<Metric> memoryUseMetric_;
 };
 
 template <class T> T* ResourceCache::GetExistingResource(const String& name)
@@ -49,6 +49,13 @@ URHO3D_EVENT(E_FILECHANGED, FileChanged)
     URHO3D_PARAM(P_RESOURCENAME, ResourceName);            // String
 }
 
+/// Batch of tracked files changed in a resource directory, sent once the directory has settled. Sent before the individual file changed events.
+URHO3D_EVENT(E_FILESCHANGED, FilesChanged)
+{
+    URHO3D_PARAM(P_PATH, Path);                            // String
+    URHO3D_PARAM(P_RESOURCENAMES, ResourceNames);          // StringVector
+}
+
 /// Resource loading failed.
 URHO3D_EVENT(E_LOADFAILED, LoadFailed)
 {
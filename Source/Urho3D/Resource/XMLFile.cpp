@@ -63,6 +63,97 @@ public:
     bool success_;
 };
 
+/// Write a null-terminated string to the compiled binary form.
+static void WriteBinaryString(Serializer& dest, const char* str)
+{
+    dest.Write(str, String::CStringLength(str) + 1);
+}
+
+/// Read a null-terminated string in place from the compiled binary form. The data must be null-terminated at the end.
+static const char* ReadBinaryString(const char*& pos, const char* end)
+{
+    const char* str = pos;
+    pos += String::CStringLength(str) + 1;
+    return pos <= end ? str : nullptr;
+}
+
+/// Read an unsigned integer from the compiled binary form.
+static bool ReadBinaryUInt(const char*& pos, const char* end, unsigned& value)
+{
+    if (pos + sizeof(unsigned) > end)
+        return false;
+    memcpy(&value, pos, sizeof(unsigned));
+    pos += sizeof(unsigned);
+    return true;
+}
+
+/// Write a node and its attributes and children to the compiled binary form.
+static void WriteBinaryNode(Serializer& dest, const pugi::xml_node& node)
+{
+    dest.WriteUByte((unsigned char)node.type());
+    WriteBinaryString(dest, node.name());
+    WriteBinaryString(dest, node.value());
+
+    unsigned numAttributes = 0;
+    for (pugi::xml_attribute attribute = node.first_attribute(); attribute; attribute = attribute.next_attribute())
+        ++numAttributes;
+    dest.WriteUInt(numAttributes);
+    for (pugi::xml_attribute attribute = node.first_attribute(); attribute; attribute = attribute.next_attribute())
+    {
+        WriteBinaryString(dest, attribute.name());
+        WriteBinaryString(dest, attribute.value());
+    }
+
+    unsigned numChildren = 0;
+    for (pugi::xml_node child = node.first_child(); child; child = child.next_sibling())
+        ++numChildren;
+    dest.WriteUInt(numChildren);
+    for (pugi::xml_node child = node.first_child(); child; child = child.next_sibling())
+        WriteBinaryNode(dest, child);
+}
+
+/// Read the name, value, attributes and children of a node from the compiled binary form.
+static bool ReadBinaryNode(const char*& pos, const char* end, pugi::xml_node node)
+{
+    const char* name = ReadBinaryString(pos, end);
+    const char* value = name ? ReadBinaryString(pos, end) : nullptr;
+    if (!value)
+        return false;
+    if (*name)
+        node.set_name(name);
+    if (*value)
+        node.set_value(value);
+
+    unsigned numAttributes;
+    if (!ReadBinaryUInt(pos, end, numAttributes))
+        return false;
+    for (unsigned i = 0; i < numAttributes; ++i)
+    {
+        const char* attributeName = ReadBinaryString(pos, end);
+        const char* attributeValue = attributeName ? ReadBinaryString(pos, end) : nullptr;
+        if (!attributeValue)
+            return false;
+        node.append_attribute(attributeName).set_value(attributeValue);
+    }
+
+    unsigned numChildren;
+    if (!ReadBinaryUInt(pos, end, numChildren))
+        return false;
+    for (unsigned i = 0; i < numChildren; ++i)
+    {
+        if (pos >= end)
+            return false;
+        auto type = (pugi::xml_node_type)*pos++;
+        if (type <= pugi::node_document || type > pugi::node_doctype)
+            return false;
+        pugi::xml_node child = node.append_child(type);
+        if (!child || !ReadBinaryNode(pos, end, child))
+            return false;
+    }
+
+    return true;
+}
+
 XMLFile::XMLFile(Context* context) :
     Resource(context),
     document_(new pugi::xml_document())
@@ -85,13 +176,8 @@ bool XMLFile::BeginLoad(Deserializer& source)
         return false;
     }
 
-    SharedArrayPtr<char> buffer(new char[dataSize]);
-    if (source.Read(buffer.Get(), dataSize) != dataSize)
-        return false;
-
-    if (!document_->load_buffer(buffer.Get(), dataSize))
+    if (!LoadDocument(source, dataSize))
     {
-        URHO3D_LOGERROR("Could not parse XML data from " + source.GetName());
         document_->reset();
         return false;
     }
@@ -102,6 +188,11 @@ bool XMLFile::BeginLoad(Deserializer& source)
     {
         // The existence of this attribute indicates this is an RFC 5261 patch file
         auto* cache = GetSubsystem<ResourceCache>();
+        if (!cache)
+        {
+            URHO3D_LOGERROR("Could not resolve inherited XML file {} without resource cache", inherit.CString());
+            return false;
+        }
         // If being async loaded, GetResource() is not safe, so use GetTempResource() instead
         XMLFile* inheritedXMLFile = GetAsyncLoadState() == ASYNC_DONE ? cache->GetResource<XMLFile>(inherit) :
             cache->GetTempResource<XMLFile>(inherit);
@@ -129,6 +220,81 @@ bool XMLFile::BeginLoad(Deserializer& source)
     return true;
 }
 
+bool XMLFile::LoadDocument(Deserializer& source, unsigned dataSize)
+{
+    // The compiled binary form may be stored in place of the text, for example by PackageTool
+    unsigned start = source.GetPosition();
+    if (dataSize >= 4)
+    {
+        if (source.ReadFileID() == "UXML")
+        {
+            if (LoadBinary(source))
+                return true;
+
+            URHO3D_LOGERROR("Could not load compiled XML data from " + source.GetName());
+            return false;
+        }
+        source.Seek(start);
+    }
+
+    // Use the compiled form from the compiled resource directory if it has been made from this source file
+    auto* cache = GetSubsystem<ResourceCache>();
+    SharedPtr<File> compiledFile = cache ? cache->GetCompiledFile(source) : SharedPtr<File>();
+    if (compiledFile)
+    {
+        if (compiledFile->ReadFileID() == "UXML" && LoadBinary(*compiledFile))
+            return true;
+        document_->reset();
+    }
+
+    SharedArrayPtr<char> buffer(new char[dataSize]);
+    if (source.Read(buffer.Get(), dataSize) != dataSize)
+        return false;
+
+    if (!document_->load_buffer(buffer.Get(), dataSize))
+    {
+        URHO3D_LOGERROR("Could not parse XML data from " + source.GetName());
+        return false;
+    }
+
+    // Store the compiled form for the next load
+    if (cache && !cache->GetCompiledResourceDir().Empty())
+    {
+        VectorBuffer compiledData;
+        if (SaveBinary(compiledData))
+            cache->SaveCompiledFile(source, compiledData.GetData(), compiledData.GetSize());
+    }
+
+    return true;
+}
+
+bool XMLFile::LoadBinary(Deserializer& source)
+{
+    unsigned dataSize = source.GetSize() - source.GetPosition();
+    SharedArrayPtr<char> buffer(new char[dataSize + 1]);
+    if (source.Read(buffer.Get(), dataSize) != dataSize)
+        return false;
+    // Terminate the data so that reading a truncated string stops at the end
+    buffer[dataSize] = '\0';
+
+    document_->reset();
+    const char* pos = buffer.Get();
+    const char* end = pos + dataSize;
+    if (pos >= end || *pos++ != pugi::node_document)
+        return false;
+
+    return ReadBinaryNode(pos, end, *document_);
+}
+
+bool XMLFile::SaveBinary(Serializer& dest) const
+{
+    if (!dest.WriteFileID("UXML"))
+        return false;
+
+    WriteBinaryNode(dest, *document_);
+    return true;
+}
+
 bool XMLFile::Save(Serializer& dest) const
 {
     return Save(dest, "\t");
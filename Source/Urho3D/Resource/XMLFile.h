@@ -57,6 +57,8 @@ public:
     bool Save(Serializer& dest) const override;
     /// Save resource with user-defined indentation. Return true if successful.
     bool Save(Serializer& dest, const String& indentation) const;
+    /// Save resource in the compiled binary form, which loads without parsing text. Return true if successful.
+    bool SaveBinary(Serializer& dest) const;
 
     /// Deserialize from a string. Return true if successful.
     bool FromString(const String& source);
@@ -80,6 +82,10 @@ public:
     void Patch(const XMLElement& patchElement);
 
 private:
+    /// Load the document from text or from the compiled binary form.
+    bool LoadDocument(Deserializer& source, unsigned dataSize);
+    /// Load the document from the compiled binary form. The file ID has already been read.
+    bool LoadBinary(Deserializer& source);
     /// Add an node in the Patch.
     void PatchAdd(const pugi::xml_node& patch, pugi::xpath_node& original) const;
     /// Replace a node or attribute in the Patch.
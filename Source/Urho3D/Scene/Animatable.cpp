@@ -29,6 +29,7 @@
 #include "../Resource/XMLElement.h"
 #include "../Scene/Animatable.h"
 #include "../Scene/ObjectAnimation.h"
+#include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
 #include "../Scene/ValueAnimation.h"
 
@@ -66,7 +67,11 @@ Animatable::Animatable(Context* context) :
 {
 }
 
-Animatable::~Animatable() = default;
+Animatable::~Animatable()
+{
+    if (attributeAnimationScene_)
+        attributeAnimationScene_->RemoveAnimatedObject(this);
+}
 
 void Animatable::RegisterObject(Context* context)
 {
@@ -449,6 +454,20 @@ float Animatable::GetAttributeAnimationTime(const String& name) const
     return info ? info->GetTime() : 0.0f;
 }
 
+void Animatable::SetAttributeAnimationScene(Scene* scene)
+{
+    if (attributeAnimationInfos_.Empty())
+        scene = nullptr;
+    if (scene == attributeAnimationScene_.Get())
+        return;
+
+    if (attributeAnimationScene_)
+        attributeAnimationScene_->RemoveAnimatedObject(this);
+    attributeAnimationScene_ = scene;
+    if (scene)
+        scene->AddAnimatedObject(this);
+}
+
 void Animatable::SetObjectAnimationAttr(const ResourceRef& value)
 {
     if (!value.name_.Empty())
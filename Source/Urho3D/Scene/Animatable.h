@@ -29,6 +29,7 @@
 namespace Urho3D
 {
 
+class Scene;
 class Animatable;
 class ValueAnimation;
 class AttributeAnimationInfo;
@@ -64,6 +65,8 @@ class URHO3D_API Animatable : public Serializable
 {
     URHO3D_OBJECT(Animatable, Serializable);
 
+    friend class Scene;
+
 public:
     /// Construct.
     explicit Animatable(Context* context);
@@ -121,6 +124,9 @@ public:
     /// Return attribute animation time position.
     float GetAttributeAnimationTime(const String& name) const;
 
+    /// Register with a scene for the batched attribute animation update while having attribute animations, or unregister when the scene is null. Called by Node, Component and Scene.
+    void SetAttributeAnimationScene(Scene* scene);
+
     /// Set object animation attribute.
     void SetObjectAnimationAttr(const ResourceRef& value);
     /// Return object animation attribute.
@@ -150,6 +156,8 @@ protected:
     /// Handle attribute animation removed.
     void HandleAttributeAnimationRemoved(StringHash eventType, VariantMap& eventData);
 
+    /// Scene registered with for the batched attribute animation update.
+    WeakPtr<Scene> attributeAnimationScene_;
     /// Animation enabled.
     bool animationEnabled_;
     /// Animation.
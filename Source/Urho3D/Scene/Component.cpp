@@ -56,6 +56,7 @@ Component::Component(Context* context) :
     node_(nullptr),
     id_(0),
     networkUpdate_(false),
+    saveUpdate_(false),
     enabled_(true)
 {
 }
@@ -107,6 +108,15 @@ void Component::MarkNetworkUpdate()
             networkUpdate_ = true;
         }
     }
+    if (!saveUpdate_)
+    {
+        Scene* scene = GetScene();
+        if (scene && scene->GetChangeTracking())
+        {
+            scene->MarkSaveUpdate(this);
+            saveUpdate_ = true;
+        }
+    }
 }
 
 void Component::GetDependencyNodes(PODVector<Node*>& dest)
@@ -225,14 +235,12 @@ void Component::CleanupConnection(Connection* connection)
 
 void Component::OnAttributeAnimationAdded()
 {
-    if (attributeAnimationInfos_.Size() == 1)
-        SubscribeToEvent(GetScene(), E_ATTRIBUTEANIMATIONUPDATE, URHO3D_HANDLER(Component, HandleAttributeAnimationUpdate));
+    SetAttributeAnimationScene(GetScene());
 }
 
 void Component::OnAttributeAnimationRemoved()
 {
-    if (attributeAnimationInfos_.Empty())
-        UnsubscribeFromEvent(GetScene(), E_ATTRIBUTEANIMATIONUPDATE);
+    SetAttributeAnimationScene(GetScene());
 }
 
 void Component::OnNodeSet(Node* node)
@@ -280,13 +288,6 @@ void Component::GetComponents(PODVector<Component*>& dest, StringHash type) cons
         dest.Clear();
 }
 
-void Component::HandleAttributeAnimationUpdate(StringHash eventType, VariantMap& eventData)
-{
-    using namespace AttributeAnimationUpdate;
-
-    UpdateAttributeAnimations(eventData[P_TIMESTEP].GetFloat());
-}
-
 Component* Component::GetFixedUpdateSource()
 {
     Component* ret = nullptr;
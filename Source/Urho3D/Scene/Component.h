@@ -114,6 +114,8 @@ public:
     void AddReplicationState(ComponentReplicationState* state);
     /// Prepare network update by comparing attributes and marking replication states dirty as necessary.
     void PrepareNetworkUpdate();
+    /// Clear the incremental save queued flag. Called by Scene.
+    void ResetSaveUpdate() { saveUpdate_ = false; }
     /// Clean up all references to a network connection that is about to be removed.
     /// @manualbind
     void CleanupConnection(Connection* connection);
@@ -136,8 +138,6 @@ protected:
     void SetID(unsigned id);
     /// Set scene node. Called by Node when creating the component.
     void SetNode(Node* node);
-    /// Handle scene attribute animation update event.
-    void HandleAttributeAnimationUpdate(StringHash eventType, VariantMap& eventData);
     /// Return a component from the scene root that sends out fixed update events (either PhysicsWorld or PhysicsWorld2D). Return null if neither exists.
     Component* GetFixedUpdateSource();
     /// Perform autoremove. Called by subclasses. Caller should keep a weak pointer to itself to check whether was actually removed, and return immediately without further member operations in that case.
@@ -149,6 +149,8 @@ protected:
     unsigned id_;
     /// Network update queued flag.
     bool networkUpdate_;
+    /// Incremental save queued flag.
+    bool saveUpdate_;
     /// Enabled flag.
     bool enabled_;
 };
@@ -22,6 +22,7 @@
 
 #include "../Precompiled.h"
 
+#include "../Graphics/SignificanceManager.h"
 #include "../IO/Log.h"
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
 #include "../Physics/PhysicsEvents.h"
@@ -37,11 +38,18 @@ LogicComponent::LogicComponent(Context* context) :
     Component(context),
     updateEventMask_(USE_UPDATE | USE_POSTUPDATE | USE_FIXEDUPDATE | USE_FIXEDPOSTUPDATE),
     currentEventMask_(0),
-    delayedStartCalled_(false)
+    updateAccumulator_(0.0f),
+    postUpdateAccumulator_(0.0f),
+    delayedStartCalled_(false),
+    significanceUpdate_(false)
 {
 }
 
-LogicComponent::~LogicComponent() = default;
+LogicComponent::~LogicComponent()
+{
+    if (parallelUpdateScene_)
+        parallelUpdateScene_->RemoveParallelUpdate(this);
+}
 
 void LogicComponent::OnSetEnabled()
 {
@@ -52,6 +60,10 @@ void LogicComponent::Update(float timeStep)
 {
 }
 
+void LogicComponent::ParallelUpdate(float timeStep)
+{
+}
+
 void LogicComponent::PostUpdate(float timeStep)
 {
 }
@@ -95,6 +107,11 @@ void LogicComponent::OnSceneSet(Scene* scene)
     {
         UnsubscribeFromEvent(E_SCENEUPDATE);
         UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+        if (parallelUpdateScene_)
+        {
+            parallelUpdateScene_->RemoveParallelUpdate(this);
+            parallelUpdateScene_.Reset();
+        }
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
         UnsubscribeFromEvent(E_PHYSICSPRESTEP);
         UnsubscribeFromEvent(E_PHYSICSPOSTSTEP);
@@ -103,6 +120,13 @@ void LogicComponent::OnSceneSet(Scene* scene)
     }
 }
 
+void LogicComponent::SetSignificanceUpdate(bool enable)
+{
+    significanceUpdate_ = enable;
+    updateAccumulator_ = 0.0f;
+    postUpdateAccumulator_ = 0.0f;
+}
+
 void LogicComponent::UpdateEventSubscription()
 {
     Scene* scene = GetScene();
@@ -114,7 +138,7 @@ void LogicComponent::UpdateEventSubscription()
     bool needUpdate = enabled && ((updateEventMask_ & USE_UPDATE) || !delayedStartCalled_);
     if (needUpdate && !(currentEventMask_ & USE_UPDATE))
     {
-        SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(LogicComponent, HandleSceneUpdate));
+        SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_TYPED_HANDLER(LogicComponent, HandleSceneUpdate));
         currentEventMask_ |= USE_UPDATE;
     }
     else if (!needUpdate && (currentEventMask_ & USE_UPDATE))
@@ -126,7 +150,7 @@ void LogicComponent::UpdateEventSubscription()
     bool needPostUpdate = enabled && (updateEventMask_ & USE_POSTUPDATE);
     if (needPostUpdate && !(currentEventMask_ & USE_POSTUPDATE))
     {
-        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(LogicComponent, HandleScenePostUpdate));
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_TYPED_HANDLER(LogicComponent, HandleScenePostUpdate));
         currentEventMask_ |= USE_POSTUPDATE;
     }
     else if (!needPostUpdate && (currentEventMask_ & USE_POSTUPDATE))
@@ -135,6 +159,22 @@ void LogicComponent::UpdateEventSubscription()
         currentEventMask_ &= ~USE_POSTUPDATE;
     }
 
+    // The parallel update is not an event; the scene keeps a list of the components that want it instead
+    bool needParallelUpdate = enabled && (updateEventMask_ & USE_PARALLELUPDATE);
+    if (needParallelUpdate && !(currentEventMask_ & USE_PARALLELUPDATE))
+    {
+        scene->AddParallelUpdate(this);
+        parallelUpdateScene_ = scene;
+        currentEventMask_ |= USE_PARALLELUPDATE;
+    }
+    else if (!needParallelUpdate && (currentEventMask_ & USE_PARALLELUPDATE))
+    {
+        if (parallelUpdateScene_)
+            parallelUpdateScene_->RemoveParallelUpdate(this);
+        parallelUpdateScene_.Reset();
+        currentEventMask_ &= ~USE_PARALLELUPDATE;
+    }
+
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
     Component* world = GetFixedUpdateSource();
     if (!world)
@@ -166,10 +206,8 @@ void LogicComponent::UpdateEventSubscription()
 #endif
 }
 
-void LogicComponent::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+void LogicComponent::HandleSceneUpdate(StringHash eventType, const SceneUpdateEventData& eventData)
 {
-    using namespace SceneUpdate;
-
     // Execute user-defined delayed start function before first update
     if (!delayedStartCalled_)
     {
@@ -185,16 +223,22 @@ void LogicComponent::HandleSceneUpdate(StringHash eventType, VariantMap& eventDa
         }
     }
 
-    // Then execute user-defined update function
-    Update(eventData[P_TIMESTEP].GetFloat());
+    // Then execute user-defined update function, possibly less often if the node is insignificant
+    float timeStep = eventData.timeStep_;
+    if (significanceUpdate_ && !SignificanceManager::CheckUpdate(this, timeStep, updateAccumulator_))
+        return;
+
+    Update(timeStep);
 }
 
-void LogicComponent::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+void LogicComponent::HandleScenePostUpdate(StringHash eventType, const SceneUpdateEventData& eventData)
 {
-    using namespace ScenePostUpdate;
-
     // Execute user-defined post-update function
-    PostUpdate(eventData[P_TIMESTEP].GetFloat());
+    float timeStep = eventData.timeStep_;
+    if (significanceUpdate_ && !SignificanceManager::CheckUpdate(this, timeStep, postUpdateAccumulator_))
+        return;
+
+    PostUpdate(timeStep);
 }
 
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
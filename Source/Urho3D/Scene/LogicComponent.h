@@ -26,6 +26,7 @@
 
 #include "../Container/FlagSet.h"
 #include "../Scene/Component.h"
+#include "../Scene/SceneEvents.h"
 
 namespace Urho3D
 {
@@ -42,6 +43,8 @@ enum UpdateEvent : unsigned
     USE_FIXEDUPDATE = 0x4,
     /// Bitmask for using the physics post-update event.
     USE_FIXEDPOSTUPDATE = 0x8,
+    /// Bitmask for using the parallel scene update phase, which runs in worker threads after the scene update event.
+    USE_PARALLELUPDATE = 0x10,
 };
 URHO3D_FLAGSET(UpdateEvent, UpdateEventFlags);
 
@@ -69,6 +72,8 @@ class URHO3D_API LogicComponent : public Component
 
     /// Called on scene update, variable timestep.
     virtual void Update(float timeStep);
+    /// Called in the parallel scene update phase from a worker thread, variable timestep. Only called when USE_PARALLELUPDATE is in the update event mask. Other components update at the same time, so only the component's own state and own scene node may be modified, and no nodes or components may be created or removed, or events sent. Components that need to react to node transform changes delay their processing until the phase ends.
+    virtual void ParallelUpdate(float timeStep);
     /// Called on scene post-update, variable timestep.
     virtual void PostUpdate(float timeStep);
     /// Called on physics update, fixed timestep.
@@ -76,12 +81,18 @@ class URHO3D_API LogicComponent : public Component
     /// Called on physics post-update, fixed timestep.
     virtual void FixedPostUpdate(float timeStep);
 
-    /// Set what update events should be subscribed to. Use this for optimization: by default all are in use. Note that this is not an attribute and is not saved or network-serialized, therefore it should always be called eg. in the subclass constructor.
+    /// Set what update events should be subscribed to. Use this for optimization: by default all except the parallel update are in use. Note that this is not an attribute and is not saved or network-serialized, therefore it should always be called eg. in the subclass constructor.
     void SetUpdateEventMask(UpdateEventFlags mask);
 
+    /// Set whether the update and post-update run less often when the node is insignificant to the viewer. Requires a SignificanceManager in the scene; the accumulated time step is passed to Update() and PostUpdate(). Like the update event mask, this is not an attribute.
+    void SetSignificanceUpdate(bool enable);
+
     /// Return what update events are subscribed to.
     UpdateEventFlags GetUpdateEventMask() const { return updateEventMask_; }
 
+    /// Return whether the update rate follows the node's significance.
+    bool GetSignificanceUpdate() const { return significanceUpdate_; }
+
     /// Return whether the DelayedStart() function has been called.
     bool IsDelayedStartCalled() const { return delayedStartCalled_; }
 
@@ -95,9 +106,9 @@ private:
     /// Subscribe/unsubscribe to update events based on current enabled state and update event mask.
     void UpdateEventSubscription();
     /// Handle scene update event.
-    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
+    void HandleSceneUpdate(StringHash eventType, const SceneUpdateEventData& eventData);
     /// Handle scene post-update event.
-    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    void HandleScenePostUpdate(StringHash eventType, const SceneUpdateEventData& eventData);
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
     /// Handle physics pre-step event.
     void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
@@ -108,8 +119,16 @@ private:
     UpdateEventFlags updateEventMask_;
     /// Current event subscription mask.
     UpdateEventFlags currentEventMask_;
+    /// Scene the component is registered to for the parallel update phase.
+    WeakPtr<Scene> parallelUpdateScene_;
+    /// Time accumulated between significance throttled updates.
+    float updateAccumulator_;
+    /// Time accumulated between significance throttled post-updates.
+    float postUpdateAccumulator_;
     /// Flag for delayed start.
     bool delayedStartCalled_;
+    /// Significance update flag.
+    bool significanceUpdate_;
 };
 
 }
@@ -45,6 +45,11 @@
 namespace Urho3D
 {
 
+/// Bits per quaternion component in the quantized network rotation.
+static const int DEFAULT_ROTATION_QUANTIZE_BITS = 16;
+
+URHO3D_IMPLEMENT_POOLED_OBJECT(Node)
+
 Node::Node(Context* context) :
     Animatable(context),
     worldTransform_(Matrix3x4::IDENTITY),
@@ -52,6 +57,7 @@ Node::Node(Context* context) :
     enabled_(true),
     enabledPrev_(true),
     networkUpdate_(false),
+    saveUpdate_(false),
     parent_(nullptr),
     scene_(nullptr),
     id_(0),
@@ -87,8 +93,8 @@ void Node::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Variables", VariantMap, vars_, Variant::emptyVariantMap, AM_FILE); // Network replication of vars uses custom data
     URHO3D_ACCESSOR_ATTRIBUTE("Network Position", GetNetPositionAttr, SetNetPositionAttr, Vector3, Vector3::ZERO,
         AM_NET | AM_LATESTDATA | AM_NOEDIT);
-    URHO3D_ACCESSOR_ATTRIBUTE("Network Rotation", GetNetRotationAttr, SetNetRotationAttr, PODVector<unsigned char>, Variant::emptyBuffer,
-        AM_NET | AM_LATESTDATA | AM_NOEDIT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Network Rotation", GetNetRotationAttr, SetNetRotationAttr, Quaternion, Quaternion::IDENTITY,
+        AM_NET | AM_LATESTDATA | AM_NOEDIT).SetMetadata(AttributeMetadata::P_QUANTIZE_BITS, DEFAULT_ROTATION_QUANTIZE_BITS);
     URHO3D_ACCESSOR_ATTRIBUTE("Network Parent Node", GetNetParentAttr, SetNetParentAttr, PODVector<unsigned char>, Variant::emptyBuffer,
         AM_NET | AM_NOEDIT);
 }
@@ -288,6 +294,12 @@ void Node::MarkNetworkUpdate()
         scene_->MarkNetworkUpdate(this);
         networkUpdate_ = true;
     }
+    // Local nodes are saved too, so the incremental save does not depend on replication
+    if (!saveUpdate_ && scene_ && scene_->GetChangeTracking())
+    {
+        scene_->MarkSaveUpdate(this);
+        saveUpdate_ = true;
+    }
 }
 
 void Node::AddReplicationState(NodeReplicationState* state)
@@ -834,6 +846,8 @@ void Node::AddChild(Node* node, unsigned index)
             }
 
             oldParent->children_.Remove(nodeShared);
+            if (scene_)
+                scene_->MarkTransformHierarchyDirty();
         }
     }
 
@@ -1462,14 +1476,13 @@ void Node::SetNetPositionAttr(const Vector3& value)
         SetPosition(value);
 }
 
-void Node::SetNetRotationAttr(const PODVector<unsigned char>& value)
+void Node::SetNetRotationAttr(const Quaternion& value)
 {
-    MemoryBuffer buf(value);
     auto* transform = GetComponent<SmoothedTransform>();
     if (transform)
-        transform->SetTargetRotation(buf.ReadPackedQuaternion());
+        transform->SetTargetRotation(value);
     else
-        SetRotation(buf.ReadPackedQuaternion());
+        SetRotation(value);
 }
 
 void Node::SetNetParentAttr(const PODVector<unsigned char>& value)
@@ -1514,11 +1527,9 @@ const Vector3& Node::GetNetPositionAttr() const
     return position_;
 }
 
-const PODVector<unsigned char>& Node::GetNetRotationAttr() const
+const Quaternion& Node::GetNetRotationAttr() const
 {
-    impl_->attrBuffer_.Clear();
-    impl_->attrBuffer_.WritePackedQuaternion(rotation_);
-    return impl_->attrBuffer_.GetBuffer();
+    return rotation_;
 }
 
 const PODVector<unsigned char>& Node::GetNetParentAttr() const
@@ -1558,10 +1569,15 @@ bool Node::Load(Deserializer& source, SceneResolver& resolver, bool loadChildren
     if (!Animatable::Load(source))
         return false;
 
+    // The component data is read in place if the source is held in memory. Otherwise it is copied to a storage buffer
+    // reused between the components
+    PODVector<unsigned char> compStorage;
     unsigned numComponents = source.ReadVLE();
     for (unsigned i = 0; i < numComponents; ++i)
     {
-        VectorBuffer compBuffer(source, source.ReadVLE());
+        unsigned compSize = source.ReadVLE();
+        const unsigned char* compData = source.ReadBlock(compSize, compStorage);
+        MemoryBuffer compBuffer(compData, compSize);
         StringHash compType = compBuffer.ReadStringHash();
         unsigned compID = compBuffer.ReadUInt();
 
@@ -1900,14 +1916,12 @@ void Node::SetTransformSilent(const Vector3& position, const Quaternion& rotatio
 
 void Node::OnAttributeAnimationAdded()
 {
-    if (attributeAnimationInfos_.Size() == 1)
-        SubscribeToEvent(GetScene(), E_ATTRIBUTEANIMATIONUPDATE, URHO3D_HANDLER(Node, HandleAttributeAnimationUpdate));
+    SetAttributeAnimationScene(GetScene());
 }
 
 void Node::OnAttributeAnimationRemoved()
 {
-    if (attributeAnimationInfos_.Empty())
-        UnsubscribeFromEvent(GetScene(), E_ATTRIBUTEANIMATIONUPDATE);
+    SetAttributeAnimationScene(GetScene());
 }
 
 Animatable* Node::FindAttributeAnimationTarget(const String& name, String& outName)
@@ -2258,11 +2272,4 @@ void Node::RemoveComponent(Vector<SharedPtr<Component> >::Iterator i)
     components_.Erase(i);
 }
 
-void Node::HandleAttributeAnimationUpdate(StringHash eventType, VariantMap& eventData)
-{
-    using namespace AttributeAnimationUpdate;
-
-    UpdateAttributeAnimations(eventData[P_TIMESTEP].GetFloat());
-}
-
 }
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "../Core/ObjectPool.h"
 #include "../IO/VectorBuffer.h"
 #include "../Math/Matrix3x4.h"
 #include "../Scene/Animatable.h"
@@ -75,6 +76,7 @@ struct URHO3D_API NodeImpl
 class URHO3D_API Node : public Animatable
 {
     URHO3D_OBJECT(Node, Animatable);
+    URHO3D_POOLED_OBJECT(Node);
 
     friend class Connection;
 
@@ -636,13 +638,13 @@ public:
     /// Set network position attribute.
     void SetNetPositionAttr(const Vector3& value);
     /// Set network rotation attribute.
-    void SetNetRotationAttr(const PODVector<unsigned char>& value);
+    void SetNetRotationAttr(const Quaternion& value);
     /// Set network parent attribute.
     void SetNetParentAttr(const PODVector<unsigned char>& value);
     /// Return network position attribute.
     const Vector3& GetNetPositionAttr() const;
     /// Return network rotation attribute.
-    const PODVector<unsigned char>& GetNetRotationAttr() const;
+    const Quaternion& GetNetRotationAttr() const;
     /// Return network parent attribute.
     const PODVector<unsigned char>& GetNetParentAttr() const;
     /// Load components and optionally load child nodes.
@@ -664,6 +666,8 @@ public:
     void CleanupConnection(Connection* connection);
     /// Mark node dirty in scene replication states.
     void MarkReplicationDirty();
+    /// Clear the incremental save queued flag. Called by Scene.
+    void ResetSaveUpdate() { saveUpdate_ = false; }
     /// Create a child node with specific ID.
     Node* CreateChild(unsigned id, CreateMode mode, bool temporary = false);
     /// Add a pre-created component. Using this function from application code is discouraged, as component operation without an owner node may not be well-defined in all cases. Prefer CreateComponent() instead.
@@ -714,8 +718,6 @@ private:
     Node* CloneRecursive(Node* parent, SceneResolver& resolver, CreateMode mode);
     /// Remove a component from this node with the specified iterator.
     void RemoveComponent(Vector<SharedPtr<Component> >::Iterator i);
-    /// Handle attribute animation update event.
-    void HandleAttributeAnimationUpdate(StringHash eventType, VariantMap& eventData);
 
     /// World-space transform matrix.
     mutable Matrix3x4 worldTransform_;
@@ -729,6 +731,8 @@ private:
 protected:
     /// Network update queued flag.
     bool networkUpdate_;
+    /// Incremental save queued flag.
+    bool saveUpdate_;
 
 private:
     /// Parent scene node.
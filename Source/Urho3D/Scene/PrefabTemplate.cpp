@@ -0,0 +1,401 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../Resource/JSONFile.h"
+#include "../Resource/XMLFile.h"
+#include "../Scene/Component.h"
+#include "../Scene/ObjectAnimation.h"
+#include "../Scene/PrefabTemplate.h"
+#include "../Scene/Scene.h"
+#include "../Scene/ValueAnimation.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+static const AttributeModeFlags ID_ATTRIBUTE_MODES = AM_NODEID | AM_COMPONENTID | AM_NODEIDVECTOR;
+
+PrefabTemplate::PrefabTemplate(Context* context) :
+    Resource(context)
+{
+}
+
+PrefabTemplate::~PrefabTemplate() = default;
+
+void PrefabTemplate::RegisterObject(Context* context)
+{
+    context->RegisterFactory<PrefabTemplate>();
+}
+
+bool PrefabTemplate::BeginLoad(Deserializer& source)
+{
+    nodes_.Clear();
+    components_.Clear();
+
+    // Only parse the data here. Compiling requires creating scene objects, which must happen in the main thread
+    String extension = GetExtension(source.GetName());
+    if (extension == ".xml")
+    {
+        loadXMLFile_ = new XMLFile(context_);
+        if (!loadXMLFile_->Load(source))
+        {
+            loadXMLFile_.Reset();
+            return false;
+        }
+    }
+    else if (extension == ".json")
+    {
+        loadJSONFile_ = new JSONFile(context_);
+        if (!loadJSONFile_->Load(source))
+        {
+            loadJSONFile_.Reset();
+            return false;
+        }
+    }
+    else
+        loadBuffer_.SetData(source, source.GetSize());
+
+    SetMemoryUse(source.GetSize());
+    return true;
+}
+
+bool PrefabTemplate::EndLoad()
+{
+    URHO3D_PROFILE(CompilePrefabTemplate);
+
+    // Load one instance into a temporary scene. This resolves the prefab with the same rules as Scene::Instantiate(),
+    // and also brings the referenced resources to the resource cache
+    SharedPtr<Scene> scene(new Scene(context_));
+    scene->SetUpdateEnabled(false);
+
+    Node* root = nullptr;
+    if (loadXMLFile_)
+        root = scene->InstantiateXML(loadXMLFile_->GetRoot(), Vector3::ZERO, Quaternion::IDENTITY);
+    else if (loadJSONFile_)
+        root = scene->InstantiateJSON(loadJSONFile_->GetRoot(), Vector3::ZERO, Quaternion::IDENTITY);
+    else if (loadBuffer_.GetSize())
+        root = scene->Instantiate(loadBuffer_, Vector3::ZERO, Quaternion::IDENTITY);
+
+    loadXMLFile_.Reset();
+    loadJSONFile_.Reset();
+    loadBuffer_.Clear();
+
+    if (!root)
+    {
+        URHO3D_LOGERROR("Failed to compile prefab template " + GetName());
+        return false;
+    }
+
+    Compile(root);
+    return true;
+}
+
+Node* PrefabTemplate::Instantiate(Node* parent, const Vector3& position, const Quaternion& rotation, CreateMode mode) const
+{
+    if (!parent || !parent->GetScene())
+    {
+        URHO3D_LOGERROR("Can not instantiate prefab template " + GetName() + " without a parent node in a scene");
+        return nullptr;
+    }
+    if (nodes_.Empty())
+    {
+        URHO3D_LOGERROR("Can not instantiate prefab template " + GetName() + " that has not been loaded");
+        return nullptr;
+    }
+
+    URHO3D_PROFILE(InstantiatePrefabTemplate);
+
+    PODVector<Node*> nodes(nodes_.Size());
+    PODVector<Component*> components(components_.Size());
+
+    // Create the hierarchy in the same order as Node::Load(): node attributes first, then components, then child nodes
+    for (unsigned i = 0; i < nodes_.Size(); ++i)
+    {
+        const PrefabObject& nodeInfo = nodes_[i];
+        Node* parentNode = i ? nodes[nodeInfo.parent_] : parent;
+        Node* node = parentNode->CreateChild(String::EMPTY, (mode == REPLICATED && nodeInfo.replicated_) ? REPLICATED : LOCAL);
+        ApplyAttributes(nodeInfo, node);
+        nodes[i] = node;
+
+        for (unsigned j = nodeInfo.firstComponent_; j < nodeInfo.firstComponent_ + nodeInfo.numComponents_; ++j)
+        {
+            const PrefabObject& componentInfo = components_[j];
+            Component* component = node->CreateComponent(componentInfo.type_,
+                (mode == REPLICATED && componentInfo.replicated_) ? REPLICATED : LOCAL);
+            if (component)
+                ApplyAttributes(componentInfo, component);
+            components[j] = component;
+        }
+    }
+
+    // Point the node and component ID attributes to the new objects
+    for (unsigned i = 0; i < components_.Size(); ++i)
+    {
+        const PrefabObject& componentInfo = components_[i];
+        Component* component = components[i];
+        if (!component || componentInfo.idAttributes_.Empty())
+            continue;
+
+        const Vector<AttributeInfo>& attributes = *component->GetAttributes();
+        for (unsigned j = 0; j < componentInfo.idAttributes_.Size(); ++j)
+        {
+            const PrefabAttribute& attr = componentInfo.idAttributes_[j];
+            const AttributeInfo& info = attributes[attr.index_];
+
+            if (info.mode_ & AM_NODEIDVECTOR)
+            {
+                const VariantVector& indices = attr.value_.GetVariantVector();
+                VariantVector ids;
+                if (indices.Size())
+                {
+                    // The first index stores the number of IDs
+                    ids.Push(indices[0]);
+                    for (unsigned k = 1; k < indices.Size(); ++k)
+                    {
+                        unsigned index = indices[k].GetUInt();
+                        ids.Push(index ? nodes[index - 1]->GetID() : 0);
+                    }
+                }
+                component->OnSetAttribute(info, ids);
+            }
+            else
+            {
+                unsigned index = attr.value_.GetUInt();
+                unsigned id = 0;
+                if (index)
+                {
+                    if (info.mode_ & AM_NODEID)
+                        id = nodes[index - 1]->GetID();
+                    else if (components[index - 1])
+                        id = components[index - 1]->GetID();
+                }
+                component->OnSetAttribute(info, id);
+            }
+        }
+    }
+
+    Node* root = nodes[0];
+    root->SetTransform(position, rotation);
+    root->ApplyAttributes();
+    return root;
+}
+
+void PrefabTemplate::Compile(Node* root)
+{
+    HashMap<unsigned, unsigned> nodeIndices;
+    HashMap<unsigned, unsigned> componentIndices;
+
+    AddNode(root, M_MAX_UNSIGNED, nodeIndices, componentIndices);
+    ResolveIDAttributes(nodeIndices, componentIndices);
+
+    // The root node is created in the instantiation mode
+    nodes_[0].replicated_ = true;
+
+    unsigned memoryUse = sizeof(PrefabTemplate) + (nodes_.Size() + components_.Size()) * sizeof(PrefabObject);
+    for (unsigned i = 0; i < nodes_.Size(); ++i)
+        memoryUse += nodes_[i].attributes_.Size() * sizeof(PrefabAttribute);
+    for (unsigned i = 0; i < components_.Size(); ++i)
+        memoryUse += (components_[i].attributes_.Size() + components_[i].idAttributes_.Size()) * sizeof(PrefabAttribute);
+    SetMemoryUse(memoryUse);
+}
+
+void PrefabTemplate::AddNode(Node* node, unsigned parentIndex, HashMap<unsigned, unsigned>& nodeIndices,
+    HashMap<unsigned, unsigned>& componentIndices)
+{
+    unsigned nodeIndex = nodes_.Size();
+    nodeIndices[node->GetID()] = nodeIndex;
+
+    nodes_.Resize(nodeIndex + 1);
+    {
+        PrefabObject& nodeInfo = nodes_.Back();
+        nodeInfo.parent_ = parentIndex;
+        nodeInfo.firstComponent_ = components_.Size();
+        nodeInfo.numComponents_ = 0;
+        nodeInfo.replicated_ = Scene::IsReplicatedID(node->GetID());
+        AddAttributes(nodeInfo, node);
+    }
+
+    const Vector<SharedPtr<Component> >& components = node->GetComponents();
+    for (unsigned i = 0; i < components.Size(); ++i)
+    {
+        Component* component = components[i];
+        if (component->IsTemporary())
+            continue;
+
+        // Components of unknown type were loaded as UnknownComponent, which can not be created by type
+        if (!context_->GetObjectFactories().Contains(component->GetType()))
+        {
+            URHO3D_LOGWARNING("Skipping component of unknown type " + component->GetTypeName() + " in prefab template " +
+                GetName());
+            continue;
+        }
+
+        componentIndices[component->GetID()] = components_.Size();
+        components_.Resize(components_.Size() + 1);
+        PrefabObject& componentInfo = components_.Back();
+        componentInfo.type_ = component->GetType();
+        componentInfo.parent_ = nodeIndex;
+        componentInfo.firstComponent_ = 0;
+        componentInfo.numComponents_ = 0;
+        componentInfo.replicated_ = Scene::IsReplicatedID(component->GetID());
+        AddAttributes(componentInfo, component);
+        ++nodes_[nodeIndex].numComponents_;
+    }
+
+    const Vector<SharedPtr<Node> >& children = node->GetChildren();
+    for (unsigned i = 0; i < children.Size(); ++i)
+    {
+        if (!children[i]->IsTemporary())
+            AddNode(children[i], nodeIndex, nodeIndices, componentIndices);
+    }
+}
+
+void PrefabTemplate::AddAttributes(PrefabObject& object, Animatable* animatable)
+{
+    const Vector<AttributeInfo>* attributes = animatable->GetAttributes();
+    if (attributes)
+    {
+        for (unsigned i = 0; i < attributes->Size(); ++i)
+        {
+            const AttributeInfo& info = attributes->At(i);
+            if (!(info.mode_ & AM_FILE))
+                continue;
+
+            PrefabAttribute attr;
+            attr.index_ = i;
+            attr.value_ = animatable->GetAttribute(i);
+
+            if (info.mode_ & ID_ATTRIBUTE_MODES)
+            {
+                object.idAttributes_.Push(attr);
+                continue;
+            }
+
+            // A new object already has the default values, so they are skipped like when saving
+            if (attr.value_ == animatable->GetAttributeDefault(i) && !animatable->SaveDefaultAttributes())
+                continue;
+
+            object.attributes_.Push(attr);
+        }
+    }
+
+    // Animations loaded from a resource file are restored by the object animation attribute. Record inline animations
+    ObjectAnimation* objectAnimation = animatable->GetObjectAnimation();
+    if (objectAnimation)
+    {
+        if (objectAnimation->GetName().Empty())
+            object.objectAnimation_ = objectAnimation;
+    }
+    else if (attributes)
+    {
+        for (unsigned i = 0; i < attributes->Size(); ++i)
+        {
+            const String& name = attributes->At(i).name_;
+            ValueAnimation* animation = animatable->GetAttributeAnimation(name);
+            if (!animation)
+                continue;
+
+            PrefabAttributeAnimation attrAnimation;
+            attrAnimation.name_ = name;
+            attrAnimation.animation_ = animation;
+            attrAnimation.wrapMode_ = animatable->GetAttributeAnimationWrapMode(name);
+            attrAnimation.speed_ = animatable->GetAttributeAnimationSpeed(name);
+            object.attributeAnimations_.Push(attrAnimation);
+        }
+    }
+}
+
+void PrefabTemplate::ResolveIDAttributes(const HashMap<unsigned, unsigned>& nodeIndices,
+    const HashMap<unsigned, unsigned>& componentIndices)
+{
+    // Nodes do not have node or component ID attributes, so only have to go through components. References to objects
+    // outside the prefab can not be resolved and are stored as zero
+    for (unsigned i = 0; i < components_.Size(); ++i)
+    {
+        PrefabObject& componentInfo = components_[i];
+        if (componentInfo.idAttributes_.Empty())
+            continue;
+
+        const Vector<AttributeInfo>& attributes = *context_->GetAttributes(componentInfo.type_);
+        for (unsigned j = 0; j < componentInfo.idAttributes_.Size(); ++j)
+        {
+            PrefabAttribute& attr = componentInfo.idAttributes_[j];
+            const AttributeInfo& info = attributes[attr.index_];
+
+            if (info.mode_ & AM_NODEIDVECTOR)
+            {
+                const VariantVector& ids = attr.value_.GetVariantVector();
+                VariantVector indices;
+                if (ids.Size())
+                {
+                    indices.Push(ids[0]);
+                    for (unsigned k = 1; k < ids.Size(); ++k)
+                    {
+                        HashMap<unsigned, unsigned>::ConstIterator l = nodeIndices.Find(ids[k].GetUInt());
+                        indices.Push(l != nodeIndices.End() ? l->second_ + 1 : 0);
+                    }
+                }
+                attr.value_ = indices;
+            }
+            else
+            {
+                const HashMap<unsigned, unsigned>& objectIndices = (info.mode_ & AM_NODEID) ? nodeIndices : componentIndices;
+                HashMap<unsigned, unsigned>::ConstIterator k = objectIndices.Find(attr.value_.GetUInt());
+                attr.value_ = k != objectIndices.End() ? k->second_ + 1 : 0;
+            }
+        }
+    }
+}
+
+void PrefabTemplate::ApplyAttributes(const PrefabObject& object, Animatable* animatable) const
+{
+    const Vector<AttributeInfo>* attributes = animatable->GetAttributes();
+    if (attributes)
+    {
+        for (unsigned i = 0; i < object.attributes_.Size(); ++i)
+        {
+            const PrefabAttribute& attr = object.attributes_[i];
+            animatable->OnSetAttribute(attributes->At(attr.index_), attr.value_);
+        }
+    }
+
+    if (object.objectAnimation_ || object.attributeAnimations_.Size())
+    {
+        if (object.objectAnimation_)
+            animatable->SetObjectAnimation(object.objectAnimation_);
+        for (unsigned i = 0; i < object.attributeAnimations_.Size(); ++i)
+        {
+            const PrefabAttributeAnimation& attrAnimation = object.attributeAnimations_[i];
+            animatable->SetAttributeAnimation(attrAnimation.name_, attrAnimation.animation_, attrAnimation.wrapMode_,
+                attrAnimation.speed_);
+        }
+    }
+}
+
+}
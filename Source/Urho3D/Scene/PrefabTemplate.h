@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../IO/VectorBuffer.h"
+#include "../Resource/Resource.h"
+#include "../Scene/AnimationDefs.h"
+#include "../Scene/Node.h"
+
+namespace Urho3D
+{
+
+class JSONFile;
+class ObjectAnimation;
+class ValueAnimation;
+class XMLFile;
+
+/// Attribute value of a prefab template object.
+struct PrefabAttribute
+{
+    /// Attribute index within the object type's attributes.
+    unsigned index_;
+    /// Value. For node and component ID attributes, holds template node or component indices plus one instead of IDs.
+    Variant value_;
+};
+
+/// Attribute animation of a prefab template object.
+struct PrefabAttributeAnimation
+{
+    /// Attribute name.
+    String name_;
+    /// Animation.
+    SharedPtr<ValueAnimation> animation_;
+    /// Wrap mode.
+    WrapMode wrapMode_;
+    /// Speed.
+    float speed_;
+};
+
+/// Node or component of a prefab template.
+struct PrefabObject
+{
+    /// Component type. Unused for nodes.
+    StringHash type_;
+    /// Index of the parent node for nodes, or of the owner node for components. M_MAX_UNSIGNED for the root node.
+    unsigned parent_;
+    /// Index of the first component for nodes.
+    unsigned firstComponent_;
+    /// Number of components for nodes.
+    unsigned numComponents_;
+    /// Whether is created as replicated when instantiating in replicated mode.
+    bool replicated_;
+    /// Attribute values that differ from the defaults.
+    Vector<PrefabAttribute> attributes_;
+    /// Node and component ID attributes, applied after the whole hierarchy has been created.
+    Vector<PrefabAttribute> idAttributes_;
+    /// Inline object animation.
+    SharedPtr<ObjectAnimation> objectAnimation_;
+    /// Attribute animations.
+    Vector<PrefabAttributeAnimation> attributeAnimations_;
+};
+
+/// Object prefab resource compiled into a flat list of nodes and components with pre-resolved attribute values, for fast repeated instantiation.
+class URHO3D_API PrefabTemplate : public Resource
+{
+    URHO3D_OBJECT(PrefabTemplate, Resource);
+
+public:
+    /// Construct.
+    explicit PrefabTemplate(Context* context);
+    /// Destruct.
+    ~PrefabTemplate() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Load resource from stream. May be called from a worker thread. Return true if successful.
+    bool BeginLoad(Deserializer& source) override;
+    /// Finish resource loading. Always called from the main thread. Return true if successful.
+    bool EndLoad() override;
+
+    /// Instantiate as a child of a node, which must belong to a scene. Return the root node if successful.
+    Node* Instantiate(Node* parent, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED) const;
+
+    /// Return number of nodes.
+    /// @property
+    unsigned GetNumNodes() const { return nodes_.Size(); }
+    /// Return number of components.
+    /// @property
+    unsigned GetNumComponents() const { return components_.Size(); }
+
+private:
+    /// Compile from the hierarchy of an instance loaded into a temporary scene.
+    void Compile(Node* root);
+    /// Add a node with its components and child nodes.
+    void AddNode(Node* node, unsigned parentIndex, HashMap<unsigned, unsigned>& nodeIndices, HashMap<unsigned, unsigned>& componentIndices);
+    /// Record the attributes and animations of a node or component.
+    void AddAttributes(PrefabObject& object, Animatable* animatable);
+    /// Convert the node and component ID attributes from IDs of the temporary instance to template indices.
+    void ResolveIDAttributes(const HashMap<unsigned, unsigned>& nodeIndices, const HashMap<unsigned, unsigned>& componentIndices);
+    /// Apply recorded attributes and animations to a new node or component.
+    void ApplyAttributes(const PrefabObject& object, Animatable* animatable) const;
+
+    /// Nodes in depth-first order, parents before their children.
+    Vector<PrefabObject> nodes_;
+    /// Components, in the order of their owner nodes.
+    Vector<PrefabObject> components_;
+    /// XML file used while loading.
+    SharedPtr<XMLFile> loadXMLFile_;
+    /// JSON file used while loading.
+    SharedPtr<JSONFile> loadJSONFile_;
+    /// Binary data used while loading.
+    VectorBuffer loadBuffer_;
+};
+
+}
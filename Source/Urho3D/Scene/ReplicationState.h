@@ -34,6 +34,8 @@ namespace Urho3D
 {
 
 static const unsigned MAX_NETWORK_ATTRIBUTES = 64;
+/// Number of quantized node latest data updates kept by the server as the baselines of the following updates.
+static const unsigned LATESTDATA_HISTORY = 32;
 
 class Component;
 class Connection;
@@ -167,8 +169,16 @@ struct URHO3D_API NodeReplicationState : public ReplicationState
     HashMap<unsigned, ComponentReplicationState> componentStates_;
     /// Interest management priority accumulator.
     float priorityAcc_{};
+    /// Number of consecutive server updates in which the node update was deferred by the bandwidth budget.
+    unsigned deferredUpdates_{};
     /// Whether exists in the SceneState's dirty set.
     bool markedDirty_{};
+    /// Quantized latest data values sent, indexed by the sequence number modulo LATESTDATA_HISTORY.
+    Vector<PODVector<unsigned> > latestDataHistory_;
+    /// Sequence number of the next quantized latest data update.
+    unsigned char latestDataSequence_{};
+    /// Sequence number of the newest quantized latest data update acknowledged by the client, or -1 if none.
+    int ackedLatestData_{-1};
 };
 
 /// Per-user scene network replication state.
@@ -28,16 +28,20 @@
 #include "../Core/WorkQueue.h"
 #include "../IO/File.h"
 #include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
 #include "../IO/PackageFile.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 #include "../Resource/XMLFile.h"
 #include "../Resource/JSONFile.h"
 #include "../Scene/Component.h"
+#include "../Scene/LogicComponent.h"
 #include "../Scene/ObjectAnimation.h"
+#include "../Scene/PrefabTemplate.h"
 #include "../Scene/ReplicationState.h"
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
+#include "../Scene/SceneStreamer.h"
 #include "../Scene/SmoothedTransform.h"
 #include "../Scene/SplinePath.h"
 #include "../Scene/UnknownComponent.h"
@@ -54,6 +58,76 @@ const char* SUBSYSTEM_CATEGORY = "Subsystem";
 
 static const float DEFAULT_SMOOTHING_CONSTANT = 50.0f;
 static const float DEFAULT_SNAP_THRESHOLD = 5.0f;
+static const float DEFAULT_MAX_EXTRAPOLATION = 0.25f;
+/// Difference between the received and estimated server time, in seconds, beyond which the estimate is reset.
+static const float SNAPSHOT_CLOCK_RESYNC = 1.0f;
+/// Fraction of the lateness of a delayed network update by which the estimated server time is moved back.
+static const float SNAPSHOT_CLOCK_CORRECTION = 0.05f;
+
+/// Minimum number of nodes per work item in the threaded transform update.
+static const unsigned MIN_TRANSFORMS_PER_WORK_ITEM = 256;
+
+/// Remove an object from a batched update list. While the list is being updated the entry is only cleared, and the list is compacted after the update.
+template <class T> static void RemoveFromUpdateList(PODVector<T*>& list, T* object, unsigned updateIndex)
+{
+    if (updateIndex == M_MAX_UNSIGNED)
+    {
+        list.RemoveSwap(object);
+        return;
+    }
+
+    // Objects usually remove themselves while being updated, so check the current entry first
+    if (updateIndex < list.Size() && list[updateIndex] == object)
+        list[updateIndex] = nullptr;
+    else
+    {
+        typename PODVector<T*>::Iterator i = list.Find(object);
+        if (i != list.End())
+            *i = nullptr;
+    }
+}
+
+/// Remove the entries cleared during a batched update.
+template <class T> static void CompactUpdateList(PODVector<T*>& list)
+{
+    unsigned dest = 0;
+    for (unsigned i = 0; i < list.Size(); ++i)
+    {
+        if (list[i])
+            list[dest++] = list[i];
+    }
+    list.Resize(dest);
+}
+
+/// Run the parallel update of a range of logic components.
+static void ParallelUpdateWork(const WorkItem* item, unsigned threadIndex)
+{
+    float timeStep = *(reinterpret_cast<float*>(item->aux_));
+    auto** start = reinterpret_cast<LogicComponent**>(item->start_);
+    auto** end = reinterpret_cast<LogicComponent**>(item->end_);
+
+    while (start != end)
+    {
+        LogicComponent* component = *start;
+        // Components that have not run their delayed start on the main thread yet wait for the next frame
+        if (component->IsDelayedStartCalled())
+            component->ParallelUpdate(timeStep);
+        ++start;
+    }
+}
+
+/// Update the world transforms of a range of nodes whose parents are already up to date.
+static void UpdateWorldTransformsWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto** start = reinterpret_cast<Node**>(item->start_);
+    auto** end = reinterpret_cast<Node**>(item->end_);
+
+    while (start != end)
+    {
+        (*start)->GetWorldTransform();
+        ++start;
+    }
+}
 
 Scene::Scene(Context* context) :
     Node(context),
@@ -63,13 +137,27 @@ Scene::Scene(Context* context) :
     localComponentID_(FIRST_LOCAL_ID),
     checksum_(0),
     asyncLoadingMs_(5),
+    instantiateQueueMs_(5),
+    instantiateQueueHead_(0),
     timeScale_(1.0f),
     elapsedTime_(0),
     smoothingConstant_(DEFAULT_SMOOTHING_CONSTANT),
     snapThreshold_(DEFAULT_SNAP_THRESHOLD),
+    interestCellSize_(0.0f),
+    interpolationDelay_(0.0f),
+    maxExtrapolation_(DEFAULT_MAX_EXTRAPOLATION),
+    snapshotTime_(0.0f),
+    snapshotInterval_(0.0f),
+    snapshotClock_(0.0f),
+    snapshotClockValid_(false),
     updateEnabled_(true),
     asyncLoading_(false),
-    threadedUpdate_(false)
+    threadedTransformUpdate_(false),
+    transformLevelsDirty_(true),
+    animatedObjectIndex_(M_MAX_UNSIGNED),
+    smoothedTransformIndex_(M_MAX_UNSIGNED),
+    threadedUpdate_(false),
+    changeTracking_(false)
 {
     // Assign an ID to self so that nodes can refer to this node as a parent
     SetID(GetFreeNodeID(REPLICATED));
@@ -87,9 +175,9 @@ Scene::~Scene()
     RemoveAllChildren();
 
     // Remove scene reference and owner from all nodes that still exist
-    for (HashMap<unsigned, Node*>::Iterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
+    for (FlatHashMap<unsigned, Node*>::Iterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
         i->second_->ResetScene();
-    for (HashMap<unsigned, Node*>::Iterator i = localNodes_.Begin(); i != localNodes_.End(); ++i)
+    for (FlatHashMap<unsigned, Node*>::Iterator i = localNodes_.Begin(); i != localNodes_.End(); ++i)
         i->second_->ResetScene();
 }
 
@@ -102,7 +190,10 @@ void Scene::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Smoothing Constant", GetSmoothingConstant, SetSmoothingConstant, float, DEFAULT_SMOOTHING_CONSTANT,
         AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Snap Threshold", GetSnapThreshold, SetSnapThreshold, float, DEFAULT_SNAP_THRESHOLD, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Interpolation Delay", GetInterpolationDelay, SetInterpolationDelay, float, 0.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Extrapolation", GetMaxExtrapolation, SetMaxExtrapolation, float, DEFAULT_MAX_EXTRAPOLATION, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Elapsed Time", GetElapsedTime, SetElapsedTime, float, 0.0f, AM_FILE);
+    URHO3D_ACCESSOR_ATTRIBUTE("Interest Cell Size", GetInterestCellSize, SetInterestCellSize, float, 0.0f, AM_FILE);
     URHO3D_ATTRIBUTE("Next Replicated Node ID", unsigned, replicatedNodeID_, FIRST_REPLICATED_ID, AM_FILE | AM_NOEDIT);
     URHO3D_ATTRIBUTE("Next Replicated Component ID", unsigned, replicatedComponentID_, FIRST_REPLICATED_ID, AM_FILE | AM_NOEDIT);
     URHO3D_ATTRIBUTE("Next Local Node ID", unsigned, localNodeID_, FIRST_LOCAL_ID, AM_FILE | AM_NOEDIT);
@@ -128,8 +219,28 @@ bool Scene::Load(Deserializer& source)
 
     Clear();
 
-    // Load the whole scene, then perform post-load if successfully loaded
-    if (Node::Load(source))
+    // Load the whole scene, then perform post-load if successfully loaded. If the source is a plain file that is not
+    // held in memory, map it so that strings and component data can be read in place without copying the file.
+    // Otherwise (e.g. a compressed package entry or a failed mapping) stream it
+    bool success;
+    auto* file = dynamic_cast<File*>(&source);
+    if (file && !file->GetReadPointer() && !file->IsPackaged() && file->GetSize() > file->GetPosition())
+    {
+        SharedPtr<PackageMapping> mapping(new PackageMapping(file->GetName(), file->GetSize()));
+        if (mapping->GetData() && mapping->GetSize() == file->GetSize())
+        {
+            MemoryBuffer buffer(mapping->GetData() + file->GetPosition(), file->GetSize() - file->GetPosition());
+            buffer.SetName(file->GetName());
+            success = Node::Load(buffer);
+            file->Seek(file->GetPosition() + buffer.GetPosition());
+        }
+        else
+            success = Node::Load(source);
+    }
+    else
+        success = Node::Load(source);
+
+    if (success)
     {
         FinishLoading(&source);
         return true;
@@ -203,6 +314,11 @@ void Scene::MarkNetworkUpdate()
         MarkNetworkUpdate(this);
         networkUpdate_ = true;
     }
+    if (changeTracking_ && !saveUpdate_)
+    {
+        MarkSaveUpdate(this);
+        saveUpdate_ = true;
+    }
 }
 
 void Scene::AddReplicationState(NodeReplicationState* state)
@@ -210,7 +326,7 @@ void Scene::AddReplicationState(NodeReplicationState* state)
     Node::AddReplicationState(state);
 
     // This is the first update for a new connection. Mark all replicated nodes dirty
-    for (HashMap<unsigned, Node*>::ConstIterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
+    for (FlatHashMap<unsigned, Node*>::ConstIterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
         state->sceneState_->dirtyNodes_.Insert(i->first_);
 }
 
@@ -350,7 +466,7 @@ bool Scene::LoadAsync(File* file, LoadMode mode)
             URHO3D_PROFILE(FindResourcesToPreload);
 
             unsigned currentPos = file->GetPosition();
-            PreloadResources(file, isSceneFile);
+            asyncProgress_.totalResources_ += PreloadResources(*file, asyncProgress_.resources_, isSceneFile);
             file->Seek(currentPos);
         }
 
@@ -373,7 +489,7 @@ bool Scene::LoadAsync(File* file, LoadMode mode)
         URHO3D_PROFILE(FindResourcesToPreload);
 
         URHO3D_LOGINFO("Preloading resources from " + file->GetName());
-        PreloadResources(file, isSceneFile);
+        asyncProgress_.totalResources_ += PreloadResources(*file, asyncProgress_.resources_, isSceneFile);
     }
 
     return true;
@@ -525,6 +641,46 @@ void Scene::StopAsyncLoading()
     resolver_.Reset();
 }
 
+Node* Scene::Instantiate(PrefabTemplate* prefab, const Vector3& position, const Quaternion& rotation, CreateMode mode)
+{
+    if (!prefab)
+    {
+        URHO3D_LOGERROR("Null prefab template for instantiation");
+        return nullptr;
+    }
+
+    return prefab->Instantiate(this, position, rotation, mode);
+}
+
+void Scene::QueueInstantiate(PrefabTemplate* prefab, const Vector3& position, const Quaternion& rotation, CreateMode mode,
+    Node* parent)
+{
+    if (!prefab)
+    {
+        URHO3D_LOGERROR("Null prefab template for instantiation");
+        return;
+    }
+    if (parent && parent->GetScene() != this)
+    {
+        URHO3D_LOGERROR("Parent node for queued instantiation does not belong to this scene");
+        return;
+    }
+
+    QueuedInstantiation queued;
+    queued.prefab_ = prefab;
+    queued.parent_ = parent ? parent : this;
+    queued.position_ = position;
+    queued.rotation_ = rotation;
+    queued.mode_ = mode;
+    instantiateQueue_.Push(queued);
+}
+
+void Scene::ClearInstantiateQueue()
+{
+    instantiateQueue_.Clear();
+    instantiateQueueHead_ = 0;
+}
+
 Node* Scene::Instantiate(Deserializer& source, const Vector3& position, const Quaternion& rotation, CreateMode mode)
 {
     URHO3D_PROFILE(Instantiate);
@@ -615,6 +771,7 @@ Node* Scene::InstantiateJSON(Deserializer& source, const Vector3& position, cons
 void Scene::Clear(bool clearReplicated, bool clearLocal)
 {
     StopAsyncLoading();
+    ClearInstantiateQueue();
 
     RemoveChildren(clearReplicated, clearLocal, true);
     RemoveComponents(clearReplicated, clearLocal);
@@ -664,11 +821,92 @@ void Scene::SetSnapThreshold(float threshold)
     Node::MarkNetworkUpdate();
 }
 
+void Scene::SetInterpolationDelay(float delay)
+{
+    interpolationDelay_ = Max(delay, 0.0f);
+    Node::MarkNetworkUpdate();
+}
+
+void Scene::SetMaxExtrapolation(float time)
+{
+    maxExtrapolation_ = Max(time, 0.0f);
+    Node::MarkNetworkUpdate();
+}
+
+void Scene::SetSnapshotTime(float time, float interval)
+{
+    snapshotTime_ = time;
+    snapshotInterval_ = interval;
+
+    // The estimate follows the earliest arriving updates, as those had the least latency. Late updates only move it back
+    // slowly, so that a single delayed packet does not stall the interpolation
+    if (!snapshotClockValid_ || Abs(time - snapshotClock_) > SNAPSHOT_CLOCK_RESYNC)
+    {
+        snapshotClock_ = time;
+        snapshotClockValid_ = true;
+    }
+    else if (time > snapshotClock_)
+        snapshotClock_ = time;
+    else
+        snapshotClock_ += (time - snapshotClock_) * SNAPSHOT_CLOCK_CORRECTION;
+}
+
+void Scene::SetInterestCellSize(float size)
+{
+    size = Max(size, 0.0f);
+    if (size == interestCellSize_)
+        return;
+
+    interestCellSize_ = size;
+    interestCells_.Clear();
+    interestNodeCells_.Clear();
+
+    // Sort the existing replicated nodes into the new grid. Afterward the grid is kept up to date on each network update
+    if (interestCellSize_ > 0.0f)
+    {
+        for (FlatHashMap<unsigned, Node*>::ConstIterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
+        {
+            Node* node = i->second_;
+            if (node == this)
+                continue;
+
+            IntVector3 cell = GetInterestCell(node->GetWorldPosition());
+            interestCells_[cell].Push(node);
+            interestNodeCells_[node->GetID()] = cell;
+        }
+    }
+}
+
+void Scene::SetThreadedTransformUpdate(bool enable)
+{
+    threadedTransformUpdate_ = enable;
+    // Release the node lists when disabled, they are rebuilt on demand
+    if (!enable)
+        transformLevels_.Clear();
+    transformLevelsDirty_ = true;
+}
+
+void Scene::SetChangeTracking(bool enable)
+{
+    if (enable == changeTracking_)
+        return;
+
+    // Discard the recorded changes and reset the queued flags, so that objects are recorded again when tracking is enabled
+    PODVector<unsigned> nodes, components, removedNodes, removedComponents;
+    TakeSaveChanges(nodes, components, removedNodes, removedComponents);
+    changeTracking_ = enable;
+}
+
 void Scene::SetAsyncLoadingMs(int ms)
 {
     asyncLoadingMs_ = Max(ms, 1);
 }
 
+void Scene::SetInstantiateQueueMs(int ms)
+{
+    instantiateQueueMs_ = Max(ms, 1);
+}
+
 void Scene::SetElapsedTime(float time)
 {
     elapsedTime_ = time;
@@ -707,12 +945,12 @@ Node* Scene::GetNode(unsigned id) const
 {
     if (IsReplicatedID(id))
     {
-        HashMap<unsigned, Node*>::ConstIterator i = replicatedNodes_.Find(id);
+        FlatHashMap<unsigned, Node*>::ConstIterator i = replicatedNodes_.Find(id);
         return i != replicatedNodes_.End() ? i->second_ : nullptr;
     }
     else
     {
-        HashMap<unsigned, Node*>::ConstIterator i = localNodes_.Find(id);
+        FlatHashMap<unsigned, Node*>::ConstIterator i = localNodes_.Find(id);
         return i != localNodes_.End() ? i->second_ : nullptr;
     }
 }
@@ -730,16 +968,69 @@ bool Scene::GetNodesWithTag(PODVector<Node*>& dest, const String& tag) const
         return false;
 }
 
+bool Scene::GetInterestNodes(PODVector<Node*>& dest, const Vector3& center, float radius) const
+{
+    dest.Clear();
+    if (interestCellSize_ <= 0.0f)
+        return false;
+
+    IntVector3 minCell = GetInterestCell(center - Vector3(radius, radius, radius));
+    IntVector3 maxCell = GetInterestCell(center + Vector3(radius, radius, radius));
+    float radiusSquared = radius * radius;
+
+    // When the radius covers more cells than are occupied, go through the occupied cells instead
+    auto numCells = (unsigned long long)(maxCell.x_ - minCell.x_ + 1) * (maxCell.y_ - minCell.y_ + 1) * (maxCell.z_ - minCell.z_ + 1);
+    if (numCells > interestCells_.Size())
+    {
+        for (HashMap<IntVector3, PODVector<Node*> >::ConstIterator i = interestCells_.Begin(); i != interestCells_.End(); ++i)
+        {
+            const IntVector3& cell = i->first_;
+            if (cell.x_ < minCell.x_ || cell.y_ < minCell.y_ || cell.z_ < minCell.z_ || cell.x_ > maxCell.x_ ||
+                cell.y_ > maxCell.y_ || cell.z_ > maxCell.z_)
+                continue;
+
+            for (PODVector<Node*>::ConstIterator j = i->second_.Begin(); j != i->second_.End(); ++j)
+            {
+                if (((*j)->GetWorldPosition() - center).LengthSquared() <= radiusSquared)
+                    dest.Push(*j);
+            }
+        }
+    }
+    else
+    {
+        for (int z = minCell.z_; z <= maxCell.z_; ++z)
+        {
+            for (int y = minCell.y_; y <= maxCell.y_; ++y)
+            {
+                for (int x = minCell.x_; x <= maxCell.x_; ++x)
+                {
+                    HashMap<IntVector3, PODVector<Node*> >::ConstIterator i = interestCells_.Find(IntVector3(x, y, z));
+                    if (i == interestCells_.End())
+                        continue;
+
+                    for (PODVector<Node*>::ConstIterator j = i->second_.Begin(); j != i->second_.End(); ++j)
+                    {
+                        if (((*j)->GetWorldPosition() - center).LengthSquared() <= radiusSquared)
+                            dest.Push(*j);
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
 Component* Scene::GetComponent(unsigned id) const
 {
     if (IsReplicatedID(id))
     {
-        HashMap<unsigned, Component*>::ConstIterator i = replicatedComponents_.Find(id);
+        FlatHashMap<unsigned, Component*>::ConstIterator i = replicatedComponents_.Find(id);
         return i != replicatedComponents_.End() ? i->second_ : nullptr;
     }
     else
     {
-        HashMap<unsigned, Component*>::ConstIterator i = localComponents_.Find(id);
+        FlatHashMap<unsigned, Component*>::ConstIterator i = localComponents_.Find(id);
         return i != localComponents_.End() ? i->second_ : nullptr;
     }
 }
@@ -769,19 +1060,64 @@ void Scene::Update(float timeStep)
 
     URHO3D_PROFILE(UpdateScene);
 
+    // Instantiate queued prefabs first so that they take part in this frame's update
+    if (instantiateQueueHead_ < instantiateQueue_.Size())
+        UpdateInstantiateQueue();
+
     timeStep *= timeScale_;
 
     using namespace SceneUpdate;
 
+    // Update variable timestep logic. Sent typed, as it is received by every logic component
+    SceneUpdateEventData updateData;
+    updateData.scene_ = this;
+    updateData.timeStep_ = timeStep;
+    SendTypedEvent(E_SCENEUPDATE, updateData);
+
+    // Run the logic components that declared themselves safe to update in parallel. Notify the scene that a threaded
+    // update is going on so that components only queue their dirty processing
+    if (!parallelUpdateComponents_.Empty())
+    {
+        URHO3D_PROFILE(ParallelUpdate);
+
+        auto* queue = GetSubsystem<WorkQueue>();
+        BeginThreadedUpdate();
+
+        int numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
+        int componentsPerItem = Max((int)(parallelUpdateComponents_.Size() / numWorkItems), 1);
+
+        PODVector<LogicComponent*>::Iterator start = parallelUpdateComponents_.Begin();
+        // Create a work item for each thread
+        for (int i = 0; i < numWorkItems && start != parallelUpdateComponents_.End(); ++i)
+        {
+            SharedPtr<WorkItem> item = queue->GetFreeItem();
+            item->priority_ = M_MAX_UNSIGNED;
+            item->workFunction_ = ParallelUpdateWork;
+            item->aux_ = &timeStep;
+
+            PODVector<LogicComponent*>::Iterator end = parallelUpdateComponents_.End();
+            if (i < numWorkItems - 1 && end - start > componentsPerItem)
+                end = start + componentsPerItem;
+
+            item->start_ = &(*start);
+            item->end_ = &(*end);
+            queue->AddWorkItem(item);
+
+            start = end;
+        }
+
+        queue->Complete(M_MAX_UNSIGNED);
+        EndThreadedUpdate();
+    }
+
     VariantMap& eventData = GetEventDataMap();
     eventData[P_SCENE] = this;
     eventData[P_TIMESTEP] = timeStep;
 
-    // Update variable timestep logic
-    SendEvent(E_SCENEUPDATE, eventData);
-
-    // Update scene attribute animation.
+    // Update scene attribute animation. Other listeners such as materials get the event, while the nodes and components
+    // of the scene are updated in one pass
     SendEvent(E_ATTRIBUTEANIMATIONUPDATE, eventData);
+    UpdateAnimatedObjects(timeStep);
 
     // Update scene subsystems. If a physics world is present, it will be updated, triggering fixed timestep logic updates
     SendEvent(E_SCENESUBSYSTEMUPDATE, eventData);
@@ -790,6 +1126,9 @@ void Scene::Update(float timeStep)
     {
         URHO3D_PROFILE(UpdateSmoothing);
 
+        if (snapshotClockValid_)
+            snapshotClock_ += timeStep;
+
         float constant = 1.0f - Clamp(powf(2.0f, -timeStep * smoothingConstant_), 0.0f, 1.0f);
         float squaredSnapThreshold = snapThreshold_ * snapThreshold_;
 
@@ -798,10 +1137,11 @@ void Scene::Update(float timeStep)
         smoothingData_[P_CONSTANT] = constant;
         smoothingData_[P_SQUAREDSNAPTHRESHOLD] = squaredSnapThreshold;
         SendEvent(E_UPDATESMOOTHING, smoothingData_);
+        UpdateSmoothedTransforms(constant, squaredSnapThreshold);
     }
 
     // Post-update variable timestep logic
-    SendEvent(E_SCENEPOSTUPDATE, eventData);
+    SendTypedEvent(E_SCENEPOSTUPDATE, updateData);
 
     // Note: using a float for elapsed time accumulation is inherently inaccurate. The purpose of this value is
     // primarily to update material animation effects, as it is available to shaders. It can be reset by calling
@@ -809,6 +1149,58 @@ void Scene::Update(float timeStep)
     elapsedTime_ += timeStep;
 }
 
+void Scene::UpdateAnimatedObjects(float timeStep)
+{
+    if (animatedObjects_.Empty())
+        return;
+
+    URHO3D_PROFILE(UpdateAttributeAnimations);
+
+    // Objects added during the update, for example by animation triggers, are updated on the same frame
+    for (animatedObjectIndex_ = 0; animatedObjectIndex_ < animatedObjects_.Size(); ++animatedObjectIndex_)
+    {
+        Animatable* object = animatedObjects_[animatedObjectIndex_];
+        if (object)
+            object->UpdateAttributeAnimations(timeStep);
+    }
+
+    animatedObjectIndex_ = M_MAX_UNSIGNED;
+    CompactUpdateList(animatedObjects_);
+}
+
+void Scene::UpdateSmoothedTransforms(float constant, float squaredSnapThreshold)
+{
+    if (smoothedTransforms_.Empty())
+        return;
+
+    // Transforms that finish smoothing remove themselves
+    for (smoothedTransformIndex_ = 0; smoothedTransformIndex_ < smoothedTransforms_.Size(); ++smoothedTransformIndex_)
+    {
+        SmoothedTransform* transform = smoothedTransforms_[smoothedTransformIndex_];
+        if (transform)
+            transform->Update(constant, squaredSnapThreshold);
+    }
+
+    smoothedTransformIndex_ = M_MAX_UNSIGNED;
+    CompactUpdateList(smoothedTransforms_);
+}
+
+void SceneUpdateEventData::ToVariantMap(VariantMap& eventData) const
+{
+    using namespace SceneUpdate;
+
+    eventData[P_SCENE] = scene_;
+    eventData[P_TIMESTEP] = timeStep_;
+}
+
+void SceneUpdateEventData::FromVariantMap(VariantMap& eventData)
+{
+    using namespace SceneUpdate;
+
+    scene_ = static_cast<Scene*>(eventData[P_SCENE].GetPtr());
+    timeStep_ = eventData[P_TIMESTEP].GetFloat();
+}
+
 void Scene::BeginThreadedUpdate()
 {
     // Check the work queue subsystem whether it actually has created worker threads. If not, do not enter threaded mode.
@@ -833,12 +1225,98 @@ void Scene::EndThreadedUpdate()
     }
 }
 
+void Scene::UpdateWorldTransforms()
+{
+    if (!threadedTransformUpdate_)
+        return;
+
+    URHO3D_PROFILE(UpdateWorldTransforms);
+
+    if (transformLevelsDirty_)
+        RebuildTransformLevels();
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    int numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
+
+    // Each level only depends on the previous one, so the parent transforms are always up to date and no node
+    // needs to walk its parent chain
+    for (unsigned i = 0; i < transformLevels_.Size(); ++i)
+    {
+        PODVector<Node*>& level = transformLevels_[i];
+        if (level.Empty())
+            continue;
+
+        if (numWorkItems == 1 || level.Size() < MIN_TRANSFORMS_PER_WORK_ITEM * 2)
+        {
+            for (PODVector<Node*>::ConstIterator j = level.Begin(); j != level.End(); ++j)
+                (*j)->GetWorldTransform();
+            continue;
+        }
+
+        int itemsPerLevel = Min(numWorkItems, (int)(level.Size() / MIN_TRANSFORMS_PER_WORK_ITEM));
+        int nodesPerItem = level.Size() / itemsPerLevel;
+
+        PODVector<Node*>::Iterator start = level.Begin();
+        for (int j = 0; j < itemsPerLevel; ++j)
+        {
+            SharedPtr<WorkItem> item = queue->GetFreeItem();
+            item->priority_ = M_MAX_UNSIGNED;
+            item->workFunction_ = UpdateWorldTransformsWork;
+
+            PODVector<Node*>::Iterator end = level.End();
+            if (j < itemsPerLevel - 1 && end - start > nodesPerItem)
+                end = start + nodesPerItem;
+
+            item->start_ = &(*start);
+            item->end_ = &(*end);
+            queue->AddWorkItem(item);
+
+            start = end;
+        }
+
+        queue->Complete(M_MAX_UNSIGNED);
+    }
+}
+
 void Scene::DelayedMarkedDirty(Component* component)
 {
     MutexLock lock(sceneMutex_);
     delayedDirtyComponents_.Push(component);
 }
 
+void Scene::AddParallelUpdate(LogicComponent* component)
+{
+    if (component)
+        parallelUpdateComponents_.Push(component);
+}
+
+void Scene::RemoveParallelUpdate(LogicComponent* component)
+{
+    parallelUpdateComponents_.RemoveSwap(component);
+}
+
+void Scene::AddAnimatedObject(Animatable* object)
+{
+    if (object)
+        animatedObjects_.Push(object);
+}
+
+void Scene::RemoveAnimatedObject(Animatable* object)
+{
+    RemoveFromUpdateList(animatedObjects_, object, animatedObjectIndex_);
+}
+
+void Scene::AddSmoothedTransform(SmoothedTransform* transform)
+{
+    if (transform)
+        smoothedTransforms_.Push(transform);
+}
+
+void Scene::RemoveSmoothedTransform(SmoothedTransform* transform)
+{
+    RemoveFromUpdateList(smoothedTransforms_, transform, smoothedTransformIndex_);
+}
+
 unsigned Scene::GetFreeNodeID(CreateMode mode)
 {
     if (mode == REPLICATED)
@@ -903,6 +1381,19 @@ unsigned Scene::GetFreeComponentID(CreateMode mode)
     }
 }
 
+void Scene::ReserveNodes(unsigned count, CreateMode mode)
+{
+    FlatHashMap<unsigned, Node*>& nodes = mode == REPLICATED ? replicatedNodes_ : localNodes_;
+    nodes.Reserve(nodes.Size() + count);
+    Node::GetObjectPool().Reserve(count);
+}
+
+void Scene::ReserveComponents(unsigned count, CreateMode mode)
+{
+    FlatHashMap<unsigned, Component*>& components = mode == REPLICATED ? replicatedComponents_ : localComponents_;
+    components.Reserve(components.Size() + count);
+}
+
 void Scene::NodeAdded(Node* node)
 {
     if (!node || node->GetScene() == this)
@@ -914,6 +1405,8 @@ void Scene::NodeAdded(Node* node)
         oldScene->NodeRemoved(node);
 
     node->SetScene(this);
+    transformLevelsDirty_ = true;
+    node->SetAttributeAnimationScene(this);
 
     // If the new node has an ID of zero (default), assign a replicated ID now
     unsigned id = node->GetID();
@@ -926,7 +1419,7 @@ void Scene::NodeAdded(Node* node)
     // If node with same ID exists, remove the scene reference from it and overwrite with the new node
     if (IsReplicatedID(id))
     {
-        HashMap<unsigned, Node*>::Iterator i = replicatedNodes_.Find(id);
+        FlatHashMap<unsigned, Node*>::Iterator i = replicatedNodes_.Find(id);
         if (i != replicatedNodes_.End() && i->second_ != node)
         {
             URHO3D_LOGWARNING("Overwriting node with ID " + String(id));
@@ -940,7 +1433,7 @@ void Scene::NodeAdded(Node* node)
     }
     else
     {
-        HashMap<unsigned, Node*>::Iterator i = localNodes_.Find(id);
+        FlatHashMap<unsigned, Node*>::Iterator i = localNodes_.Find(id);
         if (i != localNodes_.End() && i->second_ != node)
         {
             URHO3D_LOGWARNING("Overwriting node with ID " + String(id));
@@ -957,6 +1450,12 @@ void Scene::NodeAdded(Node* node)
             taggedNodes_[tags[i]].Push(node);
     }
 
+    if (changeTracking_)
+    {
+        saveRemovedNodes_.Erase(id);
+        node->MarkNetworkUpdate();
+    }
+
     // Add already created components and child nodes now
     const Vector<SharedPtr<Component> >& components = node->GetComponents();
     for (Vector<SharedPtr<Component> >::ConstIterator i = components.Begin(); i != components.End(); ++i)
@@ -986,11 +1485,22 @@ void Scene::NodeRemoved(Node* node)
     {
         replicatedNodes_.Erase(id);
         MarkReplicationDirty(node);
+        if (interestCellSize_ > 0.0f)
+            RemoveInterestCell(node);
     }
     else
         localNodes_.Erase(id);
 
+    if (changeTracking_)
+    {
+        saveUpdateNodes_.Erase(id);
+        saveRemovedNodes_.Insert(id);
+    }
+    node->ResetSaveUpdate();
+
+    node->SetAttributeAnimationScene(nullptr);
     node->ResetScene();
+    transformLevelsDirty_ = true;
 
     // Remove node from tag cache
     if (!node->GetTags().Empty())
@@ -1009,6 +1519,44 @@ void Scene::NodeRemoved(Node* node)
         NodeRemoved(*i);
 }
 
+void Scene::RebuildTransformLevels()
+{
+    for (unsigned i = 0; i < transformLevels_.Size(); ++i)
+        transformLevels_[i].Clear();
+
+    // Gather the nodes breadth-first so that every node appears one level below its parent
+    unsigned depth = 0;
+    const Vector<SharedPtr<Node> >& rootChildren = GetChildren();
+    if (!rootChildren.Empty())
+    {
+        if (transformLevels_.Empty())
+            transformLevels_.Resize(1);
+        for (Vector<SharedPtr<Node> >::ConstIterator i = rootChildren.Begin(); i != rootChildren.End(); ++i)
+            transformLevels_[0].Push(*i);
+    }
+
+    while (depth < transformLevels_.Size() && !transformLevels_[depth].Empty())
+    {
+        for (unsigned i = 0; i < transformLevels_[depth].Size(); ++i)
+        {
+            const Vector<SharedPtr<Node> >& children = transformLevels_[depth][i]->GetChildren();
+            if (children.Empty())
+                continue;
+
+            if (transformLevels_.Size() <= depth + 1)
+                transformLevels_.Resize(depth + 2);
+            PODVector<Node*>& nextLevel = transformLevels_[depth + 1];
+            for (Vector<SharedPtr<Node> >::ConstIterator j = children.Begin(); j != children.End(); ++j)
+                nextLevel.Push(*j);
+        }
+        ++depth;
+    }
+
+    // Drop levels left over from a deeper hierarchy
+    transformLevels_.Resize(depth);
+    transformLevelsDirty_ = false;
+}
+
 void Scene::ComponentAdded(Component* component)
 {
     if (!component)
@@ -1025,7 +1573,7 @@ void Scene::ComponentAdded(Component* component)
 
     if (IsReplicatedID(id))
     {
-        HashMap<unsigned, Component*>::Iterator i = replicatedComponents_.Find(id);
+        FlatHashMap<unsigned, Component*>::Iterator i = replicatedComponents_.Find(id);
         if (i != replicatedComponents_.End() && i->second_ != component)
         {
             URHO3D_LOGWARNING("Overwriting component with ID " + String(id));
@@ -1036,7 +1584,7 @@ void Scene::ComponentAdded(Component* component)
     }
     else
     {
-        HashMap<unsigned, Component*>::Iterator i = localComponents_.Find(id);
+        FlatHashMap<unsigned, Component*>::Iterator i = localComponents_.Find(id);
         if (i != localComponents_.End() && i->second_ != component)
         {
             URHO3D_LOGWARNING("Overwriting component with ID " + String(id));
@@ -1047,6 +1595,13 @@ void Scene::ComponentAdded(Component* component)
     }
 
     component->OnSceneSet(this);
+    component->SetAttributeAnimationScene(this);
+
+    if (changeTracking_)
+    {
+        saveRemovedComponents_.Erase(id);
+        component->MarkNetworkUpdate();
+    }
 }
 
 void Scene::ComponentRemoved(Component* component)
@@ -1060,6 +1615,14 @@ void Scene::ComponentRemoved(Component* component)
     else
         localComponents_.Erase(id);
 
+    if (changeTracking_)
+    {
+        saveUpdateComponents_.Erase(id);
+        saveRemovedComponents_.Insert(id);
+    }
+    component->ResetSaveUpdate();
+
+    component->SetAttributeAnimationScene(nullptr);
     component->SetID(0);
     component->OnSceneSet(nullptr);
 }
@@ -1104,18 +1667,41 @@ void Scene::PrepareNetworkUpdate()
             component->PrepareNetworkUpdate();
     }
 
+    // Moved nodes also move their children, so update the interest grid cells of the whole subtree
+    if (interestCellSize_ > 0.0f)
+    {
+        for (HashSet<unsigned>::Iterator i = networkUpdateNodes_.Begin(); i != networkUpdateNodes_.End(); ++i)
+        {
+            Node* node = GetNode(*i);
+            if (node && node != this)
+                UpdateInterestCells(node);
+        }
+    }
+
     networkUpdateNodes_.Clear();
     networkUpdateComponents_.Clear();
 }
 
+void Scene::UpdateReplicatedTransforms()
+{
+    if (threadedTransformUpdate_)
+    {
+        UpdateWorldTransforms();
+        return;
+    }
+
+    for (FlatHashMap<unsigned, Node*>::ConstIterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
+        i->second_->GetWorldTransform();
+}
+
 void Scene::CleanupConnection(Connection* connection)
 {
     Node::CleanupConnection(connection);
 
-    for (HashMap<unsigned, Node*>::Iterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
+    for (FlatHashMap<unsigned, Node*>::Iterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
         i->second_->CleanupConnection(connection);
 
-    for (HashMap<unsigned, Component*>::Iterator i = replicatedComponents_.Begin(); i != replicatedComponents_.End(); ++i)
+    for (FlatHashMap<unsigned, Component*>::Iterator i = replicatedComponents_.Begin(); i != replicatedComponents_.End(); ++i)
         i->second_->CleanupConnection(connection);
 }
 
@@ -1147,6 +1733,73 @@ void Scene::MarkNetworkUpdate(Component* component)
     }
 }
 
+void Scene::MarkSaveUpdate(Node* node)
+{
+    if (node && changeTracking_)
+    {
+        if (!threadedUpdate_)
+            saveUpdateNodes_.Insert(node->GetID());
+        else
+        {
+            MutexLock lock(sceneMutex_);
+            saveUpdateNodes_.Insert(node->GetID());
+        }
+    }
+}
+
+void Scene::MarkSaveUpdate(Component* component)
+{
+    if (component && changeTracking_)
+    {
+        if (!threadedUpdate_)
+            saveUpdateComponents_.Insert(component->GetID());
+        else
+        {
+            MutexLock lock(sceneMutex_);
+            saveUpdateComponents_.Insert(component->GetID());
+        }
+    }
+}
+
+void Scene::TakeSaveChanges(PODVector<unsigned>& nodes, PODVector<unsigned>& components, PODVector<unsigned>& removedNodes,
+    PODVector<unsigned>& removedComponents)
+{
+    nodes.Clear();
+    components.Clear();
+    removedNodes.Clear();
+    removedComponents.Clear();
+
+    for (HashSet<unsigned>::ConstIterator i = saveUpdateNodes_.Begin(); i != saveUpdateNodes_.End(); ++i)
+    {
+        Node* node = GetNode(*i);
+        if (node)
+        {
+            node->ResetSaveUpdate();
+            nodes.Push(*i);
+        }
+    }
+
+    for (HashSet<unsigned>::ConstIterator i = saveUpdateComponents_.Begin(); i != saveUpdateComponents_.End(); ++i)
+    {
+        Component* component = GetComponent(*i);
+        if (component)
+        {
+            component->ResetSaveUpdate();
+            components.Push(*i);
+        }
+    }
+
+    for (HashSet<unsigned>::ConstIterator i = saveRemovedNodes_.Begin(); i != saveRemovedNodes_.End(); ++i)
+        removedNodes.Push(*i);
+    for (HashSet<unsigned>::ConstIterator i = saveRemovedComponents_.Begin(); i != saveRemovedComponents_.End(); ++i)
+        removedComponents.Push(*i);
+
+    saveUpdateNodes_.Clear();
+    saveUpdateComponents_.Clear();
+    saveRemovedNodes_.Clear();
+    saveRemovedComponents_.Clear();
+}
+
 void Scene::MarkReplicationDirty(Node* node)
 {
     if (networkState_ && node->IsReplicated())
@@ -1161,6 +1814,58 @@ void Scene::MarkReplicationDirty(Node* node)
     }
 }
 
+IntVector3 Scene::GetInterestCell(const Vector3& position) const
+{
+    return IntVector3(FloorToInt(position.x_ / interestCellSize_), FloorToInt(position.y_ / interestCellSize_),
+        FloorToInt(position.z_ / interestCellSize_));
+}
+
+void Scene::UpdateInterestCells(Node* node)
+{
+    if (node->IsReplicated())
+    {
+        IntVector3 cell = GetInterestCell(node->GetWorldPosition());
+        HashMap<unsigned, IntVector3>::Iterator i = interestNodeCells_.Find(node->GetID());
+        if (i == interestNodeCells_.End())
+        {
+            interestCells_[cell].Push(node);
+            interestNodeCells_[node->GetID()] = cell;
+        }
+        else if (i->second_ != cell)
+        {
+            HashMap<IntVector3, PODVector<Node*> >::Iterator j = interestCells_.Find(i->second_);
+            if (j != interestCells_.End())
+            {
+                j->second_.RemoveSwap(node);
+                if (j->second_.Empty())
+                    interestCells_.Erase(j);
+            }
+            interestCells_[cell].Push(node);
+            i->second_ = cell;
+        }
+    }
+
+    const Vector<SharedPtr<Node> >& children = node->GetChildren();
+    for (Vector<SharedPtr<Node> >::ConstIterator i = children.Begin(); i != children.End(); ++i)
+        UpdateInterestCells(*i);
+}
+
+void Scene::RemoveInterestCell(Node* node)
+{
+    HashMap<unsigned, IntVector3>::Iterator i = interestNodeCells_.Find(node->GetID());
+    if (i == interestNodeCells_.End())
+        return;
+
+    HashMap<IntVector3, PODVector<Node*> >::Iterator j = interestCells_.Find(i->second_);
+    if (j != interestCells_.End())
+    {
+        j->second_.RemoveSwap(node);
+        if (j->second_.Empty())
+            interestCells_.Erase(j);
+    }
+    interestNodeCells_.Erase(i);
+}
+
 void Scene::HandleUpdate(StringHash eventType, VariantMap& eventData)
 {
     if (!updateEnabled_)
@@ -1251,6 +1956,47 @@ void Scene::UpdateAsyncLoading()
     SendEvent(E_ASYNCLOADPROGRESS, eventData);
 }
 
+void Scene::UpdateInstantiateQueue()
+{
+    URHO3D_PROFILE(UpdateInstantiateQueue);
+
+    HiresTimer instantiateTimer;
+
+    while (instantiateQueueHead_ < instantiateQueue_.Size())
+    {
+        // Take before instantiating, as the event handlers may modify the queue
+        QueuedInstantiation queued = instantiateQueue_[instantiateQueueHead_];
+        instantiateQueue_[instantiateQueueHead_].prefab_.Reset();
+        ++instantiateQueueHead_;
+
+        Node* parent = queued.parent_.Expired() ? nullptr : queued.parent_.Get();
+        Node* node = parent ? queued.prefab_->Instantiate(parent, queued.position_, queued.rotation_, queued.mode_) : nullptr;
+        if (node)
+        {
+            using namespace PrefabInstantiated;
+
+            VariantMap& eventData = GetEventDataMap();
+            eventData[P_SCENE] = this;
+            eventData[P_PREFAB] = queued.prefab_.Get();
+            eventData[P_NODE] = node;
+            SendEvent(E_PREFABINSTANTIATED, eventData);
+        }
+
+        // Break if time limit exceeded, so that we keep sufficient FPS
+        if (instantiateTimer.GetUSec(false) >= instantiateQueueMs_ * 1000LL)
+            break;
+    }
+
+    // Remove the processed instantiations once they are at least half of the queue, so that draining a large queue stays linear
+    if (instantiateQueueHead_ >= instantiateQueue_.Size())
+        ClearInstantiateQueue();
+    else if (instantiateQueueHead_ * 2 >= instantiateQueue_.Size())
+    {
+        instantiateQueue_.Erase(0, instantiateQueueHead_);
+        instantiateQueueHead_ = 0;
+    }
+}
+
 void Scene::FinishAsyncLoading()
 {
     if (asyncProgress_.mode_ > LOAD_RESOURCES_ONLY)
@@ -1288,14 +2034,16 @@ void Scene::FinishSaving(Serializer* dest) const
     }
 }
 
-void Scene::PreloadResources(File* file, bool isSceneFile)
+unsigned Scene::PreloadResources(Deserializer& source, HashSet<StringHash>& resources, bool isSceneFile)
 {
+    unsigned numQueued = 0;
+
     // If not threaded, can not background load resources, so rather load synchronously later when needed
 #ifdef URHO3D_THREADING
     auto* cache = GetSubsystem<ResourceCache>();
 
     // Read node ID (not needed)
-    /*unsigned nodeID = */file->ReadUInt();
+    /*unsigned nodeID = */source.ReadUInt();
 
     // Read Node or Scene attributes; these do not include any resources
     const Vector<AttributeInfo>* attributes = context_->GetAttributes(isSceneFile ? Scene::GetTypeStatic() : Node::GetTypeStatic());
@@ -1306,14 +2054,17 @@ void Scene::PreloadResources(File* file, bool isSceneFile)
         const AttributeInfo& attr = attributes->At(i);
         if (!(attr.mode_ & AM_FILE))
             continue;
-        /*Variant varValue = */file->ReadVariant(attr.type_);
+        /*Variant varValue = */source.ReadVariant(attr.type_);
     }
 
     // Read component attributes
-    unsigned numComponents = file->ReadVLE();
+    PODVector<unsigned char> compStorage;
+    unsigned numComponents = source.ReadVLE();
     for (unsigned i = 0; i < numComponents; ++i)
     {
-        VectorBuffer compBuffer(*file, file->ReadVLE());
+        unsigned compSize = source.ReadVLE();
+        const unsigned char* compData = source.ReadBlock(compSize, compStorage);
+        MemoryBuffer compBuffer(compData, compSize);
         StringHash compType = compBuffer.ReadStringHash();
         // Read component ID (not needed)
         /*unsigned compID = */compBuffer.ReadUInt();
@@ -1335,8 +2086,8 @@ void Scene::PreloadResources(File* file, bool isSceneFile)
                     bool success = cache->BackgroundLoadResource(ref.type_, name);
                     if (success)
                     {
-                        ++asyncProgress_.totalResources_;
-                        asyncProgress_.resources_.Insert(StringHash(name));
+                        ++numQueued;
+                        resources.Insert(StringHash(name));
                     }
                 }
                 else if (attr.type_ == VAR_RESOURCEREFLIST)
@@ -1348,8 +2099,8 @@ void Scene::PreloadResources(File* file, bool isSceneFile)
                         bool success = cache->BackgroundLoadResource(refList.type_, name);
                         if (success)
                         {
-                            ++asyncProgress_.totalResources_;
-                            asyncProgress_.resources_.Insert(StringHash(name));
+                            ++numQueued;
+                            resources.Insert(StringHash(name));
                         }
                     }
                 }
@@ -1358,10 +2109,12 @@ void Scene::PreloadResources(File* file, bool isSceneFile)
     }
 
     // Read child nodes
-    unsigned numChildren = file->ReadVLE();
+    unsigned numChildren = source.ReadVLE();
     for (unsigned i = 0; i < numChildren; ++i)
-        PreloadResources(file, false);
+        numQueued += PreloadResources(source, resources, false);
 #endif
+
+    return numQueued;
 }
 
 void Scene::PreloadResourcesXML(const XMLElement& element)
@@ -1531,11 +2284,13 @@ void RegisterSceneLibrary(Context* context)
 {
     ValueAnimation::RegisterObject(context);
     ObjectAnimation::RegisterObject(context);
+    PrefabTemplate::RegisterObject(context);
     Node::RegisterObject(context);
     Scene::RegisterObject(context);
     SmoothedTransform::RegisterObject(context);
     UnknownComponent::RegisterObject(context);
     SplinePath::RegisterObject(context);
+    SceneStreamer::RegisterObject(context);
 }
 
 }
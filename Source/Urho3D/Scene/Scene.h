@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "../Container/FlatHashMap.h"
 #include "../Container/HashSet.h"
 #include "../Core/Mutex.h"
 #include "../Resource/XMLElement.h"
@@ -35,6 +36,9 @@ namespace Urho3D
 {
 
 class File;
+class LogicComponent;
+class PrefabTemplate;
+class SmoothedTransform;
 class PackageFile;
 
 static const unsigned FIRST_REPLICATED_ID = 0x1;
@@ -83,6 +87,21 @@ struct AsyncProgress
     unsigned totalNodes_;
 };
 
+/// Prefab template instantiation waiting in the scene's instantiation queue.
+struct QueuedInstantiation
+{
+    /// Prefab template.
+    SharedPtr<PrefabTemplate> prefab_;
+    /// Parent node.
+    WeakPtr<Node> parent_;
+    /// Position.
+    Vector3 position_;
+    /// Rotation.
+    Quaternion rotation_;
+    /// Create mode.
+    CreateMode mode_;
+};
+
 /// Root scene node, represents the whole scene.
 class URHO3D_API Scene : public Node
 {
@@ -145,6 +164,12 @@ public:
         (const JSONValue& source, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED);
     /// Instantiate scene content from JSON data. Return root node if successful.
     Node* InstantiateJSON(Deserializer& source, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED);
+    /// Instantiate a compiled prefab template. Return root node if successful.
+    Node* Instantiate(PrefabTemplate* prefab, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED);
+    /// Queue a compiled prefab template to be instantiated during the scene update, spreading large numbers of instantiations over several frames. Each finished instantiation sends E_PREFABINSTANTIATED. The parent defaults to the scene.
+    void QueueInstantiate(PrefabTemplate* prefab, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED, Node* parent = nullptr);
+    /// Remove all queued prefab template instantiations.
+    void ClearInstantiateQueue();
 
     /// Clear scene completely of either replicated, local or all nodes and components.
     void Clear(bool clearReplicated = true, bool clearLocal = true);
@@ -163,9 +188,29 @@ public:
     /// Set network client motion smoothing snap threshold.
     /// @property
     void SetSnapThreshold(float threshold);
+    /// Set network client interpolation delay in seconds. When non-zero, smoothed transforms buffer the received updates by their server time and interpolate between them this far behind the estimated server time, instead of smoothing exponentially. Should cover at least two network update intervals.
+    /// @property
+    void SetInterpolationDelay(float delay);
+    /// Set network client maximum extrapolation time in seconds, used by smoothed transforms when the updates run out during interpolation.
+    /// @property
+    void SetMaxExtrapolation(float time);
+    /// Set the server time and update interval of the network update being applied, and synchronize the estimated server time to it. Called by Connection on the client.
+    void SetSnapshotTime(float time, float interval);
     /// Set maximum milliseconds per frame to spend on async scene loading.
     /// @property
     void SetAsyncLoadingMs(int ms);
+    /// Set maximum milliseconds per frame to spend on queued prefab template instantiations. At least one is always instantiated per frame.
+    /// @property
+    void SetInstantiateQueueMs(int ms);
+    /// Set whether to keep the scene nodes in depth-ordered lists and update dirty world transforms level by level in worker threads once per frame, before the octree update. Useful for scenes with large moving hierarchies.
+    /// @property
+    void SetThreadedTransformUpdate(bool enable);
+    /// Set whether to record changed, added and removed nodes and components for incremental saving. Used by SceneSaveLog.
+    /// @property
+    void SetChangeTracking(bool enable);
+    /// Set the cell size of the spatial interest grid of replicated nodes, used on the server by connections that have an interest radius. 0 disables the grid (default).
+    /// @property
+    void SetInterestCellSize(float size);
     /// Add a required package file for networking. To be called on the server.
     void AddRequiredPackageFile(PackageFile* package);
     /// Clear required package files.
@@ -183,11 +228,17 @@ public:
     Component* GetComponent(unsigned id) const;
     /// Get nodes with specific tag from the whole scene, return false if empty.
     bool GetNodesWithTag(PODVector<Node*>& dest, const String& tag)  const;
+    /// Get replicated nodes whose world position is within a radius from a point, using the spatial interest grid. Return false if the grid is disabled.
+    bool GetInterestNodes(PODVector<Node*>& dest, const Vector3& center, float radius) const;
 
     /// Return whether updates are enabled.
     /// @property
     bool IsUpdateEnabled() const { return updateEnabled_; }
 
+    /// Return whether changes are recorded for incremental saving.
+    /// @property
+    bool GetChangeTracking() const { return changeTracking_; }
+
     /// Return whether an asynchronous loading operation is in progress.
     /// @property
     bool IsAsyncLoading() const { return asyncLoading_; }
@@ -224,10 +275,44 @@ public:
     /// @property
     float GetSnapThreshold() const { return snapThreshold_; }
 
+    /// Return network client interpolation delay, or 0 if exponential smoothing is used.
+    /// @property
+    float GetInterpolationDelay() const { return interpolationDelay_; }
+
+    /// Return network client maximum extrapolation time.
+    /// @property
+    float GetMaxExtrapolation() const { return maxExtrapolation_; }
+
+    /// Return the server time of the network update being applied.
+    float GetSnapshotTime() const { return snapshotTime_; }
+
+    /// Return the server update interval of the network update being applied.
+    float GetSnapshotInterval() const { return snapshotInterval_; }
+
+    /// Return the server time the smoothed transforms are currently interpolated at.
+    /// @property
+    float GetInterpolationTime() const { return snapshotClock_ - interpolationDelay_; }
+
     /// Return maximum milliseconds per frame to spend on async loading.
     /// @property
     int GetAsyncLoadingMs() const { return asyncLoadingMs_; }
 
+    /// Return maximum milliseconds per frame to spend on queued prefab template instantiations.
+    /// @property
+    int GetInstantiateQueueMs() const { return instantiateQueueMs_; }
+
+    /// Return number of queued prefab template instantiations.
+    /// @property
+    unsigned GetNumQueuedInstantiations() const { return instantiateQueue_.Size() - instantiateQueueHead_; }
+
+    /// Return whether dirty world transforms are updated level by level in worker threads.
+    /// @property
+    bool GetThreadedTransformUpdate() const { return threadedTransformUpdate_; }
+
+    /// Return the cell size of the spatial interest grid, or 0 if disabled.
+    /// @property
+    float GetInterestCellSize() const { return interestCellSize_; }
+
     /// Return required package files.
     /// @property
     const Vector<SharedPtr<PackageFile> >& GetRequiredPackageFiles() const { return requiredPackageFiles_; }
@@ -241,16 +326,34 @@ public:
     void BeginThreadedUpdate();
     /// End a threaded update. Notify components that marked themselves for delayed dirty processing.
     void EndThreadedUpdate();
+    /// Update dirty world transforms of all scene nodes level by level in worker threads, if enabled. Called by Octree before updating drawables.
+    void UpdateWorldTransforms();
     /// Add a component to the delayed dirty notify queue. Is thread-safe.
     void DelayedMarkedDirty(Component* component);
 
     /// Return threaded update flag.
     bool IsThreadedUpdate() const { return threadedUpdate_; }
 
+    /// Add a logic component to the parallel update phase. Called by LogicComponent.
+    void AddParallelUpdate(LogicComponent* component);
+    /// Remove a logic component from the parallel update phase. Called by LogicComponent.
+    void RemoveParallelUpdate(LogicComponent* component);
+    /// Add an object to the batched attribute animation update. Called by Animatable.
+    void AddAnimatedObject(Animatable* object);
+    /// Remove an object from the batched attribute animation update. Called by Animatable.
+    void RemoveAnimatedObject(Animatable* object);
+    /// Add a transform to the batched smoothing update. Called by SmoothedTransform.
+    void AddSmoothedTransform(SmoothedTransform* transform);
+    /// Remove a transform from the batched smoothing update. Called by SmoothedTransform.
+    void RemoveSmoothedTransform(SmoothedTransform* transform);
     /// Get free node ID, either non-local or local.
     unsigned GetFreeNodeID(CreateMode mode);
     /// Get free component ID, either non-local or local.
     unsigned GetFreeComponentID(CreateMode mode);
+    /// Reserve pooled node memory and ID map capacity for creating the specified number of additional nodes, so that spawning them does not allocate or rehash.
+    void ReserveNodes(unsigned count, CreateMode mode = REPLICATED);
+    /// Reserve ID map capacity for creating the specified number of additional components.
+    void ReserveComponents(unsigned count, CreateMode mode = REPLICATED);
     /// Return whether the specified id is a replicated id.
     static bool IsReplicatedID(unsigned id) { return id < FIRST_LOCAL_ID; }
 
@@ -273,6 +376,8 @@ public:
     String GetVarNamesAttr() const;
     /// Prepare network update by comparing attributes and marking replication states dirty as necessary.
     void PrepareNetworkUpdate();
+    /// Update the dirty world transforms of all replicated nodes, so that worker threads can read them while building the server updates of the connections.
+    void UpdateReplicatedTransforms();
     /// Clean up all references to a network connection that is about to be removed.
     /// @manualbind
     void CleanupConnection(Connection* connection);
@@ -282,6 +387,19 @@ public:
     void MarkNetworkUpdate(Component* component);
     /// Mark a node dirty in scene replication states. The node does not need to have own replication state yet.
     void MarkReplicationDirty(Node* node);
+    /// Mark a node changed for the next incremental save.
+    void MarkSaveUpdate(Node* node);
+    /// Mark a component changed for the next incremental save.
+    void MarkSaveUpdate(Component* component);
+    /// Return the IDs of nodes and components changed or removed since the last call, and clear the records.
+    /// @nobind
+    void TakeSaveChanges(PODVector<unsigned>& nodes, PODVector<unsigned>& components, PODVector<unsigned>& removedNodes,
+        PODVector<unsigned>& removedComponents);
+    /// Begin background loading the resources referenced by a binary node, its components and child nodes, reading the node from the current position of the source. Adds the names of the queued resources to the set and returns how many were queued. Does nothing if threading is disabled.
+    /// @nobind
+    unsigned PreloadResources(Deserializer& source, HashSet<StringHash>& resources, bool isSceneFile = false);
+    /// Mark the depth-ordered transform update lists for rebuild. Called when nodes are added, removed or reparented.
+    void MarkTransformHierarchyDirty() { transformLevelsDirty_ = true; }
 
 private:
     /// Handle the logic update event to update the scene, if active.
@@ -292,31 +410,45 @@ private:
     void UpdateAsyncLoading();
     /// Finish asynchronous loading.
     void FinishAsyncLoading();
+    /// Instantiate queued prefab templates within the time budget.
+    void UpdateInstantiateQueue();
     /// Finish loading. Sets the scene filename and checksum.
     void FinishLoading(Deserializer* source);
     /// Finish saving. Sets the scene filename and checksum.
     void FinishSaving(Serializer* dest) const;
-    /// Preload resources from a binary scene or object prefab file.
-    void PreloadResources(File* file, bool isSceneFile);
+    /// Rebuild the depth-ordered node lists for the threaded transform update.
+    void RebuildTransformLevels();
+    /// Update attribute animations of the registered nodes and components.
+    void UpdateAnimatedObjects(float timeStep);
+    /// Update the registered transforms with ongoing smoothing.
+    void UpdateSmoothedTransforms(float constant, float squaredSnapThreshold);
+    /// Return the spatial interest grid cell of a world position.
+    IntVector3 GetInterestCell(const Vector3& position) const;
+    /// Move a replicated node and its children to the interest grid cells of their current world positions.
+    void UpdateInterestCells(Node* node);
+    /// Remove a node from the spatial interest grid.
+    void RemoveInterestCell(Node* node);
     /// Preload resources from an XML scene or object prefab file.
     void PreloadResourcesXML(const XMLElement& element);
     /// Preload resources from a JSON scene or object prefab file.
     void PreloadResourcesJSON(const JSONValue& value);
 
     /// Replicated scene nodes by ID.
-    HashMap<unsigned, Node*> replicatedNodes_;
+    FlatHashMap<unsigned, Node*> replicatedNodes_;
     /// Local scene nodes by ID.
-    HashMap<unsigned, Node*> localNodes_;
+    FlatHashMap<unsigned, Node*> localNodes_;
     /// Replicated components by ID.
-    HashMap<unsigned, Component*> replicatedComponents_;
+    FlatHashMap<unsigned, Component*> replicatedComponents_;
     /// Local components by ID.
-    HashMap<unsigned, Component*> localComponents_;
+    FlatHashMap<unsigned, Component*> localComponents_;
     /// Cached tagged nodes by tag.
     HashMap<StringHash, PODVector<Node*> > taggedNodes_;
     /// Asynchronous loading progress.
     AsyncProgress asyncProgress_;
     /// Node and component ID resolver for asynchronous loading.
     SceneResolver resolver_;
+    /// Queued prefab template instantiations.
+    Vector<QueuedInstantiation> instantiateQueue_;
     /// Source file name.
     mutable String fileName_;
     /// Required package files for networking.
@@ -327,10 +459,34 @@ private:
     HashSet<unsigned> networkUpdateNodes_;
     /// Components to check for attribute changes on the next network update.
     HashSet<unsigned> networkUpdateComponents_;
+    /// Nodes changed since the last incremental save.
+    HashSet<unsigned> saveUpdateNodes_;
+    /// Components changed since the last incremental save.
+    HashSet<unsigned> saveUpdateComponents_;
+    /// Nodes removed since the last incremental save.
+    HashSet<unsigned> saveRemovedNodes_;
+    /// Components removed since the last incremental save.
+    HashSet<unsigned> saveRemovedComponents_;
+    /// Replicated nodes in the spatial interest grid by cell.
+    HashMap<IntVector3, PODVector<Node*> > interestCells_;
+    /// Current spatial interest grid cells of replicated nodes by ID.
+    HashMap<unsigned, IntVector3> interestNodeCells_;
     /// Delayed dirty notification queue for components.
     PODVector<Component*> delayedDirtyComponents_;
     /// Mutex for the delayed dirty notification queue.
     Mutex sceneMutex_;
+    /// Logic components that use the parallel update phase.
+    PODVector<LogicComponent*> parallelUpdateComponents_;
+    /// Nodes and components with attribute animations.
+    PODVector<Animatable*> animatedObjects_;
+    /// Transforms with ongoing smoothing.
+    PODVector<SmoothedTransform*> smoothedTransforms_;
+    /// Index of the animated object being updated, or M_MAX_UNSIGNED outside the update.
+    unsigned animatedObjectIndex_;
+    /// Index of the smoothed transform being updated, or M_MAX_UNSIGNED outside the update.
+    unsigned smoothedTransformIndex_;
+    /// Scene nodes ordered by hierarchy depth for the threaded transform update, one list per level.
+    Vector<PODVector<Node*> > transformLevels_;
     /// Preallocated event data map for smoothing update events.
     VariantMap smoothingData_;
     /// Next free non-local node ID.
@@ -345,6 +501,10 @@ private:
     mutable unsigned checksum_;
     /// Maximum milliseconds per frame to spend on async scene loading.
     int asyncLoadingMs_;
+    /// Maximum milliseconds per frame to spend on queued prefab template instantiations.
+    int instantiateQueueMs_;
+    /// Index of the next queued prefab template instantiation. The processed instantiations before it are removed in batches.
+    unsigned instantiateQueueHead_;
     /// Scene update time scale.
     float timeScale_;
     /// Elapsed time accumulator.
@@ -353,12 +513,32 @@ private:
     float smoothingConstant_;
     /// Motion smoothing snap threshold.
     float snapThreshold_;
+    /// Spatial interest grid cell size, or 0 if disabled.
+    float interestCellSize_;
+    /// Snapshot interpolation delay.
+    float interpolationDelay_;
+    /// Maximum snapshot extrapolation time.
+    float maxExtrapolation_;
+    /// Server time of the network update being applied.
+    float snapshotTime_;
+    /// Server update interval of the network update being applied.
+    float snapshotInterval_;
+    /// Estimated current server time.
+    float snapshotClock_;
+    /// Estimated server time valid flag.
+    bool snapshotClockValid_;
     /// Update enabled flag.
     bool updateEnabled_;
     /// Asynchronous loading flag.
     bool asyncLoading_;
+    /// Threaded transform update flag.
+    bool threadedTransformUpdate_;
+    /// Depth-ordered node lists need rebuild flag.
+    bool transformLevelsDirty_;
     /// Threaded update flag.
     bool threadedUpdate_;
+    /// Change tracking for incremental saving flag.
+    bool changeTracking_;
 };
 
 /// Register Scene library objects.
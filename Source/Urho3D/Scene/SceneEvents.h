@@ -34,6 +34,22 @@ URHO3D_EVENT(E_SCENEUPDATE, SceneUpdate)
     URHO3D_PARAM(P_TIMESTEP, TimeStep);            // float
 }
 
+class Scene;
+
+/// Typed payload of the variable timestep scene update events E_SCENEUPDATE and E_SCENEPOSTUPDATE, for sending them without building event data.
+struct URHO3D_API SceneUpdateEventData
+{
+    /// Convert to event data.
+    void ToVariantMap(VariantMap& eventData) const;
+    /// Convert from event data.
+    void FromVariantMap(VariantMap& eventData);
+
+    /// Scene.
+    Scene* scene_;
+    /// Scaled time step.
+    float timeStep_;
+};
+
 /// Scene subsystem update.
 URHO3D_EVENT(E_SCENESUBSYSTEMUPDATE, SceneSubsystemUpdate)
 {
@@ -110,6 +126,14 @@ URHO3D_EVENT(E_ASYNCLOADFINISHED, AsyncLoadFinished)
     URHO3D_PARAM(P_SCENE, Scene);                  // Scene pointer
 }
 
+/// A queued prefab template instantiation finished.
+URHO3D_EVENT(E_PREFABINSTANTIATED, PrefabInstantiated)
+{
+    URHO3D_PARAM(P_SCENE, Scene);                  // Scene pointer
+    URHO3D_PARAM(P_PREFAB, Prefab);                // PrefabTemplate pointer
+    URHO3D_PARAM(P_NODE, Node);                    // Node pointer
+}
+
 /// A child node has been added to a parent node.
 URHO3D_EVENT(E_NODEADDED, NodeAdded)
 {
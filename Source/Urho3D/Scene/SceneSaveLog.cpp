@@ -0,0 +1,782 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Container/Sort.h"
+#include "../Core/Context.h"
+#include "../Core/Mutex.h"
+#include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#include "../Core/Timer.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../IO/VectorBuffer.h"
+#include "../Scene/Component.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+#include "../Scene/SceneSaveLog.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Record types of the scene save log.
+enum SceneSaveRecordType
+{
+    SSR_NODE = 0,
+    SSR_COMPONENT,
+    SSR_REMOVENODE,
+    SSR_REMOVECOMPONENT
+};
+
+/// Copied state of a node or component, or a removal.
+struct SceneSaveRecord
+{
+    /// Record type.
+    SceneSaveRecordType type_{SSR_NODE};
+    /// Node or component ID.
+    unsigned id_{};
+    /// Parent node ID for a node, or owner node ID for a component. Zero for the scene.
+    unsigned ownerID_{};
+    /// Component type.
+    StringHash componentType_;
+    /// Attribute name hashes.
+    PODVector<StringHash> attributeNames_;
+    /// Attribute values.
+    Vector<Variant> attributeValues_;
+};
+
+/// Unit of work for the background writer thread.
+struct SceneSaveBatch : public RefCounted
+{
+    /// Records to write.
+    Vector<SceneSaveRecord> records_;
+    /// Replace the file with a new log starting with these records.
+    bool snapshot_{};
+    /// Compact the log instead of writing records.
+    bool compact_{};
+};
+
+static void WriteRecord(Serializer& dest, const SceneSaveRecord& record)
+{
+    dest.WriteUByte((unsigned char)record.type_);
+    dest.WriteUInt(record.id_);
+    if (record.type_ == SSR_REMOVENODE || record.type_ == SSR_REMOVECOMPONENT)
+        return;
+
+    dest.WriteUInt(record.ownerID_);
+    if (record.type_ == SSR_COMPONENT)
+        dest.WriteStringHash(record.componentType_);
+    dest.WriteVLE(record.attributeValues_.Size());
+    for (unsigned i = 0; i < record.attributeValues_.Size(); ++i)
+    {
+        dest.WriteStringHash(record.attributeNames_[i]);
+        dest.WriteVariant(record.attributeValues_[i]);
+    }
+}
+
+static bool ReadRecord(Deserializer& source, SceneSaveRecord& record)
+{
+    record.type_ = (SceneSaveRecordType)source.ReadUByte();
+    record.id_ = source.ReadUInt();
+    record.attributeNames_.Clear();
+    record.attributeValues_.Clear();
+    if (record.type_ == SSR_REMOVENODE || record.type_ == SSR_REMOVECOMPONENT)
+        return !source.IsEof() || source.GetPosition() == source.GetSize();
+    if (record.type_ != SSR_NODE && record.type_ != SSR_COMPONENT)
+        return false;
+
+    record.ownerID_ = source.ReadUInt();
+    if (record.type_ == SSR_COMPONENT)
+        record.componentType_ = source.ReadStringHash();
+    unsigned numAttributes = source.ReadVLE();
+    if (numAttributes > source.GetSize() - source.GetPosition())
+        return false;
+    record.attributeNames_.Resize(numAttributes);
+    record.attributeValues_.Resize(numAttributes);
+    for (unsigned i = 0; i < numAttributes; ++i)
+    {
+        record.attributeNames_[i] = source.ReadStringHash();
+        record.attributeValues_[i] = source.ReadVariant();
+    }
+    return true;
+}
+
+/// Append a batch of records to a log file: payload size, record count and the records. Loading stops at a batch that was not completely written.
+static bool WriteBatch(File& file, const Vector<SceneSaveRecord>& records)
+{
+    VectorBuffer payload;
+    for (unsigned i = 0; i < records.Size(); ++i)
+        WriteRecord(payload, records[i]);
+
+    bool success = file.WriteUInt(payload.GetSize());
+    success &= file.WriteUInt(records.Size());
+    success &= file.Write(payload.GetData(), payload.GetSize()) == payload.GetSize();
+    file.Flush();
+    return success;
+}
+
+/// Apply a record to the merged state of a log.
+static void MergeRecord(SceneSaveRecord& record, HashMap<unsigned, SceneSaveRecord>& nodes,
+    HashMap<unsigned, SceneSaveRecord>& components)
+{
+    switch (record.type_)
+    {
+    case SSR_NODE:
+        Swap(nodes[record.id_], record);
+        break;
+
+    case SSR_COMPONENT:
+        Swap(components[record.id_], record);
+        break;
+
+    case SSR_REMOVENODE:
+        nodes.Erase(record.id_);
+        break;
+
+    case SSR_REMOVECOMPONENT:
+        components.Erase(record.id_);
+        break;
+    }
+}
+
+/// Read a log file and merge all complete batches. Return true if the file could be read.
+static bool ReadLog(File& file, HashMap<unsigned, SceneSaveRecord>& nodes, HashMap<unsigned, SceneSaveRecord>& components)
+{
+    nodes.Clear();
+    components.Clear();
+
+    if (file.ReadFileID() != "USLG")
+    {
+        URHO3D_LOGERROR(file.GetName() + " is not a valid scene save log");
+        return false;
+    }
+
+    SceneSaveRecord record;
+    while (file.GetSize() - file.GetPosition() >= 2 * sizeof(unsigned))
+    {
+        unsigned payloadSize = file.ReadUInt();
+        unsigned numRecords = file.ReadUInt();
+        if (payloadSize > file.GetSize() - file.GetPosition())
+        {
+            URHO3D_LOGWARNING("Ignoring incompletely written delta record in " + file.GetName());
+            break;
+        }
+
+        VectorBuffer payload(file, payloadSize);
+        for (unsigned i = 0; i < numRecords; ++i)
+        {
+            if (!ReadRecord(payload, record))
+            {
+                URHO3D_LOGERROR("Corrupt record in scene save log " + file.GetName());
+                return false;
+            }
+            MergeRecord(record, nodes, components);
+        }
+    }
+
+    return true;
+}
+
+/// Return the keys of a record map in ascending order.
+static PODVector<unsigned> GetSortedIDs(const HashMap<unsigned, SceneSaveRecord>& records)
+{
+    PODVector<unsigned> ids;
+    ids.Reserve(records.Size());
+    for (HashMap<unsigned, SceneSaveRecord>::ConstIterator i = records.Begin(); i != records.End(); ++i)
+        ids.Push(i->first_);
+    Sort(ids.Begin(), ids.End());
+    return ids;
+}
+
+/// Background thread that encodes and writes the batches of a scene save log in order.
+class SceneSaveLogThread : public RefCounted, public Thread
+{
+public:
+    /// Construct.
+    SceneSaveLogThread(Context* context, const String& fileName) :
+        context_(context),
+        fileName_(fileName)
+    {
+    }
+
+    /// Process queued batches until stopped.
+    void ThreadFunction() override
+    {
+        while (shouldRun_)
+        {
+            SharedPtr<SceneSaveBatch> batch;
+            {
+                MutexLock lock(queueMutex_);
+                if (!queue_.Empty())
+                    batch = queue_.Front();
+            }
+
+            if (!batch)
+            {
+                Time::Sleep(5);
+                continue;
+            }
+
+            if (batch->compact_)
+                Compact();
+            else
+                Write(*batch);
+
+            MutexLock lock(queueMutex_);
+            queue_.PopFront();
+        }
+    }
+
+    /// Queue a batch.
+    void Queue(SceneSaveBatch* batch)
+    {
+        MutexLock lock(queueMutex_);
+        queue_.Push(SharedPtr<SceneSaveBatch>(batch));
+    }
+
+    /// Return whether batches are queued or being processed.
+    bool IsBusy() const
+    {
+        MutexLock lock(queueMutex_);
+        return !queue_.Empty();
+    }
+
+    /// Wait until all queued batches have been processed.
+    void Flush()
+    {
+        while (IsStarted() && IsBusy())
+            Time::Sleep(1);
+    }
+
+private:
+    /// Write a snapshot or append a delta.
+    void Write(const SceneSaveBatch& batch)
+    {
+        File file(context_);
+        if (batch.snapshot_)
+        {
+            if (!file.Open(fileName_, FILE_WRITE) || !file.WriteFileID("USLG"))
+            {
+                URHO3D_LOGERROR("Could not create scene save log " + fileName_);
+                return;
+            }
+        }
+        else
+        {
+            if (!file.Open(fileName_, FILE_READWRITE))
+            {
+                URHO3D_LOGERROR("Could not open scene save log " + fileName_);
+                return;
+            }
+            file.Seek(file.GetSize());
+        }
+
+        if (!WriteBatch(file, batch.records_))
+            URHO3D_LOGERROR("Could not write to scene save log " + fileName_);
+    }
+
+    /// Rewrite the log as a single snapshot.
+    void Compact()
+    {
+        HashMap<unsigned, SceneSaveRecord> nodes;
+        HashMap<unsigned, SceneSaveRecord> components;
+        {
+            File file(context_);
+            if (!file.Open(fileName_, FILE_READ) || !ReadLog(file, nodes, components))
+                return;
+        }
+
+        Vector<SceneSaveRecord> records;
+        records.Reserve(nodes.Size() + components.Size());
+        PODVector<unsigned> ids = GetSortedIDs(nodes);
+        for (unsigned i = 0; i < ids.Size(); ++i)
+        {
+            records.Resize(records.Size() + 1);
+            Swap(records.Back(), nodes[ids[i]]);
+        }
+        ids = GetSortedIDs(components);
+        for (unsigned i = 0; i < ids.Size(); ++i)
+        {
+            // Drop components whose node no longer exists
+            SceneSaveRecord& record = components[ids[i]];
+            if (!nodes.Contains(record.ownerID_))
+                continue;
+            records.Resize(records.Size() + 1);
+            Swap(records.Back(), record);
+        }
+
+        // Write to a temporary file first, so that the old log stays valid if writing fails
+        String tempFileName = fileName_ + ".tmp";
+        {
+            File file(context_);
+            if (!file.Open(tempFileName, FILE_WRITE) || !file.WriteFileID("USLG") || !WriteBatch(file, records))
+            {
+                URHO3D_LOGERROR("Could not write compacted scene save log " + tempFileName);
+                return;
+            }
+        }
+
+        auto* fileSystem = context_->GetSubsystem<FileSystem>();
+        if (!fileSystem->Delete(fileName_) || !fileSystem->Rename(tempFileName, fileName_))
+            URHO3D_LOGERROR("Could not replace scene save log " + fileName_ + " with the compacted log");
+    }
+
+    /// Execution context.
+    Context* context_;
+    /// Log file name.
+    String fileName_;
+    /// Queued batches. The front batch stays queued while being processed.
+    List<SharedPtr<SceneSaveBatch> > queue_;
+    /// Mutex for the queue.
+    mutable Mutex queueMutex_;
+};
+
+SceneSaveLog::SceneSaveLog(Context* context) :
+    Object(context),
+    autoSaveInterval_(0.0f),
+    autoSaveTimer_(0.0f),
+    compactInterval_(16),
+    numDeltas_(0)
+{
+}
+
+SceneSaveLog::~SceneSaveLog()
+{
+    Close();
+}
+
+bool SceneSaveLog::Open(Scene* scene, const String& fileName)
+{
+    if (!scene)
+    {
+        URHO3D_LOGERROR("Null scene for scene save log");
+        return false;
+    }
+
+    Close();
+
+    URHO3D_PROFILE(SnapshotScene);
+
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    if (fileSystem && !fileSystem->CheckAccess(GetPath(fileName)))
+    {
+        URHO3D_LOGERROR("Access denied to " + fileName);
+        return false;
+    }
+
+    thread_ = new SceneSaveLogThread(context_, fileName);
+    if (!thread_->Run())
+    {
+        URHO3D_LOGERROR("Could not start scene save log thread");
+        thread_.Reset();
+        return false;
+    }
+
+    scene_ = scene;
+    fileName_ = fileName;
+    numDeltas_ = 0;
+    autoSaveTimer_ = 0.0f;
+
+    // Start recording changes now, so that nothing changed after the snapshot is missed
+    scene->SetChangeTracking(false);
+    scene->SetChangeTracking(true);
+
+    // The snapshot is the scene and all persistent nodes and components
+    SharedPtr<SceneSaveBatch> batch(new SceneSaveBatch());
+    batch->snapshot_ = true;
+    PODVector<Node*> nodes;
+    nodes.Push(scene);
+    for (unsigned i = 0; i < nodes.Size(); ++i)
+    {
+        Node* node = nodes[i];
+        AddNode(*batch, node);
+
+        const Vector<SharedPtr<Component> >& components = node->GetComponents();
+        for (unsigned j = 0; j < components.Size(); ++j)
+        {
+            if (!components[j]->IsTemporary())
+                AddComponent(*batch, components[j]);
+        }
+
+        const Vector<SharedPtr<Node> >& children = node->GetChildren();
+        for (unsigned j = 0; j < children.Size(); ++j)
+        {
+            if (!children[j]->IsTemporary())
+                nodes.Push(children[j]);
+        }
+    }
+
+    thread_->Queue(batch);
+
+    if (autoSaveInterval_ > 0.0f)
+        SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(SceneSaveLog, HandleSceneUpdate));
+
+    return true;
+}
+
+void SceneSaveLog::Close()
+{
+    if (thread_)
+    {
+        thread_->Flush();
+        thread_->Stop();
+        thread_.Reset();
+    }
+
+    Scene* scene = GetScene();
+    if (scene)
+    {
+        UnsubscribeFromEvent(scene, E_SCENEUPDATE);
+        scene->SetChangeTracking(false);
+    }
+
+    scene_.Reset();
+    numDeltas_ = 0;
+}
+
+bool SceneSaveLog::Save()
+{
+    Scene* scene = GetScene();
+    if (!scene || !thread_)
+        return false;
+
+    URHO3D_PROFILE(SaveSceneDelta);
+
+    PODVector<unsigned> nodeIDs, componentIDs, removedNodeIDs, removedComponentIDs;
+    scene->TakeSaveChanges(nodeIDs, componentIDs, removedNodeIDs, removedComponentIDs);
+    if (nodeIDs.Empty() && componentIDs.Empty() && removedNodeIDs.Empty() && removedComponentIDs.Empty())
+        return false;
+
+    SharedPtr<SceneSaveBatch> batch(new SceneSaveBatch());
+    Vector<SceneSaveRecord>& records = batch->records_;
+    records.Reserve(nodeIDs.Size() + componentIDs.Size() + removedNodeIDs.Size() + removedComponentIDs.Size());
+
+    // Removals go first, so that a node or component removed and then added back with the same ID is present after merging
+    for (unsigned i = 0; i < removedComponentIDs.Size(); ++i)
+    {
+        records.Resize(records.Size() + 1);
+        records.Back().type_ = SSR_REMOVECOMPONENT;
+        records.Back().id_ = removedComponentIDs[i];
+    }
+    for (unsigned i = 0; i < removedNodeIDs.Size(); ++i)
+    {
+        records.Resize(records.Size() + 1);
+        records.Back().type_ = SSR_REMOVENODE;
+        records.Back().id_ = removedNodeIDs[i];
+    }
+
+    // Nodes and components that have become temporary are no longer saved
+    for (unsigned i = 0; i < nodeIDs.Size(); ++i)
+    {
+        Node* node = scene->GetNode(nodeIDs[i]);
+        if (!IsTemporary(node))
+            AddNode(*batch, node);
+        else
+        {
+            records.Resize(records.Size() + 1);
+            records.Back().type_ = SSR_REMOVENODE;
+            records.Back().id_ = nodeIDs[i];
+        }
+    }
+    for (unsigned i = 0; i < componentIDs.Size(); ++i)
+    {
+        Component* component = scene->GetComponent(componentIDs[i]);
+        if (!component->IsTemporary() && !IsTemporary(component->GetNode()))
+            AddComponent(*batch, component);
+        else
+        {
+            records.Resize(records.Size() + 1);
+            records.Back().type_ = SSR_REMOVECOMPONENT;
+            records.Back().id_ = componentIDs[i];
+        }
+    }
+
+    thread_->Queue(batch);
+    ++numDeltas_;
+
+    if (compactInterval_ && numDeltas_ >= compactInterval_)
+        Compact();
+
+    return true;
+}
+
+void SceneSaveLog::Compact()
+{
+    if (!thread_)
+        return;
+
+    SharedPtr<SceneSaveBatch> batch(new SceneSaveBatch());
+    batch->compact_ = true;
+    thread_->Queue(batch);
+    numDeltas_ = 0;
+}
+
+void SceneSaveLog::Flush()
+{
+    if (thread_)
+        thread_->Flush();
+}
+
+bool SceneSaveLog::Load(Scene* scene, const String& fileName)
+{
+    if (!scene)
+    {
+        URHO3D_LOGERROR("Null scene for loading scene save log");
+        return false;
+    }
+
+    URHO3D_PROFILE(LoadSceneSaveLog);
+
+    // Make sure an open log has been written completely before reading it
+    if (fileName == fileName_)
+        Flush();
+
+    HashMap<unsigned, SceneSaveRecord> nodes;
+    HashMap<unsigned, SceneSaveRecord> components;
+    {
+        // A crash while replacing the log with the compacted log may have left only the compacted log
+        auto* fileSystem = GetSubsystem<FileSystem>();
+        String logFileName = fileName;
+        if (fileSystem && !fileSystem->FileExists(fileName) && fileSystem->FileExists(fileName + ".tmp"))
+            logFileName = fileName + ".tmp";
+
+        File file(context_);
+        if (!file.Open(logFileName, FILE_READ) || !ReadLog(file, nodes, components))
+            return false;
+    }
+
+    // Find the scene's own record
+    SceneSaveRecord* sceneRecord = nullptr;
+    HashMap<unsigned, PODVector<unsigned> > childIDs;
+    PODVector<unsigned> nodeIDs = GetSortedIDs(nodes);
+    for (unsigned i = 0; i < nodeIDs.Size(); ++i)
+    {
+        SceneSaveRecord& record = nodes[nodeIDs[i]];
+        if (!record.ownerID_)
+            sceneRecord = &record;
+        else
+            childIDs[record.ownerID_].Push(record.id_);
+    }
+    if (!sceneRecord)
+    {
+        URHO3D_LOGERROR("No scene in scene save log " + fileName);
+        return false;
+    }
+
+    // Do not record the load as changes
+    bool changeTracking = scene->GetChangeTracking();
+    scene->SetChangeTracking(false);
+    scene->Clear();
+
+    PODVector<Pair<unsigned, Node*> > parents;
+    HashSet<unsigned> created;
+    parents.Push(MakePair(sceneRecord->id_, (Node*)scene));
+    created.Insert(sceneRecord->id_);
+    nodeIDs.Insert(0, sceneRecord->id_);
+
+    for (unsigned i = 0; i < nodeIDs.Size(); ++i)
+    {
+        // Nodes whose parent is missing are added to the scene root
+        if (!created.Contains(nodeIDs[i]))
+        {
+            URHO3D_LOGWARNING("Parent of node " + String(nodeIDs[i]) + " not found in scene save log, adding to scene root");
+            Node* node = scene->CreateChild(nodeIDs[i], Scene::IsReplicatedID(nodeIDs[i]) ? REPLICATED : LOCAL);
+            parents.Push(MakePair(nodeIDs[i], node));
+            created.Insert(nodeIDs[i]);
+        }
+
+        // Create the children of the nodes created so far breadth-first
+        while (!parents.Empty())
+        {
+            Pair<unsigned, Node*> parent = parents.Back();
+            parents.Pop();
+
+            const SceneSaveRecord& record = nodes[parent.first_];
+            for (unsigned j = 0; j < record.attributeValues_.Size(); ++j)
+            {
+                const PODVector<StringHash>& names = GetAttributeNames(parent.second_);
+                unsigned index = names.IndexOf(record.attributeNames_[j]);
+                if (index < names.Size())
+                    parent.second_->SetAttribute(index, record.attributeValues_[j]);
+            }
+
+            HashMap<unsigned, PODVector<unsigned> >::ConstIterator children = childIDs.Find(parent.first_);
+            if (children == childIDs.End())
+                continue;
+            for (unsigned j = 0; j < children->second_.Size(); ++j)
+            {
+                unsigned id = children->second_[j];
+                if (created.Contains(id))
+                    continue;
+                Node* child = parent.second_->CreateChild(id, Scene::IsReplicatedID(id) ? REPLICATED : LOCAL);
+                parents.Push(MakePair(id, child));
+                created.Insert(id);
+            }
+        }
+    }
+
+    PODVector<unsigned> componentIDs = GetSortedIDs(components);
+    for (unsigned i = 0; i < componentIDs.Size(); ++i)
+    {
+        const SceneSaveRecord& record = components[componentIDs[i]];
+        Node* node = record.ownerID_ == sceneRecord->id_ ? scene : scene->GetNode(record.ownerID_);
+        if (!node)
+            continue;
+
+        Component* component = node->CreateComponent(record.componentType_, Scene::IsReplicatedID(record.id_) ? REPLICATED :
+            LOCAL, record.id_);
+        if (!component)
+            continue;
+
+        const PODVector<StringHash>& names = GetAttributeNames(component);
+        for (unsigned j = 0; j < record.attributeValues_.Size(); ++j)
+        {
+            unsigned index = names.IndexOf(record.attributeNames_[j]);
+            if (index < names.Size())
+                component->SetAttribute(index, record.attributeValues_[j]);
+        }
+    }
+
+    scene->ApplyAttributes();
+    scene->SetChangeTracking(changeTracking);
+    return true;
+}
+
+void SceneSaveLog::SetAutoSaveInterval(float interval)
+{
+    autoSaveInterval_ = Max(interval, 0.0f);
+    autoSaveTimer_ = 0.0f;
+
+    Scene* scene = GetScene();
+    if (scene)
+    {
+        if (autoSaveInterval_ > 0.0f)
+            SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(SceneSaveLog, HandleSceneUpdate));
+        else
+            UnsubscribeFromEvent(scene, E_SCENEUPDATE);
+    }
+}
+
+Scene* SceneSaveLog::GetScene() const
+{
+    return scene_;
+}
+
+bool SceneSaveLog::IsBusy() const
+{
+    return thread_ && thread_->IsBusy();
+}
+
+void SceneSaveLog::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+{
+    using namespace SceneUpdate;
+
+    autoSaveTimer_ += eventData[P_TIMESTEP].GetFloat();
+    if (autoSaveTimer_ >= autoSaveInterval_)
+    {
+        autoSaveTimer_ = 0.0f;
+        Save();
+    }
+}
+
+void SceneSaveLog::AddNode(SceneSaveBatch& batch, Node* node)
+{
+    batch.records_.Resize(batch.records_.Size() + 1);
+    SceneSaveRecord& record = batch.records_.Back();
+    record.type_ = SSR_NODE;
+    record.id_ = node->GetID();
+    record.ownerID_ = node->GetParent() ? node->GetParent()->GetID() : 0;
+
+    const PODVector<StringHash>& names = GetAttributeNames(node);
+    for (unsigned i = 0; i < names.Size(); ++i)
+    {
+        if (names[i] == StringHash::ZERO)
+            continue;
+        record.attributeNames_.Push(names[i]);
+        record.attributeValues_.Push(node->GetAttribute(i));
+    }
+}
+
+void SceneSaveLog::AddComponent(SceneSaveBatch& batch, Component* component)
+{
+    batch.records_.Resize(batch.records_.Size() + 1);
+    SceneSaveRecord& record = batch.records_.Back();
+    record.type_ = SSR_COMPONENT;
+    record.id_ = component->GetID();
+    record.ownerID_ = component->GetNode()->GetID();
+    record.componentType_ = component->GetType();
+
+    const PODVector<StringHash>& names = GetAttributeNames(component);
+    for (unsigned i = 0; i < names.Size(); ++i)
+    {
+        if (names[i] == StringHash::ZERO)
+            continue;
+        record.attributeNames_.Push(names[i]);
+        record.attributeValues_.Push(component->GetAttribute(i));
+    }
+}
+
+bool SceneSaveLog::IsTemporary(Node* node) const
+{
+    while (node)
+    {
+        if (node->IsTemporary())
+            return true;
+        node = node->GetParent();
+    }
+    return false;
+}
+
+const PODVector<StringHash>& SceneSaveLog::GetAttributeNames(const Serializable* object)
+{
+    static const PODVector<StringHash> noNames;
+
+    const Vector<AttributeInfo>* attributes = object->GetAttributes();
+    if (!attributes)
+        return noNames;
+
+    // Attribute lists are shared by all objects of a type, so hash the names only once per list
+    PODVector<StringHash>& names = attributeNames_[attributes];
+    if (names.Size() != attributes->Size())
+    {
+        names.Resize(attributes->Size());
+        for (unsigned i = 0; i < attributes->Size(); ++i)
+        {
+            const AttributeInfo& attr = attributes->At(i);
+            // Pointers can not be saved, and copying them would touch reference counts from the writer thread
+            bool saved = (attr.mode_ & AM_FILE) && (attr.mode_ & AM_FILEREADONLY) != AM_FILEREADONLY &&
+                attr.type_ != VAR_VOIDPTR && attr.type_ != VAR_PTR && attr.type_ != VAR_CUSTOM_HEAP &&
+                attr.type_ != VAR_CUSTOM_STACK;
+            names[i] = saved ? StringHash(attr.name_) : StringHash::ZERO;
+        }
+    }
+
+    return names;
+}
+
+}
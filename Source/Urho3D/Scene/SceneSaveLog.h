@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Object.h"
+
+namespace Urho3D
+{
+
+class Component;
+class Node;
+class Scene;
+class SceneSaveLogThread;
+class Serializable;
+struct SceneSaveBatch;
+
+/// Incremental scene save log. Records the nodes and components changed since the previous save as a delta record appended to a log file, and periodically compacts the deltas into a single snapshot. The changed objects are copied in the main thread and encoded and written in a background thread.
+class URHO3D_API SceneSaveLog : public Object
+{
+    URHO3D_OBJECT(SceneSaveLog, Object);
+
+public:
+    /// Construct.
+    explicit SceneSaveLog(Context* context);
+    /// Destruct. Wait for pending writes.
+    ~SceneSaveLog() override;
+
+    /// Start logging a scene into a file. Enables change tracking on the scene and writes a full snapshot, replacing the file. Return true if successful.
+    bool Open(Scene* scene, const String& fileName);
+    /// Stop logging. Waits for pending writes and disables change tracking on the scene.
+    void Close();
+    /// Write the changes recorded since the previous save as a delta record. The changed objects are copied now and written in the background. Return true if there were changes.
+    bool Save();
+    /// Merge the snapshot and all delta records into a new snapshot in the background.
+    void Compact();
+    /// Wait until all pending writes have finished.
+    void Flush();
+    /// Load a scene from a log file, applying the snapshot and all complete delta records. Any existing content of the scene is removed. Return true if successful.
+    bool Load(Scene* scene, const String& fileName);
+
+    /// Set interval in seconds of scene time for saving automatically on scene update. Zero (default) saves only when Save() is called.
+    /// @property
+    void SetAutoSaveInterval(float interval);
+    /// Set number of delta records after which the log is compacted automatically. Zero disables. Default 16.
+    /// @property
+    void SetCompactInterval(unsigned deltas) { compactInterval_ = deltas; }
+
+    /// Return the logged scene.
+    /// @property
+    Scene* GetScene() const;
+    /// Return the log file name.
+    /// @property
+    const String& GetFileName() const { return fileName_; }
+    /// Return whether a scene is being logged.
+    /// @property
+    bool IsOpen() const { return GetScene() != nullptr; }
+    /// Return automatic save interval.
+    /// @property
+    float GetAutoSaveInterval() const { return autoSaveInterval_; }
+    /// Return number of delta records after which the log is compacted automatically.
+    /// @property
+    unsigned GetCompactInterval() const { return compactInterval_; }
+    /// Return number of delta records written since the last snapshot.
+    /// @property
+    unsigned GetNumDeltas() const { return numDeltas_; }
+    /// Return whether writes are pending in the background.
+    /// @property
+    bool IsBusy() const;
+
+private:
+    /// Handle scene update to save automatically.
+    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
+    /// Copy a node into a batch.
+    void AddNode(SceneSaveBatch& batch, Node* node);
+    /// Copy a component into a batch.
+    void AddComponent(SceneSaveBatch& batch, Component* component);
+    /// Return whether a node or any of its parents is temporary.
+    bool IsTemporary(Node* node) const;
+    /// Return name hashes of the saved attributes of an object.
+    const PODVector<StringHash>& GetAttributeNames(const Serializable* object);
+
+    /// Logged scene.
+    WeakPtr<Scene> scene_;
+    /// Log file name.
+    String fileName_;
+    /// Background writer thread.
+    SharedPtr<SceneSaveLogThread> thread_;
+    /// Attribute name hashes by attribute list.
+    HashMap<const void*, PODVector<StringHash> > attributeNames_;
+    /// Automatic save interval.
+    float autoSaveInterval_;
+    /// Scene time since the last automatic save.
+    float autoSaveTimer_;
+    /// Automatic compaction interval in delta records.
+    unsigned compactInterval_;
+    /// Delta records written since the last snapshot.
+    unsigned numDeltas_;
+};
+
+}
@@ -0,0 +1,415 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Core/Timer.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../Resource/ResourceCache.h"
+#include "../Resource/ResourceEvents.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+#include "../Scene/SceneStreamer.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+static const float DEFAULT_CELL_SIZE = 100.0f;
+static const float DEFAULT_LOAD_DISTANCE = 200.0f;
+static const float DEFAULT_UNLOAD_DISTANCE = 250.0f;
+static const int DEFAULT_MAX_INSTANTIATION_MS = 5;
+
+extern const char* SUBSYSTEM_CATEGORY;
+
+/// Return the file name of a cell without the directory.
+static String GetCellName(const IntVector2& cell)
+{
+    return "Cell_" + String(cell.x_) + "_" + String(cell.y_) + ".bin";
+}
+
+SceneStreamer::SceneStreamer(Context* context) :
+    Component(context),
+    focusPosition_(Vector3::ZERO),
+    cellSize_(DEFAULT_CELL_SIZE),
+    loadDistance_(DEFAULT_LOAD_DISTANCE),
+    unloadDistance_(DEFAULT_UNLOAD_DISTANCE),
+    maxInstantiationMs_(DEFAULT_MAX_INSTANTIATION_MS),
+    subscribed_(false)
+{
+}
+
+SceneStreamer::~SceneStreamer()
+{
+    UnloadAllCells();
+}
+
+void SceneStreamer::RegisterObject(Context* context)
+{
+    context->RegisterFactory<SceneStreamer>(SUBSYSTEM_CATEGORY);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cell Size", GetCellSize, SetCellSize, float, DEFAULT_CELL_SIZE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Load Distance", GetLoadDistance, SetLoadDistance, float, DEFAULT_LOAD_DISTANCE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Unload Distance", GetUnloadDistance, SetUnloadDistance, float, DEFAULT_UNLOAD_DISTANCE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cell Directory", GetCellDirectory, SetCellDirectory, String, String::EMPTY, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Instantiation Ms", GetMaxInstantiationMs, SetMaxInstantiationMs, int, DEFAULT_MAX_INSTANTIATION_MS,
+        AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Focus Position", GetFocusPosition, SetFocusPosition, Vector3, Vector3::ZERO, AM_DEFAULT);
+}
+
+void SceneStreamer::OnSetEnabled()
+{
+    UpdateEventSubscription();
+}
+
+void SceneStreamer::SetCellSize(float size)
+{
+    size = Max(size, M_EPSILON);
+    if (size != cellSize_)
+    {
+        // The resident cells no longer match the grid, so start over
+        UnloadAllCells();
+        cellSize_ = size;
+        MarkNetworkUpdate();
+    }
+}
+
+void SceneStreamer::SetLoadDistance(float distance)
+{
+    loadDistance_ = Max(distance, 0.0f);
+    MarkNetworkUpdate();
+}
+
+void SceneStreamer::SetUnloadDistance(float distance)
+{
+    unloadDistance_ = Max(distance, 0.0f);
+    MarkNetworkUpdate();
+}
+
+void SceneStreamer::SetCellDirectory(const String& directory)
+{
+    String newDirectory = directory.Empty() ? directory : AddTrailingSlash(directory);
+    if (newDirectory != cellDirectory_)
+    {
+        UnloadAllCells();
+        cellDirectory_ = newDirectory;
+        MarkNetworkUpdate();
+    }
+}
+
+void SceneStreamer::SetMaxInstantiationMs(int ms)
+{
+    maxInstantiationMs_ = Max(ms, 1);
+    MarkNetworkUpdate();
+}
+
+void SceneStreamer::SetFocusNode(Node* node)
+{
+    focusNode_ = node;
+}
+
+void SceneStreamer::SetFocusPosition(const Vector3& position)
+{
+    focusPosition_ = position;
+    MarkNetworkUpdate();
+}
+
+void SceneStreamer::UnloadAllCells()
+{
+    for (HashMap<IntVector2, StreamingCell>::Iterator i = cells_.Begin(); i != cells_.End(); ++i)
+        UnloadCell(i->second_);
+    cells_.Clear();
+}
+
+bool SceneStreamer::SaveCells(const String& directory) const
+{
+    Scene* scene = GetScene();
+    if (!scene)
+    {
+        URHO3D_LOGERROR("Can not save scene cells without a scene");
+        return false;
+    }
+
+    String path = AddTrailingSlash(directory);
+    if (!GetSubsystem<FileSystem>()->CreateDir(path))
+    {
+        URHO3D_LOGERROR("Could not create scene cell directory " + path);
+        return false;
+    }
+
+    // Group the root level nodes by the cell their world position falls into
+    HashMap<IntVector2, PODVector<Node*> > cellNodes;
+    const Vector<SharedPtr<Node> >& children = scene->GetChildren();
+    for (Vector<SharedPtr<Node> >::ConstIterator i = children.Begin(); i != children.End(); ++i)
+    {
+        Node* node = *i;
+        if (!node->IsTemporary())
+            cellNodes[GetCell(node->GetWorldPosition())].Push(node);
+    }
+
+    for (HashMap<IntVector2, PODVector<Node*> >::ConstIterator i = cellNodes.Begin(); i != cellNodes.End(); ++i)
+    {
+        File file(context_, path + GetCellName(i->first_), FILE_WRITE);
+        if (!file.IsOpen())
+            return false;
+
+        file.WriteFileID("UCEL");
+        file.WriteVLE(i->second_.Size());
+        for (PODVector<Node*>::ConstIterator j = i->second_.Begin(); j != i->second_.End(); ++j)
+        {
+            if (!(*j)->Save(file))
+            {
+                URHO3D_LOGERROR("Could not save node to scene cell file " + file.GetName());
+                return false;
+            }
+        }
+    }
+
+    URHO3D_LOGINFO("Saved " + String(cellNodes.Size()) + " scene cells to " + path);
+    return true;
+}
+
+Vector3 SceneStreamer::GetFocusPosition() const
+{
+    return focusNode_ ? focusNode_->GetWorldPosition() : focusPosition_;
+}
+
+unsigned SceneStreamer::GetNumLoadedCells() const
+{
+    unsigned numLoaded = 0;
+    for (HashMap<IntVector2, StreamingCell>::ConstIterator i = cells_.Begin(); i != cells_.End(); ++i)
+    {
+        if (i->second_.state_ == CELL_LOADED)
+            ++numLoaded;
+    }
+    return numLoaded;
+}
+
+StreamingCellState SceneStreamer::GetCellState(const IntVector2& cell) const
+{
+    HashMap<IntVector2, StreamingCell>::ConstIterator i = cells_.Find(cell);
+    return i != cells_.End() ? i->second_.state_ : CELL_EMPTY;
+}
+
+Node* SceneStreamer::GetCellNode(const IntVector2& cell) const
+{
+    HashMap<IntVector2, StreamingCell>::ConstIterator i = cells_.Find(cell);
+    return i != cells_.End() ? i->second_.node_.Get() : nullptr;
+}
+
+IntVector2 SceneStreamer::GetCell(const Vector3& position) const
+{
+    return IntVector2(FloorToInt(position.x_ / cellSize_), FloorToInt(position.z_ / cellSize_));
+}
+
+String SceneStreamer::GetCellFileName(const IntVector2& cell) const
+{
+    return cellDirectory_ + GetCellName(cell);
+}
+
+void SceneStreamer::OnSceneSet(Scene* scene)
+{
+    if (!scene)
+    {
+        UnloadAllCells();
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+        UnsubscribeFromEvent(E_RESOURCEBACKGROUNDLOADED);
+        subscribed_ = false;
+    }
+    else
+        UpdateEventSubscription();
+}
+
+void SceneStreamer::UpdateEventSubscription()
+{
+    Scene* scene = GetScene();
+    if (!scene)
+        return;
+
+    bool enabled = IsEnabledEffective();
+
+    if (enabled && !subscribed_)
+    {
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(SceneStreamer, HandleScenePostUpdate));
+        SubscribeToEvent(E_RESOURCEBACKGROUNDLOADED, URHO3D_HANDLER(SceneStreamer, HandleResourceBackgroundLoaded));
+        subscribed_ = true;
+    }
+    else if (!enabled && subscribed_)
+    {
+        // Keep the resident cells, but do not stream while disabled
+        UnsubscribeFromEvent(scene, E_SCENEPOSTUPDATE);
+        UnsubscribeFromEvent(E_RESOURCEBACKGROUNDLOADED);
+        subscribed_ = false;
+    }
+}
+
+void SceneStreamer::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    URHO3D_PROFILE(UpdateSceneStreaming);
+
+    Vector3 focus = GetFocusPosition();
+
+    // Unload the cells that are beyond the unload distance, including ones that are still loading. Also forget cells
+    // whose content was removed from outside, for example by clearing the scene, so that they load again
+    for (HashMap<IntVector2, StreamingCell>::Iterator i = cells_.Begin(); i != cells_.End();)
+    {
+        const StreamingCell& cell = i->second_;
+        if (GetCellDistance(i->first_, focus) > unloadDistance_ || (cell.state_ != CELL_EMPTY && !cell.node_))
+        {
+            UnloadCell(i->second_);
+            i = cells_.Erase(i);
+        }
+        else
+            ++i;
+    }
+
+    // Begin loading the cells within the load distance that are not resident yet
+    IntVector2 minCell = GetCell(focus - Vector3(loadDistance_, 0.0f, loadDistance_));
+    IntVector2 maxCell = GetCell(focus + Vector3(loadDistance_, 0.0f, loadDistance_));
+    for (int y = minCell.y_; y <= maxCell.y_; ++y)
+    {
+        for (int x = minCell.x_; x <= maxCell.x_; ++x)
+        {
+            IntVector2 cell(x, y);
+            if (!cells_.Contains(cell) && GetCellDistance(cell, focus) <= loadDistance_)
+                BeginLoadCell(cell);
+        }
+    }
+
+    InstantiateCells();
+}
+
+void SceneStreamer::HandleResourceBackgroundLoaded(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ResourceBackgroundLoaded;
+
+    auto* resource = static_cast<Resource*>(eventData[P_RESOURCE].GetPtr());
+    StringHash nameHash = resource->GetNameHash();
+
+    for (HashMap<IntVector2, StreamingCell>::Iterator i = cells_.Begin(); i != cells_.End(); ++i)
+    {
+        StreamingCell& cell = i->second_;
+        if (cell.state_ == CELL_PRELOADING && cell.resources_.Erase(nameHash) && cell.resources_.Empty())
+            cell.state_ = CELL_INSTANTIATING;
+    }
+}
+
+void SceneStreamer::BeginLoadCell(const IntVector2& cell)
+{
+    StreamingCell& newCell = cells_[cell];
+
+    // Cells without a file are remembered as empty so that the file is not looked up again while in range
+    auto* cache = GetSubsystem<ResourceCache>();
+    String fileName = GetCellFileName(cell);
+    if (!cache->Exists(fileName))
+    {
+        newCell.state_ = CELL_EMPTY;
+        return;
+    }
+
+    newCell.file_ = cache->GetFile(fileName);
+    if (!newCell.file_ || newCell.file_->ReadFileID() != "UCEL")
+    {
+        URHO3D_LOGERROR(fileName + " is not a valid scene cell file");
+        newCell.file_.Reset();
+        newCell.state_ = CELL_EMPTY;
+        return;
+    }
+
+    newCell.numNodes_ = newCell.file_->ReadVLE();
+
+    // Queue the resources of all cell nodes for background loading, then return to the first node
+    Scene* scene = GetScene();
+    unsigned currentPos = newCell.file_->GetPosition();
+    for (unsigned i = 0; i < newCell.numNodes_; ++i)
+        scene->PreloadResources(*newCell.file_, newCell.resources_);
+    newCell.file_->Seek(currentPos);
+
+    // The cell content goes under a temporary root node, so that it is not saved with the scene and can be removed
+    // at once on unload
+    newCell.node_ = scene->CreateChild("Cell " + String(cell.x_) + " " + String(cell.y_), LOCAL, 0, true);
+    newCell.state_ = newCell.resources_.Empty() ? CELL_INSTANTIATING : CELL_PRELOADING;
+}
+
+void SceneStreamer::UnloadCell(StreamingCell& cell)
+{
+    if (cell.node_)
+        cell.node_->Remove();
+    cell.node_.Reset();
+    cell.file_.Reset();
+    cell.resources_.Clear();
+}
+
+void SceneStreamer::InstantiateCells()
+{
+    HiresTimer instantiationTimer;
+
+    for (HashMap<IntVector2, StreamingCell>::Iterator i = cells_.Begin(); i != cells_.End(); ++i)
+    {
+        StreamingCell& cell = i->second_;
+        if (cell.state_ != CELL_INSTANTIATING)
+            continue;
+
+        while (cell.loadedNodes_ < cell.numNodes_)
+        {
+            // Rewrite IDs like when instantiating, as the cell content may be loaded any number of times
+            unsigned nodeID = cell.file_->ReadUInt();
+            Node* newNode = cell.node_->CreateChild(0, LOCAL);
+            cell.resolver_.AddNode(nodeID, newNode);
+            if (!newNode->Load(*cell.file_, cell.resolver_, true, true, LOCAL))
+            {
+                URHO3D_LOGERROR("Could not load node from scene cell file " + cell.file_->GetName());
+                newNode->Remove();
+                cell.loadedNodes_ = cell.numNodes_;
+                break;
+            }
+
+            ++cell.loadedNodes_;
+
+            // Break if time limit exceeded, so that we keep sufficient FPS
+            if (instantiationTimer.GetUSec(false) >= maxInstantiationMs_ * 1000LL)
+                return;
+        }
+
+        cell.resolver_.Resolve();
+        cell.node_->ApplyAttributes();
+        cell.file_.Reset();
+        cell.state_ = CELL_LOADED;
+    }
+}
+
+float SceneStreamer::GetCellDistance(const IntVector2& cell, const Vector3& position) const
+{
+    float minX = cell.x_ * cellSize_;
+    float minZ = cell.y_ * cellSize_;
+    float dx = Max(Max(minX - position.x_, position.x_ - (minX + cellSize_)), 0.0f);
+    float dz = Max(Max(minZ - position.z_, position.z_ - (minZ + cellSize_)), 0.0f);
+    return sqrtf(dx * dx + dz * dz);
+}
+
+}
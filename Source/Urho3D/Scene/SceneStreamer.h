@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2008-2022 the Urho3D project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/HashSet.h"
+#include "../IO/File.h"
+#include "../Math/Vector2.h"
+#include "../Scene/Component.h"
+#include "../Scene/SceneResolver.h"
+
+namespace Urho3D
+{
+
+/// Streaming state of a scene cell.
+enum StreamingCellState
+{
+    /// Cell resources are being loaded in the background.
+    CELL_PRELOADING = 0,
+    /// Cell nodes are being instantiated.
+    CELL_INSTANTIATING,
+    /// Cell is fully loaded.
+    CELL_LOADED,
+    /// Cell has no content file.
+    CELL_EMPTY
+};
+
+/// Scene cell tracked by the streamer.
+struct StreamingCell
+{
+    /// Cell content file, open while the cell is loading.
+    SharedPtr<File> file_;
+    /// Root node of the cell content.
+    WeakPtr<Node> node_;
+    /// Node and component ID resolver for the cell content.
+    SceneResolver resolver_;
+    /// Resources that are still loading in the background.
+    HashSet<StringHash> resources_;
+    /// Number of root nodes in the cell file.
+    unsigned numNodes_{};
+    /// Number of root nodes instantiated so far.
+    unsigned loadedNodes_{};
+    /// Streaming state.
+    StreamingCellState state_{CELL_PRELOADING};
+};
+
+/// %Scene component that streams a scene partitioned into a grid of cells on the XZ plane. Cells around the focus position are loaded from separate binary files, with their resources preloaded in the background and their nodes instantiated within a time budget. Cells far away from the focus position are unloaded.
+class URHO3D_API SceneStreamer : public Component
+{
+    URHO3D_OBJECT(SceneStreamer, Component);
+
+public:
+    /// Construct.
+    explicit SceneStreamer(Context* context);
+    /// Destruct.
+    ~SceneStreamer() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Handle enabled/disabled state change.
+    void OnSetEnabled() override;
+
+    /// Set cell size in world units.
+    /// @property
+    void SetCellSize(float size);
+    /// Set distance from the focus position within which cells are loaded.
+    /// @property
+    void SetLoadDistance(float distance);
+    /// Set distance from the focus position beyond which cells are unloaded. Should be larger than the load distance to avoid cells being loaded and unloaded repeatedly.
+    /// @property
+    void SetUnloadDistance(float distance);
+    /// Set resource directory of the cell files.
+    /// @property
+    void SetCellDirectory(const String& directory);
+    /// Set maximum milliseconds per frame to spend on instantiating cell nodes.
+    /// @property
+    void SetMaxInstantiationMs(int ms);
+    /// Set node whose world position is used as the focus position. If null, the focus position set directly is used.
+    /// @property
+    void SetFocusNode(Node* node);
+    /// Set focus position used when there is no focus node.
+    /// @property
+    void SetFocusPosition(const Vector3& position);
+    /// Unload all cells.
+    void UnloadAllCells();
+    /// Partition the persistent root level nodes of the scene into cells by their world position and save them as binary cell files into a directory. Does not modify the scene. Return true if successful.
+    bool SaveCells(const String& directory) const;
+
+    /// Return cell size.
+    /// @property
+    float GetCellSize() const { return cellSize_; }
+
+    /// Return load distance.
+    /// @property
+    float GetLoadDistance() const { return loadDistance_; }
+
+    /// Return unload distance.
+    /// @property
+    float GetUnloadDistance() const { return unloadDistance_; }
+
+    /// Return resource directory of the cell files.
+    /// @property
+    const String& GetCellDirectory() const { return cellDirectory_; }
+
+    /// Return maximum milliseconds per frame to spend on instantiating cell nodes.
+    /// @property
+    int GetMaxInstantiationMs() const { return maxInstantiationMs_; }
+
+    /// Return focus node.
+    /// @property
+    Node* GetFocusNode() const { return focusNode_; }
+
+    /// Return focus position, either from the focus node or the one set directly.
+    /// @property
+    Vector3 GetFocusPosition() const;
+
+    /// Return number of cells loaded or loading.
+    /// @property
+    unsigned GetNumCells() const { return cells_.Size(); }
+
+    /// Return number of fully loaded cells.
+    /// @property
+    unsigned GetNumLoadedCells() const;
+
+    /// Return the streaming state of a cell, or CELL_EMPTY if the cell is not resident.
+    StreamingCellState GetCellState(const IntVector2& cell) const;
+    /// Return the root node of a cell's content, or null if the cell is not resident.
+    Node* GetCellNode(const IntVector2& cell) const;
+    /// Return the cell that contains a world position.
+    IntVector2 GetCell(const Vector3& position) const;
+    /// Return the resource name of a cell's file.
+    String GetCellFileName(const IntVector2& cell) const;
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    /// Subscribe/unsubscribe to scene updates based on the current enabled state.
+    void UpdateEventSubscription();
+    /// Handle scene post-update event.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle a background loaded resource completing.
+    void HandleResourceBackgroundLoaded(StringHash eventType, VariantMap& eventData);
+    /// Begin loading a cell: open its file and queue its resources for background loading.
+    void BeginLoadCell(const IntVector2& cell);
+    /// Unload a cell and remove its content from the scene.
+    void UnloadCell(StreamingCell& cell);
+    /// Instantiate nodes of cells whose resources are loaded until the time budget is used up.
+    void InstantiateCells();
+    /// Return distance from a position to a cell on the XZ plane.
+    float GetCellDistance(const IntVector2& cell, const Vector3& position) const;
+
+    /// Resident cells.
+    HashMap<IntVector2, StreamingCell> cells_;
+    /// Focus node.
+    WeakPtr<Node> focusNode_;
+    /// Focus position used when there is no focus node.
+    Vector3 focusPosition_;
+    /// Resource directory of the cell files.
+    String cellDirectory_;
+    /// Cell size.
+    float cellSize_;
+    /// Load distance.
+    float loadDistance_;
+    /// Unload distance.
+    float unloadDistance_;
+    /// Maximum milliseconds per frame to spend on instantiating cell nodes.
+    int maxInstantiationMs_;
+    /// Subscribed to scene updates flag.
+    bool subscribed_;
+};
+
+}
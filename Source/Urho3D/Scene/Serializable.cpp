@@ -53,6 +53,267 @@ static unsigned RemapAttributeIndex(const Vector<AttributeInfo>* attributes, con
     return netAttrIndex; // Could not remap
 }
 
+/// Maximum bits per component in the quantized latest data.
+static const int MAX_QUANTIZE_BITS = 24;
+/// Bits of the index of the largest quaternion component, which is left out of the quantized quaternion.
+static const unsigned QUATERNION_INDEX_BITS = 2;
+/// Range of the three smallest components of a unit quaternion.
+static const float QUATERNION_COMPONENT_RANGE = 0.70710678f;
+
+/// Bit-packed writer for the quantized latest data.
+struct LatestDataBitWriter
+{
+    /// Construct.
+    explicit LatestDataBitWriter(Serializer& dest) :
+        dest_(dest)
+    {
+    }
+
+    /// Write the lowest bits of a value.
+    void Write(unsigned value, unsigned bits)
+    {
+        for (unsigned i = 0; i < bits; ++i)
+        {
+            if (value & (1u << i))
+                byte_ |= (unsigned char)(1u << numBits_);
+            if (++numBits_ == 8)
+                Flush();
+        }
+    }
+
+    /// Write the partially filled byte.
+    void Flush()
+    {
+        if (numBits_)
+        {
+            dest_.WriteUByte(byte_);
+            byte_ = 0;
+            numBits_ = 0;
+        }
+    }
+
+    /// Destination.
+    Serializer& dest_;
+    /// Partially filled byte.
+    unsigned char byte_{};
+    /// Number of bits in the partially filled byte.
+    unsigned numBits_{};
+};
+
+/// Bit-packed reader for the quantized latest data.
+struct LatestDataBitReader
+{
+    /// Construct.
+    explicit LatestDataBitReader(Deserializer& source) :
+        source_(source)
+    {
+    }
+
+    /// Read a value of the given number of bits.
+    unsigned Read(unsigned bits)
+    {
+        unsigned value = 0;
+        for (unsigned i = 0; i < bits; ++i)
+        {
+            if (!numBits_)
+            {
+                byte_ = source_.ReadUByte();
+                numBits_ = 8;
+            }
+            if (byte_ & 1u)
+                value |= 1u << i;
+            byte_ >>= 1u;
+            --numBits_;
+        }
+        return value;
+    }
+
+    /// Source.
+    Deserializer& source_;
+    /// Remaining bits of the current byte.
+    unsigned char byte_{};
+    /// Number of remaining bits in the current byte.
+    unsigned numBits_{};
+};
+
+/// Return the bits per component of a quantized latest data attribute and the number of components, or 0 if it is sent as a variant.
+static unsigned GetQuantizedComponents(const AttributeInfo& attr, unsigned& bits)
+{
+    if (!(attr.mode_ & AM_LATESTDATA))
+        return 0;
+
+    int quantizeBits = attr.GetMetadata(AttributeMetadata::P_QUANTIZE_BITS).GetInt();
+    if (quantizeBits <= 0 || quantizeBits > MAX_QUANTIZE_BITS)
+        return 0;
+    bits = (unsigned)quantizeBits;
+
+    if (attr.type_ == VAR_QUATERNION)
+        return 4;
+
+    // The other types need a valid range
+    if (attr.GetMetadata(AttributeMetadata::P_QUANTIZE_MAX).GetFloat() <= attr.GetMetadata(AttributeMetadata::P_QUANTIZE_MIN).GetFloat())
+        return 0;
+
+    switch (attr.type_)
+    {
+    case VAR_FLOAT:
+        return 1;
+
+    case VAR_VECTOR2:
+        return 2;
+
+    case VAR_VECTOR3:
+        return 3;
+
+    default:
+        return 0;
+    }
+}
+
+static unsigned QuantizeFloat(float value, float min, float max, unsigned bits)
+{
+    const unsigned maxValue = (1u << bits) - 1;
+    return (unsigned)RoundToInt(Clamp((value - min) / (max - min), 0.0f, 1.0f) * (float)maxValue);
+}
+
+static float DequantizeFloat(unsigned value, float min, float max, unsigned bits)
+{
+    const unsigned maxValue = (1u << bits) - 1;
+    return min + (max - min) * (float)Min(value, maxValue) / (float)maxValue;
+}
+
+/// Quantize an attribute value. Quaternions are stored as the index of the largest component and the three others.
+static void QuantizeValue(const AttributeInfo& attr, const Variant& value, unsigned bits, unsigned* dest)
+{
+    if (attr.type_ == VAR_QUATERNION)
+    {
+        Quaternion rotation = value.GetQuaternion().Normalized();
+        const float* data = rotation.Data();
+        unsigned largest = 0;
+        for (unsigned i = 1; i < 4; ++i)
+        {
+            if (Abs(data[i]) > Abs(data[largest]))
+                largest = i;
+        }
+
+        // The rotation does not change when negated, so the largest component is always restored as positive
+        const float sign = data[largest] < 0.0f ? -1.0f : 1.0f;
+        dest[0] = largest;
+        unsigned index = 1;
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            if (i != largest)
+                dest[index++] = QuantizeFloat(data[i] * sign, -QUATERNION_COMPONENT_RANGE, QUATERNION_COMPONENT_RANGE, bits);
+        }
+        return;
+    }
+
+    const float min = attr.GetMetadata(AttributeMetadata::P_QUANTIZE_MIN).GetFloat();
+    const float max = attr.GetMetadata(AttributeMetadata::P_QUANTIZE_MAX).GetFloat();
+    switch (attr.type_)
+    {
+    case VAR_FLOAT:
+        dest[0] = QuantizeFloat(value.GetFloat(), min, max, bits);
+        break;
+
+    case VAR_VECTOR2:
+        for (unsigned i = 0; i < 2; ++i)
+            dest[i] = QuantizeFloat(value.GetVector2().Data()[i], min, max, bits);
+        break;
+
+    default:
+        for (unsigned i = 0; i < 3; ++i)
+            dest[i] = QuantizeFloat(value.GetVector3().Data()[i], min, max, bits);
+        break;
+    }
+}
+
+/// Return an attribute value from its quantized components.
+static Variant DequantizeValue(const AttributeInfo& attr, const unsigned* values, unsigned bits)
+{
+    if (attr.type_ == VAR_QUATERNION)
+    {
+        float data[4];
+        const unsigned largest = Min(values[0], 3u);
+        float sumSquares = 0.0f;
+        unsigned index = 1;
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            if (i != largest)
+            {
+                data[i] = DequantizeFloat(values[index++], -QUATERNION_COMPONENT_RANGE, QUATERNION_COMPONENT_RANGE, bits);
+                sumSquares += data[i] * data[i];
+            }
+        }
+        data[largest] = sqrtf(Max(1.0f - sumSquares, 0.0f));
+        return Quaternion(data).Normalized();
+    }
+
+    const float min = attr.GetMetadata(AttributeMetadata::P_QUANTIZE_MIN).GetFloat();
+    const float max = attr.GetMetadata(AttributeMetadata::P_QUANTIZE_MAX).GetFloat();
+    switch (attr.type_)
+    {
+    case VAR_FLOAT:
+        return DequantizeFloat(values[0], min, max, bits);
+
+    case VAR_VECTOR2:
+        return Vector2(DequantizeFloat(values[0], min, max, bits), DequantizeFloat(values[1], min, max, bits));
+
+    default:
+        return Vector3(DequantizeFloat(values[0], min, max, bits), DequantizeFloat(values[1], min, max, bits),
+            DequantizeFloat(values[2], min, max, bits));
+    }
+}
+
+/// Write a quantized component, as unchanged, a small change or the full value when a baseline is given.
+static void WriteQuantizedComponent(LatestDataBitWriter& writer, unsigned value, const unsigned* baseline, unsigned bits)
+{
+    if (baseline)
+    {
+        if (value == *baseline)
+        {
+            writer.Write(0, 1);
+            return;
+        }
+
+        writer.Write(1, 1);
+        const unsigned deltaBits = bits / 2;
+        if (deltaBits >= 2)
+        {
+            const int half = 1 << (deltaBits - 1);
+            const int delta = (int)value - (int)*baseline;
+            if (delta >= -half && delta < half)
+            {
+                writer.Write(1, 1);
+                writer.Write((unsigned)(delta + half), deltaBits);
+                return;
+            }
+            writer.Write(0, 1);
+        }
+    }
+
+    writer.Write(value, bits);
+}
+
+/// Read a quantized component written by WriteQuantizedComponent.
+static unsigned ReadQuantizedComponent(LatestDataBitReader& reader, const unsigned* baseline, unsigned bits)
+{
+    if (baseline)
+    {
+        if (!reader.Read(1))
+            return *baseline;
+
+        const unsigned deltaBits = bits / 2;
+        if (deltaBits >= 2 && reader.Read(1))
+        {
+            const int half = 1 << (deltaBits - 1);
+            return (unsigned)((int)*baseline + (int)reader.Read(deltaBits) - half);
+        }
+    }
+
+    return reader.Read(bits);
+}
+
 Serializable::Serializable(Context* context) :
     Object(context),
     setInstanceDefault_(false),
@@ -647,6 +908,67 @@ bool Serializable::SetAttribute(const String& name, const Variant& value)
     return false;
 }
 
+bool Serializable::SetAttribute(const ResolvedAttribute& resolved, const Variant& value)
+{
+    if (!resolved.IsValid() || resolved.attributes_ != GetAttributes())
+    {
+        URHO3D_LOGERROR("Resolved attribute is not valid for " + GetTypeName());
+        return false;
+    }
+
+    const AttributeInfo& attr = resolved.attributes_->At(resolved.index_);
+
+    // Check that the new value's type matches the attribute type
+    if (value.GetType() == attr.type_)
+    {
+        OnSetAttribute(attr, value);
+        return true;
+    }
+    else
+    {
+        URHO3D_LOGERROR("Could not set attribute " + attr.name_ + ": expected type " + Variant::GetTypeName(attr.type_) +
+                 " but got " + value.GetTypeName());
+        return false;
+    }
+}
+
+unsigned Serializable::SetAttributes(const PODVector<ResolvedAttribute>& attributes, const Vector<Variant>& values)
+{
+    if (attributes.Size() != values.Size())
+    {
+        URHO3D_LOGERROR("Attribute and value counts do not match");
+        return 0;
+    }
+
+    // Look up the attribute descriptions only once for the whole batch
+    const Vector<AttributeInfo>* ownAttributes = GetAttributes();
+    unsigned numSet = 0;
+
+    for (unsigned i = 0; i < attributes.Size(); ++i)
+    {
+        const ResolvedAttribute& resolved = attributes[i];
+        if (!resolved.IsValid() || resolved.attributes_ != ownAttributes)
+        {
+            URHO3D_LOGERROR("Resolved attribute is not valid for " + GetTypeName());
+            continue;
+        }
+
+        const AttributeInfo& attr = ownAttributes->At(resolved.index_);
+        if (values[i].GetType() == attr.type_)
+        {
+            OnSetAttribute(attr, values[i]);
+            ++numSet;
+        }
+        else
+        {
+            URHO3D_LOGERROR("Could not set attribute " + attr.name_ + ": expected type " + Variant::GetTypeName(attr.type_) +
+                     " but got " + values[i].GetTypeName());
+        }
+    }
+
+    return numSet;
+}
+
 void Serializable::ResetToDefault()
 {
     const Vector<AttributeInfo>* attributes = GetAttributes();
@@ -836,23 +1158,8 @@ bool Serializable::ReadDeltaUpdate(Deserializer& source)
         if (attributeBits.IsSet(i))
         {
             const AttributeInfo& attr = attributes->At(i);
-            if (!(interceptMask & (1ULL << i)))
-            {
-                OnSetAttribute(attr, source.ReadVariant(attr.type_));
+            if (ApplyNetworkAttribute(attr, i, source.ReadVariant(attr.type_), timeStamp, interceptMask))
                 changed = true;
-            }
-            else
-            {
-                using namespace InterceptNetworkUpdate;
-
-                VariantMap& eventData = GetEventDataMap();
-                eventData[P_SERIALIZABLE] = this;
-                eventData[P_TIMESTAMP] = (unsigned)timeStamp;
-                eventData[P_INDEX] = RemapAttributeIndex(GetAttributes(), attr, i);
-                eventData[P_NAME] = attr.name_;
-                eventData[P_VALUE] = source.ReadVariant(attr.type_);
-                SendEvent(E_INTERCEPTNETWORKUPDATE, eventData);
-            }
         }
     }
 
@@ -874,29 +1181,163 @@ bool Serializable::ReadLatestDataUpdate(Deserializer& source)
     for (unsigned i = 0; i < numAttributes && !source.IsEof(); ++i)
     {
         const AttributeInfo& attr = attributes->At(i);
-        if (attr.mode_ & AM_LATESTDATA)
+        if ((attr.mode_ & AM_LATESTDATA) && ApplyNetworkAttribute(attr, i, source.ReadVariant(attr.type_), timeStamp, interceptMask))
+            changed = true;
+    }
+
+    return changed;
+}
+
+void Serializable::WriteQuantizedLatestDataUpdate(Serializer& dest, unsigned char timeStamp, const PODVector<unsigned>* baseline,
+    PODVector<unsigned>& values)
+{
+    values.Clear();
+
+    if (!networkState_)
+    {
+        URHO3D_LOGERROR("WriteQuantizedLatestDataUpdate called without allocated NetworkState");
+        return;
+    }
+
+    const Vector<AttributeInfo>* attributes = networkState_->attributes_;
+    if (!attributes)
+        return;
+
+    unsigned numAttributes = attributes->Size();
+
+    // Quantize first to know whether the baseline matches
+    for (unsigned i = 0; i < numAttributes; ++i)
+    {
+        const AttributeInfo& attr = attributes->At(i);
+        unsigned bits;
+        unsigned numComponents = GetQuantizedComponents(attr, bits);
+        if (numComponents)
         {
-            if (!(interceptMask & (1ULL << i)))
-            {
-                OnSetAttribute(attr, source.ReadVariant(attr.type_));
-                changed = true;
-            }
-            else
-            {
-                using namespace InterceptNetworkUpdate;
-
-                VariantMap& eventData = GetEventDataMap();
-                eventData[P_SERIALIZABLE] = this;
-                eventData[P_TIMESTAMP] = (unsigned)timeStamp;
-                eventData[P_INDEX] = RemapAttributeIndex(GetAttributes(), attr, i);
-                eventData[P_NAME] = attr.name_;
-                eventData[P_VALUE] = source.ReadVariant(attr.type_);
-                SendEvent(E_INTERCEPTNETWORKUPDATE, eventData);
-            }
+            unsigned start = values.Size();
+            values.Resize(start + numComponents);
+            QuantizeValue(attr, networkState_->currentValues_[i], bits, &values[start]);
         }
     }
 
-    return changed;
+    if (baseline && baseline->Size() != values.Size())
+        baseline = nullptr;
+
+    // Write the quantized attributes bit-packed, then the rest of the latest data as variants
+    dest.WriteUByte(timeStamp);
+    LatestDataBitWriter writer(dest);
+    writer.Write(baseline ? 1 : 0, 1);
+    unsigned index = 0;
+    for (unsigned i = 0; i < numAttributes; ++i)
+    {
+        const AttributeInfo& attr = attributes->At(i);
+        unsigned bits;
+        unsigned numComponents = GetQuantizedComponents(attr, bits);
+        for (unsigned j = 0; j < numComponents; ++j, ++index)
+        {
+            unsigned componentBits = attr.type_ == VAR_QUATERNION && !j ? QUATERNION_INDEX_BITS : bits;
+            WriteQuantizedComponent(writer, values[index], baseline ? &baseline->At(index) : nullptr, componentBits);
+        }
+    }
+    writer.Flush();
+
+    for (unsigned i = 0; i < numAttributes; ++i)
+    {
+        const AttributeInfo& attr = attributes->At(i);
+        unsigned bits;
+        if ((attr.mode_ & AM_LATESTDATA) && !GetQuantizedComponents(attr, bits))
+            dest.WriteVariantData(networkState_->currentValues_[i]);
+    }
+}
+
+bool Serializable::ReadQuantizedLatestDataUpdate(Deserializer& source, const PODVector<unsigned>* baseline, PODVector<unsigned>& values)
+{
+    values.Clear();
+
+    const Vector<AttributeInfo>* attributes = GetNetworkAttributes();
+    if (!attributes)
+        return false;
+
+    unsigned numAttributes = attributes->Size();
+    unsigned numValues = 0;
+    for (unsigned i = 0; i < numAttributes; ++i)
+    {
+        unsigned bits;
+        numValues += GetQuantizedComponents(attributes->At(i), bits);
+    }
+
+    unsigned long long interceptMask = networkState_ ? networkState_->interceptMask_ : 0;
+    unsigned char timeStamp = source.ReadUByte();
+    LatestDataBitReader reader(source);
+    if (!reader.Read(1))
+        baseline = nullptr;
+    else if (!baseline || baseline->Size() != numValues)
+        return false;
+
+    values.Resize(numValues);
+    unsigned index = 0;
+    for (unsigned i = 0; i < numAttributes; ++i)
+    {
+        const AttributeInfo& attr = attributes->At(i);
+        unsigned bits;
+        unsigned numComponents = GetQuantizedComponents(attr, bits);
+        if (!numComponents)
+            continue;
+
+        unsigned start = index;
+        for (unsigned j = 0; j < numComponents; ++j, ++index)
+        {
+            unsigned componentBits = attr.type_ == VAR_QUATERNION && !j ? QUATERNION_INDEX_BITS : bits;
+            values[index] = ReadQuantizedComponent(reader, baseline ? &baseline->At(index) : nullptr, componentBits);
+        }
+        ApplyNetworkAttribute(attr, i, DequantizeValue(attr, &values[start], bits), timeStamp, interceptMask);
+    }
+
+    for (unsigned i = 0; i < numAttributes && !source.IsEof(); ++i)
+    {
+        const AttributeInfo& attr = attributes->At(i);
+        unsigned bits;
+        if ((attr.mode_ & AM_LATESTDATA) && !GetQuantizedComponents(attr, bits))
+            ApplyNetworkAttribute(attr, i, source.ReadVariant(attr.type_), timeStamp, interceptMask);
+    }
+
+    return true;
+}
+
+bool Serializable::HasQuantizedLatestData() const
+{
+    const Vector<AttributeInfo>* attributes = GetNetworkAttributes();
+    if (!attributes)
+        return false;
+
+    for (unsigned i = 0; i < attributes->Size(); ++i)
+    {
+        unsigned bits;
+        if (GetQuantizedComponents(attributes->At(i), bits))
+            return true;
+    }
+
+    return false;
+}
+
+bool Serializable::ApplyNetworkAttribute(const AttributeInfo& attr, unsigned index, const Variant& value, unsigned char timeStamp,
+    unsigned long long interceptMask)
+{
+    if (!(interceptMask & (1ULL << index)))
+    {
+        OnSetAttribute(attr, value);
+        return true;
+    }
+
+    using namespace InterceptNetworkUpdate;
+
+    VariantMap& eventData = GetEventDataMap();
+    eventData[P_SERIALIZABLE] = this;
+    eventData[P_TIMESTAMP] = (unsigned)timeStamp;
+    eventData[P_INDEX] = RemapAttributeIndex(GetAttributes(), attr, index);
+    eventData[P_NAME] = attr.name_;
+    eventData[P_VALUE] = value;
+    SendEvent(E_INTERCEPTNETWORKUPDATE, eventData);
+    return false;
 }
 
 Variant Serializable::GetAttribute(unsigned index) const
@@ -943,6 +1384,41 @@ Variant Serializable::GetAttribute(const String& name) const
     return ret;
 }
 
+Variant Serializable::GetAttribute(const ResolvedAttribute& resolved) const
+{
+    Variant ret;
+
+    if (!resolved.IsValid() || resolved.attributes_ != GetAttributes())
+    {
+        URHO3D_LOGERROR("Resolved attribute is not valid for " + GetTypeName());
+        return ret;
+    }
+
+    OnGetAttribute(resolved.attributes_->At(resolved.index_), ret);
+    return ret;
+}
+
+ResolvedAttribute Serializable::ResolveAttribute(const String& name) const
+{
+    ResolvedAttribute ret;
+
+    const Vector<AttributeInfo>* attributes = GetAttributes();
+    if (!attributes)
+        return ret;
+
+    for (unsigned i = 0; i < attributes->Size(); ++i)
+    {
+        if (!attributes->At(i).name_.Compare(name, true))
+        {
+            ret.attributes_ = attributes;
+            ret.index_ = i;
+            return ret;
+        }
+    }
+
+    return ret;
+}
+
 Variant Serializable::GetAttributeDefault(unsigned index) const
 {
     const Vector<AttributeInfo>* attributes = GetAttributes();
@@ -40,6 +40,18 @@ struct DirtyBits;
 struct NetworkState;
 struct ReplicationState;
 
+/// Attribute resolved by name once, for repeated access without name lookup. Valid for the objects that share the attribute descriptions it was resolved from, i.e. objects of the same type.
+struct ResolvedAttribute
+{
+    /// Return whether resolved.
+    bool IsValid() const { return attributes_ != nullptr; }
+
+    /// Attribute descriptions resolved from.
+    const Vector<AttributeInfo>* attributes_{};
+    /// Attribute index.
+    unsigned index_{};
+};
+
 /// Base class for objects with automatic serialization through attributes.
 class URHO3D_API Serializable : public Object
 {
@@ -86,6 +98,10 @@ public:
     bool SetAttribute(unsigned index, const Variant& value);
     /// Set attribute by name. Return true if successfully set.
     bool SetAttribute(const String& name, const Variant& value);
+    /// Set attribute by resolved attribute. Return true if successfully set.
+    bool SetAttribute(const ResolvedAttribute& resolved, const Variant& value);
+    /// Set attributes by resolved attributes, with one value each. Return number of attributes successfully set.
+    unsigned SetAttributes(const PODVector<ResolvedAttribute>& attributes, const Vector<Variant>& values);
     /// Set instance-level default flag.
     void SetInstanceDefault(bool enable) { setInstanceDefault_ = enable; }
     /// Reset all editable attributes to their default values.
@@ -109,12 +125,23 @@ public:
     bool ReadDeltaUpdate(Deserializer& source);
     /// Read and apply a network latest data update. Return true if attributes were changed.
     bool ReadLatestDataUpdate(Deserializer& source);
+    /// Write a latest data network update with the attributes that have quantization metadata bit-packed, as changes to the baseline values if given. The quantized values are returned for use as a later baseline.
+    void WriteQuantizedLatestDataUpdate(Serializer& dest, unsigned char timeStamp, const PODVector<unsigned>* baseline,
+        PODVector<unsigned>& values);
+    /// Read and apply a quantized latest data network update, written against the baseline values if it was written with one. The quantized values are returned for use as a later baseline. Return false if the baseline was needed but missing.
+    bool ReadQuantizedLatestDataUpdate(Deserializer& source, const PODVector<unsigned>* baseline, PODVector<unsigned>& values);
+    /// Return whether any latest data network attribute has quantization metadata, so that the quantized latest data updates should be used.
+    bool HasQuantizedLatestData() const;
 
     /// Return attribute value by index. Return empty if illegal index.
     /// @property{get_attributes}
     Variant GetAttribute(unsigned index) const;
     /// Return attribute value by name. Return empty if not found.
     Variant GetAttribute(const String& name) const;
+    /// Return attribute value by resolved attribute. Return empty if not valid for this object.
+    Variant GetAttribute(const ResolvedAttribute& resolved) const;
+    /// Resolve attribute by name for repeated access. Return an invalid result if not found.
+    ResolvedAttribute ResolveAttribute(const String& name) const;
     /// Return attribute default value by index. Return empty if illegal index.
     /// @property{get_attributeDefaults}
     Variant GetAttributeDefault(unsigned index) const;
@@ -141,6 +168,9 @@ protected:
     UniquePtr<NetworkState> networkState_;
 
 private:
+    /// Apply an attribute value from a network update, or send it as an event if intercepted. Return true if applied.
+    bool ApplyNetworkAttribute(const AttributeInfo& attr, unsigned index, const Variant& value, unsigned char timeStamp,
+        unsigned long long interceptMask);
     /// Set instance-level default value. Allocate the internal data structure as necessary.
     void SetInstanceDefault(const String& name, const Variant& defaultValue);
     /// Get instance-level default value.
@@ -230,6 +260,12 @@ namespace AttributeMetadata
 {
     /// Names of vector struct elements. StringVector.
     static const StringHash P_VECTOR_STRUCT_ELEMENTS("VectorStructElements");
+    /// Bits per component in the quantized latest data network updates, up to 24. Float, Vector2, Vector3 and Quaternion latest data attributes are bit-packed when set. Int.
+    static const StringHash P_QUANTIZE_BITS("QuantizeBits");
+    /// Minimum component value of a quantized float, Vector2 or Vector3 attribute. Float.
+    static const StringHash P_QUANTIZE_MIN("QuantizeMin");
+    /// Maximum component value of a quantized float, Vector2 or Vector3 attribute. Float.
+    static const StringHash P_QUANTIZE_MAX("QuantizeMax");
 }
 
 // The following macros need to be used within a class member function such as ClassName::RegisterObject().
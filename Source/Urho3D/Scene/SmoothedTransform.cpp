@@ -32,16 +32,23 @@
 namespace Urho3D
 {
 
+/// Maximum number of buffered snapshots.
+static const unsigned MAX_TRANSFORM_SNAPSHOTS = 32;
+/// Gap between snapshots in update intervals after which the node is assumed to have been stationary, as unchanged transforms are not sent.
+static const float SNAPSHOT_GAP_INTERVALS = 1.5f;
+
 SmoothedTransform::SmoothedTransform(Context* context) :
     Component(context),
     targetPosition_(Vector3::ZERO),
     targetRotation_(Quaternion::IDENTITY),
-    smoothingMask_(SMOOTH_NONE),
-    subscribed_(false)
+    smoothingMask_(SMOOTH_NONE)
 {
 }
 
-SmoothedTransform::~SmoothedTransform() = default;
+SmoothedTransform::~SmoothedTransform()
+{
+    StopSmoothing();
+}
 
 void SmoothedTransform::RegisterObject(Context* context)
 {
@@ -50,6 +57,20 @@ void SmoothedTransform::RegisterObject(Context* context)
 
 void SmoothedTransform::Update(float constant, float squaredSnapThreshold)
 {
+    if (!snapshots_.Empty())
+    {
+        if (smoothingScene_ && smoothingScene_->GetInterpolationDelay() > 0.0f)
+        {
+            UpdateInterpolation();
+            if (!smoothingMask_)
+                StopSmoothing();
+            return;
+        }
+
+        // Interpolation was disabled, continue with exponential smoothing toward the latest target
+        snapshots_.Clear();
+    }
+
     if (smoothingMask_ && node_)
     {
         Vector3 position = node_->GetPosition();
@@ -88,12 +109,9 @@ void SmoothedTransform::Update(float constant, float squaredSnapThreshold)
         }
     }
 
-    // If smoothing has completed, unsubscribe from the update event
+    // If smoothing has completed, leave the scene's smoothing update
     if (!smoothingMask_)
-    {
-        UnsubscribeFromEvent(GetScene(), E_UPDATESMOOTHING);
-        subscribed_ = false;
-    }
+        StopSmoothing();
 }
 
 void SmoothedTransform::SetTargetPosition(const Vector3& position)
@@ -101,12 +119,11 @@ void SmoothedTransform::SetTargetPosition(const Vector3& position)
     targetPosition_ = position;
     smoothingMask_ |= SMOOTH_POSITION;
 
-    // Subscribe to smoothing update if not yet subscribed
-    if (!subscribed_)
-    {
-        SubscribeToEvent(GetScene(), E_UPDATESMOOTHING, URHO3D_HANDLER(SmoothedTransform, HandleUpdateSmoothing));
-        subscribed_ = true;
-    }
+    Scene* scene = GetScene();
+    if (scene && scene->GetInterpolationDelay() > 0.0f)
+        AddSnapshot(&position, nullptr);
+
+    StartSmoothing();
 
     SendEvent(E_TARGETPOSITION);
 }
@@ -116,11 +133,11 @@ void SmoothedTransform::SetTargetRotation(const Quaternion& rotation)
     targetRotation_ = rotation;
     smoothingMask_ |= SMOOTH_ROTATION;
 
-    if (!subscribed_)
-    {
-        SubscribeToEvent(GetScene(), E_UPDATESMOOTHING, URHO3D_HANDLER(SmoothedTransform, HandleUpdateSmoothing));
-        subscribed_ = true;
-    }
+    Scene* scene = GetScene();
+    if (scene && scene->GetInterpolationDelay() > 0.0f)
+        AddSnapshot(nullptr, &rotation);
+
+    StartSmoothing();
 
     SendEvent(E_TARGETROTATION);
 }
@@ -167,13 +184,125 @@ void SmoothedTransform::OnNodeSet(Node* node)
     }
 }
 
-void SmoothedTransform::HandleUpdateSmoothing(StringHash eventType, VariantMap& eventData)
+void SmoothedTransform::OnSceneSet(Scene* scene)
+{
+    if (scene && smoothingMask_)
+        StartSmoothing();
+    else if (!scene)
+        StopSmoothing();
+}
+
+void SmoothedTransform::StartSmoothing()
+{
+    if (smoothingScene_)
+        return;
+
+    Scene* scene = GetScene();
+    if (scene)
+    {
+        scene->AddSmoothedTransform(this);
+        smoothingScene_ = scene;
+    }
+}
+
+void SmoothedTransform::StopSmoothing()
 {
-    using namespace UpdateSmoothing;
+    if (smoothingScene_)
+    {
+        smoothingScene_->RemoveSmoothedTransform(this);
+        smoothingScene_.Reset();
+    }
+}
+
+void SmoothedTransform::AddSnapshot(const Vector3* position, const Quaternion* rotation)
+{
+    Scene* scene = GetScene();
+    if (!scene || !node_)
+        return;
+
+    float time = scene->GetSnapshotTime();
+    float interval = scene->GetSnapshotInterval();
+
+    // Updates usually arrive in order, so search from the newest. The position and rotation of one update share a snapshot
+    unsigned index = snapshots_.Size();
+    while (index && snapshots_[index - 1].time_ > time)
+        --index;
+    if (index && snapshots_[index - 1].time_ == time)
+    {
+        TransformSnapshot& snapshot = snapshots_[index - 1];
+        if (position)
+            snapshot.position_ = *position;
+        if (rotation)
+            snapshot.rotation_ = *rotation;
+        return;
+    }
+
+    // Unchanged transforms are not sent, so after a gap hold the previous transform until one interval before this update
+    if (interval > 0.0f && index == snapshots_.Size() &&
+        (snapshots_.Empty() || time - snapshots_.Back().time_ > interval * SNAPSHOT_GAP_INTERVALS))
+    {
+        TransformSnapshot hold;
+        hold.time_ = time - interval;
+        hold.position_ = snapshots_.Empty() ? node_->GetPosition() : snapshots_.Back().position_;
+        hold.rotation_ = snapshots_.Empty() ? node_->GetRotation() : snapshots_.Back().rotation_;
+        snapshots_.Push(hold);
+        ++index;
+    }
+
+    // Fill in the part not included in this update from the preceding snapshot
+    const TransformSnapshot& previous = snapshots_[index ? index - 1 : 0];
+    TransformSnapshot snapshot;
+    snapshot.time_ = time;
+    snapshot.position_ = position ? *position : previous.position_;
+    snapshot.rotation_ = rotation ? *rotation : previous.rotation_;
+    snapshots_.Insert(index, snapshot);
+
+    if (snapshots_.Size() > MAX_TRANSFORM_SNAPSHOTS)
+        snapshots_.Erase(0);
+}
+
+void SmoothedTransform::UpdateInterpolation()
+{
+    float time = smoothingScene_->GetInterpolationTime();
+
+    // Keep the newest snapshot at or before the interpolation time, and at least two for extrapolation
+    unsigned numObsolete = 0;
+    while (snapshots_.Size() - numObsolete > 2 && snapshots_[numObsolete + 1].time_ <= time)
+        ++numObsolete;
+    if (numObsolete)
+        snapshots_.Erase(0, numObsolete);
+
+    Vector3 position;
+    Quaternion rotation;
+
+    if (snapshots_.Size() == 1 || time <= snapshots_[0].time_)
+    {
+        // The interpolation has not reached the buffered updates yet, or there is nothing to move toward
+        position = snapshots_[0].position_;
+        rotation = snapshots_[0].rotation_;
+        if (snapshots_.Size() == 1 && time >= snapshots_[0].time_)
+            smoothingMask_ = SMOOTH_NONE;
+    }
+    else
+    {
+        const TransformSnapshot& from = snapshots_[0];
+        const TransformSnapshot& to = snapshots_[1];
+        float duration = to.time_ - from.time_;
+        float t = (time - from.time_) / duration;
+
+        // Past the newest snapshot, continue with its velocity for a limited time and then hold
+        float maxT = 1.0f + smoothingScene_->GetMaxExtrapolation() / duration;
+        if (t >= maxT)
+        {
+            t = maxT;
+            smoothingMask_ = SMOOTH_NONE;
+        }
+
+        position = from.position_.Lerp(to.position_, t);
+        rotation = from.rotation_.Slerp(to.rotation_, t);
+    }
 
-    float constant = eventData[P_CONSTANT].GetFloat();
-    float squaredSnapThreshold = eventData[P_SQUAREDSNAPTHRESHOLD].GetFloat();
-    Update(constant, squaredSnapThreshold);
+    node_->SetTransform(position, rotation);
 }
 
 }
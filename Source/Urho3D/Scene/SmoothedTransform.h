@@ -40,6 +40,17 @@ enum SmoothingType : unsigned
 };
 URHO3D_FLAGSET(SmoothingType, SmoothingTypeFlags);
 
+/// Received network transform at a server time, buffered for interpolation.
+struct TransformSnapshot
+{
+    /// Server time.
+    float time_;
+    /// Position in parent space.
+    Vector3 position_;
+    /// Rotation in parent space.
+    Quaternion rotation_;
+};
+
 /// Transform smoothing component for network updates.
 class URHO3D_API SmoothedTransform : public Component
 {
@@ -88,13 +99,25 @@ public:
     /// @property
     bool IsInProgress() const { return smoothingMask_ != SMOOTH_NONE; }
 
+    /// Return number of buffered snapshots when the scene uses snapshot interpolation.
+    /// @property
+    unsigned GetNumSnapshots() const { return snapshots_.Size(); }
+
 protected:
     /// Handle scene node being assigned at creation.
     void OnNodeSet(Node* node) override;
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
 
 private:
-    /// Handle smoothing update event.
-    void HandleUpdateSmoothing(StringHash eventType, VariantMap& eventData);
+    /// Register with the scene for the batched smoothing update if not registered yet.
+    void StartSmoothing();
+    /// Unregister from the batched smoothing update.
+    void StopSmoothing();
+    /// Buffer a received position and/or rotation at the server time of the network update being applied.
+    void AddSnapshot(const Vector3* position, const Quaternion* rotation);
+    /// Interpolate between the buffered snapshots at the scene's interpolation time, or extrapolate past the newest.
+    void UpdateInterpolation();
 
     /// Target position.
     Vector3 targetPosition_;
@@ -102,8 +125,10 @@ private:
     Quaternion targetRotation_;
     /// Active smoothing operations bitmask.
     SmoothingTypeFlags smoothingMask_;
-    /// Subscribed to smoothing update event flag.
-    bool subscribed_;
+    /// Buffered snapshots ordered by server time, when the scene uses snapshot interpolation.
+    PODVector<TransformSnapshot> snapshots_;
+    /// Scene registered with for the batched smoothing update.
+    WeakPtr<Scene> smoothingScene_;
 };
 
 }
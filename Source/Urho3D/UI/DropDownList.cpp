@@ -107,6 +107,8 @@ void DropDownList::GetBatches(PODVector<UIBatch>& batches, PODVector<float>& ver
         selectedItem->GetBatchesWithOffset(offset, batches, vertexData, currentScissor);
         selectedItem->SetSelected(true);
         selectedItem->SetHovering(hover);
+        // The selected item is outside this element, so its changes would not be noticed by a batch cache
+        MarkBatchesDirty();
     }
 }
 
@@ -24,6 +24,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/Graphics.h"
 #include "../IO/Deserializer.h"
 #include "../IO/FileSystem.h"
@@ -82,6 +83,8 @@ bool Font::BeginLoad(Deserializer& source)
 
     fontType_ = FONT_NONE;
     faces_.Clear();
+    sdfPointSize_ = 0.0f;
+    sdfSpread_ = 0;
 
     fontDataSize_ = source.GetSize();
     if (fontDataSize_)
@@ -105,7 +108,7 @@ bool Font::BeginLoad(Deserializer& source)
     else if (ext == ".xml" || ext == ".fnt" || ext == ".sdf")
         fontType_ = FONT_BITMAP;
 
-    sdfFont_ = ext == ".sdf";
+    sdfFont_ = ext == ".sdf" || sdfPointSize_ > 0.0f;
 
     SetMemoryUse(fontDataSize_);
     return true;
@@ -119,6 +122,10 @@ bool Font::SaveXML(Serializer& dest, int pointSize, bool usedGlyphs, const Strin
 
     URHO3D_PROFILE(FontSaveXML);
 
+    // The textures are read back, so any glyphs still being rendered must be in them
+    if (fontType_ == FONT_FREETYPE)
+        static_cast<FontFaceFreeType*>(fontFace)->CompleteGlyphs();
+
     SharedPtr<FontFaceBitmap> packedFontFace(new FontFaceBitmap(this));
     if (!packedFontFace->Load(fontFace, usedGlyphs))
         return false;
@@ -146,6 +153,9 @@ FontFace* Font::GetFace(float pointSize)
     // For bitmap font type, always return the same font face provided by the font's bitmap file regardless of the actual requested point size
     if (fontType_ == FONT_BITMAP)
         pointSize = 0;
+    // Likewise a FreeType SDF font renders its distance field glyphs at one size, which are then scaled
+    else if (sdfPointSize_ > 0.0f)
+        pointSize = sdfPointSize_;
     else
         pointSize = Clamp(pointSize, MIN_POINT_SIZE, MAX_POINT_SIZE);
 
@@ -218,10 +228,21 @@ void Font::LoadParameters()
         scaledOffset_.x_ = scaledElem.GetFloat("x");
         scaledOffset_.y_ = scaledElem.GetFloat("y");
     }
+
+    XMLElement sdfElem = rootElem.GetChild("sdf");
+    if (sdfElem)
+    {
+        sdfPointSize_ = Clamp(sdfElem.GetFloat("pointsize"), MIN_POINT_SIZE, MAX_POINT_SIZE);
+        sdfSpread_ = sdfElem.HasAttribute("spread") ? Max(sdfElem.GetInt("spread"), 1) : Max(RoundToInt(sdfPointSize_ / 8.0f), 1);
+    }
 }
 
 FontFace* Font::GetFaceFreeType(float pointSize)
 {
+    // Faces may render glyphs in a worker thread, and upload them when the work item completes
+    if (!HasSubscribedToEvent(E_WORKITEMCOMPLETED))
+        SubscribeToEvent(E_WORKITEMCOMPLETED, URHO3D_HANDLER(Font, HandleWorkItemCompleted));
+
     SharedPtr<FontFace> newFace(new FontFaceFreeType(this));
     if (!newFace->Load(&fontData_[0], fontDataSize_, pointSize))
         return nullptr;
@@ -242,4 +263,13 @@ FontFace* Font::GetFaceBitmap(float pointSize)
     return newFace;
 }
 
+void Font::HandleWorkItemCompleted(StringHash eventType, VariantMap& eventData)
+{
+    if (fontType_ != FONT_FREETYPE)
+        return;
+
+    for (HashMap<int, SharedPtr<FontFace> >::Iterator i = faces_.Begin(); i != faces_.End(); ++i)
+        static_cast<FontFaceFreeType*>(i->second_.Get())->UploadRenderedGlyphs();
+}
+
 }
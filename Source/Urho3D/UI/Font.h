@@ -79,6 +79,12 @@ public:
     /// Is signed distance field font.
     bool IsSDFFont() const { return sdfFont_; }
 
+    /// Return the point size the distance field glyphs of a FreeType SDF font are rendered at. Zero for other fonts.
+    float GetSDFPointSize() const { return sdfPointSize_; }
+
+    /// Return the distance field spread in pixels of a FreeType SDF font.
+    int GetSDFSpread() const { return sdfSpread_; }
+
     /// Return absolute position adjustment for glyphs.
     /// @property
     const IntVector2& GetAbsoluteGlyphOffset() const { return absoluteOffset_; }
@@ -100,6 +106,8 @@ private:
     FontFace* GetFaceFreeType(float pointSize);
     /// Return bitmap font face. Called internally. Return null on error.
     FontFace* GetFaceBitmap(float pointSize);
+    /// Handle work item completed event. Upload the glyphs rendered in the worker thread.
+    void HandleWorkItemCompleted(StringHash eventType, VariantMap& eventData);
 
     /// Created faces.
     HashMap<int, SharedPtr<FontFace> > faces_;
@@ -115,6 +123,10 @@ private:
     FontType fontType_;
     /// Signed distance field font flag.
     bool sdfFont_;
+    /// Point size of the distance field glyphs generated for a FreeType font.
+    float sdfPointSize_{};
+    /// Distance field spread in pixels for a FreeType font.
+    int sdfSpread_{};
 };
 
 }
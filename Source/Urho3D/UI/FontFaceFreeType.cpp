@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Texture2D.h"
 #include "../IO/FileSystem.h"
@@ -37,6 +38,7 @@
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_TRUETYPE_TABLES_H
+#include FT_OUTLINE_H
 
 #include "../DebugNew.h"
 
@@ -48,6 +50,38 @@ inline float FixedToFloat(FT_Pos value)
     return value / 64.0f;
 }
 
+/// Convert a coverage image to a signed distance field, with the edge at value 128 and the full range covering the spread on both sides of it.
+static void GenerateDistanceField(unsigned char* dest, const unsigned char* coverage, int width, int height, int spread)
+{
+    const int maxSquaredDistance = spread * spread;
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            bool inside = coverage[y * width + x] >= 128;
+            int bestSquaredDistance = maxSquaredDistance;
+
+            // Search the nearest pixel on the other side of the edge within the spread
+            for (int dy = Max(-spread, -y); dy <= Min(spread, height - 1 - y); ++dy)
+            {
+                const unsigned char* row = coverage + (y + dy) * width;
+                for (int dx = Max(-spread, -x); dx <= Min(spread, width - 1 - x); ++dx)
+                {
+                    int squaredDistance = dx * dx + dy * dy;
+                    if (squaredDistance < bestSquaredDistance && (row[x + dx] >= 128) != inside)
+                        bestSquaredDistance = squaredDistance;
+                }
+            }
+
+            // The edge lies halfway between the pixels
+            float distance = Min(sqrtf((float)bestSquaredDistance) - 0.5f, (float)spread) / (2.0f * spread);
+            float value = inside ? 0.5f + distance : 0.5f - distance;
+            dest[y * width + x] = (unsigned char)Clamp((int)(value * 255.0f + 0.5f), 0, 255);
+        }
+    }
+}
+
 /// FreeType library subsystem.
 class FreeTypeLibrary : public Object
 {
@@ -84,6 +118,19 @@ FontFaceFreeType::FontFaceFreeType(Font* font) :
 
 FontFaceFreeType::~FontFaceFreeType()
 {
+    // Stop the worker thread rendering before the face it uses is released
+    if (renderItem_)
+    {
+        {
+            MutexLock lock(renderMutex_);
+            queuedGlyphs_.Clear();
+        }
+        auto* workQueue = font_->GetSubsystem<WorkQueue>();
+        if (workQueue)
+            workQueue->Wait(renderItem_);
+    }
+    ReleaseWorkerFace();
+
     if (face_)
     {
         FT_Done_Face((FT_Face)face_);
@@ -108,7 +155,9 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
     const FontHintLevel hintLevel = ui->GetFontHintLevel();
     const float subpixelThreshold = ui->GetFontSubpixelThreshold();
 
-    subpixel_ = (hintLevel <= FONT_HINT_LEVEL_LIGHT) && (pointSize <= subpixelThreshold);
+    // SDF fonts are scaled freely, so pixel alignment and oversampling do not apply
+    sdfSpread_ = font_->IsSDFFont() ? Max(font_->GetSDFSpread(), 1) : 0;
+    subpixel_ = !sdfSpread_ && (hintLevel <= FONT_HINT_LEVEL_LIGHT) && (pointSize <= subpixelThreshold);
     oversampling_ = subpixel_ ? ui->GetFontOversampling() : 1;
 
     if (pointSize <= 0)
@@ -159,6 +208,10 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
         loadMode_ |= FT_LOAD_TARGET_LIGHT;
     }
 
+    // Render the glyph pixels in a worker thread. If it can not be set up, render them immediately
+    if (ui->GetUseThreadedGlyphRendering() && font_->GetSubsystem<WorkQueue>())
+        CreateWorkerFace(fontData, fontDataSize, pointSize);
+
     ascender_ = FixedToFloat(face->size->metrics.ascender);
     rowHeight_ = FixedToFloat(face->size->metrics.height);
     pointSize_ = pointSize;
@@ -292,6 +345,8 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
 
 const FontGlyph* FontFaceFreeType::GetGlyph(unsigned c)
 {
+    UploadRenderedGlyphs();
+
     HashMap<unsigned, FontGlyph>::Iterator i = glyphMapping_.Find(c);
     if (i != glyphMapping_.End())
     {
@@ -333,7 +388,175 @@ bool FontFaceFreeType::SetupNextTexture(int textureWidth, int textureHeight)
     return true;
 }
 
-void FontFaceFreeType::BoxFilter(unsigned char* dest, size_t destSize, const unsigned char* src, size_t srcSize)
+void FontFaceFreeType::UploadRenderedGlyphs()
+{
+    if (!numPendingGlyphs_)
+        return;
+
+    Vector<GlyphRenderJob> glyphs;
+    {
+        MutexLock lock(renderMutex_);
+        glyphs.Swap(renderedGlyphs_);
+    }
+
+    for (unsigned i = 0; i < glyphs.Size(); ++i)
+    {
+        const GlyphRenderJob& glyph = glyphs[i];
+        if (glyph.page_ < textures_.Size())
+            textures_[glyph.page_]->SetData(0, glyph.x_, glyph.y_, glyph.width_, glyph.height_, glyph.data_.Get());
+    }
+    numPendingGlyphs_ -= glyphs.Size();
+
+    // Without mutable glyphs no more glyphs will be loaded, so the worker thread's face is no longer needed
+    if (!numPendingGlyphs_ && !face_)
+        ReleaseWorkerFace();
+}
+
+void FontFaceFreeType::CompleteGlyphs()
+{
+    if (!renderItem_)
+        return;
+
+    auto* workQueue = font_->GetSubsystem<WorkQueue>();
+    if (workQueue)
+        workQueue->Wait(renderItem_);
+    UploadRenderedGlyphs();
+}
+
+bool FontFaceFreeType::CreateWorkerFace(const unsigned char* fontData, unsigned fontDataSize, float pointSize)
+{
+    FT_Library library;
+    if (FT_Init_FreeType(&library))
+        return false;
+
+    FT_Face face;
+    if (FT_New_Memory_Face(library, fontData, fontDataSize, 0, &face) ||
+        FT_Set_Char_Size(face, 0, pointSize * 64, oversampling_ * FONT_DPI, FONT_DPI))
+    {
+        URHO3D_LOGWARNING("Could not create font face for rendering glyphs in a worker thread");
+        // Releasing the library releases also its faces
+        FT_Done_FreeType(library);
+        return false;
+    }
+
+    workerLibrary_ = library;
+    workerFace_ = face;
+    return true;
+}
+
+void FontFaceFreeType::ReleaseWorkerFace()
+{
+    if (workerLibrary_)
+    {
+        FT_Done_FreeType((FT_Library)workerLibrary_);
+        workerLibrary_ = nullptr;
+        workerFace_ = nullptr;
+    }
+}
+
+void FontFaceFreeType::QueueGlyphRender(const GlyphRenderJob& job)
+{
+    ++numPendingGlyphs_;
+
+    MutexLock lock(renderMutex_);
+    queuedGlyphs_.Push(job);
+
+    // Start a new work item if the previous one has finished. It renders also the glyphs queued while it runs
+    if (!renderingGlyphs_)
+    {
+        renderingGlyphs_ = true;
+        renderItem_ = new WorkItem();
+        renderItem_->workFunction_ = RenderGlyphsWork;
+        renderItem_->aux_ = this;
+        renderItem_->priority_ = 0;
+        renderItem_->sendEvent_ = true;
+        font_->GetSubsystem<WorkQueue>()->AddWorkItem(renderItem_);
+    }
+}
+
+void FontFaceFreeType::RenderQueuedGlyphs()
+{
+    auto face = (FT_Face)workerFace_;
+
+    for (;;)
+    {
+        Vector<GlyphRenderJob> glyphs;
+        {
+            MutexLock lock(renderMutex_);
+            if (queuedGlyphs_.Empty())
+            {
+                renderingGlyphs_ = false;
+                return;
+            }
+            glyphs.Swap(queuedGlyphs_);
+        }
+
+        for (unsigned i = 0; i < glyphs.Size(); ++i)
+        {
+            GlyphRenderJob& glyph = glyphs[i];
+            unsigned dataSize = (unsigned)(glyph.width_ * glyph.height_);
+            glyph.data_ = new unsigned char[dataSize];
+            memset(glyph.data_.Get(), 0, dataSize);
+
+            if (!FT_Load_Char(face, glyph.charCode_, loadMode_ | FT_LOAD_RENDER))
+                CopyGlyphBitmap(face->glyph, glyph.data_.Get(), (unsigned)glyph.width_, glyph.width_, glyph.height_);
+        }
+
+        MutexLock lock(renderMutex_);
+        renderedGlyphs_.Push(glyphs);
+    }
+}
+
+void FontFaceFreeType::RenderGlyphsWork(const WorkItem* item, unsigned threadIndex)
+{
+    static_cast<FontFaceFreeType*>(item->aux_)->RenderQueuedGlyphs();
+}
+
+void FontFaceFreeType::CopyGlyphBitmap(void* slot, unsigned char* dest, unsigned pitch, int width, int height) const
+{
+    auto* glyphSlot = (FT_GlyphSlot)slot;
+    const FT_Bitmap& bitmap = glyphSlot->bitmap;
+    if (!bitmap.width || !bitmap.rows)
+        return;
+
+    // Unpack or filter the bitmap into a coverage image, with room around it for the distance field
+    int srcWidth = (int)bitmap.width + oversampling_ - 1;
+    int coverageWidth = srcWidth + 2 * sdfSpread_;
+    int coverageHeight = (int)bitmap.rows + 2 * sdfSpread_;
+    PODVector<unsigned char> coverage((unsigned)(coverageWidth * coverageHeight));
+    memset(coverage.Buffer(), 0, coverage.Size());
+
+    for (unsigned y = 0; y < bitmap.rows; ++y)
+    {
+        const unsigned char* src = bitmap.buffer + bitmap.pitch * (int)y;
+        unsigned char* rowDest = coverage.Buffer() + (y + sdfSpread_) * coverageWidth + sdfSpread_;
+
+        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        {
+            // Don't do any oversampling, just unpack the bits directly.
+            rowDest += (oversampling_ - 1) / 2;
+            for (unsigned x = 0; x < bitmap.width; ++x)
+                rowDest[x] = (unsigned char)((src[x >> 3u] & (0x80u >> (x & 7u))) ? 255 : 0);
+        }
+        else
+            BoxFilter(rowDest, (size_t)srcWidth, src, bitmap.width);
+    }
+
+    if (sdfSpread_)
+    {
+        PODVector<unsigned char> distanceField(coverage.Size());
+        GenerateDistanceField(distanceField.Buffer(), coverage.Buffer(), coverageWidth, coverageHeight, sdfSpread_);
+        coverage.Swap(distanceField);
+    }
+
+    // The bitmap should match the area reserved from the glyph metrics, but clip in case it does not
+    int copyWidth = Min(width, coverageWidth);
+    int copyHeight = Min(height, coverageHeight);
+    for (int y = 0; y < copyHeight; ++y)
+        memcpy(dest + y * pitch, coverage.Buffer() + y * coverageWidth, (size_t)copyWidth);
+}
+
+void FontFaceFreeType::BoxFilter(unsigned char* dest, size_t destSize, const unsigned char* src, size_t srcSize) const
 {
     const int filterSize = oversampling_;
 
@@ -400,8 +623,10 @@ bool FontFaceFreeType::LoadCharGlyph(unsigned charCode, Image* image)
     auto face = (FT_Face)face_;
     FT_GlyphSlot slot = face->glyph;
 
+    // When rendering in the worker thread, only the outline is loaded here for the metrics
     FontGlyph fontGlyph;
-    FT_Error error = FT_Load_Char(face, charCode, loadMode_ | FT_LOAD_RENDER);
+    FT_Error error = FT_Load_Char(face, charCode, workerFace_ ? loadMode_ : loadMode_ | FT_LOAD_RENDER);
+    bool deferred = false;
     if (error)
     {
         const char* family = face->family_name ? face->family_name : "NULL";
@@ -417,13 +642,41 @@ bool FontFaceFreeType::LoadCharGlyph(unsigned charCode, Image* image)
     }
     else
     {
+        int bitmapWidth, bitmapRows, bitmapLeft, bitmapTop;
+        if (workerFace_ && slot->format == FT_GLYPH_FORMAT_OUTLINE)
+        {
+            // Compute the bitmap dimensions from the grid-fitted control box, as the FreeType smooth renderer does
+            FT_BBox cbox;
+            FT_Outline_Get_CBox(&slot->outline, &cbox);
+            FT_Pos xMin = cbox.xMin & -64;
+            FT_Pos yMin = cbox.yMin & -64;
+            FT_Pos xMax = (cbox.xMax + 63) & -64;
+            FT_Pos yMax = (cbox.yMax + 63) & -64;
+            bitmapWidth = (int)((xMax - xMin) >> 6);
+            bitmapRows = (int)((yMax - yMin) >> 6);
+            bitmapLeft = (int)(xMin >> 6);
+            bitmapTop = (int)(yMax >> 6);
+            deferred = true;
+        }
+        else
+        {
+            // Rendered already when loading, or an embedded bitmap
+            bitmapWidth = (int)slot->bitmap.width;
+            bitmapRows = (int)slot->bitmap.rows;
+            bitmapLeft = slot->bitmap_left;
+            bitmapTop = slot->bitmap_top;
+        }
+
+        // SDF glyphs have room around them for the distance field
+        int padding = bitmapWidth && bitmapRows ? sdfSpread_ : 0;
+
         // Note: position within texture will be filled later
-        fontGlyph.texWidth_ = slot->bitmap.width + oversampling_ - 1;
-        fontGlyph.texHeight_ = slot->bitmap.rows;
-        fontGlyph.width_ = slot->bitmap.width + oversampling_ - 1;
-        fontGlyph.height_ = slot->bitmap.rows;
-        fontGlyph.offsetX_ = slot->bitmap_left - (oversampling_ - 1) / 2.0f;
-        fontGlyph.offsetY_ = floorf(ascender_ + 0.5f) - slot->bitmap_top;
+        fontGlyph.texWidth_ = bitmapWidth ? bitmapWidth + oversampling_ - 1 + 2 * padding : 0;
+        fontGlyph.texHeight_ = bitmapRows ? bitmapRows + 2 * padding : 0;
+        fontGlyph.width_ = fontGlyph.texWidth_;
+        fontGlyph.height_ = fontGlyph.texHeight_;
+        fontGlyph.offsetX_ = bitmapLeft - (oversampling_ - 1) / 2.0f - padding;
+        fontGlyph.offsetY_ = floorf(ascender_ + 0.5f) - bitmapTop - padding;
 
         if (subpixel_ && slot->linearHoriAdvance)
         {
@@ -469,48 +722,32 @@ bool FontFaceFreeType::LoadCharGlyph(unsigned charCode, Image* image)
 
         fontGlyph.x_ = (short)x;
         fontGlyph.y_ = (short)y;
+        fontGlyph.page_ = image ? 0 : textures_.Size() - 1;
 
-        unsigned char* dest = nullptr;
-        unsigned pitch = 0;
-        if (image)
+        if (deferred)
         {
-            fontGlyph.page_ = 0;
-            dest = image->GetData() + fontGlyph.y_ * image->GetWidth() + fontGlyph.x_;
-            pitch = (unsigned)image->GetWidth();
+            // The area stays blank until the glyph has been rendered and uploaded
+            GlyphRenderJob job;
+            job.charCode_ = charCode;
+            job.page_ = fontGlyph.page_;
+            job.x_ = x;
+            job.y_ = y;
+            job.width_ = fontGlyph.texWidth_;
+            job.height_ = fontGlyph.texHeight_;
+            QueueGlyphRender(job);
         }
-        else
+        else if (image)
         {
-            fontGlyph.page_ = textures_.Size() - 1;
-            dest = new unsigned char[fontGlyph.texWidth_ * fontGlyph.texHeight_];
-            pitch = (unsigned)fontGlyph.texWidth_;
-        }
-
-        if (slot->bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
-        {
-            for (unsigned y = 0; y < (unsigned)slot->bitmap.rows; ++y)
-            {
-                unsigned char* src = slot->bitmap.buffer + slot->bitmap.pitch * y;
-                unsigned char* rowDest = dest + (oversampling_ - 1)/2 + y * pitch;
-
-                // Don't do any oversampling, just unpack the bits directly.
-                for (unsigned x = 0; x < (unsigned)slot->bitmap.width; ++x)
-                    rowDest[x] = (unsigned char)((src[x >> 3u] & (0x80u >> (x & 7u))) ? 255 : 0);
-            }
+            unsigned char* dest = image->GetData() + fontGlyph.y_ * image->GetWidth() + fontGlyph.x_;
+            CopyGlyphBitmap(slot, dest, (unsigned)image->GetWidth(), fontGlyph.texWidth_, fontGlyph.texHeight_);
         }
         else
         {
-            for (unsigned y = 0; y < (unsigned)slot->bitmap.rows; ++y)
-            {
-                unsigned char* src = slot->bitmap.buffer + slot->bitmap.pitch * y;
-                unsigned char* rowDest = dest + y * pitch;
-                BoxFilter(rowDest, fontGlyph.texWidth_, src, slot->bitmap.width);
-            }
-        }
-
-        if (!image)
-        {
-            textures_.Back()->SetData(0, fontGlyph.x_, fontGlyph.y_, fontGlyph.texWidth_, fontGlyph.texHeight_, dest);
-            delete[] dest;
+            unsigned dataSize = (unsigned)(fontGlyph.texWidth_ * fontGlyph.texHeight_);
+            SharedArrayPtr<unsigned char> dest(new unsigned char[dataSize]);
+            memset(dest.Get(), 0, dataSize);
+            CopyGlyphBitmap(slot, dest.Get(), (unsigned)fontGlyph.texWidth_, fontGlyph.texWidth_, fontGlyph.texHeight_);
+            textures_.Back()->SetData(0, fontGlyph.x_, fontGlyph.y_, fontGlyph.texWidth_, fontGlyph.texHeight_, dest.Get());
         }
     }
     else
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../Core/Mutex.h"
 #include "../UI/FontFace.h"
 
 namespace Urho3D
@@ -29,6 +30,7 @@ namespace Urho3D
 
 class FreeTypeLibrary;
 class Texture2D;
+struct WorkItem;
 
 /// Free type font face description.
 class URHO3D_API FontFaceFreeType : public FontFace
@@ -44,16 +46,52 @@ public:
     /// Return pointer to the glyph structure corresponding to a character. Return null if glyph not found.
     const FontGlyph* GetGlyph(unsigned c) override;
 
-    /// Return if font face uses mutable glyphs.
-    bool HasMutableGlyphs() const override { return hasMutableGlyph_; }
+    /// Return if font face uses mutable glyphs. Also true while glyphs are being rendered in the worker thread, as the textures still change then.
+    bool HasMutableGlyphs() const override { return hasMutableGlyph_ || numPendingGlyphs_; }
+
+    /// Upload the glyphs rendered in the worker thread to the textures. Called from the main thread.
+    void UploadRenderedGlyphs();
+    /// Wait for the worker thread to render all queued glyphs, and upload them.
+    void CompleteGlyphs();
 
 private:
+    /// Glyph rendered in the worker thread into an area reserved for it in a texture.
+    struct GlyphRenderJob
+    {
+        /// Character code.
+        unsigned charCode_;
+        /// Texture page.
+        unsigned page_;
+        /// X position in texture.
+        int x_;
+        /// Y position in texture.
+        int y_;
+        /// Width in texture.
+        int width_;
+        /// Height in texture.
+        int height_;
+        /// Rendered pixels.
+        SharedArrayPtr<unsigned char> data_;
+    };
+
     /// Setup next texture.
     bool SetupNextTexture(int textureWidth, int textureHeight);
-    /// Load char glyph.
+    /// Load char glyph. The glyph's pixels are rendered in the worker thread if one is in use.
     bool LoadCharGlyph(unsigned charCode, Image* image = nullptr);
     /// Smooth one row of a horizontally oversampled glyph image.
-    void BoxFilter(unsigned char* dest, size_t destSize, const unsigned char* src, size_t srcSize);
+    void BoxFilter(unsigned char* dest, size_t destSize, const unsigned char* src, size_t srcSize) const;
+    /// Copy the rendered bitmap of a FreeType glyph slot into an area of the specified size, converting it to a distance field for SDF fonts. The area must be cleared beforehand.
+    void CopyGlyphBitmap(void* slot, unsigned char* dest, unsigned pitch, int width, int height) const;
+    /// Create the FreeType library and face used by the worker thread. Return true if successful.
+    bool CreateWorkerFace(const unsigned char* fontData, unsigned fontDataSize, float pointSize);
+    /// Release the FreeType library and face used by the worker thread.
+    void ReleaseWorkerFace();
+    /// Queue a glyph for rendering in the worker thread.
+    void QueueGlyphRender(const GlyphRenderJob& job);
+    /// Render the queued glyphs until none are left. Called in the worker thread.
+    void RenderQueuedGlyphs();
+    /// Work function for rendering the queued glyphs.
+    static void RenderGlyphsWork(const WorkItem* item, unsigned threadIndex);
 
     /// FreeType library.
     SharedPtr<FreeTypeLibrary> freeType_;
@@ -65,12 +103,30 @@ private:
     bool subpixel_{};
     /// Oversampling level.
     int oversampling_{};
+    /// Distance field spread in pixels for SDF fonts, zero otherwise.
+    int sdfSpread_{};
     /// Ascender.
     float ascender_{};
     /// Has mutable glyph.
     bool hasMutableGlyph_{};
     /// Glyph area allocator.
     AreaAllocator allocator_;
+    /// FreeType library used by the worker thread, as the FreeType objects can not be shared between threads.
+    void* workerLibrary_{};
+    /// FreeType face used by the worker thread.
+    void* workerFace_{};
+    /// Work item rendering the queued glyphs.
+    SharedPtr<WorkItem> renderItem_;
+    /// Glyphs queued for rendering.
+    Vector<GlyphRenderJob> queuedGlyphs_;
+    /// Glyphs rendered and waiting for upload.
+    Vector<GlyphRenderJob> renderedGlyphs_;
+    /// Mutex for the queued and rendered glyphs.
+    Mutex renderMutex_;
+    /// Whether the work item is rendering the queued glyphs.
+    bool renderingGlyphs_{};
+    /// Number of glyphs queued or rendered, but not uploaded yet.
+    unsigned numPendingGlyphs_{};
 };
 
 }
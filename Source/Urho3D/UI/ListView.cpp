@@ -171,7 +171,13 @@ ListView::ListView(Context* context) :
     hierarchyMode_(true),    // Init to true here so that the setter below takes effect
     baseIndent_(0),
     clearSelectionOnDefocus_(false),
-    selectOnClickEnd_(false)
+    selectOnClickEnd_(false),
+    virtualMode_(false),
+    virtualItemCount_(0),
+    virtualItemHeight_(20),
+    virtualOverscan_(2),
+    realizedFirst_(0),
+    realizedEnd_(0)
 {
     resizeContentWidth_ = true;
 
@@ -182,6 +188,7 @@ ListView::ListView(Context* context) :
     SubscribeToEvent(E_FOCUSCHANGED, URHO3D_HANDLER(ListView, HandleItemFocusChanged));
     SubscribeToEvent(this, E_DEFOCUSED, URHO3D_HANDLER(ListView, HandleFocusChanged));
     SubscribeToEvent(this, E_FOCUSED, URHO3D_HANDLER(ListView, HandleFocusChanged));
+    SubscribeToEvent(this, E_VIEWCHANGED, URHO3D_HANDLER(ListView, HandleViewChanged));
 
     UpdateUIClickSubscription();
 }
@@ -201,6 +208,9 @@ void ListView::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Base Indent", GetBaseIndent, SetBaseIndent, int, 0, AM_FILE);
     URHO3D_ACCESSOR_ATTRIBUTE("Clear Sel. On Defocus", GetClearSelectionOnDefocus, SetClearSelectionOnDefocus, bool, false, AM_FILE);
     URHO3D_ACCESSOR_ATTRIBUTE("Select On Click End", GetSelectOnClickEnd, SetSelectOnClickEnd, bool, false, AM_FILE);
+    URHO3D_ACCESSOR_ATTRIBUTE("Virtual Mode", GetVirtualMode, SetVirtualMode, bool, false, AM_FILE);
+    URHO3D_ACCESSOR_ATTRIBUTE("Virtual Item Height", GetVirtualItemHeight, SetVirtualItemHeight, int, 20, AM_FILE);
+    URHO3D_ACCESSOR_ATTRIBUTE("Virtual Overscan", GetVirtualOverscan, SetVirtualOverscan, unsigned, 2, AM_FILE);
 }
 
 void ListView::OnKey(Key key, MouseButtonFlags buttons, QualifierFlags qualifiers)
@@ -258,6 +268,12 @@ void ListView::OnKey(Key key, MouseButtonFlags buttons, QualifierFlags qualifier
         case KEY_PAGEDOWN:
             {
                 // Convert page step to pixels and see how many items have to be skipped to reach that many pixels
+                if (virtualMode_)
+                {
+                    // Items have a fixed height, so the page step converts directly to an item count
+                    delta = pageDirection * Max((int)(pageStep_ * scrollPanel_->GetHeight()) / virtualItemHeight_, 1);
+                    break;
+                }
                 if (selection == M_MAX_UNSIGNED)
                     selection = 0;      // Assume as if first item is selected
                 int stepPixels = ((int)(pageStep_ * scrollPanel_->GetHeight())) - contentElement_->GetChild(selection)->GetHeight();
@@ -319,6 +335,10 @@ void ListView::OnResize(const IntVector2& newSize, const IntVector2& delta)
     // When in hierarchy mode also need to resize the overlay container
     if (hierarchyMode_)
         overlayContainer_->SetSize(scrollPanel_->GetSize());
+
+    // In virtual mode the view may now cover a different range of items
+    if (virtualMode_)
+        RealizeVirtualItems();
 }
 
 void ListView::UpdateInternalLayout()
@@ -352,6 +372,12 @@ void ListView::InsertItem(unsigned index, UIElement* item, UIElement* parentItem
     if (!item || item->GetParent() == contentElement_)
         return;
 
+    if (virtualMode_)
+    {
+        URHO3D_LOGWARNING("Can not insert items into a ListView in virtual mode, set the virtual item count instead");
+        return;
+    }
+
     // Enable input so that clicking the item can be detected
     item->SetEnabled(true);
     item->SetSelected(false);
@@ -414,7 +440,7 @@ void ListView::InsertItem(unsigned index, UIElement* item, UIElement* parentItem
 
 void ListView::RemoveItem(UIElement* item, unsigned index)
 {
-    if (!item)
+    if (!item || virtualMode_)
         return;
 
     unsigned numItems = GetNumItems();
@@ -495,6 +521,12 @@ void ListView::RemoveItem(unsigned index)
 
 void ListView::RemoveAllItems()
 {
+    if (virtualMode_)
+    {
+        SetVirtualItemCount(0);
+        return;
+    }
+
     contentElement_->DisableLayoutUpdate();
 
     ClearSelection();
@@ -679,8 +711,8 @@ void ListView::ChangeSelection(int delta, bool additive)
         if (newSelection >= numItems)
             break;
 
-        UIElement* item = GetItem(newSelection);
-        if (item->IsVisible())
+        // In virtual mode all items are considered visible, even when not realized
+        if (virtualMode_ || GetItem(newSelection)->IsVisible())
         {
             indices.Push(okSelection = newSelection);
             delta -= direction;
@@ -714,6 +746,12 @@ void ListView::SetHierarchyMode(bool enable)
     if (enable == hierarchyMode_)
         return;
 
+    if (enable && virtualMode_)
+    {
+        URHO3D_LOGWARNING("Hierarchy mode is not supported in virtual mode");
+        return;
+    }
+
     hierarchyMode_ = enable;
     UIElement* container;
     if (enable)
@@ -770,6 +808,78 @@ void ListView::SetSelectOnClickEnd(bool enable)
     }
 }
 
+void ListView::SetVirtualMode(bool enable)
+{
+    if (enable == virtualMode_)
+        return;
+
+    if (enable)
+        SetHierarchyMode(false);
+
+    // Both the owned items and the realized elements are lost during mode change
+    ClearSelection();
+    contentElement_->RemoveAllChildren();
+    realizedItems_.Clear();
+    recycledItems_.Clear();
+    realizedFirst_ = realizedEnd_ = 0;
+
+    virtualMode_ = enable;
+    if (virtualMode_)
+    {
+        UpdateVirtualContentSize();
+        RealizeVirtualItems();
+    }
+    else
+        contentElement_->SetLayoutMode(LM_VERTICAL);
+}
+
+void ListView::SetVirtualItemCount(unsigned count)
+{
+    if (count == virtualItemCount_)
+        return;
+
+    virtualItemCount_ = count;
+    if (!virtualMode_)
+        return;
+
+    // Drop selections beyond the new end of the list
+    if (!selections_.Empty() && selections_.Back() >= count)
+    {
+        PODVector<unsigned> indices;
+        for (PODVector<unsigned>::ConstIterator i = selections_.Begin(); i != selections_.End() && *i < count; ++i)
+            indices.Push(*i);
+        SetSelections(indices);
+    }
+
+    UpdateVirtualContentSize();
+    RealizeVirtualItems();
+}
+
+void ListView::SetVirtualItemHeight(int height)
+{
+    height = Max(height, 1);
+    if (height == virtualItemHeight_)
+        return;
+
+    virtualItemHeight_ = height;
+    if (virtualMode_)
+    {
+        UpdateVirtualContentSize();
+        RealizeVirtualItems(true);
+    }
+}
+
+void ListView::SetVirtualOverscan(unsigned overscan)
+{
+    virtualOverscan_ = overscan;
+    RealizeVirtualItems();
+}
+
+void ListView::RefreshVirtualItems()
+{
+    RealizeVirtualItems(true);
+}
+
 void ListView::Expand(unsigned index, bool enable, bool recursive)
 {
     if (!hierarchyMode_)
@@ -827,18 +937,30 @@ void ListView::ToggleExpand(unsigned index, bool recursive)
 
 unsigned ListView::GetNumItems() const
 {
-    return contentElement_->GetNumChildren();
+    return virtualMode_ ? virtualItemCount_ : contentElement_->GetNumChildren();
 }
 
 UIElement* ListView::GetItem(unsigned index) const
 {
+    if (virtualMode_)
+    {
+        HashMap<unsigned, SharedPtr<UIElement> >::ConstIterator i = realizedItems_.Find(index);
+        return i != realizedItems_.End() ? i->second_.Get() : nullptr;
+    }
+
     return contentElement_->GetChild(index);
 }
 
 PODVector<UIElement*> ListView::GetItems() const
 {
     PODVector<UIElement*> items;
-    contentElement_->GetChildren(items);
+    if (virtualMode_)
+    {
+        for (HashMap<unsigned, SharedPtr<UIElement> >::ConstIterator i = realizedItems_.Begin(); i != realizedItems_.End(); ++i)
+            items.Push(i->second_);
+    }
+    else
+        contentElement_->GetChildren(items);
     return items;
 }
 
@@ -851,6 +973,17 @@ unsigned ListView::FindItem(UIElement* item) const
     if (item->GetParent() != contentElement_)
         return M_MAX_UNSIGNED;
 
+    // Only the realized items have an index in virtual mode; recycled elements are hidden children of the container
+    if (virtualMode_)
+    {
+        for (HashMap<unsigned, SharedPtr<UIElement> >::ConstIterator i = realizedItems_.Begin(); i != realizedItems_.End(); ++i)
+        {
+            if (i->second_ == item)
+                return i->first_;
+        }
+        return M_MAX_UNSIGNED;
+    }
+
     const Vector<SharedPtr<UIElement> >& children = contentElement_->GetChildren();
 
     // Binary search for list item based on screen coordinate Y
@@ -891,7 +1024,7 @@ unsigned ListView::GetSelection() const
 
 UIElement* ListView::GetSelectedItem() const
 {
-    return contentElement_->GetChild(GetSelection());
+    return GetItem(GetSelection());
 }
 
 PODVector<UIElement*> ListView::GetSelectedItems() const
@@ -981,6 +1114,13 @@ void ListView::UpdateSelectionEffect()
     unsigned numItems = GetNumItems();
     bool highlighted = highlightMode_ == HM_ALWAYS || HasFocus();
 
+    if (virtualMode_)
+    {
+        for (HashMap<unsigned, SharedPtr<UIElement> >::ConstIterator i = realizedItems_.Begin(); i != realizedItems_.End(); ++i)
+            i->second_->SetSelected(highlightMode_ != HM_NEVER && highlighted && selections_.Contains(i->first_));
+        return;
+    }
+
     for (unsigned i = 0; i < numItems; ++i)
     {
         UIElement* item = GetItem(i);
@@ -993,6 +1133,26 @@ void ListView::UpdateSelectionEffect()
 
 void ListView::EnsureItemVisibility(unsigned index)
 {
+    if (virtualMode_)
+    {
+        // The item may not be realized, so compute its position from the fixed item height
+        if (index >= virtualItemCount_)
+            return;
+
+        IntVector2 newView = GetViewPosition();
+        const IntRect& clipBorder = scrollPanel_->GetClipBorder();
+        int windowHeight = scrollPanel_->GetHeight() - clipBorder.top_ - clipBorder.bottom_;
+        int itemY = (int)index * virtualItemHeight_;
+
+        if (itemY < newView.y_)
+            newView.y_ = itemY;
+        if (itemY + virtualItemHeight_ > newView.y_ + windowHeight)
+            newView.y_ = itemY + virtualItemHeight_ - windowHeight;
+
+        SetViewPosition(newView);
+        return;
+    }
+
     EnsureItemVisibility(GetItem(index));
 }
 
@@ -1015,6 +1175,120 @@ void ListView::EnsureItemVisibility(UIElement* item)
     SetViewPosition(newView);
 }
 
+void ListView::UpdateVirtualContentSize()
+{
+    // Items are placed manually at fixed intervals, so the container must not stack them
+    if (contentElement_->GetLayoutMode() != LM_FREE)
+        contentElement_->SetLayoutMode(LM_FREE);
+    contentElement_->SetHeight((int)virtualItemCount_ * virtualItemHeight_);
+}
+
+void ListView::RealizeVirtualItems(bool force)
+{
+    if (!virtualMode_ || !contentElement_)
+        return;
+
+    // A style may have re-applied a stacking layout to the item container
+    if (contentElement_->GetLayoutMode() != LM_FREE)
+        UpdateVirtualContentSize();
+
+    const IntRect& panelBorder = scrollPanel_->GetClipBorder();
+    int panelHeight = scrollPanel_->GetHeight() - panelBorder.top_ - panelBorder.bottom_;
+    unsigned first = 0;
+    unsigned end = 0;
+    if (virtualItemCount_ && panelHeight > 0)
+    {
+        first = (unsigned)(viewPosition_.y_ / virtualItemHeight_);
+        end = (unsigned)((viewPosition_.y_ + panelHeight + virtualItemHeight_ - 1) / virtualItemHeight_);
+        first = first > virtualOverscan_ ? first - virtualOverscan_ : 0;
+        end = Min(end + virtualOverscan_, virtualItemCount_);
+        first = Min(first, end);
+    }
+
+    int itemWidth = contentElement_->GetWidth();
+    if (!force && first == realizedFirst_ && end == realizedEnd_)
+    {
+        // Range unchanged, but the container width may have changed
+        for (HashMap<unsigned, SharedPtr<UIElement> >::ConstIterator i = realizedItems_.Begin(); i != realizedItems_.End(); ++i)
+            i->second_->SetWidth(itemWidth);
+        return;
+    }
+
+    realizedFirst_ = first;
+    realizedEnd_ = end;
+
+    // Recycle the items that went out of range
+    for (HashMap<unsigned, SharedPtr<UIElement> >::Iterator i = realizedItems_.Begin(); i != realizedItems_.End();)
+    {
+        if (i->first_ < first || i->first_ >= end)
+        {
+            i->second_->SetVisible(false);
+            i->second_->SetSelected(false);
+            recycledItems_.Push(i->second_);
+            i = realizedItems_.Erase(i);
+        }
+        else
+            ++i;
+    }
+
+    // Make a weak pointer to self to check for destruction as a response to events
+    WeakPtr<ListView> self(this);
+    bool highlighted = highlightMode_ != HM_NEVER && (highlightMode_ == HM_ALWAYS || HasFocus());
+
+    for (unsigned index = first; index < end; ++index)
+    {
+        SharedPtr<UIElement> item;
+        HashMap<unsigned, SharedPtr<UIElement> >::Iterator existing = realizedItems_.Find(index);
+        if (existing != realizedItems_.End())
+        {
+            if (!force)
+            {
+                existing->second_->SetWidth(itemWidth);
+                continue;
+            }
+            item = existing->second_;
+            realizedItems_.Erase(existing);
+        }
+        else if (!recycledItems_.Empty())
+        {
+            item = recycledItems_.Back();
+            recycledItems_.Pop();
+        }
+
+        using namespace VirtualItemRealize;
+
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_ELEMENT] = this;
+        eventData[P_INDEX] = index;
+        eventData[P_ITEM] = item.Get();
+        SendEvent(E_VIRTUALITEMREALIZE, eventData);
+
+        if (self.Expired())
+            return;
+
+        SharedPtr<UIElement> newItem(static_cast<UIElement*>(eventData[P_ITEM].GetPtr()));
+        if (newItem != item && item)
+        {
+            // The handler supplied a different element, so keep the offered one for later reuse
+            item->SetVisible(false);
+            recycledItems_.Push(item);
+        }
+        if (!newItem)
+            continue;
+
+        if (newItem->GetParent() != contentElement_)
+            contentElement_->AddChild(newItem);
+        // Realized items are transient and are not saved along with the list
+        newItem->SetTemporary(true);
+        newItem->SetEnabled(true);
+        newItem->SetVisible(true);
+        newItem->SetPosition(0, (int)index * virtualItemHeight_);
+        newItem->SetSize(itemWidth, virtualItemHeight_);
+        newItem->SetSelected(highlighted && selections_.Contains(index));
+        realizedItems_[index] = newItem;
+    }
+}
+
 void ListView::HandleUIMouseClick(StringHash eventType, VariantMap& eventData)
 {
     // Disregard the click end if a drag is going on
@@ -1154,6 +1428,12 @@ void ListView::HandleFocusChanged(StringHash eventType, VariantMap& eventData)
         UpdateSelectionEffect();
 }
 
+void ListView::HandleViewChanged(StringHash eventType, VariantMap& eventData)
+{
+    if (virtualMode_)
+        RealizeVirtualItems();
+}
+
 void ListView::UpdateUIClickSubscription()
 {
     UnsubscribeFromEvent(E_UIMOUSECLICK);
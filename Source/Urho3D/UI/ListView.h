@@ -115,6 +115,22 @@ public:
     /// @property
     void SetSelectOnClickEnd(bool enable);
 
+    /// \brief Enable virtual mode. Instead of owning an element per item, the list realizes only the items inside the view (plus overscan) by sending VirtualItemRealize events and recycles the elements as the view scrolls.
+    /// All items in the list will be lost during mode change. Hierarchy mode is not supported in virtual mode.
+    /// @property
+    void SetVirtualMode(bool enable);
+    /// Set number of items in virtual mode.
+    /// @property
+    void SetVirtualItemCount(unsigned count);
+    /// Set fixed item height in virtual mode.
+    /// @property
+    void SetVirtualItemHeight(int height);
+    /// Set number of extra items realized above and below the view in virtual mode.
+    /// @property
+    void SetVirtualOverscan(unsigned overscan);
+    /// Re-request the content of all realized items in virtual mode, e.g. after the underlying data changed.
+    void RefreshVirtualItems();
+
     /// Expand item at index. Only has effect in hierarchy mode.
     void Expand(unsigned index, bool enable, bool recursive = false);
     /// Toggle item's expanded flag at index. Only has effect in hierarchy mode.
@@ -123,10 +139,10 @@ public:
     /// Return number of items.
     /// @property
     unsigned GetNumItems() const;
-    /// Return item at index.
+    /// Return item at index. In virtual mode returns null for items that are currently not realized.
     /// @property{get_items}
     UIElement* GetItem(unsigned index) const;
-    /// Return all items.
+    /// Return all items. In virtual mode returns the realized items only.
     PODVector<UIElement*> GetItems() const;
     /// Return index of item, or M_MAX_UNSIGNED If not found.
     unsigned FindItem(UIElement* item) const;
@@ -175,6 +191,22 @@ public:
     /// @property
     int GetBaseIndent() const { return baseIndent_; }
 
+    /// Return whether virtual mode enabled.
+    /// @property
+    bool GetVirtualMode() const { return virtualMode_; }
+
+    /// Return number of items in virtual mode.
+    /// @property
+    unsigned GetVirtualItemCount() const { return virtualItemCount_; }
+
+    /// Return fixed item height in virtual mode.
+    /// @property
+    int GetVirtualItemHeight() const { return virtualItemHeight_; }
+
+    /// Return number of extra items realized above and below the view in virtual mode.
+    /// @property
+    unsigned GetVirtualOverscan() const { return virtualOverscan_; }
+
     /// Ensure full visibility of the item.
     void EnsureItemVisibility(unsigned index);
     /// Ensure full visibility of the item.
@@ -185,6 +217,10 @@ protected:
     bool FilterImplicitAttributes(XMLElement& dest) const override;
     /// Update selection effect when selection or focus changes.
     void UpdateSelectionEffect();
+    /// Update content element size from the item count and height in virtual mode.
+    void UpdateVirtualContentSize();
+    /// Realize the items inside the view in virtual mode and recycle the rest. When forced, re-request also the already realized items.
+    void RealizeVirtualItems(bool force = false);
 
     /// Current selection.
     PODVector<unsigned> selections_;
@@ -202,6 +238,22 @@ protected:
     bool clearSelectionOnDefocus_;
     /// React to click end instead of click start flag.
     bool selectOnClickEnd_;
+    /// Virtual mode flag.
+    bool virtualMode_;
+    /// Number of items in virtual mode.
+    unsigned virtualItemCount_;
+    /// Fixed item height in virtual mode.
+    int virtualItemHeight_;
+    /// Extra items realized above and below the view in virtual mode.
+    unsigned virtualOverscan_;
+    /// Realized items by index in virtual mode.
+    HashMap<unsigned, SharedPtr<UIElement> > realizedItems_;
+    /// Hidden items waiting for reuse in virtual mode.
+    Vector<SharedPtr<UIElement> > recycledItems_;
+    /// First realized index in virtual mode.
+    unsigned realizedFirst_;
+    /// One past the last realized index in virtual mode.
+    unsigned realizedEnd_;
 
 private:
     /// Handle global UI mouseclick to check for selection change.
@@ -212,6 +264,8 @@ private:
     void HandleItemFocusChanged(StringHash eventType, VariantMap& eventData);
     /// Handle focus changed.
     void HandleFocusChanged(StringHash eventType, VariantMap& eventData);
+    /// Handle view changed to realize the newly visible items in virtual mode.
+    void HandleViewChanged(StringHash eventType, VariantMap& eventData);
     /// Update subscription to UI click events.
     void UpdateUIClickSubscription();
 };
@@ -129,11 +129,13 @@ void Text::GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData,
     // If face has changed or char locations are not valid anymore, update before rendering
     if (charLocationsDirty_ || !fontFace_ || face != fontFace_)
         UpdateCharLocations();
-    // If face uses mutable glyphs mechanism, reacquire glyphs before rendering to make sure they are in the texture
+    // If face uses mutable glyphs mechanism, reacquire glyphs before rendering to make sure they are in the texture. The glyphs
+    // may move in the texture, so the batches can not be cached
     else if (face->HasMutableGlyphs())
     {
         for (unsigned i = 0; i < printText_.Size(); ++i)
             face->GetGlyph(printText_[i]);
+        MarkBatchesDirty();
     }
 
     // Hovering and/or whole selection batch
@@ -174,13 +176,36 @@ void Text::GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData,
         UIBatch::AddOrMerge(batch, batches);
     }
 
-    // Text batch
-    TextEffect textEffect = font_->IsSDFFont() ? TE_NONE : textEffect_;
+    // Text batch. The glyph quads are generated again only when the text, its appearance or position has changed
     const Vector<SharedPtr<Texture2D> >& textures = face->GetTextures();
-    for (unsigned n = 0; n < textures.Size() && n < pageGlyphLocations_.Size(); ++n)
+    unsigned numPages = Min(textures.Size(), pageGlyphLocations_.Size());
+    if (glyphVertexFace_ != face || glyphVertexVersion_ != GetBatchVersion() || pageVertexEnds_.Size() != numPages)
+        UpdateGlyphVertexData(face, currentScissor);
+
+    unsigned pageStart = 0;
+    for (unsigned n = 0; n < numPages; ++n)
     {
         // One batch per texture/page
         UIBatch pageBatch(this, BLEND_ALPHA, currentScissor, textures[n], &vertexData);
+        vertexData.Insert(vertexData.End(), glyphVertexData_.Begin() + pageStart, glyphVertexData_.Begin() + pageVertexEnds_[n]);
+        pageBatch.vertexEnd_ = vertexData.Size();
+        pageStart = pageVertexEnds_[n];
+
+        UIBatch::AddOrMerge(pageBatch, batches);
+    }
+}
+
+void Text::UpdateGlyphVertexData(FontFace* face, const IntRect& currentScissor)
+{
+    TextEffect textEffect = font_->IsSDFFont() ? TE_NONE : textEffect_;
+    const Vector<SharedPtr<Texture2D> >& textures = face->GetTextures();
+    unsigned numPages = Min(textures.Size(), pageGlyphLocations_.Size());
+
+    glyphVertexData_.Clear();
+    pageVertexEnds_.Resize(numPages);
+    for (unsigned n = 0; n < numPages; ++n)
+    {
+        UIBatch pageBatch(this, BLEND_ALPHA, currentScissor, textures[n], &glyphVertexData_);
 
         const PODVector<GlyphLocation>& pageGlyphLocation = pageGlyphLocations_[n];
 
@@ -233,8 +258,11 @@ void Text::GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData,
             break;
         }
 
-        UIBatch::AddOrMerge(pageBatch, batches);
+        pageVertexEnds_[n] = glyphVertexData_.Size();
     }
+
+    glyphVertexFace_ = face;
+    glyphVertexVersion_ = GetBatchVersion();
 }
 
 void Text::OnResize(const IntVector2& newSize, const IntVector2& delta)
@@ -248,6 +276,7 @@ void Text::OnResize(const IntVector2& newSize, const IntVector2& delta)
 void Text::OnIndentSet()
 {
     charLocationsDirty_ = true;
+    MarkBatchesDirty();
 }
 
 bool Text::SetFont(const String& fontName, float size)
@@ -314,6 +343,7 @@ void Text::SetTextAlignment(HorizontalAlignment align)
     {
         textAlignment_ = align;
         charLocationsDirty_ = true;
+        MarkBatchesDirty();
     }
 }
 
@@ -373,37 +403,44 @@ void Text::SetSelection(unsigned start, unsigned length)
     selectionStart_ = start;
     selectionLength_ = length;
     ValidateSelection();
+    MarkBatchesDirty();
 }
 
 void Text::ClearSelection()
 {
     selectionStart_ = 0;
     selectionLength_ = 0;
+    MarkBatchesDirty();
 }
 
 void Text::SetTextEffect(TextEffect textEffect)
 {
     textEffect_ = textEffect;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectShadowOffset(const IntVector2& offset)
 {
     shadowOffset_ = offset;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectStrokeThickness(int thickness)
 {
     strokeThickness_ = Abs(thickness);
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectRoundStroke(bool roundStroke)
 {
     roundStroke_ = roundStroke;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectColor(const Color& effectColor)
 {
     effectColor_ = effectColor;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectDepthBias(float bias)
@@ -486,14 +523,18 @@ bool Text::FilterImplicitAttributes(XMLElement& dest) const
 
 void Text::UpdateText(bool onResize)
 {
-    rowWidths_.Clear();
-    printText_.Clear();
+    MarkBatchesDirty();
 
     if (font_)
     {
         FontFace* face = font_->GetFace(fontSize_);
         if (!face)
+        {
+            rowWidths_.Clear();
+            printText_.Clear();
+            layoutFace_.Reset();
             return;
+        }
 
         rowHeight_ = face->GetRowHeight();
 
@@ -502,143 +543,164 @@ void Text::UpdateText(bool onResize)
         int rowWidth = 0;
         auto rowHeight = RoundToInt(rowSpacing_ * rowHeight_);
 
-        // First see if the text must be split up
-        if (!wordWrap_)
+        // Reuse the previous layout if nothing affecting it has changed, for example when the same text is set again
+        int maxWidth = wordWrap_ ? GetWidth() : 0;
+        if (layoutFace_ == face && layoutWordWrap_ == wordWrap_ && layoutMaxWidth_ == maxWidth && layoutRowSpacing_ == rowSpacing_ &&
+            layoutText_ == unicodeText_)
         {
-            printText_ = unicodeText_;
-            printToText_.Resize(printText_.Size());
-            for (unsigned i = 0; i < printText_.Size(); ++i)
-                printToText_[i] = i;
+            width = layoutSize_.x_;
+            height = layoutSize_.y_;
         }
         else
         {
-            int maxWidth = GetWidth();
-            unsigned nextBreak = 0;
-            unsigned lineStart = 0;
-            printToText_.Clear();
+            rowWidths_.Clear();
+            printText_.Clear();
 
-            for (unsigned i = 0; i < unicodeText_.Size(); ++i)
+            // First see if the text must be split up
+            if (!wordWrap_)
+            {
+                printText_ = unicodeText_;
+                printToText_.Resize(printText_.Size());
+                for (unsigned i = 0; i < printText_.Size(); ++i)
+                    printToText_[i] = i;
+            }
+            else
             {
-                unsigned j;
-                unsigned c = unicodeText_[i];
+                    unsigned nextBreak = 0;
+                unsigned lineStart = 0;
+                printToText_.Clear();
 
-                if (c != '\n')
+                for (unsigned i = 0; i < unicodeText_.Size(); ++i)
                 {
-                    bool ok = true;
+                    unsigned j;
+                    unsigned c = unicodeText_[i];
 
-                    if (nextBreak <= i)
+                    if (c != '\n')
                     {
-                        int futureRowWidth = rowWidth;
-                        for (j = i; j < unicodeText_.Size(); ++j)
+                        bool ok = true;
+
+                        if (nextBreak <= i)
                         {
-                            unsigned d = unicodeText_[j];
-                            if (d == ' ' || d == '\n')
-                            {
-                                nextBreak = j;
-                                break;
-                            }
-                            const FontGlyph* glyph = face->GetGlyph(d);
-                            if (glyph)
+                            int futureRowWidth = rowWidth;
+                            for (j = i; j < unicodeText_.Size(); ++j)
                             {
-                                futureRowWidth += glyph->advanceX_;
-                                if (j < unicodeText_.Size() - 1)
-                                    futureRowWidth += face->GetKerning(d, unicodeText_[j + 1]);
+                                unsigned d = unicodeText_[j];
+                                if (d == ' ' || d == '\n')
+                                {
+                                    nextBreak = j;
+                                    break;
+                                }
+                                const FontGlyph* glyph = face->GetGlyph(d);
+                                if (glyph)
+                                {
+                                    futureRowWidth += glyph->advanceX_;
+                                    if (j < unicodeText_.Size() - 1)
+                                        futureRowWidth += face->GetKerning(d, unicodeText_[j + 1]);
+                                }
+                                if (d == '-' && futureRowWidth <= maxWidth)
+                                {
+                                    nextBreak = j + 1;
+                                    break;
+                                }
+                                if (futureRowWidth > maxWidth)
+                                {
+                                    ok = false;
+                                    break;
+                                }
                             }
-                            if (d == '-' && futureRowWidth <= maxWidth)
+                        }
+
+                        if (!ok)
+                        {
+                            // If did not find any breaks on the line, copy until j, or at least 1 char, to prevent infinite loop
+                            if (nextBreak == lineStart)
                             {
-                                nextBreak = j + 1;
-                                break;
+                                while (i < j)
+                                {
+                                    printText_.Push(unicodeText_[i]);
+                                    printToText_.Push(i);
+                                    ++i;
+                                }
                             }
-                            if (futureRowWidth > maxWidth)
+                            // Eliminate spaces that have been copied before the forced break
+                            while (printText_.Size() && printText_.Back() == ' ')
                             {
-                                ok = false;
-                                break;
+                                printText_.Pop();
+                                printToText_.Pop();
                             }
+                            printText_.Push('\n');
+                            printToText_.Push(Min(i, unicodeText_.Size() - 1));
+                            rowWidth = 0;
+                            nextBreak = lineStart = i;
                         }
-                    }
 
-                    if (!ok)
-                    {
-                        // If did not find any breaks on the line, copy until j, or at least 1 char, to prevent infinite loop
-                        if (nextBreak == lineStart)
+                        if (i < unicodeText_.Size())
                         {
-                            while (i < j)
+                            // When copying a space, position is allowed to be over row width
+                            c = unicodeText_[i];
+                            const FontGlyph* glyph = face->GetGlyph(c);
+                            if (glyph)
                             {
-                                printText_.Push(unicodeText_[i]);
+                                rowWidth += glyph->advanceX_;
+                                if (i < unicodeText_.Size() - 1)
+                                    rowWidth += face->GetKerning(c, unicodeText_[i + 1]);
+                            }
+                            if (rowWidth <= maxWidth)
+                            {
+                                printText_.Push(c);
                                 printToText_.Push(i);
-                                ++i;
                             }
                         }
-                        // Eliminate spaces that have been copied before the forced break
-                        while (printText_.Size() && printText_.Back() == ' ')
-                        {
-                            printText_.Pop();
-                            printToText_.Pop();
-                        }
+                    }
+                    else
+                    {
                         printText_.Push('\n');
                         printToText_.Push(Min(i, unicodeText_.Size() - 1));
                         rowWidth = 0;
                         nextBreak = lineStart = i;
                     }
+                }
+            }
+
+            rowWidth = 0;
 
-                    if (i < unicodeText_.Size())
+            for (unsigned i = 0; i < printText_.Size(); ++i)
+            {
+                unsigned c = printText_[i];
+
+                if (c != '\n')
+                {
+                    const FontGlyph* glyph = face->GetGlyph(c);
+                    if (glyph)
                     {
-                        // When copying a space, position is allowed to be over row width
-                        c = unicodeText_[i];
-                        const FontGlyph* glyph = face->GetGlyph(c);
-                        if (glyph)
-                        {
-                            rowWidth += glyph->advanceX_;
-                            if (i < unicodeText_.Size() - 1)
-                                rowWidth += face->GetKerning(c, unicodeText_[i + 1]);
-                        }
-                        if (rowWidth <= maxWidth)
-                        {
-                            printText_.Push(c);
-                            printToText_.Push(i);
-                        }
+                        rowWidth += glyph->advanceX_;
+                        if (i < printText_.Size() - 1)
+                            rowWidth += face->GetKerning(c, printText_[i + 1]);
                     }
                 }
                 else
                 {
-                    printText_.Push('\n');
-                    printToText_.Push(Min(i, unicodeText_.Size() - 1));
+                    width = Max(width, rowWidth);
+                    height += rowHeight;
+                    rowWidths_.Push(rowWidth);
                     rowWidth = 0;
-                    nextBreak = lineStart = i;
                 }
             }
-        }
-
-        rowWidth = 0;
-
-        for (unsigned i = 0; i < printText_.Size(); ++i)
-        {
-            unsigned c = printText_[i];
 
-            if (c != '\n')
-            {
-                const FontGlyph* glyph = face->GetGlyph(c);
-                if (glyph)
-                {
-                    rowWidth += glyph->advanceX_;
-                    if (i < printText_.Size() - 1)
-                        rowWidth += face->GetKerning(c, printText_[i + 1]);
-                }
-            }
-            else
+            if (rowWidth)
             {
                 width = Max(width, rowWidth);
                 height += rowHeight;
                 rowWidths_.Push(rowWidth);
-                rowWidth = 0;
             }
-        }
 
-        if (rowWidth)
-        {
-            width = Max(width, rowWidth);
-            height += rowHeight;
-            rowWidths_.Push(rowWidth);
+            layoutFace_ = face;
+            layoutWordWrap_ = wordWrap_;
+            layoutMaxWidth_ = maxWidth;
+            layoutRowSpacing_ = rowSpacing_;
+            layoutText_ = unicodeText_;
+            layoutSize_ = IntVector2(width, height);
+            charLocationsDirty_ = true;
         }
 
         // Set at least one row height even if text is empty
@@ -657,13 +719,14 @@ void Text::UpdateText(bool onResize)
             }
         }
         SetFixedHeight(height);
-
-        charLocationsDirty_ = true;
     }
     else
     {
         // No font, nothing to render
+        rowWidths_.Clear();
+        printText_.Clear();
         pageGlyphLocations_.Clear();
+        layoutFace_.Reset();
     }
 
     // If wordwrap is on, parent may need layout update to correct for overshoot in size. However, do not do this when the
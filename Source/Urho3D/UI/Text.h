@@ -243,6 +243,8 @@ protected:
     void ValidateSelection();
     /// Return row start X position.
     int GetRowStartPosition(unsigned rowIndex) const;
+    /// Generate the glyph quads of the text into the cached vertex data.
+    void UpdateGlyphVertexData(FontFace* face, const IntRect& currentScissor);
     /// Construct batch.
     void ConstructBatch
         (UIBatch& pageBatch, const PODVector<GlyphLocation>& pageGlyphLocation, float dx = 0, float dy = 0, Color* color = nullptr,
@@ -294,6 +296,26 @@ protected:
     Vector<PODVector<GlyphLocation> > pageGlyphLocations_;
     /// Cached locations of each character in the text.
     PODVector<CharLocation> charLocations_;
+    /// Text the current layout was made for.
+    PODVector<unsigned> layoutText_;
+    /// Font face the current layout was made with.
+    WeakPtr<FontFace> layoutFace_;
+    /// Wordwrap width the current layout was made with, zero when not wordwrapping.
+    int layoutMaxWidth_{};
+    /// Wordwrap mode the current layout was made with.
+    bool layoutWordWrap_{};
+    /// Row spacing the current layout was made with.
+    float layoutRowSpacing_{};
+    /// Text size of the current layout.
+    IntVector2 layoutSize_;
+    /// Cached vertex data of the glyph quads.
+    PODVector<float> glyphVertexData_;
+    /// End of each texture page's quads in the cached vertex data.
+    PODVector<unsigned> pageVertexEnds_;
+    /// Font face the cached glyph quads were made with.
+    WeakPtr<FontFace> glyphVertexFace_;
+    /// Batch version the cached glyph quads were made with.
+    unsigned glyphVertexVersion_{};
     /// The text will be automatically translated.
     bool autoLocalizable_;
     /// Localization string id storage. Used when autoLocalizable flag is set.
@@ -86,6 +86,8 @@ const float DEFAULT_DRAGBEGIN_INTERVAL = 0.5f;
 const float DEFAULT_TOOLTIP_DELAY = 0.5f;
 const int DEFAULT_DRAGBEGIN_DISTANCE = 5;
 const int DEFAULT_FONT_TEXTURE_MAX_SIZE = 2048;
+const int HIT_TEST_CELL_SIZE = 64;
+const int MAX_HIT_TEST_CELLS = 4096;
 
 const char* UI_CATEGORY = "UI";
 
@@ -116,6 +118,8 @@ UI::UI(Context* context) :
     useScreenKeyboard_(false),
 #endif
     useMutableGlyphs_(false),
+    useThreadedGlyphRendering_(true),
+    useHitTestGrid_(true),
     forceAutoHint_(false),
     fontHintLevel_(FONT_HINT_LEVEL_NORMAL),
     fontSubpixelThreshold_(12),
@@ -209,6 +213,7 @@ void UI::SetFocusElement(UIElement* element, bool byKey)
     {
         UIElement* oldFocusElement = focusElement_;
         focusElement_.Reset();
+        oldFocusElement->MarkBatchesDirty();
 
         VariantMap& focusEventData = GetEventDataMap();
         focusEventData[Defocused::P_ELEMENT] = oldFocusElement;
@@ -219,6 +224,7 @@ void UI::SetFocusElement(UIElement* element, bool byKey)
     if (element && element->GetFocusMode() >= FM_FOCUSABLE)
     {
         focusElement_ = element;
+        element->MarkBatchesDirty();
 
         VariantMap& focusEventData = GetEventDataMap();
         focusEventData[Focused::P_ELEMENT] = element;
@@ -421,6 +427,25 @@ void UI::RenderUpdate()
     // If the OS cursor is visible, do not render the UI's own cursor
     bool osCursorVisible = GetSubsystem<Input>()->IsMouseVisible();
 
+    // Release the cache textures of destroyed elements and those no longer cached. Textures of hidden elements are kept, as
+    // they may still be referenced by the cached batches of an ancestor
+    for (auto it = textureCaches_.Begin(); it != textureCaches_.End();)
+    {
+        if (it->second_.element_.Expired() || !it->second_.element_->GetCacheAsTexture())
+            it = textureCaches_.Erase(it);
+        else
+            ++it;
+    }
+
+    // Release the hit test grids of destroyed root elements
+    for (auto it = hitTestGrids_.Begin(); it != hitTestGrids_.End();)
+    {
+        if (it->second_.rootElement_.Expired())
+            it = hitTestGrids_.Erase(it);
+        else
+            ++it;
+    }
+
     // Get rendering batches from the non-modal UI elements
     batches_.Clear();
     vertexData_.Clear();
@@ -491,6 +516,9 @@ void UI::Render(bool renderUICommand)
             cursor_->ApplyOSCursorShape();
     }
 
+    // Update the cache textures first, as the batches of this frame composite them
+    RenderTextureCaches();
+
     // Perform the default backbuffer render only if not rendered yet, or additional renders through RenderUI command
     if (renderUICommand || !uiRendered_)
     {
@@ -696,6 +724,22 @@ void UI::SetUseMutableGlyphs(bool enable)
     }
 }
 
+void UI::SetUseThreadedGlyphRendering(bool enable)
+{
+    if (enable != useThreadedGlyphRendering_)
+    {
+        useThreadedGlyphRendering_ = enable;
+        ReleaseFontFaces();
+    }
+}
+
+void UI::SetUseHitTestGrid(bool enable)
+{
+    useHitTestGrid_ = enable;
+    if (!useHitTestGrid_)
+        hitTestGrids_.Clear();
+}
+
 void UI::SetForceAutoHint(bool enable)
 {
     if (enable != forceAutoHint_)
@@ -839,7 +883,8 @@ UIElement* UI::GetElementAt(UIElement* root, const IntVector2& position, bool en
     }
 
     UIElement* result = nullptr;
-    GetElementAt(result, root, positionCopy, enabledOnly);
+    if (!useHitTestGrid_ || !GetElementAtGrid(result, root, positionCopy, enabledOnly))
+        GetElementAt(result, root, positionCopy, enabledOnly);
     return result;
 }
 
@@ -1134,13 +1179,7 @@ void UI::Render(VertexBuffer* buffer, const PODVector<UIBatch>& batches, unsigne
         {
             // Update custom shader parameters if needed
             if (graphics_->NeedParameterUpdate(SP_MATERIAL, reinterpret_cast<const void*>(batch.customMaterial_->GetShaderParameterHash())))
-            {
-                auto shader_parameters = batch.customMaterial_->GetShaderParameters();
-                for (auto it = shader_parameters.Begin(); it != shader_parameters.End(); ++it)
-                {
-                    graphics_->SetShaderParameter(it->second_.name_, it->second_.value_);
-                }
-            }
+                graphics_->SetMaterialShaderParameters(batch.customMaterial_);
             // Apply custom shader textures
             auto textures = batch.customMaterial_->GetTextures();
             for (auto it = textures.Begin(); it != textures.End(); ++it)
@@ -1164,7 +1203,38 @@ void UI::Render(VertexBuffer* buffer, const PODVector<UIBatch>& batches, unsigne
     }
 }
 
-void UI::GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, UIElement* element, IntRect currentScissor)
+void UI::GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, UIElement* element, IntRect currentScissor,
+    PODVector<UIBatchCacheEntry>* cacheEntries)
+{
+    if (element->GetCacheAsTexture() && GetTextureCacheBatches(batches, vertexData, element, currentScissor, cacheEntries))
+        return;
+
+    UIBatchCache* cache = element->GetBatchCache();
+    if (!cache)
+    {
+        GetChildBatches(batches, vertexData, element, currentScissor, cacheEntries);
+        return;
+    }
+
+    // Regenerate the cached batches only when an element of the subtree has changed
+    if (!cache->Validate(currentScissor))
+    {
+        cache->Clear();
+        cache->scissor_ = currentScissor;
+        UIBatchCacheEntry entry{element, element->GetBatchVersion(), false, false, false};
+        cache->entries_.Push(entry);
+        GetChildBatches(cache->batches_, cache->vertexData_, element, currentScissor, &cache->entries_);
+        cache->valid_ = true;
+    }
+
+    cache->AppendTo(batches, vertexData);
+    // When inside another cached subtree, its validity also depends on the elements of this one
+    if (cacheEntries)
+        cacheEntries->Push(cache->entries_);
+}
+
+void UI::GetChildBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, UIElement* element, IntRect currentScissor,
+    PODVector<UIBatchCacheEntry>* cacheEntries)
 {
     // Set clipping scissor for child elements. No need to draw if zero size
     element->AdjustScissor(currentScissor);
@@ -1187,15 +1257,14 @@ void UI::GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, U
             int currentPriority = (*i)->GetPriority();
             while (j != children.End() && (*j)->GetPriority() == currentPriority)
             {
-                if ((*j)->IsWithinScissor(currentScissor) && (*j) != cursor_)
-                    (*j)->GetBatches(batches, vertexData, currentScissor);
+                GetElementBatches(batches, vertexData, *j, currentScissor, cacheEntries);
                 ++j;
             }
             // Now recurse into the children
             while (i != j)
             {
                 if ((*i)->IsVisible() && (*i) != cursor_)
-                    GetBatches(batches, vertexData, *i, currentScissor);
+                    GetBatches(batches, vertexData, *i, currentScissor, cacheEntries);
                 ++i;
             }
         }
@@ -1205,18 +1274,161 @@ void UI::GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, U
     {
         while (i != children.End())
         {
-            if ((*i) != cursor_)
-            {
-                if ((*i)->IsWithinScissor(currentScissor))
-                    (*i)->GetBatches(batches, vertexData, currentScissor);
-                if ((*i)->IsVisible())
-                    GetBatches(batches, vertexData, *i, currentScissor);
-            }
+            GetElementBatches(batches, vertexData, *i, currentScissor, cacheEntries);
+            if ((*i)->IsVisible() && (*i) != cursor_)
+                GetBatches(batches, vertexData, *i, currentScissor, cacheEntries);
             ++i;
         }
     }
 }
 
+void UI::GetElementBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, UIElement* element, const IntRect& currentScissor,
+    PODVector<UIBatchCacheEntry>* cacheEntries)
+{
+    bool drawn = element->IsWithinScissor(currentScissor) && element != cursor_;
+
+    // Record also the elements that are not drawn, as becoming visible or moving inside the scissor changes the batches
+    unsigned entryIndex = 0;
+    if (cacheEntries)
+    {
+        entryIndex = cacheEntries->Size();
+        bool hovering = element->IsHovering();
+        UIBatchCacheEntry entry{element, element->GetBatchVersion(), drawn, hovering, hovering};
+        cacheEntries->Push(entry);
+    }
+
+    if (drawn)
+    {
+        element->GetBatches(batches, vertexData, currentScissor);
+        if (cacheEntries)
+            (*cacheEntries)[entryIndex].hoveringAfter_ = element->IsHovering();
+    }
+}
+
+bool UI::GetTextureCacheBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, UIElement* element, const IntRect& currentScissor,
+    PODVector<UIBatchCacheEntry>* cacheEntries)
+{
+    if (!graphics_ || !graphics_->IsInitialized())
+        return false;
+
+    const IntVector2& size = element->GetSize();
+    int width = (int)(size.x_ * uiScale_ + 0.5f);
+    int height = (int)(size.y_ * uiScale_ + 0.5f);
+    if (width <= 0 || height <= 0)
+        return true;
+
+    // Check also that the entry is not left over from a destroyed element at the same address
+    TextureCacheData& data = textureCaches_[element];
+    if (data.element_.Get() != element)
+    {
+        data.element_ = element;
+        data.texture_ = new Texture2D(context_);
+        data.vertexBuffer_ = new VertexBuffer(context_);
+        data.batchCache_.Clear();
+        data.rendered_ = false;
+    }
+
+    if (data.texture_->GetWidth() != width || data.texture_->GetHeight() != height)
+    {
+        data.texture_->SetNumLevels(1);
+        if (!data.texture_->SetSize(width, height, Graphics::GetRGBAFormat(), TEXTURE_RENDERTARGET))
+        {
+            URHO3D_LOGERROR("Failed to create cache texture for UI element " + element->GetName());
+            textureCaches_.Erase(element);
+            return false;
+        }
+        data.texture_->SetFilterMode(FILTER_NEAREST);
+        data.rendered_ = false;
+    }
+    if (data.texture_->IsDataLost())
+    {
+        data.texture_->ClearDataLost();
+        data.rendered_ = false;
+    }
+
+    // The child elements are rendered clipped only by the element itself, the ancestors' clipping applies to the composited quad
+    const IntVector2& screenPos = element->GetScreenPosition();
+    IntRect rect(screenPos.x_, screenPos.y_, screenPos.x_ + size.x_, screenPos.y_ + size.y_);
+    UIBatchCache& cache = data.batchCache_;
+    if (!cache.Validate(rect))
+    {
+        cache.Clear();
+        cache.scissor_ = rect;
+        UIBatchCacheEntry entry{element, element->GetBatchVersion(), false, false, false};
+        cache.entries_.Push(entry);
+        GetChildBatches(cache.batches_, cache.vertexData_, element, rect, &cache.entries_);
+
+        // Make the batches relative to the texture
+        Vector2 offset((float)screenPos.x_, (float)screenPos.y_);
+        for (unsigned i = 0; i < cache.vertexData_.Size(); i += UI_VERTEX_SIZE)
+        {
+            cache.vertexData_[i] -= offset.x_;
+            cache.vertexData_[i + 1] -= offset.y_;
+        }
+        for (PODVector<UIBatch>::Iterator i = cache.batches_.Begin(); i != cache.batches_.End(); ++i)
+        {
+            i->scissor_.left_ -= screenPos.x_;
+            i->scissor_.top_ -= screenPos.y_;
+            i->scissor_.right_ -= screenPos.x_;
+            i->scissor_.bottom_ -= screenPos.y_;
+        }
+
+        cache.valid_ = true;
+        data.rendered_ = false;
+    }
+
+    // The texture holds the child elements blended over transparent black, so the colors are premultiplied
+    UIBatch batch(element, BLEND_PREMULALPHA, currentScissor, data.texture_, &vertexData);
+    batch.SetColor(Color::WHITE, true);
+    batch.AddQuad(0.0f, 0.0f, (float)size.x_, (float)size.y_, 0, 0, width, height);
+    UIBatch::AddOrMerge(batch, batches);
+
+    if (cacheEntries)
+        cacheEntries->Push(cache.entries_);
+    return true;
+}
+
+void UI::RenderTextureCaches()
+{
+    RenderSurface* renderTarget = nullptr;
+    RenderSurface* depthStencil = nullptr;
+    IntRect viewport;
+    bool rendered = false;
+
+    for (auto& item : textureCaches_)
+    {
+        TextureCacheData& data = item.second_;
+        if (data.rendered_ || data.element_.Expired() || !data.texture_->GetWidth())
+            continue;
+
+        if (!rendered)
+        {
+            renderTarget = graphics_->GetRenderTarget(0);
+            depthStencil = graphics_->GetDepthStencil();
+            viewport = graphics_->GetViewport();
+            rendered = true;
+        }
+
+        SetVertexData(data.vertexBuffer_, data.batchCache_.vertexData_);
+
+        RenderSurface* surface = data.texture_->GetRenderSurface();
+        graphics_->SetDepthStencil(surface->GetLinkedDepthStencil());
+        graphics_->SetRenderTarget(0, surface);
+        graphics_->SetViewport(IntRect(0, 0, surface->GetWidth(), surface->GetHeight()));
+        graphics_->Clear(CLEAR_COLOR, Color::TRANSPARENT_BLACK);
+
+        Render(data.vertexBuffer_, data.batchCache_.batches_, 0, data.batchCache_.batches_.Size());
+        data.rendered_ = true;
+    }
+
+    if (rendered)
+    {
+        graphics_->SetRenderTarget(0, renderTarget);
+        graphics_->SetDepthStencil(depthStencil);
+        graphics_->SetViewport(viewport);
+    }
+}
+
 void UI::GetElementAt(UIElement*& result, UIElement* current, const IntVector2& position, bool enabledOnly)
 {
     if (!current)
@@ -1290,6 +1502,126 @@ void UI::GetElementAt(UIElement*& result, UIElement* current, const IntVector2&
     }
 }
 
+bool UI::GetElementAtGrid(UIElement*& result, UIElement* root, const IntVector2& position, bool enabledOnly)
+{
+    HitTestGrid& grid = hitTestGrids_[root];
+    if (grid.rootElement_.Get() != root || grid.geometryVersion_ != UIElement::GetGeometryVersion())
+        BuildHitTestGrid(grid, root);
+
+    if (grid.rect_.IsInside(position) != INSIDE)
+        return false;
+
+    int cellX = (position.x_ - grid.rect_.left_) / grid.cellSize_;
+    int cellY = (position.y_ - grid.rect_.top_) / grid.cellSize_;
+    const PODVector<unsigned>& cell = grid.cells_[cellY * grid.numCellsX_ + cellX];
+
+    // The entries are in traversal order, so the last one containing the position is the topmost
+    for (unsigned i = cell.Size(); i-- > 0;)
+    {
+        const HitTestEntry& entry = grid.entries_[cell[i]];
+        if (entry.rect_.IsInside(position) != INSIDE)
+            continue;
+
+        UIElement* element = entry.element_;
+        if (entry.transformed_)
+        {
+            // Test the element and its children the same way as the recursive GetElementAt()
+            bool inside = element->IsInside(position, true);
+            if (inside && (element->IsEnabled() || !enabledOnly))
+                result = element;
+            if (element->GetNumChildren() && (inside || element->IsInsideCombined(position, true)))
+                GetElementAt(result, element, position, enabledOnly);
+            if (result)
+                return true;
+        }
+        else if (element->IsEnabled() || !enabledOnly)
+        {
+            result = element;
+            return true;
+        }
+    }
+
+    return true;
+}
+
+void UI::BuildHitTestGrid(HitTestGrid& grid, UIElement* root)
+{
+    URHO3D_PROFILE(BuildHitTestGrid);
+
+    const IntVector2& rootPos = root->GetScreenPosition();
+    const IntVector2& rootSize = root->GetSize();
+
+    // Grow the cells for very large roots to keep the grid size bounded
+    int cellSize = HIT_TEST_CELL_SIZE;
+    while ((rootSize.x_ / cellSize + 1) * (rootSize.y_ / cellSize + 1) > MAX_HIT_TEST_CELLS)
+        cellSize *= 2;
+
+    grid.rootElement_ = root;
+    grid.entries_.Clear();
+    grid.rect_ = IntRect(rootPos.x_, rootPos.y_, rootPos.x_ + Max(rootSize.x_, 0), rootPos.y_ + Max(rootSize.y_, 0));
+    grid.cellSize_ = cellSize;
+    grid.numCellsX_ = (grid.rect_.Width() + cellSize - 1) / cellSize;
+    int numCellsY = (grid.rect_.Height() + cellSize - 1) / cellSize;
+    grid.cells_.Resize((unsigned)(grid.numCellsX_ * numCellsY));
+    for (unsigned i = 0; i < grid.cells_.Size(); ++i)
+        grid.cells_[i].Clear();
+
+    // Positions outside the root are rejected before hit testing, so the root rect acts as the initial clip rect
+    AddHitTestEntries(grid, root, grid.rect_);
+
+    grid.geometryVersion_ = UIElement::GetGeometryVersion();
+}
+
+void UI::AddHitTestEntries(HitTestGrid& grid, UIElement* element, const IntRect& clipRect)
+{
+    if (clipRect.Width() <= 0 || clipRect.Height() <= 0)
+        return;
+
+    element->SortChildren();
+    const Vector<SharedPtr<UIElement> >& children = element->GetChildren();
+
+    for (unsigned i = 0; i < children.Size(); ++i)
+    {
+        UIElement* child = children[i];
+        if (child == cursor_.Get() || !child->IsVisible())
+            continue;
+
+        HitTestEntry entry;
+        entry.element_ = child;
+        // Sprites can be rotated and scaled, so their screen rect is not known. Test them and their children by traversal
+        entry.transformed_ = child->IsInstanceOf<Sprite>();
+        if (entry.transformed_)
+            entry.rect_ = clipRect;
+        else
+        {
+            const IntVector2& screenPos = child->GetScreenPosition();
+            const IntVector2& size = child->GetSize();
+            entry.rect_ = IntRect(screenPos.x_, screenPos.y_, screenPos.x_ + size.x_, screenPos.y_ + size.y_);
+            entry.rect_.Clip(clipRect);
+        }
+
+        if (entry.rect_.Width() > 0 && entry.rect_.Height() > 0)
+        {
+            unsigned index = grid.entries_.Size();
+            grid.entries_.Push(entry);
+
+            int left = (entry.rect_.left_ - grid.rect_.left_) / grid.cellSize_;
+            int right = (entry.rect_.right_ - 1 - grid.rect_.left_) / grid.cellSize_;
+            int top = (entry.rect_.top_ - grid.rect_.top_) / grid.cellSize_;
+            int bottom = (entry.rect_.bottom_ - 1 - grid.rect_.top_) / grid.cellSize_;
+            for (int y = top; y <= bottom; ++y)
+            {
+                for (int x = left; x <= right; ++x)
+                    grid.cells_[y * grid.numCellsX_ + x].Push(index);
+            }
+        }
+
+        // Children which are not clipped may extend outside their parent, so they are clipped only by the ancestors
+        if (!entry.transformed_ && child->GetNumChildren())
+            AddHitTestEntries(grid, child, child->GetClipChildren() ? entry.rect_ : clipRect);
+    }
+}
+
 UIElement* UI::GetFocusableElement(UIElement* element)
 {
     while (element)
@@ -1810,6 +2142,9 @@ void UI::HandleMouseMove(StringHash eventType, VariantMap& eventData)
 
     if (cursor_)
     {
+        // The cursor is not hit tested, so moving it does not invalidate the hit test grids built before
+        unsigned geometryVersion = UIElement::GetGeometryVersion();
+
         if (!input->IsMouseVisible())
         {
             if (!input->IsMouseLocked())
@@ -1829,6 +2164,15 @@ void UI::HandleMouseMove(StringHash eventType, VariantMap& eventData)
             // Absolute mouse motion: move always
             cursor_->SetPosition(ConvertSystemToUI(mousePos));
         }
+
+        if (UIElement::GetGeometryVersion() != geometryVersion)
+        {
+            for (auto& item : hitTestGrids_)
+            {
+                if (item.second_.geometryVersion_ == geometryVersion)
+                    item.second_.geometryVersion_ = UIElement::GetGeometryVersion();
+            }
+        }
     }
 
     IntVector2 cursorPos;
@@ -124,6 +124,12 @@ public:
     /// Set whether to use mutable (eraseable) glyphs to ensure a font face never expands to more than one texture. Default false.
     /// @property
     void SetUseMutableGlyphs(bool enable);
+    /// Set whether to render the glyphs of FreeType fonts in a worker thread. The glyphs appear once rendered, which avoids stalls when many new glyphs are needed at once. Default true.
+    /// @property
+    void SetUseThreadedGlyphRendering(bool enable);
+    /// Set whether to accelerate hit testing with a grid of element screen rects, which is rebuilt when element geometry or hierarchy changes. Default true.
+    /// @property
+    void SetUseHitTestGrid(bool enable);
     /// Set whether to force font autohinting instead of using FreeType's TTF bytecode interpreter.
     /// @property
     void SetForceAutoHint(bool enable);
@@ -234,6 +240,14 @@ public:
     /// @property
     bool GetUseMutableGlyphs() const { return useMutableGlyphs_; }
 
+    /// Return whether renders the glyphs of FreeType fonts in a worker thread.
+    /// @property
+    bool GetUseThreadedGlyphRendering() const { return useThreadedGlyphRendering_; }
+
+    /// Return whether accelerates hit testing with a grid of element screen rects.
+    /// @property
+    bool GetUseHitTestGrid() const { return useHitTestGrid_; }
+
     /// Return whether is using forced autohinting.
     /// @property
     bool GetForceAutoHint() const { return forceAutoHint_; }
@@ -306,6 +320,51 @@ private:
         SharedPtr<VertexBuffer> debugVertexBuffer_;
     };
 
+    /// Data structure used to hold the texture of an UI element whose child elements are cached as texture.
+    struct TextureCacheData
+    {
+        /// UIElement whose child elements are cached.
+        WeakPtr<UIElement> element_;
+        /// Texture holding the rendered child elements.
+        SharedPtr<Texture2D> texture_;
+        /// Cached batches of the child elements, relative to the element's screen position.
+        UIBatchCache batchCache_;
+        /// UI vertex buffer.
+        SharedPtr<VertexBuffer> vertexBuffer_;
+        /// Whether the texture is up to date with the cached batches.
+        bool rendered_{};
+    };
+
+    /// Hit test grid entry.
+    struct HitTestEntry
+    {
+        /// Element.
+        UIElement* element_;
+        /// Screen rect of the element clipped by its ancestors.
+        IntRect rect_;
+        /// Whether the element is transformed, in which case the rect is only the clip region and the element with its children must be tested by traversal.
+        bool transformed_;
+    };
+
+    /// Data structure used to accelerate hit testing below a root element.
+    struct HitTestGrid
+    {
+        /// Root element.
+        WeakPtr<UIElement> rootElement_;
+        /// Hit testable elements in traversal order.
+        PODVector<HitTestEntry> entries_;
+        /// Entry indices in each cell, in traversal order.
+        Vector<PODVector<unsigned> > cells_;
+        /// Screen rect covered by the cells.
+        IntRect rect_;
+        /// Cell size in pixels.
+        int cellSize_{};
+        /// Number of cells horizontally.
+        int numCellsX_{};
+        /// Element geometry version at the time of building.
+        unsigned geometryVersion_{};
+    };
+
     /// Initialize when screen mode initially set.
     void Initialize();
     /// Update UI element logic recursively.
@@ -314,12 +373,30 @@ private:
     void SetVertexData(VertexBuffer* dest, const PODVector<float>& vertexData);
     /// Render UI batches to the current rendertarget. Geometry must have been uploaded first.
     void Render(VertexBuffer* buffer, const PODVector<UIBatch>& batches, unsigned batchStart, unsigned batchEnd);
-    /// Generate batches from an UI element recursively. Skip the cursor element.
-    void GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, UIElement* element, IntRect currentScissor);
+    /// Generate batches from an UI element recursively. Skip the cursor element. Use the element's batch cache if it has one, and record the considered elements to the batch cache entries if given.
+    void GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, UIElement* element, IntRect currentScissor,
+        PODVector<UIBatchCacheEntry>* cacheEntries = nullptr);
+    /// Generate batches from the child elements of an UI element recursively.
+    void GetChildBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, UIElement* element, IntRect currentScissor,
+        PODVector<UIBatchCacheEntry>* cacheEntries);
+    /// Generate the batches of a single child element if within the scissor, and record it to the batch cache entries if given.
+    void GetElementBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, UIElement* element, const IntRect& currentScissor,
+        PODVector<UIBatchCacheEntry>* cacheEntries);
+    /// Generate a batch compositing the child elements of an UI element from its cache texture, and update the cached batches if necessary. Return false if the texture cache can not be used.
+    bool GetTextureCacheBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, UIElement* element, const IntRect& currentScissor,
+        PODVector<UIBatchCacheEntry>* cacheEntries);
+    /// Render the cache textures whose batches have changed. The current rendertarget and viewport are restored afterward.
+    void RenderTextureCaches();
     /// Return UI element at global screen coordinates. Return position converted to element's screen coordinates.
     UIElement* GetElementAt(const IntVector2& position, bool enabledOnly, IntVector2* elementScreenPosition);
     /// Return UI element at screen position recursively.
     void GetElementAt(UIElement*& result, UIElement* current, const IntVector2& position, bool enabledOnly);
+    /// Return UI element at screen position below a root element using its hit test grid, which is rebuilt if outdated. Return false if the grid does not cover the position.
+    bool GetElementAtGrid(UIElement*& result, UIElement* root, const IntVector2& position, bool enabledOnly);
+    /// Rebuild the hit test grid of a root element.
+    void BuildHitTestGrid(HitTestGrid& grid, UIElement* root);
+    /// Add the hit testable child elements of an element to a hit test grid recursively.
+    void AddHitTestEntries(HitTestGrid& grid, UIElement* element, const IntRect& clipRect);
     /// Return the first element in hierarchy that can alter focus.
     UIElement* GetFocusableElement(UIElement* element);
     /// Return cursor position and visibility either from the cursor element, or the Input subsystem.
@@ -442,6 +519,10 @@ private:
     bool useScreenKeyboard_;
     /// Flag for using mutable (erasable) font glyphs.
     bool useMutableGlyphs_;
+    /// Flag for rendering FreeType glyphs in a worker thread.
+    bool useThreadedGlyphRendering_;
+    /// Flag for accelerating hit testing with a grid.
+    bool useHitTestGrid_;
     /// Flag for forcing FreeType auto hinting.
     bool forceAutoHint_;
     /// FreeType hinting level (default is FONT_HINT_LEVEL_NORMAL).
@@ -480,6 +561,10 @@ private:
     IntVector2 customSize_;
     /// Elements that should be rendered to textures.
     HashMap<UIElement*, RenderToTextureData> renderToTexture_;
+    /// Textures of UI elements whose child elements are cached as texture.
+    HashMap<UIElement*, TextureCacheData> textureCaches_;
+    /// Hit test grids of root elements.
+    HashMap<UIElement*, HitTestGrid> hitTestGrids_;
 };
 
 /// Register UI library objects.
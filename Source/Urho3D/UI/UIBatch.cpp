@@ -449,4 +449,55 @@ void UIBatch::AddOrMerge(const UIBatch& batch, PODVector<UIBatch>& batches)
     batches.Push(batch);
 }
 
+bool UIBatchCache::Validate(const IntRect& scissor)
+{
+    if (!valid_ || scissor != scissor_)
+        return false;
+
+    // The parents come first, so an element removed from the hierarchy is never accessed: its parent has changed
+    for (PODVector<UIBatchCacheEntry>::ConstIterator i = entries_.Begin(); i != entries_.End(); ++i)
+    {
+        if (i->element_->GetBatchVersion() != i->version_ || (i->drawn_ && i->element_->IsHovering() != i->hovering_))
+        {
+            valid_ = false;
+            return false;
+        }
+    }
+
+    for (PODVector<UIBatchCacheEntry>::ConstIterator i = entries_.Begin(); i != entries_.End(); ++i)
+    {
+        if (i->drawn_)
+            i->element_->SetHovering(i->hoveringAfter_);
+    }
+
+    return true;
+}
+
+void UIBatchCache::AppendTo(PODVector<UIBatch>& batches, PODVector<float>& vertexData) const
+{
+    unsigned offset = vertexData.Size();
+    vertexData.Push(vertexData_);
+
+    // The cached batches could not be merged with each other, but the first may merge with the preceding batch
+    for (unsigned i = 0; i < batches_.Size(); ++i)
+    {
+        UIBatch batch = batches_[i];
+        batch.vertexData_ = &vertexData;
+        batch.vertexStart_ += offset;
+        batch.vertexEnd_ += offset;
+        if (i)
+            batches.Push(batch);
+        else
+            UIBatch::AddOrMerge(batch, batches);
+    }
+}
+
+void UIBatchCache::Clear()
+{
+    batches_.Clear();
+    vertexData_.Clear();
+    entries_.Clear();
+    valid_ = false;
+}
+
 }
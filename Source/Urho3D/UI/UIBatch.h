@@ -100,4 +100,41 @@ public:
     static Vector3 posAdjust;
 };
 
+/// %UI element considered when generating cached batches, with its state at that time.
+struct UIBatchCacheEntry
+{
+    /// Element.
+    UIElement* element_;
+    /// Batch version of the element before its batches were generated.
+    unsigned version_;
+    /// Whether the element's batches were generated.
+    bool drawn_;
+    /// Hovering state before the batches were generated.
+    bool hovering_;
+    /// Hovering state after the batches were generated.
+    bool hoveringAfter_;
+};
+
+/// Cached batches of the child elements of a %UI element.
+struct URHO3D_API UIBatchCache
+{
+    /// Return whether the cached batches are still valid for the scissor, ie. none of the considered elements have changed. When valid, reset the hovering states of the elements like generating the batches would.
+    bool Validate(const IntRect& scissor);
+    /// Append the cached batches and their vertex data.
+    void AppendTo(PODVector<UIBatch>& batches, PODVector<float>& vertexData) const;
+    /// Clear the cached batches.
+    void Clear();
+
+    /// Batches.
+    PODVector<UIBatch> batches_;
+    /// Vertex data of the batches.
+    PODVector<float> vertexData_;
+    /// Elements considered during the generation, parents before their children.
+    PODVector<UIBatchCacheEntry> entries_;
+    /// Scissor the batches were generated with.
+    IntRect scissor_;
+    /// Valid flag.
+    bool valid_{};
+};
+
 }
@@ -85,6 +85,8 @@ static const char* layoutModes[] =
 
 extern const char* UI_CATEGORY;
 
+unsigned UIElement::geometryVersion_ = 0;
+
 static bool CompareUIElements(const UIElement* lhs, const UIElement* rhs)
 {
     return lhs->GetPriority() < rhs->GetPriority();
@@ -144,6 +146,8 @@ void UIElement::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Bring To Back", GetBringToBack, SetBringToBack, bool, true, AM_FILE);
     URHO3D_ACCESSOR_ATTRIBUTE("Clip Children", GetClipChildren, SetClipChildren, bool, false, AM_FILE);
     URHO3D_ACCESSOR_ATTRIBUTE("Use Derived Opacity", GetUseDerivedOpacity, SetUseDerivedOpacity, bool, true, AM_FILE);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cache Batches", GetCacheBatches, SetCacheBatches, bool, false, AM_FILE);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cache As Texture", GetCacheAsTexture, SetCacheAsTexture, bool, false, AM_FILE);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Focus Mode", GetFocusMode, SetFocusMode, FocusMode, focusModes, FM_NOTFOCUSABLE, AM_FILE);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Drag And Drop Mode", GetDragDropMode, SetDragDropMode, DragAndDropModeFlags, dragDropModes, DD_DISABLED, AM_FILE);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Layout Mode", GetLayoutMode, SetLayoutMode, LayoutMode, layoutModes, LM_FREE, AM_FILE);
@@ -817,6 +821,7 @@ void UIElement::SetClipBorder(const IntRect& rect)
     clipBorder_.top_ = Max(rect.top_, 0);
     clipBorder_.right_ = Max(rect.right_, 0);
     clipBorder_.bottom_ = Max(rect.bottom_, 0);
+    MarkBatchesDirty();
 }
 
 void UIElement::SetColor(const Color& color)
@@ -825,6 +830,7 @@ void UIElement::SetColor(const Color& color)
         cornerColor = color;
     colorGradient_ = false;
     derivedColorDirty_ = true;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetColor(Corner corner, const Color& color)
@@ -832,6 +838,7 @@ void UIElement::SetColor(Corner corner, const Color& color)
     colors_[corner] = color;
     colorGradient_ = false;
     derivedColorDirty_ = true;
+    MarkBatchesDirty();
 
     for (unsigned i = 0; i < MAX_UIELEMENT_CORNERS; ++i)
     {
@@ -846,8 +853,12 @@ void UIElement::SetPriority(int priority)
         return;
 
     priority_ = priority;
+    ++geometryVersion_;
     if (parent_)
+    {
         parent_->sortOrderDirty_ = true;
+        parent_->MarkBatchesDirty();
+    }
 }
 
 void UIElement::SetOpacity(float opacity)
@@ -869,6 +880,8 @@ void UIElement::SetBringToBack(bool enable)
 void UIElement::SetClipChildren(bool enable)
 {
     clipChildren_ = enable;
+    ++geometryVersion_;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetSortChildren(bool enable)
@@ -877,22 +890,39 @@ void UIElement::SetSortChildren(bool enable)
         sortOrderDirty_ = true;
 
     sortChildren_ = enable;
+    ++geometryVersion_;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetUseDerivedOpacity(bool enable)
 {
     useDerivedOpacity_ = enable;
+    MarkDirty();
+}
+
+void UIElement::SetCacheBatches(bool enable)
+{
+    if (enable != GetCacheBatches())
+        batchCache_.Reset(enable ? new UIBatchCache() : nullptr);
+}
+
+void UIElement::SetCacheAsTexture(bool enable)
+{
+    cacheAsTexture_ = enable;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetEnabled(bool enable)
 {
     enabled_ = enable;
     enabledPrev_ = enable;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetDeepEnabled(bool enable)
 {
     enabled_ = enable;
+    MarkBatchesDirty();
 
     for (Vector<SharedPtr<UIElement> >::ConstIterator i = children_.Begin(); i != children_.End(); ++i)
         (*i)->SetDeepEnabled(enable);
@@ -901,6 +931,7 @@ void UIElement::SetDeepEnabled(bool enable)
 void UIElement::ResetDeepEnabled()
 {
     enabled_ = enabledPrev_;
+    MarkBatchesDirty();
 
     for (Vector<SharedPtr<UIElement> >::ConstIterator i = children_.Begin(); i != children_.End(); ++i)
         (*i)->ResetDeepEnabled();
@@ -910,6 +941,7 @@ void UIElement::SetEnabledRecursive(bool enable)
 {
     enabled_ = enable;
     enabledPrev_ = enable;
+    MarkBatchesDirty();
 
     for (Vector<SharedPtr<UIElement> >::ConstIterator i = children_.Begin(); i != children_.End(); ++i)
         (*i)->SetEnabledRecursive(enable);
@@ -952,6 +984,7 @@ void UIElement::SetFocus(bool enable)
 void UIElement::SetSelected(bool enable)
 {
     selected_ = enable;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetVisible(bool enable)
@@ -964,6 +997,10 @@ void UIElement::SetVisible(bool enable)
     if (enable != visible_)
     {
         visible_ = enable;
+        ++geometryVersion_;
+        MarkBatchesDirty();
+        if (parent_)
+            parent_->MarkBatchesDirty();
 
         // Parent's layout may change as a result of visibility change
         if (parent_)
@@ -1317,6 +1354,7 @@ void UIElement::InsertChild(unsigned index, UIElement* element)
 
     element->parent_ = this;
     element->MarkDirty();
+    MarkBatchesDirty();
 
     // Apply style now if child element (and its children) has it defined
     ApplyStyleRecursive(element);
@@ -1449,6 +1487,7 @@ void UIElement::SetInternal(bool enable)
 void UIElement::SetTraversalMode(TraversalMode traversalMode)
 {
     traversalMode_ = traversalMode;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetElementEventSender(bool flag)
@@ -1936,6 +1975,8 @@ void UIElement::MarkDirty()
     positionDirty_ = true;
     opacityDirty_ = true;
     derivedColorDirty_ = true;
+    ++geometryVersion_;
+    MarkBatchesDirty();
 
     for (Vector<SharedPtr<UIElement> >::ConstIterator i = children_.Begin(); i != children_.End(); ++i)
         (*i)->MarkDirty();
@@ -2220,6 +2261,8 @@ IntVector2 UIElement::GetLayoutChildPosition(UIElement* child)
 
 void UIElement::Detach()
 {
+    if (parent_)
+        parent_->MarkBatchesDirty();
     parent_ = nullptr;
     MarkDirty();
 }
@@ -328,6 +328,12 @@ public:
     /// Set whether parent elements' opacity affects opacity. Default true.
     /// @property
     void SetUseDerivedOpacity(bool enable);
+    /// Set whether to cache the rendering batches of the child elements, so that they are generated again only when something in them has changed. Default false. Custom elements inside a cached subtree must call MarkBatchesDirty() when their appearance changes by other means than the built-in setters.
+    /// @property
+    void SetCacheBatches(bool enable);
+    /// Set whether to render the child elements into a texture, which is rendered again only when something in them has changed, and composite it as a single quad otherwise. The child elements are clipped to the element's rectangle. Default false.
+    /// @property
+    void SetCacheAsTexture(bool enable);
     /// Set whether reacts to input. Default false, but is enabled by subclasses if applicable.
     /// @property
     void SetEnabled(bool enable);
@@ -582,6 +588,24 @@ public:
     /// @property
     bool GetUseDerivedOpacity() const { return useDerivedOpacity_; }
 
+    /// Return whether the rendering batches of the child elements are cached.
+    /// @property
+    bool GetCacheBatches() const { return batchCache_.NotNull(); }
+
+    /// Return the cached batches of the child elements, or null if not cached.
+    UIBatchCache* GetBatchCache() const { return batchCache_.Get(); }
+
+    /// Return whether the child elements are rendered into a cached texture.
+    /// @property
+    bool GetCacheAsTexture() const { return cacheAsTexture_; }
+
+    /// Return the batch version, which changes whenever the element's rendering batches or the order and visibility of its children may have changed.
+    unsigned GetBatchVersion() const { return batchVersion_; }
+
+    /// Return global counter of position, size, visibility and hierarchy changes of all elements. Used to validate hit test acceleration structures.
+    /// @nobind
+    static unsigned GetGeometryVersion() { return geometryVersion_; }
+
     /// Return whether has focus.
     /// @property{get_focus}
     bool HasFocus() const;
@@ -739,6 +763,8 @@ public:
     void SetChildOffset(const IntVector2& offset);
     /// Set hovering state.
     void SetHovering(bool enable);
+    /// Mark the rendering batches changed, invalidating the batch caches which include the element.
+    void MarkBatchesDirty() { ++batchVersion_; }
     /// Adjust scissor for rendering.
     void AdjustScissor(IntRect& currentScissor);
     /// Get UI rendering batches with a specified offset. Also recurse to child elements.
@@ -915,6 +941,14 @@ private:
     mutable bool derivedColorDirty_{true};
     /// Child priority sorting dirty flag.
     bool sortOrderDirty_{};
+    /// Batch version.
+    unsigned batchVersion_{};
+    /// Global counter of element geometry and hierarchy changes.
+    static unsigned geometryVersion_;
+    /// Cached batches of the child elements.
+    UniquePtr<UIBatchCache> batchCache_;
+    /// Cache child elements as texture flag.
+    bool cacheAsTexture_{};
     /// Has color gradient flag.
     bool colorGradient_{};
     /// Default style file.
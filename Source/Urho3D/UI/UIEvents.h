@@ -305,6 +305,14 @@ URHO3D_EVENT(E_ITEMDOUBLECLICKED, ItemDoubleClicked)
     URHO3D_PARAM(P_QUALIFIERS, Qualifiers);        // int
 }
 
+/// Virtual mode listview requests the content of an item. Item is a recycled element to fill in, or null in which case the handler should create a new element, add it as a child of the listview's content element and assign it to Item.
+URHO3D_EVENT(E_VIRTUALITEMREALIZE, VirtualItemRealize)
+{
+    URHO3D_PARAM(P_ELEMENT, Element);              // UIElement pointer
+    URHO3D_PARAM(P_INDEX, Index);                  // int
+    URHO3D_PARAM(P_ITEM, Item);                    // UIElement pointer
+}
+
 /// LineEdit or ListView unhandled key pressed.
 URHO3D_EVENT(E_UNHANDLEDKEY, UnhandledKey)
 {
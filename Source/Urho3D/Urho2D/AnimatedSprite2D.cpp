@@ -61,7 +61,9 @@ AnimatedSprite2D::AnimatedSprite2D(Context* context) :
     animationState_(0),
 #endif
     speed_(1.0f),
-    loopMode_(LM_DEFAULT)
+    loopMode_(LM_DEFAULT),
+    poseCacheInterval_(0.0f),
+    spriterPoseDirty_(false)
 {
 }
 
@@ -82,6 +84,7 @@ void AnimatedSprite2D::RegisterObject(Context* context)
         ResourceRef(AnimatedSprite2D::GetTypeStatic()), AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Animation", GetAnimation, SetAnimationAttr, String, String::EMPTY, AM_DEFAULT);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Loop Mode", GetLoopMode, SetLoopMode, LoopMode2D, loopModeNames, LM_DEFAULT, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Pose Cache Interval", GetPoseCacheInterval, SetPoseCacheInterval, float, 0.0f, AM_DEFAULT);
 }
 
 void AnimatedSprite2D::OnSetEnabled()
@@ -138,6 +141,7 @@ void AnimatedSprite2D::SetAnimationSet(AnimationSet2D* animationSet)
     if (animationSet_->GetSpriterData())
     {
         spriterInstance_ = new Spriter::SpriterInstance(this, animationSet_->GetSpriterData());
+        spriterInstance_->SetPoseCacheInterval(poseCacheInterval_);
 
         if (!animationSet_->GetSpriterData()->entities_.Empty())
         {
@@ -202,6 +206,20 @@ void AnimatedSprite2D::SetSpeed(float speed)
     MarkNetworkUpdate();
 }
 
+void AnimatedSprite2D::SetPoseCacheInterval(float interval)
+{
+    poseCacheInterval_ = Max(interval, 0.0f);
+    if (spriterInstance_)
+    {
+        spriterInstance_->SetPoseCacheInterval(poseCacheInterval_);
+        spriterPoseDirty_ = true;
+        sourceBatchesDirty_ = true;
+        worldBoundingBoxDirty_ = true;
+    }
+
+    MarkNetworkUpdate();
+}
+
 AnimationSet2D* AnimatedSprite2D::GetAnimationSet() const
 {
     return animationSet_;
@@ -398,7 +416,10 @@ void AnimatedSprite2D::UpdateSourceBatchesSpine()
 void AnimatedSprite2D::SetSpriterAnimation()
 {
     if (!spriterInstance_)
+    {
         spriterInstance_ = new Spriter::SpriterInstance(this, animationSet_->GetSpriterData());
+        spriterInstance_->SetPoseCacheInterval(poseCacheInterval_);
+    }
 
     // Use entity is empty first entity
     if (entity_.Empty())
@@ -422,13 +443,23 @@ void AnimatedSprite2D::SetSpriterAnimation()
 
 void AnimatedSprite2D::UpdateSpriterAnimation(float timeStep)
 {
-    spriterInstance_->Update(timeStep * speed_);
+    // Only advance the time here, as the animation finished event must be sent from the main thread. The timeline keys
+    // are evaluated when the source batches are next needed, which normally happens in the Renderer2D visibility check
+    // work items, spreading the evaluation of many animated sprites across the worker threads
+    spriterInstance_->Advance(timeStep * speed_);
+    spriterPoseDirty_ = true;
     sourceBatchesDirty_ = true;
     worldBoundingBoxDirty_ = true;
 }
 
 void AnimatedSprite2D::UpdateSourceBatchesSpriter()
 {
+    if (spriterPoseDirty_)
+    {
+        spriterInstance_->Evaluate();
+        spriterPoseDirty_ = false;
+    }
+
     const Matrix3x4& nodeWorldTransform = GetNode()->GetWorldTransform();
 
     Vector<Vertex2D>& vertices = sourceBatches_[0].vertices_;
@@ -533,6 +564,7 @@ void AnimatedSprite2D::Dispose()
     }
 #endif
     spriterInstance_.Reset();
+    spriterPoseDirty_ = false;
 }
 
 }
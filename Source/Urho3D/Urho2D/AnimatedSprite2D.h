@@ -84,6 +84,9 @@ public:
     /// Set speed.
     /// @property
     void SetSpeed(float speed);
+    /// Set Spriter pose cache interval in seconds. When positive, the animation is sampled at multiples of the interval and the poses are shared by all sprites playing the same animation. Zero (default) evaluates every frame exactly.
+    /// @property
+    void SetPoseCacheInterval(float interval);
 
     /// Return animation.
     /// @property
@@ -100,6 +103,9 @@ public:
     /// Return speed.
     /// @property
     float GetSpeed() const { return speed_; }
+    /// Return Spriter pose cache interval.
+    /// @property
+    float GetPoseCacheInterval() const { return poseCacheInterval_; }
 
     /// Set animation set attribute.
     void SetAnimationSetAttr(const ResourceRef& value);
@@ -114,6 +120,8 @@ protected:
     void OnSceneSet(Scene* scene) override;
     /// Handle update vertices.
     void UpdateSourceBatches() override;
+    /// Return whether can be drawn as a sprite instance. Always false, as the animation generates its own vertices.
+    bool CanDrawInstanced() const override { return false; }
     /// Handle scene post update.
     void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
     /// Update animation.
@@ -130,7 +138,7 @@ protected:
     void SetSpriterAnimation();
     /// Update spriter animation.
     void UpdateSpriterAnimation(float timeStep);
-    /// Update vertices for spriter animation.
+    /// Update vertices for spriter animation, evaluating the timeline keys first if the time has advanced. May be called from a worker thread.
     void UpdateSourceBatchesSpriter();
     /// Reload sprite and spriter data on device reset.
     void HandleDeviceReset(StringHash eventType, VariantMap& eventData);
@@ -147,6 +155,10 @@ protected:
     String animationName_;
     /// Loop mode.
     LoopMode2D loopMode_;
+    /// Spriter pose cache interval.
+    float poseCacheInterval_;
+    /// Spriter timeline keys need to be evaluated flag.
+    bool spriterPoseDirty_;
 
 #ifdef URHO3D_SPINE
     /// Skeleton.
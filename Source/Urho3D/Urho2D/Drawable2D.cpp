@@ -39,6 +39,7 @@ const float PIXEL_SIZE = 0.01f;
 
 SourceBatch2D::SourceBatch2D() :
     distance_(0.0f),
+    sortIndex_(M_MAX_UNSIGNED),
     drawOrder_(0)
 {
 }
@@ -24,6 +24,7 @@
 
 #include "../Graphics/Drawable.h"
 #include "../Graphics/GraphicsDefs.h"
+#include "../Math/Rect.h"
 
 namespace Urho3D
 {
@@ -44,6 +45,21 @@ struct Vertex2D
     Vector2 uv_;
 };
 
+/// 2D sprite instance, expanded from a unit quad in the vertex shader when sprite instancing is enabled.
+struct SpriteInstance2D
+{
+    /// World position of the bottom left corner.
+    Vector3 origin_;
+    /// World space vector from the origin to the bottom right corner.
+    Vector3 axisX_;
+    /// World space vector from the origin to the top left corner.
+    Vector3 axisY_;
+    /// Texture coordinates at the origin and the opposite corner.
+    Rect uvRect_;
+    /// Color.
+    unsigned color_;
+};
+
 /// 2D source batch.
 struct SourceBatch2D
 {
@@ -54,12 +70,16 @@ struct SourceBatch2D
     WeakPtr<Drawable2D> owner_;
     /// Distance to camera.
     mutable float distance_;
+    /// Index in the sorted batch list of the view that last rendered it, used to presort the next frame.
+    mutable unsigned sortIndex_;
     /// Draw order.
     int drawOrder_;
     /// Material.
     SharedPtr<Material> material_;
     /// Vertices.
     Vector<Vertex2D> vertices_;
+    /// Sprite instances, used instead of vertices when the material is an instanced material from Renderer2D.
+    PODVector<SpriteInstance2D> instances_;
 };
 
 /// Pixel size (equal 0.01f).
@@ -99,6 +119,8 @@ public:
 
     /// Return all source batches (called by Renderer2D).
     const Vector<SourceBatch2D>& GetSourceBatches();
+    /// Handle sprite instancing being enabled or disabled (called by Renderer2D).
+    virtual void OnSpriteInstancingChanged() { }
 
 protected:
     /// Handle scene being assigned.
@@ -23,6 +23,9 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/Material.h"
 #include "../Resource/ResourceCache.h"
@@ -42,15 +45,89 @@ namespace Urho3D
 extern const char* URHO2D_CATEGORY;
 extern const char* blendModeNames[];
 
+/// Particle amount from which the particle update is split into work items.
+static const unsigned MIN_THREADED_PARTICLES = 8192;
+/// Minimum amount of particles in one work item.
+static const unsigned MIN_PARTICLES_PER_WORK_ITEM = 1024;
+
+/// Particle values, each stored in its own array.
+enum ParticleValue2D
+{
+    PV_TIMETOLIVE = 0,
+    PV_TIMESTEP,
+    PV_POSITIONX,
+    PV_POSITIONY,
+    PV_POSITIONZ,
+    PV_SIZE,
+    PV_SIZEDELTA,
+    PV_ROTATION,
+    PV_ROTATIONDELTA,
+    PV_COLORR,
+    PV_COLORG,
+    PV_COLORB,
+    PV_COLORA,
+    PV_COLORDELTAR,
+    PV_COLORDELTAG,
+    PV_COLORDELTAB,
+    PV_COLORDELTAA,
+    PV_STARTX,
+    PV_STARTY,
+    PV_VELOCITYX,
+    PV_VELOCITYY,
+    PV_RADIALACCELERATION,
+    PV_TANGENTIALACCELERATION,
+    PV_EMITRADIUS,
+    PV_EMITRADIUSDELTA,
+    PV_EMITROTATION,
+    PV_EMITROTATIONDELTA,
+    MAX_PARTICLE_VALUES
+};
+
+/// Particle range update parameters of the work items.
+struct ParticleUpdateWork2D
+{
+    /// Emitter.
+    ParticleEmitter2D* emitter_;
+    /// Time step.
+    float timeStep_;
+    /// World scale.
+    float worldScale_;
+};
+
+void UpdateParticles2DWork(const WorkItem* item, unsigned threadIndex)
+{
+    auto* update = reinterpret_cast<ParticleUpdateWork2D*>(item->aux_);
+    auto start = (unsigned)reinterpret_cast<size_t>(item->start_);
+    auto end = (unsigned)reinterpret_cast<size_t>(item->end_);
+    update->emitter_->UpdateParticles(start, end, update->timeStep_, update->worldScale_);
+}
+
+/// Add deltas multiplied by per-particle time steps to a range of particle values.
+static void AddScaled(float* values, const float* deltas, const float* timeSteps, unsigned start, unsigned end)
+{
+    unsigned i = start;
+#ifdef URHO3D_SSE
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 value = _mm_loadu_ps(values + i);
+        _mm_storeu_ps(values + i, _mm_add_ps(value, _mm_mul_ps(_mm_loadu_ps(deltas + i), _mm_loadu_ps(timeSteps + i))));
+    }
+#endif
+    for (; i < end; ++i)
+        values[i] += deltas[i] * timeSteps[i];
+}
+
 ParticleEmitter2D::ParticleEmitter2D(Context* context) :
     Drawable2D(context),
     blendMode_(BLEND_ADDALPHA),
     numParticles_(0),
+    maxParticles_(0),
     emissionTime_(0.0f),
     emitParticleTime_(0.0f),
     boundingBoxMinPoint_(Vector3::ZERO),
     boundingBoxMaxPoint_(Vector3::ZERO),
-    emitting_(true)
+    emitting_(true),
+    instanced_(false)
 {
     sourceBatches_.Resize(1);
     sourceBatches_[0].owner_ = this;
@@ -130,11 +207,23 @@ void ParticleEmitter2D::SetBlendMode(BlendMode blendMode)
 void ParticleEmitter2D::SetMaxParticles(unsigned maxParticles)
 {
     maxParticles = Max(maxParticles, 1U);
-
-    particles_.Resize(maxParticles);
-    sourceBatches_[0].vertices_.Reserve(maxParticles * 4);
+    if (maxParticles == maxParticles_)
+        return;
 
     numParticles_ = Min(maxParticles, numParticles_);
+
+    // Each value has its own array, so resizing moves the live particles of every array to the new array offsets
+    PODVector<float> particleData(maxParticles * MAX_PARTICLE_VALUES);
+    for (unsigned i = 0; i < MAX_PARTICLE_VALUES && numParticles_; ++i)
+        memcpy(&particleData[i * maxParticles], GetParticleArray(i), numParticles_ * sizeof(float));
+
+    particleData_.Swap(particleData);
+    maxParticles_ = maxParticles;
+
+    if (instanced_)
+        sourceBatches_[0].instances_.Reserve(maxParticles);
+    else
+        sourceBatches_[0].vertices_.Reserve(maxParticles * 4);
 }
 
 ParticleEffect2D* ParticleEmitter2D::GetEffect() const
@@ -212,7 +301,9 @@ void ParticleEmitter2D::UpdateSourceBatches()
         return;
 
     Vector<Vertex2D>& vertices = sourceBatches_[0].vertices_;
+    PODVector<SpriteInstance2D>& instances = sourceBatches_[0].instances_;
     vertices.Clear();
+    instances.Clear();
 
     if (!sprite_)
         return;
@@ -221,6 +312,38 @@ void ParticleEmitter2D::UpdateSourceBatches()
     if (!sprite_->GetTextureRectangle(textureRect))
         return;
 
+    const float* positionX = GetParticleArray(PV_POSITIONX);
+    const float* positionY = GetParticleArray(PV_POSITIONY);
+    const float* positionZ = GetParticleArray(PV_POSITIONZ);
+    const float* size = GetParticleArray(PV_SIZE);
+    const float* rotation = GetParticleArray(PV_ROTATION);
+    const float* colorR = GetParticleArray(PV_COLORR);
+    const float* colorG = GetParticleArray(PV_COLORG);
+    const float* colorB = GetParticleArray(PV_COLORB);
+    const float* colorA = GetParticleArray(PV_COLORA);
+
+    if (instanced_)
+    {
+        // The quad is expanded in the vertex shader, so only the corner and the rotated, scaled axes are written
+        instances.Resize(numParticles_);
+
+        for (unsigned i = 0; i < numParticles_; ++i)
+        {
+            float c = Cos(-rotation[i]) * size[i];
+            float s = Sin(-rotation[i]) * size[i];
+
+            SpriteInstance2D& instance = instances[i];
+            instance.origin_ = Vector3(positionX[i] - (c - s) * 0.5f, positionY[i] - (c + s) * 0.5f, positionZ[i]);
+            instance.axisX_ = Vector3(c, s, 0.0f);
+            instance.axisY_ = Vector3(-s, c, 0.0f);
+            instance.uvRect_ = textureRect;
+            instance.color_ = Color(colorR[i], colorG[i], colorB[i], colorA[i]).ToUInt();
+        }
+
+        sourceBatchesDirty_ = false;
+        return;
+    }
+
     /*
     V1---------V2
     |         / |
@@ -230,48 +353,56 @@ void ParticleEmitter2D::UpdateSourceBatches()
     | /         |
     V0---------V3
     */
-    Vertex2D vertex0;
-    Vertex2D vertex1;
-    Vertex2D vertex2;
-    Vertex2D vertex3;
+    vertices.Resize(numParticles_ * 4);
+    Vertex2D* dest = vertices.Buffer();
 
-    vertex0.uv_ = textureRect.min_;
-    vertex1.uv_ = Vector2(textureRect.min_.x_, textureRect.max_.y_);
-    vertex2.uv_ = textureRect.max_;
-    vertex3.uv_ = Vector2(textureRect.max_.x_, textureRect.min_.y_);
-
-    for (unsigned i = 0; i < numParticles_; ++i)
+    for (unsigned i = 0; i < numParticles_; ++i, dest += 4)
     {
-        Particle2D& p = particles_[i];
-
-        float rotation = -p.rotation_;
-        float c = Cos(rotation);
-        float s = Sin(rotation);
-        float add = (c + s) * p.size_ * 0.5f;
-        float sub = (c - s) * p.size_ * 0.5f;
-
-        vertex0.position_ = Vector3(p.position_.x_ - sub, p.position_.y_ - add, p.position_.z_);
-        vertex1.position_ = Vector3(p.position_.x_ - add, p.position_.y_ + sub, p.position_.z_);
-        vertex2.position_ = Vector3(p.position_.x_ + sub, p.position_.y_ + add, p.position_.z_);
-        vertex3.position_ = Vector3(p.position_.x_ + add, p.position_.y_ - sub, p.position_.z_);
-
-        vertex0.color_ = vertex1.color_ = vertex2.color_ = vertex3.color_ = p.color_.ToUInt();
-
-        vertices.Push(vertex0);
-        vertices.Push(vertex1);
-        vertices.Push(vertex2);
-        vertices.Push(vertex3);
+        float c = Cos(-rotation[i]);
+        float s = Sin(-rotation[i]);
+        float add = (c + s) * size[i] * 0.5f;
+        float sub = (c - s) * size[i] * 0.5f;
+        unsigned color = Color(colorR[i], colorG[i], colorB[i], colorA[i]).ToUInt();
+
+        dest[0].position_ = Vector3(positionX[i] - sub, positionY[i] - add, positionZ[i]);
+        dest[1].position_ = Vector3(positionX[i] - add, positionY[i] + sub, positionZ[i]);
+        dest[2].position_ = Vector3(positionX[i] + sub, positionY[i] + add, positionZ[i]);
+        dest[3].position_ = Vector3(positionX[i] + add, positionY[i] - sub, positionZ[i]);
+
+        dest[0].uv_ = textureRect.min_;
+        dest[1].uv_ = Vector2(textureRect.min_.x_, textureRect.max_.y_);
+        dest[2].uv_ = textureRect.max_;
+        dest[3].uv_ = Vector2(textureRect.max_.x_, textureRect.min_.y_);
+
+        dest[0].color_ = dest[1].color_ = dest[2].color_ = dest[3].color_ = color;
     }
 
     sourceBatchesDirty_ = false;
 }
 
+void ParticleEmitter2D::OnSpriteInstancingChanged()
+{
+    UpdateMaterial();
+}
+
 void ParticleEmitter2D::UpdateMaterial()
 {
+    bool instanced = false;
+
     if (sprite_ && renderer_)
-        sourceBatches_[0].material_ = renderer_->GetMaterial(sprite_->GetTexture(), blendMode_);
+    {
+        instanced = sprite_->GetTexture() && renderer_->IsSpriteInstancingActive();
+        sourceBatches_[0].material_ = instanced ? renderer_->GetInstancedMaterial(sprite_->GetTexture(), blendMode_) :
+            renderer_->GetMaterial(sprite_->GetTexture(), blendMode_);
+    }
     else
         sourceBatches_[0].material_ = nullptr;
+
+    if (instanced != instanced_)
+    {
+        instanced_ = instanced;
+        sourceBatchesDirty_ = true;
+    }
 }
 
 void ParticleEmitter2D::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
@@ -316,37 +447,65 @@ void ParticleEmitter2D::Update(float timeStep)
     Vector3 worldPosition = GetNode()->GetWorldPosition();
     float worldScale = GetNode()->GetWorldScale().x_ * PIXEL_SIZE;
 
-    boundingBoxMinPoint_ = Vector3(M_INFINITY, M_INFINITY, M_INFINITY);
-    boundingBoxMaxPoint_ = Vector3(-M_INFINITY, -M_INFINITY, -M_INFINITY);
-
+    // Remove expired particles by moving the last live particle in their place
+    const float* timeToLive = GetParticleArray(PV_TIMETOLIVE);
     unsigned particleIndex = 0;
     while (particleIndex < numParticles_)
     {
-        Particle2D& particle = particles_[particleIndex];
-        if (particle.timeToLive_ > 0.0f)
-        {
-            UpdateParticle(particle, timeStep, worldPosition, worldScale);
+        if (timeToLive[particleIndex] > 0.0f)
             ++particleIndex;
-        }
         else
+            MoveLastParticle(particleIndex);
+    }
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    unsigned numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
+    if (numParticles_ >= MIN_THREADED_PARTICLES && numWorkItems > 1 && Thread::IsMainThread())
+    {
+        URHO3D_PROFILE(UpdateParticles2D);
+
+        ParticleUpdateWork2D update;
+        update.emitter_ = this;
+        update.timeStep_ = timeStep;
+        update.worldScale_ = worldScale;
+
+        unsigned particlesPerItem = Max(numParticles_ / numWorkItems, MIN_PARTICLES_PER_WORK_ITEM);
+        unsigned start = 0;
+        unsigned numItems = 0;
+
+        while (start < numParticles_)
         {
-            if (particleIndex != numParticles_ - 1)
-                particles_[particleIndex] = particles_[numParticles_ - 1];
-            --numParticles_;
+            unsigned end = numParticles_;
+            if (numItems++ < numWorkItems - 1 && end - start > particlesPerItem)
+                end = start + particlesPerItem;
+
+            SharedPtr<WorkItem> item = queue->GetFreeItem();
+            item->priority_ = M_MAX_UNSIGNED;
+            item->workFunction_ = UpdateParticles2DWork;
+            item->aux_ = &update;
+            item->start_ = reinterpret_cast<void*>((size_t)start);
+            item->end_ = reinterpret_cast<void*>((size_t)end);
+            queue->AddWorkItem(item);
+
+            start = end;
         }
+
+        queue->Complete(M_MAX_UNSIGNED);
     }
+    else
+        UpdateParticles(0, numParticles_, timeStep, worldScale);
 
     if (emitting_ && emissionTime_ > 0.0f)
     {
         float worldAngle = GetNode()->GetWorldRotation().RollAngle();
 
-        float timeBetweenParticles = effect_->GetParticleLifeSpan() / particles_.Size();
+        float timeBetweenParticles = effect_->GetParticleLifeSpan() / maxParticles_;
         emitParticleTime_ += timeStep;
 
         while (emitParticleTime_ > 0.0f)
         {
             if (EmitParticle(worldPosition, worldAngle, worldScale))
-                UpdateParticle(particles_[numParticles_ - 1], emitParticleTime_, worldPosition, worldScale);
+                UpdateParticles(numParticles_ - 1, numParticles_, emitParticleTime_, worldScale);
 
             emitParticleTime_ -= timeBetweenParticles;
         }
@@ -355,6 +514,8 @@ void ParticleEmitter2D::Update(float timeStep)
             emissionTime_ = Max(0.0f, emissionTime_ - timeStep);
     }
 
+    UpdateBoundingBoxPoints();
+
     sourceBatchesDirty_ = true;
 
     OnMarkedDirty(node_);
@@ -362,7 +523,7 @@ void ParticleEmitter2D::Update(float timeStep)
 
 bool ParticleEmitter2D::EmitParticle(const Vector3& worldPosition, float worldAngle, float worldScale)
 {
-    if (numParticles_ >= (unsigned)effect_->GetMaxParticles() || numParticles_ >= particles_.Size())
+    if (numParticles_ >= (unsigned)effect_->GetMaxParticles() || numParticles_ >= maxParticles_)
         return false;
 
     float lifespan = effect_->GetParticleLifeSpan() + effect_->GetParticleLifespanVariance() * Random(-1.0f, 1.0f);
@@ -371,9 +532,8 @@ bool ParticleEmitter2D::EmitParticle(const Vector3& worldPosition, float worldAn
 
     float invLifespan = 1.0f / lifespan;
 
-    Particle2D& particle = particles_[numParticles_++];
+    Particle2D particle;
     particle.timeToLive_ = lifespan;
-
     particle.position_.x_ = worldPosition.x_ + worldScale * effect_->GetSourcePositionVariance().x_ * Random(-1.0f, 1.0f);
     particle.position_.y_ = worldPosition.y_ + worldScale * effect_->GetSourcePositionVariance().y_ * Random(-1.0f, 1.0f);
     particle.position_.z_ = worldPosition.z_;
@@ -411,63 +571,183 @@ bool ParticleEmitter2D::EmitParticle(const Vector3& worldPosition, float worldAn
     float endRotation = worldAngle + effect_->GetRotationEnd() + effect_->GetRotationEndVariance() * Random(-1.0f, 1.0f);
     particle.rotationDelta_ = (endRotation - particle.rotation_) * invLifespan;
 
+    SetParticle(numParticles_++, particle);
+
     return true;
 }
 
-void ParticleEmitter2D::UpdateParticle(Particle2D& particle, float timeStep, const Vector3& worldPosition, float worldScale)
+void ParticleEmitter2D::SetParticle(unsigned index, const Particle2D& particle)
 {
-    if (timeStep > particle.timeToLive_)
-        timeStep = particle.timeToLive_;
+    GetParticleArray(PV_TIMETOLIVE)[index] = particle.timeToLive_;
+    GetParticleArray(PV_POSITIONX)[index] = particle.position_.x_;
+    GetParticleArray(PV_POSITIONY)[index] = particle.position_.y_;
+    GetParticleArray(PV_POSITIONZ)[index] = particle.position_.z_;
+    GetParticleArray(PV_SIZE)[index] = particle.size_;
+    GetParticleArray(PV_SIZEDELTA)[index] = particle.sizeDelta_;
+    GetParticleArray(PV_ROTATION)[index] = particle.rotation_;
+    GetParticleArray(PV_ROTATIONDELTA)[index] = particle.rotationDelta_;
+    GetParticleArray(PV_COLORR)[index] = particle.color_.r_;
+    GetParticleArray(PV_COLORG)[index] = particle.color_.g_;
+    GetParticleArray(PV_COLORB)[index] = particle.color_.b_;
+    GetParticleArray(PV_COLORA)[index] = particle.color_.a_;
+    GetParticleArray(PV_COLORDELTAR)[index] = particle.colorDelta_.r_;
+    GetParticleArray(PV_COLORDELTAG)[index] = particle.colorDelta_.g_;
+    GetParticleArray(PV_COLORDELTAB)[index] = particle.colorDelta_.b_;
+    GetParticleArray(PV_COLORDELTAA)[index] = particle.colorDelta_.a_;
+    GetParticleArray(PV_STARTX)[index] = particle.startPos_.x_;
+    GetParticleArray(PV_STARTY)[index] = particle.startPos_.y_;
+    GetParticleArray(PV_VELOCITYX)[index] = particle.velocity_.x_;
+    GetParticleArray(PV_VELOCITYY)[index] = particle.velocity_.y_;
+    GetParticleArray(PV_RADIALACCELERATION)[index] = particle.radialAcceleration_;
+    GetParticleArray(PV_TANGENTIALACCELERATION)[index] = particle.tangentialAcceleration_;
+    GetParticleArray(PV_EMITRADIUS)[index] = particle.emitRadius_;
+    GetParticleArray(PV_EMITRADIUSDELTA)[index] = particle.emitRadiusDelta_;
+    GetParticleArray(PV_EMITROTATION)[index] = particle.emitRotation_;
+    GetParticleArray(PV_EMITROTATIONDELTA)[index] = particle.emitRotationDelta_;
+    GetParticleArray(PV_TIMESTEP)[index] = 0.0f;
+}
 
-    particle.timeToLive_ -= timeStep;
+void ParticleEmitter2D::MoveLastParticle(unsigned index)
+{
+    unsigned last = --numParticles_;
+    if (index == last)
+        return;
+
+    for (unsigned i = 0; i < MAX_PARTICLE_VALUES; ++i)
+    {
+        float* values = GetParticleArray(i);
+        values[index] = values[last];
+    }
+}
+
+void ParticleEmitter2D::UpdateParticles(unsigned start, unsigned end, float timeStep, float worldScale)
+{
+    float* timeToLive = GetParticleArray(PV_TIMETOLIVE);
+    float* timeSteps = GetParticleArray(PV_TIMESTEP);
+    float* positionX = GetParticleArray(PV_POSITIONX);
+    float* positionY = GetParticleArray(PV_POSITIONY);
+
+    // Clamp the time step of each particle to its remaining time to live
+    unsigned i = start;
+#ifdef URHO3D_SSE
+    const __m128 timeStep4 = _mm_set1_ps(timeStep);
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 ttl = _mm_loadu_ps(timeToLive + i);
+        __m128 dt = _mm_min_ps(timeStep4, ttl);
+        _mm_storeu_ps(timeSteps + i, dt);
+        _mm_storeu_ps(timeToLive + i, _mm_sub_ps(ttl, dt));
+    }
+#endif
+    for (; i < end; ++i)
+    {
+        timeSteps[i] = Min(timeStep, timeToLive[i]);
+        timeToLive[i] -= timeSteps[i];
+    }
 
     if (effect_->GetEmitterType() == EMITTER_TYPE_RADIAL)
     {
-        particle.emitRotation_ += particle.emitRotationDelta_ * timeStep;
-        particle.emitRadius_ += particle.emitRadiusDelta_ * timeStep;
+        float* emitRotation = GetParticleArray(PV_EMITROTATION);
+        float* emitRadius = GetParticleArray(PV_EMITRADIUS);
+        const float* startX = GetParticleArray(PV_STARTX);
+        const float* startY = GetParticleArray(PV_STARTY);
+
+        AddScaled(emitRotation, GetParticleArray(PV_EMITROTATIONDELTA), timeSteps, start, end);
+        AddScaled(emitRadius, GetParticleArray(PV_EMITRADIUSDELTA), timeSteps, start, end);
 
-        particle.position_.x_ = particle.startPos_.x_ - Cos(particle.emitRotation_) * particle.emitRadius_;
-        particle.position_.y_ = particle.startPos_.y_ + Sin(particle.emitRotation_) * particle.emitRadius_;
+        for (i = start; i < end; ++i)
+        {
+            positionX[i] = startX[i] - Cos(emitRotation[i]) * emitRadius[i];
+            positionY[i] = startY[i] + Sin(emitRotation[i]) * emitRadius[i];
+        }
     }
     else
     {
-        float distanceX = particle.position_.x_ - particle.startPos_.x_;
-        float distanceY = particle.position_.y_ - particle.startPos_.y_;
+        float* velocityX = GetParticleArray(PV_VELOCITYX);
+        float* velocityY = GetParticleArray(PV_VELOCITYY);
+        const float* startX = GetParticleArray(PV_STARTX);
+        const float* startY = GetParticleArray(PV_STARTY);
+        const float* radialAcceleration = GetParticleArray(PV_RADIALACCELERATION);
+        const float* tangentialAcceleration = GetParticleArray(PV_TANGENTIALACCELERATION);
+        float gravityX = effect_->GetGravity().x_ * worldScale;
+        float gravityY = effect_->GetGravity().y_ * worldScale;
+
+        // The radial acceleration points away from the start position and the tangential acceleration is perpendicular to it
+        i = start;
+#ifdef URHO3D_SSE
+        const __m128 minDistance = _mm_set1_ps(0.0001f);
+        const __m128 gravityX4 = _mm_set1_ps(gravityX);
+        const __m128 gravityY4 = _mm_set1_ps(gravityY);
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(positionX + i);
+            __m128 y = _mm_loadu_ps(positionY + i);
+            __m128 distanceX = _mm_sub_ps(x, _mm_loadu_ps(startX + i));
+            __m128 distanceY = _mm_sub_ps(y, _mm_loadu_ps(startY + i));
+            __m128 distance = _mm_max_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(distanceX, distanceX), _mm_mul_ps(distanceY, distanceY))),
+                minDistance);
+            __m128 radialX = _mm_div_ps(distanceX, distance);
+            __m128 radialY = _mm_div_ps(distanceY, distance);
+            __m128 radial = _mm_loadu_ps(radialAcceleration + i);
+            __m128 tangential = _mm_loadu_ps(tangentialAcceleration + i);
+            __m128 dt = _mm_loadu_ps(timeSteps + i);
+
+            __m128 accelX = _mm_add_ps(gravityX4, _mm_add_ps(_mm_mul_ps(radialX, radial), _mm_mul_ps(radialY, tangential)));
+            __m128 accelY = _mm_add_ps(_mm_sub_ps(gravityY4, _mm_mul_ps(radialY, radial)), _mm_mul_ps(radialX, tangential));
+            __m128 vx = _mm_add_ps(_mm_loadu_ps(velocityX + i), _mm_mul_ps(accelX, dt));
+            __m128 vy = _mm_sub_ps(_mm_loadu_ps(velocityY + i), _mm_mul_ps(accelY, dt));
+
+            _mm_storeu_ps(velocityX + i, vx);
+            _mm_storeu_ps(velocityY + i, vy);
+            _mm_storeu_ps(positionX + i, _mm_add_ps(x, _mm_mul_ps(vx, dt)));
+            _mm_storeu_ps(positionY + i, _mm_add_ps(y, _mm_mul_ps(vy, dt)));
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            float distanceX = positionX[i] - startX[i];
+            float distanceY = positionY[i] - startY[i];
 
-        float distanceScalar = Vector2(distanceX, distanceY).Length();
-        if (distanceScalar < 0.0001f)
-            distanceScalar = 0.0001f;
+            float distanceScalar = Vector2(distanceX, distanceY).Length();
+            if (distanceScalar < 0.0001f)
+                distanceScalar = 0.0001f;
 
-        float radialX = distanceX / distanceScalar;
-        float radialY = distanceY / distanceScalar;
+            float radialX = distanceX / distanceScalar;
+            float radialY = distanceY / distanceScalar;
 
-        float tangentialX = radialX;
-        float tangentialY = radialY;
+            velocityX[i] += (gravityX + radialX * radialAcceleration[i] + radialY * tangentialAcceleration[i]) * timeSteps[i];
+            velocityY[i] -= (gravityY - radialY * radialAcceleration[i] + radialX * tangentialAcceleration[i]) * timeSteps[i];
+            positionX[i] += velocityX[i] * timeSteps[i];
+            positionY[i] += velocityY[i] * timeSteps[i];
+        }
+    }
 
-        radialX *= particle.radialAcceleration_;
-        radialY *= particle.radialAcceleration_;
+    AddScaled(GetParticleArray(PV_SIZE), GetParticleArray(PV_SIZEDELTA), timeSteps, start, end);
+    AddScaled(GetParticleArray(PV_ROTATION), GetParticleArray(PV_ROTATIONDELTA), timeSteps, start, end);
+    for (unsigned c = 0; c < 4; ++c)
+        AddScaled(GetParticleArray(PV_COLORR + c), GetParticleArray(PV_COLORDELTAR + c), timeSteps, start, end);
+}
+
+void ParticleEmitter2D::UpdateBoundingBoxPoints()
+{
+    boundingBoxMinPoint_ = Vector3(M_INFINITY, M_INFINITY, M_INFINITY);
+    boundingBoxMaxPoint_ = Vector3(-M_INFINITY, -M_INFINITY, -M_INFINITY);
 
-        float newY = tangentialX;
-        tangentialX = -tangentialY * particle.tangentialAcceleration_;
-        tangentialY = newY * particle.tangentialAcceleration_;
+    const float* positionX = GetParticleArray(PV_POSITIONX);
+    const float* positionY = GetParticleArray(PV_POSITIONY);
+    const float* positionZ = GetParticleArray(PV_POSITIONZ);
+    const float* size = GetParticleArray(PV_SIZE);
 
-        particle.velocity_.x_ += (effect_->GetGravity().x_ * worldScale + radialX - tangentialX) * timeStep;
-        particle.velocity_.y_ -= (effect_->GetGravity().y_ * worldScale - radialY + tangentialY) * timeStep;
-        particle.position_.x_ += particle.velocity_.x_ * timeStep;
-        particle.position_.y_ += particle.velocity_.y_ * timeStep;
+    for (unsigned i = 0; i < numParticles_; ++i)
+    {
+        float halfSize = size[i] * 0.5f;
+        boundingBoxMinPoint_.x_ = Min(boundingBoxMinPoint_.x_, positionX[i] - halfSize);
+        boundingBoxMinPoint_.y_ = Min(boundingBoxMinPoint_.y_, positionY[i] - halfSize);
+        boundingBoxMinPoint_.z_ = Min(boundingBoxMinPoint_.z_, positionZ[i]);
+        boundingBoxMaxPoint_.x_ = Max(boundingBoxMaxPoint_.x_, positionX[i] + halfSize);
+        boundingBoxMaxPoint_.y_ = Max(boundingBoxMaxPoint_.y_, positionY[i] + halfSize);
+        boundingBoxMaxPoint_.z_ = Max(boundingBoxMaxPoint_.z_, positionZ[i]);
     }
-
-    particle.size_ += particle.sizeDelta_ * timeStep;
-    particle.rotation_ += particle.rotationDelta_ * timeStep;
-    particle.color_ += particle.colorDelta_ * timeStep;
-
-    float halfSize = particle.size_ * 0.5f;
-    boundingBoxMinPoint_.x_ = Min(boundingBoxMinPoint_.x_, particle.position_.x_ - halfSize);
-    boundingBoxMinPoint_.y_ = Min(boundingBoxMinPoint_.y_, particle.position_.y_ - halfSize);
-    boundingBoxMinPoint_.z_ = Min(boundingBoxMinPoint_.z_, particle.position_.z_);
-    boundingBoxMaxPoint_.x_ = Max(boundingBoxMaxPoint_.x_, particle.position_.x_ + halfSize);
-    boundingBoxMaxPoint_.y_ = Max(boundingBoxMaxPoint_.y_, particle.position_.y_ + halfSize);
-    boundingBoxMaxPoint_.z_ = Max(boundingBoxMaxPoint_.z_, particle.position_.z_);
 }
 
 }
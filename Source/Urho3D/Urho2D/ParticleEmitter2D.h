@@ -29,8 +29,9 @@ namespace Urho3D
 
 class ParticleEffect2D;
 class Sprite2D;
+struct WorkItem;
 
-/// 2D particle.
+/// 2D particle. ParticleEmitter2D stores its particles as a structure of arrays; this is the state of one particle when emitted.
 struct Particle2D
 {
     /// Time to live.
@@ -77,6 +78,8 @@ class URHO3D_API ParticleEmitter2D : public Drawable2D
 {
     URHO3D_OBJECT(ParticleEmitter2D, Drawable2D);
 
+    friend void UpdateParticles2DWork(const WorkItem* item, unsigned threadIndex);
+
 public:
     /// Construct.
     explicit ParticleEmitter2D(Context* context);
@@ -88,6 +91,8 @@ public:
 
     /// Handle enabled/disabled state change.
     void OnSetEnabled() override;
+    /// Handle sprite instancing being enabled or disabled in Renderer2D.
+    void OnSpriteInstancingChanged() override;
 
     /// Set particle effect.
     /// @property
@@ -116,7 +121,9 @@ public:
     BlendMode GetBlendMode() const { return blendMode_; }
 
     /// Return max particles.
-    unsigned GetMaxParticles() const { return particles_.Size(); }
+    unsigned GetMaxParticles() const { return maxParticles_; }
+    /// Return number of live particles.
+    unsigned GetNumParticles() const { return numParticles_; }
 
     /// Set particle model attr.
     void SetParticleEffectAttr(const ResourceRef& value);
@@ -147,8 +154,16 @@ private:
     void Update(float timeStep);
     /// Emit particle.
     bool EmitParticle(const Vector3& worldPosition, float worldAngle, float worldScale);
-    /// Update particle.
-    void UpdateParticle(Particle2D& particle, float timeStep, const Vector3& worldPosition, float worldScale);
+    /// Store particle state to the particle arrays.
+    void SetParticle(unsigned index, const Particle2D& particle);
+    /// Move the last live particle to an index.
+    void MoveLastParticle(unsigned index);
+    /// Update a range of particles. May be called from a worker thread.
+    void UpdateParticles(unsigned start, unsigned end, float timeStep, float worldScale);
+    /// Update the bounding box points from the live particles.
+    void UpdateBoundingBoxPoints();
+    /// Return the array of one particle value.
+    float* GetParticleArray(unsigned value) { return particleData_.Buffer() + value * maxParticles_; }
 
     /// Particle effect.
     SharedPtr<ParticleEffect2D> effect_;
@@ -158,14 +173,18 @@ private:
     BlendMode blendMode_;
     /// Nummber of particles.
     unsigned numParticles_;
+    /// Max particles.
+    unsigned maxParticles_;
     /// Emission time.
     float emissionTime_;
     /// Emit particle time.
     float emitParticleTime_;
     /// Currently emitting flag.
     bool emitting_;
-    /// Particles.
-    Vector<Particle2D> particles_;
+    /// Drawing as sprite instances flag.
+    bool instanced_;
+    /// Particle arrays, one array of max particles size per particle value.
+    PODVector<float> particleData_;
     /// Bounding box min point.
     Vector3 boundingBoxMinPoint_;
     /// Bounding box max point.
@@ -27,6 +27,7 @@
 #include "../Core/WorkQueue.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/Geometry.h"
+#include "../Graphics/Graphics.h"
 #include "../Graphics/GraphicsEvents.h"
 #include "../Graphics/IndexBuffer.h"
 #include "../Graphics/Material.h"
@@ -49,11 +50,26 @@ namespace Urho3D
 extern const char* blendModeNames[];
 
 static const unsigned MASK_VERTEX2D = MASK_POSITION | MASK_COLOR | MASK_TEXCOORD1;
+/// Vertex count below which the vertex buffer is filled on the main thread only.
+static const unsigned MIN_VERTICES_PER_WORK_ITEM = 4096;
+
+/// Return the per-instance vertex elements matching SpriteInstance2D.
+static PODVector<VertexElement> CreateSpriteInstanceElements()
+{
+    PODVector<VertexElement> elements;
+    elements.Push(VertexElement(TYPE_VECTOR3, SEM_TEXCOORD, 4, true));
+    elements.Push(VertexElement(TYPE_VECTOR3, SEM_TEXCOORD, 5, true));
+    elements.Push(VertexElement(TYPE_VECTOR3, SEM_TEXCOORD, 6, true));
+    elements.Push(VertexElement(TYPE_VECTOR4, SEM_TEXCOORD, 7, true));
+    elements.Push(VertexElement(TYPE_UBYTE4_NORM, SEM_COLOR, 1, true));
+    return elements;
+}
 
 ViewBatchInfo2D::ViewBatchInfo2D() :
     vertexBufferUpdateFrameNumber_(0),
     indexCount_(0),
     vertexCount_(0),
+    instanceCount_(0),
     batchUpdatedFrameNumber_(0),
     batchCount_(0)
 {
@@ -63,7 +79,9 @@ Renderer2D::Renderer2D(Context* context) :
     Drawable(context, DRAWABLE_GEOMETRY),
     material_(new Material(context)),
     indexBuffer_(new IndexBuffer(context_)),
-    viewMask_(DEFAULT_VIEWMASK)
+    quadVertexBuffer_(new VertexBuffer(context_)),
+    viewMask_(DEFAULT_VIEWMASK),
+    spriteInstancing_(false)
 {
     material_->SetName("Urho2D");
 
@@ -86,6 +104,8 @@ Renderer2D::~Renderer2D() = default;
 void Renderer2D::RegisterObject(Context* context)
 {
     context->RegisterFactory<Renderer2D>();
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Sprite Instancing", GetSpriteInstancing, SetSpriteInstancing, bool, false, AM_DEFAULT);
 }
 
 static inline bool CompareRayQueryResults(RayQueryResult& lr, RayQueryResult& rr)
@@ -126,6 +146,23 @@ void Renderer2D::UpdateBatches(const FrameInfo& frame)
     }
 }
 
+/// Copy the vertices of a range of source batches to consecutive locations in a vertex buffer.
+static void FillVertexBuffer(Vertex2D* dest, const SourceBatch2D* const* start, const SourceBatch2D* const* end)
+{
+    while (start != end)
+    {
+        const Vector<Vertex2D>& vertices = (*start++)->vertices_;
+        memcpy(dest, vertices.Buffer(), vertices.Size() * sizeof(Vertex2D));
+        dest += vertices.Size();
+    }
+}
+
+static void FillVertexBufferWork(const WorkItem* item, unsigned threadIndex)
+{
+    FillVertexBuffer(reinterpret_cast<Vertex2D*>(item->aux_), reinterpret_cast<const SourceBatch2D* const*>(item->start_),
+        reinterpret_cast<const SourceBatch2D* const*>(item->end_));
+}
+
 void Renderer2D::UpdateGeometry(const FrameInfo& frame)
 {
     unsigned indexCount = 0;
@@ -188,6 +225,17 @@ void Renderer2D::UpdateGeometry(const FrameInfo& frame)
     Camera* camera = frame.camera_;
     ViewBatchInfo2D& viewBatchInfo = viewBatchInfos_[camera];
 
+    // Fill the unit quad the sprite instances are expanded from. It is shadowed to survive device loss
+    if (viewBatchInfo.instanceCount_ && !quadVertexBuffer_->GetVertexCount())
+    {
+        const Vector3 quadVertices[] = {Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(1.0f, 1.0f, 0.0f),
+            Vector3(1.0f, 0.0f, 0.0f)};
+
+        quadVertexBuffer_->SetShadowed(true);
+        quadVertexBuffer_->SetSize(4, MASK_POSITION);
+        quadVertexBuffer_->SetData(quadVertices);
+    }
+
     if (viewBatchInfo.vertexBufferUpdateFrameNumber_ != frame_.frameNumber_)
     {
         unsigned vertexCount = viewBatchInfo.vertexCount_;
@@ -200,14 +248,46 @@ void Renderer2D::UpdateGeometry(const FrameInfo& frame)
             auto* dest = reinterpret_cast<Vertex2D*>(vertexBuffer->Lock(0, vertexCount, true));
             if (dest)
             {
-                const PODVector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
-                for (unsigned b = 0; b < sourceBatches.Size(); ++b)
+                URHO3D_PROFILE(FillVertexBuffer2D);
+
+                PODVector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
+                auto* queue = GetSubsystem<WorkQueue>();
+                unsigned numWorkItems = Min(queue->GetNumThreads() + 1, vertexCount / MIN_VERTICES_PER_WORK_ITEM);
+
+                if (numWorkItems > 1)
                 {
-                    const Vector<Vertex2D>& vertices = sourceBatches[b]->vertices_;
-                    for (unsigned i = 0; i < vertices.Size(); ++i)
-                        dest[i] = vertices[i];
-                    dest += vertices.Size();
+                    // Split the batches into ranges of roughly equal vertex count. Each range is copied to its own
+                    // part of the locked buffer, so the work items need no synchronization
+                    unsigned verticesPerItem = vertexCount / numWorkItems;
+                    unsigned rangeVertices = 0;
+                    const SourceBatch2D** start = sourceBatches.Begin().ptr_;
+                    const SourceBatch2D** end = sourceBatches.End().ptr_;
+
+                    for (const SourceBatch2D** i = start; i != end;)
+                    {
+                        rangeVertices += (*i)->vertices_.Size();
+                        ++i;
+
+                        if (rangeVertices >= verticesPerItem || i == end)
+                        {
+                            SharedPtr<WorkItem> item = queue->GetFreeItem();
+                            item->priority_ = M_MAX_UNSIGNED;
+                            item->workFunction_ = FillVertexBufferWork;
+                            item->aux_ = dest;
+                            item->start_ = start;
+                            item->end_ = i;
+                            queue->AddWorkItem(item);
+
+                            dest += rangeVertices;
+                            rangeVertices = 0;
+                            start = i;
+                        }
+                    }
+
+                    queue->Complete(M_MAX_UNSIGNED);
                 }
+                else
+                    FillVertexBuffer(dest, sourceBatches.Begin().ptr_, sourceBatches.End().ptr_);
 
                 vertexBuffer->Unlock();
             }
@@ -215,6 +295,33 @@ void Renderer2D::UpdateGeometry(const FrameInfo& frame)
                 URHO3D_LOGERROR("Failed to lock vertex buffer");
         }
 
+        unsigned instanceCount = viewBatchInfo.instanceCount_;
+        if (instanceCount)
+        {
+            VertexBuffer* instanceBuffer = viewBatchInfo.instanceBuffer_;
+            if (instanceBuffer->GetVertexCount() < instanceCount)
+                instanceBuffer->SetSize(instanceCount, CreateSpriteInstanceElements(), true);
+
+            auto* dest = reinterpret_cast<SpriteInstance2D*>(instanceBuffer->Lock(0, instanceCount, true));
+            if (dest)
+            {
+                const PODVector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
+                for (unsigned b = 0; b < sourceBatches.Size(); ++b)
+                {
+                    const PODVector<SpriteInstance2D>& instances = sourceBatches[b]->instances_;
+                    if (instances.Empty())
+                        continue;
+
+                    memcpy(dest, instances.Buffer(), instances.Size() * sizeof(SpriteInstance2D));
+                    dest += instances.Size();
+                }
+
+                instanceBuffer->Unlock();
+            }
+            else
+                URHO3D_LOGERROR("Failed to lock sprite instance buffer");
+        }
+
         viewBatchInfo.vertexBufferUpdateFrameNumber_ = frame_.frameNumber_;
     }
 }
@@ -245,23 +352,42 @@ Material* Renderer2D::GetMaterial(Texture2D* texture, BlendMode blendMode)
     if (!texture)
         return material_;
 
-    HashMap<Texture2D*, HashMap<int, SharedPtr<Material> > >::Iterator t = cachedMaterials_.Find(texture);
-    if (t == cachedMaterials_.End())
+    return GetCachedMaterial(texture, blendMode, false);
+}
+
+Material* Renderer2D::GetInstancedMaterial(Texture2D* texture, BlendMode blendMode)
+{
+    if (!texture)
+        return nullptr;
+
+    return GetCachedMaterial(texture, blendMode, true);
+}
+
+void Renderer2D::SetSpriteInstancing(bool enable)
+{
+    if (enable == spriteInstancing_)
+        return;
+
+    spriteInstancing_ = enable;
+
+    // Let the sprites switch materials. Disabled sprites are not in the drawables list, so go through the whole scene
+    Scene* scene = GetScene();
+    if (scene)
     {
-        SharedPtr<Material> newMaterial = CreateMaterial(texture, blendMode);
-        cachedMaterials_[texture][blendMode] = newMaterial;
-        return newMaterial;
+        PODVector<Drawable2D*> drawables;
+        scene->GetDerivedComponents<Drawable2D>(drawables, true);
+        for (unsigned i = 0; i < drawables.Size(); ++i)
+            drawables[i]->OnSpriteInstancingChanged();
     }
+}
 
-    HashMap<int, SharedPtr<Material> >& materials = t->second_;
-    HashMap<int, SharedPtr<Material> >::Iterator b = materials.Find(blendMode);
-    if (b != materials.End())
-        return b->second_;
-
-    SharedPtr<Material> newMaterial = CreateMaterial(texture, blendMode);
-    materials[blendMode] = newMaterial;
+bool Renderer2D::IsSpriteInstancingActive() const
+{
+    if (!spriteInstancing_)
+        return false;
 
-    return newMaterial;
+    auto* graphics = GetSubsystem<Graphics>();
+    return graphics && graphics->GetInstancingSupport();
 }
 
 bool Renderer2D::CheckVisibility(Drawable2D* drawable) const
@@ -280,24 +406,50 @@ void Renderer2D::OnWorldBoundingBoxUpdate()
     worldBoundingBox_ = boundingBox_;
 }
 
-SharedPtr<Material> Renderer2D::CreateMaterial(Texture2D* texture, BlendMode blendMode)
+Material* Renderer2D::GetCachedMaterial(Texture2D* texture, BlendMode blendMode, bool instanced)
+{
+    int key = instanced ? blendMode + MAX_BLENDMODES : blendMode;
+
+    HashMap<Texture2D*, HashMap<int, SharedPtr<Material> > >::Iterator t = cachedMaterials_.Find(texture);
+    if (t == cachedMaterials_.End())
+    {
+        SharedPtr<Material> newMaterial = CreateMaterial(texture, blendMode, instanced);
+        cachedMaterials_[texture][key] = newMaterial;
+        return newMaterial;
+    }
+
+    HashMap<int, SharedPtr<Material> >& materials = t->second_;
+    HashMap<int, SharedPtr<Material> >::Iterator b = materials.Find(key);
+    if (b != materials.End())
+        return b->second_;
+
+    SharedPtr<Material> newMaterial = CreateMaterial(texture, blendMode, instanced);
+    materials[key] = newMaterial;
+
+    return newMaterial;
+}
+
+SharedPtr<Material> Renderer2D::CreateMaterial(Texture2D* texture, BlendMode blendMode, bool instanced)
 {
     SharedPtr<Material> newMaterial = material_->Clone();
 
-    HashMap<int, SharedPtr<Technique> >::Iterator techIt = cachedTechniques_.Find((int)blendMode);
+    int key = instanced ? blendMode + MAX_BLENDMODES : blendMode;
+    HashMap<int, SharedPtr<Technique> >::Iterator techIt = cachedTechniques_.Find(key);
     if (techIt == cachedTechniques_.End())
     {
         SharedPtr<Technique> tech(new Technique(context_));
         Pass* pass = tech->CreatePass("alpha");
         pass->SetVertexShader("Urho2D");
         pass->SetPixelShader("Urho2D");
+        if (instanced)
+            pass->SetVertexShaderDefines("INSTANCED2D");
         pass->SetDepthWrite(false);
         pass->SetBlendMode(blendMode);
-        techIt = cachedTechniques_.Insert(MakePair((int)blendMode, tech));
+        techIt = cachedTechniques_.Insert(MakePair(key, tech));
     }
 
     newMaterial->SetTechnique(0, techIt->second_.Get());
-    newMaterial->SetName(texture->GetName() + "_" + blendModeNames[blendMode]);
+    newMaterial->SetName(texture->GetName() + "_" + blendModeNames[blendMode] + (instanced ? "_instanced" : ""));
     newMaterial->SetTexture(TU_DIFFUSE, texture);
 
     return newMaterial;
@@ -365,9 +517,11 @@ void Renderer2D::HandleBeginViewUpdate(StringHash eventType, VariantMap& eventDa
 
     ViewBatchInfo2D& viewBatchInfo = viewBatchInfos_[camera];
 
-    // Create vertex buffer
+    // Create vertex buffers
     if (!viewBatchInfo.vertexBuffer_)
         viewBatchInfo.vertexBuffer_ = new VertexBuffer(context_);
+    if (!viewBatchInfo.instanceBuffer_)
+        viewBatchInfo.instanceBuffer_ = new VertexBuffer(context_);
 
     UpdateViewBatchInfo(viewBatchInfo, camera);
 
@@ -416,35 +570,94 @@ static inline bool CompareSourceBatch2Ds(const SourceBatch2D* lhs, const SourceB
     return lhs < rhs;
 }
 
+/// Insertion sort the source batches, which is fast when they are nearly sorted already. Return false, leaving the
+/// batches partially sorted, if more than maxMoves moves would be needed.
+static bool InsertionSortSourceBatch2Ds(const SourceBatch2D** begin, const SourceBatch2D** end, unsigned maxMoves)
+{
+    for (const SourceBatch2D** i = begin + 1; i < end; ++i)
+    {
+        const SourceBatch2D* temp = *i;
+        const SourceBatch2D** j = i;
+        while (j > begin && CompareSourceBatch2Ds(temp, *(j - 1)))
+        {
+            if (!maxMoves--)
+            {
+                *j = temp;
+                return false;
+            }
+
+            *j = *(j - 1);
+            --j;
+        }
+        *j = temp;
+    }
+
+    return true;
+}
+
 void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* camera)
 {
     // Already update in same frame
     if (viewBatchInfo.batchUpdatedFrameNumber_ == frame_.frameNumber_)
         return;
 
+    // The draw order rarely changes between frames, so place the batches that were visible in the previous frame at
+    // their previous sorted position and append the rest. The previous list may contain pointers to destroyed batches,
+    // which are only compared against, never dereferenced
     PODVector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
-    sourceBatches.Clear();
+    PODVector<const SourceBatch2D*>& previousSourceBatches = viewBatchInfo.previousSourceBatches_;
+    PODVector<const SourceBatch2D*>& newSourceBatches = viewBatchInfo.newSourceBatches_;
+    sourceBatches.Swap(previousSourceBatches);
+
+    unsigned numPrevious = previousSourceBatches.Size();
+    sourceBatches.Resize(numPrevious);
+    for (unsigned i = 0; i < numPrevious; ++i)
+        sourceBatches[i] = nullptr;
+    newSourceBatches.Clear();
+
     for (unsigned d = 0; d < drawables_.Size(); ++d)
     {
         if (!drawables_[d]->IsInView(camera))
             continue;
 
         const Vector<SourceBatch2D>& batches = drawables_[d]->GetSourceBatches();
+        if (batches.Empty())
+            continue;
+
+        float distance = camera->GetDistance(drawables_[d]->GetNode()->GetWorldPosition());
         for (unsigned b = 0; b < batches.Size(); ++b)
         {
-            if (batches[b].material_ && !batches[b].vertices_.Empty())
-                sourceBatches.Push(&batches[b]);
+            const SourceBatch2D* sourceBatch = &batches[b];
+            if (!sourceBatch->material_ || (sourceBatch->vertices_.Empty() && sourceBatch->instances_.Empty()))
+                continue;
+
+            sourceBatch->distance_ = distance;
+
+            unsigned index = sourceBatch->sortIndex_;
+            if (index < numPrevious && previousSourceBatches[index] == sourceBatch)
+                sourceBatches[index] = sourceBatch;
+            else
+                newSourceBatches.Push(sourceBatch);
         }
     }
 
-    for (unsigned i = 0; i < sourceBatches.Size(); ++i)
+    unsigned numSourceBatches = 0;
+    for (unsigned i = 0; i < numPrevious; ++i)
     {
-        const SourceBatch2D* sourceBatch = sourceBatches[i];
-        Vector3 worldPos = sourceBatch->owner_->GetNode()->GetWorldPosition();
-        sourceBatch->distance_ = camera->GetDistance(worldPos);
+        if (sourceBatches[i])
+            sourceBatches[numSourceBatches++] = sourceBatches[i];
     }
+    sourceBatches.Resize(numSourceBatches);
+    sourceBatches.Push(newSourceBatches);
+
+    // Fall back to a full sort when many batches became visible, or when the order changed a lot (including when the
+    // sort indices were overwritten by another camera)
+    if (newSourceBatches.Size() * 4 > sourceBatches.Size() ||
+        !InsertionSortSourceBatch2Ds(sourceBatches.Begin().ptr_, sourceBatches.End().ptr_, sourceBatches.Size() * 4))
+        Sort(sourceBatches.Begin(), sourceBatches.End(), CompareSourceBatch2Ds);
 
-    Sort(sourceBatches.Begin(), sourceBatches.End(), CompareSourceBatch2Ds);
+    for (unsigned i = 0; i < sourceBatches.Size(); ++i)
+        sourceBatches[i]->sortIndex_ = i;
 
     viewBatchInfo.batchCount_ = 0;
     Material* currMaterial = nullptr;
@@ -452,8 +665,12 @@ void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* cam
     unsigned iCount = 0;
     unsigned vStart = 0;
     unsigned vCount = 0;
+    unsigned instStart = 0;
+    unsigned instCount = 0;
     float distance = M_INFINITY;
 
+    // Instanced materials are distinct from the vertex materials, so a run of one material is either all instances
+    // or all vertices
     for (unsigned b = 0; b < sourceBatches.Size(); ++b)
     {
         distance = Min(distance, sourceBatches[b]->distance_);
@@ -465,11 +682,13 @@ void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* cam
         {
             if (currMaterial)
             {
-                AddViewBatch(viewBatchInfo, currMaterial, iStart, iCount, vStart, vCount, distance);
+                AddViewBatch(viewBatchInfo, currMaterial, iStart, iCount, vStart, vCount, instStart, instCount, distance);
                 iStart += iCount;
                 iCount = 0;
                 vStart += vCount;
                 vCount = 0;
+                instStart += instCount;
+                instCount = 0;
                 distance = M_INFINITY;
             }
 
@@ -478,21 +697,24 @@ void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* cam
 
         iCount += vertices.Size() * 6 / 4;
         vCount += vertices.Size();
+        instCount += sourceBatches[b]->instances_.Size();
     }
 
     // Add the final batch if necessary
-    if (currMaterial && vCount)
-        AddViewBatch(viewBatchInfo, currMaterial, iStart, iCount, vStart, vCount,distance);
+    if (currMaterial && (vCount || instCount))
+        AddViewBatch(viewBatchInfo, currMaterial, iStart, iCount, vStart, vCount, instStart, instCount, distance);
 
-    viewBatchInfo.indexCount_ = iStart + iCount;
+    viewBatchInfo.instanceCount_ = instStart + instCount;
+    // Sprite instances use the first quad of the index buffer
+    viewBatchInfo.indexCount_ = Max(iStart + iCount, viewBatchInfo.instanceCount_ ? 6U : 0U);
     viewBatchInfo.vertexCount_ = vStart + vCount;
     viewBatchInfo.batchUpdatedFrameNumber_ = frame_.frameNumber_;
 }
 
-void Renderer2D::AddViewBatch(ViewBatchInfo2D& viewBatchInfo, Material* material,
-    unsigned indexStart, unsigned indexCount, unsigned vertexStart, unsigned vertexCount, float distance)
+void Renderer2D::AddViewBatch(ViewBatchInfo2D& viewBatchInfo, Material* material, unsigned indexStart, unsigned indexCount,
+    unsigned vertexStart, unsigned vertexCount, unsigned instanceStart, unsigned instanceCount, float distance)
 {
-    if (!material || indexCount == 0 || vertexCount == 0)
+    if (!material || ((indexCount == 0 || vertexCount == 0) && instanceCount == 0))
         return;
 
     if (viewBatchInfo.distances_.Size() <= viewBatchInfo.batchCount_)
@@ -508,13 +730,26 @@ void Renderer2D::AddViewBatch(ViewBatchInfo2D& viewBatchInfo, Material* material
     {
         SharedPtr<Geometry> geometry(new Geometry(context_));
         geometry->SetIndexBuffer(indexBuffer_);
-        geometry->SetVertexBuffer(0, viewBatchInfo.vertexBuffer_);
 
         viewBatchInfo.geometries_.Push(geometry);
     }
 
+    // Geometries are reused by batch index, so set up the vertex buffers for either kind of batch each time
     Geometry* geometry = viewBatchInfo.geometries_[viewBatchInfo.batchCount_];
-    geometry->SetDrawRange(TRIANGLE_LIST, indexStart, indexCount, vertexStart, vertexCount, false);
+    if (instanceCount)
+    {
+        geometry->SetNumVertexBuffers(2);
+        geometry->SetVertexBuffer(0, quadVertexBuffer_);
+        geometry->SetVertexBuffer(1, viewBatchInfo.instanceBuffer_);
+        geometry->SetDrawRange(TRIANGLE_LIST, 0, 6, 0, 4, false);
+    }
+    else
+    {
+        geometry->SetNumVertexBuffers(1);
+        geometry->SetVertexBuffer(0, viewBatchInfo.vertexBuffer_);
+        geometry->SetDrawRange(TRIANGLE_LIST, indexStart, indexCount, vertexStart, vertexCount, false);
+    }
+    geometry->SetInstanceRange(instanceStart, instanceCount);
 
     viewBatchInfo.batchCount_++;
 }
@@ -49,12 +49,20 @@ struct ViewBatchInfo2D
     unsigned indexCount_;
     /// Vertex count.
     unsigned vertexCount_;
+    /// Sprite instance count.
+    unsigned instanceCount_;
     /// Vertex buffer.
     SharedPtr<VertexBuffer> vertexBuffer_;
+    /// Sprite instance buffer.
+    SharedPtr<VertexBuffer> instanceBuffer_;
     /// Batch updated frame number.
     unsigned batchUpdatedFrameNumber_;
-    /// Source batches.
+    /// Source batches, sorted.
     PODVector<const SourceBatch2D*> sourceBatches_;
+    /// Source batches of the previous update.
+    PODVector<const SourceBatch2D*> previousSourceBatches_;
+    /// Source batches that were not visible in the previous update.
+    PODVector<const SourceBatch2D*> newSourceBatches_;
     /// Batch count.
     unsigned batchCount_;
     /// Distances.
@@ -96,6 +104,17 @@ public:
     void RemoveDrawable(Drawable2D* drawable);
     /// Return material by texture and blend mode.
     Material* GetMaterial(Texture2D* texture, BlendMode blendMode);
+    /// Return material for drawing sprite instances by texture and blend mode. Return null if the texture is null.
+    Material* GetInstancedMaterial(Texture2D* texture, BlendMode blendMode);
+
+    /// Set whether to draw static sprites as instances of a unit quad, expanded in the vertex shader, instead of writing their vertices.
+    /// @property
+    void SetSpriteInstancing(bool enable);
+    /// Return whether sprite instancing is enabled.
+    /// @property
+    bool GetSpriteInstancing() const { return spriteInstancing_; }
+    /// Return whether sprite instancing is enabled and supported by the graphics subsystem.
+    bool IsSpriteInstancingActive() const;
 
     /// Check visibility.
     bool CheckVisibility(Drawable2D* drawable) const;
@@ -103,8 +122,10 @@ public:
 private:
     /// Recalculate the world-space bounding box.
     void OnWorldBoundingBoxUpdate() override;
-    /// Create material by texture and blend mode.
-    SharedPtr<Material> CreateMaterial(Texture2D* texture, BlendMode blendMode);
+    /// Return cached material by texture, blend mode and whether it draws sprite instances.
+    Material* GetCachedMaterial(Texture2D* texture, BlendMode blendMode, bool instanced);
+    /// Create material by texture, blend mode and whether it draws sprite instances.
+    SharedPtr<Material> CreateMaterial(Texture2D* texture, BlendMode blendMode, bool instanced);
     /// Handle view update begin event. Determine Drawable2D's and their batches here.
     void HandleBeginViewUpdate(StringHash eventType, VariantMap& eventData);
     /// Get all drawables in node.
@@ -112,11 +133,13 @@ private:
     /// Update view batch info.
     void UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* camera);
     /// Add view batch.
-    void AddViewBatch(ViewBatchInfo2D& viewBatchInfo, Material* material,
-        unsigned indexStart, unsigned indexCount, unsigned vertexStart, unsigned vertexCount, float distance);
+    void AddViewBatch(ViewBatchInfo2D& viewBatchInfo, Material* material, unsigned indexStart, unsigned indexCount,
+        unsigned vertexStart, unsigned vertexCount, unsigned instanceStart, unsigned instanceCount, float distance);
 
     /// Index buffer.
     SharedPtr<IndexBuffer> indexBuffer_;
+    /// Unit quad vertex buffer for sprite instances.
+    SharedPtr<VertexBuffer> quadVertexBuffer_;
     /// Material.
     SharedPtr<Material> material_;
     /// Drawables.
@@ -129,10 +152,12 @@ private:
     Frustum frustum_;
     /// View mask of current camera for visibility checking.
     unsigned viewMask_;
-    /// Cached materials.
+    /// Cached materials. Instanced materials are offset by MAX_BLENDMODES.
     HashMap<Texture2D*, HashMap<int, SharedPtr<Material> > > cachedMaterials_;
-    /// Cached techniques per blend mode.
+    /// Cached techniques per blend mode. Instanced techniques are offset by MAX_BLENDMODES.
     HashMap<int, SharedPtr<Technique> > cachedTechniques_;
+    /// Sprite instancing flag.
+    bool spriteInstancing_;
 };
 
 }
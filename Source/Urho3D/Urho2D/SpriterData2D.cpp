@@ -243,6 +243,8 @@ Animation::~Animation()
 
 void Animation::Reset()
 {
+    ClearPoseCache();
+
     if (!mainlineKeys_.Empty())
     {
         for (unsigned i = 0; i < mainlineKeys_.Size(); ++i)
@@ -285,6 +287,18 @@ bool Animation::Load(const pugi::xml_node& node)
     return true;
 }
 
+void Animation::ClearPoseCache()
+{
+    MutexLock lock(poseCacheMutex_);
+
+    for (HashMap<unsigned, PODVector<SpatialTimelineKey*> >::Iterator i = poseCache_.Begin(); i != poseCache_.End(); ++i)
+    {
+        for (unsigned j = 0; j < i->second_.Size(); ++j)
+            delete i->second_[j];
+    }
+    poseCache_.Clear();
+}
+
 MainlineKey::~MainlineKey()
 {
     Reset();
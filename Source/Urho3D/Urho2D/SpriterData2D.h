@@ -24,6 +24,9 @@
 
 #pragma once
 
+#include "../Container/HashMap.h"
+#include "../Core/Mutex.h"
+
 namespace pugi
 {
 class xml_node;
@@ -150,6 +153,8 @@ struct Animation
 
     void Reset();
     bool Load(const pugi::xml_node& node);
+    /// Delete the cached poses.
+    void ClearPoseCache();
 
     int id_{};
     String name_;
@@ -157,6 +162,11 @@ struct Animation
     bool looping_{};
     PODVector<MainlineKey*> mainlineKeys_;
     PODVector<Timeline*> timelines_;
+
+    /// Poses shared by instances sampling the animation at the same time, keyed by the raw bits of the sample time. Timeline keys are stored bones first, unmapped to the entity root.
+    HashMap<unsigned, PODVector<SpatialTimelineKey*> > poseCache_;
+    /// Mutex for accessing the pose cache from worker threads.
+    Mutex poseCacheMutex_;
 };
 
 /// Mainline key.
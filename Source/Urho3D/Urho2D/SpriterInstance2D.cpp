@@ -35,6 +35,38 @@ namespace Urho3D
 namespace Spriter
 {
 
+/// Maximum number of poses cached per animation.
+static const unsigned MAX_CACHED_POSES = 1024;
+
+/// Evaluate a timeline key of a ref at a time into an existing key.
+template <class T> static void EvaluateTimelineKey(T& result, const Animation* animation, const Ref* ref, float time)
+{
+    const Timeline* timeline = animation->timelines_[ref->timeline_];
+    const auto* timelineKey = static_cast<const T*>(timeline->keys_[ref->key_]);
+    result = *timelineKey;
+    result.timeline_ = timelineKey->timeline_;
+    if (timeline->keys_.Size() == 1 || timelineKey->curveType_ == INSTANT)
+        return;
+
+    unsigned nextTimelineKeyIndex = ref->key_ + 1;
+    if (nextTimelineKeyIndex >= timeline->keys_.Size())
+    {
+        if (animation->looping_)
+            nextTimelineKeyIndex = 0;
+        else
+            return;
+    }
+
+    const TimelineKey* nextTimelineKey = timeline->keys_[nextTimelineKeyIndex];
+
+    float nextTimelineKeyTime = nextTimelineKey->time_;
+    if (nextTimelineKey->time_ < timelineKey->time_)
+        nextTimelineKeyTime += animation->length_;
+
+    float t = result.GetTByCurveType(time, nextTimelineKeyTime);
+    result.Interpolate(*nextTimelineKey, t);
+}
+
 SpriterInstance::SpriterInstance(Component* owner, SpriterData* spriteData) :
     owner_(owner),
     spriterData_(spriteData),
@@ -48,6 +80,11 @@ SpriterInstance::~SpriterInstance()
 
     OnSetAnimation(nullptr);
     OnSetEntity(nullptr);
+
+    for (unsigned i = 0; i < boneKeys_.Size(); ++i)
+        delete boneKeys_[i];
+    for (unsigned i = 0; i < spriteKeys_.Size(); ++i)
+        delete spriteKeys_[i];
 }
 
 bool SpriterInstance::SetEntity(int index)
@@ -122,13 +159,22 @@ void SpriterInstance::setSpatialInfo(float x, float y, float angle, float scaleX
     spatialInfo_ = SpatialInfo(x, y, angle, scaleX, scaleY);
 }
 
+void SpriterInstance::SetPoseCacheInterval(float interval)
+{
+    poseCacheInterval_ = Max(interval, 0.0f);
+}
+
 void SpriterInstance::Update(float deltaTime)
+{
+    Advance(deltaTime);
+    Evaluate();
+}
+
+void SpriterInstance::Advance(float deltaTime)
 {
     if (!animation_)
         return;
 
-    Clear();
-
     float lastTime = currentTime_;
     currentTime_ += deltaTime;
     if (currentTime_ > animation_->length_)
@@ -163,9 +209,42 @@ void SpriterInstance::Update(float deltaTime)
             }
         }
     }
+}
+
+void SpriterInstance::Evaluate()
+{
+    if (!animation_)
+        return;
+
+    Clear();
+
+    float time = currentTime_;
+    if (poseCacheInterval_ <= 0.0f)
+    {
+        UpdateMainlineKey(time);
+        UpdateTimelineKeys(time);
+        return;
+    }
+
+    time = Min(Floor(time / poseCacheInterval_) * poseCacheInterval_, animation_->length_);
+    UpdateMainlineKey(time);
+
+    // Poses only depend on the animation and the sample time when the root is not transformed
+    const SpatialInfo& info = spatialInfo_;
+    bool sharePose = info.x_ == 0.0f && info.y_ == 0.0f && info.angle_ == 0.0f && info.scaleX_ == 1.0f &&
+        info.scaleY_ == 1.0f && info.alpha_ == 1.0f && info.spin_ == 1;
+    if (!sharePose)
+    {
+        UpdateTimelineKeys(time);
+        return;
+    }
 
-    UpdateMainlineKey();
-    UpdateTimelineKeys();
+    unsigned sampleKey = FloatToRawIntBits(time);
+    if (!GetCachedPose(sampleKey))
+    {
+        UpdateTimelineKeys(time);
+        StorePose(sampleKey);
+    }
 }
 
 void SpriterInstance::OnSetEntity(Entity* entity)
@@ -198,12 +277,13 @@ void SpriterInstance::OnSetAnimation(Animation* animation, LoopMode loopMode)
     Clear();
 }
 
-void SpriterInstance::UpdateTimelineKeys()
+void SpriterInstance::UpdateTimelineKeys(float time)
 {
     for (unsigned i = 0; i < mainlineKey_->boneRefs_.Size(); ++i)
     {
         Ref* ref = mainlineKey_->boneRefs_[i];
-        auto* timelineKey = (BoneTimelineKey*)GetTimelineKey(ref);
+        BoneTimelineKey* timelineKey = GetBoneKey(i);
+        EvaluateTimelineKey(*timelineKey, animation_, ref, time);
         if (ref->parent_ >= 0)
         {
             timelineKey->info_ = timelineKey->info_.UnmapFromParent(timelineKeys_[ref->parent_]->info_);
@@ -218,7 +298,8 @@ void SpriterInstance::UpdateTimelineKeys()
     for (unsigned i = 0; i < mainlineKey_->objectRefs_.Size(); ++i)
     {
         Ref* ref = mainlineKey_->objectRefs_[i];
-        auto* timelineKey = (SpriteTimelineKey*)GetTimelineKey(ref);
+        SpriteTimelineKey* timelineKey = GetSpriteKey(i);
+        EvaluateTimelineKey(*timelineKey, animation_, ref, time);
 
         if (ref->parent_ >= 0)
         {
@@ -235,17 +316,17 @@ void SpriterInstance::UpdateTimelineKeys()
     }
 }
 
-void SpriterInstance::UpdateMainlineKey()
+void SpriterInstance::UpdateMainlineKey(float time)
 {
     const PODVector<MainlineKey*>& mainlineKeys = animation_->mainlineKeys_;
     for (unsigned i = 0; i < mainlineKeys.Size(); ++i)
     {
-        if (mainlineKeys[i]->time_ <= currentTime_)
+        if (mainlineKeys[i]->time_ <= time)
         {
             mainlineKey_ = mainlineKeys[i];
         }
 
-        if (mainlineKeys[i]->time_ >= currentTime_)
+        if (mainlineKeys[i]->time_ >= time)
         {
             break;
         }
@@ -257,54 +338,80 @@ void SpriterInstance::UpdateMainlineKey()
     }
 }
 
-TimelineKey* SpriterInstance::GetTimelineKey(Ref* ref) const
+bool SpriterInstance::GetCachedPose(unsigned sampleKey)
 {
-    Timeline* timeline = animation_->timelines_[ref->timeline_];
-    TimelineKey* timelineKey = timeline->keys_[ref->key_]->Clone();
-    if (timeline->keys_.Size() == 1 || timelineKey->curveType_ == INSTANT)
-    {
-        return timelineKey;
-    }
+    MutexLock lock(animation_->poseCacheMutex_);
 
-    unsigned nextTimelineKeyIndex = ref->key_ + 1;
-    if (nextTimelineKeyIndex >= timeline->keys_.Size())
+    HashMap<unsigned, PODVector<SpatialTimelineKey*> >::ConstIterator i = animation_->poseCache_.Find(sampleKey);
+    if (i == animation_->poseCache_.End())
+        return false;
+
+    const PODVector<SpatialTimelineKey*>& pose = i->second_;
+    unsigned numBoneKeys = 0;
+    for (unsigned j = 0; j < pose.Size(); ++j)
     {
-        if (animation_->looping_)
+        if (pose[j]->GetObjectType() == BONE)
         {
-            nextTimelineKeyIndex = 0;
+            BoneTimelineKey* timelineKey = GetBoneKey(numBoneKeys++);
+            *timelineKey = *static_cast<const BoneTimelineKey*>(pose[j]);
+            timelineKeys_.Push(timelineKey);
         }
         else
         {
-            return timelineKey;
+            const auto* cachedKey = static_cast<const SpriteTimelineKey*>(pose[j]);
+            SpriteTimelineKey* timelineKey = GetSpriteKey(j - numBoneKeys);
+            *timelineKey = *cachedKey;
+            timelineKey->zIndex_ = cachedKey->zIndex_;
+            timelineKeys_.Push(timelineKey);
         }
     }
 
-    TimelineKey* nextTimelineKey = timeline->keys_[nextTimelineKeyIndex];
+    return true;
+}
 
-    float nextTimelineKeyTime = nextTimelineKey->time_;
-    if (nextTimelineKey->time_ < timelineKey->time_)
+void SpriterInstance::StorePose(unsigned sampleKey)
+{
+    PODVector<SpatialTimelineKey*> pose(timelineKeys_.Size());
+    for (unsigned i = 0; i < timelineKeys_.Size(); ++i)
     {
-        nextTimelineKeyTime += animation_->length_;
+        pose[i] = static_cast<SpatialTimelineKey*>(timelineKeys_[i]->Clone());
+        if (timelineKeys_[i]->GetObjectType() == SPRITE)
+            static_cast<SpriteTimelineKey*>(pose[i])->zIndex_ = static_cast<SpriteTimelineKey*>(timelineKeys_[i])->zIndex_;
     }
 
-    float t = timelineKey->GetTByCurveType(currentTime_, nextTimelineKeyTime);
-    timelineKey->Interpolate(*nextTimelineKey, t);
+    MutexLock lock(animation_->poseCacheMutex_);
+
+    // Another instance may have stored the same pose meanwhile, or the cache may be full
+    if (animation_->poseCache_.Size() >= MAX_CACHED_POSES || animation_->poseCache_.Contains(sampleKey))
+    {
+        for (unsigned i = 0; i < pose.Size(); ++i)
+            delete pose[i];
+        return;
+    }
+
+    animation_->poseCache_[sampleKey] = pose;
+}
+
+BoneTimelineKey* SpriterInstance::GetBoneKey(unsigned index)
+{
+    while (boneKeys_.Size() <= index)
+        boneKeys_.Push(new BoneTimelineKey(nullptr));
+
+    return boneKeys_[index];
+}
 
-    return timelineKey;
+SpriteTimelineKey* SpriterInstance::GetSpriteKey(unsigned index)
+{
+    while (spriteKeys_.Size() <= index)
+        spriteKeys_.Push(new SpriteTimelineKey(nullptr));
+
+    return spriteKeys_[index];
 }
 
 void SpriterInstance::Clear()
 {
     mainlineKey_ = nullptr;
-
-    if (!timelineKeys_.Empty())
-    {
-        for (unsigned i = 0; i < timelineKeys_.Size(); ++i)
-        {
-            delete timelineKeys_[i];
-        }
-        timelineKeys_.Clear();
-    }
+    timelineKeys_.Clear();
 }
 
 }
@@ -63,8 +63,14 @@ public:
     void setSpatialInfo(const SpatialInfo& spatialInfo);
     /// Set root spatial info.
     void setSpatialInfo(float x, float y, float angle, float scaleX, float scaleY);
-    /// Update animation.
+    /// Set interval for sampling the animation. When positive, the time is rounded down to a multiple of the interval and the evaluated poses are shared with other instances of the same animation.
+    void SetPoseCacheInterval(float interval);
+    /// Update animation. Equivalent to Advance() followed by Evaluate().
     void Update(float deltaTime);
+    /// Advance the animation time and send the animation finished event. Must be called from the main thread.
+    void Advance(float deltaTime);
+    /// Evaluate the timeline keys at the current time. Does not allocate once the key pools have grown; may be called from a worker thread.
+    void Evaluate();
 
     /// Return current entity.
     Entity* GetEntity() const { return entity_; }
@@ -72,6 +78,8 @@ public:
     Animation* GetAnimation() const { return animation_; }
     /// Return root spatial info.
     const SpatialInfo& GetSpatialInfo() const { return spatialInfo_; }
+    /// Return pose cache interval.
+    float GetPoseCacheInterval() const { return poseCacheInterval_; }
     /// Return animation result timeline keys.
     const PODVector<SpatialTimelineKey*>& GetTimelineKeys() const { return timelineKeys_; }
 
@@ -81,11 +89,17 @@ private:
     /// Handle set animation.
     void OnSetAnimation(Animation* animation, LoopMode loopMode = Default);
     /// Update mainline key.
-    void UpdateMainlineKey();
+    void UpdateMainlineKey(float time);
     /// Update timeline keys.
-    void UpdateTimelineKeys();
-    /// Get timeline key by ref.
-    TimelineKey* GetTimelineKey(Ref* ref) const;
+    void UpdateTimelineKeys(float time);
+    /// Copy the cached pose at a sample time to the timeline keys. Return false if the pose has not been cached yet.
+    bool GetCachedPose(unsigned sampleKey);
+    /// Store the timeline keys as the cached pose at a sample time.
+    void StorePose(unsigned sampleKey);
+    /// Return pooled bone key by index, creating it if necessary.
+    BoneTimelineKey* GetBoneKey(unsigned index);
+    /// Return pooled sprite key by index, creating it if necessary.
+    SpriteTimelineKey* GetSpriteKey(unsigned index);
     /// Clear mainline key and timeline keys.
     void Clear();
 
@@ -103,10 +117,16 @@ private:
     SpatialInfo spatialInfo_;
     /// Current time.
     float currentTime_{};
+    /// Pose cache interval.
+    float poseCacheInterval_{};
     /// Current mainline key.
     MainlineKey* mainlineKey_{};
-    /// Current timeline keys.
+    /// Current timeline keys, pointing to the key pools.
     PODVector<SpatialTimelineKey*> timelineKeys_;
+    /// Bone keys reused between updates.
+    PODVector<BoneTimelineKey*> boneKeys_;
+    /// Sprite keys reused between updates.
+    PODVector<SpriteTimelineKey*> spriteKeys_;
 };
 
 }
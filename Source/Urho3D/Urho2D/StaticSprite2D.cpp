@@ -51,7 +51,8 @@ StaticSprite2D::StaticSprite2D(Context* context) :
     useTextureRect_(false),
     hotSpot_(0.5f, 0.5f),
     drawRect_(Rect::ZERO),
-    textureRect_(Rect::ZERO)
+    textureRect_(Rect::ZERO),
+    instanced_(false)
 {
     sourceBatches_.Resize(1);
     sourceBatches_[0].owner_ = this;
@@ -268,6 +269,11 @@ ResourceRef StaticSprite2D::GetCustomMaterialAttr() const
     return GetResourceRef(customMaterial_, Material::GetTypeStatic());
 }
 
+void StaticSprite2D::OnSpriteInstancingChanged()
+{
+    UpdateMaterial();
+}
+
 void StaticSprite2D::OnSceneSet(Scene* scene)
 {
     Drawable2D::OnSceneSet(scene);
@@ -284,6 +290,15 @@ void StaticSprite2D::OnWorldBoundingBoxUpdate()
     for (unsigned i = 0; i < sourceBatches[0].vertices_.Size(); ++i)
         worldBoundingBox_.Merge(sourceBatches[0].vertices_[i].position_);
 
+    for (unsigned i = 0; i < sourceBatches[0].instances_.Size(); ++i)
+    {
+        const SpriteInstance2D& instance = sourceBatches[0].instances_[i];
+        worldBoundingBox_.Merge(instance.origin_);
+        worldBoundingBox_.Merge(instance.origin_ + instance.axisX_);
+        worldBoundingBox_.Merge(instance.origin_ + instance.axisY_);
+        worldBoundingBox_.Merge(instance.origin_ + instance.axisX_ + instance.axisY_);
+    }
+
     boundingBox_ = worldBoundingBox_.Transformed(node_->GetWorldTransform().Inverse());
 }
 
@@ -299,6 +314,7 @@ void StaticSprite2D::UpdateSourceBatches()
 
     Vector<Vertex2D>& vertices = sourceBatches_[0].vertices_;
     vertices.Clear();
+    sourceBatches_[0].instances_.Clear();
 
     if (!sprite_)
         return;
@@ -309,6 +325,27 @@ void StaticSprite2D::UpdateSourceBatches()
             return;
     }
 
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+
+    if (instanced_)
+    {
+        // Only the corner and the edges of the quad are transformed, the vertex shader expands the rest. Swapping X and Y
+        // swaps the edges, so that the unit quad corners index the texture rectangle transposed
+        SpriteInstance2D instance;
+        instance.origin_ = worldTransform * Vector3(drawRect_.min_.x_, drawRect_.min_.y_, 0.0f);
+        instance.axisX_ = worldTransform.Column(0) * (drawRect_.max_.x_ - drawRect_.min_.x_);
+        instance.axisY_ = worldTransform.Column(1) * (drawRect_.max_.y_ - drawRect_.min_.y_);
+        if (swapXY_)
+            Swap(instance.axisX_, instance.axisY_);
+        instance.uvRect_ = textureRect_;
+        instance.color_ = color_.ToUInt();
+
+        sourceBatches_[0].instances_.Push(instance);
+
+        sourceBatchesDirty_ = false;
+        return;
+    }
+
     /*
     V1---------V2
     |         / |
@@ -324,7 +361,6 @@ void StaticSprite2D::UpdateSourceBatches()
     Vertex2D vertex3;
 
     // Convert to world space
-    const Matrix3x4& worldTransform = node_->GetWorldTransform();
     vertex0.position_ = worldTransform * Vector3(drawRect_.min_.x_, drawRect_.min_.y_, 0.0f);
     vertex1.position_ = worldTransform * Vector3(drawRect_.min_.x_, drawRect_.max_.y_, 0.0f);
     vertex2.position_ = worldTransform * Vector3(drawRect_.max_.x_, drawRect_.max_.y_, 0.0f);
@@ -347,15 +383,28 @@ void StaticSprite2D::UpdateSourceBatches()
 
 void StaticSprite2D::UpdateMaterial()
 {
+    bool instanced = false;
+
     if (customMaterial_)
         sourceBatches_[0].material_ = customMaterial_;
     else
     {
         if (sprite_ && renderer_)
-            sourceBatches_[0].material_ = renderer_->GetMaterial(sprite_->GetTexture(), blendMode_);
+        {
+            // Custom materials can not be drawn instanced, as their shaders expect the regular vertex layout
+            instanced = sprite_->GetTexture() && renderer_->IsSpriteInstancingActive() && CanDrawInstanced();
+            sourceBatches_[0].material_ = instanced ? renderer_->GetInstancedMaterial(sprite_->GetTexture(), blendMode_) :
+                renderer_->GetMaterial(sprite_->GetTexture(), blendMode_);
+        }
         else
             sourceBatches_[0].material_ = nullptr;
     }
+
+    if (instanced != instanced_)
+    {
+        instanced_ = instanced;
+        sourceBatchesDirty_ = true;
+    }
 }
 
 void StaticSprite2D::UpdateDrawRect()
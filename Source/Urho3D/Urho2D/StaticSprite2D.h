@@ -144,6 +144,9 @@ public:
     /// @property
     Material* GetCustomMaterial() const;
 
+    /// Handle sprite instancing being enabled or disabled (called by Renderer2D).
+    void OnSpriteInstancingChanged() override;
+
     /// Set sprite attribute.
     void SetSpriteAttr(const ResourceRef& value);
     /// Return sprite attribute.
@@ -164,6 +167,8 @@ protected:
     void OnDrawOrderChanged() override;
     /// Update source batches.
     void UpdateSourceBatches() override;
+    /// Return whether can be drawn as a sprite instance. Subclasses that generate their own vertices return false.
+    virtual bool CanDrawInstanced() const { return true; }
     /// Update material.
     void UpdateMaterial();
     /// Update drawRect.
@@ -195,6 +200,8 @@ protected:
     Rect textureRect_;
     /// Custom material.
     SharedPtr<Material> customMaterial_;
+    /// Drawn as a sprite instance flag.
+    bool instanced_;
 };
 
 }
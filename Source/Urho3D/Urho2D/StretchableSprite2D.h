@@ -48,6 +48,8 @@ public:
 protected:
     /// Update source batches.
     void UpdateSourceBatches() override;
+    /// Return whether can be drawn as a sprite instance. Always false, as the stretched borders need their own quads.
+    bool CanDrawInstanced() const override { return false; }
 
     /// The border, represented by the number of pixels from each side.
     IntRect border_; // absolute border in pixels
@@ -51,6 +51,7 @@ void TileMap2D::RegisterObject(Context* context)
     context->RegisterFactory<TileMap2D>(URHO2D_CATEGORY);
 
     URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Tile Chunk Size", GetChunkSize, SetChunkSize, int, DEFAULT_TILE_CHUNK_SIZE, AM_DEFAULT);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Tmx File", GetTmxFileAttr, SetTmxFileAttr, ResourceRef, ResourceRef(TmxFile2D::GetTypeStatic()),
         AM_DEFAULT);
 }
@@ -144,6 +145,7 @@ void TileMap2D::SetTmxFile(TmxFile2D* tmxFile)
         Node* layerNode(rootNode_->CreateTemporaryChild(tmxLayer->GetName(), LOCAL));
 
         auto* layer = layerNode->CreateComponent<TileMapLayer2D>();
+        layer->SetChunkSize(chunkSize_);
         layer->Initialize(this, tmxLayer);
         layer->SetDrawOrder(i * 10);
 
@@ -151,6 +153,21 @@ void TileMap2D::SetTmxFile(TmxFile2D* tmxFile)
     }
 }
 
+void TileMap2D::SetChunkSize(int chunkSize)
+{
+    chunkSize = Max(chunkSize, 0);
+    if (chunkSize == chunkSize_)
+        return;
+
+    chunkSize_ = chunkSize;
+
+    for (unsigned i = 0; i < layers_.Size(); ++i)
+    {
+        if (layers_[i])
+            layers_[i]->SetChunkSize(chunkSize_);
+    }
+}
+
 TmxFile2D* TileMap2D::GetTmxFile() const
 {
     return tmxFile_;
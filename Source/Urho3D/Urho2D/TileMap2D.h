@@ -53,10 +53,16 @@ public:
     void SetTmxFile(TmxFile2D* tmxFile);
     /// Add debug geometry to the debug renderer.
     void DrawDebugGeometry();
+    /// Set size in tiles of the chunks the tile layers are rendered in. 0 creates a node with a StaticSprite2D per tile instead.
+    /// @property
+    void SetChunkSize(int chunkSize);
 
     /// Return tmx file.
     /// @property
     TmxFile2D* GetTmxFile() const;
+    /// Return size in tiles of the rendering chunks.
+    /// @property
+    int GetChunkSize() const { return chunkSize_; }
 
     /// Return information.
     /// @property
@@ -84,6 +90,8 @@ private:
     SharedPtr<TmxFile2D> tmxFile_;
     /// Tile map information.
     TileMapInfo2D info_{};
+    /// Size in tiles of the rendering chunks.
+    int chunkSize_{DEFAULT_TILE_CHUNK_SIZE};
     /// Root node for tile map layer.
     SharedPtr<Node> rootNode_;
     /// Tile map layers.
@@ -32,6 +32,9 @@ namespace Urho3D
 
 class XMLElement;
 
+/// Default size in tiles of the chunks a tile layer is rendered in.
+static const int DEFAULT_TILE_CHUNK_SIZE = 16;
+
 /// Orientation.
 enum Orientation2D
 {
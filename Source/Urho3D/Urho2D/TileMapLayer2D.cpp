@@ -24,8 +24,11 @@
 
 #include "../Core/Context.h"
 #include "../Graphics/DebugRenderer.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Texture2D.h"
 #include "../Resource/ResourceCache.h"
 #include "../Scene/Node.h"
+#include "../Urho2D/Renderer2D.h"
 #include "../Urho2D/StaticSprite2D.h"
 #include "../Urho2D/TileMap2D.h"
 #include "../Urho2D/TileMapLayer2D.h"
@@ -36,6 +39,190 @@
 namespace Urho3D
 {
 
+/// Square block of tiles rendered with one vertex block per material (used by TileMapLayer2D internally).
+class TileMapChunk2D : public Drawable2D
+{
+    URHO3D_OBJECT(TileMapChunk2D, Drawable2D);
+
+public:
+    /// Construct.
+    explicit TileMapChunk2D(Context* context) :
+        Drawable2D(context)
+    {
+    }
+
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Set the layer and the tile index range of the chunk.
+    void SetTiles(TileMapLayer2D* layer, const IntRect& tiles)
+    {
+        layer_ = layer;
+        tiles_ = tiles;
+        MarkTilesDirty();
+    }
+
+    /// Mark the vertices dirty after tiles have changed. Must be called from the main thread, as it also resolves the materials.
+    void MarkTilesDirty()
+    {
+        UpdateMaterials();
+        sourceBatchesDirty_ = true;
+        OnMarkedDirty(node_);
+    }
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override
+    {
+        Drawable2D::OnSceneSet(scene);
+
+        UpdateMaterials();
+        sourceBatchesDirty_ = true;
+    }
+
+    /// Recalculate the world-space bounding box.
+    void OnWorldBoundingBoxUpdate() override
+    {
+        boundingBox_.Clear();
+        worldBoundingBox_.Clear();
+
+        const Vector<SourceBatch2D>& sourceBatches = GetSourceBatches();
+        for (unsigned i = 0; i < sourceBatches.Size(); ++i)
+        {
+            const Vector<Vertex2D>& vertices = sourceBatches[i].vertices_;
+            for (unsigned j = 0; j < vertices.Size(); ++j)
+                worldBoundingBox_.Merge(vertices[j].position_);
+        }
+
+        boundingBox_ = worldBoundingBox_.Transformed(node_->GetWorldTransform().Inverse());
+    }
+
+    /// Handle draw order changed.
+    void OnDrawOrderChanged() override
+    {
+        for (unsigned i = 0; i < sourceBatches_.Size(); ++i)
+            sourceBatches_[i].drawOrder_ = GetDrawOrder();
+    }
+
+    /// Update source batches. May be called from a worker thread during the visibility check.
+    void UpdateSourceBatches() override
+    {
+        if (!sourceBatchesDirty_)
+            return;
+
+        for (unsigned i = 0; i < sourceBatches_.Size(); ++i)
+            sourceBatches_[i].vertices_.Clear();
+
+        if (!layer_ || !layer_->GetTileMap())
+            return;
+
+        const TileMapInfo2D& info = layer_->GetTileMap()->GetInfo();
+        const Matrix3x4& worldTransform = node_->GetWorldTransform();
+        unsigned color = Color::WHITE.ToUInt();
+
+        // Add the quads in the same row-major order the tiles would be drawn in individually
+        for (int y = tiles_.top_; y < tiles_.bottom_; ++y)
+        {
+            for (int x = tiles_.left_; x < tiles_.right_; ++x)
+            {
+                Sprite2D* sprite = layer_->GetTileSprite(x, y);
+                if (!sprite)
+                    continue;
+
+                SourceBatch2D* batch = nullptr;
+                for (unsigned i = 0; i < textures_.Size(); ++i)
+                {
+                    if (textures_[i] == sprite->GetTexture())
+                    {
+                        batch = &sourceBatches_[i];
+                        break;
+                    }
+                }
+                if (!batch)
+                    continue;
+
+                const Tile2D* tile = layer_->GetTile(x, y);
+                bool flipX = tile && tile->GetFlipX();
+                bool flipY = tile && tile->GetFlipY();
+                bool swapXY = tile && tile->GetSwapXY();
+
+                Rect drawRect;
+                Rect textureRect;
+                if (!sprite->GetDrawRectangle(drawRect, flipX, flipY) || !sprite->GetTextureRectangle(textureRect, flipX, flipY))
+                    continue;
+
+                Vector2 position = info.TileIndexToPosition(x, y);
+                drawRect.min_ += position;
+                drawRect.max_ += position;
+
+                Vertex2D vertex0;
+                Vertex2D vertex1;
+                Vertex2D vertex2;
+                Vertex2D vertex3;
+
+                vertex0.position_ = worldTransform * Vector3(drawRect.min_.x_, drawRect.min_.y_, 0.0f);
+                vertex1.position_ = worldTransform * Vector3(drawRect.min_.x_, drawRect.max_.y_, 0.0f);
+                vertex2.position_ = worldTransform * Vector3(drawRect.max_.x_, drawRect.max_.y_, 0.0f);
+                vertex3.position_ = worldTransform * Vector3(drawRect.max_.x_, drawRect.min_.y_, 0.0f);
+
+                vertex0.uv_ = textureRect.min_;
+                (swapXY ? vertex3.uv_ : vertex1.uv_) = Vector2(textureRect.min_.x_, textureRect.max_.y_);
+                vertex2.uv_ = textureRect.max_;
+                (swapXY ? vertex1.uv_ : vertex3.uv_) = Vector2(textureRect.max_.x_, textureRect.min_.y_);
+
+                vertex0.color_ = vertex1.color_ = vertex2.color_ = vertex3.color_ = color;
+
+                batch->vertices_.Push(vertex0);
+                batch->vertices_.Push(vertex1);
+                batch->vertices_.Push(vertex2);
+                batch->vertices_.Push(vertex3);
+            }
+        }
+
+        sourceBatchesDirty_ = false;
+    }
+
+private:
+    /// Create a source batch for each texture used by the tiles. The material lookup from Renderer2D is not thread-safe,
+    /// so this is done beforehand and the vertices are only filled in UpdateSourceBatches().
+    void UpdateMaterials()
+    {
+        textures_.Clear();
+        if (layer_)
+        {
+            for (int y = tiles_.top_; y < tiles_.bottom_; ++y)
+            {
+                for (int x = tiles_.left_; x < tiles_.right_; ++x)
+                {
+                    Sprite2D* sprite = layer_->GetTileSprite(x, y);
+                    if (sprite && sprite->GetTexture() && !textures_.Contains(sprite->GetTexture()))
+                        textures_.Push(sprite->GetTexture());
+                }
+            }
+        }
+
+        sourceBatches_.Resize(textures_.Size());
+        for (unsigned i = 0; i < textures_.Size(); ++i)
+        {
+            sourceBatches_[i].owner_ = this;
+            sourceBatches_[i].drawOrder_ = GetDrawOrder();
+            sourceBatches_[i].material_ = renderer_ ? renderer_->GetMaterial(textures_[i], BLEND_ALPHA) : nullptr;
+        }
+    }
+
+    /// Tile map layer.
+    WeakPtr<TileMapLayer2D> layer_;
+    /// Tile index range.
+    IntRect tiles_;
+    /// Textures of the source batches.
+    PODVector<Texture2D*> textures_;
+};
+
+void TileMapChunk2D::RegisterObject(Context* context)
+{
+    context->RegisterFactory<TileMapChunk2D>();
+}
+
 TileMapLayer2D::TileMapLayer2D(Context* context) :
     Component(context)
 {
@@ -46,6 +233,8 @@ TileMapLayer2D::~TileMapLayer2D() = default;
 void TileMapLayer2D::RegisterObject(Context* context)
 {
     context->RegisterFactory<TileMapLayer2D>();
+
+    TileMapChunk2D::RegisterObject(context);
 }
 
 // Transform vector from node-local space to global space
@@ -173,16 +362,9 @@ void TileMapLayer2D::Initialize(TileMap2D* tileMap, const TmxLayer2D* tmxLayer)
         return;
 
     if (tmxLayer_)
-    {
-        for (unsigned i = 0; i < nodes_.Size(); ++i)
-        {
-            if (nodes_[i])
-                nodes_[i]->Remove();
-        }
-
-        nodes_.Clear();
-    }
+        RemoveTiles();
 
+    tileSprites_.Clear();
     tileLayer_ = nullptr;
     objectGroup_ = nullptr;
     imageLayer_ = nullptr;
@@ -221,6 +403,12 @@ void TileMapLayer2D::SetDrawOrder(int drawOrder)
 
     drawOrder_ = drawOrder;
 
+    for (unsigned i = 0; i < chunks_.Size(); ++i)
+    {
+        if (chunks_[i])
+            chunks_[i]->SetLayer(drawOrder_);
+    }
+
     for (unsigned i = 0; i < nodes_.Size(); ++i)
     {
         if (!nodes_[i])
@@ -239,6 +427,12 @@ void TileMapLayer2D::SetVisible(bool visible)
 
     visible_ = visible;
 
+    for (unsigned i = 0; i < chunks_.Size(); ++i)
+    {
+        if (chunks_[i])
+            chunks_[i]->SetEnabled(visible_);
+    }
+
     for (unsigned i = 0; i < nodes_.Size(); ++i)
     {
         if (nodes_[i])
@@ -246,6 +440,49 @@ void TileMapLayer2D::SetVisible(bool visible)
     }
 }
 
+void TileMapLayer2D::SetChunkSize(int chunkSize)
+{
+    chunkSize = Max(chunkSize, 0);
+    if (chunkSize == chunkSize_)
+        return;
+
+    chunkSize_ = chunkSize;
+
+    // Recreate the tile nodes or chunks
+    if (tileLayer_)
+    {
+        RemoveTiles();
+        SetTileLayer(tileLayer_);
+    }
+}
+
+void TileMapLayer2D::SetTileSprite(int x, int y, Sprite2D* sprite)
+{
+    if (!tileLayer_)
+        return;
+
+    int width = tileLayer_->GetWidth();
+    if (x < 0 || x >= width || y < 0 || y >= tileLayer_->GetHeight())
+        return;
+
+    tileSprites_[y * width + x] = sprite;
+
+    if (chunkSize_)
+    {
+        TileMapChunk2D* chunk = chunks_[(y / chunkSize_) * numChunksX_ + x / chunkSize_];
+        if (chunk)
+            chunk->MarkTilesDirty();
+    }
+    else
+    {
+        Node* tileNode = nodes_[y * width + x];
+        if (tileNode)
+            tileNode->GetComponent<StaticSprite2D>()->SetSprite(sprite);
+        else if (sprite)
+            CreateTileNode(x, y, sprite);
+    }
+}
+
 TileMap2D* TileMapLayer2D::GetTileMap() const
 {
     return tileMap_;
@@ -294,12 +531,28 @@ Node* TileMapLayer2D::GetTileNode(int x, int y) const
     if (!tileLayer_)
         return nullptr;
 
-    if (x < 0 || x >= tileLayer_->GetWidth() || y < 0 || y >= tileLayer_->GetHeight())
+    if (x < 0 || x >= tileLayer_->GetWidth() || y < 0 || y >= tileLayer_->GetHeight() || nodes_.Empty())
         return nullptr;
 
     return nodes_[y * tileLayer_->GetWidth() + x];
 }
 
+Sprite2D* TileMapLayer2D::GetTileSprite(int x, int y) const
+{
+    if (!tileLayer_)
+        return nullptr;
+
+    if (!tileSprites_.Empty() && x >= 0 && x < tileLayer_->GetWidth())
+    {
+        HashMap<unsigned, SharedPtr<Sprite2D> >::ConstIterator i = tileSprites_.Find(y * tileLayer_->GetWidth() + x);
+        if (i != tileSprites_.End())
+            return i->second_;
+    }
+
+    Tile2D* tile = tileLayer_->GetTile(x, y);
+    return tile ? tile->GetSprite() : nullptr;
+}
+
 unsigned TileMapLayer2D::GetNumObjects() const
 {
     if (!objectGroup_)
@@ -341,29 +594,82 @@ void TileMapLayer2D::SetTileLayer(const TmxTileLayer2D* tileLayer)
 
     int width = tileLayer->GetWidth();
     int height = tileLayer->GetHeight();
+
+    if (chunkSize_)
+    {
+        // Render the tiles in square chunks instead of a node per tile. Each chunk is culled as a whole and rebuilds its
+        // vertices only when its tiles change
+        numChunksX_ = (width + chunkSize_ - 1) / chunkSize_;
+        int numChunksY = (height + chunkSize_ - 1) / chunkSize_;
+        chunks_.Resize((unsigned)(numChunksX_ * numChunksY));
+
+        for (int y = 0; y < numChunksY; ++y)
+        {
+            for (int x = 0; x < numChunksX_; ++x)
+            {
+                auto* chunk = GetNode()->CreateComponent<TileMapChunk2D>(LOCAL);
+                chunk->SetTemporary(true);
+                chunk->SetLayer(drawOrder_);
+                chunk->SetOrderInLayer(y * numChunksX_ + x);
+                chunk->SetEnabled(visible_);
+                chunk->SetTiles(this, IntRect(x * chunkSize_, y * chunkSize_, Min((x + 1) * chunkSize_, width),
+                    Min((y + 1) * chunkSize_, height)));
+
+                chunks_[y * numChunksX_ + x] = chunk;
+            }
+        }
+        return;
+    }
+
     nodes_.Resize((unsigned)(width * height));
 
-    const TileMapInfo2D& info = tileMap_->GetInfo();
     for (int y = 0; y < height; ++y)
     {
         for (int x = 0; x < width; ++x)
         {
-            const Tile2D* tile = tileLayer->GetTile(x, y);
-            if (!tile)
-                continue;
+            Sprite2D* sprite = GetTileSprite(x, y);
+            if (sprite)
+                CreateTileNode(x, y, sprite);
+        }
+    }
+}
+
+void TileMapLayer2D::CreateTileNode(int x, int y, Sprite2D* sprite)
+{
+    int width = tileLayer_->GetWidth();
+    const TileMapInfo2D& info = tileMap_->GetInfo();
+    const Tile2D* tile = tileLayer_->GetTile(x, y);
 
-            SharedPtr<Node> tileNode(GetNode()->CreateTemporaryChild("Tile"));
-            tileNode->SetPosition(Vector3(info.TileIndexToPosition(x, y)));
+    SharedPtr<Node> tileNode(GetNode()->CreateTemporaryChild("Tile"));
+    tileNode->SetPosition(Vector3(info.TileIndexToPosition(x, y)));
+    tileNode->SetEnabled(visible_);
 
-            auto* staticSprite = tileNode->CreateComponent<StaticSprite2D>();
-            staticSprite->SetSprite(tile->GetSprite());
-            staticSprite->SetFlip(tile->GetFlipX(), tile->GetFlipY(), tile->GetSwapXY());
-            staticSprite->SetLayer(drawOrder_);
-            staticSprite->SetOrderInLayer(y * width + x);
+    auto* staticSprite = tileNode->CreateComponent<StaticSprite2D>();
+    staticSprite->SetSprite(sprite);
+    if (tile)
+        staticSprite->SetFlip(tile->GetFlipX(), tile->GetFlipY(), tile->GetSwapXY());
+    staticSprite->SetLayer(drawOrder_);
+    staticSprite->SetOrderInLayer(y * width + x);
 
-            nodes_[y * width + x] = tileNode;
-        }
+    nodes_[y * width + x] = tileNode;
+}
+
+void TileMapLayer2D::RemoveTiles()
+{
+    for (unsigned i = 0; i < nodes_.Size(); ++i)
+    {
+        if (nodes_[i])
+            nodes_[i]->Remove();
+    }
+    nodes_.Clear();
+
+    for (unsigned i = 0; i < chunks_.Size(); ++i)
+    {
+        if (chunks_[i])
+            chunks_[i]->Remove();
     }
+    chunks_.Clear();
+    numChunksX_ = 0;
 }
 
 void TileMapLayer2D::SetObjectGroup(const TmxObjectGroup2D* objectGroup)
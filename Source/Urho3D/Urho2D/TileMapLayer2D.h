@@ -35,6 +35,7 @@ namespace Urho3D
 class DebugRenderer;
 class Node;
 class TileMap2D;
+class TileMapChunk2D;
 class TmxImageLayer2D;
 class TmxLayer2D;
 class TmxObjectGroup2D;
@@ -65,6 +66,11 @@ public:
     /// Set visible.
     /// @property
     void SetVisible(bool visible);
+    /// Set size in tiles of the square chunks a tile layer is rendered in, each chunk batching its tiles into one vertex block per material. Zero creates a node with a StaticSprite2D per tile instead.
+    /// @property
+    void SetChunkSize(int chunkSize);
+    /// Set sprite rendered at a tile, keeping the tile's flip flags (for tile layer only). Null removes the tile from rendering. The tile returned by GetTile() is not changed.
+    void SetTileSprite(int x, int y, Sprite2D* sprite);
 
     /// Return tile map.
     TileMap2D* GetTileMap() const;
@@ -80,6 +86,10 @@ public:
     /// @property
     bool IsVisible() const { return visible_; }
 
+    /// Return chunk size in tiles, or zero if a node is created per tile.
+    /// @property
+    int GetChunkSize() const { return chunkSize_; }
+
     /// Return has property.
     bool HasProperty(const String& name) const;
     /// Return property.
@@ -94,10 +104,12 @@ public:
     /// Return height (for tile layer only).
     /// @property
     int GetHeight() const;
-    /// Return tile node (for tile layer only).
+    /// Return tile node (for tile layer only). Return null when the layer is rendered in chunks.
     Node* GetTileNode(int x, int y) const;
     /// Return tile (for tile layer only).
     Tile2D* GetTile(int x, int y) const;
+    /// Return sprite rendered at a tile (for tile layer only).
+    Sprite2D* GetTileSprite(int x, int y) const;
 
     /// Return number of tile map objects (for object group only).
     /// @property
@@ -114,6 +126,10 @@ public:
 private:
     /// Set tile layer.
     void SetTileLayer(const TmxTileLayer2D* tileLayer);
+    /// Create node with a static sprite for a tile.
+    void CreateTileNode(int x, int y, Sprite2D* sprite);
+    /// Remove tile nodes and chunks.
+    void RemoveTiles();
     /// Set object group.
     void SetObjectGroup(const TmxObjectGroup2D* objectGroup);
     /// Set image layer.
@@ -133,8 +149,16 @@ private:
     int drawOrder_{};
     /// Visible.
     bool visible_{true};
+    /// Chunk size in tiles.
+    int chunkSize_{DEFAULT_TILE_CHUNK_SIZE};
+    /// Number of chunks horizontally.
+    int numChunksX_{};
     /// Tile node or image nodes.
     Vector<SharedPtr<Node> > nodes_;
+    /// Tile chunks.
+    Vector<WeakPtr<TileMapChunk2D> > chunks_;
+    /// Sprites overriding those of the tmx tiles, by tile index.
+    HashMap<unsigned, SharedPtr<Sprite2D> > tileSprites_;
 };
 
 }
@@ -0,0 +1,53 @@
+// Separable Gaussian blur of the diffuse texture into the output texture of a renderpath compute command, one thread per
+// output texel. The input is read without filtering at the texel corresponding to the output texel. Parameter 0 holds the
+// blur direction, the radius in input texels and the sigma
+
+cbuffer ComputeParameters
+{
+    float4 cOutputSize;
+    float4 cParams[4];
+}
+
+Texture2D tDiffMap;
+RWTexture2D<float4> rwOutput;
+
+#if defined(BLUR9)
+static const int NUM_TAPS = 9;
+#elif defined(BLUR7)
+static const int NUM_TAPS = 7;
+#elif defined(BLUR5)
+static const int NUM_TAPS = 5;
+#else
+static const int NUM_TAPS = 3;
+#endif
+
+float4 LoadClamped(int2 texel, int2 inputSize)
+{
+    return tDiffMap.Load(int3(clamp(texel, int2(0, 0), inputSize - 1), 0));
+}
+
+[numthreads(8, 8, 1)]
+void CS(uint3 dispatchId : SV_DispatchThreadID)
+{
+    if (dispatchId.x >= (uint)cOutputSize.x || dispatchId.y >= (uint)cOutputSize.y)
+        return;
+
+    uint inputWidth, inputHeight;
+    tDiffMap.GetDimensions(inputWidth, inputHeight);
+    int2 inputSize = int2(inputWidth, inputHeight);
+    float2 inputPos = (dispatchId.xy + 0.5) * cOutputSize.zw * inputSize;
+    int2 center = int2(inputPos);
+
+    float2 blurStep = cParams[0].xy * cParams[0].z;
+    float sigma = cParams[0].w;
+    float4 color = 0;
+    float weightSum = 0;
+    for (int i = -NUM_TAPS / 2; i <= NUM_TAPS / 2; ++i)
+    {
+        float weight = exp(-(i * i) / (2.0 * sigma * sigma));
+        color += LoadClamped(center + int2(round(blurStep * i)), inputSize) * weight;
+        weightSum += weight;
+    }
+
+    rwOutput[dispatchId.xy] = color / weightSum;
+}
@@ -0,0 +1,37 @@
+// Copies index ranges of a raw 16- or 32-bit source index buffer into a raw 32-bit destination index buffer. Each thread
+// group copies one range, given as source index start, destination index start and index count
+
+cbuffer CompactParameters
+{
+    uint cNumRanges;
+    uint cFirstRange;
+    uint cLargeSourceIndices;
+    uint cPadding;
+}
+
+StructuredBuffer<uint3> sIndexRanges;
+ByteAddressBuffer bSourceIndices;
+RWByteAddressBuffer rwCompactedIndices;
+
+static const uint GROUP_SIZE = 64;
+
+uint LoadSourceIndex(uint index)
+{
+    if (cLargeSourceIndices)
+        return bSourceIndices.Load(index * 4);
+
+    uint indexPair = bSourceIndices.Load((index & ~1u) * 2);
+    return (index & 1) ? indexPair >> 16 : indexPair & 0xffff;
+}
+
+[numthreads(64, 1, 1)]
+void CS(uint3 groupId : SV_GroupID, uint3 threadId : SV_GroupThreadID)
+{
+    uint rangeIndex = cFirstRange + groupId.x;
+    if (rangeIndex >= cNumRanges)
+        return;
+
+    uint3 range = sIndexRanges[rangeIndex];
+    for (uint i = threadId.x; i < range.z; i += GROUP_SIZE)
+        rwCompactedIndices.Store((range.y + i) * 4, LoadSourceIndex(range.x + i));
+}
@@ -4,8 +4,13 @@
 #include "ScreenPos.hlsl"
 #include "Lighting.hlsl"
 
+// Directional lights and the clustered lights are drawn as fullscreen quads
+#if defined(DIRLIGHT) || defined(CLUSTERED)
+    #define LIGHTQUAD
+#endif
+
 void VS(float4 iPos : POSITION,
-    #ifdef DIRLIGHT
+    #ifdef LIGHTQUAD
         out float2 oScreenPos : TEXCOORD0,
     #else
         out float4 oScreenPos : TEXCOORD0,
@@ -19,7 +24,7 @@ void VS(float4 iPos : POSITION,
     float4x3 modelMatrix = iModelMatrix;
     float3 worldPos = GetWorldPos(modelMatrix);
     oPos = GetClipPos(worldPos);
-    #ifdef DIRLIGHT
+    #ifdef LIGHTQUAD
         oScreenPos = GetScreenPosPreDiv(oPos);
         oFarRay = GetFarRay(oPos);
         #ifdef ORTHO
@@ -35,7 +40,7 @@ void VS(float4 iPos : POSITION,
 }
 
 void PS(
-    #ifdef DIRLIGHT
+    #ifdef LIGHTQUAD
         float2 iScreenPos : TEXCOORD0,
     #else
         float4 iScreenPos : TEXCOORD0,
@@ -44,10 +49,13 @@ void PS(
     #ifdef ORTHO
         float3 iNearRay : TEXCOORD2,
     #endif
+    #ifdef CLUSTERED
+        float4 iFragPos : SV_POSITION,
+    #endif
     out float4 oColor : OUTCOLOR0)
 {
-    // If rendering a directional light quad, optimize out the w divide
-    #ifdef DIRLIGHT
+    // If rendering a fullscreen quad, optimize out the w divide
+    #ifdef LIGHTQUAD
         float depth = Sample2DLod0(DepthBuffer, iScreenPos).r;
         #ifdef HWDEPTH
             depth = ReconstructDepth(depth);
@@ -78,29 +86,38 @@ void PS(
     worldPos += cCameraPosPS;
 
     float3 normal = normalize(normalInput.rgb * 2.0 - 1.0);
-    float4 projWorldPos = float4(worldPos, 1.0);
-    float3 lightColor;
-    float3 lightDir;
 
-    float diff = GetDiffuse(normal, worldPos, lightDir);
+    #ifdef CLUSTERED
+        // Accumulate all unshadowed point and spot lights of the pixel's cluster
+        float3 clusterDiffuse;
+        float3 clusterSpecular;
+        GetClusteredLight(iFragPos, worldPos, normal, eyeVec, normalInput.a * 255.0, clusterDiffuse, clusterSpecular);
+        oColor = float4(clusterDiffuse * albedoInput.rgb + clusterSpecular * albedoInput.aaa, 0.0);
+    #else
+        float4 projWorldPos = float4(worldPos, 1.0);
+        float3 lightColor;
+        float3 lightDir;
 
-    #ifdef SHADOW
-        diff *= GetShadowDeferred(projWorldPos, normal, depth);
-    #endif
+        float diff = GetDiffuse(normal, worldPos, lightDir);
 
-    #if defined(SPOTLIGHT)
-        float4 spotPos = mul(projWorldPos, cLightMatricesPS[0]);
-        lightColor = spotPos.w > 0.0 ? Sample2DProj(LightSpotMap, spotPos).rgb * cLightColor.rgb : 0.0;
-    #elif defined(CUBEMASK)
-        lightColor = texCUBE(sLightCubeMap, mul(worldPos - cLightPosPS.xyz, (float3x3)cLightMatricesPS[0])).rgb * cLightColor.rgb;
-    #else
-        lightColor = cLightColor.rgb;
-    #endif
+        #ifdef SHADOW
+            diff *= GetShadowDeferred(projWorldPos, normal, depth);
+        #endif
 
-    #ifdef SPECULAR
-        float spec = GetSpecular(normal, eyeVec, lightDir, normalInput.a * 255.0);
-        oColor = diff * float4(lightColor * (albedoInput.rgb + spec * cLightColor.a * albedoInput.aaa), 0.0);
-    #else
-        oColor = diff * float4(lightColor * albedoInput.rgb, 0.0);
+        #if defined(SPOTLIGHT)
+            float4 spotPos = mul(projWorldPos, cLightMatricesPS[0]);
+            lightColor = spotPos.w > 0.0 ? Sample2DProj(LightSpotMap, spotPos).rgb * cLightColor.rgb : 0.0;
+        #elif defined(CUBEMASK)
+            lightColor = texCUBE(sLightCubeMap, mul(worldPos - cLightPosPS.xyz, (float3x3)cLightMatricesPS[0])).rgb * cLightColor.rgb;
+        #else
+            lightColor = cLightColor.rgb;
+        #endif
+
+        #ifdef SPECULAR
+            float spec = GetSpecular(normal, eyeVec, lightDir, normalInput.a * 255.0);
+            oColor = diff * float4(lightColor * (albedoInput.rgb + spec * cLightColor.a * albedoInput.aaa), 0.0);
+        #else
+            oColor = diff * float4(lightColor * albedoInput.rgb, 0.0);
+        #endif
     #endif
 }
@@ -0,0 +1,34 @@
+#include "Uniforms.hlsl"
+#include "Samplers.hlsl"
+#include "Transform.hlsl"
+
+void VS(float4 iPos : POSITION,
+    out float4 oPos : OUTPOSITION)
+{
+    float4x3 modelMatrix = iModelMatrix;
+    float3 worldPos = GetWorldPos(modelMatrix);
+    oPos = GetClipPos(worldPos);
+}
+
+// Reduce the depth buffer to the destination size, keeping the farthest depth of the source texels each destination
+// pixel covers so that occlusion tests against the result stay conservative
+void PS(float4 iFragPos : SV_POSITION,
+    out float4 oColor : OUTCOLOR0)
+{
+    uint srcWidth, srcHeight;
+    tDepthBuffer.GetDimensions(srcWidth, srcHeight);
+    float2 scale = float2(srcWidth, srcHeight) * cGBufferInvSize;
+    float2 destPos = floor(iFragPos.xy);
+
+    uint2 begin = uint2(destPos * scale);
+    uint2 end = min(uint2(ceil((destPos + 1.0) * scale)), uint2(srcWidth, srcHeight));
+
+    float depth = 0.0;
+    for (uint y = begin.y; y < end.y; ++y)
+    {
+        for (uint x = begin.x; x < end.x; ++x)
+            depth = max(depth, tDepthBuffer.Load(int3(x, y, 0)).r);
+    }
+
+    oColor = float4(depth, 0.0, 0.0, 0.0);
+}
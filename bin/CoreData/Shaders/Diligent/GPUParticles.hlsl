@@ -0,0 +1,235 @@
+// Spawns and simulates the particles of a GPU particle emitter in a raw state buffer and writes their billboard vertices
+// into a raw vertex buffer in the billboard set vertex format. Dead particles are written as zero-size quads, rotations
+// are in degrees and the direction byte offset is 0xffffffff when the billboards do not face their direction
+
+cbuffer ParticleParameters
+{
+    uint cNumParticles;
+    uint cSpawnStart;
+    uint cNumSpawn;
+    uint cSeed;
+    uint cDestStride;
+    uint cDirectionOffset;
+    uint cEmitterType;
+    uint cReset;
+    uint cNumColorFrames;
+    uint cNumTextureFrames;
+    float cTimeStep;
+    float cDampingForce;
+    float cSizeAdd;
+    float cSizeMul;
+    float cMinVelocity;
+    float cMaxVelocity;
+    float cMinTimeToLive;
+    float cMaxTimeToLive;
+    float cMinRotation;
+    float cMaxRotation;
+    float cMinRotationSpeed;
+    float cMaxRotationSpeed;
+    float2 cSizeScale;
+    float4 cSizeRange;
+    float4 cEmitterSize;
+    float4 cMinDirection;
+    float4 cMaxDirection;
+    float4 cConstantForce;
+    float4 cPositionScale;
+    float4 cEmitTransform[3];
+    float4 cColorFrames[16];
+    float4 cColorTimes[4];
+    float4 cTextureFrames[16];
+    float4 cTextureTimes[4];
+}
+
+// Position and timer, velocity and time to live, size, scale and rotation, then rotation speed, color frame, texture
+// frame and alive flag of each particle
+RWByteAddressBuffer rwParticleStates;
+RWByteAddressBuffer rwParticleVertices;
+
+static const uint ABSENT_ELEMENT = 0xffffffff;
+static const uint STATE_STRIDE = 64;
+static const uint EMITTER_SPHERE = 0;
+static const uint EMITTER_BOX = 1;
+static const uint EMITTER_SPHEREVOLUME = 2;
+static const uint EMITTER_CYLINDER = 3;
+static const uint EMITTER_RING = 4;
+
+uint Hash(uint value)
+{
+    uint state = value * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+float Random(inout uint seed)
+{
+    seed = Hash(seed);
+    return (seed >> 8) * (1.0 / 16777216.0);
+}
+
+float3 RandomUnitVector(inout uint seed)
+{
+    float3 dir = float3(Random(seed), Random(seed), Random(seed)) * 2.0 - 1.0;
+    return dot(dir, dir) > 0.0 ? normalize(dir) : float3(0.0, 1.0, 0.0);
+}
+
+float3 GetStartPosition(inout uint seed)
+{
+    float3 emitterSize = cEmitterSize.xyz;
+
+    if (cEmitterType == EMITTER_BOX)
+        return (float3(Random(seed), Random(seed), Random(seed)) - 0.5) * emitterSize;
+    else if (cEmitterType == EMITTER_SPHEREVOLUME)
+    {
+        float3 dir = RandomUnitVector(seed);
+        return emitterSize * dir * pow(Random(seed), 1.0 / 3.0) * 0.5;
+    }
+    else if (cEmitterType == EMITTER_CYLINDER)
+    {
+        float angle = Random(seed) * 6.28318531;
+        float radius = sqrt(Random(seed)) * 0.5;
+        return float3(cos(angle) * radius, Random(seed) - 0.5, sin(angle) * radius) * emitterSize;
+    }
+    else if (cEmitterType == EMITTER_RING)
+    {
+        float angle = Random(seed) * 6.28318531;
+        return float3(cos(angle), Random(seed) * 2.0 - 1.0, sin(angle)) * emitterSize * 0.5;
+    }
+    else
+        return emitterSize * RandomUnitVector(seed) * 0.5;
+}
+
+void StoreVertex(uint dest, float3 position, float3 direction, uint color, float2 uv, float2 size)
+{
+    rwParticleVertices.Store3(dest, asuint(position));
+    dest += 12;
+    if (cDirectionOffset != ABSENT_ELEMENT)
+    {
+        rwParticleVertices.Store3(dest, asuint(direction));
+        dest += 12;
+    }
+    rwParticleVertices.Store(dest, color);
+    rwParticleVertices.Store2(dest + 4, asuint(uv));
+    rwParticleVertices.Store2(dest + 12, asuint(size));
+}
+
+uint PackColor(float4 color)
+{
+    uint4 bytes = uint4(saturate(color) * 255.0);
+    return bytes.r | (bytes.g << 8) | (bytes.b << 16) | (bytes.a << 24);
+}
+
+[numthreads(64, 1, 1)]
+void CS(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= cNumParticles)
+        return;
+
+    uint address = id.x * STATE_STRIDE;
+    float4 state0 = cReset ? 0.0 : asfloat(rwParticleStates.Load4(address));
+    float4 state1 = cReset ? 0.0 : asfloat(rwParticleStates.Load4(address + 16));
+    float4 state2 = cReset ? 0.0 : asfloat(rwParticleStates.Load4(address + 32));
+    uint4 state3 = cReset ? 0 : rwParticleStates.Load4(address + 48);
+
+    float3 position = state0.xyz;
+    float timer = state0.w;
+    float3 velocity = state1.xyz;
+    float timeToLive = state1.w;
+    float2 baseSize = state2.xy;
+    float scale = state2.z;
+    float rotation = state2.w;
+    float rotationSpeed = asfloat(state3.x);
+    uint colorIndex = state3.y;
+    uint texIndex = state3.z;
+    bool alive = state3.w != 0;
+
+    // Spawn into the ring buffer range that the emitter reserved for this frame
+    if ((id.x + cNumParticles - cSpawnStart) % cNumParticles < cNumSpawn)
+    {
+        uint seed = Hash(cSeed ^ Hash(id.x));
+        float3 startDir = lerp(cMinDirection.xyz, cMaxDirection.xyz, float3(Random(seed), Random(seed), Random(seed)));
+        startDir = dot(startDir, startDir) > 0.0 ? normalize(startDir) : startDir;
+        float3 startPos = GetStartPosition(seed);
+
+        baseSize = lerp(cSizeRange.xy, cSizeRange.zw, Random(seed));
+        timer = 0.0;
+        timeToLive = lerp(cMinTimeToLive, cMaxTimeToLive, Random(seed));
+        scale = 1.0;
+        rotationSpeed = lerp(cMinRotationSpeed, cMaxRotationSpeed, Random(seed));
+        rotation = lerp(cMinRotation, cMaxRotation, Random(seed));
+        colorIndex = 0;
+        texIndex = 0;
+        alive = true;
+
+        if (cDirectionOffset != ABSENT_ELEMENT)
+            startPos += startDir * baseSize.y;
+
+        position = float3(dot(cEmitTransform[0], float4(startPos, 1.0)), dot(cEmitTransform[1], float4(startPos, 1.0)),
+            dot(cEmitTransform[2], float4(startPos, 1.0)));
+        startDir = float3(dot(cEmitTransform[0].xyz, startDir), dot(cEmitTransform[1].xyz, startDir), dot(cEmitTransform[2].xyz, startDir));
+        startDir = dot(startDir, startDir) > 0.0 ? normalize(startDir) : startDir;
+        velocity = lerp(cMinVelocity, cMaxVelocity, Random(seed)) * startDir;
+    }
+    else if (alive)
+    {
+        if (timer >= timeToLive)
+            alive = false;
+        else
+        {
+            timer += cTimeStep;
+
+            velocity += cTimeStep * cConstantForce.xyz;
+            velocity *= 1.0 - cTimeStep * cDampingForce;
+            position += cTimeStep * velocity * cPositionScale.xyz;
+            rotation += cTimeStep * rotationSpeed;
+
+            if (cSizeAdd != 0.0 || cSizeMul != 1.0)
+            {
+                scale = max(scale + cTimeStep * cSizeAdd, 0.0);
+                scale *= cTimeStep * (cSizeMul - 1.0) + 1.0;
+            }
+        }
+    }
+
+    // Color and texture animation
+    float4 color = float4(1.0, 1.0, 1.0, 1.0);
+    if (cNumColorFrames)
+    {
+        while (colorIndex + 1 < cNumColorFrames && timer >= cColorTimes[(colorIndex + 1) >> 2][(colorIndex + 1) & 3])
+            ++colorIndex;
+        color = cColorFrames[colorIndex];
+        if (colorIndex + 1 < cNumColorFrames)
+        {
+            float frameTime = cColorTimes[colorIndex >> 2][colorIndex & 3];
+            float interval = cColorTimes[(colorIndex + 1) >> 2][(colorIndex + 1) & 3] - frameTime;
+            if (interval > 0.0)
+                color = lerp(color, cColorFrames[colorIndex + 1], (timer - frameTime) / interval);
+        }
+    }
+    float4 uv = float4(0.0, 0.0, 1.0, 1.0);
+    if (cNumTextureFrames)
+    {
+        while (texIndex + 1 < cNumTextureFrames && timer >= cTextureTimes[(texIndex + 1) >> 2][(texIndex + 1) & 3])
+            ++texIndex;
+        uv = cTextureFrames[texIndex];
+    }
+
+    rwParticleStates.Store4(address, asuint(float4(position, timer)));
+    rwParticleStates.Store4(address + 16, asuint(float4(velocity, timeToLive)));
+    rwParticleStates.Store4(address + 32, asuint(float4(baseSize, scale, rotation)));
+    rwParticleStates.Store4(address + 48, uint4(asuint(rotationSpeed), colorIndex, texIndex, alive ? 1 : 0));
+
+    float2 size = alive ? baseSize * scale * cSizeScale : 0.0;
+    uint packedColor = alive ? PackColor(color) : 0;
+    float3 direction = dot(velocity, velocity) > 0.0 ? normalize(velocity) : float3(0.0, 1.0, 0.0);
+
+    float sinRot, cosRot;
+    sincos(radians(rotation), sinRot, cosRot);
+    float2 right = size.x * float2(cosRot, -sinRot);
+    float2 up = size.y * float2(sinRot, cosRot);
+
+    uint dest = id.x * 4 * cDestStride;
+    StoreVertex(dest, position, direction, packedColor, uv.xy, -right + up);
+    StoreVertex(dest + cDestStride, position, direction, packedColor, uv.zy, right + up);
+    StoreVertex(dest + 2 * cDestStride, position, direction, packedColor, uv.zw, right - up);
+    StoreVertex(dest + 3 * cDestStride, position, direction, packedColor, uv.xw, -right - up);
+}
@@ -187,6 +187,49 @@ float GetIntensity(float3 color)
     return dot(color, float3(0.299, 0.587, 0.114));
 }
 
+#ifdef CLUSTERED
+struct ClusterLight
+{
+    float4 posInvRange;
+    float4 colorSpecIntensity;
+    float4 dirCosOuter;
+    float4 spotScale;
+};
+
+StructuredBuffer<ClusterLight> sClusterLights;
+StructuredBuffer<uint2> sClusters;
+StructuredBuffer<uint> sClusterLightIndices;
+
+void GetClusteredLight(float4 fragPos, float3 worldPos, float3 normal, float3 eyeVec, float specularPower,
+    out float3 diffuse, out float3 specular)
+{
+    // Find the cluster from the screen tile and the exponential depth slice
+    float2 tile = clamp((fragPos.xy - cClusterTile.xy) * cClusterTile.zw, 0.0, float2(CLUSTERGRIDX - 1, CLUSTERGRIDY - 1));
+    float depth = max(dot(cClusterPlane.xyz, worldPos) + cClusterPlane.w, 0.00001);
+    float slice = clamp(log(depth) * cClusterSlice.x + cClusterSlice.y, 0.0, CLUSTERGRIDZ - 1);
+    uint2 cluster = sClusters[((uint)slice * CLUSTERGRIDY + (uint)tile.y) * CLUSTERGRIDX + (uint)tile.x];
+
+    diffuse = 0.0;
+    specular = 0.0;
+    for (uint i = 0; i < cluster.y; ++i)
+    {
+        ClusterLight light = sClusterLights[sClusterLightIndices[cluster.x + i]];
+        float3 lightVec = light.posInvRange.xyz - worldPos;
+        float lightDist = length(lightVec);
+        float3 lightDir = lightVec / max(lightDist, 0.00001);
+
+        float atten = saturate(1.0 - lightDist * light.posInvRange.w);
+        atten *= atten;
+        atten *= saturate((dot(-lightDir, light.dirCosOuter.xyz) - light.dirCosOuter.w) * light.spotScale.x);
+
+        float diff = saturate(dot(normal, lightDir)) * atten;
+        diffuse += diff * light.colorSpecIntensity.rgb;
+        specular += diff * GetSpecular(normal, eyeVec, lightDir, specularPower) * light.colorSpecIntensity.rgb *
+            light.colorSpecIntensity.a;
+    }
+}
+#endif
+
 #ifdef SHADOW
 
 #ifdef DIRLIGHT
@@ -290,7 +333,7 @@ float GetPointShadow(float3 lightVec)
     // Read the 2D UV coordinates, adjust according to shadow map size and add face offset
     float4 indirectPos = SampleCube(IndirectionCubeMap, lightVec);
     indirectPos.xy *= cShadowCubeAdjust.xy;
-    indirectPos.xy += float2(cShadowCubeAdjust.z + indirectPos.z * 0.5, cShadowCubeAdjust.w + indirectPos.w);
+    indirectPos.xy += float2(cShadowCubeAdjust.z + indirectPos.z * cShadowCubeScale.x, cShadowCubeAdjust.w + indirectPos.w * cShadowCubeScale.y);
 
     float4 shadowPos = float4(indirectPos.xy, cShadowDepthFade.x + cShadowDepthFade.y / depth, 1.0);
     return GetShadow(shadowPos);
@@ -30,6 +30,9 @@ void VS(float4 iPos : POSITION,
             float4 iModelInstanceCol1 : TEXCOORD4,
             float4 iModelInstanceCol2 : TEXCOORD5,
             float4 iModelInstanceCol3 : TEXCOORD6,
+            #ifdef BINDLESS
+                float4 iTextureIndex : TEXCOORD7,
+            #endif
         #else
             float4x3 iModelInstance : TEXCOORD4,
         #endif
@@ -68,6 +71,9 @@ void VS(float4 iPos : POSITION,
     #ifdef VERTEXCOLOR
         out float4 oColor : COLOR0,
     #endif
+    #ifdef BINDLESS
+        nointerpolation out float oTextureIndex : TEXCOORD8,
+    #endif
     #if (defined(D3D11) || defined(DILIGENT)) && defined(CLIPPLANE)
         out float oClip : SV_CLIPDISTANCE0,
     #endif
@@ -92,6 +98,14 @@ void VS(float4 iPos : POSITION,
         oColor = iColor;
     #endif
 
+    #ifdef BINDLESS
+        #ifdef INSTANCED
+            oTextureIndex = iTextureIndex.x;
+        #else
+            oTextureIndex = 0.0;
+        #endif
+    #endif
+
     #ifdef NORMALMAP
         float4 tangent = GetWorldTangent(modelMatrix);
         float3 bitangent = cross(tangent.xyz, oNormal) * tangent.w;
@@ -174,9 +188,15 @@ void PS(
     #ifdef VERTEXCOLOR
         float4 iColor : COLOR0,
     #endif
+    #ifdef BINDLESS
+        nointerpolation float iTextureIndex : TEXCOORD8,
+    #endif
     #if (defined(D3D11) || defined(DILIGENT)) && defined(CLIPPLANE)
         float iClip : SV_CLIPDISTANCE0,
     #endif
+    #ifdef CLUSTERED
+        float4 iFragPos : SV_POSITION,
+    #endif
     #ifdef PREPASS
         out float4 oDepth : OUTCOLOR1,
     #endif
@@ -189,7 +209,11 @@ void PS(
 {
     // Get material diffuse albedo
     #ifdef DIFFMAP
-        float4 diffInput = Sample2D(DiffMap, iTexCoord.xy);
+        #ifdef BINDLESS
+            float4 diffInput = tDiffMaps[NonUniformResourceIndex((uint)iTextureIndex)].Sample(tDiffMaps_sampler, iTexCoord.xy);
+        #else
+            float4 diffInput = Sample2D(DiffMap, iTexCoord.xy);
+        #endif
         #ifdef ALPHAMASK
             if (diffInput.a < 0.5)
                 discard;
@@ -299,6 +323,15 @@ void PS(
             finalColor += Sample2D(EmissiveMap, iTexCoord2).rgb * cAmbientColor.rgb * diffColor.rgb;
         #endif
 
+        #ifdef CLUSTERED
+            // Add the unshadowed point and spot lights of the pixel's cluster
+            float3 clusterDiffuse;
+            float3 clusterSpecular;
+            GetClusteredLight(iFragPos, iWorldPos.xyz, normal, cCameraPosPS - iWorldPos.xyz, cMatSpecColor.a, clusterDiffuse,
+                clusterSpecular);
+            finalColor += clusterDiffuse * diffColor.rgb + clusterSpecular * specColor;
+        #endif
+
         #ifdef MATERIAL
             // Add light pre-pass accumulation result
             // Lights are accumulated at half intensity. Bring back to full intensity now
@@ -0,0 +1,59 @@
+// Adds weighted morph deltas to the morph range of a raw source vertex buffer, writing into the same vertices of a raw
+// destination vertex buffer. Element byte offsets of 0xffffffff mark elements the destination does not have
+
+cbuffer MorphParameters
+{
+    uint cVertexStart;
+    uint cVertexCount;
+    uint cSourceStride;
+    uint cDestStride;
+    uint cPositionOffset;
+    uint cNormalOffset;
+    uint cTangentOffset;
+    uint cDestPositionOffset;
+    uint cDestNormalOffset;
+    uint cDestTangentOffset;
+    uint cNumMorphs;
+    uint cPadding;
+    float4 cMorphWeights[16];
+    uint4 cMorphDeltaBlocks[16];
+}
+
+// Position, normal and tangent deltas of each morph range vertex, in blocks of cVertexCount vertices per morph
+ByteAddressBuffer bMorphDeltas;
+ByteAddressBuffer bSourceVertices;
+RWByteAddressBuffer rwMorphedVertices;
+
+static const uint ABSENT_ELEMENT = 0xffffffff;
+static const uint DELTA_STRIDE = 36;
+
+[numthreads(64, 1, 1)]
+void CS(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= cVertexCount)
+        return;
+
+    uint vertex = cVertexStart + id.x;
+    uint src = vertex * cSourceStride;
+    uint dest = vertex * cDestStride;
+
+    float3 position = cPositionOffset != ABSENT_ELEMENT ? asfloat(bSourceVertices.Load3(src + cPositionOffset)) : 0.0;
+    float3 normal = cNormalOffset != ABSENT_ELEMENT ? asfloat(bSourceVertices.Load3(src + cNormalOffset)) : 0.0;
+    float4 tangent = cTangentOffset != ABSENT_ELEMENT ? asfloat(bSourceVertices.Load4(src + cTangentOffset)) : 0.0;
+
+    for (uint i = 0; i < cNumMorphs; ++i)
+    {
+        float weight = cMorphWeights[i >> 2][i & 3];
+        uint delta = (cMorphDeltaBlocks[i >> 2][i & 3] * cVertexCount + id.x) * DELTA_STRIDE;
+        position += asfloat(bMorphDeltas.Load3(delta)) * weight;
+        normal += asfloat(bMorphDeltas.Load3(delta + 12)) * weight;
+        tangent.xyz += asfloat(bMorphDeltas.Load3(delta + 24)) * weight;
+    }
+
+    if (cDestPositionOffset != ABSENT_ELEMENT)
+        rwMorphedVertices.Store3(dest + cDestPositionOffset, asuint(position));
+    if (cDestNormalOffset != ABSENT_ELEMENT)
+        rwMorphedVertices.Store3(dest + cDestNormalOffset, asuint(normal));
+    if (cDestTangentOffset != ABSENT_ELEMENT)
+        rwMorphedVertices.Store4(dest + cDestTangentOffset, asuint(tangent));
+}
@@ -44,6 +44,9 @@ Texture2D tDepthBuffer;
 Texture2D tLightBuffer;
 TextureCube tZoneCubeMap;
 Texture3D tZoneVolumeMap;
+#ifdef BINDLESS
+    Texture2D tDiffMaps[MAXBINDLESSTEXTURES];
+#endif
 
 SamplerState tDiffMap_sampler;
 SamplerState tDiffCubeMap_sampler;
@@ -70,6 +73,9 @@ SamplerState tDepthBuffer_sampler;
 SamplerState tLightBuffer_sampler;
 SamplerState tZoneCubeMap_sampler;
 SamplerState tZoneVolumeMap_sampler;
+#ifdef BINDLESS
+    SamplerState tDiffMaps_sampler;
+#endif
 
 #else
 
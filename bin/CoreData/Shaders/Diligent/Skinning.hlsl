@@ -0,0 +1,68 @@
+// Skins a vertex range of a raw source vertex buffer into the same vertices of a raw destination vertex buffer.
+// Element byte offsets of 0xffffffff mark absent normals and tangents
+
+cbuffer SkinningParameters
+{
+    uint cVertexStart;
+    uint cVertexCount;
+    uint cSourceStride;
+    uint cDestStride;
+    uint cPositionOffset;
+    uint cNormalOffset;
+    uint cTangentOffset;
+    uint cWeightsOffset;
+    uint cIndicesOffset;
+    uint cDestPositionOffset;
+    uint cDestNormalOffset;
+    uint cDestTangentOffset;
+}
+
+// Three rows per skin matrix
+StructuredBuffer<float4> sSkinMatrices;
+ByteAddressBuffer bSourceVertices;
+RWByteAddressBuffer rwSkinnedVertices;
+
+static const uint ABSENT_ELEMENT = 0xffffffff;
+
+[numthreads(64, 1, 1)]
+void CS(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= cVertexCount)
+        return;
+
+    uint vertex = cVertexStart + id.x;
+    uint src = vertex * cSourceStride;
+    uint dest = vertex * cDestStride;
+
+    float4 weights = asfloat(bSourceVertices.Load4(src + cWeightsOffset));
+    uint packedIndices = bSourceVertices.Load(src + cIndicesOffset);
+    uint4 indices = uint4(packedIndices & 0xff, (packedIndices >> 8) & 0xff, (packedIndices >> 16) & 0xff, packedIndices >> 24) * 3;
+
+    float4 row0 = 0.0;
+    float4 row1 = 0.0;
+    float4 row2 = 0.0;
+    [unroll]
+    for (uint i = 0; i < 4; ++i)
+    {
+        row0 += sSkinMatrices[indices[i]] * weights[i];
+        row1 += sSkinMatrices[indices[i] + 1] * weights[i];
+        row2 += sSkinMatrices[indices[i] + 2] * weights[i];
+    }
+
+    float4 position = float4(asfloat(bSourceVertices.Load3(src + cPositionOffset)), 1.0);
+    rwSkinnedVertices.Store3(dest + cDestPositionOffset, asuint(float3(dot(row0, position), dot(row1, position), dot(row2, position))));
+
+    if (cNormalOffset != ABSENT_ELEMENT)
+    {
+        float3 normal = asfloat(bSourceVertices.Load3(src + cNormalOffset));
+        normal = normalize(float3(dot(row0.xyz, normal), dot(row1.xyz, normal), dot(row2.xyz, normal)));
+        rwSkinnedVertices.Store3(dest + cDestNormalOffset, asuint(normal));
+    }
+
+    if (cTangentOffset != ABSENT_ELEMENT)
+    {
+        float4 tangent = asfloat(bSourceVertices.Load4(src + cTangentOffset));
+        tangent.xyz = normalize(float3(dot(row0.xyz, tangent.xyz), dot(row1.xyz, tangent.xyz), dot(row2.xyz, tangent.xyz)));
+        rwSkinnedVertices.Store4(dest + cDestTangentOffset, asuint(tangent));
+    }
+}
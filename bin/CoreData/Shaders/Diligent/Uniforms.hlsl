@@ -49,6 +49,12 @@ cbuffer MaterialVS : register(b4)
 {
     float4 cUOffset;
     float4 cVOffset;
+#ifdef GPUTERRAIN
+    float4x3 cGPUTerrainTransform;
+    float4 cGPUTerrainSize;
+    float4 cGPUTerrainLod;
+    float3 cGPUTerrainCamera;
+#endif
 }
 #endif
 
@@ -80,6 +86,11 @@ cbuffer CameraPS : register(b1)
     float2 cGBufferInvSize;
     float cNearClipPS;
     float cFarClipPS;
+#ifdef CLUSTERED
+    float4 cClusterTile;
+    float4 cClusterPlane;
+    float2 cClusterSlice;
+#endif
 }
 
 cbuffer ZonePS : register(b2)
@@ -98,6 +109,7 @@ cbuffer LightPS : register(b3)
     float3 cLightDirPS;
     float4 cNormalOffsetScalePS;
     float4 cShadowCubeAdjust;
+    float2 cShadowCubeScale;
     float4 cShadowDepthFade;
     float2 cShadowIntensity;
     float2 cShadowMapInvSize;
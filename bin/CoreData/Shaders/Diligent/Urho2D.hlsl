@@ -3,18 +3,35 @@
 #include "Transform.hlsl"
 
 void VS(float4 iPos : POSITION,
-    float2 iTexCoord : TEXCOORD0,
-    float4 iColor : COLOR0,
+    #ifndef INSTANCED2D
+        float2 iTexCoord : TEXCOORD0,
+        float4 iColor : COLOR0,
+    #else
+        float3 iInstanceOrigin : TEXCOORD4,
+        float3 iInstanceAxisX : TEXCOORD5,
+        float3 iInstanceAxisY : TEXCOORD6,
+        float4 iInstanceUVRect : TEXCOORD7,
+        float4 iInstanceColor : COLOR1,
+    #endif
     out float4 oColor : COLOR0,
     out float2 oTexCoord : TEXCOORD0,
     out float4 oPos : OUTPOSITION)
 {
-    float4x3 modelMatrix = iModelMatrix;
-    float3 worldPos = GetWorldPos(modelMatrix);
-    oPos = GetClipPos(worldPos);
+    #ifndef INSTANCED2D
+        float4x3 modelMatrix = iModelMatrix;
+        float3 worldPos = GetWorldPos(modelMatrix);
+        oPos = GetClipPos(worldPos);
+
+        oColor = iColor;
+        oTexCoord = iTexCoord;
+    #else
+        // Expand the unit quad corner to the sprite, which is already in world space
+        float3 worldPos = iInstanceOrigin + iPos.x * iInstanceAxisX + iPos.y * iInstanceAxisY;
+        oPos = GetClipPos(worldPos);
 
-    oColor = iColor;
-    oTexCoord = iTexCoord;
+        oColor = iInstanceColor;
+        oTexCoord = lerp(iInstanceUVRect.xy, iInstanceUVRect.zw, iPos.xy);
+    #endif
 }
 
 void PS(float4 iColor : COLOR0,
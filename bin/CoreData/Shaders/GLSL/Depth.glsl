@@ -1,13 +1,18 @@
 #include "Uniforms.glsl"
 #include "Samplers.glsl"
 #include "Transform.glsl"
+#include "GPUTerrain.glsl"
 
 varying vec3 vTexCoord;
 
 void VS()
 {
     mat4 modelMatrix = iModelMatrix;
-    vec3 worldPos = GetWorldPos(modelMatrix);
+    #ifdef GPUTERRAIN
+        vec3 worldPos = GetTerrainWorldPos(GetTerrainTexel(modelMatrix));
+    #else
+        vec3 worldPos = GetWorldPos(modelMatrix);
+    #endif
     gl_Position = GetClipPos(worldPos);
     vTexCoord = vec3(GetTexCoord(iTexCoord), GetDepth(gl_Position));
 }
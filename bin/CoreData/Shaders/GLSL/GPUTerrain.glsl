@@ -0,0 +1,51 @@
+#ifdef COMPILEVS
+#ifdef GPUTERRAIN
+
+// Heightmap of a GPU-rendered terrain. The instance transform maps the shared grid patch to heightmap texels,
+// which are then converted to world space with cGPUTerrainTransform
+
+uniform sampler2D sHeightMap6;
+
+float GetTerrainHeight(vec2 texel)
+{
+    vec2 pos = clamp(texel, vec2(0.0, 0.0), cGPUTerrainSize.xy);
+    return texture2DLod(sHeightMap6, (pos + 0.5) * cGPUTerrainSize.zw, 0.0).r;
+}
+
+vec2 GetTerrainTexel(mat4 modelMatrix)
+{
+    // Vertices of patches which extend past the terrain edge collapse onto the edge
+    return clamp((iPos * modelMatrix).xz, vec2(0.0, 0.0), cGPUTerrainSize.xy);
+}
+
+vec3 GetTerrainWorldPos(vec2 texel)
+{
+    float height = GetTerrainHeight(texel);
+    vec3 worldPos = (vec4(texel.x, height, texel.y, 1.0) * cGPUTerrainTransform).xyz;
+
+    // Geomorph toward the next coarser LOD: vertices not on the coarser grid blend to the average of their two neighbors
+    // along the coarser triangle edge they lie on
+    vec2 odd = mod(texel, 2.0 * cGPUTerrainLod.x);
+    float coarseHeight = 0.5 * (GetTerrainHeight(texel + vec2(-odd.x, odd.y)) + GetTerrainHeight(texel + vec2(odd.x, -odd.y)));
+    float morph = clamp((distance(worldPos, cGPUTerrainCamera) - cGPUTerrainLod.y) * cGPUTerrainLod.z, 0.0, 1.0);
+    return (vec4(texel.x, mix(height, coarseHeight, morph), texel.y, 1.0) * cGPUTerrainTransform).xyz;
+}
+
+vec3 GetTerrainWorldNormal(vec2 texel)
+{
+    float left = GetTerrainHeight(texel - vec2(1.0, 0.0));
+    float right = GetTerrainHeight(texel + vec2(1.0, 0.0));
+    float down = GetTerrainHeight(texel - vec2(0.0, 1.0));
+    float up = GetTerrainHeight(texel + vec2(0.0, 1.0));
+    vec3 tangentX = (vec4(2.0, right - left, 0.0, 0.0) * cGPUTerrainTransform).xyz;
+    vec3 tangentZ = (vec4(0.0, up - down, 2.0, 0.0) * cGPUTerrainTransform).xyz;
+    return normalize(cross(tangentZ, tangentX));
+}
+
+vec2 GetTerrainTexCoord(vec2 texel)
+{
+    return vec2(texel.x / cGPUTerrainSize.x, 1.0 - texel.y / cGPUTerrainSize.y);
+}
+
+#endif
+#endif
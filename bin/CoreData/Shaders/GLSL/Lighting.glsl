@@ -280,7 +280,7 @@ float GetPointShadow(vec3 lightVec)
     // Read the 2D UV coordinates, adjust according to shadow map size and add face offset
     vec4 indirectPos = textureCube(sIndirectionCubeMap, lightVec);
     indirectPos.xy *= cShadowCubeAdjust.xy;
-    indirectPos.xy += vec2(cShadowCubeAdjust.z + indirectPos.z * 0.5, cShadowCubeAdjust.w + indirectPos.w);
+    indirectPos.xy += vec2(cShadowCubeAdjust.z + indirectPos.z * cShadowCubeScale.x, cShadowCubeAdjust.w + indirectPos.w * cShadowCubeScale.y);
 
     vec4 shadowPos = vec4(indirectPos.xy, cShadowDepthFade.x + cShadowDepthFade.y / depth, 1.0);
     return GetShadow(shadowPos);
@@ -1,6 +1,7 @@
 #include "Uniforms.glsl"
 #include "Samplers.glsl"
 #include "Transform.glsl"
+#include "GPUTerrain.glsl"
 
 #ifdef VSM_SHADOW
     varying vec4 vTexCoord;
@@ -11,7 +12,11 @@
 void VS()
 {
     mat4 modelMatrix = iModelMatrix;
-    vec3 worldPos = GetWorldPos(modelMatrix);
+    #ifdef GPUTERRAIN
+        vec3 worldPos = GetTerrainWorldPos(GetTerrainTexel(modelMatrix));
+    #else
+        vec3 worldPos = GetWorldPos(modelMatrix);
+    #endif
     gl_Position = GetClipPos(worldPos);
     #ifdef VSM_SHADOW
         vTexCoord = vec4(GetTexCoord(iTexCoord), gl_Position.z, gl_Position.w);
@@ -1,6 +1,7 @@
 #include "Uniforms.glsl"
 #include "Samplers.glsl"
 #include "Transform.glsl"
+#include "GPUTerrain.glsl"
 #include "ScreenPos.glsl"
 #include "Lighting.glsl"
 #include "Fog.glsl"
@@ -54,11 +55,20 @@ uniform mediump vec2 cDetailTiling;
 void VS()
 {
     mat4 modelMatrix = iModelMatrix;
-    vec3 worldPos = GetWorldPos(modelMatrix);
-    gl_Position = GetClipPos(worldPos);
-    vNormal = GetWorldNormal(modelMatrix);
-    vWorldPos = vec4(worldPos, GetDepth(gl_Position));
-    vTexCoord = GetTexCoord(iTexCoord);
+    #ifdef GPUTERRAIN
+        vec2 texel = GetTerrainTexel(modelMatrix);
+        vec3 worldPos = GetTerrainWorldPos(texel);
+        gl_Position = GetClipPos(worldPos);
+        vNormal = GetTerrainWorldNormal(texel);
+        vWorldPos = vec4(worldPos, GetDepth(gl_Position));
+        vTexCoord = GetTexCoord(GetTerrainTexCoord(texel));
+    #else
+        vec3 worldPos = GetWorldPos(modelMatrix);
+        gl_Position = GetClipPos(worldPos);
+        vNormal = GetWorldNormal(modelMatrix);
+        vWorldPos = vec4(worldPos, GetDepth(gl_Position));
+        vTexCoord = GetTexCoord(iTexCoord);
+    #endif
     vDetailTexCoord = cDetailTiling * vTexCoord;
 
     #ifdef PERPIXEL
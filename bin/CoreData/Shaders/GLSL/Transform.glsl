@@ -148,6 +148,16 @@ vec3 GetTrailNormal(vec4 iPos, vec3 iParentPos, vec3 iForward)
 }
 #endif
 
+#ifdef OCTNORMAL
+vec3 DecodeOctNormal(vec2 enc)
+{
+    vec3 n = vec3(enc, 1.0 - abs(enc.x) - abs(enc.y));
+    float t = clamp(-n.z, 0.0, 1.0);
+    n.xy += (1.0 - 2.0 * step(0.0, n.xy)) * t;
+    return normalize(n);
+}
+#endif
+
 #if defined(SKINNED)
     #define iModelMatrix GetSkinMatrix(iBlendWeights, iBlendIndices)
 #elif defined(INSTANCED)
@@ -181,6 +191,8 @@ vec3 GetWorldNormal(mat4 modelMatrix)
         return GetTrailNormal(iPos);
     #elif defined(TRAILBONE)
         return GetTrailNormal(iPos, iTangent.xyz, iNormal);
+    #elif defined(OCTNORMAL)
+        return normalize(DecodeOctNormal(iNormal.xy) * GetNormalMatrix(modelMatrix));
     #else
         return normalize(iNormal * GetNormalMatrix(modelMatrix));
     #endif
@@ -192,6 +204,8 @@ vec4 GetWorldTangent(mat4 modelMatrix)
         return vec4(normalize(vec3(1.0, 0.0, 0.0) * cBillboardRot), 1.0);
     #elif defined(DIRBILLBOARD)
         return vec4(normalize(vec3(1.0, 0.0, 0.0) * GetNormalMatrix(modelMatrix)), 1.0);
+    #elif defined(OCTNORMAL)
+        return vec4(normalize(DecodeOctNormal(iTangent.xy) * GetNormalMatrix(modelMatrix)), iTangent.w);
     #else
         return vec4(normalize(iTangent.xyz * GetNormalMatrix(modelMatrix)), iTangent.w);
     #endif
@@ -29,6 +29,12 @@ uniform mat4 cViewProj;
 uniform vec4 cUOffset;
 uniform vec4 cVOffset;
 uniform mat4 cZone;
+#ifdef GPUTERRAIN
+    uniform mat4 cGPUTerrainTransform;
+    uniform vec4 cGPUTerrainSize;
+    uniform vec4 cGPUTerrainLod;
+    uniform vec3 cGPUTerrainCamera;
+#endif
 #if !defined(GL_ES) || defined(WEBGL)
     uniform mat4 cLightMatrices[4];
 #else
@@ -79,6 +85,7 @@ uniform vec3 cZoneMax;
 uniform float cNearClipPS;
 uniform float cFarClipPS;
 uniform vec4 cShadowCubeAdjust;
+uniform vec2 cShadowCubeScale;
 uniform vec4 cShadowDepthFade;
 uniform vec2 cShadowIntensity;
 uniform vec2 cShadowMapInvSize;
@@ -139,6 +146,12 @@ uniform MaterialVS
 {
     vec4 cUOffset;
     vec4 cVOffset;
+#ifdef GPUTERRAIN
+    mat4 cGPUTerrainTransform;
+    vec4 cGPUTerrainSize;
+    vec4 cGPUTerrainLod;
+    vec3 cGPUTerrainCamera;
+#endif
 };
 #endif
 
@@ -189,6 +202,7 @@ uniform LightPS
     vec3 cLightDirPS;
     vec4 cNormalOffsetScalePS;
     vec4 cShadowCubeAdjust;
+    vec2 cShadowCubeScale;
     vec4 cShadowDepthFade;
     vec2 cShadowIntensity;
     vec2 cShadowMapInvSize;
@@ -0,0 +1,35 @@
+#include "Uniforms.glsl"
+#include "Samplers.glsl"
+#include "Transform.glsl"
+#include "ScreenPos.glsl"
+
+varying vec2 vScreenPos;
+
+#ifdef COMPILEPS
+uniform float cSharpness;
+#endif
+
+void VS()
+{
+    mat4 modelMatrix = iModelMatrix;
+    vec3 worldPos = GetWorldPos(modelMatrix);
+    gl_Position = GetClipPos(worldPos);
+    vScreenPos = GetScreenPosPreDiv(gl_Position);
+}
+
+// Bilinearly upscale a reduced resolution view and sharpen it against its four neighbour texels. The result is clamped
+// to the range of the neighbourhood so that the sharpening does not produce halos
+void PS()
+{
+    vec4 center = texture2D(sDiffMap, vScreenPos);
+    vec3 north = texture2D(sDiffMap, vScreenPos + vec2(0.0, -cGBufferInvSize.y)).rgb;
+    vec3 south = texture2D(sDiffMap, vScreenPos + vec2(0.0, cGBufferInvSize.y)).rgb;
+    vec3 west = texture2D(sDiffMap, vScreenPos + vec2(-cGBufferInvSize.x, 0.0)).rgb;
+    vec3 east = texture2D(sDiffMap, vScreenPos + vec2(cGBufferInvSize.x, 0.0)).rgb;
+
+    vec3 minRgb = min(center.rgb, min(min(north, south), min(west, east)));
+    vec3 maxRgb = max(center.rgb, max(max(north, south), max(west, east)));
+    vec3 sharpened = center.rgb + (4.0 * center.rgb - north - south - west - east) * (0.25 * cSharpness);
+
+    gl_FragColor = vec4(clamp(sharpened, minRgb, maxRgb), center.a);
+}
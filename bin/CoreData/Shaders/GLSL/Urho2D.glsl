@@ -5,14 +5,31 @@
 varying vec2 vTexCoord;
 varying vec4 vColor;
 
+#if defined(COMPILEVS) && defined(INSTANCED2D)
+    attribute vec3 iTexCoord4;
+    attribute vec3 iTexCoord5;
+    attribute vec3 iTexCoord6;
+    attribute vec4 iTexCoord7;
+    attribute vec4 iColor1;
+#endif
+
 void VS()
 {
-    mat4 modelMatrix = iModelMatrix;
-    vec3 worldPos = GetWorldPos(modelMatrix);
-    gl_Position = GetClipPos(worldPos);
-    
-    vTexCoord = iTexCoord;
-    vColor = iColor;
+    #ifndef INSTANCED2D
+        mat4 modelMatrix = iModelMatrix;
+        vec3 worldPos = GetWorldPos(modelMatrix);
+        gl_Position = GetClipPos(worldPos);
+
+        vTexCoord = iTexCoord;
+        vColor = iColor;
+    #else
+        // Expand the unit quad corner to the sprite, which is already in world space
+        vec3 worldPos = iTexCoord4 + iPos.x * iTexCoord5 + iPos.y * iTexCoord6;
+        gl_Position = GetClipPos(worldPos);
+
+        vTexCoord = mix(iTexCoord7.xy, iTexCoord7.zw, iPos.xy);
+        vColor = iColor1;
+    #endif
 }
 
 void PS()
@@ -1,6 +1,7 @@
 #include "Uniforms.hlsl"
 #include "Samplers.hlsl"
 #include "Transform.hlsl"
+#include "GPUTerrain.hlsl"
 
 void VS(float4 iPos : POSITION,
     #ifdef SKINNED
@@ -22,7 +23,11 @@ void VS(float4 iPos : POSITION,
     #endif
     
     float4x3 modelMatrix = iModelMatrix;
-    float3 worldPos = GetWorldPos(modelMatrix);
+    #ifdef GPUTERRAIN
+        float3 worldPos = GetTerrainWorldPos(GetTerrainTexel(iPos, modelMatrix));
+    #else
+        float3 worldPos = GetWorldPos(modelMatrix);
+    #endif
     oPos = GetClipPos(worldPos);
     oTexCoord = float3(GetTexCoord(iTexCoord), GetDepth(oPos));
 }
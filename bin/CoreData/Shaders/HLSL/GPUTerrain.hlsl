@@ -0,0 +1,58 @@
+#ifdef COMPILEVS
+#ifdef GPUTERRAIN
+
+// Heightmap of a GPU-rendered terrain. The instance transform maps the shared grid patch to heightmap texels,
+// which are then converted to world space with cGPUTerrainTransform
+
+#ifdef D3D11
+Texture2D tHeightMap6 : register(t6);
+SamplerState sHeightMap6 : register(s6);
+#define SampleTerrainHeight(uv) Sample2DLod0(HeightMap6, uv).r
+#else
+sampler2D sHeightMap6 : register(s6);
+#define SampleTerrainHeight(uv) tex2Dlod(sHeightMap6, float4(uv, 0.0, 0.0)).r
+#endif
+
+float GetTerrainHeight(float2 texel)
+{
+    float2 pos = clamp(texel, float2(0.0, 0.0), cGPUTerrainSize.xy);
+    return SampleTerrainHeight((pos + 0.5) * cGPUTerrainSize.zw);
+}
+
+float2 GetTerrainTexel(float4 iPos, float4x3 modelMatrix)
+{
+    // Vertices of patches which extend past the terrain edge collapse onto the edge
+    return clamp(mul(iPos, modelMatrix).xz, float2(0.0, 0.0), cGPUTerrainSize.xy);
+}
+
+float3 GetTerrainWorldPos(float2 texel)
+{
+    float height = GetTerrainHeight(texel);
+    float3 worldPos = mul(float4(texel.x, height, texel.y, 1.0), cGPUTerrainTransform);
+
+    // Geomorph toward the next coarser LOD: vertices not on the coarser grid blend to the average of their two neighbors
+    // along the coarser triangle edge they lie on
+    float2 odd = fmod(texel, 2.0 * cGPUTerrainLod.x);
+    float coarseHeight = 0.5 * (GetTerrainHeight(texel + float2(-odd.x, odd.y)) + GetTerrainHeight(texel + float2(odd.x, -odd.y)));
+    float morph = saturate((distance(worldPos, cGPUTerrainCamera) - cGPUTerrainLod.y) * cGPUTerrainLod.z);
+    return mul(float4(texel.x, lerp(height, coarseHeight, morph), texel.y, 1.0), cGPUTerrainTransform);
+}
+
+float3 GetTerrainWorldNormal(float2 texel)
+{
+    float left = GetTerrainHeight(texel - float2(1.0, 0.0));
+    float right = GetTerrainHeight(texel + float2(1.0, 0.0));
+    float down = GetTerrainHeight(texel - float2(0.0, 1.0));
+    float up = GetTerrainHeight(texel + float2(0.0, 1.0));
+    float3 tangentX = mul(float4(2.0, right - left, 0.0, 0.0), cGPUTerrainTransform);
+    float3 tangentZ = mul(float4(0.0, up - down, 2.0, 0.0), cGPUTerrainTransform);
+    return normalize(cross(tangentZ, tangentX));
+}
+
+float2 GetTerrainTexCoord(float2 texel)
+{
+    return float2(texel.x / cGPUTerrainSize.x, 1.0 - texel.y / cGPUTerrainSize.y);
+}
+
+#endif
+#endif
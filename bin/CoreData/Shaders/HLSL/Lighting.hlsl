@@ -290,7 +290,7 @@ float GetPointShadow(float3 lightVec)
     // Read the 2D UV coordinates, adjust according to shadow map size and add face offset
     float4 indirectPos = SampleCube(IndirectionCubeMap, lightVec);
     indirectPos.xy *= cShadowCubeAdjust.xy;
-    indirectPos.xy += float2(cShadowCubeAdjust.z + indirectPos.z * 0.5, cShadowCubeAdjust.w + indirectPos.w);
+    indirectPos.xy += float2(cShadowCubeAdjust.z + indirectPos.z * cShadowCubeScale.x, cShadowCubeAdjust.w + indirectPos.w * cShadowCubeScale.y);
 
     float4 shadowPos = float4(indirectPos.xy, cShadowDepthFade.x + cShadowDepthFade.y / depth, 1.0);
     return GetShadow(shadowPos);
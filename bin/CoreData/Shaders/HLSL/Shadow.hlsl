@@ -1,6 +1,7 @@
 #include "Uniforms.hlsl"
 #include "Samplers.hlsl"
 #include "Transform.hlsl"
+#include "GPUTerrain.hlsl"
 
 void VS(float4 iPos : POSITION,
     #ifndef NOUV
@@ -29,7 +30,11 @@ void VS(float4 iPos : POSITION,
     #endif
 
     float4x3 modelMatrix = iModelMatrix;
-    float3 worldPos = GetWorldPos(modelMatrix);
+    #ifdef GPUTERRAIN
+        float3 worldPos = GetTerrainWorldPos(GetTerrainTexel(iPos, modelMatrix));
+    #else
+        float3 worldPos = GetWorldPos(modelMatrix);
+    #endif
     oPos = GetClipPos(worldPos);
     #ifdef VSM_SHADOW
         oTexCoord = float4(GetTexCoord(iTexCoord), oPos.z, oPos.w);
@@ -1,6 +1,7 @@
 #include "Uniforms.hlsl"
 #include "Samplers.hlsl"
 #include "Transform.hlsl"
+#include "GPUTerrain.hlsl"
 #include "ScreenPos.hlsl"
 #include "Lighting.hlsl"
 #include "Fog.hlsl"
@@ -39,8 +40,10 @@ SamplerState sDetailMap3 : register(s3);
 #endif
 
 void VS(float4 iPos : POSITION,
-    float3 iNormal : NORMAL,
-    float2 iTexCoord : TEXCOORD0,
+    #ifndef GPUTERRAIN
+        float3 iNormal : NORMAL,
+        float2 iTexCoord : TEXCOORD0,
+    #endif
     #ifdef SKINNED
         float4 iBlendWeights : BLENDWEIGHT,
         int4 iBlendIndices : BLENDINDICES,
@@ -78,11 +81,20 @@ void VS(float4 iPos : POSITION,
     out float4 oPos : OUTPOSITION)
 {
     float4x3 modelMatrix = iModelMatrix;
-    float3 worldPos = GetWorldPos(modelMatrix);
-    oPos = GetClipPos(worldPos);
-    oNormal = GetWorldNormal(modelMatrix);
-    oWorldPos = float4(worldPos, GetDepth(oPos));
-    oTexCoord = GetTexCoord(iTexCoord);
+    #ifdef GPUTERRAIN
+        float2 texel = GetTerrainTexel(iPos, modelMatrix);
+        float3 worldPos = GetTerrainWorldPos(texel);
+        oPos = GetClipPos(worldPos);
+        oNormal = GetTerrainWorldNormal(texel);
+        oWorldPos = float4(worldPos, GetDepth(oPos));
+        oTexCoord = GetTexCoord(GetTerrainTexCoord(texel));
+    #else
+        float3 worldPos = GetWorldPos(modelMatrix);
+        oPos = GetClipPos(worldPos);
+        oNormal = GetWorldNormal(modelMatrix);
+        oWorldPos = float4(worldPos, GetDepth(oPos));
+        oTexCoord = GetTexCoord(iTexCoord);
+    #endif
     oDetailTexCoord = cDetailTiling * oTexCoord;
 
     #if defined(D3D11) && defined(CLIPPLANE)
@@ -105,6 +105,16 @@ float3 GetTrailNormal(float4 iPos, float3 iParentPos, float3 iForward)
 }
 #endif
 
+#ifdef OCTNORMAL
+float3 DecodeOctNormal(float2 enc)
+{
+    float3 n = float3(enc, 1.0 - abs(enc.x) - abs(enc.y));
+    float t = saturate(-n.z);
+    n.xy += (1.0 - 2.0 * step(0.0, n.xy)) * t;
+    return normalize(n);
+}
+#endif
+
 #if defined(SKINNED)
     #define iModelMatrix GetSkinMatrix(iBlendWeights, iBlendIndices)
 #elif defined(INSTANCED)
@@ -133,6 +143,8 @@ float3 GetTrailNormal(float4 iPos, float3 iParentPos, float3 iForward)
     #define GetWorldNormal(modelMatrix) GetTrailNormal(iPos)
 #elif defined(TRAILBONE)
     #define GetWorldNormal(modelMatrix) GetTrailNormal(iPos, iTangent.xyz, iNormal)
+#elif defined(OCTNORMAL)
+    #define GetWorldNormal(modelMatrix) normalize(mul(DecodeOctNormal(iNormal.xy), (float3x3)modelMatrix))
 #else
     #define GetWorldNormal(modelMatrix) normalize(mul(iNormal, (float3x3)modelMatrix))
 #endif
@@ -141,6 +153,8 @@ float3 GetTrailNormal(float4 iPos, float3 iParentPos, float3 iForward)
     #define GetWorldTangent(modelMatrix) float4(normalize(mul(float3(1.0, 0.0, 0.0), cBillboardRot)), 1.0)
 #elif defined(DIRBILLBOARD)
     #define GetWorldTangent(modelMatrix) float4(normalize(mul(float3(1.0, 0.0, 0.0), (float3x3)modelMatrix)), 1.0)
+#elif defined(OCTNORMAL)
+    #define GetWorldTangent(modelMatrix) float4(normalize(mul(DecodeOctNormal(iTangent.xy), (float3x3)modelMatrix)), iTangent.w)
 #else
     #define GetWorldTangent(modelMatrix) float4(normalize(mul(iTangent.xyz, (float3x3)modelMatrix)), iTangent.w)
 #endif
@@ -28,6 +28,12 @@ uniform float4x4 cViewProj;
 uniform float4 cUOffset;
 uniform float4 cVOffset;
 uniform float4x3 cZone;
+#ifdef GPUTERRAIN
+    uniform float4x3 cGPUTerrainTransform;
+    uniform float4 cGPUTerrainSize;
+    uniform float4 cGPUTerrainLod;
+    uniform float3 cGPUTerrainCamera;
+#endif
 #ifdef SKINNED
     uniform float4x3 cSkinMatrices[MAXBONES];
 #endif
@@ -68,6 +74,7 @@ uniform float3 cZoneMax;
 uniform float cNearClipPS;
 uniform float cFarClipPS;
 uniform float4 cShadowCubeAdjust;
+uniform float2 cShadowCubeScale;
 uniform float4 cShadowDepthFade;
 uniform float2 cShadowIntensity;
 uniform float2 cShadowMapInvSize;
@@ -129,6 +136,12 @@ cbuffer MaterialVS : register(b4)
 {
     float4 cUOffset;
     float4 cVOffset;
+#ifdef GPUTERRAIN
+    float4x3 cGPUTerrainTransform;
+    float4 cGPUTerrainSize;
+    float4 cGPUTerrainLod;
+    float3 cGPUTerrainCamera;
+#endif
 }
 #endif
 
@@ -178,6 +191,7 @@ cbuffer LightPS : register(b3)
     float3 cLightDirPS;
     float4 cNormalOffsetScalePS;
     float4 cShadowCubeAdjust;
+    float2 cShadowCubeScale;
     float4 cShadowDepthFade;
     float2 cShadowIntensity;
     float2 cShadowMapInvSize;
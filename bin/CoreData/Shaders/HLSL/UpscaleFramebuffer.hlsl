@@ -0,0 +1,49 @@
+#include "Uniforms.hlsl"
+#include "Samplers.hlsl"
+#include "Transform.hlsl"
+#include "ScreenPos.hlsl"
+
+#if !defined(D3D11) && !defined(DILIGENT)
+
+// D3D9 uniforms
+uniform float cSharpness;
+
+#else
+
+// D3D11 constant buffers
+#ifdef COMPILEPS
+cbuffer CustomPS : register(b6)
+{
+    float cSharpness;
+}
+#endif
+
+#endif
+
+void VS(float4 iPos : POSITION,
+    out float2 oScreenPos : TEXCOORD0,
+    out float4 oPos : OUTPOSITION)
+{
+    float4x3 modelMatrix = iModelMatrix;
+    float3 worldPos = GetWorldPos(modelMatrix);
+    oPos = GetClipPos(worldPos);
+    oScreenPos = GetScreenPosPreDiv(oPos);
+}
+
+// Bilinearly upscale a reduced resolution view and sharpen it against its four neighbour texels. The result is clamped
+// to the range of the neighbourhood so that the sharpening does not produce halos
+void PS(float2 iScreenPos : TEXCOORD0,
+    out float4 oColor : OUTCOLOR0)
+{
+    float4 center = Sample2DLod0(DiffMap, iScreenPos);
+    float3 north = Sample2DLod0(DiffMap, iScreenPos + float2(0.0, -cGBufferInvSize.y)).rgb;
+    float3 south = Sample2DLod0(DiffMap, iScreenPos + float2(0.0, cGBufferInvSize.y)).rgb;
+    float3 west = Sample2DLod0(DiffMap, iScreenPos + float2(-cGBufferInvSize.x, 0.0)).rgb;
+    float3 east = Sample2DLod0(DiffMap, iScreenPos + float2(cGBufferInvSize.x, 0.0)).rgb;
+
+    float3 minRgb = min(center.rgb, min(min(north, south), min(west, east)));
+    float3 maxRgb = max(center.rgb, max(max(north, south), max(west, east)));
+    float3 sharpened = center.rgb + (4.0 * center.rgb - north - south - west - east) * (0.25 * cSharpness);
+
+    oColor = float4(clamp(sharpened, minRgb, maxRgb), center.a);
+}
@@ -0,0 +1,451 @@
+-- LuaJIT FFI binding layer for math types and the most used Node / Component accessors
+-- Usage: local urho = require "LuaScripts/Utilities/FFI"
+--
+-- The math types are plain FFI structs with the same memory layout as the C++ classes, and their operators are implemented
+-- in Lua so that the LuaJIT tracer can compile them. Scene objects obtained from the tolua++ API can be converted with
+-- urho.Node() and urho.Component(); the returned FFI pointers do not hold a reference, so like raw pointers in C++ they must
+-- not be used after the object has been destroyed. Values can be converted back to the tolua++ API with ToTolua().
+
+local ffi = require "ffi"
+local api = package.loaded["Urho3D.ffi.api"]
+if not api then
+    error("The FFI binding layer requires a LuaJIT build")
+end
+
+local sqrt, sin, cos, acos, abs = math.sqrt, math.sin, math.cos, math.acos, math.abs
+local format = string.format
+local M_EPSILON = 0.000001
+local M_DEGTORAD_2 = math.pi / 360
+
+ffi.cdef[[
+typedef struct { float x, y; } Urho3DVector2;
+typedef struct { float x, y, z; } Urho3DVector3;
+typedef struct { float x, y, z, w; } Urho3DVector4;
+typedef struct { float w, x, y, z; } Urho3DQuaternion;
+typedef struct { float r, g, b, a; } Urho3DColor;
+typedef struct Urho3DNode Urho3DNode;
+typedef struct Urho3DComponent Urho3DComponent;
+]]
+
+local Vector2, Vector3, Vector4, QuaternionType, ColorType
+local istype = ffi.istype
+
+local function Quaternion(w, x, y, z)
+    if w == nil then
+        return QuaternionType(1, 0, 0, 0)
+    end
+    return QuaternionType(w, x, y, z)
+end
+
+local function Color(r, g, b, a)
+    if r == nil then
+        return ColorType(1, 1, 1, 1)
+    end
+    return ColorType(r, g, b, a or 1)
+end
+
+-- Vector2
+
+local Vector2Methods = {}
+local Vector2Meta = { __index = Vector2Methods }
+
+function Vector2Meta.__add(a, b) return Vector2(a.x + b.x, a.y + b.y) end
+function Vector2Meta.__sub(a, b) return Vector2(a.x - b.x, a.y - b.y) end
+function Vector2Meta.__unm(a) return Vector2(-a.x, -a.y) end
+
+function Vector2Meta.__mul(a, b)
+    if type(a) == "number" then return Vector2(a * b.x, a * b.y) end
+    if type(b) == "number" then return Vector2(a.x * b, a.y * b) end
+    return Vector2(a.x * b.x, a.y * b.y)
+end
+
+function Vector2Meta.__div(a, b)
+    if type(b) == "number" then return Vector2(a.x / b, a.y / b) end
+    return Vector2(a.x / b.x, a.y / b.y)
+end
+
+function Vector2Meta.__eq(a, b)
+    return istype(Vector2, a) and istype(Vector2, b) and a.x == b.x and a.y == b.y
+end
+
+function Vector2Meta.__tostring(a) return format("%g %g", a.x, a.y) end
+
+function Vector2Methods:Length() return sqrt(self.x * self.x + self.y * self.y) end
+function Vector2Methods:LengthSquared() return self.x * self.x + self.y * self.y end
+function Vector2Methods:DotProduct(rhs) return self.x * rhs.x + self.y * rhs.y end
+function Vector2Methods:Lerp(rhs, t) return self * (1 - t) + rhs * t end
+
+function Vector2Methods:Normalized()
+    local lenSquared = self.x * self.x + self.y * self.y
+    if abs(lenSquared - 1) > M_EPSILON and lenSquared > 0 then
+        local invLen = 1 / sqrt(lenSquared)
+        return Vector2(self.x * invLen, self.y * invLen)
+    end
+    return Vector2(self.x, self.y)
+end
+
+function Vector2Methods:Equals(rhs)
+    return abs(self.x - rhs.x) < M_EPSILON and abs(self.y - rhs.y) < M_EPSILON
+end
+
+function Vector2Methods:ToTolua() return _G.Vector2(self.x, self.y) end
+
+-- Vector3
+
+local Vector3Methods = {}
+local Vector3Meta = { __index = Vector3Methods }
+
+function Vector3Meta.__add(a, b) return Vector3(a.x + b.x, a.y + b.y, a.z + b.z) end
+function Vector3Meta.__sub(a, b) return Vector3(a.x - b.x, a.y - b.y, a.z - b.z) end
+function Vector3Meta.__unm(a) return Vector3(-a.x, -a.y, -a.z) end
+
+function Vector3Meta.__mul(a, b)
+    if type(a) == "number" then return Vector3(a * b.x, a * b.y, a * b.z) end
+    if type(b) == "number" then return Vector3(a.x * b, a.y * b, a.z * b) end
+    return Vector3(a.x * b.x, a.y * b.y, a.z * b.z)
+end
+
+function Vector3Meta.__div(a, b)
+    if type(b) == "number" then return Vector3(a.x / b, a.y / b, a.z / b) end
+    return Vector3(a.x / b.x, a.y / b.y, a.z / b.z)
+end
+
+function Vector3Meta.__eq(a, b)
+    return istype(Vector3, a) and istype(Vector3, b) and a.x == b.x and a.y == b.y and a.z == b.z
+end
+
+function Vector3Meta.__tostring(a) return format("%g %g %g", a.x, a.y, a.z) end
+
+function Vector3Methods:Length() return sqrt(self.x * self.x + self.y * self.y + self.z * self.z) end
+function Vector3Methods:LengthSquared() return self.x * self.x + self.y * self.y + self.z * self.z end
+function Vector3Methods:DotProduct(rhs) return self.x * rhs.x + self.y * rhs.y + self.z * rhs.z end
+function Vector3Methods:Lerp(rhs, t) return self * (1 - t) + rhs * t end
+
+function Vector3Methods:CrossProduct(rhs)
+    return Vector3(self.y * rhs.z - self.z * rhs.y, self.z * rhs.x - self.x * rhs.z, self.x * rhs.y - self.y * rhs.x)
+end
+
+function Vector3Methods:Normalized()
+    local lenSquared = self.x * self.x + self.y * self.y + self.z * self.z
+    if abs(lenSquared - 1) > M_EPSILON and lenSquared > 0 then
+        local invLen = 1 / sqrt(lenSquared)
+        return Vector3(self.x * invLen, self.y * invLen, self.z * invLen)
+    end
+    return Vector3(self.x, self.y, self.z)
+end
+
+function Vector3Methods:Normalize()
+    local lenSquared = self.x * self.x + self.y * self.y + self.z * self.z
+    if abs(lenSquared - 1) > M_EPSILON and lenSquared > 0 then
+        local invLen = 1 / sqrt(lenSquared)
+        self.x, self.y, self.z = self.x * invLen, self.y * invLen, self.z * invLen
+    end
+end
+
+function Vector3Methods:Equals(rhs)
+    return abs(self.x - rhs.x) < M_EPSILON and abs(self.y - rhs.y) < M_EPSILON and abs(self.z - rhs.z) < M_EPSILON
+end
+
+function Vector3Methods:ToTolua() return _G.Vector3(self.x, self.y, self.z) end
+
+-- Vector4
+
+local Vector4Methods = {}
+local Vector4Meta = { __index = Vector4Methods }
+
+function Vector4Meta.__add(a, b) return Vector4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w) end
+function Vector4Meta.__sub(a, b) return Vector4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w) end
+function Vector4Meta.__unm(a) return Vector4(-a.x, -a.y, -a.z, -a.w) end
+
+function Vector4Meta.__mul(a, b)
+    if type(a) == "number" then return Vector4(a * b.x, a * b.y, a * b.z, a * b.w) end
+    if type(b) == "number" then return Vector4(a.x * b, a.y * b, a.z * b, a.w * b) end
+    return Vector4(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w)
+end
+
+function Vector4Meta.__div(a, b)
+    if type(b) == "number" then return Vector4(a.x / b, a.y / b, a.z / b, a.w / b) end
+    return Vector4(a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w)
+end
+
+function Vector4Meta.__eq(a, b)
+    return istype(Vector4, a) and istype(Vector4, b) and a.x == b.x and a.y == b.y and a.z == b.z and a.w == b.w
+end
+
+function Vector4Meta.__tostring(a) return format("%g %g %g %g", a.x, a.y, a.z, a.w) end
+
+function Vector4Methods:DotProduct(rhs) return self.x * rhs.x + self.y * rhs.y + self.z * rhs.z + self.w * rhs.w end
+function Vector4Methods:Lerp(rhs, t) return self * (1 - t) + rhs * t end
+function Vector4Methods:ToTolua() return _G.Vector4(self.x, self.y, self.z, self.w) end
+
+-- Quaternion
+
+local QuaternionMethods = {}
+local QuaternionMeta = { __index = QuaternionMethods }
+
+function QuaternionMeta.__add(a, b) return QuaternionType(a.w + b.w, a.x + b.x, a.y + b.y, a.z + b.z) end
+function QuaternionMeta.__sub(a, b) return QuaternionType(a.w - b.w, a.x - b.x, a.y - b.y, a.z - b.z) end
+function QuaternionMeta.__unm(a) return QuaternionType(-a.w, -a.x, -a.y, -a.z) end
+
+function QuaternionMeta.__mul(a, b)
+    if type(a) == "number" then
+        return QuaternionType(a * b.w, a * b.x, a * b.y, a * b.z)
+    elseif type(b) == "number" then
+        return QuaternionType(a.w * b, a.x * b, a.y * b, a.z * b)
+    elseif istype(Vector3, b) then
+        -- Rotate the vector: v + 2 * (w * (q x v) + q x (q x v))
+        local c1x, c1y, c1z = a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x
+        local c2x, c2y, c2z = a.y * c1z - a.z * c1y, a.z * c1x - a.x * c1z, a.x * c1y - a.y * c1x
+        return Vector3(b.x + 2 * (c1x * a.w + c2x), b.y + 2 * (c1y * a.w + c2y), b.z + 2 * (c1z * a.w + c2z))
+    end
+    return QuaternionType(
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
+        a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x)
+end
+
+function QuaternionMeta.__eq(a, b)
+    return istype(QuaternionType, a) and istype(QuaternionType, b) and a.w == b.w and a.x == b.x and a.y == b.y and a.z == b.z
+end
+
+function QuaternionMeta.__tostring(a) return format("%g %g %g %g", a.w, a.x, a.y, a.z) end
+
+function QuaternionMethods:LengthSquared() return self.w * self.w + self.x * self.x + self.y * self.y + self.z * self.z end
+function QuaternionMethods:DotProduct(rhs) return self.w * rhs.w + self.x * rhs.x + self.y * rhs.y + self.z * rhs.z end
+function QuaternionMethods:Conjugate() return QuaternionType(self.w, -self.x, -self.y, -self.z) end
+
+function QuaternionMethods:Inverse()
+    local lenSquared = self:LengthSquared()
+    if lenSquared == 1 then
+        return self:Conjugate()
+    elseif lenSquared >= M_EPSILON then
+        local invLenSquared = 1 / lenSquared
+        return QuaternionType(self.w * invLenSquared, -self.x * invLenSquared, -self.y * invLenSquared, -self.z * invLenSquared)
+    end
+    return QuaternionType(1, 0, 0, 0)
+end
+
+function QuaternionMethods:Normalized()
+    local lenSquared = self:LengthSquared()
+    if abs(lenSquared - 1) > M_EPSILON and lenSquared > 0 then
+        local invLen = 1 / sqrt(lenSquared)
+        return QuaternionType(self.w * invLen, self.x * invLen, self.y * invLen, self.z * invLen)
+    end
+    return QuaternionType(self.w, self.x, self.y, self.z)
+end
+
+function QuaternionMethods:Slerp(rhs, t)
+    local cosAngle = self:DotProduct(rhs)
+    local sign = 1
+    -- Enable shortest path rotation
+    if cosAngle < 0 then
+        cosAngle = -cosAngle
+        sign = -1
+    end
+
+    local angle = acos(math.min(cosAngle, 1))
+    local sinAngle = sin(angle)
+    local t1, t2
+    if sinAngle > 0.001 then
+        local invSinAngle = 1 / sinAngle
+        t1 = sin((1 - t) * angle) * invSinAngle
+        t2 = sin(t * angle) * invSinAngle
+    else
+        t1 = 1 - t
+        t2 = t
+    end
+    return self * t1 + rhs * (sign * t2)
+end
+
+function QuaternionMethods:Nlerp(rhs, t, shortestPath)
+    local fact = 1 - t
+    if shortestPath and self:DotProduct(rhs) < 0 then
+        t = -t
+    end
+    return (self * fact + rhs * t):Normalized()
+end
+
+function QuaternionMethods:Equals(rhs)
+    return abs(self.w - rhs.w) < M_EPSILON and abs(self.x - rhs.x) < M_EPSILON and abs(self.y - rhs.y) < M_EPSILON and
+        abs(self.z - rhs.z) < M_EPSILON
+end
+
+function QuaternionMethods:ToTolua() return _G.Quaternion(self.w, self.x, self.y, self.z) end
+
+-- Color
+
+local ColorMethods = {}
+local ColorMeta = { __index = ColorMethods }
+
+function ColorMeta.__add(a, b) return ColorType(a.r + b.r, a.g + b.g, a.b + b.b, a.a + b.a) end
+function ColorMeta.__sub(a, b) return ColorType(a.r - b.r, a.g - b.g, a.b - b.b, a.a - b.a) end
+
+function ColorMeta.__mul(a, b)
+    if type(a) == "number" then return ColorType(a * b.r, a * b.g, a * b.b, a * b.a) end
+    return ColorType(a.r * b, a.g * b, a.b * b, a.a * b)
+end
+
+function ColorMeta.__eq(a, b)
+    return istype(ColorType, a) and istype(ColorType, b) and a.r == b.r and a.g == b.g and a.b == b.b and a.a == b.a
+end
+
+function ColorMeta.__tostring(a) return format("%g %g %g %g", a.r, a.g, a.b, a.a) end
+
+function ColorMethods:Lerp(rhs, t) return self * (1 - t) + rhs * t end
+function ColorMethods:ToTolua() return _G.Color(self.r, self.g, self.b, self.a) end
+
+Vector2 = ffi.metatype("Urho3DVector2", Vector2Meta)
+Vector3 = ffi.metatype("Urho3DVector3", Vector3Meta)
+Vector4 = ffi.metatype("Urho3DVector4", Vector4Meta)
+QuaternionType = ffi.metatype("Urho3DQuaternion", QuaternionMeta)
+ColorType = ffi.metatype("Urho3DColor", ColorMeta)
+
+-- Cast the C function pointers registered by the engine to their FFI signatures
+local C = {}
+local signatures =
+{
+    NodeGetID = "unsigned (*)(const Urho3DNode*)",
+    NodeIsEnabled = "bool (*)(const Urho3DNode*)",
+    NodeSetEnabled = "void (*)(Urho3DNode*, bool)",
+    NodeGetParent = "Urho3DNode* (*)(const Urho3DNode*)",
+    NodeGetPosition = "void (*)(const Urho3DNode*, Urho3DVector3*)",
+    NodeSetPosition = "void (*)(Urho3DNode*, const Urho3DVector3*)",
+    NodeGetRotation = "void (*)(const Urho3DNode*, Urho3DQuaternion*)",
+    NodeSetRotation = "void (*)(Urho3DNode*, const Urho3DQuaternion*)",
+    NodeGetScale = "void (*)(const Urho3DNode*, Urho3DVector3*)",
+    NodeSetScale = "void (*)(Urho3DNode*, const Urho3DVector3*)",
+    NodeGetDirection = "void (*)(const Urho3DNode*, Urho3DVector3*)",
+    NodeSetTransform = "void (*)(Urho3DNode*, const Urho3DVector3*, const Urho3DQuaternion*)",
+    NodeGetWorldPosition = "void (*)(const Urho3DNode*, Urho3DVector3*)",
+    NodeSetWorldPosition = "void (*)(Urho3DNode*, const Urho3DVector3*)",
+    NodeGetWorldRotation = "void (*)(const Urho3DNode*, Urho3DQuaternion*)",
+    NodeSetWorldRotation = "void (*)(Urho3DNode*, const Urho3DQuaternion*)",
+    NodeGetWorldScale = "void (*)(const Urho3DNode*, Urho3DVector3*)",
+    NodeSetWorldScale = "void (*)(Urho3DNode*, const Urho3DVector3*)",
+    NodeGetWorldDirection = "void (*)(const Urho3DNode*, Urho3DVector3*)",
+    NodeTranslate = "void (*)(Urho3DNode*, const Urho3DVector3*, int)",
+    NodeRotate = "void (*)(Urho3DNode*, const Urho3DQuaternion*, int)",
+    NodeLookAt = "bool (*)(Urho3DNode*, const Urho3DVector3*, const Urho3DVector3*, int)",
+    ComponentGetID = "unsigned (*)(const Urho3DComponent*)",
+    ComponentIsEnabled = "bool (*)(const Urho3DComponent*)",
+    ComponentIsEnabledEffective = "bool (*)(const Urho3DComponent*)",
+    ComponentSetEnabled = "void (*)(Urho3DComponent*, bool)",
+    ComponentGetNode = "Urho3DNode* (*)(const Urho3DComponent*)",
+}
+for name, signature in pairs(signatures) do
+    C[name] = ffi.cast(signature, api[name])
+end
+
+local UP = Vector3(0, 1, 0)
+
+-- Node
+
+local NodeMethods = {}
+
+function NodeMethods:GetID() return C.NodeGetID(self) end
+function NodeMethods:IsEnabled() return C.NodeIsEnabled(self) end
+function NodeMethods:SetEnabled(enable) C.NodeSetEnabled(self, enable) end
+
+function NodeMethods:GetParent()
+    local parent = C.NodeGetParent(self)
+    if parent ~= nil then return parent end
+    return nil
+end
+
+function NodeMethods:GetPosition() local v = Vector3(); C.NodeGetPosition(self, v); return v end
+function NodeMethods:SetPosition(position) C.NodeSetPosition(self, position) end
+function NodeMethods:GetRotation() local q = QuaternionType(); C.NodeGetRotation(self, q); return q end
+function NodeMethods:SetRotation(rotation) C.NodeSetRotation(self, rotation) end
+function NodeMethods:GetScale() local v = Vector3(); C.NodeGetScale(self, v); return v end
+function NodeMethods:SetScale(scale) C.NodeSetScale(self, scale) end
+function NodeMethods:GetDirection() local v = Vector3(); C.NodeGetDirection(self, v); return v end
+function NodeMethods:SetTransform(position, rotation) C.NodeSetTransform(self, position, rotation) end
+function NodeMethods:GetWorldPosition() local v = Vector3(); C.NodeGetWorldPosition(self, v); return v end
+function NodeMethods:SetWorldPosition(position) C.NodeSetWorldPosition(self, position) end
+function NodeMethods:GetWorldRotation() local q = QuaternionType(); C.NodeGetWorldRotation(self, q); return q end
+function NodeMethods:SetWorldRotation(rotation) C.NodeSetWorldRotation(self, rotation) end
+function NodeMethods:GetWorldScale() local v = Vector3(); C.NodeGetWorldScale(self, v); return v end
+function NodeMethods:SetWorldScale(scale) C.NodeSetWorldScale(self, scale) end
+function NodeMethods:GetWorldDirection() local v = Vector3(); C.NodeGetWorldDirection(self, v); return v end
+function NodeMethods:Translate(delta, space) C.NodeTranslate(self, delta, space or TS_LOCAL) end
+function NodeMethods:Rotate(delta, space) C.NodeRotate(self, delta, space or TS_LOCAL) end
+function NodeMethods:LookAt(target, up, space) return C.NodeLookAt(self, target, up or UP, space or TS_WORLD) end
+
+ffi.metatype("Urho3DNode", { __index = NodeMethods })
+
+-- Component
+
+local ComponentMethods = {}
+
+function ComponentMethods:GetID() return C.ComponentGetID(self) end
+function ComponentMethods:IsEnabled() return C.ComponentIsEnabled(self) end
+function ComponentMethods:IsEnabledEffective() return C.ComponentIsEnabledEffective(self) end
+function ComponentMethods:SetEnabled(enable) C.ComponentSetEnabled(self, enable) end
+
+function ComponentMethods:GetNode()
+    local node = C.ComponentGetNode(self)
+    if node ~= nil then return node end
+    return nil
+end
+
+ffi.metatype("Urho3DComponent", { __index = ComponentMethods })
+
+-- tolua++ userdata hold a pointer to the C++ object as their payload
+local function Payload(userdata, pointerType)
+    if userdata == nil then return nil end
+    return ffi.cast(pointerType, userdata)[0]
+end
+
+local fromTolua =
+{
+    Vector2 = function(v) return Vector2(v.x, v.y) end,
+    Vector3 = function(v) return Vector3(v.x, v.y, v.z) end,
+    Vector4 = function(v) return Vector4(v.x, v.y, v.z, v.w) end,
+    Quaternion = function(q) return QuaternionType(q.w, q.x, q.y, q.z) end,
+    Color = function(c) return ColorType(c.r, c.g, c.b, c.a) end,
+}
+
+return
+{
+    Vector2 = Vector2,
+    Vector3 = Vector3,
+    Vector4 = Vector4,
+    Quaternion = Quaternion,
+    Color = Color,
+
+    -- Angle in degrees
+    FromAngleAxis = function(angle, axis)
+        local normAxis = axis:Normalized()
+        angle = angle * M_DEGTORAD_2
+        local sinAngle = sin(angle)
+        return QuaternionType(cos(angle), normAxis.x * sinAngle, normAxis.y * sinAngle, normAxis.z * sinAngle)
+    end,
+
+    -- Angles in degrees. Order of rotations: Z first, then X, then Y
+    FromEulerAngles = function(x, y, z)
+        x, y, z = x * M_DEGTORAD_2, y * M_DEGTORAD_2, z * M_DEGTORAD_2
+        local sinX, cosX, sinY, cosY, sinZ, cosZ = sin(x), cos(x), sin(y), cos(y), sin(z), cos(z)
+        return QuaternionType(
+            cosY * cosX * cosZ + sinY * sinX * sinZ,
+            cosY * sinX * cosZ + sinY * cosX * sinZ,
+            sinY * cosX * cosZ - cosY * sinX * sinZ,
+            cosY * cosX * sinZ - sinY * sinX * cosZ)
+    end,
+
+    -- Convert a tolua++ math value to its FFI struct
+    FromTolua = function(value)
+        local typeName = tolua.type(value):gsub("^const ", "")
+        local convert = fromTolua[typeName]
+        if not convert then
+            error("Unsupported type " .. typeName)
+        end
+        return convert(value)
+    end,
+
+    -- Return the FFI pointer of a tolua++ Node (or Scene) object
+    Node = function(node) return Payload(node, "Urho3DNode**") end,
+
+    -- Return the FFI pointer of a tolua++ Component object
+    Component = function(component) return Payload(component, "Urho3DComponent**") end,
+}
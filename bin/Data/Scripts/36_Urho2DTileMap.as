@@ -155,23 +155,22 @@ void HandleMouseButtonDown(StringHash eventType, VariantMap& eventData)
     int x, y;
     if (map.PositionToTileIndex(x, y, pos))
     {
-        // Get tile's sprite. Note that layer.GetTile(x, y).sprite is read-only, so we get the sprite through tile's node
-        Node@ n = layer.GetTileNode(x, y);
-        if (n is null)
+        // Skip tiles that are empty or already removed. Note that layer.GetTile(x, y).sprite is read-only, so the rendered sprite
+        // is replaced through the layer, which also works when the tiles are rendered in chunks
+        if (layer.GetTileSprite(x, y) is null)
             return;
-        StaticSprite2D@ sprite = n.GetComponent("StaticSprite2D");
 
         if (input.mouseButtonDown[MOUSEB_RIGHT])
         {
             // Swap grass and water
             if (layer.GetTile(x, y).gid < 9) // First 8 sprites in the "isometric_grass_and_water.png" tileset are mostly grass and from 9 to 24 they are mostly water
-                sprite.sprite = layer.GetTile(0, 0).sprite; // Replace grass by water sprite used in top tile
+                layer.SetTileSprite(x, y, layer.GetTile(0, 0).sprite); // Replace grass by water sprite used in top tile
             else
-                sprite.sprite = layer.GetTile(24, 24).sprite; // Replace water by grass sprite used in bottom tile
+                layer.SetTileSprite(x, y, layer.GetTile(24, 24).sprite); // Replace water by grass sprite used in bottom tile
         }
         else
         {
-            sprite.sprite = null; // 'Remove' sprite
+            layer.SetTileSprite(x, y, null); // 'Remove' sprite
         }
     }
 }
@@ -199,6 +199,7 @@ if (CMAKE_PROJECT_NAME STREQUAL Urho3D)
     cmake_dependent_option (URHO3D_HASH_DEBUG "Enable StringHash reversing and hash collision detection at the expense of memory and performance penalty" FALSE "NOT CMAKE_BUILD_TYPE STREQUAL Release" FALSE)
     cmake_dependent_option (URHO3D_3DNOW "Enable 3DNow! instruction set (Linux platform only); should only be used for older CPU with (legacy) 3DNow! support" "${HAVE_3DNOW}" "X86 OR E2K AND CMAKE_SYSTEM_NAME STREQUAL Linux AND NOT URHO3D_SSE" FALSE)
     cmake_dependent_option (URHO3D_MMX "Enable MMX instruction set (32-bit Linux platform only); the MMX is effectively enabled when 3DNow! or SSE is enabled; should only be used for older CPU with MMX support" "${HAVE_MMX}" "X86 OR E2K AND CMAKE_SYSTEM_NAME STREQUAL Linux AND NOT URHO3D_64BIT AND NOT URHO3D_SSE AND NOT URHO3D_3DNOW" FALSE)
+    cmake_dependent_option (URHO3D_NEON "Enable NEON instruction set in the math classes (ARM platforms with NEON only)" TRUE "NEON" FALSE)
     # For completeness sake - this option is intentionally not documented as we do not officially support PowerPC (yet)
     cmake_dependent_option (URHO3D_ALTIVEC "Enable AltiVec instruction set (PowerPC only)" "${HAVE_ALTIVEC}" POWERPC FALSE)
     cmake_dependent_option (URHO3D_LUAJIT "Enable Lua scripting support using LuaJIT (check LuaJIT's CMakeLists.txt for more options)" TRUE "NOT WEB AND NOT APPLE" FALSE)
@@ -258,6 +259,8 @@ cmake_dependent_option (URHO3D_PACKAGING "Enable resources packaging support" FA
 option (URHO3D_PROFILING "Enable default profiling support" TRUE)
 # Extended "Tracy Profiler" based profiling. Disabled by default.
 option (URHO3D_TRACY_PROFILING "Enable extended profiling support using Tracy Profiler; overrides URHO3D_PROFILING option" FALSE)
+# Recording every container allocation slows down the profiled application considerably, so it is opt-in. Disabled by default.
+cmake_dependent_option (URHO3D_TRACY_MEMORY "Record string, vector and allocator memory in Tracy memory pools" FALSE "URHO3D_TRACY_PROFILING" FALSE)
 # Enable logging by default. If disabled, LOGXXXX macros become no-ops and the Log subsystem is not instantiated.
 option (URHO3D_LOGGING "Enable logging support" TRUE)
 # Enable threading by default, except for Emscripten because its thread support is yet experimental
@@ -265,6 +268,8 @@ if (NOT WEB)
     set (THREADING_DEFAULT TRUE)
 endif ()
 option (URHO3D_THREADING "Enable thread support, on Web platform default to 0, on other platforms default to 1" ${THREADING_DEFAULT})
+# Multithreaded Bullet world is opt-in, as it builds the Bullet library thread-safe which adds locking overhead to the single-threaded path
+cmake_dependent_option (URHO3D_PHYSICS_THREADED "Enable multithreaded physics simulation on the work queue worker threads (builds Bullet with BT_THREADSAFE)" FALSE "URHO3D_PHYSICS AND URHO3D_THREADING" FALSE)
 if (URHO3D_TESTING)
     if (WEB)
         set (DEFAULT_TIMEOUT 10)
@@ -431,7 +436,7 @@ if (URHO3D_CLANG_TOOLS)
             URHO3D_URHO2D)
         set (${OPT} 1)
     endforeach ()
-    foreach (OPT URHO3D_TESTING URHO3D_LUAJIT URHO3D_DATABASE_ODBC URHO3D_TRACY_PROFILING)
+    foreach (OPT URHO3D_TESTING URHO3D_LUAJIT URHO3D_DATABASE_ODBC URHO3D_TRACY_PROFILING URHO3D_TRACY_MEMORY)
         set (${OPT} 0)
     endforeach ()
 endif ()
@@ -486,6 +491,7 @@ foreach (OPT
         URHO3D_PHYSICS2D
         URHO3D_PROFILING
         URHO3D_TRACY_PROFILING
+        URHO3D_TRACY_MEMORY
         URHO3D_THREADING
         URHO3D_URHO2D
         URHO3D_WEBP
@@ -951,7 +957,7 @@ macro (define_dependency_libs TARGET)
     if (${TARGET} STREQUAL Urho3D)
         # Core
         if (WIN32)
-            list (APPEND LIBS winmm)
+            list (APPEND LIBS winmm psapi)
             if (URHO3D_MINIDUMPS)
                 list (APPEND LIBS dbghelp)
             endif ()